@@ -2,12 +2,10 @@
 /// @file extractslice.cc : tool to extract slices from an image cube using
 ///                         standard interfaces. It can also be used to test I/O
 ///                         performance for various access patterns
-///                         At this stage implementation is rather basic without fancy
-///                         distributed access (although nothing stops us running a
-///                         number of applications as an array job + it distributes multiple 
-///                         slices between ranks out of the box) and delegates all
-///                         optimisation to the interface implementation (i.e. it just
-///                         requests a slice it needs).
+///                         Slices are distributed between ranks, slices close to each
+///                         other are grouped into batches (parameter batchrows) and read
+///                         as a single tile (in chunks of channels limited by tilesize in MB).
+///                         Batches can also be processed by several threads (nthreads).
 ///
 /// @copyright (c) 2020 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -40,6 +38,9 @@
 #include <iomanip>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <exception>
 
 
 // ASKAPSoft includes
@@ -82,6 +83,7 @@ ASKAP_LOGGER(logger, ".extractslice");
 
 // boost
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
 
 /// 3rd party
 #include <Common/ParameterSet.h>
@@ -104,6 +106,7 @@ class ExtractSliceApp : public askap::Application {
         ASKAPCHECK(dirAxes[0] >=0 && dirAxes[0] < static_cast<casacore::Int>(itsShape.nelements()) && dirAxes[1] >= 0 && dirAxes[1] < static_cast<casacore::Int>(itsShape.nelements()),
                    "Direction axes do not appear to be within the shape dimensions, this shouldn't happen. dirAxes = "<<dirAxes<<" shape = "<<itsShape);
         ASKAPLOG_INFO_STR(logger, "Direction axes: "<<dirAxes);
+        itsDirAxes = casacore::IPosition(2, dirAxes[0], dirAxes[1]);
 
         const casacore::Int spcAxis = cs.findCoordinate(casacore::Coordinate::SPECTRAL);
         ASKAPCHECK(spcAxis >= 0, "Spectral coordinate is not found in "<<itsName);
@@ -270,7 +273,7 @@ class ExtractSliceApp : public askap::Application {
                     // MV: a bit of technical debt, it would be neater to do a proper broadcast of the fixed info instead of copying it to each message
                     // (i.e. we have duplication of number of ranks times). But saves writing the same packing/unpacking into blob string for the broadcast
                     // although unlike for scatter, we do have appropriate broadcast method in MPIComms
-                    out << itsShape << itsPolAxisIndex << itsSpcAxisIndex;
+                    out << itsShape << itsPolAxisIndex << itsSpcAxisIndex << itsDirAxes;
                     //
                     for (size_t cnt = 0; cnt < nSlicesThisMsg; ++cnt, ++index) {
                          ASKAPDEBUGASSERT(index < names.size());
@@ -306,7 +309,7 @@ class ExtractSliceApp : public askap::Application {
                // MV: a bit of technical debt, it would be neater to do a proper broadcast of the fixed info instead of copying it to each message
                // (i.e. we have duplication of number of ranks times). But saves writing the same packing/unpacking into blob string for the broadcast
                // although unlike for scatter, we do have appropriate broadcast method in MPIComms
-               in >> itsShape >> itsPolAxisIndex >> itsSpcAxisIndex;
+               in >> itsShape >> itsPolAxisIndex >> itsSpcAxisIndex >> itsDirAxes;
                //
                ASKAPLOG_DEBUG_STR(logger, "Extracting "<<nSlicesThisMsg<<" slices from blob");
                for (size_t cnt = 0; cnt < nSlicesThisMsg; ++cnt) {
@@ -324,46 +327,192 @@ class ExtractSliceApp : public askap::Application {
    }
 
 
-   /// @brief actual extraction
-   void extractSlices() {
-        const casacore::CoordinateSystem cs = itsImageAccessor->coordSys(itsName);
-        const casacore::SpectralCoordinate sc = cs.spectralCoordinate();
+   /// @brief slices extracted from the same tile
+   /// @details The tile is the bounding box of all slice positions of the batch,
+   /// it covers all polarisations and is read in chunks of channels.
+   struct Batch {
+      /// @brief names of the slices
+      std::vector<std::string> itsNames;
+      /// @brief bottom left corner of the tile (first channel)
+      casacore::IPosition itsBlc;
+      /// @brief top right corner of the tile (first channel)
+      casacore::IPosition itsTrc;
+   };
+
+   /// @brief group slices into batches
+   /// @details Slices are sorted by position, the slices within the given number of rows
+   /// (along the 2nd direction axis) form a batch.
+   /// @param[in] batchRows maximum number of rows covered by a batch
+   /// @return batches covering all slices of this rank
+   std::vector<Batch> makeBatches(casacore::uInt batchRows) const {
+        ASKAPCHECK(batchRows > 0, "Number of rows per batch should be positive");
+        std::vector<std::pair<casacore::IPosition, std::string> > sorted;
+        sorted.reserve(itsSlices.size());
         for (auto ci : itsSlices) {
-             ASKAPLOG_INFO_STR(logger, "Exporting "<<ci.first);
-             casacore::IPosition trc(ci.second);
-             if (itsPolAxisIndex >= 0) {
-                 trc[itsPolAxisIndex] = itsShape[itsPolAxisIndex] - 1;
+             sorted.push_back(std::make_pair(ci.second, ci.first));
+        }
+        const casacore::Int xAxis = itsDirAxes[0];
+        const casacore::Int yAxis = itsDirAxes[1];
+        std::sort(sorted.begin(), sorted.end(), [xAxis, yAxis](const std::pair<casacore::IPosition, std::string> &a,
+                  const std::pair<casacore::IPosition, std::string> &b) {
+                  return a.first[yAxis] < b.first[yAxis] || (a.first[yAxis] == b.first[yAxis] && a.first[xAxis] < b.first[xAxis]); });
+        std::vector<Batch> result;
+        for (auto ci : sorted) {
+             if (result.empty() || ci.first[yAxis] - result.back().itsBlc[yAxis] >= static_cast<casacore::Int>(batchRows)) {
+                 result.push_back(Batch());
+                 result.back().itsBlc = ci.first;
+                 result.back().itsTrc = ci.first;
+                 if (itsPolAxisIndex >= 0) {
+                     result.back().itsTrc[itsPolAxisIndex] = itsShape[itsPolAxisIndex] - 1;
+                 }
              }
-             trc[itsSpcAxisIndex] = itsShape[itsSpcAxisIndex] - 1;
-             casacore::Array<casacore::Float> data = itsImageAccessor->read(itsName, ci.second, trc);
-             const casacore::IPosition sliceShape = data.shape();
-             std::ofstream os(itsPrefix + ci.first + ".dat");
-             os<<itsHeader;
-             os<<"# extracted from "<<ci.second<<" to "<<trc<<std::endl;
-             for (casacore::Int chan = 0; chan < itsShape[itsSpcAxisIndex]; ++chan) {
-                  casacore::IPosition sliceStart(sliceShape.nelements(),0);
-                  sliceStart[itsSpcAxisIndex] = chan;
-                  casacore::IPosition sliceEnd(sliceStart);
+             Batch &batch = result.back();
+             batch.itsNames.push_back(ci.second);
+             batch.itsBlc[xAxis] = std::min(batch.itsBlc[xAxis], ci.first[xAxis]);
+             batch.itsTrc[xAxis] = std::max(batch.itsTrc[xAxis], ci.first[xAxis]);
+             batch.itsTrc[yAxis] = ci.first[yAxis];
+        }
+        return result;
+   }
+
+   /// @brief extract all slices of a batch
+   /// @details The tile is read once per chunk of channels, the slices are copied from
+   /// memory and written when the whole spectral range has been read.
+   /// @param[in] accessor image accessor to read with
+   /// @param[in] batch slices to extract
+   /// @param[in] sc spectral coordinate of the cube
+   /// @param[in] maxTilePixels maximum number of pixels read at a time
+   void extractBatch(const IImageAccess<casacore::Float> &accessor, const Batch &batch,
+                     const casacore::SpectralCoordinate &sc, size_t maxTilePixels) const {
+        const casacore::IPosition tileShape = batch.itsTrc - batch.itsBlc + 1;
+        const size_t nChan = itsShape[itsSpcAxisIndex];
+        const size_t chunk = std::max(size_t(1), std::min(nChan, maxTilePixels / static_cast<size_t>(tileShape.product())));
+        ASKAPLOG_INFO_STR(logger, "Extracting "<<batch.itsNames.size()<<" slice(s) from the tile "<<batch.itsBlc<<
+                          " - "<<batch.itsTrc<<" in chunks of "<<chunk<<" channel(s)");
+        std::vector<casacore::Array<casacore::Float> > slices(batch.itsNames.size());
+        casacore::IPosition sliceShape(tileShape.nelements(), 1);
+        if (itsPolAxisIndex >= 0) {
+            sliceShape[itsPolAxisIndex] = tileShape[itsPolAxisIndex];
+        }
+        sliceShape[itsSpcAxisIndex] = nChan;
+        for (size_t index = 0; index < slices.size(); ++index) {
+             slices[index].resize(sliceShape);
+        }
+        for (size_t startChan = 0; startChan < nChan; startChan += chunk) {
+             casacore::IPosition blc(batch.itsBlc);
+             casacore::IPosition trc(batch.itsTrc);
+             blc[itsSpcAxisIndex] = startChan;
+             trc[itsSpcAxisIndex] = std::min(startChan + chunk, nChan) - 1;
+             const casacore::Array<casacore::Float> tile = accessor.read(itsName, blc, trc);
+             for (size_t index = 0; index < slices.size(); ++index) {
+                  const std::map<std::string, casacore::IPosition>::const_iterator ci = itsSlices.find(batch.itsNames[index]);
+                  ASKAPDEBUGASSERT(ci != itsSlices.end());
+                  casacore::IPosition tileBlc = ci->second - batch.itsBlc;
+                  tileBlc[itsSpcAxisIndex] = 0;
+                  casacore::IPosition tileTrc(tileBlc);
+                  tileTrc[itsSpcAxisIndex] = trc[itsSpcAxisIndex] - blc[itsSpcAxisIndex];
                   if (itsPolAxisIndex >= 0) {
-                      sliceEnd[itsPolAxisIndex] = sliceShape[itsPolAxisIndex] - 1;
+                      tileTrc[itsPolAxisIndex] = tileShape[itsPolAxisIndex] - 1;
                   }
+                  casacore::IPosition sliceBlc(sliceShape.nelements(), 0);
+                  sliceBlc[itsSpcAxisIndex] = startChan;
+                  casacore::IPosition sliceTrc(sliceShape - 1);
+                  sliceTrc[itsSpcAxisIndex] = trc[itsSpcAxisIndex];
+                  slices[index](sliceBlc, sliceTrc) = tile(tileBlc, tileTrc);
+             }
+        }
+        for (size_t index = 0; index < slices.size(); ++index) {
+             writeSlice(batch.itsNames[index], slices[index], sc);
+        }
+   }
 
-                  casacore::Array<casacore::Float> slice = data(sliceStart, sliceEnd);
-                  const casacore::Vector<casacore::Float> dataVec = slice.reform(casacore::IPosition(1, slice.nelements()));
-                  casacore::Double freqOrVel = -1.;
-                  const bool success = sc.toWorld(freqOrVel, static_cast<casacore::Double>(chan));
-                  ASKAPCHECK(success, "Unable to convert channel index "<<chan<<" to the physical units for "<<ci.first<<", error = "<<sc.errorMessage());
-                  ASKAPCHECK(!std::isnan(freqOrVel), "Encountered NaN after frequency conversion for channel = "<<chan<<" for "<<ci.first);
-                  os<<chan<<" "<<std::setprecision(15)<<freqOrVel<<" ";
-                  for (size_t elem = 0; elem < dataVec.nelements(); ++elem) {
-                       if (std::isnan(dataVec[elem])) {
-                           os<<" flagged";
-                       } else {
-                           os<<" "<<std::setprecision(15)<<dataVec[elem];
-                       }
+   /// @brief write the slice into its own file
+   /// @param[in] name name of the slice
+   /// @param[in] data extracted pixels (all polarisations and channels for the slice position)
+   /// @param[in] sc spectral coordinate of the cube
+   void writeSlice(const std::string &name, const casacore::Array<casacore::Float> &data,
+                   const casacore::SpectralCoordinate &sc) const {
+        const std::map<std::string, casacore::IPosition>::const_iterator ci = itsSlices.find(name);
+        ASKAPDEBUGASSERT(ci != itsSlices.end());
+        ASKAPLOG_INFO_STR(logger, "Exporting "<<name);
+        const casacore::IPosition trc = ci->second + data.shape() - 1;
+        const casacore::IPosition sliceShape = data.shape();
+        std::ofstream os(itsPrefix + name + ".dat");
+        os<<itsHeader;
+        os<<"# extracted from "<<ci->second<<" to "<<trc<<std::endl;
+        for (casacore::Int chan = 0; chan < itsShape[itsSpcAxisIndex]; ++chan) {
+             casacore::IPosition sliceStart(sliceShape.nelements(),0);
+             sliceStart[itsSpcAxisIndex] = chan;
+             casacore::IPosition sliceEnd(sliceStart);
+             if (itsPolAxisIndex >= 0) {
+                 sliceEnd[itsPolAxisIndex] = sliceShape[itsPolAxisIndex] - 1;
+             }
+
+             const casacore::Array<casacore::Float> slice = data(sliceStart, sliceEnd);
+             const casacore::Vector<casacore::Float> dataVec = slice.reform(casacore::IPosition(1, slice.nelements()));
+             casacore::Double freqOrVel = -1.;
+             const bool success = sc.toWorld(freqOrVel, static_cast<casacore::Double>(chan));
+             ASKAPCHECK(success, "Unable to convert channel index "<<chan<<" to the physical units for "<<name<<", error = "<<sc.errorMessage());
+             ASKAPCHECK(!std::isnan(freqOrVel), "Encountered NaN after frequency conversion for channel = "<<chan<<" for "<<name);
+             os<<chan<<" "<<std::setprecision(15)<<freqOrVel<<" ";
+             for (size_t elem = 0; elem < dataVec.nelements(); ++elem) {
+                  if (std::isnan(dataVec[elem])) {
+                      os<<" flagged";
+                  } else {
+                      os<<" "<<std::setprecision(15)<<dataVec[elem];
                   }
-                  os<<std::endl;
-             } 
+             }
+             os<<std::endl;
+        }
+   }
+
+   /// @brief actual extraction
+   /// @details Slices are grouped into batches (see makeBatches) and the batches are processed
+   /// by the given number of threads. Each thread uses its own image accessor set up from
+   /// the parset (in the serial mode), as accessors are not thread-safe.
+   /// @param[in] nThreads number of threads
+   /// @param[in] batchRows maximum number of rows covered by a batch
+   /// @param[in] maxTilePixels maximum number of pixels read at a time by each thread
+   void extractSlices(size_t nThreads, casacore::uInt batchRows, size_t maxTilePixels) {
+        if (itsSlices.size() == 0) {
+            return;
+        }
+        const std::vector<Batch> batches = makeBatches(batchRows);
+        ASKAPLOG_INFO_STR(logger, "Slices are grouped into "<<batches.size()<<" batch(es)");
+        nThreads = std::max(size_t(1), std::min(nThreads, batches.size()));
+        if (nThreads == 1) {
+            const casacore::SpectralCoordinate sc = itsImageAccessor->coordSys(itsName).spectralCoordinate();
+            for (const Batch &batch : batches) {
+                 extractBatch(*itsImageAccessor, batch, sc, maxTilePixels);
+            }
+            return;
+        }
+        ASKAPLOG_INFO_STR(logger, "Using "<<nThreads<<" threads");
+        std::atomic<size_t> nextBatch(0);
+        std::vector<std::exception_ptr> errors(nThreads);
+        boost::thread_group threads;
+        for (size_t thread = 0; thread < nThreads; ++thread) {
+             threads.create_thread([this, &batches, &nextBatch, &errors, thread, maxTilePixels]() {
+                  try {
+                     const boost::shared_ptr<IImageAccess<casacore::Float> > accessor = imageAccessFactory(config());
+                     // coordinates have internal caches, so each thread needs its own copy
+                     const casacore::SpectralCoordinate sc = accessor->coordSys(itsName).spectralCoordinate();
+                     for (size_t index = nextBatch++; index < batches.size(); index = nextBatch++) {
+                          extractBatch(*accessor, batches[index], sc, maxTilePixels);
+                     }
+                  }
+                  catch (...) {
+                     errors[thread] = std::current_exception();
+                     // let other threads finish early
+                     nextBatch = batches.size();
+                  }
+             });
+        }
+        threads.join_all();
+        for (const std::exception_ptr &error : errors) {
+             if (error) {
+                 std::rethrow_exception(error);
+             }
         }
    }
 
@@ -435,7 +584,8 @@ public:
 
         timer.mark();
         // the following will work for the serial case too if done under MPI and will just cause a single iteration over slices
-        extractSlices(); 
+        extractSlices(config().getUint("nthreads", 1), config().getUint("batchrows", 32),
+                      config().getUint("tilesize", 256) * 1024u * 1024u / sizeof(casacore::Float));
         ASKAPLOG_INFO_STR(logger, "Completed extraction in "<<timer.real()<<" seconds");
         comms.barrier();
         stats.logSummary();
@@ -486,6 +636,9 @@ private:
 
    /// @brief polarisation axis index in the cube
    casacore::Int itsPolAxisIndex;
+
+   /// @brief direction axes indices in the cube
+   casacore::IPosition itsDirAxes;
 };
 
 
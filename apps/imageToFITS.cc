@@ -3,6 +3,10 @@
 /// Utility function to convert a CASA image to a FITS image. Provides
 /// a parset interface to allow more flexibility than the casacore
 /// image2fits function.
+/// By default, the image is streamed through the image accessors: it is read
+/// piece by piece (bounded by memoryInMB) and written in the background, so the
+/// memory used doesn't depend on the image size. The casacore converter is used
+/// if any of the options supported by it only are given (see ConvertApp).
 ///
 /// @copyright (c) 2014 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -37,17 +41,41 @@
 #include <askap/askap/AskapLogging.h>
 #include <askap/askap/AskapError.h>
 #include <askap/askap/StatReporter.h>
+#include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/FitsImageAccess.h>
+#include <askap/imageaccess/ImageCursor.h>
+#include <askap/imageaccess/AsyncImageWriter.h>
 
 #include <Common/ParameterSet.h>
 #include <casacore/images/Images/ImageFITSConverter.h>
 #include <casacore/images/Images/PagedImage.h>
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/casa/Logging/LogIO.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/Timer.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
 
 using namespace askap;
 
 ASKAP_LOGGER(logger, ".imageToFITS");
 
+/// @brief conversion application
+/// @details Parameters with the ImageToFITS prefix. In addition to the options of
+/// the casacore converter, the following are used in the streaming mode:
+///   streaming - use the streaming converter (true by default)
+///   checksum  - write CHECKSUM and DATASUM keywords (false by default)
+///   imagecompress, imagecompress.* - tile compression (see FitsCompression::fromParset)
+/// preferVelocity, opticalVelocity, degenerateLast, stokesLast, preferWavelength and
+/// airWavelength are supported by the casacore converter only, it is used if any of them
+/// is given.
 class ConvertApp : public askap::Application {
     public:
         virtual int run(int argc, char* argv[])
@@ -63,6 +91,50 @@ class ConvertApp : public askap::Application {
                 parset.adoptCollection(config());
                 LOFAR::ParameterSet subset(parset.makeSubset("ImageToFITS."));
 
+                int bitpix = subset.getInt("bitpix", -32);
+                if (bitpix != -32 && bitpix != 16) {
+                    ASKAPTHROW(AskapError, "BITPIX can only be -32 or 16.");
+                }
+
+                const char* converterOnly[] = {"preferVelocity", "opticalVelocity", "degenerateLast",
+                                               "stokesLast", "preferWavelength", "airWavelength"};
+                bool streaming = subset.getBool("streaming", true);
+                for (const char* key : converterOnly) {
+                     if (streaming && subset.isDefined(key)) {
+                         ASKAPLOG_INFO_STR(logger, key << " is only supported by the casacore converter, "
+                                           "the image will be converted in memory");
+                         streaming = false;
+                     }
+                }
+                if (streaming) {
+                    streamConvert(subset);
+                } else {
+                    convert(subset);
+                }
+
+                stats.logSummary();
+                ///==============================================================================
+            } catch (const askap::AskapError& x) {
+                ASKAPLOG_FATAL_STR(logger, "Askap error in " << argv[0] << ": " << x.what());
+                std::cerr << "Askap error in " << argv[0] << ": " << x.what() << std::endl;
+                exit(1);
+            } catch (const std::exception& x) {
+                ASKAPLOG_FATAL_STR(logger,
+                                   "Unexpected exception in " << argv[0] << ": " << x.what());
+                std::cerr << "Unexpected exception in " << argv[0] << ": " <<
+                          x.what() << std::endl;
+                exit(1);
+            }
+
+            return 0;
+        }
+
+    private:
+        /// @brief convert the image with casacore's ImageFITSConverter
+        /// @details The converter holds large parts of the image in memory.
+        /// @param[in] subset parameters
+        void convert(const LOFAR::ParameterSet &subset)
+        {
                 std::string casaimage = subset.getString("casaimage", "");
                 std::string fitsimage = subset.getString("fitsimage", "");
                 unsigned int memoryInMB = subset.getUint("memoryInMB", 64);
@@ -81,10 +153,6 @@ class ConvertApp : public askap::Application {
 
                 std::string origin = ASKAP_PACKAGE_VERSION;
 
-                if (bitpix != -32 && bitpix != 16) {
-                    ASKAPTHROW(AskapError, "BITPIX can only be -32 or 16.");
-                }
-
                 casacore::String errorMsg;
                 bool returnVal;
 
@@ -128,26 +196,193 @@ class ConvertApp : public askap::Application {
                 if (!returnVal) {
                     ASKAPTHROW(AskapError, errorMsg);
                 }
+        }
 
+        /// @brief convert the image piece by piece
+        /// @details The pieces are read by ImageCursor with prefetching and written by
+        /// AsyncImageWriter through the FITS handle kept open by the accessor, so reading,
+        /// masking and writing overlap. memoryInMB bounds the size of the pieces held
+        /// at any time (the piece being masked, the prefetched one and the write queue).
+        /// CASA masks are applied as NaNs. Headers and history given in the parset are
+        /// written into the FITS header, the history of the CASA image is not copied.
+        /// @param[in] subset parameters
+        void streamConvert(const LOFAR::ParameterSet &subset)
+        {
+            const std::string casaimage = subset.getString("casaimage", "");
+            std::string fitsName = subset.getString("fitsimage", "");
+            // the accessor adds the extension
+            if ((fitsName.size() > 5) && (fitsName.compare(fitsName.size() - 5, 5, ".fits") == 0)) {
+                fitsName.resize(fitsName.size() - 5);
+            }
+            ASKAPCHECK(fitsName != "", "The output FITS image is not given");
+            ASKAPCHECK(subset.getBool("allowOverwrite", false) || !casacore::File(fitsName + ".fits").exists(),
+                       "The output FITS image " << fitsName << ".fits already exists, set allowOverwrite to replace it");
+            const size_t memoryInMB = subset.getUint("memoryInMB", 64);
+            const int bitpix = subset.getInt("bitpix", -32);
+            float minpix = subset.getFloat("minpix", 1.0);
+            float maxpix = subset.getFloat("maxpix", -1.0);
 
-                stats.logSummary();
-                ///==============================================================================
-            } catch (const askap::AskapError& x) {
-                ASKAPLOG_FATAL_STR(logger, "Askap error in " << argv[0] << ": " << x.what());
-                std::cerr << "Askap error in " << argv[0] << ": " << x.what() << std::endl;
-                exit(1);
-            } catch (const std::exception& x) {
-                ASKAPLOG_FATAL_STR(logger,
-                                   "Unexpected exception in " << argv[0] << ": " << x.what());
-                std::cerr << "Unexpected exception in " << argv[0] << ": " <<
-                          x.what() << std::endl;
-                exit(1);
+            accessors::CasaImageAccess<casacore::Float> input;
+            const casacore::IPosition shape = input.shape(casaimage);
+            const casacore::CoordinateSystem csys = input.coordSys(casaimage);
+            const bool masked = input.isMasked(casaimage);
+
+            boost::shared_ptr<accessors::FitsImageAccess> output(new accessors::FitsImageAccess());
+            output->useFastAlloc(true);
+            const accessors::FitsCompression compression = accessors::FitsCompression::fromParset(subset);
+            output->setCompression(compression);
+
+            // a third of the memory for each piece in flight
+            const size_t budget = std::max(size_t(1), memoryInMB * 1024 * 1024 / sizeof(casacore::Float) / 3);
+            const casacore::IPosition cursorShape = pieceShape(shape, budget, compression);
+            ASKAPLOG_INFO_STR(logger, "Streaming " << casaimage << " with the shape " << shape << " into " <<
+                              fitsName << ".fits in pieces of " << cursorShape);
+            casacore::Timer timer;
+            if ((bitpix != -32) && (minpix > maxpix)) {
+                // slices of integer images can only be written with known scaling
+                timer.mark();
+                dataRange(input, casaimage, cursorShape, masked, minpix, maxpix);
+                ASKAPLOG_INFO_STR(logger, "Data range is from " << minpix << " to " << maxpix << ", obtained in " <<
+                                  timer.real() << " s");
             }
+            output->setBitpix(bitpix, minpix, maxpix);
+            output->create(fitsName, shape, csys);
 
-            return 0;
+            timer.mark();
+            {
+              accessors::ImageCursor<casacore::Float> cursor(input, casaimage, cursorShape);
+              accessors::AsyncImageWriter<casacore::Float> writer(output, budget * sizeof(casacore::Float));
+              casacore::Array<casacore::Float> buffer;
+              casacore::LogicalArray mask;
+              while (cursor.next(buffer)) {
+                     if (masked) {
+                         applyMask(input, casaimage, cursor.blc(), cursor.trc(), mask, buffer);
+                     }
+                     writer.writeAdopt(fitsName, buffer, cursor.blc());
+              }
+              writer.flush();
+            }
+            ASKAPLOG_INFO_STR(logger, "Pixels have been copied in " << timer.real() << " s");
+
+            output->beginHeaderUpdate(fitsName);
+            output->setUnits(fitsName, input.getUnits(casaimage));
+            const accessors::BeamList beams = input.beamList(casaimage);
+            if (beams.size() > 0) {
+                output->setBeamInfo(fitsName, beams);
+            } else {
+                const casacore::Vector<casacore::Quantum<double> > beam = input.beamInfo(casaimage);
+                if ((beam.nelements() == 3) && (beam[0].getValue("rad") > 0.)) {
+                    output->setBeamInfo(fitsName, beam[0].getValue("rad"), beam[1].getValue("rad"),
+                                        beam[2].getValue("rad"));
+                }
+            }
+            if (subset.isDefined("headers")) {
+                for (const std::string &keyword : subset.getStringVector("headers", "")) {
+                     const std::string val = subset.getString("headers." + keyword, "");
+                     if (val != "") {
+                         output->setMetadataKeyword(fitsName, keyword, val, "");
+                     }
+                }
+            }
+            if (subset.isDefined("history")) {
+                output->addHistory(fitsName, subset.getStringVector("history", ""));
+            }
+            output->commitHeaderUpdate(fitsName);
+            if (subset.getBool("checksum", false)) {
+                output->writeChecksum(fitsName);
+            }
+            output->flush();
+        }
+
+        /// @brief shape of the piece read at a time
+        /// @details Whole planes are read if they fit into the budget, several planes
+        /// along the 3rd axis if possible, rows of a plane otherwise. With compression,
+        /// the pieces are aligned with the compression tiles.
+        /// @param[in] shape image shape
+        /// @param[in] budget maximum number of pixels in a piece
+        /// @param[in] compression compression of the output
+        /// @return cursor shape
+        static casacore::IPosition pieceShape(const casacore::IPosition &shape, size_t budget,
+                                              const accessors::FitsCompression &compression)
+        {
+            casacore::IPosition result = accessors::ImageCursor<casacore::Float>::planeShape(shape);
+            const size_t planeSize = result.product();
+            if (planeSize > budget) {
+                if (shape.nelements() > 1) {
+                    result[1] = std::max(size_t(1), budget / static_cast<size_t>(shape[0]));
+                }
+            } else if (shape.nelements() > 2) {
+                result[2] = std::min(static_cast<size_t>(shape[2]), budget / planeSize);
+            }
+            if (compression.enabled()) {
+                const casacore::IPosition tile = compression.tileShape(shape);
+                for (casacore::uInt axis = 0; axis < std::min(result.nelements(), tile.nelements()); ++axis) {
+                     if ((result[axis] < shape[axis]) && (tile[axis] > 0)) {
+                         result[axis] = std::max(tile[axis], result[axis] / tile[axis] * tile[axis]);
+                     }
+                }
+            }
+            return result;
+        }
+
+        /// @brief replace masked pixels by NaNs
+        /// @param[in] input accessor for the CASA image
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the piece
+        /// @param[in] trc top right corner of the piece
+        /// @param[in,out] mask buffer for the mask
+        /// @param[in,out] pixels pixels of the piece
+        static void applyMask(const accessors::CasaImageAccess<casacore::Float> &input, const std::string &name,
+                              const casacore::IPosition &blc, const casacore::IPosition &trc,
+                              casacore::LogicalArray &mask, casacore::Array<casacore::Float> &pixels)
+        {
+            input.readMaskInto(name, blc, trc, mask);
+            if (casacore::allEQ(mask, true)) {
+                return;
+            }
+            float nan;
+            casacore::setNaN(nan);
+            casacore::Array<casacore::Float>::iterator pixelIt = pixels.begin();
+            for (casacore::LogicalArray::const_iterator maskIt = mask.begin(); maskIt != mask.end(); ++maskIt, ++pixelIt) {
+                 if (!*maskIt) {
+                     *pixelIt = nan;
+                 }
+            }
+        }
+
+        /// @brief obtain minimum and maximum of the unmasked pixels
+        /// @param[in] input accessor for the CASA image
+        /// @param[in] name image name
+        /// @param[in] cursorShape shape of the piece read at a time
+        /// @param[in] masked true if the image has a mask
+        /// @param[out] minPix minimum value
+        /// @param[out] maxPix maximum value
+        static void dataRange(const accessors::CasaImageAccess<casacore::Float> &input, const std::string &name,
+                              const casacore::IPosition &cursorShape, bool masked, float &minPix, float &maxPix)
+        {
+            minPix = std::numeric_limits<float>::max();
+            maxPix = -std::numeric_limits<float>::max();
+            accessors::ImageCursor<casacore::Float> cursor(input, name, cursorShape);
+            casacore::Array<casacore::Float> buffer;
+            casacore::LogicalArray mask;
+            while (cursor.next(buffer)) {
+                   if (masked) {
+                       applyMask(input, name, cursor.blc(), cursor.trc(), mask, buffer);
+                   }
+                   for (casacore::Array<casacore::Float>::const_iterator ci = buffer.begin(); ci != buffer.end(); ++ci) {
+                        if (!casacore::isNaN(*ci)) {
+                            minPix = std::min(minPix, *ci);
+                            maxPix = std::max(maxPix, *ci);
+                        }
+                   }
+            }
+            if (minPix > maxPix) {
+                // all pixels are masked
+                minPix = 0.;
+                maxPix = 1.;
+            }
         }
 
-    private:
         std::string getVersion() const override {
             const std::string pkgVersion = std::string("base-accessor:") + ASKAP_PACKAGE_VERSION;
             return pkgVersion;
@@ -0,0 +1,380 @@
+///
+/// @file replayiotrace.cc : tool to re-issue the I/O access pattern recorded by IORecorder
+///                          (ASKAP_IO_TRACE=file) against copies of the data. Table column
+///                          ranges, image regions and calibration solutions are read (and
+///                          written back) in the recorded order, so the storage behaviour
+///                          of a pipeline stage can be studied without running it.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// std includes
+#include <string>
+#include <vector>
+#include <map>
+
+// ASKAPSoft includes
+#include "askap_accessors.h"
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+#include "askap/Application.h"
+#include "askap/StatReporter.h"
+#include "askap/dataaccess/IORecorder.h"
+#include "askap/imageaccess/CasaImageAccess.h"
+#include "askap/imageaccess/FitsImageAccess.h"
+
+ASKAP_LOGGER(logger, ".replayiotrace");
+
+// casa
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/Slicer.h>
+
+// boost
+#include <boost/shared_ptr.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+
+/// 3rd party
+#include <Common/ParameterSet.h>
+
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief read (and optionally write back) a range of rows of an array column
+/// @param[in] table table to work with
+/// @param[in] column name of the column
+/// @param[in] rows rows to access
+/// @param[in] cellSlicer part of each cell to access (NULL for the whole cells)
+/// @param[in] write if true, the data read are written back
+/// @return number of bytes transferred
+template<typename T>
+size_t replayColumnRange(const casacore::Table &table, const std::string &column, const casacore::Slicer &rows,
+                         const casacore::Slicer *cellSlicer, bool write)
+{
+  casacore::ArrayColumn<T> col(table, column);
+  const casacore::Array<T> data = cellSlicer != NULL ? col.getColumnRange(rows, *cellSlicer) :
+                                  col.getColumnRange(rows);
+  if (write) {
+      if (cellSlicer != NULL) {
+          col.putColumnRange(rows, *cellSlicer, data);
+      } else {
+          col.putColumnRange(rows, data);
+      }
+  }
+  return data.nelements() * sizeof(T);
+}
+
+/// @brief I/O trace replay application
+/// @details Parameters (no prefix):
+///   trace    - name of the trace file written by IORecorder
+///   pathmap  - optional list of from:to prefix substitutions applied to the table and
+///              image names, e.g. [/scratch/sb1234:/tmp/copy], so the copies are accessed
+///   readonly - if true, writes are skipped (default false, writes replay the recorded
+///              regions with the data read from them, or with zeros for images)
+///   realtime - if true, events are started at the recorded times rather than back to
+///              back (default false)
+/// The events are replayed sequentially in the recorded order, regardless of the thread
+/// which has issued them originally. A summary with the recorded and replay times is
+/// logged for each type of events.
+class ReplayIOTraceApp : public askap::Application {
+public:
+   virtual int run(int argc, char* argv[])
+   {
+     try {
+        StatReporter stats;
+        casacore::Timer timer;
+        const std::string traceName = config().getString("trace");
+        ASKAPCHECK(traceName != "", "Trace file name is not supposed to be empty");
+        const std::vector<std::string> pathMap = config().isDefined("pathmap") ?
+                   config().getStringVector("pathmap") : std::vector<std::string>();
+        for (std::vector<std::string>::const_iterator ci = pathMap.begin(); ci != pathMap.end(); ++ci) {
+             const size_t pos = ci->find(':');
+             ASKAPCHECK(pos != std::string::npos, "Path substitutions are expected in the form from:to, you have "<<*ci);
+             itsPathMap.push_back(std::make_pair(ci->substr(0, pos), ci->substr(pos + 1)));
+        }
+        itsReadOnly = config().getBool("readonly", false);
+        const bool realTime = config().getBool("realtime", false);
+
+        const std::vector<IORecorder::Event> events = IORecorder::readTrace(traceName);
+        ASKAPLOG_INFO_STR(logger, "Replaying "<<events.size()<<" I/O event(s) from "<<traceName<<
+                          (itsReadOnly ? ", writes are skipped" : ""));
+        timer.mark();
+        const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        for (std::vector<IORecorder::Event>::const_iterator ci = events.begin(); ci != events.end(); ++ci) {
+             if (realTime) {
+                 boost::this_thread::sleep_until(start + boost::chrono::duration_cast<boost::chrono::steady_clock::duration>(
+                                                 boost::chrono::duration<double>(ci->itsStart)));
+             }
+             const boost::chrono::steady_clock::time_point eventStart = boost::chrono::steady_clock::now();
+             const size_t bytes = replay(*ci);
+             Summary &summary = itsSummary[ci->itsType];
+             ++summary.itsCount;
+             summary.itsRecordedBytes += ci->itsBytes;
+             summary.itsRecordedTime += ci->itsDuration;
+             summary.itsBytes += bytes;
+             summary.itsTime += boost::chrono::duration<double>(boost::chrono::steady_clock::now() - eventStart).count();
+        }
+        ASKAPLOG_INFO_STR(logger, "Replay completed in "<<timer.real()<<" seconds");
+        for (std::map<IORecorder::EventType, Summary>::const_iterator ci = itsSummary.begin();
+             ci != itsSummary.end(); ++ci) {
+             const Summary &summary = ci->second;
+             ASKAPLOG_INFO_STR(logger, IORecorder::typeName(ci->first)<<": "<<summary.itsCount<<" event(s), recorded "<<
+                     summary.itsRecordedBytes<<" bytes in "<<summary.itsRecordedTime<<" s, replayed "<<
+                     summary.itsBytes<<" bytes in "<<summary.itsTime<<" s");
+        }
+        stats.logSummary();
+        return 0;
+     }
+     catch (const askap::AskapError& e) {
+        ASKAPLOG_FATAL_STR(logger, "Askap error in " << argv[0] << ": " << e.what());
+        std::cerr << "Askap error in " << argv[0] << ": " << e.what() << std::endl;
+        return 1;
+     } catch (const std::exception& e) {
+        ASKAPLOG_FATAL_STR(logger, "Unexpected exception in " << argv[0] << ": " << e.what());
+        std::cerr << "Unexpected exception in " << argv[0] << ": " << e.what()
+                  << std::endl;
+        return 1;
+     }
+   }
+private:
+   /// @brief statistics for one type of events
+   struct Summary {
+      Summary() : itsCount(0), itsRecordedBytes(0), itsRecordedTime(0.), itsBytes(0), itsTime(0.) {}
+      size_t itsCount;
+      size_t itsRecordedBytes;
+      double itsRecordedTime;
+      size_t itsBytes;
+      double itsTime;
+   };
+
+   /// @brief replay a single event
+   /// @param[in] event event to replay
+   /// @return number of bytes transferred
+   size_t replay(const IORecorder::Event &event)
+   {
+     switch (event.itsType) {
+        case IORecorder::TABLE_READ:
+        case IORecorder::TABLE_WRITE:
+             return replayTable(event);
+        case IORecorder::CAL_FETCH:
+             return replayCalFetch(event);
+        case IORecorder::IMAGE_READ:
+        case IORecorder::IMAGE_WRITE:
+             return replayImage(event);
+     };
+     ASKAPTHROW(AskapError, "Unknown I/O event type "<<int(event.itsType));
+   }
+
+   /// @brief replay access to table columns
+   /// @param[in] event event to replay
+   /// @return number of bytes transferred
+   size_t replayTable(const IORecorder::Event &event)
+   {
+     const bool write = (event.itsType == IORecorder::TABLE_WRITE);
+     if (write && itsReadOnly) {
+         return 0;
+     }
+     ASKAPCHECK((event.itsCoordinates.size() == 2) || (event.itsCoordinates.size() == 4),
+                "Unexpected coordinates of the table event for "<<event.itsObject);
+     if (event.itsCoordinates[1] == 0) {
+         return 0;
+     }
+     const casacore::Table &tab = table(event.itsObject, write);
+     const casacore::Slicer rows(casacore::IPosition(1, event.itsCoordinates[0]),
+                                 casacore::IPosition(1, event.itsCoordinates[1]));
+     if (event.itsCoordinates.size() == 4) {
+         const casacore::Slicer chanSlicer(casacore::Slice(), casacore::Slice(event.itsCoordinates[2],
+                                           event.itsCoordinates[3]));
+         return replayColumn(tab, event.itsDetail, rows, &chanSlicer, write);
+     }
+     return replayColumn(tab, event.itsDetail, rows, NULL, write);
+   }
+
+   /// @brief replay a read of a calibration solution
+   /// @details Both the values and the validity flags are read, only the rows of the
+   /// cube corresponding to the channels are read for a channel range.
+   /// @param[in] event event to replay
+   /// @return number of bytes transferred
+   size_t replayCalFetch(const IORecorder::Event &event)
+   {
+     ASKAPCHECK((event.itsCoordinates.size() == 2) || (event.itsCoordinates.size() == 4),
+                "Unexpected coordinates of the calibration event for "<<event.itsObject);
+     const casacore::Table &tab = table(event.itsObject, false);
+     const casacore::Slicer rows(casacore::IPosition(1, event.itsCoordinates[0]),
+                                 casacore::IPosition(1, event.itsCoordinates[1]));
+     if (event.itsCoordinates.size() == 4) {
+         // values for both polarisations are stored for each channel
+         const casacore::Slicer chanSlicer(casacore::Slice(2 * event.itsCoordinates[2], 2 * event.itsCoordinates[3]),
+                                           casacore::Slice(), casacore::Slice());
+         return replayColumn(tab, event.itsDetail, rows, &chanSlicer, false) +
+                replayColumn(tab, event.itsDetail + "_VALID", rows, &chanSlicer, false);
+     }
+     return replayColumn(tab, event.itsDetail, rows, NULL, false) +
+            replayColumn(tab, event.itsDetail + "_VALID", rows, NULL, false);
+   }
+
+   /// @brief replay access to an image region
+   /// @details Writes put zeros into the region (the mask is not written).
+   /// @param[in] event event to replay
+   /// @return number of bytes transferred
+   size_t replayImage(const IORecorder::Event &event)
+   {
+     const bool write = (event.itsType == IORecorder::IMAGE_WRITE);
+     if (write && itsReadOnly) {
+         return 0;
+     }
+     const size_t nDim = event.itsCoordinates.size() / 2;
+     ASKAPCHECK(event.itsCoordinates.size() == 2 * nDim, "Unexpected coordinates of the image event for "<<
+                event.itsObject);
+     casacore::IPosition blc(nDim);
+     casacore::IPosition shape(nDim);
+     for (size_t dim = 0; dim < nDim; ++dim) {
+          blc[dim] = event.itsCoordinates[dim];
+          shape[dim] = event.itsCoordinates[nDim + dim];
+     }
+     if (shape.product() == 0) {
+         return 0;
+     }
+     IImageAccess<casacore::Float> &acc = imageAccessor(event.itsDetail);
+     const std::string name = mapPath(event.itsObject);
+     if (write) {
+         acc.write(name, casacore::Array<casacore::Float>(shape, 0.f), blc);
+         return shape.product() * sizeof(casacore::Float);
+     }
+     return acc.read(name, blc, blc + shape - 1).nelements() * sizeof(casacore::Float);
+   }
+
+   /// @brief dispatch column access according to the data type of the column
+   /// @param[in] tab table to work with
+   /// @param[in] column name of the column
+   /// @param[in] rows rows to access
+   /// @param[in] cellSlicer part of each cell to access (NULL for the whole cells)
+   /// @param[in] write if true, the data read are written back
+   /// @return number of bytes transferred
+   static size_t replayColumn(const casacore::Table &tab, const std::string &column, const casacore::Slicer &rows,
+                              const casacore::Slicer *cellSlicer, bool write)
+   {
+     ASKAPCHECK(tab.tableDesc().isColumn(column), "Column "<<column<<" is missing in "<<tab.tableName());
+     switch (tab.tableDesc().columnDesc(column).dataType()) {
+        case casacore::TpBool:
+             return replayColumnRange<casacore::Bool>(tab, column, rows, cellSlicer, write);
+        case casacore::TpFloat:
+             return replayColumnRange<casacore::Float>(tab, column, rows, cellSlicer, write);
+        case casacore::TpDouble:
+             return replayColumnRange<casacore::Double>(tab, column, rows, cellSlicer, write);
+        case casacore::TpComplex:
+             return replayColumnRange<casacore::Complex>(tab, column, rows, cellSlicer, write);
+        case casacore::TpDComplex:
+             return replayColumnRange<casacore::DComplex>(tab, column, rows, cellSlicer, write);
+        default:
+             ASKAPTHROW(AskapError, "Column "<<column<<" of "<<tab.tableName()<<" has unsupported type");
+     };
+   }
+
+   /// @brief apply the path substitutions
+   /// @param[in] path recorded path
+   /// @return path to use for replay
+   std::string mapPath(const std::string &path) const
+   {
+     for (std::vector<std::pair<std::string, std::string> >::const_iterator ci = itsPathMap.begin();
+          ci != itsPathMap.end(); ++ci) {
+          if (path.compare(0, ci->first.size(), ci->first) == 0) {
+              return ci->second + path.substr(ci->first.size());
+          }
+     }
+     return path;
+   }
+
+   /// @brief obtain the table, opening it if necessary
+   /// @param[in] name recorded name of the table
+   /// @param[in] write if true, the table is reopened for writing
+   /// @return reference to the table
+   casacore::Table& table(const std::string &name, bool write)
+   {
+     std::map<std::string, casacore::Table>::iterator it = itsTables.find(name);
+     if (it == itsTables.end()) {
+         const std::string path = mapPath(name);
+         ASKAPLOG_INFO_STR(logger, "Opening table "<<path);
+         it = itsTables.insert(std::make_pair(name, casacore::Table(path))).first;
+     }
+     if (write && !it->second.isWritable()) {
+         it->second.reopenRW();
+     }
+     return it->second;
+   }
+
+   /// @brief obtain image accessor for the given format
+   /// @param[in] format image format (casa or fits)
+   /// @return reference to the accessor
+   IImageAccess<casacore::Float>& imageAccessor(const std::string &format)
+   {
+     boost::shared_ptr<IImageAccess<casacore::Float> > &acc = itsImageAccessors[format];
+     if (!acc) {
+         if (format == "casa") {
+             acc.reset(new CasaImageAccess<casacore::Float>());
+         } else if (format == "fits") {
+             acc.reset(new FitsImageAccess());
+         } else {
+             ASKAPTHROW(AskapError, "Unsupported image format "<<format<<" in the I/O trace");
+         }
+     }
+     return *acc;
+   }
+
+   std::string getVersion() const override {
+      const std::string pkgVersion = std::string("base-accessor:") + ASKAP_PACKAGE_VERSION;
+      return pkgVersion;
+   }
+
+   /// @brief prefix substitutions
+   std::vector<std::pair<std::string, std::string> > itsPathMap;
+
+   /// @brief true, if writes are skipped
+   bool itsReadOnly = false;
+
+   /// @brief tables opened so far
+   std::map<std::string, casacore::Table> itsTables;
+
+   /// @brief image accessors for each format
+   std::map<std::string, boost::shared_ptr<IImageAccess<casacore::Float> > > itsImageAccessors;
+
+   /// @brief statistics for each type of events
+   std::map<IORecorder::EventType, Summary> itsSummary;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+int main(int argc, char *argv[])
+{
+    askap::accessors::ReplayIOTraceApp app;
+    return app.main(argc, argv);
+}
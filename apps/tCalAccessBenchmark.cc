@@ -0,0 +1,330 @@
+//
+// @file tCalAccessBenchmark.cc : benchmark of the calibration solution access
+//                        backends supported by CalibAccessFactory
+//
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/calibaccess/CalibAccessFactory.h>
+#include <askap/calibaccess/ICalSolutionSource.h>
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/TableCalSolutionSource.h>
+#include <askap/calibaccess/BinaryCalSolutionConstSource.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+ASKAP_LOGGER(logger, ".tCalAccessBenchmark");
+
+#include <askap/askap/AskapError.h>
+#include <Common/ParameterSet.h>
+
+// casa
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/tables/Tables/Table.h>
+
+// std
+#include <stdexcept>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+
+// boost
+#include <boost/shared_ptr.hpp>
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using namespace askap;
+using namespace accessors;
+
+/// @brief dimensions of the solution used for the benchmark
+struct Dimensions {
+   casa::uInt nAnt;
+   casa::uInt nBeam;
+   casa::uInt nChan;
+   casa::uInt nSolutions;
+};
+
+/// @brief resident memory of this process
+/// @return resident set size in kB (zero if it can't be determined)
+long residentMemory()
+{
+   std::ifstream is("/proc/self/status");
+   std::string line;
+   while (std::getline(is, line)) {
+          if (line.compare(0, 6, "VmRSS:") == 0) {
+              std::istringstream iss(line.substr(6));
+              long result = 0;
+              iss >> result;
+              return result;
+          }
+   }
+   return 0;
+}
+
+/// @brief print one line of the report
+/// @param[in] backend name of the backend
+/// @param[in] what name of the measured quantity
+/// @param[in] value measured value
+/// @param[in] units units of the value
+void report(const std::string &backend, const std::string &what, double value, const std::string &units)
+{
+   cout<<std::setw(14)<<std::left<<backend<<std::setw(28)<<what<<std::setw(14)<<std::right<<
+         std::setprecision(6)<<value<<" "<<units<<endl;
+}
+
+/// @brief write solutions with all gains and bandpasses defined
+/// @param[in] src solution source to write
+/// @param[in] dims dimensions of the solution
+/// @param[in] nSolutions number of solutions to write
+void writeSolutions(ICalSolutionSource &src, const Dimensions &dims, const casa::uInt nSolutions)
+{
+   for (casa::uInt sol = 0; sol < nSolutions; ++sol) {
+        const long id = src.newSolutionID(60. * sol);
+        boost::shared_ptr<ICalSolutionAccessor> acc = src.rwSolution(id);
+        ASKAPASSERT(acc);
+        for (casa::uInt beam = 0; beam < dims.nBeam; ++beam) {
+             for (casa::uInt ant = 0; ant < dims.nAnt; ++ant) {
+                  const JonesIndex index(ant, beam);
+                  const casa::Complex gain(1. + 0.01 * ant, 0.1 * beam + 0.001 * sol);
+                  acc->setGain(index, JonesJTerm(gain, true, casa::conj(gain), true));
+                  acc->setLeakage(index, JonesDTerm(casa::Float(0.01) * gain, true, casa::Float(-0.01) * gain, true));
+                  for (casa::uInt chan = 0; chan < dims.nChan; ++chan) {
+                       const casa::Complex bp(1., 1e-4 * chan);
+                       acc->setBandpass(index, JonesJTerm(bp, true, bp, chan % 10 != 0), chan);
+                  }
+             }
+        }
+        // write back and flush happen here
+        acc.reset();
+   }
+}
+
+/// @brief measure read performance of the given backend
+/// @param[in] backend name of the backend (for the report)
+/// @param[in] parset parset to pass to the factory
+/// @param[in] dims dimensions of the solution
+void readBenchmark(const std::string &backend, const LOFAR::ParameterSet &parset, const Dimensions &dims)
+{
+   casa::Timer timer;
+   const long memBefore = residentMemory();
+   timer.mark();
+   const boost::shared_ptr<ICalSolutionConstSource> src = CalibAccessFactory::roCalSolutionSource(parset);
+   ASKAPASSERT(src);
+   const boost::shared_ptr<ICalSolutionConstAccessor> acc = src->roSolution(src->mostRecentSolution());
+   ASKAPASSERT(acc);
+   // the first access normally triggers the actual read
+   acc->gain(JonesIndex(0u,0u));
+   acc->bandpass(JonesIndex(0u,0u), 0);
+   report(backend, "load", timer.real(), "s");
+
+   // element-wise access, the sum prevents the compiler from optimising the loop away
+   casa::Complex sum(0.,0.);
+   const double nElements = double(dims.nAnt) * dims.nBeam * dims.nChan;
+   timer.mark();
+   for (casa::uInt beam = 0; beam < dims.nBeam; ++beam) {
+        for (casa::uInt ant = 0; ant < dims.nAnt; ++ant) {
+             const JonesIndex index(ant, beam);
+             for (casa::uInt chan = 0; chan < dims.nChan; ++chan) {
+                  sum += acc->bandpass(index, chan).g1();
+             }
+        }
+   }
+   report(backend, "bandpass per element", nElements / timer.real() / 1e6, "Melem/s");
+
+   timer.mark();
+   casa::uInt nValid = 0;
+   for (casa::uInt beam = 0; beam < dims.nBeam; ++beam) {
+        for (casa::uInt ant = 0; ant < dims.nAnt; ++ant) {
+             for (casa::uInt chan = 0; chan < dims.nChan; ++chan) {
+                  if (acc->jonesAllValid(ant, beam, chan)) {
+                      ++nValid;
+                  }
+                  sum += acc->jones(ant, beam, chan)(0,0);
+             }
+        }
+   }
+   report(backend, "jones and validity", nElements / timer.real() / 1e6, "Melem/s");
+
+   // inlined access via the view is only available if the backend uses the in-memory cache
+   const boost::shared_ptr<MemCalSolutionAccessor const> memAcc =
+         boost::dynamic_pointer_cast<MemCalSolutionAccessor const>(acc);
+   if (memAcc) {
+       timer.mark();
+       const MemCalSolutionAccessor::BandpassView bpView = memAcc->bandpassView();
+       ASKAPCHECK((bpView.nAnt() >= dims.nAnt) && (bpView.nBeam() >= dims.nBeam) && (bpView.nChan() >= dims.nChan),
+                  "Bandpass cache is smaller than the benchmark dimensions");
+       for (casa::uInt beam = 0; beam < dims.nBeam; ++beam) {
+            for (casa::uInt ant = 0; ant < dims.nAnt; ++ant) {
+                 for (casa::uInt chan = 0; chan < dims.nChan; ++chan) {
+                      sum += bpView.value(0, ant, beam, chan);
+                 }
+            }
+       }
+       report(backend, "bandpass view", nElements / timer.real() / 1e6, "Melem/s");
+   }
+
+   casa::Matrix<casa::Complex> values;
+   casa::Matrix<casa::Bool> valid;
+   timer.mark();
+   for (casa::uInt beam = 0; beam < dims.nBeam; ++beam) {
+        acc->bandpassForBeam(beam, dims.nAnt, 0, dims.nChan, values, valid);
+        sum += values(0,0);
+   }
+   report(backend, "bandpass bulk", nElements / timer.real() / 1e6, "Melem/s");
+   report(backend, "memory footprint", double(residentMemory() - memBefore) / 1024., "MB");
+   ASKAPLOG_DEBUG_STR(logger, backend<<": checksum="<<sum<<" valid="<<nValid);
+}
+
+/// @brief remove the given file if it exists
+/// @param[in] fname file name
+void removeFile(const std::string &fname)
+{
+   casa::File file(fname);
+   if (file.exists() && file.isRegular()) {
+       casa::RegularFile(fname).remove();
+   }
+}
+
+/// @brief run the benchmark for all backends
+/// @param[in] dims dimensions of the solution
+void doBenchmark(const Dimensions &dims)
+{
+   casa::Timer timer;
+   cout<<"Solution with "<<dims.nAnt<<" antennas, "<<dims.nBeam<<" beams and "<<dims.nChan<<" channels"<<endl;
+
+   // parset-based implementation keeps just one solution
+   {
+     const std::string fname("tCalAccessBenchmark.parset");
+     removeFile(fname);
+     LOFAR::ParameterSet parset;
+     parset.add("calibaccess", "parset");
+     parset.add("calibaccess.parset", fname);
+     timer.mark();
+     {
+       const boost::shared_ptr<ICalSolutionSource> src = CalibAccessFactory::rwCalSolutionSource(parset);
+       writeSolutions(*src, dims, 1);
+     }
+     report("parset", "write (1 solution)", timer.real(), "s");
+     readBenchmark("parset", parset, dims);
+   }
+
+   // table-based implementation
+   const std::string tabName("tCalAccessBenchmark.tab");
+   {
+     LOFAR::ParameterSet parset;
+     parset.add("calibaccess", "table");
+     parset.add("calibaccess.table", tabName);
+     std::ostringstream os;
+     os<<dims.nAnt;
+     parset.add("calibaccess.table.maxant", os.str());
+     os.str("");
+     os<<dims.nBeam;
+     parset.add("calibaccess.table.maxbeam", os.str());
+     os.str("");
+     os<<dims.nChan;
+     parset.add("calibaccess.table.maxchan", os.str());
+     timer.mark();
+     {
+       const boost::shared_ptr<ICalSolutionSource> src = CalibAccessFactory::rwCalSolutionSource(parset);
+       writeSolutions(*src, dims, dims.nSolutions);
+     }
+     std::ostringstream what;
+     what<<"write ("<<dims.nSolutions<<" solutions)";
+     report("table", what.str(), timer.real(), "s");
+     readBenchmark("table", parset, dims);
+
+     // the same table read via shared memory
+     parset.add("calibaccess.table.shared", "true");
+     readBenchmark("table.shared", parset, dims);
+   }
+
+   // memory-mapped binary file converted from the table
+   {
+     const std::string fname("tCalAccessBenchmark.bin");
+     timer.mark();
+     BinaryCalSolutionConstSource::convertTable(casa::Table(tabName), fname);
+     report("binary", "convert from table", timer.real(), "s");
+     LOFAR::ParameterSet parset;
+     parset.add("calibaccess", "binary");
+     parset.add("calibaccess.binary", fname);
+     readBenchmark("binary", parset, dims);
+   }
+
+   // service stub is not connected to the actual service and may not be able to deliver a solution
+   try {
+     LOFAR::ParameterSet parset;
+     parset.add("calibaccess", "service");
+     readBenchmark("service", parset, dims);
+   }
+   catch (const AskapError &ae) {
+     cout<<"service: not available ("<<ae.what()<<")"<<endl;
+   }
+}
+
+int main(int argc, char **argv) {
+  try {
+     if ((argc != 1) && (argc != 4) && (argc != 5)) {
+         cerr<<"Usage "<<argv[0]<<" [nAnt nBeam nChan [nSolutions]]"<<endl;
+         return -2;
+     }
+     Dimensions dims;
+     dims.nAnt = 36;
+     dims.nBeam = 36;
+     dims.nChan = 288;
+     dims.nSolutions = 4;
+     if (argc > 1) {
+         dims.nAnt = casa::uInt(atoi(argv[1]));
+         dims.nBeam = casa::uInt(atoi(argv[2]));
+         dims.nChan = casa::uInt(atoi(argv[3]));
+         ASKAPCHECK((dims.nAnt > 0) && (dims.nBeam > 0) && (dims.nChan > 0), "Dimensions should be positive");
+     }
+     if (argc > 4) {
+         dims.nSolutions = casa::uInt(atoi(argv[4]));
+         ASKAPCHECK(dims.nSolutions > 0, "At least one solution is required");
+     }
+     doBenchmark(dims);
+  }
+  catch(const AskapError &ce) {
+     cerr<<"AskapError has been caught. "<<ce.what()<<endl;
+     return -1;
+  }
+  catch(const std::exception &ex) {
+     cerr<<"std::exception has been caught. "<<ex.what()<<endl;
+     return -1;
+  }
+  catch(...) {
+     cerr<<"An unexpected exception has been caught"<<endl;
+     return -1;
+  }
+  return 0;
+}
@@ -39,6 +39,7 @@ ASKAP_LOGGER(logger, ".tDataAccess");
 
 #include <askap/dataaccess/TableManager.h>
 #include <askap/dataaccess/IDataConverterImpl.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
 
 // casa
 #include <casacore/measures/Measures/MFrequency.h>
@@ -161,6 +162,8 @@ int main(int argc, char **argv) {
      doReadOnlyTest(ds);
      //doReadWriteTest(ds);    
      std::cerr<<"Job: "<<timer.real()<<std::endl;
+     // summary is only available if ASKAP_DATAACCESS_STATISTICS is set in the environment
+     DataAccessStatistics::log();
      
   }
   catch(const AskapError &ce) {
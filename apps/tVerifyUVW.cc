@@ -1,7 +1,9 @@
 //
 // @file tVerifyUVW.cc : read UVWs from the given measurement set via the 
 //                       standard accessor interface, check them vs. predicted
-//                       values given times, array layout and phasing info
+//                       values given times, array layout and phasing info.
+//                       The data are split by time between MPI ranks (if run
+//                       under MPI) and worker threads of each rank.
 //
 /// @copyright (c) 2007 CSIRO
 /// Australia Telescope National Facility (ATNF)
@@ -34,11 +36,23 @@
 ASKAP_LOGGER(logger, ".tVerifyUVW");
 
 #include <askap/askap/AskapError.h>
+#include <askap/askap/AskapUtil.h>
 #include <askap/dataaccess/SharedIter.h>
 #include <askap/dataaccess/ParsetInterface.h>
 
 #include <askap/dataaccess/TableManager.h>
 #include <askap/dataaccess/IDataConverterImpl.h>
+#include <askap/dataaccess/TableDataSelector.h>
+#include <askap/dataaccess/TablePartitionPlan.h>
+#include <askap/dataaccess/BatchDirectionConverter.h>
+#include <askap/askapparallel/AskapParallel.h>
+
+// LOFAR
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
 
 // casa
 #include <casacore/measures/Measures/MFrequency.h>
@@ -46,35 +60,163 @@ ASKAP_LOGGER(logger, ".tVerifyUVW");
 #include <casacore/casa/OS/Timer.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/measures/Measures/UVWMachine.h>
 
 // boost
 #include <boost/noncopyable.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
+#include <boost/accumulators/statistics/count.hpp>
+#include <boost/accumulators/statistics/sum.hpp>
 #include <boost/accumulators/statistics/min.hpp>
 #include <boost/accumulators/statistics/max.hpp>
 
 // std
 #include <stdexcept>
+#include <exception>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <fstream>
+#include <limits>
+#include <algorithm>
+#include <vector>
+#include <map>
 
 using namespace askap;
 using namespace accessors;
 using namespace boost::accumulators;
 
+/// @brief accumulator used for statistics of a single accessor
+typedef accumulator_set<double, features<tag::count, tag::sum, tag::min, tag::max> > StatAccumulator;
+
+/// @brief statistics of a single quantity which can be merged
+/// @details boost accumulators cannot be merged, so the statistics accumulated for
+/// individual accessors are folded into this structure, which can be combined across
+/// threads and ranks.
+struct MergeableStatistics {
+    MergeableStatistics() : itsCount(0), itsSum(0.), itsMin(std::numeric_limits<double>::max()),
+                            itsMax(-std::numeric_limits<double>::max()) {}
+
+    /// @brief add statistics of an accessor
+    /// @param[in] acc accumulator to take the statistics from
+    void add(const StatAccumulator &acc) {
+       if (count(acc) > 0) {
+           itsCount += count(acc);
+           itsSum += sum(acc);
+           itsMin = std::min(itsMin, min(acc));
+           itsMax = std::max(itsMax, max(acc));
+       }
+    }
+
+    /// @brief merge statistics of another worker
+    /// @param[in] other statistics to merge
+    void merge(const MergeableStatistics &other) {
+       if (other.itsCount > 0) {
+           itsCount += other.itsCount;
+           itsSum += other.itsSum;
+           itsMin = std::min(itsMin, other.itsMin);
+           itsMax = std::max(itsMax, other.itsMax);
+       }
+    }
+
+    /// @return mean value
+    double mean() const { return itsCount > 0 ? itsSum / itsCount : 0.; }
+
+    /// @brief number of values
+    LOFAR::uint64 itsCount;
+    /// @brief sum of values
+    double itsSum;
+    /// @brief minimum value
+    double itsMin;
+    /// @brief maximum value
+    double itsMax;
+};
+
+/// @brief serialise statistics
+/// @param[in] os output stream
+/// @param[in] stats statistics to serialise
+LOFAR::BlobOStream& operator<<(LOFAR::BlobOStream &os, const MergeableStatistics &stats)
+{
+  os<<stats.itsCount<<stats.itsSum<<stats.itsMin<<stats.itsMax;
+  return os;
+}
+
+/// @brief deserialise statistics
+/// @param[in] is input stream
+/// @param[out] stats statistics to fill
+LOFAR::BlobIStream& operator>>(LOFAR::BlobIStream &is, MergeableStatistics &stats)
+{
+  is>>stats.itsCount>>stats.itsSum>>stats.itsMin>>stats.itsMax;
+  return is;
+}
+
+/// @brief summary of the UVW comparison done by one or more workers
+struct UVWStatistics {
+    UVWStatistics() : itsNAccessors(0), itsNZeroBaselines(0) {}
+
+    /// @brief merge statistics of another worker
+    /// @param[in] other statistics to merge
+    void merge(const UVWStatistics &other) {
+       itsNAccessors += other.itsNAccessors;
+       itsNZeroBaselines += other.itsNZeroBaselines;
+       itsStretch.merge(other.itsStretch);
+       itsAngle.merge(other.itsAngle);
+    }
+
+    /// @brief serialise statistics
+    /// @param[in] os output stream
+    void write(LOFAR::BlobOStream &os) const {
+       os.putStart("UVWStatistics", 1);
+       os<<itsNAccessors<<itsNZeroBaselines<<itsStretch<<itsAngle;
+       os.putEnd();
+    }
+
+    /// @brief deserialise statistics
+    /// @param[in] is input stream
+    void read(LOFAR::BlobIStream &is) {
+       const int version = is.getStart("UVWStatistics");
+       ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the serialised UVW statistics");
+       is>>itsNAccessors>>itsNZeroBaselines>>itsStretch>>itsAngle;
+       is.getEnd();
+    }
+
+    /// @brief number of accessors processed
+    LOFAR::uint64 itsNAccessors;
+    /// @brief number of unflagged rows skipped because of zero baseline length
+    LOFAR::uint64 itsNZeroBaselines;
+    /// @brief relative stretch minus 1
+    MergeableStatistics itsStretch;
+    /// @brief angle between measured and predicted UVWs in degrees
+    MergeableStatistics itsAngle;
+};
+
 class UVWChecker : public boost::noncopyable {
 public:
     /// @brief constructor
-    /// @param[in] ds table data source to work with
+    /// @details The data are split by time into comms.nProcs() * nThreads parts, this process
+    /// gets nThreads consecutive parts. This is a collective operation, the partition plan is
+    /// worked out by the master and sent to all other ranks.
+    /// @param[in] ds table data source to work with (should be in the concurrent-read mode
+    ///            if more than one thread is used)
+    /// @param[in] msName name of the measurement set used by ds (read by the master to work out the plan)
+    /// @param[in] comms communication object
+    /// @param[in] nThreads number of worker threads of this process
     /// @param[in] verbose if true, more details are printed in the log
     /// @note other constructors can be written later (i.e. for some streaming applications which cannot access table-specific info)
-    explicit UVWChecker(const TableConstDataSource &ds, bool verbose = false);
+    UVWChecker(const TableConstDataSource &ds, const std::string &msName, askapparallel::AskapParallel &comms,
+               casacore::uInt nThreads, bool verbose = false);
 
     /// @brief iterate over the data - main entry point
-    void run();
+    /// @details Parts of the data given to this process are processed in parallel.
+    /// @return statistics merged across the threads of this process
+    UVWStatistics run() const;
 
     /// @brief method predicting UVWs for the given accessor
     /// @details For each row a UVW vector is calculated
@@ -83,9 +225,24 @@ public:
     casacore::Vector<casacore::RigidVector<casacore::Double, 3> > simulateUVW(const IConstDataAccessor &acc) const;
 
 private:
+    /// @brief process one part of the data
+    /// @details This is the body of a worker thread
+    /// @param[in] it iterator over the part
+    /// @param[out] stats statistics of this part
+    /// @param[out] error exception encountered, if any
+    void processPart(IConstDataSharedIter it, UVWStatistics &stats, std::exception_ptr &error) const;
+
+    /// @brief compare measured and predicted UVWs for the given accessor
+    /// @param[in] acc accessor to work with
+    /// @param[in,out] stats statistics to update
+    void checkAccessor(const IConstDataAccessor &acc, UVWStatistics &stats) const;
+
     /// @brief const reference data source - it is set in the constructor only
     const IConstDataSource& itsDataSource;
 
+    /// @brief selectors of the parts given to this process
+    std::vector<IDataSelectorPtr> itsSelectors;
+
     /// @brief buffer with antenna positions
     std::vector<casacore::MPosition> itsLayout;
 
@@ -97,10 +254,19 @@ private:
 };
 
 /// @brief constructor
-/// @param[in] ds table data source to work with
+/// @details The data are split by time into comms.nProcs() * nThreads parts, this process
+/// gets nThreads consecutive parts. This is a collective operation, the partition plan is
+/// worked out by the master and sent to all other ranks.
+/// @param[in] ds table data source to work with (should be in the concurrent-read mode
+///            if more than one thread is used)
+/// @param[in] msName name of the measurement set used by ds (read by the master to work out the plan)
+/// @param[in] comms communication object
+/// @param[in] nThreads number of worker threads of this process
 /// @param[in] verbose if true, more details are printed in the log
-UVWChecker::UVWChecker(const TableConstDataSource &ds, bool verbose) : itsDataSource(ds), itsRefMJD(59000.), itsVerbose(verbose)
+UVWChecker::UVWChecker(const TableConstDataSource &ds, const std::string &msName, askapparallel::AskapParallel &comms,
+                       casacore::uInt nThreads, bool verbose) : itsDataSource(ds), itsRefMJD(59000.), itsVerbose(verbose)
 {
+   ASKAPCHECK(nThreads > 0, "At least one thread is required");
    // all operations specific to the table-based accessor are confined to this constructor
    // the rest of the work can proceed through the general interface (hence the type of 
    // itsDataSource in this class w.r.t. the type of ds)
@@ -109,68 +275,157 @@ UVWChecker::UVWChecker(const TableConstDataSource &ds, bool verbose) : itsDataSo
    for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
         itsLayout.push_back(ds.getAntennaPosition(ant));
    }
+
+   // partition plan, the same for all ranks
+   TablePartitionPlan plan;
+   if (comms.isMaster()) {
+       plan = TablePartitionPlan(casacore::Table(msName), TablePartitionPlan::TIME, static_cast<casacore::uInt>(comms.nProcs()) * nThreads);
+   }
+   if (comms.isParallel()) {
+       LOFAR::BlobString bs;
+       bs.resize(0);
+       if (comms.isMaster()) {
+           LOFAR::BlobOBufString bob(bs);
+           LOFAR::BlobOStream out(bob);
+           plan.write(out);
+           for (int rank = 1; rank < comms.nProcs(); ++rank) {
+                comms.sendBlob(bs, rank);
+           }
+       } else {
+           comms.receiveBlob(bs, 0);
+           LOFAR::BlobIBufString bib(bs);
+           LOFAR::BlobIStream in(bib);
+           plan.read(in);
+       }
+   }
+   for (casacore::uInt thread = 0; thread < nThreads; ++thread) {
+        const casacore::uInt part = static_cast<casacore::uInt>(comms.rank()) * nThreads + thread;
+        ASKAPDEBUGASSERT(part < plan.nParts());
+        if (plan.weight(part) == 0) {
+            // there are fewer time stamps than parts
+            continue;
+        }
+        const IDataSelectorPtr sel = ds.createSelector();
+        const boost::shared_ptr<TableDataSelector> tabSel = boost::dynamic_pointer_cast<TableDataSelector>(sel);
+        ASKAPDEBUGASSERT(tabSel);
+        plan.apply(part, *tabSel);
+        sel->chooseCrossCorrelations();
+        itsSelectors.push_back(sel);
+        ASKAPLOG_DEBUG_STR(logger, "Part "<<part<<" has "<<plan.weight(part)<<" row(s)");
+   }
 }
 
-void UVWChecker::run() {
-  IDataSelectorPtr sel=itsDataSource.createSelector();
+/// @brief iterate over the data - main entry point
+/// @details Parts of the data given to this process are processed in parallel.
+/// @return statistics merged across the threads of this process
+UVWStatistics UVWChecker::run() const {
   IDataConverterPtr conv=itsDataSource.createConverter();  
   conv->setFrequencyFrame(casacore::MFrequency::Ref(casacore::MFrequency::TOPO),"MHz");
   conv->setEpochFrame(casacore::MEpoch(casacore::Quantity(itsRefMJD,"d"),
                       casacore::MEpoch::Ref(casacore::MEpoch::UTC)),"s");
   conv->setDirectionFrame(casacore::MDirection::Ref(casacore::MDirection::J2000)); 
 
-  sel->chooseCrossCorrelations();
-    
-  for (IConstDataSharedIter it=itsDataSource.createConstIterator(sel,conv);it!=it.end();++it) {  
-       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > testUVWs = simulateUVW(*it);
-       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > measUVWs = it->uvw();
-       ASKAPDEBUGASSERT(testUVWs.nelements() == measUVWs.nelements());
-
-       const casacore::MEpoch epoch(casacore::Quantity(it->time()/86400. + itsRefMJD,"d"), casacore::MEpoch::Ref(casacore::MEpoch::UTC));
-
-       bool epochPrinted = false;
-       accumulator_set<double, features<tag::min, tag::max> > angleStats;
-       accumulator_set<double, features<tag::min, tag::max> > stretchStats;
-
-       const casacore::Cube<casacore::Bool>& flags = it->flag();
-       bool hasUnflaggedData = false;
-       for (casacore::uInt row = 0; row < it->nRow(); ++row) {
-            if (!casacore::allTrue(flags.yzPlane(row))) {
-                // this row has unflagged data, UVWs should be good
-                hasUnflaggedData = true;
-                const casacore::RigidVector<casacore::Double, 3> testUVW = testUVWs[row];
-                const casacore::RigidVector<casacore::Double, 3> measUVW = measUVWs[row];
-                const double simBslnLength = casacore::sqrt(testUVW * testUVW);
-                if (simBslnLength < 1e-6) {
-                    ASKAPLOG_WARN_STR(logger, "Encountered zero baseline length for a cross-correlation with unflagged data, antenna ids: "<<
-                                      it->antenna1()[row]<<" "<<it->antenna2()[row]<<" beam: "<<it->feed1()[row]<<" epoch: "<<epoch);
-                    continue;
-                }
-                const double measBslnLength = casacore::sqrt(measUVW * measUVW);
-                const double cosAngle = simBslnLength > 0. && measBslnLength > 0. ? testUVW * measUVW / (simBslnLength * measBslnLength): 0.;
-                ASKAPASSERT(cosAngle <= 1. && cosAngle >= -1.);
-                const casacore::RigidVector<casacore::Double, 3> diffUVW = measUVW - testUVW;
-                const double diffLength = casacore::sqrt(diffUVW * diffUVW);
-                // relative stretch minus 1. (i.e. 0 is the perfect match)
-                const double stretch = simBslnLength > 0. ? measBslnLength / simBslnLength - 1. : 0.;
-                // angle between two UVW vectors in degrees
-                const double angle = casacore::acos(cosAngle) / casacore::C::pi * 180.;
-                if (itsVerbose) {
-                    if (!epochPrinted) {
-                        ASKAPLOG_INFO_STR(logger, "UVW comparison for "<<epoch);
-                        epochPrinted = true;
-                    }
-                    ASKAPLOG_INFO_STR(logger, " "<<it->antenna1()[row]<<" "<<it->antenna2()[row]<<" "<<it->feed1()[row]<<" "<<measUVW<<" "<<testUVW<<" "<<diffUVW<<" "<<diffLength<<" "<<stretch<<" "<<angle);
-                }
-                angleStats(angle);
-                stretchStats(stretch);
-            }
+  // iterators are created here, the worker threads only iterate
+  std::vector<IConstDataSharedIter> iters;
+  iters.reserve(itsSelectors.size());
+  for (size_t part = 0; part < itsSelectors.size(); ++part) {
+       iters.push_back(itsDataSource.createConstIterator(itsSelectors[part], conv));
+  }
+  std::vector<UVWStatistics> partStats(iters.size());
+  std::vector<std::exception_ptr> errors(iters.size());
+  if (iters.size() == 1) {
+      processPart(iters[0], partStats[0], errors[0]);
+  } else {
+      boost::thread_group workers;
+      for (size_t part = 0; part < iters.size(); ++part) {
+           workers.create_thread(boost::bind(&UVWChecker::processPart, this, iters[part], boost::ref(partStats[part]),
+                                 boost::ref(errors[part])));
+      }
+      workers.join_all();
+  }
+  UVWStatistics result;
+  for (size_t part = 0; part < iters.size(); ++part) {
+       if (errors[part]) {
+           std::rethrow_exception(errors[part]);
        }
-       if (hasUnflaggedData) {
-           ASKAPLOG_INFO_STR(logger, "For "<<epoch<<" UVW min/max stretch values are "<<min(stretchStats)<<" "<<max(stretchStats)<<
-                " min/max angles (deg) are "<<min(angleStats)<<" "<<max(angleStats));
+       result.merge(partStats[part]);
+  }
+  return result;
+}
+
+/// @brief process one part of the data
+/// @details This is the body of a worker thread
+/// @param[in] it iterator over the part
+/// @param[out] stats statistics of this part
+/// @param[out] error exception encountered, if any
+void UVWChecker::processPart(IConstDataSharedIter it, UVWStatistics &stats, std::exception_ptr &error) const
+{
+  try {
+     for (; it != it.end(); ++it) {
+          checkAccessor(*it, stats);
+     }
+  }
+  catch (...) {
+     error = std::current_exception();
+  }
+}
+
+/// @brief compare measured and predicted UVWs for the given accessor
+/// @param[in] acc accessor to work with
+/// @param[in,out] stats statistics to update
+void UVWChecker::checkAccessor(const IConstDataAccessor &acc, UVWStatistics &stats) const
+{
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > testUVWs = simulateUVW(acc);
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > measUVWs = acc.uvw();
+  ASKAPDEBUGASSERT(testUVWs.nelements() == measUVWs.nelements());
+
+  const casacore::MEpoch epoch(casacore::Quantity(acc.time()/86400. + itsRefMJD,"d"), casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+
+  // verbose output is logged in one go, so lines of different threads are not mixed
+  std::ostringstream details;
+  StatAccumulator angleStats;
+  StatAccumulator stretchStats;
+
+  const casacore::Cube<casacore::Bool>& flags = acc.flag();
+  for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+       if (!casacore::allTrue(flags.yzPlane(row))) {
+           // this row has unflagged data, UVWs should be good
+           const casacore::RigidVector<casacore::Double, 3> testUVW = testUVWs[row];
+           const casacore::RigidVector<casacore::Double, 3> measUVW = measUVWs[row];
+           const double simBslnLength = casacore::sqrt(testUVW * testUVW);
+           if (simBslnLength < 1e-6) {
+               ASKAPLOG_WARN_STR(logger, "Encountered zero baseline length for a cross-correlation with unflagged data, antenna ids: "<<
+                                 acc.antenna1()[row]<<" "<<acc.antenna2()[row]<<" beam: "<<acc.feed1()[row]<<" epoch: "<<epoch);
+               ++stats.itsNZeroBaselines;
+               continue;
+           }
+           const double measBslnLength = casacore::sqrt(measUVW * measUVW);
+           const double cosAngle = simBslnLength > 0. && measBslnLength > 0. ? testUVW * measUVW / (simBslnLength * measBslnLength): 0.;
+           ASKAPASSERT(cosAngle <= 1. && cosAngle >= -1.);
+           const casacore::RigidVector<casacore::Double, 3> diffUVW = measUVW - testUVW;
+           const double diffLength = casacore::sqrt(diffUVW * diffUVW);
+           // relative stretch minus 1. (i.e. 0 is the perfect match)
+           const double stretch = simBslnLength > 0. ? measBslnLength / simBslnLength - 1. : 0.;
+           // angle between two UVW vectors in degrees
+           const double angle = casacore::acos(cosAngle) / casacore::C::pi * 180.;
+           if (itsVerbose) {
+               details<<std::endl<<" "<<acc.antenna1()[row]<<" "<<acc.antenna2()[row]<<" "<<acc.feed1()[row]<<" "<<measUVW<<" "<<
+                        testUVW<<" "<<diffUVW<<" "<<diffLength<<" "<<stretch<<" "<<angle;
+           }
+           angleStats(angle);
+           stretchStats(stretch);
        }
   }
+  if (count(angleStats) > 0) {
+      if (itsVerbose) {
+          ASKAPLOG_INFO_STR(logger, "UVW comparison for "<<epoch<<details.str());
+      }
+      ASKAPLOG_INFO_STR(logger, "For "<<epoch<<" UVW min/max stretch values are "<<min(stretchStats)<<" "<<max(stretchStats)<<
+           " min/max angles (deg) are "<<min(angleStats)<<" "<<max(angleStats));
+  }
+  ++stats.itsNAccessors;
+  stats.itsStretch.add(stretchStats);
+  stats.itsAngle.add(angleStats);
 }
 
 /// @brief method predicting UVWs for the given accessor
@@ -211,37 +466,56 @@ casacore::Vector<casacore::RigidVector<casacore::Double, 3> > UVWChecker::simula
    const casacore::MEpoch epoch(casacore::Quantity(acc.time()/86400. + itsRefMJD,"d"), casacore::MEpoch::Ref(casacore::MEpoch::UTC));
 
    const casacore::uInt nBeams = static_cast<casacore::uInt>(phaseCentres.size());
+   const casacore::Vector<casacore::MVDirection> phaseCentreVector(phaseCentres);
+   const casacore::MDirection::Ref j2000(casacore::MDirection::J2000);
+
+   // uvw rotation into J2000 for each beam. The transformation done by the uvw machine
+   // is linear, so the matrix is obtained by converting the unit vectors once per beam
+   // and applied to all rows of that beam afterwards.
+   // HADEC frame doesn't seem to work correctly with UVW machine, even apart from inversion of the first coordinate
+   // However, it is required for phasing model/UVW itself 
+   // For details see ADESCOM-342.
+   casacore::Cube<double> rotations(3, 3, nBeams, 0.);
+   {
+     const casa::MeasFrame frame(epoch, itsLayout[0]);
+     BatchDirectionConverter topoConverter((casacore::MDirection::Ref(casacore::MDirection::TOPO)));
+     topoConverter.setEpoch(epoch);
+     topoConverter.setPosition(itsLayout[0]);
+     casacore::Vector<casacore::MVDirection> topoDirs;
+     topoConverter.convert(phaseCentreVector, j2000, topoDirs);
+     casacore::Vector<double> unitVector(3);
+     for (casa::uInt beam = 0; beam < nBeams; ++beam) {
+          // Current APP phase center
+          const casa::MDirection fpc(topoDirs[beam], casa::MDirection::Ref(casa::MDirection::TOPO, frame));
+          const casa::UVWMachine uvwMachine(j2000, fpc, frame);
+          for (casa::uInt col = 0; col < 3; ++col) {
+               unitVector.set(0.);
+               unitVector(col) = 1.;
+               uvwMachine.convertUVW(unitVector);
+               for (casa::uInt elem = 0; elem < 3; ++elem) {
+                    rotations(elem, col, beam) = unitVector(elem);
+               }
+          }
+     }
+   }
+
    // geocentric U and V per antenna/beam
    casa::Matrix<double> antUs(itsLayout.size(), nBeams, 0.);
    casa::Matrix<double> antVs(itsLayout.size(), nBeams, 0.);
    casa::Matrix<double> antWs(itsLayout.size(), nBeams, 0.);
-   std::vector<boost::shared_ptr<casacore::UVWMachine> > uvwMachines(nBeams);
+   BatchDirectionConverter hadecConverter((casacore::MDirection::Ref(casacore::MDirection::HADEC)));
+   hadecConverter.setEpoch(epoch);
+   casacore::Vector<casacore::MVDirection> hadecDirs;
    for (size_t ant = 0; ant < itsLayout.size(); ++ant) {
-        const casacore::MPosition antPos = itsLayout[ant];
-        const casa::MeasFrame frame(epoch, antPos);
+        const casacore::MPosition &antPos = itsLayout[ant];
         // antenna position in metres
         const casacore::Vector<casacore::Double> xyz = antPos.getValue().getValue();
+        hadecConverter.setPosition(antPos);
+        hadecConverter.convert(phaseCentreVector, j2000, hadecDirs);
         for (casa::uInt beam =0; beam < nBeams; ++beam) {
-             // Current APP phase center
-             const casa::MDirection fpc = casa::MDirection::Convert(phaseCentres[beam],
-                                   casa::MDirection::Ref(casa::MDirection::TOPO, frame))();
-             const casa::MDirection hadec = casa::MDirection::Convert(phaseCentres[beam],
-                                   casa::MDirection::Ref(casa::MDirection::HADEC, frame))();
-             if (ant == 0) {
-                 // for uvw rotation
-                 // HADEC frame doesn't seem to work correctly with UVW machine, even apart from inversion of the first coordinate
-                 // However, it is required for phasing model/UVW itself 
-                 // For details see ADESCOM-342.
-                 uvwMachines[beam].reset(new casa::UVWMachine(casa::MDirection::Ref(casa::MDirection::J2000), fpc, frame));
-                 /*
-                 if (beam == 0) {
-                     std::cout<<ant<<" "<<epoch<<" "<<antPos<<" "<<printDirection(fpc.getValue())<<" "<<printDirection(hadec.getValue())<<std::endl;
-                 }
-                 */
-             }
-             const double dec = hadec.getValue().getLat(); //fpc.getAngle().getValue()(1);
+             const double dec = hadecDirs[beam].getLat();
              // hour angle at latitude zero
-             const double H0 = hadec.getValue().getLong() - antPos.getValue().getLong();
+             const double H0 = hadecDirs[beam].getLong() - antPos.getValue().getLong();
 
              // Transformation from antenna position to the geocentric delay
              const double sH0 = sin(H0);
@@ -255,11 +529,7 @@ casacore::Vector<casacore::RigidVector<casacore::Double, 3> > UVWChecker::simula
    }
  
    // now everything is ready to compute the result for each baseline
-   // note, in principle, the code above can be moved to a separate method or methods
-   // something can be cached too, although when time changes recalculation will still need to happen, so probably
-   // not a huge overhead to do it the current way
    casacore::Vector<casacore::RigidVector<casacore::Double, 3> > result(acc.nRow());
-   casacore::Vector<double> uvwvec(3);
    for (casa::uInt row = 0; row < acc.nRow(); ++row) {
         const casa::uInt ant1 = acc.antenna1()[row];
         const casa::uInt ant2 = acc.antenna2()[row];
@@ -272,22 +542,47 @@ casacore::Vector<casacore::RigidVector<casacore::Double, 3> > UVWChecker::simula
         ASKAPASSERT(ant2 < itsLayout.size());
         ASKAPDEBUGASSERT(beam < nBeams);
 
-        uvwvec(0) = antUs(ant2, beam) - antUs(ant1, beam);
-        uvwvec(1) = antVs(ant2, beam) - antVs(ant1, beam);
-        uvwvec(2) = antWs(ant2, beam) - antWs(ant1, beam);
+        const double u = antUs(ant2, beam) - antUs(ant1, beam);
+        const double v = antVs(ant2, beam) - antVs(ant1, beam);
+        const double w = antWs(ant2, beam) - antWs(ant1, beam);
 
-        ASKAPDEBUGASSERT(beam < uvwMachines.size());
-        ASKAPDEBUGASSERT(uvwMachines[beam]);
         // uvw rotation into J2000
-        uvwMachines[beam]->convertUVW(uvwvec);
-        ASKAPDEBUGASSERT(uvwvec.nelements() == 3);
-        result[row] = uvwvec;
- 
+        for (casa::uInt elem = 0; elem < 3; ++elem) {
+             result[row](elem) = rotations(elem, 0, beam) * u + rotations(elem, 1, beam) * v + rotations(elem, 2, beam) * w;
+        }
    }
    return result;
 }
 
-// don't use the whole application harness for now, we don't need any parallelism or passing a parset
+/// @brief merge statistics of all ranks on the master
+/// @param[in] comms communication object
+/// @param[in,out] stats statistics of this rank, merged statistics on exit (master only)
+void gatherStatistics(askapparallel::AskapParallel &comms, UVWStatistics &stats)
+{
+  if (!comms.isParallel()) {
+      return;
+  }
+  LOFAR::BlobString bs;
+  if (comms.isMaster()) {
+      for (int rank = 1; rank < comms.nProcs(); ++rank) {
+           bs.resize(0);
+           comms.receiveBlob(bs, rank);
+           LOFAR::BlobIBufString bib(bs);
+           LOFAR::BlobIStream in(bib);
+           UVWStatistics rankStats;
+           rankStats.read(in);
+           stats.merge(rankStats);
+      }
+  } else {
+      bs.resize(0);
+      LOFAR::BlobOBufString bob(bs);
+      LOFAR::BlobOStream out(bob);
+      stats.write(out);
+      comms.sendBlob(bs, 0);
+  }
+}
+
+// don't use the whole application harness for now, we don't need passing a parset
 // like it is for the standard application
 int main(int argc, char **argv) {
   try {
@@ -308,24 +603,50 @@ int main(int argc, char **argv) {
             std::cerr<<"initialised for "<<ss.str().c_str()<<std::endl;
         }
      }
-     if (argc != 2 && argc !=3) {
-         std::cerr<<"Usage "<<argv[0]<<" [-v] measurement_set"<<std::endl;
-	 return -2;
+     // MPI is used if the application is started under mpirun, otherwise comms is serial
+     askapparallel::AskapParallel comms(argc, const_cast<const char**>(argv));
+
+     bool verbose = false;
+     casacore::uInt nThreads = std::max(1u, boost::thread::hardware_concurrency());
+     int arg = 1;
+     for (; arg + 1 < argc; ++arg) {
+          const std::string option(argv[arg]);
+          if (option == "-v") {
+              verbose = true;
+          } else if ((option == "-t") && (arg + 2 < argc)) {
+              nThreads = utility::fromString<casacore::uInt>(argv[++arg]);
+              ASKAPCHECK(nThreads > 0, "Number of threads should be positive");
+          } else {
+              break;
+          }
      }
-     const bool verbose = (argc == 3);
-     if (verbose) {
-         ASKAPCHECK(std::string("-v") == argv[1], "Incorrect first parameter, only -v is allowed");
+     if (arg + 1 != argc) {
+         std::cerr<<"Usage "<<argv[0]<<" [-v] [-t nThreads] measurement_set"<<std::endl;
+	 return -2;
      }
 
      casacore::Timer timer;
 
      timer.mark();
-     TableDataSource ds(verbose ? argv[2] : argv[1],TableDataSource::MEMORY_BUFFERS); 
-     UVWChecker checker(ds, verbose);
+     const std::string msName(argv[arg]);
+     TableDataSource ds(msName,TableDataSource::MEMORY_BUFFERS); 
+     ds.configureConcurrentRead(nThreads > 1);
+     UVWChecker checker(ds, msName, comms, nThreads, verbose);
      ASKAPLOG_DEBUG_STR(logger, "Initialization: "<<timer.real());
      timer.mark();
-     checker.run();
+     UVWStatistics stats = checker.run();
      ASKAPLOG_DEBUG_STR(logger,"Job: "<<timer.real());
+     gatherStatistics(comms, stats);
+     if (comms.isMaster()) {
+         ASKAPLOG_INFO_STR(logger, "Compared "<<stats.itsStretch.itsCount<<" row(s) in "<<stats.itsNAccessors<<
+              " accessor(s) using "<<comms.nProcs()<<" rank(s) x "<<nThreads<<" thread(s), "<<
+              stats.itsNZeroBaselines<<" row(s) with zero baseline length skipped");
+         if (stats.itsStretch.itsCount > 0) {
+             ASKAPLOG_INFO_STR(logger, "Overall UVW min/mean/max stretch values are "<<stats.itsStretch.itsMin<<" "<<
+                  stats.itsStretch.mean()<<" "<<stats.itsStretch.itsMax<<" min/mean/max angles (deg) are "<<
+                  stats.itsAngle.itsMin<<" "<<stats.itsAngle.mean()<<" "<<stats.itsAngle.itsMax);
+         }
+     }
   }
   catch(const AskapError &ce) {
      std::cerr<<"AskapError has been caught. "<<ce.what()<<std::endl;
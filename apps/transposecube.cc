@@ -0,0 +1,141 @@
+///
+/// @file transposecube.cc : tool to convert an image cube into the spectrum-major layout,
+///                          so spectra can be read contiguously by the downstream jobs
+///                          (e.g. extractslice or per-spectrum processing). The cube is
+///                          read in blocks of rows covering all planes, the blocks are
+///                          distributed between ranks. Collective FITS writes are used
+///                          if the output accessor is set up for them.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// std includes
+#include <string>
+
+// ASKAPSoft includes
+#include "askap_accessors.h"
+#include "askap/AskapLogging.h"
+#include "askap/AskapError.h"
+#include "askap/Application.h"
+#include "askap/StatReporter.h"
+#include "askapparallel/AskapParallel.h"
+#include "askap/imageaccess/ImageAccessFactory.h"
+#include "askap/imageaccess/CubeTransposer.h"
+
+ASKAP_LOGGER(logger, ".transposecube");
+
+// casa
+#include <casacore/casa/OS/Timer.h>
+
+// boost
+#include <boost/shared_ptr.hpp>
+
+/// 3rd party
+#include <Common/ParameterSet.h>
+
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief transposition application
+/// @details Parameters (no prefix):
+///   image         - name of the input cube
+///   outimage      - name of the output cube
+///   spectrumfirst - if true (default), the spectral axis becomes the 1st one, use false
+///                   to keep the axis order (e.g. for CASA output with output.imageaccesspattern = spectrum)
+///   blocksize     - maximum size of the block read at a time in MB (default 128)
+///   input.*       - parameters of the input image accessor (imagetype, etc)
+///   output.*      - parameters of the output image accessor, output.imageaccess = collective
+///                   enables collective writes of FITS images in the parallel mode
+class TransposeCubeApp : public askap::Application {
+public:
+   virtual int run(int argc, char* argv[])
+   {
+     // This class must have scope outside the main try/catch block
+     askap::askapparallel::AskapParallel comms(argc, const_cast<const char**>(argv));
+     try {
+        StatReporter stats;
+        casacore::Timer timer;
+        const std::string inName = config().getString("image");
+        ASKAPCHECK(inName != "", "Input cube name is not supposed to be empty");
+        const std::string outName = config().getString("outimage");
+        ASKAPCHECK(outName != "", "Output cube name is not supposed to be empty");
+        ASKAPCHECK(inName != outName, "The cube can't be transposed in place");
+
+        const boost::shared_ptr<IImageAccess<casacore::Float> > input =
+              imageAccessFactory(config().makeSubset("input."));
+        const boost::shared_ptr<IImageAccess<casacore::Float> > output =
+              imageAccessFactory(config().makeSubset("output."), comms);
+        CubeTransposer transposer(input, output);
+        transposer.setSpectrumFirst(config().getBool("spectrumfirst", true));
+        transposer.setMaxBlockSize(config().getUint("blocksize", 128) * 1024u * 1024u / sizeof(casacore::Float));
+        transposer.setRank(comms.rank(), comms.nProcs());
+
+        timer.mark();
+        transposer.createOutput(inName, outName);
+        // the output has to exist before other ranks start writing
+        comms.barrier();
+        ASKAPLOG_INFO_STR(logger, "Created " << outName << " in " << timer.real() << " seconds");
+
+        timer.mark();
+        transposer.transpose(inName, outName);
+        comms.barrier();
+        ASKAPLOG_INFO_STR(logger, "Completed transposition in " << timer.real() << " seconds");
+
+        if (comms.isMaster()) {
+            transposer.copyMetadata(inName, outName);
+        }
+        comms.barrier();
+        stats.logSummary();
+        return 0;
+     }
+     catch (const askap::AskapError& e) {
+        ASKAPLOG_FATAL_STR(logger, "Askap error in " << argv[0] << ": " << e.what());
+        std::cerr << "Askap error in " << argv[0] << ": " << e.what() << std::endl;
+        return 1;
+     } catch (const std::exception& e) {
+        ASKAPLOG_FATAL_STR(logger, "Unexpected exception in " << argv[0] << ": " << e.what());
+        std::cerr << "Unexpected exception in " << argv[0] << ": " << e.what()
+                  << std::endl;
+        return 1;
+     }
+   }
+private:
+
+   std::string getVersion() const override {
+      const std::string pkgVersion = std::string("base-accessor:") + ASKAP_PACKAGE_VERSION;
+      return pkgVersion;
+   }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+int main(int argc, char *argv[])
+{
+    askap::accessors::TransposeCubeApp app;
+    return app.main(argc, argv);
+}
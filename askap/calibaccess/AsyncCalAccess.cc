@@ -0,0 +1,60 @@
+/// @file
+///
+/// @brief Asynchronous access to calibration solutions
+/// @details The function executed by the I/O pool on behalf of roSolutionAsync.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/AsyncCalAccess.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief read the solution
+/// @details Accessors based on MemCalSolutionAccessor are filled at once, so the caller
+/// doesn't read the wrapped source when the values are accessed.
+/// @param[in] src solution source
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> readCalSolution(const boost::shared_ptr<ICalSolutionConstSource const> &src,
+                                                             const long id)
+{
+  ASKAPDEBUGASSERT(src);
+  const boost::shared_ptr<ICalSolutionConstAccessor> acc = src->roSolution(id);
+  ASKAPCHECK(acc, "Calibration solution source returned an empty accessor for solution "<<id);
+  const boost::shared_ptr<MemCalSolutionAccessor> memAcc = boost::dynamic_pointer_cast<MemCalSolutionAccessor>(acc);
+  if (memAcc) {
+      memAcc->prefetch();
+  }
+  return acc;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,83 @@
+/// @file
+///
+/// @brief Asynchronous access to calibration solutions
+/// @details ICalSolutionConstSource::roSolution blocks until the solution is read (which may
+/// involve reading a table or a network round trip). The functions defined here read the
+/// solution in a thread of the I/O pool (see IOThreadPool), so the solutions for many beams
+/// or sources can be requested at once.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ASYNC_CAL_ACCESS_H
+#define ASKAP_ACCESSORS_ASYNC_CAL_ACCESS_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+#include <askap/dataaccess/IOThreadPool.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+
+// std includes
+#include <future>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief read the solution
+/// @details Accessors based on MemCalSolutionAccessor are filled at once, so the caller
+/// doesn't read the wrapped source when the values are accessed.
+/// @param[in] src solution source
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> readCalSolution(const boost::shared_ptr<ICalSolutionConstSource const> &src,
+                                                             const long id);
+
+/// @brief obtain read-only accessor for a given solution ID asynchronously
+/// @details Solution sources based on tables are not thread-safe, all asynchronous operations
+/// with such a source should be submitted through the same strand (see IOThreadPool::Strand),
+/// and the source shouldn't be used elsewhere until the futures are ready.
+/// @param[in] src solution source
+/// @param[in] id solution ID to read
+/// @param[in] executor strand or pool to execute the read
+/// @return future with the shared pointer to an accessor object
+template<typename Executor>
+std::future<boost::shared_ptr<ICalSolutionConstAccessor> >
+roSolutionAsync(const boost::shared_ptr<ICalSolutionConstSource const> &src, const long id, Executor &executor)
+{
+  ASKAPCHECK(src, "An attempt to read the calibration solution asynchronously from an empty source");
+  return executor.submit(boost::bind(&readCalSolution, src, id));
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ASYNC_CAL_ACCESS_H
@@ -0,0 +1,412 @@
+/// @file
+///
+/// @brief Calibration solution source polling the wrapped source in background
+/// @details This class wraps a (potentially remote) solution source, keeps the most
+/// recent solution ID up to date and fetches new solutions in a background thread.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/AsyncCalSolutionSource.h>
+#include <askap/calibaccess/AsyncCalAccess.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+ASKAP_LOGGER(logger, ".calibaccess.AsyncCalSolutionSource");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up the source and start polling
+/// @param[in] src wrapped solution source
+/// @param[in] pollInterval time between consecutive polls of the wrapped source (in seconds)
+/// @param[in] maxCached maximum number of solutions kept in the cache
+AsyncCalSolutionSource::AsyncCalSolutionSource(const boost::shared_ptr<ICalSolutionSource> &src,
+        double pollInterval, size_t maxCached) : itsState(new State(src, pollInterval, maxCached))
+{
+  itsThread.reset(new boost::thread(boost::bind(&State::run, itsState.get())));
+}
+
+/// @brief destructor, releases pending accessors and stops the background thread
+AsyncCalSolutionSource::~AsyncCalSolutionSource()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+    itsState->itsStopRequested = true;
+  }
+  itsState->itsWakeUp.notify_all();
+  if (itsThread) {
+      itsThread->join();
+      itsThread.reset();
+  }
+  ASKAPLOG_DEBUG_STR(logger, "Asynchronous calibration source: "<<itsState->itsCacheHits<<" cache hit(s), "<<
+                     itsState->itsCacheMisses<<" miss(es), "<<itsState->itsPrefetched<<" solution(s) prefetched, "<<
+                     itsState->itsWritesCompleted<<" write(s) done in background");
+}
+
+/// @brief obtain ID for the most recent solution
+/// @details The value obtained by the last poll is returned.
+/// @return ID for the most recent solution
+long AsyncCalSolutionSource::mostRecentSolution() const
+{
+  boost::unique_lock<boost::mutex> lock(itsState->itsMutex);
+  while (!itsState->itsPolled && !itsState->itsError) {
+         itsState->itsPollDone.wait(lock);
+  }
+  if (!itsState->itsPolled) {
+      std::rethrow_exception(itsState->itsError);
+  }
+  return itsState->itsMostRecent;
+}
+
+/// @brief obtain solution ID for a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long AsyncCalSolutionSource::solutionID(const double time) const
+{
+  boost::lock_guard<boost::mutex> lock(itsState->itsSourceMutex);
+  return itsState->itsSource->solutionID(time);
+}
+
+/// @brief obtain closest solution ID before a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID, time of solution
+std::pair<long, double> AsyncCalSolutionSource::solutionIDBefore(const double time) const
+{
+  boost::lock_guard<boost::mutex> lock(itsState->itsSourceMutex);
+  return itsState->itsSource->solutionIDBefore(time);
+}
+
+/// @brief obtain closest solution ID after a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID, time of solution
+std::pair<long, double> AsyncCalSolutionSource::solutionIDAfter(const double time) const
+{
+  boost::lock_guard<boost::mutex> lock(itsState->itsSourceMutex);
+  return itsState->itsSource->solutionIDAfter(time);
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @details The cached accessor is returned if available.
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> AsyncCalSolutionSource::roSolution(const long id) const
+{
+  bool pending = false;
+  {
+    boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+    pending = itsState->itsPendingIDs.count(id) > 0;
+    if (!pending) {
+        const boost::shared_ptr<ICalSolutionConstAccessor> acc = itsState->findInCache(id);
+        if (acc) {
+            ++itsState->itsCacheHits;
+            return acc;
+        }
+    }
+    ++itsState->itsCacheMisses;
+  }
+  boost::shared_ptr<ICalSolutionConstAccessor> acc;
+  {
+    boost::lock_guard<boost::mutex> lock(itsState->itsSourceMutex);
+    acc = itsState->fetch(id);
+  }
+  if (!pending) {
+      boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+      // the solution could have been opened for writing in the meantime
+      if (itsState->itsPendingIDs.count(id) == 0) {
+          itsState->addToCache(id, acc);
+      }
+  }
+  return acc;
+}
+
+/// @brief obtain a solution ID to store new solution
+/// @param[in] time time stamp of the new solution in seconds since MJD of 0.
+/// @return solution ID
+long AsyncCalSolutionSource::newSolutionID(const double time)
+{
+  boost::lock_guard<boost::mutex> lock(itsState->itsSourceMutex);
+  return itsState->itsSource->newSolutionID(time);
+}
+
+/// @brief obtain a writeable accessor for a given solution ID
+/// @details The wrapped accessor is released in the background thread when the
+/// returned shared pointer goes out of scope.
+/// @param[in] id solution ID to access
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionAccessor> AsyncCalSolutionSource::rwSolution(const long id) const
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+    itsState->itsPendingIDs.insert(id);
+    itsState->removeFromCache(id);
+  }
+  boost::shared_ptr<ICalSolutionAccessor> acc;
+  try {
+     boost::lock_guard<boost::mutex> lock(itsState->itsSourceMutex);
+     acc = itsState->itsSource->rwSolution(id);
+  }
+  catch (...) {
+     boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+     itsState->itsPendingIDs.erase(itsState->itsPendingIDs.find(id));
+     throw;
+  }
+  ASKAPDEBUGASSERT(acc);
+  return boost::shared_ptr<ICalSolutionAccessor>(acc.get(), ReleaseDeleter(itsState, id, acc));
+}
+
+/// @brief wait until all released writable accessors are written back
+void AsyncCalSolutionSource::waitForWrites() const
+{
+  boost::unique_lock<boost::mutex> lock(itsState->itsMutex);
+  while (!itsState->itsWriteQueue.empty()) {
+         itsState->itsWriteDone.wait(lock);
+  }
+}
+
+/// @return number of solutions found in the cache
+size_t AsyncCalSolutionSource::cacheHits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+  return itsState->itsCacheHits;
+}
+
+/// @return number of solutions read on demand
+size_t AsyncCalSolutionSource::cacheMisses() const
+{
+  boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+  return itsState->itsCacheMisses;
+}
+
+/// @return number of solutions read in advance by the background thread
+size_t AsyncCalSolutionSource::solutionsPrefetched() const
+{
+  boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+  return itsState->itsPrefetched;
+}
+
+/// @return number of writable accessors released by the background thread
+size_t AsyncCalSolutionSource::writesCompleted() const
+{
+  boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+  return itsState->itsWritesCompleted;
+}
+
+/// @brief set up the state
+/// @param[in] src wrapped solution source
+/// @param[in] pollInterval time between consecutive polls (in seconds)
+/// @param[in] maxCached maximum number of solutions kept in the cache
+AsyncCalSolutionSource::State::State(const boost::shared_ptr<ICalSolutionSource> &src, double pollInterval,
+        size_t maxCached) : itsSource(src), itsPollInterval(pollInterval), itsMaxCached(maxCached),
+        itsMostRecent(-1), itsPolled(false), itsStopRequested(false), itsCacheHits(0), itsCacheMisses(0),
+        itsPrefetched(0), itsWritesCompleted(0)
+{
+  ASKAPCHECK(itsSource, "An attempt to initialise AsyncCalSolutionSource with empty shared pointer");
+  ASKAPCHECK(itsPollInterval > 0., "Poll interval is supposed to be positive, you have "<<itsPollInterval);
+  ASKAPCHECK(itsMaxCached > 0, "AsyncCalSolutionSource should be able to cache at least one solution");
+}
+
+/// @brief body of the background thread
+/// @details Released accessors are processed first, the queue is emptied before the thread stops.
+void AsyncCalSolutionSource::State::run()
+{
+  const boost::chrono::steady_clock::duration interval =
+        boost::chrono::duration_cast<boost::chrono::steady_clock::duration>(boost::chrono::duration<double>(itsPollInterval));
+  boost::chrono::steady_clock::time_point nextPoll = boost::chrono::steady_clock::now();
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  while (true) {
+         if (!itsWriteQueue.empty()) {
+             std::pair<long, boost::shared_ptr<ICalSolutionAccessor> > entry = itsWriteQueue.front();
+             itsWriteQueue.front().second.reset();
+             lock.unlock();
+             {
+               boost::lock_guard<boost::mutex> sourceLock(itsSourceMutex);
+               // this is the last reference, the solution is written back by the destructor
+               entry.second.reset();
+             }
+             lock.lock();
+             itsWriteQueue.pop_front();
+             itsPendingIDs.erase(itsPendingIDs.find(entry.first));
+             removeFromCache(entry.first);
+             ++itsWritesCompleted;
+             itsWriteDone.notify_all();
+             continue;
+         }
+         if (itsStopRequested) {
+             break;
+         }
+         if (boost::chrono::steady_clock::now() >= nextPoll) {
+             lock.unlock();
+             poll();
+             lock.lock();
+             nextPoll = boost::chrono::steady_clock::now() + interval;
+             continue;
+         }
+         itsWakeUp.wait_until(lock, nextPoll);
+  }
+}
+
+/// @brief poll the wrapped source and fetch the most recent solution if necessary
+void AsyncCalSolutionSource::State::poll()
+{
+  try {
+     long id = -1;
+     {
+       boost::lock_guard<boost::mutex> sourceLock(itsSourceMutex);
+       id = itsSource->mostRecentSolution();
+     }
+     bool needToFetch = false;
+     {
+       boost::lock_guard<boost::mutex> lock(itsMutex);
+       needToFetch = (itsPendingIDs.count(id) == 0) && !findInCache(id);
+     }
+     boost::shared_ptr<ICalSolutionConstAccessor> acc;
+     if (needToFetch) {
+         boost::lock_guard<boost::mutex> sourceLock(itsSourceMutex);
+         acc = fetch(id);
+     }
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     if (acc && (itsPendingIDs.count(id) == 0)) {
+         addToCache(id, acc);
+         ++itsPrefetched;
+     }
+     itsMostRecent = id;
+     itsPolled = true;
+  }
+  catch (const std::exception &ex) {
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     if (itsPolled) {
+         ASKAPLOG_WARN_STR(logger, "Failed to poll the calibration solution source, keeping solution "<<
+                           itsMostRecent<<" as the most recent one: "<<ex.what());
+     } else {
+         itsError = std::current_exception();
+     }
+  }
+  itsPollDone.notify_all();
+}
+
+/// @brief read the solution from the wrapped source
+/// @details The source mutex should be locked. Accessors reading the data on demand
+/// are filled at once, so they don't access the wrapped source later.
+/// @param[in] id solution ID
+/// @return shared pointer to the accessor
+boost::shared_ptr<ICalSolutionConstAccessor> AsyncCalSolutionSource::State::fetch(const long id)
+{
+  return readCalSolution(itsSource, id);
+}
+
+/// @brief pass the writable accessor to the background thread
+/// @details The accessor is released synchronously if the background thread has stopped
+/// @param[in] id solution ID
+/// @param[in] acc accessor to release (reset by this method)
+void AsyncCalSolutionSource::State::release(const long id, boost::shared_ptr<ICalSolutionAccessor> &acc)
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    if (!itsStopRequested) {
+        itsWriteQueue.push_back(std::pair<long, boost::shared_ptr<ICalSolutionAccessor> >(id, acc));
+        acc.reset();
+    }
+  }
+  if (acc) {
+      {
+        boost::lock_guard<boost::mutex> sourceLock(itsSourceMutex);
+        acc.reset();
+      }
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      itsPendingIDs.erase(itsPendingIDs.find(id));
+      removeFromCache(id);
+  } else {
+      itsWakeUp.notify_all();
+  }
+}
+
+/// @brief find the solution in the cache
+/// @details The solution becomes the most recently used one. The mutex should be locked.
+/// @param[in] id solution ID
+/// @return shared pointer to the accessor or empty pointer if not found
+boost::shared_ptr<ICalSolutionConstAccessor> AsyncCalSolutionSource::State::findInCache(const long id)
+{
+  for (std::list<std::pair<long, boost::shared_ptr<ICalSolutionConstAccessor> > >::iterator it = itsCache.begin();
+       it != itsCache.end(); ++it) {
+       if (it->first == id) {
+           itsCache.splice(itsCache.begin(), itsCache, it);
+           return itsCache.front().second;
+       }
+  }
+  return boost::shared_ptr<ICalSolutionConstAccessor>();
+}
+
+/// @brief add the solution to the cache
+/// @details The mutex should be locked.
+/// @param[in] id solution ID
+/// @param[in] acc accessor to add
+void AsyncCalSolutionSource::State::addToCache(const long id, const boost::shared_ptr<ICalSolutionConstAccessor> &acc)
+{
+  removeFromCache(id);
+  itsCache.push_front(std::pair<long, boost::shared_ptr<ICalSolutionConstAccessor> >(id, acc));
+  while (itsCache.size() > itsMaxCached) {
+         itsCache.pop_back();
+  }
+}
+
+/// @brief remove the solution from the cache
+/// @details The mutex should be locked.
+/// @param[in] id solution ID
+void AsyncCalSolutionSource::State::removeFromCache(const long id)
+{
+  for (std::list<std::pair<long, boost::shared_ptr<ICalSolutionConstAccessor> > >::iterator it = itsCache.begin();
+       it != itsCache.end(); ++it) {
+       if (it->first == id) {
+           itsCache.erase(it);
+           return;
+       }
+  }
+}
+
+/// @brief set up the deleter
+/// @param[in] state shared state
+/// @param[in] id solution ID
+/// @param[in] acc wrapped accessor
+AsyncCalSolutionSource::ReleaseDeleter::ReleaseDeleter(const boost::shared_ptr<State> &state, const long id,
+        const boost::shared_ptr<ICalSolutionAccessor> &acc) : itsState(state), itsID(id), itsAccessor(acc) {}
+
+/// @brief pass the wrapped accessor to the background thread
+void AsyncCalSolutionSource::ReleaseDeleter::operator()(ICalSolutionAccessor*)
+{
+  ASKAPDEBUGASSERT(itsState);
+  itsState->release(itsID, itsAccessor);
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,284 @@
+/// @file
+///
+/// @brief Calibration solution source polling the wrapped source in background
+/// @details Remote implementations of the calibration solution source (e.g. the one
+/// working with the calibration data service) do a network round trip for each call.
+/// This class wraps such a source, keeps the most recent solution ID up to date in
+/// a background thread, fetches new solutions before they are requested and releases
+/// writable accessors (which writes the solutions back) in the same thread, so the
+/// caller is not blocked.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ASYNC_CAL_SOLUTION_SOURCE_H
+#define ASKAP_ACCESSORS_ASYNC_CAL_SOLUTION_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionSource.h>
+#include <askap/calibaccess/ICalSolutionAccessor.h>
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <list>
+#include <deque>
+#include <set>
+#include <utility>
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Calibration solution source polling the wrapped source in background
+/// @details The background thread asks the wrapped source for the most recent solution
+/// every pollInterval seconds, mostRecentSolution returns the last obtained value (it
+/// only waits for the first poll to complete). If the most recent solution is not in the
+/// cache, it is read in the same thread. Solutions read through roSolution are cached as
+/// well, up to maxCached solutions are kept (the least recently used one is dropped first).
+///
+/// Writable accessors returned by rwSolution are released by the background thread, so
+/// the solution is written back (which happens when the wrapped accessor is destroyed)
+/// without blocking the caller. Solutions opened for writing are neither taken from nor
+/// added to the cache until the write is complete.
+///
+/// All calls to the wrapped source are serialised, so the wrapped source doesn't need to be
+/// thread-safe. Read-only accessors based on MemCalSolutionAccessor are filled when the
+/// solution is read, other accessors are expected not to use the wrapped source after they
+/// have been created. Writable accessors are used by the caller directly. The remaining
+/// methods (solutionID, newSolutionID, etc) are passed to the wrapped source.
+/// @ingroup calibaccess
+class AsyncCalSolutionSource : virtual public ICalSolutionSource,
+                               public boost::noncopyable {
+public:
+  /// @brief set up the source and start polling
+  /// @param[in] src wrapped solution source
+  /// @param[in] pollInterval time between consecutive polls of the wrapped source (in seconds)
+  /// @param[in] maxCached maximum number of solutions kept in the cache
+  explicit AsyncCalSolutionSource(const boost::shared_ptr<ICalSolutionSource> &src, double pollInterval = 1.,
+                                  size_t maxCached = 4);
+
+  /// @brief destructor, releases pending accessors and stops the background thread
+  virtual ~AsyncCalSolutionSource();
+
+  /// @brief obtain ID for the most recent solution
+  /// @details The value obtained by the last poll is returned.
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const;
+
+  /// @brief obtain solution ID for a given time
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const;
+
+  /// @brief obtain closest solution ID before a given time
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID, time of solution
+  virtual std::pair<long, double> solutionIDBefore(const double time) const;
+
+  /// @brief obtain closest solution ID after a given time
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID, time of solution
+  virtual std::pair<long, double> solutionIDAfter(const double time) const;
+
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @details The cached accessor is returned if available.
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+  /// @brief obtain a solution ID to store new solution
+  /// @param[in] time time stamp of the new solution in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long newSolutionID(const double time);
+
+  /// @brief obtain a writeable accessor for a given solution ID
+  /// @details The wrapped accessor is released in the background thread when the
+  /// returned shared pointer goes out of scope.
+  /// @param[in] id solution ID to access
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionAccessor> rwSolution(const long id) const;
+
+  /// @brief wait until all released writable accessors are written back
+  void waitForWrites() const;
+
+  /// @return number of solutions found in the cache
+  size_t cacheHits() const;
+
+  /// @return number of solutions read on demand
+  size_t cacheMisses() const;
+
+  /// @return number of solutions read in advance by the background thread
+  size_t solutionsPrefetched() const;
+
+  /// @return number of writable accessors released by the background thread
+  size_t writesCompleted() const;
+
+private:
+  /// @brief state shared between the source, the background thread and writable accessors
+  /// @details Writable accessors may outlive the source, so this state is kept by
+  /// shared pointer.
+  struct State : public boost::noncopyable {
+     /// @brief set up the state
+     /// @param[in] src wrapped solution source
+     /// @param[in] pollInterval time between consecutive polls (in seconds)
+     /// @param[in] maxCached maximum number of solutions kept in the cache
+     State(const boost::shared_ptr<ICalSolutionSource> &src, double pollInterval, size_t maxCached);
+
+     /// @brief body of the background thread
+     void run();
+
+     /// @brief poll the wrapped source and fetch the most recent solution if necessary
+     void poll();
+
+     /// @brief read the solution from the wrapped source
+     /// @details The source mutex should be locked. Accessors reading the data on demand
+     /// are filled at once, so they don't access the wrapped source later.
+     /// @param[in] id solution ID
+     /// @return shared pointer to the accessor
+     boost::shared_ptr<ICalSolutionConstAccessor> fetch(const long id);
+
+     /// @brief pass the writable accessor to the background thread
+     /// @details The accessor is released synchronously if the background thread has stopped
+     /// @param[in] id solution ID
+     /// @param[in] acc accessor to release (reset by this method)
+     void release(const long id, boost::shared_ptr<ICalSolutionAccessor> &acc);
+
+     /// @brief find the solution in the cache
+     /// @details The solution becomes the most recently used one. The mutex should be locked.
+     /// @param[in] id solution ID
+     /// @return shared pointer to the accessor or empty pointer if not found
+     boost::shared_ptr<ICalSolutionConstAccessor> findInCache(const long id);
+
+     /// @brief add the solution to the cache
+     /// @details The mutex should be locked.
+     /// @param[in] id solution ID
+     /// @param[in] acc accessor to add
+     void addToCache(const long id, const boost::shared_ptr<ICalSolutionConstAccessor> &acc);
+
+     /// @brief remove the solution from the cache
+     /// @details The mutex should be locked.
+     /// @param[in] id solution ID
+     void removeFromCache(const long id);
+
+     /// @brief wrapped source
+     boost::shared_ptr<ICalSolutionSource> itsSource;
+
+     /// @brief time between consecutive polls (in seconds)
+     double itsPollInterval;
+
+     /// @brief maximum number of solutions kept in the cache
+     size_t itsMaxCached;
+
+     /// @brief cached solutions, the most recently used is first
+     std::list<std::pair<long, boost::shared_ptr<ICalSolutionConstAccessor> > > itsCache;
+
+     /// @brief writable accessors waiting to be released
+     std::deque<std::pair<long, boost::shared_ptr<ICalSolutionAccessor> > > itsWriteQueue;
+
+     /// @brief IDs of solutions opened for writing and not yet written back
+     std::multiset<long> itsPendingIDs;
+
+     /// @brief most recent solution ID obtained by the last poll
+     long itsMostRecent;
+
+     /// @brief true, if the wrapped source has been polled successfully
+     bool itsPolled;
+
+     /// @brief error encountered by the first poll, if any
+     std::exception_ptr itsError;
+
+     /// @brief true, if the background thread is asked to stop
+     bool itsStopRequested;
+
+     /// @brief number of solutions found in the cache
+     size_t itsCacheHits;
+
+     /// @brief number of solutions read on demand
+     size_t itsCacheMisses;
+
+     /// @brief number of solutions read in advance
+     size_t itsPrefetched;
+
+     /// @brief number of writable accessors released by the background thread
+     size_t itsWritesCompleted;
+
+     /// @brief mutex guarding this state
+     boost::mutex itsMutex;
+
+     /// @brief mutex serialising access to the wrapped source and its accessors
+     boost::mutex itsSourceMutex;
+
+     /// @brief signalled when a poll completes
+     boost::condition_variable itsPollDone;
+
+     /// @brief signalled when a write completes
+     boost::condition_variable itsWriteDone;
+
+     /// @brief signalled when there is work for the background thread
+     boost::condition_variable itsWakeUp;
+  };
+
+  /// @brief deleter of writable accessors passing them to the background thread
+  struct ReleaseDeleter {
+     /// @brief set up the deleter
+     /// @param[in] state shared state
+     /// @param[in] id solution ID
+     /// @param[in] acc wrapped accessor
+     ReleaseDeleter(const boost::shared_ptr<State> &state, const long id,
+                    const boost::shared_ptr<ICalSolutionAccessor> &acc);
+
+     /// @brief pass the wrapped accessor to the background thread
+     void operator()(ICalSolutionAccessor*);
+
+     /// @brief shared state
+     boost::shared_ptr<State> itsState;
+
+     /// @brief solution ID
+     long itsID;
+
+     /// @brief wrapped accessor
+     boost::shared_ptr<ICalSolutionAccessor> itsAccessor;
+  };
+
+  /// @brief shared state
+  boost::shared_ptr<State> itsState;
+
+  /// @brief background thread
+  boost::shared_ptr<boost::thread> itsThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ASYNC_CAL_SOLUTION_SOURCE_H
@@ -0,0 +1,349 @@
+/// @file
+///
+/// @brief Source of calibration solutions stored in a memory-mappable binary file
+/// @details This class maps a compact binary file with dense cubes read-only and
+/// gives out accessors referring to the mapped memory directly.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/BinaryCalSolutionConstSource.h>
+#include <askap/calibaccess/BinaryCalSolutionFiller.h>
+#include <askap/calibaccess/TableCalSolutionFiller.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MCEpoch.h>
+
+// std includes
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+// system includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".calibaccess.BinaryCalSolutionConstSource");
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief header of the file
+struct FileHeader {
+   /// @brief magic string identifying the format
+   char itsMagic[8];
+   /// @brief version of the format
+   uint32_t itsVersion;
+   /// @brief reserved for future use, always zero
+   uint32_t itsReserved;
+   /// @brief number of solutions
+   uint64_t itsNSolutions;
+   /// @brief offset of the index from the start of the file
+   uint64_t itsIndexOffset;
+};
+
+/// @brief magic string stored in the header
+const char theMagic[8] = {'A', 'S', 'K', 'A', 'P', 'C', 'A', 'L'};
+
+/// @brief current version of the format
+const uint32_t theVersion = 1;
+
+/// @brief write a single record of the solution block
+/// @param[in] os output stream
+/// @param[in] cubes pair of cubes with values and validity flags, empty cubes mean no solution
+void writeRecord(std::ofstream &os, const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes)
+{
+  ASKAPCHECK(cubes.first.shape() == cubes.second.shape(), "The cubes with values and validity flags are expected to have the same shape");
+  BinaryCalSolutionFiller::ProductHeader hdr;
+  for (casacore::uInt dim = 0; dim < 3; ++dim) {
+       hdr.itsShape[dim] = cubes.first.nelements() > 0 ? cubes.first.shape()[dim] : 0;
+  }
+  hdr.itsReserved = 0;
+  os.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  const size_t nElements = cubes.first.nelements();
+  if (nElements > 0) {
+      bool deleteValues = false;
+      const casacore::Complex *values = cubes.first.getStorage(deleteValues);
+      os.write(reinterpret_cast<const char*>(values), nElements * sizeof(casacore::Complex));
+      cubes.first.freeStorage(values, deleteValues);
+      bool deleteFlags = false;
+      const casacore::Bool *flags = cubes.second.getStorage(deleteFlags);
+      os.write(reinterpret_cast<const char*>(flags), nElements * sizeof(casacore::Bool));
+      cubes.second.freeStorage(flags, deleteFlags);
+      const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      os.write(padding, BinaryCalSolutionFiller::recordSize(hdr) - sizeof(hdr) - nElements * (sizeof(casacore::Complex) +
+               sizeof(casacore::Bool)));
+  }
+}
+
+/// @brief read the given kind of solution via the table filler
+/// @details Solutions not defined in the table are returned as empty cubes
+/// @param[in] filler table filler set up for the row of interest
+/// @param[in] noSolution method of the filler checking whether the column exists
+/// @param[in] reader method of the filler to read the data
+/// @param[out] cubes pair of cubes to fill
+void readProduct(const TableCalSolutionFiller &filler, bool (ICalSolutionFiller::*noSolution)() const,
+                 void (ICalSolutionFiller::*reader)(std::pair<casacore::Cube<casacore::Complex>,
+                 casacore::Cube<casacore::Bool> > &) const,
+                 std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes)
+{
+  cubes.first.resize(0, 0, 0);
+  cubes.second.resize(0, 0, 0);
+  if (!(filler.*noSolution)()) {
+      try {
+         (filler.*reader)(cubes);
+      }
+      catch (const AskapError &) {
+         // there is no defined cell at this row or earlier
+         cubes.first.resize(0, 0, 0);
+         cubes.second.resize(0, 0, 0);
+      }
+  }
+}
+
+} // anonymous namespace
+
+/// @brief entry of the index
+struct BinaryCalSolutionConstSource::IndexEntry {
+   /// @brief time of the solution in seconds since MJD of 0 (UTC)
+   double itsTime;
+   /// @brief offset of the solution block from the start of the file
+   uint64_t itsOffset;
+};
+
+/// @brief mapped file
+struct BinaryCalSolutionConstSource::MappedFile : public boost::noncopyable {
+   /// @brief set up an empty object
+   MappedFile() : itsAddr(MAP_FAILED), itsSize(0) {}
+
+   /// @brief unmap the memory
+   ~MappedFile() {
+      if (itsAddr != MAP_FAILED) {
+          munmap(itsAddr, itsSize);
+      }
+   }
+
+   /// @return header of the mapped file
+   const FileHeader& header() const {
+      ASKAPDEBUGASSERT(itsAddr != MAP_FAILED);
+      return *static_cast<const FileHeader*>(itsAddr);
+   }
+
+   /// @return start of the mapped memory
+   const char* data() const {
+      return static_cast<const char*>(itsAddr);
+   }
+
+   /// @brief start of the mapped memory
+   void *itsAddr;
+   /// @brief size of the mapped memory
+   size_t itsSize;
+};
+
+/// @brief constructor
+/// @details The file is mapped into memory read-only. An exception is thrown if the file
+/// doesn't exist or is not a valid binary calibration solution file.
+/// @param[in] name file name
+BinaryCalSolutionConstSource::BinaryCalSolutionConstSource(const std::string &name) : itsFile(new MappedFile)
+{
+  ASKAPCHECK(sizeof(casacore::Bool) == 1, "Binary calibration solution format requires single-byte casacore::Bool");
+  const int fd = open(name.c_str(), O_RDONLY);
+  ASKAPCHECK(fd >= 0, "Unable to open binary calibration solution file "<<name<<": "<<strerror(errno));
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+      close(fd);
+      ASKAPTHROW(AskapError, "Unable to obtain the size of binary calibration solution file "<<name);
+  }
+  const size_t size = size_t(st.st_size);
+  if (size < sizeof(FileHeader)) {
+      close(fd);
+      ASKAPTHROW(AskapError, "File "<<name<<" is too short to be a binary calibration solution file");
+  }
+  void *addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  ASKAPCHECK(addr != MAP_FAILED, "Unable to map binary calibration solution file "<<name<<": "<<strerror(errno));
+  itsFile->itsAddr = addr;
+  itsFile->itsSize = size;
+  const FileHeader &hdr = itsFile->header();
+  ASKAPCHECK(memcmp(hdr.itsMagic, theMagic, sizeof(theMagic)) == 0, "File "<<name<<
+             " is not a binary calibration solution file");
+  ASKAPCHECK(hdr.itsVersion == theVersion, "Binary calibration solution file "<<name<<" has version "<<hdr.itsVersion<<
+             ", only version "<<theVersion<<" is supported (or the file has been written with a different byte order)");
+  ASKAPCHECK(hdr.itsNSolutions > 0, "Binary calibration solution file "<<name<<" is empty");
+  ASKAPCHECK((hdr.itsIndexOffset % sizeof(uint64_t) == 0) && (hdr.itsIndexOffset <= size) &&
+             (hdr.itsNSolutions <= (size - hdr.itsIndexOffset) / sizeof(IndexEntry)),
+             "Binary calibration solution file "<<name<<" is truncated");
+  const IndexEntry *entries = index();
+  for (uint64_t id = 0; id < hdr.itsNSolutions; ++id) {
+       ASKAPCHECK((entries[id].itsOffset % sizeof(uint64_t) == 0) && (entries[id].itsOffset >= sizeof(FileHeader)) &&
+                  (entries[id].itsOffset < hdr.itsIndexOffset), "Solution "<<id<<
+                  " has invalid offset in binary calibration solution file "<<name);
+  }
+  ASKAPLOG_INFO_STR(logger, "Mapped "<<hdr.itsNSolutions<<" calibration solution(s) from binary file "<<name<<
+                    " ("<<size<<" bytes)");
+}
+
+/// @return pointer to the first entry of the index
+const BinaryCalSolutionConstSource::IndexEntry* BinaryCalSolutionConstSource::index() const
+{
+  ASKAPDEBUGASSERT(itsFile);
+  return reinterpret_cast<const IndexEntry*>(itsFile->data() + itsFile->header().itsIndexOffset);
+}
+
+/// @return number of solutions in the file
+long BinaryCalSolutionConstSource::numberOfSolutions() const
+{
+  ASKAPDEBUGASSERT(itsFile);
+  return static_cast<long>(itsFile->header().itsNSolutions);
+}
+
+/// @brief obtain ID for the most recent solution
+/// @return ID for the most recent solution
+long BinaryCalSolutionConstSource::mostRecentSolution() const
+{
+  return numberOfSolutions() - 1;
+}
+
+/// @brief obtain solution ID for a given time
+/// @details This method looks for a solution valid at the given time
+/// and returns its ID. It is equivalent to mostRecentSolution() if
+/// called with a time sufficiently into the future.
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long BinaryCalSolutionConstSource::solutionID(const double time) const
+{
+  return solutionIDBefore(time).first;
+}
+
+/// @brief obtain closest solution ID before a given time
+/// @details This method looks for the first solution valid before
+/// the given time and returns its ID and timestamp
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID, time of solution
+std::pair<long, double> BinaryCalSolutionConstSource::solutionIDBefore(const double time) const
+{
+  const IndexEntry *entries = index();
+  for (long id = numberOfSolutions(); id > 0; --id) {
+       if (time >= entries[id - 1].itsTime) {
+           return std::pair<long, double>(id - 1, entries[id - 1].itsTime);
+       }
+  }
+  ASKAPTHROW(AskapError, "Unable to find solution matching the time "<<time<<", the file doesn't go that far in the past");
+}
+
+/// @brief obtain closest solution ID after a given time
+/// @details This method looks for the first solution valid after
+/// the given time and returns its ID and timestamp
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID, time of solution
+std::pair<long, double> BinaryCalSolutionConstSource::solutionIDAfter(const double time) const
+{
+  const IndexEntry *entries = index();
+  const long nSolutions = numberOfSolutions();
+  for (long id = 0; id < nSolutions; ++id) {
+       if (time <= entries[id].itsTime) {
+           return std::pair<long, double>(id, entries[id].itsTime);
+       }
+  }
+  // return last valid solution if no later one found
+  return solutionIDBefore(time);
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @details The accessor refers to the mapped memory, so the file stays mapped as long
+/// as the accessor exists (even if this source is destroyed).
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> BinaryCalSolutionConstSource::roSolution(const long id) const
+{
+  ASKAPCHECK((id >= 0) && (numberOfSolutions() > id), "Requested solution id="<<id<<" is not in the file");
+  const uint64_t offset = index()[id].itsOffset;
+  const boost::shared_ptr<BinaryCalSolutionFiller> filler(new BinaryCalSolutionFiller(itsFile,
+               itsFile->data() + offset, itsFile->header().itsIndexOffset - offset));
+  const boost::shared_ptr<MemCalSolutionAccessor> result(new MemCalSolutionAccessor(filler, true));
+  return result;
+}
+
+/// @brief convert calibration table into the binary format
+/// @details Every row of the table is stored as a separate solution with the same ID.
+/// @param[in] tab calibration table to read
+/// @param[in] name name of the binary file to write, any existing file is overwritten
+void BinaryCalSolutionConstSource::convertTable(const casacore::Table &tab, const std::string &name)
+{
+  ASKAPCHECK(sizeof(casacore::Bool) == 1, "Binary calibration solution format requires single-byte casacore::Bool");
+  ASKAPCHECK(tab.nrow() > 0, "Calibration table is empty, nothing to convert");
+  std::ofstream os(name.c_str(), std::ios::binary | std::ios::trunc);
+  ASKAPCHECK(os, "Unable to create binary calibration solution file "<<name);
+  FileHeader hdr;
+  memcpy(hdr.itsMagic, theMagic, sizeof(theMagic));
+  hdr.itsVersion = theVersion;
+  hdr.itsReserved = 0;
+  hdr.itsNSolutions = tab.nrow();
+  hdr.itsIndexOffset = 0;
+  // the header is written again when the index offset is known
+  os.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+
+  casacore::ROScalarMeasColumn<casacore::MEpoch> timeCol(tab, "TIME");
+  std::vector<IndexEntry> entries(tab.nrow());
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > cubes;
+  for (casacore::rownr_t row = 0; row < tab.nrow(); ++row) {
+       entries[row].itsTime = timeCol.convert(row, casacore::MEpoch::UTC).get("s").getValue();
+       entries[row].itsOffset = static_cast<uint64_t>(os.tellp());
+       const TableCalSolutionFiller filler(tab, static_cast<long>(row));
+       readProduct(filler, &ICalSolutionFiller::noGain, &ICalSolutionFiller::fillGains, cubes);
+       writeRecord(os, cubes);
+       readProduct(filler, &ICalSolutionFiller::noLeakage, &ICalSolutionFiller::fillLeakages, cubes);
+       writeRecord(os, cubes);
+       readProduct(filler, &ICalSolutionFiller::noBandpass, &ICalSolutionFiller::fillBandpasses, cubes);
+       writeRecord(os, cubes);
+       readProduct(filler, &ICalSolutionFiller::noBPLeakage, &ICalSolutionFiller::fillBPLeakages, cubes);
+       writeRecord(os, cubes);
+       readProduct(filler, &ICalSolutionFiller::noIonosphere, &ICalSolutionFiller::fillIonoParams, cubes);
+       writeRecord(os, cubes);
+  }
+  hdr.itsIndexOffset = static_cast<uint64_t>(os.tellp());
+  os.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(IndexEntry));
+  os.seekp(0);
+  os.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  os.close();
+  ASKAPCHECK(os, "Failed to write binary calibration solution file "<<name);
+  ASKAPLOG_INFO_STR(logger, "Converted "<<tab.nrow()<<" calibration solution(s) into binary file "<<name);
+}
+
+} // namespace accessors
+
+} // namespace askap
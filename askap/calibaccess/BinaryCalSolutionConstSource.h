@@ -0,0 +1,147 @@
+/// @file
+///
+/// @brief Source of calibration solutions stored in a memory-mappable binary file
+/// @details Reading the solutions from a casa table involves the table system for every
+/// solution requested which is relatively slow for large bandpass tables. This class reads
+/// a compact binary file with dense cubes which is mapped into memory read-only. The
+/// solutions are accessed without any copying or conversion and the pages are shared
+/// between all processes on the node reading the same file.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_CONST_SOURCE_H
+#define ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_CONST_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Source of calibration solutions stored in a memory-mappable binary file
+/// @details The file starts with a fixed 32-byte header (magic string "ASKAPCAL", format
+/// version, number of solutions and the offset of the index). The solution blocks (see
+/// BinaryCalSolutionFiller for their layout) follow the header. The index at the end of
+/// the file gives the time (in seconds since MJD of 0, UTC) and the offset of each block,
+/// the solution ID is the position in the index. All numbers are in the native byte order
+/// of the machine which has written the file, an exception is thrown if the file is read
+/// on a machine with a different byte order.
+///
+/// The file is written by convertTable from a calibration table. For each row of the table,
+/// the solution is resolved the same way as by TableCalSolutionConstSource (i.e. the most
+/// recent defined cell is taken for each kind of solution), so the accessors of this class
+/// return the same values. Kinds of solution undefined in the table are stored as absent,
+/// and the accessor returns default values with the invalid flags for them.
+///
+/// This source is read-only and is intended for files which are not modified while they
+/// are being read.
+/// @ingroup calibaccess
+class BinaryCalSolutionConstSource : virtual public ICalSolutionConstSource,
+                                     public boost::noncopyable {
+public:
+  /// @brief constructor
+  /// @details The file is mapped into memory read-only. An exception is thrown if the file
+  /// doesn't exist or is not a valid binary calibration solution file.
+  /// @param[in] name file name
+  explicit BinaryCalSolutionConstSource(const std::string &name);
+
+  // virtual methods of the interface
+
+  /// @brief obtain ID for the most recent solution
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const override;
+
+  /// @brief obtain solution ID for a given time
+  /// @details This method looks for a solution valid at the given time
+  /// and returns its ID. It is equivalent to mostRecentSolution() if
+  /// called with a time sufficiently into the future.
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const override;
+
+  /// @brief obtain closest solution ID before a given time
+  /// @details This method looks for the first solution valid before
+  /// the given time and returns its ID and timestamp
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID, time of solution
+  virtual std::pair<long, double> solutionIDBefore(const double time) const override;
+
+  /// @brief obtain closest solution ID after a given time
+  /// @details This method looks for the first solution valid after
+  /// the given time and returns its ID and timestamp
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID, time of solution
+  virtual std::pair<long, double> solutionIDAfter(const double time) const override;
+
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @details The accessor refers to the mapped memory, so the file stays mapped as long
+  /// as the accessor exists (even if this source is destroyed).
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const override;
+
+  /// @return number of solutions in the file
+  long numberOfSolutions() const;
+
+  /// @brief convert calibration table into the binary format
+  /// @details Every row of the table is stored as a separate solution with the same ID.
+  /// @param[in] tab calibration table to read
+  /// @param[in] name name of the binary file to write, any existing file is overwritten
+  static void convertTable(const casacore::Table &tab, const std::string &name);
+
+  /// @brief shared pointer definition
+  typedef boost::shared_ptr<BinaryCalSolutionConstSource> ShPtr;
+
+private:
+  /// @brief mapped file
+  struct MappedFile;
+
+  /// @brief entry of the index
+  struct IndexEntry;
+
+  /// @return pointer to the first entry of the index
+  const IndexEntry* index() const;
+
+  /// @brief mapped file
+  boost::shared_ptr<MappedFile> itsFile;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_CONST_SOURCE_H
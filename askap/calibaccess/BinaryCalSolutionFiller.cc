@@ -0,0 +1,183 @@
+/// @file
+///
+/// @brief Solution filler reading a memory-mapped binary solution
+/// @details This filler sets up the cubes directly over the solution block
+/// mapped by BinaryCalSolutionConstSource.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/BinaryCalSolutionFiller.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up the filler
+/// @param[in] owner object keeping the mapped memory alive
+/// @param[in] block start of the solution block in the mapped memory
+/// @param[in] size number of bytes available from the start of the block
+BinaryCalSolutionFiller::BinaryCalSolutionFiller(const boost::shared_ptr<void const> &owner, const char *block,
+                                                 size_t size) : itsOwner(owner)
+{
+  ASKAPCHECK(itsOwner, "An attempt to initialise BinaryCalSolutionFiller with an empty shared pointer");
+  ASKAPDEBUGASSERT(block != 0);
+  size_t offset = 0;
+  for (int product = 0; product < NUMBER_OF_PRODUCTS; ++product) {
+       ASKAPCHECK(offset + sizeof(ProductHeader) <= size, "Binary calibration solution block is truncated");
+       itsHeaders[product] = reinterpret_cast<const ProductHeader*>(block + offset);
+       offset += recordSize(*itsHeaders[product]);
+       ASKAPCHECK(offset <= size, "Binary calibration solution block is truncated");
+  }
+}
+
+/// @brief size of the record
+/// @param[in] hdr header of the record
+/// @return number of bytes occupied by the record including its header
+size_t BinaryCalSolutionFiller::recordSize(const ProductHeader &hdr)
+{
+  const size_t nElements = size_t(hdr.itsShape[0]) * hdr.itsShape[1] * hdr.itsShape[2];
+  // flags are padded to keep the next record aligned
+  return sizeof(ProductHeader) + nElements * sizeof(casacore::Complex) + ((nElements + 7) / 8) * 8;
+}
+
+/// @brief fill cubes for the given product
+/// @param[in] product kind of the solution
+/// @param[out] cubes pair of cubes referring to the mapped memory
+void BinaryCalSolutionFiller::fill(Product product, std::pair<casacore::Cube<casacore::Complex>,
+                                   casacore::Cube<casacore::Bool> > &cubes) const
+{
+  ASKAPDEBUGASSERT(product < NUMBER_OF_PRODUCTS);
+  const ProductHeader &hdr = *itsHeaders[product];
+  const size_t nElements = size_t(hdr.itsShape[0]) * hdr.itsShape[1] * hdr.itsShape[2];
+  ASKAPCHECK(nElements > 0, "Requested solution is not present in the binary calibration solution file");
+  const char *data = reinterpret_cast<const char*>(&hdr) + sizeof(ProductHeader);
+  const casacore::IPosition shape(3, hdr.itsShape[0], hdr.itsShape[1], hdr.itsShape[2]);
+  // the cubes refer to the read-only mapping, they must not be modified
+  cubes.first.takeStorage(shape, reinterpret_cast<casacore::Complex*>(const_cast<char*>(data)), casacore::SHARE);
+  cubes.second.takeStorage(shape, reinterpret_cast<casacore::Bool*>(const_cast<char*>(data) +
+                           nElements * sizeof(casacore::Complex)), casacore::SHARE);
+}
+
+/// @brief gains filler
+/// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+void BinaryCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
+{
+  fill(GAIN, gains);
+}
+
+/// @brief leakage filler
+/// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+void BinaryCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
+{
+  fill(LEAKAGE, leakages);
+}
+
+/// @brief bandpass filler
+/// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+void BinaryCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
+{
+  fill(BANDPASS, bp);
+}
+
+/// @brief bpleakage filler
+/// @param[in] bpleakages pair of cubes with bandpass leakages and validity flags (to be resized to (2*nChan) x nAnt x nBeam)
+void BinaryCalSolutionFiller::fillBPLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages) const
+{
+  fill(BPLEAKAGE, bpleakages);
+}
+
+/// @brief ionospheric parameters filler
+/// @param[in] params pair of cubes with ionospheric parameters and validity flags (to be resised to 1 x nParam x nDir)
+void BinaryCalSolutionFiller::fillIonoParams(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &params) const
+{
+  fill(IONOSPHERE, params);
+}
+
+/// @brief gains writer (not supported)
+void BinaryCalSolutionFiller::writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "BinaryCalSolutionFiller is read-only");
+}
+
+/// @brief leakage writer (not supported)
+void BinaryCalSolutionFiller::writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "BinaryCalSolutionFiller is read-only");
+}
+
+/// @brief bandpass writer (not supported)
+void BinaryCalSolutionFiller::writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "BinaryCalSolutionFiller is read-only");
+}
+
+/// @brief bpleakage writer (not supported)
+void BinaryCalSolutionFiller::writeBPLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "BinaryCalSolutionFiller is read-only");
+}
+
+/// @brief ionospheric parameters writer (not supported)
+void BinaryCalSolutionFiller::writeIonoParams(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "BinaryCalSolutionFiller is read-only");
+}
+
+/// @return true, if there is no gain solution
+bool BinaryCalSolutionFiller::noGain() const
+{
+  return recordSize(*itsHeaders[GAIN]) == sizeof(ProductHeader);
+}
+
+/// @return true, if there is no leakage solution
+bool BinaryCalSolutionFiller::noLeakage() const
+{
+  return recordSize(*itsHeaders[LEAKAGE]) == sizeof(ProductHeader);
+}
+
+/// @return true, if there is no bandpass solution
+bool BinaryCalSolutionFiller::noBandpass() const
+{
+  return recordSize(*itsHeaders[BANDPASS]) == sizeof(ProductHeader);
+}
+
+/// @return true, if there is no bandpass leakage solution
+bool BinaryCalSolutionFiller::noBPLeakage() const
+{
+  return recordSize(*itsHeaders[BPLEAKAGE]) == sizeof(ProductHeader);
+}
+
+/// @return true, if there is no ionospheric solution
+bool BinaryCalSolutionFiller::noIonosphere() const
+{
+  return recordSize(*itsHeaders[IONOSPHERE]) == sizeof(ProductHeader);
+}
+
+} // namespace accessors
+
+} // namespace askap
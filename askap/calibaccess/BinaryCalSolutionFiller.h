@@ -0,0 +1,163 @@
+/// @file
+///
+/// @brief Solution filler reading a memory-mapped binary solution
+/// @details The binary calibration solution file (see BinaryCalSolutionConstSource) keeps
+/// each solution as a block of dense cubes in the same order as used by the accessor.
+/// This filler sets up the cubes directly over the mapped block, so no data are copied
+/// or converted when the solution is read.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_FILLER_H
+#define ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_FILLER_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionFiller.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <stdint.h>
+#include <cstddef>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Solution filler reading a memory-mapped binary solution
+/// @details A solution block consists of one record per kind of solution (gains, leakages,
+/// bandpasses, bandpass leakages and ionospheric parameters, in this order). Each record
+/// starts with ProductHeader followed by the complex values and the validity flags (one byte
+/// per element) of the cube, stored in the casacore order (the first axis varies fastest).
+/// The flags are padded to a multiple of 8 bytes, so all records stay aligned. A record with
+/// an empty shape means that there is no such solution.
+///
+/// The cubes returned by this filler refer to the mapped memory directly and must not be
+/// modified. The mapping is kept alive by the owner object passed to the constructor as long
+/// as the filler exists. This filler is read-only, write methods throw an exception.
+/// @ingroup calibaccess
+class BinaryCalSolutionFiller : virtual public ICalSolutionFiller,
+                                public boost::noncopyable {
+public:
+  /// @brief kinds of solutions in the order they are stored in the block
+  enum Product {
+     GAIN = 0,
+     LEAKAGE,
+     BANDPASS,
+     BPLEAKAGE,
+     IONOSPHERE,
+     NUMBER_OF_PRODUCTS
+  };
+
+  /// @brief header of each record in the solution block
+  struct ProductHeader {
+     /// @brief shape of the cube, all zeros if there is no solution
+     uint32_t itsShape[3];
+     /// @brief reserved for future use, always zero
+     uint32_t itsReserved;
+  };
+
+  /// @brief set up the filler
+  /// @param[in] owner object keeping the mapped memory alive
+  /// @param[in] block start of the solution block in the mapped memory
+  /// @param[in] size number of bytes available from the start of the block
+  BinaryCalSolutionFiller(const boost::shared_ptr<void const> &owner, const char *block, size_t size);
+
+  /// @brief gains filler
+  /// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage filler
+  /// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass filler
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+  virtual void fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief bpleakage filler
+  /// @param[in] bpleakages pair of cubes with bandpass leakages and validity flags (to be resized to (2*nChan) x nAnt x nBeam)
+  virtual void fillBPLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages) const;
+
+  /// @brief ionospheric parameters filler
+  /// @param[in] params pair of cubes with ionospheric parameters and validity flags (to be resised to 1 x nParam x nDir)
+  virtual void fillIonoParams(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &params) const;
+
+  /// @brief gains writer (not supported)
+  virtual void writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage writer (not supported)
+  virtual void writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass writer (not supported)
+  virtual void writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief bpleakage writer (not supported)
+  virtual void writeBPLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages) const;
+
+  /// @brief ionospheric parameters writer (not supported)
+  virtual void writeIonoParams(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &params) const;
+
+  /// @return true, if there is no gain solution
+  virtual bool noGain() const;
+
+  /// @return true, if there is no leakage solution
+  virtual bool noLeakage() const;
+
+  /// @return true, if there is no bandpass solution
+  virtual bool noBandpass() const;
+
+  /// @return true, if there is no bandpass leakage solution
+  virtual bool noBPLeakage() const;
+
+  /// @return true, if there is no ionospheric solution
+  virtual bool noIonosphere() const;
+
+  /// @brief size of the record
+  /// @param[in] hdr header of the record
+  /// @return number of bytes occupied by the record including its header
+  static size_t recordSize(const ProductHeader &hdr);
+
+private:
+  /// @brief fill cubes for the given product
+  /// @param[in] product kind of the solution
+  /// @param[out] cubes pair of cubes referring to the mapped memory
+  void fill(Product product, std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes) const;
+
+  /// @brief object keeping the mapped memory alive
+  boost::shared_ptr<void const> itsOwner;
+
+  /// @brief headers of the records
+  const ProductHeader* itsHeaders[NUMBER_OF_PRODUCTS];
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BINARY_CAL_SOLUTION_FILLER_H
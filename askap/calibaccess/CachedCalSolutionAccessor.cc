@@ -35,6 +35,11 @@
 #include <askap/calibaccess/CachedCalSolutionAccessor.h>
 #include <askap/askap/AskapError.h>
 
+// std includes
+#include <algorithm>
+#include <string>
+#include <vector>
+
 namespace askap {
 
 namespace accessors {
@@ -42,13 +47,14 @@ namespace accessors {
 /// @brief default constructor
 /// @details It initialises a new copy of scimath::Params class to be used as a cache.
 CachedCalSolutionAccessor::CachedCalSolutionAccessor() :
-   itsCache(new scimath::Params) {}
+   itsCache(new scimath::Params), itsDenseStoreStale(false), itsCacheStale(false) {}
 
 /// @brief constructor setting up an explicit cache to use
 /// @details It sets up the accessor to use the cache referred to by the given shared
 /// pointer ensuring the reference semantics.
 /// @param[in] cache shared pointer to the Params class to use as a cache
-CachedCalSolutionAccessor::CachedCalSolutionAccessor(const boost::shared_ptr<scimath::Params> &cache) : itsCache(cache)
+CachedCalSolutionAccessor::CachedCalSolutionAccessor(const boost::shared_ptr<scimath::Params> &cache) : itsCache(cache),
+   itsDenseStoreStale(false), itsCacheStale(false)
 {
   ASKAPCHECK(itsCache, "An attempt to initialise CachedCalSolutionAccessor with a void shared pointer");
 }
@@ -58,7 +64,10 @@ CachedCalSolutionAccessor::CachedCalSolutionAccessor(const boost::shared_ptr<sci
 /// clones the cache.
 /// @param[in] src a reference to another instance of the class of this type
 CachedCalSolutionAccessor::CachedCalSolutionAccessor(const CachedCalSolutionAccessor &src) :
-    itsCache(src.cache().clone()) {}
+    itsCache(src.cache().clone()), itsDenseStoreStale(false), itsCacheStale(false)
+{
+  useDenseStorage(src.denseStorage());
+}
 
 // implementation of abstract methods of the interface
 
@@ -73,6 +82,11 @@ JonesJTerm CachedCalSolutionAccessor::gain(const JonesIndex &index) const
 {
   casacore::Complex g1(1.,0.), g2(1.,0.);
   bool g1Valid = false, g2Valid = false;
+  if (itsDenseStore) {
+      g1Valid = getDense(DenseCalSolutionStore::GAIN, index, 0, 0, g1);
+      g2Valid = getDense(DenseCalSolutionStore::GAIN, index, 1, 0, g2);
+      return JonesJTerm(g1,g1Valid,g2,g2Valid);
+  }
   const std::string paramG1 = paramName(index, casacore::Stokes::XX);
   const std::string paramG2 = paramName(index, casacore::Stokes::YY);
 
@@ -99,6 +113,11 @@ JonesDTerm CachedCalSolutionAccessor::leakage(const JonesIndex &index) const
 {
   casacore::Complex d12(0.,0.), d21(0.,0.);
   bool d12Valid = false, d21Valid = false;
+  if (itsDenseStore) {
+      d12Valid = getDense(DenseCalSolutionStore::LEAKAGE, index, 0, 0, d12);
+      d21Valid = getDense(DenseCalSolutionStore::LEAKAGE, index, 1, 0, d21);
+      return JonesDTerm(d12, d12Valid, d21, d21Valid);
+  }
   const std::string paramD12 = paramName(index, casacore::Stokes::XY);
   const std::string paramD21 = paramName(index, casacore::Stokes::YX);
 
@@ -128,6 +147,11 @@ JonesJTerm CachedCalSolutionAccessor::bandpass(const JonesIndex &index, const ca
 {
     casacore::Complex g1(1.,0.), g2(1.,0.);
     bool g1Valid = false, g2Valid = false;
+    if (itsDenseStore) {
+        g1Valid = getDense(DenseCalSolutionStore::BANDPASS, index, 0, chan, g1);
+        g2Valid = getDense(DenseCalSolutionStore::BANDPASS, index, 1, chan, g2);
+        return JonesJTerm(g1, g1Valid, g2, g2Valid);
+    }
     const std::string paramG1 = addChannelInfo(paramName(index, casacore::Stokes::XX), chan);
     const std::string paramG2 = addChannelInfo(paramName(index, casacore::Stokes::YY), chan);
 
@@ -155,6 +179,11 @@ JonesDTerm CachedCalSolutionAccessor::bpleakage(const JonesIndex &index, const c
 {
     casacore::Complex d12(0.,0.), d21(0.,0.);
     bool d12Valid = false, d21Valid = false;
+    if (itsDenseStore) {
+        d12Valid = getDense(DenseCalSolutionStore::BPLEAKAGE, index, 0, chan, d12);
+        d21Valid = getDense(DenseCalSolutionStore::BPLEAKAGE, index, 1, chan, d21);
+        return JonesDTerm(d12, d12Valid, d21, d21Valid);
+    }
     const std::string paramD12 = addChannelInfo(paramName(index, casacore::Stokes::XY), chan);
     const std::string paramD21 = addChannelInfo(paramName(index, casacore::Stokes::YX), chan);
     if (cache().has(paramD12)) {
@@ -180,9 +209,11 @@ IonoTerm CachedCalSolutionAccessor::ionoparam(const JonesIndex &index) const
   bool paramValid = false;
   const std::string paramStr = ionoParamName(index);
 
-  if (cache().has(paramStr)) {
+  // ionospheric parameters are not in the dense storage, the cache is used without export
+  ASKAPDEBUGASSERT(itsCache);
+  if (itsCache->has(paramStr)) {
       paramValid = true;
-      param = cache().complexValue(paramStr);
+      param = itsCache->complexValue(paramStr);
   }
   return IonoTerm(param,paramValid);
 }
@@ -198,11 +229,12 @@ IonoTerm CachedCalSolutionAccessor::ionoparam(const JonesIndex &index) const
 /// @param[in] isValid true, if the given value is valid (method just returns otherwise)
 void CachedCalSolutionAccessor::updateParamInCache(const std::string &name, const casacore::Complex &val, const bool isValid)
 {
+  ASKAPDEBUGASSERT(itsCache);
   if (isValid) {
-      if (cache().has(name)) {
-          cache().update(name, val);
+      if (itsCache->has(name)) {
+          itsCache->update(name, val);
       } else {
-          cache().add(name, val);
+          itsCache->add(name, val);
       }
   }
 }
@@ -214,6 +246,11 @@ void CachedCalSolutionAccessor::updateParamInCache(const std::string &name, cons
 /// @param[in] gains JonesJTerm object with gains and validity flags
 void CachedCalSolutionAccessor::setGain(const JonesIndex &index, const JonesJTerm &gains)
 {
+  if (itsDenseStore) {
+      setDense(DenseCalSolutionStore::GAIN, index, 0, 0, gains.g1(), gains.g1IsValid());
+      setDense(DenseCalSolutionStore::GAIN, index, 1, 0, gains.g2(), gains.g2IsValid());
+      return;
+  }
   updateParamInCache(paramName(index, casacore::Stokes::XX), gains.g1(), gains.g1IsValid());
   updateParamInCache(paramName(index, casacore::Stokes::YY), gains.g2(), gains.g2IsValid());
 }
@@ -225,6 +262,11 @@ void CachedCalSolutionAccessor::setGain(const JonesIndex &index, const JonesJTer
 /// @param[in] leakages JonesDTerm object with leakages and validity flags
 void CachedCalSolutionAccessor::setLeakage(const JonesIndex &index, const JonesDTerm &leakages)
 {
+  if (itsDenseStore) {
+      setDense(DenseCalSolutionStore::LEAKAGE, index, 0, 0, leakages.d12(), leakages.d12IsValid());
+      setDense(DenseCalSolutionStore::LEAKAGE, index, 1, 0, leakages.d21(), leakages.d21IsValid());
+      return;
+  }
   updateParamInCache(paramName(index, casacore::Stokes::XY), leakages.d12(), leakages.d12IsValid());
   updateParamInCache(paramName(index, casacore::Stokes::YX), leakages.d21(), leakages.d21IsValid());
 }
@@ -240,6 +282,11 @@ void CachedCalSolutionAccessor::setLeakage(const JonesIndex &index, const JonesD
 /// gains set explicitly for each channel.
 void CachedCalSolutionAccessor::setBandpass(const JonesIndex &index, const JonesJTerm &bp, const casacore::uInt chan)
 {
+  if (itsDenseStore) {
+      setDense(DenseCalSolutionStore::BANDPASS, index, 0, chan, bp.g1(), bp.g1IsValid());
+      setDense(DenseCalSolutionStore::BANDPASS, index, 1, chan, bp.g2(), bp.g2IsValid());
+      return;
+  }
   updateParamInCache(addChannelInfo(paramName(index, casacore::Stokes::XX), chan), bp.g1(), bp.g1IsValid());
   updateParamInCache(addChannelInfo(paramName(index, casacore::Stokes::YY), chan), bp.g2(), bp.g2IsValid());
 }
@@ -252,6 +299,11 @@ void CachedCalSolutionAccessor::setBandpass(const JonesIndex &index, const Jones
 /// @param[in] chan spectral channel
 void CachedCalSolutionAccessor::setBPLeakage(const JonesIndex &index, const JonesDTerm &bpleakages, const casacore::uInt chan)
 {
+  if (itsDenseStore) {
+      setDense(DenseCalSolutionStore::BPLEAKAGE, index, 0, chan, bpleakages.d12(), bpleakages.d12IsValid());
+      setDense(DenseCalSolutionStore::BPLEAKAGE, index, 1, chan, bpleakages.d21(), bpleakages.d21IsValid());
+      return;
+  }
   updateParamInCache(addChannelInfo(paramName(index, casacore::Stokes::XY), chan), bpleakages.d12(), bpleakages.d12IsValid());
   updateParamInCache(addChannelInfo(paramName(index, casacore::Stokes::YX), chan), bpleakages.d21(), bpleakages.d21IsValid());
 }
@@ -271,9 +323,123 @@ void CachedCalSolutionAccessor::setIonosphere(const JonesIndex &index, const Ion
 scimath::Params& CachedCalSolutionAccessor::cache() const
 {
   ASKAPDEBUGASSERT(itsCache);
+  if (itsDenseStore) {
+      if (itsCacheStale) {
+          itsDenseStore->exportTo(*itsCache);
+          itsCacheStale = false;
+      }
+      // the caller may change the cache
+      itsDenseStoreStale = true;
+  }
   return *itsCache;
 }
 
+/// @brief switch dense storage of gains, leakages and bandpasses on or off
+/// @details The dense storage is loaded from the cache on the first access. When it is
+/// switched off, the values set via this accessor are exported into the cache.
+/// @param[in] dense true to use dense storage, false to keep everything in scimath::Params
+void CachedCalSolutionAccessor::useDenseStorage(bool dense)
+{
+  if (dense && !itsDenseStore) {
+      itsDenseStore.reset(new DenseCalSolutionStore);
+      itsDenseStoreStale = true;
+      itsCacheStale = false;
+  } else if (!dense && itsDenseStore) {
+      cache();
+      itsDenseStore.reset();
+  }
+}
+
+/// @brief replace gains, leakages and bandpasses with the given values
+/// @details Dense storage is switched on and takes over the content of the given store
+/// (the store is swapped with the current dense storage, so no copy is made). Gains,
+/// leakages, bandpasses and bandpass leakages present in the cache are removed, other
+/// parameters are left untouched.
+/// @param[in] store values to take, the store is left with unspecified content on return
+void CachedCalSolutionAccessor::takeDenseStorage(DenseCalSolutionStore &store)
+{
+  ASKAPDEBUGASSERT(itsCache);
+  const std::vector<std::string> names = itsCache->names();
+  for (std::vector<std::string>::const_iterator ci = names.begin(); ci != names.end(); ++ci) {
+       if ((ci->compare(0, 5, "gain.") == 0) || (ci->compare(0, 8, "leakage.") == 0)) {
+           itsCache->remove(*ci);
+       }
+  }
+  if (!itsDenseStore) {
+      itsDenseStore.reset(new DenseCalSolutionStore);
+  }
+  std::swap(*itsDenseStore, store);
+  itsDenseStoreStale = false;
+  // the values are only in the dense storage
+  itsCacheStale = true;
+}
+
+/// @brief bring the dense storage and the cache in sync
+/// @details The dense storage is normally reloaded on the first read after the cache has
+/// been accessed. After this call, none of the const methods except cache modify the object
+/// until a setter is called, so the accessor can be read from several threads at once.
+void CachedCalSolutionAccessor::syncStorage() const
+{
+  if (itsDenseStore) {
+      ASKAPDEBUGASSERT(itsCache);
+      if (itsCacheStale) {
+          itsDenseStore->exportTo(*itsCache);
+          itsCacheStale = false;
+      }
+      denseStore();
+  }
+}
+
+/// @brief dense storage, reloaded from the cache if necessary
+/// @return a reference to the dense storage
+const DenseCalSolutionStore& CachedCalSolutionAccessor::denseStore() const
+{
+  ASKAPDEBUGASSERT(itsDenseStore);
+  ASKAPDEBUGASSERT(itsCache);
+  if (itsDenseStoreStale) {
+      itsDenseStore->importFrom(*itsCache);
+      itsDenseStoreStale = false;
+  }
+  return *itsDenseStore;
+}
+
+/// @brief obtain an element from the dense storage
+/// @param[in] term kind of the term
+/// @param[in] index ant/beam index
+/// @param[in] pol polarisation index (0 or 1)
+/// @param[in] chan channel index (ignored for gains and leakages)
+/// @param[out] val value (untouched if the element is not valid)
+/// @return true, if the element has been set
+bool CachedCalSolutionAccessor::getDense(DenseCalSolutionStore::Term term, const JonesIndex &index,
+                casacore::uInt pol, casacore::uInt chan, casacore::Complex &val) const
+{
+  if ((index.antenna() < 0) || (index.beam() < 0)) {
+      return false;
+  }
+  return denseStore().get(term, casacore::uInt(index.antenna()), casacore::uInt(index.beam()), pol, chan, val);
+}
+
+/// @brief set an element in the dense storage
+/// @details Invalid values are ignored in the same way as by updateParamInCache
+/// @param[in] term kind of the term
+/// @param[in] index ant/beam index
+/// @param[in] pol polarisation index (0 or 1)
+/// @param[in] chan channel index (ignored for gains and leakages)
+/// @param[in] val value to set
+/// @param[in] isValid true, if the given value is valid (method just returns otherwise)
+void CachedCalSolutionAccessor::setDense(DenseCalSolutionStore::Term term, const JonesIndex &index,
+                casacore::uInt pol, casacore::uInt chan, const casacore::Complex &val, bool isValid)
+{
+  if (!isValid) {
+      return;
+  }
+  ASKAPCHECK((index.antenna() >= 0) && (index.beam() >= 0), "Negative antenna or beam index: "<<
+             index.antenna()<<" "<<index.beam());
+  denseStore();
+  itsDenseStore->set(term, casacore::uInt(index.antenna()), casacore::uInt(index.beam()), pol, chan, val);
+  itsCacheStale = true;
+}
+
 
 } // namespace accessors
 
@@ -36,8 +36,12 @@
 // own includes
 #include <askap/calibaccess/ICalSolutionAccessor.h>
 #include <askap/calibaccess/CalParamNameHelper.h>
+#include <askap/calibaccess/DenseCalSolutionStore.h>
 #include <askap/scimath/fitting/Params.h>
 
+// boost includes
+#include <boost/shared_ptr.hpp>
+
 // std includes
 #include <string>
 
@@ -167,10 +171,40 @@ public:
   virtual void setIonosphere(const JonesIndex &index, const IonoTerm &param);
 
   /// @brief direct access to the cache
+  /// @details If dense storage is used, the values set via this accessor are exported
+  /// into the cache first. The cache can be modified by the caller, the dense storage is
+  /// reloaded from the cache on the next access to the gains or bandpasses.
   /// @return a reference to the cache
   /// @note an exception is thrown if the underlying shared pointer is not initialised
   scimath::Params& cache() const;
 
+  /// @brief switch dense storage of gains, leakages and bandpasses on or off
+  /// @details By default, all values are kept in scimath::Params and each access builds a
+  /// parameter name. With dense storage, gains, leakages, bandpasses and bandpass leakages
+  /// are kept in arrays indexed by antenna, beam, polarisation and channel
+  /// (see DenseCalSolutionStore) and the names are only built when the cache is accessed
+  /// via the cache method. Ionospheric parameters are always kept in scimath::Params.
+  /// @param[in] dense true to use dense storage, false to keep everything in scimath::Params
+  void useDenseStorage(bool dense = true);
+
+  /// @return true, if dense storage is used
+  inline bool denseStorage() const { return static_cast<bool>(itsDenseStore); }
+
+  /// @brief replace gains, leakages and bandpasses with the given values
+  /// @details Dense storage is switched on and takes over the content of the given store
+  /// (the store is swapped with the current dense storage, so no copy is made). Gains,
+  /// leakages, bandpasses and bandpass leakages present in the cache are removed, other
+  /// parameters are left untouched. This allows the solution to be read straight into
+  /// the dense storage (see ParsetCalSolutionParser).
+  /// @param[in] store values to take, the store is left with unspecified content on return
+  void takeDenseStorage(DenseCalSolutionStore &store);
+
+  /// @brief bring the dense storage and the cache in sync
+  /// @details The dense storage is normally reloaded on the first read after the cache has
+  /// been accessed. After this call, none of the const methods except cache modify the object
+  /// until a setter is called, so the accessor can be read from several threads at once.
+  void syncStorage() const;
+
 protected:
 
   /// @brief helper method to update given parameter in the cache
@@ -184,8 +218,42 @@ protected:
   void updateParamInCache(const std::string &name, const casacore::Complex &val, const bool isValid = true);
 
 private:
+  /// @brief dense storage, reloaded from the cache if necessary
+  /// @return a reference to the dense storage
+  const DenseCalSolutionStore& denseStore() const;
+
+  /// @brief obtain an element from the dense storage
+  /// @param[in] term kind of the term
+  /// @param[in] index ant/beam index
+  /// @param[in] pol polarisation index (0 or 1)
+  /// @param[in] chan channel index (ignored for gains and leakages)
+  /// @param[out] val value (untouched if the element is not valid)
+  /// @return true, if the element has been set
+  bool getDense(DenseCalSolutionStore::Term term, const JonesIndex &index, casacore::uInt pol,
+                casacore::uInt chan, casacore::Complex &val) const;
+
+  /// @brief set an element in the dense storage
+  /// @details Invalid values are ignored in the same way as by updateParamInCache
+  /// @param[in] term kind of the term
+  /// @param[in] index ant/beam index
+  /// @param[in] pol polarisation index (0 or 1)
+  /// @param[in] chan channel index (ignored for gains and leakages)
+  /// @param[in] val value to set
+  /// @param[in] isValid true, if the given value is valid (method just returns otherwise)
+  void setDense(DenseCalSolutionStore::Term term, const JonesIndex &index, casacore::uInt pol,
+                casacore::uInt chan, const casacore::Complex &val, bool isValid);
+
   /// @brief shared pointer to the cache of parameters
   boost::shared_ptr<scimath::Params> itsCache;
+
+  /// @brief dense storage of gains, leakages and bandpasses, empty if not used
+  boost::shared_ptr<DenseCalSolutionStore> itsDenseStore;
+
+  /// @brief true, if the dense storage has to be reloaded from the cache
+  mutable bool itsDenseStoreStale;
+
+  /// @brief true, if the dense storage has values not yet exported to the cache
+  mutable bool itsCacheStale;
 };
 
 
@@ -0,0 +1,167 @@
+/// @file
+///
+/// @brief Sequence file announcing updates of a calibration table
+/// @details The writer updates a small sequence file inside the table directory each time
+/// the table is flushed, so readers can detect new solutions without accessing the table.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/CalSolutionSequenceFile.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#endif
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief name of the sequence file inside the table directory
+const char* CalSolutionSequenceFile::theirName = "CALSOLUTION_SEQUENCE";
+
+/// @brief set up the object for the given table
+/// @param[in] tableName name of the calibration table (directory)
+CalSolutionSequenceFile::CalSolutionSequenceFile(const std::string &tableName) :
+      itsTableName(tableName), itsFileName(tableName + "/" + theirName) {}
+
+/// @brief record an update of the table
+/// @details The update counter is incremented. This method is to be called by the writer
+/// after the table has been flushed.
+/// @param[in] nSolutions number of solutions in the table
+void CalSolutionSequenceFile::publish(long nSolutions) const
+{
+  const State current = read();
+  std::ostringstream tmpName;
+  tmpName<<itsFileName<<".tmp."<<getpid();
+  {
+    std::ofstream os(tmpName.str().c_str(), std::ios::out | std::ios::trunc);
+    os<<current.itsSequence + 1<<" "<<nSolutions<<std::endl;
+    if (!os) {
+        std::remove(tmpName.str().c_str());
+        ASKAPTHROW(DataAccessError, "Unable to write calibration table sequence file "<<tmpName.str());
+    }
+  }
+  // rename is atomic, readers see either the old or the new record
+  if (std::rename(tmpName.str().c_str(), itsFileName.c_str()) != 0) {
+      std::remove(tmpName.str().c_str());
+      ASKAPTHROW(DataAccessError, "Unable to replace calibration table sequence file "<<itsFileName);
+  }
+}
+
+/// @brief record an update of the given table
+/// @details Nothing is done for tables which are not stored on disk (e.g. memory tables).
+/// @param[in] tab table which has just been flushed
+void CalSolutionSequenceFile::announce(const casacore::Table &tab)
+{
+  if (tab.tableType() == casacore::Table::Plain) {
+      CalSolutionSequenceFile(tab.tableName()).publish(static_cast<long>(tab.nrow()));
+  }
+}
+
+/// @brief read the current state
+/// @return state recorded in the file (zero sequence if the file doesn't exist)
+CalSolutionSequenceFile::State CalSolutionSequenceFile::read() const
+{
+  State result;
+  result.itsSequence = 0;
+  result.itsNSolutions = -1;
+  std::ifstream is(itsFileName.c_str());
+  if (is) {
+      casacore::uInt64 sequence = 0;
+      long nSolutions = -1;
+      if (is>>sequence>>nSolutions) {
+          result.itsSequence = sequence;
+          result.itsNSolutions = nSolutions;
+      }
+  }
+  return result;
+}
+
+/// @brief wait for the file to change
+/// @details The method returns as soon as the update counter differs from the given one
+/// or when the timeout expires.
+/// @param[in] sequence update counter known to the caller
+/// @param[in] timeout maximum time to wait (in seconds)
+/// @param[in] pollInterval time between checks of the file if no notification arrives (in seconds)
+/// @return state recorded in the file when the method returns
+CalSolutionSequenceFile::State CalSolutionSequenceFile::waitForChange(casacore::uInt64 sequence,
+                   double timeout, double pollInterval) const
+{
+  ASKAPCHECK(pollInterval > 0., "Poll interval is supposed to be positive, you have "<<pollInterval);
+  const boost::chrono::steady_clock::time_point deadline = boost::chrono::steady_clock::now() +
+        boost::chrono::duration_cast<boost::chrono::steady_clock::duration>(boost::chrono::duration<double>(timeout));
+  int fd = -1;
+#ifdef __linux__
+  fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if ((fd >= 0) && (inotify_add_watch(fd, itsTableName.c_str(), IN_MOVED_TO | IN_CLOSE_WRITE) < 0)) {
+      close(fd);
+      fd = -1;
+  }
+#endif
+  State result = read();
+  while (result.itsSequence == sequence) {
+         const double remaining = boost::chrono::duration<double>(deadline - boost::chrono::steady_clock::now()).count();
+         if (remaining <= 0.) {
+             break;
+         }
+         const double wait = std::min(remaining, pollInterval);
+#ifdef __linux__
+         if (fd >= 0) {
+             struct pollfd pfd;
+             pfd.fd = fd;
+             pfd.events = POLLIN;
+             pfd.revents = 0;
+             if (::poll(&pfd, 1, static_cast<int>(wait * 1e3) + 1) > 0) {
+                 // drain the events, the file is read regardless of which file has changed
+                 char buf[4096];
+                 while (::read(fd, buf, sizeof(buf)) > 0) {}
+             }
+         } else
+#endif
+         {
+             boost::this_thread::sleep_for(boost::chrono::duration<double>(wait));
+         }
+         result = read();
+  }
+  if (fd >= 0) {
+      close(fd);
+  }
+  return result;
+}
@@ -0,0 +1,113 @@
+/// @file
+///
+/// @brief Sequence file announcing updates of a calibration table
+/// @details Real-time consumers ask for the most recent solution repeatedly. For the
+/// table-based source this means accessing the table on the shared file system every
+/// time. The writer updates a small sequence file inside the table directory each time
+/// the table is flushed, so readers can detect new solutions by looking at this file only,
+/// or wait for it to change.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_CAL_SOLUTION_SEQUENCE_FILE_H
+#define ASKAP_ACCESSORS_CAL_SOLUTION_SEQUENCE_FILE_H
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/tables/Tables/Table.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Sequence file announcing updates of a calibration table
+/// @details The file holds the update counter and the number of solutions in the table.
+/// It is replaced atomically (written under a temporary name and renamed), so readers
+/// always see a complete record. Waiting uses inotify on the table directory where it is
+/// available. Notifications are not delivered for changes made on other hosts of a network
+/// file system, so the file is also checked at the given poll interval. This check only
+/// reads the small sequence file, not the table. A single writer per table is assumed.
+/// @ingroup calibaccess
+class CalSolutionSequenceFile {
+public:
+  /// @brief state recorded in the file
+  struct State {
+     /// @brief update counter, 0 if the file doesn't exist
+     casacore::uInt64 itsSequence;
+     /// @brief number of solutions in the table, -1 if the file doesn't exist
+     long itsNSolutions;
+  };
+
+  /// @brief set up the object for the given table
+  /// @param[in] tableName name of the calibration table (directory)
+  explicit CalSolutionSequenceFile(const std::string &tableName);
+
+  /// @return name of the sequence file
+  inline const std::string& fileName() const { return itsFileName; }
+
+  /// @brief record an update of the table
+  /// @details The update counter is incremented. This method is to be called by the writer
+  /// after the table has been flushed.
+  /// @param[in] nSolutions number of solutions in the table
+  void publish(long nSolutions) const;
+
+  /// @brief read the current state
+  /// @return state recorded in the file (zero sequence if the file doesn't exist)
+  State read() const;
+
+  /// @brief wait for the file to change
+  /// @details The method returns as soon as the update counter differs from the given one
+  /// or when the timeout expires.
+  /// @param[in] sequence update counter known to the caller
+  /// @param[in] timeout maximum time to wait (in seconds)
+  /// @param[in] pollInterval time between checks of the file if no notification arrives (in seconds)
+  /// @return state recorded in the file when the method returns
+  State waitForChange(casacore::uInt64 sequence, double timeout, double pollInterval = 1.) const;
+
+  /// @brief record an update of the given table
+  /// @details Nothing is done for tables which are not stored on disk (e.g. memory tables).
+  /// @param[in] tab table which has just been flushed
+  static void announce(const casacore::Table &tab);
+
+  /// @brief name of the sequence file inside the table directory
+  static const char* theirName;
+
+private:
+  /// @brief name of the table directory
+  std::string itsTableName;
+
+  /// @brief full name of the sequence file
+  std::string itsFileName;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CAL_SOLUTION_SEQUENCE_FILE_H
@@ -0,0 +1,116 @@
+/// @file
+///
+/// @brief Holder of the most recent calibration solution shared between threads
+/// @details The writer replaces the immutable solution snapshot atomically, readers
+/// obtain a shared pointer to the current one without locking a mutex.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/CalSolutionSnapshotHolder.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up an empty holder
+CalSolutionSnapshotHolder::CalSolutionSnapshotHolder() : itsNPublished(0) {}
+
+/// @brief publish the solution
+/// @details The accessor should not be modified after this call
+/// @param[in] solution accessor to publish
+/// @param[in] id solution ID (negative if unknown)
+/// @return version of the published snapshot
+casacore::uInt64 CalSolutionSnapshotHolder::publish(const boost::shared_ptr<ICalSolutionConstAccessor const> &solution,
+                                                    long id)
+{
+  ASKAPCHECK(solution, "An attempt to publish an empty calibration solution");
+  const boost::shared_ptr<Snapshot> snap(new Snapshot);
+  snap->itsSolution = solution;
+  snap->itsID = id;
+  snap->itsVersion = ++itsNPublished;
+  boost::shared_ptr<Snapshot const> current = boost::atomic_load(&itsSnapshot);
+  // the versions only grow even if several writers publish at the same time
+  while (!current || (current->itsVersion < snap->itsVersion)) {
+         if (boost::atomic_compare_exchange(&itsSnapshot, &current, boost::shared_ptr<Snapshot const>(snap))) {
+             break;
+         }
+  }
+  return snap->itsVersion;
+}
+
+/// @brief publish a copy of the solution
+/// @details The accessor is copied, so the writer can carry on changing the original
+/// @param[in] solution accessor to copy and publish
+/// @param[in] id solution ID (negative if unknown)
+/// @return version of the published snapshot
+casacore::uInt64 CalSolutionSnapshotHolder::publish(const CachedCalSolutionAccessor &solution, long id)
+{
+  const boost::shared_ptr<CachedCalSolutionAccessor> copy(new CachedCalSolutionAccessor(solution));
+  copy->syncStorage();
+  return publish(boost::shared_ptr<ICalSolutionConstAccessor const>(copy), id);
+}
+
+/// @brief publish the solution read by MemCalSolutionAccessor
+/// @details All available parameters are read before publication, so the readers don't
+/// access the filler (except for parameters which couldn't be read, see
+/// MemCalSolutionAccessor::prefetch). The accessor should not be modified after this call.
+/// @param[in] solution accessor to publish
+/// @param[in] id solution ID (negative if unknown)
+/// @return version of the published snapshot
+casacore::uInt64 CalSolutionSnapshotHolder::publish(const boost::shared_ptr<MemCalSolutionAccessor> &solution, long id)
+{
+  ASKAPCHECK(solution, "An attempt to publish an empty calibration solution");
+  solution->prefetch();
+  return publish(boost::shared_ptr<ICalSolutionConstAccessor const>(solution), id);
+}
+
+/// @brief obtain the current snapshot
+/// @return shared pointer to the snapshot, empty pointer if nothing has been published
+boost::shared_ptr<CalSolutionSnapshotHolder::Snapshot const> CalSolutionSnapshotHolder::snapshot() const
+{
+  return boost::atomic_load(&itsSnapshot);
+}
+
+/// @brief obtain the current solution
+/// @return shared pointer to the accessor, empty pointer if nothing has been published
+boost::shared_ptr<ICalSolutionConstAccessor const> CalSolutionSnapshotHolder::solution() const
+{
+  const boost::shared_ptr<Snapshot const> snap = snapshot();
+  return snap ? snap->itsSolution : boost::shared_ptr<ICalSolutionConstAccessor const>();
+}
+
+/// @return version of the current snapshot, zero if nothing has been published
+casacore::uInt64 CalSolutionSnapshotHolder::version() const
+{
+  const boost::shared_ptr<Snapshot const> snap = snapshot();
+  return snap ? snap->itsVersion : 0;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,129 @@
+/// @file
+///
+/// @brief Holder of the most recent calibration solution shared between threads
+/// @details In streaming processing, one thread may solve for calibration parameters
+/// while others apply the latest solution. Accessors are not thread-safe, so the readers
+/// would have to lock a mutex for every lookup. This class publishes immutable solution
+/// snapshots instead: the writer replaces the snapshot atomically and readers obtain a
+/// shared pointer to the current one once per chunk of data.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_CAL_SOLUTION_SNAPSHOT_HOLDER_H
+#define ASKAP_ACCESSORS_CAL_SOLUTION_SNAPSHOT_HOLDER_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+#include <askap/calibaccess/CachedCalSolutionAccessor.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+
+// casa includes
+#include <casacore/casa/aipsxtype.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <atomic>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Holder of the most recent calibration solution shared between threads
+/// @details Published snapshots are never changed, the writer sets up a new accessor for
+/// each solution. The current snapshot is replaced with the atomic store of the shared
+/// pointer and read with the atomic load (boost implements these with a small pool of
+/// spinlocks, there is no mutex held across the lookups). A reader keeps the snapshot as
+/// long as it needs it, the old solution is destroyed when the last reader releases it.
+///
+/// The published accessor should be safe to read from several threads, i.e. its const
+/// methods should not modify it. The overloads taking CachedCalSolutionAccessor and
+/// MemCalSolutionAccessor prepare these accessors accordingly.
+/// @ingroup calibaccess
+class CalSolutionSnapshotHolder : public boost::noncopyable {
+public:
+  /// @brief published solution
+  struct Snapshot {
+     /// @brief accessor to the solution, never changed after publication
+     boost::shared_ptr<ICalSolutionConstAccessor const> itsSolution;
+     /// @brief solution ID given by the writer (negative if unknown)
+     long itsID;
+     /// @brief sequence number of this snapshot, starting from 1
+     casacore::uInt64 itsVersion;
+  };
+
+  /// @brief set up an empty holder
+  CalSolutionSnapshotHolder();
+
+  /// @brief publish the solution
+  /// @details The accessor should not be modified after this call
+  /// @param[in] solution accessor to publish
+  /// @param[in] id solution ID (negative if unknown)
+  /// @return version of the published snapshot
+  casacore::uInt64 publish(const boost::shared_ptr<ICalSolutionConstAccessor const> &solution, long id = -1);
+
+  /// @brief publish a copy of the solution
+  /// @details The accessor is copied, so the writer can carry on changing the original
+  /// @param[in] solution accessor to copy and publish
+  /// @param[in] id solution ID (negative if unknown)
+  /// @return version of the published snapshot
+  casacore::uInt64 publish(const CachedCalSolutionAccessor &solution, long id = -1);
+
+  /// @brief publish the solution read by MemCalSolutionAccessor
+  /// @details All available parameters are read before publication, so the readers don't
+  /// access the filler (except for parameters which couldn't be read, see
+/// MemCalSolutionAccessor::prefetch). The accessor should not be modified after this call.
+  /// @param[in] solution accessor to publish
+  /// @param[in] id solution ID (negative if unknown)
+  /// @return version of the published snapshot
+  casacore::uInt64 publish(const boost::shared_ptr<MemCalSolutionAccessor> &solution, long id = -1);
+
+  /// @brief obtain the current snapshot
+  /// @return shared pointer to the snapshot, empty pointer if nothing has been published
+  boost::shared_ptr<Snapshot const> snapshot() const;
+
+  /// @brief obtain the current solution
+  /// @return shared pointer to the accessor, empty pointer if nothing has been published
+  boost::shared_ptr<ICalSolutionConstAccessor const> solution() const;
+
+  /// @return version of the current snapshot, zero if nothing has been published
+  casacore::uInt64 version() const;
+
+private:
+  /// @brief current snapshot, accessed with atomic operations only
+  boost::shared_ptr<Snapshot const> itsSnapshot;
+
+  /// @brief number of snapshots published so far
+  std::atomic<casacore::uInt64> itsNPublished;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CAL_SOLUTION_SNAPSHOT_HOLDER_H
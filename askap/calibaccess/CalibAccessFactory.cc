@@ -38,6 +38,9 @@
 #include <askap/calibaccess/TableCalSolutionSource.h>
 #include <askap/calibaccess/TableCalSolutionConstSource.h>
 #include <askap/calibaccess/ServiceCalSolutionSourceStub.h>
+#include <askap/calibaccess/AsyncCalSolutionSource.h>
+#include <askap/calibaccess/DistributedTableCalSolutionConstSource.h>
+#include <askap/calibaccess/BinaryCalSolutionConstSource.h>
 
 #include <askap/askap/AskapError.h>
 
@@ -64,6 +67,30 @@ boost::shared_ptr<ICalSolutionSource> CalibAccessFactory::rwCalSolutionSource(co
   return css;
 }
 
+/// @brief Build an appropriate read-only "calibration source" class in the parallel environment
+/// @details For the table-based implementation, the table is read by one process and
+/// distributed to all others (see DistributedTableCalSolutionConstSource), unless
+/// calibaccess.table.distributed is set to false. Other implementations are set up
+/// independently in each process. This is a collective operation, all processes should call it.
+/// @param[in] parset parameters containing description of the class to be constructed
+/// @param[in] comms communication object
+/// @return shared pointer to the calibration solution source object
+boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::roCalSolutionSource(const LOFAR::ParameterSet &parset,
+                                                                                  askapparallel::AskapParallel &comms)
+{
+  if (comms.isParallel() && (parset.getString("calibaccess","parset") == "table") &&
+      parset.getBool("calibaccess.table.distributed", true)) {
+      const std::string fname = parset.getString("calibaccess.table", "calibdata.tab");
+      if (comms.isMaster()) {
+          ASKAPLOG_INFO_STR(logger, "Calibration table "<<fname<<" is read by the master and distributed to "<<
+                            comms.nProcs() - 1<<" other process(es)");
+      }
+      boost::shared_ptr<ICalSolutionConstSource> result(new DistributedTableCalSolutionConstSource(comms, fname));
+      return result;
+  }
+  return roCalSolutionSource(parset);
+}
+
 /// @brief Build an appropriate "calibration source" class
 /// @details This is a factory method generating a shared pointer to the calibration
 /// solution source according to the parset file. The code for read-only and
@@ -75,8 +102,8 @@ boost::shared_ptr<ICalSolutionSource> CalibAccessFactory::rwCalSolutionSource(co
 boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::calSolutionSource(const LOFAR::ParameterSet &parset, bool readonly)
 {
    const std::string calAccType = parset.getString("calibaccess","parset");
-   ASKAPCHECK((calAccType == "parset") || (calAccType == "table") || (calAccType == "service"),
-       "Only parset-based, table-based and service-based implementations are supported by the calibration access factory at the moment; you request: "<<calAccType);
+   ASKAPCHECK((calAccType == "parset") || (calAccType == "table") || (calAccType == "service") || (calAccType == "binary"),
+       "Only parset-based, table-based, binary file-based and service-based implementations are supported by the calibration access factory at the moment; you request: "<<calAccType);
    boost::shared_ptr<ICalSolutionConstSource> result;
    if (calAccType == "parset") {
        const std::string fname = parset.getString("calibaccess.parset", "result.dat");
@@ -91,7 +118,20 @@ boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::calSolutionSource
        const std::string fname = parset.getString("calibaccess.table", "calibdata.tab");
        ASKAPLOG_INFO_STR(logger, "Using implementation of the calibration solution accessor working with casa table "<<fname);
        if (readonly) {
-           result.reset(new TableCalSolutionConstSource(fname));
+           boost::shared_ptr<TableCalSolutionConstSource> src(new TableCalSolutionConstSource(fname));
+           if (parset.getBool("calibaccess.table.shared", false)) {
+               const double timeout = parset.getDouble("calibaccess.table.sharedtimeout", 60.);
+               ASKAPLOG_INFO_STR(logger, "Calibration solutions will be shared between processes on the same node");
+               src->shareSolutions(true, timeout);
+           }
+           const bool prefetch = parset.getBool("calibaccess.table.prefetch", false);
+           const casacore::uInt cacheSize = parset.getUint32("calibaccess.table.cachesize", prefetch ? 2 : 0);
+           if (cacheSize > 0) {
+               ASKAPLOG_INFO_STR(logger, "Up to "<<cacheSize<<" calibration solutions will be cached"<<
+                                 (prefetch ? ", the next solution is read in background" : ""));
+               src->cacheSolutions(cacheSize, prefetch);
+           }
+           result = src;
        } else {
            const casacore::uInt maxAnt = parset.getUint32("calibaccess.table.maxant",36);
            const casacore::uInt maxBeam = parset.getUint32("calibaccess.table.maxbeam",30);
@@ -108,11 +148,33 @@ boost::shared_ptr<ICalSolutionConstSource> CalibAccessFactory::calSolutionSource
                ASKAPLOG_INFO_STR(logger, "A new table "<<fname<<" is to be created, any old file with the same name is going to be removed");
                TableCalSolutionSource::removeOldTable(fname);
            }
-           result.reset(new TableCalSolutionSource(fname,maxAnt,maxBeam,maxChan));
+           const boost::shared_ptr<TableCalSolutionSource> src(new TableCalSolutionSource(fname,maxAnt,maxBeam,maxChan));
+           const casacore::uInt batchSize = parset.getUint32("calibaccess.table.batchsize", 1);
+           if (batchSize > 1) {
+               ASKAPLOG_INFO_STR(logger, "The table is flushed to disk once per "<<batchSize<<" calibration solutions");
+               src->batchWrites(batchSize);
+           }
+           // tile size in bytes, zero means the default storage manager
+           src->setMaxTileSize(parset.getUint32("calibaccess.table.tilesize", 0));
+           result = src;
        }
+   } else if (calAccType == "binary") {
+       const std::string fname = parset.getString("calibaccess.binary", "calibdata.bin");
+       ASKAPCHECK(readonly, "Binary calibration solution file "<<fname<<" can only be read, use calibaccess=table to write solutions");
+       ASKAPLOG_INFO_STR(logger, "Using implementation of the calibration solution accessor working with memory-mapped binary file "<<fname);
+       result.reset(new BinaryCalSolutionConstSource(fname));
    } else if (calAccType == "service") {
       ASKAPLOG_INFO_STR(logger, "Using implementation of the calibration solution accessor working with the calibration service" );
-      result.reset(new ServiceCalSolutionSourceStub(parset));
+      const boost::shared_ptr<ICalSolutionSource> src(new ServiceCalSolutionSourceStub(parset));
+      if (parset.getBool("calibaccess.service.async", false)) {
+          const double pollInterval = parset.getDouble("calibaccess.service.pollinterval", 1.);
+          const casacore::uInt cacheSize = parset.getUint32("calibaccess.service.cachesize", 4);
+          ASKAPLOG_INFO_STR(logger, "The calibration service will be polled every "<<pollInterval<<
+                            " s in background, up to "<<cacheSize<<" solutions will be cached");
+          result.reset(new AsyncCalSolutionSource(src, pollInterval, cacheSize));
+      } else {
+          result = src;
+      }
    }
 
    ASKAPDEBUGASSERT(result);
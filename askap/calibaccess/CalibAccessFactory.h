@@ -42,6 +42,8 @@
 
 #include <Common/ParameterSet.h>
 
+#include <askap/askapparallel/AskapParallel.h>
+
 namespace askap {
 
 namespace accessors {
@@ -76,6 +78,17 @@ struct CalibAccessFactory {
    /// read-only method via read-write one.
    inline static boost::shared_ptr<ICalSolutionConstSource> roCalSolutionSource(const LOFAR::ParameterSet &parset)
       { return calSolutionSource(parset,true); }
+
+   /// @brief Build an appropriate read-only "calibration source" class in the parallel environment
+   /// @details For the table-based implementation, the table is read by one process and
+   /// distributed to all others (see DistributedTableCalSolutionConstSource), unless
+   /// calibaccess.table.distributed is set to false. Other implementations are set up
+   /// independently in each process. This is a collective operation, all processes should call it.
+   /// @param[in] parset parameters containing description of the class to be constructed
+   /// @param[in] comms communication object
+   /// @return shared pointer to the calibration solution source object
+   static boost::shared_ptr<ICalSolutionConstSource> roCalSolutionSource(const LOFAR::ParameterSet &parset,
+                                                                         askapparallel::AskapParallel &comms);
       
 protected:
    /// @brief Build an appropriate "calibration source" class
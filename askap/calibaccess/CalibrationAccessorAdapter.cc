@@ -0,0 +1,202 @@
+/// @file
+///
+/// @brief Adapter applying calibration solution to the visibilities of an accessor
+/// @details Applying calibration is usually done by looping over rows, channels and
+/// polarisations and obtaining JonesJTerm/JonesDTerm objects for each sample. This
+/// adapter gathers all terms for a beam with the bulk methods of ICalSolutionConstAccessor
+/// and applies the resulting matrices to the whole visibility cube in a single pass.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/CalibrationAccessorAdapter.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+#include <map>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct the adapter
+/// @param[in] acc accessor to calibrate
+/// @param[in] calSolution calibration solution to apply
+/// @param[in] correct if true, the inverse of the Jones matrices is applied (i.e. the
+///            data are corrected), otherwise the data are corrupted with the solution
+/// @param[in] startChan channel of the solution corresponding to the first channel of the accessor
+/// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid,
+///            otherwise the validity rule of jonesValid is used
+CalibrationAccessorAdapter::CalibrationAccessorAdapter(const IConstDataAccessor &acc,
+                             const ICalSolutionConstAccessor::ShPtr &calSolution,
+                             bool correct, casacore::uInt startChan, bool requireAllValid) :
+       MetaDataAccessor(acc), itsCalSolution(calSolution), itsCorrect(correct),
+       itsStartChan(startChan), itsRequireAllValid(requireAllValid), itsCacheValid(false)
+{
+  ASKAPCHECK(itsCalSolution, "An attempt to initialise CalibrationAccessorAdapter with empty solution");
+}
+
+/// @brief construct the adapter using precomputed Jones matrices
+/// @details The direction of calibration and the validity rule are defined by the cache.
+/// @param[in] acc accessor to calibrate
+/// @param[in] jonesCache cached matrices
+/// @param[in] startChan channel of the solution corresponding to the first channel of the
+///            accessor, it should be within the range of channels cached
+CalibrationAccessorAdapter::CalibrationAccessorAdapter(const IConstDataAccessor &acc,
+                             const JonesMatrixCache::ShPtr &jonesCache, casacore::uInt startChan) :
+       MetaDataAccessor(acc), itsJonesCache(jonesCache), itsCorrect(true), itsStartChan(startChan),
+       itsRequireAllValid(true), itsCacheValid(false)
+{
+  ASKAPCHECK(itsJonesCache, "An attempt to initialise CalibrationAccessorAdapter with empty Jones matrix cache");
+  ASKAPCHECK(itsStartChan >= itsJonesCache->startChan(), "Channel "<<itsStartChan<<
+             " is not in the Jones matrix cache which starts from channel "<<itsJonesCache->startChan());
+  itsCorrect = itsJonesCache->correcting();
+  itsRequireAllValid = itsJonesCache->requireAllValid();
+}
+
+/// @brief calibrated visibilities
+/// @return a reference to nRow x nChannel x nPol cube
+const casacore::Cube<casacore::Complex>& CalibrationAccessorAdapter::visibility() const
+{
+  if (!itsCacheValid) {
+      apply();
+  }
+  return itsVisibility;
+}
+
+/// @brief flags updated for invalid calibration
+/// @return a reference to nRow x nChannel x nPol cube with flag
+///         information. If True, the corresponding element is flagged.
+const casacore::Cube<casacore::Bool>& CalibrationAccessorAdapter::flag() const
+{
+  if (!itsCacheValid) {
+      apply();
+  }
+  return itsFlag;
+}
+
+/// @brief discard the cached result
+/// @details This method should be called if the content of the wrapped accessor
+/// or the calibration solution has changed.
+void CalibrationAccessorAdapter::invalidate()
+{
+  itsCacheValid = false;
+}
+
+/// @brief calibrate the data and fill the cache
+void CalibrationAccessorAdapter::apply() const
+{
+  const IConstDataAccessor &acc = getROAccessor();
+  const casacore::uInt nRow = acc.nRow();
+  const casacore::uInt nChan = acc.nChannel();
+  const casacore::uInt nPol = acc.nPol();
+  ASKAPCHECK(nPol == 4, "CalibrationAccessorAdapter supports only full polarisation data, nPol = "<<nPol);
+  const casacore::Vector<casacore::Stokes::StokesTypes> &stokes = acc.stokes();
+  ASKAPCHECK(stokes.nelements() == 4 && stokes[0] == casacore::Stokes::XX && stokes[1] == casacore::Stokes::XY &&
+             stokes[2] == casacore::Stokes::YX && stokes[3] == casacore::Stokes::YY,
+             "CalibrationAccessorAdapter expects XX, XY, YX, YY polarisation products");
+  const casacore::Vector<casacore::uInt> &antenna1 = acc.antenna1();
+  const casacore::Vector<casacore::uInt> &antenna2 = acc.antenna2();
+  const casacore::Vector<casacore::uInt> &feed1 = acc.feed1();
+  const casacore::Vector<casacore::uInt> &feed2 = acc.feed2();
+
+  casacore::uInt nAnt = 0;
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       ASKAPCHECK(feed1[row] == feed2[row], "Cross-beam correlations are not supported, row "<<row<<
+                  " correlates beams "<<feed1[row]<<" and "<<feed2[row]);
+       nAnt = std::max(nAnt, std::max(antenna1[row], antenna2[row]) + 1);
+  }
+
+  itsVisibility.assign(acc.visibility());
+  itsFlag.assign(acc.flag());
+  ASKAPDEBUGASSERT(itsVisibility.contiguousStorage() && itsFlag.contiguousStorage());
+
+  if (itsJonesCache) {
+      // use precomputed matrices, only the offset to the first channel is required
+      const casacore::uInt chanOffset = itsStartChan - itsJonesCache->startChan();
+      ASKAPCHECK(chanOffset + nChan <= itsJonesCache->nChan(), "Jones matrix cache has "<<
+                 itsJonesCache->nChan()<<" channel(s) starting from "<<itsJonesCache->startChan()<<
+                 ", accessor requires "<<nChan<<" channel(s) starting from "<<itsStartChan);
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           applyToRow(row, itsJonesCache->matrices(antenna1[row], feed1[row]) + 4 * chanOffset,
+                      itsJonesCache->matrices(antenna2[row], feed1[row]) + 4 * chanOffset,
+                      itsJonesCache->validity(antenna1[row], feed1[row]) + chanOffset,
+                      itsJonesCache->validity(antenna2[row], feed1[row]) + chanOffset);
+      }
+      itsCacheValid = true;
+      return;
+  }
+
+  // compose Jones matrices once per beam present in the accessor
+  std::map<casacore::uInt, BeamJones> beamJones;
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       if (beamJones.find(feed1[row]) == beamJones.end()) {
+           JonesMatrixCache::fillBeamJones(*itsCalSolution, feed1[row], nAnt, itsStartChan, nChan,
+                                           itsCorrect, itsRequireAllValid, beamJones[feed1[row]]);
+       }
+  }
+  std::map<casacore::uInt, BeamJones>::const_iterator ci = beamJones.end();
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       if (ci == beamJones.end() || ci->first != feed1[row]) {
+           ci = beamJones.find(feed1[row]);
+           ASKAPDEBUGASSERT(ci != beamJones.end());
+       }
+       const BeamJones &bj = ci->second;
+       applyToRow(row, &bj.itsMatrices[4 * size_t(antenna1[row]) * nChan],
+                  &bj.itsMatrices[4 * size_t(antenna2[row]) * nChan],
+                  &bj.itsValid[size_t(antenna1[row]) * nChan], &bj.itsValid[size_t(antenna2[row]) * nChan]);
+  }
+  itsCacheValid = true;
+}
+
+/// @brief apply the given matrices to a single row
+/// @param[in] row row index
+/// @param[in] jones1 matrices for the first antenna (4 elements per channel)
+/// @param[in] jones2 matrices for the second antenna (4 elements per channel)
+/// @param[in] valid1 validity flags for the first antenna (one per channel)
+/// @param[in] valid2 validity flags for the second antenna (one per channel)
+void CalibrationAccessorAdapter::applyToRow(casacore::uInt row, const casacore::Complex *jones1,
+                  const casacore::Complex *jones2, const casacore::uChar *valid1,
+                  const casacore::uChar *valid2) const
+{
+  const casacore::uInt nRow = itsVisibility.nrow();
+  const casacore::uInt nChan = itsVisibility.ncolumn();
+  casacore::Complex *visData = itsVisibility.data();
+  casacore::Bool *flagData = itsFlag.data();
+  const size_t polStride = size_t(nRow) * nChan;
+  for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+       const size_t offset = size_t(chan) * nRow + row;
+       casacore::Complex vis[4] = {visData[offset], visData[offset + polStride],
+                                   visData[offset + 2 * polStride], visData[offset + 3 * polStride]};
+       // invalid matrices are zero, so no branch is required in the kernel
+       applyJones(jones1 + 4 * chan, jones2 + 4 * chan, vis);
+       const bool invalid = !(valid1[chan] && valid2[chan]);
+       for (casacore::uInt pol = 0; pol < 4; ++pol) {
+            visData[offset + pol * polStride] = vis[pol];
+            flagData[offset + pol * polStride] |= invalid;
+       }
+  }
+}
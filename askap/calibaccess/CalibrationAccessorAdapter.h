@@ -0,0 +1,184 @@
+/// @file
+///
+/// @brief Adapter applying calibration solution to the visibilities of an accessor
+/// @details Applying calibration is usually done by looping over rows, channels and
+/// polarisations and obtaining JonesJTerm/JonesDTerm objects for each sample. This
+/// adapter gathers all terms for a beam with the bulk methods of ICalSolutionConstAccessor,
+/// composes (and, for correction, inverts) the 2x2 Jones matrices once per antenna and
+/// channel and then applies them to the whole visibility cube in a single pass.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_CALIBRATION_ACCESSOR_ADAPTER_H
+#define ASKAP_ACCESSORS_CALIBRATION_ACCESSOR_ADAPTER_H
+
+// own includes
+#include <askap/dataaccess/MetaDataAccessor.h>
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+#include <askap/calibaccess/JonesMatrixCache.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Adapter applying calibration solution to the visibilities of an accessor
+/// @details All metadata are taken from the wrapped accessor, visibility() and flag()
+/// return the calibrated visibilities and the updated flags. The visibility for the baseline
+/// between antennas 1 and 2 is replaced by J1^{-1} V J2^{-1 H} in the correction mode and
+/// by J1 V J2^H otherwise, where V is the 2x2 matrix of XX, XY, YX and YY products and
+/// J is the Jones matrix composed the same way as ICalSolutionConstAccessor::jones does.
+/// Samples with an invalid (or, for correction, singular) Jones matrix for either antenna
+/// are flagged and set to zero. By default, the Jones matrix is considered valid only if
+/// all its constituents are (see ICalSolutionConstAccessor::jonesAllValid), the more
+/// relaxed rule of ICalSolutionConstAccessor::jonesValid can be selected instead.
+///
+/// The result is computed at the first call to visibility() or flag() and cached. Like
+/// for other adapters derived from MetaDataAccessor, the wrapped accessor is held by
+/// reference. If its content changes (e.g. the iterator advanced), invalidate() should
+/// be called. If the same solution is applied to many accessors, the matrices can be
+/// computed once with JonesMatrixCache and passed to the adapter instead of the solution.
+/// Only full polarisation data with linear products in the canonical order
+/// are supported, the noise is passed through unchanged.
+/// @ingroup calibaccess
+class CalibrationAccessorAdapter : public MetaDataAccessor
+{
+public:
+  /// @brief construct the adapter
+  /// @param[in] acc accessor to calibrate
+  /// @param[in] calSolution calibration solution to apply
+  /// @param[in] correct if true, the inverse of the Jones matrices is applied (i.e. the
+  ///            data are corrected), otherwise the data are corrupted with the solution
+  /// @param[in] startChan channel of the solution corresponding to the first channel of the accessor
+  /// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid,
+  ///            otherwise the validity rule of jonesValid is used
+  CalibrationAccessorAdapter(const IConstDataAccessor &acc,
+                             const ICalSolutionConstAccessor::ShPtr &calSolution,
+                             bool correct = true, casacore::uInt startChan = 0,
+                             bool requireAllValid = true);
+
+  /// @brief construct the adapter using precomputed Jones matrices
+  /// @details The direction of calibration and the validity rule are defined by the cache.
+  /// @param[in] acc accessor to calibrate
+  /// @param[in] jonesCache cached matrices
+  /// @param[in] startChan channel of the solution corresponding to the first channel of the
+  ///            accessor, it should be within the range of channels cached
+  CalibrationAccessorAdapter(const IConstDataAccessor &acc, const JonesMatrixCache::ShPtr &jonesCache,
+                             casacore::uInt startChan);
+
+  /// @brief calibrated visibilities
+  /// @return a reference to nRow x nChannel x nPol cube
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// @brief flags updated for invalid calibration
+  /// @return a reference to nRow x nChannel x nPol cube with flag
+  ///         information. If True, the corresponding element is flagged.
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+  /// @brief discard the cached result
+  /// @details This method should be called if the content of the wrapped accessor
+  /// or the calibration solution has changed.
+  void invalidate();
+
+  /// @return true, if the data are corrected (i.e. inverse Jones matrices are applied)
+  inline bool correcting() const { return itsCorrect; }
+
+  /// @brief apply two 2x2 matrices to the visibility matrix
+  /// @details The result is A V B^H, where all matrices are stored as 4 consecutive
+  /// elements in the row-major order (i.e. XX, XY, YX, YY for the visibility)
+  /// @param[in] a matrix of the first antenna
+  /// @param[in] b matrix of the second antenna
+  /// @param[in,out] vis visibility matrix
+  static inline void applyJones(const casacore::Complex *a, const casacore::Complex *b,
+                                casacore::Complex *vis)
+  {
+    const casacore::Complex t00 = a[0] * vis[0] + a[1] * vis[2];
+    const casacore::Complex t01 = a[0] * vis[1] + a[1] * vis[3];
+    const casacore::Complex t10 = a[2] * vis[0] + a[3] * vis[2];
+    const casacore::Complex t11 = a[2] * vis[1] + a[3] * vis[3];
+    const casacore::Complex b00 = conj(b[0]);
+    const casacore::Complex b01 = conj(b[1]);
+    const casacore::Complex b10 = conj(b[2]);
+    const casacore::Complex b11 = conj(b[3]);
+    vis[0] = t00 * b00 + t01 * b01;
+    vis[1] = t00 * b10 + t01 * b11;
+    vis[2] = t10 * b00 + t11 * b01;
+    vis[3] = t10 * b10 + t11 * b11;
+  }
+
+private:
+  /// @brief Jones matrices for all antennas and channels of one beam
+  typedef JonesMatrixCache::BeamJones BeamJones;
+
+  /// @brief calibrate the data and fill the cache
+  void apply() const;
+
+  /// @brief apply the given matrices to a single row
+  /// @param[in] row row index
+  /// @param[in] jones1 matrices for the first antenna (4 elements per channel)
+  /// @param[in] jones2 matrices for the second antenna (4 elements per channel)
+  /// @param[in] valid1 validity flags for the first antenna (one per channel)
+  /// @param[in] valid2 validity flags for the second antenna (one per channel)
+  void applyToRow(casacore::uInt row, const casacore::Complex *jones1, const casacore::Complex *jones2,
+                  const casacore::uChar *valid1, const casacore::uChar *valid2) const;
+
+  /// @brief calibration solution, empty if the cached matrices are used
+  ICalSolutionConstAccessor::ShPtr itsCalSolution;
+
+  /// @brief cached matrices, empty if the matrices are computed from the solution
+  JonesMatrixCache::ShPtr itsJonesCache;
+
+  /// @brief true, if the data are to be corrected
+  bool itsCorrect;
+
+  /// @brief solution channel corresponding to the first channel of the accessor
+  casacore::uInt itsStartChan;
+
+  /// @brief true, if all constituents of the Jones matrix are required to be valid
+  bool itsRequireAllValid;
+
+  /// @brief true, if cached visibilities and flags are up to date
+  mutable bool itsCacheValid;
+
+  /// @brief calibrated visibilities
+  mutable casacore::Cube<casacore::Complex> itsVisibility;
+
+  /// @brief updated flags
+  mutable casacore::Cube<casacore::Bool> itsFlag;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CALIBRATION_ACCESSOR_ADAPTER_H
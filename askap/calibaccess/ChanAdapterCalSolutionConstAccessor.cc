@@ -42,10 +42,33 @@ namespace accessors {
 /// is wrapped around and the channel offset
 /// @param[in] acc shared pointer to the original accessor to wrap
 /// @param[in] offset channel offset to add to bandpass request
+/// @note If acc is an adapter itself, the accessor it wraps is used with the combined
+/// offset, so nested adapters cost a single indirection.
 ChanAdapterCalSolutionConstAccessor::ChanAdapterCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc, const casacore::uInt offset) :
-        itsAccessor(acc), itsOffset(offset)
+        itsAccessor(originalAccessor(acc)), itsOffset(offset + originalOffset(acc))
+{
+   ASKAPASSERT(itsAccessor);
+}
+
+/// @brief helper method to get the innermost accessor
+/// @param[in] acc accessor passed to the constructor
+/// @return accessor wrapped by acc if it is an adapter, acc otherwise
+boost::shared_ptr<ICalSolutionConstAccessor> ChanAdapterCalSolutionConstAccessor::originalAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc)
 {
    ASKAPASSERT(acc);
+   const boost::shared_ptr<ChanAdapterCalSolutionConstAccessor> adapter =
+         boost::dynamic_pointer_cast<ChanAdapterCalSolutionConstAccessor>(acc);
+   return adapter ? adapter->accessor() : acc;
+}
+
+/// @brief helper method to get the offset already applied by the accessor
+/// @param[in] acc accessor passed to the constructor
+/// @return channel offset of acc if it is an adapter, zero otherwise
+casacore::uInt ChanAdapterCalSolutionConstAccessor::originalOffset(const boost::shared_ptr<ICalSolutionConstAccessor> &acc)
+{
+   const boost::shared_ptr<ChanAdapterCalSolutionConstAccessor> adapter =
+         boost::dynamic_pointer_cast<ChanAdapterCalSolutionConstAccessor>(acc);
+   return adapter ? adapter->offset() : 0u;
 }
 
 /// @brief obtain gains (J-Jones)
@@ -114,5 +137,59 @@ IonoTerm ChanAdapterCalSolutionConstAccessor::ionoparam(const JonesIndex &index)
    return itsAccessor->ionoparam(index);
 }
 
+void ChanAdapterCalSolutionConstAccessor::gainsForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                             casacore::Matrix<casacore::Complex> &gains,
+                             casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsAccessor->gainsForBeam(beam, nAnt, gains, valid);
+}
+
+void ChanAdapterCalSolutionConstAccessor::leakagesForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsAccessor->leakagesForBeam(beam, nAnt, leakages, valid);
+}
+
+void ChanAdapterCalSolutionConstAccessor::bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &gains,
+                                casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsAccessor->bandpassForBeam(beam, nAnt, startChan + itsOffset, nChan, gains, valid);
+}
+
+void ChanAdapterCalSolutionConstAccessor::bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                 const casacore::uInt startChan, const casacore::uInt nChan,
+                                 casacore::Matrix<casacore::Complex> &leakages,
+                                 casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsAccessor->bpleakageForBeam(beam, nAnt, startChan + itsOffset, nChan, leakages, valid);
+}
+
+void ChanAdapterCalSolutionConstAccessor::ionoparamsForBeam(const casacore::uInt beam, const casacore::uInt nParams,
+                                  casacore::Vector<casacore::Float> &params,
+                                  casacore::Vector<casacore::Bool> &valid) const
+{
+   itsAccessor->ionoparamsForBeam(beam, nParams, params, valid);
+}
+
+void ChanAdapterCalSolutionConstAccessor::ionoparams(const casacore::uInt nParams, const casacore::uInt nBeam,
+                           casacore::Matrix<casacore::Float> &params,
+                           casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsAccessor->ionoparams(nParams, nBeam, params, valid);
+}
+
+/// @brief obtain validity of the constituents of the Jones matrix
+/// @details The call is passed to the original accessor with the channel offset applied.
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel of interest
+/// @return bitwise combination of ValidityFlags for the terms which are valid
+casacore::uInt ChanAdapterCalSolutionConstAccessor::validity(const JonesIndex &index, const casacore::uInt chan) const
+{
+   return itsAccessor->validity(index, chan + itsOffset);
+}
+
 } // namespace accessors
 } // namespace askap
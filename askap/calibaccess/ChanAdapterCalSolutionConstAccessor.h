@@ -56,8 +56,16 @@ struct ChanAdapterCalSolutionConstAccessor : public ICalSolutionConstAccessor {
    /// is wrapped around and the channel offset
    /// @param[in] acc shared pointer to the original accessor to wrap
    /// @param[in] offset channel offset to add to bandpass request
+   /// @note If acc is an adapter itself, the accessor it wraps is used with the combined
+   /// offset, so nested adapters cost a single indirection.
    ChanAdapterCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc, const casacore::uInt offset);
 
+   /// @return shared pointer to the original accessor
+   inline const boost::shared_ptr<ICalSolutionConstAccessor>& accessor() const { return itsAccessor; }
+
+   /// @return channel offset added to bandpass requests
+   inline casacore::uInt offset() const { return itsOffset; }
+
    /// @brief obtain gains (J-Jones)
    /// @details This method retrieves parallel-hand gains for both
    /// polarisations (corresponding to XX and YY). If no gains are defined
@@ -110,9 +118,92 @@ struct ChanAdapterCalSolutionConstAccessor : public ICalSolutionConstAccessor {
    /// @return IonoTerm object with gains and validity flags
    virtual IonoTerm ionoparam(const JonesIndex &index) const;
 
+   /// @brief obtain gains for all antennas of one beam
+   /// @details The call is passed to the original accessor.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] gains 2 x nAnt matrix with gains, first row is XX, second is YY (resized as necessary)
+   /// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+   virtual void gainsForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                             casacore::Matrix<casacore::Complex> &gains,
+                             casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain leakages for all antennas of one beam
+   /// @details The call is passed to the original accessor.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] leakages 2 x nAnt matrix with leakages, first row is XY, second is YX (resized as necessary)
+   /// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+   virtual void leakagesForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain bandpass for all antennas of one beam over a range of channels
+   /// @details The call is passed to the original accessor with the channel offset applied.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] gains (2*nChan) x nAnt matrix with gains (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   virtual void bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &gains,
+                                casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain bandpass leakages for all antennas of one beam over a range of channels
+   /// @details The call is passed to the original accessor with the channel offset applied.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] leakages (2*nChan) x nAnt matrix with leakages (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   virtual void bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                 const casacore::uInt startChan, const casacore::uInt nChan,
+                                 casacore::Matrix<casacore::Complex> &leakages,
+                                 casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain ionospheric parameters for one direction
+   /// @details The call is passed to the original accessor.
+   /// @param[in] beam direction (beam) index
+   /// @param[in] nParams number of parameters
+   /// @param[out] params vector with nParams values (resized as necessary)
+   /// @param[out] valid vector with nParams validity flags (resized as necessary)
+   virtual void ionoparamsForBeam(const casacore::uInt beam, const casacore::uInt nParams,
+                                  casacore::Vector<casacore::Float> &params,
+                                  casacore::Vector<casacore::Bool> &valid) const;
+
+   /// @brief obtain all ionospheric parameters of the solution
+   /// @details The call is passed to the original accessor.
+   /// @param[in] nParams number of parameters per direction
+   /// @param[in] nBeam number of directions (beams)
+   /// @param[out] params nParams x nBeam matrix with values (resized as necessary)
+   /// @param[out] valid nParams x nBeam matrix with validity flags (resized as necessary)
+   virtual void ionoparams(const casacore::uInt nParams, const casacore::uInt nBeam,
+                           casacore::Matrix<casacore::Float> &params,
+                           casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain validity of the constituents of the Jones matrix
+   /// @details The call is passed to the original accessor with the channel offset applied.
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest
+   /// @return bitwise combination of ValidityFlags for the terms which are valid
+   virtual casacore::uInt validity(const JonesIndex &index, const casacore::uInt chan) const;
+
    /// @brief shared pointer definition
    typedef boost::shared_ptr<ChanAdapterCalSolutionConstAccessor> ShPtr;
 private:
+   /// @brief helper method to get the innermost accessor
+   /// @param[in] acc accessor passed to the constructor
+   /// @return accessor wrapped by acc if it is an adapter, acc otherwise
+   static boost::shared_ptr<ICalSolutionConstAccessor> originalAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &acc);
+
+   /// @brief helper method to get the offset already applied by the accessor
+   /// @param[in] acc accessor passed to the constructor
+   /// @return channel offset of acc if it is an adapter, zero otherwise
+   static casacore::uInt originalOffset(const boost::shared_ptr<ICalSolutionConstAccessor> &acc);
+
    /// @brief original accessor
    const boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor;
 
@@ -41,11 +41,13 @@ namespace accessors {
 
 /// @brief set up the adapter
 /// @details The constructor sets the shared pointer to the source which
-/// is wrapped around and the channel offset
+/// is wrapped around and the channel offset. If the number of channels is given,
+/// the source is asked for this range of channels only.
 /// @param[in] src shared pointer to the original source
 /// @param[in] offset channel offset to add to bandpass value request
-ChanAdapterCalSolutionConstSource::ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, const casacore::uInt offset) :
-    itsSource(src), itsOffset(offset)
+/// @param[in] nChan number of channels accessed via this adapter, zero means unknown
+ChanAdapterCalSolutionConstSource::ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src,
+    const casacore::uInt offset, const casacore::uInt nChan) : itsSource(src), itsOffset(offset), itsNChan(nChan)
 {
    ASKAPASSERT(src);
 }
@@ -77,6 +79,9 @@ long ChanAdapterCalSolutionConstSource::solutionID(const double time) const
 /// @return shared pointer to an accessor object
 boost::shared_ptr<ICalSolutionConstAccessor> ChanAdapterCalSolutionConstSource::roSolution(const long id) const
 {
+   if (itsNChan > 0) {
+       return itsSource->roSolutionForChannels(id, itsOffset, itsNChan);
+   }
    const boost::shared_ptr<ChanAdapterCalSolutionConstAccessor> result(new ChanAdapterCalSolutionConstAccessor(itsSource->roSolution(id),
           itsOffset));
    ASKAPDEBUGASSERT(result);
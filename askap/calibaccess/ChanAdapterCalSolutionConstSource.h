@@ -50,10 +50,15 @@ struct ChanAdapterCalSolutionConstSource  : public ICalSolutionConstSource {
 
    /// @brief set up the adapter
    /// @details The constructor sets the shared pointer to the source which
-   /// is wrapped around and the channel offset
+   /// is wrapped around and the channel offset. If the number of channels is given,
+   /// the source is asked for this range of channels only (see
+   /// ICalSolutionConstSource::roSolutionForChannels), which allows it to avoid reading
+   /// the whole bandpass.
    /// @param[in] src shared pointer to the original source
    /// @param[in] offset channel offset to add to bandpass value request
-   ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, const casacore::uInt offset);
+   /// @param[in] nChan number of channels accessed via this adapter, zero means unknown
+   ChanAdapterCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src, const casacore::uInt offset,
+                                     const casacore::uInt nChan = 0);
   
    /// @brief obtain ID for the most recent solution
    /// @return ID for the most recent solution
@@ -86,6 +91,9 @@ private:
    /// @brief channel offset
    const casacore::uInt itsOffset;
 
+   /// @brief number of channels, zero if unknown
+   const casacore::uInt itsNChan;
+
 };
 
 } // namespace accessors
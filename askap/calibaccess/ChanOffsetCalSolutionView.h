@@ -0,0 +1,152 @@
+/// @file
+///
+/// @brief Non-virtual view of a calibration solution with a channel offset
+/// @details ChanAdapterCalSolutionConstAccessor adds a fixed offset to the channel
+/// number of bandpass requests, but each call goes through the virtual interface of
+/// both the adapter and the original accessor. This template does the same for an
+/// accessor of a known concrete type, so the calls can be inlined in tight loops.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_CHAN_OFFSET_CAL_SOLUTION_VIEW_H
+#define ASKAP_ACCESSORS_CHAN_OFFSET_CAL_SOLUTION_VIEW_H
+
+// own includes
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/calibaccess/JonesJTerm.h>
+#include <askap/calibaccess/JonesDTerm.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Non-virtual view of a calibration solution with a channel offset
+/// @details The view holds a reference to the accessor, which should outlive it.
+/// Methods of Acc are called with explicit qualification, so no virtual dispatch
+/// happens. Therefore, Acc should be the actual (most derived) type of the accessor,
+/// e.g. MemCalSolutionAccessor, rather than an interface. The view is intended to
+/// be created on the stack for the duration of a loop, use
+/// ChanAdapterCalSolutionConstAccessor where an ICalSolutionConstAccessor is required.
+/// @ingroup calibaccess
+template<typename Acc>
+class ChanOffsetCalSolutionView {
+public:
+   /// @brief set up the view
+   /// @param[in] acc accessor to wrap (a reference is held)
+   /// @param[in] offset channel offset to add to bandpass requests
+   ChanOffsetCalSolutionView(const Acc &acc, const casacore::uInt offset) : itsAccessor(acc), itsOffset(offset) {}
+
+   /// @return wrapped accessor
+   inline const Acc& accessor() const { return itsAccessor; }
+
+   /// @return channel offset added to bandpass requests
+   inline casacore::uInt offset() const { return itsOffset; }
+
+   /// @brief obtain gains (J-Jones)
+   /// @param[in] index ant/beam index
+   /// @return JonesJTerm object with gains and validity flags
+   inline JonesJTerm gain(const JonesIndex &index) const { return itsAccessor.Acc::gain(index); }
+
+   /// @brief obtain leakage (D-Jones)
+   /// @param[in] index ant/beam index
+   /// @return JonesDTerm object with leakages and validity flags
+   inline JonesDTerm leakage(const JonesIndex &index) const { return itsAccessor.Acc::leakage(index); }
+
+   /// @brief obtain bandpass (frequency dependent J-Jones)
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest (offset is added)
+   /// @return JonesJTerm object with gains and validity flags
+   inline JonesJTerm bandpass(const JonesIndex &index, const casacore::uInt chan) const
+      { return itsAccessor.Acc::bandpass(index, chan + itsOffset); }
+
+   /// @brief obtain bandpass leakage (D-Jones)
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest (offset is added)
+   /// @return JonesDTerm object with leakages and validity flags
+   inline JonesDTerm bpleakage(const JonesIndex &index, const casacore::uInt chan) const
+      { return itsAccessor.Acc::bpleakage(index, chan + itsOffset); }
+
+   /// @brief obtain validity of the constituents of the Jones matrix
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest (offset is added)
+   /// @return bitwise combination of ICalSolutionConstAccessor::ValidityFlags for the terms which are valid
+   inline casacore::uInt validity(const JonesIndex &index, const casacore::uInt chan) const
+      { return itsAccessor.Acc::validity(index, chan + itsOffset); }
+
+   /// @brief obtain bandpass for all antennas of one beam over a range of channels
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel (offset is added)
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] gains (2*nChan) x nAnt matrix with gains (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   inline void bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                               const casacore::uInt startChan, const casacore::uInt nChan,
+                               casacore::Matrix<casacore::Complex> &gains,
+                               casacore::Matrix<casacore::Bool> &valid) const
+      { itsAccessor.Acc::bandpassForBeam(beam, nAnt, startChan + itsOffset, nChan, gains, valid); }
+
+   /// @brief obtain bandpass leakages for all antennas of one beam over a range of channels
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel (offset is added)
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] leakages (2*nChan) x nAnt matrix with leakages (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   inline void bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const
+      { itsAccessor.Acc::bpleakageForBeam(beam, nAnt, startChan + itsOffset, nChan, leakages, valid); }
+
+private:
+   /// @brief wrapped accessor
+   const Acc &itsAccessor;
+
+   /// @brief channel offset to apply
+   const casacore::uInt itsOffset;
+};
+
+/// @brief helper function to create a view with the type deduced from the accessor
+/// @param[in] acc accessor to wrap (a reference is held)
+/// @param[in] offset channel offset to add to bandpass requests
+/// @return view object
+template<typename Acc>
+inline ChanOffsetCalSolutionView<Acc> chanOffsetView(const Acc &acc, const casacore::uInt offset)
+{
+   return ChanOffsetCalSolutionView<Acc>(acc, offset);
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CHAN_OFFSET_CAL_SOLUTION_VIEW_H
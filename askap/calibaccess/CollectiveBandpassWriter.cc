@@ -0,0 +1,278 @@
+/// @file
+///
+/// @brief Writer of a range of bandpass channels into a shared calibration table
+/// @details Each process writes its own range of bandpass channels into the table
+/// row prepared in advance, the table is locked while writing.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/CollectiveBandpassWriter.h>
+#include <askap/calibaccess/TableCalSolutionSource.h>
+#include <askap/calibaccess/TableCalSolutionFiller.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableLock.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/IO/FileLocker.h>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+ASKAP_LOGGER(logger, ".calibaccess.CollectiveBandpassWriter");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief prepare the solution and open the table
+/// @details This is a collective operation, all processes should call it. The root
+/// process creates the new solution and sends its ID to all other processes.
+/// @param[in] comms communication object
+/// @param[in] fname file name of the calibration table (created if doesn't exist)
+/// @param[in] time time stamp of the new solution in seconds since MJD of 0.
+/// @param[in] nAnt number of antennas
+/// @param[in] nBeam number of beams
+/// @param[in] nChan total number of spectral channels
+/// @param[in] startChan first channel written by this process
+/// @param[in] nLocalChan number of channels written by this process
+/// @param[in] root rank of the process creating the solution
+CollectiveBandpassWriter::CollectiveBandpassWriter(askapparallel::AskapParallel &comms, const std::string &fname,
+         const double time, const casacore::uInt nAnt, const casacore::uInt nBeam, const casacore::uInt nChan,
+         const casacore::uInt startChan, const casacore::uInt nLocalChan, int root) :
+         TableHolder(casacore::Table()), TableBufferManager(casacore::Table()), itsID(-1),
+         itsStartChan(startChan), itsNLocalChan(nLocalChan), itsBandpassesChanged(false),
+         itsBPLeakagesChanged(false)
+{
+  ASKAPCHECK(startChan + nLocalChan <= nChan, "Channels "<<startChan<<" to "<<startChan + nLocalChan - 1<<
+             " are outside the bandpass with "<<nChan<<" channels");
+  const int nProcs = comms.nProcs();
+  ASKAPCHECK((root >= 0) && (root < nProcs), "Root rank "<<root<<" is outside the range of "<<nProcs<<" processes");
+  // the ID is sent to other processes after the table row is ready, so the message also
+  // serves as a barrier
+  LOFAR::BlobString bs;
+  bs.resize(0);
+  if (comms.rank() == root) {
+      itsID = prepareSolution(fname, time, nAnt, nBeam, nChan);
+      LOFAR::BlobOBufString bob(bs);
+      LOFAR::BlobOStream out(bob);
+      out.putStart("CollectiveBandpassWriter", 1);
+      out<<static_cast<LOFAR::int64>(itsID);
+      out.putEnd();
+      for (int rank = 0; rank < nProcs; ++rank) {
+           if (rank != root) {
+               comms.sendBlob(bs, rank);
+           }
+      }
+  } else {
+      comms.receiveBlob(bs, root);
+      LOFAR::BlobIBufString bib(bs);
+      LOFAR::BlobIStream in(bib);
+      const int version = in.getStart("CollectiveBandpassWriter");
+      ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the packed solution ID");
+      LOFAR::int64 id;
+      in>>id;
+      in.getEnd();
+      itsID = static_cast<long>(id);
+  }
+  openTable(fname);
+}
+
+/// @brief open the table for the solution prepared already
+/// @param[in] fname file name of the calibration table
+/// @param[in] id solution ID returned by prepareSolution
+/// @param[in] startChan first channel written by this object
+/// @param[in] nLocalChan number of channels written by this object
+CollectiveBandpassWriter::CollectiveBandpassWriter(const std::string &fname, const long id,
+         const casacore::uInt startChan, const casacore::uInt nLocalChan) :
+         TableHolder(casacore::Table()), TableBufferManager(casacore::Table()), itsID(id),
+         itsStartChan(startChan), itsNLocalChan(nLocalChan), itsBandpassesChanged(false),
+         itsBPLeakagesChanged(false)
+{
+  openTable(fname);
+}
+
+/// @brief destructor, writes the values if necessary
+CollectiveBandpassWriter::~CollectiveBandpassWriter()
+{
+  flush();
+}
+
+/// @brief create a new solution with bandpass cells sized for all channels
+/// @details This method is called by one process only.
+/// @param[in] fname file name of the calibration table (created if doesn't exist)
+/// @param[in] time time stamp of the new solution in seconds since MJD of 0.
+/// @param[in] nAnt number of antennas
+/// @param[in] nBeam number of beams
+/// @param[in] nChan total number of spectral channels
+/// @return solution ID
+long CollectiveBandpassWriter::prepareSolution(const std::string &fname, const double time,
+         const casacore::uInt nAnt, const casacore::uInt nBeam, const casacore::uInt nChan)
+{
+  long id = -1;
+  {
+    TableCalSolutionSource src(fname, nAnt, nBeam, nChan);
+    id = src.newSolutionID(time);
+  }
+  // the filler creates default (invalid) cubes for the new row
+  const casacore::Table tab(fname, casacore::Table::Update);
+  TableCalSolutionFiller filler(tab, id, nAnt, nBeam, nChan);
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > cubes;
+  filler.fillBandpasses(cubes);
+  filler.writeBandpasses(cubes);
+  filler.fillBPLeakages(cubes);
+  filler.writeBPLeakages(cubes);
+  filler.flush();
+  ASKAPLOG_DEBUG_STR(logger, "Prepared solution "<<id<<" in "<<fname<<" for "<<nChan<<" channels, "<<
+                     nAnt<<" antennas and "<<nBeam<<" beams");
+  return id;
+}
+
+/// @brief open the table and set up local buffers
+/// @param[in] fname file name of the calibration table
+void CollectiveBandpassWriter::openTable(const std::string &fname)
+{
+  table() = casacore::Table(fname, casacore::TableLock(casacore::TableLock::UserLocking), casacore::Table::Update);
+  ASKAPCHECK((itsID >= 0) && (itsID < static_cast<long>(table().nrow())), "Solution ID = "<<itsID<<
+             " is outside the calibration table "<<fname);
+  ASKAPCHECK(itsNLocalChan > 0, "At least one channel is expected to be written");
+  const casacore::rownr_t row = static_cast<casacore::rownr_t>(itsID);
+  table().lock(casacore::FileLocker::Read);
+  ASKAPCHECK(cellDefined<casacore::Complex>("BANDPASS", row) && cellDefined<casacore::Complex>("BPLEAKAGE", row),
+             "Bandpass cells are not defined for solution "<<itsID<<", use prepareSolution first");
+  const casacore::IPosition shape = casacore::ROArrayColumn<casacore::Complex>(table(), "BANDPASS").shape(row);
+  ASKAPCHECK(casacore::ROArrayColumn<casacore::Complex>(table(), "BPLEAKAGE").shape(row) == shape,
+             "BANDPASS and BPLEAKAGE cubes are expected to have the same shape");
+  table().unlock();
+  ASKAPCHECK(shape.nelements() == 3, "Wrong format of the calibration table: BANDPASS is expected to contain cubes");
+  ASKAPCHECK(2 * (itsStartChan + itsNLocalChan) <= casacore::uInt(shape[0]), "Channels "<<itsStartChan<<" to "<<
+             itsStartChan + itsNLocalChan - 1<<" are outside the bandpass with "<<shape[0] / 2<<" channels");
+  itsBandpasses.first.resize(2 * itsNLocalChan, shape[1], shape[2]);
+  itsBandpasses.first.set(1.);
+  itsBandpasses.second.resize(2 * itsNLocalChan, shape[1], shape[2]);
+  itsBandpasses.second.set(false);
+  itsBPLeakages.first.resize(2 * itsNLocalChan, shape[1], shape[2]);
+  itsBPLeakages.first.set(0.);
+  itsBPLeakages.second.resize(2 * itsNLocalChan, shape[1], shape[2]);
+  itsBPLeakages.second.set(false);
+}
+
+/// @brief set gains for a single bandpass channel
+/// @param[in] index ant/beam index
+/// @param[in] bp JonesJTerm object with gains for the given channel and validity flags
+/// @param[in] chan spectral channel (counted from the start of the full spectrum)
+void CollectiveBandpassWriter::setBandpass(const JonesIndex &index, const JonesJTerm &bp, const casacore::uInt chan)
+{
+  const casacore::uInt localChan = localChannel(chan);
+  store(itsBandpasses, bp.g1(), bp.g1IsValid(), 2 * localChan, index);
+  store(itsBandpasses, bp.g2(), bp.g2IsValid(), 2 * localChan + 1, index);
+  itsBandpassesChanged = true;
+}
+
+/// @brief set leakages for a single bandpass channel
+/// @param[in] index ant/beam index
+/// @param[in] bpleakages JonesDTerm object with leakages for the given channel and validity flags
+/// @param[in] chan spectral channel (counted from the start of the full spectrum)
+void CollectiveBandpassWriter::setBPLeakage(const JonesIndex &index, const JonesDTerm &bpleakages, const casacore::uInt chan)
+{
+  const casacore::uInt localChan = localChannel(chan);
+  store(itsBPLeakages, bpleakages.d12(), bpleakages.d12IsValid(), 2 * localChan, index);
+  store(itsBPLeakages, bpleakages.d21(), bpleakages.d21IsValid(), 2 * localChan + 1, index);
+  itsBPLeakagesChanged = true;
+}
+
+/// @brief write the values set so far into the table
+/// @details The table is locked for writing while the values are written.
+void CollectiveBandpassWriter::flush()
+{
+  if (!itsBandpassesChanged && !itsBPLeakagesChanged) {
+      return;
+  }
+  const casacore::rownr_t row = static_cast<casacore::rownr_t>(itsID);
+  // zero number of attempts means waiting until the lock is acquired
+  table().lock(casacore::FileLocker::Write, 0);
+  try {
+     if (itsBandpassesChanged) {
+         writeCubeRows(itsBandpasses.first, "BANDPASS", row, 2 * itsStartChan);
+         writeCubeRows(itsBandpasses.second, "BANDPASS_VALID", row, 2 * itsStartChan);
+     }
+     if (itsBPLeakagesChanged) {
+         writeCubeRows(itsBPLeakages.first, "BPLEAKAGE", row, 2 * itsStartChan);
+         writeCubeRows(itsBPLeakages.second, "BPLEAKAGE_VALID", row, 2 * itsStartChan);
+     }
+     table().flush();
+  }
+  catch (...) {
+     table().unlock();
+     throw;
+  }
+  table().unlock();
+  itsBandpassesChanged = false;
+  itsBPLeakagesChanged = false;
+}
+
+/// @brief set the value and validity flag in the local buffer
+/// @param[in] cubes pair of cubes with values and validity flags
+/// @param[in] val value
+/// @param[in] isValid validity flag
+/// @param[in] row row of the local buffer (polarisation and local channel)
+/// @param[in] index ant/beam index
+void CollectiveBandpassWriter::store(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                    const casacore::Complex &val, const casacore::Bool isValid, const casacore::uInt row,
+                    const JonesIndex &index)
+{
+  const casacore::Short ant = index.antenna();
+  const casacore::Short beam = index.beam();
+  ASKAPDEBUGASSERT(row < cubes.first.nrow());
+  ASKAPCHECK((ant >= 0) && (casacore::uInt(ant) < cubes.first.ncolumn()), "Requested antenna index "<<ant<<
+             " is outside the shape of the bandpass: "<<cubes.first.shape());
+  ASKAPCHECK((beam >= 0) && (casacore::uInt(beam) < cubes.first.nplane()), "Requested beam index "<<beam<<
+             " is outside the shape of the bandpass: "<<cubes.first.shape());
+  cubes.first(row, casacore::uInt(ant), casacore::uInt(beam)) = val;
+  cubes.second(row, casacore::uInt(ant), casacore::uInt(beam)) = isValid;
+}
+
+/// @brief channel index in the local buffer
+/// @param[in] chan spectral channel (counted from the start of the full spectrum)
+/// @return channel counted from startChan
+casacore::uInt CollectiveBandpassWriter::localChannel(const casacore::uInt chan) const
+{
+  ASKAPCHECK((chan >= itsStartChan) && (chan < itsStartChan + itsNLocalChan), "Channel "<<chan<<
+             " is outside the range written by this process: "<<itsStartChan<<" to "<<
+             itsStartChan + itsNLocalChan - 1);
+  return chan - itsStartChan;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,183 @@
+/// @file
+///
+/// @brief Writer of a range of bandpass channels into a shared calibration table
+/// @details Distributed bandpass solvers usually gather all channels on one process
+/// which then writes the table through TableCalSolutionSource. This requires the whole
+/// bandpass to be held in memory of that process. This class allows each process to
+/// write its own range of channels directly into the table row prepared in advance.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_COLLECTIVE_BANDPASS_WRITER_H
+#define ASKAP_ACCESSORS_COLLECTIVE_BANDPASS_WRITER_H
+
+// own includes
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/calibaccess/JonesJTerm.h>
+#include <askap/calibaccess/JonesDTerm.h>
+#include <askap/dataaccess/TableBufferManager.h>
+
+// askapparallel includes
+#include <askap/askapparallel/AskapParallel.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Writer of a range of bandpass channels into a shared calibration table
+/// @details The table row for the new solution is created by one process (see
+/// prepareSolution) with the BANDPASS and BPLEAKAGE cells (and their validity flags)
+/// sized for all channels. Each process then holds the bandpass and bpleakage values
+/// only for its own range of channels and writes them into the corresponding rows of
+/// these cells. The table is opened with user locking, so processes wait for each other
+/// while writing. Ranges of channels used by different processes are not expected to
+/// overlap; this is not checked. Values not set explicitly are written as invalid with
+/// the default value (1 for bandpasses, 0 for bpleakages).
+/// @ingroup calibaccess
+class CollectiveBandpassWriter : public boost::noncopyable,
+                                 virtual protected TableBufferManager {
+public:
+  /// @brief prepare the solution and open the table
+  /// @details This is a collective operation, all processes should call it. The root
+  /// process creates the new solution and sends its ID to all other processes.
+  /// @param[in] comms communication object
+  /// @param[in] fname file name of the calibration table (created if doesn't exist)
+  /// @param[in] time time stamp of the new solution in seconds since MJD of 0.
+  /// @param[in] nAnt number of antennas
+  /// @param[in] nBeam number of beams
+  /// @param[in] nChan total number of spectral channels
+  /// @param[in] startChan first channel written by this process
+  /// @param[in] nLocalChan number of channels written by this process
+  /// @param[in] root rank of the process creating the solution
+  CollectiveBandpassWriter(askapparallel::AskapParallel &comms, const std::string &fname, const double time,
+         const casacore::uInt nAnt, const casacore::uInt nBeam, const casacore::uInt nChan,
+         const casacore::uInt startChan, const casacore::uInt nLocalChan, int root = 0);
+
+  /// @brief open the table for the solution prepared already
+  /// @param[in] fname file name of the calibration table
+  /// @param[in] id solution ID returned by prepareSolution
+  /// @param[in] startChan first channel written by this object
+  /// @param[in] nLocalChan number of channels written by this object
+  CollectiveBandpassWriter(const std::string &fname, const long id, const casacore::uInt startChan,
+         const casacore::uInt nLocalChan);
+
+  /// @brief destructor, writes the values if necessary
+  ~CollectiveBandpassWriter();
+
+  /// @brief create a new solution with bandpass cells sized for all channels
+  /// @details This method is called by one process only.
+  /// @param[in] fname file name of the calibration table (created if doesn't exist)
+  /// @param[in] time time stamp of the new solution in seconds since MJD of 0.
+  /// @param[in] nAnt number of antennas
+  /// @param[in] nBeam number of beams
+  /// @param[in] nChan total number of spectral channels
+  /// @return solution ID
+  static long prepareSolution(const std::string &fname, const double time, const casacore::uInt nAnt,
+         const casacore::uInt nBeam, const casacore::uInt nChan);
+
+  /// @return solution ID
+  inline long solutionID() const { return itsID; }
+
+  /// @return first channel written by this object
+  inline casacore::uInt startChan() const { return itsStartChan; }
+
+  /// @return number of channels written by this object
+  inline casacore::uInt nLocalChan() const { return itsNLocalChan; }
+
+  /// @brief set gains for a single bandpass channel
+  /// @param[in] index ant/beam index
+  /// @param[in] bp JonesJTerm object with gains for the given channel and validity flags
+  /// @param[in] chan spectral channel (counted from the start of the full spectrum)
+  void setBandpass(const JonesIndex &index, const JonesJTerm &bp, const casacore::uInt chan);
+
+  /// @brief set leakages for a single bandpass channel
+  /// @param[in] index ant/beam index
+  /// @param[in] bpleakages JonesDTerm object with leakages for the given channel and validity flags
+  /// @param[in] chan spectral channel (counted from the start of the full spectrum)
+  void setBPLeakage(const JonesIndex &index, const JonesDTerm &bpleakages, const casacore::uInt chan);
+
+  /// @brief write the values set so far into the table
+  /// @details The table is locked for writing while the values are written.
+  void flush();
+
+private:
+  /// @brief open the table and set up local buffers
+  /// @param[in] fname file name of the calibration table
+  void openTable(const std::string &fname);
+
+  /// @brief set the value and validity flag in the local buffer
+  /// @param[in] cubes pair of cubes with values and validity flags
+  /// @param[in] val value
+  /// @param[in] isValid validity flag
+  /// @param[in] row row of the local buffer (polarisation and local channel)
+  /// @param[in] index ant/beam index
+  static void store(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                    const casacore::Complex &val, const casacore::Bool isValid, const casacore::uInt row,
+                    const JonesIndex &index);
+
+  /// @brief channel index in the local buffer
+  /// @param[in] chan spectral channel (counted from the start of the full spectrum)
+  /// @return channel counted from startChan
+  casacore::uInt localChannel(const casacore::uInt chan) const;
+
+  /// @brief solution ID (table row)
+  long itsID;
+
+  /// @brief first channel written by this object
+  casacore::uInt itsStartChan;
+
+  /// @brief number of channels written by this object
+  casacore::uInt itsNLocalChan;
+
+  /// @brief bandpasses and validity flags for the local channels ((2*nLocalChan) x nAnt x nBeam)
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > itsBandpasses;
+
+  /// @brief bpleakages and validity flags for the local channels ((2*nLocalChan) x nAnt x nBeam)
+  std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > itsBPLeakages;
+
+  /// @brief true, if bandpasses have been changed since the last flush
+  bool itsBandpassesChanged;
+
+  /// @brief true, if bpleakages have been changed since the last flush
+  bool itsBPLeakagesChanged;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLLECTIVE_BANDPASS_WRITER_H
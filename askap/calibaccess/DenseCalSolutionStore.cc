@@ -0,0 +1,217 @@
+/// @file
+///
+/// @brief Dense integer-indexed storage of calibration solutions
+/// @details Gains, leakages, bandpasses and bandpass leakages are stored in flat arrays
+/// indexed by antenna, beam, polarisation and channel. String names are only built when
+/// the content is exported to scimath::Params.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/DenseCalSolutionStore.h>
+#include <askap/calibaccess/CalParamNameHelper.h>
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/measures/Measures/Stokes.h>
+
+// std includes
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief construct an empty block
+DenseCalSolutionStore::Block::Block() : itsNAnt(0), itsNBeam(0), itsNChan(0) {}
+
+/// @brief set an element
+/// @details If the antenna or beam index is beyond the current shape, the block is
+/// reorganised. A new channel just extends the block.
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @param[in] pol polarisation index (0 or 1)
+/// @param[in] chan channel index
+/// @param[in] val value to set
+void DenseCalSolutionStore::Block::set(casacore::uInt ant, casacore::uInt beam, casacore::uInt pol,
+                                       casacore::uInt chan, const casacore::Complex &val)
+{
+  ASKAPDEBUGASSERT(pol < 2);
+  if ((ant >= itsNAnt) || (beam >= itsNBeam) || (chan >= itsNChan)) {
+      resize(std::max(ant + 1, itsNAnt), std::max(beam + 1, itsNBeam), std::max(chan + 1, itsNChan));
+  }
+  const size_t i = index(ant, beam, pol, chan);
+  itsValues[i] = val;
+  itsValid[i] = 1;
+}
+
+/// @brief change the shape of the block
+/// @details The existing elements are preserved. The block is reorganised if the number
+/// of antennas or beams changes, a new number of channels just extends the block.
+/// @param[in] nAnt number of antennas (not less than the current one)
+/// @param[in] nBeam number of beams (not less than the current one)
+/// @param[in] nChan number of channels (not less than the current one)
+void DenseCalSolutionStore::Block::resize(casacore::uInt nAnt, casacore::uInt nBeam, casacore::uInt nChan)
+{
+  ASKAPDEBUGASSERT((nAnt >= itsNAnt) && (nBeam >= itsNBeam) && (nChan >= itsNChan));
+  if ((nAnt != itsNAnt) || (nBeam != itsNBeam)) {
+      std::vector<casacore::Complex> values(size_t(nChan) * nBeam * nAnt * 2, casacore::Complex(0., 0.));
+      std::vector<char> valid(values.size(), 0);
+      for (casacore::uInt c = 0; c < itsNChan; ++c) {
+           for (casacore::uInt b = 0; b < itsNBeam; ++b) {
+                const size_t from = index(0, b, 0, c);
+                const size_t to = ((size_t(c) * nBeam + b) * nAnt) * 2;
+                std::copy(itsValues.begin() + from, itsValues.begin() + from + 2 * itsNAnt, values.begin() + to);
+                std::copy(itsValid.begin() + from, itsValid.begin() + from + 2 * itsNAnt, valid.begin() + to);
+           }
+      }
+      itsValues.swap(values);
+      itsValid.swap(valid);
+      itsNAnt = nAnt;
+      itsNBeam = nBeam;
+      itsNChan = nChan;
+  } else if (nChan != itsNChan) {
+      itsNChan = nChan;
+      itsValues.resize(size_t(itsNChan) * itsNBeam * itsNAnt * 2, casacore::Complex(0., 0.));
+      itsValid.resize(itsValues.size(), 0);
+  }
+}
+
+/// @brief make room for the given number of antennas, beams and channels
+/// @details Setting elements within this shape doesn't require the block to be reorganised,
+/// which is handy for filling large bandpasses in an arbitrary order. The shape never shrinks.
+/// @param[in] term kind of the term
+/// @param[in] nAnt number of antennas
+/// @param[in] nBeam number of beams
+/// @param[in] nChan number of channels (ignored for gains and leakages)
+void DenseCalSolutionStore::reserve(Term term, casacore::uInt nAnt, casacore::uInt nBeam, casacore::uInt nChan)
+{
+  ASKAPDEBUGASSERT(term < NUMBER_OF_TERMS);
+  Block &block = itsBlocks[term];
+  const casacore::uInt nChanRequired = (term == BANDPASS) || (term == BPLEAKAGE) ? nChan : 1;
+  if ((nAnt == 0) || (nBeam == 0) || (nChanRequired == 0)) {
+      return;
+  }
+  if ((nAnt > block.itsNAnt) || (nBeam > block.itsNBeam) || (nChanRequired > block.itsNChan)) {
+      block.resize(std::max(nAnt, block.itsNAnt), std::max(nBeam, block.itsNBeam),
+                   std::max(nChanRequired, block.itsNChan));
+  }
+}
+
+/// @brief remove all elements
+void DenseCalSolutionStore::clear()
+{
+  for (int term = 0; term < NUMBER_OF_TERMS; ++term) {
+       itsBlocks[term] = Block();
+  }
+}
+
+/// @return number of valid elements of all kinds
+size_t DenseCalSolutionStore::size() const
+{
+  size_t result = 0;
+  for (int term = 0; term < NUMBER_OF_TERMS; ++term) {
+       result += std::count(itsBlocks[term].itsValid.begin(), itsBlocks[term].itsValid.end(), 1);
+  }
+  return result;
+}
+
+/// @brief store all valid elements in scimath::Params
+/// @details Existing parameters are updated, new ones are added. Parameters which
+/// don't correspond to any valid element are left untouched.
+/// @param[in] params parameters to update
+void DenseCalSolutionStore::exportTo(scimath::Params &params) const
+{
+  for (int term = 0; term < NUMBER_OF_TERMS; ++term) {
+       const Block &block = itsBlocks[term];
+       const bool leakage = (term == LEAKAGE) || (term == BPLEAKAGE);
+       const bool bandpass = (term == BANDPASS) || (term == BPLEAKAGE);
+       const casacore::Stokes::StokesTypes pols[2] = {leakage ? casacore::Stokes::XY : casacore::Stokes::XX,
+                                                      leakage ? casacore::Stokes::YX : casacore::Stokes::YY};
+       for (casacore::uInt chan = 0; chan < block.itsNChan; ++chan) {
+            for (casacore::uInt beam = 0; beam < block.itsNBeam; ++beam) {
+                 for (casacore::uInt ant = 0; ant < block.itsNAnt; ++ant) {
+                      for (casacore::uInt pol = 0; pol < 2; ++pol) {
+                           const size_t i = block.index(ant, beam, pol, chan);
+                           if (!block.itsValid[i]) {
+                               continue;
+                           }
+                           const std::string baseName = CalParamNameHelper::paramName(JonesIndex(ant, beam), pols[pol]);
+                           const std::string name = bandpass ? CalParamNameHelper::addChannelInfo(baseName, chan) :
+                                                               baseName;
+                           if (params.has(name)) {
+                               params.update(name, block.itsValues[i]);
+                           } else {
+                               params.add(name, block.itsValues[i]);
+                           }
+                      }
+                 }
+            }
+       }
+  }
+}
+
+/// @brief read gains, leakages, bandpasses and bandpass leakages from scimath::Params
+/// @details The existing content is replaced. Parameters with other names (e.g. ionospheric
+/// parameters) are ignored.
+/// @param[in] params parameters to read
+/// @return number of elements read
+size_t DenseCalSolutionStore::importFrom(const scimath::Params &params)
+{
+  clear();
+  size_t result = 0;
+  const std::vector<std::string> names = params.names();
+  for (std::vector<std::string>::const_iterator ci = names.begin(); ci != names.end(); ++ci) {
+       const std::string &name = *ci;
+       if ((name.compare(0, 5, "gain.") != 0) && (name.compare(0, 8, "leakage.") != 0)) {
+           continue;
+       }
+       // gain.g11.ant.beam or the same with the channel appended
+       const bool bandpass = std::count(name.begin(), name.end(), '.') == 4;
+       const std::pair<casacore::uInt, std::string> chanInfo = bandpass ?
+             CalParamNameHelper::extractChannelInfo(name) : std::pair<casacore::uInt, std::string>(0u, name);
+       const casacore::uInt chan = chanInfo.first;
+       const std::pair<JonesIndex, casacore::Stokes::StokesTypes> parsed =
+             CalParamNameHelper::parseParam(chanInfo.second);
+       ASKAPCHECK((parsed.first.antenna() >= 0) && (parsed.first.beam() >= 0),
+                  "Negative antenna or beam index in the parameter "<<name);
+       const bool leakage = (parsed.second == casacore::Stokes::XY) || (parsed.second == casacore::Stokes::YX);
+       const Term term = leakage ? (bandpass ? BPLEAKAGE : LEAKAGE) : (bandpass ? BANDPASS : GAIN);
+       const casacore::uInt pol = (parsed.second == casacore::Stokes::XX) ||
+                                  (parsed.second == casacore::Stokes::XY) ? 0 : 1;
+       set(term, casacore::uInt(parsed.first.antenna()), casacore::uInt(parsed.first.beam()), pol, chan,
+           params.complexValue(name));
+       ++result;
+  }
+  return result;
+}
+
+} // namespace accessors
+
+} // namespace askap
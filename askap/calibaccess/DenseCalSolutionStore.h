@@ -0,0 +1,211 @@
+/// @file
+///
+/// @brief Dense integer-indexed storage of calibration solutions
+/// @details CachedCalSolutionAccessor keeps the solution in scimath::Params, so every
+/// access builds and looks up a string name (e.g. gain.g11.3.5). This class stores gains,
+/// leakages, bandpasses and bandpass leakages in flat arrays indexed by antenna, beam,
+/// polarisation and channel instead. String names are only built when the content is
+/// exported to scimath::Params (and parsed when it is imported).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_DENSE_CAL_SOLUTION_STORE_H
+#define ASKAP_ACCESSORS_DENSE_CAL_SOLUTION_STORE_H
+
+// own includes
+#include <askap/scimath/fitting/Params.h>
+#include <askap/calibaccess/JonesCubeView.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Dense integer-indexed storage of calibration solutions
+/// @details Each kind of term is stored in its own block of memory. The channel is the
+/// slowest varying index, so the bandpass filled in the order of channels only grows at the
+/// end of the block. The block is reorganised if a larger antenna or beam index is set.
+/// Parallel-hand terms use polarisation index 0 for XX and 1 for YY, leakages use 0 for XY
+/// and 1 for YX. Each element carries a validity flag, elements which haven't been set are
+/// invalid.
+///
+/// The names used for export and import are the same as used by CachedCalSolutionAccessor:
+/// CalParamNameHelper::paramName for gains and leakages with the channel added by
+/// CalParamNameHelper::addChannelInfo for bandpasses and bandpass leakages.
+/// @ingroup calibaccess
+class DenseCalSolutionStore {
+public:
+  /// @brief kinds of terms
+  enum Term {
+     GAIN = 0,
+     LEAKAGE,
+     BANDPASS,
+     BPLEAKAGE,
+     NUMBER_OF_TERMS
+  };
+
+  /// @brief obtain an element
+  /// @param[in] term kind of the term
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @param[in] pol polarisation index (0 or 1)
+  /// @param[in] chan channel index (ignored for gains and leakages)
+  /// @param[out] val value (untouched if the element is not valid)
+  /// @return true, if the element has been set
+  inline bool get(Term term, casacore::uInt ant, casacore::uInt beam, casacore::uInt pol, casacore::uInt chan,
+                  casacore::Complex &val) const
+     { return itsBlocks[term].get(ant, beam, pol, channel(term, chan), val); }
+
+  /// @brief set an element
+  /// @details The storage grows as necessary.
+  /// @param[in] term kind of the term
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @param[in] pol polarisation index (0 or 1)
+  /// @param[in] chan channel index (ignored for gains and leakages)
+  /// @param[in] val value to set
+  inline void set(Term term, casacore::uInt ant, casacore::uInt beam, casacore::uInt pol, casacore::uInt chan,
+                  const casacore::Complex &val)
+     { itsBlocks[term].set(ant, beam, pol, channel(term, chan), val); }
+
+  /// @brief make room for the given number of antennas, beams and channels
+  /// @details Setting elements within this shape doesn't require the block to be reorganised,
+  /// which is handy for filling large bandpasses in an arbitrary order. The shape never shrinks.
+  /// @param[in] term kind of the term
+  /// @param[in] nAnt number of antennas
+  /// @param[in] nBeam number of beams
+  /// @param[in] nChan number of channels (ignored for gains and leakages)
+  void reserve(Term term, casacore::uInt nAnt, casacore::uInt nBeam, casacore::uInt nChan);
+
+  /// @brief remove all elements
+  void clear();
+
+  /// @return number of valid elements of all kinds
+  size_t size() const;
+
+  /// @brief store all valid elements in scimath::Params
+  /// @details Existing parameters are updated, new ones are added. Parameters which
+  /// don't correspond to any valid element are left untouched.
+  /// @param[in] params parameters to update
+  void exportTo(scimath::Params &params) const;
+
+  /// @brief read gains, leakages, bandpasses and bandpass leakages from scimath::Params
+  /// @details The existing content is replaced. Parameters with other names (e.g. ionospheric
+  /// parameters) are ignored.
+  /// @param[in] params parameters to read
+  /// @return number of elements read
+  size_t importFrom(const scimath::Params &params);
+
+private:
+  /// @brief storage for one kind of terms
+  struct Block {
+     /// @brief construct an empty block
+     Block();
+
+     /// @brief obtain an element
+     /// @param[in] ant antenna index
+     /// @param[in] beam beam index
+     /// @param[in] pol polarisation index (0 or 1)
+     /// @param[in] chan channel index
+     /// @param[out] val value (untouched if the element is not valid)
+     /// @return true, if the element has been set
+     inline bool get(casacore::uInt ant, casacore::uInt beam, casacore::uInt pol, casacore::uInt chan,
+                     casacore::Complex &val) const
+        {
+          if ((ant >= itsNAnt) || (beam >= itsNBeam) || (chan >= itsNChan)) {
+              return false;
+          }
+          const size_t i = index(ant, beam, pol, chan);
+          if (!itsValid[i]) {
+              return false;
+          }
+          val = itsValues[i];
+          return true;
+        }
+
+     /// @brief set an element
+     /// @param[in] ant antenna index
+     /// @param[in] beam beam index
+     /// @param[in] pol polarisation index (0 or 1)
+     /// @param[in] chan channel index
+     /// @param[in] val value to set
+     void set(casacore::uInt ant, casacore::uInt beam, casacore::uInt pol, casacore::uInt chan,
+              const casacore::Complex &val);
+
+     /// @brief change the shape of the block
+     /// @details The existing elements are preserved.
+     /// @param[in] nAnt number of antennas (not less than the current one)
+     /// @param[in] nBeam number of beams (not less than the current one)
+     /// @param[in] nChan number of channels (not less than the current one)
+     void resize(casacore::uInt nAnt, casacore::uInt nBeam, casacore::uInt nChan);
+
+     /// @brief flat index of an element
+     /// @param[in] ant antenna index
+     /// @param[in] beam beam index
+     /// @param[in] pol polarisation index (0 or 1)
+     /// @param[in] chan channel index
+     /// @return index into itsValues and itsValid
+     inline size_t index(casacore::uInt ant, casacore::uInt beam, casacore::uInt pol, casacore::uInt chan) const
+        { return ChannelMajorJonesLayout::offset(pol, chan, ant, beam, itsNChan, itsNAnt, itsNBeam); }
+
+     /// @brief number of antennas
+     casacore::uInt itsNAnt;
+
+     /// @brief number of beams
+     casacore::uInt itsNBeam;
+
+     /// @brief number of channels
+     casacore::uInt itsNChan;
+
+     /// @brief values
+     std::vector<casacore::Complex> itsValues;
+
+     /// @brief validity flags (char rather than bool to avoid the bit-packed specialisation)
+     std::vector<char> itsValid;
+  };
+
+  /// @brief channel used for the given kind of terms
+  /// @param[in] term kind of the term
+  /// @param[in] chan channel requested
+  /// @return chan for bandpass terms, zero otherwise
+  static inline casacore::uInt channel(Term term, casacore::uInt chan)
+     { return (term == BANDPASS) || (term == BPLEAKAGE) ? chan : 0; }
+
+  /// @brief storage, one block per kind of terms
+  Block itsBlocks[NUMBER_OF_TERMS];
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DENSE_CAL_SOLUTION_STORE_H
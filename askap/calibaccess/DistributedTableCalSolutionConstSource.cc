@@ -0,0 +1,288 @@
+/// @file
+///
+/// @brief Calibration solution source reading the table on one process only
+/// @details The root process reads the table and distributes its content to all
+/// other processes, which serve the solutions from a memory table.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/DistributedTableCalSolutionConstSource.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/measures/TableMeasures/TableMeasDesc.h>
+#include <casacore/measures/TableMeasures/TableMeasRefDesc.h>
+#include <casacore/measures/TableMeasures/TableMeasValueDesc.h>
+#include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MCEpoch.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// LOFAR includes
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+ASKAP_LOGGER(logger, ".calibaccess.DistributedTableCalSolutionConstSource");
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief read the table and distribute it
+/// @details This is a collective operation, all processes should call it.
+/// @param[in] comms communication object
+/// @param[in] fname file name of the calibration table (only used by the root process)
+/// @param[in] root rank of the process reading the table
+DistributedTableCalSolutionConstSource::DistributedTableCalSolutionConstSource(askapparallel::AskapParallel &comms,
+          const std::string &fname, int root) : itsPackedSize(0)
+{
+  if (!comms.isParallel()) {
+      itsSource.reset(new TableCalSolutionConstSource(fname));
+      return;
+  }
+  const int nProcs = comms.nProcs();
+  ASKAPCHECK((root >= 0) && (root < nProcs), "Root rank "<<root<<" is outside the range of "<<nProcs<<" processes");
+  // rank relative to the root, the root is 0
+  const int relRank = (comms.rank() - root + nProcs) % nProcs;
+  LOFAR::BlobString bs;
+  bs.resize(0);
+  // binomial tree: the process receives from the rank which differs by the lowest set bit
+  // of its relative rank and forwards the data to the ranks obtained by setting lower bits
+  int mask = 1;
+  if (relRank == 0) {
+      pack(casacore::Table(fname), bs);
+      ASKAPLOG_DEBUG_STR(logger, "Calibration table "<<fname<<" is packed into "<<bs.size()<<
+                         " bytes to be distributed to "<<nProcs<<" processes");
+      while (mask < nProcs) {
+             mask *= 2;
+      }
+  } else {
+      while ((relRank & mask) == 0) {
+             mask *= 2;
+      }
+      comms.receiveBlob(bs, (relRank - mask + root) % nProcs);
+  }
+  for (mask /= 2; mask > 0; mask /= 2) {
+       if (relRank + mask < nProcs) {
+           comms.sendBlob(bs, (relRank + mask + root) % nProcs);
+       }
+  }
+  itsPackedSize = bs.size();
+  itsSource.reset(new TableCalSolutionConstSource(unpack(bs)));
+}
+
+/// @brief names of the columns with calibration data (validity flags are in name+"_VALID")
+/// @return vector with column names
+const std::vector<std::string>& DistributedTableCalSolutionConstSource::dataColumns()
+{
+  static std::vector<std::string> names;
+  if (names.size() == 0) {
+      names.push_back("GAIN");
+      names.push_back("LEAKAGE");
+      names.push_back("BANDPASS");
+      names.push_back("BPLEAKAGE");
+      names.push_back("IONOSPHERE");
+  }
+  return names;
+}
+
+/// @brief pack the calibration table into a blob
+/// @param[in] tab calibration table
+/// @param[out] bs blob string to fill
+void DistributedTableCalSolutionConstSource::pack(const casacore::Table &tab, LOFAR::BlobString &bs)
+{
+  ASKAPCHECK(tab.nrow() > 0u, "The calibration table "<<tab.tableName()<<" is empty");
+  bs.resize(0);
+  LOFAR::BlobOBufString bob(bs);
+  LOFAR::BlobOStream out(bob);
+  out.putStart("CalibrationTable", 1);
+  const LOFAR::uint64 nRow = tab.nrow();
+  out<<nRow;
+  casacore::ROScalarMeasColumn<casacore::MEpoch> timeCol(tab,"TIME");
+  for (casacore::rownr_t row = 0; row < tab.nrow(); ++row) {
+       out<<timeCol.convert(row,casacore::MEpoch::UTC).get("s").getValue();
+  }
+  const std::vector<std::string> &names = dataColumns();
+  for (std::vector<std::string>::const_iterator ci = names.begin(); ci != names.end(); ++ci) {
+       const bool exists = tab.actualTableDesc().isColumn(*ci) && tab.actualTableDesc().isColumn(*ci + "_VALID");
+       out<<exists;
+       if (!exists) {
+           continue;
+       }
+       casacore::ROArrayColumn<casacore::Complex> valCol(tab, *ci);
+       casacore::ROArrayColumn<casacore::Bool> flagCol(tab, *ci + "_VALID");
+       for (casacore::rownr_t row = 0; row < tab.nrow(); ++row) {
+            const bool defined = valCol.isDefined(row) && flagCol.isDefined(row);
+            out<<defined;
+            if (!defined) {
+                continue;
+            }
+            const casacore::Cube<casacore::Complex> values(valCol(row));
+            const casacore::Cube<casacore::Bool> flags(flagCol(row));
+            ASKAPCHECK(values.shape() == flags.shape(), "Cells of "<<*ci<<" and "<<*ci<<
+                       "_VALID have different shapes in row "<<row);
+            out<<static_cast<LOFAR::uint32>(values.nrow())<<static_cast<LOFAR::uint32>(values.ncolumn())<<
+                 static_cast<LOFAR::uint32>(values.nplane());
+            bool deleteValues, deleteFlags;
+            const casacore::Complex *valPtr = values.getStorage(deleteValues);
+            const casacore::Bool *flagPtr = flags.getStorage(deleteFlags);
+            // complex values are passed as pairs of floats
+            out.put(reinterpret_cast<const float*>(valPtr), 2 * values.nelements());
+            out.put(flagPtr, flags.nelements());
+            values.freeStorage(valPtr, deleteValues);
+            flags.freeStorage(flagPtr, deleteFlags);
+       }
+  }
+  out.putEnd();
+}
+
+/// @brief unpack the calibration table from a blob
+/// @param[in] bs blob string filled by pack
+/// @return memory table with the same content as the original table
+casacore::Table DistributedTableCalSolutionConstSource::unpack(const LOFAR::BlobString &bs)
+{
+  LOFAR::BlobIBufString bib(bs);
+  LOFAR::BlobIStream in(bib);
+  const int version = in.getStart("CalibrationTable");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the packed calibration table");
+  LOFAR::uint64 nRow;
+  in>>nRow;
+  casacore::SetupNewTable maker("", casacore::TableDesc(), casacore::Table::Scratch);
+  casacore::Table tab(maker, casacore::Table::Memory, static_cast<casacore::rownr_t>(nRow));
+  // the TIME column is set up in the same way as by TableCalSolutionSource
+  casacore::ScalarColumnDesc<casacore::Double> timeColDesc("TIME",
+        "Time stamp when the calibration solution was obtained");
+  tab.addColumn(timeColDesc);
+  casacore::TableMeasRefDesc measRef(casacore::MEpoch::UTC);
+  casacore::TableMeasValueDesc measVal(tab.actualTableDesc(), "TIME");
+  casacore::TableMeasDesc<casacore::MEpoch> mepochCol(measVal, measRef);
+  mepochCol.write(tab);
+  casacore::ScalarMeasColumn<casacore::MEpoch> timeCol(tab,"TIME");
+  for (casacore::rownr_t row = 0; row < tab.nrow(); ++row) {
+       double time;
+       in>>time;
+       timeCol.put(row, casacore::MEpoch(casacore::Quantity(time,"s"),casacore::MEpoch::UTC));
+  }
+  const std::vector<std::string> &names = dataColumns();
+  for (std::vector<std::string>::const_iterator ci = names.begin(); ci != names.end(); ++ci) {
+       bool exists;
+       in>>exists;
+       if (!exists) {
+           continue;
+       }
+       tab.addColumn(casacore::ArrayColumnDesc<casacore::Complex>(*ci));
+       tab.addColumn(casacore::ArrayColumnDesc<casacore::Bool>(*ci + "_VALID"));
+       casacore::ArrayColumn<casacore::Complex> valCol(tab, *ci);
+       casacore::ArrayColumn<casacore::Bool> flagCol(tab, *ci + "_VALID");
+       for (casacore::rownr_t row = 0; row < tab.nrow(); ++row) {
+            bool defined;
+            in>>defined;
+            if (!defined) {
+                continue;
+            }
+            LOFAR::uint32 nrow, ncol, nplane;
+            in>>nrow>>ncol>>nplane;
+            casacore::Cube<casacore::Complex> values(nrow, ncol, nplane);
+            casacore::Cube<casacore::Bool> flags(nrow, ncol, nplane);
+            ASKAPDEBUGASSERT(values.contiguousStorage() && flags.contiguousStorage());
+            in.get(reinterpret_cast<float*>(values.data()), 2 * values.nelements());
+            in.get(flags.data(), flags.nelements());
+            valCol.put(row, values);
+            flagCol.put(row, flags);
+       }
+  }
+  in.getEnd();
+  return tab;
+}
+
+/// @brief obtain ID for the most recent solution
+/// @return ID for the most recent solution
+long DistributedTableCalSolutionConstSource::mostRecentSolution() const
+{
+  ASKAPDEBUGASSERT(itsSource);
+  return itsSource->mostRecentSolution();
+}
+
+/// @brief obtain solution ID for a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long DistributedTableCalSolutionConstSource::solutionID(const double time) const
+{
+  ASKAPDEBUGASSERT(itsSource);
+  return itsSource->solutionID(time);
+}
+
+/// @brief obtain closest solution ID before a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID, time of solution
+std::pair<long, double> DistributedTableCalSolutionConstSource::solutionIDBefore(const double time) const
+{
+  ASKAPDEBUGASSERT(itsSource);
+  return itsSource->solutionIDBefore(time);
+}
+
+/// @brief obtain closest solution ID after a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID, time of solution
+std::pair<long, double> DistributedTableCalSolutionConstSource::solutionIDAfter(const double time) const
+{
+  ASKAPDEBUGASSERT(itsSource);
+  return itsSource->solutionIDAfter(time);
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> DistributedTableCalSolutionConstSource::roSolution(const long id) const
+{
+  ASKAPDEBUGASSERT(itsSource);
+  return itsSource->roSolution(id);
+}
+
+/// @brief obtain read-only accessor for a given solution ID and a range of channels
+/// @param[in] id solution ID to read
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> DistributedTableCalSolutionConstSource::roSolutionForChannels(const long id,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+  ASKAPDEBUGASSERT(itsSource);
+  return itsSource->roSolutionForChannels(id, startChan, nChan);
+}
+
+} // namespace accessors
+
+} // namespace askap
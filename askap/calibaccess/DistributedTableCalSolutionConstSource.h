@@ -0,0 +1,139 @@
+/// @file
+///
+/// @brief Calibration solution source reading the table on one process only
+/// @details With many processes, opening the calibration table in each of them
+/// puts a lot of load on the file system metadata server at startup. This source
+/// reads the table on one process and distributes its content to all others,
+/// which then serve the solutions from memory.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_DISTRIBUTED_TABLE_CAL_SOLUTION_CONST_SOURCE_H
+#define ASKAP_ACCESSORS_DISTRIBUTED_TABLE_CAL_SOLUTION_CONST_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/TableCalSolutionConstSource.h>
+
+// askapparallel includes
+#include <askap/askapparallel/AskapParallel.h>
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Calibration solution source reading the table on one process only
+/// @details The root process reads the whole calibration table (time stamps and all
+/// defined cells), packs it into a blob and sends it down a binomial tree of
+/// processes, so the distribution takes log2(nProcs) steps. Each process unpacks the
+/// blob into a memory table and serves the solutions through TableCalSolutionConstSource,
+/// so the behaviour (e.g. backward search for undefined cells) is exactly that of the
+/// table-based source. The constructor is a collective operation, all processes should call it.
+/// In the serial case, the table is simply opened by this process.
+/// @ingroup calibaccess
+class DistributedTableCalSolutionConstSource : public ICalSolutionConstSource {
+public:
+  /// @brief read the table and distribute it
+  /// @details This is a collective operation, all processes should call it.
+  /// @param[in] comms communication object
+  /// @param[in] fname file name of the calibration table (only used by the root process)
+  /// @param[in] root rank of the process reading the table
+  DistributedTableCalSolutionConstSource(askapparallel::AskapParallel &comms, const std::string &fname, int root = 0);
+
+  /// @brief obtain ID for the most recent solution
+  /// @return ID for the most recent solution
+  virtual long mostRecentSolution() const override;
+
+  /// @brief obtain solution ID for a given time
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID
+  virtual long solutionID(const double time) const override;
+
+  /// @brief obtain closest solution ID before a given time
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID, time of solution
+  virtual std::pair<long, double> solutionIDBefore(const double time) const override;
+
+  /// @brief obtain closest solution ID after a given time
+  /// @param[in] time time stamp in seconds since MJD of 0.
+  /// @return solution ID, time of solution
+  virtual std::pair<long, double> solutionIDAfter(const double time) const override;
+
+  /// @brief obtain read-only accessor for a given solution ID
+  /// @param[in] id solution ID to read
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const override;
+
+  /// @brief obtain read-only accessor for a given solution ID and a range of channels
+  /// @param[in] id solution ID to read
+  /// @param[in] startChan first channel of the range
+  /// @param[in] nChan number of channels in the range
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolutionForChannels(const long id,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const override;
+
+  /// @return size of the packed table in bytes (as received by this process)
+  inline size_t packedSize() const { return itsPackedSize; }
+
+  /// @brief pack the calibration table into a blob
+  /// @param[in] tab calibration table
+  /// @param[out] bs blob string to fill
+  static void pack(const casacore::Table &tab, LOFAR::BlobString &bs);
+
+  /// @brief unpack the calibration table from a blob
+  /// @param[in] bs blob string filled by pack
+  /// @return memory table with the same content as the original table
+  static casacore::Table unpack(const LOFAR::BlobString &bs);
+
+private:
+  /// @brief names of the columns with calibration data (validity flags are in name+"_VALID")
+  /// @return vector with column names
+  static const std::vector<std::string>& dataColumns();
+
+  /// @brief source working with the memory table
+  boost::shared_ptr<TableCalSolutionConstSource> itsSource;
+
+  /// @brief size of the packed table in bytes
+  size_t itsPackedSize;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DISTRIBUTED_TABLE_CAL_SOLUTION_CONST_SOURCE_H
@@ -56,6 +56,102 @@ ICalSolutionConstAccessor::~ICalSolutionConstAccessor()
 /// d21 (corresponding to Stokes::YX) correspond to d_{Ap} and d_{Aq} from
 /// Hamaker, Bregman & Sault, respectively. It is assumed that the gain errors
 /// are applied after leakages (i.e. R=GD).
+void ICalSolutionConstAccessor::gainsForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                             casacore::Matrix<casacore::Complex> &gains,
+                             casacore::Matrix<casacore::Bool> &valid) const
+{
+  gains.resize(2, nAnt);
+  valid.resize(2, nAnt);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const JonesJTerm term = gain(JonesIndex(ant, beam));
+       gains(0, ant) = term.g1();
+       gains(1, ant) = term.g2();
+       valid(0, ant) = term.g1IsValid();
+       valid(1, ant) = term.g2IsValid();
+  }
+}
+
+void ICalSolutionConstAccessor::leakagesForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const
+{
+  leakages.resize(2, nAnt);
+  valid.resize(2, nAnt);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const JonesDTerm term = leakage(JonesIndex(ant, beam));
+       leakages(0, ant) = term.d12();
+       leakages(1, ant) = term.d21();
+       valid(0, ant) = term.d12IsValid();
+       valid(1, ant) = term.d21IsValid();
+  }
+}
+
+void ICalSolutionConstAccessor::bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &gains,
+                                casacore::Matrix<casacore::Bool> &valid) const
+{
+  gains.resize(2 * nChan, nAnt);
+  valid.resize(2 * nChan, nAnt);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const JonesIndex index(ant, beam);
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            const JonesJTerm term = bandpass(index, startChan + chan);
+            gains(2 * chan, ant) = term.g1();
+            gains(2 * chan + 1, ant) = term.g2();
+            valid(2 * chan, ant) = term.g1IsValid();
+            valid(2 * chan + 1, ant) = term.g2IsValid();
+       }
+  }
+}
+
+void ICalSolutionConstAccessor::bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                 const casacore::uInt startChan, const casacore::uInt nChan,
+                                 casacore::Matrix<casacore::Complex> &leakages,
+                                 casacore::Matrix<casacore::Bool> &valid) const
+{
+  leakages.resize(2 * nChan, nAnt);
+  valid.resize(2 * nChan, nAnt);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const JonesIndex index(ant, beam);
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            const JonesDTerm term = bpleakage(index, startChan + chan);
+            leakages(2 * chan, ant) = term.d12();
+            leakages(2 * chan + 1, ant) = term.d21();
+            valid(2 * chan, ant) = term.d12IsValid();
+            valid(2 * chan + 1, ant) = term.d21IsValid();
+       }
+  }
+}
+
+void ICalSolutionConstAccessor::ionoparamsForBeam(const casacore::uInt beam, const casacore::uInt nParams,
+                                  casacore::Vector<casacore::Float> &params,
+                                  casacore::Vector<casacore::Bool> &valid) const
+{
+  params.resize(nParams);
+  valid.resize(nParams);
+  for (casacore::uInt param = 0; param < nParams; ++param) {
+       const IonoTerm term = ionoparam(JonesIndex(param, beam));
+       params[param] = casacore::real(term.param());
+       valid[param] = term.paramIsValid();
+  }
+}
+
+void ICalSolutionConstAccessor::ionoparams(const casacore::uInt nParams, const casacore::uInt nBeam,
+                           casacore::Matrix<casacore::Float> &params,
+                           casacore::Matrix<casacore::Bool> &valid) const
+{
+  params.resize(nParams, nBeam);
+  valid.resize(nParams, nBeam);
+  casacore::Vector<casacore::Float> beamParams;
+  casacore::Vector<casacore::Bool> beamValid;
+  for (casacore::uInt beam = 0; beam < nBeam; ++beam) {
+       ionoparamsForBeam(beam, nParams, beamParams, beamValid);
+       params.column(beam) = beamParams;
+       valid.column(beam) = beamValid;
+  }
+}
+
 casacore::SquareMatrix<casacore::Complex, 2> ICalSolutionConstAccessor::jones(const JonesIndex &index, const casacore::uInt chan) const
 {
   return jonesAndValidity(index, chan).first;
@@ -85,7 +181,8 @@ casacore::SquareMatrix<casacore::Complex, 2> ICalSolutionConstAccessor::jones(co
 /// valid, false otherwise
 bool ICalSolutionConstAccessor::jonesValid(const JonesIndex &index, const casacore::uInt chan) const
 {
-  return jonesAndValidity(index, chan).second;
+  // this is equivalent to the validity returned by jonesAndValidity
+  return (validity(index, chan) & ALL_VALID) != 0;
 }
 
 /// @brief obtain validity flag for the full 2x2 Jones Matrix
@@ -126,14 +223,37 @@ bool ICalSolutionConstAccessor::jonesAllValid(const casacore::uInt ant, const ca
 /// @return true, if the matrix returned by jones(...) method called with the same parameters is
 /// valid, false otherwise
 bool ICalSolutionConstAccessor::jonesAllValid(const JonesIndex &index, const casacore::uInt chan) const
+{
+  return validity(index, chan) == ALL_VALID;
+}
+
+/// @brief obtain validity of the constituents of the Jones matrix
+/// @details This method is used by jonesValid and jonesAllValid. The default implementation
+/// calls gain, leakage, bandpass and bpleakage and checks their validity flags.
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel of interest
+/// @return bitwise combination of ValidityFlags for the terms which are valid
+casacore::uInt ICalSolutionConstAccessor::validity(const JonesIndex &index, const casacore::uInt chan) const
 {
   const JonesJTerm gTerm = gain(index);
   const JonesJTerm bpTerm = bandpass(index,chan);
   const JonesDTerm dTerm = leakage(index);
   const JonesDTerm bpdTerm = bpleakage(index,chan);
 
-  return gTerm.g1IsValid() && gTerm.g2IsValid() && bpTerm.g1IsValid() && bpTerm.g2IsValid() &&
-         dTerm.d12IsValid() && dTerm.d21IsValid() && bpdTerm.d12IsValid() && bpdTerm.d21IsValid();
+  casacore::uInt result = 0;
+  if (gTerm.g1IsValid() && gTerm.g2IsValid()) {
+      result |= GAIN_VALID;
+  }
+  if (dTerm.d12IsValid() && dTerm.d21IsValid()) {
+      result |= LEAKAGE_VALID;
+  }
+  if (bpTerm.g1IsValid() && bpTerm.g2IsValid()) {
+      result |= BANDPASS_VALID;
+  }
+  if (bpdTerm.d12IsValid() && bpdTerm.d21IsValid()) {
+      result |= BPLEAKAGE_VALID;
+  }
+  return result;
 }
 
 std::pair<casa::SquareMatrix<casa::Complex, 2>, bool> ICalSolutionConstAccessor::jonesAndValidity(const JonesIndex &index, const casa::uInt chan) const
@@ -37,6 +37,7 @@
 #include <casacore/casa/aipstype.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
 #include <casacore/scimath/Mathematics/SquareMatrix.h>
 
 // boost includes
@@ -116,6 +117,107 @@ struct ICalSolutionConstAccessor {
    /// @return IonoTerm object with parameter and validity flag
    virtual IonoTerm ionoparam(const JonesIndex &index) const = 0;
 
+   // bulk access to the calibration parameters, the default implementation calls the methods
+   // above for each element and should be overridden if there is a faster way to get the data
+
+   /// @brief obtain gains for all antennas of one beam
+   /// @details This method is equivalent to calling gain for each antenna of the given beam,
+   /// but allows implementations to avoid a virtual call per element.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] gains 2 x nAnt matrix with gains, first row is XX, second is YY (resized as necessary)
+   /// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+   virtual void gainsForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                             casacore::Matrix<casacore::Complex> &gains,
+                             casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain leakages for all antennas of one beam
+   /// @details This method is equivalent to calling leakage for each antenna of the given beam,
+   /// but allows implementations to avoid a virtual call per element.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] leakages 2 x nAnt matrix with leakages, first row is XY, second is YX (resized as necessary)
+   /// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+   virtual void leakagesForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain bandpass for all antennas of one beam over a range of channels
+   /// @details This method is equivalent to calling bandpass for each antenna of the given beam
+   /// and each channel of the range, but allows implementations to avoid a virtual call per element.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] gains (2*nChan) x nAnt matrix with gains, rows are XX and YY for the first channel,
+   ///             then XX and YY for the second channel, etc (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   virtual void bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &gains,
+                                casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain bandpass leakages for all antennas of one beam over a range of channels
+   /// @details This method is equivalent to calling bpleakage for each antenna of the given beam
+   /// and each channel of the range, but allows implementations to avoid a virtual call per element.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] leakages (2*nChan) x nAnt matrix with leakages, rows are XY and YX for the first
+   ///             channel, then XY and YX for the second channel, etc (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   virtual void bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                 const casacore::uInt startChan, const casacore::uInt nChan,
+                                 casacore::Matrix<casacore::Complex> &leakages,
+                                 casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain ionospheric parameters for one direction
+   /// @details This method is equivalent to calling ionoparam for each parameter of the given
+   /// direction (the antenna index of JonesIndex is the parameter number, the beam index is the
+   /// direction). Ionospheric parameters are real, the imaginary part of IonoTerm is ignored.
+   /// @param[in] beam direction (beam) index
+   /// @param[in] nParams number of parameters
+   /// @param[out] params vector with nParams values (resized as necessary)
+   /// @param[out] valid vector with nParams validity flags (resized as necessary)
+   virtual void ionoparamsForBeam(const casacore::uInt beam, const casacore::uInt nParams,
+                                  casacore::Vector<casacore::Float> &params,
+                                  casacore::Vector<casacore::Bool> &valid) const;
+
+   /// @brief obtain all ionospheric parameters of the solution
+   /// @details This method is equivalent to calling ionoparamsForBeam for each direction.
+   /// @param[in] nParams number of parameters per direction
+   /// @param[in] nBeam number of directions (beams)
+   /// @param[out] params nParams x nBeam matrix with values, parameters of one direction are
+   ///             contiguous (resized as necessary)
+   /// @param[out] valid nParams x nBeam matrix with validity flags (resized as necessary)
+   virtual void ionoparams(const casacore::uInt nParams, const casacore::uInt nBeam,
+                           casacore::Matrix<casacore::Float> &params,
+                           casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief flags returned by the validity method
+   enum ValidityFlags {
+      /// @brief both parallel-hand gains are valid
+      GAIN_VALID = 1,
+      /// @brief both leakages are valid
+      LEAKAGE_VALID = 2,
+      /// @brief both parallel-hand bandpass gains are valid for the channel
+      BANDPASS_VALID = 4,
+      /// @brief both bandpass leakages are valid for the channel
+      BPLEAKAGE_VALID = 8,
+      /// @brief all constituents of the Jones matrix are valid
+      ALL_VALID = 15
+   };
+
+   /// @brief obtain validity of the constituents of the Jones matrix
+   /// @details This method is used by jonesValid and jonesAllValid. The default implementation
+   /// calls gain, leakage, bandpass and bpleakage and checks their validity flags, implementations
+   /// may override it to avoid building the terms just to check the flags.
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest
+   /// @return bitwise combination of ValidityFlags for the terms which are valid
+   virtual casacore::uInt validity(const JonesIndex &index, const casacore::uInt chan) const;
+
    // helper methods to simplify access to the calibration parameters
 
    /// @brief obtain full 2x2 Jones Matrix taking all effects into account
@@ -29,6 +29,13 @@
 /// @author Max Voronkov <Maxim.Voronkov@csiro.au>
 
 #include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/ChanAdapterCalSolutionConstAccessor.h>
+#include <askap/askap/AskapError.h>
+
+#include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
 
 
 namespace askap {
@@ -62,6 +69,48 @@ std::pair<long, double> ICalSolutionConstSource::solutionIDAfter(const double ti
     return std::pair<long, double>(solutionID(time),0.0);
 }
 
+/// @brief obtain read-only accessor for a given solution ID and a range of channels
+/// @details This method is similar to roSolution, but bandpasses and bandpass leakages
+/// are only required for the given range of channels and the channel index passed to the
+/// accessor is counted from startChan. The default implementation wraps the accessor
+/// returned by roSolution into ChanAdapterCalSolutionConstAccessor.
+/// @param[in] id solution ID to read
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range (unused by the default implementation)
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> ICalSolutionConstSource::roSolutionForChannels(const long id,
+                   const casacore::uInt startChan, const casacore::uInt) const
+{
+    if (startChan == 0) {
+        return roSolution(id);
+    }
+    const boost::shared_ptr<ChanAdapterCalSolutionConstAccessor> result(new ChanAdapterCalSolutionConstAccessor(roSolution(id),
+          startChan));
+    ASKAPDEBUGASSERT(result);
+    return result;
+}
+
+/// @brief wait for a solution newer than the given one
+/// @details This method blocks until mostRecentSolution() exceeds lastID or the timeout
+/// expires. The default implementation checks mostRecentSolution once a second.
+/// @param[in] lastID ID of the most recent solution known to the caller
+/// @param[in] timeout maximum time to wait (in seconds)
+/// @return ID of the most recent solution, it doesn't exceed lastID if the timeout has expired
+long ICalSolutionConstSource::waitForNewSolution(const long lastID, const double timeout) const
+{
+    const boost::chrono::steady_clock::time_point deadline = boost::chrono::steady_clock::now() +
+          boost::chrono::duration_cast<boost::chrono::steady_clock::duration>(boost::chrono::duration<double>(timeout));
+    long id = mostRecentSolution();
+    while (id <= lastID) {
+           const double remaining = boost::chrono::duration<double>(deadline - boost::chrono::steady_clock::now()).count();
+           if (remaining <= 0.) {
+               break;
+           }
+           boost::this_thread::sleep_for(boost::chrono::duration<double>(std::min(remaining, 1.)));
+           id = mostRecentSolution();
+    }
+    return id;
+}
 
 } // namespace accessors
 
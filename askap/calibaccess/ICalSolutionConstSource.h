@@ -89,6 +89,29 @@ struct ICalSolutionConstSource {
   /// @return shared pointer to an accessor object
   virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const = 0;
 
+  /// @brief obtain read-only accessor for a given solution ID and a range of channels
+  /// @details This method is similar to roSolution, but bandpasses and bandpass leakages
+  /// are only required for the given range of channels and the channel index passed to the
+  /// accessor is counted from startChan. Implementations may use this to read only the
+  /// required part of the solution. The default implementation wraps the accessor returned
+  /// by roSolution into ChanAdapterCalSolutionConstAccessor.
+  /// @param[in] id solution ID to read
+  /// @param[in] startChan first channel of the range
+  /// @param[in] nChan number of channels in the range
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolutionForChannels(const long id,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const;
+
+  /// @brief wait for a solution newer than the given one
+  /// @details This method blocks until mostRecentSolution() exceeds lastID or the timeout
+  /// expires. It allows real-time consumers to reload the solution only when a new one
+  /// arrives. The default implementation checks mostRecentSolution once a second,
+  /// implementations may use a cheaper way to detect the change.
+  /// @param[in] lastID ID of the most recent solution known to the caller
+  /// @param[in] timeout maximum time to wait (in seconds)
+  /// @return ID of the most recent solution, it doesn't exceed lastID if the timeout has expired
+  virtual long waitForNewSolution(const long lastID, const double timeout) const;
+
   /// @brief shared pointer definition
   typedef boost::shared_ptr<ICalSolutionConstSource> ShPtr;
 };
@@ -102,6 +102,26 @@ struct ICalSolutionFiller {
   /// @param[in] pair of cubes with ionospheric parameters and validity flags (should be 1 x nParam x nDir)
   virtual void writeIonoParams(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &params) const = 0;
 
+  /// @brief partial bandpass writer
+  /// @details This method is called if only a range of channels has been changed. By default,
+  /// the whole cube is written.
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+  /// @param[in] startChan first changed channel
+  /// @param[in] nChan number of changed channels
+  virtual void writeBandpassChannels(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp,
+                                     casacore::uInt /*startChan*/, casacore::uInt /*nChan*/) const
+     { writeBandpasses(bp); }
+
+  /// @brief partial bpleakage writer
+  /// @details This method is called if only a range of channels has been changed. By default,
+  /// the whole cube is written.
+  /// @param[in] bpleakages pair of cubes with bpleakages and validity flags (should be (2*nChan) x nAnt x nBeam)
+  /// @param[in] startChan first changed channel
+  /// @param[in] nChan number of changed channels
+  virtual void writeBPLeakageChannels(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages,
+                                      casacore::uInt /*startChan*/, casacore::uInt /*nChan*/) const
+     { writeBPLeakages(bpleakages); }
+
   // the following methods can be overriden to provide information that a particular solution doesn't exist at all
   // (and therefore reading should always return a default value). This allows to use read-only fillers without
   // giving a maximum number of antennas, beams and spectral channels. By default, these methods return that all
@@ -0,0 +1,270 @@
+/// @file
+///
+/// @brief Accessor interpolating between two calibration solutions
+/// @details This accessor wraps two accessors corresponding to the solutions before
+/// and after the time of interest and returns parameters interpolated between them.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// own includes
+#include <askap/calibaccess/InterpolatingCalSolutionConstAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <cmath>
+
+namespace askap {
+namespace accessors {
+
+/// @brief set up the accessor
+/// @param[in] before accessor for the solution before the time of interest
+/// @param[in] after accessor for the solution after the time of interest
+/// @param[in] weight weight of the second solution (0 gives before, 1 gives after)
+/// @param[in] mode interpolation mode for gains and bandpasses
+InterpolatingCalSolutionConstAccessor::InterpolatingCalSolutionConstAccessor(
+              const boost::shared_ptr<ICalSolutionConstAccessor> &before,
+              const boost::shared_ptr<ICalSolutionConstAccessor> &after, const double weight,
+              const Mode mode) : itsBefore(before), itsAfter(after), itsWeight(weight), itsMode(mode)
+{
+   ASKAPASSERT(before);
+   ASKAPASSERT(after);
+   ASKAPCHECK((weight >= 0.) && (weight <= 1.), "Interpolation weight should be between 0 and 1, you have "<<weight);
+}
+
+/// @brief interpolate between two complex values
+/// @param[in] v1 first value
+/// @param[in] v2 second value
+/// @param[in] weight weight of the second value
+/// @param[in] mode interpolation mode
+/// @return interpolated value
+casacore::Complex InterpolatingCalSolutionConstAccessor::interpolate(const casacore::Complex &v1,
+                  const casacore::Complex &v2, const double weight, const Mode mode)
+{
+   if (mode == LINEAR) {
+       return casacore::Complex(1. - weight) * v1 + casacore::Complex(weight) * v2;
+   }
+   ASKAPDEBUGASSERT(mode == AMPLITUDE_PHASE);
+   const float amp = (1. - weight) * std::abs(v1) + weight * std::abs(v2);
+   // phase difference in the range of -pi to pi, so the phase follows the shortest path
+   const float phase = std::arg(v1) + weight * std::arg(v2 * std::conj(v1));
+   return std::polar(amp, phase);
+}
+
+/// @brief interpolate one element taking validity into account
+/// @param[in] v1 first value
+/// @param[in] valid1 validity of the first value
+/// @param[in] v2 second value
+/// @param[in] valid2 validity of the second value
+/// @param[in] mode interpolation mode
+/// @return interpolated value (first value if neither is valid)
+casacore::Complex InterpolatingCalSolutionConstAccessor::interpolate(const casacore::Complex &v1, const bool valid1,
+                  const casacore::Complex &v2, const bool valid2, const Mode mode) const
+{
+   if (valid1 && valid2) {
+       return interpolate(v1, v2, itsWeight, mode);
+   }
+   return valid2 ? v2 : v1;
+}
+
+/// @brief blend two sets of values obtained in bulk
+/// @details Elements valid in both sets are interpolated, elements valid in the second set
+/// only are copied. The result is stored in the first set.
+/// @param[in,out] values values of the first solution, replaced by the result
+/// @param[in,out] valid validity flags of the first solution, replaced by the result
+/// @param[in] values2 values of the second solution
+/// @param[in] valid2 validity flags of the second solution
+/// @param[in] mode interpolation mode
+void InterpolatingCalSolutionConstAccessor::blend(casacore::Matrix<casacore::Complex> &values,
+                  casacore::Matrix<casacore::Bool> &valid, const casacore::Matrix<casacore::Complex> &values2,
+                  const casacore::Matrix<casacore::Bool> &valid2, const Mode mode) const
+{
+   ASKAPDEBUGASSERT(values.shape() == values2.shape());
+   ASKAPDEBUGASSERT(valid.shape() == valid2.shape());
+   for (casacore::uInt col = 0; col < values.ncolumn(); ++col) {
+        for (casacore::uInt row = 0; row < values.nrow(); ++row) {
+             values(row, col) = interpolate(values(row, col), valid(row, col), values2(row, col), valid2(row, col), mode);
+             valid(row, col) = valid(row, col) || valid2(row, col);
+        }
+   }
+}
+
+/// @brief obtain gains (J-Jones)
+/// @details This method retrieves parallel-hand gains for both
+/// polarisations (corresponding to XX and YY). If no gains are defined
+/// for a particular index, gains of 1. with invalid flags set are
+/// returned.
+/// @param[in] index ant/beam index
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm InterpolatingCalSolutionConstAccessor::gain(const JonesIndex &index) const
+{
+   const JonesJTerm g1 = itsBefore->gain(index);
+   const JonesJTerm g2 = itsAfter->gain(index);
+   return JonesJTerm(interpolate(g1.g1(), g1.g1IsValid(), g2.g1(), g2.g1IsValid(), itsMode),
+                     g1.g1IsValid() || g2.g1IsValid(),
+                     interpolate(g1.g2(), g1.g2IsValid(), g2.g2(), g2.g2IsValid(), itsMode),
+                     g1.g2IsValid() || g2.g2IsValid());
+}
+
+/// @brief obtain leakage (D-Jones)
+/// @details This method retrieves cross-hand elements of the
+/// Jones matrix (polarisation leakages). There are two values
+/// (corresponding to XY and YX) returned (as members of JonesDTerm
+/// class). If no leakages are defined for a particular index,
+/// zero leakages are returned with invalid flags set.
+/// @param[in] index ant/beam index
+/// @return JonesDTerm object with leakages and validity flags
+JonesDTerm InterpolatingCalSolutionConstAccessor::leakage(const JonesIndex &index) const
+{
+   const JonesDTerm d1 = itsBefore->leakage(index);
+   const JonesDTerm d2 = itsAfter->leakage(index);
+   return JonesDTerm(interpolate(d1.d12(), d1.d12IsValid(), d2.d12(), d2.d12IsValid(), LINEAR),
+                     d1.d12IsValid() || d2.d12IsValid(),
+                     interpolate(d1.d21(), d1.d21IsValid(), d2.d21(), d2.d21IsValid(), LINEAR),
+                     d1.d21IsValid() || d2.d21IsValid());
+}
+
+/// @brief obtain bandpass (frequency dependent J-Jones)
+/// @details This method retrieves parallel-hand spectral
+/// channel-dependent gain (also known as bandpass) for a
+/// given channel and antenna/beam. If no bandpass is defined
+/// (at all or for this particular channel), gains of 1.0 are
+/// returned (with invalid flag is set).
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel of interest
+/// @return JonesJTerm object with gains and validity flags
+JonesJTerm InterpolatingCalSolutionConstAccessor::bandpass(const JonesIndex &index, const casacore::uInt chan) const
+{
+   const JonesJTerm bp1 = itsBefore->bandpass(index, chan);
+   const JonesJTerm bp2 = itsAfter->bandpass(index, chan);
+   return JonesJTerm(interpolate(bp1.g1(), bp1.g1IsValid(), bp2.g1(), bp2.g1IsValid(), itsMode),
+                     bp1.g1IsValid() || bp2.g1IsValid(),
+                     interpolate(bp1.g2(), bp1.g2IsValid(), bp2.g2(), bp2.g2IsValid(), itsMode),
+                     bp1.g2IsValid() || bp2.g2IsValid());
+}
+
+/// @brief obtain bandpass leakage (D-Jones)
+/// @details This method retrieves cross-hand elements of the
+/// channel dependent Jones matrix (polarisation leakages). There are two values
+/// (corresponding to XY and YX) returned (as members of JonesDTerm
+/// class). If no leakages are defined for a particular index,
+/// zero leakages are returned with invalid flags set.
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel of interest
+/// @return JonesDTerm object with leakages and validity flags
+JonesDTerm InterpolatingCalSolutionConstAccessor::bpleakage(const JonesIndex &index, const casacore::uInt chan) const
+{
+   const JonesDTerm d1 = itsBefore->bpleakage(index, chan);
+   const JonesDTerm d2 = itsAfter->bpleakage(index, chan);
+   return JonesDTerm(interpolate(d1.d12(), d1.d12IsValid(), d2.d12(), d2.d12IsValid(), LINEAR),
+                     d1.d12IsValid() || d2.d12IsValid(),
+                     interpolate(d1.d21(), d1.d21IsValid(), d2.d21(), d2.d21IsValid(), LINEAR),
+                     d1.d21IsValid() || d2.d21IsValid());
+}
+
+/// @brief obtain ionospheric parameter
+/// @details This method retrieves an ionospheric parameter.
+/// If no gains are defined for a particular index zero is returned with an invalid flag.
+/// @param[in] index ant/beam index
+/// @return IonoTerm object with gains and validity flags
+IonoTerm InterpolatingCalSolutionConstAccessor::ionoparam(const JonesIndex &index) const
+{
+   const IonoTerm p1 = itsBefore->ionoparam(index);
+   const IonoTerm p2 = itsAfter->ionoparam(index);
+   return IonoTerm(interpolate(p1.param(), p1.paramIsValid(), p2.param(), p2.paramIsValid(), LINEAR),
+                   p1.paramIsValid() || p2.paramIsValid());
+}
+
+/// @brief obtain gains for all antennas of one beam
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas
+/// @param[out] gains 2 x nAnt matrix with gains, first row is XX, second is YY (resized as necessary)
+/// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+void InterpolatingCalSolutionConstAccessor::gainsForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                             casacore::Matrix<casacore::Complex> &gains,
+                             casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsBefore->gainsForBeam(beam, nAnt, gains, valid);
+   casacore::Matrix<casacore::Complex> gains2;
+   casacore::Matrix<casacore::Bool> valid2;
+   itsAfter->gainsForBeam(beam, nAnt, gains2, valid2);
+   blend(gains, valid, gains2, valid2, itsMode);
+}
+
+/// @brief obtain leakages for all antennas of one beam
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas
+/// @param[out] leakages 2 x nAnt matrix with leakages, first row is XY, second is YX (resized as necessary)
+/// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+void InterpolatingCalSolutionConstAccessor::leakagesForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsBefore->leakagesForBeam(beam, nAnt, leakages, valid);
+   casacore::Matrix<casacore::Complex> leakages2;
+   casacore::Matrix<casacore::Bool> valid2;
+   itsAfter->leakagesForBeam(beam, nAnt, leakages2, valid2);
+   blend(leakages, valid, leakages2, valid2, LINEAR);
+}
+
+/// @brief obtain bandpass for all antennas of one beam over a range of channels
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] gains (2*nChan) x nAnt matrix with gains (resized as necessary)
+/// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+void InterpolatingCalSolutionConstAccessor::bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &gains,
+                                casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsBefore->bandpassForBeam(beam, nAnt, startChan, nChan, gains, valid);
+   casacore::Matrix<casacore::Complex> gains2;
+   casacore::Matrix<casacore::Bool> valid2;
+   itsAfter->bandpassForBeam(beam, nAnt, startChan, nChan, gains2, valid2);
+   blend(gains, valid, gains2, valid2, itsMode);
+}
+
+/// @brief obtain bandpass leakages for all antennas of one beam over a range of channels
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas
+/// @param[in] startChan first spectral channel
+/// @param[in] nChan number of spectral channels
+/// @param[out] leakages (2*nChan) x nAnt matrix with leakages (resized as necessary)
+/// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+void InterpolatingCalSolutionConstAccessor::bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                 const casacore::uInt startChan, const casacore::uInt nChan,
+                                 casacore::Matrix<casacore::Complex> &leakages,
+                                 casacore::Matrix<casacore::Bool> &valid) const
+{
+   itsBefore->bpleakageForBeam(beam, nAnt, startChan, nChan, leakages, valid);
+   casacore::Matrix<casacore::Complex> leakages2;
+   casacore::Matrix<casacore::Bool> valid2;
+   itsAfter->bpleakageForBeam(beam, nAnt, startChan, nChan, leakages2, valid2);
+   blend(leakages, valid, leakages2, valid2, LINEAR);
+}
+
+} // namespace accessors
+} // namespace askap
@@ -0,0 +1,218 @@
+/// @file
+///
+/// @brief Accessor interpolating between two calibration solutions
+/// @details This accessor wraps two accessors corresponding to the solutions before
+/// and after the time of interest and returns parameters interpolated between them.
+/// It is normally obtained from InterpolatingCalSolutionConstSource.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_ACCESSOR_H
+#define ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_ACCESSOR_H
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Accessor interpolating between two calibration solutions
+/// @details Gains and bandpasses are interpolated either linearly in the complex plane or
+/// separately in amplitude and phase (the phase follows the shortest path). Leakages and
+/// ionospheric parameters are always interpolated linearly, as they are usually close to zero
+/// and their phase is poorly defined. If a parameter is valid in one solution only, the valid
+/// value is returned as is. The weight of the second solution is fixed for the lifetime of
+/// the object, being given by the time of interest with respect to the times of both solutions.
+/// The bulk methods obtain the parameters of both solutions in bulk and blend them element by element.
+/// @ingroup calibaccess
+struct InterpolatingCalSolutionConstAccessor : public ICalSolutionConstAccessor {
+
+   /// @brief interpolation modes
+   enum Mode {
+      /// @brief linear interpolation of the complex value
+      LINEAR = 0,
+      /// @brief linear interpolation of the amplitude and phase
+      AMPLITUDE_PHASE
+   };
+
+   /// @brief set up the accessor
+   /// @param[in] before accessor for the solution before the time of interest
+   /// @param[in] after accessor for the solution after the time of interest
+   /// @param[in] weight weight of the second solution (0 gives before, 1 gives after)
+   /// @param[in] mode interpolation mode for gains and bandpasses
+   InterpolatingCalSolutionConstAccessor(const boost::shared_ptr<ICalSolutionConstAccessor> &before,
+              const boost::shared_ptr<ICalSolutionConstAccessor> &after, const double weight,
+              const Mode mode = LINEAR);
+
+   /// @brief obtain gains (J-Jones)
+   /// @details This method retrieves parallel-hand gains for both
+   /// polarisations (corresponding to XX and YY). If no gains are defined
+   /// for a particular index, gains of 1. with invalid flags set are
+   /// returned.
+   /// @param[in] index ant/beam index
+   /// @return JonesJTerm object with gains and validity flags
+   virtual JonesJTerm gain(const JonesIndex &index) const;
+
+   /// @brief obtain leakage (D-Jones)
+   /// @details This method retrieves cross-hand elements of the
+   /// Jones matrix (polarisation leakages). There are two values
+   /// (corresponding to XY and YX) returned (as members of JonesDTerm
+   /// class). If no leakages are defined for a particular index,
+   /// zero leakages are returned with invalid flags set.
+   /// @param[in] index ant/beam index
+   /// @return JonesDTerm object with leakages and validity flags
+   virtual JonesDTerm leakage(const JonesIndex &index) const;
+
+   /// @brief obtain bandpass (frequency dependent J-Jones)
+   /// @details This method retrieves parallel-hand spectral
+   /// channel-dependent gain (also known as bandpass) for a
+   /// given channel and antenna/beam. If no bandpass is defined
+   /// (at all or for this particular channel), gains of 1.0 are
+   /// returned (with invalid flag is set).
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest
+   /// @return JonesJTerm object with gains and validity flags
+   virtual JonesJTerm bandpass(const JonesIndex &index, const casacore::uInt chan) const;
+
+   /// @brief obtain bandpass leakage (D-Jones)
+   /// @details This method retrieves cross-hand elements of the
+   /// channel dependent Jones matrix (polarisation leakages). There are two values
+   /// (corresponding to XY and YX) returned (as members of JonesDTerm
+   /// class). If no leakages are defined for a particular index,
+   /// zero leakages are returned with invalid flags set.
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest
+   /// @return JonesDTerm object with leakages and validity flags
+   virtual JonesDTerm bpleakage(const JonesIndex &index, const casacore::uInt chan) const;
+
+   /// @brief obtain ionospheric parameter
+   /// @details This method retrieves an ionospheric parameter.
+   /// If no gains are defined for a particular index zero is returned with an invalid flag.
+   /// @param[in] index ant/beam index
+   /// @return IonoTerm object with gains and validity flags
+   virtual IonoTerm ionoparam(const JonesIndex &index) const;
+
+   /// @brief obtain gains for all antennas of one beam
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] gains 2 x nAnt matrix with gains, first row is XX, second is YY (resized as necessary)
+   /// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+   virtual void gainsForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                             casacore::Matrix<casacore::Complex> &gains,
+                             casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain leakages for all antennas of one beam
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] leakages 2 x nAnt matrix with leakages, first row is XY, second is YX (resized as necessary)
+   /// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+   virtual void leakagesForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain bandpass for all antennas of one beam over a range of channels
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] gains (2*nChan) x nAnt matrix with gains (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   virtual void bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &gains,
+                                casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain bandpass leakages for all antennas of one beam over a range of channels
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] leakages (2*nChan) x nAnt matrix with leakages (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   virtual void bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                 const casacore::uInt startChan, const casacore::uInt nChan,
+                                 casacore::Matrix<casacore::Complex> &leakages,
+                                 casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @return weight of the second solution
+   inline double weight() const { return itsWeight; }
+
+   /// @return interpolation mode for gains and bandpasses
+   inline Mode mode() const { return itsMode; }
+
+   /// @brief interpolate between two complex values
+   /// @param[in] v1 first value
+   /// @param[in] v2 second value
+   /// @param[in] weight weight of the second value
+   /// @param[in] mode interpolation mode
+   /// @return interpolated value
+   static casacore::Complex interpolate(const casacore::Complex &v1, const casacore::Complex &v2,
+                                        const double weight, const Mode mode);
+
+   /// @brief shared pointer definition
+   typedef boost::shared_ptr<InterpolatingCalSolutionConstAccessor> ShPtr;
+private:
+   /// @brief blend two sets of values obtained in bulk
+   /// @details Elements valid in both sets are interpolated, elements valid in the second set
+   /// only are copied. The result is stored in the first set.
+   /// @param[in,out] values values of the first solution, replaced by the result
+   /// @param[in,out] valid validity flags of the first solution, replaced by the result
+   /// @param[in] values2 values of the second solution
+   /// @param[in] valid2 validity flags of the second solution
+   /// @param[in] mode interpolation mode
+   void blend(casacore::Matrix<casacore::Complex> &values, casacore::Matrix<casacore::Bool> &valid,
+              const casacore::Matrix<casacore::Complex> &values2,
+              const casacore::Matrix<casacore::Bool> &valid2, const Mode mode) const;
+
+   /// @brief interpolate one element taking validity into account
+   /// @param[in] v1 first value
+   /// @param[in] valid1 validity of the first value
+   /// @param[in] v2 second value
+   /// @param[in] valid2 validity of the second value
+   /// @param[in] mode interpolation mode
+   /// @return interpolated value (first value if neither is valid)
+   casacore::Complex interpolate(const casacore::Complex &v1, const bool valid1,
+                                 const casacore::Complex &v2, const bool valid2, const Mode mode) const;
+
+   /// @brief solution before the time of interest
+   const boost::shared_ptr<ICalSolutionConstAccessor> itsBefore;
+
+   /// @brief solution after the time of interest
+   const boost::shared_ptr<ICalSolutionConstAccessor> itsAfter;
+
+   /// @brief weight of the second solution
+   const double itsWeight;
+
+   /// @brief interpolation mode for gains and bandpasses
+   const Mode itsMode;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_ACCESSOR_H
@@ -0,0 +1,159 @@
+/// @file
+///
+/// @brief Solution source interpolating between neighbouring solutions in time
+/// @details This adapter wraps another source and provides accessors interpolating
+/// between the solutions before and after the given time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// own includes
+#include <askap/calibaccess/InterpolatingCalSolutionConstSource.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief set up the adapter
+/// @param[in] src shared pointer to the original source
+/// @param[in] mode interpolation mode for gains and bandpasses
+InterpolatingCalSolutionConstSource::InterpolatingCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src,
+             const InterpolatingCalSolutionConstAccessor::Mode mode) : itsSource(src), itsMode(mode), itsSolutionsLoaded(0)
+{
+   ASKAPASSERT(src);
+}
+
+/// @brief obtain ID for the most recent solution
+/// @return ID for the most recent solution
+long InterpolatingCalSolutionConstSource::mostRecentSolution() const
+{
+   return itsSource->mostRecentSolution();
+}
+
+/// @brief obtain solution ID for a given time
+/// @details This method looks for a solution valid at the given time
+/// and returns its ID. It is equivalent to mostRecentSolution() if
+/// called with a time sufficiently into the future.
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID
+long InterpolatingCalSolutionConstSource::solutionID(const double time) const
+{
+   return itsSource->solutionID(time);
+}
+
+/// @brief obtain solution ID for a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID, time of solution
+std::pair<long, double> InterpolatingCalSolutionConstSource::solutionIDBefore(const double time) const
+{
+   return itsSource->solutionIDBefore(time);
+}
+
+/// @brief obtain closest solution ID after a given time
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @return solution ID, time of solution
+std::pair<long, double> InterpolatingCalSolutionConstSource::solutionIDAfter(const double time) const
+{
+   return itsSource->solutionIDAfter(time);
+}
+
+/// @brief obtain read-only accessor for a given solution ID
+/// @param[in] id solution ID to read
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> InterpolatingCalSolutionConstSource::roSolution(const long id) const
+{
+   return itsSource->roSolution(id);
+}
+
+/// @brief obtain read-only accessor for a given solution ID and a range of channels
+/// @param[in] id solution ID to read
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> InterpolatingCalSolutionConstSource::roSolutionForChannels(const long id,
+                    const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+   return itsSource->roSolutionForChannels(id, startChan, nChan);
+}
+
+/// @brief obtain accessor for the given solution reusing the resident one if possible
+/// @param[in] id solution ID
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range, zero means all channels
+/// @param[in] resident solutions which can be reused
+/// @return resident solution
+InterpolatingCalSolutionConstSource::ResidentSolution InterpolatingCalSolutionConstSource::getSolution(const long id,
+                    const casacore::uInt startChan, const casacore::uInt nChan,
+                    const std::vector<ResidentSolution> &resident) const
+{
+   for (std::vector<ResidentSolution>::const_iterator ci = resident.begin(); ci != resident.end(); ++ci) {
+        if ((ci->itsID == id) && (ci->itsStartChan == startChan) && (ci->itsNChan == nChan)) {
+            return *ci;
+        }
+   }
+   ResidentSolution result;
+   result.itsID = id;
+   result.itsStartChan = startChan;
+   result.itsNChan = nChan;
+   result.itsAccessor = (startChan == 0) && (nChan == 0) ? itsSource->roSolution(id) :
+                        itsSource->roSolutionForChannels(id, startChan, nChan);
+   ASKAPCHECK(result.itsAccessor, "Unable to obtain accessor for solution "<<id);
+   ++itsSolutionsLoaded;
+   return result;
+}
+
+/// @brief obtain read-only accessor interpolated to the given time
+/// @details The accessor interpolates between the solutions before and after the given time
+/// with the weight proportional to the time elapsed since the first solution. The bracketing
+/// solutions are kept resident until a different pair is needed.
+/// @param[in] time time stamp in seconds since MJD of 0.
+/// @param[in] startChan first channel of the range (see roSolutionForChannels)
+/// @param[in] nChan number of channels in the range, zero means all channels
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> InterpolatingCalSolutionConstSource::roSolutionForTime(const double time,
+                    const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+   const std::pair<long, double> before = itsSource->solutionIDBefore(time);
+   const std::pair<long, double> after = itsSource->solutionIDAfter(time);
+   std::vector<ResidentSolution> resident;
+   resident.push_back(getSolution(before.first, startChan, nChan, itsResident));
+   if ((after.first == before.first) || (after.second <= before.second) || (time <= before.second)) {
+       itsResident.swap(resident);
+       return itsResident[0].itsAccessor;
+   }
+   resident.push_back(getSolution(after.first, startChan, nChan, itsResident));
+   itsResident.swap(resident);
+   const double weight = std::min((time - before.second) / (after.second - before.second), 1.);
+   const boost::shared_ptr<InterpolatingCalSolutionConstAccessor> result(new InterpolatingCalSolutionConstAccessor(
+          itsResident[0].itsAccessor, itsResident[1].itsAccessor, weight, itsMode));
+   return result;
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,159 @@
+/// @file
+///
+/// @brief Solution source interpolating between neighbouring solutions in time
+/// @details solutionID(time) selects a single solution, so time-varying calibration
+/// is applied piecewise-constant. This adapter wraps another source and provides
+/// accessors interpolating between the solutions before and after the given time.
+/// The two bracketing solutions are kept resident, so consecutive requests within
+/// the same solution interval do not read the solutions again.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_SOURCE_H
+#define ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_SOURCE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/InterpolatingCalSolutionConstAccessor.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Solution source interpolating between neighbouring solutions in time
+/// @details All methods of ICalSolutionConstSource are passed to the wrapped source,
+/// interpolation is done by roSolutionForTime. The times of solutions are obtained via
+/// solutionIDBefore and solutionIDAfter, so the wrapped source should implement them
+/// (e.g. TableCalSolutionConstSource). If the time matches a solution or is outside the
+/// range covered by the solutions, an accessor to the nearest solution is returned as is.
+/// The class is not thread-safe.
+/// @ingroup calibaccess
+struct InterpolatingCalSolutionConstSource : public ICalSolutionConstSource {
+
+   /// @brief set up the adapter
+   /// @param[in] src shared pointer to the original source
+   /// @param[in] mode interpolation mode for gains and bandpasses
+   explicit InterpolatingCalSolutionConstSource(const boost::shared_ptr<ICalSolutionConstSource> &src,
+             const InterpolatingCalSolutionConstAccessor::Mode mode = InterpolatingCalSolutionConstAccessor::LINEAR);
+
+   /// @brief obtain ID for the most recent solution
+   /// @return ID for the most recent solution
+   virtual long mostRecentSolution() const;
+
+   /// @brief obtain solution ID for a given time
+   /// @details This method looks for a solution valid at the given time
+   /// and returns its ID. It is equivalent to mostRecentSolution() if
+   /// called with a time sufficiently into the future.
+   /// @param[in] time time stamp in seconds since MJD of 0.
+   /// @return solution ID
+   virtual long solutionID(const double time) const;
+
+   /// @brief obtain solution ID for a given time
+   /// @param[in] time time stamp in seconds since MJD of 0.
+   /// @return solution ID, time of solution
+   virtual std::pair<long, double> solutionIDBefore(const double time) const;
+
+   /// @brief obtain closest solution ID after a given time
+   /// @param[in] time time stamp in seconds since MJD of 0.
+   /// @return solution ID, time of solution
+   virtual std::pair<long, double> solutionIDAfter(const double time) const;
+
+   /// @brief obtain read-only accessor for a given solution ID
+   /// @details This method returns a shared pointer to the solution accessor, which
+   /// can be used to read the parameters. If a solution with the given ID doesn't
+   /// exist, an exception is thrown. Existing solutions with undefined parameters
+   /// are managed via validity flags of gains, leakages and bandpasses
+   /// @param[in] id solution ID to read
+   /// @return shared pointer to an accessor object
+   virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const;
+
+   /// @brief obtain read-only accessor for a given solution ID and a range of channels
+   /// @param[in] id solution ID to read
+   /// @param[in] startChan first channel of the range
+   /// @param[in] nChan number of channels in the range
+   /// @return shared pointer to an accessor object
+   virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolutionForChannels(const long id,
+                    const casacore::uInt startChan, const casacore::uInt nChan) const;
+
+   /// @brief obtain read-only accessor interpolated to the given time
+   /// @details The accessor interpolates between the solutions before and after the given time
+   /// with the weight proportional to the time elapsed since the first solution. The bracketing
+   /// solutions are kept resident until a different pair is needed.
+   /// @param[in] time time stamp in seconds since MJD of 0.
+   /// @param[in] startChan first channel of the range (see roSolutionForChannels)
+   /// @param[in] nChan number of channels in the range, zero means all channels
+   /// @return shared pointer to an accessor object
+   boost::shared_ptr<ICalSolutionConstAccessor> roSolutionForTime(const double time,
+                    const casacore::uInt startChan = 0, const casacore::uInt nChan = 0) const;
+
+   /// @return number of solutions read from the wrapped source so far
+   inline size_t solutionsLoaded() const { return itsSolutionsLoaded; }
+
+   /// @brief shared pointer definition
+   typedef boost::shared_ptr<InterpolatingCalSolutionConstSource> ShPtr;
+
+private:
+   /// @brief resident solution
+   struct ResidentSolution {
+      /// @brief solution ID
+      long itsID;
+      /// @brief first channel of the range
+      casacore::uInt itsStartChan;
+      /// @brief number of channels in the range, zero means all channels
+      casacore::uInt itsNChan;
+      /// @brief accessor
+      boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor;
+   };
+
+   /// @brief obtain accessor for the given solution reusing the resident one if possible
+   /// @param[in] id solution ID
+   /// @param[in] startChan first channel of the range
+   /// @param[in] nChan number of channels in the range, zero means all channels
+   /// @param[in] resident solutions which can be reused
+   /// @return resident solution
+   ResidentSolution getSolution(const long id, const casacore::uInt startChan, const casacore::uInt nChan,
+                                const std::vector<ResidentSolution> &resident) const;
+
+   /// @brief original source
+   const boost::shared_ptr<ICalSolutionConstSource> itsSource;
+
+   /// @brief interpolation mode for gains and bandpasses
+   const InterpolatingCalSolutionConstAccessor::Mode itsMode;
+
+   /// @brief solutions used by the last call to roSolutionForTime (at most two)
+   mutable std::vector<ResidentSolution> itsResident;
+
+   /// @brief number of solutions read from the wrapped source
+   mutable size_t itsSolutionsLoaded;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_INTERPOLATING_CAL_SOLUTION_CONST_SOURCE_H
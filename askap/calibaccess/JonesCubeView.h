@@ -0,0 +1,258 @@
+/// @file
+///
+/// @brief Inlined element access to cached calibration solutions
+/// @details MemCalSolutionAccessor checks the antenna, beam and row indices against
+/// the shape of the cache on every call of the getters and goes through the virtual
+/// interface. This template gives direct read-only access to the cached values and
+/// validity flags. The address calculation is delegated to a layout policy class and
+/// is inlined, bounds are only checked in debug builds. The number of channels can be
+/// fixed at compile time (e.g. to one for gains and leakages).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_JONES_CUBE_VIEW_H
+#define ASKAP_ACCESSORS_JONES_CUBE_VIEW_H
+
+// own includes
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/calibaccess/JonesJTerm.h>
+#include <askap/calibaccess/JonesDTerm.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// std includes
+#include <utility>
+#include <cstddef>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief layout of the cubes cached by MemCalSolutionAccessor
+/// @details The cubes are (2*nChan) x nAnt x nBeam in the casacore (Fortran) order.
+/// Polarisation varies fastest, then channel, antenna and beam.
+/// @ingroup calibaccess
+struct CubeJonesLayout {
+   /// @brief flat index of an element
+   /// @param[in] pol polarisation index (0 or 1)
+   /// @param[in] chan channel index
+   /// @param[in] ant antenna index
+   /// @param[in] beam beam index
+   /// @param[in] nChan number of channels
+   /// @param[in] nAnt number of antennas
+   /// @param[in] nBeam number of beams (not used)
+   /// @return offset with respect to the first element
+   static constexpr size_t offset(casacore::uInt pol, casacore::uInt chan, casacore::uInt ant, casacore::uInt beam,
+                                  casacore::uInt nChan, casacore::uInt nAnt, casacore::uInt)
+      { return ((size_t(beam) * nAnt + ant) * nChan + chan) * 2 + pol; }
+};
+
+/// @brief channel-major layout
+/// @details Polarisation varies fastest, then antenna, beam and channel. This is the order
+/// used by DenseCalSolutionStore, the bandpass filled channel by channel only grows at the end.
+/// @ingroup calibaccess
+struct ChannelMajorJonesLayout {
+   /// @brief flat index of an element
+   /// @param[in] pol polarisation index (0 or 1)
+   /// @param[in] chan channel index
+   /// @param[in] ant antenna index
+   /// @param[in] beam beam index
+   /// @param[in] nChan number of channels (not used)
+   /// @param[in] nAnt number of antennas
+   /// @param[in] nBeam number of beams
+   /// @return offset with respect to the first element
+   static constexpr size_t offset(casacore::uInt pol, casacore::uInt chan, casacore::uInt ant, casacore::uInt beam,
+                                  casacore::uInt, casacore::uInt nAnt, casacore::uInt nBeam)
+      { return ((size_t(chan) * nBeam + beam) * nAnt + ant) * 2 + pol; }
+};
+
+/// @brief Inlined read-only access to values and validity flags of calibration terms
+/// @details Layout is a policy class with a static offset method (see CubeJonesLayout
+/// and ChannelMajorJonesLayout). The view points to the memory owned by someone else
+/// (e.g. the cache of MemCalSolutionAccessor), which must not be resized or released while the view is in use.
+/// Element access doesn't do any checks in the release build, so the caller is expected
+/// to check the indices against nAnt, nBeam and nChan once before the loop. If NChan is
+/// not zero, the number of channels is a compile-time constant and the channel arguments
+/// default to zero, which suits gains and leakages. Otherwise, the number of channels is
+/// given at construction.
+/// @ingroup calibaccess
+template<typename Layout, casacore::uInt NChan = 0>
+class JonesCubeView {
+public:
+   /// @brief construct an empty view
+   JonesCubeView() : itsValues(0), itsValid(0), itsNAnt(0), itsNBeam(0), itsNChan(NChan) {}
+
+   /// @brief construct a view of the given memory
+   /// @param[in] values pointer to the first value
+   /// @param[in] valid pointer to the first validity flag
+   /// @param[in] nAnt number of antennas
+   /// @param[in] nBeam number of beams
+   /// @param[in] nChan number of channels (should match NChan, unless it is zero)
+   JonesCubeView(const casacore::Complex *values, const casacore::Bool *valid, casacore::uInt nAnt,
+                 casacore::uInt nBeam, casacore::uInt nChan = NChan) : itsValues(values), itsValid(valid),
+                 itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan)
+      {
+        ASKAPCHECK((NChan == 0) || (nChan == NChan), "The view is set up for "<<NChan<<
+                   " channel(s), the data have "<<nChan);
+        ASKAPCHECK(((values != 0) && (valid != 0)) || (nAnt * nBeam * nChan == 0),
+                   "Data for calibration terms are not available");
+      }
+
+   /// @return true, if the view has no elements
+   inline bool empty() const { return nAnt() * nBeam() * nChan() == 0; }
+
+   /// @return number of antennas
+   inline casacore::uInt nAnt() const { return itsNAnt; }
+
+   /// @return number of beams
+   inline casacore::uInt nBeam() const { return itsNBeam; }
+
+   /// @return number of channels
+   inline casacore::uInt nChan() const { return NChan != 0 ? NChan : itsNChan; }
+
+   /// @brief obtain a value
+   /// @param[in] pol polarisation index (0 or 1)
+   /// @param[in] ant antenna index
+   /// @param[in] beam beam index
+   /// @param[in] chan channel index
+   /// @return value of the element (regardless of its validity)
+   inline const casacore::Complex& value(casacore::uInt pol, casacore::uInt ant, casacore::uInt beam,
+                                         casacore::uInt chan = 0) const
+      { return itsValues[index(pol, ant, beam, chan)]; }
+
+   /// @brief obtain a validity flag
+   /// @param[in] pol polarisation index (0 or 1)
+   /// @param[in] ant antenna index
+   /// @param[in] beam beam index
+   /// @param[in] chan channel index
+   /// @return true, if the element is valid
+   inline casacore::Bool isValid(casacore::uInt pol, casacore::uInt ant, casacore::uInt beam,
+                                 casacore::uInt chan = 0) const
+      { return itsValid[index(pol, ant, beam, chan)]; }
+
+   /// @brief obtain parallel-hand terms
+   /// @details This is the equivalent of gain or bandpass of the accessor.
+   /// @param[in] jIndex ant/beam index
+   /// @param[in] chan channel index
+   /// @return JonesJTerm object with gains and validity flags
+   inline JonesJTerm jterm(const JonesIndex &jIndex, casacore::uInt chan = 0) const
+      {
+        const size_t i = index(0, antennaIndex(jIndex), beamIndex(jIndex), chan);
+        return JonesJTerm(itsValues[i], itsValid[i], itsValues[i + 1], itsValid[i + 1]);
+      }
+
+   /// @brief obtain cross-hand terms
+   /// @details This is the equivalent of leakage or bpleakage of the accessor.
+   /// @param[in] jIndex ant/beam index
+   /// @param[in] chan channel index
+   /// @return JonesDTerm object with leakages and validity flags
+   inline JonesDTerm dterm(const JonesIndex &jIndex, casacore::uInt chan = 0) const
+      {
+        const size_t i = index(0, antennaIndex(jIndex), beamIndex(jIndex), chan);
+        return JonesDTerm(itsValues[i], itsValid[i], itsValues[i + 1], itsValid[i + 1]);
+      }
+
+   /// @brief flat index of an element
+   /// @param[in] pol polarisation index (0 or 1)
+   /// @param[in] ant antenna index
+   /// @param[in] beam beam index
+   /// @param[in] chan channel index
+   /// @return index into the value and flag arrays
+   inline size_t index(casacore::uInt pol, casacore::uInt ant, casacore::uInt beam, casacore::uInt chan) const
+      {
+        ASKAPDEBUGASSERT(pol < 2);
+        ASKAPDEBUGASSERT(ant < nAnt());
+        ASKAPDEBUGASSERT(beam < nBeam());
+        ASKAPDEBUGASSERT(chan < nChan());
+        return Layout::offset(pol, chan, ant, beam, nChan(), nAnt(), nBeam());
+      }
+
+private:
+   /// @brief antenna index
+   /// @param[in] jIndex ant/beam index
+   /// @return antenna index as an unsigned number
+   static inline casacore::uInt antennaIndex(const JonesIndex &jIndex)
+      {
+        ASKAPDEBUGASSERT(jIndex.antenna() >= 0);
+        return casacore::uInt(jIndex.antenna());
+      }
+
+   /// @brief beam index
+   /// @param[in] jIndex ant/beam index
+   /// @return beam index as an unsigned number
+   static inline casacore::uInt beamIndex(const JonesIndex &jIndex)
+      {
+        ASKAPDEBUGASSERT(jIndex.beam() >= 0);
+        return casacore::uInt(jIndex.beam());
+      }
+
+   /// @brief pointer to the values
+   const casacore::Complex *itsValues;
+
+   /// @brief pointer to the validity flags
+   const casacore::Bool *itsValid;
+
+   /// @brief number of antennas
+   casacore::uInt itsNAnt;
+
+   /// @brief number of beams
+   casacore::uInt itsNBeam;
+
+   /// @brief number of channels (used if NChan is zero)
+   casacore::uInt itsNChan;
+};
+
+/// @brief set up a view of a cube pair
+/// @details The cubes are expected to be in the format cached by MemCalSolutionAccessor,
+/// i.e. (2*nChan) x nAnt x nBeam with contiguous storage. The shape is checked here, so the
+/// access via the view doesn't need to do it. An empty view is returned for empty cubes.
+/// @param[in] cubes cube pair with values and validity flags
+/// @return view of the cubes
+template<casacore::uInt NChan>
+JonesCubeView<CubeJonesLayout, NChan> jonesCubeView(const std::pair<casacore::Cube<casacore::Complex>,
+                                                    casacore::Cube<casacore::Bool> > &cubes)
+{
+   if (cubes.first.nelements() == 0) {
+       return JonesCubeView<CubeJonesLayout, NChan>();
+   }
+   ASKAPCHECK(cubes.first.shape() == cubes.second.shape(), "Values and validity flags have different shapes: "<<
+              cubes.first.shape()<<" and "<<cubes.second.shape());
+   ASKAPCHECK(cubes.first.nrow() % 2 == 0, "Expect even number of rows in the cube, shape="<<cubes.first.shape());
+   ASKAPCHECK(cubes.first.contiguousStorage() && cubes.second.contiguousStorage(),
+              "Only cubes with contiguous storage are supported");
+   return JonesCubeView<CubeJonesLayout, NChan>(cubes.first.data(), cubes.second.data(), cubes.first.ncolumn(),
+              cubes.first.nplane(), cubes.first.nrow() / 2);
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_JONES_CUBE_VIEW_H
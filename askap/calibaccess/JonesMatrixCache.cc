@@ -0,0 +1,297 @@
+/// @file
+///
+/// @brief Precomputed Jones matrices for all beams, antennas and channels
+/// @details CalibrationAccessorAdapter composes (and, for correction, inverts) the Jones
+/// matrices for every accessor it wraps. For a solution which doesn't change between
+/// accessors this work is repeated for every integration. This class does it once per
+/// solution and can be shared by any number of adapters.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/JonesMatrixCache.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <algorithm>
+#include <exception>
+
+ASKAP_LOGGER(logger, ".calibaccess.JonesMatrixCache");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief maximum number of threads used by default
+const size_t theMaxThreads = 8;
+
+} // anonymous namespace
+
+/// @brief functor composing matrices for a subset of beams in a separate thread
+/// @details Beams part, part + nParts, part + 2*nParts, ... are processed
+struct JonesMatrixCache::Composer {
+   /// @brief set up the functor
+   /// @param[in] cache cache to fill
+   /// @param[in] terms terms of all beams
+   /// @param[in] part index of this part
+   /// @param[in] nParts total number of parts
+   /// @param[out] error error encountered, if any
+   Composer(JonesMatrixCache &cache, const std::vector<BeamTerms> &terms, size_t part, size_t nParts,
+            std::exception_ptr &error) : itsCache(&cache), itsTerms(&terms), itsPart(part),
+            itsNParts(nParts), itsError(&error) {}
+
+   /// @brief compose the matrices, errors are stored
+   void operator()() const {
+      try {
+         for (size_t beam = itsPart; beam < itsTerms->size(); beam += itsNParts) {
+              composeBeamJones((*itsTerms)[beam], itsCache->itsNAnt, itsCache->itsNChan, itsCache->itsCorrect,
+                               itsCache->itsRequireAllValid, itsCache->itsBeams[beam]);
+         }
+      }
+      catch (...) {
+         *itsError = std::current_exception();
+      }
+   }
+
+   /// @brief cache to fill
+   JonesMatrixCache *itsCache;
+   /// @brief terms of all beams
+   const std::vector<BeamTerms> *itsTerms;
+   /// @brief index of this part
+   size_t itsPart;
+   /// @brief total number of parts
+   size_t itsNParts;
+   /// @brief error encountered in this part
+   std::exception_ptr *itsError;
+};
+
+/// @brief compute the matrices
+/// @param[in] calSolution calibration solution
+/// @param[in] nAnt number of antennas
+/// @param[in] nBeam number of beams
+/// @param[in] startChan first channel of the solution to cache
+/// @param[in] nChan number of channels to cache
+/// @param[in] correct if true, the matrices are inverted
+/// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid,
+///            otherwise the validity rule of jonesValid is used
+/// @param[in] nThreads number of threads to use, zero means to decide based on the
+///            number of beams and cores
+/// @param[in] solutionID ID of the solution (for information only), negative if unknown
+JonesMatrixCache::JonesMatrixCache(const ICalSolutionConstAccessor::ShPtr &calSolution, casacore::uInt nAnt,
+                   casacore::uInt nBeam, casacore::uInt startChan, casacore::uInt nChan,
+                   bool correct, bool requireAllValid, size_t nThreads, long solutionID) :
+      itsNAnt(nAnt), itsStartChan(startChan), itsNChan(nChan), itsCorrect(correct),
+      itsRequireAllValid(requireAllValid), itsSolutionID(solutionID), itsBeams(nBeam)
+{
+  ASKAPCHECK(calSolution, "An attempt to initialise JonesMatrixCache with empty solution");
+  // accessors are not thread-safe, read all terms first
+  std::vector<BeamTerms> terms(nBeam);
+  for (casacore::uInt beam = 0; beam < nBeam; ++beam) {
+       readBeamTerms(*calSolution, beam, nAnt, startChan, nChan, terms[beam]);
+  }
+  if (nThreads == 0) {
+      nThreads = std::min(size_t(boost::thread::hardware_concurrency()), theMaxThreads);
+  }
+  nThreads = std::max(std::min(nThreads, size_t(nBeam)), size_t(1));
+  std::vector<std::exception_ptr> errors(nThreads);
+  if (nThreads == 1) {
+      Composer(*this, terms, 0, 1, errors[0])();
+  } else {
+      boost::thread_group threads;
+      for (size_t part = 0; part < nThreads; ++part) {
+           threads.create_thread(Composer(*this, terms, part, nThreads, errors[part]));
+      }
+      threads.join_all();
+  }
+  for (size_t part = 0; part < nThreads; ++part) {
+       if (errors[part]) {
+           std::rethrow_exception(errors[part]);
+       }
+  }
+  ASKAPLOG_DEBUG_STR(logger, "Cached "<<(correct ? "inverse " : "")<<"Jones matrices for solution "<<
+                     solutionID<<": "<<nAnt<<" antenna(s), "<<nBeam<<" beam(s), "<<nChan<<
+                     " channel(s) starting from "<<startChan<<" using "<<nThreads<<" thread(s)");
+}
+
+/// @brief matrices for the given beam
+/// @param[in] beam beam index
+/// @return const reference to the matrices
+const JonesMatrixCache::BeamJones& JonesMatrixCache::beamJones(casacore::uInt beam) const
+{
+  ASKAPCHECK(beam < itsBeams.size(), "Beam "<<beam<<" is not cached, the cache has "<<itsBeams.size()<<
+             " beam(s)");
+  return itsBeams[beam];
+}
+
+/// @brief matrices for the given antenna and beam
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @return pointer to 4*nChan elements with matrices for all cached channels
+const casacore::Complex* JonesMatrixCache::matrices(casacore::uInt ant, casacore::uInt beam) const
+{
+  ASKAPCHECK(ant < itsNAnt, "Antenna "<<ant<<" is not cached, the cache has "<<itsNAnt<<" antenna(s)");
+  const BeamJones &bj = beamJones(beam);
+  ASKAPDEBUGASSERT(bj.itsMatrices.size() == 4 * size_t(itsNAnt) * itsNChan);
+  return bj.itsMatrices.empty() ? 0 : &bj.itsMatrices[4 * size_t(ant) * itsNChan];
+}
+
+/// @brief validity flags for the given antenna and beam
+/// @param[in] ant antenna index
+/// @param[in] beam beam index
+/// @return pointer to nChan flags for all cached channels
+const casacore::uChar* JonesMatrixCache::validity(casacore::uInt ant, casacore::uInt beam) const
+{
+  ASKAPCHECK(ant < itsNAnt, "Antenna "<<ant<<" is not cached, the cache has "<<itsNAnt<<" antenna(s)");
+  const BeamJones &bj = beamJones(beam);
+  ASKAPDEBUGASSERT(bj.itsValid.size() == size_t(itsNAnt) * itsNChan);
+  return bj.itsValid.empty() ? 0 : &bj.itsValid[size_t(ant) * itsNChan];
+}
+
+/// @return memory used by the matrices (in bytes)
+size_t JonesMatrixCache::memoryUsed() const
+{
+  size_t result = 0;
+  for (std::vector<BeamJones>::const_iterator ci = itsBeams.begin(); ci != itsBeams.end(); ++ci) {
+       result += ci->itsMatrices.size() * sizeof(casacore::Complex) + ci->itsValid.size() * sizeof(casacore::uChar);
+  }
+  return result;
+}
+
+/// @brief compose the Jones matrices for one beam
+/// @details This method reads the terms from the solution and calls composeBeamJones.
+/// @param[in] calSolution calibration solution
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas
+/// @param[in] startChan first channel of the solution
+/// @param[in] nChan number of channels
+/// @param[in] correct if true, the matrices are inverted
+/// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid
+/// @param[out] result buffer to fill
+void JonesMatrixCache::fillBeamJones(const ICalSolutionConstAccessor &calSolution, casacore::uInt beam,
+                            casacore::uInt nAnt, casacore::uInt startChan, casacore::uInt nChan,
+                            bool correct, bool requireAllValid, BeamJones &result)
+{
+  BeamTerms terms;
+  readBeamTerms(calSolution, beam, nAnt, startChan, nChan, terms);
+  composeBeamJones(terms, nAnt, nChan, correct, requireAllValid, result);
+}
+
+/// @brief read the terms for one beam
+/// @param[in] calSolution calibration solution
+/// @param[in] beam beam index
+/// @param[in] nAnt number of antennas
+/// @param[in] startChan first channel of the solution
+/// @param[in] nChan number of channels
+/// @param[out] terms buffer to fill
+void JonesMatrixCache::readBeamTerms(const ICalSolutionConstAccessor &calSolution, casacore::uInt beam,
+                            casacore::uInt nAnt, casacore::uInt startChan, casacore::uInt nChan,
+                            BeamTerms &terms)
+{
+  calSolution.gainsForBeam(beam, nAnt, terms.itsGains, terms.itsGainsValid);
+  calSolution.leakagesForBeam(beam, nAnt, terms.itsLeakages, terms.itsLeakagesValid);
+  calSolution.bandpassForBeam(beam, nAnt, startChan, nChan, terms.itsBandpasses, terms.itsBandpassesValid);
+  calSolution.bpleakageForBeam(beam, nAnt, startChan, nChan, terms.itsBPLeakages, terms.itsBPLeakagesValid);
+}
+
+/// @brief compose the Jones matrices from the terms of one beam
+/// @details Invalid gains and bandpasses are replaced by 1, invalid leakages by 0 and the
+/// frequency-independent leakage takes precedence over the bandpass leakage (see
+/// ICalSolutionConstAccessor::jonesAndValidity). For correction, the matrices are inverted.
+/// @param[in] terms terms of the beam
+/// @param[in] nAnt number of antennas
+/// @param[in] nChan number of channels
+/// @param[in] correct if true, the matrices are inverted
+/// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid
+/// @param[out] result buffer to fill
+void JonesMatrixCache::composeBeamJones(const BeamTerms &terms, casacore::uInt nAnt, casacore::uInt nChan,
+                               bool correct, bool requireAllValid, BeamJones &result)
+{
+  const casacore::Matrix<casacore::Complex> &gains = terms.itsGains;
+  const casacore::Matrix<casacore::Complex> &leakages = terms.itsLeakages;
+  const casacore::Matrix<casacore::Complex> &bandpasses = terms.itsBandpasses;
+  const casacore::Matrix<casacore::Complex> &bpleakages = terms.itsBPLeakages;
+  const casacore::Matrix<casacore::Bool> &gValid = terms.itsGainsValid;
+  const casacore::Matrix<casacore::Bool> &dValid = terms.itsLeakagesValid;
+  const casacore::Matrix<casacore::Bool> &bpValid = terms.itsBandpassesValid;
+  const casacore::Matrix<casacore::Bool> &bpdValid = terms.itsBPLeakagesValid;
+
+  result.itsMatrices.assign(4 * size_t(nAnt) * nChan, casacore::Complex(0.,0.));
+  result.itsValid.assign(size_t(nAnt) * nChan, 0);
+  const casacore::Complex one(1.,0.);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const bool g1Valid = gValid(0, ant);
+       const bool g2Valid = gValid(1, ant);
+       const casacore::Complex g1 = g1Valid ? gains(0, ant) : one;
+       const casacore::Complex g2 = g2Valid ? gains(1, ant) : one;
+       const bool leakageValid = dValid(0, ant) && dValid(1, ant);
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            const size_t pos = size_t(ant) * nChan + chan;
+            const bool bp1Valid = bpValid(2 * chan, ant);
+            const bool bp2Valid = bpValid(2 * chan + 1, ant);
+            const bool bpleakageValid = bpdValid(2 * chan, ant) && bpdValid(2 * chan + 1, ant);
+            bool valid = requireAllValid ? g1Valid && g2Valid && bp1Valid && bp2Valid &&
+                         leakageValid && bpleakageValid :
+                         (g1Valid && g2Valid) || leakageValid || bpleakageValid || (bp1Valid && bp2Valid);
+            if (!valid) {
+                continue;
+            }
+            const casacore::Complex b1 = bp1Valid ? bandpasses(2 * chan, ant) : one;
+            const casacore::Complex b2 = bp2Valid ? bandpasses(2 * chan + 1, ant) : one;
+            casacore::Complex d12(0.,0.), d21(0.,0.);
+            if (leakageValid) {
+                d12 = leakages(0, ant);
+                d21 = leakages(1, ant);
+            } else if (bpleakageValid) {
+                d12 = bpleakages(2 * chan, ant);
+                d21 = bpleakages(2 * chan + 1, ant);
+            }
+            casacore::Complex *jones = &result.itsMatrices[4 * pos];
+            jones[0] = g1 * b1;
+            jones[1] = d12 * g1 * b2;
+            jones[2] = -d21 * g2 * b1;
+            jones[3] = g2 * b2;
+            if (correct) {
+                const casacore::Complex det = jones[0] * jones[3] - jones[1] * jones[2];
+                if (norm(det) == 0.) {
+                    jones[0] = jones[1] = jones[2] = jones[3] = casacore::Complex(0.,0.);
+                    continue;
+                }
+                const casacore::Complex invDet = one / det;
+                const casacore::Complex j00 = jones[0];
+                jones[0] = jones[3] * invDet;
+                jones[1] = -jones[1] * invDet;
+                jones[2] = -jones[2] * invDet;
+                jones[3] = j00 * invDet;
+            }
+            result.itsValid[pos] = 1;
+       }
+  }
+}
@@ -0,0 +1,212 @@
+/// @file
+///
+/// @brief Precomputed Jones matrices for all beams, antennas and channels
+/// @details CalibrationAccessorAdapter composes (and, for correction, inverts) the Jones
+/// matrices for every accessor it wraps. For a solution which doesn't change between
+/// accessors this work is repeated for every integration. This class does it once per
+/// solution and can be shared by any number of adapters.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_JONES_MATRIX_CACHE_H
+#define ASKAP_ACCESSORS_JONES_MATRIX_CACHE_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionConstAccessor.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Precomputed Jones matrices for all beams, antennas and channels
+/// @details The matrices are composed the same way as ICalSolutionConstAccessor::jones does
+/// and inverted if the cache is set up for correction (singular matrices are replaced by
+/// zeros and marked invalid). The content is computed in the constructor and never changes
+/// afterwards, so the object can be shared between threads without locking. To follow
+/// the new solutions use JonesMatrixCacheMonitor which replaces the whole object.
+///
+/// The terms are read from the solution accessor sequentially because accessors are not
+/// thread-safe, the composition and inversion are then done in parallel over beams.
+/// @ingroup calibaccess
+class JonesMatrixCache : public boost::noncopyable {
+public:
+  /// @brief Jones matrices for all antennas and channels of one beam
+  struct BeamJones {
+     /// @brief 4 elements per antenna and channel in the row-major order (channel index
+     /// runs fastest), zeros for invalid matrices
+     std::vector<casacore::Complex> itsMatrices;
+     /// @brief validity flag per antenna and channel
+     std::vector<casacore::uChar> itsValid;
+  };
+
+  /// @brief shared pointer definition
+  typedef boost::shared_ptr<JonesMatrixCache const> ShPtr;
+
+  /// @brief compute the matrices
+  /// @param[in] calSolution calibration solution
+  /// @param[in] nAnt number of antennas
+  /// @param[in] nBeam number of beams
+  /// @param[in] startChan first channel of the solution to cache
+  /// @param[in] nChan number of channels to cache
+  /// @param[in] correct if true, the matrices are inverted
+  /// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid,
+  ///            otherwise the validity rule of jonesValid is used
+  /// @param[in] nThreads number of threads to use, zero means to decide based on the
+  ///            number of beams and cores
+  /// @param[in] solutionID ID of the solution (for information only), negative if unknown
+  JonesMatrixCache(const ICalSolutionConstAccessor::ShPtr &calSolution, casacore::uInt nAnt,
+                   casacore::uInt nBeam, casacore::uInt startChan, casacore::uInt nChan,
+                   bool correct = true, bool requireAllValid = true, size_t nThreads = 0,
+                   long solutionID = -1);
+
+  /// @brief matrices for the given beam
+  /// @param[in] beam beam index
+  /// @return const reference to the matrices
+  const BeamJones& beamJones(casacore::uInt beam) const;
+
+  /// @brief matrices for the given antenna and beam
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @return pointer to 4*nChan elements with matrices for all cached channels
+  const casacore::Complex* matrices(casacore::uInt ant, casacore::uInt beam) const;
+
+  /// @brief validity flags for the given antenna and beam
+  /// @param[in] ant antenna index
+  /// @param[in] beam beam index
+  /// @return pointer to nChan flags for all cached channels
+  const casacore::uChar* validity(casacore::uInt ant, casacore::uInt beam) const;
+
+  /// @return number of antennas
+  inline casacore::uInt nAnt() const { return itsNAnt; }
+
+  /// @return number of beams
+  inline casacore::uInt nBeam() const { return casacore::uInt(itsBeams.size()); }
+
+  /// @return first cached channel of the solution
+  inline casacore::uInt startChan() const { return itsStartChan; }
+
+  /// @return number of cached channels
+  inline casacore::uInt nChan() const { return itsNChan; }
+
+  /// @return true, if the matrices are inverted
+  inline bool correcting() const { return itsCorrect; }
+
+  /// @return true, if all constituents of the Jones matrix are required to be valid
+  inline bool requireAllValid() const { return itsRequireAllValid; }
+
+  /// @return ID of the cached solution, negative if unknown
+  inline long solutionID() const { return itsSolutionID; }
+
+  /// @return memory used by the matrices (in bytes)
+  size_t memoryUsed() const;
+
+  /// @brief compose the Jones matrices for one beam
+  /// @details This method reads the terms from the solution and calls composeBeamJones.
+  /// @param[in] calSolution calibration solution
+  /// @param[in] beam beam index
+  /// @param[in] nAnt number of antennas
+  /// @param[in] startChan first channel of the solution
+  /// @param[in] nChan number of channels
+  /// @param[in] correct if true, the matrices are inverted
+  /// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid
+  /// @param[out] result buffer to fill
+  static void fillBeamJones(const ICalSolutionConstAccessor &calSolution, casacore::uInt beam,
+                            casacore::uInt nAnt, casacore::uInt startChan, casacore::uInt nChan,
+                            bool correct, bool requireAllValid, BeamJones &result);
+
+private:
+  /// @brief gains, leakages, bandpasses and bandpass leakages of one beam
+  /// @details Layout follows ICalSolutionConstAccessor::gainsForBeam and friends
+  struct BeamTerms {
+     casacore::Matrix<casacore::Complex> itsGains, itsLeakages, itsBandpasses, itsBPLeakages;
+     casacore::Matrix<casacore::Bool> itsGainsValid, itsLeakagesValid, itsBandpassesValid, itsBPLeakagesValid;
+  };
+
+  /// @brief functor composing matrices for a subset of beams in a separate thread
+  struct Composer;
+
+  /// @brief read the terms for one beam
+  /// @param[in] calSolution calibration solution
+  /// @param[in] beam beam index
+  /// @param[in] nAnt number of antennas
+  /// @param[in] startChan first channel of the solution
+  /// @param[in] nChan number of channels
+  /// @param[out] terms buffer to fill
+  static void readBeamTerms(const ICalSolutionConstAccessor &calSolution, casacore::uInt beam,
+                            casacore::uInt nAnt, casacore::uInt startChan, casacore::uInt nChan,
+                            BeamTerms &terms);
+
+  /// @brief compose the Jones matrices from the terms of one beam
+  /// @details Invalid gains and bandpasses are replaced by 1, invalid leakages by 0 and the
+  /// frequency-independent leakage takes precedence over the bandpass leakage (see
+  /// ICalSolutionConstAccessor::jonesAndValidity). For correction, the matrices are inverted.
+  /// @param[in] terms terms of the beam
+  /// @param[in] nAnt number of antennas
+  /// @param[in] nChan number of channels
+  /// @param[in] correct if true, the matrices are inverted
+  /// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid
+  /// @param[out] result buffer to fill
+  static void composeBeamJones(const BeamTerms &terms, casacore::uInt nAnt, casacore::uInt nChan,
+                               bool correct, bool requireAllValid, BeamJones &result);
+
+  /// @brief number of antennas
+  casacore::uInt itsNAnt;
+
+  /// @brief first cached channel
+  casacore::uInt itsStartChan;
+
+  /// @brief number of cached channels
+  casacore::uInt itsNChan;
+
+  /// @brief true, if the matrices are inverted
+  bool itsCorrect;
+
+  /// @brief true, if all constituents of the Jones matrix are required to be valid
+  bool itsRequireAllValid;
+
+  /// @brief ID of the cached solution
+  long itsSolutionID;
+
+  /// @brief matrices for every beam
+  std::vector<BeamJones> itsBeams;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_JONES_MATRIX_CACHE_H
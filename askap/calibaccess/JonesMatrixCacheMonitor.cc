@@ -0,0 +1,138 @@
+/// @file
+///
+/// @brief Keeps JonesMatrixCache in sync with the most recent solution
+/// @details Real-time consumers apply the most recent calibration solution. This class
+/// rebuilds the cached Jones matrices only when a new solution is announced by the
+/// solution source, so the matrices are not recomputed for every integration.
+///
+/// @copyright (c) 2026 CSIRO
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/JonesMatrixCacheMonitor.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the monitor
+/// @details The cache is built at the first call to cache(), update() or waitForUpdate().
+/// @param[in] src solution source
+/// @param[in] nAnt number of antennas
+/// @param[in] nBeam number of beams
+/// @param[in] startChan first channel of the solution to cache
+/// @param[in] nChan number of channels to cache
+/// @param[in] correct if true, the matrices are inverted
+/// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid
+/// @param[in] nThreads number of threads used to build the cache, zero means to decide
+///            based on the number of beams and cores
+JonesMatrixCacheMonitor::JonesMatrixCacheMonitor(const ICalSolutionConstSource::ShPtr &src, casacore::uInt nAnt,
+                          casacore::uInt nBeam, casacore::uInt startChan, casacore::uInt nChan,
+                          bool correct, bool requireAllValid, size_t nThreads) :
+      itsSource(src), itsNAnt(nAnt), itsNBeam(nBeam), itsStartChan(startChan), itsNChan(nChan),
+      itsCorrect(correct), itsRequireAllValid(requireAllValid), itsNThreads(nThreads), itsRebuilds(0)
+{
+  ASKAPCHECK(itsSource, "An attempt to initialise JonesMatrixCacheMonitor with empty solution source");
+}
+
+/// @brief obtain the current cache
+/// @details The source is not checked for new solutions if the cache already exists.
+/// @return shared pointer to the cache
+JonesMatrixCache::ShPtr JonesMatrixCacheMonitor::cache()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    if (itsCache) {
+        return itsCache;
+    }
+  }
+  update();
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  ASKAPDEBUGASSERT(itsCache);
+  return itsCache;
+}
+
+/// @brief check for a new solution
+/// @return true, if the cache has been rebuilt
+bool JonesMatrixCacheMonitor::update()
+{
+  return rebuild(itsSource->mostRecentSolution());
+}
+
+/// @brief wait for a new solution
+/// @param[in] timeout maximum time to wait (in seconds)
+/// @return true, if the cache has been rebuilt, false if the timeout has expired
+bool JonesMatrixCacheMonitor::waitForUpdate(double timeout)
+{
+  const long lastID = solutionID();
+  if (lastID < 0) {
+      return update();
+  }
+  const long id = itsSource->waitForNewSolution(lastID, timeout);
+  return id > lastID ? rebuild(id) : false;
+}
+
+/// @return ID of the cached solution, negative if the cache hasn't been built yet
+long JonesMatrixCacheMonitor::solutionID() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsCache ? itsCache->solutionID() : -1;
+}
+
+/// @return number of times the cache has been built
+size_t JonesMatrixCacheMonitor::rebuilds() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsRebuilds;
+}
+
+/// @brief build the cache for the given solution, if it is not cached already
+/// @details The cache is built without holding the lock, so consumers are not blocked
+/// while the matrices are computed. If two threads build the cache for the same solution
+/// at the same time, the result of the first one is kept.
+/// @param[in] id solution ID
+/// @return true, if the cache has been rebuilt
+bool JonesMatrixCacheMonitor::rebuild(long id)
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    if (itsCache && itsCache->solutionID() >= id) {
+        return false;
+    }
+  }
+  const JonesMatrixCache::ShPtr cache(new JonesMatrixCache(itsSource->roSolution(id), itsNAnt, itsNBeam,
+                                      itsStartChan, itsNChan, itsCorrect, itsRequireAllValid, itsNThreads, id));
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (itsCache && itsCache->solutionID() >= id) {
+      return false;
+  }
+  itsCache = cache;
+  ++itsRebuilds;
+  return true;
+}
@@ -0,0 +1,137 @@
+/// @file
+///
+/// @brief Keeps JonesMatrixCache in sync with the most recent solution
+/// @details Real-time consumers apply the most recent calibration solution. This class
+/// rebuilds the cached Jones matrices only when a new solution is announced by the
+/// solution source, so the matrices are not recomputed for every integration.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_JONES_MATRIX_CACHE_MONITOR_H
+#define ASKAP_ACCESSORS_JONES_MATRIX_CACHE_MONITOR_H
+
+// own includes
+#include <askap/calibaccess/JonesMatrixCache.h>
+#include <askap/calibaccess/ICalSolutionConstSource.h>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Keeps JonesMatrixCache in sync with the most recent solution
+/// @details The monitor holds the cache for the most recent solution known to it.
+/// update() checks the source and rebuilds the cache if the solution ID has changed,
+/// waitForUpdate() blocks in ICalSolutionConstSource::waitForNewSolution, so the cheap
+/// change detection of the source (e.g. the sequence file of the table-based source) is
+/// used. The cache is replaced as a whole, consumers holding a shared pointer to the old
+/// cache can finish their work with it. The methods can be called from different threads.
+/// @ingroup calibaccess
+class JonesMatrixCacheMonitor : public boost::noncopyable {
+public:
+  /// @brief set up the monitor
+  /// @details The cache is built at the first call to cache(), update() or waitForUpdate().
+  /// @param[in] src solution source
+  /// @param[in] nAnt number of antennas
+  /// @param[in] nBeam number of beams
+  /// @param[in] startChan first channel of the solution to cache
+  /// @param[in] nChan number of channels to cache
+  /// @param[in] correct if true, the matrices are inverted
+  /// @param[in] requireAllValid if true, all terms of the Jones matrix are required to be valid
+  /// @param[in] nThreads number of threads used to build the cache, zero means to decide
+  ///            based on the number of beams and cores
+  JonesMatrixCacheMonitor(const ICalSolutionConstSource::ShPtr &src, casacore::uInt nAnt,
+                          casacore::uInt nBeam, casacore::uInt startChan, casacore::uInt nChan,
+                          bool correct = true, bool requireAllValid = true, size_t nThreads = 0);
+
+  /// @brief obtain the current cache
+  /// @details The source is not checked for new solutions if the cache already exists.
+  /// @return shared pointer to the cache
+  JonesMatrixCache::ShPtr cache();
+
+  /// @brief check for a new solution
+  /// @return true, if the cache has been rebuilt
+  bool update();
+
+  /// @brief wait for a new solution
+  /// @param[in] timeout maximum time to wait (in seconds)
+  /// @return true, if the cache has been rebuilt, false if the timeout has expired
+  bool waitForUpdate(double timeout);
+
+  /// @return ID of the cached solution, negative if the cache hasn't been built yet
+  long solutionID() const;
+
+  /// @return number of times the cache has been built
+  size_t rebuilds() const;
+
+private:
+  /// @brief build the cache for the given solution, if it is not cached already
+  /// @param[in] id solution ID
+  /// @return true, if the cache has been rebuilt
+  bool rebuild(long id);
+
+  /// @brief solution source
+  ICalSolutionConstSource::ShPtr itsSource;
+
+  /// @brief number of antennas
+  casacore::uInt itsNAnt;
+
+  /// @brief number of beams
+  casacore::uInt itsNBeam;
+
+  /// @brief first cached channel
+  casacore::uInt itsStartChan;
+
+  /// @brief number of cached channels
+  casacore::uInt itsNChan;
+
+  /// @brief true, if the matrices are inverted
+  bool itsCorrect;
+
+  /// @brief true, if all constituents of the Jones matrix are required to be valid
+  bool itsRequireAllValid;
+
+  /// @brief number of threads used to build the cache
+  size_t itsNThreads;
+
+  /// @brief current cache
+  JonesMatrixCache::ShPtr itsCache;
+
+  /// @brief number of times the cache has been built
+  size_t itsRebuilds;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_JONES_MATRIX_CACHE_MONITOR_H
@@ -38,6 +38,8 @@
 #include <askap/calibaccess/JonesDTerm.h>
 #include <askap/askap/AskapError.h>
 
+#include <algorithm>
+
 namespace askap {
 
 namespace accessors {
@@ -52,7 +54,10 @@ namespace accessors {
 /// to generate the exception closer to the point where misuse occurs (hopefully aiding the
 /// debugging)
 MemCalSolutionAccessor::MemCalSolutionAccessor(const boost::shared_ptr<ICalSolutionFiller> &filler, bool roCheck) :
-   itsSolutionFiller(filler), itsSettersAllowed(!roCheck)
+   itsSolutionFiller(filler), itsSettersAllowed(!roCheck), itsBandpassesStartChan(0), itsBandpassesEndChan(0),
+   itsBPLeakagesStartChan(0), itsBPLeakagesEndChan(0), itsFlushPending(false),
+   itsValidityBuilt(false), itsValidityUsable(false), itsValidityTerms(0), itsValidityNAnt(0),
+   itsValidityNBeam(0), itsValidityNChan(0), itsIonoLayoutBuilt(false)
 {
   ASKAPCHECK(itsSolutionFiller, "Uninitialised solution filler has been passes to MemCalSolutionAccessor");
 }
@@ -169,11 +174,180 @@ IonoTerm MemCalSolutionAccessor::ionoparam(const JonesIndex &index) const
   return IonoTerm(param.first, param.second);
 }
 
+/// @brief obtain validity of the constituents of the Jones matrix
+/// @details The validity flags of all cached terms are combined into a bitmap per antenna,
+/// beam and channel on the first call (or by prefetch), so jonesValid and jonesAllValid
+/// become a simple lookup. The bitmap is updated by the setters.
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel of interest
+/// @return bitwise combination of ValidityFlags for the terms which are valid
+casacore::uInt MemCalSolutionAccessor::validity(const JonesIndex &index, const casacore::uInt chan) const
+{
+  if (!itsValidityBuilt) {
+      buildValidity();
+  }
+  if (!itsValidityUsable) {
+      return ICalSolutionConstAccessor::validity(index, chan);
+  }
+  if (itsValidityTerms == 0) {
+      // no terms defined, all defaults are invalid
+      return 0;
+  }
+  const casacore::Short ant = index.antenna();
+  const casacore::Short beam = index.beam();
+  ASKAPCHECK((ant >= 0) && (casacore::uInt(ant) < itsValidityNAnt), "Requested antenna index "<<ant<<
+             " is outside the shape of the cache, nAnt="<<itsValidityNAnt);
+  ASKAPCHECK((beam >= 0) && (casacore::uInt(beam) < itsValidityNBeam), "Requested beam index "<<beam<<
+             " is outside the shape of the cache, nBeam="<<itsValidityNBeam);
+  const size_t cell = size_t(beam) * itsValidityNAnt + casacore::uInt(ant);
+  casacore::uInt result = itsJonesValidity[cell];
+  if (itsValidityNChan > 0) {
+      ASKAPCHECK(chan < itsValidityNChan, "Requested channel "<<chan<<" is outside the shape of the cache, nChan="<<
+                 itsValidityNChan);
+      result |= itsChanValidity[size_t(chan) * itsValidityNBeam * itsValidityNAnt + cell];
+  }
+  return result;
+}
+
 /// @brief set gains (J-Jones)
 /// @details This method writes parallel-hand gains for both
 /// polarisations (corresponding to XX and YY)
 /// @param[in] index ant/beam index
 /// @param[in] gains JonesJTerm object with gains and validity flags
+void MemCalSolutionAccessor::gainsForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                             casacore::Matrix<casacore::Complex> &gains,
+                             casacore::Matrix<casacore::Bool> &valid) const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noGain() && !itsGains.flushNeeded()) {
+      // default gains
+      gains.resize(2, nAnt);
+      gains.set(1.);
+      valid.resize(2, nAnt);
+      valid.set(false);
+      return;
+  }
+  extractBeam(itsGains.value(*itsSolutionFiller, &ICalSolutionFiller::fillGains), 0, 2, beam, nAnt, gains, valid);
+}
+
+void MemCalSolutionAccessor::leakagesForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noLeakage() && !itsLeakages.flushNeeded()) {
+      // default leakages
+      leakages.resize(2, nAnt);
+      leakages.set(0.);
+      valid.resize(2, nAnt);
+      valid.set(false);
+      return;
+  }
+  extractBeam(itsLeakages.value(*itsSolutionFiller, &ICalSolutionFiller::fillLeakages), 0, 2, beam, nAnt,
+              leakages, valid);
+}
+
+void MemCalSolutionAccessor::bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &gains,
+                                casacore::Matrix<casacore::Bool> &valid) const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noBandpass() && !itsBandpasses.flushNeeded()) {
+      // default bandpasses
+      gains.resize(2 * nChan, nAnt);
+      gains.set(1.);
+      valid.resize(2 * nChan, nAnt);
+      valid.set(false);
+      return;
+  }
+  extractBeam(itsBandpasses.value(*itsSolutionFiller, &ICalSolutionFiller::fillBandpasses), 2 * startChan,
+              2 * nChan, beam, nAnt, gains, valid);
+}
+
+void MemCalSolutionAccessor::bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                 const casacore::uInt startChan, const casacore::uInt nChan,
+                                 casacore::Matrix<casacore::Complex> &leakages,
+                                 casacore::Matrix<casacore::Bool> &valid) const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noBPLeakage() && !itsBPLeakages.flushNeeded()) {
+      // default leakages
+      leakages.resize(2 * nChan, nAnt);
+      leakages.set(0.);
+      valid.resize(2 * nChan, nAnt);
+      valid.set(false);
+      return;
+  }
+  extractBeam(itsBPLeakages.value(*itsSolutionFiller, &ICalSolutionFiller::fillBPLeakages), 2 * startChan,
+              2 * nChan, beam, nAnt, leakages, valid);
+}
+
+/// @brief obtain ionospheric parameters for one direction
+/// @details The parameters are copied from a real-valued nParams x nDir layout kept apart
+/// from the complex cube (built on first use), so the values for one direction are contiguous.
+/// @param[in] beam direction (beam) index
+/// @param[in] nParams number of parameters
+/// @param[out] params vector with nParams values (resized as necessary)
+/// @param[out] valid vector with nParams validity flags (resized as necessary)
+void MemCalSolutionAccessor::ionoparamsForBeam(const casacore::uInt beam, const casacore::uInt nParams,
+                                  casacore::Vector<casacore::Float> &params,
+                                  casacore::Vector<casacore::Bool> &valid) const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noIonosphere() && !itsIonoParams.flushNeeded()) {
+      params.resize(nParams);
+      params.set(0.);
+      valid.resize(nParams);
+      valid.set(false);
+      return;
+  }
+  buildIonoLayout();
+  ASKAPCHECK(nParams <= itsIonoValues.nrow(), "Requested number of ionospheric parameters "<<nParams<<
+             " is outside the shape of the cache: "<<itsIonoValues.shape());
+  ASKAPCHECK(beam < itsIonoValues.ncolumn(), "Requested direction index "<<beam<<
+             " is outside the shape of the cache: "<<itsIonoValues.shape());
+  params.resize(nParams);
+  valid.resize(nParams);
+  if (nParams == 0) {
+      return;
+  }
+  const casacore::Slice rows(0, nParams);
+  params = itsIonoValues.column(beam)(rows);
+  valid = itsIonoValid.column(beam)(rows);
+}
+
+/// @brief obtain all ionospheric parameters of the solution
+/// @param[in] nParams number of parameters per direction
+/// @param[in] nBeam number of directions (beams)
+/// @param[out] params nParams x nBeam matrix with values, parameters of one direction are
+///             contiguous (resized as necessary)
+/// @param[out] valid nParams x nBeam matrix with validity flags (resized as necessary)
+void MemCalSolutionAccessor::ionoparams(const casacore::uInt nParams, const casacore::uInt nBeam,
+                           casacore::Matrix<casacore::Float> &params,
+                           casacore::Matrix<casacore::Bool> &valid) const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  params.resize(nParams, nBeam);
+  valid.resize(nParams, nBeam);
+  if (itsSolutionFiller->noIonosphere() && !itsIonoParams.flushNeeded()) {
+      params.set(0.);
+      valid.set(false);
+      return;
+  }
+  buildIonoLayout();
+  ASKAPCHECK((nParams <= itsIonoValues.nrow()) && (nBeam <= itsIonoValues.ncolumn()), "Requested "<<nParams<<
+             " ionospheric parameter(s) for "<<nBeam<<" direction(s), which is outside the shape of the cache: "<<
+             itsIonoValues.shape());
+  if (nParams * nBeam == 0) {
+      return;
+  }
+  const casacore::Slice rows(0, nParams);
+  const casacore::Slice dirs(0, nBeam);
+  params = itsIonoValues(rows, dirs);
+  valid = itsIonoValid(rows, dirs);
+}
+
 void MemCalSolutionAccessor::setGain(const JonesIndex &index, const JonesJTerm &gains)
 {
   ASKAPCHECK(itsSettersAllowed, "Setters methods are now allowed - roCheck=true in the constructor");
@@ -182,6 +356,7 @@ void MemCalSolutionAccessor::setGain(const JonesIndex &index, const JonesJTerm &
        itsGains.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillGains);
   store(buf, gains.g1(),gains.g1IsValid(), 0, index);
   store(buf, gains.g2(),gains.g2IsValid(), 1, index);
+  updateValidity(GAIN_VALID, index, 0, gains.g1IsValid() && gains.g2IsValid());
 }
 
 /// @brief set leakages (D-Jones)
@@ -197,6 +372,7 @@ void MemCalSolutionAccessor::setLeakage(const JonesIndex &index, const JonesDTer
        itsLeakages.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillLeakages);
   store(buf, leakages.d12(),leakages.d12IsValid(), 0, index);
   store(buf, leakages.d21(),leakages.d21IsValid(), 1, index);
+  updateValidity(LEAKAGE_VALID, index, 0, leakages.d12IsValid() && leakages.d21IsValid());
 }
 
 /// @brief set gains for a single bandpass channel
@@ -216,6 +392,8 @@ void MemCalSolutionAccessor::setBandpass(const JonesIndex &index, const JonesJTe
        itsBandpasses.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillBandpasses);
   store(bandpasses, bp.g1(),bp.g1IsValid(), chan * 2, index);
   store(bandpasses, bp.g2(),bp.g2IsValid(), chan * 2 + 1, index);
+  extendRange(itsBandpassesStartChan, itsBandpassesEndChan, chan);
+  updateValidity(BANDPASS_VALID, index, chan, bp.g1IsValid() && bp.g2IsValid());
 }
 /// @brief set leakages for a single bandpass channel
 /// @details This method writes cross-pol leakages corresponding to a single
@@ -231,6 +409,8 @@ void MemCalSolutionAccessor::setBPLeakage(const JonesIndex &index, const JonesDT
        itsBPLeakages.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillBPLeakages);
   store(bplpair, bpleakages.d12(),bpleakages.d12IsValid(), chan * 2, index);
   store(bplpair, bpleakages.d21(),bpleakages.d21IsValid(), chan * 2 + 1, index);
+  extendRange(itsBPLeakagesStartChan, itsBPLeakagesEndChan, chan);
+  updateValidity(BPLEAKAGE_VALID, index, chan, bpleakages.d12IsValid() && bpleakages.d21IsValid());
 }
 
 /// @brief set ionospheric parameters
@@ -244,6 +424,15 @@ void MemCalSolutionAccessor::setIonosphere(const JonesIndex &index, const IonoTe
   std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& buf =
        itsIonoParams.rwValue(*itsSolutionFiller, &ICalSolutionFiller::fillIonoParams);
   store(buf, param.param(),param.paramIsValid(), 0, index);
+  if (itsIonoLayoutBuilt) {
+      // the index has already been checked by store
+      if ((itsIonoValues.nrow() == buf.first.ncolumn()) && (itsIonoValues.ncolumn() == buf.first.nplane())) {
+          itsIonoValues(casacore::uInt(index.antenna()), casacore::uInt(index.beam())) = casacore::real(param.param());
+          itsIonoValid(casacore::uInt(index.antenna()), casacore::uInt(index.beam())) = param.paramIsValid();
+      } else {
+          itsIonoLayoutBuilt = false;
+      }
+  }
 }
 
 /// @details helper method to extract value and validity flag for a given ant/beam pair
@@ -271,6 +460,27 @@ std::pair<casacore::Complex, casacore::Bool> MemCalSolutionAccessor::extract(con
 /// @param[in] isValid validity flag
 /// @param[in] row polarisation/channel index (row of the cube)
 /// @param[in] index ant/beam index
+void MemCalSolutionAccessor::extractBeam(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >  &cubes,
+                   const casacore::uInt startRow, const casacore::uInt nRows, const casacore::uInt beam,
+                   const casacore::uInt nAnt, casacore::Matrix<casacore::Complex> &values,
+                   casacore::Matrix<casacore::Bool> &valid)
+{
+  ASKAPDEBUGASSERT(cubes.first.shape() == cubes.second.shape());
+  ASKAPCHECK(nAnt <= cubes.first.ncolumn(), "Requested number of antennas "<<nAnt<<" is outside the shape of the cache: "<<cubes.first.shape());
+  ASKAPCHECK(beam < cubes.first.nplane(), "Requested beam index "<<beam<<" is outside the shape of the cache: "<<cubes.first.shape());
+  ASKAPCHECK(startRow + nRows <= cubes.first.nrow(), "Requested rows (=2*channel) "<<startRow<<" to "<<startRow + nRows<<
+             " are outside the shape of the cache: "<<cubes.first.shape());
+  values.resize(nRows, nAnt);
+  valid.resize(nRows, nAnt);
+  if (nRows * nAnt == 0) {
+      return;
+  }
+  const casacore::Slice rows(startRow, nRows);
+  const casacore::Slice ants(0, nAnt);
+  values = cubes.first.xyPlane(beam)(rows, ants);
+  valid = cubes.second.xyPlane(beam)(rows, ants);
+}
+
 void MemCalSolutionAccessor::store(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >  &cubes,
                    const casacore::Complex &val, const casacore::Bool isValid,
                    const casacore::uInt row, const JonesIndex &index)
@@ -286,6 +496,243 @@ void MemCalSolutionAccessor::store(std::pair<casacore::Cube<casacore::Complex>,
   cubes.second(row,casacore::uInt(ant),casacore::uInt(beam)) = isValid;
 }
 
+/// @brief helper method to add validity of one term to the bitmap
+/// @details A term is valid if both polarisation products are valid. Pairs of rows of the
+/// cube correspond to spectral channels (there is just one pair for gains and leakages).
+/// @param[in] cubes cube pair with values and validity flags
+/// @param[in] flag bit to set for valid terms
+/// @param[in] bitmap bitmap to update (nChan x nBeam x nAnt, antenna index varies fastest)
+static void addValidity(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                        const unsigned char flag, std::vector<unsigned char> &bitmap)
+{
+  const casacore::Cube<casacore::Bool> &valid = cubes.second;
+  ASKAPDEBUGASSERT(bitmap.size() == valid.nelements() / 2);
+  size_t cell = 0;
+  for (casacore::uInt row = 0; row + 1 < valid.nrow(); row += 2) {
+       for (casacore::uInt beam = 0; beam < valid.nplane(); ++beam) {
+            for (casacore::uInt ant = 0; ant < valid.ncolumn(); ++ant, ++cell) {
+                 if (valid(row, ant, beam) && valid(row + 1, ant, beam)) {
+                     bitmap[cell] |= flag;
+                 }
+            }
+       }
+  }
+}
+
+/// @brief build the validity bitmap from the cached cubes
+/// @details The cubes are filled if necessary, so an exception is thrown if the filler can't
+/// read them (in the same way as for the individual getters). If the cubes have inconsistent
+/// shapes, the bitmap is not used and validity is obtained via the getters.
+void MemCalSolutionAccessor::buildValidity() const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  const bool hasGains = !itsSolutionFiller->noGain() || itsGains.flushNeeded();
+  const bool hasLeakages = !itsSolutionFiller->noLeakage() || itsLeakages.flushNeeded();
+  const bool hasBandpasses = !itsSolutionFiller->noBandpass() || itsBandpasses.flushNeeded();
+  const bool hasBPLeakages = !itsSolutionFiller->noBPLeakage() || itsBPLeakages.flushNeeded();
+  // fill all cubes first, so that a failure leaves the bitmap unbuilt
+  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > *terms[4] = {
+        hasGains ? &itsGains.value(*itsSolutionFiller, &ICalSolutionFiller::fillGains) : 0,
+        hasLeakages ? &itsLeakages.value(*itsSolutionFiller, &ICalSolutionFiller::fillLeakages) : 0,
+        hasBandpasses ? &itsBandpasses.value(*itsSolutionFiller, &ICalSolutionFiller::fillBandpasses) : 0,
+        hasBPLeakages ? &itsBPLeakages.value(*itsSolutionFiller, &ICalSolutionFiller::fillBPLeakages) : 0};
+  const unsigned char flags[4] = {GAIN_VALID, LEAKAGE_VALID, BANDPASS_VALID, BPLEAKAGE_VALID};
+
+  itsValidityBuilt = true;
+  itsValidityUsable = true;
+  itsValidityTerms = 0;
+  itsValidityNAnt = 0;
+  itsValidityNBeam = 0;
+  itsValidityNChan = 0;
+  itsJonesValidity.clear();
+  itsChanValidity.clear();
+  for (int term = 0; term < 4; ++term) {
+       if (terms[term] == 0) {
+           continue;
+       }
+       const casacore::Cube<casacore::Bool> &valid = terms[term]->second;
+       const bool chanDependent = (flags[term] & (BANDPASS_VALID | BPLEAKAGE_VALID)) != 0;
+       const casacore::uInt nChan = valid.nrow() / 2;
+       if (itsValidityTerms == 0) {
+           itsValidityNAnt = valid.ncolumn();
+           itsValidityNBeam = valid.nplane();
+       }
+       if ((valid.ncolumn() != itsValidityNAnt) || (valid.nplane() != itsValidityNBeam) ||
+           (valid.nrow() % 2 != 0) || (!chanDependent && (nChan != 1)) ||
+           (chanDependent && ((nChan == 0) || ((itsValidityNChan > 0) && (nChan != itsValidityNChan))))) {
+           // inconsistent shapes, use the getters
+           itsValidityUsable = false;
+           return;
+       }
+       if (chanDependent) {
+           itsValidityNChan = nChan;
+       }
+       itsValidityTerms |= flags[term];
+  }
+  itsJonesValidity.resize(size_t(itsValidityNAnt) * itsValidityNBeam, 0);
+  itsChanValidity.resize(size_t(itsValidityNChan) * itsValidityNBeam * itsValidityNAnt, 0);
+  for (int term = 0; term < 4; ++term) {
+       if (terms[term] != 0) {
+           addValidity(*terms[term], flags[term], term < 2 ? itsJonesValidity : itsChanValidity);
+       }
+  }
+}
+
+/// @brief build the real-valued layout of ionospheric parameters
+/// @details The cube is filled if necessary. The layout is empty if there are no
+/// ionospheric parameters.
+void MemCalSolutionAccessor::buildIonoLayout() const
+{
+  if (itsIonoLayoutBuilt) {
+      return;
+  }
+  ASKAPASSERT(itsSolutionFiller);
+  const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >& params =
+        itsIonoParams.value(*itsSolutionFiller, &ICalSolutionFiller::fillIonoParams);
+  ASKAPDEBUGASSERT(params.first.shape() == params.second.shape());
+  ASKAPCHECK(params.first.nrow() == 1u, "Ionospheric parameters are expected to be stored in a cube with one row, "
+             "shape="<<params.first.shape());
+  itsIonoValues.resize(params.first.ncolumn(), params.first.nplane());
+  itsIonoValid.resize(params.first.ncolumn(), params.first.nplane());
+  for (casacore::uInt dir = 0; dir < params.first.nplane(); ++dir) {
+       for (casacore::uInt param = 0; param < params.first.ncolumn(); ++param) {
+            itsIonoValues(param, dir) = casacore::real(params.first(0, param, dir));
+            itsIonoValid(param, dir) = params.second(0, param, dir);
+       }
+  }
+  itsIonoLayoutBuilt = true;
+}
+
+/// @brief update the validity bitmap after a term has been set
+/// @details The bitmap is rebuilt on the next use if the term wasn't cached when it was built
+/// @param[in] flag term which has been set (one of ValidityFlags)
+/// @param[in] index ant/beam index
+/// @param[in] chan spectral channel (ignored for gains and leakages)
+/// @param[in] valid true, if both polarisation products of the term are valid
+void MemCalSolutionAccessor::updateValidity(const casacore::uInt flag, const JonesIndex &index,
+                                            const casacore::uInt chan, const bool valid)
+{
+  if (!itsValidityBuilt || !itsValidityUsable) {
+      return;
+  }
+  const bool chanDependent = (flag & (BANDPASS_VALID | BPLEAKAGE_VALID)) != 0;
+  if (!(itsValidityTerms & flag) || (chanDependent && (chan >= itsValidityNChan))) {
+      // the shape of the bitmap is no longer right
+      itsValidityBuilt = false;
+      return;
+  }
+  // the index has already been checked by store
+  const size_t cell = size_t(index.beam()) * itsValidityNAnt + casacore::uInt(index.antenna());
+  unsigned char &bits = chanDependent ? itsChanValidity[size_t(chan) * itsValidityNBeam * itsValidityNAnt + cell] :
+                        itsJonesValidity[cell];
+  if (valid) {
+      bits |= flag;
+  } else {
+      bits &= ~flag;
+  }
+}
+
+/// @brief helper method to fill one field on demand ignoring errors
+/// @details The field is left to be filled on demand if the filler can't read it
+/// @param[in] field field to fill
+/// @param[in] filler filler to use
+/// @param[in] func member function of the filler to call
+static void tryToFill(const CachedAccessorField<std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > > &field,
+                      const ICalSolutionFiller &filler,
+                      void (ICalSolutionFiller::*func)(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const)
+{
+  try {
+     field.value(filler, func);
+  }
+  catch (const AskapError &) {
+     // the error will be reported if this parameter is actually requested
+  }
+}
+
+/// @brief read all parameters available from the filler
+/// @details Normally the cubes are filled on demand. This method fills all of them
+/// at once, so no further calls to the filler are made by the accessor methods. Parameters
+/// which can't be read are left to be read on demand, so the error is only reported if such
+/// parameter is actually requested.
+void MemCalSolutionAccessor::prefetch() const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (!itsSolutionFiller->noGain()) {
+      tryToFill(itsGains, *itsSolutionFiller, &ICalSolutionFiller::fillGains);
+  }
+  if (!itsSolutionFiller->noLeakage()) {
+      tryToFill(itsLeakages, *itsSolutionFiller, &ICalSolutionFiller::fillLeakages);
+  }
+  if (!itsSolutionFiller->noBandpass()) {
+      tryToFill(itsBandpasses, *itsSolutionFiller, &ICalSolutionFiller::fillBandpasses);
+  }
+  if (!itsSolutionFiller->noBPLeakage()) {
+      tryToFill(itsBPLeakages, *itsSolutionFiller, &ICalSolutionFiller::fillBPLeakages);
+  }
+  if (!itsSolutionFiller->noIonosphere()) {
+      tryToFill(itsIonoParams, *itsSolutionFiller, &ICalSolutionFiller::fillIonoParams);
+  }
+  if (!itsValidityBuilt) {
+      try {
+         buildValidity();
+      }
+      catch (const AskapError &) {
+         // the bitmap will be built (and the error reported) on demand
+      }
+  }
+}
+
+/// @brief inlined access to gains
+/// @details The cache is filled if necessary. The view gives direct access to the cached
+/// cube without any index checks in the release build, so the indices should be checked
+/// against the dimensions of the view before the loop. It stays valid until the accessor
+/// is destroyed. An empty view is returned if no gains are defined.
+/// @return view of the gains
+MemCalSolutionAccessor::GainView MemCalSolutionAccessor::gainView() const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noGain() && !itsGains.flushNeeded()) {
+      return GainView();
+  }
+  return jonesCubeView<1>(itsGains.value(*itsSolutionFiller, &ICalSolutionFiller::fillGains));
+}
+
+/// @brief inlined access to leakages
+/// @details See gainView for details
+/// @return view of the leakages
+MemCalSolutionAccessor::GainView MemCalSolutionAccessor::leakageView() const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noLeakage() && !itsLeakages.flushNeeded()) {
+      return GainView();
+  }
+  return jonesCubeView<1>(itsLeakages.value(*itsSolutionFiller, &ICalSolutionFiller::fillLeakages));
+}
+
+/// @brief inlined access to bandpasses
+/// @details See gainView for details
+/// @return view of the bandpasses
+MemCalSolutionAccessor::BandpassView MemCalSolutionAccessor::bandpassView() const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noBandpass() && !itsBandpasses.flushNeeded()) {
+      return BandpassView();
+  }
+  return jonesCubeView<0>(itsBandpasses.value(*itsSolutionFiller, &ICalSolutionFiller::fillBandpasses));
+}
+
+/// @brief inlined access to bandpass leakages
+/// @details See gainView for details
+/// @return view of the bandpass leakages
+MemCalSolutionAccessor::BandpassView MemCalSolutionAccessor::bpleakageView() const
+{
+  ASKAPASSERT(itsSolutionFiller);
+  if (itsSolutionFiller->noBPLeakage() && !itsBPLeakages.flushNeeded()) {
+      return BandpassView();
+  }
+  return jonesCubeView<0>(itsBPLeakages.value(*itsSolutionFiller, &ICalSolutionFiller::fillBPLeakages));
+}
+
 /// @brief write back cache, if necessary
 /// @details This method checks whether caches need flush and calls appropriate methods of the filler
 void MemCalSolutionAccessor::syncCache() const
@@ -294,27 +741,70 @@ void MemCalSolutionAccessor::syncCache() const
       if (itsGains.flushNeeded()) {
           itsSolutionFiller->writeGains(itsGains.value());
           itsGains.flushed();
+          itsFlushPending = true;
       }
       if (itsLeakages.flushNeeded()) {
           itsSolutionFiller->writeLeakages(itsLeakages.value());
           itsLeakages.flushed();
+          itsFlushPending = true;
       }
       if (itsBandpasses.flushNeeded()) {
-          itsSolutionFiller->writeBandpasses(itsBandpasses.value());
+          const casacore::uInt nChan = itsBandpasses.value().first.nrow() / 2;
+          if ((itsBandpassesStartChan < itsBandpassesEndChan) &&
+              ((itsBandpassesStartChan > 0) || (itsBandpassesEndChan < nChan))) {
+              itsSolutionFiller->writeBandpassChannels(itsBandpasses.value(), itsBandpassesStartChan,
+                                 itsBandpassesEndChan - itsBandpassesStartChan);
+          } else {
+              itsSolutionFiller->writeBandpasses(itsBandpasses.value());
+          }
           itsBandpasses.flushed();
+          itsBandpassesStartChan = itsBandpassesEndChan = 0;
+          itsFlushPending = true;
       }
       if (itsBPLeakages.flushNeeded()) {
-          itsSolutionFiller->writeBPLeakages(itsBPLeakages.value());
+          const casacore::uInt nChan = itsBPLeakages.value().first.nrow() / 2;
+          if ((itsBPLeakagesStartChan < itsBPLeakagesEndChan) &&
+              ((itsBPLeakagesStartChan > 0) || (itsBPLeakagesEndChan < nChan))) {
+              itsSolutionFiller->writeBPLeakageChannels(itsBPLeakages.value(), itsBPLeakagesStartChan,
+                                 itsBPLeakagesEndChan - itsBPLeakagesStartChan);
+          } else {
+              itsSolutionFiller->writeBPLeakages(itsBPLeakages.value());
+          }
           itsBPLeakages.flushed();
+          itsBPLeakagesStartChan = itsBPLeakagesEndChan = 0;
+          itsFlushPending = true;
       }
       if (itsIonoParams.flushNeeded()) {
           itsSolutionFiller->writeIonoParams(itsIonoParams.value());
           itsIonoParams.flushed();
+          itsFlushPending = true;
       }
   }
 }
 
+/// @brief extend the range of changed channels
+/// @param[in] start first changed channel (updated)
+/// @param[in] end last changed channel + 1 (updated)
+/// @param[in] chan channel to add to the range
+void MemCalSolutionAccessor::extendRange(casacore::uInt &start, casacore::uInt &end, const casacore::uInt chan)
+{
+  if (start >= end) {
+      start = chan;
+      end = chan + 1;
+  } else {
+      start = std::min(start, chan);
+      end = std::max(end, chan + 1);
+  }
+}
+
+/// @brief flush the underlying Filler - if necessary
+/// @details Nothing is done if nothing has been written since the last flush
+/// @return true if the filler has been flushed
 bool MemCalSolutionAccessor::flushFiller() {
+    if (!itsFlushPending) {
+        return false;
+    }
+    itsFlushPending = false;
     return itsSolutionFiller->flush();
 }
 /// @brief destructor
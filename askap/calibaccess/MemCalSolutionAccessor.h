@@ -41,14 +41,20 @@
 #include <askap/calibaccess/ICalSolutionAccessor.h>
 #include <askap/dataaccess/CachedAccessorField.h>
 #include <askap/calibaccess/ICalSolutionFiller.h>
+#include <askap/calibaccess/JonesCubeView.h>
 
 // casa includes
 #include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/BasicSL/Complex.h>
 
 // boost includes
 #include <boost/shared_ptr.hpp>
 
+// std includes
+#include <vector>
+
 namespace askap {
 
 namespace accessors {
@@ -138,6 +144,86 @@ public:
    /// @return ionoparam object with a param and validity flag
    virtual IonoTerm ionoparam(const JonesIndex &index) const;
 
+   /// @brief obtain validity of the constituents of the Jones matrix
+   /// @details The validity flags of all cached terms are combined into a bitmap per antenna,
+   /// beam and channel on the first call (or by prefetch), so jonesValid and jonesAllValid
+   /// become a simple lookup. The bitmap is updated by the setters.
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel of interest
+   /// @return bitwise combination of ValidityFlags for the terms which are valid
+   virtual casacore::uInt validity(const JonesIndex &index, const casacore::uInt chan) const;
+
+   // bulk access to the cached cubes
+
+   /// @brief obtain gains for all antennas of one beam
+   /// @details The values are copied straight from the cache.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] gains 2 x nAnt matrix with gains, first row is XX, second is YY (resized as necessary)
+   /// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+   virtual void gainsForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                             casacore::Matrix<casacore::Complex> &gains,
+                             casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain leakages for all antennas of one beam
+   /// @details The values are copied straight from the cache.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] leakages 2 x nAnt matrix with leakages, first row is XY, second is YX (resized as necessary)
+   /// @param[out] valid 2 x nAnt matrix with validity flags (resized as necessary)
+   virtual void leakagesForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                casacore::Matrix<casacore::Complex> &leakages,
+                                casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain bandpass for all antennas of one beam over a range of channels
+   /// @details The values are copied straight from the cache.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] gains (2*nChan) x nAnt matrix with gains, rows are XX and YY for the first channel,
+   ///             then XX and YY for the second channel, etc (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   virtual void bandpassForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                const casacore::uInt startChan, const casacore::uInt nChan,
+                                casacore::Matrix<casacore::Complex> &gains,
+                                casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain bandpass leakages for all antennas of one beam over a range of channels
+   /// @details The values are copied straight from the cache.
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[in] startChan first spectral channel
+   /// @param[in] nChan number of spectral channels
+   /// @param[out] leakages (2*nChan) x nAnt matrix with leakages, rows are XY and YX for the first
+   ///             channel, then XY and YX for the second channel, etc (resized as necessary)
+   /// @param[out] valid (2*nChan) x nAnt matrix with validity flags (resized as necessary)
+   virtual void bpleakageForBeam(const casacore::uInt beam, const casacore::uInt nAnt,
+                                 const casacore::uInt startChan, const casacore::uInt nChan,
+                                 casacore::Matrix<casacore::Complex> &leakages,
+                                 casacore::Matrix<casacore::Bool> &valid) const;
+
+   /// @brief obtain ionospheric parameters for one direction
+   /// @details The parameters are copied from a real-valued nParams x nDir layout kept apart
+   /// from the complex cube (built on first use), so the values for one direction are contiguous.
+   /// @param[in] beam direction (beam) index
+   /// @param[in] nParams number of parameters
+   /// @param[out] params vector with nParams values (resized as necessary)
+   /// @param[out] valid vector with nParams validity flags (resized as necessary)
+   virtual void ionoparamsForBeam(const casacore::uInt beam, const casacore::uInt nParams,
+                                  casacore::Vector<casacore::Float> &params,
+                                  casacore::Vector<casacore::Bool> &valid) const;
+
+   /// @brief obtain all ionospheric parameters of the solution
+   /// @param[in] nParams number of parameters per direction
+   /// @param[in] nBeam number of directions (beams)
+   /// @param[out] params nParams x nBeam matrix with values, parameters of one direction are
+   ///             contiguous (resized as necessary)
+   /// @param[out] valid nParams x nBeam matrix with validity flags (resized as necessary)
+   virtual void ionoparams(const casacore::uInt nParams, const casacore::uInt nBeam,
+                           casacore::Matrix<casacore::Float> &params,
+                           casacore::Matrix<casacore::Bool> &valid) const;
+
    /// @brief set gains (J-Jones)
    /// @details This method writes parallel-hand gains for both
    /// polarisations (corresponding to XX and YY)
@@ -179,12 +265,52 @@ public:
    virtual void setIonosphere(const JonesIndex &index, const IonoTerm &param);
 
    /// @brief write back cache, if necessary
-   /// @details This method checks whether caches need flush and calls appropriate methods of the filler
+   /// @details This method checks whether caches need flush and calls appropriate methods of the filler.
+   /// Only the cubes which have been changed are written. For bandpasses and bpleakages, only the
+   /// range of channels which has been changed is passed to the filler.
    void syncCache() const;
 
+   /// @brief read all parameters available from the filler
+   /// @details Normally the cubes are filled on demand. This method fills all of them
+   /// at once, so the solution can be read in advance (e.g. in a different thread). Parameters
+   /// which can't be read are left to be read on demand, so the error is only reported if such
+   /// parameter is actually requested.
+   void prefetch() const;
+
    /// @brief flush the underlying Filler - if necessary
+   /// @details Nothing is done if nothing has been written since the last flush
+   /// @return true if the filler has been flushed
    virtual bool flushFiller();
 
+   /// @brief view type for gains and leakages
+   typedef JonesCubeView<CubeJonesLayout, 1> GainView;
+
+   /// @brief view type for bandpasses and bandpass leakages
+   typedef JonesCubeView<CubeJonesLayout> BandpassView;
+
+   /// @brief inlined access to gains
+   /// @details The cache is filled if necessary. The view gives direct access to the cached
+   /// cube without any index checks in the release build, so the indices should be checked
+   /// against the dimensions of the view before the loop. It stays valid until the accessor
+   /// is destroyed. An empty view is returned if no gains are defined.
+   /// @return view of the gains
+   GainView gainView() const;
+
+   /// @brief inlined access to leakages
+   /// @details See gainView for details
+   /// @return view of the leakages
+   GainView leakageView() const;
+
+   /// @brief inlined access to bandpasses
+   /// @details See gainView for details
+   /// @return view of the bandpasses
+   BandpassView bandpassView() const;
+
+   /// @brief inlined access to bandpass leakages
+   /// @details See gainView for details
+   /// @return view of the bandpass leakages
+   BandpassView bpleakageView() const;
+
    /// @brief shared pointer definition
    typedef boost::shared_ptr<MemCalSolutionAccessor> ShPtr;
 protected:
@@ -196,6 +322,19 @@ protected:
    static std::pair<casacore::Complex, casacore::Bool> extract(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >  &cubes,
                    const casacore::uInt row, const JonesIndex &index);
 
+   /// @details helper method to extract values and validity flags for all antennas of one beam
+   /// @param[in] cubes const reference to a cube pair
+   /// @param[in] startRow first polarisation/channel index (row of the cube)
+   /// @param[in] nRows number of rows to extract
+   /// @param[in] beam beam index
+   /// @param[in] nAnt number of antennas
+   /// @param[out] values nRows x nAnt matrix with values (resized as necessary)
+   /// @param[out] valid nRows x nAnt matrix with validity flags (resized as necessary)
+   static void extractBeam(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> >  &cubes,
+                   const casacore::uInt startRow, const casacore::uInt nRows, const casacore::uInt beam,
+                   const casacore::uInt nAnt, casacore::Matrix<casacore::Complex> &values,
+                   casacore::Matrix<casacore::Bool> &valid);
+
    /// @details helper method to set the value and validity flag for a given ant/beam pair
    /// @param[in] cubes non-const reference to a cube pair
    /// @param[in] val const reference to the value
@@ -206,7 +345,32 @@ protected:
                    const casacore::Complex &val, const casacore::Bool isValid,
                    const casacore::uInt row, const JonesIndex &index);
 
+   /// @brief extend the range of changed channels
+   /// @param[in] start first changed channel (updated)
+   /// @param[in] end last changed channel + 1 (updated)
+   /// @param[in] chan channel to add to the range
+   static void extendRange(casacore::uInt &start, casacore::uInt &end, const casacore::uInt chan);
+
 private:
+   /// @brief build the validity bitmap from the cached cubes
+   /// @details The cubes are filled if necessary, so an exception is thrown if the filler can't
+   /// read them (in the same way as for the individual getters). If the cubes have inconsistent
+   /// shapes, the bitmap is not used and validity is obtained via the getters.
+   void buildValidity() const;
+
+   /// @brief build the real-valued layout of ionospheric parameters
+   /// @details The cube is filled if necessary. The layout is empty if there are no
+   /// ionospheric parameters.
+   void buildIonoLayout() const;
+
+   /// @brief update the validity bitmap after a term has been set
+   /// @details The bitmap is rebuilt on the next use if the term wasn't cached when it was built
+   /// @param[in] flag term which has been set (one of ValidityFlags)
+   /// @param[in] index ant/beam index
+   /// @param[in] chan spectral channel (ignored for gains and leakages)
+   /// @param[in] valid true, if both polarisation products of the term are valid
+   void updateValidity(const casacore::uInt flag, const JonesIndex &index, const casacore::uInt chan, const bool valid);
+
    // cache fields
 
    /// @brief gains and validity flags (2 x nAnt x nBeam), first row is XX, second is YY
@@ -230,6 +394,61 @@ private:
    /// @brief flag, if false an exception is thrown in setter methods
    const bool itsSettersAllowed;
 
+   // ranges of channels changed since the last syncCache, empty range (start >= end) means
+   // no channel has been set explicitly and the whole cube is written if it needs flush
+
+   /// @brief first changed bandpass channel
+   mutable casacore::uInt itsBandpassesStartChan;
+
+   /// @brief last changed bandpass channel + 1
+   mutable casacore::uInt itsBandpassesEndChan;
+
+   /// @brief first changed bpleakage channel
+   mutable casacore::uInt itsBPLeakagesStartChan;
+
+   /// @brief last changed bpleakage channel + 1
+   mutable casacore::uInt itsBPLeakagesEndChan;
+
+   /// @brief true, if something has been written to the filler since the last flush
+   mutable bool itsFlushPending;
+
+   // validity bitmap (see validity), indexed in the same way as the cubes
+
+   /// @brief true, if the validity bitmap has been built
+   mutable bool itsValidityBuilt;
+
+   /// @brief true, if the validity bitmap can be used (i.e. the cubes have consistent shapes)
+   mutable bool itsValidityUsable;
+
+   /// @brief terms available when the bitmap was built (bitwise combination of ValidityFlags)
+   mutable casacore::uInt itsValidityTerms;
+
+   /// @brief number of antennas in the bitmap
+   mutable casacore::uInt itsValidityNAnt;
+
+   /// @brief number of beams in the bitmap
+   mutable casacore::uInt itsValidityNBeam;
+
+   /// @brief number of channels in the bitmap, zero if there are no bandpasses or bpleakages
+   mutable casacore::uInt itsValidityNChan;
+
+   /// @brief validity of gains and leakages for each antenna and beam
+   mutable std::vector<unsigned char> itsJonesValidity;
+
+   /// @brief validity of bandpasses and bpleakages for each antenna, beam and channel
+   mutable std::vector<unsigned char> itsChanValidity;
+
+   // real-valued layout of ionospheric parameters (see ionoparamsForBeam)
+
+   /// @brief true, if the layout has been built
+   mutable bool itsIonoLayoutBuilt;
+
+   /// @brief ionospheric parameters (nParams x nDir)
+   mutable casacore::Matrix<casacore::Float> itsIonoValues;
+
+   /// @brief validity flags of ionospheric parameters (nParams x nDir)
+   mutable casacore::Matrix<casacore::Bool> itsIonoValid;
+
 }; // class MemCalSolutionAccessor
 
 } // namespace accessors
@@ -33,12 +33,10 @@
 /// @author Max Voronkov <Maxim.Voronkov@csiro.au>
 
 #include <askap/calibaccess/ParsetCalSolutionAccessor.h>
+#include <askap/calibaccess/ParsetCalSolutionParser.h>
+#include <askap/calibaccess/DenseCalSolutionStore.h>
 #include <askap/askap/AskapError.h>
 
-// LOFAR
-#include <Common/ParameterSet.h>
-#include <Common/Exceptions.h>
-
 // logging stuff
 #include <askap_accessors.h>
 #include <askap/askap/AskapLogging.h>
@@ -55,6 +53,8 @@ namespace accessors {
 /// @brief constructor
 /// @details It reads the given parset file, if it exists, and caches the values. Write
 /// operations are performed via this cache which is stored into file in the destructor.
+/// The file is read by ParsetCalSolutionParser, gains, leakages and bandpasses are
+/// kept in the dense storage.
 /// @param[in] parset parset file name
 /// @param[in] readonly if true, additional checks are done that file exists, otherwise
 /// it is assumed that we may write a new file
@@ -62,10 +62,13 @@ ParsetCalSolutionAccessor::ParsetCalSolutionAccessor(const std::string &parset,
         itsWriteRequired(false), itsFirstWrite(true)
 {
   try {
-     cache() << LOFAR::ParameterSet(itsParsetFileName);
-     ASKAPLOG_INFO_STR(logger, "Successfully read calibration solution from a parset file "<<itsParsetFileName);
+     DenseCalSolutionStore store;
+     const size_t nParams = ParsetCalSolutionParser::parseFile(itsParsetFileName, store, cache());
+     takeDenseStorage(store);
+     ASKAPLOG_INFO_STR(logger, "Successfully read calibration solution ("<<nParams<<
+                       " parameters) from a parset file "<<itsParsetFileName);
   }
-  catch (const LOFAR::APSException &) {
+  catch (const AskapError &) {
      // nothing read, this could be a write case, unless we know otherwise
      if (readonly) {
          throw;
@@ -0,0 +1,402 @@
+/// @file
+///
+/// @brief Fast parser of calibration solutions stored in a parset file
+/// @details This parser decodes the keys of gains, leakages, bandpasses and bandpass
+/// leakages directly into DenseCalSolutionStore, optionally using several threads.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/ParsetCalSolutionParser.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+ASKAP_LOGGER(logger, ".calibaccess.ParsetCalSolutionParser");
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief minimum number of bytes worth parsing in a separate thread
+const size_t theMinChunkSize = 4 * 1024 * 1024;
+
+/// @brief maximum number of threads used by default
+const size_t theMaxThreads = 8;
+
+/// @brief element decoded from a single line
+struct Element {
+   /// @brief kind of the term
+   DenseCalSolutionStore::Term itsTerm;
+   /// @brief antenna index
+   casacore::uInt itsAnt;
+   /// @brief beam index
+   casacore::uInt itsBeam;
+   /// @brief polarisation index (0 or 1)
+   casacore::uInt itsPol;
+   /// @brief channel index (zero for gains and leakages)
+   casacore::uInt itsChan;
+   /// @brief value
+   casacore::Complex itsValue;
+};
+
+/// @brief result of parsing a part of the buffer
+struct Chunk {
+   /// @brief set up an empty chunk
+   Chunk() {
+      std::fill(&itsShape[0][0], &itsShape[0][0] + DenseCalSolutionStore::NUMBER_OF_TERMS * 3, 0u);
+   }
+
+   /// @brief elements in the order of lines
+   std::vector<Element> itsElements;
+   /// @brief other parameters in the order of lines
+   std::vector<std::pair<std::string, casacore::Complex> > itsOther;
+   /// @brief number of antennas, beams and channels required for each kind of terms
+   casacore::uInt itsShape[DenseCalSolutionStore::NUMBER_OF_TERMS][3];
+   /// @brief error encountered while parsing, if any
+   std::exception_ptr itsError;
+};
+
+/// @brief skip spaces and tabs
+/// @param[in] ptr current position
+/// @param[in] end end of the line
+/// @return first position which is not a space or tab
+inline const char* skipBlanks(const char *ptr, const char *end)
+{
+  while ((ptr != end) && ((*ptr == ' ') || (*ptr == '\t') || (*ptr == '\r'))) {
+         ++ptr;
+  }
+  return ptr;
+}
+
+/// @brief decode unsigned number
+/// @param[in,out] ptr current position, advanced past the digits
+/// @param[in] end end of the key
+/// @param[out] val decoded number
+/// @return true, if at least one digit has been found
+inline bool parseIndex(const char *&ptr, const char *end, casacore::uInt &val)
+{
+  const char *start = ptr;
+  val = 0;
+  while ((ptr != end) && (*ptr >= '0') && (*ptr <= '9')) {
+         val = val * 10 + casacore::uInt(*ptr - '0');
+         ++ptr;
+  }
+  return ptr != start;
+}
+
+/// @brief decode the key of a gain, leakage, bandpass or bandpass leakage
+/// @param[in] begin start of the key
+/// @param[in] end end of the key
+/// @param[out] elem element to fill (all fields except the value)
+/// @return true, if the key has been decoded, false if it has a different form
+bool parseKey(const char *begin, const char *end, Element &elem)
+{
+  const size_t length = size_t(end - begin);
+  const char *ptr = begin;
+  bool leakage = false;
+  if ((length > 5) && (strncmp(ptr, "gain.", 5) == 0)) {
+      ptr += 5;
+  } else if ((length > 8) && (strncmp(ptr, "leakage.", 8) == 0)) {
+      ptr += 8;
+      leakage = true;
+  } else {
+      return false;
+  }
+  // g11/g22 for gains, d12/d21 for leakages
+  if (end - ptr < 4) {
+      return false;
+  }
+  if (!leakage && (ptr[0] == 'g') && (ptr[1] == ptr[2]) && ((ptr[1] == '1') || (ptr[1] == '2'))) {
+      elem.itsPol = ptr[1] == '1' ? 0 : 1;
+  } else if (leakage && (ptr[0] == 'd') && (ptr[1] != ptr[2]) && ((ptr[1] == '1') || (ptr[1] == '2')) &&
+             ((ptr[2] == '1') || (ptr[2] == '2'))) {
+      elem.itsPol = ptr[1] == '1' ? 0 : 1;
+  } else {
+      return false;
+  }
+  ptr += 3;
+  if ((*ptr++ != '.') || !parseIndex(ptr, end, elem.itsAnt) || (ptr == end) || (*ptr++ != '.') ||
+      !parseIndex(ptr, end, elem.itsBeam)) {
+      return false;
+  }
+  bool bandpass = false;
+  elem.itsChan = 0;
+  if (ptr != end) {
+      if ((*ptr++ != '.') || !parseIndex(ptr, end, elem.itsChan) || (ptr != end)) {
+          return false;
+      }
+      bandpass = true;
+  }
+  elem.itsTerm = leakage ? (bandpass ? DenseCalSolutionStore::BPLEAKAGE : DenseCalSolutionStore::LEAKAGE) :
+                           (bandpass ? DenseCalSolutionStore::BANDPASS : DenseCalSolutionStore::GAIN);
+  return true;
+}
+
+/// @brief decode a real number
+/// @param[in,out] ptr current position, advanced past the number
+/// @param[in] end end of the line
+/// @param[out] val decoded number
+/// @return true, if the number has been decoded
+bool parseNumber(const char *&ptr, const char *end, double &val)
+{
+  // the buffer is not necessarily null-terminated, so the number is copied first
+  char buf[64];
+  size_t length = 0;
+  while ((ptr + length != end) && (length + 1 < sizeof(buf)) && (strchr("0123456789+-.eE", ptr[length]) != 0)) {
+         buf[length] = ptr[length];
+         ++length;
+  }
+  buf[length] = 0;
+  char *stop = 0;
+  val = strtod(buf, &stop);
+  if ((stop == buf) || (stop != buf + length)) {
+      return false;
+  }
+  ptr += length;
+  return true;
+}
+
+/// @brief decode the value
+/// @details The value is either [re,im], [re] or re
+/// @param[in] begin start of the value
+/// @param[in] end end of the line (comments are stripped already)
+/// @param[out] val decoded value
+/// @return true, if the value has been decoded
+bool parseValue(const char *begin, const char *end, casacore::Complex &val)
+{
+  const char *ptr = skipBlanks(begin, end);
+  const bool bracket = (ptr != end) && (*ptr == '[');
+  if (bracket) {
+      ptr = skipBlanks(ptr + 1, end);
+  }
+  double re = 0., im = 0.;
+  if (!parseNumber(ptr, end, re)) {
+      return false;
+  }
+  ptr = skipBlanks(ptr, end);
+  if (bracket) {
+      if ((ptr != end) && (*ptr == ',')) {
+          ptr = skipBlanks(ptr + 1, end);
+          if (!parseNumber(ptr, end, im)) {
+              return false;
+          }
+          ptr = skipBlanks(ptr, end);
+      }
+      if ((ptr == end) || (*ptr != ']')) {
+          return false;
+      }
+      ptr = skipBlanks(ptr + 1, end);
+  }
+  val = casacore::Complex(re, im);
+  return ptr == end;
+}
+
+/// @brief parse a part of the buffer
+/// @param[in] begin start of the part, should be the start of a line
+/// @param[in] end end of the part, should be the end of a line
+/// @param[out] chunk result
+void parseChunk(const char *begin, const char *end, Chunk &chunk)
+{
+  for (const char *line = begin; line < end;) {
+       const char *eol = static_cast<const char*>(memchr(line, '\n', size_t(end - line)));
+       if (eol == 0) {
+           eol = end;
+       }
+       const char *comment = static_cast<const char*>(memchr(line, '#', size_t(eol - line)));
+       const char *lineEnd = comment != 0 ? comment : eol;
+       const char *keyBegin = skipBlanks(line, lineEnd);
+       if (keyBegin != lineEnd) {
+           const char *equal = static_cast<const char*>(memchr(keyBegin, '=', size_t(lineEnd - keyBegin)));
+           ASKAPCHECK(equal != 0, "Unable to parse line '"<<std::string(keyBegin, lineEnd)<<
+                      "' of the calibration parset, '=' is missing");
+           const char *keyEnd = equal;
+           while ((keyEnd != keyBegin) && ((keyEnd[-1] == ' ') || (keyEnd[-1] == '\t'))) {
+                  --keyEnd;
+           }
+           Element elem;
+           ASKAPCHECK(parseValue(equal + 1, lineEnd, elem.itsValue), "Unable to parse the value of "<<
+                      std::string(keyBegin, keyEnd)<<" in the calibration parset: "<<std::string(equal + 1, lineEnd));
+           if (parseKey(keyBegin, keyEnd, elem)) {
+               casacore::uInt *shape = chunk.itsShape[elem.itsTerm];
+               shape[0] = std::max(shape[0], elem.itsAnt + 1);
+               shape[1] = std::max(shape[1], elem.itsBeam + 1);
+               shape[2] = std::max(shape[2], elem.itsChan + 1);
+               chunk.itsElements.push_back(elem);
+           } else {
+               chunk.itsOther.push_back(std::make_pair(std::string(keyBegin, keyEnd), elem.itsValue));
+           }
+       }
+       line = eol + 1;
+  }
+}
+
+/// @brief functor parsing a part of the buffer in a separate thread
+struct ChunkParser {
+   /// @brief set up the functor
+   /// @param[in] begin start of the part
+   /// @param[in] end end of the part
+   /// @param[out] chunk result
+   ChunkParser(const char *begin, const char *end, Chunk &chunk) : itsBegin(begin), itsEnd(end), itsChunk(&chunk) {}
+
+   /// @brief parse the part, errors are stored in the chunk
+   void operator()() const {
+      try {
+         parseChunk(itsBegin, itsEnd, *itsChunk);
+      }
+      catch (...) {
+         itsChunk->itsError = std::current_exception();
+      }
+   }
+
+   /// @brief start of the part
+   const char *itsBegin;
+   /// @brief end of the part
+   const char *itsEnd;
+   /// @brief result
+   Chunk *itsChunk;
+};
+
+} // anonymous namespace
+
+/// @brief parse the buffer
+/// @details An exception is thrown if the buffer contains a line which can't be parsed.
+/// @param[in] begin start of the buffer
+/// @param[in] end end of the buffer (one past the last character)
+/// @param[out] store dense storage to fill (the existing content is kept, but can be
+///             overwritten by the parsed values)
+/// @param[out] other parameters not handled by the dense storage are added here
+/// @param[in] nThreads number of threads to use, zero means to decide based on the
+///            buffer size and the number of cores
+/// @return number of elements stored in the dense storage
+size_t ParsetCalSolutionParser::parse(const char *begin, const char *end, DenseCalSolutionStore &store,
+                                      scimath::Params &other, size_t nThreads)
+{
+  ASKAPDEBUGASSERT(begin <= end);
+  const size_t size = size_t(end - begin);
+  if (nThreads == 0) {
+      nThreads = std::min(size_t(boost::thread::hardware_concurrency()), theMaxThreads);
+      nThreads = std::min(nThreads, size / theMinChunkSize);
+  }
+  nThreads = std::max(std::min(nThreads, size), size_t(1));
+
+  // split the buffer at line boundaries
+  std::vector<Chunk> chunks(nThreads);
+  std::vector<const char*> bounds(nThreads + 1, end);
+  bounds[0] = begin;
+  for (size_t part = 1; part < nThreads; ++part) {
+       const char *pos = std::max(begin + part * (size / nThreads), bounds[part - 1]);
+       const char *eol = static_cast<const char*>(memchr(pos, '\n', size_t(end - pos)));
+       bounds[part] = eol != 0 ? eol + 1 : end;
+  }
+  if (nThreads == 1) {
+      parseChunk(begin, end, chunks[0]);
+  } else {
+      boost::thread_group threads;
+      for (size_t part = 0; part < nThreads; ++part) {
+           threads.create_thread(ChunkParser(bounds[part], bounds[part + 1], chunks[part]));
+      }
+      threads.join_all();
+      for (size_t part = 0; part < nThreads; ++part) {
+           if (chunks[part].itsError) {
+               std::rethrow_exception(chunks[part].itsError);
+           }
+      }
+  }
+
+  // allocate the storage once, so it is not reorganised while the elements are set
+  for (int term = 0; term < DenseCalSolutionStore::NUMBER_OF_TERMS; ++term) {
+       casacore::uInt shape[3] = {0u, 0u, 0u};
+       for (size_t part = 0; part < nThreads; ++part) {
+            for (int dim = 0; dim < 3; ++dim) {
+                 shape[dim] = std::max(shape[dim], chunks[part].itsShape[term][dim]);
+            }
+       }
+       store.reserve(DenseCalSolutionStore::Term(term), shape[0], shape[1], shape[2]);
+  }
+  size_t result = 0;
+  for (size_t part = 0; part < nThreads; ++part) {
+       const std::vector<Element> &elements = chunks[part].itsElements;
+       for (std::vector<Element>::const_iterator ci = elements.begin(); ci != elements.end(); ++ci) {
+            store.set(ci->itsTerm, ci->itsAnt, ci->itsBeam, ci->itsPol, ci->itsChan, ci->itsValue);
+       }
+       result += elements.size();
+       const std::vector<std::pair<std::string, casacore::Complex> > &params = chunks[part].itsOther;
+       for (std::vector<std::pair<std::string, casacore::Complex> >::const_iterator ci = params.begin();
+            ci != params.end(); ++ci) {
+            if (other.has(ci->first)) {
+                other.update(ci->first, ci->second);
+            } else {
+                other.add(ci->first, ci->second);
+            }
+       }
+  }
+  ASKAPLOG_DEBUG_STR(logger, "Parsed "<<result<<" calibration parameter(s) using "<<nThreads<<" thread(s)");
+  return result;
+}
+
+/// @brief parse the file
+/// @details An exception is thrown if the file can't be read or parsed.
+/// @param[in] name file name
+/// @param[out] store dense storage to fill (the existing content is kept, but can be
+///             overwritten by the parsed values)
+/// @param[out] other parameters not handled by the dense storage are added here
+/// @param[in] nThreads number of threads to use, zero means to decide based on the
+///            file size and the number of cores
+/// @return number of elements stored in the dense storage
+size_t ParsetCalSolutionParser::parseFile(const std::string &name, DenseCalSolutionStore &store,
+                                          scimath::Params &other, size_t nThreads)
+{
+  std::ifstream is(name.c_str(), std::ios::binary | std::ios::ate);
+  ASKAPCHECK(is, "Unable to open calibration parset "<<name);
+  const std::streamoff size = is.tellg();
+  ASKAPCHECK(size >= 0, "Unable to obtain the size of calibration parset "<<name);
+  std::vector<char> buffer(static_cast<size_t>(size));
+  is.seekg(0);
+  if (size > 0) {
+      is.read(&buffer[0], size);
+  }
+  ASKAPCHECK(is, "Unable to read calibration parset "<<name);
+  const char *begin = buffer.empty() ? 0 : &buffer[0];
+  return parse(begin, begin + buffer.size(), store, other, nThreads);
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,93 @@
+/// @file
+///
+/// @brief Fast parser of calibration solutions stored in a parset file
+/// @details Reading the parset via LOFAR::ParameterSet and converting every key name with
+/// CalParamNameHelper takes a long time for large files with bandpasses. This parser
+/// decodes the keys of gains, leakages, bandpasses and bandpass leakages directly into
+/// DenseCalSolutionStore without building an intermediate parameter set.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_PARSET_CAL_SOLUTION_PARSER_H
+#define ASKAP_ACCESSORS_PARSET_CAL_SOLUTION_PARSER_H
+
+// own includes
+#include <askap/calibaccess/DenseCalSolutionStore.h>
+#include <askap/scimath/fitting/Params.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Fast parser of calibration solutions stored in a parset file
+/// @details The parser handles the subset of the parset syntax written by
+/// ParsetCalSolutionAccessor: one "key = value" pair per line, where the value is either
+/// a complex number given as [re,im], or a real number (with or without brackets). Empty
+/// lines and comments starting with '#' are skipped. Keys of the form gain.g11.ant.beam,
+/// gain.g22.ant.beam, leakage.d12.ant.beam and leakage.d21.ant.beam, optionally followed
+/// by the channel number, are decoded straight into the dense storage without any memory
+/// allocation per key. All other keys (e.g. ionospheric parameters) are added to the given
+/// scimath::Params object. If the same key is given more than once, the last value is taken.
+///
+/// Large buffers are split at line boundaries and parsed by several threads, the results
+/// are combined in the order of the lines, so the outcome doesn't depend on the number of
+/// threads used.
+/// @ingroup calibaccess
+struct ParsetCalSolutionParser {
+  /// @brief parse the buffer
+  /// @details An exception is thrown if the buffer contains a line which can't be parsed.
+  /// @param[in] begin start of the buffer
+  /// @param[in] end end of the buffer (one past the last character)
+  /// @param[out] store dense storage to fill (the existing content is kept, but can be
+  ///             overwritten by the parsed values)
+  /// @param[out] other parameters not handled by the dense storage are added here
+  /// @param[in] nThreads number of threads to use, zero means to decide based on the
+  ///            buffer size and the number of cores
+  /// @return number of elements stored in the dense storage
+  static size_t parse(const char *begin, const char *end, DenseCalSolutionStore &store,
+                      scimath::Params &other, size_t nThreads = 0);
+
+  /// @brief parse the file
+  /// @details An exception is thrown if the file can't be read or parsed.
+  /// @param[in] name file name
+  /// @param[out] store dense storage to fill (the existing content is kept, but can be
+  ///             overwritten by the parsed values)
+  /// @param[out] other parameters not handled by the dense storage are added here
+  /// @param[in] nThreads number of threads to use, zero means to decide based on the
+  ///            file size and the number of cores
+  /// @return number of elements stored in the dense storage
+  static size_t parseFile(const std::string &name, DenseCalSolutionStore &store,
+                          scimath::Params &other, size_t nThreads = 0);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PARSET_CAL_SOLUTION_PARSER_H
@@ -0,0 +1,474 @@
+/// @file
+///
+/// @brief Solution filler sharing the cubes between processes on the same node
+/// @details This filler wraps another (read-only) filler and keeps the cubes in
+/// POSIX shared memory segments, so the solution is read by one process only.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/calibaccess/SharedMemCalSolutionFiller.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/chrono.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <sstream>
+#include <stdint.h>
+
+// system includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".calibaccess.SharedMemCalSolutionFiller");
+
+namespace askap {
+
+namespace accessors {
+
+namespace {
+
+/// @brief states of the segment
+enum SegmentState {
+   SEGMENT_LOADING = 0,
+   SEGMENT_READY,
+   SEGMENT_FAILED
+};
+
+/// @brief header at the start of each shared memory segment
+struct SegmentHeader {
+   /// @brief magic number to catch incompatible segments
+   uint32_t itsMagic;
+   /// @brief state of the segment (see SegmentState)
+   std::atomic<uint32_t> itsState;
+   /// @brief shape of the cubes
+   uint32_t itsShape[3];
+};
+
+/// @brief magic number stored in the header
+const uint32_t theMagic = 0x41534b43;
+
+/// @brief offset of the data from the start of the segment (keeps the data aligned)
+const size_t theDataOffset = 64;
+
+/// @brief size of the segment holding the cubes with the given number of elements
+/// @param[in] nElements number of elements in each cube
+/// @return size in bytes
+size_t segmentSize(const size_t nElements)
+{
+  return theDataOffset + nElements * (sizeof(casacore::Complex) + sizeof(casacore::Bool));
+}
+
+/// @brief name of the product used in the segment name
+/// @param[in] product index of the product
+/// @return product name
+const char* productName(const int product)
+{
+  static const char* names[] = {"gain", "leakage", "bandpass", "bpleakage", "iono"};
+  ASKAPDEBUGASSERT((product >= 0) && (product < 5));
+  return names[product];
+}
+
+} // anonymous namespace
+
+/// @brief mapped segment
+struct SharedMemCalSolutionFiller::Segment : public boost::noncopyable {
+   /// @brief set up an empty segment
+   /// @param[in] name name of the shared memory object
+   explicit Segment(const std::string &name) : itsName(name), itsAddr(MAP_FAILED), itsSize(0), itsOwner(false) {}
+
+   /// @brief unmap the memory and remove the name if this process created it
+   ~Segment() {
+      if (itsAddr != MAP_FAILED) {
+          munmap(itsAddr, itsSize);
+      }
+      if (itsOwner) {
+          shm_unlink(itsName.c_str());
+      }
+   }
+
+   /// @return header of the mapped segment
+   const SegmentHeader& header() const {
+      ASKAPDEBUGASSERT(itsAddr != MAP_FAILED);
+      return *static_cast<const SegmentHeader*>(itsAddr);
+   }
+
+   /// @return pointer to the values
+   casacore::Complex* values() const {
+      return reinterpret_cast<casacore::Complex*>(static_cast<char*>(itsAddr) + theDataOffset);
+   }
+
+   /// @return pointer to the validity flags
+   casacore::Bool* flags() const {
+      const SegmentHeader &hdr = header();
+      return reinterpret_cast<casacore::Bool*>(values() + size_t(hdr.itsShape[0]) * hdr.itsShape[1] * hdr.itsShape[2]);
+   }
+
+   /// @brief name of the shared memory object
+   std::string itsName;
+   /// @brief start of the mapped memory
+   void *itsAddr;
+   /// @brief size of the mapped memory
+   size_t itsSize;
+   /// @brief true, if this process created the segment
+   bool itsOwner;
+};
+
+/// @brief set up the filler
+/// @param[in] filler read-only filler used to read the data
+/// @param[in] key string identifying the solution store and selection (e.g. table name and
+///            channel range), processes using the same key and ID share the data
+/// @param[in] id solution ID
+/// @param[in] timeout maximum time (in seconds) to wait for another process to publish the data
+SharedMemCalSolutionFiller::SharedMemCalSolutionFiller(const boost::shared_ptr<ICalSolutionFiller> &filler,
+         const std::string &key, const long id, const double timeout) : itsFiller(filler), itsKey(key),
+         itsID(id), itsTimeout(timeout)
+{
+  ASKAPCHECK(itsFiller, "An attempt to initialise SharedMemCalSolutionFiller with an empty shared pointer");
+}
+
+/// @brief destructor, unmaps the segments and removes the names created by this process
+SharedMemCalSolutionFiller::~SharedMemCalSolutionFiller()
+{
+  if ((segmentsPublished() > 0) || (segmentsMapped() > 0)) {
+      ASKAPLOG_DEBUG_STR(logger, "Calibration solution "<<itsID<<": "<<segmentsPublished()<<
+                  " segment(s) published, "<<segmentsMapped()<<" segment(s) mapped from another process");
+  }
+}
+
+/// @brief number of segments read by this process via the wrapped filler and published
+/// @return number of segments owned by this process
+size_t SharedMemCalSolutionFiller::segmentsPublished() const
+{
+  size_t result = 0;
+  for (int product = 0; product < NUMBER_OF_PRODUCTS; ++product) {
+       if (itsSegments[product] && itsSegments[product]->itsOwner) {
+           ++result;
+       }
+  }
+  return result;
+}
+
+/// @brief number of segments mapped from another process
+/// @return number of segments published by other processes
+size_t SharedMemCalSolutionFiller::segmentsMapped() const
+{
+  size_t result = 0;
+  for (int product = 0; product < NUMBER_OF_PRODUCTS; ++product) {
+       if (itsSegments[product] && !itsSegments[product]->itsOwner) {
+           ++result;
+       }
+  }
+  return result;
+}
+
+/// @brief obtain the name of the shared memory segment
+/// @param[in] key string identifying the solution store and selection
+/// @param[in] id solution ID
+/// @param[in] product name of the product (e.g. "gain")
+/// @return segment name suitable for shm_open
+std::string SharedMemCalSolutionFiller::segmentName(const std::string &key, const long id, const std::string &product)
+{
+  std::ostringstream os;
+  os<<"/askap_cal_"<<getuid()<<"_"<<std::hex<<std::hash<std::string>()(key)<<std::dec<<"_"<<id<<"_"<<product;
+  return os.str();
+}
+
+/// @brief fill cubes for the given product
+/// @details The cubes are created from the shared segment. If the segment can't be used,
+/// they are read via the wrapped filler.
+/// @param[in] product kind of the solution
+/// @param[in] reader method of the wrapped filler to read the data
+/// @param[out] cubes pair of cubes to fill
+void SharedMemCalSolutionFiller::fill(Product product, void (ICalSolutionFiller::*reader)(std::pair<casacore::Cube<casacore::Complex>,
+            casacore::Cube<casacore::Bool> > &) const,
+            std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes) const
+{
+  ASKAPDEBUGASSERT(itsFiller);
+  ASKAPDEBUGASSERT(product < NUMBER_OF_PRODUCTS);
+  if (!itsSegments[product]) {
+      const std::string name = segmentName(itsKey, itsID, productName(product));
+      boost::shared_ptr<Segment> segment(new Segment(name));
+      bool mapped = false;
+      int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+      if (fd >= 0) {
+          segment->itsOwner = true;
+          mapped = publish(fd, *segment, reader, cubes);
+          if (!mapped) {
+              // the data have been read, but can't be shared
+              return;
+          }
+      } else if (errno == EEXIST) {
+          fd = shm_open(name.c_str(), O_RDONLY, 0);
+          if (fd >= 0) {
+              mapped = attach(fd, *segment);
+          }
+      }
+      if (!mapped) {
+          ASKAPLOG_WARN_STR(logger, "Unable to use shared memory segment "<<name<<
+                            ", calibration solution is read by this process");
+          ((*itsFiller).*reader)(cubes);
+          return;
+      }
+      itsSegments[product] = segment;
+  }
+  const Segment &segment = *itsSegments[product];
+  const SegmentHeader &hdr = segment.header();
+  const casacore::IPosition shape(3, hdr.itsShape[0], hdr.itsShape[1], hdr.itsShape[2]);
+  // the cubes refer to the mapped memory, they must not be modified
+  cubes.first.takeStorage(shape, segment.values(), casacore::SHARE);
+  cubes.second.takeStorage(shape, segment.flags(), casacore::SHARE);
+}
+
+/// @brief read the data via the wrapped filler and publish them in the new segment
+/// @param[in] fd descriptor of the newly created shared memory object
+/// @param[in] segment segment to set up
+/// @param[in] reader method of the wrapped filler to read the data
+/// @param[out] cubes pair of cubes filled by the wrapped filler
+/// @return true, if the data have been published, false if they are only available in cubes
+bool SharedMemCalSolutionFiller::publish(int fd, Segment &segment, void (ICalSolutionFiller::*reader)(std::pair<casacore::Cube<casacore::Complex>,
+               casacore::Cube<casacore::Bool> > &) const,
+               std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes) const
+{
+  ASKAPDEBUGASSERT(segment.itsOwner);
+  // the header is published first, so other processes know the data are being read
+  void *hdrAddr = ftruncate(fd, theDataOffset) == 0 ? mmap(0, theDataOffset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+  if (hdrAddr == MAP_FAILED) {
+      close(fd);
+      ((*itsFiller).*reader)(cubes);
+      return false;
+  }
+  SegmentHeader *hdr = new (hdrAddr) SegmentHeader;
+  hdr->itsMagic = theMagic;
+  hdr->itsState.store(SEGMENT_LOADING);
+  try {
+     ((*itsFiller).*reader)(cubes);
+  }
+  catch (...) {
+     hdr->itsState.store(SEGMENT_FAILED);
+     munmap(hdrAddr, theDataOffset);
+     close(fd);
+     throw;
+  }
+  ASKAPCHECK(cubes.first.shape() == cubes.second.shape(), "Cubes with values and validity flags are expected to have the same shape");
+  const size_t nElements = cubes.first.nelements();
+  const size_t size = segmentSize(nElements);
+  void *addr = ftruncate(fd, size) == 0 ? mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+  close(fd);
+  if (addr == MAP_FAILED) {
+      hdr->itsState.store(SEGMENT_FAILED);
+      munmap(hdrAddr, theDataOffset);
+      return false;
+  }
+  munmap(hdrAddr, theDataOffset);
+  segment.itsAddr = addr;
+  segment.itsSize = size;
+  SegmentHeader *fullHdr = static_cast<SegmentHeader*>(addr);
+  for (casacore::uInt dim = 0; dim < 3; ++dim) {
+       fullHdr->itsShape[dim] = static_cast<uint32_t>(cubes.first.shape()[dim]);
+  }
+  bool deleteValues, deleteFlags;
+  const casacore::Complex *values = cubes.first.getStorage(deleteValues);
+  const casacore::Bool *flags = cubes.second.getStorage(deleteFlags);
+  std::memcpy(segment.values(), values, nElements * sizeof(casacore::Complex));
+  std::memcpy(segment.flags(), flags, nElements * sizeof(casacore::Bool));
+  cubes.first.freeStorage(values, deleteValues);
+  cubes.second.freeStorage(flags, deleteFlags);
+  fullHdr->itsState.store(SEGMENT_READY, std::memory_order_release);
+  return true;
+}
+
+/// @brief wait until the data are published by another process and map them
+/// @param[in] fd descriptor of the existing shared memory object
+/// @param[in] segment segment to set up
+/// @return true, if the data have been mapped, false if they have to be read via the wrapped filler
+bool SharedMemCalSolutionFiller::attach(int fd, Segment &segment) const
+{
+  ASKAPDEBUGASSERT(!segment.itsOwner);
+  const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+  void *hdrAddr = MAP_FAILED;
+  uint32_t state = SEGMENT_LOADING;
+  while (state == SEGMENT_LOADING) {
+         if (hdrAddr == MAP_FAILED) {
+             struct stat st;
+             if (fstat(fd, &st) != 0) {
+                 break;
+             }
+             if (size_t(st.st_size) >= theDataOffset) {
+                 hdrAddr = mmap(0, theDataOffset, PROT_READ, MAP_SHARED, fd, 0);
+                 if (hdrAddr == MAP_FAILED) {
+                     break;
+                 }
+             }
+         }
+         if (hdrAddr != MAP_FAILED) {
+             const SegmentHeader *hdr = static_cast<const SegmentHeader*>(hdrAddr);
+             if (hdr->itsMagic != theMagic) {
+                 break;
+             }
+             state = hdr->itsState.load(std::memory_order_acquire);
+         }
+         if ((state == SEGMENT_LOADING) && (boost::chrono::duration<double>(boost::chrono::steady_clock::now() -
+              start).count() > itsTimeout)) {
+             ASKAPLOG_WARN_STR(logger, "Timeout waiting for shared memory segment "<<segment.itsName);
+             break;
+         }
+         if (state == SEGMENT_LOADING) {
+             boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+         }
+  }
+  if (hdrAddr != MAP_FAILED) {
+      munmap(hdrAddr, theDataOffset);
+  }
+  struct stat st;
+  if ((state != SEGMENT_READY) || (fstat(fd, &st) != 0)) {
+      close(fd);
+      return false;
+  }
+  const size_t size = size_t(st.st_size);
+  void *addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+      return false;
+  }
+  segment.itsAddr = addr;
+  segment.itsSize = size;
+  const SegmentHeader &hdr = segment.header();
+  if (size < segmentSize(size_t(hdr.itsShape[0]) * hdr.itsShape[1] * hdr.itsShape[2])) {
+      ASKAPLOG_WARN_STR(logger, "Shared memory segment "<<segment.itsName<<" is truncated");
+      return false;
+  }
+  return true;
+}
+
+/// @brief gains filler
+/// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+void SharedMemCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
+{
+  fill(GAIN, &ICalSolutionFiller::fillGains, gains);
+}
+
+/// @brief leakage filler
+/// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+void SharedMemCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
+{
+  fill(LEAKAGE, &ICalSolutionFiller::fillLeakages, leakages);
+}
+
+/// @brief bandpass filler
+/// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+void SharedMemCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
+{
+  fill(BANDPASS, &ICalSolutionFiller::fillBandpasses, bp);
+}
+
+/// @brief bpleakage filler
+/// @param[in] bpleakages pair of cubes with bandpass leakages and validity flags (to be resized to (2*nChan) x nAnt x nBeam)
+void SharedMemCalSolutionFiller::fillBPLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages) const
+{
+  fill(BPLEAKAGE, &ICalSolutionFiller::fillBPLeakages, bpleakages);
+}
+
+/// @brief ionospheric parameters filler
+/// @param[in] params pair of cubes with ionospheric parameters and validity flags (to be resised to 1 x nParam x nDir)
+void SharedMemCalSolutionFiller::fillIonoParams(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &params) const
+{
+  fill(IONOSPHERE, &ICalSolutionFiller::fillIonoParams, params);
+}
+
+/// @brief gains writer (not supported)
+void SharedMemCalSolutionFiller::writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "SharedMemCalSolutionFiller is read-only");
+}
+
+/// @brief leakage writer (not supported)
+void SharedMemCalSolutionFiller::writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "SharedMemCalSolutionFiller is read-only");
+}
+
+/// @brief bandpass writer (not supported)
+void SharedMemCalSolutionFiller::writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "SharedMemCalSolutionFiller is read-only");
+}
+
+/// @brief bpleakage writer (not supported)
+void SharedMemCalSolutionFiller::writeBPLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "SharedMemCalSolutionFiller is read-only");
+}
+
+/// @brief ionospheric parameters writer (not supported)
+void SharedMemCalSolutionFiller::writeIonoParams(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &) const
+{
+  ASKAPTHROW(AskapError, "SharedMemCalSolutionFiller is read-only");
+}
+
+/// @return true, if there is no gain solution
+bool SharedMemCalSolutionFiller::noGain() const
+{
+  return itsFiller->noGain();
+}
+
+/// @return true, if there is no leakage solution
+bool SharedMemCalSolutionFiller::noLeakage() const
+{
+  return itsFiller->noLeakage();
+}
+
+/// @return true, if there is no bandpass solution
+bool SharedMemCalSolutionFiller::noBandpass() const
+{
+  return itsFiller->noBandpass();
+}
+
+/// @return true, if there is no bandpass leakage solution
+bool SharedMemCalSolutionFiller::noBPLeakage() const
+{
+  return itsFiller->noBPLeakage();
+}
+
+/// @return true, if there is no ionospheric solution
+bool SharedMemCalSolutionFiller::noIonosphere() const
+{
+  return itsFiller->noIonosphere();
+}
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,204 @@
+/// @file
+///
+/// @brief Solution filler sharing the cubes between processes on the same node
+/// @details Each process on a node usually constructs its own MemCalSolutionAccessor
+/// and reads the same calibration solution from the table. This filler wraps another
+/// (read-only) filler and keeps the cubes in POSIX shared memory segments, so the
+/// solution is read by one process only and mapped read-only by all others.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SHARED_MEM_CAL_SOLUTION_FILLER_H
+#define ASKAP_ACCESSORS_SHARED_MEM_CAL_SOLUTION_FILLER_H
+
+// own includes
+#include <askap/calibaccess/ICalSolutionFiller.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Solution filler sharing the cubes between processes on the same node
+/// @details Each kind of solution (gains, leakages, etc) is kept in a separate shared memory
+/// segment named after the given key and the solution ID. The first process to create
+/// the segment reads the cubes via the wrapped filler and publishes them, other processes
+/// wait until the segment is ready and map it read-only. The cubes returned by this filler
+/// refer to the mapped memory directly, so only one copy of the solution is held per node.
+/// The segment name is removed by the process which created it when the filler is destroyed,
+/// the memory is released by the system when the last process unmaps it.
+///
+/// If the process which reads the data fails or doesn't publish the segment within the
+/// given time, other processes read the solution via the wrapped filler themselves. This
+/// filler is read-only, write methods throw an exception.
+/// @ingroup calibaccess
+class SharedMemCalSolutionFiller : virtual public ICalSolutionFiller,
+                                   public boost::noncopyable {
+public:
+  /// @brief set up the filler
+  /// @param[in] filler read-only filler used to read the data
+  /// @param[in] key string identifying the solution store and selection (e.g. table name and
+  ///            channel range), processes using the same key and ID share the data
+  /// @param[in] id solution ID
+  /// @param[in] timeout maximum time (in seconds) to wait for another process to publish the data
+  SharedMemCalSolutionFiller(const boost::shared_ptr<ICalSolutionFiller> &filler, const std::string &key,
+                             const long id, const double timeout = 60.);
+
+  /// @brief destructor, unmaps the segments and removes the names created by this process
+  virtual ~SharedMemCalSolutionFiller();
+
+  /// @brief gains filler
+  /// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage filler
+  /// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
+  virtual void fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass filler
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
+  virtual void fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief bpleakage filler
+  /// @param[in] bpleakages pair of cubes with bandpass leakages and validity flags (to be resized to (2*nChan) x nAnt x nBeam)
+  virtual void fillBPLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages) const;
+
+  /// @brief ionospheric parameters filler
+  /// @param[in] params pair of cubes with ionospheric parameters and validity flags (to be resised to 1 x nParam x nDir)
+  virtual void fillIonoParams(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &params) const;
+
+  /// @brief gains writer (not supported)
+  virtual void writeGains(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const;
+
+  /// @brief leakage writer (not supported)
+  virtual void writeLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const;
+
+  /// @brief bandpass writer (not supported)
+  virtual void writeBandpasses(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const;
+
+  /// @brief bpleakage writer (not supported)
+  virtual void writeBPLeakages(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages) const;
+
+  /// @brief ionospheric parameters writer (not supported)
+  virtual void writeIonoParams(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &params) const;
+
+  /// @return true, if there is no gain solution
+  virtual bool noGain() const;
+
+  /// @return true, if there is no leakage solution
+  virtual bool noLeakage() const;
+
+  /// @return true, if there is no bandpass solution
+  virtual bool noBandpass() const;
+
+  /// @return true, if there is no bandpass leakage solution
+  virtual bool noBPLeakage() const;
+
+  /// @return true, if there is no ionospheric solution
+  virtual bool noIonosphere() const;
+
+  /// @brief number of segments read by this process via the wrapped filler and published
+  /// @return number of segments owned by this process
+  size_t segmentsPublished() const;
+
+  /// @brief number of segments mapped from another process
+  /// @return number of segments published by other processes
+  size_t segmentsMapped() const;
+
+  /// @brief obtain the name of the shared memory segment
+  /// @param[in] key string identifying the solution store and selection
+  /// @param[in] id solution ID
+  /// @param[in] product name of the product (e.g. "gain")
+  /// @return segment name suitable for shm_open
+  static std::string segmentName(const std::string &key, const long id, const std::string &product);
+
+private:
+  /// @brief kinds of solutions, each is kept in a separate segment
+  enum Product {
+     GAIN = 0,
+     LEAKAGE,
+     BANDPASS,
+     BPLEAKAGE,
+     IONOSPHERE,
+     NUMBER_OF_PRODUCTS
+  };
+
+  /// @brief mapped segment
+  struct Segment;
+
+  /// @brief fill cubes for the given product
+  /// @details The cubes are created from the shared segment. If the segment can't be used,
+  /// they are read via the wrapped filler.
+  /// @param[in] product kind of the solution
+  /// @param[in] reader method of the wrapped filler to read the data
+  /// @param[out] cubes pair of cubes to fill
+  void fill(Product product, void (ICalSolutionFiller::*reader)(std::pair<casacore::Cube<casacore::Complex>,
+            casacore::Cube<casacore::Bool> > &) const,
+            std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes) const;
+
+  /// @brief read the data via the wrapped filler and publish them in the new segment
+  /// @param[in] fd descriptor of the newly created shared memory object
+  /// @param[in] segment segment to set up
+  /// @param[in] reader method of the wrapped filler to read the data
+  /// @param[out] cubes pair of cubes filled by the wrapped filler
+  /// @return true, if the data have been published, false if they are only available in cubes
+  bool publish(int fd, Segment &segment, void (ICalSolutionFiller::*reader)(std::pair<casacore::Cube<casacore::Complex>,
+               casacore::Cube<casacore::Bool> > &) const,
+               std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes) const;
+
+  /// @brief wait until the data are published by another process and map them
+  /// @param[in] fd descriptor of the existing shared memory object
+  /// @param[in] segment segment to set up
+  /// @return true, if the data have been mapped, false if they have to be read via the wrapped filler
+  bool attach(int fd, Segment &segment) const;
+
+  /// @brief wrapped filler
+  boost::shared_ptr<ICalSolutionFiller> itsFiller;
+
+  /// @brief key identifying the solution store
+  std::string itsKey;
+
+  /// @brief solution ID
+  long itsID;
+
+  /// @brief maximum time to wait for the data (in seconds)
+  double itsTimeout;
+
+  /// @brief mapped segments
+  mutable boost::shared_ptr<Segment> itsSegments[NUMBER_OF_PRODUCTS];
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SHARED_MEM_CAL_SOLUTION_FILLER_H
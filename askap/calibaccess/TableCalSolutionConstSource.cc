@@ -33,11 +33,24 @@
 #include <askap/calibaccess/TableCalSolutionConstSource.h>
 #include <askap/calibaccess/TableCalSolutionFiller.h>
 #include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/calibaccess/SharedMemCalSolutionFiller.h>
+#include <askap/calibaccess/CalSolutionSequenceFile.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
 #include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
 #include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/measures/Measures/MCEpoch.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <askap/askap/AskapLogging.h>
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include <sstream>
+#include <algorithm>
+
+ASKAP_LOGGER(logger, ".calibaccess.TableCalSolutionConstSource");
 
 
 namespace askap {
@@ -47,17 +60,32 @@ namespace accessors {
 /// @brief constructor using a table defined explicitly
 /// @details
 /// @param[in] tab table to read the solutions from
-TableCalSolutionConstSource::TableCalSolutionConstSource(const casacore::Table &tab) : TableHolder(tab) {}
+TableCalSolutionConstSource::TableCalSolutionConstSource(const casacore::Table &tab) : TableHolder(tab),
+        itsShareSolutions(false), itsShareTimeout(60.), itsCacheSize(0), itsPrefetch(false),
+        itsChangePollInterval(1.), itsCacheMutex(new boost::mutex), itsTableMutex(new boost::mutex), itsCacheHits(0), itsCacheMisses(0),
+        itsSolutionsPrefetched(0) {}
 
 /// @brief constructor using a file name
 /// @details The table is opened for reading and an exception is thrown if the table doesn't exist
 /// @param[in] name table file name
 TableCalSolutionConstSource::TableCalSolutionConstSource(const std::string &name) :
-        TableHolder(casacore::Table(name))
+        TableHolder(casacore::Table(name)), itsShareSolutions(false), itsShareTimeout(60.), itsCacheSize(0),
+        itsPrefetch(false), itsChangePollInterval(1.), itsCacheMutex(new boost::mutex),
+        itsTableMutex(new boost::mutex), itsCacheHits(0), itsCacheMisses(0), itsSolutionsPrefetched(0)
 {
   ASKAPCHECK(table().nrow()>0u, "The table "<<name<<" passed to TableCalSolutionConstSource is empty");
 }
 
+/// @brief destructor, waits for the background read to finish
+TableCalSolutionConstSource::~TableCalSolutionConstSource()
+{
+  waitForPrefetch();
+  if (itsCacheHits + itsCacheMisses > 0) {
+      ASKAPLOG_DEBUG_STR(logger, "Calibration solution cache: "<<itsCacheHits<<" hit(s), "<<itsCacheMisses<<
+                         " miss(es), "<<itsSolutionsPrefetched<<" solution(s) read in background");
+  }
+}
+
 
 /// @brief obtain ID for the most recent solution
 /// @return ID for the most recent solution
@@ -65,7 +93,7 @@ long TableCalSolutionConstSource::mostRecentSolution() const
 {
   // derived classes may initialise the table for writing and, therefore, it could be empty by this point
   // despite the check in the constructor
-  return table().nrow() > 0u ? static_cast<long>(table().nrow()) - 1 : -1;
+  return numberOfSolutions() - 1;
 }
 
 /// @brief obtain solution ID for a given time
@@ -87,6 +115,7 @@ long TableCalSolutionConstSource::solutionID(const double time) const
 /// @return solution ID, time of solution
 std::pair<long, double> TableCalSolutionConstSource::solutionIDBefore(const double time) const
 {
+  const boost::lock_guard<boost::mutex> lock(*itsTableMutex);
   ASKAPASSERT(table().nrow()>0);
   casacore::ROScalarMeasColumn<casacore::MEpoch> bufCol(table(),"TIME");
   for (casacore::rownr_t row = table().nrow(); row > 0u; --row) {
@@ -105,13 +134,16 @@ std::pair<long, double> TableCalSolutionConstSource::solutionIDBefore(const doub
 /// @return solution ID
 std::pair<long, double> TableCalSolutionConstSource::solutionIDAfter(const double time) const
 {
-  ASKAPASSERT(table().nrow()>0);
-  casacore::ROScalarMeasColumn<casacore::MEpoch> bufCol(table(),"TIME");
-  for (casacore::rownr_t row = 0u; row < table().nrow(); ++row) {
-       const double cTime = bufCol.convert(row,casacore::MEpoch::UTC).get("s").getValue();
-       if (time <= cTime) {
-           return std::pair<long, double>(static_cast<long>(row), cTime);
-       }
+  {
+    const boost::lock_guard<boost::mutex> lock(*itsTableMutex);
+    ASKAPASSERT(table().nrow()>0);
+    casacore::ROScalarMeasColumn<casacore::MEpoch> bufCol(table(),"TIME");
+    for (casacore::rownr_t row = 0u; row < table().nrow(); ++row) {
+         const double cTime = bufCol.convert(row,casacore::MEpoch::UTC).get("s").getValue();
+         if (time <= cTime) {
+             return std::pair<long, double>(static_cast<long>(row), cTime);
+         }
+    }
   }
   // return last valid solution if no later one found
   return solutionIDBefore(time);
@@ -127,14 +159,334 @@ std::pair<long, double> TableCalSolutionConstSource::solutionIDAfter(const doubl
 /// @return shared pointer to an accessor object
 boost::shared_ptr<ICalSolutionConstAccessor> TableCalSolutionConstSource::roSolution(const long id) const
 {
-  ASKAPCHECK((id >= 0) && (static_cast<long>(table().nrow()) > id), "Requested solution id="<<id<<" is not in the table");
-  boost::shared_ptr<TableCalSolutionFiller> filler(new TableCalSolutionFiller(table(),id));
-  ASKAPDEBUGASSERT(filler);
-  boost::shared_ptr<MemCalSolutionAccessor> acc(new MemCalSolutionAccessor(filler,true));
+  ASKAPCHECK((id >= 0) && (numberOfSolutions() > id), "Requested solution id="<<id<<" is not in the table");
+  return getAccessor(id, 0, 0);
+}
+
+/// @brief obtain read-only accessor for a given solution ID and a range of channels
+/// @details Only the given range of channels is read from the bandpass and bandpass leakage
+/// cells, the channel index passed to the accessor is counted from startChan.
+/// @param[in] id solution ID to read
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> TableCalSolutionConstSource::roSolutionForChannels(const long id,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+  ASKAPCHECK((id >= 0) && (numberOfSolutions() > id), "Requested solution id="<<id<<" is not in the table");
+  ASKAPCHECK(nChan > 0, "At least one channel is expected to be requested from the calibration table");
+  return getAccessor(id, startChan, nChan);
+}
+
+/// @brief share solutions between processes on the same node
+/// @details If enabled, solutions are read through SharedMemCalSolutionFiller, so only
+/// one process on the node reads a given solution from the table and all others map it
+/// read-only from shared memory.
+/// @param[in] share true to share solutions, false to read them in each process
+/// @param[in] timeout maximum time (in seconds) to wait for another process to read the solution
+void TableCalSolutionConstSource::shareSolutions(bool share, double timeout)
+{
+  itsShareSolutions = share;
+  itsShareTimeout = timeout;
+}
+
+/// @brief set up the accessor for the given filler
+/// @details The filler is wrapped into SharedMemCalSolutionFiller if solutions are shared
+/// @param[in] filler filler to read the solution
+/// @param[in] key string identifying the table and selection
+/// @param[in] id solution ID
+/// @return shared pointer to an accessor object
+boost::shared_ptr<MemCalSolutionAccessor> TableCalSolutionConstSource::makeAccessor(const boost::shared_ptr<ICalSolutionFiller> &filler,
+                   const std::string &key, const long id) const
+{
+  boost::shared_ptr<ICalSolutionFiller> actualFiller = filler;
+  if (itsShareSolutions) {
+      actualFiller.reset(new SharedMemCalSolutionFiller(filler, key, id, itsShareTimeout));
+  }
+  boost::shared_ptr<MemCalSolutionAccessor> acc(new MemCalSolutionAccessor(actualFiller,true));
   ASKAPDEBUGASSERT(acc);
   return acc;
 }
 
+/// @brief keep recently used solutions in memory
+/// @details If the cache is enabled, accessors for up to the given number of solutions are
+/// kept and returned again if the same solution (and the same range of channels) is requested.
+/// If prefetching is enabled, the solution following the requested one is read in a background thread.
+/// @param[in] maxSolutions maximum number of solutions to keep, zero disables the cache
+/// @param[in] prefetchNext if true, the next solution is read in background (requires
+///            room for at least two solutions)
+void TableCalSolutionConstSource::cacheSolutions(size_t maxSolutions, bool prefetchNext)
+{
+  ASKAPCHECK(!prefetchNext || (maxSolutions > 1), "Prefetching calibration solutions requires the cache to hold "
+             "at least 2 solutions, you have "<<maxSolutions);
+  waitForPrefetch();
+  const boost::lock_guard<boost::mutex> lock(*itsCacheMutex);
+  itsCacheSize = maxSolutions;
+  itsPrefetch = prefetchNext;
+  while (itsCache.size() > itsCacheSize) {
+         itsCache.pop_back();
+  }
+}
+
+/// @return number of requests served from the cache (including prefetched solutions)
+size_t TableCalSolutionConstSource::cacheHits() const
+{
+  const boost::lock_guard<boost::mutex> lock(*itsCacheMutex);
+  return itsCacheHits;
+}
+
+/// @return number of requests which required the table to be read
+size_t TableCalSolutionConstSource::cacheMisses() const
+{
+  const boost::lock_guard<boost::mutex> lock(*itsCacheMutex);
+  return itsCacheMisses;
+}
+
+/// @return number of solutions read in background
+size_t TableCalSolutionConstSource::solutionsPrefetched() const
+{
+  const boost::lock_guard<boost::mutex> lock(*itsCacheMutex);
+  return itsSolutionsPrefetched;
+}
+
+/// @brief number of rows in the table
+/// @return number of solutions
+long TableCalSolutionConstSource::numberOfSolutions() const
+{
+  const boost::lock_guard<boost::mutex> lock(*itsTableMutex);
+  return static_cast<long>(table().nrow());
+}
+
+/// @brief pick up rows added by another process
+/// @details Nothing is done for tables open for writing (rows are added by this process).
+void TableCalSolutionConstSource::resyncTable() const
+{
+  const boost::lock_guard<boost::mutex> lock(*itsTableMutex);
+  if (!table().isWritable()) {
+      table().resync();
+  }
+}
+
+/// @brief wait for a solution newer than the given one
+/// @details The writer (TableCalSolutionSource) updates the sequence file inside the table
+/// directory after each flush (see CalSolutionSequenceFile). This method waits for the file
+/// to announce a new solution and only then resynchronises the table, so waiting consumers
+/// don't access the table on the shared file system. Tables without the sequence file (e.g.
+/// written by other tools) are resynchronised at the change poll interval instead.
+/// @param[in] lastID ID of the most recent solution known to the caller
+/// @param[in] timeout maximum time to wait (in seconds)
+/// @return ID of the most recent solution, it doesn't exceed lastID if the timeout has expired
+long TableCalSolutionConstSource::waitForNewSolution(const long lastID, const double timeout) const
+{
+  const boost::chrono::steady_clock::time_point deadline = boost::chrono::steady_clock::now() +
+        boost::chrono::duration_cast<boost::chrono::steady_clock::duration>(boost::chrono::duration<double>(timeout));
+  const CalSolutionSequenceFile sequenceFile(solutionKey(0, 0));
+  CalSolutionSequenceFile::State state = sequenceFile.read();
+  while (true) {
+         // zero sequence means there is no sequence file, the table has to be checked then
+         if ((state.itsSequence == 0) || (state.itsNSolutions - 1 > lastID)) {
+             resyncTable();
+             const long id = mostRecentSolution();
+             if (id > lastID) {
+                 return id;
+             }
+         }
+         const double remaining = boost::chrono::duration<double>(deadline - boost::chrono::steady_clock::now()).count();
+         if (remaining <= 0.) {
+             return mostRecentSolution();
+         }
+         state = sequenceFile.waitForChange(state.itsSequence, state.itsSequence == 0 ?
+                      std::min(remaining, itsChangePollInterval) : remaining, itsChangePollInterval);
+  }
+}
+
+/// @brief set the interval of the checks for new solutions
+/// @details While waiting for a new solution, change notifications are used where the file
+/// system delivers them. The sequence file is also checked at this interval, because
+/// notifications are not delivered for changes made on other hosts.
+/// @param[in] interval time between checks (in seconds)
+void TableCalSolutionConstSource::setChangePollInterval(double interval)
+{
+  ASKAPCHECK(interval > 0., "Poll interval is supposed to be positive, you have "<<interval);
+  itsChangePollInterval = interval;
+}
+
+/// @brief string identifying the table and selection
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range, zero means all channels
+/// @return key used for the cache and shared memory segments
+std::string TableCalSolutionConstSource::solutionKey(const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+  const boost::lock_guard<boost::mutex> lock(*itsTableMutex);
+  if (nChan == 0) {
+      return table().tableName();
+  }
+  std::ostringstream key;
+  key<<table().tableName()<<":"<<startChan<<":"<<nChan;
+  return key.str();
+}
+
+/// @brief set up the accessor reading the given solution from the table
+/// @param[in] id solution ID
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range, zero means all channels
+/// @return shared pointer to an accessor object
+boost::shared_ptr<MemCalSolutionAccessor> TableCalSolutionConstSource::readSolution(const long id,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+  boost::shared_ptr<TableCalSolutionFiller> filler;
+  {
+    const boost::lock_guard<boost::mutex> lock(*itsTableMutex);
+    filler.reset(new TableCalSolutionFiller(table(),id));
+  }
+  ASKAPDEBUGASSERT(filler);
+  if (nChan > 0) {
+      filler->setChannelRange(startChan, nChan);
+  }
+  if (itsPrefetch) {
+      filler->setLock(itsTableMutex);
+  }
+  return makeAccessor(filler, solutionKey(startChan, nChan), id);
+}
+
+/// @brief obtain accessor using the cache if enabled
+/// @param[in] id solution ID
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range, zero means all channels
+/// @return shared pointer to an accessor object
+boost::shared_ptr<ICalSolutionConstAccessor> TableCalSolutionConstSource::getAccessor(const long id,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const
+{
+  if (itsCacheSize == 0) {
+      return readSolution(id, startChan, nChan);
+  }
+  const std::string key = solutionKey(startChan, nChan);
+  boost::shared_ptr<ICalSolutionConstAccessor> result;
+  for (int attempt = 0; attempt < 2 && !result; ++attempt) {
+       if (attempt > 0) {
+           // the solution may be being read in background
+           waitForPrefetch();
+       }
+       const boost::lock_guard<boost::mutex> lock(*itsCacheMutex);
+       const std::list<CachedSolution>::iterator it = findInCache(key, id);
+       if (it != itsCache.end()) {
+           // make it the most recently used solution
+           itsCache.splice(itsCache.begin(), itsCache, it);
+           result = it->itsAccessor;
+           ++itsCacheHits;
+           DataAccessStatistics::countHit("TableCalSolutionConstSource::getAccessor");
+       }
+  }
+  if (!result) {
+      result = readSolution(id, startChan, nChan);
+      const boost::lock_guard<boost::mutex> lock(*itsCacheMutex);
+      addToCache(key, id, result);
+      ++itsCacheMisses;
+      DataAccessStatistics::countMiss("TableCalSolutionConstSource::getAccessor");
+  }
+  if (itsPrefetch) {
+      startPrefetch(id + 1, startChan, nChan);
+  }
+  return result;
+}
+
+/// @brief find the solution in the cache
+/// @details The cache mutex should be locked by the caller.
+/// @param[in] key string identifying the table and selection
+/// @param[in] id solution ID
+/// @return iterator to the cache entry or the end iterator if the solution is not cached
+std::list<TableCalSolutionConstSource::CachedSolution>::iterator TableCalSolutionConstSource::findInCache(const std::string &key,
+                   const long id) const
+{
+  std::list<CachedSolution>::iterator it = itsCache.begin();
+  for (; it != itsCache.end(); ++it) {
+       if ((it->itsID == id) && (it->itsKey == key)) {
+           break;
+       }
+  }
+  return it;
+}
+
+/// @brief add the solution to the cache
+/// @details The solution becomes the most recently used one, the least recently used
+/// solutions are dropped if necessary. The cache mutex should be locked by the caller.
+/// @param[in] key string identifying the table and selection
+/// @param[in] id solution ID
+/// @param[in] acc accessor
+void TableCalSolutionConstSource::addToCache(const std::string &key, const long id,
+                   const boost::shared_ptr<ICalSolutionConstAccessor> &acc) const
+{
+  CachedSolution entry;
+  entry.itsKey = key;
+  entry.itsID = id;
+  entry.itsAccessor = acc;
+  itsCache.push_front(entry);
+  while (itsCache.size() > itsCacheSize) {
+         itsCache.pop_back();
+  }
+}
+
+/// @brief start reading the given solution in background
+/// @details Nothing is done if the solution doesn't exist, is already cached or the
+/// previous background read hasn't finished yet.
+/// @param[in] id solution ID
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range, zero means all channels
+void TableCalSolutionConstSource::startPrefetch(const long id, const casacore::uInt startChan,
+                   const casacore::uInt nChan) const
+{
+  if (id >= numberOfSolutions()) {
+      return;
+  }
+  {
+    const boost::lock_guard<boost::mutex> lock(*itsCacheMutex);
+    if (findInCache(solutionKey(startChan, nChan), id) != itsCache.end()) {
+        return;
+    }
+  }
+  if (itsPrefetchThread) {
+      if (!itsPrefetchThread->try_join_for(boost::chrono::milliseconds(0))) {
+          return;
+      }
+      itsPrefetchThread.reset();
+  }
+  itsPrefetchThread.reset(new boost::thread(boost::bind(&TableCalSolutionConstSource::prefetchSolution,
+                          this, id, startChan, nChan)));
+}
+
+/// @brief body of the background thread reading the solution
+/// @details Errors are ignored, the solution will be read again when requested.
+/// @param[in] id solution ID
+/// @param[in] startChan first channel of the range
+/// @param[in] nChan number of channels in the range, zero means all channels
+void TableCalSolutionConstSource::prefetchSolution(const long id, const casacore::uInt startChan,
+                   const casacore::uInt nChan) const
+{
+  try {
+     const boost::shared_ptr<MemCalSolutionAccessor> acc = readSolution(id, startChan, nChan);
+     ASKAPDEBUGASSERT(acc);
+     acc->prefetch();
+     const std::string key = solutionKey(startChan, nChan);
+     const boost::lock_guard<boost::mutex> lock(*itsCacheMutex);
+     if (findInCache(key, id) == itsCache.end()) {
+         addToCache(key, id, acc);
+         ++itsSolutionsPrefetched;
+     }
+  }
+  catch (const std::exception &ex) {
+     ASKAPLOG_DEBUG_STR(logger, "Unable to read calibration solution "<<id<<" in background: "<<ex.what());
+  }
+}
+
+/// @brief wait until the background read finishes
+void TableCalSolutionConstSource::waitForPrefetch() const
+{
+  if (itsPrefetchThread) {
+      itsPrefetchThread->join();
+      itsPrefetchThread.reset();
+  }
+}
+
 /// @brief check that the table exists and can be opened
 /// @details This is a helper method which tries to open a given table
 /// to determine whether it exists and can be used. It catches the exception and
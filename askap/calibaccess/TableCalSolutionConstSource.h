@@ -35,6 +35,7 @@
 
 // own includes
 #include <askap/calibaccess/ICalSolutionConstSource.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
 #include <askap/dataaccess/TableHolder.h>
 
 // casa includes
@@ -42,9 +43,12 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
 
 // std includes
 #include <string>
+#include <list>
 
 namespace askap {
 
@@ -71,6 +75,9 @@ public:
   /// @param[in] name table file name
   TableCalSolutionConstSource(const std::string &name);
 
+  /// @brief destructor, waits for the background read to finish
+  virtual ~TableCalSolutionConstSource();
+
   // virtual methods of the interface
 
   /// @brief obtain ID for the most recent solution
@@ -109,6 +116,65 @@ public:
   /// @return shared pointer to an accessor object
   virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolution(const long id) const override;
 
+  /// @brief obtain read-only accessor for a given solution ID and a range of channels
+  /// @details Only the given range of channels is read from the bandpass and bandpass leakage
+  /// cells, the channel index passed to the accessor is counted from startChan.
+  /// @param[in] id solution ID to read
+  /// @param[in] startChan first channel of the range
+  /// @param[in] nChan number of channels in the range
+  /// @return shared pointer to an accessor object
+  virtual boost::shared_ptr<ICalSolutionConstAccessor> roSolutionForChannels(const long id,
+                   const casacore::uInt startChan, const casacore::uInt nChan) const override;
+
+  /// @brief wait for a solution newer than the given one
+  /// @details The writer (TableCalSolutionSource) updates the sequence file inside the table
+  /// directory after each flush (see CalSolutionSequenceFile). This method waits for the file
+  /// to announce a new solution and only then resynchronises the table, so waiting consumers
+  /// don't access the table on the shared file system. Tables without the sequence file (e.g.
+  /// written by other tools) are resynchronised at the change poll interval instead.
+  /// @param[in] lastID ID of the most recent solution known to the caller
+  /// @param[in] timeout maximum time to wait (in seconds)
+  /// @return ID of the most recent solution, it doesn't exceed lastID if the timeout has expired
+  virtual long waitForNewSolution(const long lastID, const double timeout) const override;
+
+  /// @brief set the interval of the checks for new solutions
+  /// @details While waiting for a new solution, change notifications are used where the file
+  /// system delivers them. The sequence file is also checked at this interval, because
+  /// notifications are not delivered for changes made on other hosts.
+  /// @param[in] interval time between checks (in seconds)
+  void setChangePollInterval(double interval);
+
+  /// @brief share solutions between processes on the same node
+  /// @details If enabled, solutions are read through SharedMemCalSolutionFiller, so only
+  /// one process on the node reads a given solution from the table and all others map it
+  /// read-only from shared memory. This is intended for tables which are not modified
+  /// while they are being read.
+  /// @param[in] share true to share solutions, false to read them in each process
+  /// @param[in] timeout maximum time (in seconds) to wait for another process to read the solution
+  void shareSolutions(bool share = true, double timeout = 60.);
+
+  /// @brief keep recently used solutions in memory
+  /// @details By default, a new accessor is created and the table is read every time a solution
+  /// is requested. If the cache is enabled, accessors for up to the given number of solutions are
+  /// kept and returned again if the same solution (and the same range of channels) is requested,
+  /// the least recently used solution is dropped when the cache is full. If prefetching is enabled,
+  /// the solution following the requested one is read in a background thread, which suits the
+  /// time-ordered iteration. This is intended for tables which are not modified while they are
+  /// being read.
+  /// @param[in] maxSolutions maximum number of solutions to keep, zero disables the cache
+  /// @param[in] prefetchNext if true, the next solution is read in background (requires
+  ///            room for at least two solutions)
+  void cacheSolutions(size_t maxSolutions, bool prefetchNext = false);
+
+  /// @return number of requests served from the cache (including prefetched solutions)
+  size_t cacheHits() const;
+
+  /// @return number of requests which required the table to be read
+  size_t cacheMisses() const;
+
+  /// @return number of solutions read in background
+  size_t solutionsPrefetched() const;
+
   /// @brief shared pointer definition
   typedef boost::shared_ptr<TableCalSolutionConstSource> ShPtr;
 
@@ -119,6 +185,125 @@ public:
   /// @param[in] fname file name of the table to test
   /// @return true, if table exists and is useable, false otherwise
   static bool tableExists(const std::string &fname);
+
+private:
+  /// @brief set up the accessor for the given filler
+  /// @details The filler is wrapped into SharedMemCalSolutionFiller if solutions are shared
+  /// @param[in] filler filler to read the solution
+  /// @param[in] key string identifying the table and selection
+  /// @param[in] id solution ID
+  /// @return shared pointer to an accessor object
+  boost::shared_ptr<MemCalSolutionAccessor> makeAccessor(const boost::shared_ptr<ICalSolutionFiller> &filler,
+                   const std::string &key, const long id) const;
+
+  /// @brief solution kept in the cache
+  struct CachedSolution {
+     /// @brief string identifying the table and selection
+     std::string itsKey;
+     /// @brief solution ID
+     long itsID;
+     /// @brief accessor
+     boost::shared_ptr<ICalSolutionConstAccessor> itsAccessor;
+  };
+
+  /// @brief number of rows in the table
+  /// @return number of solutions
+  long numberOfSolutions() const;
+
+  /// @brief pick up rows added by another process
+  /// @details Nothing is done for tables open for writing (rows are added by this process).
+  void resyncTable() const;
+
+  /// @brief obtain accessor using the cache if enabled
+  /// @param[in] id solution ID
+  /// @param[in] startChan first channel of the range
+  /// @param[in] nChan number of channels in the range, zero means all channels
+  /// @return shared pointer to an accessor object
+  boost::shared_ptr<ICalSolutionConstAccessor> getAccessor(const long id, const casacore::uInt startChan,
+                   const casacore::uInt nChan) const;
+
+  /// @brief set up the accessor reading the given solution from the table
+  /// @param[in] id solution ID
+  /// @param[in] startChan first channel of the range
+  /// @param[in] nChan number of channels in the range, zero means all channels
+  /// @return shared pointer to an accessor object
+  boost::shared_ptr<MemCalSolutionAccessor> readSolution(const long id, const casacore::uInt startChan,
+                   const casacore::uInt nChan) const;
+
+  /// @brief string identifying the table and selection
+  /// @param[in] startChan first channel of the range
+  /// @param[in] nChan number of channels in the range, zero means all channels
+  /// @return key used for the cache and shared memory segments
+  std::string solutionKey(const casacore::uInt startChan, const casacore::uInt nChan) const;
+
+  /// @brief find the solution in the cache
+  /// @details The cache mutex should be locked by the caller.
+  /// @param[in] key string identifying the table and selection
+  /// @param[in] id solution ID
+  /// @return iterator to the cache entry or the end iterator if the solution is not cached
+  std::list<CachedSolution>::iterator findInCache(const std::string &key, const long id) const;
+
+  /// @brief add the solution to the cache
+  /// @details The solution becomes the most recently used one, the least recently used
+  /// solutions are dropped if necessary. The cache mutex should be locked by the caller.
+  /// @param[in] key string identifying the table and selection
+  /// @param[in] id solution ID
+  /// @param[in] acc accessor
+  void addToCache(const std::string &key, const long id, const boost::shared_ptr<ICalSolutionConstAccessor> &acc) const;
+
+  /// @brief start reading the given solution in background
+  /// @details Nothing is done if the solution doesn't exist, is already cached or the
+  /// previous background read hasn't finished yet.
+  /// @param[in] id solution ID
+  /// @param[in] startChan first channel of the range
+  /// @param[in] nChan number of channels in the range, zero means all channels
+  void startPrefetch(const long id, const casacore::uInt startChan, const casacore::uInt nChan) const;
+
+  /// @brief body of the background thread reading the solution
+  /// @details Errors are ignored, the solution will be read again when requested.
+  /// @param[in] id solution ID
+  /// @param[in] startChan first channel of the range
+  /// @param[in] nChan number of channels in the range, zero means all channels
+  void prefetchSolution(const long id, const casacore::uInt startChan, const casacore::uInt nChan) const;
+
+  /// @brief wait until the background read finishes
+  void waitForPrefetch() const;
+
+  /// @brief true, if solutions are shared between processes on the same node
+  bool itsShareSolutions;
+
+  /// @brief maximum time to wait for another process to read the solution (in seconds)
+  double itsShareTimeout;
+
+  /// @brief maximum number of cached solutions, zero means no caching
+  size_t itsCacheSize;
+
+  /// @brief true, if the next solution is to be read in background
+  bool itsPrefetch;
+
+  /// @brief time between checks for new solutions while waiting (in seconds)
+  double itsChangePollInterval;
+
+  /// @brief cached solutions, the most recently used first
+  mutable std::list<CachedSolution> itsCache;
+
+  /// @brief mutex guarding the cache and the statistics
+  boost::shared_ptr<boost::mutex> itsCacheMutex;
+
+  /// @brief mutex guarding table access (shared with the fillers)
+  boost::shared_ptr<boost::mutex> itsTableMutex;
+
+  /// @brief background thread reading the next solution
+  mutable boost::shared_ptr<boost::thread> itsPrefetchThread;
+
+  /// @brief number of requests served from the cache
+  mutable size_t itsCacheHits;
+
+  /// @brief number of requests which required the table to be read
+  mutable size_t itsCacheMisses;
+
+  /// @brief number of solutions read in background
+  mutable size_t itsSolutionsPrefetched;
 };
 
 
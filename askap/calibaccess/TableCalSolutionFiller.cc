@@ -36,18 +36,37 @@
 /// @author Max Voronkov <Maxim.Voronkov@csiro.au>
 
 #include <map>
+#include <algorithm>
 #include <askap/calibaccess/TableCalSolutionFiller.h>
+#include <askap/calibaccess/CalSolutionSequenceFile.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/dataaccess/IORecorder.h>
+
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/Slice.h>
 
 namespace askap {
 
 namespace accessors {
 
+namespace {
+
+/// @brief size of the solution cubes
+/// @param[in] cubes pair of cubes with values and validity flags
+/// @return number of bytes in both cubes
+size_t cubeBytes(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes)
+{
+  return cubes.first.nelements() * sizeof(casacore::Complex) + cubes.second.nelements() * sizeof(casacore::Bool);
+}
+
+} // anonymous namespace
+
 /// @brief construct the object and link it to the given table
 /// @details read-only operation is assumed
 /// @param[in] tab  table to use
 /// @param[in] row reference row
 TableCalSolutionFiller::TableCalSolutionFiller(const casa::Table& tab, const long row) : TableHolder(tab),
-       TableBufferManager(tab), itsNAnt(0), itsNBeam(0), itsNChan(0), itsRefRow(row), itsGainsRow(-1),
+       TableBufferManager(tab), itsNAnt(0), itsNBeam(0), itsNChan(0), itsStartChan(0), itsChanRange(0), itsRefRow(row), itsGainsRow(-1),
        itsLeakagesRow(-1), itsBandpassesRow(-1), itsBPLeakagesRow(-1), itsIonoParamsRow(-1)
 {
   ASKAPCHECK((itsRefRow >= 0) && (itsRefRow <= static_cast<long>(table().nrow())), "Requested calibration solution ID = "<<itsRefRow<<" is outside calibration table");
@@ -65,9 +84,11 @@ TableCalSolutionFiller::TableCalSolutionFiller(const casa::Table& tab, const lon
 /// @param[in] nAnt maximum number of antennas
 /// @param[in] nBeam maximum number of beams
 /// @param[in] nChan maximum number of channels
+/// @param[in] maxTileSize maximum tile size in bytes for new columns, zero means the
+/// default storage manager is used (see TableBufferManager::addBufferColumn)
 TableCalSolutionFiller::TableCalSolutionFiller(const casa::Table& tab, const long row, const casa::uInt nAnt,
-          const casa::uInt nBeam, const casa::uInt nChan) : TableHolder(tab),
-       TableBufferManager(tab), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan), itsRefRow(row), itsGainsRow(-1),
+          const casa::uInt nBeam, const casa::uInt nChan, const size_t maxTileSize) : TableHolder(tab),
+       TableBufferManager(tab, maxTileSize), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan), itsStartChan(0), itsChanRange(0), itsRefRow(row), itsGainsRow(-1),
        itsLeakagesRow(-1), itsBandpassesRow(-1), itsBPLeakagesRow(-1), itsIonoParamsRow(-1)
 {
   ASKAPCHECK((itsRefRow >= 0) && (itsRefRow <= static_cast<long>(table().nrow())), "Requested calibration solution ID = "<<itsRefRow<<" is outside calibration table");
@@ -89,6 +110,86 @@ bool TableCalSolutionFiller::isReadOnly() const
    return (itsNAnt == 0);
 }
 
+/// @brief restrict bandpass reading to a range of channels
+/// @details Only the given range of channels is read from the BANDPASS and BPLEAKAGE
+/// cells (and their validity flags), so the cubes are (2*nChan) x nAnt x nBeam with
+/// the channel counted from startChan. The range is truncated at the end of the stored
+/// spectrum. This is only allowed for read-only operations.
+/// @param[in] startChan first channel to read
+/// @param[in] nChan number of channels to read
+void TableCalSolutionFiller::setChannelRange(const casacore::uInt startChan, const casacore::uInt nChan)
+{
+  ASKAPCHECK(isReadOnly(), "Channel range can only be selected for read-only access to the calibration table");
+  ASKAPCHECK(nChan > 0, "At least one channel is expected to be selected");
+  ASKAPCHECK((itsBandpassesRow < 0) && (itsBPLeakagesRow < 0), "Channel range has to be set before bandpasses are read");
+  itsStartChan = startChan;
+  itsChanRange = nChan;
+}
+
+/// @brief set the lock guarding table access
+/// @details casa tables can't be read from different threads at the same time. If the
+/// same table is accessed by other threads, all fill methods of this class lock the given mutex.
+/// @param[in] mutex shared pointer to the mutex, empty pointer means no locking
+void TableCalSolutionFiller::setLock(const boost::shared_ptr<boost::mutex> &mutex)
+{
+  itsLock = mutex;
+}
+
+/// @brief set the batch of deferred flushes
+/// @param[in] batch shared pointer to the batch, empty pointer means flush is done every time
+void TableCalSolutionFiller::setFlushBatch(const boost::shared_ptr<FlushBatch> &batch)
+{
+  itsFlushBatch = batch;
+}
+
+/// @brief flush the table to disk
+/// @details If the batch of deferred flushes is set, the table is only flushed when
+/// the batch is full.
+/// @return true, if the table has been flushed
+bool TableCalSolutionFiller::flush()
+{
+  if (itsFlushBatch) {
+      if (++itsFlushBatch->itsPending < itsFlushBatch->itsSize) {
+          return false;
+      }
+      itsFlushBatch->itsPending = 0;
+  }
+  DataAccessStatistics::ScopedTimer timer("TableCalSolutionFiller::flush");
+  table().flush();
+  CalSolutionSequenceFile::announce(table());
+  return true;
+}
+
+/// @brief lock the table, if the lock is set
+/// @return lock object (doesn't own a mutex if the lock is not set)
+boost::unique_lock<boost::mutex> TableCalSolutionFiller::tableLock() const
+{
+  return itsLock ? boost::unique_lock<boost::mutex>(*itsLock) : boost::unique_lock<boost::mutex>();
+}
+
+/// @brief read bandpass-like cubes for the selected range of channels
+/// @details Only the rows of the stored cubes corresponding to the channel range set by
+/// setChannelRange are read.
+/// @param[in] cubes pair of cubes with values and validity flags (resized as necessary)
+/// @param[in] name name of the column with values (validity flags are in name+"_VALID")
+/// @param[in] row table row to read
+void TableCalSolutionFiller::readChannelRange(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                        const std::string &name, const long row) const
+{
+  ASKAPDEBUGASSERT(itsChanRange > 0);
+  ASKAPDEBUGASSERT(row >= 0);
+  const casacore::IPosition shape = casacore::ROArrayColumn<casacore::Complex>(table(), name).shape(static_cast<casacore::rownr_t>(row));
+  ASKAPCHECK(shape.nelements() == 3, "Wrong format of the calibration table: "<<name<<" is expected to contain cubes");
+  const casacore::uInt nStoredChan = casacore::uInt(shape[0]) / 2;
+  ASKAPCHECK(itsStartChan < nStoredChan, "Requested start channel "<<itsStartChan<<" is outside the "<<name<<
+             " solution with "<<nStoredChan<<" channels");
+  const casacore::uInt nChan = std::min(itsChanRange, nStoredChan - itsStartChan);
+  cubes.first.resize(2 * nChan, shape[1], shape[2]);
+  cubes.second.resize(2 * nChan, shape[1], shape[2]);
+  readCubeRows(cubes.first, name, static_cast<casacore::rownr_t>(row), 2 * itsStartChan);
+  readCubeRows(cubes.second, name + "_VALID", static_cast<casacore::rownr_t>(row), 2 * itsStartChan);
+}
+
 /// @brief check for gain solution
 /// @return true, if there is no gain solution, false otherwise
 bool TableCalSolutionFiller::noGain() const
@@ -144,6 +245,8 @@ bool TableCalSolutionFiller::columnExists(const std::string &name) const
 /// @param[in] gains pair of cubes with gains and validity flags (to be resised to 2 x nAnt x nBeam)
 void TableCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &gains) const
 {
+  DataAccessStatistics::ScopedTimer timer("TableCalSolutionFiller::fillGains");
+  const boost::unique_lock<boost::mutex> lock = tableLock();
   // cellDefined should not be called if noGain returns true according to C++ evaluation rules.
   const bool needToCreateGains = noGain() || !cellDefined<casa::Complex>("GAIN", static_cast<casacore::rownr_t>(itsRefRow));
   if (!isReadOnly() && needToCreateGains) {
@@ -160,6 +263,8 @@ void TableCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Comple
          itsGainsRow = findDefinedCube("GAIN");
      }
      ASKAPASSERT(itsGainsRow>=0);
+     IORecorder::ScopedEvent ioEvent(IORecorder::CAL_FETCH);
+     ioEvent.setRows(table(), "GAIN", static_cast<casacore::rownr_t>(itsGainsRow), 1);
      if (itsGainsRow != itsRefRow) {
          // backwards search should only be possible in the read-only mode
          ASKAPDEBUGASSERT(isReadOnly());
@@ -169,6 +274,8 @@ void TableCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Comple
          "Wrong format of the calibration table: GAIN element should always be accompanied by GAIN_VALID");
      readCube(gains.first, "GAIN", static_cast<casacore::rownr_t>(itsGainsRow));
      readCube(gains.second, "GAIN_VALID", static_cast<casacore::rownr_t>(itsGainsRow));
+     timer.addBytes(cubeBytes(gains));
+     ioEvent.addBytes(cubeBytes(gains));
   }
   ASKAPCHECK(gains.first.shape() == gains.second.shape(), "GAIN and GAIN_VALID cubes are expected to have the same shape");
 }
@@ -178,6 +285,8 @@ void TableCalSolutionFiller::fillGains(std::pair<casacore::Cube<casacore::Comple
 /// @param[in] leakages pair of cubes with leakages and validity flags (to be resised to 2 x nAnt x nBeam)
 void TableCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &leakages) const
 {
+  DataAccessStatistics::ScopedTimer timer("TableCalSolutionFiller::fillLeakages");
+  const boost::unique_lock<boost::mutex> lock = tableLock();
   // cellDefined should not be called if noLeakage returns true according to C++ evaluation rules.
   const bool needToCreateLeakage = noLeakage() || !cellDefined<casa::Complex>("LEAKAGE", static_cast<casacore::rownr_t>(itsRefRow));
   if (!isReadOnly() && needToCreateLeakage) {
@@ -193,6 +302,8 @@ void TableCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Com
          itsLeakagesRow = findDefinedCube("LEAKAGE");
      }
      ASKAPASSERT(itsLeakagesRow>=0);
+     IORecorder::ScopedEvent ioEvent(IORecorder::CAL_FETCH);
+     ioEvent.setRows(table(), "LEAKAGE", static_cast<casacore::rownr_t>(itsLeakagesRow), 1);
      if (itsLeakagesRow != itsRefRow) {
          // backwards search should only be possible in the read-only mode
          ASKAPDEBUGASSERT(isReadOnly());
@@ -202,6 +313,8 @@ void TableCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Com
          "Wrong format of the calibration table: LEAKAGE element should always be accompanied by LEAKAGE_VALID");
      readCube(leakages.first, "LEAKAGE", static_cast<casacore::rownr_t>(itsLeakagesRow));
      readCube(leakages.second, "LEAKAGE_VALID", static_cast<casacore::rownr_t>(itsLeakagesRow));
+     timer.addBytes(cubeBytes(leakages));
+     ioEvent.addBytes(cubeBytes(leakages));
   }
   ASKAPCHECK(leakages.first.shape() == leakages.second.shape(), "LEAKAGE and LEAKAGE_VALID cubes are expected to have the same shape");
 }
@@ -211,6 +324,8 @@ void TableCalSolutionFiller::fillLeakages(std::pair<casacore::Cube<casacore::Com
 /// @param[in] bp pair of cubes with bandpasses and validity flags (to be resised to (2*nChan) x nAnt x nBeam)
 void TableCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp) const
 {
+  DataAccessStatistics::ScopedTimer timer("TableCalSolutionFiller::fillBandpasses");
+  const boost::unique_lock<boost::mutex> lock = tableLock();
   // cellDefined should not be called if noBandpass returns true according to C++ evaluation rules.
   const bool needToCreateBandpass = noBandpass() || !cellDefined<casa::Complex>("BANDPASS", static_cast<casacore::rownr_t>(itsRefRow));
   if (!isReadOnly() && needToCreateBandpass) {
@@ -226,6 +341,11 @@ void TableCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::C
          itsBandpassesRow = findDefinedCube("BANDPASS");
      }
      ASKAPASSERT(itsBandpassesRow>=0);
+     IORecorder::ScopedEvent ioEvent(IORecorder::CAL_FETCH);
+     ioEvent.setRows(table(), "BANDPASS", static_cast<casacore::rownr_t>(itsBandpassesRow), 1);
+     if (itsChanRange > 0) {
+         ioEvent.setChannels(itsStartChan, itsChanRange);
+     }
      if (itsBandpassesRow != itsRefRow) {
          // backwards search should only be possible in the read-only mode
          ASKAPDEBUGASSERT(isReadOnly());
@@ -233,8 +353,14 @@ void TableCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::C
      }
      ASKAPCHECK(cellDefined<casa::Bool>("BANDPASS_VALID", static_cast<casacore::rownr_t>(itsBandpassesRow)),
          "Wrong format of the calibration table: BANDPASS element should always be accompanied by BANDPASS_VALID");
-     readCube(bp.first, "BANDPASS", static_cast<casacore::rownr_t>(itsBandpassesRow));
-     readCube(bp.second, "BANDPASS_VALID", static_cast<casacore::rownr_t>(itsBandpassesRow));
+     if (itsChanRange > 0) {
+         readChannelRange(bp, "BANDPASS", itsBandpassesRow);
+     } else {
+         readCube(bp.first, "BANDPASS", static_cast<casacore::rownr_t>(itsBandpassesRow));
+         readCube(bp.second, "BANDPASS_VALID", static_cast<casacore::rownr_t>(itsBandpassesRow));
+     }
+     timer.addBytes(cubeBytes(bp));
+     ioEvent.addBytes(cubeBytes(bp));
   }
   ASKAPCHECK(bp.first.shape() == bp.second.shape(), "BANDPASS and BANDPASS_VALID cubes are expected to have the same shape");
 }
@@ -244,6 +370,8 @@ void TableCalSolutionFiller::fillBandpasses(std::pair<casacore::Cube<casacore::C
 /// @param[in] bp pair of cubes with bandpasses and validity flags (to be resized to (2*nChan) x nAnt x nBeam)
 void TableCalSolutionFiller::fillBPLeakages(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages) const
 {
+  DataAccessStatistics::ScopedTimer timer("TableCalSolutionFiller::fillBPLeakages");
+  const boost::unique_lock<boost::mutex> lock = tableLock();
   // cellDefined should not be called if noBPLeakage returns true according to C++ evaluation rules.
   const bool needToCreateBPLeakage = noBPLeakage() || !cellDefined<casa::Complex>("BPLEAKAGE", static_cast<casacore::rownr_t>(itsRefRow));
   if (!isReadOnly() && needToCreateBPLeakage) {
@@ -259,6 +387,11 @@ void TableCalSolutionFiller::fillBPLeakages(std::pair<casacore::Cube<casacore::C
          itsBPLeakagesRow = findDefinedCube("BPLEAKAGE");
      }
      ASKAPASSERT(itsBPLeakagesRow>=0);
+     IORecorder::ScopedEvent ioEvent(IORecorder::CAL_FETCH);
+     ioEvent.setRows(table(), "BPLEAKAGE", static_cast<casacore::rownr_t>(itsBPLeakagesRow), 1);
+     if (itsChanRange > 0) {
+         ioEvent.setChannels(itsStartChan, itsChanRange);
+     }
      if (itsBPLeakagesRow != itsRefRow) {
          // backwards search should only be possible in the read-only mode
          ASKAPDEBUGASSERT(isReadOnly());
@@ -266,8 +399,14 @@ void TableCalSolutionFiller::fillBPLeakages(std::pair<casacore::Cube<casacore::C
      }
      ASKAPCHECK(cellDefined<casa::Bool>("BPLEAKAGE_VALID", static_cast<casacore::rownr_t>(itsBPLeakagesRow)),
          "Wrong format of the calibration table: BPLEAKAGE element should always be accompanied by BPLEAKAGE_VALID");
-     readCube(bpleakages.first, "BPLEAKAGE", static_cast<casacore::rownr_t>(itsBPLeakagesRow));
-     readCube(bpleakages.second, "BPLEAKAGE_VALID", static_cast<casacore::rownr_t>(itsBPLeakagesRow));
+     if (itsChanRange > 0) {
+         readChannelRange(bpleakages, "BPLEAKAGE", itsBPLeakagesRow);
+     } else {
+         readCube(bpleakages.first, "BPLEAKAGE", static_cast<casacore::rownr_t>(itsBPLeakagesRow));
+         readCube(bpleakages.second, "BPLEAKAGE_VALID", static_cast<casacore::rownr_t>(itsBPLeakagesRow));
+     }
+     timer.addBytes(cubeBytes(bpleakages));
+     ioEvent.addBytes(cubeBytes(bpleakages));
   }
   ASKAPCHECK(bpleakages.first.shape() == bpleakages.second.shape(), "BPLEAKAGE and BPLEAKAGE_VALID cubes are expected to have the same shape");
 }
@@ -278,6 +417,8 @@ void TableCalSolutionFiller::fillBPLeakages(std::pair<casacore::Cube<casacore::C
 void TableCalSolutionFiller::fillIonoParams(std::pair<casacore::Cube<casacore::Complex>,
                                                       casacore::Cube<casacore::Bool> > &params) const
 {
+  DataAccessStatistics::ScopedTimer timer("TableCalSolutionFiller::fillIonoParams");
+  const boost::unique_lock<boost::mutex> lock = tableLock();
   // cellDefined should not be called if noIonosphere returns true according to C++ evaluation rules.
   const bool needToCreateIono = noIonosphere() || !cellDefined<casa::Complex>("IONOSPHERE", static_cast<casacore::rownr_t>(itsRefRow));
   if (!isReadOnly() && needToCreateIono) {
@@ -294,6 +435,8 @@ void TableCalSolutionFiller::fillIonoParams(std::pair<casacore::Cube<casacore::C
          itsIonoParamsRow = findDefinedCube("IONOSPHERE");
      }
      ASKAPASSERT(itsIonoParamsRow>=0);
+     IORecorder::ScopedEvent ioEvent(IORecorder::CAL_FETCH);
+     ioEvent.setRows(table(), "IONOSPHERE", static_cast<casacore::rownr_t>(itsIonoParamsRow), 1);
      if (itsIonoParamsRow != itsRefRow) {
          // backwards search should only be possible in the read-only mode
          ASKAPDEBUGASSERT(isReadOnly());
@@ -303,6 +446,8 @@ void TableCalSolutionFiller::fillIonoParams(std::pair<casacore::Cube<casacore::C
          "Wrong format of the calibration table: IONOSPHERE element should always be accompanied by IONOSPHERE_VALID");
      readCube(params.first, "IONOSPHERE", static_cast<casacore::rownr_t>(itsIonoParamsRow));
      readCube(params.second, "IONOSPHERE_VALID", static_cast<casacore::rownr_t>(itsIonoParamsRow));
+     timer.addBytes(cubeBytes(params));
+     ioEvent.addBytes(cubeBytes(params));
   }
   ASKAPCHECK(params.first.shape() == params.second.shape(), "IONOSPHERE and IONOSPHERE_VALID cubes are expected to have the same shape");
 }
@@ -362,6 +507,65 @@ void TableCalSolutionFiller::writeIonoParams(const std::pair<casacore::Cube<casa
   writeCube(params.second, "IONOSPHERE_VALID", static_cast<casacore::rownr_t>(itsIonoParamsRow));
 }
 
+/// @brief partial bandpass writer
+/// @details Only the given channels are written if the table cell already exists
+/// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+/// @param[in] startChan first changed channel
+/// @param[in] nChan number of changed channels
+void TableCalSolutionFiller::writeBandpassChannels(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp,
+                                                   casacore::uInt startChan, casacore::uInt nChan) const
+{
+  ASKAPASSERT(itsBandpassesRow>=0);
+  ASKAPCHECK(bp.first.shape() == bp.second.shape(), "The cubes with bandpasses and validity flags are expected to have the same shape");
+  writeChannelRange(bp, "BANDPASS", itsBandpassesRow, startChan, nChan);
+}
+
+/// @brief partial bpleakage writer
+/// @details Only the given channels are written if the table cell already exists
+/// @param[in] bpleakages pair of cubes with bpleakages and validity flags (should be (2*nChan) x nAnt x nBeam)
+/// @param[in] startChan first changed channel
+/// @param[in] nChan number of changed channels
+void TableCalSolutionFiller::writeBPLeakageChannels(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages,
+                                                    casacore::uInt startChan, casacore::uInt nChan) const
+{
+  ASKAPASSERT(itsBPLeakagesRow>=0);
+  ASKAPCHECK(bpleakages.first.shape() == bpleakages.second.shape(), "The cubes with bandpass leakage and validity flags are expected to have the same shape");
+  writeChannelRange(bpleakages, "BPLEAKAGE", itsBPLeakagesRow, startChan, nChan);
+}
+
+/// @brief write bandpass-like cubes for the given range of channels
+/// @details The whole cubes are written if the table cell doesn't exist yet or has a different shape.
+/// @param[in] cubes pair of cubes with values and validity flags
+/// @param[in] name name of the column with values (validity flags are in name+"_VALID")
+/// @param[in] row table row to write
+/// @param[in] startChan first channel to write
+/// @param[in] nChan number of channels to write
+void TableCalSolutionFiller::writeChannelRange(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                         const std::string &name, const long row, const casacore::uInt startChan,
+                         const casacore::uInt nChan) const
+{
+  ASKAPDEBUGASSERT(row >= 0);
+  ASKAPCHECK(2 * (startChan + nChan) <= cubes.first.nrow(), "Channels "<<startChan<<" to "<<startChan + nChan - 1<<
+             " are outside the "<<name<<" cube of shape "<<cubes.first.shape());
+  const casacore::rownr_t index = static_cast<casacore::rownr_t>(row);
+  const std::string validName = name + "_VALID";
+  bool partial = cellDefined<casacore::Complex>(name, index) && cellDefined<casacore::Bool>(validName, index);
+  if (partial) {
+      partial = (casacore::ROArrayColumn<casacore::Complex>(table(), name).shape(index) == cubes.first.shape()) &&
+                (casacore::ROArrayColumn<casacore::Bool>(table(), validName).shape(index) == cubes.second.shape());
+  }
+  if (!partial) {
+      writeCube(cubes.first, name, index);
+      writeCube(cubes.second, validName, index);
+      return;
+  }
+  const casacore::Slice rows(2 * startChan, 2 * nChan);
+  const casacore::Cube<casacore::Complex> values = cubes.first(rows, casacore::Slice(), casacore::Slice());
+  const casacore::Cube<casacore::Bool> flags = cubes.second(rows, casacore::Slice(), casacore::Slice());
+  writeCubeRows(values, name, index, 2 * startChan);
+  writeCubeRows(flags, validName, index, 2 * startChan);
+}
+
 /// @brief find first defined cube searching backwards
 /// @details This assumes that the table rows are given in the time order. If the cell at the reference row
 /// doesn't have a cube defined, the search is continued up to the top of the table. An exception is thrown
@@ -45,6 +45,10 @@
 #include <askap/calibaccess/ICalSolutionFiller.h>
 #include <askap/dataaccess/TableBufferManager.h>
 
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
 // std includes
 #include <string>
 #include <map>
@@ -83,8 +87,46 @@ public:
   /// @param[in] nAnt maximum number of antennas
   /// @param[in] nBeam maximum number of beams
   /// @param[in] nChan maximum number of channels
+  /// @param[in] maxTileSize maximum tile size in bytes for new columns, zero means the
+  /// default storage manager is used (see TableBufferManager::addBufferColumn)
   TableCalSolutionFiller(const casacore::Table& tab, const long row, const casacore::uInt nAnt,
-         const casacore::uInt nBeam, const casacore::uInt nChan);
+         const casacore::uInt nBeam, const casacore::uInt nChan, const size_t maxTileSize = 0);
+
+  /// @brief counter of solutions written but not flushed to disk
+  /// @details Fillers sharing this object flush the table only when the given number of
+  /// solutions have been written, the remaining ones are flushed by the owner (see
+  /// TableCalSolutionSource::flushBatch).
+  struct FlushBatch {
+     /// @brief set up the batch
+     /// @param[in] size number of solutions written before the table is flushed
+     explicit FlushBatch(const casacore::uInt size) : itsSize(size), itsPending(0) {}
+
+     /// @brief number of solutions written before the table is flushed
+     casacore::uInt itsSize;
+
+     /// @brief number of solutions written since the last flush
+     casacore::uInt itsPending;
+  };
+
+  /// @brief set the batch of deferred flushes
+  /// @param[in] batch shared pointer to the batch, empty pointer means flush is done every time
+  void setFlushBatch(const boost::shared_ptr<FlushBatch> &batch);
+
+  /// @brief restrict bandpass reading to a range of channels
+  /// @details Only the given range of channels is read from the BANDPASS and BPLEAKAGE
+  /// cells (and their validity flags), so the cubes are (2*nChan) x nAnt x nBeam with
+  /// the channel counted from startChan. The range is truncated at the end of the stored
+  /// spectrum. This is only allowed for read-only operations.
+  /// @param[in] startChan first channel to read
+  /// @param[in] nChan number of channels to read
+  void setChannelRange(const casacore::uInt startChan, const casacore::uInt nChan);
+
+  /// @brief set the lock guarding table access
+  /// @details casa tables can't be read from different threads at the same time. If the
+  /// same table is accessed by other threads (e.g. to read the next solution in
+  /// background), all fill methods of this class lock the given mutex.
+  /// @param[in] mutex shared pointer to the mutex, empty pointer means no locking
+  void setLock(const boost::shared_ptr<boost::mutex> &mutex);
 
   /// @brief gains filler
   /// @details
@@ -136,6 +178,22 @@ public:
   /// @param[in] pair of cubes with ionospheric parameters and validity flags (should be 1 x nAnt x nBeam)
   virtual void writeIonoParams(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &params) const;
 
+  /// @brief partial bandpass writer
+  /// @details Only the given channels are written if the table cell already exists
+  /// @param[in] bp pair of cubes with bandpasses and validity flags (should be (2*nChan) x nAnt x nBeam)
+  /// @param[in] startChan first changed channel
+  /// @param[in] nChan number of changed channels
+  virtual void writeBandpassChannels(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bp,
+                                     casacore::uInt startChan, casacore::uInt nChan) const;
+
+  /// @brief partial bpleakage writer
+  /// @details Only the given channels are written if the table cell already exists
+  /// @param[in] bpleakages pair of cubes with bpleakages and validity flags (should be (2*nChan) x nAnt x nBeam)
+  /// @param[in] startChan first changed channel
+  /// @param[in] nChan number of changed channels
+  virtual void writeBPLeakageChannels(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &bpleakages,
+                                      casacore::uInt startChan, casacore::uInt nChan) const;
+
   /// @brief check for gain solution
   /// @return true, if there is no gain solution, false otherwise
   virtual bool noGain() const;
@@ -157,7 +215,10 @@ public:
   virtual bool noIonosphere() const;
 
   /// @brief flush the table to disk
-  virtual bool flush() { table().flush(); return true; }
+  /// @details If the batch of deferred flushes is set, the table is only flushed when
+  /// the batch is full.
+  /// @return true, if the table has been flushed
+  virtual bool flush();
 
 private:
 
@@ -181,12 +242,46 @@ private:
   /// @return true if the given column exists
   bool columnExists(const std::string &name) const;
 
+  /// @brief read bandpass-like cubes for the selected range of channels
+  /// @details Only the rows of the stored cubes corresponding to the channel range set by
+  /// setChannelRange are read.
+  /// @param[in] cubes pair of cubes with values and validity flags (resized as necessary)
+  /// @param[in] name name of the column with values (validity flags are in name+"_VALID")
+  /// @param[in] row table row to read
+  void readChannelRange(std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                        const std::string &name, const long row) const;
+
+  /// @brief write bandpass-like cubes for the given range of channels
+  /// @details The whole cubes are written if the table cell doesn't exist yet or has a different shape.
+  /// @param[in] cubes pair of cubes with values and validity flags
+  /// @param[in] name name of the column with values (validity flags are in name+"_VALID")
+  /// @param[in] row table row to write
+  /// @param[in] startChan first channel to write
+  /// @param[in] nChan number of channels to write
+  void writeChannelRange(const std::pair<casacore::Cube<casacore::Complex>, casacore::Cube<casacore::Bool> > &cubes,
+                         const std::string &name, const long row, const casacore::uInt startChan,
+                         const casacore::uInt nChan) const;
+
+  /// @brief lock the table, if the lock is set
+  /// @return lock object (doesn't own a mutex if the lock is not set)
+  boost::unique_lock<boost::mutex> tableLock() const;
+
+  /// @brief mutex guarding table access, may be empty
+  boost::shared_ptr<boost::mutex> itsLock;
+
+  /// @brief batch of deferred flushes, empty if flush is done every time
+  boost::shared_ptr<FlushBatch> itsFlushBatch;
+
   /// @brief number of antennas (used when new solutions are created)
   casacore::uInt itsNAnt;
   /// @brief number of beams (used when new solutions are created)
   casacore::uInt itsNBeam;
   /// @brief number of spectral channels (used when new solutions are created)
   casacore::uInt itsNChan;
+  /// @brief first channel to read from bandpass-like cubes
+  casacore::uInt itsStartChan;
+  /// @brief number of channels to read from bandpass-like cubes, zero means all channels
+  casacore::uInt itsChanRange;
   /// @brief reference row for the selected solution (actual solution will be searched from this row up)
   long itsRefRow;
 
@@ -34,6 +34,7 @@
 #include <askap/calibaccess/TableCalSolutionSource.h>
 #include <askap/calibaccess/TableCalSolutionFiller.h>
 #include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/calibaccess/CalSolutionSequenceFile.h>
 
 // casa includes
 #include <casacore/measures/TableMeasures/TableMeasDesc.h>
@@ -66,7 +67,7 @@ namespace accessors {
 /// @param[in] nChan maximum number of channels
 TableCalSolutionSource::TableCalSolutionSource(const casacore::Table &tab, const casacore::uInt nAnt,
          const casacore::uInt nBeam, const casacore::uInt nChan) : TableHolder(tab),
-   TableCalSolutionConstSource(tab), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan) {}
+   TableCalSolutionConstSource(tab), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan), itsMaxTileSize(0) {}
 
 /// @brief constructor using a file name
 /// @details The table is opened for writing
@@ -76,7 +77,8 @@ TableCalSolutionSource::TableCalSolutionSource(const casacore::Table &tab, const
 /// @param[in] nChan maximum number of channels
 TableCalSolutionSource::TableCalSolutionSource(const std::string &name, const casacore::uInt nAnt,
          const casacore::uInt nBeam, const casacore::uInt nChan) :
-   TableHolder(casacore::Table()), TableCalSolutionConstSource(table()), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan)
+   TableHolder(casacore::Table()), TableCalSolutionConstSource(table()), itsNAnt(nAnt), itsNBeam(nBeam), itsNChan(nChan),
+   itsMaxTileSize(0)
 {
   try {
      table() = casacore::Table(name,casacore::Table::Update);
@@ -94,7 +96,49 @@ TableCalSolutionSource::TableCalSolutionSource(const std::string &name, const ca
   }
 }
 
+/// @brief destructor, flushes the solutions written in the current batch
+TableCalSolutionSource::~TableCalSolutionSource()
+{
+  flushBatch();
+}
+
+/// @brief set up batched writes
+/// @details By default, the table is flushed to disk every time a writable accessor
+/// goes out of scope. For many small solutions (e.g. per-interval gains) it is more
+/// efficient to flush once per batch of solutions. Pending solutions are flushed by
+/// this method, by flushBatch or when this object is destroyed.
+/// @param[in] batchSize number of solutions written before the table is flushed,
+/// 0 or 1 mean flush for every solution
+void TableCalSolutionSource::batchWrites(const casacore::uInt batchSize)
+{
+  flushBatch();
+  if (batchSize > 1) {
+      itsFlushBatch.reset(new TableCalSolutionFiller::FlushBatch(batchSize));
+  } else {
+      itsFlushBatch.reset();
+  }
+}
 
+/// @brief flush the solutions written in the current batch
+/// @details Nothing is done if there is nothing to flush
+void TableCalSolutionSource::flushBatch()
+{
+  if (itsFlushBatch && (itsFlushBatch->itsPending > 0)) {
+      table().flush();
+      CalSolutionSequenceFile::announce(table());
+      itsFlushBatch->itsPending = 0;
+  }
+}
+
+/// @brief set the maximum tile size for new columns
+/// @details If non-zero, new columns (e.g. BANDPASS when the first bandpass is written)
+/// are set up with the tiled storage manager with tiles below the given size, so large
+/// cubes are written in big chunks. Existing columns are not affected.
+/// @param[in] maxTileSize maximum tile size in bytes, zero means default storage manager
+void TableCalSolutionSource::setMaxTileSize(const size_t maxTileSize)
+{
+  itsMaxTileSize = maxTileSize;
+}
 
 /// @brief obtain a solution ID to store new solution
 /// @details This method provides a solution ID for a new solution. It must
@@ -133,8 +177,9 @@ long TableCalSolutionSource::newSolutionID(const double time) {
 boost::shared_ptr<ICalSolutionAccessor> TableCalSolutionSource::rwSolution(const long id) const {
    ASKAPCHECK((id >= 0) && (static_cast<long>(table().nrow()) > id), "Requested solution id="<<id<<" is not in the table");
    boost::shared_ptr<TableCalSolutionFiller> filler(new TableCalSolutionFiller(table(),id,itsNAnt,
-          itsNBeam, itsNChan));
+          itsNBeam, itsNChan, itsMaxTileSize));
    ASKAPDEBUGASSERT(filler);
+   filler->setFlushBatch(itsFlushBatch);
    boost::shared_ptr<MemCalSolutionAccessor> acc(new MemCalSolutionAccessor(filler,false));
    ASKAPDEBUGASSERT(acc);
    return acc;
@@ -36,6 +36,7 @@
 // own includes
 #include <askap/calibaccess/ICalSolutionSource.h>
 #include <askap/calibaccess/TableCalSolutionConstSource.h>
+#include <askap/calibaccess/TableCalSolutionFiller.h>
 #include <askap/dataaccess/TableHolder.h>
 
 namespace askap {
@@ -72,6 +73,29 @@ public:
   TableCalSolutionSource(const std::string &name, const casacore::uInt nAnt, 
          const casacore::uInt nBeam, const casacore::uInt nChan);
   
+  /// @brief destructor, flushes the solutions written in the current batch
+  virtual ~TableCalSolutionSource();
+
+  /// @brief set up batched writes
+  /// @details By default, the table is flushed to disk every time a writable accessor
+  /// goes out of scope. For many small solutions (e.g. per-interval gains) it is more
+  /// efficient to flush once per batch of solutions. Pending solutions are flushed by
+  /// this method, by flushBatch or when this object is destroyed.
+  /// @param[in] batchSize number of solutions written before the table is flushed,
+  /// 0 or 1 mean flush for every solution
+  void batchWrites(const casacore::uInt batchSize);
+
+  /// @brief flush the solutions written in the current batch
+  /// @details Nothing is done if there is nothing to flush
+  void flushBatch();
+
+  /// @brief set the maximum tile size for new columns
+  /// @details If non-zero, new columns (e.g. BANDPASS when the first bandpass is written)
+  /// are set up with the tiled storage manager with tiles below the given size, so large
+  /// cubes are written in big chunks. Existing columns are not affected.
+  /// @param[in] maxTileSize maximum tile size in bytes, zero means default storage manager
+  void setMaxTileSize(const size_t maxTileSize);
+
   // remaining virtual methods of the interface
   
   /// @brief obtain a solution ID to store new solution
@@ -110,6 +134,10 @@ private:
   casacore::uInt itsNBeam;
   /// @brief number of spectral channels (used when new solutions are created)
   casacore::uInt itsNChan;     
+  /// @brief maximum tile size for new columns (zero means default storage manager)
+  size_t itsMaxTileSize;
+  /// @brief batch of deferred flushes shared with the fillers, empty if batching is off
+  boost::shared_ptr<TableCalSolutionFiller::FlushBatch> itsFlushBatch;
 }; // class TableCalSolutionSource
 
 } // namespace accessors
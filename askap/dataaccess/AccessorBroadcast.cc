@@ -0,0 +1,246 @@
+/// @file
+///
+/// @brief Fan-out of accessors read once to a number of consumers
+/// @details This class reads each accessor once in a producer thread and hands out
+/// immutable snapshots to a given number of consumers via a ring buffer.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/AccessorBroadcast.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+// std includes
+#include <limits>
+
+ASKAP_LOGGER(logger, ".AccessorBroadcast");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief position of a detached consumer
+const casacore::uInt64 detachedPosition = std::numeric_limits<casacore::uInt64>::max();
+
+} // anonymous namespace
+
+/// @brief set up the buffer and start reading
+/// @param[in] iter iterator to read
+/// @param[in] nConsumers number of consumers
+/// @param[in] capacity number of slots in the ring buffer
+/// @param[in] fields accessor fields to copy (bitwise combination of
+///            IDataSelector::AccessorFields values)
+AccessorBroadcast::AccessorBroadcast(const boost::shared_ptr<IConstDataIterator> &iter, size_t nConsumers,
+                    size_t capacity, casacore::uInt fields) :
+      itsIterator(iter), itsNConsumers(nConsumers), itsFields(fields), itsSlots(capacity),
+      itsWritten(0), itsRead(new std::atomic<casacore::uInt64>[nConsumers]), itsFinished(false),
+      itsStopRequested(false), itsProducerWaits(0), itsConsumerWaits(0)
+{
+  ASKAPCHECK(iter, "An attempt to initialise AccessorBroadcast with empty shared pointer");
+  ASKAPCHECK(nConsumers > 0, "AccessorBroadcast should have at least one consumer");
+  ASKAPCHECK(capacity > 0, "AccessorBroadcast should be able to hold at least one accessor");
+  for (size_t consumer = 0; consumer < itsNConsumers; ++consumer) {
+       itsRead[consumer].store(0);
+  }
+  itsProducerThread.reset(new boost::thread(boost::bind(&AccessorBroadcast::produce, this)));
+}
+
+/// @brief destructor, stops the producer thread
+AccessorBroadcast::~AccessorBroadcast()
+{
+  itsStopRequested.store(true);
+  if (itsProducerThread) {
+      itsProducerThread->join();
+      itsProducerThread.reset();
+  }
+  ASKAPLOG_DEBUG_STR(logger, "Accessor broadcast: "<<itsWritten.load()<<" accessor(s) read for "<<
+                     itsNConsumers<<" consumer(s); producer waited "<<itsProducerWaits.load()<<
+                     " time(s), consumers waited "<<itsConsumerWaits.load()<<" time(s)");
+}
+
+/// @brief check consumer index
+/// @param[in] consumer index of the consumer
+void AccessorBroadcast::checkConsumer(size_t consumer) const
+{
+  ASKAPCHECK(consumer < itsNConsumers, "Consumer index "<<consumer<<" exceeds the number of consumers ("<<
+             itsNConsumers<<")");
+}
+
+/// @brief obtain the next accessor for the given consumer
+/// @details The method waits until the accessor has been read. An empty pointer
+/// is returned when the end of the data is reached.
+/// @param[in] consumer index of the consumer
+/// @return shared pointer to the accessor, empty at the end of the data
+boost::shared_ptr<IConstDataAccessor const> AccessorBroadcast::next(size_t consumer)
+{
+  checkConsumer(consumer);
+  // only this consumer changes its own position
+  const casacore::uInt64 position = itsRead[consumer].load(std::memory_order_relaxed);
+  if (position == detachedPosition) {
+      ASKAPTHROW(DataAccessLogicError, "Consumer "<<consumer<<" has been detached from the broadcast");
+  }
+  bool waited = false;
+  while (position >= itsWritten.load(std::memory_order_acquire)) {
+         if (itsFinished.load(std::memory_order_acquire)) {
+             // the last accessor could be published just before the flag was set
+             if (position < itsWritten.load(std::memory_order_acquire)) {
+                 break;
+             }
+             if (itsError) {
+                 std::rethrow_exception(itsError);
+             }
+             return boost::shared_ptr<IConstDataAccessor const>();
+         }
+         if (!waited) {
+             ++itsConsumerWaits;
+             waited = true;
+         }
+         boost::this_thread::yield();
+  }
+  // the producer doesn't touch this slot until the position is advanced
+  const boost::shared_ptr<IConstDataAccessor const> result = itsSlots[position % itsSlots.size()];
+  itsRead[consumer].store(position + 1, std::memory_order_release);
+  return result;
+}
+
+/// @brief stop delivering accessors to the given consumer
+/// @param[in] consumer index of the consumer
+void AccessorBroadcast::detach(size_t consumer)
+{
+  checkConsumer(consumer);
+  itsRead[consumer].store(detachedPosition, std::memory_order_release);
+}
+
+/// @brief position of the slowest consumer which is still attached
+/// @return number of accessors taken by the slowest consumer
+casacore::uInt64 AccessorBroadcast::slowestConsumer() const
+{
+  casacore::uInt64 result = detachedPosition;
+  for (size_t consumer = 0; consumer < itsNConsumers; ++consumer) {
+       const casacore::uInt64 position = itsRead[consumer].load(std::memory_order_acquire);
+       if (position < result) {
+           result = position;
+       }
+  }
+  return result;
+}
+
+/// @brief body of the producer thread
+/// @details Errors are stored in itsError to be rethrown in the consumer threads
+void AccessorBroadcast::produce()
+{
+  ASKAPDEBUGASSERT(itsIterator);
+  try {
+     for (IConstDataIterator &it = *itsIterator; it.hasMore() && !itsStopRequested.load(); it.next()) {
+          if (slowestConsumer() == detachedPosition) {
+              // all consumers are detached, there is no point reading further
+              break;
+          }
+          const boost::shared_ptr<IConstDataAccessor const> acc = TimeChunkBuffer::copyAccessor(*it, itsFields);
+          const casacore::uInt64 position = itsWritten.load(std::memory_order_relaxed);
+          bool waited = false;
+          // the slot is free when the slowest consumer has taken the accessor held there
+          for (casacore::uInt64 slowest = slowestConsumer(); (slowest != detachedPosition) &&
+               (position - slowest >= itsSlots.size()); slowest = slowestConsumer()) {
+               if (itsStopRequested.load()) {
+                   break;
+               }
+               if (!waited) {
+                   ++itsProducerWaits;
+                   waited = true;
+               }
+               boost::this_thread::yield();
+          }
+          if (itsStopRequested.load()) {
+              break;
+          }
+          itsSlots[position % itsSlots.size()] = acc;
+          itsWritten.store(position + 1, std::memory_order_release);
+     }
+  }
+  catch (...) {
+     itsError = std::current_exception();
+  }
+  itsFinished.store(true, std::memory_order_release);
+}
+
+/// @brief construct the iterator and wait for the first accessor
+/// @param[in] broadcast shared pointer to the broadcast object
+/// @param[in] consumer index of the consumer
+BroadcastConsumerIterator::BroadcastConsumerIterator(const boost::shared_ptr<AccessorBroadcast> &broadcast,
+                  size_t consumer) : itsBroadcast(broadcast), itsConsumer(consumer), itsAtStart(true)
+{
+  ASKAPCHECK(itsBroadcast, "An attempt to initialise BroadcastConsumerIterator with empty shared pointer");
+  itsAccessor = itsBroadcast->next(itsConsumer);
+}
+
+/// @brief destructor, detaches the consumer
+BroadcastConsumerIterator::~BroadcastConsumerIterator()
+{
+  itsBroadcast->detach(itsConsumer);
+}
+
+/// @brief restart the iteration from the beginning
+/// @details This is only possible if the iterator is still at the first accessor
+void BroadcastConsumerIterator::init()
+{
+  if (!itsAtStart) {
+      ASKAPTHROW(DataAccessLogicError, "BroadcastConsumerIterator supports a single pass only, init can't "
+                 "be called after the iterator has been advanced");
+  }
+}
+
+/// @brief current accessor
+/// @return a reference to the current accessor
+const IConstDataAccessor& BroadcastConsumerIterator::operator*() const
+{
+  ASKAPCHECK(itsAccessor, "An attempt to access the accessor past the end of the data");
+  return *itsAccessor;
+}
+
+/// @brief check whether there are more data available
+/// @return true if there are more data available
+casacore::Bool BroadcastConsumerIterator::hasMore() const throw()
+{
+  return static_cast<bool>(itsAccessor);
+}
+
+/// @brief advance the iterator one step further
+/// @return true if there are more data
+casacore::Bool BroadcastConsumerIterator::next()
+{
+  itsAtStart = false;
+  if (itsAccessor) {
+      itsAccessor = itsBroadcast->next(itsConsumer);
+  }
+  return hasMore();
+}
@@ -0,0 +1,218 @@
+/// @file
+///
+/// @brief Fan-out of accessors read once to a number of consumers
+/// @details Several analyses (e.g. gridding, flagging statistics, quality plots) are
+/// often run over the same measurement set, each with its own iterator reading the
+/// data again. This class reads each accessor once in a producer thread and hands out
+/// immutable snapshots to a given number of consumers via a ring buffer, so all
+/// analyses can proceed in parallel with a single pass over the data.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ACCESSOR_BROADCAST_H
+#define ASKAP_ACCESSORS_ACCESSOR_BROADCAST_H
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/TimeChunkBuffer.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <vector>
+#include <atomic>
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Fan-out of accessors read once to a number of consumers
+/// @details The producer thread copies the fields given at construction (see
+/// TimeChunkBuffer::copyAccessor) of each accessor of the wrapped iterator into
+/// a slot of the ring buffer. Each consumer (identified by its index) gets every
+/// accessor in order. A slot is reused once all consumers have taken its accessor,
+/// i.e. the slowest consumer is at most capacity accessors behind the producer.
+/// Accessors are reference counted, so a consumer can keep them as long as necessary.
+///
+/// Positions of the producer and consumers are atomic counters, no locks are taken.
+/// A side which can't proceed yields the processor and tries again, the number of such
+/// waits is counted. This suits consumers of similar speed; a consumer which stops early
+/// should call detach, otherwise the producer waits for it forever.
+///
+/// Each consumer index should be used by one thread only. The wrapped iterator is used by
+/// the producer thread only and shouldn't be accessed elsewhere while this object is alive.
+/// Errors encountered by the producer are rethrown to the consumers once they have taken
+/// all accessors read before the error.
+/// @ingroup dataaccess_hlp
+class AccessorBroadcast : public boost::noncopyable {
+public:
+  /// @brief set up the buffer and start reading
+  /// @param[in] iter iterator to read
+  /// @param[in] nConsumers number of consumers
+  /// @param[in] capacity number of slots in the ring buffer
+  /// @param[in] fields accessor fields to copy (bitwise combination of
+  ///            IDataSelector::AccessorFields values)
+  AccessorBroadcast(const boost::shared_ptr<IConstDataIterator> &iter, size_t nConsumers,
+                    size_t capacity = 4, casacore::uInt fields = TimeChunkBuffer::defaultFields());
+
+  /// @brief destructor, stops the producer thread
+  ~AccessorBroadcast();
+
+  /// @brief obtain the next accessor for the given consumer
+  /// @details The method waits until the accessor has been read. An empty pointer
+  /// is returned when the end of the data is reached.
+  /// @param[in] consumer index of the consumer
+  /// @return shared pointer to the accessor, empty at the end of the data
+  boost::shared_ptr<IConstDataAccessor const> next(size_t consumer);
+
+  /// @brief stop delivering accessors to the given consumer
+  /// @details The producer doesn't wait for the detached consumer any more. The
+  /// consumer shouldn't call next after this call.
+  /// @param[in] consumer index of the consumer
+  void detach(size_t consumer);
+
+  /// @return number of consumers
+  inline size_t nConsumers() const { return itsNConsumers; }
+
+  /// @return number of slots in the ring buffer
+  inline size_t capacity() const { return itsSlots.size(); }
+
+  /// @return number of accessors read so far
+  inline casacore::uInt64 accessorsRead() const { return itsWritten.load(); }
+
+  /// @return number of times the producer had to wait for the slowest consumer
+  inline casacore::uInt64 producerWaits() const { return itsProducerWaits.load(); }
+
+  /// @return number of times consumers had to wait for an accessor to be read
+  inline casacore::uInt64 consumerWaits() const { return itsConsumerWaits.load(); }
+
+private:
+  /// @brief body of the producer thread
+  void produce();
+
+  /// @brief position of the slowest consumer which is still attached
+  /// @return number of accessors taken by the slowest consumer
+  casacore::uInt64 slowestConsumer() const;
+
+  /// @brief check consumer index
+  /// @param[in] consumer index of the consumer
+  void checkConsumer(size_t consumer) const;
+
+  /// @brief iterator read by the producer
+  boost::shared_ptr<IConstDataIterator> itsIterator;
+
+  /// @brief number of consumers
+  size_t itsNConsumers;
+
+  /// @brief fields to copy
+  casacore::uInt itsFields;
+
+  /// @brief ring buffer, accessor number n is kept in slot n % capacity
+  std::vector<boost::shared_ptr<IConstDataAccessor const> > itsSlots;
+
+  /// @brief number of accessors published by the producer
+  std::atomic<casacore::uInt64> itsWritten;
+
+  /// @brief number of accessors taken by each consumer
+  boost::scoped_array<std::atomic<casacore::uInt64> > itsRead;
+
+  /// @brief true, if the producer has finished (end of data, error or stop request)
+  std::atomic<bool> itsFinished;
+
+  /// @brief true, if the producer is asked to stop
+  std::atomic<bool> itsStopRequested;
+
+  /// @brief error encountered by the producer, if any
+  /// @details Written before itsFinished is set, read after it is seen
+  std::exception_ptr itsError;
+
+  /// @brief number of producer waits
+  std::atomic<casacore::uInt64> itsProducerWaits;
+
+  /// @brief number of consumer waits
+  std::atomic<casacore::uInt64> itsConsumerWaits;
+
+  /// @brief producer thread
+  boost::shared_ptr<boost::thread> itsProducerThread;
+};
+
+/// @brief iterator interface for a consumer of AccessorBroadcast
+/// @details This adapter allows code written for IConstDataIterator to be used as a
+/// consumer. Only a single pass is possible, init throws an exception after the iterator
+/// has been advanced. The consumer is detached when the adapter is destroyed.
+/// @ingroup dataaccess_hlp
+class BroadcastConsumerIterator : public IConstDataIterator,
+                                  public boost::noncopyable {
+public:
+  /// @brief construct the iterator and wait for the first accessor
+  /// @param[in] broadcast shared pointer to the broadcast object
+  /// @param[in] consumer index of the consumer
+  BroadcastConsumerIterator(const boost::shared_ptr<AccessorBroadcast> &broadcast, size_t consumer);
+
+  /// @brief destructor, detaches the consumer
+  virtual ~BroadcastConsumerIterator();
+
+  /// @brief restart the iteration from the beginning
+  /// @details This is only possible if the iterator is still at the first accessor
+  virtual void init();
+
+  /// @brief current accessor
+  /// @return a reference to the current accessor
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// @brief check whether there are more data available
+  /// @return true if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// @brief advance the iterator one step further
+  /// @return true if there are more data
+  virtual casacore::Bool next();
+
+private:
+  /// @brief broadcast object
+  boost::shared_ptr<AccessorBroadcast> itsBroadcast;
+
+  /// @brief index of the consumer
+  size_t itsConsumer;
+
+  /// @brief current accessor, empty at the end of the data
+  boost::shared_ptr<IConstDataAccessor const> itsAccessor;
+
+  /// @brief true, if the iterator is at the first accessor
+  bool itsAtStart;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ACCESSOR_BROADCAST_H
@@ -0,0 +1,324 @@
+/// @file
+///
+/// @brief Wire format of accessor snapshots
+/// @details Master-worker setups read the data on one rank and distribute the content of
+/// accessors to the others. This class defines a contiguous representation of the accessor
+/// fields: a fixed-size header followed by the raw content of each field. Such a buffer can
+/// be sent as is and wrapped on the receiving side by WireDataAccessor without copying.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/AccessorWireFormat.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <cstring>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief copy the content of an array into the buffer
+/// @param[in] array array to copy
+/// @param[in] nElements expected number of elements
+/// @param[in] dst start of the block
+/// @param[in] name name of the field (for the error message)
+template<typename T>
+void packArray(const casacore::Array<T> &array, size_t nElements, char *dst, const char *name)
+{
+  ASKAPCHECK(array.nelements() == nElements, "Accessor field "<<name<<" has "<<array.nelements()<<
+             " elements, "<<nElements<<" expected for the shape of the visibility cube");
+  if (nElements == 0) {
+      return;
+  }
+  bool deleteIt = false;
+  const T *data = array.getStorage(deleteIt);
+  std::memcpy(dst, data, nElements * sizeof(T));
+  array.freeStorage(data, deleteIt);
+}
+
+/// @brief copy uvw coordinates into the buffer as three doubles per row
+/// @param[in] uvw uvw coordinates
+/// @param[in] nRow expected number of rows
+/// @param[in] dst start of the block
+void packUVW(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw, size_t nRow, char *dst)
+{
+  ASKAPCHECK(uvw.nelements() == nRow, "Accessor field uvw has "<<uvw.nelements()<<" elements, "<<nRow<<
+             " expected");
+  casacore::Double *out = reinterpret_cast<casacore::Double*>(dst);
+  for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            out[3 * row + dim] = uvw[row](dim);
+       }
+  }
+}
+
+/// @brief copy directions into the buffer as three direction cosines each
+/// @param[in] dirs directions
+/// @param[in] nRow expected number of rows
+/// @param[in] dst start of the block
+/// @param[in] name name of the field (for the error message)
+void packDirections(const casacore::Vector<casacore::MVDirection> &dirs, size_t nRow, char *dst, const char *name)
+{
+  ASKAPCHECK(dirs.nelements() == nRow, "Accessor field "<<name<<" has "<<dirs.nelements()<<" elements, "<<
+             nRow<<" expected");
+  casacore::Double *out = reinterpret_cast<casacore::Double*>(dst);
+  for (casacore::uInt row = 0; row < dirs.nelements(); ++row) {
+       const casacore::Vector<casacore::Double> &xyz = dirs[row].getValue();
+       ASKAPDEBUGASSERT(xyz.nelements() == 3);
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            out[3 * row + dim] = xyz[dim];
+       }
+  }
+}
+
+/// @brief swap the byte order of a 64-bit number
+/// @param[in] value number to swap
+/// @return the number with the reverse byte order
+casacore::uInt64 swapBytes(casacore::uInt64 value)
+{
+  casacore::uInt64 result = 0;
+  for (int byte = 0; byte < 8; ++byte) {
+       result = (result << 8) | ((value >> (8 * byte)) & 0xff);
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+/// @brief pack accessor fields into the buffer
+/// @param[in] acc accessor to pack
+/// @param[out] buffer buffer to fill (resized as necessary)
+/// @param[in] fields accessor fields to pack (bitwise combination of
+///            IDataSelector::AccessorFields values), the visibility cube is always packed
+void AccessorWireFormat::pack(const IConstDataAccessor &acc, std::vector<char> &buffer, casacore::uInt fields)
+{
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  header.itsMagic = theirMagic;
+  header.itsFields = (fields | IDataSelector::VISIBILITY) & IDataSelector::ALL_FIELDS;
+  header.itsNRow = acc.nRow();
+  header.itsNChannel = acc.nChannel();
+  header.itsNPol = acc.nPol();
+  header.itsTime = acc.time();
+  size_t size = sizeof(Header);
+  for (int block = 0; block < N_BLOCKS; ++block) {
+       if (header.itsFields & blockField(Blocks(block))) {
+           size = (size + theirAlignment - 1) / theirAlignment * theirAlignment;
+           header.itsOffsets[block] = size;
+           size += blockSize(header, Blocks(block));
+       }
+  }
+  header.itsSize = size;
+  buffer.resize(size);
+  char *data = &buffer[0];
+  std::memcpy(data, &header, sizeof(Header));
+
+  const size_t nRow = header.itsNRow;
+  const size_t nSamples = nRow * header.itsNChannel * header.itsNPol;
+  packArray(acc.visibility(), nSamples, data + header.itsOffsets[VISIBILITY_BLOCK], "visibility");
+  if (header.itsFields & IDataSelector::FLAG) {
+      packArray(acc.flag(), nSamples, data + header.itsOffsets[FLAG_BLOCK], "flag");
+  }
+  if (header.itsFields & IDataSelector::NOISE) {
+      packArray(acc.noise(), nSamples, data + header.itsOffsets[NOISE_BLOCK], "noise");
+  }
+  if (header.itsFields & IDataSelector::UVW) {
+      packUVW(acc.uvw(), nRow, data + header.itsOffsets[UVW_BLOCK]);
+  }
+  if (header.itsFields & IDataSelector::FREQUENCY) {
+      packArray(acc.frequency(), header.itsNChannel, data + header.itsOffsets[FREQUENCY_BLOCK], "frequency");
+  }
+  if (header.itsFields & IDataSelector::ANTENNA) {
+      packArray(acc.antenna1(), nRow, data + header.itsOffsets[ANTENNA1_BLOCK], "antenna1");
+      packArray(acc.antenna2(), nRow, data + header.itsOffsets[ANTENNA2_BLOCK], "antenna2");
+  }
+  if (header.itsFields & IDataSelector::FEED) {
+      packArray(acc.feed1(), nRow, data + header.itsOffsets[FEED1_BLOCK], "feed1");
+      packArray(acc.feed2(), nRow, data + header.itsOffsets[FEED2_BLOCK], "feed2");
+  }
+  if (header.itsFields & IDataSelector::FEED_PA) {
+      packArray(acc.feed1PA(), nRow, data + header.itsOffsets[FEED1_PA_BLOCK], "feed1PA");
+      packArray(acc.feed2PA(), nRow, data + header.itsOffsets[FEED2_PA_BLOCK], "feed2PA");
+  }
+  if (header.itsFields & IDataSelector::POINTING) {
+      packDirections(acc.pointingDir1(), nRow, data + header.itsOffsets[POINTING_DIR1_BLOCK], "pointingDir1");
+      packDirections(acc.pointingDir2(), nRow, data + header.itsOffsets[POINTING_DIR2_BLOCK], "pointingDir2");
+  }
+  if (header.itsFields & IDataSelector::DISH_POINTING) {
+      packDirections(acc.dishPointing1(), nRow, data + header.itsOffsets[DISH_POINTING1_BLOCK], "dishPointing1");
+      packDirections(acc.dishPointing2(), nRow, data + header.itsOffsets[DISH_POINTING2_BLOCK], "dishPointing2");
+  }
+  if (header.itsFields & IDataSelector::STOKES) {
+      const casacore::Vector<casacore::Stokes::StokesTypes> &stokes = acc.stokes();
+      ASKAPCHECK(stokes.nelements() == header.itsNPol, "Accessor field stokes has "<<stokes.nelements()<<
+                 " elements, "<<header.itsNPol<<" expected");
+      casacore::Int *out = reinterpret_cast<casacore::Int*>(data + header.itsOffsets[STOKES_BLOCK]);
+      for (casacore::uInt pol = 0; pol < stokes.nelements(); ++pol) {
+           out[pol] = static_cast<casacore::Int>(stokes[pol]);
+      }
+  }
+}
+
+/// @brief obtain and check the header of the buffer
+/// @details An exception is thrown if the buffer is not in this format (or comes from a
+/// machine with a different byte order).
+/// @param[in] buffer buffer filled by pack
+/// @return copy of the header
+AccessorWireFormat::Header AccessorWireFormat::header(const std::vector<char> &buffer)
+{
+  ASKAPCHECK(buffer.size() >= sizeof(Header), "Buffer of "<<buffer.size()<<
+             " bytes is too small to hold an accessor snapshot");
+  Header result;
+  std::memcpy(&result, &buffer[0], sizeof(Header));
+  ASKAPCHECK(result.itsMagic != swapBytes(theirMagic), "Accessor snapshot has been packed on a machine "
+             "with a different byte order");
+  ASKAPCHECK(result.itsMagic == theirMagic, "Buffer doesn't contain an accessor snapshot");
+  ASKAPCHECK(result.itsSize == buffer.size(), "Accessor snapshot is "<<result.itsSize<<
+             " bytes long, the buffer has "<<buffer.size()<<" bytes");
+  ASKAPCHECK(result.itsFields & IDataSelector::VISIBILITY, "Accessor snapshot has no visibility cube");
+  for (int block = 0; block < N_BLOCKS; ++block) {
+       const bool present = (result.itsFields & blockField(Blocks(block))) != 0;
+       const casacore::uInt64 offset = result.itsOffsets[block];
+       ASKAPCHECK(present == (offset != 0), "Block "<<block<<" of the accessor snapshot is inconsistent "
+                  "with the list of fields");
+       if (present) {
+           ASKAPCHECK((offset % theirAlignment == 0) && (offset >= sizeof(Header)) &&
+                      (offset + blockSize(result, Blocks(block)) <= result.itsSize), "Block "<<block<<
+                      " at offset "<<offset<<" doesn't fit into the accessor snapshot");
+       }
+  }
+  return result;
+}
+
+/// @brief send the buffer to another rank
+/// @details The size is sent first, then the buffer itself. The buffer is given to the
+/// communication layer directly, there is no intermediate copy (as for blob streams).
+/// @param[in] comms communication object
+/// @param[in] buffer buffer filled by pack
+/// @param[in] dest rank to send to
+void AccessorWireFormat::send(askapparallel::AskapParallel &comms, const std::vector<char> &buffer, int dest)
+{
+  const casacore::uInt64 size = buffer.size();
+  comms.send(&size, sizeof(size), dest, theirTag);
+  if (size > 0) {
+      comms.send(&buffer[0], buffer.size(), dest, theirTag);
+  }
+}
+
+/// @brief receive the buffer from another rank
+/// @details This is the counterpart of send. The data are received directly into the
+/// returned buffer, which can be wrapped by WireDataAccessor.
+/// @param[in] comms communication object
+/// @param[in] source rank to receive from
+/// @return shared pointer to the received buffer
+boost::shared_ptr<std::vector<char> > AccessorWireFormat::receive(askapparallel::AskapParallel &comms, int source)
+{
+  casacore::uInt64 size = 0;
+  comms.receive(&size, sizeof(size), source, theirTag);
+  boost::shared_ptr<std::vector<char> > buffer(new std::vector<char>(size));
+  if (size > 0) {
+      comms.receive(&(*buffer)[0], buffer->size(), source, theirTag);
+  }
+  return buffer;
+}
+
+/// @brief size of the given block
+/// @param[in] header header describing the shape of the accessor
+/// @param[in] block block of interest
+/// @return number of bytes in the block (if present)
+size_t AccessorWireFormat::blockSize(const Header &header, Blocks block)
+{
+  const size_t nRow = header.itsNRow;
+  const size_t nSamples = nRow * header.itsNChannel * header.itsNPol;
+  switch (block) {
+     case VISIBILITY_BLOCK:
+     case NOISE_BLOCK:
+          return nSamples * sizeof(casacore::Complex);
+     case FLAG_BLOCK:
+          return nSamples * sizeof(casacore::Bool);
+     case UVW_BLOCK:
+     case POINTING_DIR1_BLOCK:
+     case POINTING_DIR2_BLOCK:
+     case DISH_POINTING1_BLOCK:
+     case DISH_POINTING2_BLOCK:
+          return 3 * nRow * sizeof(casacore::Double);
+     case FREQUENCY_BLOCK:
+          return header.itsNChannel * sizeof(casacore::Double);
+     case ANTENNA1_BLOCK:
+     case ANTENNA2_BLOCK:
+     case FEED1_BLOCK:
+     case FEED2_BLOCK:
+          return nRow * sizeof(casacore::uInt);
+     case FEED1_PA_BLOCK:
+     case FEED2_PA_BLOCK:
+          return nRow * sizeof(casacore::Float);
+     case STOKES_BLOCK:
+          return header.itsNPol * sizeof(casacore::Int);
+     default:
+          ASKAPTHROW(AskapError, "Unknown block "<<int(block)<<" of the accessor snapshot");
+  }
+}
+
+/// @brief accessor fields stored in the given block
+/// @param[in] block block of interest
+/// @return IDataSelector::AccessorFields value
+casacore::uInt AccessorWireFormat::blockField(Blocks block)
+{
+  switch (block) {
+     case VISIBILITY_BLOCK:
+          return IDataSelector::VISIBILITY;
+     case FLAG_BLOCK:
+          return IDataSelector::FLAG;
+     case NOISE_BLOCK:
+          return IDataSelector::NOISE;
+     case UVW_BLOCK:
+          return IDataSelector::UVW;
+     case FREQUENCY_BLOCK:
+          return IDataSelector::FREQUENCY;
+     case ANTENNA1_BLOCK:
+     case ANTENNA2_BLOCK:
+          return IDataSelector::ANTENNA;
+     case FEED1_BLOCK:
+     case FEED2_BLOCK:
+          return IDataSelector::FEED;
+     case FEED1_PA_BLOCK:
+     case FEED2_PA_BLOCK:
+          return IDataSelector::FEED_PA;
+     case POINTING_DIR1_BLOCK:
+     case POINTING_DIR2_BLOCK:
+          return IDataSelector::POINTING;
+     case DISH_POINTING1_BLOCK:
+     case DISH_POINTING2_BLOCK:
+          return IDataSelector::DISH_POINTING;
+     case STOKES_BLOCK:
+          return IDataSelector::STOKES;
+     default:
+          ASKAPTHROW(AskapError, "Unknown block "<<int(block)<<" of the accessor snapshot");
+  }
+}
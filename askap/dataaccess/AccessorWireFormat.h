@@ -0,0 +1,168 @@
+/// @file
+///
+/// @brief Wire format of accessor snapshots
+/// @details Master-worker setups read the data on one rank and distribute the content of
+/// accessors to the others. This class defines a contiguous representation of the accessor
+/// fields: a fixed-size header followed by the raw content of each field. Such a buffer can
+/// be sent as is and wrapped on the receiving side by WireDataAccessor without copying.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ACCESSOR_WIRE_FORMAT_H
+#define ASKAP_ACCESSORS_ACCESSOR_WIRE_FORMAT_H
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IDataSelector.h>
+
+// askapparallel includes
+#include <askap/askapparallel/AskapParallel.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Wire format of accessor snapshots
+/// @details The buffer starts with the Header structure, followed by the blocks with the
+/// content of the fields in the native byte order of the sender. Each block starts at an
+/// offset aligned to theirAlignment bytes and holds the field exactly as stored in the
+/// corresponding casacore array (i.e. row-major nRow x nChannel x nPol cubes with the row
+/// axis varying fastest). Directions are stored as three direction cosines, uvw as three
+/// doubles per row and polarisation types as integers. Only the fields given at packing are
+/// present (the visibility cube is always present as it defines the shape), as in
+/// TimeChunkBuffer::copyAccessor. The format is meant for ranks of the same job, i.e.
+/// machines of the same architecture. The byte order is checked when the buffer is unpacked.
+/// @ingroup dataaccess_hlp
+class AccessorWireFormat {
+public:
+  /// @brief blocks of the buffer
+  enum Blocks {
+     VISIBILITY_BLOCK = 0,
+     FLAG_BLOCK,
+     NOISE_BLOCK,
+     UVW_BLOCK,
+     FREQUENCY_BLOCK,
+     ANTENNA1_BLOCK,
+     ANTENNA2_BLOCK,
+     FEED1_BLOCK,
+     FEED2_BLOCK,
+     FEED1_PA_BLOCK,
+     FEED2_PA_BLOCK,
+     POINTING_DIR1_BLOCK,
+     POINTING_DIR2_BLOCK,
+     DISH_POINTING1_BLOCK,
+     DISH_POINTING2_BLOCK,
+     STOKES_BLOCK,
+     /// @brief number of blocks
+     N_BLOCKS
+  };
+
+  /// @brief fixed-size header of the buffer
+  struct Header {
+     /// @brief format identifier, also reveals byte order (see theirMagic)
+     casacore::uInt64 itsMagic;
+     /// @brief total size of the buffer in bytes, including the header
+     casacore::uInt64 itsSize;
+     /// @brief fields present (bitwise combination of IDataSelector::AccessorFields values)
+     casacore::uInt itsFields;
+     /// @brief number of rows
+     casacore::uInt itsNRow;
+     /// @brief number of spectral channels
+     casacore::uInt itsNChannel;
+     /// @brief number of polarisation products
+     casacore::uInt itsNPol;
+     /// @brief time of the accessor
+     casacore::Double itsTime;
+     /// @brief offset of each block from the start of the buffer, zero if the block is absent
+     casacore::uInt64 itsOffsets[N_BLOCKS];
+  };
+
+  /// @brief format identifier
+  static const casacore::uInt64 theirMagic = 0x4153415031434341ull;
+
+  /// @brief alignment of the blocks in bytes
+  static const size_t theirAlignment = 64;
+
+  /// @brief pack accessor fields into the buffer
+  /// @param[in] acc accessor to pack
+  /// @param[out] buffer buffer to fill (resized as necessary)
+  /// @param[in] fields accessor fields to pack (bitwise combination of
+  ///            IDataSelector::AccessorFields values), the visibility cube is always packed
+  static void pack(const IConstDataAccessor &acc, std::vector<char> &buffer,
+                   casacore::uInt fields = IDataSelector::ALL_FIELDS);
+
+  /// @brief obtain and check the header of the buffer
+  /// @details An exception is thrown if the buffer is not in this format (or comes from a
+  /// machine with a different byte order).
+  /// @param[in] buffer buffer filled by pack
+  /// @return copy of the header
+  static Header header(const std::vector<char> &buffer);
+
+  /// @brief send the buffer to another rank
+  /// @details The size is sent first, then the buffer itself. The buffer is given to the
+  /// communication layer directly, there is no intermediate copy (as for blob streams).
+  /// @param[in] comms communication object
+  /// @param[in] buffer buffer filled by pack
+  /// @param[in] dest rank to send to
+  static void send(askapparallel::AskapParallel &comms, const std::vector<char> &buffer, int dest);
+
+  /// @brief receive the buffer from another rank
+  /// @details This is the counterpart of send. The data are received directly into the
+  /// returned buffer, which can be wrapped by WireDataAccessor.
+  /// @param[in] comms communication object
+  /// @param[in] source rank to receive from
+  /// @return shared pointer to the received buffer
+  static boost::shared_ptr<std::vector<char> > receive(askapparallel::AskapParallel &comms, int source);
+
+  /// @brief size of the given block
+  /// @param[in] header header describing the shape of the accessor
+  /// @param[in] block block of interest
+  /// @return number of bytes in the block (if present)
+  static size_t blockSize(const Header &header, Blocks block);
+
+  /// @brief accessor fields stored in the given block
+  /// @param[in] block block of interest
+  /// @return IDataSelector::AccessorFields value
+  static casacore::uInt blockField(Blocks block);
+
+  /// @brief tag of the messages sent by send
+  static const int theirTag = 21;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ACCESSOR_WIRE_FORMAT_H
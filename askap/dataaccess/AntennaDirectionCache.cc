@@ -0,0 +1,154 @@
+/// @file
+///
+/// @brief Cache of per-antenna parallactic angles and dish pointings
+/// @details Parallactic angles and dish pointings for all antennas are stored
+/// for each epoch and reference direction, so they can be reused by other iterators.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/AntennaDirectionCache.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty cache
+/// @param[in] maxSize maximum number of epochs to keep for each kind of values
+AntennaDirectionCache::AntennaDirectionCache(size_t maxSize) : itsMaxSize(maxSize), itsHits(0) 
+{
+  ASKAPCHECK(itsMaxSize > 0, "Direction cache should be able to hold at least one epoch");
+}
+
+/// @brief search for parallactic angles
+/// @param[in] epoch epoch of interest
+/// @param[in] dir reference direction
+/// @param[out] angles parallactic angles for all antennas (unchanged if not found)
+/// @return true, if the angles have been found in the cache
+bool AntennaDirectionCache::findParallacticAngles(const casacore::MEpoch &epoch, 
+          const casacore::MDirection &dir, casacore::Vector<casacore::Double> &angles) const
+{
+  return find(itsAngles, makeKey(epoch, dir, casacore::MDirection::AZEL), angles);
+}
+
+/// @brief add parallactic angles to the cache
+/// @param[in] epoch epoch of interest
+/// @param[in] dir reference direction
+/// @param[in] angles parallactic angles for all antennas
+void AntennaDirectionCache::addParallacticAngles(const casacore::MEpoch &epoch, 
+          const casacore::MDirection &dir, const casacore::Vector<casacore::Double> &angles) const
+{
+  add(itsAngles, makeKey(epoch, dir, casacore::MDirection::AZEL), angles);
+}
+
+/// @brief search for dish pointings
+/// @param[in] epoch epoch of interest
+/// @param[in] dir reference direction
+/// @param[in] target frame the pointings are converted to
+/// @param[out] dirs pointings for all antennas (unchanged if not found)
+/// @return true, if the pointings have been found in the cache
+bool AntennaDirectionCache::findDishPointings(const casacore::MEpoch &epoch, 
+          const casacore::MDirection &dir, const casacore::MDirection::Ref &target,
+          casacore::Vector<casacore::MVDirection> &dirs) const
+{
+  return find(itsDishPointings, makeKey(epoch, dir, target.getType()), dirs);
+}
+
+/// @brief add dish pointings to the cache
+/// @param[in] epoch epoch of interest
+/// @param[in] dir reference direction
+/// @param[in] target frame the pointings are converted to
+/// @param[in] dirs pointings for all antennas
+void AntennaDirectionCache::addDishPointings(const casacore::MEpoch &epoch, 
+          const casacore::MDirection &dir, const casacore::MDirection::Ref &target,
+          const casacore::Vector<casacore::MVDirection> &dirs) const
+{
+  add(itsDishPointings, makeKey(epoch, dir, target.getType()), dirs);
+}
+
+/// @return number of epochs in the cache
+size_t AntennaDirectionCache::size() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsAngles.size() + itsDishPointings.size();
+}
+
+/// @return number of successful searches
+size_t AntennaDirectionCache::hits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsHits;
+}
+
+/// @brief make a key
+/// @param[in] epoch epoch of interest
+/// @param[in] dir reference direction
+/// @param[in] targetType type of the target frame
+/// @return key
+AntennaDirectionCache::Key AntennaDirectionCache::makeKey(const casacore::MEpoch &epoch, 
+          const casacore::MDirection &dir, casacore::uInt targetType)
+{
+  const casacore::Vector<casacore::Double> angles = dir.getValue().get();
+  ASKAPDEBUGASSERT(angles.nelements() == 2);
+  return Key(epoch.getValue().get(), epoch.getRef().getType(), dir.getRef().getType(),
+             angles[0], angles[1], targetType);
+}
+
+/// @brief search for values
+/// @param[in] store map to search
+/// @param[in] key key to search for
+/// @param[out] values found values (unchanged if not found)
+/// @return true, if the key has been found
+template<typename T>
+bool AntennaDirectionCache::find(const std::map<Key, casacore::Vector<T> > &store, const Key &key,
+                                 casacore::Vector<T> &values) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const typename std::map<Key, casacore::Vector<T> >::const_iterator ci = store.find(key);
+  if (ci == store.end()) {
+      return false;
+  }
+  values.assign(ci->second);
+  ++itsHits;
+  return true;
+}
+
+/// @brief add values
+/// @param[in] store map to add to
+/// @param[in] key key to add
+/// @param[in] values values to store
+template<typename T>
+void AntennaDirectionCache::add(std::map<Key, casacore::Vector<T> > &store, const Key &key,
+                                const casacore::Vector<T> &values) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (store.size() < itsMaxSize || store.find(key) != store.end()) {
+      store[key].assign(values);
+  }
+}
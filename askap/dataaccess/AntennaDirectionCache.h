@@ -0,0 +1,161 @@
+/// @file
+///
+/// @brief Cache of per-antenna parallactic angles and dish pointings
+/// @details Parallactic angles and dish pointings depend only on the epoch and the
+/// reference direction (plus the target frame for pointings). These values are 
+/// recomputed for every time step by each iterator. This class memoises them, so
+/// iterators of the same data source (e.g. in successive major cycles) can reuse the
+/// results.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ANTENNA_DIRECTION_CACHE_H
+#define ASKAP_ACCESSORS_ANTENNA_DIRECTION_CACHE_H
+
+// casa includes
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+
+// std includes
+#include <map>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Cache of per-antenna parallactic angles and dish pointings
+/// @details Values for all antennas are stored together, indexed by a key made of
+/// the epoch, the reference direction and the target frame. The number of entries
+/// is limited. Once the limit is reached, new results are not added, so a repeated
+/// pass over a long dataset still benefits for the first part of the data rather
+/// than constantly replacing entries. All methods are thread-safe.
+/// @ingroup dataaccess_tab
+class AntennaDirectionCache {
+public:
+  /// @brief construct an empty cache
+  /// @param[in] maxSize maximum number of epochs to keep for each kind of values
+  explicit AntennaDirectionCache(size_t maxSize = 8192);
+
+  /// @brief search for parallactic angles
+  /// @param[in] epoch epoch of interest
+  /// @param[in] dir reference direction
+  /// @param[out] angles parallactic angles for all antennas (unchanged if not found)
+  /// @return true, if the angles have been found in the cache
+  bool findParallacticAngles(const casacore::MEpoch &epoch, const casacore::MDirection &dir,
+                             casacore::Vector<casacore::Double> &angles) const;
+
+  /// @brief add parallactic angles to the cache
+  /// @param[in] epoch epoch of interest
+  /// @param[in] dir reference direction
+  /// @param[in] angles parallactic angles for all antennas
+  void addParallacticAngles(const casacore::MEpoch &epoch, const casacore::MDirection &dir,
+                            const casacore::Vector<casacore::Double> &angles) const;
+
+  /// @brief search for dish pointings
+  /// @param[in] epoch epoch of interest
+  /// @param[in] dir reference direction
+  /// @param[in] target frame the pointings are converted to
+  /// @param[out] dirs pointings for all antennas (unchanged if not found)
+  /// @return true, if the pointings have been found in the cache
+  bool findDishPointings(const casacore::MEpoch &epoch, const casacore::MDirection &dir,
+                         const casacore::MDirection::Ref &target,
+                         casacore::Vector<casacore::MVDirection> &dirs) const;
+
+  /// @brief add dish pointings to the cache
+  /// @param[in] epoch epoch of interest
+  /// @param[in] dir reference direction
+  /// @param[in] target frame the pointings are converted to
+  /// @param[in] dirs pointings for all antennas
+  void addDishPointings(const casacore::MEpoch &epoch, const casacore::MDirection &dir,
+                        const casacore::MDirection::Ref &target,
+                        const casacore::Vector<casacore::MVDirection> &dirs) const;
+
+  /// @return number of epochs in the cache
+  size_t size() const;
+
+  /// @return number of successful searches
+  size_t hits() const;
+
+private:
+  /// @brief key type
+  /// @details time (in days), epoch frame type, direction frame type, longitude, latitude
+  /// and target frame type
+  typedef boost::tuple<casacore::Double, casacore::uInt, casacore::uInt, casacore::Double,
+                       casacore::Double, casacore::uInt> Key;
+
+  /// @brief make a key
+  /// @param[in] epoch epoch of interest
+  /// @param[in] dir reference direction
+  /// @param[in] targetType type of the target frame
+  /// @return key
+  static Key makeKey(const casacore::MEpoch &epoch, const casacore::MDirection &dir,
+                     casacore::uInt targetType);
+
+  /// @brief search for values
+  /// @param[in] store map to search
+  /// @param[in] key key to search for
+  /// @param[out] values found values (unchanged if not found)
+  /// @return true, if the key has been found
+  template<typename T>
+  bool find(const std::map<Key, casacore::Vector<T> > &store, const Key &key,
+            casacore::Vector<T> &values) const;
+
+  /// @brief add values
+  /// @param[in] store map to add to
+  /// @param[in] key key to add
+  /// @param[in] values values to store
+  template<typename T>
+  void add(std::map<Key, casacore::Vector<T> > &store, const Key &key,
+           const casacore::Vector<T> &values) const;
+
+  /// @brief maximum number of epochs to keep for each kind of values
+  size_t itsMaxSize;
+
+  /// @brief cached parallactic angles
+  mutable std::map<Key, casacore::Vector<casacore::Double> > itsAngles;
+
+  /// @brief cached dish pointings
+  mutable std::map<Key, casacore::Vector<casacore::MVDirection> > itsDishPointings;
+
+  /// @brief number of successful searches
+  mutable size_t itsHits;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ANTENNA_DIRECTION_CACHE_H
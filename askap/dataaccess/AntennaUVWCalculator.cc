@@ -0,0 +1,150 @@
+/// @file
+///
+/// @brief Calculator of uvw coordinates from antenna positions
+/// @details This class converts the position of each antenna once per time step and
+/// obtains uvw of each baseline as a difference of antenna-based coordinates.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/AntennaUVWCalculator.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/measures/Measures/MBaseline.h>
+#include <casacore/measures/Measures/MCBaseline.h>
+#include <casacore/measures/Measures/MCDirection.h>
+#include <casacore/measures/Measures/MCPosition.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MeasConvert.h>
+#include <casacore/casa/Quanta/MVBaseline.h>
+#include <casacore/casa/Quanta/MVuvw.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the calculator
+/// @param[in] antennas antenna subtable handler to take the positions from
+AntennaUVWCalculator::AntennaUVWCalculator(const IAntennaSubtableHandler &antennas) :
+      itsTime(0.), itsTimeFrame(0), itsValid(false), itsNUpdates(0)
+{
+  const casacore::uInt nAnt = antennas.getNumberOfAntennas();
+  ASKAPCHECK(nAnt > 0, "AntennaUVWCalculator requires at least one antenna in the ANTENNA subtable");
+  itsAntennaXYZ.resize(nAnt, 3);
+  itsAntennaUVW.resize(nAnt, 3);
+  itsReferencePosition = casacore::MPosition::Convert(antennas.getPosition(0), casacore::MPosition::ITRF)();
+  const casacore::Vector<casacore::Double> refXYZ = itsReferencePosition.getValue().getValue();
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       const casacore::MPosition pos = casacore::MPosition::Convert(antennas.getPosition(ant),
+                                                                    casacore::MPosition::ITRF)();
+       const casacore::Vector<casacore::Double> xyz = pos.getValue().getValue();
+       ASKAPDEBUGASSERT(xyz.nelements() == 3);
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            itsAntennaXYZ(ant, dim) = xyz[dim] - refXYZ[dim];
+       }
+  }
+}
+
+/// @brief set the epoch and the phase centre
+/// @details Antenna-based uvws are recomputed only if the epoch or the phase centre
+/// differ from those used in the previous call.
+/// @param[in] epoch epoch of interest
+/// @param[in] phaseCentre phase centre (converted to J2000 if necessary)
+void AntennaUVWCalculator::setTime(const casacore::MEpoch &epoch, const casacore::MDirection &phaseCentre)
+{
+  const casacore::Double time = epoch.getValue().get();
+  const casacore::uInt timeFrame = epoch.getRef().getType();
+  casacore::MeasFrame frame(epoch, itsReferencePosition);
+  const casacore::MDirection j2000Centre = phaseCentre.getRef().getType() == casacore::MDirection::J2000 ?
+        phaseCentre : casacore::MDirection::Convert(phaseCentre,
+                               casacore::MDirection::Ref(casacore::MDirection::J2000, frame))();
+  const casacore::MVDirection &centre = j2000Centre.getValue();
+  if (itsValid && (time == itsTime) && (timeFrame == itsTimeFrame) &&
+      (centre.separation(itsPhaseCentre) < 1e-12)) {
+      return;
+  }
+  DataAccessStatistics::ScopedTimer timer("AntennaUVWCalculator::setTime");
+  frame.set(j2000Centre);
+  casacore::MBaseline::Convert converter(casacore::MBaseline::Ref(casacore::MBaseline::ITRF, frame),
+                                         casacore::MBaseline::Ref(casacore::MBaseline::J2000));
+  for (casacore::uInt ant = 0; ant < nAntenna(); ++ant) {
+       const casacore::MVBaseline itrfBaseline(itsAntennaXYZ(ant, 0), itsAntennaXYZ(ant, 1),
+                                               itsAntennaXYZ(ant, 2));
+       const casacore::MBaseline j2000Baseline = converter(casacore::MBaseline(itrfBaseline,
+                                                          casacore::MBaseline::ITRF));
+       const casacore::MVuvw uvw(j2000Baseline.getValue(), centre);
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            itsAntennaUVW(ant, dim) = uvw(dim);
+       }
+  }
+  itsTime = time;
+  itsTimeFrame = timeFrame;
+  itsPhaseCentre = centre;
+  itsValid = true;
+  ++itsNUpdates;
+  timer.miss();
+}
+
+/// @brief compute uvws of baselines
+/// @details setTime should be called first.
+/// @param[in] ant1 IDs of the first antenna for each row
+/// @param[in] ant2 IDs of the second antenna for each row
+/// @param[out] uvw uvw for each row (resized as necessary)
+/// @param[out] bounds bounding box of uvw, computed in the same pass
+void AntennaUVWCalculator::fill(const casacore::Vector<casacore::uInt> &ant1,
+                                const casacore::Vector<casacore::uInt> &ant2,
+                                casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                                UVWBounds &bounds) const
+{
+  ASKAPCHECK(itsValid, "AntennaUVWCalculator::setTime should be called before uvws are computed");
+  ASKAPDEBUGASSERT(ant1.nelements() == ant2.nelements());
+  const size_t nRows = ant1.nelements();
+  uvw.resize(nRows);
+  bounds.reset();
+  if (nRows == 0) {
+      return;
+  }
+  ASKAPDEBUGASSERT(ant1.contiguousStorage() && ant2.contiguousStorage() && uvw.contiguousStorage());
+  ASKAPDEBUGASSERT(itsAntennaUVW.contiguousStorage());
+  const casacore::uInt nAnt = nAntenna();
+  const casacore::Double *antU = itsAntennaUVW.data();
+  const casacore::Double *antV = antU + nAnt;
+  const casacore::Double *antW = antV + nAnt;
+  const casacore::uInt *id1 = ant1.data();
+  const casacore::uInt *id2 = ant2.data();
+  casacore::RigidVector<casacore::Double, 3> *out = uvw.data();
+  for (size_t row = 0; row < nRows; ++row) {
+       ASKAPDEBUGASSERT((id1[row] < nAnt) && (id2[row] < nAnt));
+       const casacore::Double u = antU[id2[row]] - antU[id1[row]];
+       const casacore::Double v = antV[id2[row]] - antV[id1[row]];
+       const casacore::Double w = antW[id2[row]] - antW[id1[row]];
+       out[row](0) = u;
+       out[row](1) = v;
+       out[row](2) = w;
+       bounds.add(u, v, w);
+  }
+}
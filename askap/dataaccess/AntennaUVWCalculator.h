@@ -0,0 +1,129 @@
+/// @file
+///
+/// @brief Calculator of uvw coordinates from antenna positions
+/// @details The UVW column takes 24 bytes per row, but it can be derived from the
+/// antenna positions, the phase centre and the epoch. This class converts the position
+/// of each antenna once per time step (O(nAntenna) conversions) and obtains uvw of each
+/// baseline as a difference of antenna-based coordinates.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ANTENNA_UVW_CALCULATOR_H
+#define ASKAP_ACCESSORS_ANTENNA_UVW_CALCULATOR_H
+
+// own includes
+#include <askap/dataaccess/IAntennaSubtableHandler.h>
+#include <askap/dataaccess/UVWBounds.h>
+
+// casa includes
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Calculator of uvw coordinates from antenna positions
+/// @details Antenna positions are converted to ITRF once at construction. For the given
+/// epoch and phase centre, the position of each antenna relative to the first antenna is
+/// converted to the J2000 baseline frame and projected onto the uvw axes of the phase centre
+/// (the same approach as used by casacore to generate the UVW column). The uvw of a baseline
+/// is then the difference of antenna-based values, uvw(ant2) - uvw(ant1), following the
+/// measurement set convention. Antenna-based values are kept in the struct-of-arrays layout,
+/// so the per-baseline loop is a plain loop over contiguous arrays which can be vectorised.
+///
+/// As uvws are derived for any phase centre, this class can also be used to get the exact
+/// coordinates for a different phase centre without rotating the stored ones.
+/// @ingroup dataaccess_tab
+class AntennaUVWCalculator {
+public:
+  /// @brief set up the calculator
+  /// @param[in] antennas antenna subtable handler to take the positions from
+  explicit AntennaUVWCalculator(const IAntennaSubtableHandler &antennas);
+
+  /// @brief set the epoch and the phase centre
+  /// @details Antenna-based uvws are recomputed only if the epoch or the phase centre
+  /// differ from those used in the previous call.
+  /// @param[in] epoch epoch of interest
+  /// @param[in] phaseCentre phase centre (converted to J2000 if necessary)
+  void setTime(const casacore::MEpoch &epoch, const casacore::MDirection &phaseCentre);
+
+  /// @brief compute uvws of baselines
+  /// @details setTime should be called first.
+  /// @param[in] ant1 IDs of the first antenna for each row
+  /// @param[in] ant2 IDs of the second antenna for each row
+  /// @param[out] uvw uvw for each row (resized as necessary)
+  /// @param[out] bounds bounding box of uvw, computed in the same pass
+  void fill(const casacore::Vector<casacore::uInt> &ant1, const casacore::Vector<casacore::uInt> &ant2,
+            casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw, UVWBounds &bounds) const;
+
+  /// @brief antenna-based uvws
+  /// @return nAntenna x 3 matrix with u, v and w in columns (relative to the first antenna)
+  inline const casacore::Matrix<casacore::Double>& antennaUVW() const { return itsAntennaUVW; }
+
+  /// @return number of antennas
+  inline casacore::uInt nAntenna() const { return itsAntennaXYZ.nrow(); }
+
+  /// @return number of times antenna-based uvws have been computed
+  inline size_t nUpdates() const { return itsNUpdates; }
+
+private:
+  /// @brief ITRF positions of antennas relative to the first antenna
+  /// @details nAntenna x 3 matrix
+  casacore::Matrix<casacore::Double> itsAntennaXYZ;
+
+  /// @brief position of the first antenna
+  casacore::MPosition itsReferencePosition;
+
+  /// @brief antenna-based uvws for the current epoch and phase centre
+  /// @details nAntenna x 3 matrix with u, v and w in columns
+  casacore::Matrix<casacore::Double> itsAntennaUVW;
+
+  /// @brief epoch antenna-based uvws correspond to (in days)
+  casacore::Double itsTime;
+
+  /// @brief frame type of the epoch
+  casacore::uInt itsTimeFrame;
+
+  /// @brief phase centre antenna-based uvws correspond to (J2000)
+  casacore::MVDirection itsPhaseCentre;
+
+  /// @brief true, if antenna-based uvws have been computed
+  bool itsValid;
+
+  /// @brief number of times antenna-based uvws have been computed
+  size_t itsNUpdates;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ANTENNA_UVW_CALCULATOR_H
@@ -0,0 +1,237 @@
+/// @file
+///
+/// @brief Allocation policies for large accessor arrays
+/// @details The classes in this file allow the user to give an allocation policy to
+/// the data sources and image accessors: huge pages or memory bound to the given NUMA node.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/ArrayAllocator.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// std includes
+#include <cerrno>
+#include <cstring>
+#include <stdint.h>
+
+// system includes
+#include <unistd.h>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+ASKAP_LOGGER(logger, ".ArrayAllocator");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief page-aligned part of the block
+/// @param[in] data pointer to the block
+/// @param[in] bytes size of the block in bytes
+/// @param[out] length length of the aligned part in bytes (0 if the block doesn't contain whole pages)
+/// @return pointer to the first whole page of the block
+void* alignedPart(void *data, size_t bytes, size_t &length)
+{
+  const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t start = (reinterpret_cast<uintptr_t>(data) + pageSize - 1) / pageSize * pageSize;
+  const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + bytes) / pageSize * pageSize;
+  length = end > start ? end - start : 0;
+  return reinterpret_cast<void*>(start);
+}
+
+#ifdef __linux__
+/// @brief preferred memory policy (MPOL_PREFERRED of numaif.h)
+const int theMPolPreferred = 1;
+
+/// @brief flag requesting to move the pages already allocated (MPOL_MF_MOVE of numaif.h)
+const unsigned int theMPolMFMove = 1u << 1;
+#endif
+
+} // anonymous namespace
+
+/// @brief void virtual destructor to keep the compiler happy
+ArrayAllocator::~ArrayAllocator() {}
+
+/// @return name of the policy (as accepted by create)
+std::string ArrayAllocator::name() const
+{
+  return "heap";
+}
+
+/// @brief create the allocator for the given policy
+/// @details The following policies are supported: "heap" (the global heap, an empty pointer
+/// is returned), "hugepages" (see HugePageArrayAllocator), "numa" (see NumaArrayAllocator,
+/// the memory is bound to the NUMA node of the calling thread) and "pinned" (see
+/// PinnedArrayAllocator).
+/// @param[in] policy name of the policy
+/// @return shared pointer to the allocator, empty for the global heap
+/// @throw AskapError if the policy is not supported
+boost::shared_ptr<ArrayAllocator const> ArrayAllocator::create(const std::string &policy)
+{
+  if (policy == "heap") {
+      return boost::shared_ptr<ArrayAllocator const>();
+  }
+  if (policy == "hugepages") {
+      return boost::shared_ptr<ArrayAllocator const>(new HugePageArrayAllocator);
+  }
+  if (policy == "numa") {
+      return boost::shared_ptr<ArrayAllocator const>(new NumaArrayAllocator);
+  }
+  ASKAPCHECK(policy == "pinned", "Unsupported array allocation policy "<<policy<<
+             ", use heap, hugepages, numa or pinned");
+  return boost::shared_ptr<ArrayAllocator const>(new PinnedArrayAllocator);
+}
+
+/// @brief change the placement of the freshly allocated memory
+/// @details This method is called for every allocation before the storage is handed over
+/// to the caller. Nothing is done by default.
+void ArrayAllocator::place(void *, size_t) const {}
+
+/// @brief set up the allocator
+/// @param[in] minBytes smaller blocks are left as allocated
+HugePageArrayAllocator::HugePageArrayAllocator(size_t minBytes) : itsMinBytes(minBytes) {}
+
+/// @return name of the policy (as accepted by create)
+std::string HugePageArrayAllocator::name() const
+{
+  return "hugepages";
+}
+
+/// @brief advise the kernel to use huge pages
+/// @param[in] data pointer to the storage
+/// @param[in] bytes size of the storage in bytes
+void HugePageArrayAllocator::place(void *data, size_t bytes) const
+{
+  if (bytes < itsMinBytes) {
+      return;
+  }
+#ifdef MADV_HUGEPAGE
+  size_t length = 0;
+  void *start = alignedPart(data, bytes, length);
+  if ((length > 0) && (madvise(start, length, MADV_HUGEPAGE) != 0)) {
+      ASKAPLOG_DEBUG_STR(logger, "madvise failed for "<<length<<" bytes: "<<std::strerror(errno));
+  }
+#endif
+}
+
+/// @brief set up the allocator
+/// @param[in] node NUMA node to bind the memory to, negative value means the node of
+///            the thread calling the constructor
+NumaArrayAllocator::NumaArrayAllocator(int node) : itsNode(node < 0 ? currentNode() : node)
+{
+  ASKAPCHECK(itsNode < 64, "NUMA node "<<itsNode<<" is not supported, only nodes 0 to 63 can be used");
+}
+
+/// @return name of the policy (as accepted by create)
+std::string NumaArrayAllocator::name() const
+{
+  return "numa";
+}
+
+/// @brief obtain the NUMA node of the calling thread
+/// @return node number, 0 if it can't be determined
+int NumaArrayAllocator::currentNode()
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) {
+      return static_cast<int>(node);
+  }
+#endif
+  return 0;
+}
+
+/// @brief bind the storage to the node
+/// @param[in] data pointer to the storage
+/// @param[in] bytes size of the storage in bytes
+void NumaArrayAllocator::place(void *data, size_t bytes) const
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  size_t length = 0;
+  void *start = alignedPart(data, bytes, length);
+  if (length > 0) {
+      const unsigned long nodeMask = 1ul << itsNode;
+      if (syscall(SYS_mbind, start, length, theMPolPreferred, &nodeMask, sizeof(nodeMask) * 8,
+                  theMPolMFMove) != 0) {
+          ASKAPLOG_DEBUG_STR(logger, "mbind to NUMA node "<<itsNode<<" failed for "<<length<<" bytes: "<<
+                             std::strerror(errno));
+      }
+  }
+#endif
+}
+
+/// @brief set up the allocator
+/// @param[in] minBytes smaller blocks are left as allocated
+PinnedArrayAllocator::PinnedArrayAllocator(size_t minBytes) : itsMinBytes(minBytes), itsNLocked(0),
+      itsNFailed(0) {}
+
+/// @return name of the policy (as accepted by create)
+std::string PinnedArrayAllocator::name() const
+{
+  return "pinned";
+}
+
+/// @return number of blocks locked so far
+size_t PinnedArrayAllocator::nLocked() const
+{
+  return itsNLocked.load();
+}
+
+/// @return number of blocks which couldn't be locked
+size_t PinnedArrayAllocator::nFailed() const
+{
+  return itsNFailed.load();
+}
+
+/// @brief lock the storage in RAM
+/// @param[in] data pointer to the storage
+/// @param[in] bytes size of the storage in bytes
+void PinnedArrayAllocator::place(void *data, size_t bytes) const
+{
+  if (bytes < itsMinBytes) {
+      return;
+  }
+  size_t length = 0;
+  void *start = alignedPart(data, bytes, length);
+  if (length == 0) {
+      return;
+  }
+  if (mlock(start, length) == 0) {
+      ++itsNLocked;
+  } else {
+      // the first failure is usually due to RLIMIT_MEMLOCK, don't flood the log
+      if (itsNFailed++ == 0) {
+          ASKAPLOG_DEBUG_STR(logger, "mlock failed for "<<length<<" bytes: "<<std::strerror(errno)<<
+                             ", memory is left pageable");
+      }
+  }
+}
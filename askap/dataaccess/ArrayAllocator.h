@@ -0,0 +1,247 @@
+/// @file
+///
+/// @brief Allocation policies for large accessor arrays
+/// @details Visibility and flag cubes and image slices are the largest arrays handled by
+/// the accessors. By default, they are allocated on the global heap and the memory lands
+/// on the NUMA node of the thread which happens to touch it first (e.g. the read-ahead
+/// thread). The classes in this file allow the user to give an allocation policy to
+/// the data sources and image accessors: huge pages or memory bound to the given NUMA node.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ARRAY_ALLOCATOR_H
+#define ASKAP_ACCESSORS_ARRAY_ALLOCATOR_H
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+#include <atomic>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Allocation policy for large accessor arrays
+/// @details The storage is always allocated by casacore, so the arrays own their memory
+/// and can be copied, referenced and kept beyond the lifetime of the accessor as usual.
+/// After allocation, the derived classes can change the placement of the memory (see the
+/// place method), e.g. advise the kernel to back it with huge pages or bind it to a
+/// NUMA node. This base class leaves the memory as allocated by the global heap. An empty
+/// shared pointer can be used wherever the allocator is optional, with the same effect.
+/// Allocators are stateless after construction and can be shared between threads.
+/// @ingroup dataaccess_hlp
+class ArrayAllocator {
+public:
+  /// @brief void virtual destructor to keep the compiler happy
+  virtual ~ArrayAllocator();
+
+  /// @brief allocate flat storage
+  /// @param[in] nElements number of elements
+  /// @return vector with the storage
+  template<typename T>
+  casacore::Vector<T> allocate(size_t nElements) const;
+
+  /// @brief resize the given array using the storage allocated by this object
+  /// @details Nothing is done if the array already has the required shape. Otherwise, new
+  /// storage is allocated and the content is undefined (as after resize).
+  /// @param[in] array array to resize (Vector, Matrix, Cube or Array)
+  /// @param[in] shape required shape
+  template<typename A>
+  void resize(A &array, const casacore::IPosition &shape) const;
+
+  /// @return name of the policy (as accepted by create)
+  virtual std::string name() const;
+
+  /// @brief create the allocator for the given policy
+  /// @details The following policies are supported: "heap" (the global heap, an empty pointer
+  /// is returned), "hugepages" (see HugePageArrayAllocator), "numa" (see NumaArrayAllocator,
+  /// the memory is bound to the NUMA node of the calling thread) and "pinned" (see
+  /// PinnedArrayAllocator).
+  /// @param[in] policy name of the policy
+  /// @return shared pointer to the allocator, empty for the global heap
+  /// @throw AskapError if the policy is not supported
+  static boost::shared_ptr<ArrayAllocator const> create(const std::string &policy);
+
+protected:
+  /// @brief change the placement of the freshly allocated memory
+  /// @details This method is called for every allocation before the storage is handed over
+  /// to the caller. Nothing is done by default.
+  /// @param[in] data pointer to the storage
+  /// @param[in] bytes size of the storage in bytes
+  virtual void place(void *data, size_t bytes) const;
+};
+
+/// @brief Allocation policy requesting transparent huge pages
+/// @details Large blocks are advised to be backed by huge pages (madvise with MADV_HUGEPAGE),
+/// which reduces the number of page faults and TLB misses for large cubes. Only the part of
+/// the block aligned to page boundaries is advised. Pages touched before the advice (e.g. by
+/// the initialisation of the array elements) are collapsed into huge pages by the kernel later.
+/// If the system doesn't support transparent huge pages, the memory is left as allocated.
+/// @ingroup dataaccess_hlp
+class HugePageArrayAllocator : public ArrayAllocator {
+public:
+  /// @brief set up the allocator
+  /// @param[in] minBytes smaller blocks are left as allocated
+  explicit HugePageArrayAllocator(size_t minBytes = 2u * 1024u * 1024u);
+
+  /// @return name of the policy (as accepted by create)
+  virtual std::string name() const;
+
+protected:
+  /// @brief advise the kernel to use huge pages
+  /// @param[in] data pointer to the storage
+  /// @param[in] bytes size of the storage in bytes
+  virtual void place(void *data, size_t bytes) const;
+
+private:
+  /// @brief smaller blocks are left as allocated
+  size_t itsMinBytes;
+};
+
+/// @brief Allocation policy binding the memory to a NUMA node
+/// @details The allocated blocks are bound to the given node with the preferred policy
+/// (mbind with MPOL_PREFERRED), the pages already touched are moved to this node. This way
+/// the cubes read by the read-ahead thread end up on the node of the thread using them.
+/// Small blocks which share pages with other allocations are left as allocated. If the
+/// system doesn't support NUMA policies, the memory is left as allocated.
+/// @ingroup dataaccess_hlp
+class NumaArrayAllocator : public ArrayAllocator {
+public:
+  /// @brief set up the allocator
+  /// @param[in] node NUMA node to bind the memory to, negative value means the node of
+  ///            the thread calling the constructor
+  explicit NumaArrayAllocator(int node = -1);
+
+  /// @return NUMA node the memory is bound to
+  inline int node() const { return itsNode; }
+
+  /// @return name of the policy (as accepted by create)
+  virtual std::string name() const;
+
+  /// @brief obtain the NUMA node of the calling thread
+  /// @return node number, 0 if it can't be determined
+  static int currentNode();
+
+protected:
+  /// @brief bind the storage to the node
+  /// @param[in] data pointer to the storage
+  /// @param[in] bytes size of the storage in bytes
+  virtual void place(void *data, size_t bytes) const;
+
+private:
+  /// @brief NUMA node the memory is bound to
+  int itsNode;
+};
+
+/// @brief Allocation policy locking the memory in RAM
+/// @details Large blocks are locked (mlock), so they are never paged out and stay at the
+/// same physical location. Page-locked buffers can be transferred to an accelerator by DMA
+/// without an intermediate copy into the staging buffer of the driver (see also
+/// DeviceUploadStage). Only the part of the block aligned to page boundaries is locked.
+/// The lock is released by the kernel when the pages are returned to the system, which
+/// happens for large blocks (served by mmap) as soon as the array is destroyed. Blocks
+/// below the threshold are left as allocated because they may share pages with other
+/// allocations. If the limit on locked memory (RLIMIT_MEMLOCK) is reached, the memory is
+/// left as allocated and the number of such failures is counted.
+/// @note Device runtimes which require explicit registration of host memory (and the
+/// matching deregistration before the memory is freed) can't use this class directly as
+/// the storage is released by casacore.
+/// @ingroup dataaccess_hlp
+class PinnedArrayAllocator : public ArrayAllocator {
+public:
+  /// @brief set up the allocator
+  /// @param[in] minBytes smaller blocks are left as allocated
+  explicit PinnedArrayAllocator(size_t minBytes = 1024u * 1024u);
+
+  /// @return name of the policy (as accepted by create)
+  virtual std::string name() const;
+
+  /// @return number of blocks locked so far
+  size_t nLocked() const;
+
+  /// @return number of blocks which couldn't be locked
+  size_t nFailed() const;
+
+protected:
+  /// @brief lock the storage in RAM
+  /// @param[in] data pointer to the storage
+  /// @param[in] bytes size of the storage in bytes
+  virtual void place(void *data, size_t bytes) const;
+
+private:
+  /// @brief smaller blocks are left as allocated
+  size_t itsMinBytes;
+
+  /// @brief number of blocks locked so far
+  mutable std::atomic<size_t> itsNLocked;
+
+  /// @brief number of blocks which couldn't be locked
+  mutable std::atomic<size_t> itsNFailed;
+};
+
+/// @brief allocate flat storage
+/// @param[in] nElements number of elements
+/// @return vector with the storage
+template<typename T>
+casacore::Vector<T> ArrayAllocator::allocate(size_t nElements) const
+{
+  casacore::Vector<T> result(nElements);
+  if (nElements > 0) {
+      place(result.data(), nElements * sizeof(T));
+  }
+  return result;
+}
+
+/// @brief resize the given array using the storage allocated by this object
+/// @details Nothing is done if the array already has the required shape. Otherwise, new
+/// storage is allocated and the content is undefined (as after resize).
+/// @param[in] array array to resize (Vector, Matrix, Cube or Array)
+/// @param[in] shape required shape
+template<typename A>
+void ArrayAllocator::resize(A &array, const casacore::IPosition &shape) const
+{
+  if (array.shape().isEqual(shape)) {
+      return;
+  }
+  const size_t nElements = shape.product();
+  if (nElements == 0) {
+      array.resize(shape);
+      return;
+  }
+  array.reference(allocate<typename A::value_type>(nElements).reform(shape));
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ARRAY_ALLOCATOR_H
@@ -0,0 +1,121 @@
+/// @file
+///
+/// @brief Exchange of values without deep copies
+/// @details casacore arrays have reference semantics for the copy constructor, but
+/// the assignment operator copies the data. Depending on the casacore version, move
+/// operations may fall back to a copy as well. The helpers in this file swap arrays
+/// by exchanging references, so the storage changes hands without copying. Other types
+/// are swapped with std::swap.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ARRAY_SWAP_H
+#define ASKAP_ACCESSORS_ARRAY_SWAP_H
+
+// casa includes
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+// std includes
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief swap two casacore arrays by exchanging references
+/// @details No data are copied, each array takes over the storage of the other one.
+/// @param[in] first first array
+/// @param[in] second second array
+/// @ingroup dataaccess_hlp
+template<typename A>
+inline void swapArrays(A &first, A &second)
+{
+  A tmp;
+  tmp.reference(first);
+  first.reference(second);
+  second.reference(tmp);
+}
+
+/// @brief swap two values
+/// @details This is the generic version, which uses std::swap
+/// @param[in] first first value
+/// @param[in] second second value
+/// @ingroup dataaccess_hlp
+template<typename T>
+inline void swapValues(T &first, T &second)
+{
+  using std::swap;
+  swap(first, second);
+}
+
+/// @brief swap two arrays without copying the data
+/// @param[in] first first array
+/// @param[in] second second array
+/// @ingroup dataaccess_hlp
+template<typename T>
+inline void swapValues(casacore::Array<T> &first, casacore::Array<T> &second)
+{
+  swapArrays(first, second);
+}
+
+/// @brief swap two vectors without copying the data
+/// @param[in] first first vector
+/// @param[in] second second vector
+/// @ingroup dataaccess_hlp
+template<typename T>
+inline void swapValues(casacore::Vector<T> &first, casacore::Vector<T> &second)
+{
+  swapArrays(first, second);
+}
+
+/// @brief swap two matrices without copying the data
+/// @param[in] first first matrix
+/// @param[in] second second matrix
+/// @ingroup dataaccess_hlp
+template<typename T>
+inline void swapValues(casacore::Matrix<T> &first, casacore::Matrix<T> &second)
+{
+  swapArrays(first, second);
+}
+
+/// @brief swap two cubes without copying the data
+/// @param[in] first first cube
+/// @param[in] second second cube
+/// @ingroup dataaccess_hlp
+template<typename T>
+inline void swapValues(casacore::Cube<T> &first, casacore::Cube<T> &second)
+{
+  swapArrays(first, second);
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ARRAY_SWAP_H
@@ -0,0 +1,110 @@
+/// @file
+///
+/// @brief Asynchronous operations on data iterators
+/// @details The functions executed by the I/O pool on behalf of fetchAsync and nextAsync.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/AsyncDataAccess.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief read the given fields of the current accessor
+/// @details The accessor caches the fields, so they are delivered without reading when
+/// accessed later. Nothing is done if there are no more data.
+/// @param[in] it iterator to work with
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+/// @return true if there are more data (i.e. the accessor is valid)
+bool askap::accessors::fetchAccessor(const boost::shared_ptr<IConstDataIterator> &it, casacore::uInt fields)
+{
+  ASKAPDEBUGASSERT(it);
+  if (!it->hasMore()) {
+      return false;
+  }
+  fetchFields(**it, fields);
+  return true;
+}
+
+/// @brief read the given fields of an accessor
+/// @details The accessor caches the fields, so they are delivered without reading when
+/// accessed later.
+/// @param[in] acc accessor to work with
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+void askap::accessors::fetchFields(const IConstDataAccessor &acc, casacore::uInt fields)
+{
+  if (fields & IDataSelector::VISIBILITY) {
+      acc.visibility();
+  }
+  if (fields & IDataSelector::FLAG) {
+      acc.flag();
+  }
+  if (fields & IDataSelector::NOISE) {
+      acc.noise();
+  }
+  if (fields & IDataSelector::UVW) {
+      acc.uvw();
+  }
+  if (fields & IDataSelector::FREQUENCY) {
+      acc.frequency();
+  }
+  if (fields & IDataSelector::ANTENNA) {
+      acc.antenna1();
+      acc.antenna2();
+  }
+  if (fields & IDataSelector::FEED) {
+      acc.feed1();
+      acc.feed2();
+  }
+  if (fields & IDataSelector::FEED_PA) {
+      acc.feed1PA();
+      acc.feed2PA();
+  }
+  if (fields & IDataSelector::POINTING) {
+      acc.pointingDir1();
+      acc.pointingDir2();
+  }
+  if (fields & IDataSelector::DISH_POINTING) {
+      acc.dishPointing1();
+      acc.dishPointing2();
+  }
+  if (fields & IDataSelector::STOKES) {
+      acc.stokes();
+  }
+}
+
+/// @brief advance the iterator and read the given fields of the new accessor
+/// @param[in] it iterator to work with
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+/// @return true if there are more data
+bool askap::accessors::nextAccessor(const boost::shared_ptr<IConstDataIterator> &it, casacore::uInt fields)
+{
+  ASKAPDEBUGASSERT(it);
+  it->next();
+  return fetchAccessor(it, fields);
+}
@@ -0,0 +1,134 @@
+/// @file
+///
+/// @brief Asynchronous operations on data iterators
+/// @details IConstDataIterator::next and the accessor methods block until the data are
+/// read. The functions defined here advance the iterator and read the requested fields
+/// in a thread of the I/O pool (see IOThreadPool), so a pipeline can have reads of many
+/// measurement sets in flight without a thread per measurement set.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ASYNC_DATA_ACCESS_H
+#define ASKAP_ACCESSORS_ASYNC_DATA_ACCESS_H
+
+// own includes
+#include <askap/dataaccess/IOThreadPool.h>
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IDataSelector.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+
+// std includes
+#include <future>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief read the given fields of the current accessor
+/// @details The accessor caches the fields, so they are delivered without reading when
+/// accessed later. Nothing is done if there are no more data.
+/// @param[in] it iterator to work with
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+/// @return true if there are more data (i.e. the accessor is valid)
+bool fetchAccessor(const boost::shared_ptr<IConstDataIterator> &it, casacore::uInt fields);
+
+/// @brief read the given fields of an accessor
+/// @details The accessor caches the fields, so they are delivered without reading when
+/// accessed later. This is the body of fetchAccessor, it is also handy to materialise the
+/// fields before the accessor is shared between threads (e.g. via RowSliceAccessor views).
+/// @param[in] acc accessor to work with
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+void fetchFields(const IConstDataAccessor &acc, casacore::uInt fields);
+
+/// @brief advance the iterator and read the given fields of the new accessor
+/// @param[in] it iterator to work with
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+/// @return true if there are more data
+bool nextAccessor(const boost::shared_ptr<IConstDataIterator> &it, casacore::uInt fields);
+
+/// @brief read the current accessor asynchronously
+/// @details The iterator shouldn't be used until the future is ready. Typically used to
+/// start reading the first accessor.
+/// @param[in] it iterator to work with
+/// @param[in] executor pool or strand to execute the read (see IOThreadPool)
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+/// @return future with the result of hasMore
+template<typename Executor>
+std::future<bool> fetchAsync(const boost::shared_ptr<IConstDataIterator> &it, Executor &executor,
+                             casacore::uInt fields = IDataSelector::VISIBILITY | IDataSelector::FLAG)
+{
+  ASKAPCHECK(it, "An attempt to read an empty iterator asynchronously");
+  return executor.submit(boost::bind(&fetchAccessor, it, fields));
+}
+
+/// @brief read the current accessor asynchronously using the shared pool
+/// @param[in] it iterator to work with
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+/// @return future with the result of hasMore
+inline std::future<bool> fetchAsync(const boost::shared_ptr<IConstDataIterator> &it,
+                             casacore::uInt fields = IDataSelector::VISIBILITY | IDataSelector::FLAG)
+{
+  return fetchAsync(it, IOThreadPool::shared(), fields);
+}
+
+/// @brief advance the iterator asynchronously
+/// @details This is an asynchronous version of IConstDataIterator::next. The given fields of
+/// the new accessor are read as well. The iterator shouldn't be used until the future is ready.
+/// @param[in] it iterator to work with
+/// @param[in] executor pool or strand to execute the read (see IOThreadPool)
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+/// @return future with the result of next
+template<typename Executor>
+std::future<bool> nextAsync(const boost::shared_ptr<IConstDataIterator> &it, Executor &executor,
+                            casacore::uInt fields = IDataSelector::VISIBILITY | IDataSelector::FLAG)
+{
+  ASKAPCHECK(it, "An attempt to advance an empty iterator asynchronously");
+  return executor.submit(boost::bind(&nextAccessor, it, fields));
+}
+
+/// @brief advance the iterator asynchronously using the shared pool
+/// @param[in] it iterator to work with
+/// @param[in] fields accessor fields to read (bitwise combination of IDataSelector::AccessorFields values)
+/// @return future with the result of next
+inline std::future<bool> nextAsync(const boost::shared_ptr<IConstDataIterator> &it,
+                            casacore::uInt fields = IDataSelector::VISIBILITY | IDataSelector::FLAG)
+{
+  return nextAsync(it, IOThreadPool::shared(), fields);
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ASYNC_DATA_ACCESS_H
@@ -0,0 +1,350 @@
+/// @file
+///
+/// @brief Baseline-major cache of the visibility data
+/// @details Integrations are buffered in blocks and written into a temporary file
+/// baseline by baseline.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/BaselineMajorCache.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".BaselineMajorCache");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief write a vector into the binary stream
+/// @param[in] os output stream
+/// @param[in] data vector to write
+template<typename T>
+void writeVector(std::ostream &os, const std::vector<T> &data)
+{
+  if (data.size()) {
+      os.write(reinterpret_cast<const char*>(&data[0]), data.size() * sizeof(T));
+  }
+}
+
+/// @brief read a vector from the binary stream
+/// @param[in] is input stream
+/// @param[out] data vector to fill (should be of the appropriate size)
+template<typename T>
+void readVector(std::istream &is, std::vector<T> &data)
+{
+  if (data.size()) {
+      is.read(reinterpret_cast<char*>(&data[0]), data.size() * sizeof(T));
+  }
+}
+
+} // anonymous namespace
+
+/// @brief transpose the data
+/// @details The iteration is restarted from the beginning and all data are read.
+/// @param[in] iter iterator to read
+/// @param[in] directory directory for the cache file
+/// @param[in] blockSize number of integrations accumulated in memory before they are
+///            written to disk
+/// @param[in] fields accessor fields to cache (bitwise combination of
+///            IDataSelector::AccessorFields values)
+BaselineMajorCache::BaselineMajorCache(IConstDataIterator &iter, const std::string &directory,
+                     casacore::uInt blockSize, casacore::uInt fields) :
+      itsBlockSize(blockSize), itsFields(fields | IDataSelector::VISIBILITY), itsNChannel(0), itsNPol(0),
+      itsIntegrationsInBlock(0), itsNBlocks(0), itsFileSize(0)
+{
+  ASKAPCHECK(itsBlockSize > 0, "Block size of the baseline-major cache should be positive");
+  ASKAPCHECK(directory.size(), "Directory for the baseline-major cache should be given");
+  std::string pattern = directory + "/askap_baseline_cache_XXXXXX";
+  std::vector<char> buf(pattern.begin(), pattern.end());
+  buf.push_back(0);
+  const int fd = mkstemp(&buf[0]);
+  if (fd < 0) {
+      ASKAPTHROW(DataAccessError, "Unable to create baseline-major cache file in "<<directory);
+  }
+  close(fd);
+  itsFileName = &buf[0];
+  itsFile.open(itsFileName.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!itsFile) {
+      std::remove(itsFileName.c_str());
+      ASKAPTHROW(DataAccessError, "Unable to open baseline-major cache file "<<itsFileName);
+  }
+  try {
+     bool first = true;
+     casacore::Double lastTime = 0.;
+     for (iter.init(); iter.hasMore(); iter.next()) {
+          const IConstDataAccessor &acc = *iter;
+          if (first || (acc.time() != lastTime)) {
+              if (itsIntegrationsInBlock == itsBlockSize) {
+                  flush();
+              }
+              ++itsIntegrationsInBlock;
+              lastTime = acc.time();
+              first = false;
+          }
+          add(acc);
+     }
+     flush();
+  }
+  catch (...) {
+     itsFile.close();
+     std::remove(itsFileName.c_str());
+     throw;
+  }
+  itsBuffers.clear();
+  ASKAPLOG_DEBUG_STR(logger, "Baseline-major cache: "<<nBaselines()<<" baseline(s) written in "<<itsNBlocks<<
+                     " block(s) of up to "<<itsBlockSize<<" integration(s), "<<itsFileSize<<" bytes in "<<
+                     itsFileName);
+}
+
+/// @brief destructor, removes the cache file
+BaselineMajorCache::~BaselineMajorCache()
+{
+  itsFile.close();
+  std::remove(itsFileName.c_str());
+}
+
+/// @brief obtain the given baseline
+/// @param[in] index baseline index (less than nBaselines)
+/// @return antenna and feed indices
+const BaselineMajorCache::BaselineKey& BaselineMajorCache::baseline(casacore::uInt index) const
+{
+  ASKAPCHECK(index < itsBaselines.size(), "Baseline index "<<index<<" exceeds the number of baselines "<<
+             itsBaselines.size());
+  return itsBaselines[index];
+}
+
+/// @brief number of samples (integrations) of the given baseline
+/// @param[in] index baseline index (less than nBaselines)
+/// @return number of samples
+casacore::uInt BaselineMajorCache::nSamples(casacore::uInt index) const
+{
+  ASKAPCHECK(index < itsSegments.size(), "Baseline index "<<index<<" exceeds the number of baselines "<<
+             itsSegments.size());
+  casacore::uInt result = 0;
+  for (std::vector<Segment>::const_iterator ci = itsSegments[index].begin();
+       ci != itsSegments[index].end(); ++ci) {
+       result += ci->itsNSamples;
+  }
+  return result;
+}
+
+/// @brief read the time series of the given baseline
+/// @details The accessor has one row per sample in time order, antenna and feed indices
+/// are the same for all rows. Fields which are not cached are left empty. The time of
+/// the accessor is that of the first sample.
+/// @param[in] index baseline index (less than nBaselines)
+/// @param[out] acc accessor to fill
+/// @param[out] times time of each sample (row)
+void BaselineMajorCache::read(casacore::uInt index, DataAccessorStub &acc,
+                              casacore::Vector<casacore::Double> &times) const
+{
+  const BaselineKey &key = baseline(index);
+  const casacore::uInt nRow = nSamples(index);
+  const bool useFlag = itsFields & IDataSelector::FLAG;
+  const bool useNoise = itsFields & IDataSelector::NOISE;
+  const bool useUVW = itsFields & IDataSelector::UVW;
+  times.resize(nRow);
+  acc.itsVisibility.resize(nRow, itsNChannel, itsNPol);
+  acc.itsFlag.resize(useFlag ? nRow : 0, itsNChannel, itsNPol);
+  acc.itsNoise.resize(useNoise ? nRow : 0, itsNChannel, itsNPol);
+  acc.itsUVW.resize(useUVW ? nRow : 0);
+  acc.itsAntenna1.resize(nRow);
+  acc.itsAntenna1.set(std::get<0>(key));
+  acc.itsAntenna2.resize(nRow);
+  acc.itsAntenna2.set(std::get<1>(key));
+  acc.itsFeed1.resize(nRow);
+  acc.itsFeed1.set(std::get<2>(key));
+  acc.itsFeed2.resize(nRow);
+  acc.itsFeed2.set(std::get<3>(key));
+  acc.itsFrequency.assign(itsFrequency);
+  acc.itsStokes.assign(itsStokes);
+
+  const size_t nSpectral = size_t(itsNChannel) * itsNPol;
+  Buffer buf;
+  casacore::uInt row = 0;
+  for (std::vector<Segment>::const_iterator ci = itsSegments[index].begin();
+       ci != itsSegments[index].end(); ++ci) {
+       const casacore::uInt n = ci->itsNSamples;
+       buf.itsTimes.resize(n);
+       buf.itsUVW.resize(useUVW ? 3 * n : 0);
+       buf.itsVisibility.resize(n * nSpectral);
+       buf.itsFlag.resize(useFlag ? n * nSpectral : 0);
+       buf.itsNoise.resize(useNoise ? n * nSpectral : 0);
+       {
+         boost::lock_guard<boost::mutex> lock(itsMutex);
+         itsFile.clear();
+         itsFile.seekg(ci->itsOffset);
+         readVector(itsFile, buf.itsTimes);
+         readVector(itsFile, buf.itsUVW);
+         readVector(itsFile, buf.itsVisibility);
+         readVector(itsFile, buf.itsFlag);
+         readVector(itsFile, buf.itsNoise);
+         if (!itsFile) {
+             ASKAPTHROW(DataAccessError, "Unable to read baseline-major cache file "<<itsFileName);
+         }
+       }
+       for (casacore::uInt sample = 0; sample < n; ++sample, ++row) {
+            times[row] = buf.itsTimes[sample];
+            if (useUVW) {
+                for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                     acc.itsUVW[row](dim) = buf.itsUVW[3 * sample + dim];
+                }
+            }
+            for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+                 for (casacore::uInt chan = 0; chan < itsNChannel; ++chan) {
+                      const size_t offset = sample * nSpectral + size_t(pol) * itsNChannel + chan;
+                      acc.itsVisibility(row, chan, pol) = buf.itsVisibility[offset];
+                      if (useFlag) {
+                          acc.itsFlag(row, chan, pol) = buf.itsFlag[offset] != 0;
+                      }
+                      if (useNoise) {
+                          acc.itsNoise(row, chan, pol) = buf.itsNoise[offset];
+                      }
+                 }
+            }
+       }
+  }
+  ASKAPDEBUGASSERT(row == nRow);
+  acc.itsTime = nRow > 0 ? times[0] : 0.;
+}
+
+/// @return fields cached by default (visibilities, flags, noise and uvw)
+casacore::uInt BaselineMajorCache::defaultFields()
+{
+  return IDataSelector::VISIBILITY | IDataSelector::FLAG | IDataSelector::NOISE | IDataSelector::UVW;
+}
+
+/// @brief add the given accessor to the buffers
+/// @param[in] acc accessor to add
+void BaselineMajorCache::add(const IConstDataAccessor &acc)
+{
+  if (itsBaselines.size() == 0 && itsFrequency.nelements() == 0) {
+      itsNChannel = acc.nChannel();
+      itsNPol = acc.nPol();
+      itsFrequency.assign(acc.frequency());
+      itsStokes.assign(acc.stokes());
+  }
+  ASKAPCHECK((acc.nChannel() == itsNChannel) && (acc.nPol() == itsNPol), "Baseline-major cache requires the "
+             "same number of channels and polarisations for all integrations, have "<<acc.nChannel()<<" x "<<
+             acc.nPol()<<" instead of "<<itsNChannel<<" x "<<itsNPol);
+  const casacore::Vector<casacore::Double> &freq = acc.frequency();
+  ASKAPCHECK(freq.nelements() == itsFrequency.nelements(), "Baseline-major cache requires the same spectral "
+             "axis for all integrations, select a single spectral window");
+  for (casacore::uInt chan = 0; chan < freq.nelements(); ++chan) {
+       ASKAPCHECK(freq[chan] == itsFrequency[chan], "Baseline-major cache requires the same spectral axis for "
+                  "all integrations, select a single spectral window");
+  }
+  const bool useFlag = itsFields & IDataSelector::FLAG;
+  const bool useNoise = itsFields & IDataSelector::NOISE;
+  const bool useUVW = itsFields & IDataSelector::UVW;
+  const casacore::Cube<casacore::Complex> &vis = acc.visibility();
+  const casacore::Vector<casacore::uInt> &ant1 = acc.antenna1();
+  const casacore::Vector<casacore::uInt> &ant2 = acc.antenna2();
+  const casacore::Vector<casacore::uInt> &feed1 = acc.feed1();
+  const casacore::Vector<casacore::uInt> &feed2 = acc.feed2();
+  for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+       const BaselineKey key(ant1[row], ant2[row], feed1[row], feed2[row]);
+       const std::map<BaselineKey, casacore::uInt>::const_iterator ci = itsIndices.find(key);
+       casacore::uInt index = 0;
+       if (ci == itsIndices.end()) {
+           index = casacore::uInt(itsBaselines.size());
+           itsIndices[key] = index;
+           itsBaselines.push_back(key);
+           itsSegments.push_back(std::vector<Segment>());
+           itsBuffers.push_back(Buffer());
+       } else {
+           index = ci->second;
+       }
+       Buffer &buf = itsBuffers[index];
+       buf.itsTimes.push_back(acc.time());
+       if (useUVW) {
+           for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                buf.itsUVW.push_back(acc.uvw()[row](dim));
+           }
+       }
+       for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+            for (casacore::uInt chan = 0; chan < itsNChannel; ++chan) {
+                 buf.itsVisibility.push_back(vis(row, chan, pol));
+                 if (useFlag) {
+                     buf.itsFlag.push_back(acc.flag()(row, chan, pol) ? 1 : 0);
+                 }
+                 if (useNoise) {
+                     buf.itsNoise.push_back(acc.noise()(row, chan, pol));
+                 }
+            }
+       }
+  }
+}
+
+/// @brief write the buffers into the file and empty them
+void BaselineMajorCache::flush()
+{
+  if (itsIntegrationsInBlock == 0) {
+      return;
+  }
+  itsFile.clear();
+  itsFile.seekp(itsFileSize);
+  for (size_t index = 0; index < itsBuffers.size(); ++index) {
+       Buffer &buf = itsBuffers[index];
+       if (buf.itsTimes.size() == 0) {
+           continue;
+       }
+       Segment segment;
+       segment.itsOffset = itsFile.tellp();
+       segment.itsNSamples = casacore::uInt(buf.itsTimes.size());
+       writeVector(itsFile, buf.itsTimes);
+       writeVector(itsFile, buf.itsUVW);
+       writeVector(itsFile, buf.itsVisibility);
+       writeVector(itsFile, buf.itsFlag);
+       writeVector(itsFile, buf.itsNoise);
+       if (!itsFile) {
+           ASKAPTHROW(DataAccessError, "Unable to write baseline-major cache file "<<itsFileName);
+       }
+       itsSegments[index].push_back(segment);
+       // the capacity is kept for the next block
+       buf.itsTimes.clear();
+       buf.itsUVW.clear();
+       buf.itsVisibility.clear();
+       buf.itsFlag.clear();
+       buf.itsNoise.clear();
+  }
+  itsFile.flush();
+  itsFileSize = itsFile.tellp();
+  itsIntegrationsInBlock = 0;
+  ++itsNBlocks;
+}
@@ -0,0 +1,227 @@
+/// @file
+///
+/// @brief Baseline-major cache of the visibility data
+/// @details Flaggers and per-baseline solvers need a time series for each baseline,
+/// while the data are iterated in time order. This class transposes the data in a
+/// single streaming pass. Integrations are buffered in memory in blocks of the given
+/// size and each block is written into a temporary file baseline by baseline, so the
+/// memory footprint is bounded by the block size and both the transposition and the
+/// subsequent reading of a baseline are done with sequential I/O.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_BASELINE_MAJOR_CACHE_H
+#define ASKAP_ACCESSORS_BASELINE_MAJOR_CACHE_H
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IDataSelector.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+#include <casacore/measures/Measures/Stokes.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+// std includes
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <fstream>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Baseline-major cache of the visibility data
+/// @details The cache is filled from the given iterator at construction. Baselines, i.e.
+/// (antenna1, antenna2, feed1, feed2) combinations, are numbered in the order of their first
+/// appearance. Up to blockSize integrations (distinct time stamps) are accumulated in memory,
+/// then the samples of each baseline are written as one contiguous segment into a temporary
+/// file in the given directory (e.g. on the node-local SSD). Reading a baseline back therefore
+/// requires one seek per block. The file is removed when the cache is destroyed.
+///
+/// All integrations have to share the same spectral axis (number of channels and polarisations,
+/// frequencies), so the iterator should deliver a single spectral window. Visibilities are always
+/// cached, flags, noise and uvw are cached if requested. The cache is read-only once constructed,
+/// the read method is thread-safe.
+/// @ingroup dataaccess_hlp
+class BaselineMajorCache : public boost::noncopyable {
+public:
+  /// @brief baseline: antenna1, antenna2, feed1, feed2
+  typedef std::tuple<casacore::uInt, casacore::uInt, casacore::uInt, casacore::uInt> BaselineKey;
+
+  /// @brief transpose the data
+  /// @details The iteration is restarted from the beginning and all data are read.
+  /// @param[in] iter iterator to read
+  /// @param[in] directory directory for the cache file
+  /// @param[in] blockSize number of integrations accumulated in memory before they are
+  ///            written to disk
+  /// @param[in] fields accessor fields to cache (bitwise combination of
+  ///            IDataSelector::AccessorFields values)
+  BaselineMajorCache(IConstDataIterator &iter, const std::string &directory = "/tmp",
+                     casacore::uInt blockSize = 64, casacore::uInt fields = defaultFields());
+
+  /// @brief destructor, removes the cache file
+  ~BaselineMajorCache();
+
+  /// @return number of baselines
+  inline casacore::uInt nBaselines() const { return casacore::uInt(itsBaselines.size()); }
+
+  /// @brief obtain the given baseline
+  /// @param[in] index baseline index (less than nBaselines)
+  /// @return antenna and feed indices
+  const BaselineKey& baseline(casacore::uInt index) const;
+
+  /// @brief number of samples (integrations) of the given baseline
+  /// @param[in] index baseline index (less than nBaselines)
+  /// @return number of samples
+  casacore::uInt nSamples(casacore::uInt index) const;
+
+  /// @brief read the time series of the given baseline
+  /// @details The accessor has one row per sample in time order, antenna and feed indices
+  /// are the same for all rows. Fields which are not cached are left empty. The time of
+  /// the accessor is that of the first sample.
+  /// @param[in] index baseline index (less than nBaselines)
+  /// @param[out] acc accessor to fill
+  /// @param[out] times time of each sample (row)
+  void read(casacore::uInt index, DataAccessorStub &acc, casacore::Vector<casacore::Double> &times) const;
+
+  /// @return number of channels
+  inline casacore::uInt nChannel() const { return itsNChannel; }
+
+  /// @return number of polarisations
+  inline casacore::uInt nPol() const { return itsNPol; }
+
+  /// @return number of integrations accumulated in memory before they are written to disk
+  inline casacore::uInt blockSize() const { return itsBlockSize; }
+
+  /// @return number of blocks written
+  inline casacore::uInt nBlocks() const { return itsNBlocks; }
+
+  /// @return fields cached
+  inline casacore::uInt fields() const { return itsFields; }
+
+  /// @return size of the cache file in bytes
+  inline size_t diskUsage() const { return size_t(itsFileSize); }
+
+  /// @return fields cached by default (visibilities, flags, noise and uvw)
+  static casacore::uInt defaultFields();
+
+private:
+  /// @brief samples of one baseline accumulated in memory
+  /// @details The spectral data are stored for nChannel x nPol samples per row
+  /// (channel changes fastest).
+  struct Buffer {
+    /// @brief time of each sample
+    std::vector<casacore::Double> itsTimes;
+    /// @brief uvw of each sample
+    std::vector<casacore::Double> itsUVW;
+    /// @brief visibilities
+    std::vector<casacore::Complex> itsVisibility;
+    /// @brief flags
+    std::vector<char> itsFlag;
+    /// @brief noise
+    std::vector<casacore::Complex> itsNoise;
+  };
+
+  /// @brief contiguous part of the cache file with samples of one baseline
+  struct Segment {
+    /// @brief position in the file
+    std::streamoff itsOffset;
+    /// @brief number of samples
+    casacore::uInt itsNSamples;
+  };
+
+  /// @brief add the given accessor to the buffers
+  /// @param[in] acc accessor to add
+  void add(const IConstDataAccessor &acc);
+
+  /// @brief write the buffers into the file and empty them
+  void flush();
+
+  /// @brief number of integrations accumulated before writing to disk
+  casacore::uInt itsBlockSize;
+
+  /// @brief fields to cache
+  casacore::uInt itsFields;
+
+  /// @brief number of channels
+  casacore::uInt itsNChannel;
+
+  /// @brief number of polarisations
+  casacore::uInt itsNPol;
+
+  /// @brief frequencies
+  casacore::Vector<casacore::Double> itsFrequency;
+
+  /// @brief polarisation types
+  casacore::Vector<casacore::Stokes::StokesTypes> itsStokes;
+
+  /// @brief baselines in the order of the first appearance
+  std::vector<BaselineKey> itsBaselines;
+
+  /// @brief index of each baseline
+  std::map<BaselineKey, casacore::uInt> itsIndices;
+
+  /// @brief file segments of each baseline
+  std::vector<std::vector<Segment> > itsSegments;
+
+  /// @brief samples accumulated for each baseline in the current block
+  std::vector<Buffer> itsBuffers;
+
+  /// @brief number of integrations in the current block
+  casacore::uInt itsIntegrationsInBlock;
+
+  /// @brief number of blocks written
+  casacore::uInt itsNBlocks;
+
+  /// @brief name of the cache file
+  std::string itsFileName;
+
+  /// @brief cache file
+  mutable std::fstream itsFile;
+
+  /// @brief size of the cache file in bytes
+  std::streamoff itsFileSize;
+
+  /// @brief synchronisation lock for file reading
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BASELINE_MAJOR_CACHE_H
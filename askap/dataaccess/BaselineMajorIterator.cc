@@ -0,0 +1,102 @@
+/// @file
+///
+/// @brief Iterator delivering the data in the baseline-major order
+/// @details Each accessor contains the time series of one baseline read from
+/// BaselineMajorCache.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/BaselineMajorIterator.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief setup with the existing cache
+/// @param[in] cache shared pointer to the cache
+BaselineMajorIterator::BaselineMajorIterator(const boost::shared_ptr<BaselineMajorCache const> &cache) :
+      itsCache(cache), itsIndex(0), itsAccessor(false)
+{
+  ASKAPCHECK(itsCache, "An attempt to initialise BaselineMajorIterator with empty shared pointer");
+  init();
+}
+
+/// @brief transpose the given iterator and setup the iteration
+/// @param[in] iter iterator to read in one pass
+/// @param[in] directory directory for the cache file
+/// @param[in] blockSize number of integrations accumulated in memory before they are
+///            written to disk
+/// @param[in] fields accessor fields to cache (bitwise combination of
+///            IDataSelector::AccessorFields values)
+BaselineMajorIterator::BaselineMajorIterator(IConstDataIterator &iter, const std::string &directory,
+                        casacore::uInt blockSize, casacore::uInt fields) :
+      itsCache(new BaselineMajorCache(iter, directory, blockSize, fields)), itsIndex(0), itsAccessor(false)
+{
+  init();
+}
+
+/// @brief restart the iteration from the first baseline
+void BaselineMajorIterator::init()
+{
+  itsIndex = 0;
+  readBaseline();
+}
+
+/// @brief access the time series of the current baseline
+/// @return a reference to the current accessor
+const IConstDataAccessor& BaselineMajorIterator::operator*() const
+{
+  ASKAPCHECK(hasMore(), "BaselineMajorIterator has reached the end of the data");
+  return itsAccessor;
+}
+
+/// @brief checks whether there are more data available
+/// @return true if there are more data available
+casacore::Bool BaselineMajorIterator::hasMore() const throw()
+{
+  return itsIndex < itsCache->nBaselines();
+}
+
+/// @brief advance the iterator one step further
+/// @return True if there are more data (so constructions like
+///         while(it.next()) {} are possible)
+casacore::Bool BaselineMajorIterator::next()
+{
+  if (hasMore()) {
+      ++itsIndex;
+      readBaseline();
+  }
+  return hasMore();
+}
+
+/// @brief read the current baseline if there is one
+void BaselineMajorIterator::readBaseline()
+{
+  if (hasMore()) {
+      itsCache->read(itsIndex, itsAccessor, itsTimes);
+  }
+}
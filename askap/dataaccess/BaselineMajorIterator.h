@@ -0,0 +1,126 @@
+/// @file
+///
+/// @brief Iterator delivering the data in the baseline-major order
+/// @details Each accessor contains the time series of one baseline read from
+/// BaselineMajorCache. This is the natural order for flaggers and per-baseline solvers.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_BASELINE_MAJOR_ITERATOR_H
+#define ASKAP_ACCESSORS_BASELINE_MAJOR_ITERATOR_H
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+#include <askap/dataaccess/BaselineMajorCache.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Iterator delivering the data in the baseline-major order
+/// @details The accessor delivered at each step has one row per integration of a single
+/// baseline, in time order (baselines follow in the order of their first appearance in the
+/// original iteration). The time of the accessor is that of the first sample, times of all
+/// rows are given by the times method. Fields not cached by BaselineMajorCache are empty and
+/// rotatedUVW returns the original uvw. Only one baseline is held in memory at a time.
+///
+/// The cache can be shared between several iterators, e.g. to process baselines in
+/// parallel threads.
+/// @ingroup dataaccess_hlp
+class BaselineMajorIterator : virtual public IConstDataIterator,
+                              public boost::noncopyable
+{
+public:
+  /// @brief setup with the existing cache
+  /// @param[in] cache shared pointer to the cache
+  explicit BaselineMajorIterator(const boost::shared_ptr<BaselineMajorCache const> &cache);
+
+  /// @brief transpose the given iterator and setup the iteration
+  /// @param[in] iter iterator to read in one pass
+  /// @param[in] directory directory for the cache file
+  /// @param[in] blockSize number of integrations accumulated in memory before they are
+  ///            written to disk
+  /// @param[in] fields accessor fields to cache (bitwise combination of
+  ///            IDataSelector::AccessorFields values)
+  BaselineMajorIterator(IConstDataIterator &iter, const std::string &directory = "/tmp",
+                        casacore::uInt blockSize = 64,
+                        casacore::uInt fields = BaselineMajorCache::defaultFields());
+
+  /// @brief restart the iteration from the first baseline
+  virtual void init();
+
+  /// @brief access the time series of the current baseline
+  /// @return a reference to the current accessor
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// @brief checks whether there are more data available
+  /// @return true if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// @brief advance the iterator one step further
+  /// @return True if there are more data (so constructions like
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @return index of the current baseline in the cache
+  inline casacore::uInt baselineIndex() const { return itsIndex; }
+
+  /// @return time of each row of the current accessor
+  inline const casacore::Vector<casacore::Double>& times() const { return itsTimes; }
+
+  /// @return cache this iterator works with
+  inline const BaselineMajorCache& cache() const { return *itsCache; }
+
+private:
+  /// @brief read the current baseline if there is one
+  void readBaseline();
+
+  /// @brief cache to read
+  boost::shared_ptr<BaselineMajorCache const> itsCache;
+
+  /// @brief index of the current baseline
+  casacore::uInt itsIndex;
+
+  /// @brief time of each row
+  casacore::Vector<casacore::Double> itsTimes;
+
+  /// @brief current accessor
+  DataAccessorStub itsAccessor;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BASELINE_MAJOR_ITERATOR_H
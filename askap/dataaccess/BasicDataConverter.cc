@@ -45,6 +45,17 @@
 #include <askap/dataaccess/DirectionConverter.h>
 #include <askap/dataaccess/DopplerConverter.h>
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/measures/Measures/MeasFrame.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <cmath>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -52,12 +63,14 @@ using namespace askap::accessors;
 BasicDataConverter::BasicDataConverter() :
      itsEpochConverter(new EpochConverter),
      itsDirectionConverter(new DirectionConverter),
+     itsDirectionFrame(casacore::MDirection::J2000),
      itsFrequencyConverter(new GenericConverter<casacore::MFrequency>(
                            casacore::MFrequency::Ref(casacore::MFrequency::LSRK),
 			   "GHz")),
      itsVelocityConverter(new GenericConverter<casacore::MRadialVelocity>(
                      casacore::MRadialVelocity::Ref(casacore::MRadialVelocity::LSRK),
-		     "km/s"))
+		     "km/s")),
+     itsFrequencyTolerance(0.), itsInterpolateFrequencies(false)
 {     
 }
 
@@ -92,6 +105,7 @@ void BasicDataConverter::setDirectionFrame(const casacore::MDirection::Ref &ref,
                const casacore::Unit &)
 {
   itsDirectionConverter.reset(new DirectionConverter(ref));
+  itsDirectionFrame = ref;
 }
 
 /// set the reference frame for any frequency
@@ -106,6 +120,10 @@ void BasicDataConverter::setFrequencyFrame(const casacore::MFrequency::Ref &ref,
        const casacore::Unit &unit)
 {
   itsFrequencyConverter.reset(new GenericConverter<casacore::MFrequency>(ref,unit));
+  // cached axes are no longer valid
+  if (itsFrequencyCache) {
+      itsFrequencyCache.reset(new FrequencyAxisCache);
+  }
 }
 
 /// set the reference frame for any velocity
@@ -136,6 +154,30 @@ void BasicDataConverter::setRestFrequency(const casacore::MVFrequency &restFreq)
                             casacore::MDoppler::RADIO));
 }
 
+/// set the epoch tolerance for frequency axis conversion
+/// (e.g. spectral line processing in LSRK frame). Converted axes
+/// are cached and reused for all epochs within the same interval
+/// of the given length.
+/// @param[in] tolerance length of the interval in seconds. Zero means
+///                  that the axis is converted for each epoch exactly
+/// @param[in] interpolate if true, axes are converted at the boundaries
+///                  of the interval and linearly interpolated for
+///                  the intermediate epochs. Otherwise, the axis
+///                  converted for the middle of the interval is used.
+void BasicDataConverter::setFrequencyTolerance(casacore::Double tolerance,
+                   bool interpolate)
+{
+  ASKAPCHECK(tolerance >= 0., "Frequency conversion tolerance is supposed to be non-negative, you have "<<
+             tolerance);
+  itsFrequencyTolerance = tolerance;
+  itsInterpolateFrequencies = interpolate;
+  if (tolerance > 0.) {
+      itsFrequencyCache.reset(new FrequencyAxisCache);
+  } else {
+      itsFrequencyCache.reset();
+  }
+}
+
 
 /// set a frame (time, position), where the conversion is performed
 void BasicDataConverter::setMeasFrame(const casacore::MeasFrame &frame)
@@ -160,6 +202,7 @@ bool BasicDataConverter::isVoid(const casacore::MFrequency::Ref &testRef,
 /// @return epoch converted to Double 
 casacore::Double BasicDataConverter::epoch(const casacore::MEpoch &in) const
 {
+  DataAccessStatistics::ScopedTimer timer("BasicDataConverter::epoch");
   return (*itsEpochConverter)(in);
 }
 
@@ -179,23 +222,150 @@ casacore::MEpoch BasicDataConverter::epochMeasure(const casacore::MVEpoch &in) c
   return itsEpochConverter->toMeasure(in);
 }
 
+/// @brief convert a number of epochs in one go
+/// @param[in] in input epochs
+/// @param[in] inRef reference frame of the input epochs
+/// @param[out] out epochs converted to Double (resized as necessary)
+void BasicDataConverter::epochs(const casacore::Vector<casacore::MVEpoch> &in,
+                                const casacore::MEpoch::Ref &inRef,
+                                casacore::Vector<casacore::Double> &out) const
+{
+  DataAccessStatistics::ScopedTimer timer("BasicDataConverter::epochs");
+  itsEpochConverter->convert(in, inRef, out);
+  timer.addBytes(out.nelements() * sizeof(casacore::Double));
+}
+
 /// convert directions
 /// @param in input direction given as an MDirection object
 /// @param out direction as an MVDirection object
 void BasicDataConverter::direction(const casacore::MDirection &in,
                       casacore::MVDirection &out) const
 {
+  DataAccessStatistics::ScopedTimer timer("BasicDataConverter::direction");
   out=(*itsDirectionConverter)(in);
 }
 
+/// @brief convert a number of directions in one go
+/// @param[in] in input directions
+/// @param[in] inRef reference frame of the input directions
+/// @param[out] out converted directions (resized as necessary)
+void BasicDataConverter::directions(const casacore::Vector<casacore::MVDirection> &in,
+                                    const casacore::MDirection::Ref &inRef,
+                                    casacore::Vector<casacore::MVDirection> &out) const
+{
+  DataAccessStatistics::ScopedTimer timer("BasicDataConverter::directions");
+  itsDirectionConverter->convert(in, inRef, out);
+  timer.addBytes(out.nelements() * sizeof(casacore::MVDirection));
+}
+
+/// @brief obtain the reference frame for directions
+/// @return reference frame all directions are converted to
+const casacore::MDirection::Ref& BasicDataConverter::directionFrame() const
+{
+  return itsDirectionFrame;
+}
+
 /// convert frequencies
 /// @param in input frequency given as an MFrequency object
 /// @return output frequency as a Double
 casacore::Double BasicDataConverter::frequency(const casacore::MFrequency &in) const
 {
+  DataAccessStatistics::ScopedTimer timer("BasicDataConverter::frequency");
   return (*itsFrequencyConverter)(in);
 }
 
+/// @brief convert a frequency axis
+/// @details All channels are converted with the same conversion engine. 
+/// The converted axes can be cached (see setFrequencyTolerance).
+/// The antenna position is assumed to be the same for all calls with the same
+/// axisID.
+/// @param[in] axisID identifier of the input axis (e.g. spectral window ID),
+///            a negative value disables caching
+/// @param[in] in input frequencies
+/// @param[in] inRef reference frame of the input frequencies
+/// @param[in] inUnit units of the input frequencies
+/// @param[in] epoch epoch of the conversion
+/// @param[in] pos position of the observer
+/// @param[in] dir direction of interest
+/// @param[out] out converted frequencies (resized as necessary)
+void BasicDataConverter::frequencies(casacore::Int axisID, const casacore::Vector<casacore::Double> &in,
+                   const casacore::MFrequency::Ref &inRef, const casacore::Unit &inUnit,
+                   const casacore::MEpoch &epoch, const casacore::MPosition &pos,
+                   const casacore::MDirection &dir, casacore::Vector<casacore::Double> &out) const
+{
+  // hits and misses of the axis cache are counted in cachedAxis
+  DataAccessStatistics::ScopedTimer timer("BasicDataConverter::frequencies");
+  if (!itsFrequencyCache || axisID < 0) {
+      itsFrequencyConverter->setMeasFrame(casacore::MeasFrame(epoch, pos, dir));
+      itsFrequencyConverter->convert(in, inRef, inUnit, out);
+      timer.addBytes(out.nelements() * sizeof(casacore::Double));
+      return;
+  }
+  ASKAPDEBUGASSERT(itsFrequencyTolerance > 0.);
+  const casacore::Double time = epoch.getValue().get() * 86400.;
+  const casacore::Double startTime = std::floor(time / itsFrequencyTolerance) * itsFrequencyTolerance;
+  const casacore::MEpoch::Ref &epochRef = epoch.getRef();
+  if (itsInterpolateFrequencies) {
+      const casacore::Vector<casacore::Double> startAxis = cachedAxis(axisID, in, inRef, inUnit,
+                                      startTime, epochRef, pos, dir);
+      const casacore::Vector<casacore::Double> stopAxis = cachedAxis(axisID, in, inRef, inUnit,
+                                      startTime + itsFrequencyTolerance, epochRef, pos, dir);
+      ASKAPDEBUGASSERT(startAxis.nelements() == stopAxis.nelements());
+      const casacore::Double weight = (time - startTime) / itsFrequencyTolerance;
+      out.resize(startAxis.nelements());
+      for (casacore::uInt ch = 0; ch < out.nelements(); ++ch) {
+           out[ch] = startAxis[ch] + weight * (stopAxis[ch] - startAxis[ch]);
+      }
+  } else {
+      out.assign(cachedAxis(axisID, in, inRef, inUnit, startTime + itsFrequencyTolerance / 2., 
+                            epochRef, pos, dir));
+  }
+  timer.addBytes(out.nelements() * sizeof(casacore::Double));
+}
+
+/// @brief obtain the converted axis for the given time
+/// @details The axis is taken from the cache or converted and cached.
+/// @param[in] axisID identifier of the input axis
+/// @param[in] in input frequencies
+/// @param[in] inRef reference frame of the input frequencies
+/// @param[in] inUnit units of the input frequencies
+/// @param[in] time time (in seconds) of the conversion
+/// @param[in] epochRef reference frame of the epoch
+/// @param[in] pos position of the observer
+/// @param[in] dir direction of interest
+/// @return converted frequencies
+casacore::Vector<casacore::Double> BasicDataConverter::cachedAxis(casacore::Int axisID, 
+                   const casacore::Vector<casacore::Double> &in,
+                   const casacore::MFrequency::Ref &inRef, const casacore::Unit &inUnit,
+                   casacore::Double time, const casacore::MEpoch::Ref &epochRef,
+                   const casacore::MPosition &pos, const casacore::MDirection &dir) const
+{
+  ASKAPDEBUGASSERT(itsFrequencyCache);
+  const casacore::Vector<casacore::Double> dirAngles = dir.getValue().get();
+  ASKAPDEBUGASSERT(dirAngles.nelements() == 2);
+  const FrequencyAxisCache::Key key(axisID, in.nelements(), in.nelements() ? in[0] : 0., 
+                   inRef.getType(), dirAngles[0], dirAngles[1], time);
+  // the lock also protects the frequency converter, which may be shared between clones
+  boost::lock_guard<boost::mutex> lock(itsFrequencyCache->itsMutex);
+  std::map<FrequencyAxisCache::Key, casacore::Vector<casacore::Double> >::const_iterator ci = 
+                   itsFrequencyCache->itsAxes.find(key);
+  if (ci != itsFrequencyCache->itsAxes.end()) {
+      DataAccessStatistics::countHit("BasicDataConverter::frequencies");
+      return ci->second;
+  }
+  DataAccessStatistics::countMiss("BasicDataConverter::frequencies");
+  // limit memory footprint, a typical job uses only a few axes at a time
+  if (itsFrequencyCache->itsAxes.size() >= 4096) {
+      itsFrequencyCache->itsAxes.clear();
+  }
+  const casacore::MEpoch epoch(casacore::MVEpoch(casacore::Quantity(time, "s")), epochRef);
+  itsFrequencyConverter->setMeasFrame(casacore::MeasFrame(epoch, pos, dir));
+  casacore::Vector<casacore::Double> result;
+  itsFrequencyConverter->convert(in, inRef, inUnit, result);
+  itsFrequencyCache->itsAxes[key].reference(result);
+  return result;
+}
+
 /// convert velocities
 /// @param in input velocities given as an MRadialVelocity object
 /// @return out output velocity as a Double
@@ -32,6 +32,12 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+
+// std includes
+#include <map>
 
 // CASA includes
 #include <casacore/measures/Measures/MFrequency.h>
@@ -140,6 +146,19 @@ public:
     ///
     virtual void setRestFrequency(const casacore::MVFrequency &restFreq);
 
+    /// set the epoch tolerance for frequency axis conversion
+    /// (e.g. spectral line processing in LSRK frame). Converted axes
+    /// are cached and reused for all epochs within the same interval
+    /// of the given length.
+    /// @param[in] tolerance length of the interval in seconds. Zero means
+    ///                  that the axis is converted for each epoch exactly
+    /// @param[in] interpolate if true, axes are converted at the boundaries
+    ///                  of the interval and linearly interpolated for
+    ///                  the intermediate epochs. Otherwise, the axis
+    ///                  converted for the middle of the interval is used.
+    virtual void setFrequencyTolerance(casacore::Double tolerance,
+                   bool interpolate = false);
+
     /// set a frame (for epochs it is just a position), where the
     /// conversion is performed
     /// @param[in] frame measure's frame object
@@ -163,12 +182,32 @@ public:
     /// @return epoch converted to Measure
     virtual casacore::MEpoch epochMeasure(const casacore::MVEpoch &in) const;
 
+    /// @brief convert a number of epochs in one go
+    /// @param[in] in input epochs
+    /// @param[in] inRef reference frame of the input epochs
+    /// @param[out] out epochs converted to Double (resized as necessary)
+    virtual void epochs(const casacore::Vector<casacore::MVEpoch> &in,
+                        const casacore::MEpoch::Ref &inRef,
+                        casacore::Vector<casacore::Double> &out) const;
+
     /// convert directions
     /// @param[in] in input direction given as an MDirection object
     /// @param[out] out output direction as an MVDirection object
     virtual void direction(const casacore::MDirection &in, 
                           casacore::MVDirection &out) const;
 
+    /// @brief convert a number of directions in one go
+    /// @param[in] in input directions
+    /// @param[in] inRef reference frame of the input directions
+    /// @param[out] out converted directions (resized as necessary)
+    virtual void directions(const casacore::Vector<casacore::MVDirection> &in,
+                            const casacore::MDirection::Ref &inRef,
+                            casacore::Vector<casacore::MVDirection> &out) const;
+
+    /// @brief obtain the reference frame for directions
+    /// @return reference frame all directions are converted to
+    virtual const casacore::MDirection::Ref& directionFrame() const;
+
     /// test whether the frequency conversion is void
     /// @param[in] testRef reference frame to test
     /// @param[in] testUnit units to test
@@ -180,6 +219,25 @@ public:
     /// @return output frequency as a Double
     virtual casacore::Double frequency(const casacore::MFrequency &in) const;
 
+    /// @brief convert a frequency axis
+    /// @details All channels are converted with the same conversion engine. 
+    /// The converted axes can be cached (see setFrequencyTolerance).
+    /// The antenna position is assumed to be the same for all calls with the same
+    /// axisID.
+    /// @param[in] axisID identifier of the input axis (e.g. spectral window ID),
+    ///            a negative value disables caching
+    /// @param[in] in input frequencies
+    /// @param[in] inRef reference frame of the input frequencies
+    /// @param[in] inUnit units of the input frequencies
+    /// @param[in] epoch epoch of the conversion
+    /// @param[in] pos position of the observer
+    /// @param[in] dir direction of interest
+    /// @param[out] out converted frequencies (resized as necessary)
+    virtual void frequencies(casacore::Int axisID, const casacore::Vector<casacore::Double> &in,
+                   const casacore::MFrequency::Ref &inRef, const casacore::Unit &inUnit,
+                   const casacore::MEpoch &epoch, const casacore::MPosition &pos,
+                   const casacore::MDirection &dir, casacore::Vector<casacore::Double> &out) const;
+
     /// convert velocities
     /// @param[in] in input velocities given as an MRadialVelocity object
     /// @return output velocity as a Double
@@ -222,13 +280,49 @@ public:
     virtual boost::shared_ptr<IDataConverterImpl> clone() const;  
     
 private:
+    /// @brief cache of converted frequency axes
+    /// @details The key is made of the axis ID, number of channels, the first frequency, 
+    /// the input frame type, direction (longitude and latitude) and time (in seconds)
+    /// the axis has been converted for. The cache is shared between clones of
+    /// the converter as long as the frequency frame and tolerance are unchanged.
+    struct FrequencyAxisCache {
+       /// @brief key type
+       typedef boost::tuple<casacore::Int, casacore::uInt, casacore::Double, casacore::uInt,
+                            casacore::Double, casacore::Double, casacore::Double> Key;
+       /// @brief cached axes
+       std::map<Key, casacore::Vector<casacore::Double> > itsAxes;
+       /// @brief synchronisation lock
+       boost::mutex itsMutex;
+    };
+
+    /// @brief obtain the converted axis for the given time
+    /// @details The axis is taken from the cache or converted and cached.
+    /// @param[in] axisID identifier of the input axis
+    /// @param[in] in input frequencies
+    /// @param[in] inRef reference frame of the input frequencies
+    /// @param[in] inUnit units of the input frequencies
+    /// @param[in] time time (in seconds) of the conversion
+    /// @param[in] epochRef reference frame of the epoch
+    /// @param[in] pos position of the observer
+    /// @param[in] dir direction of interest
+    /// @return converted frequencies
+    casacore::Vector<casacore::Double> cachedAxis(casacore::Int axisID, 
+                   const casacore::Vector<casacore::Double> &in,
+                   const casacore::MFrequency::Ref &inRef, const casacore::Unit &inUnit,
+                   casacore::Double time, const casacore::MEpoch::Ref &epochRef,
+                   const casacore::MPosition &pos, const casacore::MDirection &dir) const;
+
     boost::shared_ptr<IEpochConverter>      itsEpochConverter;
     boost::shared_ptr<IDirectionConverter>  itsDirectionConverter;
+    casacore::MDirection::Ref               itsDirectionFrame;
     boost::shared_ptr<GenericConverter<casacore::MFrequency> >
                                             itsFrequencyConverter;
     boost::shared_ptr<GenericConverter<casacore::MRadialVelocity> >
                                             itsVelocityConverter;
     boost::shared_ptr<IDopplerConverter>    itsDopplerConverter;
+    casacore::Double                        itsFrequencyTolerance;
+    bool                                    itsInterpolateFrequencies;
+    boost::shared_ptr<FrequencyAxisCache>   itsFrequencyCache;
 };
   
 } // namespace accessors
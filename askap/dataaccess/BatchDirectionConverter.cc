@@ -0,0 +1,161 @@
+/// @file
+///
+/// @brief Direction converter reusing the frame and conversion engine
+/// @details This class keeps one frame, which is updated in place when the epoch or
+/// the position change, and one conversion engine per input reference frame.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/BatchDirectionConverter.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct the converter
+/// @param[in] targetFrame reference frame to convert directions to
+BatchDirectionConverter::BatchDirectionConverter(const casacore::MDirection::Ref &targetFrame) :
+      itsTargetType(casacore::MDirection::castType(targetFrame.getType())),
+      itsEpochSet(false), itsPositionSet(false) {}
+
+/// @brief set the epoch of the conversion
+/// @param[in] epoch epoch to use
+void BatchDirectionConverter::setEpoch(const casacore::MEpoch &epoch)
+{
+  if (itsEpochSet) {
+      itsFrame.resetEpoch(epoch);
+  } else {
+      itsFrame.set(epoch);
+      itsEpochSet = true;
+  }
+}
+
+/// @brief set the position of the observer
+/// @param[in] pos position to use (e.g. antenna location)
+void BatchDirectionConverter::setPosition(const casacore::MPosition &pos)
+{
+  if (itsPositionSet) {
+      itsFrame.resetPosition(pos);
+  } else {
+      itsFrame.set(pos);
+      itsPositionSet = true;
+  }
+}
+
+/// @brief convert the given direction to the target frame
+/// @param[in] in direction to convert
+/// @return converted direction
+casacore::MVDirection BatchDirectionConverter::operator()(const casacore::MDirection &in) const
+{
+  return converter(in.getRef())(in).getValue();
+}
+
+/// @brief convert a number of directions in one go
+/// @details All directions are given in the same frame and converted with the
+/// same engine for the current epoch and position.
+/// @param[in] in directions to convert
+/// @param[in] inRef reference frame of the input directions
+/// @param[out] out converted directions (resized as necessary)
+void BatchDirectionConverter::convert(const casacore::Vector<casacore::MVDirection> &in,
+              const casacore::MDirection::Ref &inRef, casacore::Vector<casacore::MVDirection> &out) const
+{
+  out.resize(in.nelements());
+  if (in.nelements() == 0) {
+      return;
+  }
+  casacore::MDirection::Convert &engine = converter(inRef);
+  for (casacore::uInt i = 0; i < in.nelements(); ++i) {
+       out[i] = engine(in[i]).getValue();
+  }
+}
+
+/// @brief check whether the conversion depends on the observer position
+/// @details This is the case if either the input or the target frame is 
+/// topocentric (e.g. AZEL, HADEC). Otherwise, the result is the same for all antennas
+/// and the position need not be set.
+/// @param[in] inRef reference frame of the input directions
+/// @return true, if the position is required
+bool BatchDirectionConverter::needsPosition(const casacore::MDirection::Ref &inRef) const
+{
+  if (inRef.offset() != 0 || !inRef.getFrame().empty()) {
+      // be conservative, the offset may be given in a topocentric frame
+      return true;
+  }
+  return isTopocentric(itsTargetType) || isTopocentric(inRef.getType());
+}
+
+/// @brief obtain the conversion engine for the given input frame
+/// @param[in] inRef reference frame of the input directions
+/// @return reference to the engine, valid until the next call
+casacore::MDirection::Convert& BatchDirectionConverter::converter(const casacore::MDirection::Ref &inRef) const
+{
+  ASKAPDEBUGASSERT(itsEpochSet);
+  if (inRef.offset() != 0 || !inRef.getFrame().empty()) {
+      // the engine depends on more than just the type of the input frame
+      itsUncachedConverter = casacore::MDirection::Convert(inRef, casacore::MDirection::Ref(itsTargetType, 
+                  itsFrame));
+      return itsUncachedConverter;
+  }
+  std::map<casacore::uInt, casacore::MDirection::Convert>::iterator it = itsConverters.find(inRef.getType());
+  if (it == itsConverters.end()) {
+      // the engine refers to itsFrame, so it picks up the changes of epoch and position
+      it = itsConverters.insert(std::make_pair(inRef.getType(), casacore::MDirection::Convert(inRef, 
+                casacore::MDirection::Ref(itsTargetType, itsFrame)))).first;
+  }
+  return it->second;
+}
+
+/// @brief check whether the given frame type is topocentric
+/// @param[in] type frame type
+/// @return true, if conversion to or from this frame requires the position
+bool BatchDirectionConverter::isTopocentric(casacore::uInt type)
+{
+  switch (casacore::MDirection::castType(type)) {
+     case casacore::MDirection::HADEC:
+     case casacore::MDirection::AZEL:
+     case casacore::MDirection::AZELSW:
+     case casacore::MDirection::AZELGEO:
+     case casacore::MDirection::AZELSWGEO:
+     case casacore::MDirection::TOPO:
+     case casacore::MDirection::ITRF:
+          return true;
+     default:
+          return false;
+  }
+}
+
+/// @brief compute the parallactic angle
+/// @details This is the position angle of the celestial pole with respect
+/// to the given direction measured in the target frame (which should be AZEL).
+/// @param[in] dir direction of interest
+/// @return parallactic angle in radians
+casacore::Double BatchDirectionConverter::parallacticAngle(const casacore::MDirection &dir) const
+{
+  casacore::MDirection celestialPole;
+  celestialPole.set(casacore::MDirection::Ref(casacore::MDirection::HADEC));
+  return (*this)(dir).positionAngle((*this)(celestialPole));
+}
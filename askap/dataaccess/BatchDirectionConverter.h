@@ -0,0 +1,141 @@
+/// @file
+///
+/// @brief Direction converter reusing the frame and conversion engine
+/// @details DirectionConverter sets up a new conversion engine for each direction
+/// converted and the iterator builds a new measure frame for each antenna. This class
+/// keeps one frame, which is updated in place when the epoch or the position change,
+/// and one conversion engine per input reference frame. It is intended to convert
+/// directions for all antennas or beams at a given epoch in one go.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_BATCH_DIRECTION_CONVERTER_H
+#define ASKAP_ACCESSORS_BATCH_DIRECTION_CONVERTER_H
+
+// casa includes
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MCDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/measures/Measures/MPosition.h>
+#include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/measures/Measures/MeasConvert.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// std includes
+#include <map>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Direction converter reusing the frame and conversion engine
+/// @details The frame has to be given the epoch via setEpoch before any conversion.
+/// The position is optional, it is only required for frames like AZEL or HADEC.
+/// The conversion engine is cached for input directions without their own frame or
+/// offset (e.g. directions read from the FIELD table). Other directions are converted
+/// with a temporary engine.
+/// @note Measures conversions are not thread-safe, an object of this class 
+/// should not be shared between threads.
+/// @ingroup dataaccess_conv
+class BatchDirectionConverter {
+public:
+  /// @brief construct the converter
+  /// @param[in] targetFrame reference frame to convert directions to
+  explicit BatchDirectionConverter(const casacore::MDirection::Ref &targetFrame);
+
+  /// @brief set the epoch of the conversion
+  /// @param[in] epoch epoch to use
+  void setEpoch(const casacore::MEpoch &epoch);
+
+  /// @brief set the position of the observer
+  /// @param[in] pos position to use (e.g. antenna location)
+  void setPosition(const casacore::MPosition &pos);
+
+  /// @brief convert the given direction to the target frame
+  /// @param[in] in direction to convert
+  /// @return converted direction
+  casacore::MVDirection operator()(const casacore::MDirection &in) const;
+
+  /// @brief convert a number of directions in one go
+  /// @details All directions are given in the same frame and converted with the
+  /// same engine for the current epoch and position.
+  /// @param[in] in directions to convert
+  /// @param[in] inRef reference frame of the input directions
+  /// @param[out] out converted directions (resized as necessary)
+  void convert(const casacore::Vector<casacore::MVDirection> &in, const casacore::MDirection::Ref &inRef,
+               casacore::Vector<casacore::MVDirection> &out) const;
+
+  /// @brief check whether the conversion depends on the observer position
+  /// @details This is the case if either the input or the target frame is 
+  /// topocentric (e.g. AZEL, HADEC). Otherwise, the result is the same for all antennas
+  /// and the position need not be set.
+  /// @param[in] inRef reference frame of the input directions
+  /// @return true, if the position is required
+  bool needsPosition(const casacore::MDirection::Ref &inRef) const;
+
+  /// @brief compute the parallactic angle
+  /// @details This is the position angle of the celestial pole with respect
+  /// to the given direction measured in the target frame (which should be AZEL).
+  /// @param[in] dir direction of interest
+  /// @return parallactic angle in radians
+  casacore::Double parallacticAngle(const casacore::MDirection &dir) const;
+
+private:
+  /// @brief obtain the conversion engine for the given input frame
+  /// @param[in] inRef reference frame of the input directions
+  /// @return reference to the engine, valid until the next call
+  casacore::MDirection::Convert& converter(const casacore::MDirection::Ref &inRef) const;
+
+  /// @brief check whether the given frame type is topocentric
+  /// @param[in] type frame type
+  /// @return true, if conversion to or from this frame requires the position
+  static bool isTopocentric(casacore::uInt type);
+
+  /// @brief target frame type
+  casacore::MDirection::Types itsTargetType;
+
+  /// @brief measure frame shared by all conversion engines
+  casacore::MeasFrame itsFrame;
+
+  /// @brief true, if epoch has been set in the frame
+  bool itsEpochSet;
+
+  /// @brief true, if position has been set in the frame
+  bool itsPositionSet;
+
+  /// @brief conversion engines for each input frame type
+  mutable std::map<casacore::uInt, casacore::MDirection::Convert> itsConverters;
+
+  /// @brief engine for input frames with their own frame or offset
+  mutable casacore::MDirection::Convert itsUncachedConverter;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BATCH_DIRECTION_CONVERTER_H
@@ -48,6 +48,79 @@ using namespace askap::accessors;
 
 ASKAP_LOGGER(logger,".casaAccessors")
 
+namespace {
+
+/// @brief sums of the least-squares problem for w=Au+Bv
+struct PlaneFitSums {
+   /// @brief sum of u-squared
+   double su2;
+   /// @brief sum of v-squared
+   double sv2;
+   /// @brief sum of uv-products
+   double suv;
+   /// @brief sum of uw-products
+   double suw;
+   /// @brief sum of vw-products
+   double svw;
+
+   /// @brief solve the normal equations
+   /// @details We need a non-zero determinant for a successful fitting, some tolerance
+   /// has to be put on the determinant to avoid unconstrained fits.
+   /// @param[out] coeffA fit coefficient A (unchanged if the fit is not possible)
+   /// @param[out] coeffB fit coefficient B (unchanged if the fit is not possible)
+   /// @return true if the fit has been done
+   bool solve(double &coeffA, double &coeffB) const {
+      const double D = su2 * sv2 - casacore::square(suv);
+      if (fabs(D) < 1e-7) {
+          return false;
+      }
+      coeffA = (sv2 * suw - suv * svw) / D;
+      coeffB = (su2 * svw - suv * suw) / D;
+      return true;
+   }
+};
+
+/// @brief accumulate the sums and find the largest deviation in one pass
+/// @details This is a fused kernel computing both the sums of the least-squares
+/// problem (to fit a new plane) and the largest deviation of w from the given plane,
+/// so the uvw buffer is only traversed once. The loop works with plain local variables,
+/// so the compiler can vectorise it.
+/// @param[in] uvw a vector with uvw's
+/// @param[in] coeffA coefficient A of the plane to compute the deviation from
+/// @param[in] coeffB coefficient B of the plane to compute the deviation from
+/// @param[out] sums sums of the least-squares problem
+/// @return the largest w-term deviation from the given plane (same units as uvw's)
+double accumulatePlaneFit(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw,
+                          const double coeffA, const double coeffB, PlaneFitSums &sums)
+{
+   double su2 = 0., sv2 = 0., suv = 0., suw = 0., svw = 0.;
+   double maxDeviation = 0.;
+   bool deleteIt = false;
+   const casacore::RigidVector<casacore::Double, 3> *data = uvw.getStorage(deleteIt);
+   const size_t nRows = uvw.nelements();
+   for (size_t row = 0; row < nRows; ++row) {
+        const double u = data[row](0);
+        const double v = data[row](1);
+        const double w = data[row](2);
+        su2 += u * u;
+        sv2 += v * v;
+        suv += u * v;
+        suw += u * w;
+        svw += v * w;
+        const double deviation = fabs(coeffA * u + coeffB * v - w);
+        maxDeviation = deviation > maxDeviation ? deviation : maxDeviation;
+   }
+   uvw.freeStorage(data, deleteIt);
+   sums.su2 = su2;
+   sums.sv2 = sv2;
+   sums.suv = suv;
+   sums.suw = suw;
+   sums.svw = svw;
+   return maxDeviation;
+}
+
+} // anonymous namespace
+
 /// @brief constructor
 /// @details The only parameter is the w-term tolerance in wavelengths
 /// If the deviation from the fitted plane exceeds the tolerance, a new
@@ -59,7 +132,8 @@ ASKAP_LOGGER(logger,".casaAccessors")
 /// in the constructor call itself.
 BestWPlaneDataAccessor::BestWPlaneDataAccessor(const double tolerance, const bool checkResidual) : itsCheckResidual(checkResidual), 
        itsWTolerance(tolerance),
-       itsCoeffA(0.), itsCoeffB(0.), itsUVWChangeMonitor(changeMonitor()), itsPredictWPlane(false)
+       itsCoeffA(0.), itsCoeffB(0.), itsUVWChangeMonitor(changeMonitor()), itsPredictWPlane(false),
+       itsPredictTimeInterval(10.)
 {
    
 }
@@ -70,8 +144,10 @@ BestWPlaneDataAccessor::BestWPlaneDataAccessor(const double tolerance, const boo
 BestWPlaneDataAccessor::BestWPlaneDataAccessor(const BestWPlaneDataAccessor &other) : 
     itsCheckResidual(other.itsCheckResidual), itsWTolerance(other.itsWTolerance), itsCoeffA(other.itsCoeffA),
     itsCoeffB(other.itsCoeffB), itsUVWChangeMonitor(changeMonitor()), itsPlaneChangeMonitor(changeMonitor()),
-    itsRotatedUVW(other.itsRotatedUVW.copy()), itsLastTangentPoint(other.itsLastTangentPoint),
-    itsPredictWPlane(other.itsPredictWPlane), itsPredictTimeInterval(other.itsPredictTimeInterval) {}
+    itsRotatedUVW(other.itsRotatedUVW.copy()), itsRotatedUVWBounds(other.itsRotatedUVWBounds),
+    itsLastTangentPoint(other.itsLastTangentPoint),
+    itsPredictWPlane(other.itsPredictWPlane), itsPredictTimeInterval(other.itsPredictTimeInterval),
+    itsPlaneSchedule(other.itsPlaneSchedule) {}
 
 /// @brief assignment operator
 /// @details We need it because we have data members of non-trivial types
@@ -86,9 +162,11 @@ BestWPlaneDataAccessor& BestWPlaneDataAccessor::operator=(const BestWPlaneDataAc
       itsUVWChangeMonitor.notifyOfChanges();
       itsPlaneChangeMonitor.notifyOfChanges();
       itsRotatedUVW.assign(other.itsRotatedUVW.copy());
+      itsRotatedUVWBounds = other.itsRotatedUVWBounds;
       itsLastTangentPoint = other.itsLastTangentPoint;
       itsPredictWPlane = other.itsPredictWPlane;
       itsPredictTimeInterval = other.itsPredictTimeInterval;
+      itsPlaneSchedule = other.itsPlaneSchedule;
   }
   return *this;
 }
@@ -139,7 +217,13 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
    
    double maxDeviation = 0.;
    
-   if (itsPredictWPlane == false) {
+   if (itsPlaneSchedule) {
+       ASKAPCHECK(UVWMachineCache::compare(tangentPoint,itsPlaneSchedule->tangent(),1e-6),
+           "The w-plane schedule has been computed for the tangent point="<<itsPlaneSchedule->tangent()<<
+           ", rotatedUVW got "<<tangentPoint);
+       maxDeviation = updatePlaneFromSchedule(originalUVW);
+   }
+   else if (itsPredictWPlane == false) {
        maxDeviation = updatePlaneIfNecessary(originalUVW, tolInMetres);
    }
    else {
@@ -152,17 +236,31 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
    }
 
     
+   itsRotatedUVWBounds.reset();
    for (casacore::uInt row=0; row<originalUVW.nelements(); ++row) {
         const casacore::RigidVector<casacore::Double, 3> currentUVW = originalUVW[row];
         itsRotatedUVW[row] = currentUVW;
         // subtract the current plane
         itsRotatedUVW[row](2) -= coeffA()*currentUVW(0) + coeffB()*currentUVW(1);
+        itsRotatedUVWBounds.add(currentUVW(0), currentUVW(1), itsRotatedUVW[row](2));
    }
    
 
    return itsRotatedUVW;
 }	         
 
+/// @brief bounding box of uvw after rotation
+/// @details The bounds correspond to the w coordinates with the best plane subtracted
+/// (i.e. to the output of rotatedUVW). They are computed in the same pass which
+/// subtracts the plane.
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return bounding box of rotated uvw
+UVWBounds BestWPlaneDataAccessor::rotatedUVWBounds(const casacore::MDirection &tangentPoint) const
+{
+   rotatedUVW(tangentPoint);
+   return itsRotatedUVWBounds;
+}
+
 /// @brief calculate the largest deviation from the current fitted plane
 /// @details This helper method iterates through the given uvw's and returns
 /// the largest deviation of the w-term from the current best fit plane.
@@ -173,18 +271,77 @@ double BestWPlaneDataAccessor::maxWDeviation(const casacore::Vector<casacore::Ri
    double maxDeviation = 0.;
 
    // we fit w=Au+Bv, the following lines compute the largest deviation from the current plane.
-
-   for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-        const casacore::RigidVector<casacore::Double, 3> currentUVW = uvw[row];
-        const double deviation = fabs(coeffA()*currentUVW(0) + coeffB()*currentUVW(1) - currentUVW(2));
-        if (deviation > maxDeviation) {
-            maxDeviation = deviation;
-        }
+   const double coeffA = itsCoeffA;
+   const double coeffB = itsCoeffB;
+   bool deleteIt = false;
+   const casacore::RigidVector<casacore::Double, 3> *data = uvw.getStorage(deleteIt);
+   const size_t nRows = uvw.nelements();
+   for (size_t row=0; row<nRows; ++row) {
+        const double deviation = fabs(coeffA*data[row](0) + coeffB*data[row](1) - data[row](2));
+        maxDeviation = deviation > maxDeviation ? deviation : maxDeviation;
    }
+   uvw.freeStorage(data, deleteIt);
    
    return maxDeviation;
 }
 
+/// @brief walk the uvw track once and record all plane changes
+/// @details The given iterator is run to the end and the planes are fitted the same way
+/// rotatedUVW does with the settings of this adapter. Each plane is recorded with the
+/// time of the first accessor it is used for. The state of this adapter is not changed.
+/// @param[in] it iterator over the data, it is advanced to the end
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return shared pointer to the schedule
+boost::shared_ptr<WPlaneSchedule> BestWPlaneDataAccessor::precomputePlaneSchedule(IConstDataIterator &it,
+                        const casacore::MDirection &tangentPoint) const
+{
+   // a fresh adapter with the same settings fits planes from scratch
+   BestWPlaneDataAccessor fitter(itsWTolerance, itsCheckResidual);
+   fitter.itsPredictWPlane = itsPredictWPlane;
+   fitter.itsPredictTimeInterval = itsPredictTimeInterval;
+   boost::shared_ptr<WPlaneSchedule> schedule(new WPlaneSchedule(tangentPoint));
+   scimath::ChangeMonitor cm = fitter.planeChangeMonitor();
+   for (; it.hasMore(); it.next()) {
+        fitter.associate(*it);
+        fitter.rotatedUVW(tangentPoint);
+        if ((schedule->size() == 0) || (cm != fitter.planeChangeMonitor())) {
+            schedule->add(it->time(), fitter.coeffA(), fitter.coeffB());
+            cm = fitter.planeChangeMonitor();
+        }
+   }
+   fitter.detach();
+   ASKAPLOG_DEBUG_STR(logger, "BestWPlaneDataAccessor::precomputePlaneSchedule: "<<schedule->size()<<
+                      " plane(s) for the tangent point "<<tangentPoint);
+   return schedule;
+}
+
+/// @brief use precomputed planes instead of fitting
+/// @details An empty shared pointer returns to fitting planes as the data are accessed.
+/// @param[in] schedule shared pointer to the schedule (see precomputePlaneSchedule)
+void BestWPlaneDataAccessor::setPlaneSchedule(const boost::shared_ptr<WPlaneSchedule const> &schedule)
+{
+   itsPlaneSchedule = schedule;
+   // force the update of rotated uvw's
+   itsUVWChangeMonitor.notifyOfChanges();
+}
+
+/// @brief take the plane from the schedule
+/// @details The coefficients are set to those of the plane in effect at the time of the
+/// associated accessor, planeChangeMonitor() is updated if they change.
+/// @param[in] uvw a vector with uvw's
+/// @return the largest w-term deviation from the plane (same units as uvw's)
+double BestWPlaneDataAccessor::updatePlaneFromSchedule(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw) const
+{
+   ASKAPDEBUGASSERT(itsPlaneSchedule);
+   const size_t plane = itsPlaneSchedule->planeIndex(getROAccessor().time());
+   if ((itsCoeffA != itsPlaneSchedule->coeffA(plane)) || (itsCoeffB != itsPlaneSchedule->coeffB(plane))) {
+       itsCoeffA = itsPlaneSchedule->coeffA(plane);
+       itsCoeffB = itsPlaneSchedule->coeffB(plane);
+       itsPlaneChangeMonitor.notifyOfChanges();
+   }
+   return itsCheckResidual ? maxWDeviation(uvw) : 0.;
+}
+
 /// @brief Fit a new plane assuming this is a continuous track and update coefficients if neccessary.
 /// @details A best fit plane for the current time can be found with UpdatePlaneIfNecessary ... which minimises the maxW now
 /// But this method instead minimises sometime in the future - so that we are currently at tolerance
@@ -209,7 +366,10 @@ double BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary(double toleran
    double tmpCoeffA = 0.0;
    double tmpCoeffB = 0.0;
 
-   double AdvancedDeviation = maxWDeviation(uvw); // using current plane
+   // we fit w=Au+Bv, the sums of the LSF problem are accumulated in the same pass
+   // as the largest deviation from the current plane is computed
+   PlaneFitSums sums;
+   double AdvancedDeviation = accumulatePlaneFit(uvw, itsCoeffA, itsCoeffB, sums); // using current plane
    
    if (verbose) {
        ASKAPLOG_INFO_STR(logger, "BestWPlaneDataAccessor::On entry current deviation (using the current plane) " << AdvancedDeviation << " tolerance " << tolerance);
@@ -222,39 +382,14 @@ double BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary(double toleran
     
    // we are out of our tolerance range - get a new plane
    // First thing we should do is use the existing update plane to get a plane that minimises W-deviation
-   // This fragment breaks the rules of code-reuse - but means I dont have to worry about the changemonitor picking this up
-   // we fit w=Au+Bv, the following lines accumulate the necessary sums of the LSF problem
-       
-   double su2 = 0.; // sum of u-squared
-   double sv2 = 0.; // sum of v-squared
-   double suv = 0.; // sum of uv-products
-   double suw = 0.; // sum of uw-products
-   double svw = 0.; // sum of vw-products
-       
-   for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-       const casacore::RigidVector<casacore::Double, 3> currentUVW = uvw[row];
-           
-       su2 += casacore::square(currentUVW(0));
-       sv2 += casacore::square(currentUVW(1));
-       suv += currentUVW(0) * currentUVW(1);
-       suw += currentUVW(0) * currentUVW(2);
-       svw += currentUVW(1) * currentUVW(2);
-   }
-       
-   // we need a non-zero determinant for a successful fitting
-   // some tolerance has to be put on the determinant to avoid unconstrained fits
+   // The sums have already been accumulated, solving into local coefficients means
+   // I dont have to worry about the changemonitor picking this up
    // we just accept the current fit results if the new fit is not possible
-   double D = su2 * sv2 - casacore::square(suv);
-       
-   if (fabs(D) < 1e-7) {
+   if (!sums.solve(tmpCoeffA, tmpCoeffB)) {
        ASKAPLOG_INFO_STR(logger, "BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary::Matrix has almost 0 determinant fit not likely to be valid");
        return AdvancedDeviation;
    }
        
-   // make an update to the coefficients
-   tmpCoeffA = (sv2 * suw - suv * svw) / D;
-   tmpCoeffB = (su2 * svw - suv * suw) / D;
-       
        
    // this fragment basically replicates the maxDeviation functionality
      
@@ -315,35 +450,14 @@ double BestWPlaneDataAccessor::updateAdvancedTimePlaneIfNecessary(double toleran
        const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&advanced_uvw = acc.rotatedUVW(newTangentPoint);
        
      // we fit w=Au+Bv, the following lines accumulate the necessary sums of the LSF problem
+       // (the deviation computed along the way is not needed here)
+       accumulatePlaneFit(advanced_uvw, itsCoeffA, itsCoeffB, sums);
        
-       su2 = 0.; // sum of u-squared
-       sv2 = 0.; // sum of v-squared
-       suv = 0.; // sum of uv-products
-       suw = 0.; // sum of uw-products
-       svw = 0.; // sum of vw-products
-       
-       for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-           const casacore::RigidVector<casacore::Double, 3> currentUVW = advanced_uvw[row];
-           
-           su2 += casacore::square(currentUVW(0));
-           sv2 += casacore::square(currentUVW(1));
-           suv += currentUVW(0) * currentUVW(1);
-           suw += currentUVW(0) * currentUVW(2);
-           svw += currentUVW(1) * currentUVW(2);
-       }
-       
-       // we need a non-zero determinant for a successful fitting
-       // some tolerance has to be put on the determinant to avoid unconstrained fits
        // we just accept the current fit results if the new fit is not possible
-       D = su2 * sv2 - casacore::square(suv);
-       
-       if (fabs(D) < 1e-7) {
+       if (!sums.solve(itsCoeffA, itsCoeffB)) {
            return on_exit_deviation;
        }
        
-       // make an update to the coefficients
-       itsCoeffA = (sv2 * suw - suv * svw) / D;
-       itsCoeffB = (su2 * svw - suv * suw) / D;
        itsPlaneChangeMonitor.notifyOfChanges();
    
    } while (on_exit_deviation > tolerance);
@@ -376,7 +490,10 @@ double BestWPlaneDataAccessor::updatePlaneIfNecessary(const casacore::Vector<cas
                  double tolerance) const
 {
 
-   const double maxDeviation = maxWDeviation(uvw);
+   // we fit w=Au+Bv, the sums of the LSF problem are accumulated in the same pass
+   // as the largest deviation from the current plane is computed
+   PlaneFitSums sums;
+   const double maxDeviation = accumulatePlaneFit(uvw, itsCoeffA, itsCoeffB, sums);
     
    // we need at least two rows for a successful fitting, don't bother doing anything if the
    // number of rows is too small or the deviation is below the tolerance
@@ -384,36 +501,11 @@ double BestWPlaneDataAccessor::updatePlaneIfNecessary(const casacore::Vector<cas
        return maxDeviation;
    }
    
-   // we fit w=Au+Bv, the following lines accumulate the necessary sums of the LSF problem
-   
-   double su2 = 0.; // sum of u-squared
-   double sv2 = 0.; // sum of v-squared
-   double suv = 0.; // sum of uv-products
-   double suw = 0.; // sum of uw-products
-   double svw = 0.; // sum of vw-products
-   
-   for (casacore::uInt row=0; row<uvw.nelements(); ++row) {
-        const casacore::RigidVector<casacore::Double, 3> currentUVW = uvw[row];
-
-        su2 += casacore::square(currentUVW(0));
-        sv2 += casacore::square(currentUVW(1));
-        suv += currentUVW(0) * currentUVW(1);
-        suw += currentUVW(0) * currentUVW(2);
-        svw += currentUVW(1) * currentUVW(2);                
-   }
-   
-   // we need a non-zero determinant for a successful fitting
-   // some tolerance has to be put on the determinant to avoid unconstrained fits
    // we just accept the current fit results if the new fit is not possible
-   const double D = su2 * sv2 - casacore::square(suv);
-
-   if (fabs(D) < 1e-7) {
+   if (!sums.solve(itsCoeffA, itsCoeffB)) {
        return maxDeviation;
    }
 
-   // make an update to the coefficients
-   itsCoeffA = (sv2 * suw - suv * svw) / D;
-   itsCoeffB = (su2 * svw - suv * suw) / D;
    itsPlaneChangeMonitor.notifyOfChanges();
   
    return maxWDeviation(uvw);
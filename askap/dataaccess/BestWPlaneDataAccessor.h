@@ -41,8 +41,13 @@
 
 // own includes
 #include <askap/dataaccess/DataAccessorAdapter.h>
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/WPlaneSchedule.h>
 #include <askap/scimath/utils/ChangeMonitor.h>
 
+// boost includes
+#include <boost/shared_ptr.hpp>
+
 
 namespace askap {
 
@@ -91,6 +96,14 @@ public:
    /// the required tolerance on w-term cannot be met.
    virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
 	         rotatedUVW(const casacore::MDirection &tangentPoint) const;
+
+   /// @brief bounding box of uvw after rotation
+   /// @details The bounds correspond to the w coordinates with the best plane subtracted
+   /// (i.e. to the output of rotatedUVW). They are computed in the same pass which
+   /// subtracts the plane.
+   /// @param[in] tangentPoint tangent point to rotate the coordinates to
+   /// @return bounding box of rotated uvw
+   virtual UVWBounds rotatedUVWBounds(const casacore::MDirection &tangentPoint) const;
    
    // fitted plane parameters
    
@@ -120,6 +133,33 @@ public:
    inline void setPredictWPlaneMode(const double timeinterval=10.0) {
        itsPredictWPlane = true; itsPredictTimeInterval = timeinterval;}
 
+   /// @brief walk the uvw track once and record all plane changes
+   /// @details The given iterator is run to the end and the planes are fitted the same way
+   /// rotatedUVW does with the settings of this adapter (tolerance, predict mode). Each
+   /// plane is recorded with the time of the first accessor it is used for. Only uvw's,
+   /// pointing directions and frequencies are accessed, so the iterator can be set up to
+   /// read just these fields (see IDataSelector::chooseAccessorFields). The state of this
+   /// adapter is not changed.
+   /// @param[in] it iterator over the data, it is advanced to the end
+   /// @param[in] tangentPoint tangent point to rotate the coordinates to
+   /// @return shared pointer to the schedule
+   /// @note An exception is thrown if the residual is checked and the required tolerance
+   /// on w-term cannot be met.
+   boost::shared_ptr<WPlaneSchedule> precomputePlaneSchedule(IConstDataIterator &it,
+                        const casacore::MDirection &tangentPoint) const;
+
+   /// @brief use precomputed planes instead of fitting
+   /// @details If the schedule is set, rotatedUVW takes the coefficients from the schedule
+   /// for the time of the associated accessor and no fitting is done. The plane change
+   /// monitor is updated when the coefficients change. An empty shared pointer returns
+   /// to fitting planes as the data are accessed.
+   /// @param[in] schedule shared pointer to the schedule (see precomputePlaneSchedule)
+   void setPlaneSchedule(const boost::shared_ptr<WPlaneSchedule const> &schedule);
+
+   /// @brief obtain the schedule of planes
+   /// @return shared pointer to the schedule, empty if planes are fitted as the data are accessed
+   inline const boost::shared_ptr<WPlaneSchedule const>& planeSchedule() const { return itsPlaneSchedule;}
+
 protected:
 
    /// @brief fit a new plane and update coefficients if necessary
@@ -166,6 +206,13 @@ protected:
    /// @param[in] uvw a vector with uvw's
    /// @return the largest w-term deviation from the current plane (same units as uvw's)
    double maxWDeviation(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw) const;
+
+   /// @brief take the plane from the schedule
+   /// @details The coefficients are set to those of the plane in effect at the time of the
+   /// associated accessor, planeChangeMonitor() is updated if they change.
+   /// @param[in] uvw a vector with uvw's
+   /// @return the largest w-term deviation from the plane (same units as uvw's)
+   double updatePlaneFromSchedule(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw) const;
    
   
 private:
@@ -200,6 +247,9 @@ private:
       
    /// @brief buffer for rotated UVW vector with corrected w
    mutable casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsRotatedUVW;   
+
+   /// @brief bounding box of itsRotatedUVW
+   mutable UVWBounds itsRotatedUVWBounds;
    
    /// @brief last tangent point
    /// @details This field is added just to be able to do extra checks
@@ -213,6 +263,9 @@ private:
     
    /// @brief The time interval between assesments of the predicted W Plane
    double itsPredictTimeInterval;
+
+   /// @brief precomputed planes, empty if planes are fitted as the data are accessed
+   boost::shared_ptr<WPlaneSchedule const> itsPlaneSchedule;
 };
 
 } // namespace accessors
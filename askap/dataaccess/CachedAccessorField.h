@@ -12,6 +12,7 @@
 #define ASKAP_ACCESSORS_CACHED_ACCESSOR_FIELD_H
 
 #include <askap/askap/AskapError.h>
+#include <askap/dataaccess/ArraySwap.h>
 
 // boost includes
 #ifdef _OPENMP
@@ -48,6 +49,34 @@ struct CachedAccessorField  {
   /// @param[in] other an object to copy from
   /// @note reference semantics for casa arrays, but we're not using this method where T is a casa array type. 
   CachedAccessorField<T>& operator=(const CachedAccessorField<T> &other);
+
+  /// @brief move constructor
+  /// @details The cached value changes hands without a deep copy (see swapValues), 
+  /// the other object becomes invalid.
+  /// @param[in] other an object to move from
+  CachedAccessorField(CachedAccessorField<T> &&other);
+
+  /// @brief move assignment
+  /// @details The cached value changes hands without a deep copy (see swapValues), 
+  /// the other object becomes invalid.
+  /// @param[in] other an object to move from
+  CachedAccessorField<T>& operator=(CachedAccessorField<T> &&other);
+
+  /// @brief replace the cached value by the given one without copying
+  /// @details This method allows to set the cache from a buffer filled elsewhere. The field 
+  /// becomes valid as if it had been read. The previous content of the cache is returned
+  /// in the buffer, so its storage can be reused.
+  /// @param[in] buffer value to take over, previous value of the cache on exit
+  /// @note an exception is thrown if the cache needs flush
+  void swapIn(T &buffer);
+
+  /// @brief give away the cached value without copying
+  /// @details This method allows to take over the cached value (e.g. by an adapter).
+  /// The field becomes invalid, the buffer content on input is kept by the cache to
+  /// be reused by the next read on-demand.
+  /// @param[in] buffer buffer to receive the value, its previous content goes into the cache
+  /// @note an exception is thrown if the read operation is required or if the cache needs flush
+  void swapOut(T &buffer);
   
   /// @brief access the data, read on-demand
   /// @details On the first request and whenever is necessary, this method reads the data using 
@@ -152,6 +152,83 @@ CachedAccessorField<T>& CachedAccessorField<T>::operator=(const CachedAccessorFi
   return *this;
 }
 
+/// @brief move constructor
+/// @details The cached value changes hands without a deep copy (see swapValues), 
+/// the other object becomes invalid.
+/// @param[in] other an object to move from
+template<class T>
+CachedAccessorField<T>::CachedAccessorField(CachedAccessorField<T> &&other) : itsChangedFlag(true),
+        itsFlushFlag(false)
+{
+#ifdef _OPENMP
+  boost::unique_lock<boost::shared_mutex> otherLock(other.itsMutex);
+#endif
+  itsChangedFlag = other.itsChangedFlag;
+  itsFlushFlag = other.itsFlushFlag;
+  swapValues(itsValue, other.itsValue);
+  other.itsChangedFlag = true;
+  other.itsFlushFlag = false;
+}
+
+/// @brief move assignment
+/// @details The cached value changes hands without a deep copy (see swapValues), 
+/// the other object becomes invalid.
+/// @param[in] other an object to move from
+template<class T>
+CachedAccessorField<T>& CachedAccessorField<T>::operator=(CachedAccessorField<T> &&other)
+{
+  if (&other != this) {
+
+#ifdef _OPENMP
+      boost::unique_lock<boost::shared_mutex> otherLock(other.itsMutex);
+      boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+
+      itsChangedFlag = other.itsChangedFlag;
+      itsFlushFlag = other.itsFlushFlag;
+      // the other object gets the old buffer, it can be reused on the next read
+      swapValues(itsValue, other.itsValue);
+      other.itsChangedFlag = true;
+      other.itsFlushFlag = false;
+  }
+  return *this;
+}
+
+/// @brief replace the cached value by the given one without copying
+/// @details This method allows to set the cache from a buffer filled elsewhere. The field 
+/// becomes valid as if it had been read. The previous content of the cache is returned
+/// in the buffer, so its storage can be reused.
+/// @param[in] buffer value to take over, previous value of the cache on exit
+/// @note an exception is thrown if the cache needs flush
+template<class T>
+void CachedAccessorField<T>::swapIn(T &buffer)
+{
+#ifdef _OPENMP
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+  ASKAPCHECK(!itsFlushFlag, "An attempt to replace the cached value when the cache needs flush, this is most likely a logical error");
+  swapValues(itsValue, buffer);
+  itsChangedFlag = false;
+}
+
+/// @brief give away the cached value without copying
+/// @details This method allows to take over the cached value (e.g. by an adapter).
+/// The field becomes invalid, the buffer content on input is kept by the cache to
+/// be reused by the next read on-demand.
+/// @param[in] buffer buffer to receive the value, its previous content goes into the cache
+/// @note an exception is thrown if the read operation is required or if the cache needs flush
+template<class T>
+void CachedAccessorField<T>::swapOut(T &buffer)
+{
+#ifdef _OPENMP
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+  ASKAPCHECK(!itsChangedFlag, "An attempt to take over the cached value when read operation is required, most likely a logical error");
+  ASKAPCHECK(!itsFlushFlag, "An attempt to take over the cached value when the cache needs flush, this is most likely a logical error");
+  swapValues(itsValue, buffer);
+  itsChangedFlag = true;
+}
+
 /// @brief invalidate the field
 template<class T>
 inline void CachedAccessorField<T>::invalidate() const throw()
@@ -0,0 +1,145 @@
+/// @file
+///
+/// @brief Const iterator taking visibilities and flags from VisibilityCache
+/// @details The first iteration over the given selection fills the cache,
+/// all following iterations take visibilities and flags from the cache.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/CachedTableConstDataIterator.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <sstream>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor of the const iterator
+/// @param[in] msManager a manager of the measurement set to use
+/// @param[in] sel shared pointer to selector
+/// @param[in] conv shared pointer to converter
+/// @param[in] cache visibility cache to use (should be validated by the caller)
+/// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+/// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
+/// to initialisation of a new UVW Machine
+/// @param[in] maxChunkSize maximum number of rows per accessor
+/// @param[in] maxChannelBlock maximum number of spectral channels per accessor, 0 means
+/// no restriction
+/// @param[in] tableMutex mutex serialising access to the table (a new mutex is created
+/// if an empty shared pointer is given)
+CachedTableConstDataIterator::CachedTableConstDataIterator(
+            const boost::shared_ptr<ITableManager const> &msManager,
+            const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
+            const boost::shared_ptr<IDataConverterImpl const> &conv,
+            const boost::shared_ptr<VisibilityCache> &cache,
+            size_t cacheSize, double tolerance, casacore::uInt maxChunkSize,
+            casacore::uInt maxChannelBlock,
+            const boost::shared_ptr<boost::recursive_mutex> &tableMutex) :
+         TableInfoAccessor(msManager),
+         // reading ahead would defeat the purpose of the cache
+         TableConstDataIterator(msManager, sel, conv, cacheSize, tolerance, maxChunkSize,
+                                false, maxChannelBlock, tableMutex),
+         itsCache(cache), itsAccessorIndex(0)
+{
+  ASKAPCHECK(itsCache, "CachedTableConstDataIterator is initialised with empty visibility cache");
+}
+
+/// Restart the iteration from the beginning
+void CachedTableConstDataIterator::init()
+{
+  TableConstDataIterator::init();
+  itsAccessorIndex = 0;
+}
+
+/// advance the iterator one step further
+/// @return True if there are more data (so constructions like
+///         while(it.next()) {} are possible)
+casacore::Bool CachedTableConstDataIterator::next()
+{
+  ++itsAccessorIndex;
+  return TableConstDataIterator::next();
+}
+
+/// populate the buffer of visibilities with the values of current
+/// iteration
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+void CachedTableConstDataIterator::fillVisibility(casacore::Cube<casacore::Complex> &vis) const
+{
+  checkAccessorField(IDataSelector::VISIBILITY, "visibility");
+  const std::string key = currentKey("VIS");
+  if (!itsCache->getVisibility(key, vis)) {
+      TableConstDataIterator::fillVisibility(vis);
+      itsCache->addVisibility(key, vis);
+  } else {
+      updateVisibilityChecksum(vis);
+  }
+  ASKAPDEBUGASSERT((vis.nrow() == nRow()) && (vis.ncolumn() == nChannel()) && (vis.nplane() == nPol()));
+}
+
+/// @brief read flagging information
+/// @param[in] flag a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the flag information (each element has
+///            bool type)
+void CachedTableConstDataIterator::fillFlag(casacore::Cube<casacore::Bool> &flag) const
+{
+  checkAccessorField(IDataSelector::FLAG, "flag");
+  const std::string key = currentKey("FLAG");
+  if (!itsCache->getFlag(key, flag)) {
+      TableConstDataIterator::fillFlag(flag);
+      itsCache->addFlag(key, flag);
+  } else {
+      updateFlagChecksum(flag);
+      updateChunkSummary(flag);
+  }
+  ASKAPDEBUGASSERT((flag.nrow() == nRow()) && (flag.ncolumn() == nChannel()) && (flag.nplane() == nPol()));
+}
+
+/// @brief obtain the key of the current accessor
+/// @param[in] field name of the field (to distinguish visibilities from flags)
+/// @return string identifying the current accessor in the cache
+std::string CachedTableConstDataIterator::currentKey(const std::string &field) const
+{
+  casacore::rownr_t firstRow = 0;
+  {
+    boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+    if (nRow() > 0) {
+        // row numbers in the root table
+        firstRow = getCurrentIteration().rowNumbers()[getCurrentTopRow()];
+    }
+  }
+  const std::pair<casacore::uInt, casacore::uInt> chanRange = getChannelRange();
+  std::ostringstream os;
+  os<<field<<":"<<(field == "FLAG" ? std::string("FLAG") : getDataColumnName())<<":"<<getSelectionKey()<<
+      ":"<<itsAccessorIndex<<":"<<firstRow<<":"<<nRow()<<":"<<chanRange.second<<":"<<chanRange.first<<
+      ":"<<channelAveraging();
+  return os.str();
+}
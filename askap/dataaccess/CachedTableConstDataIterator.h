@@ -0,0 +1,119 @@
+/// @file
+///
+/// @brief Const iterator taking visibilities and flags from VisibilityCache
+/// @details This iterator is created by TableConstDataSource if the visibility
+/// cache is enabled. The first iteration over the given selection fills the cache,
+/// all following iterations take visibilities and flags from the cache.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_CACHED_TABLE_CONST_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_CACHED_TABLE_CONST_DATA_ITERATOR_H
+
+// own includes
+#include <askap/dataaccess/TableConstDataIterator.h>
+#include <askap/dataaccess/VisibilityCache.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Const iterator taking visibilities and flags from VisibilityCache
+/// @details Each accessor is identified by the selection, the data column, its sequence
+/// number since init, the first row it covers (in the measurement set) and the channel
+/// range, so iterators with the same selection share the cached data, while any other
+/// iterator doesn't match. Visibilities delivered by this iterator are always quantised,
+/// including the first iteration which fills the cache. Such an iterator doesn't read
+/// ahead. All other fields are read from the measurement set as usual.
+/// @ingroup dataaccess_tab
+class CachedTableConstDataIterator : public TableConstDataIterator {
+public:
+  /// @brief constructor of the const iterator
+  /// @param[in] msManager a manager of the measurement set to use
+  /// @param[in] sel shared pointer to selector
+  /// @param[in] conv shared pointer to converter
+  /// @param[in] cache visibility cache to use (should be validated by the caller)
+  /// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+  /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
+  /// to initialisation of a new UVW Machine
+  /// @param[in] maxChunkSize maximum number of rows per accessor
+  /// @param[in] maxChannelBlock maximum number of spectral channels per accessor, 0 means
+  /// no restriction
+  /// @param[in] tableMutex mutex serialising access to the table (a new mutex is created
+  /// if an empty shared pointer is given)
+  CachedTableConstDataIterator(const boost::shared_ptr<ITableManager const> &msManager,
+              const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
+              const boost::shared_ptr<IDataConverterImpl const> &conv,
+              const boost::shared_ptr<VisibilityCache> &cache,
+              size_t cacheSize = 1, double tolerance = 1e-6,
+              casacore::uInt maxChunkSize = INT_MAX, casacore::uInt maxChannelBlock = 0,
+              const boost::shared_ptr<boost::recursive_mutex> &tableMutex =
+                    boost::shared_ptr<boost::recursive_mutex>());
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// advance the iterator one step further
+  /// @return True if there are more data (so constructions like
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// populate the buffer of visibilities with the values of current
+  /// iteration
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  virtual void fillVisibility(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief read flagging information
+  /// @param[in] flag a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the flag information (each element has
+  ///            bool type)
+  virtual void fillFlag(casacore::Cube<casacore::Bool> &flag) const;
+
+private:
+  /// @brief obtain the key of the current accessor
+  /// @param[in] field name of the field (to distinguish visibilities from flags)
+  /// @return string identifying the current accessor in the cache
+  std::string currentKey(const std::string &field) const;
+
+  /// @brief visibility cache
+  boost::shared_ptr<VisibilityCache> itsCache;
+
+  /// @brief number of accessors delivered since init
+  casacore::uInt itsAccessorIndex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CACHED_TABLE_CONST_DATA_ITERATOR_H
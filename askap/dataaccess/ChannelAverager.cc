@@ -0,0 +1,289 @@
+/// @file
+///
+/// @brief Averaging of the cubes along the spectral axis
+/// @details The table-based iterator reads full spectral resolution from the table and
+/// averages adjacent channels when the accessor is filled. This class holds the reductions.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/ChannelAverager.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <vector>
+#include <cmath>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief check the shape of the input and set up the output
+/// @param[in] in input cube
+/// @param[in] nAvg number of adjacent channels to average
+/// @param[out] out output cube, resized if necessary
+template<typename In, typename Out>
+void setUpOutput(const casacore::Cube<In> &in, casacore::uInt nAvg, casacore::Cube<Out> &out)
+{
+  ASKAPCHECK(nAvg > 0, "Number of channels to average should be positive");
+  ASKAPCHECK(in.ncolumn() % nAvg == 0, "Unable to average "<<in.ncolumn()<<" channels by "<<nAvg<<
+             ", the number of channels has to be a multiple of the averaging factor");
+  const casacore::IPosition shape(3, in.nrow(), in.ncolumn() / nAvg, in.nplane());
+  if (!out.shape().isEqual(shape)) {
+      out.resize(shape);
+  }
+}
+
+/// @brief weighted reduction of one group of channels for all rows
+/// @details The sums are accumulated separately for unflagged samples and for all samples,
+/// the latter is used when all samples of the group are flagged.
+struct Accumulator {
+  explicit Accumulator(casacore::uInt nRow) : itsSum(nRow), itsWeight(nRow), itsAllSum(nRow),
+           itsAllWeight(nRow) {}
+
+  /// @brief reset the sums
+  void reset() {
+      std::fill(itsSum.begin(), itsSum.end(), 0.);
+      std::fill(itsWeight.begin(), itsWeight.end(), 0.);
+      std::fill(itsAllSum.begin(), itsAllSum.end(), 0.);
+      std::fill(itsAllWeight.begin(), itsAllWeight.end(), 0.);
+  }
+
+  /// @brief add one channel
+  /// @param[in] value values to add, nRow elements, may be stepped for complex data
+  /// @param[in] step step between values
+  /// @param[in] weight weights, nRow elements, zero pointer means unit weights
+  /// @param[in] flag flags, nRow elements
+  void add(const float *value, size_t step, const float *weight, const bool *flag) {
+      const size_t nRow = itsSum.size();
+      float *sum = &itsSum[0];
+      float *wt = &itsWeight[0];
+      float *allSum = &itsAllSum[0];
+      float *allWt = &itsAllWeight[0];
+      for (size_t row = 0; row < nRow; ++row) {
+           const float w = weight == 0 ? 1.f : weight[row];
+           const float wf = flag[row] ? 0.f : w;
+           const float v = value[row * step];
+           sum[row] += wf * v;
+           wt[row] += wf;
+           allSum[row] += w * v;
+           allWt[row] += w;
+      }
+  }
+
+  std::vector<float> itsSum;
+  std::vector<float> itsWeight;
+  std::vector<float> itsAllSum;
+  std::vector<float> itsAllWeight;
+};
+
+/// @brief convert noise into weights
+/// @param[in] sigma noise values, nRow elements, may be stepped for complex data
+/// @param[in] step step between values
+/// @param[in] nRow number of rows
+/// @param[out] weight 1/sigma^2 (zero for non-positive sigma)
+void noiseToWeight(const float *sigma, size_t step, size_t nRow, std::vector<float> &weight)
+{
+  weight.resize(nRow);
+  for (size_t row = 0; row < nRow; ++row) {
+       const float s = sigma[row * step];
+       weight[row] = s > 0.f ? 1.f / (s * s) : 0.f;
+  }
+}
+
+} // anonymous namespace
+
+/// @brief average visibilities
+/// @param[in] vis input cube
+/// @param[in] flag input flags (same shape as vis)
+/// @param[in] noise input noise (same shape as vis), empty cube means equal weights
+/// @param[in] nAvg number of adjacent channels to average, has to divide the number of channels
+/// @param[out] out output cube (resized if its shape doesn't match)
+void ChannelAverager::averageVisibility(const casacore::Cube<casacore::Complex> &vis,
+                              const casacore::Cube<casacore::Bool> &flag,
+                              const casacore::Cube<casacore::Complex> &noise, casacore::uInt nAvg,
+                              casacore::Cube<casacore::Complex> &out)
+{
+  ASKAPCHECK(flag.shape().isEqual(vis.shape()), "Flag cube shape "<<flag.shape()<<
+             " doesn't match the visibility cube shape "<<vis.shape());
+  const bool weighted = noise.nelements() > 0;
+  ASKAPCHECK(!weighted || noise.shape().isEqual(vis.shape()), "Noise cube shape "<<noise.shape()<<
+             " doesn't match the visibility cube shape "<<vis.shape());
+  setUpOutput(vis, nAvg, out);
+  const casacore::uInt nRow = vis.nrow();
+  const casacore::uInt nChan = out.ncolumn();
+  if (vis.nelements() == 0) {
+      return;
+  }
+  bool deleteVis, deleteFlag, deleteNoise = false, deleteOut;
+  const casacore::Complex *visData = vis.getStorage(deleteVis);
+  const casacore::Bool *flagData = flag.getStorage(deleteFlag);
+  const casacore::Complex *noiseData = weighted ? noise.getStorage(deleteNoise) : 0;
+  casacore::Complex *outData = out.getStorage(deleteOut);
+  Accumulator re(nRow), im(nRow);
+  std::vector<float> weightRe, weightIm;
+  for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            re.reset();
+            im.reset();
+            for (casacore::uInt k = 0; k < nAvg; ++k) {
+                 const size_t offset = (size_t(pol) * vis.ncolumn() + chan * nAvg + k) * nRow;
+                 const float *visPtr = reinterpret_cast<const float*>(visData + offset);
+                 if (weighted) {
+                     const float *noisePtr = reinterpret_cast<const float*>(noiseData + offset);
+                     noiseToWeight(noisePtr, 2, nRow, weightRe);
+                     noiseToWeight(noisePtr + 1, 2, nRow, weightIm);
+                 }
+                 re.add(visPtr, 2, weighted ? &weightRe[0] : 0, flagData + offset);
+                 im.add(visPtr + 1, 2, weighted ? &weightIm[0] : 0, flagData + offset);
+            }
+            casacore::Complex *outPtr = outData + (size_t(pol) * nChan + chan) * nRow;
+            for (casacore::uInt row = 0; row < nRow; ++row) {
+                 const float outRe = re.itsWeight[row] > 0.f ? re.itsSum[row] / re.itsWeight[row] :
+                          (re.itsAllWeight[row] > 0.f ? re.itsAllSum[row] / re.itsAllWeight[row] : 0.f);
+                 const float outIm = im.itsWeight[row] > 0.f ? im.itsSum[row] / im.itsWeight[row] :
+                          (im.itsAllWeight[row] > 0.f ? im.itsAllSum[row] / im.itsAllWeight[row] : 0.f);
+                 outPtr[row] = casacore::Complex(outRe, outIm);
+            }
+       }
+  }
+  vis.freeStorage(visData, deleteVis);
+  flag.freeStorage(flagData, deleteFlag);
+  if (weighted) {
+      noise.freeStorage(noiseData, deleteNoise);
+  }
+  out.putStorage(outData, deleteOut);
+}
+
+/// @brief average flags
+/// @details The output is flagged if all input samples are flagged
+/// @param[in] flag input flags
+/// @param[in] nAvg number of adjacent channels to average, has to divide the number of channels
+/// @param[out] out output cube (resized if its shape doesn't match)
+void ChannelAverager::averageFlag(const casacore::Cube<casacore::Bool> &flag, casacore::uInt nAvg,
+                        casacore::Cube<casacore::Bool> &out)
+{
+  setUpOutput(flag, nAvg, out);
+  const casacore::uInt nRow = flag.nrow();
+  const casacore::uInt nChan = out.ncolumn();
+  if (flag.nelements() == 0) {
+      return;
+  }
+  bool deleteIn, deleteOut;
+  const casacore::Bool *inData = flag.getStorage(deleteIn);
+  casacore::Bool *outData = out.getStorage(deleteOut);
+  for (casacore::uInt pol = 0; pol < flag.nplane(); ++pol) {
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            casacore::Bool *outPtr = outData + (size_t(pol) * nChan + chan) * nRow;
+            const casacore::Bool *inPtr = inData + (size_t(pol) * flag.ncolumn() + chan * nAvg) * nRow;
+            std::copy(inPtr, inPtr + nRow, outPtr);
+            for (casacore::uInt k = 1; k < nAvg; ++k) {
+                 inPtr += nRow;
+                 for (casacore::uInt row = 0; row < nRow; ++row) {
+                      outPtr[row] = outPtr[row] && inPtr[row];
+                 }
+            }
+       }
+  }
+  flag.freeStorage(inData, deleteIn);
+  out.putStorage(outData, deleteOut);
+}
+
+/// @brief obtain noise of the averaged visibilities
+/// @details Real and imaginary parts are processed separately.
+/// @param[in] noise input noise
+/// @param[in] flag input flags (same shape as noise)
+/// @param[in] nAvg number of adjacent channels to average, has to divide the number of channels
+/// @param[out] out output cube (resized if its shape doesn't match)
+void ChannelAverager::averageNoise(const casacore::Cube<casacore::Complex> &noise,
+                         const casacore::Cube<casacore::Bool> &flag, casacore::uInt nAvg,
+                         casacore::Cube<casacore::Complex> &out)
+{
+  ASKAPCHECK(flag.shape().isEqual(noise.shape()), "Flag cube shape "<<flag.shape()<<
+             " doesn't match the noise cube shape "<<noise.shape());
+  setUpOutput(noise, nAvg, out);
+  const casacore::uInt nRow = noise.nrow();
+  const casacore::uInt nChan = out.ncolumn();
+  if (noise.nelements() == 0) {
+      return;
+  }
+  bool deleteNoise, deleteFlag, deleteOut;
+  const casacore::Complex *noiseData = noise.getStorage(deleteNoise);
+  const casacore::Bool *flagData = flag.getStorage(deleteFlag);
+  casacore::Complex *outData = out.getStorage(deleteOut);
+  // the accumulated sum of weights defines the output noise, the values themselves are unused
+  const std::vector<float> unity(nRow, 1.f);
+  Accumulator re(nRow), im(nRow);
+  std::vector<float> weightRe, weightIm;
+  for (casacore::uInt pol = 0; pol < noise.nplane(); ++pol) {
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            re.reset();
+            im.reset();
+            const size_t firstOffset = (size_t(pol) * noise.ncolumn() + chan * nAvg) * nRow;
+            for (casacore::uInt k = 0; k < nAvg; ++k) {
+                 const size_t offset = firstOffset + size_t(k) * nRow;
+                 const float *noisePtr = reinterpret_cast<const float*>(noiseData + offset);
+                 noiseToWeight(noisePtr, 2, nRow, weightRe);
+                 noiseToWeight(noisePtr + 1, 2, nRow, weightIm);
+                 re.add(&unity[0], 1, &weightRe[0], flagData + offset);
+                 im.add(&unity[0], 1, &weightIm[0], flagData + offset);
+            }
+            casacore::Complex *outPtr = outData + (size_t(pol) * nChan + chan) * nRow;
+            const casacore::Complex *firstPtr = noiseData + firstOffset;
+            for (casacore::uInt row = 0; row < nRow; ++row) {
+                 const float wRe = re.itsWeight[row] > 0.f ? re.itsWeight[row] : re.itsAllWeight[row];
+                 const float wIm = im.itsWeight[row] > 0.f ? im.itsWeight[row] : im.itsAllWeight[row];
+                 outPtr[row] = casacore::Complex(wRe > 0.f ? 1.f / std::sqrt(wRe) : casacore::real(firstPtr[row]),
+                                                 wIm > 0.f ? 1.f / std::sqrt(wIm) : casacore::imag(firstPtr[row]));
+            }
+       }
+  }
+  noise.freeStorage(noiseData, deleteNoise);
+  flag.freeStorage(flagData, deleteFlag);
+  out.putStorage(outData, deleteOut);
+}
+
+/// @brief average frequencies
+/// @details The output channel frequency is the mean frequency of the input channels.
+/// @param[in] freq input frequencies
+/// @param[in] nAvg number of adjacent channels to average, has to divide the number of channels
+/// @return output frequencies
+casacore::Vector<casacore::Double> ChannelAverager::averageFrequency(const casacore::Vector<casacore::Double> &freq,
+                                                           casacore::uInt nAvg)
+{
+  ASKAPCHECK(nAvg > 0, "Number of channels to average should be positive");
+  ASKAPCHECK(freq.nelements() % nAvg == 0, "Unable to average "<<freq.nelements()<<" channels by "<<nAvg<<
+             ", the number of channels has to be a multiple of the averaging factor");
+  casacore::Vector<casacore::Double> result(freq.nelements() / nAvg, 0.);
+  for (casacore::uInt chan = 0; chan < result.nelements(); ++chan) {
+       for (casacore::uInt k = 0; k < nAvg; ++k) {
+            result[chan] += freq[chan * nAvg + k];
+       }
+       result[chan] /= nAvg;
+  }
+  return result;
+}
@@ -0,0 +1,102 @@
+/// @file
+///
+/// @brief Averaging of the cubes along the spectral axis
+/// @details The table-based iterator reads full spectral resolution from the table and
+/// averages adjacent channels when the accessor is filled, if requested via the selector
+/// (see IDataSelector::chooseChannels). This class holds the reductions.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_CHANNEL_AVERAGER_H
+#define ASKAP_ACCESSORS_CHANNEL_AVERAGER_H
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Averaging of the cubes along the spectral axis
+/// @details Each group of nAvg adjacent input channels forms one output channel. The
+/// averaging is flag-aware: flagged samples don't contribute, an output sample is flagged
+/// only if all contributing samples are flagged (such samples get the average of all input
+/// samples, so the value is still meaningful). It is also weight-aware: if noise is given,
+/// the samples are weighted by 1/sigma^2 and the noise of the output is that of the weighted
+/// average. Samples with non-positive sigma are treated as flagged.
+///
+/// The cubes are nRow x nChannel x nPol as delivered by the accessor. The reductions go
+/// along the row axis, which is contiguous in memory, so the inner loops are vectorised
+/// by the compiler.
+/// @ingroup dataaccess_tab
+class ChannelAverager {
+public:
+  /// @brief average visibilities
+  /// @param[in] vis input cube
+  /// @param[in] flag input flags (same shape as vis)
+  /// @param[in] noise input noise (same shape as vis), empty cube means equal weights
+  /// @param[in] nAvg number of adjacent channels to average, has to divide the number of channels
+  /// @param[out] out output cube (resized if its shape doesn't match)
+  static void averageVisibility(const casacore::Cube<casacore::Complex> &vis,
+                                const casacore::Cube<casacore::Bool> &flag,
+                                const casacore::Cube<casacore::Complex> &noise, casacore::uInt nAvg,
+                                casacore::Cube<casacore::Complex> &out);
+
+  /// @brief average flags
+  /// @details The output is flagged if all input samples are flagged
+  /// @param[in] flag input flags
+  /// @param[in] nAvg number of adjacent channels to average, has to divide the number of channels
+  /// @param[out] out output cube (resized if its shape doesn't match)
+  static void averageFlag(const casacore::Cube<casacore::Bool> &flag, casacore::uInt nAvg,
+                          casacore::Cube<casacore::Bool> &out);
+
+  /// @brief obtain noise of the averaged visibilities
+  /// @details Real and imaginary parts are processed separately.
+  /// @param[in] noise input noise
+  /// @param[in] flag input flags (same shape as noise)
+  /// @param[in] nAvg number of adjacent channels to average, has to divide the number of channels
+  /// @param[out] out output cube (resized if its shape doesn't match)
+  static void averageNoise(const casacore::Cube<casacore::Complex> &noise,
+                           const casacore::Cube<casacore::Bool> &flag, casacore::uInt nAvg,
+                           casacore::Cube<casacore::Complex> &out);
+
+  /// @brief average frequencies
+  /// @details The output channel frequency is the mean frequency of the input channels.
+  /// @param[in] freq input frequencies
+  /// @param[in] nAvg number of adjacent channels to average, has to divide the number of channels
+  /// @return output frequencies
+  static casacore::Vector<casacore::Double> averageFrequency(const casacore::Vector<casacore::Double> &freq,
+                                                             casacore::uInt nAvg);
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CHANNEL_AVERAGER_H
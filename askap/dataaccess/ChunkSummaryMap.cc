@@ -0,0 +1,355 @@
+/// @file
+///
+/// @brief Per-time-stamp summaries of the data ("zone maps")
+/// @details Summaries are collected by iterators and can be persisted next to the
+/// measurement set.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/ChunkSummaryMap.h>
+#include <askap/dataaccess/VisibilityCache.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <fstream>
+#include <limits>
+#include <algorithm>
+#include <stdint.h>
+
+ASKAP_LOGGER(logger, ".ChunkSummaryMap");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief identification of the file format
+const uint32_t theMagic = 0x4d534341;
+
+/// @brief version of the file format
+const uint32_t theVersion = 1;
+
+/// @brief write a binary value
+/// @param[in] os output stream
+/// @param[in] value value to write
+template<typename T>
+void writeValue(std::ostream &os, const T &value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// @brief read a binary value
+/// @param[in] is input stream
+/// @param[out] value value to read
+template<typename T>
+void readValue(std::istream &is, T &value)
+{
+  is.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+} // anonymous namespace
+
+/// @brief construct an empty summary
+ChunkSummary::ChunkSummary() : itsStartTime(std::numeric_limits<double>::max()),
+      itsEndTime(-std::numeric_limits<double>::max()), itsFieldID(-1), itsNRow(0), itsNSamples(0),
+      itsNFlagged(0), itsMinUVDistance(std::numeric_limits<double>::max()), itsMaxUVDistance(0.),
+      itsMinW(std::numeric_limits<double>::max()), itsMaxW(-std::numeric_limits<double>::max()) {}
+
+/// @brief extend the summary with another one
+/// @details Field ID becomes -1 if the summaries are for different fields.
+/// @param[in] other summary to add
+void ChunkSummary::merge(const ChunkSummary &other)
+{
+  if (itsNRow == 0) {
+      *this = other;
+      return;
+  }
+  if (other.itsNRow == 0) {
+      return;
+  }
+  itsStartTime = std::min(itsStartTime, other.itsStartTime);
+  itsEndTime = std::max(itsEndTime, other.itsEndTime);
+  if (itsFieldID != other.itsFieldID) {
+      itsFieldID = -1;
+  }
+  itsNRow += other.itsNRow;
+  itsNSamples += other.itsNSamples;
+  itsNFlagged += other.itsNFlagged;
+  itsMinUVDistance = std::min(itsMinUVDistance, other.itsMinUVDistance);
+  itsMaxUVDistance = std::max(itsMaxUVDistance, other.itsMaxUVDistance);
+  itsMinW = std::min(itsMinW, other.itsMinW);
+  itsMaxW = std::max(itsMaxW, other.itsMaxW);
+}
+
+/// @return fraction of flagged samples (1 for an empty summary)
+double ChunkSummary::flaggedFraction() const
+{
+  return itsNSamples > 0 ? double(itsNFlagged) / double(itsNSamples) : 1.;
+}
+
+/// @brief check whether any row may be within the given uv-distance range
+/// @param[in] minUV minimum uv-distance in metres
+/// @param[in] maxUV maximum uv-distance in metres
+/// @return true, if the uv-distance range of the summary overlaps with the given range
+bool ChunkSummary::overlapsUVRange(double minUV, double maxUV) const
+{
+  return (itsNRow > 0) && (itsMaxUVDistance >= minUV) && (itsMinUVDistance <= maxUV);
+}
+
+/// @brief construct the map
+/// @param[in] msName name of the measurement set
+/// @param[in] fileName file to persist the summaries in, empty string means no persistence
+ChunkSummaryMap::ChunkSummaryMap(const std::string &msName, const std::string &fileName) :
+      itsMSName(msName), itsFileName(fileName), itsMSTime(VisibilityCache::modificationTime(msName)),
+      itsNComplete(0), itsModified(false)
+{
+  if (itsFileName.size()) {
+      load();
+  }
+}
+
+/// @brief destructor, saves the summaries if they have changed
+ChunkSummaryMap::~ChunkSummaryMap()
+{
+  try {
+     save();
+  }
+  catch (const AskapError &ex) {
+     ASKAPLOG_WARN_STR(logger, "Unable to save chunk summaries: "<<ex.what());
+  }
+}
+
+/// @brief add summary of one chunk
+/// @param[in] time time stamp of the chunk as stored in the TIME column
+/// @param[in] firstRow row number of the first row of the chunk in the main table
+/// @param[in] rowsInTimeStamp number of rows with this time stamp in the main table
+/// @param[in] chunk summary of the chunk
+void ChunkSummaryMap::add(double time, casacore::rownr_t firstRow, casacore::rownr_t rowsInTimeStamp,
+                          const ChunkSummary &chunk)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  Entry &entry = itsEntries[time];
+  if (entry.itsComplete || !entry.itsChunks.insert(firstRow).second) {
+      // this chunk has already been seen
+      return;
+  }
+  entry.itsExpectedRows = rowsInTimeStamp;
+  entry.itsSummary.merge(chunk);
+  if (entry.itsSummary.itsNRow > entry.itsExpectedRows) {
+      // chunks of different size have been mixed, start again
+      ASKAPLOG_DEBUG_STR(logger, "Overlapping chunks for time "<<time<<", the summary is discarded");
+      itsEntries.erase(time);
+      return;
+  }
+  if (entry.itsSummary.itsNRow == entry.itsExpectedRows) {
+      entry.itsComplete = true;
+      entry.itsChunks.clear();
+      ++itsNComplete;
+      itsModified = true;
+  }
+}
+
+/// @brief obtain the summary for the given time stamp
+/// @param[in] time time stamp as stored in the TIME column
+/// @param[out] summary summary of all rows with this time stamp (unchanged if not found)
+/// @return true, if a complete summary exists for this time stamp
+bool ChunkSummaryMap::find(double time, ChunkSummary &summary) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const std::map<double, Entry>::const_iterator ci = itsEntries.find(time);
+  if ((ci == itsEntries.end()) || !ci->second.itsComplete) {
+      return false;
+  }
+  summary = ci->second.itsSummary;
+  return true;
+}
+
+/// @brief obtain the summary for the given time range
+/// @param[in] start start time (inclusive)
+/// @param[in] end end time (inclusive)
+/// @param[out] summary merged summary of all complete time stamps in the range
+/// @return number of complete time stamps in the range
+size_t ChunkSummaryMap::find(double start, double end, ChunkSummary &summary) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  summary = ChunkSummary();
+  size_t result = 0;
+  for (std::map<double, Entry>::const_iterator ci = itsEntries.lower_bound(start);
+       (ci != itsEntries.end()) && (ci->first <= end); ++ci) {
+       if (ci->second.itsComplete) {
+           summary.merge(ci->second.itsSummary);
+           ++result;
+       }
+  }
+  return result;
+}
+
+/// @return number of complete time stamps
+size_t ChunkSummaryMap::size() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsNComplete;
+}
+
+/// @brief remove all summaries
+void ChunkSummaryMap::clear()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsEntries.clear();
+  itsNComplete = 0;
+  itsModified = false;
+}
+
+/// @brief write complete summaries into the file given at construction
+/// @details Nothing is done if there is no file name or nothing has changed
+/// since the last save or load.
+/// @return true, if the file has been written
+bool ChunkSummaryMap::save()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (!itsFileName.size() || !itsModified) {
+      return false;
+  }
+  if (VisibilityCache::modificationTime(itsMSName) != itsMSTime) {
+      ASKAPLOG_WARN_STR(logger, itsMSName<<" has been modified, chunk summaries are not saved");
+      return false;
+  }
+  std::ofstream os(itsFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!os) {
+      ASKAPLOG_WARN_STR(logger, "Unable to write chunk summaries into "<<itsFileName);
+      return false;
+  }
+  writeValue(os, theMagic);
+  writeValue(os, theVersion);
+  writeValue(os, itsMSTime);
+  writeValue(os, uint64_t(itsNComplete));
+  for (std::map<double, Entry>::const_iterator ci = itsEntries.begin(); ci != itsEntries.end(); ++ci) {
+       if (!ci->second.itsComplete) {
+           continue;
+       }
+       const ChunkSummary &summary = ci->second.itsSummary;
+       writeValue(os, ci->first);
+       writeValue(os, uint64_t(ci->second.itsExpectedRows));
+       writeValue(os, summary.itsStartTime);
+       writeValue(os, summary.itsEndTime);
+       writeValue(os, int32_t(summary.itsFieldID));
+       writeValue(os, uint64_t(summary.itsNRow));
+       writeValue(os, uint64_t(summary.itsNSamples));
+       writeValue(os, uint64_t(summary.itsNFlagged));
+       writeValue(os, summary.itsMinUVDistance);
+       writeValue(os, summary.itsMaxUVDistance);
+       writeValue(os, summary.itsMinW);
+       writeValue(os, summary.itsMaxW);
+  }
+  if (!os) {
+      ASKAPLOG_WARN_STR(logger, "Unable to write chunk summaries into "<<itsFileName);
+      return false;
+  }
+  itsModified = false;
+  ASKAPLOG_DEBUG_STR(logger, "Saved chunk summaries for "<<itsNComplete<<" time stamp(s) into "<<itsFileName);
+  return true;
+}
+
+/// @brief default file name for the given measurement set
+/// @param[in] msName name of the measurement set
+/// @return name of the file next to the measurement set
+std::string ChunkSummaryMap::defaultFileName(const std::string &msName)
+{
+  std::string result = msName;
+  while ((result.size() > 1) && (result[result.size() - 1] == '/')) {
+         result.resize(result.size() - 1);
+  }
+  return result + ".chunksummary";
+}
+
+/// @brief read the file given at construction
+void ChunkSummaryMap::load()
+{
+  std::ifstream is(itsFileName.c_str(), std::ios::in | std::ios::binary);
+  if (!is) {
+      // nothing saved yet
+      return;
+  }
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  double msTime = -1.;
+  uint64_t count = 0;
+  readValue(is, magic);
+  readValue(is, version);
+  readValue(is, msTime);
+  readValue(is, count);
+  if (!is || (magic != theMagic) || (version != theVersion)) {
+      ASKAPLOG_WARN_STR(logger, "Chunk summaries in "<<itsFileName<<" are unreadable and will be ignored");
+      return;
+  }
+  if (msTime != itsMSTime) {
+      ASKAPLOG_INFO_STR(logger, itsMSName<<" has been modified since the chunk summaries were saved, "
+                        "they will be recomputed");
+      return;
+  }
+  std::map<double, Entry> entries;
+  for (uint64_t i = 0; i < count; ++i) {
+       double time = 0.;
+       uint64_t expectedRows = 0;
+       int32_t fieldID = -1;
+       uint64_t nRow = 0;
+       uint64_t nSamples = 0;
+       uint64_t nFlagged = 0;
+       Entry entry;
+       ChunkSummary &summary = entry.itsSummary;
+       readValue(is, time);
+       readValue(is, expectedRows);
+       readValue(is, summary.itsStartTime);
+       readValue(is, summary.itsEndTime);
+       readValue(is, fieldID);
+       readValue(is, nRow);
+       readValue(is, nSamples);
+       readValue(is, nFlagged);
+       readValue(is, summary.itsMinUVDistance);
+       readValue(is, summary.itsMaxUVDistance);
+       readValue(is, summary.itsMinW);
+       readValue(is, summary.itsMaxW);
+       summary.itsFieldID = fieldID;
+       summary.itsNRow = nRow;
+       summary.itsNSamples = nSamples;
+       summary.itsNFlagged = nFlagged;
+       entry.itsExpectedRows = casacore::rownr_t(expectedRows);
+       entry.itsComplete = true;
+       entries[time] = entry;
+  }
+  if (!is) {
+      ASKAPLOG_WARN_STR(logger, "Chunk summaries in "<<itsFileName<<" are truncated and will be ignored");
+      return;
+  }
+  itsEntries.swap(entries);
+  itsNComplete = itsEntries.size();
+  ASKAPLOG_DEBUG_STR(logger, "Loaded chunk summaries for "<<itsNComplete<<" time stamp(s) from "<<itsFileName);
+}
@@ -0,0 +1,210 @@
+/// @file
+///
+/// @brief Per-time-stamp summaries of the data ("zone maps")
+/// @details Summaries (fraction flagged, uv-distance and w ranges, time and field) are
+/// collected by the iterators during full passes over the data and can be persisted next
+/// to the measurement set. Consumers can then skip chunks which are fully flagged or
+/// outside the uv-range of interest without reading their visibility cubes.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_CHUNK_SUMMARY_MAP_H
+#define ASKAP_ACCESSORS_CHUNK_SUMMARY_MAP_H
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+// std includes
+#include <string>
+#include <map>
+#include <set>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief summary of a chunk of data
+/// @details Times are in the units of the TIME column of the measurement set (seconds since
+/// 0 MJD), uv-distances and w are in metres as stored in the UVW column.
+/// @ingroup dataaccess_hlp
+struct ChunkSummary {
+  /// @brief construct an empty summary
+  ChunkSummary();
+
+  /// @brief extend the summary with another one
+  /// @details Field ID becomes -1 if the summaries are for different fields.
+  /// @param[in] other summary to add
+  void merge(const ChunkSummary &other);
+
+  /// @return fraction of flagged samples (1 for an empty summary)
+  double flaggedFraction() const;
+
+  /// @return true, if all samples are flagged (or there are no samples)
+  inline bool allFlagged() const { return itsNFlagged == itsNSamples; }
+
+  /// @brief check whether any row may be within the given uv-distance range
+  /// @param[in] minUV minimum uv-distance in metres
+  /// @param[in] maxUV maximum uv-distance in metres
+  /// @return true, if the uv-distance range of the summary overlaps with the given range
+  bool overlapsUVRange(double minUV, double maxUV) const;
+
+  /// @brief earliest time
+  double itsStartTime;
+  /// @brief latest time
+  double itsEndTime;
+  /// @brief field ID, -1 if the summary covers different fields
+  int itsFieldID;
+  /// @brief number of rows
+  casacore::uInt64 itsNRow;
+  /// @brief number of samples (rows x channels x polarisations)
+  casacore::uInt64 itsNSamples;
+  /// @brief number of flagged samples
+  casacore::uInt64 itsNFlagged;
+  /// @brief minimum uv-distance
+  double itsMinUVDistance;
+  /// @brief maximum uv-distance
+  double itsMaxUVDistance;
+  /// @brief minimum w
+  double itsMinW;
+  /// @brief maximum w
+  double itsMaxW;
+};
+
+/// @brief Per-time-stamp summaries of the data ("zone maps")
+/// @details Iterators add summaries of the chunks they read (see
+/// TableConstDataIterator::setChunkSummaryMap). Chunks are identified by their first
+/// row in the main table, so the chunks read again (e.g. in every major cycle) are
+/// counted once. A time stamp is complete once its chunks cover all rows of the main
+/// table with this time stamp, only complete time stamps are returned by find. Therefore,
+/// the summaries are only collected by passes over all rows of the measurement set, but
+/// can be used by iterators with any selection.
+///
+/// If a file name is given, complete summaries are loaded from this file at construction
+/// (if the file exists and the measurement set hasn't been modified since it was written)
+/// and written into it at destruction (unless the measurement set has been modified in
+/// the meantime). Problems with the file are reported to the log, but are not fatal.
+/// All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class ChunkSummaryMap : public boost::noncopyable {
+public:
+  /// @brief construct the map
+  /// @param[in] msName name of the measurement set
+  /// @param[in] fileName file to persist the summaries in, empty string means no persistence
+  explicit ChunkSummaryMap(const std::string &msName, const std::string &fileName = "");
+
+  /// @brief destructor, saves the summaries if they have changed
+  ~ChunkSummaryMap();
+
+  /// @brief add summary of one chunk
+  /// @param[in] time time stamp of the chunk as stored in the TIME column
+  /// @param[in] firstRow row number of the first row of the chunk in the main table
+  /// @param[in] rowsInTimeStamp number of rows with this time stamp in the main table
+  /// @param[in] chunk summary of the chunk
+  void add(double time, casacore::rownr_t firstRow, casacore::rownr_t rowsInTimeStamp,
+           const ChunkSummary &chunk);
+
+  /// @brief obtain the summary for the given time stamp
+  /// @param[in] time time stamp as stored in the TIME column
+  /// @param[out] summary summary of all rows with this time stamp (unchanged if not found)
+  /// @return true, if a complete summary exists for this time stamp
+  bool find(double time, ChunkSummary &summary) const;
+
+  /// @brief obtain the summary for the given time range
+  /// @param[in] start start time (inclusive)
+  /// @param[in] end end time (inclusive)
+  /// @param[out] summary merged summary of all complete time stamps in the range
+  /// @return number of complete time stamps in the range
+  size_t find(double start, double end, ChunkSummary &summary) const;
+
+  /// @return number of complete time stamps
+  size_t size() const;
+
+  /// @brief remove all summaries
+  void clear();
+
+  /// @brief write complete summaries into the file given at construction
+  /// @details Nothing is done if there is no file name or nothing has changed
+  /// since the last save or load.
+  /// @return true, if the file has been written
+  bool save();
+
+  /// @return name of the file the summaries are persisted in
+  inline const std::string& fileName() const { return itsFileName; }
+
+  /// @brief default file name for the given measurement set
+  /// @param[in] msName name of the measurement set
+  /// @return name of the file next to the measurement set
+  static std::string defaultFileName(const std::string &msName);
+
+private:
+  /// @brief summaries gathered for one time stamp
+  struct Entry {
+    /// @brief construct an empty entry
+    Entry() : itsExpectedRows(0), itsComplete(false) {}
+    /// @brief summary of the chunks added so far
+    ChunkSummary itsSummary;
+    /// @brief number of rows of the time stamp in the main table
+    casacore::rownr_t itsExpectedRows;
+    /// @brief first rows of the chunks added so far
+    std::set<casacore::rownr_t> itsChunks;
+    /// @brief true if the chunks cover all rows of the time stamp
+    bool itsComplete;
+  };
+
+  /// @brief read the file given at construction
+  void load();
+
+  /// @brief name of the measurement set
+  std::string itsMSName;
+
+  /// @brief name of the file to persist the summaries in
+  std::string itsFileName;
+
+  /// @brief modification time of the measurement set when the map was created
+  double itsMSTime;
+
+  /// @brief summaries for each time stamp
+  std::map<double, Entry> itsEntries;
+
+  /// @brief number of complete time stamps
+  size_t itsNComplete;
+
+  /// @brief true if there are summaries which haven't been saved
+  bool itsModified;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_CHUNK_SUMMARY_MAP_H
@@ -0,0 +1,113 @@
+/// @file
+///
+/// @brief Run-length decomposition of an integer column
+/// @details The iterator splits each time step into chunks with the same
+/// DATA_DESC_ID and FIELD_ID. This class holds the runs of constant value found
+/// in one pass over the column.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/ColumnRuns.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief number of values compared at once
+/// @details The comparison of a block is branch-free, so it is vectorised by the compiler.
+const casacore::rownr_t theBlockSize = 64;
+
+} // anonymous namespace
+
+/// @brief construct an empty object
+ColumnRuns::ColumnRuns() : itsLastRun(0) {}
+
+/// @brief find runs in the given values
+/// @details The values are compared in blocks, only the blocks containing
+/// a change are scanned element by element.
+/// @param[in] values column values, one per row
+void ColumnRuns::assign(const casacore::Vector<casacore::Int> &values)
+{
+  clear();
+  const casacore::rownr_t nRows = values.nelements();
+  if (nRows == 0) {
+      return;
+  }
+  bool deleteIt = false;
+  const casacore::Int *data = values.getStorage(deleteIt);
+  for (casacore::rownr_t start = 1; start < nRows; start += theBlockSize) {
+       const casacore::rownr_t end = std::min(start + theBlockSize, nRows);
+       casacore::Int changes = 0;
+       for (casacore::rownr_t row = start; row < end; ++row) {
+            changes |= data[row] ^ data[row - 1];
+       }
+       if (changes != 0) {
+           for (casacore::rownr_t row = start; row < end; ++row) {
+                if (data[row] != data[row - 1]) {
+                    itsEnds.push_back(row);
+                    itsValues.push_back(data[row - 1]);
+                }
+           }
+       }
+  }
+  itsEnds.push_back(nRows);
+  itsValues.push_back(data[nRows - 1]);
+  values.freeStorage(data, deleteIt);
+}
+
+/// @brief remove all runs
+void ColumnRuns::clear()
+{
+  itsEnds.clear();
+  itsValues.clear();
+  itsLastRun = 0;
+}
+
+/// @brief obtain the run containing the given row
+/// @param[in] row row of interest, should be less than nRows()
+/// @return value of the row and the row following the last one of its run
+ColumnRuns::Run ColumnRuns::run(casacore::rownr_t row) const
+{
+  ASKAPCHECK(row < nRows(), "Row "<<row<<" is outside the "<<nRows()<<" row(s) covered by the runs");
+  ASKAPDEBUGASSERT(itsLastRun < itsEnds.size());
+  // rows are typically accessed in order, so try the last run and the following one first
+  const casacore::rownr_t lastStart = itsLastRun > 0 ? itsEnds[itsLastRun - 1] : 0;
+  if (row < lastStart || row >= itsEnds[itsLastRun]) {
+      if ((row >= itsEnds[itsLastRun]) && (itsLastRun + 1 < itsEnds.size()) && (row < itsEnds[itsLastRun + 1])) {
+          ++itsLastRun;
+      } else {
+          itsLastRun = std::upper_bound(itsEnds.begin(), itsEnds.end(), row) - itsEnds.begin();
+      }
+  }
+  ASKAPDEBUGASSERT(itsLastRun < itsEnds.size());
+  return Run(itsValues[itsLastRun], itsEnds[itsLastRun]);
+}
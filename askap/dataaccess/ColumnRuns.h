@@ -0,0 +1,101 @@
+/// @file
+///
+/// @brief Run-length decomposition of an integer column
+/// @details The iterator splits each time step into chunks with the same
+/// DATA_DESC_ID and FIELD_ID. This class holds the runs of constant value found
+/// in one pass over the column, so the chunks of the time step don't require
+/// further scans of the table.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_COLUMN_RUNS_H
+#define ASKAP_ACCESSORS_COLUMN_RUNS_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// std includes
+#include <vector>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Run-length decomposition of an integer column
+/// @details Values are stored as a sorted list of runs given by the row following
+/// the last row of the run and the value. The lookup of the run is constant time
+/// when the rows are accessed in order (as the iterator does), a binary search is
+/// done otherwise.
+/// @ingroup dataaccess_hlp
+class ColumnRuns {
+public:
+  /// @brief a single run, the value and the row following the last one
+  typedef std::pair<casacore::Int, casacore::rownr_t> Run;
+
+  /// @brief construct an empty object
+  ColumnRuns();
+
+  /// @brief find runs in the given values
+  /// @details The values are compared in blocks, only the blocks containing
+  /// a change are scanned element by element.
+  /// @param[in] values column values, one per row
+  void assign(const casacore::Vector<casacore::Int> &values);
+
+  /// @brief remove all runs
+  void clear();
+
+  /// @return true if there are no runs (i.e. no rows)
+  inline bool empty() const { return itsEnds.empty(); }
+
+  /// @return number of runs
+  inline size_t nRuns() const { return itsEnds.size(); }
+
+  /// @return number of rows covered by the runs
+  inline casacore::rownr_t nRows() const { return itsEnds.empty() ? 0 : itsEnds.back(); }
+
+  /// @brief obtain the run containing the given row
+  /// @param[in] row row of interest, should be less than nRows()
+  /// @return value of the row and the row following the last one of its run
+  Run run(casacore::rownr_t row) const;
+
+private:
+  /// @brief rows following the last row of each run
+  std::vector<casacore::rownr_t> itsEnds;
+
+  /// @brief value for each run
+  std::vector<casacore::Int> itsValues;
+
+  /// @brief index of the run found last time
+  mutable size_t itsLastRun;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COLUMN_RUNS_H
@@ -0,0 +1,124 @@
+/// @file
+///
+/// @brief Compact representation of the noise cube
+/// @details The noise cube delivered by the accessor has the same size as the
+/// visibility cube. This class stores the noise given per row and polarisation
+/// with an optional spectrum common to all rows.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/CompactNoise.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty object
+CompactNoise::CompactNoise() : itsNRow(0), itsNChan(0), itsNPol(0), itsFull(false) {}
+
+/// @brief set noise given per row and polarisation
+/// @details The spectrum is reset.
+/// @param[in] sigma nRow x nPol matrix with noise values
+/// @param[in] nChan number of spectral channels
+void CompactNoise::assign(const casacore::Matrix<casacore::Float> &sigma, casacore::uInt nChan)
+{
+  itsNRow = sigma.nrow();
+  itsNChan = nChan;
+  itsNPol = sigma.ncolumn();
+  itsFull = false;
+  itsSigma.assign(sigma);
+  itsSpectrum.resize(0);
+  itsCube.resize(0,0,0);
+}
+
+/// @brief set the full noise cube
+/// @details This form is used if the noise can't be represented in the compact form
+/// @param[in] noise nRow x nChannel x nPol cube with noise (real and imaginary parts)
+void CompactNoise::assign(const casacore::Cube<casacore::Complex> &noise)
+{
+  itsNRow = noise.nrow();
+  itsNChan = noise.ncolumn();
+  itsNPol = noise.nplane();
+  itsFull = true;
+  itsSigma.resize(0,0);
+  itsSpectrum.resize(0);
+  itsCube.assign(noise);
+}
+
+/// @brief set the spectrum common to all rows and polarisations
+/// @details This is only allowed in the compact form
+/// @param[in] spectrum vector of nChannel multiplicative factors
+void CompactNoise::setSpectrum(const casacore::Vector<casacore::Float> &spectrum)
+{
+  ASKAPCHECK(!itsFull, "Spectrum can only be set for the compact form of the noise");
+  ASKAPCHECK(spectrum.nelements() == itsNChan, "Spectrum has "<<spectrum.nelements()<<
+             " channels, noise has "<<itsNChan);
+  itsSpectrum.assign(spectrum);
+}
+
+/// @brief noise per row and polarisation
+/// @details Valid in the compact form only
+/// @return nRow x nPol matrix
+const casacore::Matrix<casacore::Float>& CompactNoise::sigma() const
+{
+  ASKAPCHECK(!itsFull, "Noise is not given per row and polarisation, use the full cube");
+  return itsSigma;
+}
+
+/// @brief obtain noise for the given sample
+/// @param[in] row row index
+/// @param[in] chan channel index
+/// @param[in] pol polarisation index
+/// @return complex noise (same for real and imaginary parts in the compact form)
+casacore::Complex CompactNoise::operator()(casacore::uInt row, casacore::uInt chan, casacore::uInt pol) const
+{
+  if (itsFull) {
+      return itsCube(row, chan, pol);
+  }
+  const casacore::Float val = hasSpectrum() ? itsSigma(row, pol) * itsSpectrum[chan] : itsSigma(row, pol);
+  return casacore::Complex(val, val);
+}
+
+/// @brief expand into the full cube
+/// @param[out] noise nRow x nChannel x nPol cube to fill (resized as necessary)
+void CompactNoise::expand(casacore::Cube<casacore::Complex> &noise) const
+{
+  if (itsFull) {
+      noise.assign(itsCube);
+      return;
+  }
+  noise.resize(itsNRow, itsNChan, itsNPol);
+  for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+       for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+            const casacore::Float factor = hasSpectrum() ? itsSpectrum[chan] : 1.;
+            for (casacore::uInt row = 0; row < itsNRow; ++row) {
+                 const casacore::Float val = itsSigma(row, pol) * factor;
+                 noise(row, chan, pol) = casacore::Complex(val, val);
+            }
+       }
+  }
+}
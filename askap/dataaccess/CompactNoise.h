@@ -0,0 +1,138 @@
+/// @file
+///
+/// @brief Compact representation of the noise cube
+/// @details The noise cube delivered by the accessor has the same size as the
+/// visibility cube. However, in most cases the noise is given per row and polarisation
+/// (SIGMA column) and does not depend on the spectral channel. This class stores such
+/// noise as a nRow x nPol matrix with an optional spectrum common to all rows.
+/// The full cube is kept only if the noise cannot be represented this way.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_COMPACT_NOISE_H
+#define ASKAP_ACCESSORS_COMPACT_NOISE_H
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Compact representation of the noise cube
+/// @details In the compact form, the noise for the given row, channel and polarisation
+/// is sigma(row, pol) * spectrum(chan) for both real and imaginary parts (spectrum is
+/// treated as 1 for all channels if not set). If the noise is not separable this way,
+/// the full nRow x nChannel x nPol cube is stored instead (see isFull).
+/// @ingroup dataaccess
+class CompactNoise {
+public:
+  /// @brief construct an empty object
+  CompactNoise();
+
+  /// @brief set noise given per row and polarisation
+  /// @details The spectrum is reset.
+  /// @param[in] sigma nRow x nPol matrix with noise values
+  /// @param[in] nChan number of spectral channels
+  void assign(const casacore::Matrix<casacore::Float> &sigma, casacore::uInt nChan);
+
+  /// @brief set the full noise cube
+  /// @details This form is used if the noise can't be represented in the compact form
+  /// @param[in] noise nRow x nChannel x nPol cube with noise (real and imaginary parts)
+  void assign(const casacore::Cube<casacore::Complex> &noise);
+
+  /// @brief set the spectrum common to all rows and polarisations
+  /// @details This is only allowed in the compact form
+  /// @param[in] spectrum vector of nChannel multiplicative factors
+  void setSpectrum(const casacore::Vector<casacore::Float> &spectrum);
+
+  /// @return true if the full cube is stored
+  inline bool isFull() const { return itsFull; }
+
+  /// @return true if per-channel spectrum is set
+  inline bool hasSpectrum() const { return itsSpectrum.nelements() > 0; }
+
+  /// @return number of rows
+  inline casacore::uInt nRow() const { return itsNRow; }
+
+  /// @return number of channels
+  inline casacore::uInt nChannel() const { return itsNChan; }
+
+  /// @return number of polarisations
+  inline casacore::uInt nPol() const { return itsNPol; }
+
+  /// @brief noise per row and polarisation
+  /// @details Valid in the compact form only
+  /// @return nRow x nPol matrix
+  const casacore::Matrix<casacore::Float>& sigma() const;
+
+  /// @brief per-channel spectrum
+  /// @details Empty vector is returned if spectrum is not set
+  /// @return vector of nChannel factors
+  inline const casacore::Vector<casacore::Float>& spectrum() const { return itsSpectrum; }
+
+  /// @brief obtain noise for the given sample
+  /// @param[in] row row index
+  /// @param[in] chan channel index
+  /// @param[in] pol polarisation index
+  /// @return complex noise (same for real and imaginary parts in the compact form)
+  casacore::Complex operator()(casacore::uInt row, casacore::uInt chan, casacore::uInt pol) const;
+
+  /// @brief expand into the full cube
+  /// @param[out] noise nRow x nChannel x nPol cube to fill (resized as necessary)
+  void expand(casacore::Cube<casacore::Complex> &noise) const;
+
+private:
+  /// @brief number of rows
+  casacore::uInt itsNRow;
+
+  /// @brief number of channels
+  casacore::uInt itsNChan;
+
+  /// @brief number of polarisations
+  casacore::uInt itsNPol;
+
+  /// @brief true, if the full cube is stored
+  bool itsFull;
+
+  /// @brief noise per row and polarisation (compact form)
+  casacore::Matrix<casacore::Float> itsSigma;
+
+  /// @brief per-channel spectrum (compact form), may be empty
+  casacore::Vector<casacore::Float> itsSpectrum;
+
+  /// @brief full noise cube (full form)
+  casacore::Cube<casacore::Complex> itsCube;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COMPACT_NOISE_H
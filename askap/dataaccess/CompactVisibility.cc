@@ -0,0 +1,238 @@
+/// @file
+///
+/// @brief Quantised representation of the visibility cube
+/// @details Visibilities are stored with 16 bits per real and imaginary part, either
+/// as IEEE half-precision numbers or as integers scaled separately for each row.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/CompactVisibility.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty object
+CompactVisibility::CompactVisibility() : itsNRow(0), itsNChan(0), itsNPol(0), itsPrecision(INT16) {}
+
+/// @brief quantise the visibility cube
+/// @param[in] vis nRow x nChannel x nPol cube of visibilities
+/// @param[in] precision quantisation mode
+void CompactVisibility::assign(const casacore::Cube<casacore::Complex> &vis, Precision precision)
+{
+  itsNRow = vis.nrow();
+  itsNChan = vis.ncolumn();
+  itsNPol = vis.nplane();
+  itsPrecision = precision;
+  itsData.resize(2 * size_t(itsNRow) * itsNChan * itsNPol);
+  itsScale.assign(precision == INT16 ? itsNRow : 0, 0.);
+  std::vector<uint16_t>::iterator dst = itsData.begin();
+  for (casacore::uInt row = 0; row < itsNRow; ++row) {
+       if (precision == HALF) {
+           for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+                for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+                     const casacore::Complex &value = vis(row, chan, pol);
+                     *(dst++) = floatToHalf(casacore::real(value));
+                     *(dst++) = floatToHalf(casacore::imag(value));
+                }
+           }
+           continue;
+       }
+       ASKAPDEBUGASSERT(precision == INT16);
+       float maxAbs = 0.;
+       for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+            for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+                 const casacore::Complex &value = vis(row, chan, pol);
+                 if (std::isfinite(casacore::real(value))) {
+                     maxAbs = std::max(maxAbs, std::abs(casacore::real(value)));
+                 }
+                 if (std::isfinite(casacore::imag(value))) {
+                     maxAbs = std::max(maxAbs, std::abs(casacore::imag(value)));
+                 }
+            }
+       }
+       const float scale = maxAbs / 32767.;
+       itsScale[row] = scale;
+       const float factor = scale > 0. ? 1. / scale : 0.;
+       for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+            for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+                 const casacore::Complex &value = vis(row, chan, pol);
+                 const float re = std::isfinite(casacore::real(value)) ? casacore::real(value) * factor : 0.;
+                 const float im = std::isfinite(casacore::imag(value)) ? casacore::imag(value) * factor : 0.;
+                 *(dst++) = static_cast<uint16_t>(static_cast<int16_t>(std::lround(re)));
+                 *(dst++) = static_cast<uint16_t>(static_cast<int16_t>(std::lround(im)));
+            }
+       }
+  }
+  ASKAPDEBUGASSERT(dst == itsData.end());
+}
+
+/// @brief expand into the complex cube
+/// @param[out] vis nRow x nChannel x nPol cube to fill (resized as necessary)
+void CompactVisibility::expand(casacore::Cube<casacore::Complex> &vis) const
+{
+  vis.resize(itsNRow, itsNChan, itsNPol);
+  std::vector<uint16_t>::const_iterator src = itsData.begin();
+  for (casacore::uInt row = 0; row < itsNRow; ++row) {
+       const float scale = itsPrecision == INT16 ? itsScale[row] : 1.;
+       for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+            for (casacore::uInt pol = 0; pol < itsNPol; ++pol, src += 2) {
+                 if (itsPrecision == HALF) {
+                     vis(row, chan, pol) = casacore::Complex(halfToFloat(src[0]), halfToFloat(src[1]));
+                 } else {
+                     vis(row, chan, pol) = casacore::Complex(scale * static_cast<int16_t>(src[0]),
+                                                             scale * static_cast<int16_t>(src[1]));
+                 }
+            }
+       }
+  }
+}
+
+/// @return memory used by the quantised data in bytes
+size_t CompactVisibility::memoryUsage() const
+{
+  return itsData.size() * sizeof(uint16_t) + itsScale.size() * sizeof(casacore::Float);
+}
+
+/// @brief write the object into a binary stream
+/// @details The native byte order is used, the format is only intended for
+/// temporary files read back by the same process.
+/// @param[in] os output stream
+void CompactVisibility::write(std::ostream &os) const
+{
+  const uint32_t header[4] = {itsNRow, itsNChan, itsNPol, uint32_t(itsPrecision)};
+  os.write(reinterpret_cast<const char*>(header), sizeof(header));
+  if (itsData.size()) {
+      os.write(reinterpret_cast<const char*>(&itsData[0]), itsData.size() * sizeof(uint16_t));
+  }
+  if (itsScale.size()) {
+      os.write(reinterpret_cast<const char*>(&itsScale[0]), itsScale.size() * sizeof(casacore::Float));
+  }
+  if (!os) {
+      ASKAPTHROW(DataAccessError, "Unable to write quantised visibilities");
+  }
+}
+
+/// @brief read the object from a binary stream
+/// @details The stream should be positioned at the data written by write.
+/// @param[in] is input stream
+void CompactVisibility::read(std::istream &is)
+{
+  uint32_t header[4];
+  is.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!is || ((header[3] != uint32_t(HALF)) && (header[3] != uint32_t(INT16)))) {
+      ASKAPTHROW(DataAccessError, "Unable to read quantised visibilities, the data are corrupted");
+  }
+  itsNRow = header[0];
+  itsNChan = header[1];
+  itsNPol = header[2];
+  itsPrecision = Precision(header[3]);
+  itsData.resize(2 * size_t(itsNRow) * itsNChan * itsNPol);
+  itsScale.resize(itsPrecision == INT16 ? itsNRow : 0);
+  if (itsData.size()) {
+      is.read(reinterpret_cast<char*>(&itsData[0]), itsData.size() * sizeof(uint16_t));
+  }
+  if (itsScale.size()) {
+      is.read(reinterpret_cast<char*>(&itsScale[0]), itsScale.size() * sizeof(casacore::Float));
+  }
+  if (!is) {
+      ASKAPTHROW(DataAccessError, "Unable to read quantised visibilities, the data are truncated");
+  }
+}
+
+/// @brief convert a single precision number to the half-precision format
+/// @param[in] value number to convert
+/// @return bit pattern of the nearest half-precision number
+uint16_t CompactVisibility::floatToHalf(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint16_t sign = (bits >> 16) & 0x8000u;
+  const uint32_t absBits = bits & 0x7fffffffu;
+  if (absBits >= 0x7f800000u) {
+      // infinity or NaN (keep NaN quiet)
+      return sign | 0x7c00u | (absBits > 0x7f800000u ? 0x200u : 0u);
+  }
+  if (absBits >= 0x477ff000u) {
+      // 65520 and above round to infinity
+      return sign | 0x7c00u;
+  }
+  if (absBits < 0x38800000u) {
+      // below the smallest normal half-precision number (2^-14)
+      if (absBits < 0x33000000u) {
+          // below half of the smallest subnormal number (2^-25), rounds to zero
+          return sign;
+      }
+      const uint32_t mantissa = (absBits & 0x7fffffu) | 0x800000u;
+      const int shift = 126 - int(absBits >> 23);
+      uint32_t result = mantissa >> shift;
+      const uint32_t remainder = mantissa & ((1u << shift) - 1);
+      const uint32_t halfway = 1u << (shift - 1);
+      if ((remainder > halfway) || ((remainder == halfway) && (result & 1u))) {
+          ++result;
+      }
+      return sign | uint16_t(result);
+  }
+  // normal number, rebias the exponent (127 - 15 = 112)
+  uint32_t result = (((absBits >> 23) - 112) << 10) | ((absBits >> 13) & 0x3ffu);
+  const uint32_t remainder = absBits & 0x1fffu;
+  // rounding to the nearest even, carry into the exponent is handled naturally
+  if ((remainder > 0x1000u) || ((remainder == 0x1000u) && (result & 1u))) {
+      ++result;
+  }
+  return sign | uint16_t(result);
+}
+
+/// @brief convert a half-precision number to single precision
+/// @param[in] value bit pattern of the half-precision number
+/// @return the same number in single precision
+float CompactVisibility::halfToFloat(uint16_t value)
+{
+  const uint32_t sign = uint32_t(value & 0x8000u) << 16;
+  const uint32_t exponent = (value >> 10) & 0x1fu;
+  const uint32_t mantissa = value & 0x3ffu;
+  uint32_t bits;
+  if (exponent == 0) {
+      // zero or subnormal number, exactly representable in single precision
+      const float magnitude = float(mantissa) * 5.9604644775390625e-8f;
+      return sign ? -magnitude : magnitude;
+  } else if (exponent == 0x1fu) {
+      bits = sign | 0x7f800000u | (mantissa << 13);
+  } else {
+      bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  }
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
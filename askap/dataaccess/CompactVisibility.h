@@ -0,0 +1,146 @@
+/// @file
+///
+/// @brief Quantised representation of the visibility cube
+/// @details Visibilities are stored with 16 bits per real and imaginary part, either
+/// as IEEE half-precision numbers or as integers scaled separately for each row.
+/// This halves the memory footprint compared to the complex cube delivered by the
+/// accessor, at the expense of the precision. The class is used to cache visibilities
+/// between major cycles (see VisibilityCache).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_COMPACT_VISIBILITY_H
+#define ASKAP_ACCESSORS_COMPACT_VISIBILITY_H
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// std includes
+#include <vector>
+#include <iosfwd>
+#include <stdint.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Quantised representation of the visibility cube
+/// @details In the HALF mode, each real and imaginary part is converted to the IEEE 754
+/// binary16 format (11 significant bits, rounding to the nearest, values above 65504 in
+/// magnitude become infinite). In the INT16 mode, the largest absolute value of the real
+/// and imaginary parts in each row is mapped to 32767 and all values of the row are rounded
+/// to the nearest integer on this scale, so the absolute error is at most half of the
+/// row maximum divided by 32767. The latter is usually more accurate for visibilities, as
+/// the values within a row are of the similar magnitude, and handles any dynamic range
+/// across rows. Non-finite values are preserved in the HALF mode only.
+/// @ingroup dataaccess
+class CompactVisibility {
+public:
+  /// @brief quantisation modes
+  enum Precision {
+     /// @brief IEEE half-precision real and imaginary parts
+     HALF = 0,
+     /// @brief 16-bit integers with a scale factor per row
+     INT16
+  };
+
+  /// @brief construct an empty object
+  CompactVisibility();
+
+  /// @brief quantise the visibility cube
+  /// @param[in] vis nRow x nChannel x nPol cube of visibilities
+  /// @param[in] precision quantisation mode
+  void assign(const casacore::Cube<casacore::Complex> &vis, Precision precision);
+
+  /// @brief expand into the complex cube
+  /// @param[out] vis nRow x nChannel x nPol cube to fill (resized as necessary)
+  void expand(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @return number of rows
+  inline casacore::uInt nRow() const { return itsNRow; }
+
+  /// @return number of channels
+  inline casacore::uInt nChannel() const { return itsNChan; }
+
+  /// @return number of polarisations
+  inline casacore::uInt nPol() const { return itsNPol; }
+
+  /// @return quantisation mode
+  inline Precision precision() const { return itsPrecision; }
+
+  /// @return memory used by the quantised data in bytes
+  size_t memoryUsage() const;
+
+  /// @brief write the object into a binary stream
+  /// @details The native byte order is used, the format is only intended for
+  /// temporary files read back by the same process.
+  /// @param[in] os output stream
+  void write(std::ostream &os) const;
+
+  /// @brief read the object from a binary stream
+  /// @details The stream should be positioned at the data written by write.
+  /// @param[in] is input stream
+  void read(std::istream &is);
+
+  /// @brief convert a single precision number to the half-precision format
+  /// @param[in] value number to convert
+  /// @return bit pattern of the nearest half-precision number
+  static uint16_t floatToHalf(float value);
+
+  /// @brief convert a half-precision number to single precision
+  /// @param[in] value bit pattern of the half-precision number
+  /// @return the same number in single precision
+  static float halfToFloat(uint16_t value);
+
+private:
+  /// @brief number of rows
+  casacore::uInt itsNRow;
+
+  /// @brief number of channels
+  casacore::uInt itsNChan;
+
+  /// @brief number of polarisations
+  casacore::uInt itsNPol;
+
+  /// @brief quantisation mode
+  Precision itsPrecision;
+
+  /// @brief quantised real and imaginary parts
+  /// @details The polarisation is the fastest varying index, then channel and row,
+  /// i.e. each row occupies a contiguous block. Values are either half-precision bit
+  /// patterns or 16-bit integers (stored as unsigned)
+  std::vector<uint16_t> itsData;
+
+  /// @brief scale factor for each row (INT16 mode only)
+  std::vector<casacore::Float> itsScale;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COMPACT_VISIBILITY_H
@@ -0,0 +1,174 @@
+/// @file
+///
+/// @brief Compact linear form of a uvw machine
+/// @details Conversion done by a uvw machine (including the delay) is linear with respect
+/// to the input uvw. This class holds the coefficients of this linear transformation
+/// obtained from the machine once, so the whole chunk can be rotated by a simple loop
+/// instead of going through the general code of the machine for every row.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_COMPILED_UVW_MACHINE_H
+#define ASKAP_ACCESSORS_COMPILED_UVW_MACHINE_H
+
+// own includes
+#include <askap/dataaccess/UVWBounds.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// std includes
+#include <cstddef>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Compact linear form of a uvw machine
+/// @details The structure holds the 3x3 matrix rotating uvw and the vector giving the delay
+/// per unit uvw, i.e. 12 doubles and nothing else. It can be copied with memcpy, stored in
+/// plain arrays and shared between threads. The coefficients are obtained by converting
+/// the unit vectors with the given machine (see compile), so any projection done by the
+/// machine is included as long as it is linear. The batched convertUVW has no branches in
+/// the loop over rows, which the compiler can vectorise.
+/// @ingroup dataaccess_hlp
+struct CompiledUVWMachine {
+   /// @brief obtain the coefficients from a uvw machine
+   /// @details The machine type should provide convertUVW(Double &delay, Vector<Double> &uvw)
+   /// (e.g. casacore::UVWMachine or TempUVWMachine).
+   /// @param[in] machine uvw machine to compile
+   /// @return compiled machine
+   template<typename Machine>
+   static CompiledUVWMachine compile(const Machine &machine);
+
+   /// @brief obtain the machine acting on uvw with the opposite sign of u and v
+   /// @details The result is equivalent to negating u and v before and after the conversion
+   /// by this machine (this sign convention is used around the machine in UVWRotationHandler).
+   /// @return compiled machine with the sign swap folded into the coefficients
+   CompiledUVWMachine flippedUV() const;
+
+   /// @brief convert a single uvw
+   /// @details This method has the same interface as that of the uvw machine.
+   /// @param[out] delay delay associated with the conversion
+   /// @param[in] uvw uvw vector to update (3 elements)
+   inline void convertUVW(casacore::Double &delay, casacore::Vector<casacore::Double> &uvw) const {
+      const double u = uvw[0], v = uvw[1], w = uvw[2];
+      uvw[0] = itsMatrix[0][0] * u + itsMatrix[0][1] * v + itsMatrix[0][2] * w;
+      uvw[1] = itsMatrix[1][0] * u + itsMatrix[1][1] * v + itsMatrix[1][2] * w;
+      uvw[2] = itsMatrix[2][0] * u + itsMatrix[2][1] * v + itsMatrix[2][2] * w;
+      delay = itsDelay[0] * u + itsDelay[1] * v + itsDelay[2] * w;
+   }
+
+   /// @brief convert a number of rows
+   /// @param[in] in pointer to the first input uvw
+   /// @param[out] out pointer to the first output uvw (can be the same as in)
+   /// @param[out] delays pointer to the first output delay
+   /// @param[in] nRows number of rows to process
+   inline void convertUVW(const casacore::RigidVector<double, 3> *in, casacore::RigidVector<double, 3> *out,
+                          double *delays, size_t nRows) const {
+      // local copies help the compiler to keep the coefficients in registers
+      const double m00 = itsMatrix[0][0], m01 = itsMatrix[0][1], m02 = itsMatrix[0][2];
+      const double m10 = itsMatrix[1][0], m11 = itsMatrix[1][1], m12 = itsMatrix[1][2];
+      const double m20 = itsMatrix[2][0], m21 = itsMatrix[2][1], m22 = itsMatrix[2][2];
+      const double d0 = itsDelay[0], d1 = itsDelay[1], d2 = itsDelay[2];
+      for (size_t row = 0; row < nRows; ++row) {
+           const double u = in[row](0);
+           const double v = in[row](1);
+           const double w = in[row](2);
+           out[row](0) = m00 * u + m01 * v + m02 * w;
+           out[row](1) = m10 * u + m11 * v + m12 * w;
+           out[row](2) = m20 * u + m21 * v + m22 * w;
+           delays[row] = d0 * u + d1 * v + d2 * w;
+      }
+   }
+
+   /// @brief convert a number of rows and update the bounding box
+   /// @param[in] in pointer to the first input uvw
+   /// @param[out] out pointer to the first output uvw (can be the same as in)
+   /// @param[out] delays pointer to the first output delay
+   /// @param[in] nRows number of rows to process
+   /// @param[in,out] bounds bounding box to add the output uvw to
+   inline void convertUVW(const casacore::RigidVector<double, 3> *in, casacore::RigidVector<double, 3> *out,
+                          double *delays, size_t nRows, UVWBounds &bounds) const {
+      convertUVW(in, out, delays, nRows);
+      UVWBounds runBounds;
+      for (size_t row = 0; row < nRows; ++row) {
+           runBounds.add(out[row](0), out[row](1), out[row](2));
+      }
+      bounds.add(runBounds);
+   }
+
+   /// @brief rotation matrix, output uvw = itsMatrix * input uvw
+   double itsMatrix[3][3];
+
+   /// @brief delay per unit input uvw
+   double itsDelay[3];
+};
+
+/// @brief obtain the coefficients from a uvw machine
+/// @details The machine type should provide convertUVW(Double &delay, Vector<Double> &uvw)
+/// (e.g. casacore::UVWMachine or TempUVWMachine).
+/// @param[in] machine uvw machine to compile
+/// @return compiled machine
+template<typename Machine>
+CompiledUVWMachine CompiledUVWMachine::compile(const Machine &machine)
+{
+  CompiledUVWMachine result;
+  casacore::Vector<casacore::Double> uvwBuffer(3);
+  for (int j = 0; j < 3; ++j) {
+       uvwBuffer.set(0.);
+       uvwBuffer(j) = 1.;
+       machine.convertUVW(result.itsDelay[j], uvwBuffer);
+       for (int i = 0; i < 3; ++i) {
+            result.itsMatrix[i][j] = uvwBuffer(i);
+       }
+  }
+  return result;
+}
+
+/// @brief obtain the machine acting on uvw with the opposite sign of u and v
+/// @details The result is equivalent to negating u and v before and after the conversion
+/// by this machine (this sign convention is used around the machine in UVWRotationHandler).
+/// @return compiled machine with the sign swap folded into the coefficients
+inline CompiledUVWMachine CompiledUVWMachine::flippedUV() const
+{
+  CompiledUVWMachine result;
+  for (int j = 0; j < 3; ++j) {
+       const double inSign = j < 2 ? -1. : 1.;
+       result.itsDelay[j] = inSign * itsDelay[j];
+       for (int i = 0; i < 3; ++i) {
+            result.itsMatrix[i][j] = (i < 2 ? -1. : 1.) * inSign * itsMatrix[i][j];
+       }
+  }
+  return result;
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_COMPILED_UVW_MACHINE_H
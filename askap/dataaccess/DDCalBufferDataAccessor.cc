@@ -40,6 +40,8 @@
 
 // own includes
 #include <askap/dataaccess/DDCalBufferDataAccessor.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -48,7 +50,7 @@ using namespace askap::accessors;
 /// construct an object linked with the given const accessor
 /// @param[in] acc a reference to the associated accessor
 DDCalBufferDataAccessor::DDCalBufferDataAccessor(const IConstDataAccessor &acc) :
-      MetaDataAccessor(acc), itsNDir(1) {}
+      MetaDataAccessor(acc), itsNDir(1), itsMaxResident(0), itsUseCounter(0) {}
   
 /// Read-only visibilities (a cube is nRow x nChannel x nPol; 
 /// each element is a complex visibility)
@@ -58,6 +60,9 @@ DDCalBufferDataAccessor::DDCalBufferDataAccessor(const IConstDataAccessor &acc)
 ///
 const casacore::Cube<casacore::Complex>& DDCalBufferDataAccessor::visibility() const
 {
+  if (isStreaming()) {
+      ASKAPTHROW(DataAccessLogicError, "The whole buffer is not available in the streaming mode, use directionVisibility");
+  }
   resizeBufferIfNeeded();
   return itsBuffer;
 }
@@ -70,7 +75,17 @@ const casacore::Cube<casacore::Complex>& DDCalBufferDataAccessor::visibility() c
 ///
 casacore::Cube<casacore::Complex>& DDCalBufferDataAccessor::rwVisibility()
 {
+  if (isStreaming()) {
+      ASKAPTHROW(DataAccessLogicError, "The whole buffer is not available in the streaming mode, use rwDirectionVisibility");
+  }
   resizeBufferIfNeeded();
+  {
+    #ifdef _OPENMP
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    #endif
+    // all directions are assumed to be filled by the caller
+    itsDirectionStored.assign(itsNDir, true);
+  }
   return itsBuffer;
 }
 
@@ -85,6 +100,203 @@ void DDCalBufferDataAccessor::resizeBufferIfNeeded() const
   if (itsBuffer.nrow() != itsNDir*acc.nRow() || itsBuffer.ncolumn() != acc.nChannel() ||
                                         itsBuffer.nplane() != acc.nPol()) {
       itsBuffer.resize(itsNDir*acc.nRow(), acc.nChannel(), acc.nPol());
+      itsDirectionViews.clear();
+  }
+  if (itsDirectionViews.size() != itsNDir) {
+      itsDirectionViews.resize(itsNDir);
+      itsDirectionStored.assign(itsNDir, false);
+      for (casacore::uInt dir = 0; dir < itsNDir; ++dir) {
+           itsDirectionViews[dir].reference(itsBuffer(casacore::Slice(dir * acc.nRow(), acc.nRow()),
+                                casacore::Slice(), casacore::Slice()));
+      }
+  }
+}
+
+/// @brief switch to the streaming mode
+/// @details Only up to maxResident directions are kept in memory, others are stored
+/// via the given buffer manager under the given name with the direction as the index.
+/// Directions held in memory at the time of this call are discarded.
+/// @param[in] bufferMgr buffer manager to store evicted directions
+/// @param[in] maxResident maximum number of directions held in memory (at least 1)
+/// @param[in] name name of the buffer used for all directions (should be unique for
+///            the given buffer manager)
+void DDCalBufferDataAccessor::configureStreaming(const boost::shared_ptr<IBufferManager> &bufferMgr, 
+                          casacore::uInt maxResident, const std::string &name)
+{
+  ASKAPCHECK(bufferMgr, "An attempt to configure streaming with an empty buffer manager");
+  ASKAPCHECK(maxResident > 0, "At least one direction should be held in memory in the streaming mode");
+  discardDirections();
+  itsBufferManager = bufferMgr;
+  itsMaxResident = maxResident;
+  itsBufferName = name;
+  // references to resident directions should survive additions
+  itsResident.reserve(itsMaxResident);
+  itsBuffer.resize(0,0,0);
+  itsDirectionViews.clear();
+}
+
+/// @brief set the function computing directions on demand
+/// @details It is used for directions which have not been written in the current chunk
+/// (in both modes of operation, it is not used if the function is empty)
+/// @param[in] filler function to compute visibilities of one direction
+void DDCalBufferDataAccessor::setDirectionFiller(const DirectionFiller &filler)
+{
+  itsFiller = filler;
+}
+
+/// @brief read-only visibilities of one direction
+/// @details In the streaming mode, the reference is valid until maxResident other
+/// directions are requested.
+/// @param[in] dir direction index
+/// @return a reference to nRow x nChannel x nPol cube
+const casacore::Cube<casacore::Complex>& DDCalBufferDataAccessor::directionVisibility(casacore::uInt dir) const
+{
+  checkDirection(dir);
+  if (isStreaming()) {
+      return residentDirection(dir).itsVisibility;
+  }
+  resizeBufferIfNeeded();
+  #ifdef _OPENMP
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  #endif
+  ASKAPDEBUGASSERT(dir < itsDirectionViews.size());
+  if (!itsDirectionStored[dir]) {
+      initDirection(dir, itsDirectionViews[dir]);
+      itsDirectionStored[dir] = true;
+  }
+  return itsDirectionViews[dir];
+}
+
+/// @brief read-write visibilities of one direction
+/// @details In the streaming mode, the reference is valid until maxResident other
+/// directions are requested. The direction is written to the buffer manager when evicted.
+/// @param[in] dir direction index
+/// @return a reference to nRow x nChannel x nPol cube
+casacore::Cube<casacore::Complex>& DDCalBufferDataAccessor::rwDirectionVisibility(casacore::uInt dir)
+{
+  if (isStreaming()) {
+      checkDirection(dir);
+      ResidentDirection &rd = residentDirection(dir);
+      rd.itsModified = true;
+      return rd.itsVisibility;
+  }
+  // the view is a reference to the buffer owned by this class
+  return const_cast<casacore::Cube<casacore::Complex>&>(directionVisibility(dir));
+}
+
+/// @brief write all modified directions held in memory to the buffer manager
+/// @details This method does nothing if the streaming mode is not configured
+void DDCalBufferDataAccessor::flushDirections() const
+{
+  #ifdef _OPENMP
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  #endif
+  for (std::vector<ResidentDirection>::iterator it = itsResident.begin(); it != itsResident.end(); ++it) {
+       if (it->itsModified) {
+           ASKAPDEBUGASSERT(itsBufferManager);
+           itsBufferManager->writeBuffer(it->itsVisibility, itsBufferName, it->itsDir);
+           ASKAPDEBUGASSERT(it->itsDir < itsDirectionStored.size());
+           itsDirectionStored[it->itsDir] = true;
+           it->itsModified = false;
+       }
+  }
+}
+
+/// @brief forget the content of all directions
+/// @details This method is intended to be called when the accessor is reused for a new 
+/// chunk of the same shape. The change of shape discards the content automatically.
+/// Next request of a direction will start from scratch (i.e. filler or zeros).
+void DDCalBufferDataAccessor::discardDirections()
+{
+  #ifdef _OPENMP
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  #endif
+  itsResident.clear();
+  itsDirectionStored.assign(itsNDir, false);
+}
+
+/// @return number of directions held in memory
+casacore::uInt DDCalBufferDataAccessor::nResidentDirections() const
+{
+  #ifdef _OPENMP
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  #endif
+  return isStreaming() ? itsResident.size() : itsNDir;
+}
+
+/// @brief obtain the direction held in memory, loading it if necessary
+/// @details This is the implementation of the streaming mode
+/// @param[in] dir direction index
+/// @return a reference to the structure with the direction
+DDCalBufferDataAccessor::ResidentDirection& DDCalBufferDataAccessor::residentDirection(casacore::uInt dir) const
+{
+  ASKAPDEBUGASSERT(isStreaming());
+  #ifdef _OPENMP
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  #endif
+  const IConstDataAccessor &acc = getROAccessor();
+  const casacore::IPosition shape(3, acc.nRow(), acc.nChannel(), acc.nPol());
+  if (!shape.isEqual(itsDirectionShape) || itsDirectionStored.size() != itsNDir) {
+      // new chunk, the content is no longer relevant
+      itsDirectionShape = shape;
+      itsResident.clear();
+      itsDirectionStored.assign(itsNDir, false);
+  }
+  ++itsUseCounter;
+  std::vector<ResidentDirection>::iterator lru = itsResident.begin();
+  for (std::vector<ResidentDirection>::iterator it = itsResident.begin(); it != itsResident.end(); ++it) {
+       if (it->itsDir == dir) {
+           it->itsLastUse = itsUseCounter;
+           return *it;
+       }
+       if (it->itsLastUse < lru->itsLastUse) {
+           lru = it;
+       }
+  }
+  if (itsResident.size() < itsMaxResident) {
+      itsResident.push_back(ResidentDirection());
+      lru = itsResident.end() - 1;
+  } else {
+      ASKAPDEBUGASSERT(lru != itsResident.end());
+      if (lru->itsModified) {
+          itsBufferManager->writeBuffer(lru->itsVisibility, itsBufferName, lru->itsDir);
+          itsDirectionStored[lru->itsDir] = true;
+      }
+  }
+  lru->itsDir = dir;
+  lru->itsModified = false;
+  lru->itsLastUse = itsUseCounter;
+  if (itsDirectionStored[dir]) {
+      itsBufferManager->readBuffer(lru->itsVisibility, itsBufferName, dir);
+      ASKAPCHECK(lru->itsVisibility.shape().isEqual(shape), "Direction "<<dir<<" stored in the buffer has shape "<<
+                 lru->itsVisibility.shape()<<", expected "<<shape);
+  } else {
+      if (!lru->itsVisibility.shape().isEqual(shape)) {
+          lru->itsVisibility.resize(shape);
+      }
+      initDirection(dir, lru->itsVisibility);
+  }
+  return *lru;
+}
+
+/// @brief fill the cube of a direction, which has not been written in this chunk
+/// @param[in] dir direction index
+/// @param[in] vis cube to fill (already resized)
+void DDCalBufferDataAccessor::initDirection(casacore::uInt dir, casacore::Cube<casacore::Complex> &vis) const
+{
+  if (itsFiller) {
+      itsFiller(dir, vis);
+  } else {
+      vis.set(casacore::Complex(0.,0.));
+  }
+}
+
+/// @brief check the direction index
+/// @param[in] dir direction index
+void DDCalBufferDataAccessor::checkDirection(casacore::uInt dir) const
+{
+  if (dir >= itsNDir) {
+      ASKAPTHROW(DataAccessLogicError, "Direction "<<dir<<" is requested, only "<<itsNDir<<" direction(s) are defined");
   }
 }
 
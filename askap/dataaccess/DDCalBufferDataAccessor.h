@@ -44,6 +44,15 @@
 // own includes
 #include <askap/dataaccess/MetaDataAccessor.h>
 #include <askap/dataaccess/IFlagAndNoiseDataAccessor.h>
+#include <askap/dataaccess/IBufferManager.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+
+// std includes
+#include <string>
+#include <vector>
 
 #ifdef _OPENMP
 //boost include
@@ -71,6 +80,16 @@ namespace accessors {
 /// all metadata requests and returns a reference to the internal buffer for
 /// both read-only and read-write visibility access methods (the buffer is
 /// resized automatically to match the cube provided by the accessor). 
+///
+/// The buffer holds nDir blocks of nRow rows, one per calibration direction, so the
+/// memory grows linearly with the number of directions. In the streaming mode (see
+/// configureStreaming), only a limited number of directions is kept in memory and
+/// accessed via directionVisibility and rwDirectionVisibility. The least recently used
+/// direction is evicted when another one is requested. Modified directions are written
+/// to the given buffer manager and read back on the next request. Directions which have
+/// not been written in the current chunk are computed by the filler, if one is set, or
+/// start as zeros. The whole buffer (visibility and rwVisibility methods) is not
+/// available in this mode.
 /// @ingroup dataaccess_hlp
 class DDCalBufferDataAccessor : virtual public MetaDataAccessor,
                                 virtual public IDataAccessor
@@ -101,16 +120,122 @@ public:
   /// (a cube is (nDir*nRow) x nChannel x nPol; each element is a complex visibility)
   ///
   void setNDir(casacore::uInt nDir) { itsNDir = nDir; }
- 
+
+  /// @brief type of the function computing visibilities of one direction on demand
+  /// @details The parameters are the direction index and the nRow x nChannel x nPol
+  /// cube to fill (already resized)
+  typedef boost::function<void(casacore::uInt, casacore::Cube<casacore::Complex>&)> DirectionFiller;
+
+  /// @brief switch to the streaming mode
+  /// @details Only up to maxResident directions are kept in memory, others are stored
+  /// via the given buffer manager under the given name with the direction as the index.
+  /// Directions held in memory at the time of this call are discarded.
+  /// @param[in] bufferMgr buffer manager to store evicted directions
+  /// @param[in] maxResident maximum number of directions held in memory (at least 1)
+  /// @param[in] name name of the buffer used for all directions (should be unique for
+  ///            the given buffer manager)
+  void configureStreaming(const boost::shared_ptr<IBufferManager> &bufferMgr, casacore::uInt maxResident,
+                          const std::string &name = "DDCAL");
+
+  /// @brief set the function computing directions on demand
+  /// @details It is used for directions which have not been written in the current chunk
+  /// (in both modes of operation, it is not used if the function is empty)
+  /// @param[in] filler function to compute visibilities of one direction
+  void setDirectionFiller(const DirectionFiller &filler);
+
+  /// @return true, if the streaming mode is configured
+  inline bool isStreaming() const { return static_cast<bool>(itsBufferManager); }
+
+  /// @brief read-only visibilities of one direction
+  /// @details In the streaming mode, the reference is valid until maxResident other
+  /// directions are requested.
+  /// @param[in] dir direction index
+  /// @return a reference to nRow x nChannel x nPol cube
+  const casacore::Cube<casacore::Complex>& directionVisibility(casacore::uInt dir) const;
+
+  /// @brief read-write visibilities of one direction
+  /// @details In the streaming mode, the reference is valid until maxResident other
+  /// directions are requested. The direction is written to the buffer manager when evicted.
+  /// @param[in] dir direction index
+  /// @return a reference to nRow x nChannel x nPol cube
+  casacore::Cube<casacore::Complex>& rwDirectionVisibility(casacore::uInt dir);
+
+  /// @brief write all modified directions held in memory to the buffer manager
+  /// @details This method does nothing if the streaming mode is not configured
+  void flushDirections() const;
+
+  /// @brief forget the content of all directions
+  /// @details This method is intended to be called when the accessor is reused for a new 
+  /// chunk of the same shape. The change of shape discards the content automatically.
+  /// Next request of a direction will start from scratch (i.e. filler or zeros).
+  void discardDirections();
+
+  /// @return number of directions held in memory
+  casacore::uInt nResidentDirections() const;
   
 private:
+  /// @brief a direction held in memory in the streaming mode
+  struct ResidentDirection {
+     /// @brief direction index
+     casacore::uInt itsDir;
+     /// @brief true, if the cube has been modified since it has been loaded
+     bool itsModified;
+     /// @brief value of the use counter at the last access
+     casacore::uInt64 itsLastUse;
+     /// @brief visibilities of this direction
+     casacore::Cube<casacore::Complex> itsVisibility;
+  };
+
   /// @brief a helper method to ensure the buffer has appropriate shape
   void resizeBufferIfNeeded() const;
+
+  /// @brief obtain the direction held in memory, loading it if necessary
+  /// @details This is the implementation of the streaming mode
+  /// @param[in] dir direction index
+  /// @return a reference to the structure with the direction
+  ResidentDirection& residentDirection(casacore::uInt dir) const;
+
+  /// @brief fill the cube of a direction, which has not been written in this chunk
+  /// @param[in] dir direction index
+  /// @param[in] vis cube to fill (already resized)
+  void initDirection(casacore::uInt dir, casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief check the direction index
+  /// @param[in] dir direction index
+  void checkDirection(casacore::uInt dir) const;
  
   mutable casacore::uInt itsNDir;
  
   /// @brief actual buffer
   mutable casacore::Cube<casacore::Complex> itsBuffer;
+
+  /// @brief views of individual directions into itsBuffer
+  mutable std::vector<casacore::Cube<casacore::Complex> > itsDirectionViews;
+
+  /// @brief buffer manager used for evicted directions, empty if not streaming
+  boost::shared_ptr<IBufferManager> itsBufferManager;
+
+  /// @brief name of the buffer in the streaming mode
+  std::string itsBufferName;
+
+  /// @brief maximum number of directions held in memory in the streaming mode
+  casacore::uInt itsMaxResident;
+
+  /// @brief directions held in memory in the streaming mode
+  mutable std::vector<ResidentDirection> itsResident;
+
+  /// @brief flags showing which directions have been written to the buffer manager (or
+  /// to the buffer in the memory mode) in the current chunk
+  mutable std::vector<bool> itsDirectionStored;
+
+  /// @brief shape of a single direction, the chunk is considered new if it changes
+  mutable casacore::IPosition itsDirectionShape;
+
+  /// @brief counter of accesses used to find the least recently used direction
+  mutable casacore::uInt64 itsUseCounter;
+
+  /// @brief function computing directions on demand
+  DirectionFiller itsFiller;
   
   #ifdef _OPENMP
   /// @brief synchronisation lock for resizing of the buffer
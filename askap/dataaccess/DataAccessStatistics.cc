@@ -0,0 +1,392 @@
+/// @file
+///
+/// @brief Counters and timers of the data access stages
+/// @details This class accumulates the number of calls, the number of bytes
+/// delivered, cache hits and misses and the wall time for named stages of the
+/// data access layer. The individual calls can be traced as well.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+// system includes
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".DataAccessStatistics");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief file to write the trace into at exit
+/// @return value of ASKAP_DATAACCESS_TRACE environment variable, empty string if it is not set
+std::string traceFileFromEnvironment()
+{
+  const char *value = std::getenv("ASKAP_DATAACCESS_TRACE");
+  return value != NULL ? value : "";
+}
+
+/// @brief initial state of the statistics collection
+/// @return true, if ASKAP_DATAACCESS_STATISTICS environment variable is set to a non-zero value
+/// or the trace is requested
+bool enabledByEnvironment()
+{
+  const char *value = std::getenv("ASKAP_DATAACCESS_STATISTICS");
+  return (value != NULL && std::atoi(value) != 0) || !traceFileFromEnvironment().empty();
+}
+
+/// @brief counters of all stages
+/// @details A function-level static is used to avoid problems with the order of static
+/// initialisation (stages can be recorded from other static objects)
+/// @return reference to the map of counters
+std::map<std::string, DataAccessStatistics::Counters>& stageCounters()
+{
+  static std::map<std::string, DataAccessStatistics::Counters> counters;
+  return counters;
+}
+
+/// @brief mutex protecting the counters and the trace
+/// @return reference to the mutex
+boost::mutex& statisticsMutex()
+{
+  static boost::mutex mutex;
+  return mutex;
+}
+
+/// @brief events of the trace
+/// @return reference to the event buffer
+std::vector<DataAccessStatistics::TraceEvent>& traceBuffer()
+{
+  static std::vector<DataAccessStatistics::TraceEvent> events;
+  return events;
+}
+
+/// @brief maximum number of events in the trace
+size_t theMaxTraceEvents = 1000000;
+
+/// @brief number of events which didn't fit into the trace
+size_t theDroppedTraceEvents = 0;
+
+/// @brief origin of the trace timestamps
+/// @return time of the first call (which happens during static initialisation)
+boost::chrono::steady_clock::time_point traceOrigin()
+{
+  static const boost::chrono::steady_clock::time_point origin = boost::chrono::steady_clock::now();
+  return origin;
+}
+
+/// @brief small index of the calling thread
+/// @details Chrome trace viewers show each thread on its own track, consecutive numbers are
+/// easier to read than native thread ids.
+/// @return index of the calling thread
+unsigned int threadIndex()
+{
+  static std::atomic<unsigned int> nThreads(0);
+  thread_local const unsigned int index = ++nThreads;
+  return index;
+}
+
+/// @brief category of the event in the trace
+/// @param[in] stage name of the stage
+/// @return class name, i.e. the part of the stage name before "::" (or the whole name)
+std::string traceCategory(const std::string &stage)
+{
+  return stage.substr(0, stage.find("::"));
+}
+
+/// @brief write a string as JSON
+/// @param[in] os stream to write to
+/// @param[in] str string to write
+void writeJSONString(std::ostream &os, const std::string &str)
+{
+  os << '"';
+  for (const char c : str) {
+       if (c == '"' || c == '\\') {
+           os << '\\' << c;
+       } else if (static_cast<unsigned char>(c) < 0x20) {
+           os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) <<
+                 std::dec << std::setfill(' ');
+       } else {
+           os << c;
+       }
+  }
+  os << '"';
+}
+
+/// @brief writes the trace requested via ASKAP_DATAACCESS_TRACE at exit
+/// @details The statics used by the trace are constructed first, so they are
+/// destroyed after this object.
+struct TraceWriterAtExit {
+  /// @brief remember the file name
+  TraceWriterAtExit() : itsFileName(traceFileFromEnvironment())
+  {
+    statisticsMutex();
+    stageCounters();
+    traceBuffer();
+    traceOrigin();
+  }
+
+  /// @brief write the trace, if requested
+  ~TraceWriterAtExit()
+  {
+    if (!itsFileName.empty()) {
+        try {
+           DataAccessStatistics::writeTrace(itsFileName);
+        }
+        catch (const std::exception &ex) {
+           ASKAPLOG_ERROR_STR(logger, "Failed to write the trace into "<<itsFileName<<": "<<ex.what());
+        }
+    }
+  }
+
+  /// @brief name of the trace file, empty if not requested
+  std::string itsFileName;
+};
+
+/// @brief the trace writer
+TraceWriterAtExit theTraceWriter;
+
+} // anonymous namespace
+
+std::atomic<bool> DataAccessStatistics::theirEnabled(enabledByEnvironment());
+
+std::atomic<bool> DataAccessStatistics::theirTracing(!traceFileFromEnvironment().empty());
+
+/// @brief initialise all counters with zeros
+DataAccessStatistics::Counters::Counters() : itsCalls(0), itsBytes(0), itsHits(0), itsMisses(0), itsTime(0.) {}
+
+/// @brief start timing
+/// @param[in] stage name of the stage, should be a string literal (the pointer is stored)
+DataAccessStatistics::ScopedTimer::ScopedTimer(const char *stage) : itsStage(stage),
+      itsActive(DataAccessStatistics::enabled()), itsHit(false), itsMiss(false), itsBytes(0)
+{
+  if (itsActive) {
+      itsStart = boost::chrono::steady_clock::now();
+  }
+}
+
+/// @brief stop timing and add the result to the statistics
+DataAccessStatistics::ScopedTimer::~ScopedTimer()
+{
+  if (itsActive) {
+      const double time = boost::chrono::duration<double>(boost::chrono::steady_clock::now() -
+                          itsStart).count();
+      DataAccessStatistics::add(itsStage, 1, time, itsBytes, itsHit ? 1 : 0, itsMiss ? 1 : 0);
+      if (DataAccessStatistics::tracing()) {
+          DataAccessStatistics::trace(itsStage, time, itsBytes);
+      }
+  }
+}
+
+/// @brief switch the collection on or off
+/// @details The statistics accumulated so far are kept.
+/// @param[in] enable true to collect the statistics
+void DataAccessStatistics::enable(bool enable)
+{
+  theirEnabled.store(enable);
+}
+
+/// @brief obtain the counters of the given stage
+/// @param[in] stage name of the stage
+/// @return a copy of the counters, all zeros if nothing has been recorded for this stage
+DataAccessStatistics::Counters DataAccessStatistics::counters(const std::string &stage)
+{
+  boost::lock_guard<boost::mutex> lock(statisticsMutex());
+  const std::map<std::string, Counters>::const_iterator ci = stageCounters().find(stage);
+  return ci == stageCounters().end() ? Counters() : ci->second;
+}
+
+/// @brief obtain the counters of all stages
+/// @return a copy of the counters for all stages recorded so far
+std::map<std::string, DataAccessStatistics::Counters> DataAccessStatistics::allCounters()
+{
+  boost::lock_guard<boost::mutex> lock(statisticsMutex());
+  return stageCounters();
+}
+
+/// @brief reset all counters
+/// @details The trace events are discarded as well.
+void DataAccessStatistics::reset()
+{
+  boost::lock_guard<boost::mutex> lock(statisticsMutex());
+  stageCounters().clear();
+  traceBuffer().clear();
+  theDroppedTraceEvents = 0;
+}
+
+/// @brief switch tracing on or off
+/// @details Switching tracing on also enables the statistics. The events recorded so far are kept.
+/// @param[in] enable true to trace the calls
+/// @param[in] maxEvents maximum number of events kept, further events are counted as dropped
+void DataAccessStatistics::enableTrace(bool enable, size_t maxEvents)
+{
+  {
+    boost::lock_guard<boost::mutex> lock(statisticsMutex());
+    theMaxTraceEvents = maxEvents;
+  }
+  if (enable) {
+      DataAccessStatistics::enable();
+  }
+  theirTracing.store(enable);
+}
+
+/// @brief obtain the events recorded so far
+/// @return a copy of the events in the order they have been recorded
+std::vector<DataAccessStatistics::TraceEvent> DataAccessStatistics::traceEvents()
+{
+  boost::lock_guard<boost::mutex> lock(statisticsMutex());
+  return traceBuffer();
+}
+
+/// @return number of events which didn't fit into the trace
+size_t DataAccessStatistics::droppedEvents()
+{
+  boost::lock_guard<boost::mutex> lock(statisticsMutex());
+  return theDroppedTraceEvents;
+}
+
+/// @brief write the trace in the Chrome trace event format
+/// @details Each call becomes a complete ("X") event with the class name of the stage
+/// as its category. The counters of all stages and the number of dropped events are
+/// written into the otherData section.
+/// @param[in] os stream to write to
+void DataAccessStatistics::writeTrace(std::ostream &os)
+{
+  const std::vector<TraceEvent> events = traceEvents();
+  const std::map<std::string, Counters> counters = allCounters();
+  const size_t dropped = droppedEvents();
+  const long pid = static_cast<long>(getpid());
+  const std::streamsize precision = os.precision(3);
+  os.setf(std::ios::fixed, std::ios::floatfield);
+  os << "{\"traceEvents\":[\n";
+  os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":"<<pid<<",\"tid\":0,\"args\":{\"name\":\"accessors\"}}";
+  for (const TraceEvent &event : events) {
+       os << ",\n{\"name\":";
+       writeJSONString(os, event.itsStage);
+       os << ",\"cat\":";
+       writeJSONString(os, traceCategory(event.itsStage));
+       os << ",\"ph\":\"X\",\"ts\":"<<event.itsStart<<",\"dur\":"<<event.itsDuration<<",\"pid\":"<<pid<<
+             ",\"tid\":"<<event.itsThread<<",\"args\":{\"bytes\":"<<event.itsBytes<<"}}";
+  }
+  os << "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"droppedEvents\":"<<dropped<<",\"stages\":{";
+  os.precision(9);
+  for (std::map<std::string, Counters>::const_iterator ci = counters.begin(); ci != counters.end(); ++ci) {
+       const Counters &c = ci->second;
+       os << (ci == counters.begin() ? "\n" : ",\n");
+       writeJSONString(os, ci->first);
+       os << ":{\"calls\":"<<c.itsCalls<<",\"time\":"<<c.itsTime<<",\"bytes\":"<<c.itsBytes<<
+             ",\"hits\":"<<c.itsHits<<",\"misses\":"<<c.itsMisses<<"}";
+  }
+  os << "}}}\n";
+  os.unsetf(std::ios::floatfield);
+  os.precision(precision);
+}
+
+/// @brief write the trace into a file
+/// @param[in] fname file name (e.g. trace.json)
+void DataAccessStatistics::writeTrace(const std::string &fname)
+{
+  std::ofstream os(fname.c_str());
+  ASKAPCHECK(os, "Unable to open "<<fname<<" to write the trace: "<<std::strerror(errno));
+  writeTrace(os);
+  os.close();
+  ASKAPCHECK(os, "Failed to write the trace into "<<fname);
+  ASKAPLOG_INFO_STR(logger, "Trace of "<<traceEvents().size()<<" data access call(s) has been written into "<<fname);
+}
+
+/// @brief write the summary into the log
+/// @details One line per stage is written at the INFO level, nothing is done
+/// if no stage has been recorded.
+void DataAccessStatistics::log()
+{
+  const std::map<std::string, Counters> counters = allCounters();
+  if (counters.size() == 0) {
+      return;
+  }
+  ASKAPLOG_INFO_STR(logger, "Data access statistics for "<<counters.size()<<" stage(s):");
+  for (std::map<std::string, Counters>::const_iterator ci = counters.begin(); ci != counters.end(); ++ci) {
+       const Counters &c = ci->second;
+       ASKAPLOG_INFO_STR(logger, "  "<<ci->first<<": "<<c.itsCalls<<" call(s), "<<c.itsTime<<" s, "<<
+                  c.itsBytes / 1048576.<<" MB, "<<c.itsHits<<" hit(s), "<<c.itsMisses<<" miss(es)");
+  }
+}
+
+/// @brief apply a change to the counters of the given stage
+/// @param[in] stage name of the stage
+/// @param[in] calls number of calls to add
+/// @param[in] time time to add (in seconds)
+/// @param[in] bytes number of bytes to add
+/// @param[in] hits number of hits to add
+/// @param[in] misses number of misses to add
+void DataAccessStatistics::add(const std::string &stage, size_t calls, double time, size_t bytes,
+                               size_t hits, size_t misses)
+{
+  boost::lock_guard<boost::mutex> lock(statisticsMutex());
+  Counters &c = stageCounters()[stage];
+  c.itsCalls += calls;
+  c.itsTime += time;
+  c.itsBytes += bytes;
+  c.itsHits += hits;
+  c.itsMisses += misses;
+}
+
+/// @brief add an event which has just finished to the trace
+/// @param[in] stage name of the stage (string literal)
+/// @param[in] time duration in seconds
+/// @param[in] bytes number of bytes delivered
+void DataAccessStatistics::trace(const char *stage, double time, size_t bytes)
+{
+  const double end = boost::chrono::duration<double, boost::micro>(boost::chrono::steady_clock::now() -
+                     traceOrigin()).count();
+  TraceEvent event;
+  event.itsStage = stage;
+  event.itsDuration = time * 1e6;
+  event.itsStart = end - event.itsDuration;
+  event.itsThread = threadIndex();
+  event.itsBytes = bytes;
+  boost::lock_guard<boost::mutex> lock(statisticsMutex());
+  std::vector<TraceEvent> &events = traceBuffer();
+  if (events.size() < theMaxTraceEvents) {
+      events.push_back(event);
+  } else {
+      ++theDroppedTraceEvents;
+  }
+}
@@ -0,0 +1,265 @@
+/// @file
+///
+/// @brief Counters and timers of the data access stages
+/// @details It is often hard to tell where the iteration time goes: reading the
+/// table, flag handling, uvw rotation, measure conversions or the code using the
+/// accessor. This class accumulates the number of calls, the number of bytes
+/// delivered, cache hits and misses and the wall time for named stages of the
+/// data access layer, so the summary can be logged at the end of the run.
+/// The individual calls can also be recorded as a trace in the Chrome trace event
+/// format understood by chrome://tracing and Perfetto. The same instrumentation is
+/// used by the calibration, image and VOTable accessors.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_DATA_ACCESS_STATISTICS_H
+#define ASKAP_ACCESSORS_DATA_ACCESS_STATISTICS_H
+
+// boost includes
+#include <boost/chrono.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+#include <map>
+#include <vector>
+#include <ostream>
+#include <atomic>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Counters and timers of the data access stages
+/// @details The statistics are accumulated per process for the stages identified by
+/// name (e.g. "TableConstDataIterator::fillVisibility"). Collection is disabled by default
+/// and can be switched on with enable (or by setting the ASKAP_DATAACCESS_STATISTICS environment
+/// variable to a non-zero value), then the summary can be logged with log. While disabled,
+/// the cost of instrumentation is a check of a single flag. If the library is built without
+/// the ASKAP_DATAACCESS_STATISTICS preprocessor definition (see the ENABLE_DATAACCESS_STATISTICS
+/// option of cmake), enabled always returns false and the instrumentation is optimised away.
+///
+/// If tracing is switched on with enableTrace, each call timed by ScopedTimer (or given to
+/// record) is also kept as an event, up to the given number of events. The trace can be written
+/// with writeTrace. Setting the ASKAP_DATAACCESS_TRACE environment variable to a file name
+/// switches on both the statistics and tracing, the trace is then written into this file
+/// at the exit of the process. All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class DataAccessStatistics {
+public:
+  /// @brief accumulated values for a single stage
+  struct Counters {
+     /// @brief initialise all counters with zeros
+     Counters();
+
+     /// @brief number of calls
+     size_t itsCalls;
+
+     /// @brief number of bytes delivered
+     size_t itsBytes;
+
+     /// @brief number of requests served from a cache
+     size_t itsHits;
+
+     /// @brief number of requests which required the data to be read or computed
+     size_t itsMisses;
+
+     /// @brief total wall time in seconds
+     double itsTime;
+  };
+
+  /// @brief a single call recorded in the trace
+  struct TraceEvent {
+     /// @brief name of the stage (string literal)
+     const char *itsStage;
+
+     /// @brief start time in microseconds since the start of the process
+     double itsStart;
+
+     /// @brief duration in microseconds
+     double itsDuration;
+
+     /// @brief index of the thread (in the order threads have first recorded an event)
+     unsigned int itsThread;
+
+     /// @brief number of bytes delivered
+     size_t itsBytes;
+  };
+
+  /// @brief helper class timing a scope
+  /// @details The time between construction and destruction is added to the statistics
+  /// of the given stage as one call. Nothing is done if the statistics are disabled at
+  /// the time of construction.
+  class ScopedTimer : public boost::noncopyable {
+  public:
+     /// @brief start timing
+     /// @param[in] stage name of the stage, should be a string literal (the pointer is stored)
+     explicit ScopedTimer(const char *stage);
+
+     /// @brief stop timing and add the result to the statistics
+     ~ScopedTimer();
+
+     /// @brief add the number of bytes delivered in this call
+     /// @param[in] bytes number of bytes
+     inline void addBytes(size_t bytes) { itsBytes += bytes; }
+
+     /// @brief mark this call as served from the cache
+     inline void hit() { itsHit = true; }
+
+     /// @brief mark this call as not served from the cache
+     inline void miss() { itsMiss = true; }
+
+  private:
+     /// @brief name of the stage
+     const char *itsStage;
+
+     /// @brief true, if the statistics were enabled at construction
+     bool itsActive;
+
+     /// @brief true, if the call is marked as a cache hit
+     bool itsHit;
+
+     /// @brief true, if the call is marked as a cache miss
+     bool itsMiss;
+
+     /// @brief number of bytes delivered
+     size_t itsBytes;
+
+     /// @brief time of construction
+     boost::chrono::steady_clock::time_point itsStart;
+  };
+
+  /// @brief check whether the statistics are collected
+  /// @return true, if the statistics are collected
+  static inline bool enabled() {
+#ifdef ASKAP_DATAACCESS_STATISTICS
+    return theirEnabled.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+  }
+
+  /// @brief switch the collection on or off
+  /// @details The statistics accumulated so far are kept.
+  /// @param[in] enable true to collect the statistics
+  static void enable(bool enable = true);
+
+  /// @brief add a call to the statistics of the given stage
+  /// @details Nothing is done if the statistics are disabled.
+  /// @param[in] stage name of the stage
+  /// @param[in] time wall time of the call in seconds
+  /// @param[in] bytes number of bytes delivered
+  static inline void record(const char *stage, double time, size_t bytes = 0)
+       { if (enabled()) { add(stage, 1, time, bytes, 0, 0); if (tracing()) { trace(stage, time, bytes); } } }
+
+  /// @brief count a cache hit for the given stage
+  /// @details Nothing is done if the statistics are disabled.
+  /// @param[in] stage name of the stage
+  static inline void countHit(const char *stage) { if (enabled()) { add(stage, 0, 0., 0, 1, 0); } }
+
+  /// @brief count a cache miss for the given stage
+  /// @details Nothing is done if the statistics are disabled.
+  /// @param[in] stage name of the stage
+  static inline void countMiss(const char *stage) { if (enabled()) { add(stage, 0, 0., 0, 0, 1); } }
+
+  /// @brief obtain the counters of the given stage
+  /// @param[in] stage name of the stage
+  /// @return a copy of the counters, all zeros if nothing has been recorded for this stage
+  static Counters counters(const std::string &stage);
+
+  /// @brief obtain the counters of all stages
+  /// @return a copy of the counters for all stages recorded so far
+  static std::map<std::string, Counters> allCounters();
+
+  /// @brief reset all counters
+  /// @details The trace events are discarded as well.
+  static void reset();
+
+  /// @brief check whether the calls are traced
+  /// @return true, if the statistics are collected and the calls are traced
+  static inline bool tracing() {
+    return enabled() && theirTracing.load(std::memory_order_relaxed);
+  }
+
+  /// @brief switch tracing on or off
+  /// @details Switching tracing on also enables the statistics. The events recorded so far are kept.
+  /// @param[in] enable true to trace the calls
+  /// @param[in] maxEvents maximum number of events kept, further events are counted as dropped
+  static void enableTrace(bool enable = true, size_t maxEvents = 1000000);
+
+  /// @brief obtain the events recorded so far
+  /// @return a copy of the events in the order they have been recorded
+  static std::vector<TraceEvent> traceEvents();
+
+  /// @return number of events which didn't fit into the trace
+  static size_t droppedEvents();
+
+  /// @brief write the trace in the Chrome trace event format
+  /// @details Each call becomes a complete ("X") event with the class name of the stage
+  /// as its category. The counters of all stages and the number of dropped events are
+  /// written into the otherData section.
+  /// @param[in] os stream to write to
+  static void writeTrace(std::ostream &os);
+
+  /// @brief write the trace into a file
+  /// @param[in] fname file name (e.g. trace.json)
+  /// @throw AskapError if the file can't be written
+  static void writeTrace(const std::string &fname);
+
+  /// @brief write the summary into the log
+  /// @details One line per stage is written at the INFO level, nothing is done
+  /// if no stage has been recorded.
+  static void log();
+
+private:
+  /// @brief apply a change to the counters of the given stage
+  /// @param[in] stage name of the stage
+  /// @param[in] calls number of calls to add
+  /// @param[in] time time to add (in seconds)
+  /// @param[in] bytes number of bytes to add
+  /// @param[in] hits number of hits to add
+  /// @param[in] misses number of misses to add
+  static void add(const std::string &stage, size_t calls, double time, size_t bytes,
+                  size_t hits, size_t misses);
+
+  /// @brief add an event which has just finished to the trace
+  /// @param[in] stage name of the stage (string literal)
+  /// @param[in] time duration in seconds
+  /// @param[in] bytes number of bytes delivered
+  static void trace(const char *stage, double time, size_t bytes);
+
+  /// @brief true, if the statistics are collected
+  static std::atomic<bool> theirEnabled;
+
+  /// @brief true, if the calls are traced
+  static std::atomic<bool> theirTracing;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DATA_ACCESS_STATISTICS_H
@@ -254,6 +254,21 @@ const casacore::Vector<casacore::Double>& DataAccessorAdapter::uvwRotationDelay(
   return getROAccessor().uvwRotationDelay(tangentPoint, imageCentre);
 }	
 
+/// @brief bounding box of uvw
+/// @return bounding box of uvw obtained from the wrapped accessor
+UVWBounds DataAccessorAdapter::uvwBounds() const
+{
+  return getROAccessor().uvwBounds();
+}
+
+/// @brief bounding box of uvw after rotation
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return bounding box of rotated uvw obtained from the wrapped accessor
+UVWBounds DataAccessorAdapter::rotatedUVWBounds(const casacore::MDirection &tangentPoint) const
+{
+  return getROAccessor().rotatedUVWBounds(tangentPoint);
+}
+
 /// @brief Noise level required for a proper weighting
 /// @return a reference to nRow x nChannel x nPol cube with
 ///         complex noise estimates. Elements correspond to the
@@ -0,0 +1,186 @@
+/// @file
+///
+/// @brief Fast incremental checksum of the data delivered by iterators
+/// @details DataChecksum is a 64-bit non-cryptographic hash (the mixing steps
+/// follow xxHash64). DataChecksumAggregator collects checksums of all chunks.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/DataChecksum.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <cstring>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief multiplicative constants of xxHash64
+const casacore::uInt64 prime1 = 11400714785074694791ULL;
+const casacore::uInt64 prime2 = 14029467366897019727ULL;
+const casacore::uInt64 prime3 = 1609587929392839161ULL;
+const casacore::uInt64 prime4 = 9650029242287828579ULL;
+const casacore::uInt64 prime5 = 2870177450012600261ULL;
+
+/// @brief rotate bits to the left
+/// @param[in] x value
+/// @param[in] r number of bits
+/// @return rotated value
+inline casacore::uInt64 rotl(casacore::uInt64 x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+/// @brief final mixing of bits
+/// @param[in] h value to mix
+/// @return mixed value
+inline casacore::uInt64 avalanche(casacore::uInt64 h)
+{
+  h ^= h >> 33;
+  h *= prime2;
+  h ^= h >> 29;
+  h *= prime3;
+  h ^= h >> 32;
+  return h;
+}
+
+} // anonymous namespace
+
+/// @brief initialise the checksum
+/// @param[in] seed seed value, checksums of different quantities can use different seeds
+DataChecksum::DataChecksum(casacore::uInt64 seed)
+{
+  reset(seed);
+}
+
+/// @brief reset the checksum to its initial state
+/// @param[in] seed seed value
+void DataChecksum::reset(casacore::uInt64 seed)
+{
+  itsState = seed + prime5;
+  itsNBytes = 0;
+  itsTail = 0;
+  itsTailSize = 0;
+}
+
+/// @brief process one 64-bit word
+/// @param[in] word word to add
+void DataChecksum::addWord(casacore::uInt64 word)
+{
+  itsState ^= rotl(word * prime2, 31) * prime1;
+  itsState = rotl(itsState, 27) * prime1 + prime4;
+}
+
+/// @brief add a block of memory to the checksum
+/// @param[in] data pointer to the data
+/// @param[in] nBytes number of bytes
+void DataChecksum::update(const void *data, size_t nBytes)
+{
+  const unsigned char *ptr = static_cast<const unsigned char*>(data);
+  itsNBytes += nBytes;
+  // complete the word left from the previous call
+  while (itsTailSize > 0 && itsTailSize < 8 && nBytes > 0) {
+         itsTail |= casacore::uInt64(*ptr) << (8 * itsTailSize);
+         ++ptr;
+         --nBytes;
+         ++itsTailSize;
+  }
+  if (itsTailSize == 8) {
+      addWord(itsTail);
+      itsTail = 0;
+      itsTailSize = 0;
+  }
+  for (; nBytes >= 8; nBytes -= 8, ptr += 8) {
+       casacore::uInt64 word;
+       std::memcpy(&word, ptr, 8);
+       addWord(word);
+  }
+  for (; nBytes > 0; --nBytes, ++ptr, ++itsTailSize) {
+       itsTail |= casacore::uInt64(*ptr) << (8 * itsTailSize);
+  }
+}
+
+/// @return the checksum of the data added so far
+/// @note The state is not changed, so more data can be added afterwards
+casacore::uInt64 DataChecksum::value() const
+{
+  casacore::uInt64 h = itsState + itsNBytes;
+  if (itsTailSize > 0) {
+      h ^= itsTail * prime1;
+      h = rotl(h, 23) * prime2 + prime3;
+  }
+  return avalanche(h);
+}
+
+/// @brief construct an empty aggregator
+DataChecksumAggregator::DataChecksumAggregator() : itsSum(0), itsCount(0), itsNBytes(0) {}
+
+/// @brief add the checksum of one chunk
+/// @param[in] checksum checksum of the chunk
+/// @param[in] nBytes number of bytes the checksum covers
+void DataChecksumAggregator::add(casacore::uInt64 checksum, casacore::uInt64 nBytes)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  // sum modulo 2^64 doesn't depend on the order
+  itsSum += checksum;
+  ++itsCount;
+  itsNBytes += nBytes;
+}
+
+/// @brief forget all checksums added so far
+void DataChecksumAggregator::reset()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsSum = 0;
+  itsCount = 0;
+  itsNBytes = 0;
+}
+
+/// @return combined checksum of all chunks added so far
+casacore::uInt64 DataChecksumAggregator::value() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return avalanche(itsSum + itsCount * prime5);
+}
+
+/// @return number of checksums added so far
+casacore::uInt64 DataChecksumAggregator::count() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsCount;
+}
+
+/// @return total number of bytes covered by the checksums
+casacore::uInt64 DataChecksumAggregator::nBytes() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsNBytes;
+}
@@ -0,0 +1,158 @@
+/// @file
+///
+/// @brief Fast incremental checksum of the data delivered by iterators
+/// @details Integrity checks of transferred measurement sets would otherwise need
+/// a separate full read of the data. DataChecksum is a 64-bit non-cryptographic hash
+/// (the mixing steps follow xxHash64) which can be updated as cubes are filled by
+/// the iterator. DataChecksumAggregator collects checksums of all chunks for the
+/// whole data source.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_DATA_CHECKSUM_H
+#define ASKAP_ACCESSORS_DATA_CHECKSUM_H
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/Arrays/Array.h>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <cstddef>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Fast incremental checksum
+/// @details The data are processed as a stream of 64-bit words, so the result
+/// depends on the byte order of the machine. This is fine for comparing the
+/// datasets read on the same type of machine, which is the intended use. The
+/// checksum is not suitable for cryptographic purposes.
+/// @ingroup dataaccess_hlp
+class DataChecksum {
+public:
+  /// @brief initialise the checksum
+  /// @param[in] seed seed value, checksums of different quantities can use different seeds
+  explicit DataChecksum(casacore::uInt64 seed = 0);
+
+  /// @brief reset the checksum to its initial state
+  /// @param[in] seed seed value
+  void reset(casacore::uInt64 seed = 0);
+
+  /// @brief add a block of memory to the checksum
+  /// @param[in] data pointer to the data
+  /// @param[in] nBytes number of bytes
+  void update(const void *data, size_t nBytes);
+
+  /// @brief add an array to the checksum
+  /// @details Elements are processed in the storage order (i.e. the first
+  /// axis varies most rapidly), non-contiguous arrays are copied first.
+  /// @param[in] arr array to add
+  template<typename T>
+  void update(const casacore::Array<T> &arr) {
+     bool deleteIt = false;
+     const T* data = arr.getStorage(deleteIt);
+     update(data, arr.nelements() * sizeof(T));
+     arr.freeStorage(data, deleteIt);
+  }
+
+  /// @return the checksum of the data added so far
+  /// @note The state is not changed, so more data can be added afterwards
+  casacore::uInt64 value() const;
+
+  /// @return number of bytes added so far
+  inline casacore::uInt64 nBytes() const { return itsNBytes; }
+
+private:
+  /// @brief process one 64-bit word
+  /// @param[in] word word to add
+  void addWord(casacore::uInt64 word);
+
+  /// @brief current state
+  casacore::uInt64 itsState;
+
+  /// @brief number of bytes added
+  casacore::uInt64 itsNBytes;
+
+  /// @brief incomplete word (up to 7 bytes) waiting for more data
+  casacore::uInt64 itsTail;
+
+  /// @brief number of bytes in itsTail
+  casacore::uInt itsTailSize;
+};
+
+/// @brief checksums of all chunks of a data source
+/// @details Checksums of individual chunks are combined in the way which doesn't
+/// depend on the order the chunks are processed. Therefore, the same dataset iterated
+/// with the same selection and chunk size gives the same result even if several threads
+/// iterate over different parts of it. Chunks read more than once are counted each time
+/// they are read. This class is thread-safe.
+/// @ingroup dataaccess_hlp
+class DataChecksumAggregator : public boost::noncopyable {
+public:
+  /// @brief construct an empty aggregator
+  DataChecksumAggregator();
+
+  /// @brief add the checksum of one chunk
+  /// @param[in] checksum checksum of the chunk
+  /// @param[in] nBytes number of bytes the checksum covers
+  void add(casacore::uInt64 checksum, casacore::uInt64 nBytes);
+
+  /// @brief forget all checksums added so far
+  void reset();
+
+  /// @return combined checksum of all chunks added so far
+  casacore::uInt64 value() const;
+
+  /// @return number of checksums added so far
+  casacore::uInt64 count() const;
+
+  /// @return total number of bytes covered by the checksums
+  casacore::uInt64 nBytes() const;
+
+private:
+  /// @brief sum of the chunk checksums
+  casacore::uInt64 itsSum;
+
+  /// @brief number of checksums added
+  casacore::uInt64 itsCount;
+
+  /// @brief number of bytes
+  casacore::uInt64 itsNBytes;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DATA_CHECKSUM_H
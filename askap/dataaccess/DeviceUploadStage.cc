@@ -0,0 +1,223 @@
+/// @file
+///
+/// @brief Double-buffered upload of accessor data to an accelerator
+/// @details This class copies the relevant fields of the accessor into one of a small
+/// number of staging slots and runs the transfer in a separate thread.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/DeviceUploadStage.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+ASKAP_LOGGER(logger, ".DeviceUploadStage");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief resize the slot array and copy the data
+/// @param[in] allocator allocation policy, empty for the global heap
+/// @param[in] array slot array to fill
+/// @param[in] data data to copy
+template<typename A>
+void stageArray(const boost::shared_ptr<ArrayAllocator const> &allocator, A &array, const A &data)
+{
+  if (allocator) {
+      allocator->resize(array, data.shape());
+  } else if (!array.shape().isEqual(data.shape())) {
+      array.resize(data.shape());
+  }
+  array = data;
+}
+
+} // anonymous namespace
+
+/// @brief set up the stage and start the upload thread
+/// @param[in] upload function transferring a slot to the device
+/// @param[in] nSlots number of staging slots, 2 for double buffering
+/// @param[in] allocator allocation policy for the slots, empty pointer means the global heap
+DeviceUploadStage::DeviceUploadStage(const UploadFunction &upload, size_t nSlots,
+                      const boost::shared_ptr<ArrayAllocator const> &allocator) :
+      itsUpload(upload), itsAllocator(allocator), itsSlots(nSlots), itsUploading(false),
+      itsStopRequested(false), itsNUploaded(0), itsSubmitWaits(0), itsSubmitWaitTime(0.)
+{
+  ASKAPCHECK(itsUpload, "An attempt to initialise DeviceUploadStage with an empty upload function");
+  ASKAPCHECK(nSlots > 0, "DeviceUploadStage should have at least one staging slot");
+  for (size_t slot = 0; slot < nSlots; ++slot) {
+       itsFreeSlots.push_back(slot);
+  }
+  itsUploadThread.reset(new boost::thread(boost::bind(&DeviceUploadStage::uploadLoop, this)));
+}
+
+/// @brief destructor, waits for the uploads in progress and stops the thread
+DeviceUploadStage::~DeviceUploadStage()
+{
+  {
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    while ((itsUploading || itsPendingSlots.size()) && !itsError) {
+           itsSlotReleased.wait(lock);
+    }
+    itsStopRequested = true;
+  }
+  itsSlotSubmitted.notify_all();
+  if (itsUploadThread) {
+      itsUploadThread->join();
+      itsUploadThread.reset();
+  }
+  if (itsNUploaded > 0) {
+      ASKAPLOG_DEBUG_STR(logger, "Device upload stage: "<<itsNUploaded<<" accessor(s) uploaded via "<<
+                  itsSlots.size()<<" slot(s), submit waited "<<itsSubmitWaits<<" time(s) for "<<
+                  itsSubmitWaitTime<<" s");
+  }
+}
+
+/// @brief copy the accessor into a free slot and schedule its upload
+/// @details The method waits if all slots are busy.
+/// @param[in] acc accessor to upload
+/// @return index of the slot used
+size_t DeviceUploadStage::submit(const IConstDataAccessor &acc)
+{
+  size_t slotIndex = 0;
+  {
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    checkError();
+    if (itsFreeSlots.empty()) {
+        ++itsSubmitWaits;
+        const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+        while (itsFreeSlots.empty() && !itsError) {
+               itsSlotReleased.wait(lock);
+        }
+        itsSubmitWaitTime += boost::chrono::duration<double>(boost::chrono::steady_clock::now() - start).count();
+        checkError();
+    }
+    slotIndex = itsFreeSlots.front();
+    itsFreeSlots.pop_front();
+  }
+  // the slot is owned by this thread until it is scheduled for upload
+  Slot &slot = itsSlots[slotIndex];
+  try {
+     slot.itsTime = acc.time();
+     stageArray(itsAllocator, slot.itsVisibility, acc.visibility());
+     stageArray(itsAllocator, slot.itsFlag, acc.flag());
+     stageArray(itsAllocator, slot.itsUVW, acc.uvw());
+  }
+  catch (...) {
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     itsFreeSlots.push_back(slotIndex);
+     throw;
+  }
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsPendingSlots.push_back(slotIndex);
+  }
+  itsSlotSubmitted.notify_all();
+  return slotIndex;
+}
+
+/// @brief wait until all scheduled uploads are complete
+void DeviceUploadStage::flush()
+{
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  while ((itsUploading || itsPendingSlots.size()) && !itsError) {
+         itsSlotReleased.wait(lock);
+  }
+  checkError();
+}
+
+/// @return number of accessors uploaded so far
+size_t DeviceUploadStage::nUploaded() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsNUploaded;
+}
+
+/// @return number of times submit had to wait for a free slot
+size_t DeviceUploadStage::submitWaits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsSubmitWaits;
+}
+
+/// @return total time in seconds submit spent waiting for a free slot
+double DeviceUploadStage::submitWaitTime() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsSubmitWaitTime;
+}
+
+/// @brief rethrow the error of the upload thread, if any
+/// @note the mutex should be locked by the caller
+void DeviceUploadStage::checkError() const
+{
+  if (itsError) {
+      std::rethrow_exception(itsError);
+  }
+}
+
+/// @brief body of the upload thread
+/// @details Errors are stored in itsError to be rethrown in the submitting thread
+void DeviceUploadStage::uploadLoop()
+{
+  try {
+     for (;;) {
+          size_t slotIndex = 0;
+          {
+            boost::unique_lock<boost::mutex> lock(itsMutex);
+            while (itsPendingSlots.empty() && !itsStopRequested) {
+                   itsSlotSubmitted.wait(lock);
+            }
+            if (itsPendingSlots.empty()) {
+                break;
+            }
+            slotIndex = itsPendingSlots.front();
+            itsPendingSlots.pop_front();
+            itsUploading = true;
+          }
+          itsUpload(itsSlots[slotIndex], slotIndex);
+          {
+            boost::lock_guard<boost::mutex> lock(itsMutex);
+            itsUploading = false;
+            itsFreeSlots.push_back(slotIndex);
+            ++itsNUploaded;
+          }
+          itsSlotReleased.notify_all();
+     }
+  }
+  catch (...) {
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     itsUploading = false;
+     itsError = std::current_exception();
+  }
+  itsSlotReleased.notify_all();
+}
@@ -0,0 +1,188 @@
+/// @file
+///
+/// @brief Double-buffered upload of accessor data to an accelerator
+/// @details Gridding on an accelerator requires the visibilities to be transferred to
+/// the device memory. This class copies the relevant fields of the accessor into one of
+/// a small number of staging slots (page-locked by default) and runs the transfer in a
+/// separate thread, so the next chunk of data can be read while the previous one is uploaded.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_DEVICE_UPLOAD_STAGE_H
+#define ASKAP_ACCESSORS_DEVICE_UPLOAD_STAGE_H
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/ArrayAllocator.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <deque>
+#include <vector>
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Double-buffered upload of accessor data to an accelerator
+/// @details The data are copied into a staging slot by the thread calling submit, then the
+/// upload function is called for this slot in the upload thread. While the upload is in
+/// progress, the caller is free to read the next accessor and submit it into another slot.
+/// The caller waits only if all slots are busy. The upload function is expected to complete
+/// the transfer (or to synchronise with it) before it returns, the slot is reused afterwards.
+/// The device API itself is not used by this class, it is hidden behind the upload function.
+///
+/// The slot storage is allocated with the given policy, page-locked memory (see
+/// PinnedArrayAllocator) is used by default. As the storage is reused for chunks of the
+/// same shape, the cost of locking the memory is paid once per slot.
+///
+/// Errors raised by the upload function stop the upload thread, they are rethrown by the
+/// next call to submit or flush.
+/// @ingroup dataaccess_hlp
+class DeviceUploadStage : public boost::noncopyable {
+public:
+  /// @brief staging slot
+  struct Slot {
+     /// @brief time of the accessor (in the units of the iterator's converter)
+     double itsTime;
+     /// @brief visibility cube
+     casacore::Cube<casacore::Complex> itsVisibility;
+     /// @brief flag cube
+     casacore::Cube<casacore::Bool> itsFlag;
+     /// @brief uvw vectors
+     casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+  };
+
+  /// @brief type of the upload function
+  /// @details The function receives the slot to upload and its index (from 0 to nSlots-1),
+  /// the index can be used to address the matching device buffer.
+  typedef boost::function<void(const Slot&, size_t)> UploadFunction;
+
+  /// @brief set up the stage and start the upload thread
+  /// @param[in] upload function transferring a slot to the device
+  /// @param[in] nSlots number of staging slots, 2 for double buffering
+  /// @param[in] allocator allocation policy for the slots, empty pointer means the global heap
+  explicit DeviceUploadStage(const UploadFunction &upload, size_t nSlots = 2,
+                      const boost::shared_ptr<ArrayAllocator const> &allocator =
+                      ArrayAllocator::create("pinned"));
+
+  /// @brief destructor, waits for the uploads in progress and stops the thread
+  ~DeviceUploadStage();
+
+  /// @brief copy the accessor into a free slot and schedule its upload
+  /// @details The method waits if all slots are busy.
+  /// @param[in] acc accessor to upload
+  /// @return index of the slot used
+  size_t submit(const IConstDataAccessor &acc);
+
+  /// @brief wait until all scheduled uploads are complete
+  void flush();
+
+  /// @return number of staging slots
+  inline size_t nSlots() const { return itsSlots.size(); }
+
+  /// @return number of accessors uploaded so far
+  size_t nUploaded() const;
+
+  /// @return number of times submit had to wait for a free slot
+  size_t submitWaits() const;
+
+  /// @return total time in seconds submit spent waiting for a free slot
+  double submitWaitTime() const;
+
+private:
+  /// @brief body of the upload thread
+  void uploadLoop();
+
+  /// @brief rethrow the error of the upload thread, if any
+  /// @note the mutex should be locked by the caller
+  void checkError() const;
+
+  /// @brief upload function
+  UploadFunction itsUpload;
+
+  /// @brief allocation policy for the slots, empty for the global heap
+  boost::shared_ptr<ArrayAllocator const> itsAllocator;
+
+  /// @brief staging slots
+  std::vector<Slot> itsSlots;
+
+  /// @brief indices of the slots available for filling
+  std::deque<size_t> itsFreeSlots;
+
+  /// @brief indices of the slots waiting for upload, in order of submission
+  std::deque<size_t> itsPendingSlots;
+
+  /// @brief true, if the upload thread is working on a slot
+  bool itsUploading;
+
+  /// @brief true, if the upload thread is asked to stop
+  bool itsStopRequested;
+
+  /// @brief error raised by the upload function, if any
+  std::exception_ptr itsError;
+
+  /// @brief number of accessors uploaded so far
+  size_t itsNUploaded;
+
+  /// @brief number of times submit waited for a free slot
+  size_t itsSubmitWaits;
+
+  /// @brief time spent by submit waiting (in seconds)
+  double itsSubmitWaitTime;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+
+  /// @brief signalled when a slot is submitted or the thread is asked to stop
+  boost::condition_variable itsSlotSubmitted;
+
+  /// @brief signalled when an upload is complete or the thread stops
+  boost::condition_variable itsSlotReleased;
+
+  /// @brief upload thread
+  boost::shared_ptr<boost::thread> itsUploadThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DEVICE_UPLOAD_STAGE_H
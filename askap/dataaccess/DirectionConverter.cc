@@ -60,6 +60,26 @@ casacore::MVDirection
                              itsTargetFrame)(in).getValue();    
 }
 
+/// @brief convert a number of directions in one go
+/// @details All directions are given in the same frame, so a single conversion
+/// engine is set up and reused for all elements.
+/// @param[in] in directions to convert
+/// @param[in] inRef reference frame of the input directions
+/// @param[out] out converted directions (resized as necessary)
+void DirectionConverter::convert(const casacore::Vector<casacore::MVDirection> &in,
+                                 const casacore::MDirection::Ref &inRef,
+                                 casacore::Vector<casacore::MVDirection> &out) const
+{
+  out.resize(in.nelements());
+  if (in.nelements() == 0) {
+      return;
+  }
+  MDirection::Convert converter(inRef, itsTargetFrame);
+  for (casacore::uInt i = 0; i < in.nelements(); ++i) {
+       out[i] = converter(in[i]).getValue();
+  }
+}
+
 /// set a frame (i.e. time and/or position), where the
 /// conversion is performed
 /// @param frame  MeasFrame object (can be constructed from
@@ -62,6 +62,16 @@ struct DirectionConverter : public IDirectionConverter {
     /// @param in an epoch to convert. 
     virtual casacore::MVDirection operator()(const casacore::MDirection &in) const;
 
+    /// @brief convert a number of directions in one go
+    /// @details All directions are given in the same frame, so a single conversion
+    /// engine is set up and reused for all elements.
+    /// @param[in] in directions to convert
+    /// @param[in] inRef reference frame of the input directions
+    /// @param[out] out converted directions (resized as necessary)
+    virtual void convert(const casacore::Vector<casacore::MVDirection> &in,
+                         const casacore::MDirection::Ref &inRef,
+                         casacore::Vector<casacore::MVDirection> &out) const;
+
     /// set a frame (i.e. time and/or position), where the
     /// conversion is performed
     /// @param frame  MeasFrame object (can be constructed from
@@ -0,0 +1,110 @@
+/// @file
+///
+/// @brief Data source delivering a part of the measurement set to each process
+/// @details Parallel jobs used to work with measurement sets split in advance, one
+/// per process. This data source allows all processes to use the same measurement set,
+/// each of them gets its own part (a block of channels, a range of time or a group of
+/// baselines) defined by TablePartitionPlan.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/DistributedTableConstDataSource.h>
+#include <askap/dataaccess/TableDataSelector.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+ASKAP_LOGGER(logger, ".DistributedTableConstDataSource");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct a read-only data source object
+/// @details This is a collective operation, all processes should call it.
+/// @param[in] comms communication object
+/// @param[in] fname file name of the measurement set to use
+/// @param[in] mode way of splitting the data between processes
+/// @param[in] dataColumn a name of the data column used by default
+///                       (default is DATA)
+/// @param[in] includeMaster if false, the master doesn't get any part of the data
+DistributedTableConstDataSource::DistributedTableConstDataSource(askapparallel::AskapParallel &comms,
+               const std::string &fname, TablePartitionPlan::Mode mode, const std::string &dataColumn,
+               bool includeMaster) : TableInfoAccessor(casacore::Table(fname), false, dataColumn), itsPart(0)
+{
+  if (!comms.isParallel()) {
+      itsPlan = TablePartitionPlan(table(), mode, 1);
+      return;
+  }
+  const int firstRank = includeMaster ? 0 : 1;
+  ASKAPCHECK(comms.nProcs() > firstRank, "No process is left to get the data");
+  itsPart = comms.rank() - firstRank;
+  if (comms.rank() == 0) {
+      itsPlan = TablePartitionPlan(table(), mode, static_cast<casacore::uInt>(comms.nProcs() - firstRank));
+      LOFAR::BlobString bs;
+      bs.resize(0);
+      LOFAR::BlobOBufString bob(bs);
+      LOFAR::BlobOStream out(bob);
+      itsPlan.write(out);
+      for (int rank = 1; rank < comms.nProcs(); ++rank) {
+           comms.sendBlob(bs, rank);
+      }
+      for (casacore::uInt part = 0; part < itsPlan.nParts(); ++part) {
+           ASKAPLOG_DEBUG_STR(logger, "Part "<<part<<" of "<<fname<<" (rank "<<part + firstRank<<
+                              ") has weight "<<itsPlan.weight(part));
+      }
+  } else {
+      LOFAR::BlobString bs;
+      bs.resize(0);
+      comms.receiveBlob(bs, 0);
+      LOFAR::BlobIBufString bib(bs);
+      LOFAR::BlobIStream in(bib);
+      itsPlan.read(in);
+  }
+  ASKAPCHECK(itsPart < static_cast<int>(itsPlan.nParts()), "Partition plan has "<<itsPlan.nParts()<<
+             " part(s), rank "<<comms.rank()<<" is not covered");
+}
+
+/// @brief create a selector object restricted to the part of this process
+/// @return a shared pointer to the DataSelector corresponding to this type of DataSource
+IDataSelectorPtr DistributedTableConstDataSource::createSelector() const
+{
+  if (!hasPart()) {
+      ASKAPTHROW(DataAccessLogicError, "This process is not given any part of the data");
+  }
+  const IDataSelectorPtr sel = TableConstDataSource::createSelector();
+  const boost::shared_ptr<TableDataSelector> tabSel = boost::dynamic_pointer_cast<TableDataSelector>(sel);
+  ASKAPDEBUGASSERT(tabSel);
+  itsPlan.apply(static_cast<casacore::uInt>(itsPart), *tabSel);
+  return sel;
+}
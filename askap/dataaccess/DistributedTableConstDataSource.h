@@ -0,0 +1,101 @@
+/// @file
+///
+/// @brief Data source delivering a part of the measurement set to each process
+/// @details Parallel jobs used to work with measurement sets split in advance, one
+/// per process. This data source allows all processes to use the same measurement set,
+/// each of them gets its own part (a block of channels, a range of time or a group of
+/// baselines) defined by TablePartitionPlan.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_DISTRIBUTED_TABLE_CONST_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_DISTRIBUTED_TABLE_CONST_DATA_SOURCE_H
+
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/TablePartitionPlan.h>
+
+// askapparallel includes
+#include <askap/askapparallel/AskapParallel.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Data source delivering a part of the measurement set to each process
+/// @details The partition plan is worked out by the master (rank 0), which is the
+/// only process reading the main table columns required for it, and sent to all other
+/// processes. The constructor is, therefore, a collective operation. Selectors created
+/// by this data source are restricted to the part of the calling process, all further
+/// selection is done within this part (note, that channel selection overrides the
+/// partition in the CHANNEL mode). If the master is not included, it doesn't get any
+/// part and an attempt to create a selector on the master results in an exception.
+/// In the serial case, the whole dataset forms a single part.
+/// @ingroup dataaccess_tab
+class DistributedTableConstDataSource : public TableConstDataSource
+{
+public:
+  /// @brief construct a read-only data source object
+  /// @details This is a collective operation, all processes should call it.
+  /// @param[in] comms communication object
+  /// @param[in] fname file name of the measurement set to use
+  /// @param[in] mode way of splitting the data between processes
+  /// @param[in] dataColumn a name of the data column used by default
+  ///                       (default is DATA)
+  /// @param[in] includeMaster if false, the master doesn't get any part of the data
+  DistributedTableConstDataSource(askapparallel::AskapParallel &comms, const std::string &fname,
+                                  TablePartitionPlan::Mode mode, const std::string &dataColumn = "DATA",
+                                  bool includeMaster = true);
+
+  /// @brief create a selector object restricted to the part of this process
+  /// @return a shared pointer to the DataSelector corresponding to this type of DataSource
+  virtual IDataSelectorPtr createSelector() const;
+
+  /// @return true if this process has been given a part of the data
+  inline bool hasPart() const { return itsPart >= 0; }
+
+  /// @return index of the part given to this process, negative if none
+  inline int part() const { return itsPart; }
+
+  /// @return partition plan (the same for all processes)
+  inline const TablePartitionPlan& plan() const { return itsPlan; }
+
+private:
+  /// @brief partition plan
+  TablePartitionPlan itsPlan;
+
+  /// @brief part of the data given to this process, negative if none
+  int itsPart;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_DISTRIBUTED_TABLE_CONST_DATA_SOURCE_H
@@ -69,6 +69,28 @@ casacore::Double EpochConverter::operator()(const casacore::MEpoch &in) const
   return converted.getTime(itsTargetUnit).getValue();
 }
 
+/// @brief convert a number of epochs in one go
+/// @details All epochs are given in the same frame, so a single conversion
+/// engine is set up and reused for all elements.
+/// @param[in] in epochs to convert
+/// @param[in] inRef reference frame of the input epochs
+/// @param[out] out epochs in the target units/frame (resized as necessary)
+void EpochConverter::convert(const casacore::Vector<casacore::MVEpoch> &in,
+                             const casacore::MEpoch::Ref &inRef,
+                             casacore::Vector<casacore::Double> &out) const
+{
+  out.resize(in.nelements());
+  if (in.nelements() == 0) {
+      return;
+  }
+  MEpoch::Convert converter(inRef, itsTargetRef);
+  for (casacore::uInt i = 0; i < in.nelements(); ++i) {
+       MVEpoch converted = converter(in[i]).getValue();
+       converted -= itsTargetOrigin;
+       out[i] = converted.getTime(itsTargetUnit).getValue();
+  }
+}
+
 /// set a frame (for epochs it is just a position), where the
 /// conversion is performed
 void EpochConverter::setMeasFrame(const casacore::MeasFrame &frame)
@@ -64,6 +64,16 @@ struct EpochConverter : public IEpochConverter {
     /// @param in an epoch to convert. 
     casacore::Double operator()(const casacore::MEpoch &in) const;
 
+    /// @brief convert a number of epochs in one go
+    /// @details All epochs are given in the same frame, so a single conversion
+    /// engine is set up and reused for all elements.
+    /// @param[in] in epochs to convert
+    /// @param[in] inRef reference frame of the input epochs
+    /// @param[out] out epochs in the target units/frame (resized as necessary)
+    virtual void convert(const casacore::Vector<casacore::MVEpoch> &in,
+                         const casacore::MEpoch::Ref &inRef,
+                         casacore::Vector<casacore::Double> &out) const;
+
     /// Reverse conversion (casacore::Double to full measure)
     /// @param in an epoch given as Double in the target units/frame
     /// @return the same epoch as a fully qualified measure
@@ -2,13 +2,10 @@
 /// @brief A class to access FEED subtable
 /// @details This file contains a class implementing IFeedSubtableHandler interface to
 /// the content of the FEED subtable (which provides offsets of each physical
-/// feed from the dish pointing centre and its position anlge). Although this 
-/// implementation caches the values for the last requested time-range and 
-/// the spectral window, it reads the data on-demand. This is the difference
-/// from some other subtables which are implemented by Mem... classes reading
-/// all the required data in the constructor. If the table is trivial 
-/// (no time- and spectral window dependence), it will be fully cached on the
-/// first request.
+/// feed from the dish pointing centre and its position anlge). All rows are
+/// read in the constructor into an interval index keyed on spectral window and
+/// time, so a look up is a binary search and alternating between spectral windows
+/// doesn't cause the table to be re-read.
 /// @note The measurement set format specifies offsets for each receptor,
 /// rather than feed (i.e. for each polarization separately). We handle possible
 /// squints together with other image plane effects and therefore need just
@@ -46,6 +43,7 @@
 
 #include <askap/askap/AskapError.h>
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
 
 // casa includes
 #include <casacore/tables/Tables/TableRecord.h>
@@ -55,6 +53,10 @@
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/BasicSL/String.h>
 
+// std includes
+#include <algorithm>
+#include <set>
+
 // enable logger here, when it is used in the code
 //#include <askap/askap/AskapLogging.h>
 //ASKAP_LOGGER(logger, "");
@@ -72,7 +74,7 @@ FeedSubtableHandler::FeedSubtableHandler(const casacore::Table &ms) :
           TableHolder(ms.keywordSet().asTable("FEED")),
           itsCachedSpWindow(-2),
           itsCachedStartTime(0.), itsCachedStopTime(0.),
-          itsAllCachedOffsetsZero(false), itsIntervalFactor(1.)
+          itsCurrentEpoch(new FeedEpoch), itsIntervalFactor(1.)
 { 
   const casacore::Array<casacore::String> &intervalUnits=table().tableDesc().
           columnDesc("INTERVAL").keywordSet().asArrayString("QuantumUnits");
@@ -86,6 +88,168 @@ FeedSubtableHandler::FeedSubtableHandler(const casacore::Table &ms) :
             getTime(casacore::Unit(intervalUnits(casacore::IPosition(1,0)))).getValue();
   ASKAPDEBUGASSERT(itsIntervalFactor != 0);
   itsIntervalFactor = 1./itsIntervalFactor;
+  buildIndex();
+}
+
+/// @brief read the whole FEED subtable and build the interval index
+/// @details This method is called from the constructor.
+void FeedSubtableHandler::buildIndex()
+{
+  DataAccessStatistics::ScopedTimer timer("FeedSubtableHandler::buildIndex");
+  const casacore::rownr_t nRows = table().nrow();
+  if (nRows == 0u) {
+      return;
+  }
+  casacore::ROScalarColumn<casacore::Int> antCol(table(),"ANTENNA_ID");
+  casacore::ROScalarColumn<casacore::Int> feedCol(table(),"FEED_ID");
+  casacore::ROScalarColumn<casacore::Int> spWinCol(table(),"SPECTRAL_WINDOW_ID");
+  casacore::ROScalarColumn<casacore::Double> timeCol(table(),"TIME");
+  casacore::ROScalarColumn<casacore::Double> intervalCol(table(),"INTERVAL");
+  casacore::ROArrayColumn<casacore::Double>  rcptrOffsets(table(),"BEAM_OFFSET");
+  casacore::ROArrayColumn<casacore::Double>  rcptrPAs(table(),"RECEPTOR_ANGLE");
+  const casacore::Vector<casacore::Int> antIDs = antCol.getColumn();
+  const casacore::Vector<casacore::Int> feedIDs = feedCol.getColumn();
+  const casacore::Vector<casacore::Int> spWinIDs = spWinCol.getColumn();
+  const casacore::Vector<casacore::Double> times = timeCol.getColumn();
+  const casacore::Vector<casacore::Double> intervals = intervalCol.getColumn();
+
+  // per row quantities are computed only once
+  std::vector<casacore::RigidVector<casacore::Double, 2> > rowOffsets(nRows);
+  std::vector<casacore::Double> rowPAs(nRows);
+  std::vector<casacore::Double> rowStarts(nRows), rowStops(nRows);
+  std::set<casacore::Int> spWindows;
+  for (casacore::rownr_t row=0; row<nRows; ++row) {
+       if (antIDs[row] < 0 || feedIDs[row] < 0) {
+           ASKAPTHROW(DataAccessError,"Negative indices in FEED_ID and ANTENNA_ID "
+              "columns of the FEED subtable are not allowed");
+       }
+       computeBeamOffset(rcptrOffsets(row),rowOffsets[row]);
+       rowPAs[row] = computePositionAngle(rcptrPAs(row));
+       // (temporary) work around for zero interval (happens for ATCA data)
+       // probably an appropriate filler has to be fixed as it doesn't
+       // seem to conform with the measurement set standard
+       if (intervals[row] == 0.) {
+           // not a very clean way, but
+           // we need large offsets here
+           rowStarts[row] = times[row] - 1e30;
+           rowStops[row] = times[row] + 1e30;
+       } else {
+           rowStarts[row] = times[row] - intervals[row] * itsIntervalFactor/2.;
+           rowStops[row] = times[row] + intervals[row] * itsIntervalFactor/2.;
+       }
+       spWindows.insert(spWinIDs[row]);
+  }
+
+  // intervals with the same set of rows share the data
+  std::map<std::vector<casacore::rownr_t>, boost::shared_ptr<FeedEpoch const> > epochs;
+  for (std::set<casacore::Int>::const_iterator ci = spWindows.begin(); ci != spWindows.end(); ++ci) {
+       std::vector<casacore::rownr_t> candidates;
+       for (casacore::rownr_t row=0; row<nRows; ++row) {
+            if (spWinIDs[row] == *ci || spWinIDs[row] == -1) {
+                candidates.push_back(row);
+            }
+       }
+       SpWindowIndex &index = itsIndex[*ci];
+       for (std::vector<casacore::rownr_t>::const_iterator rowIt = candidates.begin(); 
+            rowIt != candidates.end(); ++rowIt) {
+            index.itsBoundaries.push_back(rowStarts[*rowIt]);
+            index.itsBoundaries.push_back(rowStops[*rowIt]);
+       }
+       std::sort(index.itsBoundaries.begin(), index.itsBoundaries.end());
+       index.itsBoundaries.erase(std::unique(index.itsBoundaries.begin(), 
+                 index.itsBoundaries.end()), index.itsBoundaries.end());
+       ASKAPDEBUGASSERT(index.itsBoundaries.size() > 1);
+       index.itsEpochs.resize(index.itsBoundaries.size() - 1);
+       for (size_t interval = 0; interval < index.itsEpochs.size(); ++interval) {
+            std::vector<casacore::rownr_t> rows;
+            for (std::vector<casacore::rownr_t>::const_iterator rowIt = candidates.begin(); 
+                 rowIt != candidates.end(); ++rowIt) {
+                 if (rowStarts[*rowIt] <= index.itsBoundaries[interval] &&
+                     rowStops[*rowIt] >= index.itsBoundaries[interval + 1]) {
+                     rows.push_back(*rowIt);
+                 }
+            }
+            if (rows.size() == 0) {
+                // gap in the table
+                continue;
+            }
+            boost::shared_ptr<FeedEpoch const> &cachedEpoch = epochs[rows];
+            if (!cachedEpoch) {
+                boost::shared_ptr<FeedEpoch> epoch(new FeedEpoch);
+                const casacore::uInt nEpochRows = rows.size();
+                epoch->itsBeamOffsets.resize(nEpochRows);
+                epoch->itsPositionAngles.resize(nEpochRows);
+                epoch->itsAntennaIDs.resize(nEpochRows);
+                epoch->itsFeedIDs.resize(nEpochRows);
+                for (casacore::uInt i = 0; i < nEpochRows; ++i) {
+                     epoch->itsAntennaIDs[i] = antIDs[rows[i]];
+                     epoch->itsFeedIDs[i] = feedIDs[rows[i]];
+                }
+                casacore::Int minAntID=-1,maxAntID=-1;
+                casacore::minMax(minAntID,maxAntID,epoch->itsAntennaIDs);
+                casacore::Int minFeedID=-1,maxFeedID=-1;
+                casacore::minMax(minFeedID,maxFeedID,epoch->itsFeedIDs);
+                ++maxAntID; ++maxFeedID; // now we have numbers of feeds and antennae
+                ASKAPDEBUGASSERT(maxAntID*maxFeedID == casacore::Int(nEpochRows));
+                epoch->itsIndices.resize(maxAntID,maxFeedID);
+                epoch->itsIndices.set(-2); // negative value is a flag, which means an 
+                                           // uninitialized index
+                // we will set this flag to false later, if a non-zero offset is found
+                epoch->itsAllOffsetsZero = true;
+                epoch->itsSpWindowIndependent = true;
+                for (casacore::uInt i = 0; i < nEpochRows; ++i) {
+                     const casacore::RigidVector<casacore::Double, 2> &cOffset = rowOffsets[rows[i]];
+                     epoch->itsBeamOffsets[i] = cOffset;
+                     if ((std::abs(cOffset(0)) > 1e-15) || (std::abs(cOffset(1)) > 1e-15)) {
+                         epoch->itsAllOffsetsZero = false;
+                     }
+                     epoch->itsPositionAngles[i] = rowPAs[rows[i]];
+                     epoch->itsIndices(epoch->itsAntennaIDs[i],epoch->itsFeedIDs[i]) = i;
+                     if (spWinIDs[rows[i]] != -1) {
+                         epoch->itsSpWindowIndependent = false;
+                     }
+                }
+                cachedEpoch = epoch;
+            }
+            index.itsEpochs[interval] = cachedEpoch;
+       }
+  }
+}
+
+/// @brief find data for the given time and spectral window
+/// @details This is a binary search through the interval index.
+/// @param[in] dTime time in the native frame/units of the FEED table
+/// @param[in] spWinID spectral window ID of interest
+/// @param[out] startTime start of the interval found
+/// @param[out] stopTime stop of the interval found
+/// @return shared pointer to the data, empty if no data are defined
+boost::shared_ptr<FeedSubtableHandler::FeedEpoch const> FeedSubtableHandler::findEpoch(casacore::Double dTime, 
+                 casacore::uInt spWinID, casacore::Double &startTime, casacore::Double &stopTime) const
+{
+  std::map<casacore::Int, SpWindowIndex>::const_iterator ci = itsIndex.find(casacore::Int(spWinID));
+  if (ci == itsIndex.end()) {
+      // spectral window is not present explicitly, only rows valid for any 
+      // spectral window can be used
+      ci = itsIndex.find(-1);
+      if (ci == itsIndex.end()) {
+          return boost::shared_ptr<FeedEpoch const>();
+      }
+  }
+  const std::vector<casacore::Double> &boundaries = ci->second.itsBoundaries;
+  ASKAPDEBUGASSERT(boundaries.size() > 1);
+  if (dTime < boundaries.front() || dTime > boundaries.back()) {
+      return boost::shared_ptr<FeedEpoch const>();
+  }
+  size_t interval = std::upper_bound(boundaries.begin(), boundaries.end(), dTime) - 
+                    boundaries.begin();
+  ASKAPDEBUGASSERT(interval > 0);
+  // the stop time of the last row is still within the validity range
+  if (interval == boundaries.size()) {
+      --interval;
+  }
+  startTime = boundaries[interval - 1];
+  stopTime = boundaries[interval];
+  return ci->second.itsEpochs[interval - 1];
 }
  
 /// obtain the offsets of each beam with respect to dish pointing
@@ -105,8 +269,8 @@ const casacore::RigidVector<casacore::Double, 2>&
 {
   fillCacheOnDemand(time,spWinID);
   const casacore::uInt index=getIndex(antID,feedID);
-  ASKAPDEBUGASSERT(index<=itsBeamOffsets.nelements());
-  return itsBeamOffsets[index];
+  ASKAPDEBUGASSERT(index<=itsCurrentEpoch->itsBeamOffsets.nelements());
+  return itsCurrentEpoch->itsBeamOffsets[index];
 }    
 
 /// obtain the offsets for all beams with respect to dish pointing
@@ -121,7 +285,7 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 2> > &
                                   casacore::uInt spWinID) const
 {
  fillCacheOnDemand(time,spWinID);
- return itsBeamOffsets;
+ return itsCurrentEpoch->itsBeamOffsets;
 }
 
 /// obtain position angles for all beams in the current cache (w.r.t. some
@@ -137,7 +301,7 @@ const casacore::Vector<casacore::Double>& FeedSubtableHandler::getAllBeamPAs(
                                  casacore::uInt spWinID) const
 {
   fillCacheOnDemand(time,spWinID);
-  return itsPositionAngles;
+  return itsCurrentEpoch->itsPositionAngles;
 }
 
 /// obtain an index of the given feed/antenna pair via the look-up table
@@ -148,17 +312,18 @@ const casacore::Vector<casacore::Double>& FeedSubtableHandler::getAllBeamPAs(
 /// @param[in] feedID feed of interest 
 casacore::uInt FeedSubtableHandler::getIndex(casacore::uInt antID, casacore::uInt feedID) const
 {
- if (antID>=itsIndices.nrow()) {
+ const casacore::Matrix<casacore::Int> &indices = itsCurrentEpoch->itsIndices;
+ if (antID>=indices.nrow()) {
       ASKAPTHROW(DataAccessError, "Antenna ID requested ("<<antID<<
           ") is outside the range of the FEED table (max. antenna number is "<<
-          itsIndices.nrow());
+          indices.nrow());
   }
-  if (feedID>=itsIndices.ncolumn()) {
+  if (feedID>=indices.ncolumn()) {
       ASKAPTHROW(DataAccessError, "Feed ID requested ("<<feedID<<
           ") is outside the range of the FEED table (max. antenna number is "<<
-          itsIndices.ncolumn());
+          indices.ncolumn());
   }
-  const casacore::Int index=itsIndices(antID,feedID);
+  const casacore::Int index=indices(antID,feedID);
   if (index<0) {
       ASKAPTHROW(DataAccessError, "Requested Antenna ID="<<antID<<
            " and Feed ID="<<feedID<<" are not found in the FEED subtable for "
@@ -168,6 +333,17 @@ casacore::uInt FeedSubtableHandler::getIndex(casacore::uInt antID, casacore::uIn
   return static_cast<casacore::uInt>(index);
 } 
 
+/// @brief check whether the given time and spectral window are within the cached range
+/// @details This is a quick check which doesn't search the index.
+/// @param[in] dTime time in the native frame/units of the FEED table
+/// @param[in] spWinID spectral window ID of interest
+/// @return true if the current cache is valid for the given time and spectral window
+bool FeedSubtableHandler::isInCache(casacore::Double dTime, casacore::uInt spWinID) const
+{
+  return dTime>=itsCachedStartTime && dTime<itsCachedStopTime &&
+         (casacore::Int(spWinID)==itsCachedSpWindow || itsCachedSpWindow==-1);
+}
+
 /// @brief check whether the given time and spectral window ID is  in cache.
 /// @details The users of this class are expected to do some heavy postprocessing
 /// based on the position angle and beam offsets returned. It is, therefore,
@@ -183,17 +359,19 @@ bool FeedSubtableHandler::newBeamDetails(const casacore::MEpoch &time,
                                     casacore::uInt spWinID) const
 {
   const casacore::Double dTime=tableTime(time);
-  if (dTime>=itsCachedStartTime && dTime<=itsCachedStopTime &&
-      (casacore::Int(spWinID)==itsCachedSpWindow || itsCachedSpWindow==-1)) {
+  if (isInCache(dTime, spWinID)) {
       // cache is valid
       return false;
   } 
-  return true;
+  // adjacent intervals or spectral windows may still share the same data
+  casacore::Double startTime = 0., stopTime = 0.;
+  const boost::shared_ptr<FeedEpoch const> epoch = findEpoch(dTime, spWinID, startTime, stopTime);
+  return !epoch || epoch != itsCurrentEpoch;
 }                                    
 
 
-/// read the data to fill the cache, a call to isCacheValid allows to check
-/// whether reading is necessary
+/// @brief select the data for the given time and spectral window
+/// @details Nothing is read from the table, the interval index is searched
 /// @param[in] time a full epoch of interest (feed table can be time-
 /// dependent
 /// @param[in] spWinID spectral window ID of interest (feed table can be
@@ -201,91 +379,20 @@ bool FeedSubtableHandler::newBeamDetails(const casacore::MEpoch &time,
 void FeedSubtableHandler::fillCache(const casacore::MEpoch &time, 
                        casacore::uInt spWinID) const
 {
-  // if we really need to optimize the performance, we can cache dTime
+  DataAccessStatistics::ScopedTimer timer("FeedSubtableHandler::fillCache");
+  timer.miss();
   const casacore::Double dTime=tableTime(time);
-  const casacore::TableExprNode halfInterval = table().col("INTERVAL")*itsIntervalFactor/2.;
-
-  // (temporary) work around for zero interval (happens for ATCA data)
-  // probably an appropriate filler has to be fixed as it doesn't
-  // seem to conform with the measurement set standard
-
-  const casacore::TableExprNode expression = ((table().col("SPECTRAL_WINDOW_ID") ==
-                static_cast<casacore::Int>(spWinID)) || 
-                    (table().col("SPECTRAL_WINDOW_ID") == -1)) &&
-               (((table().col("TIME") - halfInterval <= dTime) &&
-                (table().col("TIME") + halfInterval >= dTime)) ||
-                (halfInterval == 0.));
-  casacore::Table selection=table()(expression);
-  if (selection.nrow()==0u) {
+  casacore::Double startTime = 0., stopTime = 0.;
+  const boost::shared_ptr<FeedEpoch const> epoch = findEpoch(dTime, spWinID, startTime, stopTime);
+  if (!epoch) {
       ASKAPTHROW(DataAccessError,
                  "FEED subtable is empty or feed data missing for "
                   <<time<<" and spectral window: "<<spWinID);
   }
-  itsBeamOffsets.resize(selection.nrow());
-  itsPositionAngles.resize(selection.nrow());
-  casacore::ROScalarColumn<casacore::Int> antIDs(selection,"ANTENNA_ID");
-  antIDs.getColumn(itsAntennaIDs,casacore::True);
-  casacore::Int minAntID=-1,maxAntID=-1;
-  casacore::minMax(minAntID,maxAntID,itsAntennaIDs);
-  casacore::ROScalarColumn<casacore::Int> feedIDs(selection,"FEED_ID");
-  feedIDs.getColumn(itsFeedIDs,casacore::True);
-  casacore::Int minFeedID=-1,maxFeedID=-1;
-  casacore::minMax(minFeedID,maxFeedID,itsFeedIDs);
-  if (minAntID<0 || maxAntID<0 || minFeedID<0 || maxFeedID<0) {
-      ASKAPTHROW(DataAccessError,"Negative indices in FEED_ID and ANTENNA_ID "
-         "columns of the FEED subtable are not allowed");
-  }
-  ++maxAntID; ++maxFeedID; // now we have numbers of feeds and antennae
-  ASKAPDEBUGASSERT(maxAntID*maxFeedID == casacore::Int(selection.nrow()));
-  itsIndices.resize(maxAntID,maxFeedID);
-  itsIndices.set(-2); // negative value is a flag, which means an 
-                      // uninitialized index
-  casacore::ROArrayColumn<casacore::Double>  rcptrOffsets(selection,"BEAM_OFFSET");
-  casacore::ROArrayColumn<casacore::Double>  rcptrPAs(selection,"RECEPTOR_ANGLE");
-  // update start and stop times as well as the spectral window ID 
-  // used in the cache management within the same loop
-  casacore::ROScalarColumn<casacore::Double> timeCol(selection,"TIME");
-  casacore::ROScalarColumn<casacore::Double> intervalCol(selection,"INTERVAL");
-  casacore::ROScalarColumn<casacore::Int> spWinCol(selection,"SPECTRAL_WINDOW_ID");
-  itsCachedSpWindow = spWinCol(0);
-  // we will set this flag to false later, if a non-zero offset is found
-  itsAllCachedOffsetsZero = true; 
-  for (casacore::rownr_t row=0; row<selection.nrow(); ++row) {
-       casacore::RigidVector<casacore::Double, 2> &cOffset = itsBeamOffsets[row];
-       computeBeamOffset(rcptrOffsets(row),cOffset);
-       if ((std::abs(cOffset(0)) > 1e-15) || (std::abs(cOffset(1)) > 1e-15)) {
-           itsAllCachedOffsetsZero = false;
-           //std::cerr<<"non zero offset "<<cOffset(0)<<" "<<cOffset(1)<<std::endl; 
-       }
-       itsPositionAngles[row]=computePositionAngle(rcptrPAs(row));
-       itsIndices(antIDs(row),feedIDs(row))=row;
-       
-       casacore::Double cStartTime = timeCol(row) -
-                          intervalCol(row) * itsIntervalFactor/2.;
-       casacore::Double cStopTime = timeCol(row) +
-                          intervalCol(row) * itsIntervalFactor/2.;
-       // (temporary) work around for zero interval (happens for ATCA data)
-       // probably an appropriate filler has to be fixed as it doesn't
-       // seem to conform with the measurement set standard
-       if (intervalCol(row) == 0.) {
-           // not a very clean way, but
-	       // we need large offsets here
-           cStartTime = timeCol(row) - 1e30;
-	       cStopTime = timeCol(row) + 1e30; 
-       }
-       if (!row || itsCachedStartTime<cStartTime) {
-           itsCachedStartTime=cStartTime;	   
-       }
-       if (!row || itsCachedStopTime>cStopTime) {
-           itsCachedStopTime=cStopTime;
-       }
-       if (spWinCol(row) != -1) {
-           ASKAPDEBUGASSERT((itsCachedSpWindow == -1) || 
-                             (spWinCol(row) == itsCachedSpWindow));
-           itsCachedSpWindow = spWinCol(row);
-       }
-  }
-            
+  itsCurrentEpoch = epoch;
+  itsCachedStartTime = startTime;
+  itsCachedStopTime = stopTime;
+  itsCachedSpWindow = epoch->itsSpWindowIndependent ? -1 : casacore::Int(spWinID);
 }
                        
 
@@ -350,11 +457,12 @@ casacore::Double FeedSubtableHandler::getBeamPA(const casacore::MEpoch &time,
 {
   fillCacheOnDemand(time,spWinID);
   const casacore::uInt index=getIndex(antID,feedID);
-  ASKAPDEBUGASSERT(index<=itsPositionAngles.nelements());
-  return itsPositionAngles[index];
+  ASKAPDEBUGASSERT(index<=itsCurrentEpoch->itsPositionAngles.nelements());
+  return itsCurrentEpoch->itsPositionAngles[index];
 }                                 
   
-/// the same as fillCache, but perform it if newBeamDetails returns true
+/// the same as fillCache, but perform it if the cached time range and spectral
+/// window don't match
 /// @param[in] time a full epoch of interest (feed table can be time-
 /// dependent
 /// @param[in] spWinID spectral window ID of interest (feed table can be
@@ -363,8 +471,10 @@ void FeedSubtableHandler::fillCacheOnDemand(const casacore::MEpoch &time,
                                             casacore::uInt spWinID) const
 {
   ASKAPDEBUGASSERT(spWinID>=0);
-  if (newBeamDetails(time,spWinID)) {
+  if (!isInCache(tableTime(time),spWinID)) {
       fillCache(time,spWinID);
+  } else {
+      DataAccessStatistics::countHit("FeedSubtableHandler::fillCache");
   }
 }                                            
 
@@ -383,7 +493,7 @@ void FeedSubtableHandler::fillCacheOnDemand(const casacore::MEpoch &time,
 bool FeedSubtableHandler::allBeamOffsetsZero(const casacore::MEpoch &time, casacore::uInt spWinID) const
 {
   fillCacheOnDemand(time,spWinID);
-  return itsAllCachedOffsetsZero;
+  return itsCurrentEpoch->itsAllOffsetsZero;
 }
 
 /// obtain feed IDs for the given time and spectral window
@@ -397,7 +507,7 @@ const casacore::Vector<casacore::Int>& FeedSubtableHandler::getFeedIDs(const cas
                       casacore::uInt spWinID) const
 {
   fillCacheOnDemand(time,spWinID);
-  return itsFeedIDs;
+  return itsCurrentEpoch->itsFeedIDs;
 }                      
   
 /// obtain antenna IDs for the given time and spectral window
@@ -411,7 +521,7 @@ const casacore::Vector<casacore::Int>& FeedSubtableHandler::getAntennaIDs(const
                       casacore::uInt spWinID) const
 {
   fillCacheOnDemand(time,spWinID);
-  return itsAntennaIDs;  
+  return itsCurrentEpoch->itsAntennaIDs;
 }  
 
 /// @brief obtain a matrix of indices into beam offset and beam PA arrays
@@ -430,5 +540,5 @@ const casacore::Vector<casacore::Int>& FeedSubtableHandler::getAntennaIDs(const
 /// @return a reference to matrix with indicies
 const casacore::Matrix<casacore::Int>& FeedSubtableHandler::getIndices() const throw()
 {
-  return itsIndices;
+  return itsCurrentEpoch->itsIndices;
 }
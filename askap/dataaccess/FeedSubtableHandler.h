@@ -2,13 +2,10 @@
 /// @brief A class to access FEED subtable
 /// @details This file contains a class implementing IFeedSubtableHandler interface to
 /// the content of the FEED subtable (which provides offsets of each physical
-/// feed from the dish pointing centre and its position anlge). Although this 
-/// implementation caches the values for the last requested time-range and 
-/// the spectral window, it reads the data on-demand. This is the difference
-/// from some other subtables which are implemented by Mem... classes reading
-/// all the required data in the constructor. If the table is trivial 
-/// (no time- and spectral window dependence), it will be fully cached on the
-/// first request.
+/// feed from the dish pointing centre and its position anlge). All rows are
+/// read in the constructor into an interval index keyed on spectral window and
+/// time, so a look up is a binary search and alternating between spectral windows
+/// doesn't cause the table to be re-read.
 /// @note The measurement set format specifies offsets for each receptor,
 /// rather than feed (i.e. for each polarization separately). We handle possible
 /// squints together with other image plane effects and therefore need just
@@ -48,7 +45,12 @@
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Quanta/Quantum.h>
 
+// boost includes
+#include <boost/shared_ptr.hpp>
 
+// std includes
+#include <map>
+#include <vector>
 
 // own includes
 #include <askap/dataaccess/IFeedSubtableHandler.h>
@@ -62,13 +64,10 @@ namespace accessors {
 /// @brief A class to access FEED subtable
 /// @details This file contains a class implementing IFeedSubtableHandler interface to
 /// the content of the FEED subtable (which provides offsets of each physical
-/// feed from the dish pointing centre and its position anlge). Although this 
-/// implementation caches the values for the last requested time-range and 
-/// the spectral window, it reads the data on-demand. This is the difference
-/// from some other subtables which are implemented by Mem... classes reading
-/// all the required data in the constructor. If the table is trivial 
-/// (no time- and spectral window dependence), it will be fully cached on the
-/// first request.
+/// feed from the dish pointing centre and its position anlge). All rows are
+/// read in the constructor into an interval index keyed on spectral window and
+/// time, so a look up is a binary search and alternating between spectral windows
+/// doesn't cause the table to be re-read.
 /// @note The measurement set format specifies offsets for each receptor,
 /// rather than feed (i.e. for each polarization separately). We handle possible
 /// squints together with other image plane effects and therefore need just
@@ -199,15 +198,81 @@ struct FeedSubtableHandler : virtual public IFeedSubtableHandler,
   virtual bool allBeamOffsetsZero(const casacore::MEpoch &time, casacore::uInt spWinID) const;
   
 protected:
-  /// read the data to fill the cache, a call to isCacheValid allows to check
-  /// whether reading is necessary
+  /// @brief all data relevant to a particular time range and spectral window
+  /// @details Each FEED row is valid for the time range defined by its TIME and
+  /// INTERVAL columns and for either one or all spectral windows. The time axis of
+  /// each spectral window is split at the boundaries of these ranges, so a unique
+  /// set of rows applies to each elementary interval. Beam offsets and position angles
+  /// for this set are precomputed into contiguous arrays. Intervals which share the
+  /// same set of rows share the same object.
+  struct FeedEpoch {
+     /// @brief construct an empty object
+     FeedEpoch() : itsAllOffsetsZero(false), itsSpWindowIndependent(false) {}
+
+     /// beam offsets
+     casacore::Vector<casacore::RigidVector<casacore::Double, 2> > itsBeamOffsets;
+
+     /// position angles
+     casacore::Vector<casacore::Double> itsPositionAngles;
+
+     /// antenna IDs
+     casacore::Vector<casacore::Int> itsAntennaIDs;
+
+     /// feed IDs
+     casacore::Vector<casacore::Int> itsFeedIDs;
+
+     /// look-up table to convert (ant,feed) into an index for the vectors above
+     casacore::Matrix<casacore::Int> itsIndices;
+
+     /// true if all beam offsets are zero
+     bool itsAllOffsetsZero;
+
+     /// true if all rows are valid for any spectral window
+     bool itsSpWindowIndependent;
+  };
+
+  /// @brief interval index for one spectral window
+  /// @details Element i of itsEpochs applies to the time range from itsBoundaries[i]
+  /// till itsBoundaries[i+1]. Null pointer means a gap in the FEED table.
+  struct SpWindowIndex {
+     /// sorted boundaries of elementary intervals
+     std::vector<casacore::Double> itsBoundaries;
+
+     /// data for each interval
+     std::vector<boost::shared_ptr<FeedEpoch const> > itsEpochs;
+  };
+
+  /// @brief find data for the given time and spectral window
+  /// @details This is a binary search through the interval index.
+  /// @param[in] dTime time in the native frame/units of the FEED table
+  /// @param[in] spWinID spectral window ID of interest
+  /// @param[out] startTime start of the interval found
+  /// @param[out] stopTime stop of the interval found
+  /// @return shared pointer to the data, empty if no data are defined
+  boost::shared_ptr<FeedEpoch const> findEpoch(casacore::Double dTime, casacore::uInt spWinID,
+                      casacore::Double &startTime, casacore::Double &stopTime) const;
+
+  /// @brief read the whole FEED subtable and build the interval index
+  /// @details This method is called from the constructor.
+  void buildIndex();
+
+  /// @brief select the data for the given time and spectral window
+  /// @details Nothing is read from the table, the interval index is searched
   /// @param[in] time a full epoch of interest (feed table can be time-
   /// dependent
   /// @param[in] spWinID spectral window ID of interest (feed table can be
   /// spectral window-dependent  
   void fillCache(const casacore::MEpoch &time, casacore::uInt spWinID) const;
   
-  /// the same as fillCache, but perform it if newBeamDetails returns true
+  /// @brief check whether the given time and spectral window are within the cached range
+  /// @details This is a quick check which doesn't search the index.
+  /// @param[in] dTime time in the native frame/units of the FEED table
+  /// @param[in] spWinID spectral window ID of interest
+  /// @return true if the current cache is valid for the given time and spectral window
+  bool isInCache(casacore::Double dTime, casacore::uInt spWinID) const;
+
+  /// the same as fillCache, but perform it if the cached time range and spectral
+  /// window don't match
   /// @param[in] time a full epoch of interest (feed table can be time-
   /// dependent
   /// @param[in] spWinID spectral window ID of interest (feed table can be
@@ -255,33 +320,17 @@ private:
   /// See itsCachedStartTimes for more details.
   mutable casacore::Double itsCachedStopTime;
   
-  /// a cache of beam offsets
-  mutable casacore::Vector<casacore::RigidVector<casacore::Double, 2> > itsBeamOffsets;
+  /// data for the current time range and spectral window
+  mutable boost::shared_ptr<FeedEpoch const> itsCurrentEpoch;
   
-  /// a cache of position angles
-  mutable casacore::Vector<casacore::Double> itsPositionAngles;
-  
-  /// @brief true if all beam offsets in the cache are zero
-  /// @details This flag is used to speed-up data reduction in the case of
-  /// single-feed interferometers, which are usually on-axis.
-  mutable bool itsAllCachedOffsetsZero;
-  
-  /// a look-up table to convert (ant,feed) into an index for all caches
-  /// (1D-vectors). We need this look-up table as, in principle, the fields
-  /// can be out of order in the FEED subtable, missing or repeated. A simple
-  /// sort, as it was done for the VisBuffer in AIPS++ is not sufficient
-  /// in the general case.
-  mutable casacore::Matrix<casacore::Int> itsIndices;
+  /// interval index for each spectral window present in the table. The element
+  /// with the key of -1 collects rows valid for any spectral window and is used 
+  /// for spectral windows not present in the table explicitly.
+  std::map<casacore::Int, SpWindowIndex> itsIndex;
   
   /// a factor to multiply the INTERVAL to get the same units as
   /// TIME column
   casacore::Double itsIntervalFactor;
-  
-  /// a cache of antenna IDs
-  mutable casacore::Vector<casacore::Int> itsAntennaIDs;
-  
-  /// a cache of feed IDs
-  mutable casacore::Vector<casacore::Int> itsFeedIDs;
 };
 
 
@@ -40,6 +40,7 @@
 
 #include <askap/askap/AskapError.h>
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
 
 // casa includes
 #include <casacore/tables/Tables/TableRecord.h>
@@ -48,6 +49,11 @@
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/casa/BasicSL/String.h>
 
+// std includes
+#include <algorithm>
+#include <limits>
+#include <utility>
+
 // uncomment logger when it is actually used
 //#include <askap/askap/AskapLogging.h>
 //ASKAP_LOGGER(logger, "");
@@ -57,17 +63,39 @@ using namespace askap;
 using namespace askap::accessors;
 
 /// @brief construct the object
-/// @details 
+/// @details The whole subtable is read into memory and sorted by time
 /// @param[in] ms a table object, which has a field subtable defined
 /// (i.e. this method accepts a main ms table).
 FieldSubtableHandler::FieldSubtableHandler(const casacore::Table &ms) :
-       TableHolder(ms.keywordSet().asTable("FIELD")),
-       itsIterator(table(),"TIME",casacore::TableIterator::Ascending,
-                   casacore::TableIterator::NoSort), itsNeverAccessedFlag(true)
+       TableHolder(ms.keywordSet().asTable("FIELD")), itsMultipleRowsPerTime(false),
+       itsCachedStartTime(0.), itsCachedStopTime(0.), itsCurrentIndex(0),
+       itsNeverAccessedFlag(true)
 {
-  if (!table().nrow()) {
+  DataAccessStatistics::ScopedTimer timer("FieldSubtableHandler::buildIndex");
+  const casacore::uInt nRows = table().nrow();
+  if (!nRows) {
       ASKAPTHROW(DataAccessError, "The FIELD subtable is empty");
   }  
+  casacore::ROScalarColumn<casacore::Double> timeCol(table(),"TIME");
+  casacore::ROScalarMeasColumn<casacore::MDirection> refDirCol(table(),"REFERENCE_DIR");
+  std::vector<std::pair<casacore::Double, casacore::uInt> > timeAndRow;
+  timeAndRow.reserve(nRows);
+  itsReferenceDirs.reserve(nRows);
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       timeAndRow.push_back(std::pair<casacore::Double, casacore::uInt>(timeCol(row), row));
+       itsReferenceDirs.push_back(refDirCol(row));
+  }
+  std::stable_sort(timeAndRow.begin(), timeAndRow.end());
+  itsTimes.reserve(nRows);
+  itsTimeOrderedDirs.reserve(nRows);
+  for (size_t i = 0; i < timeAndRow.size(); ++i) {
+       if (i && (timeAndRow[i].first == itsTimes.back())) {
+           // such a table can still be used via FIELD_ID
+           itsMultipleRowsPerTime = true;
+       }
+       itsTimes.push_back(timeAndRow[i].first);
+       itsTimeOrderedDirs.push_back(itsReferenceDirs[timeAndRow[i].second]);
+  }
 }         
   
 /// @brief obtain the reference direction for a given time.
@@ -83,12 +111,10 @@ FieldSubtableHandler::FieldSubtableHandler(const casacore::Table &ms) :
 const casacore::MDirection& FieldSubtableHandler::getReferenceDir(const 
                  casacore::MEpoch &time) const
 {
-  if (itsNeverAccessedFlag) {
-      fillCacheWithCurrentIteration();
-  }
   fillCacheOnDemand(time);
   itsNeverAccessedFlag=false;
-  return itsReferenceDir;
+  ASKAPDEBUGASSERT(itsCurrentIndex < itsTimeOrderedDirs.size());
+  return itsTimeOrderedDirs[itsCurrentIndex];
 }
 
 /// @brief obtain the reference direction stored in a given row
@@ -107,32 +133,10 @@ const casacore::MDirection& FieldSubtableHandler::getReferenceDir(const
 const casacore::MDirection&
 FieldSubtableHandler::getReferenceDir(casacore::uInt fieldID) const
 {
-  if (fieldID >= table().nrow()) {
+  if (fieldID >= itsReferenceDirs.size()) {
       ASKAPTHROW(DataAccessError, "The FIELD subtable does not have row="<<fieldID);
   }
-  casacore::ROScalarMeasColumn<casacore::MDirection> refDirCol(table(),"REFERENCE_DIR");
-  itsRandomlyAccessedReferenceDir = refDirCol(fieldID);
-  return itsRandomlyAccessedReferenceDir;
-}
-
-/// read the current iteration and populate cache. It also advances the
-/// iterator
-void FieldSubtableHandler::fillCacheWithCurrentIteration() const
-{
-  casacore::Table curIt=itsIterator.table(); 
-  if (curIt.nrow()>1u) {
-      ASKAPTHROW(DataAccessError, "Multiple rows for the same TIME in the FIELD table "
-          "(e.g. polynomial interpolation) are not yet supported");
-  }
-  casacore::ROScalarColumn<casacore::Double> timeCol(curIt,"TIME");
-  itsCachedStartTime=timeCol(0);
-  casacore::ROScalarMeasColumn<casacore::MDirection> refDirCol(curIt,"REFERENCE_DIR");
-  itsReferenceDir=refDirCol(0);
-  ASKAPDEBUGASSERT(!itsIterator.pastEnd());
-  itsIterator.next();
-  if (!itsIterator.pastEnd()) {
-      itsCachedStopTime=timeCol(0);
-  }    
+  return itsReferenceDirs[fieldID];
 }
 
 /// @brief check whether the field changed for a given time
@@ -156,33 +160,42 @@ bool FieldSubtableHandler::newField(const casacore::MEpoch &time) const
   if (dTime<itsCachedStartTime) {
       return true;
   }
-  if (table().nrow() == 1) {
+  if (itsTimes.size() == 1) {
       return false;
   }
   return (dTime>itsCachedStopTime);
 }
 
-/// read the data if cache is outdated
+/// update the current field if cache is outdated
 /// @param[in] time a full epoch of interest (field table can have many
 /// pointings and therefore can be time-dependent)
 void FieldSubtableHandler::fillCacheOnDemand(const casacore::MEpoch &time) const
 {
-  const casacore::Double dTime=tableTime(time);
-  if (dTime<itsCachedStartTime) {
-      itsIterator.reset();
-      fillCacheWithCurrentIteration();
-  } 
-  if (dTime<itsCachedStartTime) {
-      ASKAPTHROW(DataAccessError, "An earlier time is requested ("<<time<<") than "
-             "the FIELD table has data for");
+  if (itsTimes.size() == 1u) {
+      // time-independent table
+      DataAccessStatistics::countHit("FieldSubtableHandler::fillCacheOnDemand");
+      itsCachedStartTime = itsTimes[0];
+      itsCachedStopTime = std::numeric_limits<casacore::Double>::max();
+      return;
   }
-  if ((table().nrow() == 1u) || 
-      (dTime>=itsCachedStartTime && dTime<=itsCachedStopTime)) {      
+  if (itsMultipleRowsPerTime) {
+      ASKAPTHROW(DataAccessError, "Multiple rows for the same TIME in the FIELD table "
+          "(e.g. polynomial interpolation) are not yet supported");
+  }
+  const casacore::Double dTime=tableTime(time);
+  if (!itsNeverAccessedFlag && (dTime>=itsCachedStartTime) && (dTime<=itsCachedStopTime)) {
+      DataAccessStatistics::countHit("FieldSubtableHandler::fillCacheOnDemand");
       return;
   }
-  while (!itsIterator.pastEnd() && ((dTime<itsCachedStartTime) || 
-         (dTime>itsCachedStopTime))) {
-     fillCacheWithCurrentIteration(); 
+  DataAccessStatistics::ScopedTimer timer("FieldSubtableHandler::fillCacheOnDemand");
+  timer.miss();
+  if (dTime<itsTimes[0]) {
+      ASKAPTHROW(DataAccessError, "An earlier time is requested ("<<time<<") than "
+             "the FIELD table has data for");
   }
-  ASKAPDEBUGASSERT(dTime>=itsCachedStartTime);
+  // the last field which starts at or before the requested time
+  itsCurrentIndex = (std::upper_bound(itsTimes.begin(), itsTimes.end(), dTime) - itsTimes.begin()) - 1;
+  itsCachedStartTime = itsTimes[itsCurrentIndex];
+  itsCachedStopTime = itsCurrentIndex + 1 < itsTimes.size() ? itsTimes[itsCurrentIndex + 1] :
+                      std::numeric_limits<casacore::Double>::max();
 }
@@ -39,9 +39,11 @@
 
 // casa includes
 #include <casacore/tables/Tables/Table.h>
-#include <casacore/tables/Tables/TableIter.h>
 #include <casacore/casa/Quanta/Quantum.h>
 
+// std includes
+#include <vector>
+
 // own includes
 #include <askap/dataaccess/IFieldSubtableHandler.h>
 #include <askap/dataaccess/TimeDependentSubtable.h>
@@ -56,11 +58,11 @@ namespace accessors {
 /// @details This class derived provides access to
 /// the content of the FIELD subtable (which provides delay, phase and
 /// reference centres for each time). The POINTING table gives the actual 
-/// pointing of the antennae. Although this implementation caches the values
-/// for the last requested time range, it reads the data on-demand. This is 
-/// a difference from subtable handler classes, whose name starts from Mem...
-/// The latter classes read all the subtable into memory in the constructor and
-/// later return cached values. 
+/// pointing of the antennae. The FIELD subtable is small, so this implementation
+/// reads all of it into memory in the constructor (similar to subtable handler classes,
+/// whose name starts from Mem...). Rows are sorted by time, so a time-based lookup is
+/// a binary search and access in an arbitrary order (e.g. mosaics switching fields
+/// often, or going back in time) is cheap.
 /// @note The class has not been properly tested with time-dependent FIELD table
 /// @ingroup dataaccess_tab
 struct FieldSubtableHandler : virtual public IFieldSubtableHandler,
@@ -116,19 +118,25 @@ struct FieldSubtableHandler : virtual public IFieldSubtableHandler,
                                                   const;
 
 protected:
-  /// read the data if cache is outdated
+  /// update the current field if cache is outdated
   /// @param[in] time a full epoch of interest (field table can have many
   /// pointing and therefore can be time-dependent)
   void fillCacheOnDemand(const casacore::MEpoch &time) const;
   
-  /// read the current iteration and populate cache
-  void fillCacheWithCurrentIteration() const;
-  
 private:
   
-  /// iterator over the FIELD subtable
-  mutable casacore::TableIterator itsIterator;
-   
+  /// TIME column sorted in the ascending order
+  std::vector<casacore::Double> itsTimes;
+
+  /// reference directions in the same order as itsTimes
+  std::vector<casacore::MDirection> itsTimeOrderedDirs;
+
+  /// reference directions in the row order (for FIELD_ID-based access)
+  std::vector<casacore::MDirection> itsReferenceDirs;
+
+  /// true, if there are multiple rows for the same time
+  bool itsMultipleRowsPerTime;
+
   /// start time of the time range, for which the cache is valid
   /// Time independent table has a very wide time range. Values are
   /// stored as Doubles in the native frame/units of the FIELD table
@@ -138,11 +146,8 @@ private:
   /// see itsCachedStartTime for more details.
   mutable casacore::Double itsCachedStopTime;
   
-  /// cache of the reference direction (time-based selection of rows)
-  mutable casacore::MDirection itsReferenceDir;
-
-  /// cache of the reference direction (direct row-based access)
-  mutable casacore::MDirection itsRandomlyAccessedReferenceDir;
+  /// index into itsTimes of the current field (time-based selection of rows)
+  mutable size_t itsCurrentIndex;
   
   /// @brief flag showing that no data has been obtained yet via this class
   /// @details It is necessary that newField always returns true before 
@@ -0,0 +1,163 @@
+/// @file
+/// @brief accessor adapter combining on-demand buffers and the best w-plane fit
+///
+/// @details This adapter replaces a stack of on-demand buffering adapters and
+/// BestWPlaneDataAccessor with a single layer.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/FusedDataAccessor.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor
+/// @param[in] wTolerance w-term tolerance in wavelengths for the best w-plane fit,
+///            negative value means no fitting is done
+/// @param[in] checkResidual if true, the magnitude of the residual w-term is checked to be below tolerance 
+FusedDataAccessor::FusedDataAccessor(double wTolerance, bool checkResidual) :
+      BestWPlaneDataAccessor(wTolerance, checkResidual), itsFitWPlane(wTolerance >= 0.),
+      itsBufferMonitor(changeMonitor()), itsVisibilitySubstituted(false), itsNoiseSubstituted(false),
+      itsFlagSubstituted(false), itsFrequencySubstituted(false) {}
+
+/// @brief invalidate all buffers if a new accessor has been associated
+/// @details This is the only cache check done on field access
+void FusedDataAccessor::syncBuffers() const
+{
+  if (!(itsBufferMonitor == changeMonitor())) {
+      itsBufferMonitor = changeMonitor();
+      itsVisibilitySubstituted = false;
+      itsNoiseSubstituted = false;
+      itsFlagSubstituted = false;
+      itsFrequencySubstituted = false;
+  }
+}
+
+/// @brief uvw after rotation
+/// @details The best plane is subtracted if fitting is enabled (see BestWPlaneDataAccessor)
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return uvw after rotation to the new coordinate system for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	         FusedDataAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
+{
+  if (itsFitWPlane) {
+      return BestWPlaneDataAccessor::rotatedUVW(tangentPoint);
+  }
+  return getROAccessor().rotatedUVW(tangentPoint);
+}
+
+/// @brief read-only visibilities
+/// @return a reference to nRow x nChannel x nPol cube, containing
+/// all visibility data
+const casacore::Cube<casacore::Complex>& FusedDataAccessor::visibility() const
+{
+  syncBuffers();
+  return itsVisibilitySubstituted ? itsVisibilityBuffer : getROAccessor().visibility();
+}
+
+/// @brief read-write visibilities
+/// @details The first call for the given accessor makes a copy of visibilities
+/// @return a reference to nRow x nChannel x nPol cube, containing
+/// all visibility data
+casacore::Cube<casacore::Complex>& FusedDataAccessor::rwVisibility()
+{
+  syncBuffers();
+  if (!itsVisibilitySubstituted) {
+      itsVisibilityBuffer.assign(getROAccessor().visibility());
+      itsVisibilitySubstituted = true;
+  }
+  return itsVisibilityBuffer;
+}
+
+/// @brief noise level required for a proper weighting
+/// @return a reference to nRow x nChannel x nPol cube with
+///         complex noise estimates
+const casacore::Cube<casacore::Complex>& FusedDataAccessor::noise() const
+{
+  syncBuffers();
+  return itsNoiseSubstituted ? itsNoiseBuffer : getROAccessor().noise();
+}
+
+/// @brief write access to noise level 
+/// @details The first call for the given accessor makes a copy of the noise
+/// @return a reference to nRow x nChannel x nPol cube with
+///         complex noise estimates
+casacore::Cube<casacore::Complex>& FusedDataAccessor::rwNoise()
+{
+  syncBuffers();
+  if (!itsNoiseSubstituted) {
+      itsNoiseBuffer.assign(getROAccessor().noise());
+      itsNoiseSubstituted = true;
+  }
+  return itsNoiseBuffer;
+}
+
+/// @brief cube of flags corresponding to the output of visibility()
+/// @return a reference to nRow x nChannel x nPol cube with the flag
+///         information. If True, the corresponding element is flagged.
+const casacore::Cube<casacore::Bool>& FusedDataAccessor::flag() const
+{
+  syncBuffers();
+  return itsFlagSubstituted ? itsFlagBuffer : getROAccessor().flag();
+}
+
+/// @brief non-const access to the cube of flags
+/// @details The first call for the given accessor makes a copy of flags
+/// @return a reference to nRow x nChannel x nPol cube with the flag
+///         information. If True, the corresponding element is flagged.
+casacore::Cube<casacore::Bool>& FusedDataAccessor::rwFlag()
+{
+  syncBuffers();
+  if (!itsFlagSubstituted) {
+      itsFlagBuffer.assign(getROAccessor().flag());
+      itsFlagSubstituted = true;
+  }
+  return itsFlagBuffer;
+}
+
+/// @brief frequency for each channel
+/// @return a reference to vector containing frequencies for each
+///         spectral channel (vector size is nChannel)
+const casacore::Vector<casacore::Double>& FusedDataAccessor::frequency() const
+{
+  syncBuffers();
+  return itsFrequencySubstituted ? itsFrequencyBuffer : getROAccessor().frequency();
+}
+
+/// @brief read-write access to the frequency
+/// @details The first call for the given accessor makes a copy of frequencies
+/// @return a reference to vector containing frequencies for each
+///         spectral channel (vector size is nChannel)
+casacore::Vector<casacore::Double>& FusedDataAccessor::rwFrequency()
+{
+  syncBuffers();
+  if (!itsFrequencySubstituted) {
+      itsFrequencyBuffer.assign(getROAccessor().frequency());
+      itsFrequencySubstituted = true;
+  }
+  return itsFrequencyBuffer;
+}
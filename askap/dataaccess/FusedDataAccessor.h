@@ -0,0 +1,170 @@
+/// @file
+/// @brief accessor adapter combining on-demand buffers and the best w-plane fit
+///
+/// @details Processing code typically stacks several adapters on top of the accessor
+/// returned by the iterator: OnDemandBufferDataAccessor for visibilities, OnDemandNoiseAndFlagDA
+/// for noise and flags, SmearingAccessorAdapter for frequencies and BestWPlaneDataAccessor
+/// for uvw's. Each layer adds a virtual call per field access and its own cache checks.
+/// This adapter provides the same functionality in a single layer with one check of the
+/// cache validity shared by all fields.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_FUSED_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_FUSED_DATA_ACCESSOR_H
+
+// own includes
+#include <askap/dataaccess/BestWPlaneDataAccessor.h>
+#include <askap/dataaccess/IFlagAndNoiseDataAccessor.h>
+#include <askap/scimath/utils/ChangeMonitor.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief accessor adapter combining on-demand buffers and the best w-plane fit
+/// @details Visibilities, noise, flags and frequencies are taken from the associated
+/// accessor until the corresponding read-write method is called. Then a copy is made
+/// and returned by both read-only and read-write methods for this field. Unlike
+/// DataAccessorAdapter, read-write methods never write through to the associated accessor.
+/// If the w-tolerance given at construction is not negative, rotatedUVW corrects w for
+/// the best fitting plane as BestWPlaneDataAccessor does. Otherwise, rotated uvw's
+/// are passed through.
+///
+/// All buffers are invalidated together when a new accessor is associated. Therefore,
+/// the adapter is expected to be associated with the accessor for each iteration (as
+/// required by BestWPlaneDataAccessor, too). Only the validity of the association is
+/// checked on field access, not the shape of individual fields.
+/// @ingroup dataaccess_hlp
+class FusedDataAccessor : public BestWPlaneDataAccessor,
+                          virtual public IFlagAndNoiseDataAccessor,
+                          public boost::noncopyable
+{
+public:
+  /// @brief constructor
+  /// @param[in] wTolerance w-term tolerance in wavelengths for the best w-plane fit,
+  ///            negative value means no fitting is done
+  /// @param[in] checkResidual if true, the magnitude of the residual w-term is checked to be below tolerance 
+  explicit FusedDataAccessor(double wTolerance = -1., bool checkResidual = true);
+
+  /// @return true, if the best w-plane fitting is done
+  inline bool fitsWPlane() const { return itsFitWPlane; }
+
+  /// @brief uvw after rotation
+  /// @details The best plane is subtracted if fitting is enabled (see BestWPlaneDataAccessor)
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @return uvw after rotation to the new coordinate system for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	         rotatedUVW(const casacore::MDirection &tangentPoint) const;
+
+  /// @brief read-only visibilities
+  /// @return a reference to nRow x nChannel x nPol cube, containing
+  /// all visibility data
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// @brief read-write visibilities
+  /// @details The first call for the given accessor makes a copy of visibilities
+  /// @return a reference to nRow x nChannel x nPol cube, containing
+  /// all visibility data
+  virtual casacore::Cube<casacore::Complex>& rwVisibility();
+
+  /// @brief noise level required for a proper weighting
+  /// @return a reference to nRow x nChannel x nPol cube with
+  ///         complex noise estimates
+  virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// @brief write access to noise level 
+  /// @details The first call for the given accessor makes a copy of the noise
+  /// @return a reference to nRow x nChannel x nPol cube with
+  ///         complex noise estimates
+  virtual casacore::Cube<casacore::Complex>& rwNoise();
+
+  /// @brief cube of flags corresponding to the output of visibility()
+  /// @return a reference to nRow x nChannel x nPol cube with the flag
+  ///         information. If True, the corresponding element is flagged.
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+  /// @brief non-const access to the cube of flags
+  /// @details The first call for the given accessor makes a copy of flags
+  /// @return a reference to nRow x nChannel x nPol cube with the flag
+  ///         information. If True, the corresponding element is flagged.
+  virtual casacore::Cube<casacore::Bool>& rwFlag();
+
+  /// @brief frequency for each channel
+  /// @return a reference to vector containing frequencies for each
+  ///         spectral channel (vector size is nChannel)
+  virtual const casacore::Vector<casacore::Double>& frequency() const;
+
+  /// @brief read-write access to the frequency
+  /// @details The first call for the given accessor makes a copy of frequencies
+  /// @return a reference to vector containing frequencies for each
+  ///         spectral channel (vector size is nChannel)
+  casacore::Vector<casacore::Double>& rwFrequency();
+
+private:
+  /// @brief invalidate all buffers if a new accessor has been associated
+  /// @details This is the only cache check done on field access
+  void syncBuffers() const;
+
+  /// @brief if true, w-plane is fitted
+  bool itsFitWPlane;
+
+  /// @brief change monitor of the association the buffers correspond to
+  mutable scimath::ChangeMonitor itsBufferMonitor;
+
+  /// @brief true, if the visibility buffer is used
+  mutable bool itsVisibilitySubstituted;
+
+  /// @brief true, if the noise buffer is used
+  mutable bool itsNoiseSubstituted;
+
+  /// @brief true, if the flag buffer is used
+  mutable bool itsFlagSubstituted;
+
+  /// @brief true, if the frequency buffer is used
+  mutable bool itsFrequencySubstituted;
+
+  /// @brief buffer for visibilities
+  casacore::Cube<casacore::Complex> itsVisibilityBuffer;
+
+  /// @brief buffer for noise
+  casacore::Cube<casacore::Complex> itsNoiseBuffer;
+
+  /// @brief buffer for flags
+  casacore::Cube<casacore::Bool> itsFlagBuffer;
+
+  /// @brief buffer for frequencies
+  casacore::Vector<casacore::Double> itsFrequencyBuffer;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_FUSED_DATA_ACCESSOR_H
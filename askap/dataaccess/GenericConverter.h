@@ -72,6 +72,23 @@ struct GenericConverter : virtual public IConverterBase {
        return converted.get(itsTargetUnit).getValue();
     }
 
+    /// @brief convert a number of values given in the same frame and units
+    /// @details Unlike operator(), the conversion engine is set up only once
+    /// @param[in] in values to convert
+    /// @param[in] inRef reference frame of the input values
+    /// @param[in] inUnit units of the input values
+    /// @param[out] out converted values (resized as necessary)
+    void convert(const casacore::Vector<casacore::Double> &in, 
+                 const typename M::Ref &inRef, const casacore::Unit &inUnit,
+                 casacore::Vector<casacore::Double> &out) const {
+       typename M::Convert conv(inRef, itsTargetRef);
+       out.resize(in.nelements());
+       for (casacore::uInt i = 0; i < in.nelements(); ++i) {
+            out[i] = conv(typename M::MVType(casacore::Quantity(in[i], inUnit))).
+                          getValue().get(itsTargetUnit).getValue();
+       }
+    }
+
     /// set a frame (i.e. time and/or position), where the
     /// conversion is performed
     /// @param[in] frame  MeasFrame object (can be constructed from
@@ -0,0 +1,153 @@
+/// @file
+///
+/// @brief Storage for accessor fields which only grows
+/// @details When the shape of the chunk changes (e.g. the last partial chunk or a
+/// change of the spectral window), resizing the cached cube frees the memory and
+/// allocates it again. This class keeps a flat buffer sized for the largest chunk
+/// seen so far and presents chunks of any shape as views into it, so the memory is
+/// allocated only when a larger chunk comes in.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_HIGH_WATER_STORAGE_H
+#define ASKAP_ACCESSORS_HIGH_WATER_STORAGE_H
+
+// own includes
+#include <askap/dataaccess/ArrayAllocator.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Slice.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <algorithm>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Storage for accessor fields which only grows
+/// @details The storage is a flat vector. Arrays attached to it are contiguous views of the
+/// required shape starting at the first element. The storage is released when this object
+/// and all arrays attached to it are destroyed. If the storage is still referenced elsewhere
+/// (e.g. the filled array has been handed over to another object via swapValues), it is not
+/// overwritten. New storage is allocated instead and the old one stays with its users.
+/// The storage is allocated with the given allocation policy (see ArrayAllocator), the
+/// global heap is used by default.
+/// @note Attaching and filling of arrays are not synchronised, the whole object is meant to
+/// be used by one thread at a time (as is the iterator which holds it).
+/// @ingroup dataaccess_hlp
+template<typename T>
+class HighWaterStorage {
+public:
+  /// @brief construct empty storage
+  HighWaterStorage() : itsNAllocations(0) {}
+
+  /// @brief make the given array a view into the storage
+  /// @details The storage grows if the required number of elements exceeds its size. The 
+  /// content of the array is undefined after this call (as after resize).
+  /// @param[in] array array to attach (Vector, Matrix, Cube or Array with the same
+  ///            element type)
+  /// @param[in] shape required shape of the array
+  template<typename A>
+  void attach(A &array, const casacore::IPosition &shape);
+
+  /// @brief set the allocation policy
+  /// @details The new policy applies to the storage allocated in the future.
+  /// @param[in] allocator shared pointer to the allocator, empty pointer means the global heap
+  inline void setAllocator(const boost::shared_ptr<ArrayAllocator const> &allocator)
+       { itsAllocator = allocator; }
+
+  /// @return number of elements in the storage (size of the largest chunk so far)
+  inline size_t capacity() const { return itsStorage.nelements(); }
+
+  /// @return number of times the storage has been allocated
+  inline size_t nAllocations() const { return itsNAllocations; }
+
+private:
+  /// @brief check whether the storage is used by anyone except the given array
+  /// @param[in] array array to check
+  /// @return true, if the storage can be overwritten
+  template<typename A>
+  bool isFree(A &array) const;
+
+  /// @brief flat storage
+  casacore::Vector<T> itsStorage;
+
+  /// @brief number of allocations
+  size_t itsNAllocations;
+
+  /// @brief allocation policy, empty for the global heap
+  boost::shared_ptr<ArrayAllocator const> itsAllocator;
+};
+
+/// @brief make the given array a view into the storage
+/// @details The storage grows if the required number of elements exceeds its size. The 
+/// content of the array is undefined after this call (as after resize).
+/// @param[in] array array to attach (Vector, Matrix, Cube or Array with the same
+///            element type)
+/// @param[in] shape required shape of the array
+template<typename T> template<typename A>
+void HighWaterStorage<T>::attach(A &array, const casacore::IPosition &shape)
+{
+  const size_t required = shape.product();
+  if (required == 0) {
+      array.resize(shape);
+      return;
+  }
+  if ((required > capacity()) || !isFree(array)) {
+      // don't shrink the storage even if the old one is still in use elsewhere
+      const size_t nElements = std::max(required, capacity());
+      itsStorage.reference(itsAllocator ? itsAllocator->allocate<T>(nElements) : casacore::Vector<T>(nElements));
+      ++itsNAllocations;
+  } else if (array.shape().isEqual(shape) && (array.data() == itsStorage.data())) {
+      // already attached
+      return;
+  }
+  array.reference(itsStorage(casacore::Slice(0, required)).reform(shape));
+}
+
+/// @brief check whether the storage is used by anyone except the given array
+/// @param[in] array array to check
+/// @return true, if the storage can be overwritten
+template<typename T> template<typename A>
+bool HighWaterStorage<T>::isFree(A &array) const
+{
+  if (itsStorage.nrefs() == 1) {
+      return true;
+  }
+  return (itsStorage.nrefs() == 2) && (array.nelements() > 0) && (array.data() == itsStorage.data());
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_HIGH_WATER_STORAGE_H
@@ -27,6 +27,7 @@
 ///
 //
 #include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/RowSliceAccessor.h>
 
 namespace askap {
 
@@ -38,4 +39,35 @@ accessors::IConstDataAccessor::~IConstDataAccessor()
 {
 }
 
+/// @brief bounding box of uvw
+/// @details The ranges of u, v and w and the largest uv-distance of all rows
+/// returned by uvw(). This default implementation scans uvw().
+/// @return bounding box of uvw
+accessors::UVWBounds accessors::IConstDataAccessor::uvwBounds() const
+{
+  return UVWBounds(uvw());
+}
+
+/// @brief bounding box of uvw after rotation
+/// @details The same as uvwBounds, but for the coordinates returned by rotatedUVW.
+/// This default implementation scans rotatedUVW().
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return bounding box of rotated uvw
+accessors::UVWBounds accessors::IConstDataAccessor::rotatedUVWBounds(const casacore::MDirection &tangentPoint) const
+{
+  return UVWBounds(rotatedUVW(tangentPoint));
+}
+
+/// @brief view of the given range of rows
+/// @details The view references the data of this accessor, no copy is
+/// made. See RowSliceAccessor for details.
+/// @param[in] begin first row of the view
+/// @param[in] end row following the last row of the view
+/// @return accessor with end-begin rows
+accessors::RowSliceAccessor accessors::IConstDataAccessor::rowSlice(casacore::uInt begin,
+                                                                    casacore::uInt end) const
+{
+  return RowSliceAccessor(*this, begin, end);
+}
+
 } // end of namespace askap
@@ -37,11 +37,14 @@
 #include <casacore/scimath/Mathematics/RigidVector.h>
 #include <casacore/measures/Measures/Stokes.h>
 
+#include <askap/dataaccess/UVWBounds.h>
 
 namespace askap {
 
 namespace accessors {
 
+class RowSliceAccessor;
+
 /// @brief Interface class for read-only access to visibility data
 /// @details IConstDataAccessor is an interface class for read-only 
 /// access to buffered visibility data. Working instances include 
@@ -164,6 +167,20 @@ public:
 	/// @return delays corresponding to the uvw rotation for each row
 	virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
 	         const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const = 0;
+
+	/// @brief bounding box of uvw
+	/// @details The ranges of u, v and w and the largest uv-distance of all rows
+	/// returned by uvw(). This default implementation scans uvw(), accessors
+	/// reading the data compute the bounds in the same pass as uvw.
+	/// @return bounding box of uvw
+	virtual UVWBounds uvwBounds() const;
+
+	/// @brief bounding box of uvw after rotation
+	/// @details The same as uvwBounds, but for the coordinates returned by rotatedUVW.
+	/// This default implementation scans rotatedUVW().
+	/// @param[in] tangentPoint tangent point to rotate the coordinates to
+	/// @return bounding box of rotated uvw
+	virtual UVWBounds rotatedUVWBounds(const casacore::MDirection &tangentPoint) const;
 	
 
     /// Noise level required for a proper weighting
@@ -199,6 +216,14 @@ public:
 	/// @note All rows of the accessor have the same structure of the visibility
 	/// cube, i.e. polarisation types returned by this method are valid for all rows.
 	virtual const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const = 0;
+
+	/// @brief view of the given range of rows
+	/// @details The view references the data of this accessor, no copy is
+	/// made. See RowSliceAccessor for details.
+	/// @param[in] begin first row of the view
+	/// @param[in] end row following the last row of the view
+	/// @return accessor with end-begin rows
+	RowSliceAccessor rowSlice(casacore::uInt begin, casacore::uInt end) const;
 };
 
 } // end of namespace accessors
@@ -128,6 +128,22 @@ public:
 	///                 between frequencies and velocities
 	///
 	virtual void setRestFrequency(const casacore::MVFrequency &restFreq) = 0;
+
+	/// set the epoch tolerance for frequency axis conversion
+	/// (e.g. spectral line processing in LSRK frame). Converted axes
+	/// are cached and reused for all epochs within the same interval
+	/// of the given length.
+	///
+	/// @param tolerance length of the interval in seconds. Zero means
+	///                  that the axis is converted for each epoch exactly
+	/// @param interpolate if true, axes are converted at the boundaries
+	///                  of the interval and linearly interpolated for
+	///                  the intermediate epochs. Otherwise, the axis
+	///                  converted for the middle of the interval is used.
+	///
+	/// Class defaults to exact conversion
+	virtual void setFrequencyTolerance(casacore::Double tolerance,
+	           bool interpolate = false) = 0;
 };
 
 } // namespace accessors
@@ -41,6 +41,8 @@
 #include <casacore/measures/Measures/MDirection.h>
 #include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/measures/Measures/MRadialVelocity.h>
+#include <casacore/measures/Measures/MPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
 
 // own includes
 #include <askap/dataaccess/IDataConverter.h>
@@ -73,12 +75,53 @@ public:
     /// @return epoch converted to Measure
     virtual casacore::MEpoch epochMeasure(const casacore::MVEpoch &in) const = 0;
 
+    /// @brief convert a number of epochs in one go
+    /// @param[in] in input epochs
+    /// @param[in] inRef reference frame of the input epochs
+    /// @param[out] out epochs converted to Double (resized as necessary)
+    virtual void epochs(const casacore::Vector<casacore::MVEpoch> &in,
+                        const casacore::MEpoch::Ref &inRef,
+                        casacore::Vector<casacore::Double> &out) const = 0;
+
     /// convert directions
     /// @param[in] in input direction given as an MDirection object
     /// @param out output direction as an MVDirection object
     virtual void direction(const casacore::MDirection &in,
                            casacore::MVDirection &out) const = 0;
 
+    /// @brief convert a number of directions in one go
+    /// @param[in] in input directions
+    /// @param[in] inRef reference frame of the input directions
+    /// @param[out] out converted directions (resized as necessary)
+    virtual void directions(const casacore::Vector<casacore::MVDirection> &in,
+                            const casacore::MDirection::Ref &inRef,
+                            casacore::Vector<casacore::MVDirection> &out) const = 0;
+
+    /// @brief obtain the reference frame for directions
+    /// @details This allows to set up a specialised converter (e.g. 
+    /// BatchDirectionConverter) for the same target frame
+    /// @return reference frame all directions are converted to
+    virtual const casacore::MDirection::Ref& directionFrame() const = 0;
+
+    /// @brief convert a frequency axis
+    /// @details All channels are converted with the same conversion engine. 
+    /// The converted axes can be cached (see IDataConverter::setFrequencyTolerance).
+    /// The antenna position is assumed to be the same for all calls with the same
+    /// axisID.
+    /// @param[in] axisID identifier of the input axis (e.g. spectral window ID),
+    ///            a negative value disables caching
+    /// @param[in] in input frequencies
+    /// @param[in] inRef reference frame of the input frequencies
+    /// @param[in] inUnit units of the input frequencies
+    /// @param[in] epoch epoch of the conversion
+    /// @param[in] pos position of the observer
+    /// @param[in] dir direction of interest
+    /// @param[out] out converted frequencies (resized as necessary)
+    virtual void frequencies(casacore::Int axisID, const casacore::Vector<casacore::Double> &in,
+                   const casacore::MFrequency::Ref &inRef, const casacore::Unit &inUnit,
+                   const casacore::MEpoch &epoch, const casacore::MPosition &pos,
+                   const casacore::MDirection &dir, casacore::Vector<casacore::Double> &out) const = 0;
+
     /// test whether the frequency conversion is void
     /// @param[in] testRef reference frame to test
     /// @param[in] testUnit units to test
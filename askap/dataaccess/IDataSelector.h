@@ -51,6 +51,37 @@ namespace accessors {
 class IDataSelector
 {
 public:
+    /// @brief fields of the accessor which can be declared as used
+    /// @details The values are bit masks and can be combined with bitwise OR
+    /// to declare a subset of fields via chooseAccessorFields. Time and the
+    /// shape of the chunk are always available.
+    enum AccessorFields {
+       /// visibility cube
+       VISIBILITY = 1,
+       /// flag cube
+       FLAG = 2,
+       /// noise cube
+       NOISE = 4,
+       /// uvw coordinates
+       UVW = 8,
+       /// frequency axis
+       FREQUENCY = 16,
+       /// antenna1 and antenna2
+       ANTENNA = 32,
+       /// feed1 and feed2
+       FEED = 64,
+       /// feed1PA and feed2PA
+       FEED_PA = 128,
+       /// pointingDir1 and pointingDir2 (rotatedUVW and uvwRotationDelay require this together with UVW)
+       POINTING = 256,
+       /// dishPointing1 and dishPointing2
+       DISH_POINTING = 512,
+       /// polarisation types
+       STOKES = 1024,
+       /// all fields (default)
+       ALL_FIELDS = 2047
+    };
+
     /// An empty virtual destructor to make the compiler happy
     virtual ~IDataSelector();
 
@@ -174,6 +205,16 @@ public:
     /// Choose a single scan number
     /// @param[in] scanNumber the scan number to choose
     virtual void chooseScanNumber(casacore::uInt scanNumber) = 0;
+
+    /// @brief declare a subset of accessor fields which will be used
+    /// @details Narrow jobs (e.g. calibration passes using visibilities, flags and
+    /// antenna indices only) can declare ahead of time which fields of the accessor
+    /// they are going to access. The implementation can then avoid unnecessary work
+    /// (e.g. reading data ahead or setting up subtable handlers for the fields not used)
+    /// and throws an exception if an undeclared field is requested. By default, all fields
+    /// are available.
+    /// @param[in] fields bitwise combination of AccessorFields values
+    virtual void chooseAccessorFields(casacore::uInt fields) = 0;
 };
 
 } // end of namespace accessors
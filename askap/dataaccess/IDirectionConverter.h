@@ -36,6 +36,7 @@
 // CASA includes
 #include <casacore/measures/Measures/MDirection.h>
 #include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/casa/Arrays/Vector.h>
 
 // own includes
 #include <askap/dataaccess/IConverterBase.h>
@@ -56,6 +57,16 @@ struct IDirectionConverter : virtual public IConverterBase {
     /// property of the actual instance of the derived class
     virtual casacore::MVDirection operator()(const casacore::MDirection &in) const = 0;
 
+    /// @brief convert a number of directions in one go
+    /// @details All directions are given in the same frame, so a single conversion
+    /// engine is set up and reused for all elements.
+    /// @param[in] in directions to convert
+    /// @param[in] inRef reference frame of the input directions
+    /// @param[out] out converted directions (resized as necessary)
+    virtual void convert(const casacore::Vector<casacore::MVDirection> &in,
+                         const casacore::MDirection::Ref &inRef,
+                         casacore::Vector<casacore::MVDirection> &out) const = 0;
+
     /// using statement to have setMeasFrame public.
     using IConverterBase::setMeasFrame;
 };
@@ -36,6 +36,7 @@
 // CASA includes
 #include <casacore/measures/Measures/MEpoch.h>
 #include <casacore/measures/Measures/MeasFrame.h>
+#include <casacore/casa/Arrays/Vector.h>
 
 // own includes
 #include <askap/dataaccess/IConverterBase.h>
@@ -58,6 +59,16 @@ struct IEpochConverter : virtual public IConverterBase {
     /// properties of the actual instance of the derived class
     virtual casacore::Double operator()(const casacore::MEpoch &in) const = 0;
 
+    /// @brief convert a number of epochs in one go
+    /// @details All epochs are given in the same frame, so a single conversion
+    /// engine is set up and reused for all elements.
+    /// @param[in] in epochs to convert
+    /// @param[in] inRef reference frame of the input epochs
+    /// @param[out] out epochs in the target units/frame (resized as necessary)
+    virtual void convert(const casacore::Vector<casacore::MVEpoch> &in,
+                         const casacore::MEpoch::Ref &inRef,
+                         casacore::Vector<casacore::Double> &out) const = 0;
+
     /// Reverse conversion (casacore::Double to full measure)
     /// @param[in] in an epoch given as Double in the target units/frame
     /// @return the same epoch as a fully qualified measure
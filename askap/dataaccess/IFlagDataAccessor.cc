@@ -0,0 +1,79 @@
+/// @file IFlagDataAccessor.cc
+/// @brief An read/write interface to flagging information
+/// @details Default implementations of the row-based flag updates.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/dataaccess/IFlagDataAccessor.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+
+/// @brief replace flags of a range of rows
+/// @details Unlike rwFlag, this method tells the implementation which rows
+/// have been changed, so it can write back just these rows. This default
+/// implementation copies the flags into the cube returned by rwFlag.
+/// @param[in] row first row to update
+/// @param[in] flags nRowsToUpdate x nChannel x nPol cube with new flags
+void accessors::IFlagDataAccessor::updateFlags(casacore::uInt row, const casacore::Cube<casacore::Bool> &flags)
+{
+  if (flags.nrow() == 0) {
+      return;
+  }
+  casacore::Cube<casacore::Bool> &cube = rwFlag();
+  ASKAPCHECK(row + flags.nrow() <= cube.nrow(), "Rows "<<row<<" to "<<row + flags.nrow() - 1<<
+             " are outside the accessor with "<<cube.nrow()<<" rows");
+  ASKAPCHECK(flags.ncolumn() == cube.ncolumn() && flags.nplane() == cube.nplane(),
+             "Flags to update have "<<flags.ncolumn()<<" channels and "<<flags.nplane()<<
+             " polarisations, the accessor has "<<cube.ncolumn()<<" and "<<cube.nplane());
+  if (cube.nelements() == 0) {
+      return;
+  }
+  cube(casacore::IPosition(3, row, 0, 0), casacore::IPosition(3, row + flags.nrow() - 1,
+       cube.ncolumn() - 1, cube.nplane() - 1)) = flags;
+}
+
+/// @brief flag whole rows
+/// @details Implementations can use row-based flags (e.g. FLAG_ROW) if available.
+/// This default implementation sets the rows of the cube returned by rwFlag.
+/// @param[in] row first row to flag
+/// @param[in] nRows number of rows to flag
+void accessors::IFlagDataAccessor::flagRows(casacore::uInt row, casacore::uInt nRows)
+{
+  if (nRows == 0) {
+      return;
+  }
+  casacore::Cube<casacore::Bool> &cube = rwFlag();
+  ASKAPCHECK(row + nRows <= cube.nrow(), "Rows "<<row<<" to "<<row + nRows - 1<<
+             " are outside the accessor with "<<cube.nrow()<<" rows");
+  if (cube.nelements() == 0) {
+      return;
+  }
+  cube(casacore::IPosition(3, row, 0, 0), casacore::IPosition(3, row + nRows - 1,
+       cube.ncolumn() - 1, cube.nplane() - 1)) = casacore::True;
+}
+
+} // end of namespace askap
@@ -59,6 +59,21 @@ public:
         /// @return a reference to nRow x nChannel x nPol cube with the flag
         ///         information. If True, the corresponding element is flagged.
         virtual casacore::Cube<casacore::Bool>& rwFlag() = 0;
+
+        /// @brief replace flags of a range of rows
+        /// @details Unlike rwFlag, this method tells the implementation which rows
+        /// have been changed, so it can write back just these rows. This default
+        /// implementation copies the flags into the cube returned by rwFlag.
+        /// @param[in] row first row to update
+        /// @param[in] flags nRowsToUpdate x nChannel x nPol cube with new flags
+        virtual void updateFlags(casacore::uInt row, const casacore::Cube<casacore::Bool> &flags);
+
+        /// @brief flag whole rows
+        /// @details Implementations can use row-based flags (e.g. FLAG_ROW) if available.
+        /// This default implementation sets the rows of the cube returned by rwFlag.
+        /// @param[in] row first row to flag
+        /// @param[in] nRows number of rows to flag
+        virtual void flagRows(casacore::uInt row, casacore::uInt nRows);
 };
 
 } // end of namespace accessors
@@ -0,0 +1,76 @@
+/// @file
+///
+/// @brief Interface of caches which give up memory on request
+/// @details Caches implementing this interface register with MemoryGovernor, which
+/// keeps the total memory used by all of them within a single budget.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_I_MEMORY_CONSUMER_H
+#define ASKAP_ACCESSORS_I_MEMORY_CONSUMER_H
+
+// own includes
+#include <askap/dataaccess/IHolder.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Interface of caches which give up memory on request
+/// @details The governor compares entries of different caches by the use stamps
+/// obtained via MemoryGovernor::stamp, which the cache records whenever an entry is
+/// added or used. The methods are called by the governor from any thread, but never while
+/// the governor waits for the lock of the same cache, so implementations should be
+/// thread-safe and shouldn't call the governor while their own lock is held.
+/// @ingroup dataaccess_hlp
+struct IMemoryConsumer : virtual public IHolder {
+  /// @return name of the cache used in usage reports and in the parset
+  virtual std::string consumerName() const = 0;
+
+  /// @return memory used by the cached data in bytes
+  virtual size_t memoryUsed() const = 0;
+
+  /// @brief use stamp of the least recently used entry
+  /// @return stamp obtained from MemoryGovernor::stamp or the largest possible value
+  /// if the cache is empty
+  virtual casacore::uInt64 oldestUse() const = 0;
+
+  /// @brief drop the least recently used entry
+  /// @return memory released in bytes, 0 if nothing could be released
+  virtual size_t releaseOldest() = 0;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_MEMORY_CONSUMER_H
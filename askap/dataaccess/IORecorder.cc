@@ -0,0 +1,445 @@
+/// @file
+///
+/// @brief Recorder of the I/O access pattern
+/// @details Reads and writes of table columns, image regions and calibration
+/// solutions are logged with their sizes and timestamps into a compact binary trace.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/IORecorder.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+// system includes
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".IORecorder");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief magic string at the start of the trace
+const char theTraceMagic[8] = {'A', 'S', 'K', 'A', 'P', 'I', 'O', 'T'};
+
+/// @brief version of the trace format
+const std::uint32_t theTraceVersion = 1;
+
+/// @brief byte order mark, read back differently on machines of other endianness
+const std::uint32_t theByteOrderMark = 0x01020304;
+
+/// @brief type of the record defining a string
+const std::uint8_t theStringRecord = 0;
+
+/// @brief size of the buffer triggering a write to disk
+const size_t theFlushThreshold = 1024 * 1024;
+
+/// @brief state of the recorder
+struct RecorderState {
+  /// @brief initialise an idle recorder
+  RecorderState() : itsEvents(0) {}
+
+  /// @brief mutex protecting the state
+  boost::mutex itsMutex;
+
+  /// @brief trace file
+  std::ofstream itsStream;
+
+  /// @brief name of the trace file
+  std::string itsFileName;
+
+  /// @brief records not yet written to the file
+  std::vector<char> itsBuffer;
+
+  /// @brief indices of the strings defined so far
+  std::map<std::string, std::uint32_t> itsStrings;
+
+  /// @brief number of events recorded since start
+  size_t itsEvents;
+};
+
+/// @brief the recorder state
+/// @details A function-level static is used to avoid problems with the order of static
+/// initialisation
+/// @return reference to the state
+RecorderState& recorderState()
+{
+  static RecorderState state;
+  return state;
+}
+
+/// @brief origin of the timestamps (time since the epoch of the steady clock)
+/// @details It is kept separately from the state, so the scoped events can read it without locking.
+std::atomic<boost::chrono::steady_clock::rep> theOrigin(0);
+
+/// @brief small index of the calling thread
+/// @return index of the calling thread
+unsigned int threadIndex()
+{
+  static std::atomic<unsigned int> nThreads(0);
+  thread_local const unsigned int index = ++nThreads;
+  return index;
+}
+
+/// @brief append a value to the buffer
+/// @param[in] buffer buffer to append to
+/// @param[in] value value to append
+template<typename T>
+void append(std::vector<char> &buffer, const T &value)
+{
+  const char *ptr = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+}
+
+/// @brief index of the string, defining it in the trace if necessary
+/// @param[in] state recorder state (should be locked)
+/// @param[in] str string
+/// @return index of the string
+std::uint32_t stringIndex(RecorderState &state, const std::string &str)
+{
+  const std::map<std::string, std::uint32_t>::const_iterator ci = state.itsStrings.find(str);
+  if (ci != state.itsStrings.end()) {
+      return ci->second;
+  }
+  const std::uint32_t index = static_cast<std::uint32_t>(state.itsStrings.size());
+  state.itsStrings[str] = index;
+  append(state.itsBuffer, theStringRecord);
+  append(state.itsBuffer, index);
+  append(state.itsBuffer, static_cast<std::uint32_t>(str.size()));
+  state.itsBuffer.insert(state.itsBuffer.end(), str.begin(), str.end());
+  return index;
+}
+
+/// @brief write the buffered records into the file
+/// @param[in] state recorder state (should be locked)
+void writeBuffer(RecorderState &state)
+{
+  if (!state.itsBuffer.empty()) {
+      state.itsStream.write(state.itsBuffer.data(), state.itsBuffer.size());
+      state.itsBuffer.clear();
+      if (!state.itsStream) {
+          ASKAPLOG_ERROR_STR(logger, "Failed to write the I/O trace into "<<state.itsFileName);
+      }
+  }
+}
+
+/// @brief read a value from the stream
+/// @param[in] is stream to read from
+/// @param[out] value value read
+/// @return true, if the value has been read
+template<typename T>
+bool extract(std::istream &is, T &value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/// @brief starts and stops recording requested via ASKAP_IO_TRACE
+/// @details The state is constructed first, so it is destroyed after this object.
+struct RecorderFromEnvironment {
+  /// @brief start recording, if requested
+  RecorderFromEnvironment()
+  {
+    recorderState();
+    const char *value = std::getenv("ASKAP_IO_TRACE");
+    if ((value != NULL) && (std::strlen(value) > 0)) {
+        try {
+           IORecorder::start(value);
+        }
+        catch (const std::exception &ex) {
+           ASKAPLOG_ERROR_STR(logger, "Failed to start recording the I/O trace: "<<ex.what());
+        }
+    }
+  }
+
+  /// @brief finish the trace
+  ~RecorderFromEnvironment()
+  {
+    IORecorder::stop();
+  }
+};
+
+/// @brief the recorder started by the environment variable
+RecorderFromEnvironment theRecorderFromEnvironment;
+
+} // anonymous namespace
+
+std::atomic<bool> IORecorder::theirEnabled(false);
+
+/// @brief initialise an empty event
+/// @param[in] type type of the event
+IORecorder::Event::Event(EventType type) : itsType(type), itsThread(0), itsStart(0.), itsDuration(0.),
+      itsBytes(0) {}
+
+/// @brief start the event
+/// @param[in] type type of the event
+IORecorder::ScopedEvent::ScopedEvent(EventType type) : itsActive(IORecorder::enabled()), itsEvent(type)
+{
+  if (itsActive) {
+      itsStart = boost::chrono::steady_clock::now();
+  }
+}
+
+/// @brief finish the event and record it
+IORecorder::ScopedEvent::~ScopedEvent()
+{
+  if (itsActive) {
+      try {
+         const boost::chrono::steady_clock::time_point origin(boost::chrono::steady_clock::duration(theOrigin.load()));
+         itsEvent.itsStart = boost::chrono::duration<double>(itsStart - origin).count();
+         itsEvent.itsDuration = boost::chrono::duration<double>(boost::chrono::steady_clock::now() -
+                                itsStart).count();
+         IORecorder::record(itsEvent);
+      }
+      catch (...) {
+         // can't throw from the destructor, the event is lost
+      }
+  }
+}
+
+/// @brief set the rows accessed
+/// @param[in] table table accessed
+/// @param[in] column name of the column
+/// @param[in] row first row (of the given table)
+/// @param[in] nRows number of rows
+void IORecorder::ScopedEvent::setRows(const casacore::Table &table, const std::string &column,
+                                      casacore::rownr_t row, casacore::rownr_t nRows)
+{
+  if (itsActive) {
+      casacore::rownr_t rootRow = row;
+      if (table.isRootTable()) {
+          itsEvent.itsObject = table.tableName();
+      } else {
+          // a reference table refers to the rows of its root table directly
+          const casacore::Block<casacore::String> parts = table.getPartNames();
+          itsEvent.itsObject = parts.nelements() > 0 ? std::string(parts[0]) : std::string(table.tableName());
+          if (nRows > 0) {
+              rootRow = table.rowNumbers()[row];
+          }
+      }
+      itsEvent.itsDetail = column;
+      itsEvent.itsCoordinates.assign(1, static_cast<casacore::Int64>(rootRow));
+      itsEvent.itsCoordinates.push_back(static_cast<casacore::Int64>(nRows));
+  }
+}
+
+/// @brief set the channels accessed
+/// @param[in] startChan first channel
+/// @param[in] nChan number of channels
+void IORecorder::ScopedEvent::setChannels(casacore::uInt startChan, casacore::uInt nChan)
+{
+  if (itsActive) {
+      ASKAPDEBUGASSERT(itsEvent.itsCoordinates.size() == 2);
+      itsEvent.itsCoordinates.push_back(startChan);
+      itsEvent.itsCoordinates.push_back(nChan);
+  }
+}
+
+/// @brief set the image region accessed
+/// @param[in] image name of the image
+/// @param[in] format image format (e.g. casa or fits)
+/// @param[in] blc bottom left corner of the region
+/// @param[in] shape shape of the region
+void IORecorder::ScopedEvent::setRegion(const std::string &image, const std::string &format,
+                                        const casacore::IPosition &blc, const casacore::IPosition &shape)
+{
+  if (itsActive) {
+      ASKAPDEBUGASSERT(blc.nelements() == shape.nelements());
+      itsEvent.itsObject = image;
+      itsEvent.itsDetail = format;
+      itsEvent.itsCoordinates.assign(blc.begin(), blc.end());
+      itsEvent.itsCoordinates.insert(itsEvent.itsCoordinates.end(), shape.begin(), shape.end());
+  }
+}
+
+/// @brief start recording into the given file
+/// @param[in] fname name of the trace file ("%p" is replaced by the process id)
+void IORecorder::start(const std::string &fname)
+{
+  stop();
+  std::string name = fname;
+  const size_t pos = name.find("%p");
+  if (pos != std::string::npos) {
+      std::ostringstream os;
+      os << getpid();
+      name.replace(pos, 2, os.str());
+  }
+  RecorderState &state = recorderState();
+  boost::lock_guard<boost::mutex> lock(state.itsMutex);
+  state.itsStream.clear();
+  state.itsStream.open(name.c_str(), std::ios::binary | std::ios::trunc);
+  ASKAPCHECK(state.itsStream.is_open(), "Unable to open "<<name<<" to write the I/O trace");
+  state.itsFileName = name;
+  state.itsBuffer.clear();
+  state.itsStrings.clear();
+  state.itsEvents = 0;
+  state.itsBuffer.insert(state.itsBuffer.end(), theTraceMagic, theTraceMagic + sizeof(theTraceMagic));
+  append(state.itsBuffer, theTraceVersion);
+  append(state.itsBuffer, theByteOrderMark);
+  theOrigin.store(boost::chrono::steady_clock::now().time_since_epoch().count());
+  ASKAPLOG_INFO_STR(logger, "Recording the I/O trace into "<<name);
+  theirEnabled.store(true);
+}
+
+/// @brief stop recording
+void IORecorder::stop()
+{
+  RecorderState &state = recorderState();
+  boost::lock_guard<boost::mutex> lock(state.itsMutex);
+  if (!state.itsStream.is_open()) {
+      return;
+  }
+  theirEnabled.store(false);
+  writeBuffer(state);
+  state.itsStream.close();
+  ASKAPLOG_INFO_STR(logger, "Written "<<state.itsEvents<<" event(s) into the I/O trace "<<state.itsFileName);
+}
+
+/// @return number of events recorded since the last start
+size_t IORecorder::eventsRecorded()
+{
+  RecorderState &state = recorderState();
+  boost::lock_guard<boost::mutex> lock(state.itsMutex);
+  return state.itsEvents;
+}
+
+/// @brief record an event
+/// @param[in] event event to record
+void IORecorder::record(const Event &event)
+{
+  if (!enabled()) {
+      return;
+  }
+  const unsigned int thread = threadIndex();
+  RecorderState &state = recorderState();
+  boost::lock_guard<boost::mutex> lock(state.itsMutex);
+  // the recording might have been stopped by another thread in the meantime
+  if (!state.itsStream.is_open()) {
+      return;
+  }
+  ASKAPCHECK(event.itsCoordinates.size() < 256, "Too many coordinates ("<<event.itsCoordinates.size()<<
+             ") in the I/O event");
+  const std::uint32_t object = stringIndex(state, event.itsObject);
+  const std::uint32_t detail = stringIndex(state, event.itsDetail);
+  append(state.itsBuffer, static_cast<std::uint8_t>(event.itsType));
+  append(state.itsBuffer, static_cast<std::uint32_t>(thread));
+  append(state.itsBuffer, event.itsStart);
+  append(state.itsBuffer, event.itsDuration);
+  append(state.itsBuffer, event.itsBytes);
+  append(state.itsBuffer, object);
+  append(state.itsBuffer, detail);
+  append(state.itsBuffer, static_cast<std::uint8_t>(event.itsCoordinates.size()));
+  for (std::vector<casacore::Int64>::const_iterator ci = event.itsCoordinates.begin();
+       ci != event.itsCoordinates.end(); ++ci) {
+       append(state.itsBuffer, static_cast<std::int64_t>(*ci));
+  }
+  ++state.itsEvents;
+  if (state.itsBuffer.size() >= theFlushThreshold) {
+      writeBuffer(state);
+  }
+}
+
+/// @brief read a trace
+/// @param[in] fname name of the trace file
+/// @return events in the order they have been recorded
+std::vector<IORecorder::Event> IORecorder::readTrace(const std::string &fname)
+{
+  std::ifstream is(fname.c_str(), std::ios::binary);
+  ASKAPCHECK(is.is_open(), "Unable to open the I/O trace "<<fname);
+  char magic[sizeof(theTraceMagic)];
+  std::uint32_t version = 0;
+  std::uint32_t byteOrderMark = 0;
+  ASKAPCHECK(is.read(magic, sizeof(magic)) && (std::memcmp(magic, theTraceMagic, sizeof(magic)) == 0) &&
+             extract(is, version) && extract(is, byteOrderMark), fname<<" is not an I/O trace");
+  ASKAPCHECK(version == theTraceVersion, "I/O trace "<<fname<<" has unsupported version "<<version);
+  ASKAPCHECK(byteOrderMark == theByteOrderMark, "I/O trace "<<fname<<
+             " has been written on a machine with a different byte order");
+  std::vector<std::string> strings;
+  std::vector<Event> result;
+  std::uint8_t type = 0;
+  while (extract(is, type)) {
+         if (type == theStringRecord) {
+             std::uint32_t index = 0;
+             std::uint32_t length = 0;
+             ASKAPCHECK(extract(is, index) && extract(is, length), "I/O trace "<<fname<<" is truncated");
+             ASKAPCHECK(index == strings.size(), "Unexpected string index "<<index<<" in the I/O trace "<<fname);
+             std::string str(length, ' ');
+             ASKAPCHECK(is.read(&str[0], length), "I/O trace "<<fname<<" is truncated");
+             strings.push_back(str);
+             continue;
+         }
+         ASKAPCHECK((type >= TABLE_READ) && (type <= CAL_FETCH), "Unknown record type "<<int(type)<<
+                    " in the I/O trace "<<fname);
+         Event event(static_cast<EventType>(type));
+         std::uint32_t thread = 0;
+         std::uint32_t object = 0;
+         std::uint32_t detail = 0;
+         std::uint8_t nCoords = 0;
+         ASKAPCHECK(extract(is, thread) && extract(is, event.itsStart) && extract(is, event.itsDuration) &&
+                    extract(is, event.itsBytes) && extract(is, object) && extract(is, detail) &&
+                    extract(is, nCoords), "I/O trace "<<fname<<" is truncated");
+         ASKAPCHECK((object < strings.size()) && (detail < strings.size()), "Undefined string referred to in the I/O trace "<<
+                    fname);
+         event.itsThread = thread;
+         event.itsObject = strings[object];
+         event.itsDetail = strings[detail];
+         event.itsCoordinates.resize(nCoords);
+         for (std::uint8_t coord = 0; coord < nCoords; ++coord) {
+              std::int64_t value = 0;
+              ASKAPCHECK(extract(is, value), "I/O trace "<<fname<<" is truncated");
+              event.itsCoordinates[coord] = value;
+         }
+         result.push_back(event);
+  }
+  return result;
+}
+
+/// @brief name of the event type
+/// @param[in] type type of the event
+/// @return name in lower case (e.g. table_read)
+std::string IORecorder::typeName(EventType type)
+{
+  switch (type) {
+     case TABLE_READ: return "table_read";
+     case TABLE_WRITE: return "table_write";
+     case IMAGE_READ: return "image_read";
+     case IMAGE_WRITE: return "image_write";
+     case CAL_FETCH: return "cal_fetch";
+  };
+  ASKAPTHROW(AskapError, "Unknown I/O event type "<<int(type));
+}
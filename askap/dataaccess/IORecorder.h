@@ -0,0 +1,221 @@
+/// @file
+///
+/// @brief Recorder of the I/O access pattern
+/// @details Reads and writes of table columns, image regions and calibration
+/// solutions can be logged with their sizes and timestamps into a compact binary
+/// trace. The trace can then be replayed (see the replayiotrace tool) to reproduce
+/// the I/O workload without running the science code.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_IO_RECORDER_H
+#define ASKAP_ACCESSORS_IO_RECORDER_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/tables/Tables/Table.h>
+
+// boost includes
+#include <boost/chrono.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Recorder of the I/O access pattern
+/// @details Recording is disabled by default and can be switched on with start (or by setting
+/// the ASKAP_IO_TRACE environment variable to the name of the trace file, "%p" in the name is
+/// replaced by the process id, so each rank of a parallel job gets its own trace). While disabled,
+/// the cost of instrumentation is a check of a single flag. The events are buffered in memory and
+/// appended to the file in large blocks, so the trace can be much longer than the buffer.
+///
+/// The trace starts with a header (magic string, version and byte order mark). It is followed by
+/// the records, each starting with a byte giving its type. Names of tables, columns and images are
+/// stored once as string records, events refer to them by index. Each event has the thread index,
+/// start time and duration in seconds, the number of bytes transferred, the object and detail names
+/// and a list of coordinates, their meaning depends on the event type (see EventType).
+/// All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class IORecorder {
+public:
+  /// @brief types of events
+  enum EventType {
+     /// @brief read of table rows, the object is the root table, the detail is the column,
+     /// coordinates are the first row in the root table, the number of rows and, optionally,
+     /// the first channel and the number of channels
+     TABLE_READ = 1,
+     /// @brief write of table rows, the same coordinates as for TABLE_READ
+     TABLE_WRITE,
+     /// @brief read of an image region, the object is the image name, the detail is the
+     /// image format (casa or fits), coordinates are blc followed by the shape of the region
+     IMAGE_READ,
+     /// @brief write of an image region, the same coordinates as for IMAGE_READ
+     IMAGE_WRITE,
+     /// @brief fetch of a calibration solution, the object is the calibration table, the
+     /// detail is the column (e.g. GAIN), coordinates are the row and the number of rows
+     CAL_FETCH
+  };
+
+  /// @brief a single recorded event
+  struct Event {
+     /// @brief initialise an empty event
+     /// @param[in] type type of the event
+     explicit Event(EventType type = TABLE_READ);
+
+     /// @brief type of the event
+     EventType itsType;
+
+     /// @brief index of the thread (in the order threads have first recorded an event)
+     unsigned int itsThread;
+
+     /// @brief start time in seconds since the start of recording
+     double itsStart;
+
+     /// @brief duration in seconds
+     double itsDuration;
+
+     /// @brief number of bytes transferred
+     std::uint64_t itsBytes;
+
+     /// @brief name of the table or image
+     std::string itsObject;
+
+     /// @brief column name or image format
+     std::string itsDetail;
+
+     /// @brief coordinates of the access, see EventType
+     std::vector<casacore::Int64> itsCoordinates;
+  };
+
+  /// @brief helper class recording a scope as an event
+  /// @details The time between construction and destruction is the duration of the event.
+  /// Nothing is done if the recording is disabled at the time of construction, the setters
+  /// are then no-ops as well.
+  class ScopedEvent : public boost::noncopyable {
+  public:
+     /// @brief start the event
+     /// @param[in] type type of the event
+     explicit ScopedEvent(EventType type);
+
+     /// @brief finish the event and record it
+     ~ScopedEvent();
+
+     /// @return true, if the event is going to be recorded
+     inline bool active() const { return itsActive; }
+
+     /// @brief set the rows accessed
+     /// @details Rows of a reference table (e.g. an iteration of a table iterator) are
+     /// translated into the rows of its root table. The rows are assumed to be contiguous
+     /// in the root table, so only the first one is translated.
+     /// @param[in] table table accessed
+     /// @param[in] column name of the column
+     /// @param[in] row first row (of the given table)
+     /// @param[in] nRows number of rows
+     void setRows(const casacore::Table &table, const std::string &column, casacore::rownr_t row,
+                  casacore::rownr_t nRows);
+
+     /// @brief set the channels accessed
+     /// @details This method should be called after setRows.
+     /// @param[in] startChan first channel
+     /// @param[in] nChan number of channels
+     void setChannels(casacore::uInt startChan, casacore::uInt nChan);
+
+     /// @brief set the image region accessed
+     /// @param[in] image name of the image
+     /// @param[in] format image format (e.g. casa or fits)
+     /// @param[in] blc bottom left corner of the region
+     /// @param[in] shape shape of the region
+     void setRegion(const std::string &image, const std::string &format, const casacore::IPosition &blc,
+                    const casacore::IPosition &shape);
+
+     /// @brief add the number of bytes transferred
+     /// @param[in] bytes number of bytes
+     inline void addBytes(size_t bytes) { itsEvent.itsBytes += bytes; }
+
+  private:
+     /// @brief true, if the recording was enabled at construction
+     bool itsActive;
+
+     /// @brief time of construction
+     boost::chrono::steady_clock::time_point itsStart;
+
+     /// @brief event being recorded
+     Event itsEvent;
+  };
+
+  /// @brief check whether the events are recorded
+  /// @return true, if the recording is on
+  static inline bool enabled() { return theirEnabled.load(std::memory_order_relaxed); }
+
+  /// @brief start recording into the given file
+  /// @details The file is overwritten. If the recording is already on, the current trace
+  /// is finished first.
+  /// @param[in] fname name of the trace file ("%p" is replaced by the process id)
+  /// @throw AskapError if the file can't be opened
+  static void start(const std::string &fname);
+
+  /// @brief stop recording
+  /// @details The buffered events are written and the file is closed. Nothing is done if
+  /// the recording is off.
+  static void stop();
+
+  /// @return number of events recorded since the last start
+  static size_t eventsRecorded();
+
+  /// @brief record an event
+  /// @details Nothing is done if the recording is off. The thread index is assigned here.
+  /// @param[in] event event to record
+  static void record(const Event &event);
+
+  /// @brief read a trace
+  /// @param[in] fname name of the trace file
+  /// @return events in the order they have been recorded
+  /// @throw AskapError if the file is not a valid trace
+  static std::vector<Event> readTrace(const std::string &fname);
+
+  /// @brief name of the event type
+  /// @param[in] type type of the event
+  /// @return name in lower case (e.g. table_read)
+  static std::string typeName(EventType type);
+
+private:
+  /// @brief true, if the events are recorded
+  static std::atomic<bool> theirEnabled;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IO_RECORDER_H
@@ -0,0 +1,200 @@
+/// @file
+///
+/// @brief Thread pool shared by asynchronous accessor operations
+/// @details Tasks are kept in a single queue served by all threads of the pool.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/IOThreadPool.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <algorithm>
+#include <cstdlib>
+
+ASKAP_LOGGER(logger, ".IOThreadPool");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief number of threads of the shared pool
+/// @details The ASKAP_ACCESSORS_IO_THREADS environment variable overrides the number of CPUs
+/// @return number of threads
+size_t defaultNThreads()
+{
+  const char *value = std::getenv("ASKAP_ACCESSORS_IO_THREADS");
+  const int nThreads = value != NULL ? std::atoi(value) : static_cast<int>(boost::thread::hardware_concurrency());
+  return static_cast<size_t>(std::max(1, nThreads));
+}
+
+} // anonymous namespace
+
+/// @brief constructor
+/// @param[in] pool pool executing the tasks
+IOThreadPool::Strand::State::State(IOThreadPool &pool) : itsPool(pool), itsRunning(false) {}
+
+/// @brief set up the strand
+/// @param[in] pool pool executing the tasks
+IOThreadPool::Strand::Strand(IOThreadPool &pool) : itsState(new State(pool)) {}
+
+/// @brief add a task to the queue
+/// @param[in] task task to execute
+void IOThreadPool::Strand::post(const boost::function<void()> &task)
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsState->itsMutex);
+    itsState->itsTasks.push_back(task);
+    if (itsState->itsRunning) {
+        return;
+    }
+    itsState->itsRunning = true;
+  }
+  itsState->itsPool.post(boost::bind(&IOThreadPool::Strand::runNext, itsState));
+}
+
+/// @brief execute the first task and pass the rest to the pool again
+/// @details The remaining tasks are queued behind the tasks of other strands, so a busy
+/// strand doesn't occupy a thread of the pool.
+/// @param[in] state state of the strand
+void IOThreadPool::Strand::runNext(const boost::shared_ptr<State> &state)
+{
+  boost::function<void()> task;
+  {
+    boost::lock_guard<boost::mutex> lock(state->itsMutex);
+    ASKAPDEBUGASSERT(state->itsTasks.size() > 0);
+    task = state->itsTasks.front();
+    state->itsTasks.pop_front();
+  }
+  task();
+  {
+    boost::lock_guard<boost::mutex> lock(state->itsMutex);
+    if (state->itsTasks.empty()) {
+        state->itsRunning = false;
+        return;
+    }
+  }
+  state->itsPool.post(boost::bind(&IOThreadPool::Strand::runNext, state));
+}
+
+/// @brief start the threads
+/// @param[in] nThreads number of threads, should be positive
+/// @param[in] affinity placement policy for the threads (resolved in the calling thread)
+IOThreadPool::IOThreadPool(size_t nThreads, const ThreadAffinity &affinity) :
+      itsAffinity(affinity.resolve()), itsTasksCompleted(0), itsStopRequested(false)
+{
+  ASKAPCHECK(nThreads > 0, "IOThreadPool should have at least one thread");
+  for (size_t thread = 0; thread < nThreads; ++thread) {
+       itsThreads.push_back(boost::shared_ptr<boost::thread>(new boost::thread(boost::bind(&IOThreadPool::run, this))));
+  }
+}
+
+/// @brief destructor, completes the queued tasks and stops the threads
+IOThreadPool::~IOThreadPool()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsStopRequested = true;
+  }
+  itsTaskQueued.notify_all();
+  for (std::vector<boost::shared_ptr<boost::thread> >::const_iterator ci = itsThreads.begin();
+       ci != itsThreads.end(); ++ci) {
+       (*ci)->join();
+  }
+}
+
+/// @brief add a task to the queue
+/// @details The task shouldn't throw, use submit to obtain the result or the error.
+/// @param[in] task task to execute
+void IOThreadPool::post(const boost::function<void()> &task)
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsTasks.push_back(task);
+  }
+  itsTaskQueued.notify_one();
+}
+
+/// @return number of tasks waiting for a thread
+size_t IOThreadPool::pendingTasks() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsTasks.size();
+}
+
+/// @return number of tasks completed so far
+size_t IOThreadPool::tasksCompleted() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsTasksCompleted;
+}
+
+/// @brief pool shared by the asynchronous operations
+/// @details The pool is created at the first call.
+/// @return reference to the shared pool
+IOThreadPool& IOThreadPool::shared()
+{
+  static IOThreadPool pool(defaultNThreads());
+  return pool;
+}
+
+/// @brief body of the threads
+/// @details The queue is drained before the threads stop.
+void IOThreadPool::run()
+{
+  itsAffinity.apply("I/O pool");
+  while (true) {
+     boost::function<void()> task;
+     {
+       boost::unique_lock<boost::mutex> lock(itsMutex);
+       while (itsTasks.empty() && !itsStopRequested) {
+              itsTaskQueued.wait(lock);
+       }
+       if (itsTasks.empty()) {
+           break;
+       }
+       task = itsTasks.front();
+       itsTasks.pop_front();
+     }
+     try {
+        task();
+     }
+     catch (const std::exception &ex) {
+        ASKAPLOG_ERROR_STR(logger, "Task executed by the I/O thread pool has failed: "<<ex.what());
+     }
+     catch (...) {
+        ASKAPLOG_ERROR_STR(logger, "Task executed by the I/O thread pool has failed with unknown exception");
+     }
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     ++itsTasksCompleted;
+  }
+}
@@ -0,0 +1,204 @@
+/// @file
+///
+/// @brief Thread pool shared by asynchronous accessor operations
+/// @details Asynchronous reads of measurement sets, images and calibration tables
+/// are executed by a small pool of threads instead of one thread per stream. Operations
+/// on the same non-thread-safe object are serialised with a strand.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_IO_THREAD_POOL_H
+#define ASKAP_ACCESSORS_IO_THREAD_POOL_H
+
+// own includes
+#include <askap/dataaccess/ThreadAffinity.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <deque>
+#include <future>
+#include <type_traits>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Thread pool shared by asynchronous accessor operations
+/// @details Tasks are executed in the order of submission by the first idle thread.
+/// The result (or the exception thrown by the task) is delivered through std::future,
+/// so the caller can keep many operations outstanding and wait for them when the data
+/// are needed. Tasks working with objects which are not thread-safe (e.g. an iterator
+/// or a table-based accessor) should be submitted through a Strand, which runs them one
+/// at a time without dedicating a thread to the object.
+///
+/// The shared pool (see shared) has the number of threads given by the
+/// ASKAP_ACCESSORS_IO_THREADS environment variable, or the number of CPUs by default.
+/// @ingroup dataaccess_hlp
+class IOThreadPool : public boost::noncopyable {
+public:
+  /// @brief serial queue of tasks executed by the pool
+  /// @details Tasks submitted through the same strand are executed in order, one at a time,
+  /// by any thread of the pool. The strand can be destroyed while tasks are outstanding,
+  /// they are completed anyway. The pool should outlive its strands.
+  class Strand {
+  public:
+    /// @brief set up the strand
+    /// @param[in] pool pool executing the tasks
+    explicit Strand(IOThreadPool &pool);
+
+    /// @brief submit the task
+    /// @param[in] task functor to execute
+    /// @return future with the result of the task
+    template<typename F>
+    std::future<typename std::result_of<F()>::type> submit(F task);
+
+  private:
+    /// @brief state shared with the tasks in flight
+    struct State : public boost::noncopyable {
+       /// @brief constructor
+       /// @param[in] pool pool executing the tasks
+       explicit State(IOThreadPool &pool);
+       /// @brief pool executing the tasks
+       IOThreadPool &itsPool;
+       /// @brief tasks waiting for the previous ones to finish
+       std::deque<boost::function<void()> > itsTasks;
+       /// @brief true if a task of this strand has been passed to the pool
+       bool itsRunning;
+       /// @brief synchronisation lock
+       boost::mutex itsMutex;
+    };
+
+    /// @brief add a task to the queue
+    /// @param[in] task task to execute
+    void post(const boost::function<void()> &task);
+
+    /// @brief execute the first task and pass the rest to the pool again
+    /// @param[in] state state of the strand
+    static void runNext(const boost::shared_ptr<State> &state);
+
+    /// @brief state shared with the tasks in flight
+    boost::shared_ptr<State> itsState;
+  };
+
+  /// @brief start the threads
+  /// @param[in] nThreads number of threads, should be positive
+  /// @param[in] affinity placement policy for the threads (resolved in the calling thread)
+  explicit IOThreadPool(size_t nThreads, const ThreadAffinity &affinity = ThreadAffinity());
+
+  /// @brief destructor, completes the queued tasks and stops the threads
+  ~IOThreadPool();
+
+  /// @brief submit the task
+  /// @param[in] task functor to execute
+  /// @return future with the result of the task
+  template<typename F>
+  std::future<typename std::result_of<F()>::type> submit(F task);
+
+  /// @brief add a task to the queue
+  /// @details The task shouldn't throw, use submit to obtain the result or the error.
+  /// @param[in] task task to execute
+  void post(const boost::function<void()> &task);
+
+  /// @return number of threads
+  inline size_t nThreads() const { return itsThreads.size(); }
+
+  /// @return number of tasks waiting for a thread
+  size_t pendingTasks() const;
+
+  /// @return number of tasks completed so far
+  size_t tasksCompleted() const;
+
+  /// @brief pool shared by the asynchronous operations
+  /// @details The pool is created at the first call.
+  /// @return reference to the shared pool
+  static IOThreadPool& shared();
+
+private:
+  /// @brief body of the threads
+  void run();
+
+  /// @brief placement policy for the threads
+  ThreadAffinity itsAffinity;
+
+  /// @brief tasks waiting for a thread
+  std::deque<boost::function<void()> > itsTasks;
+
+  /// @brief number of tasks completed so far
+  size_t itsTasksCompleted;
+
+  /// @brief true if the threads are asked to stop
+  bool itsStopRequested;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+
+  /// @brief signalled when a task is queued or the threads are asked to stop
+  boost::condition_variable itsTaskQueued;
+
+  /// @brief threads of the pool
+  std::vector<boost::shared_ptr<boost::thread> > itsThreads;
+};
+
+/// @brief submit the task
+/// @param[in] task functor to execute
+/// @return future with the result of the task
+template<typename F>
+std::future<typename std::result_of<F()>::type> IOThreadPool::submit(F task)
+{
+  typedef typename std::result_of<F()>::type Result;
+  const boost::shared_ptr<std::packaged_task<Result()> > packaged(new std::packaged_task<Result()>(task));
+  std::future<Result> result = packaged->get_future();
+  post(boost::bind(&std::packaged_task<Result()>::operator(), packaged));
+  return result;
+}
+
+/// @brief submit the task
+/// @param[in] task functor to execute
+/// @return future with the result of the task
+template<typename F>
+std::future<typename std::result_of<F()>::type> IOThreadPool::Strand::submit(F task)
+{
+  typedef typename std::result_of<F()>::type Result;
+  const boost::shared_ptr<std::packaged_task<Result()> > packaged(new std::packaged_task<Result()>(task));
+  std::future<Result> result = packaged->get_future();
+  post(boost::bind(&std::packaged_task<Result()>::operator(), packaged));
+  return result;
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IO_THREAD_POOL_H
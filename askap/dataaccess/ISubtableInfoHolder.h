@@ -49,6 +49,9 @@
 #include <askap/dataaccess/IFieldSubtableHandler.h>
 #include <askap/dataaccess/IAntennaSubtableHandler.h>
 #include <askap/dataaccess/ITablePolarisationHolder.h>
+#include <askap/dataaccess/ITableRowIndex.h>
+#include <askap/dataaccess/TableSelectionCache.h>
+#include <askap/dataaccess/AntennaDirectionCache.h>
 
 namespace askap {
 
@@ -70,6 +73,27 @@ namespace accessors {
 /// @ingroup dataaccess_tm
 struct ISubtableInfoHolder : virtual public IHolder {
 
+   /// @brief handlers which can be preloaded
+   /// @details The values are bit flags, they can be combined with the bitwise or.
+   enum Subtables {
+      /// @brief ANTENNA subtable
+      ANTENNA = 1,
+      /// @brief FEED subtable
+      FEED = 2,
+      /// @brief FIELD subtable
+      FIELD = 4,
+      /// @brief SPECTRAL_WINDOW subtable
+      SPECTRAL_WINDOW = 8,
+      /// @brief POLARIZATION subtable
+      POLARIZATION = 16,
+      /// @brief DATA_DESCRIPTION subtable
+      DATA_DESCRIPTION = 32,
+      /// @brief row index of the main table
+      ROW_INDEX = 64,
+      /// @brief all of the above
+      ALL_SUBTABLES = 127
+   };
+
    /// @return a reference to the handler of the DATA_DESCRIPTION subtable
    virtual const ITableDataDescHolder& getDataDescription() const = 0;
 
@@ -90,6 +114,20 @@ struct ISubtableInfoHolder : virtual public IHolder {
 
    /// @return a reference to the handler of the ANTENNA subtable
    virtual const IAntennaSubtableHandler& getAntenna() const = 0;
+
+   /// @return a reference to the row index of the main table
+   virtual const ITableRowIndex& getRowIndex() const = 0;
+
+   /// @return a reference to the cache of table selections
+   virtual const TableSelectionCache& getSelectionCache() const = 0;
+
+   /// @return a reference to the cache of parallactic angles and dish pointings
+   virtual const AntennaDirectionCache& getDirectionCache() const = 0;
+
+   /// @brief construct the given handlers now
+   /// @details Handlers which already exist are not affected.
+   /// @param[in] subtables handlers to construct (bitwise combination of Subtables values)
+   virtual void preload(casacore::uInt subtables) const = 0;
 };
 
 
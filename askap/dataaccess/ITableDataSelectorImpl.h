@@ -41,6 +41,8 @@
 
 // casa includes
 #include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/measures/Measures/Stokes.h>
 
 // own includes
 #include <askap/dataaccess/IDataConverterImpl.h>
@@ -49,6 +51,7 @@
 // std includes
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace askap {
 
@@ -79,6 +82,26 @@ public:
   virtual const casacore::TableExprNode& getTableSelector(const
                boost::shared_ptr<IDataConverterImpl const> &conv) const = 0;
 
+  /// @brief check whether a row-based selection has been done
+  /// @details Selection on antennas, feeds and spectral windows is resolved
+  /// via the row index into a list of rows. The result is combined with
+  /// the expression node returned by getTableSelector (logical and).
+  /// @return true, if the selection is restricted to a list of rows
+  virtual bool rowsSelected() const throw() = 0;
+
+  /// @brief obtain row-based selection
+  /// @details This method is only valid if rowsSelected returns true.
+  /// @return sorted vector with row numbers in the main table
+  virtual const std::vector<casacore::rownr_t>& getRowSelection() const = 0;
+
+  /// @brief obtain canonical form of the selection
+  /// @details Selectors with the same key select the same rows, regardless of
+  /// the order in which the selection methods were called. This is used to cache
+  /// selections (see TableSelectionCache). The key is only complete after
+  /// getTableSelector has been called, because the time range requires the converter.
+  /// @return string describing the selection, empty string if no selection is done
+  virtual std::string getSelectionKey() const = 0;
+
   /// @brief choose data column
   /// @details This method allows to choose any table column as the visibility
   /// data column (e.g. DATA, CORRECTED_DATA, etc). Because this is a
@@ -127,14 +150,38 @@ public:
   /// which is probably a prefered way to do this check to retain the code clarity.
   /// @return a pair, the first element gives the number of channels selected and
   /// the second element gives the start channel (0-based)
+  /// @note The number of channels is that delivered by the accessor, i.e. after averaging
+  /// (see getChannelAveraging).
   virtual std::pair<int,int> getChannelSelection() const throw() = 0;
 
+  /// @brief obtain the number of adjacent channels to average
+  /// @details This is the nAvg parameter of chooseChannels, 1 means no averaging.
+  /// @return number of input channels per output channel
+  virtual casacore::uInt getChannelAveraging() const throw() = 0;
+
   /// @brief obtain frequency selection
   /// @details By default all channels are selected. However, if chooseFrequencies
   /// has been called, less channels are returned by the accessor. This method
   /// returns the number of channels, the start frequency and the increment (Hz)
   virtual std::tuple<int,casacore::MFrequency,double> getFrequencySelection() const throw() = 0;
 
+  /// @brief check whether polarisation selection has been done
+  /// @details By default all polarisation products stored in the dataset are returned.
+  /// If choosePolarizations has been called, only the requested products are returned.
+  /// @return true, if a subset of polarisation products has been selected
+  virtual bool polarizationsSelected() const throw() = 0;
+
+  /// @brief obtain polarisation selection
+  /// @details This method is only meaningful if polarizationsSelected returns true.
+  /// @return vector with the polarisation products requested (in the order requested)
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& getPolarizationSelection() const throw() = 0;
+
+  /// @brief obtain the subset of accessor fields declared as used
+  /// @details By default all fields are declared. However, if chooseAccessorFields
+  /// has been called, only some fields are allowed to be accessed.
+  /// @return bitwise combination of IDataSelector::AccessorFields values
+  virtual casacore::uInt getAccessorFields() const throw() = 0;
+
 };
 
 } // namespace accessors
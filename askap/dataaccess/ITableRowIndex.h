@@ -0,0 +1,125 @@
+/// @file
+/// @brief An interface to the row index of the main table
+/// @details A class derived from this interface provides row numbers of the
+/// main table for a given combination of antennas, feeds and data description ID.
+/// It also allows to find the range of rows for a time interval if the table is
+/// time-ordered. This allows selectors to avoid evaluation of a table expression over
+/// the whole measurement set.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_I_TABLE_ROW_INDEX_H
+#define ASKAP_ACCESSORS_I_TABLE_ROW_INDEX_H
+
+// std includes
+#include <vector>
+#include <utility>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+
+// own includes
+#include <askap/dataaccess/IHolder.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief An interface to the row index of the main table
+/// @details All methods return row numbers sorted in the ascending order, so the
+/// table built from them preserves the original order of rows (i.e. time order).
+/// @ingroup dataaccess_tab
+struct ITableRowIndex : virtual public IHolder {
+
+  /// @brief obtain rows for a single baseline
+  /// @param[in] ant1 the first antenna
+  /// @param[in] ant2 the second antenna
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> baselineRows(casacore::uInt ant1,
+                                                      casacore::uInt ant2) const = 0;
+
+  /// @brief obtain rows for all baselines to the given antenna
+  /// @param[in] ant antenna index
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> antennaRows(casacore::uInt ant) const = 0;
+
+  /// @brief obtain rows for a group of baselines
+  /// @param[in] baselines pairs of the first and the second antenna
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> baselineGroupRows(
+          const std::vector<std::pair<casacore::uInt, casacore::uInt> > &baselines) const = 0;
+
+  /// @brief obtain rows for the given feed (the same for both antennas)
+  /// @param[in] feed feed index
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> feedRows(casacore::uInt feed) const = 0;
+
+  /// @brief obtain rows for the given data description IDs
+  /// @param[in] dataDescIDs data description IDs of interest
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> dataDescRows(const std::vector<size_t> &dataDescIDs) const = 0;
+
+  /// @brief obtain rows with auto-correlations
+  /// @details The same antenna and the same feed
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> autoCorrelationRows() const = 0;
+
+  /// @brief obtain rows with cross-correlations
+  /// @details Different antennas or different feeds
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> crossCorrelationRows() const = 0;
+
+  /// @brief check whether the table is ordered in time
+  /// @return true, if TIME never decreases with the row number
+  virtual bool timeOrdered() const = 0;
+
+  /// @brief obtain rows for a time interval
+  /// @details This method is only valid for time-ordered tables (see timeOrdered).
+  /// Time is given in the same frame and units as the TIME column, the interval
+  /// is open at both ends (the same as the table expression used otherwise).
+  /// @param[in] start start of the interval
+  /// @param[in] stop end of the interval
+  /// @return the first row and one past the last row in the interval
+  virtual std::pair<casacore::rownr_t, casacore::rownr_t> timeRange(casacore::Double start,
+                                                                   casacore::Double stop) const = 0;
+
+  /// @brief obtain rows for a range of uv-distances
+  /// @details The uv-distance is sqrt(u^2+v^2) in the units of the UVW column. Rows
+  /// where UVW is not a vector of at least two elements are never selected.
+  /// @param[in] minDist minimum uv-distance (inclusive)
+  /// @param[in] maxDist maximum uv-distance (inclusive)
+  /// @param[in] keepZero if true, rows with all uvw components exactly zero are selected
+  /// regardless of the range
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> uvDistanceRows(casacore::Double minDist, casacore::Double maxDist,
+                                                        bool keepZero) const = 0;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_I_TABLE_ROW_INDEX_H
@@ -0,0 +1,110 @@
+/// @file
+///
+/// @brief Rate-limited logging for the hot paths of the accessors
+/// @details This file provides a limiter which lets through at most one message
+/// per call site in the given time interval.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/LogRateLimiter.h>
+
+// boost includes
+#include <boost/chrono.hpp>
+
+// std includes
+#include <cstdlib>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief initial interval between messages
+/// @return value of ASKAP_ACCESSORS_LOG_INTERVAL environment variable converted to
+/// nanoseconds, 1 second if the variable is not set
+long long intervalFromEnvironment()
+{
+  const char *value = std::getenv("ASKAP_ACCESSORS_LOG_INTERVAL");
+  const double seconds = value != NULL ? std::atof(value) : 1.;
+  return static_cast<long long>(seconds * 1e9);
+}
+
+/// @return current time of the steady clock in nanoseconds
+long long now()
+{
+  return boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+         boost::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+/// @brief minimum interval between messages in nanoseconds
+std::atomic<long long> LogRateLimiter::theirInterval(intervalFromEnvironment());
+
+/// @brief initialise the limiter, the first message will be let through
+LogRateLimiter::LogRateLimiter() : itsLast(0), itsFirst(true), itsSuppressed(0) {}
+
+/// @brief check whether a message can be logged now
+/// @param[out] suppressed number of messages suppressed since the last one let through
+///             (only set if true is returned)
+/// @return true, if the message should be logged
+bool LogRateLimiter::allow(size_t &suppressed)
+{
+  const long long interval = theirInterval.load(std::memory_order_relaxed);
+  if (interval < 0) {
+      return false;
+  }
+  if (interval > 0) {
+      const long long time = now();
+      long long last = itsLast.load(std::memory_order_relaxed);
+      if (!itsFirst.load(std::memory_order_relaxed) && time - last < interval) {
+          itsSuppressed.fetch_add(1, std::memory_order_relaxed);
+          return false;
+      }
+      // only one of the threads arriving at the same time logs the message
+      if (!itsLast.compare_exchange_strong(last, time, std::memory_order_relaxed)) {
+          itsSuppressed.fetch_add(1, std::memory_order_relaxed);
+          return false;
+      }
+  }
+  itsFirst.store(false, std::memory_order_relaxed);
+  suppressed = itsSuppressed.exchange(0, std::memory_order_relaxed);
+  return true;
+}
+
+/// @brief set the minimum interval between messages of the same call site
+/// @param[in] seconds interval in seconds, zero to log all messages, negative to log none
+void LogRateLimiter::setInterval(double seconds)
+{
+  theirInterval.store(static_cast<long long>(seconds * 1e9));
+}
+
+/// @return the minimum interval between messages of the same call site in seconds
+double LogRateLimiter::interval()
+{
+  return 1e-9 * theirInterval.load();
+}
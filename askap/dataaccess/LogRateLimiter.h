@@ -0,0 +1,121 @@
+/// @file
+///
+/// @brief Rate-limited logging for the hot paths of the accessors
+/// @details Image slices, calibration solutions and visibility chunks can be
+/// requested millions of times per run. Logging each such call (including the
+/// formatting of the message) easily costs more than the access itself. This file
+/// provides a limiter which lets through at most one message per call site in the
+/// given time interval and a macro to log through it. The number and size of the
+/// calls are available from DataAccessStatistics instead.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_LOG_RATE_LIMITER_H
+#define ASKAP_ACCESSORS_LOG_RATE_LIMITER_H
+
+// boost includes
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <atomic>
+#include <cstddef>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Limiter of the message rate for a single call site
+/// @details Each call site has its own static instance (see ASKAPLOG_HOTPATH_STR). The first
+/// message is always let through, the following ones only if the given interval has passed
+/// since the last message which has been let through. The number of suppressed messages is
+/// returned with the next message let through, so it can be appended to the log entry.
+/// The interval is common to all call sites, it is 1 second by default and can be changed
+/// with setInterval or by setting the ASKAP_ACCESSORS_LOG_INTERVAL environment variable
+/// (in seconds). A zero interval lets all messages through, a negative one suppresses all.
+/// All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class LogRateLimiter : public boost::noncopyable {
+public:
+  /// @brief initialise the limiter, the first message will be let through
+  LogRateLimiter();
+
+  /// @brief check whether a message can be logged now
+  /// @param[out] suppressed number of messages suppressed since the last one let through
+  ///             (only set if true is returned)
+  /// @return true, if the message should be logged
+  bool allow(size_t &suppressed);
+
+  /// @brief set the minimum interval between messages of the same call site
+  /// @param[in] seconds interval in seconds, zero to log all messages, negative to log none
+  static void setInterval(double seconds);
+
+  /// @return the minimum interval between messages of the same call site in seconds
+  static double interval();
+
+private:
+  /// @brief time of the last message let through (in nanoseconds of the steady clock)
+  std::atomic<long long> itsLast;
+
+  /// @brief true, if no message has been let through yet
+  std::atomic<bool> itsFirst;
+
+  /// @brief number of messages suppressed since the last one let through
+  std::atomic<size_t> itsSuppressed;
+
+  /// @brief minimum interval between messages in nanoseconds
+  static std::atomic<long long> theirInterval;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+/// @brief log a message from a hot path of the accessors
+/// @details The message is logged at the DEBUG level via the rate limiter of this call
+/// site, the message is not formatted if it is suppressed. If the library is built without
+/// the ASKAP_ACCESSORS_HOTPATH_LOG preprocessor definition (see the ENABLE_ACCESSORS_HOTPATH_LOG
+/// option of cmake), the macro expands to nothing.
+/// @param[in] logger logger to use
+/// @param[in] message message, can be a chain of operator<< as for ASKAPLOG_DEBUG_STR
+#ifdef ASKAP_ACCESSORS_HOTPATH_LOG
+#define ASKAPLOG_HOTPATH_STR(logger, message) \
+  do { \
+     static ::askap::accessors::LogRateLimiter askapHotPathLimiter; \
+     size_t askapHotPathSuppressed = 0; \
+     if (askapHotPathLimiter.allow(askapHotPathSuppressed)) { \
+         if (askapHotPathSuppressed > 0) { \
+             ASKAPLOG_DEBUG_STR(logger, message << " (" << askapHotPathSuppressed << \
+                                " similar message(s) suppressed)"); \
+         } else { \
+             ASKAPLOG_DEBUG_STR(logger, message); \
+         } \
+     } \
+  } while (false)
+#else
+#define ASKAPLOG_HOTPATH_STR(logger, message) do {} while (false)
+#endif
+
+#endif // #ifndef ASKAP_ACCESSORS_LOG_RATE_LIMITER_H
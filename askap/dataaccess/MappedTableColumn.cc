@@ -0,0 +1,239 @@
+/// @file
+///
+/// @brief Read-only memory map of a tiled array column
+/// @details Visibilities and flags stored with one of the tiled storage managers
+/// without any compression occupy a single file with a simple layout. This class
+/// validates the layout and maps the file into memory.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/MappedTableColumn.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/casa/OS/HostInfo.h>
+
+// system includes
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".MappedTableColumn");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief map the column into memory
+/// @details No exception is thrown if the layout is unsupported, use isValid
+/// to check whether the map can be used.
+/// @param[in] ms measurement set (should be a plain table)
+/// @param[in] column name of the column to map (e.g. DATA or FLAG)
+MappedTableColumn::MappedTableColumn(const casacore::Table &ms, const std::string &column) :
+       itsColumnName(column), itsIsBool(false), itsNPol(0), itsNChan(0), itsNRow(0),
+       itsRowsPerTile(0), itsTileSize(0), itsData(0), itsSize(0)
+{
+  itsReason = init(ms);
+  if (isValid()) {
+      ASKAPLOG_DEBUG_STR(logger, "Column "<<column<<" of "<<ms.tableName()<<" is mapped into memory, "<<
+                  itsSize<<" bytes, "<<itsRowsPerTile<<" row(s) per tile");
+  } else {
+      ASKAPLOG_INFO_STR(logger, "Column "<<column<<" of "<<ms.tableName()<<
+                  " will be read via the table system: "<<itsReason);
+  }
+}
+
+/// @brief destructor, unmaps the file
+MappedTableColumn::~MappedTableColumn()
+{
+  if (itsData != 0) {
+      munmap(const_cast<char*>(itsData), itsSize);
+  }
+}
+
+/// @brief check the layout and map the file
+/// @param[in] ms measurement set
+/// @return empty string on success, or a reason why the column can't be mapped
+std::string MappedTableColumn::init(const casacore::Table &ms)
+{
+  if (ms.tableType() != casacore::Table::Plain) {
+      return "the table is not a plain table";
+  }
+  if (!ms.tableDesc().isColumn(itsColumnName)) {
+      return "the column doesn't exist";
+  }
+  const casacore::ColumnDesc &desc = ms.tableDesc().columnDesc(itsColumnName);
+  if (!desc.isArray()) {
+      return "the column is not an array column";
+  }
+  if (desc.dataType() == casacore::TpBool) {
+      itsIsBool = true;
+  } else if (desc.dataType() != casacore::TpComplex) {
+      return "unsupported data type";
+  }
+  // bits are stored the same way regardless of the byte order
+  if (!itsIsBool && ((ms.endianFormat() == casacore::Table::BigEndian) != casacore::HostInfo::bigEndian())) {
+      return "the table is not stored in the native byte order";
+  }
+  const casacore::DataManager *dm = ms.findDataManager(itsColumnName, casacore::True);
+  ASKAPDEBUGASSERT(dm);
+  const std::string dmType = dm->dataManagerType();
+  if (dmType.compare(0, 5, "Tiled") != 0) {
+      return "the column is stored with "+dmType+" rather than a tiled storage manager";
+  }
+  if (dm->ncolumn() != 1) {
+      return "the storage manager holds other columns as well";
+  }
+  const casacore::ROTiledStManAccessor accessor(ms, itsColumnName, casacore::True);
+  if (accessor.nhypercubes() != 1) {
+      return "the storage manager has more than one hypercube";
+  }
+  const casacore::IPosition cubeShape = accessor.hypercubeShape(0);
+  const casacore::IPosition tileShape = accessor.tileShape(0);
+  if ((cubeShape.nelements() != 3) || (tileShape.nelements() != 3)) {
+      return "the cells are not two-dimensional";
+  }
+  if ((tileShape[0] != cubeShape[0]) || (tileShape[1] != cubeShape[1])) {
+      return "the tiles don't cover whole cells";
+  }
+  itsNPol = cubeShape[0];
+  itsNChan = cubeShape[1];
+  itsNRow = ms.nrow();
+  itsRowsPerTile = tileShape[2];
+  if ((itsNRow == 0) || (itsRowsPerTile == 0) || (casacore::rownr_t(cubeShape[2]) < itsNRow)) {
+      return "the hypercube doesn't cover the table";
+  }
+  const size_t elementsPerTile = size_t(itsNPol) * itsNChan * itsRowsPerTile;
+  itsTileSize = itsIsBool ? (elementsPerTile + 7) / 8 : elementsPerTile * sizeof(casacore::Complex);
+  const size_t nTiles = (size_t(cubeShape[2]) + itsRowsPerTile - 1) / itsRowsPerTile;
+
+  const std::string fname = dm->fileName() + "_TSM0";
+  const int fd = open(fname.c_str(), O_RDONLY);
+  if (fd < 0) {
+      return "unable to open "+fname;
+  }
+  struct stat info;
+  if ((fstat(fd, &info) != 0) || (size_t(info.st_size) != nTiles * itsTileSize)) {
+      close(fd);
+      return "the size of "+fname+" doesn't match the hypercube";
+  }
+  void *addr = mmap(0, nTiles * itsTileSize, PROT_READ, MAP_SHARED, fd, 0);
+  // the mapping stays valid after the file is closed
+  close(fd);
+  if (addr == MAP_FAILED) {
+      return "unable to map "+fname+" into memory";
+  }
+  itsData = static_cast<const char*>(addr);
+  itsSize = nTiles * itsTileSize;
+  return std::string();
+}
+
+/// @brief check that the rows and channels requested are within the column
+/// @param[in] rows row numbers in the mapped table
+/// @param[in] startChan first channel to read
+/// @param[in] nChan number of channels to read
+void MappedTableColumn::checkRequest(const casacore::Vector<casacore::rownr_t> &rows,
+                   casacore::uInt startChan, casacore::uInt nChan) const
+{
+  ASKAPCHECK(isValid(), "Column "<<itsColumnName<<" is not mapped into memory: "<<itsReason);
+  if (startChan + nChan > itsNChan) {
+      ASKAPTHROW(DataAccessError, "Channels "<<startChan<<" to "<<startChan + nChan<<
+                 " are requested, but column "<<itsColumnName<<" has only "<<itsNChan<<" channels");
+  }
+  for (casacore::uInt row = 0; row < rows.nelements(); ++row) {
+       if (rows[row] >= itsNRow) {
+           ASKAPTHROW(DataAccessError, "Row "<<rows[row]<<" is requested, but the table has only "<<
+                      itsNRow<<" rows");
+       }
+  }
+}
+
+/// @brief read visibilities for the given rows
+/// @details The data are transposed into the accessor layout straight from the
+/// mapped pages. This method is only valid for complex columns.
+/// @param[in] rows row numbers in the mapped table
+/// @param[in] startChan first channel to read
+/// @param[in] nChan number of channels to read
+/// @param[out] cube nRow x nChan x nPol cube to fill (resized as necessary)
+void MappedTableColumn::read(const casacore::Vector<casacore::rownr_t> &rows, casacore::uInt startChan,
+            casacore::uInt nChan, casacore::Cube<casacore::Complex> &cube) const
+{
+  ASKAPCHECK(!itsIsBool, "Column "<<itsColumnName<<" is not a complex column");
+  checkRequest(rows, startChan, nChan);
+  const casacore::uInt nRows = rows.nelements();
+  cube.resize(nRows, nChan, itsNPol);
+  ASKAPDEBUGASSERT(cube.contiguousStorage());
+  casacore::Complex* dst = cube.data();
+  const size_t planeSize = size_t(nRows) * nChan;
+  const size_t rowSize = size_t(itsNPol) * itsNChan;
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       const casacore::rownr_t tableRow = rows[row];
+       const casacore::Complex *src = reinterpret_cast<const casacore::Complex*>(itsData +
+                 (tableRow / itsRowsPerTile) * itsTileSize) + (tableRow % itsRowsPerTile) * rowSize +
+                 size_t(startChan) * itsNPol;
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            casacore::Complex* dstElem = dst + row + size_t(nRows) * chan;
+            for (casacore::uInt pol = 0; pol < itsNPol; ++pol, ++src) {
+                 dstElem[planeSize * pol] = *src;
+            }
+       }
+  }
+}
+
+/// @brief read flags for the given rows
+/// @details This method is only valid for boolean columns.
+/// @param[in] rows row numbers in the mapped table
+/// @param[in] startChan first channel to read
+/// @param[in] nChan number of channels to read
+/// @param[out] cube nRow x nChan x nPol cube to fill (resized as necessary)
+void MappedTableColumn::read(const casacore::Vector<casacore::rownr_t> &rows, casacore::uInt startChan,
+            casacore::uInt nChan, casacore::Cube<casacore::Bool> &cube) const
+{
+  ASKAPCHECK(itsIsBool, "Column "<<itsColumnName<<" is not a boolean column");
+  checkRequest(rows, startChan, nChan);
+  const casacore::uInt nRows = rows.nelements();
+  cube.resize(nRows, nChan, itsNPol);
+  const size_t rowSize = size_t(itsNPol) * itsNChan;
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       const casacore::rownr_t tableRow = rows[row];
+       // bits are packed separately for each tile, the lowest bit first
+       const unsigned char *tile = reinterpret_cast<const unsigned char*>(itsData +
+                 (tableRow / itsRowsPerTile) * itsTileSize);
+       size_t bit = (tableRow % itsRowsPerTile) * rowSize + size_t(startChan) * itsNPol;
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            for (casacore::uInt pol = 0; pol < itsNPol; ++pol, ++bit) {
+                 cube(row, chan, pol) = (tile[bit / 8] & (1 << (bit % 8))) != 0;
+            }
+       }
+  }
+}
@@ -0,0 +1,161 @@
+/// @file
+///
+/// @brief Read-only memory map of a tiled array column
+/// @details Visibilities and flags stored with one of the tiled storage managers
+/// without any compression occupy a single file with a simple layout. This class
+/// validates the layout and maps the file into memory, so the data can be read
+/// from the OS page cache bypassing the bucket cache of the table system.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_MAPPED_TABLE_COLUMN_H
+#define ASKAP_ACCESSORS_MAPPED_TABLE_COLUMN_H
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Read-only memory map of a tiled array column
+/// @details The following layout is supported: the column is the only column
+/// of a tiled storage manager (e.g. TiledColumnStMan or TiledShapeStMan) with a
+/// single hypercube, each tile covers whole cells (i.e. all polarisations and
+/// channels of a number of rows) and the table is stored in the native byte order.
+/// The data file then consists of tiles stored one after another in the row order.
+/// Complex values are stored as is, Bool values are packed into bits separately
+/// for each tile. All other layouts (e.g. StandardStMan, which interleaves columns
+/// in buckets, or storage managers with compression) are reported as unsupported,
+/// so the caller can revert to the table system.
+///
+/// The table is expected not to be modified while the map exists. The object
+/// doesn't change after construction, so it can be shared between threads.
+/// @ingroup dataaccess_tab
+class MappedTableColumn : public boost::noncopyable {
+public:
+  /// @brief map the column into memory
+  /// @details No exception is thrown if the layout is unsupported, use isValid
+  /// to check whether the map can be used.
+  /// @param[in] ms measurement set (should be a plain table)
+  /// @param[in] column name of the column to map (e.g. DATA or FLAG)
+  MappedTableColumn(const casacore::Table &ms, const std::string &column);
+
+  /// @brief destructor, unmaps the file
+  ~MappedTableColumn();
+
+  /// @return true if the column has been mapped successfully
+  inline bool isValid() const { return itsData != 0; }
+
+  /// @return the reason why the column couldn't be mapped (empty if it is valid)
+  inline const std::string& reason() const { return itsReason; }
+
+  /// @return name of the mapped column
+  inline const std::string& columnName() const { return itsColumnName; }
+
+  /// @return number of polarisations in the column
+  inline casacore::uInt nPol() const { return itsNPol; }
+
+  /// @return number of channels in the column
+  inline casacore::uInt nChannel() const { return itsNChan; }
+
+  /// @brief read visibilities for the given rows
+  /// @details The data are transposed into the accessor layout straight from the
+  /// mapped pages. This method is only valid for complex columns.
+  /// @param[in] rows row numbers in the mapped table
+  /// @param[in] startChan first channel to read
+  /// @param[in] nChan number of channels to read
+  /// @param[out] cube nRow x nChan x nPol cube to fill (resized as necessary)
+  void read(const casacore::Vector<casacore::rownr_t> &rows, casacore::uInt startChan,
+            casacore::uInt nChan, casacore::Cube<casacore::Complex> &cube) const;
+
+  /// @brief read flags for the given rows
+  /// @details This method is only valid for boolean columns.
+  /// @param[in] rows row numbers in the mapped table
+  /// @param[in] startChan first channel to read
+  /// @param[in] nChan number of channels to read
+  /// @param[out] cube nRow x nChan x nPol cube to fill (resized as necessary)
+  void read(const casacore::Vector<casacore::rownr_t> &rows, casacore::uInt startChan,
+            casacore::uInt nChan, casacore::Cube<casacore::Bool> &cube) const;
+
+private:
+  /// @brief check the layout and map the file
+  /// @param[in] ms measurement set
+  /// @return empty string on success, or a reason why the column can't be mapped
+  std::string init(const casacore::Table &ms);
+
+  /// @brief check that the rows and channels requested are within the column
+  /// @param[in] rows row numbers in the mapped table
+  /// @param[in] startChan first channel to read
+  /// @param[in] nChan number of channels to read
+  void checkRequest(const casacore::Vector<casacore::rownr_t> &rows, casacore::uInt startChan,
+                    casacore::uInt nChan) const;
+
+  /// @brief name of the mapped column
+  std::string itsColumnName;
+
+  /// @brief reason why the column couldn't be mapped
+  std::string itsReason;
+
+  /// @brief true for a boolean column, false for a complex one
+  bool itsIsBool;
+
+  /// @brief number of polarisations
+  casacore::uInt itsNPol;
+
+  /// @brief number of channels
+  casacore::uInt itsNChan;
+
+  /// @brief number of rows
+  casacore::rownr_t itsNRow;
+
+  /// @brief number of rows per tile
+  casacore::rownr_t itsRowsPerTile;
+
+  /// @brief size of a single tile in bytes
+  size_t itsTileSize;
+
+  /// @brief start of the mapped file, zero if not mapped
+  const char *itsData;
+
+  /// @brief size of the mapped file in bytes
+  size_t itsSize;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MAPPED_TABLE_COLUMN_H
@@ -0,0 +1,152 @@
+/// @file
+///
+/// @brief Const iterator reading visibilities and flags from memory-mapped columns
+/// @details This iterator is created by MappedTableConstDataSource. Everything except
+/// visibilities and flags is read via the table system the same way as in
+/// TableConstDataIterator.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/MappedTableConstDataIterator.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/tables/Tables/ScalarColumn.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor of the const iterator
+/// @param[in] msManager a manager of the measurement set to use
+/// @param[in] sel shared pointer to selector
+/// @param[in] conv shared pointer to converter
+/// @param[in] visibility mapped visibility column (empty pointer to use the table system)
+/// @param[in] flag mapped flag column (empty pointer to use the table system)
+/// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+/// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
+/// to initialisation of a new UVW Machine
+/// @param[in] maxChunkSize maximum number of rows per accessor
+/// @param[in] maxChannelBlock maximum number of spectral channels per accessor, 0 means
+/// no restriction
+/// @param[in] tableMutex mutex serialising access to the table (a new mutex is created
+/// if an empty shared pointer is given)
+MappedTableConstDataIterator::MappedTableConstDataIterator(
+            const boost::shared_ptr<ITableManager const> &msManager,
+            const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
+            const boost::shared_ptr<IDataConverterImpl const> &conv,
+            const boost::shared_ptr<MappedTableColumn const> &visibility,
+            const boost::shared_ptr<MappedTableColumn const> &flag,
+            size_t cacheSize, double tolerance, casacore::uInt maxChunkSize,
+            casacore::uInt maxChannelBlock,
+            const boost::shared_ptr<boost::recursive_mutex> &tableMutex) :
+         TableInfoAccessor(msManager),
+         // read-ahead is pointless, the data are read from the page cache
+         TableConstDataIterator(msManager, sel, conv, cacheSize, tolerance, maxChunkSize,
+                                false, maxChannelBlock, tableMutex),
+         itsVisibility(visibility), itsFlag(flag)
+{
+  ASKAPDEBUGASSERT(!itsVisibility || itsVisibility->isValid());
+  ASKAPDEBUGASSERT(!itsFlag || itsFlag->isValid());
+}
+
+/// populate the buffer of visibilities with the values of current
+/// iteration
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+void MappedTableConstDataIterator::fillVisibility(casacore::Cube<casacore::Complex> &vis) const
+{
+  // averaging needs flags and noise, it is done by the table-based code as is the polarisation conversion
+  if (!itsVisibility || (itsVisibility->columnName() != getDataColumnName()) || (channelAveraging() > 1) ||
+      polarisationConverted()) {
+      TableConstDataIterator::fillVisibility(vis);
+      return;
+  }
+  checkAccessorField(IDataSelector::VISIBILITY, "visibility");
+  checkShape(*itsVisibility);
+  itsVisibility->read(currentRows(), startChannel(), nChannel(), vis);
+}
+
+/// @brief read flagging information
+/// @details populate the buffer of flags with the information
+/// read in the current iteration. Rows with FLAG_ROW set are flagged entirely.
+/// @param[in] flag a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the flag information (each element has
+///            bool type)
+void MappedTableConstDataIterator::fillFlag(casacore::Cube<casacore::Bool> &flag) const
+{
+  if (!itsFlag || (channelAveraging() > 1) || polarisationConverted()) {
+      TableConstDataIterator::fillFlag(flag);
+      return;
+  }
+  checkAccessorField(IDataSelector::FLAG, "flag");
+  checkShape(*itsFlag);
+  const casacore::uInt nChan = nChannel();
+  const casacore::uInt startChan = startChannel();
+  itsFlag->read(currentRows(), startChan, nChan, flag);
+  if (allFlaggedBySelection()) {
+      flag = true;
+      return;
+  }
+  boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+  const casacore::Table &iteration = getCurrentIteration();
+  if (iteration.tableDesc().isColumn("FLAG_ROW")) {
+      const casacore::ROScalarColumn<casacore::Bool> flagRowCol(iteration, "FLAG_ROW");
+      for (casacore::uInt row = 0; row < nRow(); ++row) {
+           if (flagRowCol(getCurrentTopRow() + row)) {
+               flag.yzPlane(row) = true;
+           }
+      }
+  }
+}
+
+/// @brief obtain row numbers of the current accessor in the measurement set
+/// @return vector with nRow elements
+casacore::Vector<casacore::rownr_t> MappedTableConstDataIterator::currentRows() const
+{
+  boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+  const casacore::Vector<casacore::rownr_t> allRows = getCurrentIteration().rowNumbers(table(), casacore::True);
+  ASKAPDEBUGASSERT(getCurrentTopRow() + nRow() <= allRows.nelements());
+  casacore::Vector<casacore::rownr_t> rows(nRow());
+  for (casacore::uInt row = 0; row < nRow(); ++row) {
+       rows[row] = allRows[getCurrentTopRow() + row];
+  }
+  return rows;
+}
+
+/// @brief check that the mapped column matches the current accessor
+/// @param[in] column mapped column
+void MappedTableConstDataIterator::checkShape(const MappedTableColumn &column) const
+{
+  if (column.nPol() != nPol()) {
+      ASKAPTHROW(DataAccessError, "Number of polarizations is not conformant for the "<<
+                 column.columnName()<<" column: "<<column.nPol()<<" in the column, "<<nPol()<<" expected");
+  }
+}
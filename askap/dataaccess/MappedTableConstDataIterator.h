@@ -0,0 +1,113 @@
+/// @file
+///
+/// @brief Const iterator reading visibilities and flags from memory-mapped columns
+/// @details This iterator is created by MappedTableConstDataSource. Everything except
+/// visibilities and flags is read via the table system the same way as in
+/// TableConstDataIterator.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_MAPPED_TABLE_CONST_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_MAPPED_TABLE_CONST_DATA_ITERATOR_H
+
+// own includes
+#include <askap/dataaccess/TableConstDataIterator.h>
+#include <askap/dataaccess/MappedTableColumn.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Const iterator reading visibilities and flags from memory-mapped columns
+/// @details The row numbers of the current accessor in the measurement set are
+/// obtained from the table iterator, then the data are copied straight from the
+/// mapped pages (see MappedTableColumn). Either of the columns can be absent (empty
+/// shared pointer), the table system is used for it then.
+/// @ingroup dataaccess_tab
+class MappedTableConstDataIterator : public TableConstDataIterator {
+public:
+  /// @brief constructor of the const iterator
+  /// @param[in] msManager a manager of the measurement set to use
+  /// @param[in] sel shared pointer to selector
+  /// @param[in] conv shared pointer to converter
+  /// @param[in] visibility mapped visibility column (empty pointer to use the table system)
+  /// @param[in] flag mapped flag column (empty pointer to use the table system)
+  /// @param[in] cacheSize a number of uvw machines in the cache (default is 1)
+  /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
+  /// to initialisation of a new UVW Machine
+  /// @param[in] maxChunkSize maximum number of rows per accessor
+  /// @param[in] maxChannelBlock maximum number of spectral channels per accessor, 0 means
+  /// no restriction
+  /// @param[in] tableMutex mutex serialising access to the table (a new mutex is created
+  /// if an empty shared pointer is given)
+  MappedTableConstDataIterator(const boost::shared_ptr<ITableManager const> &msManager,
+              const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
+              const boost::shared_ptr<IDataConverterImpl const> &conv,
+              const boost::shared_ptr<MappedTableColumn const> &visibility,
+              const boost::shared_ptr<MappedTableColumn const> &flag,
+              size_t cacheSize = 1, double tolerance = 1e-6,
+              casacore::uInt maxChunkSize = INT_MAX, casacore::uInt maxChannelBlock = 0,
+              const boost::shared_ptr<boost::recursive_mutex> &tableMutex =
+                    boost::shared_ptr<boost::recursive_mutex>());
+
+  /// populate the buffer of visibilities with the values of current
+  /// iteration
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  virtual void fillVisibility(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief read flagging information
+  /// @details populate the buffer of flags with the information
+  /// read in the current iteration. Rows with FLAG_ROW set are flagged entirely.
+  /// @param[in] flag a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the flag information (each element has
+  ///            bool type)
+  virtual void fillFlag(casacore::Cube<casacore::Bool> &flag) const;
+
+private:
+  /// @brief obtain row numbers of the current accessor in the measurement set
+  /// @return vector with nRow elements
+  casacore::Vector<casacore::rownr_t> currentRows() const;
+
+  /// @brief check that the mapped column matches the current accessor
+  /// @param[in] column mapped column
+  void checkShape(const MappedTableColumn &column) const;
+
+  /// @brief mapped visibility column, may be empty
+  boost::shared_ptr<MappedTableColumn const> itsVisibility;
+
+  /// @brief mapped flag column, may be empty
+  boost::shared_ptr<MappedTableColumn const> itsFlag;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MAPPED_TABLE_CONST_DATA_ITERATOR_H
@@ -0,0 +1,131 @@
+/// @file
+///
+/// @brief Read-only data source with memory-mapped visibility and flag columns
+/// @details The iterators created by this data source read visibilities and flags
+/// via MappedTableColumn if the layout of the column allows it.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/MappedTableConstDataSource.h>
+#include <askap/dataaccess/MappedTableConstDataIterator.h>
+#include <askap/dataaccess/ITableDataSelectorImpl.h>
+#include <askap/dataaccess/IDataConverterImpl.h>
+#include <askap/dataaccess/TableManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct a read-only data source object
+/// @param[in] fname file name of the measurement set to use
+/// @param[in] dataColumn a name of the data column used by default
+///                       (default is DATA)
+MappedTableConstDataSource::MappedTableConstDataSource(const std::string &fname,
+                  const std::string &dataColumn) :
+         TableInfoAccessor(casacore::Table(fname), false, dataColumn) {}
+
+/// get iterator over a selected part of the dataset represented
+/// by this DataSource object with an explicitly specified conversion
+/// policy.
+/// @param[in] sel a shared pointer to the selector object defining
+///            which subset of the data is used
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @return a shared pointer to DataIterator object
+boost::shared_ptr<IConstDataIterator>
+MappedTableConstDataSource::createConstIterator(const IDataSelectorConstPtr &sel,
+              const IDataConverterConstPtr &conv) const
+{
+   boost::shared_ptr<ITableDataSelectorImpl const> implSel =
+           boost::dynamic_pointer_cast<ITableDataSelectorImpl const>(sel);
+   boost::shared_ptr<IDataConverterImpl const> implConv =
+           boost::dynamic_pointer_cast<IDataConverterImpl const>(conv);
+   if (!implSel || !implConv) {
+       ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
+                 "converter are received by the createConstIterator method");
+   }
+   const boost::shared_ptr<MappedTableColumn const> vis = mappedColumn(implSel->getDataColumnName());
+   const boost::shared_ptr<MappedTableColumn const> flag = mappedColumn("FLAG");
+   if (!vis && !flag) {
+       return TableConstDataSource::createConstIterator(sel, conv);
+   }
+   boost::lock_guard<boost::recursive_mutex> lock(*tableMutex());
+   // see TableConstDataSource::createConstIterator for the concurrent-read mode
+   const boost::shared_ptr<ITableManager const> msManager = concurrentRead() ?
+           boost::shared_ptr<ITableManager const>(new TableManager(table(), false,
+                             getTableManager()->defaultDataColumnName())) : getTableManager();
+   return boost::shared_ptr<IConstDataIterator>(new MappedTableConstDataIterator(msManager,
+                implSel, implConv, vis, flag, uvwMachineCacheSize(), uvwMachineCacheTolerance(),
+                maxChunkSize(), maxChannelBlock(),
+                concurrentRead() ? tableMutex() : boost::shared_ptr<boost::recursive_mutex>()));
+}
+
+/// @brief check whether the given column is read from memory-mapped storage
+/// @details The column is mapped if this hasn't been done yet.
+/// @param[in] column name of the column (e.g. DATA or FLAG)
+/// @return true, if the column is mapped successfully
+bool MappedTableConstDataSource::isMapped(const std::string &column) const
+{
+   return static_cast<bool>(mappedColumn(column));
+}
+
+/// @brief obtain the mapped column
+/// @details The column is mapped on the first request
+/// @param[in] column name of the column
+/// @return shared pointer to the mapped column, empty if the column layout is unsupported
+boost::shared_ptr<MappedTableColumn const> MappedTableConstDataSource::mappedColumn(const std::string &column) const
+{
+   typedef std::map<std::string, boost::shared_ptr<MappedTableColumn const> >::const_iterator ColumnIt;
+   {
+     boost::lock_guard<boost::mutex> lock(itsColumnsMutex);
+     const ColumnIt ci = itsColumns.find(column);
+     if (ci != itsColumns.end()) {
+         return ci->second;
+     }
+   }
+   // the layout is checked via the table system, itsColumnsMutex is not held to
+   // avoid nesting it with the table mutex
+   boost::shared_ptr<MappedTableColumn const> result;
+   {
+     boost::lock_guard<boost::recursive_mutex> lock(*tableMutex());
+     result.reset(new MappedTableColumn(table(), column));
+   }
+   if (!result->isValid()) {
+       result.reset();
+   }
+   boost::lock_guard<boost::mutex> lock(itsColumnsMutex);
+   // another thread may have mapped the same column in the meantime
+   const ColumnIt ci = itsColumns.find(column);
+   if (ci != itsColumns.end()) {
+       return ci->second;
+   }
+   itsColumns[column] = result;
+   return result;
+}
@@ -0,0 +1,109 @@
+/// @file
+///
+/// @brief Read-only data source with memory-mapped visibility and flag columns
+/// @details Major cycles read the same visibilities again and again. If the columns
+/// are stored without compression by a tiled storage manager, mapping the storage
+/// files into memory allows the data to be served from the OS page cache without
+/// going through the bucket cache of the table system.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_MAPPED_TABLE_CONST_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_MAPPED_TABLE_CONST_DATA_SOURCE_H
+
+// own includes
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/MappedTableColumn.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+// std includes
+#include <string>
+#include <map>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Read-only data source with memory-mapped visibility and flag columns
+/// @details This class behaves exactly like TableConstDataSource, but the iterators
+/// it creates read visibilities and flags via MappedTableColumn. Columns are mapped
+/// on the first use and the maps are shared by all iterators. If the layout of a column
+/// is unsupported (see MappedTableColumn for the list of requirements), it is read via
+/// the table system as usual. Iterators don't read ahead when a mapped column is used.
+/// The measurement set shouldn't be modified while this data source exists.
+/// @ingroup dataaccess_tab
+class MappedTableConstDataSource : public TableConstDataSource {
+public:
+  /// @brief construct a read-only data source object
+  /// @param[in] fname file name of the measurement set to use
+  /// @param[in] dataColumn a name of the data column used by default
+  ///                       (default is DATA)
+  explicit MappedTableConstDataSource(const std::string &fname,
+                                      const std::string &dataColumn = "DATA");
+
+  /// get iterator over a selected part of the dataset represented
+  /// by this DataSource object with an explicitly specified conversion
+  /// policy.
+  /// @param[in] sel a shared pointer to the selector object defining
+  ///            which subset of the data is used
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @return a shared pointer to DataIterator object
+  virtual boost::shared_ptr<IConstDataIterator> createConstIterator(const
+             IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv) const;
+
+  // we need this to get access to the overloaded syntax in the base class
+  using IConstDataSource::createConstIterator;
+
+  /// @brief check whether the given column is read from memory-mapped storage
+  /// @details The column is mapped if this hasn't been done yet.
+  /// @param[in] column name of the column (e.g. DATA or FLAG)
+  /// @return true, if the column is mapped successfully
+  bool isMapped(const std::string &column) const;
+
+private:
+  /// @brief obtain the mapped column
+  /// @details The column is mapped on the first request
+  /// @param[in] column name of the column
+  /// @return shared pointer to the mapped column, empty if the column layout is unsupported
+  boost::shared_ptr<MappedTableColumn const> mappedColumn(const std::string &column) const;
+
+  /// @brief columns mapped so far, empty pointers mark unsupported columns
+  mutable std::map<std::string, boost::shared_ptr<MappedTableColumn const> > itsColumns;
+
+  /// @brief mutex protecting itsColumns
+  mutable boost::mutex itsColumnsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MAPPED_TABLE_CONST_DATA_SOURCE_H
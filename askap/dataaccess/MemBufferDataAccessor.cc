@@ -39,6 +39,8 @@
 
 // own includes
 #include <askap/dataaccess/MemBufferDataAccessor.h>
+#include <askap/dataaccess/ArraySwap.h>
+#include <askap/askap/AskapError.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -73,6 +75,23 @@ casacore::Cube<casacore::Complex>& MemBufferDataAccessor::rwVisibility()
   return itsBuffer;
 }
 
+/// @brief exchange the buffer with the given cube without copying
+/// @details This method allows to take over visibilities filled elsewhere. The cube
+/// should have the shape of the associated accessor (nRow x nChannel x nPol). 
+/// The previous content of the buffer is returned in the given cube.
+/// @param[in] vis cube to take over, previous buffer on exit
+void MemBufferDataAccessor::swapVisibility(casacore::Cube<casacore::Complex> &vis)
+{
+  const IConstDataAccessor &acc = getROAccessor();
+  ASKAPCHECK(vis.nrow() == acc.nRow() && vis.ncolumn() == acc.nChannel() && vis.nplane() == acc.nPol(),
+             "Cube passed to swapVisibility has shape "<<vis.shape()<<", the accessor has "<<acc.nRow()<<
+             " rows, "<<acc.nChannel()<<" channels and "<<acc.nPol()<<" polarisations");
+  #ifdef _OPENMP
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  #endif
+  swapValues(itsBuffer, vis);
+}
+
 /// @brief a helper method to ensure the buffer has appropriate shape
 void MemBufferDataAccessor::resizeBufferIfNeeded() const
 {
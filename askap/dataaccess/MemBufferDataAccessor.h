@@ -95,6 +95,13 @@ public:
   /// all visibility data
   ///
   virtual casacore::Cube<casacore::Complex>& rwVisibility();
+
+  /// @brief exchange the buffer with the given cube without copying
+  /// @details This method allows to take over visibilities filled elsewhere. The cube
+  /// should have the shape of the associated accessor (nRow x nChannel x nPol). 
+  /// The previous content of the buffer is returned in the given cube.
+  /// @param[in] vis cube to take over, previous buffer on exit
+  void swapVisibility(casacore::Cube<casacore::Complex> &vis);
     
   
 private:
@@ -0,0 +1,368 @@
+/// @file
+/// @brief Implementation of ITableRowIndex holding everything in memory
+/// @details This file contains a class implementing the ITableRowIndex
+/// interface by reading ANTENNA1, ANTENNA2, FEED1, FEED2, DATA_DESC_ID,
+/// TIME and UVW columns of the main table into memory on demand.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/MemTableRowIndex.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <cmath>
+
+ASKAP_LOGGER(logger, ".MemTableRowIndex");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief predicate matching a single baseline
+struct BaselineMatch {
+  BaselineMatch(casacore::Int ant1, casacore::Int ant2) : itsAnt1(ant1), itsAnt2(ant2) {}
+  template<typename Key>
+  bool operator()(const Key &key) const
+     { return key.template get<0>() == itsAnt1 && key.template get<1>() == itsAnt2; }
+  casacore::Int itsAnt1;
+  casacore::Int itsAnt2;
+};
+
+/// @brief predicate matching a group of baselines
+struct BaselineGroupMatch {
+  explicit BaselineGroupMatch(const std::set<std::pair<casacore::Int, casacore::Int> > &baselines) :
+           itsBaselines(baselines) {}
+  template<typename Key>
+  bool operator()(const Key &key) const
+     { return itsBaselines.find(std::make_pair(key.template get<0>(), key.template get<1>())) !=
+              itsBaselines.end(); }
+  const std::set<std::pair<casacore::Int, casacore::Int> > &itsBaselines;
+};
+
+/// @brief predicate matching all baselines to the given antenna
+struct AntennaMatch {
+  explicit AntennaMatch(casacore::Int ant) : itsAnt(ant) {}
+  template<typename Key>
+  bool operator()(const Key &key) const
+     { return key.template get<0>() == itsAnt || key.template get<1>() == itsAnt; }
+  casacore::Int itsAnt;
+};
+
+/// @brief predicate matching the given feed for both antennas
+struct FeedMatch {
+  explicit FeedMatch(casacore::Int feed) : itsFeed(feed) {}
+  template<typename Key>
+  bool operator()(const Key &key) const
+     { return key.template get<2>() == itsFeed && key.template get<3>() == itsFeed; }
+  casacore::Int itsFeed;
+};
+
+/// @brief predicate matching a set of data description IDs
+struct DataDescMatch {
+  explicit DataDescMatch(const std::vector<size_t> &ids) : itsIDs(ids) {}
+  template<typename Key>
+  bool operator()(const Key &key) const
+     { return key.template get<4>() >= 0 && std::find(itsIDs.begin(), itsIDs.end(),
+              size_t(key.template get<4>())) != itsIDs.end(); }
+  const std::vector<size_t> &itsIDs;
+};
+
+/// @brief predicate matching auto- or cross-correlations
+struct CorrelationMatch {
+  explicit CorrelationMatch(bool autoCorr) : itsAuto(autoCorr) {}
+  template<typename Key>
+  bool operator()(const Key &key) const
+     { return ((key.template get<0>() == key.template get<1>()) &&
+               (key.template get<2>() == key.template get<3>())) == itsAuto; }
+  bool itsAuto;
+};
+
+} // anonymous namespace
+
+/// @brief set up the index
+/// @details Nothing is read in the constructor
+/// @param[in] ms an input measurement set
+MemTableRowIndex::MemTableRowIndex(const casacore::Table &ms) : TableHolder(ms),
+      itsRowsBuilt(false), itsTimeChecked(false), itsTimeOrdered(false),
+      itsUVDistanceBuilt(false) {}
+
+/// @brief read antenna, feed and data description columns and group rows
+/// @note the mutex should be locked by the caller
+void MemTableRowIndex::buildRows() const
+{
+  // read whole columns at once, this is the only pass through the table
+  const casacore::Table &ms = table();
+  const casacore::Vector<casacore::Int> ant1 = casacore::ROScalarColumn<casacore::Int>(ms, "ANTENNA1").getColumn();
+  const casacore::Vector<casacore::Int> ant2 = casacore::ROScalarColumn<casacore::Int>(ms, "ANTENNA2").getColumn();
+  const casacore::Vector<casacore::Int> feed1 = casacore::ROScalarColumn<casacore::Int>(ms, "FEED1").getColumn();
+  const casacore::Vector<casacore::Int> feed2 = casacore::ROScalarColumn<casacore::Int>(ms, "FEED2").getColumn();
+  const casacore::Vector<casacore::Int> ddID = casacore::ROScalarColumn<casacore::Int>(ms, "DATA_DESC_ID").getColumn();
+  ASKAPDEBUGASSERT(ant1.nelements() == ms.nrow());
+  for (casacore::rownr_t row = 0; row < ms.nrow(); ++row) {
+       itsRows[Key(ant1[row], ant2[row], feed1[row], feed2[row], ddID[row])].push_back(row);
+  }
+  itsRowsBuilt = true;
+  ASKAPLOG_DEBUG_STR(logger, "Row index built for "<<ms.nrow()<<" rows, "<<itsRows.size()<<
+                     " distinct baseline/feed/data description combinations");
+}
+
+/// @brief read TIME column and check the ordering, if not done already
+/// @note the mutex should be locked by the caller
+void MemTableRowIndex::initTime() const
+{
+  if (itsTimeChecked) {
+      return;
+  }
+  itsTime = casacore::ROScalarColumn<casacore::Double>(table(), "TIME").getColumn();
+  itsTimeOrdered = true;
+  for (casacore::rownr_t row = 1; row < itsTime.nelements(); ++row) {
+       if (itsTime[row] < itsTime[row - 1]) {
+           itsTimeOrdered = false;
+           break;
+       }
+  }
+  if (!itsTimeOrdered) {
+      // the content is useless for binary search, don't waste memory
+      itsTime.resize(0);
+      ASKAPLOG_DEBUG_STR(logger, "Main table is not time-ordered, time selection will be done via table expression");
+  }
+  itsTimeChecked = true;
+}
+
+/// @brief read UVW column and sort rows by uv-distance, if not done already
+/// @note the mutex should be locked by the caller
+void MemTableRowIndex::initUVDistance() const
+{
+  if (itsUVDistanceBuilt) {
+      return;
+  }
+  const casacore::Table &ms = table();
+  casacore::ROArrayColumn<casacore::Double> uvwCol(ms, "UVW");
+  itsUVDistance.reserve(ms.nrow());
+  if (uvwCol.columnDesc().isFixedShape() && (uvwCol.shapeColumn().nelements() == 1)) {
+      // read the whole column at once
+      const casacore::Matrix<casacore::Double> uvw(uvwCol.getColumn());
+      ASKAPDEBUGASSERT(uvw.ncolumn() == ms.nrow());
+      if (uvw.nrow() >= 2) {
+          for (casacore::rownr_t row = 0; row < uvw.ncolumn(); ++row) {
+               itsUVDistance.push_back(std::pair<casacore::Double, casacore::rownr_t>(
+                      std::sqrt(casacore::square(uvw(0,row)) + casacore::square(uvw(1,row))), row));
+               if ((uvw.nrow() >= 3) && (uvw(0,row) == 0.) && (uvw(1,row) == 0.) && (uvw(2,row) == 0.)) {
+                   itsZeroUVWRows.push_back(row);
+               }
+          }
+      }
+  } else {
+      // shape can change from row to row
+      for (casacore::rownr_t row = 0; row < ms.nrow(); ++row) {
+           if (!uvwCol.isDefined(row)) {
+               continue;
+           }
+           const casacore::Array<casacore::Double> uvw = uvwCol(row);
+           if ((uvw.ndim() != 1) || (uvw.nelements() < 2)) {
+               continue;
+           }
+           const casacore::Vector<casacore::Double> uvwVec(uvw);
+           itsUVDistance.push_back(std::pair<casacore::Double, casacore::rownr_t>(
+                  std::sqrt(casacore::square(uvwVec[0]) + casacore::square(uvwVec[1])), row));
+           if ((uvwVec.nelements() >= 3) && (uvwVec[0] == 0.) && (uvwVec[1] == 0.) && (uvwVec[2] == 0.)) {
+               itsZeroUVWRows.push_back(row);
+           }
+      }
+  }
+  std::sort(itsUVDistance.begin(), itsUVDistance.end());
+  itsUVDistanceBuilt = true;
+  ASKAPLOG_DEBUG_STR(logger, "Sorted uv-distances for "<<itsUVDistance.size()<<" rows");
+}
+
+/// @brief collect rows for all keys satisfying the predicate
+/// @param[in] pred predicate taking a Key and returning bool
+/// @return sorted vector of row numbers
+template<typename Predicate>
+std::vector<casacore::rownr_t> MemTableRowIndex::collectRows(Predicate pred) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (!itsRowsBuilt) {
+      buildRows();
+  }
+  std::vector<casacore::rownr_t> result;
+  size_t nGroups = 0;
+  for (std::map<Key, std::vector<casacore::rownr_t> >::const_iterator ci = itsRows.begin();
+       ci != itsRows.end(); ++ci) {
+       if (pred(ci->first)) {
+           result.insert(result.end(), ci->second.begin(), ci->second.end());
+           ++nGroups;
+       }
+  }
+  // each group is sorted, only need to sort if more than one group contributed
+  if (nGroups > 1) {
+      std::sort(result.begin(), result.end());
+  }
+  return result;
+}
+
+/// @brief obtain rows for a single baseline
+/// @param[in] ant1 the first antenna
+/// @param[in] ant2 the second antenna
+/// @return sorted vector of row numbers
+std::vector<casacore::rownr_t> MemTableRowIndex::baselineRows(casacore::uInt ant1, casacore::uInt ant2) const
+{
+  return collectRows(BaselineMatch(static_cast<casacore::Int>(ant1), static_cast<casacore::Int>(ant2)));
+}
+
+/// @brief obtain rows for a group of baselines
+/// @param[in] baselines pairs of the first and the second antenna
+/// @return sorted vector of row numbers
+std::vector<casacore::rownr_t> MemTableRowIndex::baselineGroupRows(
+          const std::vector<std::pair<casacore::uInt, casacore::uInt> > &baselines) const
+{
+  std::set<std::pair<casacore::Int, casacore::Int> > baselineSet;
+  for (std::vector<std::pair<casacore::uInt, casacore::uInt> >::const_iterator ci = baselines.begin();
+       ci != baselines.end(); ++ci) {
+       baselineSet.insert(std::make_pair(static_cast<casacore::Int>(ci->first),
+                          static_cast<casacore::Int>(ci->second)));
+  }
+  return collectRows(BaselineGroupMatch(baselineSet));
+}
+
+/// @brief obtain rows for all baselines to the given antenna
+/// @param[in] ant antenna index
+/// @return sorted vector of row numbers
+std::vector<casacore::rownr_t> MemTableRowIndex::antennaRows(casacore::uInt ant) const
+{
+  return collectRows(AntennaMatch(static_cast<casacore::Int>(ant)));
+}
+
+/// @brief obtain rows for the given feed (the same for both antennas)
+/// @param[in] feed feed index
+/// @return sorted vector of row numbers
+std::vector<casacore::rownr_t> MemTableRowIndex::feedRows(casacore::uInt feed) const
+{
+  return collectRows(FeedMatch(static_cast<casacore::Int>(feed)));
+}
+
+/// @brief obtain rows for the given data description IDs
+/// @param[in] dataDescIDs data description IDs of interest
+/// @return sorted vector of row numbers
+std::vector<casacore::rownr_t> MemTableRowIndex::dataDescRows(const std::vector<size_t> &dataDescIDs) const
+{
+  return collectRows(DataDescMatch(dataDescIDs));
+}
+
+/// @brief obtain rows with auto-correlations
+/// @details The same antenna and the same feed
+/// @return sorted vector of row numbers
+std::vector<casacore::rownr_t> MemTableRowIndex::autoCorrelationRows() const
+{
+  return collectRows(CorrelationMatch(true));
+}
+
+/// @brief obtain rows with cross-correlations
+/// @details Different antennas or different feeds
+/// @return sorted vector of row numbers
+std::vector<casacore::rownr_t> MemTableRowIndex::crossCorrelationRows() const
+{
+  return collectRows(CorrelationMatch(false));
+}
+
+/// @brief check whether the table is ordered in time
+/// @return true, if TIME never decreases with the row number
+bool MemTableRowIndex::timeOrdered() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  initTime();
+  return itsTimeOrdered;
+}
+
+/// @brief obtain rows for a time interval
+/// @details This method is only valid for time-ordered tables (see timeOrdered).
+/// Time is given in the same frame and units as the TIME column, the interval
+/// is open at both ends (the same as the table expression used otherwise).
+/// @param[in] start start of the interval
+/// @param[in] stop end of the interval
+/// @return the first row and one past the last row in the interval
+std::pair<casacore::rownr_t, casacore::rownr_t> MemTableRowIndex::timeRange(casacore::Double start,
+                                                                           casacore::Double stop) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  initTime();
+  ASKAPCHECK(itsTimeOrdered, "Binary search on time is only possible for time-ordered tables");
+  const casacore::Double *first = itsTime.data();
+  const casacore::Double *last = first + itsTime.nelements();
+  // strict inequalities: start < TIME < stop
+  const casacore::rownr_t startRow = std::upper_bound(first, last, start) - first;
+  const casacore::rownr_t stopRow = std::lower_bound(first, last, stop) - first;
+  return std::pair<casacore::rownr_t, casacore::rownr_t>(startRow, std::max(startRow, stopRow));
+}
+
+/// @brief obtain rows for a range of uv-distances
+/// @details The uv-distance is sqrt(u^2+v^2) in the units of the UVW column. Rows
+/// where UVW is not a vector of at least two elements are never selected.
+/// @param[in] minDist minimum uv-distance (inclusive)
+/// @param[in] maxDist maximum uv-distance (inclusive)
+/// @param[in] keepZero if true, rows with all uvw components exactly zero are selected
+/// regardless of the range
+/// @return sorted vector of row numbers
+std::vector<casacore::rownr_t> MemTableRowIndex::uvDistanceRows(casacore::Double minDist, casacore::Double maxDist,
+                                                                bool keepZero) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  initUVDistance();
+  typedef std::vector<std::pair<casacore::Double, casacore::rownr_t> >::const_iterator UVDistIt;
+  const UVDistIt first = std::lower_bound(itsUVDistance.begin(), itsUVDistance.end(),
+                  std::pair<casacore::Double, casacore::rownr_t>(minDist, 0));
+  const UVDistIt last = std::upper_bound(itsUVDistance.begin(), itsUVDistance.end(),
+                  std::pair<casacore::Double, casacore::rownr_t>(maxDist, std::numeric_limits<casacore::rownr_t>::max()));
+  std::vector<casacore::rownr_t> result;
+  if (first < last) {
+      result.reserve(last - first + (keepZero ? itsZeroUVWRows.size() : 0));
+      for (UVDistIt ci = first; ci != last; ++ci) {
+           result.push_back(ci->second);
+      }
+  }
+  if (keepZero) {
+      result.insert(result.end(), itsZeroUVWRows.begin(), itsZeroUVWRows.end());
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
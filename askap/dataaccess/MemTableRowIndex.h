@@ -0,0 +1,190 @@
+/// @file
+/// @brief Implementation of ITableRowIndex holding everything in memory
+/// @details This file contains a class implementing the ITableRowIndex
+/// interface by reading ANTENNA1, ANTENNA2, FEED1, FEED2, DATA_DESC_ID,
+/// TIME and UVW columns of the main table into memory on demand.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_MEM_TABLE_ROW_INDEX_H
+#define ASKAP_ACCESSORS_MEM_TABLE_ROW_INDEX_H
+
+// std includes
+#include <map>
+#include <vector>
+
+// boost includes
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <boost/thread/mutex.hpp>
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// own includes
+#include <askap/dataaccess/ITableRowIndex.h>
+#include <askap/dataaccess/TableHolder.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Implementation of ITableRowIndex holding everything in memory
+/// @details The main table is scanned once on the first query. Rows are grouped
+/// by (antenna1, antenna2, feed1, feed2, data description ID), so a query only
+/// loops over the distinct combinations and merges the matching row lists.
+/// The TIME column is read separately on the first time-related query, it is
+/// checked for ordering and then used for binary search. Similarly, uv-distances
+/// are computed and sorted on the first uv-distance query.
+/// @ingroup dataaccess_tab
+struct MemTableRowIndex : public ITableRowIndex,
+                          virtual protected TableHolder {
+
+  /// @brief set up the index
+  /// @details Nothing is read in the constructor
+  /// @param[in] ms an input measurement set
+  explicit MemTableRowIndex(const casacore::Table &ms);
+
+  /// @brief obtain rows for a single baseline
+  /// @param[in] ant1 the first antenna
+  /// @param[in] ant2 the second antenna
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> baselineRows(casacore::uInt ant1,
+                                                      casacore::uInt ant2) const;
+
+  /// @brief obtain rows for a group of baselines
+  /// @param[in] baselines pairs of the first and the second antenna
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> baselineGroupRows(
+          const std::vector<std::pair<casacore::uInt, casacore::uInt> > &baselines) const;
+
+  /// @brief obtain rows for all baselines to the given antenna
+  /// @param[in] ant antenna index
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> antennaRows(casacore::uInt ant) const;
+
+  /// @brief obtain rows for the given feed (the same for both antennas)
+  /// @param[in] feed feed index
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> feedRows(casacore::uInt feed) const;
+
+  /// @brief obtain rows for the given data description IDs
+  /// @param[in] dataDescIDs data description IDs of interest
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> dataDescRows(const std::vector<size_t> &dataDescIDs) const;
+
+  /// @brief obtain rows with auto-correlations
+  /// @details The same antenna and the same feed
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> autoCorrelationRows() const;
+
+  /// @brief obtain rows with cross-correlations
+  /// @details Different antennas or different feeds
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> crossCorrelationRows() const;
+
+  /// @brief check whether the table is ordered in time
+  /// @return true, if TIME never decreases with the row number
+  virtual bool timeOrdered() const;
+
+  /// @brief obtain rows for a time interval
+  /// @details This method is only valid for time-ordered tables (see timeOrdered).
+  /// Time is given in the same frame and units as the TIME column, the interval
+  /// is open at both ends (the same as the table expression used otherwise).
+  /// @param[in] start start of the interval
+  /// @param[in] stop end of the interval
+  /// @return the first row and one past the last row in the interval
+  virtual std::pair<casacore::rownr_t, casacore::rownr_t> timeRange(casacore::Double start,
+                                                                   casacore::Double stop) const;
+
+  /// @brief obtain rows for a range of uv-distances
+  /// @details The uv-distance is sqrt(u^2+v^2) in the units of the UVW column. Rows
+  /// where UVW is not a vector of at least two elements are never selected.
+  /// @param[in] minDist minimum uv-distance (inclusive)
+  /// @param[in] maxDist maximum uv-distance (inclusive)
+  /// @param[in] keepZero if true, rows with all uvw components exactly zero are selected
+  /// regardless of the range
+  /// @return sorted vector of row numbers
+  virtual std::vector<casacore::rownr_t> uvDistanceRows(casacore::Double minDist, casacore::Double maxDist,
+                                                        bool keepZero) const;
+
+private:
+  /// @brief index key: antenna1, antenna2, feed1, feed2, data description ID
+  typedef boost::tuple<casacore::Int, casacore::Int, casacore::Int, casacore::Int, casacore::Int> Key;
+
+  /// @brief collect rows for all keys satisfying the predicate
+  /// @param[in] pred predicate taking a Key and returning bool
+  /// @return sorted vector of row numbers
+  template<typename Predicate>
+  std::vector<casacore::rownr_t> collectRows(Predicate pred) const;
+
+  /// @brief read antenna, feed and data description columns and group rows
+  /// @note the mutex should be locked by the caller
+  void buildRows() const;
+
+  /// @brief read TIME column and check the ordering, if not done already
+  /// @note the mutex should be locked by the caller
+  void initTime() const;
+
+  /// @brief read UVW column and sort rows by uv-distance, if not done already
+  /// @note the mutex should be locked by the caller
+  void initUVDistance() const;
+
+  /// @brief row numbers grouped by key, each vector is sorted
+  mutable std::map<Key, std::vector<casacore::rownr_t> > itsRows;
+
+  /// @brief true, if itsRows has been filled
+  mutable bool itsRowsBuilt;
+
+  /// @brief content of the TIME column, only kept if the table is time-ordered
+  mutable casacore::Vector<casacore::Double> itsTime;
+
+  /// @brief true, if TIME column has been read and checked
+  mutable bool itsTimeChecked;
+
+  /// @brief true, if the table is time-ordered
+  mutable bool itsTimeOrdered;
+
+  /// @brief pairs of uv-distance and row number sorted by uv-distance
+  mutable std::vector<std::pair<casacore::Double, casacore::rownr_t> > itsUVDistance;
+
+  /// @brief sorted rows with zero uvw
+  mutable std::vector<casacore::rownr_t> itsZeroUVWRows;
+
+  /// @brief true, if uv-distances have been computed
+  mutable bool itsUVDistanceBuilt;
+
+  /// @brief synchronisation lock for building the index on demand
+  mutable boost::mutex itsMutex;
+};
+
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MEM_TABLE_ROW_INDEX_H
@@ -0,0 +1,234 @@
+/// @file
+///
+/// @brief Process-wide memory budget of the data access caches
+/// @details This class keeps the total memory used by all registered caches within
+/// one budget, evicting the least recently used entries across the caches.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <algorithm>
+#include <limits>
+
+ASKAP_LOGGER(logger, ".MemoryGovernor");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor, use instance
+MemoryGovernor::MemoryGovernor() : itsBudget(0), itsEvictions(0), itsStamp(0) {}
+
+/// @return the instance of the governor used by this process
+MemoryGovernor& MemoryGovernor::instance()
+{
+  static MemoryGovernor theGovernor;
+  return theGovernor;
+}
+
+/// @brief set up the governor from the parset
+/// @details The budget is taken from the memorybudget keyword (in megabytes), the priorities
+/// from memorybudget.priority.<name> keywords. Parameters which are not given are left unchanged.
+/// @param[in] parset parset to read the parameters from
+void MemoryGovernor::configure(const LOFAR::ParameterSet &parset)
+{
+  const LOFAR::ParameterSet priorities = parset.makeSubset("memorybudget.priority.");
+  for (LOFAR::ParameterSet::const_iterator ci = priorities.begin(); ci != priorities.end(); ++ci) {
+       setPriority(ci->first, priorities.getInt(ci->first));
+  }
+  if (parset.isDefined("memorybudget")) {
+      const double megabytes = parset.getDouble("memorybudget");
+      ASKAPCHECK(megabytes >= 0., "Memory budget should not be negative, you have "<<megabytes);
+      setBudget(static_cast<size_t>(megabytes * 1024. * 1024.));
+      ASKAPLOG_INFO_STR(logger, "Memory used by the data access caches is limited to "<<megabytes<<" MB");
+  }
+}
+
+/// @brief set the budget
+/// @details The budget is enforced immediately.
+/// @param[in] bytes maximum memory used by all caches in bytes, 0 means no limit
+void MemoryGovernor::setBudget(size_t bytes)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsBudget = bytes;
+  doEnforce();
+}
+
+/// @return maximum memory used by all caches in bytes, 0 means no limit
+size_t MemoryGovernor::budget() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsBudget;
+}
+
+/// @brief set the priority of the caches with the given name
+/// @param[in] name name of the cache (see IMemoryConsumer::consumerName)
+/// @param[in] priority caches with the lower priority are released first (the default is 0)
+void MemoryGovernor::setPriority(const std::string &name, int priority)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsPriorities[name] = priority;
+}
+
+/// @brief register a cache
+/// @param[in] consumer cache to register, it should be unregistered before it is destroyed
+void MemoryGovernor::add(IMemoryConsumer *consumer)
+{
+  ASKAPDEBUGASSERT(consumer != 0);
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (std::find(itsConsumers.begin(), itsConsumers.end(), consumer) == itsConsumers.end()) {
+      itsConsumers.push_back(consumer);
+  }
+}
+
+/// @brief unregister a cache
+/// @param[in] consumer cache to unregister
+void MemoryGovernor::remove(IMemoryConsumer *consumer)
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsConsumers.erase(std::remove(itsConsumers.begin(), itsConsumers.end(), consumer), itsConsumers.end());
+}
+
+/// @brief release entries until the registered caches fit into the budget
+/// @details The caller shouldn't hold the lock of any registered cache.
+void MemoryGovernor::enforce()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  doEnforce();
+}
+
+/// @return memory used by all registered caches in bytes
+size_t MemoryGovernor::memoryUsed() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  size_t result = 0;
+  for (std::vector<IMemoryConsumer*>::const_iterator ci = itsConsumers.begin(); ci != itsConsumers.end(); ++ci) {
+       result += (*ci)->memoryUsed();
+  }
+  return result;
+}
+
+/// @return memory used by each registered cache
+std::vector<MemoryGovernor::Usage> MemoryGovernor::usage() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  std::vector<Usage> result(itsConsumers.size());
+  for (size_t index = 0; index < itsConsumers.size(); ++index) {
+       result[index].itsName = itsConsumers[index]->consumerName();
+       result[index].itsBytes = itsConsumers[index]->memoryUsed();
+       result[index].itsPriority = priority(*itsConsumers[index]);
+  }
+  return result;
+}
+
+/// @brief write memory usage of the registered caches into the log
+void MemoryGovernor::logUsage() const
+{
+  const std::vector<Usage> caches = usage();
+  size_t total = 0;
+  for (std::vector<Usage>::const_iterator ci = caches.begin(); ci != caches.end(); ++ci) {
+       ASKAPLOG_INFO_STR(logger, "Cache "<<ci->itsName<<" (priority "<<ci->itsPriority<<") uses "<<
+                         ci->itsBytes<<" bytes");
+       total += ci->itsBytes;
+  }
+  const size_t limit = budget();
+  if (limit > 0) {
+      ASKAPLOG_INFO_STR(logger, caches.size()<<" cache(s) use "<<total<<" bytes in total, the budget is "<<
+                        limit<<" bytes, "<<evictions()<<" entries released to fit into the budget");
+  } else {
+      ASKAPLOG_INFO_STR(logger, caches.size()<<" cache(s) use "<<total<<" bytes in total, no budget is set");
+  }
+}
+
+/// @return number of entries released to fit into the budget
+size_t MemoryGovernor::evictions() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsEvictions;
+}
+
+/// @brief obtain the priority of the cache
+/// @note the mutex should be locked by the caller
+/// @param[in] consumer cache of interest
+/// @return priority
+int MemoryGovernor::priority(const IMemoryConsumer &consumer) const
+{
+  const std::map<std::string, int>::const_iterator ci = itsPriorities.find(consumer.consumerName());
+  return ci != itsPriorities.end() ? ci->second : 0;
+}
+
+/// @brief release entries until the registered caches fit into the budget
+/// @note the mutex should be locked by the caller
+void MemoryGovernor::doEnforce()
+{
+  if (itsBudget == 0) {
+      return;
+  }
+  std::vector<size_t> used(itsConsumers.size());
+  std::vector<int> priorities(itsConsumers.size());
+  size_t total = 0;
+  for (size_t index = 0; index < itsConsumers.size(); ++index) {
+       used[index] = itsConsumers[index]->memoryUsed();
+       priorities[index] = priority(*itsConsumers[index]);
+       total += used[index];
+  }
+  while (total > itsBudget) {
+         // the least recently used entry of the caches with the lowest priority
+         size_t victim = itsConsumers.size();
+         casacore::uInt64 victimStamp = std::numeric_limits<casacore::uInt64>::max();
+         for (size_t index = 0; index < itsConsumers.size(); ++index) {
+              if (used[index] == 0) {
+                  continue;
+              }
+              const casacore::uInt64 oldest = itsConsumers[index]->oldestUse();
+              if ((victim == itsConsumers.size()) || (priorities[index] < priorities[victim]) ||
+                  ((priorities[index] == priorities[victim]) && (oldest < victimStamp))) {
+                  victim = index;
+                  victimStamp = oldest;
+              }
+         }
+         if (victim == itsConsumers.size()) {
+             break;
+         }
+         const size_t released = std::min(itsConsumers[victim]->releaseOldest(), used[victim]);
+         if (released == 0) {
+             // nothing else can be released from this cache
+             total -= used[victim];
+             used[victim] = 0;
+             continue;
+         }
+         used[victim] -= released;
+         total -= released;
+         ++itsEvictions;
+  }
+}
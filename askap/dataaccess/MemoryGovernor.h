@@ -0,0 +1,175 @@
+/// @file
+///
+/// @brief Process-wide memory budget of the data access caches
+/// @details The data access layer has a number of caches, each limited on its own.
+/// This class keeps the total memory used by all registered caches within one budget,
+/// evicting the least recently used entries across the caches.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_MEMORY_GOVERNOR_H
+#define ASKAP_ACCESSORS_MEMORY_GOVERNOR_H
+
+// own includes
+#include <askap/dataaccess/IMemoryConsumer.h>
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+
+// LOFAR includes
+#include <Common/ParameterSet.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+// std includes
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Process-wide memory budget of the data access caches
+/// @details Caches register with the governor on construction and call enforce after
+/// adding data. If the total memory used by the registered caches exceeds the budget,
+/// entries are released until it fits. Caches with the lower priority lose their entries
+/// first, entries of the caches with the same priority are released in the order of use
+/// (least recently used first) regardless of the cache they belong to. The budget of zero
+/// (default) means no global limit, each cache is then only bound by its own limits.
+///
+/// The parameters can be given in the parset (see configure):
+/// @code
+///   memorybudget = 4096                     # total budget in megabytes
+///   memorybudget.priority.VisibilityCache = 1   # released after priority 0 caches
+/// @endcode
+/// All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class MemoryGovernor : public boost::noncopyable {
+public:
+  /// @brief memory used by a single cache
+  struct Usage {
+     /// @brief name of the cache
+     std::string itsName;
+     /// @brief memory used in bytes
+     size_t itsBytes;
+     /// @brief priority of the cache
+     int itsPriority;
+  };
+
+  /// @return the instance of the governor used by this process
+  static MemoryGovernor& instance();
+
+  /// @brief set up the governor from the parset
+  /// @details The budget is taken from the memorybudget keyword (in megabytes), the priorities
+  /// from memorybudget.priority.<name> keywords. Parameters which are not given are left unchanged.
+  /// @param[in] parset parset to read the parameters from
+  void configure(const LOFAR::ParameterSet &parset);
+
+  /// @brief set the budget
+  /// @details The budget is enforced immediately.
+  /// @param[in] bytes maximum memory used by all caches in bytes, 0 means no limit
+  void setBudget(size_t bytes);
+
+  /// @return maximum memory used by all caches in bytes, 0 means no limit
+  size_t budget() const;
+
+  /// @brief set the priority of the caches with the given name
+  /// @param[in] name name of the cache (see IMemoryConsumer::consumerName)
+  /// @param[in] priority caches with the lower priority are released first (the default is 0)
+  void setPriority(const std::string &name, int priority);
+
+  /// @brief register a cache
+  /// @param[in] consumer cache to register, it should be unregistered before it is destroyed
+  void add(IMemoryConsumer *consumer);
+
+  /// @brief unregister a cache
+  /// @param[in] consumer cache to unregister
+  void remove(IMemoryConsumer *consumer);
+
+  /// @brief release entries until the registered caches fit into the budget
+  /// @details The caller shouldn't hold the lock of any registered cache.
+  void enforce();
+
+  /// @return memory used by all registered caches in bytes
+  size_t memoryUsed() const;
+
+  /// @return memory used by each registered cache
+  std::vector<Usage> usage() const;
+
+  /// @brief write memory usage of the registered caches into the log
+  void logUsage() const;
+
+  /// @return number of entries released to fit into the budget
+  size_t evictions() const;
+
+  /// @brief obtain a new use stamp
+  /// @details Stamps are ever increasing, the caches record them for their entries
+  /// on each use, so entries of different caches can be compared.
+  /// @return the stamp
+  inline casacore::uInt64 stamp() { return ++itsStamp; }
+
+private:
+  /// @brief constructor, use instance
+  MemoryGovernor();
+
+  /// @brief obtain the priority of the cache
+  /// @note the mutex should be locked by the caller
+  /// @param[in] consumer cache of interest
+  /// @return priority
+  int priority(const IMemoryConsumer &consumer) const;
+
+  /// @brief release entries until the registered caches fit into the budget
+  /// @note the mutex should be locked by the caller
+  void doEnforce();
+
+  /// @brief registered caches
+  std::vector<IMemoryConsumer*> itsConsumers;
+
+  /// @brief priorities given per cache name
+  std::map<std::string, int> itsPriorities;
+
+  /// @brief budget in bytes, 0 means no limit
+  size_t itsBudget;
+
+  /// @brief number of entries released
+  size_t itsEvictions;
+
+  /// @brief last issued use stamp
+  std::atomic<casacore::uInt64> itsStamp;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MEMORY_GOVERNOR_H
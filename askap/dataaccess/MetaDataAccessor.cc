@@ -207,6 +207,21 @@ const casacore::Vector<casacore::Double>& MetaDataAccessor::uvwRotationDelay(
   return itsROAccessor.uvwRotationDelay(tangentPoint, imageCentre);
 }	
 
+/// @brief bounding box of uvw
+/// @return bounding box of uvw obtained from the original accessor
+UVWBounds MetaDataAccessor::uvwBounds() const
+{
+  return itsROAccessor.uvwBounds();
+}
+
+/// @brief bounding box of uvw after rotation
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return bounding box of rotated uvw obtained from the original accessor
+UVWBounds MetaDataAccessor::rotatedUVWBounds(const casacore::MDirection &tangentPoint) const
+{
+  return itsROAccessor.rotatedUVWBounds(tangentPoint);
+}
+
 /// Noise level required for a proper weighting
 /// @return a reference to nRow x nChannel x nPol cube with
 ///         complex noise estimates. Elements correspond to the
@@ -175,6 +175,15 @@ public:
   /// @return delays corresponding to the uvw rotation for each row
   virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
 	         const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const;
+
+  /// @brief bounding box of uvw
+  /// @return bounding box of uvw obtained from the original accessor
+  virtual UVWBounds uvwBounds() const;
+
+  /// @brief bounding box of uvw after rotation
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @return bounding box of rotated uvw obtained from the original accessor
+  virtual UVWBounds rotatedUVWBounds(const casacore::MDirection &tangentPoint) const;
           
 
   /// Noise level required for a proper weighting
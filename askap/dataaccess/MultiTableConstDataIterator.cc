@@ -0,0 +1,151 @@
+/// @file
+///
+/// @brief Iterator over a number of measurement sets
+/// @details This iterator is created by MultiTableConstDataSource. It runs through
+/// the iterators of individual measurement sets either one after another or merging
+/// them by time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/MultiTableConstDataIterator.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the iterator
+/// @param[in] nSources number of measurement sets
+/// @param[in] factory function creating iterator for the given measurement set
+/// @param[in] timeOrder if true, accessors are merged by time, otherwise
+///            measurement sets are iterated one after another
+MultiTableConstDataIterator::MultiTableConstDataIterator(size_t nSources, const IteratorFactory &factory,
+                  bool timeOrder) : itsFactory(factory), itsTimeOrder(timeOrder), itsIterators(nSources),
+                  itsCurrent(0)
+{
+  ASKAPCHECK(nSources > 0, "MultiTableConstDataIterator requires at least one measurement set");
+  init();
+}
+
+/// @brief Restart the iteration from the beginning
+void MultiTableConstDataIterator::init()
+{
+  if (itsTimeOrder) {
+      for (size_t index = 0; index < itsIterators.size(); ++index) {
+           startSource(index);
+      }
+      selectEarliest();
+  } else {
+      // iterators of the measurement sets processed during the previous pass are released
+      itsIterators.assign(itsIterators.size(), boost::shared_ptr<IConstDataIterator>());
+      itsCurrent = 0;
+      startSource(itsCurrent);
+      skipExhausted();
+  }
+}
+
+/// @brief operator* delivers a reference to data accessor (current chunk)
+/// @return a reference to the current chunk
+const IConstDataAccessor& MultiTableConstDataIterator::operator*() const
+{
+  ASKAPCHECK(hasMore(), "An attempt to access the accessor past the end of the iteration");
+  return *(*itsIterators[itsCurrent]);
+}
+
+/// @brief Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool MultiTableConstDataIterator::hasMore() const throw()
+{
+  return itsCurrent < itsIterators.size() && itsIterators[itsCurrent] && itsIterators[itsCurrent]->hasMore();
+}
+
+/// @brief advance the iterator one step further
+/// @return True if there are more data (so constructions like
+///         while(it.next()) {} are possible)
+casacore::Bool MultiTableConstDataIterator::next()
+{
+  if (!hasMore()) {
+      return false;
+  }
+  itsIterators[itsCurrent]->next();
+  if (itsTimeOrder) {
+      selectEarliest();
+  } else {
+      skipExhausted();
+  }
+  return hasMore();
+}
+
+/// @brief obtain iterator for the given measurement set
+/// @details The iterator is created if necessary, an existing one is rewound
+/// @param[in] index measurement set index
+void MultiTableConstDataIterator::startSource(size_t index)
+{
+  ASKAPDEBUGASSERT(index < itsIterators.size());
+  if (itsIterators[index]) {
+      itsIterators[index]->init();
+  } else {
+      itsIterators[index] = itsFactory(index);
+      ASKAPCHECK(itsIterators[index], "Unable to create iterator for measurement set "<<index);
+  }
+}
+
+/// @brief find the measurement set with the earliest accessor
+/// @details Used in the time order mode. itsCurrent is set to the number of
+/// measurement sets if all iterators are exhausted.
+void MultiTableConstDataIterator::selectEarliest()
+{
+  itsCurrent = itsIterators.size();
+  double earliest = 0.;
+  for (size_t index = 0; index < itsIterators.size(); ++index) {
+       const boost::shared_ptr<IConstDataIterator> &it = itsIterators[index];
+       ASKAPDEBUGASSERT(it);
+       if (it->hasMore()) {
+           const double time = (*it)->time();
+           if (itsCurrent == itsIterators.size() || time < earliest) {
+               itsCurrent = index;
+               earliest = time;
+           }
+       }
+  }
+}
+
+/// @brief skip exhausted measurement sets
+/// @details Used in the MS order mode, starts from itsCurrent
+void MultiTableConstDataIterator::skipExhausted()
+{
+  while (itsCurrent < itsIterators.size()) {
+         ASKAPDEBUGASSERT(itsIterators[itsCurrent]);
+         if (itsIterators[itsCurrent]->hasMore()) {
+             break;
+         }
+         itsIterators[itsCurrent].reset();
+         ++itsCurrent;
+         if (itsCurrent < itsIterators.size()) {
+             startSource(itsCurrent);
+         }
+  }
+}
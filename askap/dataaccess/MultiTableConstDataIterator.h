@@ -0,0 +1,125 @@
+/// @file
+///
+/// @brief Iterator over a number of measurement sets
+/// @details This iterator is created by MultiTableConstDataSource. It runs through
+/// the iterators of individual measurement sets either one after another or merging
+/// them by time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_MULTI_TABLE_CONST_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_MULTI_TABLE_CONST_DATA_ITERATOR_H
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Iterator over a number of measurement sets
+/// @details Iterators of individual measurement sets are obtained via the factory
+/// function given at construction. In the MS order, they are created when the
+/// iteration reaches the appropriate measurement set and released when it is
+/// exhausted, so only one measurement set is read at a time. In the time order,
+/// all iterators are created by init and the accessor with the earliest time is
+/// delivered at each step (the measurement sets are assumed to be time-ordered
+/// individually). Accessors with the same time are taken in the order of the
+/// measurement sets.
+/// @ingroup dataaccess_tab
+class MultiTableConstDataIterator : virtual public IConstDataIterator
+{
+public:
+  /// @brief type of the factory function
+  /// @details It returns an iterator for the measurement set with the given index
+  typedef boost::function<boost::shared_ptr<IConstDataIterator>(size_t)> IteratorFactory;
+
+  /// @brief set up the iterator
+  /// @param[in] nSources number of measurement sets
+  /// @param[in] factory function creating iterator for the given measurement set
+  /// @param[in] timeOrder if true, accessors are merged by time, otherwise
+  ///            measurement sets are iterated one after another
+  MultiTableConstDataIterator(size_t nSources, const IteratorFactory &factory, bool timeOrder);
+
+  /// @brief Restart the iteration from the beginning
+  virtual void init();
+
+  /// @brief operator* delivers a reference to data accessor (current chunk)
+  /// @return a reference to the current chunk
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// @brief Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// @brief advance the iterator one step further
+  /// @return True if there are more data (so constructions like
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @return index of the measurement set the current accessor belongs to
+  inline size_t currentSource() const { return itsCurrent; }
+
+private:
+  /// @brief obtain iterator for the given measurement set
+  /// @details The iterator is created if necessary, an existing one is rewound
+  /// @param[in] index measurement set index
+  void startSource(size_t index);
+
+  /// @brief find the measurement set with the earliest accessor
+  /// @details Used in the time order mode. itsCurrent is set to the number of
+  /// measurement sets if all iterators are exhausted.
+  void selectEarliest();
+
+  /// @brief skip exhausted measurement sets
+  /// @details Used in the MS order mode, starts from itsCurrent
+  void skipExhausted();
+
+  /// @brief function creating iterators for individual measurement sets
+  IteratorFactory itsFactory;
+
+  /// @brief true if accessors are merged by time
+  bool itsTimeOrder;
+
+  /// @brief iterators of individual measurement sets (empty if not yet created or released)
+  std::vector<boost::shared_ptr<IConstDataIterator> > itsIterators;
+
+  /// @brief index of the measurement set the current accessor belongs to
+  size_t itsCurrent;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MULTI_TABLE_CONST_DATA_ITERATOR_H
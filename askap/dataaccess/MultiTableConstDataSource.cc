@@ -0,0 +1,218 @@
+/// @file
+///
+/// @brief Read-only data source concatenating a number of measurement sets
+/// @details Observations are often split into a number of measurement sets (e.g. one
+/// per beam, per scheduling block or per time range). This data source presents them
+/// as a single dataset, iterated either one measurement set after another or merged
+/// by time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/MultiTableConstDataSource.h>
+#include <askap/dataaccess/MultiTableConstDataIterator.h>
+#include <askap/dataaccess/BasicDataConverter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+ASKAP_LOGGER(logger, ".MultiTableConstDataSource");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct a read-only data source object
+/// @details The first measurement set is opened straight away.
+/// @param[in] fnames file names of the measurement sets to use
+/// @param[in] dataColumn a name of the data column used by default
+///                       (default is DATA)
+/// @param[in] order order of iteration
+MultiTableConstDataSource::MultiTableConstDataSource(const std::vector<std::string> &fnames,
+                  const std::string &dataColumn, IterationOrder order) : itsFileNames(fnames),
+                  itsDataColumn(dataColumn), itsOrder(order), itsSources(fnames.size()),
+                  itsSharedSubtables(0), itsOpenIndex(0)
+{
+  ASKAPCHECK(itsFileNames.size() > 0, "MultiTableConstDataSource requires at least one measurement set");
+  dataSource(0);
+}
+
+/// @brief destructor, waits for the background thread (if any)
+MultiTableConstDataSource::~MultiTableConstDataSource()
+{
+  if (itsOpenThread) {
+      itsOpenThread->join();
+  }
+}
+
+/// @brief create a converter object corresponding to this type of the DataSource
+/// @details The same converter is used for all measurement sets.
+/// @return a shared pointer to a new DataConverter object
+IDataConverterPtr MultiTableConstDataSource::createConverter() const
+{
+  return IDataConverterPtr(new BasicDataConverter);
+}
+
+/// @brief get iterator over a selected part of the dataset
+/// @param[in] sel a shared pointer to the selector object defining
+///            which subset of the data is used (must be created by this data source)
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @return a shared pointer to DataIterator object
+boost::shared_ptr<IConstDataIterator> MultiTableConstDataSource::createConstIterator(const
+             IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv) const
+{
+  boost::shared_ptr<MultiTableDataSelector const> multiSel =
+           boost::dynamic_pointer_cast<MultiTableDataSelector const>(sel);
+  if (!multiSel || !conv) {
+      ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
+                 "converter are received by the createConstIterator method");
+  }
+  const MultiTableConstDataIterator::IteratorFactory factory =
+        boost::bind(&MultiTableConstDataSource::createSourceIterator, this, multiSel, conv, _1);
+  return boost::shared_ptr<IConstDataIterator>(new MultiTableConstDataIterator(nSources(), factory,
+                itsOrder == TIME_ORDER));
+}
+
+/// @brief create a selector object corresponding to this type of the DataSource
+/// @return a shared pointer to the DataSelector corresponding to this type of DataSource
+IDataSelectorPtr MultiTableConstDataSource::createSelector() const
+{
+  return IDataSelectorPtr(new MultiTableDataSelector);
+}
+
+/// @brief access the data source of the given measurement set
+/// @details The measurement set is opened if necessary. This gives access to
+/// table-specific methods like getAntennaPosition.
+/// @param[in] index measurement set index
+/// @return const reference to the data source
+const TableConstDataSource& MultiTableConstDataSource::source(size_t index) const
+{
+  return *dataSource(index);
+}
+
+/// @brief obtain the data source of the given measurement set
+/// @details The data source opened in the background is taken if it is the
+/// requested one, otherwise the measurement set is opened synchronously. The
+/// next measurement set is then opened in the background.
+/// @param[in] index measurement set index
+/// @return shared pointer to the data source
+const boost::shared_ptr<TableConstDataSource>& MultiTableConstDataSource::dataSource(size_t index) const
+{
+  ASKAPCHECK(index < itsSources.size(), "Measurement set index "<<index<<" exceeds the number of "
+             "measurement sets ("<<itsSources.size()<<")");
+  if (itsSources[index]) {
+      return itsSources[index];
+  }
+  if (itsOpenThread && itsOpenIndex == index) {
+      finishBackgroundOpen();
+  }
+  if (!itsSources[index]) {
+      itsSources[index] = openSource(index);
+      if (index > 0) {
+          itsSharedSubtables += itsSources[index]->shareIdenticalSubtables(*dataSource(0));
+      }
+  }
+  const size_t nextIndex = index + 1;
+  if (nextIndex < itsSources.size() && !itsSources[nextIndex] && !itsOpenThread) {
+      itsOpenIndex = nextIndex;
+      itsOpenThread.reset(new boost::thread(boost::bind(&MultiTableConstDataSource::openInBackground,
+                          this, nextIndex)));
+  }
+  return itsSources[index];
+}
+
+/// @brief create iterator for the given measurement set
+/// @param[in] sel recorded selection
+/// @param[in] conv converter
+/// @param[in] index measurement set index
+/// @return shared pointer to the iterator
+boost::shared_ptr<IConstDataIterator> MultiTableConstDataSource::createSourceIterator(
+             const boost::shared_ptr<MultiTableDataSelector const> &sel,
+             const IDataConverterConstPtr &conv, size_t index) const
+{
+  ASKAPDEBUGASSERT(sel);
+  const boost::shared_ptr<TableConstDataSource> &ds = dataSource(index);
+  ASKAPDEBUGASSERT(ds);
+  const IDataSelectorPtr tabSel = ds->createSelector();
+  sel->apply(*tabSel);
+  return ds->createConstIterator(tabSel, conv);
+}
+
+/// @brief open the given measurement set
+/// @param[in] index measurement set index
+/// @return shared pointer to the new data source
+boost::shared_ptr<TableConstDataSource> MultiTableConstDataSource::openSource(size_t index) const
+{
+  ASKAPDEBUGASSERT(index < itsFileNames.size());
+  return boost::shared_ptr<TableConstDataSource>(new TableConstDataSource(itsFileNames[index],
+                     itsDataColumn));
+}
+
+/// @brief body of the background thread
+/// @details Errors are stored to be reported in the main thread
+/// @param[in] index measurement set index
+void MultiTableConstDataSource::openInBackground(size_t index) const
+{
+  try {
+     itsOpenedSource = openSource(index);
+  }
+  catch (...) {
+     itsOpenError = std::current_exception();
+  }
+}
+
+/// @brief wait for the background thread and take its result
+void MultiTableConstDataSource::finishBackgroundOpen() const
+{
+  ASKAPDEBUGASSERT(itsOpenThread);
+  itsOpenThread->join();
+  itsOpenThread.reset();
+  if (itsOpenError) {
+      // the measurement set will be opened again in the main thread to report the problem there
+      try {
+         std::rethrow_exception(itsOpenError);
+      }
+      catch (const std::exception &ex) {
+         ASKAPLOG_WARN_STR(logger, "Failed to open "<<itsFileNames[itsOpenIndex]<<
+                           " in the background: "<<ex.what());
+      }
+      catch (...) {
+         ASKAPLOG_WARN_STR(logger, "Failed to open "<<itsFileNames[itsOpenIndex]<<" in the background");
+      }
+      itsOpenError = std::exception_ptr();
+  }
+  if (itsOpenedSource) {
+      ASKAPDEBUGASSERT(!itsSources[itsOpenIndex]);
+      itsSources[itsOpenIndex] = itsOpenedSource;
+      itsOpenedSource.reset();
+      if (itsOpenIndex > 0) {
+          itsSharedSubtables += itsSources[itsOpenIndex]->shareIdenticalSubtables(*dataSource(0));
+      }
+  }
+}
@@ -0,0 +1,191 @@
+/// @file
+///
+/// @brief Read-only data source concatenating a number of measurement sets
+/// @details Observations are often split into a number of measurement sets (e.g. one
+/// per beam, per scheduling block or per time range). This data source presents them
+/// as a single dataset, iterated either one measurement set after another or merged
+/// by time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_MULTI_TABLE_CONST_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_MULTI_TABLE_CONST_DATA_SOURCE_H
+
+// own includes
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/MultiTableDataSelector.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <vector>
+#include <string>
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Read-only data source concatenating a number of measurement sets
+/// @details Each measurement set is handled by its own TableConstDataSource, which is
+/// created when the iteration reaches this measurement set for the first time. The
+/// following measurement set is opened in a background thread while the current one
+/// is read. Handlers of the subtables which are identical to those of the first
+/// measurement set (antennas, spectral windows, polarisations and data descriptions)
+/// are shared rather than built again (see TableConstDataSource::shareIdenticalSubtables).
+/// Selection is recorded by MultiTableDataSelector and applied to each measurement set.
+/// Indices delivered by the accessors (antennas, feeds, etc) are those of the individual
+/// measurement sets, so the measurement sets are expected to be consistent.
+/// @ingroup dataaccess_tab
+class MultiTableConstDataSource : virtual public IConstDataSource,
+                                  public boost::noncopyable
+{
+public:
+  /// @brief order of iteration
+  enum IterationOrder {
+     /// measurement sets are iterated one after another in the given order
+     MS_ORDER,
+     /// accessors of all measurement sets are merged by time
+     TIME_ORDER
+  };
+
+  /// @brief construct a read-only data source object
+  /// @details The first measurement set is opened straight away.
+  /// @param[in] fnames file names of the measurement sets to use
+  /// @param[in] dataColumn a name of the data column used by default
+  ///                       (default is DATA)
+  /// @param[in] order order of iteration
+  explicit MultiTableConstDataSource(const std::vector<std::string> &fnames,
+                                     const std::string &dataColumn = "DATA",
+                                     IterationOrder order = MS_ORDER);
+
+  /// @brief destructor, waits for the background thread (if any)
+  virtual ~MultiTableConstDataSource();
+
+  /// @brief create a converter object corresponding to this type of the DataSource
+  /// @details The same converter is used for all measurement sets.
+  /// @return a shared pointer to a new DataConverter object
+  virtual IDataConverterPtr createConverter() const;
+
+  /// @brief get iterator over a selected part of the dataset
+  /// @param[in] sel a shared pointer to the selector object defining
+  ///            which subset of the data is used (must be created by this data source)
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @return a shared pointer to DataIterator object
+  virtual boost::shared_ptr<IConstDataIterator> createConstIterator(const
+             IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv) const;
+
+  // we need this to get access to the overloaded syntax in the base class
+  using IConstDataSource::createConstIterator;
+
+  /// @brief create a selector object corresponding to this type of the DataSource
+  /// @return a shared pointer to the DataSelector corresponding to this type of DataSource
+  virtual IDataSelectorPtr createSelector() const;
+
+  /// @return number of measurement sets
+  inline size_t nSources() const { return itsFileNames.size(); }
+
+  /// @brief access the data source of the given measurement set
+  /// @details The measurement set is opened if necessary. This gives access to
+  /// table-specific methods like getAntennaPosition.
+  /// @param[in] index measurement set index
+  /// @return const reference to the data source
+  const TableConstDataSource& source(size_t index) const;
+
+  /// @return number of subtable handlers shared with the first measurement set so far
+  inline size_t sharedSubtables() const { return itsSharedSubtables; }
+
+private:
+  /// @brief obtain the data source of the given measurement set
+  /// @details The data source opened in the background is taken if it is the
+  /// requested one, otherwise the measurement set is opened synchronously. The
+  /// next measurement set is then opened in the background.
+  /// @param[in] index measurement set index
+  /// @return shared pointer to the data source
+  const boost::shared_ptr<TableConstDataSource>& dataSource(size_t index) const;
+
+  /// @brief create iterator for the given measurement set
+  /// @param[in] sel recorded selection
+  /// @param[in] conv converter
+  /// @param[in] index measurement set index
+  /// @return shared pointer to the iterator
+  boost::shared_ptr<IConstDataIterator> createSourceIterator(
+             const boost::shared_ptr<MultiTableDataSelector const> &sel,
+             const IDataConverterConstPtr &conv, size_t index) const;
+
+  /// @brief open the given measurement set
+  /// @param[in] index measurement set index
+  /// @return shared pointer to the new data source
+  boost::shared_ptr<TableConstDataSource> openSource(size_t index) const;
+
+  /// @brief body of the background thread
+  /// @details Errors are stored to be reported in the main thread
+  /// @param[in] index measurement set index
+  void openInBackground(size_t index) const;
+
+  /// @brief wait for the background thread and take its result
+  void finishBackgroundOpen() const;
+
+  /// @brief file names of the measurement sets
+  std::vector<std::string> itsFileNames;
+
+  /// @brief data column used by default
+  std::string itsDataColumn;
+
+  /// @brief iteration order
+  IterationOrder itsOrder;
+
+  /// @brief data sources of individual measurement sets (empty until opened)
+  mutable std::vector<boost::shared_ptr<TableConstDataSource> > itsSources;
+
+  /// @brief number of subtable handlers shared so far
+  mutable size_t itsSharedSubtables;
+
+  /// @brief background thread opening the next measurement set
+  mutable boost::shared_ptr<boost::thread> itsOpenThread;
+
+  /// @brief index of the measurement set opened in the background
+  mutable size_t itsOpenIndex;
+
+  /// @brief data source opened in the background
+  /// @note it is accessed in the main thread only after the background thread is joined
+  mutable boost::shared_ptr<TableConstDataSource> itsOpenedSource;
+
+  /// @brief error encountered in the background thread, if any
+  mutable std::exception_ptr itsOpenError;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MULTI_TABLE_CONST_DATA_SOURCE_H
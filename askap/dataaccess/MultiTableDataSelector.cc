@@ -0,0 +1,197 @@
+/// @file
+///
+/// @brief Selector replayed on each measurement set of a composite data source
+/// @details Selectors of the table-based data sources are bound to a particular
+/// measurement set. This class records the selection and applies it to the selector
+/// of each measurement set.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/MultiTableDataSelector.h>
+
+// boost includes
+#include <boost/bind.hpp>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief Choose a single feed, the same for both antennae
+/// @param[in] feedID the sequence number of feed to choose
+void MultiTableDataSelector::chooseFeed(casacore::uInt feedID)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseFeed, _1, feedID));
+}
+
+/// @brief Choose a single baseline
+/// @param[in] ant1 the sequence number of the first antenna
+/// @param[in] ant2 the sequence number of the second antenna
+void MultiTableDataSelector::chooseBaseline(casacore::uInt ant1, casacore::uInt ant2)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseBaseline, _1, ant1, ant2));
+}
+
+/// @brief Choose all baselines to given antenna
+/// @param[in] ant the sequence number of antenna
+void MultiTableDataSelector::chooseAntenna(casacore::uInt ant)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseAntenna, _1, ant));
+}
+
+/// @brief Choose samples corresponding to a user-defined index
+/// @param[in] column name of the column of the measurement set
+/// @param[in] value selected value of the index
+void MultiTableDataSelector::chooseUserDefinedIndex(const std::string &column, const casacore::uInt value)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseUserDefinedIndex, _1, column, value));
+}
+
+/// @brief Choose autocorrelations only
+void MultiTableDataSelector::chooseAutoCorrelations()
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseAutoCorrelations, _1));
+}
+
+/// @brief Choose crosscorrelations only
+void MultiTableDataSelector::chooseCrossCorrelations()
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseCrossCorrelations, _1));
+}
+
+/// @brief Choose samples with uv-distance larger than threshold
+/// @param[in] uvDist threshold
+void MultiTableDataSelector::chooseMinUVDistance(casacore::Double uvDist)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseMinUVDistance, _1, uvDist));
+}
+
+/// @brief Choose samples with uv-distance larger than threshold
+/// @details Unlike chooseMinUVDistance, zero uv-distance samples are kept.
+/// @param[in] uvDist threshold
+void MultiTableDataSelector::chooseMinNonZeroUVDistance(casacore::Double uvDist)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseMinNonZeroUVDistance, _1, uvDist));
+}
+
+/// @brief Choose samples with uv-distance smaller than threshold
+/// @param[in] uvDist threshold
+void MultiTableDataSelector::chooseMaxUVDistance(casacore::Double uvDist)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseMaxUVDistance, _1, uvDist));
+}
+
+/// @brief Choose a subset of spectral channels
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the number of the first spectral channel to choose
+/// @param[in] nAvg a number of adjacent spectral channels to average
+void MultiTableDataSelector::chooseChannels(casacore::uInt nChan, casacore::uInt start, casacore::uInt nAvg)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseChannels, _1, nChan, start, nAvg));
+}
+
+/// @brief Choose a subset of frequencies
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the frequency of the first spectral channel to choose
+/// @param[in] freqInc an increment in terms of the frequency
+void MultiTableDataSelector::chooseFrequencies(casacore::uInt nChan,
+                  const casacore::MFrequency &start, const casacore::MVFrequency &freqInc)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseFrequencies, _1, nChan, start, freqInc));
+}
+
+/// @brief Choose a subset of radial velocities
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the velocity of the first spectral channel to choose
+/// @param[in] velInc an increment in terms of the radial velocity
+void MultiTableDataSelector::chooseVelocities(casacore::uInt nChan,
+                  const casacore::MVRadialVelocity &start, const casacore::MVRadialVelocity &velInc)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseVelocities, _1, nChan, start, velInc));
+}
+
+/// @brief Choose a single spectral window (also known as IF).
+/// @param[in] spWinID the ID of the spectral window to choose
+void MultiTableDataSelector::chooseSpectralWindow(casacore::uInt spWinID)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseSpectralWindow, _1, spWinID));
+}
+
+/// @brief Choose a time range given as MVEpoch objects
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop  the end of the chosen time interval
+void MultiTableDataSelector::chooseTimeRange(const casacore::MVEpoch &start, const casacore::MVEpoch &stop)
+{
+  void (IDataSelector::*method)(const casacore::MVEpoch&, const casacore::MVEpoch&) = &IDataSelector::chooseTimeRange;
+  itsSelection.push_back(boost::bind(method, _1, start, stop));
+}
+
+/// @brief Choose time range with respect to the origin of the converter
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop the end of the chosen time interval
+void MultiTableDataSelector::chooseTimeRange(casacore::Double start, casacore::Double stop)
+{
+  void (IDataSelector::*method)(casacore::Double, casacore::Double) = &IDataSelector::chooseTimeRange;
+  itsSelection.push_back(boost::bind(method, _1, start, stop));
+}
+
+/// @brief Choose polarization.
+/// @param pols a string describing the wanted polarization
+void MultiTableDataSelector::choosePolarizations(const casacore::String &pols)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::choosePolarizations, _1, pols));
+}
+
+/// @brief Choose cycles.
+/// @param[in] start the number of the first cycle to choose
+/// @param[in] stop the number of the last cycle to choose
+void MultiTableDataSelector::chooseCycles(casacore::uInt start, casacore::uInt stop)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseCycles, _1, start, stop));
+}
+
+/// @brief Choose a single scan number
+/// @param[in] scanNumber the scan number to choose
+void MultiTableDataSelector::chooseScanNumber(casacore::uInt scanNumber)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseScanNumber, _1, scanNumber));
+}
+
+/// @brief declare a subset of accessor fields which will be used
+/// @param[in] fields bitwise combination of AccessorFields values
+void MultiTableDataSelector::chooseAccessorFields(casacore::uInt fields)
+{
+  itsSelection.push_back(boost::bind(&IDataSelector::chooseAccessorFields, _1, fields));
+}
+
+/// @brief apply the recorded selection
+/// @param[in] sel selector of an individual measurement set
+void MultiTableDataSelector::apply(IDataSelector &sel) const
+{
+  for (std::vector<boost::function<void(IDataSelector&)> >::const_iterator ci = itsSelection.begin();
+       ci != itsSelection.end(); ++ci) {
+       (*ci)(sel);
+  }
+}
@@ -0,0 +1,164 @@
+/// @file
+///
+/// @brief Selector replayed on each measurement set of a composite data source
+/// @details Selectors of the table-based data sources are bound to a particular
+/// measurement set. MultiTableConstDataSource deals with a number of measurement sets,
+/// so its selector just records the selection and applies it to the selector of
+/// each measurement set when the iterator reaches it.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_MULTI_TABLE_DATA_SELECTOR_H
+#define ASKAP_ACCESSORS_MULTI_TABLE_DATA_SELECTOR_H
+
+// own includes
+#include <askap/dataaccess/IDataSelector.h>
+
+// boost includes
+#include <boost/function.hpp>
+
+// std includes
+#include <vector>
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Selector replayed on each measurement set of a composite data source
+/// @details All choose methods are recorded in order and replayed by apply on
+/// the selector of an individual measurement set. Errors (e.g. a selection not
+/// supported by the table-based selector) are, therefore, reported only when the
+/// selection is applied.
+/// @ingroup dataaccess_tab
+class MultiTableDataSelector : virtual public IDataSelector
+{
+public:
+  /// @brief Choose a single feed, the same for both antennae
+  /// @param[in] feedID the sequence number of feed to choose
+  virtual void chooseFeed(casacore::uInt feedID);
+
+  /// @brief Choose a single baseline
+  /// @param[in] ant1 the sequence number of the first antenna
+  /// @param[in] ant2 the sequence number of the second antenna
+  virtual void chooseBaseline(casacore::uInt ant1, casacore::uInt ant2);
+
+  /// @brief Choose all baselines to given antenna
+  /// @param[in] ant the sequence number of antenna
+  virtual void chooseAntenna(casacore::uInt ant);
+
+  /// @brief Choose samples corresponding to a user-defined index
+  /// @param[in] column name of the column of the measurement set
+  /// @param[in] value selected value of the index
+  virtual void chooseUserDefinedIndex(const std::string &column, const casacore::uInt value);
+
+  /// @brief Choose autocorrelations only
+  virtual void chooseAutoCorrelations();
+
+  /// @brief Choose crosscorrelations only
+  virtual void chooseCrossCorrelations();
+
+  /// @brief Choose samples with uv-distance larger than threshold
+  /// @param[in] uvDist threshold
+  virtual void chooseMinUVDistance(casacore::Double uvDist);
+
+  /// @brief Choose samples with uv-distance larger than threshold
+  /// @details Unlike chooseMinUVDistance, zero uv-distance samples are kept.
+  /// @param[in] uvDist threshold
+  virtual void chooseMinNonZeroUVDistance(casacore::Double uvDist);
+
+  /// @brief Choose samples with uv-distance smaller than threshold
+  /// @param[in] uvDist threshold
+  virtual void chooseMaxUVDistance(casacore::Double uvDist);
+
+  /// @brief Choose a subset of spectral channels
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the number of the first spectral channel to choose
+  /// @param[in] nAvg a number of adjacent spectral channels to average
+  virtual void chooseChannels(casacore::uInt nChan, casacore::uInt start, casacore::uInt nAvg = 1);
+
+  /// @brief Choose a subset of frequencies
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the frequency of the first spectral channel to choose
+  /// @param[in] freqInc an increment in terms of the frequency
+  virtual void chooseFrequencies(casacore::uInt nChan,
+             const casacore::MFrequency &start, const casacore::MVFrequency &freqInc);
+
+  /// @brief Choose a subset of radial velocities
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the velocity of the first spectral channel to choose
+  /// @param[in] velInc an increment in terms of the radial velocity
+  virtual void chooseVelocities(casacore::uInt nChan,
+             const casacore::MVRadialVelocity &start, const casacore::MVRadialVelocity &velInc);
+
+  /// @brief Choose a single spectral window (also known as IF).
+  /// @param[in] spWinID the ID of the spectral window to choose
+  virtual void chooseSpectralWindow(casacore::uInt spWinID);
+
+  /// @brief Choose a time range given as MVEpoch objects
+  /// @param[in] start the beginning of the chosen time interval
+  /// @param[in] stop  the end of the chosen time interval
+  virtual void chooseTimeRange(const casacore::MVEpoch &start, const casacore::MVEpoch &stop);
+
+  /// @brief Choose time range with respect to the origin of the converter
+  /// @param[in] start the beginning of the chosen time interval
+  /// @param[in] stop the end of the chosen time interval
+  virtual void chooseTimeRange(casacore::Double start, casacore::Double stop);
+
+  /// @brief Choose polarization.
+  /// @param pols a string describing the wanted polarization
+  virtual void choosePolarizations(const casacore::String &pols);
+
+  /// @brief Choose cycles.
+  /// @param[in] start the number of the first cycle to choose
+  /// @param[in] stop the number of the last cycle to choose
+  virtual void chooseCycles(casacore::uInt start, casacore::uInt stop);
+
+  /// @brief Choose a single scan number
+  /// @param[in] scanNumber the scan number to choose
+  virtual void chooseScanNumber(casacore::uInt scanNumber);
+
+  /// @brief declare a subset of accessor fields which will be used
+  /// @param[in] fields bitwise combination of AccessorFields values
+  virtual void chooseAccessorFields(casacore::uInt fields);
+
+  /// @brief apply the recorded selection
+  /// @param[in] sel selector of an individual measurement set
+  void apply(IDataSelector &sel) const;
+
+  /// @return true if nothing has been selected
+  inline bool empty() const { return itsSelection.empty(); }
+
+private:
+  /// @brief recorded calls in order
+  std::vector<boost::function<void(IDataSelector&)> > itsSelection;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_MULTI_TABLE_DATA_SELECTOR_H
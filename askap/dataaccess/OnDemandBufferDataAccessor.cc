@@ -36,6 +36,10 @@
 
 // own includes
 #include <askap/dataaccess/OnDemandBufferDataAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -43,8 +47,13 @@ using namespace askap::accessors;
 
 /// construct an object linked with the given const accessor
 /// @param[in] acc a reference to the associated accessor
-OnDemandBufferDataAccessor::OnDemandBufferDataAccessor(const IConstDataAccessor &acc) :
-      MetaDataAccessor(acc), itsUseBuffer(false) {}
+/// @param[in] rowsPerBlock number of rows copied together when the buffer is populated
+OnDemandBufferDataAccessor::OnDemandBufferDataAccessor(const IConstDataAccessor &acc,
+      casacore::uInt rowsPerBlock) : MetaDataAccessor(acc), itsRowsPerBlock(rowsPerBlock),
+      itsNumberOfCopiedBlocks(0), itsUseBuffer(false) 
+{
+  ASKAPCHECK(itsRowsPerBlock > 0, "Number of rows per block is supposed to be positive");
+}
   
 /// Read-only visibilities (a cube is nRow x nChannel x nPol; 
 /// each element is a complex visibility)
@@ -59,10 +68,12 @@ const casacore::Cube<casacore::Complex>& OnDemandBufferDataAccessor::visibility(
   if (itsUseBuffer) {
       lock.unlock();
       checkBufferSize();
+      completeBuffer();
       lock.lock();
   #else    
   if (itsUseBuffer) {
       checkBufferSize();
+      completeBuffer();
   #endif
       if (itsUseBuffer) {
           return itsBuffer;
@@ -91,16 +102,107 @@ casacore::Cube<casacore::Complex>& OnDemandBufferDataAccessor::rwVisibility()
   #endif
   }
   // itsUseBuffer may be changed by the call to checkBufferSize
-  if (!itsUseBuffer) {
+  if (!itsUseBuffer || itsNumberOfCopiedBlocks < itsBlockCopied.size()) {
       #ifdef _OPENMP
       boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
       #endif
-      itsBuffer = getROAccessor().visibility().copy();
-      itsUseBuffer = true;
+      copyRows(0, getROAccessor().nRow());
   }
   return itsBuffer;  
 }
 
+/// @brief read-only access to a range of rows
+/// @details Unlike visibility(), this method doesn't force copy of rows outside
+/// the requested range if the accessor is decoupled.
+/// @param[in] startRow first row 
+/// @param[in] nRows number of rows
+/// @return nRows x nChannel x nPol cube referencing the buffer or the original visibilities
+const casacore::Cube<casacore::Complex> OnDemandBufferDataAccessor::visibilityRows(casacore::uInt startRow,
+                                                     casacore::uInt nRows) const
+{
+  const IConstDataAccessor &acc = getROAccessor();
+  ASKAPCHECK(startRow + nRows <= acc.nRow(), "Requested rows "<<startRow<<" to "<<startRow + nRows<<
+             " are outside the accessor with "<<acc.nRow()<<" rows");
+  const casacore::Slice rowSlice(startRow, nRows);
+  if (itsUseBuffer) {
+      checkBufferSize();
+  }
+  #ifdef _OPENMP
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+  #endif
+  if (itsUseBuffer) {
+      copyRows(startRow, nRows);
+      return itsBuffer(rowSlice, casacore::Slice(), casacore::Slice());
+  }
+  return acc.visibility()(rowSlice, casacore::Slice(), casacore::Slice());
+}
+
+/// @brief read-write access to a range of rows
+/// @details This method decouples the accessor from the original one (as rwVisibility does),
+/// but copies only the blocks of rows covering the requested range.
+/// @param[in] startRow first row 
+/// @param[in] nRows number of rows
+/// @return nRows x nChannel x nPol cube referencing the buffer
+casacore::Cube<casacore::Complex> OnDemandBufferDataAccessor::rwVisibilityRows(casacore::uInt startRow, 
+                                                     casacore::uInt nRows)
+{
+  ASKAPCHECK(startRow + nRows <= getROAccessor().nRow(), "Requested rows "<<startRow<<" to "<<startRow + nRows<<
+             " are outside the accessor with "<<getROAccessor().nRow()<<" rows");
+  if (itsUseBuffer) {
+      checkBufferSize();
+  }
+  #ifdef _OPENMP
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+  #endif
+  copyRows(startRow, nRows);
+  return itsBuffer(casacore::Slice(startRow, nRows), casacore::Slice(), casacore::Slice());
+}
+
+/// @brief copy blocks of rows covering the given range to the buffer
+/// @details The buffer is set up if the accessor is not yet decoupled. Blocks copied 
+/// already are left intact.
+/// @param[in] startRow first row 
+/// @param[in] nRows number of rows
+/// @note The caller should hold the exclusive lock.
+void OnDemandBufferDataAccessor::copyRows(casacore::uInt startRow, casacore::uInt nRows) const
+{
+  const casacore::Cube<casacore::Complex> &vis = getROAccessor().visibility();
+  if (!itsUseBuffer) {
+      // buffer is not initialised here, all blocks are copied before they are used
+      itsBuffer.resize(vis.shape());
+      itsBlockCopied.assign((vis.nrow() + itsRowsPerBlock - 1) / itsRowsPerBlock, false);
+      itsNumberOfCopiedBlocks = 0;
+      itsUseBuffer = true;
+  }
+  if (nRows == 0) {
+      return;
+  }
+  const casacore::uInt lastBlock = (startRow + nRows - 1) / itsRowsPerBlock;
+  ASKAPDEBUGASSERT(lastBlock < itsBlockCopied.size());
+  for (casacore::uInt block = startRow / itsRowsPerBlock; block <= lastBlock; ++block) {
+       if (!itsBlockCopied[block]) {
+           const casacore::uInt firstRow = block * itsRowsPerBlock;
+           const casacore::uInt blockSize = std::min(itsRowsPerBlock, casacore::uInt(vis.nrow()) - firstRow);
+           const casacore::Slice rowSlice(firstRow, blockSize);
+           itsBuffer(rowSlice, casacore::Slice(), casacore::Slice()) = 
+                vis(rowSlice, casacore::Slice(), casacore::Slice());
+           itsBlockCopied[block] = true;
+           ++itsNumberOfCopiedBlocks;
+       }
+  }
+}
+
+/// @brief copy all blocks which are not copied yet (if decoupled)
+void OnDemandBufferDataAccessor::completeBuffer() const
+{
+  #ifdef _OPENMP
+  boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+  #endif
+  if (itsUseBuffer && itsNumberOfCopiedBlocks < itsBlockCopied.size()) {
+      copyRows(0, itsBuffer.nrow());
+  }
+}
+
 /// @brief a helper method to check whether the buffer has a correct size
 /// @details The wrong size means that the iterator has advanced and this
 /// accessor has to be coupled back to the read-only accessor which has been given at the 
@@ -135,5 +237,7 @@ void OnDemandBufferDataAccessor::discardCache()
   #endif
   itsUseBuffer = false;
   itsBuffer.resize(0,0,0);
+  itsBlockCopied.clear();
+  itsNumberOfCopiedBlocks = 0;
 }
 
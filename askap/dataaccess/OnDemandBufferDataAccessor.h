@@ -41,6 +41,9 @@
 #include <askap/dataaccess/MetaDataAccessor.h>
 #include <askap/dataaccess/IDataAccessor.h>
 
+// std includes
+#include <vector>
+
 // boost includes
 #include <boost/noncopyable.hpp>
 #ifdef _OPENMP
@@ -60,6 +63,11 @@ namespace accessors {
 /// copied to the internal buffer and the reference to this buffer is passed for all later calls
 /// to read-write and read-only methods until either the shape changes or discardCache method is
 /// called. The intention is to provide a similar functionality for the flagging methos
+///
+/// The copy is done in blocks of rows. Code modifying only a small fraction of rows can use
+/// rwVisibilityRows (and visibilityRows to read) instead of the whole-cube methods. Then only
+/// the blocks of rows covered by the request are copied, the remaining blocks are copied on 
+/// demand (at the latest when a whole-cube method is called).
 /// @ingroup dataaccess_hlp
 class OnDemandBufferDataAccessor : virtual public MetaDataAccessor,
                               virtual public IDataAccessor,
@@ -68,7 +76,9 @@ class OnDemandBufferDataAccessor : virtual public MetaDataAccessor,
 public:
   /// construct an object linked with the given const accessor
   /// @param[in] acc a reference to the associated accessor
-  explicit OnDemandBufferDataAccessor(const IConstDataAccessor &acc);
+  /// @param[in] rowsPerBlock number of rows copied together when the buffer is populated
+  explicit OnDemandBufferDataAccessor(const IConstDataAccessor &acc, 
+                                      casacore::uInt rowsPerBlock = 64);
   
   /// Read-only visibilities (a cube is nRow x nChannel x nPol; 
   /// each element is a complex visibility)
@@ -86,6 +96,27 @@ public:
   /// all visibility data
   ///
   virtual casacore::Cube<casacore::Complex>& rwVisibility();
+
+  /// @brief read-only access to a range of rows
+  /// @details Unlike visibility(), this method doesn't force copy of rows outside
+  /// the requested range if the accessor is decoupled.
+  /// @param[in] startRow first row 
+  /// @param[in] nRows number of rows
+  /// @return nRows x nChannel x nPol cube referencing the buffer or the original visibilities
+  const casacore::Cube<casacore::Complex> visibilityRows(casacore::uInt startRow, 
+                                                         casacore::uInt nRows) const;
+
+  /// @brief read-write access to a range of rows
+  /// @details This method decouples the accessor from the original one (as rwVisibility does),
+  /// but copies only the blocks of rows covering the requested range.
+  /// @param[in] startRow first row 
+  /// @param[in] nRows number of rows
+  /// @return nRows x nChannel x nPol cube referencing the buffer
+  casacore::Cube<casacore::Complex> rwVisibilityRows(casacore::uInt startRow, casacore::uInt nRows);
+
+  /// @brief number of blocks of rows copied to the buffer
+  /// @return number of blocks copied since the accessor has been decoupled
+  casacore::uInt numberOfCopiedBlocks() const throw() { return itsNumberOfCopiedBlocks; }
   
   /// @brief discard the content of the cache
   /// @details A call to this method would switch the accessor to the pristine state
@@ -108,6 +139,26 @@ private:
   /// accessor has to be coupled back to the read-only accessor which has been given at the 
   /// construction. If a wrong size is detected, itsUseBuffer flag is reset.
   void checkBufferSize() const;
+
+  /// @brief copy blocks of rows covering the given range to the buffer
+  /// @details The buffer is set up if the accessor is not yet decoupled. Blocks copied 
+  /// already are left intact.
+  /// @param[in] startRow first row 
+  /// @param[in] nRows number of rows
+  /// @note The caller should hold the exclusive lock.
+  void copyRows(casacore::uInt startRow, casacore::uInt nRows) const;
+
+  /// @brief copy all blocks which are not copied yet (if decoupled)
+  void completeBuffer() const;
+
+  /// @brief number of rows per block
+  casacore::uInt itsRowsPerBlock;
+
+  /// @brief flags showing which blocks have been copied to the buffer
+  mutable std::vector<bool> itsBlockCopied;
+
+  /// @brief number of true elements in itsBlockCopied
+  mutable casacore::uInt itsNumberOfCopiedBlocks;
   
   /// @brief is buffer used?
   /// @details true, if accessor is coupled 
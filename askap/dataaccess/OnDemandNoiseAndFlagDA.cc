@@ -34,6 +34,8 @@
 
 // own includes
 #include <askap/dataaccess/OnDemandNoiseAndFlagDA.h>
+#include <askap/dataaccess/ArraySwap.h>
+#include <askap/askap/AskapError.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -93,3 +95,36 @@ casacore::Cube<casacore::Bool>& OnDemandNoiseAndFlagDA::rwFlag()
   }
   return itsFlagBuffer;
 }
+
+/// @brief substitute noise by the given cube without copying
+/// @details The cube should have the same shape as the visibility cube. 
+/// The previous content of the noise buffer is returned in the given cube.
+/// @param[in] noise cube to take over, previous buffer on exit
+void OnDemandNoiseAndFlagDA::swapNoise(casacore::Cube<casacore::Complex> &noise)
+{
+  checkShape(noise.shape(), "noise");
+  swapValues(itsNoiseBuffer, noise);
+  itsNoiseSubstituted = true;
+}
+
+/// @brief substitute flags by the given cube without copying
+/// @details The cube should have the same shape as the visibility cube. 
+/// The previous content of the flag buffer is returned in the given cube.
+/// @param[in] flag cube to take over, previous buffer on exit
+void OnDemandNoiseAndFlagDA::swapFlag(casacore::Cube<casacore::Bool> &flag)
+{
+  checkShape(flag.shape(), "flag");
+  swapValues(itsFlagBuffer, flag);
+  itsFlagSubstituted = true;
+}
+
+/// @brief check that the cube conforms to the accessor
+/// @param[in] shape shape of the cube
+/// @param[in] what name of the cube for the error message
+void OnDemandNoiseAndFlagDA::checkShape(const casacore::IPosition &shape, const std::string &what) const
+{
+  const IConstDataAccessor &acc = getROAccessor();
+  ASKAPCHECK(shape == casacore::IPosition(3, acc.nRow(), acc.nChannel(), acc.nPol()), "The "<<what<<
+             " cube has shape "<<shape<<", the accessor has "<<acc.nRow()<<" rows, "<<acc.nChannel()<<
+             " channels and "<<acc.nPol()<<" polarisations");
+}
@@ -39,6 +39,9 @@
 #include <askap/dataaccess/MemBufferDataAccessor.h>
 #include <askap/dataaccess/IFlagAndNoiseDataAccessor.h>
 
+// std includes
+#include <string>
+
 
 namespace askap {
 	
@@ -81,8 +84,25 @@ public:
   /// @return a reference to nRow x nChannel x nPol cube with the flag
   ///         information. If True, the corresponding element is flagged.
   virtual casacore::Cube<casacore::Bool>& rwFlag();
+
+  /// @brief substitute noise by the given cube without copying
+  /// @details The cube should have the same shape as the visibility cube. 
+  /// The previous content of the noise buffer is returned in the given cube.
+  /// @param[in] noise cube to take over, previous buffer on exit
+  void swapNoise(casacore::Cube<casacore::Complex> &noise);
+
+  /// @brief substitute flags by the given cube without copying
+  /// @details The cube should have the same shape as the visibility cube. 
+  /// The previous content of the flag buffer is returned in the given cube.
+  /// @param[in] flag cube to take over, previous buffer on exit
+  void swapFlag(casacore::Cube<casacore::Bool> &flag);
   
 private:  
+  /// @brief check that the cube conforms to the accessor
+  /// @param[in] shape shape of the cube
+  /// @param[in] what name of the cube for the error message
+  void checkShape(const casacore::IPosition &shape, const std::string &what) const;
+
   /// @brief if true, the flag buffer is to be used instead of metadata
   bool itsFlagSubstituted;
   
@@ -0,0 +1,106 @@
+/// @file
+///
+/// @brief Bit-packed representation of the flag cube
+/// @details The flag cube delivered by the accessor uses one byte per sample.
+/// This class stores the same information with one bit per sample and keeps
+/// a per-row summary.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+// own includes
+#include <askap/dataaccess/PackedFlagCube.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty cube
+PackedFlagCube::PackedFlagCube() : itsNRow(0), itsNChan(0), itsNPol(0), itsWordsPerRow(0) {}
+
+/// @brief construct from the flag cube
+/// @param[in] flags nRow x nChannel x nPol cube of flags
+PackedFlagCube::PackedFlagCube(const casacore::Cube<casacore::Bool> &flags) : itsNRow(0), itsNChan(0),
+        itsNPol(0), itsWordsPerRow(0)
+{
+  assign(flags);
+}
+
+/// @brief fill the packed representation from the flag cube
+/// @param[in] flags nRow x nChannel x nPol cube of flags
+void PackedFlagCube::assign(const casacore::Cube<casacore::Bool> &flags)
+{
+  itsNRow = flags.nrow();
+  itsNChan = flags.ncolumn();
+  itsNPol = flags.nplane();
+  const size_t bitsPerRow = size_t(itsNChan) * itsNPol;
+  itsWordsPerRow = (bitsPerRow + 63) / 64;
+  itsBits.assign(itsWordsPerRow * itsNRow, 0);
+  itsRowSummary.assign(itsNRow, NONE_FLAGGED);
+  for (casacore::uInt row = 0; row < itsNRow; ++row) {
+       uint64_t *words = &itsBits[row * itsWordsPerRow];
+       size_t nFlagged = 0;
+       size_t bit = 0;
+       for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+            for (casacore::uInt pol = 0; pol < itsNPol; ++pol, ++bit) {
+                 if (flags(row, chan, pol)) {
+                     words[bit / 64] |= uint64_t(1) << (bit % 64);
+                     ++nFlagged;
+                 }
+            }
+       }
+       ASKAPDEBUGASSERT(bit == bitsPerRow);
+       if (nFlagged > 0) {
+           itsRowSummary[row] = nFlagged == bitsPerRow ? ALL_FLAGGED : PARTIALLY_FLAGGED;
+       }
+  }
+}
+
+/// @brief unpack into the flag cube
+/// @param[out] flags nRow x nChannel x nPol cube to fill (resized as necessary)
+void PackedFlagCube::expand(casacore::Cube<casacore::Bool> &flags) const
+{
+  flags.resize(itsNRow, itsNChan, itsNPol);
+  for (casacore::uInt row = 0; row < itsNRow; ++row) {
+       if (itsRowSummary[row] != PARTIALLY_FLAGGED) {
+           flags.yzPlane(row) = (itsRowSummary[row] == ALL_FLAGGED);
+           continue;
+       }
+       const uint64_t *words = rowBits(row);
+       size_t bit = 0;
+       for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+            for (casacore::uInt pol = 0; pol < itsNPol; ++pol, ++bit) {
+                 flags(row, chan, pol) = (words[bit / 64] >> (bit % 64)) & 1u;
+            }
+       }
+  }
+}
+
+/// @return memory used by the packed representation in bytes
+size_t PackedFlagCube::memoryUsage() const
+{
+  return itsBits.size() * sizeof(uint64_t) + itsRowSummary.size();
+}
@@ -0,0 +1,154 @@
+/// @file
+///
+/// @brief Bit-packed representation of the flag cube
+/// @details The flag cube delivered by the accessor uses one byte per sample.
+/// This class stores the same information with one bit per sample and keeps
+/// a per-row summary, so the consumer can skip fully flagged rows (or avoid checking
+/// unflagged rows) without scanning them.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_PACKED_FLAG_CUBE_H
+#define ASKAP_ACCESSORS_PACKED_FLAG_CUBE_H
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+
+// std includes
+#include <vector>
+#include <stdint.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Bit-packed representation of the flag cube
+/// @details The flag cube delivered by the accessor uses one byte per sample.
+/// This class stores the same information with one bit per sample and keeps
+/// a per-row summary, so the consumer can skip fully flagged rows (or avoid checking
+/// unflagged rows) without scanning them. Bits for each row are stored in a separate
+/// block (channel is the slowest varying index within the row, polarisation is the fastest).
+/// @ingroup dataaccess
+class PackedFlagCube {
+public:
+  /// @brief summary of flags for a row
+  enum RowSummary {
+     /// @brief no sample in the row is flagged
+     NONE_FLAGGED = 0,
+     /// @brief some samples are flagged
+     PARTIALLY_FLAGGED,
+     /// @brief all samples in the row are flagged
+     ALL_FLAGGED
+  };
+
+  /// @brief construct an empty cube
+  PackedFlagCube();
+
+  /// @brief construct from the flag cube
+  /// @param[in] flags nRow x nChannel x nPol cube of flags
+  explicit PackedFlagCube(const casacore::Cube<casacore::Bool> &flags);
+
+  /// @brief fill the packed representation from the flag cube
+  /// @param[in] flags nRow x nChannel x nPol cube of flags
+  void assign(const casacore::Cube<casacore::Bool> &flags);
+
+  /// @return number of rows
+  inline casacore::uInt nRow() const { return itsNRow; }
+
+  /// @return number of channels
+  inline casacore::uInt nChannel() const { return itsNChan; }
+
+  /// @return number of polarisations
+  inline casacore::uInt nPol() const { return itsNPol; }
+
+  /// @brief obtain flag for the given sample
+  /// @param[in] row row index
+  /// @param[in] chan channel index
+  /// @param[in] pol polarisation index
+  /// @return true if the sample is flagged
+  inline bool operator()(casacore::uInt row, casacore::uInt chan, casacore::uInt pol) const
+  {
+    const size_t bit = row * itsWordsPerRow * 64 + size_t(chan) * itsNPol + pol;
+    return (itsBits[bit / 64] >> (bit % 64)) & 1u;
+  }
+
+  /// @brief obtain flag summary for the given row
+  /// @param[in] row row index
+  /// @return summary of flags for the row
+  inline RowSummary rowSummary(casacore::uInt row) const { return RowSummary(itsRowSummary[row]); }
+
+  /// @brief check whether the whole row is flagged
+  /// @param[in] row row index
+  /// @return true if all samples of the row are flagged
+  inline bool allFlagged(casacore::uInt row) const { return itsRowSummary[row] == ALL_FLAGGED; }
+
+  /// @brief check whether the row has no flagged samples
+  /// @param[in] row row index
+  /// @return true if no sample of the row is flagged
+  inline bool noneFlagged(casacore::uInt row) const { return itsRowSummary[row] == NONE_FLAGGED; }
+
+  /// @brief obtain bits for the given row
+  /// @details Each row occupies wordsPerRow() 64-bit words, unused bits at the end of
+  /// the block are zero.
+  /// @param[in] row row index
+  /// @return pointer to the first word of the row
+  inline const uint64_t* rowBits(casacore::uInt row) const { return &itsBits[row * itsWordsPerRow]; }
+
+  /// @return number of 64-bit words per row
+  inline size_t wordsPerRow() const { return itsWordsPerRow; }
+
+  /// @brief unpack into the flag cube
+  /// @param[out] flags nRow x nChannel x nPol cube to fill (resized as necessary)
+  void expand(casacore::Cube<casacore::Bool> &flags) const;
+
+  /// @return memory used by the packed representation in bytes
+  size_t memoryUsage() const;
+
+private:
+  /// @brief number of rows
+  casacore::uInt itsNRow;
+
+  /// @brief number of channels
+  casacore::uInt itsNChan;
+
+  /// @brief number of polarisations
+  casacore::uInt itsNPol;
+
+  /// @brief number of 64-bit words per row
+  size_t itsWordsPerRow;
+
+  /// @brief packed flags
+  std::vector<uint64_t> itsBits;
+
+  /// @brief summary for each row (RowSummary values)
+  std::vector<unsigned char> itsRowSummary;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PACKED_FLAG_CUBE_H
@@ -0,0 +1,256 @@
+/// @file
+///
+/// @brief Time-indexed cache of the POINTING subtable
+/// @details The subtable is read once, the samples are sorted by antenna and time
+/// and the dish pointing direction is interpolated for any given time.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/PointingSubtableHandler.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/measures/TableMeasures/ArrayMeasColumn.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+
+// system includes
+#include <sys/mman.h>
+#include <unistd.h>
+#include <stdlib.h>
+
+ASKAP_LOGGER(logger, ".PointingSubtableHandler");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief read the subtable
+/// @param[in] ms a table object, which has a pointing subtable defined
+/// (i.e. this method accepts a main ms table).
+/// @param[in] spillDir directory for the memory-mapped file, empty string (default)
+///            means the samples are always kept in memory
+/// @param[in] spillThreshold minimum size of the samples in bytes to spill them
+PointingSubtableHandler::PointingSubtableHandler(const casacore::Table &ms, const std::string &spillDir,
+                          size_t spillThreshold) :
+       TableHolder(ms.keywordSet().asTable("POINTING")), itsSamples(0), itsNSamples(0), itsMapped(0)
+{
+  DataAccessStatistics::ScopedTimer timer("PointingSubtableHandler::buildIndex");
+  const casacore::uInt nRows = table().nrow();
+  if (!nRows) {
+      return;
+  }
+  casacore::ROArrayMeasColumn<casacore::MDirection> dirMeasCol(table(), "DIRECTION");
+  if (dirMeasCol.isRefVariable()) {
+      ASKAPTHROW(DataAccessError, "Variable reference frame of the DIRECTION column in the "
+                 "POINTING subtable is not supported");
+  }
+  itsFrame = dirMeasCol.getMeasRef();
+  // set up the time converter now, so the object isn't modified after construction
+  tableTime(casacore::MEpoch());
+
+  const casacore::Vector<casacore::Double> times = casacore::ROScalarColumn<casacore::Double>(table(),
+                                                   "TIME").getColumn();
+  const casacore::Vector<casacore::Double> intervals = casacore::ROScalarColumn<casacore::Double>(table(),
+                                                   "INTERVAL").getColumn();
+  const casacore::Vector<casacore::Int> antIDs = casacore::ROScalarColumn<casacore::Int>(table(),
+                                                   "ANTENNA_ID").getColumn();
+  casacore::ROArrayColumn<casacore::Double> dirCol(table(), "DIRECTION");
+
+  // sort by antenna and time, the order of rows is kept for equal times
+  std::vector<std::pair<std::pair<casacore::Int, casacore::Double>, casacore::uInt> > order;
+  order.reserve(nRows);
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       if (antIDs[row] < 0) {
+           ASKAPTHROW(DataAccessError, "Negative ANTENNA_ID="<<antIDs[row]<<" in row "<<row<<
+                      " of the POINTING subtable");
+       }
+       order.push_back(std::make_pair(std::make_pair(antIDs[row], times[row]), row));
+  }
+  std::stable_sort(order.begin(), order.end());
+
+  const casacore::uInt nAnt = static_cast<casacore::uInt>(order.back().first.first) + 1;
+  itsAntennaStart.assign(nAnt + 1, 0);
+  itsMemSamples.resize(nRows);
+  casacore::Array<casacore::Double> dir;
+  for (casacore::uInt i = 0; i < nRows; ++i) {
+       const casacore::uInt row = order[i].second;
+       dirCol.get(row, dir, casacore::True);
+       if ((dir.ndim() == 0) || (dir.shape()[0] != 2)) {
+           ASKAPTHROW(DataAccessError, "Unexpected shape "<<dir.shape()<<" of the DIRECTION cell in row "<<
+                      row<<" of the POINTING subtable");
+       }
+       // only the zero-order term of the polynomial is used
+       const casacore::Double *dirPtr = dir.data();
+       Sample &sample = itsMemSamples[i];
+       sample.itsTime = times[row];
+       sample.itsHalfInterval = intervals[row] / 2.;
+       sample.itsLong = dirPtr[0];
+       sample.itsLat = dirPtr[1];
+       ++itsAntennaStart[antIDs[row] + 1];
+  }
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       itsAntennaStart[ant + 1] += itsAntennaStart[ant];
+  }
+  itsNSamples = nRows;
+  itsSamples = &itsMemSamples[0];
+  if (spillDir.size() && (dataSize() >= spillThreshold)) {
+      if (spill(spillDir)) {
+          ASKAPLOG_DEBUG_STR(logger, "POINTING subtable with "<<itsNSamples<<" samples for "<<nAnt<<
+                      " antenna(s) is mapped from a temporary file in "<<spillDir);
+          return;
+      }
+  }
+  ASKAPLOG_DEBUG_STR(logger, "POINTING subtable with "<<itsNSamples<<" samples for "<<nAnt<<
+                  " antenna(s) is cached in memory, "<<dataSize()<<" bytes");
+}
+
+/// @brief destructor, unmaps the file (if any)
+PointingSubtableHandler::~PointingSubtableHandler()
+{
+  if (itsMapped != 0) {
+      munmap(itsMapped, dataSize());
+  }
+}
+
+/// @brief write sorted samples to a file and map it into memory
+/// @details The file is removed as soon as it is mapped, the mapping stays
+/// valid until munmap is called.
+/// @param[in] dir directory for the file
+/// @return true, if successful (samples are kept in memory otherwise)
+bool PointingSubtableHandler::spill(const std::string &dir)
+{
+  std::string pattern = dir + "/askap_pointing_XXXXXX";
+  std::vector<char> buf(pattern.begin(), pattern.end());
+  buf.push_back(0);
+  const int fd = mkstemp(&buf[0]);
+  if (fd < 0) {
+      ASKAPLOG_WARN_STR(logger, "Unable to create a temporary file in "<<dir<<
+                 ", the POINTING subtable is kept in memory");
+      return false;
+  }
+  std::remove(&buf[0]);
+  const char *src = reinterpret_cast<const char*>(itsSamples);
+  size_t written = 0;
+  while (written < dataSize()) {
+         const ssize_t res = write(fd, src + written, dataSize() - written);
+         if (res <= 0) {
+             break;
+         }
+         written += static_cast<size_t>(res);
+  }
+  void *addr = written == dataSize() ? mmap(0, dataSize(), PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  // the mapping stays valid after the file is closed
+  close(fd);
+  if (addr == MAP_FAILED) {
+      ASKAPLOG_WARN_STR(logger, "Unable to map the POINTING subtable via a temporary file in "<<dir<<
+                 ", it is kept in memory");
+      return false;
+  }
+  itsMapped = addr;
+  itsSamples = static_cast<const Sample*>(addr);
+  std::vector<Sample>().swap(itsMemSamples);
+  return true;
+}
+
+/// @brief comparison of a time with the time of a sample
+/// @param[in] time time of interest
+/// @param[in] sample sample to compare with
+/// @return true, if the time is earlier than the sample
+bool PointingSubtableHandler::earlier(casacore::Double time, const Sample &sample)
+{
+  return time < sample.itsTime;
+}
+
+/// @brief obtain pointing direction for the given antenna and time
+/// @param[in] ant antenna index
+/// @param[in] time epoch of interest
+/// @param[out] dir interpolated direction in the frame returned by directionFrame
+/// @return true, if the subtable has data for this antenna and time (dir is
+///         untouched otherwise)
+bool PointingSubtableHandler::getPointing(casacore::uInt ant, const casacore::MEpoch &time,
+                                          casacore::MVDirection &dir) const
+{
+  if (empty()) {
+      return false;
+  }
+  return getPointing(ant, tableTime(time), dir);
+}
+
+/// @brief obtain pointing direction for the given antenna and time
+/// @param[in] ant antenna index
+/// @param[in] time time in the frame and units of the TIME column
+/// @param[out] dir interpolated direction in the frame returned by directionFrame
+/// @return true, if the subtable has data for this antenna and time (dir is
+///         untouched otherwise)
+bool PointingSubtableHandler::getPointing(casacore::uInt ant, casacore::Double time,
+                                          casacore::MVDirection &dir) const
+{
+  if (ant >= nAntenna()) {
+      return false;
+  }
+  const Sample *first = itsSamples + itsAntennaStart[ant];
+  const Sample *last = itsSamples + itsAntennaStart[ant + 1];
+  if (first == last) {
+      return false;
+  }
+  // first sample which is later than the requested time
+  const Sample *after = std::upper_bound(first, last, time, &PointingSubtableHandler::earlier);
+  if (after == first) {
+      if (time < first->itsTime - first->itsHalfInterval) {
+          return false;
+      }
+      dir = casacore::MVDirection(first->itsLong, first->itsLat);
+      return true;
+  }
+  const Sample *before = after - 1;
+  if (after == last || before->itsTime == time) {
+      if (time > before->itsTime + before->itsHalfInterval) {
+          return false;
+      }
+      dir = casacore::MVDirection(before->itsLong, before->itsLat);
+      return true;
+  }
+  const double frac = (time - before->itsTime) / (after->itsTime - before->itsTime);
+  // longitude difference is taken the short way around
+  const double dLong = std::remainder(after->itsLong - before->itsLong, casacore::C::_2pi);
+  dir = casacore::MVDirection(before->itsLong + frac * dLong,
+                              before->itsLat + frac * (after->itsLat - before->itsLat));
+  return true;
+}
@@ -0,0 +1,174 @@
+/// @file
+///
+/// @brief Time-indexed cache of the POINTING subtable
+/// @details The POINTING subtable has one row per antenna per pointing sample and
+/// can be huge for on-the-fly mosaicing observations. This class reads the subtable
+/// once, sorts the samples by antenna and time and interpolates the dish pointing
+/// direction for any given time. For very large tables the sorted samples can be
+/// spilled into a memory-mapped temporary file.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_POINTING_SUBTABLE_HANDLER_H
+#define ASKAP_ACCESSORS_POINTING_SUBTABLE_HANDLER_H
+
+// own includes
+#include <askap/dataaccess/TimeDependentSubtable.h>
+#include <askap/dataaccess/TableHolder.h>
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/measures/Measures/MEpoch.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Time-indexed cache of the POINTING subtable
+/// @details The whole subtable is read in the constructor. Samples are grouped per
+/// antenna and sorted by time, so a direction for the given antenna and time is found
+/// by a binary search within the antenna's block. The direction is interpolated linearly
+/// between the neighbouring samples. Times before the first or after the last sample of
+/// the antenna are accepted within half of the sample's INTERVAL, otherwise no direction
+/// is returned and the caller is expected to fall back to the FIELD subtable.
+///
+/// Only the zero-order term of the DIRECTION polynomial is used. All samples should be
+/// in the same reference frame (variable reference codes are not supported).
+///
+/// If a spill directory is given and the sorted samples take more than the given
+/// threshold, they are written to a temporary file in that directory which is mapped
+/// into memory and removed straight away. The pages are then managed by the operating
+/// system and can be dropped under memory pressure. The object is not modified after
+/// construction and can be used by several iterators at the same time.
+/// @ingroup dataaccess_tab
+class PointingSubtableHandler : virtual public TimeDependentSubtable,
+                                virtual public TableHolder,
+                                public boost::noncopyable {
+public:
+  /// @brief read the subtable
+  /// @param[in] ms a table object, which has a pointing subtable defined
+  /// (i.e. this method accepts a main ms table).
+  /// @param[in] spillDir directory for the memory-mapped file, empty string (default)
+  ///            means the samples are always kept in memory
+  /// @param[in] spillThreshold minimum size of the samples in bytes to spill them
+  PointingSubtableHandler(const casacore::Table &ms, const std::string &spillDir = std::string(),
+                          size_t spillThreshold = 64u * 1024u * 1024u);
+
+  /// @brief destructor, unmaps the file (if any)
+  ~PointingSubtableHandler();
+
+  /// @return true, if the subtable has no samples
+  inline bool empty() const { return itsNSamples == 0; }
+
+  /// @return total number of samples
+  inline size_t nSamples() const { return itsNSamples; }
+
+  /// @brief number of antennas
+  /// @return the largest ANTENNA_ID found in the subtable plus one
+  inline casacore::uInt nAntenna() const { return itsAntennaStart.size() ? itsAntennaStart.size() - 1 : 0; }
+
+  /// @return true, if the samples are held in a memory-mapped file
+  inline bool isMapped() const { return itsMapped != 0; }
+
+  /// @return size of the samples in bytes (in memory or mapped)
+  inline size_t dataSize() const { return itsNSamples * sizeof(Sample); }
+
+  /// @return reference frame of the directions
+  inline const casacore::MDirection::Ref& directionFrame() const { return itsFrame; }
+
+  /// @brief obtain pointing direction for the given antenna and time
+  /// @param[in] ant antenna index
+  /// @param[in] time epoch of interest
+  /// @param[out] dir interpolated direction in the frame returned by directionFrame
+  /// @return true, if the subtable has data for this antenna and time (dir is
+  ///         untouched otherwise)
+  bool getPointing(casacore::uInt ant, const casacore::MEpoch &time, casacore::MVDirection &dir) const;
+
+  /// @brief obtain pointing direction for the given antenna and time
+  /// @param[in] ant antenna index
+  /// @param[in] time time in the frame and units of the TIME column
+  /// @param[out] dir interpolated direction in the frame returned by directionFrame
+  /// @return true, if the subtable has data for this antenna and time (dir is
+  ///         untouched otherwise)
+  bool getPointing(casacore::uInt ant, casacore::Double time, casacore::MVDirection &dir) const;
+
+private:
+  /// @brief single pointing sample, stored as is in the mapped file
+  struct Sample {
+     /// @brief time of the sample (native frame/units of the TIME column)
+     double itsTime;
+     /// @brief half of the time interval covered by the sample
+     double itsHalfInterval;
+     /// @brief longitude in radians
+     double itsLong;
+     /// @brief latitude in radians
+     double itsLat;
+  };
+
+  /// @brief comparison of a time with the time of a sample
+  /// @param[in] time time of interest
+  /// @param[in] sample sample to compare with
+  /// @return true, if the time is earlier than the sample
+  static bool earlier(casacore::Double time, const Sample &sample);
+
+  /// @brief write sorted samples to a file and map it into memory
+  /// @param[in] dir directory for the file
+  /// @return true, if successful (samples are kept in memory otherwise)
+  bool spill(const std::string &dir);
+
+  /// @brief samples held in memory, empty if spilled
+  std::vector<Sample> itsMemSamples;
+
+  /// @brief pointer to the first sample (in memory or mapped)
+  const Sample* itsSamples;
+
+  /// @brief total number of samples
+  size_t itsNSamples;
+
+  /// @brief index of the first sample for each antenna, nAntenna + 1 elements
+  std::vector<size_t> itsAntennaStart;
+
+  /// @brief start of the memory-mapped area, zero if samples are held in memory
+  void* itsMapped;
+
+  /// @brief reference frame of the directions
+  casacore::MDirection::Ref itsFrame;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_POINTING_SUBTABLE_HANDLER_H
@@ -0,0 +1,332 @@
+/// @file
+///
+/// @brief Conversion of polarisation products applied to whole cubes
+/// @details The polarisation products requested via choosePolarizations may differ
+/// from the correlations stored in the measurement set (e.g. Stokes I from XX and YY).
+/// This class holds the conversion matrix obtained from scimath::PolConverter and
+/// applies it to the visibility, flag and noise cubes in one pass over the data.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/PolarisationConversion.h>
+#include <askap/askap/AskapError.h>
+#include <askap/scimath/utils/PolConverter.h>
+
+// std includes
+#include <algorithm>
+#include <cmath>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief conversion matrix
+typedef float ConversionMatrix[PolarisationConversion::theirMaxPol][PolarisationConversion::theirMaxPol];
+
+/// @brief apply the conversion matrix of the given size to the planes of a cube
+/// @details Complex numbers are given as interleaved real and imaginary parts. The
+/// sizes are known at compile time, so the loops over products are unrolled and the
+/// loop over samples can be vectorised.
+/// @param[in] re real parts of the matrix
+/// @param[in] im imaginary parts of the matrix
+/// @param[in] in NIn planes of planeSize complex numbers each
+/// @param[out] out NOut planes of planeSize complex numbers each
+/// @param[in] planeSize number of complex numbers in one plane
+template<casacore::uInt NOut, casacore::uInt NIn>
+void applyMatrix(const ConversionMatrix &re, const ConversionMatrix &im, const float *in, float *out,
+                 size_t planeSize)
+{
+  float matRe[NOut][NIn];
+  float matIm[NOut][NIn];
+  for (casacore::uInt i = 0; i < NOut; ++i) {
+       for (casacore::uInt j = 0; j < NIn; ++j) {
+            matRe[i][j] = re[i][j];
+            matIm[i][j] = im[i][j];
+       }
+  }
+  for (size_t k = 0; k < planeSize; ++k) {
+       float inRe[NIn];
+       float inIm[NIn];
+       for (casacore::uInt j = 0; j < NIn; ++j) {
+            inRe[j] = in[2 * (j * planeSize + k)];
+            inIm[j] = in[2 * (j * planeSize + k) + 1];
+       }
+       for (casacore::uInt i = 0; i < NOut; ++i) {
+            float sumRe = 0.;
+            float sumIm = 0.;
+            for (casacore::uInt j = 0; j < NIn; ++j) {
+                 sumRe += matRe[i][j] * inRe[j] - matIm[i][j] * inIm[j];
+                 sumIm += matRe[i][j] * inIm[j] + matIm[i][j] * inRe[j];
+            }
+            out[2 * (i * planeSize + k)] = sumRe;
+            out[2 * (i * planeSize + k) + 1] = sumIm;
+       }
+  }
+}
+
+/// @brief apply the conversion matrix of arbitrary size to the planes of a cube
+/// @details This is the fallback for the shapes without compile-time sized version.
+/// @param[in] re real parts of the matrix
+/// @param[in] im imaginary parts of the matrix
+/// @param[in] nOut number of output planes
+/// @param[in] nIn number of input planes
+/// @param[in] in nIn planes of planeSize complex numbers each
+/// @param[out] out nOut planes of planeSize complex numbers each
+/// @param[in] planeSize number of complex numbers in one plane
+void applyMatrix(const ConversionMatrix &re, const ConversionMatrix &im, casacore::uInt nOut,
+                 casacore::uInt nIn, const float *in, float *out, size_t planeSize)
+{
+  for (casacore::uInt i = 0; i < nOut; ++i) {
+       float *dst = out + 2 * i * planeSize;
+       std::fill(dst, dst + 2 * planeSize, 0.f);
+       for (casacore::uInt j = 0; j < nIn; ++j) {
+            const float a = re[i][j];
+            const float b = im[i][j];
+            if ((a == 0.) && (b == 0.)) {
+                continue;
+            }
+            const float *src = in + 2 * j * planeSize;
+            for (size_t k = 0; k < planeSize; ++k) {
+                 dst[2 * k] += a * src[2 * k] - b * src[2 * k + 1];
+                 dst[2 * k + 1] += a * src[2 * k + 1] + b * src[2 * k];
+            }
+       }
+  }
+}
+
+} // anonymous namespace
+
+/// @brief set up the conversion
+/// @details An exception is thrown if the products can't be obtained from the given
+/// correlations (see canConvert).
+/// @param[in] stored polarisation products stored in the dataset
+/// @param[in] wanted polarisation products to obtain (in the order required)
+PolarisationConversion::PolarisationConversion(const casacore::Vector<casacore::Stokes::StokesTypes> &stored,
+                         const casacore::Vector<casacore::Stokes::StokesTypes> &wanted) :
+       itsNIn(stored.nelements()), itsNOut(wanted.nelements()), itsOutputTypes(wanted.copy())
+{
+  ASKAPCHECK((itsNIn > 0) && (itsNIn <= theirMaxPol), "Unsupported number of stored polarisation products: "<<
+             itsNIn);
+  ASKAPCHECK((itsNOut > 0) && (itsNOut <= theirMaxPol), "Unsupported number of requested polarisation products: "<<
+             itsNOut);
+  ASKAPCHECK(canConvert(stored, wanted), "Requested polarisation products can't be obtained from the "<<itsNIn<<
+             " stored correlations");
+  for (casacore::uInt out = 0; out < theirMaxPol; ++out) {
+       for (casacore::uInt in = 0; in < theirMaxPol; ++in) {
+            itsRe[out][in] = 0.;
+            itsIm[out][in] = 0.;
+       }
+  }
+  // columns of the matrix are the converted unit vectors
+  const scimath::PolConverter converter(stored, wanted);
+  casacore::Vector<casacore::Complex> unit(itsNIn);
+  for (casacore::uInt in = 0; in < itsNIn; ++in) {
+       unit.set(casacore::Complex(0., 0.));
+       unit[in] = casacore::Complex(1., 0.);
+       const casacore::Vector<casacore::Complex> column = converter(unit);
+       ASKAPDEBUGASSERT(column.nelements() == itsNOut);
+       for (casacore::uInt out = 0; out < itsNOut; ++out) {
+            itsRe[out][in] = std::real(column[out]);
+            itsIm[out][in] = std::imag(column[out]);
+       }
+  }
+}
+
+/// @brief check whether the conversion is possible
+/// @param[in] stored polarisation products stored in the dataset
+/// @param[in] wanted polarisation products to obtain
+/// @return true, if wanted products can be obtained from the stored ones
+bool PolarisationConversion::canConvert(const casacore::Vector<casacore::Stokes::StokesTypes> &stored,
+                         const casacore::Vector<casacore::Stokes::StokesTypes> &wanted)
+{
+  if ((stored.nelements() == 0) || (stored.nelements() > theirMaxPol) || (wanted.nelements() == 0) ||
+      (wanted.nelements() > theirMaxPol)) {
+      return false;
+  }
+  return scimath::PolConverter::canConvert(stored, wanted);
+}
+
+/// @brief obtain the element of the conversion matrix
+/// @param[in] out index of the output product
+/// @param[in] in index of the stored product
+/// @return coefficient of the stored product in the output product
+casacore::Complex PolarisationConversion::coefficient(casacore::uInt out, casacore::uInt in) const
+{
+  ASKAPDEBUGASSERT((out < itsNOut) && (in < itsNIn));
+  return casacore::Complex(itsRe[out][in], itsIm[out][in]);
+}
+
+/// @brief convert visibilities
+/// @param[in] in nRow x nChannel x nIn cube with the stored correlations
+/// @param[out] out nRow x nChannel x nOut cube to fill (resized if the shape doesn't match)
+void PolarisationConversion::convertVisibility(const casacore::Cube<casacore::Complex> &in,
+                                               casacore::Cube<casacore::Complex> &out) const
+{
+  ASKAPCHECK(in.nplane() == itsNIn, "Visibility cube has "<<in.nplane()<<" polarisation products, "<<
+             itsNIn<<" expected");
+  const casacore::IPosition shape(3, in.nrow(), in.ncolumn(), itsNOut);
+  if (!out.shape().isEqual(shape)) {
+      out.resize(shape);
+  }
+  const size_t planeSize = size_t(in.nrow()) * in.ncolumn();
+  if (planeSize == 0) {
+      return;
+  }
+  bool deleteIn = false;
+  bool deleteOut = false;
+  const casacore::Complex *inData = in.getStorage(deleteIn);
+  casacore::Complex *outData = out.getStorage(deleteOut);
+  const float *src = reinterpret_cast<const float*>(inData);
+  float *dst = reinterpret_cast<float*>(outData);
+  if ((itsNOut == 4) && (itsNIn == 4)) {
+      applyMatrix<4, 4>(itsRe, itsIm, src, dst, planeSize);
+  } else if ((itsNOut == 2) && (itsNIn == 2)) {
+      applyMatrix<2, 2>(itsRe, itsIm, src, dst, planeSize);
+  } else if ((itsNOut == 2) && (itsNIn == 4)) {
+      applyMatrix<2, 4>(itsRe, itsIm, src, dst, planeSize);
+  } else if ((itsNOut == 1) && (itsNIn == 2)) {
+      applyMatrix<1, 2>(itsRe, itsIm, src, dst, planeSize);
+  } else if ((itsNOut == 1) && (itsNIn == 4)) {
+      applyMatrix<1, 4>(itsRe, itsIm, src, dst, planeSize);
+  } else {
+      applyMatrix(itsRe, itsIm, itsNOut, itsNIn, src, dst, planeSize);
+  }
+  out.putStorage(outData, deleteOut);
+  in.freeStorage(inData, deleteIn);
+}
+
+/// @brief convert flags
+/// @param[in] in nRow x nChannel x nIn cube with the stored flags
+/// @param[out] out nRow x nChannel x nOut cube to fill (resized if the shape doesn't match)
+void PolarisationConversion::convertFlag(const casacore::Cube<casacore::Bool> &in,
+                                         casacore::Cube<casacore::Bool> &out) const
+{
+  ASKAPCHECK(in.nplane() == itsNIn, "Flag cube has "<<in.nplane()<<" polarisation products, "<<
+             itsNIn<<" expected");
+  const casacore::IPosition shape(3, in.nrow(), in.ncolumn(), itsNOut);
+  if (!out.shape().isEqual(shape)) {
+      out.resize(shape);
+  }
+  const size_t planeSize = size_t(in.nrow()) * in.ncolumn();
+  if (planeSize == 0) {
+      return;
+  }
+  bool deleteIn = false;
+  bool deleteOut = false;
+  const casacore::Bool *inData = in.getStorage(deleteIn);
+  casacore::Bool *outData = out.getStorage(deleteOut);
+  for (casacore::uInt i = 0; i < itsNOut; ++i) {
+       casacore::Bool *dst = outData + i * planeSize;
+       std::fill(dst, dst + planeSize, casacore::False);
+       for (casacore::uInt j = 0; j < itsNIn; ++j) {
+            if ((itsRe[i][j] == 0.) && (itsIm[i][j] == 0.)) {
+                continue;
+            }
+            const casacore::Bool *src = inData + j * planeSize;
+            for (size_t k = 0; k < planeSize; ++k) {
+                 dst[k] = dst[k] | src[k];
+            }
+       }
+  }
+  out.putStorage(outData, deleteOut);
+  in.freeStorage(inData, deleteIn);
+}
+
+/// @brief convert noise
+/// @param[in] in nRow x nChannel x nIn cube with the noise of the stored correlations
+/// @param[out] out nRow x nChannel x nOut cube to fill (resized if the shape doesn't match)
+void PolarisationConversion::convertNoise(const casacore::Cube<casacore::Complex> &in,
+                                          casacore::Cube<casacore::Complex> &out) const
+{
+  ASKAPCHECK(in.nplane() == itsNIn, "Noise cube has "<<in.nplane()<<" polarisation products, "<<
+             itsNIn<<" expected");
+  const casacore::IPosition shape(3, in.nrow(), in.ncolumn(), itsNOut);
+  if (!out.shape().isEqual(shape)) {
+      out.resize(shape);
+  }
+  const size_t planeSize = size_t(in.nrow()) * in.ncolumn();
+  if (planeSize == 0) {
+      return;
+  }
+  bool deleteIn = false;
+  bool deleteOut = false;
+  const casacore::Complex *inData = in.getStorage(deleteIn);
+  casacore::Complex *outData = out.getStorage(deleteOut);
+  const float *src = reinterpret_cast<const float*>(inData);
+  float *dst = reinterpret_cast<float*>(outData);
+  // variances add up, the real part of the coefficient mixes real parts of the noise
+  // and the imaginary part swaps them
+  for (casacore::uInt i = 0; i < itsNOut; ++i) {
+       float *dstPlane = dst + 2 * i * planeSize;
+       std::fill(dstPlane, dstPlane + 2 * planeSize, 0.f);
+       for (casacore::uInt j = 0; j < itsNIn; ++j) {
+            const float a = itsRe[i][j] * itsRe[i][j];
+            const float b = itsIm[i][j] * itsIm[i][j];
+            if ((a == 0.) && (b == 0.)) {
+                continue;
+            }
+            const float *srcPlane = src + 2 * j * planeSize;
+            for (size_t k = 0; k < planeSize; ++k) {
+                 const float re2 = srcPlane[2 * k] * srcPlane[2 * k];
+                 const float im2 = srcPlane[2 * k + 1] * srcPlane[2 * k + 1];
+                 dstPlane[2 * k] += a * re2 + b * im2;
+                 dstPlane[2 * k + 1] += a * im2 + b * re2;
+            }
+       }
+  }
+  const size_t nValues = 2 * planeSize * itsNOut;
+  for (size_t k = 0; k < nValues; ++k) {
+       dst[k] = std::sqrt(dst[k]);
+  }
+  out.putStorage(outData, deleteOut);
+  in.freeStorage(inData, deleteIn);
+}
+
+/// @brief convert noise given per row and polarisation
+/// @details The noise is assumed to be the same for real and imaginary parts, which
+/// is preserved by the conversion.
+/// @param[in] in nRow x nIn matrix with the noise of the stored correlations
+/// @param[out] out nRow x nOut matrix to fill (resized if the shape doesn't match)
+void PolarisationConversion::convertSigma(const casacore::Matrix<casacore::Float> &in,
+                                          casacore::Matrix<casacore::Float> &out) const
+{
+  ASKAPCHECK(in.ncolumn() == itsNIn, "Noise is given for "<<in.ncolumn()<<" polarisation products, "<<
+             itsNIn<<" expected");
+  if ((out.nrow() != in.nrow()) || (out.ncolumn() != itsNOut)) {
+      out.resize(in.nrow(), itsNOut);
+  }
+  for (casacore::uInt i = 0; i < itsNOut; ++i) {
+       for (casacore::uInt row = 0; row < in.nrow(); ++row) {
+            float sum = 0.;
+            for (casacore::uInt j = 0; j < itsNIn; ++j) {
+                 sum += (itsRe[i][j] * itsRe[i][j] + itsIm[i][j] * itsIm[i][j]) * in(row, j) * in(row, j);
+            }
+            out(row, i) = std::sqrt(sum);
+       }
+  }
+}
@@ -0,0 +1,136 @@
+/// @file
+///
+/// @brief Conversion of polarisation products applied to whole cubes
+/// @details The polarisation products requested via choosePolarizations may differ
+/// from the correlations stored in the measurement set (e.g. Stokes I from XX and YY).
+/// This class holds the conversion matrix obtained from scimath::PolConverter and
+/// applies it to the visibility, flag and noise cubes in one pass over the data.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_POLARISATION_CONVERSION_H
+#define ASKAP_ACCESSORS_POLARISATION_CONVERSION_H
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/measures/Measures/Stokes.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Conversion of polarisation products applied to whole cubes
+/// @details The conversion matrix (at most 4x4) is obtained once from scimath::PolConverter
+/// by converting the unit vectors. The cubes are stored with the polarisation as the slowest
+/// varying axis, so each output plane is a linear combination of contiguous input planes.
+/// The kernels loop over the samples of the plane with the matrix held in local variables,
+/// compile-time sized versions are used for the common (2x2, 4x4 and to/from single product)
+/// shapes, which the compiler can vectorise. An output product is flagged if any of the
+/// stored correlations it depends upon is flagged. Noise is propagated assuming independent
+/// errors of real and imaginary parts of the stored correlations (as done by PolConverter).
+/// @ingroup dataaccess_hlp
+class PolarisationConversion {
+public:
+  /// @brief set up the conversion
+  /// @details An exception is thrown if the products can't be obtained from the given
+  /// correlations (see canConvert).
+  /// @param[in] stored polarisation products stored in the dataset
+  /// @param[in] wanted polarisation products to obtain (in the order required)
+  PolarisationConversion(const casacore::Vector<casacore::Stokes::StokesTypes> &stored,
+                         const casacore::Vector<casacore::Stokes::StokesTypes> &wanted);
+
+  /// @brief check whether the conversion is possible
+  /// @param[in] stored polarisation products stored in the dataset
+  /// @param[in] wanted polarisation products to obtain
+  /// @return true, if wanted products can be obtained from the stored ones
+  static bool canConvert(const casacore::Vector<casacore::Stokes::StokesTypes> &stored,
+                         const casacore::Vector<casacore::Stokes::StokesTypes> &wanted);
+
+  /// @return number of stored polarisation products (planes of the input cubes)
+  inline casacore::uInt nIn() const { return itsNIn; }
+
+  /// @return number of products obtained by the conversion (planes of the output cubes)
+  inline casacore::uInt nOut() const { return itsNOut; }
+
+  /// @return polarisation products obtained by the conversion
+  inline const casacore::Vector<casacore::Stokes::StokesTypes>& outputTypes() const { return itsOutputTypes; }
+
+  /// @brief obtain the element of the conversion matrix
+  /// @param[in] out index of the output product
+  /// @param[in] in index of the stored product
+  /// @return coefficient of the stored product in the output product
+  casacore::Complex coefficient(casacore::uInt out, casacore::uInt in) const;
+
+  /// @brief convert visibilities
+  /// @param[in] in nRow x nChannel x nIn cube with the stored correlations
+  /// @param[out] out nRow x nChannel x nOut cube to fill (resized if the shape doesn't match)
+  void convertVisibility(const casacore::Cube<casacore::Complex> &in, casacore::Cube<casacore::Complex> &out) const;
+
+  /// @brief convert flags
+  /// @param[in] in nRow x nChannel x nIn cube with the stored flags
+  /// @param[out] out nRow x nChannel x nOut cube to fill (resized if the shape doesn't match)
+  void convertFlag(const casacore::Cube<casacore::Bool> &in, casacore::Cube<casacore::Bool> &out) const;
+
+  /// @brief convert noise
+  /// @param[in] in nRow x nChannel x nIn cube with the noise of the stored correlations
+  /// @param[out] out nRow x nChannel x nOut cube to fill (resized if the shape doesn't match)
+  void convertNoise(const casacore::Cube<casacore::Complex> &in, casacore::Cube<casacore::Complex> &out) const;
+
+  /// @brief convert noise given per row and polarisation
+  /// @details The noise is assumed to be the same for real and imaginary parts, which
+  /// is preserved by the conversion.
+  /// @param[in] in nRow x nIn matrix with the noise of the stored correlations
+  /// @param[out] out nRow x nOut matrix to fill (resized if the shape doesn't match)
+  void convertSigma(const casacore::Matrix<casacore::Float> &in, casacore::Matrix<casacore::Float> &out) const;
+
+  /// @brief maximum number of polarisation products supported
+  static const casacore::uInt theirMaxPol = 4;
+
+private:
+  /// @brief number of stored products
+  casacore::uInt itsNIn;
+
+  /// @brief number of output products
+  casacore::uInt itsNOut;
+
+  /// @brief real parts of the conversion matrix (output x stored)
+  float itsRe[theirMaxPol][theirMaxPol];
+
+  /// @brief imaginary parts of the conversion matrix (output x stored)
+  float itsIm[theirMaxPol][theirMaxPol];
+
+  /// @brief output products
+  casacore::Vector<casacore::Stokes::StokesTypes> itsOutputTypes;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_POLARISATION_CONVERSION_H
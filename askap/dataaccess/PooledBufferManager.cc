@@ -0,0 +1,248 @@
+/// @file
+///
+/// @brief Memory-based buffer manager using a pool of fixed-size slabs
+/// @details Read-write iterator (see IDataIterator) uses the concept
+/// of buffers to store scratch data. This implementation of IBufferManager
+/// keeps the buffers in memory using a pool of fixed-size slabs.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/PooledBufferManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <algorithm>
+
+ASKAP_LOGGER(logger, "");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct the pool
+/// @param[in] slabSize number of complex elements per slab
+/// @param[in] maxMemory maximum memory in bytes allocated for slabs, zero means no limit
+/// @param[in] allocator allocation policy for slabs, empty pointer means the global heap
+PooledBufferManager::PooledBufferManager(size_t slabSize, size_t maxMemory,
+                      const boost::shared_ptr<ArrayAllocator const> &allocator) :
+      itsSlabSize(slabSize), itsMaxSlabs(maxMemory / (slabSize * sizeof(casacore::Complex))),
+      itsAllocator(allocator), itsPeakSlabsInUse(0), itsSlabReuses(0)
+{
+  ASKAPCHECK(itsSlabSize > 0, "Slab size is supposed to be positive");
+  ASKAPCHECK(maxMemory == 0 || itsMaxSlabs > 0, "Memory limit of "<<maxMemory<<
+             " bytes doesn't fit a single slab of "<<itsSlabSize<<" elements");
+}
+
+/// @brief destructor, logs the statistics
+PooledBufferManager::~PooledBufferManager()
+{
+  if (itsSlabs.size()) {
+      ASKAPLOG_DEBUG_STR(logger, "Buffer pool utilisation: "<<itsSlabs.size()<<" slab(s) of "<<itsSlabSize<<
+                         " elements allocated, peak usage "<<itsPeakSlabsInUse<<" slab(s), "<<itsSlabReuses<<
+                         " reuse(s)");
+  }
+}
+
+/// @brief populate the cube with the data stored in the given buffer
+/// @details The method throws an exception if the requested buffer
+/// does not exist (prevents a shape mismatch)
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+void PooledBufferManager::readBuffer(casacore::Cube<casacore::Complex> &vis,
+                        const std::string &name, casacore::uInt index) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  std::map<std::string, std::map<casacore::uInt, Cell> >::const_iterator bufIt = itsCells.find(name);
+  ASKAPCHECK(bufIt != itsCells.end(), "Buffer "<<name<<" does not exist");
+  std::map<casacore::uInt, Cell>::const_iterator cellIt = bufIt->second.find(index);
+  ASKAPCHECK(cellIt != bufIt->second.end(), "Buffer "<<name<<" is not defined for index="<<index);
+  const Cell &cell = cellIt->second;
+  if (!vis.shape().isEqual(cell.itsShape)) {
+      vis.resize(cell.itsShape);
+  }
+  bool deleteIt = false;
+  casacore::Complex* data = vis.getStorage(deleteIt);
+  size_t remainder = vis.nelements();
+  casacore::Complex* dest = data;
+  for (std::vector<size_t>::const_iterator ci = cell.itsSlabs.begin();
+       ci != cell.itsSlabs.end(); ++ci) {
+       ASKAPDEBUGASSERT(*ci < itsSlabs.size());
+       const size_t count = std::min(remainder, itsSlabSize);
+       const casacore::Complex *slab = itsSlabs[*ci].data();
+       std::copy(slab, slab + count, dest);
+       dest += count;
+       remainder -= count;
+  }
+  ASKAPDEBUGASSERT(remainder == 0);
+  vis.putStorage(data, deleteIt);
+}
+
+/// @brief write the cube back to the given buffer
+/// @details This buffer is created on the first write operation
+/// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the complex visibility data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+void PooledBufferManager::writeBuffer(const casacore::Cube<casacore::Complex> &vis,
+                         const std::string &name, casacore::uInt index) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  Cell &cell = itsCells[name][index];
+  const size_t nSlabs = (vis.nelements() + itsSlabSize - 1) / itsSlabSize;
+  shrinkCell(cell, nSlabs);
+  try {
+     while (cell.itsSlabs.size() < nSlabs) {
+            cell.itsSlabs.push_back(acquireSlab());
+     }
+  }
+  catch (...) {
+     // don't leave a partially allocated cell behind
+     shrinkCell(cell, 0);
+     itsCells[name].erase(index);
+     throw;
+  }
+  cell.itsShape = vis.shape();
+  const size_t inUse = itsSlabs.size() - itsFreeSlabs.size();
+  if (inUse > itsPeakSlabsInUse) {
+      itsPeakSlabsInUse = inUse;
+  }
+
+  bool deleteIt = false;
+  const casacore::Complex* data = vis.getStorage(deleteIt);
+  size_t remainder = vis.nelements();
+  const casacore::Complex* src = data;
+  for (std::vector<size_t>::const_iterator ci = cell.itsSlabs.begin();
+       ci != cell.itsSlabs.end(); ++ci) {
+       const size_t count = std::min(remainder, itsSlabSize);
+       std::copy(src, src + count, itsSlabs[*ci].data());
+       src += count;
+       remainder -= count;
+  }
+  vis.freeStorage(data, deleteIt);
+}
+
+/// @brief check whether the particular buffer exists
+/// @param[in] name a name of the buffer to query
+/// @param[in] index a sequential index in the buffer
+/// @return true, if the buffer with the given name is present
+bool PooledBufferManager::bufferExists(const std::string &name, casacore::uInt index) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  std::map<std::string, std::map<casacore::uInt, Cell> >::const_iterator bufIt = itsCells.find(name);
+  if (bufIt == itsCells.end()) {
+      return false;
+  }
+  return bufIt->second.find(index) != bufIt->second.end();
+}
+
+/// @brief drop all cells of the given buffer
+/// @details Slabs used by the buffer are returned to the pool.
+/// @param[in] name a name of the buffer to release
+void PooledBufferManager::releaseBuffer(const std::string &name) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  std::map<std::string, std::map<casacore::uInt, Cell> >::iterator bufIt = itsCells.find(name);
+  if (bufIt != itsCells.end()) {
+      for (std::map<casacore::uInt, Cell>::iterator it = bufIt->second.begin();
+           it != bufIt->second.end(); ++it) {
+           shrinkCell(it->second, 0);
+      }
+      itsCells.erase(bufIt);
+  }
+}
+
+/// @return number of slabs allocated so far
+size_t PooledBufferManager::slabsAllocated() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsSlabs.size();
+}
+
+/// @return number of slabs currently holding data
+size_t PooledBufferManager::slabsInUse() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsSlabs.size() - itsFreeSlabs.size();
+}
+
+/// @return maximum number of slabs held at the same time
+size_t PooledBufferManager::peakSlabsInUse() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsPeakSlabsInUse;
+}
+
+/// @return number of times a slab was taken from the free list instead of being allocated
+size_t PooledBufferManager::slabReuses() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsSlabReuses;
+}
+
+/// @return memory in bytes allocated for slabs
+size_t PooledBufferManager::memoryAllocated() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsSlabs.size() * itsSlabSize * sizeof(casacore::Complex);
+}
+
+/// @brief obtain a slab from the free list or allocate a new one
+/// @return index of the slab
+/// @note the mutex should be locked by the caller
+size_t PooledBufferManager::acquireSlab() const
+{
+  if (itsFreeSlabs.size()) {
+      const size_t slab = itsFreeSlabs.back();
+      itsFreeSlabs.pop_back();
+      ++itsSlabReuses;
+      return slab;
+  }
+  if (itsMaxSlabs > 0 && itsSlabs.size() >= itsMaxSlabs) {
+      ASKAPTHROW(DataAccessError, "Memory limit for buffers is exceeded: all "<<itsSlabs.size()<<
+                 " slabs of "<<itsSlabSize<<" elements are in use");
+  }
+  itsSlabs.push_back(itsAllocator ? itsAllocator->allocate<casacore::Complex>(itsSlabSize) :
+                     casacore::Vector<casacore::Complex>(itsSlabSize));
+  return itsSlabs.size() - 1;
+}
+
+/// @brief return slabs to the free list
+/// @param[in] cell cell to shrink
+/// @param[in] nSlabs number of slabs to keep
+/// @note the mutex should be locked by the caller
+void PooledBufferManager::shrinkCell(Cell &cell, size_t nSlabs) const
+{
+  while (cell.itsSlabs.size() > nSlabs) {
+         itsFreeSlabs.push_back(cell.itsSlabs.back());
+         cell.itsSlabs.pop_back();
+  }
+}
@@ -0,0 +1,192 @@
+/// @file
+///
+/// @brief Memory-based buffer manager using a pool of fixed-size slabs
+/// @details Read-write iterator (see IDataIterator) uses the concept
+/// of buffers to store scratch data. This implementation of IBufferManager
+/// keeps the buffers in memory. Storage is taken from a pool of fixed-size slabs shared
+/// by all named buffers. Slabs released when a buffer shrinks or is dropped are reused
+/// for other buffers or iterations, so a major cycle loop allocates memory only once.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_POOLED_BUFFER_MANAGER_H
+#define ASKAP_ACCESSORS_POOLED_BUFFER_MANAGER_H
+
+// own includes
+#include <askap/dataaccess/IBufferManager.h>
+#include <askap/dataaccess/ArrayAllocator.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+#include <vector>
+#include <map>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief A class to manage buffers held in memory slabs
+/// @details Each buffer cell (a named buffer for a given iteration) occupies a number of
+/// slabs from the pool, enough to hold the cube. Slabs are never returned to the heap
+/// while the object is alive. They go to the free list when a cell is rewritten with a
+/// smaller cube or when the whole named buffer is released, and are taken from there
+/// before any new allocation. The total memory allocated can be capped, an exception is
+/// thrown if the cap is exceeded. Statistics are logged when the object is destroyed.
+/// Slabs can be allocated with the given policy (see ArrayAllocator), e.g. page-locked
+/// to be uploaded to an accelerator. As slabs are kept for the lifetime of the pool, the
+/// cost of placing the memory is paid once.
+/// @ingroup dataaccess_hlp
+class PooledBufferManager : virtual public IBufferManager
+{
+public:
+  /// @brief construct the pool
+  /// @param[in] slabSize number of complex elements per slab
+  /// @param[in] maxMemory maximum memory in bytes allocated for slabs, zero means no limit
+  /// @param[in] allocator allocation policy for slabs, empty pointer means the global heap
+  explicit PooledBufferManager(size_t slabSize = 65536, size_t maxMemory = 0,
+                      const boost::shared_ptr<ArrayAllocator const> &allocator =
+                      boost::shared_ptr<ArrayAllocator const>());
+
+  /// @brief destructor, logs the statistics
+  virtual ~PooledBufferManager();
+
+  /// @brief populate the cube with the data stored in the given buffer
+  /// @details The method throws an exception if the requested buffer
+  /// does not exist (prevents a shape mismatch)
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  virtual void readBuffer(casacore::Cube<casacore::Complex> &vis,
+                          const std::string &name,
+                          casacore::uInt index) const;
+
+  /// @brief write the cube back to the given buffer
+  /// @details This buffer is created on the first write operation
+  /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
+  ///            cube to fill with the complex visibility data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  virtual void writeBuffer(const casacore::Cube<casacore::Complex> &vis,
+                           const std::string &name,
+                           casacore::uInt index) const;
+
+  /// @brief check whether the particular buffer exists
+  /// @param[in] name a name of the buffer to query
+  /// @param[in] index a sequential index in the buffer
+  /// @return true, if the buffer with the given name is present
+  virtual bool bufferExists(const std::string &name,
+                            casacore::uInt index) const;
+
+  /// @brief drop all cells of the given buffer
+  /// @details Slabs used by the buffer are returned to the pool.
+  /// @param[in] name a name of the buffer to release
+  void releaseBuffer(const std::string &name) const;
+
+  /// @return number of elements per slab
+  inline size_t slabSize() const { return itsSlabSize;}
+
+  /// @return number of slabs allocated so far
+  size_t slabsAllocated() const;
+
+  /// @return number of slabs currently holding data
+  size_t slabsInUse() const;
+
+  /// @return maximum number of slabs held at the same time
+  size_t peakSlabsInUse() const;
+
+  /// @return number of times a slab was taken from the free list instead of being allocated
+  size_t slabReuses() const;
+
+  /// @return memory in bytes allocated for slabs
+  size_t memoryAllocated() const;
+
+  /// @return allocation policy for slabs, empty for the global heap
+  inline const boost::shared_ptr<ArrayAllocator const>& allocator() const { return itsAllocator;}
+
+private:
+  /// @brief a single buffer cell
+  struct Cell {
+     /// @brief shape of the cube
+     casacore::IPosition itsShape;
+     /// @brief indices of the slabs holding data, in order
+     std::vector<size_t> itsSlabs;
+  };
+
+  /// @brief obtain a slab from the free list or allocate a new one
+  /// @return index of the slab
+  /// @note the mutex should be locked by the caller
+  size_t acquireSlab() const;
+
+  /// @brief return slabs to the free list
+  /// @param[in] cell cell to shrink
+  /// @param[in] nSlabs number of slabs to keep
+  /// @note the mutex should be locked by the caller
+  void shrinkCell(Cell &cell, size_t nSlabs) const;
+
+  /// @brief number of elements per slab
+  size_t itsSlabSize;
+
+  /// @brief maximum number of slabs, zero means no limit
+  size_t itsMaxSlabs;
+
+  /// @brief storage
+  mutable std::vector<casacore::Vector<casacore::Complex> > itsSlabs;
+
+  /// @brief allocation policy for slabs, empty for the global heap
+  boost::shared_ptr<ArrayAllocator const> itsAllocator;
+
+  /// @brief indices of unused slabs
+  mutable std::vector<size_t> itsFreeSlabs;
+
+  /// @brief buffer cells, indexed by name and iteration
+  mutable std::map<std::string, std::map<casacore::uInt, Cell> > itsCells;
+
+  /// @brief maximum number of slabs in use at the same time
+  mutable size_t itsPeakSlabsInUse;
+
+  /// @brief number of slabs taken from the free list
+  mutable size_t itsSlabReuses;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_POOLED_BUFFER_MANAGER_H
@@ -0,0 +1,207 @@
+/// @file
+///
+/// @brief Cache of rotated uvw and delays shared between iterations
+/// @details This class keeps rotated uvw and delays between iterations, keyed by the
+/// identity of the chunk, the phase centre and the tangent point.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/RotatedUVWCache.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <limits>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty cache
+/// @param[in] maxBytes maximum memory used by the cached vectors in bytes
+RotatedUVWCache::RotatedUVWCache(size_t maxBytes) : itsMaxBytes(maxBytes), itsBytes(0),
+       itsHits(0), itsMisses(0)
+{
+  MemoryGovernor::instance().add(this);
+}
+
+/// @brief destructor, unregisters the cache from MemoryGovernor
+RotatedUVWCache::~RotatedUVWCache()
+{
+  MemoryGovernor::instance().remove(this);
+}
+
+/// @brief memory used by an entry
+/// @param[in] nRow number of rows
+/// @return size in bytes
+size_t RotatedUVWCache::entrySize(size_t nRow)
+{
+  return nRow * (sizeof(casacore::RigidVector<casacore::Double, 3>) + sizeof(casacore::Double));
+}
+
+/// @brief search for an entry
+/// @param[in] key identification of the chunk, phase centre and tangent point
+/// @param[out] uvw rotated uvw to fill (untouched if there is no such entry)
+/// @param[out] delays delays to fill (untouched if there is no such entry)
+/// @return true, if the entry has been found
+bool RotatedUVWCache::find(const std::string &key, casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+            casacore::Vector<casacore::Double> &delays) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const std::map<std::string, Entry>::const_iterator ci = itsEntries.find(key);
+  if (ci == itsEntries.end()) {
+      ++itsMisses;
+      return false;
+  }
+  // delays are changed in place when the image centre moves, so the caller gets a copy
+  uvw.resize(ci->second.itsUVW.nelements());
+  uvw = ci->second.itsUVW;
+  delays.resize(ci->second.itsDelays.nelements());
+  delays = ci->second.itsDelays;
+  itsUseOrder.remove(key);
+  itsUseOrder.push_front(key);
+  ci->second.itsLastUse = MemoryGovernor::instance().stamp();
+  ++itsHits;
+  return true;
+}
+
+/// @brief add an entry
+/// @details The vectors are copied. Nothing is done if the entry alone exceeds
+/// the memory limit.
+/// @param[in] key identification of the chunk, phase centre and tangent point
+/// @param[in] uvw rotated uvw
+/// @param[in] delays delays for the image centre at the tangent point
+void RotatedUVWCache::add(const std::string &key, const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+           const casacore::Vector<casacore::Double> &delays)
+{
+  ASKAPDEBUGASSERT(uvw.nelements() == delays.nelements());
+  const size_t size = entrySize(uvw.nelements());
+  if (size > itsMaxBytes) {
+      return;
+  }
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    const std::map<std::string, Entry>::iterator it = itsEntries.find(key);
+    if (it != itsEntries.end()) {
+        itsBytes -= entrySize(it->second.itsUVW.nelements());
+        itsEntries.erase(it);
+        itsUseOrder.remove(key);
+    }
+    while (itsBytes + size > itsMaxBytes) {
+           ASKAPDEBUGASSERT(itsUseOrder.size());
+           const std::map<std::string, Entry>::iterator lru = itsEntries.find(itsUseOrder.back());
+           ASKAPDEBUGASSERT(lru != itsEntries.end());
+           itsBytes -= entrySize(lru->second.itsUVW.nelements());
+           itsEntries.erase(lru);
+           itsUseOrder.pop_back();
+    }
+    Entry &entry = itsEntries[key];
+    entry.itsUVW = uvw.copy();
+    entry.itsDelays = delays.copy();
+    entry.itsLastUse = MemoryGovernor::instance().stamp();
+    itsBytes += size;
+    itsUseOrder.push_front(key);
+  }
+  // the governor may call back releaseOldest, so the lock has to be released first
+  MemoryGovernor::instance().enforce();
+}
+
+/// @brief drop all entries
+void RotatedUVWCache::clear()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsEntries.clear();
+  itsUseOrder.clear();
+  itsBytes = 0;
+}
+
+/// @return number of entries in the cache
+size_t RotatedUVWCache::size() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsEntries.size();
+}
+
+/// @return memory used by the cached vectors in bytes
+size_t RotatedUVWCache::memoryUsed() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsBytes;
+}
+
+/// @return number of successful searches
+size_t RotatedUVWCache::hits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsHits;
+}
+
+/// @return number of unsuccessful searches
+size_t RotatedUVWCache::misses() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsMisses;
+}
+
+/// @return name of the cache used in usage reports and in the parset
+std::string RotatedUVWCache::consumerName() const
+{
+  return "RotatedUVWCache";
+}
+
+/// @brief use stamp of the least recently used entry
+/// @return stamp obtained from MemoryGovernor::stamp or the largest possible value
+/// if the cache is empty
+casacore::uInt64 RotatedUVWCache::oldestUse() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (itsUseOrder.empty()) {
+      return std::numeric_limits<casacore::uInt64>::max();
+  }
+  const std::map<std::string, Entry>::const_iterator ci = itsEntries.find(itsUseOrder.back());
+  ASKAPDEBUGASSERT(ci != itsEntries.end());
+  return ci->second.itsLastUse;
+}
+
+/// @brief drop the least recently used entry
+/// @return memory released in bytes, 0 if the cache is empty
+size_t RotatedUVWCache::releaseOldest()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (itsUseOrder.empty()) {
+      return 0;
+  }
+  const std::map<std::string, Entry>::iterator lru = itsEntries.find(itsUseOrder.back());
+  ASKAPDEBUGASSERT(lru != itsEntries.end());
+  const size_t size = entrySize(lru->second.itsUVW.nelements());
+  itsBytes -= size;
+  itsEntries.erase(lru);
+  itsUseOrder.pop_back();
+  return size;
+}
@@ -0,0 +1,164 @@
+/// @file
+///
+/// @brief Cache of rotated uvw and delays shared between iterations
+/// @details UVWRotationHandler keeps the rotated uvw and delays for the current accessor
+/// only. Major cycles iterate over the same data with the same tangent point many times,
+/// recomputing identical rotations. This class keeps the results between iterations,
+/// keyed by the identity of the chunk, the phase centre and the tangent point. The
+/// memory used is limited, the least recently used entries are dropped first.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ROTATED_UVW_CACHE_H
+#define ASKAP_ACCESSORS_ROTATED_UVW_CACHE_H
+
+// own includes
+#include <askap/dataaccess/IMemoryConsumer.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+#include <map>
+#include <list>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Cache of rotated uvw and delays shared between iterations
+/// @details Delays are stored for the image centre coinciding with the tangent point,
+/// i.e. before any extra shift applied by UVWRotationHandler::delays. The key is built
+/// by the caller (see UVWRotationHandler) and should identify the rows of the chunk,
+/// their phase centre and the tangent point. The content is not checked against the
+/// measurement set, the cache should be released if uvw are modified.
+/// The cache is registered with MemoryGovernor, so its entries can also be dropped
+/// to keep the memory used by all caches within the process-wide budget.
+/// All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class RotatedUVWCache : virtual public IMemoryConsumer,
+                        public boost::noncopyable {
+public:
+  /// @brief construct an empty cache
+  /// @param[in] maxBytes maximum memory used by the cached vectors in bytes
+  explicit RotatedUVWCache(size_t maxBytes = 256u * 1024u * 1024u);
+
+  /// @brief destructor, unregisters the cache from MemoryGovernor
+  virtual ~RotatedUVWCache();
+
+  /// @brief search for an entry
+  /// @param[in] key identification of the chunk, phase centre and tangent point
+  /// @param[out] uvw rotated uvw to fill (untouched if there is no such entry)
+  /// @param[out] delays delays to fill (untouched if there is no such entry)
+  /// @return true, if the entry has been found
+  bool find(const std::string &key, casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+            casacore::Vector<casacore::Double> &delays) const;
+
+  /// @brief add an entry
+  /// @details The vectors are copied. Nothing is done if the entry alone exceeds
+  /// the memory limit.
+  /// @param[in] key identification of the chunk, phase centre and tangent point
+  /// @param[in] uvw rotated uvw
+  /// @param[in] delays delays for the image centre at the tangent point
+  void add(const std::string &key, const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+           const casacore::Vector<casacore::Double> &delays);
+
+  /// @brief drop all entries
+  void clear();
+
+  /// @return number of entries in the cache
+  size_t size() const;
+
+  /// @return memory used by the cached vectors in bytes
+  virtual size_t memoryUsed() const;
+
+  /// @return number of successful searches
+  size_t hits() const;
+
+  /// @return number of unsuccessful searches
+  size_t misses() const;
+
+  /// @return name of the cache used in usage reports and in the parset
+  virtual std::string consumerName() const;
+
+  /// @brief use stamp of the least recently used entry
+  /// @return stamp obtained from MemoryGovernor::stamp or the largest possible value
+  /// if the cache is empty
+  virtual casacore::uInt64 oldestUse() const;
+
+  /// @brief drop the least recently used entry
+  /// @return memory released in bytes, 0 if the cache is empty
+  virtual size_t releaseOldest();
+
+private:
+  /// @brief single cached entry
+  struct Entry {
+     /// @brief rotated uvw
+     casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+     /// @brief delays
+     casacore::Vector<casacore::Double> itsDelays;
+     /// @brief use stamp of the last search or addition
+     mutable casacore::uInt64 itsLastUse;
+  };
+
+  /// @brief memory used by an entry
+  /// @param[in] nRow number of rows
+  /// @return size in bytes
+  static size_t entrySize(size_t nRow);
+
+  /// @brief maximum memory used by the cached vectors
+  size_t itsMaxBytes;
+
+  /// @brief memory used by the cached vectors
+  size_t itsBytes;
+
+  /// @brief keys in the order of use, most recent first
+  mutable std::list<std::string> itsUseOrder;
+
+  /// @brief cached entries
+  std::map<std::string, Entry> itsEntries;
+
+  /// @brief number of successful searches
+  mutable size_t itsHits;
+
+  /// @brief number of unsuccessful searches
+  mutable size_t itsMisses;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ROTATED_UVW_CACHE_H
@@ -0,0 +1,124 @@
+/// @file
+///
+/// @brief Set of row ranges stored as runs
+/// @details This class is used to track rows of an accessor modified by the user
+/// (e.g. by a flagger), so only those rows are written back to the table.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/RowRangeSet.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief comparison of the end of a run with the row
+/// @param[in] range run to compare
+/// @param[in] row row to compare with
+/// @return true, if the run ends before the given row
+bool endsBefore(const RowRangeSet::Range &range, casacore::uInt row)
+{
+  return range.second < row;
+}
+
+} // anonymous namespace
+
+/// @brief add a range of rows
+/// @param[in] first first row to add
+/// @param[in] nRows number of rows to add
+void RowRangeSet::add(casacore::uInt first, casacore::uInt nRows)
+{
+  if (nRows == 0) {
+      return;
+  }
+  Range range(first, first + nRows);
+  // the first run which overlaps or touches the new one
+  std::vector<Range>::iterator begin = std::lower_bound(itsRanges.begin(), itsRanges.end(),
+                                                        range.first, endsBefore);
+  std::vector<Range>::iterator end = begin;
+  for (; end != itsRanges.end() && end->first <= range.second; ++end) {
+       range.first = std::min(range.first, end->first);
+       range.second = std::max(range.second, end->second);
+  }
+  if (begin == end) {
+      itsRanges.insert(begin, range);
+  } else {
+      *begin = range;
+      itsRanges.erase(begin + 1, end);
+  }
+}
+
+/// @brief remove a range of rows
+/// @param[in] first first row to remove
+/// @param[in] nRows number of rows to remove
+void RowRangeSet::remove(casacore::uInt first, casacore::uInt nRows)
+{
+  if (nRows == 0) {
+      return;
+  }
+  const casacore::uInt last = first + nRows;
+  std::vector<Range> result;
+  result.reserve(itsRanges.size() + 1);
+  for (std::vector<Range>::const_iterator ci = itsRanges.begin(); ci != itsRanges.end(); ++ci) {
+       if (ci->second <= first || ci->first >= last) {
+           result.push_back(*ci);
+           continue;
+       }
+       // parts of the run outside the removed range are kept
+       if (ci->first < first) {
+           result.push_back(Range(ci->first, first));
+       }
+       if (ci->second > last) {
+           result.push_back(Range(last, ci->second));
+       }
+  }
+  itsRanges.swap(result);
+}
+
+/// @return total number of rows in the set
+casacore::uInt RowRangeSet::nRows() const
+{
+  casacore::uInt result = 0;
+  for (std::vector<Range>::const_iterator ci = itsRanges.begin(); ci != itsRanges.end(); ++ci) {
+       result += ci->second - ci->first;
+  }
+  return result;
+}
+
+/// @brief check whether the row belongs to the set
+/// @param[in] row row to check
+/// @return true if the row is in the set
+bool RowRangeSet::contains(casacore::uInt row) const
+{
+  const std::vector<Range>::const_iterator ci = std::lower_bound(itsRanges.begin(), itsRanges.end(),
+                                                                 row + 1, endsBefore);
+  return ci != itsRanges.end() && ci->first <= row;
+}
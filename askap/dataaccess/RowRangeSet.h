@@ -0,0 +1,94 @@
+/// @file
+///
+/// @brief Set of row ranges stored as runs
+/// @details This class is used to track rows of an accessor modified by the user
+/// (e.g. by a flagger), so only those rows are written back to the table.
+/// Consecutive and overlapping ranges are merged into a single run.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ROW_RANGE_SET_H
+#define ASKAP_ACCESSORS_ROW_RANGE_SET_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+// std includes
+#include <vector>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Set of row ranges stored as runs
+/// @details Rows are stored as a sorted list of runs (the first row and the
+/// row following the last one), which don't overlap and are not adjacent.
+/// Therefore, a set covering all rows of an accessor takes just one element
+/// regardless of how it has been built.
+/// @ingroup dataaccess_hlp
+class RowRangeSet {
+public:
+  /// @brief a single run, the first row and the row following the last one
+  typedef std::pair<casacore::uInt, casacore::uInt> Range;
+
+  /// @brief add a range of rows
+  /// @param[in] first first row to add
+  /// @param[in] nRows number of rows to add
+  void add(casacore::uInt first, casacore::uInt nRows);
+
+  /// @brief remove a range of rows
+  /// @param[in] first first row to remove
+  /// @param[in] nRows number of rows to remove
+  void remove(casacore::uInt first, casacore::uInt nRows);
+
+  /// @brief remove all rows
+  inline void clear() { itsRanges.clear(); }
+
+  /// @return true if the set contains no rows
+  inline bool empty() const { return itsRanges.empty(); }
+
+  /// @return sorted runs of rows
+  inline const std::vector<Range>& ranges() const { return itsRanges; }
+
+  /// @return total number of rows in the set
+  casacore::uInt nRows() const;
+
+  /// @brief check whether the row belongs to the set
+  /// @param[in] row row to check
+  /// @return true if the row is in the set
+  bool contains(casacore::uInt row) const;
+
+private:
+  /// @brief sorted runs of rows
+  std::vector<Range> itsRanges;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ROW_RANGE_SET_H
@@ -0,0 +1,311 @@
+/// @file
+///
+/// @brief Row-range view of an accessor
+/// @details The views reference the data of the parent accessor, no copy is made.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/RowSliceAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Slice.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief take rows of a vector
+/// @param[in] in vector of the parent accessor
+/// @param[in] begin first row
+/// @param[in] end row following the last row
+/// @param[out] out vector referencing the given rows of the input
+template<typename T>
+void sliceRows(const casacore::Vector<T> &in, casacore::uInt begin, casacore::uInt end,
+               casacore::Vector<T> &out)
+{
+  ASKAPCHECK(end <= in.nelements(), "Row slice ["<<begin<<", "<<end<<") extends beyond "<<in.nelements()<<
+             " rows of the parent accessor");
+  if (begin == end) {
+      out.resize(0);
+  } else {
+      // the vector is sliced via a non-const reference, the data are not modified here
+      casacore::Vector<T> parent;
+      parent.reference(in);
+      out.reference(parent(casacore::Slice(begin, end - begin)));
+  }
+}
+
+/// @brief take rows of a cube
+/// @param[in] in cube of the parent accessor
+/// @param[in] begin first row
+/// @param[in] end row following the last row
+/// @param[out] out cube referencing the given rows of the input
+template<typename T>
+void sliceRows(const casacore::Cube<T> &in, casacore::uInt begin, casacore::uInt end,
+               casacore::Cube<T> &out)
+{
+  ASKAPCHECK(end <= in.nrow(), "Row slice ["<<begin<<", "<<end<<") extends beyond "<<in.nrow()<<
+             " rows of the parent accessor");
+  if ((begin == end) || (in.nelements() == 0)) {
+      out.resize(end - begin, in.ncolumn(), in.nplane());
+  } else {
+      casacore::Cube<T> parent;
+      parent.reference(in);
+      out.reference(parent(casacore::IPosition(3, begin, 0, 0),
+                           casacore::IPosition(3, end - 1, in.ncolumn() - 1, in.nplane() - 1)));
+  }
+}
+
+/// @brief object function filling a cached field with the slice of the parent's field
+/// @details Used with CachedAccessorField::value.
+template<typename T>
+struct FieldSlicer {
+  /// @brief type of the parent accessor method giving the field
+  typedef const T& (IConstDataAccessor::*Getter)() const;
+
+  /// @brief set up the object function
+  /// @param[in] parent parent accessor
+  /// @param[in] getter parent accessor method giving the field
+  /// @param[in] begin first row
+  /// @param[in] end row following the last row
+  FieldSlicer(const IConstDataAccessor &parent, Getter getter, casacore::uInt begin, casacore::uInt end) :
+      itsParent(parent), itsGetter(getter), itsBegin(begin), itsEnd(end) {}
+
+  /// @brief fill the field
+  /// @param[out] out field to fill
+  void operator()(T &out) const { sliceRows((itsParent.*itsGetter)(), itsBegin, itsEnd, out); }
+
+  /// @brief parent accessor
+  const IConstDataAccessor &itsParent;
+  /// @brief parent accessor method giving the field
+  Getter itsGetter;
+  /// @brief first row
+  casacore::uInt itsBegin;
+  /// @brief row following the last row
+  casacore::uInt itsEnd;
+};
+
+/// @brief helper function to create FieldSlicer
+/// @param[in] parent parent accessor
+/// @param[in] getter parent accessor method giving the field
+/// @param[in] begin first row
+/// @param[in] end row following the last row
+/// @return object function
+template<typename T>
+FieldSlicer<T> slicer(const IConstDataAccessor &parent, const T& (IConstDataAccessor::*getter)() const,
+                      casacore::uInt begin, casacore::uInt end)
+{
+  return FieldSlicer<T>(parent, getter, begin, end);
+}
+
+} // anonymous namespace
+
+/// @brief construct the view
+/// @param[in] parent accessor to take rows from (reference semantics)
+/// @param[in] begin first row of the view
+/// @param[in] end row following the last row of the view
+RowSliceAccessor::RowSliceAccessor(const IConstDataAccessor &parent, casacore::uInt begin, casacore::uInt end) :
+      itsParent(parent), itsBegin(begin), itsEnd(end)
+{
+  ASKAPCHECK(begin <= end, "Row slice should have non-negative length, you have ["<<begin<<", "<<end<<")");
+  ASKAPCHECK(end <= parent.nRow(), "Row slice ["<<begin<<", "<<end<<") extends beyond "<<parent.nRow()<<
+             " rows of the parent accessor");
+}
+
+/// @brief copy constructor
+/// @details The cached slices are not copied, they reference the parent data anyway
+/// and are formed again on demand.
+/// @param[in] other view to copy
+RowSliceAccessor::RowSliceAccessor(const RowSliceAccessor &other) : IConstDataAccessor(),
+      itsParent(other.itsParent), itsBegin(other.itsBegin), itsEnd(other.itsEnd) {}
+
+/// @brief split the rows of an accessor into views of nearly equal size
+/// @param[in] acc accessor to split
+/// @param[in] nParts number of views
+/// @return vector with nParts views (some of them are empty if nParts exceeds the number of rows)
+std::vector<RowSliceAccessor> RowSliceAccessor::split(const IConstDataAccessor &acc, casacore::uInt nParts)
+{
+  ASKAPCHECK(nParts > 0, "Number of row slices should be positive");
+  std::vector<RowSliceAccessor> result;
+  result.reserve(nParts);
+  const casacore::uInt nRow = acc.nRow();
+  for (casacore::uInt part = 0; part < nParts; ++part) {
+       result.push_back(RowSliceAccessor(acc, casacore::uInt(casacore::uInt64(part) * nRow / nParts),
+                                         casacore::uInt(casacore::uInt64(part + 1) * nRow / nParts)));
+  }
+  return result;
+}
+
+/// @return the number of rows in this view
+casacore::uInt RowSliceAccessor::nRow() const throw()
+{
+  return itsEnd - itsBegin;
+}
+
+/// @return the number of spectral channels (equal for all rows)
+casacore::uInt RowSliceAccessor::nChannel() const throw()
+{
+  return itsParent.nChannel();
+}
+
+/// @return the number of polarization products (equal for all rows)
+casacore::uInt RowSliceAccessor::nPol() const throw()
+{
+  return itsParent.nPol();
+}
+
+/// @return a reference to nRow x nChannel x nPol cube with visibilities
+const casacore::Cube<casacore::Complex>& RowSliceAccessor::visibility() const
+{
+  return itsVisibility.value(slicer(itsParent, &IConstDataAccessor::visibility, itsBegin, itsEnd));
+}
+
+/// @return a reference to nRow x nChannel x nPol cube with flags
+const casacore::Cube<casacore::Bool>& RowSliceAccessor::flag() const
+{
+  return itsFlag.value(slicer(itsParent, &IConstDataAccessor::flag, itsBegin, itsEnd));
+}
+
+/// @return a reference to nRow x nChannel x nPol cube with noise figures
+const casacore::Cube<casacore::Complex>& RowSliceAccessor::noise() const
+{
+  return itsNoise.value(slicer(itsParent, &IConstDataAccessor::noise, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector containing uvw-coordinates for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& RowSliceAccessor::uvw() const
+{
+  return itsUVW.value(slicer(itsParent, &IConstDataAccessor::uvw, itsBegin, itsEnd));
+}
+
+/// @brief uvw after rotation
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return uvw after rotation to the new coordinate system for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+RowSliceAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
+{
+  sliceRows(itsParent.rotatedUVW(tangentPoint), itsBegin, itsEnd, itsRotatedUVW);
+  return itsRotatedUVW;
+}
+
+/// @brief delay associated with uvw rotation
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+/// @return delays corresponding to the uvw rotation for each row
+const casacore::Vector<casacore::Double>& RowSliceAccessor::uvwRotationDelay(
+      const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
+{
+  sliceRows(itsParent.uvwRotationDelay(tangentPoint, imageCentre), itsBegin, itsEnd, itsDelays);
+  return itsDelays;
+}
+
+/// @return a reference to vector with the first antenna index for each row
+const casacore::Vector<casacore::uInt>& RowSliceAccessor::antenna1() const
+{
+  return itsAntenna1.value(slicer(itsParent, &IConstDataAccessor::antenna1, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with the second antenna index for each row
+const casacore::Vector<casacore::uInt>& RowSliceAccessor::antenna2() const
+{
+  return itsAntenna2.value(slicer(itsParent, &IConstDataAccessor::antenna2, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with the first feed index for each row
+const casacore::Vector<casacore::uInt>& RowSliceAccessor::feed1() const
+{
+  return itsFeed1.value(slicer(itsParent, &IConstDataAccessor::feed1, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with the second feed index for each row
+const casacore::Vector<casacore::uInt>& RowSliceAccessor::feed2() const
+{
+  return itsFeed2.value(slicer(itsParent, &IConstDataAccessor::feed2, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with position angles of the first feed for each row
+const casacore::Vector<casacore::Float>& RowSliceAccessor::feed1PA() const
+{
+  return itsFeed1PA.value(slicer(itsParent, &IConstDataAccessor::feed1PA, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with position angles of the second feed for each row
+const casacore::Vector<casacore::Float>& RowSliceAccessor::feed2PA() const
+{
+  return itsFeed2PA.value(slicer(itsParent, &IConstDataAccessor::feed2PA, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with pointing directions of the first antenna/feed
+const casacore::Vector<casacore::MVDirection>& RowSliceAccessor::pointingDir1() const
+{
+  return itsPointingDir1.value(slicer(itsParent, &IConstDataAccessor::pointingDir1, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with pointing directions of the second antenna/feed
+const casacore::Vector<casacore::MVDirection>& RowSliceAccessor::pointingDir2() const
+{
+  return itsPointingDir2.value(slicer(itsParent, &IConstDataAccessor::pointingDir2, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with pointing directions of the first dish centre
+const casacore::Vector<casacore::MVDirection>& RowSliceAccessor::dishPointing1() const
+{
+  return itsDishPointing1.value(slicer(itsParent, &IConstDataAccessor::dishPointing1, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with pointing directions of the second dish centre
+const casacore::Vector<casacore::MVDirection>& RowSliceAccessor::dishPointing2() const
+{
+  return itsDishPointing2.value(slicer(itsParent, &IConstDataAccessor::dishPointing2, itsBegin, itsEnd));
+}
+
+/// @return a reference to vector with frequencies of the parent accessor
+const casacore::Vector<casacore::Double>& RowSliceAccessor::frequency() const
+{
+  return itsParent.frequency();
+}
+
+/// @return a reference to vector with velocities of the parent accessor
+const casacore::Vector<casacore::Double>& RowSliceAccessor::velocity() const
+{
+  return itsParent.velocity();
+}
+
+/// @return time stamp of the parent accessor
+casacore::Double RowSliceAccessor::time() const
+{
+  return itsParent.time();
+}
+
+/// @return a reference to vector with polarisation types of the parent accessor
+const casacore::Vector<casacore::Stokes::StokesTypes>& RowSliceAccessor::stokes() const
+{
+  return itsParent.stokes();
+}
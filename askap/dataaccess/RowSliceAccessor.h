@@ -0,0 +1,246 @@
+/// @file
+///
+/// @brief Row-range view of an accessor
+/// @details A chunk of visibility data is delivered as a single accessor. To process the
+/// rows in parallel, each thread can work with its own view of a range of rows. The views
+/// reference the data of the parent accessor, no copy is made.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ROW_SLICE_ACCESSOR_H
+#define ASKAP_ACCESSORS_ROW_SLICE_ACCESSOR_H
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/CachedAccessorField.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Row-range view of an accessor
+/// @details This accessor delivers rows [begin, end) of the parent accessor. The row-based
+/// fields (visibilities, flags, noise, uvw, antenna and feed indices, position angles and
+/// pointings) reference the storage of the parent's fields, so creating a view is cheap and
+/// doesn't allocate memory for the data. The spectral fields and time are those of the parent.
+/// The parent accessor has to stay valid (i.e. the iterator must not be advanced) while
+/// the view is in use.
+///
+/// Each view slices the parent's fields on the first request and caches the result. Several
+/// views of the same parent can be used concurrently from different threads, provided the
+/// parent fields used by the views have been read beforehand from a single thread (see
+/// fetchFields), as filling the parent accessor itself is not thread-safe. Each view should
+/// be used by one thread at a time. Typical use is
+/// @code
+///    fetchFields(acc, IDataSelector::VISIBILITY | IDataSelector::FLAG);
+///    #pragma omp parallel for
+///    for (int part = 0; part < nParts; ++part) {
+///         const RowSliceAccessor slice = acc.rowSlice(part * acc.nRow() / nParts,
+///                                                     (part + 1) * acc.nRow() / nParts);
+///         ...
+///    }
+/// @endcode
+/// The rotated uvw and delays are sliced on every call, the parent has to have them
+/// computed for the same tangent point and image centre for concurrent use.
+/// @ingroup dataaccess_hlp
+class RowSliceAccessor : virtual public IConstDataAccessor
+{
+public:
+  /// @brief construct the view
+  /// @param[in] parent accessor to take rows from (reference semantics)
+  /// @param[in] begin first row of the view
+  /// @param[in] end row following the last row of the view
+  RowSliceAccessor(const IConstDataAccessor &parent, casacore::uInt begin, casacore::uInt end);
+
+  /// @brief copy constructor
+  /// @details The cached slices are not copied, they reference the parent data anyway
+  /// and are formed again on demand.
+  /// @param[in] other view to copy
+  RowSliceAccessor(const RowSliceAccessor &other);
+
+  /// @return parent accessor
+  inline const IConstDataAccessor& parent() const { return itsParent; }
+
+  /// @return first row of the view in the parent accessor
+  inline casacore::uInt begin() const { return itsBegin; }
+
+  /// @return row following the last row of the view in the parent accessor
+  inline casacore::uInt end() const { return itsEnd; }
+
+  /// @brief split the rows of an accessor into views of nearly equal size
+  /// @param[in] acc accessor to split
+  /// @param[in] nParts number of views
+  /// @return vector with nParts views (some of them are empty if nParts exceeds the number of rows)
+  static std::vector<RowSliceAccessor> split(const IConstDataAccessor &acc, casacore::uInt nParts);
+
+  // IConstDataAccessor interface
+
+  /// @return the number of rows in this view
+  virtual casacore::uInt nRow() const throw();
+
+  /// @return the number of spectral channels (equal for all rows)
+  virtual casacore::uInt nChannel() const throw();
+
+  /// @return the number of polarization products (equal for all rows)
+  virtual casacore::uInt nPol() const throw();
+
+  /// @return a reference to nRow x nChannel x nPol cube with visibilities
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// @return a reference to nRow x nChannel x nPol cube with flags
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+  /// @return a reference to nRow x nChannel x nPol cube with noise figures
+  virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// @return a reference to vector containing uvw-coordinates for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw() const;
+
+  /// @brief uvw after rotation
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @return uvw after rotation to the new coordinate system for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+          rotatedUVW(const casacore::MDirection &tangentPoint) const;
+
+  /// @brief delay associated with uvw rotation
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+  /// @return delays corresponding to the uvw rotation for each row
+  virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
+          const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const;
+
+  /// @return a reference to vector with the first antenna index for each row
+  virtual const casacore::Vector<casacore::uInt>& antenna1() const;
+
+  /// @return a reference to vector with the second antenna index for each row
+  virtual const casacore::Vector<casacore::uInt>& antenna2() const;
+
+  /// @return a reference to vector with the first feed index for each row
+  virtual const casacore::Vector<casacore::uInt>& feed1() const;
+
+  /// @return a reference to vector with the second feed index for each row
+  virtual const casacore::Vector<casacore::uInt>& feed2() const;
+
+  /// @return a reference to vector with position angles of the first feed for each row
+  virtual const casacore::Vector<casacore::Float>& feed1PA() const;
+
+  /// @return a reference to vector with position angles of the second feed for each row
+  virtual const casacore::Vector<casacore::Float>& feed2PA() const;
+
+  /// @return a reference to vector with pointing directions of the first antenna/feed
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir1() const;
+
+  /// @return a reference to vector with pointing directions of the second antenna/feed
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir2() const;
+
+  /// @return a reference to vector with pointing directions of the first dish centre
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing1() const;
+
+  /// @return a reference to vector with pointing directions of the second dish centre
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing2() const;
+
+  /// @return a reference to vector with frequencies of the parent accessor
+  virtual const casacore::Vector<casacore::Double>& frequency() const;
+
+  /// @return a reference to vector with velocities of the parent accessor
+  virtual const casacore::Vector<casacore::Double>& velocity() const;
+
+  /// @return time stamp of the parent accessor
+  virtual casacore::Double time() const;
+
+  /// @return a reference to vector with polarisation types of the parent accessor
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const;
+
+private:
+  /// @brief assignment is not supported
+  RowSliceAccessor& operator=(const RowSliceAccessor &);
+
+  /// @brief parent accessor
+  const IConstDataAccessor &itsParent;
+
+  /// @brief first row of the view
+  casacore::uInt itsBegin;
+
+  /// @brief row following the last row of the view
+  casacore::uInt itsEnd;
+
+  /// @brief sliced visibilities
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsVisibility;
+
+  /// @brief sliced flags
+  CachedAccessorField<casacore::Cube<casacore::Bool> > itsFlag;
+
+  /// @brief sliced noise
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsNoise;
+
+  /// @brief sliced uvw
+  CachedAccessorField<casacore::Vector<casacore::RigidVector<casacore::Double, 3> > > itsUVW;
+
+  /// @brief sliced first antenna indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsAntenna1;
+
+  /// @brief sliced second antenna indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsAntenna2;
+
+  /// @brief sliced first feed indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsFeed1;
+
+  /// @brief sliced second feed indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsFeed2;
+
+  /// @brief sliced position angles of the first feed
+  CachedAccessorField<casacore::Vector<casacore::Float> > itsFeed1PA;
+
+  /// @brief sliced position angles of the second feed
+  CachedAccessorField<casacore::Vector<casacore::Float> > itsFeed2PA;
+
+  /// @brief sliced pointing directions of the first antenna/feed
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsPointingDir1;
+
+  /// @brief sliced pointing directions of the second antenna/feed
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsPointingDir2;
+
+  /// @brief sliced pointing directions of the first dish centre
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsDishPointing1;
+
+  /// @brief sliced pointing directions of the second dish centre
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsDishPointing2;
+
+  /// @brief sliced rotated uvw (formed on every call)
+  mutable casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsRotatedUVW;
+
+  /// @brief sliced delays (formed on every call)
+  mutable casacore::Vector<casacore::Double> itsDelays;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ROW_SLICE_ACCESSOR_H
@@ -35,6 +35,12 @@
 #include <askap/dataaccess/SmearingAccessorAdapter.h>
 #include <askap/askap/AskapError.h>
 
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <cmath>
+
 namespace askap {
 
 namespace accessors {
@@ -43,7 +49,8 @@ namespace accessors {
 /// @param[in] acc a reference to the associated accessor
 SmearingAccessorAdapter::SmearingAccessorAdapter(const IConstDataAccessor &acc) :
    MetaDataAccessor(acc), MemBufferDataAccessor(acc), OnDemandNoiseAndFlagDA(acc), 
-   itsFrequencySubstituted(false) {}
+   itsFrequencySubstituted(false), itsSmearingValid(false), itsSmearingTangentType(0),
+   itsSmearingChannelWidth(0.), itsSmearingIntegrationTime(0.) {}
 
 /// Frequency for each channel
 /// @return a reference to vector containing frequencies for each
@@ -84,6 +91,133 @@ void SmearingAccessorAdapter::useFrequencyBuffer()
   itsFrequencyBuffer.resize(getROAccessor().nChannel()); 
 }
 
+/// @brief sinc function used for smearing factors
+/// @param[in] x argument
+/// @return sin(x)/x
+static inline casacore::Double smearingSinc(casacore::Double x)
+{
+  return std::abs(x) < 1e-8 ? 1. : std::sin(x) / x;
+}
+
+/// @brief exact comparison of two directions
+/// @param[in] dir1 first direction
+/// @param[in] dir2 second direction
+/// @return true, if all direction cosines are the same
+static inline bool sameDirection(const casacore::MVDirection &dir1, const casacore::MVDirection &dir2)
+{
+  return (dir1(0) == dir2(0)) && (dir1(1) == dir2(1)) && (dir1(2) == dir2(2));
+}
+
+/// @brief attenuation due to bandwidth and time smearing
+/// @details The factor for each row and channel is sinc(pi*dNu*tau) * sinc(pi*nu*dT*dTau/dt),
+/// where tau is the geometric delay of the given direction with respect to the tangent
+/// point, dNu is the channel width, nu is the channel frequency (see frequency), dT is the
+/// integration time and dTau/dt is the rate of change of the delay due to Earth rotation.
+/// The result is cached. It is recomputed only if the uvw's, frequencies or any of the
+/// parameters differ from those used for the cached value.
+/// @param[in] tangentPoint phase centre (uvw's are rotated to this point, see rotatedUVW)
+/// @param[in] dir direction of interest (e.g. source position) in the frame of tangentPoint
+/// @param[in] channelWidth channel width in the units of frequency (assumed to be Hz)
+/// @param[in] integrationTime integration time in seconds, zero means no time smearing
+/// @return a reference to nRow x nChannel matrix with attenuation factors
+const casacore::Matrix<casacore::Float>& SmearingAccessorAdapter::smearingFactors(
+               const casacore::MDirection &tangentPoint, const casacore::MVDirection &dir,
+               casacore::Double channelWidth, casacore::Double integrationTime) const
+{
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = rotatedUVW(tangentPoint);
+  const casacore::Vector<casacore::Double> &freq = frequency();
+  const casacore::MVDirection &tangent = tangentPoint.getValue();
+  const bool sameParameters = itsSmearingValid && (itsSmearingTangentType == tangentPoint.getRef().getType()) &&
+        sameDirection(itsSmearingTangentPoint, tangent) && sameDirection(itsSmearingDir, dir) &&
+        (itsSmearingChannelWidth == channelWidth) && (itsSmearingIntegrationTime == integrationTime);
+  // the inputs are compared even if the parameters differ, as this also stores them in the cache
+  if (smearingInputsUnchanged(uvw, freq) && sameParameters) {
+      return itsSmearingFactors;
+  }
+  itsSmearingTangentPoint = tangent;
+  itsSmearingTangentType = tangentPoint.getRef().getType();
+  itsSmearingDir = dir;
+  itsSmearingChannelWidth = channelWidth;
+  itsSmearingIntegrationTime = integrationTime;
+
+  // direction cosines with respect to the tangent point
+  const casacore::Double ra0 = tangent.getLong();
+  const casacore::Double dec0 = tangent.getLat();
+  const casacore::Double dRA = dir.getLong() - ra0;
+  const casacore::Double dec = dir.getLat();
+  const casacore::Double sinDec0 = std::sin(dec0);
+  const casacore::Double cosDec0 = std::cos(dec0);
+  const casacore::Double l = std::cos(dec) * std::sin(dRA);
+  const casacore::Double m = std::sin(dec) * cosDec0 - std::cos(dec) * sinDec0 * std::cos(dRA);
+  const casacore::Double nMinusOne = std::sin(dec) * sinDec0 + std::cos(dec) * cosDec0 * std::cos(dRA) - 1.;
+
+  // Earth rotation rate in radians per second
+  const casacore::Double omega = casacore::C::_2pi / 86164.0905;
+  const casacore::uInt nRow = itsSmearingU.size();
+  const casacore::uInt nChan = itsSmearingFreqs.size();
+
+  // the loops below work with contiguous arrays and have no dependencies between
+  // iterations, so they can be vectorised by the compiler
+  std::vector<casacore::Double> bandwidthFactor(nRow);
+  std::vector<casacore::Double> delayRate(nRow);
+  const casacore::Double bandwidthScale = casacore::C::pi * channelWidth / casacore::C::c;
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       const casacore::Double u = itsSmearingU[row];
+       const casacore::Double v = itsSmearingV[row];
+       const casacore::Double w = itsSmearingW[row];
+       bandwidthFactor[row] = smearingSinc(bandwidthScale * (l * u + m * v + nMinusOne * w));
+       // du/dt = omega*(w*cos(dec0) - v*sin(dec0)), dv/dt = omega*u*sin(dec0), dw/dt = -omega*u*cos(dec0)
+       delayRate[row] = omega * (l * (w * cosDec0 - v * sinDec0) + m * u * sinDec0 -
+                        nMinusOne * u * cosDec0) / casacore::C::c;
+  }
+
+  itsSmearingFactors.resize(nRow, nChan);
+  // matrix is stored column by column, so each channel is a contiguous block of rows
+  casacore::Float *factors = itsSmearingFactors.data();
+  for (casacore::uInt chan = 0; chan < nChan; ++chan, factors += nRow) {
+       const casacore::Double timeScale = casacore::C::pi * itsSmearingFreqs[chan] * integrationTime;
+       for (casacore::uInt row = 0; row < nRow; ++row) {
+            factors[row] = casacore::Float(bandwidthFactor[row] * smearingSinc(timeScale * delayRate[row]));
+       }
+  }
+  itsSmearingValid = true;
+  return itsSmearingFactors;
+}
+
+/// @brief check whether cached smearing factors can be reused
+/// @details If not, uvw's and frequencies are stored in the cache
+/// @param[in] uvw rotated uvw's
+/// @param[in] freq frequencies
+/// @return true, if the cached smearing factors correspond to the given uvw's and frequencies
+bool SmearingAccessorAdapter::smearingInputsUnchanged(
+               const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+               const casacore::Vector<casacore::Double> &freq) const
+{
+  bool unchanged = itsSmearingValid && (uvw.nelements() == itsSmearingU.size()) &&
+                   (freq.nelements() == itsSmearingFreqs.size());
+  for (casacore::uInt row = 0; unchanged && row < uvw.nelements(); ++row) {
+       unchanged = (uvw[row](0) == itsSmearingU[row]) && (uvw[row](1) == itsSmearingV[row]) &&
+                   (uvw[row](2) == itsSmearingW[row]);
+  }
+  for (casacore::uInt chan = 0; unchanged && chan < freq.nelements(); ++chan) {
+       unchanged = (freq[chan] == itsSmearingFreqs[chan]);
+  }
+  if (!unchanged) {
+      // store uvw's as separate arrays for the computation
+      itsSmearingValid = false;
+      itsSmearingU.resize(uvw.nelements());
+      itsSmearingV.resize(uvw.nelements());
+      itsSmearingW.resize(uvw.nelements());
+      for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+           itsSmearingU[row] = uvw[row](0);
+           itsSmearingV[row] = uvw[row](1);
+           itsSmearingW[row] = uvw[row](2);
+      }
+      itsSmearingFreqs.assign(freq.begin(), freq.end());
+  }
+  return unchanged;
+}
+
 
 } // namespace accessors
 
@@ -41,6 +41,12 @@
 
 // casa includes
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/measures/Measures/MDirection.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+
+// std includes
+#include <vector>
 
 namespace askap {
 	
@@ -84,12 +90,69 @@ public:
   /// (but doesn't copy the data)
   void useFrequencyBuffer();
 
-private:  
+  /// @brief attenuation due to bandwidth and time smearing
+  /// @details The factor for each row and channel is sinc(pi*dNu*tau) * sinc(pi*nu*dT*dTau/dt),
+  /// where tau is the geometric delay of the given direction with respect to the tangent
+  /// point, dNu is the channel width, nu is the channel frequency (see frequency), dT is the
+  /// integration time and dTau/dt is the rate of change of the delay due to Earth rotation.
+  /// The result is cached. It is recomputed only if the uvw's, frequencies or any of the
+  /// parameters differ from those used for the cached value.
+  /// @param[in] tangentPoint phase centre (uvw's are rotated to this point, see rotatedUVW)
+  /// @param[in] dir direction of interest (e.g. source position) in the frame of tangentPoint
+  /// @param[in] channelWidth channel width in the units of frequency (assumed to be Hz)
+  /// @param[in] integrationTime integration time in seconds, zero means no time smearing
+  /// @return a reference to nRow x nChannel matrix with attenuation factors
+  const casacore::Matrix<casacore::Float>& smearingFactors(const casacore::MDirection &tangentPoint,
+               const casacore::MVDirection &dir, casacore::Double channelWidth,
+               casacore::Double integrationTime) const;
+
+private:
+  /// @brief check whether cached smearing factors can be reused
+  /// @details If not, uvw's and frequencies are stored in the cache
+  /// @param[in] uvw rotated uvw's
+  /// @param[in] freq frequencies
+  /// @return true, if the cached smearing factors correspond to the given uvw's and frequencies
+  bool smearingInputsUnchanged(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                               const casacore::Vector<casacore::Double> &freq) const;
+  
   /// @brief if true, the frequency buffer is to be used instead of the original metadata
   bool itsFrequencySubstituted;
   
   /// @brief buffer for noise (used if itsNoiseSubstituted is true)
   casacore::Vector<casacore::Double> itsFrequencyBuffer;  
+
+  /// @brief true, if cached smearing factors are valid
+  mutable bool itsSmearingValid;
+
+  /// @brief cached smearing factors (nRow x nChannel)
+  mutable casacore::Matrix<casacore::Float> itsSmearingFactors;
+
+  /// @brief u coordinates used for the cached smearing factors
+  mutable std::vector<casacore::Double> itsSmearingU;
+
+  /// @brief v coordinates used for the cached smearing factors
+  mutable std::vector<casacore::Double> itsSmearingV;
+
+  /// @brief w coordinates used for the cached smearing factors
+  mutable std::vector<casacore::Double> itsSmearingW;
+
+  /// @brief frequencies used for the cached smearing factors
+  mutable std::vector<casacore::Double> itsSmearingFreqs;
+
+  /// @brief tangent point used for the cached smearing factors
+  mutable casacore::MVDirection itsSmearingTangentPoint;
+
+  /// @brief frame type of the tangent point used for the cached smearing factors
+  mutable casacore::uInt itsSmearingTangentType;
+
+  /// @brief direction used for the cached smearing factors
+  mutable casacore::MVDirection itsSmearingDir;
+
+  /// @brief channel width used for the cached smearing factors
+  mutable casacore::Double itsSmearingChannelWidth;
+
+  /// @brief integration time used for the cached smearing factors
+  mutable casacore::Double itsSmearingIntegrationTime;
 };
 
 } // namespace accessors
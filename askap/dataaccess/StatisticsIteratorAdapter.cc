@@ -0,0 +1,112 @@
+/// @file
+///
+/// @brief Iterator adapter accumulating statistics of the data as a side effect
+/// @details This adapter gathers flag, amplitude and noise statistics while the data
+/// are iterated over for other purposes.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/StatisticsIteratorAdapter.h>
+#include <askap/dataaccess/TableConstDataAccessor.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <vector>
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief setup with the given iterator
+/// @param[in] iter shared pointer to iterator to be wrapped
+/// @param[in] nThreads number of threads processing each accessor
+StatisticsIteratorAdapter::StatisticsIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter,
+                                     casacore::uInt nThreads) : DataIteratorAdapter(iter), itsNThreads(nThreads)
+{
+  ASKAPCHECK(iter, "An attempt to initialise StatisticsIteratorAdapter with empty shared pointer");
+  ASKAPCHECK(itsNThreads > 0, "StatisticsIteratorAdapter needs at least one thread");
+}
+
+/// @brief restart the iteration from the beginning
+/// @details The statistics accumulated so far are reset.
+void StatisticsIteratorAdapter::init()
+{
+  itsStatistics.reset();
+  DataIteratorAdapter::init();
+}
+
+/// @brief advance the iterator one step further
+/// @details The current accessor is added to the statistics first.
+/// @return True if there are more data (so constructions like
+///         while(it.next()) {} are possible)
+casacore::Bool StatisticsIteratorAdapter::next()
+{
+  if (hasMore()) {
+      accumulateCurrent();
+  }
+  return DataIteratorAdapter::next();
+}
+
+/// @brief add the current accessor to the statistics
+void StatisticsIteratorAdapter::accumulateCurrent()
+{
+  const IConstDataAccessor &acc = *roIterator();
+  const casacore::uInt nRow = acc.nRow();
+  // accessor fields are filled on demand, this has to be done before the threads start
+  // bit-packed flags are not updated if the flags are changed via the read-write interface
+  const TableConstDataAccessor *tableAcc = canWrite() ? 0 : dynamic_cast<const TableConstDataAccessor*>(&acc);
+  const PackedFlagCube *packedFlags = tableAcc != 0 ? &tableAcc->packedFlag() : 0;
+  if (packedFlags == 0) {
+      acc.flag();
+  }
+  acc.visibility();
+  acc.noise();
+  acc.antenna1();
+  acc.antenna2();
+  const casacore::uInt nThreads = std::min(itsNThreads, std::max(nRow, 1u));
+  if (nThreads == 1) {
+      itsStatistics.accumulate(acc, 0, nRow, packedFlags);
+      return;
+  }
+  std::vector<VisibilityStatistics> partial(nThreads);
+  boost::thread_group threads;
+  const casacore::uInt rowsPerThread = (nRow + nThreads - 1) / nThreads;
+  for (casacore::uInt thread = 0; thread < nThreads; ++thread) {
+       const casacore::uInt startRow = std::min(thread * rowsPerThread, nRow);
+       const casacore::uInt endRow = std::min(startRow + rowsPerThread, nRow);
+       threads.create_thread(boost::bind(&VisibilityStatistics::accumulate, &partial[thread],
+                             boost::cref(acc), startRow, endRow, packedFlags));
+  }
+  threads.join_all();
+  for (casacore::uInt thread = 0; thread < nThreads; ++thread) {
+       itsStatistics.merge(partial[thread]);
+  }
+}
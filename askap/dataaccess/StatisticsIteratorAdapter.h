@@ -0,0 +1,98 @@
+/// @file
+///
+/// @brief Iterator adapter accumulating statistics of the data as a side effect
+/// @details Quality assessment computes flag fractions, amplitude moments and noise
+/// summaries with a separate loop over the data. This adapter gathers the same
+/// statistics while the data are iterated over for other purposes, splitting the
+/// rows of each accessor between a number of threads.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_STATISTICS_ITERATOR_ADAPTER_H
+#define ASKAP_ACCESSORS_STATISTICS_ITERATOR_ADAPTER_H
+
+// own includes
+#include <askap/dataaccess/DataIteratorAdapter.h>
+#include <askap/dataaccess/VisibilityStatistics.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Iterator adapter accumulating statistics of the data as a side effect
+/// @details Each accessor is added to the statistics (see VisibilityStatistics) when the
+/// iteration moves past it, i.e. in next(). Therefore, the statistics reflect any changes
+/// made to the data via the read-write interface and cover all accessors once the end of
+/// the data is reached. The statistics are reset by init().
+///
+/// The rows of each accessor are split between the given number of threads, each thread
+/// fills its own partial accumulator. The partial results are merged after all threads
+/// have finished, so the threads don't share any state and no locking is required.
+/// Bit-packed flags are used if the wrapped iterator is read-only and delivers table-based accessors.
+/// @ingroup dataaccess_hlp
+class StatisticsIteratorAdapter : virtual public DataIteratorAdapter
+{
+public:
+  /// @brief setup with the given iterator
+  /// @param[in] iter shared pointer to iterator to be wrapped
+  /// @param[in] nThreads number of threads processing each accessor
+  /// @note the code tries to cast the shared pointer to a non-const iterator type. If
+  /// successul, non-const methods of the adapter will also work.
+  explicit StatisticsIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter,
+                                     casacore::uInt nThreads = 1);
+
+  /// @brief restart the iteration from the beginning
+  /// @details The statistics accumulated so far are reset.
+  virtual void init();
+
+  /// @brief advance the iterator one step further
+  /// @details The current accessor is added to the statistics first.
+  /// @return True if there are more data (so constructions like
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @return statistics of the accessors iterated over so far
+  inline const VisibilityStatistics& statistics() const { return itsStatistics; }
+
+  /// @return number of threads processing each accessor
+  inline casacore::uInt nThreads() const { return itsNThreads; }
+
+private:
+  /// @brief add the current accessor to the statistics
+  void accumulateCurrent();
+
+  /// @brief number of threads processing each accessor
+  casacore::uInt itsNThreads;
+
+  /// @brief statistics accumulated so far
+  VisibilityStatistics itsStatistics;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_STATISTICS_ITERATOR_ADAPTER_H
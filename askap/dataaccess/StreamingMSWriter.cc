@@ -0,0 +1,342 @@
+/// @file
+///
+/// @brief Writer of a new measurement set from a stream of accessors
+/// @details The accessor layer can only write back into existing tables. This class
+/// creates a new measurement set and appends the data of accessors one chunk after
+/// another.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/StreamingMSWriter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableCopy.h>
+#include <casacore/tables/Tables/TableInfo.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
+
+// std includes
+#include <cmath>
+
+ASKAP_LOGGER(logger, ".StreamingMSWriter");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief transpose a cube into the layout of the table
+/// @details The accessor layout is nRow x nChannel x nPol, the table column stores
+/// nPol x nChannel cells, so the block of rows is nPol x nChannel x nRow.
+/// @param[in] cube cube to transpose
+/// @param[out] buf buffer to fill (resized as necessary)
+template<typename T>
+void toTableLayout(const casacore::Cube<T> &cube, casacore::Array<T> &buf)
+{
+  const casacore::IPosition shape(3, cube.nplane(), cube.ncolumn(), cube.nrow());
+  if (!buf.shape().isEqual(shape)) {
+      buf.resize(shape);
+  }
+  ASKAPDEBUGASSERT(buf.contiguousStorage());
+  T* dst = buf.data();
+  for (casacore::uInt row = 0; row < cube.nrow(); ++row) {
+       for (casacore::uInt chan = 0; chan < cube.ncolumn(); ++chan) {
+            for (casacore::uInt pol = 0; pol < cube.nplane(); ++pol, ++dst) {
+                 *dst = cube(row, chan, pol);
+            }
+       }
+  }
+}
+
+/// @brief convert indices delivered by the accessor to the type of the table column
+/// @param[in] indices vector of indices
+/// @return the same indices as signed integers
+casacore::Vector<casacore::Int> toInt(const casacore::Vector<casacore::uInt> &indices)
+{
+  casacore::Vector<casacore::Int> result(indices.nelements());
+  for (casacore::uInt i = 0; i < indices.nelements(); ++i) {
+       result[i] = static_cast<casacore::Int>(indices[i]);
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+/// @brief set up the writer
+/// @details The new measurement set is not created until the first write.
+/// @param[in] name name of the measurement set to create (must not exist)
+/// @param[in] templateName name of the measurement set to copy subtables from
+/// @param[in] maxTileSize maximum size of a tile in bytes
+StreamingMSWriter::StreamingMSWriter(const std::string &name, const std::string &templateName,
+                                     size_t maxTileSize) :
+      itsName(name), itsTemplate(templateName), itsMaxTileSize(maxTileSize), itsNChan(0), itsNPol(0),
+      itsDataDescID(0), itsDataDescChecked(false), itsFieldID(0), itsScanNumber(0), itsInterval(0.),
+      itsNRowsWritten(0), itsChunksWritten(0)
+{
+  ASKAPCHECK(itsName != templateName, "Unable to write measurement set over its own template "<<templateName);
+}
+
+/// @brief destructor, flushes the measurement set
+StreamingMSWriter::~StreamingMSWriter()
+{
+  try {
+     flush();
+  }
+  catch (const std::exception &ex) {
+     // can't throw from the destructor
+     ASKAPLOG_ERROR_STR(logger, "Failed to flush measurement set "<<itsName<<": "<<ex.what());
+  }
+}
+
+/// @brief flush the data written so far to disk
+void StreamingMSWriter::flush()
+{
+  if (!itsMS.isNull()) {
+      itsMS.flush();
+  }
+}
+
+/// @brief set data descriptor of the rows written subsequently
+/// @param[in] id row of the DATA_DESCRIPTION subtable
+void StreamingMSWriter::setDataDescID(casacore::uInt id)
+{
+  if (id != itsDataDescID) {
+      itsDataDescID = id;
+      itsDataDescChecked = false;
+  }
+}
+
+/// @brief create the measurement set for the shape of the given accessor
+/// @param[in] acc first accessor to be written
+void StreamingMSWriter::create(const IConstDataAccessor &acc)
+{
+  ASKAPDEBUGASSERT(itsMS.isNull());
+  itsNChan = acc.nChannel();
+  itsNPol = acc.nPol();
+  ASKAPCHECK(itsNChan > 0 && itsNPol > 0, "Unable to create measurement set "<<itsName<<
+             " for data with "<<itsNChan<<" channel(s) and "<<itsNPol<<" polarisation(s)");
+  casacore::TableDesc td = casacore::MeasurementSet::requiredTableDesc();
+  casacore::MeasurementSet::addColumnToDesc(td, casacore::MeasurementSet::DATA, 2);
+  // fixed shapes allow the cells to be stored without indirection
+  const casacore::IPosition cellShape(2, itsNPol, itsNChan);
+  td.rwColumnDesc("DATA").setShape(cellShape);
+  td.rwColumnDesc("FLAG").setShape(cellShape);
+  td.rwColumnDesc("WEIGHT").setShape(casacore::IPosition(1, itsNPol));
+  td.rwColumnDesc("SIGMA").setShape(casacore::IPosition(1, itsNPol));
+  td.defineHypercolumn("TiledData", 3, casacore::stringToVector("DATA"));
+  td.defineHypercolumn("TiledFlag", 3, casacore::stringToVector("FLAG"));
+
+  // tiles span whole cells and as many rows as the size limit allows
+  const size_t rowSize = size_t(itsNPol) * itsNChan * sizeof(casacore::Complex);
+  const casacore::Int tileRows = rowSize < itsMaxTileSize ? static_cast<casacore::Int>(itsMaxTileSize / rowSize) : 1;
+  const casacore::IPosition tileShape(3, itsNPol, itsNChan, tileRows);
+
+  casacore::SetupNewTable maker(itsName, td, casacore::Table::NewNoReplace);
+  casacore::StandardStMan ssm("SSM", 32768);
+  maker.bindAll(ssm);
+  casacore::TiledColumnStMan dataStMan("TiledData", tileShape);
+  maker.bindColumn("DATA", dataStMan);
+  casacore::TiledColumnStMan flagStMan("TiledFlag", tileShape);
+  maker.bindColumn("FLAG", flagStMan);
+  itsMS = casacore::Table(maker);
+  itsMS.tableInfo().setType(casacore::TableInfo::type(casacore::TableInfo::MEASUREMENTSET));
+  itsMS.tableInfo().setSubType(itsTemplate.tableInfo().subType());
+  // subtables are copied once, the main table is filled by write
+  casacore::TableCopy::copySubTables(itsMS, itsTemplate);
+  ASKAPLOG_DEBUG_STR(logger, "Created measurement set "<<itsName<<" for "<<itsNChan<<" channel(s) and "<<
+                     itsNPol<<" polarisation(s), tile shape "<<tileShape<<", subtables copied from "<<
+                     itsTemplate.tableName());
+}
+
+/// @brief check that the data descriptor matches the shape of the data
+/// @details The spectral window is updated if the frequencies differ from the accessor.
+/// @param[in] acc accessor to be written
+void StreamingMSWriter::checkDataDescriptor(const IConstDataAccessor &acc)
+{
+  const casacore::Table ddTable = itsMS.keywordSet().asTable("DATA_DESCRIPTION");
+  ASKAPCHECK(itsDataDescID < ddTable.nrow(), "Data descriptor "<<itsDataDescID<<
+             " is not present in the DATA_DESCRIPTION subtable of "<<itsName);
+  const casacore::Int spWinID = casacore::ROScalarColumn<casacore::Int>(ddTable,
+                                "SPECTRAL_WINDOW_ID")(itsDataDescID);
+  const casacore::Int polID = casacore::ROScalarColumn<casacore::Int>(ddTable,
+                                "POLARIZATION_ID")(itsDataDescID);
+
+  const casacore::Table polTable = itsMS.keywordSet().asTable("POLARIZATION");
+  ASKAPCHECK(polID >= 0 && casacore::rownr_t(polID) < polTable.nrow(), "Polarisation ID "<<polID<<
+             " of data descriptor "<<itsDataDescID<<" is not present in the POLARIZATION subtable");
+  const casacore::Int nCorr = casacore::ROScalarColumn<casacore::Int>(polTable, "NUM_CORR")(polID);
+  if (nCorr != casacore::Int(itsNPol)) {
+      ASKAPTHROW(DataAccessError, "Data with "<<itsNPol<<" polarisation(s) can't be written to "<<itsName<<
+                 ", data descriptor "<<itsDataDescID<<" has "<<nCorr<<" correlation product(s)");
+  }
+
+  casacore::Table spWinTable = itsMS.keywordSet().asTable("SPECTRAL_WINDOW");
+  ASKAPCHECK(spWinID >= 0 && casacore::rownr_t(spWinID) < spWinTable.nrow(), "Spectral window "<<spWinID<<
+             " of data descriptor "<<itsDataDescID<<" is not present in the SPECTRAL_WINDOW subtable");
+  const casacore::Vector<casacore::Double> &freq = acc.frequency();
+  ASKAPCHECK(freq.nelements() == itsNChan, "Accessor has "<<itsNChan<<" channel(s), but "<<
+             freq.nelements()<<" frequencies");
+  const casacore::Vector<casacore::Double> tableFreq =
+        casacore::ROArrayColumn<casacore::Double>(spWinTable, "CHAN_FREQ")(spWinID);
+  bool same = (tableFreq.nelements() == freq.nelements());
+  for (casacore::uInt chan = 0; same && chan < freq.nelements(); ++chan) {
+       // 1 Hz is well below any channel width
+       same = std::abs(tableFreq[chan] - freq[chan]) < 1.;
+  }
+  if (same) {
+      return;
+  }
+  // the data have been averaged or otherwise resampled in frequency
+  spWinTable.reopenRW();
+  const casacore::Double totalBandwidth = casacore::ROScalarColumn<casacore::Double>(spWinTable,
+                                          "TOTAL_BANDWIDTH")(spWinID);
+  casacore::Vector<casacore::Double> width(itsNChan);
+  casacore::Vector<casacore::Double> resolution(itsNChan);
+  for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+       if (itsNChan == 1) {
+           width[chan] = totalBandwidth;
+       } else {
+           width[chan] = chan + 1 < itsNChan ? freq[chan + 1] - freq[chan] : freq[chan] - freq[chan - 1];
+       }
+       resolution[chan] = std::abs(width[chan]);
+  }
+  casacore::ScalarColumn<casacore::Int>(spWinTable, "NUM_CHAN").put(spWinID, casacore::Int(itsNChan));
+  casacore::ArrayColumn<casacore::Double>(spWinTable, "CHAN_FREQ").put(spWinID, freq);
+  casacore::ArrayColumn<casacore::Double>(spWinTable, "CHAN_WIDTH").put(spWinID, width);
+  casacore::ArrayColumn<casacore::Double>(spWinTable, "EFFECTIVE_BW").put(spWinID, resolution);
+  casacore::ArrayColumn<casacore::Double>(spWinTable, "RESOLUTION").put(spWinID, resolution);
+  ASKAPLOG_INFO_STR(logger, "Spectral window "<<spWinID<<" of "<<itsName<<" updated to "<<itsNChan<<
+                    " channel(s) starting at "<<freq[0]<<" Hz");
+}
+
+/// @brief append the chunk of data
+/// @details All accessors must have the same number of channels and polarisations.
+/// @param[in] acc accessor to write
+void StreamingMSWriter::write(const IConstDataAccessor &acc)
+{
+  const casacore::uInt nRow = acc.nRow();
+  if (nRow == 0) {
+      return;
+  }
+  if (itsMS.isNull()) {
+      create(acc);
+  }
+  ASKAPCHECK(acc.nChannel() == itsNChan && acc.nPol() == itsNPol, "Accessor with "<<acc.nChannel()<<
+             " channel(s) and "<<acc.nPol()<<" polarisation(s) doesn't match the shape of "<<itsName<<
+             " ("<<itsNChan<<" channel(s) and "<<itsNPol<<" polarisation(s))");
+  if (!itsDataDescChecked) {
+      checkDataDescriptor(acc);
+      itsDataDescChecked = true;
+  }
+
+  const casacore::rownr_t startRow = itsMS.nrow();
+  itsMS.addRow(nRow);
+  const casacore::Slicer rows(casacore::IPosition(1, startRow), casacore::IPosition(1, nRow));
+
+  // every column is written with a single call for the whole block of rows
+  const casacore::Vector<casacore::Double> time(nRow, acc.time());
+  casacore::ScalarColumn<casacore::Double>(itsMS, "TIME").putColumnRange(rows, time);
+  casacore::ScalarColumn<casacore::Double>(itsMS, "TIME_CENTROID").putColumnRange(rows, time);
+  const casacore::Vector<casacore::Double> interval(nRow, itsInterval);
+  casacore::ScalarColumn<casacore::Double>(itsMS, "INTERVAL").putColumnRange(rows, interval);
+  casacore::ScalarColumn<casacore::Double>(itsMS, "EXPOSURE").putColumnRange(rows, interval);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "ANTENNA1").putColumnRange(rows, toInt(acc.antenna1()));
+  casacore::ScalarColumn<casacore::Int>(itsMS, "ANTENNA2").putColumnRange(rows, toInt(acc.antenna2()));
+  casacore::ScalarColumn<casacore::Int>(itsMS, "FEED1").putColumnRange(rows, toInt(acc.feed1()));
+  casacore::ScalarColumn<casacore::Int>(itsMS, "FEED2").putColumnRange(rows, toInt(acc.feed2()));
+  casacore::ScalarColumn<casacore::Int>(itsMS, "DATA_DESC_ID").putColumnRange(rows,
+          casacore::Vector<casacore::Int>(nRow, casacore::Int(itsDataDescID)));
+  casacore::ScalarColumn<casacore::Int>(itsMS, "FIELD_ID").putColumnRange(rows,
+          casacore::Vector<casacore::Int>(nRow, casacore::Int(itsFieldID)));
+  casacore::ScalarColumn<casacore::Int>(itsMS, "SCAN_NUMBER").putColumnRange(rows,
+          casacore::Vector<casacore::Int>(nRow, casacore::Int(itsScanNumber)));
+  const casacore::Vector<casacore::Int> zeros(nRow, 0);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "ARRAY_ID").putColumnRange(rows, zeros);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "OBSERVATION_ID").putColumnRange(rows, zeros);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "PROCESSOR_ID").putColumnRange(rows, zeros);
+  casacore::ScalarColumn<casacore::Int>(itsMS, "STATE_ID").putColumnRange(rows,
+          casacore::Vector<casacore::Int>(nRow, -1));
+
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.uvw();
+  ASKAPDEBUGASSERT(uvw.nelements() == nRow);
+  casacore::Matrix<casacore::Double> uvwBuf(3, nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            uvwBuf(dim, row) = uvw[row](dim);
+       }
+  }
+  casacore::ArrayColumn<casacore::Double>(itsMS, "UVW").putColumnRange(rows, uvwBuf);
+
+  // weights are derived from the noise of the first channel
+  const casacore::Cube<casacore::Complex> &noise = acc.noise();
+  ASKAPDEBUGASSERT(noise.nrow() == nRow && noise.nplane() == itsNPol);
+  casacore::Matrix<casacore::Float> sigma(itsNPol, nRow);
+  casacore::Matrix<casacore::Float> weight(itsNPol, nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+            sigma(pol, row) = noise(row, 0, pol).real();
+            weight(pol, row) = sigma(pol, row) > 0 ? 1. / (sigma(pol, row) * sigma(pol, row)) : 0.;
+       }
+  }
+  casacore::ArrayColumn<casacore::Float>(itsMS, "SIGMA").putColumnRange(rows, sigma);
+  casacore::ArrayColumn<casacore::Float>(itsMS, "WEIGHT").putColumnRange(rows, weight);
+
+  const casacore::Cube<casacore::Bool> &flag = acc.flag();
+  toTableLayout(flag, itsFlagBuffer);
+  casacore::ArrayColumn<casacore::Bool>(itsMS, "FLAG").putColumnRange(rows, itsFlagBuffer);
+  // rows with all samples flagged are also flagged via FLAG_ROW
+  casacore::Vector<casacore::Bool> flagRow(nRow, casacore::True);
+  const casacore::Bool* flagPtr = itsFlagBuffer.data();
+  const size_t cellSize = size_t(itsNPol) * itsNChan;
+  for (casacore::uInt row = 0; row < nRow; ++row, flagPtr += cellSize) {
+       for (size_t elem = 0; elem < cellSize; ++elem) {
+            if (!flagPtr[elem]) {
+                flagRow[row] = casacore::False;
+                break;
+            }
+       }
+  }
+  casacore::ScalarColumn<casacore::Bool>(itsMS, "FLAG_ROW").putColumnRange(rows, flagRow);
+
+  toTableLayout(acc.visibility(), itsDataBuffer);
+  casacore::ArrayColumn<casacore::Complex>(itsMS, "DATA").putColumnRange(rows, itsDataBuffer);
+
+  itsNRowsWritten += nRow;
+  ++itsChunksWritten;
+}
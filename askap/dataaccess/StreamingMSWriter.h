@@ -0,0 +1,185 @@
+/// @file
+///
+/// @brief Writer of a new measurement set from a stream of accessors
+/// @details The accessor layer can only write back into existing tables. This class
+/// creates a new measurement set and appends the data of accessors one chunk after
+/// another (e.g. the output of averaging adapters), so derived datasets can be made
+/// in a single pass over the input.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_STREAMING_MS_WRITER_H
+#define ASKAP_ACCESSORS_STREAMING_MS_WRITER_H
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Writer of a new measurement set from a stream of accessors
+/// @details The measurement set is created when the first accessor is written, as
+/// the shape of the data is only known then. All subtables are copied from the
+/// template measurement set at this point. If the frequencies of the accessor differ
+/// from those of the spectral window (e.g. the data are averaged in frequency), the
+/// spectral window referenced by the data descriptor is updated accordingly.
+///
+/// DATA and FLAG columns are stored by the tiled storage manager with tiles covering
+/// whole cells of a block of rows, so both writing and subsequent reading is done in
+/// large contiguous pieces. All other columns are stored by the standard storage manager.
+/// Each accessor is appended as a block of rows, every column is filled with a single
+/// putColumnRange call.
+///
+/// The accessors are expected to give time in seconds since MJD 0 in the UTC frame and
+/// frequencies in Hz in the frame of the template (as it is done by the default converter).
+/// Visibility, flag, uvw, antenna, feed, noise and frequency fields are used. Weights are
+/// derived from the noise of the first channel. Polarisation conversion is not supported,
+/// i.e. the number of polarisations must match the template. Data descriptor, field,
+/// scan and integration time of the rows are not available from the accessor and are
+/// set via the setters of this class (applied to all subsequent writes).
+///
+/// This class is not thread-safe.
+/// @ingroup dataaccess_tab
+class StreamingMSWriter : public boost::noncopyable {
+public:
+  /// @brief set up the writer
+  /// @details The new measurement set is not created until the first write.
+  /// @param[in] name name of the measurement set to create (must not exist)
+  /// @param[in] templateName name of the measurement set to copy subtables from
+  /// @param[in] maxTileSize maximum size of a tile in bytes
+  StreamingMSWriter(const std::string &name, const std::string &templateName,
+                    size_t maxTileSize = 4194304);
+
+  /// @brief destructor, flushes the measurement set
+  ~StreamingMSWriter();
+
+  /// @brief append the chunk of data
+  /// @details All accessors must have the same number of channels and polarisations.
+  /// @param[in] acc accessor to write
+  void write(const IConstDataAccessor &acc);
+
+  /// @brief flush the data written so far to disk
+  void flush();
+
+  /// @brief set data descriptor of the rows written subsequently
+  /// @param[in] id row of the DATA_DESCRIPTION subtable
+  void setDataDescID(casacore::uInt id);
+
+  /// @brief set field of the rows written subsequently
+  /// @param[in] id row of the FIELD subtable
+  inline void setFieldID(casacore::uInt id) { itsFieldID = id; }
+
+  /// @brief set scan number of the rows written subsequently
+  /// @param[in] scan scan number
+  inline void setScanNumber(casacore::uInt scan) { itsScanNumber = scan; }
+
+  /// @brief set integration time of the rows written subsequently
+  /// @param[in] interval integration time in seconds used for INTERVAL and EXPOSURE
+  inline void setInterval(double interval) { itsInterval = interval; }
+
+  /// @return name of the measurement set
+  inline const std::string& name() const { return itsName; }
+
+  /// @return number of rows written so far
+  inline casacore::rownr_t nRowsWritten() const { return itsNRowsWritten; }
+
+  /// @return number of chunks written so far
+  inline casacore::uInt chunksWritten() const { return itsChunksWritten; }
+
+private:
+  /// @brief create the measurement set for the shape of the given accessor
+  /// @param[in] acc first accessor to be written
+  void create(const IConstDataAccessor &acc);
+
+  /// @brief check that the data descriptor matches the shape of the data
+  /// @details The spectral window is updated if the frequencies differ from the accessor.
+  /// @param[in] acc accessor to be written
+  void checkDataDescriptor(const IConstDataAccessor &acc);
+
+  /// @brief name of the measurement set to create
+  std::string itsName;
+
+  /// @brief template to copy subtables from
+  casacore::Table itsTemplate;
+
+  /// @brief maximum tile size in bytes
+  size_t itsMaxTileSize;
+
+  /// @brief new measurement set (null until the first write)
+  casacore::Table itsMS;
+
+  /// @brief number of channels
+  casacore::uInt itsNChan;
+
+  /// @brief number of polarisations
+  casacore::uInt itsNPol;
+
+  /// @brief data descriptor of the rows written
+  casacore::uInt itsDataDescID;
+
+  /// @brief true if the data descriptor has been checked against the data
+  bool itsDataDescChecked;
+
+  /// @brief field of the rows written
+  casacore::uInt itsFieldID;
+
+  /// @brief scan number of the rows written
+  casacore::uInt itsScanNumber;
+
+  /// @brief integration time in seconds
+  double itsInterval;
+
+  /// @brief number of rows written so far
+  casacore::rownr_t itsNRowsWritten;
+
+  /// @brief number of chunks written so far
+  casacore::uInt itsChunksWritten;
+
+  /// @brief buffer for the visibilities in the table layout (reused between chunks)
+  casacore::Array<casacore::Complex> itsDataBuffer;
+
+  /// @brief buffer for the flags in the table layout (reused between chunks)
+  casacore::Array<casacore::Bool> itsFlagBuffer;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_STREAMING_MS_WRITER_H
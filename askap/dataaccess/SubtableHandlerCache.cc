@@ -0,0 +1,123 @@
+/// @file
+///
+/// @brief Process-wide cache of read-only subtable handlers
+/// @details Handlers of the subtables which don't change during processing (antennas,
+/// spectral windows, data descriptions and polarisations) read the whole subtable into
+/// memory. Data sources opened on the same measurement set (e.g. one per worker thread)
+/// can share these handlers rather than read the subtables again.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/SubtableHandlerCache.h>
+
+// casa includes
+#include <casacore/tables/Tables/TableRecord.h>
+
+// std includes
+#include <sstream>
+#include <climits>
+#include <cstdlib>
+#include <sys/stat.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor, use instance
+SubtableHandlerCache::SubtableHandlerCache() : itsHits(0), itsMisses(0) {}
+
+/// @return the instance of the cache used by this process
+SubtableHandlerCache& SubtableHandlerCache::instance()
+{
+  static SubtableHandlerCache theCache;
+  return theCache;
+}
+
+/// @return number of requests served from the cache
+size_t SubtableHandlerCache::hits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsHits;
+}
+
+/// @return number of handlers constructed
+size_t SubtableHandlerCache::misses() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsMisses;
+}
+
+/// @brief forget all handlers
+/// @details The handlers in use are not affected, but they will not be shared with
+/// data sources set up afterwards.
+void SubtableHandlerCache::clear()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  itsHandlers.clear();
+}
+
+/// @brief form the key for the given subtable
+/// @param[in] ms measurement set (main table)
+/// @param[in] subtable name of the subtable
+/// @param[in] type name of the handler type
+/// @return the key or an empty string if the subtable can't be cached
+std::string SubtableHandlerCache::makeKey(const casacore::Table &ms, const std::string &subtable,
+                                          const std::string &type)
+{
+  if ((ms.tableType() != casacore::Table::Plain) || !ms.keywordSet().isDefined(subtable)) {
+      return std::string();
+  }
+  const casacore::Table tab = ms.keywordSet().asTable(subtable);
+  if (tab.tableType() != casacore::Table::Plain) {
+      return std::string();
+  }
+  char resolved[PATH_MAX];
+  if (realpath(tab.tableName().c_str(), resolved) == NULL) {
+      return std::string();
+  }
+  // table.dat is rewritten every time the table is changed
+  struct stat info;
+  if (stat((std::string(resolved) + "/table.dat").c_str(), &info) != 0) {
+      return std::string();
+  }
+  std::ostringstream os;
+  os<<type<<":"<<resolved<<":"<<info.st_mtime<<"."<<info.st_mtim.tv_nsec;
+  return os.str();
+}
+
+/// @brief remove entries of the handlers which no longer exist
+/// @note the mutex should be locked by the caller
+void SubtableHandlerCache::removeExpired()
+{
+  for (std::map<std::string, boost::weak_ptr<void const> >::iterator it = itsHandlers.begin();
+       it != itsHandlers.end();) {
+       if (it->second.expired()) {
+           itsHandlers.erase(it++);
+       } else {
+           ++it;
+       }
+  }
+}
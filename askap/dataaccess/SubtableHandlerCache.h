@@ -0,0 +1,124 @@
+/// @file
+///
+/// @brief Process-wide cache of read-only subtable handlers
+/// @details Handlers of the subtables which don't change during processing (antennas,
+/// spectral windows, data descriptions and polarisations) read the whole subtable into
+/// memory. Data sources opened on the same measurement set (e.g. one per worker thread)
+/// can share these handlers rather than read the subtables again.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SUBTABLE_HANDLER_CACHE_H
+#define ASKAP_ACCESSORS_SUBTABLE_HANDLER_CACHE_H
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <map>
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Process-wide cache of read-only subtable handlers
+/// @details Handlers are keyed by the type of the handler, the canonical path of the
+/// subtable (symbolic links resolved) and the modification time of the subtable, so a
+/// subtable rewritten on disk is read again. The cache holds weak pointers only, i.e.
+/// a handler is destroyed when the last data source using it goes away. Only handlers
+/// which are immutable after construction can be cached, because they are shared between
+/// threads. Subtables of temporary (memory) tables and subtables which can't be located
+/// on disk are never cached. All methods are thread-safe.
+/// @ingroup dataaccess_tab
+class SubtableHandlerCache : public boost::noncopyable {
+public:
+  /// @return the instance of the cache used by this process
+  static SubtableHandlerCache& instance();
+
+  /// @brief obtain a handler for the given subtable
+  /// @details The handler is taken from the cache if it exists, otherwise a new one is
+  /// constructed (as Handler(ms)) and added to the cache. Construction is done while the
+  /// cache is locked, so concurrent requests for the same subtable read the subtable once.
+  /// @param[in] ms measurement set (main table)
+  /// @param[in] subtable name of the subtable the handler reads
+  /// @return shared pointer to the handler
+  template<typename Handler, typename Interface>
+  boost::shared_ptr<Interface const> get(const casacore::Table &ms, const std::string &subtable);
+
+  /// @return number of requests served from the cache
+  size_t hits() const;
+
+  /// @return number of handlers constructed
+  size_t misses() const;
+
+  /// @brief forget all handlers
+  /// @details The handlers in use are not affected, but they will not be shared with
+  /// data sources set up afterwards.
+  void clear();
+
+private:
+  /// @brief constructor, use instance
+  SubtableHandlerCache();
+
+  /// @brief form the key for the given subtable
+  /// @param[in] ms measurement set (main table)
+  /// @param[in] subtable name of the subtable
+  /// @param[in] type name of the handler type
+  /// @return the key or an empty string if the subtable can't be cached
+  static std::string makeKey(const casacore::Table &ms, const std::string &subtable,
+                             const std::string &type);
+
+  /// @brief remove entries of the handlers which no longer exist
+  /// @note the mutex should be locked by the caller
+  void removeExpired();
+
+  /// @brief cached handlers
+  std::map<std::string, boost::weak_ptr<void const> > itsHandlers;
+
+  /// @brief number of requests served from the cache
+  size_t itsHits;
+
+  /// @brief number of handlers constructed
+  size_t itsMisses;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#include <askap/dataaccess/SubtableHandlerCache.tcc>
+
+#endif // #ifndef ASKAP_ACCESSORS_SUBTABLE_HANDLER_CACHE_H
@@ -0,0 +1,79 @@
+/// @file
+///
+/// @brief Process-wide cache of read-only subtable handlers
+/// @details Handlers of the subtables which don't change during processing (antennas,
+/// spectral windows, data descriptions and polarisations) read the whole subtable into
+/// memory. Data sources opened on the same measurement set (e.g. one per worker thread)
+/// can share these handlers rather than read the subtables again.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SUBTABLE_HANDLER_CACHE_TCC
+#define ASKAP_ACCESSORS_SUBTABLE_HANDLER_CACHE_TCC
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <typeinfo>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief obtain a handler for the given subtable
+/// @details The handler is taken from the cache if it exists, otherwise a new one is
+/// constructed (as Handler(ms)) and added to the cache. Construction is done while the
+/// cache is locked, so concurrent requests for the same subtable read the subtable once.
+/// @param[in] ms measurement set (main table)
+/// @param[in] subtable name of the subtable the handler reads
+/// @return shared pointer to the handler
+template<typename Handler, typename Interface>
+boost::shared_ptr<Interface const> SubtableHandlerCache::get(const casacore::Table &ms,
+                                                             const std::string &subtable)
+{
+  const std::string key = makeKey(ms, subtable, typeid(Handler).name());
+  if (key.empty()) {
+      return boost::shared_ptr<Interface const>(new Handler(ms));
+  }
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  const boost::shared_ptr<void const> cached = itsHandlers[key].lock();
+  if (cached) {
+      ++itsHits;
+      return boost::static_pointer_cast<Handler const>(cached);
+  }
+  removeExpired();
+  const boost::shared_ptr<Handler const> handler(new Handler(ms));
+  itsHandlers[key] = handler;
+  ++itsMisses;
+  return handler;
+}
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SUBTABLE_HANDLER_CACHE_TCC
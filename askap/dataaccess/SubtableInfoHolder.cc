@@ -41,19 +41,27 @@
 #include <casacore/tables/Tables/SetupNewTab.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableRecord.h>
-#include <casacore/tables/Tables/MemoryTable.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 
 // own includes
 #include <askap/dataaccess/SubtableInfoHolder.h>
 #include <askap/dataaccess/MemTableDataDescHolder.h>
 #include <askap/dataaccess/MemTableSpWindowHolder.h>
 #include <askap/dataaccess/TableBufferManager.h>
+#include <askap/dataaccess/PooledBufferManager.h>
 #include <askap/dataaccess/DataAccessError.h>
 #include <askap/dataaccess/FeedSubtableHandler.h>
 #include <askap/dataaccess/FieldSubtableHandler.h>
 #include <askap/dataaccess/MemAntennaSubtableHandler.h>
 #include <askap/dataaccess/MemTablePolarisationHolder.h>
+#include <askap/dataaccess/MemTableRowIndex.h>
+#include <askap/dataaccess/SubtableHandlerCache.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -65,41 +73,48 @@ using namespace askap::accessors;
 /// practical to provide reasonable defaults here
 /// @param memBuffers true if the buffers should be held in memory, false if they should be
 /// written back to the disk (table needs to be writable for this)
-SubtableInfoHolder::SubtableInfoHolder(bool memBuffers) : itsUseMemBuffers(memBuffers) {}
+SubtableInfoHolder::SubtableInfoHolder(bool memBuffers, size_t bufferTileSize) :
+        itsUseMemBuffers(memBuffers), itsBufferTileSize(bufferTileSize) {}
 
 
 /// @brief obtain data description holder
-/// @details A MemTableDataDescHolder is constructed on the first call
-/// to this method and a reference to it is always returned later
+/// @details A MemTableDataDescHolder is obtained from SubtableHandlerCache on the first
+/// call to this method and a reference to it is always returned later
 /// @return a reference to the handler of the DATA_DESCRIPTION subtable
 const ITableDataDescHolder& SubtableInfoHolder::getDataDescription() const
 {
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
   if (!itsDataDescHandler) {
-      itsDataDescHandler.reset(new MemTableDataDescHolder(table()));
+      itsDataDescHandler = SubtableHandlerCache::instance().get<MemTableDataDescHolder, ITableDataDescHolder>(table(),
+                 "DATA_DESCRIPTION");
   }
   return *itsDataDescHandler;
 }
 
 /// @brief obtain spectral window holder
-/// @details A MemTableSpWindowHolder is constructed on the first call
-/// to this method and a reference to it is always returned later
+/// @details A MemTableSpWindowHolder is obtained from SubtableHandlerCache on the first
+/// call to this method and a reference to it is always returned later
 /// @return a reference to the handler of the SPECTRAL_WINDOW subtable
 const ITableSpWindowHolder& SubtableInfoHolder::getSpWindow() const
 {
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
   if (!itsSpWindowHandler) {
-      itsSpWindowHandler.reset(new MemTableSpWindowHolder(table()));
+      itsSpWindowHandler = SubtableHandlerCache::instance().get<MemTableSpWindowHolder, ITableSpWindowHolder>(table(),
+                 "SPECTRAL_WINDOW");
   }
   return *itsSpWindowHandler;
 }
 
 /// @brief obtain polarisation information holder
-/// @details A MemTablePolarisationHolder is constructed on the first call
-/// to this method and a reference to it is always returned later   
+/// @details A MemTablePolarisationHolder is obtained from SubtableHandlerCache on the first
+/// call to this method and a reference to it is always returned later   
 /// @return a reference to the handler of the POLARIZATION subtable
 const ITablePolarisationHolder& SubtableInfoHolder::getPolarisation() const
 {
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
   if (!itsPolarisationHandler) {
-      itsPolarisationHandler.reset(new MemTablePolarisationHolder(table()));
+      itsPolarisationHandler = SubtableHandlerCache::instance().get<MemTablePolarisationHolder, ITablePolarisationHolder>(table(),
+                 "POLARIZATION");
   }
   return *itsPolarisationHandler;
 }
@@ -112,6 +127,7 @@ const ITablePolarisationHolder& SubtableInfoHolder::getPolarisation() const
 /// @return a reference to the manager of buffers (BUFFERS subtable)
 const IBufferManager& SubtableInfoHolder::getBufferManager() const
 {
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
   if (!itsBufferManager) {
       initBufferManager();
   }
@@ -123,12 +139,9 @@ void SubtableInfoHolder::initBufferManager() const
 {  
   if (itsUseMemBuffers) {
       // After calling this method, the buffers will be held in
-      // memory (via casacore::MemoryTable), rather than be a subtable of
-      // the measurement set.
-      casacore::SetupNewTable maker("BUFFERS",
-								casacore::TableDesc(),casacore::Table::New);
-      itsBufferManager.reset(new TableBufferManager(casacore::Table(maker,
-                                casacore::Table::Memory)));      
+      // memory (in a pool of slabs shared by all buffers), rather than 
+      // be a subtable of the measurement set.
+      itsBufferManager.reset(new PooledBufferManager);
   } else {
       // first, test that we have a compatible BUFFERS subtable if the
       // keyword exists
@@ -156,7 +169,7 @@ void SubtableInfoHolder::initBufferManager() const
           table().rwKeywordSet().defineTable("BUFFERS",casacore::Table(maker));
       }
       itsBufferManager.reset(new
-               TableBufferManager(table().keywordSet().asTable("BUFFERS")));
+               TableBufferManager(table().keywordSet().asTable("BUFFERS"), itsBufferTileSize));
   }
 }
 
@@ -166,6 +179,7 @@ void SubtableInfoHolder::initBufferManager() const
 /// @return a reference to the handler of the FEED subtable
 const IFeedSubtableHandler& SubtableInfoHolder::getFeed() const
 {
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
   if (!itsFeedHandler) {
       itsFeedHandler.reset(new FeedSubtableHandler(table()));  
   }
@@ -179,6 +193,7 @@ const IFeedSubtableHandler& SubtableInfoHolder::getFeed() const
 /// @return a reference to the handler of the FIELD subtable
 const IFieldSubtableHandler& SubtableInfoHolder::getField() const
 {
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
   if (!itsFieldHandler) {
       itsFieldHandler.reset(new FieldSubtableHandler(table()));
   }
@@ -187,13 +202,270 @@ const IFieldSubtableHandler& SubtableInfoHolder::getField() const
 
 
 /// @brief obtain an antenna subtable handler
-/// @details A MemAntennaSubtableHandler is constructed on the first call
-/// to this method and a reference to it is returned thereafter
+/// @details A MemAntennaSubtableHandler is obtained from SubtableHandlerCache on the first
+/// call to this method and a reference to it is returned thereafter
 /// @return a reference to the handler of the ANTENNA subtable
 const IAntennaSubtableHandler& SubtableInfoHolder::getAntenna() const
 {
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
   if (!itsAntennaHandler) {
-      itsAntennaHandler.reset(new MemAntennaSubtableHandler(table()));
+      itsAntennaHandler = SubtableHandlerCache::instance().get<MemAntennaSubtableHandler, IAntennaSubtableHandler>(table(),
+                 "ANTENNA");
   }
   return *itsAntennaHandler;
 }
+
+/// @brief obtain the row index of the main table
+/// @details A MemTableRowIndex is constructed on the first call
+/// to this method and a reference to it is returned thereafter
+/// @return a reference to the row index of the main table
+const ITableRowIndex& SubtableInfoHolder::getRowIndex() const
+{
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
+  if (!itsRowIndex) {
+      itsRowIndex.reset(new MemTableRowIndex(table()));
+  }
+  return *itsRowIndex;
+}
+
+/// @brief obtain the cache of table selections
+/// @details The cache is constructed on the first call to this method
+/// and a reference to it is returned thereafter
+/// @return a reference to the cache of table selections
+const TableSelectionCache& SubtableInfoHolder::getSelectionCache() const
+{
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
+  if (!itsSelectionCache) {
+      itsSelectionCache.reset(new TableSelectionCache(table()));
+  }
+  return *itsSelectionCache;
+}
+
+/// @brief obtain the cache of parallactic angles and dish pointings
+/// @details The cache is constructed on the first call to this method
+/// and a reference to it is returned thereafter
+/// @return a reference to the cache of parallactic angles and dish pointings
+const AntennaDirectionCache& SubtableInfoHolder::getDirectionCache() const
+{
+  boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
+  if (!itsDirectionCache) {
+      itsDirectionCache.reset(new AntennaDirectionCache);
+  }
+  return *itsDirectionCache;
+}
+
+/// @brief construct the given handlers now
+/// @details Handlers which already exist are not affected.
+/// @param[in] subtables handlers to construct (bitwise combination of Subtables values)
+void SubtableInfoHolder::preload(casacore::uInt subtables) const
+{
+  if (subtables & ANTENNA) {
+      getAntenna();
+  }
+  if (subtables & FEED) {
+      getFeed();
+  }
+  if (subtables & FIELD) {
+      getField();
+  }
+  if (subtables & SPECTRAL_WINDOW) {
+      getSpWindow();
+  }
+  if (subtables & POLARIZATION) {
+      getPolarisation();
+  }
+  if (subtables & DATA_DESCRIPTION) {
+      getDataDescription();
+  }
+  if (subtables & ROW_INDEX) {
+      getRowIndex();
+  }
+}
+
+/// @brief copy the handler pointer under the lock
+/// @param[in] mutex lock protecting the pointer
+/// @param[in] handler pointer to copy
+/// @return copy of the pointer
+template<typename T>
+static boost::shared_ptr<T> lockedCopy(boost::mutex &mutex, const boost::shared_ptr<T> &handler)
+{
+  boost::lock_guard<boost::mutex> lock(mutex);
+  return handler;
+}
+
+/// @brief compare a column of two tables
+/// @param[in] tab1 first table
+/// @param[in] tab2 second table
+/// @param[in] name column name
+/// @return true, if the column is present in both tables and all cells are the same
+template<typename T>
+static bool identicalColumns(const casacore::Table &tab1, const casacore::Table &tab2, const std::string &name)
+{
+  if (!tab1.tableDesc().isColumn(name) || !tab2.tableDesc().isColumn(name)) {
+      return false;
+  }
+  // units and measure reference frames are given by column keywords
+  const casacore::TableRecord &keywords1 = tab1.tableDesc().columnDesc(name).keywordSet();
+  const casacore::TableRecord &keywords2 = tab2.tableDesc().columnDesc(name).keywordSet();
+  if (keywords1.isDefined("QuantumUnits") != keywords2.isDefined("QuantumUnits")) {
+      return false;
+  }
+  if (keywords1.isDefined("QuantumUnits")) {
+      const casacore::Vector<casacore::String> units1 = keywords1.asArrayString("QuantumUnits");
+      const casacore::Vector<casacore::String> units2 = keywords2.asArrayString("QuantumUnits");
+      if (units1.nelements() != units2.nelements() || !casacore::allEQ(units1, units2)) {
+          return false;
+      }
+  }
+  if (keywords1.isDefined("MEASINFO") != keywords2.isDefined("MEASINFO")) {
+      return false;
+  }
+  if (keywords1.isDefined("MEASINFO")) {
+      const casacore::TableRecord &measInfo1 = keywords1.subRecord("MEASINFO");
+      const casacore::TableRecord &measInfo2 = keywords2.subRecord("MEASINFO");
+      if (measInfo1.isDefined("Ref") != measInfo2.isDefined("Ref") ||
+          (measInfo1.isDefined("Ref") && measInfo1.asString("Ref") != measInfo2.asString("Ref"))) {
+          return false;
+      }
+  }
+  if (tab1.tableDesc().columnDesc(name).isScalar()) {
+      return casacore::allEQ(casacore::ROScalarColumn<T>(tab1, name).getColumn(),
+                             casacore::ROScalarColumn<T>(tab2, name).getColumn());
+  }
+  casacore::ROArrayColumn<T> col1(tab1, name);
+  casacore::ROArrayColumn<T> col2(tab2, name);
+  for (casacore::uInt row = 0; row < tab1.nrow(); ++row) {
+       if (col1.isDefined(row) != col2.isDefined(row)) {
+           return false;
+       }
+       if (col1.isDefined(row)) {
+           const casacore::Array<T> cell1 = col1(row);
+           const casacore::Array<T> cell2 = col2(row);
+           if (!cell1.shape().isEqual(cell2.shape()) || !casacore::allEQ(cell1, cell2)) {
+               return false;
+           }
+       }
+  }
+  return true;
+}
+
+/// @brief check whether the given subtable is the same in two measurement sets
+/// @param[in] ms1 first measurement set
+/// @param[in] ms2 second measurement set
+/// @param[in] name subtable name
+/// @param[in] intColumns names of the columns of integer type to compare
+/// @param[in] doubleColumns names of the columns of double type to compare
+/// @param[in] stringColumns names of the columns of string type to compare
+/// @return true, if the subtables are the same physical table or have the same content
+static bool identicalSubtables(const casacore::Table &ms1, const casacore::Table &ms2,
+            const std::string &name, const char *intColumns[], const char *doubleColumns[],
+            const char *stringColumns[])
+{
+  if (!ms1.keywordSet().isDefined(name) || !ms2.keywordSet().isDefined(name)) {
+      return false;
+  }
+  const casacore::Table subtable1 = ms1.keywordSet().asTable(name);
+  const casacore::Table subtable2 = ms2.keywordSet().asTable(name);
+  if (subtable1.tableName() == subtable2.tableName()) {
+      return true;
+  }
+  if (subtable1.nrow() != subtable2.nrow()) {
+      return false;
+  }
+  for (const char **col = intColumns; *col != 0; ++col) {
+       if (!identicalColumns<casacore::Int>(subtable1, subtable2, *col)) {
+           return false;
+       }
+  }
+  for (const char **col = doubleColumns; *col != 0; ++col) {
+       if (!identicalColumns<casacore::Double>(subtable1, subtable2, *col)) {
+           return false;
+       }
+  }
+  for (const char **col = stringColumns; *col != 0; ++col) {
+       if (!identicalColumns<casacore::String>(subtable1, subtable2, *col)) {
+           return false;
+       }
+  }
+  return true;
+}
+
+/// @brief reuse handlers of another holder for identical subtables
+/// @details This is intended for a number of measurement sets observed with the
+/// same array (e.g. one per beam or sub-band). The ANTENNA, SPECTRAL_WINDOW,
+/// POLARIZATION and DATA_DESCRIPTION subtables are compared with those of the other
+/// holder (only the columns used by the handlers are compared). For identical subtables
+/// the handlers of the other holder are used from now on, if this holder hasn't created
+/// its own yet. The cache of parallactic angles and dish pointings goes along with the
+/// antenna handler. FEED and FIELD handlers keep track of the last accessed time and
+/// are never shared.
+/// @param[in] other holder to share handlers with
+/// @return number of subtables shared
+size_t SubtableInfoHolder::shareIdenticalSubtables(const SubtableInfoHolder &other) const
+{
+  const char *noColumns[] = {0};
+  size_t nShared = 0;
+  const casacore::Table &ms = table();
+  const casacore::Table &otherMS = other.table();
+  // the locks are not held while the subtables are compared or the handlers of the other holder
+  // are constructed, so two holders can share with each other from different threads
+
+  const char *antennaStrings[] = {"MOUNT", 0};
+  const char *antennaDoubles[] = {"POSITION", 0};
+  if (!lockedCopy(itsHandlerMutex, itsAntennaHandler) && !lockedCopy(itsHandlerMutex, itsDirectionCache) &&
+      identicalSubtables(ms, otherMS, "ANTENNA", noColumns, antennaDoubles, antennaStrings)) {
+      other.getAntenna();
+      other.getDirectionCache();
+      const boost::shared_ptr<IAntennaSubtableHandler const> antenna = lockedCopy(other.itsHandlerMutex,
+                                                                    other.itsAntennaHandler);
+      const boost::shared_ptr<AntennaDirectionCache const> directions = lockedCopy(other.itsHandlerMutex,
+                                                                    other.itsDirectionCache);
+      boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
+      if (!itsAntennaHandler && !itsDirectionCache) {
+          itsAntennaHandler = antenna;
+          itsDirectionCache = directions;
+          ++nShared;
+      }
+  }
+
+  const char *spWindowInts[] = {"MEAS_FREQ_REF", 0};
+  const char *spWindowDoubles[] = {"CHAN_FREQ", 0};
+  if (!lockedCopy(itsHandlerMutex, itsSpWindowHandler) &&
+      identicalSubtables(ms, otherMS, "SPECTRAL_WINDOW", spWindowInts, spWindowDoubles, noColumns)) {
+      other.getSpWindow();
+      const boost::shared_ptr<ITableSpWindowHolder const> spWindow = lockedCopy(other.itsHandlerMutex,
+                                                                    other.itsSpWindowHandler);
+      boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
+      if (!itsSpWindowHandler) {
+          itsSpWindowHandler = spWindow;
+          ++nShared;
+      }
+  }
+
+  const char *polInts[] = {"CORR_TYPE", "NUM_CORR", 0};
+  if (!lockedCopy(itsHandlerMutex, itsPolarisationHandler) &&
+      identicalSubtables(ms, otherMS, "POLARIZATION", polInts, noColumns, noColumns)) {
+      other.getPolarisation();
+      const boost::shared_ptr<ITablePolarisationHolder const> polarisation = lockedCopy(other.itsHandlerMutex,
+                                                                    other.itsPolarisationHandler);
+      boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
+      if (!itsPolarisationHandler) {
+          itsPolarisationHandler = polarisation;
+          ++nShared;
+      }
+  }
+
+  const char *dataDescInts[] = {"SPECTRAL_WINDOW_ID", "POLARIZATION_ID", 0};
+  if (!lockedCopy(itsHandlerMutex, itsDataDescHandler) &&
+      identicalSubtables(ms, otherMS, "DATA_DESCRIPTION", dataDescInts, noColumns, noColumns)) {
+      other.getDataDescription();
+      const boost::shared_ptr<ITableDataDescHolder const> dataDesc = lockedCopy(other.itsHandlerMutex,
+                                                                    other.itsDataDescHandler);
+      boost::lock_guard<boost::mutex> lock(itsHandlerMutex);
+      if (!itsDataDescHandler) {
+          itsDataDescHandler = dataDesc;
+          ++nShared;
+      }
+  }
+  return nShared;
+}
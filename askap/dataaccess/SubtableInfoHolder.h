@@ -42,6 +42,7 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 
 // own includes
 #include <askap/dataaccess/ISubtableInfoHolder.h>
@@ -63,7 +64,11 @@ namespace accessors {
 ///     4. Polarisation information
 /// Such design allows to avoid parsing of all possible subtables and
 /// building all possible derived information (which can be time consuming)
-/// when the measurement set is opened.
+/// when the measurement set is opened. The construction on first use is thread-safe,
+/// each handler is constructed exactly once even if several threads ask for it at the
+/// same time (but the table itself has to be protected by the caller, as for any other
+/// access to the table, see TableConstDataSource::tableMutex). Handlers known to be
+/// needed can be constructed in advance (see preload).
 /// @ingroup dataaccess_tm
 struct SubtableInfoHolder : virtual public ISubtableInfoHolder,
                             virtual public ITableHolder
@@ -75,7 +80,9 @@ struct SubtableInfoHolder : virtual public ISubtableInfoHolder,
    /// practical to provide reasonable defaults here
    /// @param memBuffers true if the buffers should be held in memory, false if they should be
    /// written back to the disk (table needs to be writable for this)
-   explicit SubtableInfoHolder(bool memBuffers = false);
+   /// @param bufferTileSize maximum tile size in bytes for disk-based buffers, zero means
+   /// that buffer columns are created with the default storage manager (see TableBufferManager)
+   explicit SubtableInfoHolder(bool memBuffers = false, size_t bufferTileSize = 0);
 
    /// @brief obtain data description holder
    /// @details A MemTableDataDescHolder is constructed on the first call
@@ -120,14 +127,53 @@ struct SubtableInfoHolder : virtual public ISubtableInfoHolder,
    /// to this method and a reference to it is returned thereafter
    /// @return a reference to the handler of the ANTENNA subtable
    virtual const IAntennaSubtableHandler& getAntenna() const;
-   
+
+   /// @brief obtain the row index of the main table
+   /// @details A MemTableRowIndex is constructed on the first call
+   /// to this method and a reference to it is returned thereafter
+   /// @return a reference to the row index of the main table
+   virtual const ITableRowIndex& getRowIndex() const;
+
+   /// @brief obtain the cache of table selections
+   /// @details The cache is constructed on the first call to this method
+   /// and a reference to it is returned thereafter
+   /// @return a reference to the cache of table selections
+   virtual const TableSelectionCache& getSelectionCache() const;
+
+   /// @brief obtain the cache of parallactic angles and dish pointings
+   /// @details The cache is constructed on the first call to this method
+   /// and a reference to it is returned thereafter
+   /// @return a reference to the cache of parallactic angles and dish pointings
+   virtual const AntennaDirectionCache& getDirectionCache() const;
+
+   /// @brief construct the given handlers now
+   /// @details Handlers which already exist are not affected.
+   /// @param[in] subtables handlers to construct (bitwise combination of Subtables values)
+   virtual void preload(casacore::uInt subtables) const;
+
+   /// @brief reuse handlers of another holder for identical subtables
+   /// @details This is intended for a number of measurement sets observed with the
+   /// same array (e.g. one per beam or sub-band). The ANTENNA, SPECTRAL_WINDOW,
+   /// POLARIZATION and DATA_DESCRIPTION subtables are compared with those of the other
+   /// holder (only the columns used by the handlers are compared). For identical subtables
+   /// the handlers of the other holder are used from now on, if this holder hasn't created
+   /// its own yet. The cache of parallactic angles and dish pointings goes along with the
+   /// antenna handler. FEED and FIELD handlers keep track of the last accessed time and
+   /// are never shared.
+   /// @param[in] other holder to share handlers with
+   /// @return number of subtables shared
+   size_t shareIdenticalSubtables(const SubtableInfoHolder &other) const;
    
 protected:   
 
    /// initialize itsBufferManager with an instance of TableBufferManager
+   /// @note the handler mutex should be locked by the caller
    void initBufferManager() const;
    
 private:
+   /// @brief synchronisation lock for the construction of handlers
+   mutable boost::mutex itsHandlerMutex;
+
    /// smart pointer to the handler of the data description subtable
    mutable boost::shared_ptr<ITableDataDescHolder const> itsDataDescHandler;
 
@@ -143,6 +189,9 @@ private:
    /// true if visibility buffers are kept in memory
    bool itsUseMemBuffers;
 
+   /// maximum tile size in bytes for disk-based buffers, zero means no tiling
+   size_t itsBufferTileSize;
+
    /// smart pointer to the feed subtable handler
    mutable boost::shared_ptr<IFeedSubtableHandler const> itsFeedHandler;
    
@@ -151,6 +200,15 @@ private:
    
    /// smart pointer to the antenna subtable handler
    mutable boost::shared_ptr<IAntennaSubtableHandler const> itsAntennaHandler;
+
+   /// smart pointer to the row index of the main table
+   mutable boost::shared_ptr<ITableRowIndex const> itsRowIndex;
+
+   /// smart pointer to the cache of table selections
+   mutable boost::shared_ptr<TableSelectionCache const> itsSelectionCache;
+
+   /// smart pointer to the cache of parallactic angles and dish pointings
+   mutable boost::shared_ptr<AntennaDirectionCache const> itsDirectionCache;
 };
 
 
@@ -0,0 +1,263 @@
+/// @file
+///
+/// @brief Accessor of the synthetic data source
+/// @details All fields are generated on demand by SyntheticConstDataIterator and
+/// cached until the iterator moves on.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/SyntheticConstDataAccessor.h>
+#include <askap/dataaccess/SyntheticConstDataIterator.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// construct an object linked with the given iterator
+/// @param iter a reference to associated iterator
+SyntheticConstDataAccessor::SyntheticConstDataAccessor(const SyntheticConstDataIterator &iter) :
+        itsIterator(iter) {}
+
+/// The number of rows in this chunk
+/// @return the number of rows in this chunk
+casacore::uInt SyntheticConstDataAccessor::nRow() const throw()
+{
+  return itsIterator.nRow();
+}
+
+/// The number of spectral channels (equal for all rows)
+/// @return the number of spectral channels
+casacore::uInt SyntheticConstDataAccessor::nChannel() const throw()
+{
+  return itsIterator.nChannel();
+}
+
+/// The number of polarization products (equal for all rows)
+/// @return the number of polarization products (always 4 for the synthetic data)
+casacore::uInt SyntheticConstDataAccessor::nPol() const throw()
+{
+  return itsIterator.nPol();
+}
+
+/// Visibilities (a cube is nRow x nChannel x nPol; each element is
+/// a complex visibility)
+/// @return a reference to nRow x nChannel x nPol cube, containing
+/// all visibility data
+const casacore::Cube<casacore::Complex>& SyntheticConstDataAccessor::visibility() const
+{
+  return itsVisibility.value(itsIterator, &SyntheticConstDataIterator::fillVisibility);
+}
+
+/// Cube of flags corresponding to the output of visibility()
+/// @return a reference to nRow x nChannel x nPol cube with flag
+///         information. If True, the corresponding element is flagged.
+const casacore::Cube<casacore::Bool>& SyntheticConstDataAccessor::flag() const
+{
+  return itsFlag.value(itsIterator, &SyntheticConstDataIterator::fillFlag);
+}
+
+/// UVW
+/// @return a reference to vector containing uvw-coordinates
+/// packed into a 3-D rigid vector
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& SyntheticConstDataAccessor::uvw() const
+{
+  return itsUVW.value(itsIterator, &SyntheticConstDataIterator::fillUVW);
+}
+
+/// @brief uvw after rotation
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return uvw after rotation to the new coordinate system for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	           SyntheticConstDataAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
+{
+  return itsRotatedUVW.uvw(*this, tangentPoint);
+}
+
+/// @brief delay associated with uvw rotation
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+/// @return delays corresponding to the uvw rotation for each row
+const casacore::Vector<casacore::Double>& SyntheticConstDataAccessor::uvwRotationDelay(
+	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
+{
+  return itsRotatedUVW.delays(*this, tangentPoint, imageCentre);
+}
+
+/// Frequency for each channel
+/// @return a reference to vector containing frequencies for each
+///         spectral channel (vector size is nChannel). Frequencies
+///         are given in the frame/units of the converter
+const casacore::Vector<casacore::Double>& SyntheticConstDataAccessor::frequency() const
+{
+  return itsFrequency.value(itsIterator, &SyntheticConstDataIterator::fillFrequency);
+}
+
+/// Timestamp for each row
+/// @return a timestamp for this buffer in the frame/units of the converter
+casacore::Double SyntheticConstDataAccessor::time() const
+{
+  return itsTime.value(itsIterator, &SyntheticConstDataIterator::fillTime);
+}
+
+/// First antenna IDs for all rows
+/// @return a vector with IDs of the first antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& SyntheticConstDataAccessor::antenna1() const
+{
+  return itsAntenna1.value(itsIterator, &SyntheticConstDataIterator::fillAntenna1);
+}
+
+/// Second antenna IDs for all rows
+/// @return a vector with IDs of the second antenna corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& SyntheticConstDataAccessor::antenna2() const
+{
+  return itsAntenna2.value(itsIterator, &SyntheticConstDataIterator::fillAntenna2);
+}
+
+/// First feed IDs for all rows
+/// @return a vector with IDs of the first feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& SyntheticConstDataAccessor::feed1() const
+{
+  return itsFeed1.value(itsIterator, &SyntheticConstDataIterator::fillFeed);
+}
+
+/// Second feed IDs for all rows
+/// @details Both feeds of a row are the same in the synthetic data
+/// @return a vector with IDs of the second feed corresponding
+/// to each visibility (one for each row)
+const casacore::Vector<casacore::uInt>& SyntheticConstDataAccessor::feed2() const
+{
+  return itsFeed2.value(itsIterator, &SyntheticConstDataIterator::fillFeed);
+}
+
+/// Position angles of the first feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// first feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& SyntheticConstDataAccessor::feed1PA() const
+{
+  return itsFeed1PA.value(itsIterator, &SyntheticConstDataIterator::fillFeedPA);
+}
+
+/// Position angles of the second feed for all rows
+/// @return a vector with position angles (in radians) of the
+/// second feed corresponding to each visibility
+const casacore::Vector<casacore::Float>& SyntheticConstDataAccessor::feed2PA() const
+{
+  return itsFeed2PA.value(itsIterator, &SyntheticConstDataIterator::fillFeedPA);
+}
+
+/// Return pointing centre directions of the first antenna/feed
+/// @return a vector with direction measures (coordinate system
+/// is set via IDataConverter), one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& SyntheticConstDataAccessor::pointingDir1() const
+{
+  return itsPointingDir1.value(itsIterator, &SyntheticConstDataIterator::fillPointingDir1);
+}
+
+/// Pointing centre directions of the second antenna/feed
+/// @return a vector with direction measures (coordinate system
+/// is is set via IDataConverter), one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& SyntheticConstDataAccessor::pointingDir2() const
+{
+  return itsPointingDir2.value(itsIterator, &SyntheticConstDataIterator::fillPointingDir2);
+}
+
+/// pointing direction for the centre of the first antenna
+/// @return a vector with direction measures (coordinate system
+/// is set via IDataConverter), one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& SyntheticConstDataAccessor::dishPointing1() const
+{
+  return itsDishPointing1.value(itsIterator, &SyntheticConstDataIterator::fillDishPointing1);
+}
+
+/// pointing direction for the centre of the second antenna
+/// @return a vector with direction measures (coordinate system
+/// is set via IDataConverter), one direction for each
+/// visibility/row
+const casacore::Vector<casacore::MVDirection>& SyntheticConstDataAccessor::dishPointing2() const
+{
+  return itsDishPointing2.value(itsIterator, &SyntheticConstDataIterator::fillDishPointing2);
+}
+
+/// Noise level required for a proper weighting
+/// @return a reference to nRow x nChannel x nPol cube with
+///         complex noise estimates
+const casacore::Cube<casacore::Complex>& SyntheticConstDataAccessor::noise() const
+{
+  return itsNoise.value(itsIterator, &SyntheticConstDataIterator::fillNoise);
+}
+
+/// Velocity for each channel
+/// @details Not supported by the synthetic data source
+/// @return a reference to vector containing velocities for each
+///         spectral channel
+const casacore::Vector<casacore::Double>& SyntheticConstDataAccessor::velocity() const
+{
+  throw AskapError("SyntheticConstDataAccessor::velocity has not been implemented.");
+}
+
+/// @brief polarisation type for each product
+/// @return a reference to vector containing polarisation types for
+/// each product in the visibility cube (nPol() elements).
+const casacore::Vector<casacore::Stokes::StokesTypes>& SyntheticConstDataAccessor::stokes() const
+{
+  return itsStokes.value(itsIterator, &SyntheticConstDataIterator::fillStokes);
+}
+
+/// @brief invalidate fields updated on each iteration
+/// @details The frequency axis and polarisation types are preserved
+void SyntheticConstDataAccessor::invalidateIterationCaches() const throw()
+{
+  itsVisibility.invalidate();
+  itsFlag.invalidate();
+  itsUVW.invalidate();
+  itsRotatedUVW.invalidate();
+  itsTime.invalidate();
+  itsAntenna1.invalidate();
+  itsAntenna2.invalidate();
+  itsFeed1.invalidate();
+  itsFeed2.invalidate();
+  itsFeed1PA.invalidate();
+  itsFeed2PA.invalidate();
+  itsPointingDir1.invalidate();
+  itsPointingDir2.invalidate();
+  itsDishPointing1.invalidate();
+  itsDishPointing2.invalidate();
+  itsNoise.invalidate();
+}
+
+/// @brief invalidate the frequency axis
+/// @details It depends on time if a frame conversion is required
+void SyntheticConstDataAccessor::invalidateSpectralCaches() const throw()
+{
+  itsFrequency.invalidate();
+}
@@ -0,0 +1,251 @@
+/// @file
+///
+/// @brief Accessor of the synthetic data source
+/// @details This accessor works in tandem with SyntheticConstDataIterator. All fields
+/// are generated on demand by the iterator and cached until the iterator moves on,
+/// the same way TableConstDataAccessor caches fields read from the table.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_ACCESSOR_H
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/CachedAccessorField.h>
+#include <askap/dataaccess/UVWRotationHandler.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// to be able to link this class to appropriate iterator
+class SyntheticConstDataIterator;
+
+/// @brief Accessor of the synthetic data source
+/// @details All fields are generated by the associated iterator on the first access.
+/// Rotated uvw are handled by UVWRotationHandler, as for the table-based accessor.
+/// Velocities are not supported.
+/// @ingroup dataaccess_hlp
+class SyntheticConstDataAccessor : virtual public IConstDataAccessor {
+public:
+  /// construct an object linked with the given iterator
+  /// @param iter a reference to associated iterator
+  explicit SyntheticConstDataAccessor(const SyntheticConstDataIterator &iter);
+
+  /// The number of rows in this chunk
+  /// @return the number of rows in this chunk
+  virtual casacore::uInt nRow() const throw();
+
+  /// The number of spectral channels (equal for all rows)
+  /// @return the number of spectral channels
+  virtual casacore::uInt nChannel() const throw();
+
+  /// The number of polarization products (equal for all rows)
+  /// @return the number of polarization products (always 4 for the synthetic data)
+  virtual casacore::uInt nPol() const throw();
+
+  /// Visibilities (a cube is nRow x nChannel x nPol; each element is
+  /// a complex visibility)
+  /// @return a reference to nRow x nChannel x nPol cube, containing
+  /// all visibility data
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// Cube of flags corresponding to the output of visibility()
+  /// @return a reference to nRow x nChannel x nPol cube with flag
+  ///         information. If True, the corresponding element is flagged.
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+  /// UVW
+  /// @return a reference to vector containing uvw-coordinates
+  /// packed into a 3-D rigid vector
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw() const;
+
+  /// @brief uvw after rotation
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @return uvw after rotation to the new coordinate system for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+	           rotatedUVW(const casacore::MDirection &tangentPoint) const;
+
+  /// @brief delay associated with uvw rotation
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+  /// @return delays corresponding to the uvw rotation for each row
+  virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
+	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const;
+
+  /// Frequency for each channel
+  /// @return a reference to vector containing frequencies for each
+  ///         spectral channel (vector size is nChannel). Frequencies
+  ///         are given in the frame/units of the converter
+  virtual const casacore::Vector<casacore::Double>& frequency() const;
+
+  /// Timestamp for each row
+  /// @return a timestamp for this buffer in the frame/units of the converter
+  virtual casacore::Double time() const;
+
+  /// First antenna IDs for all rows
+  /// @return a vector with IDs of the first antenna corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& antenna1() const;
+
+  /// Second antenna IDs for all rows
+  /// @return a vector with IDs of the second antenna corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& antenna2() const;
+
+  /// First feed IDs for all rows
+  /// @return a vector with IDs of the first feed corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& feed1() const;
+
+  /// Second feed IDs for all rows
+  /// @return a vector with IDs of the second feed corresponding
+  /// to each visibility (one for each row)
+  virtual const casacore::Vector<casacore::uInt>& feed2() const;
+
+  /// Position angles of the first feed for all rows
+  /// @return a vector with position angles (in radians) of the
+  /// first feed corresponding to each visibility
+  virtual const casacore::Vector<casacore::Float>& feed1PA() const;
+
+  /// Position angles of the second feed for all rows
+  /// @return a vector with position angles (in radians) of the
+  /// second feed corresponding to each visibility
+  virtual const casacore::Vector<casacore::Float>& feed2PA() const;
+
+  /// Return pointing centre directions of the first antenna/feed
+  /// @return a vector with direction measures (coordinate system
+  /// is set via IDataConverter), one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir1() const;
+
+  /// Pointing centre directions of the second antenna/feed
+  /// @return a vector with direction measures (coordinate system
+  /// is is set via IDataConverter), one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir2() const;
+
+  /// pointing direction for the centre of the first antenna
+  /// @return a vector with direction measures (coordinate system
+  /// is set via IDataConverter), one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing1() const;
+
+  /// pointing direction for the centre of the second antenna
+  /// @return a vector with direction measures (coordinate system
+  /// is set via IDataConverter), one direction for each
+  /// visibility/row
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing2() const;
+
+  /// Noise level required for a proper weighting
+  /// @return a reference to nRow x nChannel x nPol cube with
+  ///         complex noise estimates
+  virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// Velocity for each channel
+  /// @details Not supported by the synthetic data source
+  /// @return a reference to vector containing velocities for each
+  ///         spectral channel
+  virtual const casacore::Vector<casacore::Double>& velocity() const;
+
+  /// @brief polarisation type for each product
+  /// @return a reference to vector containing polarisation types for
+  /// each product in the visibility cube (nPol() elements).
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const;
+
+  /// @brief invalidate fields updated on each iteration
+  /// @details The frequency axis and polarisation types are preserved
+  void invalidateIterationCaches() const throw();
+
+  /// @brief invalidate the frequency axis
+  /// @details It depends on time if a frame conversion is required
+  void invalidateSpectralCaches() const throw();
+
+private:
+  /// @brief associated iterator
+  const SyntheticConstDataIterator &itsIterator;
+
+  /// @brief cached visibility cube
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsVisibility;
+
+  /// @brief cached flag cube
+  CachedAccessorField<casacore::Cube<casacore::Bool> > itsFlag;
+
+  /// @brief cached uvw
+  CachedAccessorField<casacore::Vector<casacore::RigidVector<casacore::Double, 3> > > itsUVW;
+
+  /// @brief rotated uvw with the associated delays
+  UVWRotationHandler itsRotatedUVW;
+
+  /// @brief cached frequency axis
+  CachedAccessorField<casacore::Vector<casacore::Double> > itsFrequency;
+
+  /// @brief cached time
+  CachedAccessorField<casacore::Double> itsTime;
+
+  /// @brief cached first antenna IDs
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsAntenna1;
+
+  /// @brief cached second antenna IDs
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsAntenna2;
+
+  /// @brief cached first feed IDs
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsFeed1;
+
+  /// @brief cached second feed IDs
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsFeed2;
+
+  /// @brief cached position angles of the first feed
+  CachedAccessorField<casacore::Vector<casacore::Float> > itsFeed1PA;
+
+  /// @brief cached position angles of the second feed
+  CachedAccessorField<casacore::Vector<casacore::Float> > itsFeed2PA;
+
+  /// @brief cached pointing directions of the first feed
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsPointingDir1;
+
+  /// @brief cached pointing directions of the second feed
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsPointingDir2;
+
+  /// @brief cached pointing directions of the first dish
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsDishPointing1;
+
+  /// @brief cached pointing directions of the second dish
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsDishPointing2;
+
+  /// @brief cached noise cube
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsNoise;
+
+  /// @brief cached polarisation types
+  CachedAccessorField<casacore::Vector<casacore::Stokes::StokesTypes> > itsStokes;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_ACCESSOR_H
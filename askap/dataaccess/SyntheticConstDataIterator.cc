@@ -0,0 +1,379 @@
+/// @file
+///
+/// @brief Iterator of the synthetic data source
+/// @details This iterator steps through the cycles of a synthetic observation and
+/// generates the data on demand.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/SyntheticConstDataIterator.h>
+#include <askap/dataaccess/BatchDirectionConverter.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Quanta/MVEpoch.h>
+#include <casacore/measures/Measures/MFrequency.h>
+#include <casacore/measures/Measures/MDirection.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the iterator
+/// @param[in] obs synthetic observation to generate the data for
+/// @param[in] sel selector
+/// @param[in] conv converter
+/// @param[in] maxChunkSize maximum number of rows per accessor
+SyntheticConstDataIterator::SyntheticConstDataIterator(const boost::shared_ptr<SyntheticObservation const> &obs,
+                             const boost::shared_ptr<SyntheticDataSelector const> &sel,
+                             const boost::shared_ptr<IDataConverterImpl const> &conv,
+                             casacore::uInt maxChunkSize) : itsObservation(obs), itsMaxChunkSize(maxChunkSize),
+        itsStartChan(0), itsNChan(0), itsCycleIndex(0), itsTopRow(0), itsDirectionCacheCycle(-1), itsAccessor(*this)
+{
+  ASKAPCHECK(obs, "An attempt to create SyntheticConstDataIterator for an empty observation");
+  ASKAPDEBUGASSERT(sel);
+  ASKAPDEBUGASSERT(conv);
+  ASKAPCHECK(itsMaxChunkSize > 0, "Maximum chunk size should be positive");
+  // take copies, so changes to the selector or converter don't affect the iteration
+  itsSelector.reset(new SyntheticDataSelector(*sel));
+  itsConverter = conv->clone();
+  itsNChan = itsObservation->nChannels();
+  if (itsSelector->channelsSelected()) {
+      ASKAPCHECK(itsSelector->startChannel() + itsSelector->nChannels() <= itsNChan, "Channel selection (start="<<
+                 itsSelector->startChannel()<<", nChan="<<itsSelector->nChannels()<<") is beyond "<<itsNChan<<
+                 " channels available");
+      itsStartChan = itsSelector->startChannel();
+      itsNChan = itsSelector->nChannels();
+  }
+  const casacore::uInt nAnt = itsObservation->nAntennas();
+  for (casacore::uInt beam = 0; beam < itsObservation->nBeams(); ++beam) {
+       for (casacore::uInt ant1 = 0; ant1 < nAnt; ++ant1) {
+            for (casacore::uInt ant2 = ant1; ant2 < nAnt; ++ant2) {
+                 if (itsSelector->rowSelected(beam, ant1, ant2)) {
+                     itsBeams.push_back(beam);
+                     itsAnt1.push_back(ant1);
+                     itsAnt2.push_back(ant2);
+                 }
+            }
+       }
+  }
+  for (casacore::uInt cycle = 0; cycle < itsObservation->nCycles(); ++cycle) {
+       const double time = itsObservation->time(cycle);
+       const casacore::MEpoch epoch(casacore::MVEpoch(casacore::Quantity(time, "s")), casacore::MEpoch::UTC);
+       if (itsSelector->cycleSelected(cycle, time, itsConverter->epoch(epoch))) {
+           itsCycles.push_back(cycle);
+       }
+  }
+  init();
+}
+
+/// Restart the iteration from the beginning
+void SyntheticConstDataIterator::init()
+{
+  itsCycleIndex = 0;
+  itsTopRow = 0;
+  itsDirectionCacheCycle = -1;
+  itsAccessor.invalidateIterationCaches();
+  itsAccessor.invalidateSpectralCaches();
+}
+
+/// Return the data accessor (current chunk) in various ways
+/// @return a reference to the current chunk
+const IConstDataAccessor& SyntheticConstDataIterator::operator*() const
+{
+  ASKAPCHECK(hasMore(), "An attempt to access the data past the end of the synthetic observation");
+  return itsAccessor;
+}
+
+/// Checks whether there are more data available.
+/// @return True if there are more data available
+casacore::Bool SyntheticConstDataIterator::hasMore() const throw()
+{
+  return (itsCycleIndex < itsCycles.size()) && !itsBeams.empty();
+}
+
+/// advance the iterator one step further
+/// @return True if there are more data (so constructions like
+///         while(it.next()) {} are possible)
+casacore::Bool SyntheticConstDataIterator::next()
+{
+  if (!hasMore()) {
+      return false;
+  }
+  itsTopRow += nRow();
+  if (itsTopRow >= itsBeams.size()) {
+      itsTopRow = 0;
+      ++itsCycleIndex;
+      // frame conversion of the frequency axis depends on time
+      itsAccessor.invalidateSpectralCaches();
+  }
+  itsAccessor.invalidateIterationCaches();
+  return hasMore();
+}
+
+/// @return number of rows in the current chunk
+casacore::uInt SyntheticConstDataIterator::nRow() const throw()
+{
+  if (!hasMore()) {
+      return 0;
+  }
+  return std::min(itsMaxChunkSize, casacore::uInt(itsBeams.size() - itsTopRow));
+}
+
+/// @brief compute visibilities
+/// @param[in] vis cube to fill
+void SyntheticConstDataIterator::fillVisibility(casacore::Cube<casacore::Complex> &vis) const
+{
+  DataAccessStatistics::ScopedTimer timer("SyntheticConstDataIterator::fillVisibility");
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = itsAccessor.uvw();
+  vis.resize(nRow(), nChannel(), nPol());
+  for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+       itsObservation->fillVisibility(uvw[row], itsStartChan, row, vis);
+  }
+  timer.addBytes(vis.nelements() * sizeof(casacore::Complex));
+}
+
+/// @brief compute flags
+/// @param[in] flag cube to fill
+void SyntheticConstDataIterator::fillFlag(casacore::Cube<casacore::Bool> &flag) const
+{
+  DataAccessStatistics::ScopedTimer timer("SyntheticConstDataIterator::fillFlag");
+  const casacore::Vector<casacore::Bool> &chanFlags = itsObservation->channelFlags();
+  const casacore::uInt cycle = itsCycles[itsCycleIndex];
+  flag.resize(nRow(), nChannel(), nPol());
+  for (casacore::uInt row = 0; row < flag.nrow(); ++row) {
+       const casacore::uInt index = itsTopRow + row;
+       const bool rowFlag = itsObservation->rowFlagged(cycle, itsBeams[index], itsAnt1[index], itsAnt2[index]);
+       for (casacore::uInt chan = 0; chan < flag.ncolumn(); ++chan) {
+            const casacore::Bool value = rowFlag || chanFlags[itsStartChan + chan];
+            for (casacore::uInt pol = 0; pol < flag.nplane(); ++pol) {
+                 flag(row, chan, pol) = value;
+            }
+       }
+  }
+  timer.addBytes(flag.nelements() * sizeof(casacore::Bool));
+}
+
+/// @brief compute uvw
+/// @param[in] uvw vector to fill
+void SyntheticConstDataIterator::fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw) const
+{
+  const casacore::uInt cycle = itsCycles[itsCycleIndex];
+  uvw.resize(nRow());
+  for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+       const casacore::uInt index = itsTopRow + row;
+       uvw[row] = itsObservation->uvw(cycle, itsBeams[index], itsAnt1[index], itsAnt2[index]);
+  }
+}
+
+/// @brief compute the frequency axis
+/// @details Synthetic frequencies are topocentric and given in Hz
+/// @param[in] freq vector to fill
+void SyntheticConstDataIterator::fillFrequency(casacore::Vector<casacore::Double> &freq) const
+{
+  ASKAPDEBUGASSERT(itsConverter);
+  const casacore::MFrequency::Ref topo(casacore::MFrequency::TOPO);
+  const casacore::Unit hz("Hz");
+  const casacore::Vector<casacore::Double> &allFreqs = itsObservation->frequencies();
+  if (itsConverter->isVoid(topo, hz) && !itsSelector->channelsSelected()) {
+      freq.reference(allFreqs);
+      return;
+  }
+  casacore::Vector<casacore::Double> chanFreqs(nChannel());
+  for (casacore::uInt chan = 0; chan < chanFreqs.nelements(); ++chan) {
+       chanFreqs[chan] = allFreqs[itsStartChan + chan];
+  }
+  const casacore::MDirection centre(itsObservation->phaseCentre(), casacore::MDirection::J2000);
+  itsConverter->frequencies(0, chanFreqs, topo, hz, currentEpoch(), itsObservation->antennaPosition(0),
+                            centre, freq);
+}
+
+/// @brief compute the time of the current cycle
+/// @param[in] time buffer to fill
+void SyntheticConstDataIterator::fillTime(casacore::Double &time) const
+{
+  ASKAPDEBUGASSERT(itsConverter);
+  time = itsConverter->epoch(currentEpoch());
+}
+
+/// @brief fill the first antenna IDs
+/// @param[in] ids vector to fill
+void SyntheticConstDataIterator::fillAntenna1(casacore::Vector<casacore::uInt> &ids) const
+{
+  fillIndex(ids, itsAnt1);
+}
+
+/// @brief fill the second antenna IDs
+/// @param[in] ids vector to fill
+void SyntheticConstDataIterator::fillAntenna2(casacore::Vector<casacore::uInt> &ids) const
+{
+  fillIndex(ids, itsAnt2);
+}
+
+/// @brief fill feed IDs
+/// @details Both feeds of a row are the same
+/// @param[in] ids vector to fill
+void SyntheticConstDataIterator::fillFeed(casacore::Vector<casacore::uInt> &ids) const
+{
+  fillIndex(ids, itsBeams);
+}
+
+/// @brief fill the position angles of feeds
+/// @details ASKAP antennas track the sky with the third axis, so the position angle is zero
+/// @param[in] pa vector to fill
+void SyntheticConstDataIterator::fillFeedPA(casacore::Vector<casacore::Float> &pa) const
+{
+  pa.resize(nRow());
+  pa.set(0.);
+}
+
+/// @brief fill pointing directions of the first antenna/feed
+/// @param[in] dirs vector to fill
+void SyntheticConstDataIterator::fillPointingDir1(casacore::Vector<casacore::MVDirection> &dirs) const
+{
+  fillDirections(dirs, itsAnt1, true);
+}
+
+/// @brief fill pointing directions of the second antenna/feed
+/// @param[in] dirs vector to fill
+void SyntheticConstDataIterator::fillPointingDir2(casacore::Vector<casacore::MVDirection> &dirs) const
+{
+  fillDirections(dirs, itsAnt2, true);
+}
+
+/// @brief fill dish pointing directions of the first antenna
+/// @param[in] dirs vector to fill
+void SyntheticConstDataIterator::fillDishPointing1(casacore::Vector<casacore::MVDirection> &dirs) const
+{
+  fillDirections(dirs, itsAnt1, false);
+}
+
+/// @brief fill dish pointing directions of the second antenna
+/// @param[in] dirs vector to fill
+void SyntheticConstDataIterator::fillDishPointing2(casacore::Vector<casacore::MVDirection> &dirs) const
+{
+  fillDirections(dirs, itsAnt2, false);
+}
+
+/// @brief fill the noise cube
+/// @param[in] noise cube to fill
+void SyntheticConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise) const
+{
+  const casacore::Float sigma = itsObservation->noise();
+  noise.resize(nRow(), nChannel(), nPol());
+  noise.set(casacore::Complex(sigma, sigma));
+}
+
+/// @brief fill polarisation types
+/// @param[in] stokes vector to fill
+void SyntheticConstDataIterator::fillStokes(casacore::Vector<casacore::Stokes::StokesTypes> &stokes) const
+{
+  stokes.resize(nPol());
+  stokes[0] = casacore::Stokes::XX;
+  stokes[1] = casacore::Stokes::XY;
+  stokes[2] = casacore::Stokes::YX;
+  stokes[3] = casacore::Stokes::YY;
+}
+
+/// @return epoch of the current cycle
+casacore::MEpoch SyntheticConstDataIterator::currentEpoch() const
+{
+  ASKAPDEBUGASSERT(itsCycleIndex < itsCycles.size());
+  return casacore::MEpoch(casacore::MVEpoch(casacore::Quantity(itsObservation->time(itsCycles[itsCycleIndex]), "s")),
+                          casacore::MEpoch::UTC);
+}
+
+/// @brief compute directions of all antennas and beams for the current cycle
+/// @details The result is cached, so both pointingDir1 and pointingDir2 reuse it
+void SyntheticConstDataIterator::updateDirectionCache() const
+{
+  const long cycle = long(itsCycles[itsCycleIndex]);
+  if (itsDirectionCacheCycle == cycle) {
+      return;
+  }
+  ASKAPDEBUGASSERT(itsConverter);
+  const casacore::uInt nAnt = itsObservation->nAntennas();
+  const casacore::uInt nBeam = itsObservation->nBeams();
+  casacore::Vector<casacore::MVDirection> beams(nBeam);
+  for (casacore::uInt beam = 0; beam < nBeam; ++beam) {
+       beams[beam] = itsObservation->beamDirection(beam);
+  }
+  const casacore::MDirection::Ref inRef(casacore::MDirection::J2000);
+  const casacore::MDirection centre(itsObservation->phaseCentre(), inRef);
+  BatchDirectionConverter dirConv(itsConverter->directionFrame());
+  dirConv.setEpoch(currentEpoch());
+  itsBeamDirections.resize(nAnt, nBeam);
+  itsDishDirections.resize(nAnt);
+  casacore::Vector<casacore::MVDirection> converted;
+  if (!dirConv.needsPosition(inRef)) {
+      // celestial frames, the result is the same for all antennas
+      dirConv.convert(beams, inRef, converted);
+      const casacore::MVDirection dish = dirConv(centre);
+      for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+           itsBeamDirections.row(ant) = converted;
+           itsDishDirections[ant] = dish;
+      }
+  } else {
+      for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+           dirConv.setPosition(itsObservation->antennaPosition(ant));
+           dirConv.convert(beams, inRef, converted);
+           itsBeamDirections.row(ant) = converted;
+           itsDishDirections[ant] = dirConv(centre);
+      }
+  }
+  itsDirectionCacheCycle = cycle;
+}
+
+/// @brief fill the given vector with pointing directions
+/// @param[in] dirs vector to fill
+/// @param[in] ants antenna IDs of all selected rows in the cycle
+/// @param[in] beamCentre true to use the beam directions, false for the dish pointing
+void SyntheticConstDataIterator::fillDirections(casacore::Vector<casacore::MVDirection> &dirs,
+                                 const std::vector<casacore::uInt> &ants, bool beamCentre) const
+{
+  updateDirectionCache();
+  dirs.resize(nRow());
+  for (casacore::uInt row = 0; row < dirs.nelements(); ++row) {
+       const casacore::uInt index = itsTopRow + row;
+       dirs[row] = beamCentre ? itsBeamDirections(ants[index], itsBeams[index]) : itsDishDirections[ants[index]];
+  }
+}
+
+/// @brief copy the part of the given row index which corresponds to the current chunk
+/// @param[in] ids vector to fill
+/// @param[in] index row index for the whole cycle
+void SyntheticConstDataIterator::fillIndex(casacore::Vector<casacore::uInt> &ids,
+                                 const std::vector<casacore::uInt> &index) const
+{
+  ids.resize(nRow());
+  for (casacore::uInt row = 0; row < ids.nelements(); ++row) {
+       ids[row] = index[itsTopRow + row];
+  }
+}
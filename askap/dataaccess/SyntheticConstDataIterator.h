@@ -0,0 +1,241 @@
+/// @file
+///
+/// @brief Iterator of the synthetic data source
+/// @details This iterator steps through the cycles of a synthetic observation and
+/// generates the data on demand. Nothing is read from disk, so the cost of iteration is
+/// the cost of the calculations and memory traffic only.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_ITERATOR_H
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/IDataConverterImpl.h>
+#include <askap/dataaccess/SyntheticConstDataAccessor.h>
+#include <askap/dataaccess/SyntheticDataSelector.h>
+#include <askap/dataaccess/SyntheticObservation.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// casa includes
+#include <casacore/measures/Measures/MEpoch.h>
+
+// std includes
+#include <vector>
+#include <climits>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Iterator of the synthetic data source
+/// @details Within each cycle, rows are ordered by beam, then by the first and the second
+/// antenna (including auto-correlations), which is the order of ASKAP measurement sets.
+/// Rows passing the selection are delivered in chunks of at most maxChunkSize rows,
+/// a chunk never spans two cycles.
+/// @ingroup dataaccess_hlp
+class SyntheticConstDataIterator : public IConstDataIterator {
+public:
+  /// @brief set up the iterator
+  /// @param[in] obs synthetic observation to generate the data for
+  /// @param[in] sel selector
+  /// @param[in] conv converter
+  /// @param[in] maxChunkSize maximum number of rows per accessor
+  SyntheticConstDataIterator(const boost::shared_ptr<SyntheticObservation const> &obs,
+                             const boost::shared_ptr<SyntheticDataSelector const> &sel,
+                             const boost::shared_ptr<IDataConverterImpl const> &conv,
+                             casacore::uInt maxChunkSize = INT_MAX);
+
+  /// Restart the iteration from the beginning
+  virtual void init();
+
+  /// Return the data accessor (current chunk) in various ways
+  /// @return a reference to the current chunk
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// Checks whether there are more data available.
+  /// @return True if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// advance the iterator one step further
+  /// @return True if there are more data (so constructions like
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @return number of rows in the current chunk
+  casacore::uInt nRow() const throw();
+
+  /// @return number of channels
+  inline casacore::uInt nChannel() const throw() { return itsNChan; }
+
+  /// @return number of polarisation products
+  inline casacore::uInt nPol() const throw() { return itsObservation->nPol(); }
+
+  /// @return number of rows per cycle passing the selection
+  inline casacore::uInt nRowsPerCycle() const { return itsBeams.size(); }
+
+  /// @return number of cycles passing the selection
+  inline casacore::uInt nCycles() const { return itsCycles.size(); }
+
+  /// @brief compute visibilities
+  /// @param[in] vis cube to fill
+  void fillVisibility(casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief compute flags
+  /// @param[in] flag cube to fill
+  void fillFlag(casacore::Cube<casacore::Bool> &flag) const;
+
+  /// @brief compute uvw
+  /// @param[in] uvw vector to fill
+  void fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw) const;
+
+  /// @brief compute the frequency axis
+  /// @param[in] freq vector to fill
+  void fillFrequency(casacore::Vector<casacore::Double> &freq) const;
+
+  /// @brief compute the time of the current cycle
+  /// @param[in] time buffer to fill
+  void fillTime(casacore::Double &time) const;
+
+  /// @brief fill the first antenna IDs
+  /// @param[in] ids vector to fill
+  void fillAntenna1(casacore::Vector<casacore::uInt> &ids) const;
+
+  /// @brief fill the second antenna IDs
+  /// @param[in] ids vector to fill
+  void fillAntenna2(casacore::Vector<casacore::uInt> &ids) const;
+
+  /// @brief fill feed IDs
+  /// @details Both feeds of a row are the same
+  /// @param[in] ids vector to fill
+  void fillFeed(casacore::Vector<casacore::uInt> &ids) const;
+
+  /// @brief fill the position angles of feeds
+  /// @details ASKAP antennas track the sky with the third axis, so the position angle is zero
+  /// @param[in] pa vector to fill
+  void fillFeedPA(casacore::Vector<casacore::Float> &pa) const;
+
+  /// @brief fill pointing directions of the first antenna/feed
+  /// @param[in] dirs vector to fill
+  void fillPointingDir1(casacore::Vector<casacore::MVDirection> &dirs) const;
+
+  /// @brief fill pointing directions of the second antenna/feed
+  /// @param[in] dirs vector to fill
+  void fillPointingDir2(casacore::Vector<casacore::MVDirection> &dirs) const;
+
+  /// @brief fill dish pointing directions of the first antenna
+  /// @param[in] dirs vector to fill
+  void fillDishPointing1(casacore::Vector<casacore::MVDirection> &dirs) const;
+
+  /// @brief fill dish pointing directions of the second antenna
+  /// @param[in] dirs vector to fill
+  void fillDishPointing2(casacore::Vector<casacore::MVDirection> &dirs) const;
+
+  /// @brief fill the noise cube
+  /// @param[in] noise cube to fill
+  void fillNoise(casacore::Cube<casacore::Complex> &noise) const;
+
+  /// @brief fill polarisation types
+  /// @param[in] stokes vector to fill
+  void fillStokes(casacore::Vector<casacore::Stokes::StokesTypes> &stokes) const;
+
+private:
+  /// @return epoch of the current cycle
+  casacore::MEpoch currentEpoch() const;
+
+  /// @brief compute directions of all antennas and beams for the current cycle
+  /// @details The result is cached, so both pointingDir1 and pointingDir2 reuse it
+  void updateDirectionCache() const;
+
+  /// @brief fill the given vector with pointing directions
+  /// @param[in] dirs vector to fill
+  /// @param[in] ants antenna IDs of all selected rows in the cycle
+  /// @param[in] beamCentre true to use the beam directions, false for the dish pointing
+  void fillDirections(casacore::Vector<casacore::MVDirection> &dirs, const std::vector<casacore::uInt> &ants,
+                      bool beamCentre) const;
+
+  /// @brief copy the part of the given row index which corresponds to the current chunk
+  /// @param[in] ids vector to fill
+  /// @param[in] index row index for the whole cycle
+  void fillIndex(casacore::Vector<casacore::uInt> &ids, const std::vector<casacore::uInt> &index) const;
+
+  /// @brief observation
+  boost::shared_ptr<SyntheticObservation const> itsObservation;
+
+  /// @brief selector
+  boost::shared_ptr<SyntheticDataSelector const> itsSelector;
+
+  /// @brief converter
+  boost::shared_ptr<IDataConverterImpl const> itsConverter;
+
+  /// @brief maximum number of rows per accessor
+  casacore::uInt itsMaxChunkSize;
+
+  /// @brief first selected channel
+  casacore::uInt itsStartChan;
+
+  /// @brief number of selected channels
+  casacore::uInt itsNChan;
+
+  /// @brief selected cycles
+  std::vector<casacore::uInt> itsCycles;
+
+  /// @brief beam of each selected row within a cycle
+  std::vector<casacore::uInt> itsBeams;
+
+  /// @brief first antenna of each selected row within a cycle
+  std::vector<casacore::uInt> itsAnt1;
+
+  /// @brief second antenna of each selected row within a cycle
+  std::vector<casacore::uInt> itsAnt2;
+
+  /// @brief index of the current cycle in itsCycles
+  size_t itsCycleIndex;
+
+  /// @brief first row of the current chunk within the selected rows of the cycle
+  casacore::uInt itsTopRow;
+
+  /// @brief cycle for which directions have been computed, negative if none
+  mutable long itsDirectionCacheCycle;
+
+  /// @brief directions of all beams (nAnt x nBeam) for the cached cycle in the converter frame
+  mutable casacore::Matrix<casacore::MVDirection> itsBeamDirections;
+
+  /// @brief dish pointing directions of all antennas for the cached cycle in the converter frame
+  mutable casacore::Vector<casacore::MVDirection> itsDishDirections;
+
+  /// @brief accessor
+  SyntheticConstDataAccessor itsAccessor;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_ITERATOR_H
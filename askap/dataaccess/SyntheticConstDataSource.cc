@@ -0,0 +1,85 @@
+/// @file
+///
+/// @brief Read-only data source generating a synthetic observation on the fly
+/// @details The observation is described by SyntheticObservation, the data are
+/// computed by SyntheticConstDataIterator when requested.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/SyntheticConstDataSource.h>
+#include <askap/dataaccess/SyntheticConstDataIterator.h>
+#include <askap/dataaccess/SyntheticDataSelector.h>
+#include <askap/dataaccess/BasicDataConverter.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct the data source
+/// @param[in] obs description of the observation (a copy is taken)
+/// @param[in] maxChunkSize maximum number of rows per accessor
+SyntheticConstDataSource::SyntheticConstDataSource(const SyntheticObservation &obs, casacore::uInt maxChunkSize) :
+         itsObservation(new SyntheticObservation(obs)), itsMaxChunkSize(maxChunkSize)
+{
+  ASKAPCHECK(itsMaxChunkSize > 0, "Maximum chunk size should be positive");
+}
+
+/// @brief create a converter object corresponding to this type of the DataSource
+/// @return a shared pointer to a new DataConverter object
+IDataConverterPtr SyntheticConstDataSource::createConverter() const
+{
+  return IDataConverterPtr(new BasicDataConverter);
+}
+
+/// @brief get iterator over a selected part of the dataset
+/// @param[in] sel a shared pointer to the selector object defining
+///            which subset of the data is used (must be created by this data source)
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @return a shared pointer to DataIterator object
+boost::shared_ptr<IConstDataIterator> SyntheticConstDataSource::createConstIterator(const
+             IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv) const
+{
+  boost::shared_ptr<SyntheticDataSelector const> synthSel =
+           boost::dynamic_pointer_cast<SyntheticDataSelector const>(sel);
+  boost::shared_ptr<IDataConverterImpl const> implConv =
+           boost::dynamic_pointer_cast<IDataConverterImpl const>(conv);
+  if (!synthSel || !implConv) {
+      ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
+                 "converter are received by the createConstIterator method");
+  }
+  return boost::shared_ptr<IConstDataIterator>(new SyntheticConstDataIterator(itsObservation, synthSel,
+                implConv, itsMaxChunkSize));
+}
+
+/// @brief create a selector object corresponding to this type of the DataSource
+/// @return a shared pointer to the DataSelector corresponding to this type of DataSource
+IDataSelectorPtr SyntheticConstDataSource::createSelector() const
+{
+  return IDataSelectorPtr(new SyntheticDataSelector);
+}
@@ -0,0 +1,106 @@
+/// @file
+///
+/// @brief Read-only data source generating a synthetic observation on the fly
+/// @details DataAccessorStub and DataIteratorStub are tiny fixed-size stubs for unit tests.
+/// This data source produces ASKAP-scale visibility streams (by default 36 antennas,
+/// 36 beams) with realistic uvw tracks and flagging patterns at memory speed. It allows
+/// benchmarking of gridders, calibrators and adapters without disk in the loop.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_SOURCE_H
+#define ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_SOURCE_H
+
+// own includes
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/SyntheticObservation.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <climits>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Read-only data source generating a synthetic observation on the fly
+/// @details The observation is described by SyntheticObservation, the data are
+/// computed by the iterator when the accessor fields are requested. Iterators
+/// created by this source are independent and can be used from different threads.
+/// The converter is BasicDataConverter (as for table-based sources); the synthetic
+/// frequencies are topocentric and time is given in UTC. Selection is done with
+/// SyntheticDataSelector, which supports a subset of IDataSelector criteria.
+///
+/// A full ASKAP cycle (36 beams, all baselines) with tens of thousands channels
+/// doesn't fit into memory, use the chunk size or the selection to limit the size
+/// of each accessor.
+/// @ingroup dataaccess_hlp
+class SyntheticConstDataSource : virtual public IConstDataSource {
+public:
+  /// @brief construct the data source
+  /// @param[in] obs description of the observation (a copy is taken)
+  /// @param[in] maxChunkSize maximum number of rows per accessor
+  explicit SyntheticConstDataSource(const SyntheticObservation &obs = SyntheticObservation(),
+                                    casacore::uInt maxChunkSize = INT_MAX);
+
+  /// @brief create a converter object corresponding to this type of the DataSource
+  /// @return a shared pointer to a new DataConverter object
+  virtual IDataConverterPtr createConverter() const;
+
+  /// @brief get iterator over a selected part of the dataset
+  /// @param[in] sel a shared pointer to the selector object defining
+  ///            which subset of the data is used (must be created by this data source)
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @return a shared pointer to DataIterator object
+  virtual boost::shared_ptr<IConstDataIterator> createConstIterator(const
+             IDataSelectorConstPtr &sel, const IDataConverterConstPtr &conv) const;
+
+  // we need this to get access to the overloaded syntax in the base class
+  using IConstDataSource::createConstIterator;
+
+  /// @brief create a selector object corresponding to this type of the DataSource
+  /// @return a shared pointer to the DataSelector corresponding to this type of DataSource
+  virtual IDataSelectorPtr createSelector() const;
+
+  /// @return description of the observation
+  inline const SyntheticObservation& observation() const { return *itsObservation; }
+
+private:
+  /// @brief description of the observation
+  boost::shared_ptr<SyntheticObservation const> itsObservation;
+
+  /// @brief maximum number of rows per accessor
+  casacore::uInt itsMaxChunkSize;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_CONST_DATA_SOURCE_H
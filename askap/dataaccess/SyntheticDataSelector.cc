@@ -0,0 +1,260 @@
+/// @file
+///
+/// @brief Selector for the synthetic data source
+/// @details The selection is kept as a set of index ranges rather than a table expression.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/SyntheticDataSelector.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <climits>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty selection
+SyntheticDataSelector::SyntheticDataSelector() : itsFeed(-1), itsAnt1(-1), itsAnt2(-1), itsAutoOnly(false),
+        itsCrossOnly(false), itsNChan(0), itsStartChan(0), itsStartCycle(0), itsStopCycle(UINT_MAX),
+        itsEpochRangeSelected(false), itsStartEpoch(0.), itsStopEpoch(0.), itsTimeRangeSelected(false),
+        itsStartTime(0.), itsStopTime(0.), itsAccessorFields(IDataSelector::ALL_FIELDS) {}
+
+/// Choose a single feed, the same for both antennae
+/// @param[in] feedID the sequence number of feed to choose
+void SyntheticDataSelector::chooseFeed(casacore::uInt feedID)
+{
+  itsFeed = int(feedID);
+}
+
+/// Choose a single baseline
+/// @param[in] ant1 the sequence number of the first antenna
+/// @param[in] ant2 the sequence number of the second antenna
+/// Which one is the first and which is the second is not important
+void SyntheticDataSelector::chooseBaseline(casacore::uInt ant1, casacore::uInt ant2)
+{
+  itsAnt1 = int(ant1);
+  itsAnt2 = int(ant2);
+}
+
+/// Choose all baselines to given antenna
+/// @param[in] ant the sequence number of antenna
+void SyntheticDataSelector::chooseAntenna(casacore::uInt ant)
+{
+  itsAnt1 = int(ant);
+  itsAnt2 = -1;
+}
+
+/// @brief choose user-defined index
+/// @details Not supported by the synthetic data source
+/// @param[in] column column name in the measurement set for a user-defined index
+/// @param[in] value index value
+void SyntheticDataSelector::chooseUserDefinedIndex(const std::string &column, const casacore::uInt value)
+{
+  ASKAPTHROW(DataAccessLogicError, "Synthetic data source doesn't support selection by user-defined index, column="<<
+             column<<" value="<<value);
+}
+
+/// @brief Choose autocorrelations only
+void SyntheticDataSelector::chooseAutoCorrelations()
+{
+  itsAutoOnly = true;
+  itsCrossOnly = false;
+}
+
+/// @brief Choose crosscorrelations only
+void SyntheticDataSelector::chooseCrossCorrelations()
+{
+  itsCrossOnly = true;
+  itsAutoOnly = false;
+}
+
+/// @brief Choose samples corresponding to a uv-distance larger than threshold
+/// @details Not supported by the synthetic data source
+/// @param[in] uvDist threshold
+void SyntheticDataSelector::chooseMinUVDistance(casacore::Double uvDist)
+{
+  ASKAPTHROW(DataAccessLogicError, "Synthetic data source doesn't support selection by uv-distance, uvDist="<<uvDist);
+}
+
+/// @brief Choose samples corresponding to either zero uv-distance or larger than threshold
+/// @details Not supported by the synthetic data source
+/// @param[in] uvDist threshold
+void SyntheticDataSelector::chooseMinNonZeroUVDistance(casacore::Double uvDist)
+{
+  ASKAPTHROW(DataAccessLogicError, "Synthetic data source doesn't support selection by uv-distance, uvDist="<<uvDist);
+}
+
+/// @brief Choose samples corresponding to a uv-distance smaller than threshold
+/// @details Not supported by the synthetic data source
+/// @param[in] uvDist threshold
+void SyntheticDataSelector::chooseMaxUVDistance(casacore::Double uvDist)
+{
+  ASKAPTHROW(DataAccessLogicError, "Synthetic data source doesn't support selection by uv-distance, uvDist="<<uvDist);
+}
+
+/// Choose a subset of spectral channels
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the number of the first spectral channel to choose
+/// @param[in] nAvg a number of adjacent spectral channels to average,
+///             only 1 (no averaging) is supported
+void SyntheticDataSelector::chooseChannels(casacore::uInt nChan, casacore::uInt start, casacore::uInt nAvg)
+{
+  ASKAPCHECK(nChan > 0, "At least one channel should be selected");
+  if (nAvg != 1) {
+      ASKAPTHROW(DataAccessLogicError, "Synthetic data source doesn't support averaging of channels, nAvg="<<nAvg);
+  }
+  itsNChan = nChan;
+  itsStartChan = start;
+}
+
+/// Choose a subset of frequencies
+/// @details Not supported by the synthetic data source
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the frequency of the first spectral channel to choose
+/// @param[in] freqInc an increment in terms of the frequency
+void SyntheticDataSelector::chooseFrequencies(casacore::uInt nChan, const casacore::MFrequency &start,
+                            const casacore::MVFrequency &freqInc)
+{
+  ASKAPTHROW(DataAccessLogicError, "Synthetic data source doesn't support selection by frequency, nChan="<<nChan<<
+             " start="<<start<<" freqInc="<<freqInc);
+}
+
+/// Choose a subset of radial velocities
+/// @details Not supported by the synthetic data source
+/// @param[in] nChan a number of spectral channels wanted in the output
+/// @param[in] start the velocity of the first spectral channel to choose
+/// @param[in] velInc an increment in terms of the radial velocity
+void SyntheticDataSelector::chooseVelocities(casacore::uInt nChan, const casacore::MVRadialVelocity &start,
+                            const casacore::MVRadialVelocity &velInc)
+{
+  ASKAPTHROW(DataAccessLogicError, "Synthetic data source doesn't support selection by velocity, nChan="<<nChan<<
+             " start="<<start<<" velInc="<<velInc);
+}
+
+/// Choose a single spectral window (also known as IF).
+/// @details The synthetic observation has a single spectral window
+/// @param[in] spWinID the ID of the spectral window to choose (should be 0)
+void SyntheticDataSelector::chooseSpectralWindow(casacore::uInt spWinID)
+{
+  ASKAPCHECK(spWinID == 0, "Synthetic observation has a single spectral window, you requested "<<spWinID);
+}
+
+/// Choose a time range given as absolute UTC epochs
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop  the end of the chosen time interval
+void SyntheticDataSelector::chooseTimeRange(const casacore::MVEpoch &start, const casacore::MVEpoch &stop)
+{
+  itsEpochRangeSelected = true;
+  itsStartEpoch = start.getTime("s").getValue();
+  itsStopEpoch = stop.getTime("s").getValue();
+}
+
+/// Choose time range given in the frame and units of the converter
+/// @param[in] start the beginning of the chosen time interval
+/// @param[in] stop the end of the chosen time interval
+void SyntheticDataSelector::chooseTimeRange(casacore::Double start, casacore::Double stop)
+{
+  itsTimeRangeSelected = true;
+  itsStartTime = start;
+  itsStopTime = stop;
+}
+
+/// Choose polarization.
+/// @details Not supported by the synthetic data source
+/// @param pols a string describing the wanted polarization
+void SyntheticDataSelector::choosePolarizations(const casacore::String &pols)
+{
+  ASKAPTHROW(DataAccessLogicError, "Synthetic data source doesn't support selection of polarisations, pols="<<pols);
+}
+
+/// Choose cycles
+/// @param[in] start the number of the first cycle to choose
+/// @param[in] stop the number of the last cycle to choose (inclusive)
+void SyntheticDataSelector::chooseCycles(casacore::uInt start, casacore::uInt stop)
+{
+  ASKAPCHECK(start <= stop, "The first cycle ("<<start<<") should not be past the last one ("<<stop<<")");
+  itsStartCycle = start;
+  itsStopCycle = stop;
+}
+
+/// Choose a single scan number
+/// @details The synthetic observation has a single scan
+/// @param[in] scanNumber the scan number to choose (should be 0)
+void SyntheticDataSelector::chooseScanNumber(casacore::uInt scanNumber)
+{
+  ASKAPCHECK(scanNumber == 0, "Synthetic observation has a single scan, you requested "<<scanNumber);
+}
+
+/// @brief declare a subset of accessor fields which will be used
+/// @param[in] fields bitwise combination of AccessorFields values
+void SyntheticDataSelector::chooseAccessorFields(casacore::uInt fields)
+{
+  itsAccessorFields = fields;
+}
+
+/// @brief check whether the given row is selected
+/// @param[in] beam beam (feed) number
+/// @param[in] ant1 first antenna
+/// @param[in] ant2 second antenna
+/// @return true, if the row passes the selection
+bool SyntheticDataSelector::rowSelected(casacore::uInt beam, casacore::uInt ant1, casacore::uInt ant2) const
+{
+  if ((itsFeed >= 0) && (int(beam) != itsFeed)) {
+      return false;
+  }
+  if ((itsAutoOnly && (ant1 != ant2)) || (itsCrossOnly && (ant1 == ant2))) {
+      return false;
+  }
+  if (itsAnt1 >= 0) {
+      if (itsAnt2 < 0) {
+          return (int(ant1) == itsAnt1) || (int(ant2) == itsAnt1);
+      }
+      return ((int(ant1) == itsAnt1) && (int(ant2) == itsAnt2)) || ((int(ant1) == itsAnt2) && (int(ant2) == itsAnt1));
+  }
+  return true;
+}
+
+/// @brief check whether the given cycle is selected
+/// @param[in] cycle cycle number
+/// @param[in] time centre of the cycle (MJD in seconds, UTC)
+/// @param[in] convertedTime centre of the cycle in the frame and units of the converter
+/// @return true, if the cycle passes the selection
+bool SyntheticDataSelector::cycleSelected(casacore::uInt cycle, double time, double convertedTime) const
+{
+  if ((cycle < itsStartCycle) || (cycle > itsStopCycle)) {
+      return false;
+  }
+  if (itsEpochRangeSelected && ((time < itsStartEpoch) || (time > itsStopEpoch))) {
+      return false;
+  }
+  if (itsTimeRangeSelected && ((convertedTime < itsStartTime) || (convertedTime > itsStopTime))) {
+      return false;
+  }
+  return true;
+}
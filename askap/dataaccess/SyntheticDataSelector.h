@@ -0,0 +1,238 @@
+/// @file
+///
+/// @brief Selector for the synthetic data source
+/// @details The synthetic data source generates rows from indices, so the selection is
+/// kept as a set of index ranges rather than a table expression. Only criteria which can
+/// be evaluated without generating the data are supported.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_DATA_SELECTOR_H
+#define ASKAP_ACCESSORS_SYNTHETIC_DATA_SELECTOR_H
+
+// own includes
+#include <askap/dataaccess/IDataSelector.h>
+
+// casa includes
+#include <casacore/casa/Quanta/MVEpoch.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Selector for the synthetic data source
+/// @details Feed, antenna, baseline, correlation type, channel, cycle and time range
+/// selections are supported. Other criteria (uv-distance, frequencies, velocities,
+/// polarisations and user-defined indices) throw DataAccessLogicError. The synthetic
+/// observation has a single spectral window and a single scan with index 0, which are
+/// the only values allowed in the respective selection.
+/// @ingroup dataaccess_hlp
+class SyntheticDataSelector : public IDataSelector {
+public:
+  /// @brief construct an empty selection
+  SyntheticDataSelector();
+
+  /// Choose a single feed, the same for both antennae
+  /// @param[in] feedID the sequence number of feed to choose
+  virtual void chooseFeed(casacore::uInt feedID);
+
+  /// Choose a single baseline
+  /// @param[in] ant1 the sequence number of the first antenna
+  /// @param[in] ant2 the sequence number of the second antenna
+  /// Which one is the first and which is the second is not important
+  virtual void chooseBaseline(casacore::uInt ant1, casacore::uInt ant2);
+
+  /// Choose all baselines to given antenna
+  /// @param[in] ant the sequence number of antenna
+  virtual void chooseAntenna(casacore::uInt ant);
+
+  /// @brief choose user-defined index
+  /// @details Not supported by the synthetic data source
+  /// @param[in] column column name in the measurement set for a user-defined index
+  /// @param[in] value index value
+  virtual void chooseUserDefinedIndex(const std::string &column, const casacore::uInt value);
+
+  /// @brief Choose autocorrelations only
+  virtual void chooseAutoCorrelations();
+
+  /// @brief Choose crosscorrelations only
+  virtual void chooseCrossCorrelations();
+
+  /// @brief Choose samples corresponding to a uv-distance larger than threshold
+  /// @details Not supported by the synthetic data source
+  /// @param[in] uvDist threshold
+  virtual void chooseMinUVDistance(casacore::Double uvDist);
+
+  /// @brief Choose samples corresponding to either zero uv-distance or larger than threshold
+  /// @details Not supported by the synthetic data source
+  /// @param[in] uvDist threshold
+  virtual void chooseMinNonZeroUVDistance(casacore::Double uvDist);
+
+  /// @brief Choose samples corresponding to a uv-distance smaller than threshold
+  /// @details Not supported by the synthetic data source
+  /// @param[in] uvDist threshold
+  virtual void chooseMaxUVDistance(casacore::Double uvDist);
+
+  /// Choose a subset of spectral channels
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the number of the first spectral channel to choose
+  /// @param[in] nAvg a number of adjacent spectral channels to average,
+  ///             only 1 (no averaging) is supported
+  virtual void chooseChannels(casacore::uInt nChan, casacore::uInt start, casacore::uInt nAvg = 1);
+
+  /// Choose a subset of frequencies
+  /// @details Not supported by the synthetic data source
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the frequency of the first spectral channel to choose
+  /// @param[in] freqInc an increment in terms of the frequency
+  virtual void chooseFrequencies(casacore::uInt nChan, const casacore::MFrequency &start,
+                                 const casacore::MVFrequency &freqInc);
+
+  /// Choose a subset of radial velocities
+  /// @details Not supported by the synthetic data source
+  /// @param[in] nChan a number of spectral channels wanted in the output
+  /// @param[in] start the velocity of the first spectral channel to choose
+  /// @param[in] velInc an increment in terms of the radial velocity
+  virtual void chooseVelocities(casacore::uInt nChan, const casacore::MVRadialVelocity &start,
+                                const casacore::MVRadialVelocity &velInc);
+
+  /// Choose a single spectral window (also known as IF).
+  /// @details The synthetic observation has a single spectral window
+  /// @param[in] spWinID the ID of the spectral window to choose (should be 0)
+  virtual void chooseSpectralWindow(casacore::uInt spWinID);
+
+  /// Choose a time range given as absolute UTC epochs
+  /// @param[in] start the beginning of the chosen time interval
+  /// @param[in] stop  the end of the chosen time interval
+  virtual void chooseTimeRange(const casacore::MVEpoch &start, const casacore::MVEpoch &stop);
+
+  /// Choose time range given in the frame and units of the converter
+  /// @param[in] start the beginning of the chosen time interval
+  /// @param[in] stop the end of the chosen time interval
+  virtual void chooseTimeRange(casacore::Double start, casacore::Double stop);
+
+  /// Choose polarization.
+  /// @details Not supported by the synthetic data source
+  /// @param pols a string describing the wanted polarization
+  virtual void choosePolarizations(const casacore::String &pols);
+
+  /// Choose cycles
+  /// @param[in] start the number of the first cycle to choose
+  /// @param[in] stop the number of the last cycle to choose (inclusive)
+  virtual void chooseCycles(casacore::uInt start, casacore::uInt stop);
+
+  /// Choose a single scan number
+  /// @details The synthetic observation has a single scan
+  /// @param[in] scanNumber the scan number to choose (should be 0)
+  virtual void chooseScanNumber(casacore::uInt scanNumber);
+
+  /// @brief declare a subset of accessor fields which will be used
+  /// @details The synthetic data source generates fields on demand, so the declaration
+  /// is stored but doesn't change what is available.
+  /// @param[in] fields bitwise combination of AccessorFields values
+  virtual void chooseAccessorFields(casacore::uInt fields);
+
+  /// @brief check whether the given row is selected
+  /// @param[in] beam beam (feed) number
+  /// @param[in] ant1 first antenna
+  /// @param[in] ant2 second antenna
+  /// @return true, if the row passes the selection
+  bool rowSelected(casacore::uInt beam, casacore::uInt ant1, casacore::uInt ant2) const;
+
+  /// @brief check whether the given cycle is selected
+  /// @param[in] cycle cycle number
+  /// @param[in] time centre of the cycle (MJD in seconds, UTC)
+  /// @param[in] convertedTime centre of the cycle in the frame and units of the converter
+  /// @return true, if the cycle passes the selection
+  bool cycleSelected(casacore::uInt cycle, double time, double convertedTime) const;
+
+  /// @return true, if a subset of channels is selected
+  inline bool channelsSelected() const { return itsNChan > 0; }
+
+  /// @return number of selected channels (0 means all)
+  inline casacore::uInt nChannels() const { return itsNChan; }
+
+  /// @return first selected channel
+  inline casacore::uInt startChannel() const { return itsStartChan; }
+
+  /// @return accessor fields declared to be used
+  inline casacore::uInt accessorFields() const { return itsAccessorFields; }
+
+private:
+  /// @brief selected feed, negative value means all feeds
+  int itsFeed;
+
+  /// @brief first antenna of the selected baseline or the selected antenna, negative value means all
+  int itsAnt1;
+
+  /// @brief second antenna of the selected baseline, negative value means any
+  int itsAnt2;
+
+  /// @brief true, if only auto-correlations are selected
+  bool itsAutoOnly;
+
+  /// @brief true, if only cross-correlations are selected
+  bool itsCrossOnly;
+
+  /// @brief number of selected channels, 0 means all
+  casacore::uInt itsNChan;
+
+  /// @brief first selected channel
+  casacore::uInt itsStartChan;
+
+  /// @brief first selected cycle
+  casacore::uInt itsStartCycle;
+
+  /// @brief last selected cycle
+  casacore::uInt itsStopCycle;
+
+  /// @brief true, if the time range is given as absolute epochs
+  bool itsEpochRangeSelected;
+
+  /// @brief beginning of the time range (MJD in seconds, UTC)
+  double itsStartEpoch;
+
+  /// @brief end of the time range (MJD in seconds, UTC)
+  double itsStopEpoch;
+
+  /// @brief true, if the time range is given in the frame of the converter
+  bool itsTimeRangeSelected;
+
+  /// @brief beginning of the time range in the frame of the converter
+  double itsStartTime;
+
+  /// @brief end of the time range in the frame of the converter
+  double itsStopTime;
+
+  /// @brief accessor fields declared to be used
+  casacore::uInt itsAccessorFields;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_DATA_SELECTOR_H
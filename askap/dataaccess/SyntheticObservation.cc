@@ -0,0 +1,349 @@
+/// @file
+///
+/// @brief Description of a synthetic observation
+/// @details This class describes an observation generated on the fly by the synthetic
+/// data source and implements the calculations of uvw and visibilities.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/SyntheticObservation.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/casa/Quanta/MVPosition.h>
+
+// std includes
+#include <random>
+#include <cmath>
+#include <complex>
+#include <stdint.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief seed of the random generator used for the layout and RFI bands
+const unsigned int theSeed = 20120312u;
+
+/// @brief ITRF position of the array centre in metres (near the ASKAP site)
+const double theArrayCentre[3] = {-2556743.707, 5097440.315, -2847749.766};
+
+/// @brief radius of the area occupied by antennas in metres
+const double theArrayRadius = 3000.;
+
+/// @brief number of channels after which the phase recurrence is restarted to limit round-off
+const casacore::uInt thePhaseRestart = 64;
+
+/// @brief mix the bits of a 64-bit value
+/// @details This is the finaliser of the splitmix64 generator. It gives well distributed
+/// values for consecutive inputs, which is what we need to derive flags from indices.
+/// @param[in] x value to mix
+/// @return mixed value
+inline uint64_t mixBits(uint64_t x)
+{
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+} // anonymous namespace
+
+/// @brief set up an observation
+/// @param[in] nAnt number of antennas (at least 2)
+/// @param[in] nBeam number of beams
+/// @param[in] nChan number of spectral channels
+/// @param[in] nCycles number of integration cycles
+SyntheticObservation::SyntheticObservation(casacore::uInt nAnt, casacore::uInt nBeam,
+                      casacore::uInt nChan, casacore::uInt nCycles) : itsNCycles(nCycles),
+        itsStartTime(58000. * 86400.), itsIntegrationTime(10.), itsStartFreq(8e8), itsChanWidth(288e6 / nChan),
+        itsPhaseCentre(casacore::Quantity(0., "deg"), casacore::Quantity(-45., "deg")),
+        itsBeamSpacing(0.9 * casacore::C::pi / 180.), itsFlux(1.), itsSourceL(1e-3), itsSourceM(-1e-3),
+        itsNoise(1.), itsRFIFraction(0.05), itsRowFraction(0.01)
+{
+  ASKAPCHECK(nAnt > 1, "At least 2 antennas are required, you have "<<nAnt);
+  ASKAPCHECK(nBeam > 0, "At least one beam is required");
+  ASKAPCHECK(nChan > 0, "At least one spectral channel is required");
+  ASKAPCHECK(nCycles > 0, "At least one cycle is required");
+  makeAntennas(nAnt);
+  makeBeams(nBeam);
+  makeFrequencies(nChan);
+  makeChannelFlags();
+}
+
+/// @brief set the time grid
+/// @param[in] startTime start of the observation (MJD in seconds, UTC)
+/// @param[in] integrationTime duration of each cycle in seconds
+void SyntheticObservation::setTimes(double startTime, double integrationTime)
+{
+  ASKAPCHECK(integrationTime > 0., "Integration time should be positive, you have "<<integrationTime);
+  itsStartTime = startTime;
+  itsIntegrationTime = integrationTime;
+}
+
+/// @brief set the spectral axis
+/// @details The number of channels is given at construction
+/// @param[in] startFreq frequency of the first channel in Hz (topocentric)
+/// @param[in] chanWidth channel width in Hz
+void SyntheticObservation::setSpectralAxis(double startFreq, double chanWidth)
+{
+  ASKAPCHECK(startFreq > 0., "Frequency should be positive, you have "<<startFreq);
+  itsStartFreq = startFreq;
+  itsChanWidth = chanWidth;
+  makeFrequencies(nChannels());
+}
+
+/// @brief set the pointing
+/// @param[in] centre centre of the beam footprint (J2000)
+/// @param[in] beamSpacing distance between adjacent beams in radians
+void SyntheticObservation::setPointing(const casacore::MVDirection &centre, double beamSpacing)
+{
+  itsPhaseCentre = centre;
+  itsBeamSpacing = beamSpacing;
+  makeBeams(nBeams());
+}
+
+/// @brief set the sky model
+/// @param[in] flux flux density of the source in Jy
+/// @param[in] l offset of the source from the beam centre in radians (direction cosine)
+/// @param[in] m offset of the source from the beam centre in radians (direction cosine)
+void SyntheticObservation::setSource(float flux, double l, double m)
+{
+  ASKAPCHECK(l * l + m * m < 1., "Source offset ("<<l<<","<<m<<") is beyond the horizon");
+  itsFlux = flux;
+  itsSourceL = l;
+  itsSourceM = m;
+}
+
+/// @brief set the noise level
+/// @param[in] sigma noise of each visibility (real and imaginary parts) in Jy
+void SyntheticObservation::setNoise(float sigma)
+{
+  ASKAPCHECK(sigma > 0., "Noise should be positive, you have "<<sigma);
+  itsNoise = sigma;
+}
+
+/// @brief set the flagging pattern
+/// @param[in] rfiFraction fraction of channels occupied by persistent RFI
+/// @param[in] rowFraction fraction of rows flagged entirely
+void SyntheticObservation::setFlagging(double rfiFraction, double rowFraction)
+{
+  ASKAPCHECK((rfiFraction >= 0.) && (rfiFraction <= 1.), "Fraction of RFI channels should be between 0 and 1, you have "<<
+             rfiFraction);
+  ASKAPCHECK((rowFraction >= 0.) && (rowFraction <= 1.), "Fraction of flagged rows should be between 0 and 1, you have "<<
+             rowFraction);
+  itsRFIFraction = rfiFraction;
+  itsRowFraction = rowFraction;
+  makeChannelFlags();
+}
+
+/// @return number of rows per cycle including auto-correlations
+casacore::uInt SyntheticObservation::nRowsPerCycle() const
+{
+  return nBeams() * nAntennas() * (nAntennas() + 1) / 2;
+}
+
+/// @brief centre of the given cycle
+/// @param[in] cycle cycle number
+/// @return MJD in seconds (UTC)
+double SyntheticObservation::time(casacore::uInt cycle) const
+{
+  return itsStartTime + (cycle + 0.5) * itsIntegrationTime;
+}
+
+/// @brief position of the given antenna
+/// @param[in] ant antenna number
+/// @return ITRF position
+casacore::MPosition SyntheticObservation::antennaPosition(casacore::uInt ant) const
+{
+  ASKAPDEBUGASSERT(ant < nAntennas());
+  return casacore::MPosition(casacore::MVPosition(itsAntennaXYZ(ant, 0), itsAntennaXYZ(ant, 1),
+                             itsAntennaXYZ(ant, 2)), casacore::MPosition::ITRF);
+}
+
+/// @brief check whether the whole row is flagged
+/// @param[in] cycle cycle number
+/// @param[in] beam beam number
+/// @param[in] ant1 first antenna
+/// @param[in] ant2 second antenna
+/// @return true, if the row is flagged
+bool SyntheticObservation::rowFlagged(casacore::uInt cycle, casacore::uInt beam, casacore::uInt ant1,
+                                      casacore::uInt ant2) const
+{
+  if (itsRowFraction <= 0.) {
+      return false;
+  }
+  const uint64_t index = ((uint64_t(cycle) * nBeams() + beam) * nAntennas() + ant1) * nAntennas() + ant2;
+  // top 53 bits give a uniformly distributed number in [0,1)
+  const double value = double(mixBits(index) >> 11) / double(uint64_t(1) << 53);
+  return value < itsRowFraction;
+}
+
+/// @brief compute uvw of the given baseline
+/// @details The hour angle is taken with respect to Greenwich, as the antenna positions
+/// are in ITRF (see Thompson, Moran & Swenson, eq. 4.1). UT1 is approximated by UTC.
+/// @param[in] cycle cycle number
+/// @param[in] beam beam number (defines the phase centre)
+/// @param[in] ant1 first antenna
+/// @param[in] ant2 second antenna
+/// @return uvw in metres
+casacore::RigidVector<casacore::Double, 3> SyntheticObservation::uvw(casacore::uInt cycle, casacore::uInt beam,
+                                           casacore::uInt ant1, casacore::uInt ant2) const
+{
+  ASKAPDEBUGASSERT((ant1 < nAntennas()) && (ant2 < nAntennas()));
+  // earth rotation angle
+  const double days = time(cycle) / 86400. - 51544.5;
+  const double era = 2. * casacore::C::pi * (0.7790572732640 + 1.00273781191135448 * days);
+  const casacore::MVDirection &dir = beamDirection(beam);
+  const double ha = era - dir.getLong();
+  const double dec = dir.getLat();
+  const double sinHA = std::sin(ha);
+  const double cosHA = std::cos(ha);
+  const double sinDec = std::sin(dec);
+  const double cosDec = std::cos(dec);
+  const double bx = itsAntennaXYZ(ant2, 0) - itsAntennaXYZ(ant1, 0);
+  const double by = itsAntennaXYZ(ant2, 1) - itsAntennaXYZ(ant1, 1);
+  const double bz = itsAntennaXYZ(ant2, 2) - itsAntennaXYZ(ant1, 2);
+  casacore::RigidVector<casacore::Double, 3> result;
+  result(0) = sinHA * bx + cosHA * by;
+  result(1) = -sinDec * cosHA * bx + sinDec * sinHA * by + cosDec * bz;
+  result(2) = cosDec * cosHA * bx - cosDec * sinHA * by + sinDec * bz;
+  return result;
+}
+
+/// @brief compute visibilities of a single row
+/// @details The spectrum is computed with a phase recurrence, so the cost per
+/// sample is a complex multiplication. The recurrence is restarted every few channels
+/// to keep the round-off error small.
+/// @param[in] uvw baseline coordinates in metres
+/// @param[in] startChan first channel to compute
+/// @param[in] row row of the cube to fill
+/// @param[in] vis nRow x nChan x nPol cube, nChan channels starting at startChan are computed
+void SyntheticObservation::fillVisibility(const casacore::RigidVector<casacore::Double, 3> &uvw,
+                casacore::uInt startChan, casacore::uInt row, casacore::Cube<casacore::Complex> &vis) const
+{
+  ASKAPDEBUGASSERT(row < vis.nrow());
+  ASKAPDEBUGASSERT(startChan + vis.ncolumn() <= nChannels());
+  ASKAPDEBUGASSERT(vis.nplane() == nPol());
+  const double n = std::sqrt(1. - itsSourceL * itsSourceL - itsSourceM * itsSourceM);
+  // geometric delay of the source in seconds
+  const double delay = (uvw(0) * itsSourceL + uvw(1) * itsSourceM + uvw(2) * (n - 1.)) / casacore::C::c;
+  const std::complex<double> step = std::polar(1., -2. * casacore::C::pi * delay * itsChanWidth);
+  std::complex<double> phasor;
+  for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+       if (chan % thePhaseRestart == 0) {
+           phasor = std::polar(double(itsFlux), -2. * casacore::C::pi * delay * itsFrequencies[startChan + chan]);
+       } else {
+           phasor *= step;
+       }
+       const casacore::Complex value(phasor.real(), phasor.imag());
+       vis(row, chan, 0) = value;
+       vis(row, chan, 1) = casacore::Complex(0., 0.);
+       vis(row, chan, 2) = casacore::Complex(0., 0.);
+       vis(row, chan, 3) = value;
+  }
+}
+
+/// @brief generate antenna layout
+/// @details The first antenna is at the array centre, others are distributed uniformly
+/// over a disk in the local horizontal plane.
+/// @param[in] nAnt number of antennas
+void SyntheticObservation::makeAntennas(casacore::uInt nAnt)
+{
+  std::mt19937 gen(theSeed);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  // geocentric latitude and longitude are accurate enough to define the local plane
+  const double lon = std::atan2(theArrayCentre[1], theArrayCentre[0]);
+  const double lat = std::atan2(theArrayCentre[2], std::sqrt(theArrayCentre[0] * theArrayCentre[0] +
+                                theArrayCentre[1] * theArrayCentre[1]));
+  itsAntennaXYZ.resize(nAnt, 3);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       double east = 0.;
+       double north = 0.;
+       if (ant > 0) {
+           const double radius = theArrayRadius * std::sqrt(uniform(gen));
+           const double angle = 2. * casacore::C::pi * uniform(gen);
+           east = radius * std::cos(angle);
+           north = radius * std::sin(angle);
+       }
+       itsAntennaXYZ(ant, 0) = theArrayCentre[0] - std::sin(lon) * east - std::sin(lat) * std::cos(lon) * north;
+       itsAntennaXYZ(ant, 1) = theArrayCentre[1] + std::cos(lon) * east - std::sin(lat) * std::sin(lon) * north;
+       itsAntennaXYZ(ant, 2) = theArrayCentre[2] + std::cos(lat) * north;
+  }
+}
+
+/// @brief generate beam footprint
+/// @details Beams fill a square grid row by row, the grid is centred on the phase centre
+/// @param[in] nBeam number of beams
+void SyntheticObservation::makeBeams(casacore::uInt nBeam)
+{
+  const casacore::uInt side = casacore::uInt(std::ceil(std::sqrt(double(nBeam))));
+  itsBeamDirections.resize(nBeam);
+  for (casacore::uInt beam = 0; beam < nBeam; ++beam) {
+       const double dx = (double(beam % side) - 0.5 * (side - 1)) * itsBeamSpacing;
+       const double dy = (double(beam / side) - 0.5 * (side - 1)) * itsBeamSpacing;
+       casacore::MVDirection dir(itsPhaseCentre);
+       dir.shift(dx, dy, casacore::True);
+       itsBeamDirections[beam] = dir;
+  }
+}
+
+/// @brief generate channel frequencies
+/// @param[in] nChan number of channels
+void SyntheticObservation::makeFrequencies(casacore::uInt nChan)
+{
+  itsFrequencies.resize(nChan);
+  for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+       itsFrequencies[chan] = itsStartFreq + chan * itsChanWidth;
+  }
+}
+
+/// @brief generate flags of channels occupied by RFI
+/// @details Bands of random width (up to 2% of the channels) are added at random
+/// positions until the required fraction of channels is flagged.
+void SyntheticObservation::makeChannelFlags()
+{
+  const casacore::uInt nChan = nChannels();
+  itsChannelFlags.resize(nChan);
+  itsChannelFlags.set(casacore::False);
+  const casacore::uInt target = casacore::uInt(itsRFIFraction * nChan + 0.5);
+  std::mt19937 gen(theSeed + 1);
+  std::uniform_int_distribution<casacore::uInt> startDist(0, nChan - 1);
+  std::uniform_int_distribution<casacore::uInt> widthDist(1, std::max(casacore::uInt(1), nChan / 50));
+  for (casacore::uInt flagged = 0; flagged < target; ) {
+       const casacore::uInt start = startDist(gen);
+       const casacore::uInt width = widthDist(gen);
+       for (casacore::uInt chan = start; (chan < start + width) && (chan < nChan) && (flagged < target); ++chan) {
+            if (!itsChannelFlags[chan]) {
+                itsChannelFlags[chan] = casacore::True;
+                ++flagged;
+            }
+       }
+  }
+}
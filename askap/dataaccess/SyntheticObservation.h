@@ -0,0 +1,257 @@
+/// @file
+///
+/// @brief Description of a synthetic observation
+/// @details This class describes an observation generated on the fly by the synthetic
+/// data source: the antenna layout, the beam footprint, the spectral axis, the time grid,
+/// the sky model and the flagging pattern. It also implements the calculations which
+/// are required to produce the data (uvw and visibilities) for a given sample, so the
+/// data source doesn't need to store anything but this description.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_OBSERVATION_H
+#define ASKAP_ACCESSORS_SYNTHETIC_OBSERVATION_H
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Quanta/MVDirection.h>
+#include <casacore/measures/Measures/MPosition.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Description of a synthetic observation
+/// @details The default parameters correspond to a full ASKAP observation: 36 antennas
+/// spread over 6 km, 36 beams arranged in a square footprint with 0.9 deg pitch,
+/// 288 MHz of bandwidth starting at 800 MHz and 10 s integrations. The sky is a single
+/// unpolarised point source at the given offset from every beam centre, so each beam
+/// has the same model in its own phase centre. Visibilities are noise-free, the noise
+/// level only defines the values returned as the noise estimate.
+///
+/// Antenna positions are random (with a fixed seed) within the given radius around
+/// the array centre near the ASKAP site. The uvw coordinates are computed for the
+/// phase centre of each beam from the Greenwich hour angle, so they follow realistic
+/// tracks over the observation.
+///
+/// Flags follow two patterns: persistent RFI occupying a fraction of channels in a
+/// number of contiguous bands, and intermittent flagging of whole rows (e.g. due to
+/// a dropped packet). Both are deterministic, so repeated iterations see the same data.
+/// @ingroup dataaccess_hlp
+class SyntheticObservation {
+public:
+  /// @brief set up an observation
+  /// @param[in] nAnt number of antennas (at least 2)
+  /// @param[in] nBeam number of beams
+  /// @param[in] nChan number of spectral channels
+  /// @param[in] nCycles number of integration cycles
+  explicit SyntheticObservation(casacore::uInt nAnt = 36, casacore::uInt nBeam = 36,
+                                casacore::uInt nChan = 288, casacore::uInt nCycles = 10);
+
+  /// @brief set the time grid
+  /// @param[in] startTime start of the observation (MJD in seconds, UTC)
+  /// @param[in] integrationTime duration of each cycle in seconds
+  void setTimes(double startTime, double integrationTime);
+
+  /// @brief set the spectral axis
+  /// @details The number of channels is given at construction
+  /// @param[in] startFreq frequency of the first channel in Hz (topocentric)
+  /// @param[in] chanWidth channel width in Hz
+  void setSpectralAxis(double startFreq, double chanWidth);
+
+  /// @brief set the pointing
+  /// @param[in] centre centre of the beam footprint (J2000)
+  /// @param[in] beamSpacing distance between adjacent beams in radians
+  void setPointing(const casacore::MVDirection &centre, double beamSpacing);
+
+  /// @brief set the sky model
+  /// @param[in] flux flux density of the source in Jy
+  /// @param[in] l offset of the source from the beam centre in radians (direction cosine)
+  /// @param[in] m offset of the source from the beam centre in radians (direction cosine)
+  void setSource(float flux, double l, double m);
+
+  /// @brief set the noise level
+  /// @param[in] sigma noise of each visibility (real and imaginary parts) in Jy
+  void setNoise(float sigma);
+
+  /// @brief set the flagging pattern
+  /// @param[in] rfiFraction fraction of channels occupied by persistent RFI
+  /// @param[in] rowFraction fraction of rows flagged entirely
+  void setFlagging(double rfiFraction, double rowFraction);
+
+  /// @return number of antennas
+  inline casacore::uInt nAntennas() const { return itsAntennaXYZ.nrow(); }
+
+  /// @return number of beams
+  inline casacore::uInt nBeams() const { return itsBeamDirections.nelements(); }
+
+  /// @return number of spectral channels
+  inline casacore::uInt nChannels() const { return itsFrequencies.nelements(); }
+
+  /// @return number of cycles
+  inline casacore::uInt nCycles() const { return itsNCycles; }
+
+  /// @return number of polarisation products (always XX, XY, YX and YY)
+  inline casacore::uInt nPol() const { return 4; }
+
+  /// @return number of rows per cycle including auto-correlations
+  casacore::uInt nRowsPerCycle() const;
+
+  /// @brief centre of the given cycle
+  /// @param[in] cycle cycle number
+  /// @return MJD in seconds (UTC)
+  double time(casacore::uInt cycle) const;
+
+  /// @return integration time in seconds
+  inline double integrationTime() const { return itsIntegrationTime; }
+
+  /// @return topocentric frequencies of all channels in Hz
+  inline const casacore::Vector<casacore::Double>& frequencies() const { return itsFrequencies; }
+
+  /// @return centre of the beam footprint (J2000)
+  inline const casacore::MVDirection& phaseCentre() const { return itsPhaseCentre; }
+
+  /// @brief direction of the given beam
+  /// @param[in] beam beam number
+  /// @return phase centre of the beam (J2000)
+  inline const casacore::MVDirection& beamDirection(casacore::uInt beam) const
+      { return itsBeamDirections[beam]; }
+
+  /// @brief position of the given antenna
+  /// @param[in] ant antenna number
+  /// @return ITRF position
+  casacore::MPosition antennaPosition(casacore::uInt ant) const;
+
+  /// @return noise of each visibility in Jy
+  inline float noise() const { return itsNoise; }
+
+  /// @return flags of channels occupied by RFI (true means flagged)
+  inline const casacore::Vector<casacore::Bool>& channelFlags() const { return itsChannelFlags; }
+
+  /// @brief check whether the whole row is flagged
+  /// @param[in] cycle cycle number
+  /// @param[in] beam beam number
+  /// @param[in] ant1 first antenna
+  /// @param[in] ant2 second antenna
+  /// @return true, if the row is flagged
+  bool rowFlagged(casacore::uInt cycle, casacore::uInt beam, casacore::uInt ant1, casacore::uInt ant2) const;
+
+  /// @brief compute uvw of the given baseline
+  /// @param[in] cycle cycle number
+  /// @param[in] beam beam number (defines the phase centre)
+  /// @param[in] ant1 first antenna
+  /// @param[in] ant2 second antenna
+  /// @return uvw in metres
+  casacore::RigidVector<casacore::Double, 3> uvw(casacore::uInt cycle, casacore::uInt beam,
+                                                  casacore::uInt ant1, casacore::uInt ant2) const;
+
+  /// @brief compute visibilities of a single row
+  /// @details The spectrum is computed with a phase recurrence, so the cost per
+  /// sample is a complex multiplication.
+  /// @param[in] uvw baseline coordinates in metres
+  /// @param[in] startChan first channel to compute
+  /// @param[in] row row of the cube to fill
+  /// @param[in] vis nRow x nChan x nPol cube, nChan channels starting at startChan are computed
+  void fillVisibility(const casacore::RigidVector<casacore::Double, 3> &uvw, casacore::uInt startChan,
+                      casacore::uInt row, casacore::Cube<casacore::Complex> &vis) const;
+
+private:
+  /// @brief generate antenna layout
+  /// @param[in] nAnt number of antennas
+  void makeAntennas(casacore::uInt nAnt);
+
+  /// @brief generate beam footprint
+  /// @param[in] nBeam number of beams
+  void makeBeams(casacore::uInt nBeam);
+
+  /// @brief generate channel frequencies
+  /// @param[in] nChan number of channels
+  void makeFrequencies(casacore::uInt nChan);
+
+  /// @brief generate flags of channels occupied by RFI
+  void makeChannelFlags();
+
+  /// @brief ITRF antenna positions (nAnt x 3, metres)
+  casacore::Matrix<casacore::Double> itsAntennaXYZ;
+
+  /// @brief number of cycles
+  casacore::uInt itsNCycles;
+
+  /// @brief start of the observation (MJD in seconds, UTC)
+  double itsStartTime;
+
+  /// @brief duration of a cycle in seconds
+  double itsIntegrationTime;
+
+  /// @brief frequency of the first channel in Hz
+  double itsStartFreq;
+
+  /// @brief channel width in Hz
+  double itsChanWidth;
+
+  /// @brief frequencies of all channels in Hz
+  casacore::Vector<casacore::Double> itsFrequencies;
+
+  /// @brief centre of the beam footprint
+  casacore::MVDirection itsPhaseCentre;
+
+  /// @brief distance between adjacent beams in radians
+  double itsBeamSpacing;
+
+  /// @brief phase centres of all beams
+  casacore::Vector<casacore::MVDirection> itsBeamDirections;
+
+  /// @brief flux density of the source in Jy
+  float itsFlux;
+
+  /// @brief offset of the source from the beam centre (direction cosine)
+  double itsSourceL;
+
+  /// @brief offset of the source from the beam centre (direction cosine)
+  double itsSourceM;
+
+  /// @brief noise of each visibility in Jy
+  float itsNoise;
+
+  /// @brief fraction of channels occupied by RFI
+  double itsRFIFraction;
+
+  /// @brief fraction of rows flagged entirely
+  double itsRowFraction;
+
+  /// @brief flags of channels occupied by RFI
+  casacore::Vector<casacore::Bool> itsChannelFlags;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_OBSERVATION_H
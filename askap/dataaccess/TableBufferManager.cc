@@ -37,8 +37,12 @@ using namespace askap::accessors;
 
 /// construct the object and link it to the given buffers subtable
 /// @param[in] tab  subtable to use
-TableBufferManager::TableBufferManager(const casacore::Table &tab) :
-                   TableHolder(tab) {}
+/// @param[in] maxTileSize maximum tile size in bytes. If non-zero, new buffer columns
+/// are created with the tiled storage manager (TiledShapeStMan), with tiles covering
+/// all channels and polarisations of a block of rows of the first cube written. 
+/// Zero (default) means that the default storage manager of the table is used.
+TableBufferManager::TableBufferManager(const casacore::Table &tab, size_t maxTileSize) :
+                   TableHolder(tab), itsMaxTileSize(maxTileSize) {}
 
 
 /// @brief populate the cube with the data stored in the given buffer
@@ -78,3 +82,30 @@ bool TableBufferManager::bufferExists(const std::string &name,
 {
   return cellDefined<casacore::Complex>(name,static_cast<casacore::rownr_t>(index));
 }
+
+/// @brief read a range of rows of the given buffer
+/// @details The cube should be sized to the number of rows required, other
+/// dimensions should match the buffer. Only the part of the buffer (and tiles, 
+/// if tiled storage manager is used) covering the requested rows is accessed.
+/// @param[in] vis a reference to the nRow x nChannel x nPol cube to fill
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+/// @param[in] startRow first row of the buffer cube to read
+void TableBufferManager::readBufferRows(casacore::Cube<casacore::Complex> &vis, 
+           const std::string &name, casacore::uInt index, casacore::uInt startRow) const
+{
+  readCubeRows(vis, name, static_cast<casacore::rownr_t>(index), startRow);
+}
+
+/// @brief write a range of rows of the given buffer
+/// @details The buffer should already exist for the given index (i.e. the whole cube
+/// has to be written first), other dimensions of the cube should match the buffer.
+/// @param[in] vis a reference to the nRow x nChannel x nPol cube with the data
+/// @param[in] name a name of the buffer to work with
+/// @param[in] index a sequential index in the buffer
+/// @param[in] startRow first row of the buffer cube to write
+void TableBufferManager::writeBufferRows(const casacore::Cube<casacore::Complex> &vis, 
+           const std::string &name, casacore::uInt index, casacore::uInt startRow) const
+{
+  writeCubeRows(vis, name, static_cast<casacore::rownr_t>(index), startRow);
+}
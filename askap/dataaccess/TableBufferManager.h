@@ -52,7 +52,11 @@ struct TableBufferManager : virtual public IBufferManager,
 {
   /// construct the object and link it to the given buffers subtable
   /// @param[in] tab  subtable to use
-  TableBufferManager(const casacore::Table &tab);
+  /// @param[in] maxTileSize maximum tile size in bytes. If non-zero, new buffer columns
+  /// are created with the tiled storage manager (TiledShapeStMan), with tiles covering
+  /// all channels and polarisations of a block of rows of the first cube written. 
+  /// Zero (default) means that the default storage manager of the table is used.
+  explicit TableBufferManager(const casacore::Table &tab, size_t maxTileSize = 0);
   
   /// @brief populate the cube with the data stored in the given buffer
   /// @details The method throws an exception if the requested buffer
@@ -81,6 +85,31 @@ struct TableBufferManager : virtual public IBufferManager,
   /// @param[in] index a sequential index in the buffer
   virtual bool bufferExists(const std::string &name,
 			   casacore::uInt index) const;
+
+  /// @brief read a range of rows of the given buffer
+  /// @details The cube should be sized to the number of rows required, other
+  /// dimensions should match the buffer. Only the part of the buffer (and tiles, 
+  /// if tiled storage manager is used) covering the requested rows is accessed.
+  /// @param[in] vis a reference to the nRow x nChannel x nPol cube to fill
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  /// @param[in] startRow first row of the buffer cube to read
+  void readBufferRows(casacore::Cube<casacore::Complex> &vis, const std::string &name,
+                      casacore::uInt index, casacore::uInt startRow) const;
+
+  /// @brief write a range of rows of the given buffer
+  /// @details The buffer should already exist for the given index (i.e. the whole cube
+  /// has to be written first), other dimensions of the cube should match the buffer.
+  /// @param[in] vis a reference to the nRow x nChannel x nPol cube with the data
+  /// @param[in] name a name of the buffer to work with
+  /// @param[in] index a sequential index in the buffer
+  /// @param[in] startRow first row of the buffer cube to write
+  void writeBufferRows(const casacore::Cube<casacore::Complex> &vis, const std::string &name,
+                       casacore::uInt index, casacore::uInt startRow) const;
+
+  /// @brief maximum tile size
+  /// @return maximum tile size in bytes used for new buffer columns, zero means no tiling
+  inline size_t maxTileSize() const { return itsMaxTileSize;}
 protected:
   // templated methods to handle cubes of different types + handling specialised row index type in casa tables
 
@@ -112,6 +141,36 @@ protected:
   template<typename T>
   bool cellDefined(const std::string &name,
 			      casacore::rownr_t index) const;  			   
+
+  /// @brief read a block of rows of the cube stored in the given table cell
+  /// @param[in] cube a reference to a cube of some type, sized to the required block
+  /// @param[in] name a name of the column to work with
+  /// @param[in] index row number
+  /// @param[in] startRow first row (the first axis) of the cube stored in the cell
+  template<typename T>
+  void readCubeRows(casacore::Cube<T> &cube, const std::string &name,
+                    casacore::rownr_t index, casacore::uInt startRow) const;
+
+  /// @brief write a block of rows of the cube stored in the given table cell
+  /// @param[in] cube to take the data from 
+  /// @param[in] name a name of the column to work with
+  /// @param[in] index row number
+  /// @param[in] startRow first row (the first axis) of the cube stored in the cell
+  template<typename T>
+  void writeCubeRows(const casacore::Cube<T> &cube, const std::string &name,
+                     casacore::rownr_t index, casacore::uInt startRow) const;
+
+  /// @brief add a new buffer column
+  /// @details The column is set up with the tiled storage manager if the maximum tile
+  /// size is non-zero, the tile shape is derived from the shape given.
+  /// @param[in] name a name of the column
+  /// @param[in] shape shape of the first cube to be stored
+  template<typename T>
+  void addBufferColumn(const std::string &name, const casacore::IPosition &shape) const;
+
+private:
+  /// @brief maximum tile size in bytes, zero means no tiling
+  size_t itsMaxTileSize;
 };
 
 } // namespace accessors
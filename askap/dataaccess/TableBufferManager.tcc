@@ -33,6 +33,10 @@
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/ArrColDesc.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/ArrayUtil.h>
 
 // own includes
 #include <askap/dataaccess/DataAccessError.h>
@@ -73,10 +77,7 @@ void TableBufferManager::writeCube(const casa::Cube<T> &cube, const std::string
 {  
   if (!table().actualTableDesc().isColumn(name)) {
       // create a brand new buffer
-      typename casa::ArrayColumnDesc<T> newColDesc(name,
-           "Writable buffer managed by the dataaccess layer",3);
-      newColDesc.rwKeywordSet().define("UNIT","Jy");
-      table().addColumn(newColDesc);
+      addBufferColumn<T>(name, cube.shape());
   }
   if (table().nrow()<=index) {
       table().addRow(index-table().nrow()+1);
@@ -85,6 +86,79 @@ void TableBufferManager::writeCube(const casa::Cube<T> &cube, const std::string
   bufCol.put(index,cube);
 }
 
+/// @brief add a new buffer column
+/// @details The column is set up with the tiled storage manager if the maximum tile
+/// size is non-zero, the tile shape is derived from the shape given.
+/// @param[in] name a name of the column
+/// @param[in] shape shape of the first cube to be stored
+template<typename T>
+void TableBufferManager::addBufferColumn(const std::string &name, 
+                                         const casacore::IPosition &shape) const
+{
+  typename casa::ArrayColumnDesc<T> newColDesc(name,
+       "Writable buffer managed by the dataaccess layer",3);
+  newColDesc.rwKeywordSet().define("UNIT","Jy");
+  if (itsMaxTileSize == 0 || shape.nelements() != 3 || shape.product() == 0) {
+      table().addColumn(newColDesc);
+      return;
+  }
+  // tiles span all channels and polarisations (cube is nRow x nChannel x nPol),
+  // as many rows as the size limit allows and a single cell
+  const size_t rowSize = static_cast<size_t>(shape[1] * shape[2]) * sizeof(T);
+  casacore::Int tileRows = rowSize < itsMaxTileSize ? static_cast<casacore::Int>(itsMaxTileSize / rowSize) : 1;
+  if (tileRows > shape[0]) {
+      tileRows = shape[0];
+  }
+  const casacore::IPosition tileShape(4, tileRows, shape[1], shape[2], 1);
+  const std::string hyperColumn = name + "_HYPERCOLUMN";
+  casacore::TableDesc td;
+  td.addColumn(newColDesc);
+  td.defineHypercolumn(hyperColumn, 4, casacore::stringToVector(name));
+  casacore::TiledShapeStMan stMan(hyperColumn, tileShape);
+  table().addColumn(td, stMan);
+}
+
+/// @brief read a block of rows of the cube stored in the given table cell
+/// @param[in] cube a reference to a cube of some type, sized to the required block
+/// @param[in] name a name of the column to work with
+/// @param[in] index row number
+/// @param[in] startRow first row (the first axis) of the cube stored in the cell
+template<typename T>
+void TableBufferManager::readCubeRows(casacore::Cube<T> &cube, const std::string &name,
+                         casacore::rownr_t index, casacore::uInt startRow) const
+{
+  ASKAPCHECK(cellDefined<T>(name, index), "Buffer "<<name<<" is not defined for index="<<index);
+  typename casa::ROArrayColumn<T> bufCol(table(),name);
+  const casacore::IPosition shape = bufCol.shape(index);
+  ASKAPASSERT(shape.nelements() == 3u); // only cubes should be in buffers
+  ASKAPCHECK(startRow + cube.nrow() <= casacore::uInt(shape[0]) && cube.ncolumn() == casacore::uInt(shape[1]) &&
+             cube.nplane() == casacore::uInt(shape[2]), "Requested block of rows from "<<startRow<<" of shape "<<
+             cube.shape()<<" does not fit into the buffer "<<name<<" of shape "<<shape);
+  const casacore::Slicer slicer(casacore::IPosition(3, startRow, 0, 0), cube.shape());
+  bufCol.getSlice(index, slicer, cube);
+}
+
+/// @brief write a block of rows of the cube stored in the given table cell
+/// @param[in] cube to take the data from 
+/// @param[in] name a name of the column to work with
+/// @param[in] index row number
+/// @param[in] startRow first row (the first axis) of the cube stored in the cell
+template<typename T>
+void TableBufferManager::writeCubeRows(const casacore::Cube<T> &cube, const std::string &name,
+                         casacore::rownr_t index, casacore::uInt startRow) const
+{
+  ASKAPCHECK(cellDefined<T>(name, index), "Buffer "<<name<<" is not defined for index="<<index<<
+             ", the whole cube has to be written first");
+  typename casa::ArrayColumn<T> bufCol(table(),name);
+  const casacore::IPosition shape = bufCol.shape(index);
+  ASKAPASSERT(shape.nelements() == 3u); // only cubes should be in buffers
+  ASKAPCHECK(startRow + cube.nrow() <= casacore::uInt(shape[0]) && cube.ncolumn() == casacore::uInt(shape[1]) &&
+             cube.nplane() == casacore::uInt(shape[2]), "Block of rows from "<<startRow<<" of shape "<<
+             cube.shape()<<" does not fit into the buffer "<<name<<" of shape "<<shape);
+  const casacore::Slicer slicer(casacore::IPosition(3, startRow, 0, 0), cube.shape());
+  bufCol.putSlice(index, slicer, cube);
+}
+
 /// @brief check whether a particular table cell exists
 /// @param[in] name a name of the table column to query
 /// @param[in] index row number 
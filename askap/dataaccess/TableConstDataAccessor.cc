@@ -93,7 +93,7 @@ const casacore::Cube<casacore::Bool>& TableConstDataAccessor::flag() const
 const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
 TableConstDataAccessor::uvw() const
 {
-  return itsUVW.value(itsIterator,&TableConstDataIterator::fillUVW);
+  return itsUVW.value(*this, &TableConstDataAccessor::fillUVW);
 }
 
 /// @brief uvw after rotation
@@ -105,7 +105,7 @@ TableConstDataAccessor::uvw() const
 const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
 	           TableConstDataAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
 {
-  return itsRotatedUVW.uvw(*this, tangentPoint);
+  return itsRotatedUVW.uvw(*this, tangentPoint, itsIterator.rotatedUVWKey());
 }	           
 	         
 /// @brief delay associated with uvw rotation
@@ -119,7 +119,27 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
 const casacore::Vector<casacore::Double>& TableConstDataAccessor::uvwRotationDelay(
 	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
 {
-  return itsRotatedUVW.delays(*this,tangentPoint,imageCentre);
+  return itsRotatedUVW.delays(*this,tangentPoint,imageCentre,itsIterator.rotatedUVWKey());
+}
+
+/// @brief bounding box of uvw
+/// @details The bounds are computed in the same pass which reads uvw from the table,
+/// so this method doesn't scan the uvw again.
+/// @return bounding box of uvw
+UVWBounds TableConstDataAccessor::uvwBounds() const
+{
+  // ensures itsUVWBounds is up to date
+  uvw();
+  return itsUVWBounds;
+}
+
+/// @brief bounding box of uvw after rotation
+/// @details The bounds are computed in the same pass which rotates uvw.
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return bounding box of rotated uvw
+UVWBounds TableConstDataAccessor::rotatedUVWBounds(const casacore::MDirection &tangentPoint) const
+{
+  return itsRotatedUVW.bounds(*this, tangentPoint, itsIterator.rotatedUVWKey());
 }
 
 /// Frequency for each channel
@@ -270,6 +290,136 @@ const casacore::Vector<casacore::Stokes::StokesTypes>& TableConstDataAccessor::s
   return itsStokes.value(itsIterator, &TableConstDataIterator::fillStokes);
 }                                    
 
+/// @brief uvw in the struct-of-arrays layout
+/// @details This is the same information as returned by uvw(), but stored as a
+/// nRow x 3 matrix. Each column (u, v and w, respectively) is contiguous in memory.
+/// @return a reference to nRow x 3 matrix with u, v and w in columns
+const casacore::Matrix<casacore::Double>& TableConstDataAccessor::uvwColumns() const
+{
+  return itsUVWColumns.value(*this, &TableConstDataAccessor::fillUVWColumns);
+}
+
+/// @brief pointing directions of the first antenna/feed in the struct-of-arrays layout
+/// @return a reference to nRow x 2 matrix with longitudes and latitudes in columns
+const casacore::Matrix<casacore::Double>& TableConstDataAccessor::pointingDir1Columns() const
+{
+  return itsPointingDir1Columns.value(*this, &TableConstDataAccessor::fillPointingDir1Columns);
+}
+
+/// @brief pointing directions of the second antenna/feed in the struct-of-arrays layout
+/// @return a reference to nRow x 2 matrix with longitudes and latitudes in columns
+const casacore::Matrix<casacore::Double>& TableConstDataAccessor::pointingDir2Columns() const
+{
+  return itsPointingDir2Columns.value(*this, &TableConstDataAccessor::fillPointingDir2Columns);
+}
+
+/// @brief bit-packed flags
+/// @details This is the same information as returned by flag(), but packed with
+/// one bit per sample and with a summary for each row.
+/// @return a reference to packed flags
+const PackedFlagCube& TableConstDataAccessor::packedFlag() const
+{
+  return itsPackedFlag.value(*this, &TableConstDataAccessor::fillPackedFlag);
+}
+
+/// @brief baseline index for each row
+/// @details The index is antenna1 * nAntenna + antenna2, where nAntenna is the number of
+/// antennas in the ANTENNA subtable.
+/// @return a reference to the vector with nRow baseline indices
+const casacore::Vector<casacore::uInt>& TableConstDataAccessor::baselineIndex() const
+{
+  return itsBaselineIndex.value(*this, &TableConstDataAccessor::fillBaselineIndex);
+}
+
+/// @brief compact noise
+/// @details This is the same information as returned by noise(), but stored per
+/// row and polarisation if the noise doesn't depend on the spectral channel.
+/// @return a reference to compact noise 
+const CompactNoise& TableConstDataAccessor::compactNoise() const
+{
+  return itsCompactNoise.value(itsIterator, &TableConstDataIterator::fillCompactNoise);
+}
+
+/// @brief fill the bit-packed flags
+/// @param[in] flags a reference to packed flags to fill
+void TableConstDataAccessor::fillPackedFlag(PackedFlagCube &flags) const
+{
+  flags.assign(flag());
+}
+
+/// @brief fill the baseline indices
+/// @param[in] indices a reference to the vector to fill
+void TableConstDataAccessor::fillBaselineIndex(casacore::Vector<casacore::uInt> &indices) const
+{
+  const casacore::uInt nAnt = itsIterator.subtableInfo().getAntenna().getNumberOfAntennas();
+  const casacore::uInt nRows = nRow();
+  const casacore::uInt *ant1 = antenna1Data();
+  const casacore::uInt *ant2 = antenna2Data();
+  indices.resize(nRows);
+  casacore::uInt *out = indices.data();
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       out[row] = ant1[row] * nAnt + ant2[row];
+  }
+}
+
+/// @brief fill the buffer of uvw
+/// @details The bounding box of uvw is filled in the same pass
+/// @param[in] uvw a reference to vector of rigid vectors to fill
+void TableConstDataAccessor::fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw) const
+{
+  itsIterator.fillUVW(uvw, itsUVWBounds);
+}
+
+/// @brief fill the struct-of-arrays buffer of uvw
+/// @param[in] uvw a reference to the nRow x 3 matrix to fill
+void TableConstDataAccessor::fillUVWColumns(casacore::Matrix<casacore::Double> &uvw) const
+{
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvwRows = this->uvw();
+  const casacore::uInt nRows = uvwRows.nelements();
+  uvw.resize(nRows, 3);
+  ASKAPDEBUGASSERT(uvw.contiguousStorage());
+  casacore::Double *u = uvw.data();
+  casacore::Double *v = u + nRows;
+  casacore::Double *w = v + nRows;
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       const casacore::RigidVector<casacore::Double, 3> &current = uvwRows[row];
+       u[row] = current(0);
+       v[row] = current(1);
+       w[row] = current(2);
+  }
+}
+
+/// @brief fill the struct-of-arrays buffer of the first pointing directions
+/// @param[in] dirs a reference to the nRow x 2 matrix to fill
+void TableConstDataAccessor::fillPointingDir1Columns(casacore::Matrix<casacore::Double> &dirs) const
+{
+  splitDirections(pointingDir1(), dirs);
+}
+
+/// @brief fill the struct-of-arrays buffer of the second pointing directions
+/// @param[in] dirs a reference to the nRow x 2 matrix to fill
+void TableConstDataAccessor::fillPointingDir2Columns(casacore::Matrix<casacore::Double> &dirs) const
+{
+  splitDirections(pointingDir2(), dirs);
+}
+
+/// @brief helper method to split directions into longitude and latitude columns
+/// @param[in] in vector of directions
+/// @param[in] out a reference to the matrix to fill (resized to nelements x 2)
+void TableConstDataAccessor::splitDirections(const casacore::Vector<casacore::MVDirection> &in,
+                              casacore::Matrix<casacore::Double> &out)
+{
+  const casacore::uInt nRows = in.nelements();
+  out.resize(nRows, 2);
+  ASKAPDEBUGASSERT(out.contiguousStorage());
+  casacore::Double *lon = out.data();
+  casacore::Double *lat = lon + nRows;
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       lon[row] = in[row].getLong();
+       lat[row] = in[row].getLat();
+  }
+}
+
 /// invalidate fields  updated on each iteration
 void TableConstDataAccessor::invalidateIterationCaches() const throw()
 {
@@ -289,6 +439,12 @@ void TableConstDataAccessor::invalidateIterationCaches() const throw()
   itsDishPointing1.invalidate();
   itsDishPointing2.invalidate();
   itsNoise.invalidate();
+  itsUVWColumns.invalidate();
+  itsPointingDir1Columns.invalidate();
+  itsPointingDir2Columns.invalidate();
+  itsPackedFlag.invalidate();
+  itsBaselineIndex.invalidate();
+  itsCompactNoise.invalidate();
 }
 
 /// @brief invalidate all fields  corresponding to the spectral axis
@@ -301,6 +457,20 @@ void TableConstDataAccessor::invalidateSpectralCaches() const throw()
   itsStokes.invalidate();
 }
 
+/// @brief invalidate fields depending on the range of channels
+/// @details This method is used when the iterator moves to the next block of channels
+/// for the same rows. Visibility, flag and noise cubes and the frequency axis are
+/// invalidated, all other fields remain valid.
+void TableConstDataAccessor::invalidateChannelCaches() const throw()
+{
+  itsVisibility.invalidate();
+  itsFlag.invalidate();
+  itsPackedFlag.invalidate();
+  itsCompactNoise.invalidate();
+  itsNoise.invalidate();
+  itsFrequency.invalidate();
+}
+
 /// @brief invalidate cache of rotated uvw and delays
 /// @details Cache of rotated uvw and delays is kept per accessor, need this
 /// method to access private field
@@ -309,6 +479,14 @@ void TableConstDataAccessor::invalidateRotatedUVW() const throw()
   itsRotatedUVW.invalidate();
 }
 
+/// @brief set up the cache of rotated uvws and delays shared between iterations
+/// @details An empty shared pointer disables caching.
+/// @param[in] cache shared pointer to the cache
+void TableConstDataAccessor::setRotatedUVWCache(const boost::shared_ptr<RotatedUVWCache> &cache)
+{
+  itsRotatedUVW.setResultCache(cache);
+}
+
 
 /// @brief Obtain a const reference to associated iterator.
 /// @details This method is mainly intended to be used in the derived
@@ -40,6 +40,8 @@
 #include <askap/dataaccess/DataAccessError.h>
 #include <askap/dataaccess/CachedAccessorField.h>
 #include <askap/dataaccess/UVWRotationHandler.h>
+#include <askap/dataaccess/PackedFlagCube.h>
+#include <askap/dataaccess/CompactNoise.h>
 
 namespace askap {
 	
@@ -141,6 +143,18 @@ public:
   /// @return delays corresponding to the uvw rotation for each row
   virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
 	       const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const;
+
+  /// @brief bounding box of uvw
+  /// @details The bounds are computed in the same pass which reads uvw from the table,
+  /// so this method doesn't scan the uvw again.
+  /// @return bounding box of uvw
+  virtual UVWBounds uvwBounds() const;
+
+  /// @brief bounding box of uvw after rotation
+  /// @details The bounds are computed in the same pass which rotates uvw.
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @return bounding box of rotated uvw
+  virtual UVWBounds rotatedUVWBounds(const casacore::MDirection &tangentPoint) const;
   
   /// Frequency for each channel
   /// @return a reference to vector containing frequencies for each
@@ -204,6 +218,82 @@ public:
   /// @note All rows of the accessor have the same structure of the visibility
   /// cube, i.e. polarisation types returned by this method are valid for all rows.
   virtual const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const;
+
+  /// @brief uvw in the struct-of-arrays layout
+  /// @details This is the same information as returned by uvw(), but stored as a
+  /// nRow x 3 matrix. Each column (u, v and w, respectively) is contiguous in memory,
+  /// which is more convenient for vectorised numeric kernels than the vector of
+  /// rigid vectors. The matrix is built on demand and cached until the next iteration.
+  /// @note This method is specific to the table-based implementation and is not
+  /// exposed via IConstDataAccessor.
+  /// @return a reference to nRow x 3 matrix with u, v and w in columns
+  const casacore::Matrix<casacore::Double>& uvwColumns() const;
+
+  /// @brief pointing directions of the first antenna/feed in the struct-of-arrays layout
+  /// @details This is the same information as returned by pointingDir1(), but stored
+  /// as a nRow x 2 matrix with longitude and latitude (in radians) in separate contiguous
+  /// columns. The matrix is built on demand and cached until the next iteration.
+  /// @return a reference to nRow x 2 matrix with longitudes and latitudes in columns
+  const casacore::Matrix<casacore::Double>& pointingDir1Columns() const;
+
+  /// @brief pointing directions of the second antenna/feed in the struct-of-arrays layout
+  /// @details This is the same information as returned by pointingDir2(), but stored
+  /// as a nRow x 2 matrix with longitude and latitude (in radians) in separate contiguous
+  /// columns. The matrix is built on demand and cached until the next iteration.
+  /// @return a reference to nRow x 2 matrix with longitudes and latitudes in columns
+  const casacore::Matrix<casacore::Double>& pointingDir2Columns() const;
+
+  /// @brief first antenna IDs as a contiguous array
+  /// @details This is the same information as returned by antenna1(), given as a raw
+  /// pointer to nRow() contiguous elements for numeric kernels. The pointer is valid
+  /// until the next iteration.
+  /// @return pointer to the first antenna ID of the chunk
+  inline const casacore::uInt* antenna1Data() const { return antenna1().data(); }
+
+  /// @brief second antenna IDs as a contiguous array
+  /// @details See antenna1Data
+  /// @return pointer to the second antenna ID of the chunk
+  inline const casacore::uInt* antenna2Data() const { return antenna2().data(); }
+
+  /// @brief first feed IDs as a contiguous array
+  /// @details See antenna1Data
+  /// @return pointer to the first feed ID of the chunk
+  inline const casacore::uInt* feed1Data() const { return feed1().data(); }
+
+  /// @brief second feed IDs as a contiguous array
+  /// @details See antenna1Data
+  /// @return pointer to the second feed ID of the chunk
+  inline const casacore::uInt* feed2Data() const { return feed2().data(); }
+
+  /// @brief baseline index for each row
+  /// @details The index is antenna1 * nAntenna + antenna2, where nAntenna is the number of
+  /// antennas in the ANTENNA subtable. It can be used to address per-baseline arrays of
+  /// nAntenna * nAntenna elements directly. The vector is built on demand and cached
+  /// until the next iteration.
+  /// @note This method is specific to the table-based implementation and is not
+  /// exposed via IConstDataAccessor.
+  /// @return a reference to the vector with nRow baseline indices
+  const casacore::Vector<casacore::uInt>& baselineIndex() const;
+
+  /// @brief bit-packed flags
+  /// @details This is the same information as returned by flag(), but packed with
+  /// one bit per sample and with a summary for each row. Consumers can use the summary
+  /// to skip fully flagged rows without scanning them. The packed representation
+  /// is built on demand and cached until the flags are invalidated.
+  /// @note This method is specific to the table-based implementation and is not
+  /// exposed via IConstDataAccessor. Changes made to the flags via the read-write
+  /// accessor after the packed flags have been built are not tracked.
+  /// @return a reference to packed flags
+  const PackedFlagCube& packedFlag() const;
+
+  /// @brief compact noise
+  /// @details This is the same information as returned by noise(), but stored per
+  /// row and polarisation if the noise doesn't depend on the spectral channel (the usual 
+  /// case with SIGMA column). The full cube is never built if only this method is used.
+  /// @note This method is specific to the table-based implementation and is not
+  /// exposed via IConstDataAccessor.
+  /// @return a reference to compact noise 
+  const CompactNoise& compactNoise() const;
   
 
   /// @brief invalidate fields updated on each iteration
@@ -218,12 +308,25 @@ public:
   /// @brief invalidate fields corresponding to the spectral axis
   /// @details See invalidateIterationCaches for more details
   void invalidateSpectralCaches() const throw();
+
+  /// @brief invalidate fields depending on the range of channels
+  /// @details This method is used when the iterator moves to the next block of channels
+  /// for the same rows. Visibility, flag and noise cubes and the frequency axis are
+  /// invalidated, all other fields remain valid.
+  void invalidateChannelCaches() const throw();
   
   /// @brief invalidate cache of rotated uvw and delays
   /// @details Cache of rotated uvw and delays is kept per accessor, need this
   /// method to access private field
   void invalidateRotatedUVW() const throw();
 
+  /// @brief set up the cache of rotated uvws and delays shared between iterations
+  /// @details The cache is keyed by the rows of the current chunk obtained from the
+  /// associated iterator (see TableConstDataIterator::rotatedUVWKey). An empty shared
+  /// pointer disables caching.
+  /// @param[in] cache shared pointer to the cache
+  void setRotatedUVWCache(const boost::shared_ptr<RotatedUVWCache> &cache);
+
   /// @brief Obtain a const reference to associated iterator.
   /// @details This method is mainly intended to be used in the derived
   /// non-const implementation, which works with a different type of the
@@ -234,6 +337,37 @@ private:
   /// a helper adapter method to set the time via non-const reference
   /// @param[in] time a reference to buffer to fill with the current time 
   void readTime(casacore::Double &time) const;
+
+  /// @brief fill the buffer of uvw
+  /// @details The bounding box of uvw is filled in the same pass
+  /// @param[in] uvw a reference to vector of rigid vectors to fill
+  void fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw) const;
+
+  /// @brief fill the struct-of-arrays buffer of uvw
+  /// @param[in] uvw a reference to the nRow x 3 matrix to fill
+  void fillUVWColumns(casacore::Matrix<casacore::Double> &uvw) const;
+
+  /// @brief fill the struct-of-arrays buffer of the first pointing directions
+  /// @param[in] dirs a reference to the nRow x 2 matrix to fill
+  void fillPointingDir1Columns(casacore::Matrix<casacore::Double> &dirs) const;
+
+  /// @brief fill the struct-of-arrays buffer of the second pointing directions
+  /// @param[in] dirs a reference to the nRow x 2 matrix to fill
+  void fillPointingDir2Columns(casacore::Matrix<casacore::Double> &dirs) const;
+
+  /// @brief fill the bit-packed flags
+  /// @param[in] flags a reference to packed flags to fill
+  void fillPackedFlag(PackedFlagCube &flags) const;
+
+  /// @brief fill the baseline indices
+  /// @param[in] indices a reference to the vector to fill
+  void fillBaselineIndex(casacore::Vector<casacore::uInt> &indices) const;
+
+  /// @brief helper method to split directions into longitude and latitude columns
+  /// @param[in] in vector of directions
+  /// @param[in] out a reference to the matrix to fill (resized to nelements x 2)
+  static void splitDirections(const casacore::Vector<casacore::MVDirection> &in,
+                              casacore::Matrix<casacore::Double> &out);
   
   /// a reference to iterator managing this accessor
   const TableConstDataIterator& itsIterator;
@@ -246,6 +380,9 @@ private:
  
   /// internal buffer for uvw
   CachedAccessorField<casacore::Vector<casacore::RigidVector<casacore::Double, 3> > > itsUVW;
+
+  /// bounding box of uvw, valid whenever itsUVW is valid
+  mutable UVWBounds itsUVWBounds;
   
   /// internal buffer for rotated uvw and associated delay
   UVWRotationHandler itsRotatedUVW; 
@@ -291,6 +428,24 @@ private:
   
   /// internal buffer for the polarisation types
   CachedAccessorField<casacore::Vector<casacore::Stokes::StokesTypes> > itsStokes;
+
+  /// internal buffer for uvw in the struct-of-arrays layout
+  CachedAccessorField<casacore::Matrix<casacore::Double> > itsUVWColumns;
+
+  /// internal buffer for the first pointing directions in the struct-of-arrays layout
+  CachedAccessorField<casacore::Matrix<casacore::Double> > itsPointingDir1Columns;
+
+  /// internal buffer for the second pointing directions in the struct-of-arrays layout
+  CachedAccessorField<casacore::Matrix<casacore::Double> > itsPointingDir2Columns;
+
+  /// internal buffer for bit-packed flags
+  CachedAccessorField<PackedFlagCube> itsPackedFlag;
+
+  /// internal buffer for baseline indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsBaselineIndex;
+
+  /// internal buffer for compact noise
+  CachedAccessorField<CompactNoise> itsCompactNoise;
 };
 
 
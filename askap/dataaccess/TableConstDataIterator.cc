@@ -39,17 +39,33 @@
 #include <askap/profile/AskapProfiler.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/RowNumbers.h>
 #include <casacore/measures/TableMeasures/ScalarMeasColumn.h>
 #include <casacore/scimath/Mathematics/SquareMatrix.h>
 #include <casacore/measures/Measures/MeasFrame.h>
 #include <casacore/measures/Measures/MCFrequency.h>
+#include <casacore/casa/Arrays/Slice.h>
 #include <casacore/casa/Arrays/Slicer.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Containers/Record.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <sstream>
+#include <cmath>
+#include <algorithm>
 
 /// Local package
 #include <askap/dataaccess/TableConstDataIterator.h>
 #include <askap/dataaccess/DataAccessError.h>
-#include <askap/dataaccess/DirectionConverter.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/dataaccess/IORecorder.h>
+#include <askap/dataaccess/BatchDirectionConverter.h>
+#include <askap/dataaccess/ChannelAverager.h>
 
 ASKAP_LOGGER(logger, "");
 
@@ -83,6 +99,11 @@ struct WholeRowFlagger
   /// If it can't do this, it returns true, which forces an element by element
   /// processing. By default parameters are not used
   inline bool copyRequired(casacore::uInt, casacore::Cube<T> &) { return true;}
+
+  /// @brief flag whole rows of the cube read in bulk
+  /// @details This method is used when the cube is read in one go rather than
+  /// row by row. Nothing is done in the default version
+  inline void flagRows(casacore::rownr_t, casacore::uInt, casacore::Cube<T> &) {}
 };
 
 
@@ -106,6 +127,14 @@ struct WholeRowFlagger<casacore::Bool>
   /// @param[in] row a row to work with
   /// @param[in] cube cube to work with
   inline bool copyRequired(casacore::uInt row, casacore::Cube<casacore::Bool> &cube);
+
+  /// @brief flag whole rows of the cube read in bulk
+  /// @details This method is used when the cube is read in one go rather than
+  /// row by row. All rows with FLAG_ROW set are flagged in the cube.
+  /// @param[in] topRow row of the table corresponding to row 0 of the cube
+  /// @param[in] nRows number of rows in the cube
+  /// @param[in] cube cube to work with
+  inline void flagRows(casacore::rownr_t topRow, casacore::uInt nRows, casacore::Cube<casacore::Bool> &cube);
 private:
   /// @brief accessor to the FLAG_ROW column
   ROScalarColumn<casacore::Bool> itsFlagRowCol;
@@ -134,6 +163,243 @@ bool WholeRowFlagger<casacore::Bool>::copyRequired(casacore::uInt row,
   return true;
 }
 
+void WholeRowFlagger<casacore::Bool>::flagRows(casacore::rownr_t topRow, casacore::uInt nRows,
+                 casacore::Cube<casacore::Bool> &cube)
+{
+  if (itsHasFlagRow) {
+      ASKAPDEBUGASSERT(cube.nrow() == nRows);
+      const casacore::Vector<casacore::Bool> rowFlags = itsFlagRowCol.getColumnRange(Slicer(IPosition(1,
+                       topRow),IPosition(1,nRows)));
+      if (!casacore::anyEQ(rowFlags, casacore::True)) {
+          return;
+      }
+      if (!cube.contiguousStorage() || !rowFlags.contiguousStorage()) {
+          for (casacore::uInt row = 0; row < nRows; ++row) {
+               if (rowFlags[row]) {
+                   cube.yzPlane(row) = true;
+               }
+          }
+          return;
+      }
+      // the row axis is the fastest varying one, apply the row flags as a mask to every
+      // channel and polarisation without branching per row
+      const casacore::Bool* flags = rowFlags.data();
+      casacore::Bool* dst = cube.data();
+      const size_t nPlanes = size_t(cube.ncolumn()) * cube.nplane();
+      for (size_t plane = 0; plane < nPlanes; ++plane, dst += nRows) {
+           for (casacore::uInt row = 0; row < nRows; ++row) {
+                dst[row] = dst[row] || flags[row];
+           }
+      }
+  }
+}
+
+/// @brief read a slab of an array column into a cube in one go
+/// @details This is a fast path for readCube if all rows of the chunk have the
+/// shape of the table. The chunk is read with a single getColumnRange call, selecting
+/// the channel and polarisation range with the slicer. The layout of
+/// the table column (nPol x nChannel per row) is the reverse of the cube layout, so in
+/// general the data have to be transposed. However, if at most one of the three axes is
+/// longer than one, the layouts coincide and the cube just references the buffer
+/// filled by the table system, avoiding the copy altogether.
+/// @param[in] tableCol column to read
+/// @param[in] topRow row of the table corresponding to row 0 of the cube
+/// @param[in] nRows number of rows to read
+/// @param[in] nPol number of polarisations to read
+/// @param[in] nChan number of channels to read
+/// @param[in] cellSlicer slicer selecting polarisations and channels from the cells of the
+///            table, empty pointer means that whole cells are read
+/// @param[in] cube a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the information from table
+template<typename T>
+void readRowRange(const ROArrayColumn<T> &tableCol, casacore::rownr_t topRow,
+                  casacore::uInt nRows, casacore::uInt nPol, casacore::uInt nChan,
+                  const Slicer *cellSlicer, casacore::Cube<T> &cube)
+{
+  const Slicer rowSlicer(IPosition(1,topRow),IPosition(1,nRows));
+  const casacore::Array<T> buf = cellSlicer != NULL ? tableCol.getColumnRange(rowSlicer, *cellSlicer) :
+                                 tableCol.getColumnRange(rowSlicer);
+  ASKAPDEBUGASSERT(buf.shape() == IPosition(3, nPol, nChan, nRows));
+  const int nLongAxes = (nRows > 1 ? 1 : 0) + (nChan > 1 ? 1 : 0) + (nPol > 1 ? 1 : 0);
+  if (nLongAxes <= 1) {
+      // the same element order in memory, no need to copy
+      cube.reference(buf.reform(IPosition(3, nRows, nChan, nPol)));
+      return;
+  }
+  cube.resize(nRows, nChan, nPol);
+  ASKAPDEBUGASSERT(cube.contiguousStorage());
+  bool deleteIt = false;
+  const T* src = buf.getStorage(deleteIt);
+  T* dst = cube.data();
+  const size_t planeSize = size_t(nRows) * nChan;
+  // go through the source buffer sequentially
+  for (casacore::uInt row = 0; row < nRows; ++row) {
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            T* dstElem = dst + row + size_t(nRows) * chan;
+            for (casacore::uInt pol = 0; pol < nPol; ++pol, ++src) {
+                 dstElem[planeSize * pol] = *src;
+            }
+       }
+  }
+  src -= planeSize * nPol;
+  buf.freeStorage(src, deleteIt);
+}
+
+/// @brief read an array column of the table into a cube
+/// @details This helper does the actual work for TableConstDataIterator::fillCube.
+/// It doesn't depend on the state of the iterator and, therefore, can also be
+/// used by the read-ahead thread (with appropriate locking).
+/// @param[in] iteration table to read (current iteration of the table iterator)
+/// @param[in] topRow row of the table corresponding to row 0 of the cube
+/// @param[in] nRows number of rows to read
+/// @param[in] nPolInTable expected number of polarisations in the table
+/// @param[in] polSlice polarisations to read (only those are stored in the cube)
+/// @param[in] nChanInTable expected number of channels in the table
+/// @param[in] startChan first channel to read
+/// @param[in] nChan number of channels to read
+/// @param[in] columnName a name of the column to read
+/// @param[in] cube a reference to the nRow x nChannel x nPol buffer
+///            cube to fill with the information from table
+template<typename T>
+void readCube(const casacore::Table &iteration, casacore::rownr_t topRow,
+              casacore::uInt nRows, casacore::uInt nPolInTable, const casacore::Slice &polSlice,
+              casacore::uInt nChanInTable, casacore::uInt startChan, casacore::uInt nChan,
+              const std::string &columnName, casacore::Cube<T> &cube)
+{
+  const casacore::uInt nPol = polSlice.length();
+  const bool allPols = (nPol == nPolInTable);
+  // Setup a slicer to extract the specified channel and polarisation range only
+  const Slicer chanSlicer(allPols ? Slice() : polSlice, Slice(startChan,nChan));
+
+  IORecorder::ScopedEvent ioEvent(IORecorder::TABLE_READ);
+  if (ioEvent.active()) {
+      ioEvent.setRows(iteration, columnName, topRow, nRows);
+      ioEvent.setChannels(startChan, nChan);
+      ioEvent.addBytes(size_t(nRows) * nChan * nPol * sizeof(T));
+  }
+
+  ROArrayColumn<T> tableCol(iteration,columnName);
+
+  // helper class, which does nothing for visibility cube, but checks
+  // FLAG_ROW for flagging
+  WholeRowFlagger<T> wrFlagger(iteration);
+
+  if (nRows > 0) {
+      // if the first and the last rows have the expected shape, read the chunk in one go
+      // (the table system checks that the cells of all rows in between conform)
+      const casacore::IPosition firstShape = tableCol.shape(topRow);
+      const casacore::IPosition lastShape = tableCol.shape(topRow + nRows - 1);
+      if ((firstShape.size() == 2) && (firstShape[0] == casacore::Int(nPolInTable)) &&
+          (firstShape[1] == casacore::Int(nChanInTable)) && firstShape.isEqual(lastShape)) {
+          // channel range and polarisation subset are read directly from the column
+          // without reading other products
+          const bool wholeCells = allPols && (startChan == 0) && (nChan == nChanInTable);
+          readRowRange(tableCol, topRow, nRows, nPol, nChan, wholeCells ? NULL : &chanSlicer, cube);
+          wrFlagger.flagRows(topRow, nRows, cube);
+          return;
+      }
+  }
+
+  // this is only reached for non-conformant chunks, rows are checked one by one to
+  // report the offending row
+  cube.resize(nRows, nChan, nPol);
+
+  // temporary buffer declared outside the loop
+  casacore::Matrix<T> buf(nPol, nChan);
+  for (uInt row=0; row<nRows; ++row) {
+       const casacore::IPosition shape = tableCol.shape(row + topRow);
+       ASKAPASSERT(shape.size() && (shape.size()<3));
+       const casacore::uInt thisRowNumberOfPols=shape[0];
+       const casacore::uInt thisRowNumberOfChannels = shape.size() > 1 ? shape[1] : 1;
+       if (thisRowNumberOfPols!=nPolInTable) {
+           ASKAPTHROW(DataAccessError,"Number of polarizations is not "
+	               "conformant for row "<<row<<" of the "<<columnName<<
+	               "column");
+       }
+       if (thisRowNumberOfChannels!=nChanInTable) {
+           ASKAPTHROW(DataAccessError,"Number of channels is not "
+	               "conformant for row "<<row<<" of the "<<columnName<<
+	               "column");
+       }
+       // for now just copy. In the future we will pass this array through
+       // the transformation which will do averaging, selection,
+       // polarization conversion
+
+       if (wrFlagger.copyRequired(row + topRow, cube)) {
+           // Extract slice for this row
+           tableCol.getSlice(row + topRow, chanSlicer, buf, False);
+
+           // Copy the slice into the cube
+           for (uInt chan = 0; chan < nChan; ++chan) {
+               for (uInt pol = 0; pol < nPol; ++pol) {
+                   cube(row,chan,pol) = buf(pol,chan);
+               }
+           }
+       }
+  }
+}
+
+/// @brief determine whether the column is stored by a compressing data manager
+/// @details Only the data managers known to decompress the data on the fly are
+/// recognised (they are either virtual column engines or storage managers).
+/// @param[in] table table to check
+/// @param[in] columnName name of the column
+/// @return type of the data manager if it compresses the column, empty string otherwise
+std::string compressingDataManager(const casacore::Table &table, const std::string &columnName)
+{
+  if (table.isNull() || !table.actualTableDesc().isColumn(columnName)) {
+      return std::string();
+  }
+  const casacore::Record info = table.dataManagerInfo();
+  for (casacore::uInt field = 0; field < info.nfields(); ++field) {
+       const casacore::Record &dm = info.subRecord(field);
+       if (!dm.isDefined("COLUMNS") || !dm.isDefined("TYPE")) {
+           continue;
+       }
+       const casacore::Vector<casacore::String> columns = dm.asArrayString("COLUMNS");
+       if (std::find(columns.begin(), columns.end(), casacore::String(columnName)) == columns.end()) {
+           continue;
+       }
+       const std::string type = dm.asString("TYPE");
+       if ((type == "DyscoStMan") || (type.compare(0, 8, "Compress") == 0)) {
+           return type;
+       }
+       return std::string();
+  }
+  return std::string();
+}
+
+/// @brief read uvw column of the table
+/// @details This helper does the actual work for TableConstDataIterator::fillUVW.
+/// Similar to readCube, it doesn't depend on the state of the iterator.
+/// @param[in] iteration table to read (current iteration of the table iterator)
+/// @param[in] topRow row of the table corresponding to row 0 of the output vector
+/// @param[in] nRows number of rows to read
+/// @param[in] uvw a reference to vector of rigid vectors (3 elemets,
+///            u,v and w for each row) to fill
+/// @param[in] bounds bounding box of uvw, accumulated in the same pass (reset first)
+void readUVW(const casacore::Table &iteration, casacore::rownr_t topRow,
+             casacore::uInt nRows, casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+             UVWBounds &bounds)
+{
+  uvw.resize(nRows);
+  bounds.reset();
+
+  ROArrayColumn<Double> uvwCol(iteration,"UVW");
+  // temporary buffer
+  Vector<Double> buf(3);
+  for (uInt row=0;row<nRows;++row) {
+#ifdef ASKAP_DEBUG
+       const casacore::IPosition shape=uvwCol.shape(row);
+       ASKAPDEBUGASSERT(shape.size()==1);
+       ASKAPDEBUGASSERT(shape[0]==3);
+#endif // ASKAP_DEBUG
+       // extract data record for this row, no resizing
+       uvwCol.get(row+topRow,buf,False);
+       uvw(row) = buf;
+       bounds.add(buf[0], buf[1], buf[2]);
+  }
+}
 
 } // namespace accessors
 
@@ -146,12 +412,21 @@ bool WholeRowFlagger<casacore::Bool>::copyRequired(casacore::uInt row,
 /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
 /// to initialisation of a new UVW Machine
 /// @param[in] maxChunkSize maximum number of rows per accessor
+/// @param[in] readAhead if true, visibilities, flags and uvw for the next chunk are
+/// read by a background thread while the current chunk is processed. Read-ahead is
+/// always enabled if the data column is compressed
+/// @param[in] maxChannelBlock maximum number of spectral channels per accessor, 0 means
+/// no restriction
+/// @param[in] tableMutex mutex serialising access to the table, a new one is created if
+/// an empty shared pointer is given (default)
 TableConstDataIterator::TableConstDataIterator(
             const boost::shared_ptr<ITableManager const> &msManager,
             const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
             const boost::shared_ptr<IDataConverterImpl const> &conv,
             size_t cacheSize, double tolerance,
-            casacore::uInt maxChunkSize) :
+            casacore::uInt maxChunkSize, bool readAhead,
+            casacore::uInt maxChannelBlock,
+            const boost::shared_ptr<boost::recursive_mutex> &tableMutex) :
         TableInfoAccessor(msManager),
         // it is essential that accessor is initialised after cache parameters!
 	    itsUVWCacheSize(cacheSize), itsUVWCacheTolerance(tolerance),
@@ -160,8 +435,15 @@ TableConstDataIterator::TableConstDataIterator(
         itsSelector(sel->clone()),
 	    itsConverter(conv->clone()),
 #endif
-	    itsMaxChunkSize(maxChunkSize),
-        itsAtStart(false)
+	    itsMaxChunkSize(maxChunkSize), itsIterationStep(0),
+        itsChannelAveraging(1), itsAtStart(false), itsReadAhead(readAhead), itsMaxChannelBlock(maxChannelBlock),
+        itsChannelBlock(0), itsNumberOfChannelBlocks(1),
+        itsNumberOfSelectedPols(0), itsPolStart(0), itsPolIncrement(1),
+        itsAccessorFields(IDataSelector::ALL_FIELDS),
+        itsChunkCounter(0), itsVisibilityChecksum(0), itsFlagChecksum(0),
+        itsVisibilityChecksumValid(false), itsFlagChecksumValid(false), itsChunkSummaryAdded(false),
+        itsRotatedUVWKeyValid(false), itsComputedUVW(false),
+        itsTableMutex(tableMutex ? tableMutex : boost::shared_ptr<boost::recursive_mutex>(new boost::recursive_mutex))
 {
   ASKAPDEBUGASSERT(conv);
   ASKAPDEBUGASSERT(sel);
@@ -169,15 +451,55 @@ TableConstDataIterator::TableConstDataIterator(
     itsConverter = conv->clone();
     itsSelector  = sel->clone();
   #endif
+  itsAccessorFields = itsSelector->getAccessorFields();
+  // add fields used internally to compute the declared ones
+  if (itsAccessorFields & (IDataSelector::POINTING | IDataSelector::FEED_PA)) {
+      itsAccessorFields |= IDataSelector::ANTENNA | IDataSelector::FEED;
+  }
+  if (itsAccessorFields & IDataSelector::DISH_POINTING) {
+      itsAccessorFields |= IDataSelector::ANTENNA;
+  }
+  {
+    boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+    itsCompressingDataManager = accessors::compressingDataManager(table(), getDataColumnName());
+  }
+  if (compressedDataColumn() && !itsReadAhead) {
+      ASKAPLOG_DEBUG_STR(logger, "Column "<<getDataColumnName()<<" is compressed by "<<
+                         itsCompressingDataManager<<", read-ahead of the next chunk is enabled");
+      itsReadAhead = true;
+  }
   init();
 }
 
+/// @brief destructor
+/// @details Waits for the read-ahead thread (if any) to finish. Table objects
+/// are released while holding the table mutex, as the mutex may be shared with
+/// iterators working in other threads.
+TableConstDataIterator::~TableConstDataIterator()
+{
+  waitForReadAhead();
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+  itsReadAheadBuffer.reset();
+  itsPrefetchedChunk.reset();
+  itsCurrentIteration = casacore::Table();
+  itsSelectedTable = casacore::Table();
+}
+
 /// Restart the iteration from the beginning
 void TableConstDataIterator::init()
 {
     ASKAPTRACE("TableConstDataIterator::init");
   // avoid doing this if not required as it can be expensive
   if (!itsAtStart) {
+      waitForReadAhead();
+      itsReadAheadBuffer.reset();
+      itsPrefetchedChunk.reset();
+      boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+      itsChunkCounter = 0;
+      itsVisibilityChecksumValid = false;
+      itsFlagChecksumValid = false;
+      itsChunkSummaryAdded = false;
+      itsRotatedUVWKeyValid = false;
       itsCurrentTopRow=0;
       itsCurrentDataDescID=-100; // this value can't be in the table,
                                  // therefore it is a flag of a new data descriptor
@@ -189,18 +511,39 @@ void TableConstDataIterator::init()
 
       const casacore::TableExprNode &exprNode =
                   itsSelector->getTableSelector(itsConverter);
-      if (exprNode.isNull()) {
-          itsTabIterator=casacore::TableIterator(table(),"TIME",
-    	     casacore::TableIterator::Ascending,casacore::TableIterator::NoSort);
-      } else {
-          itsTabIterator=casacore::TableIterator(table()(itsSelector->
-                                   getTableSelector(itsConverter)),"TIME",
-    	     casacore::TableIterator::Ascending,casacore::TableIterator::NoSort);
+      // the same selection is typically repeated in major cycles, reuse the result
+      const std::string selectionKey = itsSelector->getSelectionKey();
+      casacore::Table selectedTable = table();
+      if (selectionKey.size() && !subtableInfo().getSelectionCache().find(selectionKey, selectedTable)) {
+          if (itsSelector->rowsSelected()) {
+              // rows are resolved via the row index, no table scan is required
+              selectedTable = table()(casacore::RowNumbers(itsSelector->getRowSelection()));
+              if (!exprNode.isNull()) {
+                  selectedTable = selectedTable & table()(exprNode);
+              }
+          } else if (!exprNode.isNull()) {
+              selectedTable = table()(exprNode);
+          }
+          subtableInfo().getSelectionCache().add(selectionKey, selectedTable);
       }
+      // grouping of rows by time is the same for all iterators with this selection
+      boost::shared_ptr<TableSelectionCache::IterationPlan const> plan;
+      if (!subtableInfo().getSelectionCache().findPlan(selectionKey, plan)) {
+          plan = buildIterationPlan(selectedTable);
+          subtableInfo().getSelectionCache().addPlan(selectionKey, plan);
+      }
+      itsSelectedTable = selectedTable;
+      itsIterationPlan = plan;
+      itsIterationStep = 0;
+      itsScanIndex.clear();
       itsChannelsSelected = false;
       itsFlagData = false;
+      itsChannelBlock = 0;
       setUpIteration();
       itsAtStart = true;
+      if (itsReadAhead) {
+          startReadAhead();
+      }
   }
 }
 
@@ -215,12 +558,15 @@ const IConstDataAccessor& TableConstDataIterator::operator*() const
 /// @return True if there are more data available
 casacore::Bool TableConstDataIterator::hasMore() const throw()
 {
-  if (!itsTabIterator.pastEnd()) {
+  if (itsIterationPlan && itsIterationStep < itsIterationPlan->size()) {
       return true;
   }
   if (itsCurrentTopRow+itsNumberOfRows<itsCurrentIteration.nrow()) {
       return true;
   }
+  if (itsChannelBlock + 1 < itsNumberOfChannelBlocks) {
+      return true;
+  }
   return false;
 }
 
@@ -230,14 +576,30 @@ casacore::Bool TableConstDataIterator::hasMore() const throw()
 casacore::Bool TableConstDataIterator::next()
 {
   ASKAPTRACE("TableConstDataIterator::next");
+  // the background thread (if any) works on the chunk we're about to advance to
+  waitForReadAhead();
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   itsAtStart = false;
+  ++itsChunkCounter;
+  itsVisibilityChecksumValid = false;
+  itsFlagChecksumValid = false;
+  itsChunkSummaryAdded = false;
+  itsRotatedUVWKeyValid = false;
+  if (itsChannelBlock + 1 < itsNumberOfChannelBlocks) {
+      // same rows, next block of channels
+      ++itsChannelBlock;
+      itsAccessor.invalidateChannelCaches();
+      return true;
+  }
+  itsChannelBlock = 0;
   itsCurrentTopRow+=itsNumberOfRows;
   if (itsCurrentTopRow>=itsCurrentIteration.nrow()) {
-      ASKAPDEBUGASSERT(!itsTabIterator.pastEnd());
+      ASKAPDEBUGASSERT(itsIterationPlan);
+      ASKAPDEBUGASSERT(itsIterationStep < itsIterationPlan->size());
       itsCurrentTopRow=0;
-      // need to advance table iterator further
-      itsTabIterator.next();
-      if (!itsTabIterator.pastEnd()) {
+      // need to advance to the next time step
+      ++itsIterationStep;
+      if (itsIterationStep < itsIterationPlan->size()) {
           setUpIteration();
       }
   } else {
@@ -257,15 +619,325 @@ casacore::Bool TableConstDataIterator::next()
       // invalidate direction cache if necessary.
       // do nothing if itsUseFieldID is false
       makeUniformFieldID();
+      setUpChannelBlocks();
+  }
+  if (itsReadAhead) {
+      adoptReadAheadBuffer();
+      if (hasMore()) {
+          startReadAhead();
+      }
   }
   return hasMore();
 }
 
+/// @brief number of cycles (time steps) in the selected data
+/// @return number of distinct time stamps, as grouped by the iteration plan
+casacore::uInt TableConstDataIterator::nCycles() const
+{
+  ASKAPDEBUGASSERT(itsIterationPlan);
+  return casacore::uInt(itsIterationPlan->size());
+}
+
+/// @brief position the iterator at the given cycle
+/// @details The iterator points to the first accessor of the given cycle and the
+/// iteration can be continued from there with next().
+/// @param[in] cycle 0-based index of the time step in the selected data
+void TableConstDataIterator::seekCycle(casacore::uInt cycle)
+{
+  ASKAPTRACE("TableConstDataIterator::seekCycle");
+  ASKAPDEBUGASSERT(itsIterationPlan);
+  if (cycle >= itsIterationPlan->size()) {
+      ASKAPTHROW(DataAccessLogicError, "Requested cycle "<<cycle<<" is beyond "<<itsIterationPlan->size()<<
+                 " cycle(s) of the selected data");
+  }
+  waitForReadAhead();
+  itsReadAheadBuffer.reset();
+  itsPrefetchedChunk.reset();
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+  // the state differs from that after init, even for the first cycle
+  itsAtStart = false;
+  ++itsChunkCounter;
+  itsVisibilityChecksumValid = false;
+  itsFlagChecksumValid = false;
+  itsChunkSummaryAdded = false;
+  itsRotatedUVWKeyValid = false;
+  itsChannelBlock = 0;
+  itsCurrentTopRow = 0;
+  itsIterationStep = cycle;
+  // caches are only checked incrementally, the new time may be far away
+  itsDirectionCache.invalidate();
+  itsParallacticAngleCache.invalidate();
+  itsDishPointingCache.invalidate();
+  itsAccessor.invalidateRotatedUVW();
+  setUpIteration();
+  if (itsReadAhead && hasMore()) {
+      startReadAhead();
+  }
+}
+
+/// @brief position the iterator at the first cycle of the given scan
+/// @details The first row of each cycle determines the scan it belongs to.
+/// @param[in] scan scan number
+void TableConstDataIterator::seekScan(casacore::uInt scan)
+{
+  ASKAPDEBUGASSERT(itsIterationPlan);
+  if (itsScanIndex.empty() && itsIterationPlan->size()) {
+      boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+      ROScalarColumn<Int> scanCol(itsSelectedTable, "SCAN_NUMBER");
+      for (size_t cycle = 0; cycle < itsIterationPlan->size(); ++cycle) {
+           const Int scanNumber = scanCol((*itsIterationPlan)[cycle].first);
+           ASKAPCHECK(scanNumber >= 0, "Negative scan number encountered in the main table");
+           // the first cycle of the scan is kept
+           itsScanIndex.insert(std::make_pair(casacore::uInt(scanNumber), casacore::uInt(cycle)));
+      }
+  }
+  const std::map<casacore::uInt, casacore::uInt>::const_iterator ci = itsScanIndex.find(scan);
+  if (ci == itsScanIndex.end()) {
+      ASKAPTHROW(DataAccessLogicError, "Scan "<<scan<<" is not present in the selected data");
+  }
+  seekCycle(ci->second);
+}
+
+/// @brief check that the given field has been declared as used
+/// @details An exception is thrown if the field is not in the set of fields
+/// declared via the selector
+/// @param[in] field IDataSelector::AccessorFields value to check
+/// @param[in] name name of the field for the error message
+void TableConstDataIterator::checkAccessorField(casacore::uInt field, const char *name) const
+{
+  if (!(itsAccessorFields & field)) {
+      ASKAPTHROW(DataAccessLogicError, "An attempt to access "<<name<<
+                 " which has not been declared via chooseAccessorFields");
+  }
+}
+
+/// @brief start reading the next chunk in the background
+/// @details This method determines the rows of the chunk which will follow the current
+/// one and starts a thread filling the buffer. Nothing is done if there is no
+/// next chunk or it has a different data descriptor (and therefore potentially different shape).
+void TableConstDataIterator::startReadAhead()
+{
+  ASKAPDEBUGASSERT(!itsReadAheadThread);
+  itsReadAheadBuffer.reset();
+  // read-ahead is not done if the spectral axis is split into blocks, the following
+  // accessor could be the same rows with different channels
+  if (!itsNumberOfRows || itsCurrentDataDescID < 0 || itsMaxChannelBlock) {
+      return;
+  }
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+  boost::shared_ptr<ReadAheadBuffer> buf(new ReadAheadBuffer);
+  buf->itsChunk = itsChunkCounter + 1;
+  buf->itsTopRow = itsCurrentTopRow + itsNumberOfRows;
+  if (buf->itsTopRow < itsCurrentIteration.nrow()) {
+      buf->itsIteration = itsCurrentIteration;
+  } else {
+      // peek into the next time step of the plan
+      ASKAPDEBUGASSERT(itsIterationPlan);
+      if (itsIterationStep + 1 >= itsIterationPlan->size()) {
+          return;
+      }
+      buf->itsIteration = iterationTable(itsIterationStep + 1);
+      buf->itsTopRow = 0;
+  }
+  const casacore::rownr_t remainder = buf->itsIteration.nrow() - buf->itsTopRow;
+  if (remainder == 0) {
+      return;
+  }
+  buf->itsNumberOfRows = remainder <= itsMaxChunkSize ? remainder : itsMaxChunkSize;
+
+  // the same logic as in makeUniformDataDescID and makeUniformFieldID, but without
+  // changing the state of the iterator
+  if (buf->itsTopRow != 0) {
+      // the next chunk is in the current time step, its runs are known
+      const ColumnRuns::Run run = itsDataDescRuns.run(buf->itsTopRow);
+      if (run.first != itsCurrentDataDescID) {
+          // the shape of the cube may change, the next chunk will be read on demand
+          return;
+      }
+      buf->itsNumberOfRows = casacore::uInt(std::min(casacore::rownr_t(buf->itsNumberOfRows),
+                                                     run.second - buf->itsTopRow));
+      if (itsUseFieldID) {
+          buf->itsNumberOfRows = casacore::uInt(std::min(casacore::rownr_t(buf->itsNumberOfRows),
+                                 itsFieldRuns.run(buf->itsTopRow).second - buf->itsTopRow));
+      }
+  } else {
+      // the next chunk starts a new time step
+      ROScalarColumn<Int> dataDescCol(buf->itsIteration,"DATA_DESC_ID");
+      if (dataDescCol(buf->itsTopRow) != itsCurrentDataDescID) {
+          // the shape of the cube may change, the next chunk will be read on demand
+          return;
+      }
+      for (uInt row=1; row<buf->itsNumberOfRows; ++row) {
+           if (dataDescCol(row + buf->itsTopRow) != itsCurrentDataDescID) {
+               buf->itsNumberOfRows = row;
+               break;
+           }
+      }
+      if (itsUseFieldID) {
+          ROScalarColumn<Int> fieldIDCol(buf->itsIteration,"FIELD_ID");
+          const Int fieldID = fieldIDCol(buf->itsTopRow);
+          for (uInt row=1; row<buf->itsNumberOfRows; ++row) {
+               if (fieldIDCol(row + buf->itsTopRow) != fieldID) {
+                   buf->itsNumberOfRows = row;
+                   break;
+               }
+          }
+      }
+  }
+  buf->itsNPol = itsNumberOfPols;
+  buf->itsPolSlice = polSlice();
+  buf->itsNChanInTable = itsNumberOfChannels;
+  // frequency selection depends on time, so the channel range is not known in advance,
+  // averaged cubes are read on demand as the averaging needs flags and noise together
+  ASKAPDEBUGASSERT(itsSelector);
+  buf->itsReadCubes = !itsSelector->frequenciesSelected() && (channelAveraging() == 1) &&
+           (itsAccessorFields & (IDataSelector::VISIBILITY | IDataSelector::FLAG));
+  if (buf->itsReadCubes) {
+      const std::pair<casacore::uInt, casacore::uInt> chanRange = getChannelRange();
+      buf->itsNChan = chanRange.first;
+      buf->itsStartChan = chanRange.second;
+      if (itsArrayAllocator) {
+          // the cubes are allocated by this thread rather than by the background one,
+          // readCube keeps the storage as the shape matches
+          const casacore::IPosition shape(3, buf->itsNumberOfRows, buf->itsNChan, buf->itsPolSlice.length());
+          if (itsAccessorFields & IDataSelector::VISIBILITY) {
+              itsArrayAllocator->resize(buf->itsVisibility, shape);
+          }
+          if (itsAccessorFields & IDataSelector::FLAG) {
+              itsArrayAllocator->resize(buf->itsFlag, shape);
+          }
+      }
+  }
+  buf->itsVisibilityValid = false;
+  buf->itsFlagValid = false;
+  buf->itsUVWValid = false;
+  itsReadAheadBuffer = buf;
+  itsReadAheadThread.reset(new boost::thread(boost::bind(&TableConstDataIterator::readAhead, this, buf)));
+}
+
+/// @brief wait until the background read is finished
+void TableConstDataIterator::waitForReadAhead() const
+{
+  if (itsReadAheadThread) {
+      itsReadAheadThread->join();
+      itsReadAheadThread.reset();
+  }
+}
+
+/// @brief body of the background thread
+/// @param[in] buf buffer to fill
+void TableConstDataIterator::readAhead(const boost::shared_ptr<ReadAheadBuffer> &buf) const
+{
+  ASKAPDEBUGASSERT(buf);
+  itsThreadAffinity.apply("read-ahead");
+  try {
+     // the lock is released between columns to give the consumer thread a chance
+     // to access the table
+     // only the fields declared as used are read
+     if (buf->itsReadCubes && (itsAccessorFields & IDataSelector::VISIBILITY)) {
+         if (compressedDataColumn()) {
+             readCompressedVisibility(*buf);
+         } else {
+           boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+           readCube(buf->itsIteration, buf->itsTopRow, buf->itsNumberOfRows, buf->itsNPol,
+                    buf->itsPolSlice, buf->itsNChanInTable, buf->itsStartChan, buf->itsNChan, getDataColumnName(),
+                    buf->itsVisibility);
+         }
+         buf->itsVisibilityValid = true;
+     }
+     if (buf->itsReadCubes && (itsAccessorFields & IDataSelector::FLAG)) {
+         {
+           boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+           readCube(buf->itsIteration, buf->itsTopRow, buf->itsNumberOfRows, buf->itsNPol,
+                    buf->itsPolSlice, buf->itsNChanInTable, buf->itsStartChan, buf->itsNChan, "FLAG", buf->itsFlag);
+         }
+         buf->itsFlagValid = true;
+     }
+     // computed uvws don't require any I/O and are not read ahead
+     if ((itsAccessorFields & IDataSelector::UVW) && !itsComputedUVW) {
+         {
+           boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+           readUVW(buf->itsIteration, buf->itsTopRow, buf->itsNumberOfRows, buf->itsUVW, buf->itsUVWBounds);
+         }
+         buf->itsUVWValid = true;
+     }
+  }
+  catch (const std::exception &ex) {
+     // the data will be read again on demand, so any genuine problem will be reported then
+     ASKAPLOG_DEBUG_STR(logger, "Read-ahead of the next chunk failed: "<<ex.what());
+  }
+}
+
+/// @brief read compressed visibilities of the next chunk in blocks of rows
+/// @details This method is used by the background thread if the data column is
+/// compressed. Data managers decompress the data inside the table system, which is
+/// not thread-safe, so the blocks are decompressed one after another under the table
+/// mutex. However, the mutex is released between blocks, so the consumer thread and
+/// other iterators sharing the mutex are not locked out while the whole chunk is
+/// decompressed. Decompressed blocks are gathered in the buffer of the chunk.
+/// @param[in] buf buffer to fill
+void TableConstDataIterator::readCompressedVisibility(ReadAheadBuffer &buf) const
+{
+  // about 8 MB of decompressed data per block
+  const casacore::uInt64 samplesPerBlock = 1048576;
+  const casacore::uInt nPol = buf.itsPolSlice.length();
+  const casacore::uInt64 samplesPerRow = casacore::uInt64(buf.itsNChan) * nPol;
+  const casacore::uInt rowsPerBlock = samplesPerRow > 0 && samplesPerRow < samplesPerBlock ?
+                                      casacore::uInt(samplesPerBlock / samplesPerRow) : 1;
+  if (buf.itsNumberOfRows <= rowsPerBlock) {
+      boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+      readCube(buf.itsIteration, buf.itsTopRow, buf.itsNumberOfRows, buf.itsNPol, buf.itsPolSlice,
+               buf.itsNChanInTable, buf.itsStartChan, buf.itsNChan, getDataColumnName(), buf.itsVisibility);
+      return;
+  }
+  // the cube may have been allocated by the consumer thread already
+  buf.itsVisibility.resize(buf.itsNumberOfRows, buf.itsNChan, nPol);
+  casacore::Cube<casacore::Complex> block;
+  for (casacore::uInt row = 0; row < buf.itsNumberOfRows; row += rowsPerBlock) {
+       const casacore::uInt nRows = std::min(rowsPerBlock, buf.itsNumberOfRows - row);
+       DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::decompressBlock");
+       {
+         boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+         readCube(buf.itsIteration, buf.itsTopRow + row, nRows, buf.itsNPol, buf.itsPolSlice,
+                  buf.itsNChanInTable, buf.itsStartChan, buf.itsNChan, getDataColumnName(), block);
+       }
+       ASKAPDEBUGASSERT(block.shape() == casacore::IPosition(3, nRows, buf.itsNChan, nPol));
+       buf.itsVisibility(casacore::IPosition(3, row, 0, 0),
+                         casacore::IPosition(3, row + nRows - 1, buf.itsNChan - 1, nPol - 1)) = block;
+       timer.addBytes(block.nelements() * sizeof(casacore::Complex));
+  }
+}
+
+/// @brief take the buffer read in the background for the current chunk
+/// @details This method is called when the iterator advances. If the buffer
+/// filled in the background corresponds to the new current chunk, it is moved
+/// to itsPrefetchedChunk and subsequently used by the fill methods.
+void TableConstDataIterator::adoptReadAheadBuffer()
+{
+  ASKAPDEBUGASSERT(!itsReadAheadThread);
+  itsPrefetchedChunk.reset();
+  if (itsReadAheadBuffer && (itsReadAheadBuffer->itsChunk == itsChunkCounter) &&
+      (itsReadAheadBuffer->itsTopRow == itsCurrentTopRow) &&
+      (itsReadAheadBuffer->itsNumberOfRows == itsNumberOfRows)) {
+      itsPrefetchedChunk = itsReadAheadBuffer;
+  }
+  itsReadAheadBuffer.reset();
+}
+
 /// setup accessor for a new iteration of the table iterator
 void TableConstDataIterator::setUpIteration()
 {
-  itsCurrentIteration=itsTabIterator.table();
+  itsCurrentIteration = iterationTable(itsIterationStep);
   itsAccessor.invalidateIterationCaches();
+  // the chunks of this time step are slices of the runs of DATA_DESC_ID and FIELD_ID
+  itsDataDescRuns.clear();
+  itsFieldRuns.clear();
+  if (itsCurrentIteration.nrow()) {
+      itsDataDescRuns.assign(ROScalarColumn<Int>(itsCurrentIteration, "DATA_DESC_ID").getColumn());
+      if (itsUseFieldID) {
+          itsFieldRuns.assign(ROScalarColumn<Int>(itsCurrentIteration, "FIELD_ID").getColumn());
+      }
+  }
 
   itsNumberOfRows=itsCurrentIteration.nrow()<=itsMaxChunkSize ?
                   itsCurrentIteration.nrow() : itsMaxChunkSize;
@@ -307,8 +979,13 @@ void TableConstDataIterator::setUpIteration()
       // do nothing if itsUseFieldID is false
       makeUniformFieldID();
   } else {
+      itsNumberOfChannelBlocks = 1;
       itsNumberOfChannels = 0;
       itsNumberOfPols = 0;
+      itsPolStart = 0;
+      itsPolIncrement = 1;
+      itsNumberOfSelectedPols = 0;
+      itsPolConversion.reset();
       itsCurrentDataDescID = -100;
       itsCurrentFieldID = -100;
       itsDirectionCache.invalidate();
@@ -317,6 +994,70 @@ void TableConstDataIterator::setUpIteration()
       itsParallacticAngleCache.invalidate();
       itsDishPointingCache.invalidate();
   }
+  if (itsNumberOfRows) {
+      setUpChannelBlocks();
+  }
+}
+
+/// @brief build the iteration plan for the given table
+/// @details Rows are grouped into consecutive ranges with the same time stamp. The
+/// table is assumed to be in time order (no sorting is done), as for the table iterator
+/// used previously with the NoSort option.
+/// @param[in] tab selected table
+/// @return shared pointer to the plan
+boost::shared_ptr<TableSelectionCache::IterationPlan const>
+TableConstDataIterator::buildIterationPlan(const casacore::Table &tab)
+{
+  boost::shared_ptr<TableSelectionCache::IterationPlan> plan(new TableSelectionCache::IterationPlan);
+  if (tab.nrow() == 0) {
+      return plan;
+  }
+  const casacore::Vector<casacore::Double> times = ROScalarColumn<Double>(tab, "TIME").getColumn();
+  casacore::rownr_t start = 0;
+  for (casacore::rownr_t row = 1; row < times.nelements(); ++row) {
+       if (times[row] != times[start]) {
+           plan->push_back(std::make_pair(start, row - start));
+           start = row;
+       }
+  }
+  plan->push_back(std::make_pair(start, casacore::rownr_t(times.nelements()) - start));
+  return plan;
+}
+
+/// @brief obtain rows of the given iteration step
+/// @param[in] step index of the step in the iteration plan
+/// @return reference table with the rows of the step
+casacore::Table TableConstDataIterator::iterationTable(size_t step) const
+{
+  ASKAPDEBUGASSERT(itsIterationPlan);
+  if (step >= itsIterationPlan->size()) {
+      // empty selection
+      return itsSelectedTable;
+  }
+  const std::pair<casacore::rownr_t, casacore::rownr_t> &range = (*itsIterationPlan)[step];
+  if (range.first == 0 && range.second == itsSelectedTable.nrow()) {
+      return itsSelectedTable;
+  }
+  std::vector<casacore::rownr_t> rows(range.second);
+  for (casacore::rownr_t i = 0; i < range.second; ++i) {
+       rows[i] = range.first + i;
+  }
+  return itsSelectedTable(casacore::RowNumbers(rows));
+}
+
+/// @brief set up the number of channel blocks for the current chunk of rows
+/// @details This method is called every time the rows of the chunk change.
+void TableConstDataIterator::setUpChannelBlocks()
+{
+  ASKAPDEBUGASSERT(itsChannelBlock == 0);
+  itsNumberOfChannelBlocks = 1;
+  if (itsMaxChannelBlock > 0) {
+      const casacore::uInt nChan = getSelectedChannelRange().first;
+      itsNumberOfChannelBlocks = (nChan + itsMaxChannelBlock - 1) / itsMaxChannelBlock;
+      if (itsNumberOfChannelBlocks == 0) {
+          itsNumberOfChannelBlocks = 1;
+      }
+  }
 }
 
 /// @brief method ensures that the chunk has uniform DATA_DESC_ID
@@ -333,8 +1074,8 @@ void TableConstDataIterator::makeUniformDataDescID()
   ASKAPDEBUGASSERT(itsCurrentTopRow+itsNumberOfRows<=
                     itsCurrentIteration.nrow());
 
-  ROScalarColumn<Int> dataDescCol(itsCurrentIteration,"DATA_DESC_ID");
-  const Int newDataDescID=dataDescCol(itsCurrentTopRow);
+  const ColumnRuns::Run run = itsDataDescRuns.run(itsCurrentTopRow);
+  const Int newDataDescID = run.first;
   ASKAPDEBUGASSERT(newDataDescID>=0);
   if (itsCurrentDataDescID!=newDataDescID) {
       itsAccessor.invalidateSpectralCaches();
@@ -364,11 +1105,13 @@ void TableConstDataIterator::makeUniformDataDescID()
       itsNumberOfPols=shape[0];
       itsNumberOfChannels=shape.size()>1?shape[1]:1;
       ASKAPDEBUGASSERT(itsSelector);
+      setUpPolarisationSelection();
       if (itsSelector->channelsSelected()) {
           // validity checks that selection doesn't extend beyond the channels available
           const std::pair<int,int> chanSelection = itsSelector->getChannelSelection();
-          ASKAPCHECK(itsNumberOfChannels >= casacore::uInt(chanSelection.first + chanSelection.second),
-               "Channel selection from "<<chanSelection.second+1<<" to "<<chanSelection.first+
+          const int nChanToRead = chanSelection.first * int(itsSelector->getChannelAveraging());
+          ASKAPCHECK(itsNumberOfChannels >= casacore::uInt(nChanToRead + chanSelection.second),
+               "Channel selection from "<<chanSelection.second+1<<" to "<<nChanToRead+
                chanSelection.second<<" (1-based) extends beyond "<<itsNumberOfChannels<<
                " channel(s) available in  the dataset");
       }
@@ -380,12 +1123,65 @@ void TableConstDataIterator::makeUniformDataDescID()
       itsChannelsSelected = false;
   }
 
-  for (uInt row=1;row<itsNumberOfRows;++row) {
-       if (dataDescCol(row+itsCurrentTopRow)!=itsCurrentDataDescID) {
-           itsNumberOfRows=row;
-	   break;
+  // break the iteration at the end of the run
+  if (run.second - itsCurrentTopRow < itsNumberOfRows) {
+      itsNumberOfRows = casacore::uInt(run.second - itsCurrentTopRow);
+  }
+}
+
+/// @brief set up polarisations to read for the current DATA_DESC_ID
+/// @details If polarisations are selected, the requested products are located among
+/// the correlations stored in the table. Only those products are read from the table,
+/// if they form a strided subset of the stored correlations (e.g. XX,YY out of
+/// XX,XY,YX,YY). Otherwise, all stored correlations are read and converted into the
+/// requested products (see PolarisationConversion).
+void TableConstDataIterator::setUpPolarisationSelection()
+{
+  itsPolStart = 0;
+  itsPolIncrement = 1;
+  itsNumberOfSelectedPols = itsNumberOfPols;
+  itsPolConversion.reset();
+  ASKAPDEBUGASSERT(itsSelector);
+  if (!itsSelector->polarizationsSelected()) {
+      return;
+  }
+  const casacore::Vector<casacore::Stokes::StokesTypes> &wanted = itsSelector->getPolarizationSelection();
+  const casacore::Vector<casacore::Stokes::StokesTypes> stored = 
+            subtableInfo().getPolarisation().getTypes(currentPolID());
+  ASKAPCHECK(stored.nelements() == itsNumberOfPols, "Polarisation table describes "<<stored.nelements()<<
+             " products, the data column has "<<itsNumberOfPols);
+  std::vector<casacore::uInt> indices;
+  indices.reserve(wanted.nelements());
+  bool direct = true;
+  for (casacore::uInt i = 0; i < wanted.nelements() && direct; ++i) {
+       casacore::uInt index = 0;
+       while (index < stored.nelements() && stored[index] != wanted[i]) {
+              ++index;
+       }
+       if (index == stored.nelements()) {
+           direct = false;
        }
+       indices.push_back(index);
   }
+  ASKAPDEBUGASSERT(indices.size() > 0);
+  const casacore::uInt increment = indices.size() > 1 ? indices[1] - indices[0] : 1;
+  for (size_t i = 1; i < indices.size() && direct; ++i) {
+       if (indices[i] <= indices[i - 1] || indices[i] - indices[i - 1] != increment) {
+           direct = false;
+       }
+  }
+  if (!direct) {
+      // read all stored correlations and convert
+      if (!PolarisationConversion::canConvert(stored, wanted)) {
+          ASKAPTHROW(DataAccessLogicError, "Selected polarisation products can't be obtained from the "<<
+                     stored.nelements()<<" correlations stored in the dataset");
+      }
+      itsPolConversion.reset(new PolarisationConversion(stored, wanted));
+      return;
+  }
+  itsPolStart = indices[0];
+  itsPolIncrement = increment;
+  itsNumberOfSelectedPols = indices.size();
 }
 
 /// @brief method ensures that the chunk has a uniform FIELD_ID
@@ -402,8 +1198,8 @@ void TableConstDataIterator::makeUniformFieldID()
       ASKAPDEBUGASSERT(itsCurrentTopRow+itsNumberOfRows<=
                        itsCurrentIteration.nrow());
 
-      ROScalarColumn<Int> fieldIDCol(itsCurrentIteration,"FIELD_ID");
-      const Int newFieldID=fieldIDCol(itsCurrentTopRow);
+      const ColumnRuns::Run run = itsFieldRuns.run(itsCurrentTopRow);
+      const Int newFieldID = run.first;
       ASKAPDEBUGASSERT(newFieldID>=0);
       if (newFieldID != itsCurrentFieldID) {
           itsCurrentFieldID = newFieldID;
@@ -413,12 +1209,9 @@ void TableConstDataIterator::makeUniformFieldID()
           itsParallacticAngleCache.invalidate();
           itsDishPointingCache.invalidate();
       }
-      // break the iteration if necessary
-      for (uInt row=1;row<itsNumberOfRows;++row) {
-           if (fieldIDCol(row+itsCurrentTopRow)!=itsCurrentFieldID) {
-               itsNumberOfRows=row;
-	           break;
-           }
+      // break the iteration at the end of the run
+      if (run.second - itsCurrentTopRow < itsNumberOfRows) {
+          itsNumberOfRows = casacore::uInt(run.second - itsCurrentTopRow);
       }
   }
 }
@@ -434,52 +1227,12 @@ template<typename T>
 void TableConstDataIterator::fillCube(casacore::Cube<T> &cube,
                const std::string &columnName) const
 {
-  const casacore::uInt nChan = nChannel();
+  const casacore::uInt nChan = nChannelsToRead();
   const casacore::uInt startChan = startChannel();
 
-  // Setup a slicer to extract the specified channel range only
-  const Slicer chanSlicer(Slice(),Slice(startChan,nChan));
-
-  cube.resize(itsNumberOfRows, nChan, itsNumberOfPols);
-  ROArrayColumn<T> tableCol(itsCurrentIteration,columnName);
-
-  // helper class, which does nothing for visibility cube, but checks
-  // FLAG_ROW for flagging
-  WholeRowFlagger<T> wrFlagger(itsCurrentIteration);
-
-  // temporary buffer declared outside the loop
-  casacore::Matrix<T> buf(itsNumberOfPols, nChan);
-  for (uInt row=0; row<itsNumberOfRows; ++row) {
-       const casacore::IPosition shape = tableCol.shape(row);
-       ASKAPASSERT(shape.size() && (shape.size()<3));
-       const casacore::uInt thisRowNumberOfPols=shape[0];
-       const casacore::uInt thisRowNumberOfChannels = shape.size() > 1 ? shape[1] : 1;
-       if (thisRowNumberOfPols!=itsNumberOfPols) {
-           ASKAPTHROW(DataAccessError,"Number of polarizations is not "
-	               "conformant for row "<<row<<" of the "<<columnName<<
-	               "column");
-       }
-       if (thisRowNumberOfChannels!=itsNumberOfChannels) {
-           ASKAPTHROW(DataAccessError,"Number of channels is not "
-	               "conformant for row "<<row<<" of the "<<columnName<<
-	               "column");
-       }
-       // for now just copy. In the future we will pass this array through
-       // the transformation which will do averaging, selection,
-       // polarization conversion
-
-       if (wrFlagger.copyRequired(row + itsCurrentTopRow, cube)) {
-           // Extract slice for this row
-           tableCol.getSlice(row + itsCurrentTopRow, chanSlicer, buf, False);
-
-           // Copy the slice into the cube
-           for (uInt chan = 0; chan < nChan; ++chan) {
-               for (uInt pol = 0; pol < itsNumberOfPols; ++pol) {
-                   cube(row,chan,pol) = buf(pol,chan);
-               }
-           }
-       }
-  }
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+  readCube(itsCurrentIteration, itsCurrentTopRow, itsNumberOfRows, itsNumberOfPols,
+           polSlice(), itsNumberOfChannels, startChan, nChan, columnName, cube);
 }
 
 /// populate the buffer of visibilities with the values of current
@@ -488,7 +1241,58 @@ void TableConstDataIterator::fillCube(casacore::Cube<T> &cube,
 ///            cube to fill with the complex visibility data
 void TableConstDataIterator::fillVisibility(casacore::Cube<casacore::Complex> &vis) const
 {
-  fillCube(vis, getDataColumnName());
+  checkAccessorField(IDataSelector::VISIBILITY, "visibility");
+  if (itsPolConversion) {
+      casacore::Cube<casacore::Complex> storedVis;
+      fillStoredVisibility(storedVis, itsStoredVisibilityStorage);
+      itsVisibilityStorage.attach(vis, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPol()));
+      itsPolConversion->convertVisibility(storedVis, vis);
+  } else {
+      fillStoredVisibility(vis, itsVisibilityStorage);
+  }
+  updateVisibilityChecksum(vis);
+}
+
+/// @brief obtain visibilities for the stored polarisation products
+/// @details This is the body of fillVisibility, the cube has nPolToRead planes.
+/// @param[in] vis a reference to the nRow x nChannel x nPolToRead cube to fill
+/// @param[in] storage storage to attach the cube to, if it is filled from the table
+void TableConstDataIterator::fillStoredVisibility(casacore::Cube<casacore::Complex> &vis,
+                            HighWaterStorage<casacore::Complex> &storage) const
+{
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillVisibility");
+  if (itsPrefetchedChunk && itsPrefetchedChunk->itsVisibilityValid) {
+      ASKAPDEBUGASSERT(itsPrefetchedChunk->itsNChan == nChannel());
+      vis.reference(itsPrefetchedChunk->itsVisibility);
+      // the buffer is given away to the accessor
+      itsPrefetchedChunk->itsVisibility.reference(casacore::Cube<casacore::Complex>());
+      itsPrefetchedChunk->itsVisibilityValid = false;
+      // the chunk has been read in the background
+      timer.hit();
+  } else if (channelAveraging() > 1) {
+      // flagged channels are excluded from the average, noise gives the weights if it
+      // depends on the channel (otherwise all channels of the row have the same weight)
+      casacore::Cube<casacore::Complex> inVis;
+      casacore::Cube<casacore::Bool> inFlag;
+      casacore::Cube<casacore::Complex> inNoise;
+      {
+        boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+        fillCube(inVis, getDataColumnName());
+        fillCube(inFlag, "FLAG");
+        if (table().actualTableDesc().isColumn("SIGMA_SPECTRUM")) {
+            inNoise.resize(inVis.shape());
+            readNoise(inNoise, startChannel(), nChannelsToRead());
+        }
+      }
+      storage.attach(vis, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPolToRead()));
+      ChannelAverager::averageVisibility(inVis, inFlag, inNoise, channelAveraging(), vis);
+      timer.miss();
+  } else {
+      storage.attach(vis, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPolToRead()));
+      fillCube(vis, getDataColumnName());
+      timer.miss();
+  }
+  timer.addBytes(vis.nelements() * sizeof(casacore::Complex));
 }
 
 /// @brief read flagging information
@@ -499,10 +1303,254 @@ void TableConstDataIterator::fillVisibility(casacore::Cube<casacore::Complex> &v
 ///            bool type)
 void TableConstDataIterator::fillFlag(casacore::Cube<casacore::Bool> &flag) const
 {
-  fillCube(flag,"FLAG");
+  checkAccessorField(IDataSelector::FLAG, "flag");
+  if (itsPolConversion) {
+      casacore::Cube<casacore::Bool> storedFlag;
+      fillStoredFlag(storedFlag, itsStoredFlagStorage);
+      itsFlagStorage.attach(flag, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPol()));
+      itsPolConversion->convertFlag(storedFlag, flag);
+  } else {
+      fillStoredFlag(flag, itsFlagStorage);
+  }
   if (itsFlagData) {
       flag = true;
   }
+  updateFlagChecksum(flag);
+  updateChunkSummary(flag);
+}
+
+/// @brief obtain flags for the stored polarisation products
+/// @details This is the body of fillFlag, the cube has nPolToRead planes.
+/// @param[in] flag a reference to the nRow x nChannel x nPolToRead cube to fill
+/// @param[in] storage storage to attach the cube to, if it is filled from the table
+void TableConstDataIterator::fillStoredFlag(casacore::Cube<casacore::Bool> &flag,
+                                            HighWaterStorage<casacore::Bool> &storage) const
+{
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillFlag");
+  if (itsPrefetchedChunk && itsPrefetchedChunk->itsFlagValid) {
+      ASKAPDEBUGASSERT(itsPrefetchedChunk->itsNChan == nChannel());
+      flag.reference(itsPrefetchedChunk->itsFlag);
+      // the buffer is given away to the accessor
+      itsPrefetchedChunk->itsFlag.reference(casacore::Cube<casacore::Bool>());
+      itsPrefetchedChunk->itsFlagValid = false;
+      timer.hit();
+  } else if (channelAveraging() > 1) {
+      casacore::Cube<casacore::Bool> inFlag;
+      fillCube(inFlag, "FLAG");
+      storage.attach(flag, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPolToRead()));
+      ChannelAverager::averageFlag(inFlag, channelAveraging(), flag);
+      timer.miss();
+  } else {
+      storage.attach(flag, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPolToRead()));
+      fillCube(flag,"FLAG");
+      timer.miss();
+  }
+  timer.addBytes(flag.nelements() * sizeof(casacore::Bool));
+}
+
+/// @brief enable checksums of the data delivered by this iterator
+/// @details If enabled, the checksums of the visibility and flag cubes are computed
+/// when the cubes are filled for each chunk and added to the aggregator given here.
+/// An empty shared pointer disables checksums.
+/// @param[in] aggregator object collecting checksums of all chunks
+void TableConstDataIterator::setChecksumAggregator(const boost::shared_ptr<DataChecksumAggregator> &aggregator)
+{
+  itsChecksumAggregator = aggregator;
+  itsVisibilityChecksumValid = false;
+  itsFlagChecksumValid = false;
+}
+
+/// @brief collect chunk summaries
+/// @details If a map is given, the summary of each chunk is added to it when the flags
+/// are filled, provided the iterator reads all rows, channels and polarisations of the
+/// measurement set. An empty shared pointer disables summaries.
+/// @param[in] map object collecting summaries of all chunks
+void TableConstDataIterator::setChunkSummaryMap(const boost::shared_ptr<ChunkSummaryMap> &map)
+{
+  itsChunkSummaryMap = map;
+  itsChunkSummaryAdded = false;
+}
+
+/// @brief summary of the time stamp of the current chunk
+/// @details The summary covers all rows of the measurement set with the time stamp of
+/// the current chunk, regardless of the selection.
+/// @param[out] summary summary of the current time stamp (unchanged if not available)
+/// @return true, if the summary is available
+bool TableConstDataIterator::currentChunkSummary(ChunkSummary &summary) const
+{
+  if (!itsChunkSummaryMap || (nRow() == 0)) {
+      return false;
+  }
+  casacore::Double time = 0.;
+  {
+    boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+    time = casacore::ROScalarColumn<casacore::Double>(itsCurrentIteration, "TIME")(itsCurrentTopRow);
+  }
+  return itsChunkSummaryMap->find(time, summary);
+}
+
+/// @brief set the allocation policy for the cubes of this iterator
+/// @details An empty shared pointer means the global heap.
+/// @param[in] allocator shared pointer to the allocator
+void TableConstDataIterator::setArrayAllocator(const boost::shared_ptr<ArrayAllocator const> &allocator)
+{
+  itsArrayAllocator = allocator;
+  itsVisibilityStorage.setAllocator(allocator);
+  itsFlagStorage.setAllocator(allocator);
+  itsNoiseStorage.setAllocator(allocator);
+  itsUVWStorage.setAllocator(allocator);
+}
+
+/// @brief set the placement policy for the background threads of this iterator
+/// @param[in] affinity placement policy
+void TableConstDataIterator::setThreadAffinity(const ThreadAffinity &affinity)
+{
+  waitForReadAhead();
+  itsThreadAffinity = affinity;
+}
+
+/// @brief enable caching of rotated uvws and delays across iterations
+/// @details An empty shared pointer disables caching.
+/// @param[in] cache shared pointer to the cache
+void TableConstDataIterator::setRotatedUVWCache(const boost::shared_ptr<RotatedUVWCache> &cache)
+{
+  itsRotatedUVWCache = cache;
+  itsRotatedUVWKeyValid = false;
+  itsAccessor.setRotatedUVWCache(cache);
+}
+
+/// @brief compute uvw from antenna positions
+/// @details If enabled, uvw are not read from the UVW column, but computed from the
+/// antenna positions, the phase centre and the epoch.
+/// @param[in] enable true to compute uvw, false to read them from the UVW column (default)
+void TableConstDataIterator::setComputedUVW(bool enable)
+{
+  itsComputedUVW = enable;
+}
+
+/// @brief obtain the key identifying rows of the current chunk for the rotated uvw cache
+/// @details The key includes the selection, the first row in the root table and the
+/// number of rows. It is computed once per chunk.
+/// @return key string, empty if rotated uvw caching is disabled
+std::string TableConstDataIterator::rotatedUVWKey() const
+{
+  if (!itsRotatedUVWCache) {
+      return std::string();
+  }
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+  if (!itsRotatedUVWKeyValid) {
+      casacore::rownr_t firstRow = 0;
+      if (nRow() > 0) {
+          // row numbers in the root table
+          firstRow = getCurrentIteration().rowNumbers()[getCurrentTopRow()];
+      }
+      std::ostringstream os;
+      os<<getSelectionKey()<<":"<<firstRow<<":"<<nRow();
+      itsRotatedUVWKey = os.str();
+      itsRotatedUVWKeyValid = true;
+  }
+  return itsRotatedUVWKey;
+}
+
+/// @brief checksum of the visibility cube delivered for the current chunk
+/// @return checksum of the visibility cube
+casacore::uInt64 TableConstDataIterator::visibilityChecksum() const
+{
+  if (!itsVisibilityChecksumValid) {
+      ASKAPTHROW(DataAccessLogicError, "Visibility checksum is not available for the current chunk, "
+                 "checksums should be enabled and visibilities accessed first");
+  }
+  return itsVisibilityChecksum;
+}
+
+/// @brief checksum of the flag cube delivered for the current chunk
+/// @return checksum of the flag cube
+casacore::uInt64 TableConstDataIterator::flagChecksum() const
+{
+  if (!itsFlagChecksumValid) {
+      ASKAPTHROW(DataAccessLogicError, "Flag checksum is not available for the current chunk, "
+                 "checksums should be enabled and flags accessed first");
+  }
+  return itsFlagChecksum;
+}
+
+/// @brief compute checksum of the visibility cube delivered for the current chunk
+/// @details Does nothing if checksums are disabled or the checksum has already been
+/// computed for the current chunk.
+/// @param[in] vis visibility cube
+void TableConstDataIterator::updateVisibilityChecksum(const casacore::Cube<casacore::Complex> &vis) const
+{
+  if (itsChecksumAggregator && !itsVisibilityChecksumValid) {
+      // distinct seeds ensure visibilities and flags don't give the same contribution
+      DataChecksum checksum(1);
+      checksum.update(vis);
+      itsVisibilityChecksum = checksum.value();
+      itsVisibilityChecksumValid = true;
+      itsChecksumAggregator->add(itsVisibilityChecksum, checksum.nBytes());
+  }
+}
+
+/// @brief compute checksum of the flag cube delivered for the current chunk
+/// @details Does nothing if checksums are disabled or the checksum has already been
+/// computed for the current chunk.
+/// @param[in] flag flag cube
+void TableConstDataIterator::updateFlagChecksum(const casacore::Cube<casacore::Bool> &flag) const
+{
+  if (itsChecksumAggregator && !itsFlagChecksumValid) {
+      DataChecksum checksum(2);
+      checksum.update(flag);
+      itsFlagChecksum = checksum.value();
+      itsFlagChecksumValid = true;
+      itsChecksumAggregator->add(itsFlagChecksum, checksum.nBytes());
+  }
+}
+
+/// @brief add summary of the current chunk to the chunk summary map
+/// @details Does nothing if summaries are disabled, the selection doesn't cover the whole
+/// measurement set or the summary has already been added for the current chunk.
+/// @param[in] flag flag cube
+void TableConstDataIterator::updateChunkSummary(const casacore::Cube<casacore::Bool> &flag) const
+{
+  if (!itsChunkSummaryMap || itsChunkSummaryAdded || (nRow() == 0)) {
+      return;
+  }
+  // only passes over all rows and all spectral samples give summaries valid for any selection
+  ASKAPDEBUGASSERT(itsSelector);
+  if (itsSelector->getSelectionKey().size() || itsFlagData || (channelAveraging() != 1) ||
+      (startChannel() != 0) || (nChannelsToRead() != itsNumberOfChannels) ||
+      (itsNumberOfSelectedPols != itsNumberOfPols) || itsPolConversion) {
+      return;
+  }
+  ChunkSummary summary;
+  summary.itsFieldID = int(currentFieldID());
+  summary.itsNRow = nRow();
+  summary.itsNSamples = flag.nelements();
+  summary.itsNFlagged = casacore::uInt64(casacore::ntrue(flag));
+  casacore::Double time = 0.;
+  casacore::rownr_t firstRow = 0;
+  casacore::rownr_t rowsInTimeStamp = 0;
+  {
+    boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+    time = casacore::ROScalarColumn<casacore::Double>(itsCurrentIteration, "TIME")(itsCurrentTopRow);
+    firstRow = itsCurrentIteration.rowNumbers()[itsCurrentTopRow];
+    rowsInTimeStamp = itsCurrentIteration.nrow();
+    const casacore::Slicer rows(casacore::IPosition(1, itsCurrentTopRow), casacore::IPosition(1, nRow()),
+                                casacore::Slicer::endIsLength);
+    const casacore::Matrix<casacore::Double> uvw =
+          casacore::ROArrayColumn<casacore::Double>(itsCurrentIteration, "UVW").getColumnRange(rows);
+    ASKAPDEBUGASSERT(uvw.ncolumn() == nRow());
+    for (casacore::uInt row = 0; row < nRow(); ++row) {
+         const double uvDist = std::sqrt(uvw(0, row) * uvw(0, row) + uvw(1, row) * uvw(1, row));
+         summary.itsMinUVDistance = std::min(summary.itsMinUVDistance, uvDist);
+         summary.itsMaxUVDistance = std::max(summary.itsMaxUVDistance, uvDist);
+         summary.itsMinW = std::min(summary.itsMinW, uvw(2, row));
+         summary.itsMaxW = std::max(summary.itsMaxW, uvw(2, row));
+    }
+  }
+  summary.itsStartTime = time;
+  summary.itsEndTime = time;
+  itsChunkSummaryMap->add(time, firstRow, rowsInTimeStamp, summary);
+  itsChunkSummaryAdded = true;
 }
 
 /// populate the buffer of noise figures with the values of current
@@ -510,20 +1558,64 @@ void TableConstDataIterator::fillFlag(casacore::Cube<casacore::Bool> &flag) cons
 /// @param[in] noise a reference to the nRow x nChannel x nPol buffer
 ///            cube to be filled with the noise figures
 void TableConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise) const
+{
+  checkAccessorField(IDataSelector::NOISE, "noise");
+  if (itsPolConversion) {
+      casacore::Cube<casacore::Complex> storedNoise;
+      fillStoredNoise(storedNoise, itsStoredNoiseStorage);
+      itsNoiseStorage.attach(noise, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPol()));
+      itsPolConversion->convertNoise(storedNoise, noise);
+  } else {
+      fillStoredNoise(noise, itsNoiseStorage);
+  }
+}
+
+/// @brief obtain noise for the stored polarisation products
+/// @details This is the body of fillNoise, the cube has nPolToRead planes.
+/// @param[in] noise a reference to the nRow x nChannel x nPolToRead cube to fill
+/// @param[in] storage storage to attach the cube to
+void TableConstDataIterator::fillStoredNoise(casacore::Cube<casacore::Complex> &noise,
+                                             HighWaterStorage<casacore::Complex> &storage) const
 {
   ASKAPDEBUGASSERT(itsSelector);
-  const casacore::uInt nChan = nChannel();
-  const casacore::uInt startChan = startChannel();
+  const casacore::uInt nAvg = channelAveraging();
+
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillNoise");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+  if (nAvg > 1) {
+      // the noise of the average depends on which channels are flagged
+      casacore::Cube<casacore::Complex> inNoise(itsNumberOfRows, nChannelsToRead(), nPolToRead());
+      readNoise(inNoise, startChannel(), nChannelsToRead());
+      casacore::Cube<casacore::Bool> inFlag;
+      fillCube(inFlag, "FLAG");
+      storage.attach(noise, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPolToRead()));
+      ChannelAverager::averageNoise(inNoise, inFlag, nAvg, noise);
+  } else {
+      storage.attach(noise, casacore::IPosition(3, itsNumberOfRows, nChannel(), nPolToRead()));
+      readNoise(noise, startChannel(), nChannel());
+  }
+  timer.addBytes(noise.nelements() * sizeof(casacore::Complex));
+}
 
-  // default action first - just resize the cube and assign 1.
-  noise.resize(itsNumberOfRows, nChan, itsNumberOfPols);
+/// @brief read noise from the table
+/// @details This is the body of fillNoise. The table mutex should be locked by the caller.
+/// @param[in] noise a reference to the nRow x nChan x nPol cube to fill
+///            (it should already have the right shape)
+/// @param[in] startChan first channel to read
+/// @param[in] nChan number of channels to read
+void TableConstDataIterator::readNoise(casacore::Cube<casacore::Complex> &noise, casacore::uInt startChan,
+                                       casacore::uInt nChan) const
+{
+  ASKAPDEBUGASSERT((noise.nrow() == itsNumberOfRows) && (noise.ncolumn() == nChan) &&
+                   (noise.nplane() == nPolToRead()));
+  // default action first - just assign 1.
   noise.set(casacore::Complex(1.,1.));
   // if the sigma spectrum exists, use those sigmas to fill the noise cube
   if (table().actualTableDesc().isColumn("SIGMA_SPECTRUM")) {
       // noise is given per channel and polarisation
       // Setup a slicer to extract the specified channel range only
-      const Slicer chanSlicer(Slice(),Slice(startChan,nChan));
-      casa::Matrix<Float> buf(itsNumberOfPols,nChan);
+      const Slicer chanSlicer(polSlice(),Slice(startChan,nChan));
+      casa::Matrix<Float> buf(nPolToRead(),nChan);
       ROArrayColumn<Float> sigmaCol(itsCurrentIteration,"SIGMA_SPECTRUM");
       for (uInt row = 0; row<itsNumberOfRows; ++row) {
 #ifdef ASKAP_DEBUG
@@ -536,7 +1628,7 @@ void TableConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise)
 
            // SIGMA_SPECTRUM is ordered (pol,chan), so need to transpose
            for (casa::uInt chan=0; chan<nChan; chan++) {
-                for (casa::uInt pol=0; pol<itsNumberOfPols; pol++) {
+                for (casa::uInt pol=0; pol<nPolToRead(); pol++) {
                      // same noise for both real and imaginary parts
                      const casa::Float val = buf(pol,chan);
                      noise(row,chan,pol) = casa::Complex(val,val);
@@ -560,10 +1652,10 @@ void TableConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise)
                for (uInt chan = 0; chan< nChan; ++chan) {
                     //ASKAPDEBUGASSERT(chan< slice.nrow());
                     //casacore::Vector<casacore::Complex> polNoise = slice.row(chan);
-                    for (casacore::uInt pol=0; pol<itsNumberOfPols; ++pol) {
+                    for (casacore::uInt pol=0; pol<nPolToRead(); ++pol) {
                          //ASKAPDEBUGASSERT(pol<buf.nelements());
                          // same polarisation for both real and imaginary parts
-                         const casacore::Float val = buf(pol);
+                         const casacore::Float val = buf(polIndex(pol));
                          noise(row,chan,pol) = casacore::Complex(val,val);
                     }
                }
@@ -587,9 +1679,9 @@ void TableConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise)
                for (casacore::uInt x=0; x<rowNoise.nrow(); ++x) {
                     for (casacore::uInt y=0; y<rowNoise.ncolumn(); ++y) {
                          ASKAPDEBUGASSERT(x<inVals.nrow());
-                         ASKAPDEBUGASSERT(y<inVals.ncolumn());
+                         ASKAPDEBUGASSERT(polIndex(y)<inVals.ncolumn());
                          // same polarisation for both real and imaginary parts
-                         const casacore::Float val = inVals(x,y);
+                         const casacore::Float val = inVals(x,polIndex(y));
                          rowNoise(x,y) = casacore::Complex(val,val);
                     }
                }
@@ -598,26 +1690,103 @@ void TableConstDataIterator::fillNoise(casacore::Cube<casacore::Complex> &noise)
   } // if-statement checking that SIGMA column is present
 }
 
+/// @brief populate the compact noise representation
+/// @details Noise given per row and polarisation (i.e. SIGMA column or SIGMA_SPECTRUM
+/// constant across the spectral axis) is stored without expanding it into a cube.
+/// Otherwise, the full cube is stored (via fillNoise).
+/// @param[in] noise a reference to the compact noise object to fill
+void TableConstDataIterator::fillCompactNoise(CompactNoise &noise) const
+{
+  checkAccessorField(IDataSelector::NOISE, "noise");
+  if (channelAveraging() > 1) {
+      // noise of the averaged channels depends on flags, which vary along the spectral axis
+      casacore::Cube<casacore::Complex> fullNoise;
+      fillNoise(fullNoise);
+      noise.assign(fullNoise);
+      return;
+  }
+  const casacore::uInt nChan = nChannel();
+  const casacore::uInt startChan = startChannel();
+
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillCompactNoise");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+  // same default as in fillNoise
+  casacore::Matrix<casacore::Float> sigma(itsNumberOfRows, nPolToRead(), 1.);
+  bool separable = true;
+  if (table().actualTableDesc().isColumn("SIGMA_SPECTRUM")) {
+      const Slicer chanSlicer(polSlice(),Slice(startChan,nChan));
+      casa::Matrix<Float> buf(nPolToRead(),nChan);
+      ROArrayColumn<Float> sigmaCol(itsCurrentIteration,"SIGMA_SPECTRUM");
+      for (uInt row = 0; row<itsNumberOfRows && separable; ++row) {
+           sigmaCol.getSlice(row+itsCurrentTopRow,chanSlicer,buf,False);
+           for (casa::uInt pol=0; pol<nPolToRead() && separable; ++pol) {
+                const casa::Float val = nChan > 0 ? buf(pol,0) : 1.;
+                for (casa::uInt chan=1; chan<nChan; ++chan) {
+                     if (buf(pol,chan) != val) {
+                         separable = false;
+                         break;
+                     }
+                }
+                sigma(row,pol) = val;
+           }
+      }
+  } else if (table().actualTableDesc().isColumn("SIGMA")) {
+      ROArrayColumn<Float> sigmaCol(itsCurrentIteration,"SIGMA");
+      casacore::Vector<Float> buf(itsNumberOfPols);
+      for (uInt row = 0; row<itsNumberOfRows; ++row) {
+           const casacore::IPosition shape = sigmaCol.shape(row);
+           if (shape.size() != 1) {
+               // noise depends on the spectral channel
+               separable = false;
+               break;
+           }
+           ASKAPDEBUGASSERT(shape[0] == casacore::Int(itsNumberOfPols));
+           sigmaCol.get(row+itsCurrentTopRow,buf,False);
+           for (casacore::uInt pol=0; pol<nPolToRead(); ++pol) {
+                sigma(row,pol) = buf(polIndex(pol));
+           }
+      }
+  }
+  if (separable) {
+      if (itsPolConversion) {
+          casacore::Matrix<casacore::Float> converted;
+          itsPolConversion->convertSigma(sigma, converted);
+          sigma.reference(converted);
+      }
+      noise.assign(sigma, nChan);
+      timer.addBytes(sigma.nelements() * sizeof(casacore::Float));
+  } else {
+      casacore::Cube<casacore::Complex> fullNoise;
+      fillNoise(fullNoise);
+      noise.assign(fullNoise);
+  }
+}
+
 /// populate the buffer with uvw
 /// @param[in] uvw a reference to vector of rigid vectors (3 elemets,
 ///            u,v and w for each row) to fill
-void TableConstDataIterator::fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&uvw) const
+void TableConstDataIterator::fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&uvw,
+                                     UVWBounds &bounds) const
 {
-  uvw.resize(itsNumberOfRows);
-
-  ROArrayColumn<Double> uvwCol(itsCurrentIteration,"UVW");
-  // temporary buffer
-  Vector<Double> buf(3);
-  for (uInt row=0;row<itsNumberOfRows;++row) {
-#ifdef ASKAP_DEBUG
-       const casacore::IPosition shape=uvwCol.shape(row);
-       ASKAPDEBUGASSERT(shape.size()==1);
-       ASKAPDEBUGASSERT(shape[0]==3);
-#endif // ASKAP_DEBUG
-       // extract data record for this row, no resizing
-       uvwCol.get(row+itsCurrentTopRow,buf,False);
-       uvw(row) = buf;
+  checkAccessorField(IDataSelector::UVW, "uvw");
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillUVW");
+  if (itsPrefetchedChunk && itsPrefetchedChunk->itsUVWValid) {
+      uvw.reference(itsPrefetchedChunk->itsUVW);
+      bounds = itsPrefetchedChunk->itsUVWBounds;
+      // the buffer is given away to the accessor
+      itsPrefetchedChunk->itsUVW.reference(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >());
+      itsPrefetchedChunk->itsUVWValid = false;
+      timer.hit();
+  } else if (itsComputedUVW) {
+      computeUVW(uvw, bounds);
+      timer.miss();
+  } else {
+      boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+      itsUVWStorage.attach(uvw, casacore::IPosition(1, itsNumberOfRows));
+      readUVW(itsCurrentIteration, itsCurrentTopRow, itsNumberOfRows, uvw, bounds);
+      timer.miss();
   }
+  timer.addBytes(uvw.nelements() * sizeof(casacore::RigidVector<casacore::Double, 3>));
 }
 
 /// @brief obtain a current spectral window ID
@@ -679,6 +1848,24 @@ const casacore::MDirection& TableConstDataIterator::getCurrentReferenceDir() con
 /// @return a pair, first element is the number of channels, second is the first channel
 /// in the full cube
 std::pair<casacore::uInt, casacore::uInt> TableConstDataIterator::getChannelRange() const
+{
+  const std::pair<casacore::uInt, casacore::uInt> selection = getSelectedChannelRange();
+  if (itsMaxChannelBlock == 0) {
+      return selection;
+  }
+  const casacore::uInt offset = itsChannelBlock * itsMaxChannelBlock;
+  ASKAPDEBUGASSERT((offset < selection.first) || (offset == 0));
+  const casacore::uInt nChan = selection.first - offset > itsMaxChannelBlock ?
+                               itsMaxChannelBlock : selection.first - offset;
+  return std::pair<casacore::uInt, casacore::uInt>(nChan, selection.second + offset);
+}
+
+/// @brief obtain the full range of selected channels
+/// @details Unlike getChannelRange, this method ignores splitting of the spectral
+/// axis into blocks (see maxChannelBlock parameter of the constructor).
+/// @return a pair, first element is the number of channels, second is the first channel
+/// in the full cube
+std::pair<casacore::uInt, casacore::uInt> TableConstDataIterator::getSelectedChannelRange() const
 {
   ASKAPDEBUGASSERT(itsSelector);
   if (!itsChannelsSelected) {
@@ -686,8 +1873,7 @@ std::pair<casacore::uInt, casacore::uInt> TableConstDataIterator::getChannelRang
 
       if (itsSelector->frequenciesSelected()) {
           const std::tuple<int,casacore::MFrequency,double> freqSel = itsSelector->getFrequencySelection();
-          // cannot do multiple channels yet
-          ASKAPCHECK(std::get<0>(freqSel)<=1, "Can only do a single channel in frequency selection mode");
+          const casacore::uInt nChanOut = casacore::uInt(std::get<0>(freqSel));
           // convert frequency in requested frame to MS frame
           // Using antenna 0 and antenna pointing (= field direction) as reference (or direction ref in MFrequency)
           // Note this differs from imager which uses current phase centre direction in freq conversion
@@ -715,23 +1901,43 @@ std::pair<casacore::uInt, casacore::uInt> TableConstDataIterator::getChannelRang
           // assuming linear freq scale
           itsNumberOfChannelsSelected = 1;
           itsStartChannelSelected = 0;
+          itsChannelAveraging = 1;
           const uint nFreq = dataFreqs.nelements();
           if (nFreq > 1) {
               const double freqInc = dataFreqs(1) - dataFreqs(0);
               ASKAPDEBUGASSERT(freqInc != 0);
               ASKAPCHECK(abs((dataFreqs(nFreq-1)-dataFreqs(0))/((nFreq-1)*freqInc)-1)<0.001,
                 "Frequency axis non-linear, cannot do frequency selection with current code");
-              const double channel = (requiredFreq - dataFreqs(0)) / freqInc;
+              // coarser increment means averaging of adjacent channels
+              const double requiredInc = std::get<2>(freqSel);
+              if (requiredInc != 0.) {
+                  const double ratio = requiredInc / freqInc;
+                  itsChannelAveraging = casacore::uInt(std::lrint(ratio));
+                  ASKAPCHECK((ratio > 0.) && (itsChannelAveraging >= 1) &&
+                             (std::abs(ratio - itsChannelAveraging) < 0.01),
+                     "Frequency increment of "<<requiredInc<<" Hz should be a positive multiple of the " <<
+                     "channel width ("<<freqInc<<" Hz) in frequency selection mode");
+              }
+              itsNumberOfChannelsSelected = nChanOut * itsChannelAveraging;
+              ASKAPCHECK(itsNumberOfChannelsSelected <= nFreq, "Frequency selection of "<<nChanOut<<
+                     " channel(s) averaged by "<<itsChannelAveraging<<" requires more than "<<nFreq<<
+                     " channel(s) available in the dataset");
+              // the requested frequency is the centre of the first output channel
+              const double channel = (requiredFreq - dataFreqs(0)) / freqInc -
+                                     0.5 * (itsChannelAveraging - 1);
               // for now just use nearest channel, but could do linear interpolation between nearest two
               const int nearestChannel = std::lrint(channel);
-              if (nearestChannel >= 0 && nearestChannel < nFreq) {
+              if (nearestChannel >= 0 && nearestChannel + itsNumberOfChannelsSelected <= nFreq) {
                   itsStartChannelSelected = (uint)nearestChannel;
                   itsFlagData = false;
               } else {
-                  if (nearestChannel >= nFreq) {
-                      itsStartChannelSelected = nFreq - 1;
+                  if (nearestChannel > 0) {
+                      itsStartChannelSelected = nFreq - itsNumberOfChannelsSelected;
                   }
               }
+          } else {
+              ASKAPCHECK(nChanOut <= 1, "Frequency selection of "<<nChanOut<<
+                     " channels requested, dataset has a single channel");
           }
       } else {
           const std::pair<int, int> chanSelection = itsSelector->getChannelSelection();
@@ -739,37 +1945,63 @@ std::pair<casacore::uInt, casacore::uInt> TableConstDataIterator::getChannelRang
                                    casacore::uInt(chanSelection.first) : itsNumberOfChannels;
           itsStartChannelSelected = itsSelector->channelsSelected() ?
                                    casacore::uInt(chanSelection.second) : 0;
+          itsChannelAveraging = itsSelector->channelsSelected() ? itsSelector->getChannelAveraging() : 1;
+          itsNumberOfChannelsSelected *= itsChannelAveraging;
           ASKAPDEBUGASSERT(itsNumberOfChannelsSelected + itsStartChannelSelected <= itsNumberOfChannels);
           itsFlagData = false;
       }
+      ASKAPCHECK(itsMaxChannelBlock % itsChannelAveraging == 0, "Channel block of "<<itsMaxChannelBlock<<
+                 " channels should be a multiple of the number of channels averaged ("<<
+                 itsChannelAveraging<<")");
       itsChannelsSelected = true;
   }
 
   return std::pair<casacore::uInt, casacore::uInt>(itsNumberOfChannelsSelected,itsStartChannelSelected);
 }
 
+/// @brief number of adjacent channels averaged into one output channel
+/// @details The channel range (see getChannelRange) is given in the input channels,
+/// the accessor has this number of times fewer channels.
+/// @return averaging factor, 1 means no averaging
+casacore::uInt TableConstDataIterator::channelAveraging() const
+{
+  getSelectedChannelRange();
+  ASKAPDEBUGASSERT(itsChannelAveraging > 0);
+  return itsChannelAveraging;
+}
+
 /// @brief fill the buffer with the polarisation types
 /// @param[in] stokes a reference to a vector to be filled
 void TableConstDataIterator::fillStokes(casacore::Vector<casacore::Stokes::StokesTypes> &stokes) const
 {
+  checkAccessorField(IDataSelector::STOKES, "stokes");
+  if (itsPolConversion) {
+      stokes = itsPolConversion->outputTypes().copy();
+      return;
+  }
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   const ITablePolarisationHolder& polSubtable = subtableInfo().getPolarisation();
 
   ASKAPDEBUGASSERT(itsCurrentDataDescID>=0);
   const casacore::uInt polID = currentPolID();
-  ASKAPASSERT(polSubtable.nPol(polID) == nPol());
-  stokes = polSubtable.getTypes(polID).copy();
+  ASKAPASSERT(polSubtable.nPol(polID) == itsNumberOfPols);
+  const casacore::Vector<casacore::Stokes::StokesTypes> allTypes = polSubtable.getTypes(polID);
+  stokes = allTypes(polSlice()).copy();
 }
 
 /// populate the buffer with frequencies
 /// @param[in] freq a reference to a vector to fill
 void TableConstDataIterator::fillFrequency(casacore::Vector<casacore::Double> &freq) const
 {
+  checkAccessorField(IDataSelector::FREQUENCY, "frequency");
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillFrequency");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   ASKAPDEBUGASSERT(itsConverter);
   const ITableSpWindowHolder& spWindowSubtable=subtableInfo().getSpWindow();
   ASKAPDEBUGASSERT(itsCurrentDataDescID>=0);
   const casacore::uInt spWindowID = currentSpWindowID();
 
-  const casacore::uInt nChan = nChannel();
+  const casacore::uInt nChan = nChannelsToRead();
   const casacore::uInt startChan = startChannel();
 
   // for the time being we don't do the short-cut if a subset of channels
@@ -778,10 +2010,12 @@ void TableConstDataIterator::fillFrequency(casacore::Vector<casacore::Double> &f
   // operation.
   if (itsConverter->isVoid(spWindowSubtable.getReferenceFrame(spWindowID),
 	                   spWindowSubtable.getFrequencyUnit()) && !itsSelector->channelsSelected()
-                       && !itsSelector->frequenciesSelected()) {
+                       && !itsSelector->frequenciesSelected() && (itsNumberOfChannelBlocks == 1)) {
       // the conversion is void, i.e. table units/frame are exactly what
       // we need for output. This simplifies things a lot.
       freq.reference(spWindowSubtable.getFrequencies(spWindowID));
+      // no conversion is required, the axis is taken from the subtable handler
+      timer.hit();
       if (itsNumberOfChannels!=freq.nelements()) {
           ASKAPTHROW(DataAccessError,"The measurement set has bad or corrupted "<<
 	      "SPECTRAL_WINDOW subtable. The number of spectral channels for data "<<
@@ -801,20 +2035,30 @@ void TableConstDataIterator::fillFrequency(casacore::Vector<casacore::Double> &f
       // currently use the position of the first antenna for convertion.
       // we may need some average position + a check that they are close
       // enough to throw an exception if someone gives a VLBI measurement set.
-      itsConverter->setMeasFrame(casacore::MeasFrame(epoch, subtableInfo().
-                     getAntenna().getPosition(0), antReferenceDir));
-
-      freq.resize(nChan);
+      const casacore::Vector<casacore::Double> &allFreqs = spWindowSubtable.getFrequencies(spWindowID);
+      ASKAPDEBUGASSERT(startChan + nChan <= allFreqs.nelements());
+      casacore::Vector<casacore::Double> chanFreqs(nChan);
       for (uInt ch=0;ch<nChan;++ch) {
-           freq[ch]=itsConverter->frequency(spWindowSubtable.getFrequency(
-	                                    spWindowID,ch+startChan));
+           chanFreqs[ch] = allFreqs[ch+startChan];
       }
+      if (channelAveraging() > 1) {
+          chanFreqs.reference(ChannelAverager::averageFrequency(chanFreqs, channelAveraging()));
+      }
+      // the whole axis is converted at once, the converter may reuse the
+      // result for nearby epochs if the tolerance is set
+      itsConverter->frequencies(casacore::Int(spWindowID), chanFreqs,
+                     spWindowSubtable.getReferenceFrame(spWindowID),
+                     spWindowSubtable.getFrequencyUnit(), epoch,
+                     subtableInfo().getAntenna().getPosition(0), antReferenceDir, freq);
+      timer.miss();
   }
+  timer.addBytes(freq.nelements() * sizeof(casacore::Double));
 }
 
 /// @return the time stamp
 casacore::Double TableConstDataIterator::getTime() const
 {
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   // add additional checks in debug mode
   #ifdef ASKAP_DEBUG
    ROScalarColumn<Double> timeCol(itsCurrentIteration,"TIME");
@@ -834,10 +2078,50 @@ casacore::Double TableConstDataIterator::getTime() const
 }
 
 
+/// @brief compute uvw from antenna positions
+/// @details This helper does the actual work for fillUVW if uvws are computed
+/// (see setComputedUVW).
+/// @param[in] uvw a reference to vector of rigid vectors to fill
+/// @param[in] bounds a reference to the bounding box of uvw to fill
+void TableConstDataIterator::computeUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                                        UVWBounds &bounds) const
+{
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+  if (!itsUVWCalculator) {
+      itsUVWCalculator.reset(new AntennaUVWCalculator(subtableInfo().getAntenna()));
+  }
+  casacore::Vector<casacore::uInt> ant1;
+  casacore::Vector<casacore::uInt> ant2;
+  fillVectorOfIDs(ant1, "ANTENNA1");
+  fillVectorOfIDs(ant2, "ANTENNA2");
+  // antenna-based uvws are only recomputed when the time or the field changes
+  itsUVWCalculator->setTime(currentEpoch(), getCurrentReferenceDir());
+  itsUVWStorage.attach(uvw, casacore::IPosition(1, itsNumberOfRows));
+  itsUVWCalculator->fill(ant1, ant2, uvw, bounds);
+#ifdef ASKAP_DEBUG
+  // cross-check with the UVW column
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > stored;
+  UVWBounds storedBounds;
+  readUVW(itsCurrentIteration, itsCurrentTopRow, itsNumberOfRows, stored, storedBounds);
+  ASKAPDEBUGASSERT(stored.nelements() == uvw.nelements());
+  double maxDifference = 0.;
+  for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            maxDifference = std::max(maxDifference, std::abs(stored[row](dim) - uvw[row](dim)));
+       }
+  }
+  if (maxDifference > 1e-3) {
+      ASKAPLOG_WARN_STR(logger, "uvw computed from antenna positions differ from the UVW column by up to "<<
+                        maxDifference<<" metres at "<<currentEpoch());
+  }
+#endif // ASKAP_DEBUG
+}
+
 /// populate the buffer with IDs of the first antenna
 /// @param[in] ids a reference to a vector to fill
 void TableConstDataIterator::fillAntenna1(casacore::Vector<casacore::uInt>& ids) const
 {
+  checkAccessorField(IDataSelector::ANTENNA, "antenna1");
   fillVectorOfIDs(ids,"ANTENNA1");
 }
 
@@ -845,6 +2129,7 @@ void TableConstDataIterator::fillAntenna1(casacore::Vector<casacore::uInt>& ids)
 /// @param[in] ids a reference to a vector to fill
 void TableConstDataIterator::fillAntenna2(casacore::Vector<casacore::uInt> &ids) const
 {
+  checkAccessorField(IDataSelector::ANTENNA, "antenna2");
   fillVectorOfIDs(ids,"ANTENNA2");
 }
 
@@ -852,6 +2137,7 @@ void TableConstDataIterator::fillAntenna2(casacore::Vector<casacore::uInt> &ids)
 /// @param[in] ids a reference to a vector to fill
 void TableConstDataIterator::fillFeed1(casacore::Vector<casacore::uInt> &ids) const
 {
+  checkAccessorField(IDataSelector::FEED, "feed1");
   fillVectorOfIDs(ids,"FEED1");
 }
 
@@ -859,6 +2145,7 @@ void TableConstDataIterator::fillFeed1(casacore::Vector<casacore::uInt> &ids) co
 /// @param[in] ids a reference to a vector to fill
 void TableConstDataIterator::fillFeed2(casacore::Vector<casacore::uInt> &ids) const
 {
+  checkAccessorField(IDataSelector::FEED, "feed2");
   fillVectorOfIDs(ids,"FEED2");
 }
 
@@ -872,18 +2159,23 @@ void TableConstDataIterator::fillFeed2(casacore::Vector<casacore::uInt> &ids) co
 void TableConstDataIterator::fillVectorOfIDs(casacore::Vector<casacore::uInt> &ids,
                      const casacore::String &name) const
 {
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   ROScalarColumn<Int> col(itsCurrentIteration,name);
   ids.resize(itsNumberOfRows);
-  Vector<Int> buf=col.getColumnRange(Slicer(IPosition(1,
-                      itsCurrentTopRow),IPosition(1,itsNumberOfRows)));
+  Vector<Int> buf(itsNumberOfRows);
+  col.getColumnRange(Slicer(IPosition(1, itsCurrentTopRow),IPosition(1,itsNumberOfRows)), buf);
   ASKAPDEBUGASSERT(buf.nelements()==ids.nelements());
+  ASKAPDEBUGASSERT(ids.contiguousStorage());
   // need a copy because the type is different. There are no
-  // appropriate cast operators for casacore::Vectors
-  Vector<Int>::const_iterator ci=buf.begin();
-  Vector<uInt>::iterator it=ids.begin();
-  for (; ci!=buf.end() && it!=ids.end() ; ++ci,++it) {
-       ASKAPDEBUGASSERT(*ci>=0);
-	   *it=static_cast<uInt>(*ci);
+  // appropriate cast operators for casacore::Vectors. Both vectors are
+  // freshly allocated (hence contiguous), a plain loop over raw pointers
+  // can be vectorised by the compiler
+  const Int *src = buf.data();
+  uInt *dst = ids.data();
+  const size_t nElements = ids.nelements();
+  for (size_t i = 0; i < nElements; ++i) {
+       ASKAPDEBUGASSERT(src[i]>=0);
+       dst[i] = static_cast<uInt>(src[i]);
   }
 }
 
@@ -903,6 +2195,7 @@ casacore::MEpoch TableConstDataIterator::currentEpoch() const
 /// @param[in] angles a reference to a vector to be filled
 void TableConstDataIterator::fillParallacticAngleCache(casacore::Vector<casacore::Double> &angles) const
 {
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillParallacticAngleCache");
   angles.resize(subtableInfo().getAntenna().getNumberOfAntennas());
   ASKAPDEBUGASSERT(angles.size());
   if (subtableInfo().getAntenna().allEquatorial()) {
@@ -911,27 +2204,31 @@ void TableConstDataIterator::fillParallacticAngleCache(casacore::Vector<casacore
 
   const casacore::MEpoch epoch=currentEpoch();
 
-  // we need a separate converter for parallactic angle calculations
-  DirectionConverter dirConv((casacore::MDirection::Ref(casacore::MDirection::AZEL)));
-  dirConv.setMeasFrame(epoch);
-
   // we currently use FIELD table to get the pointing direction. This table
   // does not depend on the antenna.
   const casacore::MDirection& antReferenceDir = getCurrentReferenceDir();
 
+  // angles may have been computed by another iterator for the same epoch
+  const AntennaDirectionCache &directionCache = subtableInfo().getDirectionCache();
+  if (directionCache.findParallacticAngles(epoch, antReferenceDir, angles)) {
+      timer.hit();
+      return;
+  }
+  timer.miss();
+
+  // we need a separate converter for parallactic angle calculations,
+  // the frame is set up once for all antennas
+  BatchDirectionConverter dirConv((casacore::MDirection::Ref(casacore::MDirection::AZEL)));
+  dirConv.setEpoch(epoch);
+
 
   for (casacore::uInt ant = 0; ant<angles.size(); ++ant) {
        const casacore::String &antMount=subtableInfo().getAntenna().
                                           getMount(ant);
 
        if (antMount == "ALT-AZ" || antMount == "alt-az")  {
-           casacore::MDirection celestialPole;
-           celestialPole.set(MDirection::Ref(MDirection::HADEC));
-           dirConv.setMeasFrame(casacore::MeasFrame(subtableInfo().getAntenna().
-                              getPosition(ant),epoch));
-           const casacore::Double pAngle=dirConv(antReferenceDir).
-                               positionAngle(dirConv(celestialPole).getValue());
-           angles[ant] = pAngle;
+           dirConv.setPosition(subtableInfo().getAntenna().getPosition(ant));
+           angles[ant] = dirConv.parallacticAngle(antReferenceDir);
        } else if (antMount == "FIXED"  ||  antMount == "fixed") {
            // LOFAR has a fixed antenna mount.
            angles[ant] = 0.;
@@ -942,6 +2239,7 @@ void TableConstDataIterator::fillParallacticAngleCache(casacore::Vector<casacore
               " for antenna "<<ant);
        }
     }
+    directionCache.addParallacticAngles(epoch, antReferenceDir, angles);
   } // if all equatorial
 }
 
@@ -965,6 +2263,7 @@ void TableConstDataIterator::fillDirectionCache(casacore::Vector<casacore::MVDir
   // it is hard coded at the moment
   const double parallacticAngleThreshold = 1e-9;
 
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillDirectionCache");
   const casacore::Vector<casacore::Double> &parallacticAngles = itsParallacticAngleCache.value(*this,
                  &TableConstDataIterator::fillParallacticAngleCache);
 
@@ -986,17 +2285,11 @@ void TableConstDataIterator::fillDirectionCache(casacore::Vector<casacore::MVDir
   const casacore::Vector<casacore::RigidVector<casacore::Double, 2> > &offsets =
                feedSubtable.getAllBeamOffsets(epoch,spWindowID);
 
+  // beam centres before conversion, all of them are in the frame of the reference direction
+  casacore::Vector<casacore::MVDirection> feedPointingCentres(antIDs.nelements());
+
   for (casacore::uInt element=0;element<antIDs.nelements();++element) {
        const casacore::uInt ant=antIDs[element];
-
-       // if we decide to be paranoid about performance, we can add a method
-       // to the converter to test whether antenna position and/or epoch are
-       // really required to the requested convertion. Because the antenna
-       // position are cached, the overhead of the present straightforward
-       // approach should be relatively minor.
-       itsConverter->setMeasFrame(casacore::MeasFrame(epoch,subtableInfo().
-                     getAntenna().getPosition(ant)));
-
        casacore::RigidVector<casacore::Double, 2> offset = offsets[element];
        ASKAPDEBUGASSERT(ant<parallacticAngles.nelements());
        const casacore::Double posAngle = parallacticAngles[ant];
@@ -1017,7 +2310,29 @@ void TableConstDataIterator::fillDirectionCache(casacore::Vector<casacore::MVDir
        // x direction is flipped to convert az-el type frame to ra-dec
        feedPointingCentre.shift(casacore::MVDirection(-offset(0),
                              offset(1)),casacore::True);
-       itsConverter->direction(feedPointingCentre,dirs[element]);
+       feedPointingCentres[element] = feedPointingCentre.getValue();
+  }
+
+  // the frame and the conversion engine are set up once for all beams
+  ASKAPDEBUGASSERT(itsConverter);
+  BatchDirectionConverter dirConv(itsConverter->directionFrame());
+  dirConv.setEpoch(epoch);
+  const casacore::MDirection::Ref &inRef = antReferenceDir.getRef();
+  if (!dirConv.needsPosition(inRef)) {
+      dirConv.convert(feedPointingCentres, inRef, dirs);
+      return;
+  }
+  // convert beams of each antenna in one go, only the position is updated
+  // when the antenna changes
+  casacore::Vector<casacore::MVDirection> converted;
+  for (casacore::uInt start = 0; start < antIDs.nelements(); ) {
+       casacore::uInt stop = start + 1;
+       for (; stop < antIDs.nelements() && antIDs[stop] == antIDs[start]; ++stop) {}
+       dirConv.setPosition(subtableInfo().getAntenna().getPosition(antIDs[start]));
+       const casacore::Slice elements(start, stop - start);
+       dirConv.convert(feedPointingCentres(elements), inRef, converted);
+       dirs(elements) = converted;
+       start = stop;
   }
 }
 
@@ -1027,6 +2342,8 @@ void TableConstDataIterator::fillDirectionCache(casacore::Vector<casacore::MVDir
 void TableConstDataIterator::fillPointingDir1(
                           casacore::Vector<casacore::MVDirection> &dirs) const
 {
+  checkAccessorField(IDataSelector::POINTING, "pointingDir1");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   const casacore::Vector<casacore::uInt> &feedIDs=itsAccessor.feed1();
   const casacore::Vector<casacore::uInt> &antIDs=itsAccessor.antenna1();
   fillVectorOfPointings(dirs,antIDs,feedIDs);
@@ -1037,6 +2354,8 @@ void TableConstDataIterator::fillPointingDir1(
 void TableConstDataIterator::fillPointingDir2(
                           casacore::Vector<casacore::MVDirection> &dirs) const
 {
+  checkAccessorField(IDataSelector::POINTING, "pointingDir2");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   const casacore::Vector<casacore::uInt> &feedIDs=itsAccessor.feed2();
   const casacore::Vector<casacore::uInt> &antIDs=itsAccessor.antenna2();
   fillVectorOfPointings(dirs,antIDs,feedIDs);
@@ -1046,6 +2365,8 @@ void TableConstDataIterator::fillPointingDir2(
 /// @param[in] angles a reference to vector to be filled
 void TableConstDataIterator::fillFeed1PA(casacore::Vector<casacore::Float> &angles) const
 {
+  checkAccessorField(IDataSelector::FEED_PA, "feed1PA");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   const casacore::Vector<casacore::uInt> &feedIDs=itsAccessor.feed1();
   const casacore::Vector<casacore::uInt> &antIDs=itsAccessor.antenna1();
   fillVectorOfPositionAngles(angles,antIDs,feedIDs);
@@ -1055,6 +2376,8 @@ void TableConstDataIterator::fillFeed1PA(casacore::Vector<casacore::Float> &angl
 /// @param[in] angles a reference to vector to be filled
 void TableConstDataIterator::fillFeed2PA(casacore::Vector<casacore::Float> &angles) const
 {
+  checkAccessorField(IDataSelector::FEED_PA, "feed2PA");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   const casacore::Vector<casacore::uInt> &feedIDs=itsAccessor.feed2();
   const casacore::Vector<casacore::uInt> &antIDs=itsAccessor.antenna2();
   fillVectorOfPositionAngles(angles,antIDs,feedIDs);
@@ -1088,6 +2411,8 @@ void TableConstDataIterator::fillVectorOfDishPointings(casacore::Vector<casacore
 /// @param[in] dirs a reference to a vector to fill
 void TableConstDataIterator::fillDishPointing1(casacore::Vector<casacore::MVDirection> &dirs) const
 {
+  checkAccessorField(IDataSelector::DISH_POINTING, "dishPointing1");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   const casacore::Vector<casacore::uInt> &antIDs=itsAccessor.antenna1();
   fillVectorOfDishPointings(dirs,antIDs);
 }
@@ -1097,6 +2422,8 @@ void TableConstDataIterator::fillDishPointing1(casacore::Vector<casacore::MVDire
 /// @param[in] dirs a reference to a vector to fill
 void TableConstDataIterator::fillDishPointing2(casacore::Vector<casacore::MVDirection> &dirs) const
 {
+  checkAccessorField(IDataSelector::DISH_POINTING, "dishPointing2");
+  boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
   const casacore::Vector<casacore::uInt> &antIDs=itsAccessor.antenna2();
   fillVectorOfDishPointings(dirs,antIDs);
 }
@@ -1107,33 +2434,91 @@ void TableConstDataIterator::fillDishPointing2(casacore::Vector<casacore::MVDire
 /// individual feeds (or synthetic beams, strictly speaking). The number of elements
 /// in the buffer equals to the number of antennas. This is also different from
 /// fillDirectionCache, which projects feeds to the same 1D array as well.
-/// @note At this stage we use FIELD subtable to get the pointing directions.
+/// @note By default, FIELD subtable is used to get the pointing directions.
 /// Therefore, these directions do not depend on antenna/feed. This method writes
 /// the same value for all elements of the array. It will be used for both antennas
-/// in the pair.
+/// in the pair. If the POINTING subtable is enabled (see setPointingHandler), the
+/// directions are interpolated for each antenna individually.
 /// @param[in] dirs a reference to a vector to fill
 void TableConstDataIterator::fillDishPointingCache(casacore::Vector<casacore::MVDirection> &dirs) const
 {
   ASKAPDEBUGASSERT(itsConverter);
+  DataAccessStatistics::ScopedTimer timer("TableConstDataIterator::fillDishPointingCache");
   const casacore::MEpoch epoch = currentEpoch();
 
   dirs.resize(subtableInfo().getAntenna().getNumberOfAntennas());
 
-  // we currently use FIELD table to get the pointing direction. This table
-  // does not depend on the antenna. However, the reference frame can introduce such
-  // a dependence (i.e. a large array and AZEL frame requested)
+  // the FIELD table does not depend on the antenna. However, the reference frame
+  // can introduce such a dependence (i.e. a large array and AZEL frame requested)
   const casacore::MDirection& antReferenceDir = getCurrentReferenceDir();
+  if (itsPointingHandler && !itsPointingHandler->empty()) {
+      fillDishPointingsFromPointingTable(dirs, epoch, antReferenceDir);
+      return;
+  }
 
+  // pointings may have been computed by another iterator for the same epoch
+  const AntennaDirectionCache &directionCache = subtableInfo().getDirectionCache();
+  const casacore::MDirection::Ref &targetFrame = itsConverter->directionFrame();
+  if (directionCache.findDishPointings(epoch, antReferenceDir, targetFrame, dirs)) {
+      timer.hit();
+      return;
+  }
+  timer.miss();
+
+  // the frame and the conversion engine are set up once for all antennas
+  BatchDirectionConverter dirConv(targetFrame);
+  dirConv.setEpoch(epoch);
+  if (!dirConv.needsPosition(antReferenceDir.getRef())) {
+      // celestial frames, the result is the same for all antennas
+      dirs.set(dirConv(antReferenceDir));
+      directionCache.addDishPointings(epoch, antReferenceDir, targetFrame, dirs);
+      return;
+  }
   for (casacore::uInt ant = 0; ant<dirs.nelements(); ++ant) {
-       // if we decide to be paranoid about performance, we can add a method
-       // to the converter to test whether antenna position and/or epoch are
-       // really required to the requested convertion. Because the antenna
-       // position are cached, the overhead of the present straightforward
-       // approach should be relatively minor.
-       itsConverter->setMeasFrame(casacore::MeasFrame(epoch,subtableInfo().
-                  getAntenna().getPosition(ant)));
-       itsConverter->direction(antReferenceDir,dirs[ant]);
+       dirConv.setPosition(subtableInfo().getAntenna().getPosition(ant));
+       dirs[ant] = dirConv(antReferenceDir);
   }
+  directionCache.addDishPointings(epoch, antReferenceDir, targetFrame, dirs);
+}
+
+/// @brief fill the buffer with the dish pointing directions from the POINTING subtable
+/// @details Directions are interpolated for the current time for each antenna. The
+/// reference direction from the FIELD subtable is used for antennas without pointing
+/// samples around this time. The result is not stored in the direction cache of the
+/// subtable info holder because it doesn't depend on the reference direction only.
+/// @param[in] dirs a reference to a vector to fill (one element per antenna)
+/// @param[in] epoch current time
+/// @param[in] antReferenceDir reference direction from the FIELD subtable
+void TableConstDataIterator::fillDishPointingsFromPointingTable(casacore::Vector<casacore::MVDirection> &dirs,
+               const casacore::MEpoch &epoch, const casacore::MDirection &antReferenceDir) const
+{
+  ASKAPDEBUGASSERT(itsPointingHandler);
+  ASKAPDEBUGASSERT(itsConverter);
+  BatchDirectionConverter dirConv(itsConverter->directionFrame());
+  dirConv.setEpoch(epoch);
+  const bool needsPosition = dirConv.needsPosition(itsPointingHandler->directionFrame()) ||
+                             dirConv.needsPosition(antReferenceDir.getRef());
+  const casacore::Double time = itsPointingHandler->tableTime(epoch);
+  casacore::MVDirection pointing;
+  for (casacore::uInt ant = 0; ant<dirs.nelements(); ++ant) {
+       if (needsPosition) {
+           dirConv.setPosition(subtableInfo().getAntenna().getPosition(ant));
+       }
+       if (itsPointingHandler->getPointing(ant, time, pointing)) {
+           dirs[ant] = dirConv(casacore::MDirection(pointing, itsPointingHandler->directionFrame()));
+       } else {
+           dirs[ant] = dirConv(antReferenceDir);
+       }
+  }
+}
+
+/// @brief use the POINTING subtable for dish pointings
+/// @details An empty shared pointer (default) means that the FIELD subtable is used.
+/// @param[in] handler shared pointer to the handler of the POINTING subtable
+void TableConstDataIterator::setPointingHandler(const boost::shared_ptr<PointingSubtableHandler const> &handler)
+{
+  itsPointingHandler = handler;
+  itsDishPointingCache.invalidate();
 }
 
 /// @brief A helper method to fill a given vector with pointing directions.
@@ -1219,6 +2604,15 @@ const std::string& TableConstDataIterator::getDataColumnName() const throw()
   return itsSelector->getDataColumnName();
 }
 
+/// @brief obtain canonical form of the selection used by this iterator
+/// @details See ITableDataSelectorImpl::getSelectionKey
+/// @return string describing the selection, empty string if no selection is done
+std::string TableConstDataIterator::getSelectionKey() const
+{
+  ASKAPDEBUGASSERT(itsSelector);
+  return itsSelector->getSelectionKey();
+}
+
 /// @brief obtain a current field ID
 /// @details This method obtains a field ID corresponding to the
 /// current iteration, if field ID column is present (and used). Otherwise
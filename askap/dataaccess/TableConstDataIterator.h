@@ -37,14 +37,17 @@
 // std includes
 #include <string>
 #include <utility>
+#include <map>
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 
 // casa includes
 #include <casacore/tables/Tables/Table.h>
-#include <casacore/tables/Tables/TableIter.h>
 #include <casacore/measures/Measures/Stokes.h>
+#include <casacore/casa/Arrays/Slice.h>
 
 
 // own includes
@@ -55,6 +58,18 @@
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/ITableManager.h>
 #include <askap/dataaccess/CachedAccessorField.tcc>
+#include <askap/dataaccess/HighWaterStorage.h>
+#include <askap/dataaccess/ArrayAllocator.h>
+#include <askap/dataaccess/ThreadAffinity.h>
+#include <askap/dataaccess/DataChecksum.h>
+#include <askap/dataaccess/ChunkSummaryMap.h>
+#include <askap/dataaccess/ColumnRuns.h>
+#include <askap/dataaccess/RotatedUVWCache.h>
+#include <askap/dataaccess/UVWBounds.h>
+#include <askap/dataaccess/AntennaUVWCalculator.h>
+#include <askap/dataaccess/PointingSubtableHandler.h>
+#include <askap/dataaccess/TableSelectionCache.h>
+#include <askap/dataaccess/PolarisationConversion.h>
 
 namespace askap {
 
@@ -78,12 +93,29 @@ public:
   /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
   /// to initialisation of a new UVW Machine
   /// @param[in] maxChunkSize maximum number of rows per accessor
+  /// @param[in] readAhead if true, visibilities, flags and uvw for the next chunk are
+  /// read by a background thread while the current chunk is processed. Read-ahead is
+  /// always enabled if the data column is compressed (see compressedDataColumn)
+  /// @param[in] maxChannelBlock maximum number of spectral channels per accessor, 0 means
+  /// no restriction. If set, each chunk of rows is split into a number of accessors covering
+  /// consecutive blocks of the selected channels.
+  /// @param[in] tableMutex mutex serialising access to the table. Iterators working with the
+  /// same measurement set in different threads should share the mutex.
+  /// A new mutex is created if an empty shared pointer is given (default).
   TableConstDataIterator(const boost::shared_ptr<ITableManager const>
               &msManager,
               const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
 	      const boost::shared_ptr<IDataConverterImpl const> &conv,
 	      size_t cacheSize = 1, double tolerance = 1e-6,
-	      casacore::uInt maxChunkSize = INT_MAX);
+	      casacore::uInt maxChunkSize = INT_MAX, bool readAhead = false,
+	      casacore::uInt maxChannelBlock = 0,
+	      const boost::shared_ptr<boost::recursive_mutex> &tableMutex =
+	            boost::shared_ptr<boost::recursive_mutex>());
+
+  /// @brief destructor
+  /// @details Waits for the read-ahead thread (if any) to finish and releases
+  /// table objects while holding the table mutex
+  virtual ~TableConstDataIterator();
 
   /// Restart the iteration from the beginning
   virtual void init();
@@ -101,6 +133,29 @@ public:
   ///         while(it.next()) {} are possible)
   virtual casacore::Bool next();
 
+  /// @brief number of cycles (time steps) in the selected data
+  /// @return number of distinct time stamps, as grouped by the iteration plan
+  casacore::uInt nCycles() const;
+
+  /// @brief index of the current cycle
+  /// @return 0-based index of the time step the current accessor belongs to
+  inline casacore::uInt currentCycle() const { return casacore::uInt(itsIterationStep); }
+
+  /// @brief position the iterator at the given cycle
+  /// @details The rows are located via the iteration plan, so no data need to be read
+  /// to get to the requested time step. The iterator points to the first accessor of the
+  /// given cycle and the iteration can be continued from there with next(). An exception
+  /// is thrown if the cycle doesn't exist.
+  /// @param[in] cycle 0-based index of the time step in the selected data
+  virtual void seekCycle(casacore::uInt cycle);
+
+  /// @brief position the iterator at the first cycle of the given scan
+  /// @details The first row of each cycle determines the scan it belongs to. The index
+  /// of scans is built when this method is called the first time after init. An exception
+  /// is thrown if there are no selected data for the given scan.
+  /// @param[in] scan scan number
+  void seekScan(casacore::uInt scan);
+
   /// methods used in the accessor.
 
   /// @return number of rows in the current accessor
@@ -111,16 +166,23 @@ public:
   /// for now
 
   /// @return number of channels in the current accessor
-  casacore::uInt inline nChannel() const throw() { return getChannelRange().first;}
+  /// @note If channels are averaged, this is the number of channels after averaging
+  casacore::uInt inline nChannel() const throw() { return getChannelRange().first / channelAveraging();}
 
-  /// @return number of channels in the current accessor
-  casacore::uInt inline nPol() const throw() { return itsNumberOfPols;}
+  /// @return number of polarisations in the current accessor
+  /// @note If a subset of polarisations is selected, this number can be smaller
+  /// than the number of polarisations in the table. If the selected products are
+  /// converted from the stored ones, this is the number of products after conversion.
+  casacore::uInt inline nPol() const throw()
+      { return itsPolConversion ? itsPolConversion->nOut() : itsNumberOfSelectedPols;}
 
   /// populate the buffer of visibilities with the values of current
   /// iteration
+  /// @details This method is virtual to allow derived classes to obtain
+  /// the data some other way (e.g. from a memory-mapped column)
   /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
   ///            cube to fill with the complex visibility data
-  void fillVisibility(casacore::Cube<casacore::Complex> &vis) const;
+  virtual void fillVisibility(casacore::Cube<casacore::Complex> &vis) const;
 
   /// populate the buffer of noise figures with the values of current
   /// iteration
@@ -128,18 +190,28 @@ public:
   ///            cube to be filled with the noise figures
   void fillNoise(casacore::Cube<casacore::Complex> &noise) const;
 
+  /// @brief populate the compact noise representation
+  /// @details Noise given per row and polarisation (i.e. SIGMA column or SIGMA_SPECTRUM
+  /// constant across the spectral axis) is stored without expanding it into a cube.
+  /// Otherwise, the full cube is stored (via fillNoise).
+  /// @param[in] noise a reference to the compact noise object to fill
+  void fillCompactNoise(CompactNoise &noise) const;
+
   /// @brief read flagging information
   /// @details populate the buffer of flags with the information
   /// read in the current iteration
   /// @param[in] flag a reference to the nRow x nChannel x nPol buffer
   ///            cube to fill with the flag information (each element has
   ///            bool type)
-  void fillFlag(casacore::Cube<casacore::Bool> &flag) const;
+  virtual void fillFlag(casacore::Cube<casacore::Bool> &flag) const;
 
   /// populate the buffer with uvw
+  /// @details The bounding box of uvw is computed in the same pass.
   /// @param[in] uvw a reference to vector of rigid vectors (3 elemets,
   ///            u,v and w for each row) to fill
-  void fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&uvw) const;
+  /// @param[in] bounds a reference to the bounding box of uvw to fill
+  void fillUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&uvw,
+               UVWBounds &bounds) const;
 
   /// populate the buffer with frequencies
   /// @param[in] freq a reference to a vector to fill
@@ -210,6 +282,126 @@ public:
   /// @return direction tolerance used for UVW machine cache (in radians)
   inline double uvwMachineCacheTolerance() const {return itsUVWCacheTolerance;}
 
+  /// @brief obtain accessor fields allowed to be used
+  /// @details This is the set of fields declared via the selector extended by the
+  /// fields which are required internally to compute them (e.g. pointing directions
+  /// need feed and antenna indices).
+  /// @return bitwise combination of IDataSelector::AccessorFields values
+  inline casacore::uInt accessorFields() const { return itsAccessorFields;}
+
+  /// @brief check whether read-ahead is enabled
+  /// @return true, if the next chunk is read in the background
+  inline bool readAheadEnabled() const { return itsReadAhead;}
+
+  /// @brief check whether the data column is stored by a compressing data manager
+  /// @details Decompression (e.g. by DyscoStMan or CompressComplex) typically dominates
+  /// the cost of reading such columns. The next chunk is then always read ahead and
+  /// decompressed in blocks of rows, so the consumer doesn't wait for it.
+  /// @return true, if the data column is compressed
+  inline bool compressedDataColumn() const { return !itsCompressingDataManager.empty();}
+
+  /// @return type of the data manager compressing the data column, empty string if the
+  /// column is not compressed
+  inline const std::string& compressingDataManager() const { return itsCompressingDataManager;}
+
+  /// @brief enable checksums of the data delivered by this iterator
+  /// @details If enabled, the checksums of the visibility and flag cubes are computed
+  /// when the cubes are filled for each chunk and added to the aggregator given here.
+  /// The aggregator can be shared between iterators (e.g. those created by the same
+  /// data source). An empty shared pointer disables checksums.
+  /// @param[in] aggregator object collecting checksums of all chunks
+  void setChecksumAggregator(const boost::shared_ptr<DataChecksumAggregator> &aggregator);
+
+  /// @brief check whether checksums are computed
+  /// @return true, if the checksums are computed for each chunk
+  inline bool checksumsEnabled() const { return static_cast<bool>(itsChecksumAggregator);}
+
+  /// @brief collect chunk summaries
+  /// @details If a map is given, the summary of each chunk is added to it when the flags
+  /// are filled, provided the iterator reads all rows, channels and polarisations of the
+  /// measurement set (i.e. the selection is empty). Otherwise the map is only used to look
+  /// summaries up (see currentChunkSummary). An empty shared pointer disables summaries.
+  /// @param[in] map object collecting summaries of all chunks
+  void setChunkSummaryMap(const boost::shared_ptr<ChunkSummaryMap> &map);
+
+  /// @brief summary of the time stamp of the current chunk
+  /// @details The summary covers all rows of the measurement set with the time stamp of
+  /// the current chunk, regardless of the selection. It is available if a full pass over
+  /// this time stamp has been done before (possibly by another iterator sharing the map or
+  /// in another process if the map is persisted). This allows the consumers to skip the
+  /// chunks which are fully flagged or don't have any data in the uv-range of interest
+  /// without accessing the visibility cube.
+  /// @param[out] summary summary of the current time stamp (unchanged if not available)
+  /// @return true, if the summary is available
+  bool currentChunkSummary(ChunkSummary &summary) const;
+
+  /// @brief set the allocation policy for the cubes of this iterator
+  /// @details The policy is used for the storage of visibility, flag and noise cubes and
+  /// uvw vectors allocated in the future (including those read ahead in the background).
+  /// An empty shared pointer means the global heap (default).
+  /// @param[in] allocator shared pointer to the allocator
+  void setArrayAllocator(const boost::shared_ptr<ArrayAllocator const> &allocator);
+
+  /// @return allocation policy for the cubes, empty for the global heap
+  inline const boost::shared_ptr<ArrayAllocator const>& arrayAllocator() const { return itsArrayAllocator;}
+
+  /// @brief set the placement policy for the background threads of this iterator
+  /// @details The policy is applied at the start of every read-ahead (and write-behind
+  /// for the read-write iterator) thread. The CONSUMER policy should be resolved by the
+  /// thread using the iterator (see ThreadAffinity::resolve).
+  /// @param[in] affinity placement policy
+  void setThreadAffinity(const ThreadAffinity &affinity);
+
+  /// @return placement policy for the background threads
+  inline const ThreadAffinity& threadAffinity() const { return itsThreadAffinity;}
+
+  /// @brief enable caching of rotated uvws and delays across iterations
+  /// @details If enabled, the results of rotatedUVW and uvwRotationDelay of the accessor
+  /// are stored in the given cache and reused if the same rows are delivered again with the
+  /// same phase and tangent point (e.g. in the next major cycle). The cache can be shared
+  /// between iterators working with the same table. An empty shared pointer disables caching.
+  /// @param[in] cache shared pointer to the cache
+  void setRotatedUVWCache(const boost::shared_ptr<RotatedUVWCache> &cache);
+
+  /// @brief compute uvw from antenna positions
+  /// @details If enabled, uvw are not read from the UVW column. Instead, they are computed
+  /// from the antenna positions of the ANTENNA subtable, the phase centre of the FIELD subtable
+  /// and the epoch (see AntennaUVWCalculator). Antenna positions are converted once per time
+  /// step. In the debug mode, the result is compared with the UVW column and a warning is
+  /// logged if they disagree.
+  /// @param[in] enable true to compute uvw, false to read them from the UVW column (default)
+  void setComputedUVW(bool enable);
+
+  /// @return true, if uvw are computed from the antenna positions
+  inline bool computedUVW() const { return itsComputedUVW;}
+
+  /// @brief use the POINTING subtable for dish pointings
+  /// @details If set, dishPointing1 and dishPointing2 are interpolated from the given
+  /// handler of the POINTING subtable for each antenna. The reference direction from the
+  /// FIELD subtable is used if the handler has no samples for the antenna around the
+  /// current time. An empty shared pointer (default) means that the FIELD subtable is
+  /// used for all antennas. The handler can be shared between iterators.
+  /// @param[in] handler shared pointer to the handler of the POINTING subtable
+  void setPointingHandler(const boost::shared_ptr<PointingSubtableHandler const> &handler);
+
+  /// @brief obtain the key identifying rows of the current chunk for the rotated uvw cache
+  /// @details The key includes the selection, the first row in the root table and the
+  /// number of rows. It is computed once per chunk.
+  /// @return key string, empty if rotated uvw caching is disabled
+  std::string rotatedUVWKey() const;
+
+  /// @brief checksum of the visibility cube delivered for the current chunk
+  /// @details The checksum is available after the visibilities of the current chunk
+  /// have been accessed. An exception is thrown otherwise.
+  /// @return checksum of the visibility cube
+  casacore::uInt64 visibilityChecksum() const;
+
+  /// @brief checksum of the flag cube delivered for the current chunk
+  /// @details The checksum is available after the flags of the current chunk
+  /// have been accessed. An exception is thrown otherwise.
+  /// @return checksum of the flag cube
+  casacore::uInt64 flagChecksum() const;
+
   /// @brief obtain a current field ID
   /// @details This method obtains a field ID corresponding to the
   /// current iteration, if field ID column is present (and used). Otherwise
@@ -237,10 +429,70 @@ protected:
   /// in the full cube
   std::pair<casacore::uInt, casacore::uInt> getChannelRange() const;
 
+  /// @brief obtain the full range of selected channels
+  /// @details Unlike getChannelRange, this method ignores splitting of the spectral
+  /// axis into blocks (see maxChannelBlock parameter of the constructor).
+  /// @return a pair, first element is the number of channels, second is the first channel
+  /// in the full cube
+  std::pair<casacore::uInt, casacore::uInt> getSelectedChannelRange() const;
+
   /// @brief a short cut to get the first channel in the full cube
   /// @return the number of the first channel in the full cube
   inline casacore::uInt startChannel() const { return getChannelRange().second;}
 
+  /// @brief number of channels read from the table for the current accessor
+  /// @details This is nChannel times channelAveraging.
+  /// @return number of input channels
+  inline casacore::uInt nChannelsToRead() const { return getChannelRange().first;}
+
+  /// @brief number of polarisations read from the table for the current accessor
+  /// @details This is nPol unless the selected products are converted from the stored
+  /// correlations, in which case all stored correlations are read.
+  /// @return number of input polarisations
+  inline casacore::uInt nPolToRead() const { return itsNumberOfSelectedPols;}
+
+  /// @brief check whether the polarisation products are converted
+  /// @return true, if the products sent out are obtained from the stored correlations
+  /// by conversion (and therefore can't be written back)
+  inline bool polarisationConverted() const { return static_cast<bool>(itsPolConversion);}
+
+  /// @brief number of adjacent channels averaged into one output channel
+  /// @details The channel range (see getChannelRange) is given in the input channels,
+  /// the accessor has this number of times fewer channels.
+  /// @return averaging factor, 1 means no averaging
+  casacore::uInt channelAveraging() const;
+
+  /// @brief obtain canonical form of the selection used by this iterator
+  /// @details See ITableDataSelectorImpl::getSelectionKey
+  /// @return string describing the selection, empty string if no selection is done
+  std::string getSelectionKey() const;
+
+  /// @brief check whether all data of the current accessor are flagged by the selection
+  /// @details This is the case if the frequency selection is outside the current
+  /// spectral window. The flag is updated when the channel range is obtained, so
+  /// getChannelRange (or nChannel) should be called first.
+  /// @return true, if all flags of the current accessor should be set
+  inline bool allFlaggedBySelection() const { return itsFlagData;}
+
+  /// @brief compute checksum of the visibility cube delivered for the current chunk
+  /// @details Does nothing if checksums are disabled or the checksum has already been
+  /// computed for the current chunk. Derived classes delivering the data some other way
+  /// should call this method for the cubes which are not filled by this class.
+  /// @param[in] vis visibility cube
+  void updateVisibilityChecksum(const casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief compute checksum of the flag cube delivered for the current chunk
+  /// @details Does nothing if checksums are disabled or the checksum has already been
+  /// computed for the current chunk.
+  /// @param[in] flag flag cube
+  void updateFlagChecksum(const casacore::Cube<casacore::Bool> &flag) const;
+
+  /// @brief add summary of the current chunk to the chunk summary map
+  /// @details Does nothing if summaries are disabled, the selection doesn't cover the whole
+  /// measurement set or the summary has already been added for the current chunk.
+  /// @param[in] flag flag cube
+  void updateChunkSummary(const casacore::Cube<casacore::Bool> &flag) const;
+
   /// @brief read an array column of the table into a cube
   /// @details populate the buffer provided with the information
   /// read in the current iteration. This method is templated and can be
@@ -248,9 +500,39 @@ protected:
   /// @param[in] cube a reference to the nRow x nChannel x nPol buffer
   ///            cube to fill with the information from table
   /// @param[in] columnName a name of the column to read
+  /// @note The channels are those of the table, i.e. before averaging (see nChannelsToRead)
   template<typename T>
   void fillCube(casacore::Cube<T> &cube, const std::string &columnName) const;
 
+  /// @brief read noise from the table
+  /// @details This is the body of fillNoise. The table mutex should be locked by the caller.
+  /// @param[in] noise a reference to the nRow x nChan x nPol cube to fill
+  ///            (it should already have the right shape)
+  /// @param[in] startChan first channel to read
+  /// @param[in] nChan number of channels to read
+  void readNoise(casacore::Cube<casacore::Complex> &noise, casacore::uInt startChan,
+                 casacore::uInt nChan) const;
+
+  /// @brief obtain visibilities for the stored polarisation products
+  /// @details This is the body of fillVisibility, the cube has nPolToRead planes.
+  /// @param[in] vis a reference to the nRow x nChannel x nPolToRead cube to fill
+  /// @param[in] storage storage to attach the cube to, if it is filled from the table
+  void fillStoredVisibility(casacore::Cube<casacore::Complex> &vis,
+                            HighWaterStorage<casacore::Complex> &storage) const;
+
+  /// @brief obtain flags for the stored polarisation products
+  /// @details This is the body of fillFlag, the cube has nPolToRead planes.
+  /// @param[in] flag a reference to the nRow x nChannel x nPolToRead cube to fill
+  /// @param[in] storage storage to attach the cube to, if it is filled from the table
+  void fillStoredFlag(casacore::Cube<casacore::Bool> &flag, HighWaterStorage<casacore::Bool> &storage) const;
+
+  /// @brief obtain noise for the stored polarisation products
+  /// @details This is the body of fillNoise, the cube has nPolToRead planes.
+  /// @param[in] noise a reference to the nRow x nChannel x nPolToRead cube to fill
+  /// @param[in] storage storage to attach the cube to
+  void fillStoredNoise(casacore::Cube<casacore::Complex> &noise,
+                       HighWaterStorage<casacore::Complex> &storage) const;
+
   /// @brief A helper method to fill a given vector with pointing directions.
   /// @details fillPointingDir1 and fillPointingDir2 methods do very similar
   /// operations, which differ only by the feedIDs and antennaIDs used.
@@ -298,9 +580,34 @@ protected:
   void fillVectorOfIDs(casacore::Vector<casacore::uInt> &ids,
                        const casacore::String &name) const;
 
+  /// @brief compute uvw from antenna positions
+  /// @details This helper does the actual work for fillUVW if uvws are computed
+  /// (see setComputedUVW).
+  /// @param[in] uvw a reference to vector of rigid vectors to fill
+  /// @param[in] bounds a reference to the bounding box of uvw to fill
+  void computeUVW(casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                  UVWBounds &bounds) const;
+
   /// setup accessor for a new iteration
   void setUpIteration();
 
+  /// @brief build the iteration plan for the given table
+  /// @details Rows are grouped into consecutive ranges with the same time stamp. The
+  /// table is assumed to be in time order (no sorting is done).
+  /// @param[in] tab selected table
+  /// @return shared pointer to the plan
+  static boost::shared_ptr<TableSelectionCache::IterationPlan const>
+        buildIterationPlan(const casacore::Table &tab);
+
+  /// @brief obtain rows of the given iteration step
+  /// @param[in] step index of the step in the iteration plan
+  /// @return reference table with the rows of the step
+  casacore::Table iterationTable(size_t step) const;
+
+  /// @brief set up the number of channel blocks for the current chunk of rows
+  /// @details This method is called every time the rows of the chunk change.
+  void setUpChannelBlocks();
+
   /// @brief method ensures that the chunk has a uniform DATA_DESC_ID
   /// @details This method reduces itsNumberOfRows to achieve
   /// uniform DATA_DESC_ID reading for all rows in the current chunk.
@@ -311,6 +618,23 @@ protected:
   /// when DATA_DESC_ID changes (and therefore at the first run as well)
   void makeUniformDataDescID();
 
+  /// @brief set up polarisations to read for the current DATA_DESC_ID
+  /// @details If polarisations are selected, the requested products are located among
+  /// the correlations stored in the table. Only those products are read from the table,
+  /// if they form a strided subset of the stored correlations (e.g. XX,YY out of
+  /// XX,XY,YX,YY). Otherwise, all stored correlations are read and converted into the
+  /// requested products (see PolarisationConversion).
+  void setUpPolarisationSelection();
+
+  /// @return slice of the polarisation axis of the table with the selected products
+  inline casacore::Slice polSlice() const 
+        { return casacore::Slice(itsPolStart, itsNumberOfSelectedPols, itsPolIncrement); }
+
+  /// @brief index of the polarisation in the table
+  /// @param[in] pol polarisation index in the accessor
+  /// @return corresponding index along the polarisation axis of the table
+  inline casacore::uInt polIndex(casacore::uInt pol) const { return itsPolStart + pol * itsPolIncrement; }
+
   /// @brief method ensures that the chunk has a uniform FIELD_ID
   /// @details This method reduces itsNumberOfRows until FIELD_ID is
   /// the same for all rows in the current chunk. The resulting
@@ -355,6 +679,16 @@ protected:
   /// @param[in] dirs a reference to a vector to fill
   void fillDishPointingCache(casacore::Vector<casacore::MVDirection> &dirs) const;
 
+  /// @brief fill the buffer with the dish pointing directions from the POINTING subtable
+  /// @details Directions are interpolated for the current time for each antenna. The
+  /// reference direction from the FIELD subtable is used for antennas without pointing
+  /// samples around this time.
+  /// @param[in] dirs a reference to a vector to fill (one element per antenna)
+  /// @param[in] epoch current time
+  /// @param[in] antReferenceDir reference direction from the FIELD subtable
+  void fillDishPointingsFromPointingTable(casacore::Vector<casacore::MVDirection> &dirs,
+               const casacore::MEpoch &epoch, const casacore::MDirection &antReferenceDir) const;
+
   /// @brief obtain a current spectral window ID
   /// @details This method obtains a spectral window ID corresponding to the
   /// current data description ID and tests its validity
@@ -367,8 +701,8 @@ protected:
   /// @return current polarisation ID
   casacore::uInt currentPolID() const;
 
-  /// @brief obtain the current iteration of the table iterator
-  /// @details This class uses TableIterator behind the scene. This method
+  /// @brief obtain the current iteration (all rows of the current time step)
+  /// @details Rows are grouped by time according to the iteration plan. This method
   /// returns the current iteration, which can be used in derived classes
   /// (e.g. for read-write access)
   /// @return a const reference to table object representing the current iteration
@@ -376,8 +710,7 @@ protected:
        {return itsCurrentIteration;}
 
   /// @brief obtain the current top row
-  /// @details This class uses TableIterator behind the scence. One iteration
-  /// of the table iterator may cover more than one iteration of the iterator
+  /// @details One time step of the iteration plan may cover more than one iteration of the iterator
   /// represented by this class. The result of this method is a row number,
   /// where current data accessor starts.
   /// @return row number in itsCurrentItrertion corresponding to row 0 of the
@@ -401,7 +734,88 @@ protected:
   /// @return a reference to direction measure
   const casacore::MDirection& getCurrentReferenceDir() const;
 
+  /// @brief check that the given field has been declared as used
+  /// @details An exception is thrown if the field is not in the set of fields
+  /// declared via the selector
+  /// @param[in] field IDataSelector::AccessorFields value to check
+  /// @param[in] name name of the field for the error message
+  void checkAccessorField(casacore::uInt field, const char *name) const;
+
+  /// @brief mutex serialising access to the table
+  /// @details casacore tables are not thread-safe. If read-ahead is enabled, the
+  /// background thread and the consumer thread share the table. All table access
+  /// done by this class is guarded by this mutex (it is recursive because fill
+  /// methods may call each other). Derived classes can use it too.
+  /// @return reference to the mutex
+  inline boost::recursive_mutex& tableMutex() const { return *itsTableMutex;}
+
 private:
+  /// @brief buffer for the data of the next chunk read in the background
+  struct ReadAheadBuffer {
+     /// @brief chunk sequence number this buffer corresponds to
+     casacore::uInt itsChunk;
+     /// @brief table iteration containing the chunk
+     casacore::Table itsIteration;
+     /// @brief first row of the chunk in itsIteration
+     casacore::rownr_t itsTopRow;
+     /// @brief number of rows in the chunk
+     casacore::uInt itsNumberOfRows;
+     /// @brief number of polarisations in the table
+     casacore::uInt itsNPol;
+     /// @brief polarisations to read
+     casacore::Slice itsPolSlice;
+     /// @brief number of channels in the table
+     casacore::uInt itsNChanInTable;
+     /// @brief number of channels (after selection)
+     casacore::uInt itsNChan;
+     /// @brief first selected channel
+     casacore::uInt itsStartChan;
+     /// @brief true if visibility and flag cubes are to be read
+     bool itsReadCubes;
+     /// @brief visibility cube
+     casacore::Cube<casacore::Complex> itsVisibility;
+     /// @brief flag cube
+     casacore::Cube<casacore::Bool> itsFlag;
+     /// @brief uvw
+     casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+     /// @brief bounding box of itsUVW
+     UVWBounds itsUVWBounds;
+     /// @brief validity flags set by the background thread upon successful read
+     bool itsVisibilityValid;
+     /// @brief see itsVisibilityValid
+     bool itsFlagValid;
+     /// @brief see itsVisibilityValid
+     bool itsUVWValid;
+  };
+
+  /// @brief start reading the next chunk in the background
+  /// @details This method determines the rows of the chunk which will follow the current
+  /// one and starts a thread filling the buffer. Nothing is done if there is no
+  /// next chunk or it has a different data descriptor (and therefore potentially different shape).
+  void startReadAhead();
+
+  /// @brief wait until the background read is finished
+  void waitForReadAhead() const;
+
+  /// @brief body of the background thread
+  /// @param[in] buf buffer to fill
+  void readAhead(const boost::shared_ptr<ReadAheadBuffer> &buf) const;
+
+  /// @brief read compressed visibilities of the next chunk in blocks of rows
+  /// @details This method is used by the background thread if the data column is
+  /// compressed. The table mutex is released between blocks, so the consumer thread
+  /// and other iterators sharing the mutex are not locked out while the whole chunk
+  /// is decompressed.
+  /// @param[in] buf buffer to fill
+  void readCompressedVisibility(ReadAheadBuffer &buf) const;
+
+  /// @brief take the buffer read in the background for the current chunk
+  /// @details This method is called when the iterator advances. If the buffer
+  /// filled in the background corresponds to the new current chunk, it is moved
+  /// to itsPrefetchedChunk and subsequently used by the fill methods.
+  void adoptReadAheadBuffer();
+
+
   // note, it is essential that itsUVWCacheSize and itsUVWCacheTolerance are initialised
   // prior to itsAccessor (accessor uses them in its setup)
 
@@ -423,8 +837,17 @@ private:
   boost::shared_ptr<IDataConverterImpl>  itsConverter;
   /// the maximum allowed number of rows in the accessor.
   casacore::uInt itsMaxChunkSize;
-  casacore::TableIterator itsTabIterator;
-  /// current group of data returned by itsTabIterator
+  /// table with all selected rows
+  casacore::Table itsSelectedTable;
+  /// @brief ranges of rows with the same time stamp in itsSelectedTable
+  /// @details The plan is shared with the selection cache and other iterators
+  boost::shared_ptr<TableSelectionCache::IterationPlan const> itsIterationPlan;
+  /// index of the current step in itsIterationPlan
+  size_t itsIterationStep;
+  /// @brief first cycle of each scan present in the selected data
+  /// @details This index is built on demand by seekScan and cleared by init
+  std::map<casacore::uInt, casacore::uInt> itsScanIndex;
+  /// current group of data (rows of the current time step)
   casacore::Table itsCurrentIteration;
   /// current row in the itsCurrentIteration projected to the row 0
   /// of the data accessor
@@ -438,6 +861,20 @@ private:
   /// see above
   casacore::uInt itsNumberOfPols;
 
+  /// @brief number of polarisations sent out (after selection)
+  casacore::uInt itsNumberOfSelectedPols;
+
+  /// @brief first selected polarisation in the table
+  casacore::uInt itsPolStart;
+
+  /// @brief step between selected polarisations in the table
+  casacore::uInt itsPolIncrement;
+
+  /// @brief conversion of the stored correlations into the selected products
+  /// @details Empty, if the selected products are read directly. Otherwise, all stored
+  /// correlations are read and converted.
+  boost::shared_ptr<PolarisationConversion const> itsPolConversion;
+
   /// current DATA_DESC_ID, the iteration is broken if this
   /// ID changes
   casacore::Int itsCurrentDataDescID;
@@ -457,6 +894,15 @@ private:
   /// if the latter is present.
   bool itsUseFieldID;
 
+  /// @brief runs of DATA_DESC_ID in itsCurrentIteration
+  /// @details The runs are found once per time step in setUpIteration, so the chunks
+  /// of the time step are obtained without scanning the column again
+  ColumnRuns itsDataDescRuns;
+
+  /// @brief runs of FIELD_ID in itsCurrentIteration
+  /// @details Empty if itsUseFieldID is false, see itsDataDescRuns for details
+  ColumnRuns itsFieldRuns;
+
   /// @brief cache of pointing directions  for each feed
   /// @details This is an internal buffer for pointing
   /// directions for the whole current cache of the Feed subtable handler
@@ -474,12 +920,116 @@ private:
   mutable uint itsNumberOfChannelsSelected;
   /// currently selected start channel
   mutable uint itsStartChannelSelected;
+  /// currently selected number of channels to average
+  mutable uint itsChannelAveraging;
   /// selection initialised?
   mutable bool itsChannelsSelected;
   /// selection invalid?
   mutable bool itsFlagData;
   /// are we at the start?
   mutable bool itsAtStart;
+
+  /// @brief true if the next chunk is read in the background
+  bool itsReadAhead;
+
+  /// @brief type of the data manager compressing the data column, empty if not compressed
+  std::string itsCompressingDataManager;
+
+  /// @brief maximum number of channels per accessor, 0 means no restriction
+  casacore::uInt itsMaxChannelBlock;
+
+  /// @brief index of the current block of channels
+  casacore::uInt itsChannelBlock;
+
+  /// @brief number of channel blocks for the current chunk of rows
+  casacore::uInt itsNumberOfChannelBlocks;
+
+  /// @brief accessor fields allowed to be used (bitwise combination of IDataSelector::AccessorFields)
+  casacore::uInt itsAccessorFields;
+
+  /// @brief sequence number of the current chunk since init
+  casacore::uInt itsChunkCounter;
+
+  /// @brief object collecting checksums of all chunks, empty if checksums are disabled
+  boost::shared_ptr<DataChecksumAggregator> itsChecksumAggregator;
+
+  /// @brief checksum of the visibility cube of the current chunk
+  mutable casacore::uInt64 itsVisibilityChecksum;
+
+  /// @brief checksum of the flag cube of the current chunk
+  mutable casacore::uInt64 itsFlagChecksum;
+
+  /// @brief true, if itsVisibilityChecksum corresponds to the current chunk
+  mutable bool itsVisibilityChecksumValid;
+
+  /// @brief true, if itsFlagChecksum corresponds to the current chunk
+  mutable bool itsFlagChecksumValid;
+
+  /// @brief summaries of the chunks, empty if summaries are disabled
+  boost::shared_ptr<ChunkSummaryMap> itsChunkSummaryMap;
+
+  /// @brief true, if the summary of the current chunk has been added to the map
+  mutable bool itsChunkSummaryAdded;
+
+  /// @brief cache of rotated uvws and delays, empty if caching is disabled
+  boost::shared_ptr<RotatedUVWCache> itsRotatedUVWCache;
+
+  /// @brief handler of the POINTING subtable, empty if the FIELD subtable is used
+  boost::shared_ptr<PointingSubtableHandler const> itsPointingHandler;
+
+  /// @brief key identifying rows of the current chunk for the rotated uvw cache
+  mutable std::string itsRotatedUVWKey;
+
+  /// @brief true, if itsRotatedUVWKey corresponds to the current chunk
+  mutable bool itsRotatedUVWKeyValid;
+
+  /// @brief true, if uvws are computed from the antenna positions
+  bool itsComputedUVW;
+
+  /// @brief calculator of uvws from the antenna positions, created on demand
+  mutable boost::shared_ptr<AntennaUVWCalculator> itsUVWCalculator;
+
+  /// @brief buffer filled (or being filled) by the background thread for the next chunk
+  boost::shared_ptr<ReadAheadBuffer> itsReadAheadBuffer;
+
+  /// @brief buffer read in the background for the current chunk
+  /// @details Fill methods take the data from this buffer (if valid)
+  boost::shared_ptr<ReadAheadBuffer> itsPrefetchedChunk;
+
+  /// @brief background thread reading the next chunk
+  mutable boost::shared_ptr<boost::thread> itsReadAheadThread;
+
+  /// @brief mutex serialising table access
+  /// @details The mutex can be shared between iterators working in different threads
+  boost::shared_ptr<boost::recursive_mutex> itsTableMutex;
+
+  /// @brief storage reused by visibility cubes of all chunks
+  /// @details Chunks of smaller size are views into the storage allocated for the largest chunk
+  mutable HighWaterStorage<casacore::Complex> itsVisibilityStorage;
+
+  /// @brief storage reused by flag cubes of all chunks
+  mutable HighWaterStorage<casacore::Bool> itsFlagStorage;
+
+  /// @brief storage reused by noise cubes of all chunks
+  mutable HighWaterStorage<casacore::Complex> itsNoiseStorage;
+
+  /// @brief storage for visibilities of the stored correlations prior to polarisation conversion
+  mutable HighWaterStorage<casacore::Complex> itsStoredVisibilityStorage;
+
+  /// @brief storage for flags of the stored correlations prior to polarisation conversion
+  mutable HighWaterStorage<casacore::Bool> itsStoredFlagStorage;
+
+  /// @brief storage for noise of the stored correlations prior to polarisation conversion
+  mutable HighWaterStorage<casacore::Complex> itsStoredNoiseStorage;
+
+  /// @brief storage reused by uvw vectors of all chunks
+  mutable HighWaterStorage<casacore::RigidVector<casacore::Double, 3> > itsUVWStorage;
+
+  /// @brief allocation policy for the cubes, empty for the global heap
+  boost::shared_ptr<ArrayAllocator const> itsArrayAllocator;
+
+  /// @brief placement policy for the background threads
+  ThreadAffinity itsThreadAffinity;
 };
 
 
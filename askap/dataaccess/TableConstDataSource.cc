@@ -31,11 +31,25 @@
 
 /// boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+
+/// casa includes
+#include <casacore/tables/Tables/ScalarColumn.h>
+
+/// std includes
+#include <set>
+#include <exception>
 
 /// own includes
 #include <askap/dataaccess/TableConstDataSource.h>
 #include <askap/dataaccess/TableConstDataIterator.h>
+#include <askap/dataaccess/CachedTableConstDataIterator.h>
 #include <askap/dataaccess/TableDataSelector.h>
+#include <askap/dataaccess/TableManager.h>
 #include <askap/dataaccess/BasicDataConverter.h>
 #include <askap/dataaccess/DataAccessError.h>
 
@@ -53,7 +67,9 @@ TableConstDataSource::TableConstDataSource(const std::string &fname,
                const std::string &dataColumn) :
          TableInfoAccessor(casacore::Table(fname), false, dataColumn),
          itsUVWCacheSize(1), itsUVWCacheTolerance(1e-6),
-         itsMaxChunkSize(INT_MAX) {}
+         itsMaxChunkSize(INT_MAX), itsReadAhead(false), itsMaxChannelBlock(0),
+         itsUVDistanceIndex(false), itsConcurrentRead(false), itsComputedUVW(false),
+         itsTableMutex(new boost::recursive_mutex) {}
 
 /// @brief obtain the position of the given antenna
 /// @details
@@ -100,6 +116,260 @@ void TableConstDataSource::configureMaxChunkSize(casacore::uInt maxNumRows)
    itsMaxChunkSize = maxNumRows;
 }
 
+/// @brief configure read-ahead of the data
+/// @details If read-ahead is enabled, visibilities, flags and uvw for the next chunk
+/// are read by a background thread while the current chunk is being processed.
+/// @param[in] readAhead true to enable read-ahead, false to disable it (default)
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureReadAhead(bool readAhead)
+{
+   itsReadAhead = readAhead;
+}
+
+/// @brief configure splitting of the spectral axis
+/// @details If this option is set, each chunk of rows is delivered as several accessors,
+/// each covering a block of consecutive channels of the selection.
+/// @param[in] maxNumChannels maximum number of channels per accessor, 0 means no
+/// restriction (default)
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureMaxChannelBlock(casacore::uInt maxNumChannels)
+{
+   itsMaxChannelBlock = maxNumChannels;
+}
+
+/// @brief configure uv-distance selection
+/// @details If this option is set, uv-distances of all rows are computed and sorted
+/// once per data source when the first uv-distance selection is done. Subsequent
+/// selections on the uv-distance (e.g. different uv-cuts of the same dataset) are then
+/// done via binary search rather than by evaluating a table expression for every row.
+/// This costs about 16 bytes of memory per row of the measurement set.
+/// @param[in] useIndex true to use the index, false to use table expressions (default)
+/// @note The new setting will apply to any selector created in the future, but will not
+/// affect selectors already created
+void TableConstDataSource::configureUVDistanceIndex(bool useIndex)
+{
+   itsUVDistanceIndex = useIndex;
+}
+
+/// @brief configure concurrent-read mode
+/// @details If this option is set, each iterator created by createConstIterator
+/// gets its own table manager and all iterators serialise table access via the
+/// mutex returned by tableMutex.
+/// @param[in] concurrentRead true to enable concurrent-read mode, false to disable it (default)
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureConcurrentRead(bool concurrentRead)
+{
+   itsConcurrentRead = concurrentRead;
+}
+
+/// @brief configure caching of visibilities and flags
+/// @details If this option is set, iterators created by createConstIterator keep
+/// visibilities (in the compact form) and flags read in the first iteration in a cache
+/// shared by all iterators of this data source. Subsequent iterations with the same selection
+/// (e.g. major cycles of imaging) take the data from the cache instead of the measurement set.
+/// The cache is discarded if the measurement set is modified.
+/// @param[in] enable true to enable caching, false to disable it and release the cache (default)
+/// @param[in] precision precision of cached visibilities
+/// @param[in] directory directory for the cache file, visibilities are kept in memory if empty
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureVisibilityCache(bool enable, CompactVisibility::Precision precision,
+                                                    const std::string &directory)
+{
+   if (enable) {
+       itsVisibilityCache.reset(new VisibilityCache(precision, directory));
+   } else {
+       itsVisibilityCache.reset();
+   }
+}
+
+/// @brief configure checksums of the data
+/// @details If this option is set, iterators created by this data source compute checksums
+/// of visibility and flag cubes as they are read and add them to an aggregator shared
+/// by all iterators of this data source.
+/// @param[in] enable true to enable checksums, false to disable them (default)
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureChecksums(bool enable)
+{
+   if (enable) {
+       if (!itsChecksumAggregator) {
+           itsChecksumAggregator.reset(new DataChecksumAggregator);
+       }
+   } else {
+       itsChecksumAggregator.reset();
+   }
+}
+
+/// @brief configure per time stamp summaries of the data
+/// @details If this option is set, iterators created by this data source add summaries of
+/// the time stamps they read in full to a map shared by all iterators of this data source.
+/// @param[in] enable true to enable summaries, false to disable them (default)
+/// @param[in] persist if true, the summaries are loaded from and saved to a file next to
+///            the measurement set
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureChunkSummaries(bool enable, bool persist)
+{
+   if (enable) {
+       const std::string msName = table().tableName();
+       const std::string fileName = persist ? ChunkSummaryMap::defaultFileName(msName) : std::string();
+       if (!itsChunkSummaryMap || (itsChunkSummaryMap->fileName() != fileName)) {
+           itsChunkSummaryMap.reset(new ChunkSummaryMap(msName, fileName));
+       }
+   } else {
+       itsChunkSummaryMap.reset();
+   }
+}
+
+/// @brief configure the allocation policy for the cubes
+/// @details The storage for the cubes of the iterators created by this data source is
+/// allocated with the given policy.
+/// @param[in] allocator shared pointer to the allocator, empty pointer means the global heap (default)
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureArrayAllocator(const boost::shared_ptr<ArrayAllocator const> &allocator)
+{
+   itsArrayAllocator = allocator;
+}
+
+/// @brief configure the placement policy for the background threads
+/// @details The read-ahead and write-behind threads of the iterators created by this data
+/// source are pinned according to the given policy.
+/// @param[in] affinity placement policy, ThreadAffinity::NONE by default
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureThreadAffinity(const ThreadAffinity &affinity)
+{
+   itsThreadAffinity = affinity;
+}
+
+/// @brief set up the placement of the background threads and buffers of the iterator
+/// @details The thread affinity policy is resolved in the calling thread. The allocation
+/// policy configured explicitly takes precedence over the allocator of the affinity policy.
+/// @param[in] it iterator to set up
+void TableConstDataSource::setUpPlacement(TableConstDataIterator &it) const
+{
+   const ThreadAffinity affinity = itsThreadAffinity.resolve();
+   it.setThreadAffinity(affinity);
+   it.setArrayAllocator(itsArrayAllocator ? itsArrayAllocator : affinity.allocator());
+}
+
+/// @brief configure caching of rotated uvws and delays
+/// @details If this option is set, rotated uvws and delays computed by accessors of the
+/// iterators created by this data source are stored in a shared cache and reused when
+/// the same rows are read again with the same phase and tangent point.
+/// @param[in] enable true to enable caching, false to disable it (default)
+/// @param[in] maxBytes memory limit for the cache in bytes
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureUVWRotationCache(bool enable, size_t maxBytes)
+{
+   if (enable) {
+       itsUVWRotationCache.reset(new RotatedUVWCache(maxBytes));
+   } else {
+       itsUVWRotationCache.reset();
+   }
+}
+
+/// @brief configure computation of uvw from antenna positions
+/// @details If this option is set, iterators created by this data source compute uvws
+/// from the antenna positions, the phase centre and the epoch instead of reading the
+/// UVW column.
+/// @param[in] enable true to compute uvws, false to read the UVW column (default)
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configureComputedUVW(bool enable)
+{
+   itsComputedUVW = enable;
+}
+
+/// @brief configure the use of the POINTING subtable
+/// @details If this option is set, the whole POINTING subtable is read into a time-indexed
+/// cache shared by the iterators created by this data source and the dish pointing is
+/// interpolated for each antenna.
+/// @param[in] enable true to use the POINTING subtable, false to use FIELD subtable (default)
+/// @param[in] spillDir directory for a memory-mapped temporary file, empty string
+///            means the cache is always kept in memory
+/// @param[in] spillThreshold minimum size of the cache in bytes to spill it into the file
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableConstDataSource::configurePointingTable(bool enable, const std::string &spillDir,
+                                                  size_t spillThreshold)
+{
+   if (enable) {
+       boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+       itsPointingHandler.reset(new PointingSubtableHandler(table(), spillDir, spillThreshold));
+   } else {
+       itsPointingHandler.reset();
+   }
+}
+
+/// @brief share subtable handlers with another data source
+/// @details Handlers of the subtables which are identical in both measurement sets
+/// (ANTENNA, SPECTRAL_WINDOW, POLARIZATION and DATA_DESCRIPTION) are taken from the
+/// other data source instead of being built for this one (see
+/// SubtableInfoHolder::shareIdenticalSubtables). This is intended for a number of
+/// measurement sets observed with the same array. The method should be called before
+/// any iterator is created.
+/// @param[in] other data source to share the handlers with
+/// @return number of subtables shared
+size_t TableConstDataSource::shareIdenticalSubtables(const TableConstDataSource &other) const
+{
+   const SubtableInfoHolder *holder = dynamic_cast<const SubtableInfoHolder*>(&subtableInfo());
+   const SubtableInfoHolder *otherHolder = dynamic_cast<const SubtableInfoHolder*>(&other.subtableInfo());
+   if (!holder || !otherHolder || holder == otherHolder) {
+       return 0;
+   }
+   return holder->shareIdenticalSubtables(*otherHolder);
+}
+
+/// @brief body of the thread constructing subtable handlers
+/// @param[in] manager table manager holding the handlers
+/// @param[in] mutex mutex serialising table access
+/// @param[in] subtables handlers to construct (bitwise combination of
+///            ISubtableInfoHolder::Subtables values)
+/// @param[in] done promise to fulfil when all handlers are constructed
+static void preloadSubtables(const boost::shared_ptr<ITableManager const> &manager,
+                 const boost::shared_ptr<boost::recursive_mutex> &mutex, casacore::uInt subtables,
+                 const boost::shared_ptr<std::promise<void> > &done)
+{
+   try {
+      // one subtable at a time, so iterators are not blocked for the whole duration
+      for (casacore::uInt subtable = 1; subtable <= ISubtableInfoHolder::ALL_SUBTABLES; subtable <<= 1) {
+           if (subtables & subtable) {
+               boost::lock_guard<boost::recursive_mutex> lock(*mutex);
+               manager->preload(subtable);
+           }
+      }
+      done->set_value();
+   }
+   catch (...) {
+      done->set_exception(std::current_exception());
+   }
+}
+
+/// @brief construct subtable handlers in the background
+/// @details Handlers are normally constructed when first used, which delays the first
+/// iteration. This method reads the given subtables in a separate thread, so the work can
+/// overlap with other set up done by the caller. The table mutex (see tableMutex) is locked
+/// while each subtable is read.
+/// @param[in] subtables handlers to construct (bitwise combination of
+///            ISubtableInfoHolder::Subtables values)
+/// @return future becoming ready when all handlers are constructed, it rethrows the error
+///         encountered by the background thread, if any
+std::shared_future<void> TableConstDataSource::warmSubtables(casacore::uInt subtables) const
+{
+   const boost::shared_ptr<std::promise<void> > done(new std::promise<void>);
+   std::shared_future<void> result = done->get_future().share();
+   boost::thread thread(boost::bind(preloadSubtables, getTableManager(), itsTableMutex, subtables, done));
+   thread.detach();
+   return result;
+}
+
 /// @brief configure caching of the uvw-machines
 /// @details A number of uvw machines can be cached at the same time. This can
 /// result in a significant performance improvement in the mosaicing case. By default
@@ -125,7 +395,9 @@ void TableConstDataSource::configureUVWMachineCache(size_t cacheSize, double tol
 TableConstDataSource::TableConstDataSource() :
          TableInfoAccessor(boost::shared_ptr<ITableManager const>()),
          itsUVWCacheSize(1), itsUVWCacheTolerance(1e-6),
-         itsMaxChunkSize(INT_MAX) {} 
+         itsMaxChunkSize(INT_MAX), itsReadAhead(false), itsMaxChannelBlock(0),
+         itsUVDistanceIndex(false), itsConcurrentRead(false), itsComputedUVW(false),
+         itsTableMutex(new boost::recursive_mutex) {} 
 
 /// create a converter object corresponding to this type of the
 /// DataSource. The user can change converting policies (units,
@@ -178,9 +450,241 @@ TableConstDataSource::createConstIterator(const IDataSelectorConstPtr &sel,
        ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
                  "converter are received by the createConstIterator method");
    }
-   return boost::shared_ptr<IConstDataIterator>(new TableConstDataIterator(
+   boost::shared_ptr<TableConstDataIterator> it;
+   if (itsVisibilityCache) {
+       boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+       itsVisibilityCache->validate(table().tableName());
+       const boost::shared_ptr<ITableManager const> msManager = concurrentRead() ?
+             boost::shared_ptr<ITableManager const>(new TableManager(table(), false,
+                        getTableManager()->defaultDataColumnName())) : getTableManager();
+       it.reset(new CachedTableConstDataIterator(msManager,
+                implSel, implConv, itsVisibilityCache, uvwMachineCacheSize(), uvwMachineCacheTolerance(),
+                maxChunkSize(), maxChannelBlock(),
+                concurrentRead() ? itsTableMutex : boost::shared_ptr<boost::recursive_mutex>()));
+   } else if (concurrentRead()) {
+       // own manager means own stateful subtable caches, read-only handlers
+       // are shared via SubtableHandlerCache
+       boost::lock_guard<boost::recursive_mutex> lock(*itsTableMutex);
+       const boost::shared_ptr<ITableManager const> msManager(new TableManager(table(), false,
+                                     getTableManager()->defaultDataColumnName()));
+       it.reset(new TableConstDataIterator(msManager,
+                implSel, implConv, uvwMachineCacheSize(), uvwMachineCacheTolerance(),
+                maxChunkSize(), readAhead(), maxChannelBlock(), itsTableMutex));
+   } else {
+       it.reset(new TableConstDataIterator(
                 getTableManager(),implSel,implConv,uvwMachineCacheSize(), uvwMachineCacheTolerance(),
-                maxChunkSize()));
+                maxChunkSize(), readAhead(), maxChannelBlock()));
+   }
+   it->setChecksumAggregator(itsChecksumAggregator);
+   it->setChunkSummaryMap(itsChunkSummaryMap);
+   it->setRotatedUVWCache(itsUVWRotationCache);
+   it->setPointingHandler(itsPointingHandler);
+   it->setComputedUVW(computedUVW());
+   setUpPlacement(*it);
+   return it;
+}
+
+/// @brief get iterator positioned at the given cycle
+/// @details The iterator is created with createConstIterator and moved to the first
+/// accessor of the given cycle without reading the preceding data.
+/// @param[in] sel a shared pointer to the selector object defining
+///            which subset of the data is used
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @param[in] cycle 0-based index of the time step
+/// @return a shared pointer to the iterator
+boost::shared_ptr<TableConstDataIterator>
+TableConstDataSource::createConstIteratorAtCycle(const IDataSelectorConstPtr &sel,
+              const IDataConverterConstPtr &conv, casacore::uInt cycle) const
+{
+   const boost::shared_ptr<TableConstDataIterator> it =
+         boost::dynamic_pointer_cast<TableConstDataIterator>(createConstIterator(sel, conv));
+   ASKAPDEBUGASSERT(it);
+   it->seekCycle(cycle);
+   return it;
+}
+
+/// @brief get iterator positioned at the start of the given scan
+/// @details The iterator is created with createConstIterator and moved to the first
+/// cycle of the given scan.
+/// @param[in] sel a shared pointer to the selector object defining
+///            which subset of the data is used
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @param[in] scan scan number
+/// @return a shared pointer to the iterator
+boost::shared_ptr<TableConstDataIterator>
+TableConstDataSource::createConstIteratorAtScan(const IDataSelectorConstPtr &sel,
+              const IDataConverterConstPtr &conv, casacore::uInt scan) const
+{
+   const boost::shared_ptr<TableConstDataIterator> it =
+         boost::dynamic_pointer_cast<TableConstDataIterator>(createConstIterator(sel, conv));
+   ASKAPDEBUGASSERT(it);
+   it->seekScan(scan);
+   return it;
+}
+
+/// @brief get iterator over the metadata columns
+/// @details The iterator reads time, antenna indices, uvw and row flags of the main
+/// table in blocks of rows without setting up accessors (see TableMetaDataIterator).
+/// Selection and conversion are not applied, which is sufficient for planning passes.
+/// If concurrent read is enabled, access to the table is serialised via tableMutex.
+/// @param[in] blockSize maximum number of rows read at a time
+/// @return a shared pointer to the iterator
+boost::shared_ptr<TableMetaDataIterator>
+TableConstDataSource::createMetaDataIterator(casacore::uInt blockSize) const
+{
+   return boost::shared_ptr<TableMetaDataIterator>(new TableMetaDataIterator(table(), blockSize,
+                concurrentRead() ? itsTableMutex : boost::shared_ptr<boost::recursive_mutex>()));
+}
+
+/// @brief get independent iterators, one per spectral window
+/// @details This method splits the selection by spectral window present in the
+/// main table and creates an iterator for each of them. Each iterator has its own
+/// table iterator and its own subtable caches, so the iterators can be used concurrently
+/// from different threads. Access to the measurement set is serialised via a mutex
+/// shared between these iterators.
+/// @param[in] sel a shared pointer to the selector object defining
+///            which subset of the data is used
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @return a vector of pairs, the first element is the spectral window ID, the second
+///         is the iterator
+std::vector<std::pair<casacore::uInt, boost::shared_ptr<IConstDataIterator> > >
+TableConstDataSource::createConstIterators(const IDataSelectorConstPtr &sel,
+              const IDataConverterConstPtr &conv) const
+{
+   boost::shared_ptr<TableDataSelector const> tabSel =
+           boost::dynamic_pointer_cast<TableDataSelector const>(sel);
+   boost::shared_ptr<IDataConverterImpl const> implConv=
+           boost::dynamic_pointer_cast<IDataConverterImpl const>(conv);
+   if (!tabSel || !implConv) {
+       ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
+                 "converter are received by the createConstIterators method");
+   }
+   const boost::shared_ptr<boost::recursive_mutex> tableMutex(concurrentRead() ? itsTableMutex :
+                             boost::shared_ptr<boost::recursive_mutex>(new boost::recursive_mutex));
+   boost::lock_guard<boost::recursive_mutex> lock(*tableMutex);
+   // spectral windows actually present in the main table
+   std::set<casacore::uInt> spWindows;
+   {
+     const casacore::Vector<casacore::Int> ddIDs =
+             casacore::ROScalarColumn<casacore::Int>(table(), "DATA_DESC_ID").getColumn();
+     std::set<casacore::Int> uniqueDDIDs(ddIDs.begin(), ddIDs.end());
+     for (std::set<casacore::Int>::const_iterator ci = uniqueDDIDs.begin(); ci != uniqueDDIDs.end(); ++ci) {
+          ASKAPCHECK(*ci >= 0, "Negative DATA_DESC_ID encountered in the main table");
+          const int spWindow = subtableInfo().getDataDescription().getSpectralWindowID(*ci);
+          ASKAPCHECK(spWindow >= 0, "Negative spectral window ID encountered for DATA_DESC_ID="<<*ci);
+          spWindows.insert(casacore::uInt(spWindow));
+     }
+   }
+
+   std::vector<std::pair<casacore::uInt, boost::shared_ptr<IConstDataIterator> > > result;
+   result.reserve(spWindows.size());
+   for (std::set<casacore::uInt>::const_iterator ci = spWindows.begin(); ci != spWindows.end(); ++ci) {
+        boost::shared_ptr<TableDataSelector> spWinSel(new TableDataSelector(*tabSel));
+        spWinSel->chooseSpectralWindow(*ci);
+        // own manager means own subtable caches
+        const boost::shared_ptr<ITableManager const> msManager(new TableManager(table(), false,
+                                      getTableManager()->defaultDataColumnName()));
+        const boost::shared_ptr<TableConstDataIterator> it(new TableConstDataIterator(msManager,
+                spWinSel, implConv, uvwMachineCacheSize(), uvwMachineCacheTolerance(),
+                maxChunkSize(), readAhead(), maxChannelBlock(), tableMutex));
+        it->setChecksumAggregator(itsChecksumAggregator);
+        it->setChunkSummaryMap(itsChunkSummaryMap);
+        it->setRotatedUVWCache(itsUVWRotationCache);
+        it->setPointingHandler(itsPointingHandler);
+        it->setComputedUVW(computedUVW());
+        setUpPlacement(*it);
+        result.push_back(std::pair<casacore::uInt, boost::shared_ptr<IConstDataIterator> >(*ci, it));
+   }
+   return result;
+}
+
+namespace {
+
+/// @brief helper class to process the iterators in a number of threads
+/// @details Each thread takes the next unprocessed iterator until none is left.
+struct SpWindowProcessor {
+   /// @brief type of the job list
+   typedef std::vector<std::pair<casacore::uInt, boost::shared_ptr<IConstDataIterator> > > JobList;
+
+   /// @brief constructor
+   /// @param[in] jobs iterators to process
+   /// @param[in] func function to call for each iterator
+   SpWindowProcessor(const JobList &jobs,
+             const boost::function<void(casacore::uInt, IConstDataIterator&)> &func) :
+             itsJobs(jobs), itsFunc(func), itsNextJob(0) {}
+
+   /// @brief thread entry point
+   void run() {
+      for (size_t job = nextJob(); job < itsJobs.size(); job = nextJob()) {
+           try {
+              ASKAPDEBUGASSERT(itsJobs[job].second);
+              itsFunc(itsJobs[job].first, *(itsJobs[job].second));
+           }
+           catch (...) {
+              boost::lock_guard<boost::mutex> lock(itsMutex);
+              if (!itsException) {
+                  itsException = std::current_exception();
+              }
+           }
+      }
+   }
+
+   /// @brief rethrow the first exception caught in the threads, if any
+   void rethrow() const {
+      if (itsException) {
+          std::rethrow_exception(itsException);
+      }
+   }
+
+private:
+   /// @brief obtain the next job index
+   /// @return index of the job to process, itsJobs.size() if nothing is left
+   size_t nextJob() {
+      boost::lock_guard<boost::mutex> lock(itsMutex);
+      return itsNextJob < itsJobs.size() ? itsNextJob++ : itsJobs.size();
+   }
+
+   /// @brief iterators to process
+   const JobList &itsJobs;
+   /// @brief function to call
+   const boost::function<void(casacore::uInt, IConstDataIterator&)> &itsFunc;
+   /// @brief index of the next job
+   size_t itsNextJob;
+   /// @brief first exception caught
+   std::exception_ptr itsException;
+   /// @brief mutex protecting the job counter and the exception
+   boost::mutex itsMutex;
+};
+
+} // anonymous namespace
+
+/// @brief process spectral windows in parallel
+/// @details This method creates iterators via createConstIterators and passes them
+/// to the given function, running at most nThreads calls at the same time.
+/// @param[in] sel a shared pointer to the selector object defining
+///            which subset of the data is used
+/// @param[in] conv a shared pointer to the converter object defining
+///            reference frames and units to be used
+/// @param[in] nThreads maximum number of threads to use
+/// @param[in] func function to call for each spectral window
+void TableConstDataSource::processSpectralWindows(const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, casacore::uInt nThreads,
+             const boost::function<void(casacore::uInt, IConstDataIterator&)> &func) const
+{
+   ASKAPCHECK(nThreads > 0, "Number of threads should be a positive number");
+   const SpWindowProcessor::JobList jobs = createConstIterators(sel, conv);
+   SpWindowProcessor processor(jobs, func);
+   boost::thread_group threads;
+   for (casacore::uInt thread = 1; (thread < nThreads) && (thread < jobs.size()); ++thread) {
+        threads.create_thread(boost::bind(&SpWindowProcessor::run, &processor));
+   }
+   // the calling thread does its share of work too
+   processor.run();
+   threads.join_all();
+   processor.rethrow();
 }
 
 /// create a selector object corresponding to this type of the
@@ -200,6 +704,8 @@ TableConstDataSource::createConstIterator(const IDataSelectorConstPtr &sel,
 /// iteration loop is started).
 IDataSelectorPtr TableConstDataSource::createSelector() const
 {
-  return IDataSelectorPtr(new TableDataSelector(getTableManager()));
+  boost::shared_ptr<TableDataSelector> sel(new TableDataSelector(getTableManager()));
+  sel->useUVDistanceIndex(itsUVDistanceIndex);
+  return sel;
 }
 
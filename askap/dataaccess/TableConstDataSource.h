@@ -34,6 +34,8 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/recursive_mutex.hpp>
 
 // casa includes
 #include <casacore/tables/Tables/Table.h>
@@ -41,9 +43,21 @@
 // own includes
 #include <askap/dataaccess/IConstDataSource.h>
 #include <askap/dataaccess/TableInfoAccessor.h>
+#include <askap/dataaccess/TableConstDataIterator.h>
+#include <askap/dataaccess/TableMetaDataIterator.h>
+#include <askap/dataaccess/VisibilityCache.h>
+#include <askap/dataaccess/DataChecksum.h>
+#include <askap/dataaccess/ChunkSummaryMap.h>
+#include <askap/dataaccess/RotatedUVWCache.h>
+#include <askap/dataaccess/PointingSubtableHandler.h>
+#include <askap/dataaccess/CompactVisibility.h>
+#include <askap/dataaccess/ArrayAllocator.h>
+#include <askap/dataaccess/ThreadAffinity.h>
 
 // std includes
 #include <string>
+#include <vector>
+#include <future>
 
 namespace askap {
 
@@ -53,6 +67,24 @@ namespace accessors {
 /// @details
 /// TableConstDataSource: Allow read-only access to the data stored in the
 /// measurement set. This class implements IConstDataSource interface.
+///
+/// By default, all iterators share subtable caches and the table objects held by
+/// this data source, so they can only be used from one thread at a time. If the
+/// concurrent-read mode is enabled (see configureConcurrentRead), iterators can be
+/// created and used in different threads at the same time:
+///   - the state which doesn't change after construction (read-only subtable handlers,
+///     see SubtableHandlerCache) is shared between all iterators;
+///   - the state which changes during the iteration (table iterator, accessor caches,
+///     converter, FEED and FIELD handlers, selection and direction caches) is owned
+///     by each iterator;
+///   - all access to the measurement set is serialised via a single mutex (see
+///     tableMutex), because casacore tables are not thread-safe.
+///
+/// A single iterator (and the accessor obtained from it) is still meant to be used by
+/// one thread at a time. Selectors and converters passed to createConstIterator are
+/// cloned by the iterator, so they can be reused once the iterator is created. However,
+/// some choose* methods of the selector read the measurement set, so they should either
+/// be called before other threads start iterating or while holding tableMutex.
 /// @ingroup dataaccess_tab
 class TableConstDataSource : virtual public IConstDataSource,
                              virtual protected TableInfoAccessor
@@ -107,6 +139,77 @@ public:
   
   // we need this to get access to the overloaded syntax in the base class 
   using IConstDataSource::createConstIterator;
+
+  /// @brief get iterator positioned at the given cycle
+  /// @details The iterator is created with createConstIterator and moved to the first
+  /// accessor of the given cycle (0-based time step of the selected data) via the
+  /// iteration plan, without reading the preceding data (see TableConstDataIterator::seekCycle).
+  /// The iteration can be continued from there. An exception is thrown if there is no such cycle.
+  /// @param[in] sel a shared pointer to the selector object defining
+  ///            which subset of the data is used
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @param[in] cycle 0-based index of the time step
+  /// @return a shared pointer to the iterator
+  boost::shared_ptr<TableConstDataIterator> createConstIteratorAtCycle(const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, casacore::uInt cycle) const;
+
+  /// @brief get iterator positioned at the start of the given scan
+  /// @details The iterator is created with createConstIterator and moved to the first
+  /// cycle of the given scan (see TableConstDataIterator::seekScan). An exception is thrown
+  /// if there are no selected data for this scan.
+  /// @param[in] sel a shared pointer to the selector object defining
+  ///            which subset of the data is used
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @param[in] scan scan number
+  /// @return a shared pointer to the iterator
+  boost::shared_ptr<TableConstDataIterator> createConstIteratorAtScan(const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, casacore::uInt scan) const;
+
+  /// @brief get iterator over the metadata columns
+  /// @details The iterator reads time, antenna indices, uvw and row flags of the main
+  /// table in blocks of rows without setting up accessors (see TableMetaDataIterator).
+  /// Selection and conversion are not applied, which is sufficient for planning passes.
+  /// If concurrent read is enabled, access to the table is serialised via tableMutex.
+  /// @param[in] blockSize maximum number of rows read at a time
+  /// @return a shared pointer to the iterator
+  boost::shared_ptr<TableMetaDataIterator> createMetaDataIterator(casacore::uInt blockSize = 65536) const;
+
+  /// @brief get independent iterators, one per spectral window
+  /// @details This method splits the selection by spectral window present in the
+  /// main table and creates an iterator for each of them. Each iterator has its own
+  /// table iterator and its own subtable caches, so the iterators can be used concurrently
+  /// from different threads. Access to the measurement set is serialised via a mutex
+  /// shared between these iterators (casacore tables are not thread-safe), processing of the
+  /// data in the accessors is not. Spectral window selection set up in the given selector
+  /// is combined with the selection done by this method, i.e. iterators for other spectral
+  /// windows will be empty.
+  /// @param[in] sel a shared pointer to the selector object defining
+  ///            which subset of the data is used
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @return a vector of pairs, the first element is the spectral window ID, the second
+  ///         is the iterator
+  std::vector<std::pair<casacore::uInt, boost::shared_ptr<IConstDataIterator> > >
+         createConstIterators(const IDataSelectorConstPtr &sel,
+                              const IDataConverterConstPtr &conv) const;
+
+  /// @brief process spectral windows in parallel
+  /// @details This method creates iterators via createConstIterators and passes them
+  /// to the given function, running at most nThreads calls at the same time. The function
+  /// is called once for each spectral window. If any of the calls throws an exception, the
+  /// first exception is rethrown after all threads have finished.
+  /// @param[in] sel a shared pointer to the selector object defining
+  ///            which subset of the data is used
+  /// @param[in] conv a shared pointer to the converter object defining
+  ///            reference frames and units to be used
+  /// @param[in] nThreads maximum number of threads to use
+  /// @param[in] func function to call for each spectral window, the parameters are the
+  ///            spectral window ID and the iterator for it (the iterator is at the start)
+  void processSpectralWindows(const IDataSelectorConstPtr &sel,
+             const IDataConverterConstPtr &conv, casacore::uInt nThreads,
+             const boost::function<void(casacore::uInt, IConstDataIterator&)> &func) const;
  
   /// create a selector object corresponding to this type of the
   /// DataSource
@@ -144,6 +247,228 @@ public:
   /// affect iterators already created
   void configureMaxChunkSize(casacore::uInt maxNumRows);
 
+  /// @brief configure read-ahead of the data
+  /// @details If read-ahead is enabled, visibilities, flags and uvw for the next chunk
+  /// are read by a background thread while the current chunk is being processed. This
+  /// allows I/O to overlap with computation at the expense of holding one extra chunk in memory.
+  /// Table access is serialised within each iterator, so the background thread and the 
+  /// consumer never work with the table at the same time. However, there is no synchronisation
+  /// between different iterators, so other iterators should not be used on the same dataset
+  /// while a read-ahead iterator is active.
+  /// @param[in] readAhead true to enable read-ahead, false to disable it (default)
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureReadAhead(bool readAhead);
+
+  /// @brief configure splitting of the spectral axis
+  /// @details For very wide spectra the visibility cube of a single time step may not fit
+  /// into the memory budget even if the number of rows is restricted. If this option is set,
+  /// each chunk of rows is delivered as several accessors, each covering a block of
+  /// consecutive channels of the selection. The memory footprint of the cubes is then
+  /// about nRow x maxNumChannels x nPol elements per accessor. Read-ahead is not done if
+  /// the spectral axis is split.
+  /// @param[in] maxNumChannels maximum number of channels per accessor, 0 means no
+  /// restriction (default)
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureMaxChannelBlock(casacore::uInt maxNumChannels);
+
+  /// @brief configure uv-distance selection
+  /// @details If this option is set, uv-distances of all rows are computed and sorted
+  /// once per data source when the first uv-distance selection is done. Subsequent
+  /// selections on the uv-distance (e.g. different uv-cuts of the same dataset) are then
+  /// done via binary search rather than by evaluating a table expression for every row.
+  /// This costs about 16 bytes of memory per row of the measurement set.
+  /// @param[in] useIndex true to use the index, false to use table expressions (default)
+  /// @note The new setting will apply to any selector created in the future, but will not
+  /// affect selectors already created
+  void configureUVDistanceIndex(bool useIndex);
+
+  /// @brief configure concurrent-read mode
+  /// @details If this option is set, each iterator created by createConstIterator
+  /// gets its own table manager (and, therefore, its own stateful subtable caches) and
+  /// all iterators serialise table access via the mutex returned by tableMutex. This
+  /// allows a number of threads to iterate over this data source at the same time
+  /// (see the class description for details). Iterators created by createConstIterators
+  /// use the same mutex in this mode.
+  /// @param[in] concurrentRead true to enable concurrent-read mode, false to disable it (default)
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureConcurrentRead(bool concurrentRead);
+
+  /// @brief mutex serialising table access in the concurrent-read mode
+  /// @details Code accessing the measurement set (or the selectors created by this
+  /// data source) outside of the iterators should lock this mutex while other threads
+  /// may be iterating.
+  /// @return shared pointer to the mutex, the same for the lifetime of the data source
+  inline const boost::shared_ptr<boost::recursive_mutex>& tableMutex() const {return itsTableMutex;}
+
+  /// @brief configure caching of visibilities and flags
+  /// @details If this option is set, iterators created by createConstIterator keep
+  /// visibilities and flags read in the first iteration in a cache shared by all iterators
+  /// of this data source (see VisibilityCache). Subsequent iterations with the same selection
+  /// (e.g. major cycles of imaging) take the data from the cache instead of the measurement set.
+  /// Visibilities are quantised to 16 bits per component, including the first iteration, so
+  /// all iterations see the same data. The cache is discarded if the measurement set is
+  /// modified. Read-ahead is not done by caching iterators.
+  /// @param[in] enable true to enable caching, false to disable it and release the cache (default)
+  /// @param[in] precision precision of cached visibilities
+  /// @param[in] directory directory for the cache file, visibilities are kept in memory if empty
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureVisibilityCache(bool enable, CompactVisibility::Precision precision = CompactVisibility::INT16,
+                                const std::string &directory = "");
+
+  /// @brief visibility cache used by the iterators
+  /// @return shared pointer to the cache, empty if caching is disabled
+  inline const boost::shared_ptr<VisibilityCache>& visibilityCache() const {return itsVisibilityCache;}
+
+  /// @brief configure checksums of the data
+  /// @details If this option is set, iterators created by this data source compute checksums
+  /// of visibility and flag cubes as they are read (see TableConstDataIterator::visibilityChecksum
+  /// and TableConstDataIterator::flagChecksum). Checksums of all chunks are combined in an
+  /// aggregator shared by all iterators of this data source, which allows integrity checks
+  /// without a separate pass over the data. The combined checksum doesn't depend on the order
+  /// in which the chunks are read, but chunks read more than once contribute each time.
+  /// Enabling checksums again keeps the aggregator accumulated so far.
+  /// @param[in] enable true to enable checksums, false to disable them and release the aggregator (default)
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureChecksums(bool enable);
+
+  /// @brief checksums of the data read so far
+  /// @return shared pointer to the aggregator, empty if checksums are disabled
+  inline const boost::shared_ptr<DataChecksumAggregator>& checksums() const {return itsChecksumAggregator;}
+
+  /// @brief configure per time stamp summaries of the data
+  /// @details If this option is set, iterators created by this data source record a summary
+  /// (number of rows and samples, number of flagged samples, uv-distance and w ranges and the
+  /// field) of each time stamp they read in full, i.e. when the flags are read with an empty
+  /// selection. Summaries are available through TableConstDataIterator::currentChunkSummary
+  /// to any iterator created by this data source, regardless of its selection, so the consumers
+  /// can skip fully flagged or out of range time stamps without reading the visibility cube.
+  /// If persisted, the summaries are saved to a file next to the measurement set (see
+  /// ChunkSummaryMap::defaultFileName) and are ignored if the measurement set has been
+  /// modified since. Enabling summaries again keeps the map accumulated so far.
+  /// @param[in] enable true to enable summaries, false to disable them and release the map (default)
+  /// @param[in] persist if true, the summaries are loaded from and saved to a file
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureChunkSummaries(bool enable, bool persist = true);
+
+  /// @brief summaries of the time stamps read so far
+  /// @return shared pointer to the map, empty if summaries are disabled
+  inline const boost::shared_ptr<ChunkSummaryMap>& chunkSummaries() const {return itsChunkSummaryMap;}
+
+  /// @brief configure the allocation policy for the cubes
+  /// @details The storage for visibility, flag and noise cubes and uvw vectors of the iterators
+  /// created by this data source is allocated with the given policy (see ArrayAllocator), e.g.
+  /// bound to the NUMA node of the thread processing the data or page-locked for an upload
+  /// to an accelerator (see PinnedArrayAllocator and DeviceUploadStage). The storage of the cubes
+  /// read ahead in the background is allocated by the thread advancing the iterator.
+  /// @param[in] allocator shared pointer to the allocator, empty pointer means the global heap (default)
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureArrayAllocator(const boost::shared_ptr<ArrayAllocator const> &allocator);
+
+  /// @brief allocation policy for the cubes of the iterators
+  /// @return shared pointer to the allocator, empty for the global heap
+  inline const boost::shared_ptr<ArrayAllocator const>& arrayAllocator() const {return itsArrayAllocator;}
+
+  /// @brief configure the placement policy for the background threads
+  /// @details The read-ahead and write-behind threads of the iterators created by this data
+  /// source are pinned according to the given policy (see ThreadAffinity). The CONSUMER policy
+  /// is resolved when the iterator is created, i.e. the threads are pinned to the socket of
+  /// the thread creating the iterator. Unless the allocation policy is configured explicitly
+  /// (see configureArrayAllocator), the cubes are bound to the same NUMA node.
+  /// @param[in] affinity placement policy, ThreadAffinity::NONE by default
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureThreadAffinity(const ThreadAffinity &affinity);
+
+  /// @brief placement policy for the background threads of the iterators
+  /// @return placement policy
+  inline const ThreadAffinity& threadAffinity() const {return itsThreadAffinity;}
+
+  /// @brief configure caching of rotated uvws and delays
+  /// @details If this option is set, rotated uvws and delays computed by accessors of the
+  /// iterators created by this data source are stored in a cache shared by these iterators
+  /// and reused when the same rows are read again with the same phase and tangent point
+  /// (e.g. in the next major cycle). The least recently used entries are dropped if the
+  /// memory limit is exceeded. The cache is keyed by rows and doesn't notice if the uvw
+  /// column is modified, so it shouldn't be used if the data are updated in place.
+  /// @param[in] enable true to enable caching, false to disable it and release the cache (default)
+  /// @param[in] maxBytes memory limit for the cache in bytes
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureUVWRotationCache(bool enable, size_t maxBytes = 256u * 1024u * 1024u);
+
+  /// @brief cache of rotated uvws and delays used by the iterators
+  /// @return shared pointer to the cache, empty if caching is disabled
+  inline const boost::shared_ptr<RotatedUVWCache>& uvwRotationCache() const {return itsUVWRotationCache;}
+
+  /// @brief configure computation of uvw from antenna positions
+  /// @details If this option is set, iterators created by this data source don't read the
+  /// UVW column. Instead, uvws are computed from the antenna positions of the ANTENNA subtable,
+  /// the phase centre of the FIELD subtable and the epoch (see AntennaUVWCalculator). This
+  /// saves 24 bytes of I/O per row. Antenna positions are converted once per time step, so the
+  /// extra computation is proportional to the number of antennas rather than baselines. The
+  /// results follow the casacore model and can differ slightly from a UVW column written by
+  /// other software. In the debug mode, the iterators compare the result with the UVW column
+  /// and log a warning if they disagree.
+  /// @param[in] enable true to compute uvws, false to read the UVW column (default)
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureComputedUVW(bool enable);
+
+  /// @brief current setting of uvw computation
+  /// @return true, if the iterators created in the future compute uvw from the antenna positions
+  inline bool computedUVW() const {return itsComputedUVW;}
+
+  /// @brief configure the use of the POINTING subtable
+  /// @details By default, the reference direction of the FIELD subtable is used as the dish
+  /// pointing direction for all antennas. If this option is set, the whole POINTING subtable
+  /// is read into a time-indexed cache (see PointingSubtableHandler) and the dish pointing
+  /// is interpolated for each antenna. This is useful for on-the-fly mosaicing observations.
+  /// The cache is shared by all iterators created by this data source.
+  /// @param[in] enable true to use the POINTING subtable, false to use FIELD subtable (default)
+  /// @param[in] spillDir directory for a memory-mapped temporary file, empty string (default)
+  ///            means the cache is always kept in memory
+  /// @param[in] spillThreshold minimum size of the cache in bytes to spill it into the file
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configurePointingTable(bool enable, const std::string &spillDir = std::string(),
+                              size_t spillThreshold = 64u * 1024u * 1024u);
+
+  /// @brief handler of the POINTING subtable used by the iterators
+  /// @return shared pointer to the handler, empty if the FIELD subtable is used
+  inline const boost::shared_ptr<PointingSubtableHandler const>& pointingHandler() const
+       {return itsPointingHandler;}
+
+  /// @brief share subtable handlers with another data source
+  /// @details Handlers of the subtables which are identical in both measurement sets
+  /// (ANTENNA, SPECTRAL_WINDOW, POLARIZATION and DATA_DESCRIPTION) are taken from the
+  /// other data source instead of being built for this one (see
+  /// SubtableInfoHolder::shareIdenticalSubtables). This is intended for a number of
+  /// measurement sets observed with the same array. The method should be called before
+  /// any iterator is created.
+  /// @param[in] other data source to share the handlers with
+  /// @return number of subtables shared
+  size_t shareIdenticalSubtables(const TableConstDataSource &other) const;
+
+  /// @brief construct subtable handlers in the background
+  /// @details Handlers are normally constructed when first used, which delays the first
+  /// iteration. This method reads the given subtables in a separate thread, so the work can
+  /// overlap with other set up done by the caller. The table mutex (see tableMutex) is locked
+  /// while each subtable is read. The thread keeps the table manager alive, so the data source
+  /// can be destroyed before the warming is finished. Handlers constructed by iterators using
+  /// their own table manager (concurrent-read mode) are not affected.
+  /// @param[in] subtables handlers to construct (bitwise combination of
+  ///            ISubtableInfoHolder::Subtables values)
+  /// @return future becoming ready when all handlers are constructed, it rethrows the error
+  ///         encountered by the background thread, if any
+  std::shared_future<void> warmSubtables(casacore::uInt subtables = ISubtableInfoHolder::ALL_SUBTABLES) const;
+
   /// @brief obtain the position of the given antenna
   /// @details
   /// @param[in] antID antenna index to use, matches indices in the data table
@@ -185,6 +510,25 @@ protected:
   /// @brief current restriction on the chunk size
   /// @return maximum number of rows in the accessor (the current setting, affects future iterators)
   inline casacore::uInt maxChunkSize() const {return itsMaxChunkSize;}
+
+  /// @brief current read-ahead setting
+  /// @return true, if the iterators created in the future will read the next chunk in the background
+  inline bool readAhead() const {return itsReadAhead;}
+
+  /// @brief current restriction on the number of channels per accessor
+  /// @return maximum number of channels in the accessor, 0 means no restriction
+  inline casacore::uInt maxChannelBlock() const {return itsMaxChannelBlock;}
+
+  /// @brief current concurrent-read setting
+  /// @return true, if the iterators created in the future have their own table managers
+  /// and share the table mutex
+  inline bool concurrentRead() const {return itsConcurrentRead;}
+
+  /// @brief set up the placement of the background threads and buffers of the iterator
+  /// @details The thread affinity policy is resolved in the calling thread. The allocation
+  /// policy configured explicitly takes precedence over the allocator of the affinity policy.
+  /// @param[in] it iterator to set up
+  void setUpPlacement(TableConstDataIterator &it) const;
   
 private:
   /// @brief a number of uvw machines in the cache (default is 1)
@@ -205,6 +549,57 @@ private:
   /// processing chain which do data copy (usually in the temporary code/hacks which technically shouldn't
   /// stay long term in the ideal case).
   casacore::uInt itsMaxChunkSize;
+
+  /// @brief true, if the const iterators read the next chunk in the background
+  /// @details This is false by default. See configureReadAhead for details.
+  bool itsReadAhead;
+
+  /// @brief maximum number of channels per accessor
+  /// @details This is 0 by default, which means no restriction. See configureMaxChannelBlock.
+  casacore::uInt itsMaxChannelBlock;
+
+  /// @brief true, if selectors use the row index for uv-distance selection
+  /// @details This is false by default. See configureUVDistanceIndex.
+  bool itsUVDistanceIndex;
+
+  /// @brief true, if the iterators can be used from different threads at the same time
+  /// @details This is false by default. See configureConcurrentRead.
+  bool itsConcurrentRead;
+
+  /// @brief true, if the iterators compute uvw from the antenna positions
+  /// @details This is false by default. See configureComputedUVW.
+  bool itsComputedUVW;
+
+  /// @brief mutex serialising table access in the concurrent-read mode
+  boost::shared_ptr<boost::recursive_mutex> itsTableMutex;
+
+  /// @brief cache of visibilities and flags, empty if caching is disabled
+  /// @details See configureVisibilityCache.
+  boost::shared_ptr<VisibilityCache> itsVisibilityCache;
+
+  /// @brief checksums of the data read by the iterators, empty if checksums are disabled
+  /// @details See configureChecksums.
+  boost::shared_ptr<DataChecksumAggregator> itsChecksumAggregator;
+
+  /// @brief summaries of the time stamps, empty if summaries are disabled
+  /// @details See configureChunkSummaries.
+  boost::shared_ptr<ChunkSummaryMap> itsChunkSummaryMap;
+
+  /// @brief cache of rotated uvws and delays, empty if caching is disabled
+  /// @details See configureUVWRotationCache.
+  boost::shared_ptr<RotatedUVWCache> itsUVWRotationCache;
+
+  /// @brief handler of the POINTING subtable, empty if the FIELD subtable is used
+  /// @details See configurePointingTable.
+  boost::shared_ptr<PointingSubtableHandler const> itsPointingHandler;
+
+  /// @brief allocation policy for the cubes, empty for the global heap
+  /// @details See configureArrayAllocator.
+  boost::shared_ptr<ArrayAllocator const> itsArrayAllocator;
+
+  /// @brief placement policy for the background threads
+  /// @details See configureThreadAffinity.
+  ThreadAffinity itsThreadAffinity;
 };
  
 } // namespace accessors
@@ -34,6 +34,7 @@
 /// own includes
 #include <askap/dataaccess/TableDataAccessor.h>
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -108,17 +109,83 @@ casacore::Cube<casacore::Bool>& TableDataAccessor::rwFlag()
    return const_cast<casacore::Cube<casacore::Bool>&>(getROAccessor().flag());
 }
 
+/// @brief replace flags of a range of rows
+/// @details Only the rows updated this way (or flagged with flagRows) are
+/// written back, unless rwFlag has been called for the same iteration.
+/// @param[in] row first row to update
+/// @param[in] flags nRowsToUpdate x nChannel x nPol cube with new flags
+void TableDataAccessor::updateFlags(casacore::uInt row, const casacore::Cube<casacore::Bool> &flags)
+{
+   if (!itsIterator.mainTableWritable()) {
+       throw DataAccessLogicError("updateFlags() is used for original visibilities, "
+           "but the table is not writable");
+   }
+   // see rwFlag for the reason why const_cast is safe here
+   casacore::Cube<casacore::Bool> &cube = const_cast<casacore::Cube<casacore::Bool>&>(getROAccessor().flag());
+   ASKAPCHECK(row + flags.nrow() <= cube.nrow(), "Rows "<<row<<" to "<<row + flags.nrow()<<
+              " are outside the accessor with "<<cube.nrow()<<" rows");
+   ASKAPCHECK(flags.ncolumn() == cube.ncolumn() && flags.nplane() == cube.nplane(),
+              "Flags to update have "<<flags.ncolumn()<<" channels and "<<flags.nplane()<<
+              " polarisations, the accessor has "<<cube.ncolumn()<<" and "<<cube.nplane());
+   if (flags.nelements() == 0) {
+       return;
+   }
+   cube(casacore::IPosition(3, row, 0, 0), casacore::IPosition(3, row + flags.nrow() - 1,
+        cube.ncolumn() - 1, cube.nplane() - 1)) = flags;
+   itsChangedFlagRows.add(row, flags.nrow());
+}
+
+/// @brief flag whole rows
+/// @details FLAG_ROW is set for these rows (if the column exists) and the
+/// cells of the FLAG column are filled in bulk.
+/// @param[in] row first row to flag
+/// @param[in] nRows number of rows to flag
+void TableDataAccessor::flagRows(casacore::uInt row, casacore::uInt nRows)
+{
+   if (!itsIterator.mainTableWritable()) {
+       throw DataAccessLogicError("flagRows() is used for original visibilities, "
+           "but the table is not writable");
+   }
+   casacore::Cube<casacore::Bool> &cube = const_cast<casacore::Cube<casacore::Bool>&>(getROAccessor().flag());
+   ASKAPCHECK(row + nRows <= cube.nrow(), "Rows "<<row<<" to "<<row + nRows<<
+              " are outside the accessor with "<<cube.nrow()<<" rows");
+   if (nRows == 0 || cube.nelements() == 0) {
+       return;
+   }
+   cube(casacore::IPosition(3, row, 0, 0), casacore::IPosition(3, row + nRows - 1,
+        cube.ncolumn() - 1, cube.nplane() - 1)) = casacore::True;
+   itsFlaggedRows.add(row, nRows);
+}
+
 
 /// this method flush back the data to disk if there are any changes
 void TableDataAccessor::sync() const
 {
+  // rwFlag gives access to the whole cube, so all rows have to be written then
+  if (itsFlagNeedsFlush) {
+      itsChangedFlagRows.add(0, nRow());
+  }
+  if (itsIterator.writeBehindEnabled()) {
+      // the writer thread works with copies of the cubes, flags can be reset straight away
+      const bool writeVis = itsVisNeedsFlush;
+      itsVisNeedsFlush = false;
+      itsFlagNeedsFlush = false;
+      itsIterator.scheduleWrite(writeVis, itsChangedFlagRows, itsFlaggedRows);
+      itsChangedFlagRows.clear();
+      itsFlaggedRows.clear();
+      return;
+  }
   if (itsVisNeedsFlush) {
       itsVisNeedsFlush = false;
       itsIterator.writeOriginalVis();
   }
 
-  if (itsFlagNeedsFlush) {
+  if (!itsChangedFlagRows.empty() || !itsFlaggedRows.empty()) {
       itsFlagNeedsFlush = false;
-      itsIterator.writeOriginalFlag();
+      const RowRangeSet changedRows = itsChangedFlagRows;
+      const RowRangeSet flaggedRows = itsFlaggedRows;
+      itsChangedFlagRows.clear();
+      itsFlaggedRows.clear();
+      itsIterator.writeOriginalFlag(changedRows, flaggedRows);
   }
 }
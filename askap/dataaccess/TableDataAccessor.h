@@ -40,6 +40,7 @@
 #include <askap/dataaccess/TableDataIterator.h>
 #include <askap/dataaccess/MetaDataAccessor.h>
 #include <askap/dataaccess/IFlagDataAccessor.h>
+#include <askap/dataaccess/RowRangeSet.h>
 
 namespace askap {
 	
@@ -101,8 +102,23 @@ public:
   ///         information. If True, the corresponding element is flagged.
   virtual casacore::Cube<casacore::Bool>& rwFlag();
 
+  /// @brief replace flags of a range of rows
+  /// @details Only the rows updated this way (or flagged with flagRows) are
+  /// written back, unless rwFlag has been called for the same iteration.
+  /// @param[in] row first row to update
+  /// @param[in] flags nRowsToUpdate x nChannel x nPol cube with new flags
+  virtual void updateFlags(casacore::uInt row, const casacore::Cube<casacore::Bool> &flags);
+
+  /// @brief flag whole rows
+  /// @details FLAG_ROW is set for these rows (if the column exists) and the
+  /// cells of the FLAG column are filled in bulk.
+  /// @param[in] row first row to flag
+  /// @param[in] nRows number of rows to flag
+  virtual void flagRows(casacore::uInt row, casacore::uInt nRows);
   
-  /// this method flush back the data to disk if there are any changes
+  /// @brief this method flush back the data to disk if there are any changes
+  /// @details If write-behind is enabled in the iterator, the data are handed over
+  /// to the writer thread and may not be on disk when this method returns
   void sync() const;
 private:
   /// a flag showing that the visibility has been changed and needs flushing
@@ -112,6 +128,12 @@ private:
   /// a flag showing that the visibility has been changed and needs flushing
   /// back to the table
   mutable bool itsFlagNeedsFlush;  
+
+  /// @brief rows changed via updateFlags since the last sync
+  mutable RowRangeSet itsChangedFlagRows;
+
+  /// @brief rows flagged via flagRows since the last sync
+  mutable RowRangeSet itsFlaggedRows;
   
   /// @brief A reference to associated read-write iterator
   /// @details 
@@ -45,11 +45,21 @@
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/IBufferManager.h>
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/IORecorder.h>
 
 // casa includes
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+// other 3rd party
+#include <askap/askap/AskapLogging.h>
+
+ASKAP_LOGGER(logger, ".TableDataIterator");
+
 
 namespace askap {
 
@@ -99,16 +109,18 @@ using namespace askap::accessors;
 /// @param[in] sel shared pointer to selector
 /// @param[in] conv shared pointer to converter
 /// @param[in] maxChunkSize maximum number of rows per accessor
+/// @param[in] writeBehind if true, modified visibilities and flags are written to
+/// the table by a background thread while the iteration continues (see sync)
 TableDataIterator::TableDataIterator(
             const boost::shared_ptr<ITableManager const> &msManager,
             const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
             const boost::shared_ptr<IDataConverterImpl const> &conv,
             size_t cacheSize, double tolerance,
-            casacore::uInt maxChunkSize) :
+            casacore::uInt maxChunkSize, bool writeBehind) :
          TableInfoAccessor(msManager),
            TableConstDataIterator(msManager,sel,conv,cacheSize, tolerance, maxChunkSize),
 	      itsOriginalVisAccessor(new TableDataAccessor(*this)),
-	      itsIterationCounter(0)
+	      itsIterationCounter(0), itsWriteBehind(writeBehind)
 {
   itsActiveBufferPtr=itsOriginalVisAccessor;
 }
@@ -194,6 +206,8 @@ void TableDataIterator::init()
            mapMemFun(&TableBufferDataAccessor::sync));
   ASKAPDEBUGASSERT(itsOriginalVisAccessor);
   itsOriginalVisAccessor->sync();
+  // the data of the first iteration could be read while still being written
+  waitForWriteBehind();
 
   TableConstDataIterator::init();
   itsIterationCounter=0;
@@ -230,6 +244,30 @@ casacore::Bool TableDataIterator::next()
   return TableConstDataIterator::next();
 }
 
+/// @brief random access is not supported by the read-write iterator
+/// @details Buffers are indexed by the iteration number, which is undefined after
+/// a jump. This method always throws DataAccessLogicError.
+/// @param[in] cycle 0-based index of the time step (unused)
+void TableDataIterator::seekCycle(casacore::uInt cycle)
+{
+  ASKAPTHROW(DataAccessLogicError, "Read-write iterators don't support random access, cycle="<<cycle<<
+             " has been requested; use a const iterator instead");
+}
+
+/// @brief flush all changes made so far
+/// @details Buffers and original visibilities/flags modified for the current
+/// iteration are written to disk. If write-behind is enabled, this method also
+/// waits until the background write is complete, so the table is consistent
+/// after the call. Any error encountered by the background thread is rethrown here.
+void TableDataIterator::sync()
+{
+  std::for_each(itsBuffers.begin(),itsBuffers.end(),
+           mapMemFun(&TableBufferDataAccessor::sync));
+  ASKAPDEBUGASSERT(itsOriginalVisAccessor);
+  itsOriginalVisAccessor->sync();
+  waitForWriteBehind();
+}
+
 /// populate the cube with the data stored in the given buffer
 /// @param[in] vis a reference to the nRow x nChannel x nPol buffer
 ///            cube to fill with the complex visibility data
@@ -241,6 +279,8 @@ void TableDataIterator::readBuffer(casacore::Cube<casacore::Complex> &vis,
   const TableConstDataAccessor &accessor=getAccessor();
   const casacore::IPosition requiredShape(3, accessor.nRow(),
           accessor.nChannel(), accessor.nPol());
+  // buffers may share the storage manager with the main table
+  boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
   if (bufManager.bufferExists(name,itsIterationCounter)) {
       bufManager.readBuffer(vis,name,itsIterationCounter);
       if (vis.shape()!=requiredShape) {
@@ -259,6 +299,7 @@ void TableDataIterator::readBuffer(casacore::Cube<casacore::Complex> &vis,
 void TableDataIterator::writeBuffer(const casacore::Cube<casacore::Complex> &vis,
                          const std::string &name) const
 {
+  boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
   subtableInfo().getBufferManager().writeBuffer(vis,name,itsIterationCounter);
 }
 
@@ -273,6 +314,13 @@ TableDataIterator::~TableDataIterator()
       // doesn't point to a valid instance for some reason (it shouldn't happend)
       itsOriginalVisAccessor->sync();
   }
+  try {
+     waitForWriteBehind();
+  }
+  catch (const std::exception &ex) {
+     // can't throw from the destructor
+     ASKAPLOG_ERROR_STR(logger, "Background write of visibilities or flags failed: "<<ex.what());
+  }
 }
 
 /// @brief helper templated method to write back a cube to main table column
@@ -284,25 +332,27 @@ TableDataIterator::~TableDataIterator()
 ///                 of the appropriate shape
 /// @param[in] colName Name of the column
 template<typename T>
-void TableDataIterator::writeCube(const casacore::Cube<T> &cube,
-                                  const std::string &colName) const
+void TableDataIterator::writeCube(const casacore::Table &iteration, casacore::rownr_t topRow,
+                                  casacore::uInt startChan, const casacore::Cube<T> &cube,
+                                  const std::string &colName)
 {
-  const casacore::uInt nChan = nChannel();
-  const casacore::uInt startChan = startChannel();
+  const casacore::uInt nChan = cube.ncolumn();
   // Setup a slicer to extract the specified channel range only
   const casacore::Slicer chanSlicer(casacore::Slice(),casacore::Slice(startChan,nChan));
 
-  // no change of shape is permitted
-  ASKAPASSERT(cube.nrow() == nRow() &&
-              cube.ncolumn() == nChan &&
-              cube.nplane() == nPol());
-  casacore::ArrayColumn<T> visCol(getCurrentIteration(), colName);
-  ASKAPDEBUGASSERT(getCurrentIteration().nrow() >= getCurrentTopRow()+
-                    nRow());
-  casacore::rownr_t tableRow = getCurrentTopRow();
-  casacore::Matrix<T> buf(nPol(),nChan);
+  IORecorder::ScopedEvent ioEvent(IORecorder::TABLE_WRITE);
+  if (ioEvent.active()) {
+      ioEvent.setRows(iteration, colName, topRow, cube.nrow());
+      ioEvent.setChannels(startChan, nChan);
+      ioEvent.addBytes(cube.nelements() * sizeof(T));
+  }
+
+  casacore::ArrayColumn<T> visCol(iteration, colName);
+  ASKAPDEBUGASSERT(iteration.nrow() >= topRow + cube.nrow());
+  casacore::rownr_t tableRow = topRow;
+  casacore::Matrix<T> buf(cube.nplane(),nChan);
   for (casacore::uInt row=0;row<cube.nrow();++row,++tableRow) {
-       const casacore::IPosition shape = visCol.shape(row);
+       const casacore::IPosition shape = visCol.shape(tableRow);
        ASKAPDEBUGASSERT(shape.size() && (shape.size()<3));
        const casacore::uInt thisRowNumberOfPols = shape[0];
        const casacore::uInt thisRowNumberOfChannels = shape.size()>1 ? shape[1] : 1;
@@ -336,7 +386,14 @@ void TableDataIterator::writeCube(const casacore::Cube<T> &cube,
 /// visibility cube (hence no parameters).
 void TableDataIterator::writeOriginalVis() const
 {
-   writeCube(getAccessor().visibility(), getDataColumnName());
+   ASKAPCHECK(channelAveraging() == 1, "Unable to write back visibilities averaged in frequency");
+   ASKAPCHECK(!polarisationConverted(), "Unable to write back visibilities converted to other polarisation products");
+   const casacore::Cube<casacore::Complex> &vis = getAccessor().visibility();
+   // no change of shape is permitted
+   ASKAPASSERT(vis.nrow() == nRow() && vis.ncolumn() == nChannel() &&
+               vis.nplane() == nPol());
+   boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+   writeCube(getCurrentIteration(), getCurrentTopRow(), startChannel(), vis, getDataColumnName());
 }
 
 /// @brief write back flags
@@ -348,16 +405,53 @@ void TableDataIterator::writeOriginalVis() const
 /// of the interface
 void TableDataIterator::writeOriginalFlag() const
 {
-   const bool rowBasedFlagUsed = getCurrentIteration().tableDesc().isColumn("FLAG_ROW");
+   ASKAPCHECK(channelAveraging() == 1, "Unable to write back flags averaged in frequency");
+   ASKAPCHECK(!polarisationConverted(), "Unable to write back flags converted to other polarisation products");
+   const casacore::Cube<casacore::Bool>& flags = getAccessor().flag();
+   // no change of shape is permitted
+   ASKAPASSERT(flags.nrow() == nRow() && flags.ncolumn() == nChannel() &&
+               flags.nplane() == nPol());
+   boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+   writeFlagCube(getCurrentIteration(), getCurrentTopRow(), startChannel(), flags);
+}
+
+/// @brief write back flags for the given rows only
+/// @details Rows flagged entirely are written first: FLAG_ROW is set (if the
+/// column exists) and whole cells of the FLAG column are filled in bulk. The other
+/// changed rows are then written from the flag cube of the accessor. Rows not
+/// present in either set are not touched.
+/// @param[in] changedRows rows of the accessor with changed flags
+/// @param[in] flaggedRows rows of the accessor flagged entirely
+void TableDataIterator::writeOriginalFlag(const RowRangeSet &changedRows, const RowRangeSet &flaggedRows) const
+{
+   ASKAPCHECK(channelAveraging() == 1, "Unable to write back flags averaged in frequency");
+   ASKAPCHECK(!polarisationConverted(), "Unable to write back flags converted to other polarisation products");
    const casacore::Cube<casacore::Bool>& flags = getAccessor().flag();
+   ASKAPASSERT(flags.nrow() == nRow() && flags.ncolumn() == nChannel() &&
+               flags.nplane() == nPol());
+   boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+   writeFlagRows(getCurrentIteration(), getCurrentTopRow(), startChannel(), flags, changedRows, flaggedRows);
+}
+
+/// @brief write back flags checking consistency with FLAG_ROW
+/// @param[in] iteration table to write to
+/// @param[in] topRow first row to write
+/// @param[in] startChan first channel to write
+/// @param[in] flags cube of flags (nRow x nChannel x nPol)
+void TableDataIterator::writeFlagCube(const casacore::Table &iteration, casacore::rownr_t topRow,
+                       casacore::uInt startChan, const casacore::Cube<casacore::Bool> &flags)
+{
+   const bool rowBasedFlagUsed = iteration.tableDesc().isColumn("FLAG_ROW");
    if (rowBasedFlagUsed) {
        // check that updated flag doesn't contradict row-based flag
-       casacore::ROScalarColumn<casacore::Bool> rowFlagCol(getCurrentIteration(), "FLAG_ROW");
-       const casacore::Vector<casacore::Bool> rowBasedFlag = rowFlagCol.getColumn();
-       const casacore::rownr_t topRow = getCurrentTopRow();
-       ASKAPDEBUGASSERT(static_cast<casacore::rownr_t>(rowBasedFlag.nelements()) >= topRow+flags.nrow());
+       casacore::ROScalarColumn<casacore::Bool> rowFlagCol(iteration, "FLAG_ROW");
+       ASKAPDEBUGASSERT(iteration.nrow() >= topRow + flags.nrow());
+       // only the rows being written are read
+       const casacore::Vector<casacore::Bool> rowBasedFlag = flags.nrow() > 0 ?
+             rowFlagCol.getColumnRange(casacore::Slicer(casacore::IPosition(1, topRow),
+             casacore::IPosition(1, flags.nrow()))) : casacore::Vector<casacore::Bool>();
        for (casacore::uInt row = 0; row < flags.nrow(); ++row) {
-            if (rowBasedFlag[row + topRow]) {
+            if (rowBasedFlag[row]) {
                 bool oneUnflagged = false;
                 casacore::Matrix<casacore::Bool> thisRow = flags.yzPlane(row);
                 for (casacore::Matrix<casacore::Bool>::const_iterator ci = thisRow.begin();
@@ -367,16 +461,178 @@ void TableDataIterator::writeOriginalFlag() const
                          break;
                      }
                 }
-                //std::cout<<row<<" "<<rowBasedFlag[row + topRow]<<" "<<oneUnflagged<<std::endl;
                 ASKAPCHECK(!oneUnflagged, "Flag modification attempted to unflag data for the row ("<<
                       row<<") which is flagged via row-based flagging mechanism. This is not supported");
             }
        }
 
    }
-   writeCube(flags, "FLAG");
+   writeCube(iteration, topRow, startChan, flags, "FLAG");
 }
 
+/// @brief write back flags for the given rows only
+/// @details See writeOriginalFlag for details
+/// @param[in] iteration table to write to
+/// @param[in] topRow row of the table corresponding to row 0 of the cube
+/// @param[in] startChan first channel to write
+/// @param[in] flags cube of flags (nRow x nChannel x nPol)
+/// @param[in] changedRows rows of the cube with changed flags
+/// @param[in] flaggedRows rows of the cube flagged entirely
+void TableDataIterator::writeFlagRows(const casacore::Table &iteration, casacore::rownr_t topRow,
+                       casacore::uInt startChan, const casacore::Cube<casacore::Bool> &flags,
+                       const RowRangeSet &changedRows, const RowRangeSet &flaggedRows)
+{
+   typedef std::vector<RowRangeSet::Range>::const_iterator RangeIt;
+   if (!flaggedRows.empty()) {
+       const bool rowBasedFlagUsed = iteration.tableDesc().isColumn("FLAG_ROW");
+       casacore::ScalarColumn<casacore::Bool> rowFlagCol;
+       if (rowBasedFlagUsed) {
+           rowFlagCol.attach(iteration, "FLAG_ROW");
+       }
+       casacore::ArrayColumn<casacore::Bool> flagCol(iteration, "FLAG");
+       for (RangeIt ci = flaggedRows.ranges().begin(); ci != flaggedRows.ranges().end(); ++ci) {
+            const casacore::uInt nRows = ci->second - ci->first;
+            ASKAPCHECK(ci->second <= flags.nrow(), "Rows "<<ci->first<<" to "<<ci->second<<
+                       " to flag are outside the accessor with "<<flags.nrow()<<" rows");
+            const casacore::Slicer rowSlicer(casacore::IPosition(1, topRow + ci->first),
+                                             casacore::IPosition(1, nRows));
+            IORecorder::ScopedEvent ioEvent(IORecorder::TABLE_WRITE);
+            ioEvent.setRows(iteration, "FLAG", topRow + ci->first, nRows);
+            if (rowBasedFlagUsed) {
+                rowFlagCol.putColumnRange(rowSlicer, casacore::Vector<casacore::Bool>(nRows, casacore::True));
+            }
+            // the whole row is flagged, so whole cells are filled regardless of the channel selection
+            const casacore::IPosition cellShape = flagCol.shape(topRow + ci->first);
+            ASKAPCHECK(cellShape.nelements() == 2, "Expect 2-dimensional cells in the FLAG column, shape = "<<
+                       cellShape);
+            flagCol.putColumnRange(rowSlicer, casacore::Array<casacore::Bool>(casacore::IPosition(3,
+                       cellShape[0], cellShape[1], nRows), casacore::True));
+            ioEvent.addBytes(size_t(nRows) * cellShape.product() * sizeof(casacore::Bool));
+       }
+   }
+   // rows flagged entirely have been written already
+   RowRangeSet rowsToWrite = changedRows;
+   for (RangeIt ci = flaggedRows.ranges().begin(); ci != flaggedRows.ranges().end(); ++ci) {
+        rowsToWrite.remove(ci->first, ci->second - ci->first);
+   }
+   if (flags.nelements() == 0) {
+       return;
+   }
+   for (RangeIt ci = rowsToWrite.ranges().begin(); ci != rowsToWrite.ranges().end(); ++ci) {
+        ASKAPCHECK(ci->second <= flags.nrow(), "Rows "<<ci->first<<" to "<<ci->second<<
+                   " to write are outside the accessor with "<<flags.nrow()<<" rows");
+        const casacore::Cube<casacore::Bool> section = flags(casacore::IPosition(3, ci->first, 0, 0),
+                   casacore::IPosition(3, ci->second - 1, flags.ncolumn() - 1, flags.nplane() - 1));
+        writeFlagCube(iteration, topRow + ci->first, startChan, section);
+   }
+}
+
+/// @brief hand modified visibilities and/or flags over to the writer thread
+/// @details This is the write-behind version of writeOriginalVis and writeOriginalFlag.
+/// The cubes of the current iteration are copied and written to the table in the
+/// background. A previously scheduled write is completed first, so at most one
+/// write is outstanding at any time.
+/// @param[in] vis true to write visibilities
+/// @param[in] flag true to write flags
+void TableDataIterator::scheduleWrite(bool vis, bool flag) const
+{
+  RowRangeSet changedFlagRows;
+  if (flag) {
+      changedFlagRows.add(0, nRow());
+  }
+  scheduleWrite(vis, changedFlagRows, RowRangeSet());
+}
+
+/// @brief hand modified visibilities and/or rows of flags over to the writer thread
+/// @details This is the write-behind version of writeOriginalFlag for the given rows.
+/// @param[in] vis true to write visibilities
+/// @param[in] changedFlagRows rows of the accessor with changed flags
+/// @param[in] flaggedRows rows of the accessor flagged entirely
+void TableDataIterator::scheduleWrite(bool vis, const RowRangeSet &changedFlagRows,
+                                      const RowRangeSet &flaggedRows) const
+{
+  waitForWriteBehind();
+  const bool flag = !changedFlagRows.empty() || !flaggedRows.empty();
+  if (!vis && !flag) {
+      return;
+  }
+  ASKAPCHECK(channelAveraging() == 1, "Unable to write back data averaged in frequency");
+  ASKAPCHECK(!polarisationConverted(), "Unable to write back data converted to other polarisation products");
+  const TableConstDataAccessor &accessor = getAccessor();
+  boost::shared_ptr<PendingWrite> pending(new PendingWrite);
+  pending->itsWriteVis = vis;
+  pending->itsWriteFlag = flag;
+  pending->itsChangedFlagRows = changedFlagRows;
+  pending->itsFlaggedRows = flaggedRows;
+  // cubes are copied because the accessor reuses its buffers for the next iteration
+  if (vis) {
+      pending->itsVisibility = accessor.visibility().copy();
+      ASKAPASSERT(pending->itsVisibility.nrow() == nRow() &&
+                  pending->itsVisibility.ncolumn() == nChannel() &&
+                  pending->itsVisibility.nplane() == nPol());
+  }
+  if (flag) {
+      pending->itsFlag = accessor.flag().copy();
+      ASKAPASSERT(pending->itsFlag.nrow() == nRow() &&
+                  pending->itsFlag.ncolumn() == nChannel() &&
+                  pending->itsFlag.nplane() == nPol());
+  }
+  {
+    boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+    pending->itsIteration = getCurrentIteration();
+  }
+  pending->itsTopRow = getCurrentTopRow();
+  pending->itsStartChan = startChannel();
+  pending->itsDataColumn = getDataColumnName();
+  itsPendingWrite = pending;
+  itsWriteBehindThread.reset(new boost::thread(boost::bind(&TableDataIterator::writeBehind, this)));
+}
+
+/// @brief body of the writer thread
+/// @details Errors are stored in itsWriteBehindError to be rethrown in the main thread
+void TableDataIterator::writeBehind() const
+{
+  ASKAPDEBUGASSERT(itsPendingWrite);
+  threadAffinity().apply("write-behind");
+  try {
+     const PendingWrite &pending = *itsPendingWrite;
+     // the lock is released between columns to give the consumer thread a chance
+     // to access the table
+     if (pending.itsWriteVis) {
+         boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+         writeCube(pending.itsIteration, pending.itsTopRow, pending.itsStartChan,
+                   pending.itsVisibility, pending.itsDataColumn);
+     }
+     if (pending.itsWriteFlag) {
+         boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+         writeFlagRows(pending.itsIteration, pending.itsTopRow, pending.itsStartChan,
+                       pending.itsFlag, pending.itsChangedFlagRows, pending.itsFlaggedRows);
+     }
+  }
+  catch (...) {
+     itsWriteBehindError = std::current_exception();
+  }
+}
+
+/// @brief wait until the background write is finished
+/// @details The error encountered by the writer thread (if any) is rethrown.
+void TableDataIterator::waitForWriteBehind() const
+{
+  if (itsWriteBehindThread) {
+      itsWriteBehindThread->join();
+      itsWriteBehindThread.reset();
+  }
+  if (itsPendingWrite) {
+      // release the table and the copies of the cubes in this thread
+      boost::lock_guard<boost::recursive_mutex> lock(tableMutex());
+      itsPendingWrite.reset();
+  }
+  if (itsWriteBehindError) {
+      std::exception_ptr error = itsWriteBehindError;
+      itsWriteBehindError = std::exception_ptr();
+      std::rethrow_exception(error);
+  }
+}
 
 /// @brief check whether one can write to the main table
 /// @details Buffers held in subtables are not covered by this method.
@@ -42,6 +42,10 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <exception>
 
 // own includes
 #include <askap/dataaccess/TableConstDataIterator.h>
@@ -49,6 +53,7 @@
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/IDataAccessor.h>
 #include <askap/dataaccess/TableBufferDataAccessor.h>
+#include <askap/dataaccess/RowRangeSet.h>
 
 
 namespace askap {
@@ -78,16 +83,29 @@ public:
   /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
   /// to initialisation of a new UVW Machine
   /// @param[in] maxChunkSize maximum number of rows per accessor
+  /// @param[in] writeBehind if true, modified visibilities and flags are written to
+  /// the table by a background thread while the iteration continues (see sync)
   TableDataIterator(const boost::shared_ptr<ITableManager const>
               &msManager,
               const boost::shared_ptr<ITableDataSelectorImpl const> &sel,
 	      const boost::shared_ptr<IDataConverterImpl const> &conv,
 	      size_t cacheSize = 1, double tolerance = 1e-6,
-	      casacore::uInt maxChunkSize = INT_MAX);
+	      casacore::uInt maxChunkSize = INT_MAX, bool writeBehind = false);
 
   /// destructor required to sync buffers on the last iteration
   virtual ~TableDataIterator();
 
+  /// @brief flush all changes made so far
+  /// @details Buffers and original visibilities/flags modified for the current
+  /// iteration are written to disk. If write-behind is enabled, this method also
+  /// waits until the background write is complete, so the table is consistent
+  /// after the call. Any error encountered by the background thread is rethrown here.
+  void sync();
+
+  /// @brief check whether write-behind is enabled
+  /// @return true, if modified visibilities and flags are written in the background
+  inline bool writeBehindEnabled() const { return itsWriteBehind;}
+
   /// @brief operator* delivers a reference to data accessor (current chunk)
   /// @details
   /// @return a reference to the current chunk
@@ -136,6 +154,12 @@ public:
   ///         while(it.next()) {} are possible)
   virtual casacore::Bool next();
 
+  /// @brief random access is not supported by the read-write iterator
+  /// @details Buffers are indexed by the iteration number, which is undefined after
+  /// a jump. This method always throws DataAccessLogicError.
+  /// @param[in] cycle 0-based index of the time step (unused)
+  virtual void seekCycle(casacore::uInt cycle);
+
   // to make it public instead of protected
   using TableConstDataIterator::getAccessor;
 
@@ -169,24 +193,105 @@ public:
   /// of the interface
   void writeOriginalFlag() const;
 
+  /// @brief write back flags for the given rows only
+  /// @details Rows flagged entirely are written first: FLAG_ROW is set (if the
+  /// column exists) and whole cells of the FLAG column are filled in bulk. The other
+  /// changed rows are then written from the flag cube of the accessor. Rows not
+  /// present in either set are not touched.
+  /// @param[in] changedRows rows of the accessor with changed flags
+  /// @param[in] flaggedRows rows of the accessor flagged entirely
+  void writeOriginalFlag(const RowRangeSet &changedRows, const RowRangeSet &flaggedRows) const;
+
   
   /// @brief check whether one can write to the main table
   /// @details Buffers held in subtables are not covered by this method.
   /// @return true if write operation is allowed
   bool mainTableWritable() const throw();		  
 
+  /// @brief hand modified visibilities and/or flags over to the writer thread
+  /// @details This is the write-behind version of writeOriginalVis and writeOriginalFlag.
+  /// The cubes of the current iteration are copied and written to the table in the 
+  /// background. A previously scheduled write is completed first, so at most one
+  /// write is outstanding at any time.
+  /// @param[in] vis true to write visibilities
+  /// @param[in] flag true to write flags
+  void scheduleWrite(bool vis, bool flag) const;
+
+  /// @brief hand modified visibilities and/or rows of flags over to the writer thread
+  /// @details This is the write-behind version of writeOriginalFlag for the given rows.
+  /// @param[in] vis true to write visibilities
+  /// @param[in] changedFlagRows rows of the accessor with changed flags
+  /// @param[in] flaggedRows rows of the accessor flagged entirely
+  void scheduleWrite(bool vis, const RowRangeSet &changedFlagRows, const RowRangeSet &flaggedRows) const;
+
 private:
+  /// @brief pending write of the original visibilities and flags
+  struct PendingWrite {
+     /// @brief table iteration containing the chunk
+     casacore::Table itsIteration;
+     /// @brief first row of the chunk in itsIteration
+     casacore::rownr_t itsTopRow;
+     /// @brief first channel to write
+     casacore::uInt itsStartChan;
+     /// @brief name of the data column
+     std::string itsDataColumn;
+     /// @brief true if visibilities are to be written
+     bool itsWriteVis;
+     /// @brief true if flags are to be written
+     bool itsWriteFlag;
+     /// @brief rows with changed flags
+     RowRangeSet itsChangedFlagRows;
+     /// @brief rows flagged entirely
+     RowRangeSet itsFlaggedRows;
+     /// @brief copy of the visibility cube
+     casacore::Cube<casacore::Complex> itsVisibility;
+     /// @brief copy of the flag cube
+     casacore::Cube<casacore::Bool> itsFlag;
+  };
+
+  /// @brief body of the writer thread
+  /// @details Errors are stored in itsWriteBehindError to be rethrown in the main thread
+  void writeBehind() const;
+
+  /// @brief wait until the background write is finished
+  /// @details The error encountered by the writer thread (if any) is rethrown.
+  void waitForWriteBehind() const;
+
+  /// @brief write back flags checking consistency with FLAG_ROW
+  /// @param[in] iteration table to write to
+  /// @param[in] topRow first row to write
+  /// @param[in] startChan first channel to write
+  /// @param[in] flags cube of flags (nRow x nChannel x nPol)
+  static void writeFlagCube(const casacore::Table &iteration, casacore::rownr_t topRow,
+                            casacore::uInt startChan, const casacore::Cube<casacore::Bool> &flags);
+
+  /// @brief write back flags for the given rows only
+  /// @details See writeOriginalFlag for details
+  /// @param[in] iteration table to write to
+  /// @param[in] topRow row of the table corresponding to row 0 of the cube
+  /// @param[in] startChan first channel to write
+  /// @param[in] flags cube of flags (nRow x nChannel x nPol)
+  /// @param[in] changedRows rows of the cube with changed flags
+  /// @param[in] flaggedRows rows of the cube flagged entirely
+  static void writeFlagRows(const casacore::Table &iteration, casacore::rownr_t topRow,
+                            casacore::uInt startChan, const casacore::Cube<casacore::Bool> &flags,
+                            const RowRangeSet &changedRows, const RowRangeSet &flaggedRows);
 
   /// @brief helper templated method to write back a cube to main table column
   /// @details For now, it is only used in writeOriginalVis/Flag methods
   /// and therefore can be kept in cc rather than tcc file (it is private, so
   /// can be used by this class only). This can easily be changed in the future,
   /// if need arises. This method encapsulates handling of channel selection
+  /// @param[in] iteration table to write to
+  /// @param[in] topRow first row to write
+  /// @param[in] startChan first channel to write
   /// @param[in] cube Cube to work with, type should match the column type. Should be
   ///                 of the appropriate shape
   /// @param[in] colName Name of the column 
   template<typename T>
-  void writeCube(const casacore::Cube<T> &cube, const std::string &colName) const;
+  static void writeCube(const casacore::Table &iteration, casacore::rownr_t topRow,
+                        casacore::uInt startChan, const casacore::Cube<T> &cube,
+                        const std::string &colName);
 
 
 
@@ -206,6 +311,18 @@ private:
   /// counter of the iteration steps. It is used to store the buffers
   /// to the appropriate cell of the disk table
   casacore::uInt itsIterationCounter;
+
+  /// @brief true, if original visibilities and flags are written in the background
+  bool itsWriteBehind;
+
+  /// @brief the write currently done (or about to be done) by the writer thread
+  mutable boost::shared_ptr<PendingWrite> itsPendingWrite;
+
+  /// @brief writer thread
+  mutable boost::shared_ptr<boost::thread> itsWriteBehindThread;
+
+  /// @brief error encountered by the writer thread, if any
+  mutable std::exception_ptr itsWriteBehindError;
 };
 
 } // end of namespace accessors
@@ -36,6 +36,12 @@
 #include <askap/dataaccess/TableDataSelector.h>
 #include <askap/dataaccess/DataAccessError.h>
 #include <askap/dataaccess/TableTimeStampSelectorImpl.h>
+#include <askap/scimath/utils/PolConverter.h>
+
+// std includes
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
 
 using namespace askap;
 using namespace askap::accessors;
@@ -52,7 +58,7 @@ TableDataSelector::TableDataSelector(const
 #ifndef ASKAP_DEBUG
        itsDataColumnName(msManager->defaultDataColumnName()),
 #endif
-       itsChannelSelection(-1,0),itsNFreq(-1)
+       itsChannelSelection(-1,0),itsChannelAveraging(1),itsNFreq(-1), itsAccessorFields(ALL_FIELDS)
 {
   ASKAPDEBUGASSERT(msManager);
 #ifdef ASKAP_DEBUG
@@ -107,27 +113,90 @@ const casacore::TableExprNode& TableDataSelector::getTableSelector(const
 {
    if (itsEpochSelector) {
        /// epoch selection has been done, we need to narrow down the
-       /// selection by updating the table expression
+       /// selection
        itsEpochSelector->setConverter(conv);
-       itsEpochSelector->updateTableExpression(rwTableSelector());
+       const ITableRowIndex &index = subtableInfo().getRowIndex();
+       if (index.timeOrdered()) {
+           // binary search gives a contiguous range of rows, no need to
+           // evaluate the TIME comparison for every row
+           const std::pair<casacore::Double, casacore::Double> interval =
+                 itsEpochSelector->getTableTimeRange();
+           const std::pair<casacore::rownr_t, casacore::rownr_t> range =
+                 index.timeRange(interval.first, interval.second);
+           boost::shared_ptr<std::vector<casacore::rownr_t> > rows(new std::vector<casacore::rownr_t>);
+           if (TableScalarFieldSelector::rowsSelected()) {
+               const std::vector<casacore::rownr_t> &selected = TableScalarFieldSelector::getRowSelection();
+               rows->assign(std::lower_bound(selected.begin(), selected.end(), range.first),
+                            std::lower_bound(selected.begin(), selected.end(), range.second));
+           } else {
+               rows->reserve(range.second - range.first);
+               for (casacore::rownr_t row = range.first; row < range.second; ++row) {
+                    rows->push_back(row);
+               }
+           }
+           itsTimeRangeRows = rows;
+       } else {
+           itsEpochSelector->updateTableExpression(rwTableSelector());
+       }
    }
    return rwTableSelector();
 }
 
+/// @brief obtain canonical form of the selection
+/// @details In addition to the clauses in TableScalarFieldSelector, the
+/// time range (in the table frame) is included. Therefore, this method should be
+/// called after getTableSelector, which sets up the converter.
+/// @return string describing the selection, empty string if no selection is done
+std::string TableDataSelector::getSelectionKey() const
+{
+  std::string result = TableScalarFieldSelector::getSelectionKey();
+  if (itsEpochSelector) {
+      const std::pair<casacore::Double, casacore::Double> interval =
+            itsEpochSelector->getTableTimeRange();
+      std::ostringstream os;
+      os<<std::setprecision(17)<<(result.size() ? ";" : "")<<"TIME="<<interval.first<<","<<interval.second;
+      result += os.str();
+  }
+  return result;
+}
+
+/// @brief check whether a row-based selection has been done
+/// @details In addition to the selection done in TableScalarFieldSelector,
+/// the time range is resolved into a range of rows if the table is
+/// time-ordered. This happens inside getTableSelector, i.e. when the
+/// converter is known.
+/// @return true, if the selection is restricted to a list of rows
+bool TableDataSelector::rowsSelected() const throw()
+{
+  return itsTimeRangeRows || TableScalarFieldSelector::rowsSelected();
+}
+
+/// @brief obtain row-based selection
+/// @details This method is only valid if rowsSelected returns true.
+/// @return sorted vector with row numbers in the main table
+const std::vector<casacore::rownr_t>& TableDataSelector::getRowSelection() const
+{
+  if (itsTimeRangeRows) {
+      return *itsTimeRangeRows;
+  }
+  return TableScalarFieldSelector::getRowSelection();
+}
+
 /// Choose a subset of spectral channels
 /// @param[in] nChan a number of spectral channels wanted in the output
 /// @param[in] start the number of the first spectral channel to choose
 /// @param[in] nAvg a number of adjacent spectral channels to average
 ///             default is no averaging
+/// @note With averaging, nChan*nAvg channels are read starting from start. The averaging
+/// is done by the iterator when the accessor is filled (see ChannelAverager).
 void TableDataSelector::chooseChannels(casacore::uInt nChan, casacore::uInt start,
                              casacore::uInt nAvg)
 {
-   if (nAvg != 1) {
-       throw DataAccessLogicError("not yet implemented");
-   }
    ASKAPDEBUGASSERT((nChan>0) && (start>=0));
+   ASKAPCHECK(nAvg > 0, "Number of channels to average should be positive, you have "<<nAvg);
    itsChannelSelection.first = int(nChan);
    itsChannelSelection.second = int(start);
+   itsChannelAveraging = nAvg;
 }
 
 /// Choose a subset of frequencies. The reference frame is
@@ -140,12 +209,13 @@ void TableDataSelector::chooseChannels(casacore::uInt nChan, casacore::uInt star
 ///        same reference frame as start. This parameter plays
 ///        the same role as nAvg for chooseChannels, i.e. twice
 ///        the frequency resolution would average two adjacent channels
+///        (zero increment means the native resolution). The increment
+///        has to be a multiple of the channel width.
 void TableDataSelector::chooseFrequencies(casacore::uInt nChan,
          const casacore::MFrequency &start,
          const casacore::MVFrequency &freqInc)
 {
    ASKAPDEBUGASSERT((nChan>0) && (start>=0));
-   ASKAPCHECK(freqInc.near(casacore::MVFrequency(0)), "Non zero frequency increment not yet implemented");
    itsNFreq = nChan;
    itsFreqStart = start;
    itsFreqInc = freqInc.getValue();
@@ -170,10 +240,31 @@ void TableDataSelector::chooseVelocities(casacore::uInt nChan,
 
 /// Choose polarization.
 /// @param[in] pols a string describing the wanted polarization
-/// in the output. Allowed values are: I, "IQUV","XXYY","RRLL"
+/// in the output (e.g. "XX,YY" or "XXYY")
+/// @note Only products stored in the dataset can be selected. If they form a strided
+/// subset of the stored correlations, only the selected products are read.
 void TableDataSelector::choosePolarizations(const casacore::String &pols)
 {
-   ASKAPTHROW(DataAccessLogicError, "choosePolarizations has not yet been implemented, requested pols="<<pols);
+   // reference rather than assign, the vector may be shared with cloned selectors
+   itsPolSelection.reference(scimath::PolConverter::fromString(pols));
+   ASKAPCHECK(itsPolSelection.nelements() > 0, "Empty polarisation selection: "<<pols);
+}
+
+/// @brief check whether polarisation selection has been done
+/// @details By default all polarisation products stored in the dataset are returned.
+/// If choosePolarizations has been called, only the requested products are returned.
+/// @return true, if a subset of polarisation products has been selected
+bool TableDataSelector::polarizationsSelected() const throw()
+{
+  return itsPolSelection.nelements() > 0;
+}
+
+/// @brief obtain polarisation selection
+/// @details This method is only meaningful if polarizationsSelected returns true.
+/// @return vector with the polarisation products requested (in the order requested)
+const casacore::Vector<casacore::Stokes::StokesTypes>& TableDataSelector::getPolarizationSelection() const throw()
+{
+  return itsPolSelection;
 }
 
 /// @brief choose data column
@@ -234,6 +325,14 @@ std::pair<int,int> TableDataSelector::getChannelSelection() const throw()
   return itsChannelSelection;
 }
 
+/// @brief obtain the number of adjacent channels to average
+/// @details This is the nAvg parameter of chooseChannels, 1 means no averaging.
+/// @return number of input channels per output channel
+casacore::uInt TableDataSelector::getChannelAveraging() const throw()
+{
+  return itsChannelAveraging;
+}
+
 /// @brief check whether frequency selection has been done
 /// @details By default all channels are selected. However, if chooseFrequencies
 /// has been called, less channels are returned. This method returns true if
@@ -252,3 +351,20 @@ std::tuple<int,casacore::MFrequency,double> TableDataSelector::getFrequencySelec
 {
     return std::tuple<int,casacore::MFrequency,double>(itsNFreq,itsFreqStart,itsFreqInc);
 }
+
+/// @brief declare a subset of accessor fields which will be used
+/// @details Only the declared fields can be accessed by iterators created with this
+/// selector, an exception is thrown if an undeclared field is requested.
+/// @param[in] fields bitwise combination of IDataSelector::AccessorFields values
+void TableDataSelector::chooseAccessorFields(casacore::uInt fields)
+{
+  ASKAPCHECK((fields & ~casacore::uInt(ALL_FIELDS)) == 0, "Unknown accessor fields are requested: "<<fields);
+  itsAccessorFields = fields;
+}
+
+/// @brief obtain the subset of accessor fields declared as used
+/// @return bitwise combination of IDataSelector::AccessorFields values
+casacore::uInt TableDataSelector::getAccessorFields() const throw()
+{
+  return itsAccessorFields;
+}
@@ -45,7 +45,7 @@
 // own includes
 #include <askap/dataaccess/TableScalarFieldSelector.h>
 #include <askap/dataaccess/IDataConverterImpl.h>
-#include <askap/dataaccess/ITableMeasureFieldSelector.h>
+#include <askap/dataaccess/TableTimeStampSelector.h>
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/ITableManager.h>
 
@@ -129,7 +129,9 @@ public:
 
   /// Choose polarization.
   /// @param[in] pols a string describing the wanted polarization
-  /// in the output. Allowed values are: I, "IQUV","XXYY","RRLL"
+  /// in the output (e.g. "XX,YY" or "XXYY")
+  /// @note Only products stored in the dataset can be selected. If they form a strided
+  /// subset of the stored correlations, only the selected products are read.
   virtual void choosePolarizations(const casacore::String &pols);
 
   /// Obtain a table expression node for selection. This method is
@@ -142,6 +144,26 @@ public:
   virtual const casacore::TableExprNode& getTableSelector(const
                   boost::shared_ptr<IDataConverterImpl const> &conv) const;
 
+  /// @brief check whether a row-based selection has been done
+  /// @details In addition to the selection done in TableScalarFieldSelector,
+  /// the time range is resolved into a range of rows if the table is
+  /// time-ordered. This happens inside getTableSelector, i.e. when the
+  /// converter is known.
+  /// @return true, if the selection is restricted to a list of rows
+  virtual bool rowsSelected() const throw();
+
+  /// @brief obtain row-based selection
+  /// @details This method is only valid if rowsSelected returns true.
+  /// @return sorted vector with row numbers in the main table
+  virtual const std::vector<casacore::rownr_t>& getRowSelection() const;
+
+  /// @brief obtain canonical form of the selection
+  /// @details In addition to the clauses in TableScalarFieldSelector, the
+  /// time range (in the table frame) is included. Therefore, this method should be
+  /// called after getTableSelector, which sets up the converter.
+  /// @return string describing the selection, empty string if no selection is done
+  virtual std::string getSelectionKey() const;
+
   /// @brief choose data column
   /// @details This method allows to choose any table column as the visibility
   /// data column (e.g. DATA, CORRECTED_DATA, etc). Because this is a
@@ -183,8 +205,15 @@ public:
   /// which is probably a prefered way to do this check to retain the code clarity.
   /// @return a pair, the first element gives the number of channels selected and
   /// the second element gives the start channel (0-based)
+  /// @note The number of channels is that delivered by the accessor, i.e. after averaging
+  /// (see getChannelAveraging).
   virtual std::pair<int,int> getChannelSelection() const throw();
 
+  /// @brief obtain the number of adjacent channels to average
+  /// @details This is the nAvg parameter of chooseChannels, 1 means no averaging.
+  /// @return number of input channels per output channel
+  virtual casacore::uInt getChannelAveraging() const throw();
+
   /// @brief check whether frequency selection has been done
   /// @details By default all channels are selected. However, if chooseFrequencies
   /// has been called, less channels are returned. This method returns true if
@@ -198,13 +227,38 @@ public:
   /// returns the number of channels, the start frequency and the increment (Hz)
   virtual std::tuple<int,casacore::MFrequency,double> getFrequencySelection() const throw();
 
+  /// @brief check whether polarisation selection has been done
+  /// @details By default all polarisation products stored in the dataset are returned.
+  /// If choosePolarizations has been called, only the requested products are returned.
+  /// @return true, if a subset of polarisation products has been selected
+  virtual bool polarizationsSelected() const throw();
+
+  /// @brief obtain polarisation selection
+  /// @details This method is only meaningful if polarizationsSelected returns true.
+  /// @return vector with the polarisation products requested (in the order requested)
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& getPolarizationSelection() const throw();
+
+  /// @brief declare a subset of accessor fields which will be used
+  /// @details Only the declared fields can be accessed by iterators created with this
+  /// selector, an exception is thrown if an undeclared field is requested.
+  /// @param[in] fields bitwise combination of IDataSelector::AccessorFields values
+  virtual void chooseAccessorFields(casacore::uInt fields);
+
+  /// @brief obtain the subset of accessor fields declared as used
+  /// @return bitwise combination of IDataSelector::AccessorFields values
+  virtual casacore::uInt getAccessorFields() const throw();
+
 
 
 private:
   /// a measurement set to work with. Reference semantics
   casacore::Table itsMS;
   /// selector for epoch
-  boost::shared_ptr<ITableMeasureFieldSelector> itsEpochSelector;
+  boost::shared_ptr<TableTimeStampSelector> itsEpochSelector;
+  /// @brief rows selected with the time range taken into account
+  /// @details Filled by getTableSelector if the table is time-ordered,
+  /// empty pointer otherwise
+  mutable boost::shared_ptr<std::vector<casacore::rownr_t> const> itsTimeRangeRows;
   /// a name of the column containing visibility data
   std::string itsDataColumnName;
   /// @brief channel selection
@@ -213,6 +267,8 @@ private:
   /// This class actually doesn't care about the meaning of these two numbers and just passes them across.
   /// However, in the TableConstDataIterator we assume the meaning given above.
   std::pair<int, int> itsChannelSelection;
+  /// @brief number of adjacent channels to average, 1 means no averaging
+  casacore::uInt itsChannelAveraging;
   /// Frequency selection
   /// number of Frequencies
   int itsNFreq;
@@ -220,6 +276,11 @@ private:
   casacore::MFrequency itsFreqStart;
   /// frequency increment (channel width)
   double itsFreqInc;
+  /// @brief polarisation products selected, empty if no selection is done
+  casacore::Vector<casacore::Stokes::StokesTypes> itsPolSelection;
+  /// @brief accessor fields declared as used
+  /// @details bitwise combination of IDataSelector::AccessorFields values, all fields by default
+  casacore::uInt itsAccessorFields;
 };
 
 } // namespace accessors
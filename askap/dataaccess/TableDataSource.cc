@@ -43,6 +43,8 @@
 using namespace askap;
 using namespace askap::accessors;
 
+const size_t TableDataSource::theirBufferTileSize;
+
 /// construct a read-write data source object
 /// @param[in] fname file name of the measurement set to use
 /// @param[in] opt options from TableDataSourceOptions, can be or'ed
@@ -54,7 +56,8 @@ TableDataSource::TableDataSource(const std::string &fname,
          TableInfoAccessor(casacore::Table(fname, (opt & MEMORY_BUFFERS) && 
 				  !(opt & REMOVE_BUFFERS) && !(opt & WRITE_PERMITTED) ? 
 				      casacore::Table::Old : casacore::Table::Update),
-						opt & MEMORY_BUFFERS, dataColumn)
+						opt & MEMORY_BUFFERS, dataColumn,
+						opt & TILED_BUFFERS ? theirBufferTileSize : 0), itsWriteBehind(false)
 {
   if (opt & REMOVE_BUFFERS) {
       if (table().keywordSet().isDefined("BUFFERS")) {
@@ -101,7 +104,21 @@ boost::shared_ptr<IDataIterator> TableDataSource::createIterator(const
        ASKAPTHROW(DataAccessLogicError, "Incompatible selector and/or "<<
                  "converter are received by the createIterator method");
    }
-   return boost::shared_ptr<IDataIterator>(new TableDataIterator(
+   const boost::shared_ptr<TableDataIterator> it(new TableDataIterator(
                 getTableManager(),implSel,implConv,uvwMachineCacheSize(),
-                uvwMachineCacheTolerance(), maxChunkSize())); 
+                uvwMachineCacheTolerance(), maxChunkSize(), writeBehind()));
+   setUpPlacement(*it);
+   return it;
+}
+
+/// @brief configure write-behind of the original visibilities and flags
+/// @details If write-behind is enabled, visibilities and flags modified via a read-write
+/// iterator are copied and written to the table by a background thread while the
+/// iteration continues. See the header for details.
+/// @param[in] writeBehind true to enable write-behind, false to disable it (default)
+/// @note The new setting will apply to any iterator created in the future, but will not
+/// affect iterators already created
+void TableDataSource::configureWriteBehind(bool writeBehind)
+{
+  itsWriteBehind = writeBehind;
 }
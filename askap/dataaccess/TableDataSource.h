@@ -59,8 +59,14 @@ public:
      /// create buffers in memory (via MemoryTable)
      MEMORY_BUFFERS = 2,
      /// allow to write to the measurement set
-     WRITE_PERMITTED = 4
+     WRITE_PERMITTED = 4,
+     /// create new disk-based buffer columns with the tiled storage manager,
+     /// tiles hold a block of rows of the buffer cube for all channels and polarisations
+     TILED_BUFFERS = 8
   };
+
+  /// @brief maximum tile size in bytes used for the buffers if TILED_BUFFERS option is given
+  static const size_t theirBufferTileSize = 4*1024*1024;
   
   /// construct a read-write data source object
   /// @param[in] fname file name of the measurement set to use
@@ -96,6 +102,29 @@ public:
   	   
   // we need this to get access to the overloaded syntax in the base class 
   using IDataSource::createIterator;	   
+
+  /// @brief configure write-behind of the original visibilities and flags
+  /// @details If write-behind is enabled, visibilities and flags modified via a read-write
+  /// iterator are copied and written to the table by a background thread while the
+  /// iteration continues. Only one write is outstanding at any time, i.e. the write of
+  /// the previous chunk is completed when the iterator advances again. Call sync() of
+  /// TableDataIterator to make sure all changes are on disk (this also happens when the
+  /// iterator is rewound or destroyed). Similar to read-ahead, table access is serialised
+  /// within the iterator only.
+  /// @param[in] writeBehind true to enable write-behind, false to disable it (default)
+  /// @note The new setting will apply to any iterator created in the future, but will not
+  /// affect iterators already created
+  void configureWriteBehind(bool writeBehind);
+
+protected:
+  /// @brief current write-behind setting
+  /// @return true, if the iterators created in the future write in the background
+  inline bool writeBehind() const {return itsWriteBehind;}
+
+private:
+  /// @brief true, if read-write iterators write modified data in the background
+  /// @details This is false by default. See configureWriteBehind for details.
+  bool itsWriteBehind;
 };
  
 } // namespace accessors
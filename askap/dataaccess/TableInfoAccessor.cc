@@ -62,9 +62,11 @@ TableInfoAccessor::TableInfoAccessor(const
 /// instead of the disk-based buffers
 /// @param[in] dataColumn a name of the data column used by default
 ///                       (default is DATA)
+/// @param[in] bufferTileSize maximum tile size in bytes for disk-based buffers,
+/// zero means that the default storage manager is used 
 TableInfoAccessor::TableInfoAccessor(const casacore::Table &tab, 
-                  bool useMemBuffer, const std::string &dataColumn) :
-        itsTableManager(new TableManager(tab,useMemBuffer,dataColumn)) {}
+                  bool useMemBuffer, const std::string &dataColumn, size_t bufferTileSize) :
+        itsTableManager(new TableManager(tab,useMemBuffer,dataColumn,bufferTileSize)) {}
 
 
 /// @return a non-const reference to Table held by this object
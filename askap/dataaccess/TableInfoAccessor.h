@@ -74,8 +74,10 @@ struct TableInfoAccessor : virtual public ITableInfoAccessor {
   /// @param useMemBuffer if true, buffers in memory will be created
   /// instead of the disk-based buffers
   /// @param[in] dataColumn a name of the data column used by default
+  /// @param[in] bufferTileSize maximum tile size in bytes for disk-based buffers,
+  /// zero means that the default storage manager is used 
   TableInfoAccessor(const casacore::Table &tab, bool useMemBuffer=false,
-                    const std::string &dataColumn = "DATA"); 
+                    const std::string &dataColumn = "DATA", size_t bufferTileSize = 0); 
   
   /// @return a non-const reference to Table held by this object
   virtual casacore::Table& table() const;
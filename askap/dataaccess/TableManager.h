@@ -109,9 +109,11 @@ struct TableManager : virtual public ITableManager,
   /// @param[in] useMemBuffers if true, buffers in memory will be created
   /// instead of the disk-based buffers
   /// @param[in] dataColumn name of the data column used by default
+  /// @param[in] bufferTileSize maximum tile size in bytes for disk-based buffers,
+  /// zero means that the default storage manager is used 
   explicit TableManager(const casacore::Table &tab, bool useMemBuffers,
-                        const std::string &dataColumn = "DATA") :
-           TableHolder(tab), SubtableInfoHolder(useMemBuffers),
+                        const std::string &dataColumn = "DATA", size_t bufferTileSize = 0) :
+           TableHolder(tab), SubtableInfoHolder(useMemBuffers, bufferTileSize),
            MiscTableInfoHolder(dataColumn) {}
 };
 
@@ -0,0 +1,139 @@
+/// @file
+///
+/// @brief Fast iteration over the metadata columns of a measurement set
+/// @details Only TIME, ANTENNA1, ANTENNA2, UVW and FLAG_ROW columns are read
+/// in large blocks of rows.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/TableMetaDataIterator.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the iteration
+/// @param[in] ms measurement set to read
+/// @param[in] blockSize maximum number of rows read at a time
+/// @param[in] mutex mutex guarding access to the table, empty pointer means no locking
+TableMetaDataIterator::TableMetaDataIterator(const casacore::Table &ms, casacore::uInt blockSize,
+                         const boost::shared_ptr<boost::recursive_mutex> &mutex) :
+      itsTable(ms), itsBlockSize(blockSize), itsMutex(mutex), itsFirstRow(0), itsNRow(0)
+{
+  ASKAPCHECK(itsBlockSize > 0, "Block size of the metadata iterator should be positive");
+  boost::shared_ptr<boost::lock_guard<boost::recursive_mutex> > lock;
+  if (itsMutex) {
+      lock.reset(new boost::lock_guard<boost::recursive_mutex>(*itsMutex));
+  }
+  itsTimeCol.attach(itsTable, "TIME");
+  itsAntenna1Col.attach(itsTable, "ANTENNA1");
+  itsAntenna2Col.attach(itsTable, "ANTENNA2");
+  itsUVWCol.attach(itsTable, "UVW");
+  if (itsTable.tableDesc().isColumn("FLAG_ROW")) {
+      itsFlagRowCol.attach(itsTable, "FLAG_ROW");
+  }
+  lock.reset();
+  init();
+}
+
+/// @brief restart the iteration from the first row
+void TableMetaDataIterator::init()
+{
+  itsFirstRow = 0;
+  readBlock();
+}
+
+/// @brief advance to the next block of rows
+/// @return true if there are more data
+bool TableMetaDataIterator::next()
+{
+  if (hasMore()) {
+      itsFirstRow += itsNRow;
+      readBlock();
+  }
+  return hasMore();
+}
+
+/// @brief read the block starting at itsFirstRow
+void TableMetaDataIterator::readBlock()
+{
+  boost::shared_ptr<boost::lock_guard<boost::recursive_mutex> > lock;
+  if (itsMutex) {
+      lock.reset(new boost::lock_guard<boost::recursive_mutex>(*itsMutex));
+  }
+  const casacore::rownr_t nTableRows = itsTable.nrow();
+  itsNRow = itsFirstRow < nTableRows ?
+            casacore::uInt(std::min(casacore::rownr_t(itsBlockSize), nTableRows - itsFirstRow)) : 0;
+  if (itsNRow == 0) {
+      itsTime.resize(0);
+      itsAntenna1.resize(0);
+      itsAntenna2.resize(0);
+      itsUVW.resize(0);
+      itsFlagRow.resize(0);
+      return;
+  }
+  const casacore::Slicer rows(casacore::IPosition(1, itsFirstRow), casacore::IPosition(1, itsNRow),
+                              casacore::Slicer::endIsLength);
+  itsTimeCol.getColumnRange(rows, itsTime, casacore::True);
+  itsAntenna1Col.getColumnRange(rows, itsIntBuffer, casacore::True);
+  itsAntenna1.resize(itsNRow);
+  for (casacore::uInt row = 0; row < itsNRow; ++row) {
+       ASKAPDEBUGASSERT(itsIntBuffer[row] >= 0);
+       itsAntenna1[row] = casacore::uInt(itsIntBuffer[row]);
+  }
+  itsAntenna2Col.getColumnRange(rows, itsIntBuffer, casacore::True);
+  itsAntenna2.resize(itsNRow);
+  for (casacore::uInt row = 0; row < itsNRow; ++row) {
+       ASKAPDEBUGASSERT(itsIntBuffer[row] >= 0);
+       itsAntenna2[row] = casacore::uInt(itsIntBuffer[row]);
+  }
+  itsUVWCol.getColumnRange(rows, itsUVWBuffer, casacore::True);
+  ASKAPCHECK((itsUVWBuffer.nrow() == 3) && (itsUVWBuffer.ncolumn() == itsNRow),
+             "UVW column is expected to have 3 elements per row");
+  itsUVW.resize(itsNRow);
+  for (casacore::uInt row = 0; row < itsNRow; ++row) {
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            itsUVW[row](dim) = itsUVWBuffer(dim, row);
+       }
+  }
+  if (itsFlagRowCol.isNull()) {
+      itsFlagRow.resize(itsNRow);
+      itsFlagRow.set(casacore::False);
+  } else {
+      itsFlagRowCol.getColumnRange(rows, itsFlagRow, casacore::True);
+  }
+}
@@ -0,0 +1,170 @@
+/// @file
+///
+/// @brief Fast iteration over the metadata columns of a measurement set
+/// @details Planning steps (w-plane schedules, partitioning, uv-coverage statistics)
+/// need only time, antenna indices, uvw and row flags. This class reads these columns
+/// in large blocks of rows bypassing the accessor machinery of TableConstDataIterator,
+/// so such passes run at the speed of the metadata column I/O.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_TABLE_META_DATA_ITERATOR_H
+#define ASKAP_ACCESSORS_TABLE_META_DATA_ITERATOR_H
+
+// casa includes
+#include <casacore/casa/aipstype.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Fast iteration over the metadata columns of a measurement set
+/// @details The main table is read in blocks of consecutive rows via column-wise
+/// getColumnRange calls. Only TIME, ANTENNA1, ANTENNA2, UVW and FLAG_ROW columns are
+/// touched, no subtables are read, no selection is applied and no frame conversion is
+/// done: times are in the units of the TIME column (seconds since 0 MJD) and uvw are as
+/// stored in the dataset. If there is no FLAG_ROW column, all rows are unflagged.
+/// Unlike IConstDataIterator, a block is not tied to a single time stamp.
+///
+/// If a mutex is given, each block is read with the mutex locked (see
+/// TableConstDataSource::tableMutex).
+/// @ingroup dataaccess_tab
+class TableMetaDataIterator : public boost::noncopyable {
+public:
+  /// @brief set up the iteration
+  /// @param[in] ms measurement set to read
+  /// @param[in] blockSize maximum number of rows read at a time
+  /// @param[in] mutex mutex guarding access to the table, empty pointer means no locking
+  explicit TableMetaDataIterator(const casacore::Table &ms, casacore::uInt blockSize = 65536,
+                         const boost::shared_ptr<boost::recursive_mutex> &mutex =
+                               boost::shared_ptr<boost::recursive_mutex>());
+
+  /// @brief restart the iteration from the first row
+  void init();
+
+  /// @return true if there are more data available
+  inline bool hasMore() const { return itsNRow > 0; }
+
+  /// @brief advance to the next block of rows
+  /// @return true if there are more data
+  bool next();
+
+  /// @return row number of the first row of the current block in the main table
+  inline casacore::rownr_t firstRow() const { return itsFirstRow; }
+
+  /// @return number of rows in the current block
+  inline casacore::uInt nRow() const { return itsNRow; }
+
+  /// @return maximum number of rows read at a time
+  inline casacore::uInt blockSize() const { return itsBlockSize; }
+
+  /// @return time of each row of the current block
+  inline const casacore::Vector<casacore::Double>& time() const { return itsTime; }
+
+  /// @return first antenna index of each row of the current block
+  inline const casacore::Vector<casacore::uInt>& antenna1() const { return itsAntenna1; }
+
+  /// @return second antenna index of each row of the current block
+  inline const casacore::Vector<casacore::uInt>& antenna2() const { return itsAntenna2; }
+
+  /// @return uvw of each row of the current block
+  inline const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw() const { return itsUVW; }
+
+  /// @return row flag of each row of the current block
+  inline const casacore::Vector<casacore::Bool>& flagRow() const { return itsFlagRow; }
+
+private:
+  /// @brief read the block starting at itsFirstRow
+  void readBlock();
+
+  /// @brief main table
+  casacore::Table itsTable;
+
+  /// @brief maximum number of rows read at a time
+  casacore::uInt itsBlockSize;
+
+  /// @brief mutex guarding access to the table (may be empty)
+  boost::shared_ptr<boost::recursive_mutex> itsMutex;
+
+  /// @brief TIME column
+  casacore::ROScalarColumn<casacore::Double> itsTimeCol;
+
+  /// @brief ANTENNA1 column
+  casacore::ROScalarColumn<casacore::Int> itsAntenna1Col;
+
+  /// @brief ANTENNA2 column
+  casacore::ROScalarColumn<casacore::Int> itsAntenna2Col;
+
+  /// @brief UVW column
+  casacore::ROArrayColumn<casacore::Double> itsUVWCol;
+
+  /// @brief FLAG_ROW column (may be null)
+  casacore::ROScalarColumn<casacore::Bool> itsFlagRowCol;
+
+  /// @brief first row of the current block
+  casacore::rownr_t itsFirstRow;
+
+  /// @brief number of rows in the current block
+  casacore::uInt itsNRow;
+
+  /// @brief time of each row
+  casacore::Vector<casacore::Double> itsTime;
+
+  /// @brief first antenna of each row
+  casacore::Vector<casacore::uInt> itsAntenna1;
+
+  /// @brief second antenna of each row
+  casacore::Vector<casacore::uInt> itsAntenna2;
+
+  /// @brief uvw of each row
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsUVW;
+
+  /// @brief row flags
+  casacore::Vector<casacore::Bool> itsFlagRow;
+
+  /// @brief buffer for integer columns
+  casacore::Vector<casacore::Int> itsIntBuffer;
+
+  /// @brief buffer for the uvw column
+  casacore::Matrix<casacore::Double> itsUVWBuffer;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_META_DATA_ITERATOR_H
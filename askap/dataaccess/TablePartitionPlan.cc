@@ -0,0 +1,283 @@
+/// @file
+///
+/// @brief Plan splitting a measurement set between a number of processes
+/// @details Each process of a parallel job can read its own part of a single
+/// measurement set instead of a pre-split copy. The plan is worked out from the
+/// main table by one process and sent to all others, so the main table columns
+/// are read just once.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/TablePartitionPlan.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+// std includes
+#include <algorithm>
+#include <functional>
+#include <map>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty plan
+/// @details It is intended to be filled via read.
+TablePartitionPlan::TablePartitionPlan() : itsMode(CHANNEL), itsNParts(0) {}
+
+/// @brief work out the plan for the given measurement set
+/// @param[in] ms measurement set to split
+/// @param[in] mode way of splitting
+/// @param[in] nParts number of parts
+TablePartitionPlan::TablePartitionPlan(const casacore::Table &ms, Mode mode, casacore::uInt nParts) :
+         itsMode(mode), itsNParts(nParts), itsWeights(nParts, 0)
+{
+  ASKAPCHECK(nParts > 0, "The number of parts should be positive");
+  if (mode == CHANNEL) {
+      splitChannels(ms);
+  } else if (mode == TIME) {
+      splitTime(ms);
+  } else {
+      ASKAPCHECK(mode == BASELINE, "Unknown partition mode "<<int(mode));
+      splitBaselines(ms);
+  }
+}
+
+/// @brief amount of data in the given part
+/// @param[in] part part index
+/// @return number of rows (times number of channels in the CHANNEL mode)
+casacore::uInt64 TablePartitionPlan::weight(casacore::uInt part) const
+{
+  checkPart(part, itsMode);
+  return itsWeights[part];
+}
+
+/// @brief channels of the given part
+/// @details Valid in the CHANNEL mode only
+/// @param[in] part part index
+/// @return the first channel and the number of channels
+std::pair<casacore::uInt, casacore::uInt> TablePartitionPlan::channels(casacore::uInt part) const
+{
+  checkPart(part, CHANNEL);
+  return itsChannels[part];
+}
+
+/// @brief rows of the given part
+/// @details Valid in the TIME mode only
+/// @param[in] part part index
+/// @return the first row and one past the last row
+std::pair<casacore::rownr_t, casacore::rownr_t> TablePartitionPlan::rows(casacore::uInt part) const
+{
+  checkPart(part, TIME);
+  return itsRows[part];
+}
+
+/// @brief baselines of the given part
+/// @details Valid in the BASELINE mode only
+/// @param[in] part part index
+/// @return pairs of the first and the second antenna
+const std::vector<std::pair<casacore::uInt, casacore::uInt> >&
+TablePartitionPlan::baselines(casacore::uInt part) const
+{
+  checkPart(part, BASELINE);
+  return itsBaselines[part];
+}
+
+/// @brief restrict the selection to the given part
+/// @param[in] part part index
+/// @param[in] sel selector of the measurement set the plan has been worked out for
+void TablePartitionPlan::apply(casacore::uInt part, TableDataSelector &sel) const
+{
+  if (itsMode == CHANNEL) {
+      const std::pair<casacore::uInt, casacore::uInt> chans = channels(part);
+      sel.chooseChannels(chans.second, chans.first);
+  } else if (itsMode == TIME) {
+      const std::pair<casacore::rownr_t, casacore::rownr_t> range = rows(part);
+      sel.chooseRowRange(range.first, range.second);
+  } else {
+      sel.chooseBaselineGroup(baselines(part));
+  }
+}
+
+/// @brief serialise the plan
+/// @param[in] os output stream
+void TablePartitionPlan::write(LOFAR::BlobOStream &os) const
+{
+  os.putStart("TablePartitionPlan", 1);
+  os<<static_cast<LOFAR::int32>(itsMode)<<static_cast<LOFAR::uint32>(itsNParts);
+  for (casacore::uInt part = 0; part < itsNParts; ++part) {
+       os<<static_cast<LOFAR::uint64>(itsWeights[part]);
+       if (itsMode == CHANNEL) {
+           os<<static_cast<LOFAR::uint32>(itsChannels[part].first)<<
+               static_cast<LOFAR::uint32>(itsChannels[part].second);
+       } else if (itsMode == TIME) {
+           os<<static_cast<LOFAR::uint64>(itsRows[part].first)<<static_cast<LOFAR::uint64>(itsRows[part].second);
+       } else {
+           const std::vector<std::pair<casacore::uInt, casacore::uInt> > &bsln = itsBaselines[part];
+           os<<static_cast<LOFAR::uint32>(bsln.size());
+           for (size_t i = 0; i < bsln.size(); ++i) {
+                os<<static_cast<LOFAR::uint32>(bsln[i].first)<<static_cast<LOFAR::uint32>(bsln[i].second);
+           }
+       }
+  }
+  os.putEnd();
+}
+
+/// @brief deserialise the plan
+/// @param[in] is input stream
+void TablePartitionPlan::read(LOFAR::BlobIStream &is)
+{
+  const int version = is.getStart("TablePartitionPlan");
+  ASKAPCHECK(version == 1, "Unsupported version "<<version<<" of the serialised partition plan");
+  LOFAR::int32 mode;
+  LOFAR::uint32 nParts;
+  is>>mode>>nParts;
+  ASKAPCHECK((mode >= CHANNEL) && (mode <= BASELINE), "Unknown partition mode "<<mode);
+  itsMode = static_cast<Mode>(mode);
+  itsNParts = nParts;
+  itsWeights.assign(nParts, 0);
+  itsChannels.clear();
+  itsRows.clear();
+  itsBaselines.clear();
+  for (casacore::uInt part = 0; part < itsNParts; ++part) {
+       LOFAR::uint64 weight;
+       is>>weight;
+       itsWeights[part] = weight;
+       if (itsMode == CHANNEL) {
+           LOFAR::uint32 start, nChan;
+           is>>start>>nChan;
+           itsChannels.push_back(std::make_pair(casacore::uInt(start), casacore::uInt(nChan)));
+       } else if (itsMode == TIME) {
+           LOFAR::uint64 first, last;
+           is>>first>>last;
+           itsRows.push_back(std::make_pair(casacore::rownr_t(first), casacore::rownr_t(last)));
+       } else {
+           LOFAR::uint32 size;
+           is>>size;
+           std::vector<std::pair<casacore::uInt, casacore::uInt> > bsln(size);
+           for (size_t i = 0; i < bsln.size(); ++i) {
+                LOFAR::uint32 ant1, ant2;
+                is>>ant1>>ant2;
+                bsln[i] = std::make_pair(casacore::uInt(ant1), casacore::uInt(ant2));
+           }
+           itsBaselines.push_back(bsln);
+       }
+  }
+  is.getEnd();
+}
+
+/// @brief split spectral channels
+/// @details The smallest number of channels over all spectral windows is split, so
+/// the channel selection is valid for all of them.
+/// @param[in] ms measurement set
+void TablePartitionPlan::splitChannels(const casacore::Table &ms)
+{
+  const casacore::Table spWindow = ms.keywordSet().asTable("SPECTRAL_WINDOW");
+  const casacore::Vector<casacore::Int> numChan =
+        casacore::ROScalarColumn<casacore::Int>(spWindow, "NUM_CHAN").getColumn();
+  ASKAPCHECK(numChan.nelements() > 0, "SPECTRAL_WINDOW table of "<<ms.tableName()<<" is empty");
+  const casacore::uInt nChan = static_cast<casacore::uInt>(*std::min_element(numChan.begin(), numChan.end()));
+  ASKAPCHECK(nChan >= itsNParts, "Unable to split "<<nChan<<" spectral channels into "<<itsNParts<<" parts");
+  // the first nChan % nParts parts get one more channel
+  casacore::uInt start = 0;
+  for (casacore::uInt part = 0; part < itsNParts; ++part) {
+       const casacore::uInt size = nChan / itsNParts + (part < nChan % itsNParts ? 1 : 0);
+       itsChannels.push_back(std::make_pair(start, size));
+       itsWeights[part] = casacore::uInt64(ms.nrow()) * size;
+       start += size;
+  }
+  ASKAPDEBUGASSERT(start == nChan);
+}
+
+/// @brief split time-ordered rows
+/// @param[in] ms measurement set
+void TablePartitionPlan::splitTime(const casacore::Table &ms)
+{
+  const casacore::Vector<casacore::Double> times =
+        casacore::ROScalarColumn<casacore::Double>(ms, "TIME").getColumn();
+  const casacore::rownr_t nRow = times.nelements();
+  for (casacore::rownr_t row = 1; row < nRow; ++row) {
+       if (times[row] < times[row - 1]) {
+           ASKAPTHROW(DataAccessLogicError, "Unable to split "<<ms.tableName()<<
+                      " by time, the main table is not time-ordered (row "<<row<<")");
+       }
+  }
+  casacore::rownr_t first = 0;
+  for (casacore::uInt part = 0; part < itsNParts; ++part) {
+       // the ideal end of this part, moved forward to the end of the time stamp
+       casacore::rownr_t last = part + 1 == itsNParts ? nRow :
+               std::max(first, casacore::rownr_t(double(nRow) * (part + 1) / itsNParts));
+       while ((last > 0) && (last < nRow) && (times[last] == times[last - 1])) {
+              ++last;
+       }
+       itsRows.push_back(std::make_pair(first, last));
+       itsWeights[part] = last - first;
+       first = last;
+  }
+}
+
+/// @brief distribute baselines
+/// @param[in] ms measurement set
+void TablePartitionPlan::splitBaselines(const casacore::Table &ms)
+{
+  const casacore::Vector<casacore::Int> ant1 = casacore::ROScalarColumn<casacore::Int>(ms, "ANTENNA1").getColumn();
+  const casacore::Vector<casacore::Int> ant2 = casacore::ROScalarColumn<casacore::Int>(ms, "ANTENNA2").getColumn();
+  std::map<std::pair<casacore::uInt, casacore::uInt>, casacore::uInt64> rowsPerBaseline;
+  for (casacore::rownr_t row = 0; row < ant1.nelements(); ++row) {
+       ++rowsPerBaseline[std::make_pair(casacore::uInt(ant1[row]), casacore::uInt(ant2[row]))];
+  }
+  // largest baselines first, ties resolved by the baseline to make the plan reproducible
+  std::vector<std::pair<casacore::uInt64, std::pair<casacore::uInt, casacore::uInt> > > bySize;
+  for (std::map<std::pair<casacore::uInt, casacore::uInt>, casacore::uInt64>::const_iterator ci =
+       rowsPerBaseline.begin(); ci != rowsPerBaseline.end(); ++ci) {
+       bySize.push_back(std::make_pair(ci->second, ci->first));
+  }
+  std::stable_sort(bySize.begin(), bySize.end(),
+       std::greater<std::pair<casacore::uInt64, std::pair<casacore::uInt, casacore::uInt> > >());
+  itsBaselines.resize(itsNParts);
+  for (size_t i = 0; i < bySize.size(); ++i) {
+       const casacore::uInt part = static_cast<casacore::uInt>(std::min_element(itsWeights.begin(),
+                                   itsWeights.end()) - itsWeights.begin());
+       itsBaselines[part].push_back(bySize[i].second);
+       itsWeights[part] += bySize[i].first;
+  }
+  for (casacore::uInt part = 0; part < itsNParts; ++part) {
+       std::sort(itsBaselines[part].begin(), itsBaselines[part].end());
+  }
+}
+
+/// @brief check the part index
+/// @param[in] part part index
+/// @param[in] mode mode the caller is valid for
+void TablePartitionPlan::checkPart(casacore::uInt part, Mode mode) const
+{
+  ASKAPCHECK(part < itsNParts, "Part "<<part<<" doesn't exist, the plan has only "<<itsNParts<<" part(s)");
+  ASKAPCHECK(mode == itsMode, "This information is not available for the partition mode "<<int(itsMode));
+}
@@ -0,0 +1,173 @@
+/// @file
+///
+/// @brief Plan splitting a measurement set between a number of processes
+/// @details Each process of a parallel job can read its own part of a single
+/// measurement set instead of a pre-split copy. The plan is worked out from the
+/// main table by one process and sent to all others, so the main table columns
+/// are read just once.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_TABLE_PARTITION_PLAN_H
+#define ASKAP_ACCESSORS_TABLE_PARTITION_PLAN_H
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/aipstype.h>
+
+// LOFAR includes
+#include <Common/LofarTypes.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
+// own includes
+#include <askap/dataaccess/TableDataSelector.h>
+
+// std includes
+#include <vector>
+#include <utility>
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Plan splitting a measurement set between a number of processes
+/// @details Three ways of splitting are supported. In the CHANNEL mode, the spectral
+/// axis is divided into contiguous blocks of (almost) equal size. In the TIME mode,
+/// the main table, which has to be time-ordered, is divided into contiguous ranges of
+/// rows with (almost) equal number of rows, a time stamp is never split between parts.
+/// In the BASELINE mode, baselines are distributed between parts (largest first, each
+/// to the part with the smallest number of rows so far), so the number of rows is
+/// balanced as well. Parts may be empty if there are fewer time stamps or baselines
+/// than parts.
+/// @ingroup dataaccess_tab
+class TablePartitionPlan {
+public:
+  /// @brief way of splitting the data
+  enum Mode {
+     /// contiguous blocks of spectral channels
+     CHANNEL = 0,
+     /// contiguous ranges of time
+     TIME,
+     /// groups of baselines
+     BASELINE
+  };
+
+  /// @brief construct an empty plan
+  /// @details It is intended to be filled via read.
+  TablePartitionPlan();
+
+  /// @brief work out the plan for the given measurement set
+  /// @param[in] ms measurement set to split
+  /// @param[in] mode way of splitting
+  /// @param[in] nParts number of parts
+  TablePartitionPlan(const casacore::Table &ms, Mode mode, casacore::uInt nParts);
+
+  /// @return way of splitting
+  inline Mode mode() const { return itsMode; }
+
+  /// @return number of parts
+  inline casacore::uInt nParts() const { return itsNParts; }
+
+  /// @brief amount of data in the given part
+  /// @param[in] part part index
+  /// @return number of rows (times number of channels in the CHANNEL mode)
+  casacore::uInt64 weight(casacore::uInt part) const;
+
+  /// @brief channels of the given part
+  /// @details Valid in the CHANNEL mode only
+  /// @param[in] part part index
+  /// @return the first channel and the number of channels
+  std::pair<casacore::uInt, casacore::uInt> channels(casacore::uInt part) const;
+
+  /// @brief rows of the given part
+  /// @details Valid in the TIME mode only
+  /// @param[in] part part index
+  /// @return the first row and one past the last row
+  std::pair<casacore::rownr_t, casacore::rownr_t> rows(casacore::uInt part) const;
+
+  /// @brief baselines of the given part
+  /// @details Valid in the BASELINE mode only
+  /// @param[in] part part index
+  /// @return pairs of the first and the second antenna
+  const std::vector<std::pair<casacore::uInt, casacore::uInt> >& baselines(casacore::uInt part) const;
+
+  /// @brief restrict the selection to the given part
+  /// @param[in] part part index
+  /// @param[in] sel selector of the measurement set the plan has been worked out for
+  void apply(casacore::uInt part, TableDataSelector &sel) const;
+
+  /// @brief serialise the plan
+  /// @param[in] os output stream
+  void write(LOFAR::BlobOStream &os) const;
+
+  /// @brief deserialise the plan
+  /// @param[in] is input stream
+  void read(LOFAR::BlobIStream &is);
+
+private:
+  /// @brief split spectral channels
+  /// @param[in] ms measurement set
+  void splitChannels(const casacore::Table &ms);
+
+  /// @brief split time-ordered rows
+  /// @param[in] ms measurement set
+  void splitTime(const casacore::Table &ms);
+
+  /// @brief distribute baselines
+  /// @param[in] ms measurement set
+  void splitBaselines(const casacore::Table &ms);
+
+  /// @brief check the part index
+  /// @param[in] part part index
+  /// @param[in] mode mode the caller is valid for
+  void checkPart(casacore::uInt part, Mode mode) const;
+
+  /// @brief way of splitting
+  Mode itsMode;
+
+  /// @brief number of parts
+  casacore::uInt itsNParts;
+
+  /// @brief amount of data per part
+  std::vector<casacore::uInt64> itsWeights;
+
+  /// @brief first channel and number of channels per part (CHANNEL mode)
+  std::vector<std::pair<casacore::uInt, casacore::uInt> > itsChannels;
+
+  /// @brief first row and one past the last row per part (TIME mode)
+  std::vector<std::pair<casacore::rownr_t, casacore::rownr_t> > itsRows;
+
+  /// @brief baselines per part (BASELINE mode)
+  std::vector<std::vector<std::pair<casacore::uInt, casacore::uInt> > > itsBaselines;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_PARTITION_PLAN_H
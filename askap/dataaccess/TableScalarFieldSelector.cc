@@ -40,25 +40,69 @@
 #include <askap/dataaccess/DataAccessError.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 
+// std includes
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+
 
 using namespace askap;
 using namespace askap::accessors;
 using namespace casa;
 
+namespace {
+
+/// @brief form a clause of the canonical selection
+/// @param[in] name name of the selection criterion
+/// @param[in] value value
+/// @return string representation
+template<typename T>
+std::string clause(const std::string &name, const T &value)
+{
+  std::ostringstream os;
+  os<<std::setprecision(17)<<name<<"="<<value;
+  return os.str();
+}
+
+/// @brief form a clause of the canonical selection with two values
+/// @param[in] name name of the selection criterion
+/// @param[in] value1 first value
+/// @param[in] value2 second value
+/// @return string representation
+template<typename T>
+std::string clause(const std::string &name, const T &value1, const T &value2)
+{
+  std::ostringstream os;
+  os<<std::setprecision(17)<<name<<"="<<value1<<","<<value2;
+  return os.str();
+}
+
+} // anonymous namespace
+
+
+/// @brief default constructor
+/// @details uv-distance selection is done via table expression by default
+TableScalarFieldSelector::TableScalarFieldSelector() : itsUseUVDistanceIndex(false) {}
+
+/// @brief configure the way uv-distance selection is done
+/// @details If the index is used, uv-distances of all rows are computed and sorted once
+/// per data source (see ITableRowIndex), so repeated uv-range selections reduce to a binary
+/// search. This is a table-specific option not present in IDataSelector.
+/// @param[in] useIndex true to use the row index, false to use table expression
+void TableScalarFieldSelector::useUVDistanceIndex(bool useIndex)
+{
+  itsUseUVDistanceIndex = useIndex;
+}
 
 /// Choose a single feed, the same for both antennae
 /// @param feedID the sequence number of feed to choose
 void TableScalarFieldSelector::chooseFeed(casacore::uInt feedID)
 {
-   if (itsTableSelector.isNull()) {
-       itsTableSelector= (table().col("FEED1") ==
-                  static_cast<casacore::Int>(feedID)) && (table().col("FEED2") ==
-                  static_cast<casacore::Int>(feedID));
-   } else {
-       itsTableSelector=itsTableSelector && (table().col("FEED1") ==
-                  static_cast<casacore::Int>(feedID)) && (table().col("FEED2") ==
-                  static_cast<casacore::Int>(feedID));
-   }
+   addSelectionClause(clause("FEED", feedID));
+   // resolved via the row index of the main table to avoid the table scan
+   restrictRows(subtableInfo().getRowIndex().feedRows(feedID));
 }
 
 /// @brief choose user-defined index
@@ -66,6 +110,7 @@ void TableScalarFieldSelector::chooseFeed(casacore::uInt feedID)
 /// @param[in] value index value
 void TableScalarFieldSelector::chooseUserDefinedIndex(const std::string &column, const casacore::uInt value)
 {
+   addSelectionClause(clause("USER_INDEX:" + column, value));
    if (itsTableSelector.isNull()) {
        itsTableSelector = (table().col(column) == value);
    } else {
@@ -80,30 +125,16 @@ void TableScalarFieldSelector::chooseUserDefinedIndex(const std::string &column,
 void TableScalarFieldSelector::chooseBaseline(casacore::uInt ant1,
                                               casacore::uInt ant2)
 {
-   if (itsTableSelector.isNull()) {
-       itsTableSelector= (table().col("ANTENNA1") ==
-           static_cast<casacore::Int>(ant1)) && (table().col("ANTENNA2") ==
-	   static_cast<casacore::Int>(ant2));
-   } else {
-       itsTableSelector=itsTableSelector && (table().col("ANTENNA1") ==
-           static_cast<casacore::Int>(ant1)) && (table().col("ANTENNA2") ==
-	   static_cast<casacore::Int>(ant2));
-   }
+   addSelectionClause(clause("BASELINE", ant1, ant2));
+   restrictRows(subtableInfo().getRowIndex().baselineRows(ant1, ant2));
 }
 
 /// Choose all baselines to given antenna
 /// @param[in] ant the sequence number of antenna
 void TableScalarFieldSelector::chooseAntenna(casacore::uInt ant)
 {
-   if (itsTableSelector.isNull()) {
-       itsTableSelector=(table().col("ANTENNA1") ==
-           static_cast<casacore::Int>(ant)) || (table().col("ANTENNA2") ==
-	   static_cast<casacore::Int>(ant));
-   } else {
-       itsTableSelector=itsTableSelector && ((table().col("ANTENNA1") ==
-           static_cast<casacore::Int>(ant)) || (table().col("ANTENNA2") ==
-	   static_cast<casacore::Int>(ant)));
-   }
+   addSelectionClause(clause("ANTENNA", ant));
+   restrictRows(subtableInfo().getRowIndex().antennaRows(ant));
 }
 
 /// @brief Choose samples corresponding to a uv-distance larger than threshold
@@ -112,6 +143,11 @@ void TableScalarFieldSelector::chooseAntenna(casacore::uInt ant)
 /// @param[in] uvDist threshold
 void TableScalarFieldSelector::chooseMinUVDistance(casacore::Double uvDist)
 {
+  addSelectionClause(clause("MIN_UVDIST", uvDist));
+  if (itsUseUVDistanceIndex) {
+      restrictRows(subtableInfo().getRowIndex().uvDistanceRows(uvDist, std::numeric_limits<casacore::Double>::max(), false));
+      return;
+  }
   TableExprNode uvwExprNode = table().col("UVW");
   const TableExprNode uExprNode = uvwExprNode(IPosition(1,0));
   const TableExprNode vExprNode = uvwExprNode(IPosition(1,1));
@@ -136,6 +172,11 @@ void TableScalarFieldSelector::chooseMinUVDistance(casacore::Double uvDist)
 /// @param[in] uvDist threshold
 void TableScalarFieldSelector::chooseMinNonZeroUVDistance(casacore::Double uvDist)
 {
+  addSelectionClause(clause("MIN_NONZERO_UVDIST", uvDist));
+  if (itsUseUVDistanceIndex) {
+      restrictRows(subtableInfo().getRowIndex().uvDistanceRows(uvDist, std::numeric_limits<casacore::Double>::max(), true));
+      return;
+  }
   TableExprNode uvwExprNode = table().col("UVW");
   const TableExprNode uExprNode = uvwExprNode(IPosition(1,0));
   const TableExprNode vExprNode = uvwExprNode(IPosition(1,1));
@@ -160,6 +201,11 @@ void TableScalarFieldSelector::chooseMinNonZeroUVDistance(casacore::Double uvDis
 /// @param[in] uvDist threshold
 void TableScalarFieldSelector::chooseMaxUVDistance(casacore::Double uvDist)
 {
+  addSelectionClause(clause("MAX_UVDIST", uvDist));
+  if (itsUseUVDistanceIndex) {
+      restrictRows(subtableInfo().getRowIndex().uvDistanceRows(0., uvDist, false));
+      return;
+  }
   TableExprNode uvwExprNode = table().col("UVW");
   const TableExprNode uExprNode = uvwExprNode(IPosition(1,0));
   const TableExprNode vExprNode = uvwExprNode(IPosition(1,1));
@@ -179,6 +225,7 @@ void TableScalarFieldSelector::chooseMaxUVDistance(casacore::Double uvDist)
 /// @param[in] scanNumber the scan number to choose
 void TableScalarFieldSelector::chooseScanNumber(casacore::uInt scanNumber)
 {
+   addSelectionClause(clause("SCAN_NUMBER", scanNumber));
     if (itsTableSelector.isNull()) {
         itsTableSelector = (table().col("SCAN_NUMBER") ==
                 static_cast<casacore::Int>(scanNumber));
@@ -188,62 +235,68 @@ void TableScalarFieldSelector::chooseScanNumber(casacore::uInt scanNumber)
     }
 }
 
+/// @brief Choose a group of baselines
+/// @details This is a table-specific selection not present in IDataSelector (which
+/// only allows a single baseline to be chosen). Unlike chooseBaseline, the order of
+/// antennas matters, i.e. baselines are given as they appear in the table.
+/// @param[in] baselines pairs of the first and the second antenna
+void TableScalarFieldSelector::chooseBaselineGroup(const std::vector<std::pair<casacore::uInt,
+                                                   casacore::uInt> > &baselines)
+{
+   std::vector<std::pair<casacore::uInt, casacore::uInt> > sorted(baselines);
+   std::sort(sorted.begin(), sorted.end());
+   std::ostringstream os;
+   os<<"BASELINE_GROUP=";
+   for (size_t i = 0; i < sorted.size(); ++i) {
+        os<<(i ? "," : "")<<sorted[i].first<<"-"<<sorted[i].second;
+   }
+   addSelectionClause(os.str());
+   restrictRows(subtableInfo().getRowIndex().baselineGroupRows(sorted));
+}
+
+/// @brief Choose a contiguous range of rows of the main table
+/// @details This is a table-specific selection not present in IDataSelector. It is
+/// used to split time-ordered data between a number of processes.
+/// @param[in] first the first row to choose
+/// @param[in] last one past the last row to choose
+void TableScalarFieldSelector::chooseRowRange(casacore::rownr_t first, casacore::rownr_t last)
+{
+   ASKAPCHECK(first <= last, "Invalid row range "<<first<<" - "<<last);
+   addSelectionClause(clause("ROWS", first, last));
+   std::vector<casacore::rownr_t> rows;
+   rows.reserve(last - first);
+   for (casacore::rownr_t row = first; row < last; ++row) {
+        rows.push_back(row);
+   }
+   restrictRows(rows);
+}
+
 /// @brief Choose autocorrelations only
 void TableScalarFieldSelector::chooseAutoCorrelations()
 {
-   if (itsTableSelector.isNull()) {
-       itsTableSelector = (table().col("ANTENNA1") ==
-                           table().col("ANTENNA2")) &&
-                           (table().col("FEED1") ==
-                           table().col("FEED2"));
-   } else {
-       itsTableSelector = itsTableSelector && (table().col("ANTENNA1") ==
-                                               table().col("ANTENNA2")) &&
-                           (table().col("FEED1") == table().col("FEED2"));
-   }
+   addSelectionClause("AUTO");
+   restrictRows(subtableInfo().getRowIndex().autoCorrelationRows());
 }
   
 /// @brief Choose crosscorrelations only
 void TableScalarFieldSelector::chooseCrossCorrelations()
 {
-   if (itsTableSelector.isNull()) {
-       itsTableSelector = (table().col("ANTENNA1") !=
-                           table().col("ANTENNA2")) || 
-                           (table().col("FEED1") != table().col("FEED2"));
-   } else {
-       itsTableSelector = itsTableSelector && ((table().col("ANTENNA1") !=
-                                               table().col("ANTENNA2")) ||
-                           (table().col("FEED1") != table().col("FEED2"))) ;
-   }
+   addSelectionClause("CROSS");
+   restrictRows(subtableInfo().getRowIndex().crossCorrelationRows());
 }
 
 /// Choose a single spectral window (also known as IF).
 /// @param spWinID the ID of the spectral window to choose
 void TableScalarFieldSelector::chooseSpectralWindow(casacore::uInt spWinID)
 {
+   addSelectionClause(clause("SPECTRAL_WINDOW", spWinID));
    // one spectral window can correspond to multiple data description IDs
-   // We need to obtain this information from the DATA_DESCRIPTION table
-   std::vector<size_t> dataDescIDs = subtableInfo().
+   // We need to obtain this information from the DATA_DESCRIPTION table.
+   // If the required spectral window is not present in the measurement set,
+   // the list is empty and so is the selection
+   const std::vector<size_t> dataDescIDs = subtableInfo().
         getDataDescription().getDescIDsForSpWinID(static_cast<int>(spWinID));
-   if (dataDescIDs.size()) {
-       std::vector<size_t>::const_iterator ci=dataDescIDs.begin();
-       TableExprNode tempNode=(table().col("DATA_DESC_ID") ==
-                  static_cast<casacore::Int>(*ci));
-       for(++ci;ci!=dataDescIDs.end();++ci) {           
-	   tempNode = tempNode || (table().col("DATA_DESC_ID") ==
-                  static_cast<casacore::Int>(*ci));
-       }
-       if (itsTableSelector.isNull()) {
-           itsTableSelector=tempNode;
-       } else {
-           itsTableSelector = itsTableSelector && tempNode;
-       }       
-   } else {
-     // required spectral window is not present in the measurement set
-     // we have to insert a dummy expression, otherwise an exception
-     // is thrown within the table selection.
-     itsTableSelector=(table().col("DATA_DESC_ID") == -1) && False;
-   }   
+   restrictRows(subtableInfo().getRowIndex().dataDescRows(dataDescIDs));
 }
  
 /// @brief Obtain a table expression node for selection. 
@@ -266,3 +319,64 @@ casacore::TableExprNode& TableScalarFieldSelector::rwTableSelector() const
   return itsTableSelector;
 }
 
+/// @brief check whether a row-based selection has been done
+/// @details Selection on antennas, feeds and spectral windows is resolved
+/// via the row index into a list of rows. The result is combined with
+/// the expression node returned by getTableSelector (logical and).
+/// @return true, if the selection is restricted to a list of rows
+bool TableScalarFieldSelector::rowsSelected() const throw()
+{
+  return static_cast<bool>(itsRowSelection);
+}
+
+/// @brief obtain row-based selection
+/// @details This method is only valid if rowsSelected returns true.
+/// @return sorted vector with row numbers in the main table
+const std::vector<casacore::rownr_t>& TableScalarFieldSelector::getRowSelection() const
+{
+  ASKAPCHECK(itsRowSelection, "No row-based selection has been done");
+  return *itsRowSelection;
+}
+
+/// @brief restrict row-based selection
+/// @details The current list of rows is intersected with the given one
+/// (or just set, if no row-based selection has been done so far)
+/// @param[in] rows sorted vector of row numbers to keep
+void TableScalarFieldSelector::restrictRows(const std::vector<casacore::rownr_t> &rows)
+{
+  boost::shared_ptr<std::vector<casacore::rownr_t> > newSelection(new std::vector<casacore::rownr_t>);
+  if (itsRowSelection) {
+      std::set_intersection(itsRowSelection->begin(), itsRowSelection->end(), rows.begin(),
+                            rows.end(), std::back_inserter(*newSelection));
+  } else {
+      newSelection->assign(rows.begin(), rows.end());
+  }
+  itsRowSelection = newSelection;
+}
+
+/// @brief obtain canonical form of the selection
+/// @details Selectors with the same key select the same rows, regardless of
+/// the order in which the selection methods were called. This is used to cache
+/// selections (see TableSelectionCache).
+/// @return string describing the selection, empty string if no selection is done
+std::string TableScalarFieldSelector::getSelectionKey() const
+{
+  std::vector<std::string> clauses(itsSelectionClauses);
+  std::sort(clauses.begin(), clauses.end());
+  std::string result;
+  for (std::vector<std::string>::const_iterator ci = clauses.begin(); ci != clauses.end(); ++ci) {
+       if (result.size()) {
+           result += ";";
+       }
+       result += *ci;
+  }
+  return result;
+}
+
+/// @brief add a clause to the canonical form of the selection
+/// @details All clauses are combined with the logical and
+/// @param[in] clause string describing the selection criterion
+void TableScalarFieldSelector::addSelectionClause(const std::string &clause)
+{
+  itsSelectionClauses.push_back(clause);
+}
@@ -47,8 +47,13 @@
 #include <askap/dataaccess/ITableHolder.h>
 #include <askap/dataaccess/ITableInfoAccessor.h>
 
+// boost includes
+#include <boost/shared_ptr.hpp>
+
 // std includes
 #include <string>
+#include <vector>
+#include <utility>
 
 namespace askap {
 
@@ -73,6 +78,16 @@ class TableScalarFieldSelector : virtual public ITableDataSelectorImpl,
 				 virtual protected ITableInfoAccessor
 {
 public:
+  /// @brief default constructor
+  /// @details uv-distance selection is done via table expression by default
+  TableScalarFieldSelector();
+
+  /// @brief configure the way uv-distance selection is done
+  /// @details If the index is used, uv-distances of all rows are computed and sorted once
+  /// per data source (see ITableRowIndex), so repeated uv-range selections reduce to a binary
+  /// search. This is a table-specific option not present in IDataSelector.
+  /// @param[in] useIndex true to use the row index, false to use table expression
+  void useUVDistanceIndex(bool useIndex);
   
   /// Choose a single feed, the same for both antennae
   /// @param[in] feedID the sequence number of feed to choose
@@ -129,6 +144,20 @@ public:
   /// @param[in] scanNumber the scan number to choose
   virtual void chooseScanNumber(casacore::uInt scanNumber);
 
+  /// @brief Choose a group of baselines
+  /// @details This is a table-specific selection not present in IDataSelector (which
+  /// only allows a single baseline to be chosen). Unlike chooseBaseline, the order of
+  /// antennas matters, i.e. baselines are given as they appear in the table.
+  /// @param[in] baselines pairs of the first and the second antenna
+  void chooseBaselineGroup(const std::vector<std::pair<casacore::uInt, casacore::uInt> > &baselines);
+
+  /// @brief Choose a contiguous range of rows of the main table
+  /// @details This is a table-specific selection not present in IDataSelector. It is
+  /// used to split time-ordered data between a number of processes.
+  /// @param[in] first the first row to choose
+  /// @param[in] last one past the last row to choose
+  void chooseRowRange(casacore::rownr_t first, casacore::rownr_t last);
+
   /// @brief Obtain a table expression node for selection. 
   /// @details This method is
   /// used in the implementation of the iterator to form a subtable
@@ -140,8 +169,38 @@ public:
   /// @return a const reference to table expression node object
   virtual const casacore::TableExprNode& getTableSelector(const
                boost::shared_ptr<IDataConverterImpl const> &conv) const;
+
+  /// @brief check whether a row-based selection has been done
+  /// @details Selection on antennas, feeds and spectral windows is resolved
+  /// via the row index into a list of rows. The result is combined with
+  /// the expression node returned by getTableSelector (logical and).
+  /// @return true, if the selection is restricted to a list of rows
+  virtual bool rowsSelected() const throw();
+
+  /// @brief obtain row-based selection
+  /// @details This method is only valid if rowsSelected returns true.
+  /// @return sorted vector with row numbers in the main table
+  virtual const std::vector<casacore::rownr_t>& getRowSelection() const;
+
+  /// @brief obtain canonical form of the selection
+  /// @details Selectors with the same key select the same rows, regardless of
+  /// the order in which the selection methods were called. This is used to cache
+  /// selections (see TableSelectionCache).
+  /// @return string describing the selection, empty string if no selection is done
+  virtual std::string getSelectionKey() const;
       
 protected:
+  /// @brief add a clause to the canonical form of the selection
+  /// @details All clauses are combined with the logical and
+  /// @param[in] clause string describing the selection criterion
+  void addSelectionClause(const std::string &clause);
+
+  /// @brief restrict row-based selection
+  /// @details The current list of rows is intersected with the given one
+  /// (or just set, if no row-based selection has been done so far)
+  /// @param[in] rows sorted vector of row numbers to keep
+  void restrictRows(const std::vector<casacore::rownr_t> &rows);
+
   /// @brief get read-write access to expression node
   /// @return a reference to the cached table expression node
   ///
@@ -150,6 +209,16 @@ protected:
 private:
   /// a current table selection expression (cache)
   mutable casacore::TableExprNode  itsTableSelector;  
+
+  /// @brief rows selected via the row index, empty pointer if no such selection
+  /// @details Shared between clones, a new vector is created on every change
+  boost::shared_ptr<std::vector<casacore::rownr_t> const> itsRowSelection;
+
+  /// @brief clauses of the canonical form of the selection (see getSelectionKey)
+  std::vector<std::string> itsSelectionClauses;
+
+  /// @brief true, if uv-distance selection is done via the row index
+  bool itsUseUVDistanceIndex;
 };
   
 } // namespace accessors
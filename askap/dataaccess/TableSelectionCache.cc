@@ -0,0 +1,156 @@
+/// @file
+/// @brief Cache of table selections
+/// @details Selection of rows from the main table can be expensive for large
+/// measurement sets if it requires evaluation of a table expression. This class
+/// keeps the resulting reference tables keyed by a canonical form of the selection.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/TableSelectionCache.h>
+#include <askap/askap/AskapError.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty cache
+/// @param[in] ms main table the selections are made from
+/// @param[in] maxSize maximum number of selections to keep
+TableSelectionCache::TableSelectionCache(const casacore::Table &ms, size_t maxSize) :
+       itsTable(ms), itsNRow(ms.nrow()), itsMaxSize(maxSize), itsHits(0), itsPlanHits(0)
+{
+  ASKAPCHECK(itsMaxSize > 0, "Selection cache should be able to hold at least one selection");
+}
+
+/// @brief search for a selection
+/// @param[in] key canonical form of the selection
+/// @param[out] tab reference table with the selected rows (unchanged if not found)
+/// @return true, if the selection has been found in the cache
+bool TableSelectionCache::find(const std::string &key, casacore::Table &tab) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  checkTable();
+  const std::map<std::string, casacore::Table>::const_iterator ci = itsTables.find(key);
+  if (ci == itsTables.end()) {
+      return false;
+  }
+  tab = ci->second;
+  // move the key to the front
+  itsUseOrder.remove(key);
+  itsUseOrder.push_front(key);
+  ++itsHits;
+  return true;
+}
+
+/// @brief add a selection to the cache
+/// @param[in] key canonical form of the selection
+/// @param[in] tab reference table with the selected rows
+void TableSelectionCache::add(const std::string &key, const casacore::Table &tab) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  checkTable();
+  if (itsTables.find(key) != itsTables.end()) {
+      itsUseOrder.remove(key);
+  } else if (itsTables.size() >= itsMaxSize) {
+      ASKAPDEBUGASSERT(itsUseOrder.size());
+      itsTables.erase(itsUseOrder.back());
+      itsPlans.erase(itsUseOrder.back());
+      itsUseOrder.pop_back();
+  }
+  itsTables[key] = tab;
+  // the plan may not match the new selection
+  itsPlans.erase(key);
+  itsUseOrder.push_front(key);
+}
+
+/// @brief search for an iteration plan
+/// @param[in] key canonical form of the selection
+/// @param[out] plan shared pointer to the plan (unchanged if not found)
+/// @return true, if the plan has been found in the cache
+bool TableSelectionCache::findPlan(const std::string &key, boost::shared_ptr<IterationPlan const> &plan) const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  checkTable();
+  const std::map<std::string, boost::shared_ptr<IterationPlan const> >::const_iterator ci = itsPlans.find(key);
+  if (ci == itsPlans.end()) {
+      return false;
+  }
+  plan = ci->second;
+  ++itsPlanHits;
+  return true;
+}
+
+/// @brief add an iteration plan to the cache
+/// @details The plan is ignored if the selection with the given (non-empty) key
+/// is not in the cache.
+/// @param[in] key canonical form of the selection
+/// @param[in] plan shared pointer to the plan
+void TableSelectionCache::addPlan(const std::string &key, const boost::shared_ptr<IterationPlan const> &plan) const
+{
+  ASKAPDEBUGASSERT(plan);
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  checkTable();
+  if (key.size() && itsTables.find(key) == itsTables.end()) {
+      return;
+  }
+  itsPlans[key] = plan;
+}
+
+/// @return number of selections in the cache
+size_t TableSelectionCache::size() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsTables.size();
+}
+
+/// @return number of successful searches
+size_t TableSelectionCache::hits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsHits;
+}
+
+/// @return number of successful searches of iteration plans
+size_t TableSelectionCache::planHits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsPlanHits;
+}
+
+/// @brief drop all selections if the main table has changed
+/// @note the mutex should be locked by the caller
+void TableSelectionCache::checkTable() const
+{
+  if (itsTable.nrow() != itsNRow) {
+      itsTables.clear();
+      itsPlans.clear();
+      itsUseOrder.clear();
+      itsNRow = itsTable.nrow();
+  }
+}
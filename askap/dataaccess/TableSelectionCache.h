@@ -0,0 +1,148 @@
+/// @file
+/// @brief Cache of table selections
+/// @details Selection of rows from the main table can be expensive for large
+/// measurement sets if it requires evaluation of a table expression. Major cycle
+/// loops create iterators with the same selection over and over again. This class
+/// keeps the resulting reference tables keyed by a canonical form of the selection,
+/// so the selection is evaluated only once. The iteration plan (ranges of rows
+/// sharing the same time stamp) can be cached alongside the selection, so iterators
+/// created later don't need to group the rows again.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_TABLE_SELECTION_CACHE_H
+#define ASKAP_ACCESSORS_TABLE_SELECTION_CACHE_H
+
+// casa includes
+#include <casacore/tables/Tables/Table.h>
+
+// boost includes
+#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+#include <map>
+#include <list>
+#include <vector>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Cache of table selections
+/// @details Reference tables are stored together with a key describing the
+/// selection (see ITableDataSelectorImpl::getSelectionKey). The number of cached
+/// selections is limited, the least recently used one is dropped first.
+/// The whole cache is invalidated if the number of rows in the main table changes.
+/// All methods are thread-safe.
+///
+/// Iteration plans are kept for the selections held in the cache and for the
+/// whole table (empty key). A plan is dropped together with its selection.
+/// @ingroup dataaccess_tab
+class TableSelectionCache {
+public:
+  /// @brief ranges of rows with the same time stamp in the order of iteration
+  /// @details Each element has the first row (in the selected table) and the number of rows
+  typedef std::vector<std::pair<casacore::rownr_t, casacore::rownr_t> > IterationPlan;
+
+  /// @brief construct an empty cache
+  /// @param[in] ms main table the selections are made from
+  /// @param[in] maxSize maximum number of selections to keep
+  explicit TableSelectionCache(const casacore::Table &ms, size_t maxSize = 32);
+
+  /// @brief search for a selection
+  /// @param[in] key canonical form of the selection
+  /// @param[out] tab reference table with the selected rows (unchanged if not found)
+  /// @return true, if the selection has been found in the cache
+  bool find(const std::string &key, casacore::Table &tab) const;
+
+  /// @brief add a selection to the cache
+  /// @param[in] key canonical form of the selection
+  /// @param[in] tab reference table with the selected rows
+  void add(const std::string &key, const casacore::Table &tab) const;
+
+  /// @brief search for an iteration plan
+  /// @param[in] key canonical form of the selection
+  /// @param[out] plan shared pointer to the plan (unchanged if not found)
+  /// @return true, if the plan has been found in the cache
+  bool findPlan(const std::string &key, boost::shared_ptr<IterationPlan const> &plan) const;
+
+  /// @brief add an iteration plan to the cache
+  /// @details The plan is ignored if the selection with the given (non-empty) key
+  /// is not in the cache.
+  /// @param[in] key canonical form of the selection
+  /// @param[in] plan shared pointer to the plan
+  void addPlan(const std::string &key, const boost::shared_ptr<IterationPlan const> &plan) const;
+
+  /// @return number of selections in the cache
+  size_t size() const;
+
+  /// @return number of successful searches
+  size_t hits() const;
+
+  /// @return number of successful searches of iteration plans
+  size_t planHits() const;
+
+private:
+  /// @brief drop all selections if the main table has changed
+  /// @note the mutex should be locked by the caller
+  void checkTable() const;
+
+  /// @brief main table
+  casacore::Table itsTable;
+
+  /// @brief number of rows in the main table when the cache was filled
+  mutable casacore::rownr_t itsNRow;
+
+  /// @brief maximum number of selections to keep
+  size_t itsMaxSize;
+
+  /// @brief keys in the order of use, most recent first
+  mutable std::list<std::string> itsUseOrder;
+
+  /// @brief cached tables
+  mutable std::map<std::string, casacore::Table> itsTables;
+
+  /// @brief cached iteration plans
+  mutable std::map<std::string, boost::shared_ptr<IterationPlan const> > itsPlans;
+
+  /// @brief number of successful searches
+  mutable size_t itsHits;
+
+  /// @brief number of successful searches of iteration plans
+  mutable size_t itsPlanHits;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TABLE_SELECTION_CACHE_H
@@ -54,12 +54,10 @@ using namespace askap::accessors;
 void TableTimeStampSelector::updateTableExpression(casacore::TableExprNode &tex)
 	                                           const
 {
+  const std::pair<casacore::Double, casacore::Double> startAndStop = getTableTimeRange();
+  const casacore::Double start = startAndStop.first;
+  const casacore::Double stop = startAndStop.second;
   try {    
-    const std::pair<casacore::MEpoch, casacore::MEpoch> startAndStop = getStartAndStop();
-    
-    const casacore::Double start = tableTime(startAndStop.first);
-    const casacore::Double stop = tableTime(startAndStop.second);
-            
     if (tex.isNull()) {
         tex=(table().col("TIME") > start) &&
             (table().col("TIME") < stop);
@@ -77,3 +75,24 @@ void TableTimeStampSelector::updateTableExpression(casacore::TableExprNode &tex)
          "TableTimeStampSelector::updateTableExpression: "<<ex.what());
   }
 }
+
+/// @brief obtain the time interval in the table frame
+/// @details Start and stop times are converted to the same frame and units
+/// as the TIME column. The converter should be set before this method is called.
+/// @return start and stop times (start is first, stop is second)
+std::pair<casacore::Double, casacore::Double> TableTimeStampSelector::getTableTimeRange() const
+{
+  try {
+    const std::pair<casacore::MEpoch, casacore::MEpoch> startAndStop = getStartAndStop();
+    return std::pair<casacore::Double, casacore::Double>(tableTime(startAndStop.first),
+                                                         tableTime(startAndStop.second));
+  }
+  catch(const casacore::AipsError &ae) {
+    ASKAPTHROW(DataAccessError, "casacore::AipsError has been caught inside "
+         "TableTimeStampSelector::getTableTimeRange: "<<ae.what());
+  }
+  catch (const std::exception &ex) {
+    ASKAPTHROW(DataAccessError, "std::exception has been caught inside "
+         "TableTimeStampSelector::getTableTimeRange: "<<ex.what());
+  }
+}
@@ -72,6 +72,12 @@ public:
    /// @param tex a reference to table expression to use
    virtual void updateTableExpression(casacore::TableExprNode &tex) const;
 
+   /// @brief obtain the time interval in the table frame
+   /// @details Start and stop times are converted to the same frame and units
+   /// as the TIME column. The converter should be set before this method is called.
+   /// @return start and stop times (start is first, stop is second)
+   std::pair<casacore::Double, casacore::Double> getTableTimeRange() const;
+
 protected:
   
    /// @brief This method has to be overriden in derived classes.
@@ -0,0 +1,300 @@
+/// @file
+///
+/// @brief Placement policy for the background I/O threads
+/// @details The CPUs of NUMA nodes are taken from sysfs, the threads are pinned with
+/// pthread_setaffinity_np.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/ThreadAffinity.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+// system includes
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+ASKAP_LOGGER(logger, ".ThreadAffinity");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief lock protecting the placement statistics
+boost::mutex &placementMutex()
+{
+  static boost::mutex mutex;
+  return mutex;
+}
+
+/// @brief placement statistics
+std::map<std::string, ThreadAffinity::Placement> &placementMap()
+{
+  static std::map<std::string, ThreadAffinity::Placement> placements;
+  return placements;
+}
+
+/// @brief parse the CPU list in the kernel format (e.g. "0-3,8-11")
+/// @param[in] list string to parse
+/// @return CPU numbers
+std::vector<int> parseCPUList(const std::string &list)
+{
+  std::vector<int> result;
+  std::istringstream is(list);
+  std::string range;
+  while (std::getline(is, range, ',')) {
+         if (range.empty() || range == "\n") {
+             continue;
+         }
+         const size_t dash = range.find('-');
+         const int first = std::atoi(range.substr(0, dash).c_str());
+         const int last = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+         for (int cpu = first; cpu <= last; ++cpu) {
+              result.push_back(cpu);
+         }
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+/// @brief constructor, initialises counters
+ThreadAffinity::Placement::Placement() : itsPinned(0), itsFailed(0), itsNode(-1) {}
+
+/// @brief construct the default (NONE) policy
+ThreadAffinity::ThreadAffinity() : itsPolicy(NONE), itsNode(-1) {}
+
+/// @brief construct the given policy
+/// @param[in] policy placement policy
+/// @param[in] node NUMA node for the NODE policy (ignored otherwise)
+ThreadAffinity::ThreadAffinity(Policy policy, int node) : itsPolicy(policy), itsNode(-1)
+{
+  if (itsPolicy == NODE) {
+      ASKAPCHECK(node >= 0 && node < 64, "NUMA node "<<node<<" is not supported, only nodes 0 to 63 can be used");
+      itsNode = node;
+  }
+}
+
+/// @brief create the policy from its name
+/// @details The following names are supported: "none", "consumer" and "node:N",
+/// where N is the NUMA node number.
+/// @param[in] name name of the policy
+/// @return policy object
+/// @throw AskapError if the name is not supported
+ThreadAffinity ThreadAffinity::create(const std::string &name)
+{
+  if (name == "none") {
+      return ThreadAffinity();
+  }
+  if (name == "consumer") {
+      return ThreadAffinity(CONSUMER);
+  }
+  if (name.compare(0, 5, "node:") == 0) {
+      int node = -1;
+      try {
+         node = boost::lexical_cast<int>(name.substr(5));
+      }
+      catch (const boost::bad_lexical_cast &) {
+         ASKAPTHROW(AskapError, "Unable to parse NUMA node number in the thread affinity policy "<<name);
+      }
+      return ThreadAffinity(NODE, node);
+  }
+  ASKAPTHROW(AskapError, "Thread affinity policy "<<name<<
+             " is not supported, use none, consumer or node:N");
+}
+
+/// @return name of the policy (as accepted by create)
+std::string ThreadAffinity::name() const
+{
+  if (itsPolicy == NONE) {
+      return "none";
+  }
+  if (itsPolicy == CONSUMER) {
+      return "consumer";
+  }
+  return "node:" + boost::lexical_cast<std::string>(itsNode);
+}
+
+/// @brief resolve the policy in the consuming thread
+/// @details For the CONSUMER policy, the node of the calling thread is fixed,
+/// so the result can be passed to the background thread. Other policies are
+/// returned unchanged.
+/// @return resolved policy
+ThreadAffinity ThreadAffinity::resolve() const
+{
+  ThreadAffinity result(*this);
+  if (itsPolicy == CONSUMER && itsNode < 0) {
+      result.itsNode = currentNode();
+  }
+  return result;
+}
+
+/// @brief pin the calling thread according to this policy
+/// @details Nothing is done for the NONE policy. An unresolved CONSUMER policy uses
+/// the node of the calling thread.
+/// @param[in] role name of the thread's role used for introspection (e.g. "read-ahead")
+/// @return true if the thread has been pinned
+bool ThreadAffinity::apply(const std::string &role) const
+{
+  if (itsPolicy == NONE) {
+      return false;
+  }
+  const int node = itsNode < 0 ? currentNode() : itsNode;
+  const std::vector<int> cpus = nodeCPUs(node);
+  bool success = false;
+#ifdef __linux__
+  if (cpus.size() > 0) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (std::vector<int>::const_iterator ci = cpus.begin(); ci != cpus.end(); ++ci) {
+           if (*ci >= 0 && *ci < CPU_SETSIZE) {
+               CPU_SET(*ci, &set);
+           }
+      }
+      const int status = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+      success = (status == 0);
+      if (!success) {
+          ASKAPLOG_DEBUG_STR(logger, "Unable to pin "<<role<<" thread to NUMA node "<<node<<": "<<
+                             std::strerror(status));
+      }
+  } else {
+      ASKAPLOG_DEBUG_STR(logger, "Unable to pin "<<role<<" thread, CPUs of NUMA node "<<node<<" are unknown");
+  }
+#endif
+  record(role, success, node, success ? cpus : std::vector<int>());
+  return success;
+}
+
+/// @brief allocator binding the memory to the node of this policy
+/// @details An unresolved CONSUMER policy binds to the node of the calling thread.
+/// @return shared pointer to the allocator, empty for the NONE policy
+boost::shared_ptr<ArrayAllocator const> ThreadAffinity::allocator() const
+{
+  if (itsPolicy == NONE) {
+      return boost::shared_ptr<ArrayAllocator const>();
+  }
+  return boost::shared_ptr<ArrayAllocator const>(new NumaArrayAllocator(itsNode));
+}
+
+/// @brief placement statistics of all roles
+/// @return map with the role as the key
+std::map<std::string, ThreadAffinity::Placement> ThreadAffinity::placements()
+{
+  boost::lock_guard<boost::mutex> lock(placementMutex());
+  return placementMap();
+}
+
+/// @brief reset the placement statistics
+void ThreadAffinity::resetPlacements()
+{
+  boost::lock_guard<boost::mutex> lock(placementMutex());
+  placementMap().clear();
+}
+
+/// @brief obtain the CPUs of the given NUMA node
+/// @param[in] node NUMA node number
+/// @return CPU numbers, empty if the information is unavailable
+std::vector<int> ThreadAffinity::nodeCPUs(int node)
+{
+  std::ifstream is(("/sys/devices/system/node/node" + boost::lexical_cast<std::string>(node) +
+                    "/cpulist").c_str());
+  std::string list;
+  if (!is || !std::getline(is, list)) {
+      // no NUMA information, a non-NUMA machine has a single node with all CPUs
+      return node == 0 ? currentCPUs() : std::vector<int>();
+  }
+  return parseCPUList(list);
+}
+
+/// @brief obtain the CPUs the calling thread is allowed to run on
+/// @return CPU numbers, empty if the information is unavailable
+std::vector<int> ThreadAffinity::currentCPUs()
+{
+  std::vector<int> result;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+      for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+           if (CPU_ISSET(cpu, &set)) {
+               result.push_back(cpu);
+           }
+      }
+  }
+#endif
+  return result;
+}
+
+/// @brief obtain the CPU the calling thread runs on
+/// @return CPU number, negative value if it can't be determined
+int ThreadAffinity::currentCPU()
+{
+#ifdef __linux__
+  return sched_getcpu();
+#else
+  return -1;
+#endif
+}
+
+/// @brief obtain the NUMA node of the calling thread
+/// @return node number, 0 if it can't be determined
+int ThreadAffinity::currentNode()
+{
+  return NumaArrayAllocator::currentNode();
+}
+
+/// @brief record the result of the attempt to pin a thread
+/// @param[in] role role of the thread
+/// @param[in] success true if the thread has been pinned
+/// @param[in] node NUMA node
+/// @param[in] cpus CPUs the thread has been pinned to
+void ThreadAffinity::record(const std::string &role, bool success, int node, const std::vector<int> &cpus)
+{
+  boost::lock_guard<boost::mutex> lock(placementMutex());
+  Placement &placement = placementMap()[role];
+  if (success) {
+      ++placement.itsPinned;
+      placement.itsNode = node;
+      placement.itsCPUs = cpus;
+  } else {
+      ++placement.itsFailed;
+  }
+}
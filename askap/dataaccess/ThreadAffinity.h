@@ -0,0 +1,178 @@
+/// @file
+///
+/// @brief Placement policy for the background I/O threads
+/// @details Read-ahead, write-behind and asynchronous image writer threads move large
+/// arrays which are consumed (or produced) by the compute thread. On a multi-socket
+/// machine it pays to run such threads on the socket of the compute thread and to keep
+/// the arrays in the memory attached to it. This class holds the policy and pins the
+/// calling thread accordingly.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_THREAD_AFFINITY_H
+#define ASKAP_ACCESSORS_THREAD_AFFINITY_H
+
+// own includes
+#include <askap/dataaccess/ArrayAllocator.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <map>
+#include <string>
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Placement policy for the background I/O threads
+/// @details The following policies are supported:
+/// - NONE: the threads are left to the scheduler (default);
+/// - CONSUMER: the threads are pinned to the CPUs of the NUMA node the consuming
+///   (compute) thread runs on. The node is determined when the policy is resolved
+///   (see resolve), i.e. by the thread setting up the background work;
+/// - NODE: the threads are pinned to the CPUs of the given NUMA node.
+/// The buffers exchanged with the background threads can be bound to the same node
+/// with the allocator returned by the allocator method. Each successful or failed
+/// attempt to pin a thread is counted per role, which can be examined with placements.
+/// Failures (e.g. no NUMA information available or restricted CPU set) are not fatal,
+/// such threads are left as they were.
+/// @ingroup dataaccess_hlp
+class ThreadAffinity {
+public:
+  /// @brief supported policies
+  enum Policy {
+     NONE = 0,
+     CONSUMER,
+     NODE
+  };
+
+  /// @brief placement statistics for a single role
+  struct Placement {
+     /// @brief constructor, initialises counters
+     Placement();
+     /// @brief number of threads pinned successfully
+     size_t itsPinned;
+     /// @brief number of threads which couldn't be pinned
+     size_t itsFailed;
+     /// @brief NUMA node of the last thread pinned
+     int itsNode;
+     /// @brief CPUs the last thread was pinned to
+     std::vector<int> itsCPUs;
+  };
+
+  /// @brief construct the default (NONE) policy
+  ThreadAffinity();
+
+  /// @brief construct the given policy
+  /// @param[in] policy placement policy
+  /// @param[in] node NUMA node for the NODE policy (ignored otherwise)
+  explicit ThreadAffinity(Policy policy, int node = -1);
+
+  /// @brief create the policy from its name
+  /// @details The following names are supported: "none", "consumer" and "node:N",
+  /// where N is the NUMA node number.
+  /// @param[in] name name of the policy
+  /// @return policy object
+  /// @throw AskapError if the name is not supported
+  static ThreadAffinity create(const std::string &name);
+
+  /// @return placement policy
+  inline Policy policy() const { return itsPolicy; }
+
+  /// @return NUMA node the threads are pinned to, negative value if the policy is
+  /// NONE or the CONSUMER policy hasn't been resolved yet
+  inline int node() const { return itsNode; }
+
+  /// @return name of the policy (as accepted by create)
+  std::string name() const;
+
+  /// @brief resolve the policy in the consuming thread
+  /// @details For the CONSUMER policy, the node of the calling thread is fixed,
+  /// so the result can be passed to the background thread. Other policies are
+  /// returned unchanged.
+  /// @return resolved policy
+  ThreadAffinity resolve() const;
+
+  /// @brief pin the calling thread according to this policy
+  /// @details This method is intended to be called at the start of the background
+  /// thread. Nothing is done for the NONE policy. An unresolved CONSUMER policy uses
+  /// the node of the calling thread (i.e. nothing changes except the CPU mask).
+  /// @param[in] role name of the thread's role used for introspection (e.g. "read-ahead")
+  /// @return true if the thread has been pinned
+  bool apply(const std::string &role) const;
+
+  /// @brief allocator binding the memory to the node of this policy
+  /// @details An unresolved CONSUMER policy binds to the node of the calling thread.
+  /// @return shared pointer to the allocator, empty for the NONE policy
+  boost::shared_ptr<ArrayAllocator const> allocator() const;
+
+  /// @brief placement statistics of all roles
+  /// @return map with the role as the key
+  static std::map<std::string, Placement> placements();
+
+  /// @brief reset the placement statistics
+  static void resetPlacements();
+
+  /// @brief obtain the CPUs of the given NUMA node
+  /// @param[in] node NUMA node number
+  /// @return CPU numbers, empty if the information is unavailable
+  static std::vector<int> nodeCPUs(int node);
+
+  /// @brief obtain the CPUs the calling thread is allowed to run on
+  /// @return CPU numbers, empty if the information is unavailable
+  static std::vector<int> currentCPUs();
+
+  /// @brief obtain the CPU the calling thread runs on
+  /// @return CPU number, negative value if it can't be determined
+  static int currentCPU();
+
+  /// @brief obtain the NUMA node of the calling thread
+  /// @return node number, 0 if it can't be determined
+  static int currentNode();
+
+private:
+  /// @brief record the result of the attempt to pin a thread
+  /// @param[in] role role of the thread
+  /// @param[in] success true if the thread has been pinned
+  /// @param[in] node NUMA node
+  /// @param[in] cpus CPUs the thread has been pinned to
+  static void record(const std::string &role, bool success, int node, const std::vector<int> &cpus);
+
+  /// @brief placement policy
+  Policy itsPolicy;
+
+  /// @brief NUMA node, negative if undefined
+  int itsNode;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_THREAD_AFFINITY_H
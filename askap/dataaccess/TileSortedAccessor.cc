@@ -0,0 +1,375 @@
+/// @file
+///
+/// @brief Accessor view with rows sorted into grid tiles
+/// @details This adapter exposes the rows of the parent accessor sorted by the w-plane
+/// and the uv-tile they fall into, which improves the cache locality of gridding.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/TileSortedAccessor.h>
+#include <askap/dataaccess/UVWMachineCache.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <vector>
+#include <cmath>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief number of bits required to represent the given value
+/// @param[in] value value to represent
+/// @return number of bits (0 for zero)
+casacore::uInt bitsRequired(casacore::uInt64 value)
+{
+  casacore::uInt result = 0;
+  for (; value > 0; value >>= 1) {
+       ++result;
+  }
+  return result;
+}
+
+/// @brief quantise the coordinate
+/// @param[in] value coordinate
+/// @param[in] origin lower bound of the coordinate
+/// @param[in] step cell size, zero or negative value means a single cell
+/// @return index of the cell
+casacore::uInt64 cellIndex(double value, double origin, double step)
+{
+  if (step <= 0.) {
+      return 0;
+  }
+  const double index = std::floor((value - origin) / step);
+  return index > 0. ? static_cast<casacore::uInt64>(index) : 0;
+}
+
+/// @brief permute the elements of a vector
+/// @param[in] in vector of the parent accessor
+/// @param[in] permutation index of the parent element for every output element
+/// @param[out] out permuted vector (resized as necessary)
+template<typename T>
+void permuteRows(const casacore::Vector<T> &in, const casacore::Vector<casacore::uInt> &permutation,
+                 casacore::Vector<T> &out)
+{
+  ASKAPCHECK(in.nelements() == permutation.nelements(), "Parent field has "<<in.nelements()<<
+             " rows, the permutation has "<<permutation.nelements());
+  out.resize(permutation.nelements());
+  for (casacore::uInt row = 0; row < permutation.nelements(); ++row) {
+       out[row] = in[permutation[row]];
+  }
+}
+
+/// @brief permute the rows of a cube
+/// @param[in] in cube of the parent accessor
+/// @param[in] permutation index of the parent row for every output row
+/// @param[out] out permuted cube (resized as necessary)
+template<typename T>
+void permuteRows(const casacore::Cube<T> &in, const casacore::Vector<casacore::uInt> &permutation,
+                 casacore::Cube<T> &out)
+{
+  ASKAPCHECK(in.nrow() == permutation.nelements(), "Parent field has "<<in.nrow()<<
+             " rows, the permutation has "<<permutation.nelements());
+  out.resize(in.shape());
+  for (casacore::uInt pol = 0; pol < in.nplane(); ++pol) {
+       for (casacore::uInt chan = 0; chan < in.ncolumn(); ++chan) {
+            for (casacore::uInt row = 0; row < permutation.nelements(); ++row) {
+                 out(row, chan, pol) = in(permutation[row], chan, pol);
+            }
+       }
+  }
+}
+
+/// @brief object function filling a cached field with the permuted parent's field
+/// @details Used with CachedAccessorField::value.
+template<typename T>
+struct FieldPermuter {
+  /// @brief type of the parent accessor method giving the field
+  typedef const T& (IConstDataAccessor::*Getter)() const;
+
+  /// @brief set up the object function
+  /// @param[in] parent parent accessor
+  /// @param[in] getter parent accessor method giving the field
+  /// @param[in] permutation index of the parent row for every output row
+  FieldPermuter(const IConstDataAccessor &parent, Getter getter,
+                const casacore::Vector<casacore::uInt> &permutation) :
+      itsParent(parent), itsGetter(getter), itsPermutation(permutation) {}
+
+  /// @brief fill the field
+  /// @param[out] out field to fill
+  void operator()(T &out) const { permuteRows((itsParent.*itsGetter)(), itsPermutation, out); }
+
+  /// @brief parent accessor
+  const IConstDataAccessor &itsParent;
+  /// @brief parent accessor method giving the field
+  Getter itsGetter;
+  /// @brief index of the parent row for every output row
+  const casacore::Vector<casacore::uInt> &itsPermutation;
+};
+
+/// @brief helper function to create FieldPermuter
+/// @param[in] parent parent accessor
+/// @param[in] getter parent accessor method giving the field
+/// @param[in] permutation index of the parent row for every output row
+/// @return object function
+template<typename T>
+FieldPermuter<T> permuter(const IConstDataAccessor &parent, const T& (IConstDataAccessor::*getter)() const,
+                          const casacore::Vector<casacore::uInt> &permutation)
+{
+  return FieldPermuter<T>(parent, getter, permutation);
+}
+
+} // anonymous namespace
+
+/// @brief construct the view and sort the rows
+/// @param[in] parent accessor to take rows from (reference semantics)
+/// @param[in] tangentPoint tangent point of the rotated uvw used for sorting
+/// @param[in] uvTile size of the uv-tile in metres, should be positive
+/// @param[in] wStep width of the w-plane in metres, zero or negative value means a single plane
+TileSortedAccessor::TileSortedAccessor(const IConstDataAccessor &parent, const casacore::MDirection &tangentPoint,
+                     double uvTile, double wStep) : itsParent(parent), itsTangentPoint(tangentPoint), itsNTiles(0)
+{
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &rotated = parent.rotatedUVW(tangentPoint);
+  itsNTiles = sortRows(rotated, parent.rotatedUVWBounds(tangentPoint), uvTile, wStep, itsPermutation);
+  permuteRows(rotated, itsPermutation, itsSortedRotatedUVW);
+}
+
+/// @brief compute the row permutation
+/// @details The coordinates are quantised relative to the lower corner of their bounding
+/// box, the rows are ordered by w-plane, u-tile and v-tile. The keys are sorted with the
+/// least significant digit radix sort (8 bits per pass), only the bits actually used by
+/// the keys are processed. The sort is stable.
+/// @param[in] uvw uvw for every row
+/// @param[in] bounds bounding box of uvw
+/// @param[in] uvTile size of the uv-tile, should be positive
+/// @param[in] wStep width of the w-plane, zero or negative value means a single plane
+/// @param[out] permutation index of the original row for every sorted row (resized as necessary)
+/// @return number of distinct (w-plane, uv-tile) cells occupied by the rows
+casacore::uInt TileSortedAccessor::sortRows(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                                 const UVWBounds &bounds, double uvTile, double wStep,
+                                 casacore::Vector<casacore::uInt> &permutation)
+{
+  ASKAPCHECK(uvTile > 0., "Size of the uv-tile is supposed to be positive, you have "<<uvTile);
+  const casacore::uInt nRow = uvw.nelements();
+  permutation.resize(nRow);
+  if (nRow == 0) {
+      return 0;
+  }
+  const casacore::uInt bitsU = bitsRequired(cellIndex(bounds.maxU(), bounds.minU(), uvTile));
+  const casacore::uInt bitsV = bitsRequired(cellIndex(bounds.maxV(), bounds.minV(), uvTile));
+  const casacore::uInt bitsW = bitsRequired(cellIndex(bounds.maxW(), bounds.minW(), wStep));
+  const casacore::uInt nBits = bitsU + bitsV + bitsW;
+  ASKAPCHECK(nBits <= 64, "Sort key requires "<<nBits<<" bits, use larger uv-tiles or w-planes");
+
+  std::vector<casacore::uInt64> keys(nRow);
+  std::vector<casacore::uInt> index(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       const casacore::RigidVector<casacore::Double, 3> &cur = uvw[row];
+       keys[row] = (cellIndex(cur(2), bounds.minW(), wStep) << (bitsU + bitsV)) |
+                   (cellIndex(cur(0), bounds.minU(), uvTile) << bitsV) | cellIndex(cur(1), bounds.minV(), uvTile);
+       index[row] = row;
+  }
+
+  std::vector<casacore::uInt64> keysBuf(nRow);
+  std::vector<casacore::uInt> indexBuf(nRow);
+  for (casacore::uInt shift = 0; shift < nBits; shift += 8) {
+       size_t offsets[257] = {0};
+       for (casacore::uInt row = 0; row < nRow; ++row) {
+            ++offsets[((keys[row] >> shift) & 0xff) + 1];
+       }
+       for (size_t digit = 1; digit < 257; ++digit) {
+            offsets[digit] += offsets[digit - 1];
+       }
+       for (casacore::uInt row = 0; row < nRow; ++row) {
+            const size_t dest = offsets[(keys[row] >> shift) & 0xff]++;
+            keysBuf[dest] = keys[row];
+            indexBuf[dest] = index[row];
+       }
+       keys.swap(keysBuf);
+       index.swap(indexBuf);
+  }
+
+  casacore::uInt nTiles = 1;
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       permutation[row] = index[row];
+       if ((row > 0) && (keys[row] != keys[row - 1])) {
+           ++nTiles;
+       }
+  }
+  return nTiles;
+}
+
+/// @return the number of rows in this view
+casacore::uInt TileSortedAccessor::nRow() const throw()
+{
+  return itsPermutation.nelements();
+}
+
+/// @return the number of spectral channels (equal for all rows)
+casacore::uInt TileSortedAccessor::nChannel() const throw()
+{
+  return itsParent.nChannel();
+}
+
+/// @return the number of polarization products (equal for all rows)
+casacore::uInt TileSortedAccessor::nPol() const throw()
+{
+  return itsParent.nPol();
+}
+
+/// @return a reference to nRow x nChannel x nPol cube with visibilities
+const casacore::Cube<casacore::Complex>& TileSortedAccessor::visibility() const
+{
+  return itsVisibility.value(permuter(itsParent, &IConstDataAccessor::visibility, itsPermutation));
+}
+
+/// @return a reference to nRow x nChannel x nPol cube with flags
+const casacore::Cube<casacore::Bool>& TileSortedAccessor::flag() const
+{
+  return itsFlag.value(permuter(itsParent, &IConstDataAccessor::flag, itsPermutation));
+}
+
+/// @return a reference to nRow x nChannel x nPol cube with noise figures
+const casacore::Cube<casacore::Complex>& TileSortedAccessor::noise() const
+{
+  return itsNoise.value(permuter(itsParent, &IConstDataAccessor::noise, itsPermutation));
+}
+
+/// @return a reference to vector containing uvw-coordinates for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& TileSortedAccessor::uvw() const
+{
+  return itsUVW.value(permuter(itsParent, &IConstDataAccessor::uvw, itsPermutation));
+}
+
+/// @brief uvw after rotation
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @return uvw after rotation to the new coordinate system for each row
+const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+TileSortedAccessor::rotatedUVW(const casacore::MDirection &tangentPoint) const
+{
+  if (UVWMachineCache::compare(tangentPoint, itsTangentPoint, 1e-6)) {
+      return itsSortedRotatedUVW;
+  }
+  permuteRows(itsParent.rotatedUVW(tangentPoint), itsPermutation, itsRotatedUVW);
+  return itsRotatedUVW;
+}
+
+/// @brief delay associated with uvw rotation
+/// @param[in] tangentPoint tangent point to rotate the coordinates to
+/// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+/// @return delays corresponding to the uvw rotation for each row
+const casacore::Vector<casacore::Double>& TileSortedAccessor::uvwRotationDelay(
+      const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const
+{
+  permuteRows(itsParent.uvwRotationDelay(tangentPoint, imageCentre), itsPermutation, itsDelays);
+  return itsDelays;
+}
+
+/// @return a reference to vector with the first antenna index for each row
+const casacore::Vector<casacore::uInt>& TileSortedAccessor::antenna1() const
+{
+  return itsAntenna1.value(permuter(itsParent, &IConstDataAccessor::antenna1, itsPermutation));
+}
+
+/// @return a reference to vector with the second antenna index for each row
+const casacore::Vector<casacore::uInt>& TileSortedAccessor::antenna2() const
+{
+  return itsAntenna2.value(permuter(itsParent, &IConstDataAccessor::antenna2, itsPermutation));
+}
+
+/// @return a reference to vector with the first feed index for each row
+const casacore::Vector<casacore::uInt>& TileSortedAccessor::feed1() const
+{
+  return itsFeed1.value(permuter(itsParent, &IConstDataAccessor::feed1, itsPermutation));
+}
+
+/// @return a reference to vector with the second feed index for each row
+const casacore::Vector<casacore::uInt>& TileSortedAccessor::feed2() const
+{
+  return itsFeed2.value(permuter(itsParent, &IConstDataAccessor::feed2, itsPermutation));
+}
+
+/// @return a reference to vector with position angles of the first feed for each row
+const casacore::Vector<casacore::Float>& TileSortedAccessor::feed1PA() const
+{
+  return itsFeed1PA.value(permuter(itsParent, &IConstDataAccessor::feed1PA, itsPermutation));
+}
+
+/// @return a reference to vector with position angles of the second feed for each row
+const casacore::Vector<casacore::Float>& TileSortedAccessor::feed2PA() const
+{
+  return itsFeed2PA.value(permuter(itsParent, &IConstDataAccessor::feed2PA, itsPermutation));
+}
+
+/// @return a reference to vector with pointing directions of the first antenna/feed
+const casacore::Vector<casacore::MVDirection>& TileSortedAccessor::pointingDir1() const
+{
+  return itsPointingDir1.value(permuter(itsParent, &IConstDataAccessor::pointingDir1, itsPermutation));
+}
+
+/// @return a reference to vector with pointing directions of the second antenna/feed
+const casacore::Vector<casacore::MVDirection>& TileSortedAccessor::pointingDir2() const
+{
+  return itsPointingDir2.value(permuter(itsParent, &IConstDataAccessor::pointingDir2, itsPermutation));
+}
+
+/// @return a reference to vector with pointing directions of the first dish centre
+const casacore::Vector<casacore::MVDirection>& TileSortedAccessor::dishPointing1() const
+{
+  return itsDishPointing1.value(permuter(itsParent, &IConstDataAccessor::dishPointing1, itsPermutation));
+}
+
+/// @return a reference to vector with pointing directions of the second dish centre
+const casacore::Vector<casacore::MVDirection>& TileSortedAccessor::dishPointing2() const
+{
+  return itsDishPointing2.value(permuter(itsParent, &IConstDataAccessor::dishPointing2, itsPermutation));
+}
+
+/// @return a reference to vector with frequencies of the parent accessor
+const casacore::Vector<casacore::Double>& TileSortedAccessor::frequency() const
+{
+  return itsParent.frequency();
+}
+
+/// @return a reference to vector with velocities of the parent accessor
+const casacore::Vector<casacore::Double>& TileSortedAccessor::velocity() const
+{
+  return itsParent.velocity();
+}
+
+/// @return time stamp of the parent accessor
+casacore::Double TileSortedAccessor::time() const
+{
+  return itsParent.time();
+}
+
+/// @return a reference to vector with polarisation types of the parent accessor
+const casacore::Vector<casacore::Stokes::StokesTypes>& TileSortedAccessor::stokes() const
+{
+  return itsParent.stokes();
+}
@@ -0,0 +1,253 @@
+/// @file
+///
+/// @brief Accessor view with rows sorted into grid tiles
+/// @details Rows of an accessor come in the storage order (typically, baselines for
+/// every time step), which scatters the writes of a gridder over the whole grid. This
+/// adapter exposes the rows of the parent accessor sorted by the w-plane and the uv-tile
+/// they fall into, which improves the cache locality of gridding.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_TILE_SORTED_ACCESSOR_H
+#define ASKAP_ACCESSORS_TILE_SORTED_ACCESSOR_H
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/CachedAccessorField.h>
+
+// casa includes
+#include <casacore/measures/Measures/MDirection.h>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Accessor view with rows sorted into grid tiles
+/// @details Row i of this view is row permutation()[i] of the parent accessor. The permutation
+/// is computed once at construction from the rotated uvw of the parent accessor: the
+/// coordinates are quantised into w-planes of the given width and square uv-tiles of the
+/// given size, and the rows are ordered by w-plane, then by u-tile, then by v-tile with a
+/// stable radix sort, so the rows within a tile keep the storage order. If the parent is a
+/// BestWPlaneDataAccessor, the planes correspond to the residual w-term after the best plane
+/// is subtracted.
+///
+/// Code which can work with indices (e.g. a gridder taking a row list) can use the
+/// permutation with the fields of the parent directly, without any copy. Otherwise, the
+/// row-based fields of this view are copied into the sorted order on the first request and
+/// cached. The spectral fields and time are those of the parent. The parent accessor has to
+/// stay valid (i.e. the iterator must not be advanced) while the view is in use.
+///
+/// The rotated uvw and delays are permuted on every call, except the rotated uvw for the
+/// tangent point used for sorting, which are cached.
+/// @ingroup dataaccess_hlp
+class TileSortedAccessor : virtual public IConstDataAccessor
+{
+public:
+  /// @brief construct the view and sort the rows
+  /// @param[in] parent accessor to take rows from (reference semantics)
+  /// @param[in] tangentPoint tangent point of the rotated uvw used for sorting
+  /// @param[in] uvTile size of the uv-tile in metres, should be positive
+  /// @param[in] wStep width of the w-plane in metres, zero or negative value means a single plane
+  TileSortedAccessor(const IConstDataAccessor &parent, const casacore::MDirection &tangentPoint,
+                     double uvTile, double wStep = 0.);
+
+  /// @return parent accessor
+  inline const IConstDataAccessor& parent() const { return itsParent; }
+
+  /// @brief row permutation
+  /// @return vector with the index of the parent row for every row of this view
+  inline const casacore::Vector<casacore::uInt>& permutation() const { return itsPermutation; }
+
+  /// @return number of distinct (w-plane, uv-tile) cells occupied by the rows
+  inline casacore::uInt nTiles() const { return itsNTiles; }
+
+  /// @brief compute the row permutation
+  /// @details The coordinates are quantised relative to the lower corner of their bounding
+  /// box, the rows are ordered by w-plane, u-tile and v-tile. The sort is stable.
+  /// @param[in] uvw uvw for every row
+  /// @param[in] bounds bounding box of uvw
+  /// @param[in] uvTile size of the uv-tile, should be positive
+  /// @param[in] wStep width of the w-plane, zero or negative value means a single plane
+  /// @param[out] permutation index of the original row for every sorted row (resized as necessary)
+  /// @return number of distinct (w-plane, uv-tile) cells occupied by the rows
+  static casacore::uInt sortRows(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw,
+                                 const UVWBounds &bounds, double uvTile, double wStep,
+                                 casacore::Vector<casacore::uInt> &permutation);
+
+  // IConstDataAccessor interface
+
+  /// @return the number of rows in this view
+  virtual casacore::uInt nRow() const throw();
+
+  /// @return the number of spectral channels (equal for all rows)
+  virtual casacore::uInt nChannel() const throw();
+
+  /// @return the number of polarization products (equal for all rows)
+  virtual casacore::uInt nPol() const throw();
+
+  /// @return a reference to nRow x nChannel x nPol cube with visibilities
+  virtual const casacore::Cube<casacore::Complex>& visibility() const;
+
+  /// @return a reference to nRow x nChannel x nPol cube with flags
+  virtual const casacore::Cube<casacore::Bool>& flag() const;
+
+  /// @return a reference to nRow x nChannel x nPol cube with noise figures
+  virtual const casacore::Cube<casacore::Complex>& noise() const;
+
+  /// @return a reference to vector containing uvw-coordinates for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw() const;
+
+  /// @brief uvw after rotation
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @return uvw after rotation to the new coordinate system for each row
+  virtual const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >&
+          rotatedUVW(const casacore::MDirection &tangentPoint) const;
+
+  /// @brief delay associated with uvw rotation
+  /// @param[in] tangentPoint tangent point to rotate the coordinates to
+  /// @param[in] imageCentre image centre (additional translation is done if imageCentre!=tangentPoint)
+  /// @return delays corresponding to the uvw rotation for each row
+  virtual const casacore::Vector<casacore::Double>& uvwRotationDelay(
+          const casacore::MDirection &tangentPoint, const casacore::MDirection &imageCentre) const;
+
+  /// @return a reference to vector with the first antenna index for each row
+  virtual const casacore::Vector<casacore::uInt>& antenna1() const;
+
+  /// @return a reference to vector with the second antenna index for each row
+  virtual const casacore::Vector<casacore::uInt>& antenna2() const;
+
+  /// @return a reference to vector with the first feed index for each row
+  virtual const casacore::Vector<casacore::uInt>& feed1() const;
+
+  /// @return a reference to vector with the second feed index for each row
+  virtual const casacore::Vector<casacore::uInt>& feed2() const;
+
+  /// @return a reference to vector with position angles of the first feed for each row
+  virtual const casacore::Vector<casacore::Float>& feed1PA() const;
+
+  /// @return a reference to vector with position angles of the second feed for each row
+  virtual const casacore::Vector<casacore::Float>& feed2PA() const;
+
+  /// @return a reference to vector with pointing directions of the first antenna/feed
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir1() const;
+
+  /// @return a reference to vector with pointing directions of the second antenna/feed
+  virtual const casacore::Vector<casacore::MVDirection>& pointingDir2() const;
+
+  /// @return a reference to vector with pointing directions of the first dish centre
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing1() const;
+
+  /// @return a reference to vector with pointing directions of the second dish centre
+  virtual const casacore::Vector<casacore::MVDirection>& dishPointing2() const;
+
+  /// @return a reference to vector with frequencies of the parent accessor
+  virtual const casacore::Vector<casacore::Double>& frequency() const;
+
+  /// @return a reference to vector with velocities of the parent accessor
+  virtual const casacore::Vector<casacore::Double>& velocity() const;
+
+  /// @return time stamp of the parent accessor
+  virtual casacore::Double time() const;
+
+  /// @return a reference to vector with polarisation types of the parent accessor
+  virtual const casacore::Vector<casacore::Stokes::StokesTypes>& stokes() const;
+
+private:
+  /// @brief copy is not supported
+  TileSortedAccessor(const TileSortedAccessor &);
+
+  /// @brief assignment is not supported
+  TileSortedAccessor& operator=(const TileSortedAccessor &);
+
+  /// @brief parent accessor
+  const IConstDataAccessor &itsParent;
+
+  /// @brief tangent point used for sorting
+  casacore::MDirection itsTangentPoint;
+
+  /// @brief index of the parent row for every row of this view
+  casacore::Vector<casacore::uInt> itsPermutation;
+
+  /// @brief number of distinct cells occupied by the rows
+  casacore::uInt itsNTiles;
+
+  /// @brief sorted visibilities
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsVisibility;
+
+  /// @brief sorted flags
+  CachedAccessorField<casacore::Cube<casacore::Bool> > itsFlag;
+
+  /// @brief sorted noise
+  CachedAccessorField<casacore::Cube<casacore::Complex> > itsNoise;
+
+  /// @brief sorted uvw
+  CachedAccessorField<casacore::Vector<casacore::RigidVector<casacore::Double, 3> > > itsUVW;
+
+  /// @brief sorted rotated uvw for the tangent point used for sorting
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsSortedRotatedUVW;
+
+  /// @brief sorted first antenna indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsAntenna1;
+
+  /// @brief sorted second antenna indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsAntenna2;
+
+  /// @brief sorted first feed indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsFeed1;
+
+  /// @brief sorted second feed indices
+  CachedAccessorField<casacore::Vector<casacore::uInt> > itsFeed2;
+
+  /// @brief sorted position angles of the first feed
+  CachedAccessorField<casacore::Vector<casacore::Float> > itsFeed1PA;
+
+  /// @brief sorted position angles of the second feed
+  CachedAccessorField<casacore::Vector<casacore::Float> > itsFeed2PA;
+
+  /// @brief sorted pointing directions of the first antenna/feed
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsPointingDir1;
+
+  /// @brief sorted pointing directions of the second antenna/feed
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsPointingDir2;
+
+  /// @brief sorted pointing directions of the first dish centre
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsDishPointing1;
+
+  /// @brief sorted pointing directions of the second dish centre
+  CachedAccessorField<casacore::Vector<casacore::MVDirection> > itsDishPointing2;
+
+  /// @brief sorted rotated uvw for other tangent points (formed on every call)
+  mutable casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsRotatedUVW;
+
+  /// @brief sorted delays (formed on every call)
+  mutable casacore::Vector<casacore::Double> itsDelays;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TILE_SORTED_ACCESSOR_H
@@ -0,0 +1,282 @@
+/// @file
+///
+/// @brief Iterator adapter averaging consecutive integrations
+/// @details This adapter averages the given number of consecutive integrations of the
+/// wrapped iterator per baseline.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/TimeAveragingIteratorAdapter.h>
+#include <askap/dataaccess/IDataSelector.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
+
+// std includes
+#include <cmath>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief setup with the given iterator
+/// @param[in] iter shared pointer to iterator to be wrapped
+/// @param[in] nIntegrations number of consecutive integrations to average
+/// @param[in] maxRows maximum number of rows (baselines) accumulated at a time, 0 means
+///            no restriction (a single accessor of the wrapped iterator is always accepted)
+/// @param[in] fields accessor fields to average (bitwise combination of
+///            IDataSelector::AccessorFields values)
+TimeAveragingIteratorAdapter::TimeAveragingIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter,
+                               casacore::uInt nIntegrations, size_t maxRows, casacore::uInt fields) :
+      itsIterator(iter), itsNIntegrations(nIntegrations), itsMaxRows(maxRows),
+      itsFields(fields | IDataSelector::VISIBILITY | IDataSelector::ANTENNA), itsAccessorsAveraged(0),
+      itsNChannel(0), itsNPol(0), itsAccessor(false), itsHasMore(false)
+{
+  ASKAPCHECK(itsIterator, "An attempt to initialise TimeAveragingIteratorAdapter with empty shared pointer");
+  ASKAPCHECK(itsNIntegrations > 0, "Number of integrations to average should be positive");
+  averageNextInterval();
+}
+
+/// @brief restart the iteration from the beginning
+void TimeAveragingIteratorAdapter::init()
+{
+  itsIterator->init();
+  averageNextInterval();
+}
+
+/// @brief access the current averaged accessor
+/// @return a reference to the current chunk
+const IConstDataAccessor& TimeAveragingIteratorAdapter::operator*() const
+{
+  ASKAPCHECK(itsHasMore, "TimeAveragingIteratorAdapter has reached the end of the data");
+  return itsAccessor;
+}
+
+/// @brief checks whether there are more data available
+/// @return true if there are more data available
+casacore::Bool TimeAveragingIteratorAdapter::hasMore() const throw()
+{
+  return itsHasMore;
+}
+
+/// @brief advance the iterator one step further
+/// @return True if there are more data (so constructions like
+///         while(it.next()) {} are possible)
+casacore::Bool TimeAveragingIteratorAdapter::next()
+{
+  averageNextInterval();
+  return itsHasMore;
+}
+
+/// @brief accumulate the next averaging interval and form the output accessor
+/// @details The wrapped iterator is left at the first accessor which doesn't belong
+/// to the interval.
+void TimeAveragingIteratorAdapter::averageNextInterval()
+{
+  itsRows.clear();
+  itsAccumulators.clear();
+  itsTimes.clear();
+  itsAccessorsAveraged = 0;
+  for (; itsIterator->hasMore(); itsIterator->next()) {
+       const IConstDataAccessor &acc = **itsIterator;
+       if (itsAccessorsAveraged > 0 && !fitsInterval(acc)) {
+           break;
+       }
+       if (itsAccessorsAveraged == 0) {
+           itsNChannel = acc.nChannel();
+           itsNPol = acc.nPol();
+           if (itsFields & IDataSelector::FREQUENCY) {
+               itsFrequency.assign(acc.frequency());
+           }
+           if (itsFields & IDataSelector::STOKES) {
+               itsAccessor.itsStokes.assign(acc.stokes());
+           }
+       }
+       if (itsTimes.empty() || (itsTimes.back() != acc.time())) {
+           itsTimes.push_back(acc.time());
+       }
+       accumulate(acc);
+       ++itsAccessorsAveraged;
+  }
+  itsHasMore = itsAccessorsAveraged > 0;
+  if (itsHasMore) {
+      formAccessor();
+  }
+}
+
+/// @brief check whether the given accessor can be added to the current interval
+/// @param[in] acc accessor of the wrapped iterator
+/// @return true, if the accessor is compatible with the current interval
+bool TimeAveragingIteratorAdapter::fitsInterval(const IConstDataAccessor &acc) const
+{
+  ASKAPDEBUGASSERT(!itsTimes.empty());
+  if ((itsTimes.back() != acc.time()) && (itsTimes.size() >= itsNIntegrations)) {
+      return false;
+  }
+  if ((acc.nChannel() != itsNChannel) || (acc.nPol() != itsNPol)) {
+      return false;
+  }
+  if (itsFields & IDataSelector::FREQUENCY) {
+      const casacore::Vector<casacore::Double> &freq = acc.frequency();
+      if ((freq.nelements() != itsFrequency.nelements()) || !casacore::allEQ(freq, itsFrequency)) {
+          return false;
+      }
+  }
+  if (itsMaxRows > 0) {
+      size_t newRows = 0;
+      for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+           if (itsRows.find(baseline(acc, row)) == itsRows.end()) {
+               ++newRows;
+           }
+      }
+      if (itsAccumulators.size() + newRows > itsMaxRows) {
+          return false;
+      }
+  }
+  return true;
+}
+
+/// @brief obtain baseline of the given row
+/// @param[in] acc accessor of the wrapped iterator
+/// @param[in] row row number
+/// @return baseline key
+TimeAveragingIteratorAdapter::BaselineKey TimeAveragingIteratorAdapter::baseline(const IConstDataAccessor &acc,
+                                                                                 casacore::uInt row) const
+{
+  const bool useFeeds = itsFields & IDataSelector::FEED;
+  return BaselineKey(acc.antenna1()[row], acc.antenna2()[row], useFeeds ? acc.feed1()[row] : 0,
+                     useFeeds ? acc.feed2()[row] : 0);
+}
+
+/// @brief add the given accessor to the sums
+/// @param[in] acc accessor of the wrapped iterator
+void TimeAveragingIteratorAdapter::accumulate(const IConstDataAccessor &acc)
+{
+  const casacore::Cube<casacore::Complex> &vis = acc.visibility();
+  const bool useFlags = itsFields & IDataSelector::FLAG;
+  const bool useNoise = itsFields & IDataSelector::NOISE;
+  const bool useUVW = itsFields & IDataSelector::UVW;
+  const size_t nSamples = size_t(itsNChannel) * itsNPol;
+  for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+       const std::pair<std::map<BaselineKey, casacore::uInt>::iterator, bool> res =
+             itsRows.insert(std::make_pair(baseline(acc, row), casacore::uInt(itsAccumulators.size())));
+       if (res.second) {
+           itsAccumulators.push_back(Accumulator());
+           Accumulator &newAcc = itsAccumulators.back();
+           newAcc.itsSum.assign(nSamples, casacore::Complex(0., 0.));
+           newAcc.itsWeight.assign(nSamples, 0.);
+           newAcc.itsAllSum.assign(nSamples, casacore::Complex(0., 0.));
+           newAcc.itsAllWeight.assign(nSamples, 0.);
+           newAcc.itsUVW = casacore::RigidVector<casacore::Double, 3>(0., 0., 0.);
+           newAcc.itsCount = 0;
+       }
+       Accumulator &sums = itsAccumulators[res.first->second];
+       for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+            for (casacore::uInt chan = 0; chan < itsNChannel; ++chan) {
+                 const size_t index = size_t(pol) * itsNChannel + chan;
+                 float weight = 1.;
+                 if (useNoise) {
+                     const float sigma = casacore::real(acc.noise()(row, chan, pol));
+                     weight = sigma > 0. ? 1. / (sigma * sigma) : 0.;
+                 }
+                 const casacore::Complex value = vis(row, chan, pol) * weight;
+                 sums.itsAllSum[index] += value;
+                 sums.itsAllWeight[index] += weight;
+                 if (!useFlags || !acc.flag()(row, chan, pol)) {
+                     sums.itsSum[index] += value;
+                     sums.itsWeight[index] += weight;
+                 }
+            }
+       }
+       if (useUVW) {
+           sums.itsUVW += acc.uvw()[row];
+       }
+       ++sums.itsCount;
+  }
+}
+
+/// @brief form the output accessor from the sums
+void TimeAveragingIteratorAdapter::formAccessor()
+{
+  const casacore::uInt nRow = casacore::uInt(itsAccumulators.size());
+  double time = 0.;
+  for (std::vector<double>::const_iterator ci = itsTimes.begin(); ci != itsTimes.end(); ++ci) {
+       time += *ci;
+  }
+  itsAccessor.itsTime = time / itsTimes.size();
+  itsAccessor.itsVisibility.resize(nRow, itsNChannel, itsNPol);
+  itsAccessor.itsAntenna1.resize(nRow);
+  itsAccessor.itsAntenna2.resize(nRow);
+  const bool useFeeds = itsFields & IDataSelector::FEED;
+  if (useFeeds) {
+      itsAccessor.itsFeed1.resize(nRow);
+      itsAccessor.itsFeed2.resize(nRow);
+  }
+  if (itsFields & IDataSelector::FLAG) {
+      itsAccessor.itsFlag.resize(nRow, itsNChannel, itsNPol);
+  }
+  if (itsFields & IDataSelector::NOISE) {
+      itsAccessor.itsNoise.resize(nRow, itsNChannel, itsNPol);
+  }
+  if (itsFields & IDataSelector::UVW) {
+      itsAccessor.itsUVW.resize(nRow);
+  }
+  if (itsFields & IDataSelector::FREQUENCY) {
+      itsAccessor.itsFrequency.assign(itsFrequency);
+  }
+  for (std::map<BaselineKey, casacore::uInt>::const_iterator ci = itsRows.begin(); ci != itsRows.end(); ++ci) {
+       const casacore::uInt row = ci->second;
+       itsAccessor.itsAntenna1[row] = std::get<0>(ci->first);
+       itsAccessor.itsAntenna2[row] = std::get<1>(ci->first);
+       if (useFeeds) {
+           itsAccessor.itsFeed1[row] = std::get<2>(ci->first);
+           itsAccessor.itsFeed2[row] = std::get<3>(ci->first);
+       }
+       const Accumulator &sums = itsAccumulators[row];
+       for (casacore::uInt pol = 0; pol < itsNPol; ++pol) {
+            for (casacore::uInt chan = 0; chan < itsNChannel; ++chan) {
+                 const size_t index = size_t(pol) * itsNChannel + chan;
+                 const bool flagged = !(sums.itsWeight[index] > 0.);
+                 const float weight = flagged ? sums.itsAllWeight[index] : sums.itsWeight[index];
+                 const casacore::Complex &sum = flagged ? sums.itsAllSum[index] : sums.itsSum[index];
+                 itsAccessor.itsVisibility(row, chan, pol) = weight > 0. ? sum / weight : casacore::Complex(0., 0.);
+                 if (itsFields & IDataSelector::FLAG) {
+                     itsAccessor.itsFlag(row, chan, pol) = flagged;
+                 }
+                 if (itsFields & IDataSelector::NOISE) {
+                     const float sigma = weight > 0. ? 1. / std::sqrt(weight) : 1.;
+                     itsAccessor.itsNoise(row, chan, pol) = casacore::Complex(sigma, sigma);
+                 }
+            }
+       }
+       if (itsFields & IDataSelector::UVW) {
+           ASKAPDEBUGASSERT(sums.itsCount > 0);
+           itsAccessor.itsUVW[row] = sums.itsUVW;
+           itsAccessor.itsUVW[row] *= 1. / sums.itsCount;
+       }
+  }
+}
@@ -0,0 +1,205 @@
+/// @file
+///
+/// @brief Iterator adapter averaging consecutive integrations
+/// @details TimeChunkIteratorAdapter groups the accessors in time, but doesn't combine them.
+/// This adapter averages the given number of consecutive integrations per baseline, so
+/// the downstream stages (e.g. slow-cadence calibration or imaging of extended sources)
+/// receive a few times less data.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_TIME_AVERAGING_ITERATOR_ADAPTER_H
+#define ASKAP_ACCESSORS_TIME_AVERAGING_ITERATOR_ADAPTER_H
+
+// own includes
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+#include <askap/dataaccess/TimeChunkBuffer.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <map>
+#include <vector>
+#include <tuple>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Iterator adapter averaging consecutive integrations
+/// @details Each accessor delivered by this adapter is the average of up to nIntegrations
+/// consecutive time stamps of the wrapped iterator. The rows are accumulated per baseline,
+/// i.e. per (antenna1, antenna2, feed1, feed2) combination, in the order of the first
+/// appearance. The averaging is flag- and noise-weighted: flagged samples don't contribute,
+/// unflagged samples are weighted by 1/sigma^2. An output sample is flagged if no unflagged
+/// samples with positive weight contributed to it, its value is the weighted average of all
+/// samples in this case. The noise is that of the weighted average. Time and uvw are the
+/// means over the integrations the baseline is present in (time is the same for all rows).
+///
+/// An averaging interval is closed early if the spectral axis (number of channels or
+/// polarisations, or frequencies) changes, so the wrapped iterator should deliver a single
+/// spectral window (e.g. via the selector). The number of accumulated rows can be bounded,
+/// the interval is also closed early if the next accessor would exceed this bound.
+///
+/// Only the fields given at construction are averaged (visibilities and antenna indices are
+/// always required), the other fields of the delivered accessors are empty, as for
+/// TimeChunkBuffer. rotatedUVW returns the averaged uvw, and there is no write access
+/// to the averaged data.
+/// @ingroup dataaccess_hlp
+class TimeAveragingIteratorAdapter : virtual public IConstDataIterator,
+                                     public boost::noncopyable
+{
+public:
+  /// @brief setup with the given iterator
+  /// @param[in] iter shared pointer to iterator to be wrapped
+  /// @param[in] nIntegrations number of consecutive integrations to average
+  /// @param[in] maxRows maximum number of rows (baselines) accumulated at a time, 0 means
+  ///            no restriction (a single accessor of the wrapped iterator is always accepted)
+  /// @param[in] fields accessor fields to average (bitwise combination of
+  ///            IDataSelector::AccessorFields values)
+  TimeAveragingIteratorAdapter(const boost::shared_ptr<IConstDataIterator> &iter,
+                               casacore::uInt nIntegrations, size_t maxRows = 0,
+                               casacore::uInt fields = TimeChunkBuffer::defaultFields());
+
+  /// @brief restart the iteration from the beginning
+  virtual void init();
+
+  /// @brief access the current averaged accessor
+  /// @return a reference to the current chunk
+  virtual const IConstDataAccessor& operator*() const;
+
+  /// @brief checks whether there are more data available
+  /// @return true if there are more data available
+  virtual casacore::Bool hasMore() const throw();
+
+  /// @brief advance the iterator one step further
+  /// @return True if there are more data (so constructions like
+  ///         while(it.next()) {} are possible)
+  virtual casacore::Bool next();
+
+  /// @return number of consecutive integrations to average
+  inline casacore::uInt nIntegrations() const { return itsNIntegrations; }
+
+  /// @return maximum number of rows accumulated at a time, 0 means no restriction
+  inline size_t maxRows() const { return itsMaxRows; }
+
+  /// @return number of integrations averaged into the current accessor
+  inline casacore::uInt integrationsAveraged() const { return casacore::uInt(itsTimes.size()); }
+
+  /// @return number of accessors of the wrapped iterator averaged into the current one
+  inline size_t accessorsAveraged() const { return itsAccessorsAveraged; }
+
+private:
+  /// @brief baseline: antenna1, antenna2, feed1, feed2
+  typedef std::tuple<casacore::uInt, casacore::uInt, casacore::uInt, casacore::uInt> BaselineKey;
+
+  /// @brief sums accumulated for one baseline
+  /// @details The spectral data are stored for nChannel x nPol samples (channel
+  /// changes fastest).
+  struct Accumulator {
+    /// @brief weighted sum of unflagged samples
+    std::vector<casacore::Complex> itsSum;
+    /// @brief sum of weights of unflagged samples
+    std::vector<casacore::Float> itsWeight;
+    /// @brief weighted sum of all samples
+    std::vector<casacore::Complex> itsAllSum;
+    /// @brief sum of weights of all samples
+    std::vector<casacore::Float> itsAllWeight;
+    /// @brief sum of uvw
+    casacore::RigidVector<casacore::Double, 3> itsUVW;
+    /// @brief number of integrations added
+    casacore::uInt itsCount;
+  };
+
+  /// @brief accumulate the next averaging interval and form the output accessor
+  void averageNextInterval();
+
+  /// @brief check whether the given accessor can be added to the current interval
+  /// @param[in] acc accessor of the wrapped iterator
+  /// @return true, if the accessor is compatible with the current interval
+  bool fitsInterval(const IConstDataAccessor &acc) const;
+
+  /// @brief obtain baseline of the given row
+  /// @param[in] acc accessor of the wrapped iterator
+  /// @param[in] row row number
+  /// @return baseline key
+  BaselineKey baseline(const IConstDataAccessor &acc, casacore::uInt row) const;
+
+  /// @brief add the given accessor to the sums
+  /// @param[in] acc accessor of the wrapped iterator
+  void accumulate(const IConstDataAccessor &acc);
+
+  /// @brief form the output accessor from the sums
+  void formAccessor();
+
+  /// @brief wrapped iterator
+  boost::shared_ptr<IConstDataIterator> itsIterator;
+
+  /// @brief number of consecutive integrations to average
+  casacore::uInt itsNIntegrations;
+
+  /// @brief maximum number of rows accumulated at a time, 0 means no restriction
+  size_t itsMaxRows;
+
+  /// @brief fields to average
+  casacore::uInt itsFields;
+
+  /// @brief row of the output accessor for each baseline
+  std::map<BaselineKey, casacore::uInt> itsRows;
+
+  /// @brief sums for each row of the output accessor
+  std::vector<Accumulator> itsAccumulators;
+
+  /// @brief time stamps of the integrations in the current interval
+  std::vector<double> itsTimes;
+
+  /// @brief number of accessors averaged into the current one
+  size_t itsAccessorsAveraged;
+
+  /// @brief number of channels in the current interval
+  casacore::uInt itsNChannel;
+
+  /// @brief number of polarisations in the current interval
+  casacore::uInt itsNPol;
+
+  /// @brief frequencies of the current interval (if averaged)
+  casacore::Vector<casacore::Double> itsFrequency;
+
+  /// @brief output accessor
+  DataAccessorStub itsAccessor;
+
+  /// @brief true if the output accessor is valid
+  bool itsHasMore;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TIME_AVERAGING_ITERATOR_ADAPTER_H
@@ -0,0 +1,299 @@
+/// @file
+///
+/// @brief Bounded buffer of time chunks read in the background
+/// @details TimeChunkIteratorAdapter splits the iteration into chunks of the given
+/// time interval. This class runs the adapter in a producer thread and keeps up to
+/// the given number of chunks in memory.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/TimeChunkBuffer.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+ASKAP_LOGGER(logger, ".TimeChunkBuffer");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the buffer and start reading
+/// @param[in] iter iterator to read, it is wrapped into TimeChunkIteratorAdapter
+/// @param[in] interval maximum time span of a single chunk (in seconds), negative
+///            value means the whole dataset is a single chunk
+/// @param[in] maxChunks maximum number of chunks held in memory
+/// @param[in] fields accessor fields to copy (bitwise combination of
+///            IDataSelector::AccessorFields values)
+TimeChunkBuffer::TimeChunkBuffer(const boost::shared_ptr<IConstDataIterator> &iter, double interval,
+                  size_t maxChunks, casacore::uInt fields) :
+      itsMaxChunks(maxChunks), itsFields(fields | IDataSelector::VISIBILITY), itsFinished(false),
+      itsStopRequested(false), itsChunksRead(0), itsPeakChunksHeld(0), itsProducerWaits(0),
+      itsProducerWaitTime(0.), itsConsumerWaits(0), itsConsumerWaitTime(0.)
+{
+  ASKAPCHECK(iter, "An attempt to initialise TimeChunkBuffer with empty shared pointer");
+  ASKAPCHECK(itsMaxChunks > 0, "TimeChunkBuffer should be able to hold at least one chunk");
+  if (iter->hasMore()) {
+      itsIterator.reset(new TimeChunkIteratorAdapter(iter, interval));
+      itsProducerThread.reset(new boost::thread(boost::bind(&TimeChunkBuffer::produce, this)));
+  } else {
+      itsFinished = true;
+  }
+}
+
+/// @brief destructor, stops the producer thread
+TimeChunkBuffer::~TimeChunkBuffer()
+{
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsStopRequested = true;
+  }
+  itsChunkReleased.notify_all();
+  if (itsProducerThread) {
+      itsProducerThread->join();
+      itsProducerThread.reset();
+  }
+  if (itsChunksRead > 0) {
+      ASKAPLOG_DEBUG_STR(logger, "Time chunk buffer: "<<itsChunksRead<<" chunk(s) read, peak usage "<<
+                  itsPeakChunksHeld<<" out of "<<itsMaxChunks<<" slot(s); producer waited "<<itsProducerWaits<<
+                  " time(s) for "<<itsProducerWaitTime<<" s, consumer waited "<<itsConsumerWaits<<
+                  " time(s) for "<<itsConsumerWaitTime<<" s");
+  }
+}
+
+/// @brief check whether the given chunk is available
+/// @details The method waits until the chunk has been read or the end of the data
+/// is reached.
+/// @param[in] offset position of the chunk with respect to the current one,
+///            has to be less than maxChunks
+/// @return true, if the chunk exists
+bool TimeChunkBuffer::hasChunk(size_t offset) const
+{
+  ASKAPCHECK(offset < itsMaxChunks, "Unable to look "<<offset<<" chunk(s) ahead, the buffer holds only "<<
+             itsMaxChunks<<" chunk(s)");
+  boost::unique_lock<boost::mutex> lock(itsMutex);
+  if (itsChunks.size() <= offset && !itsFinished) {
+      ++itsConsumerWaits;
+      const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+      while (itsChunks.size() <= offset && !itsFinished) {
+             itsChunkAdded.wait(lock);
+      }
+      itsConsumerWaitTime += boost::chrono::duration<double>(boost::chrono::steady_clock::now() - start).count();
+  }
+  if (itsChunks.size() > offset) {
+      return true;
+  }
+  if (itsError) {
+      std::rethrow_exception(itsError);
+  }
+  return false;
+}
+
+/// @brief obtain the given chunk
+/// @details The method waits until the chunk has been read, an exception is
+/// thrown if there is no such chunk.
+/// @param[in] offset position of the chunk with respect to the current one,
+///            has to be less than maxChunks
+/// @return shared pointer to the chunk
+boost::shared_ptr<TimeChunkBuffer::Chunk const> TimeChunkBuffer::chunk(size_t offset) const
+{
+  ASKAPCHECK(hasChunk(offset), "There is no chunk at offset "<<offset<<", the end of the data has been reached");
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  ASKAPDEBUGASSERT(offset < itsChunks.size());
+  return itsChunks[offset];
+}
+
+/// @brief release the current chunk and proceed to the next one
+/// @details The producer is allowed to read one more chunk in the freed slot.
+void TimeChunkBuffer::next()
+{
+  ASKAPCHECK(hasChunk(), "There are no more chunks available");
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsChunks.pop_front();
+  }
+  itsChunkReleased.notify_all();
+}
+
+/// @return number of chunks read so far
+size_t TimeChunkBuffer::chunksRead() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsChunksRead;
+}
+
+/// @return maximum number of chunks held at the same time
+size_t TimeChunkBuffer::peakChunksHeld() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsPeakChunksHeld;
+}
+
+/// @return number of times the producer had to wait because the buffer was full
+size_t TimeChunkBuffer::producerWaits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsProducerWaits;
+}
+
+/// @return total time in seconds the producer spent waiting for a free slot
+double TimeChunkBuffer::producerWaitTime() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsProducerWaitTime;
+}
+
+/// @return number of times the consumer had to wait for a chunk to be read
+size_t TimeChunkBuffer::consumerWaits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsConsumerWaits;
+}
+
+/// @return total time in seconds the consumer spent waiting for data
+double TimeChunkBuffer::consumerWaitTime() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsConsumerWaitTime;
+}
+
+/// @return fields copied by default (all except pointing directions and position angles)
+casacore::uInt TimeChunkBuffer::defaultFields()
+{
+  return IDataSelector::VISIBILITY | IDataSelector::FLAG | IDataSelector::NOISE | IDataSelector::UVW |
+         IDataSelector::FREQUENCY | IDataSelector::ANTENNA | IDataSelector::FEED | IDataSelector::STOKES;
+}
+
+/// @brief body of the producer thread
+/// @details Errors are stored in itsError to be rethrown in the consumer thread
+void TimeChunkBuffer::produce()
+{
+  ASKAPDEBUGASSERT(itsIterator);
+  try {
+     TimeChunkIteratorAdapter &it = *itsIterator;
+     while (it.moreDataAvailable()) {
+            {
+              boost::lock_guard<boost::mutex> lock(itsMutex);
+              if (itsStopRequested) {
+                  break;
+              }
+            }
+            boost::shared_ptr<Chunk> chunk(new Chunk);
+            chunk->itsTime = it->time();
+            for (; it.hasMore(); it.next()) {
+                 chunk->itsAccessors.push_back(copyAccessor(*it, itsFields));
+            }
+            {
+              boost::unique_lock<boost::mutex> lock(itsMutex);
+              if (itsChunks.size() >= itsMaxChunks && !itsStopRequested) {
+                  ++itsProducerWaits;
+                  const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+                  while (itsChunks.size() >= itsMaxChunks && !itsStopRequested) {
+                         itsChunkReleased.wait(lock);
+                  }
+                  itsProducerWaitTime += boost::chrono::duration<double>(boost::chrono::steady_clock::now() -
+                                         start).count();
+              }
+              if (itsStopRequested) {
+                  break;
+              }
+              itsChunks.push_back(chunk);
+              ++itsChunksRead;
+              if (itsChunks.size() > itsPeakChunksHeld) {
+                  itsPeakChunksHeld = itsChunks.size();
+              }
+            }
+            itsChunkAdded.notify_all();
+            if (it.moreDataAvailable()) {
+                it.resume();
+            }
+     }
+  }
+  catch (...) {
+     boost::lock_guard<boost::mutex> lock(itsMutex);
+     itsError = std::current_exception();
+  }
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsFinished = true;
+  }
+  itsChunkAdded.notify_all();
+}
+
+/// @brief make a copy of the given accessor
+/// @details Only the given fields are copied, the visibility cube is always copied.
+/// @param[in] acc accessor to copy
+/// @param[in] fields accessor fields to copy (bitwise combination of
+///            IDataSelector::AccessorFields values)
+/// @return shared pointer to the copy
+boost::shared_ptr<IConstDataAccessor const> TimeChunkBuffer::copyAccessor(const IConstDataAccessor &acc,
+                                                                          casacore::uInt fields)
+{
+  boost::shared_ptr<DataAccessorStub> result(new DataAccessorStub(false));
+  result->itsTime = acc.time();
+  result->itsVisibility.assign(acc.visibility());
+  if (fields & IDataSelector::FLAG) {
+      result->itsFlag.assign(acc.flag());
+  }
+  if (fields & IDataSelector::NOISE) {
+      result->itsNoise.assign(acc.noise());
+  }
+  if (fields & IDataSelector::UVW) {
+      result->itsUVW.assign(acc.uvw());
+  }
+  if (fields & IDataSelector::FREQUENCY) {
+      result->itsFrequency.assign(acc.frequency());
+  }
+  if (fields & IDataSelector::ANTENNA) {
+      result->itsAntenna1.assign(acc.antenna1());
+      result->itsAntenna2.assign(acc.antenna2());
+  }
+  if (fields & IDataSelector::FEED) {
+      result->itsFeed1.assign(acc.feed1());
+      result->itsFeed2.assign(acc.feed2());
+  }
+  if (fields & IDataSelector::FEED_PA) {
+      result->itsFeed1PA.assign(acc.feed1PA());
+      result->itsFeed2PA.assign(acc.feed2PA());
+  }
+  if (fields & IDataSelector::POINTING) {
+      result->itsPointingDir1.assign(acc.pointingDir1());
+      result->itsPointingDir2.assign(acc.pointingDir2());
+  }
+  if (fields & IDataSelector::DISH_POINTING) {
+      result->itsDishPointing1.assign(acc.dishPointing1());
+      result->itsDishPointing2.assign(acc.dishPointing2());
+  }
+  if (fields & IDataSelector::STOKES) {
+      result->itsStokes.assign(acc.stokes());
+  }
+  return result;
+}
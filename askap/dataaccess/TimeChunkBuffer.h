@@ -0,0 +1,212 @@
+/// @file
+///
+/// @brief Bounded buffer of time chunks read in the background
+/// @details TimeChunkIteratorAdapter splits the iteration into chunks of the given
+/// time interval. Solvers working with solution intervals often need the neighbouring
+/// chunks as well (e.g. for smoothing), which means iterating over the data again.
+/// This class runs the adapter in a producer thread and keeps up to the given number
+/// of chunks in memory, so the consumer can look ahead without re-reading the data.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_TIME_CHUNK_BUFFER_H
+#define ASKAP_ACCESSORS_TIME_CHUNK_BUFFER_H
+
+// own includes
+#include <askap/dataaccess/TimeChunkIteratorAdapter.h>
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/IConstDataIterator.h>
+#include <askap/dataaccess/IDataSelector.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <deque>
+#include <vector>
+#include <exception>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Bounded buffer of time chunks read in the background
+/// @details The producer thread reads the wrapped iterator chunk by chunk (see
+/// TimeChunkIteratorAdapter) and copies the accessors into memory. At most maxChunks
+/// chunks are held at any time. The producer waits when the buffer is full, and
+/// the consumer waits when the chunk it asks for has not been read yet. The number
+/// of such waits and the time spent waiting are counted, so one can tell which side
+/// is the bottleneck.
+///
+/// Only the fields given at construction are copied, all other fields of the buffered
+/// accessors are empty. The visibility cube is always copied as it defines the shape
+/// of the chunk. rotatedUVW of the buffered accessors returns the original uvw.
+///
+/// The wrapped iterator is used by the producer thread only and shouldn't be accessed
+/// elsewhere while this object is alive. Errors encountered by the producer are rethrown
+/// to the consumer when it asks for a chunk which couldn't be read.
+/// @ingroup dataaccess_hlp
+class TimeChunkBuffer : public boost::noncopyable {
+public:
+  /// @brief a single time chunk
+  struct Chunk {
+     /// @brief time of the first accessor in the chunk (in the units of the iterator's converter)
+     double itsTime;
+     /// @brief copies of all accessors in the chunk, in order
+     std::vector<boost::shared_ptr<IConstDataAccessor const> > itsAccessors;
+  };
+
+  /// @brief set up the buffer and start reading
+  /// @param[in] iter iterator to read, it is wrapped into TimeChunkIteratorAdapter
+  /// @param[in] interval maximum time span of a single chunk (in seconds), negative
+  ///            value means the whole dataset is a single chunk
+  /// @param[in] maxChunks maximum number of chunks held in memory
+  /// @param[in] fields accessor fields to copy (bitwise combination of
+  ///            IDataSelector::AccessorFields values)
+  TimeChunkBuffer(const boost::shared_ptr<IConstDataIterator> &iter, double interval,
+                  size_t maxChunks = 3, casacore::uInt fields = defaultFields());
+
+  /// @brief destructor, stops the producer thread
+  ~TimeChunkBuffer();
+
+  /// @brief check whether the given chunk is available
+  /// @details The method waits until the chunk has been read or the end of the data
+  /// is reached.
+  /// @param[in] offset position of the chunk with respect to the current one,
+  ///            has to be less than maxChunks
+  /// @return true, if the chunk exists
+  bool hasChunk(size_t offset = 0) const;
+
+  /// @brief obtain the given chunk
+  /// @details The method waits until the chunk has been read, an exception is
+  /// thrown if there is no such chunk.
+  /// @param[in] offset position of the chunk with respect to the current one,
+  ///            has to be less than maxChunks
+  /// @return shared pointer to the chunk
+  boost::shared_ptr<Chunk const> chunk(size_t offset = 0) const;
+
+  /// @brief release the current chunk and proceed to the next one
+  /// @details The producer is allowed to read one more chunk in the freed slot.
+  void next();
+
+  /// @return maximum number of chunks held in memory
+  inline size_t maxChunks() const { return itsMaxChunks; }
+
+  /// @return number of chunks read so far
+  size_t chunksRead() const;
+
+  /// @return maximum number of chunks held at the same time
+  size_t peakChunksHeld() const;
+
+  /// @return number of times the producer had to wait because the buffer was full
+  size_t producerWaits() const;
+
+  /// @return total time in seconds the producer spent waiting for a free slot
+  double producerWaitTime() const;
+
+  /// @return number of times the consumer had to wait for a chunk to be read
+  size_t consumerWaits() const;
+
+  /// @return total time in seconds the consumer spent waiting for data
+  double consumerWaitTime() const;
+
+  /// @return fields copied by default (all except pointing directions and position angles)
+  static casacore::uInt defaultFields();
+
+  /// @brief make a copy of the given accessor
+  /// @details Only the given fields are copied, the visibility cube is always copied.
+  /// @param[in] acc accessor to copy
+  /// @param[in] fields accessor fields to copy (bitwise combination of
+  ///            IDataSelector::AccessorFields values)
+  /// @return shared pointer to the copy
+  static boost::shared_ptr<IConstDataAccessor const> copyAccessor(const IConstDataAccessor &acc,
+                                                                  casacore::uInt fields);
+
+private:
+  /// @brief body of the producer thread
+  void produce();
+
+  /// @brief iterator read by the producer
+  boost::shared_ptr<TimeChunkIteratorAdapter> itsIterator;
+
+  /// @brief maximum number of chunks held in memory
+  size_t itsMaxChunks;
+
+  /// @brief fields to copy
+  casacore::uInt itsFields;
+
+  /// @brief chunks read, but not released by the consumer
+  std::deque<boost::shared_ptr<Chunk const> > itsChunks;
+
+  /// @brief true, if the producer has finished (end of data, error or stop request)
+  bool itsFinished;
+
+  /// @brief true, if the producer is asked to stop
+  bool itsStopRequested;
+
+  /// @brief error encountered by the producer, if any
+  std::exception_ptr itsError;
+
+  /// @brief number of chunks read so far
+  size_t itsChunksRead;
+
+  /// @brief maximum number of chunks held at the same time
+  size_t itsPeakChunksHeld;
+
+  /// @brief number of producer waits
+  size_t itsProducerWaits;
+
+  /// @brief time spent by the producer waiting (in seconds)
+  double itsProducerWaitTime;
+
+  /// @brief number of consumer waits
+  mutable size_t itsConsumerWaits;
+
+  /// @brief time spent by the consumer waiting (in seconds)
+  mutable double itsConsumerWaitTime;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+
+  /// @brief signalled when a chunk is added or the producer finishes
+  mutable boost::condition_variable itsChunkAdded;
+
+  /// @brief signalled when a chunk is released or the producer is asked to stop
+  boost::condition_variable itsChunkReleased;
+
+  /// @brief producer thread
+  boost::shared_ptr<boost::thread> itsProducerThread;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_TIME_CHUNK_BUFFER_H
@@ -0,0 +1,89 @@
+/// @file
+///
+/// @brief Bounding box of uvw coordinates
+/// @details This class accumulates the ranges of u, v and w as well as the largest
+/// uv-distance of the rows added to it.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/UVWBounds.h>
+
+// std includes
+#include <limits>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty object
+UVWBounds::UVWBounds()
+{
+  reset();
+}
+
+/// @brief construct the bounds of the given uvw coordinates
+/// @param[in] uvw vector with uvw coordinates
+UVWBounds::UVWBounds(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw)
+{
+  reset();
+  add(uvw);
+}
+
+/// @brief reset to the empty state
+void UVWBounds::reset()
+{
+  itsMinU = itsMinV = itsMinW = std::numeric_limits<double>::max();
+  itsMaxU = itsMaxV = itsMaxW = -std::numeric_limits<double>::max();
+  itsMaxUVDistanceSquared = 0.;
+  itsNRow = 0;
+}
+
+/// @brief add all rows of the given vector
+/// @param[in] uvw vector with uvw coordinates
+void UVWBounds::add(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw)
+{
+  for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+       const casacore::RigidVector<casacore::Double, 3> &current = uvw[row];
+       add(current(0), current(1), current(2));
+  }
+}
+
+/// @brief add rows accumulated by another object
+/// @param[in] other bounds to merge with this one
+void UVWBounds::add(const UVWBounds &other)
+{
+  if (other.empty()) {
+      return;
+  }
+  itsMinU = std::min(itsMinU, other.itsMinU);
+  itsMaxU = std::max(itsMaxU, other.itsMaxU);
+  itsMinV = std::min(itsMinV, other.itsMinV);
+  itsMaxV = std::max(itsMaxV, other.itsMaxV);
+  itsMinW = std::min(itsMinW, other.itsMinW);
+  itsMaxW = std::max(itsMaxW, other.itsMaxW);
+  itsMaxUVDistanceSquared = std::max(itsMaxUVDistanceSquared, other.itsMaxUVDistanceSquared);
+  itsNRow += other.itsNRow;
+}
@@ -0,0 +1,156 @@
+/// @file
+///
+/// @brief Bounding box of uvw coordinates
+/// @details Gridders need the extent of the uvw coordinates of a chunk to choose grid
+/// tiles, w-kernel supports or snapshot planes. This class accumulates the ranges of u, v
+/// and w as well as the largest uv-distance, so they can be computed in the same pass
+/// which fills the uvw buffer instead of scanning it again.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_UVW_BOUNDS_H
+#define ASKAP_ACCESSORS_UVW_BOUNDS_H
+
+// casa includes
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/scimath/Mathematics/RigidVector.h>
+
+// std includes
+#include <cmath>
+#include <algorithm>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Bounding box of uvw coordinates
+/// @details The object accumulates the minimum and maximum of each coordinate and the
+/// largest uv-distance over all rows added to it. The units are those of the uvw
+/// coordinates added (metres for the accessors). All ranges are undefined (and the
+/// corresponding methods return zero) if no rows have been added.
+/// @ingroup dataaccess
+class UVWBounds {
+public:
+  /// @brief construct an empty object
+  UVWBounds();
+
+  /// @brief construct the bounds of the given uvw coordinates
+  /// @param[in] uvw vector with uvw coordinates
+  explicit UVWBounds(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw);
+
+  /// @brief reset to the empty state
+  void reset();
+
+  /// @brief add a single row
+  /// @param[in] u u-coordinate
+  /// @param[in] v v-coordinate
+  /// @param[in] w w-coordinate
+  inline void add(double u, double v, double w) {
+     itsMinU = std::min(itsMinU, u);
+     itsMaxU = std::max(itsMaxU, u);
+     itsMinV = std::min(itsMinV, v);
+     itsMaxV = std::max(itsMaxV, v);
+     itsMinW = std::min(itsMinW, w);
+     itsMaxW = std::max(itsMaxW, w);
+     itsMaxUVDistanceSquared = std::max(itsMaxUVDistanceSquared, u * u + v * v);
+     ++itsNRow;
+  }
+
+  /// @brief add all rows of the given vector
+  /// @param[in] uvw vector with uvw coordinates
+  void add(const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw);
+
+  /// @brief add rows accumulated by another object
+  /// @param[in] other bounds to merge with this one
+  void add(const UVWBounds &other);
+
+  /// @return number of rows added
+  inline casacore::uInt nRow() const { return itsNRow; }
+
+  /// @return true if no rows have been added
+  inline bool empty() const { return itsNRow == 0; }
+
+  /// @return minimum u
+  inline double minU() const { return empty() ? 0. : itsMinU; }
+
+  /// @return maximum u
+  inline double maxU() const { return empty() ? 0. : itsMaxU; }
+
+  /// @return minimum v
+  inline double minV() const { return empty() ? 0. : itsMinV; }
+
+  /// @return maximum v
+  inline double maxV() const { return empty() ? 0. : itsMaxV; }
+
+  /// @return minimum w
+  inline double minW() const { return empty() ? 0. : itsMinW; }
+
+  /// @return maximum w
+  inline double maxW() const { return empty() ? 0. : itsMaxW; }
+
+  /// @return largest absolute value of u
+  inline double maxAbsU() const { return std::max(std::abs(minU()), std::abs(maxU())); }
+
+  /// @return largest absolute value of v
+  inline double maxAbsV() const { return std::max(std::abs(minV()), std::abs(maxV())); }
+
+  /// @return largest absolute value of w
+  inline double maxAbsW() const { return std::max(std::abs(minW()), std::abs(maxW())); }
+
+  /// @return largest uv-distance
+  inline double maxUVDistance() const { return std::sqrt(itsMaxUVDistanceSquared); }
+
+private:
+  /// @brief minimum u
+  double itsMinU;
+
+  /// @brief maximum u
+  double itsMaxU;
+
+  /// @brief minimum v
+  double itsMinV;
+
+  /// @brief maximum v
+  double itsMaxV;
+
+  /// @brief minimum w
+  double itsMinW;
+
+  /// @brief maximum w
+  double itsMaxW;
+
+  /// @brief square of the largest uv-distance
+  double itsMaxUVDistanceSquared;
+
+  /// @brief number of rows added
+  casacore::uInt itsNRow;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_UVW_BOUNDS_H
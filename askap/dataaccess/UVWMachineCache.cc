@@ -30,8 +30,12 @@
 ///
 
 #include <askap/dataaccess/UVWMachineCache.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
 #include <askap/askap/AskapError.h>
 
+// std includes
+#include <cmath>
+
 // for logging
 #include <askap_accessors.h>
 #include <askap/askap/AskapLogging.h>
@@ -47,13 +51,17 @@ using namespace askap::accessors;
 /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads 
 /// to initialisation of a new UVW Machine
 UVWMachineCache::UVWMachineCache(size_t cacheSize, double tolerance) : itsCache(cacheSize),
-      itsTangentPoints(cacheSize), itsPhaseCentres(cacheSize), 
-      itsOldestElement(0), itsTolerance(tolerance)
+      itsCompiled(cacheSize,false), itsTangentPoints(cacheSize), itsPhaseCentres(cacheSize),
+      itsLRUPositions(cacheSize), itsKeys(cacheSize,0), itsUsed(cacheSize,false),
+      itsHits(0), itsMisses(0), itsEvictions(0), itsTolerance(tolerance)
 {
   ASKAPASSERT(cacheSize>=1);
   ASKAPDEBUGASSERT(tolerance>0);
   ASKAPDEBUGASSERT(itsCache.size() == itsTangentPoints.size());
   ASKAPDEBUGASSERT(itsCache.size() == itsPhaseCentres.size());
+  for (size_t index = 0; index < cacheSize; ++index) {
+       itsLRUPositions[index] = itsLRUList.insert(itsLRUList.end(), index);
+  }
 }
 
 /// @brief destructor to print some stats
@@ -67,11 +75,12 @@ UVWMachineCache::~UVWMachineCache()
    if (itsCache.size()) {
        size_t cntUsed = 0;
        for (size_t elem=0; elem < itsCache.size(); ++elem) {
-            if (itsCache[elem]) {
+            if (itsCompiled[elem]) {
                 ++cntUsed;
             }
        }
-       ASKAPLOG_DEBUG_STR(logger, "UVW-Machine cache utilisation: used "<<cntUsed<<" cache(s) out of "<<itsCache.size()<<" available");
+       ASKAPLOG_DEBUG_STR(logger, "UVW-Machine cache utilisation: used "<<cntUsed<<" cache(s) out of "<<itsCache.size()<<" available; "<<
+                          itsHits<<" hit(s), "<<itsMisses<<" miss(es), "<<itsEvictions<<" eviction(s)");
    }
 }
 
@@ -80,29 +89,34 @@ UVWMachineCache::~UVWMachineCache()
 /// @details This is the main method of the class.
 /// @param[in] phaseCentre direction to the input phase centre
 /// @param[in] tangent direction to tangent point
-/// @return a const reference to uvw machine 
-const UVWMachineCache::machineType& UVWMachineCache::machine(const casacore::MDirection &phaseCentre,
+/// @return a const reference to the compiled uvw machine
+const CompiledUVWMachine& UVWMachineCache::machine(const casacore::MDirection &phaseCentre,
                                                  const casacore::MDirection &tangent) const
 {  
+   DataAccessStatistics::ScopedTimer timer("UVWMachineCache::machine");
 #ifdef _OPENMP
    boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
 #endif
     
    const size_t index = getIndex(phaseCentre,tangent);
-   boost::shared_ptr<machineType> &machinePtr = itsCache[index];
-   if (!machinePtr) {
+   if (!itsCompiled[index]) {
 #ifdef _OPENMP
        boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
-       ASKAPDEBUGASSERT(!machinePtr);
+       ASKAPDEBUGASSERT(!itsCompiled[index]);
 #endif
-       // need to set up a new machine here
-       machinePtr.reset(new machineType(tangent, phaseCentre, false, false));
+       timer.miss();
+       // need to set up a new machine here, only its compiled form is kept
        // swap the arguments in the uvw machine call. It gives the correct result on real data
        // although the casacore manual clearly says that the first argument is "out" and the second is "in".
        // also set the fourth parameter, project, to false, as we do not want to reproject to the input frame.
-       // machinePtr.reset(new machineType(phaseCentre, tangent, false, true));
+       // const machineType uvwm(phaseCentre, tangent, false, true);
+       const machineType uvwm(tangent, phaseCentre, false, false);
+       itsCache[index] = CompiledUVWMachine::compile(uvwm);
+       itsCompiled[index] = true;
+   } else {
+       timer.hit();
    }
-   return *machinePtr;
+   return itsCache[index];
 }
 
 /// @brief a helper method to check whether two directions are matching
@@ -139,6 +153,63 @@ bool UVWMachineCache::compare(const casacore::MDirection &dir1, const casacore::
 }
 
 
+/// @brief number of cache hits
+/// @return number of calls to machine which found a cached machine
+size_t UVWMachineCache::hits() const
+{
+#ifdef _OPENMP
+   boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+   return itsHits;
+}
+
+/// @brief number of cache misses
+/// @return number of calls to machine which required a new machine
+size_t UVWMachineCache::misses() const
+{
+#ifdef _OPENMP
+   boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+   return itsMisses;
+}
+
+/// @brief number of evictions
+/// @return number of times a cached machine has been replaced by a new one
+size_t UVWMachineCache::evictions() const
+{
+#ifdef _OPENMP
+   boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+   return itsEvictions;
+}
+
+/// @brief compute hash key for a pair of directions
+/// @details Directions are quantised with the cell size equal to the tolerance.
+/// @param[in] phaseCentre direction to the input phase centre
+/// @param[in] tangent direction to tangent point
+/// @return hash key
+size_t UVWMachineCache::hashKey(const casacore::MDirection &phaseCentre,
+                                const casacore::MDirection &tangent) const
+{
+   const double values[4] = {phaseCentre.getValue().getLong(), phaseCentre.getValue().getLat(),
+                             tangent.getValue().getLong(), tangent.getValue().getLat()};
+   size_t key = size_t(phaseCentre.getRef().getType()) * 31u + size_t(tangent.getRef().getType());
+   for (int i = 0; i < 4; ++i) {
+        const long long cell = static_cast<long long>(std::floor(values[i] / itsTolerance));
+        // boost::hash_combine-like mixing
+        key ^= std::hash<long long>()(cell) + 0x9e3779b9 + (key << 6) + (key >> 2);
+   }
+   return key;
+}
+
+/// @brief mark the given cache element as the most recently used
+/// @param[in] index cache index
+void UVWMachineCache::touch(size_t index) const
+{
+   ASKAPDEBUGASSERT(index < itsLRUPositions.size());
+   itsLRUList.splice(itsLRUList.begin(), itsLRUList, itsLRUPositions[index]);
+}
+
 /// @brief obtain the index corresponding to a particular tangent point
 /// @details If the cache entry needs updating, the appropriate shared pointer will
 /// be reset. This method updates itsTangentPoints, if necessary.
@@ -151,30 +222,52 @@ size_t UVWMachineCache::getIndex(const casacore::MDirection &phaseCentre,
    // this method is protected and is only called after the upgrade_lock has been acquired.
    // Therefore, we don't need any more locks here.
    
-   // search from the newest element backwards (i.e. most likely the match is the most
-   // recently used tangent point)
-   for (int pos=0; pos<int(itsTangentPoints.size()); ++pos) {
-        int index = int(itsOldestElement)-pos-1;
-        if (index<0) {
-            // wrap around the end of the vector
-            index += int(itsCache.size());
+   // look up the hash first, this is the most likely match
+   const size_t key = hashKey(phaseCentre, tangent);
+   typedef std::unordered_multimap<size_t, size_t>::const_iterator MapIt;
+   const std::pair<MapIt, MapIt> range = itsKeyMap.equal_range(key);
+   for (MapIt ci = range.first; ci != range.second; ++ci) {
+        const size_t index = ci->second;
+        ASKAPDEBUGASSERT(index < itsCache.size() && itsUsed[index]);
+        if (compare(tangent, itsTangentPoints[index]) && compare(phaseCentre, itsPhaseCentres[index])) {
+            ++itsHits;
+            touch(index);
+            return index;
         }
-        ASKAPDEBUGASSERT((index>=0) && (index<int(itsTangentPoints.size())));
+   }
+   // directions matching within the tolerance may be in the adjacent quantisation cells,
+   // search all used elements starting from the most recently used one
+   for (LRUList::const_iterator ci = itsLRUList.begin(); ci != itsLRUList.end() && itsUsed[*ci]; ++ci) {
+        const size_t index = *ci;
         if (compare(tangent, itsTangentPoints[index]) && compare(phaseCentre, itsPhaseCentres[index])) {
-            return size_t(index);
+            ++itsHits;
+            touch(index);
+            return index;
         }
    }
-   // there has been no match, need to replace itsOldestElement   
-   ASKAPDEBUGASSERT(itsOldestElement<itsCache.size());
-   const size_t result = itsOldestElement++;
-   // machine needs updating
-   itsCache[result].reset(); 
-   if (itsOldestElement >= itsCache.size()) {
-       // wrap around the end of the vector
-       itsOldestElement = 0;
+   // there has been no match, need to replace the least recently used element
+   ++itsMisses;
+   ASKAPDEBUGASSERT(itsLRUList.size() == itsCache.size());
+   const size_t result = itsLRUList.back();
+   ASKAPDEBUGASSERT(result < itsCache.size());
+   if (itsUsed[result]) {
+       ++itsEvictions;
+       const std::pair<MapIt, MapIt> oldRange = itsKeyMap.equal_range(itsKeys[result]);
+       for (MapIt ci = oldRange.first; ci != oldRange.second; ++ci) {
+            if (ci->second == result) {
+                itsKeyMap.erase(ci);
+                break;
+            }
+       }
    }
+   // machine needs updating
+   itsCompiled[result] = false;
    itsTangentPoints[result] = tangent;
    itsPhaseCentres[result] = phaseCentre;
+   itsKeys[result] = key;
+   itsUsed[result] = true;
+   itsKeyMap.insert(std::pair<size_t, size_t>(key, result));
+   touch(result);
    return result;
 }
 
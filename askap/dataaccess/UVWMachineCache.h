@@ -34,6 +34,9 @@
 
 // std includes
 #include <vector>
+#include <list>
+#include <unordered_map>
+#include <functional>
 
 // boost includes
 #include <boost/shared_ptr.hpp>
@@ -48,6 +51,7 @@
 #include <casacore/measures/Measures/UVWMachine.h>
 
 #include <askap/dataaccess/TempUVWMachine.h>
+#include <askap/dataaccess/CompiledUVWMachine.h>
 
 namespace askap {
 
@@ -57,13 +61,18 @@ namespace accessors {
 /// @details
 /// This class maintains the cache of UVW Machines (a pair of tangent point and phase centre directions 
 /// is  the key). The number of machines cached and the direction tolerance are specified as parameters.
+/// Cached entries are found via a hash of the directions quantised to the tolerance, the least
+/// recently used entry is replaced if there is no match. Hit, miss and eviction counts are kept to
+/// help with choosing the cache size. Each machine is compiled into its linear form (see
+/// CompiledUVWMachine) right after construction, only the compact form is cached.
 /// @ingroup dataaccess
 struct UVWMachineCache : public boost::noncopyable {
    
    /// @brief UVWMachine class type
    /// @details For debugging, it is handy to substitute UVWMachine class by another type
    /// (to be able to implement only methods we need and to reduce our dependence on 
-   /// the fix to casacore). This typedef defines what class is cached.
+   /// the fix to casacore). This typedef defines what class is used to set up the
+   /// cached compiled machines.
    typedef casacore::UVWMachine  machineType;
    //typedef TempUVWMachine  machineType;
 
@@ -82,8 +91,8 @@ struct UVWMachineCache : public boost::noncopyable {
    /// @details This is the main method of the class.
    /// @param[in] phaseCentre direction to the input phase centre
    /// @param[in] tangent direction to tangent point
-   /// @return a const reference to uvw machine 
-   const machineType& machine(const casacore::MDirection &phaseCentre, 
+   /// @return a const reference to the compiled uvw machine
+   const CompiledUVWMachine& machine(const casacore::MDirection &phaseCentre, 
                                    const casacore::MDirection &tangent) const;
    
    /// @brief a helper method to check whether two directions are matching
@@ -110,22 +119,52 @@ struct UVWMachineCache : public boost::noncopyable {
    /// @return true, if they are matching
    static bool compare(const casacore::MDirection &dir1, const casacore::MDirection &dir2, const double tolerance);
 
+   /// @brief number of cache hits
+   /// @return number of calls to machine which found a cached machine
+   size_t hits() const;
+
+   /// @brief number of cache misses
+   /// @return number of calls to machine which required a new machine
+   size_t misses() const;
+
+   /// @brief number of evictions
+   /// @return number of times a cached machine has been replaced by a new one
+   size_t evictions() const;
+
 protected:
    /// @brief obtain the index corresponding to a particular tangent point
-   /// @details If the cache entry needs updating, the appropriate shared pointer will
-   /// be reset. This method updates itsTangentPoints, if necessary.
+   /// @details If the cache entry needs updating, it is marked as not compiled. This method updates itsTangentPoints, if necessary.
    /// @param[in] phaseCentre direction to the input phase centre
    /// @param[in] tangent direction to tangent point
    /// @return cache index
    size_t getIndex(const casacore::MDirection &phaseCentre, const casacore::MDirection &tangent) const;
    
 private:
+   /// @brief compute hash key for a pair of directions
+   /// @details Directions are quantised with the cell size equal to the tolerance. Directions
+   /// matching within the tolerance usually have the same key, but it is not guaranteed
+   /// (e.g. if they are on the opposite sides of the cell boundary). Therefore, a linear search
+   /// is done if there is no match for the key.
+   /// @param[in] phaseCentre direction to the input phase centre
+   /// @param[in] tangent direction to tangent point
+   /// @return hash key
+   size_t hashKey(const casacore::MDirection &phaseCentre, const casacore::MDirection &tangent) const;
+
+   /// @brief mark the given cache element as the most recently used
+   /// @param[in] index cache index
+   void touch(size_t index) const;
+
+   /// @brief type of the list of cache indices in the order of use
+   typedef std::list<size_t> LRUList;
 
    /// @brief the actual cache of uvw machines
    /// @note We're using a plain vector-based cache here instead of the std queue because we
    /// need a flexible iteration over all elements to determine whether the requested tangent
    /// point is already in the cache.
-   mutable std::vector<boost::shared_ptr<machineType> > itsCache;
+   mutable std::vector<CompiledUVWMachine> itsCache;
+
+   /// @brief true for cache elements holding the machine for their directions
+   mutable std::vector<bool> itsCompiled;
 
    /// @brief cached tangent directions
    mutable std::vector<casacore::MDirection> itsTangentPoints;
@@ -133,8 +172,30 @@ private:
    /// @brief cached phase centre directions
    mutable std::vector<casacore::MDirection> itsPhaseCentres;
    
-   /// @brief index of the oldest element in the cache
-   mutable size_t itsOldestElement;
+   /// @brief cache indices, the most recently used first
+   /// @details Unused elements are at the end of the list
+   mutable LRUList itsLRUList;
+
+   /// @brief position of each cache element in itsLRUList
+   mutable std::vector<LRUList::iterator> itsLRUPositions;
+
+   /// @brief hash key of each used cache element
+   mutable std::vector<size_t> itsKeys;
+
+   /// @brief true for cache elements which have been assigned directions
+   mutable std::vector<bool> itsUsed;
+
+   /// @brief map of hash keys to cache indices
+   mutable std::unordered_multimap<size_t, size_t> itsKeyMap;
+
+   /// @brief number of cache hits
+   mutable size_t itsHits;
+
+   /// @brief number of cache misses
+   mutable size_t itsMisses;
+
+   /// @brief number of evictions
+   mutable size_t itsEvictions;
       
    /// @brief direction tolerance
    /// @details It determines whether we a new machine has to be created
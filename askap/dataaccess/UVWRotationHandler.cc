@@ -32,12 +32,16 @@
 ///
 
 #include <askap/dataaccess/UVWRotationHandler.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
 #include <askap/askap/AskapError.h>
 
 #include <casacore/measures/Measures/MeasFrame.h>
 #include <casacore/measures/Measures/MEpoch.h>
 #include <askap/askap/AskapUtil.h>
 
+#include <sstream>
+#include <iomanip>
+
 
 using namespace askap;
 using namespace askap::accessors;
@@ -48,7 +52,7 @@ using namespace askap::accessors;
 /// @param[in] tolerance pointing direction tolerance in radians, exceeding which leads
 /// to initialisation of a new UVW Machine and recompute of the rotated uvws/delays
 UVWRotationHandler::UVWRotationHandler(size_t cacheSize, double tolerance) :
-         UVWMachineCache(cacheSize, tolerance), itsValid(false) {}
+         UVWMachineCache(cacheSize, tolerance), itsValid(false), itsBoundsValid(false) {}
 
 
 /// @brief invalidate the cache
@@ -61,19 +65,57 @@ void UVWRotationHandler::invalidate() const
 #endif
 
    itsValid = false;
+   itsBoundsValid = false;
+}
+
+
+/// @brief set up the cache of results shared between iterations
+/// @details If set, rotated uvws and delays are looked up in this cache before they are
+/// computed, provided the caller passes a key identifying the chunk.
+/// @param[in] cache shared pointer to the cache
+void UVWRotationHandler::setResultCache(const boost::shared_ptr<RotatedUVWCache> &cache)
+{
+#ifdef _OPENMP
+   boost::unique_lock<boost::shared_mutex> lock(itsMutex);
+#endif
+   itsResultCache = cache;
 }
 
+/// @brief build the key for the result cache
+/// @details The key combines the chunk identification with the phase centres of the
+/// first and the last row and the tangent point.
+/// @param[in] acc const reference to the input accessor
+/// @param[in] tangent direction to the tangent point
+/// @param[in] chunkKey identification of the rows of the accessor
+/// @return key for the result cache
+std::string UVWRotationHandler::resultKey(const IConstDataAccessor &acc, const casacore::MDirection &tangent,
+                                          const std::string &chunkKey)
+{
+  std::ostringstream os;
+  os<<std::setprecision(15)<<chunkKey;
+  const casacore::MVDirection tangentDir(tangent.getValue());
+  os<<":"<<tangentDir.getLong()<<","<<tangentDir.getLat();
+  if (acc.nRow() > 0) {
+      const casacore::Vector<casacore::MVDirection>& pointingDir1Vector = acc.pointingDir1();
+      const casacore::MVDirection &first = pointingDir1Vector[0];
+      const casacore::MVDirection &last = pointingDir1Vector[acc.nRow() - 1];
+      os<<":"<<first.getLong()<<","<<first.getLat()<<":"<<last.getLong()<<","<<last.getLat();
+  }
+  return os.str();
+}
 
 /// @brief obtain rotated uvws
 /// @details
 /// Use parameters in the given accessor to compute rotated uvws
 /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
 /// @param[in] tangent direction to the tangent point
+/// @param[in] chunkKey identification of the rows of the accessor for the result cache, the
+/// cache is not used if the key is empty
 /// @return const reference to rotated uvws
 /// @note the method doesn't monitor a change to the accessor. It expects that invalidate
 /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
 const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotationHandler::uvw(const IConstDataAccessor &acc,
-               const casacore::MDirection &tangent) const
+               const casacore::MDirection &tangent, const std::string &chunkKey) const
 {
   ASKAPCHECK(tangent.getRef().getType() == casacore::MDirection::J2000,
       "This is a cautionary assertion because a number of places in the code implicitly assume J2000 for "
@@ -81,6 +123,7 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotation
       "frame information to UVWMachines as well as to invalidate cache when say the time changes if it is required for conversion. "
       "This work has not been done and is beyond the scope for ASKAP.");
 
+  DataAccessStatistics::ScopedTimer timer("UVWRotationHandler::uvw");
 #ifdef _OPENMP
   boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
 #endif
@@ -89,13 +132,27 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotation
 #ifdef _OPENMP
      boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
 #endif
+     itsTangentPoint = tangent;
+     itsImageCentre = tangent;
+     // results of the previous iterations over the same data, if available
+     const std::string key = itsResultCache && chunkKey.size() ? resultKey(acc, tangent, chunkKey) : std::string();
+     if (key.size() && itsResultCache->find(key, itsRotatedUVWs, itsDelays)) {
+         ASKAPDEBUGASSERT(itsRotatedUVWs.nelements() == acc.nRow());
+         itsValid = true;
+         // bounds are only computed on demand for the cached results
+         itsBoundsValid = false;
+         timer.hit();
+         return itsRotatedUVWs;
+     }
+     timer.miss();
      // have to fill itsRotatedUVW
      const casacore::uInt nSamples = acc.nRow();
+     timer.addBytes(nSamples * (sizeof(casacore::RigidVector<casacore::Double, 3>) + sizeof(casacore::Double)));
      itsRotatedUVWs.resize(nSamples);
      itsDelays.resize(nSamples);
-     itsTangentPoint = tangent;
-     itsImageCentre = tangent;
      itsValid = true;
+     itsRotatedBounds.reset();
+     itsBoundsValid = true;
      // just copy rotation code from TableVisGridder for a moment
      const casacore::Vector<casacore::RigidVector<double, 3> >& uvwVector = acc.uvw();
      //casacore::Vector<casacore::MVDirection> pointingDir1Vector =
@@ -118,37 +175,71 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotation
      pointingDir1Vector.set(casacore::MVDirection(tmpra,tmpdec));
      */
      //
-     casacore::Vector<double> uvwBuffer(3);
-     const UVWMachineCache::machineType * uvwm;
-     for (casacore::uInt row=0; row<nSamples; ++row) {
-          const casacore::RigidVector<double, 3> &uvwRow = uvwVector(row);
-          /// @todo Decide what to do about pointingDir1!=pointingDir2
-          for (int i=0; i<3; ++i) {
-               uvwBuffer(i) = (i<2 ? -1. : 1.) * uvwRow(i);
+     if (nSamples == 0) {
+         return itsRotatedUVWs;
+     }
+     ASKAPDEBUGASSERT(uvwVector.nelements() == nSamples);
+     ASKAPDEBUGASSERT(pointingDir1Vector.nelements() == nSamples);
+     bool deleteIt = false;
+     const casacore::RigidVector<double, 3> *uvwIn = uvwVector.getStorage(deleteIt);
+     casacore::RigidVector<double, 3> *uvwOut = itsRotatedUVWs.data();
+     double *delays = itsDelays.data();
+     // rows are processed in runs with the same pointing direction (usually the whole chunk),
+     // each run is a single batch rotation with the coefficients of the appropriate machine
+     for (casacore::uInt row=0; row<nSamples;) {
+          casacore::uInt runEnd = row + 1;
+          while ((runEnd < nSamples) && (pointingDir1Vector(runEnd) == pointingDir1Vector(row))) {
+                 ++runEnd;
           }
+          /// @todo Decide what to do about pointingDir1!=pointingDir2
 
           /// @note we actually pass MVDirection as MDirection. The code had just been
           /// copied, so this bug had been here for a while. It means that J2000 is
           /// hard coded in the next line (quite implicitly).
-          //const UVWMachineCache::machineType& uvwm = machine(pointingDir1Vector(row),itsTangentPoint);
-          // Optimise the common case where all pointingdirs are the same
-          if (row==0 || pointingDir1Vector(row)!=pointingDir1Vector(row-1)) {
-              uvwm = &machine(pointingDir1Vector(row),itsTangentPoint);
-          }
-          uvwm->convertUVW(itsDelays(row), uvwBuffer);
+          // the sign swap of u and v used with uvw machines is folded into the coefficients
+          const CompiledUVWMachine transform = machine(pointingDir1Vector(row),itsTangentPoint).flippedUV();
+          transform.convertUVW(uvwIn + row, uvwOut + row, delays + row, runEnd - row, itsRotatedBounds);
+          row = runEnd;
+     }
+     uvwVector.freeStorage(uvwIn, deleteIt);
+     if (key.size()) {
+         // delays are stored before any shift of the image centre
+         itsResultCache->add(key, itsRotatedUVWs, itsDelays);
+     }
+  } else {
+     timer.hit();
+  }
+  return itsRotatedUVWs;
+}
 
-          // the following line is to be commented out if we swap arguments in the uvw machine call
-          // (swapping the sign of uvw's above is another way to achieve a similar outcome
-          //itsDelays(row) *= -1;
-          //
+/// @brief obtain bounding box of rotated uvws
+/// @details The bounds are computed in the same pass as the rotated uvws. If the uvws
+/// are taken from the result cache, the bounds are computed on the first call to this method.
+/// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
+/// @param[in] tangent direction to the tangent point
+/// @param[in] chunkKey identification of the rows of the accessor for the result cache, the
+/// cache is not used if the key is empty
+/// @return bounding box of the rotated uvws
+UVWBounds UVWRotationHandler::bounds(const IConstDataAccessor &acc, const casacore::MDirection &tangent,
+                                     const std::string &chunkKey) const
+{
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvwBuffer = uvw(acc, tangent, chunkKey);
 
-          for (int i=0; i<3; ++i) {
-               itsRotatedUVWs(row)(i) = (i<2 ? -1. : 1.) * uvwBuffer(i);
-          }
+#ifdef _OPENMP
+  boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
+  ASKAPCHECK(compare(tangent, itsTangentPoint) && itsValid,
+             "This should not happen, suspect race condition with number of threads exceeding number of cache elements");
+#endif
 
-     }
+  if (!itsBoundsValid) {
+#ifdef _OPENMP
+      boost::upgrade_to_unique_lock<boost::shared_mutex> uniqueLock(lock);
+#endif
+      itsRotatedBounds.reset();
+      itsRotatedBounds.add(uvwBuffer);
+      itsBoundsValid = true;
   }
-  return itsRotatedUVWs;
+  return itsRotatedBounds;
 }
 
 /// @brief obtain delays corresponding to rotation
@@ -158,13 +249,16 @@ const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& UVWRotation
 /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
 /// @param[in] tangent direction to the tangent point
 /// @param[in] imageCentre direction to the image centre
+/// @param[in] chunkKey identification of the rows of the accessor for the result cache, the
+/// cache is not used if the key is empty
 /// @return const reference to delay vector
 /// @note the method doesn't monitor a change to the accessor. It expects that invalidate
 /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
 const casacore::Vector<casacore::Double>& UVWRotationHandler::delays(const IConstDataAccessor &acc,
-               const casacore::MDirection &tangent, const casacore::MDirection &imageCentre) const
+               const casacore::MDirection &tangent, const casacore::MDirection &imageCentre,
+               const std::string &chunkKey) const
 {
-  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvwBuffer = uvw(acc, tangent);
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvwBuffer = uvw(acc, tangent, chunkKey);
 
 #ifdef _OPENMP
   boost::upgrade_lock<boost::shared_mutex> lock(itsMutex);
@@ -36,8 +36,16 @@
 
 #include <askap/dataaccess/UVWMachineCache.h>
 #include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/RotatedUVWCache.h>
+#include <askap/dataaccess/UVWBounds.h>
 #include <casacore/measures/Measures/MDirection.h>
 
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+
 #ifdef _OPENMP
 // boost includes
 #include <boost/thread/shared_mutex.hpp>
@@ -68,17 +76,38 @@ struct UVWRotationHandler : protected UVWMachineCache {
    /// uvws and delays. Nothing is done for uvw machines as UVWMachineCache takes care of this.
    /// This method is const as effectively non-const operations are only for caching purposes.
    void invalidate() const;
-   
+
+   /// @brief set up the cache of results shared between iterations
+   /// @details If set, rotated uvws and delays are looked up in this cache before they are
+   /// computed, provided the caller passes a key identifying the chunk (see uvw and delays).
+   /// Computed results are added to the cache. An empty shared pointer disables the cache.
+   /// @param[in] cache shared pointer to the cache
+   void setResultCache(const boost::shared_ptr<RotatedUVWCache> &cache);
+
    /// @brief obtain rotated uvws
    /// @details
    /// Use parameters in the given accessor to compute rotated uvws
    /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
    /// @param[in] tangent direction to the tangent point
+   /// @param[in] chunkKey identification of the rows of the accessor for the result cache, the
+   /// cache is not used if the key is empty (default)
    /// @return const reference to rotated uvws
    /// @note the method doesn't monitor a change to the accessor. It expects that invalidate 
    /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
    const casacore::Vector<casacore::RigidVector<casacore::Double, 3> >& uvw(const IConstDataAccessor &acc, 
-               const casacore::MDirection &tangent) const;
+               const casacore::MDirection &tangent, const std::string &chunkKey = std::string()) const;
+
+   /// @brief obtain bounding box of rotated uvws
+   /// @details The bounds are computed in the same pass as the rotated uvws. If the uvws
+   /// are taken from the result cache, the bounds are computed on the first call to this method.
+   /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
+   /// @param[in] tangent direction to the tangent point
+   /// @param[in] chunkKey identification of the rows of the accessor for the result cache, the
+   /// cache is not used if the key is empty (default)
+   /// @return bounding box of the rotated uvws
+   /// @note the method doesn't monitor a change to the accessor, see uvw
+   UVWBounds bounds(const IConstDataAccessor &acc, const casacore::MDirection &tangent,
+                    const std::string &chunkKey = std::string()) const;
 
    /// @brief obtain delays corresponding to rotation
    /// @details
@@ -87,18 +116,40 @@ struct UVWRotationHandler : protected UVWMachineCache {
    /// @param[in] acc const reference to the input accessor (need phase centre info, uvw, etc)
    /// @param[in] tangent direction to the tangent point
    /// @param[in] imageCentre direction to the image centre
+   /// @param[in] chunkKey identification of the rows of the accessor for the result cache, the
+   /// cache is not used if the key is empty (default)
    /// @return const reference to delay vector
    /// @note the method doesn't monitor a change to the accessor. It expects that invalidate 
    /// is called explicitly when recalculation is needed (i.e. iterator moved to the next iteration, etc)
    const casacore::Vector<casacore::Double>& delays(const IConstDataAccessor &acc, 
-               const casacore::MDirection &tangent, const casacore::MDirection &imageCentre) const;
+               const casacore::MDirection &tangent, const casacore::MDirection &imageCentre,
+               const std::string &chunkKey = std::string()) const;
                   
 private:
+   /// @brief build the key for the result cache
+   /// @details The key combines the chunk identification with the phase centres of the
+   /// first and the last row and the tangent point.
+   /// @param[in] acc const reference to the input accessor
+   /// @param[in] tangent direction to the tangent point
+   /// @param[in] chunkKey identification of the rows of the accessor
+   /// @return key for the result cache
+   static std::string resultKey(const IConstDataAccessor &acc, const casacore::MDirection &tangent,
+                                const std::string &chunkKey);
+
+   /// @brief cache of results shared between iterations, may be empty
+   boost::shared_ptr<RotatedUVWCache> itsResultCache;
+
    /// @brief rotated uvw coordinates
    mutable casacore::Vector<casacore::RigidVector<casacore::Double, 3> > itsRotatedUVWs;
    
    /// @brief internal buffer for delay associated with uvw rotation
    mutable casacore::Vector<casacore::Double> itsDelays;
+
+   /// @brief bounding box of itsRotatedUVWs
+   mutable UVWBounds itsRotatedBounds;
+
+   /// @brief true, if itsRotatedBounds corresponds to itsRotatedUVWs
+   mutable bool itsBoundsValid;
    
    /// @brief flag that rotated uvws and delays are up to date
    /// @details If this field is uptodate itsDelays contain some valid information too.
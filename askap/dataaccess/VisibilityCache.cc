@@ -0,0 +1,375 @@
+/// @file
+///
+/// @brief Cache of quantised visibilities and packed flags
+/// @details This class keeps the visibilities in a compact form in memory or in
+/// a file on the local disk together with bit-packed flags.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/VisibilityCache.h>
+#include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/thread/lock_guard.hpp>
+
+// std includes
+#include <vector>
+#include <limits>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".VisibilityCache");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief create an empty cache
+/// @param[in] precision quantisation mode for visibilities
+/// @param[in] directory directory for the cache file, empty string (default) means
+///            that visibilities are kept in memory
+VisibilityCache::VisibilityCache(CompactVisibility::Precision precision, const std::string &directory) :
+      itsPrecision(precision), itsMemoryUsed(0), itsFileSize(0), itsMSTime(-1.), itsHits(0), itsMisses(0)
+{
+  if (directory.size()) {
+      std::string pattern = directory + "/askap_vis_cache_XXXXXX";
+      std::vector<char> buf(pattern.begin(), pattern.end());
+      buf.push_back(0);
+      const int fd = mkstemp(&buf[0]);
+      if (fd < 0) {
+          ASKAPTHROW(DataAccessError, "Unable to create visibility cache file in "<<directory);
+      }
+      close(fd);
+      itsFileName = &buf[0];
+      itsFile.open(itsFileName.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!itsFile) {
+          std::remove(itsFileName.c_str());
+          ASKAPTHROW(DataAccessError, "Unable to open visibility cache file "<<itsFileName);
+      }
+      ASKAPLOG_DEBUG_STR(logger, "Quantised visibilities will be cached in "<<itsFileName);
+  }
+  MemoryGovernor::instance().add(this);
+}
+
+/// @brief destructor, removes the cache file (if any)
+VisibilityCache::~VisibilityCache()
+{
+  MemoryGovernor::instance().remove(this);
+  if (itsHits + itsMisses > 0) {
+      ASKAPLOG_DEBUG_STR(logger, "Visibility cache: "<<itsHits<<" hit(s), "<<itsMisses<<" miss(es), "<<
+                  memoryUsage()<<" bytes in memory, "<<itsFileSize<<" bytes on disk");
+  }
+  if (onDisk()) {
+      itsFile.close();
+      std::remove(itsFileName.c_str());
+  }
+}
+
+/// @brief discard the content if the measurement set has been modified
+/// @details The modification time of the measurement set is compared to that
+/// at the time of the first validate call after the cache has been emptied.
+/// @param[in] msName name of the measurement set
+/// @return true, if the existing entries are still valid
+bool VisibilityCache::validate(const std::string &msName)
+{
+  const double msTime = modificationTime(msName);
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  if (itsMSTime >= 0. && itsMSTime != msTime) {
+      ASKAPLOG_INFO_STR(logger, msName<<" has been modified, cached visibilities are discarded");
+      clearEntries();
+      itsMSTime = msTime;
+      return false;
+  }
+  itsMSTime = msTime;
+  return true;
+}
+
+/// @brief obtain visibilities from the cache
+/// @param[in] key accessor identification
+/// @param[out] vis nRow x nChannel x nPol cube to fill (untouched if there is no such entry)
+/// @return true, if the entry has been found
+bool VisibilityCache::getVisibility(const std::string &key, casacore::Cube<casacore::Complex> &vis) const
+{
+  boost::shared_ptr<CompactVisibility const> result;
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    if (onDisk()) {
+        const std::map<std::string, std::streamoff>::const_iterator ci = itsFileOffsets.find(key);
+        if (ci != itsFileOffsets.end()) {
+            boost::shared_ptr<CompactVisibility> buf(new CompactVisibility);
+            itsFile.clear();
+            itsFile.seekg(ci->second);
+            buf->read(itsFile);
+            result = buf;
+        }
+    } else {
+        const std::map<std::string, boost::shared_ptr<CompactVisibility const> >::const_iterator ci =
+              itsVisibilities.find(key);
+        if (ci != itsVisibilities.end()) {
+            result = ci->second;
+        }
+    }
+    if (!result) {
+        ++itsMisses;
+        return false;
+    }
+    ++itsHits;
+    touch(key);
+  }
+  result->expand(vis);
+  return true;
+}
+
+/// @brief store visibilities in the cache
+/// @details The cube is replaced by the quantised values, so the data are the same
+/// regardless of whether they've been obtained from the cache or not.
+/// @param[in] key accessor identification
+/// @param[in,out] vis nRow x nChannel x nPol cube of visibilities
+void VisibilityCache::addVisibility(const std::string &key, casacore::Cube<casacore::Complex> &vis)
+{
+  boost::shared_ptr<CompactVisibility> entry(new CompactVisibility);
+  entry->assign(vis, itsPrecision);
+  entry->expand(vis);
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    if (onDisk()) {
+        // replaced entries are not reused, the space is reclaimed by clear
+        itsFile.clear();
+        itsFile.seekp(itsFileSize);
+        entry->write(itsFile);
+        itsFileOffsets[key] = itsFileSize;
+        itsFileSize = itsFile.tellp();
+    } else {
+        boost::shared_ptr<CompactVisibility const> &slot = itsVisibilities[key];
+        if (slot) {
+            itsMemoryUsed -= slot->memoryUsage();
+        }
+        slot = entry;
+        itsMemoryUsed += entry->memoryUsage();
+    }
+    touch(key);
+  }
+  // the governor may call back releaseOldest, so the lock has to be released first
+  MemoryGovernor::instance().enforce();
+}
+
+/// @brief obtain flags from the cache
+/// @param[in] key accessor identification
+/// @param[out] flag nRow x nChannel x nPol cube to fill (untouched if there is no such entry)
+/// @return true, if the entry has been found
+bool VisibilityCache::getFlag(const std::string &key, casacore::Cube<casacore::Bool> &flag) const
+{
+  boost::shared_ptr<PackedFlagCube const> result;
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    const std::map<std::string, boost::shared_ptr<PackedFlagCube const> >::const_iterator ci =
+          itsFlags.find(key);
+    if (ci == itsFlags.end()) {
+        ++itsMisses;
+        return false;
+    }
+    ++itsHits;
+    result = ci->second;
+    touch(key);
+  }
+  ASKAPDEBUGASSERT(result);
+  result->expand(flag);
+  return true;
+}
+
+/// @brief store flags in the cache
+/// @param[in] key accessor identification
+/// @param[in] flag nRow x nChannel x nPol cube of flags
+void VisibilityCache::addFlag(const std::string &key, const casacore::Cube<casacore::Bool> &flag)
+{
+  const boost::shared_ptr<PackedFlagCube const> entry(new PackedFlagCube(flag));
+  {
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    boost::shared_ptr<PackedFlagCube const> &slot = itsFlags[key];
+    if (slot) {
+        itsMemoryUsed -= slot->memoryUsage();
+    }
+    slot = entry;
+    itsMemoryUsed += entry->memoryUsage();
+    touch(key);
+  }
+  MemoryGovernor::instance().enforce();
+}
+
+/// @brief remove all entries
+void VisibilityCache::clear()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  clearEntries();
+  itsMSTime = -1.;
+}
+
+/// @brief remove all entries, the mutex should be locked by the caller
+void VisibilityCache::clearEntries()
+{
+  itsVisibilities.clear();
+  itsFileOffsets.clear();
+  itsFlags.clear();
+  itsLastUse.clear();
+  itsUseOrder.clear();
+  itsMemoryUsed = 0;
+  if (onDisk()) {
+      itsFile.close();
+      itsFile.open(itsFileName.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!itsFile) {
+          ASKAPTHROW(DataAccessError, "Unable to reopen visibility cache file "<<itsFileName);
+      }
+      itsFileSize = 0;
+  }
+}
+
+/// @return number of requests served from the cache
+size_t VisibilityCache::hits() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsHits;
+}
+
+/// @return number of requests not found in the cache
+size_t VisibilityCache::misses() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsMisses;
+}
+
+/// @return memory used by the cached data in bytes
+size_t VisibilityCache::memoryUsage() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsMemoryUsed;
+}
+
+/// @return size of the cache file in bytes (0 if visibilities are kept in memory)
+size_t VisibilityCache::diskUsage() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsFileSize;
+}
+
+/// @return name of the cache used in usage reports and in the parset
+std::string VisibilityCache::consumerName() const
+{
+  return "VisibilityCache";
+}
+
+/// @return memory used by the cached data in bytes
+size_t VisibilityCache::memoryUsed() const
+{
+  return memoryUsage();
+}
+
+/// @brief use stamp of the least recently used entry
+/// @return stamp obtained from MemoryGovernor::stamp or the largest possible value
+/// if the cache is empty
+casacore::uInt64 VisibilityCache::oldestUse() const
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  return itsUseOrder.empty() ? std::numeric_limits<casacore::uInt64>::max() : itsUseOrder.begin()->first;
+}
+
+/// @brief drop the least recently used entry
+/// @details Visibilities and flags with the same key are dropped together. The space
+/// in the cache file is not reclaimed until the cache is cleared.
+/// @return memory released in bytes, 0 if the cache is empty
+size_t VisibilityCache::releaseOldest()
+{
+  boost::lock_guard<boost::mutex> lock(itsMutex);
+  size_t released = 0;
+  // entries kept on disk only don't release any memory, drop them until something is released
+  while (released == 0 && !itsUseOrder.empty()) {
+         const std::string key = itsUseOrder.begin()->second;
+         itsUseOrder.erase(itsUseOrder.begin());
+         itsLastUse.erase(key);
+         const std::map<std::string, boost::shared_ptr<CompactVisibility const> >::iterator visIt =
+               itsVisibilities.find(key);
+         if (visIt != itsVisibilities.end()) {
+             released += visIt->second->memoryUsage();
+             itsVisibilities.erase(visIt);
+         }
+         itsFileOffsets.erase(key);
+         const std::map<std::string, boost::shared_ptr<PackedFlagCube const> >::iterator flagIt =
+               itsFlags.find(key);
+         if (flagIt != itsFlags.end()) {
+             released += flagIt->second->memoryUsage();
+             itsFlags.erase(flagIt);
+         }
+  }
+  ASKAPDEBUGASSERT(released <= itsMemoryUsed);
+  itsMemoryUsed -= released;
+  return released;
+}
+
+/// @brief mark the entry as the most recently used, the mutex should be locked by the caller
+/// @param[in] key accessor identification
+void VisibilityCache::touch(const std::string &key) const
+{
+  const casacore::uInt64 stamp = MemoryGovernor::instance().stamp();
+  const std::map<std::string, casacore::uInt64>::iterator it = itsLastUse.find(key);
+  if (it != itsLastUse.end()) {
+      itsUseOrder.erase(it->second);
+      it->second = stamp;
+  } else {
+      itsLastUse[key] = stamp;
+  }
+  itsUseOrder[stamp] = key;
+}
+
+/// @brief obtain the modification time of the measurement set
+/// @details This is the latest modification time of the files in the table
+/// directory (the main table only, the subtables are not checked).
+/// @param[in] msName name of the measurement set
+/// @return modification time in seconds since the epoch
+double VisibilityCache::modificationTime(const std::string &msName)
+{
+  DIR *dir = opendir(msName.c_str());
+  if (dir == 0) {
+      ASKAPTHROW(DataAccessError, "Unable to read the directory of "<<msName);
+  }
+  double result = 0.;
+  for (struct dirent *entry = readdir(dir); entry != 0; entry = readdir(dir)) {
+       struct stat info;
+       const std::string name = msName + "/" + entry->d_name;
+       if ((stat(name.c_str(), &info) == 0) && S_ISREG(info.st_mode)) {
+           const double mtime = double(info.st_mtim.tv_sec) + 1e-9 * info.st_mtim.tv_nsec;
+           if (mtime > result) {
+               result = mtime;
+           }
+       }
+  }
+  closedir(dir);
+  return result;
+}
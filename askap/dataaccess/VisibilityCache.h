@@ -0,0 +1,221 @@
+/// @file
+///
+/// @brief Cache of quantised visibilities and packed flags
+/// @details Major cycles of imaging read the same visibilities from the measurement
+/// set every time. This class keeps the visibilities read in the first cycle in a
+/// compact form (see CompactVisibility) in memory or in a file on the local disk,
+/// together with bit-packed flags, so the following cycles don't need to read the
+/// measurement set.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_VISIBILITY_CACHE_H
+#define ASKAP_ACCESSORS_VISIBILITY_CACHE_H
+
+// own includes
+#include <askap/dataaccess/CompactVisibility.h>
+#include <askap/dataaccess/PackedFlagCube.h>
+#include <askap/dataaccess/IMemoryConsumer.h>
+
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+#include <casacore/casa/BasicSL/Complex.h>
+
+// boost includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <string>
+#include <map>
+#include <fstream>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Cache of quantised visibilities and packed flags
+/// @details The entries are identified by a string key, which the caller constructs
+/// to describe the accessor uniquely (see CachedTableConstDataIterator). Visibilities
+/// are stored quantised with the precision given at construction, flags are stored
+/// exactly. If a directory is given, quantised visibilities are written into a temporary
+/// file in that directory (e.g. on the node-local SSD) and only their positions are kept
+/// in memory, flags are always kept in memory. The file is removed when the cache is
+/// destroyed.
+///
+/// The cache is tied to one measurement set. The modification time of the measurement
+/// set is checked by validate, which discards all entries if the dataset has changed
+/// since they were stored. The cache is registered with MemoryGovernor, which may drop
+/// the least recently used entries to keep the memory used by all caches within the
+/// process-wide budget. All methods are thread-safe.
+/// @ingroup dataaccess_hlp
+class VisibilityCache : virtual public IMemoryConsumer,
+                        public boost::noncopyable {
+public:
+  /// @brief create an empty cache
+  /// @param[in] precision quantisation mode for visibilities
+  /// @param[in] directory directory for the cache file, empty string (default) means
+  ///            that visibilities are kept in memory
+  explicit VisibilityCache(CompactVisibility::Precision precision = CompactVisibility::INT16,
+                           const std::string &directory = "");
+
+  /// @brief destructor, removes the cache file (if any)
+  virtual ~VisibilityCache();
+
+  /// @brief discard the content if the measurement set has been modified
+  /// @details The modification time of the measurement set is compared to that
+  /// at the time of the first validate call after the cache has been emptied.
+  /// @param[in] msName name of the measurement set
+  /// @return true, if the existing entries are still valid
+  bool validate(const std::string &msName);
+
+  /// @brief obtain visibilities from the cache
+  /// @param[in] key accessor identification
+  /// @param[out] vis nRow x nChannel x nPol cube to fill (untouched if there is no such entry)
+  /// @return true, if the entry has been found
+  bool getVisibility(const std::string &key, casacore::Cube<casacore::Complex> &vis) const;
+
+  /// @brief store visibilities in the cache
+  /// @details The cube is replaced by the quantised values, so the data are the same
+  /// regardless of whether they've been obtained from the cache or not.
+  /// @param[in] key accessor identification
+  /// @param[in,out] vis nRow x nChannel x nPol cube of visibilities
+  void addVisibility(const std::string &key, casacore::Cube<casacore::Complex> &vis);
+
+  /// @brief obtain flags from the cache
+  /// @param[in] key accessor identification
+  /// @param[out] flag nRow x nChannel x nPol cube to fill (untouched if there is no such entry)
+  /// @return true, if the entry has been found
+  bool getFlag(const std::string &key, casacore::Cube<casacore::Bool> &flag) const;
+
+  /// @brief store flags in the cache
+  /// @param[in] key accessor identification
+  /// @param[in] flag nRow x nChannel x nPol cube of flags
+  void addFlag(const std::string &key, const casacore::Cube<casacore::Bool> &flag);
+
+  /// @brief remove all entries
+  void clear();
+
+  /// @return quantisation mode for visibilities
+  inline CompactVisibility::Precision precision() const { return itsPrecision; }
+
+  /// @return true, if visibilities are stored on disk
+  inline bool onDisk() const { return itsFileName.size() > 0; }
+
+  /// @return number of requests served from the cache
+  size_t hits() const;
+
+  /// @return number of requests not found in the cache
+  size_t misses() const;
+
+  /// @return memory used by the cached data in bytes
+  size_t memoryUsage() const;
+
+  /// @return size of the cache file in bytes (0 if visibilities are kept in memory)
+  size_t diskUsage() const;
+
+  /// @return name of the cache used in usage reports and in the parset
+  virtual std::string consumerName() const;
+
+  /// @return memory used by the cached data in bytes
+  virtual size_t memoryUsed() const;
+
+  /// @brief use stamp of the least recently used entry
+  /// @return stamp obtained from MemoryGovernor::stamp or the largest possible value
+  /// if the cache is empty
+  virtual casacore::uInt64 oldestUse() const;
+
+  /// @brief drop the least recently used entry
+  /// @details Visibilities and flags with the same key are dropped together. The space
+  /// in the cache file is not reclaimed until the cache is cleared.
+  /// @return memory released in bytes, 0 if the cache is empty
+  virtual size_t releaseOldest();
+
+  /// @brief obtain the modification time of the measurement set
+  /// @details This is the latest modification time of the files in the table
+  /// directory (the main table only, the subtables are not checked).
+  /// @param[in] msName name of the measurement set
+  /// @return modification time in seconds since the epoch
+  static double modificationTime(const std::string &msName);
+
+private:
+  /// @brief remove all entries, the mutex should be locked by the caller
+  void clearEntries();
+
+  /// @brief mark the entry as the most recently used, the mutex should be locked by the caller
+  /// @param[in] key accessor identification
+  void touch(const std::string &key) const;
+
+  /// @brief quantisation mode
+  CompactVisibility::Precision itsPrecision;
+
+  /// @brief visibilities kept in memory
+  std::map<std::string, boost::shared_ptr<CompactVisibility const> > itsVisibilities;
+
+  /// @brief positions of the visibilities in the cache file
+  std::map<std::string, std::streamoff> itsFileOffsets;
+
+  /// @brief flags
+  std::map<std::string, boost::shared_ptr<PackedFlagCube const> > itsFlags;
+
+  /// @brief memory used by the cached data in bytes
+  size_t itsMemoryUsed;
+
+  /// @brief use stamp of each key
+  mutable std::map<std::string, casacore::uInt64> itsLastUse;
+
+  /// @brief keys in the order of use, the least recently used first
+  mutable std::map<casacore::uInt64, std::string> itsUseOrder;
+
+  /// @brief name of the cache file, empty if visibilities are kept in memory
+  std::string itsFileName;
+
+  /// @brief cache file
+  mutable std::fstream itsFile;
+
+  /// @brief size of the cache file in bytes
+  std::streamoff itsFileSize;
+
+  /// @brief modification time of the measurement set when the entries were stored,
+  /// negative value means the time is not known yet
+  double itsMSTime;
+
+  /// @brief number of requests served from the cache
+  mutable size_t itsHits;
+
+  /// @brief number of requests not found in the cache
+  mutable size_t itsMisses;
+
+  /// @brief synchronisation lock
+  mutable boost::mutex itsMutex;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_VISIBILITY_CACHE_H
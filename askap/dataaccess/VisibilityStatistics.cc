@@ -0,0 +1,174 @@
+/// @file
+///
+/// @brief Flag, amplitude and noise statistics of the visibility data
+/// @details This class accumulates flag fractions per baseline, channel and time together
+/// with visibility amplitude moments and noise summaries for a range of rows of an accessor.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/VisibilityStatistics.h>
+#include <askap/askap/AskapError.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Complex.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief add sums of another object
+/// @param[in] other sums to add
+void VisibilityStatistics::Moments::merge(const Moments &other)
+{
+  if (other.itsCount == 0) {
+      return;
+  }
+  if (itsCount == 0) {
+      *this = other;
+      return;
+  }
+  itsCount += other.itsCount;
+  itsSum += other.itsSum;
+  itsSumSq += other.itsSumSq;
+  itsMin = std::min(itsMin, other.itsMin);
+  itsMax = std::max(itsMax, other.itsMax);
+}
+
+/// @return variance, 0 if there are no values
+double VisibilityStatistics::Moments::variance() const
+{
+  if (itsCount == 0) {
+      return 0.;
+  }
+  const double meanValue = mean();
+  // guard against the rounding error for nearly constant values
+  return std::max(itsSumSq / itsCount - meanValue * meanValue, 0.);
+}
+
+/// @brief accumulate statistics for a range of rows
+/// @details If the bit-packed flags are given, they are used instead of the flag cube
+/// and the per-sample checks are only done for partially flagged rows.
+/// @param[in] acc accessor with the data
+/// @param[in] startRow first row to process
+/// @param[in] endRow row after the last one to process
+/// @param[in] packedFlags bit-packed flags of the accessor, 0 to use the flag cube
+void VisibilityStatistics::accumulate(const IConstDataAccessor &acc, casacore::uInt startRow,
+                  casacore::uInt endRow, const PackedFlagCube *packedFlags)
+{
+  ASKAPCHECK((startRow <= endRow) && (endRow <= acc.nRow()), "Rows from "<<startRow<<" to "<<endRow<<
+             " are outside the accessor with "<<acc.nRow()<<" row(s)");
+  if (startRow == endRow) {
+      return;
+  }
+  const casacore::uInt nChan = acc.nChannel();
+  const casacore::uInt nPol = acc.nPol();
+  const casacore::Cube<casacore::Complex> &vis = acc.visibility();
+  const casacore::Cube<casacore::Complex> &noise = acc.noise();
+  const casacore::Cube<casacore::Bool> *flags = packedFlags == 0 ? &acc.flag() : 0;
+  const casacore::Vector<casacore::uInt> &antenna1 = acc.antenna1();
+  const casacore::Vector<casacore::uInt> &antenna2 = acc.antenna2();
+  ASKAPDEBUGASSERT((packedFlags == 0) || (packedFlags->nRow() == acc.nRow()));
+  if (itsChannels.size() < nChan) {
+      itsChannels.resize(nChan);
+  }
+  FlagCounts &timeCounts = itsTimes[acc.time()];
+  const casacore::uInt64 samplesPerRow = casacore::uInt64(nChan) * nPol;
+  casacore::uInt64 flaggedInRange = 0;
+  for (casacore::uInt row = startRow; row < endRow; ++row) {
+       BaselineSummary &baseline = itsBaselines[BaselineType(antenna1[row], antenna2[row])];
+       const PackedFlagCube::RowSummary summary = packedFlags != 0 ? packedFlags->rowSummary(row) :
+                                                  PackedFlagCube::PARTIALLY_FLAGGED;
+       casacore::uInt64 flaggedInRow = 0;
+       for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+            casacore::uInt flaggedInChan = 0;
+            if (summary == PackedFlagCube::ALL_FLAGGED) {
+                flaggedInChan = nPol;
+            } else {
+                for (casacore::uInt pol = 0; pol < nPol; ++pol) {
+                     if (summary == PackedFlagCube::PARTIALLY_FLAGGED) {
+                         const bool flagged = flags != 0 ? (*flags)(row, chan, pol) : (*packedFlags)(row, chan, pol);
+                         if (flagged) {
+                             ++flaggedInChan;
+                             continue;
+                         }
+                     }
+                     const double amplitude = casacore::abs(vis(row, chan, pol));
+                     itsAmplitude.add(amplitude);
+                     baseline.itsAmplitude.add(amplitude);
+                     itsNoise.add(casacore::real(noise(row, chan, pol)));
+                }
+            }
+            itsChannels[chan].itsSamples += nPol;
+            itsChannels[chan].itsFlagged += flaggedInChan;
+            flaggedInRow += flaggedInChan;
+       }
+       baseline.itsFlags.itsSamples += samplesPerRow;
+       baseline.itsFlags.itsFlagged += flaggedInRow;
+       timeCounts.itsSamples += samplesPerRow;
+       timeCounts.itsFlagged += flaggedInRow;
+       flaggedInRange += flaggedInRow;
+  }
+  itsTotal.itsSamples += samplesPerRow * (endRow - startRow);
+  itsTotal.itsFlagged += flaggedInRange;
+}
+
+/// @brief add statistics accumulated by another object
+/// @param[in] other statistics to add
+void VisibilityStatistics::merge(const VisibilityStatistics &other)
+{
+  itsTotal.merge(other.itsTotal);
+  itsAmplitude.merge(other.itsAmplitude);
+  itsNoise.merge(other.itsNoise);
+  for (std::map<BaselineType, BaselineSummary>::const_iterator ci = other.itsBaselines.begin();
+       ci != other.itsBaselines.end(); ++ci) {
+       BaselineSummary &baseline = itsBaselines[ci->first];
+       baseline.itsFlags.merge(ci->second.itsFlags);
+       baseline.itsAmplitude.merge(ci->second.itsAmplitude);
+  }
+  if (itsChannels.size() < other.itsChannels.size()) {
+      itsChannels.resize(other.itsChannels.size());
+  }
+  for (size_t chan = 0; chan < other.itsChannels.size(); ++chan) {
+       itsChannels[chan].merge(other.itsChannels[chan]);
+  }
+  for (std::map<double, FlagCounts>::const_iterator ci = other.itsTimes.begin(); ci != other.itsTimes.end(); ++ci) {
+       itsTimes[ci->first].merge(ci->second);
+  }
+}
+
+/// @brief reset all statistics
+void VisibilityStatistics::reset()
+{
+  itsTotal = FlagCounts();
+  itsAmplitude = Moments();
+  itsNoise = Moments();
+  itsBaselines.clear();
+  itsChannels.clear();
+  itsTimes.clear();
+}
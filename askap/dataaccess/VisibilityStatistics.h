@@ -0,0 +1,197 @@
+/// @file
+///
+/// @brief Flag, amplitude and noise statistics of the visibility data
+/// @details Quality assessment needs flag fractions per baseline, channel and time together
+/// with visibility amplitude moments and noise summaries. This class accumulates them for
+/// a range of rows of an accessor. Partial accumulators filled for different rows (e.g. by
+/// different threads) can be merged into one.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_VISIBILITY_STATISTICS_H
+#define ASKAP_ACCESSORS_VISIBILITY_STATISTICS_H
+
+// own includes
+#include <askap/dataaccess/IConstDataAccessor.h>
+#include <askap/dataaccess/PackedFlagCube.h>
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+// std includes
+#include <map>
+#include <vector>
+#include <utility>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Flag, amplitude and noise statistics of the visibility data
+/// @details Flags are counted for every sample, amplitude moments and noise summaries
+/// cover unflagged samples only. Baselines are identified by the pair of antenna indices
+/// (feeds are not distinguished), channels by their index in the accessor (i.e. after
+/// the channel selection) and times by the accessor time (in the units of the data converter).
+/// @ingroup dataaccess_hlp
+class VisibilityStatistics {
+public:
+  /// @brief number of samples and flagged samples
+  struct FlagCounts {
+     /// @brief initialise counts to zero
+     FlagCounts() : itsSamples(0), itsFlagged(0) {}
+
+     /// @return fraction of flagged samples, 0 if there are no samples
+     inline double flagFraction() const { return itsSamples > 0 ? double(itsFlagged) / itsSamples : 0.; }
+
+     /// @brief add counts of another object
+     /// @param[in] other counts to add
+     inline void merge(const FlagCounts &other) { itsSamples += other.itsSamples; itsFlagged += other.itsFlagged; }
+
+     /// @brief total number of samples
+     casacore::uInt64 itsSamples;
+
+     /// @brief number of flagged samples
+     casacore::uInt64 itsFlagged;
+  };
+
+  /// @brief sums required to compute mean and spread of a quantity
+  struct Moments {
+     /// @brief initialise sums to zero
+     Moments() : itsCount(0), itsSum(0.), itsSumSq(0.), itsMin(0.), itsMax(0.) {}
+
+     /// @brief add a value
+     /// @param[in] val value to add
+     inline void add(double val) {
+        if (itsCount == 0 || val < itsMin) {
+            itsMin = val;
+        }
+        if (itsCount == 0 || val > itsMax) {
+            itsMax = val;
+        }
+        ++itsCount;
+        itsSum += val;
+        itsSumSq += val * val;
+     }
+
+     /// @brief add sums of another object
+     /// @param[in] other sums to add
+     void merge(const Moments &other);
+
+     /// @return mean value, 0 if there are no values
+     inline double mean() const { return itsCount > 0 ? itsSum / itsCount : 0.; }
+
+     /// @return variance, 0 if there are no values
+     double variance() const;
+
+     /// @brief number of values
+     casacore::uInt64 itsCount;
+
+     /// @brief sum of values
+     double itsSum;
+
+     /// @brief sum of squares of values
+     double itsSumSq;
+
+     /// @brief smallest value, undefined if there are no values
+     double itsMin;
+
+     /// @brief largest value, undefined if there are no values
+     double itsMax;
+  };
+
+  /// @brief statistics of a single baseline
+  struct BaselineSummary {
+     /// @brief flag counts
+     FlagCounts itsFlags;
+
+     /// @brief moments of the amplitude of unflagged visibilities
+     Moments itsAmplitude;
+  };
+
+  /// @brief type of the baseline identification (antenna1, antenna2)
+  typedef std::pair<casacore::uInt, casacore::uInt> BaselineType;
+
+  /// @brief accumulate statistics for a range of rows
+  /// @details If the bit-packed flags are given, they are used instead of the flag cube
+  /// and the per-sample checks are only done for partially flagged rows. The accessor
+  /// fields used should be filled before this method is called from several threads.
+  /// @param[in] acc accessor with the data
+  /// @param[in] startRow first row to process
+  /// @param[in] endRow row after the last one to process
+  /// @param[in] packedFlags bit-packed flags of the accessor, 0 to use the flag cube
+  void accumulate(const IConstDataAccessor &acc, casacore::uInt startRow, casacore::uInt endRow,
+                  const PackedFlagCube *packedFlags = 0);
+
+  /// @brief add statistics accumulated by another object
+  /// @param[in] other statistics to add
+  void merge(const VisibilityStatistics &other);
+
+  /// @brief reset all statistics
+  void reset();
+
+  /// @return flag counts for all samples
+  inline const FlagCounts& total() const { return itsTotal; }
+
+  /// @return moments of the amplitude of all unflagged visibilities
+  inline const Moments& amplitude() const { return itsAmplitude; }
+
+  /// @return moments of the noise of all unflagged samples
+  inline const Moments& noise() const { return itsNoise; }
+
+  /// @return statistics per baseline
+  inline const std::map<BaselineType, BaselineSummary>& baselines() const { return itsBaselines; }
+
+  /// @return flag counts per channel
+  inline const std::vector<FlagCounts>& channels() const { return itsChannels; }
+
+  /// @return flag counts per time
+  inline const std::map<double, FlagCounts>& times() const { return itsTimes; }
+
+private:
+  /// @brief flag counts for all samples
+  FlagCounts itsTotal;
+
+  /// @brief amplitude of all unflagged visibilities
+  Moments itsAmplitude;
+
+  /// @brief noise of all unflagged samples
+  Moments itsNoise;
+
+  /// @brief statistics per baseline
+  std::map<BaselineType, BaselineSummary> itsBaselines;
+
+  /// @brief flag counts per channel
+  std::vector<FlagCounts> itsChannels;
+
+  /// @brief flag counts per time
+  std::map<double, FlagCounts> itsTimes;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_VISIBILITY_STATISTICS_H
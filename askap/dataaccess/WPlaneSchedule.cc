@@ -0,0 +1,68 @@
+/// @file
+///
+/// @brief Precomputed schedule of the best fitting w-planes
+/// @details This class holds a sequence of w-planes, each given with the time it
+/// comes into effect, computed in a single pass over the metadata.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/WPlaneSchedule.h>
+#include <askap/askap/AskapError.h>
+
+// std includes
+#include <algorithm>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty schedule
+/// @param[in] tangent tangent point for which the planes are fitted
+WPlaneSchedule::WPlaneSchedule(const casacore::MDirection &tangent) : itsTangent(tangent) {}
+
+/// @brief add a plane
+/// @param[in] time change point, i.e. the time this plane comes into effect
+/// @param[in] coeffA fit coefficient A
+/// @param[in] coeffB fit coefficient B
+void WPlaneSchedule::add(double time, double coeffA, double coeffB)
+{
+  ASKAPCHECK(itsTimes.empty() || time >= itsTimes.back(), "Planes should be added to the schedule in time order, "
+             "the change point "<<time<<" precedes the last one at "<<itsTimes.back());
+  itsTimes.push_back(time);
+  itsCoeffA.push_back(coeffA);
+  itsCoeffB.push_back(coeffB);
+}
+
+/// @brief find the plane for the given time
+/// @details An exception is thrown if the schedule is empty.
+/// @param[in] time time of interest
+/// @return index of the plane in effect at the given time
+size_t WPlaneSchedule::planeIndex(double time) const
+{
+  ASKAPCHECK(itsTimes.size() > 0, "The w-plane schedule is empty");
+  const std::vector<double>::const_iterator ci = std::upper_bound(itsTimes.begin(), itsTimes.end(), time);
+  return ci == itsTimes.begin() ? 0 : size_t(ci - itsTimes.begin()) - 1;
+}
@@ -0,0 +1,113 @@
+/// @file
+///
+/// @brief Precomputed schedule of the best fitting w-planes
+/// @details BestWPlaneDataAccessor fits a new plane lazily when the deviation of the
+/// w-term from the current plane exceeds the tolerance. The sequence of planes only depends
+/// on the uvw track, so it can be computed in a single pass over the metadata and then
+/// reused by every imaging iteration. This class holds such a sequence: the time each plane
+/// comes into effect together with its coefficients.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_W_PLANE_SCHEDULE_H
+#define ASKAP_ACCESSORS_W_PLANE_SCHEDULE_H
+
+// casa includes
+#include <casacore/measures/Measures/MDirection.h>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Precomputed schedule of the best fitting w-planes
+/// @details The schedule is a sequence of planes w=Au+Bv, each given with the time it
+/// comes into effect (change point). Times are in the units of the data converter used by
+/// the iterator the schedule has been computed for and have to be added in the increasing
+/// order. The plane for any time is the last one with the change point not later than this
+/// time, the first plane is also used for earlier times. The schedule corresponds to a
+/// single tangent point.
+/// @ingroup dataaccess_hlp
+class WPlaneSchedule {
+public:
+  /// @brief construct an empty schedule
+  /// @param[in] tangent tangent point for which the planes are fitted
+  explicit WPlaneSchedule(const casacore::MDirection &tangent);
+
+  /// @brief add a plane
+  /// @param[in] time change point, i.e. the time this plane comes into effect
+  /// @param[in] coeffA fit coefficient A
+  /// @param[in] coeffB fit coefficient B
+  void add(double time, double coeffA, double coeffB);
+
+  /// @return number of planes in the schedule
+  inline size_t size() const { return itsTimes.size(); }
+
+  /// @return tangent point for which the planes are fitted
+  inline const casacore::MDirection& tangent() const { return itsTangent; }
+
+  /// @brief find the plane for the given time
+  /// @details An exception is thrown if the schedule is empty.
+  /// @param[in] time time of interest
+  /// @return index of the plane in effect at the given time
+  size_t planeIndex(double time) const;
+
+  /// @brief obtain the change point of a plane
+  /// @param[in] plane index of the plane
+  /// @return time the plane comes into effect
+  inline double changePoint(size_t plane) const { return itsTimes[plane]; }
+
+  /// @brief obtain fit coefficient A of a plane
+  /// @param[in] plane index of the plane
+  /// @return fit coefficient A
+  inline double coeffA(size_t plane) const { return itsCoeffA[plane]; }
+
+  /// @brief obtain fit coefficient B of a plane
+  /// @param[in] plane index of the plane
+  /// @return fit coefficient B
+  inline double coeffB(size_t plane) const { return itsCoeffB[plane]; }
+
+private:
+  /// @brief tangent point for which the planes are fitted
+  casacore::MDirection itsTangent;
+
+  /// @brief change points in the increasing order
+  std::vector<double> itsTimes;
+
+  /// @brief fit coefficients A
+  std::vector<double> itsCoeffA;
+
+  /// @brief fit coefficients B
+  std::vector<double> itsCoeffB;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_W_PLANE_SCHEDULE_H
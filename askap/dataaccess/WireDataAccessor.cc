@@ -0,0 +1,137 @@
+/// @file
+///
+/// @brief Accessor wrapping a received accessor snapshot
+/// @details AccessorWireFormat packs the content of an accessor into a contiguous
+/// buffer which can be sent to another rank. This class presents such a buffer as a
+/// read-only accessor without copying the large fields.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include <askap/dataaccess/WireDataAccessor.h>
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief make the array refer to the block of the buffer
+/// @param[in] array array to set up
+/// @param[in] shape shape of the array
+/// @param[in] data start of the buffer
+/// @param[in] header header of the buffer
+/// @param[in] block block to refer to
+template<typename T, typename ArrayType>
+void shareBlock(ArrayType &array, const casacore::IPosition &shape, char *data,
+                const AccessorWireFormat::Header &header, AccessorWireFormat::Blocks block)
+{
+  ASKAPDEBUGASSERT(header.itsOffsets[block] > 0);
+  array.takeStorage(shape, reinterpret_cast<T*>(data + header.itsOffsets[block]), casacore::SHARE);
+}
+
+/// @brief unpack directions stored as three direction cosines each
+/// @param[out] dirs vector of directions to fill
+/// @param[in] nRow number of rows
+/// @param[in] data start of the buffer
+/// @param[in] header header of the buffer
+/// @param[in] block block to unpack
+void unpackDirections(casacore::Vector<casacore::MVDirection> &dirs, casacore::uInt nRow, const char *data,
+                      const AccessorWireFormat::Header &header, AccessorWireFormat::Blocks block)
+{
+  const casacore::Double *in = reinterpret_cast<const casacore::Double*>(data + header.itsOffsets[block]);
+  dirs.resize(nRow);
+  for (casacore::uInt row = 0; row < nRow; ++row) {
+       dirs[row] = casacore::MVDirection(in[3 * row], in[3 * row + 1], in[3 * row + 2]);
+  }
+}
+
+} // anonymous namespace
+
+/// @brief wrap the buffer
+/// @details The buffer is checked by AccessorWireFormat::header and an exception is
+/// thrown if it is not an accessor snapshot. The buffer shouldn't be changed while
+/// this object is alive.
+/// @param[in] buffer shared pointer to the buffer filled by AccessorWireFormat::pack
+WireDataAccessor::WireDataAccessor(const boost::shared_ptr<std::vector<char> > &buffer) :
+      DataAccessorStub(false), itsBuffer(buffer), itsFields(0)
+{
+  ASKAPCHECK(itsBuffer, "An attempt to initialise WireDataAccessor with empty shared pointer");
+  const AccessorWireFormat::Header header = AccessorWireFormat::header(*itsBuffer);
+  itsFields = header.itsFields;
+  itsTime = header.itsTime;
+  char *data = &(*itsBuffer)[0];
+  const casacore::uInt nRow = header.itsNRow;
+  const casacore::IPosition cubeShape(3, nRow, header.itsNChannel, header.itsNPol);
+  const casacore::IPosition rowShape(1, nRow);
+
+  shareBlock<casacore::Complex>(itsVisibility, cubeShape, data, header, AccessorWireFormat::VISIBILITY_BLOCK);
+  if (itsFields & IDataSelector::FLAG) {
+      shareBlock<casacore::Bool>(itsFlag, cubeShape, data, header, AccessorWireFormat::FLAG_BLOCK);
+  }
+  if (itsFields & IDataSelector::NOISE) {
+      shareBlock<casacore::Complex>(itsNoise, cubeShape, data, header, AccessorWireFormat::NOISE_BLOCK);
+  }
+  if (itsFields & IDataSelector::UVW) {
+      // uvw is packed as three doubles per row which is the layout of RigidVector
+      static_assert(sizeof(casacore::RigidVector<casacore::Double, 3>) == 3 * sizeof(casacore::Double),
+                    "RigidVector is expected to hold its elements without padding");
+      shareBlock<casacore::RigidVector<casacore::Double, 3> >(itsUVW, rowShape, data, header,
+                 AccessorWireFormat::UVW_BLOCK);
+  }
+  if (itsFields & IDataSelector::FREQUENCY) {
+      shareBlock<casacore::Double>(itsFrequency, casacore::IPosition(1, header.itsNChannel), data, header,
+                 AccessorWireFormat::FREQUENCY_BLOCK);
+  }
+  if (itsFields & IDataSelector::ANTENNA) {
+      shareBlock<casacore::uInt>(itsAntenna1, rowShape, data, header, AccessorWireFormat::ANTENNA1_BLOCK);
+      shareBlock<casacore::uInt>(itsAntenna2, rowShape, data, header, AccessorWireFormat::ANTENNA2_BLOCK);
+  }
+  if (itsFields & IDataSelector::FEED) {
+      shareBlock<casacore::uInt>(itsFeed1, rowShape, data, header, AccessorWireFormat::FEED1_BLOCK);
+      shareBlock<casacore::uInt>(itsFeed2, rowShape, data, header, AccessorWireFormat::FEED2_BLOCK);
+  }
+  if (itsFields & IDataSelector::FEED_PA) {
+      shareBlock<casacore::Float>(itsFeed1PA, rowShape, data, header, AccessorWireFormat::FEED1_PA_BLOCK);
+      shareBlock<casacore::Float>(itsFeed2PA, rowShape, data, header, AccessorWireFormat::FEED2_PA_BLOCK);
+  }
+  if (itsFields & IDataSelector::POINTING) {
+      unpackDirections(itsPointingDir1, nRow, data, header, AccessorWireFormat::POINTING_DIR1_BLOCK);
+      unpackDirections(itsPointingDir2, nRow, data, header, AccessorWireFormat::POINTING_DIR2_BLOCK);
+  }
+  if (itsFields & IDataSelector::DISH_POINTING) {
+      unpackDirections(itsDishPointing1, nRow, data, header, AccessorWireFormat::DISH_POINTING1_BLOCK);
+      unpackDirections(itsDishPointing2, nRow, data, header, AccessorWireFormat::DISH_POINTING2_BLOCK);
+  }
+  if (itsFields & IDataSelector::STOKES) {
+      const casacore::Int *in = reinterpret_cast<const casacore::Int*>(data +
+                                header.itsOffsets[AccessorWireFormat::STOKES_BLOCK]);
+      itsStokes.resize(header.itsNPol);
+      for (casacore::uInt pol = 0; pol < header.itsNPol; ++pol) {
+           itsStokes[pol] = casacore::Stokes::StokesTypes(in[pol]);
+      }
+  }
+}
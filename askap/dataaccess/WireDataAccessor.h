@@ -0,0 +1,86 @@
+/// @file
+///
+/// @brief Accessor wrapping a received accessor snapshot
+/// @details AccessorWireFormat packs the content of an accessor into a contiguous
+/// buffer which can be sent to another rank. This class presents such a buffer as a
+/// read-only accessor. The large fields refer to the buffer directly, nothing is copied.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_WIRE_DATA_ACCESSOR_H
+#define ASKAP_ACCESSORS_WIRE_DATA_ACCESSOR_H
+
+// own includes
+#include <askap/dataaccess/DataAccessorStub.h>
+#include <askap/dataaccess/AccessorWireFormat.h>
+
+// boost includes
+#include <boost/shared_ptr.hpp>
+
+// std includes
+#include <vector>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Accessor wrapping a received accessor snapshot
+/// @details The visibility, flag and noise cubes, the frequency, antenna, feed and
+/// position angle vectors, as well as uvw, are casacore arrays sharing the storage with
+/// the buffer. The buffer is held by this class, so the arrays stay valid as long as the
+/// accessor is alive. Directions and polarisation types are small and are converted into
+/// the usual casacore types on construction. Fields which haven't been packed are empty,
+/// rotatedUVW returns the original uvw (the same as for TimeChunkBuffer).
+/// @ingroup dataaccess_hlp
+class WireDataAccessor : public DataAccessorStub {
+public:
+  /// @brief wrap the buffer
+  /// @details The buffer is checked by AccessorWireFormat::header and an exception is
+  /// thrown if it is not an accessor snapshot. The buffer shouldn't be changed while
+  /// this object is alive.
+  /// @param[in] buffer shared pointer to the buffer filled by AccessorWireFormat::pack
+  explicit WireDataAccessor(const boost::shared_ptr<std::vector<char> > &buffer);
+
+  /// @return fields present in the buffer (bitwise combination of
+  /// IDataSelector::AccessorFields values)
+  inline casacore::uInt fields() const { return itsFields; }
+
+  /// @return shared pointer to the wrapped buffer
+  inline const boost::shared_ptr<std::vector<char> >& buffer() const { return itsBuffer; }
+
+private:
+  /// @brief wrapped buffer
+  boost::shared_ptr<std::vector<char> > itsBuffer;
+
+  /// @brief fields present in the buffer
+  casacore::uInt itsFields;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_WIRE_DATA_ACCESSOR_H
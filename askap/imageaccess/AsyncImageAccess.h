@@ -0,0 +1,106 @@
+/// @file AsyncImageAccess.h
+/// @brief Asynchronous image reads
+/// @details IImageAccess::read blocks until the pixels are read. The functions defined here
+/// read the pixels in a thread of the I/O pool (see IOThreadPool), so a pipeline can have
+/// many reads of different images in flight and wait for them when the pixels are needed.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ASYNC_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_ASYNC_IMAGE_ACCESS_H
+
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/SharedImageReader.h>
+#include <askap/dataaccess/IOThreadPool.h>
+#include <askap/askap/AskapError.h>
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+
+#include <future>
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief read part of the image asynchronously
+/// @details Image accessors are not thread-safe, so all asynchronous operations with the same
+/// accessor should be submitted through the same strand (see IOThreadPool::Strand), and the
+/// accessor shouldn't be used elsewhere until the futures are ready.
+/// @param[in] accessor image accessor to read with
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[in] executor strand (or pool, if the accessor is used by a single operation) to execute the read
+/// @return future with the array of pixels for the selection only
+template<typename T, typename Executor>
+std::future<casacore::Array<T> > readAsync(const boost::shared_ptr<IImageAccess<T> > &accessor,
+              const std::string &name, const casacore::IPosition &blc, const casacore::IPosition &trc,
+              Executor &executor)
+{
+    ASKAPCHECK(accessor, "An attempt to read an image asynchronously with an empty accessor");
+    typedef casacore::Array<T> (IImageAccess<T>::*ReadMethod)(const std::string &, const casacore::IPosition &,
+                                                              const casacore::IPosition &) const;
+    return executor.submit(boost::bind(static_cast<ReadMethod>(&IImageAccess<T>::read), accessor, name, blc, trc));
+}
+
+/// @brief read part of the image asynchronously with the thread-safe reader
+/// @details SharedImageReader can be used concurrently, so any number of reads can be
+/// outstanding.
+/// @param[in] reader thread-safe reader
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[in] executor pool or strand to execute the read
+/// @return future with the array of pixels for the selection only
+template<typename Executor>
+std::future<casacore::Array<float> > readAsync(const boost::shared_ptr<SharedImageReader const> &reader,
+              const std::string &name, const casacore::IPosition &blc, const casacore::IPosition &trc,
+              Executor &executor)
+{
+    ASKAPCHECK(reader, "An attempt to read an image asynchronously with an empty reader");
+    return executor.submit(boost::bind(&SharedImageReader::read, reader, name, blc, trc));
+}
+
+/// @brief read part of the image asynchronously with the thread-safe reader using the shared pool
+/// @param[in] reader thread-safe reader
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return future with the array of pixels for the selection only
+inline std::future<casacore::Array<float> > readAsync(const boost::shared_ptr<SharedImageReader const> &reader,
+              const std::string &name, const casacore::IPosition &blc, const casacore::IPosition &trc)
+{
+    return readAsync(reader, name, blc, trc, IOThreadPool::shared());
+}
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_ASYNC_IMAGE_ACCESS_H
@@ -0,0 +1,183 @@
+/// @file AsyncImageWriter.h
+/// @brief Write images in the background
+/// @details This class wraps an image accessor and performs the writes in a
+/// background thread, so the caller can carry on with computing while the data
+/// are written to disk.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_ASYNC_IMAGE_WRITER_H
+#define ASKAP_ACCESSORS_ASYNC_IMAGE_WRITER_H
+
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/dataaccess/ThreadAffinity.h>
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <exception>
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Write images in the background
+/// @details The writes are queued and done by a background thread in the order they were
+/// requested. The memory held by the queued arrays is bounded, the caller waits if the
+/// budget is exceeded (a single array larger than the budget is still accepted if the
+/// queue is empty). Errors encountered by the background thread are rethrown by the next
+/// call to write or flush, the writes queued after the failed one are discarded.
+///
+/// The wrapped accessor is used by the background thread, so it (and the images being
+/// written) shouldn't be accessed elsewhere until flush has returned.
+/// @ingroup imageaccess
+template <class T = casacore::Float>
+class AsyncImageWriter : public boost::noncopyable {
+public:
+    /// @brief set up the writer
+    /// @param[in] accessor image accessor to write with
+    /// @param[in] maxBytes maximum size in bytes of the arrays waiting to be written
+    /// @param[in] affinity placement policy for the background thread, the CONSUMER policy
+    ///            is resolved in the thread constructing this object. The copies of the
+    ///            queued arrays are bound to the NUMA node of the policy.
+    explicit AsyncImageWriter(const boost::shared_ptr<IImageAccess<T> > &accessor,
+                              size_t maxBytes = 256 * 1024 * 1024,
+                              const accessors::ThreadAffinity &affinity = accessors::ThreadAffinity());
+
+    /// @brief destructor, waits until all queued writes are done
+    /// @details Errors are reported to the log, call flush to handle them.
+    ~AsyncImageWriter();
+
+    /// @brief queue a copy of the array to be written into the full image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    void write(const std::string &name, const casacore::Array<T> &arr);
+
+    /// @brief queue a copy of the array to be written into a slice of the image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    void write(const std::string &name, const casacore::Array<T> &arr, const casacore::IPosition &where);
+
+    /// @brief queue the array to be written into a slice of the image without copying
+    /// @details The writer takes over the storage of the array, the array passed is left empty.
+    /// The storage shouldn't be referenced by any other array.
+    /// @param[in] name image name
+    /// @param[in,out] arr array with pixels, empty on return
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    void writeAdopt(const std::string &name, casacore::Array<T> &arr, const casacore::IPosition &where);
+
+    /// @brief wait until all queued writes are done
+    /// @details The error encountered by the background thread (if any) is rethrown.
+    void flush();
+
+    /// @return size in bytes of the arrays waiting to be written
+    size_t pendingBytes() const;
+
+    /// @return number of writes waiting to be done
+    size_t pendingWrites() const;
+
+    /// @return placement policy of the background thread (resolved)
+    inline const accessors::ThreadAffinity& threadAffinity() const { return itsThreadAffinity; }
+
+private:
+    /// @brief single queued write
+    struct Request {
+        /// @brief image name
+        std::string itsName;
+        /// @brief pixels to write
+        casacore::Array<T> itsArray;
+        /// @brief bottom left corner, empty to write the full image
+        casacore::IPosition itsWhere;
+    };
+
+    /// @brief add a request to the queue
+    /// @details Waits for the memory budget, rethrows the error of the background thread.
+    /// @param[in] request write to do (the array is referenced, not copied)
+    void enqueue(const Request &request);
+
+    /// @brief make a copy of the array to be queued
+    /// @details The storage is allocated on the NUMA node of the placement policy
+    /// @param[in] arr array to copy
+    /// @return copy of the array
+    casacore::Array<T> copyArray(const casacore::Array<T> &arr) const;
+
+    /// @brief body of the background thread
+    void run();
+
+    /// @brief accessor to write with
+    boost::shared_ptr<IImageAccess<T> > itsAccessor;
+
+    /// @brief maximum size of the queued arrays in bytes
+    size_t itsMaxBytes;
+
+    /// @brief placement policy of the background thread
+    accessors::ThreadAffinity itsThreadAffinity;
+
+    /// @brief allocator for the copies of the queued arrays, empty for the global heap
+    boost::shared_ptr<accessors::ArrayAllocator const> itsAllocator;
+
+    /// @brief writes waiting to be done
+    std::deque<Request> itsQueue;
+
+    /// @brief size of the queued arrays in bytes (including the write in progress)
+    size_t itsPendingBytes;
+
+    /// @brief true while the background thread is writing
+    bool itsBusy;
+
+    /// @brief true if the background thread is asked to stop
+    bool itsStopRequested;
+
+    /// @brief error encountered by the background thread, if any
+    std::exception_ptr itsError;
+
+    /// @brief synchronisation lock
+    mutable boost::mutex itsMutex;
+
+    /// @brief signalled when a request is queued or the thread is asked to stop
+    boost::condition_variable itsRequestQueued;
+
+    /// @brief signalled when a write is done
+    boost::condition_variable itsWriteDone;
+
+    /// @brief background thread
+    boost::shared_ptr<boost::thread> itsThread;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#include <askap/imageaccess/AsyncImageWriter.tcc>
+
+#endif // #ifndef ASKAP_ACCESSORS_ASYNC_IMAGE_WRITER_H
@@ -0,0 +1,252 @@
+/// @file AsyncImageWriter.tcc
+/// @brief Write images in the background
+/// @details This class wraps an image accessor and performs the writes in a
+/// background thread.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/imageaccess/AsyncImageWriter.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+namespace askap {
+namespace accessors {
+
+/// @brief set up the writer
+/// @param[in] accessor image accessor to write with
+/// @param[in] maxBytes maximum size in bytes of the arrays waiting to be written
+/// @param[in] affinity placement policy for the background thread
+template <class T>
+AsyncImageWriter<T>::AsyncImageWriter(const boost::shared_ptr<IImageAccess<T> > &accessor, size_t maxBytes,
+                                      const accessors::ThreadAffinity &affinity) :
+    itsAccessor(accessor), itsMaxBytes(maxBytes), itsThreadAffinity(affinity.resolve()),
+    itsAllocator(itsThreadAffinity.allocator()), itsPendingBytes(0), itsBusy(false), itsStopRequested(false)
+{
+    ASKAPCHECK(itsAccessor, "An attempt to initialise AsyncImageWriter with empty shared pointer");
+    itsThread.reset(new boost::thread(boost::bind(&AsyncImageWriter<T>::run, this)));
+}
+
+/// @brief destructor, waits until all queued writes are done
+/// @details Errors are reported to the log, call flush to handle them.
+template <class T>
+AsyncImageWriter<T>::~AsyncImageWriter()
+{
+    {
+      boost::unique_lock<boost::mutex> lock(itsMutex);
+      while ((!itsQueue.empty() || itsBusy) && !itsError) {
+             itsWriteDone.wait(lock);
+      }
+      itsStopRequested = true;
+    }
+    itsRequestQueued.notify_all();
+    if (itsThread) {
+        itsThread->join();
+    }
+    if (itsError) {
+        try {
+           std::rethrow_exception(itsError);
+        }
+        catch (const std::exception &ex) {
+           ASKAP_LOGGER(logger, ".AsyncImageWriter");
+           ASKAPLOG_ERROR_STR(logger, "Asynchronous image write has failed: " << ex.what());
+        }
+        catch (...) {
+        }
+    }
+}
+
+/// @brief queue a copy of the array to be written into the full image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+template <class T>
+void AsyncImageWriter<T>::write(const std::string &name, const casacore::Array<T> &arr)
+{
+    Request request;
+    request.itsName = name;
+    request.itsArray.reference(copyArray(arr));
+    enqueue(request);
+}
+
+/// @brief queue a copy of the array to be written into a slice of the image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void AsyncImageWriter<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                const casacore::IPosition &where)
+{
+    Request request;
+    request.itsName = name;
+    request.itsArray.reference(copyArray(arr));
+    request.itsWhere = where;
+    enqueue(request);
+}
+
+/// @brief queue the array to be written into a slice of the image without copying
+/// @details The writer takes over the storage of the array, the array passed is left empty.
+/// The storage shouldn't be referenced by any other array.
+/// @param[in] name image name
+/// @param[in,out] arr array with pixels, empty on return
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void AsyncImageWriter<T>::writeAdopt(const std::string &name, casacore::Array<T> &arr,
+                                     const casacore::IPosition &where)
+{
+    Request request;
+    request.itsName = name;
+    request.itsArray.reference(arr);
+    request.itsWhere = where;
+    arr.reference(casacore::Array<T>());
+    enqueue(request);
+}
+
+/// @brief wait until all queued writes are done
+/// @details The error encountered by the background thread (if any) is rethrown.
+template <class T>
+void AsyncImageWriter<T>::flush()
+{
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    while ((!itsQueue.empty() || itsBusy) && !itsError) {
+           itsWriteDone.wait(lock);
+    }
+    if (itsError) {
+        std::exception_ptr error = itsError;
+        itsError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+/// @return size in bytes of the arrays waiting to be written
+template <class T>
+size_t AsyncImageWriter<T>::pendingBytes() const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    return itsPendingBytes;
+}
+
+/// @return number of writes waiting to be done
+template <class T>
+size_t AsyncImageWriter<T>::pendingWrites() const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    return itsQueue.size() + (itsBusy ? 1 : 0);
+}
+
+/// @brief make a copy of the array to be queued
+/// @details The storage is allocated on the NUMA node of the placement policy
+/// @param[in] arr array to copy
+/// @return copy of the array
+template <class T>
+casacore::Array<T> AsyncImageWriter<T>::copyArray(const casacore::Array<T> &arr) const
+{
+    if (!itsAllocator) {
+        return arr.copy();
+    }
+    casacore::Array<T> result;
+    itsAllocator->resize(result, arr.shape());
+    result = arr;
+    return result;
+}
+
+/// @brief add a request to the queue
+/// @details Waits for the memory budget, rethrows the error of the background thread.
+/// @param[in] request write to do (the array is referenced, not copied)
+template <class T>
+void AsyncImageWriter<T>::enqueue(const Request &request)
+{
+    const size_t bytes = request.itsArray.nelements() * sizeof(T);
+    {
+      boost::unique_lock<boost::mutex> lock(itsMutex);
+      // an array larger than the budget is accepted when nothing else is pending
+      while ((itsPendingBytes > 0) && (itsPendingBytes + bytes > itsMaxBytes) && !itsError) {
+             itsWriteDone.wait(lock);
+      }
+      if (itsError) {
+          std::exception_ptr error = itsError;
+          itsError = nullptr;
+          std::rethrow_exception(error);
+      }
+      itsQueue.push_back(request);
+      itsPendingBytes += bytes;
+    }
+    itsRequestQueued.notify_all();
+}
+
+/// @brief body of the background thread
+template <class T>
+void AsyncImageWriter<T>::run()
+{
+    itsThreadAffinity.apply("image writer");
+    while (true) {
+       Request request;
+       {
+         boost::unique_lock<boost::mutex> lock(itsMutex);
+         while (itsQueue.empty() && !itsStopRequested) {
+                itsRequestQueued.wait(lock);
+         }
+         if (itsQueue.empty()) {
+             break;
+         }
+         request = itsQueue.front();
+         itsQueue.pop_front();
+         itsBusy = true;
+       }
+       const size_t bytes = request.itsArray.nelements() * sizeof(T);
+       std::exception_ptr error;
+       try {
+          if (request.itsWhere.nelements() > 0) {
+              itsAccessor->write(request.itsName, request.itsArray, request.itsWhere);
+          } else {
+              itsAccessor->write(request.itsName, request.itsArray);
+          }
+       }
+       catch (...) {
+          error = std::current_exception();
+       }
+       // release the memory before the budget is updated
+       request.itsArray.resize();
+       {
+         boost::lock_guard<boost::mutex> lock(itsMutex);
+         itsBusy = false;
+         itsPendingBytes -= bytes;
+         if (error) {
+             itsError = error;
+             // the writes queued after the failed one are discarded
+             for (typename std::deque<Request>::const_iterator ci = itsQueue.begin(); ci != itsQueue.end(); ++ci) {
+                  itsPendingBytes -= ci->itsArray.nelements() * sizeof(T);
+             }
+             itsQueue.clear();
+         }
+       }
+       itsWriteDone.notify_all();
+    }
+}
+
+} // namespace accessors
+} // namespace askap
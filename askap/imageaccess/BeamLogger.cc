@@ -32,6 +32,9 @@
 // System includes
 #include <string>
 #include <vector>
+#include <atomic>
+#include <exception>
+#include <algorithm>
 
 // ASKAPsoft includes
 #include <askap/askap/AskapLogging.h>
@@ -39,14 +42,12 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Quanta/Quantum.h>
 #include <Common/ParameterSet.h>
-#include <Blob/BlobString.h>
-#include <Blob/BlobIBufString.h>
-#include <Blob/BlobOBufString.h>
-#include <Blob/BlobIStream.h>
-#include <Blob/BlobOStream.h>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 
 // Local package includeas
 #include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/GatherRecords.h>
 ASKAP_LOGGER(logger, ".BeamLogger");
 
 namespace askap {
@@ -70,16 +71,83 @@ BeamLogger::BeamLogger(const std::string &filename):
 {
 }
 
-void BeamLogger::extractBeams(const std::vector<std::string>& imageList)
+namespace {
+
+/// @brief body of the threads reading beams for BeamLogger::extractBeams
+/// @details Every image is opened by its own accessor, which is discarded straight away,
+/// so the snapshots of thousands of images are not kept in memory.
+/// @param imageList image names in the channel order
+/// @param channels channels to read
+/// @param next index of the next element of channels to read, shared between the threads
+/// @param beams beams for each element of channels
+/// @param error first error encountered by this thread
+void readBeams(const std::vector<std::string> &imageList, const std::vector<unsigned int> &channels,
+               std::atomic<size_t> &next, std::vector<casacore::Vector<casacore::Quantum<double> > > &beams,
+               std::exception_ptr &error)
+{
+    try {
+        for (size_t index = next++; index < channels.size(); index = next++) {
+             CasaImageAccess<> ia;
+             beams[index] = ia.metadata(imageList[channels[index]])->itsBeam;
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+}
+
+} // anonymous namespace
+
+void BeamLogger::extractBeams(const std::vector<std::string>& imageList, size_t nThreads)
 {
     itsBeamList.clear();
-    std::vector<std::string>::const_iterator image = imageList.begin();
+    std::vector<unsigned int> channels(imageList.size());
+    for (size_t chan = 0; chan < channels.size(); ++chan) {
+         channels[chan] = chan;
+    }
+    extractBeams(imageList, channels, nThreads);
+}
 
-    unsigned int chan = 0;
-    for (; image != imageList.end(); image++) {
-        CasaImageAccess<> ia;
-        itsBeamList[chan] = ia.beamInfo(*image);
-        chan++;
+void BeamLogger::extractBeams(askapparallel::AskapParallel &comms, const std::vector<std::string>& imageList,
+                              int rankToGather, size_t nThreads)
+{
+    itsBeamList.clear();
+    std::vector<unsigned int> channels;
+    const size_t nProcs = comms.isParallel() ? comms.nProcs() : 1;
+    for (size_t chan = comms.isParallel() ? comms.rank() : 0; chan < imageList.size(); chan += nProcs) {
+         channels.push_back(chan);
+    }
+    ASKAPLOG_DEBUG_STR(logger, "Extracting beams of " << channels.size() << " out of " << imageList.size() <<
+                       " channel image(s) on rank " << comms.rank());
+    extractBeams(imageList, channels, nThreads);
+    gather(comms, rankToGather, true);
+}
+
+void BeamLogger::extractBeams(const std::vector<std::string>& imageList, const std::vector<unsigned int> &channels,
+                              size_t nThreads)
+{
+    ASKAPCHECK(nThreads > 0, "extractBeams needs at least one thread, you have " << nThreads);
+    std::vector<casacore::Vector<casacore::Quantum<double> > > beams(channels.size());
+    std::atomic<size_t> next(0);
+    nThreads = std::min(nThreads, channels.size());
+    std::vector<std::exception_ptr> errors(std::max(nThreads, size_t(1)));
+    if (nThreads <= 1) {
+        readBeams(imageList, channels, next, beams, errors[0]);
+    } else {
+        boost::thread_group threads;
+        for (size_t thread = 0; thread < nThreads; ++thread) {
+             threads.create_thread(boost::bind(&readBeams, boost::cref(imageList), boost::cref(channels),
+                                   boost::ref(next), boost::ref(beams), boost::ref(errors[thread])));
+        }
+        threads.join_all();
+    }
+    for (std::vector<std::exception_ptr>::const_iterator ci = errors.begin(); ci != errors.end(); ++ci) {
+         if (*ci) {
+             std::rethrow_exception(*ci);
+         }
+    }
+    for (size_t index = 0; index < channels.size(); ++index) {
+         itsBeamList[channels[index]] = beams[index];
     }
 }
 
@@ -161,76 +229,32 @@ void BeamLogger::gather(askapparallel::AskapParallel &comms, int rankToGather, b
 
     if (comms.isParallel()) {
 
-        int minrank=0;
-        if (!includeMaster){
-            minrank=1;
-        }
-
-        if (comms.rank() != rankToGather) {
-            // If we are here, the current rank does not do the gathering.
-            // Instead, send the data to the rank that is.
-
-            ASKAPLOG_DEBUG_STR(logger, "Sending from rank " << comms.rank() <<" to rank " << rankToGather);
-            // send to desired rank
-            LOFAR::BlobString bs;
-            bs.resize(0);
-            LOFAR::BlobOBufString bob(bs);
-            LOFAR::BlobOStream out(bob);
-            out.putStart("gatherBeam", 1);
-            unsigned int size = itsBeamList.size();
-            out << size;
-            if (itsBeamList.size() > 0) {
-                ASKAPLOG_DEBUG_STR(logger, "This has data, so sending beam list of size " << size);
-                BeamList::iterator beam = itsBeamList.begin();
-                for (const auto& beam : itsBeamList) {
-                    out << beam.first
-                        << beam.second[0].getValue("arcsec")
-                        << beam.second[1].getValue("arcsec")
-                        << beam.second[2].getValue("deg");
-                }
+        // records of 4 numbers: channel, major and minor axes (arcsec) and position angle (deg)
+        // the nominated rank keeps its own list, the master is excluded if requested
+        std::vector<double> records;
+        if ((comms.rank() != rankToGather) && (includeMaster || (comms.rank() != 0))) {
+            records.reserve(itsBeamList.size() * 4);
+            for (const auto& beam : itsBeamList) {
+                 records.push_back(beam.first);
+                 records.push_back(beam.second[0].getValue("arcsec"));
+                 records.push_back(beam.second[1].getValue("arcsec"));
+                 records.push_back(beam.second[2].getValue("deg"));
             }
-            out.putEnd();
-            comms.sendBlob(bs, rankToGather);
-        } else {
-
-            // The rank on which we are gathering the data
-            // Loop over all the others and read their beam.
-            for (int rank = minrank; rank < comms.nProcs(); rank++) {
-
-                if (rank != comms.rank()) {
-                    ASKAPLOG_DEBUG_STR(logger, "Preparing to receive beamlist from rank " << rank);
-                    LOFAR::BlobString bs;
-                    bs.resize(0);
-                    comms.receiveBlob(bs, rank);
-                    LOFAR::BlobIBufString bib(bs);
-                    LOFAR::BlobIStream in(bib);
-                    int version = in.getStart("gatherBeam");
-                    ASKAPASSERT(version == 1);
-                    unsigned int size, chan;
-                    double bmaj, bmin, bpa;
-                    in >> size;
-                    if (size > 0) {
-                        ASKAPLOG_DEBUG_STR(logger, "Has data - about to receive " << size << " channels");
-                        for(unsigned int i=0;i<size;i++){
-                            in >> chan >> bmaj >> bmin >> bpa;
-                            if (bmaj > 0.) {
-                                casacore::Vector<casacore::Quantum<double> > currentbeam(3);
-                                currentbeam[0] = casacore::Quantum<double>(bmaj, "arcsec");
-                                currentbeam[1] = casacore::Quantum<double>(bmin, "arcsec");
-                                currentbeam[2] = casacore::Quantum<double>(bpa, "deg");
-                                itsBeamList[chan] = currentbeam;
-                            }
-                        }
-                    }
-                    else {
-                        ASKAPLOG_DEBUG_STR(logger, "No data from rank " << rank);
-                    }
-                    in.getEnd();
-
-                }
-
-            }
-
+        }
+        const std::vector<double> gathered = gatherRecords(records, rankToGather);
+        ASKAPDEBUGASSERT(gathered.size() % 4 == 0);
+        if (comms.rank() == rankToGather) {
+            ASKAPLOG_DEBUG_STR(logger, "Received " << gathered.size() / 4 << " channels from other ranks");
+        }
+        // records are in the rank order, so later ranks take precedence as before
+        for (size_t index = 0; index + 3 < gathered.size(); index += 4) {
+             if (gathered[index + 1] > 0.) {
+                 casacore::Vector<casacore::Quantum<double> > currentbeam(3);
+                 currentbeam[0] = casacore::Quantum<double>(gathered[index + 1], "arcsec");
+                 currentbeam[1] = casacore::Quantum<double>(gathered[index + 2], "arcsec");
+                 currentbeam[2] = casacore::Quantum<double>(gathered[index + 3], "deg");
+                 itsBeamList[static_cast<unsigned int>(gathered[index])] = currentbeam;
+             }
         }
 
     }
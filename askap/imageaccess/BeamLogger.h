@@ -69,8 +69,25 @@ class BeamLogger {
         /// provided in the the imageList. The order of the images is
         /// assumed to give the channel order (so the first image is
         /// channel 0, the second channel 1, etc).
+        /// @details Only the metadata snapshot of each image is read (see
+        /// IImageAccess::metadata). The images can be shared between a number
+        /// of threads, each thread opens its own images, so no image is opened
+        /// by more than one thread.
         /// @param imageList A vector list of image names
-        void extractBeams(const std::vector<std::string>& imageList);
+        /// @param nThreads Number of threads reading the images
+        void extractBeams(const std::vector<std::string>& imageList, size_t nThreads = 1);
+
+        /// @brief Extract the beam information distributing the images between ranks
+        /// @details Every rank (including the master) reads every nProcs-th image
+        /// of the list, starting from its rank number. The beams are then gathered
+        /// onto the nominated rank (see gather), so all ranks have to call this method.
+        /// Channels with zero-sized beams are not gathered.
+        /// @param comms Communicator
+        /// @param imageList A vector list of image names in the channel order
+        /// @param rankToGather Rank receiving the beam information of all channels
+        /// @param nThreads Number of threads reading the images on each rank
+        void extractBeams(askapparallel::AskapParallel &comms, const std::vector<std::string>& imageList,
+                          int rankToGather, size_t nThreads = 1);
 
         /// @brief Write the beam information to the beam log
         /// @details The beam information for each channel is written
@@ -96,6 +113,8 @@ class BeamLogger {
         /// the channel and beam information to the nominated
         /// rank. The beamlists are aggregated on that rank ready for
         /// writing, ignoring any channels that have zero-sized beams.
+        /// The lists are packed into fixed-size records and gathered with
+        /// a single collective call, so all ranks have to call this method.
         void gather(askapparallel::AskapParallel &comms, int rankToGather, bool includeMaster);
 
 
@@ -112,6 +131,14 @@ class BeamLogger {
         casacore::Vector<casacore::Quantum<double> > beam(const unsigned int channel);
 
     protected:
+        /// @brief Extract the beam information for the given channels
+        /// @details The beams of the channels are added to the beam list.
+        /// @param imageList A vector list of image names in the channel order
+        /// @param channels Channels to extract
+        /// @param nThreads Number of threads reading the images
+        void extractBeams(const std::vector<std::string>& imageList, const std::vector<unsigned int> &channels,
+                          size_t nThreads);
+
         /// @brief The disk file to be read from / written to
         std::string itsFilename;
 
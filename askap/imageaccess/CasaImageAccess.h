@@ -33,16 +33,98 @@
 
 #include <askap/imageaccess/IImageAccess.h>
 
+#include <casacore/images/Images/PagedImage.h>
+#include <casacore/tables/Tables/TableLock.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <string>
+
 namespace askap {
 namespace accessors {
 
 /// @brief Access casa image
-/// @details This class implements IImageAccess interface for CASA image
+/// @details This class implements IImageAccess interface for CASA image.
+/// The images are kept open between the calls (up to the given number of images),
+/// so writing an image plane by plane doesn't reopen the table and rebuild the
+/// coordinate system each time. The changes are written to disk by flush or when
+/// the image is closed (explicitly, when the cache is full or in the destructor).
 /// @ingroup imageaccess
 
 template <class T = casacore::Float>
 struct CasaImageAccess : public IImageAccess<T> {
 
+    /// @brief expected access pattern used to choose the tile shape of new images
+    enum AccessPattern {
+        /// @brief casacore's default tiling, roughly equal tile length along all axes
+        BALANCED,
+        /// @brief whole (or large parts of) spatial planes, e.g. writing spectral planes
+        PLANE_MAJOR,
+        /// @brief spectra of individual pixels, e.g. spectrum extraction
+        SPECTRUM_MAJOR
+    };
+
+    /// @brief constructor
+    /// @param[in] lockOption table locking used to open the images. With UserLocking the
+    /// locks are acquired on the first access and held until flush or close is called.
+    /// @param[in] maxOpenImages maximum number of images kept open at the same time
+    explicit CasaImageAccess(casacore::TableLock::LockOption lockOption = casacore::TableLock::AutoLocking,
+                             size_t maxOpenImages = 8);
+
+    /// @brief destructor, closes all images
+    virtual ~CasaImageAccess();
+
+    /// @brief write all changes to disk
+    /// @details The images stay open, but the locks acquired with UserLocking are released.
+    void flush() const;
+
+    /// @brief close the given image
+    /// @details Nothing is done if the image is not open.
+    /// @param[in] name image name
+    void close(const std::string &name);
+
+    /// @brief close all images
+    void close();
+
+    /// @return table locking used to open the images
+    inline casacore::TableLock::LockOption lockOption() const { return itsLockOption; }
+
+    /// @brief set the tile shape for new images
+    /// @details The given tile shape takes precedence over the access pattern. An empty
+    /// shape means that the tile shape is derived from the access pattern.
+    /// @param[in] tileShape tile shape (same dimensionality as the images created)
+    void setTileShape(const casacore::IPosition &tileShape);
+
+    /// @brief set the expected access pattern for new images
+    /// @param[in] pattern access pattern used to choose the tile shape
+    void setAccessPattern(AccessPattern pattern);
+
+    /// @brief set the maximum size of the tile cache
+    /// @details It applies to all images opened afterwards. A larger cache helps when
+    /// the access pattern doesn't match the tiling (e.g. spectra from plane tiled cubes).
+    /// @param[in] nPixels maximum number of pixels in the cache, 0 means casacore's default
+    void setMaximumCacheSize(casacore::uInt nPixels);
+
+    /// @brief use fast allocation of new images
+    /// @details The file holding the tiles of a new image is preallocated to its full size
+    /// with posix_fallocate (or extended as a sparse file if the file system doesn't support
+    /// it), so no pixels are written until the image is filled. This mirrors
+    /// FitsImageAccess::useFastAlloc.
+    /// @param[in] fast If true use fast allocation, default lets casacore extend the file
+    inline void useFastAlloc(bool fast = false) { itsFastAlloc = fast;}
+
+    /// @brief tile shape for a new image
+    /// @param[in] shape shape of the image
+    /// @param[in] csys coordinate system of the image (used to find the spectral axis)
+    /// @return tiled shape to create the image with
+    casacore::TiledShape tiledShape(const casacore::IPosition &shape, const casacore::CoordinateSystem &csys) const;
+
+    /// @brief tile shape of an existing image
+    /// @param[in] name image name
+    /// @return shape of the tiles the image is stored in
+    casacore::IPosition tileShape(const std::string &name) const;
+
     //////////////////
     // Reading methods
     //////////////////
@@ -65,6 +147,27 @@ struct CasaImageAccess : public IImageAccess<T> {
     virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
                                     const casacore::IPosition &trc) const override;
 
+    /// @brief read every stride-th pixel of part of the image
+    /// @details The strided slicer is passed to the lattice, so only the tiles holding
+    /// the pixels returned are read. Unmasked pixels are set to zero as in read.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[in] stride increment along each axis (1 to take all pixels)
+    /// @return array with (trc - blc) / stride + 1 pixels along each axis
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc, const casacore::IPosition &stride) const override;
+
+    /// @brief read part of the image into the given buffer
+    /// @details The buffer is only resized if its shape doesn't match the selection.
+    /// Unmasked pixels are set to zero as in read.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with pixels for the selection
+    virtual void readInto(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<T> &buffer) const override;
+
     /// @brief Determine whether an image has a mask
     /// @param[in] nam image name
     /// @return True if image has a mask, False if not.
@@ -83,6 +186,15 @@ struct CasaImageAccess : public IImageAccess<T> {
     virtual casacore::LogicalArray readMask(const std::string &name, const casacore::IPosition &blc,
                                     const casacore::IPosition &trc) const override;
 
+    /// @brief read the mask for part of the image into the given buffer
+    /// @details The buffer is only resized if its shape doesn't match the selection.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with mask values - 1=good, 0=bad
+    virtual void readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                              const casacore::IPosition &trc, casacore::LogicalArray &buffer) const override;
+
     /// @brief obtain coordinate system info
     /// @param[in] name image name
     /// @return coordinate system object
@@ -123,6 +235,15 @@ struct CasaImageAccess : public IImageAccess<T> {
     /// @return pair of strings - keyword value and comment
     virtual std::pair<std::string, std::string> getMetadataKeyword(const std::string &name, const std::string &keyword) const override;
 
+    /// @brief obtain a snapshot of the image metadata
+    /// @details The snapshot is cached until the image is written to through this accessor or
+    /// closed, the shape, units, beams, keywords and mask presence getters are served from it.
+    /// The keywords are the scalar string, boolean and numeric fields of miscInfo. Changes done
+    /// by other processes are picked up after close.
+    /// @param[in] name image name
+    /// @return shared pointer to the snapshot
+    virtual boost::shared_ptr<const ImageMetadata> metadata(const std::string &name) const override;
+
     //////////////////
     // Writing methods
     //////////////////
@@ -234,6 +355,91 @@ struct CasaImageAccess : public IImageAccess<T> {
     /// @param[in] name image name
     /// @param[in] info record with information
     virtual void setInfo(const std::string &name, const casacore::RecordInterface & info) override;
+
+protected:
+    /// @brief drop the pixels cached for the given image
+    /// @details The open image is resynchronised with the table on disk.
+    /// @param[in] name image name
+    virtual void refreshPixels(const std::string &name) const override;
+
+    /// @brief write the pixels buffered for the given image to disk
+    /// @details With UserLocking the lock of the image is released as well.
+    /// @param[in] name image name
+    virtual void syncPixels(const std::string &name) const override;
+
+    /// @brief create a new image with the given tiling
+    /// @details This is the implementation of create, the tile shape is used as given.
+    /// @param[in] name image name
+    /// @param[in] tiled shape and tile shape of the image
+    /// @param[in] csys coordinate system of the full image
+    /// @param[in] preallocate true to preallocate the tile storage (see useFastAlloc)
+    void createTiled(const std::string &name, const casacore::TiledShape &tiled,
+                     const casacore::CoordinateSystem &csys, bool preallocate);
+
+private:
+    /// @brief cache entry
+    struct CachedImage {
+        /// @brief open image
+        boost::shared_ptr<casacore::PagedImage<T> > itsImage;
+        /// @brief value of the use counter when the image was last accessed
+        size_t itsLastUse;
+    };
+
+    /// @brief obtain an open image
+    /// @details The image is opened and put into the cache if necessary. With UserLocking,
+    /// the lock of the required type is acquired and held until flush or close.
+    /// @param[in] name image name
+    /// @param[in] write true, if the image is going to be modified
+    /// @return reference to the image (valid until the image is closed)
+    casacore::PagedImage<T>& image(const std::string &name, bool write) const;
+
+    /// @brief set unmasked pixels to zero in place
+    /// @param[in,out] buffer pixels
+    /// @param[in] mask mask of the same shape (true for good pixels)
+    static void applyMask(casacore::Array<T> &buffer, const casacore::LogicalArray &mask);
+
+    /// @brief add an image to the cache
+    /// @details The least recently used image is closed if the cache is full.
+    /// @param[in] name image name
+    /// @param[in] img shared pointer to the open image
+    void cacheImage(const std::string &name, const boost::shared_ptr<casacore::PagedImage<T> > &img) const;
+
+    /// @brief preallocate the tile storage of a new image
+    /// @details The image should be flushed, so the storage manager file exists. Failures
+    /// are not fatal, casacore extends the file as the tiles are written anyway.
+    /// @param[in] name image name
+    /// @param[in] tiled shape and tile shape of the image
+    static void preallocate(const std::string &name, const casacore::TiledShape &tiled);
+
+    /// @brief table locking used to open the images
+    casacore::TableLock::LockOption itsLockOption;
+
+    /// @brief maximum number of images kept open
+    size_t itsMaxOpenImages;
+
+    /// @brief open images
+    mutable std::map<std::string, CachedImage> itsImages;
+
+    /// @brief counter incremented on every access, used to find the least recently used image
+    mutable size_t itsUseCounter;
+
+    /// @brief tile shape for new images, empty to use the access pattern
+    casacore::IPosition itsTileShape;
+
+    /// @brief expected access pattern for new images
+    AccessPattern itsAccessPattern;
+
+    /// @brief maximum number of pixels in the tile cache, 0 for casacore's default
+    casacore::uInt itsMaxCacheSize;
+
+    /// @brief true, if the tile storage of new images is preallocated
+    bool itsFastAlloc;
+
+    /// @brief metadata snapshots by image name
+    mutable std::map<std::string, boost::shared_ptr<const ImageMetadata> > itsMetadata;
+
+    /// @brief mask of the last selection read, reused to avoid allocations
+    mutable casacore::LogicalArray itsMaskBuffer;
 };
 
 
@@ -32,16 +32,259 @@
 #include <askap/imageaccess/CasaImageAccess.h>
 
 #include <askap/askap/AskapLogging.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/dataaccess/IORecorder.h>
+#include <askap/dataaccess/LogRateLimiter.h>
 #include <casacore/images/Images/PagedImage.h>
-#include <casacore/images/Images/SubImage.h>
 #include <casacore/images/Regions/ImageRegion.h>
 #include <casacore/images/Regions/RegionHandler.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+
+#include <cmath>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 ASKAP_LOGGER(casaImAccessLogger, ".casaImageAccessor");
 
 using namespace askap;
 using namespace askap::accessors;
 
+/// @brief constructor
+/// @param[in] lockOption table locking used to open the images. With UserLocking the
+/// locks are acquired on the first access and held until flush or close is called.
+/// @param[in] maxOpenImages maximum number of images kept open at the same time
+template <class T>
+CasaImageAccess<T>::CasaImageAccess(casacore::TableLock::LockOption lockOption, size_t maxOpenImages) :
+    itsLockOption(lockOption), itsMaxOpenImages(maxOpenImages), itsUseCounter(0),
+    itsAccessPattern(BALANCED), itsMaxCacheSize(0), itsFastAlloc(false)
+{
+    ASKAPCHECK(itsMaxOpenImages > 0, "CasaImageAccess should be able to keep at least one image open");
+}
+
+/// @brief set the tile shape for new images
+/// @details The given tile shape takes precedence over the access pattern. An empty
+/// shape means that the tile shape is derived from the access pattern.
+/// @param[in] tileShape tile shape (same dimensionality as the images created)
+template <class T>
+void CasaImageAccess<T>::setTileShape(const casacore::IPosition &tileShape)
+{
+    for (casacore::uInt dim = 0; dim < tileShape.nelements(); ++dim) {
+         ASKAPCHECK(tileShape(dim) > 0, "Tile shape " << tileShape << " should be positive along all axes");
+    }
+    itsTileShape.resize(tileShape.nelements());
+    itsTileShape = tileShape;
+}
+
+/// @brief set the expected access pattern for new images
+/// @param[in] pattern access pattern used to choose the tile shape
+template <class T>
+void CasaImageAccess<T>::setAccessPattern(AccessPattern pattern)
+{
+    itsAccessPattern = pattern;
+}
+
+/// @brief set the maximum size of the tile cache
+/// @details It applies to all images opened afterwards. A larger cache helps when
+/// the access pattern doesn't match the tiling (e.g. spectra from plane tiled cubes).
+/// @param[in] nPixels maximum number of pixels in the cache, 0 means casacore's default
+template <class T>
+void CasaImageAccess<T>::setMaximumCacheSize(casacore::uInt nPixels)
+{
+    itsMaxCacheSize = nPixels;
+}
+
+/// @brief tile shape for a new image
+/// @param[in] shape shape of the image
+/// @param[in] csys coordinate system of the image (used to find the spectral axis)
+/// @return tiled shape to create the image with
+template <class T>
+casacore::TiledShape CasaImageAccess<T>::tiledShape(const casacore::IPosition &shape,
+                                                    const casacore::CoordinateSystem &csys) const
+{
+    if (itsTileShape.nelements() > 0) {
+        ASKAPCHECK(itsTileShape.nelements() == shape.nelements(), "Tile shape " << itsTileShape <<
+                   " doesn't match the image shape " << shape);
+        return casacore::TiledShape(shape, casacore::min(itsTileShape, shape));
+    }
+    if ((itsAccessPattern == BALANCED) || (shape.nelements() < 2)) {
+        return casacore::TiledShape(shape);
+    }
+    // the first two axes are spatial, the spectral axis is the last one unless given by csys
+    int specAxis = shape.nelements() - 1;
+    const int specCoord = csys.findCoordinate(casacore::Coordinate::SPECTRAL);
+    if ((specCoord >= 0) && (csys.pixelAxes(specCoord).nelements() == 1) && (csys.pixelAxes(specCoord)[0] >= 0)) {
+        specAxis = csys.pixelAxes(specCoord)[0];
+    }
+    // tiles of about 32k pixels like the casacore's default
+    const casacore::Int64 tileSize = 32768;
+    casacore::IPosition tile(shape.nelements(), 1);
+    if (itsAccessPattern == PLANE_MAJOR) {
+        // one plane per tile as long as it fits, otherwise square parts of the plane
+        const casacore::Int64 side = static_cast<casacore::Int64>(std::sqrt(static_cast<double>(tileSize)));
+        for (casacore::uInt dim = 0; dim < 2; ++dim) {
+             tile(dim) = shape(0) * shape(1) <= tileSize ? shape(dim) : std::min(shape(dim), side);
+        }
+    } else {
+        // the whole spectrum in a tile, spatial pixels are added to reach the tile size
+        ASKAPDEBUGASSERT(itsAccessPattern == SPECTRUM_MAJOR);
+        tile(specAxis) = std::min(shape(specAxis), tileSize);
+        const casacore::Int64 side = std::max(casacore::Int64(1), static_cast<casacore::Int64>(
+                                     std::sqrt(static_cast<double>(tileSize / tile(specAxis)))));
+        for (casacore::uInt dim = 0; dim < 2; ++dim) {
+             if (static_cast<int>(dim) != specAxis) {
+                 tile(dim) = std::min(shape(dim), side);
+             }
+        }
+    }
+    return casacore::TiledShape(shape, tile);
+}
+
+/// @brief destructor, closes all images
+template <class T>
+CasaImageAccess<T>::~CasaImageAccess()
+{
+    close();
+}
+
+/// @brief write all changes to disk
+/// @details The images stay open, but the locks acquired with UserLocking are released.
+template <class T>
+void CasaImageAccess<T>::flush() const
+{
+    for (typename std::map<std::string, CachedImage>::const_iterator ci = itsImages.begin();
+         ci != itsImages.end(); ++ci) {
+         ASKAPDEBUGASSERT(ci->second.itsImage);
+         if (itsLockOption == casacore::TableLock::UserLocking) {
+             // unlock flushes the image as well
+             ci->second.itsImage->unlock();
+         } else {
+             ci->second.itsImage->flush();
+         }
+    }
+}
+
+/// @brief drop the pixels cached for the given image
+/// @details The open image is resynchronised with the table on disk.
+/// @param[in] name image name
+template <class T>
+void CasaImageAccess<T>::refreshPixels(const std::string &name) const
+{
+    const typename std::map<std::string, CachedImage>::const_iterator ci = itsImages.find(name);
+    if (ci != itsImages.end()) {
+        ASKAPDEBUGASSERT(ci->second.itsImage);
+        ci->second.itsImage->resync();
+    }
+}
+
+/// @brief write the pixels buffered for the given image to disk
+/// @details With UserLocking the lock of the image is released as well.
+/// @param[in] name image name
+template <class T>
+void CasaImageAccess<T>::syncPixels(const std::string &name) const
+{
+    const typename std::map<std::string, CachedImage>::const_iterator ci = itsImages.find(name);
+    if (ci != itsImages.end()) {
+        ASKAPDEBUGASSERT(ci->second.itsImage);
+        if (itsLockOption == casacore::TableLock::UserLocking) {
+            ci->second.itsImage->unlock();
+        } else {
+            ci->second.itsImage->flush();
+        }
+    }
+}
+
+/// @brief close the given image
+/// @details Nothing is done if the image is not open.
+/// @param[in] name image name
+template <class T>
+void CasaImageAccess<T>::close(const std::string &name)
+{
+    itsImages.erase(name);
+    itsMetadata.erase(name);
+}
+
+/// @brief close all images
+template <class T>
+void CasaImageAccess<T>::close()
+{
+    itsImages.clear();
+    itsMetadata.clear();
+}
+
+/// @brief obtain an open image
+/// @details The image is opened and put into the cache if necessary. With UserLocking,
+/// the lock of the required type is acquired and held until flush or close.
+/// @param[in] name image name
+/// @param[in] write true, if the image is going to be modified
+/// @return reference to the image (valid until the image is closed)
+template <class T>
+casacore::PagedImage<T>& CasaImageAccess<T>::image(const std::string &name, bool write) const
+{
+    typename std::map<std::string, CachedImage>::iterator it = itsImages.find(name);
+    if (it == itsImages.end()) {
+        boost::shared_ptr<casacore::PagedImage<T> > img(new casacore::PagedImage<T>(name,
+                                                        casacore::TableLock(itsLockOption)));
+        if (itsMaxCacheSize > 0) {
+            img->setMaximumCacheSize(itsMaxCacheSize);
+        }
+        cacheImage(name, img);
+        it = itsImages.find(name);
+        ASKAPDEBUGASSERT(it != itsImages.end());
+    }
+    it->second.itsLastUse = ++itsUseCounter;
+    if (write) {
+        // the snapshot may become out of date
+        itsMetadata.erase(name);
+    }
+    casacore::PagedImage<T> &img = *(it->second.itsImage);
+    if (itsLockOption == casacore::TableLock::UserLocking) {
+        const casacore::FileLocker::LockType type = write ? casacore::FileLocker::Write : casacore::FileLocker::Read;
+        if (!img.hasLock(type)) {
+            ASKAPCHECK(img.lock(type, 1), "Unable to lock CASA image " << name);
+        }
+    }
+    return img;
+}
+
+/// @brief add an image to the cache
+/// @details The least recently used image is closed if the cache is full.
+/// @param[in] name image name
+/// @param[in] img shared pointer to the open image
+template <class T>
+void CasaImageAccess<T>::cacheImage(const std::string &name, const boost::shared_ptr<casacore::PagedImage<T> > &img) const
+{
+    ASKAPDEBUGASSERT(img);
+    itsImages.erase(name);
+    while (itsImages.size() >= itsMaxOpenImages) {
+        typename std::map<std::string, CachedImage>::iterator oldest = itsImages.begin();
+        for (typename std::map<std::string, CachedImage>::iterator it = itsImages.begin(); it != itsImages.end(); ++it) {
+             if (it->second.itsLastUse < oldest->second.itsLastUse) {
+                 oldest = it;
+             }
+        }
+        ASKAPLOG_DEBUG_STR(casaImAccessLogger, "Closing CASA image " << oldest->first << " to free the cache slot");
+        itsImages.erase(oldest);
+    }
+    CachedImage &entry = itsImages[name];
+    entry.itsImage = img;
+    entry.itsLastUse = ++itsUseCounter;
+}
+
+/// @brief tile shape of an existing image
+/// @param[in] name image name
+/// @return shape of the tiles the image is stored in
+template <class T>
+casacore::IPosition CasaImageAccess<T>::tileShape(const std::string &name) const
+{
+    return image(name, false).niceCursorShape();
+}
+
 // reading methods
 
 /// @brief obtain the shape
@@ -50,8 +293,7 @@ using namespace askap::accessors;
 template <class T>
 casacore::IPosition CasaImageAccess<T>::shape(const std::string &name) const
 {
-    casacore::PagedImage<T> img(name);
-    return img.shape();
+    return metadata(name)->itsShape;
 }
 
 /// @brief read full image
@@ -61,29 +303,10 @@ template <class T>
 casacore::Array<T> CasaImageAccess<T>::read(const std::string &name) const
 {
     ASKAPLOG_INFO_STR(casaImAccessLogger, "Reading CASA image " << name);
-    casacore::PagedImage<T> img(name);
-    if (img.hasPixelMask()) {
-        ASKAPLOG_INFO_STR(casaImAccessLogger, " - setting unmasked pixels to zero");
-        // generate an Array of zeros and copy the elements for which the mask is true
-        casacore::Array<T> tempArray(img.get().shape(), static_cast<T>(0.0));
-        tempArray = casacore::MaskedArray<T>(img.get(), img.getMask(), casacore::True);
-        return tempArray;
-        // The following seems to avoid a copy but takes longer:
-        //// Iterate over image array and set any unmasked pixels to zero
-        //casacore::Array<float> tempArray = img.get();
-        //const casacore::LogicalArray tempMask = img.getMask();
-        //casacore::Array<float>::iterator iterArray = tempArray.begin();
-        //casacore::LogicalArray::const_iterator iterMask = tempMask.begin();
-        //for( ; iterArray != tempArray.end() ; iterArray++ ) {
-        //    if (*iterMask == casacore::False) {
-        //        *iterArray = 0.0;
-        //    }
-        //    iterMask++;
-        //}
-        //return tempArray;
-    } else {
-        return img.get();
-    }
+    const casacore::IPosition shape = image(name, false).shape();
+    casacore::Array<T> result;
+    readInto(name, casacore::IPosition(shape.nelements(), 0), shape - 1, result);
+    return result;
 }
 
 /// @brief read part of the image
@@ -95,31 +318,95 @@ template <class T>
 casacore::Array<T> CasaImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
         const casacore::IPosition &trc) const
 {
-    ASKAPLOG_INFO_STR(casaImAccessLogger, "Reading a slice of the CASA image " << name << " from " << blc << " to " << trc);
-    casacore::PagedImage<T> img(name);
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, "Reading a slice of the CASA image " << name << " from " << blc << " to " << trc);
+    casacore::Array<T> result;
+    readInto(name, blc, trc, result);
+    return result;
+}
+
+/// @brief read every stride-th pixel of part of the image
+/// @details Unmasked pixels are set to zero as in read.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[in] stride increment along each axis (1 to take all pixels)
+/// @return array with (trc - blc) / stride + 1 pixels along each axis
+template <class T>
+casacore::Array<T> CasaImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, const casacore::IPosition &stride) const
+{
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, "Reading a slice of the CASA image " << name << " from " << blc << " to " <<
+                        trc << " with the stride " << stride);
+    ASKAPCHECK(casacore::allGT(stride, 0), "Stride should be positive, you have " << stride);
+    DataAccessStatistics::ScopedTimer timer("CasaImageAccess::read");
+    casacore::PagedImage<T> &img = image(name, false);
+    const casacore::Slicer slicer(blc, trc, stride, casacore::Slicer::endIsLast);
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_READ);
+    ioEvent.setRegion(name, "casa", blc, slicer.length());
+    casacore::Array<T> result = img.getSlice(slicer);
     if (img.hasPixelMask()) {
-        ASKAPLOG_INFO_STR(casaImAccessLogger, " - setting unmasked pixels to zero");
-        // generate an Array of zeros and copy the elements for which the mask is true
-        const casacore::Slicer slicer(blc, trc, casacore::Slicer::endIsLast);
-        casacore::Array<T> tempSlice(img.getSlice(slicer).shape(), static_cast<T>(0.0));
-        tempSlice = casacore::MaskedArray<T>(img.getSlice(slicer), img.getMaskSlice(slicer), casacore::True);
-        return tempSlice;
-        // The following seems to avoid a copy but takes longer:
-        //// Iterate over image array and set any unmasked pixels to zero
-        //const casacore::Slicer slicer(blc,trc,casacore::Slicer::endIsLast);
-        //casacore::Array<float> tempSlice = img.getSlice(slicer);
-        //const casacore::LogicalArray tempMask = img.getMaskSlice(slicer);
-        //casacore::Array<float>::iterator iterSlice = tempSlice.begin();
-        //casacore::LogicalArray::const_iterator iterMask = tempMask.begin();
-        //for( ; iterSlice != tempSlice.end() ; iterSlice++ ) {
-        //    if (*iterMask == casacore::False) {
-        //        *iterSlice = 0.0;
-        //    }
-        //    iterMask++;
-        //}
-        //return tempSlice;
+        applyMask(result, img.getMaskSlice(slicer));
+    }
+    timer.addBytes(result.nelements() * sizeof(T));
+    ioEvent.addBytes(result.nelements() * sizeof(T));
+    return result;
+}
+
+/// @brief read part of the image into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// Unmasked pixels are set to zero as in read.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with pixels for the selection
+template <class T>
+void CasaImageAccess<T>::readInto(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, casacore::Array<T> &buffer) const
+{
+    DataAccessStatistics::ScopedTimer timer("CasaImageAccess::read");
+    casacore::PagedImage<T> &img = image(name, false);
+    const casacore::Slicer slicer(blc, trc, casacore::Slicer::endIsLast);
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_READ);
+    ioEvent.setRegion(name, "casa", blc, slicer.length());
+    this->resizeBuffer(buffer, slicer.length());
+    // the lattice reads straight into the buffer if the shape matches
+    img.getSlice(buffer, slicer);
+    if (img.hasPixelMask()) {
+        // unmasked pixels are set to zero in place, the mask buffer is reused between calls
+        if (!itsMaskBuffer.shape().isEqual(slicer.length())) {
+            itsMaskBuffer.resize(slicer.length());
+        }
+        img.getMaskSlice(itsMaskBuffer, slicer);
+        applyMask(buffer, itsMaskBuffer);
+    }
+    timer.addBytes(buffer.nelements() * sizeof(T));
+    ioEvent.addBytes(buffer.nelements() * sizeof(T));
+}
+
+/// @brief set unmasked pixels to zero in place
+/// @details Both arrays are normally contiguous, then the loop runs over the raw
+/// storage without branches, so the compiler can vectorise it.
+/// @param[in,out] buffer pixels
+/// @param[in] mask mask of the same shape (true for good pixels)
+template <class T>
+void CasaImageAccess<T>::applyMask(casacore::Array<T> &buffer, const casacore::LogicalArray &mask)
+{
+    ASKAPDEBUGASSERT(buffer.shape().isEqual(mask.shape()));
+    if (buffer.contiguousStorage() && mask.contiguousStorage()) {
+        T* const data = buffer.data();
+        const casacore::Bool* const good = mask.data();
+        const size_t n = buffer.nelements();
+        for (size_t i = 0; i < n; ++i) {
+             data[i] = good[i] ? data[i] : static_cast<T>(0.0);
+        }
     } else {
-        return img.getSlice(casacore::Slicer(blc, trc, casacore::Slicer::endIsLast));
+        typename casacore::Array<T>::iterator iterBuffer = buffer.begin();
+        for (casacore::LogicalArray::const_iterator iterMask = mask.begin(); iterMask != mask.end();
+             ++iterMask, ++iterBuffer) {
+             if (!*iterMask) {
+                 *iterBuffer = static_cast<T>(0.0);
+             }
+        }
     }
 }
 
@@ -129,10 +416,7 @@ casacore::Array<T> CasaImageAccess<T>::read(const std::string &name, const casac
 template <class T>
 bool CasaImageAccess<T>::isMasked(const std::string &name) const
 {
-
-    casacore::PagedImage<T> img(name);
-    return img.hasPixelMask();
-
+    return metadata(name)->itsMasked;
 }
 
 /// @brief read the mask for the full image
@@ -142,7 +426,7 @@ template <class T>
 casacore::LogicalArray CasaImageAccess<T>::readMask(const std::string &name) const
 {
 
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, false);
     if (img.hasPixelMask()) {
         return img.getMask();
     } else {
@@ -161,7 +445,7 @@ template <class T>
 casacore::LogicalArray CasaImageAccess<T>::readMask(const std::string &name, const casacore::IPosition &blc,
                                                     const casacore::IPosition &trc) const
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, false);
     const casacore::Slicer slicer(blc, trc, casacore::Slicer::endIsLast);
     if (img.hasPixelMask()) {
         return img.getMaskSlice(slicer);
@@ -172,26 +456,53 @@ casacore::LogicalArray CasaImageAccess<T>::readMask(const std::string &name, con
 
 }
 
+/// @brief read the mask for part of the image into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with mask values - 1=good, 0=bad
+template <class T>
+void CasaImageAccess<T>::readMaskInto(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, casacore::LogicalArray &buffer) const
+{
+    casacore::PagedImage<T> &img = image(name, false);
+    const casacore::Slicer slicer(blc, trc, casacore::Slicer::endIsLast);
+    if (!buffer.shape().isEqual(slicer.length())) {
+        buffer.resize(slicer.length());
+    }
+    if (img.hasPixelMask()) {
+        img.getMaskSlice(buffer, slicer);
+    } else {
+        buffer = true;
+    }
+}
+
 /// @brief obtain coordinate system info
+/// @details The coordinates are taken from the cached open image.
 /// @param[in] name image name
 /// @return coordinate system object
 template <class T>
 casacore::CoordinateSystem CasaImageAccess<T>::coordSys(const std::string &name) const
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, false);
     return img.coordinates();
 }
+
+/// @brief obtain coordinate system info for part of an image
+/// @details The coordinates are derived from those of the cached open image by shifting
+/// the reference pixel, the subimage is not set up.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return coordinate system object
 template <class T>
 casacore::CoordinateSystem CasaImageAccess<T>::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
         const casacore::IPosition &trc) const
 {
-    casacore::Slicer slc(blc, trc, casacore::Slicer::endIsLast);
-    ASKAPLOG_INFO_STR(casaImAccessLogger, " CasaImageAccess - Slicer " << slc);
-    casacore::PagedImage<T> img(name);
-    casacore::SubImage<T> si = casacore::SubImage<T>(img, slc, casacore::AxesSpecifier(casacore::True));
-    return si.coordinates();
-
-
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, " CasaImageAccess - coordinates of the slice from " << blc << " to " << trc);
+    const casacore::PagedImage<T> &img = image(name, false);
+    return this->sliceCoordSys(img.coordinates(), img.shape(), blc, trc);
 }
 /// @brief obtain beam info
 /// @param[in] name image name
@@ -199,13 +510,7 @@ casacore::CoordinateSystem CasaImageAccess<T>::coordSysSlice(const std::string &
 template <class T>
 casacore::Vector<casacore::Quantum<double> > CasaImageAccess<T>::beamInfo(const std::string &name) const
 {
-    casacore::PagedImage<T> img(name);
-    casacore::ImageInfo ii = img.imageInfo();
-    if (!img.imageInfo().hasMultipleBeams()) {
-      return ii.restoringBeam().toVector();
-    } else {
-      return casacore::Vector<casacore::Quantum<double>>();
-    }
+    return metadata(name)->itsBeam;
 }
 
 /// @brief get restoring beam info
@@ -214,24 +519,13 @@ casacore::Vector<casacore::Quantum<double> > CasaImageAccess<T>::beamInfo(const
 template <class T>
 BeamList CasaImageAccess<T>::beamList(const std::string &name) const
 {
-    casacore::PagedImage<T> img(name);
-    casacore::ImageInfo ii = img.imageInfo();
-    BeamList bl;
-    if (img.imageInfo().hasMultipleBeams()) {
-      for (int chan = 0; chan < ii.nChannels(); chan++) {
-        casacore::GaussianBeam gb = ii.restoringBeam(chan,0);
-        bl[chan] = gb.toVector();
-      }
-    }
-    return bl;
+    return metadata(name)->itsBeamList;
 }
 
 template <class T>
 std::string CasaImageAccess<T>::getUnits(const std::string &name) const
 {
-    casacore::Table tmpTable(name);
-    std::string units = tmpTable.keywordSet().asString("units");
-    return units;
+    return metadata(name)->itsUnits;
 }
 
 /// @brief Get a particular keyword from the image metadata (A.K.A header)
@@ -242,19 +536,65 @@ std::string CasaImageAccess<T>::getUnits(const std::string &name) const
 template <class T>
 std::pair<std::string, std::string> CasaImageAccess<T>::getMetadataKeyword(const std::string &name, const std::string &keyword) const
 {
-
-    casacore::PagedImage<T> img(name);
-    casacore::TableRecord miscinfo = img.miscInfo();
-    std::string value = "";
-    std::string comment = "";
-    if (miscinfo.isDefined(keyword)) {
-        value = miscinfo.asString(keyword);
-        comment = miscinfo.comment(keyword);
-    } else {
+    const boost::shared_ptr<const ImageMetadata> md = metadata(name);
+    if (md->itsKeywords.find(keyword) == md->itsKeywords.end()) {
         ASKAPLOG_DEBUG_STR(casaImAccessLogger, "Keyword " << keyword << " is not defined in metadata for image " << name);
     }
-    return std::pair<std::string,std::string>(value,comment);
+    return md->keyword(keyword);
+}
 
+/// @brief obtain a snapshot of the image metadata
+/// @details The snapshot is cached until the image is written to through this accessor or closed.
+/// @param[in] name image name
+/// @return shared pointer to the snapshot
+template <class T>
+boost::shared_ptr<const ImageMetadata> CasaImageAccess<T>::metadata(const std::string &name) const
+{
+    const typename std::map<std::string, boost::shared_ptr<const ImageMetadata> >::const_iterator ci =
+          itsMetadata.find(name);
+    if (ci != itsMetadata.end()) {
+        return ci->second;
+    }
+    const casacore::PagedImage<T> &img = image(name, false);
+    boost::shared_ptr<ImageMetadata> result(new ImageMetadata);
+    result->itsShape = img.shape();
+    result->itsCoordSys = img.coordinates();
+    result->itsUnits = img.units().getName();
+    result->itsMasked = img.hasPixelMask();
+    const casacore::ImageInfo ii = img.imageInfo();
+    if (ii.hasMultipleBeams()) {
+        for (int chan = 0; chan < ii.nChannels(); chan++) {
+             result->itsBeamList[chan] = ii.restoringBeam(chan,0).toVector();
+        }
+    } else {
+        result->itsBeam = ii.restoringBeam().toVector();
+    }
+    const casacore::TableRecord miscinfo = img.miscInfo();
+    for (casacore::uInt field = 0; field < miscinfo.nfields(); ++field) {
+         std::ostringstream os;
+         switch (miscinfo.type(field)) {
+             case casacore::TpString:
+                 os << miscinfo.asString(field);
+                 break;
+             case casacore::TpBool:
+                 os << (miscinfo.asBool(field) ? "T" : "F");
+                 break;
+             case casacore::TpInt:
+                 os << miscinfo.asInt(field);
+                 break;
+             case casacore::TpFloat:
+             case casacore::TpDouble:
+                 os << std::setprecision(15) << miscinfo.asDouble(field);
+                 break;
+             default:
+                 // arrays and sub-records (e.g. the info tables) are not keywords
+                 continue;
+         }
+         result->itsKeywords[miscinfo.name(field)] = std::pair<std::string, std::string>(os.str(),
+                                                      miscinfo.comment(field));
+    }
+    itsMetadata[name] = result;
+    return result;
 }
 
 
@@ -272,7 +612,70 @@ void CasaImageAccess<T>::create(const std::string &name, const casacore::IPositi
                              const casacore::CoordinateSystem &csys)
 {
     ASKAPLOG_INFO_STR(casaImAccessLogger, "Creating a new CASA image " << name << " with the shape " << shape);
-    casacore::PagedImage<T> img(casacore::TiledShape(shape), csys, name);
+    createTiled(name, tiledShape(shape, csys), csys, itsFastAlloc);
+}
+
+/// @brief create a new image with the given tiling
+/// @details This is the implementation of create, the tile shape is used as given.
+/// @param[in] name image name
+/// @param[in] tiled shape and tile shape of the image
+/// @param[in] csys coordinate system of the full image
+/// @param[in] preallocate true to preallocate the tile storage (see useFastAlloc)
+template <class T>
+void CasaImageAccess<T>::createTiled(const std::string &name, const casacore::TiledShape &tiled,
+                                     const casacore::CoordinateSystem &csys, bool preallocate)
+{
+    // the old image (if any) has to be closed before it is replaced
+    close(name);
+    ASKAPLOG_INFO_STR(casaImAccessLogger, " - tile shape " << tiled.tileShape());
+    boost::shared_ptr<casacore::PagedImage<T> > img(new casacore::PagedImage<T>(tiled, csys, name,
+                                                    casacore::TableLock(itsLockOption)));
+    if (itsMaxCacheSize > 0) {
+        img->setMaximumCacheSize(itsMaxCacheSize);
+    }
+    if (preallocate) {
+        img->flush();
+        CasaImageAccess<T>::preallocate(name, tiled);
+    }
+    cacheImage(name, img);
+}
+
+/// @brief preallocate the tile storage of a new image
+/// @details The pixels are held by the first storage manager of the image table
+/// (table.f0_TSM0), which stores the tiles one after another.
+/// @param[in] name image name
+/// @param[in] tiled shape and tile shape of the image
+template <class T>
+void CasaImageAccess<T>::preallocate(const std::string &name, const casacore::TiledShape &tiled)
+{
+    const casacore::IPosition shape = tiled.shape();
+    const casacore::IPosition tile = tiled.tileShape();
+    off_t nTiles = 1;
+    for (size_t axis = 0; axis < shape.nelements(); ++axis) {
+         nTiles *= (shape[axis] + tile[axis] - 1) / tile[axis];
+    }
+    const off_t size = nTiles * static_cast<off_t>(tile.product()) * static_cast<off_t>(sizeof(T));
+    const std::string fileName = name + "/table.f0_TSM0";
+    const int fd = ::open(fileName.c_str(), O_WRONLY);
+    if (fd < 0) {
+        ASKAPLOG_WARN_STR(casaImAccessLogger, "Unable to open " << fileName << " for preallocation: " <<
+                          std::strerror(errno));
+        return;
+    }
+    ASKAPLOG_DEBUG_STR(casaImAccessLogger, "Allocating " << size / 1024 / 1024 << " MB for " << nTiles <<
+                       " tile(s) of the image " << name);
+    // posix_fallocate returns the error code rather than setting errno
+    const int status = posix_fallocate(fd, 0, size);
+    if (status != 0) {
+        // e.g. not supported by the file system, a sparse file is the next best thing
+        ASKAPLOG_DEBUG_STR(casaImAccessLogger, "posix_fallocate failed (" << std::strerror(status) <<
+                           "), extending the file instead");
+        struct stat st;
+        if ((fstat(fd, &st) == 0) && (st.st_size < size) && (ftruncate(fd, size) != 0)) {
+            ASKAPLOG_WARN_STR(casaImAccessLogger, "Unable to extend " << fileName << ": " << std::strerror(errno));
+        }
+    }
+    ::close(fd);
 }
 
 /// @brief write full image
@@ -281,9 +684,15 @@ void CasaImageAccess<T>::create(const std::string &name, const casacore::IPositi
 template <class T>
 void CasaImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr)
 {
-    ASKAPLOG_INFO_STR(casaImAccessLogger, "Writing an array with the shape " << arr.shape() << " into a CASA image " << name);
-    casacore::PagedImage<T> img(name);
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, "Writing an array with the shape " << arr.shape() << " into a CASA image " << name);
+    DataAccessStatistics::ScopedTimer timer("CasaImageAccess::write");
+    timer.addBytes(arr.nelements() * sizeof(T));
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "casa", casacore::IPosition(arr.ndim(), 0), arr.shape());
+    ioEvent.addBytes(arr.nelements() * sizeof(T));
+    casacore::PagedImage<T> &img = image(name, true);
     img.put(arr);
+    this->accumulateStatistics(arr, casacore::IPosition(arr.ndim(), 0));
 }
 
 /// @brief write a slice of an image
@@ -294,10 +703,16 @@ template <class T>
 void CasaImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
                                const casacore::IPosition &where)
 {
-    ASKAPLOG_INFO_STR(casaImAccessLogger, "Writing a slice with the shape " << arr.shape() << " into a CASA image " <<
-                      name << " at " << where);
-    casacore::PagedImage<T> img(name);
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, "Writing a slice with the shape " << arr.shape() << " into a CASA image " <<
+                         name << " at " << where);
+    DataAccessStatistics::ScopedTimer timer("CasaImageAccess::write");
+    timer.addBytes(arr.nelements() * sizeof(T));
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "casa", where, arr.shape());
+    ioEvent.addBytes(arr.nelements() * sizeof(T));
+    casacore::PagedImage<T> &img = image(name, true);
     img.putSlice(arr, where);
+    this->accumulateStatistics(arr, where);
 }
 
 /// @brief write a slice of an image and mask
@@ -308,11 +723,17 @@ template <class T>
 void CasaImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
                                const casacore::Array<bool> &mask)
 {
-    ASKAPLOG_INFO_STR(casaImAccessLogger, "Writing image & mask with the shape " << arr.shape() << " into a CASA image " <<
-                      name);
-    casacore::PagedImage<T> img(name);
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, "Writing image & mask with the shape " << arr.shape() << " into a CASA image " <<
+                         name);
+    DataAccessStatistics::ScopedTimer timer("CasaImageAccess::write");
+    timer.addBytes(arr.nelements() * sizeof(T) + mask.nelements() * sizeof(bool));
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "casa", casacore::IPosition(arr.ndim(), 0), arr.shape());
+    ioEvent.addBytes(arr.nelements() * sizeof(T) + mask.nelements() * sizeof(bool));
+    casacore::PagedImage<T> &img = image(name, true);
     img.put(arr);
     img.pixelMask().put(mask);
+    this->accumulateStatistics(arr, mask, casacore::IPosition(arr.ndim(), 0));
 }
 
 
@@ -325,11 +746,17 @@ template <class T>
 void CasaImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
                                const casacore::Array<bool> &mask, const casacore::IPosition &where)
 {
-    ASKAPLOG_INFO_STR(casaImAccessLogger, "Writing a slice with the shape " << arr.shape() << " into a CASA image " <<
-                      name << " at " << where);
-    casacore::PagedImage<T> img(name);
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, "Writing a slice with the shape " << arr.shape() << " into a CASA image " <<
+                         name << " at " << where);
+    DataAccessStatistics::ScopedTimer timer("CasaImageAccess::write");
+    timer.addBytes(arr.nelements() * sizeof(T) + mask.nelements() * sizeof(bool));
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "casa", where, arr.shape());
+    ioEvent.addBytes(arr.nelements() * sizeof(T) + mask.nelements() * sizeof(bool));
+    casacore::PagedImage<T> &img = image(name, true);
     img.putSlice(arr, where);
     img.pixelMask().putSlice(mask, where);
+    this->accumulateStatistics(arr, mask, where);
 }
 
 
@@ -341,9 +768,11 @@ template <class T>
 void CasaImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask,
                                 const casacore::IPosition &where)
 {
-    ASKAPLOG_INFO_STR(casaImAccessLogger, "Writing a slice with the shape " << mask.shape() << " into a CASA image " <<
-                      name << " at " << where);
-    casacore::PagedImage<T> img(name);
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, "Writing a slice with the shape " << mask.shape() << " into a CASA image " <<
+                         name << " at " << where);
+    DataAccessStatistics::ScopedTimer timer("CasaImageAccess::writeMask");
+    timer.addBytes(mask.nelements() * sizeof(bool));
+    casacore::PagedImage<T> &img = image(name, true);
     img.pixelMask().putSlice(mask, where);
 }
 
@@ -353,9 +782,11 @@ void CasaImageAccess<T>::writeMask(const std::string &name, const casacore::Arra
 template <class T>
 void CasaImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask)
 {
-    ASKAPLOG_INFO_STR(casaImAccessLogger, "Writing a full mask with the shape " << mask.shape() << " into a CASA image " <<
-                      name);
-    casacore::PagedImage<T> img(name);
+    ASKAPLOG_HOTPATH_STR(casaImAccessLogger, "Writing a full mask with the shape " << mask.shape() << " into a CASA image " <<
+                         name);
+    DataAccessStatistics::ScopedTimer timer("CasaImageAccess::writeMask");
+    timer.addBytes(mask.nelements() * sizeof(bool));
+    casacore::PagedImage<T> &img = image(name, true);
     img.pixelMask().put(mask);
 }
 /// @brief set brightness units of the image
@@ -365,7 +796,7 @@ void CasaImageAccess<T>::writeMask(const std::string &name, const casacore::Arra
 template <class T>
 void CasaImageAccess<T>::setUnits(const std::string &name, const std::string &units)
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, true);
     img.setUnits(casacore::Unit(units));
 }
 
@@ -379,7 +810,7 @@ void CasaImageAccess<T>::setUnits(const std::string &name, const std::string &un
 template <class T>
 void CasaImageAccess<T>::setBeamInfo(const std::string &name, double maj, double min, double pa)
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, true);
     casacore::ImageInfo ii = img.imageInfo();
     ii.setRestoringBeam(casacore::Quantity(maj, "rad"), casacore::Quantity(min, "rad"), casacore::Quantity(pa, "rad"));
     img.setImageInfo(ii);
@@ -393,7 +824,7 @@ void CasaImageAccess<T>::setBeamInfo(const std::string &name, double maj, double
 template <class T>
 void CasaImageAccess<T>::setBeamInfo(const std::string &name, const BeamList & beamlist)
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, true);
     casacore::ImageInfo ii = img.imageInfo();
     ii.setAllBeams(beamlist.size(),1,casacore::GaussianBeam());
     for (const auto& beam : beamlist) {
@@ -411,7 +842,7 @@ void CasaImageAccess<T>::setBeamInfo(const std::string &name, const BeamList & b
 template <class T>
 void CasaImageAccess<T>::makeDefaultMask(const std::string &name)
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, true);
 
     // Create a mask and make it default region.
     // need to assert sizes etc ...
@@ -433,7 +864,7 @@ void CasaImageAccess<T>::setMetadataKeyword(const std::string &name, const std::
         const std::string value, const std::string &desc)
 {
 
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, true);
     casacore::TableRecord miscinfo = img.miscInfo();
     miscinfo.define(keyword, value);
     miscinfo.setComment(keyword, desc);
@@ -444,7 +875,7 @@ void CasaImageAccess<T>::setMetadataKeyword(const std::string &name, const std::
 template <class T>
 void CasaImageAccess<T>::setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords)
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, true);
     casacore::TableRecord miscinfo = img.miscInfo();
     // Note: we could sort through the keywords here and pick out ones that need to go in places
     // other than miscInfo to be more compatible with casacore
@@ -495,7 +926,7 @@ template <class T>
 void CasaImageAccess<T>::addHistory(const std::string &name, const std::vector<std::string> &historyLines)
 {
 
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, true);
     casacore::LogIO log = img.logSink();
     for (const auto& history : historyLines) {
         log << history << casacore::LogIO::POST;
@@ -510,7 +941,7 @@ void CasaImageAccess<T>::addHistory(const std::string &name, const std::vector<s
 template <class T>
 void CasaImageAccess<T>::setInfo(const std::string &name, const casacore::RecordInterface & info)
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, true);
     // make a copy of the table record
     casacore::TableRecord updateTableRecord = img.miscInfo();
     // find the name of the info table.  this is the name field of the info sub record
@@ -540,7 +971,7 @@ void CasaImageAccess<T>::setInfo(const std::string &name, const casacore::Record
 template <class T>
 void CasaImageAccess<T>::getInfo(const std::string &name, const std::string& tableName, casacore::Record &info)
 {
-    casacore::PagedImage<T> img(name);
+    casacore::PagedImage<T> &img = image(name, false);
 
     //casacore::TableRecord tableRecord = img.miscInfo().toRecord();
     casacore::Record tableRecord = img.miscInfo().toRecord();
@@ -0,0 +1,194 @@
+/// @file CasaImageAccessParallel.h
+/// @brief Write CASA images from several ranks in parallel
+/// @details This class extends CasaImageAccess with a collective creation mode.
+/// The image is tiled so that the blocks of the distribution axis given to the ranks
+/// consist of whole tiles, then every rank writes its own block directly.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#ifndef ASKAP_ACCESSORS_CASA_IMAGE_ACCESS_PARALLEL_H
+#define ASKAP_ACCESSORS_CASA_IMAGE_ACCESS_PARALLEL_H
+
+#include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/askapparallel/AskapParallel.h>
+
+#include <mpi.h>
+
+#include <map>
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Access CASA images with parallel writes
+/// @details The image is created collectively (see createCollective): the first rank of
+/// the communicator creates it with the tile length along the distribution axis chosen
+/// so that the block of every rank consists of whole tiles, and preallocates the tile
+/// storage. After that all ranks open the image without table locking and write their
+/// blocks at the same time. As no tile is shared between ranks and the storage doesn't
+/// grow, the writes don't interfere. The image has to be closed collectively (see
+/// closeCollective) before it is used otherwise.
+///
+/// Only pixels can be written in parallel. Masks, units, beams and other metadata change
+/// the table itself and should be written by a single rank after closeCollective.
+/// Images not created by createCollective are accessed serially as by CasaImageAccess.
+/// @ingroup imageaccess
+template <class T = casacore::Float>
+struct CasaImageAccessParallel : public CasaImageAccess<T> {
+
+    // the overloads not redefined here are inherited unchanged
+    using CasaImageAccess<T>::write;
+
+    /// @brief constructor
+    /// @details The images are opened without table locking, the coordination is done
+    /// by the collective operations.
+    /// @param[in] comms MPI communicator
+    /// @param[in] axis image axis to distribute over, negative to use the spectral axis
+    /// (or the last axis if there is no spectral axis)
+    /// @param[in] maxOpenImages maximum number of images kept open at the same time
+    explicit CasaImageAccessParallel(askapparallel::AskapParallel &comms, int axis = -1,
+                                     size_t maxOpenImages = 8);
+
+    /// @brief use the given communicator for collective operations
+    /// @details All ranks of this communicator (and only them) have to take part in
+    /// the collective operations. The communicator should stay valid while it is used.
+    /// @param[in] comm MPI communicator (MPI_COMM_WORLD by default)
+    void setCommunicator(MPI_Comm comm);
+
+    /// @brief create a new image - collective operation
+    /// @details The first rank of the communicator creates the image and writes it to disk,
+    /// then all ranks can write their blocks (see ownedBlock). All ranks of the communicator
+    /// have to call this method.
+    /// @param[in] name image name
+    /// @param[in] shape full shape of the image
+    /// @param[in] csys coordinate system of the full image
+    void createCollective(const std::string &name, const casacore::IPosition &shape,
+                          const casacore::CoordinateSystem &csys);
+
+    /// @brief close the image written in parallel - collective operation
+    /// @details Every rank writes its tiles to disk and closes the image. The method
+    /// returns when all ranks have finished, the image can then be accessed as usual.
+    /// @param[in] name image name
+    void closeCollective(const std::string &name);
+
+    /// @brief block of the image owned by this rank
+    /// @details Only valid for images created with createCollective and not yet closed
+    /// collectively. The block may be empty if there are more ranks than tiles.
+    /// @param[in] name image name
+    /// @param[out] blc bottom left corner of the block
+    /// @param[out] shape shape of the block
+    void ownedBlock(const std::string &name, casacore::IPosition &blc, casacore::IPosition &shape) const;
+
+    /// @brief split an axis into blocks of whole tiles
+    /// @details The axis is split into nearly equal blocks, one per rank. The tile length
+    /// is reduced (if necessary) to divide the block length, so the blocks are at most
+    /// a few pixels longer than the even split and only the last non-empty block is shorter.
+    /// @param[in] length length of the axis
+    /// @param[in] nBlocks number of blocks (ranks)
+    /// @param[in] tileLength preferred tile length along the axis
+    /// @return pair with the block length and the tile length
+    static std::pair<casacore::Int64, casacore::Int64> splitAxis(casacore::Int64 length, int nBlocks,
+                                                                 casacore::Int64 tileLength);
+
+    /// @brief write full image
+    /// @details For images written in parallel this rank must own the whole image.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    virtual void write(const std::string &name, const casacore::Array<T> &arr) override;
+
+    /// @brief write a slice of an image
+    /// @details For images written in parallel the slice has to be within the block
+    /// owned by this rank.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image and mask
+    /// @details Masks can't be written to images written in parallel.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::Array<bool> &mask, const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image mask
+    /// @details Masks can't be written to images written in parallel.
+    /// @param[in] name image name
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                           const casacore::IPosition &where) override;
+
+private:
+    /// @brief block of an image owned by this rank
+    struct OwnedBlock {
+        /// @brief distribution axis
+        casacore::uInt itsAxis;
+        /// @brief first pixel of the block along the distribution axis
+        casacore::Int64 itsStart;
+        /// @brief length of the block along the distribution axis (may be zero)
+        casacore::Int64 itsLength;
+        /// @brief full shape of the image
+        casacore::IPosition itsShape;
+    };
+
+    /// @brief check that a slice is within the block owned by this rank
+    /// @details Nothing is checked for images not written in parallel.
+    /// @param[in] name image name
+    /// @param[in] shape shape of the slice (trailing degenerate axes may be omitted)
+    /// @param[in] where bottom left corner of the slice
+    void checkOwnership(const std::string &name, const casacore::IPosition &shape,
+                        const casacore::IPosition &where) const;
+
+    /// @return rank in the communicator used for collective operations
+    int rank() const;
+
+    /// @return number of ranks in the communicator used for collective operations
+    int nProcs() const;
+
+    /// @brief communicator class
+    askapparallel::AskapParallel &itsComms;
+
+    /// @brief communicator used for collective operations
+    MPI_Comm itsMPIComm;
+
+    /// @brief axis to distribute over, negative for the spectral axis
+    int itsAxis;
+
+    /// @brief blocks owned by this rank for the images written in parallel
+    std::map<std::string, OwnedBlock> itsOwnedBlocks;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#include <askap/imageaccess/CasaImageAccessParallel.tcc>
+
+#endif // #ifndef ASKAP_ACCESSORS_CASA_IMAGE_ACCESS_PARALLEL_H
@@ -0,0 +1,268 @@
+/// @file CasaImageAccessParallel.tcc
+/// @brief Write CASA images from several ranks in parallel
+/// @details This class extends CasaImageAccess with a collective creation mode.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#include <askap/imageaccess/CasaImageAccessParallel.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+#include <algorithm>
+#include <exception>
+
+ASKAP_LOGGER(casaParallelLogger, ".casaImageAccessParallel");
+
+namespace askap {
+namespace accessors {
+
+/// @brief constructor
+/// @details The images are opened without table locking, the coordination is done
+/// by the collective operations.
+/// @param[in] comms MPI communicator
+/// @param[in] axis image axis to distribute over, negative to use the spectral axis
+/// (or the last axis if there is no spectral axis)
+/// @param[in] maxOpenImages maximum number of images kept open at the same time
+template <class T>
+CasaImageAccessParallel<T>::CasaImageAccessParallel(askapparallel::AskapParallel &comms, int axis,
+                                                    size_t maxOpenImages) :
+    CasaImageAccess<T>(casacore::TableLock::NoLocking, maxOpenImages), itsComms(comms),
+    itsMPIComm(MPI_COMM_WORLD), itsAxis(axis)
+{
+}
+
+/// @brief use the given communicator for collective operations
+/// @param[in] comm MPI communicator (MPI_COMM_WORLD by default)
+template <class T>
+void CasaImageAccessParallel<T>::setCommunicator(MPI_Comm comm)
+{
+    itsMPIComm = comm;
+}
+
+/// @return rank in the communicator used for collective operations
+template <class T>
+int CasaImageAccessParallel<T>::rank() const
+{
+    int result = 0;
+    MPI_Comm_rank(itsMPIComm, &result);
+    return result;
+}
+
+/// @return number of ranks in the communicator used for collective operations
+template <class T>
+int CasaImageAccessParallel<T>::nProcs() const
+{
+    int result = 1;
+    MPI_Comm_size(itsMPIComm, &result);
+    return result;
+}
+
+/// @brief split an axis into blocks of whole tiles
+/// @details The block length is the even split rounded up to a whole number of tiles,
+/// and the tile length is shrunk so this rounding adds less than one pixel per tile.
+/// @param[in] length length of the axis
+/// @param[in] nBlocks number of blocks (ranks)
+/// @param[in] tileLength preferred tile length along the axis
+/// @return pair with the block length and the tile length
+template <class T>
+std::pair<casacore::Int64, casacore::Int64> CasaImageAccessParallel<T>::splitAxis(casacore::Int64 length,
+                                        int nBlocks, casacore::Int64 tileLength)
+{
+    ASKAPCHECK(length > 0, "Unable to split an axis of length " << length);
+    ASKAPCHECK(nBlocks > 0, "Number of blocks should be positive, you have " << nBlocks);
+    ASKAPCHECK(tileLength > 0, "Tile length should be positive, you have " << tileLength);
+    const casacore::Int64 even = (length + nBlocks - 1) / nBlocks;
+    const casacore::Int64 nTiles = (even + tileLength - 1) / tileLength;
+    const casacore::Int64 tile = (even + nTiles - 1) / nTiles;
+    return std::make_pair(nTiles * tile, tile);
+}
+
+/// @brief create a new image - collective operation
+/// @details The first rank creates the image with the adjusted tiling, preallocates the
+/// tile storage and closes the image, so the header is on disk before other ranks open it.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+template <class T>
+void CasaImageAccessParallel<T>::createCollective(const std::string &name, const casacore::IPosition &shape,
+                                                  const casacore::CoordinateSystem &csys)
+{
+    ASKAPCHECK(shape.nelements() > 0, "Unable to create a CASA image " << name << " with empty shape");
+    // the same logic as for the spectrum tiling in CasaImageAccess::tiledShape
+    int axis = itsAxis;
+    if (axis < 0) {
+        axis = shape.nelements() - 1;
+        const int specCoord = csys.findCoordinate(casacore::Coordinate::SPECTRAL);
+        if ((specCoord >= 0) && (csys.pixelAxes(specCoord).nelements() == 1) && (csys.pixelAxes(specCoord)[0] >= 0)) {
+            axis = csys.pixelAxes(specCoord)[0];
+        }
+    }
+    ASKAPCHECK(axis < static_cast<int>(shape.nelements()), "Unable to distribute the image " << name <<
+               " with the shape " << shape << " over axis " << axis);
+    casacore::IPosition tile = this->tiledShape(shape, csys).tileShape();
+    const std::pair<casacore::Int64, casacore::Int64> split = splitAxis(shape(axis), nProcs(), tile(axis));
+    tile(axis) = split.second;
+
+    // an image of the same name opened before would be out of date
+    this->close(name);
+    int ok = 1;
+    if (rank() == 0) {
+        try {
+           ASKAPLOG_INFO_STR(casaParallelLogger, "Creating a new CASA image " << name << " with the shape " << shape <<
+                             " to be written by " << nProcs() << " rank(s), " << split.first <<
+                             " pixel(s) along axis " << axis << " per rank");
+           // the storage shouldn't grow while the ranks are writing
+           this->createTiled(name, casacore::TiledShape(shape, tile), csys, true);
+           this->close(name);
+        }
+        catch (const std::exception &ex) {
+           ASKAPLOG_ERROR_STR(casaParallelLogger, "Failed to create " << name << ": " << ex.what());
+           ok = 0;
+        }
+    }
+    MPI_Bcast(&ok, 1, MPI_INT, 0, itsMPIComm);
+    ASKAPCHECK(ok, "Collective creation of the CASA image " << name << " has failed");
+
+    OwnedBlock block;
+    block.itsAxis = static_cast<casacore::uInt>(axis);
+    block.itsStart = std::min(static_cast<casacore::Int64>(rank()) * split.first, shape(axis));
+    block.itsLength = std::min(split.first, shape(axis) - block.itsStart);
+    block.itsShape = shape;
+    itsOwnedBlocks[name] = block;
+}
+
+/// @brief close the image written in parallel - collective operation
+/// @details The pixels are flushed explicitly, so errors are not lost in the destructor.
+/// @param[in] name image name
+template <class T>
+void CasaImageAccessParallel<T>::closeCollective(const std::string &name)
+{
+    int ok = 1;
+    try {
+       this->syncPixels(name);
+       this->close(name);
+    }
+    catch (const std::exception &ex) {
+       ASKAPLOG_ERROR_STR(casaParallelLogger, "Failed to close " << name << " on rank " << rank() << ": " << ex.what());
+       ok = 0;
+    }
+    itsOwnedBlocks.erase(name);
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, itsMPIComm);
+    ASKAPCHECK(ok, "Collective write of the CASA image " << name << " has failed");
+}
+
+/// @brief block of the image owned by this rank
+/// @param[in] name image name
+/// @param[out] blc bottom left corner of the block
+/// @param[out] shape shape of the block
+template <class T>
+void CasaImageAccessParallel<T>::ownedBlock(const std::string &name, casacore::IPosition &blc,
+                                            casacore::IPosition &shape) const
+{
+    const typename std::map<std::string, OwnedBlock>::const_iterator ci = itsOwnedBlocks.find(name);
+    ASKAPCHECK(ci != itsOwnedBlocks.end(), "CASA image " << name << " is not written in parallel");
+    const OwnedBlock &block = ci->second;
+    blc.resize(block.itsShape.nelements());
+    blc = 0;
+    blc(block.itsAxis) = block.itsStart;
+    shape.resize(block.itsShape.nelements());
+    shape = block.itsShape;
+    shape(block.itsAxis) = block.itsLength;
+}
+
+/// @brief check that a slice is within the block owned by this rank
+/// @param[in] name image name
+/// @param[in] shape shape of the slice (trailing degenerate axes may be omitted)
+/// @param[in] where bottom left corner of the slice
+template <class T>
+void CasaImageAccessParallel<T>::checkOwnership(const std::string &name, const casacore::IPosition &shape,
+                                                const casacore::IPosition &where) const
+{
+    const typename std::map<std::string, OwnedBlock>::const_iterator ci = itsOwnedBlocks.find(name);
+    if ((ci == itsOwnedBlocks.end()) || (shape.product() == 0)) {
+        return;
+    }
+    const OwnedBlock &block = ci->second;
+    const casacore::Int64 start = block.itsAxis < where.nelements() ? where(block.itsAxis) : 0;
+    const casacore::Int64 length = block.itsAxis < shape.nelements() ? shape(block.itsAxis) : 1;
+    ASKAPCHECK((start >= block.itsStart) && (start + length <= block.itsStart + block.itsLength),
+               "Rank " << rank() << " attempts to write pixels " << start << " to " << start + length - 1 <<
+               " along axis " << block.itsAxis << " of the CASA image " << name << ", but owns only " <<
+               block.itsLength << " pixel(s) starting from " << block.itsStart);
+}
+
+/// @brief write full image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+template <class T>
+void CasaImageAccessParallel<T>::write(const std::string &name, const casacore::Array<T> &arr)
+{
+    checkOwnership(name, arr.shape(), casacore::IPosition(arr.ndim(), 0));
+    CasaImageAccess<T>::write(name, arr);
+}
+
+/// @brief write a slice of an image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void CasaImageAccessParallel<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                       const casacore::IPosition &where)
+{
+    checkOwnership(name, arr.shape(), where);
+    CasaImageAccess<T>::write(name, arr, where);
+}
+
+/// @brief write a slice of an image and mask
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void CasaImageAccessParallel<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                       const casacore::Array<bool> &mask, const casacore::IPosition &where)
+{
+    ASKAPCHECK(itsOwnedBlocks.find(name) == itsOwnedBlocks.end(), "Masks can't be written into the CASA image " <<
+               name << " while it is written in parallel, call closeCollective first");
+    CasaImageAccess<T>::write(name, arr, mask, where);
+}
+
+/// @brief write a slice of an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void CasaImageAccessParallel<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                                           const casacore::IPosition &where)
+{
+    ASKAPCHECK(itsOwnedBlocks.find(name) == itsOwnedBlocks.end(), "Masks can't be written into the CASA image " <<
+               name << " while it is written in parallel, call closeCollective first");
+    CasaImageAccess<T>::writeMask(name, mask, where);
+}
+
+} // namespace accessors
+} // namespace askap
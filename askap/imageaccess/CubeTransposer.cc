@@ -0,0 +1,276 @@
+/// @file CubeTransposer.cc
+/// @brief Convert a cube into the spectrum-major layout
+/// @details The cube is copied in blocks of rows covering all planes, optionally
+/// with the spectral axis moved to the front.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/imageaccess/CubeTransposer.h>
+#include <askap/imageaccess/AsyncImageWriter.h>
+#include <askap/imageaccess/FitsImageAccessParallel.h>
+
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/OS/Timer.h>
+
+#include <algorithm>
+#include <vector>
+
+ASKAP_LOGGER(logger, ".CubeTransposer");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the transposer
+/// @param[in] input accessor to read the cube with
+/// @param[in] output accessor to write the result with
+CubeTransposer::CubeTransposer(const boost::shared_ptr<IImageAccess<casacore::Float> > &input,
+                               const boost::shared_ptr<IImageAccess<casacore::Float> > &output) :
+    itsInput(input), itsOutput(output), itsCollectiveOutput(boost::dynamic_pointer_cast<FitsImageAccessParallel>(output)),
+    itsSpectrumFirst(true), itsMaxBlockSize(32 * 1024 * 1024), itsRank(0), itsNRanks(1)
+{
+    ASKAPCHECK(itsInput && itsOutput, "CubeTransposer needs both input and output accessors");
+    ASKAPCHECK(itsInput != itsOutput, "CubeTransposer needs different objects to read and write, "
+               "the output is written in the background");
+}
+
+/// @brief choose whether the spectral axis is moved to the front
+/// @param[in] flag true to make the spectral axis the 1st one
+void CubeTransposer::setSpectrumFirst(bool flag)
+{
+    itsSpectrumFirst = flag;
+}
+
+/// @brief set the maximum size of the block read at a time
+/// @param[in] maxPixels maximum number of pixels in a block
+void CubeTransposer::setMaxBlockSize(size_t maxPixels)
+{
+    itsMaxBlockSize = maxPixels;
+}
+
+/// @brief set the part of the job done by this process
+/// @param[in] rank rank of this process
+/// @param[in] nRanks number of processes sharing the job
+void CubeTransposer::setRank(size_t rank, size_t nRanks)
+{
+    ASKAPCHECK(rank < nRanks, "Rank " << rank << " is outside the range of " << nRanks << " ranks");
+    itsRank = rank;
+    itsNRanks = nRanks;
+}
+
+/// @brief axis order of the output
+/// @param[in] inName input image name
+/// @return output axis i corresponds to the input axis given by the i-th element
+casacore::IPosition CubeTransposer::axisOrder(const std::string &inName) const
+{
+    const casacore::uInt nDim = itsInput->shape(inName).nelements();
+    casacore::IPosition order(nDim);
+    for (casacore::uInt axis = 0; axis < nDim; ++axis) {
+         order[axis] = axis;
+    }
+    if (itsSpectrumFirst) {
+        const casacore::uInt spcAxis = spectralAxis(itsInput->coordSys(inName));
+        ASKAPCHECK(spcAxis < nDim, "Spectral axis " << spcAxis << " is outside the image " << inName);
+        order[0] = spcAxis;
+        for (casacore::uInt axis = 0, outAxis = 1; axis < nDim; ++axis) {
+             if (axis != spcAxis) {
+                 order[outAxis++] = axis;
+             }
+        }
+    }
+    return order;
+}
+
+/// @brief number of blocks the input is split into
+/// @param[in] inName input image name
+/// @return number of blocks (summed over all ranks)
+size_t CubeTransposer::nBlocks(const std::string &inName) const
+{
+    const casacore::IPosition shape = itsInput->shape(inName);
+    const casacore::uInt axis = splitAxis(inName);
+    const size_t rows = rowsPerBlock(shape, axis);
+    return (shape[axis] + rows - 1) / rows;
+}
+
+/// @brief create the output image
+/// @param[in] inName input image name
+/// @param[in] outName output image name
+void CubeTransposer::createOutput(const std::string &inName, const std::string &outName)
+{
+    const casacore::IPosition shape = itsInput->shape(inName);
+    const casacore::IPosition order = axisOrder(inName);
+    casacore::CoordinateSystem csys = itsInput->coordSys(inName);
+    casacore::IPosition outShape(shape.nelements());
+    casacore::Vector<casacore::Int> pixelOrder(shape.nelements());
+    std::vector<casacore::Int> worldOrder;
+    for (casacore::uInt axis = 0; axis < shape.nelements(); ++axis) {
+         outShape[axis] = shape[order[axis]];
+         pixelOrder[axis] = order[axis];
+         const casacore::Int worldAxis = csys.pixelAxisToWorldAxis(order[axis]);
+         if (worldAxis >= 0) {
+             worldOrder.push_back(worldAxis);
+         }
+    }
+    // world axes without pixel axes (if any) keep their order at the end
+    for (casacore::Int worldAxis = 0; worldAxis < static_cast<casacore::Int>(csys.nWorldAxes()); ++worldAxis) {
+         if (std::find(worldOrder.begin(), worldOrder.end(), worldAxis) == worldOrder.end()) {
+             worldOrder.push_back(worldAxis);
+         }
+    }
+    csys.transpose(casacore::Vector<casacore::Int>(worldOrder), pixelOrder);
+    ASKAPLOG_INFO_STR(logger, "Creating " << outName << " with the shape " << outShape << " (axis order " <<
+                      order << " of " << inName << ")");
+    if (itsCollectiveOutput) {
+        itsCollectiveOutput->createCollective(outName, outShape, csys);
+    } else if (itsRank == 0) {
+        itsOutput->create(outName, outShape, csys);
+    }
+}
+
+/// @brief copy the blocks of this rank
+/// @param[in] inName input image name
+/// @param[in] outName output image name (should exist, see createOutput)
+void CubeTransposer::transpose(const std::string &inName, const std::string &outName)
+{
+    const casacore::IPosition shape = itsInput->shape(inName);
+    const casacore::uInt axis = splitAxis(inName);
+    const size_t rows = rowsPerBlock(shape, axis);
+    const size_t nBlk = nBlocks(inName);
+    const casacore::IPosition order = axisOrder(inName);
+    bool reorder = false;
+    for (casacore::uInt dim = 0; dim < order.nelements(); ++dim) {
+         reorder |= (order[dim] != static_cast<ssize_t>(dim));
+    }
+    ASKAPCHECK(itsCollectiveOutput || (itsNRanks == 1) || !boost::dynamic_pointer_cast<FitsImageAccess>(itsOutput),
+               "Several ranks can write FITS images through collective I/O only");
+    ASKAPLOG_INFO_STR(logger, "Copying " << inName << " into " << outName << " in " << nBlk << " block(s) of " <<
+                      rows << " element(s) along axis " << axis << ", rank " << itsRank << " of " << itsNRanks);
+
+    boost::shared_ptr<AsyncImageWriter<casacore::Float> > writer;
+    if (!itsCollectiveOutput) {
+        writer.reset(new AsyncImageWriter<casacore::Float>(itsOutput));
+    }
+    casacore::Timer timer;
+    double readTime = 0.;
+    size_t nCopied = 0;
+    // collective writes need the same number of calls on all ranks
+    const size_t nRounds = (nBlk + itsNRanks - 1) / itsNRanks;
+    for (size_t round = 0; round < nRounds; ++round) {
+         const size_t block = round * itsNRanks + itsRank;
+         casacore::Array<casacore::Float> arr;
+         casacore::IPosition where(shape.nelements(), 0);
+         if (block < nBlk) {
+             casacore::IPosition blc(shape.nelements(), 0);
+             casacore::IPosition trc = shape - 1;
+             blc[axis] = block * rows;
+             trc[axis] = std::min(blc[axis] + static_cast<ssize_t>(rows), shape[axis]) - 1;
+             timer.mark();
+             arr = itsInput->read(inName, blc, trc);
+             readTime += timer.real();
+             if (reorder) {
+                 arr.reference(casacore::reorderArray(arr, order));
+             }
+             for (casacore::uInt dim = 0; dim < order.nelements(); ++dim) {
+                  where[dim] = blc[order[dim]];
+             }
+             ++nCopied;
+         }
+         if (itsCollectiveOutput) {
+             itsCollectiveOutput->writeCollective(outName, arr, where);
+         } else if (block < nBlk) {
+             writer->writeAdopt(outName, arr, where);
+         }
+    }
+    if (writer) {
+        writer->flush();
+    }
+    ASKAPLOG_INFO_STR(logger, "Rank " << itsRank << " copied " << nCopied << " block(s), reading took " <<
+                      readTime << " s");
+}
+
+/// @brief copy brightness units and restoring beam
+/// @param[in] inName input image name
+/// @param[in] outName output image name
+void CubeTransposer::copyMetadata(const std::string &inName, const std::string &outName)
+{
+    itsOutput->setUnits(outName, itsInput->getUnits(inName));
+    const BeamList beams = itsInput->beamList(inName);
+    if (beams.size() > 0) {
+        // channel numbers don't change, so the list can be copied as is
+        itsOutput->setBeamInfo(outName, beams);
+    } else {
+        const casacore::Vector<casacore::Quantum<double> > beam = itsInput->beamInfo(inName);
+        if ((beam.nelements() == 3) && (beam[0].getValue("rad") > 0.)) {
+            itsOutput->setBeamInfo(outName, beam[0].getValue("rad"), beam[1].getValue("rad"), beam[2].getValue("rad"));
+        }
+    }
+}
+
+/// @brief find the spectral pixel axis
+/// @param[in] csys coordinate system of the cube
+/// @return index of the spectral pixel axis, an exception is thrown if there is none
+casacore::uInt CubeTransposer::spectralAxis(const casacore::CoordinateSystem &csys)
+{
+    const casacore::Int coord = csys.findCoordinate(casacore::Coordinate::SPECTRAL);
+    ASKAPCHECK(coord >= 0, "The image has no spectral coordinate");
+    const casacore::Vector<casacore::Int> axes = csys.pixelAxes(coord);
+    ASKAPCHECK((axes.nelements() == 1) && (axes[0] >= 0), "The spectral coordinate should have exactly one pixel axis");
+    return static_cast<casacore::uInt>(axes[0]);
+}
+
+/// @brief axis the cube is split along
+/// @details This is the 2nd axis unless it is spectral (the whole spectra are always read).
+/// @param[in] inName input image name
+/// @return index of the input axis
+casacore::uInt CubeTransposer::splitAxis(const std::string &inName) const
+{
+    const casacore::uInt nDim = itsInput->shape(inName).nelements();
+    ASKAPCHECK(nDim >= 2, "Image " << inName << " should have at least 2 axes to be transposed");
+    const casacore::uInt spcAxis = spectralAxis(itsInput->coordSys(inName));
+    for (casacore::uInt axis = 1; axis < nDim; ++axis) {
+         if (axis != spcAxis) {
+             return axis;
+         }
+    }
+    return 0;
+}
+
+/// @brief number of elements along the split axis in a single block
+/// @param[in] shape shape of the input
+/// @param[in] axis split axis
+/// @return number of rows (or elements along the split axis) per block
+size_t CubeTransposer::rowsPerBlock(const casacore::IPosition &shape, casacore::uInt axis) const
+{
+    ASKAPDEBUGASSERT(axis < shape.nelements());
+    ASKAPCHECK(shape[axis] > 0, "Empty image can't be transposed");
+    const size_t rowSize = shape.product() / shape[axis];
+    const size_t rows = rowSize > 0 ? itsMaxBlockSize / rowSize : 1;
+    return std::max(size_t(1), std::min(rows, static_cast<size_t>(shape[axis])));
+}
@@ -0,0 +1,167 @@
+/// @file CubeTransposer.h
+/// @brief Convert a cube into the spectrum-major layout
+/// @details Spectra of individual pixels are scattered over the whole file if the cube is
+/// stored plane by plane, so reading them one at a time is very slow. This class copies
+/// the cube in blocks of rows (each block covers all planes), optionally moving the
+/// spectral axis to the front, so the spectra of the output are contiguous on disk.
+/// Together with spectral tiling of CASA images this allows downstream spectral jobs
+/// to read the data contiguously.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_CUBE_TRANSPOSER_H
+#define ASKAP_ACCESSORS_CUBE_TRANSPOSER_H
+
+#include <askap/imageaccess/IImageAccess.h>
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+class FitsImageAccessParallel;
+
+/// @brief Convert a cube into the spectrum-major layout
+/// @details The input is split into blocks along the first non-spectral axis other than
+/// the 1st one (i.e. blocks of rows for the usual RA, Dec, Stokes, Freq cube). Every block
+/// includes all planes, so it is read as a number of contiguous runs. Blocks are distributed
+/// over the ranks in a round-robin fashion and each rank reads its own blocks independently.
+///
+/// If the output accessor is FitsImageAccessParallel, the output is created and written
+/// with collective MPI-IO, so all ranks of its communicator have to call createOutput and
+/// transpose. Otherwise, the output is created by rank 0 (the caller should synchronise
+/// the ranks before transpose is called) and written in the background with
+/// AsyncImageWriter, so the next block is read while the previous one is written. In this
+/// case, several ranks writing the same image is only safe if the accessor takes care of
+/// locking (i.e. CASA images with auto locking). The input and output accessors should
+/// be different objects.
+///
+/// Pixel masks of FITS images are carried by NaNs and are transposed with the pixels,
+/// CASA masks are not copied.
+/// @ingroup imageaccess
+class CubeTransposer : public boost::noncopyable {
+public:
+    /// @brief set up the transposer
+    /// @param[in] input accessor to read the cube with
+    /// @param[in] output accessor to write the result with
+    CubeTransposer(const boost::shared_ptr<IImageAccess<casacore::Float> > &input,
+                   const boost::shared_ptr<IImageAccess<casacore::Float> > &output);
+
+    /// @brief choose whether the spectral axis is moved to the front
+    /// @details If false, the axis order is kept, which is useful if the output is a CASA
+    /// image with spectral tiling (see CasaImageAccess::setAccessPattern). The default is true.
+    /// @param[in] flag true to make the spectral axis the 1st one
+    void setSpectrumFirst(bool flag);
+
+    /// @brief set the maximum size of the block read at a time
+    /// @details At least one row of all planes is read, even if it exceeds this size.
+    /// @param[in] maxPixels maximum number of pixels in a block
+    void setMaxBlockSize(size_t maxPixels);
+
+    /// @brief set the part of the job done by this process
+    /// @param[in] rank rank of this process
+    /// @param[in] nRanks number of processes sharing the job
+    void setRank(size_t rank, size_t nRanks);
+
+    /// @brief axis order of the output
+    /// @param[in] inName input image name
+    /// @return output axis i corresponds to the input axis given by the i-th element
+    casacore::IPosition axisOrder(const std::string &inName) const;
+
+    /// @brief number of blocks the input is split into
+    /// @param[in] inName input image name
+    /// @return number of blocks (summed over all ranks)
+    size_t nBlocks(const std::string &inName) const;
+
+    /// @brief create the output image
+    /// @details The shape and coordinate system are those of the input with the axes reordered.
+    /// This is a collective operation for FitsImageAccessParallel, otherwise the image is
+    /// created by rank 0 only.
+    /// @param[in] inName input image name
+    /// @param[in] outName output image name
+    void createOutput(const std::string &inName, const std::string &outName);
+
+    /// @brief copy the blocks of this rank
+    /// @details This is a collective operation for FitsImageAccessParallel.
+    /// @param[in] inName input image name
+    /// @param[in] outName output image name (should exist, see createOutput)
+    void transpose(const std::string &inName, const std::string &outName);
+
+    /// @brief copy brightness units and restoring beam
+    /// @details This should be done by one rank only, after all ranks have finished writing.
+    /// @param[in] inName input image name
+    /// @param[in] outName output image name
+    void copyMetadata(const std::string &inName, const std::string &outName);
+
+    /// @brief find the spectral pixel axis
+    /// @param[in] csys coordinate system of the cube
+    /// @return index of the spectral pixel axis, an exception is thrown if there is none
+    static casacore::uInt spectralAxis(const casacore::CoordinateSystem &csys);
+
+private:
+    /// @brief axis the cube is split along
+    /// @param[in] inName input image name
+    /// @return index of the input axis
+    casacore::uInt splitAxis(const std::string &inName) const;
+
+    /// @brief number of elements along the split axis in a single block
+    /// @param[in] shape shape of the input
+    /// @param[in] axis split axis
+    /// @return number of rows (or elements along the split axis) per block
+    size_t rowsPerBlock(const casacore::IPosition &shape, casacore::uInt axis) const;
+
+    /// @brief accessor to read with
+    boost::shared_ptr<IImageAccess<casacore::Float> > itsInput;
+
+    /// @brief accessor to write with
+    boost::shared_ptr<IImageAccess<casacore::Float> > itsOutput;
+
+    /// @brief output accessor if it supports collective I/O, empty otherwise
+    boost::shared_ptr<FitsImageAccessParallel> itsCollectiveOutput;
+
+    /// @brief true if the spectral axis becomes the 1st one
+    bool itsSpectrumFirst;
+
+    /// @brief maximum number of pixels in a block
+    size_t itsMaxBlockSize;
+
+    /// @brief rank of this process
+    size_t itsRank;
+
+    /// @brief number of processes sharing the job
+    size_t itsNRanks;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
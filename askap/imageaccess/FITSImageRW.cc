@@ -31,6 +31,7 @@
 #include <askap_accessors.h>
 #include <askap/askap/AskapLogging.h>
 #include <askap/askap/AskapUtil.h>
+#include <askap/dataaccess/LogRateLimiter.h>
 #include <casacore/images/Images/FITSImage.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/DataType.h>
@@ -41,13 +42,25 @@
 
 #include <casacore/casa/Quanta/MVTime.h>
 #include <askap/imageaccess/FITSImageRW.h>
+#include <askap/imageaccess/FitsPixelConversion.h>
 
 #include <boost/shared_array.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
 
 #include <fitsio.h>
 #include <iostream>
 
+#include <sys/stat.h>
+#include <set>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <functional>
+
 ASKAP_LOGGER(FITSlogger, ".FITSImageRW");
 
 void printerror(int status)
@@ -69,6 +82,140 @@ void printerror(int status)
 
 using namespace askap;
 using namespace askap::accessors;
+
+namespace {
+
+/// @brief objects which keep a file open
+/// @details cfitsio reuses the handle if the file with the same name is opened again
+/// in the same process, so the file can't be replaced while any of these handles are open.
+std::set<const FITSImageRW*>& openFileRegistry()
+{
+    static std::set<const FITSImageRW*> registry;
+    return registry;
+}
+
+/// @brief mutex protecting the registry
+boost::recursive_mutex& openFileRegistryMutex()
+{
+    static boost::recursive_mutex mutex;
+    return mutex;
+}
+
+/// @brief prefix of placeholder keywords reserving header space (followed by 4 digits)
+const std::string reservedKeywordPrefix("RSRV");
+
+/// @brief number of rows cfitsio can buffer at once for the current table
+/// @param[in] fptr FITS file pointer positioned at the table
+/// @return number of rows to transfer at a time (at least one)
+long optimalRowCount(fitsfile *fptr)
+{
+    long nRows = 0;
+    int status = 0;
+    if (fits_get_rowsize(fptr, &nRows, &status) || (nRows < 1)) {
+        nRows = 1;
+    }
+    return nRows;
+}
+
+/// @brief write a chunk of rows of a numeric column
+/// @details The data are passed to cfitsio straight from the array storage. Columns
+/// shorter than the table are left undefined beyond their length.
+/// @param[in] fptr FITS file pointer positioned at the table
+/// @param[in] datatype cfitsio data type matching T
+/// @param[in] column column number (1-based)
+/// @param[in] arr column data
+/// @param[in] firstRow first row of the chunk (0-based)
+/// @param[in] nRows number of rows in the chunk
+/// @param[in,out] status cfitsio status
+template <typename T>
+void writeColumnChunk(fitsfile *fptr, int datatype, int column, const casacore::Array<T> &arr,
+                      long firstRow, long nRows, int &status)
+{
+    const long length = static_cast<long>(arr.nelements());
+    if (firstRow >= length) {
+        return;
+    }
+    bool deleteIt = false;
+    const T *data = arr.getStorage(deleteIt);
+    fits_write_col(fptr, datatype, column, firstRow + 1, 1, std::min(nRows, length - firstRow),
+                   const_cast<T*>(data + firstRow), &status);
+    arr.freeStorage(data, deleteIt);
+}
+
+/// @brief write a chunk of rows of a string column
+/// @param[in] fptr FITS file pointer positioned at the table
+/// @param[in] column column number (1-based)
+/// @param[in] arr column data
+/// @param[in] firstRow first row of the chunk (0-based)
+/// @param[in] nRows number of rows in the chunk
+/// @param[in,out] status cfitsio status
+void writeStringChunk(fitsfile *fptr, int column, const casacore::Array<casacore::String> &arr,
+                      long firstRow, long nRows, int &status)
+{
+    const long length = static_cast<long>(arr.nelements());
+    if (firstRow >= length) {
+        return;
+    }
+    nRows = std::min(nRows, length - firstRow);
+    bool deleteIt = false;
+    const casacore::String *data = arr.getStorage(deleteIt);
+    // cfitsio doesn't modify the strings written
+    std::vector<char*> values(nRows);
+    for (long row = 0; row < nRows; ++row) {
+         values[row] = const_cast<char*>(data[firstRow + row].c_str());
+    }
+    fits_write_col(fptr, TSTRING, column, firstRow + 1, 1, nRows, values.data(), &status);
+    arr.freeStorage(data, deleteIt);
+}
+
+/// @brief read a chunk of rows of a numeric column
+/// @details The data are read straight into the array storage, which should be contiguous.
+/// @param[in] fptr FITS file pointer positioned at the table
+/// @param[in] datatype cfitsio data type matching T
+/// @param[in] column column number (1-based)
+/// @param[in,out] arr column data, sized for the whole table
+/// @param[in] firstRow first row of the chunk (0-based)
+/// @param[in] nRows number of rows in the chunk
+/// @param[in,out] status cfitsio status
+template <typename T>
+void readColumnChunk(fitsfile *fptr, int datatype, int column, casacore::Array<T> &arr,
+                     long firstRow, long nRows, int &status)
+{
+    ASKAPDEBUGASSERT(arr.contiguousStorage());
+    ASKAPDEBUGASSERT(firstRow + nRows <= static_cast<long>(arr.nelements()));
+    int anynull = 0;
+    fits_read_col(fptr, datatype, column, firstRow + 1, 1, nRows, nullptr, arr.data() + firstRow, &anynull, &status);
+}
+
+/// @brief read a chunk of rows of a string column
+/// @param[in] fptr FITS file pointer positioned at the table
+/// @param[in] column column number (1-based)
+/// @param[in] width maximum length of the strings
+/// @param[in,out] arr column data, sized for the whole table
+/// @param[in] firstRow first row of the chunk (0-based)
+/// @param[in] nRows number of rows in the chunk
+/// @param[in,out] status cfitsio status
+void readStringChunk(fitsfile *fptr, int column, long width, casacore::Array<casacore::String> &arr,
+                     long firstRow, long nRows, int &status)
+{
+    ASKAPDEBUGASSERT(arr.contiguousStorage());
+    std::vector<char> buffer(nRows * (width + 1), '\0');
+    std::vector<char*> values(nRows);
+    for (long row = 0; row < nRows; ++row) {
+         values[row] = buffer.data() + row * (width + 1);
+    }
+    int anynull = 0;
+    char strnull[] = " ";
+    if (fits_read_col(fptr, TSTRING, column, firstRow + 1, 1, nRows, strnull, values.data(), &anynull, &status) == 0) {
+        casacore::String *data = arr.data() + firstRow;
+        for (long row = 0; row < nRows; ++row) {
+             data[row] = values[row];
+        }
+    }
+}
+
+} // anonymous namespace
+
 FITSImageRW::CPointerWrapper::CPointerWrapper(unsigned int numColumns)
     : itsNumColumns(numColumns),
       itsTType  { new char* [sizeof(char*) * numColumns] },
@@ -108,15 +255,282 @@ FITSImageRW::CPointerWrapper::~CPointerWrapper()
     }
 }
 ///////////////////////////////////////////////////
-FITSImageRW::FITSImageRW(const std::string &name)
+/// @brief construct a stamp which doesn't match any file
+FitsFileStamp::FitsFileStamp() : itsValid(false), itsDevice(0), itsInode(0), itsSize(0),
+    itsMTime(0), itsMTimeNSec(0)
+{
+}
+
+/// @brief obtain the stamp of the given file
+/// @param[in] fname file name
+FitsFileStamp::FitsFileStamp(const std::string &fname) : itsValid(false), itsDevice(0), itsInode(0),
+    itsSize(0), itsMTime(0), itsMTimeNSec(0)
+{
+    struct stat buf;
+    if (stat(fname.c_str(), &buf) == 0) {
+        itsValid = true;
+        itsDevice = buf.st_dev;
+        itsInode = buf.st_ino;
+        itsSize = buf.st_size;
+        itsMTime = buf.st_mtim.tv_sec;
+        itsMTimeNSec = buf.st_mtim.tv_nsec;
+    }
+}
+
+/// @brief check that both stamps refer to the same file
+/// @param[in] other stamp to compare with
+/// @return true, if the device and inode match
+bool FitsFileStamp::sameFile(const FitsFileStamp &other) const
+{
+    return itsValid && other.itsValid && (itsDevice == other.itsDevice) && (itsInode == other.itsInode);
+}
+
+/// @brief check that both stamps refer to the same unmodified file
+/// @param[in] other stamp to compare with
+/// @return true, if the file, its size and modification time match
+bool FitsFileStamp::operator==(const FitsFileStamp &other) const
+{
+    return sameFile(other) && (itsSize == other.itsSize) && (itsMTime == other.itsMTime) &&
+           (itsMTimeNSec == other.itsMTimeNSec);
+}
+
+///////////////////////////////////////////////////
+/// @brief set up parameters for uncompressed images
+FitsCompression::FitsCompression() : itsAlgorithm(UNCOMPRESSED), itsQuantizeLevel(4.),
+    itsDither(DITHER_SUBTRACTIVE_1), itsHCompScale(0.)
+{
+}
+
+/// @brief set up compression parameters
+/// @param[in] algorithm compression algorithm
+/// @param[in] tile tile shape, the default (empty shape) is one plane per tile
+/// @param[in] quantizeLevel quantisation level (cfitsio convention), zero turns quantisation off
+/// @param[in] dither dithering method used for quantisation
+/// @param[in] hcompScale HCOMPRESS scale factor
+FitsCompression::FitsCompression(Algorithm algorithm, const casacore::IPosition &tile, float quantizeLevel,
+                                 Dither dither, float hcompScale) : itsAlgorithm(algorithm), itsTile(tile),
+    itsQuantizeLevel(quantizeLevel), itsDither(dither), itsHCompScale(hcompScale)
+{
+}
+
+/// @brief read compression parameters from the parset
+/// @param[in] parset parset with parameters
+/// @return compression parameters
+FitsCompression FitsCompression::fromParset(const LOFAR::ParameterSet &parset)
+{
+    FitsCompression result;
+    const std::string algorithm = toLower(parset.getString("imagecompress", "none"));
+    if (algorithm == "none") {
+        return result;
+    } else if (algorithm == "rice") {
+        result.itsAlgorithm = RICE;
+    } else if (algorithm == "gzip") {
+        result.itsAlgorithm = GZIP;
+    } else if (algorithm == "gzip2") {
+        result.itsAlgorithm = GZIP2;
+    } else if (algorithm == "hcompress") {
+        result.itsAlgorithm = HCOMPRESS;
+    } else {
+        ASKAPTHROW(AskapError, "Unknown FITS compression " << algorithm <<
+                   ", supported values are none, rice, gzip, gzip2 and hcompress");
+    }
+    const std::vector<int> tile = parset.getIntVector("imagecompress.tile", std::vector<int>());
+    result.itsTile.resize(tile.size());
+    for (size_t axis = 0; axis < tile.size(); ++axis) {
+         result.itsTile[axis] = tile[axis];
+    }
+    result.itsQuantizeLevel = parset.getFloat("imagecompress.quantize", 4.);
+    const std::string dither = toLower(parset.getString("imagecompress.dither", "subtractive1"));
+    if (dither == "none") {
+        result.itsDither = DITHER_NONE;
+    } else if (dither == "subtractive1") {
+        result.itsDither = DITHER_SUBTRACTIVE_1;
+    } else if (dither == "subtractive2") {
+        result.itsDither = DITHER_SUBTRACTIVE_2;
+    } else {
+        ASKAPTHROW(AskapError, "Unknown dithering method " << dither <<
+                   ", supported values are none, subtractive1 and subtractive2");
+    }
+    result.itsHCompScale = parset.getFloat("imagecompress.hcompscale", 0.);
+    return result;
+}
+
+/// @brief tile shape for the image of the given shape
+/// @details Missing trailing dimensions of the tile shape are set to 1.
+/// @param[in] shape image shape
+/// @return tile shape (same dimensionality as the image)
+casacore::IPosition FitsCompression::tileShape(const casacore::IPosition &shape) const
+{
+    ASKAPCHECK(itsTile.nelements() <= shape.nelements(), "Tile shape " << itsTile <<
+               " has more dimensions than the image " << shape);
+    casacore::IPosition tile(shape.nelements(), 1);
+    if (itsTile.nelements() == 0) {
+        for (casacore::uInt axis = 0; (axis < 2) && (axis < shape.nelements()); ++axis) {
+             tile[axis] = shape[axis];
+        }
+    } else {
+        for (casacore::uInt axis = 0; axis < itsTile.nelements(); ++axis) {
+             ASKAPCHECK(itsTile[axis] > 0, "Tile shape " << itsTile << " should be positive");
+             tile[axis] = std::min(itsTile[axis], shape[axis]);
+        }
+    }
+    return tile;
+}
+
+///////////////////////////////////////////////////
+FITSImageRW::FITSImageRW(const std::string &name) : itsFastAlloc(false), itsFptr(nullptr),
+    itsReadWrite(false), itsModified(false), itsReservedKeywords(0), itsInHeaderUpdate(false), itsImageHDU(1),
+    itsBitpix(-32), itsBScale(1.), itsBZero(0.), itsHasBlank(false), itsBlank(0), itsAutoScale(false),
+    itsIncrementalChecksum(false), itsChecksumValid(false), itsChecksumPixels(0)
 {
     std::string fullname = name + ".fits";
     this->name = std::string(fullname.c_str());
 }
-FITSImageRW::FITSImageRW(bool useFastAlloc): itsFastAlloc(useFastAlloc)
+FITSImageRW::FITSImageRW(bool useFastAlloc): itsFastAlloc(useFastAlloc), itsFptr(nullptr),
+    itsReadWrite(false), itsModified(false), itsReservedKeywords(0), itsInHeaderUpdate(false), itsImageHDU(1),
+    itsBitpix(-32), itsBScale(1.), itsBZero(0.), itsHasBlank(false), itsBlank(0), itsAutoScale(false),
+    itsIncrementalChecksum(false), itsChecksumValid(false), itsChecksumPixels(0)
 {
 
 }
+
+/// @brief obtain the handle of the open file
+/// @details The file is opened on the first call and kept open until it is closed explicitly,
+/// the object is destroyed or a handle with write access is requested for a file opened read-only.
+/// The handle is dropped if the file has been replaced or modified since it was opened (or flushed).
+/// Our own writes change the modification time, so only the identity of the file is checked while
+/// there are changes which haven't been flushed. The HDU with the image is made current, this is
+/// the first extension for tile-compressed images (primary HDU without data followed by the
+/// compressed image) and the primary HDU otherwise.
+/// @param[in] mode READONLY or READWRITE
+/// @return cfitsio file pointer (owned by this object)
+fitsfile* FITSImageRW::openFile(int mode) const
+{
+    if (itsFptr != nullptr) {
+        const FitsFileStamp stamp(this->name);
+        const bool changed = itsModified ? !stamp.sameFile(itsStamp) : !(stamp == itsStamp);
+        if (changed) {
+            ASKAPLOG_DEBUG_STR(FITSlogger, "File " << this->name << " has been changed externally, reopening");
+            closeFile();
+        } else if ((mode == READWRITE) && !itsReadWrite) {
+            closeFile();
+        }
+    }
+    int status = 0;
+    if (itsFptr == nullptr) {
+        if (fits_open_file(&itsFptr, this->name.c_str(), mode, &status))
+            printerror(status);
+        itsReadWrite = (mode == READWRITE);
+        itsStamp = FitsFileStamp(this->name);
+        {
+          boost::lock_guard<boost::recursive_mutex> lock(openFileRegistryMutex());
+          openFileRegistry().insert(this);
+        }
+        itsImageHDU = 1;
+        int naxis = 0;
+        if (fits_get_img_dim(itsFptr, &naxis, &status))
+            printerror(status);
+        if (naxis == 0) {
+            int hdutype;
+            if (fits_movabs_hdu(itsFptr, 2, &hdutype, &status) == 0) {
+                if (fits_is_compressed_image(itsFptr, &status)) {
+                    itsImageHDU = 2;
+                }
+            }
+            status = 0;
+            if (itsImageHDU == 1) {
+                if (fits_movabs_hdu(itsFptr, 1, &hdutype, &status))
+                    printerror(status);
+            } else if (fits_get_img_dim(itsFptr, &naxis, &status)) {
+                printerror(status);
+            }
+        }
+        // the geometry doesn't change while the file is open
+        itsAxes.resize(naxis);
+        if ((naxis > 0) && fits_get_img_size(itsFptr, naxis, itsAxes.data(), &status))
+            printerror(status);
+        // data format, used to quantise the pixels of integer images
+        if (fits_get_img_type(itsFptr, &itsBitpix, &status))
+            printerror(status);
+        itsBScale = 1.;
+        itsBZero = 0.;
+        itsHasBlank = false;
+        if ((itsImageHDU == 1) && (itsBitpix > 0)) {
+            if (fits_read_key(itsFptr, TDOUBLE, "BSCALE", &itsBScale, nullptr, &status) == KEY_NO_EXIST) {
+                itsBScale = 1.;
+            }
+            status = 0;
+            if (fits_read_key(itsFptr, TDOUBLE, "BZERO", &itsBZero, nullptr, &status) == KEY_NO_EXIST) {
+                itsBZero = 0.;
+            }
+            status = 0;
+            itsHasBlank = (fits_read_key(itsFptr, TLONG, "BLANK", &itsBlank, nullptr, &status) == 0);
+            status = 0;
+        }
+    } else {
+        int hdutype;
+        if (fits_movabs_hdu(itsFptr, itsImageHDU, &hdutype, &status))
+            printerror(status);
+    }
+    if (mode == READWRITE) {
+        itsModified = true;
+    }
+    return itsFptr;
+}
+
+/// @brief write buffered changes to disk
+/// @details The file is kept open between calls, so the changes may stay in the
+/// cfitsio buffers until the file is closed. This method makes them visible to
+/// readers which don't use this object (e.g. casacore::FITSImage). The stamp is
+/// updated, so the modifications done by others after the flush can be detected.
+/// @return true, if anything has been written since the last flush
+bool FITSImageRW::flushFile() const
+{
+    if ((itsFptr == nullptr) || !itsModified) {
+        return false;
+    }
+    int status = 0;
+    // fits_flush_buffer would be faster, but it doesn't update the size of the tables
+    if (fits_flush_file(itsFptr, &status))
+        printerror(status);
+    itsModified = false;
+    itsStamp = FitsFileStamp(this->name);
+    return true;
+}
+
+/// @brief close the file
+/// @details The file is reopened on demand, this method can be used to release the
+/// handle or to pick up modifications done outside of this object.
+void FITSImageRW::closeFile() const
+{
+    if (itsFptr != nullptr) {
+        {
+          boost::lock_guard<boost::recursive_mutex> lock(openFileRegistryMutex());
+          openFileRegistry().erase(this);
+        }
+        int status = 0;
+        fitsfile *fptr = itsFptr;
+        itsFptr = nullptr;
+        itsModified = false;
+        if (fits_close_file(fptr, &status))
+            printerror(status);
+    }
+}
+
+/// @brief close all handles of the given file kept open in this process
+/// @details This is done before the file is replaced, otherwise cfitsio would reuse
+/// the handle of the old file when the new one is opened.
+/// @param[in] fname file name (including the extension)
+void FITSImageRW::closeAll(const std::string &fname)
+{
+    boost::lock_guard<boost::recursive_mutex> lock(openFileRegistryMutex());
+    const std::set<const FITSImageRW*> objects(openFileRegistry());
+    for (std::set<const FITSImageRW*>::const_iterator it = objects.begin(); it != objects.end(); ++it) {
+         if ((*it)->fileName() == fname) {
+             (*it)->closeFile();
+         }
+    }
+}
 bool FITSImageRW::create(const std::string &name, const casacore::IPosition &shape, \
                          const casacore::CoordinateSystem &csys, \
                          uint memoryInMB, bool preferVelocity, \
@@ -147,10 +561,22 @@ bool FITSImageRW::create(const std::string &name, const casacore::IPosition &sha
     this->history = history;
 
     ASKAPLOG_DEBUG_STR(FITSlogger, "Creating R/W FITSImage " << this->name);
+    ASKAPCHECK(!itsInHeaderUpdate, "Header update should be committed before the image is created");
+    ASKAPCHECK(itsReservedKeywords < 10000, "Unable to reserve space for "<<itsReservedKeywords<<" keywords");
 
+    closeFile();
+    closeAll(this->name);
     unlink(this->name.c_str());
-    std::ofstream outfile(this->name.c_str());
-    ASKAPCHECK(outfile.is_open(), "Cannot open FITS file for output");
+    // the sum of the compressed data can't be derived from the pixels
+    itsChecksumValid = itsIncrementalChecksum && !itsCompression.enabled();
+    itsDataChecksum.reset();
+    itsChecksumPixels = 0;
+    // compressed images are written by cfitsio, otherwise the header is written directly
+    std::ofstream outfile;
+    if (!itsCompression.enabled()) {
+        outfile.open(this->name.c_str());
+        ASKAPCHECK(outfile.is_open(), "Cannot open FITS file for output");
+    }
     ASKAPLOG_INFO_STR(FITSlogger, "Created Empty R/W FITSImage " << this->name);
     ASKAPLOG_DEBUG_STR(FITSlogger, "Generating FITS header");
 
@@ -163,18 +589,35 @@ bool FITSImageRW::create(const std::string &name, const casacore::IPosition &sha
     casacore::Record header;
     casacore::Double b_scale, b_zero;
     ASKAPLOG_DEBUG_STR(FITSlogger, "Created blank FITS header");
-    if (BITPIX == -32) {
+    itsAutoScale = false;
+    if ((BITPIX == -32) || (BITPIX == -64)) {
 
         b_scale = 1.0;
         b_zero = 0.0;
         header.define("bitpix", BITPIX);
-        header.setComment("bitpix", "Floating point (32 bit)");
+        header.setComment("bitpix", BITPIX == -32 ? "Floating point (32 bit)" : "Floating point (64 bit)");
 
     }
 
+    else if ((BITPIX == 16) || (BITPIX == 32)) {
+        ASKAPCHECK(!itsCompression.enabled(), "Integer FITS images can't be tile-compressed, use BITPIX=-32");
+        if (minPix <= maxPix) {
+            FitsPixelConversion::scaling(BITPIX, minPix, maxPix, b_scale, b_zero);
+        } else {
+            // replaced by the first write of the full image
+            b_scale = 1.0;
+            b_zero = 0.0;
+            itsAutoScale = true;
+        }
+        header.define("bitpix", BITPIX);
+        header.setComment("bitpix", BITPIX == 16 ? "Integer (16 bit)" : "Integer (32 bit)");
+        header.define("blank", static_cast<casacore::Int>(FitsPixelConversion::blankValue(BITPIX)));
+        header.setComment("blank", "Value of undefined pixels");
+    }
+
     else {
         error =
-            "BITPIX must be -32 (floating point)";
+            "BITPIX must be -32 or -64 (floating point), 16 or 32 (integer)";
         return false;
     }
     ASKAPLOG_DEBUG_STR(FITSlogger, "Added BITPIX");
@@ -295,6 +738,22 @@ bool FITSImageRW::create(const std::string &name, const casacore::IPosition &sha
         return false;
     }
 
+    // placeholders reserving space for the keywords added later, they are deleted as
+    // the new keywords are written (see makeHeaderSpace)
+    if (itsReservedKeywords > 0) {
+        casacore::Record reserved;
+        for (uint key = 0; key < itsReservedKeywords; ++key) {
+            std::ostringstream keyword;
+            keyword << reservedKeywordPrefix << std::setw(4) << std::setfill('0') << key;
+            reserved.define(keyword.str(), "");
+        }
+        ok = casacore::FITSKeywordUtil::addKeywords(theKeywordList, reserved);
+        if (! ok) {
+            error = "Error reserving space in FITS header";
+            return false;
+        }
+    }
+
     // count how many keywords we have, if close to filling a block (36 keywords),
     // add enough comments to allocate another block to allow for expansion without block inserts (very slow)
     int nkey = theKeywordList.toString().size()/80;
@@ -329,25 +788,32 @@ bool FITSImageRW::create(const std::string &name, const casacore::IPosition &sha
     const size_t cards_size = 2880 * 4;
     char cards[cards_size];
     memset(cards, 0, sizeof(cards));
+    std::string headerCards;
     while (1) {
         if (m_kc.build(cards, theKeywordList)) {
 
-            outfile << cards;
+            headerCards += cards;
             memset(cards, 0, sizeof(cards));
         } else {
             if (cards[0] != 0) {
-                outfile << cards;
+                headerCards += cards;
             }
             break;
         }
 
     }
+    if (itsCompression.enabled()) {
+        createCompressed(headerCards);
+        ASKAPLOG_DEBUG_STR(FITSlogger, "Created tile-compressed image");
+        return true;
+    }
+    outfile << headerCards;
     ASKAPLOG_DEBUG_STR(FITSlogger, "All keywords added to file");
 
     if (itsFastAlloc) {
         // allocate file - this should be quick
         long long pos = outfile.tellp();
-        pos += shape.product() * sizeof(float);
+        pos += shape.product() * (std::abs(BITPIX) / 8);
         // add FITS padding
         if (pos % 2880) {
             pos += 2880 - (pos % 2880);
@@ -373,16 +839,13 @@ bool FITSImageRW::create(const std::string &name, const casacore::IPosition &sha
 }
 void FITSImageRW::print_hdr()
 {
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    fitsfile *fptr = openFile(READONLY);
 
     int status, nkeys, keypos, hdutype, ii, jj;
     char card[FLEN_CARD];   /* standard string lengths defined in fitsioc.h */
 
     status = 0;
 
-    if (fits_open_file(&fptr, this->name.c_str(), READONLY, &status))
-        printerror(status);
-
     /* attempt to move to next HDU, until we get an EOF error */
     for (ii = 1; !(fits_movabs_hdu(fptr, ii, &hdutype, &status)); ii++) {
         /* get no. of keywords */
@@ -404,187 +867,503 @@ void FITSImageRW::print_hdr()
     else
         printerror(status);       /* got an unexpected error                */
 
-    if (fits_close_file(fptr, &status))
-        printerror(status);
-
     return;
 
 }
 bool FITSImageRW::write(const casacore::Array<float> &arr)
 {
-    ASKAPLOG_INFO_STR(FITSlogger, "Writing array to FITS image");
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-
+    ASKAPLOG_HOTPATH_STR(FITSlogger, "Writing array to FITS image");
+    fitsfile *fptr = openFile(READWRITE);
 
     int status = 0;
 
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
-
-    long fpixel = 1;                               /* first pixel to write      */
     size_t nelements = arr.nelements();          /* number of pixels to write */
     bool deleteIt;
     const float *data = arr.getStorage(deleteIt);
-    void *dataptr = (void *) data;
 
-    /* write the array of unsigned integers to the FITS file */
-    if (fits_write_img(fptr, TFLOAT, fpixel, nelements, dataptr, &status))
-        printerror(status);
+    if (itsAutoScale && (itsBitpix > 0)) {
+        // the scaling of the integer image is derived from the data
+        float minPix = 0.;
+        float maxPix = 0.;
+        FitsPixelConversion::dataRange(data, nelements, minPix, maxPix);
+        FitsPixelConversion::scaling(itsBitpix, minPix, maxPix, itsBScale, itsBZero);
+        ASKAPLOG_DEBUG_STR(FITSlogger, "Pixels from " << minPix << " to " << maxPix << " are stored with BSCALE = " <<
+                           itsBScale << ", BZERO = " << itsBZero);
+        if (fits_update_key(fptr, TDOUBLE, "BSCALE", &itsBScale, nullptr, &status))
+            printerror(status);
+        if (fits_update_key(fptr, TDOUBLE, "BZERO", &itsBZero, nullptr, &status))
+            printerror(status);
+        itsAutoScale = false;
+    }
 
-    if (fits_close_file(fptr, &status))
-        printerror(status);
+    std::vector<long> fpixel(itsAxes.size(), 1);
+    std::vector<long> lpixel(itsAxes.begin(), itsAxes.end());
+    writePixels(fptr, fpixel, lpixel, true, data, nelements);
+    arr.freeStorage(data, deleteIt);
 
     return true;
 }
 
 
+/// @brief write a hyper-rectangular block
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner of the block
+/// @return true on success
 bool FITSImageRW::write(const casacore::Array<float> &arr, const casacore::IPosition &where)
 {
-    ASKAPLOG_INFO_STR(FITSlogger, "Writing array to FITS image at (Cindex)" << where);
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    return writeBlock(arr, where);
+}
 
-    int status, hdutype;
+/// @brief write a hyper-rectangular block of double precision pixels
+/// @details The pixels are stored without loss of precision into images with BITPIX=-64
+/// and converted by cfitsio for BITPIX=-32.
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner of the block
+/// @return true on success
+bool FITSImageRW::write(const casacore::Array<double> &arr, const casacore::IPosition &where)
+{
+    return writeBlock(arr, where);
+}
 
+/// @brief write a hyper-rectangular block
+/// @details The block may have any number of dimensions up to the dimensionality of the
+/// image, missing trailing axes are treated as degenerate. Blocks which are contiguous in
+/// the file (e.g. a number of whole planes) are written in one go.
+/// @param[in] arr array with pixels (float or double)
+/// @param[in] where bottom left corner of the block
+/// @return true on success
+template <typename T>
+bool FITSImageRW::writeBlock(const casacore::Array<T> &arr, const casacore::IPosition &where)
+{
+    ASKAPLOG_HOTPATH_STR(FITSlogger, "Writing array to FITS image at (Cindex)" << where);
+    // the image HDU is made current by openFile, the geometry is cached when the file is opened
+    fitsfile *fptr = openFile(READWRITE);
+    const std::vector<long> &axes = itsAxes;
+    const int naxes = axes.size();
 
-    status = 0;
+    ASKAPCHECK(where.nelements() == naxes,
+               "Mismatch in dimensions - FITS file has " << naxes
+               << " axes, while requested location has " << where.nelements());
+    ASKAPCHECK(arr.ndim() <= naxes, "Array with the shape " << arr.shape() << " has more dimensions than the image");
+    if (arr.nelements() == 0) {
+        return true;
+    }
 
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
+    // the block is hyper-rectangular, trailing axes missing in the array are degenerate
+    std::vector<long> fpixel(naxes);
+    std::vector<long> lpixel(naxes);
+    for (int axis = 0; axis < naxes; ++axis) {
+         const long length = axis < static_cast<int>(arr.ndim()) ? arr.shape()[axis] : 1;
+         fpixel[axis] = where[axis] + 1;
+         lpixel[axis] = where[axis] + length;
+         ASKAPCHECK((fpixel[axis] >= 1) && (lpixel[axis] <= axes[axis]), "Slice with the shape " << arr.shape() <<
+                    " at " << where << " is outside the image along axis " << axis);
+    }
 
-    if (fits_movabs_hdu(fptr, 1, &hdutype, &status))
-        printerror(status);
+    if (itsImageHDU != 1) {
+        // tiles should be compressed once, rewriting them would waste space in the file
+        checkTileAlignment(fptr, naxes, axes.data(), fpixel.data(), lpixel.data());
+    }
 
-    // get the dimensionality & size of the fits file.
-    int naxes;
-    if (fits_get_img_dim(fptr, &naxes, &status)) {
-        printerror(status);
+    // the block is contiguous in the file if it covers whole axes up to some axis k,
+    // any part of the axis k and a single pixel along the higher axes
+    int axis = 0;
+    while ((axis < naxes) && (fpixel[axis] == 1) && (lpixel[axis] == axes[axis])) {
+           ++axis;
     }
-    long *axes = new long[naxes];
-    if (fits_get_img_size(fptr, naxes, axes, &status)) {
-        printerror(status);
+    bool contiguous = true;
+    for (++axis; axis < naxes; ++axis) {
+         contiguous &= (fpixel[axis] == lpixel[axis]);
     }
 
-    ASKAPCHECK(where.nelements() == naxes,
-               "Mismatch in dimensions - FITS file has " << naxes
-               << " axes, while requested location has " << where.nelements());
+    ASKAPCHECK(!itsAutoScale || (itsBitpix < 0), "Scaling of the integer image " << this->name <<
+               " is derived from the data, the full image should be written before any slices");
+    const LONGLONG nelements = arr.nelements();
+    bool deleteIt = false;
+    const T *data = arr.getStorage(deleteIt);
+    writePixels(fptr, fpixel, lpixel, contiguous, data, nelements);
+    arr.freeStorage(data, deleteIt);
 
-    long fpixel[4], lpixel[4];
-    int array_dim = arr.shape().nelements();
-    int location_dim = where.nelements();
-    ASKAPLOG_DEBUG_STR(FITSlogger, "There are " << array_dim << " dimensions in the slice");
-    ASKAPLOG_DEBUG_STR(FITSlogger," There are " << location_dim << " dimensions in the place");
-
-    fpixel[0] = where[0] + 1;
-    lpixel[0] = where[0] + arr.shape()[0];
-    ASKAPLOG_DEBUG_STR(FITSlogger, "fpixel[0] = " << fpixel[0] << ", lpixel[0] = " << lpixel[0]);
-    fpixel[1] = where[1] + 1;
-    lpixel[1] = where[1] + arr.shape()[1];
-    ASKAPLOG_DEBUG_STR(FITSlogger, "fpixel[1] = " << fpixel[1] << ", lpixel[1] = " << lpixel[1]);
-
-    if (array_dim == 2 && location_dim >= 3) {
-        ASKAPLOG_DEBUG_STR(FITSlogger,"Writing a single slice into an array");
-        fpixel[2] = where[2] + 1;
-        lpixel[2] = where[2] + 1;
-        ASKAPLOG_DEBUG_STR(FITSlogger, "fpixel[2] = " << fpixel[2] << ", lpixel[2] = " << lpixel[2]);
-        if (location_dim == 4) {
-            fpixel[3] = where[3] + 1;
-            lpixel[3] = where[3] + 1;
-            ASKAPLOG_DEBUG_STR(FITSlogger, "fpixel[3] = " << fpixel[3] << ", lpixel[3] = " << lpixel[3]);
+    ASKAPLOG_HOTPATH_STR(FITSlogger, "Written " << nelements << " elements");
+    return true;
+}
+
+/// @brief write pixels into the image HDU
+/// @details Floating point pixels are passed to cfitsio as they are. Pixels of integer
+/// images are quantised with the scaling of the image in one pass and written raw.
+/// @param[in] fptr FITS file pointer, the image HDU should be current
+/// @param[in] fpixel first pixel of the block (1-based)
+/// @param[in] lpixel last pixel of the block (1-based, inclusive)
+/// @param[in] contiguous true, if the block is contiguous in the file
+/// @param[in] data pixels of the block
+/// @param[in] nelements number of pixels
+void FITSImageRW::writePixels(fitsfile *fptr, std::vector<long> &fpixel, std::vector<long> &lpixel,
+                              bool contiguous, const float *data, LONGLONG nelements)
+{
+    int status = 0;
+    int datatype = TFLOAT;
+    void *buffer = const_cast<float*>(data);
+    std::vector<short> shorts;
+    std::vector<int> ints;
+    if (itsBitpix > 0) {
+        // quantise ourselves to get rounding and NaN handling right, cfitsio shouldn't scale again
+        if (itsBitpix == 16) {
+            shorts.resize(nelements);
+            buffer = shorts.data();
+            datatype = TSHORT;
+        } else {
+            ASKAPCHECK(itsBitpix == 32, "Writing into FITS image with BITPIX=" << itsBitpix << " is not supported");
+            ints.resize(nelements);
+            buffer = ints.data();
+            datatype = TINT;
         }
+        FitsPixelConversion::quantise(data, nelements, itsBitpix, itsBScale, itsBZero, itsHasBlank, itsBlank, buffer);
+        if (fits_set_bscale(fptr, 1., 0., &status))
+            printerror(status);
     }
-    else if (array_dim == 3 && location_dim >= 3) {
-        ASKAPLOG_DEBUG_STR(FITSlogger,"Writing more than 1 slice into the array");
-        fpixel[2] = where[2] + 1;
-        lpixel[2] = where[2] + arr.shape()[2];
-        ASKAPLOG_DEBUG_STR(FITSlogger, "fpixel[2] = " << fpixel[2] << ", lpixel[2] = " << lpixel[2]);
-        if (location_dim == 4) {
-            fpixel[3] = where[3] + 1;
-            lpixel[3] = where[3] + 1;
-            ASKAPLOG_DEBUG_STR(FITSlogger, "fpixel[3] = " << fpixel[3] << ", lpixel[3] = " << lpixel[3]);
-        }
+    if (contiguous) {
+        ASKAPLOG_HOTPATH_STR(FITSlogger, "Writing " << nelements << " contiguous elements");
+        std::vector<LONGLONG> first(fpixel.begin(), fpixel.end());
+        fits_write_pixll(fptr, datatype, first.data(), nelements, buffer, &status);
+    } else {
+        ASKAPLOG_HOTPATH_STR(FITSlogger, "Writing " << nelements << " elements of a hyper-rectangular block");
+        fits_write_subset(fptr, datatype, fpixel.data(), lpixel.data(), buffer, &status);
     }
-    else if (array_dim == 4 && location_dim == 4) {
-        fpixel[2] = where[2] + 1;
-        lpixel[2] = where[2] + arr.shape()[2];
-        ASKAPLOG_DEBUG_STR(FITSlogger, "fpixel[2] = " << fpixel[2] << ", lpixel[2] = " << lpixel[2]);
-        fpixel[3] = where[3] + 1;
-        lpixel[3] = where[3] + arr.shape()[3];
-        ASKAPLOG_DEBUG_STR(FITSlogger, "fpixel[3] = " << fpixel[3] << ", lpixel[3] = " << lpixel[3]);
+    if (itsBitpix > 0) {
+        // restore the scaling for reads
+        int scaleStatus = 0;
+        fits_set_bscale(fptr, itsBScale, itsBZero, &scaleStatus);
     }
+    if (status)
+        printerror(status);
+    if (itsChecksumValid) {
+        const casacore::uInt ndim = itsAxes.size();
+        casacore::IPosition imageShape(ndim), blc(ndim), blockShape(ndim);
+        for (casacore::uInt dim = 0; dim < ndim; ++dim) {
+             imageShape[dim] = itsAxes[dim];
+             blc[dim] = fpixel[dim] - 1;
+             blockShape[dim] = lpixel[dim] - fpixel[dim] + 1;
+        }
+        itsDataChecksum.addBlock(data, imageShape, blc, blockShape, itsBitpix, itsBScale, itsBZero,
+                                 itsHasBlank, itsBlank);
+        itsChecksumPixels += nelements;
+    }
+}
 
+/// @brief write double precision pixels into the image HDU
+/// @details Only floating point images are supported, cfitsio converts the pixels
+/// if BITPIX=-32.
+/// @param[in] fptr FITS file pointer, the image HDU should be current
+/// @param[in] fpixel first pixel of the block (1-based)
+/// @param[in] lpixel last pixel of the block (1-based, inclusive)
+/// @param[in] contiguous true, if the block is contiguous in the file
+/// @param[in] data pixels of the block
+/// @param[in] nelements number of pixels
+void FITSImageRW::writePixels(fitsfile *fptr, std::vector<long> &fpixel, std::vector<long> &lpixel,
+                              bool contiguous, const double *data, LONGLONG nelements)
+{
+    ASKAPCHECK(itsBitpix < 0, "Double precision pixels can't be written into the integer image " << this->name <<
+               " (BITPIX=" << itsBitpix << ")");
+    // the data sum is only accumulated for single precision pixels
+    itsChecksumValid = false;
+    int status = 0;
+    double *buffer = const_cast<double*>(data);
+    if (contiguous) {
+        std::vector<LONGLONG> first(fpixel.begin(), fpixel.end());
+        fits_write_pixll(fptr, TDOUBLE, first.data(), nelements, buffer, &status);
+    } else {
+        fits_write_subset(fptr, TDOUBLE, fpixel.data(), lpixel.data(), buffer, &status);
+    }
+    if (status)
+        printerror(status);
+}
 
-    int64_t nelements = arr.nelements();          /* number of pixels to write */
-
-    ASKAPLOG_DEBUG_STR(FITSlogger, "We are writing " << nelements << " elements");
-    bool deleteIt = false;
-    const float *data = arr.getStorage(deleteIt);
-    float *dataptr = (float *) data;
-
-    // status = 0;
-
-    // if ( fits_write_pix(fptr, TFLOAT,fpixel, nelements, dataptr, &status) )
-    //     printerror( status );
-
-    status = 0;
-    long group = 0;
+/// @brief write the tile-compressed image and its header
+/// @details cfitsio creates an empty primary HDU followed by the compressed image. The cards
+/// built for the uncompressed image are copied into the header of the compressed image, except
+/// for the structural keywords which cfitsio writes itself.
+/// @param[in] cards header cards (80 characters each, up to the END card)
+void FITSImageRW::createCompressed(const std::string &cards)
+{
+    const casacore::uInt ndim = shape.nelements();
+    const casacore::IPosition tile = itsCompression.tileShape(shape);
+    ASKAPLOG_INFO_STR(FITSlogger, "Writing tile-compressed image with tile shape " << tile);
+    int type = RICE_1;
+    switch (itsCompression.itsAlgorithm) {
+        case FitsCompression::RICE: type = RICE_1; break;
+        case FitsCompression::GZIP: type = GZIP_1; break;
+        case FitsCompression::GZIP2: type = GZIP_2; break;
+        case FitsCompression::HCOMPRESS: type = HCOMPRESS_1; break;
+        default: ASKAPTHROW(AskapError, "Unsupported compression algorithm " << itsCompression.itsAlgorithm);
+    }
+    const bool gzip = (itsCompression.itsAlgorithm == FitsCompression::GZIP) ||
+                      (itsCompression.itsAlgorithm == FitsCompression::GZIP2);
+    ASKAPCHECK(gzip || (itsCompression.itsQuantizeLevel != 0.),
+               "Floating point images can be compressed without quantisation by GZIP only");
+    if (itsCompression.itsAlgorithm == FitsCompression::HCOMPRESS) {
+        ASKAPCHECK((ndim >= 2) && (tile[0] >= 4) && (tile[1] >= 4) && (tile.product() == tile[0] * tile[1]),
+                   "HCOMPRESS requires 2-dimensional tiles of at least 4x4 pixels, tile shape " << tile);
+    }
 
-    if (fits_write_subset_flt(fptr, group, naxes, axes, fpixel, lpixel, dataptr, &status))
+    fitsfile *fptr = nullptr;
+    int status = 0;
+    if (fits_create_file(&fptr, this->name.c_str(), &status))
+        printerror(status);
+    if (fits_set_compression_type(fptr, type, &status))
+        printerror(status);
+    std::vector<long> tileDim(ndim);
+    std::vector<long> naxes(ndim);
+    for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+         tileDim[axis] = tile[axis];
+         naxes[axis] = shape[axis];
+    }
+    if (fits_set_tile_dim(fptr, ndim, tileDim.data(), &status))
+        printerror(status);
+    if (fits_set_quantize_level(fptr, itsCompression.itsQuantizeLevel, &status))
+        printerror(status);
+    int dither = SUBTRACTIVE_DITHER_1;
+    if (itsCompression.itsDither == FitsCompression::DITHER_NONE) {
+        dither = NO_DITHER;
+    } else if (itsCompression.itsDither == FitsCompression::DITHER_SUBTRACTIVE_2) {
+        dither = SUBTRACTIVE_DITHER_2;
+    }
+    if (fits_set_quantize_method(fptr, dither, &status))
+        printerror(status);
+    if (itsCompression.itsAlgorithm == FitsCompression::HCOMPRESS) {
+        if (fits_set_hcomp_scale(fptr, itsCompression.itsHCompScale, &status))
+            printerror(status);
+    }
+    if (fits_create_img(fptr, BITPIX == -64 ? DOUBLE_IMG : FLOAT_IMG, ndim, naxes.data(), &status))
         printerror(status);
 
-    ASKAPLOG_INFO_STR(FITSlogger, "Written " << nelements << " elements");
-    status = 0;
-
+    for (size_t pos = 0; pos + 80 <= cards.size(); pos += 80) {
+         const std::string card = cards.substr(pos, 80);
+         const std::string keyword = boost::algorithm::trim_right_copy(card.substr(0, 8));
+         if (keyword == "END") {
+             break;
+         }
+         if ((keyword == "SIMPLE") || (keyword == "BITPIX") || (keyword.compare(0, 5, "NAXIS") == 0) ||
+             (keyword == "EXTEND") || (keyword == "PCOUNT") || (keyword == "GCOUNT") ||
+             (keyword == "BSCALE") || (keyword == "BZERO")) {
+             continue;
+         }
+         if (fits_write_record(fptr, card.c_str(), &status))
+             printerror(status);
+    }
     if (fits_close_file(fptr, &status))
         printerror(status);
+}
 
-    delete [] axes;
-
-    return true;
+/// @brief check that the given section covers whole tiles of the compressed image
+/// @details cfitsio can update partially covered tiles, but each rewritten tile is appended
+/// to the heap leaving the old version behind. Hence the sections have to start at a tile
+/// boundary and end either at a tile boundary or at the edge of the image.
+/// @param[in] fptr FITS file pointer, the image HDU should be current
+/// @param[in] naxes number of image axes
+/// @param[in] axes image shape
+/// @param[in] fpixel first pixel of the section (1-based)
+/// @param[in] lpixel last pixel of the section (1-based, inclusive)
+void FITSImageRW::checkTileAlignment(fitsfile *fptr, int naxes, const long *axes, const long *fpixel,
+                                     const long *lpixel) const
+{
+    for (int axis = 0; axis < naxes; ++axis) {
+         std::ostringstream keyword;
+         keyword << "ZTILE" << axis + 1;
+         long tile = 1;
+         int status = 0;
+         if (fits_read_key(fptr, TLONG, keyword.str().c_str(), &tile, nullptr, &status)) {
+             // cfitsio default is row by row
+             tile = (axis == 0 ? axes[0] : 1);
+         }
+         ASKAPCHECK(((fpixel[axis] - 1) % tile == 0) && ((lpixel[axis] % tile == 0) || (lpixel[axis] == axes[axis])),
+                    "Section from pixel " << fpixel[axis] << " to " << lpixel[axis] << " along axis " << axis + 1 <<
+                    " is not aligned with the compression tiles of " << tile << " pixel(s)");
+    }
+}
 
+/// @return true, if the image is tile-compressed
+bool FITSImageRW::isCompressed() const
+{
+    openFile(READONLY);
+    return itsImageHDU != 1;
 }
-void FITSImageRW::setUnits(const std::string &units)
+
+/// @return shape of the image
+casacore::IPosition FITSImageRW::imageShape() const
 {
-    ASKAPLOG_INFO_STR(FITSlogger, "Updating brightness units");
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    int status = 0;
+    openFile(READONLY);
+    casacore::IPosition result(itsAxes.size());
+    for (size_t axis = 0; axis < itsAxes.size(); ++axis) {
+         result[axis] = itsAxes[axis];
+    }
+    return result;
+}
 
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
+/// @brief read part of the image through cfitsio
+/// @details This works for both compressed and uncompressed images.
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return array with pixels for the selection only
+casacore::Array<float> FITSImageRW::read(const casacore::IPosition &blc, const casacore::IPosition &trc) const
+{
+    casacore::Array<float> result;
+    read(blc, trc, result);
+    return result;
+}
 
-    if (fits_update_key(fptr, TSTRING, "BUNIT", (void *)(units.c_str()),
-                        "Brightness (pixel) unit", &status))
-        printerror(status);
+/// @brief read part of the image through cfitsio into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @param[out] buffer array to fill with pixels for the selection
+void FITSImageRW::read(const casacore::IPosition &blc, const casacore::IPosition &trc,
+                       casacore::Array<float> &buffer) const
+{
+    readBlock(blc, trc, casacore::IPosition(), TFLOAT, buffer);
+}
 
-    if (fits_close_file(fptr, &status))
-        printerror(status);
+/// @brief read part of the image in double precision through cfitsio into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @param[out] buffer array to fill with pixels for the selection
+void FITSImageRW::read(const casacore::IPosition &blc, const casacore::IPosition &trc,
+                       casacore::Array<double> &buffer) const
+{
+    readBlock(blc, trc, casacore::IPosition(), TDOUBLE, buffer);
+}
 
+/// @brief read every stride-th pixel of part of the image through cfitsio
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @param[in] stride increment along each axis
+/// @param[out] buffer array to fill with pixels, (trc - blc) / stride + 1 along each axis
+void FITSImageRW::read(const casacore::IPosition &blc, const casacore::IPosition &trc,
+                       const casacore::IPosition &stride, casacore::Array<float> &buffer) const
+{
+    ASKAPCHECK(stride.nelements() == blc.nelements(), "Stride " << stride << " doesn't match the selection from " <<
+               blc << " to " << trc);
+    readBlock(blc, trc, stride, TFLOAT, buffer);
 }
 
-void FITSImageRW::setHeader(const std::string &keyword, const std::string &value, const std::string &desc)
+/// @brief read part of the image through cfitsio
+/// @details This works for both compressed and uncompressed images.
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @param[in] stride increment along each axis, empty for all pixels
+/// @param[in] datatype cfitsio data type matching T (TFLOAT or TDOUBLE)
+/// @param[out] buffer array to fill with pixels for the selection
+template <typename T>
+void FITSImageRW::readBlock(const casacore::IPosition &blc, const casacore::IPosition &trc,
+                            const casacore::IPosition &stride, int datatype, casacore::Array<T> &buffer) const
 {
-    ASKAPLOG_INFO_STR(FITSlogger, "Setting header value for " << keyword);
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    ASKAPCHECK(blc.nelements() == trc.nelements(), "Corners of the selection have different dimensions: " <<
+               blc << " and " << trc);
+    fitsfile *fptr = openFile(READONLY);
+    const casacore::uInt ndim = blc.nelements();
+    std::vector<long> fpixel(ndim);
+    std::vector<long> lpixel(ndim);
+    std::vector<long> inc(ndim, 1);
+    casacore::IPosition shape(ndim);
+    for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+         ASKAPCHECK(trc[axis] >= blc[axis], "Empty selection from " << blc << " to " << trc);
+         if (stride.nelements() > 0) {
+             ASKAPCHECK(stride[axis] > 0, "Stride should be positive, you have " << stride);
+             inc[axis] = stride[axis];
+         }
+         fpixel[axis] = blc[axis] + 1;
+         lpixel[axis] = trc[axis] + 1;
+         shape[axis] = (trc[axis] - blc[axis]) / inc[axis] + 1;
+    }
+    if (!buffer.shape().isEqual(shape)) {
+        buffer.resize(shape);
+    }
+    bool deleteIt = false;
+    T *data = buffer.getStorage(deleteIt);
+    int anynul = 0;
     int status = 0;
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
+    // NaNs of floating point images and BLANK of integer images are returned as NaN
+    T nulval = std::numeric_limits<T>::quiet_NaN();
+    if (fits_read_subset(fptr, datatype, fpixel.data(), lpixel.data(), inc.data(), &nulval, data,
+                         &anynul, &status))
         printerror(status);
+    buffer.putStorage(data, deleteIt);
+}
+void FITSImageRW::setUnits(const std::string &units)
+{
+    ASKAPLOG_INFO_STR(FITSlogger, "Updating brightness units");
+    StagedKeyword kw("BUNIT", TSTRING, "Brightness (pixel) unit");
+    kw.itsString = units;
+    itsStagedKeywords.push_back(kw);
+    if (!itsInHeaderUpdate) {
+        writeStagedUpdates();
+    }
+}
 
+/// @brief read a header keyword as a string
+/// @param[in] keyword name of the keyword
+/// @return pair of strings - keyword value and comment (empty strings if the keyword is not found)
+std::pair<std::string, std::string> FITSImageRW::getHeader(const std::string &keyword) const
+{
+    fitsfile *fptr = openFile(READONLY);
+    int status = 0;
+    char value[FLEN_VALUE];
+    char comment[FLEN_COMMENT];
+    value[0] = 0;
+    comment[0] = 0;
+    if (fits_read_key(fptr, TSTRING, keyword.c_str(), value, comment, &status)) {
+        ASKAPLOG_DEBUG_STR(FITSlogger, "Cannot find keyword " << keyword << " - fits_read_key returned status " << status);
+        value[0] = 0;
+        comment[0] = 0;
+    }
+    return std::pair<std::string, std::string>(std::string(value), std::string(comment));
+}
 
-    if (fits_update_key(fptr, TSTRING, keyword.c_str(), (char *)value.c_str(),
-                        desc.c_str(), &status))
+/// @brief read all header keywords as strings
+/// @details The values are formatted as in getHeader. Cards without a value (COMMENT,
+/// HISTORY) are skipped, the first card is taken if a keyword is repeated.
+/// @return map of keyword names to pairs of strings - keyword value and comment
+std::map<std::string, std::pair<std::string, std::string> > FITSImageRW::getHeaders() const
+{
+    fitsfile *fptr = openFile(READONLY);
+    int status = 0;
+    int nkeys = 0;
+    if (fits_get_hdrspace(fptr, &nkeys, NULL, &status))
         printerror(status);
+    std::map<std::string, std::pair<std::string, std::string> > result;
+    char keyname[FLEN_KEYWORD];
+    char value[FLEN_VALUE];
+    char comment[FLEN_COMMENT];
+    char str[FLEN_VALUE];
+    for (int key = 1; key <= nkeys; ++key) {
+         if (fits_read_keyn(fptr, key, keyname, value, comment, &status))
+             printerror(status);
+         if ((keyname[0] == 0) || (value[0] == 0) || (result.find(keyname) != result.end())) {
+             continue;
+         }
+         // strip the quotes of string values as fits_read_key does
+         if (ffc2s(value, str, &status))
+             printerror(status);
+         result[keyname] = std::pair<std::string, std::string>(std::string(str), std::string(comment));
+    }
+    return result;
+}
 
-    if (fits_close_file(fptr, &status))
-        printerror(status);
+void FITSImageRW::setHeader(const std::string &keyword, const std::string &value, const std::string &desc)
+{
+    ASKAPLOG_INFO_STR(FITSlogger, "Setting header value for " << keyword);
+    StagedKeyword kw(keyword, TSTRING, desc);
+    kw.itsString = value;
+    itsStagedKeywords.push_back(kw);
+    if (!itsInHeaderUpdate) {
+        writeStagedUpdates();
+    }
 }
 
 void FITSImageRW::setHeader(const LOFAR::ParameterSet & keywords)
 {
     ASKAPLOG_INFO_STR(FITSlogger, "Setting header values from parset ");
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    int status = 0;
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status)) {
-        printerror(status);
-    }
 
     for (auto &elem : keywords) {
       const string keyword = elem.first;
@@ -596,10 +1375,9 @@ void FITSImageRW::setHeader(const LOFAR::ParameterSet & keywords)
         const string type = (valanddesc.size() > 2 ? toUpper(valanddesc[2]) : "STRING");
         if (type == "INT") {
           try {
-            int intVal = std::stoi(value);
-            if (fits_update_key(fptr, TINT, keyword.c_str(), &intVal, desc.c_str(), &status)) {
-              printerror(status);
-            }
+            StagedKeyword kw(keyword, TINT, desc);
+            kw.itsInt = std::stoi(value);
+            itsStagedKeywords.push_back(kw);
           } catch (const std::invalid_argument&) {
             ASKAPLOG_WARN_STR(FITSlogger, "Invalid int value for header keyword "<<keyword<<" : "<<value);
           } catch (const std::out_of_range&) {
@@ -607,73 +1385,59 @@ void FITSImageRW::setHeader(const LOFAR::ParameterSet & keywords)
           }
         } else if (type == "DOUBLE") {
           try {
-            double doubleVal = std::stod(value);
-            if (fits_update_key(fptr, TDOUBLE, keyword.c_str(), &doubleVal, desc.c_str(), &status)) {
-              printerror(status);
-            }
+            StagedKeyword kw(keyword, TDOUBLE, desc);
+            kw.itsDouble = std::stod(value);
+            itsStagedKeywords.push_back(kw);
           } catch (const std::invalid_argument&) {
             ASKAPLOG_WARN_STR(FITSlogger, "Invalid double value for header keyword "<<keyword<<" : "<<value);
           } catch (const std::out_of_range&) {
             ASKAPLOG_WARN_STR(FITSlogger, "Out of range double value for header keyword "<<keyword<<" : "<<value);
           }
         } else if (type == "STRING") {
-          if (fits_update_key(fptr, TSTRING, keyword.c_str(), (char *)value.c_str(), desc.c_str(), &status)) {
-            printerror(status);
-          }
+          StagedKeyword kw(keyword, TSTRING, desc);
+          kw.itsString = value;
+          itsStagedKeywords.push_back(kw);
         } else {
           ASKAPLOG_WARN_STR(FITSlogger, "Invalid type for header keyword "<<keyword<<" : "<<type);
         }
 
       }
     }
-
-    if (fits_close_file(fptr, &status)) {
-        printerror(status);
+    // all keywords are written in one go even if there is no transaction in progress
+    if (!itsInHeaderUpdate) {
+        writeStagedUpdates();
     }
 }
 
 void FITSImageRW::setRestoringBeam(double maj, double min, double pa)
 {
     ASKAPLOG_INFO_STR(FITSlogger, "Setting Beam info");
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    int status = 0;
     double radtodeg = 360. / (2 * M_PI);
 
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
-
-    double value = radtodeg * maj;
-    if (fits_update_key(fptr, TDOUBLE, "BMAJ", &value,
-                        "Restoring beam major axis", &status))
-        printerror(status);
-    value = radtodeg * min;
-    if (fits_update_key(fptr, TDOUBLE, "BMIN", &value,
-                        "Restoring beam minor axis", &status))
-        printerror(status);
-    value = radtodeg * pa;
-    if (fits_update_key(fptr, TDOUBLE, "BPA", &value,
-                        "Restoring beam position angle", &status))
-        printerror(status);
-    if (fits_update_key(fptr, TSTRING, "BTYPE", (void *) "Intensity",
-                        " ", &status))
-        printerror(status);
-
-    if (fits_close_file(fptr, &status))
-        printerror(status);
-
+    StagedKeyword kw("BMAJ", TDOUBLE, "Restoring beam major axis");
+    kw.itsDouble = radtodeg * maj;
+    itsStagedKeywords.push_back(kw);
+    kw = StagedKeyword("BMIN", TDOUBLE, "Restoring beam minor axis");
+    kw.itsDouble = radtodeg * min;
+    itsStagedKeywords.push_back(kw);
+    kw = StagedKeyword("BPA", TDOUBLE, "Restoring beam position angle");
+    kw.itsDouble = radtodeg * pa;
+    itsStagedKeywords.push_back(kw);
+    kw = StagedKeyword("BTYPE", TSTRING, " ");
+    kw.itsString = "Intensity";
+    itsStagedKeywords.push_back(kw);
+    if (!itsInHeaderUpdate) {
+        writeStagedUpdates();
+    }
 }
 
 casacore::Vector<casacore::Quantity> FITSImageRW::getRestoringBeam() const
 {
     ASKAPLOG_DEBUG_STR(FITSlogger, "Getting Beam info");
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
+    fitsfile *fptr = openFile(READONLY);
     int status = 0;
     const double radtodeg = 360. / (2 * M_PI);
     char comment[1024];
-
-    if (fits_open_file(&fptr, this->name.c_str(), READONLY, &status)) {
-      printerror(status);
-    }
     double bmaj = 0, bmin = 0, bpa = 0;
     if (fits_read_key(fptr, TDOUBLE, "BMAJ", &bmaj, comment, &status)) {
         ASKAPLOG_WARN_STR(FITSlogger, "FITSImageAccess:: Cannot find keyword BMAJ - fits_read_key returned status " << status);
@@ -682,10 +1446,6 @@ casacore::Vector<casacore::Quantity> FITSImageRW::getRestoringBeam() const
     } else if (fits_read_key(fptr, TDOUBLE, "BPA", &bpa, comment, &status)) {
         ASKAPLOG_WARN_STR(FITSlogger, "FITSImageAccess:: Cannot find keyword BPA - fits_read_key returned status " << status);
     }
-    status=0;
-    if (fits_close_file(fptr, &status)) {
-      printerror(status);
-    }
 
     casacore::Vector<casacore::Quantity> beam(3);
     beam(0) = casacore::Quantity(bmaj/radtodeg,"rad");
@@ -694,19 +1454,87 @@ casacore::Vector<casacore::Quantity> FITSImageRW::getRestoringBeam() const
     return beam;
 }
 
+/// @brief read the restoring beam of a single channel
+/// @details Only the row of the BEAMS table for the given channel is read (the CHAN
+/// column is searched if the rows are not in the channel order). The beam given by
+/// the header keywords is returned if there is no BEAMS table.
+/// @param[in] chan channel number
+/// @return beam vector (major axis, minor axis, position angle)
+casacore::Vector<casacore::Quantity> FITSImageRW::getRestoringBeam(unsigned int chan) const
+{
+    fitsfile *fptr = openFile(READONLY);
+    int status = 0;
+    char extname[] = "BEAMS";
+    int hdutype;
+    if (fits_movnam_hdu(fptr, BINARY_TBL, extname, 0, &status)) {
+        // single beam, go back to the image HDU to read the keywords
+        status = 0;
+        if (fits_movabs_hdu(fptr, itsImageHDU, &hdutype, &status)) {
+            printerror(status);
+        }
+        return getRestoringBeam();
+    }
+    int colBmaj = 0, colBmin = 0, colBpa = 0, colChan = 0;
+    char bmajName[] = "BMAJ", bminName[] = "BMIN", bpaName[] = "BPA", chanName[] = "CHAN";
+    fits_get_colnum(fptr, CASEINSEN, bmajName, &colBmaj, &status);
+    fits_get_colnum(fptr, CASEINSEN, bminName, &colBmin, &status);
+    fits_get_colnum(fptr, CASEINSEN, bpaName, &colBpa, &status);
+    fits_get_colnum(fptr, CASEINSEN, chanName, &colChan, &status);
+    long nRows = 0;
+    fits_get_num_rows(fptr, &nRows, &status);
+    // the table is normally written in the channel order
+    LONGLONG row = static_cast<LONGLONG>(chan) + 1;
+    int rowChan = -1;
+    int anynul = 0;
+    if (row <= nRows) {
+        fits_read_col(fptr, TINT, colChan, row, 1, 1, NULL, &rowChan, &anynul, &status);
+    }
+    if ((status == 0) && (rowChan != static_cast<int>(chan))) {
+        std::vector<int> chans(nRows);
+        fits_read_col(fptr, TINT, colChan, 1, 1, nRows, NULL, chans.data(), &anynul, &status);
+        const std::vector<int>::const_iterator ci = std::find(chans.begin(), chans.end(), static_cast<int>(chan));
+        row = ci != chans.end() ? (ci - chans.begin()) + 1 : 0;
+    }
+    double bmaj = 0., bmin = 0., bpa = 0.;
+    if ((status == 0) && (row > 0)) {
+        fits_read_col(fptr, TDOUBLE, colBmaj, row, 1, 1, NULL, &bmaj, &anynul, &status);
+        fits_read_col(fptr, TDOUBLE, colBmin, row, 1, 1, NULL, &bmin, &anynul, &status);
+        fits_read_col(fptr, TDOUBLE, colBpa, row, 1, 1, NULL, &bpa, &anynul, &status);
+    }
+    fits_movabs_hdu(fptr, itsImageHDU, &hdutype, &status);
+    if (status) {
+        printerror(status);
+    }
+    ASKAPCHECK(row > 0, "There is no beam for channel " << chan << " in " << this->name);
+    casacore::Vector<casacore::Quantity> beam(3);
+    beam(0) = casacore::Quantity(bmaj, "arcsec");
+    beam(1) = casacore::Quantity(bmin, "arcsec");
+    beam(2) = casacore::Quantity(bpa, "deg");
+    return beam;
+}
+
 void FITSImageRW::setRestoringBeam(const BeamList & beamlist)
 {
   ASKAPCHECK(!beamlist.empty(),"Called FITSImageRW::setRestoringBeam with empty beamlist");
+  // set header keyword to indicate beams table is present
+  StagedKeyword kw("CASAMBM", TLOGICAL, "CASA Multiple beams table present");
+  kw.itsInt = 1;
+  itsStagedKeywords.push_back(kw);
+  itsStagedBeamList.reset(new BeamList(beamlist));
+  if (!itsInHeaderUpdate) {
+      writeStagedUpdates();
+  }
+}
+
+/// @brief write the BEAMS binary table
+/// @param[in] fptr FITS file pointer opened for writing
+/// @param[in] beamlist beams for all channels
+void FITSImageRW::writeBeamTable(fitsfile *fptr, const BeamList &beamlist)
+{
   // write multiple beams to a binary table
   ASKAPLOG_INFO_STR(FITSlogger, "Writing BEAMS binary table");
-  fitsfile *fptr;
   // note status is passed on from each call and calls do not execute if status is non zero on entry
   int status = 0;
-  fits_open_file(&fptr, this->name.c_str(), READWRITE, &status);
-
-  // set header keyword to indicate beams table is present
-  int present = 1;
-  fits_update_key(fptr, TLOGICAL, "CASAMBM", &present, "CASA Multiple beams table present", &status);
 
   int nchan = beamlist.size();
   int npol = 1;
@@ -724,23 +1552,26 @@ void FITSImageRW::setRestoringBeam(const BeamList & beamlist)
   fits_write_key(fptr, TINT, "NCHAN", &nchan, "Number of channels", &status);
   fits_write_key(fptr, TINT, "NPOL", &npol, "Number of polarisations", &status);
 
-  int row = 0;
+  // each column is written in one go, row by row writes are slow for large cubes
+  std::vector<float> bmaj, bmin, bpa;
+  std::vector<int> chan;
+  bmaj.reserve(nchan);
+  bmin.reserve(nchan);
+  bpa.reserve(nchan);
+  chan.reserve(nchan);
   for (const auto& beam : beamlist) {
-    row++;
-    // can't make these const due to fits_write_col signature
     ASKAPDEBUGASSERT(beam.second.size()==3);
-    float bmaj = beam.second[0].getValue("arcsec");
-    float bmin = beam.second[1].getValue("arcsec");
-    float bpa = beam.second[2].getValue("deg");
-    int chan = row - 1;
-    int pol = 0;
-    fits_write_col(fptr, TFLOAT, 1, row, 1, 1, &bmaj , &status);
-    fits_write_col(fptr, TFLOAT, 2, row, 1, 1, &bmin, &status);
-    fits_write_col(fptr, TFLOAT, 3, row, 1, 1, &bpa, &status);
-    fits_write_col(fptr, TINT, 4, row, 1, 1, &chan, &status);
-    fits_write_col(fptr, TINT, 5, row, 1, 1, &pol, &status);
+    bmaj.push_back(beam.second[0].getValue("arcsec"));
+    bmin.push_back(beam.second[1].getValue("arcsec"));
+    bpa.push_back(beam.second[2].getValue("deg"));
+    chan.push_back(beam.first);
   }
-  fits_close_file(fptr, &status);
+  std::vector<int> pol(nchan, 0);
+  fits_write_col(fptr, TFLOAT, 1, 1, 1, nchan, bmaj.data(), &status);
+  fits_write_col(fptr, TFLOAT, 2, 1, 1, nchan, bmin.data(), &status);
+  fits_write_col(fptr, TFLOAT, 3, 1, 1, nchan, bpa.data(), &status);
+  fits_write_col(fptr, TINT, 4, 1, 1, nchan, chan.data(), &status);
+  fits_write_col(fptr, TINT, 5, 1, 1, nchan, pol.data(), &status);
 
   if (status) {
     printerror(status);
@@ -749,25 +1580,259 @@ void FITSImageRW::setRestoringBeam(const BeamList & beamlist)
 
 void FITSImageRW::addHistory(const std::vector<std::string> &historyLines)
 {
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    int status = 0;
-    if ( fits_open_file(&fptr, this->name.c_str(), READWRITE, &status) )
-        printerror( status );
-
     for ( const auto& history : historyLines ) {
         ASKAPLOG_INFO_STR(FITSlogger,"Adding HISTORY string: " << history);
-        if ( fits_write_history(fptr, history.c_str(), &status) )
-            printerror( status );
+        itsStagedHistory.push_back(history);
+    }
+    if (!itsInHeaderUpdate) {
+        writeStagedUpdates();
     }
+}
 
+/// @brief write CHECKSUM and DATASUM keywords into all HDUs
+/// @details Unless the data sum has been accumulated during the writes, the data are
+/// read back by cfitsio to compute the sums, so this is as expensive as reading the
+/// whole file.
+void FITSImageRW::writeChecksum()
+{
+    ASKAPCHECK(!itsInHeaderUpdate, "Checksums of "<<this->name<<" can't be written during a header update");
+    if (itsChecksumValid) {
+        const unsigned long long nPixels = std::accumulate(itsAxes.begin(), itsAxes.end(), 1ull,
+                                                           std::multiplies<unsigned long long>());
+        // otherwise some pixels have been overwritten or written by other means
+        if (itsChecksumPixels == nPixels) {
+            writeChecksum(itsDataChecksum);
+            return;
+        }
+        ASKAPLOG_INFO_STR(FITSlogger, itsChecksumPixels << " pixel(s) have been summed for " << this->name <<
+                          " with " << nPixels << " pixel(s), computing checksums from the file");
+    }
+    ASKAPLOG_INFO_STR(FITSlogger, "Writing checksums of " << this->name);
+    fitsfile *fptr = openFile(READWRITE);
+    int status = 0;
+    int nHDU = 0;
+    if (fits_get_num_hdus(fptr, &nHDU, &status))
+        printerror(status);
+    int hdutype;
+    for (int hdu = 1; hdu <= nHDU; ++hdu) {
+         if (fits_movabs_hdu(fptr, hdu, &hdutype, &status))
+             printerror(status);
+         if (fits_write_chksum(fptr, &status))
+             printerror(status);
+    }
+    if (fits_movabs_hdu(fptr, itsImageHDU, &hdutype, &status))
+        printerror(status);
+}
 
-    if ( fits_close_file(fptr, &status) )
-        printerror( status );
+/// @brief write CHECKSUM and DATASUM keywords using the given sum of the image data
+/// @details DATASUM is written first and CHECKSUM is set to zeros, so the header can be
+/// summed as it is in the file. The encoded complement of the header and data sum makes
+/// the sum of the HDU zero as required by the checksum convention.
+/// @param[in] dataSum checksum of the image data unit
+void FITSImageRW::writeChecksum(const FitsChecksum &dataSum)
+{
+    ASKAPCHECK(!itsInHeaderUpdate, "Checksums of "<<this->name<<" can't be written during a header update");
+    ASKAPCHECK(itsImageHDU == 1, "Data sum of the compressed image " << this->name << " can't be given explicitly");
+    ASKAPLOG_INFO_STR(FITSlogger, "Writing checksums of " << this->name << " using the accumulated data sum");
+    fitsfile *fptr = openFile(READWRITE);
+    int status = 0;
+    int hdutype;
+    if (fits_movabs_hdu(fptr, 1, &hdutype, &status))
+        printerror(status);
+    const std::string datasum = std::to_string(dataSum.value());
+    if (fits_update_key_str(fptr, "DATASUM", datasum.c_str(), "data unit checksum updated", &status))
+        printerror(status);
+    if (fits_update_key_str(fptr, "CHECKSUM", "0000000000000000", "HDU checksum updated", &status))
+        printerror(status);
+    if (fits_flush_file(fptr, &status))
+        printerror(status);
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    if (fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status))
+        printerror(status);
+    std::vector<char> header(dataStart - headStart);
+    {
+        std::ifstream file(this->name.c_str(), std::ios::binary);
+        ASKAPCHECK(file.is_open(), "Unable to open " << this->name << " to read the header");
+        file.seekg(headStart);
+        file.read(header.data(), header.size());
+        ASKAPCHECK(file.gcount() == static_cast<std::streamsize>(header.size()), "Unable to read the header of " <<
+                   this->name);
+    }
+    FitsChecksum hduSum(dataSum);
+    hduSum.add(header.data(), header.size(), 0);
+    const std::string checksum = FitsChecksum::encode(hduSum.value());
+    if (fits_update_key_str(fptr, "CHECKSUM", checksum.c_str(), "HDU checksum updated", &status))
+        printerror(status);
+    // other HDUs (e.g. tables) are small, let cfitsio sum them
+    int nHDU = 0;
+    if (fits_get_num_hdus(fptr, &nHDU, &status))
+        printerror(status);
+    for (int hdu = 2; hdu <= nHDU; ++hdu) {
+         if (fits_movabs_hdu(fptr, hdu, &hdutype, &status))
+             printerror(status);
+         if (fits_write_chksum(fptr, &status))
+             printerror(status);
+    }
+    if (fits_movabs_hdu(fptr, itsImageHDU, &hdutype, &status))
+        printerror(status);
+}
+
+/// @brief set up the keyword
+/// @param[in] keyword name of the keyword
+/// @param[in] type cfitsio data type (TSTRING, TINT, TDOUBLE or TLOGICAL)
+/// @param[in] comment keyword description
+FITSImageRW::StagedKeyword::StagedKeyword(const std::string &keyword, int type, const std::string &comment) :
+    itsName(keyword), itsType(type), itsInt(0), itsDouble(0.), itsComment(comment)
+{
+}
+
+/// @brief start a header transaction
+/// @details Units, beam, keywords, history and info tables set until commitHeaderUpdate
+/// are staged in memory and then written together.
+void FITSImageRW::beginHeaderUpdate()
+{
+    ASKAPCHECK(!itsInHeaderUpdate, "Header update of "<<this->name<<" is already in progress");
+    itsInHeaderUpdate = true;
+}
+
+/// @brief write the header changes staged since beginHeaderUpdate
+void FITSImageRW::commitHeaderUpdate()
+{
+    ASKAPCHECK(itsInHeaderUpdate, "Header update of "<<this->name<<" has not been started");
+    itsInHeaderUpdate = false;
+    writeStagedUpdates();
+}
+
+/// @brief write all staged header changes
+/// @details The keywords and history go to the primary header first, so the space for all
+/// of them is made at once, the tables are appended afterwards. The staged changes are
+/// dropped before writing, so they are not written twice if something goes wrong.
+void FITSImageRW::writeStagedUpdates()
+{
+    if (itsStagedKeywords.empty() && itsStagedHistory.empty() && !itsStagedBeamList && itsStagedInfo.empty()) {
+        return;
+    }
+    std::vector<StagedKeyword> keywords;
+    std::vector<std::string> historyLines;
+    boost::shared_ptr<BeamList> beamlist;
+    std::vector<casacore::Record> infos;
+    keywords.swap(itsStagedKeywords);
+    historyLines.swap(itsStagedHistory);
+    beamlist.swap(itsStagedBeamList);
+    infos.swap(itsStagedInfo);
+    ASKAPLOG_DEBUG_STR(FITSlogger, "Writing "<<keywords.size()<<" keyword(s), "<<historyLines.size()<<
+                       " history line(s) and "<<infos.size() + (beamlist ? 1 : 0)<<" table(s) to "<<this->name);
+
+    fitsfile *fptr = openFile(READWRITE);
+    int status = 0;
+
+    // count the cards to be added, the existing keywords are updated in place
+    int nNew = historyLines.size();
+    std::set<std::string> names;
+    for (const auto& kw : keywords) {
+         if (names.insert(toUpper(kw.itsName)).second) {
+             char card[FLEN_CARD];
+             if (fits_read_card(fptr, kw.itsName.c_str(), card, &status) == KEY_NO_EXIST) {
+                 ++nNew;
+             }
+             status = 0;
+         }
+    }
+    makeHeaderSpace(fptr, nNew);
+
+    for (auto& kw : keywords) {
+         void *value = nullptr;
+         if (kw.itsType == TSTRING) {
+             value = (void *)kw.itsString.c_str();
+         } else if (kw.itsType == TDOUBLE) {
+             value = &kw.itsDouble;
+         } else {
+             ASKAPDEBUGASSERT((kw.itsType == TINT) || (kw.itsType == TLOGICAL));
+             value = &kw.itsInt;
+         }
+         if (fits_update_key(fptr, kw.itsType, kw.itsName.c_str(), value, kw.itsComment.c_str(), &status))
+             printerror(status);
+    }
+    for (const auto& history : historyLines) {
+         if (fits_write_history(fptr, history.c_str(), &status))
+             printerror(status);
+    }
+
+    // tables are appended at the end of the file
+    if (beamlist) {
+        writeBeamTable(fptr, *beamlist);
+    }
+    for (const auto& info : infos) {
+         createTable(fptr, info);
+    }
+}
 
+/// @brief make sure the primary header has space for the given number of new keywords
+/// @details Placeholders reserved at create are deleted as required. Deleting a keyword
+/// shifts the following ones within the header, which is cheap compared to cfitsio
+/// inserting a new header block and moving all the data by 2880 bytes.
+/// @param[in] fptr FITS file pointer, the image HDU should be current
+/// @param[in] nKeywords number of keywords to be added
+void FITSImageRW::makeHeaderSpace(fitsfile *fptr, int nKeywords)
+{
+    int status = 0;
+    int nExist = 0;
+    int nMore = 0;
+    if (fits_get_hdrspace(fptr, &nExist, &nMore, &status))
+        printerror(status);
+    if (nKeywords <= nMore) {
+        return;
+    }
+    std::vector<std::string> placeholders;
+    for (int key = 1; key <= nExist; ++key) {
+         char keyname[FLEN_KEYWORD];
+         char value[FLEN_VALUE];
+         char comment[FLEN_COMMENT];
+         if (fits_read_keyn(fptr, key, keyname, value, comment, &status))
+             printerror(status);
+         if (std::string(keyname).compare(0, reservedKeywordPrefix.size(), reservedKeywordPrefix) == 0) {
+             placeholders.push_back(keyname);
+         }
+    }
+    const int nDelete = std::min(static_cast<int>(placeholders.size()), nKeywords - nMore);
+    // delete from the end, so the remaining placeholders stay in one contiguous group
+    for (int i = 0; i < nDelete; ++i) {
+         if (fits_delete_key(fptr, placeholders[placeholders.size() - 1 - i].c_str(), &status))
+             printerror(status);
+    }
+    if (nKeywords > nMore + nDelete) {
+        ASKAPLOG_DEBUG_STR(FITSlogger, "Header of "<<this->name<<" has to be extended for "<<
+                           nKeywords - nMore - nDelete<<" keyword(s)");
+    }
 }
 
+/// @brief destructor, closes the file if it is open
 FITSImageRW::~FITSImageRW()
 {
+    if (itsInHeaderUpdate) {
+        ASKAPLOG_WARN_STR(FITSlogger, "Header update of " << this->name << " has not been committed, writing staged changes");
+        itsInHeaderUpdate = false;
+        try {
+           writeStagedUpdates();
+        }
+        catch (const std::exception &ex) {
+           ASKAPLOG_WARN_STR(FITSlogger, "Failed to write staged header changes: " << ex.what());
+        }
+    }
+    if (itsFptr != nullptr) {
+        {
+          boost::lock_guard<boost::recursive_mutex> lock(openFileRegistryMutex());
+          openFileRegistry().erase(this);
+        }
+        int status = 0;
+        if (fits_close_file(itsFptr, &status)) {
+            // don't terminate the program from the destructor
+            char status_str[FLEN_STATUS];
+            fits_get_errstatus(status, status_str);
+            ASKAPLOG_WARN_STR(FITSlogger, "Failed to close " << this->name << ": " << status_str);
+        }
+        itsFptr = nullptr;
+    }
 }
 
 
@@ -831,8 +1896,10 @@ void FITSImageRW::setInfoValidityCheck(const casacore::RecordInterface &info)
 
 /// @brief this method creates and writes the keywords and table data stored in the casacore::Record
 ///        to the FITS binary table.
+/// @param[in] fptr  FITS file pointer. The file must be opened for writting before calling this
+///                  method. It does not close the file pointer after the call
 /// @param[in] info  keywords and table data kept in the casacore::Record
-void FITSImageRW::createTable(const casacore::RecordInterface &info)
+void FITSImageRW::createTable(fitsfile* fptr, const casacore::RecordInterface &info)
 {
     // find the sub record. it is the table we want to create
     casacore::uInt nFields = info.nfields();
@@ -933,14 +2000,10 @@ void FITSImageRW::createTable(const casacore::RecordInterface &info)
 
     ASKAPCHECK(rows.empty() == false, "FITSImageRW::createTable does not contain any rows of data");
 
-    fitsfile *fptr;
     int status = 0;
     std::vector<long>::iterator maxIter = std::max_element(rows.begin(),rows.end());
     long maxRow = *maxIter;
 
-    if (fits_open_file(&fptr, this->name.c_str(), READWRITE, &status))
-        printerror(status);
-
     auto t = cPointerWrapper.itsTType;
     auto f = cPointerWrapper.itsTForm;
     auto u = cPointerWrapper.itsUnits;
@@ -953,9 +2016,6 @@ void FITSImageRW::createTable(const casacore::RecordInterface &info)
     // write the table columns
     writeTableColumns(fptr,table);
 
-    if (fits_close_file(fptr, &status))
-        printerror(status);
-
 }
 
 /// @brief a helper method to write the casacore::Record to the FITS binary table columns.
@@ -966,63 +2026,43 @@ void FITSImageRW::createTable(const casacore::RecordInterface &info)
 ///                  FitsImageAccess::setInfo() method.
 void FITSImageRW::writeTableColumns(fitsfile *fptr, const casacore::RecordInterface &table)
 {
-    auto nFields = table.nfields();
-
+    const casacore::uInt nFields = table.nfields();
+
+    // the table is stored row by row, so the columns are written together in chunks
+    // of the number of rows cfitsio can buffer
+    long nRows = 0;
+    for (casacore::uInt f = 0; f < nFields; f++) {
+         if ((table.name(f) != "Units") && casacore::isArray(table.dataType(f))) {
+             nRows = std::max(nRows, static_cast<long>(table.shape(f).product()));
+         }
+    }
+    const long chunk = optimalRowCount(fptr);
 
     int status = 0;
-    long firstrow = 1;
-    long firstelem = 1;
-    for(int f = 0; f < nFields; f++) {
-        // Write the actual data to the binary table rows and columns
-        casacore::String name = table.name(f);
-        // Ignore the "Units"field
-        if ( name == "Units" ) continue;
-
-        casacore::DataType type = table.dataType(f);
-        if ( type == casacore::DataType::TpArrayDouble ) {
-            casacore::Array<double> doubleArr;
-            table.get(f,doubleArr);
-            long nrows = doubleArr.capacity();
-            fits_write_col(fptr, TDOUBLE, f+1, firstrow, firstelem, nrows, doubleArr.data(), &status);
-        } else if ( type == casacore::DataType::TpArrayFloat ) {
-            casacore::Array<float> floatArr;
-            table.get(f,floatArr);
-            long nrows = floatArr.capacity();
-            fits_write_col(fptr, TFLOAT, f+1, firstrow, firstelem, nrows, floatArr.data(), &status);
-        } else if ( type == casacore::DataType::TpArrayInt ) {
-            casacore::Array<int> intArr;
-            table.get(f,intArr);
-            long nrows = intArr.capacity();
-            fits_write_col(fptr, TINT, f+1, firstrow, firstelem, nrows, intArr.data(), &status);
-        } else if ( type == casacore::DataType::TpArrayUInt ) {
-            casacore::Array<unsigned int> uintArr;
-            table.get(f,uintArr);
-            long nrows = uintArr.capacity();
-            fits_write_col(fptr, TUINT, f+1, firstrow, firstelem, nrows, uintArr.data(), &status);
-        } else if ( type == casacore::DataType::TpArrayInt64 ) {
-            casacore::Array<long long> int64Arr;
-            table.get(f,int64Arr);
-            long nrows = int64Arr.capacity();
-            fits_write_col(fptr, TLONGLONG, f+1, firstrow, firstelem, nrows, int64Arr.data(), &status);
-        } else if ( type == casacore::DataType::TpArrayString ) {
-            casacore::Array<casacore::String> stringArr;
-            table.get(f,stringArr);
-            long nrows = stringArr.capacity();
-            std::vector<casacore::String> v = stringArr.tovector();
-            long frow = 1;
-            long felem = 1;
-            // write the data to the binary table column one cell at a time
-            for (long i = 0; i < nrows; i++) {
-                boost::shared_array<char> ptr {new char[sizeof(char) * (v[i].length() + 1)]};
-                std::fill_n(ptr.get(),v[i].length() + 1,'\0');
-                std::copy_n(v[i].data(),v[i].length(),ptr.get());
-                char* bptr[] = { ptr.get() };
-                if ( fits_write_col(fptr, TSTRING, f+1, frow, firstelem, 1, bptr, &status) ) {
-                    printerror(status);
-                }
-                frow += 1;
-            }
-        }
+    for (long firstRow = 0; firstRow < nRows; firstRow += chunk) {
+         for (casacore::uInt f = 0; f < nFields; f++) {
+              // Ignore the "Units"field
+              if ( table.name(f) == "Units" ) continue;
+
+              const int column = static_cast<int>(f) + 1;
+              const casacore::DataType type = table.dataType(f);
+              if ( type == casacore::DataType::TpArrayDouble ) {
+                  writeColumnChunk(fptr, TDOUBLE, column, table.asArrayDouble(f), firstRow, chunk, status);
+              } else if ( type == casacore::DataType::TpArrayFloat ) {
+                  writeColumnChunk(fptr, TFLOAT, column, table.asArrayFloat(f), firstRow, chunk, status);
+              } else if ( type == casacore::DataType::TpArrayInt ) {
+                  writeColumnChunk(fptr, TINT, column, table.asArrayInt(f), firstRow, chunk, status);
+              } else if ( type == casacore::DataType::TpArrayUInt ) {
+                  writeColumnChunk(fptr, TUINT, column, table.asArrayuInt(f), firstRow, chunk, status);
+              } else if ( type == casacore::DataType::TpArrayInt64 ) {
+                  writeColumnChunk(fptr, TLONGLONG, column, table.asArrayInt64(f), firstRow, chunk, status);
+              } else if ( type == casacore::DataType::TpArrayString ) {
+                  writeStringChunk(fptr, column, table.asArrayString(f), firstRow, chunk, status);
+              }
+              if (status) {
+                  printerror(status);
+              }
+         }
     }
 }
 
@@ -1077,7 +2117,10 @@ void FITSImageRW::writeTableKeywords(fitsfile* fptr, const casacore::RecordInter
 void FITSImageRW::setInfo(const casacore::RecordInterface &info)
 {
     setInfoValidityCheck(info);
-    createTable(info);
+    itsStagedInfo.push_back(casacore::Record(info));
+    if (!itsInHeaderUpdate) {
+        writeStagedUpdates();
+    }
 }
 
 /// @brief this method is the implementation of the interface FitsImageAccess::getInfo()
@@ -1088,14 +2131,11 @@ void FITSImageRW::getInfo(const std::string& tblName,casacore::RecordInterface &
 {
     ASKAPLOG_DEBUG_STR(FITSlogger, "FITSImageRW::getInfo. tblName: " << tblName);
 
-    fitsfile *fptr;
+    fitsfile *fptr = openFile(READONLY);
     int hdunum = -1;
     int hdutype = -1;
     int status = 0;
 
-    if ( fits_open_file(&fptr,this->name.c_str(),READONLY,&status) )
-         printerror( status );
-
     if ( fits_get_num_hdus(fptr,&hdunum,&status) )
         printerror( status );
 
@@ -1153,46 +2193,11 @@ void FITSImageRW::getInfo(const std::string& tblName,casacore::RecordInterface &
         table.defineRecord(tableExtName,sub);
         info.defineRecord(tableExtName,table);
     }
-    if (fits_close_file(fptr, &status)){
-        printerror(status);
-    }
-}
-
-/// @brief this method gets the FITS table column that contains string data.
-/// param[in] fptr - fits file pointer. Must be opened before calling this method.
-/// param[in] columnName - name of the column
-/// param[in] columnNum - column number of the FITS table
-/// param[in] frow - first row
-/// param[in] felem - first element
-/// param[in] nelem - number of road to read
-/// param[in] strnull
-/// param[in] anynull
-/// param[in] status - status of the fits call
-/// param[out] table - casacore::Record to store the FITS binary table data
-void FITSImageRW::getStringColumnType(fitsfile* fptr,const std::string& columnName,
-                                      long columnNum,long frow,long felem,long nelem,
-                                      char* strnull, int& anynull, int& status,
-                                      char** stringArrayValues,casacore::Record& table) const
-{
-    if (fits_read_col(fptr,TSTRING,columnNum,frow,felem,nelem,strnull,
-                      stringArrayValues, &anynull, &status))
-        printerror( status );
-
-    // copy the column data (arrayOfStringValues.itsTType) to casa array
-    casacore::IPosition shape(1);
-    shape(0) = nelem;
-    casacore::Array<casacore::String> casaStrArr(shape);
-    int index = 0;
-    casacore::Array<casacore::String>::iterator iterend(casaStrArr.end());
-    for (casacore::Array<casacore::String>::iterator iter=casaStrArr.begin();
-        iter!=iterend; ++iter) {
-        *iter = stringArrayValues[index];
-        index += 1;
-    }
-    table.define(columnName,casaStrArr);
 }
 
 /// @brief helper method. It copies FITS table data to casacore::Record
+/// @details The columns are allocated first and the rows are read in chunks of the
+/// number of rows cfitsio can buffer, straight into the storage of the columns.
 /// param[in] fptr - fits file pointer. Must be opened before calling this method.
 /// param[in] nelem - number of road to read
 /// param[in] numColumns - column to read
@@ -1203,49 +2208,61 @@ void FITSImageRW::copyFitsToCasa(fitsfile* fptr,long nelem, long numColumns,
                                  CPointerWrapper& cPtrWrapper, int& status,
                                  casacore::Record& table) const
 {
+    // allocate the columns first, the data are read straight into their storage
+    std::vector<int> types(numColumns, 0);
+    std::vector<long> widths(numColumns, 0);
     for ( int i = 0; i < numColumns; i++ ) {
-        std::string columnType = cPtrWrapper.itsTForm[i];
-        std::string columnName = cPtrWrapper.itsTType[i];
-        long frow = 1;
-        long felem = 1;
-        int anynull;
-        char strnull[10];
-        std::fill_n(strnull,10,' ');
+        const std::string columnType = cPtrWrapper.itsTForm[i];
+        const std::string columnName = cPtrWrapper.itsTType[i];
+        casacore::IPosition shape(1, nelem);
         if ( columnType.find("A") != std::string::npos ) {
-            // convert to casacore string array
-            // read the column values
-            CPointerWrapper arrayOfStringValues(nelem);
-            for (int j = 0; j < nelem; j++) {
-                arrayOfStringValues.itsTType[j] = new char[FLEN_VALUE];
-            }
-            // here we use the CPointerWrapper.itsType pointer to store the
-            getStringColumnType(fptr,columnName,i+1,frow,felem,nelem,
-                                strnull, anynull,status,
-                                arrayOfStringValues.itsTType,
-                                table);
+            int typecode = 0;
+            long repeat = 0;
+            if (fits_get_coltype(fptr, i + 1, &typecode, &repeat, &widths[i], &status))
+                printerror(status);
+            widths[i] = std::max(repeat, widths[i]);
+            types[i] = TSTRING;
+            table.define(columnName, casacore::Array<casacore::String>(shape));
         } else if ( columnType.find("E") != std::string::npos ) {
-            // convert to casacore float array
-            getColumnData<float>(fptr,columnName,TFLOAT,i+1,frow,felem,nelem,
-                                strnull, anynull,status, table);
+            types[i] = TFLOAT;
+            table.define(columnName, casacore::Array<float>(shape));
         } else if ( columnType.find("J") != std::string::npos ) {
-            // convert to casacore integer array
-            getColumnData<int>(fptr,columnName,TINT,i+1,frow,felem,nelem,
-                                strnull, anynull,status, table);
+            types[i] = TINT;
+            table.define(columnName, casacore::Array<int>(shape));
         } else if ( columnType.find("V") != std::string::npos ) {
-            // convert to casacore unsigned integer array
-            getColumnData<unsigned int>(fptr,columnName,TUINT,i+1,frow,felem,nelem,
-                                    strnull, anynull,status, table);
+            types[i] = TUINT;
+            table.define(columnName, casacore::Array<unsigned int>(shape));
         } else if ( columnType.find("K") != std::string::npos ) {
-            // convert to casacore long array
-            getColumnData<long long>(fptr,columnName,TLONGLONG,i+1,frow,felem,nelem,
-                                    strnull, anynull,status, table);
+            types[i] = TLONGLONG;
+            table.define(columnName, casacore::Array<long long>(shape));
         } else if ( columnType.find("D") != std::string::npos ) {
-            // convert to casacore double array
-            getColumnData<double>(fptr,columnName,TDOUBLE,i+1,frow,felem,nelem,
-                                    strnull, anynull,status, table);
+            types[i] = TDOUBLE;
+            table.define(columnName, casacore::Array<double>(shape));
         }
-        printerror(status);
+    }
 
+    // the table is stored row by row, so all columns are read together in chunks
+    // of the number of rows cfitsio can buffer
+    const long chunk = optimalRowCount(fptr);
+    for (long firstRow = 0; firstRow < nelem; firstRow += chunk) {
+         const long nRows = std::min(chunk, nelem - firstRow);
+         for ( int i = 0; i < numColumns; i++ ) {
+              const casacore::String columnName = cPtrWrapper.itsTType[i];
+              if (types[i] == TSTRING) {
+                  readStringChunk(fptr, i + 1, widths[i], table.rwArrayString(columnName), firstRow, nRows, status);
+              } else if (types[i] == TFLOAT) {
+                  readColumnChunk(fptr, TFLOAT, i + 1, table.rwArrayFloat(columnName), firstRow, nRows, status);
+              } else if (types[i] == TINT) {
+                  readColumnChunk(fptr, TINT, i + 1, table.rwArrayInt(columnName), firstRow, nRows, status);
+              } else if (types[i] == TUINT) {
+                  readColumnChunk(fptr, TUINT, i + 1, table.rwArrayuInt(columnName), firstRow, nRows, status);
+              } else if (types[i] == TLONGLONG) {
+                  readColumnChunk(fptr, TLONGLONG, i + 1, table.rwArrayInt64(columnName), firstRow, nRows, status);
+              } else if (types[i] == TDOUBLE) {
+                  readColumnChunk(fptr, TDOUBLE, i + 1, table.rwArrayDouble(columnName), firstRow, nRows, status);
+              }
+              printerror(status);
+         }
     }
 }
 
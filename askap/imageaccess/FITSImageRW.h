@@ -36,17 +36,142 @@
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/fits/FITS/fitsio.h>
 #include <casacore/casa/Containers/RecordInterface.h>
+#include <casacore/casa/Containers/Record.h>
 
 #include <Common/ParameterSet.h>
 #include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/FitsChecksum.h>
 
 #include <tuple>
 #include <map>
+#include <vector>
 #include "boost/scoped_ptr.hpp"
+#include "boost/shared_ptr.hpp"
+
+#include <sys/types.h>
 
 namespace askap {
 namespace accessors {
 
+/// @brief identity and modification time of a file
+/// @details This is used to detect that a file has been replaced or modified by
+/// someone else since it was opened, so cached handles and headers can be dropped.
+/// @ingroup imageaccess
+struct FitsFileStamp {
+
+        /// @brief construct a stamp which doesn't match any file
+        FitsFileStamp();
+
+        /// @brief obtain the stamp of the given file
+        /// @param[in] fname file name
+        explicit FitsFileStamp(const std::string &fname);
+
+        /// @return true, if the file existed when the stamp was taken
+        inline bool valid() const { return itsValid; }
+
+        /// @brief check that both stamps refer to the same file
+        /// @param[in] other stamp to compare with
+        /// @return true, if the device and inode match
+        bool sameFile(const FitsFileStamp &other) const;
+
+        /// @brief check that both stamps refer to the same unmodified file
+        /// @param[in] other stamp to compare with
+        /// @return true, if the file, its size and modification time match
+        bool operator==(const FitsFileStamp &other) const;
+
+        /// @brief true, if the file existed
+        bool itsValid;
+
+        /// @brief device
+        dev_t itsDevice;
+
+        /// @brief inode
+        ino_t itsInode;
+
+        /// @brief size in bytes
+        off_t itsSize;
+
+        /// @brief modification time (seconds)
+        time_t itsMTime;
+
+        /// @brief modification time (nanoseconds within the second)
+        long itsMTimeNSec;
+};
+
+/// @brief tile compression parameters for new FITS images
+/// @details The compressed image is written into a binary table extension following an
+/// empty primary HDU (tiled image compression convention), cfitsio compresses the tiles as
+/// they are written. Floating point pixels are quantised for RICE and HCOMPRESS, and for
+/// GZIP unless the quantisation level is zero, i.e. the compression is lossy in this case.
+/// @ingroup imageaccess
+struct FitsCompression {
+
+        /// @brief compression algorithm
+        enum Algorithm {
+            UNCOMPRESSED = 0,
+            RICE,
+            GZIP,
+            /// @brief GZIP with shuffled bytes
+            GZIP2,
+            HCOMPRESS
+        };
+
+        /// @brief dithering applied when floating point pixels are quantised
+        enum Dither {
+            DITHER_NONE = 0,
+            DITHER_SUBTRACTIVE_1,
+            /// @brief as DITHER_SUBTRACTIVE_1, but zero-valued pixels are preserved exactly
+            DITHER_SUBTRACTIVE_2
+        };
+
+        /// @brief set up parameters for uncompressed images
+        FitsCompression();
+
+        /// @brief set up compression parameters
+        /// @param[in] algorithm compression algorithm
+        /// @param[in] tile tile shape, the default (empty shape) is one plane per tile
+        /// @param[in] quantizeLevel quantisation level, positive values are in units of the
+        ///            noise estimated for each tile, negative values are absolute (cfitsio convention),
+        ///            zero turns quantisation off (GZIP only)
+        /// @param[in] dither dithering method used for quantisation
+        /// @param[in] hcompScale HCOMPRESS scale factor, zero is lossless for integer data
+        explicit FitsCompression(Algorithm algorithm, const casacore::IPosition &tile = casacore::IPosition(),
+                                 float quantizeLevel = 4., Dither dither = DITHER_SUBTRACTIVE_1,
+                                 float hcompScale = 0.);
+
+        /// @brief read compression parameters from the parset
+        /// @details The parameters are imagecompress (none, rice, gzip, gzip2 or hcompress),
+        /// imagecompress.tile, imagecompress.quantize, imagecompress.dither (none, subtractive1
+        /// or subtractive2) and imagecompress.hcompscale. Images are uncompressed by default.
+        /// @param[in] parset parset with parameters
+        /// @return compression parameters
+        static FitsCompression fromParset(const LOFAR::ParameterSet &parset);
+
+        /// @return true, if images are compressed
+        inline bool enabled() const { return itsAlgorithm != UNCOMPRESSED; }
+
+        /// @brief tile shape for the image of the given shape
+        /// @details Missing trailing dimensions of the tile shape are set to 1.
+        /// @param[in] shape image shape
+        /// @return tile shape (same dimensionality as the image)
+        casacore::IPosition tileShape(const casacore::IPosition &shape) const;
+
+        /// @brief compression algorithm
+        Algorithm itsAlgorithm;
+
+        /// @brief tile shape, empty for one plane per tile
+        casacore::IPosition itsTile;
+
+        /// @brief quantisation level
+        float itsQuantizeLevel;
+
+        /// @brief dithering method
+        Dither itsDither;
+
+        /// @brief HCOMPRESS scale factor
+        float itsHCompScale;
+};
+
 /// @brief Extend FITSImage class functionality
 /// @details It is made clear in the casacore implementation that there are
 /// difficulties in writing general FITS access routines for writing.
@@ -70,6 +195,12 @@ class FITSImageRW {
         /// @details A call to this method should preceed any write calls. The actual
         /// image may be created only upon the first write call. Details depend on the
         /// implementation.
+        ///
+        /// BITPIX can be -32 (floating point) or 16/32 for quantised integer images (uncompressed
+        /// only). The integer range is mapped onto the pixel values from minPix to maxPix (see
+        /// FitsPixelConversion::scaling), NaNs are stored as BLANK. If minPix > maxPix (default),
+        /// BSCALE and BZERO are derived from the data by the first write of the full image, which
+        /// should then precede any slice writes.
 
 
         bool create(const std::string &name, const casacore::IPosition &shape, \
@@ -89,14 +220,46 @@ class FITSImageRW {
                     bool allowAppend = false, \
                     bool history = true);
 
-        // Destructor does nothing
+        /// @brief destructor, closes the file if it is open
         virtual ~FITSImageRW();
 
         bool create();
 
+        /// @return name of the FITS file (including the extension)
+        inline const std::string& fileName() const { return name; }
+
+        /// @brief write buffered changes to disk
+        /// @details The file is kept open between calls, so the changes may stay in the
+        /// cfitsio buffers until the file is closed. This method makes them visible to
+        /// readers which don't use this object (e.g. casacore::FITSImage).
+        /// @return true, if anything has been written since the last flush
+        bool flushFile() const;
+
+        /// @brief close the file
+        /// @details The file is reopened on demand, this method can be used to release the
+        /// handle or to pick up modifications done outside of this object.
+        void closeFile() const;
+
+        /// @brief close all handles of the given file kept open in this process
+        /// @details This is done before the file is replaced, otherwise cfitsio would reuse
+        /// the handle of the old file when the new one is opened.
+        /// @param[in] fname file name (including the extension)
+        static void closeAll(const std::string &fname);
+
         void print_hdr();
         void setUnits(const std::string &units);
 
+        /// @brief read a header keyword as a string
+        /// @param[in] keyword name of the keyword
+        /// @return pair of strings - keyword value and comment (empty strings if the keyword is not found)
+        std::pair<std::string, std::string> getHeader(const std::string &keyword) const;
+
+        /// @brief read all header keywords as strings
+        /// @details The values are formatted as in getHeader. Cards without a value (COMMENT,
+        /// HISTORY) are skipped, the first card is taken if a keyword is repeated.
+        /// @return map of keyword names to pairs of strings - keyword value and comment
+        std::map<std::string, std::pair<std::string, std::string> > getHeaders() const;
+
         void setHeader(const std::string &keyword, const std::string &value, const std::string &desc);
         void setHeader(const LOFAR::ParameterSet & keywords);
 
@@ -104,12 +267,58 @@ class FITSImageRW {
         void setRestoringBeam(const BeamList& beamlist);
         casacore::Vector<casacore::Quantity> getRestoringBeam() const;
 
+        /// @brief read the restoring beam of a single channel
+        /// @details Only the row of the BEAMS table for the given channel is read (the CHAN
+        /// column is searched if the rows are not in the channel order). The beam given by
+        /// the header keywords is returned if there is no BEAMS table.
+        /// @param[in] chan channel number
+        /// @return beam vector (major axis, minor axis, position angle)
+        casacore::Vector<casacore::Quantity> getRestoringBeam(unsigned int chan) const;
+
         void addHistory(const std::vector<std::string> &historyLines);
 
+        /// @brief write CHECKSUM and DATASUM keywords into all HDUs
+        /// @details Header updates can't be in progress. Any later change invalidates the checksums.
+        /// If the data sum of the image has been accumulated during the writes (see
+        /// useIncrementalChecksum), the image data are not read back.
+        void writeChecksum();
+
+        /// @brief write CHECKSUM and DATASUM keywords using the given sum of the image data
+        /// @details This version is used when the data have been written by other means (e.g. by
+        /// several ranks directly into the file), the caller is responsible for the sum covering
+        /// all written pixels. Other HDUs are summed by cfitsio.
+        /// @param[in] dataSum checksum of the image data unit
+        void writeChecksum(const FitsChecksum &dataSum);
+
+        /// @brief enable accumulation of the data sum as the pixels are written
+        /// @details The setting takes effect at the next create. The sum is only used if each
+        /// pixel has been written once through this object (the number of pixels written
+        /// matches the image size), it is not accumulated for compressed images.
+        /// @param[in] flag true to accumulate the sum
+        inline void useIncrementalChecksum(bool flag) { itsIncrementalChecksum = flag; }
+
+        /// @return true, if the data sum accumulated since create covers the written pixels
+        inline bool hasIncrementalChecksum() const { return itsChecksumValid; }
+
+        /// @return data sum accumulated since create
+        inline const FitsChecksum& dataChecksum() const { return itsDataChecksum; }
+
+        /// @return number of pixels added to the data sum since create
+        inline unsigned long long checksumPixels() const { return itsChecksumPixels; }
+
         // write into a FITS image
         bool write(const casacore::Array<float>&);
         bool write(const casacore::Array<float> &arr, const casacore::IPosition &where);
 
+        /// @brief write a hyper-rectangular block of double precision pixels
+        /// @details The pixels are stored without loss of precision into images with BITPIX=-64
+        /// and converted by cfitsio for BITPIX=-32. Integer images are not supported. The pixels
+        /// are not added to the incremental data sum, so writeChecksum falls back to the full pass.
+        /// @param[in] arr array with pixels
+        /// @param[in] where bottom left corner of the block
+        /// @return true on success
+        bool write(const casacore::Array<double> &arr, const casacore::IPosition &where);
+
         /// @brief this method is the implementation of the interface FitsImageAccess::setInfo()
         /// @see the description in FitsImageAccess::setInfo() for details.
         /// @param[in] the top level casacore::Record object.
@@ -121,8 +330,175 @@ class FITSImageRW {
         ///                      the FITS file.
         /// @param[in] the top level casacore::Record object.
         void getInfo(const std::string& tblName, casacore::RecordInterface &info) const;
+
+        /// @brief start a header transaction
+        /// @details Units, beam, keywords, history and info tables set until commitHeaderUpdate
+        /// are staged in memory and then written together, with the file opened once and space
+        /// for all new keywords made in one go. Staged changes are not visible to the read methods
+        /// before the commit.
+        void beginHeaderUpdate();
+
+        /// @brief write the header changes staged since beginHeaderUpdate
+        void commitHeaderUpdate();
+
+        /// @return true, if a header transaction is in progress
+        inline bool inHeaderUpdate() const { return itsInHeaderUpdate; }
+
+        /// @brief reserve header space for keywords added after the image is created
+        /// @details create adds the given number of placeholder keywords to the header. They are
+        /// removed as new keywords are written, so the data don't have to be moved to extend the
+        /// header (which is very slow for large images).
+        /// @param[in] nKeywords number of keywords to reserve space for
+        inline void reserveKeywords(uint nKeywords) { itsReservedKeywords = nKeywords; }
+
+        /// @brief set tile compression of the images created by this object
+        /// @details With compression enabled, partial writes have to cover whole tiles
+        /// (except at the image edges), so each tile is compressed once.
+        /// @param[in] compression compression parameters
+        inline void setCompression(const FitsCompression &compression) { itsCompression = compression; }
+
+        /// @return true, if the image is tile-compressed
+        bool isCompressed() const;
+
+        /// @return shape of the image
+        casacore::IPosition imageShape() const;
+
+        /// @brief read part of the image through cfitsio
+        /// @details This works for both compressed and uncompressed images.
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection (inclusive)
+        /// @return array with pixels for the selection only
+        casacore::Array<float> read(const casacore::IPosition &blc, const casacore::IPosition &trc) const;
+
+        /// @brief read part of the image through cfitsio into the given buffer
+        /// @details The buffer is only resized if its shape doesn't match the selection.
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection (inclusive)
+        /// @param[out] buffer array to fill with pixels for the selection
+        void read(const casacore::IPosition &blc, const casacore::IPosition &trc, casacore::Array<float> &buffer) const;
+
+        /// @brief read part of the image in double precision through cfitsio into the given buffer
+        /// @details The buffer is only resized if its shape doesn't match the selection.
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection (inclusive)
+        /// @param[out] buffer array to fill with pixels for the selection
+        void read(const casacore::IPosition &blc, const casacore::IPosition &trc, casacore::Array<double> &buffer) const;
+
+        /// @brief read every stride-th pixel of part of the image through cfitsio
+        /// @details cfitsio skips the pixels in between, so only the pixels returned are
+        /// converted. The buffer is only resized if its shape doesn't match the selection.
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection (inclusive)
+        /// @param[in] stride increment along each axis
+        /// @param[out] buffer array to fill with pixels, (trc - blc) / stride + 1 along each axis
+        void read(const casacore::IPosition &blc, const casacore::IPosition &trc, const casacore::IPosition &stride,
+                  casacore::Array<float> &buffer) const;
+
     private:
 
+        /// @brief keyword update staged until the header is written
+        struct StagedKeyword {
+            /// @brief set up the keyword
+            /// @param[in] keyword name of the keyword
+            /// @param[in] type cfitsio data type (TSTRING, TINT, TDOUBLE or TLOGICAL)
+            /// @param[in] comment keyword description
+            StagedKeyword(const std::string &keyword, int type, const std::string &comment);
+
+            /// @brief name of the keyword
+            std::string itsName;
+            /// @brief cfitsio data type
+            int itsType;
+            /// @brief value for TSTRING
+            std::string itsString;
+            /// @brief value for TINT and TLOGICAL
+            int itsInt;
+            /// @brief value for TDOUBLE
+            double itsDouble;
+            /// @brief keyword description
+            std::string itsComment;
+        };
+
+        /// @brief write pixels into the image HDU
+        /// @details Floating point pixels are passed to cfitsio as they are. Pixels of integer
+        /// images are quantised with the scaling of the image in one pass and written raw.
+        /// @param[in] fptr FITS file pointer, the image HDU should be current
+        /// @param[in] fpixel first pixel of the block (1-based)
+        /// @param[in] lpixel last pixel of the block (1-based, inclusive)
+        /// @param[in] contiguous true, if the block is contiguous in the file
+        /// @param[in] data pixels of the block
+        /// @param[in] nelements number of pixels
+        void writePixels(fitsfile *fptr, std::vector<long> &fpixel, std::vector<long> &lpixel, bool contiguous,
+                         const float *data, LONGLONG nelements);
+
+        /// @brief write double precision pixels into the image HDU
+        /// @details Only floating point images are supported, cfitsio converts the pixels
+        /// if BITPIX=-32.
+        /// @param[in] fptr FITS file pointer, the image HDU should be current
+        /// @param[in] fpixel first pixel of the block (1-based)
+        /// @param[in] lpixel last pixel of the block (1-based, inclusive)
+        /// @param[in] contiguous true, if the block is contiguous in the file
+        /// @param[in] data pixels of the block
+        /// @param[in] nelements number of pixels
+        void writePixels(fitsfile *fptr, std::vector<long> &fpixel, std::vector<long> &lpixel, bool contiguous,
+                         const double *data, LONGLONG nelements);
+
+        /// @brief write a hyper-rectangular block
+        /// @details This is the implementation of the public write methods for blocks
+        /// @param[in] arr array with pixels (float or double)
+        /// @param[in] where bottom left corner of the block
+        /// @return true on success
+        template <typename T>
+        bool writeBlock(const casacore::Array<T> &arr, const casacore::IPosition &where);
+
+        /// @brief read part of the image through cfitsio
+        /// @details This is the implementation of the public read methods
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection (inclusive)
+        /// @param[in] stride increment along each axis, empty for all pixels
+        /// @param[in] datatype cfitsio data type matching T (TFLOAT or TDOUBLE)
+        /// @param[out] buffer array to fill with pixels for the selection
+        template <typename T>
+        void readBlock(const casacore::IPosition &blc, const casacore::IPosition &trc,
+                       const casacore::IPosition &stride, int datatype, casacore::Array<T> &buffer) const;
+
+        /// @brief write the tile-compressed image and its header
+        /// @param[in] cards header cards (80 characters each, up to the END card)
+        void createCompressed(const std::string &cards);
+
+        /// @brief check that the given section covers whole tiles of the compressed image
+        /// @param[in] fptr FITS file pointer, the image HDU should be current
+        /// @param[in] naxes number of image axes
+        /// @param[in] axes image shape
+        /// @param[in] fpixel first pixel of the section (1-based)
+        /// @param[in] lpixel last pixel of the section (1-based, inclusive)
+        void checkTileAlignment(fitsfile *fptr, int naxes, const long *axes, const long *fpixel,
+                                const long *lpixel) const;
+
+        /// @brief write all staged header changes
+        /// @details This is done at commit or straight after staging if there is no transaction in progress.
+        void writeStagedUpdates();
+
+        /// @brief make sure the primary header has space for the given number of new keywords
+        /// @details Placeholders reserved at create are deleted as required. cfitsio extends the
+        /// header itself if there are not enough of them.
+        /// @param[in] fptr FITS file pointer, the image HDU should be current
+        /// @param[in] nKeywords number of keywords to be added
+        void makeHeaderSpace(fitsfile *fptr, int nKeywords);
+
+        /// @brief write the BEAMS binary table
+        /// @param[in] fptr FITS file pointer opened for writing
+        /// @param[in] beamlist beams for all channels
+        void writeBeamTable(fitsfile *fptr, const BeamList &beamlist);
+
+        /// @brief obtain the handle of the open file
+        /// @details The file is opened on the first call and kept open until it is closed explicitly,
+        /// the object is destroyed or a handle with write access is requested for a file opened read-only.
+        /// The handle is dropped if the file has been replaced or modified by someone else since it
+        /// was opened or flushed. The HDU with the image (primary or compressed) is made current.
+        /// @param[in] mode READONLY or READWRITE
+        /// @return cfitsio file pointer (owned by this object)
+        fitsfile* openFile(int mode) const;
+
         /// @brief this structure wraps the c pointers required by cfitsio library to ensure
         ///        memory used is properly freed.
         struct CPointerWrapper
@@ -147,6 +523,8 @@ class FITSImageRW {
         void writeTableKeywords(fitsfile* fptr, const casacore::RecordInterface& info);
 
         /// @brief a helper method to write the casacore::Record to the FITS binary table columns.
+        /// @details The rows are written in chunks of the number of rows cfitsio can buffer,
+        /// straight from the storage of the columns.
         /// @param[in] fptr  FITS file pointer. The file must be opened for writting before calling this
         ///                  method. It does not close the file pointer after the call.
         /// @param[in] table a casacore::Record contains the columns' data to be written FITS binary table.
@@ -155,26 +533,14 @@ class FITSImageRW {
 
         /// @brief this method creates and writes the keywords and table data stored in the casacore::Record
         ///        to the FITS binary table.
+        /// @param[in] fptr  FITS file pointer. The file must be opened for writting before calling this
+        ///                  method. It does not close the file pointer after the call
         /// @param[in] info  keywords and table data kept in the casacore::Record
-        void createTable(const casacore::RecordInterface &info);
-
-        /// @brief this method gets the FITS table column that contains string data.
-        /// param[in] fptr - fits file pointer. Must be opened before calling this method.
-        /// param[in] columnName - name of the column
-        /// param[in] columnNum - column number of the FITS table
-        /// param[in] frow - first row
-        /// param[in] felem - first element
-        /// param[in] nelem - number of road to read
-        /// param[in] strnull
-        /// param[in] anynull
-        /// param[in] status - status of the fits call
-        /// param[out] table - casacore::Record to store the FITS binary table data
-        void getStringColumnType(fitsfile* fptr,const std::string& columnName,
-                                 long columnNum,long frow,long felem,long nelem,
-                                 char* strnull, int& anynull, int& status,
-                                 char** stringArrayValues,casacore::Record& table) const;
+        void createTable(fitsfile* fptr, const casacore::RecordInterface &info);
 
         /// @brief helper method. It copies FITS table data to casacore::Record
+        /// @details The columns are allocated first and the rows are read in chunks of the
+        /// number of rows cfitsio can buffer, straight into the storage of the columns.
         /// param[in] fptr - fits file pointer. Must be opened before calling this method.
         /// param[in] nelem - number of road to read
         /// param[in] numColumns - column to read
@@ -199,42 +565,6 @@ class FITSImageRW {
         void extractFitsRecord(const std::string& record, std::string& keyword,
                                std::string& value, std::string& comment) const;
 
-        /// @brief a helper template method to copy table column data to casacore::Record
-        /// param[in] fptr - fits file pointer. Must be opened before calling this method.
-        /// param[in] columnName - name of the column
-        /// param[in] datatype - FITS column datatype e.g TSTRING, TINT and etc
-        /// param[in] columnNum - column number of the FITS table
-        /// param[in] frow - first row
-        /// param[in] felem - first element
-        /// param[in] nelem - number of road to read
-        /// param[in] strnull
-        /// param[in] anynull
-        /// param[in] status - status of the fits call
-        /// param[out] table - casacore::Record to store the FITS binary table data
-        template<typename T>
-        bool getColumnData(fitsfile* fptr,const std::string& columnName,int datatype,
-                           long columnNum,long frow,long felem,long nelem,
-                           char* strnull, int& anynull, int& status,
-                           casacore::Record& table) const
-        {
-            boost::shared_array<T> tArray {new T[nelem]};
-            fits_read_col(fptr,datatype,columnNum,frow,felem,nelem,strnull,
-                tArray.get(), &anynull, &status);
-
-            //this->addColToRecord<T>(columnName,nelem,tArray.get(),table);
-            bool r = (status == 0 ? true : false);
-
-            casacore::Vector<T> casaVector(nelem);
-            const T* data = tArray.get();
-            for (std::size_t index = 0; index < nelem; index++) {
-                casaVector[index] = data[index];
-            }
-            table.define(columnName,casaVector);
-
-            return r;
-        }
-
-
         std::string name;
         casacore::IPosition shape;
         casacore::CoordinateSystem csys;
@@ -256,6 +586,75 @@ class FITSImageRW {
         casacore::FitsKeywordList theKeywordList;
         bool itsFastAlloc;
 
+        /// @brief handle of the open file, null if the file is not open
+        mutable fitsfile *itsFptr;
+
+        /// @brief true, if the file has been opened for writing
+        mutable bool itsReadWrite;
+
+        /// @brief true, if something has been written since the last flush
+        mutable bool itsModified;
+
+        /// @brief stamp of the file taken when it was opened or flushed
+        mutable FitsFileStamp itsStamp;
+
+        /// @brief number of keywords to reserve space for at create
+        uint itsReservedKeywords;
+
+        /// @brief true, if a header transaction is in progress
+        bool itsInHeaderUpdate;
+
+        /// @brief staged keyword updates (in the order they were made)
+        std::vector<StagedKeyword> itsStagedKeywords;
+
+        /// @brief staged history lines
+        std::vector<std::string> itsStagedHistory;
+
+        /// @brief staged beam table, if any
+        boost::shared_ptr<BeamList> itsStagedBeamList;
+
+        /// @brief staged info tables
+        std::vector<casacore::Record> itsStagedInfo;
+
+        /// @brief compression of the images created by this object
+        FitsCompression itsCompression;
+
+        /// @brief number of the HDU with the image (1 for the primary HDU, 2 for compressed images)
+        mutable int itsImageHDU;
+
+        /// @brief image geometry (NAXISn), read when the file is opened
+        mutable std::vector<long> itsAxes;
+
+        /// @brief BITPIX of the image, read when the file is opened
+        mutable int itsBitpix;
+
+        /// @brief BSCALE of the image, read when the file is opened
+        mutable double itsBScale;
+
+        /// @brief BZERO of the image, read when the file is opened
+        mutable double itsBZero;
+
+        /// @brief true, if BLANK is defined for the integer image
+        mutable bool itsHasBlank;
+
+        /// @brief BLANK of the integer image
+        mutable long itsBlank;
+
+        /// @brief true, if BSCALE and BZERO of the created integer image are to be derived from the data
+        bool itsAutoScale;
+
+        /// @brief true, if the data sum is to be accumulated for the images created by this object
+        bool itsIncrementalChecksum;
+
+        /// @brief true, if itsDataChecksum is being accumulated for the current image
+        bool itsChecksumValid;
+
+        /// @brief data sum of the pixels written since create
+        FitsChecksum itsDataChecksum;
+
+        /// @brief number of pixels written since create
+        unsigned long long itsChecksumPixels;
+
 };
 }
 }
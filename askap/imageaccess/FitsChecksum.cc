@@ -0,0 +1,226 @@
+/// @file FitsChecksum.cc
+/// @brief Incremental computation of FITS checksums
+/// @details The words are added into a 64-bit accumulator and the carries are folded
+/// back when the checksum is requested, which is equivalent to the end-around carry
+/// of the ones' complement addition done by cfitsio.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/imageaccess/FitsChecksum.h>
+#include <askap/imageaccess/FitsPixelConversion.h>
+#include <askap/askap/AskapError.h>
+
+#include <fitsio.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief fold the carries of the 64-bit sum into 32 bits
+/// @param[in] sum sum of 32-bit words
+/// @return ones' complement sum
+inline uint64_t fold(uint64_t sum)
+{
+    while (sum >> 32) {
+           sum = (sum & 0xffffffffull) + (sum >> 32);
+    }
+    return sum;
+}
+
+/// @brief number of pixels converted at a time by addBlock
+const size_t theChunkSize = 16384;
+
+} // anonymous namespace
+
+/// @brief empty sum
+FitsChecksum::FitsChecksum() : itsSum(0) {}
+
+/// @brief reset the sum to zero
+void FitsChecksum::reset()
+{
+    itsSum = 0;
+}
+
+/// @brief add bytes
+/// @param[in] bytes bytes in the file representation
+/// @param[in] n number of bytes
+/// @param[in] offset offset of the first byte from the start of the data unit
+void FitsChecksum::add(const char *bytes, size_t n, size_t offset)
+{
+    const unsigned char *ptr = reinterpret_cast<const unsigned char*>(bytes);
+    const unsigned char *end = ptr + n;
+    uint64_t sum = 0;
+    // leading bytes up to the word boundary
+    for (; (ptr != end) && (offset % 4 != 0); ++ptr, ++offset) {
+         sum += static_cast<uint64_t>(*ptr) << (8 * (3 - offset % 4));
+    }
+    // whole words, the 64-bit accumulator can't overflow for less than 2^32 words
+    const size_t nWords = static_cast<size_t>(end - ptr) / 4;
+    for (size_t word = 0; word < nWords; ++word, ptr += 4) {
+         sum += (static_cast<uint64_t>(ptr[0]) << 24) | (static_cast<uint64_t>(ptr[1]) << 16) |
+                (static_cast<uint64_t>(ptr[2]) << 8) | static_cast<uint64_t>(ptr[3]);
+         if ((word & 0x3fffffff) == 0x3fffffff) {
+             sum = fold(sum);
+         }
+    }
+    // trailing bytes
+    for (size_t pos = 0; ptr != end; ++ptr, ++pos) {
+         sum += static_cast<uint64_t>(*ptr) << (8 * (3 - pos));
+    }
+    itsSum = fold(fold(itsSum) + fold(sum));
+}
+
+/// @brief contiguous runs of the block in the file
+/// @details A run spans the whole block along the leading axes which the block covers
+/// completely and the block along the next axis.
+/// @param[in] imageShape shape of the image
+/// @param[in] blc bottom left corner of the block
+/// @param[in] shape shape of the block
+/// @param[out] runLength number of pixels in a run
+/// @return offsets of the runs in pixels from the start of the image
+std::vector<size_t> FitsChecksum::runs(const casacore::IPosition &imageShape, const casacore::IPosition &blc,
+                                       const casacore::IPosition &shape, size_t &runLength)
+{
+    const casacore::uInt ndim = imageShape.nelements();
+    ASKAPCHECK((blc.nelements() == ndim) && (shape.nelements() == ndim), "Block at " << blc << " with the shape " <<
+               shape << " doesn't match the image shape " << imageShape);
+    runLength = 0;
+    std::vector<size_t> result;
+    if ((ndim == 0) || (shape.product() <= 0)) {
+        return result;
+    }
+    casacore::uInt axis = 0;
+    runLength = shape[0];
+    while ((axis + 1 < ndim) && (shape[axis] == imageShape[axis])) {
+           ++axis;
+           runLength *= shape[axis];
+    }
+    std::vector<size_t> strides(ndim, 1);
+    for (casacore::uInt dim = 1; dim < ndim; ++dim) {
+         strides[dim] = strides[dim - 1] * imageShape[dim - 1];
+    }
+    const size_t nRuns = shape.product() / runLength;
+    result.resize(nRuns);
+    for (size_t run = 0; run < nRuns; ++run) {
+         size_t offset = 0;
+         for (casacore::uInt dim = 0; dim <= axis; ++dim) {
+              offset += blc[dim] * strides[dim];
+         }
+         size_t rest = run;
+         for (casacore::uInt dim = axis + 1; dim < ndim; ++dim) {
+              offset += (blc[dim] + rest % shape[dim]) * strides[dim];
+              rest /= shape[dim];
+         }
+         result[run] = offset;
+    }
+    return result;
+}
+
+/// @brief add a block of pixels in the file representation
+/// @param[in] raw pixels of the block (big-endian, first axis varying fastest)
+/// @param[in] width size of a pixel in bytes
+/// @param[in] imageShape shape of the image
+/// @param[in] blc bottom left corner of the block
+/// @param[in] shape shape of the block (same dimensionality as the image)
+void FitsChecksum::addRawBlock(const char *raw, size_t width, const casacore::IPosition &imageShape,
+                               const casacore::IPosition &blc, const casacore::IPosition &shape)
+{
+    size_t runLength = 0;
+    const std::vector<size_t> offsets = runs(imageShape, blc, shape, runLength);
+    for (size_t run = 0; run < offsets.size(); ++run) {
+         add(raw + run * runLength * width, runLength * width, offsets[run] * width);
+    }
+}
+
+/// @brief add a block of pixels
+/// @details The pixels are converted to the file representation (see FitsPixelConversion)
+/// in small chunks, so no buffer of the block size is needed.
+/// @param[in] data pixels of the block (first axis varying fastest)
+/// @param[in] imageShape shape of the image
+/// @param[in] blc bottom left corner of the block
+/// @param[in] shape shape of the block (same dimensionality as the image)
+/// @param[in] bitpix BITPIX of the image (-32, -64, 16 or 32)
+/// @param[in] bscale BSCALE
+/// @param[in] bzero BZERO
+/// @param[in] hasBlank true if BLANK is defined (integer data only)
+/// @param[in] blank BLANK
+void FitsChecksum::addBlock(const float *data, const casacore::IPosition &imageShape, const casacore::IPosition &blc,
+                            const casacore::IPosition &shape, int bitpix, double bscale, double bzero,
+                            bool hasBlank, long blank)
+{
+    const size_t width = std::abs(bitpix) / 8;
+    size_t runLength = 0;
+    const std::vector<size_t> offsets = runs(imageShape, blc, shape, runLength);
+    std::vector<char> buffer(std::min(runLength, theChunkSize) * width);
+    for (size_t run = 0; run < offsets.size(); ++run) {
+         const float *runData = data + run * runLength;
+         for (size_t start = 0; start < runLength; start += theChunkSize) {
+              const size_t n = std::min(theChunkSize, runLength - start);
+              FitsPixelConversion::encode(runData + start, n, bitpix, bscale, bzero, hasBlank, blank, buffer.data());
+              add(buffer.data(), n * width, (offsets[run] + start) * width);
+         }
+    }
+}
+
+/// @brief add another sum
+/// @param[in] other sum to add
+void FitsChecksum::merge(const FitsChecksum &other)
+{
+    itsSum = fold(fold(itsSum) + fold(other.itsSum));
+}
+
+/// @brief combine the sums of all ranks
+/// @details This is a collective operation, all ranks of the communicator have to call it.
+/// All ranks get the combined sum.
+/// @param[in] comm communicator
+void FitsChecksum::reduce(MPI_Comm comm)
+{
+    // the folded sums are below 2^32, so the total can't overflow for less than 2^32 ranks
+    unsigned long long sum = fold(itsSum);
+    const int status = MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+    ASKAPCHECK(status == MPI_SUCCESS, "Failed to reduce the checksums, error = " << status);
+    itsSum = fold(sum);
+}
+
+/// @return checksum (the value of DATASUM for the data unit)
+uint32_t FitsChecksum::value() const
+{
+    return static_cast<uint32_t>(fold(itsSum));
+}
+
+/// @brief encode the checksum as the value of the CHECKSUM keyword
+/// @param[in] sum checksum of the HDU (header and data)
+/// @return 16 character string with the encoded complement of the sum
+std::string FitsChecksum::encode(uint32_t sum)
+{
+    char ascii[17];
+    fits_encode_chksum(sum, TRUE, ascii);
+    return std::string(ascii, 16);
+}
@@ -0,0 +1,132 @@
+/// @file FitsChecksum.h
+/// @brief Incremental computation of FITS checksums
+/// @details The archive requires CHECKSUM and DATASUM keywords. cfitsio computes them by
+/// reading the whole data unit back, which doubles the I/O for large cubes. The checksum is
+/// a 32-bit ones' complement sum, which doesn't depend on the order of the words, so it can
+/// be accumulated block by block as the data are written and combined across ranks.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_FITS_CHECKSUM_H
+#define ASKAP_ACCESSORS_FITS_CHECKSUM_H
+
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Incremental computation of FITS checksums
+/// @details The sum is defined by the FITS checksum convention: the data unit is treated as
+/// a sequence of 32-bit big-endian words which are added with end-around carry. Bytes can be
+/// added in any order, each at its offset from the start of the data unit, so the bytes not
+/// added are treated as zeros (which is what the unwritten parts of a new file contain).
+/// Each byte should be added exactly once, rewriting a part of the data unit makes the sum
+/// invalid.
+/// @ingroup imageaccess
+class FitsChecksum {
+public:
+    /// @brief empty sum
+    FitsChecksum();
+
+    /// @brief reset the sum to zero
+    void reset();
+
+    /// @brief add bytes
+    /// @param[in] bytes bytes in the file representation
+    /// @param[in] n number of bytes
+    /// @param[in] offset offset of the first byte from the start of the data unit
+    void add(const char *bytes, size_t n, size_t offset);
+
+    /// @brief add a block of pixels in the file representation
+    /// @param[in] raw pixels of the block (big-endian, first axis varying fastest)
+    /// @param[in] width size of a pixel in bytes
+    /// @param[in] imageShape shape of the image
+    /// @param[in] blc bottom left corner of the block
+    /// @param[in] shape shape of the block (same dimensionality as the image)
+    void addRawBlock(const char *raw, size_t width, const casacore::IPosition &imageShape,
+                     const casacore::IPosition &blc, const casacore::IPosition &shape);
+
+    /// @brief add a block of pixels
+    /// @details The pixels are converted to the file representation (see FitsPixelConversion)
+    /// in small chunks, so no buffer of the block size is needed.
+    /// @param[in] data pixels of the block (first axis varying fastest)
+    /// @param[in] imageShape shape of the image
+    /// @param[in] blc bottom left corner of the block
+    /// @param[in] shape shape of the block (same dimensionality as the image)
+    /// @param[in] bitpix BITPIX of the image (-32, -64, 16 or 32)
+    /// @param[in] bscale BSCALE
+    /// @param[in] bzero BZERO
+    /// @param[in] hasBlank true if BLANK is defined (integer data only)
+    /// @param[in] blank BLANK
+    void addBlock(const float *data, const casacore::IPosition &imageShape, const casacore::IPosition &blc,
+                  const casacore::IPosition &shape, int bitpix, double bscale, double bzero,
+                  bool hasBlank, long blank);
+
+    /// @brief add another sum
+    /// @param[in] other sum to add
+    void merge(const FitsChecksum &other);
+
+    /// @brief combine the sums of all ranks
+    /// @details This is a collective operation, all ranks of the communicator have to call it.
+    /// All ranks get the combined sum.
+    /// @param[in] comm communicator
+    void reduce(MPI_Comm comm = MPI_COMM_WORLD);
+
+    /// @return checksum (the value of DATASUM for the data unit)
+    uint32_t value() const;
+
+    /// @brief encode the checksum as the value of the CHECKSUM keyword
+    /// @param[in] sum checksum of the HDU (header and data)
+    /// @return 16 character string with the encoded complement of the sum
+    static std::string encode(uint32_t sum);
+
+private:
+    /// @brief contiguous runs of the block in the file
+    /// @details A run spans the whole block along the leading axes which the block covers
+    /// completely and the block along the next axis.
+    /// @param[in] imageShape shape of the image
+    /// @param[in] blc bottom left corner of the block
+    /// @param[in] shape shape of the block
+    /// @param[out] runLength number of pixels in a run
+    /// @return offsets of the runs in pixels from the start of the image
+    static std::vector<size_t> runs(const casacore::IPosition &imageShape, const casacore::IPosition &blc,
+                                    const casacore::IPosition &shape, size_t &runLength);
+
+    /// @brief sum of the words, not folded
+    uint64_t itsSum;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_FITS_CHECKSUM_H
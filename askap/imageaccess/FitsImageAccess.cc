@@ -31,10 +31,12 @@
 #include <askap_accessors.h>
 
 #include <askap/askap/AskapLogging.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/dataaccess/IORecorder.h>
+#include <askap/dataaccess/LogRateLimiter.h>
 #include <casacore/casa/System/ProgressMeter.h>
 #include <casacore/images/Images/FITSImage.h>
 #include <casacore/images/Images/TempImage.h>
-#include <casacore/images/Images/SubImage.h>
 #include <casacore/images/Images/ImageFITSConverter.h>
 #include <casacore/images/Images/PagedImage.h>
 #include <casacore/lattices/Lattices/ArrayLattice.h>
@@ -51,6 +53,12 @@ ASKAP_LOGGER(logger, ".fitsImageAccessor");
 using namespace askap;
 using namespace askap::accessors;
 
+/// @brief default constructor
+FitsImageAccess::FitsImageAccess() : itsFastAlloc(false), itsReservedKeywords(0), itsIncrementalChecksum(false),
+    itsBitpix(-32), itsMinPix(1.), itsMaxPix(-1.), itsUseMemoryMap(true)
+{
+}
+
 // reading methods
 
 /// @brief obtain the shape
@@ -58,9 +66,7 @@ using namespace askap::accessors;
 /// @return full shape of the given image
 casacore::IPosition FitsImageAccess::shape(const std::string &name) const
 {
-    std::string fullname = name + ".fits";
-    casacore::FITSImage img(fullname);
-    return img.shape();
+    return metadata(name)->itsShape;
 }
 
 /// @brief read full image
@@ -71,9 +77,7 @@ casacore::Array<float> FitsImageAccess::read(const std::string &name) const
     std::string fullname = name + ".fits";
     ASKAPLOG_INFO_STR(logger, "Reading FITS image " << fullname);
 
-    casacore::FITSImage img(fullname);
-
-    const casacore::IPosition shape = img.shape();
+    const casacore::IPosition shape = this->shape(name);
     ASKAPLOG_INFO_STR(logger, " - Shape " << shape);
 
     casacore::IPosition blc(shape.nelements(), 0);
@@ -91,17 +95,113 @@ casacore::Array<float> FitsImageAccess::read(const std::string &name) const
 casacore::Array<float> FitsImageAccess::read(const std::string &name, const casacore::IPosition &blc,
         const casacore::IPosition &trc) const
 {
-    std::string fullname = name + ".fits";
     // ASKAPLOG_INFO_STR(logger, "Reading a slice of the FITS image " << name << " from " << blc << " to " << trc);
 
-    casacore::FITSImage img(fullname);
     casacore::Array<float> buffer;
+    if (arrayAllocator()) {
+        // the buffer allocated with the given policy is filled in place
+        readInto(name, blc, trc, buffer);
+        return buffer;
+    }
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::read");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_READ);
+    ioEvent.setRegion(name, "fits", blc, trc - blc + 1);
+    const FitsMappedImage *mapped = mappedImage(name);
+    if (mapped != nullptr) {
+        mapped->read(blc, trc, buffer);
+        timer.addBytes(buffer.nelements() * sizeof(float));
+        ioEvent.addBytes(buffer.nelements() * sizeof(float));
+        return buffer;
+    }
+    // casacore::FITSImage doesn't support tile-compressed images
+    connect(name);
+    if (itsFITSImage->isCompressed()) {
+        ASKAPLOG_HOTPATH_STR(logger, "Reading a slice of the compressed FITS image " << name << " from " << blc << " to " << trc);
+        buffer.reference(itsFITSImage->read(blc, trc));
+        timer.addBytes(buffer.nelements() * sizeof(float));
+        ioEvent.addBytes(buffer.nelements() * sizeof(float));
+        return buffer;
+    }
+    casacore::FITSImage &img = image(name);
     casacore::Slicer slc(blc, trc, casacore::Slicer::endIsLast);
-    ASKAPLOG_INFO_STR(logger, "Reading a slice of the FITS image " << name << " slice " << slc);
+    ASKAPLOG_HOTPATH_STR(logger, "Reading a slice of the FITS image " << name << " slice " << slc);
     ASKAPCHECK(img.doGetSlice(buffer, slc) == casacore::False, "Cannot read image");
+    timer.addBytes(buffer.nelements() * sizeof(float));
+    ioEvent.addBytes(buffer.nelements() * sizeof(float));
+    return buffer;
+}
+
+/// @brief read every stride-th pixel of part of the image
+/// @details The increments are passed to cfitsio (fits_read_subset).
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[in] stride increment along each axis (1 to take all pixels)
+/// @return array with (trc - blc) / stride + 1 pixels along each axis
+casacore::Array<float> FitsImageAccess::read(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, const casacore::IPosition &stride) const
+{
+    ASKAPLOG_HOTPATH_STR(logger, "Reading a slice of the FITS image " << name << " from " << blc << " to " <<
+                         trc << " with the stride " << stride);
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::read");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_READ);
+    ioEvent.setRegion(name, "fits", blc, trc - blc + 1);
+    connect(name);
+    casacore::Array<float> buffer;
+    itsFITSImage->read(blc, trc, stride, buffer);
+    timer.addBytes(buffer.nelements() * sizeof(float));
+    ioEvent.addBytes(buffer.nelements() * sizeof(float));
     return buffer;
 }
 
+/// @brief read part of the image into the given buffer
+/// @details The file is kept open, so reading an image piece by piece into the
+/// same buffer doesn't reopen the file or allocate memory for each piece.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with pixels for the selection
+void FitsImageAccess::readInto(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, casacore::Array<float> &buffer) const
+{
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::read");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_READ);
+    ioEvent.setRegion(name, "fits", blc, trc - blc + 1);
+    if (arrayAllocator()) {
+        resizeBuffer(buffer, trc - blc + 1);
+    }
+    const FitsMappedImage *mapped = mappedImage(name);
+    if (mapped != nullptr) {
+        mapped->read(blc, trc, buffer);
+    } else {
+        connect(name);
+        itsFITSImage->read(blc, trc, buffer);
+    }
+    timer.addBytes(buffer.nelements() * sizeof(float));
+    ioEvent.addBytes(buffer.nelements() * sizeof(float));
+}
+
+/// @brief read part of the image in double precision into the given buffer
+/// @details The memory map is only used for single precision reads.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with pixels for the selection
+void FitsImageAccess::readInto(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, casacore::Array<double> &buffer) const
+{
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::read");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_READ);
+    ioEvent.setRegion(name, "fits", blc, trc - blc + 1);
+    if (arrayAllocator()) {
+        arrayAllocator()->resize(buffer, trc - blc + 1);
+    }
+    connect(name);
+    itsFITSImage->read(blc, trc, buffer);
+    timer.addBytes(buffer.nelements() * sizeof(double));
+    ioEvent.addBytes(buffer.nelements() * sizeof(double));
+}
+
 /// @brief Determine whether an image has a mask
 /// @param[in] nam image name
 /// @return True if image has a mask, False if not.
@@ -140,25 +240,122 @@ casacore::LogicalArray FitsImageAccess::readMask(const std::string &name, const
 
 }
 
+/// @brief read the mask for part of the image with one bit per pixel
+/// @details The mask is derived from the pixels read plane by plane, the summaries of
+/// the whole image planes covered by the selection are cached for maskPlaneState.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return packed mask for the selection (set bit = good pixel)
+PackedMask FitsImageAccess::readPackedMask(const std::string &name, const casacore::IPosition &blc,
+                                           const casacore::IPosition &trc) const
+{
+    PackedMask result(trc - blc + 1, true);
+    std::vector<signed char> &states = planeStates(name);
+    const casacore::IPosition imageShape = shape(name);
+    ASKAPCHECK(blc.nelements() == imageShape.nelements(), "Selection from " << blc << " to " << trc <<
+               " doesn't match the image with the shape " << imageShape);
+    // the summaries can only be cached for whole planes
+    bool wholePlanes = true;
+    for (casacore::uInt axis = 0; (axis < 2) && (axis < imageShape.nelements()); ++axis) {
+         wholePlanes &= (blc[axis] == 0) && (trc[axis] == imageShape[axis] - 1);
+    }
+    const size_t planeSize = result.planeSize();
+    casacore::IPosition planeBlc, planeTrc;
+    for (size_t plane = 0; plane < result.nPlanes(); ++plane) {
+         planeSelection(blc, trc, plane, planeBlc, planeTrc);
+         readInto(name, planeBlc, planeTrc, itsMaskPixels);
+         bool deleteIt = false;
+         const float *pixels = itsMaskPixels.getStorage(deleteIt);
+         result.packFinite(plane * planeSize, pixels, planeSize);
+         itsMaskPixels.freeStorage(pixels, deleteIt);
+         if (wholePlanes) {
+             size_t imagePlane = 0;
+             size_t stride = 1;
+             for (casacore::uInt axis = 2; axis < imageShape.nelements(); ++axis) {
+                  imagePlane += planeBlc[axis] * stride;
+                  stride *= imageShape[axis];
+             }
+             if (imagePlane < states.size()) {
+                 states[imagePlane] = static_cast<signed char>(result.planeState(plane));
+             }
+         }
+    }
+    return result;
+}
+
+/// @brief obtain the summary of the mask of an image plane
+/// @details The summaries are cached for the most recently used image until it is modified,
+/// so the pixels of each plane are read at most once.
+/// @param[in] name image name
+/// @param[in] plane plane number (see PackedMask)
+/// @return PackedMask::ALL_VALID, PackedMask::ALL_MASKED or PackedMask::PARTIAL
+PackedMask::PlaneState FitsImageAccess::maskPlaneState(const std::string &name, size_t plane) const
+{
+    std::vector<signed char> &states = planeStates(name);
+    ASKAPCHECK(plane < states.size(), "Plane " << plane << " is outside the image " << name << " with " <<
+               states.size() << " plane(s)");
+    if (states[plane] < 0) {
+        const casacore::IPosition imageShape = shape(name);
+        casacore::IPosition planeBlc, planeTrc;
+        planeSelection(casacore::IPosition(imageShape.nelements(), 0), imageShape - 1, plane, planeBlc, planeTrc);
+        readInto(name, planeBlc, planeTrc, itsMaskPixels);
+        bool deleteIt = false;
+        const float *pixels = itsMaskPixels.getStorage(deleteIt);
+        size_t valid = 0;
+        const size_t size = itsMaskPixels.nelements();
+        for (size_t i = 0; i < size; ++i) {
+             valid += pixels[i] == pixels[i] ? 1 : 0;
+        }
+        itsMaskPixels.freeStorage(pixels, deleteIt);
+        states[plane] = static_cast<signed char>(valid == size ? PackedMask::ALL_VALID :
+                        (valid == 0 ? PackedMask::ALL_MASKED : PackedMask::PARTIAL));
+    }
+    return static_cast<PackedMask::PlaneState>(states[plane]);
+}
+
+/// @brief read the mask for part of the image into the given buffer
+/// @details The pixels are read into a scratch buffer reused between the calls
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with mask values - 1=good, 0=bad
+void FitsImageAccess::readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                                   const casacore::IPosition &trc, casacore::LogicalArray &buffer) const
+{
+    readInto(name, blc, trc, itsMaskPixels);
+    if (!buffer.shape().isEqual(itsMaskPixels.shape())) {
+        buffer.resize(itsMaskPixels.shape());
+    }
+    casacore::LogicalArray::iterator iterMask = buffer.begin();
+    for (casacore::Array<float>::const_iterator iterPixel = itsMaskPixels.begin(); iterPixel != itsMaskPixels.end();
+         ++iterPixel, ++iterMask) {
+         *iterMask = !casacore::isNaN(*iterPixel);
+    }
+}
+
 /// @brief obtain coordinate system info
+/// @details The coordinates are taken from the cached header (see image).
 /// @param[in] name image name
 /// @return coordinate system object
 casacore::CoordinateSystem FitsImageAccess::coordSys(const std::string &name) const
 {
-    std::string fullname = name + ".fits";
-    casacore::FITSImage img(fullname);
-    return img.coordinates();
+    return image(name).coordinates();
 }
 
+/// @brief obtain coordinate system info for part of an image
+/// @details The coordinates are derived from those of the cached header by shifting
+/// the reference pixel, the subimage is not set up.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return coordinate system object
 casacore::CoordinateSystem FitsImageAccess::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
         const casacore::IPosition &trc) const
 {
-    std::string fullname = name + ".fits";
-    casacore::Slicer slc(blc, trc, casacore::Slicer::endIsLast);
-    ASKAPLOG_INFO_STR(logger, " FITSImageAccess - Slicer " << slc);
-    casacore::FITSImage img(fullname);
-    casacore::SubImage<casacore::Float> si = casacore::SubImage<casacore::Float>(img, slc, casacore::AxesSpecifier(casacore::True));
-    return si.coordinates();
+    ASKAPLOG_HOTPATH_STR(logger, " FITSImageAccess - coordinates of the slice from " << blc << " to " << trc);
+    const casacore::FITSImage &img = image(name);
+    return sliceCoordSys(img.coordinates(), img.shape(), blc, trc);
 }
 
 /// @brief obtain beam info
@@ -166,18 +363,7 @@ casacore::CoordinateSystem FitsImageAccess::coordSysSlice(const std::string &nam
 /// @return beam info vector
 casacore::Vector<casacore::Quantum<double> > FitsImageAccess::beamInfo(const std::string &name) const
 {
-    std::string fullname = name + ".fits";
-    casacore::FITSImage img(fullname);
-    casacore::ImageInfo ii = img.imageInfo();
-    if (img.imageInfo().hasMultipleBeams()) {
-      // read the fits beam keywords - casa doesn't allow separate ref beam with beam table
-      connect(name);
-      ASKAPLOG_DEBUG_STR(logger,"FITSImageAccess::beamInfo return beam from fits keywords");
-      return itsFITSImage->getRestoringBeam();
-    } else {
-      ASKAPLOG_DEBUG_STR(logger,"FITSImageAccess::beamInfo return beam from imageInfo");
-      return ii.restoringBeam().toVector();
-    }
+    return metadata(name)->itsBeam;
 }
 
 /// @brief obtain beam info
@@ -185,17 +371,29 @@ casacore::Vector<casacore::Quantum<double> > FitsImageAccess::beamInfo(const std
 /// @return beam info list, beamlist will be empty if image only has a single beam
 BeamList FitsImageAccess::beamList(const std::string &name) const
 {
-    std::string fullname = name + ".fits";
-    casacore::FITSImage img(fullname);
-    casacore::ImageInfo ii = img.imageInfo();
-    BeamList bl;
-    if (img.imageInfo().hasMultipleBeams()) {
-      for (int chan = 0; chan < ii.nChannels(); chan++) {
-        casacore::GaussianBeam gb = ii.restoringBeam(chan,0);
-        bl[chan] = gb.toVector();
-      }
+    return metadata(name)->itsBeamList;
+}
+
+/// @brief obtain the restoring beam of a single channel
+/// @details The cached metadata snapshot is used if it is up to date, otherwise
+/// only the given row of the BEAMS table is read.
+/// @param[in] name image name
+/// @param[in] chan channel number
+/// @return beam info vector
+casacore::Vector<casacore::Quantum<double> > FitsImageAccess::channelBeam(const std::string &name,
+                                                                          unsigned int chan) const
+{
+    const std::string fullname = name + ".fits";
+    flushPending(fullname);
+    const std::map<std::string, CachedMetadata>::const_iterator ci = itsMetadata.find(fullname);
+    if ((ci != itsMetadata.end()) && (ci->second.itsStamp == FitsFileStamp(fullname))) {
+        return ci->second.itsMetadata->beam(chan);
     }
-    return bl;
+    connect(name);
+    if (itsFITSImage->isCompressed()) {
+        return metadata(name)->beam(chan);
+    }
+    return itsFITSImage->getRestoringBeam(chan);
 }
 
 
@@ -204,22 +402,10 @@ BeamList FitsImageAccess::beamList(const std::string &name) const
 /// @return units string
 std::string FitsImageAccess::getUnits(const std::string &name) const
 {
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    std::string fullname = name + ".fits";
-    int status = 0;
-    char value[1024];
-    char comment[1024];
-    if (fits_open_file(&fptr, fullname.c_str(), READONLY, &status))
-        ASKAPCHECK(status == 0, "FITSImageAccess:: Cannot open FITS file");
-    status = 0;
-
-    if (fits_read_key(fptr, TSTRING, "BUNIT", value, comment,  &status))
-        ASKAPLOG_WARN_STR(logger, "FITSImageAccess:: Cannot find BUNIT keyword - fits_read_key returned status " << status);
-    status=0;
-    if (fits_close_file(fptr, &status))
-        ASKAPCHECK(status == 0, "FITSImageAccess:: Error on closing file");
-
-    std::string units(value);
+    const std::string &units = metadata(name)->itsUnits;
+    if (units.empty()) {
+        ASKAPLOG_WARN_STR(logger, "FITSImageAccess:: Cannot find BUNIT keyword in " << name);
+    }
     return units;
 }
 
@@ -230,34 +416,174 @@ std::string FitsImageAccess::getUnits(const std::string &name) const
 /// @return pair of strings - keyword value and comment
 std::pair<std::string, std::string> FitsImageAccess::getMetadataKeyword(const std::string &name, const std::string &keyword) const
 {
+    return metadata(name)->keyword(keyword);
+}
 
-    fitsfile *fptr;       /* pointer to the FITS file, defined in fitsio.h */
-    std::string fullname = name + ".fits";
-    int status = 0;
-    char value[1024];
-    char comment[1024];
-    if (fits_open_file(&fptr, fullname.c_str(), READONLY, &status))
-        ASKAPCHECK(status == 0, "FITSImageAccess:: Cannot open FITS file");
-    status=0;
-
-    if (fits_read_key(fptr, TSTRING, keyword.c_str(), value, comment,  &status))
-        ASKAPLOG_DEBUG_STR(logger, "FITSImageAccess:: Cannot find keyword " << keyword << " - fits_read_key returned status " << status);
-    status=0;
-    if (fits_close_file(fptr, &status))
-        ASKAPCHECK(status == 0, "FITSImageAccess:: Error on closing file, status="<<status);
-
-    std::string valueStr(value);
-    std::string commentStr(comment);
-    return std::pair<std::string,std::string>(valueStr,commentStr);
+/// @brief obtain a snapshot of the image metadata
+/// @details The snapshot is cached for each image until the file is modified.
+/// @param[in] name image name
+/// @return shared pointer to the snapshot
+boost::shared_ptr<const ImageMetadata> FitsImageAccess::metadata(const std::string &name) const
+{
+    const std::string fullname = name + ".fits";
+    flushPending(fullname);
+    const FitsFileStamp stamp(fullname);
+    const std::map<std::string, CachedMetadata>::const_iterator ci = itsMetadata.find(fullname);
+    if ((ci != itsMetadata.end()) && (ci->second.itsStamp == stamp)) {
+        return ci->second.itsMetadata;
+    }
+    connect(name);
+    boost::shared_ptr<ImageMetadata> result(new ImageMetadata);
+    result->itsKeywords = itsFITSImage->getHeaders();
+    result->itsUnits = result->keyword("BUNIT").first;
+    // masked pixels are NaNs, so there is always a mask
+    result->itsMasked = true;
+    if (itsFITSImage->isCompressed()) {
+        // casacore::FITSImage doesn't support tile-compressed images
+        result->itsShape = itsFITSImage->imageShape();
+        result->itsBeam = itsFITSImage->getRestoringBeam();
+    } else {
+        const casacore::FITSImage &img = image(name);
+        result->itsShape = img.shape();
+        result->itsCoordSys = img.coordinates();
+        const casacore::ImageInfo ii = img.imageInfo();
+        if (ii.hasMultipleBeams()) {
+            // read the fits beam keywords - casa doesn't allow separate ref beam with beam table
+            result->itsBeam = itsFITSImage->getRestoringBeam();
+            for (int chan = 0; chan < ii.nChannels(); chan++) {
+                 result->itsBeamList[chan] = ii.restoringBeam(chan,0).toVector();
+            }
+        } else {
+            result->itsBeam = ii.restoringBeam().toVector();
+        }
+    }
+    CachedMetadata &entry = itsMetadata[fullname];
+    entry.itsMetadata = result;
+    entry.itsStamp = stamp;
+    return result;
 }
 
 /// @brief connect accessor to an existing image
-/// @details Instantiates the private FITSImageRW shared pointer.
+/// @details Instantiates the private FITSImageRW shared pointer. The existing object
+/// (and the file it keeps open) is reused if it refers to the same image.
 /// @param[in] name image name
 void FitsImageAccess::connect(const std::string &name) const
 {
-    //std::string fullname = name + ".fits";
-    itsFITSImage.reset(new FITSImageRW(name));
+    const std::string fullname = name + ".fits";
+    if (!itsFITSImage || (itsFITSImage->fileName() != fullname)) {
+        itsFITSImage.reset(new FITSImageRW(name));
+    }
+}
+
+/// @brief write pending changes and release the cached handles
+/// @details The file and the parsed header are reopened on demand.
+void FitsImageAccess::flush() const
+{
+    if (itsFITSImage) {
+        if (itsFITSImage->inHeaderUpdate()) {
+            itsFITSImage->commitHeaderUpdate();
+        }
+        itsFITSImage->closeFile();
+    }
+    itsCachedImage.reset();
+    itsMappedImage.reset();
+    itsPlaneStatesName.clear();
+    itsMetadata.clear();
+}
+
+/// @brief drop the pixels cached for the given image
+/// @details cfitsio buffers the file, so it is closed and reopened on demand
+/// together with the memory map (see flush).
+/// @param[in] name image name
+void FitsImageAccess::refreshPixels(const std::string &) const
+{
+    flush();
+}
+
+/// @brief write the pixels buffered for the given image to disk
+/// @details The file is kept open.
+/// @param[in] name image name
+void FitsImageAccess::syncPixels(const std::string &name) const
+{
+    flushPending(name + ".fits");
+}
+
+/// @brief obtain the parsed image
+/// @details The casacore::FITSImage object is cached for the most recently read image.
+/// It is recreated if another image is requested or the file has been modified since
+/// it was parsed. Changes buffered by the writer are flushed first.
+/// @param[in] name image name
+/// @return reference to the image object (valid until the next call)
+casacore::FITSImage& FitsImageAccess::image(const std::string &name) const
+{
+    const std::string fullname = name + ".fits";
+    flushPending(fullname);
+    const FitsFileStamp stamp(fullname);
+    if (!itsCachedImage || (itsCachedImageName != fullname) || !(stamp == itsCachedImageStamp)) {
+        itsCachedImage.reset();
+        itsCachedImage.reset(new casacore::FITSImage(fullname));
+        itsCachedImageName = fullname;
+        itsCachedImageStamp = stamp;
+    }
+    return *itsCachedImage;
+}
+
+/// @brief obtain the mapped image
+/// @details The map of the most recently read image is cached. It is recreated if
+/// another image is requested or the file has been modified since it was mapped.
+/// Changes buffered by the writer are flushed first.
+/// @param[in] name image name
+/// @return pointer to the mapped image or nullptr if the image can't be mapped
+const FitsMappedImage* FitsImageAccess::mappedImage(const std::string &name) const
+{
+    if (!itsUseMemoryMap) {
+        return nullptr;
+    }
+    const std::string fullname = name + ".fits";
+    flushPending(fullname);
+    const FitsFileStamp stamp(fullname);
+    if (!itsMappedImage || (itsMappedImage->fileName() != fullname) || !(stamp == itsMappedImage->stamp())) {
+        itsMappedImage.reset();
+        itsMappedImage.reset(new FitsMappedImage(fullname));
+    }
+    return itsMappedImage->isMapped() ? itsMappedImage.get() : nullptr;
+}
+
+/// @brief write the changes buffered for the given image
+/// @details The cached header, map and mask summaries of the image are dropped if
+/// there was anything to write.
+/// @param[in] fullname file name (including the extension)
+void FitsImageAccess::flushPending(const std::string &fullname) const
+{
+    if (itsFITSImage && (itsFITSImage->fileName() == fullname) && itsFITSImage->flushFile()) {
+        // our own changes invalidate the caches (modification time may not be fine-grained enough)
+        itsCachedImage.reset();
+        itsMappedImage.reset();
+        itsPlaneStates.clear();
+        itsPlaneStatesName.clear();
+        itsMetadata.erase(fullname);
+    }
+}
+
+/// @brief obtain the cached mask summaries of the given image
+/// @details The cache is reset if another image is requested or the file has been
+/// modified since the summaries were collected.
+/// @param[in] name image name
+/// @return summary for each plane, -1 if not known yet
+std::vector<signed char>& FitsImageAccess::planeStates(const std::string &name) const
+{
+    const std::string fullname = name + ".fits";
+    flushPending(fullname);
+    const FitsFileStamp stamp(fullname);
+    if ((itsPlaneStatesName != fullname) || !(stamp == itsPlaneStatesStamp)) {
+        const casacore::IPosition imageShape = shape(name);
+        const size_t planeSize = imageShape.nelements() > 1 ? imageShape[0] * imageShape[1] :
+                                 (imageShape.nelements() == 1 ? imageShape[0] : 1);
+        itsPlaneStates.assign(imageShape.product() / planeSize, -1);
+        itsPlaneStatesName = fullname;
+        itsPlaneStatesStamp = stamp;
+    }
+    return itsPlaneStates;
 }
 
 // writing methods
@@ -276,8 +602,17 @@ void FitsImageAccess::create(const std::string &name, const casacore::IPosition
     ASKAPLOG_INFO_STR(logger, "Creating a new FITS image " << name << " with the shape " << shape);
     casacore::String error;
 
+    // the file is replaced, so the cached handles are of no use
+    itsCachedImage.reset();
+    itsMappedImage.reset();
+    itsPlaneStatesName.clear();
+    itsMetadata.erase(name + ".fits");
+    itsFITSImage.reset();
     itsFITSImage.reset(new FITSImageRW(itsFastAlloc));
-    if (!itsFITSImage->create(name, shape, csys)) {
+    itsFITSImage->reserveKeywords(itsReservedKeywords);
+    itsFITSImage->setCompression(itsCompression);
+    itsFITSImage->useIncrementalChecksum(itsIncrementalChecksum);
+    if (!itsFITSImage->create(name, shape, csys, 64, false, true, itsBitpix, itsMinPix, itsMaxPix)) {
         casacore::String error;
         error = casacore::String("Failed to create FITSFile");
         ASKAPTHROW(AskapError, error);
@@ -293,9 +628,15 @@ void FitsImageAccess::create(const std::string &name, const casacore::IPosition
 /// @param[in] arr array with pixels
 void FitsImageAccess::write(const std::string &name, const casacore::Array<float> &arr)
 {
-    ASKAPLOG_INFO_STR(logger, "Writing an array with the shape " << arr.shape() << " into a FITS image " << name);
+    ASKAPLOG_HOTPATH_STR(logger, "Writing an array with the shape " << arr.shape() << " into a FITS image " << name);
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::write");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "fits", casacore::IPosition(arr.ndim(), 0), arr.shape());
+    timer.addBytes(arr.nelements() * sizeof(float));
+    ioEvent.addBytes(arr.nelements() * sizeof(float));
     connect(name);
     itsFITSImage->write(arr);
+    accumulateStatistics(arr, casacore::IPosition(arr.ndim(), 0));
 }
 
 /// @brief write a slice of an image
@@ -305,14 +646,46 @@ void FitsImageAccess::write(const std::string &name, const casacore::Array<float
 void FitsImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
                             const casacore::IPosition &where)
 {
-    ASKAPLOG_INFO_STR(logger, "Writing a slice with the shape " << arr.shape() << " into a FITS image " <<
-                      name << " at " << where);
+    ASKAPLOG_HOTPATH_STR(logger, "Writing a slice with the shape " << arr.shape() << " into a FITS image " <<
+                         name << " at " << where);
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::write");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "fits", where, arr.shape());
+    timer.addBytes(arr.nelements() * sizeof(float));
+    ioEvent.addBytes(arr.nelements() * sizeof(float));
     casacore::String error;
     connect(name);
     if (!itsFITSImage->write(arr, where)) {
         error = casacore::String("Failed to write slice");
         ASKAPTHROW(AskapError, error);
     }
+    accumulateStatistics(arr, where);
+}
+
+/// @brief write full image in double precision
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+void FitsImageAccess::write(const std::string &name, const casacore::Array<double> &arr)
+{
+    write(name, arr, casacore::IPosition(arr.ndim(), 0));
+}
+
+/// @brief write a slice of an image in double precision
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+void FitsImageAccess::write(const std::string &name, const casacore::Array<double> &arr,
+                            const casacore::IPosition &where)
+{
+    ASKAPLOG_HOTPATH_STR(logger, "Writing a double precision slice with the shape " << arr.shape() <<
+                         " into a FITS image " << name << " at " << where);
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::write");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "fits", where, arr.shape());
+    timer.addBytes(arr.nelements() * sizeof(double));
+    ioEvent.addBytes(arr.nelements() * sizeof(double));
+    connect(name);
+    ASKAPCHECK(itsFITSImage->write(arr, where), "Failed to write slice");
 }
 
 /// @brief write an image and mask
@@ -322,7 +695,12 @@ void FitsImageAccess::write(const std::string &name, const casacore::Array<float
 void FitsImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
                             const casacore::Array<bool> &mask)
 {
-    ASKAPLOG_INFO_STR(logger, "Writing array with the shape " << arr.shape() << " into a FITS image ");
+    ASKAPLOG_HOTPATH_STR(logger, "Writing array with the shape " << arr.shape() << " into a FITS image ");
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::write");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "fits", casacore::IPosition(arr.ndim(), 0), arr.shape());
+    timer.addBytes(arr.nelements() * sizeof(float));
+    ioEvent.addBytes(arr.nelements() * sizeof(float));
     casacore::String error;
     connect(name);
     casacore::Array<float> arrmasked;
@@ -336,6 +714,7 @@ void FitsImageAccess::write(const std::string &name, const casacore::Array<float
         error = casacore::String("Failed to write slice");
         ASKAPTHROW(AskapError, error);
     }
+    accumulateStatistics(arr, mask, casacore::IPosition(arr.ndim(), 0));
 }
 
 /// @brief write a slice of an image and mask
@@ -346,8 +725,13 @@ void FitsImageAccess::write(const std::string &name, const casacore::Array<float
 void FitsImageAccess::write(const std::string &name, const casacore::Array<float> &arr,
                             const casacore::Array<bool> &mask, const casacore::IPosition &where)
 {
-    ASKAPLOG_INFO_STR(logger, "Writing a slice with the shape " << arr.shape() << " into a FITS image " <<
-                      name << " at " << where);
+    ASKAPLOG_HOTPATH_STR(logger, "Writing a slice with the shape " << arr.shape() << " into a FITS image " <<
+                         name << " at " << where);
+    DataAccessStatistics::ScopedTimer timer("FitsImageAccess::write");
+    IORecorder::ScopedEvent ioEvent(IORecorder::IMAGE_WRITE);
+    ioEvent.setRegion(name, "fits", where, arr.shape());
+    timer.addBytes(arr.nelements() * sizeof(float));
+    ioEvent.addBytes(arr.nelements() * sizeof(float));
     casacore::String error;
     connect(name);
     casacore::Array<float> arrmasked;
@@ -361,6 +745,7 @@ void FitsImageAccess::write(const std::string &name, const casacore::Array<float
         error = casacore::String("Failed to write slice");
         ASKAPTHROW(AskapError, error);
     }
+    accumulateStatistics(arr, mask, where);
 }
 
 /// @brief write a slice of an image mask
@@ -482,6 +867,40 @@ void FitsImageAccess::addHistory(const std::string &name, const std::vector<std:
     itsFITSImage->addHistory(historyLines);
 }
 
+/// @brief write CHECKSUM and DATASUM keywords
+/// @details The checksums are computed for all HDUs of the file, so this should be
+/// the last change made to the image.
+/// @param[in] name Image name
+void FitsImageAccess::writeChecksum(const std::string &name)
+{
+    connect(name);
+    itsFITSImage->writeChecksum();
+}
+
+/// @brief write CHECKSUM and DATASUM keywords using the given sum of the image data
+/// @details This version is used when the pixels have been written by other means (e.g.
+/// collectively by several ranks). The sum accumulated by this object, if any, is added.
+/// @param[in] name Image name
+/// @param[in] dataSum checksum of the pixels written by other means
+/// @param[in] nPixels number of pixels covered by dataSum
+void FitsImageAccess::writeChecksum(const std::string &name, const FitsChecksum &dataSum, unsigned long long nPixels)
+{
+    connect(name);
+    FitsChecksum total(dataSum);
+    if (itsFITSImage->hasIncrementalChecksum()) {
+        total.merge(itsFITSImage->dataChecksum());
+        nPixels += itsFITSImage->checksumPixels();
+    }
+    const casacore::IPosition imageShape = shape(name);
+    if (nPixels == static_cast<unsigned long long>(imageShape.product())) {
+        itsFITSImage->writeChecksum(total);
+    } else {
+        ASKAPLOG_INFO_STR(logger, nPixels << " pixel(s) have been summed for " << name << " with " <<
+                          imageShape.product() << " pixel(s), computing checksums from the file");
+        itsFITSImage->writeChecksum();
+    }
+}
+
 void FitsImageAccess::setInfo(const std::string &name, const casacore::RecordInterface &info)
 {
     connect(name);
@@ -492,3 +911,23 @@ void FitsImageAccess::getInfo(const std::string &name, const std::string& tableN
     connect(name);
     itsFITSImage->getInfo(tableName,info);
 }
+
+/// @brief start a batch of header updates
+/// @details Units, beam, keywords, history and info tables set for this image until
+/// commitHeaderUpdate are staged in memory and written together.
+/// @param[in] name image name
+void FitsImageAccess::beginHeaderUpdate(const std::string &name)
+{
+    connect(name);
+    itsFITSImage->beginHeaderUpdate();
+}
+
+/// @brief write the header changes staged since beginHeaderUpdate
+/// @param[in] name image name
+void FitsImageAccess::commitHeaderUpdate(const std::string &name)
+{
+    const std::string fullname = name + ".fits";
+    ASKAPCHECK(itsFITSImage && (itsFITSImage->fileName() == fullname),
+               "Header update of "<<name<<" has not been started or has been committed already");
+    itsFITSImage->commitHeaderUpdate();
+}
@@ -34,8 +34,14 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <string>
+#include <vector>
+
+#include <casacore/images/Images/FITSImage.h>
+
 #include <askap/imageaccess/IImageAccess.h>
 #include <askap/imageaccess/FITSImageRW.h>
+#include <askap/imageaccess/FitsMappedImage.h>
 
 namespace askap {
 namespace accessors {
@@ -46,22 +52,72 @@ namespace accessors {
 /// for efficient output.
 /// It therefore makes sense to heavily inherit from the CASA conversion
 /// classes.
+///
+/// The accessor keeps the most recently used file open (see FITSImageRW) and the
+/// parsed header of the most recently read image, so writing a cube plane by plane
+/// or querying the shape and coordinates repeatedly doesn't reopen the file each time.
+/// The parsed header is dropped if the file is replaced or modified. Use flush to make
+/// the pending changes visible to other processes before the accessor is destroyed.
 /// @ingroup imageaccess
 
 struct FitsImageAccess : public IImageAccess<> {
 
     public:
 
+        /// @brief default constructor
+        FitsImageAccess();
+
         /// @brief connect accessor to an existing image
         /// @details Instantiates the private FITSImageRW shared pointer.
         /// @param[in] name image name
         void connect(const std::string &name) const;
 
+        /// @brief write pending changes and release the cached handles
+        /// @details The file and the parsed header are reopened on demand.
+        void flush() const;
+
         /// @brief use fast allocation of file
         /// @details calculates file size and writes a zero at the end
         /// @param[in] fast If true use fast allocation, default uses CFITSIO
         inline void useFastAlloc(bool fast = false) { itsFastAlloc = fast;}
 
+        /// @brief reserve header space for keywords added after the image is created
+        /// @details see FITSImageRW::reserveKeywords
+        /// @param[in] nKeywords number of keywords to reserve space for in new images
+        inline void reserveKeywords(uint nKeywords) { itsReservedKeywords = nKeywords;}
+
+        /// @brief set tile compression of new images
+        /// @details see FITSImageRW::setCompression. Only the shape and pixels of compressed
+        /// images can be read back through this class.
+        /// @param[in] compression compression parameters
+        inline void setCompression(const FitsCompression &compression) { itsCompression = compression;}
+
+        /// @brief accumulate the data sum of new images as the pixels are written
+        /// @details see FITSImageRW::useIncrementalChecksum. writeChecksum doesn't need to read
+        /// the image back if each pixel has been written once through this object.
+        /// @param[in] flag true to accumulate the sum
+        inline void useIncrementalChecksum(bool flag) { itsIncrementalChecksum = flag;}
+
+        /// @return true, if the data sum of new images is accumulated during the writes
+        inline bool incrementalChecksum() const { return itsIncrementalChecksum;}
+
+        /// @brief set the data type of new images
+        /// @details see FITSImageRW::create. Integer images take half (BITPIX=16) or the same
+        /// (BITPIX=32) space as floating point ones at the cost of quantisation. The range of
+        /// pixel values mapped onto the integers defines BSCALE and BZERO. If it is not given
+        /// (minPix > maxPix), the scaling is derived from the data of the first full image write,
+        /// in this case images can't be written slice by slice.
+        /// @param[in] bitpix BITPIX of new images (-32, -64, 16 or 32)
+        /// @param[in] minPix minimum pixel value of integer images
+        /// @param[in] maxPix maximum pixel value of integer images
+        inline void setBitpix(int bitpix, float minPix = 1., float maxPix = -1.)
+               { itsBitpix = bitpix; itsMinPix = minPix; itsMaxPix = maxPix;}
+
+        /// @brief read uncompressed images through a memory map
+        /// @details see FitsMappedImage. Images which can't be mapped are read through cfitsio.
+        /// @param[in] use true to map the images (default), false to always read through cfitsio
+        inline void useMemoryMap(bool use = true) { itsUseMemoryMap = use; itsMappedImage.reset();}
+
         //////////////////
         // Reading methods
         //////////////////
@@ -83,6 +139,38 @@ struct FitsImageAccess : public IImageAccess<> {
         /// @return array with pixels for the selection only
         virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
                                         const casacore::IPosition &trc) const override;
+
+        /// @brief read every stride-th pixel of part of the image
+        /// @details The increments are passed to cfitsio (fits_read_subset), which converts only
+        /// the pixels returned. This works for compressed images too.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[in] stride increment along each axis (1 to take all pixels)
+        /// @return array with (trc - blc) / stride + 1 pixels along each axis
+        virtual casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
+                                            const casacore::IPosition &trc,
+                                            const casacore::IPosition &stride) const override;
+
+        /// @brief read part of the image into the given buffer
+        /// @details The file is kept open, so reading an image piece by piece into the
+        /// same buffer doesn't reopen the file or allocate memory for each piece.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[out] buffer array to fill with pixels for the selection
+        virtual void readInto(const std::string &name, const casacore::IPosition &blc,
+                              const casacore::IPosition &trc, casacore::Array<float> &buffer) const override;
+
+        /// @brief read part of the image in double precision into the given buffer
+        /// @details The pixels are read through cfitsio, so there is no loss of precision
+        /// for images with BITPIX=-64 (see setBitpix). Blanked pixels are returned as NaN.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the selection
+        /// @param[in] trc top right corner of the selection
+        /// @param[out] buffer array to fill with pixels for the selection
+        void readInto(const std::string &name, const casacore::IPosition &blc,
+                      const casacore::IPosition &trc, casacore::Array<double> &buffer) const;
     
     /// @brief Determine whether an image has a mask
     /// @param[in] nam image name
@@ -102,6 +190,33 @@ struct FitsImageAccess : public IImageAccess<> {
     virtual casacore::LogicalArray readMask(const std::string &name, const casacore::IPosition &blc,
                                     const casacore::IPosition &trc) const override;
 
+    /// @brief read the mask for part of the image into the given buffer
+    /// @details The pixels are read into a scratch buffer reused between the calls
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with mask values - 1=good, 0=bad
+    virtual void readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                              const casacore::IPosition &trc, casacore::LogicalArray &buffer) const override;
+
+    /// @brief read the mask for part of the image with one bit per pixel
+    /// @details The mask is derived from the pixels read plane by plane, the summaries of
+    /// the whole image planes covered by the selection are cached for maskPlaneState.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return packed mask for the selection (set bit = good pixel)
+    virtual PackedMask readPackedMask(const std::string &name, const casacore::IPosition &blc,
+                                      const casacore::IPosition &trc) const override;
+
+    /// @brief obtain the summary of the mask of an image plane
+    /// @details The summaries are cached for the most recently used image until it is modified,
+    /// so the pixels of each plane are read at most once.
+    /// @param[in] name image name
+    /// @param[in] plane plane number (see PackedMask)
+    /// @return PackedMask::ALL_VALID, PackedMask::ALL_MASKED or PackedMask::PARTIAL
+    virtual PackedMask::PlaneState maskPlaneState(const std::string &name, size_t plane) const override;
+
         /// @brief obtain coordinate system info
         /// @param[in] name image name
         /// @return coordinate system object
@@ -123,6 +238,15 @@ struct FitsImageAccess : public IImageAccess<> {
         /// @return beam info list
         virtual BeamList beamList(const std::string &name) const override;
 
+        /// @brief obtain the restoring beam of a single channel
+        /// @details The cached metadata snapshot is used if it is up to date, otherwise
+        /// only the given row of the BEAMS table is read.
+        /// @param[in] name image name
+        /// @param[in] chan channel number
+        /// @return beam info vector
+        virtual casacore::Vector<casacore::Quantum<double> > channelBeam(const std::string &name,
+                                                                         unsigned int chan) const override;
+
         /// @brief obtain pixel units
         /// @param[in] name image name
         /// @return units string
@@ -142,6 +266,14 @@ struct FitsImageAccess : public IImageAccess<> {
         /// @return pair of strings - keyword value and comment
         virtual std::pair<std::string, std::string> getMetadataKeyword(const std::string &name, const std::string &keyword) const override;
 
+        /// @brief obtain a snapshot of the image metadata
+        /// @details The snapshot is cached for each image until the file is modified, the
+        /// shape, units, beams, keywords and mask presence getters are served from it. The
+        /// coordinate system is not filled for tile-compressed images.
+        /// @param[in] name image name
+        /// @return shared pointer to the snapshot
+        virtual boost::shared_ptr<const ImageMetadata> metadata(const std::string &name) const override;
+
         //////////////////
         // Writing methods
         //////////////////
@@ -168,6 +300,21 @@ struct FitsImageAccess : public IImageAccess<> {
         virtual void write(const std::string &name, const casacore::Array<float> &arr,
                            const casacore::IPosition &where) override;
 
+        /// @brief write full image in double precision
+        /// @details Intermediate products, e.g. weights or PSF sums, can be kept in FITS
+        /// images with BITPIX=-64 (see setBitpix) without loss of precision. The pixels
+        /// are not passed to the image statistics.
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        void write(const std::string &name, const casacore::Array<double> &arr);
+
+        /// @brief write a slice of an image in double precision
+        /// @details see the full image version for details
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels
+        /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+        void write(const std::string &name, const casacore::Array<double> &arr, const casacore::IPosition &where);
+
         /// @brief write full image and mask
         /// @param[in] name image name
         /// @param[in] mask array with mask
@@ -244,6 +391,24 @@ struct FitsImageAccess : public IImageAccess<> {
         /// @param[in] historyLines History comments to add
         virtual void addHistory(const std::string &name, const std::vector<std::string> &historyLines) override;
 
+        /// @brief write CHECKSUM and DATASUM keywords
+        /// @details The checksums are computed for all HDUs of the file, so this should be
+        /// the last change made to the image (any later update of the header or pixels
+        /// invalidates them). The image data are read back unless the data sum has been
+        /// accumulated during the writes (see useIncrementalChecksum).
+        /// @param[in] name Image name
+        void writeChecksum(const std::string &name);
+
+        /// @brief write CHECKSUM and DATASUM keywords using the given sum of the image data
+        /// @details This version is used when the pixels have been written by other means (e.g.
+        /// collectively by several ranks). The sum accumulated by this object, if any, is added.
+        /// If the number of pixels summed differs from the size of the image, some of them have
+        /// been overwritten or written elsewhere, the checksums are computed from the file instead.
+        /// @param[in] name Image name
+        /// @param[in] dataSum checksum of the pixels written by other means
+        /// @param[in] nPixels number of pixels covered by dataSum
+        void writeChecksum(const std::string &name, const FitsChecksum &dataSum, unsigned long long nPixels);
+
         /// @brief Write what is in the info object to FITS binary table.
         /// @param[in] name - name of the FITS file
         /// @param[in] info - In this case the info object is an instance of casacore::Record class.
@@ -268,10 +433,119 @@ struct FitsImageAccess : public IImageAccess<> {
         ///           indicates the unit of the first column in the table and so on.
         virtual void setInfo(const std::string &name, const casacore::RecordInterface &info) override;
 
+        /// @brief start a batch of header updates
+        /// @details Units, beam, keywords, history and info tables set for this image until
+        /// commitHeaderUpdate are staged in memory and written with the file opened once and
+        /// space for the new keywords made in one go. The read methods don't see the staged changes.
+        /// The changes are also written if another image is accessed or flush is called.
+        /// @param[in] name image name
+        virtual void beginHeaderUpdate(const std::string &name) override;
+
+        /// @brief write the header changes staged since beginHeaderUpdate
+        /// @param[in] name image name
+        virtual void commitHeaderUpdate(const std::string &name) override;
+
+    protected:
+        /// @brief drop the pixels cached for the given image
+        /// @details cfitsio buffers the file, so it is closed and reopened on demand
+        /// together with the memory map (see flush).
+        /// @param[in] name image name
+        virtual void refreshPixels(const std::string &name) const override;
+
+        /// @brief write the pixels buffered for the given image to disk
+        /// @details The file is kept open.
+        /// @param[in] name image name
+        virtual void syncPixels(const std::string &name) const override;
+
     private:
+        /// @brief obtain the parsed image
+        /// @details The casacore::FITSImage object is cached for the most recently read image.
+        /// It is recreated if another image is requested or the file has been modified since
+        /// it was parsed. Changes buffered by the writer are flushed first.
+        /// @param[in] name image name
+        /// @return reference to the image object (valid until the next call)
+        casacore::FITSImage& image(const std::string &name) const;
+
+        /// @brief obtain the mapped image
+        /// @details The map of the most recently read image is cached. It is recreated if
+        /// another image is requested or the file has been modified since it was mapped.
+        /// Changes buffered by the writer are flushed first.
+        /// @param[in] name image name
+        /// @return pointer to the mapped image or nullptr if the image can't be mapped
+        const FitsMappedImage* mappedImage(const std::string &name) const;
+
+        /// @brief write the changes buffered for the given image
+        /// @details The cached header, map and mask summaries of the image are dropped if
+        /// there was anything to write.
+        /// @param[in] fullname file name (including the extension)
+        void flushPending(const std::string &fullname) const;
+
+        /// @brief obtain the cached mask summaries of the given image
+        /// @details The cache is reset if another image is requested or the file has been
+        /// modified since the summaries were collected.
+        /// @param[in] name image name
+        /// @return summary for each plane, -1 if not known yet
+        std::vector<signed char>& planeStates(const std::string &name) const;
+
         mutable boost::shared_ptr<FITSImageRW> itsFITSImage;
         bool itsFastAlloc;
 
+        /// @brief number of keywords to reserve space for in new images
+        uint itsReservedKeywords;
+
+        /// @brief compression of new images
+        FitsCompression itsCompression;
+
+        /// @brief true, if the data sum of new images is accumulated during the writes
+        bool itsIncrementalChecksum;
+
+        /// @brief BITPIX of new images
+        int itsBitpix;
+
+        /// @brief minimum pixel value of new integer images
+        float itsMinPix;
+
+        /// @brief maximum pixel value of new integer images
+        float itsMaxPix;
+
+        /// @brief parsed image cached by the read methods
+        mutable boost::shared_ptr<casacore::FITSImage> itsCachedImage;
+
+        /// @brief file name of the cached image
+        mutable std::string itsCachedImageName;
+
+        /// @brief stamp of the file taken when itsCachedImage has been parsed
+        mutable FitsFileStamp itsCachedImageStamp;
+
+        /// @brief pixels read to derive the mask, reused to avoid allocations
+        mutable casacore::Array<float> itsMaskPixels;
+
+        /// @brief true, if uncompressed images are read through a memory map
+        bool itsUseMemoryMap;
+
+        /// @brief map of the most recently read image
+        mutable boost::shared_ptr<FitsMappedImage> itsMappedImage;
+
+        /// @brief cached metadata snapshot
+        struct CachedMetadata {
+            /// @brief the snapshot
+            boost::shared_ptr<const ImageMetadata> itsMetadata;
+            /// @brief stamp of the file taken when the snapshot has been made
+            FitsFileStamp itsStamp;
+        };
+
+        /// @brief metadata snapshots by file name (including the extension)
+        mutable std::map<std::string, CachedMetadata> itsMetadata;
+
+        /// @brief mask summary of each plane of the most recently used image, -1 if not known
+        mutable std::vector<signed char> itsPlaneStates;
+
+        /// @brief file name of the image the plane summaries refer to
+        mutable std::string itsPlaneStatesName;
+
+        /// @brief stamp of the file taken when the plane summaries have been reset
+        mutable FitsFileStamp itsPlaneStatesStamp;
+
 };
 
 
@@ -32,11 +32,19 @@
 #include <askap_accessors.h>
 
 #include <askap/askap/AskapLogging.h>
-#include <casacore/casa/OS/CanonicalConversion.h>
+#include <askap/dataaccess/LogRateLimiter.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicMath/Math.h>
 
 #include <askap/imageaccess/FitsImageAccessParallel.h>
+#include <askap/imageaccess/FitsPixelConversion.h>
+#include <askap/imageaccess/ImageRegionLock.h>
 
 #include <fitsio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cmath>
+#include <vector>
 
 ASKAP_LOGGER(logger, ".fitsImageAccessParallel");
 
@@ -47,11 +55,146 @@ using namespace askap::accessors;
 /// @param[in] comms, MPI communicator
 /// @param[in] axis, image axis to distribute over (i.e., for cube: 0,1,2 gives yz,xz,xy planes)
 FitsImageAccessParallel::FitsImageAccessParallel(askapparallel::AskapParallel &comms, uint axis):
-    itsComms(comms), itsAxis(axis), itsParallel(-1)
+    itsComms(comms), itsMPIComm(MPI_COMM_WORLD), itsAxis(axis), itsParallel(-1), itsCollectivePixels(0)
 {
     ASKAPLOG_INFO_STR(logger, "Creating parallel FITS accessor with data distributed over axis " << axis);
 }
 
+/// @brief use the given communicator for collective I/O
+/// @details All ranks of this communicator (and only them) have to take part in
+/// the collective operations. The communicator should stay valid while it is used.
+/// @param[in] comm MPI communicator (MPI_COMM_WORLD by default)
+void FitsImageAccessParallel::setCommunicator(MPI_Comm comm)
+{
+    ASKAPCHECK(comm != MPI_COMM_NULL, "Null communicator is given to FitsImageAccessParallel");
+    itsMPIComm = comm;
+    // the decision to use parallel I/O depends on the number of ranks
+    itsName = "";
+}
+
+/// @brief set MPI-IO hints
+/// @details The hints are passed to MPI_File_open and MPI_File_set_view, e.g.
+/// cb_nodes, cb_buffer_size, romio_cb_write or romio_cb_read. The striping hints
+/// (striping_factor and striping_unit) only take effect when the file is created,
+/// they are applied in create. All values are given as strings as per MPI standard.
+/// @param[in] hints map of hint names and values, an empty map resets to defaults
+void FitsImageAccessParallel::setHints(const std::map<std::string, std::string> &hints)
+{
+    itsHints = hints;
+    for (std::map<std::string, std::string>::const_iterator ci = itsHints.begin(); ci != itsHints.end(); ++ci) {
+         ASKAPCHECK(ci->first.size() < MPI_MAX_INFO_KEY, "MPI-IO hint name " << ci->first << " is too long");
+         ASKAPCHECK(ci->second.size() < MPI_MAX_INFO_VAL, "Value of the MPI-IO hint " << ci->first << " is too long");
+         ASKAPLOG_INFO_STR(logger, "Using MPI-IO hint " << ci->first << " = " << ci->second);
+    }
+}
+
+/// @brief build MPI info object with the hints
+/// @param[in] striping true to include striping hints (only used on file creation)
+/// @return MPI info object or MPI_INFO_NULL if there are no hints,
+///         the caller is responsible for freeing it
+MPI_Info FitsImageAccessParallel::makeInfo(bool striping) const
+{
+    MPI_Info info = MPI_INFO_NULL;
+    for (std::map<std::string, std::string>::const_iterator ci = itsHints.begin(); ci != itsHints.end(); ++ci) {
+         if (!striping && (ci->first.find("striping_") == 0)) {
+             continue;
+         }
+         if (info == MPI_INFO_NULL) {
+             MPI_Info_create(&info);
+         }
+         MPI_Info_set(info, const_cast<char*>(ci->first.c_str()), const_cast<char*>(ci->second.c_str()));
+    }
+    return info;
+}
+
+/// @brief create a new image
+/// @details If striping hints are given, the file is first created through MPI-IO by the
+/// calling rank, so the file system can set the stripe layout. The header is written
+/// by the serial writer afterwards as usual.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+void FitsImageAccessParallel::create(const std::string &name, const casacore::IPosition &shape,
+                                     const casacore::CoordinateSystem &csys)
+{
+    if ((itsHints.count("striping_factor") > 0) || (itsHints.count("striping_unit") > 0)) {
+        const std::string fullname = name + ".fits";
+        ASKAPLOG_INFO_STR(logger, "Creating " << fullname << " with the stripe layout given by MPI-IO hints");
+        // the layout is only set for a new file, truncation by the serial writer preserves it
+        unlink(fullname.c_str());
+        MPI_Info info = makeInfo(true);
+        MPI_File fh;
+        const int rc = MPI_File_open(MPI_COMM_SELF, const_cast<char*>(fullname.c_str()),
+                                     MPI_MODE_CREATE | MPI_MODE_WRONLY, info, &fh);
+        if (info != MPI_INFO_NULL) {
+            MPI_Info_free(&info);
+        }
+        ASKAPCHECK(rc == MPI_SUCCESS, "Unable to create " << fullname << " via MPI-IO");
+        MPI_File_close(&fh);
+    }
+    FitsImageAccess::create(name, shape, csys);
+    // the file is new, the cached properties need to be recomputed
+    itsName = "";
+    itsChecksumFile = incrementalChecksum() ? name + ".fits" : "";
+    itsCollectiveChecksum.reset();
+    itsCollectivePixels = 0;
+}
+
+/// @brief create a new image - collective operation
+/// @details The first rank of the communicator writes the header and extends the file
+/// to its full padded size, then the data offset is broadcast to all ranks, so they can
+/// start writing pixels straight away (e.g. with writeCollective or writeAll). All ranks
+/// of the communicator have to call this method. Header keywords added afterwards
+/// should fit into the reserved header space (see reserveKeywords), otherwise the data
+/// would have to be moved.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+void FitsImageAccessParallel::createCollective(const std::string &name, const casacore::IPosition &shape,
+                                               const casacore::CoordinateSystem &csys)
+{
+    int ok = 1;
+    if (rank() == 0) {
+        try {
+           create(name, shape, csys);
+           // the header has to be on disk before the data offset can be worked out
+           flush();
+        }
+        catch (const AskapError &ae) {
+           ASKAPLOG_ERROR_STR(logger, "Failed to create " << name << ": " << ae.what());
+           ok = 0;
+        }
+    }
+    MPI_Bcast(&ok, 1, MPI_INT, 0, itsMPIComm);
+    ASKAPCHECK(ok, "Collective creation of the FITS image " << name << " has failed");
+    // other ranks don't call create, but write their blocks into the new file as well
+    itsChecksumFile = incrementalChecksum() ? name + ".fits" : "";
+    itsCollectiveChecksum.reset();
+    itsCollectivePixels = 0;
+
+    DataFormat format;
+    decodeHeaderCollective(name + ".fits", format, true);
+    ASKAPCHECK(format.itsShape.product() == shape.product(), "FITS image " << name << " has been created with the shape " <<
+               format.itsShape << ", requested shape is " << shape);
+    cacheFormat(name, format);
+}
+
+/// @return rank in the communicator used for I/O
+int FitsImageAccessParallel::rank() const
+{
+    int result = 0;
+    MPI_Comm_rank(itsMPIComm, &result);
+    return result;
+}
+
+/// @return number of ranks in the communicator used for I/O
+int FitsImageAccessParallel::nProcs() const
+{
+    int result = 1;
+    MPI_Comm_size(itsMPIComm, &result);
+    return result;
+}
+
 // reading methods
 
 /// @brief read full image distributed by rank
@@ -70,8 +213,8 @@ casacore::Array<float> FitsImageAccessParallel::read(const std::string &name) co
 /// @param[in] trc top right corner of the selection
 /// @return array with pixels for the selection only
 /// @details The read operation will only be parallel when reading one entire
-/// plane along axes perpendicular to the distribution axis. The ranks should
-/// specify consecutive planes in rank order for this to work correctly.
+/// plane along axes perpendicular to the distribution axis. All ranks should
+/// read a plane at the same time for this to work correctly.
 casacore::Array<float> FitsImageAccessParallel::read(const std::string &name, const casacore::IPosition &blc,
                                                      const casacore::IPosition &trc) const
 {
@@ -79,8 +222,7 @@ casacore::Array<float> FitsImageAccessParallel::read(const std::string &name, co
     int section = blctrcTosection(blc,trc);
 
     if (section>=0 && parallel) {
-        int nsection = itsShape(itsAxis) / itsComms.nProcs();
-        return readAll(name, itsAxis, nsection, section);
+        return readCollective(name, blc, trc - blc + 1);
     } else {
         return FitsImageAccess::read(name, blc, trc);
     }
@@ -89,7 +231,10 @@ casacore::Array<float> FitsImageAccessParallel::read(const std::string &name, co
 /// @brief read part of the image - collective MPI read
 /// @param[in] name image name
 /// @param[in] iax, axis to distribute over: use 1 for 2D images,  0, 1 or 2 for x, y, z, i.e., yz planes, xz planes, xy planes
+/// @param[in] nsub, number of subarrays
+/// @param[in] sub, subarray number (0<=sub<nsub)
 /// @return array with pixels for the section of the image read
+/// @details The axis is split into nsub * #ranks blocks of nearly equal length.
 casacore::Array<float> FitsImageAccessParallel::readAll(const std::string &name,
     int iax, int nsub, int sub) const
 {
@@ -99,29 +244,50 @@ casacore::Array<float> FitsImageAccessParallel::readAll(const std::string &name,
     }
     ASKAPASSERT(iax>=0);
     ASKAPLOG_INFO_STR(logger, "Reading the FITS image " << name << " distributed over axis " << iax);
+    // changes buffered by the serial writer have to be on disk before MPI I/O
+    flush();
 
-    MPI_Datatype filetype;
-    MPI_Offset offset;
-    casa::IPosition bufshape;
-    setFileAccess(fullname, bufshape, offset, filetype, iax, nsub, sub);
-    MPI_File fh;
-    MPI_File_open(MPI_COMM_WORLD, fullname.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
-    MPI_File_set_view(fh, offset, MPI_FLOAT, filetype, "native", MPI_INFO_NULL);
-    const MPI_Offset bufsize = bufshape.product();  // local number to read
-    //casa::Float* buf = new casa::Float[bufsize];
-    boost::shared_array<casa::Float> buf {new casa::Float[bufsize]};
-    // Collective read of the whole cube
-    MPI_Status status;
-    MPI_File_read_all(fh, buf.get(), bufsize, MPI_FLOAT, &status);
-    MPI_File_close(&fh);
-    // Take care of endianness
-    casa::Array<casa::Float> buffer(bufshape);
-    casa::CanonicalConversion::toLocal(buffer.data(), buf.get(), bufsize);
-    //delete [] buf;
+    DataFormat format;
+    decodeHeaderCollective(fullname, format, false);
+    casacore::IPosition blc;
+    casacore::IPosition shape;
+    distribute(format.itsShape, iax, nsub, sub, blc, shape);
+    casacore::Array<float> buffer(shape);
+    casacore::Bool deleteIt;
+    casacore::Float *storage = buffer.getStorage(deleteIt);
+    transferBlock(fullname, format, blc, shape, storage, false);
+    buffer.putStorage(storage, deleteIt);
     if (nsub > 1) ASKAPLOG_INFO_STR(logger, " - returning section " << sub << ", an array with shape " << buffer.shape());
     return buffer;
 }
 
+/// @brief read a block of the image - collective MPI read
+/// @details Each rank reads its own block, the blocks may overlap.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the block read by this rank
+/// @param[in] shape shape of the block (zero-sized block if this rank doesn't need any data)
+/// @return array with pixels of the block
+casacore::Array<float> FitsImageAccessParallel::readCollective(const std::string &name,
+    const casacore::IPosition &blc, const casacore::IPosition &shape) const
+{
+    std::string fullname = name;
+    if (name.rfind(".fits") == std::string::npos) {
+        fullname = name + ".fits";
+    }
+    ASKAPLOG_HOTPATH_STR(logger, "Reading block from " << blc << " with the shape " << shape <<
+                         " of the FITS image " << name);
+    flush();
+
+    DataFormat format;
+    decodeHeaderCollective(fullname, format, false);
+    casacore::Array<float> buffer(shape);
+    casacore::Bool deleteIt;
+    casacore::Float *storage = buffer.getStorage(deleteIt);
+    transferBlock(fullname, format, blc, shape, storage, false);
+    buffer.putStorage(storage, deleteIt);
+    return buffer;
+}
+
 /// @brief Determine whether an image has a mask
 /// @param[in] nam image name
 /// @return True if image has a mask, False if not.
@@ -174,8 +340,8 @@ void FitsImageAccessParallel::write(const std::string &name, const casacore::Arr
 /// @param[in] arr array with pixels
 /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
 /// @details The write operation will only be parallel when writing one entire
-/// plane along axes perpendicular to the distribution axis. The ranks should
-/// specify consecutive planes in rank order for this to work correctly.
+/// plane along axes perpendicular to the distribution axis. All ranks should
+/// write a plane at the same time for this to work correctly.
 void FitsImageAccessParallel::write(const std::string &name, const casacore::Array<float> &arr,
                    const casacore::IPosition &where)
 {
@@ -186,21 +352,38 @@ void FitsImageAccessParallel::write(const std::string &name, const casacore::Arr
     int section = blctrcTosection(where, tlc);
 
     if (section>=0 && parallel) {
-        int nsection = itsShape(itsAxis) / itsComms.nProcs();
-        writeAll(name, arr, itsAxis, nsection, section);
+        writeCollective(name, arr, where);
     } else {
         FitsImageAccess::write(name, arr, where);
     }
 }
 
+/// @brief add pixels to a slice of an image
+/// @details The collective write can't be used as the other ranks don't take part.
+/// @param[in] name image name
+/// @param[in] arr array with pixels to add
+/// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+void FitsImageAccessParallel::addInto(const std::string &name, const casacore::Array<float> &arr,
+                                      const casacore::IPosition &where)
+{
+    const casacore::IPosition trc = where + arr.shape() - 1;
+    const ImageRegionLock::Guard guard(regionLock(name), shape(name), where, trc);
+    refreshPixels(name);
+    casacore::Array<float> buffer(arr.shape());
+    FitsImageAccess::readInto(name, where, trc, buffer);
+    buffer += arr;
+    FitsImageAccess::write(name, buffer, where);
+    syncPixels(name);
+}
+
 /// @brief write a slice of an image and mask
 /// @param[in] name image name
 /// @param[in] arr array with pixels
 /// @param[in] mask array with mask
 /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
 /// @details The write operation will only be parallel when writing one entire
-/// plane along axes perpendicular to the distribution axis. The ranks should
-/// specify consecutive planes in rank order for this to work correctly.
+/// plane along axes perpendicular to the distribution axis. All ranks should
+/// write a plane at the same time for this to work correctly.
 void FitsImageAccessParallel::write(const std::string &name, const casacore::Array<float> &arr,
                    const casacore::Array<bool> &mask, const casacore::IPosition &where)
 {
@@ -211,7 +394,6 @@ void FitsImageAccessParallel::write(const std::string &name, const casacore::Arr
    int section = blctrcTosection(where, tlc);
 
    if (section>=0 && parallel) {
-       int nsection = itsShape(itsAxis) / itsComms.nProcs();
        casacore::Array<float> arrmasked;
        arrmasked = arr;
        for(size_t i=0;i<arr.size();i++){
@@ -219,7 +401,7 @@ void FitsImageAccessParallel::write(const std::string &name, const casacore::Arr
                casacore::setNaN(arrmasked.data()[i]);
            }
        }
-       writeAll(name, arrmasked, itsAxis, nsection, section);
+       writeCollective(name, arrmasked, where);
    } else {
        FitsImageAccess::write(name, arr, mask, where);
    }
@@ -228,50 +410,213 @@ void FitsImageAccessParallel::write(const std::string &name, const casacore::Arr
 /// @brief write an image - collective MPI write.
 /// @details Note that the fits header must be written to disk before calling this.
 /// @param[in] name image name
-/// @param[in] arr array with pixels. Array dimension iax * #ranks must match the corresponding image dimension
+/// @param[in] arr array with pixels. The arrays of all ranks are stacked along iax in the rank
+/// order, they can have different lengths along this axis (including zero).
 /// @param[in] iax, axis to distribute over: 0, 1 or 2 for x, y, z, i.e., yz planes, xz planes, xy planes
+/// @param[in] nsub, number of subarrays
+/// @param[in] sub, subarray number (0<=sub<nsub), subarrays follow each other along iax
 void FitsImageAccessParallel::writeAll(const std::string &name,
     const casacore::Array<float> &arr, int iax, int nsub, int sub) const
 {
     ASKAPLOG_INFO_STR(logger, "Writing array with the shape " << arr.shape() << " into a FITS image " <<
                       name << " distributed over axis " << iax);
+    ASKAPASSERT(iax>=0);
+    ASKAPCHECK((sub >= 0) && (sub < nsub), "Subarray number " << sub << " is outside [0, " << nsub << ")");
+    // the length along iax is given by the array, the ranks follow each other
+    long length = (arr.nelements() == 0) ? 0 : (iax < static_cast<int>(arr.ndim()) ? arr.shape()(iax) : 1);
+    long before = 0;
+    long total = 0;
+    MPI_Exscan(&length, &before, 1, MPI_LONG, MPI_SUM, itsMPIComm);
+    if (rank() == 0) {
+        before = 0;
+    }
+    MPI_Allreduce(&length, &total, 1, MPI_LONG, MPI_SUM, itsMPIComm);
+    const casacore::uInt ndim = std::max(arr.ndim(), static_cast<casacore::uInt>(iax + 1));
+    casacore::IPosition where(ndim, 0);
+    where(iax) = sub * total + before;
+    writeCollective(name, arr, where);
+}
+
+/// @brief write a block of the image - collective MPI write
+/// @details Each rank writes its own block, the blocks shouldn't overlap. Ranks without
+/// data should pass an empty array. The file is extended to its full size if necessary.
+/// Note that the fits header must be written to disk before calling this.
+/// @param[in] name image name
+/// @param[in] arr array with pixels (trailing degenerate axes may be omitted)
+/// @param[in] where bottom left corner of the block written by this rank
+void FitsImageAccessParallel::writeCollective(const std::string &name, const casacore::Array<float> &arr,
+                                              const casacore::IPosition &where) const
+{
+    ASKAPLOG_HOTPATH_STR(logger, "Writing block with the shape " << arr.shape() << " at " << where <<
+                         " into a FITS image " << name);
     std::string fullname = name;
     if (name.rfind(".fits") == std::string::npos) {
       fullname = name + ".fits";
     }
-    ASKAPASSERT(iax>=0);
+    // the header written by the serial writer has to be on disk before MPI I/O
+    flush();
+
+    // the file is extended to its full size first, so the order of writes doesn't matter
+    DataFormat format;
+    decodeHeaderCollective(fullname, format, true);
+    const casacore::uInt ndim = format.itsShape.nelements();
+    ASKAPCHECK(arr.ndim() <= ndim, "Array with the shape " << arr.shape() << " has more dimensions than the image " <<
+               format.itsShape);
+    // the arrays with fewer dimensions are treated as degenerate along the trailing axes
+    casacore::IPosition blc(ndim, 0);
+    casacore::IPosition shape(ndim, arr.nelements() == 0 ? 0 : 1);
+    for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+         if (axis < where.nelements()) {
+             blc(axis) = where(axis);
+         }
+         if ((axis < arr.ndim()) && (arr.nelements() > 0)) {
+             shape(axis) = arr.shape()(axis);
+         }
+    }
+
+    casacore::Bool deleteIt;
+    const casacore::Float *storage = arr.getStorage(deleteIt);
+    transferBlock(fullname, format, blc, shape, const_cast<casacore::Float*>(storage), true);
+    arr.freeStorage(storage, deleteIt);
+    accumulateStatistics(arr, blc);
+
+    // All wait for the data to be written
+    MPI_Barrier(itsMPIComm);
+}
+
+/// @brief write CHECKSUM and DATASUM keywords - collective operation
+/// @details The sums of the blocks are combined across ranks, the header is then summed
+/// by the first rank which has written it (see FitsImageAccess::writeChecksum).
+/// @param[in] name image name
+void FitsImageAccessParallel::writeChecksumCollective(const std::string &name)
+{
+    const std::string fullname = name + ".fits";
+    int accumulated = (fullname == itsChecksumFile) ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &accumulated, 1, MPI_INT, MPI_MIN, itsMPIComm);
+    FitsChecksum total(itsCollectiveChecksum);
+    unsigned long long nPixels = itsCollectivePixels;
+    if (accumulated) {
+        total.reduce(itsMPIComm);
+        MPI_Allreduce(MPI_IN_PLACE, &nPixels, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, itsMPIComm);
+    }
+    int ok = 1;
+    if (rank() == 0) {
+        try {
+           if (accumulated) {
+               writeChecksum(name, total, nPixels);
+           } else {
+               writeChecksum(name);
+           }
+           flush();
+        }
+        catch (const AskapError &ae) {
+           ASKAPLOG_ERROR_STR(logger, "Failed to write checksums of " << name << ": " << ae.what());
+           ok = 0;
+        }
+    }
+    MPI_Bcast(&ok, 1, MPI_INT, 0, itsMPIComm);
+    ASKAPCHECK(ok, "Collective checksum update of the FITS image " << name << " has failed");
+}
 
-    MPI_Datatype filetype;
-    MPI_Offset offset;
-    casa::IPosition bufshape;
-    setFileAccess(fullname, bufshape, offset, filetype, iax, nsub, sub);
+/// @brief collective transfer of a block of the image
+/// @details The file view is an MPI subarray type, so any N-dimensional block can be
+/// transferred in one collective call. Ranks with an empty block take part in the call
+/// without transferring any data.
+/// @param[in] fullname file name (including the extension)
+/// @param[in] format data layout and encoding
+/// @param[in] blc bottom left corner of the block
+/// @param[in] shape shape of the block (same dimensionality as the image, may be empty)
+/// @param[in,out] data pixels of the block (blockShape.product() elements)
+/// @param[in] write true to write the block, false to read it
+void FitsImageAccessParallel::transferBlock(const std::string &fullname, const DataFormat &format,
+    const casacore::IPosition &blc, const casacore::IPosition &shape, float *data, bool write) const
+{
+    const casacore::uInt ndim = format.itsShape.nelements();
+    ASKAPCHECK((blc.nelements() == ndim) && (shape.nelements() == ndim), "Block at " << blc << " with the shape " <<
+               shape << " doesn't match the image shape " << format.itsShape);
+    MPI_Datatype etype = MPI_FLOAT;
+    switch (format.itsBitpix) {
+        case -32: etype = MPI_FLOAT; break;
+        case -64: etype = MPI_DOUBLE; break;
+        case 16: etype = MPI_SHORT; break;
+        case 32: etype = MPI_INT; break;
+        default: ASKAPTHROW(AskapError, "BITPIX=" << format.itsBitpix << " is not supported by collective FITS I/O");
+    }
+    const size_t bytesPerPixel = std::abs(format.itsBitpix) / 8;
+    const size_t nelements = shape.product() > 0 ? shape.product() : 0;
+
+    MPI_Datatype filetype = etype;
+    if (nelements > 0) {
+        std::vector<int> sizes(ndim);
+        std::vector<int> subsizes(ndim);
+        std::vector<int> starts(ndim);
+        for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+             ASKAPCHECK((blc(axis) >= 0) && (blc(axis) + shape(axis) <= format.itsShape(axis)), "Block at " << blc <<
+                        " with the shape " << shape << " is outside the image with the shape " << format.itsShape);
+             sizes[axis] = format.itsShape(axis);
+             subsizes[axis] = shape(axis);
+             starts[axis] = blc(axis);
+        }
+        MPI_Type_create_subarray(ndim, sizes.data(), subsizes.data(), starts.data(), MPI_ORDER_FORTRAN,
+                                 etype, &filetype);
+        MPI_Type_commit(&filetype);
+    }
 
+    MPI_Info info = makeInfo(false);
     MPI_File fh;
-    MPI_File_open(MPI_COMM_WORLD, fullname.c_str(), MPI_MODE_APPEND|MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
-    MPI_File_set_view(fh, offset, MPI_FLOAT, filetype, "native", MPI_INFO_NULL);
-    const MPI_Offset bufsize = bufshape.product();
-    casa::Float* buf = new casa::Float[bufsize];
-    if (arr.contiguousStorage()) {
-        casa::CanonicalConversion::fromLocal(buf, arr.data(), bufsize);
-    } else {
-        casa::Bool deleteIt;
-        const casa::Float *storage = arr.getStorage(deleteIt);
-        casa::CanonicalConversion::fromLocal(buf, storage, bufsize);
-        arr.freeStorage(storage, deleteIt);
+    const int rc = MPI_File_open(itsMPIComm, const_cast<char*>(fullname.c_str()),
+                                 write ? MPI_MODE_WRONLY : MPI_MODE_RDONLY, info, &fh);
+    if (rc != MPI_SUCCESS && info != MPI_INFO_NULL) {
+        MPI_Info_free(&info);
     }
+    ASKAPCHECK(rc == MPI_SUCCESS, "Unable to open " << fullname << " for collective I/O");
+    MPI_File_set_view(fh, format.itsHeaderSize, etype, filetype, const_cast<char*>("native"), info);
+    if (info != MPI_INFO_NULL) {
+        MPI_Info_free(&info);
+    }
+    boost::shared_array<char> buf {new char[std::max(nelements * bytesPerPixel, size_t(1))]};
     MPI_Status status;
-    MPI_File_write_all(fh, buf, bufsize, MPI_FLOAT, &status);
+    if (write) {
+        FitsPixelConversion::encode(data, nelements, format.itsBitpix, format.itsBScale, format.itsBZero,
+                                    format.itsHasBlank, format.itsBlank, buf.get());
+        MPI_File_write_all(fh, buf.get(), nelements, etype, &status);
+        if ((nelements > 0) && (fullname == itsChecksumFile)) {
+            itsCollectiveChecksum.addRawBlock(buf.get(), bytesPerPixel, format.itsShape, blc, shape);
+            itsCollectivePixels += nelements;
+        }
+    } else {
+        MPI_File_read_all(fh, buf.get(), nelements, etype, &status);
+        FitsPixelConversion::decode(buf.get(), nelements, format.itsBitpix, format.itsBScale, format.itsBZero,
+                                    format.itsHasBlank, format.itsBlank, data);
+    }
     MPI_File_close(&fh);
-    delete [] buf;
-
-    // Add fits padding to make file size multiple of 2880
-    if (itsComms.isMaster() && sub == nsub-1) {
-        fitsPadding(fullname);
+    if (nelements > 0) {
+        MPI_Type_free(&filetype);
     }
+}
 
-    // All wait for padding to be written
-    itsComms.barrier();
-
+/// @brief block of the image for the given rank and subarray
+/// @details The axis is split into nsub * #ranks nearly equal blocks.
+/// @param[in] imageShape image shape
+/// @param[in] iax axis to distribute over
+/// @param[in] nsub number of subarrays
+/// @param[in] sub subarray number
+/// @param[out] blc bottom left corner of the block
+/// @param[out] shape shape of the block
+void FitsImageAccessParallel::distribute(const casacore::IPosition &imageShape, int iax, int nsub, int sub,
+                                         casacore::IPosition &blc, casacore::IPosition &shape) const
+{
+    ASKAPCHECK(iax < static_cast<int>(imageShape.nelements()), "Unable to distribute over axis " << iax <<
+               " of the image with the shape " << imageShape);
+    ASKAPCHECK((sub >= 0) && (sub < nsub), "Subarray number " << sub << " is outside [0, " << nsub << ")");
+    const long nblocks = static_cast<long>(nsub) * nProcs();
+    const long block = rank() + static_cast<long>(sub) * nProcs();
+    const long length = imageShape(iax);
+    blc.resize(imageShape.nelements());
+    blc = 0;
+    shape = imageShape;
+    blc(iax) = block * length / nblocks;
+    shape(iax) = (block + 1) * length / nblocks - blc(iax);
 }
 
 /// @brief check if we can do parallel I/O on the file
@@ -279,25 +624,39 @@ bool FitsImageAccessParallel::canDoParallelIO(const std::string &name) const
 {
     if (name != itsName) {
         // we keep some values cached so cast away const
-        FitsImageAccessParallel *This = (FitsImageAccessParallel *) this;
-        This->itsName = name;
-        casa::IPosition imageShape;
-        casa::Long headersize;
         std::string fullname = name;
         if (name.rfind(".fits") == std::string::npos) {
             fullname = name + ".fits";
         }
-        decodeHeader(fullname, imageShape, headersize);
-        int ndim = imageShape.size();
-        This->itsShape.resize(ndim);
-        This->itsShape = imageShape;
-        ASKAPCHECK(itsAxis < ndim, "imageaccess.axis needs to be less than number of image axes");
-        This->itsParallel = ( itsShape(itsAxis) % itsComms.nProcs() == 0  );
-        if (ndim>3) This->itsParallel &= itsShape(2)==1 || itsShape(3)==1;
+        DataFormat format;
+        decodeHeader(fullname, format);
+        cacheFormat(name, format);
     }
     return itsParallel;
 }
 
+/// @brief cache the properties of the image used to decide on parallel I/O
+/// param[in]  name image name as given by the user
+/// param[in]  format data layout and encoding
+void FitsImageAccessParallel::cacheFormat(const std::string& name, const DataFormat& format) const
+{
+    // we keep some values cached so cast away const
+    FitsImageAccessParallel *This = (FitsImageAccessParallel *) this;
+    This->itsName = name;
+    int ndim = format.itsShape.size();
+    This->itsShape.resize(ndim);
+    This->itsShape = format.itsShape;
+    // the primary HDU has no data for compressed images, they are accessed serially
+    if (ndim == 0) {
+        This->itsParallel = false;
+        return;
+    }
+    ASKAPCHECK(itsAxis < ndim, "imageaccess.axis needs to be less than number of image axes");
+    This->itsParallel = ( itsShape(itsAxis) % nProcs() == 0  );
+    This->itsParallel &= (format.itsBitpix == -32) || (format.itsBitpix == -64) ||
+                         (format.itsBitpix == 16) || (format.itsBitpix == 32);
+}
+
 /// @brief turn blc/trc into a section of the cube to read
 /// @param[in] blc bottom left corner of the selection
 /// @param[in] trc top right corner of the selection
@@ -313,7 +672,7 @@ int FitsImageAccessParallel::blctrcTosection(const casacore::IPosition & blc, co
             ok = ok && blc(i) == trc(i);
         }
     }
-    if (ok) return blc(itsAxis) / itsComms.nProcs();
+    if (ok) return blc(itsAxis) / nProcs();
     return -1;
 }
 
@@ -323,6 +682,7 @@ int FitsImageAccessParallel::blctrcTosection(const casacore::IPosition & blc, co
 void FitsImageAccessParallel::copyHeader(const casa::String &infile, const casa::String& outfile) const
 {
     using namespace std;
+    flush();
     // get header size
     casa::IPosition shape;
     casa::Long headersize;
@@ -480,6 +840,7 @@ void FitsImageAccessParallel::copyHeaderWithHistoryKW(const casa::String &infile
                                                          const std::vector<std::string>& historyLines) const
 {
     using namespace std;
+    flush();
 
     ASKAPCHECK(!historyLines.empty(), "FitsImageAccessParallel::copy_header_historykw historyLines argument is empty");
 
@@ -515,53 +876,25 @@ void FitsImageAccessParallel::copyHeaderWithHistoryKW(const casa::String &infile
     }
 }
 
-/// @brief determine the file access pattern, offset to start reading or writing and the buffer shape needed
-void FitsImageAccessParallel::setFileAccess(const casa::String& name,
-    casa::IPosition& bufshape, MPI_Offset& offset, MPI_Datatype&  filetype, int iax,
-    int nsub, int sub) const
-{
-    std::string fullname = name;
-    if (fullname.rfind(".fits") == std::string::npos) {
-        fullname += ".fits";
-    }
-    ASKAPLOG_DEBUG_STR(logger,"setFileAccess: name - " << name
-                        << ", fullname - " << fullname);
-    // get header and data size, get image dimensions
-    casa::IPosition imageShape;
-    casa::Long headersize;
-    decodeHeader(fullname, imageShape, headersize);
-    int nz = imageShape(2);
-    if (imageShape.size()>3) nz *= imageShape(3);
-    // Now work out the file access pattern and start offset
-    MPI_Status status;
-    const int myrank = itsComms.rank();
-    const int numprocs = itsComms.nProcs();
-    int nplane = imageShape(iax) / numprocs / nsub;
-    ASKAPASSERT(imageShape(iax) == nsub * nplane * numprocs);
-    bufshape = imageShape;
-    bufshape(iax) = nplane;
-    MPI_Offset blocksize = nplane;
-    for (int i=1; i<=iax; i++) blocksize *= bufshape(i-1);   // number of contiguous floats
-
-    // # blocks, blocklength, stride (distance between blocks)
-    if (iax == 0) {
-        MPI_Type_vector(imageShape(2)*nz, blocksize, imageShape(0), MPI_FLOAT, &filetype);
-    } else if (iax == 1) {
-        MPI_Type_vector(nz, blocksize, imageShape(0)*imageShape(1), MPI_FLOAT, &filetype);
-    } else {
-        MPI_Type_vector(1, blocksize, blocksize, MPI_FLOAT, &filetype);
-    }
-    MPI_Type_commit(&filetype);
-    offset = headersize + (myrank + sub * numprocs) * blocksize * sizeof(float);
-}
-
-/// @brief determine image dimensions (up to 3 non degenerate axes) and headersize from file
+/// @brief determine image dimensions and headersize from file
 /// param[in]  infile filename
 /// param[out] imageShape image dimension
 /// param[out] headerSize the size in bytes of the header section (i.e the start of the data section)
 ///                       of a fits file.
 void FitsImageAccessParallel::decodeHeader(const casa::String& infile, casa::IPosition& imageShape,
                     casa::Long& headerSize) const
+{
+    DataFormat format;
+    decodeHeader(infile, format);
+    imageShape.resize(0);
+    imageShape = format.itsShape;
+    headerSize = format.itsHeaderSize;
+}
+
+/// @brief determine the layout and encoding of the data from file
+/// param[in]  infile filename
+/// param[out] format data layout and encoding
+void FitsImageAccessParallel::decodeHeader(const casa::String& infile, DataFormat& format) const
 {
     fitsfile *infptr;  // FITS file pointers
     int status = 0;  // CFITSIO status value MUST be initialized to zero!
@@ -574,22 +907,112 @@ void FitsImageAccessParallel::decodeHeader(const casa::String& infile, casa::IPo
     fits_open_file(&infptr, fullinfile.c_str(), READONLY, &status); // open input image
     if (status) {
         fits_report_error(stderr, status); // print error message
-        return;
+        ASKAPTHROW(AskapError, "Unable to open FITS file " << fullinfile);
     }
     LONGLONG headstart, datastart, dataend;
     fits_get_hduaddrll (infptr, &headstart, &datastart, &dataend, &status);
     ASKAPLOG_DEBUG_STR(logger,"header starts at: "<<headstart<<" data start: "<<datastart<<" end: "<<dataend);
-    headerSize = datastart;
-    int naxis;
-    long naxes[4];
-    fits_get_img_dim(infptr, &naxis, &status);  // read dimensions
-    //ASKAPLOG_INFO_STR(logger,"Input image #dimensions: " << naxis);
-    fits_get_img_size(infptr, 4, naxes, &status);
-    imageShape.resize(0);
-    ASKAPCHECK("naxis==3||naxis==4","FITS image must have 3 or 4 axes");
-    if (naxis==3) imageShape = casacore::IPosition(naxis,naxes[0],naxes[1],naxes[2]);
-    if (naxis==4) imageShape = casacore::IPosition(naxis,naxes[0],naxes[1],naxes[2],naxes[3]);
+    format.itsHeaderSize = datastart;
+    int naxis = 0;
+    fits_get_img_param(infptr, 0, &format.itsBitpix, &naxis, nullptr, &status);
+    std::vector<long> naxes(std::max(naxis, 1));
+    fits_get_img_size(infptr, naxis, naxes.data(), &status);
+    format.itsShape.resize(naxis);
+    for (int axis = 0; axis < naxis; ++axis) {
+         format.itsShape(axis) = naxes[axis];
+    }
+    // optional keywords
+    int keyStatus = 0;
+    format.itsBScale = 1.;
+    format.itsBZero = 0.;
+    format.itsHasBlank = false;
+    format.itsBlank = 0;
+    if (fits_read_key(infptr, TDOUBLE, "BSCALE", &format.itsBScale, nullptr, &keyStatus)) {
+        format.itsBScale = 1.;
+        keyStatus = 0;
+    }
+    if (fits_read_key(infptr, TDOUBLE, "BZERO", &format.itsBZero, nullptr, &keyStatus)) {
+        format.itsBZero = 0.;
+        keyStatus = 0;
+    }
+    if (format.itsBitpix > 0) {
+        format.itsHasBlank = (fits_read_key(infptr, TLONG, "BLANK", &format.itsBlank, nullptr, &keyStatus) == 0);
+    }
     fits_close_file(infptr, &status);
+    ASKAPCHECK(status == 0, "Failed to read the header of " << fullinfile << ", cfitsio status = " << status);
+}
+
+/// @brief determine the layout and encoding of the data - collective operation
+/// @details The header is only read by the first rank and the result is broadcast,
+/// so the file is not opened by every rank. Errors are rethrown on all ranks.
+/// param[in]  fullname file name (including the extension)
+/// param[out] format data layout and encoding
+/// param[in]  extend if true, the file is extended to its full padded size before
+///            the result is broadcast
+void FitsImageAccessParallel::decodeHeaderCollective(const std::string& fullname, DataFormat& format,
+                                                     bool extend) const
+{
+    // naxis (or -1 on error), header size, bitpix, hasBlank and blank
+    long meta[5] = {-1, 0, 0, 0, 0};
+    double scaling[2] = {1., 0.};
+    if (rank() == 0) {
+        try {
+           decodeHeader(fullname, format);
+           if (extend) {
+               extendFile(fullname, format);
+           }
+           meta[0] = format.itsShape.nelements();
+           meta[1] = format.itsHeaderSize;
+           meta[2] = format.itsBitpix;
+           meta[3] = format.itsHasBlank ? 1 : 0;
+           meta[4] = format.itsBlank;
+           scaling[0] = format.itsBScale;
+           scaling[1] = format.itsBZero;
+        }
+        catch (const AskapError &ae) {
+           ASKAPLOG_ERROR_STR(logger, "Failed to decode the header of " << fullname << ": " << ae.what());
+           meta[0] = -1;
+        }
+    }
+    MPI_Bcast(meta, 5, MPI_LONG, 0, itsMPIComm);
+    ASKAPCHECK(meta[0] >= 0, "Unable to decode the header of " << fullname);
+    std::vector<long> shape(std::max(meta[0], 1L));
+    if (rank() == 0) {
+        for (long axis = 0; axis < meta[0]; ++axis) {
+             shape[axis] = format.itsShape(axis);
+        }
+    }
+    MPI_Bcast(shape.data(), meta[0], MPI_LONG, 0, itsMPIComm);
+    MPI_Bcast(scaling, 2, MPI_DOUBLE, 0, itsMPIComm);
+    format.itsShape.resize(meta[0]);
+    for (long axis = 0; axis < meta[0]; ++axis) {
+         format.itsShape(axis) = shape[axis];
+    }
+    format.itsHeaderSize = meta[1];
+    format.itsBitpix = static_cast<int>(meta[2]);
+    format.itsHasBlank = (meta[3] != 0);
+    format.itsBlank = meta[4];
+    format.itsBScale = scaling[0];
+    format.itsBZero = scaling[1];
+}
+
+/// @brief extend the file to its full size including FITS padding
+/// @details Writes are then just overwriting the existing blocks and may come in any order.
+/// param[in]  fullname file name (including the extension)
+/// param[in]  format data layout and encoding
+void FitsImageAccessParallel::extendFile(const std::string& fullname, const DataFormat& format) const
+{
+    const int bytesPerPixel = std::abs(format.itsBitpix) / 8;
+    off_t fullSize = format.itsHeaderSize + format.itsShape.product() * bytesPerPixel;
+    if (fullSize % 2880) {
+        fullSize += 2880 - (fullSize % 2880);
+    }
+    struct stat buf;
+    ASKAPCHECK(stat(fullname.c_str(), &buf) == 0, "Unable to stat " << fullname);
+    if (buf.st_size < fullSize) {
+        ASKAPCHECK(truncate(fullname.c_str(), fullSize) == 0, "Unable to extend " << fullname <<
+                   " to " << fullSize << " bytes");
+    }
 }
 
 /// @brief add padding to the fits file to make it complient
@@ -33,6 +33,8 @@
 
 #include <boost/shared_ptr.hpp>
 #include <boost/shared_array.hpp>
+#include <map>
+#include <string>
 
 #include <mpi.h>
 #include <askap/askapparallel/MPIComms.h>
@@ -43,9 +45,13 @@ namespace accessors {
 
 /// @brief Access casa image using collective MPI I/O
 /// @details This class adds collective read/write functions for FITS images
-/// At present it can deal with 2D images and 3D cubes. Both images and cubes can
-/// have up to 4 dimensions, but only 3 can differ from 1. For cubes one of the last
-/// last two dimensions must be 1.
+/// Each rank reads or writes an arbitrary N-dimensional block of the primary HDU
+/// (described by an MPI subarray type), blocks may have different shapes on different
+/// ranks and some ranks may have no data at all. The data can be stored as 32- or 64-bit
+/// floating point numbers or as scaled 16- or 32-bit integers (BITPIX -32, -64, 16 or 32
+/// with BSCALE, BZERO and BLANK), pixels are always exchanged as floats.
+/// The collective operations are done within MPI_COMM_WORLD unless another communicator
+/// is given, so the accessor can be used by a sub-group of a larger job.
 /// Distribution over the 1st axis (iax=0) may be less efficient than over the 2nd or 3rd.
 /// @ingroup imageaccess
 
@@ -54,11 +60,33 @@ namespace accessors {
 class FitsImageAccessParallel : public FitsImageAccess {
 
     public:
+        // the overloads not redefined here are serial
+        using FitsImageAccess::read;
+        using FitsImageAccess::readInto;
+        using FitsImageAccess::write;
+
         /// @brief constructor
         /// @param[in] comms, MPI communicator
         /// @param[in] axis, image axis to distribute over (i.e., for cube: 0,1,2 gives yz,xz,xy planes)
         FitsImageAccessParallel(askapparallel::AskapParallel &comms, uint axis = 0);
 
+        /// @brief use the given communicator for collective I/O
+        /// @details All ranks of this communicator (and only them) have to take part in
+        /// the collective operations. The communicator should stay valid while it is used.
+        /// @param[in] comm MPI communicator (MPI_COMM_WORLD by default)
+        void setCommunicator(MPI_Comm comm);
+
+        /// @brief set MPI-IO hints
+        /// @details The hints are passed to MPI_File_open and MPI_File_set_view, e.g.
+        /// cb_nodes, cb_buffer_size, romio_cb_write or romio_cb_read. The striping hints
+        /// (striping_factor and striping_unit) only take effect when the file is created,
+        /// they are applied in create. All values are given as strings as per MPI standard.
+        /// @param[in] hints map of hint names and values, an empty map resets to defaults
+        void setHints(const std::map<std::string, std::string> &hints);
+
+        /// @return MPI-IO hints set for this accessor
+        inline const std::map<std::string, std::string>& hints() const { return itsHints; }
+
         /// @brief read full image distributed by rank
         /// @param[in] name image name
         /// @return array with pixels
@@ -100,6 +128,38 @@ class FitsImageAccessParallel : public FitsImageAccess {
         casacore::Array<float> readAll(const std::string &name, int iax,
                                         int nsub=1, int sub=0) const;
 
+        /// @brief read a block of the image - collective MPI read
+        /// @details Each rank reads its own block, the blocks may overlap.
+        /// @param[in] name image name
+        /// @param[in] blc bottom left corner of the block read by this rank
+        /// @param[in] shape shape of the block (zero-sized block if this rank doesn't need any data)
+        /// @return array with pixels of the block
+        casacore::Array<float> readCollective(const std::string &name, const casacore::IPosition &blc,
+                                              const casacore::IPosition &shape) const;
+
+        /// @brief create a new image
+        /// @details If striping hints are given, the file is first created through MPI-IO by the
+        /// calling rank, so the file system can set the stripe layout. The header is written
+        /// by the serial writer afterwards as usual.
+        /// @param[in] name image name
+        /// @param[in] shape full shape of the image
+        /// @param[in] csys coordinate system of the full image
+        virtual void create(const std::string &name, const casacore::IPosition &shape,
+                            const casacore::CoordinateSystem &csys) override;
+
+        /// @brief create a new image - collective operation
+        /// @details The first rank of the communicator writes the header and extends the file
+        /// to its full padded size, then the data offset is broadcast to all ranks, so they can
+        /// start writing pixels straight away (e.g. with writeCollective or writeAll). All ranks
+        /// of the communicator have to call this method. Header keywords added afterwards
+        /// should fit into the reserved header space (see reserveKeywords), otherwise the data
+        /// would have to be moved.
+        /// @param[in] name image name
+        /// @param[in] shape full shape of the image
+        /// @param[in] csys coordinate system of the full image
+        void createCollective(const std::string &name, const casacore::IPosition &shape,
+                              const casacore::CoordinateSystem &csys);
+
         /// @brief write full image across ranks
         /// @param[in] name image name
         virtual void write(const std::string &name, const casacore::Array<float> &arr) override;
@@ -119,17 +179,46 @@ class FitsImageAccessParallel : public FitsImageAccess {
         virtual void write(const std::string &name, const casacore::Array<float> &arr,
                            const casacore::Array<bool> &mask, const casacore::IPosition &where) override;
 
+        /// @brief add pixels to a slice of an image
+        /// @details see IImageAccess::addInto. The update is always done by this rank alone
+        /// through the serial code, even for whole planes, so ranks may add into the image
+        /// independently of each other.
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels to add
+        /// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+        virtual void addInto(const std::string &name, const casacore::Array<float> &arr,
+                             const casacore::IPosition &where) override;
+
 
         /// @brief write an image - collective MPI write.
         /// @details Note that the fits header must be written to disk before calling this.
         /// @param[in] name image name
-        /// @param[in] arr array with pixels. Array dimension iax * #ranks must match the corresponding image dimension
+        /// @param[in] arr array with pixels. The arrays of all ranks are stacked along iax in the rank
+        /// order, they can have different lengths along this axis (including zero).
         /// @param[in] iax, axis to distribute over: 0, 1 or 2 for x, y, z, i.e., yz planes, xz planes, xy planes
         /// @param[in] nsub, number of subarrays
-        /// @param[in] sub, subarray number (0<=sub<nsub)
+        /// @param[in] sub, subarray number (0<=sub<nsub), subarrays follow each other along iax
         void writeAll(const std::string &name, const casacore::Array<float> &arr, int iax,
                        int nsub=1, int sub=0) const;
 
+        /// @brief write a block of the image - collective MPI write
+        /// @details Each rank writes its own block, the blocks shouldn't overlap. Ranks without
+        /// data should pass an empty array. The file is extended to its full size if necessary.
+        /// Note that the fits header must be written to disk before calling this.
+        /// @param[in] name image name
+        /// @param[in] arr array with pixels (trailing degenerate axes may be omitted)
+        /// @param[in] where bottom left corner of the block written by this rank
+        void writeCollective(const std::string &name, const casacore::Array<float> &arr,
+                             const casacore::IPosition &where) const;
+
+        /// @brief write CHECKSUM and DATASUM keywords - collective operation
+        /// @details If the image has been created by this object with the incremental checksum
+        /// enabled (see useIncrementalChecksum), the sums of the blocks written by all ranks
+        /// are combined and the file is not read back. Otherwise the checksums are computed
+        /// from the file by the first rank. All ranks of the communicator have to call this method.
+        /// @param[in] name image name
+        void writeChecksumCollective(const std::string &name);
+
         /// @brief copy the header of a fits image (i.e., copies the fits 'cards' preceeding the data)
         /// @param[in] infile, the input fits file
         /// @param[in] outfile, the output fits file (overwritten if it exists)
@@ -144,9 +233,60 @@ class FitsImageAccessParallel : public FitsImageAccess {
                           const std::vector<std::string>& historyLines) const;
 
     private:
+        /// @brief layout and encoding of the data in the primary HDU
+        struct DataFormat {
+            /// @brief image shape
+            casacore::IPosition itsShape;
+            /// @brief offset of the data in bytes
+            casacore::Long itsHeaderSize;
+            /// @brief BITPIX
+            int itsBitpix;
+            /// @brief BSCALE
+            double itsBScale;
+            /// @brief BZERO
+            double itsBZero;
+            /// @brief true, if BLANK is defined
+            bool itsHasBlank;
+            /// @brief BLANK (integer data only)
+            long itsBlank;
+        };
+
         /// @brief check if we can do parallel I/O on the file
         bool canDoParallelIO(const std::string &name) const;
 
+        /// @brief collective transfer of a block of the image
+        /// @param[in] fullname file name (including the extension)
+        /// @param[in] format data layout and encoding
+        /// @param[in] blc bottom left corner of the block
+        /// @param[in] shape shape of the block (same dimensionality as the image, may be empty)
+        /// @param[in,out] data pixels of the block (blockShape.product() elements)
+        /// @param[in] write true to write the block, false to read it
+        void transferBlock(const std::string &fullname, const DataFormat &format, const casacore::IPosition &blc,
+                           const casacore::IPosition &shape, float *data, bool write) const;
+
+        /// @brief block of the image for the given rank and subarray
+        /// @details The axis is split into nsub * #ranks nearly equal blocks.
+        /// @param[in] imageShape image shape
+        /// @param[in] iax axis to distribute over
+        /// @param[in] nsub number of subarrays
+        /// @param[in] sub subarray number
+        /// @param[out] blc bottom left corner of the block
+        /// @param[out] shape shape of the block
+        void distribute(const casacore::IPosition &imageShape, int iax, int nsub, int sub,
+                        casacore::IPosition &blc, casacore::IPosition &shape) const;
+
+        /// @return rank in the communicator used for I/O
+        int rank() const;
+
+        /// @brief build MPI info object with the hints
+        /// @param[in] striping true to include striping hints (only used on file creation)
+        /// @return MPI info object or MPI_INFO_NULL if there are no hints,
+        ///         the caller is responsible for freeing it
+        MPI_Info makeInfo(bool striping) const;
+
+        /// @return number of ranks in the communicator used for I/O
+        int nProcs() const;
+
         /// @brief turn blc/trc into a section of the cube to read
         /// @param[in] blc bottom left corner of the selection
         /// @param[in] trc top right corner of the selection
@@ -160,14 +300,35 @@ class FitsImageAccessParallel : public FitsImageAccess {
         /// data section) of a fits file.
         void decodeHeader(const casa::String& infile, casa::IPosition& imageShape, casa::Long& headersize) const;
 
+        /// @brief determine the layout and encoding of the data from file
+        /// param[in]  infile filename
+        /// param[out] format data layout and encoding
+        void decodeHeader(const casa::String& infile, DataFormat& format) const;
+
+        /// @brief determine the layout and encoding of the data - collective operation
+        /// @details The header is only read by the first rank and the result is broadcast,
+        /// so the file is not opened by every rank. Errors are rethrown on all ranks.
+        /// param[in]  fullname file name (including the extension)
+        /// param[out] format data layout and encoding
+        /// param[in]  extend if true, the file is extended to its full padded size before
+        ///            the result is broadcast
+        void decodeHeaderCollective(const std::string& fullname, DataFormat& format, bool extend) const;
+
+        /// @brief extend the file to its full size including FITS padding
+        /// @details Writes are then just overwriting the existing blocks and may come in any order.
+        /// param[in]  fullname file name (including the extension)
+        /// param[in]  format data layout and encoding
+        void extendFile(const std::string& fullname, const DataFormat& format) const;
+
+        /// @brief cache the properties of the image used to decide on parallel I/O
+        /// param[in]  name image name as given by the user
+        /// param[in]  format data layout and encoding
+        void cacheFormat(const std::string& name, const DataFormat& format) const;
+
         /// @brief add padding to the fits file to make it complient
         /// param[in]  filename   name of fits file
         void fitsPadding(const casa::String& filename) const;
 
-        /// @brief determine the file access pattern, offset to start reading or writing and the buffer shape needed
-        void setFileAccess(const casa::String& fullname, casa::IPosition& bufshape,
-            MPI_Offset& offset, MPI_Datatype&  filetype, casacore::Int iax, int nsub, int sub) const;
-
         /// @brief copy the fits keywords (not including the END keyword) from the input fits file in the header array.
         /// @param[in]  fullinfile fits input file
         /// @param[out] header an array to store the keywords (minus the END keyword) of the input file
@@ -203,10 +364,20 @@ class FitsImageAccessParallel : public FitsImageAccess {
         static constexpr unsigned long KEYWORD_NAME_SIZE = 8; // number of bytes per keyword name
 
         askapparallel::AskapParallel& itsComms;
+        /// @brief communicator used for collective I/O
+        MPI_Comm itsMPIComm;
+        /// @brief MPI-IO hints
+        std::map<std::string, std::string> itsHints;
         uint itsAxis;
         int itsParallel;
         std::string itsName;
         casacore::IPosition itsShape;
+        /// @brief file the data sum is accumulated for, empty if none
+        std::string itsChecksumFile;
+        /// @brief sum of the blocks written by this rank through collective I/O
+        mutable FitsChecksum itsCollectiveChecksum;
+        /// @brief number of pixels written by this rank through collective I/O
+        mutable unsigned long long itsCollectivePixels;
 };
 
 
@@ -0,0 +1,223 @@
+/// @file FitsMappedImage.cc
+/// @brief Read uncompressed FITS images through a memory map
+/// @details The pixels are gathered straight from the mapped file and converted
+/// to the host byte order.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/imageaccess/FitsMappedImage.h>
+#include <askap/imageaccess/FitsPixelConversion.h>
+
+#include <fitsio.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".FitsMappedImage");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief map the given file
+/// @details An exception is thrown if the file can't be opened or its header can't be
+/// read. Files with unsupported layout are not mapped, isMapped returns false for them.
+/// @param[in] fname file name (including the extension)
+FitsMappedImage::FitsMappedImage(const std::string &fname) : itsFileName(fname), itsStamp(fname),
+    itsAddr(nullptr), itsSize(0), itsDataOffset(0), itsBitpix(0), itsBScale(1.), itsBZero(0.), itsHasBlank(false),
+    itsBlank(0)
+{
+    // decode the header of the primary HDU
+    fitsfile *fptr = nullptr;
+    int status = 0;
+    ASKAPCHECK(fits_open_file(&fptr, fname.c_str(), READONLY, &status) == 0,
+               "Unable to open FITS image " << fname << ", cfitsio status " << status);
+    int naxis = 0;
+    std::vector<LONGLONG> axes(99, 0);
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    fits_get_img_paramll(fptr, static_cast<int>(axes.size()), &itsBitpix, &naxis, axes.data(), &status);
+    fits_get_hduaddrll(fptr, &headStart, &dataStart, &dataEnd, &status);
+    if (status == 0) {
+        fits_read_key(fptr, TDOUBLE, "BSCALE", &itsBScale, nullptr, &status);
+        if (status == KEY_NO_EXIST) {
+            status = 0;
+        }
+    }
+    if (status == 0) {
+        fits_read_key(fptr, TDOUBLE, "BZERO", &itsBZero, nullptr, &status);
+        if (status == KEY_NO_EXIST) {
+            status = 0;
+        }
+    }
+    if ((status == 0) && (itsBitpix > 0)) {
+        fits_read_key(fptr, TLONG, "BLANK", &itsBlank, nullptr, &status);
+        itsHasBlank = (status == 0);
+        if (status == KEY_NO_EXIST) {
+            status = 0;
+        }
+    }
+    const int readStatus = status;
+    status = 0;
+    fits_close_file(fptr, &status);
+    ASKAPCHECK(readStatus == 0, "Unable to read the header of FITS image " << fname << ", cfitsio status " <<
+               readStatus);
+
+    // compressed images have an empty primary HDU
+    if ((naxis == 0) || ((itsBitpix != -32) && (itsBitpix != -64) && (itsBitpix != 16) && (itsBitpix != 32))) {
+        ASKAPLOG_DEBUG_STR(logger, "FITS image " << fname << " is not mapped: NAXIS = " << naxis <<
+                           ", BITPIX = " << itsBitpix);
+        return;
+    }
+    itsShape.resize(naxis);
+    size_t nPixels = 1;
+    for (int axis = 0; axis < naxis; ++axis) {
+         itsShape[axis] = axes[axis];
+         nPixels *= static_cast<size_t>(axes[axis]);
+    }
+    itsDataOffset = static_cast<size_t>(dataStart);
+
+    const int fd = open(fname.c_str(), O_RDONLY);
+    ASKAPCHECK(fd >= 0, "Unable to open FITS image " << fname << ": " << strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        ASKAPTHROW(AskapError, "Unable to obtain the size of FITS image " << fname);
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    if (itsDataOffset + nPixels * (std::abs(itsBitpix) / 8) > size) {
+        close(fd);
+        ASKAPLOG_WARN_STR(logger, "FITS image " << fname << " is truncated, it is not mapped");
+        return;
+    }
+    void *addr = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    ASKAPCHECK(addr != MAP_FAILED, "Unable to map FITS image " << fname << ": " << strerror(errno));
+    itsAddr = addr;
+    itsSize = size;
+}
+
+/// @brief destructor, unmaps the file
+FitsMappedImage::~FitsMappedImage()
+{
+    if (itsAddr != nullptr) {
+        munmap(itsAddr, itsSize);
+    }
+}
+
+/// @brief read part of the image into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @param[out] buffer array to fill with pixels for the selection
+void FitsMappedImage::read(const casacore::IPosition &blc, const casacore::IPosition &trc,
+                           casacore::Array<float> &buffer) const
+{
+    ASKAPCHECK(isMapped(), "FITS image " << itsFileName << " is not mapped");
+    const casacore::uInt ndim = itsShape.nelements();
+    ASKAPCHECK((blc.nelements() == ndim) && (trc.nelements() == ndim), "Selection from " << blc << " to " <<
+               trc << " doesn't match the dimensions of the image " << itsFileName << " with the shape " << itsShape);
+    casacore::IPosition shape(ndim);
+    for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+         ASKAPCHECK((blc[axis] >= 0) && (trc[axis] >= blc[axis]) && (trc[axis] < itsShape[axis]),
+                    "Selection from " << blc << " to " << trc << " is outside the image " << itsFileName <<
+                    " with the shape " << itsShape);
+         shape[axis] = trc[axis] - blc[axis] + 1;
+    }
+    if (!buffer.shape().isEqual(shape)) {
+        buffer.resize(shape);
+    }
+    bool deleteIt = false;
+    float *data = buffer.getStorage(deleteIt);
+
+    // element strides along each axis of the file
+    casacore::IPosition stride(ndim, 1);
+    for (casacore::uInt axis = 1; axis < ndim; ++axis) {
+         stride[axis] = stride[axis - 1] * itsShape[axis - 1];
+    }
+    const size_t bytesPerPixel = std::abs(itsBitpix) / 8;
+    const char *start = static_cast<const char*>(itsAddr) + itsDataOffset;
+    const size_t rowLength = shape[0];
+    const size_t nRows = shape.product() / rowLength;
+    // iterate over the rows along the first axis, each is contiguous in the file
+    casacore::IPosition pos(blc);
+    for (size_t row = 0; row < nRows; ++row) {
+         size_t offset = 0;
+         for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+              offset += pos[axis] * stride[axis];
+         }
+         const char *src = start + offset * bytesPerPixel;
+         FitsPixelConversion::decode(src, rowLength, itsBitpix, itsBScale, itsBZero, itsHasBlank, itsBlank,
+                                     data + row * rowLength);
+         for (casacore::uInt axis = 1; axis < ndim; ++axis) {
+              if (++pos[axis] <= trc[axis]) {
+                  break;
+              }
+              pos[axis] = blc[axis];
+         }
+    }
+    buffer.putStorage(data, deleteIt);
+}
+
+/// @brief obtain a view of the whole plane without copying
+/// @details This is only possible if the pixels are stored in the host format, i.e.
+/// for BITPIX = -32 on big-endian hosts. The view references the read-only map,
+/// it must not be modified and must not outlive this object.
+/// @param[in] plane index of the plane (first two axes) in the flattened remaining axes
+/// @param[out] view array referencing the plane, unchanged if false is returned
+/// @return true, if the view has been set up
+bool FitsMappedImage::planeView(casacore::uInt plane, casacore::Array<float> &view) const
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    if (!isMapped() || (itsBitpix != -32) || (itsBScale != 1.) || (itsBZero != 0.)) {
+        return false;
+    }
+    casacore::IPosition planeShape(itsShape);
+    for (casacore::uInt axis = 2; axis < planeShape.nelements(); ++axis) {
+         planeShape[axis] = 1;
+    }
+    const size_t planeSize = planeShape.product();
+    ASKAPCHECK(plane < itsShape.product() / planeSize, "Plane " << plane << " is outside the image " <<
+               itsFileName << " with the shape " << itsShape);
+    const char *src = static_cast<const char*>(itsAddr) + itsDataOffset + plane * planeSize * sizeof(float);
+    if (reinterpret_cast<uintptr_t>(src) % sizeof(float) != 0) {
+        return false;
+    }
+    view.takeStorage(planeShape, const_cast<float*>(reinterpret_cast<const float*>(src)), casacore::SHARE);
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,136 @@
+/// @file FitsMappedImage.h
+/// @brief Read uncompressed FITS images through a memory map
+/// @details casacore::FITSImage and cfitsio copy the data through their own buffers.
+/// For uncompressed floating point images the pixels are stored as a plain big-endian
+/// array following the header, so they can be gathered straight from the mapped file.
+/// Extracting small cutouts from a large image this way is bounded by page faults.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_FITS_MAPPED_IMAGE_H
+#define ASKAP_ACCESSORS_FITS_MAPPED_IMAGE_H
+
+#include <askap/imageaccess/FITSImageRW.h>
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Read uncompressed FITS images through a memory map
+/// @details The header is decoded once (through cfitsio) and the whole file is mapped
+/// read-only. Only images with the data in the primary HDU and BITPIX of -32, -64, 16 or 32
+/// can be mapped, see isMapped. The pixels are converted to the host byte order (and scaled
+/// with BSCALE/BZERO, blanks become NaN) as they are gathered, see FitsPixelConversion, so
+/// the mapped pages are shared with the page cache and other processes reading the same file.
+///
+/// The map reflects the file at construction, the stamp can be used to check whether the
+/// file has been modified or replaced since.
+/// @ingroup imageaccess
+class FitsMappedImage : public boost::noncopyable {
+public:
+    /// @brief map the given file
+    /// @details An exception is thrown if the file can't be opened or its header can't be
+    /// read. Files with unsupported layout are not mapped, isMapped returns false for them.
+    /// @param[in] fname file name (including the extension)
+    explicit FitsMappedImage(const std::string &fname);
+
+    /// @brief destructor, unmaps the file
+    ~FitsMappedImage();
+
+    /// @return true, if the file has been mapped and can be read with this class
+    inline bool isMapped() const { return itsAddr != nullptr; }
+
+    /// @return name of the mapped file
+    inline const std::string& fileName() const { return itsFileName; }
+
+    /// @return stamp of the file taken when it has been mapped
+    inline const FitsFileStamp& stamp() const { return itsStamp; }
+
+    /// @return shape of the image
+    inline const casacore::IPosition& shape() const { return itsShape; }
+
+    /// @brief read part of the image into the given buffer
+    /// @details The buffer is only resized if its shape doesn't match the selection.
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @param[out] buffer array to fill with pixels for the selection
+    void read(const casacore::IPosition &blc, const casacore::IPosition &trc,
+              casacore::Array<float> &buffer) const;
+
+    /// @brief obtain a view of the whole plane without copying
+    /// @details This is only possible if the pixels are stored in the host format, i.e.
+    /// for unscaled BITPIX = -32 images on big-endian hosts. The view references the read-only map,
+    /// it must not be modified and must not outlive this object.
+    /// @param[in] plane index of the plane (first two axes) in the flattened remaining axes
+    /// @param[out] view array referencing the plane, unchanged if false is returned
+    /// @return true, if the view has been set up
+    bool planeView(casacore::uInt plane, casacore::Array<float> &view) const;
+
+private:
+    /// @brief name of the mapped file
+    std::string itsFileName;
+
+    /// @brief stamp of the file when it has been mapped
+    FitsFileStamp itsStamp;
+
+    /// @brief start of the mapped memory, nullptr if not mapped
+    void *itsAddr;
+
+    /// @brief size of the mapped memory
+    size_t itsSize;
+
+    /// @brief offset of the first pixel in bytes
+    size_t itsDataOffset;
+
+    /// @brief value of BITPIX
+    int itsBitpix;
+
+    /// @brief value of BSCALE
+    double itsBScale;
+
+    /// @brief value of BZERO
+    double itsBZero;
+
+    /// @brief true, if BLANK is defined
+    bool itsHasBlank;
+
+    /// @brief value of BLANK
+    long itsBlank;
+
+    /// @brief shape of the image
+    casacore::IPosition itsShape;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_FITS_MAPPED_IMAGE_H
@@ -0,0 +1,455 @@
+/// @file FitsPixelConversion.cc
+/// @brief Conversion of pixels between FITS and host representation
+/// @details Byte swap kernels with run time dispatch and the conversion of
+/// scaled pixels.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/askap/AskapError.h>
+#include <askap/imageaccess/FitsPixelConversion.h>
+
+#include <casacore/casa/BasicMath/Math.h>
+
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdint.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ASKAP_FITS_SWAP_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ASKAP_FITS_SWAP_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief number of pixels converted in one go when a temporary buffer is needed
+const size_t theBlockSize = 4096;
+
+/// @brief swap bytes with plain loops
+/// @param[in] src input values
+/// @param[out] dst output values
+/// @param[in] n number of values
+/// @param[in] width size of a value in bytes
+void swapScalar(const char *src, char *dst, size_t n, size_t width)
+{
+    switch (width) {
+        case 2:
+            for (size_t i = 0; i < n; ++i) {
+                 uint16_t value;
+                 memcpy(&value, src + 2 * i, 2);
+                 value = __builtin_bswap16(value);
+                 memcpy(dst + 2 * i, &value, 2);
+            }
+            break;
+        case 4:
+            for (size_t i = 0; i < n; ++i) {
+                 uint32_t value;
+                 memcpy(&value, src + 4 * i, 4);
+                 value = __builtin_bswap32(value);
+                 memcpy(dst + 4 * i, &value, 4);
+            }
+            break;
+        default:
+            for (size_t i = 0; i < n; ++i) {
+                 uint64_t value;
+                 memcpy(&value, src + 8 * i, 8);
+                 value = __builtin_bswap64(value);
+                 memcpy(dst + 8 * i, &value, 8);
+            }
+    }
+}
+
+#ifdef ASKAP_FITS_SWAP_AVX2
+/// @brief swap bytes with AVX2 instructions
+/// @details 32 bytes are shuffled at a time, the remainder is done by the scalar loop
+/// @param[in] src input values
+/// @param[out] dst output values
+/// @param[in] n number of values
+/// @param[in] width size of a value in bytes
+__attribute__((target("avx2")))
+void swapAVX2(const char *src, char *dst, size_t n, size_t width)
+{
+    const __m256i mask16 = _mm256_setr_epi8(1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14,
+                                            1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14);
+    const __m256i mask32 = _mm256_setr_epi8(3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12,
+                                            3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12);
+    const __m256i mask64 = _mm256_setr_epi8(7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8,
+                                            7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+    const __m256i mask = width == 2 ? mask16 : (width == 4 ? mask32 : mask64);
+    const size_t nBytes = n * width;
+    size_t offset = 0;
+    for (; offset + 32 <= nBytes; offset += 32) {
+         const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + offset));
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + offset), _mm256_shuffle_epi8(value, mask));
+    }
+    swapScalar(src + offset, dst + offset, (nBytes - offset) / width, width);
+}
+#endif // #ifdef ASKAP_FITS_SWAP_AVX2
+
+#ifdef ASKAP_FITS_SWAP_NEON
+/// @brief swap bytes with NEON instructions
+/// @details 16 bytes are reversed at a time, the remainder is done by the scalar loop
+/// @param[in] src input values
+/// @param[out] dst output values
+/// @param[in] n number of values
+/// @param[in] width size of a value in bytes
+void swapNEON(const char *src, char *dst, size_t n, size_t width)
+{
+    const size_t nBytes = n * width;
+    size_t offset = 0;
+    for (; offset + 16 <= nBytes; offset += 16) {
+         const uint8x16_t value = vld1q_u8(reinterpret_cast<const uint8_t*>(src + offset));
+         const uint8x16_t swapped = width == 2 ? vrev16q_u8(value) : (width == 4 ? vrev32q_u8(value) :
+                                    vrev64q_u8(value));
+         vst1q_u8(reinterpret_cast<uint8_t*>(dst + offset), swapped);
+    }
+    swapScalar(src + offset, dst + offset, (nBytes - offset) / width, width);
+}
+#endif // #ifdef ASKAP_FITS_SWAP_NEON
+
+/// @brief type of the byte swap kernel
+typedef void (*SwapKernel)(const char *, char *, size_t, size_t);
+
+/// @brief select the best byte swap kernel for this host
+/// @return pointer to the kernel
+SwapKernel selectKernel()
+{
+#ifdef ASKAP_FITS_SWAP_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return swapAVX2;
+    }
+#endif
+#ifdef ASKAP_FITS_SWAP_NEON
+    return swapNEON;
+#else
+    return swapScalar;
+#endif
+}
+
+/// @brief byte swap kernel used on this host
+const SwapKernel theSwapKernel = selectKernel();
+
+/// @brief convert integer pixels from the file representation
+/// @param[in] raw pixels in the file (big-endian)
+/// @param[in] n number of pixels
+/// @param[in] bscale BSCALE
+/// @param[in] bzero BZERO
+/// @param[in] hasBlank true if BLANK is defined
+/// @param[in] blank BLANK
+/// @param[out] out converted pixels, blanks are set to NaN
+template<typename T>
+void decodeIntegers(const char *raw, size_t n, double bscale, double bzero, bool hasBlank, long blank, float *out)
+{
+    T local[theBlockSize];
+    // out of range BLANK can't match any pixel
+    const bool checkBlank = hasBlank && (blank >= std::numeric_limits<T>::min()) &&
+                            (blank <= std::numeric_limits<T>::max());
+    const T blankValue = checkBlank ? static_cast<T>(blank) : 0;
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (size_t start = 0; start < n; start += theBlockSize) {
+         const size_t count = std::min(theBlockSize, n - start);
+         FitsPixelConversion::swapBytes(raw + start * sizeof(T), local, count, sizeof(T));
+         float *dst = out + start;
+         if (checkBlank) {
+             for (size_t i = 0; i < count; ++i) {
+                  const float value = static_cast<float>(bzero + bscale * local[i]);
+                  dst[i] = local[i] == blankValue ? nan : value;
+             }
+         } else {
+             for (size_t i = 0; i < count; ++i) {
+                  dst[i] = static_cast<float>(bzero + bscale * local[i]);
+             }
+         }
+    }
+}
+
+/// @brief quantise pixels into integers in the host byte order
+/// @param[in] in pixels
+/// @param[in] n number of pixels
+/// @param[in] bscale BSCALE
+/// @param[in] bzero BZERO
+/// @param[in] hasBlank true if BLANK is defined
+/// @param[in] blank BLANK
+/// @param[out] out integers
+template<typename T>
+void quantiseIntegers(const float *in, size_t n, double bscale, double bzero, bool hasBlank, long blank, T *out)
+{
+    const double minValue = std::numeric_limits<T>::min();
+    const double maxValue = std::numeric_limits<T>::max();
+    for (size_t i = 0; i < n; ++i) {
+         if (casacore::isNaN(in[i])) {
+             ASKAPCHECK(hasBlank, "Unable to write NaN into an integer FITS image without BLANK keyword");
+             out[i] = static_cast<T>(blank);
+         } else {
+             const double rounded = std::round((in[i] - bzero) / bscale);
+             out[i] = static_cast<T>(std::min(std::max(rounded, minValue), maxValue));
+         }
+    }
+}
+
+/// @brief convert pixels to integers in the file representation
+/// @param[in] in pixels
+/// @param[in] n number of pixels
+/// @param[in] bscale BSCALE
+/// @param[in] bzero BZERO
+/// @param[in] hasBlank true if BLANK is defined
+/// @param[in] blank BLANK
+/// @param[out] raw pixels in the file representation (big-endian)
+template<typename T>
+void encodeIntegers(const float *in, size_t n, double bscale, double bzero, bool hasBlank, long blank, char *raw)
+{
+    T local[theBlockSize];
+    for (size_t start = 0; start < n; start += theBlockSize) {
+         const size_t count = std::min(theBlockSize, n - start);
+         quantiseIntegers<T>(in + start, count, bscale, bzero, hasBlank, blank, local);
+         FitsPixelConversion::swapBytes(local, raw + start * sizeof(T), count, sizeof(T));
+    }
+}
+
+} // anonymous namespace
+
+/// @brief convert pixels from the file representation
+/// @param[in] raw pixels in the file (big-endian)
+/// @param[in] n number of pixels
+/// @param[in] bitpix BITPIX of the image (-32, -64, 16 or 32)
+/// @param[in] bscale BSCALE
+/// @param[in] bzero BZERO
+/// @param[in] hasBlank true if BLANK is defined (integer data only)
+/// @param[in] blank BLANK
+/// @param[out] out converted pixels, blanks are set to NaN
+void FitsPixelConversion::decode(const char *raw, size_t n, int bitpix, double bscale, double bzero,
+                                 bool hasBlank, long blank, float *out)
+{
+    const bool scaled = (bscale != 1.) || (bzero != 0.);
+    switch (bitpix) {
+        case -32:
+            swapBytes(raw, out, n, sizeof(float));
+            if (scaled) {
+                for (size_t i = 0; i < n; ++i) {
+                     out[i] = static_cast<float>(bzero + bscale * out[i]);
+                }
+            }
+            break;
+        case -64: {
+            double local[theBlockSize];
+            for (size_t start = 0; start < n; start += theBlockSize) {
+                 const size_t count = std::min(theBlockSize, n - start);
+                 swapBytes(raw + start * sizeof(double), local, count, sizeof(double));
+                 float *dst = out + start;
+                 for (size_t i = 0; i < count; ++i) {
+                      dst[i] = static_cast<float>(bzero + bscale * local[i]);
+                 }
+            }
+            break;
+        }
+        case 16:
+            decodeIntegers<int16_t>(raw, n, bscale, bzero, hasBlank, blank, out);
+            break;
+        case 32:
+            decodeIntegers<int32_t>(raw, n, bscale, bzero, hasBlank, blank, out);
+            break;
+        default:
+            ASKAPTHROW(AskapError, "Conversion of pixels with BITPIX=" << bitpix << " is not supported");
+    }
+}
+
+/// @brief convert pixels to the file representation
+/// @details Integer values are rounded and clipped to the range of the type.
+/// NaNs are written as BLANK, an exception is thrown if BLANK is not defined.
+/// @param[in] in pixels
+/// @param[in] n number of pixels
+/// @param[in] bitpix BITPIX of the image (-32, -64, 16 or 32)
+/// @param[in] bscale BSCALE
+/// @param[in] bzero BZERO
+/// @param[in] hasBlank true if BLANK is defined (integer data only)
+/// @param[in] blank BLANK
+/// @param[out] raw pixels in the file representation (big-endian)
+void FitsPixelConversion::encode(const float *in, size_t n, int bitpix, double bscale, double bzero,
+                                 bool hasBlank, long blank, char *raw)
+{
+    const bool scaled = (bscale != 1.) || (bzero != 0.);
+    switch (bitpix) {
+        case -32:
+            if (!scaled) {
+                swapBytes(in, raw, n, sizeof(float));
+            } else {
+                float local[theBlockSize];
+                for (size_t start = 0; start < n; start += theBlockSize) {
+                     const size_t count = std::min(theBlockSize, n - start);
+                     for (size_t i = 0; i < count; ++i) {
+                          local[i] = static_cast<float>((in[start + i] - bzero) / bscale);
+                     }
+                     swapBytes(local, raw + start * sizeof(float), count, sizeof(float));
+                }
+            }
+            break;
+        case -64: {
+            double local[theBlockSize];
+            for (size_t start = 0; start < n; start += theBlockSize) {
+                 const size_t count = std::min(theBlockSize, n - start);
+                 for (size_t i = 0; i < count; ++i) {
+                      local[i] = (in[start + i] - bzero) / bscale;
+                 }
+                 swapBytes(local, raw + start * sizeof(double), count, sizeof(double));
+            }
+            break;
+        }
+        case 16:
+            encodeIntegers<int16_t>(in, n, bscale, bzero, hasBlank, blank, raw);
+            break;
+        case 32:
+            encodeIntegers<int32_t>(in, n, bscale, bzero, hasBlank, blank, raw);
+            break;
+        default:
+            ASKAPTHROW(AskapError, "Conversion of pixels with BITPIX=" << bitpix << " is not supported");
+    }
+}
+
+/// @brief quantise pixels into integers in the host byte order
+/// @details Values are rounded and clipped to the range of the type. NaNs are written
+/// as BLANK, an exception is thrown if BLANK is not defined.
+/// @param[in] in pixels
+/// @param[in] n number of pixels
+/// @param[in] bitpix BITPIX of the image (16 or 32)
+/// @param[in] bscale BSCALE
+/// @param[in] bzero BZERO
+/// @param[in] hasBlank true if BLANK is defined
+/// @param[in] blank BLANK
+/// @param[out] out integers (int16_t or int32_t depending on bitpix)
+void FitsPixelConversion::quantise(const float *in, size_t n, int bitpix, double bscale, double bzero,
+                                   bool hasBlank, long blank, void *out)
+{
+    switch (bitpix) {
+        case 16:
+            quantiseIntegers(in, n, bscale, bzero, hasBlank, blank, static_cast<int16_t*>(out));
+            break;
+        case 32:
+            quantiseIntegers(in, n, bscale, bzero, hasBlank, blank, static_cast<int32_t*>(out));
+            break;
+        default:
+            ASKAPTHROW(AskapError, "Quantisation into BITPIX=" << bitpix << " is not supported");
+    }
+}
+
+/// @brief find the range of finite pixel values
+/// @param[in] in pixels
+/// @param[in] n number of pixels
+/// @param[out] minPix minimum value
+/// @param[out] maxPix maximum value
+/// @return false, if there are no finite pixels (the range is left unchanged)
+bool FitsPixelConversion::dataRange(const float *in, size_t n, float &minPix, float &maxPix)
+{
+    float minValue = std::numeric_limits<float>::max();
+    float maxValue = -std::numeric_limits<float>::max();
+    for (size_t i = 0; i < n; ++i) {
+         // comparisons with NaN are false, so NaNs are skipped
+         minValue = in[i] < minValue ? in[i] : minValue;
+         maxValue = in[i] > maxValue ? in[i] : maxValue;
+    }
+    if (minValue > maxValue) {
+        return false;
+    }
+    minPix = minValue;
+    maxPix = maxValue;
+    return true;
+}
+
+/// @brief scaling mapping the given range onto the integer type
+/// @details The lowest value of the type is reserved for BLANK (see blankValue), the rest
+/// of the range is used for the pixels from minPix to maxPix.
+/// @param[in] bitpix BITPIX of the image (16 or 32)
+/// @param[in] minPix minimum pixel value
+/// @param[in] maxPix maximum pixel value
+/// @param[out] bscale BSCALE
+/// @param[out] bzero BZERO
+void FitsPixelConversion::scaling(int bitpix, float minPix, float maxPix, double &bscale, double &bzero)
+{
+    ASKAPCHECK((bitpix == 16) || (bitpix == 32), "Scaling for BITPIX=" << bitpix << " is not supported");
+    ASKAPCHECK(minPix <= maxPix, "Invalid range of pixel values from " << minPix << " to " << maxPix);
+    // valid integers are from -maxInt to maxInt
+    const double maxInt = bitpix == 16 ? std::numeric_limits<int16_t>::max() : std::numeric_limits<int32_t>::max();
+    const double range = static_cast<double>(maxPix) - static_cast<double>(minPix);
+    bscale = range > 0. ? range / (2. * maxInt) : 1.;
+    bzero = static_cast<double>(minPix) + maxInt * bscale;
+}
+
+/// @param[in] bitpix BITPIX of the image (16 or 32)
+/// @return value of BLANK used for integer images
+long FitsPixelConversion::blankValue(int bitpix)
+{
+    ASKAPCHECK((bitpix == 16) || (bitpix == 32), "BLANK is only defined for integer images, BITPIX=" << bitpix);
+    return bitpix == 16 ? std::numeric_limits<int16_t>::min() : std::numeric_limits<int32_t>::min();
+}
+
+/// @brief convert between big-endian and host byte order
+/// @details The buffers may be the same, but shouldn't overlap otherwise.
+/// @param[in] src input values
+/// @param[out] dst output values
+/// @param[in] n number of values
+/// @param[in] width size of a value in bytes (2, 4 or 8)
+void FitsPixelConversion::swapBytes(const void *src, void *dst, size_t n, size_t width)
+{
+    ASKAPDEBUGASSERT((width == 2) || (width == 4) || (width == 8));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    if (src != dst) {
+        memcpy(dst, src, n * width);
+    }
+#else
+    theSwapKernel(static_cast<const char*>(src), static_cast<char*>(dst), n, width);
+#endif
+}
+
+/// @return name of the byte swap kernel used on this host (avx2, neon, scalar or none
+/// for big-endian hosts)
+std::string FitsPixelConversion::kernel()
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return "none";
+#else
+#ifdef ASKAP_FITS_SWAP_AVX2
+    if (theSwapKernel == swapAVX2) {
+        return "avx2";
+    }
+#endif
+#ifdef ASKAP_FITS_SWAP_NEON
+    if (theSwapKernel == swapNEON) {
+        return "neon";
+    }
+#endif
+    return "scalar";
+#endif
+}
@@ -0,0 +1,127 @@
+/// @file FitsPixelConversion.h
+/// @brief Conversion of pixels between FITS and host representation
+/// @details FITS data are big-endian. The image accessors which bypass cfitsio
+/// (memory-mapped and MPI-IO paths) have to swap the bytes and apply BSCALE/BZERO
+/// themselves. This class provides vectorised kernels for this.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_FITS_PIXEL_CONVERSION_H
+#define ASKAP_ACCESSORS_FITS_PIXEL_CONVERSION_H
+
+#include <cstddef>
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Conversion of pixels between FITS and host representation
+/// @details The byte swap is done by the best kernel available on the host, selected at
+/// run time: AVX2 on x86 processors supporting it, NEON on ARM, plain loops otherwise.
+/// The conversion of scaled integer pixels is done in blocks, so no temporary buffer of
+/// the full size is allocated. All methods work with unaligned buffers.
+/// @ingroup imageaccess
+struct FitsPixelConversion {
+
+    /// @brief convert pixels from the file representation
+    /// @param[in] raw pixels in the file (big-endian)
+    /// @param[in] n number of pixels
+    /// @param[in] bitpix BITPIX of the image (-32, -64, 16 or 32)
+    /// @param[in] bscale BSCALE
+    /// @param[in] bzero BZERO
+    /// @param[in] hasBlank true if BLANK is defined (integer data only)
+    /// @param[in] blank BLANK
+    /// @param[out] out converted pixels, blanks are set to NaN
+    static void decode(const char *raw, size_t n, int bitpix, double bscale, double bzero,
+                       bool hasBlank, long blank, float *out);
+
+    /// @brief convert pixels to the file representation
+    /// @details Integer values are rounded and clipped to the range of the type.
+    /// NaNs are written as BLANK, an exception is thrown if BLANK is not defined.
+    /// @param[in] in pixels
+    /// @param[in] n number of pixels
+    /// @param[in] bitpix BITPIX of the image (-32, -64, 16 or 32)
+    /// @param[in] bscale BSCALE
+    /// @param[in] bzero BZERO
+    /// @param[in] hasBlank true if BLANK is defined (integer data only)
+    /// @param[in] blank BLANK
+    /// @param[out] raw pixels in the file representation (big-endian)
+    static void encode(const float *in, size_t n, int bitpix, double bscale, double bzero,
+                       bool hasBlank, long blank, char *raw);
+
+    /// @brief quantise pixels into integers in the host byte order
+    /// @details Values are rounded and clipped to the range of the type. NaNs are written
+    /// as BLANK, an exception is thrown if BLANK is not defined.
+    /// @param[in] in pixels
+    /// @param[in] n number of pixels
+    /// @param[in] bitpix BITPIX of the image (16 or 32)
+    /// @param[in] bscale BSCALE
+    /// @param[in] bzero BZERO
+    /// @param[in] hasBlank true if BLANK is defined
+    /// @param[in] blank BLANK
+    /// @param[out] out integers (int16_t or int32_t depending on bitpix)
+    static void quantise(const float *in, size_t n, int bitpix, double bscale, double bzero,
+                         bool hasBlank, long blank, void *out);
+
+    /// @brief find the range of finite pixel values
+    /// @param[in] in pixels
+    /// @param[in] n number of pixels
+    /// @param[out] minPix minimum value
+    /// @param[out] maxPix maximum value
+    /// @return false, if there are no finite pixels (the range is left unchanged)
+    static bool dataRange(const float *in, size_t n, float &minPix, float &maxPix);
+
+    /// @brief scaling mapping the given range onto the integer type
+    /// @details The lowest value of the type is reserved for BLANK (see blankValue), the rest
+    /// of the range is used for the pixels from minPix to maxPix.
+    /// @param[in] bitpix BITPIX of the image (16 or 32)
+    /// @param[in] minPix minimum pixel value
+    /// @param[in] maxPix maximum pixel value
+    /// @param[out] bscale BSCALE
+    /// @param[out] bzero BZERO
+    static void scaling(int bitpix, float minPix, float maxPix, double &bscale, double &bzero);
+
+    /// @param[in] bitpix BITPIX of the image (16 or 32)
+    /// @return value of BLANK used for integer images
+    static long blankValue(int bitpix);
+
+    /// @brief convert between big-endian and host byte order
+    /// @details The buffers may be the same, but shouldn't overlap otherwise.
+    /// @param[in] src input values
+    /// @param[out] dst output values
+    /// @param[in] n number of values
+    /// @param[in] width size of a value in bytes (2, 4 or 8)
+    static void swapBytes(const void *src, void *dst, size_t n, size_t width);
+
+    /// @return name of the byte swap kernel used on this host (avx2, neon, scalar or none
+    /// for big-endian hosts)
+    static std::string kernel();
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_FITS_PIXEL_CONVERSION_H
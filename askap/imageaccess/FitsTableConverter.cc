@@ -0,0 +1,591 @@
+/// @file FitsTableConverter.cc
+/// @brief Direct conversion of FITS binary tables to VOTable
+/// @details The rows are read in chunks of the number of rows cfitsio can buffer and each
+/// row is formatted into a reused VOTableRow passed to the writer.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+
+#include <askap/imageaccess/FitsTableConverter.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/votable/VOTableInfo.h>
+#include <askap/votable/VOTableResource.h>
+#include <askap/votable/VOTableRow.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+ASKAP_LOGGER(logger, ".FitsTableConverter");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief throw an exception if cfitsio reported an error
+/// @param[in] status cfitsio status
+/// @param[in] what description of the operation which failed
+void checkStatus(int status, const std::string &what)
+{
+    if (status) {
+        char text[FLEN_STATUS];
+        fits_get_errstatus(status, text);
+        fits_clear_errmsg();
+        ASKAPTHROW(AskapError, what << ": cfitsio error " << status << " (" << text << ")");
+    }
+}
+
+/// @brief read an optional keyword
+/// @param[in] fptr FITS file pointer positioned at the table
+/// @param[in] datatype cfitsio data type of the value
+/// @param[in] keyword keyword name
+/// @param[out] value keyword value, unchanged if the keyword is absent
+/// @return true if the keyword is present
+bool readOptionalKey(fitsfile *fptr, int datatype, const std::string &keyword, void *value)
+{
+    int status = 0;
+    if (fits_read_key(fptr, datatype, keyword.c_str(), value, nullptr, &status) == KEY_NO_EXIST) {
+        fits_clear_errmsg();
+        return false;
+    }
+    checkStatus(status, "Failed to read keyword " + keyword);
+    return true;
+}
+
+/// @brief check whether the keyword describes the table structure
+/// @param[in] keyword keyword name
+/// @return true for the keywords implied by the fields of the VOTable
+bool isStructuralKeyword(const std::string &keyword)
+{
+    if (keyword.empty() || keyword == "XTENSION" || keyword == "BITPIX" || keyword == "PCOUNT" ||
+        keyword == "GCOUNT" || keyword == "TFIELDS" || keyword == "EXTNAME" || keyword == "END" ||
+        boost::starts_with(keyword, "NAXIS")) {
+        return true;
+    }
+    const char* prefixes[] = {"TTYPE", "TFORM", "TUNIT", "TNULL", "TSCAL", "TZERO", "TDIM"};
+    for (const char* prefix : prefixes) {
+         const std::string str(prefix);
+         if (boost::starts_with(keyword, str) && keyword.size() > str.size() &&
+             std::all_of(keyword.begin() + str.size(), keyword.end(),
+                         [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; })) {
+             return true;
+         }
+    }
+    return false;
+}
+
+/// @brief remove the quotes from a string keyword value
+/// @param[in] value keyword value as it appears in the card
+/// @return the value with the quotes removed, other values are returned as they are
+std::string unquote(const std::string &value)
+{
+    if (value.empty() || value[0] != '\'') {
+        return value;
+    }
+    std::string result;
+    for (size_t pos = 1; pos < value.size(); ++pos) {
+         if (value[pos] == '\'') {
+             if (pos + 1 < value.size() && value[pos + 1] == '\'') {
+                 // escaped quote
+                 ++pos;
+             } else {
+                 break;
+             }
+         }
+         result.push_back(value[pos]);
+    }
+    // trailing spaces are not significant in FITS strings
+    const size_t last = result.find_last_not_of(' ');
+    result.erase(last == std::string::npos ? 0 : last + 1);
+    return result;
+}
+
+/// @brief append a real value in the shortest form which reads back exactly
+/// @param[in] value value to append
+/// @param[in] singlePrecision true if the value has to be exact for float only
+/// @param[in,out] out string to append to
+void appendReal(double value, bool singlePrecision, std::string &out)
+{
+    if (std::isnan(value)) {
+        out += "NaN";
+        return;
+    }
+    if (std::isinf(value)) {
+        out += value > 0 ? "+Inf" : "-Inf";
+        return;
+    }
+    char buf[32];
+    const int maxDigits = singlePrecision ? 9 : 17;
+    for (int digits = singlePrecision ? 7 : 15; digits <= maxDigits; ++digits) {
+         std::snprintf(buf, sizeof(buf), "%.*g", digits, value);
+         const bool exact = singlePrecision ? std::strtof(buf, nullptr) == static_cast<float>(value) :
+                            std::strtod(buf, nullptr) == value;
+         if (exact) {
+             break;
+         }
+    }
+    out += buf;
+}
+
+/// @brief reading buffers and conversion details of one column
+struct ColumnReader {
+    /// @brief kind of the buffer used
+    enum Kind {
+        INTEGER,
+        REAL,
+        LOGICAL,
+        STRING
+    };
+
+    /// @brief column number (1-based)
+    int itsNumber;
+
+    /// @brief kind of the buffer used
+    Kind itsKind;
+
+    /// @brief cfitsio data type used for reading
+    int itsType;
+
+    /// @brief number of values per cell (two per complex element)
+    long itsCount;
+
+    /// @brief true if the values should be exact in single precision only
+    bool itsSinglePrecision;
+
+    /// @brief true if the integer column has TNULL defined
+    bool itsHasNull;
+
+    /// @brief value of the undefined integers (after TZERO is applied)
+    long long itsNull;
+
+    /// @brief integer values of the chunk
+    std::vector<long long> itsIntegers;
+
+    /// @brief real values of the chunk
+    std::vector<double> itsReals;
+
+    /// @brief logical values of the chunk (0, 1 or 2 for undefined)
+    std::vector<char> itsLogicals;
+
+    /// @brief storage of the strings of the chunk
+    std::vector<char> itsChars;
+
+    /// @brief pointers to each string of the chunk
+    std::vector<char*> itsStrings;
+
+    /// @brief string width
+    long itsWidth;
+
+    /// @brief set up the buffers for the given number of rows
+    /// @param[in] nRows rows per chunk
+    void allocate(long nRows)
+    {
+        const size_t size = static_cast<size_t>(nRows * itsCount);
+        if (itsKind == INTEGER) {
+            itsIntegers.resize(size);
+        } else if (itsKind == REAL) {
+            itsReals.resize(size);
+        } else if (itsKind == LOGICAL) {
+            itsLogicals.resize(size);
+        } else {
+            itsChars.assign(nRows * (itsWidth + 1), '\0');
+            itsStrings.resize(nRows);
+            for (long row = 0; row < nRows; ++row) {
+                 itsStrings[row] = itsChars.data() + row * (itsWidth + 1);
+            }
+        }
+    }
+
+    /// @brief read a chunk of rows
+    /// @details Undefined values are not substituted, they are recognised while formatting.
+    /// @param[in] fptr FITS file pointer positioned at the table
+    /// @param[in] firstRow first row of the chunk (0-based)
+    /// @param[in] nRows number of rows in the chunk
+    void read(fitsfile *fptr, long firstRow, long nRows)
+    {
+        int status = 0;
+        int anynull = 0;
+        // complex values are counted in pairs by cfitsio
+        const long nElements = nRows * (itsType == TDBLCOMPLEX ? itsCount / 2 : itsCount);
+        if (itsKind == INTEGER) {
+            fits_read_col(fptr, TLONGLONG, itsNumber, firstRow + 1, 1, nElements, nullptr,
+                          itsIntegers.data(), &anynull, &status);
+        } else if (itsKind == REAL) {
+            fits_read_col(fptr, itsType, itsNumber, firstRow + 1, 1, nElements, nullptr,
+                          itsReals.data(), &anynull, &status);
+        } else if (itsKind == LOGICAL) {
+            char nulval = 2;
+            fits_read_col(fptr, TLOGICAL, itsNumber, firstRow + 1, 1, nElements, &nulval,
+                          itsLogicals.data(), &anynull, &status);
+        } else {
+            char nulstr[] = "";
+            fits_read_col(fptr, TSTRING, itsNumber, firstRow + 1, 1, nRows, nulstr,
+                          itsStrings.data(), &anynull, &status);
+        }
+        checkStatus(status, "Failed to read column " + boost::lexical_cast<std::string>(itsNumber));
+    }
+
+    /// @brief format a cell of the chunk
+    /// @param[in] row row within the chunk
+    /// @param[out] cell text of the cell, empty for null
+    void format(long row, std::string &cell) const
+    {
+        cell.clear();
+        if (itsKind == STRING) {
+            cell = itsStrings[row];
+            return;
+        }
+        bool allNull = true;
+        const size_t first = static_cast<size_t>(row * itsCount);
+        for (size_t index = first; index < first + static_cast<size_t>(itsCount); ++index) {
+             if (index > first) {
+                 cell += ' ';
+             }
+             if (itsKind == INTEGER) {
+                 const long long value = itsIntegers[index];
+                 allNull = allNull && itsHasNull && value == itsNull;
+                 char buf[24];
+                 std::snprintf(buf, sizeof(buf), "%lld", value);
+                 cell += buf;
+             } else if (itsKind == REAL) {
+                 const double value = itsReals[index];
+                 allNull = allNull && std::isnan(value);
+                 appendReal(value, itsSinglePrecision, cell);
+             } else {
+                 const char value = itsLogicals[index];
+                 allNull = allNull && value == 2;
+                 cell += value == 1 ? 'T' : (value == 0 ? 'F' : '?');
+             }
+        }
+        if (allNull) {
+            cell.clear();
+        }
+    }
+};
+
+} // anonymous namespace
+
+/// @brief open the FITS file
+/// @param[in] name file name as given to FitsImageAccess (".fits" is appended unless present)
+FitsTableConverter::FitsTableConverter(const std::string &name) :
+    itsName(boost::ends_with(name, ".fits") ? name : name + ".fits"), itsFptr(nullptr)
+{
+    int status = 0;
+    fits_open_file(&itsFptr, itsName.c_str(), READONLY, &status);
+    checkStatus(status, "Unable to open " + itsName);
+}
+
+/// @brief close the FITS file
+FitsTableConverter::~FitsTableConverter()
+{
+    int status = 0;
+    fits_close_file(itsFptr, &status);
+    if (status) {
+        ASKAPLOG_WARN_STR(logger, "Failed to close " << itsName << ", cfitsio error " << status);
+        fits_clear_errmsg();
+    }
+}
+
+/// @brief names of the binary tables in the file
+/// @return EXTNAME of each binary table extension, in the order of the HDUs
+std::vector<std::string> FitsTableConverter::tableNames() const
+{
+    std::vector<std::string> result;
+    for (int hdu = firstTable(2); hdu > 0; hdu = firstTable(hdu + 1)) {
+         result.push_back(currentName());
+    }
+    return result;
+}
+
+/// @brief convert the binary table(s) into the given writer
+/// @details A RESOURCE is written for each table converted, the writer is not closed.
+/// @param[in] tblName EXTNAME of the table to convert or "All" for all binary tables
+/// @param[in] writer VOTable writer to append to
+/// @param[in] format serialisation of the rows
+/// @return number of rows written
+size_t FitsTableConverter::convert(const std::string &tblName, VOTableWriter &writer,
+                                   VOTableTable::DataFormat format) const
+{
+    size_t nRows = 0;
+    for (int hdu = firstTable(2); hdu > 0; hdu = firstTable(hdu + 1)) {
+         if (tblName == "All") {
+             nRows += convertCurrent(writer, format);
+         } else if (tblName == currentName()) {
+             return convertCurrent(writer, format);
+         }
+    }
+    ASKAPCHECK(tblName == "All", "There is no binary table " << tblName << " in " << itsName);
+    return nRows;
+}
+
+/// @brief convert the binary table(s) into a VOTable file
+/// @param[in] tblName EXTNAME of the table to convert or "All" for all binary tables
+/// @param[in] voName output file name (compressed if it ends with .gz or .zst)
+/// @param[in] format serialisation of the rows
+/// @return number of rows written
+size_t FitsTableConverter::convert(const std::string &tblName, const std::string &voName,
+                                   VOTableTable::DataFormat format) const
+{
+    VOTableWriter writer(voName, "Converted from " + itsName);
+    const size_t nRows = convert(tblName, writer, format);
+    writer.close();
+    ASKAPLOG_DEBUG_STR(logger, "Converted " << nRows << " row(s) of " << tblName << " from " << itsName <<
+                       " to " << voName);
+    return nRows;
+}
+
+/// @brief describe a FITS column as a VOTable field
+/// @param[in] name column name (TTYPE)
+/// @param[in] typecode cfitsio equivalent type of the column (see fits_get_eqcoltype)
+/// @param[in] repeat repeat count of the column
+/// @param[in] dims dimensions given by TDIM, if any (the first axis varies fastest)
+/// @param[in] unit column unit (TUNIT)
+/// @return field matching the column
+VOTableField FitsTableConverter::makeField(const std::string &name, int typecode, long repeat,
+                                           const std::vector<long> &dims, const std::string &unit)
+{
+    VOTableField field;
+    field.setName(name);
+    field.setUnit(unit);
+    switch (typecode) {
+        case TLOGICAL:
+            field.setDatatype("boolean");
+            break;
+        case TBYTE:
+            field.setDatatype("unsignedByte");
+            break;
+        case TSBYTE:
+        case TSHORT:
+            field.setDatatype("short");
+            break;
+        case TUSHORT:
+        case TINT:
+        case TLONG:
+            field.setDatatype("int");
+            break;
+        case TUINT:
+        case TULONG:
+        case TLONGLONG:
+            field.setDatatype("long");
+            break;
+        case TFLOAT:
+            field.setDatatype("float");
+            break;
+        case TDOUBLE:
+            field.setDatatype("double");
+            break;
+        case TCOMPLEX:
+            field.setDatatype("floatComplex");
+            break;
+        case TDBLCOMPLEX:
+            field.setDatatype("doubleComplex");
+            break;
+        case TSTRING:
+            field.setDatatype("char");
+            field.setArraysize("*");
+            return field;
+        default:
+            ASKAPTHROW(AskapError, "Column " << name << " has type " << typecode <<
+                       " which can't be converted to VOTable");
+    }
+    if (dims.size() > 1) {
+        std::string arraysize;
+        for (size_t dim = 0; dim < dims.size(); ++dim) {
+             arraysize += (dim > 0 ? "x" : "") + boost::lexical_cast<std::string>(dims[dim]);
+        }
+        field.setArraysize(arraysize);
+    } else if (repeat != 1) {
+        field.setArraysize(boost::lexical_cast<std::string>(repeat));
+    }
+    return field;
+}
+
+/// @brief move to the first binary table at or after the given HDU
+/// @param[in] hdu HDU number (1-based) to start from
+/// @return number of the HDU found or 0 if there are no more binary tables
+int FitsTableConverter::firstTable(int hdu) const
+{
+    int status = 0;
+    int nHDU = 0;
+    fits_get_num_hdus(itsFptr, &nHDU, &status);
+    checkStatus(status, "Failed to get the number of HDUs in " + itsName);
+    for (; hdu <= nHDU; ++hdu) {
+         int hduType = 0;
+         fits_movabs_hdu(itsFptr, hdu, &hduType, &status);
+         checkStatus(status, "Failed to move to HDU " + boost::lexical_cast<std::string>(hdu) + " of " + itsName);
+         if (hduType == BINARY_TBL) {
+             return hdu;
+         }
+    }
+    return 0;
+}
+
+/// @return EXTNAME of the current HDU (empty if not defined)
+std::string FitsTableConverter::currentName() const
+{
+    char extName[FLEN_VALUE] = "";
+    readOptionalKey(itsFptr, TSTRING, "EXTNAME", extName);
+    return extName;
+}
+
+/// @brief convert the table in the current HDU
+/// @param[in] writer VOTable writer to append to
+/// @param[in] format serialisation of the rows
+/// @return number of rows written
+size_t FitsTableConverter::convertCurrent(VOTableWriter &writer, VOTableTable::DataFormat format) const
+{
+    const std::string extName = currentName();
+    int status = 0;
+
+    // the keywords except those describing the columns
+    VOTableResource resource;
+    resource.setName(extName);
+    int nKeys = 0;
+    int nMore = 0;
+    fits_get_hdrspace(itsFptr, &nKeys, &nMore, &status);
+    checkStatus(status, "Failed to read the header of " + extName);
+    for (int key = 1; key <= nKeys; ++key) {
+         char keyword[FLEN_KEYWORD];
+         char value[FLEN_VALUE];
+         char comment[FLEN_COMMENT];
+         fits_read_keyn(itsFptr, key, keyword, value, comment, &status);
+         checkStatus(status, "Failed to read the header of " + extName);
+         if (!isStructuralKeyword(keyword)) {
+             VOTableInfo info;
+             info.setName(keyword);
+             info.setValue(unquote(value));
+             info.setText(comment);
+             resource.addInfo(std::move(info));
+         }
+    }
+
+    // fields and readers of the columns
+    VOTableTable table;
+    table.setName(extName);
+    table.setDataFormat(format);
+    int nColumns = 0;
+    long nRows = 0;
+    fits_get_num_cols(itsFptr, &nColumns, &status);
+    fits_get_num_rows(itsFptr, &nRows, &status);
+    checkStatus(status, "Failed to get the size of " + extName);
+    std::vector<ColumnReader> columns(nColumns);
+    for (int col = 0; col < nColumns; ++col) {
+         const std::string number = boost::lexical_cast<std::string>(col + 1);
+         char ttype[FLEN_VALUE] = "";
+         char tunit[FLEN_VALUE] = "";
+         readOptionalKey(itsFptr, TSTRING, "TTYPE" + number, ttype);
+         readOptionalKey(itsFptr, TSTRING, "TUNIT" + number, tunit);
+         int typecode = 0;
+         long repeat = 0;
+         long width = 0;
+         fits_get_eqcoltype(itsFptr, col + 1, &typecode, &repeat, &width, &status);
+         checkStatus(status, "Failed to get the type of column " + number + " of " + extName);
+         // TDIM can't hold more numbers than its value has characters
+         std::vector<long> dims(FLEN_VALUE);
+         int nDims = 0;
+         if (typecode != TSTRING) {
+             fits_read_tdim(itsFptr, col + 1, static_cast<int>(dims.size()), &nDims, dims.data(), &status);
+             checkStatus(status, "Failed to get the dimensions of column " + number + " of " + extName);
+         }
+         dims.resize(nDims);
+         table.addField(makeField(ttype, typecode, repeat, dims, tunit));
+
+         ColumnReader &reader = columns[col];
+         reader.itsNumber = col + 1;
+         reader.itsType = typecode;
+         reader.itsCount = repeat;
+         reader.itsSinglePrecision = false;
+         reader.itsHasNull = false;
+         reader.itsNull = 0;
+         reader.itsWidth = 0;
+         if (typecode == TSTRING) {
+             reader.itsKind = ColumnReader::STRING;
+             reader.itsCount = 1;
+             reader.itsWidth = std::max(repeat, width);
+         } else if (typecode == TLOGICAL) {
+             reader.itsKind = ColumnReader::LOGICAL;
+         } else if (typecode == TFLOAT || typecode == TDOUBLE || typecode == TCOMPLEX ||
+                    typecode == TDBLCOMPLEX) {
+             reader.itsKind = ColumnReader::REAL;
+             reader.itsSinglePrecision = typecode == TFLOAT || typecode == TCOMPLEX;
+             if (typecode == TCOMPLEX || typecode == TDBLCOMPLEX) {
+                 // both kinds of complex are read as pairs of doubles
+                 reader.itsType = TDBLCOMPLEX;
+                 reader.itsCount *= 2;
+             } else {
+                 reader.itsType = TDOUBLE;
+             }
+         } else {
+             reader.itsKind = ColumnReader::INTEGER;
+             long long tnull = 0;
+             double tzero = 0.;
+             reader.itsHasNull = readOptionalKey(itsFptr, TLONGLONG, "TNULL" + number, &tnull);
+             readOptionalKey(itsFptr, TDOUBLE, "TZERO" + number, &tzero);
+             reader.itsNull = tnull + static_cast<long long>(tzero);
+         }
+    }
+
+    writer.beginResource(resource);
+    writer.beginTable(table);
+
+    // the table is stored row by row, so all columns are read together in chunks
+    // of the number of rows cfitsio can buffer
+    long chunk = 0;
+    if (fits_get_rowsize(itsFptr, &chunk, &status) || chunk < 1) {
+        status = 0;
+        fits_clear_errmsg();
+        chunk = 1;
+    }
+    chunk = std::min(chunk, std::max(nRows, 1l));
+    for (ColumnReader &reader : columns) {
+         reader.allocate(chunk);
+    }
+    VOTableRow row;
+    row.resize(nColumns);
+    std::vector<std::string> &cells = row.getCells();
+    for (long firstRow = 0; firstRow < nRows; firstRow += chunk) {
+         const long nChunkRows = std::min(chunk, nRows - firstRow);
+         for (ColumnReader &reader : columns) {
+              reader.read(itsFptr, firstRow, nChunkRows);
+         }
+         for (long rowInChunk = 0; rowInChunk < nChunkRows; ++rowInChunk) {
+              for (int col = 0; col < nColumns; ++col) {
+                   columns[col].format(rowInChunk, cells[col]);
+              }
+              writer.addRow(row);
+         }
+    }
+
+    writer.endTable();
+    writer.endResource();
+    return static_cast<size_t>(nRows);
+}
@@ -0,0 +1,137 @@
+/// @file FitsTableConverter.h
+/// @brief Direct conversion of FITS binary tables to VOTable
+/// @details The tables written by FitsImageAccess::setInfo (beam logs, component tables) used to be
+/// converted via getInfo, which reads the whole table into a casacore::Record, and a VOTable built
+/// in memory as a DOM tree. This class reads the binary table extensions in chunks of rows and
+/// streams them straight into VOTableWriter, so the memory footprint doesn't depend on the size
+/// of the table.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+///
+
+#ifndef ASKAP_ACCESSORS_FITS_TABLE_CONVERTER_H
+#define ASKAP_ACCESSORS_FITS_TABLE_CONVERTER_H
+
+#include <askap/votable/VOTableField.h>
+#include <askap/votable/VOTableTable.h>
+#include <askap/votable/VOTableWriter.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <fitsio.h>
+
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Direct conversion of FITS binary tables to VOTable
+/// @details Each binary table extension is written as a RESOURCE named after its EXTNAME with a
+/// single TABLE. The keywords of the extension, except the structural ones describing the
+/// columns, become INFO elements of the resource. The columns are mapped as follows:
+/// @code
+/// L -> boolean        B -> unsignedByte   I -> short   J -> int    K -> long
+/// E -> float          D -> double         C -> floatComplex        M -> doubleComplex
+/// A -> char (arraysize="*")
+/// @endcode
+/// Unsigned columns (TZERO offset) are widened to the next signed type (V, which is unsigned
+/// J, becomes long) and scaled integer columns (TSCAL) become float or double. Repeat counts and TDIM
+/// give the arraysize. Bit (X) and variable length (P, Q) columns are not supported.
+///
+/// Undefined values (TNULL for integers, NaN for reals, undefined logicals) of scalar columns
+/// become null cells. Array elements can't be null individually in a VOTable, so undefined reals
+/// are written as NaN, logicals as '?' and integers keep their TNULL value; the cell is null only
+/// if all its elements are undefined.
+/// @ingroup imageaccess
+class FitsTableConverter : private boost::noncopyable {
+public:
+    /// @brief open the FITS file
+    /// @param[in] name file name as given to FitsImageAccess (".fits" is appended unless present)
+    /// @throw AskapError if the file can't be opened
+    explicit FitsTableConverter(const std::string &name);
+
+    /// @brief close the FITS file
+    ~FitsTableConverter();
+
+    /// @brief names of the binary tables in the file
+    /// @return EXTNAME of each binary table extension, in the order of the HDUs
+    std::vector<std::string> tableNames() const;
+
+    /// @brief convert the binary table(s) into the given writer
+    /// @details A RESOURCE is written for each table converted, the writer is not closed.
+    /// @param[in] tblName EXTNAME of the table to convert or "All" for all binary tables
+    /// @param[in] writer VOTable writer to append to
+    /// @param[in] format serialisation of the rows
+    /// @return number of rows written
+    /// @throw AskapError if there is no such table or it has unsupported columns
+    size_t convert(const std::string &tblName, VOTableWriter &writer,
+                   VOTableTable::DataFormat format = VOTableTable::BINARY2) const;
+
+    /// @brief convert the binary table(s) into a VOTable file
+    /// @param[in] tblName EXTNAME of the table to convert or "All" for all binary tables
+    /// @param[in] voName output file name (compressed if it ends with .gz or .zst)
+    /// @param[in] format serialisation of the rows
+    /// @return number of rows written
+    size_t convert(const std::string &tblName, const std::string &voName,
+                   VOTableTable::DataFormat format = VOTableTable::BINARY2) const;
+
+    /// @brief describe a FITS column as a VOTable field
+    /// @param[in] name column name (TTYPE)
+    /// @param[in] typecode cfitsio equivalent type of the column (see fits_get_eqcoltype)
+    /// @param[in] repeat repeat count of the column
+    /// @param[in] dims dimensions given by TDIM, if any (the first axis varies fastest)
+    /// @param[in] unit column unit (TUNIT)
+    /// @return field matching the column
+    /// @throw AskapError if the type has no VOTable counterpart
+    static VOTableField makeField(const std::string &name, int typecode, long repeat,
+                                  const std::vector<long> &dims, const std::string &unit);
+
+private:
+    /// @brief move to the first binary table at or after the given HDU
+    /// @param[in] hdu HDU number (1-based) to start from
+    /// @return number of the HDU found or 0 if there are no more binary tables
+    int firstTable(int hdu) const;
+
+    /// @return EXTNAME of the current HDU (empty if not defined)
+    std::string currentName() const;
+
+    /// @brief convert the table in the current HDU
+    /// @param[in] writer VOTable writer to append to
+    /// @param[in] format serialisation of the rows
+    /// @return number of rows written
+    size_t convertCurrent(VOTableWriter &writer, VOTableTable::DataFormat format) const;
+
+    /// @brief name of the file
+    std::string itsName;
+
+    /// @brief cfitsio handle
+    fitsfile *itsFptr;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_FITS_TABLE_CONVERTER_H
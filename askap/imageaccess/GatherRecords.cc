@@ -0,0 +1,98 @@
+/// @file GatherRecords.cc
+/// @brief Collective gather of fixed-size records
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/askap/AskapError.h>
+#include <askap/imageaccess/GatherRecords.h>
+
+#include <limits>
+
+/// @brief gather packed records onto a single rank
+/// @details The sizes are gathered first, so ranks can contribute different numbers of records.
+/// @param[in] local records of this rank (packed, the same record size on all ranks)
+/// @param[in] root rank to gather onto
+/// @param[in] comm communicator
+/// @return concatenated records on the root rank, an empty vector on other ranks
+std::vector<double> askap::accessors::gatherRecords(const std::vector<double> &local, int root, MPI_Comm comm)
+{
+    int rank = 0;
+    int nProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nProcs);
+    ASKAPCHECK((root >= 0) && (root < nProcs), "Unable to gather onto rank " << root << ", there are " << nProcs << " ranks");
+    ASKAPCHECK(local.size() <= static_cast<size_t>(std::numeric_limits<int>::max()), "Too many records to gather");
+    int count = static_cast<int>(local.size());
+    std::vector<int> counts(rank == root ? nProcs : 0, 0);
+    const int status = MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, root, comm);
+    ASKAPCHECK(status == MPI_SUCCESS, "Failed to gather the number of records, error = " << status);
+
+    std::vector<int> displacements(counts.size(), 0);
+    size_t total = 0;
+    for (size_t proc = 0; proc < counts.size(); ++proc) {
+         displacements[proc] = static_cast<int>(total);
+         total += counts[proc];
+         ASKAPCHECK(total <= static_cast<size_t>(std::numeric_limits<int>::max()), "Too many records to gather");
+    }
+    std::vector<double> result(total);
+    const int status1 = MPI_Gatherv(const_cast<double*>(local.data()), count, MPI_DOUBLE, result.data(),
+                                    counts.data(), displacements.data(), MPI_DOUBLE, root, comm);
+    ASKAPCHECK(status1 == MPI_SUCCESS, "Failed to gather the records, error = " << status1);
+    return result;
+}
+
+/// @brief element-wise maximum of the vectors of all ranks on a single rank
+/// @details The longest length is agreed on first, then the padded vectors are reduced
+/// with a single MPI_Reduce.
+/// @param[in] local values of this rank
+/// @param[in] root rank to reduce onto
+/// @param[in] padding value used to pad shorter vectors
+/// @param[in] comm communicator
+/// @return element-wise maximum (as long as the longest vector) on the root rank,
+/// an empty vector on other ranks
+std::vector<float> askap::accessors::reduceMax(const std::vector<float> &local, int root, float padding,
+                                               MPI_Comm comm)
+{
+    int rank = 0;
+    int nProcs = 1;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &nProcs);
+    ASKAPCHECK((root >= 0) && (root < nProcs), "Unable to reduce onto rank " << root << ", there are " << nProcs << " ranks");
+    ASKAPCHECK(local.size() <= static_cast<size_t>(std::numeric_limits<int>::max()), "Too many values to reduce");
+    int count = static_cast<int>(local.size());
+    int maxCount = 0;
+    const int status = MPI_Allreduce(&count, &maxCount, 1, MPI_INT, MPI_MAX, comm);
+    ASKAPCHECK(status == MPI_SUCCESS, "Failed to reduce the number of values, error = " << status);
+
+    std::vector<float> padded(local);
+    padded.resize(maxCount, padding);
+    std::vector<float> result(rank == root ? maxCount : 0);
+    const int status1 = MPI_Reduce(padded.data(), result.data(), maxCount, MPI_FLOAT, MPI_MAX, root, comm);
+    ASKAPCHECK(status1 == MPI_SUCCESS, "Failed to reduce the values, error = " << status1);
+    return result;
+}
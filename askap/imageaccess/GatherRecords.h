@@ -0,0 +1,66 @@
+/// @file GatherRecords.h
+/// @brief Collective gather of fixed-size records
+/// @details Per-channel logs (beams, weights) are gathered onto a single rank at the end
+/// of the spectral imaging jobs. Packing the entries into fixed-size records of doubles
+/// allows a single MPI_Gatherv call instead of a point-to-point exchange with each rank.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_GATHER_RECORDS_H
+#define ASKAP_ACCESSORS_GATHER_RECORDS_H
+
+#include <mpi.h>
+
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief gather packed records onto a single rank
+/// @details This is a collective operation, all ranks of the communicator have to call it.
+/// The records of all ranks are concatenated in the rank order.
+/// @param[in] local records of this rank (packed, the same record size on all ranks)
+/// @param[in] root rank to gather onto
+/// @param[in] comm communicator
+/// @return concatenated records on the root rank, an empty vector on other ranks
+std::vector<double> gatherRecords(const std::vector<double> &local, int root, MPI_Comm comm = MPI_COMM_WORLD);
+
+/// @brief element-wise maximum of the vectors of all ranks on a single rank
+/// @details This is a collective operation, all ranks of the communicator have to call it.
+/// The vectors may have different lengths, shorter vectors are padded.
+/// @param[in] local values of this rank
+/// @param[in] root rank to reduce onto
+/// @param[in] padding value used to pad shorter vectors
+/// @param[in] comm communicator
+/// @return element-wise maximum (as long as the longest vector) on the root rank,
+/// an empty vector on other ranks
+std::vector<float> reduceMax(const std::vector<float> &local, int root, float padding,
+                             MPI_Comm comm = MPI_COMM_WORLD);
+
+} // namespace accessors
+} // namespace askap
+
+#endif
@@ -0,0 +1,311 @@
+/// @file Hdf5ImageAccess.h
+/// @brief Access HDF5 image
+/// @details This class implements IImageAccess interface for images stored in HDF5 files
+/// by casacore. The pixels are kept in a chunked dataset, so the I/O efficiency along different
+/// axes of large spectral cubes is controlled by the chunk shape.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_HDF5_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_HDF5_IMAGE_ACCESS_H
+
+#include <askap/imageaccess/IImageAccess.h>
+
+#include <casacore/images/Images/HDF5Image.h>
+#include <casacore/lattices/Lattices/TiledShape.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Access HDF5 image
+/// @details The image is a casacore::HDF5Image stored in the file with the ".h5" extension added
+/// to the image name (like ".fits" for FITS images). The dataset is chunked with the shape
+/// given by setChunkShape or with casacore's default tiling, which has roughly equal length
+/// along all axes and therefore gives similar performance for plane and spectrum access.
+/// Units, beams, keywords, history and info tables are stored in the attributes of the file.
+/// The most recently used image is kept open between the calls. The HDF5 library has to be
+/// available to casacore, otherwise an exception is thrown at construction.
+/// @ingroup imageaccess
+template <class T = casacore::Float>
+struct Hdf5ImageAccess : public IImageAccess<T> {
+
+    /// @brief constructor
+    Hdf5ImageAccess();
+
+    /// @brief destructor, closes the image
+    virtual ~Hdf5ImageAccess();
+
+    /// @brief write all changes to disk
+    /// @details The image stays open.
+    void flush() const;
+
+    /// @brief close the open image, if any
+    void close();
+
+    /// @brief set the chunk shape for new images
+    /// @details An empty shape means casacore's default tiling. The chunk shape is
+    /// adjusted to the image shape if it has fewer or more dimensions.
+    /// @param[in] chunkShape chunk shape (same dimensionality as the images created)
+    void setChunkShape(const casacore::IPosition &chunkShape);
+
+    /// @brief chunk shape for a new image
+    /// @param[in] shape shape of the image
+    /// @return tiled shape to create the image with
+    casacore::TiledShape tiledShape(const casacore::IPosition &shape) const;
+
+    /// @return true if casacore has been built with HDF5 support
+    static bool hasHDF5Support();
+
+    //////////////////
+    // Reading methods
+    //////////////////
+
+    /// @brief obtain the shape
+    /// @param[in] name image name
+    /// @return full shape of the given image
+    virtual casacore::IPosition shape(const std::string &name) const override;
+
+    /// @brief read full image
+    /// @param[in] name image name
+    /// @return array with pixels
+    virtual casacore::Array<T> read(const std::string &name) const override;
+
+    /// @brief read part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return array with pixels for the selection only
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc) const override;
+
+    /// @brief read every stride-th pixel of part of the image
+    /// @details The strided slicer is passed to the HDF5 hyperslab selection, so only
+    /// the chunks holding the pixels returned are read. Unmasked pixels are set to zero as in read.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[in] stride increment along each axis (1 to take all pixels)
+    /// @return array with (trc - blc) / stride + 1 pixels along each axis
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc, const casacore::IPosition &stride) const override;
+
+    /// @brief read part of the image into the given buffer
+    /// @details The buffer is only resized if its shape doesn't match the selection.
+    /// Unmasked pixels are set to zero as in read.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with pixels for the selection
+    virtual void readInto(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<T> &buffer) const override;
+
+    /// @brief Determine whether an image has a mask
+    /// @param[in] nam image name
+    /// @return True if image has a mask, False if not.
+    virtual bool isMasked(const std::string &name) const override;
+
+    /// @brief read the mask for the full image
+    /// @param[in] name image name
+    /// @return bool array with mask values - 1=good, 0=bad
+    virtual casacore::LogicalArray readMask(const std::string &name) const override;
+
+    /// @brief read the mask for part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return bool array with mask values - 1=good, 0=bad
+    virtual casacore::LogicalArray readMask(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc) const override;
+
+    /// @brief obtain coordinate system info
+    /// @param[in] name image name
+    /// @return coordinate system object
+    virtual casacore::CoordinateSystem coordSys(const std::string &name) const override;
+
+    /// @brief obtain coordinate system info for part of an image
+    /// @param[in] name image name
+    /// @return coordinate system object
+    virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+            const casacore::IPosition &trc) const override;
+
+    /// @brief obtain beam info
+    /// @param[in] name image name
+    /// @return beam info vector
+    virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const override;
+
+    /// @brief obtain beam info
+    /// @param[in] name image name
+    /// @return beam info list
+    virtual BeamList beamList(const std::string &name) const override;
+
+    /// @brief obtain pixel units
+    /// @param[in] name image name
+    /// @return units string
+    virtual std::string getUnits(const std::string &name) const override;
+
+    /// @brief this methods retrieves the table(s) in the image and stores them in the casacore::Record
+    /// @param[in] name - image name
+    /// @param[in] tblName - name of the table to retrieve the data. if tblName = "All" then retrieve all
+    ///                      the tables in the image
+    /// @param[out] info - casacore::Record to contain the tables' data.
+    virtual void getInfo(const std::string &name, const std::string& tableName, casacore::Record &info) override;
+
+    /// @brief Get a particular keyword from the image metadata (A.K.A header)
+    /// @details This reads a given keyword from the image metadata.
+    /// @param[in] name Image name
+    /// @param[in] keyword The name of the metadata keyword
+    /// @return pair of strings - keyword value and comment
+    virtual std::pair<std::string, std::string> getMetadataKeyword(const std::string &name, const std::string &keyword) const override;
+
+    //////////////////
+    // Writing methods
+    //////////////////
+
+    /// @brief create a new image
+    /// @details The file is created straight away with the chunk shape given by tiledShape.
+    /// @param[in] name image name
+    /// @param[in] shape full shape of the image
+    /// @param[in] csys coordinate system of the full image
+    virtual void create(const std::string &name, const casacore::IPosition &shape,
+                        const casacore::CoordinateSystem &csys) override;
+
+    /// @brief write full image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    virtual void write(const std::string &name, const casacore::Array<T> &arr) override;
+
+    /// @brief write a slice of an image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::IPosition &where) override;
+
+    /// @brief write an image and mask
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] mask array with mask
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::Array<bool> &mask);
+
+    /// @brief write a slice of an image and mask
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::Array<bool> &mask, const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image mask
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                           const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image mask
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask) override;
+
+    /// @brief set brightness units of the image
+    /// @param[in] name image name
+    /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+    virtual void setUnits(const std::string &name, const std::string &units) override;
+
+    /// @brief set restoring beam info
+    /// @param[in] name image name
+    /// @param[in] maj major axis in radians
+    /// @param[in] min minor axis in radians
+    /// @param[in] pa position angle in radians
+    virtual void setBeamInfo(const std::string &name, double maj, double min, double pa) override;
+
+    /// @brief set restoring beam info for all channels
+    /// @param[in] name image name
+    /// @param[in] beamlist The list of beams
+    virtual void setBeamInfo(const std::string &name, const BeamList & beamlist) override;
+
+    /// @brief apply mask to image
+    /// @details The default pixel mask is created with all pixels good
+    /// @param[in] name image name
+    virtual void makeDefaultMask(const std::string &name) override;
+
+    /// @brief Set a particular keyword for the metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keyword The name of the metadata keyword
+    /// @param[in] value The value for the keyword, in string format
+    /// @param[in] desc A description of the keyword
+    virtual void setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                    const std::string value, const std::string &desc = "") override;
+
+    /// @brief Set the keywords for the metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keywords A parset with keyword entries (KEYWORD = ["keyword value","keyword description","STRING"])
+    virtual void setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords) override;
+
+    /// @brief Add HISTORY messages to the image metadata
+    /// @details The lines are appended to the HISTORY field of the image metadata.
+    /// @param[in] name Image name
+    /// @param[in] historyLines History comments to add
+    virtual void addHistory(const std::string &name, const std::vector<std::string> &historyLines) override;
+
+    /// @brief set info for image that can vary by e.g., channel
+    /// @details The info table is stored as a sub-record of the image metadata
+    /// @param[in] name image name
+    /// @param[in] info record with information
+    virtual void setInfo(const std::string &name, const casacore::RecordInterface & info) override;
+
+private:
+    /// @brief obtain an open image
+    /// @details The image is opened if necessary, the previously open image is closed.
+    /// @param[in] name image name
+    /// @return reference to the image (valid until another image is opened)
+    casacore::HDF5Image<T>& image(const std::string &name) const;
+
+    /// @param[in] name image name
+    /// @return name of the file with the image
+    static std::string fileName(const std::string &name);
+
+    /// @brief open image
+    mutable boost::shared_ptr<casacore::HDF5Image<T> > itsImage;
+
+    /// @brief name of the open image
+    mutable std::string itsImageName;
+
+    /// @brief chunk shape for new images, empty for the default tiling
+    casacore::IPosition itsChunkShape;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#include "Hdf5ImageAccess.tcc"
+
+#endif // #ifndef ASKAP_ACCESSORS_HDF5_IMAGE_ACCESS_H
@@ -0,0 +1,611 @@
+/// @file Hdf5ImageAccess.tcc
+/// @brief Access HDF5 image
+/// @details This class implements IImageAccess interface for images stored in HDF5 files
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/imageaccess/Hdf5ImageAccess.h>
+
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapUtil.h>
+#include <casacore/casa/HDF5/HDF5Object.h>
+#include <casacore/casa/Arrays/Vector.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+ASKAP_LOGGER(hdf5ImAccessLogger, ".hdf5ImageAccessor");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor
+template <class T>
+Hdf5ImageAccess<T>::Hdf5ImageAccess()
+{
+    ASKAPCHECK(hasHDF5Support(), "HDF5 images are not supported, casacore has been built without HDF5");
+}
+
+/// @brief destructor, closes the image
+template <class T>
+Hdf5ImageAccess<T>::~Hdf5ImageAccess()
+{
+    close();
+}
+
+/// @return true if casacore has been built with HDF5 support
+template <class T>
+bool Hdf5ImageAccess<T>::hasHDF5Support()
+{
+    return casacore::HDF5Object::hasHDF5Support();
+}
+
+/// @brief write all changes to disk
+/// @details The image stays open.
+template <class T>
+void Hdf5ImageAccess<T>::flush() const
+{
+    if (itsImage) {
+        itsImage->flush();
+    }
+}
+
+/// @brief close the open image, if any
+template <class T>
+void Hdf5ImageAccess<T>::close()
+{
+    itsImage.reset();
+    itsImageName.clear();
+}
+
+/// @brief set the chunk shape for new images
+/// @details An empty shape means casacore's default tiling. The chunk shape is
+/// adjusted to the image shape if it has fewer or more dimensions.
+/// @param[in] chunkShape chunk shape (same dimensionality as the images created)
+template <class T>
+void Hdf5ImageAccess<T>::setChunkShape(const casacore::IPosition &chunkShape)
+{
+    for (casacore::uInt axis = 0; axis < chunkShape.nelements(); ++axis) {
+         ASKAPCHECK(chunkShape[axis] > 0, "Chunk shape " << chunkShape << " should be positive along all axes");
+    }
+    itsChunkShape = chunkShape;
+}
+
+/// @brief chunk shape for a new image
+/// @details The missing axes of the chunk are set to 1 (i.e. a single plane of the trailing
+/// axes), the chunk is clipped at the image shape.
+/// @param[in] shape shape of the image
+/// @return tiled shape to create the image with
+template <class T>
+casacore::TiledShape Hdf5ImageAccess<T>::tiledShape(const casacore::IPosition &shape) const
+{
+    if (itsChunkShape.nelements() == 0) {
+        return casacore::TiledShape(shape);
+    }
+    casacore::IPosition chunk(shape.nelements(), 1);
+    for (casacore::uInt axis = 0; axis < chunk.nelements() && axis < itsChunkShape.nelements(); ++axis) {
+         chunk[axis] = std::min(itsChunkShape[axis], shape[axis]);
+    }
+    return casacore::TiledShape(shape, chunk);
+}
+
+/// @param[in] name image name
+/// @return name of the file with the image
+template <class T>
+std::string Hdf5ImageAccess<T>::fileName(const std::string &name)
+{
+    return name + ".h5";
+}
+
+/// @brief obtain an open image
+/// @details The image is opened if necessary, the previously open image is closed.
+/// @param[in] name image name
+/// @return reference to the image (valid until another image is opened)
+template <class T>
+casacore::HDF5Image<T>& Hdf5ImageAccess<T>::image(const std::string &name) const
+{
+    if (!itsImage || (itsImageName != name)) {
+        itsImage.reset();
+        itsImage.reset(new casacore::HDF5Image<T>(fileName(name)));
+        itsImageName = name;
+    }
+    return *itsImage;
+}
+
+// reading methods
+
+/// @brief obtain the shape
+/// @param[in] name image name
+/// @return full shape of the given image
+template <class T>
+casacore::IPosition Hdf5ImageAccess<T>::shape(const std::string &name) const
+{
+    return image(name).shape();
+}
+
+/// @brief read full image
+/// @param[in] name image name
+/// @return array with pixels
+template <class T>
+casacore::Array<T> Hdf5ImageAccess<T>::read(const std::string &name) const
+{
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, "Reading HDF5 image " << name);
+    const casacore::IPosition shape = image(name).shape();
+    casacore::Array<T> result;
+    readInto(name, casacore::IPosition(shape.nelements(), 0), shape - 1, result);
+    return result;
+}
+
+/// @brief read part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return array with pixels for the selection only
+template <class T>
+casacore::Array<T> Hdf5ImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, "Reading a slice of the HDF5 image " << name << " from " << blc <<
+                      " to " << trc);
+    casacore::Array<T> result;
+    readInto(name, blc, trc, result);
+    return result;
+}
+
+/// @brief read every stride-th pixel of part of the image
+/// @details Unmasked pixels are set to zero as in read.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[in] stride increment along each axis (1 to take all pixels)
+/// @return array with (trc - blc) / stride + 1 pixels along each axis
+template <class T>
+casacore::Array<T> Hdf5ImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, const casacore::IPosition &stride) const
+{
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, "Reading a slice of the HDF5 image " << name << " from " << blc << " to " <<
+                      trc << " with the stride " << stride);
+    ASKAPCHECK(casacore::allGT(stride, 0), "Stride should be positive, you have " << stride);
+    casacore::HDF5Image<T> &img = image(name);
+    const casacore::Slicer slicer(blc, trc, stride, casacore::Slicer::endIsLast);
+    casacore::Array<T> result = img.getSlice(slicer);
+    if (img.hasPixelMask()) {
+        const casacore::LogicalArray mask = img.getMaskSlice(slicer);
+        typename casacore::Array<T>::iterator iterBuffer = result.begin();
+        for (casacore::LogicalArray::const_iterator iterMask = mask.begin(); iterMask != mask.end();
+             ++iterMask, ++iterBuffer) {
+             if (!*iterMask) {
+                 *iterBuffer = static_cast<T>(0.0);
+             }
+        }
+    }
+    return result;
+}
+
+/// @brief read part of the image into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// Unmasked pixels are set to zero as in read.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with pixels for the selection
+template <class T>
+void Hdf5ImageAccess<T>::readInto(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, casacore::Array<T> &buffer) const
+{
+    casacore::HDF5Image<T> &img = image(name);
+    const casacore::Slicer slicer(blc, trc, casacore::Slicer::endIsLast);
+    if (!buffer.shape().isEqual(slicer.length())) {
+        buffer.resize(slicer.length());
+    }
+    img.getSlice(buffer, slicer);
+    if (img.hasPixelMask()) {
+        const casacore::LogicalArray mask = img.getMaskSlice(slicer);
+        typename casacore::Array<T>::iterator iterBuffer = buffer.begin();
+        for (casacore::LogicalArray::const_iterator iterMask = mask.begin(); iterMask != mask.end();
+             ++iterMask, ++iterBuffer) {
+             if (!*iterMask) {
+                 *iterBuffer = static_cast<T>(0.0);
+             }
+        }
+    }
+}
+
+/// @brief Determine whether an image has a mask
+/// @param[in] nam image name
+/// @return True if image has a mask, False if not.
+template <class T>
+bool Hdf5ImageAccess<T>::isMasked(const std::string &name) const
+{
+    return image(name).hasPixelMask();
+}
+
+/// @brief read the mask for the full image
+/// @param[in] name image name
+/// @return bool array with mask values - 1=good, 0=bad
+template <class T>
+casacore::LogicalArray Hdf5ImageAccess<T>::readMask(const std::string &name) const
+{
+    casacore::HDF5Image<T> &img = image(name);
+    if (img.hasPixelMask()) {
+        return img.getMask();
+    }
+    return casacore::LogicalArray(img.shape(), true);
+}
+
+/// @brief read the mask for part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return bool array with mask values - 1=good, 0=bad
+template <class T>
+casacore::LogicalArray Hdf5ImageAccess<T>::readMask(const std::string &name, const casacore::IPosition &blc,
+                                                    const casacore::IPosition &trc) const
+{
+    casacore::HDF5Image<T> &img = image(name);
+    const casacore::Slicer slicer(blc, trc, casacore::Slicer::endIsLast);
+    if (img.hasPixelMask()) {
+        return img.getMaskSlice(slicer);
+    }
+    return casacore::LogicalArray(slicer.length(), true);
+}
+
+/// @brief obtain coordinate system info
+/// @param[in] name image name
+/// @return coordinate system object
+template <class T>
+casacore::CoordinateSystem Hdf5ImageAccess<T>::coordSys(const std::string &name) const
+{
+    return image(name).coordinates();
+}
+
+/// @brief obtain coordinate system info for part of an image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return coordinate system object
+template <class T>
+casacore::CoordinateSystem Hdf5ImageAccess<T>::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    const casacore::HDF5Image<T> &img = image(name);
+    return this->sliceCoordSys(img.coordinates(), img.shape(), blc, trc);
+}
+
+/// @brief obtain beam info
+/// @param[in] name image name
+/// @return beam info vector
+template <class T>
+casacore::Vector<casacore::Quantum<double> > Hdf5ImageAccess<T>::beamInfo(const std::string &name) const
+{
+    const casacore::ImageInfo ii = image(name).imageInfo();
+    if (!ii.hasMultipleBeams()) {
+        return ii.restoringBeam().toVector();
+    }
+    return casacore::Vector<casacore::Quantum<double> >();
+}
+
+/// @brief get restoring beam info
+/// @param[in] name image name
+/// @return beamlist  list of beams, beamlist will be empty if image only has a single beam
+template <class T>
+BeamList Hdf5ImageAccess<T>::beamList(const std::string &name) const
+{
+    const casacore::ImageInfo ii = image(name).imageInfo();
+    BeamList bl;
+    if (ii.hasMultipleBeams()) {
+        for (int chan = 0; chan < ii.nChannels(); chan++) {
+             bl[chan] = ii.restoringBeam(chan,0).toVector();
+        }
+    }
+    return bl;
+}
+
+/// @brief obtain pixel units
+/// @param[in] name image name
+/// @return units string
+template <class T>
+std::string Hdf5ImageAccess<T>::getUnits(const std::string &name) const
+{
+    return image(name).units().getName();
+}
+
+/// @brief Get a particular keyword from the image metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @return pair of strings - keyword value and comment
+template <class T>
+std::pair<std::string, std::string> Hdf5ImageAccess<T>::getMetadataKeyword(const std::string &name,
+        const std::string &keyword) const
+{
+    const casacore::TableRecord miscinfo = image(name).miscInfo();
+    if (miscinfo.isDefined(keyword)) {
+        return std::pair<std::string,std::string>(miscinfo.asString(keyword), miscinfo.comment(keyword));
+    }
+    ASKAPLOG_DEBUG_STR(hdf5ImAccessLogger, "Keyword " << keyword << " is not defined in metadata for image " << name);
+    return std::pair<std::string,std::string>("","");
+}
+
+/// @brief this methods retrieves the table(s) in the image and stores them in the casacore::Record
+/// @param[in] name - image name
+/// @param[in] tblName - name of the table to retrieve the data. if tblName = "All" then retrieve all
+///                      the tables in the image
+/// @param[out] info - casacore::Record to contain the tables' data.
+template <class T>
+void Hdf5ImageAccess<T>::getInfo(const std::string &name, const std::string& tableName, casacore::Record &info)
+{
+    const casacore::Record miscinfo = image(name).miscInfo().toRecord();
+    for (casacore::uInt f = 0; f < miscinfo.nfields(); ++f) {
+         // the tables are stored as sub-records
+         if ((miscinfo.dataType(f) == casacore::TpRecord) &&
+             ((tableName == miscinfo.name(f)) || (tableName == "All"))) {
+             info.defineRecord(miscinfo.name(f), miscinfo.asRecord(f));
+         }
+    }
+}
+
+// writing methods
+
+/// @brief create a new image
+/// @details The file is created straight away with the chunk shape given by tiledShape.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+template <class T>
+void Hdf5ImageAccess<T>::create(const std::string &name, const casacore::IPosition &shape,
+                                const casacore::CoordinateSystem &csys)
+{
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, "Creating a new HDF5 image " << name << " with the shape " << shape);
+    close();
+    const casacore::TiledShape tiled = tiledShape(shape);
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, " - chunk shape " << tiled.tileShape());
+    itsImage.reset(new casacore::HDF5Image<T>(tiled, csys, fileName(name)));
+    itsImageName = name;
+}
+
+/// @brief write full image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+template <class T>
+void Hdf5ImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr)
+{
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, "Writing an array with the shape " << arr.shape() << " into a HDF5 image " <<
+                      name);
+    image(name).put(arr);
+    this->accumulateStatistics(arr, casacore::IPosition(arr.ndim(), 0));
+}
+
+/// @brief write a slice of an image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void Hdf5ImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                               const casacore::IPosition &where)
+{
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, "Writing a slice with the shape " << arr.shape() << " into a HDF5 image " <<
+                      name << " at " << where);
+    image(name).putSlice(arr, where);
+    this->accumulateStatistics(arr, where);
+}
+
+/// @brief write an image and mask
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] mask array with mask
+template <class T>
+void Hdf5ImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                               const casacore::Array<bool> &mask)
+{
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, "Writing image & mask with the shape " << arr.shape() <<
+                      " into a HDF5 image " << name);
+    casacore::HDF5Image<T> &img = image(name);
+    img.put(arr);
+    img.pixelMask().put(mask);
+    this->accumulateStatistics(arr, mask, casacore::IPosition(arr.ndim(), 0));
+}
+
+/// @brief write a slice of an image and mask
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void Hdf5ImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                               const casacore::Array<bool> &mask, const casacore::IPosition &where)
+{
+    ASKAPLOG_INFO_STR(hdf5ImAccessLogger, "Writing a slice with the shape " << arr.shape() << " into a HDF5 image " <<
+                      name << " at " << where);
+    casacore::HDF5Image<T> &img = image(name);
+    img.putSlice(arr, where);
+    img.pixelMask().putSlice(mask, where);
+    this->accumulateStatistics(arr, mask, where);
+}
+
+/// @brief write a slice of an image mask
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void Hdf5ImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                                   const casacore::IPosition &where)
+{
+    image(name).pixelMask().putSlice(mask, where);
+}
+
+/// @brief write a slice of an image mask
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+template <class T>
+void Hdf5ImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+{
+    image(name).pixelMask().put(mask);
+}
+
+/// @brief set brightness units of the image
+/// @param[in] name image name
+/// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+template <class T>
+void Hdf5ImageAccess<T>::setUnits(const std::string &name, const std::string &units)
+{
+    image(name).setUnits(casacore::Unit(units));
+}
+
+/// @brief set restoring beam info
+/// @param[in] name image name
+/// @param[in] maj major axis in radians
+/// @param[in] min minor axis in radians
+/// @param[in] pa position angle in radians
+template <class T>
+void Hdf5ImageAccess<T>::setBeamInfo(const std::string &name, double maj, double min, double pa)
+{
+    casacore::HDF5Image<T> &img = image(name);
+    casacore::ImageInfo ii = img.imageInfo();
+    ii.setRestoringBeam(casacore::Quantity(maj, "rad"), casacore::Quantity(min, "rad"), casacore::Quantity(pa, "rad"));
+    img.setImageInfo(ii);
+}
+
+/// @brief set restoring beam info for all channels
+/// @param[in] name image name
+/// @param[in] beamlist  list of beams
+template <class T>
+void Hdf5ImageAccess<T>::setBeamInfo(const std::string &name, const BeamList & beamlist)
+{
+    casacore::HDF5Image<T> &img = image(name);
+    casacore::ImageInfo ii = img.imageInfo();
+    ii.setAllBeams(beamlist.size(),1,casacore::GaussianBeam());
+    for (const auto& beam : beamlist) {
+         ASKAPDEBUGASSERT(beam.second.size()==3);
+         ii.setBeam(beam.first,0,beam.second[0],beam.second[1],beam.second[2]);
+    }
+    img.setImageInfo(ii);
+}
+
+/// @brief apply mask to image
+/// @details The default pixel mask is created with all pixels good
+/// @param[in] name image name
+template <class T>
+void Hdf5ImageAccess<T>::makeDefaultMask(const std::string &name)
+{
+    casacore::HDF5Image<T> &img = image(name);
+    img.makeMask("mask", casacore::True, casacore::True);
+    img.pixelMask().put(casacore::Array<casacore::Bool>(img.shape(), casacore::True));
+}
+
+/// @brief Set a particular keyword for the metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @param[in] value The value for the keyword, in string format
+/// @param[in] desc A description of the keyword
+template <class T>
+void Hdf5ImageAccess<T>::setMetadataKeyword(const std::string &name, const std::string &keyword,
+        const std::string value, const std::string &desc)
+{
+    casacore::HDF5Image<T> &img = image(name);
+    casacore::TableRecord miscinfo = img.miscInfo();
+    miscinfo.define(keyword, value);
+    miscinfo.setComment(keyword, desc);
+    img.setMiscInfo(miscinfo);
+}
+
+/// @brief Set the keywords for the metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keywords A parset with keyword entries (KEYWORD = ["keyword value","keyword description","STRING"])
+template <class T>
+void Hdf5ImageAccess<T>::setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords)
+{
+    casacore::HDF5Image<T> &img = image(name);
+    casacore::TableRecord miscinfo = img.miscInfo();
+    for (auto &elem : keywords) {
+         const std::string keyword = elem.first;
+         const std::vector<std::string> valanddesc = elem.second.getStringVector();
+         if (valanddesc.size() == 0) {
+             continue;
+         }
+         const std::string value = valanddesc[0];
+         const std::string desc = (valanddesc.size() > 1 ? valanddesc[1] : "");
+         const std::string type = (valanddesc.size() > 2 ? toUpper(valanddesc[2]) : "STRING");
+         try {
+            if (type == "INT") {
+                miscinfo.define(keyword, std::stoi(value));
+            } else if (type == "DOUBLE") {
+                miscinfo.define(keyword, std::stod(value));
+            } else if (type == "STRING") {
+                miscinfo.define(keyword, value);
+            } else {
+                ASKAPLOG_WARN_STR(hdf5ImAccessLogger, "Invalid type for header keyword "<<keyword<<" : "<<type);
+                continue;
+            }
+            miscinfo.setComment(keyword, desc);
+         }
+         catch (const std::logic_error&) {
+            // invalid_argument or out_of_range from the conversion
+            ASKAPLOG_WARN_STR(hdf5ImAccessLogger, "Invalid "<<type<<" value for header keyword "<<keyword<<" : "<<value);
+         }
+    }
+    img.setMiscInfo(miscinfo);
+}
+
+/// @brief Add HISTORY messages to the image metadata
+/// @details The lines are appended to the HISTORY field of the image metadata.
+/// @param[in] name Image name
+/// @param[in] historyLines History comments to add
+template <class T>
+void Hdf5ImageAccess<T>::addHistory(const std::string &name, const std::vector<std::string> &historyLines)
+{
+    casacore::HDF5Image<T> &img = image(name);
+    casacore::TableRecord miscinfo = img.miscInfo();
+    std::vector<casacore::String> history;
+    if (miscinfo.isDefined("HISTORY")) {
+        miscinfo.asArrayString("HISTORY").tovector(history);
+    }
+    history.insert(history.end(), historyLines.begin(), historyLines.end());
+    miscinfo.define("HISTORY", casacore::Vector<casacore::String>(history));
+    img.setMiscInfo(miscinfo);
+}
+
+/// @brief set info for image that can vary by e.g., channel
+/// @details The info table is stored as a sub-record of the image metadata
+/// @param[in] name image name
+/// @param[in] info record with information
+template <class T>
+void Hdf5ImageAccess<T>::setInfo(const std::string &name, const casacore::RecordInterface & info)
+{
+    casacore::HDF5Image<T> &img = image(name);
+    casacore::TableRecord miscinfo = img.miscInfo();
+    // the name of the info table is the name of the first sub-record
+    std::string infoTableName = "notfound";
+    for (casacore::uInt f = 0; f < info.nfields(); ++f) {
+         if (info.dataType(f) == casacore::TpRecord) {
+             infoTableName = info.name(f);
+             break;
+         }
+    }
+    miscinfo.defineRecord(infoTableName, info);
+    img.setMiscInfo(miscinfo);
+}
@@ -41,12 +41,20 @@
 #include <casacore/casa/Quanta/Quantum.h>
 #include <casacore/casa/Containers/RecordInterface.h>
 #include <askap/askapparallel/AskapParallel.h>
+#include <askap/imageaccess/ImageMetadata.h>
+#include <askap/imageaccess/PackedMask.h>
+#include <askap/imageaccess/RegionCoalescer.h>
+#include <askap/dataaccess/ArrayAllocator.h>
 #include <Common/ParameterSet.h>
+#include <boost/shared_ptr.hpp>
+
+#include <map>
 
 namespace askap {
 namespace accessors {
 
-typedef std::map<unsigned int, casacore::Vector<casacore::Quantum<double> > > BeamList;
+class ImageStatistics;
+class ImageRegionLock;
 
 /// @brief Basic interface to access an image
 /// @details This interface class is somewhat analogous to casacore::ImageInterface. But it has
@@ -82,6 +90,63 @@ struct IImageAccess {
     virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
                                     const casacore::IPosition &trc) const = 0;
 
+    /// @brief read every stride-th pixel of part of the image
+    /// @details This is meant for previews and thumbnails. The pixels at blc, blc + stride,
+    /// blc + 2 * stride, ... up to trc are returned. The default implementation reads the whole
+    /// selection and decimates it, the accessors override it to read only the pixels returned.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[in] stride increment along each axis (1 to take all pixels)
+    /// @return array with (trc - blc) / stride + 1 pixels along each axis
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc, const casacore::IPosition &stride) const;
+
+    /// @brief read part of the image averaged in blocks
+    /// @details Each output pixel is the average of a block of factor pixels, the blocks at the
+    /// top right edges may be smaller. NaNs are ignored, the output pixel is NaN if the whole
+    /// block is blank. Unlike the strided read all pixels have to be read, but the selection is
+    /// read in slabs of factor pixels along the last axis, so only one slab is held in memory.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[in] factor block size along each axis (1 to keep the resolution)
+    /// @return array with ceil((trc - blc + 1) / factor) pixels along each axis
+    casacore::Array<T> readAveraged(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc, const casacore::IPosition &factor) const;
+
+    /// @brief read part of the image into the given buffer
+    /// @details The buffer is only resized if its shape doesn't match the selection, so
+    /// the same buffer can be reused to read an image piece by piece. The default
+    /// implementation copies the result of read into the buffer.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with pixels for the selection
+    virtual void readInto(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<T> &buffer) const;
+
+    /// @brief read part of the image into the given memory
+    /// @details This is a wrapper around readInto for data not held by a casacore array.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] data pointer to the memory for (trc - blc + 1).product() pixels (Fortran order)
+    void readIntoStorage(const std::string &name, const casacore::IPosition &blc,
+                         const casacore::IPosition &trc, T *data) const;
+
+    /// @brief read many parts of the image
+    /// @details This is meant for many small, possibly overlapping cutouts, e.g. around the
+    /// sources found. Overlapping and adjacent regions (or those within maxGap pixels) are
+    /// merged into larger reads (see RegionCoalescer), which are done one by one in the storage
+    /// order, and the pixels of each region are copied out of the merged read.
+    /// @param[in] name image name
+    /// @param[in] regions bottom left and top right corners of the selections
+    /// @param[in] maxGap number of pixels between the regions still read together
+    /// @return array with pixels for each region, in the order of the regions
+    virtual std::vector<casacore::Array<T> > readMany(const std::string &name, const std::vector<PixelRegion> &regions,
+                                                      size_t maxGap = 0) const;
+
     /// @brief Determine whether an image has a mask
     /// @param[in] nam image name
     /// @return True if image has a mask, False if not.
@@ -100,6 +165,35 @@ struct IImageAccess {
     virtual casacore::LogicalArray readMask(const std::string &name, const casacore::IPosition &blc,
                                     const casacore::IPosition &trc) const = 0;
 
+    /// @brief read the mask for part of the image into the given buffer
+    /// @details The buffer is only resized if its shape doesn't match the selection.
+    /// The default implementation copies the result of readMask into the buffer.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with mask values - 1=good, 0=bad
+    virtual void readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                              const casacore::IPosition &trc, casacore::LogicalArray &buffer) const;
+
+    /// @brief read the mask for part of the image with one bit per pixel
+    /// @details The default implementation reads the mask plane by plane through readMaskInto,
+    /// so only a single plane is held with one byte per pixel.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return packed mask for the selection (set bit = good pixel)
+    virtual PackedMask readPackedMask(const std::string &name, const casacore::IPosition &blc,
+                                      const casacore::IPosition &trc) const;
+
+    /// @brief obtain the summary of the mask of an image plane
+    /// @details Planes are spanned by the first two axes and numbered in the Fortran order of the
+    /// remaining axes (see PackedMask). The default implementation reads the mask of the plane,
+    /// implementations may cache the result.
+    /// @param[in] name image name
+    /// @param[in] plane plane number
+    /// @return PackedMask::ALL_VALID, PackedMask::ALL_MASKED or PackedMask::PARTIAL
+    virtual PackedMask::PlaneState maskPlaneState(const std::string &name, size_t plane) const;
+
 
     /// @brief obtain coordinate system info
     /// @param[in] name image name
@@ -121,6 +215,15 @@ struct IImageAccess {
     /// @return beam info list
     virtual BeamList beamList(const std::string &name) const = 0;
 
+    /// @brief obtain the restoring beam of a single channel
+    /// @details This avoids copying the whole beam list when the beams are needed
+    /// channel by channel. The single beam is returned if the image has no beam list.
+    /// @param[in] name image name
+    /// @param[in] chan channel number
+    /// @return beam info vector
+    virtual casacore::Vector<casacore::Quantum<double> > channelBeam(const std::string &name,
+                                                                     unsigned int chan) const;
+
     /// @brief obtain pixel units
     /// @param[in] name image name
     /// @return units string
@@ -133,6 +236,16 @@ struct IImageAccess {
     /// @return pair of strings - keyword value and comment
     virtual std::pair<std::string, std::string> getMetadataKeyword(const std::string &name, const std::string &keyword) const = 0;
 
+    /// @brief obtain a snapshot of the image metadata
+    /// @details The shape, coordinates, units, beams, header keywords and mask presence are
+    /// collected in one pass. The accessors cache the snapshot and serve the individual
+    /// getters from it, so it is cheap to call repeatedly. The default implementation
+    /// calls the getters and leaves the keyword map empty, as keywords can't be listed
+    /// through this interface.
+    /// @param[in] name image name
+    /// @return shared pointer to the snapshot
+    virtual boost::shared_ptr<const ImageMetadata> metadata(const std::string &name) const;
+
     /// @brief this method reads the table(s) in the image and stores it to the casacore::Record
     /// @param[in] name image name
     /// @param[in] tblName  table name. tbleName = "All" gets all the tables in the image file.
@@ -175,6 +288,18 @@ struct IImageAccess {
     virtual void write(const std::string &name, const casacore::Array<T> &arr,
                        const casacore::Array<bool> &mask, const casacore::IPosition &where) = 0;
 
+    /// @brief add pixels to a slice of an image
+    /// @details This is the read-modify-write step of the accumulation into a shared output
+    /// image (e.g. mosaicking). The region is locked with ImageRegionLock for the duration of
+    /// the update, so processes adding into overlapping regions of the same image wait for
+    /// each other while the updates of disjoint regions proceed in parallel. The lock file
+    /// is opened on the first call and kept open. The pixels are simply added, the mask
+    /// is not changed. The sums are passed to the statistics (see setStatistics) as written.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels to add
+    /// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+    virtual void addInto(const std::string &name, const casacore::Array<T> &arr, const casacore::IPosition &where);
+
     /// @brief write a slice of an image pixel mask
     /// @param[in] name image name
     /// @param[in] mask array with mask
@@ -241,6 +366,109 @@ struct IImageAccess {
     /// @param[in] info - record to be written to the table.
     virtual void setInfo(const std::string &name, const casacore::RecordInterface & info) = 0;
 
+    /// @brief start a batch of header updates
+    /// @details Implementations may stage the units, beam, keywords, history and info tables
+    /// set until commitHeaderUpdate and write them together. This is much faster if many
+    /// keywords are set. By default, the changes are written straight away.
+    /// @param[in] name image name
+    virtual void beginHeaderUpdate(const std::string &name);
+
+    /// @brief write the header changes staged since beginHeaderUpdate
+    /// @param[in] name image name
+    virtual void commitHeaderUpdate(const std::string &name);
+
+    /// @brief derive the coordinate system of part of an image
+    /// @details The reference pixel is shifted to the bottom left corner of the selection,
+    /// which gives the same result as the coordinates of casacore::SubImage with unit
+    /// stride and all axes kept, without setting up the subimage.
+    /// @param[in] csys coordinate system of the full image
+    /// @param[in] shape shape of the full image
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @return coordinate system of the selection
+    static casacore::CoordinateSystem sliceCoordSys(const casacore::CoordinateSystem &csys,
+                                                    const casacore::IPosition &shape,
+                                                    const casacore::IPosition &blc, const casacore::IPosition &trc);
+
+    /// @brief accumulate statistics of the pixels written
+    /// @details All pixels passed to the write methods (including the collective writes of
+    /// FitsImageAccessParallel) are added to the given accumulator until it is reset with an
+    /// empty pointer. It is up to the caller to combine the statistics across ranks and to
+    /// store them, see ImageStatistics.
+    /// @param[in] stats accumulator, an empty pointer switches the accumulation off
+    void setStatistics(const boost::shared_ptr<ImageStatistics> &stats);
+
+    /// @return accumulator of the statistics of the pixels written, empty if not set
+    inline const boost::shared_ptr<ImageStatistics>& statistics() const { return itsStatistics; }
+
+    /// @brief set the allocation policy for the pixel arrays
+    /// @details Arrays returned by read and buffers resized by readInto are allocated with the
+    /// given policy (see ArrayAllocator), e.g. bound to the NUMA node of the thread using them.
+    /// The strided and averaged reads always use the global heap.
+    /// @param[in] allocator shared pointer to the allocator, empty pointer means the global heap (default)
+    void setArrayAllocator(const boost::shared_ptr<ArrayAllocator const> &allocator);
+
+    /// @return allocation policy for the pixel arrays, empty for the global heap
+    inline const boost::shared_ptr<ArrayAllocator const>& arrayAllocator() const { return itsArrayAllocator; }
+
+protected:
+    /// @brief drop the pixels cached for the given image
+    /// @details This is called by addInto after the region is locked, so the changes done by
+    /// other processes are seen by the read which follows. Nothing is done by default.
+    /// @param[in] name image name
+    virtual void refreshPixels(const std::string &name) const;
+
+    /// @brief write the pixels buffered for the given image to disk
+    /// @details This is called by addInto before the region is unlocked, so other processes
+    /// see the update. Nothing is done by default.
+    /// @param[in] name image name
+    virtual void syncPixels(const std::string &name) const;
+
+    /// @brief obtain the region lock of the given image
+    /// @details The lock file is opened on the first call and kept open.
+    /// @param[in] name image name
+    /// @return reference to the lock (valid for the lifetime of this object)
+    ImageRegionLock& regionLock(const std::string &name);
+
+    /// @brief select a plane of the given block
+    /// @param[in] blc bottom left corner of the block
+    /// @param[in] trc top right corner of the block
+    /// @param[in] plane plane number within the block (see PackedMask)
+    /// @param[out] planeBlc bottom left corner of the plane
+    /// @param[out] planeTrc top right corner of the plane
+    static void planeSelection(const casacore::IPosition &blc, const casacore::IPosition &trc, size_t plane,
+                               casacore::IPosition &planeBlc, casacore::IPosition &planeTrc);
+
+    /// @brief add written pixels to the statistics
+    /// @details Nothing is done if the statistics are not accumulated (see setStatistics).
+    /// @param[in] arr pixels written
+    /// @param[in] where bottom left corner of the block written
+    void accumulateStatistics(const casacore::Array<T> &arr, const casacore::IPosition &where) const;
+
+    /// @brief add written pixels to the statistics
+    /// @details Nothing is done if the statistics are not accumulated (see setStatistics).
+    /// @param[in] arr pixels written
+    /// @param[in] mask mask written (true for good pixels)
+    /// @param[in] where bottom left corner of the block written
+    void accumulateStatistics(const casacore::Array<T> &arr, const casacore::Array<bool> &mask,
+                              const casacore::IPosition &where) const;
+
+    /// @brief resize the buffer for the pixels read
+    /// @details The allocation policy given by setArrayAllocator is used. Nothing is done if
+    /// the buffer already has the required shape.
+    /// @param[in] buffer array to resize
+    /// @param[in] shape required shape
+    void resizeBuffer(casacore::Array<T> &buffer, const casacore::IPosition &shape) const;
+
+private:
+    /// @brief accumulator of the statistics of the pixels written, empty if not used
+    boost::shared_ptr<ImageStatistics> itsStatistics;
+
+    /// @brief lock files used by addInto, opened on demand
+    std::map<std::string, boost::shared_ptr<ImageRegionLock> > itsRegionLocks;
+
+    /// @brief allocation policy for the pixel arrays, empty for the global heap
+    boost::shared_ptr<ArrayAllocator const> itsArrayAllocator;
 };
 
 } // namespace accessors
@@ -32,6 +32,14 @@
 ///
 
 #include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/ImageStatistics.h>
+#include <askap/imageaccess/ImageRegionLock.h>
+#include <askap/askap/AskapError.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicMath/Math.h>
+
+#include <algorithm>
+#include <vector>
 
 namespace askap {
 
@@ -41,6 +49,424 @@ namespace accessors {
 template <class T>
 IImageAccess<T>::~IImageAccess<T>() {}
 
+/// @brief read part of the image into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection, so
+/// the same buffer can be reused to read an image piece by piece. The default
+/// implementation copies the result of read into the buffer.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with pixels for the selection
+template <class T>
+void IImageAccess<T>::readInto(const std::string &name, const casacore::IPosition &blc,
+                               const casacore::IPosition &trc, casacore::Array<T> &buffer) const
+{
+    const casacore::Array<T> result = read(name, blc, trc);
+    if (!buffer.shape().isEqual(result.shape())) {
+        buffer.resize(result.shape());
+    }
+    buffer = result;
+}
+
+/// @brief read every stride-th pixel of part of the image
+/// @details The default implementation reads the whole selection and decimates it.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[in] stride increment along each axis (1 to take all pixels)
+/// @return array with (trc - blc) / stride + 1 pixels along each axis
+template <class T>
+casacore::Array<T> IImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+                                         const casacore::IPosition &trc, const casacore::IPosition &stride) const
+{
+    ASKAPCHECK((stride.nelements() == blc.nelements()) && (trc.nelements() == blc.nelements()),
+               "Stride " << stride << " doesn't match the selection from " << blc << " to " << trc);
+    ASKAPCHECK(casacore::allGT(stride, 0), "Stride should be positive, you have " << stride);
+    casacore::Array<T> full = read(name, blc, trc);
+    if (casacore::allEQ(stride, 1)) {
+        return full;
+    }
+    return full(casacore::IPosition(blc.nelements(), 0), full.shape() - 1, stride).copy();
+}
+
+/// @brief read part of the image averaged in blocks
+/// @details The selection is read in slabs of factor pixels along the last axis.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[in] factor block size along each axis (1 to keep the resolution)
+/// @return array with ceil((trc - blc + 1) / factor) pixels along each axis
+template <class T>
+casacore::Array<T> IImageAccess<T>::readAveraged(const std::string &name, const casacore::IPosition &blc,
+                                                 const casacore::IPosition &trc, const casacore::IPosition &factor) const
+{
+    const casacore::uInt ndim = blc.nelements();
+    ASKAPCHECK((ndim > 0) && (factor.nelements() == ndim) && (trc.nelements() == ndim),
+               "Averaging factor " << factor << " doesn't match the selection from " << blc << " to " << trc);
+    ASKAPCHECK(casacore::allGT(factor, 0), "Averaging factor should be positive, you have " << factor);
+    casacore::IPosition outShape(ndim);
+    std::vector<size_t> outStride(ndim);
+    size_t nOut = 1;
+    for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+         ASKAPCHECK(trc[axis] >= blc[axis], "Empty selection from " << blc << " to " << trc);
+         outShape[axis] = (trc[axis] - blc[axis] + factor[axis]) / factor[axis];
+         outStride[axis] = nOut;
+         nOut *= outShape[axis];
+    }
+    std::vector<double> sums(nOut, 0.);
+    std::vector<size_t> counts(nOut, 0);
+    const casacore::uInt last = ndim - 1;
+    casacore::IPosition slabBlc(blc);
+    casacore::IPosition slabTrc(trc);
+    for (ssize_t slab = 0; slab < outShape[last]; ++slab) {
+         slabBlc[last] = blc[last] + slab * factor[last];
+         slabTrc[last] = std::min(slabBlc[last] + factor[last] - 1, trc[last]);
+         const casacore::Array<T> pixels = read(name, slabBlc, slabTrc);
+         const size_t slabOffset = slab * outStride[last];
+         casacore::IPosition pos(ndim, 0);
+         for (typename casacore::Array<T>::const_iterator ci = pixels.begin(); ci != pixels.end(); ++ci) {
+              if (!casacore::isNaN(*ci)) {
+                  size_t index = slabOffset;
+                  for (casacore::uInt axis = 0; axis < last; ++axis) {
+                       index += (pos[axis] / factor[axis]) * outStride[axis];
+                  }
+                  sums[index] += *ci;
+                  ++counts[index];
+              }
+              // next position in the Fortran order
+              for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+                   if (++pos[axis] < pixels.shape()[axis]) {
+                       break;
+                   }
+                   pos[axis] = 0;
+              }
+         }
+    }
+    casacore::Array<T> result(outShape);
+    size_t index = 0;
+    for (typename casacore::Array<T>::iterator it = result.begin(); it != result.end(); ++it, ++index) {
+         if (counts[index] > 0) {
+             *it = static_cast<T>(sums[index] / counts[index]);
+         } else {
+             casacore::setNaN(*it);
+         }
+    }
+    return result;
+}
+
+/// @brief obtain the restoring beam of a single channel
+/// @details The default implementation looks the beam up in the metadata snapshot.
+/// @param[in] name image name
+/// @param[in] chan channel number
+/// @return beam info vector
+template <class T>
+casacore::Vector<casacore::Quantum<double> > IImageAccess<T>::channelBeam(const std::string &name,
+                                                                          unsigned int chan) const
+{
+    return metadata(name)->beam(chan);
+}
+
+/// @brief obtain a snapshot of the image metadata
+/// @details The default implementation calls the getters, the keyword map is left empty.
+/// @param[in] name image name
+/// @return shared pointer to the snapshot
+template <class T>
+boost::shared_ptr<const ImageMetadata> IImageAccess<T>::metadata(const std::string &name) const
+{
+    boost::shared_ptr<ImageMetadata> result(new ImageMetadata);
+    result->itsShape = shape(name);
+    result->itsCoordSys = coordSys(name);
+    result->itsUnits = getUnits(name);
+    result->itsBeam = beamInfo(name);
+    result->itsBeamList = beamList(name);
+    result->itsMasked = isMasked(name);
+    return result;
+}
+
+/// @brief read part of the image into the given memory
+/// @details This is a wrapper around readInto for data not held by a casacore array.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] data pointer to the memory for (trc - blc + 1).product() pixels (Fortran order)
+template <class T>
+void IImageAccess<T>::readIntoStorage(const std::string &name, const casacore::IPosition &blc,
+                                      const casacore::IPosition &trc, T *data) const
+{
+    ASKAPASSERT(data != nullptr);
+    const casacore::IPosition shape(trc - blc + 1);
+    casacore::Array<T> buffer(shape, data, casacore::SHARE);
+    readInto(name, blc, trc, buffer);
+    if (buffer.data() != data) {
+        // the implementation has replaced the storage, copy the pixels over
+        casacore::Array<T> target(shape, data, casacore::SHARE);
+        target = buffer;
+    }
+}
+
+/// @brief read many parts of the image
+/// @details Overlapping and adjacent regions (or those within maxGap pixels) are merged into
+/// larger reads (see RegionCoalescer), which are done one by one in the storage order.
+/// @param[in] name image name
+/// @param[in] regions bottom left and top right corners of the selections
+/// @param[in] maxGap number of pixels between the regions still read together
+/// @return array with pixels for each region, in the order of the regions
+template <class T>
+std::vector<casacore::Array<T> > IImageAccess<T>::readMany(const std::string &name,
+                                 const std::vector<PixelRegion> &regions, size_t maxGap) const
+{
+    const std::vector<RegionCoalescer::Read> reads = RegionCoalescer::coalesce(regions, maxGap);
+    std::vector<casacore::Array<T> > result(regions.size());
+    for (std::vector<RegionCoalescer::Read>::const_iterator ci = reads.begin(); ci != reads.end(); ++ci) {
+         // each read gets its own array, as a single region keeps a reference to it
+         RegionCoalescer::scatter(*ci, read(name, ci->itsRegion.first, ci->itsRegion.second), regions, result);
+    }
+    return result;
+}
+
+/// @brief read the mask for part of the image into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// The default implementation copies the result of readMask into the buffer.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with mask values - 1=good, 0=bad
+template <class T>
+void IImageAccess<T>::readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                                   const casacore::IPosition &trc, casacore::LogicalArray &buffer) const
+{
+    const casacore::LogicalArray result = readMask(name, blc, trc);
+    if (!buffer.shape().isEqual(result.shape())) {
+        buffer.resize(result.shape());
+    }
+    buffer = result;
+}
+
+/// @brief read the mask for part of the image with one bit per pixel
+/// @details The default implementation reads the mask plane by plane through readMaskInto,
+/// so only a single plane is held with one byte per pixel.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return packed mask for the selection (set bit = good pixel)
+template <class T>
+PackedMask IImageAccess<T>::readPackedMask(const std::string &name, const casacore::IPosition &blc,
+                                           const casacore::IPosition &trc) const
+{
+    PackedMask result(trc - blc + 1, true);
+    if (!isMasked(name)) {
+        return result;
+    }
+    const size_t planeSize = result.planeSize();
+    casacore::IPosition planeBlc, planeTrc;
+    casacore::LogicalArray buffer;
+    for (size_t plane = 0; plane < result.nPlanes(); ++plane) {
+         planeSelection(blc, trc, plane, planeBlc, planeTrc);
+         readMaskInto(name, planeBlc, planeTrc, buffer);
+         bool deleteIt = false;
+         const bool *values = buffer.getStorage(deleteIt);
+         result.pack(plane * planeSize, values, planeSize);
+         buffer.freeStorage(values, deleteIt);
+    }
+    return result;
+}
+
+/// @brief obtain the summary of the mask of an image plane
+/// @details The default implementation reads the mask of the plane.
+/// @param[in] name image name
+/// @param[in] plane plane number
+/// @return PackedMask::ALL_VALID, PackedMask::ALL_MASKED or PackedMask::PARTIAL
+template <class T>
+PackedMask::PlaneState IImageAccess<T>::maskPlaneState(const std::string &name, size_t plane) const
+{
+    if (!isMasked(name)) {
+        return PackedMask::ALL_VALID;
+    }
+    const casacore::IPosition imageShape = shape(name);
+    casacore::IPosition planeBlc, planeTrc;
+    planeSelection(casacore::IPosition(imageShape.nelements(), 0), imageShape - 1, plane, planeBlc, planeTrc);
+    casacore::LogicalArray buffer;
+    readMaskInto(name, planeBlc, planeTrc, buffer);
+    bool deleteIt = false;
+    const bool *values = buffer.getStorage(deleteIt);
+    const PackedMask::PlaneState state = PackedMask::summary(values, buffer.nelements());
+    buffer.freeStorage(values, deleteIt);
+    return state;
+}
+
+/// @brief select a plane of the given block
+/// @param[in] blc bottom left corner of the block
+/// @param[in] trc top right corner of the block
+/// @param[in] plane plane number within the block (see PackedMask)
+/// @param[out] planeBlc bottom left corner of the plane
+/// @param[out] planeTrc top right corner of the plane
+template <class T>
+void IImageAccess<T>::planeSelection(const casacore::IPosition &blc, const casacore::IPosition &trc, size_t plane,
+                                     casacore::IPosition &planeBlc, casacore::IPosition &planeTrc)
+{
+    ASKAPDEBUGASSERT(blc.nelements() == trc.nelements());
+    planeBlc = blc;
+    planeTrc = trc;
+    size_t rest = plane;
+    for (casacore::uInt axis = 2; axis < blc.nelements(); ++axis) {
+         const size_t length = trc[axis] - blc[axis] + 1;
+         planeBlc[axis] = planeTrc[axis] = blc[axis] + rest % length;
+         rest /= length;
+    }
+    ASKAPCHECK(rest == 0, "Plane " << plane << " is outside the selection from " << blc << " to " << trc);
+}
+
+/// @brief derive the coordinate system of part of an image
+/// @details The reference pixel is shifted to the bottom left corner of the selection,
+/// which gives the same result as the coordinates of casacore::SubImage with unit
+/// stride and all axes kept, without setting up the subimage.
+/// @param[in] csys coordinate system of the full image
+/// @param[in] shape shape of the full image
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return coordinate system of the selection
+template <class T>
+casacore::CoordinateSystem IImageAccess<T>::sliceCoordSys(const casacore::CoordinateSystem &csys,
+                                                          const casacore::IPosition &shape,
+                                                          const casacore::IPosition &blc, const casacore::IPosition &trc)
+{
+    const casacore::uInt nAxes = csys.nPixelAxes();
+    ASKAPCHECK((blc.nelements() == nAxes) && (trc.nelements() == nAxes) && (shape.nelements() == nAxes),
+               "Selection from " << blc << " to " << trc << " doesn't match the " << nAxes <<
+               "-dimensional coordinate system");
+    casacore::Vector<casacore::Float> originShift(nAxes);
+    casacore::Vector<casacore::Float> incrFac(nAxes, 1.f);
+    casacore::Vector<casacore::Int> newShape(nAxes);
+    for (casacore::uInt axis = 0; axis < nAxes; ++axis) {
+         ASKAPCHECK((blc[axis] >= 0) && (blc[axis] <= trc[axis]) && (trc[axis] < shape[axis]),
+                    "Selection from " << blc << " to " << trc << " is outside the image of shape " << shape);
+         originShift[axis] = static_cast<casacore::Float>(blc[axis]);
+         newShape[axis] = static_cast<casacore::Int>(trc[axis] - blc[axis] + 1);
+    }
+    return csys.subImage(originShift, incrFac, newShape);
+}
+
+/// @brief accumulate statistics of the pixels written
+/// @details All pixels passed to the write methods (including the collective writes of
+/// FitsImageAccessParallel) are added to the given accumulator until it is reset with an
+/// empty pointer. It is up to the caller to combine the statistics across ranks and to
+/// store them, see ImageStatistics.
+/// @param[in] stats accumulator, an empty pointer switches the accumulation off
+template <class T>
+void IImageAccess<T>::setStatistics(const boost::shared_ptr<ImageStatistics> &stats)
+{
+    itsStatistics = stats;
+}
+
+/// @brief set the allocation policy for the pixel arrays
+/// @details Arrays returned by read and buffers resized by readInto are allocated with the
+/// given policy.
+/// @param[in] allocator shared pointer to the allocator, empty pointer means the global heap (default)
+template <class T>
+void IImageAccess<T>::setArrayAllocator(const boost::shared_ptr<ArrayAllocator const> &allocator)
+{
+    itsArrayAllocator = allocator;
+}
+
+/// @brief resize the buffer for the pixels read
+/// @details The allocation policy given by setArrayAllocator is used. Nothing is done if
+/// the buffer already has the required shape.
+/// @param[in] buffer array to resize
+/// @param[in] shape required shape
+template <class T>
+void IImageAccess<T>::resizeBuffer(casacore::Array<T> &buffer, const casacore::IPosition &shape) const
+{
+    if (itsArrayAllocator) {
+        itsArrayAllocator->resize(buffer, shape);
+    } else if (!buffer.shape().isEqual(shape)) {
+        buffer.resize(shape);
+    }
+}
+
+/// @brief add written pixels to the statistics
+/// @details Nothing is done if the statistics are not accumulated (see setStatistics).
+/// @param[in] arr pixels written
+/// @param[in] where bottom left corner of the block written
+template <class T>
+void IImageAccess<T>::accumulateStatistics(const casacore::Array<T> &arr, const casacore::IPosition &where) const
+{
+    if (itsStatistics) {
+        itsStatistics->add(arr, where);
+    }
+}
+
+/// @brief add written pixels to the statistics
+/// @details Nothing is done if the statistics are not accumulated (see setStatistics).
+/// @param[in] arr pixels written
+/// @param[in] mask mask written (true for good pixels)
+/// @param[in] where bottom left corner of the block written
+template <class T>
+void IImageAccess<T>::accumulateStatistics(const casacore::Array<T> &arr, const casacore::Array<bool> &mask,
+                                           const casacore::IPosition &where) const
+{
+    if (itsStatistics) {
+        itsStatistics->add(arr, mask, where);
+    }
+}
+
+/// @brief start a batch of header updates
+/// @details This does nothing by default, the changes are written straight away.
+/// @param[in] name image name
+template <class T>
+void IImageAccess<T>::beginHeaderUpdate(const std::string &) {}
+
+/// @brief write the header changes staged since beginHeaderUpdate
+/// @details This does nothing by default, the changes are written straight away.
+/// @param[in] name image name
+template <class T>
+void IImageAccess<T>::commitHeaderUpdate(const std::string &) {}
+
+/// @brief add pixels to a slice of an image
+/// @details The region is locked, read, updated and written back. Other processes
+/// adding into an overlapping region wait until the lock is released.
+/// @param[in] name image name
+/// @param[in] arr array with pixels to add
+/// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+template <class T>
+void IImageAccess<T>::addInto(const std::string &name, const casacore::Array<T> &arr,
+                              const casacore::IPosition &where)
+{
+    const casacore::IPosition trc = where + arr.shape() - 1;
+    const ImageRegionLock::Guard guard(regionLock(name), shape(name), where, trc);
+    refreshPixels(name);
+    casacore::Array<T> buffer(arr.shape());
+    readInto(name, where, trc, buffer);
+    buffer += arr;
+    write(name, buffer, where);
+    syncPixels(name);
+}
+
+/// @brief obtain the region lock of the given image
+/// @details The lock file is opened on the first call and kept open.
+/// @param[in] name image name
+/// @return reference to the lock (valid for the lifetime of this object)
+template <class T>
+ImageRegionLock& IImageAccess<T>::regionLock(const std::string &name)
+{
+    boost::shared_ptr<ImageRegionLock> &lock = itsRegionLocks[name];
+    if (!lock) {
+        lock.reset(new ImageRegionLock(ImageRegionLock::lockFileName(name)));
+    }
+    return *lock;
+}
+
+/// @brief drop the pixels cached for the given image
+/// @details Nothing is done by default.
+/// @param[in] name image name
+template <class T>
+void IImageAccess<T>::refreshPixels(const std::string &) const {}
+
+/// @brief write the pixels buffered for the given image to disk
+/// @details Nothing is done by default.
+/// @param[in] name image name
+template <class T>
+void IImageAccess<T>::syncPixels(const std::string &) const {}
+
 } // namespace accessors
 
 } // namespace askap
@@ -31,16 +31,97 @@
 
 #include <askap/imageaccess/ImageAccessFactory.h>
 #include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/CasaImageAccessParallel.h>
 #include <askap/imageaccess/FitsImageAccess.h>
 #include <askap/imageaccess/FitsImageAccessParallel.h>
+#include <askap/imageaccess/Hdf5ImageAccess.h>
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap/imageaccess/StagedImageAccess.h>
+#include <askap/imageaccess/WriteCombiningImageAccess.h>
 
 #include <askap/askap/AskapError.h>
 
 #include <string>
+#include <vector>
 
 using namespace askap;
 using namespace askap::accessors;
 
+namespace {
+
+/// @brief set the data type of new FITS images from the parset
+/// @details imagebitpix gives BITPIX (-32 by default, -64 for double precision, 16 or 32 for quantised
+/// integer images),
+/// imagedatarange optionally gives the minimum and maximum pixel values mapped onto the integers.
+/// @param[in] accessor FITS accessor to set up
+/// @param[in] parset parameters
+void setFitsBitpix(FitsImageAccess &accessor, const LOFAR::ParameterSet &parset)
+{
+   const int bitpix = parset.getInt("imagebitpix", -32);
+   ASKAPCHECK((bitpix == -32) || (bitpix == -64) || (bitpix == 16) || (bitpix == 32), "Unsupported imagebitpix = " <<
+              bitpix << ", use -32, -64, 16 or 32");
+   const std::vector<float> range = parset.getFloatVector("imagedatarange", std::vector<float>());
+   ASKAPCHECK(range.empty() || (range.size() == 2), "imagedatarange should have 2 elements: minimum and maximum");
+   if (range.size() == 2) {
+       accessor.setBitpix(bitpix, range[0], range[1]);
+   } else {
+       accessor.setBitpix(bitpix);
+   }
+}
+
+/// @brief set up the store of memory images from the parset
+/// @details imagememorybudget gives the memory budget in MB and imagespilldir the directory
+/// for images spilled to disk when the budget is exceeded. Both settings are shared by all
+/// memory image accessors in the process, they are only changed if given in the parset.
+/// @param[in] accessor memory accessor to set up
+/// @param[in] parset parameters
+void setupMemoryImages(MemoryImageAccess<casacore::Float> &accessor, const LOFAR::ParameterSet &parset)
+{
+   if (parset.isDefined("imagememorybudget")) {
+       accessor.setMemoryBudget(size_t(parset.getUint("imagememorybudget")) * 1024u * 1024u);
+   }
+   if (parset.isDefined("imagespilldir")) {
+       accessor.setSpillDirectory(parset.getString("imagespilldir"));
+   }
+}
+
+/// @brief wrap the accessor to stage the images, if requested in the parset
+/// @details imagestaging.dir gives the directory on fast local storage for the images written,
+/// imagestaging.maxdrains gives the number of images copied to the final destination at the
+/// same time (2 by default). The accessor is returned unchanged if the directory is not given.
+/// @param[in] accessor accessor set up from the parset
+/// @param[in] parset parameters
+/// @return accessor to use
+boost::shared_ptr<IImageAccess<casacore::Float> > setupStaging(const boost::shared_ptr<IImageAccess<casacore::Float> > &accessor,
+                                                               const LOFAR::ParameterSet &parset)
+{
+   const std::string stagingDir = parset.getString("imagestaging.dir", "");
+   if (stagingDir.empty()) {
+       return accessor;
+   }
+   return boost::shared_ptr<IImageAccess<casacore::Float> >(new StagedImageAccess<casacore::Float>(accessor,
+              stagingDir, parset.getUint("imagestaging.maxdrains", 2)));
+}
+
+/// @brief wrap the accessor to combine the slices written into large blocks, if requested in the parset
+/// @details imagewritebuffer gives the size of the block buffered for each image in MB
+/// (see WriteCombiningImageAccess). The accessor is returned unchanged if it is zero (default).
+/// @param[in] accessor accessor set up from the parset
+/// @param[in] parset parameters
+/// @return accessor to use
+boost::shared_ptr<IImageAccess<casacore::Float> > setupWriteCombining(const boost::shared_ptr<IImageAccess<casacore::Float> > &accessor,
+                                                                      const LOFAR::ParameterSet &parset)
+{
+   const size_t bufferSize = parset.getUint("imagewritebuffer", 0);
+   if (bufferSize == 0) {
+       return accessor;
+   }
+   return boost::shared_ptr<IImageAccess<casacore::Float> >(new WriteCombiningImageAccess<casacore::Float>(accessor,
+              bufferSize * 1024 * 1024 / sizeof(casacore::Float)));
+}
+
+} // anonymous namespace
+
 /// @brief Build an appropriate image access class
 /// @details This is a factory method generating a shared pointer to the image
 /// accessor from the parset file
@@ -53,18 +134,59 @@ boost::shared_ptr<IImageAccess<casacore::Float> > askap::accessors::imageAccessF
 
    boost::shared_ptr<IImageAccess<> > result;
    if (imageType == "casa") {
-       boost::shared_ptr<CasaImageAccess<casacore::Float> > iaCASA(new CasaImageAccess<casacore::Float>());
-       // optional parameter setting may come here
+       const std::string locking = parset.getString("imagelocking", "auto");
+       ASKAPCHECK((locking == "auto") || (locking == "user") || (locking == "permanent"),
+                  "Unsupported imagelocking = " << locking << ", use auto, user or permanent");
+       const casacore::TableLock::LockOption lockOption = (locking == "user" ? casacore::TableLock::UserLocking :
+                  (locking == "permanent" ? casacore::TableLock::PermanentLocking : casacore::TableLock::AutoLocking));
+       boost::shared_ptr<CasaImageAccess<casacore::Float> > iaCASA(new CasaImageAccess<casacore::Float>(lockOption,
+                  parset.getUint("imagecachesize", 8)));
+       const std::string pattern = parset.getString("imageaccesspattern", "balanced");
+       ASKAPCHECK((pattern == "balanced") || (pattern == "plane") || (pattern == "spectrum"),
+                  "Unsupported imageaccesspattern = " << pattern << ", use balanced, plane or spectrum");
+       iaCASA->setAccessPattern(pattern == "plane" ? CasaImageAccess<casacore::Float>::PLANE_MAJOR :
+                  (pattern == "spectrum" ? CasaImageAccess<casacore::Float>::SPECTRUM_MAJOR :
+                   CasaImageAccess<casacore::Float>::BALANCED));
+       const std::vector<int> tile = parset.getIntVector("imagetileshape", std::vector<int>());
+       casacore::IPosition tileShape(tile.size());
+       for (size_t axis = 0; axis < tile.size(); ++axis) {
+            tileShape[axis] = tile[axis];
+       }
+       iaCASA->setTileShape(tileShape);
+       // the tile cache is given in MB
+       iaCASA->setMaximumCacheSize(parset.getUint("imagetilecache", 0) * 1024u * 1024u / sizeof(casacore::Float));
+       iaCASA->useFastAlloc(parset.getString("imagealloc","fast") == "fast");
        result = iaCASA;
+   } else if (imageType == "hdf5") {
+       boost::shared_ptr<Hdf5ImageAccess<casacore::Float> > iaHDF5(new Hdf5ImageAccess<casacore::Float>());
+       const std::vector<int> chunk = parset.getIntVector("imagechunkshape", std::vector<int>());
+       casacore::IPosition chunkShape(chunk.size());
+       for (size_t axis = 0; axis < chunk.size(); ++axis) {
+            chunkShape[axis] = chunk[axis];
+       }
+       iaHDF5->setChunkShape(chunkShape);
+       result = iaHDF5;
+   } else if (imageType == "memory") {
+       boost::shared_ptr<MemoryImageAccess<casacore::Float> > iaMemory(new MemoryImageAccess<casacore::Float>());
+       setupMemoryImages(*iaMemory, parset);
+       result = iaMemory;
    } else if (imageType == "fits"){
        boost::shared_ptr<FitsImageAccess> iaFITS(new FitsImageAccess());
        const bool fast = (parset.getString("imagealloc","fast") == "fast");
        iaFITS->useFastAlloc(fast);
+       iaFITS->reserveKeywords(parset.getUint("imagereservedkeywords",0));
+       iaFITS->setCompression(FitsCompression::fromParset(parset));
+       iaFITS->useMemoryMap(parset.getBool("imagememorymap", true));
+       iaFITS->useIncrementalChecksum(parset.getBool("imageincrementalchecksum", false));
+       setFitsBitpix(*iaFITS, parset);
        result = iaFITS;
   } else {
       throw AskapError(std::string("Unsupported image type ")+imageType+" has been requested");
    }
-   return result;
+   result->setArrayAllocator(ArrayAllocator::create(parset.getString("imagearrayalloc", "heap")));
+   ASKAPCHECK(imageType != "memory" || !parset.isDefined("imagestaging.dir"),
+              "Memory images can't be staged, remove imagestaging.dir from the parset");
+   return setupStaging(setupWriteCombining(result, parset), parset);
 
 }/// @brief Build an appropriate image access class
 /// @details This is a factory method generating a shared pointer to the image
@@ -78,28 +200,92 @@ boost::shared_ptr<IImageAccess<casacore::Float> > askap::accessors::imageAccessF
 {
    const std::string imageType = parset.getString("imagetype","casa");
    const std::string imageAccessType = parset.getString("imageaccess","individual");
-   ASKAPCHECK(imageType!="casa" || imageAccessType=="individual","Collective I/O not supported for imagetype casa")
+   ASKAPCHECK(imageType=="fits" || imageType=="casa" || imageAccessType=="individual",
+              "Collective I/O not supported for imagetype "<<imageType)
 
    boost::shared_ptr<IImageAccess<> > result;
    if (imageType == "casa") {
-       boost::shared_ptr<CasaImageAccess<casacore::Float> > iaCASA(new CasaImageAccess<casacore::Float>());
-       // optional parameter setting may come here
+       boost::shared_ptr<CasaImageAccess<casacore::Float> > iaCASA;
+       if (imageAccessType == "collective") {
+           // the ranks coordinate through createCollective/closeCollective rather than table locks
+           ASKAPCHECK(!parset.isDefined("imagelocking"), "imagelocking can't be used with collective CASA image access");
+           iaCASA.reset(new CasaImageAccessParallel<casacore::Float>(comms, parset.getInt("imageaccess.axis", -1),
+                        parset.getUint("imagecachesize", 8)));
+       } else {
+           const std::string locking = parset.getString("imagelocking", "auto");
+           ASKAPCHECK((locking == "auto") || (locking == "user") || (locking == "permanent"),
+                      "Unsupported imagelocking = " << locking << ", use auto, user or permanent");
+           const casacore::TableLock::LockOption lockOption = (locking == "user" ? casacore::TableLock::UserLocking :
+                      (locking == "permanent" ? casacore::TableLock::PermanentLocking : casacore::TableLock::AutoLocking));
+           iaCASA.reset(new CasaImageAccess<casacore::Float>(lockOption, parset.getUint("imagecachesize", 8)));
+       }
+       const std::string pattern = parset.getString("imageaccesspattern", "balanced");
+       ASKAPCHECK((pattern == "balanced") || (pattern == "plane") || (pattern == "spectrum"),
+                  "Unsupported imageaccesspattern = " << pattern << ", use balanced, plane or spectrum");
+       iaCASA->setAccessPattern(pattern == "plane" ? CasaImageAccess<casacore::Float>::PLANE_MAJOR :
+                  (pattern == "spectrum" ? CasaImageAccess<casacore::Float>::SPECTRUM_MAJOR :
+                   CasaImageAccess<casacore::Float>::BALANCED));
+       const std::vector<int> tile = parset.getIntVector("imagetileshape", std::vector<int>());
+       casacore::IPosition tileShape(tile.size());
+       for (size_t axis = 0; axis < tile.size(); ++axis) {
+            tileShape[axis] = tile[axis];
+       }
+       iaCASA->setTileShape(tileShape);
+       // the tile cache is given in MB
+       iaCASA->setMaximumCacheSize(parset.getUint("imagetilecache", 0) * 1024u * 1024u / sizeof(casacore::Float));
+       iaCASA->useFastAlloc(parset.getString("imagealloc","fast") == "fast");
        result = iaCASA;
+   } else if (imageType == "hdf5") {
+       boost::shared_ptr<Hdf5ImageAccess<casacore::Float> > iaHDF5(new Hdf5ImageAccess<casacore::Float>());
+       const std::vector<int> chunk = parset.getIntVector("imagechunkshape", std::vector<int>());
+       casacore::IPosition chunkShape(chunk.size());
+       for (size_t axis = 0; axis < chunk.size(); ++axis) {
+            chunkShape[axis] = chunk[axis];
+       }
+       iaHDF5->setChunkShape(chunkShape);
+       result = iaHDF5;
+   } else if (imageType == "memory") {
+       boost::shared_ptr<MemoryImageAccess<casacore::Float> > iaMemory(new MemoryImageAccess<casacore::Float>());
+       setupMemoryImages(*iaMemory, parset);
+       result = iaMemory;
    } else if (imageType == "fits"){
        const bool fast = (parset.getString("imagealloc","fast") == "fast");
        if (imageAccessType == "collective") {
            uint axis = parset.getUint("imageaccess.axis",0);
            boost::shared_ptr<FitsImageAccessParallel> iaFITS(new FitsImageAccessParallel(comms,axis));
            iaFITS->useFastAlloc(fast);
+           iaFITS->reserveKeywords(parset.getUint("imagereservedkeywords",0));
+           // MPI-IO hints, e.g. imageaccess.hints.cb_nodes or imageaccess.hints.striping_factor
+           const LOFAR::ParameterSet hintsParset = parset.makeSubset("imageaccess.hints.");
+           std::map<std::string, std::string> hints;
+           for (LOFAR::ParameterSet::const_iterator ci = hintsParset.begin(); ci != hintsParset.end(); ++ci) {
+                hints[ci->first] = hintsParset.getString(ci->first);
+           }
+           iaFITS->setHints(hints);
+           iaFITS->useIncrementalChecksum(parset.getBool("imageincrementalchecksum", false));
+           // collective writes go to the file directly, bypassing cfitsio
+           ASKAPCHECK(!FitsCompression::fromParset(parset).enabled(),
+                      "Compressed FITS images are not supported with collective image access");
            result = iaFITS;
        } else {
            boost::shared_ptr<FitsImageAccess> iaFITS(new FitsImageAccess());
            iaFITS->useFastAlloc(fast);
+           iaFITS->reserveKeywords(parset.getUint("imagereservedkeywords",0));
+           iaFITS->setCompression(FitsCompression::fromParset(parset));
+           iaFITS->useMemoryMap(parset.getBool("imagememorymap", true));
+           iaFITS->useIncrementalChecksum(parset.getBool("imageincrementalchecksum", false));
+           setFitsBitpix(*iaFITS, parset);
            result = iaFITS;
        }
    }
    else {
       throw AskapError(std::string("Unsupported image type ")+imageType+" has been requested");
    }
-   return result;
+   result->setArrayAllocator(ArrayAllocator::create(parset.getString("imagearrayalloc", "heap")));
+   ASKAPCHECK(imageType != "memory" || !parset.isDefined("imagestaging.dir"),
+              "Memory images can't be staged, remove imagestaging.dir from the parset");
+   // node-local staging would split the file written collectively by several ranks
+   ASKAPCHECK(imageAccessType != "collective" || !parset.isDefined("imagestaging.dir"),
+              "Staging is not supported with collective image access");
+   return setupStaging(setupWriteCombining(result, parset), parset);
 }
@@ -46,7 +46,12 @@ namespace accessors {
 /// accessor from the parset file
 /// @param[in] parset parameters containing description of image accessor to be constructed
 /// @return shared pointer to the image access object
-/// @note CASA images are used by default
+/// @note CASA images are used by default, imagetype=memory keeps the images in memory (see
+/// MemoryImageAccess). The imagearrayalloc parameter selects the allocation
+/// policy for the pixel arrays read (heap, hugepages or numa, see ArrayAllocator::create).
+/// If imagestaging.dir is given, the images are written there and copied to their final
+/// destination in the background (see StagedImageAccess). A non-zero imagewritebuffer (in MB)
+/// combines the slices written into large blocks (see WriteCombiningImageAccess).
 boost::shared_ptr<IImageAccess< casacore::Float > > imageAccessFactory(const LOFAR::ParameterSet &parset);
 
 /// @brief Build an appropriate image access class
@@ -55,7 +60,15 @@ boost::shared_ptr<IImageAccess< casacore::Float > > imageAccessFactory(const LOF
 /// @param[in] parset parameters containing description of image accessor to be constructed
 /// @param[in] comms, MPI communicator, needed for parallel I/O
 /// @return shared pointer to the image access object
-/// @note CASA images are used by default
+/// @note CASA images are used by default, imagetype=memory keeps the images in memory (see
+/// MemoryImageAccess). The imagearrayalloc parameter selects the allocation
+/// policy for the pixel arrays read (heap, hugepages or numa, see ArrayAllocator::create).
+/// If imagestaging.dir is given, the images are written there and copied to their final
+/// destination in the background (see StagedImageAccess). A non-zero imagewritebuffer (in MB)
+/// combines the slices written into large blocks (see WriteCombiningImageAccess). With imageaccess=collective,
+/// FITS images are written with MPI-IO (see FitsImageAccessParallel) and CASA images by
+/// all ranks at once after a collective creation (see CasaImageAccessParallel), the
+/// distribution axis is given by imageaccess.axis.
 boost::shared_ptr<IImageAccess< casacore::Float > > imageAccessFactory(const LOFAR::ParameterSet &parset,
                                                                        askapparallel::AskapParallel &comms);
 
@@ -0,0 +1,167 @@
+/// @file ImageCursor.h
+/// @brief Iterate over an image piece by piece
+/// @details This class steps a cursor (e.g. a plane, a spectrum or a tile) through
+/// the image and reads the data into a reusable buffer, optionally reading the next
+/// piece in the background while the current one is processed.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_CURSOR_H
+#define ASKAP_ACCESSORS_IMAGE_CURSOR_H
+
+#include <askap/imageaccess/IImageAccess.h>
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <exception>
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Iterate over an image piece by piece
+/// @details The cursor shape defines the piece of the image read at each step, the
+/// cursor moves through the image along the first axis first (pieces at the edges of
+/// the image may be smaller). The data are read with IImageAccess::readInto, so the
+/// memory used doesn't depend on the image size. With prefetching enabled, the next
+/// piece is read by a background thread while the caller processes the current one.
+/// The accessor and the image should not be used by anything else while the
+/// prefetch is in progress (i.e. between the calls to next).
+/// @code
+///   ImageCursor<float> cursor(accessor, name, ImageCursor<float>::planeShape(accessor.shape(name)));
+///   casacore::Array<float> plane;
+///   while (cursor.next(plane)) {
+///      // process plane read at cursor.blc()
+///   }
+/// @endcode
+/// @ingroup imageaccess
+template <class T = casacore::Float>
+class ImageCursor : public boost::noncopyable {
+public:
+    /// @brief set up the cursor
+    /// @param[in] accessor image accessor to read data with
+    /// @param[in] name image name
+    /// @param[in] cursorShape shape of the piece read at each step (clipped to the image shape)
+    /// @param[in] prefetch if true, the next piece is read in the background
+    ImageCursor(const IImageAccess<T> &accessor, const std::string &name,
+                const casacore::IPosition &cursorShape, bool prefetch = true);
+
+    /// @brief destructor, waits for the prefetch to finish
+    ~ImageCursor();
+
+    /// @return true if there are more pieces to read
+    inline bool hasMore() const { return itsHasNext; }
+
+    /// @brief read the next piece and advance the cursor
+    /// @details The buffer is resized only if the shape of the piece differs. With prefetch,
+    /// the storage of the buffer is exchanged with the internal buffer holding the prefetched
+    /// data if the buffer is not referenced elsewhere, otherwise the data are copied.
+    /// @param[in,out] buffer array to fill with pixels
+    /// @return false if there are no more pieces (the buffer is not changed)
+    bool next(casacore::Array<T> &buffer);
+
+    /// @return bottom left corner of the piece returned by the last call to next
+    inline const casacore::IPosition& blc() const { return itsBlc; }
+
+    /// @return top right corner of the piece returned by the last call to next
+    casacore::IPosition trc() const;
+
+    /// @return cursor shape
+    inline const casacore::IPosition& cursorShape() const { return itsCursorShape; }
+
+    /// @brief cursor shape to iterate over spatial planes
+    /// @param[in] imageShape image shape
+    /// @return cursor shape covering the first two axes
+    static casacore::IPosition planeShape(const casacore::IPosition &imageShape);
+
+    /// @brief cursor shape to iterate over spectra
+    /// @param[in] imageShape image shape
+    /// @param[in] specAxis spectral axis (the last axis by default)
+    /// @return cursor shape covering the spectral axis
+    static casacore::IPosition spectrumShape(const casacore::IPosition &imageShape, int specAxis = -1);
+
+private:
+    /// @brief top right corner for the given bottom left corner
+    /// @param[in] blc bottom left corner of a piece
+    /// @return top right corner of the piece (clipped to the image shape)
+    casacore::IPosition trc(const casacore::IPosition &blc) const;
+
+    /// @brief move the given position to the next piece
+    /// @param[in,out] pos bottom left corner of a piece
+    /// @return false if the end of the image is reached
+    bool advance(casacore::IPosition &pos) const;
+
+    /// @brief start reading the next piece in the background
+    void startPrefetch();
+
+    /// @brief wait for the background read to finish, rethrows its error if any
+    void waitPrefetch();
+
+    /// @brief accessor to read data with
+    const IImageAccess<T> &itsAccessor;
+
+    /// @brief image name
+    std::string itsName;
+
+    /// @brief image shape
+    casacore::IPosition itsShape;
+
+    /// @brief cursor shape
+    casacore::IPosition itsCursorShape;
+
+    /// @brief bottom left corner of the piece returned by next
+    casacore::IPosition itsBlc;
+
+    /// @brief bottom left corner of the piece to read next
+    casacore::IPosition itsNextBlc;
+
+    /// @brief true if there are more pieces to read
+    bool itsHasNext;
+
+    /// @brief true if the next piece is read in the background
+    bool itsPrefetch;
+
+    /// @brief buffer for the prefetched piece
+    casacore::Array<T> itsPrefetchBuffer;
+
+    /// @brief background thread reading the next piece
+    boost::shared_ptr<boost::thread> itsThread;
+
+    /// @brief error encountered by the background thread, if any
+    std::exception_ptr itsError;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#include <askap/imageaccess/ImageCursor.tcc>
+
+#endif // #ifndef ASKAP_ACCESSORS_IMAGE_CURSOR_H
@@ -0,0 +1,209 @@
+/// @file ImageCursor.tcc
+/// @brief Iterate over an image piece by piece
+/// @details This class steps a cursor (e.g. a plane, a spectrum or a tile) through
+/// the image and reads the data into a reusable buffer.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/imageaccess/ImageCursor.h>
+#include <askap/askap/AskapError.h>
+
+namespace askap {
+namespace accessors {
+
+/// @brief set up the cursor
+/// @param[in] accessor image accessor to read data with
+/// @param[in] name image name
+/// @param[in] cursorShape shape of the piece read at each step (clipped to the image shape)
+/// @param[in] prefetch if true, the next piece is read in the background
+template <class T>
+ImageCursor<T>::ImageCursor(const IImageAccess<T> &accessor, const std::string &name,
+                            const casacore::IPosition &cursorShape, bool prefetch) :
+    itsAccessor(accessor), itsName(name), itsShape(accessor.shape(name)), itsCursorShape(cursorShape),
+    itsHasNext(false), itsPrefetch(prefetch)
+{
+    ASKAPCHECK(itsCursorShape.nelements() == itsShape.nelements(), "Cursor shape " << itsCursorShape <<
+               " doesn't match the shape " << itsShape << " of the image " << name);
+    for (casacore::uInt dim = 0; dim < itsShape.nelements(); ++dim) {
+         ASKAPCHECK(itsCursorShape(dim) > 0, "Cursor shape " << itsCursorShape << " should be positive along all axes");
+         if (itsCursorShape(dim) > itsShape(dim)) {
+             itsCursorShape(dim) = itsShape(dim);
+         }
+    }
+    itsNextBlc = casacore::IPosition(itsShape.nelements(), 0);
+    itsHasNext = itsShape.product() > 0;
+    if (itsPrefetch && itsHasNext) {
+        startPrefetch();
+    }
+}
+
+/// @brief destructor, waits for the prefetch to finish
+template <class T>
+ImageCursor<T>::~ImageCursor()
+{
+    if (itsThread) {
+        itsThread->join();
+    }
+}
+
+/// @brief read the next piece and advance the cursor
+/// @details The buffer is resized only if the shape of the piece differs. With prefetch,
+/// the storage of the buffer is exchanged with the internal buffer holding the prefetched
+/// data if the buffer is not referenced elsewhere, otherwise the data are copied.
+/// @param[in,out] buffer array to fill with pixels
+/// @return false if there are no more pieces (the buffer is not changed)
+template <class T>
+bool ImageCursor<T>::next(casacore::Array<T> &buffer)
+{
+    if (!itsHasNext) {
+        return false;
+    }
+    if (itsPrefetch) {
+        waitPrefetch();
+        if ((buffer.nrefs() <= 1) && buffer.contiguousStorage()) {
+            // exchange the storage, the old buffer is reused for the next piece
+            casacore::Array<T> tmp;
+            tmp.reference(buffer);
+            buffer.reference(itsPrefetchBuffer);
+            itsPrefetchBuffer.reference(tmp);
+        } else {
+            if (!buffer.shape().isEqual(itsPrefetchBuffer.shape())) {
+                buffer.resize(itsPrefetchBuffer.shape());
+            }
+            buffer = itsPrefetchBuffer;
+        }
+    } else {
+        itsAccessor.readInto(itsName, itsNextBlc, trc(itsNextBlc), buffer);
+    }
+    itsBlc = itsNextBlc;
+    itsHasNext = advance(itsNextBlc);
+    if (itsPrefetch && itsHasNext) {
+        startPrefetch();
+    }
+    return true;
+}
+
+/// @return top right corner of the piece returned by the last call to next
+template <class T>
+casacore::IPosition ImageCursor<T>::trc() const
+{
+    ASKAPCHECK(itsBlc.nelements() == itsShape.nelements(), "next should be called before trc");
+    return trc(itsBlc);
+}
+
+/// @brief cursor shape to iterate over spatial planes
+/// @param[in] imageShape image shape
+/// @return cursor shape covering the first two axes
+template <class T>
+casacore::IPosition ImageCursor<T>::planeShape(const casacore::IPosition &imageShape)
+{
+    casacore::IPosition result(imageShape.nelements(), 1);
+    for (casacore::uInt dim = 0; (dim < 2) && (dim < imageShape.nelements()); ++dim) {
+         result(dim) = imageShape(dim);
+    }
+    return result;
+}
+
+/// @brief cursor shape to iterate over spectra
+/// @param[in] imageShape image shape
+/// @param[in] specAxis spectral axis (the last axis by default)
+/// @return cursor shape covering the spectral axis
+template <class T>
+casacore::IPosition ImageCursor<T>::spectrumShape(const casacore::IPosition &imageShape, int specAxis)
+{
+    const int axis = specAxis < 0 ? static_cast<int>(imageShape.nelements()) - 1 : specAxis;
+    ASKAPCHECK((axis >= 0) && (axis < static_cast<int>(imageShape.nelements())), "Spectral axis " << specAxis <<
+               " is outside the image with the shape " << imageShape);
+    casacore::IPosition result(imageShape.nelements(), 1);
+    result(axis) = imageShape(axis);
+    return result;
+}
+
+/// @brief top right corner for the given bottom left corner
+/// @param[in] blc bottom left corner of a piece
+/// @return top right corner of the piece (clipped to the image shape)
+template <class T>
+casacore::IPosition ImageCursor<T>::trc(const casacore::IPosition &blc) const
+{
+    casacore::IPosition result(blc + itsCursorShape - 1);
+    for (casacore::uInt dim = 0; dim < result.nelements(); ++dim) {
+         if (result(dim) >= itsShape(dim)) {
+             result(dim) = itsShape(dim) - 1;
+         }
+    }
+    return result;
+}
+
+/// @brief move the given position to the next piece
+/// @param[in,out] pos bottom left corner of a piece
+/// @return false if the end of the image is reached
+template <class T>
+bool ImageCursor<T>::advance(casacore::IPosition &pos) const
+{
+    for (casacore::uInt dim = 0; dim < pos.nelements(); ++dim) {
+         pos(dim) += itsCursorShape(dim);
+         if (pos(dim) < itsShape(dim)) {
+             return true;
+         }
+         pos(dim) = 0;
+    }
+    return false;
+}
+
+/// @brief start reading the next piece in the background
+template <class T>
+void ImageCursor<T>::startPrefetch()
+{
+    ASKAPDEBUGASSERT(!itsThread);
+    const casacore::IPosition blc(itsNextBlc);
+    const casacore::IPosition trc(this->trc(itsNextBlc));
+    itsThread.reset(new boost::thread([this, blc, trc]() {
+        try {
+           itsAccessor.readInto(itsName, blc, trc, itsPrefetchBuffer);
+        }
+        catch (...) {
+           itsError = std::current_exception();
+        }
+    }));
+}
+
+/// @brief wait for the background read to finish, rethrows its error if any
+template <class T>
+void ImageCursor<T>::waitPrefetch()
+{
+    ASKAPDEBUGASSERT(itsThread);
+    itsThread->join();
+    itsThread.reset();
+    if (itsError) {
+        std::exception_ptr error = itsError;
+        itsError = nullptr;
+        itsHasNext = false;
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace accessors
+} // namespace askap
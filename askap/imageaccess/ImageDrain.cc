@@ -0,0 +1,503 @@
+/// @file ImageDrain.cc
+/// @brief Background transfer of staged images to their final destination
+/// @details Images written to fast node-local storage (e.g. NVMe or a burst buffer) are
+/// copied to the final destination in the background, see StagedImageAccess.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#include <askap_accessors.h>
+
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/imageaccess/ImageDrain.h>
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/crc.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ASKAP_LOGGER(logger, ".ImageDrain");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief size of the buffer used to copy files
+const size_t theCopyBufferSize = 4u * 1024u * 1024u;
+
+/// @brief obtain the directory part of the path
+/// @param[in] path file name
+/// @return directory name, "." if the path has no directory part
+std::string directoryOf(const std::string &path)
+{
+    const size_t pos = path.rfind('/');
+    if (pos == std::string::npos) {
+        return ".";
+    }
+    return pos == 0 ? std::string("/") : path.substr(0, pos);
+}
+
+/// @brief obtain the file part of the path
+/// @param[in] path file name
+/// @return file name without the directory
+std::string baseOf(const std::string &path)
+{
+    const size_t pos = path.rfind('/');
+    return pos == std::string::npos ? path : path.substr(pos + 1);
+}
+
+/// @brief list the entries of a directory
+/// @param[in] dir directory name
+/// @return names of the entries except "." and ".."
+std::vector<std::string> listDirectory(const std::string &dir)
+{
+    DIR *handle = ::opendir(dir.c_str());
+    ASKAPCHECK(handle != 0, "Unable to read the directory " << dir << ": " << std::strerror(errno));
+    std::vector<std::string> result;
+    for (struct dirent *entry = ::readdir(handle); entry != 0; entry = ::readdir(handle)) {
+        const std::string entryName(entry->d_name);
+        if ((entryName != ".") && (entryName != "..")) {
+            result.push_back(entryName);
+        }
+    }
+    ::closedir(handle);
+    return result;
+}
+
+/// @brief flush the directory entries to disk
+/// @details Some file systems don't support fsync for directories, this is ignored.
+/// @param[in] dir directory name
+void syncDirectory(const std::string &dir)
+{
+    const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    ASKAPCHECK(fd >= 0, "Unable to open the directory " << dir << ": " << std::strerror(errno));
+    const int status = ::fsync(fd);
+    const int error = errno;
+    ::close(fd);
+    ASKAPCHECK((status == 0) || (error == EINVAL), "Unable to sync the directory " << dir << ": " <<
+               std::strerror(error));
+}
+
+/// @brief read data from the file
+/// @details Interrupted calls are repeated.
+/// @param[in] fd file descriptor
+/// @param[in] buf buffer to fill
+/// @param[in] size size of the buffer
+/// @param[in] fileName file name for the error message
+/// @return number of bytes read, 0 at the end of the file
+size_t readChunk(int fd, char *buf, size_t size, const std::string &fileName)
+{
+    ssize_t nRead = ::read(fd, buf, size);
+    while ((nRead < 0) && (errno == EINTR)) {
+        nRead = ::read(fd, buf, size);
+    }
+    ASKAPCHECK(nRead >= 0, "Unable to read " << fileName << ": " << std::strerror(errno));
+    return size_t(nRead);
+}
+
+/// @brief compute the checksum of a file
+/// @param[in] fileName file name
+/// @param[out] size size of the file in bytes
+/// @return CRC-32 of the file contents
+boost::crc_32_type::value_type fileChecksum(const std::string &fileName, size_t &size)
+{
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    ASKAPCHECK(fd >= 0, "Unable to open " << fileName << ": " << std::strerror(errno));
+    std::vector<char> buf(theCopyBufferSize);
+    boost::crc_32_type crc;
+    size = 0;
+    try {
+        for (size_t nRead = readChunk(fd, buf.data(), buf.size(), fileName); nRead > 0;
+             nRead = readChunk(fd, buf.data(), buf.size(), fileName)) {
+            crc.process_bytes(buf.data(), nRead);
+            size += nRead;
+        }
+    }
+    catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+    return crc.checksum();
+}
+
+/// @brief copy a regular file and verify the copy
+/// @details The copy is synced to disk and read back before it is compared with the source.
+/// @param[in] from source file
+/// @param[in] to destination file, shouldn't exist
+/// @param[in] mode permissions of the destination
+/// @return number of bytes copied
+size_t copyFile(const std::string &from, const std::string &to, mode_t mode)
+{
+    const int in = ::open(from.c_str(), O_RDONLY);
+    ASKAPCHECK(in >= 0, "Unable to open " << from << ": " << std::strerror(errno));
+    const int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL, mode);
+    if (out < 0) {
+        const int error = errno;
+        ::close(in);
+        ASKAPTHROW(AskapError, "Unable to create " << to << ": " << std::strerror(error));
+    }
+    std::vector<char> buf(theCopyBufferSize);
+    boost::crc_32_type crc;
+    size_t size = 0;
+    try {
+        for (size_t nRead = readChunk(in, buf.data(), buf.size(), from); nRead > 0;
+             nRead = readChunk(in, buf.data(), buf.size(), from)) {
+            crc.process_bytes(buf.data(), nRead);
+            size += nRead;
+            for (size_t done = 0; done < nRead;) {
+                const ssize_t nWritten = ::write(out, buf.data() + done, nRead - done);
+                if ((nWritten < 0) && (errno == EINTR)) {
+                    continue;
+                }
+                ASKAPCHECK(nWritten > 0, "Unable to write " << to << ": " << std::strerror(errno));
+                done += size_t(nWritten);
+            }
+        }
+        ASKAPCHECK(::fsync(out) == 0, "Unable to sync " << to << ": " << std::strerror(errno));
+    }
+    catch (...) {
+        ::close(in);
+        ::close(out);
+        throw;
+    }
+    ::close(in);
+    ASKAPCHECK(::close(out) == 0, "Unable to close " << to << ": " << std::strerror(errno));
+
+    size_t copySize = 0;
+    const boost::crc_32_type::value_type copyCrc = fileChecksum(to, copySize);
+    ASKAPCHECK(copySize == size, "Verification of " << to << " failed: " << copySize <<
+               " bytes found, " << size << " bytes written");
+    ASKAPCHECK(copyCrc == crc.checksum(), "Verification of " << to << " failed: checksum mismatch");
+    return size;
+}
+
+} // anonymous namespace
+
+/// @brief set up the transfer
+/// @param[in] stagingDir directory for the staged images (created if necessary)
+/// @param[in] maxDrains maximum number of images transferred at the same time
+ImageDrain::ImageDrain(const std::string &stagingDir, size_t maxDrains) :
+    itsStagingDir(stagingDir), itsCounter(0), itsBytesDrained(0), itsPool(maxDrains)
+{
+    ASKAPCHECK(!itsStagingDir.empty(), "Staging directory is not defined");
+    if ((::mkdir(itsStagingDir.c_str(), 0755) != 0) && (errno != EEXIST)) {
+        ASKAPTHROW(AskapError, "Unable to create the staging directory " << itsStagingDir << ": " <<
+                   std::strerror(errno));
+    }
+    struct stat info;
+    ASKAPCHECK((::stat(itsStagingDir.c_str(), &info) == 0) && S_ISDIR(info.st_mode),
+               "Staging directory " << itsStagingDir << " is not a directory");
+}
+
+/// @brief destructor, waits for the outstanding transfers
+ImageDrain::~ImageDrain()
+{
+    if (!waitAll()) {
+        ASKAPLOG_WARN_STR(logger, "Some images failed to drain, the staged copies are kept in " << itsStagingDir);
+    }
+}
+
+/// @brief stage the image
+/// @details An image which is staged or failed to drain keeps its staged name, a new one
+/// is given otherwise. The image can't be staged while it is being drained.
+/// @param[in] name final name of the image
+/// @return name of the image in the staging directory
+std::string ImageDrain::stage(const std::string &name)
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    Image &img = itsImages[name];
+    if (!img.itsStagedName.empty()) {
+        ASKAPCHECK(img.itsState != DRAINING, "Image " << name << " is being drained and can't be staged again");
+        if (img.itsState != DURABLE) {
+            img.itsState = STAGED;
+            img.itsError.clear();
+            return img.itsStagedName;
+        }
+    }
+    std::ostringstream os;
+    os << itsStagingDir << "/" << itsCounter++ << "_" << baseOf(name);
+    img.itsState = STAGED;
+    img.itsStagedName = os.str();
+    img.itsError.clear();
+    return img.itsStagedName;
+}
+
+/// @brief obtain the name to access the image with
+/// @details The image is read from the staging directory until it is durable. If the image
+/// is being drained, reading waits for the transfer to finish and writing is an error.
+/// @param[in] name final name of the image
+/// @param[in] forWriting true if the image is going to be modified
+/// @return name of the image in the staging directory or the final name
+std::string ImageDrain::location(const std::string &name, bool forWriting) const
+{
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    const std::map<std::string, Image>::const_iterator ci = itsImages.find(name);
+    if (ci == itsImages.end()) {
+        return name;
+    }
+    ASKAPCHECK(!forWriting || (ci->second.itsState != DRAINING), "Image " << name <<
+               " is being drained to its final destination and can't be modified");
+    while (ci->second.itsState == DRAINING) {
+        itsDrainFinished.wait(lock);
+    }
+    return ci->second.itsState == DURABLE ? name : ci->second.itsStagedName;
+}
+
+/// @brief start the transfer of the image
+/// @details The image should be staged or failed to drain before.
+/// @param[in] name final name of the image
+void ImageDrain::drain(const std::string &name)
+{
+    std::string stagedName;
+    {
+        boost::lock_guard<boost::mutex> lock(itsMutex);
+        const std::map<std::string, Image>::iterator it = itsImages.find(name);
+        ASKAPCHECK((it != itsImages.end()) && ((it->second.itsState == STAGED) || (it->second.itsState == FAILED)),
+                   "Image " << name << " is not staged, unable to drain it");
+        it->second.itsState = DRAINING;
+        it->second.itsError.clear();
+        stagedName = it->second.itsStagedName;
+    }
+    itsPool.post(boost::bind(&ImageDrain::transfer, this, name, stagedName));
+}
+
+/// @return final names of the images which are staged, but not being drained
+std::vector<std::string> ImageDrain::staged() const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    std::vector<std::string> result;
+    for (std::map<std::string, Image>::const_iterator ci = itsImages.begin(); ci != itsImages.end(); ++ci) {
+        if (ci->second.itsState == STAGED) {
+            result.push_back(ci->first);
+        }
+    }
+    return result;
+}
+
+/// @brief obtain the state of the image
+/// @param[in] name final name of the image
+/// @return state of the image
+ImageDrain::State ImageDrain::state(const std::string &name) const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    const std::map<std::string, Image>::const_iterator ci = itsImages.find(name);
+    return ci == itsImages.end() ? NOT_STAGED : ci->second.itsState;
+}
+
+/// @brief obtain the reason of the failure
+/// @param[in] name final name of the image
+/// @return error message of the last transfer, empty if it hasn't failed
+std::string ImageDrain::drainError(const std::string &name) const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    const std::map<std::string, Image>::const_iterator ci = itsImages.find(name);
+    return ci == itsImages.end() ? std::string() : ci->second.itsError;
+}
+
+/// @brief wait for the transfer of the image to finish
+/// @details The method returns straight away if the image is not being drained.
+/// @param[in] name final name of the image
+/// @param[in] timeout maximum time to wait in seconds, negative value means no limit
+/// @return true, if the image is durable
+bool ImageDrain::waitDurable(const std::string &name, double timeout) const
+{
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    const std::map<std::string, Image>::const_iterator ci = itsImages.find(name);
+    if (ci == itsImages.end()) {
+        return false;
+    }
+    const boost::chrono::steady_clock::time_point deadline = boost::chrono::steady_clock::now() +
+          boost::chrono::duration_cast<boost::chrono::steady_clock::duration>(
+          boost::chrono::duration<double>(timeout < 0. ? 0. : timeout));
+    while (ci->second.itsState == DRAINING) {
+        if (timeout < 0.) {
+            itsDrainFinished.wait(lock);
+        } else if (itsDrainFinished.wait_until(lock, deadline) == boost::cv_status::timeout) {
+            break;
+        }
+    }
+    return ci->second.itsState == DURABLE;
+}
+
+/// @brief wait for all transfers to finish
+/// @return true, if none of the transfers has failed
+bool ImageDrain::waitAll() const
+{
+    boost::unique_lock<boost::mutex> lock(itsMutex);
+    bool draining = true;
+    bool failed = false;
+    while (draining) {
+        draining = false;
+        failed = false;
+        for (std::map<std::string, Image>::const_iterator ci = itsImages.begin(); ci != itsImages.end(); ++ci) {
+            draining |= (ci->second.itsState == DRAINING);
+            failed |= (ci->second.itsState == FAILED);
+        }
+        if (draining) {
+            itsDrainFinished.wait(lock);
+        }
+    }
+    return !failed;
+}
+
+/// @return number of bytes transferred and verified so far
+size_t ImageDrain::bytesDrained() const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    return itsBytesDrained;
+}
+
+/// @brief copy a file or directory verifying the copy
+/// @details Files are fsync'ed and read back to compare their CRC-32 and size with the
+/// source. An exception is thrown if the copy doesn't match.
+/// @param[in] from source file or directory
+/// @param[in] to destination, shouldn't exist
+/// @return number of bytes copied
+size_t ImageDrain::copyVerified(const std::string &from, const std::string &to)
+{
+    struct stat info;
+    ASKAPCHECK(::stat(from.c_str(), &info) == 0, "Unable to access " << from << ": " << std::strerror(errno));
+    if (!S_ISDIR(info.st_mode)) {
+        return copyFile(from, to, info.st_mode & 0777);
+    }
+    ASKAPCHECK(::mkdir(to.c_str(), info.st_mode & 0777) == 0, "Unable to create the directory " << to << ": " <<
+               std::strerror(errno));
+    size_t result = 0;
+    const std::vector<std::string> entries = listDirectory(from);
+    for (std::vector<std::string>::const_iterator ci = entries.begin(); ci != entries.end(); ++ci) {
+        result += copyVerified(from + "/" + *ci, to + "/" + *ci);
+    }
+    syncDirectory(to);
+    return result;
+}
+
+/// @brief remove a file or directory with its contents
+/// @details Nothing is done if it doesn't exist.
+/// @param[in] path file or directory to remove
+void ImageDrain::removeAll(const std::string &path)
+{
+    struct stat info;
+    if (::lstat(path.c_str(), &info) != 0) {
+        ASKAPCHECK(errno == ENOENT, "Unable to access " << path << ": " << std::strerror(errno));
+        return;
+    }
+    if (S_ISDIR(info.st_mode)) {
+        const std::vector<std::string> entries = listDirectory(path);
+        for (std::vector<std::string>::const_iterator ci = entries.begin(); ci != entries.end(); ++ci) {
+            removeAll(path + "/" + *ci);
+        }
+        ASKAPCHECK(::rmdir(path.c_str()) == 0, "Unable to remove " << path << ": " << std::strerror(errno));
+    } else {
+        ASKAPCHECK(::unlink(path.c_str()) == 0, "Unable to remove " << path << ": " << std::strerror(errno));
+    }
+}
+
+/// @brief body of the transfer task
+/// @details Errors are stored with the image, the task doesn't throw.
+/// @param[in] name final name of the image
+/// @param[in] stagedName name of the image in the staging directory
+void ImageDrain::transfer(const std::string &name, const std::string &stagedName)
+{
+    try {
+        const size_t bytes = transferEntries(name, stagedName);
+        ASKAPLOG_DEBUG_STR(logger, "Image " << name << " is durable, " << bytes << " bytes drained from " <<
+                           stagedName);
+        boost::lock_guard<boost::mutex> lock(itsMutex);
+        itsImages[name].itsState = DURABLE;
+        itsBytesDrained += bytes;
+    }
+    catch (const std::exception &ex) {
+        ASKAPLOG_WARN_STR(logger, "Failed to drain image " << name << " from " << stagedName << ": " << ex.what());
+        boost::lock_guard<boost::mutex> lock(itsMutex);
+        Image &img = itsImages[name];
+        img.itsState = FAILED;
+        img.itsError = ex.what();
+    }
+    itsDrainFinished.notify_all();
+}
+
+/// @brief transfer the staged entries to their final names
+/// @details All entries are copied to temporary names and verified first, then renamed to
+/// the final names. The staged entries are removed once all of them are in place.
+/// @param[in] name final name of the image
+/// @param[in] stagedName name of the image in the staging directory
+/// @return number of bytes transferred
+size_t ImageDrain::transferEntries(const std::string &name, const std::string &stagedName)
+{
+    const std::string stagingDir = directoryOf(stagedName);
+    const std::string base = baseOf(stagedName);
+    std::vector<std::string> suffixes;
+    const std::vector<std::string> entries = listDirectory(stagingDir);
+    for (std::vector<std::string>::const_iterator ci = entries.begin(); ci != entries.end(); ++ci) {
+        if ((*ci == base) || (ci->compare(0, base.size() + 1, base + ".") == 0)) {
+            suffixes.push_back(ci->substr(base.size()));
+        }
+    }
+    ASKAPCHECK(!suffixes.empty(), "Nothing has been written to " << stagedName);
+
+    size_t result = 0;
+    try {
+        for (std::vector<std::string>::const_iterator ci = suffixes.begin(); ci != suffixes.end(); ++ci) {
+            const std::string tmpName = name + *ci + ".draining";
+            removeAll(tmpName);
+            result += copyVerified(stagedName + *ci, tmpName);
+        }
+    }
+    catch (...) {
+        for (std::vector<std::string>::const_iterator ci = suffixes.begin(); ci != suffixes.end(); ++ci) {
+            try {
+                removeAll(name + *ci + ".draining");
+            }
+            catch (...) {
+                // the original error is more useful
+            }
+        }
+        throw;
+    }
+    for (std::vector<std::string>::const_iterator ci = suffixes.begin(); ci != suffixes.end(); ++ci) {
+        const std::string finalName = name + *ci;
+        removeAll(finalName);
+        ASKAPCHECK(::rename((finalName + ".draining").c_str(), finalName.c_str()) == 0, "Unable to rename " <<
+                   finalName << ".draining: " << std::strerror(errno));
+    }
+    syncDirectory(directoryOf(name));
+    for (std::vector<std::string>::const_iterator ci = suffixes.begin(); ci != suffixes.end(); ++ci) {
+        removeAll(stagedName + *ci);
+    }
+    return result;
+}
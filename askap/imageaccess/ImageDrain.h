@@ -0,0 +1,203 @@
+/// @file ImageDrain.h
+/// @brief Background transfer of staged images to their final destination
+/// @details Images written to fast node-local storage (e.g. NVMe or a burst buffer) are
+/// copied to the final destination in the background, see StagedImageAccess.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#ifndef ASKAP_ACCESSORS_IMAGE_DRAIN_H
+#define ASKAP_ACCESSORS_IMAGE_DRAIN_H
+
+#include <askap/dataaccess/IOThreadPool.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Background transfer of staged images to their final destination
+/// @details Each image is known by its final name and gets a unique name in the staging
+/// directory when it is staged. The image accessor creates the image under the staged name,
+/// which may be a file or a directory with extension(s) added (e.g. ".fits" or ".h5"), so
+/// all entries of the staging directory starting with the staged name are transferred.
+/// The entry with the staged name plus a suffix becomes the final name plus the same suffix.
+///
+/// At most maxDrains images are transferred at the same time, further drains are queued.
+/// Every file is copied to a temporary name next to the destination with a CRC-32 of the
+/// data computed on the way. The copy is synced to disk, read back and compared against
+/// the checksum and size of the staged file. Only when all files of the image are verified
+/// the temporary copy is renamed to the final name (an existing image is replaced) and the
+/// staged copy is removed. The image is then durable. If anything fails, the staged copy is
+/// kept and the image can be drained again.
+///
+/// The methods are thread-safe. The files are only touched by the transfer threads while
+/// the image is being drained, it is up to the caller to close the image beforehand.
+/// @ingroup imageaccess
+class ImageDrain : public boost::noncopyable {
+public:
+    /// @brief state of an image
+    enum State {
+        /// @brief the image has not been staged, it lives at its final name (if at all)
+        NOT_STAGED,
+        /// @brief the image is in the staging directory and can be modified
+        STAGED,
+        /// @brief the image is queued for the transfer or being transferred
+        DRAINING,
+        /// @brief the image is verified at its final name and the staged copy is removed
+        DURABLE,
+        /// @brief the transfer has failed, the staged copy is kept
+        FAILED
+    };
+
+    /// @brief set up the transfer
+    /// @param[in] stagingDir directory for the staged images (created if necessary)
+    /// @param[in] maxDrains maximum number of images transferred at the same time
+    ImageDrain(const std::string &stagingDir, size_t maxDrains = 2);
+
+    /// @brief destructor, waits for the outstanding transfers
+    ~ImageDrain();
+
+    /// @return directory for the staged images
+    inline const std::string& stagingDirectory() const { return itsStagingDir; }
+
+    /// @return maximum number of images transferred at the same time
+    inline size_t maxDrains() const { return itsPool.nThreads(); }
+
+    /// @brief stage the image
+    /// @details An image which is staged or failed to drain keeps its staged name, a new one
+    /// is given otherwise. The image can't be staged while it is being drained.
+    /// @param[in] name final name of the image
+    /// @return name of the image in the staging directory
+    std::string stage(const std::string &name);
+
+    /// @brief obtain the name to access the image with
+    /// @details The image is read from the staging directory until it is durable. If the image
+    /// is being drained, reading waits for the transfer to finish and writing is an error.
+    /// @param[in] name final name of the image
+    /// @param[in] forWriting true if the image is going to be modified
+    /// @return name of the image in the staging directory or the final name
+    std::string location(const std::string &name, bool forWriting) const;
+
+    /// @brief start the transfer of the image
+    /// @details The image should be staged or failed to drain before.
+    /// @param[in] name final name of the image
+    void drain(const std::string &name);
+
+    /// @return final names of the images which are staged, but not being drained
+    std::vector<std::string> staged() const;
+
+    /// @brief obtain the state of the image
+    /// @param[in] name final name of the image
+    /// @return state of the image
+    State state(const std::string &name) const;
+
+    /// @brief obtain the reason of the failure
+    /// @param[in] name final name of the image
+    /// @return error message of the last transfer, empty if it hasn't failed
+    std::string drainError(const std::string &name) const;
+
+    /// @brief wait for the transfer of the image to finish
+    /// @param[in] name final name of the image
+    /// @param[in] timeout maximum time to wait in seconds, negative value means no limit
+    /// @return true, if the image is durable
+    bool waitDurable(const std::string &name, double timeout = -1.) const;
+
+    /// @brief wait for all transfers to finish
+    /// @return true, if none of the transfers has failed
+    bool waitAll() const;
+
+    /// @return number of bytes transferred and verified so far
+    size_t bytesDrained() const;
+
+    /// @brief copy a file or directory verifying the copy
+    /// @details Files are fsync'ed and read back to compare their CRC-32 and size with the
+    /// source. An exception is thrown if the copy doesn't match.
+    /// @param[in] from source file or directory
+    /// @param[in] to destination, shouldn't exist
+    /// @return number of bytes copied
+    static size_t copyVerified(const std::string &from, const std::string &to);
+
+    /// @brief remove a file or directory with its contents
+    /// @details Nothing is done if it doesn't exist.
+    /// @param[in] path file or directory to remove
+    static void removeAll(const std::string &path);
+
+private:
+    /// @brief image known to the transfer
+    struct Image {
+        /// @brief current state
+        State itsState;
+        /// @brief name in the staging directory
+        std::string itsStagedName;
+        /// @brief error message of the last transfer
+        std::string itsError;
+    };
+
+    /// @brief body of the transfer task
+    /// @param[in] name final name of the image
+    /// @param[in] stagedName name of the image in the staging directory
+    void transfer(const std::string &name, const std::string &stagedName);
+
+    /// @brief transfer the staged entries to their final names
+    /// @param[in] name final name of the image
+    /// @param[in] stagedName name of the image in the staging directory
+    /// @return number of bytes transferred
+    static size_t transferEntries(const std::string &name, const std::string &stagedName);
+
+    /// @brief directory for the staged images
+    std::string itsStagingDir;
+
+    /// @brief images by final name
+    std::map<std::string, Image> itsImages;
+
+    /// @brief counter used to give the staged images unique names
+    size_t itsCounter;
+
+    /// @brief number of bytes transferred so far
+    size_t itsBytesDrained;
+
+    /// @brief synchronisation lock
+    mutable boost::mutex itsMutex;
+
+    /// @brief signalled when a transfer finishes
+    mutable boost::condition_variable itsDrainFinished;
+
+    /// @brief threads doing the transfers, destroyed first to complete the outstanding tasks
+    IOThreadPool itsPool;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif
@@ -0,0 +1,109 @@
+/// @file ImageMetadata.h
+/// @brief Snapshot of the image metadata
+/// @details Tools which only collect the headers (e.g. catalogues of images) used to
+/// call the individual getters of the accessor, each parsing the header again. The
+/// snapshot holds all of it after a single pass, see IImageAccess::metadata.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_METADATA_H
+#define ASKAP_ACCESSORS_IMAGE_METADATA_H
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Quanta/Quantum.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+
+#include <askap/askap/AskapError.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace askap {
+namespace accessors {
+
+/// @brief restoring beam for each channel (major axis, minor axis, position angle)
+typedef std::map<unsigned int, casacore::Vector<casacore::Quantum<double> > > BeamList;
+
+/// @brief Snapshot of the image metadata
+/// @details The accessors hand out the snapshot as a shared pointer to a constant object, so
+/// it can be kept and shared. It is not updated if the image changes, a new snapshot has to
+/// be obtained instead.
+/// @ingroup imageaccess
+struct ImageMetadata {
+    /// @brief initialise an empty snapshot
+    ImageMetadata() : itsMasked(false) {}
+
+    /// @brief obtain a keyword
+    /// @param[in] keyword name of the keyword
+    /// @return pair of strings - keyword value and comment (empty strings if the keyword is not found)
+    inline std::pair<std::string, std::string> keyword(const std::string &keyword) const
+    {
+        const std::map<std::string, std::pair<std::string, std::string> >::const_iterator ci =
+              itsKeywords.find(keyword);
+        return ci != itsKeywords.end() ? ci->second : std::pair<std::string, std::string>();
+    }
+
+    /// @brief obtain the restoring beam of a single channel
+    /// @param[in] chan channel number
+    /// @return beam of the given channel, or the single beam if there is no beam list
+    inline casacore::Vector<casacore::Quantum<double> > beam(unsigned int chan) const
+    {
+        if (itsBeamList.empty()) {
+            return itsBeam;
+        }
+        const BeamList::const_iterator ci = itsBeamList.find(chan);
+        ASKAPCHECK(ci != itsBeamList.end(), "There is no beam for channel " << chan);
+        return ci->second;
+    }
+
+    /// @brief shape of the image
+    casacore::IPosition itsShape;
+
+    /// @brief coordinate system of the image
+    casacore::CoordinateSystem itsCoordSys;
+
+    /// @brief pixel units
+    std::string itsUnits;
+
+    /// @brief single restoring beam, as returned by IImageAccess::beamInfo
+    casacore::Vector<casacore::Quantum<double> > itsBeam;
+
+    /// @brief restoring beams per channel, empty if the image has a single beam
+    BeamList itsBeamList;
+
+    /// @brief keywords of the header (value and comment) by name
+    std::map<std::string, std::pair<std::string, std::string> > itsKeywords;
+
+    /// @brief true, if the image has a mask
+    bool itsMasked;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // ASKAP_ACCESSORS_IMAGE_METADATA_H
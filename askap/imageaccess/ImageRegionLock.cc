@@ -0,0 +1,127 @@
+/// @file ImageRegionLock.cc
+/// @brief Lock on a region of an image shared by several processes
+/// @details The region is mapped onto a range of bytes of the lock file, which is
+/// locked with fcntl.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/askap/AskapError.h>
+#include <askap/imageaccess/ImageRegionLock.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief open the lock file
+/// @param[in] fileName name of the lock file
+ImageRegionLock::ImageRegionLock(const std::string &fileName) : itsFileName(fileName), itsFd(-1),
+    itsLocked(false), itsStart(0), itsLength(0)
+{
+    itsFd = ::open(itsFileName.c_str(), O_RDWR | O_CREAT, 0666);
+    ASKAPCHECK(itsFd >= 0, "Unable to open the lock file " << itsFileName << ": " << std::strerror(errno));
+}
+
+/// @brief destructor, releases the lock and closes the file
+ImageRegionLock::~ImageRegionLock()
+{
+    if (itsLocked) {
+        try {
+            unlock();
+        }
+        catch (...) {
+            // closing the file releases the lock anyway
+        }
+    }
+    ::close(itsFd);
+}
+
+/// @brief lock the given region
+/// @details The call blocks until the region can be locked.
+/// @param[in] shape shape of the image
+/// @param[in] blc bottom left corner of the region
+/// @param[in] trc top right corner of the region (inclusive)
+void ImageRegionLock::lock(const casacore::IPosition &shape, const casacore::IPosition &blc,
+                           const casacore::IPosition &trc)
+{
+    ASKAPCHECK(!itsLocked, "A region is already locked through " << itsFileName);
+    ASKAPCHECK((blc.nelements() == shape.nelements()) && (trc.nelements() == shape.nelements()),
+               "Region from " << blc << " to " << trc << " doesn't match the image shape " << shape);
+    long long first = 0;
+    long long last = 0;
+    long long stride = 1;
+    for (size_t axis = 0; axis < shape.nelements(); ++axis) {
+         ASKAPCHECK((blc[axis] >= 0) && (blc[axis] <= trc[axis]) && (trc[axis] < shape[axis]),
+                    "Region from " << blc << " to " << trc << " is outside the image of the shape " << shape);
+         first += blc[axis] * stride;
+         last += trc[axis] * stride;
+         stride *= shape[axis];
+    }
+    itsStart = first;
+    itsLength = last - first + 1;
+    setLock(F_WRLCK);
+    itsLocked = true;
+}
+
+/// @brief release the lock
+/// @details Nothing is done if no region is locked.
+void ImageRegionLock::unlock()
+{
+    if (itsLocked) {
+        itsLocked = false;
+        setLock(F_UNLCK);
+    }
+}
+
+/// @brief lock file used for the given image
+/// @param[in] name image name as passed to the accessor
+/// @return the image name with the ".lock" suffix
+std::string ImageRegionLock::lockFileName(const std::string &name)
+{
+    return name + ".lock";
+}
+
+/// @brief set or release the record lock
+/// @param[in] type F_WRLCK or F_UNLCK
+void ImageRegionLock::setLock(short type)
+{
+    struct flock fl;
+    std::memset(&fl, 0, sizeof(fl));
+    fl.l_type = type;
+    fl.l_whence = SEEK_SET;
+    fl.l_start = static_cast<off_t>(itsStart);
+    fl.l_len = static_cast<off_t>(itsLength);
+    int status;
+    // waiting for the lock can be interrupted by a signal
+    while (((status = fcntl(itsFd, F_SETLKW, &fl)) != 0) && (errno == EINTR)) {}
+    ASKAPCHECK(status == 0, "Unable to " << (type == F_UNLCK ? "release" : "set") << " the lock on " <<
+               itsFileName << ": " << std::strerror(errno));
+}
@@ -0,0 +1,126 @@
+/// @file ImageRegionLock.h
+/// @brief Lock on a region of an image shared by several processes
+/// @details Accumulation into an output image (e.g. mosaicking) is a read-modify-write
+/// of the region covered by the input. This class serialises such updates between
+/// processes with POSIX advisory record locks on a lock file kept next to the image,
+/// so only the updates of overlapping regions have to wait for each other.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_REGION_LOCK_H
+#define ASKAP_ACCESSORS_IMAGE_REGION_LOCK_H
+
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <string>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Lock on a region of an image shared by several processes
+/// @details The lock file is opened (and created if necessary) once and kept open, every
+/// lock call is then a single fcntl call. A region is represented by the range of linear
+/// (Fortran order) pixel indices from its bottom left to its top right corner. Such ranges
+/// of overlapping regions always overlap, although some disjoint regions wait for each other
+/// too. The lock file itself stays empty. The locks are not exclusive between threads of the
+/// same process, and only one region can be locked at a time by this object.
+/// @ingroup imageaccess
+class ImageRegionLock : public boost::noncopyable {
+public:
+    /// @brief open the lock file
+    /// @param[in] fileName name of the lock file
+    explicit ImageRegionLock(const std::string &fileName);
+
+    /// @brief destructor, releases the lock and closes the file
+    ~ImageRegionLock();
+
+    /// @brief lock the given region
+    /// @details The call blocks until the region can be locked.
+    /// @param[in] shape shape of the image
+    /// @param[in] blc bottom left corner of the region
+    /// @param[in] trc top right corner of the region (inclusive)
+    void lock(const casacore::IPosition &shape, const casacore::IPosition &blc, const casacore::IPosition &trc);
+
+    /// @brief release the lock
+    /// @details Nothing is done if no region is locked.
+    void unlock();
+
+    /// @return true if a region is locked
+    inline bool isLocked() const { return itsLocked; }
+
+    /// @return name of the lock file
+    inline const std::string& fileName() const { return itsFileName; }
+
+    /// @brief lock file used for the given image
+    /// @param[in] name image name as passed to the accessor
+    /// @return the image name with the ".lock" suffix
+    static std::string lockFileName(const std::string &name);
+
+    /// @brief release the lock when going out of scope
+    class Guard : public boost::noncopyable {
+    public:
+        /// @brief lock the given region
+        /// @param[in] lock lock to use
+        /// @param[in] shape shape of the image
+        /// @param[in] blc bottom left corner of the region
+        /// @param[in] trc top right corner of the region (inclusive)
+        Guard(ImageRegionLock &lock, const casacore::IPosition &shape, const casacore::IPosition &blc,
+              const casacore::IPosition &trc) : itsLock(lock) { itsLock.lock(shape, blc, trc); }
+
+        /// @brief destructor, releases the lock
+        ~Guard() { itsLock.unlock(); }
+    private:
+        /// @brief lock held
+        ImageRegionLock &itsLock;
+    };
+
+private:
+    /// @brief set or release the record lock
+    /// @param[in] type F_WRLCK or F_UNLCK
+    void setLock(short type);
+
+    /// @brief name of the lock file
+    std::string itsFileName;
+
+    /// @brief file descriptor of the lock file
+    int itsFd;
+
+    /// @brief true if a region is locked
+    bool itsLocked;
+
+    /// @brief first linear index of the locked region
+    long long itsStart;
+
+    /// @brief number of linear indices covered by the locked region
+    long long itsLength;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // ASKAP_ACCESSORS_IMAGE_REGION_LOCK_H
@@ -0,0 +1,337 @@
+/// @file ImageStatistics.cc
+/// @brief Statistics of the image accumulated as it is written
+/// @details The moments are accumulated per plane as the pixels are written and can be
+/// combined across ranks.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/imageaccess/ImageStatistics.h>
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/askap/AskapError.h>
+
+#include <casacore/casa/Arrays/Vector.h>
+
+#include <Common/ParameterSet.h>
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief value of a header keyword in the form expected by IImageAccess::setMetadataKeywords
+/// @param[in] value keyword value
+/// @param[in] desc keyword description
+/// @return string with the vector of the value, description and type
+std::string doubleKeyword(double value, const std::string &desc)
+{
+    std::ostringstream os;
+    os << "[" << std::setprecision(std::numeric_limits<double>::max_digits10) << value << ", \"" << desc << "\", DOUBLE]";
+    return os.str();
+}
+
+} // anonymous namespace
+
+/// @brief empty set
+ImageMoments::ImageMoments() : itsCount(0), itsSum(0.), itsSumSq(0.),
+    itsMin(std::numeric_limits<float>::quiet_NaN()), itsMax(std::numeric_limits<float>::quiet_NaN()) {}
+
+/// @brief add another set
+/// @param[in] other moments to add
+void ImageMoments::merge(const ImageMoments &other)
+{
+    if (other.itsCount == 0) {
+        return;
+    }
+    if (itsCount == 0) {
+        *this = other;
+        return;
+    }
+    itsCount += other.itsCount;
+    itsSum += other.itsSum;
+    itsSumSq += other.itsSumSq;
+    itsMin = std::min(itsMin, other.itsMin);
+    itsMax = std::max(itsMax, other.itsMax);
+}
+
+/// @return mean value, NaN if there are no pixels
+double ImageMoments::mean() const
+{
+    return itsCount > 0 ? itsSum / itsCount : std::numeric_limits<double>::quiet_NaN();
+}
+
+/// @return root mean square of the values, NaN if there are no pixels
+double ImageMoments::rms() const
+{
+    return itsCount > 0 ? std::sqrt(itsSumSq / itsCount) : std::numeric_limits<double>::quiet_NaN();
+}
+
+/// @return standard deviation (with respect to the mean), NaN if there are no pixels
+double ImageMoments::stddev() const
+{
+    if (itsCount == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const double avg = mean();
+    // rounding errors may give a small negative variance for constant images
+    return std::sqrt(std::max(itsSumSq / itsCount - avg * avg, 0.));
+}
+
+/// @brief set up the accumulator
+/// @param[in] shape shape of the image which is going to be written
+ImageStatistics::ImageStatistics(const casacore::IPosition &shape) : itsShape(shape)
+{
+    const casacore::uInt ndim = itsShape.nelements();
+    size_t nPlanes = 1;
+    for (casacore::uInt axis = 2; axis < ndim; ++axis) {
+         nPlanes *= itsShape[axis];
+    }
+    itsPlanes.resize(nPlanes);
+}
+
+/// @brief reset all moments
+void ImageStatistics::reset()
+{
+    itsPlanes.assign(itsPlanes.size(), ImageMoments());
+}
+
+/// @brief add a block of pixels
+/// @param[in] arr pixels (trailing degenerate axes may be omitted)
+/// @param[in] where bottom left corner of the block
+void ImageStatistics::add(const casacore::Array<float> &arr, const casacore::IPosition &where)
+{
+    accumulate(arr, nullptr, where);
+}
+
+/// @brief add a block of pixels with a mask
+/// @param[in] arr pixels (trailing degenerate axes may be omitted)
+/// @param[in] mask mask of the same shape (true for good pixels)
+/// @param[in] where bottom left corner of the block
+void ImageStatistics::add(const casacore::Array<float> &arr, const casacore::Array<bool> &mask,
+                          const casacore::IPosition &where)
+{
+    ASKAPCHECK(mask.nelements() == arr.nelements(), "Mask with the shape " << mask.shape() <<
+               " doesn't match the pixels with the shape " << arr.shape());
+    bool deleteIt = false;
+    const bool *maskData = mask.getStorage(deleteIt);
+    accumulate(arr, maskData, where);
+    mask.freeStorage(maskData, deleteIt);
+}
+
+/// @brief add a block of pixels
+/// @param[in] arr pixels (trailing degenerate axes may be omitted)
+/// @param[in] mask pointer to the mask of the same shape or nullptr if all pixels are good
+/// @param[in] where bottom left corner of the block
+void ImageStatistics::accumulate(const casacore::Array<float> &arr, const bool *mask, const casacore::IPosition &where)
+{
+    if (arr.nelements() == 0) {
+        return;
+    }
+    const casacore::uInt ndim = itsShape.nelements();
+    ASKAPCHECK(arr.ndim() <= ndim, "Array with the shape " << arr.shape() << " has more dimensions than the image " <<
+               itsShape);
+    // the arrays with fewer dimensions are treated as degenerate along the trailing axes
+    casacore::IPosition blc(ndim, 0);
+    casacore::IPosition shape(ndim, 1);
+    for (casacore::uInt axis = 0; axis < ndim; ++axis) {
+         if (axis < where.nelements()) {
+             blc[axis] = where[axis];
+         }
+         if (axis < arr.ndim()) {
+             shape[axis] = arr.shape()[axis];
+         }
+         ASKAPCHECK((blc[axis] >= 0) && (blc[axis] + shape[axis] <= itsShape[axis]), "Block with the shape " <<
+                    arr.shape() << " at " << where << " is outside the image with the shape " << itsShape);
+    }
+    const size_t planeSize = ndim > 1 ? shape[0] * shape[1] : shape[0];
+    const size_t nBlockPlanes = arr.nelements() / planeSize;
+
+    bool deleteIt = false;
+    const float *data = arr.getStorage(deleteIt);
+    for (size_t blockPlane = 0; blockPlane < nBlockPlanes; ++blockPlane) {
+         // position of the plane in the image, the axes beyond the first two are flattened
+         size_t rest = blockPlane;
+         size_t plane = 0;
+         size_t stride = 1;
+         for (casacore::uInt axis = 2; axis < ndim; ++axis) {
+              plane += (blc[axis] + rest % shape[axis]) * stride;
+              rest /= shape[axis];
+              stride *= itsShape[axis];
+         }
+         ASKAPDEBUGASSERT(plane < itsPlanes.size());
+         ImageMoments &moments = itsPlanes[plane];
+         const size_t offset = blockPlane * planeSize;
+         for (size_t pixel = offset; pixel < offset + planeSize; ++pixel) {
+              const float value = data[pixel];
+              if (!std::isfinite(value) || ((mask != nullptr) && !mask[pixel])) {
+                  continue;
+              }
+              if (moments.itsCount == 0) {
+                  moments.itsMin = moments.itsMax = value;
+              } else if (value < moments.itsMin) {
+                  moments.itsMin = value;
+              } else if (value > moments.itsMax) {
+                  moments.itsMax = value;
+              }
+              ++moments.itsCount;
+              moments.itsSum += value;
+              moments.itsSumSq += static_cast<double>(value) * value;
+         }
+    }
+    arr.freeStorage(data, deleteIt);
+}
+
+/// @brief combine the moments accumulated by all ranks
+/// @details This is a collective operation, all ranks of the communicator have to call it
+/// with the same image shape. All ranks get the combined moments.
+/// @param[in] comm communicator
+void ImageStatistics::reduce(MPI_Comm comm)
+{
+    const size_t nPlanes = itsPlanes.size();
+    std::vector<unsigned long long> counts(nPlanes);
+    std::vector<double> sums(2 * nPlanes);
+    std::vector<float> extrema(2 * nPlanes);
+    for (size_t plane = 0; plane < nPlanes; ++plane) {
+         const ImageMoments &moments = itsPlanes[plane];
+         counts[plane] = moments.itsCount;
+         sums[2 * plane] = moments.itsSum;
+         sums[2 * plane + 1] = moments.itsSumSq;
+         // the maximum is reduced as the minimum of negated values, empty planes don't contribute
+         extrema[2 * plane] = moments.itsCount > 0 ? moments.itsMin : std::numeric_limits<float>::infinity();
+         extrema[2 * plane + 1] = moments.itsCount > 0 ? -moments.itsMax : std::numeric_limits<float>::infinity();
+    }
+    int status = MPI_Allreduce(MPI_IN_PLACE, counts.data(), static_cast<int>(nPlanes), MPI_UNSIGNED_LONG_LONG,
+                               MPI_SUM, comm);
+    ASKAPCHECK(status == MPI_SUCCESS, "Failed to reduce the pixel counts, error = " << status);
+    status = MPI_Allreduce(MPI_IN_PLACE, sums.data(), static_cast<int>(sums.size()), MPI_DOUBLE, MPI_SUM, comm);
+    ASKAPCHECK(status == MPI_SUCCESS, "Failed to reduce the sums, error = " << status);
+    status = MPI_Allreduce(MPI_IN_PLACE, extrema.data(), static_cast<int>(extrema.size()), MPI_FLOAT, MPI_MIN, comm);
+    ASKAPCHECK(status == MPI_SUCCESS, "Failed to reduce the extrema, error = " << status);
+    for (size_t plane = 0; plane < nPlanes; ++plane) {
+         ImageMoments &moments = itsPlanes[plane];
+         moments = ImageMoments();
+         if (counts[plane] > 0) {
+             moments.itsCount = counts[plane];
+             moments.itsSum = sums[2 * plane];
+             moments.itsSumSq = sums[2 * plane + 1];
+             moments.itsMin = extrema[2 * plane];
+             moments.itsMax = -extrema[2 * plane + 1];
+         }
+    }
+}
+
+/// @brief moments of the given plane
+/// @param[in] plane plane number
+/// @return moments
+const ImageMoments& ImageStatistics::plane(size_t plane) const
+{
+    ASKAPCHECK(plane < itsPlanes.size(), "Plane " << plane << " is outside the image with " << itsPlanes.size() <<
+               " plane(s)");
+    return itsPlanes[plane];
+}
+
+/// @return moments of the whole image
+ImageMoments ImageStatistics::total() const
+{
+    ImageMoments result;
+    for (std::vector<ImageMoments>::const_iterator ci = itsPlanes.begin(); ci != itsPlanes.end(); ++ci) {
+         result.merge(*ci);
+    }
+    return result;
+}
+
+/// @brief store the statistics of the whole image as header keywords
+/// @details DATAMIN, DATAMAX, DATAMEAN, DATARMS and DATASTD are written (nothing is written
+/// if no valid pixel has been accumulated).
+/// @param[in] accessor accessor to write the keywords with
+/// @param[in] name image name
+void ImageStatistics::writeKeywords(IImageAccess<casacore::Float> &accessor, const std::string &name) const
+{
+    const ImageMoments moments = total();
+    if (moments.itsCount == 0) {
+        return;
+    }
+    LOFAR::ParameterSet keywords;
+    keywords.add("DATAMIN", doubleKeyword(moments.itsMin, "Minimum pixel value"));
+    keywords.add("DATAMAX", doubleKeyword(moments.itsMax, "Maximum pixel value"));
+    keywords.add("DATAMEAN", doubleKeyword(moments.mean(), "Mean pixel value"));
+    keywords.add("DATARMS", doubleKeyword(moments.rms(), "Root mean square of pixel values"));
+    keywords.add("DATASTD", doubleKeyword(moments.stddev(), "Standard deviation of pixel values"));
+    accessor.setMetadataKeywords(name, keywords);
+}
+
+/// @brief record with the per-plane statistics
+/// @details The record has the form expected by IImageAccess::setInfo: a sub-record with
+/// the given name with PLANE, NPIX, MIN, MAX, MEAN, RMS and STDDEV columns.
+/// @param[in] tableName name of the table
+/// @return record with the table
+casacore::Record ImageStatistics::toRecord(const std::string &tableName) const
+{
+    const size_t nPlanes = itsPlanes.size();
+    casacore::Vector<casacore::Int> planes(nPlanes);
+    casacore::Vector<casacore::Int64> counts(nPlanes);
+    casacore::Vector<casacore::Float> mins(nPlanes), maxs(nPlanes);
+    casacore::Vector<casacore::Double> means(nPlanes), rmss(nPlanes), stddevs(nPlanes);
+    for (size_t plane = 0; plane < nPlanes; ++plane) {
+         const ImageMoments &moments = itsPlanes[plane];
+         planes[plane] = static_cast<casacore::Int>(plane);
+         counts[plane] = static_cast<casacore::Int64>(moments.itsCount);
+         mins[plane] = moments.itsMin;
+         maxs[plane] = moments.itsMax;
+         means[plane] = moments.mean();
+         rmss[plane] = moments.rms();
+         stddevs[plane] = moments.stddev();
+    }
+    casacore::Record table;
+    table.define("PLANE", planes);
+    table.define("NPIX", counts);
+    table.define("MIN", mins);
+    table.define("MAX", maxs);
+    table.define("MEAN", means);
+    table.define("RMS", rmss);
+    table.define("STDDEV", stddevs);
+    // the units have to be the last field, they are not a column
+    casacore::Vector<casacore::String> units(7, "");
+    table.define("Units", units);
+    casacore::Record result;
+    result.defineRecord(tableName, table);
+    return result;
+}
+
+/// @brief store the per-plane statistics as a table
+/// @details The table is written with IImageAccess::setInfo, see toRecord.
+/// @param[in] accessor accessor to write the table with
+/// @param[in] name image name
+/// @param[in] tableName name of the table
+void ImageStatistics::writeTable(IImageAccess<casacore::Float> &accessor, const std::string &name,
+                                 const std::string &tableName) const
+{
+    accessor.setInfo(name, toRecord(tableName));
+}
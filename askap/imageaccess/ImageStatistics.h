@@ -0,0 +1,176 @@
+/// @file ImageStatistics.h
+/// @brief Statistics of the image accumulated as it is written
+/// @details Restored images and residual cubes used to be read again after they had been
+/// written to obtain the statistics for the QA headers. This class accumulates the moments
+/// of each plane as the data pass through the write methods of the accessor (see
+/// IImageAccess::setStatistics), which saves a full pass over the largest data products.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_IMAGE_STATISTICS_H
+#define ASKAP_ACCESSORS_IMAGE_STATISTICS_H
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Containers/Record.h>
+
+#include <mpi.h>
+
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+template <class T> struct IImageAccess;
+
+/// @brief moments of a set of pixels
+struct ImageMoments {
+    /// @brief empty set
+    ImageMoments();
+
+    /// @brief add another set
+    /// @param[in] other moments to add
+    void merge(const ImageMoments &other);
+
+    /// @return mean value, NaN if there are no pixels
+    double mean() const;
+
+    /// @return root mean square of the values, NaN if there are no pixels
+    double rms() const;
+
+    /// @return standard deviation (with respect to the mean), NaN if there are no pixels
+    double stddev() const;
+
+    /// @brief number of pixels
+    unsigned long long itsCount;
+
+    /// @brief sum of values
+    double itsSum;
+
+    /// @brief sum of squares
+    double itsSumSq;
+
+    /// @brief minimum value, NaN if there are no pixels
+    float itsMin;
+
+    /// @brief maximum value, NaN if there are no pixels
+    float itsMax;
+};
+
+/// @brief Statistics of the image accumulated as it is written
+/// @details The moments (number of pixels, sum, sum of squares, minimum and maximum) are
+/// accumulated per plane, where the plane is given by the first two axes and the remaining
+/// axes are flattened (as for PackedMask). Non-finite and masked pixels are ignored. Pixels
+/// written more than once are counted each time, so the image should be written exactly once
+/// while the statistics are collected. Median and MAD need all pixels of the plane and can't
+/// be accumulated this way.
+///
+/// In parallel jobs each rank accumulates the data it writes and reduce combines the moments.
+/// The statistics can be stored as header keywords (global values) or as a per-plane table.
+/// Not thread-safe, one object should be used by one accessor.
+/// @ingroup imageaccess
+class ImageStatistics {
+public:
+    /// @brief set up the accumulator
+    /// @param[in] shape shape of the image which is going to be written
+    explicit ImageStatistics(const casacore::IPosition &shape);
+
+    /// @brief reset all moments
+    void reset();
+
+    /// @brief add a block of pixels
+    /// @param[in] arr pixels (trailing degenerate axes may be omitted)
+    /// @param[in] where bottom left corner of the block
+    void add(const casacore::Array<float> &arr, const casacore::IPosition &where);
+
+    /// @brief add a block of pixels with a mask
+    /// @param[in] arr pixels (trailing degenerate axes may be omitted)
+    /// @param[in] mask mask of the same shape (true for good pixels)
+    /// @param[in] where bottom left corner of the block
+    void add(const casacore::Array<float> &arr, const casacore::Array<bool> &mask,
+             const casacore::IPosition &where);
+
+    /// @brief combine the moments accumulated by all ranks
+    /// @details This is a collective operation, all ranks of the communicator have to call it
+    /// with the same image shape. All ranks get the combined moments.
+    /// @param[in] comm communicator
+    void reduce(MPI_Comm comm = MPI_COMM_WORLD);
+
+    /// @return shape of the image
+    inline const casacore::IPosition& shape() const { return itsShape; }
+
+    /// @return number of planes
+    inline size_t nPlanes() const { return itsPlanes.size(); }
+
+    /// @brief moments of the given plane
+    /// @param[in] plane plane number
+    /// @return moments
+    const ImageMoments& plane(size_t plane) const;
+
+    /// @return moments of the whole image
+    ImageMoments total() const;
+
+    /// @brief store the statistics of the whole image as header keywords
+    /// @details DATAMIN, DATAMAX, DATAMEAN, DATARMS and DATASTD are written (nothing is written
+    /// if no valid pixel has been accumulated).
+    /// @param[in] accessor accessor to write the keywords with
+    /// @param[in] name image name
+    void writeKeywords(IImageAccess<casacore::Float> &accessor, const std::string &name) const;
+
+    /// @brief record with the per-plane statistics
+    /// @details The record has the form expected by IImageAccess::setInfo: a sub-record with
+    /// the given name with PLANE, NPIX, MIN, MAX, MEAN, RMS and STDDEV columns.
+    /// @param[in] tableName name of the table
+    /// @return record with the table
+    casacore::Record toRecord(const std::string &tableName = "STATISTICS") const;
+
+    /// @brief store the per-plane statistics as a table
+    /// @details The table is written with IImageAccess::setInfo, see toRecord.
+    /// @param[in] accessor accessor to write the table with
+    /// @param[in] name image name
+    /// @param[in] tableName name of the table
+    void writeTable(IImageAccess<casacore::Float> &accessor, const std::string &name,
+                    const std::string &tableName = "STATISTICS") const;
+
+private:
+    /// @brief add a block of pixels
+    /// @param[in] arr pixels (trailing degenerate axes may be omitted)
+    /// @param[in] mask pointer to the mask of the same shape or nullptr if all pixels are good
+    /// @param[in] where bottom left corner of the block
+    void accumulate(const casacore::Array<float> &arr, const bool *mask, const casacore::IPosition &where);
+
+    /// @brief shape of the image
+    casacore::IPosition itsShape;
+
+    /// @brief moments of each plane
+    std::vector<ImageMoments> itsPlanes;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_IMAGE_STATISTICS_H
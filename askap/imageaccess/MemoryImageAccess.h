@@ -0,0 +1,434 @@
+/// @file MemoryImageAccess.h
+/// @brief Access images held in memory
+/// @details This class implements IImageAccess interface for images which only live
+/// for the duration of the process, e.g. intermediate products of a multi-stage pipeline.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#ifndef ASKAP_ACCESSORS_MEMORY_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_MEMORY_IMAGE_ACCESS_H
+
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/dataaccess/IMemoryConsumer.h>
+
+#include <casacore/casa/Containers/Record.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Access images held in memory
+/// @details Pipelines running several stages in one process write intermediate images
+/// (e.g. PSF, weights, residuals) and read them back straight away. This accessor keeps
+/// the pixels, the mask and all metadata in memory, so the hand-off doesn't go through
+/// the disk. The images are shared by all instances of the accessor with the same pixel
+/// type in the process, so an image written through one instance (e.g. created by
+/// imageAccessFactory in one stage) can be read through another. The images live until
+/// they are erased or the process ends.
+///
+/// Under memory pressure the pixels and mask of the least recently used images are
+/// written to a scratch file in the spill directory and read back in on the next access.
+/// The metadata always stay in memory. The pressure is defined by the memory budget
+/// given to this class as well as by the process-wide budget of MemoryGovernor, which the
+/// image store is registered with under the name "memoryimages". Spilling is only possible
+/// if the spill directory is set, otherwise the budget is not enforced.
+///
+/// The methods are thread-safe, but the images are protected by a single lock, so
+/// concurrent accesses are serialised. Unlike the images on disk, unmasked pixels are
+/// returned as written.
+/// @ingroup imageaccess
+template <class T = casacore::Float>
+struct MemoryImageAccess : public IImageAccess<T> {
+
+    /// @brief constructor
+    MemoryImageAccess();
+
+    /// @brief set the memory budget of the images held in memory
+    /// @details The budget is shared by all instances with the same pixel type.
+    /// @param[in] bytes maximum memory used by the pixels and masks, 0 means no limit
+    void setMemoryBudget(size_t bytes);
+
+    /// @return memory budget in bytes, 0 means no limit
+    size_t memoryBudget() const;
+
+    /// @brief set the directory for images spilled to disk
+    /// @details The directory is shared by all instances with the same pixel type.
+    /// @param[in] dir directory name, empty string switches spilling off
+    void setSpillDirectory(const std::string &dir);
+
+    /// @return directory for images spilled to disk, empty if spilling is off
+    std::string spillDirectory() const;
+
+    /// @brief check whether the image exists
+    /// @param[in] name image name
+    /// @return true, if the image exists
+    bool exists(const std::string &name) const;
+
+    /// @brief check whether the pixels of the image are spilled to disk
+    /// @param[in] name image name
+    /// @return true, if the pixels are currently on disk
+    bool isSpilled(const std::string &name) const;
+
+    /// @brief remove the image
+    /// @details Nothing is done if the image doesn't exist.
+    /// @param[in] name image name
+    void erase(const std::string &name);
+
+    /// @return memory used by the pixels and masks of all images in bytes
+    size_t memoryUsed() const;
+
+    /// @return number of times an image was spilled to disk
+    size_t spills() const;
+
+    //////////////////
+    // Reading methods
+    //////////////////
+
+    /// @brief obtain the shape
+    /// @param[in] name image name
+    /// @return full shape of the given image
+    virtual casacore::IPosition shape(const std::string &name) const override;
+
+    /// @brief read full image
+    /// @param[in] name image name
+    /// @return array with pixels
+    virtual casacore::Array<T> read(const std::string &name) const override;
+
+    /// @brief read part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return array with pixels for the selection only
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc) const override;
+
+    /// @brief read part of the image into the given buffer
+    /// @details The buffer is only resized if its shape doesn't match the selection.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with pixels for the selection
+    virtual void readInto(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<T> &buffer) const override;
+
+    /// @brief Determine whether an image has a mask
+    /// @param[in] nam image name
+    /// @return True if image has a mask, False if not.
+    virtual bool isMasked(const std::string &name) const override;
+
+    /// @brief read the mask for the full image
+    /// @param[in] name image name
+    /// @return bool array with mask values - 1=good, 0=bad
+    virtual casacore::LogicalArray readMask(const std::string &name) const override;
+
+    /// @brief read the mask for part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return bool array with mask values - 1=good, 0=bad
+    virtual casacore::LogicalArray readMask(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc) const override;
+
+    /// @brief obtain coordinate system info
+    /// @param[in] name image name
+    /// @return coordinate system object
+    virtual casacore::CoordinateSystem coordSys(const std::string &name) const override;
+
+    /// @brief obtain coordinate system info for part of an image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @return coordinate system object
+    virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+            const casacore::IPosition &trc) const override;
+
+    /// @brief obtain beam info
+    /// @param[in] name image name
+    /// @return beam info vector
+    virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const override;
+
+    /// @brief obtain beam info
+    /// @param[in] name image name
+    /// @return beam info list, empty if the image has a single beam
+    virtual BeamList beamList(const std::string &name) const override;
+
+    /// @brief obtain pixel units
+    /// @param[in] name image name
+    /// @return units string
+    virtual std::string getUnits(const std::string &name) const override;
+
+    /// @brief Get a particular keyword from the image metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keyword The name of the metadata keyword
+    /// @return pair of strings - keyword value and comment
+    virtual std::pair<std::string, std::string> getMetadataKeyword(const std::string &name,
+                                                                   const std::string &keyword) const override;
+
+    /// @brief obtain a snapshot of the image metadata
+    /// @details Unlike for other accessors, the keyword map is complete.
+    /// @param[in] name image name
+    /// @return shared pointer to the snapshot
+    virtual boost::shared_ptr<const ImageMetadata> metadata(const std::string &name) const override;
+
+    /// @brief this method reads the table(s) set by setInfo
+    /// @param[in] name image name
+    /// @param[in] tableName table name, "All" gets all the tables
+    /// @param[out] info record to add the tables to
+    virtual void getInfo(const std::string &name, const std::string& tableName, casacore::Record &info) override;
+
+    /// @brief obtain history lines added to the image
+    /// @param[in] name image name
+    /// @return history lines in the order they were added
+    std::vector<std::string> history(const std::string &name) const;
+
+    //////////////////
+    // Writing methods
+    //////////////////
+
+    /// @brief create a new image
+    /// @details The pixels are allocated and set to zero, an existing image with the
+    /// same name is replaced.
+    /// @param[in] name image name
+    /// @param[in] shape full shape of the image
+    /// @param[in] csys coordinate system of the full image
+    virtual void create(const std::string &name, const casacore::IPosition &shape,
+                        const casacore::CoordinateSystem &csys) override;
+
+    /// @brief write full image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    virtual void write(const std::string &name, const casacore::Array<T> &arr) override;
+
+    /// @brief write a slice of an image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image and mask
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::Array<bool> &mask, const casacore::IPosition &where) override;
+
+    /// @brief add pixels to a slice of an image
+    /// @details The addition is done under the lock of the image store, the region lock
+    /// file used by other accessors is not required.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels to add
+    /// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+    virtual void addInto(const std::string &name, const casacore::Array<T> &arr,
+                         const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image mask
+    /// @param[in] name image name
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                           const casacore::IPosition &where) override;
+
+    /// @brief write an image mask
+    /// @param[in] name image name
+    /// @param[in] mask array with mask
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask) override;
+
+    /// @brief set brightness units of the image
+    /// @param[in] name image name
+    /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+    virtual void setUnits(const std::string &name, const std::string &units) override;
+
+    /// @brief set restoring beam info
+    /// @param[in] name image name
+    /// @param[in] maj major axis in radians
+    /// @param[in] min minor axis in radians
+    /// @param[in] pa position angle in radians
+    virtual void setBeamInfo(const std::string &name, double maj, double min, double pa) override;
+
+    /// @brief set restoring beam info for all channels
+    /// @param[in] name image name
+    /// @param[in] beamlist The list of beams
+    virtual void setBeamInfo(const std::string &name, const BeamList & beamlist) override;
+
+    /// @brief assign the default mask
+    /// @details As for CASA images, all pixels are marked good.
+    /// @param[in] name image name
+    virtual void makeDefaultMask(const std::string &name) override;
+
+    /// @brief Set a particular keyword for the metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keyword The name of the metadata keyword
+    /// @param[in] value The value for the keyword, in string format
+    /// @param[in] desc A description of the keyword
+    virtual void setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                    const std::string value, const std::string &desc = "") override;
+
+    /// @brief Set the keywords for the metadata (A.K.A header)
+    /// @details The values are stored as strings, the type given in the parset is only
+    /// checked (INT, DOUBLE or STRING).
+    /// @param[in] name Image name
+    /// @param[in] keywords A parset with keyword entries (KEYWORD = ["keyword value","keyword description","STRING"])
+    virtual void setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords) override;
+
+    /// @brief Add HISTORY messages to the image metadata
+    /// @param[in] name Image name
+    /// @param[in] historyLines History comments to add
+    virtual void addHistory(const std::string &name, const std::vector<std::string> &historyLines) override;
+
+    /// @brief this method stores the table given as a sub-record of info with the image
+    /// @param[in] name image name
+    /// @param[in] info record to be stored
+    virtual void setInfo(const std::string &name, const casacore::RecordInterface & info) override;
+
+private:
+    /// @brief image held in memory
+    struct Image {
+        /// @brief pixels, empty if spilled to disk
+        casacore::Array<T> itsPixels;
+        /// @brief mask, empty if the image has no mask or it is spilled to disk
+        casacore::LogicalArray itsMask;
+        /// @brief metadata snapshot, replaced on every header change
+        boost::shared_ptr<const ImageMetadata> itsMetadata;
+        /// @brief history lines
+        std::vector<std::string> itsHistory;
+        /// @brief tables set via setInfo
+        casacore::Record itsInfo;
+        /// @brief use stamp of the last access (see MemoryGovernor::stamp)
+        casacore::uInt64 itsLastUse;
+        /// @brief name of the file with the pixels and the mask, empty if not spilled
+        std::string itsSpillFile;
+    };
+
+    /// @brief images shared by all instances of the accessor with the same pixel type
+    struct Store : public IMemoryConsumer {
+        /// @brief constructor, registers the store with MemoryGovernor
+        Store();
+
+        /// @brief destructor, removes spill files and unregisters the store
+        ~Store();
+
+        /// @return name of the store used by MemoryGovernor
+        virtual std::string consumerName() const override;
+
+        /// @return memory used by the pixels and masks of all images in bytes
+        virtual size_t memoryUsed() const override;
+
+        /// @return use stamp of the least recently used image held in memory
+        virtual casacore::uInt64 oldestUse() const override;
+
+        /// @brief spill the least recently used image to disk
+        /// @return memory released in bytes
+        virtual size_t releaseOldest() override;
+
+        /// @brief find the image and make sure its pixels are in memory
+        /// @note the mutex should be locked by the caller
+        /// @param[in] name image name
+        /// @return reference to the image
+        Image& image(const std::string &name);
+
+        /// @brief spill images until the budget is met
+        /// @note the mutex should be locked by the caller
+        /// @param[in] keep name of the image which shouldn't be spilled
+        void enforceBudget(const std::string &keep);
+
+        /// @brief spill the least recently used image held in memory
+        /// @note the mutex should be locked by the caller
+        /// @param[in] keep name of the image which shouldn't be spilled
+        /// @return memory released in bytes, 0 if nothing could be spilled
+        size_t spillOldest(const std::string &keep);
+
+        /// @brief memory used by the pixels and masks of all images in bytes
+        /// @note the mutex should be locked by the caller
+        size_t bytesUsed() const;
+
+        /// @brief memory used by the pixels and mask of a single image in bytes
+        static size_t bytesUsed(const Image &img);
+
+        /// @brief remove the spill file of the image, if any
+        static void removeSpillFile(Image &img);
+
+        /// @brief images by name
+        std::map<std::string, Image> itsImages;
+
+        /// @brief memory budget in bytes, 0 means no limit
+        size_t itsBudget;
+
+        /// @brief spill directory, empty if spilling is off
+        std::string itsSpillDir;
+
+        /// @brief number of images spilled so far
+        size_t itsSpills;
+
+        /// @brief counter used to give spill files unique names
+        size_t itsSpillCounter;
+
+        /// @brief synchronisation lock
+        mutable boost::mutex itsMutex;
+    };
+
+    /// @brief obtain the store shared by all instances
+    /// @return reference to the store
+    static Store& store();
+
+    /// @brief obtain the metadata for modification
+    /// @details The snapshot is copied, so the snapshots handed out stay unchanged
+    /// @param[in] img image
+    /// @return reference to the new snapshot
+    static ImageMetadata& editMetadata(Image &img);
+
+    /// @brief write a slice of the mask
+    /// @details The mask is created (with all pixels good) if the image doesn't have one.
+    /// @param[in] img image
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner of the slice
+    static void writeMaskSection(Image &img, const casacore::Array<bool> &mask, const casacore::IPosition &where);
+
+    /// @brief check that the selection is within the image
+    /// @param[in] img image
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    static void checkSelection(const Image &img, const casacore::IPosition &blc, const casacore::IPosition &trc);
+
+    /// @brief enforce the budget of MemoryGovernor
+    /// @details This is called after the lock of the store is released
+    static void enforceGlobalBudget();
+};
+
+} // namespace accessors
+} // namespace askap
+
+#include "MemoryImageAccess.tcc"
+#endif
@@ -0,0 +1,924 @@
+/// @file MemoryImageAccess.tcc
+/// @brief Access images held in memory
+/// @details This class implements IImageAccess interface for images which only live
+/// for the duration of the process, e.g. intermediate products of a multi-stage pipeline.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#include <askap/imageaccess/MemoryImageAccess.h>
+
+#include <askap/askap/AskapLogging.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/scimath/Mathematics/GaussianBeam.h>
+
+#include <boost/thread/lock_guard.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+ASKAP_LOGGER(memImAccessLogger, ".memoryImageAccessor");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief constructor
+template <class T>
+MemoryImageAccess<T>::MemoryImageAccess()
+{
+    // make sure the store is set up before it is used from other threads
+    store();
+}
+
+/// @brief set the memory budget of the images held in memory
+/// @details The budget is shared by all instances with the same pixel type.
+/// @param[in] bytes maximum memory used by the pixels and masks, 0 means no limit
+template <class T>
+void MemoryImageAccess<T>::setMemoryBudget(size_t bytes)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    st.itsBudget = bytes;
+    st.enforceBudget("");
+}
+
+/// @return memory budget in bytes, 0 means no limit
+template <class T>
+size_t MemoryImageAccess<T>::memoryBudget() const
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    return st.itsBudget;
+}
+
+/// @brief set the directory for images spilled to disk
+/// @details The directory is shared by all instances with the same pixel type.
+/// @param[in] dir directory name, empty string switches spilling off
+template <class T>
+void MemoryImageAccess<T>::setSpillDirectory(const std::string &dir)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    st.itsSpillDir = dir;
+    st.enforceBudget("");
+}
+
+/// @return directory for images spilled to disk, empty if spilling is off
+template <class T>
+std::string MemoryImageAccess<T>::spillDirectory() const
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    return st.itsSpillDir;
+}
+
+/// @brief check whether the image exists
+/// @param[in] name image name
+/// @return true, if the image exists
+template <class T>
+bool MemoryImageAccess<T>::exists(const std::string &name) const
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    return st.itsImages.find(name) != st.itsImages.end();
+}
+
+/// @brief check whether the pixels of the image are spilled to disk
+/// @param[in] name image name
+/// @return true, if the pixels are currently on disk
+template <class T>
+bool MemoryImageAccess<T>::isSpilled(const std::string &name) const
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    const typename std::map<std::string, Image>::const_iterator ci = st.itsImages.find(name);
+    ASKAPCHECK(ci != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    return !ci->second.itsSpillFile.empty();
+}
+
+/// @brief remove the image
+/// @details Nothing is done if the image doesn't exist.
+/// @param[in] name image name
+template <class T>
+void MemoryImageAccess<T>::erase(const std::string &name)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    const typename std::map<std::string, Image>::iterator it = st.itsImages.find(name);
+    if (it != st.itsImages.end()) {
+        Store::removeSpillFile(it->second);
+        st.itsImages.erase(it);
+    }
+}
+
+/// @return memory used by the pixels and masks of all images in bytes
+template <class T>
+size_t MemoryImageAccess<T>::memoryUsed() const
+{
+    return store().memoryUsed();
+}
+
+/// @return number of times an image was spilled to disk
+template <class T>
+size_t MemoryImageAccess<T>::spills() const
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    return st.itsSpills;
+}
+
+// reading methods
+
+/// @brief obtain the shape
+/// @param[in] name image name
+/// @return full shape of the given image
+template <class T>
+casacore::IPosition MemoryImageAccess<T>::shape(const std::string &name) const
+{
+    return metadata(name)->itsShape;
+}
+
+/// @brief read full image
+/// @param[in] name image name
+/// @return array with pixels
+template <class T>
+casacore::Array<T> MemoryImageAccess<T>::read(const std::string &name) const
+{
+    const casacore::IPosition shape = this->shape(name);
+    casacore::Array<T> result;
+    readInto(name, casacore::IPosition(shape.nelements(), 0), shape - 1, result);
+    return result;
+}
+
+/// @brief read part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return array with pixels for the selection only
+template <class T>
+casacore::Array<T> MemoryImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    casacore::Array<T> result;
+    readInto(name, blc, trc, result);
+    return result;
+}
+
+/// @brief read part of the image into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @param[out] buffer array to fill with pixels for the selection
+template <class T>
+void MemoryImageAccess<T>::readInto(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc, casacore::Array<T> &buffer) const
+{
+    {
+      Store &st = store();
+      boost::lock_guard<boost::mutex> lock(st.itsMutex);
+      Image &img = st.image(name);
+      checkSelection(img, blc, trc);
+      this->resizeBuffer(buffer, trc - blc + 1);
+      buffer = img.itsPixels(blc, trc);
+    }
+    enforceGlobalBudget();
+}
+
+/// @brief Determine whether an image has a mask
+/// @param[in] nam image name
+/// @return True if image has a mask, False if not.
+template <class T>
+bool MemoryImageAccess<T>::isMasked(const std::string &name) const
+{
+    return metadata(name)->itsMasked;
+}
+
+/// @brief read the mask for the full image
+/// @param[in] name image name
+/// @return bool array with mask values - 1=good, 0=bad
+template <class T>
+casacore::LogicalArray MemoryImageAccess<T>::readMask(const std::string &name) const
+{
+    const casacore::IPosition shape = this->shape(name);
+    return readMask(name, casacore::IPosition(shape.nelements(), 0), shape - 1);
+}
+
+/// @brief read the mask for part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+/// @return bool array with mask values - 1=good, 0=bad
+template <class T>
+casacore::LogicalArray MemoryImageAccess<T>::readMask(const std::string &name, const casacore::IPosition &blc,
+                                                      const casacore::IPosition &trc) const
+{
+    casacore::LogicalArray result;
+    {
+      Store &st = store();
+      boost::lock_guard<boost::mutex> lock(st.itsMutex);
+      Image &img = st.image(name);
+      checkSelection(img, blc, trc);
+      if (img.itsMetadata->itsMasked) {
+          result = img.itsMask(blc, trc);
+      } else {
+          result.resize(trc - blc + 1);
+          result = true;
+      }
+    }
+    enforceGlobalBudget();
+    return result;
+}
+
+/// @brief obtain coordinate system info
+/// @param[in] name image name
+/// @return coordinate system object
+template <class T>
+casacore::CoordinateSystem MemoryImageAccess<T>::coordSys(const std::string &name) const
+{
+    return metadata(name)->itsCoordSys;
+}
+
+/// @brief obtain coordinate system info for part of an image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return coordinate system object
+template <class T>
+casacore::CoordinateSystem MemoryImageAccess<T>::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+        const casacore::IPosition &trc) const
+{
+    const boost::shared_ptr<const ImageMetadata> md = metadata(name);
+    return this->sliceCoordSys(md->itsCoordSys, md->itsShape, blc, trc);
+}
+
+/// @brief obtain beam info
+/// @param[in] name image name
+/// @return beam info vector
+template <class T>
+casacore::Vector<casacore::Quantum<double> > MemoryImageAccess<T>::beamInfo(const std::string &name) const
+{
+    return metadata(name)->itsBeam;
+}
+
+/// @brief obtain beam info
+/// @param[in] name image name
+/// @return beam info list, empty if the image has a single beam
+template <class T>
+BeamList MemoryImageAccess<T>::beamList(const std::string &name) const
+{
+    return metadata(name)->itsBeamList;
+}
+
+/// @brief obtain pixel units
+/// @param[in] name image name
+/// @return units string
+template <class T>
+std::string MemoryImageAccess<T>::getUnits(const std::string &name) const
+{
+    return metadata(name)->itsUnits;
+}
+
+/// @brief Get a particular keyword from the image metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @return pair of strings - keyword value and comment
+template <class T>
+std::pair<std::string, std::string> MemoryImageAccess<T>::getMetadataKeyword(const std::string &name,
+        const std::string &keyword) const
+{
+    const boost::shared_ptr<const ImageMetadata> md = metadata(name);
+    if (md->itsKeywords.find(keyword) == md->itsKeywords.end()) {
+        ASKAPLOG_DEBUG_STR(memImAccessLogger, "Keyword " << keyword << " is not defined in metadata for image " << name);
+    }
+    return md->keyword(keyword);
+}
+
+/// @brief obtain a snapshot of the image metadata
+/// @details Unlike for other accessors, the keyword map is complete. The pixels are not
+/// read back if the image is spilled to disk.
+/// @param[in] name image name
+/// @return shared pointer to the snapshot
+template <class T>
+boost::shared_ptr<const ImageMetadata> MemoryImageAccess<T>::metadata(const std::string &name) const
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    const typename std::map<std::string, Image>::const_iterator ci = st.itsImages.find(name);
+    ASKAPCHECK(ci != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    return ci->second.itsMetadata;
+}
+
+/// @brief this method reads the table(s) set by setInfo
+/// @param[in] name image name
+/// @param[in] tableName table name, "All" gets all the tables
+/// @param[out] info record to add the tables to
+template <class T>
+void MemoryImageAccess<T>::getInfo(const std::string &name, const std::string& tableName, casacore::Record &info)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    const typename std::map<std::string, Image>::const_iterator ci = st.itsImages.find(name);
+    ASKAPCHECK(ci != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    const casacore::Record &tables = ci->second.itsInfo;
+    for (casacore::uInt f = 0; f < tables.nfields(); ++f) {
+         if ((tables.dataType(f) == casacore::TpRecord) && ((tableName == tables.name(f)) || (tableName == "All"))) {
+             info.defineRecord(tables.name(f), tables.asRecord(f));
+         }
+    }
+}
+
+/// @brief obtain history lines added to the image
+/// @param[in] name image name
+/// @return history lines in the order they were added
+template <class T>
+std::vector<std::string> MemoryImageAccess<T>::history(const std::string &name) const
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    const typename std::map<std::string, Image>::const_iterator ci = st.itsImages.find(name);
+    ASKAPCHECK(ci != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    return ci->second.itsHistory;
+}
+
+// writing methods
+
+/// @brief create a new image
+/// @details The pixels are allocated and set to zero, an existing image with the
+/// same name is replaced.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+template <class T>
+void MemoryImageAccess<T>::create(const std::string &name, const casacore::IPosition &shape,
+                                  const casacore::CoordinateSystem &csys)
+{
+    ASKAPLOG_INFO_STR(memImAccessLogger, "Creating a new memory image " << name << " with the shape " << shape);
+    ASKAPCHECK(shape.nelements() == csys.nPixelAxes(), "Image " << name << " with the shape " << shape <<
+               " doesn't match the coordinate system with " << csys.nPixelAxes() << " pixel axes");
+    {
+      Store &st = store();
+      boost::lock_guard<boost::mutex> lock(st.itsMutex);
+      Image &img = st.itsImages[name];
+      Store::removeSpillFile(img);
+      img.itsPixels.resize(shape);
+      img.itsPixels = static_cast<T>(0.0);
+      img.itsMask.resize();
+      img.itsHistory.clear();
+      img.itsInfo = casacore::Record();
+      boost::shared_ptr<ImageMetadata> md(new ImageMetadata);
+      md->itsShape = shape;
+      md->itsCoordSys = csys;
+      md->itsBeam = casacore::GaussianBeam().toVector();
+      img.itsMetadata = md;
+      img.itsLastUse = MemoryGovernor::instance().stamp();
+      st.enforceBudget(name);
+    }
+    enforceGlobalBudget();
+}
+
+/// @brief write full image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+template <class T>
+void MemoryImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr)
+{
+    write(name, arr, casacore::IPosition(arr.ndim(), 0));
+}
+
+/// @brief write a slice of an image
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void MemoryImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                 const casacore::IPosition &where)
+{
+    {
+      Store &st = store();
+      boost::lock_guard<boost::mutex> lock(st.itsMutex);
+      Image &img = st.image(name);
+      checkSelection(img, where, where + arr.shape() - 1);
+      casacore::Array<T> section = img.itsPixels(where, where + arr.shape() - 1);
+      section = arr;
+    }
+    this->accumulateStatistics(arr, where);
+    enforceGlobalBudget();
+}
+
+/// @brief write a slice of an image and mask
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void MemoryImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                 const casacore::Array<bool> &mask, const casacore::IPosition &where)
+{
+    ASKAPCHECK(arr.shape().isEqual(mask.shape()), "Mask shape " << mask.shape() << " doesn't match the shape of pixels " <<
+               arr.shape());
+    {
+      Store &st = store();
+      boost::lock_guard<boost::mutex> lock(st.itsMutex);
+      Image &img = st.image(name);
+      checkSelection(img, where, where + arr.shape() - 1);
+      casacore::Array<T> section = img.itsPixels(where, where + arr.shape() - 1);
+      section = arr;
+      writeMaskSection(img, mask, where);
+      st.enforceBudget(name);
+    }
+    this->accumulateStatistics(arr, mask, where);
+    enforceGlobalBudget();
+}
+
+/// @brief add pixels to a slice of an image
+/// @details The addition is done under the lock of the image store, the region lock
+/// file used by other accessors is not required.
+/// @param[in] name image name
+/// @param[in] arr array with pixels to add
+/// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+template <class T>
+void MemoryImageAccess<T>::addInto(const std::string &name, const casacore::Array<T> &arr,
+                                   const casacore::IPosition &where)
+{
+    casacore::Array<T> sums;
+    {
+      Store &st = store();
+      boost::lock_guard<boost::mutex> lock(st.itsMutex);
+      Image &img = st.image(name);
+      checkSelection(img, where, where + arr.shape() - 1);
+      casacore::Array<T> section = img.itsPixels(where, where + arr.shape() - 1);
+      section += arr;
+      if (this->statistics()) {
+          sums = section.copy();
+      }
+    }
+    if (this->statistics()) {
+        this->accumulateStatistics(sums, where);
+    }
+    enforceGlobalBudget();
+}
+
+/// @brief write a slice of an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void MemoryImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                                     const casacore::IPosition &where)
+{
+    {
+      Store &st = store();
+      boost::lock_guard<boost::mutex> lock(st.itsMutex);
+      Image &img = st.image(name);
+      checkSelection(img, where, where + mask.shape() - 1);
+      writeMaskSection(img, mask, where);
+      st.enforceBudget(name);
+    }
+    enforceGlobalBudget();
+}
+
+/// @brief write an image mask
+/// @param[in] name image name
+/// @param[in] mask array with mask
+template <class T>
+void MemoryImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+{
+    writeMask(name, mask, casacore::IPosition(mask.ndim(), 0));
+}
+
+/// @brief set brightness units of the image
+/// @param[in] name image name
+/// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+template <class T>
+void MemoryImageAccess<T>::setUnits(const std::string &name, const std::string &units)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    typename std::map<std::string, Image>::iterator it = st.itsImages.find(name);
+    ASKAPCHECK(it != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    editMetadata(it->second).itsUnits = units;
+}
+
+/// @brief set restoring beam info
+/// @param[in] name image name
+/// @param[in] maj major axis in radians
+/// @param[in] min minor axis in radians
+/// @param[in] pa position angle in radians
+template <class T>
+void MemoryImageAccess<T>::setBeamInfo(const std::string &name, double maj, double min, double pa)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    typename std::map<std::string, Image>::iterator it = st.itsImages.find(name);
+    ASKAPCHECK(it != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    ImageMetadata &md = editMetadata(it->second);
+    md.itsBeam = casacore::GaussianBeam(casacore::Quantity(maj, "rad"), casacore::Quantity(min, "rad"),
+                                        casacore::Quantity(pa, "rad")).toVector();
+    md.itsBeamList.clear();
+}
+
+/// @brief set restoring beam info for all channels
+/// @param[in] name image name
+/// @param[in] beamlist The list of beams
+template <class T>
+void MemoryImageAccess<T>::setBeamInfo(const std::string &name, const BeamList & beamlist)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    typename std::map<std::string, Image>::iterator it = st.itsImages.find(name);
+    ASKAPCHECK(it != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    for (BeamList::const_iterator ci = beamlist.begin(); ci != beamlist.end(); ++ci) {
+         ASKAPCHECK(ci->second.nelements() == 3, "Beam of channel " << ci->first << " should have 3 elements");
+    }
+    editMetadata(it->second).itsBeamList = beamlist;
+}
+
+/// @brief assign the default mask
+/// @details As for CASA images, all pixels are marked good.
+/// @param[in] name image name
+template <class T>
+void MemoryImageAccess<T>::makeDefaultMask(const std::string &name)
+{
+    const casacore::IPosition shape = this->shape(name);
+    writeMask(name, casacore::LogicalArray(shape, true));
+}
+
+/// @brief Set a particular keyword for the metadata (A.K.A header)
+/// @param[in] name Image name
+/// @param[in] keyword The name of the metadata keyword
+/// @param[in] value The value for the keyword, in string format
+/// @param[in] desc A description of the keyword
+template <class T>
+void MemoryImageAccess<T>::setMetadataKeyword(const std::string &name, const std::string &keyword,
+        const std::string value, const std::string &desc)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    typename std::map<std::string, Image>::iterator it = st.itsImages.find(name);
+    ASKAPCHECK(it != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    editMetadata(it->second).itsKeywords[keyword] = std::pair<std::string, std::string>(value, desc);
+}
+
+/// @brief Set the keywords for the metadata (A.K.A header)
+/// @details The values are stored as strings, the type given in the parset is only
+/// checked (INT, DOUBLE or STRING).
+/// @param[in] name Image name
+/// @param[in] keywords A parset with keyword entries (KEYWORD = ["keyword value","keyword description","STRING"])
+template <class T>
+void MemoryImageAccess<T>::setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    typename std::map<std::string, Image>::iterator it = st.itsImages.find(name);
+    ASKAPCHECK(it != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    ImageMetadata &md = editMetadata(it->second);
+    for (auto &elem : keywords) {
+      const std::string keyword = elem.first;
+      const std::vector<std::string> valanddesc = elem.second.getStringVector();
+      if (valanddesc.size() > 0) {
+        const std::string value = valanddesc[0];
+        const std::string desc = (valanddesc.size() > 1 ? valanddesc[1] : "");
+        std::string type = (valanddesc.size() > 2 ? valanddesc[2] : "STRING");
+        std::transform(type.begin(), type.end(), type.begin(), ::toupper);
+        try {
+          if (type == "INT") {
+              static_cast<void>(std::stoi(value));
+          } else if (type == "DOUBLE") {
+              static_cast<void>(std::stod(value));
+          } else if (type != "STRING") {
+              ASKAPLOG_WARN_STR(memImAccessLogger, "Invalid type for header keyword "<<keyword<<" : "<<type);
+              continue;
+          }
+          md.itsKeywords[keyword] = std::pair<std::string, std::string>(value, desc);
+        } catch (const std::invalid_argument&) {
+          ASKAPLOG_WARN_STR(memImAccessLogger, "Invalid "<<type<<" value for header keyword "<<keyword<<" : "<<value);
+        } catch (const std::out_of_range&) {
+          ASKAPLOG_WARN_STR(memImAccessLogger, "Out of range "<<type<<" value for header keyword "<<keyword<<" : "<<value);
+        }
+      }
+    }
+}
+
+/// @brief Add HISTORY messages to the image metadata
+/// @param[in] name Image name
+/// @param[in] historyLines History comments to add
+template <class T>
+void MemoryImageAccess<T>::addHistory(const std::string &name, const std::vector<std::string> &historyLines)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    typename std::map<std::string, Image>::iterator it = st.itsImages.find(name);
+    ASKAPCHECK(it != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    it->second.itsHistory.insert(it->second.itsHistory.end(), historyLines.begin(), historyLines.end());
+}
+
+/// @brief this method stores the table given as a sub-record of info with the image
+/// @param[in] name image name
+/// @param[in] info record to be stored
+template <class T>
+void MemoryImageAccess<T>::setInfo(const std::string &name, const casacore::RecordInterface & info)
+{
+    Store &st = store();
+    boost::lock_guard<boost::mutex> lock(st.itsMutex);
+    typename std::map<std::string, Image>::iterator it = st.itsImages.find(name);
+    ASKAPCHECK(it != st.itsImages.end(), "Memory image " << name << " doesn't exist");
+    // the name of the info table is the name of the first sub-record, as for CASA images
+    std::string infoTableName = "notfound";
+    for (casacore::uInt f = 0; f < info.nfields(); ++f) {
+         if (info.dataType(f) == casacore::TpRecord) {
+             infoTableName = info.name(f);
+             break;
+         }
+    }
+    it->second.itsInfo.defineRecord(infoTableName, info);
+}
+
+// helper methods
+
+/// @brief obtain the store shared by all instances
+/// @return reference to the store
+template <class T>
+typename MemoryImageAccess<T>::Store& MemoryImageAccess<T>::store()
+{
+    static Store theStore;
+    return theStore;
+}
+
+/// @brief obtain the metadata for modification
+/// @details The snapshot is copied, so the snapshots handed out stay unchanged
+/// @param[in] img image
+/// @return reference to the new snapshot
+template <class T>
+ImageMetadata& MemoryImageAccess<T>::editMetadata(Image &img)
+{
+    ASKAPDEBUGASSERT(img.itsMetadata);
+    boost::shared_ptr<ImageMetadata> md(new ImageMetadata(*img.itsMetadata));
+    img.itsMetadata = md;
+    return *md;
+}
+
+/// @brief write a slice of the mask
+/// @details The mask is created (with all pixels good) if the image doesn't have one.
+/// The selection should be checked by the caller.
+/// @param[in] img image
+/// @param[in] mask array with mask
+/// @param[in] where bottom left corner of the slice
+template <class T>
+void MemoryImageAccess<T>::writeMaskSection(Image &img, const casacore::Array<bool> &mask,
+                                            const casacore::IPosition &where)
+{
+    if (!img.itsMetadata->itsMasked) {
+        img.itsMask.resize(img.itsPixels.shape());
+        img.itsMask = true;
+        editMetadata(img).itsMasked = true;
+    }
+    casacore::LogicalArray section = img.itsMask(where, where + mask.shape() - 1);
+    section = mask;
+}
+
+/// @brief check that the selection is within the image
+/// @param[in] img image
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection
+template <class T>
+void MemoryImageAccess<T>::checkSelection(const Image &img, const casacore::IPosition &blc,
+                                          const casacore::IPosition &trc)
+{
+    const casacore::IPosition &shape = img.itsMetadata->itsShape;
+    ASKAPCHECK((blc.nelements() == shape.nelements()) && (trc.nelements() == shape.nelements()),
+               "Selection from " << blc << " to " << trc << " doesn't match the image dimensionality, shape = " << shape);
+    for (size_t axis = 0; axis < shape.nelements(); ++axis) {
+         ASKAPCHECK((blc[axis] >= 0) && (blc[axis] <= trc[axis]) && (trc[axis] < shape[axis]),
+                    "Selection from " << blc << " to " << trc << " is outside the image with the shape " << shape);
+    }
+}
+
+/// @brief enforce the budget of MemoryGovernor
+/// @details This is called after the lock of the store is released
+template <class T>
+void MemoryImageAccess<T>::enforceGlobalBudget()
+{
+    MemoryGovernor::instance().enforce();
+}
+
+// image store
+
+/// @brief constructor, registers the store with MemoryGovernor
+template <class T>
+MemoryImageAccess<T>::Store::Store() : itsBudget(0), itsSpills(0), itsSpillCounter(0)
+{
+    MemoryGovernor::instance().add(this);
+}
+
+/// @brief destructor, removes spill files and unregisters the store
+template <class T>
+MemoryImageAccess<T>::Store::~Store()
+{
+    MemoryGovernor::instance().remove(this);
+    for (typename std::map<std::string, Image>::iterator it = itsImages.begin(); it != itsImages.end(); ++it) {
+         removeSpillFile(it->second);
+    }
+}
+
+/// @return name of the store used by MemoryGovernor
+template <class T>
+std::string MemoryImageAccess<T>::Store::consumerName() const
+{
+    return "memoryimages";
+}
+
+/// @return memory used by the pixels and masks of all images in bytes
+template <class T>
+size_t MemoryImageAccess<T>::Store::memoryUsed() const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    return bytesUsed();
+}
+
+/// @return use stamp of the least recently used image held in memory
+template <class T>
+casacore::uInt64 MemoryImageAccess<T>::Store::oldestUse() const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    casacore::uInt64 result = std::numeric_limits<casacore::uInt64>::max();
+    if (itsSpillDir.empty()) {
+        // nothing can be released
+        return result;
+    }
+    for (typename std::map<std::string, Image>::const_iterator ci = itsImages.begin(); ci != itsImages.end(); ++ci) {
+         if (ci->second.itsSpillFile.empty() && (ci->second.itsLastUse < result)) {
+             result = ci->second.itsLastUse;
+         }
+    }
+    return result;
+}
+
+/// @brief spill the least recently used image to disk
+/// @return memory released in bytes
+template <class T>
+size_t MemoryImageAccess<T>::Store::releaseOldest()
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    return spillOldest("");
+}
+
+/// @brief find the image and make sure its pixels are in memory
+/// @details An image spilled to disk is read back and its spill file is removed,
+/// other images may be spilled to make room for it.
+/// @note the mutex should be locked by the caller
+/// @param[in] name image name
+/// @return reference to the image
+template <class T>
+typename MemoryImageAccess<T>::Image& MemoryImageAccess<T>::Store::image(const std::string &name)
+{
+    const typename std::map<std::string, Image>::iterator it = itsImages.find(name);
+    ASKAPCHECK(it != itsImages.end(), "Memory image " << name << " doesn't exist");
+    Image &img = it->second;
+    img.itsLastUse = MemoryGovernor::instance().stamp();
+    if (!img.itsSpillFile.empty()) {
+        ASKAPLOG_DEBUG_STR(memImAccessLogger, "Reading memory image " << name << " back from " << img.itsSpillFile);
+        std::ifstream is(img.itsSpillFile.c_str(), std::ios::binary);
+        const casacore::IPosition &shape = img.itsMetadata->itsShape;
+        img.itsPixels.resize(shape);
+        is.read(reinterpret_cast<char*>(img.itsPixels.data()), img.itsPixels.nelements() * sizeof(T));
+        if (img.itsMetadata->itsMasked) {
+            img.itsMask.resize(shape);
+            is.read(reinterpret_cast<char*>(img.itsMask.data()), img.itsMask.nelements() * sizeof(casacore::Bool));
+        }
+        ASKAPCHECK(is, "Unable to read memory image " << name << " back from " << img.itsSpillFile);
+        removeSpillFile(img);
+        enforceBudget(name);
+    }
+    return img;
+}
+
+/// @brief spill images until the budget is met
+/// @note the mutex should be locked by the caller
+/// @param[in] keep name of the image which shouldn't be spilled
+template <class T>
+void MemoryImageAccess<T>::Store::enforceBudget(const std::string &keep)
+{
+    if ((itsBudget == 0) || itsSpillDir.empty()) {
+        return;
+    }
+    size_t used = bytesUsed();
+    while (used > itsBudget) {
+           const size_t released = spillOldest(keep);
+           if (released == 0) {
+               break;
+           }
+           used -= std::min(used, released);
+    }
+}
+
+/// @brief spill the least recently used image held in memory
+/// @details The pixels are written to a scratch file followed by the mask (if any)
+/// in the native binary format, the metadata stay in memory.
+/// @note the mutex should be locked by the caller
+/// @param[in] keep name of the image which shouldn't be spilled
+/// @return memory released in bytes, 0 if nothing could be spilled
+template <class T>
+size_t MemoryImageAccess<T>::Store::spillOldest(const std::string &keep)
+{
+    if (itsSpillDir.empty()) {
+        return 0;
+    }
+    typename std::map<std::string, Image>::iterator victim = itsImages.end();
+    for (typename std::map<std::string, Image>::iterator it = itsImages.begin(); it != itsImages.end(); ++it) {
+         if ((it->first != keep) && it->second.itsSpillFile.empty() && (it->second.itsPixels.nelements() > 0) &&
+             ((victim == itsImages.end()) || (it->second.itsLastUse < victim->second.itsLastUse))) {
+             victim = it;
+         }
+    }
+    if (victim == itsImages.end()) {
+        return 0;
+    }
+    Image &img = victim->second;
+    std::ostringstream os;
+    os << itsSpillDir << "/memoryimage_" << getpid() << "_" << itsSpillCounter++ << ".spill";
+    const std::string fileName = os.str();
+    ASKAPLOG_DEBUG_STR(memImAccessLogger, "Spilling memory image " << victim->first << " to " << fileName);
+    {
+      std::ofstream out(fileName.c_str(), std::ios::binary | std::ios::trunc);
+      const casacore::Array<T> pixels = img.itsPixels.contiguousStorage() ? img.itsPixels : img.itsPixels.copy();
+      out.write(reinterpret_cast<const char*>(pixels.data()), pixels.nelements() * sizeof(T));
+      if (img.itsMask.nelements() > 0) {
+          const casacore::LogicalArray mask = img.itsMask.contiguousStorage() ? img.itsMask : img.itsMask.copy();
+          out.write(reinterpret_cast<const char*>(mask.data()), mask.nelements() * sizeof(casacore::Bool));
+      }
+      out.close();
+      if (!out) {
+          ASKAPLOG_WARN_STR(memImAccessLogger, "Unable to spill memory image " << victim->first << " to " <<
+                            fileName << ", it is kept in memory");
+          std::remove(fileName.c_str());
+          return 0;
+      }
+    }
+    const size_t released = bytesUsed(img);
+    img.itsPixels.resize();
+    img.itsMask.resize();
+    img.itsSpillFile = fileName;
+    ++itsSpills;
+    return released;
+}
+
+/// @brief memory used by the pixels and masks of all images in bytes
+/// @note the mutex should be locked by the caller
+template <class T>
+size_t MemoryImageAccess<T>::Store::bytesUsed() const
+{
+    size_t result = 0;
+    for (typename std::map<std::string, Image>::const_iterator ci = itsImages.begin(); ci != itsImages.end(); ++ci) {
+         result += bytesUsed(ci->second);
+    }
+    return result;
+}
+
+/// @brief memory used by the pixels and mask of a single image in bytes
+template <class T>
+size_t MemoryImageAccess<T>::Store::bytesUsed(const Image &img)
+{
+    return img.itsPixels.nelements() * sizeof(T) + img.itsMask.nelements() * sizeof(casacore::Bool);
+}
+
+/// @brief remove the spill file of the image, if any
+template <class T>
+void MemoryImageAccess<T>::Store::removeSpillFile(Image &img)
+{
+    if (!img.itsSpillFile.empty()) {
+        std::remove(img.itsSpillFile.c_str());
+        img.itsSpillFile.clear();
+    }
+}
@@ -0,0 +1,201 @@
+/// @file PackedMask.cc
+/// @brief Image mask stored with one bit per pixel
+/// @details The mask is packed into 64-bit words, the plane summary is derived
+/// by counting the set bits.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap_accessors.h>
+
+#include <askap/askap/AskapError.h>
+#include <askap/imageaccess/PackedMask.h>
+
+#include <cmath>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief construct an empty mask
+PackedMask::PackedMask() : itsNElements(0) {}
+
+/// @brief construct a mask of the given shape
+/// @param[in] shape shape of the mask
+/// @param[in] value initial value of all pixels (true = good)
+PackedMask::PackedMask(const casacore::IPosition &shape, bool value) : itsShape(shape),
+    itsNElements(shape.nelements() > 0 ? shape.product() : 0),
+    itsBits((itsNElements + 63) / 64, value ? ~uint64_t(0) : uint64_t(0))
+{
+}
+
+/// @brief pack the given mask
+/// @param[in] mask mask with one byte per pixel (true = good)
+PackedMask::PackedMask(const casacore::LogicalArray &mask) : itsShape(mask.shape()),
+    itsNElements(mask.nelements()), itsBits((itsNElements + 63) / 64, 0)
+{
+    bool deleteIt = false;
+    const bool *values = mask.getStorage(deleteIt);
+    pack(0, values, itsNElements);
+    mask.freeStorage(values, deleteIt);
+}
+
+/// @return number of pixels in a plane
+size_t PackedMask::planeSize() const
+{
+    if (itsShape.nelements() == 0) {
+        return 1;
+    }
+    return itsShape.nelements() == 1 ? itsShape[0] : itsShape[0] * itsShape[1];
+}
+
+/// @param[in] pos pixel position
+/// @return true, if the pixel is good
+bool PackedMask::operator()(const casacore::IPosition &pos) const
+{
+    ASKAPDEBUGASSERT(pos.nelements() == itsShape.nelements());
+    size_t index = 0;
+    size_t stride = 1;
+    for (casacore::uInt axis = 0; axis < itsShape.nelements(); ++axis) {
+         ASKAPDEBUGASSERT((pos[axis] >= 0) && (pos[axis] < itsShape[axis]));
+         index += pos[axis] * stride;
+         stride *= itsShape[axis];
+    }
+    return get(index);
+}
+
+/// @brief pack a run of byte-per-pixel values
+/// @param[in] start index of the first pixel
+/// @param[in] values mask values (true = good)
+/// @param[in] n number of values
+void PackedMask::pack(size_t start, const bool *values, size_t n)
+{
+    ASKAPCHECK(start + n <= itsNElements, "Unable to pack " << n << " values at " << start <<
+               " into the mask of " << itsNElements << " pixels");
+    size_t i = 0;
+    // up to the word boundary
+    for (; (i < n) && ((start + i) & 63); ++i) {
+         set(start + i, values[i]);
+    }
+    // whole words
+    for (; i + 64 <= n; i += 64) {
+         uint64_t word = 0;
+         for (size_t bit = 0; bit < 64; ++bit) {
+              word |= uint64_t(values[i + bit] ? 1 : 0) << bit;
+         }
+         itsBits[(start + i) >> 6] = word;
+    }
+    for (; i < n; ++i) {
+         set(start + i, values[i]);
+    }
+}
+
+/// @brief derive a run of values from the pixels
+/// @details Pixels which are not NaN are good (FITS convention)
+/// @param[in] start index of the first pixel
+/// @param[in] pixels pixel values
+/// @param[in] n number of pixels
+void PackedMask::packFinite(size_t start, const float *pixels, size_t n)
+{
+    ASKAPCHECK(start + n <= itsNElements, "Unable to pack " << n << " values at " << start <<
+               " into the mask of " << itsNElements << " pixels");
+    size_t i = 0;
+    for (; (i < n) && ((start + i) & 63); ++i) {
+         set(start + i, !std::isnan(pixels[i]));
+    }
+    for (; i + 64 <= n; i += 64) {
+         uint64_t word = 0;
+         for (size_t bit = 0; bit < 64; ++bit) {
+              // NaN is the only value which is not equal to itself
+              word |= uint64_t(pixels[i + bit] == pixels[i + bit] ? 1 : 0) << bit;
+         }
+         itsBits[(start + i) >> 6] = word;
+    }
+    for (; i < n; ++i) {
+         set(start + i, !std::isnan(pixels[i]));
+    }
+}
+
+/// @param[in] plane plane number
+/// @return summary of the mask of the plane
+PackedMask::PlaneState PackedMask::planeState(size_t plane) const
+{
+    ASKAPCHECK(plane < nPlanes(), "Plane " << plane << " is outside the mask with the shape " << itsShape);
+    const size_t size = planeSize();
+    const size_t valid = countValid(plane * size, size);
+    return valid == size ? ALL_VALID : (valid == 0 ? ALL_MASKED : PARTIAL);
+}
+
+/// @return number of good pixels
+size_t PackedMask::nValid() const
+{
+    return countValid(0, itsNElements);
+}
+
+/// @return mask with one byte per pixel
+casacore::LogicalArray PackedMask::toArray() const
+{
+    casacore::LogicalArray result(itsShape);
+    bool deleteIt = false;
+    bool *values = result.getStorage(deleteIt);
+    for (size_t i = 0; i < itsNElements; ++i) {
+         values[i] = get(i);
+    }
+    result.putStorage(values, deleteIt);
+    return result;
+}
+
+/// @brief summary of the given byte-per-pixel values
+/// @param[in] values mask values (true = good)
+/// @param[in] n number of values
+/// @return ALL_VALID, ALL_MASKED or PARTIAL
+PackedMask::PlaneState PackedMask::summary(const bool *values, size_t n)
+{
+    size_t valid = 0;
+    for (size_t i = 0; i < n; ++i) {
+         valid += values[i] ? 1 : 0;
+    }
+    return valid == n ? ALL_VALID : (valid == 0 ? ALL_MASKED : PARTIAL);
+}
+
+/// @brief count the good pixels in the range
+/// @param[in] start index of the first pixel
+/// @param[in] n number of pixels
+/// @return number of set bits
+size_t PackedMask::countValid(size_t start, size_t n) const
+{
+    size_t count = 0;
+    size_t i = start;
+    const size_t end = start + n;
+    for (; (i < end) && (i & 63); ++i) {
+         count += get(i) ? 1 : 0;
+    }
+    for (; i + 64 <= end; i += 64) {
+         count += __builtin_popcountll(itsBits[i >> 6]);
+    }
+    for (; i < end; ++i) {
+         count += get(i) ? 1 : 0;
+    }
+    return count;
+}
@@ -0,0 +1,153 @@
+/// @file PackedMask.h
+/// @brief Image mask stored with one bit per pixel
+/// @details casacore::LogicalArray takes a byte per pixel which is a lot for the
+/// mask of a large cube. This class packs the mask into 64-bit words and gives
+/// a quick summary of each plane (all pixels valid, all masked or mixed).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_PACKED_MASK_H
+#define ASKAP_ACCESSORS_PACKED_MASK_H
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Image mask stored with one bit per pixel
+/// @details The bits follow the pixels in the Fortran order, a set bit marks a good pixel.
+/// A plane is spanned by the first two axes (the first axis only for 1-dimensional masks),
+/// the planes are numbered in the Fortran order of the remaining axes.
+/// @ingroup imageaccess
+class PackedMask {
+public:
+    /// @brief summary of the mask of a plane
+    enum PlaneState {
+        /// @brief the plane has both good and masked pixels
+        PARTIAL = 0,
+        /// @brief all pixels of the plane are good
+        ALL_VALID,
+        /// @brief all pixels of the plane are masked
+        ALL_MASKED
+    };
+
+    /// @brief construct an empty mask
+    PackedMask();
+
+    /// @brief construct a mask of the given shape
+    /// @param[in] shape shape of the mask
+    /// @param[in] value initial value of all pixels (true = good)
+    explicit PackedMask(const casacore::IPosition &shape, bool value = true);
+
+    /// @brief pack the given mask
+    /// @param[in] mask mask with one byte per pixel (true = good)
+    explicit PackedMask(const casacore::LogicalArray &mask);
+
+    /// @return shape of the mask
+    inline const casacore::IPosition& shape() const { return itsShape; }
+
+    /// @return number of pixels
+    inline size_t nelements() const { return itsNElements; }
+
+    /// @return number of pixels in a plane
+    size_t planeSize() const;
+
+    /// @return number of planes
+    inline size_t nPlanes() const { return itsNElements > 0 ? itsNElements / planeSize() : 0; }
+
+    /// @param[in] index pixel index in the Fortran order
+    /// @return true, if the pixel is good
+    inline bool get(size_t index) const { return (itsBits[index >> 6] >> (index & 63)) & 1; }
+
+    /// @param[in] pos pixel position
+    /// @return true, if the pixel is good
+    bool operator()(const casacore::IPosition &pos) const;
+
+    /// @brief set the value of a pixel
+    /// @param[in] index pixel index in the Fortran order
+    /// @param[in] value true, if the pixel is good
+    inline void set(size_t index, bool value) {
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        itsBits[index >> 6] = value ? (itsBits[index >> 6] | bit) : (itsBits[index >> 6] & ~bit);
+    }
+
+    /// @brief pack a run of byte-per-pixel values
+    /// @param[in] start index of the first pixel
+    /// @param[in] values mask values (true = good)
+    /// @param[in] n number of values
+    void pack(size_t start, const bool *values, size_t n);
+
+    /// @brief derive a run of values from the pixels
+    /// @details Pixels which are not NaN are good (FITS convention)
+    /// @param[in] start index of the first pixel
+    /// @param[in] pixels pixel values
+    /// @param[in] n number of pixels
+    void packFinite(size_t start, const float *pixels, size_t n);
+
+    /// @param[in] plane plane number
+    /// @return summary of the mask of the plane
+    PlaneState planeState(size_t plane) const;
+
+    /// @return number of good pixels
+    size_t nValid() const;
+
+    /// @return mask with one byte per pixel
+    casacore::LogicalArray toArray() const;
+
+    /// @return memory taken by the bits in bytes
+    inline size_t memoryUsage() const { return itsBits.size() * sizeof(uint64_t); }
+
+    /// @brief summary of the given byte-per-pixel values
+    /// @param[in] values mask values (true = good)
+    /// @param[in] n number of values
+    /// @return ALL_VALID, ALL_MASKED or PARTIAL
+    static PlaneState summary(const bool *values, size_t n);
+
+private:
+    /// @brief count the good pixels in the range
+    /// @param[in] start index of the first pixel
+    /// @param[in] n number of pixels
+    /// @return number of set bits
+    size_t countValid(size_t start, size_t n) const;
+
+    /// @brief shape of the mask
+    casacore::IPosition itsShape;
+
+    /// @brief number of pixels
+    size_t itsNElements;
+
+    /// @brief packed bits
+    std::vector<uint64_t> itsBits;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_PACKED_MASK_H
@@ -0,0 +1,202 @@
+/// @file RegionCoalescer.cc
+/// @brief Merge many small image regions into a few large reads
+/// @details Source finding and quality assessment read many small, often overlapping cutouts
+/// of the same image. This class groups them, so each group is read at once.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#include <askap_accessors.h>
+
+#include <askap/askap/AskapError.h>
+#include <askap/imageaccess/RegionCoalescer.h>
+
+#include <algorithm>
+#include <list>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief order of the regions along the last axis
+/// @details The regions are compared by their bottom left corners, the last axis first.
+struct LastAxisOrder {
+    /// @brief set up the comparison
+    /// @param[in] regions regions to compare
+    explicit LastAxisOrder(const std::vector<PixelRegion> &regions) : itsRegions(regions) {}
+
+    /// @brief compare two regions given by their indices
+    /// @param[in] first index of the first region
+    /// @param[in] second index of the second region
+    /// @return true, if the first region goes before the second one
+    bool operator()(size_t first, size_t second) const
+    {
+        const casacore::IPosition &blc1 = itsRegions[first].first;
+        const casacore::IPosition &blc2 = itsRegions[second].first;
+        for (size_t axis = blc1.nelements(); axis > 0; --axis) {
+             if (blc1[axis - 1] != blc2[axis - 1]) {
+                 return blc1[axis - 1] < blc2[axis - 1];
+             }
+        }
+        return first < second;
+    }
+
+    /// @brief regions to compare
+    const std::vector<PixelRegion> &itsRegions;
+};
+
+} // anonymous namespace
+
+/// @brief default limit on the size of a merged read in pixels
+const size_t RegionCoalescer::theDefaultMaxPixels;
+
+/// @brief group the regions
+/// @param[in] regions regions to read, all of the same dimensionality
+/// @param[in] maxGap number of pixels between regions still merged (0 merges adjacent regions)
+/// @param[in] maxPixels maximum size of a merged read in pixels, 0 means no limit
+/// @return reads covering all regions, sorted along the last axis
+std::vector<RegionCoalescer::Read> RegionCoalescer::coalesce(const std::vector<PixelRegion> &regions,
+                                                             size_t maxGap, size_t maxPixels)
+{
+    std::vector<Read> result;
+    if (regions.empty()) {
+        return result;
+    }
+    const size_t nDim = regions[0].first.nelements();
+    ASKAPCHECK(nDim > 0, "Regions should have at least one dimension");
+    for (size_t index = 0; index < regions.size(); ++index) {
+         const PixelRegion &region = regions[index];
+         ASKAPCHECK((region.first.nelements() == nDim) && (region.second.nelements() == nDim),
+                    "Region " << index << " from " << region.first << " to " << region.second <<
+                    " doesn't have " << nDim << " dimensions");
+         ASKAPCHECK(region.first <= region.second, "Region " << index << " from " << region.first <<
+                    " to " << region.second << " is empty");
+    }
+    const size_t last = nDim - 1;
+    std::vector<size_t> order(regions.size());
+    for (size_t index = 0; index < order.size(); ++index) {
+         order[index] = index;
+    }
+    std::sort(order.begin(), order.end(), LastAxisOrder(regions));
+
+    // sweep along the last axis, the groups left behind can't be merged with further regions
+    std::list<size_t> open;
+    for (std::vector<size_t>::const_iterator ci = order.begin(); ci != order.end(); ++ci) {
+         const PixelRegion &region = regions[*ci];
+         for (std::list<size_t>::iterator it = open.begin(); it != open.end();) {
+              if (result[*it].itsRegion.second[last] + ssize_t(maxGap) + 1 < region.first[last]) {
+                  it = open.erase(it);
+              } else {
+                  ++it;
+              }
+         }
+         bool merged = false;
+         for (std::list<size_t>::const_iterator group = open.begin(); group != open.end(); ++group) {
+              Read &read = result[*group];
+              if (touching(read.itsRegion, region, maxGap)) {
+                  const PixelRegion box = boundingBox(read.itsRegion, region);
+                  if ((maxPixels == 0) || (nPixels(box) <= maxPixels)) {
+                      read.itsRegion = box;
+                      read.itsMembers.push_back(*ci);
+                      merged = true;
+                      break;
+                  }
+              }
+         }
+         if (!merged) {
+             Read read;
+             read.itsRegion = region;
+             read.itsMembers.push_back(*ci);
+             open.push_back(result.size());
+             result.push_back(read);
+         }
+    }
+
+    // growing groups may have reached each other, merge them until nothing changes
+    for (bool changed = true; changed;) {
+         changed = false;
+         for (size_t first = 0; first < result.size(); ++first) {
+              for (size_t second = first + 1; second < result.size(); ++second) {
+                   if (result[second].itsRegion.first[last] > result[first].itsRegion.second[last] + ssize_t(maxGap) + 1) {
+                       // the groups are sorted by the start along the last axis
+                       break;
+                   }
+                   if (touching(result[first].itsRegion, result[second].itsRegion, maxGap)) {
+                       const PixelRegion box = boundingBox(result[first].itsRegion, result[second].itsRegion);
+                       if ((maxPixels == 0) || (nPixels(box) <= maxPixels)) {
+                           result[first].itsRegion = box;
+                           result[first].itsMembers.insert(result[first].itsMembers.end(),
+                                          result[second].itsMembers.begin(), result[second].itsMembers.end());
+                           result.erase(result.begin() + second);
+                           changed = true;
+                           --second;
+                       }
+                   }
+              }
+         }
+    }
+    return result;
+}
+
+/// @brief number of pixels in the region
+/// @param[in] region region
+/// @return number of pixels
+size_t RegionCoalescer::nPixels(const PixelRegion &region)
+{
+    return size_t((region.second - region.first + 1).product());
+}
+
+/// @brief check whether the regions can be merged
+/// @param[in] first first region
+/// @param[in] second second region
+/// @param[in] maxGap number of pixels between regions still merged
+/// @return true, if the regions overlap or are within maxGap pixels from each other along all axes
+bool RegionCoalescer::touching(const PixelRegion &first, const PixelRegion &second, size_t maxGap)
+{
+    const ssize_t reach = ssize_t(maxGap) + 1;
+    for (size_t axis = 0; axis < first.first.nelements(); ++axis) {
+         if ((second.first[axis] > first.second[axis] + reach) || (first.first[axis] > second.second[axis] + reach)) {
+             return false;
+         }
+    }
+    return true;
+}
+
+/// @brief bounding box of two regions
+/// @param[in] first first region
+/// @param[in] second second region
+/// @return the smallest region containing both
+PixelRegion RegionCoalescer::boundingBox(const PixelRegion &first, const PixelRegion &second)
+{
+    PixelRegion result(first);
+    for (size_t axis = 0; axis < first.first.nelements(); ++axis) {
+         result.first[axis] = std::min(first.first[axis], second.first[axis]);
+         result.second[axis] = std::max(first.second[axis], second.second[axis]);
+    }
+    return result;
+}
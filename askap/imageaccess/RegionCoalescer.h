@@ -0,0 +1,129 @@
+/// @file RegionCoalescer.h
+/// @brief Merge many small image regions into a few large reads
+/// @details Source finding and quality assessment read many small, often overlapping cutouts
+/// of the same image. This class groups them, so each group is read at once.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#ifndef ASKAP_ACCESSORS_REGION_COALESCER_H
+#define ASKAP_ACCESSORS_REGION_COALESCER_H
+
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Array.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief region of an image given by its bottom left and top right corners (inclusive)
+typedef std::pair<casacore::IPosition, casacore::IPosition> PixelRegion;
+
+/// @brief Merge many small image regions into a few large reads
+/// @details Regions which overlap or are closer than the given gap along all axes are merged
+/// into their bounding box, as long as the box doesn't exceed the given number of pixels. The
+/// regions are sorted along the last (slowest varying) axis first, so only the groups which can
+/// still be reached have to be checked, and the resulting reads follow the storage order.
+/// A region larger than the limit is read on its own.
+/// @ingroup imageaccess
+struct RegionCoalescer {
+
+    /// @brief read covering one or more regions
+    struct Read {
+        /// @brief bounding box of the regions
+        PixelRegion itsRegion;
+        /// @brief indices of the regions covered (in the order of the regions given)
+        std::vector<size_t> itsMembers;
+    };
+
+    /// @brief default limit on the size of a merged read in pixels
+    static const size_t theDefaultMaxPixels = 16u * 1024u * 1024u;
+
+    /// @brief group the regions
+    /// @param[in] regions regions to read, all of the same dimensionality
+    /// @param[in] maxGap number of pixels between regions still merged (0 merges adjacent regions)
+    /// @param[in] maxPixels maximum size of a merged read in pixels, 0 means no limit
+    /// @return reads covering all regions, sorted along the last axis
+    static std::vector<Read> coalesce(const std::vector<PixelRegion> &regions, size_t maxGap = 0,
+                                      size_t maxPixels = theDefaultMaxPixels);
+
+    /// @brief copy the pixels of the regions out of a merged read
+    /// @param[in] read merged read
+    /// @param[in] pixels pixels of the merged read
+    /// @param[in] regions all regions
+    /// @param[out] result one array per region, the members of the read are assigned
+    template <class T>
+    static void scatter(const Read &read, const casacore::Array<T> &pixels, const std::vector<PixelRegion> &regions,
+                        std::vector<casacore::Array<T> > &result);
+
+    /// @brief number of pixels in the region
+    /// @param[in] region region
+    /// @return number of pixels
+    static size_t nPixels(const PixelRegion &region);
+
+    /// @brief check whether the regions can be merged
+    /// @param[in] first first region
+    /// @param[in] second second region
+    /// @param[in] maxGap number of pixels between regions still merged
+    /// @return true, if the regions overlap or are within maxGap pixels from each other along all axes
+    static bool touching(const PixelRegion &first, const PixelRegion &second, size_t maxGap);
+
+    /// @brief bounding box of two regions
+    /// @param[in] first first region
+    /// @param[in] second second region
+    /// @return the smallest region containing both
+    static PixelRegion boundingBox(const PixelRegion &first, const PixelRegion &second);
+};
+
+/// @brief copy the pixels of the regions out of a merged read
+/// @param[in] read merged read
+/// @param[in] pixels pixels of the merged read
+/// @param[in] regions all regions
+/// @param[out] result one array per region, the members of the read are assigned
+template <class T>
+void RegionCoalescer::scatter(const Read &read, const casacore::Array<T> &pixels,
+                              const std::vector<PixelRegion> &regions, std::vector<casacore::Array<T> > &result)
+{
+    const casacore::IPosition &origin = read.itsRegion.first;
+    for (std::vector<size_t>::const_iterator ci = read.itsMembers.begin(); ci != read.itsMembers.end(); ++ci) {
+         const PixelRegion &region = regions[*ci];
+         if (read.itsMembers.size() == 1) {
+             result[*ci].reference(pixels);
+         } else {
+             // the copy doesn't keep the whole merged read in memory
+             result[*ci] = pixels(region.first - origin, region.second - origin).copy();
+         }
+    }
+}
+
+} // namespace accessors
+} // namespace askap
+
+#endif
@@ -0,0 +1,325 @@
+/// @file SharedImageReader.cc
+/// @brief Thread-safe read-only image access
+/// @details The header of each image is read once and shared, the pixels are read from
+/// a shared memory map or through a pool of accessors.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/imageaccess/SharedImageReader.h>
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+
+ASKAP_LOGGER(logger, ".SharedImageReader");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief accessor taken from the pool for the duration of a read
+/// @details An idle accessor is taken from the pool (or a new one is created) on construction
+/// and returned to the pool on destruction. For CASA images, the lock serialising the reads is
+/// held as long as the lease exists. The header of the image is parsed by the accessor under
+/// the header lock when another image has been read last.
+class SharedImageReader::Lease : public boost::noncopyable {
+public:
+    /// @brief take an accessor from the pool
+    /// @param[in] reader reader owning the pool
+    /// @param[in] name image to be read
+    Lease(const SharedImageReader &reader, const std::string &name) : itsReader(reader)
+    {
+        if (!itsReader.itsIsFits) {
+            itsCasaLock = boost::unique_lock<boost::mutex>(itsReader.itsCasaMutex);
+        }
+        {
+            boost::lock_guard<boost::mutex> lock(itsReader.itsMutex);
+            if (itsReader.itsIdle.size() > 0) {
+                itsEntry = itsReader.itsIdle.back();
+                itsReader.itsIdle.pop_back();
+            }
+        }
+        try {
+           if (!itsEntry.itsAccessor) {
+               itsEntry.itsAccessor = imageAccessFactory(itsReader.itsParset);
+               ASKAPDEBUGASSERT(itsEntry.itsAccessor);
+               boost::lock_guard<boost::mutex> lock(itsReader.itsMutex);
+               ++itsReader.itsNAccessors;
+           }
+           if (itsEntry.itsLastImage != name) {
+               // the accessor keeps the parsed header, so it is set up before the actual read
+               boost::lock_guard<boost::mutex> lock(itsReader.itsHeaderMutex);
+               itsEntry.itsLastImage.clear();
+               itsEntry.itsAccessor->shape(name);
+               itsEntry.itsAccessor->coordSys(name);
+               itsEntry.itsLastImage = name;
+           }
+        }
+        catch (...) {
+           release();
+           throw;
+        }
+    }
+
+    /// @brief return the accessor to the pool
+    ~Lease() { release(); }
+
+    /// @return accessor
+    inline IImageAccess<casacore::Float>& accessor() const
+    {
+        ASKAPDEBUGASSERT(itsEntry.itsAccessor);
+        return *itsEntry.itsAccessor;
+    }
+
+private:
+    /// @brief return the accessor to the pool
+    void release()
+    {
+        if (itsEntry.itsAccessor) {
+            boost::lock_guard<boost::mutex> lock(itsReader.itsMutex);
+            itsReader.itsIdle.push_back(itsEntry);
+            itsEntry = PooledAccessor();
+        }
+    }
+
+    /// @brief reader owning the pool
+    const SharedImageReader &itsReader;
+
+    /// @brief accessor taken from the pool
+    PooledAccessor itsEntry;
+
+    /// @brief lock serialising the reads of CASA images (not used for FITS)
+    boost::unique_lock<boost::mutex> itsCasaLock;
+};
+
+/// @brief set up the reader
+/// @param[in] parset accessor parameters (imagetype, etc), see imageAccessFactory
+SharedImageReader::SharedImageReader(const LOFAR::ParameterSet &parset) :
+    itsParset(parset), itsIsFits(parset.getString("imagetype", "casa") == "fits"),
+    itsUseMemoryMap(parset.getBool("imagememorymap", true)), itsNAccessors(0)
+{
+    // the pooled accessors only read images which can't be mapped
+    itsParset.replace("imagememorymap", "false");
+}
+
+/// @brief obtain the header of the given image
+/// @details The header is read on first access.
+/// @param[in] name image name
+/// @return shared pointer to the header
+boost::shared_ptr<SharedImageReader::Header const> SharedImageReader::header(const std::string &name) const
+{
+    {
+        boost::lock_guard<boost::mutex> lock(itsMutex);
+        const std::map<std::string, boost::shared_ptr<Header const> >::const_iterator ci = itsHeaders.find(name);
+        if (ci != itsHeaders.end()) {
+            return ci->second;
+        }
+    }
+    boost::shared_ptr<Header> result(new Header);
+    {
+        Lease lease(*this, name);
+        result->itsShape = lease.accessor().shape(name);
+        result->itsCoordSys = lease.accessor().coordSys(name);
+    }
+    if (itsIsFits && itsUseMemoryMap) {
+        const std::string fullname = name + ".fits";
+        boost::lock_guard<boost::mutex> lock(itsHeaderMutex);
+        boost::shared_ptr<FitsMappedImage> map(new FitsMappedImage(fullname));
+        if (map->isMapped()) {
+            ASKAPCHECK(map->shape() == result->itsShape, "Shape of the mapped image " << fullname << " (" <<
+                       map->shape() << ") doesn't match the header (" << result->itsShape << ")");
+            result->itsMap = map;
+        } else {
+            ASKAPLOG_DEBUG_STR(logger, "Image " << fullname << " can't be mapped, it is read through the accessors");
+        }
+    }
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    // another thread may have read the header in the meantime, the first one is kept
+    const std::pair<std::map<std::string, boost::shared_ptr<Header const> >::iterator, bool> res =
+          itsHeaders.insert(std::make_pair(name, boost::shared_ptr<Header const>(result)));
+    return res.first->second;
+}
+
+/// @brief obtain the shape
+/// @param[in] name image name
+/// @return full shape of the given image
+casacore::IPosition SharedImageReader::shape(const std::string &name) const
+{
+    return header(name)->itsShape;
+}
+
+/// @brief obtain coordinate system info
+/// @param[in] name image name
+/// @return coordinate system object
+casacore::CoordinateSystem SharedImageReader::coordSys(const std::string &name) const
+{
+    return header(name)->itsCoordSys;
+}
+
+/// @brief obtain coordinate system info for part of an image
+/// @details The coordinates are derived from the shared header, see IImageAccess::sliceCoordSys.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return coordinate system object
+casacore::CoordinateSystem SharedImageReader::coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+                                                            const casacore::IPosition &trc) const
+{
+    const boost::shared_ptr<Header const> hdr = header(name);
+    return IImageAccess<casacore::Float>::sliceCoordSys(hdr->itsCoordSys, hdr->itsShape, blc, trc);
+}
+
+/// @brief read part of the image
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @return array with pixels for the selection only
+casacore::Array<float> SharedImageReader::read(const std::string &name, const casacore::IPosition &blc,
+                                               const casacore::IPosition &trc) const
+{
+    casacore::Array<float> result;
+    readInto(name, blc, trc, result);
+    return result;
+}
+
+/// @brief read part of the image into the given buffer
+/// @details The buffer is only resized if its shape doesn't match the selection.
+/// @param[in] name image name
+/// @param[in] blc bottom left corner of the selection
+/// @param[in] trc top right corner of the selection (inclusive)
+/// @param[out] buffer array to fill with pixels for the selection
+void SharedImageReader::readInto(const std::string &name, const casacore::IPosition &blc,
+                                 const casacore::IPosition &trc, casacore::Array<float> &buffer) const
+{
+    const boost::shared_ptr<Header const> hdr = header(name);
+    if (hdr->itsMap) {
+        // the map is read-only, the reads don't need any locking
+        hdr->itsMap->read(blc, trc, buffer);
+        return;
+    }
+    Lease lease(*this, name);
+    lease.accessor().readInto(name, blc, trc, buffer);
+}
+
+/// @brief read many parts of the image
+/// @details Overlapping and adjacent regions (or those within maxGap pixels) are merged into
+/// larger reads (see RegionCoalescer). The merged reads are shared between the given number
+/// of threads, which take them in the storage order.
+/// @param[in] name image name
+/// @param[in] regions bottom left and top right corners of the selections
+/// @param[in] nThreads number of threads doing the merged reads
+/// @param[in] maxGap number of pixels between the regions still read together
+/// @return array with pixels for each region, in the order of the regions
+std::vector<casacore::Array<float> > SharedImageReader::readMany(const std::string &name,
+                   const std::vector<PixelRegion> &regions, size_t nThreads, size_t maxGap) const
+{
+    ASKAPCHECK(nThreads > 0, "readMany needs at least one thread, you have " << nThreads);
+    const std::vector<RegionCoalescer::Read> reads = RegionCoalescer::coalesce(regions, maxGap);
+    ASKAPLOG_DEBUG_STR(logger, "Reading " << regions.size() << " region(s) of " << name << " in " << reads.size() <<
+                       " merged read(s)");
+    std::vector<casacore::Array<float> > result(regions.size());
+    std::atomic<size_t> next(0);
+    nThreads = std::min(nThreads, reads.size());
+    if (nThreads <= 1) {
+        std::exception_ptr error;
+        readMerged(name, reads, regions, next, result, error);
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return result;
+    }
+    // make sure the header is read before the threads start
+    header(name);
+    std::vector<std::exception_ptr> errors(nThreads);
+    boost::thread_group threads;
+    for (size_t thread = 0; thread < nThreads; ++thread) {
+         threads.create_thread(boost::bind(&SharedImageReader::readMerged, this, boost::cref(name), boost::cref(reads),
+                          boost::cref(regions), boost::ref(next), boost::ref(result), boost::ref(errors[thread])));
+    }
+    threads.join_all();
+    for (std::vector<std::exception_ptr>::const_iterator ci = errors.begin(); ci != errors.end(); ++ci) {
+         if (*ci) {
+             std::rethrow_exception(*ci);
+         }
+    }
+    return result;
+}
+
+/// @brief body of the threads doing the merged reads for readMany
+/// @details Errors are stored to be rethrown in the calling thread.
+/// @param[in] name image name
+/// @param[in] reads merged reads
+/// @param[in] regions regions requested
+/// @param[in] next index of the next merged read to do, shared between the threads
+/// @param[out] result array with pixels for each region
+/// @param[out] error first error encountered by this thread
+void SharedImageReader::readMerged(const std::string &name, const std::vector<RegionCoalescer::Read> &reads,
+                                   const std::vector<PixelRegion> &regions, std::atomic<size_t> &next,
+                                   std::vector<casacore::Array<float> > &result, std::exception_ptr &error) const
+{
+    try {
+        for (size_t index = next++; index < reads.size(); index = next++) {
+             const RegionCoalescer::Read &merged = reads[index];
+             // every read gets its own array, the regions refer to it or are copied out
+             RegionCoalescer::scatter(merged, read(name, merged.itsRegion.first, merged.itsRegion.second),
+                                      regions, result);
+        }
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+}
+
+/// @brief drop the cached header and map of the given image
+/// @details This has to be called if the image has been modified or replaced. Reads
+/// already in progress are completed with the old map, idle accessors which have read
+/// the image are dropped.
+/// @param[in] name image name
+void SharedImageReader::forget(const std::string &name)
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    itsHeaders.erase(name);
+    // the idle accessors may keep the old header too, they are recreated when needed
+    for (std::vector<PooledAccessor>::iterator it = itsIdle.begin(); it != itsIdle.end();) {
+         if (it->itsLastImage == name) {
+             it = itsIdle.erase(it);
+         } else {
+             ++it;
+         }
+    }
+}
+
+/// @return number of accessors created so far (i.e. the peak number of concurrent reads
+/// which couldn't use the shared map, unless forget has been called)
+size_t SharedImageReader::nAccessors() const
+{
+    boost::lock_guard<boost::mutex> lock(itsMutex);
+    return itsNAccessors;
+}
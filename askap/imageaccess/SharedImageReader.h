@@ -0,0 +1,207 @@
+/// @file SharedImageReader.h
+/// @brief Thread-safe read-only image access
+/// @details Neither FitsImageAccess nor CasaImageAccess can be used from several threads at
+/// once as they keep open handles and parsed headers in mutable members. This class is
+/// shared by the threads of cutout and QA tools doing concurrent reads of the same images.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SHARED_IMAGE_READER_H
+#define ASKAP_ACCESSORS_SHARED_IMAGE_READER_H
+
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/FitsMappedImage.h>
+#include <askap/imageaccess/RegionCoalescer.h>
+
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+
+#include <Common/ParameterSet.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
+#include <exception>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Thread-safe read-only image access
+/// @details All methods can be called concurrently. The shape and coordinate system of each
+/// image are read once and shared by all threads, the images are assumed not to change while
+/// they are read (see forget).
+///
+/// Uncompressed FITS images which can be memory mapped (see FitsMappedImage) are read from a
+/// single map shared by all threads without any locking. Other FITS images are read through
+/// a pool of accessors, each thread takes an idle accessor (with its own file handle) for the
+/// duration of a read, so the pool grows up to the number of concurrent readers. casacore
+/// tables opened several times in the same process share their internal state, so CASA images
+/// are read through a single accessor and the reads are serialised.
+///
+/// The accessors are set up with imageAccessFactory from the parset given at construction.
+/// @ingroup imageaccess
+class SharedImageReader : public boost::noncopyable {
+public:
+    /// @brief set up the reader
+    /// @param[in] parset accessor parameters (imagetype, etc), see imageAccessFactory
+    explicit SharedImageReader(const LOFAR::ParameterSet &parset);
+
+    /// @brief obtain the shape
+    /// @param[in] name image name
+    /// @return full shape of the given image
+    casacore::IPosition shape(const std::string &name) const;
+
+    /// @brief obtain coordinate system info
+    /// @param[in] name image name
+    /// @return coordinate system object
+    casacore::CoordinateSystem coordSys(const std::string &name) const;
+
+    /// @brief obtain coordinate system info for part of an image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @return coordinate system object
+    casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+                                             const casacore::IPosition &trc) const;
+
+    /// @brief read part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @return array with pixels for the selection only
+    casacore::Array<float> read(const std::string &name, const casacore::IPosition &blc,
+                                const casacore::IPosition &trc) const;
+
+    /// @brief read part of the image into the given buffer
+    /// @details The buffer is only resized if its shape doesn't match the selection.
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @param[out] buffer array to fill with pixels for the selection
+    void readInto(const std::string &name, const casacore::IPosition &blc,
+                  const casacore::IPosition &trc, casacore::Array<float> &buffer) const;
+
+    /// @brief read many parts of the image
+    /// @details Overlapping and adjacent regions (or those within maxGap pixels) are merged into
+    /// larger reads (see RegionCoalescer). The merged reads are shared between the given number
+    /// of threads, which take them in the storage order.
+    /// @param[in] name image name
+    /// @param[in] regions bottom left and top right corners of the selections
+    /// @param[in] nThreads number of threads doing the merged reads
+    /// @param[in] maxGap number of pixels between the regions still read together
+    /// @return array with pixels for each region, in the order of the regions
+    std::vector<casacore::Array<float> > readMany(const std::string &name, const std::vector<PixelRegion> &regions,
+                                                  size_t nThreads = 1, size_t maxGap = 0) const;
+
+    /// @brief drop the cached header and map of the given image
+    /// @details This has to be called if the image has been modified or replaced. Reads
+    /// already in progress are completed with the old map, idle accessors which have read
+    /// the image are dropped.
+    /// @param[in] name image name
+    void forget(const std::string &name);
+
+    /// @return number of accessors created so far (i.e. the peak number of concurrent reads
+    /// which couldn't use the shared map, unless forget has been called)
+    size_t nAccessors() const;
+
+private:
+    /// @brief header information shared by all threads
+    struct Header {
+        /// @brief shape of the image
+        casacore::IPosition itsShape;
+        /// @brief coordinate system of the image
+        casacore::CoordinateSystem itsCoordSys;
+        /// @brief shared map, empty if the image can't be mapped
+        boost::shared_ptr<FitsMappedImage const> itsMap;
+    };
+
+    /// @brief accessor of the pool
+    struct PooledAccessor {
+        /// @brief accessor
+        boost::shared_ptr<IImageAccess<casacore::Float> > itsAccessor;
+        /// @brief image read last, its header is cached by the accessor
+        std::string itsLastImage;
+    };
+
+    /// @brief accessor taken from the pool for the duration of a read
+    class Lease;
+
+    /// @brief obtain the header of the given image
+    /// @details The header is read on first access.
+    /// @param[in] name image name
+    /// @return shared pointer to the header
+    boost::shared_ptr<Header const> header(const std::string &name) const;
+
+    /// @brief body of the threads doing the merged reads for readMany
+    /// @details Errors are stored to be rethrown in the calling thread.
+    /// @param[in] name image name
+    /// @param[in] reads merged reads
+    /// @param[in] regions regions requested
+    /// @param[in] next index of the next merged read to do, shared between the threads
+    /// @param[out] result array with pixels for each region
+    /// @param[out] error first error encountered by this thread
+    void readMerged(const std::string &name, const std::vector<RegionCoalescer::Read> &reads,
+                    const std::vector<PixelRegion> &regions, std::atomic<size_t> &next,
+                    std::vector<casacore::Array<float> > &result, std::exception_ptr &error) const;
+
+    /// @brief accessor parameters
+    LOFAR::ParameterSet itsParset;
+
+    /// @brief true for FITS images
+    bool itsIsFits;
+
+    /// @brief true, if FITS images are read through a memory map where possible
+    bool itsUseMemoryMap;
+
+    /// @brief headers of the images accessed so far
+    mutable std::map<std::string, boost::shared_ptr<Header const> > itsHeaders;
+
+    /// @brief idle accessors
+    mutable std::vector<PooledAccessor> itsIdle;
+
+    /// @brief number of accessors created so far
+    mutable size_t itsNAccessors;
+
+    /// @brief protects the header cache and the pool
+    mutable boost::mutex itsMutex;
+
+    /// @brief serialises header parsing (casacore and cfitsio set-up is not guaranteed to be reentrant)
+    mutable boost::mutex itsHeaderMutex;
+
+    /// @brief serialises reads of CASA images
+    mutable boost::mutex itsCasaMutex;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SHARED_IMAGE_READER_H
@@ -0,0 +1,390 @@
+/// @file StagedImageAccess.h
+/// @brief Image access through fast staging storage
+/// @details This class wraps another image accessor, so the images are written to node-local
+/// storage (e.g. NVMe or a burst buffer) and copied to their final destination in the background.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#ifndef ASKAP_ACCESSORS_STAGED_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_STAGED_IMAGE_ACCESS_H
+
+#include <askap/imageaccess/IImageAccess.h>
+#include <askap/imageaccess/ImageDrain.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Image access through fast staging storage
+/// @details Writing large cubes straight to the shared file system stalls the imager when the
+/// file system is busy. This accessor creates the images in the staging directory on fast local
+/// storage through the wrapped accessor instead, and copies them to the final name in the
+/// background once they are complete (see ImageDrain). Images are known by their final names,
+/// the staging is transparent to the caller:
+/// - create stages the image, it is written and read in the staging directory afterwards;
+/// - drain (or drainAll) closes the image in the wrapped accessor and starts the transfer,
+///   modifying the image is an error until the transfer is finished and reading waits for it;
+/// - the image is durable (see isDurable, waitDurable) once the copy at the final name is
+///   verified, afterwards the image is accessed at its final name again;
+/// - images which haven't been created through this accessor are accessed at their final name.
+///
+/// The images still staged are drained when the accessor is destroyed, the destructor waits for
+/// all transfers. If a transfer fails, the staged copy is kept and can be drained again.
+/// The statistics and the array allocator should be set up on the wrapped accessor.
+/// The accessor is not thread-safe, as the wrapped accessors are not, although the transfers
+/// run in parallel (at most maxDrains at a time).
+/// @ingroup imageaccess
+template <class T = casacore::Float>
+struct StagedImageAccess : public IImageAccess<T> {
+
+    /// @brief set up the accessor
+    /// @param[in] accessor accessor to work with the staged images
+    /// @param[in] stagingDir directory on fast storage for the staged images (created if necessary)
+    /// @param[in] maxDrains maximum number of images transferred at the same time
+    StagedImageAccess(const boost::shared_ptr<IImageAccess<T> > &accessor, const std::string &stagingDir,
+                      size_t maxDrains = 2);
+
+    /// @brief destructor, drains the staged images and waits for the transfers
+    virtual ~StagedImageAccess();
+
+    /// @return wrapped accessor
+    inline const boost::shared_ptr<IImageAccess<T> >& accessor() const { return itsAccessor; }
+
+    /// @return directory for the staged images
+    inline const std::string& stagingDirectory() const { return itsDrain.stagingDirectory(); }
+
+    /// @brief start the transfer of the image to its final name
+    /// @details The image is closed in the wrapped accessor first. The image should have been
+    /// created through this accessor, images which failed to drain are transferred again.
+    /// @param[in] name image name
+    void drain(const std::string &name);
+
+    /// @brief start the transfer of all staged images
+    void drainAll();
+
+    /// @brief obtain the state of the image
+    /// @param[in] name image name
+    /// @return state of the image (see ImageDrain::State)
+    ImageDrain::State drainState(const std::string &name) const;
+
+    /// @brief check whether the image is at its final destination
+    /// @param[in] name image name
+    /// @return true, if the transfer has been completed and verified
+    bool isDurable(const std::string &name) const;
+
+    /// @brief wait for the transfer of the image to finish
+    /// @details The method returns straight away if the image is not being drained.
+    /// @param[in] name image name
+    /// @param[in] timeout maximum time to wait in seconds, negative value means no limit
+    /// @return true, if the image is durable
+    bool waitDurable(const std::string &name, double timeout = -1.) const;
+
+    /// @brief wait for all transfers to finish
+    /// @return true, if none of the transfers has failed
+    bool waitAll() const;
+
+    /// @brief obtain the reason of the failure
+    /// @param[in] name image name
+    /// @return error message of the last transfer, empty if it hasn't failed
+    std::string drainError(const std::string &name) const;
+
+    /// @return number of bytes transferred and verified so far
+    inline size_t bytesDrained() const { return itsDrain.bytesDrained(); }
+
+    //////////////////
+    // Reading methods
+    //////////////////
+
+    /// @brief obtain the shape
+    /// @param[in] name image name
+    /// @return full shape of the given image
+    virtual casacore::IPosition shape(const std::string &name) const override;
+
+    /// @brief read full image
+    /// @param[in] name image name
+    /// @return array with pixels
+    virtual casacore::Array<T> read(const std::string &name) const override;
+
+    /// @brief read part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return array with pixels for the selection only
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc) const override;
+
+    /// @brief read every stride-th pixel of part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[in] stride increment along each axis (1 to take all pixels)
+    /// @return array with (trc - blc) / stride + 1 pixels along each axis
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc, const casacore::IPosition &stride) const override;
+
+    /// @brief read part of the image into the given buffer
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with pixels for the selection
+    virtual void readInto(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<T> &buffer) const override;
+
+    /// @brief Determine whether an image has a mask
+    /// @param[in] nam image name
+    /// @return True if image has a mask, False if not.
+    virtual bool isMasked(const std::string &name) const override;
+
+    /// @brief read the mask for the full image
+    /// @param[in] name image name
+    /// @return bool array with mask values - 1=good, 0=bad
+    virtual casacore::LogicalArray readMask(const std::string &name) const override;
+
+    /// @brief read the mask for part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return bool array with mask values - 1=good, 0=bad
+    virtual casacore::LogicalArray readMask(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc) const override;
+
+    /// @brief read the mask for part of the image into the given buffer
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with mask values - 1=good, 0=bad
+    virtual void readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                              const casacore::IPosition &trc, casacore::LogicalArray &buffer) const override;
+
+    /// @brief read the mask for part of the image with one bit per pixel
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return packed mask for the selection (set bit = good pixel)
+    virtual PackedMask readPackedMask(const std::string &name, const casacore::IPosition &blc,
+                                      const casacore::IPosition &trc) const override;
+
+    /// @brief obtain the summary of the mask of an image plane
+    /// @param[in] name image name
+    /// @param[in] plane plane number
+    /// @return PackedMask::ALL_VALID, PackedMask::ALL_MASKED or PackedMask::PARTIAL
+    virtual PackedMask::PlaneState maskPlaneState(const std::string &name, size_t plane) const override;
+
+    /// @brief obtain coordinate system info
+    /// @param[in] name image name
+    /// @return coordinate system object
+    virtual casacore::CoordinateSystem coordSys(const std::string &name) const override;
+
+    /// @brief obtain coordinate system info for part of an image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @return coordinate system object
+    virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+            const casacore::IPosition &trc) const override;
+
+    /// @brief obtain beam info
+    /// @param[in] name image name
+    /// @return beam info vector
+    virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const override;
+
+    /// @brief obtain beam info
+    /// @param[in] name image name
+    /// @return beam info list
+    virtual BeamList beamList(const std::string &name) const override;
+
+    /// @brief obtain the restoring beam of a single channel
+    /// @param[in] name image name
+    /// @param[in] chan channel number
+    /// @return beam info vector
+    virtual casacore::Vector<casacore::Quantum<double> > channelBeam(const std::string &name,
+                                                                     unsigned int chan) const override;
+
+    /// @brief obtain pixel units
+    /// @param[in] name image name
+    /// @return units string
+    virtual std::string getUnits(const std::string &name) const override;
+
+    /// @brief Get a particular keyword from the image metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keyword The name of the metadata keyword
+    /// @return pair of strings - keyword value and comment
+    virtual std::pair<std::string, std::string> getMetadataKeyword(const std::string &name,
+                                                                   const std::string &keyword) const override;
+
+    /// @brief obtain a snapshot of the image metadata
+    /// @param[in] name image name
+    /// @return shared pointer to the snapshot
+    virtual boost::shared_ptr<const ImageMetadata> metadata(const std::string &name) const override;
+
+    /// @brief this method reads the table(s) set by setInfo
+    /// @param[in] name image name
+    /// @param[in] tableName table name, "All" gets all the tables
+    /// @param[out] info record to add the tables to
+    virtual void getInfo(const std::string &name, const std::string& tableName, casacore::Record &info) override;
+
+    //////////////////
+    // Writing methods
+    //////////////////
+
+    /// @brief create a new image
+    /// @details The image is created in the staging directory.
+    /// @param[in] name image name
+    /// @param[in] shape full shape of the image
+    /// @param[in] csys coordinate system of the full image
+    virtual void create(const std::string &name, const casacore::IPosition &shape,
+                        const casacore::CoordinateSystem &csys) override;
+
+    /// @brief write full image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    virtual void write(const std::string &name, const casacore::Array<T> &arr) override;
+
+    /// @brief write a slice of an image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image and mask
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::Array<bool> &mask, const casacore::IPosition &where) override;
+
+    /// @brief add pixels to a slice of an image
+    /// @details The region lock is taken by the wrapped accessor on the staged image.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels to add
+    /// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+    virtual void addInto(const std::string &name, const casacore::Array<T> &arr,
+                         const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image mask
+    /// @param[in] name image name
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                           const casacore::IPosition &where) override;
+
+    /// @brief write an image mask
+    /// @param[in] name image name
+    /// @param[in] mask array with mask
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask) override;
+
+    /// @brief set brightness units of the image
+    /// @param[in] name image name
+    /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+    virtual void setUnits(const std::string &name, const std::string &units) override;
+
+    /// @brief set restoring beam info
+    /// @param[in] name image name
+    /// @param[in] maj major axis in radians
+    /// @param[in] min minor axis in radians
+    /// @param[in] pa position angle in radians
+    virtual void setBeamInfo(const std::string &name, double maj, double min, double pa) override;
+
+    /// @brief set restoring beam info for all channels
+    /// @param[in] name image name
+    /// @param[in] beamlist The list of beams
+    virtual void setBeamInfo(const std::string &name, const BeamList & beamlist) override;
+
+    /// @brief assign the default mask
+    /// @param[in] name image name
+    virtual void makeDefaultMask(const std::string &name) override;
+
+    /// @brief Set a particular keyword for the metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keyword The name of the metadata keyword
+    /// @param[in] value The value for the keyword, in string format
+    /// @param[in] desc A description of the keyword
+    virtual void setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                    const std::string value, const std::string &desc = "") override;
+
+    /// @brief Set the keywords for the metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keywords A parset with keyword entries (KEYWORD = ["keyword value","keyword description","STRING"])
+    virtual void setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords) override;
+
+    /// @brief Add HISTORY messages to the image metadata
+    /// @param[in] name Image name
+    /// @param[in] historyLines History comments to add
+    virtual void addHistory(const std::string &name, const std::vector<std::string> &historyLines) override;
+
+    /// @brief this method stores the table given as a sub-record of info with the image
+    /// @param[in] name image name
+    /// @param[in] info record to be stored
+    virtual void setInfo(const std::string &name, const casacore::RecordInterface & info) override;
+
+    /// @brief start a batch of header updates
+    /// @param[in] name image name
+    virtual void beginHeaderUpdate(const std::string &name) override;
+
+    /// @brief write the header changes staged since beginHeaderUpdate
+    /// @param[in] name image name
+    virtual void commitHeaderUpdate(const std::string &name) override;
+
+private:
+    /// @brief name to read the image with
+    /// @param[in] name image name
+    /// @return name passed to the wrapped accessor
+    inline std::string readLocation(const std::string &name) const { return itsDrain.location(name, false); }
+
+    /// @brief name to modify the image with
+    /// @param[in] name image name
+    /// @return name passed to the wrapped accessor
+    inline std::string writeLocation(const std::string &name) const { return itsDrain.location(name, true); }
+
+    /// @brief make sure the wrapped accessor doesn't hold the image
+    /// @details Pending changes are written and the files are closed, so they can be copied.
+    /// The accessors without the means to close a single image are flushed or closed completely.
+    /// The blocks buffered by WriteCombiningImageAccess are written before the wrapped accessor
+    /// is released.
+    /// @param[in] accessor accessor holding the image
+    /// @param[in] stagedName name of the image in the staging directory
+    static void releaseImage(IImageAccess<T> &accessor, const std::string &stagedName);
+
+    /// @brief wrapped accessor
+    boost::shared_ptr<IImageAccess<T> > itsAccessor;
+
+    /// @brief transfer of the staged images, destroyed before the wrapped accessor
+    ImageDrain itsDrain;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#include "StagedImageAccess.tcc"
+#endif
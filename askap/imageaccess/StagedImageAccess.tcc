@@ -0,0 +1,416 @@
+/// @file StagedImageAccess.tcc
+/// @brief Image access through fast staging storage
+/// @details This class wraps another image accessor, so the images are written to node-local
+/// storage (e.g. NVMe or a burst buffer) and copied to their final destination in the background.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+
+#include <askap/imageaccess/StagedImageAccess.h>
+
+#include <askap/askap/AskapLogging.h>
+#include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/FitsImageAccess.h>
+#include <askap/imageaccess/Hdf5ImageAccess.h>
+#include <askap/imageaccess/WriteCombiningImageAccess.h>
+
+ASKAP_LOGGER(stagedImAccessLogger, ".stagedImageAccessor");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the accessor
+/// @param[in] accessor accessor to work with the staged images
+/// @param[in] stagingDir directory on fast storage for the staged images (created if necessary)
+/// @param[in] maxDrains maximum number of images transferred at the same time
+template <class T>
+StagedImageAccess<T>::StagedImageAccess(const boost::shared_ptr<IImageAccess<T> > &accessor,
+                                        const std::string &stagingDir, size_t maxDrains) :
+    itsAccessor(accessor), itsDrain(stagingDir, maxDrains)
+{
+    ASKAPCHECK(itsAccessor, "StagedImageAccess needs an accessor to wrap");
+}
+
+/// @brief destructor, drains the staged images and waits for the transfers
+template <class T>
+StagedImageAccess<T>::~StagedImageAccess()
+{
+    try {
+        drainAll();
+    }
+    catch (const std::exception &ex) {
+        ASKAPLOG_WARN_STR(stagedImAccessLogger, "Unable to drain the staged images from " <<
+                          itsDrain.stagingDirectory() << ": " << ex.what());
+    }
+    itsDrain.waitAll();
+}
+
+/// @brief start the transfer of the image to its final name
+/// @details The image is closed in the wrapped accessor first. The image should have been
+/// created through this accessor, images which failed to drain are transferred again.
+/// @param[in] name image name
+template <class T>
+void StagedImageAccess<T>::drain(const std::string &name)
+{
+    const ImageDrain::State state = itsDrain.state(name);
+    ASKAPCHECK((state == ImageDrain::STAGED) || (state == ImageDrain::FAILED), "Image " << name <<
+               " is not staged, unable to drain it");
+    releaseImage(*itsAccessor, itsDrain.location(name, true));
+    ASKAPLOG_INFO_STR(stagedImAccessLogger, "Draining image " << name << " from " << itsDrain.stagingDirectory());
+    itsDrain.drain(name);
+}
+
+/// @brief start the transfer of all staged images
+template <class T>
+void StagedImageAccess<T>::drainAll()
+{
+    const std::vector<std::string> names = itsDrain.staged();
+    for (std::vector<std::string>::const_iterator ci = names.begin(); ci != names.end(); ++ci) {
+        drain(*ci);
+    }
+}
+
+/// @brief obtain the state of the image
+/// @param[in] name image name
+/// @return state of the image (see ImageDrain::State)
+template <class T>
+ImageDrain::State StagedImageAccess<T>::drainState(const std::string &name) const
+{
+    return itsDrain.state(name);
+}
+
+/// @brief check whether the image is at its final destination
+/// @param[in] name image name
+/// @return true, if the transfer has been completed and verified
+template <class T>
+bool StagedImageAccess<T>::isDurable(const std::string &name) const
+{
+    return itsDrain.state(name) == ImageDrain::DURABLE;
+}
+
+/// @brief wait for the transfer of the image to finish
+/// @details The method returns straight away if the image is not being drained.
+/// @param[in] name image name
+/// @param[in] timeout maximum time to wait in seconds, negative value means no limit
+/// @return true, if the image is durable
+template <class T>
+bool StagedImageAccess<T>::waitDurable(const std::string &name, double timeout) const
+{
+    return itsDrain.waitDurable(name, timeout);
+}
+
+/// @brief wait for all transfers to finish
+/// @return true, if none of the transfers has failed
+template <class T>
+bool StagedImageAccess<T>::waitAll() const
+{
+    return itsDrain.waitAll();
+}
+
+/// @brief obtain the reason of the failure
+/// @param[in] name image name
+/// @return error message of the last transfer, empty if it hasn't failed
+template <class T>
+std::string StagedImageAccess<T>::drainError(const std::string &name) const
+{
+    return itsDrain.drainError(name);
+}
+
+/// @brief make sure the wrapped accessor doesn't hold the image
+/// @details Pending changes are written and the files are closed, so they can be copied.
+/// The accessors without the means to close a single image are flushed or closed completely.
+/// The blocks buffered by WriteCombiningImageAccess are written before the wrapped accessor
+/// is released.
+/// @param[in] accessor accessor holding the image
+/// @param[in] stagedName name of the image in the staging directory
+template <class T>
+void StagedImageAccess<T>::releaseImage(IImageAccess<T> &accessor, const std::string &stagedName)
+{
+    if (WriteCombiningImageAccess<T> *combining = dynamic_cast<WriteCombiningImageAccess<T>*>(&accessor)) {
+        combining->flush(stagedName);
+        releaseImage(*combining->accessor(), stagedName);
+    } else if (CasaImageAccess<T> *casa = dynamic_cast<CasaImageAccess<T>*>(&accessor)) {
+        casa->close(stagedName);
+    } else if (Hdf5ImageAccess<T> *hdf5 = dynamic_cast<Hdf5ImageAccess<T>*>(&accessor)) {
+        hdf5->close();
+    } else if (const FitsImageAccess *fits = dynamic_cast<const FitsImageAccess*>(&accessor)) {
+        fits->flush();
+    }
+}
+
+//////////////////
+// Reading methods
+//////////////////
+
+template <class T>
+casacore::IPosition StagedImageAccess<T>::shape(const std::string &name) const
+{
+    return itsAccessor->shape(readLocation(name));
+}
+
+template <class T>
+casacore::Array<T> StagedImageAccess<T>::read(const std::string &name) const
+{
+    return itsAccessor->read(readLocation(name));
+}
+
+template <class T>
+casacore::Array<T> StagedImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+                                              const casacore::IPosition &trc) const
+{
+    return itsAccessor->read(readLocation(name), blc, trc);
+}
+
+template <class T>
+casacore::Array<T> StagedImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+                                              const casacore::IPosition &trc, const casacore::IPosition &stride) const
+{
+    return itsAccessor->read(readLocation(name), blc, trc, stride);
+}
+
+template <class T>
+void StagedImageAccess<T>::readInto(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc, casacore::Array<T> &buffer) const
+{
+    itsAccessor->readInto(readLocation(name), blc, trc, buffer);
+}
+
+template <class T>
+bool StagedImageAccess<T>::isMasked(const std::string &name) const
+{
+    return itsAccessor->isMasked(readLocation(name));
+}
+
+template <class T>
+casacore::LogicalArray StagedImageAccess<T>::readMask(const std::string &name) const
+{
+    return itsAccessor->readMask(readLocation(name));
+}
+
+template <class T>
+casacore::LogicalArray StagedImageAccess<T>::readMask(const std::string &name, const casacore::IPosition &blc,
+                                                      const casacore::IPosition &trc) const
+{
+    return itsAccessor->readMask(readLocation(name), blc, trc);
+}
+
+template <class T>
+void StagedImageAccess<T>::readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                                        const casacore::IPosition &trc, casacore::LogicalArray &buffer) const
+{
+    itsAccessor->readMaskInto(readLocation(name), blc, trc, buffer);
+}
+
+template <class T>
+PackedMask StagedImageAccess<T>::readPackedMask(const std::string &name, const casacore::IPosition &blc,
+                                                const casacore::IPosition &trc) const
+{
+    return itsAccessor->readPackedMask(readLocation(name), blc, trc);
+}
+
+template <class T>
+PackedMask::PlaneState StagedImageAccess<T>::maskPlaneState(const std::string &name, size_t plane) const
+{
+    return itsAccessor->maskPlaneState(readLocation(name), plane);
+}
+
+template <class T>
+casacore::CoordinateSystem StagedImageAccess<T>::coordSys(const std::string &name) const
+{
+    return itsAccessor->coordSys(readLocation(name));
+}
+
+template <class T>
+casacore::CoordinateSystem StagedImageAccess<T>::coordSysSlice(const std::string &name,
+                           const casacore::IPosition &blc, const casacore::IPosition &trc) const
+{
+    return itsAccessor->coordSysSlice(readLocation(name), blc, trc);
+}
+
+template <class T>
+casacore::Vector<casacore::Quantum<double> > StagedImageAccess<T>::beamInfo(const std::string &name) const
+{
+    return itsAccessor->beamInfo(readLocation(name));
+}
+
+template <class T>
+BeamList StagedImageAccess<T>::beamList(const std::string &name) const
+{
+    return itsAccessor->beamList(readLocation(name));
+}
+
+template <class T>
+casacore::Vector<casacore::Quantum<double> > StagedImageAccess<T>::channelBeam(const std::string &name,
+                                                                              unsigned int chan) const
+{
+    return itsAccessor->channelBeam(readLocation(name), chan);
+}
+
+template <class T>
+std::string StagedImageAccess<T>::getUnits(const std::string &name) const
+{
+    return itsAccessor->getUnits(readLocation(name));
+}
+
+template <class T>
+std::pair<std::string, std::string> StagedImageAccess<T>::getMetadataKeyword(const std::string &name,
+                                                                             const std::string &keyword) const
+{
+    return itsAccessor->getMetadataKeyword(readLocation(name), keyword);
+}
+
+template <class T>
+boost::shared_ptr<const ImageMetadata> StagedImageAccess<T>::metadata(const std::string &name) const
+{
+    return itsAccessor->metadata(readLocation(name));
+}
+
+template <class T>
+void StagedImageAccess<T>::getInfo(const std::string &name, const std::string& tableName, casacore::Record &info)
+{
+    itsAccessor->getInfo(readLocation(name), tableName, info);
+}
+
+//////////////////
+// Writing methods
+//////////////////
+
+/// @brief create a new image
+/// @details The image is created in the staging directory.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+template <class T>
+void StagedImageAccess<T>::create(const std::string &name, const casacore::IPosition &shape,
+                                  const casacore::CoordinateSystem &csys)
+{
+    const std::string stagedName = itsDrain.stage(name);
+    ASKAPLOG_INFO_STR(stagedImAccessLogger, "Staging image " << name << " as " << stagedName);
+    itsAccessor->create(stagedName, shape, csys);
+}
+
+template <class T>
+void StagedImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr)
+{
+    itsAccessor->write(writeLocation(name), arr);
+}
+
+template <class T>
+void StagedImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                 const casacore::IPosition &where)
+{
+    itsAccessor->write(writeLocation(name), arr, where);
+}
+
+template <class T>
+void StagedImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                 const casacore::Array<bool> &mask, const casacore::IPosition &where)
+{
+    itsAccessor->write(writeLocation(name), arr, mask, where);
+}
+
+template <class T>
+void StagedImageAccess<T>::addInto(const std::string &name, const casacore::Array<T> &arr,
+                                   const casacore::IPosition &where)
+{
+    itsAccessor->addInto(writeLocation(name), arr, where);
+}
+
+template <class T>
+void StagedImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                                     const casacore::IPosition &where)
+{
+    itsAccessor->writeMask(writeLocation(name), mask, where);
+}
+
+template <class T>
+void StagedImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+{
+    itsAccessor->writeMask(writeLocation(name), mask);
+}
+
+template <class T>
+void StagedImageAccess<T>::setUnits(const std::string &name, const std::string &units)
+{
+    itsAccessor->setUnits(writeLocation(name), units);
+}
+
+template <class T>
+void StagedImageAccess<T>::setBeamInfo(const std::string &name, double maj, double min, double pa)
+{
+    itsAccessor->setBeamInfo(writeLocation(name), maj, min, pa);
+}
+
+template <class T>
+void StagedImageAccess<T>::setBeamInfo(const std::string &name, const BeamList & beamlist)
+{
+    itsAccessor->setBeamInfo(writeLocation(name), beamlist);
+}
+
+template <class T>
+void StagedImageAccess<T>::makeDefaultMask(const std::string &name)
+{
+    itsAccessor->makeDefaultMask(writeLocation(name));
+}
+
+template <class T>
+void StagedImageAccess<T>::setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                              const std::string value, const std::string &desc)
+{
+    itsAccessor->setMetadataKeyword(writeLocation(name), keyword, value, desc);
+}
+
+template <class T>
+void StagedImageAccess<T>::setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords)
+{
+    itsAccessor->setMetadataKeywords(writeLocation(name), keywords);
+}
+
+template <class T>
+void StagedImageAccess<T>::addHistory(const std::string &name, const std::vector<std::string> &historyLines)
+{
+    itsAccessor->addHistory(writeLocation(name), historyLines);
+}
+
+template <class T>
+void StagedImageAccess<T>::setInfo(const std::string &name, const casacore::RecordInterface & info)
+{
+    itsAccessor->setInfo(writeLocation(name), info);
+}
+
+template <class T>
+void StagedImageAccess<T>::beginHeaderUpdate(const std::string &name)
+{
+    itsAccessor->beginHeaderUpdate(writeLocation(name));
+}
+
+template <class T>
+void StagedImageAccess<T>::commitHeaderUpdate(const std::string &name)
+{
+    itsAccessor->commitHeaderUpdate(writeLocation(name));
+}
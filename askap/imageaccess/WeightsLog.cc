@@ -32,58 +32,99 @@
 // System includes
 #include <string>
 #include <vector>
+#include <map>
+#include <fstream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 // ASKAPsoft includes
 #include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
 #include <askap/askapparallel/AskapParallel.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <Common/ParameterSet.h>
-#include <Blob/BlobString.h>
-#include <Blob/BlobIBufString.h>
-#include <Blob/BlobOBufString.h>
-#include <Blob/BlobIStream.h>
-#include <Blob/BlobOStream.h>
 
 // Local package includes
 #include <askap/imageaccess/CasaImageAccess.h>
+#include <askap/imageaccess/GatherRecords.h>
 ASKAP_LOGGER(logger, ".WeightsLog");
 
 namespace askap {
 namespace accessors {
 
+namespace {
+
+/// @brief magic string at the start of the binary weights log
+const char theBinaryMagic[8] = {'A', 'S', 'K', 'A', 'P', 'W', 'T', 'S'};
+
+/// @brief version of the binary format
+const std::uint32_t theBinaryVersion = 1;
+
+/// @brief byte order mark of the binary format, read back differently on machines of other endianness
+const std::uint32_t theByteOrderMark = 0x01020304;
+
+} // anonymous namespace
+
 WeightsLog::WeightsLog(const LOFAR::ParameterSet &parset) :
-    itsFilename(parset.getString("WeightsLog", ""))
+    itsFilename(parset.getString("WeightsLog", "")), itsBinary(false)
 {
+    const std::string format = parset.getString("WeightsLogFormat", "text");
+    ASKAPCHECK((format == "text") || (format == "binary"), "WeightsLogFormat should be either text or binary, you have " << format);
+    itsBinary = (format == "binary");
 }
 
-WeightsLog::WeightsLog(const std::string &filename) :
-    itsFilename(filename)
+WeightsLog::WeightsLog(const std::string &filename, bool binary) :
+    itsFilename(filename), itsBinary(binary)
 {
 }
 
 float WeightsLog::weight(const unsigned int channel) const
 {
-   std::map<unsigned int, float>::const_iterator it = itsWeightsList.find(channel);
-   if (it != itsWeightsList.end()) {
-       return it->second;
-   } 
+   if (hasChannel(channel)) {
+       return itsWeights[channel];
+   }
    ASKAPLOG_WARN_STR(logger, "WeightsList has no Weights recorded for channel " << channel << ", returning zero Weights");
    return 0.f;
 }
 
+void WeightsLog::setWeight(const unsigned int channel, const float wt)
+{
+    if (channel >= itsWeights.size()) {
+        itsWeights.resize(channel + 1, 0.f);
+        itsMask.resize(channel + 1, 0);
+    }
+    itsWeights[channel] = wt;
+    itsMask[channel] = 1;
+}
+
+void WeightsLog::clear()
+{
+    itsWeights.clear();
+    itsMask.clear();
+}
+
+std::map<unsigned int, float> WeightsLog::weightslist() const
+{
+    std::map<unsigned int, float> result;
+    for (size_t chan = 0; chan < itsWeights.size(); ++chan) {
+         if (itsMask[chan]) {
+             result.insert(result.end(), std::make_pair(static_cast<unsigned int>(chan), itsWeights[chan]));
+         }
+    }
+    return result;
+}
+
 void WeightsLog::write() const
 {
     if (itsFilename != "") {
 
         if (valid()) {
-
-          std::ofstream fout(itsFilename.c_str());
-          fout << "#Channel Weight\n";
-
-          for (std::map<unsigned int, float>::const_iterator weightsIt = itsWeightsList.begin(); weightsIt!= itsWeightsList.end(); ++weightsIt) {
-              fout << weightsIt->first << " "
-                   << weightsIt->second<< std::endl;
-          }
+            if (itsBinary) {
+                writeBinary();
+            } else {
+                writeText();
+            }
         } else {
           ASKAPLOG_WARN_STR(logger,
                             "WeightsLog cannot write the log, as the weights are invalid");
@@ -95,21 +136,55 @@ void WeightsLog::write() const
     }
 }
 
+void WeightsLog::writeText() const
+{
+    std::ofstream fout(itsFilename.c_str());
+    fout << "#Channel Weight\n";
+
+    for (size_t chan = 0; chan < itsWeights.size(); ++chan) {
+         if (itsMask[chan]) {
+             fout << chan << " " << itsWeights[chan] << "\n";
+         }
+    }
+    ASKAPCHECK(fout, "Failed to write weights log file " << itsFilename);
+}
+
+void WeightsLog::writeBinary() const
+{
+    ASKAPDEBUGASSERT(itsWeights.size() == itsMask.size());
+    std::ofstream fout(itsFilename.c_str(), std::ios::binary);
+    const std::uint64_t nChan = itsWeights.size();
+    fout.write(theBinaryMagic, sizeof(theBinaryMagic));
+    fout.write(reinterpret_cast<const char*>(&theBinaryVersion), sizeof(theBinaryVersion));
+    fout.write(reinterpret_cast<const char*>(&theByteOrderMark), sizeof(theByteOrderMark));
+    fout.write(reinterpret_cast<const char*>(&nChan), sizeof(nChan));
+    fout.write(reinterpret_cast<const char*>(itsWeights.data()), nChan * sizeof(float));
+    fout.write(reinterpret_cast<const char*>(itsMask.data()), nChan);
+    ASKAPCHECK(fout, "Failed to write weights log file " << itsFilename);
+}
+
 casacore::Record WeightsLog::toRecord() const
 {
     casacore::Record record;
 
     if (valid()) {
 
-      const int n = itsWeightsList.size();
+      int n = 0;
+      for (size_t chan = 0; chan < itsMask.size(); ++chan) {
+           if (itsMask[chan]) {
+               ++n;
+           }
+      }
       // We want columns for channel and weight
       casacore::Vector<casacore::Int> colChan(n);
       casacore::Vector<casacore::Float> colWt(n);
-      //std::map<unsigned int, float>::iterator wl = itsWeightsList.begin();
       int i = 0;
-      for (auto wl = itsWeightsList.begin(); wl != itsWeightsList.end(); wl++, i++) {
-          colChan[i] = wl->first;
-          colWt[i] = wl->second;
+      for (size_t chan = 0; chan < itsWeights.size(); ++chan) {
+           if (itsMask[chan]) {
+               colChan[i] = chan;
+               colWt[i] = itsWeights[chan];
+               ++i;
+           }
       }
       casacore::Record subRecord;
 
@@ -133,23 +208,45 @@ casacore::Record WeightsLog::toRecord() const
 
 void WeightsLog::read()
 {
-    itsWeightsList.clear();
+    clear();
 
     if (itsFilename != "") {
 
-        std::ifstream fin(itsFilename.c_str());
+        std::ifstream fin(itsFilename.c_str(), std::ios::binary);
         ASKAPCHECK(fin.is_open(),"Weights log file " << itsFilename << " could not be opened.");
 
-        unsigned int chan;
-        float wt;
-        std::string line, name;
-
-        while (getline(fin, line),
-                !fin.eof()) {
-            if (line[0] != '#') {
-                std::stringstream ss(line);
-                ss >> chan >> wt;
-                itsWeightsList[chan] = wt;
+        char magic[sizeof(theBinaryMagic)];
+        if (fin.read(magic, sizeof(magic)) && (std::memcmp(magic, theBinaryMagic, sizeof(magic)) == 0)) {
+            std::uint32_t version = 0;
+            std::uint32_t byteOrderMark = 0;
+            std::uint64_t nChan = 0;
+            fin.read(reinterpret_cast<char*>(&version), sizeof(version));
+            fin.read(reinterpret_cast<char*>(&byteOrderMark), sizeof(byteOrderMark));
+            fin.read(reinterpret_cast<char*>(&nChan), sizeof(nChan));
+            ASKAPCHECK(fin, "Weights log file " << itsFilename << " has a truncated header");
+            ASKAPCHECK(version == theBinaryVersion, "Weights log file " << itsFilename << " has unsupported version " << version);
+            ASKAPCHECK(byteOrderMark == theByteOrderMark, "Weights log file " << itsFilename <<
+                       " has been written on a machine with a different byte order");
+            itsWeights.resize(nChan);
+            itsMask.resize(nChan);
+            fin.read(reinterpret_cast<char*>(itsWeights.data()), nChan * sizeof(float));
+            fin.read(reinterpret_cast<char*>(itsMask.data()), nChan);
+            if (!fin) {
+                clear();
+                ASKAPTHROW(AskapError, "Weights log file " << itsFilename << " is truncated, expected " << nChan << " channels");
+            }
+        } else {
+            fin.clear();
+            fin.seekg(0);
+            std::string line;
+            while (getline(fin, line)) {
+                if (!line.empty() && (line[0] != '#')) {
+                    char *end = nullptr;
+                    const unsigned long chan = std::strtoul(line.c_str(), &end, 10);
+                    if (end != line.c_str()) {
+                        setWeight(static_cast<unsigned int>(chan), std::strtof(end, nullptr));
+                    }
+                }
             }
         }
     }
@@ -162,66 +259,26 @@ void WeightsLog::gather(askapparallel::AskapParallel &comms, int rankToGather, b
 
     if (comms.isParallel()) {
 
-        const int minrank = includeMaster ? 0 : 1;
-
-        if (comms.rank() != rankToGather) {
-            // If we are here, the current rank does not do the gathering.
-            // Instead, send the data to the rank that is.
-
-            ASKAPLOG_DEBUG_STR(logger, "Sending from rank " << comms.rank() <<" to rank " << rankToGather);
-            // send to desired rank
-            LOFAR::BlobString bs;
-            bs.resize(0);
-            LOFAR::BlobOBufString bob(bs);
-            LOFAR::BlobOStream out(bob);
-            out.putStart("gatherWeights", 1);
-            const unsigned int size = itsWeightsList.size();
-            out << size;
-            if (itsWeightsList.size() > 0) {
-                ASKAPLOG_DEBUG_STR(logger, "This has data, so sending Weights list of size " << size);
-                for (std::map<unsigned int, float>::const_iterator weightsIt = itsWeightsList.begin(); weightsIt != itsWeightsList.end(); ++weightsIt) {
-                    out << weightsIt->first
-                        << weightsIt->second;
-                }
-            }
-            out.putEnd();
-            comms.sendBlob(bs, rankToGather);
-        } else {
-
-            // The rank on which we are gathering the data
-            // Loop over all the others and read their Weights.
-            for (int rank = minrank; rank < comms.nProcs(); rank++) {
-
-                if (rank != comms.rank()) {
-                    ASKAPLOG_DEBUG_STR(logger, "Preparing to receive Weightslist from rank " << rank);
-                    LOFAR::BlobString bs;
-                    bs.resize(0);
-                    comms.receiveBlob(bs, rank);
-                    LOFAR::BlobIBufString bib(bs);
-                    LOFAR::BlobIStream in(bib);
-                    const int version = in.getStart("gatherWeights");
-                    ASKAPASSERT(version == 1);
-                    unsigned int size;
-                    in >> size;
-                    if (size > 0) {
-                        ASKAPLOG_DEBUG_STR(logger, "Has data - about to receive " << size << " channels");
-                        for(unsigned int i=0;i<size;i++){
-                            unsigned int chan;
-                            float wt;
-                            in >> chan >> wt;
-                            if (wt > 0.) {
-                                itsWeightsList[chan] = wt;
-                            }
-                        }
-                    }
-                    else {
-                        ASKAPLOG_DEBUG_STR(logger, "No data from rank " << rank);
-                    }
-                    in.getEnd();
-                }
-
+        // dense weights with zeros for the channels not recorded, zero weights are ignored anyway
+        // the nominated rank keeps its own list, the master is excluded if requested
+        std::vector<float> local;
+        if ((comms.rank() != rankToGather) && (includeMaster || (comms.rank() != 0))) {
+            local.resize(itsWeights.size(), 0.f);
+            for (size_t chan = 0; chan < itsWeights.size(); ++chan) {
+                 if (itsMask[chan] && (itsWeights[chan] > 0.)) {
+                     local[chan] = itsWeights[chan];
+                 }
             }
-
+        }
+        const std::vector<float> gathered = reduceMax(local, rankToGather, 0.f);
+        if (comms.rank() == rankToGather) {
+            ASKAPLOG_DEBUG_STR(logger, "Received weights for up to " << gathered.size() << " channels from other ranks");
+        }
+        // a channel recorded on more than one rank gets the largest weight
+        for (size_t chan = 0; chan < gathered.size(); ++chan) {
+             if (gathered[chan] > 0.) {
+                 setWeight(static_cast<unsigned int>(chan), gathered[chan]);
+             }
         }
 
     }
@@ -229,14 +286,12 @@ void WeightsLog::gather(askapparallel::AskapParallel &comms, int rankToGather, b
 }
 
 bool WeightsLog::valid() const {
-    bool valid = true;
-    for (const auto& wl : itsWeightsList) {
-        if (wl.second < 0) {
-            valid = false;
-            break;
-        }
+    for (size_t chan = 0; chan < itsWeights.size(); ++chan) {
+         if (itsMask[chan] && (itsWeights[chan] < 0)) {
+             return false;
+         }
     }
-    return valid;
+    return true;
 }
 
 
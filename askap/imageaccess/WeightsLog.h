@@ -32,6 +32,7 @@
 // System includes
 #include <string>
 #include <vector>
+#include <map>
 
 // ASKAPsoft includes
 #include <askap/askapparallel/AskapParallel.h>
@@ -50,6 +51,8 @@ namespace accessors {
 /// create and access the weights log files. The class also
 /// provides the ability to straightforwardly read the weights
 /// log to extract the channel-level weights information.
+/// The weights are stored densely, indexed by the channel number,
+/// with a mask telling which channels have weights recorded.
 
 class WeightsLog {
     public:
@@ -57,9 +60,16 @@ class WeightsLog {
         // MV: it seems to me the design would be clearer if write/read methods get the file name as a parameter
         // instead of keeping it as a member of this class
 
+        /// @brief set up the log from the parset
+        /// @details The file name is taken from the WeightsLog keyword, the
+        /// file format from the WeightsLogFormat keyword ("text", the default,
+        /// or "binary").
         explicit WeightsLog(const LOFAR::ParameterSet &parset);
 
-        explicit WeightsLog(const std::string &filename = "");
+        /// @brief set up the log for the given file
+        /// @param[in] filename name of the file
+        /// @param[in] binary true to write the binary format
+        explicit WeightsLog(const std::string &filename = "", bool binary = false);
 
         // MV: default copy constructor and assignment operator seem to be fine for this class. I tried to make it noncopyable for clarity, but
         // tests seem to rely on copy construction (perhaps, it is good to make them not to as it is not needed conceptually)
@@ -70,21 +80,29 @@ class WeightsLog {
         /// @return the file name of the beam log file
         std::string filename() const {return itsFilename;};
 
+        /// @brief Choose the format written by write
+        /// @param[in] binary true for the binary format, false for text
+        void setBinary(bool binary) {itsBinary = binary;};
+
+        /// @return true if write produces the binary format
+        bool binary() const {return itsBinary;};
+
         /// @brief Write the weights information to the weights log
         /// @details The weights information for each channel is written
-        /// to the weights log. The log is in ASCII format, with each
-        /// line having columns: number | weight. Each column is
-        /// separated by a single space. The first line is a comment
-        /// line (starting with a '#') that indicates what each column
-        /// contains.
+        /// to the weights log. In the text format each line has columns:
+        /// number | weight. Each column is separated by a single space.
+        /// The first line is a comment line (starting with a '#') that
+        /// indicates what each column contains. The binary format has a
+        /// header (magic string, version, byte order mark and the number of
+        /// channels) followed by the dense vector of weights (32-bit floats)
+        /// and the mask (one byte per channel).
         void write() const;
 
         /// @brief Read the weights information from a weights log
         /// @details The weights log file is opened and each channel's
         /// weights information is read and stored in the vector of weights
-        /// values. The list of channel image names is also filled. If
-        /// the weights log can not be opened, both vectors are cleared
-        /// and an error message is written to the log.
+        /// values. The format is recognised from the file contents. An
+        /// exception is thrown if the weights log can not be opened.
         void read();
 
         /// @brief Gather channels from different ranks onto a single,
@@ -93,16 +111,38 @@ class WeightsLog {
         /// the channel and weight information to the nominated
         /// rank. The weightslists are aggregated on that rank ready for
         /// writing, ignoring any channels that have zero weights.
+        /// The lists are packed into fixed-size records and gathered with
+        /// a single collective call, so all ranks have to call this method.
         void gather(askapparallel::AskapParallel &comms, int rankToGather, bool includeMaster);
 
 
         /// @brief Return the weights information
-        std::map<unsigned int, float> weightslist() const {return itsWeightsList;};
+        /// @details The map is built from the dense storage, it is meant for
+        /// small logs and backwards compatibility.
+        std::map<unsigned int, float> weightslist() const;
 
-        /// MV: having non-const method returning a reference to data member is breaking encapsulation
+        /// @brief Set the weight of the given channel
+        /// @details The storage grows to include the channel if necessary.
+        /// @param[in] channel channel number
+        /// @param[in] wt weight
+        void setWeight(const unsigned int channel, const float wt);
 
-        /// @brief Return the weights information
-        std::map<unsigned int, float>& weightslist() {return itsWeightsList;};
+        /// @brief Remove the weights of all channels
+        void clear();
+
+        /// @return number of channels covered by the storage (highest recorded channel + 1)
+        size_t nChannels() const {return itsWeights.size();};
+
+        /// @brief Check whether the weight of the given channel is recorded
+        bool hasChannel(const unsigned int channel) const
+            {return (channel < itsMask.size()) && itsMask[channel];};
+
+        /// @brief Dense weights indexed by the channel number
+        /// @details Only the elements with the mask set are meaningful.
+        const std::vector<float>& weights() const {return itsWeights;};
+
+        /// @brief Mask of the channels with weights recorded (non-zero if recorded)
+        const std::vector<unsigned char>& mask() const {return itsMask;};
 
         /// @brief Return the weights for a given channel.
         /// @details Returns the weights stored for the requested channel. If
@@ -121,9 +161,20 @@ class WeightsLog {
         /// @brief The disk file to be read from / written to
         std::string itsFilename;
 
-        /// @brief The list of beam information. Each element of the map is a float,
-        /// referenced by the channel number.
-        std::map<unsigned int, float> itsWeightsList;
+        /// @brief Write the weights in the binary format
+        void writeBinary() const;
+
+        /// @brief Write the weights in the text format
+        void writeText() const;
+
+        /// @brief The weights indexed by the channel number
+        std::vector<float> itsWeights;
+
+        /// @brief The validity mask, one byte per channel so it can be written as is
+        std::vector<unsigned char> itsMask;
+
+        /// @brief True if write produces the binary format
+        bool itsBinary;
 
 };
 
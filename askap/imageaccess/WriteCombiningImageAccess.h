@@ -0,0 +1,417 @@
+/// @file WriteCombiningImageAccess.h
+/// @brief Image access combining consecutive slices into large writes
+/// @details This class wraps another image accessor, so the planes written one at a time
+/// by the imagers are gathered into blocks and written to the wrapped accessor at once.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#ifndef ASKAP_ACCESSORS_WRITE_COMBINING_IMAGE_ACCESS_H
+#define ASKAP_ACCESSORS_WRITE_COMBINING_IMAGE_ACCESS_H
+
+#include <askap/imageaccess/IImageAccess.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace askap {
+namespace accessors {
+
+/// @brief Image access combining consecutive slices into large writes
+/// @details Imagers write one plane (or channel) at a time. For FITS images each such write is
+/// a separate small write at a new offset, and for CASA images with tiles spanning several planes
+/// every write updates a part of the same tiles. This accessor keeps the slices in a buffer and
+/// writes the whole block to the wrapped accessor once it is complete:
+/// - the slices are stacked along the last axis where the slice is shorter than the image (the
+///   stacking axis), consecutive writes should continue the block along this axis and have the
+///   same shape and position along the other axes;
+/// - blocks start at multiples of the block length along the stacking axis, the length is chosen
+///   to fit the given number of pixels and rounded to whole tiles for CASA images, so the blocks
+///   are aligned with the storage;
+/// - a write not continuing the buffered block writes the buffered pixels first; writes which
+///   are not combined (e.g. the full image or slices already as large as a block) are passed
+///   straight to the wrapped accessor;
+/// - the buffered pixels are written before any other access to the image except reading
+///   its shape and metadata, and by flush and the destructor.
+///
+/// The statistics and the array allocator should be set up on the wrapped accessor, the
+/// statistics are accumulated as the blocks are written. The accessor is not thread-safe,
+/// as the wrapped accessors are not.
+/// @ingroup imageaccess
+template <class T = casacore::Float>
+struct WriteCombiningImageAccess : public IImageAccess<T> {
+
+    /// @brief default size of the buffered block in pixels
+    static const size_t theDefaultMaxPixels = 32u * 1024u * 1024u;
+
+    /// @brief set up the accessor
+    /// @param[in] accessor accessor to write the blocks with
+    /// @param[in] maxPixels maximum number of pixels in the block buffered for each image
+    explicit WriteCombiningImageAccess(const boost::shared_ptr<IImageAccess<T> > &accessor,
+                                       size_t maxPixels = theDefaultMaxPixels);
+
+    /// @brief destructor, writes the buffered blocks
+    virtual ~WriteCombiningImageAccess();
+
+    /// @return wrapped accessor
+    inline const boost::shared_ptr<IImageAccess<T> >& accessor() const { return itsAccessor; }
+
+    /// @return maximum number of pixels in the block buffered for each image
+    inline size_t maxPixels() const { return itsMaxPixels; }
+
+    /// @brief write the block buffered for the given image
+    /// @details Nothing is done if there is no block buffered for the image.
+    /// @param[in] name image name
+    void flush(const std::string &name);
+
+    /// @brief write all buffered blocks
+    void flush();
+
+    /// @return number of slices gathered into blocks so far
+    inline size_t slicesCombined() const { return itsSlicesCombined; }
+
+    /// @return number of blocks written so far
+    inline size_t blocksWritten() const { return itsBlocksWritten; }
+
+    //////////////////
+    // Reading methods
+    //////////////////
+
+    /// @brief obtain the shape
+    /// @param[in] name image name
+    /// @return full shape of the given image
+    virtual casacore::IPosition shape(const std::string &name) const override;
+
+    /// @brief read full image
+    /// @param[in] name image name
+    /// @return array with pixels
+    virtual casacore::Array<T> read(const std::string &name) const override;
+
+    /// @brief read part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return array with pixels for the selection only
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc) const override;
+
+    /// @brief read every stride-th pixel of part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[in] stride increment along each axis (1 to take all pixels)
+    /// @return array with (trc - blc) / stride + 1 pixels along each axis
+    virtual casacore::Array<T> read(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc, const casacore::IPosition &stride) const override;
+
+    /// @brief read part of the image into the given buffer
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with pixels for the selection
+    virtual void readInto(const std::string &name, const casacore::IPosition &blc,
+                          const casacore::IPosition &trc, casacore::Array<T> &buffer) const override;
+
+    /// @brief Determine whether an image has a mask
+    /// @param[in] nam image name
+    /// @return True if image has a mask, False if not.
+    virtual bool isMasked(const std::string &name) const override;
+
+    /// @brief read the mask for the full image
+    /// @param[in] name image name
+    /// @return bool array with mask values - 1=good, 0=bad
+    virtual casacore::LogicalArray readMask(const std::string &name) const override;
+
+    /// @brief read the mask for part of the image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return bool array with mask values - 1=good, 0=bad
+    virtual casacore::LogicalArray readMask(const std::string &name, const casacore::IPosition &blc,
+                                    const casacore::IPosition &trc) const override;
+
+    /// @brief read the mask for part of the image into the given buffer
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @param[out] buffer array to fill with mask values - 1=good, 0=bad
+    virtual void readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                              const casacore::IPosition &trc, casacore::LogicalArray &buffer) const override;
+
+    /// @brief read the mask for part of the image with one bit per pixel
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection
+    /// @return packed mask for the selection (set bit = good pixel)
+    virtual PackedMask readPackedMask(const std::string &name, const casacore::IPosition &blc,
+                                      const casacore::IPosition &trc) const override;
+
+    /// @brief obtain the summary of the mask of an image plane
+    /// @param[in] name image name
+    /// @param[in] plane plane number
+    /// @return PackedMask::ALL_VALID, PackedMask::ALL_MASKED or PackedMask::PARTIAL
+    virtual PackedMask::PlaneState maskPlaneState(const std::string &name, size_t plane) const override;
+
+    /// @brief obtain coordinate system info
+    /// @param[in] name image name
+    /// @return coordinate system object
+    virtual casacore::CoordinateSystem coordSys(const std::string &name) const override;
+
+    /// @brief obtain coordinate system info for part of an image
+    /// @param[in] name image name
+    /// @param[in] blc bottom left corner of the selection
+    /// @param[in] trc top right corner of the selection (inclusive)
+    /// @return coordinate system object
+    virtual casacore::CoordinateSystem coordSysSlice(const std::string &name, const casacore::IPosition &blc,
+            const casacore::IPosition &trc) const override;
+
+    /// @brief obtain beam info
+    /// @param[in] name image name
+    /// @return beam info vector
+    virtual casacore::Vector<casacore::Quantum<double> > beamInfo(const std::string &name) const override;
+
+    /// @brief obtain beam info
+    /// @param[in] name image name
+    /// @return beam info list
+    virtual BeamList beamList(const std::string &name) const override;
+
+    /// @brief obtain the restoring beam of a single channel
+    /// @param[in] name image name
+    /// @param[in] chan channel number
+    /// @return beam info vector
+    virtual casacore::Vector<casacore::Quantum<double> > channelBeam(const std::string &name,
+                                                                     unsigned int chan) const override;
+
+    /// @brief obtain pixel units
+    /// @param[in] name image name
+    /// @return units string
+    virtual std::string getUnits(const std::string &name) const override;
+
+    /// @brief Get a particular keyword from the image metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keyword The name of the metadata keyword
+    /// @return pair of strings - keyword value and comment
+    virtual std::pair<std::string, std::string> getMetadataKeyword(const std::string &name,
+                                                                   const std::string &keyword) const override;
+
+    /// @brief obtain a snapshot of the image metadata
+    /// @param[in] name image name
+    /// @return shared pointer to the snapshot
+    virtual boost::shared_ptr<const ImageMetadata> metadata(const std::string &name) const override;
+
+    /// @brief this method reads the table(s) set by setInfo
+    /// @param[in] name image name
+    /// @param[in] tableName table name, "All" gets all the tables
+    /// @param[out] info record to add the tables to
+    virtual void getInfo(const std::string &name, const std::string& tableName, casacore::Record &info) override;
+
+    //////////////////
+    // Writing methods
+    //////////////////
+
+    /// @brief create a new image
+    /// @details The block buffered for the image with the same name (if any) is written first.
+    /// @param[in] name image name
+    /// @param[in] shape full shape of the image
+    /// @param[in] csys coordinate system of the full image
+    virtual void create(const std::string &name, const casacore::IPosition &shape,
+                        const casacore::CoordinateSystem &csys) override;
+
+    /// @brief write full image
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    virtual void write(const std::string &name, const casacore::Array<T> &arr) override;
+
+    /// @brief write a slice of an image
+    /// @details The slice is added to the buffered block, if it can be combined.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image and mask
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void write(const std::string &name, const casacore::Array<T> &arr,
+                       const casacore::Array<bool> &mask, const casacore::IPosition &where) override;
+
+    /// @brief add pixels to a slice of an image
+    /// @details The region lock is taken by the wrapped accessor.
+    /// @param[in] name image name
+    /// @param[in] arr array with pixels to add
+    /// @param[in] where bottom left corner of the slice (trc is deduced from the array shape)
+    virtual void addInto(const std::string &name, const casacore::Array<T> &arr,
+                         const casacore::IPosition &where) override;
+
+    /// @brief write a slice of an image mask
+    /// @param[in] name image name
+    /// @param[in] mask array with mask
+    /// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                           const casacore::IPosition &where) override;
+
+    /// @brief write an image mask
+    /// @param[in] name image name
+    /// @param[in] mask array with mask
+    virtual void writeMask(const std::string &name, const casacore::Array<bool> &mask) override;
+
+    /// @brief set brightness units of the image
+    /// @param[in] name image name
+    /// @param[in] units string describing brightness units of the image (e.g. "Jy/beam")
+    virtual void setUnits(const std::string &name, const std::string &units) override;
+
+    /// @brief set restoring beam info
+    /// @param[in] name image name
+    /// @param[in] maj major axis in radians
+    /// @param[in] min minor axis in radians
+    /// @param[in] pa position angle in radians
+    virtual void setBeamInfo(const std::string &name, double maj, double min, double pa) override;
+
+    /// @brief set restoring beam info for all channels
+    /// @param[in] name image name
+    /// @param[in] beamlist The list of beams
+    virtual void setBeamInfo(const std::string &name, const BeamList & beamlist) override;
+
+    /// @brief assign the default mask
+    /// @param[in] name image name
+    virtual void makeDefaultMask(const std::string &name) override;
+
+    /// @brief Set a particular keyword for the metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keyword The name of the metadata keyword
+    /// @param[in] value The value for the keyword, in string format
+    /// @param[in] desc A description of the keyword
+    virtual void setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                    const std::string value, const std::string &desc = "") override;
+
+    /// @brief Set the keywords for the metadata (A.K.A header)
+    /// @param[in] name Image name
+    /// @param[in] keywords A parset with keyword entries (KEYWORD = ["keyword value","keyword description","STRING"])
+    virtual void setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords) override;
+
+    /// @brief Add HISTORY messages to the image metadata
+    /// @param[in] name Image name
+    /// @param[in] historyLines History comments to add
+    virtual void addHistory(const std::string &name, const std::vector<std::string> &historyLines) override;
+
+    /// @brief this method stores the table given as a sub-record of info with the image
+    /// @param[in] name image name
+    /// @param[in] info record to be stored
+    virtual void setInfo(const std::string &name, const casacore::RecordInterface & info) override;
+
+    /// @brief start a batch of header updates
+    /// @param[in] name image name
+    virtual void beginHeaderUpdate(const std::string &name) override;
+
+    /// @brief write the header changes staged since beginHeaderUpdate
+    /// @param[in] name image name
+    virtual void commitHeaderUpdate(const std::string &name) override;
+
+private:
+    /// @brief block of slices buffered for an image
+    struct Block {
+        /// @brief pixels of the whole block
+        casacore::Array<T> itsPixels;
+        /// @brief bottom left corner of the block
+        casacore::IPosition itsWhere;
+        /// @brief stacking axis
+        size_t itsAxis;
+        /// @brief length of the part filled so far along the stacking axis
+        casacore::Int64 itsFilled;
+    };
+
+    /// @brief write the block buffered for the given image
+    /// @details This version is used by the reading methods.
+    /// @param[in] name image name
+    void flushPending(const std::string &name) const;
+
+    /// @brief write the given block
+    /// @param[in] name image name
+    /// @param[in] block block to write
+    void writeBlock(const std::string &name, const Block &block) const;
+
+    /// @brief shape of the image
+    /// @details The shape is cached, as it is needed for every slice written.
+    /// @param[in] name image name
+    /// @return full shape of the given image
+    const casacore::IPosition& imageShape(const std::string &name) const;
+
+    /// @brief choose the stacking axis for the slice
+    /// @param[in] shape shape of the image
+    /// @param[in] sliceShape shape of the slice
+    /// @param[in] where bottom left corner of the slice
+    /// @return the last axis where the slice is shorter than the image, the number of
+    /// dimensions if the slice can't be combined
+    static size_t stackingAxis(const casacore::IPosition &shape, const casacore::IPosition &sliceShape,
+                               const casacore::IPosition &where);
+
+    /// @brief length of the blocks along the stacking axis
+    /// @param[in] name image name
+    /// @param[in] sliceShape shape of the slice
+    /// @param[in] axis stacking axis
+    /// @return block length fitting the maximum number of pixels, rounded to whole tiles
+    casacore::Int64 blockLength(const std::string &name, const casacore::IPosition &sliceShape, size_t axis) const;
+
+    /// @brief check whether the slice continues the block
+    /// @param[in] block buffered block
+    /// @param[in] sliceShape shape of the slice
+    /// @param[in] where bottom left corner of the slice
+    /// @param[in] axis stacking axis of the slice
+    /// @return true, if the slice can be added to the block
+    static bool continuesBlock(const Block &block, const casacore::IPosition &sliceShape,
+                               const casacore::IPosition &where, size_t axis);
+
+    /// @brief wrapped accessor
+    boost::shared_ptr<IImageAccess<T> > itsAccessor;
+
+    /// @brief maximum number of pixels in the block buffered for each image
+    size_t itsMaxPixels;
+
+    /// @brief blocks buffered for each image
+    mutable std::map<std::string, Block> itsBlocks;
+
+    /// @brief shapes of the images written
+    mutable std::map<std::string, casacore::IPosition> itsShapes;
+
+    /// @brief number of slices gathered into blocks
+    size_t itsSlicesCombined;
+
+    /// @brief number of blocks written
+    mutable size_t itsBlocksWritten;
+};
+
+} // namespace accessors
+} // namespace askap
+
+#include "WriteCombiningImageAccess.tcc"
+#endif
@@ -0,0 +1,530 @@
+/// @file WriteCombiningImageAccess.tcc
+/// @brief Image access combining consecutive slices into large writes
+/// @details This class wraps another image accessor, so the planes written one at a time
+/// by the imagers are gathered into blocks and written to the wrapped accessor at once.
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+
+
+#include <askap/imageaccess/WriteCombiningImageAccess.h>
+
+#include <askap/askap/AskapLogging.h>
+#include <askap/imageaccess/CasaImageAccess.h>
+
+#include <algorithm>
+
+ASKAP_LOGGER(writeCombiningImAccessLogger, ".writeCombiningImageAccessor");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the accessor
+/// @param[in] accessor accessor to write the blocks with
+/// @param[in] maxPixels maximum number of pixels in the block buffered for each image
+template <class T>
+WriteCombiningImageAccess<T>::WriteCombiningImageAccess(const boost::shared_ptr<IImageAccess<T> > &accessor,
+                                                        size_t maxPixels) :
+    itsAccessor(accessor), itsMaxPixels(maxPixels), itsSlicesCombined(0), itsBlocksWritten(0)
+{
+    ASKAPCHECK(itsAccessor, "WriteCombiningImageAccess needs an accessor to wrap");
+    ASKAPCHECK(itsMaxPixels > 0, "WriteCombiningImageAccess needs a non-empty buffer");
+}
+
+/// @brief destructor, writes the buffered blocks
+template <class T>
+WriteCombiningImageAccess<T>::~WriteCombiningImageAccess()
+{
+    try {
+        flush();
+    }
+    catch (const std::exception &ex) {
+        ASKAPLOG_WARN_STR(writeCombiningImAccessLogger, "Unable to write the buffered image blocks: " << ex.what());
+    }
+    if (itsSlicesCombined > 0) {
+        ASKAPLOG_DEBUG_STR(writeCombiningImAccessLogger, itsSlicesCombined << " slice(s) combined, " <<
+                           itsBlocksWritten << " block(s) written");
+    }
+}
+
+/// @brief write the block buffered for the given image
+/// @details Nothing is done if there is no block buffered for the image.
+/// @param[in] name image name
+template <class T>
+void WriteCombiningImageAccess<T>::flush(const std::string &name)
+{
+    flushPending(name);
+}
+
+/// @brief write all buffered blocks
+template <class T>
+void WriteCombiningImageAccess<T>::flush()
+{
+    while (!itsBlocks.empty()) {
+        flushPending(itsBlocks.begin()->first);
+    }
+}
+
+/// @brief write the block buffered for the given image
+/// @details This version is used by the reading methods. The block is dropped only
+/// after it has been written.
+/// @param[in] name image name
+template <class T>
+void WriteCombiningImageAccess<T>::flushPending(const std::string &name) const
+{
+    const typename std::map<std::string, Block>::iterator it = itsBlocks.find(name);
+    if (it != itsBlocks.end()) {
+        writeBlock(name, it->second);
+        itsBlocks.erase(it);
+    }
+}
+
+/// @brief write the given block
+/// @details Only the filled part is written if the block is not complete.
+/// @param[in] name image name
+/// @param[in] block block to write
+template <class T>
+void WriteCombiningImageAccess<T>::writeBlock(const std::string &name, const Block &block) const
+{
+    ASKAPDEBUGASSERT(block.itsFilled > 0);
+    const casacore::IPosition &blockShape = block.itsPixels.shape();
+    if (block.itsFilled == blockShape(block.itsAxis)) {
+        itsAccessor->write(name, block.itsPixels, block.itsWhere);
+    } else {
+        casacore::IPosition trc = blockShape - 1;
+        trc(block.itsAxis) = block.itsFilled - 1;
+        const casacore::IPosition blc(blockShape.nelements(), 0);
+        itsAccessor->write(name, block.itsPixels(blc, trc), block.itsWhere);
+    }
+    ++itsBlocksWritten;
+}
+
+/// @brief shape of the image
+/// @details The shape is cached, as it is needed for every slice written.
+/// @param[in] name image name
+/// @return full shape of the given image
+template <class T>
+const casacore::IPosition& WriteCombiningImageAccess<T>::imageShape(const std::string &name) const
+{
+    typename std::map<std::string, casacore::IPosition>::const_iterator ci = itsShapes.find(name);
+    if (ci == itsShapes.end()) {
+        ci = itsShapes.insert(std::make_pair(name, itsAccessor->shape(name))).first;
+    }
+    return ci->second;
+}
+
+/// @brief choose the stacking axis for the slice
+/// @param[in] shape shape of the image
+/// @param[in] sliceShape shape of the slice
+/// @param[in] where bottom left corner of the slice
+/// @return the last axis where the slice is shorter than the image, the number of
+/// dimensions if the slice can't be combined
+template <class T>
+size_t WriteCombiningImageAccess<T>::stackingAxis(const casacore::IPosition &shape,
+                                                  const casacore::IPosition &sliceShape,
+                                                  const casacore::IPosition &where)
+{
+    const size_t nDim = shape.nelements();
+    if ((sliceShape.nelements() != nDim) || (where.nelements() != nDim)) {
+        // leave it to the wrapped accessor to report the error
+        return nDim;
+    }
+    for (size_t dim = nDim; dim > 0; --dim) {
+        if (sliceShape(dim - 1) < shape(dim - 1)) {
+            return dim - 1;
+        }
+    }
+    return nDim;
+}
+
+/// @brief length of the blocks along the stacking axis
+/// @param[in] name image name
+/// @param[in] sliceShape shape of the slice
+/// @param[in] axis stacking axis
+/// @return block length fitting the maximum number of pixels, rounded to whole tiles
+template <class T>
+casacore::Int64 WriteCombiningImageAccess<T>::blockLength(const std::string &name,
+                                                          const casacore::IPosition &sliceShape, size_t axis) const
+{
+    ASKAPDEBUGASSERT(sliceShape(axis) > 0);
+    const size_t pixelsPerStep = static_cast<size_t>(sliceShape.product() / sliceShape(axis));
+    casacore::Int64 length = std::max<casacore::Int64>(1, pixelsPerStep > 0 ? itsMaxPixels / pixelsPerStep : 1);
+    const CasaImageAccess<T>* casaAccessor = dynamic_cast<const CasaImageAccess<T>*>(itsAccessor.get());
+    if (casaAccessor != 0) {
+        const casacore::Int64 tileLength = casaAccessor->tileShape(name)(axis);
+        if (tileLength > 1) {
+            length = std::max(tileLength, length / tileLength * tileLength);
+        }
+    }
+    return length;
+}
+
+/// @brief check whether the slice continues the block
+/// @param[in] block buffered block
+/// @param[in] sliceShape shape of the slice
+/// @param[in] where bottom left corner of the slice
+/// @param[in] axis stacking axis of the slice
+/// @return true, if the slice can be added to the block
+template <class T>
+bool WriteCombiningImageAccess<T>::continuesBlock(const Block &block, const casacore::IPosition &sliceShape,
+                                                  const casacore::IPosition &where, size_t axis)
+{
+    if (axis != block.itsAxis) {
+        return false;
+    }
+    const casacore::IPosition &blockShape = block.itsPixels.shape();
+    for (size_t dim = 0; dim < blockShape.nelements(); ++dim) {
+        if (dim == axis) {
+            if ((where(dim) != block.itsWhere(dim) + block.itsFilled) ||
+                (block.itsFilled + sliceShape(dim) > blockShape(dim))) {
+                return false;
+            }
+        } else if ((where(dim) != block.itsWhere(dim)) || (sliceShape(dim) != blockShape(dim))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// reading methods
+
+template <class T>
+casacore::IPosition WriteCombiningImageAccess<T>::shape(const std::string &name) const
+{
+    return itsAccessor->shape(name);
+}
+
+template <class T>
+casacore::Array<T> WriteCombiningImageAccess<T>::read(const std::string &name) const
+{
+    flushPending(name);
+    return itsAccessor->read(name);
+}
+
+template <class T>
+casacore::Array<T> WriteCombiningImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+                                                      const casacore::IPosition &trc) const
+{
+    flushPending(name);
+    return itsAccessor->read(name, blc, trc);
+}
+
+template <class T>
+casacore::Array<T> WriteCombiningImageAccess<T>::read(const std::string &name, const casacore::IPosition &blc,
+                                                      const casacore::IPosition &trc,
+                                                      const casacore::IPosition &stride) const
+{
+    flushPending(name);
+    return itsAccessor->read(name, blc, trc, stride);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::readInto(const std::string &name, const casacore::IPosition &blc,
+                                            const casacore::IPosition &trc, casacore::Array<T> &buffer) const
+{
+    flushPending(name);
+    itsAccessor->readInto(name, blc, trc, buffer);
+}
+
+template <class T>
+bool WriteCombiningImageAccess<T>::isMasked(const std::string &name) const
+{
+    return itsAccessor->isMasked(name);
+}
+
+template <class T>
+casacore::LogicalArray WriteCombiningImageAccess<T>::readMask(const std::string &name) const
+{
+    flushPending(name);
+    return itsAccessor->readMask(name);
+}
+
+template <class T>
+casacore::LogicalArray WriteCombiningImageAccess<T>::readMask(const std::string &name, const casacore::IPosition &blc,
+                                                              const casacore::IPosition &trc) const
+{
+    flushPending(name);
+    return itsAccessor->readMask(name, blc, trc);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::readMaskInto(const std::string &name, const casacore::IPosition &blc,
+                                                const casacore::IPosition &trc, casacore::LogicalArray &buffer) const
+{
+    flushPending(name);
+    itsAccessor->readMaskInto(name, blc, trc, buffer);
+}
+
+template <class T>
+PackedMask WriteCombiningImageAccess<T>::readPackedMask(const std::string &name, const casacore::IPosition &blc,
+                                                        const casacore::IPosition &trc) const
+{
+    flushPending(name);
+    return itsAccessor->readPackedMask(name, blc, trc);
+}
+
+template <class T>
+PackedMask::PlaneState WriteCombiningImageAccess<T>::maskPlaneState(const std::string &name, size_t plane) const
+{
+    flushPending(name);
+    return itsAccessor->maskPlaneState(name, plane);
+}
+
+template <class T>
+casacore::CoordinateSystem WriteCombiningImageAccess<T>::coordSys(const std::string &name) const
+{
+    return itsAccessor->coordSys(name);
+}
+
+template <class T>
+casacore::CoordinateSystem WriteCombiningImageAccess<T>::coordSysSlice(const std::string &name,
+                                                                       const casacore::IPosition &blc,
+                                                                       const casacore::IPosition &trc) const
+{
+    return itsAccessor->coordSysSlice(name, blc, trc);
+}
+
+template <class T>
+casacore::Vector<casacore::Quantum<double> > WriteCombiningImageAccess<T>::beamInfo(const std::string &name) const
+{
+    return itsAccessor->beamInfo(name);
+}
+
+template <class T>
+BeamList WriteCombiningImageAccess<T>::beamList(const std::string &name) const
+{
+    return itsAccessor->beamList(name);
+}
+
+template <class T>
+casacore::Vector<casacore::Quantum<double> > WriteCombiningImageAccess<T>::channelBeam(const std::string &name,
+                                                                                       unsigned int chan) const
+{
+    return itsAccessor->channelBeam(name, chan);
+}
+
+template <class T>
+std::string WriteCombiningImageAccess<T>::getUnits(const std::string &name) const
+{
+    return itsAccessor->getUnits(name);
+}
+
+template <class T>
+std::pair<std::string, std::string> WriteCombiningImageAccess<T>::getMetadataKeyword(const std::string &name,
+                                                                                     const std::string &keyword) const
+{
+    return itsAccessor->getMetadataKeyword(name, keyword);
+}
+
+template <class T>
+boost::shared_ptr<const ImageMetadata> WriteCombiningImageAccess<T>::metadata(const std::string &name) const
+{
+    return itsAccessor->metadata(name);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::getInfo(const std::string &name, const std::string& tableName,
+                                           casacore::Record &info)
+{
+    itsAccessor->getInfo(name, tableName, info);
+}
+
+// writing methods
+
+/// @brief create a new image
+/// @details The block buffered for the image with the same name (if any) is written first.
+/// @param[in] name image name
+/// @param[in] shape full shape of the image
+/// @param[in] csys coordinate system of the full image
+template <class T>
+void WriteCombiningImageAccess<T>::create(const std::string &name, const casacore::IPosition &shape,
+                                          const casacore::CoordinateSystem &csys)
+{
+    flushPending(name);
+    itsShapes.erase(name);
+    itsAccessor->create(name, shape, csys);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr)
+{
+    flushPending(name);
+    itsAccessor->write(name, arr);
+}
+
+/// @brief write a slice of an image
+/// @details The slice is added to the buffered block, if it can be combined. A new block
+/// starts at the slice and ends at the next multiple of the block length along the stacking axis.
+/// @param[in] name image name
+/// @param[in] arr array with pixels
+/// @param[in] where bottom left corner where to put the slice to (trc is deduced from the array shape)
+template <class T>
+void WriteCombiningImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                         const casacore::IPosition &where)
+{
+    const casacore::IPosition &shape = imageShape(name);
+    const casacore::IPosition &sliceShape = arr.shape();
+    const size_t axis = stackingAxis(shape, sliceShape, where);
+    typename std::map<std::string, Block>::iterator it = itsBlocks.find(name);
+    if ((it != itsBlocks.end()) && ((axis >= shape.nelements()) || !continuesBlock(it->second, sliceShape, where, axis))) {
+        flushPending(name);
+        it = itsBlocks.end();
+    }
+    if (axis >= shape.nelements()) {
+        itsAccessor->write(name, arr, where);
+        return;
+    }
+    if (it == itsBlocks.end()) {
+        const casacore::Int64 length = blockLength(name, sliceShape, axis);
+        const casacore::Int64 blockEnd = std::min<casacore::Int64>((where(axis) / length + 1) * length, shape(axis));
+        if (blockEnd - where(axis) <= sliceShape(axis)) {
+            // the slice fills or crosses the block on its own
+            itsAccessor->write(name, arr, where);
+            return;
+        }
+        casacore::IPosition blockShape(sliceShape);
+        blockShape(axis) = blockEnd - where(axis);
+        Block block;
+        block.itsPixels.resize(blockShape);
+        block.itsWhere = where;
+        block.itsAxis = axis;
+        block.itsFilled = 0;
+        it = itsBlocks.insert(std::make_pair(name, block)).first;
+    }
+    Block &block = it->second;
+    casacore::IPosition blc(sliceShape.nelements(), 0);
+    blc(axis) = block.itsFilled;
+    casacore::Array<T> section = block.itsPixels(blc, blc + sliceShape - 1);
+    section = arr;
+    block.itsFilled += sliceShape(axis);
+    ++itsSlicesCombined;
+    if (block.itsFilled == block.itsPixels.shape()(axis)) {
+        flushPending(name);
+    }
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::write(const std::string &name, const casacore::Array<T> &arr,
+                                         const casacore::Array<bool> &mask, const casacore::IPosition &where)
+{
+    flushPending(name);
+    itsAccessor->write(name, arr, mask, where);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::addInto(const std::string &name, const casacore::Array<T> &arr,
+                                           const casacore::IPosition &where)
+{
+    flushPending(name);
+    itsAccessor->addInto(name, arr, where);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask,
+                                             const casacore::IPosition &where)
+{
+    flushPending(name);
+    itsAccessor->writeMask(name, mask, where);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::writeMask(const std::string &name, const casacore::Array<bool> &mask)
+{
+    flushPending(name);
+    itsAccessor->writeMask(name, mask);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::setUnits(const std::string &name, const std::string &units)
+{
+    flushPending(name);
+    itsAccessor->setUnits(name, units);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::setBeamInfo(const std::string &name, double maj, double min, double pa)
+{
+    flushPending(name);
+    itsAccessor->setBeamInfo(name, maj, min, pa);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::setBeamInfo(const std::string &name, const BeamList & beamlist)
+{
+    flushPending(name);
+    itsAccessor->setBeamInfo(name, beamlist);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::makeDefaultMask(const std::string &name)
+{
+    flushPending(name);
+    itsAccessor->makeDefaultMask(name);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::setMetadataKeyword(const std::string &name, const std::string &keyword,
+                                                      const std::string value, const std::string &desc)
+{
+    flushPending(name);
+    itsAccessor->setMetadataKeyword(name, keyword, value, desc);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::setMetadataKeywords(const std::string &name, const LOFAR::ParameterSet &keywords)
+{
+    flushPending(name);
+    itsAccessor->setMetadataKeywords(name, keywords);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::addHistory(const std::string &name, const std::vector<std::string> &historyLines)
+{
+    flushPending(name);
+    itsAccessor->addHistory(name, historyLines);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::setInfo(const std::string &name, const casacore::RecordInterface & info)
+{
+    flushPending(name);
+    itsAccessor->setInfo(name, info);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::beginHeaderUpdate(const std::string &name)
+{
+    flushPending(name);
+    itsAccessor->beginHeaderUpdate(name);
+}
+
+template <class T>
+void WriteCombiningImageAccess<T>::commitHeaderUpdate(const std::string &name)
+{
+    itsAccessor->commitHeaderUpdate(name);
+}
@@ -32,16 +32,30 @@
 
 // System includes
 #include <string>
+#include <utility>
 #include <sstream>
 #include <istream>
 #include <ostream>
 #include <iostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <vector>
+#include <cstdlib>
+#include <exception>
 
 // ASKAPsoft includes
 #include <askap/askap/AskapLogging.h>
 #include <askap/askap/AskapError.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
 #include "boost/scoped_ptr.hpp"
 #include "boost/algorithm/string/trim.hpp"
+#include "boost/algorithm/string/case_conv.hpp"
+#include "boost/shared_ptr.hpp"
+#include "boost/thread/thread.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/lock_guard.hpp"
+#include "boost/ref.hpp"
 
 // For XML
 #include "askap/votable/XercescString.h"
@@ -58,6 +72,8 @@
 // Local package includes
 #include "askap/votable/VOTableInfo.h"
 #include "askap/votable/VOTableResource.h"
+#include "askap/votable/VOTableTags.h"
+#include "askap/votable/VOTableStream.h"
 
 ASKAP_LOGGER(logger, ".VOTable");
 
@@ -66,6 +82,147 @@ using namespace askap;
 using namespace askap::accessors;
 using namespace xercesc;
 
+namespace {
+
+/// @brief byte range of a TABLE element in the document
+struct TableSpan {
+    size_t begin;
+    size_t end;
+};
+
+/// @return true if the tag with the given name starts at pos
+bool isTag(const std::string& xml, size_t pos, const char* tag)
+{
+    const size_t len = std::char_traits<char>::length(tag);
+    if (xml.compare(pos, len, tag) != 0 || pos + len >= xml.size()) {
+        return false;
+    }
+    const char next = xml[pos + len];
+    return next == '>' || next == '/' || next == ' ' || next == '\t' || next == '\n' || next == '\r';
+}
+
+/// @return position after the '>' closing the tag which starts at pos, or npos
+size_t tagEnd(const std::string& xml, size_t pos)
+{
+    char quote = 0;
+    for (; pos < xml.size(); ++pos) {
+        const char c = xml[pos];
+        if (quote) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            return pos + 1;
+        }
+    }
+    return std::string::npos;
+}
+
+/// @brief find the TABLE elements in the document
+/// @details Comments and CDATA sections are skipped. TABLE elements can't be
+/// nested in a VOTable.
+/// @return false if the document can't be split into tables
+bool indexTables(const std::string& xml, std::vector<TableSpan>& spans)
+{
+    // the fragments are parsed without the prolog, so they have to be UTF-8
+    if (xml.compare(0, 5, "<?xml") == 0) {
+        const size_t prologEnd = xml.find("?>");
+        const size_t encPos = xml.find("encoding", 0);
+        if (encPos != std::string::npos && encPos < prologEnd) {
+            const size_t quote = xml.find_first_of("\"'", encPos);
+            const size_t quoteEnd = quote == std::string::npos ? quote : xml.find(xml[quote], quote + 1);
+            if (quoteEnd == std::string::npos) {
+                return false;
+            }
+            const std::string encoding = boost::to_lower_copy(xml.substr(quote + 1, quoteEnd - quote - 1));
+            if (encoding != "utf-8" && encoding != "utf8" && encoding != "us-ascii") {
+                return false;
+            }
+        }
+    }
+    size_t open = std::string::npos;
+    size_t pos = 0;
+    while ((pos = xml.find('<', pos)) != std::string::npos) {
+        if (xml.compare(pos, 4, "<!--") == 0) {
+            pos = xml.find("-->", pos + 4);
+            if (pos == std::string::npos) {
+                return false;
+            }
+        } else if (xml.compare(pos, 9, "<![CDATA[") == 0) {
+            pos = xml.find("]]>", pos + 9);
+            if (pos == std::string::npos) {
+                return false;
+            }
+        } else if (xml.compare(pos, 9, "<!DOCTYPE") == 0) {
+            // entities declared there would be unknown to the fragments
+            return false;
+        } else if (isTag(xml, pos, "<TABLE")) {
+            const size_t end = tagEnd(xml, pos);
+            if (open != std::string::npos || end == std::string::npos) {
+                return false;
+            }
+            if (xml[end - 2] == '/') {
+                const TableSpan span = {pos, end};
+                spans.push_back(span);
+            } else {
+                open = pos;
+            }
+            pos = end;
+            continue;
+        } else if (isTag(xml, pos, "</TABLE")) {
+            const size_t end = tagEnd(xml, pos);
+            if (open == std::string::npos || end == std::string::npos) {
+                return false;
+            }
+            const TableSpan span = {open, end};
+            spans.push_back(span);
+            open = std::string::npos;
+            pos = end;
+            continue;
+        }
+        ++pos;
+    }
+    return open == std::string::npos;
+}
+
+/// @brief body of the threads parsing the tables
+/// @details Each thread has its own parser and takes the next unparsed table
+/// until there are none left. Errors are stored to be rethrown by the caller.
+void parseTables(const std::string& xml, const std::vector<TableSpan>& spans,
+                 std::vector<VOTableTable>& tables, std::vector<std::exception_ptr>& errors,
+                 size_t& next, boost::mutex& mutex)
+{
+    XercesDOMParser parser;
+    parser.setValidationScheme(XercesDOMParser::Val_Never);
+    parser.setDoNamespaces(false);
+    parser.setDoSchema(false);
+    parser.setLoadExternalDTD(false);
+    for (;;) {
+        size_t i;
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+            if (next >= spans.size()) {
+                return;
+            }
+            i = next++;
+        }
+        try {
+            const MemBufInputSource source(reinterpret_cast<const XMLByte*>(xml.data() + spans[i].begin),
+                    spans[i].end - spans[i].begin, "TABLE");
+            parser.parse(source);
+            const DOMElement* root = parser.getDocument()->getDocumentElement();
+            ASKAPCHECK(root, "TABLE number " << i << " could not be parsed");
+            tables[i] = VOTableTable::fromXmlElement(*root);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
+}
+
+}
+
 VOTable::VOTable(void)
 {
 }
@@ -75,12 +232,12 @@ std::string VOTable::getDescription() const
     return itsDescription;
 }
 
-std::vector<askap::accessors::VOTableInfo> VOTable::getInfo() const
+const std::vector<askap::accessors::VOTableInfo>& VOTable::getInfo() const
 {
     return itsInfo;
 }
 
-std::vector<askap::accessors::VOTableResource> VOTable::getResource() const
+const std::vector<askap::accessors::VOTableResource>& VOTable::getResource() const
 {
     return itsResource;
 }
@@ -95,24 +252,36 @@ void VOTable::addResource(const askap::accessors::VOTableResource& resource)
     itsResource.push_back(resource);
 }
 
+void VOTable::addResource(askap::accessors::VOTableResource&& resource)
+{
+    itsResource.push_back(std::move(resource));
+}
+
 void VOTable::addInfo(const askap::accessors::VOTableInfo& info)
 {
     itsInfo.push_back(info);
 }
 
+void VOTable::addInfo(askap::accessors::VOTableInfo&& info)
+{
+    itsInfo.push_back(std::move(info));
+}
+
 void VOTable::toXMLImpl(xercesc::XMLFormatTarget& target) const
 {
+    DataAccessStatistics::ScopedTimer timer("VOTable::toXML");
+
     // Create document
     DOMImplementation *impl = DOMImplementationRegistry::getDOMImplementation(XercescString("LS"));
     DOMDocument* doc = impl->createDocument();
     doc->setXmlVersion(XercescString("1.0"));
 
     // Create the root element and add it to the document
-    DOMElement* root = doc->createElement(XercescString("VOTABLE"));
-    root->setAttribute(XercescString("version"), XercescString("1.2"));
+    DOMElement* root = doc->createElement(VOTableTags::VOTABLE);
+    root->setAttribute(VOTableTags::ATTR_VERSION, XercescString("1.2"));
     root->setAttribute(XercescString("xmlns:xsi"),
                        XercescString("http://www.w3.org/2001/XMLSchema-instance"));
-    root->setAttribute(XercescString("xmlns"),
+    root->setAttribute(VOTableTags::ATTR_XMLNS,
                        XercescString("http://www.ivoa.net/xml/VOTable/v1.2"));
     root->setAttribute(XercescString("xmlns:stc"),
                        XercescString("http://www.ivoa.net/xml/STC/v1.30"));
@@ -121,7 +290,7 @@ void VOTable::toXMLImpl(xercesc::XMLFormatTarget& target) const
 
     // Create DESCRIPTION element
     if (itsDescription != "") {
-        DOMElement* descElement = doc->createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc->createElement(VOTableTags::DESCRIPTION);
         DOMText* text = doc->createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         root->appendChild(descElement);
@@ -158,6 +327,8 @@ void VOTable::toXMLImpl(xercesc::XMLFormatTarget& target) const
 
 VOTable VOTable::fromXMLImpl(const xercesc::InputSource& source)
 {
+    DataAccessStatistics::ScopedTimer timer("VOTable::fromXML");
+
     // Setup a parser
     boost::scoped_ptr<xercesc::XercesDOMParser> parser(new XercesDOMParser);
     parser->setValidationScheme(XercesDOMParser::Val_Never);
@@ -186,7 +357,7 @@ VOTable VOTable::fromXMLImpl(const xercesc::InputSource& source)
     vot.setDescription(desc);
 
     // Process INFO
-    DOMNodeList* children = root->getElementsByTagName(XercescString("INFO"));
+    DOMNodeList* children = root->getElementsByTagName(VOTableTags::INFO);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableInfo info = VOTableInfo::fromXmlElement(*node);
@@ -194,7 +365,7 @@ VOTable VOTable::fromXMLImpl(const xercesc::InputSource& source)
     }
 
     // Process RESOURCE
-    children = root->getElementsByTagName(XercescString("RESOURCE"));
+    children = root->getElementsByTagName(VOTableTags::RESOURCE);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableResource res = VOTableResource::fromXmlElement(*node);
@@ -207,6 +378,101 @@ VOTable VOTable::fromXMLImpl(const xercesc::InputSource& source)
     return vot;
 }
 
+VOTable VOTable::fromXMLParallelImpl(const std::string& xml, unsigned int nThreads)
+{
+    DataAccessStatistics::ScopedTimer timer("VOTable::fromXMLParallel");
+    timer.addBytes(xml.size());
+    std::vector<TableSpan> spans;
+    if (!indexTables(xml, spans) || spans.size() < 2) {
+        const MemBufInputSource source(reinterpret_cast<const XMLByte*>(xml.data()), xml.size(), "VOTABLE");
+        return fromXMLImpl(source);
+    }
+
+    // Parse the tables
+    if (nThreads == 0) {
+        nThreads = boost::thread::hardware_concurrency();
+    }
+    nThreads = std::max(1u, std::min(nThreads, static_cast<unsigned int>(spans.size())));
+    std::vector<VOTableTable> tables(spans.size());
+    std::vector<std::exception_ptr> errors(spans.size());
+    size_t next = 0;
+    boost::mutex mutex;
+    std::vector<boost::shared_ptr<boost::thread> > threads;
+    for (unsigned int t = 0; t < nThreads; ++t) {
+        threads.push_back(boost::shared_ptr<boost::thread>(new boost::thread(parseTables,
+                boost::cref(xml), boost::cref(spans), boost::ref(tables), boost::ref(errors),
+                boost::ref(next), boost::ref(mutex))));
+    }
+
+    for (size_t t = 0; t < threads.size(); ++t) {
+        threads[t]->join();
+    }
+    for (size_t i = 0; i < errors.size(); ++i) {
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+        }
+    }
+
+    // Parse the rest of the document with the tables replaced by placeholders
+    // named after the table index
+    std::string skeleton;
+    skeleton.reserve(xml.size() - spans.back().end + spans.front().begin + 32 * spans.size());
+    size_t pos = 0;
+    for (size_t i = 0; i < spans.size(); ++i) {
+        skeleton.append(xml, pos, spans[i].begin - pos);
+        std::ostringstream placeholder;
+        placeholder << "<TABLE name=\"" << i << "\"/>";
+        skeleton += placeholder.str();
+        pos = spans[i].end;
+    }
+    skeleton.append(xml, pos, std::string::npos);
+    const MemBufInputSource source(reinterpret_cast<const XMLByte*>(skeleton.data()),
+            skeleton.size(), "VOTABLE");
+    VOTable vot = fromXMLImpl(source);
+
+    // Put the tables in place, a table referred to more than once is copied
+    std::vector<size_t> uses(tables.size(), 0);
+    for (std::vector<VOTableResource>::const_iterator it = vot.itsResource.begin();
+            it != vot.itsResource.end(); ++it) {
+        for (size_t t = 0; t < it->getTables().size(); ++t) {
+            const size_t index = std::strtoul(it->getTables()[t].getName().c_str(), 0, 10);
+            ASKAPDEBUGASSERT(index < uses.size());
+            ++uses[index];
+        }
+    }
+    for (std::vector<VOTableResource>::iterator it = vot.itsResource.begin();
+            it != vot.itsResource.end(); ++it) {
+        std::vector<VOTableTable>& resTables = it->getTables();
+        for (size_t t = 0; t < resTables.size(); ++t) {
+            const size_t index = std::strtoul(resTables[t].getName().c_str(), 0, 10);
+            if (--uses[index] == 0) {
+                resTables[t] = std::move(tables[index]);
+            } else {
+                resTables[t] = tables[index];
+            }
+        }
+    }
+    ASKAPLOG_DEBUG_STR(logger, "Parsed " << spans.size() << " tables using " << nThreads << " threads");
+    return vot;
+}
+
+VOTable VOTable::fromXMLParallel(const std::string& filename, unsigned int nThreads)
+{
+    VOTableInputStream is(filename);
+    return fromXMLParallel(is, nThreads);
+}
+
+VOTable VOTable::fromXMLParallel(std::istream& is, unsigned int nThreads)
+{
+    const std::string xml((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+
+    xercesc::XMLPlatformUtils::Initialize();
+    VOTable vot;
+    vot = fromXMLParallelImpl(xml, nThreads);
+    xercesc::XMLPlatformUtils::Terminate();
+    return vot;
+}
+
 VOTable VOTable::fromXML(const std::string& filename)
 {
     // Check if the file exists
@@ -214,6 +480,13 @@ VOTable VOTable::fromXML(const std::string& filename)
     if (!fs) {
         ASKAPTHROW(AskapError, "File " << filename << " could not be opened");
     }
+    fs.close();
+
+    // Compressed files are decompressed in memory
+    if (VOTableCompression::detect(filename) != VOTableCompression::NONE) {
+        VOTableInputStream is(filename);
+        return fromXML(is);
+    }
 
     // Parse and build VOTable
     xercesc::XMLPlatformUtils::Initialize();
@@ -229,6 +502,13 @@ VOTable VOTable::fromXML(const std::string& filename)
 
 void VOTable::toXML(const std::string& filename) const
 {
+    if (VOTableCompression::fromFilename(filename) != VOTableCompression::NONE) {
+        VOTableOutputStream os(filename);
+        toXML(os);
+        os.close();
+        return;
+    }
+
     xercesc::XMLPlatformUtils::Initialize();
 
     boost::scoped_ptr<LocalFileFormatTarget> target(new LocalFileFormatTarget(XercescString(filename)));
@@ -64,19 +64,21 @@ namespace askap {
                 std::string getDescription() const;
 
                 /// Get a vector containing all the INFO elements in the VOTable
-                std::vector<askap::accessors::VOTableInfo> getInfo() const;
+                const std::vector<askap::accessors::VOTableInfo>& getInfo() const;
 
                 /// Get a vector containing all the RESOURCE elements in the VOTable
-                std::vector<askap::accessors::VOTableResource> getResource() const;
+                const std::vector<askap::accessors::VOTableResource>& getResource() const;
 
                 /// Set the text of the DESCRIPTION element.
                 void setDescription(const std::string& desc);
 
                 /// Add a RESOURCE element to the VOTable
                 void addResource(const askap::accessors::VOTableResource& resource);
+                void addResource(askap::accessors::VOTableResource&& resource);
 
                 /// Add an INFO element to the VOTable
                 void addInfo(const askap::accessors::VOTableInfo& info);
+                void addInfo(askap::accessors::VOTableInfo&& info);
 
                 /// Transform the VOTable object into an XML VOTable
                 ///
@@ -94,17 +96,49 @@ namespace askap {
 
                 /// Transform the VOTable object into an XML VOTable
                 ///
-                /// @param[in] filename the file/path to write the XML output to.
+                /// @param[in] filename the file/path to write the XML output to,
+                ///                     compressed if it ends with .gz or .zst
+                ///                     (see VOTableOutputStream).
                 void toXML(const std::string& filename) const;
 
                 /// Transform an XML VOTable to a VOTable object instance
                 ///
-                /// @param[in] filename the file/path to read the XML input from.
+                /// @param[in] filename the file/path to read the XML input from,
+                ///                     gzip and zstd compressed files are
+                ///                     decompressed (see VOTableInputStream).
                 /// @return a VOTable.
                 /// @throw AskapError   if the XML document is empty (i.e. no root)
                 ///                     or if the specified file cannot be opened.
                 static VOTable fromXML(const std::string& filename);
 
+                /// Transform an XML VOTable to a VOTable object instance,
+                /// parsing the tables in parallel
+                ///
+                /// @details The document is scanned for the TABLE elements first.
+                /// The rest of the document is parsed with the tables replaced by
+                /// placeholders, while the tables are parsed by a pool of threads
+                /// and then put in place, in document order. The result is the same
+                /// as with fromXML. Documents which can't be split this way (a
+                /// single table, a DOCTYPE, an encoding other than UTF-8 or nested
+                /// TABLE elements) are parsed serially.
+                ///
+                /// @param[in] filename the file/path to read the XML input from.
+                /// @param[in] nThreads number of threads, 0 means the number of cores
+                /// @return a VOTable.
+                /// @throw AskapError   if the XML document is empty (i.e. no root)
+                ///                     or if the specified file cannot be opened.
+                static VOTable fromXMLParallel(const std::string& filename, unsigned int nThreads = 0);
+
+                /// Transform an XML VOTable to a VOTable object instance,
+                /// parsing the tables in parallel
+                ///
+                /// @param[in] is   an istream from which the XML input string
+                ///                 will be read from.
+                /// @param[in] nThreads number of threads, 0 means the number of cores
+                /// @return a VOTable.
+                /// @throw AskapError   if the XML document is empty (i.e. no root).
+                static VOTable fromXMLParallel(std::istream& is, unsigned int nThreads = 0);
+
             private:
 
                 /// Transform the VOTable object into an XML VOTable
@@ -115,6 +149,9 @@ namespace askap {
                 /// @throw AskapError   if the XML document is empty (i.e. no root).
                 static VOTable fromXMLImpl(const xercesc::InputSource& source);
 
+                /// Parse the document held in memory, the tables in parallel
+                static VOTable fromXMLParallelImpl(const std::string& xml, unsigned int nThreads);
+
                 /// The text for the DESCRIPTION element
                 std::string itsDescription;
 
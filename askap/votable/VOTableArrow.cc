@@ -0,0 +1,574 @@
+/// @file VOTableArrow.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// Include own header file first
+#include "VOTableArrow.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapError.h>
+
+// Local package includes
+#include "askap/votable/VOTableField.h"
+#include "askap/votable/VOTableColumn.h"
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// keys of the field attributes in the metadata, in the order of fieldAttributes
+const char* const theirFieldKeys[] = {"votable.id", "votable.datatype", "votable.arraysize", "votable.unit",
+                                      "votable.ucd", "votable.utype"};
+
+/// keys of the table attributes in the metadata
+const char* const theirTableKeys[] = {"votable.id", "votable.description"};
+
+/// buffer used for empty columns, it is a valid offsets buffer of a string column as well
+const int64_t theirEmptyBuffer[1] = {0};
+
+/// private data of an exported schema
+struct SchemaHolder {
+    std::string itsFormat;
+    std::string itsName;
+    std::string itsMetadata;
+    std::vector<ArrowSchema*> itsChildren;
+};
+
+/// private data of an exported array
+struct ArrayHolder {
+    /// the table owning the buffers shared with the array
+    boost::shared_ptr<const VOTableTable> itsTable;
+    std::vector<uint8_t> itsValidity;
+    std::vector<uint8_t> itsValues;
+    std::vector<int32_t> itsOffsets;
+    std::vector<int64_t> itsLargeOffsets;
+    std::string itsText;
+    std::vector<const void*> itsBuffers;
+    std::vector<ArrowArray*> itsChildren;
+};
+
+void releaseSchema(ArrowSchema* schema)
+{
+    SchemaHolder* holder = static_cast<SchemaHolder*>(schema->private_data);
+    for (size_t i = 0; i < holder->itsChildren.size(); ++i) {
+        ArrowSchema* child = holder->itsChildren[i];
+        // the consumer may have moved the child out and released it already
+        if (child->release != 0) {
+            child->release(child);
+        }
+        delete child;
+    }
+    delete holder;
+    schema->release = 0;
+}
+
+void releaseArray(ArrowArray* array)
+{
+    ArrayHolder* holder = static_cast<ArrayHolder*>(array->private_data);
+    for (size_t i = 0; i < holder->itsChildren.size(); ++i) {
+        ArrowArray* child = holder->itsChildren[i];
+        if (child->release != 0) {
+            child->release(child);
+        }
+        delete child;
+    }
+    delete holder;
+    array->release = 0;
+}
+
+/// Append a 32-bit integer in the native byte order, as required for the metadata
+void appendInt32(std::string& out, size_t value)
+{
+    ASKAPCHECK(value <= static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+               "Metadata entry of " << value << " bytes is too long");
+    const int32_t v = static_cast<int32_t>(value);
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+/// Read a 32-bit integer in the native byte order
+int32_t readInt32(const char*& ptr)
+{
+    int32_t v = 0;
+    std::memcpy(&v, ptr, sizeof(v));
+    ptr += sizeof(v);
+    return v;
+}
+
+/// Encode the metadata in the format of the Arrow C data interface
+/// @param[in] keys keys of the entries
+/// @param[in] values values of the entries, empty ones are skipped
+/// @param[in] count number of entries
+/// @return encoded metadata, empty if there are no entries
+std::string encodeMetadata(const char* const* keys, const std::string* values, size_t count)
+{
+    std::string entries;
+    size_t nEntries = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!values[i].empty()) {
+            const size_t keySize = std::strlen(keys[i]);
+            appendInt32(entries, keySize);
+            entries.append(keys[i], keySize);
+            appendInt32(entries, values[i].size());
+            entries += values[i];
+            ++nEntries;
+        }
+    }
+    if (nEntries == 0) {
+        return std::string();
+    }
+    std::string result;
+    appendInt32(result, nEntries);
+    return result + entries;
+}
+
+/// Look up a key in the metadata of the Arrow C data interface
+/// @param[in] metadata encoded metadata, may be null
+/// @param[in] key key to look up
+/// @return value, empty if the key is not present
+std::string metadataValue(const char* metadata, const std::string& key)
+{
+    if (metadata == 0) {
+        return std::string();
+    }
+    const char* ptr = metadata;
+    const int32_t nEntries = readInt32(ptr);
+    for (int32_t i = 0; i < nEntries; ++i) {
+        const int32_t keySize = readInt32(ptr);
+        const char* keyPtr = ptr;
+        ptr += keySize;
+        const int32_t valueSize = readInt32(ptr);
+        if (key.compare(0, std::string::npos, keyPtr, keySize) == 0) {
+            return std::string(ptr, valueSize);
+        }
+        ptr += valueSize;
+    }
+    return std::string();
+}
+
+/// Attach the holder to the schema, the pointers of the holder are used as they are now
+void initSchema(ArrowSchema* schema, SchemaHolder* holder, int64_t flags)
+{
+    schema->format = holder->itsFormat.c_str();
+    schema->name = holder->itsName.c_str();
+    schema->metadata = holder->itsMetadata.empty() ? 0 : holder->itsMetadata.data();
+    schema->flags = flags;
+    schema->n_children = static_cast<int64_t>(holder->itsChildren.size());
+    schema->children = holder->itsChildren.empty() ? 0 : &holder->itsChildren[0];
+    schema->dictionary = 0;
+    schema->release = &releaseSchema;
+    schema->private_data = holder;
+}
+
+/// Attach the holder to the array, the pointers of the holder are used as they are now
+void initArray(ArrowArray* array, ArrayHolder* holder, int64_t length, int64_t nullCount)
+{
+    array->length = length;
+    array->null_count = nullCount;
+    array->offset = 0;
+    array->n_buffers = static_cast<int64_t>(holder->itsBuffers.size());
+    array->n_children = static_cast<int64_t>(holder->itsChildren.size());
+    array->buffers = &holder->itsBuffers[0];
+    array->children = holder->itsChildren.empty() ? 0 : &holder->itsChildren[0];
+    array->dictionary = 0;
+    array->release = &releaseArray;
+    array->private_data = holder;
+}
+
+/// @return true if the given bit of the bitmap is set (a null bitmap means all bits are set)
+inline bool bitSet(const void* bitmap, int64_t index)
+{
+    return bitmap == 0 || ((static_cast<const uint8_t*>(bitmap)[index >> 3] >> (index & 7)) & 1) != 0;
+}
+
+/// Build a bitmap with one bit per element
+template<typename Predicate>
+void makeBitmap(size_t size, Predicate predicate, std::vector<uint8_t>& bitmap)
+{
+    bitmap.assign((size + 7) / 8, 0);
+    for (size_t i = 0; i < size; ++i) {
+        if (predicate(i)) {
+            bitmap[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+        }
+    }
+}
+
+/// predicate of the cells which are not null
+struct NotNull {
+    explicit NotNull(const VOTableColumn& column) : itsColumn(column) {}
+    bool operator()(size_t row) const { return !itsColumn.isNull(row); }
+    const VOTableColumn& itsColumn;
+};
+
+/// predicate of the true values of a BOOLEAN column
+struct IsTrue {
+    explicit IsTrue(const std::vector<char>& values) : itsValues(values) {}
+    bool operator()(size_t row) const { return itsValues[row] == 'T'; }
+    const std::vector<char>& itsValues;
+};
+
+/// Fill the offsets and the text of a string column
+template<typename Offset>
+void makeStrings(const std::vector<std::string>& strings, std::vector<Offset>& offsets, std::string& text,
+                 size_t totalSize)
+{
+    offsets.resize(strings.size() + 1);
+    text.reserve(totalSize);
+    offsets[0] = 0;
+    for (size_t i = 0; i < strings.size(); ++i) {
+        text += strings[i];
+        offsets[i + 1] = static_cast<Offset>(text.size());
+    }
+}
+
+/// @return attributes of the field in the order of theirFieldKeys
+std::vector<std::string> fieldAttributes(const VOTableField& field)
+{
+    std::vector<std::string> values;
+    values.push_back(field.getID());
+    values.push_back(field.getDatatype());
+    values.push_back(field.getArraysize());
+    values.push_back(field.getUnit());
+    values.push_back(field.getUCD());
+    values.push_back(field.getUType());
+    return values;
+}
+
+/// Datatype and arraysize of the field implied by the Arrow format
+/// @return false if the format is not supported
+bool defaultDatatype(const std::string& format, std::string& datatype, std::string& arraysize)
+{
+    static const char* const formats[][3] = {{"g", "double", ""}, {"f", "float", ""}, {"l", "long", ""},
+        {"i", "int", ""}, {"s", "short", ""}, {"c", "short", ""}, {"C", "unsignedByte", ""},
+        {"S", "int", ""}, {"I", "long", ""}, {"b", "boolean", ""}, {"u", "char", "*"}, {"U", "char", "*"}};
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+        if (format == formats[i][0]) {
+            datatype = formats[i][1];
+            arraysize = formats[i][2];
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Storage type for the given Arrow format, STRING for the utf8 formats
+VOTableColumn::Type storageType(const std::string& format)
+{
+    if (format == "g" || format == "f") {
+        return VOTableColumn::REAL;
+    }
+    if (format == "b") {
+        return VOTableColumn::BOOLEAN;
+    }
+    if (format == "u" || format == "U") {
+        return VOTableColumn::STRING;
+    }
+    return VOTableColumn::INTEGER;
+}
+
+/// Append the typed values of an Arrow array to a column
+/// @param[in] child array of the column
+/// @param[in] parent struct array with the table (its offset and validity apply to all columns)
+template<typename T>
+void appendNumbers(const ArrowArray& child, const ArrowArray& parent, bool singlePrecision,
+                   VOTableColumn& column)
+{
+    const void* validity = child.null_count != 0 ? child.buffers[0] : 0;
+    const void* parentValidity = parent.null_count != 0 ? parent.buffers[0] : 0;
+    const T* values = static_cast<const T*>(child.buffers[1]);
+    for (int64_t row = 0; row < parent.length; ++row) {
+        const int64_t index = row + parent.offset + child.offset;
+        if (!bitSet(validity, index) || !bitSet(parentValidity, row + parent.offset)) {
+            column.appendNull();
+        } else if (column.getType() == VOTableColumn::REAL) {
+            column.appendReal(static_cast<double>(values[index]), singlePrecision);
+        } else {
+            column.appendInteger(static_cast<long long>(values[index]));
+        }
+    }
+}
+
+/// Append the text of a utf8 Arrow array to a column, the text is parsed for typed columns
+template<typename Offset>
+void appendStrings(const ArrowArray& child, const ArrowArray& parent, VOTableColumn& column)
+{
+    const void* validity = child.null_count != 0 ? child.buffers[0] : 0;
+    const void* parentValidity = parent.null_count != 0 ? parent.buffers[0] : 0;
+    const Offset* offsets = static_cast<const Offset*>(child.buffers[1]);
+    const char* text = static_cast<const char*>(child.buffers[2]);
+    for (int64_t row = 0; row < parent.length; ++row) {
+        const int64_t index = row + parent.offset + child.offset;
+        if (!bitSet(validity, index) || !bitSet(parentValidity, row + parent.offset)) {
+            column.appendNull();
+        } else {
+            column.addCell(std::string(text + offsets[index], static_cast<size_t>(offsets[index + 1] -
+                           offsets[index])));
+        }
+    }
+}
+
+/// Append the values of a boolean Arrow array to a column
+void appendBooleans(const ArrowArray& child, const ArrowArray& parent, VOTableColumn& column)
+{
+    const void* validity = child.null_count != 0 ? child.buffers[0] : 0;
+    const void* parentValidity = parent.null_count != 0 ? parent.buffers[0] : 0;
+    for (int64_t row = 0; row < parent.length; ++row) {
+        const int64_t index = row + parent.offset + child.offset;
+        if (!bitSet(validity, index) || !bitSet(parentValidity, row + parent.offset)) {
+            column.appendNull();
+        } else {
+            column.appendBoolean(bitSet(child.buffers[1], index));
+        }
+    }
+}
+
+/// Releases the imported structures when it goes out of scope
+struct ImportGuard {
+    ImportGuard(ArrowSchema* schema, ArrowArray* array) : itsSchema(schema), itsArray(array) {}
+    ~ImportGuard() {
+        if (itsSchema != 0 && itsSchema->release != 0) {
+            itsSchema->release(itsSchema);
+        }
+        if (itsArray != 0 && itsArray->release != 0) {
+            itsArray->release(itsArray);
+        }
+    }
+    ArrowSchema* itsSchema;
+    ArrowArray* itsArray;
+};
+
+/// Export a single column
+/// @param[in] column typed storage of the column
+/// @param[in] field field of the column
+/// @param[in] table table owning the column
+/// @param[out] schema schema of the child
+/// @param[out] array child array
+void exportColumn(const VOTableColumn& column, const VOTableField& field,
+                  const boost::shared_ptr<const VOTableTable>& table, ArrowSchema* schema, ArrowArray* array)
+{
+    const size_t nRows = column.size();
+    SchemaHolder* schemaHolder = new SchemaHolder;
+    schemaHolder->itsName = field.getName();
+    const std::vector<std::string> attributes = fieldAttributes(field);
+    schemaHolder->itsMetadata = encodeMetadata(theirFieldKeys, &attributes[0],
+                                               sizeof(theirFieldKeys) / sizeof(theirFieldKeys[0]));
+    ArrayHolder* arrayHolder = new ArrayHolder;
+    arrayHolder->itsTable = table;
+    size_t nullCount = 0;
+    for (size_t row = 0; row < nRows; ++row) {
+        if (column.isNull(row)) {
+            ++nullCount;
+        }
+    }
+    if (nullCount > 0) {
+        makeBitmap(nRows, NotNull(column), arrayHolder->itsValidity);
+        arrayHolder->itsBuffers.push_back(&arrayHolder->itsValidity[0]);
+    } else {
+        arrayHolder->itsBuffers.push_back(0);
+    }
+    switch (column.getType()) {
+        case VOTableColumn::REAL:
+            schemaHolder->itsFormat = "g";
+            arrayHolder->itsBuffers.push_back(nRows > 0 ? static_cast<const void*>(&column.getReals()[0]) :
+                                              theirEmptyBuffer);
+            break;
+        case VOTableColumn::INTEGER:
+            schemaHolder->itsFormat = "l";
+            arrayHolder->itsBuffers.push_back(nRows > 0 ? static_cast<const void*>(&column.getIntegers()[0]) :
+                                              theirEmptyBuffer);
+            break;
+        case VOTableColumn::BOOLEAN:
+            schemaHolder->itsFormat = "b";
+            makeBitmap(nRows, IsTrue(column.getBooleans()), arrayHolder->itsValues);
+            arrayHolder->itsBuffers.push_back(nRows > 0 ? static_cast<const void*>(&arrayHolder->itsValues[0]) :
+                                              theirEmptyBuffer);
+            break;
+        case VOTableColumn::STRING: {
+            const std::vector<std::string>& strings = column.getStrings();
+            size_t totalSize = 0;
+            for (size_t row = 0; row < nRows; ++row) {
+                totalSize += strings[row].size();
+            }
+            if (totalSize > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+                schemaHolder->itsFormat = "U";
+                makeStrings(strings, arrayHolder->itsLargeOffsets, arrayHolder->itsText, totalSize);
+                arrayHolder->itsBuffers.push_back(&arrayHolder->itsLargeOffsets[0]);
+            } else {
+                schemaHolder->itsFormat = "u";
+                makeStrings(strings, arrayHolder->itsOffsets, arrayHolder->itsText, totalSize);
+                arrayHolder->itsBuffers.push_back(&arrayHolder->itsOffsets[0]);
+            }
+            arrayHolder->itsBuffers.push_back(totalSize > 0 ? static_cast<const void*>(arrayHolder->itsText.data()) :
+                                              theirEmptyBuffer);
+            break;
+        }
+    }
+    initSchema(schema, schemaHolder, ARROW_FLAG_NULLABLE);
+    initArray(array, arrayHolder, static_cast<int64_t>(nRows), static_cast<int64_t>(nullCount));
+}
+
+}
+
+void VOTableArrow::exportTable(const boost::shared_ptr<const VOTableTable>& table, struct ArrowSchema* schema,
+                               struct ArrowArray* array)
+{
+    ASKAPCHECK(table, "An attempt to export an empty shared pointer");
+    ASKAPCHECK(schema != 0 && array != 0, "Output structures are required to export the table");
+    const std::vector<VOTableField>& fields = table->getFields();
+    const size_t nColumns = std::max(fields.size(), table->getNColumns());
+
+    SchemaHolder* schemaHolder = new SchemaHolder;
+    schemaHolder->itsFormat = "+s";
+    schemaHolder->itsName = table->getName();
+    const std::string attributes[] = {table->getID(), table->getDescription()};
+    schemaHolder->itsMetadata = encodeMetadata(theirTableKeys, attributes,
+                                               sizeof(theirTableKeys) / sizeof(theirTableKeys[0]));
+    ArrayHolder* arrayHolder = new ArrayHolder;
+    arrayHolder->itsBuffers.push_back(0);
+    // the children are attached first, so they are cleaned up by the release callbacks on error
+    for (size_t c = 0; c < nColumns; ++c) {
+        schemaHolder->itsChildren.push_back(new ArrowSchema());
+        arrayHolder->itsChildren.push_back(new ArrowArray());
+    }
+    initSchema(schema, schemaHolder, 0);
+    initArray(array, arrayHolder, static_cast<int64_t>(table->getNRows()), 0);
+    try {
+        for (size_t c = 0; c < nColumns; ++c) {
+            VOTableField field;
+            if (c < fields.size()) {
+                field = fields[c];
+            } else {
+                // extra cells of the rows are strings with no field
+                field.setName("column" + std::to_string(c));
+                field.setDatatype("char");
+                field.setArraysize("*");
+            }
+            if (c < table->getNColumns()) {
+                exportColumn(table->getColumn(c), field, table, schemaHolder->itsChildren[c],
+                             arrayHolder->itsChildren[c]);
+            } else {
+                // the table has no rows, so the columns have not been created
+                const VOTableColumn empty(VOTableColumn::typeOf(field));
+                exportColumn(empty, field, table, schemaHolder->itsChildren[c], arrayHolder->itsChildren[c]);
+            }
+        }
+    } catch (...) {
+        schema->release(schema);
+        array->release(array);
+        throw;
+    }
+}
+
+void VOTableArrow::exportTable(const VOTableTable& table, struct ArrowSchema* schema, struct ArrowArray* array)
+{
+    exportTable(boost::shared_ptr<const VOTableTable>(new VOTableTable(table)), schema, array);
+}
+
+VOTableTable VOTableArrow::importTable(struct ArrowSchema* schema, struct ArrowArray* array)
+{
+    const ImportGuard guard(schema, array);
+    ASKAPCHECK(schema != 0 && array != 0, "Schema and array are required to import a table");
+    ASKAPCHECK(schema->release != 0 && array->release != 0, "An attempt to import released Arrow structures");
+    ASKAPCHECK(std::string(schema->format) == "+s", "Only struct arrays can be imported as a table, the format is " <<
+               schema->format);
+    ASKAPCHECK(schema->n_children == array->n_children, "Schema has " << schema->n_children <<
+               " children, the array has " << array->n_children);
+
+    VOTableTable table;
+    table.setName(schema->name != 0 ? schema->name : "");
+    table.setID(metadataValue(schema->metadata, theirTableKeys[0]));
+    table.setDescription(metadataValue(schema->metadata, theirTableKeys[1]));
+
+    std::vector<VOTableColumn> columns;
+    columns.reserve(static_cast<size_t>(schema->n_children));
+    for (int64_t c = 0; c < schema->n_children; ++c) {
+        const ArrowSchema& childSchema = *schema->children[c];
+        const ArrowArray& child = *array->children[c];
+        const std::string format(childSchema.format);
+        VOTableField field;
+        std::string datatype;
+        std::string arraysize;
+        ASKAPCHECK(defaultDatatype(format, datatype, arraysize), "Arrow format " << format << " of column " <<
+                   (childSchema.name != 0 ? childSchema.name : "") << " is not supported");
+        field.setName(childSchema.name != 0 ? childSchema.name : "");
+        field.setID(metadataValue(childSchema.metadata, theirFieldKeys[0]));
+        const std::string storedDatatype = metadataValue(childSchema.metadata, theirFieldKeys[1]);
+        if (!storedDatatype.empty()) {
+            datatype = storedDatatype;
+            arraysize = metadataValue(childSchema.metadata, theirFieldKeys[2]);
+        }
+        field.setDatatype(datatype);
+        field.setArraysize(arraysize);
+        field.setUnit(metadataValue(childSchema.metadata, theirFieldKeys[3]));
+        field.setUCD(metadataValue(childSchema.metadata, theirFieldKeys[4]));
+        field.setUType(metadataValue(childSchema.metadata, theirFieldKeys[5]));
+
+        const VOTableColumn::Type type = VOTableColumn::typeOf(field);
+        ASKAPCHECK(storageType(format) == VOTableColumn::STRING || storageType(format) == type,
+                   "Arrow format " << format << " of column " << field.getName() <<
+                   " doesn't match its datatype " << datatype);
+        VOTableColumn column(type);
+        if (format == "g") {
+            appendNumbers<double>(child, *array, false, column);
+        } else if (format == "f") {
+            appendNumbers<float>(child, *array, true, column);
+        } else if (format == "l") {
+            appendNumbers<int64_t>(child, *array, false, column);
+        } else if (format == "i") {
+            appendNumbers<int32_t>(child, *array, false, column);
+        } else if (format == "s") {
+            appendNumbers<int16_t>(child, *array, false, column);
+        } else if (format == "c") {
+            appendNumbers<int8_t>(child, *array, false, column);
+        } else if (format == "C") {
+            appendNumbers<uint8_t>(child, *array, false, column);
+        } else if (format == "S") {
+            appendNumbers<uint16_t>(child, *array, false, column);
+        } else if (format == "I") {
+            appendNumbers<uint32_t>(child, *array, false, column);
+        } else if (format == "b") {
+            appendBooleans(child, *array, column);
+        } else if (format == "u") {
+            appendStrings<int32_t>(child, *array, column);
+        } else {
+            appendStrings<int64_t>(child, *array, column);
+        }
+        table.addField(std::move(field));
+        columns.push_back(std::move(column));
+    }
+    table.setColumns(std::move(columns));
+    return table;
+}
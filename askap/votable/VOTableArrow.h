@@ -0,0 +1,149 @@
+/// @file VOTableArrow.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEARROW_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEARROW_H
+
+// System includes
+#include <stdint.h>
+
+// Boost includes
+#include <boost/shared_ptr.hpp>
+
+// Local package includes
+#include "askap/votable/VOTableTable.h"
+
+// Structures of the Arrow C data interface. They are defined by the Arrow specification
+// as a stable ABI meant to be copied into other projects, so no Arrow library is needed
+// on either side. The guard is the one used by Arrow itself, so the definitions can
+// coexist with Arrow headers.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Exchange of VOTableTable data in the Arrow columnar format
+        /// @details The table is exported through the Arrow C data interface as a struct
+        /// array with one child per column, which pyarrow (pyarrow.RecordBatch._import_from_c),
+        /// the Arrow C++ library and other implementations import without copying. The
+        /// children are:
+        ///   - float64 for REAL columns, sharing the values of the typed store;
+        ///   - int64 for INTEGER columns, sharing the values of the typed store;
+        ///   - boolean for BOOLEAN columns (bit-packed, so the values are copied);
+        ///   - utf8 (large_utf8 for more than 2 GB of text) for STRING columns, which also
+        ///     hold arrays and complex values as space-separated text.
+        /// Null (empty) cells are marked in the validity bitmaps. A REAL cell whose text
+        /// is not a number is exported as a non-null NaN.
+        ///
+        /// The attributes of the fields are kept in the metadata of the children under
+        /// the keys votable.id, votable.datatype, votable.arraysize, votable.unit,
+        /// votable.ucd and votable.utype; the table ID and description are kept in the
+        /// metadata of the struct (its name is the table name). Import uses the metadata
+        /// to restore the fields, so a table survives the round trip unchanged, apart from
+        /// the text of the real values which is regenerated from the values (see
+        /// VOTableColumn::appendReal). Tables from other producers get the datatypes
+        /// implied by the Arrow types.
+        ///
+        /// Groups and the serialisation format of the table are not exported.
+        ///
+        /// @ingroup votableaccess
+        class VOTableArrow {
+            public:
+
+                /// Export the table without copying the numeric columns
+                /// @details The exported array keeps the table alive until it is
+                /// released, the table shouldn't be modified in the meantime.
+                /// @param[in] table table to export
+                /// @param[out] schema schema of the struct array, released by the consumer
+                /// @param[out] array struct array with the table data, released by the consumer
+                static void exportTable(const boost::shared_ptr<const VOTableTable>& table,
+                                        struct ArrowSchema* schema, struct ArrowArray* array);
+
+                /// Export a copy of the table
+                /// @details This version is for a table with no shared pointer. The
+                /// table is copied once, the exported array is independent of it.
+                /// @param[in] table table to export
+                /// @param[out] schema schema of the struct array, released by the consumer
+                /// @param[out] array struct array with the table data, released by the consumer
+                static void exportTable(const VOTableTable& table, struct ArrowSchema* schema,
+                                        struct ArrowArray* array);
+
+                /// Import a table
+                /// @details The typed values are appended to the columns directly, without
+                /// converting them to text. Both structures are released when the method
+                /// returns, including when an exception is thrown.
+                /// @param[in] schema schema of a struct array
+                /// @param[in] array struct array with one child per column
+                /// @return new table
+                /// @throw AskapError   if the schema has other than struct format or a
+                ///                     child has a type which is not supported
+                static VOTableTable importTable(struct ArrowSchema* schema, struct ArrowArray* array);
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,533 @@
+/// @file VOTableBinary.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// Include own header file first
+#include "VOTableBinary.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <stdint.h>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapError.h>
+#include "boost/algorithm/string/split.hpp"
+#include "boost/algorithm/string/classification.hpp"
+#include "boost/algorithm/string/trim.hpp"
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief append the given number of the least significant bytes of the value, big endian
+void putBE(uint64_t value, size_t size, std::string& out)
+{
+    for (size_t i = size; i > 0; --i) {
+        out.push_back(static_cast<char>((value >> (8 * (i - 1))) & 0xff));
+    }
+}
+
+/// @brief read a big endian value of the given size
+uint64_t getBE(const char* data, size_t size)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value = (value << 8) | static_cast<unsigned char>(data[i]);
+    }
+    return value;
+}
+
+/// @brief shortest representation which converts back to the same value
+template<typename T>
+std::string formatReal(T value, int minPrecision, int maxPrecision)
+{
+    std::string result;
+    for (int precision = minPrecision; precision <= maxPrecision; ++precision) {
+        std::ostringstream os;
+        os.precision(precision);
+        os << value;
+        result = os.str();
+        if (static_cast<T>(std::strtod(result.c_str(), 0)) == value) {
+            break;
+        }
+    }
+    return result;
+}
+
+/// @brief split UTF-8 string into UCS-2 code units, characters outside of BMP are replaced by '?'
+std::vector<uint16_t> utf8ToUcs2(const std::string& str)
+{
+    std::vector<uint16_t> result;
+    result.reserve(str.size());
+    for (size_t i = 0; i < str.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c < 0x80) {
+            result.push_back(c);
+        } else if ((c >> 5) == 0x6 && i + 1 < str.size()) {
+            result.push_back(((c & 0x1f) << 6) | (static_cast<unsigned char>(str[i + 1]) & 0x3f));
+            i += 1;
+        } else if ((c >> 4) == 0xe && i + 2 < str.size()) {
+            result.push_back(((c & 0x0f) << 12) | ((static_cast<unsigned char>(str[i + 1]) & 0x3f) << 6) |
+                             (static_cast<unsigned char>(str[i + 2]) & 0x3f));
+            i += 2;
+        } else {
+            result.push_back('?');
+            while (i + 1 < str.size() && (static_cast<unsigned char>(str[i + 1]) >> 6) == 0x2) {
+                ++i;
+            }
+        }
+    }
+    return result;
+}
+
+/// @brief append UCS-2 code unit as UTF-8
+void appendUtf8(uint16_t cu, std::string& out)
+{
+    if (cu < 0x80) {
+        out.push_back(static_cast<char>(cu));
+    } else if (cu < 0x800) {
+        out.push_back(static_cast<char>(0xc0 | (cu >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cu & 0x3f)));
+    } else {
+        out.push_back(static_cast<char>(0xe0 | (cu >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cu >> 6) & 0x3f)));
+        out.push_back(static_cast<char>(0x80 | (cu & 0x3f)));
+    }
+}
+
+const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// @brief value of base64 character, -1 if invalid
+int base64Value(char c)
+{
+    if (c >= 'A' && c <= 'Z') {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z') {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9') {
+        return c - '0' + 52;
+    }
+    if (c == '+') {
+        return 62;
+    }
+    if (c == '/') {
+        return 63;
+    }
+    return -1;
+}
+
+}
+
+VOTableBinary::VOTableBinary(const std::vector<VOTableField>& fields, bool binary2) :
+    itsBinary2(binary2), itsPos(0)
+{
+    for (std::vector<VOTableField>::const_iterator it = fields.begin();
+            it != fields.end(); ++it) {
+        itsColumns.push_back(makeColumn(*it));
+    }
+}
+
+void VOTableBinary::encodeRow(const VOTableRow& row, std::string& out) const
+{
+    const std::vector<std::string>& cells = row.getCells();
+    ASKAPCHECK(cells.size() == itsColumns.size(), "Row has " << cells.size() <<
+               " cells, the table has " << itsColumns.size() << " fields");
+    if (itsBinary2) {
+        std::string flags((itsColumns.size() + 7) / 8, '\0');
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (cells[i].empty()) {
+                flags[i / 8] |= static_cast<char>(0x80 >> (i % 8));
+            }
+        }
+        out += flags;
+    }
+    for (size_t i = 0; i < cells.size(); ++i) {
+        encodeCell(itsColumns[i], cells[i], cells[i].empty(), out);
+    }
+}
+
+void VOTableBinary::appendData(const char* data, size_t size)
+{
+    // drop the decoded part once it dominates the buffer
+    if (itsPos > 65536 && 2 * itsPos > itsBuffer.size()) {
+        itsBuffer.erase(0, itsPos);
+        itsPos = 0;
+    }
+    itsBuffer.append(data, size);
+}
+
+bool VOTableBinary::nextRow(VOTableRow& row)
+{
+    const size_t nFlagBytes = itsBinary2 ? (itsColumns.size() + 7) / 8 : 0;
+    size_t pos = itsPos + nFlagBytes;
+    if (pos > itsBuffer.size()) {
+        return false;
+    }
+    // find the layout of the row first, nothing is consumed if it is incomplete
+    std::vector<size_t> offsets(itsColumns.size());
+    std::vector<size_t> counts(itsColumns.size());
+    for (size_t i = 0; i < itsColumns.size(); ++i) {
+        const size_t size = cellSize(itsColumns[i], pos, counts[i]);
+        if (size == 0 || pos + size > itsBuffer.size()) {
+            return false;
+        }
+        offsets[i] = pos + (itsColumns[i].itsVariable ? 4 : 0);
+        pos += size;
+    }
+
+    row = VOTableRow();
+    for (size_t i = 0; i < itsColumns.size(); ++i) {
+        const bool isNull = itsBinary2 &&
+            (static_cast<unsigned char>(itsBuffer[itsPos + i / 8]) & (0x80 >> (i % 8)));
+        row.addCell(isNull ? "" : decodeCell(itsColumns[i], itsBuffer.data() + offsets[i], counts[i],
+                                             itsBinary2));
+    }
+    itsPos = pos;
+    return true;
+}
+
+bool VOTableBinary::hasPartialRow() const
+{
+    return itsPos < itsBuffer.size();
+}
+
+std::string VOTableBinary::hrefToPath(const std::string& href)
+{
+    if (href.compare(0, 7, "file://") == 0) {
+        return href.substr(7);
+    }
+    if (href.compare(0, 5, "file:") == 0) {
+        return href.substr(5);
+    }
+    ASKAPCHECK(href.find("://") == std::string::npos, "Only local files are supported for external streams, href="
+               << href);
+    return href;
+}
+
+std::string VOTableBinary::base64Encode(const char* data, size_t size)
+{
+    std::string result;
+    result.reserve((size + 2) / 3 * 4);
+    for (size_t i = 0; i < size; i += 3) {
+        const size_t n = size - i < 3 ? size - i : 3;
+        uint32_t triple = 0;
+        for (size_t j = 0; j < 3; ++j) {
+            triple = (triple << 8) | (j < n ? static_cast<unsigned char>(data[i + j]) : 0);
+        }
+        result.push_back(base64Chars[(triple >> 18) & 0x3f]);
+        result.push_back(base64Chars[(triple >> 12) & 0x3f]);
+        result.push_back(n > 1 ? base64Chars[(triple >> 6) & 0x3f] : '=');
+        result.push_back(n > 2 ? base64Chars[triple & 0x3f] : '=');
+    }
+    return result;
+}
+
+void VOTableBinary::base64Decode(const char* text, size_t size, std::string& pending, std::string& out)
+{
+    for (size_t i = 0; i < size; ++i) {
+        const char c = text[i];
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            continue;
+        }
+        ASKAPCHECK(c == '=' || base64Value(c) >= 0, "Invalid character '" << c << "' in base64 stream");
+        pending.push_back(c);
+        if (pending.size() < 4) {
+            continue;
+        }
+        ASKAPCHECK(pending[0] != '=' && pending[1] != '=' && (pending[2] != '=' || pending[3] == '='),
+                   "Invalid padding in base64 stream");
+        uint32_t triple = 0;
+        size_t n = 3;
+        for (size_t j = 0; j < 4; ++j) {
+            if (pending[j] == '=') {
+                n = n < j - 1 ? n : j - 1;
+                triple <<= 6;
+            } else {
+                triple = (triple << 6) | base64Value(pending[j]);
+            }
+        }
+        for (size_t j = 0; j < n; ++j) {
+            out.push_back(static_cast<char>((triple >> (16 - 8 * j)) & 0xff));
+        }
+        pending.clear();
+    }
+}
+
+VOTableBinary::Column VOTableBinary::makeColumn(const VOTableField& field)
+{
+    Column col;
+    col.itsDatatype = field.getDatatype();
+    col.itsComponents = 1;
+    const std::string& type = col.itsDatatype;
+    if (type == "boolean") {
+        col.itsType = BOOLEAN;
+        col.itsSize = 1;
+    } else if (type == "unsignedByte") {
+        col.itsType = UBYTE;
+        col.itsSize = 1;
+    } else if (type == "short") {
+        col.itsType = SHORT;
+        col.itsSize = 2;
+    } else if (type == "int") {
+        col.itsType = INT;
+        col.itsSize = 4;
+    } else if (type == "long") {
+        col.itsType = LONG;
+        col.itsSize = 8;
+    } else if (type == "char") {
+        col.itsType = CHAR;
+        col.itsSize = 1;
+    } else if (type == "unicodeChar") {
+        col.itsType = UNICHAR;
+        col.itsSize = 2;
+    } else if (type == "float" || type == "floatComplex") {
+        col.itsType = FLOAT;
+        col.itsSize = 4;
+        col.itsComponents = type == "float" ? 1 : 2;
+    } else if (type == "double" || type == "doubleComplex") {
+        col.itsType = DOUBLE;
+        col.itsSize = 8;
+        col.itsComponents = type == "double" ? 1 : 2;
+    } else {
+        ASKAPTHROW(AskapError, "Datatype '" << type << "' of field " << field.getName() <<
+                   " is not supported by the binary serialisation");
+    }
+
+    // arraysize is e.g. "", "10", "*", "10*" or "3x2x*", variable arrays are preceded by
+    // the total number of elements
+    col.itsCount = 1;
+    col.itsVariable = false;
+    std::vector<std::string> dims;
+    const std::string arraysize = field.getArraysize();
+    if (!arraysize.empty()) {
+        boost::split(dims, arraysize, boost::is_any_of("x"));
+    }
+    for (size_t i = 0; i < dims.size(); ++i) {
+        if (!dims[i].empty() && dims[i][dims[i].size() - 1] == '*') {
+            ASKAPCHECK(i + 1 == dims.size(), "Only the last dimension can be variable, arraysize='" <<
+                       arraysize << "' of field " << field.getName());
+            col.itsVariable = true;
+        } else {
+            char* end = 0;
+            const long dim = std::strtol(dims[i].c_str(), &end, 10);
+            ASKAPCHECK(dim > 0 && end != 0 && *end == '\0', "Invalid arraysize='" << arraysize <<
+                       "' of field " << field.getName());
+            col.itsCount *= dim;
+        }
+    }
+    return col;
+}
+
+void VOTableBinary::encodeCell(const Column& col, const std::string& cell, bool isNull, std::string& out)
+{
+    if (col.itsType == CHAR || col.itsType == UNICHAR) {
+        std::vector<uint16_t> units;
+        if (col.itsType == UNICHAR) {
+            units = utf8ToUcs2(cell);
+        } else {
+            units.assign(cell.begin(), cell.end());
+        }
+        if (col.itsVariable) {
+            putBE(units.size(), 4, out);
+        } else {
+            units.resize(col.itsCount, 0);
+        }
+        for (std::vector<uint16_t>::const_iterator it = units.begin(); it != units.end(); ++it) {
+            putBE(*it, col.itsSize, out);
+        }
+        return;
+    }
+
+    std::vector<std::string> tokens;
+    std::string trimmed = boost::trim_copy(cell);
+    if (!isNull && !trimmed.empty()) {
+        boost::split(tokens, trimmed, boost::is_any_of(" \t\n"), boost::token_compress_on);
+    }
+    if (col.itsVariable) {
+        ASKAPCHECK(tokens.size() % col.itsComponents == 0, "Cell '" << cell <<
+                   "' doesn't have a whole number of " << col.itsDatatype << " values");
+        putBE(tokens.size() / col.itsComponents, 4, out);
+    } else {
+        ASKAPCHECK(tokens.empty() || tokens.size() == col.itsCount * col.itsComponents, "Cell '" << cell <<
+                   "' should have " << col.itsCount * col.itsComponents << " value(s) of type " << col.itsDatatype);
+        // null value
+        tokens.resize(col.itsCount * col.itsComponents);
+    }
+
+    for (std::vector<std::string>::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+        const std::string& token = *it;
+        char* end = 0;
+        switch (col.itsType) {
+            case BOOLEAN: {
+                const char c = token.empty() ? '?' : token[0];
+                out.push_back(c == 'T' || c == 't' || c == '1' ? 'T' :
+                              (c == 'F' || c == 'f' || c == '0' ? 'F' : '?'));
+                break;
+            }
+            case UBYTE:
+            case SHORT:
+            case INT:
+            case LONG: {
+                long long value = 0;
+                if (!token.empty()) {
+                    value = std::strtoll(token.c_str(), &end, 10);
+                    ASKAPCHECK(*end == '\0', "Cannot convert '" << token << "' to " << col.itsDatatype);
+                }
+                putBE(static_cast<uint64_t>(value), col.itsSize, out);
+                break;
+            }
+            case FLOAT: {
+                float value = std::numeric_limits<float>::quiet_NaN();
+                if (!token.empty()) {
+                    value = std::strtof(token.c_str(), &end);
+                    ASKAPCHECK(*end == '\0', "Cannot convert '" << token << "' to " << col.itsDatatype);
+                }
+                uint32_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                putBE(bits, 4, out);
+                break;
+            }
+            case DOUBLE: {
+                double value = std::numeric_limits<double>::quiet_NaN();
+                if (!token.empty()) {
+                    value = std::strtod(token.c_str(), &end);
+                    ASKAPCHECK(*end == '\0', "Cannot convert '" << token << "' to " << col.itsDatatype);
+                }
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                putBE(bits, 8, out);
+                break;
+            }
+            default:
+                ASKAPTHROW(AskapError, "Unexpected primitive type");
+        }
+    }
+}
+
+std::string VOTableBinary::decodeCell(const Column& col, const char* data, size_t count, bool binary2)
+{
+    std::string result;
+    if (col.itsType == CHAR || col.itsType == UNICHAR) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint16_t cu = static_cast<uint16_t>(getBE(data + i * col.itsSize, col.itsSize));
+            if (cu == 0 && !col.itsVariable) {
+                // fixed size strings are padded with nulls
+                break;
+            }
+            if (col.itsType == CHAR) {
+                result.push_back(static_cast<char>(cu));
+            } else {
+                appendUtf8(cu, result);
+            }
+        }
+        return result;
+    }
+
+    const size_t nValues = count * col.itsComponents;
+    for (size_t i = 0; i < nValues; ++i) {
+        const char* ptr = data + i * col.itsSize;
+        std::string token;
+        switch (col.itsType) {
+            case BOOLEAN:
+                token = (*ptr == 'T' || *ptr == 't' || *ptr == '1') ? "T" :
+                        ((*ptr == 'F' || *ptr == 'f' || *ptr == '0') ? "F" : "?");
+                break;
+            case UBYTE: {
+                std::ostringstream os;
+                os << getBE(ptr, 1);
+                token = os.str();
+                break;
+            }
+            case SHORT: {
+                std::ostringstream os;
+                os << static_cast<int16_t>(getBE(ptr, 2));
+                token = os.str();
+                break;
+            }
+            case INT: {
+                std::ostringstream os;
+                os << static_cast<int32_t>(getBE(ptr, 4));
+                token = os.str();
+                break;
+            }
+            case LONG: {
+                std::ostringstream os;
+                os << static_cast<int64_t>(getBE(ptr, 8));
+                token = os.str();
+                break;
+            }
+            case FLOAT: {
+                const uint32_t bits = static_cast<uint32_t>(getBE(ptr, 4));
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                token = std::isnan(value) ? "NaN" : formatReal(value, 6, 9);
+                break;
+            }
+            case DOUBLE: {
+                const uint64_t bits = getBE(ptr, 8);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                token = std::isnan(value) ? "NaN" : formatReal(value, 15, 17);
+                break;
+            }
+            default:
+                ASKAPTHROW(AskapError, "Unexpected primitive type");
+        }
+        if (nValues == 1 && !binary2 && (token == "NaN" || token == "?")) {
+            // scalar null in BINARY
+            return "";
+        }
+        if (i > 0) {
+            result.push_back(' ');
+        }
+        result += token;
+    }
+    return result;
+}
+
+size_t VOTableBinary::cellSize(const Column& col, size_t pos, size_t& count) const
+{
+    if (!col.itsVariable) {
+        count = col.itsCount;
+        return count * col.itsComponents * col.itsSize;
+    }
+    if (pos + 4 > itsBuffer.size()) {
+        return 0;
+    }
+    count = static_cast<size_t>(getBE(itsBuffer.data() + pos, 4));
+    return 4 + count * col.itsComponents * col.itsSize;
+}
@@ -0,0 +1,156 @@
+/// @file VOTableBinary.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEBINARY_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEBINARY_H
+
+// System includes
+#include <string>
+#include <vector>
+
+// Local package includes
+#include "askap/votable/VOTableField.h"
+#include "askap/votable/VOTableRow.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Encoding and decoding of rows in the BINARY and BINARY2 serialisations
+        /// @details The binary serialisations store each row as the concatenation of the
+        /// big endian representation of its cells, with the layout given by the datatype
+        /// and arraysize attributes of the fields. BINARY2 additionally precedes each row
+        /// by a bit mask of null cells. The rows are kept as strings in VOTableRow, the
+        /// same way as for TABLEDATA: numeric arrays and complex values are written as
+        /// space-separated numbers and an empty cell means null.
+        ///
+        /// All datatypes except bit are supported. Null values in BINARY are represented
+        /// by NaN for floating point types, '?' for boolean and zero otherwise (nulls for
+        /// the integer types require VALUES null="...", which is not supported).
+        ///
+        /// Rows are decoded incrementally: raw bytes are appended as they become
+        /// available (see base64Decode) and complete rows are extracted with nextRow.
+        ///
+        /// @ingroup votableaccess
+        class VOTableBinary {
+            public:
+
+                /// @brief Constructor
+                /// @param[in] fields fields of the table, in order
+                /// @param[in] binary2 true for BINARY2, false for BINARY
+                /// @throw AskapError   if a datatype or arraysize is not supported
+                VOTableBinary(const std::vector<VOTableField>& fields, bool binary2);
+
+                /// Encode a row
+                /// @param[in] row the row, it should have a cell for each field
+                /// @param[in,out] out raw bytes are appended to this buffer
+                void encodeRow(const VOTableRow& row, std::string& out) const;
+
+                /// Add raw bytes of the stream to be decoded
+                void appendData(const char* data, size_t size);
+
+                /// Extract the next complete row
+                /// @param[out] row decoded row
+                /// @return true if a row was extracted, false if more data is needed
+                bool nextRow(VOTableRow& row);
+
+                /// @return true if there are bytes not forming a complete row
+                bool hasPartialRow() const;
+
+                /// Convert the href attribute of an external STREAM to a file name
+                /// @details Only local files are supported (plain path or file: URL)
+                /// @throw AskapError   for other URL schemes
+                static std::string hrefToPath(const std::string& href);
+
+                /// Base64 encoding
+                /// @param[in] data raw bytes
+                /// @param[in] size number of bytes
+                /// @return encoded string (with padding, no line breaks)
+                static std::string base64Encode(const char* data, size_t size);
+
+                /// Incremental base64 decoding
+                /// @details White space is ignored, the characters not forming a complete
+                /// quartet are kept in pending until the next call.
+                /// @param[in] text encoded characters
+                /// @param[in] size number of characters
+                /// @param[in,out] pending characters left over from the previous call
+                /// @param[in,out] out decoded bytes are appended to this buffer
+                /// @throw AskapError   if the text is not valid base64
+                static void base64Decode(const char* text, size_t size, std::string& pending,
+                                         std::string& out);
+
+            private:
+
+                /// primitive types
+                enum Primitive { BOOLEAN, UBYTE, SHORT, INT, LONG, CHAR, UNICHAR, FLOAT, DOUBLE };
+
+                /// layout of a single field
+                struct Column {
+                    /// primitive type
+                    Primitive itsType;
+                    /// size of the primitive in bytes
+                    size_t itsSize;
+                    /// number of primitives per element (2 for complex types)
+                    size_t itsComponents;
+                    /// number of elements (for fixed size columns)
+                    size_t itsCount;
+                    /// true if the number of elements is given in the stream
+                    bool itsVariable;
+                    /// datatype attribute, for error messages
+                    std::string itsDatatype;
+                };
+
+                /// Parse the datatype and arraysize of a field
+                static Column makeColumn(const VOTableField& field);
+
+                /// Encode a single cell
+                static void encodeCell(const Column& col, const std::string& cell, bool isNull,
+                                       std::string& out);
+
+                /// Decode a single cell, data points to the start of the cell
+                static std::string decodeCell(const Column& col, const char* data, size_t count,
+                                              bool binary2);
+
+                /// @return number of bytes of the cell starting at the given position,
+                ///         0 if there is not enough data to tell (variable size columns)
+                size_t cellSize(const Column& col, size_t pos, size_t& count) const;
+
+                /// Layout of the fields
+                std::vector<Column> itsColumns;
+
+                /// True for BINARY2
+                bool itsBinary2;
+
+                /// Raw bytes not decoded yet
+                std::string itsBuffer;
+
+                /// Position of the first byte not decoded yet
+                size_t itsPos;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,394 @@
+/// @file VOTableColumn.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// Include own header file first
+#include "VOTableColumn.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <utility>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapError.h>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief format a real value, codes below 128 give the number of decimals in the fixed
+/// point notation, 128 + n gives n significant digits in the %g notation
+std::string formatReal(double value, unsigned char code)
+{
+    char buf[512];
+    if (code < 128) {
+        std::snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(code), value);
+    } else {
+        std::snprintf(buf, sizeof(buf), "%.*g", static_cast<int>(code - 128), value);
+    }
+    return buf;
+}
+
+/// @brief format an integer value
+std::string formatInteger(long long value)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%lld", value);
+    return buf;
+}
+
+}
+
+const unsigned char VOTableColumn::theirTextOnly;
+
+VOTableColumn::VOTableColumn(Type type) : itsType(type), itsSize(0)
+{
+}
+
+VOTableColumn::Type VOTableColumn::typeOf(const VOTableField& field)
+{
+    const std::string arraysize = field.getArraysize();
+    if (!arraysize.empty() && arraysize != "1") {
+        return STRING;
+    }
+    const std::string type = field.getDatatype();
+    if (type == "double" || type == "float") {
+        return REAL;
+    }
+    if (type == "long" || type == "int" || type == "short" || type == "unsignedByte") {
+        return INTEGER;
+    }
+    if (type == "boolean") {
+        return BOOLEAN;
+    }
+    return STRING;
+}
+
+VOTableColumn::Type VOTableColumn::getType() const
+{
+    return itsType;
+}
+
+size_t VOTableColumn::size() const
+{
+    return itsSize;
+}
+
+void VOTableColumn::addCell(const std::string& cell)
+{
+    switch (itsType) {
+        case STRING:
+            itsStrings.push_back(cell);
+            break;
+        case REAL:
+            addReal(cell);
+            break;
+        case INTEGER: {
+            char* end = 0;
+            const long long value = std::strtoll(cell.c_str(), &end, 10);
+            itsIntegers.push_back(value);
+            if (cell.empty() || *end != '\0' || formatInteger(value) != cell) {
+                itsText[itsSize] = cell;
+            }
+            break;
+        }
+        case BOOLEAN: {
+            const char c = cell.empty() ? 'F' : cell[0];
+            itsBooleans.push_back(c == 'T' || c == 't' || c == '1' ? 'T' : 'F');
+            if (cell != "T" && cell != "F") {
+                itsText[itsSize] = cell;
+            }
+            break;
+        }
+    }
+    ++itsSize;
+}
+
+void VOTableColumn::addCell(std::string&& cell)
+{
+    if (itsType == STRING) {
+        itsStrings.push_back(std::move(cell));
+        ++itsSize;
+    } else {
+        addCell(static_cast<const std::string&>(cell));
+    }
+}
+
+void VOTableColumn::appendReal(double value, bool singlePrecision)
+{
+    checkType(REAL);
+    unsigned char code = theirTextOnly;
+    if (std::isfinite(value)) {
+        // 7 (15) significant digits are nearly always enough, 9 (17) always are
+        const int maxDigits = singlePrecision ? 9 : 17;
+        for (int digits = maxDigits - 2; digits <= maxDigits; ++digits) {
+            const double readBack = std::strtod(formatReal(value, 128 + digits).c_str(), 0);
+            if (singlePrecision ? static_cast<float>(readBack) == static_cast<float>(value) :
+                readBack == value) {
+                code = static_cast<unsigned char>(128 + digits);
+                break;
+            }
+        }
+    }
+    if (code == theirTextOnly) {
+        itsText[itsSize] = std::isnan(value) ? "NaN" : (value > 0 ? "+Inf" : "-Inf");
+    }
+    itsReals.push_back(value);
+    itsFormats.push_back(code);
+    ++itsSize;
+}
+
+void VOTableColumn::appendInteger(long long value)
+{
+    checkType(INTEGER);
+    itsIntegers.push_back(value);
+    ++itsSize;
+}
+
+void VOTableColumn::appendBoolean(bool value)
+{
+    checkType(BOOLEAN);
+    itsBooleans.push_back(value ? 'T' : 'F');
+    ++itsSize;
+}
+
+void VOTableColumn::appendNull()
+{
+    switch (itsType) {
+        case STRING:
+            itsStrings.push_back(std::string());
+            break;
+        case REAL:
+            itsReals.push_back(std::numeric_limits<double>::quiet_NaN());
+            itsFormats.push_back(theirTextOnly);
+            itsText[itsSize] = std::string();
+            break;
+        case INTEGER:
+            itsIntegers.push_back(0);
+            itsText[itsSize] = std::string();
+            break;
+        case BOOLEAN:
+            itsBooleans.push_back('F');
+            itsText[itsSize] = std::string();
+            break;
+    }
+    ++itsSize;
+}
+
+std::string VOTableColumn::getCell(size_t row) const
+{
+    ASKAPDEBUGASSERT(row < itsSize);
+    if (itsType == STRING) {
+        return itsStrings[row];
+    }
+    const std::map<size_t, std::string>::const_iterator ci = itsText.find(row);
+    if (ci != itsText.end()) {
+        return ci->second;
+    }
+    switch (itsType) {
+        case REAL:
+            return formatReal(itsReals[row], itsFormats[row]);
+        case INTEGER:
+            return formatInteger(itsIntegers[row]);
+        default:
+            return std::string(1, itsBooleans[row]);
+    }
+}
+
+bool VOTableColumn::isNull(size_t row) const
+{
+    ASKAPDEBUGASSERT(row < itsSize);
+    if (itsType == STRING) {
+        return itsStrings[row].empty();
+    }
+    const std::map<size_t, std::string>::const_iterator ci = itsText.find(row);
+    return ci != itsText.end() && ci->second.empty();
+}
+
+double VOTableColumn::getDouble(size_t row) const
+{
+    ASKAPDEBUGASSERT(row < itsSize);
+    if (itsType == REAL) {
+        return itsReals[row];
+    }
+    ASKAPCHECK(itsType == INTEGER, "Column doesn't hold numeric values");
+    return isNull(row) ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(itsIntegers[row]);
+}
+
+const std::vector<double>& VOTableColumn::getReals() const
+{
+    checkType(REAL);
+    return itsReals;
+}
+
+const std::vector<long long>& VOTableColumn::getIntegers() const
+{
+    checkType(INTEGER);
+    return itsIntegers;
+}
+
+const std::vector<char>& VOTableColumn::getBooleans() const
+{
+    checkType(BOOLEAN);
+    return itsBooleans;
+}
+
+const std::vector<std::string>& VOTableColumn::getStrings() const
+{
+    checkType(STRING);
+    return itsStrings;
+}
+
+void VOTableColumn::selectRange(double min, double max, std::vector<char>& mask) const
+{
+    ASKAPCHECK(itsType == REAL || itsType == INTEGER, "Range selection requires a numeric column");
+    prepareMask(mask);
+    // simple loops without branches, so the compiler can vectorise them
+    if (itsType == REAL) {
+        for (size_t row = 0; row < itsSize; ++row) {
+            const double val = itsReals[row];
+            mask[row] &= static_cast<char>((val >= min) & (val <= max));
+        }
+    } else {
+        for (size_t row = 0; row < itsSize; ++row) {
+            const double val = static_cast<double>(itsIntegers[row]);
+            mask[row] &= static_cast<char>((val >= min) & (val <= max));
+        }
+        deselectNulls(mask);
+    }
+}
+
+void VOTableColumn::selectEqual(const std::string& value, std::vector<char>& mask) const
+{
+    prepareMask(mask);
+    if (value.empty()) {
+        // nulls are never selected
+        mask.assign(itsSize, 0);
+    } else if (itsType == STRING) {
+        for (size_t row = 0; row < itsSize; ++row) {
+            mask[row] &= static_cast<char>(itsStrings[row] == value);
+        }
+    } else {
+        for (size_t row = 0; row < itsSize; ++row) {
+            if (mask[row]) {
+                mask[row] = static_cast<char>(getCell(row) == value);
+            }
+        }
+    }
+}
+
+std::vector<size_t> VOTableColumn::selectedRows(const std::vector<char>& mask)
+{
+    std::vector<size_t> rows;
+    for (size_t row = 0; row < mask.size(); ++row) {
+        if (mask[row]) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+void VOTableColumn::prepareMask(std::vector<char>& mask) const
+{
+    if (mask.empty()) {
+        mask.assign(itsSize, 1);
+    }
+    ASKAPCHECK(mask.size() == itsSize, "Selection mask has " << mask.size() <<
+               " elements, the column has " << itsSize << " cells");
+}
+
+void VOTableColumn::deselectNulls(std::vector<char>& mask) const
+{
+    for (std::map<size_t, std::string>::const_iterator ci = itsText.begin(); ci != itsText.end(); ++ci) {
+        if (ci->second.empty()) {
+            mask[ci->first] = 0;
+        }
+    }
+}
+
+void VOTableColumn::checkType(Type type) const
+{
+    ASKAPCHECK(itsType == type, "Column has type " << itsType << ", " << type << " is requested");
+}
+
+void VOTableColumn::addReal(const std::string& cell)
+{
+    char* end = 0;
+    const double value = std::strtod(cell.c_str(), &end);
+    if (cell.empty() || *end != '\0') {
+        itsReals.push_back(std::numeric_limits<double>::quiet_NaN());
+        itsFormats.push_back(theirTextOnly);
+        itsText[itsSize] = cell;
+        return;
+    }
+
+    // find the notation of the text: decimals of the fixed point notation and
+    // the number of significant digits
+    size_t decimals = 0;
+    size_t digits = 0;
+    bool hasDot = false;
+    bool hasExponent = false;
+    bool leading = true;
+    for (std::string::const_iterator it = cell.begin(); it != cell.end(); ++it) {
+        if (*it == '.') {
+            hasDot = true;
+        } else if (*it == 'e' || *it == 'E') {
+            hasExponent = true;
+            break;
+        } else if (*it >= '0' && *it <= '9') {
+            if (hasDot) {
+                ++decimals;
+            }
+            if (*it != '0' || !leading) {
+                leading = false;
+                ++digits;
+            }
+        }
+    }
+
+    unsigned char code = theirTextOnly;
+    if (hasDot && !hasExponent && decimals < 128 && formatReal(value, decimals) == cell) {
+        code = static_cast<unsigned char>(decimals);
+    } else {
+        const size_t precision = digits > 0 ? digits : 1;
+        if (precision <= 17 && formatReal(value, 128 + precision) == cell) {
+            code = static_cast<unsigned char>(128 + precision);
+        } else {
+            itsText[itsSize] = cell;
+        }
+    }
+    itsReals.push_back(value);
+    itsFormats.push_back(code);
+}
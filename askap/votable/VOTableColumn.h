@@ -0,0 +1,189 @@
+/// @file VOTableColumn.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLECOLUMN_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLECOLUMN_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <map>
+
+// Local package includes
+#include "askap/votable/VOTableField.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Typed storage of a single column of a VOTableTable
+        /// @details Scalar numeric and boolean fields are stored as contiguous arrays of
+        /// double, long long or char ('T'/'F') values instead of one string per cell.
+        /// Other fields (strings, arrays, complex values) are stored as strings.
+        ///
+        /// The text of every cell is preserved: for real values the number of decimals
+        /// is kept if the text is in the fixed point notation (e.g. "1.50"), and the
+        /// few cells whose text can't be reproduced from the value (including nulls,
+        /// i.e. empty cells) are kept as strings in a sparse map. Such cells have NaN
+        /// (real), zero (integer) or 'F' (boolean) in the typed array.
+        ///
+        /// @ingroup votableaccess
+        class VOTableColumn {
+            public:
+
+                /// @brief type of the storage
+                enum Type { STRING, REAL, INTEGER, BOOLEAN };
+
+                /// @brief Constructor
+                /// @param[in] type type of the storage
+                explicit VOTableColumn(Type type = STRING);
+
+                /// @brief type of the storage suitable for the given field
+                static Type typeOf(const VOTableField& field);
+
+                /// @return type of the storage
+                Type getType() const;
+
+                /// @return number of cells
+                size_t size() const;
+
+                /// Add a cell to the end of the column
+                /// @param[in] cell text of the cell, empty for null
+                void addCell(const std::string& cell);
+
+                /// Add a cell to the end of the column, the text is moved into the string column
+                void addCell(std::string&& cell);
+
+                /// Add a value to the end of the REAL column without going through the text
+                /// @details The text of the cell is the shortest %g representation which gives
+                /// the same value when read back. Infinities and NaN are written as "+Inf",
+                /// "-Inf" and "NaN", as in the VOTable standard.
+                /// @param[in] value value of the cell
+                /// @param[in] singlePrecision true, if the value only needs to round trip as float
+                /// @throw AskapError   for other columns
+                void appendReal(double value, bool singlePrecision = false);
+
+                /// Add a value to the end of the INTEGER column
+                /// @throw AskapError   for other columns
+                void appendInteger(long long value);
+
+                /// Add a value to the end of the BOOLEAN column
+                /// @throw AskapError   for other columns
+                void appendBoolean(bool value);
+
+                /// Add a null (empty) cell to the end of the column
+                void appendNull();
+
+                /// @return text of the given cell, as it was added
+                std::string getCell(size_t row) const;
+
+                /// @return true if the given cell is null (empty)
+                bool isNull(size_t row) const;
+
+                /// @return value of the given cell of the REAL or INTEGER column
+                /// @throw AskapError   for other columns
+                double getDouble(size_t row) const;
+
+                /// Typed values of the REAL column
+                /// @throw AskapError   for other columns
+                const std::vector<double>& getReals() const;
+
+                /// Typed values of the INTEGER column
+                /// @throw AskapError   for other columns
+                const std::vector<long long>& getIntegers() const;
+
+                /// Typed values of the BOOLEAN column ('T' or 'F')
+                /// @throw AskapError   for other columns
+                const std::vector<char>& getBooleans() const;
+
+                /// Values of the STRING column
+                /// @throw AskapError   for other columns
+                const std::vector<std::string>& getStrings() const;
+
+                /// Select the rows with values within the given range (inclusive)
+                /// @details The mask has one element per row, non-zero for the selected
+                /// rows. An empty mask is initialised with all rows selected, otherwise
+                /// the rows with values outside the range are deselected, so the calls
+                /// can be chained to combine predicates. Null cells are never selected.
+                /// @param[in] min lower bound
+                /// @param[in] max upper bound
+                /// @param[in,out] mask selection mask
+                /// @throw AskapError   for columns other than REAL and INTEGER
+                void selectRange(double min, double max, std::vector<char>& mask) const;
+
+                /// Select the rows with the given text of the cell (see selectRange)
+                /// @param[in] value text to match
+                /// @param[in,out] mask selection mask
+                void selectEqual(const std::string& value, std::vector<char>& mask) const;
+
+                /// @return indices of the rows selected by the mask
+                static std::vector<size_t> selectedRows(const std::vector<char>& mask);
+
+            private:
+
+                /// Initialise an empty mask or check the size of the given one
+                void prepareMask(std::vector<char>& mask) const;
+
+                /// Deselect the null cells of the typed column
+                void deselectNulls(std::vector<char>& mask) const;
+
+                /// Check that the column has the given type
+                void checkType(Type type) const;
+
+                /// Add a real value, the format code is chosen to reproduce the text
+                void addReal(const std::string& cell);
+
+                /// format code of the cells kept as text only
+                static const unsigned char theirTextOnly = 255;
+
+                /// type of the storage
+                Type itsType;
+
+                /// number of cells
+                size_t itsSize;
+
+                /// values of the REAL column
+                std::vector<double> itsReals;
+
+                /// format codes of the cells of the REAL column (see formatReal in the .cc file)
+                std::vector<unsigned char> itsFormats;
+
+                /// values of the INTEGER column
+                std::vector<long long> itsIntegers;
+
+                /// values of the BOOLEAN column
+                std::vector<char> itsBooleans;
+
+                /// values of the STRING column
+                std::vector<std::string> itsStrings;
+
+                /// text of the cells which can't be reproduced from the typed value
+                std::map<size_t, std::string> itsText;
+        };
+
+    }
+}
+
+#endif
@@ -42,6 +42,7 @@
 // Local package includes
 #include "askap/votable/XercescString.h"
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableTags.h"
 
 ASKAP_LOGGER(logger, ".VOTableField");
 
@@ -145,37 +146,37 @@ std::string VOTableField::getRef() const
 
 xercesc::DOMElement* VOTableField::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("FIELD"));
+    DOMElement* e = doc.createElement(VOTableTags::FIELD);
 
     // Add attributes
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableTags::ATTR_NAME, XercescString(itsName));
     }
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableTags::ATTR_ID, XercescString(itsID));
     }
     if (itsDatatype.length() > 0) {
-        e->setAttribute(XercescString("datatype"), XercescString(itsDatatype));
+        e->setAttribute(VOTableTags::ATTR_DATATYPE, XercescString(itsDatatype));
     }
     if (itsArraysize.length() > 0) {
-        e->setAttribute(XercescString("arraysize"), XercescString(itsArraysize));
+        e->setAttribute(VOTableTags::ATTR_ARRAYSIZE, XercescString(itsArraysize));
     }
     if (itsUnit.length() > 0) {
-        e->setAttribute(XercescString("unit"), XercescString(itsUnit));
+        e->setAttribute(VOTableTags::ATTR_UNIT, XercescString(itsUnit));
     }
     if (itsUCD.length() > 0) {
-        e->setAttribute(XercescString("ucd"), XercescString(itsUCD));
+        e->setAttribute(VOTableTags::ATTR_UCD, XercescString(itsUCD));
     }
     if (itsUType.length() > 0) {
-        e->setAttribute(XercescString("utype"), XercescString(itsUType));
+        e->setAttribute(VOTableTags::ATTR_UTYPE, XercescString(itsUType));
     }
     if (itsRef.length() > 0) {
-        e->setAttribute(XercescString("ref"), XercescString(itsRef));
+        e->setAttribute(VOTableTags::ATTR_REF, XercescString(itsRef));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableTags::DESCRIPTION);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -188,14 +189,14 @@ VOTableField VOTableField::fromXmlElement(const xercesc::DOMElement& e)
     VOTableField f;
 
     // Get attributes
-    f.setName(XercescUtils::getAttribute(e, "name"));
-    f.setID(XercescUtils::getAttribute(e, "ID"));
-    f.setDatatype(XercescUtils::getAttribute(e, "datatype"));
-    f.setArraysize(XercescUtils::getAttribute(e, "arraysize"));
-    f.setUnit(XercescUtils::getAttribute(e, "unit"));
-    f.setUCD(XercescUtils::getAttribute(e, "ucd"));
-    f.setUType(XercescUtils::getAttribute(e, "utype"));
-    f.setRef(XercescUtils::getAttribute(e, "ref"));
+    f.setName(XercescUtils::getAttribute(e, VOTableTags::ATTR_NAME));
+    f.setID(XercescUtils::getAttribute(e, VOTableTags::ATTR_ID));
+    f.setDatatype(XercescUtils::getAttribute(e, VOTableTags::ATTR_DATATYPE));
+    f.setArraysize(XercescUtils::getAttribute(e, VOTableTags::ATTR_ARRAYSIZE));
+    f.setUnit(XercescUtils::getAttribute(e, VOTableTags::ATTR_UNIT));
+    f.setUCD(XercescUtils::getAttribute(e, VOTableTags::ATTR_UCD));
+    f.setUType(XercescUtils::getAttribute(e, VOTableTags::ATTR_UTYPE));
+    f.setRef(XercescUtils::getAttribute(e, VOTableTags::ATTR_REF));
 
     // Get description
     f.setDescription(XercescUtils::getDescription(e));
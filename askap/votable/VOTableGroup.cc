@@ -43,6 +43,7 @@
 #include "askap/votable/XercescString.h"
 #include "askap/votable/XercescUtils.h"
 #include "askap/votable/VOTableParam.h"
+#include "askap/votable/VOTableTags.h"
 
 ASKAP_LOGGER(logger, ".VOTableGroup");
 
@@ -119,7 +120,7 @@ void VOTableGroup::addParam(const VOTableParam& param)
     itsParams.push_back(param);
 }
 
-std::vector<VOTableParam> VOTableGroup::getParams() const
+const std::vector<VOTableParam>& VOTableGroup::getParams() const
 {
     return itsParams;
 }
@@ -129,7 +130,7 @@ void VOTableGroup::addFieldRef(const std::string& fieldRef)
     itsFieldRefs.push_back(fieldRef);
 }
 
-std::vector<std::string> VOTableGroup::getFieldRefs() const
+const std::vector<std::string>& VOTableGroup::getFieldRefs() const
 {
     return itsFieldRefs;
 }
@@ -139,35 +140,35 @@ void VOTableGroup::addParamRef(const std::string& paramRef)
     itsParamRefs.push_back(paramRef);
 }
 
-std::vector<std::string> VOTableGroup::getParamRefs() const
+const std::vector<std::string>& VOTableGroup::getParamRefs() const
 {
     return itsParamRefs;
 }
 
 xercesc::DOMElement* VOTableGroup::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("GROUP"));
+    DOMElement* e = doc.createElement(VOTableTags::GROUP);
 
     // Add attributes
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableTags::ATTR_NAME, XercescString(itsName));
     }
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableTags::ATTR_ID, XercescString(itsID));
     }
     if (itsUCD.length() > 0) {
-        e->setAttribute(XercescString("ucd"), XercescString(itsUCD));
+        e->setAttribute(VOTableTags::ATTR_UCD, XercescString(itsUCD));
     }
     if (itsUType.length() > 0) {
-        e->setAttribute(XercescString("utype"), XercescString(itsUType));
+        e->setAttribute(VOTableTags::ATTR_UTYPE, XercescString(itsUType));
     }
     if (itsRef.length() > 0) {
-        e->setAttribute(XercescString("ref"), XercescString(itsRef));
+        e->setAttribute(VOTableTags::ATTR_REF, XercescString(itsRef));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableTags::DESCRIPTION);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -182,16 +183,16 @@ xercesc::DOMElement* VOTableGroup::toXmlElement(xercesc::DOMDocument& doc) const
     // Create FIELDref elements
     for (std::vector<std::string>::const_iterator it = itsFieldRefs.begin();
             it != itsFieldRefs.end(); ++it) {
-        DOMElement* fr = doc.createElement(XercescString("FIELDref"));
-        fr->setAttribute(XercescString("ref"), XercescString(*it));
+        DOMElement* fr = doc.createElement(VOTableTags::FIELDref);
+        fr->setAttribute(VOTableTags::ATTR_REF, XercescString(*it));
         e->appendChild(fr);
     }
 
     // Create PARAMref elements
     for (std::vector<std::string>::const_iterator it = itsParamRefs.begin();
             it != itsParamRefs.end(); ++it) {
-        DOMElement* fr = doc.createElement(XercescString("PARAMref"));
-        fr->setAttribute(XercescString("ref"), XercescString(*it));
+        DOMElement* fr = doc.createElement(VOTableTags::PARAMref);
+        fr->setAttribute(VOTableTags::ATTR_REF, XercescString(*it));
         e->appendChild(fr);
     }
     return e;
@@ -202,17 +203,17 @@ VOTableGroup VOTableGroup::fromXmlElement(const xercesc::DOMElement& e)
     VOTableGroup g;
 
     // Get attributes
-    g.setName(XercescUtils::getAttribute(e, "name"));
-    g.setID(XercescUtils::getAttribute(e, "ID"));
-    g.setUCD(XercescUtils::getAttribute(e, "ucd"));
-    g.setUType(XercescUtils::getAttribute(e, "utype"));
-    g.setRef(XercescUtils::getAttribute(e, "ref"));
+    g.setName(XercescUtils::getAttribute(e, VOTableTags::ATTR_NAME));
+    g.setID(XercescUtils::getAttribute(e, VOTableTags::ATTR_ID));
+    g.setUCD(XercescUtils::getAttribute(e, VOTableTags::ATTR_UCD));
+    g.setUType(XercescUtils::getAttribute(e, VOTableTags::ATTR_UTYPE));
+    g.setRef(XercescUtils::getAttribute(e, VOTableTags::ATTR_REF));
 
     // Get description
     g.setDescription(XercescUtils::getDescription(e));
 
     // Process PARAM
-    DOMNodeList* children = e.getElementsByTagName(XercescString("PARAM"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableTags::PARAM);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableParam param = VOTableParam::fromXmlElement(*node);
@@ -220,17 +221,17 @@ VOTableGroup VOTableGroup::fromXmlElement(const xercesc::DOMElement& e)
     }
 
     // Process FIELDref elements
-    children = e.getElementsByTagName(XercescString("FIELDref"));
+    children = e.getElementsByTagName(VOTableTags::FIELDref);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
-        g.addFieldRef(XercescUtils::getAttribute(*node, "ref"));
+        g.addFieldRef(XercescUtils::getAttribute(*node, VOTableTags::ATTR_REF));
     }
 
     // Process PARAMref elements
-    children = e.getElementsByTagName(XercescString("PARAMref"));
+    children = e.getElementsByTagName(VOTableTags::PARAMref);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
-        g.addParamRef(XercescUtils::getAttribute(*node, "ref"));
+        g.addParamRef(XercescUtils::getAttribute(*node, VOTableTags::ATTR_REF));
     }
 
     return g;
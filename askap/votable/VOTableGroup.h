@@ -75,15 +75,15 @@ namespace askap {
 
                 void addParam(const VOTableParam& param);
 
-                std::vector<VOTableParam> getParams() const;
+                const std::vector<VOTableParam>& getParams() const;
 
                 void addFieldRef(const std::string& fieldRef);
 
-                std::vector<std::string> getFieldRefs() const;
+                const std::vector<std::string>& getFieldRefs() const;
 
                 void addParamRef(const std::string& paramRef);
 
-                std::vector<std::string> getParamRefs() const;
+                const std::vector<std::string>& getParamRefs() const;
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
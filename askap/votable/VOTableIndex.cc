@@ -0,0 +1,216 @@
+/// @file VOTableIndex.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// Include own header file first
+#include "VOTableIndex.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <limits>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapError.h>
+
+using namespace askap::accessors;
+
+namespace {
+
+const double theirDegToRad = M_PI / 180.;
+
+/// @return angular distance between the given positions (degrees)
+double distance(double ra1, double dec1, double ra2, double dec2)
+{
+    // haversine formula, accurate for small distances
+    const double sinDDec = std::sin((dec2 - dec1) * theirDegToRad / 2.);
+    const double sinDRA = std::sin((ra2 - ra1) * theirDegToRad / 2.);
+    const double h = sinDDec * sinDDec +
+        std::cos(dec1 * theirDegToRad) * std::cos(dec2 * theirDegToRad) * sinDRA * sinDRA;
+    return 2. * std::asin(std::min(1., std::sqrt(h))) / theirDegToRad;
+}
+
+}
+
+VOTableSortedIndex::VOTableSortedIndex(const VOTableColumn& column)
+{
+    ASKAPCHECK(column.getType() == VOTableColumn::REAL || column.getType() == VOTableColumn::INTEGER,
+               "Sorted index requires a numeric column");
+    std::vector<std::pair<double, size_t> > entries;
+    entries.reserve(column.size());
+    for (size_t row = 0; row < column.size(); ++row) {
+        const double val = column.getDouble(row);
+        if (!std::isnan(val)) {
+            entries.push_back(std::make_pair(val, row));
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+    itsValues.reserve(entries.size());
+    itsRows.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        itsValues.push_back(entries[i].first);
+        itsRows.push_back(entries[i].second);
+    }
+}
+
+std::vector<size_t> VOTableSortedIndex::findRange(double min, double max) const
+{
+    const std::vector<double>::const_iterator first = std::lower_bound(itsValues.begin(), itsValues.end(), min);
+    const std::vector<double>::const_iterator last = std::upper_bound(first, itsValues.end(), max);
+    std::vector<size_t> rows(itsRows.begin() + (first - itsValues.begin()),
+                             itsRows.begin() + (last - itsValues.begin()));
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+std::vector<size_t> VOTableSortedIndex::find(double value) const
+{
+    return findRange(value, value);
+}
+
+size_t VOTableSortedIndex::size() const
+{
+    return itsValues.size();
+}
+
+VOTableHashIndex::VOTableHashIndex(const VOTableColumn& column)
+{
+    itsRows.reserve(column.size());
+    for (size_t row = 0; row < column.size(); ++row) {
+        if (!column.isNull(row)) {
+            itsRows[column.getCell(row)].push_back(row);
+        }
+    }
+}
+
+std::vector<size_t> VOTableHashIndex::find(const std::string& key) const
+{
+    const std::unordered_map<std::string, std::vector<size_t> >::const_iterator ci = itsRows.find(key);
+    return ci != itsRows.end() ? ci->second : std::vector<size_t>();
+}
+
+bool VOTableHashIndex::contains(const std::string& key) const
+{
+    return itsRows.find(key) != itsRows.end();
+}
+
+size_t VOTableHashIndex::size() const
+{
+    return itsRows.size();
+}
+
+VOTableSkyIndex::VOTableSkyIndex(const VOTableColumn& ra, const VOTableColumn& dec, double cellSize) :
+    itsCellSize(cellSize), itsSize(0)
+{
+    ASKAPCHECK(cellSize > 0 && cellSize <= 180., "Bucket size of " << cellSize << " deg is not supported");
+    ASKAPCHECK(ra.size() == dec.size(), "Right ascension and declination columns have different sizes");
+    itsBuckets.resize(static_cast<size_t>(std::ceil(180. / cellSize)));
+    for (size_t band = 0; band < itsBuckets.size(); ++band) {
+        itsBuckets[band].resize(nBuckets(band));
+    }
+    itsRA.resize(ra.size());
+    itsDec.resize(dec.size());
+    for (size_t row = 0; row < ra.size(); ++row) {
+        double raVal = ra.getDouble(row);
+        const double decVal = dec.getDouble(row);
+        if (std::isnan(raVal) || std::isnan(decVal) || std::abs(decVal) > 90.) {
+            itsRA[row] = std::numeric_limits<double>::quiet_NaN();
+            continue;
+        }
+        raVal = std::fmod(raVal, 360.);
+        if (raVal < 0) {
+            raVal += 360.;
+        }
+        itsRA[row] = raVal;
+        itsDec[row] = decVal;
+        const size_t band = std::min(static_cast<size_t>((decVal + 90.) / cellSize), itsBuckets.size() - 1);
+        std::vector<std::vector<size_t> >& buckets = itsBuckets[band];
+        const size_t bucket = std::min(static_cast<size_t>(raVal / 360. * buckets.size()), buckets.size() - 1);
+        buckets[bucket].push_back(row);
+        ++itsSize;
+    }
+}
+
+size_t VOTableSkyIndex::nBuckets(size_t band) const
+{
+    // the largest circumference of the band determines the number of buckets
+    const double decLow = -90. + band * itsCellSize;
+    const double decHigh = std::min(decLow + itsCellSize, 90.);
+    const double minAbsDec = decLow <= 0 && decHigh >= 0 ? 0. : std::min(std::abs(decLow), std::abs(decHigh));
+    const double circumference = 360. * std::cos(minAbsDec * theirDegToRad);
+    return std::max(static_cast<size_t>(1), static_cast<size_t>(circumference / itsCellSize));
+}
+
+std::vector<size_t> VOTableSkyIndex::findCone(double ra, double dec, double radius) const
+{
+    std::vector<size_t> rows;
+    if (itsSize == 0 || radius < 0) {
+        return rows;
+    }
+    const double decMin = std::max(dec - radius, -90.);
+    const double decMax = std::min(dec + radius, 90.);
+    const size_t firstBand = std::min(static_cast<size_t>((decMin + 90.) / itsCellSize), itsBuckets.size() - 1);
+    const size_t lastBand = std::min(static_cast<size_t>((decMax + 90.) / itsCellSize), itsBuckets.size() - 1);
+
+    // half-width of the cone in right ascension, the whole circle if it covers a pole
+    double halfWidth = 180.;
+    if (std::abs(dec) + radius < 90.) {
+        halfWidth = std::asin(std::min(1., std::sin(radius * theirDegToRad) /
+                                       std::cos(dec * theirDegToRad))) / theirDegToRad;
+    }
+
+    for (size_t band = firstBand; band <= lastBand; ++band) {
+        const std::vector<std::vector<size_t> >& buckets = itsBuckets[band];
+        const double width = 360. / buckets.size();
+        long first = 0;
+        long last = static_cast<long>(buckets.size()) - 1;
+        if (2. * halfWidth + 2. * width < 360.) {
+            first = static_cast<long>(std::floor((ra - halfWidth) / width));
+            last = static_cast<long>(std::floor((ra + halfWidth) / width));
+        }
+        const long nBuckets = static_cast<long>(buckets.size());
+        for (long b = first; b <= last; ++b) {
+            const std::vector<size_t>& bucket = buckets[((b % nBuckets) + nBuckets) % nBuckets];
+            for (std::vector<size_t>::const_iterator it = bucket.begin(); it != bucket.end(); ++it) {
+                if (distance(ra, dec, itsRA[*it], itsDec[*it]) <= radius) {
+                    rows.push_back(*it);
+                }
+            }
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+size_t VOTableSkyIndex::size() const
+{
+    return itsSize;
+}
@@ -0,0 +1,150 @@
+/// @file VOTableIndex.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEINDEX_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEINDEX_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Local package includes
+#include "askap/votable/VOTableColumn.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Sorted index of a numeric column of a VOTableTable
+        /// @details The values are copied, so the index doesn't refer to the column,
+        /// but it doesn't see the rows added after it has been built. Null cells are
+        /// not indexed. Integers are indexed as doubles.
+        ///
+        /// @ingroup votableaccess
+        class VOTableSortedIndex {
+            public:
+
+                /// @brief Constructor
+                /// @param[in] column REAL or INTEGER column to index
+                /// @throw AskapError   for other columns
+                explicit VOTableSortedIndex(const VOTableColumn& column);
+
+                /// @return rows with values within the given range (inclusive), in row order
+                std::vector<size_t> findRange(double min, double max) const;
+
+                /// @return rows with the given value, in row order
+                std::vector<size_t> find(double value) const;
+
+                /// @return number of indexed (non-null) cells
+                size_t size() const;
+
+            private:
+                /// values in ascending order
+                std::vector<double> itsValues;
+
+                /// rows of the values
+                std::vector<size_t> itsRows;
+        };
+
+        /// @brief Hash index of the cell text of a VOTableTable column
+        /// @details Intended for the ID columns. The text of the cells is used as
+        /// the key, so any column can be indexed. Null cells are not indexed.
+        ///
+        /// @ingroup votableaccess
+        class VOTableHashIndex {
+            public:
+
+                /// @brief Constructor
+                /// @param[in] column column to index
+                explicit VOTableHashIndex(const VOTableColumn& column);
+
+                /// @return rows with the given text, in row order
+                std::vector<size_t> find(const std::string& key) const;
+
+                /// @return true if there is at least one row with the given text
+                bool contains(const std::string& key) const;
+
+                /// @return number of distinct keys
+                size_t size() const;
+
+            private:
+                /// rows for every key
+                std::unordered_map<std::string, std::vector<size_t> > itsRows;
+        };
+
+        /// @brief Positional index of a VOTableTable
+        /// @details The sky is split into declination bands of the given width and
+        /// every band into right ascension buckets of about the same width on the sky.
+        /// A cone search looks at the buckets overlapping the cone only and checks
+        /// the exact angular distance for the rows found there. The positions are
+        /// copied, rows with null positions are not indexed.
+        ///
+        /// @ingroup votableaccess
+        class VOTableSkyIndex {
+            public:
+
+                /// @brief Constructor
+                /// @param[in] ra column with right ascension (degrees)
+                /// @param[in] dec column with declination (degrees)
+                /// @param[in] cellSize width of the buckets (degrees), about the
+                ///            typical search radius works best
+                /// @throw AskapError   for non-numeric columns or columns of different size
+                VOTableSkyIndex(const VOTableColumn& ra, const VOTableColumn& dec,
+                                double cellSize = 1.);
+
+                /// @return rows within the given distance from the given position, in row order
+                /// @param[in] ra right ascension of the centre (degrees)
+                /// @param[in] dec declination of the centre (degrees)
+                /// @param[in] radius radius of the cone (degrees)
+                std::vector<size_t> findCone(double ra, double dec, double radius) const;
+
+                /// @return number of indexed rows
+                size_t size() const;
+
+            private:
+                /// @return number of right ascension buckets in the given band
+                size_t nBuckets(size_t band) const;
+
+                /// width of the buckets (degrees)
+                double itsCellSize;
+
+                /// rows for every bucket of every declination band
+                std::vector<std::vector<std::vector<size_t> > > itsBuckets;
+
+                /// right ascension of the rows (degrees), NaN for not indexed rows
+                std::vector<double> itsRA;
+
+                /// declination of the rows (degrees)
+                std::vector<double> itsDec;
+
+                /// number of indexed rows
+                size_t itsSize;
+        };
+
+    }
+}
+
+#endif
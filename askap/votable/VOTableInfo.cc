@@ -43,6 +43,7 @@
 
 // Local package includes
 #include "askap/votable/XercescUtils.h"
+#include "askap/votable/VOTableTags.h"
 
 ASKAP_LOGGER(logger, ".VOTableInfo");
 
@@ -96,17 +97,17 @@ std::string VOTableInfo::getText() const
 
 DOMElement* VOTableInfo::toXmlElement(DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("INFO"));
+    DOMElement* e = doc.createElement(VOTableTags::INFO);
 
     // Add attributes
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableTags::ATTR_ID, XercescString(itsID));
     }
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableTags::ATTR_NAME, XercescString(itsName));
     }
     if (itsValue.length()) {
-        e->setAttribute(XercescString("value"), XercescString(itsValue));
+        e->setAttribute(VOTableTags::ATTR_VALUE, XercescString(itsValue));
     }
 
     // Add text
@@ -122,9 +123,9 @@ VOTableInfo VOTableInfo::fromXmlElement(const xercesc::DOMElement& e)
 {
     VOTableInfo info;
 
-    info.setID(XercescUtils::getAttribute(e, "ID"));
-    info.setName(XercescUtils::getAttribute(e, "name"));
-    info.setValue(XercescUtils::getAttribute(e, "value"));
+    info.setID(XercescUtils::getAttribute(e, VOTableTags::ATTR_ID));
+    info.setName(XercescUtils::getAttribute(e, VOTableTags::ATTR_NAME));
+    info.setValue(XercescUtils::getAttribute(e, VOTableTags::ATTR_VALUE));
 
     const DOMText* text = dynamic_cast<xercesc::DOMText*>(e.getChildNodes()->item(0));
     std::string str = XercescUtils::getStringFromDOMText(*text);
@@ -42,6 +42,7 @@
 // Local package includes
 #include "askap/votable/XercescUtils.h"
 #include "askap/votable/XercescString.h"
+#include "askap/votable/VOTableTags.h"
 
 ASKAP_LOGGER(logger, ".VOTableParam");
 
@@ -155,40 +156,40 @@ std::string VOTableParam::getValue() const
 
 xercesc::DOMElement* VOTableParam::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("PARAM"));
+    DOMElement* e = doc.createElement(VOTableTags::PARAM);
 
     // Add attributes
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableTags::ATTR_NAME, XercescString(itsName));
     }
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableTags::ATTR_ID, XercescString(itsID));
     }
     if (itsDatatype.length() > 0) {
-        e->setAttribute(XercescString("datatype"), XercescString(itsDatatype));
+        e->setAttribute(VOTableTags::ATTR_DATATYPE, XercescString(itsDatatype));
     }
     if (itsArraysize.length() > 0) {
-        e->setAttribute(XercescString("arraysize"), XercescString(itsArraysize));
+        e->setAttribute(VOTableTags::ATTR_ARRAYSIZE, XercescString(itsArraysize));
     }
     if (itsUnit.length() > 0) {
-        e->setAttribute(XercescString("unit"), XercescString(itsUnit));
+        e->setAttribute(VOTableTags::ATTR_UNIT, XercescString(itsUnit));
     }
     if (itsUCD.length() > 0) {
-        e->setAttribute(XercescString("ucd"), XercescString(itsUCD));
+        e->setAttribute(VOTableTags::ATTR_UCD, XercescString(itsUCD));
     }
     if (itsUType.length() > 0) {
-        e->setAttribute(XercescString("utype"), XercescString(itsUType));
+        e->setAttribute(VOTableTags::ATTR_UTYPE, XercescString(itsUType));
     }
     if (itsRef.length() > 0) {
-        e->setAttribute(XercescString("ref"), XercescString(itsRef));
+        e->setAttribute(VOTableTags::ATTR_REF, XercescString(itsRef));
     }
     if (itsValue.length() > 0) {
-        e->setAttribute(XercescString("value"), XercescString(itsValue));
+        e->setAttribute(VOTableTags::ATTR_VALUE, XercescString(itsValue));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableTags::DESCRIPTION);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -201,15 +202,15 @@ VOTableParam VOTableParam::fromXmlElement(const xercesc::DOMElement& e)
     VOTableParam p;
 
     // Get attributes
-    p.setName(XercescUtils::getAttribute(e, "name"));
-    p.setID(XercescUtils::getAttribute(e, "ID"));
-    p.setDatatype(XercescUtils::getAttribute(e, "datatype"));
-    p.setArraysize(XercescUtils::getAttribute(e, "arraysize"));
-    p.setUnit(XercescUtils::getAttribute(e, "unit"));
-    p.setUCD(XercescUtils::getAttribute(e, "ucd"));
-    p.setUType(XercescUtils::getAttribute(e, "utype"));
-    p.setRef(XercescUtils::getAttribute(e, "ref"));
-    p.setValue(XercescUtils::getAttribute(e, "value"));
+    p.setName(XercescUtils::getAttribute(e, VOTableTags::ATTR_NAME));
+    p.setID(XercescUtils::getAttribute(e, VOTableTags::ATTR_ID));
+    p.setDatatype(XercescUtils::getAttribute(e, VOTableTags::ATTR_DATATYPE));
+    p.setArraysize(XercescUtils::getAttribute(e, VOTableTags::ATTR_ARRAYSIZE));
+    p.setUnit(XercescUtils::getAttribute(e, VOTableTags::ATTR_UNIT));
+    p.setUCD(XercescUtils::getAttribute(e, VOTableTags::ATTR_UCD));
+    p.setUType(XercescUtils::getAttribute(e, VOTableTags::ATTR_UTYPE));
+    p.setRef(XercescUtils::getAttribute(e, VOTableTags::ATTR_REF));
+    p.setValue(XercescUtils::getAttribute(e, VOTableTags::ATTR_VALUE));
 
     // Get description
     p.setDescription(XercescUtils::getDescription(e));
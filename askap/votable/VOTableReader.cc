@@ -0,0 +1,438 @@
+/// @file VOTableReader.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// Include own header file first
+#include "VOTableReader.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <utility>
+#include <vector>
+#include <istream>
+#include <fstream>
+#include <algorithm>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include "boost/scoped_ptr.hpp"
+#include "boost/algorithm/string/trim.hpp"
+#include "xercesc/sax2/SAX2XMLReader.hpp"
+#include "xercesc/sax2/XMLReaderFactory.hpp"
+#include "xercesc/sax/SAXParseException.hpp"
+#include "xercesc/util/BinInputStream.hpp"
+#include "xercesc/framework/LocalFileInputSource.hpp"
+
+// Local package includes
+#include "askap/votable/XercescString.h"
+#include "askap/votable/VOTableTags.h"
+#include "askap/votable/VOTableStream.h"
+
+ASKAP_LOGGER(logger, ".VOTableReader");
+
+using namespace askap;
+using namespace askap::accessors;
+using namespace xercesc;
+
+namespace {
+
+/// @brief Xerces input stream reading from std::istream
+/// @details Unlike MemBufInputSource used by VOTable::fromXML, the stream is
+/// read in blocks as the parser needs them.
+class StdBinInputStream : public BinInputStream {
+    public:
+        explicit StdBinInputStream(std::istream& is) : itsStream(is), itsPos(0) {}
+
+        virtual XMLFilePos curPos() const
+        {
+            return itsPos;
+        }
+
+        virtual XMLSize_t readBytes(XMLByte* const toFill, const XMLSize_t maxToRead)
+        {
+            itsStream.read(reinterpret_cast<char*>(toFill), maxToRead);
+            const XMLSize_t nRead = itsStream.gcount();
+            itsPos += nRead;
+            return nRead;
+        }
+
+        virtual const XMLCh* getContentType() const
+        {
+            return 0;
+        }
+
+    private:
+        std::istream& itsStream;
+        XMLFilePos itsPos;
+};
+
+/// @brief Xerces input source for std::istream
+class StdInputSource : public InputSource {
+    public:
+        explicit StdInputSource(std::istream& is) : itsStream(is) {}
+
+        virtual BinInputStream* makeStream() const
+        {
+            return new StdBinInputStream(itsStream);
+        }
+
+    private:
+        std::istream& itsStream;
+};
+
+}
+
+VOTableReader::VOTableReader() : itsInStream(false), itsCollectText(false), itsRowCount(0)
+{
+}
+
+VOTableReader::VOTableReader(const RowCallback& callback) : itsCallback(callback),
+    itsInStream(false), itsCollectText(false), itsRowCount(0)
+{
+}
+
+VOTable VOTableReader::read(const std::string& filename)
+{
+    // Check if the file exists
+    std::ifstream fs(filename.c_str());
+    if (!fs) {
+        ASKAPTHROW(AskapError, "File " << filename << " could not be opened");
+    }
+    fs.close();
+
+    // Compressed files are decompressed while they are parsed
+    if (VOTableCompression::detect(filename) != VOTableCompression::NONE) {
+        VOTableInputStream is(filename);
+        return read(is);
+    }
+
+    xercesc::XMLPlatformUtils::Initialize();
+    VOTable vot;
+    try {
+        const LocalFileInputSource source((XercescString(filename)));
+        vot = readImpl(source);
+    } catch (...) {
+        xercesc::XMLPlatformUtils::Terminate();
+        throw;
+    }
+    xercesc::XMLPlatformUtils::Terminate();
+    return vot;
+}
+
+VOTable VOTableReader::read(std::istream& is)
+{
+    xercesc::XMLPlatformUtils::Initialize();
+    VOTable vot;
+    try {
+        const StdInputSource source(is);
+        vot = readImpl(source);
+    } catch (...) {
+        xercesc::XMLPlatformUtils::Terminate();
+        throw;
+    }
+    xercesc::XMLPlatformUtils::Terminate();
+    return vot;
+}
+
+size_t VOTableReader::rowCount() const
+{
+    return itsRowCount;
+}
+
+VOTable VOTableReader::readImpl(const xercesc::InputSource& source)
+{
+    DataAccessStatistics::ScopedTimer timer("VOTableReader::read");
+
+    // Reset the state left by the previous document
+    itsVOTable = VOTable();
+    itsElements.clear();
+    itsResources.clear();
+    itsGroups.clear();
+    itsTable = VOTableTable();
+    itsRow = VOTableRow();
+    itsBinary.reset();
+    itsInStream = false;
+    itsBase64Pending.clear();
+    itsText.clear();
+    itsCollectText = false;
+    itsRowCount = 0;
+
+    // Setup a parser
+    boost::scoped_ptr<SAX2XMLReader> parser(XMLReaderFactory::createXMLReader());
+    parser->setFeature(XMLUni::fgSAX2CoreValidation, false);
+    parser->setFeature(XMLUni::fgSAX2CoreNameSpaces, false);
+    parser->setFeature(XMLUni::fgXercesSchema, false);
+    parser->setFeature(XMLUni::fgXercesLoadExternalDTD, false);
+    parser->setContentHandler(this);
+    parser->setErrorHandler(this);
+
+    // Parse, the VOTable is built by the handlers
+    parser->parse(source);
+    parser.reset(0);
+
+    ASKAPLOG_DEBUG_STR(logger, "Read " << itsRowCount << " VOTable row(s)");
+    VOTable vot;
+    std::swap(vot, itsVOTable);
+    return vot;
+}
+
+void VOTableReader::startElement(const XMLCh* const, const XMLCh* const,
+                                 const XMLCh* const qname, const xercesc::Attributes& attrs)
+{
+    const std::string name = XercescString::toString(qname);
+    const std::string parent = parentElement();
+    itsElements.push_back(name);
+
+    if (name == "TD" || name == "DESCRIPTION" || name == "INFO") {
+        itsText.clear();
+        itsCollectText = true;
+    }
+
+    if (name == "TD" || name == "TR" || name == "DATA" || name == "TABLEDATA") {
+        // Nothing to do, the most frequent elements are checked first
+    } else if ((name == "BINARY" || name == "BINARY2") && parent == "DATA") {
+        const bool binary2 = name == "BINARY2";
+        itsTable.setDataFormat(binary2 ? VOTableTable::BINARY2 : VOTableTable::BINARY);
+        itsBinary.reset(new VOTableBinary(itsTable.getFields(), binary2));
+    } else if (name == "STREAM" && itsBinary) {
+        const std::string encoding = getAttribute(attrs, VOTableTags::ATTR_ENCODING);
+        ASKAPCHECK(encoding.empty() || encoding == "base64", "Unsupported STREAM encoding " << encoding);
+        const std::string href = getAttribute(attrs, VOTableTags::ATTR_HREF);
+        if (href.empty()) {
+            ASKAPCHECK(encoding == "base64", "Inline STREAM has to be base64 encoded");
+            itsBase64Pending.clear();
+            itsInStream = true;
+        } else {
+            readExternalStream(href, encoding == "base64");
+        }
+    } else if (name == "RESOURCE") {
+        VOTableResource res;
+        res.setID(getAttribute(attrs, VOTableTags::ATTR_ID));
+        res.setName(getAttribute(attrs, VOTableTags::ATTR_NAME));
+        res.setType(getAttribute(attrs, VOTableTags::ATTR_TYPE));
+        itsResources.push_back(res);
+    } else if (name == "TABLE") {
+        itsTable = VOTableTable();
+        itsTable.setID(getAttribute(attrs, VOTableTags::ATTR_ID));
+        itsTable.setName(getAttribute(attrs, VOTableTags::ATTR_NAME));
+    } else if (name == "FIELD") {
+        itsField = VOTableField();
+        itsField.setName(getAttribute(attrs, VOTableTags::ATTR_NAME));
+        itsField.setID(getAttribute(attrs, VOTableTags::ATTR_ID));
+        itsField.setDatatype(getAttribute(attrs, VOTableTags::ATTR_DATATYPE));
+        itsField.setArraysize(getAttribute(attrs, VOTableTags::ATTR_ARRAYSIZE));
+        itsField.setUnit(getAttribute(attrs, VOTableTags::ATTR_UNIT));
+        itsField.setUCD(getAttribute(attrs, VOTableTags::ATTR_UCD));
+        itsField.setUType(getAttribute(attrs, VOTableTags::ATTR_UTYPE));
+        itsField.setRef(getAttribute(attrs, VOTableTags::ATTR_REF));
+    } else if (name == "PARAM") {
+        itsParam = VOTableParam();
+        itsParam.setName(getAttribute(attrs, VOTableTags::ATTR_NAME));
+        itsParam.setID(getAttribute(attrs, VOTableTags::ATTR_ID));
+        itsParam.setDatatype(getAttribute(attrs, VOTableTags::ATTR_DATATYPE));
+        itsParam.setArraysize(getAttribute(attrs, VOTableTags::ATTR_ARRAYSIZE));
+        itsParam.setUnit(getAttribute(attrs, VOTableTags::ATTR_UNIT));
+        itsParam.setUCD(getAttribute(attrs, VOTableTags::ATTR_UCD));
+        itsParam.setUType(getAttribute(attrs, VOTableTags::ATTR_UTYPE));
+        itsParam.setRef(getAttribute(attrs, VOTableTags::ATTR_REF));
+        itsParam.setValue(getAttribute(attrs, VOTableTags::ATTR_VALUE));
+    } else if (name == "GROUP") {
+        VOTableGroup g;
+        g.setName(getAttribute(attrs, VOTableTags::ATTR_NAME));
+        g.setID(getAttribute(attrs, VOTableTags::ATTR_ID));
+        g.setUCD(getAttribute(attrs, VOTableTags::ATTR_UCD));
+        g.setUType(getAttribute(attrs, VOTableTags::ATTR_UTYPE));
+        g.setRef(getAttribute(attrs, VOTableTags::ATTR_REF));
+        itsGroups.push_back(g);
+    } else if (name == "FIELDref" && parent == "GROUP") {
+        itsGroups.back().addFieldRef(getAttribute(attrs, VOTableTags::ATTR_REF));
+    } else if (name == "PARAMref" && parent == "GROUP") {
+        itsGroups.back().addParamRef(getAttribute(attrs, VOTableTags::ATTR_REF));
+    } else if (name == "INFO") {
+        itsInfo = VOTableInfo();
+        itsInfo.setID(getAttribute(attrs, VOTableTags::ATTR_ID));
+        itsInfo.setName(getAttribute(attrs, VOTableTags::ATTR_NAME));
+        itsInfo.setValue(getAttribute(attrs, VOTableTags::ATTR_VALUE));
+    }
+}
+
+void VOTableReader::endElement(const XMLCh* const, const XMLCh* const, const XMLCh* const)
+{
+    ASKAPDEBUGASSERT(!itsElements.empty());
+    const std::string name = itsElements.back();
+    itsElements.pop_back();
+    const std::string parent = parentElement();
+    const bool inTable = std::find(itsElements.begin(), itsElements.end(), "TABLE") != itsElements.end();
+
+    if (name == "TD") {
+        itsRow.addCell(text());
+    } else if (name == "TR") {
+        processRow();
+    } else if (name == "STREAM" && itsBinary) {
+        itsInStream = false;
+        ASKAPCHECK(itsBase64Pending.empty() && !itsBinary->hasPartialRow(),
+                   "Incomplete row at the end of the binary STREAM of the table " << itsTable.getName());
+    } else if (name == "BINARY" || name == "BINARY2") {
+        itsBinary.reset();
+    } else if (name == "DESCRIPTION") {
+        const std::string desc = text();
+        if (parent == "VOTABLE") {
+            itsVOTable.setDescription(desc);
+        } else if (parent == "RESOURCE") {
+            itsResources.back().setDescription(desc);
+        } else if (parent == "TABLE") {
+            itsTable.setDescription(desc);
+        } else if (parent == "FIELD") {
+            itsField.setDescription(desc);
+        } else if (parent == "PARAM") {
+            itsParam.setDescription(desc);
+        } else if (parent == "GROUP") {
+            itsGroups.back().setDescription(desc);
+        }
+    } else if (name == "FIELD") {
+        if (parent == "TABLE") {
+            itsTable.addField(std::move(itsField));
+        }
+    } else if (name == "PARAM") {
+        if (parent == "GROUP") {
+            itsGroups.back().addParam(itsParam);
+        }
+    } else if (name == "GROUP") {
+        if (inTable) {
+            itsTable.addGroup(itsGroups.back());
+        }
+        itsGroups.pop_back();
+    } else if (name == "TABLE") {
+        if (!itsResources.empty()) {
+            itsResources.back().addTable(std::move(itsTable));
+        }
+        itsTable = VOTableTable();
+    } else if (name == "RESOURCE") {
+        itsVOTable.addResource(std::move(itsResources.back()));
+        itsResources.pop_back();
+    } else if (name == "INFO") {
+        itsInfo.setText(text());
+        if (parent == "VOTABLE") {
+            itsVOTable.addInfo(itsInfo);
+        } else if (parent == "RESOURCE") {
+            itsResources.back().addInfo(itsInfo);
+        }
+    }
+
+    if (name == "TD" || name == "DESCRIPTION" || name == "INFO") {
+        itsCollectText = false;
+    }
+}
+
+void VOTableReader::characters(const XMLCh* const chars, const XMLSize_t length)
+{
+    if (itsInStream) {
+        // base64 is plain ASCII, other characters are rejected by the decoder
+        std::string text(length, '!');
+        for (XMLSize_t i = 0; i < length; ++i) {
+            if (chars[i] < 0x80) {
+                text[i] = static_cast<char>(chars[i]);
+            }
+        }
+        decodeStream(text.data(), text.size());
+    } else if (itsCollectText) {
+        itsText.insert(itsText.end(), chars, chars + length);
+    }
+}
+
+void VOTableReader::fatalError(const xercesc::SAXParseException& exc)
+{
+    const std::string msg = XercescString(exc.getMessage());
+    ASKAPTHROW(AskapError, "Error parsing VOTable at line " << exc.getLineNumber() << ": " << msg);
+}
+
+void VOTableReader::processRow()
+{
+    if (itsCallback) {
+        itsCallback(itsTable, itsRow);
+    } else {
+        itsTable.addRow(std::move(itsRow));
+    }
+    itsRow = VOTableRow();
+    ++itsRowCount;
+}
+
+void VOTableReader::readExternalStream(const std::string& href, bool base64)
+{
+    ASKAPDEBUGASSERT(itsBinary);
+    const std::string path = VOTableBinary::hrefToPath(href);
+    std::ifstream fs(path.c_str(), std::ios::binary);
+    ASKAPCHECK(fs, "File " << path << " of the external STREAM could not be opened");
+    itsBase64Pending.clear();
+    std::vector<char> buf(65536);
+    while (fs) {
+        fs.read(&buf[0], buf.size());
+        const size_t nRead = fs.gcount();
+        if (base64) {
+            decodeStream(&buf[0], nRead);
+        } else {
+            itsBinary->appendData(&buf[0], nRead);
+            while (itsBinary->nextRow(itsRow)) {
+                processRow();
+            }
+        }
+    }
+}
+
+void VOTableReader::decodeStream(const char* text, size_t size)
+{
+    ASKAPDEBUGASSERT(itsBinary);
+    itsDecoded.clear();
+    VOTableBinary::base64Decode(text, size, itsBase64Pending, itsDecoded);
+    itsBinary->appendData(itsDecoded.data(), itsDecoded.size());
+    while (itsBinary->nextRow(itsRow)) {
+        processRow();
+    }
+}
+
+std::string VOTableReader::parentElement() const
+{
+    return itsElements.empty() ? "" : itsElements.back();
+}
+
+std::string VOTableReader::text() const
+{
+    if (itsText.empty()) {
+        return "";
+    }
+    std::string str = XercescString::toString(&itsText[0], itsText.size());
+    boost::trim(str);
+    return str;
+}
+
+std::string VOTableReader::getAttribute(const xercesc::Attributes& attrs, const XMLCh* key)
+{
+    return XercescString::toString(attrs.getValue(key));
+}
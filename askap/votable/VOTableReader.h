@@ -0,0 +1,191 @@
+/// @file VOTableReader.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEREADER_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEREADER_H
+
+// System includes
+#include <string>
+#include <vector>
+#include <istream>
+
+// ASKAPsoft includes
+#include "boost/function.hpp"
+#include "boost/scoped_ptr.hpp"
+#include "xercesc/sax/InputSource.hpp"
+#include "xercesc/sax2/Attributes.hpp"
+#include "xercesc/sax2/DefaultHandler.hpp"
+
+// Local package includes
+#include "askap/votable/VOTable.h"
+#include "askap/votable/VOTableBinary.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Streaming (SAX2) reader of XML VOTables
+        /// @details VOTable::fromXML builds the whole DOM tree before the VOTable
+        /// object is assembled, so for large catalogues the memory footprint is a few
+        /// times the size of the table itself. This reader builds the VOTable while the
+        /// document is parsed and never holds more than one row in addition to the
+        /// result. BINARY and BINARY2 streams (inline base64 or external local files)
+        /// are decoded as they are read as well. If a row callback is given, the rows are passed to it as soon as they
+        /// are read and are not stored in the tables at all, so the memory footprint
+        /// doesn't depend on the number of rows.
+        ///
+        /// Unlike the DOM based reader, elements are only attached to their immediate
+        /// parent (e.g. INFO elements of a RESOURCE are not duplicated at the top level).
+        /// Nested RESOURCE and GROUP elements are flattened.
+        ///
+        /// @ingroup votableaccess
+        class VOTableReader : public xercesc::DefaultHandler {
+            public:
+
+                /// @brief type of the row callback
+                /// @details The first parameter is the table being read, it has all
+                /// elements preceding the data (fields, groups, description) but no rows.
+                /// The second parameter is the row just read.
+                typedef boost::function<void(const VOTableTable&, const VOTableRow&)> RowCallback;
+
+                /// @brief Constructor, rows are stored in the tables
+                VOTableReader();
+
+                /// @brief Constructor, rows are passed to the callback
+                /// @param[in] callback function called for every row read
+                explicit VOTableReader(const RowCallback& callback);
+
+                /// Read an XML VOTable
+                ///
+                /// @param[in] filename the file/path to read the XML input from,
+                ///                     gzip and zstd compressed files are
+                ///                     decompressed as they are parsed.
+                /// @return a VOTable (without rows if the callback is set).
+                /// @throw AskapError   if the XML document is empty or malformed
+                ///                     or if the specified file cannot be opened.
+                VOTable read(const std::string& filename);
+
+                /// Read an XML VOTable
+                ///
+                /// @param[in] is   an istream from which the XML input string
+                ///                 will be read from.
+                /// @return a VOTable (without rows if the callback is set).
+                /// @throw AskapError   if the XML document is empty or malformed.
+                VOTable read(std::istream& is);
+
+                /// @return number of rows read by the last call to read
+                size_t rowCount() const;
+
+                // SAX2 content and error handler interface
+
+                virtual void startElement(const XMLCh* const uri, const XMLCh* const localname,
+                                          const XMLCh* const qname, const xercesc::Attributes& attrs);
+
+                virtual void endElement(const XMLCh* const uri, const XMLCh* const localname,
+                                        const XMLCh* const qname);
+
+                virtual void characters(const XMLCh* const chars, const XMLSize_t length);
+
+                virtual void fatalError(const xercesc::SAXParseException& exc);
+
+            private:
+
+                /// Parse the document from the given source
+                VOTable readImpl(const xercesc::InputSource& source);
+
+                /// @return name of the parent of the current element, empty string at the top level
+                std::string parentElement() const;
+
+                /// Store or pass to the callback the row just read
+                void processRow();
+
+                /// Read the external file of a STREAM element
+                void readExternalStream(const std::string& href, bool base64);
+
+                /// Decode the given base64 text of the current STREAM
+                void decodeStream(const char* text, size_t size);
+
+                /// @return accumulated text of the current element (trimmed)
+                std::string text() const;
+
+                /// Get an attribute of the current element, the key is one of VOTableTags
+                static std::string getAttribute(const xercesc::Attributes& attrs, const XMLCh* key);
+
+                /// Function called for every row, rows are stored if empty
+                RowCallback itsCallback;
+
+                /// VOTable being built
+                VOTable itsVOTable;
+
+                /// Names of the open elements, the last one is the current element
+                std::vector<std::string> itsElements;
+
+                /// Open RESOURCE elements
+                std::vector<VOTableResource> itsResources;
+
+                /// Open GROUP elements
+                std::vector<VOTableGroup> itsGroups;
+
+                /// TABLE being read
+                VOTableTable itsTable;
+
+                /// FIELD being read
+                VOTableField itsField;
+
+                /// PARAM being read
+                VOTableParam itsParam;
+
+                /// INFO being read
+                VOTableInfo itsInfo;
+
+                /// TR being read
+                VOTableRow itsRow;
+
+                /// Decoder of the current BINARY or BINARY2 element
+                boost::scoped_ptr<VOTableBinary> itsBinary;
+
+                /// True, if inside a STREAM element with inline data
+                bool itsInStream;
+
+                /// Base64 characters not decoded yet
+                std::string itsBase64Pending;
+
+                /// Decoded bytes of the current chunk of the stream
+                std::string itsDecoded;
+
+                /// Text content of the current element
+                std::vector<XMLCh> itsText;
+
+                /// True if the text content of the current element is needed
+                bool itsCollectText;
+
+                /// Number of rows read
+                size_t itsRowCount;
+        };
+
+    }
+}
+
+#endif
@@ -32,6 +32,7 @@
 
 // System includes
 #include <string>
+#include <utility>
 #include <vector>
 
 // ASKAPsoft includes
@@ -44,6 +45,7 @@
 #include "askap/votable/XercescUtils.h"
 #include "askap/votable/VOTableInfo.h"
 #include "askap/votable/VOTableTable.h"
+#include "askap/votable/VOTableTags.h"
 
 ASKAP_LOGGER(logger, ".VOTableResource");
 
@@ -100,7 +102,12 @@ void VOTableResource::addInfo(const VOTableInfo& info)
     itsInfo.push_back(info);
 }
 
-std::vector<VOTableInfo> VOTableResource::getInfo() const
+void VOTableResource::addInfo(VOTableInfo&& info)
+{
+    itsInfo.push_back(std::move(info));
+}
+
+const std::vector<VOTableInfo>& VOTableResource::getInfo() const
 {
     return itsInfo;
 }
@@ -110,29 +117,39 @@ void VOTableResource::addTable(const VOTableTable& table)
     itsTables.push_back(table);
 }
 
-std::vector<VOTableTable> VOTableResource::getTables() const
+void VOTableResource::addTable(VOTableTable&& table)
+{
+    itsTables.push_back(std::move(table));
+}
+
+const std::vector<VOTableTable>& VOTableResource::getTables() const
+{
+    return itsTables;
+}
+
+std::vector<VOTableTable>& VOTableResource::getTables()
 {
     return itsTables;
 }
 
 xercesc::DOMElement* VOTableResource::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("RESOURCE"));
+    DOMElement* e = doc.createElement(VOTableTags::RESOURCE);
 
     // Add attributes
     if (itsID.length() > 0) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableTags::ATTR_ID, XercescString(itsID));
     }
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableTags::ATTR_NAME, XercescString(itsName));
     }
     if (itsType.length() > 0) {
-        e->setAttribute(XercescString("type"), XercescString(itsType));
+        e->setAttribute(VOTableTags::ATTR_TYPE, XercescString(itsType));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableTags::DESCRIPTION);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -158,15 +175,15 @@ VOTableResource VOTableResource::fromXmlElement(const xercesc::DOMElement& e)
     VOTableResource res;
 
     // Get attributes
-    res.setID(XercescUtils::getAttribute(e, "ID"));
-    res.setName(XercescUtils::getAttribute(e, "name"));
-    res.setType(XercescUtils::getAttribute(e, "type"));
+    res.setID(XercescUtils::getAttribute(e, VOTableTags::ATTR_ID));
+    res.setName(XercescUtils::getAttribute(e, VOTableTags::ATTR_NAME));
+    res.setType(XercescUtils::getAttribute(e, VOTableTags::ATTR_TYPE));
 
     // Get description
     res.setDescription(XercescUtils::getDescription(e));
 
     // Process INFO
-    DOMNodeList* children = e.getElementsByTagName(XercescString("INFO"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableTags::INFO);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableInfo info = VOTableInfo::fromXmlElement(*node);
@@ -174,7 +191,7 @@ VOTableResource VOTableResource::fromXmlElement(const xercesc::DOMElement& e)
     }
 
     // Process TABLE
-    children = e.getElementsByTagName(XercescString("TABLE"));
+    children = e.getElementsByTagName(VOTableTags::TABLE);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableTable tab = VOTableTable::fromXmlElement(*node);
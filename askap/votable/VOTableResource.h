@@ -63,10 +63,15 @@ namespace askap {
                 std::string getType() const;
 
                 void addInfo(const VOTableInfo& info);
-                std::vector<VOTableInfo> getInfo() const;
+                void addInfo(VOTableInfo&& info);
+                const std::vector<VOTableInfo>& getInfo() const;
 
                 void addTable(const VOTableTable& table);
-                std::vector<VOTableTable> getTables() const;
+                void addTable(VOTableTable&& table);
+                const std::vector<VOTableTable>& getTables() const;
+
+                /// @brief access the tables for modification
+                std::vector<VOTableTable>& getTables();
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
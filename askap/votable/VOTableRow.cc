@@ -33,6 +33,7 @@
 // System includes
 # include <vector>
 # include <string>
+# include <utility>
 
 // ASKAPsoft includes
 #include <askap/askap/AskapLogging.h>
@@ -43,6 +44,7 @@
 // Local package includes
 #include "askap/votable/XercescUtils.h"
 #include "askap/votable/XercescString.h"
+#include "askap/votable/VOTableTags.h"
 
 ASKAP_LOGGER(logger, ".VOTableRow");
 
@@ -59,18 +61,39 @@ void VOTableRow::addCell(const std::string& cell)
     itsCells.push_back(cell);
 }
 
-std::vector<std::string> VOTableRow::getCells() const
+void VOTableRow::addCell(std::string&& cell)
+{
+    itsCells.push_back(std::move(cell));
+}
+
+void VOTableRow::resize(size_t nCells)
+{
+    itsCells.resize(nCells);
+}
+
+void VOTableRow::setCell(size_t index, std::string&& cell)
+{
+    ASKAPDEBUGASSERT(index < itsCells.size());
+    itsCells[index] = std::move(cell);
+}
+
+const std::vector<std::string>& VOTableRow::getCells() const
+{
+    return itsCells;
+}
+
+std::vector<std::string>& VOTableRow::getCells()
 {
     return itsCells;
 }
 
 xercesc::DOMElement* VOTableRow::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* tr = doc.createElement(XercescString("TR"));
+    DOMElement* tr = doc.createElement(VOTableTags::TR);
 
     for (std::vector<std::string>::const_iterator it = itsCells.begin();
             it != itsCells.end(); ++it) {
-        DOMElement* td = doc.createElement(XercescString("TD"));
+        DOMElement* td = doc.createElement(VOTableTags::TD);
         DOMText* text = doc.createTextNode(XercescString(*it));
         td->appendChild(text);
         tr->appendChild(td);
@@ -84,14 +107,14 @@ VOTableRow VOTableRow::fromXmlElement(const xercesc::DOMElement& e)
     VOTableRow r;
 
     // Process TD
-    DOMNodeList* children = e.getElementsByTagName(XercescString("TD"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableTags::TD);
     const XMLSize_t nCells = children->getLength();
     for (XMLSize_t i = 0; i < nCells; ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const DOMText* text = dynamic_cast<xercesc::DOMText*>(node->getChildNodes()->item(0));
         std::string str = XercescUtils::getStringFromDOMText(*text);
         boost::trim(str);
-        r.addCell(str);
+        r.addCell(std::move(str));
     }
 
     return r;
@@ -47,7 +47,18 @@ namespace askap {
                 VOTableRow();
 
                 void addCell(const std::string& cell);
-                std::vector<std::string> getCells() const;
+                void addCell(std::string&& cell);
+
+                /// @brief set the number of cells, new cells are empty
+                void resize(size_t nCells);
+
+                /// @brief replace the given cell
+                void setCell(size_t index, std::string&& cell);
+
+                const std::vector<std::string>& getCells() const;
+
+                /// @brief access the cells for modification, e.g. to move them out
+                std::vector<std::string>& getCells();
 
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
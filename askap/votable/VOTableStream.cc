@@ -0,0 +1,563 @@
+/// @file VOTableStream.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// Include own header file first
+#include "VOTableStream.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include "boost/thread/thread.hpp"
+#include "boost/bind.hpp"
+#include "boost/ref.hpp"
+
+ASKAP_LOGGER(logger, ".VOTableStream");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// size of the blocks read from the compressed file
+const size_t theirInputSize = 1 << 16;
+
+/// size of the decompressed blocks
+const size_t theirOutputSize = 1 << 18;
+
+/// size of the blocks compressed independently by the gzip threads
+const size_t theirBlockSize = 1 << 20;
+
+/// @brief compress the block as a gzip member
+/// @return false if zlib has failed
+bool gzipBlock(const std::string& in, std::string& out, int level)
+{
+    z_stream zs;
+    std::memset(&zs, 0, sizeof(zs));
+    if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    out.resize(deflateBound(&zs, in.size()) + 32);
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+    zs.avail_in = in.size();
+    zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    zs.avail_out = out.size();
+    const int ret = deflate(&zs, Z_FINISH);
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+    return ret == Z_STREAM_END;
+}
+
+/// @brief body of the gzip threads, every thread compresses every nThreads-th block
+void gzipBlocks(const std::vector<std::string>& in, std::vector<std::string>& out,
+                std::vector<char>& ok, size_t first, size_t step, int level)
+{
+    for (size_t i = first; i < in.size(); i += step) {
+        ok[i] = gzipBlock(in[i], out[i], level);
+    }
+}
+
+}
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief stream buffer decompressing the data read from the source stream
+        class VOTableDecompressingBuffer : public std::streambuf {
+            public:
+                VOTableDecompressingBuffer(std::istream& source, VOTableCompression::Codec codec);
+
+                virtual ~VOTableDecompressingBuffer();
+
+            protected:
+                virtual int_type underflow();
+
+            private:
+                /// @brief read the next block of the compressed data
+                /// @return number of bytes read
+                size_t fill();
+
+                /// @return number of bytes decompressed into itsOut, 0 at the end of the data
+                size_t inflateGzip();
+
+                /// @return number of bytes decompressed into itsOut, 0 at the end of the data
+                size_t inflateZstd();
+
+                std::istream& itsSource;
+
+                VOTableCompression::Codec itsCodec;
+
+                /// compressed data
+                std::vector<char> itsIn;
+
+                /// decompressed data
+                std::vector<char> itsOut;
+
+                /// true, if the source has been read to the end
+                bool itsSourceEnd;
+
+                /// gzip decompression state
+                z_stream itsZStream;
+
+                /// true, if the current gzip member has ended
+                bool itsMemberEnd;
+
+#ifdef HAVE_ZSTD
+                /// zstd decompression state
+                ZSTD_DStream* itsZstd;
+
+                /// compressed data not yet consumed by zstd
+                ZSTD_inBuffer itsZstdIn;
+
+                /// last result of ZSTD_decompressStream, 0 if a frame is complete
+                size_t itsZstdHint;
+#endif
+        };
+
+        /// @brief stream buffer compressing the data written to the sink stream
+        class VOTableCompressingBuffer : public std::streambuf {
+            public:
+                VOTableCompressingBuffer(std::ostream& sink, VOTableCompression::Codec codec,
+                                         unsigned int nThreads, int level);
+
+                virtual ~VOTableCompressingBuffer();
+
+                /// @brief compress the rest of the data and end the compressed stream
+                void finish();
+
+            protected:
+                virtual int_type overflow(int_type c);
+
+                /// @brief nothing is flushed before finish, the data are compressed in blocks
+                virtual int sync();
+
+            private:
+                /// @brief pass the filled part of the block to the compressor
+                void submitBlock();
+
+                /// @brief compress the pending gzip blocks in parallel and write them in order
+                void compressPending();
+
+#ifdef HAVE_ZSTD
+                /// @brief compress the data with zstd and write the output
+                void compressZstd(const char* data, size_t size, ZSTD_EndDirective mode);
+#endif
+
+                std::ostream& itsSink;
+
+                VOTableCompression::Codec itsCodec;
+
+                unsigned int itsNThreads;
+
+                int itsLevel;
+
+                /// block being filled
+                std::vector<char> itsBlock;
+
+                /// full gzip blocks waiting to be compressed
+                std::vector<std::string> itsPending;
+
+                /// true, if at least one block has been compressed
+                bool itsStarted;
+
+                /// true, if the compressed stream has been ended
+                bool itsFinished;
+
+#ifdef HAVE_ZSTD
+                /// zstd compression state
+                ZSTD_CCtx* itsZstd;
+
+                /// compressed output
+                std::vector<char> itsZstdOut;
+#endif
+        };
+
+    }
+}
+
+VOTableCompression::Codec VOTableCompression::fromFilename(const std::string& filename)
+{
+    if (filename.size() > 3 && filename.compare(filename.size() - 3, 3, ".gz") == 0) {
+        return GZIP;
+    }
+    if (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".zst") == 0) {
+        return ZSTD;
+    }
+    return NONE;
+}
+
+VOTableCompression::Codec VOTableCompression::detect(const std::string& filename)
+{
+    std::ifstream fs(filename.c_str(), std::ios::binary);
+    ASKAPCHECK(fs, "File " << filename << " could not be opened");
+    unsigned char magic[4] = {0, 0, 0, 0};
+    fs.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    const std::streamsize n = fs.gcount();
+    if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        return GZIP;
+    }
+    if (n == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return ZSTD;
+    }
+    return NONE;
+}
+
+bool VOTableCompression::isSupported(Codec codec)
+{
+#ifdef HAVE_ZSTD
+    return true;
+#else
+    return codec != ZSTD;
+#endif
+}
+
+VOTableDecompressingBuffer::VOTableDecompressingBuffer(std::istream& source,
+        VOTableCompression::Codec codec) :
+    itsSource(source), itsCodec(codec), itsIn(theirInputSize), itsOut(theirOutputSize),
+    itsSourceEnd(false), itsMemberEnd(false)
+{
+    std::memset(&itsZStream, 0, sizeof(itsZStream));
+    if (itsCodec == VOTableCompression::GZIP) {
+        // 15 + 32 detects the gzip header
+        ASKAPCHECK(inflateInit2(&itsZStream, 15 + 32) == Z_OK, "Failed to initialise gzip decompression");
+    }
+#ifdef HAVE_ZSTD
+    itsZstd = 0;
+    itsZstdIn.src = &itsIn[0];
+    itsZstdIn.size = 0;
+    itsZstdIn.pos = 0;
+    itsZstdHint = 0;
+    if (itsCodec == VOTableCompression::ZSTD) {
+        itsZstd = ZSTD_createDStream();
+        ASKAPCHECK(itsZstd, "Failed to initialise zstd decompression");
+        ZSTD_initDStream(itsZstd);
+    }
+#endif
+    setg(&itsOut[0], &itsOut[0], &itsOut[0]);
+}
+
+VOTableDecompressingBuffer::~VOTableDecompressingBuffer()
+{
+    if (itsCodec == VOTableCompression::GZIP) {
+        inflateEnd(&itsZStream);
+    }
+#ifdef HAVE_ZSTD
+    if (itsZstd) {
+        ZSTD_freeDStream(itsZstd);
+    }
+#endif
+}
+
+VOTableDecompressingBuffer::int_type VOTableDecompressingBuffer::underflow()
+{
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+    const size_t n = itsCodec == VOTableCompression::GZIP ? inflateGzip() : inflateZstd();
+    if (n == 0) {
+        return traits_type::eof();
+    }
+    setg(&itsOut[0], &itsOut[0], &itsOut[0] + n);
+    return traits_type::to_int_type(itsOut[0]);
+}
+
+size_t VOTableDecompressingBuffer::fill()
+{
+    itsSource.read(&itsIn[0], itsIn.size());
+    const size_t n = itsSource.gcount();
+    if (n < itsIn.size()) {
+        itsSourceEnd = true;
+    }
+    return n;
+}
+
+size_t VOTableDecompressingBuffer::inflateGzip()
+{
+    for (;;) {
+        if (itsZStream.avail_in == 0 && !itsSourceEnd) {
+            itsZStream.avail_in = fill();
+            itsZStream.next_in = reinterpret_cast<Bytef*>(&itsIn[0]);
+        }
+        if (itsMemberEnd) {
+            if (itsZStream.avail_in == 0) {
+                return 0;
+            }
+            // another gzip member follows
+            ASKAPCHECK(inflateReset(&itsZStream) == Z_OK, "Failed to reset gzip decompression");
+            itsMemberEnd = false;
+        }
+        itsZStream.next_out = reinterpret_cast<Bytef*>(&itsOut[0]);
+        itsZStream.avail_out = itsOut.size();
+        const int ret = inflate(&itsZStream, Z_NO_FLUSH);
+        ASKAPCHECK(ret == Z_OK || ret == Z_STREAM_END || ret == Z_BUF_ERROR,
+                   "gzip decompression failed: " << (itsZStream.msg ? itsZStream.msg : "corrupted data"));
+        if (ret == Z_STREAM_END) {
+            itsMemberEnd = true;
+        }
+        const size_t n = itsOut.size() - itsZStream.avail_out;
+        if (n > 0) {
+            return n;
+        }
+        ASKAPCHECK(itsMemberEnd || itsZStream.avail_in > 0 || !itsSourceEnd, "Truncated gzip data");
+    }
+}
+
+size_t VOTableDecompressingBuffer::inflateZstd()
+{
+#ifdef HAVE_ZSTD
+    for (;;) {
+        if (itsZstdIn.pos == itsZstdIn.size && !itsSourceEnd) {
+            itsZstdIn.size = fill();
+            itsZstdIn.pos = 0;
+        }
+        ZSTD_outBuffer out = {&itsOut[0], itsOut.size(), 0};
+        const size_t ret = ZSTD_decompressStream(itsZstd, &out, &itsZstdIn);
+        ASKAPCHECK(!ZSTD_isError(ret), "zstd decompression failed: " << ZSTD_getErrorName(ret));
+        itsZstdHint = ret;
+        if (out.pos > 0) {
+            return out.pos;
+        }
+        if (itsZstdIn.pos == itsZstdIn.size && itsSourceEnd) {
+            ASKAPCHECK(itsZstdHint == 0, "Truncated zstd data");
+            return 0;
+        }
+    }
+#else
+    ASKAPTHROW(AskapError, "zstd compression is not supported by this build");
+#endif
+}
+
+VOTableCompressingBuffer::VOTableCompressingBuffer(std::ostream& sink, VOTableCompression::Codec codec,
+        unsigned int nThreads, int level) :
+    itsSink(sink), itsCodec(codec), itsNThreads(nThreads), itsLevel(level), itsBlock(theirBlockSize),
+    itsStarted(false), itsFinished(false)
+{
+    if (itsNThreads == 0) {
+        itsNThreads = std::max(1u, boost::thread::hardware_concurrency());
+    }
+    if (itsCodec == VOTableCompression::GZIP && itsLevel < 0) {
+        itsLevel = Z_DEFAULT_COMPRESSION;
+    }
+#ifdef HAVE_ZSTD
+    itsZstd = 0;
+    if (itsCodec == VOTableCompression::ZSTD) {
+        itsZstd = ZSTD_createCCtx();
+        ASKAPCHECK(itsZstd, "Failed to initialise zstd compression");
+        ZSTD_CCtx_setParameter(itsZstd, ZSTD_c_compressionLevel, itsLevel < 0 ? ZSTD_CLEVEL_DEFAULT : itsLevel);
+        if (itsNThreads > 1 && ZSTD_isError(ZSTD_CCtx_setParameter(itsZstd, ZSTD_c_nbWorkers, itsNThreads))) {
+            ASKAPLOG_DEBUG_STR(logger, "zstd library doesn't support multi-threaded compression");
+        }
+        itsZstdOut.resize(ZSTD_CStreamOutSize());
+    }
+#endif
+    setp(&itsBlock[0], &itsBlock[0] + itsBlock.size());
+}
+
+VOTableCompressingBuffer::~VOTableCompressingBuffer()
+{
+#ifdef HAVE_ZSTD
+    if (itsZstd) {
+        ZSTD_freeCCtx(itsZstd);
+    }
+#endif
+}
+
+VOTableCompressingBuffer::int_type VOTableCompressingBuffer::overflow(int_type c)
+{
+    ASKAPCHECK(!itsFinished, "The compressed stream has already been ended");
+    submitBlock();
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int VOTableCompressingBuffer::sync()
+{
+    return 0;
+}
+
+void VOTableCompressingBuffer::submitBlock()
+{
+    const size_t size = pptr() - pbase();
+    if (itsCodec == VOTableCompression::GZIP) {
+        itsPending.push_back(std::string(pbase(), size));
+        if (itsPending.size() >= itsNThreads) {
+            compressPending();
+        }
+    } else {
+#ifdef HAVE_ZSTD
+        compressZstd(pbase(), size, ZSTD_e_continue);
+#endif
+    }
+    setp(&itsBlock[0], &itsBlock[0] + itsBlock.size());
+}
+
+void VOTableCompressingBuffer::compressPending()
+{
+    std::vector<std::string> out(itsPending.size());
+    std::vector<char> ok(itsPending.size(), 0);
+    const size_t nThreads = std::min(static_cast<size_t>(itsNThreads), itsPending.size());
+    if (nThreads <= 1) {
+        gzipBlocks(itsPending, out, ok, 0, 1, itsLevel);
+    } else {
+        boost::thread_group threads;
+        for (size_t t = 0; t < nThreads; ++t) {
+            threads.create_thread(boost::bind(gzipBlocks, boost::cref(itsPending), boost::ref(out),
+                                              boost::ref(ok), t, nThreads, itsLevel));
+        }
+        threads.join_all();
+    }
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASKAPCHECK(ok[i], "gzip compression failed");
+        itsSink.write(out[i].data(), out[i].size());
+    }
+    ASKAPCHECK(itsSink, "Failed to write the compressed data");
+    itsPending.clear();
+    itsStarted = true;
+}
+
+#ifdef HAVE_ZSTD
+void VOTableCompressingBuffer::compressZstd(const char* data, size_t size, ZSTD_EndDirective mode)
+{
+    ZSTD_inBuffer in = {data, size, 0};
+    for (;;) {
+        ZSTD_outBuffer out = {&itsZstdOut[0], itsZstdOut.size(), 0};
+        const size_t ret = ZSTD_compressStream2(itsZstd, &out, &in, mode);
+        ASKAPCHECK(!ZSTD_isError(ret), "zstd compression failed: " << ZSTD_getErrorName(ret));
+        itsSink.write(&itsZstdOut[0], out.pos);
+        // with ZSTD_e_end, zero means the frame is complete
+        if (mode == ZSTD_e_end ? ret == 0 : in.pos == in.size) {
+            break;
+        }
+    }
+    ASKAPCHECK(itsSink, "Failed to write the compressed data");
+}
+#endif
+
+void VOTableCompressingBuffer::finish()
+{
+    if (itsFinished) {
+        return;
+    }
+    const size_t size = pptr() - pbase();
+    if (itsCodec == VOTableCompression::GZIP) {
+        // an empty member is written for empty data, to have a valid gzip file
+        if (size > 0 || !itsStarted) {
+            itsPending.push_back(std::string(pbase(), size));
+        }
+        compressPending();
+    } else {
+#ifdef HAVE_ZSTD
+        compressZstd(pbase(), size, ZSTD_e_end);
+#endif
+    }
+    setp(&itsBlock[0], &itsBlock[0] + itsBlock.size());
+    itsFinished = true;
+    itsSink.flush();
+}
+
+VOTableInputStream::VOTableInputStream(const std::string& filename) :
+    std::istream(0), itsCodec(VOTableCompression::detect(filename))
+{
+    ASKAPCHECK(VOTableCompression::isSupported(itsCodec), "File " << filename <<
+               " is compressed with zstd, which is not supported by this build");
+    itsFile.open(filename.c_str(), std::ios::in | std::ios::binary);
+    ASKAPCHECK(itsFile, "File " << filename << " could not be opened");
+    if (itsCodec == VOTableCompression::NONE) {
+        rdbuf(itsFile.rdbuf());
+    } else {
+        itsBuffer.reset(new VOTableDecompressingBuffer(itsFile, itsCodec));
+        rdbuf(itsBuffer.get());
+        // errors of the decompression (e.g. truncated data) are rethrown by the reads
+        exceptions(std::ios::badbit);
+    }
+}
+
+VOTableInputStream::~VOTableInputStream()
+{
+}
+
+VOTableCompression::Codec VOTableInputStream::getCodec() const
+{
+    return itsCodec;
+}
+
+VOTableOutputStream::VOTableOutputStream(const std::string& filename, unsigned int nThreads, int level) :
+    std::ostream(0), itsCodec(VOTableCompression::fromFilename(filename)), itsClosed(false)
+{
+    ASKAPCHECK(VOTableCompression::isSupported(itsCodec), "zstd compression of " << filename <<
+               " is not supported by this build");
+    itsFile.open(filename.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    ASKAPCHECK(itsFile, "File " << filename << " could not be opened");
+    if (itsCodec == VOTableCompression::NONE) {
+        rdbuf(itsFile.rdbuf());
+    } else {
+        itsBuffer.reset(new VOTableCompressingBuffer(itsFile, itsCodec, nThreads, level));
+        rdbuf(itsBuffer.get());
+    }
+}
+
+VOTableOutputStream::~VOTableOutputStream()
+{
+    if (!itsClosed) {
+        try {
+            close();
+        } catch (const AskapError& e) {
+            ASKAPLOG_ERROR_STR(logger, "Failed to close the VOTable file: " << e.what());
+        }
+    }
+}
+
+void VOTableOutputStream::close()
+{
+    ASKAPCHECK(!itsClosed, "The stream has already been closed");
+    itsClosed = true;
+    flush();
+    if (itsBuffer) {
+        itsBuffer->finish();
+    }
+    itsFile.close();
+    ASKAPCHECK(itsFile && good(), "Failed to write the VOTable file");
+}
+
+VOTableCompression::Codec VOTableOutputStream::getCodec() const
+{
+    return itsCodec;
+}
@@ -0,0 +1,149 @@
+/// @file VOTableStream.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLESTREAM_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLESTREAM_H
+
+// System includes
+#include <string>
+#include <istream>
+#include <ostream>
+#include <fstream>
+
+// ASKAPsoft includes
+#include "boost/scoped_ptr.hpp"
+#include "boost/noncopyable.hpp"
+
+namespace askap {
+    namespace accessors {
+
+        class VOTableDecompressingBuffer;
+        class VOTableCompressingBuffer;
+
+        /// @brief Compression of VOTable files
+        /// @details gzip is always supported, zstd only if the library is built
+        /// with ENABLE_ZSTD.
+        ///
+        /// @ingroup votableaccess
+        class VOTableCompression {
+            public:
+
+                /// @brief compression codec
+                enum Codec { NONE, GZIP, ZSTD };
+
+                /// @return codec implied by the extension of the file name (.gz or .zst)
+                static Codec fromFilename(const std::string& filename);
+
+                /// @return codec detected from the magic number at the start of the file
+                /// @throw AskapError   if the file cannot be opened
+                static Codec detect(const std::string& filename);
+
+                /// @return true if the codec is supported by this build
+                static bool isSupported(Codec codec);
+        };
+
+        /// @brief Input file stream decompressing the file on the fly
+        /// @details The compression is detected from the content of the file, so
+        /// uncompressed files are read as they are. The data are decompressed in
+        /// blocks as they are read, so the whole file is never held in memory.
+        /// Concatenated gzip members and zstd frames are read as one stream.
+        /// Decompression errors are thrown as AskapError by the read operations.
+        ///
+        /// @ingroup votableaccess
+        class VOTableInputStream : public std::istream, private boost::noncopyable {
+            public:
+
+                /// @brief Constructor, opens the file
+                /// @param[in] filename the file/path to read
+                /// @throw AskapError   if the file cannot be opened or the
+                ///                     compression is not supported
+                explicit VOTableInputStream(const std::string& filename);
+
+                /// @brief Destructor
+                ~VOTableInputStream();
+
+                /// @return compression of the file
+                VOTableCompression::Codec getCodec() const;
+
+            private:
+                /// the file
+                std::ifstream itsFile;
+
+                /// decompressing buffer, not used for uncompressed files
+                boost::scoped_ptr<VOTableDecompressingBuffer> itsBuffer;
+
+                /// compression of the file
+                VOTableCompression::Codec itsCodec;
+        };
+
+        /// @brief Output file stream compressing the data on the fly
+        /// @details The compression is chosen from the extension of the file name
+        /// (see VOTableCompression::fromFilename), other files are written as they are.
+        /// gzip data are compressed in blocks of 1 MiB by the given number of threads
+        /// and written as concatenated gzip members, which any gzip reader handles.
+        /// zstd uses the multi-threaded compression of the library, if available.
+        ///
+        /// @ingroup votableaccess
+        class VOTableOutputStream : public std::ostream, private boost::noncopyable {
+            public:
+
+                /// @brief Constructor, creates the file
+                /// @param[in] filename the file/path to write
+                /// @param[in] nThreads number of compression threads, 0 means the number of cores
+                /// @param[in] level compression level, negative for the default of the codec
+                /// @throw AskapError   if the file cannot be opened or the
+                ///                     compression is not supported
+                explicit VOTableOutputStream(const std::string& filename, unsigned int nThreads = 0,
+                                             int level = -1);
+
+                /// @brief Destructor, closes the stream if not yet closed
+                ~VOTableOutputStream();
+
+                /// @brief Compress the rest of the data, end the compressed stream and close the file
+                /// @throw AskapError   if the data couldn't be written
+                void close();
+
+                /// @return compression of the file
+                VOTableCompression::Codec getCodec() const;
+
+            private:
+                /// the file
+                std::ofstream itsFile;
+
+                /// compressing buffer, not used for uncompressed files
+                boost::scoped_ptr<VOTableCompressingBuffer> itsBuffer;
+
+                /// compression of the file
+                VOTableCompression::Codec itsCodec;
+
+                /// true, if the stream has been closed
+                bool itsClosed;
+        };
+
+    }
+}
+
+#endif
@@ -32,7 +32,11 @@
 
 // System includes
 #include <string>
+#include <utility>
 #include <vector>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
 
 // ASKAPsoft includes
 #include <askap/askap/AskapLogging.h>
@@ -44,6 +48,8 @@
 #include "askap/votable/XercescUtils.h"
 #include "askap/votable/VOTableField.h"
 #include "askap/votable/VOTableRow.h"
+#include "askap/votable/VOTableBinary.h"
+#include "askap/votable/VOTableTags.h"
 
 ASKAP_LOGGER(logger, ".VOTableTable");
 
@@ -51,7 +57,7 @@ using namespace askap;
 using namespace askap::accessors;
 using namespace xercesc;
 
-VOTableTable::VOTableTable()
+VOTableTable::VOTableTable() : itsNRows(0), itsDataFormat(TABLEDATA)
 {
 }
 
@@ -85,6 +91,16 @@ std::string VOTableTable::getDescription() const
     return itsDescription;
 }
 
+void VOTableTable::setDataFormat(DataFormat format)
+{
+    itsDataFormat = format;
+}
+
+VOTableTable::DataFormat VOTableTable::getDataFormat() const
+{
+    return itsDataFormat;
+}
+
 void VOTableTable::addGroup(const VOTableGroup& group)
 {
     itsGroups.push_back(group);
@@ -95,41 +111,153 @@ void VOTableTable::addField(const VOTableField& field)
     itsFields.push_back(field);
 }
 
+void VOTableTable::addField(VOTableField&& field)
+{
+    itsFields.push_back(std::move(field));
+}
+
 void VOTableTable::addRow(const VOTableRow& row)
 {
-    itsRows.push_back(row);
+    const std::vector<std::string>& cells = row.getCells();
+    prepareColumns(cells.size());
+    for (size_t c = 0; c < itsColumns.size(); ++c) {
+        itsColumns[c].addCell(c < cells.size() ? cells[c] : std::string());
+    }
+    ++itsNRows;
+}
+
+void VOTableTable::addRow(VOTableRow&& row)
+{
+    std::vector<std::string>& cells = row.getCells();
+    prepareColumns(cells.size());
+    for (size_t c = 0; c < itsColumns.size(); ++c) {
+        itsColumns[c].addCell(c < cells.size() ? std::move(cells[c]) : std::string());
+    }
+    ++itsNRows;
 }
 
-std::vector<VOTableGroup> VOTableTable::getGroups() const
+void VOTableTable::prepareColumns(size_t nCells)
+{
+    if (itsNRows == 0 && itsColumns.empty()) {
+        for (std::vector<VOTableField>::const_iterator it = itsFields.begin();
+                it != itsFields.end(); ++it) {
+            itsColumns.push_back(VOTableColumn(VOTableColumn::typeOf(*it)));
+        }
+    }
+    if (nCells > itsColumns.size()) {
+        // extra cells, the rows added so far become short
+        for (size_t r = 0; r < itsNRows; ++r) {
+            itsShortRows.insert(std::make_pair(r, itsColumns.size()));
+        }
+        while (itsColumns.size() < nCells) {
+            itsColumns.push_back(VOTableColumn());
+            for (size_t r = 0; r < itsNRows; ++r) {
+                itsColumns.back().addCell(std::string());
+            }
+        }
+    }
+    if (nCells < itsColumns.size()) {
+        itsShortRows[itsNRows] = nCells;
+    }
+}
+
+const std::vector<VOTableGroup>& VOTableTable::getGroups() const
 {
     return itsGroups;
 }
 
-std::vector<VOTableField> VOTableTable::getFields() const
+const std::vector<VOTableField>& VOTableTable::getFields() const
 {
     return itsFields;
 }
 
 std::vector<VOTableRow> VOTableTable::getRows() const
 {
-    return itsRows;
+    std::vector<VOTableRow> rows;
+    rows.reserve(itsNRows);
+    for (size_t r = 0; r < itsNRows; ++r) {
+        rows.push_back(getRow(r));
+    }
+    return rows;
+}
+
+size_t VOTableTable::getNRows() const
+{
+    return itsNRows;
+}
+
+VOTableRow VOTableTable::getRow(size_t row) const
+{
+    VOTableRow result;
+    getRow(row, result);
+    return result;
+}
+
+void VOTableTable::getRow(size_t row, VOTableRow& out) const
+{
+    ASKAPCHECK(row < itsNRows, "Row " << row << " is requested, the table has only " << itsNRows);
+    const std::map<size_t, size_t>::const_iterator ci = itsShortRows.find(row);
+    const size_t nCells = ci != itsShortRows.end() ? ci->second : itsColumns.size();
+    out.resize(nCells);
+    for (size_t c = 0; c < nCells; ++c) {
+        out.setCell(c, itsColumns[c].getCell(row));
+    }
+}
+
+size_t VOTableTable::getNColumns() const
+{
+    return itsColumns.size();
+}
+
+const VOTableColumn& VOTableTable::getColumn(size_t column) const
+{
+    ASKAPCHECK(column < itsColumns.size(), "Column " << column << " is requested, the table has only " <<
+               itsColumns.size());
+    return itsColumns[column];
+}
+
+const VOTableColumn& VOTableTable::getColumn(const std::string& name) const
+{
+    for (size_t i = 0; i < itsFields.size(); ++i) {
+        if (itsFields[i].getName() == name) {
+            return getColumn(i);
+        }
+    }
+    ASKAPTHROW(AskapError, "Field " << name << " is not found in the table " << itsName);
+}
+
+void VOTableTable::setColumns(std::vector<VOTableColumn>&& columns)
+{
+    ASKAPCHECK(columns.size() == itsFields.size(), "Got " << columns.size() << " columns for " <<
+               itsFields.size() << " fields of the table " << itsName);
+    const size_t nRows = columns.empty() ? 0 : columns[0].size();
+    for (size_t c = 0; c < columns.size(); ++c) {
+        ASKAPCHECK(columns[c].size() == nRows, "Column " << c << " has " << columns[c].size() <<
+                   " cells, column 0 has " << nRows);
+        ASKAPCHECK(columns[c].getType() == VOTableColumn::typeOf(itsFields[c]), "Type of column " << c <<
+                   " doesn't match the datatype " << itsFields[c].getDatatype() << " of field " <<
+                   itsFields[c].getName());
+    }
+    itsColumns = std::move(columns);
+    itsNRows = nRows;
+    itsShortRows.clear();
 }
 
 xercesc::DOMElement* VOTableTable::toXmlElement(xercesc::DOMDocument& doc) const
 {
-    DOMElement* e = doc.createElement(XercescString("TABLE"));
+    DOMElement* e = doc.createElement(VOTableTags::TABLE);
 
     // Add attributes
     if (itsID.length()) {
-        e->setAttribute(XercescString("ID"), XercescString(itsID));
+        e->setAttribute(VOTableTags::ATTR_ID, XercescString(itsID));
     }
     if (itsName.length() > 0) {
-        e->setAttribute(XercescString("name"), XercescString(itsName));
+        e->setAttribute(VOTableTags::ATTR_NAME, XercescString(itsName));
     }
 
     // Create DESCRIPTION element
     if (itsDescription.length() > 0) {
-        DOMElement* descElement = doc.createElement(XercescString("DESCRIPTION"));
+        DOMElement* descElement = doc.createElement(VOTableTags::DESCRIPTION);
         DOMText* text = doc.createTextNode(XercescString(itsDescription));
         descElement->appendChild(text);
         e->appendChild(descElement);
@@ -148,17 +276,39 @@ xercesc::DOMElement* VOTableTable::toXmlElement(xercesc::DOMDocument& doc) const
     }
 
     // Create DATA element
-    DOMElement* dataElement = doc.createElement(XercescString("DATA"));
+    DOMElement* dataElement = doc.createElement(VOTableTags::DATA);
     e->appendChild(dataElement);
 
+    if (itsDataFormat != TABLEDATA) {
+        // Create BINARY or BINARY2 element with the base64 encoded STREAM
+        const bool binary2 = itsDataFormat == BINARY2;
+        DOMElement* binaryElement = doc.createElement(binary2 ? VOTableTags::BINARY2 : VOTableTags::BINARY);
+        dataElement->appendChild(binaryElement);
+        const VOTableBinary codec(itsFields, binary2);
+        std::string raw;
+        VOTableRow row;
+        for (size_t r = 0; r < itsNRows; ++r) {
+            getRow(r, row);
+            codec.encodeRow(row, raw);
+        }
+        // 76 characters per line
+        std::string encoded("\n");
+        for (size_t pos = 0; pos < raw.size(); pos += 57) {
+            encoded += VOTableBinary::base64Encode(raw.data() + pos, std::min<size_t>(57, raw.size() - pos));
+            encoded += "\n";
+        }
+        DOMElement* streamElement = XercescUtils::addTextElement(*binaryElement, VOTableTags::STREAM, encoded);
+        streamElement->setAttribute(VOTableTags::ATTR_ENCODING, XercescString("base64"));
+        return e;
+    }
+
     // Create TABLEDATA element
-    DOMElement* tableDataElement = doc.createElement(XercescString("TABLEDATA"));
+    DOMElement* tableDataElement = doc.createElement(VOTableTags::TABLEDATA);
     dataElement->appendChild(tableDataElement);
 
     // Add rows
-    for (std::vector<VOTableRow>::const_iterator it = itsRows.begin();
-            it != itsRows.end(); ++it) {
-        tableDataElement->appendChild(it->toXmlElement(doc));
+    for (size_t r = 0; r < itsNRows; ++r) {
+        tableDataElement->appendChild(getRow(r).toXmlElement(doc));
     }
 
     return e;
@@ -169,14 +319,14 @@ VOTableTable VOTableTable::fromXmlElement(const xercesc::DOMElement& e)
     VOTableTable tab;
 
     // Get attributes
-    tab.setID(XercescUtils::getAttribute(e, "ID"));
-    tab.setName(XercescUtils::getAttribute(e, "name"));
+    tab.setID(XercescUtils::getAttribute(e, VOTableTags::ATTR_ID));
+    tab.setName(XercescUtils::getAttribute(e, VOTableTags::ATTR_NAME));
 
     // Get description
     tab.setDescription(XercescUtils::getDescription(e));
 
     // Process GROUP
-    DOMNodeList* children = e.getElementsByTagName(XercescString("GROUP"));
+    DOMNodeList* children = e.getElementsByTagName(VOTableTags::GROUP);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         const VOTableGroup group = VOTableGroup::fromXmlElement(*node);
@@ -184,30 +334,38 @@ VOTableTable VOTableTable::fromXmlElement(const xercesc::DOMElement& e)
     }
 
     // Process FIELD
-    children = e.getElementsByTagName(XercescString("FIELD"));
+    children = e.getElementsByTagName(VOTableTags::FIELD);
     for (XMLSize_t i = 0; i < children->getLength(); ++i) {
         const DOMElement* node = dynamic_cast<xercesc::DOMElement*>(children->item(i));
-        const VOTableField field = VOTableField::fromXmlElement(*node);
-        tab.addField(field);
+        tab.addField(VOTableField::fromXmlElement(*node));
     }
 
     // Process DATA
-    const DOMNodeList* dataNodes = e.getElementsByTagName(XercescString("DATA"));
+    const DOMNodeList* dataNodes = e.getElementsByTagName(VOTableTags::DATA);
     for (XMLSize_t i = 0; i < dataNodes->getLength(); ++i) {
         const DOMElement* dataNode = dynamic_cast<xercesc::DOMElement*>(dataNodes->item(i));
-        
+
+        // Process BINARY and BINARY2
+        for (int binary2 = 0; binary2 < 2; ++binary2) {
+            const DOMElement* binaryNode = XercescUtils::getFirstElementByTagName(*dataNode,
+                    binary2 ? VOTableTags::BINARY2 : VOTableTags::BINARY);
+            if (binaryNode) {
+                tab.setDataFormat(binary2 ? BINARY2 : BINARY);
+                readBinary(*binaryNode, binary2, tab);
+            }
+        }
+
         // Process TABLEDATA
-        const DOMNodeList* tableDataNodes = dataNode->getElementsByTagName(XercescString("TABLEDATA"));
+        const DOMNodeList* tableDataNodes = dataNode->getElementsByTagName(VOTableTags::TABLEDATA);
         for (XMLSize_t j = 0; j < tableDataNodes->getLength(); ++j) {
             const DOMElement* tableDataNode = dynamic_cast<xercesc::DOMElement*>(tableDataNodes->item(j));
 
             // Process TR
-            const DOMNodeList* rowNodes = tableDataNode->getElementsByTagName(XercescString("TR"));
+            const DOMNodeList* rowNodes = tableDataNode->getElementsByTagName(VOTableTags::TR);
             const XMLSize_t nRows = rowNodes->getLength();
             for (XMLSize_t k = 0; k < nRows; ++k) {
                 const DOMElement* rowNode = dynamic_cast<xercesc::DOMElement*>(rowNodes->item(k));
-                const VOTableRow row = VOTableRow::fromXmlElement(*rowNode);
-                tab.addRow(row);
+                tab.addRow(VOTableRow::fromXmlElement(*rowNode));
             }
 
         }
@@ -215,3 +373,44 @@ VOTableTable VOTableTable::fromXmlElement(const xercesc::DOMElement& e)
 
     return tab;
 }
+
+void VOTableTable::readBinary(const xercesc::DOMElement& e, bool binary2, VOTableTable& tab)
+{
+    const DOMElement* streamNode = XercescUtils::getFirstElementByTagName(e, VOTableTags::STREAM);
+    ASKAPCHECK(streamNode, "BINARY element of the table " << tab.getName() << " has no STREAM");
+    const std::string encoding = XercescUtils::getAttribute(*streamNode, VOTableTags::ATTR_ENCODING);
+    ASKAPCHECK(encoding.empty() || encoding == "base64", "Unsupported STREAM encoding " << encoding);
+    const std::string href = XercescUtils::getAttribute(*streamNode, VOTableTags::ATTR_HREF);
+
+    // Get the raw bytes, either inline or from the external file
+    std::string raw;
+    if (href.empty()) {
+        ASKAPCHECK(encoding == "base64", "Inline STREAM has to be base64 encoded");
+        const DOMText* text = dynamic_cast<xercesc::DOMText*>(streamNode->getFirstChild());
+        if (text) {
+            const std::string encoded = XercescUtils::getStringFromDOMText(*text);
+            std::string pending;
+            VOTableBinary::base64Decode(encoded.data(), encoded.size(), pending, raw);
+        }
+    } else {
+        const std::string path = VOTableBinary::hrefToPath(href);
+        std::ifstream fs(path.c_str(), std::ios::binary);
+        ASKAPCHECK(fs, "File " << path << " of the external STREAM could not be opened");
+        const std::string content((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+        if (encoding == "base64") {
+            std::string pending;
+            VOTableBinary::base64Decode(content.data(), content.size(), pending, raw);
+        } else {
+            raw = content;
+        }
+    }
+
+    VOTableBinary codec(tab.getFields(), binary2);
+    codec.appendData(raw.data(), raw.size());
+    VOTableRow row;
+    while (codec.nextRow(row)) {
+        tab.addRow(std::move(row));
+    }
+    ASKAPCHECK(!codec.hasPartialRow(), "Incomplete row at the end of the binary STREAM of the table " <<
+               tab.getName());
+}
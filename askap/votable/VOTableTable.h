@@ -30,6 +30,7 @@
 // System includes
 #include <string>
 #include <vector>
+#include <map>
 
 // ASKAPsoft includes
 #include "xercesc/dom/DOM.hpp" // Includes all DOM
@@ -38,16 +39,31 @@
 #include "askap/votable/VOTableField.h"
 #include "askap/votable/VOTableRow.h"
 #include "askap/votable/VOTableGroup.h"
+#include "askap/votable/VOTableColumn.h"
 
 namespace askap {
     namespace accessors {
 
         /// @brief Encapsulates the TABLE element
+        /// @details The rows are stored by column (see VOTableColumn), the storage type
+        /// of each column is chosen from the datatype of the corresponding field when
+        /// the first row is added. Cells beyond the fields defined at that time are
+        /// stored as strings. The rows are assembled on request.
         ///
         /// @ingroup votableaccess
         class VOTableTable {
             public:
 
+                /// @brief serialisation of the table data
+                enum DataFormat {
+                    /// rows as TR/TD elements
+                    TABLEDATA,
+                    /// base64 encoded binary stream
+                    BINARY,
+                    /// base64 encoded binary stream with null flags
+                    BINARY2
+                };
+
                 /// @brief Constructor
                 VOTableTable();
 
@@ -60,26 +76,75 @@ namespace askap {
                 void setDescription(const std::string& description);
                 std::string getDescription() const;
 
+                /// @brief set the serialisation used by toXmlElement, TABLEDATA by default
+                void setDataFormat(DataFormat format);
+                DataFormat getDataFormat() const;
+
                 void addGroup(const VOTableGroup& group);
                 void addField(const VOTableField& field);
+                void addField(VOTableField&& field);
                 void addRow(const VOTableRow& row);
 
-                std::vector<VOTableGroup> getGroups() const;
-                std::vector<VOTableField> getFields() const;
+                /// @brief add a row, the cells of string columns are moved from the row
+                void addRow(VOTableRow&& row);
+
+                const std::vector<VOTableGroup>& getGroups() const;
+                const std::vector<VOTableField>& getFields() const;
                 std::vector<VOTableRow> getRows() const;
 
+                /// @return number of rows
+                size_t getNRows() const;
+
+                /// @return the given row, assembled from the columns
+                VOTableRow getRow(size_t row) const;
+
+                /// @brief assemble the given row reusing the storage of the output row
+                /// @details This is the cheapest way to iterate over the rows.
+                /// @param[in] row row index
+                /// @param[out] out row to fill
+                void getRow(size_t row, VOTableRow& out) const;
+
+                /// @return number of columns with data
+                size_t getNColumns() const;
+
+                /// @return typed storage of the given column
+                const VOTableColumn& getColumn(size_t column) const;
+
+                /// @return typed storage of the column of the field with the given name
+                /// @throw AskapError   if there is no such field
+                const VOTableColumn& getColumn(const std::string& name) const;
+
+                /// @brief replace all rows by the given columns
+                /// @details This is the way to fill the table from typed data without
+                /// converting it to text first (see VOTableArrow).
+                /// @param[in] columns one column per field, all of the same size and of the
+                ///            type given by VOTableColumn::typeOf for the field
+                /// @throw AskapError   if the columns don't match the fields
+                void setColumns(std::vector<VOTableColumn>&& columns);
+
                 xercesc::DOMElement* toXmlElement(xercesc::DOMDocument& doc) const;
 
                 static VOTableTable fromXmlElement(const xercesc::DOMElement& e);
 
             private:
 
+                /// @brief create columns for the fields if this is the first row and add
+                ///        columns for the extra cells
+                void prepareColumns(size_t nCells);
+
+                /// @brief decode the STREAM of a BINARY or BINARY2 element into the rows of the table
+                static void readBinary(const xercesc::DOMElement& e, bool binary2, VOTableTable& tab);
+
                 std::string itsDescription;
                 std::string itsName;
                 std::string itsID;
                 std::vector<VOTableGroup> itsGroups;
                 std::vector<VOTableField> itsFields;
-                std::vector<VOTableRow> itsRows;
+                std::vector<VOTableColumn> itsColumns;
+                size_t itsNRows;
+                /// number of cells of the rows shorter than the number of columns
+                std::map<size_t, size_t> itsShortRows;
+                DataFormat itsDataFormat;
         };
 
     }
@@ -0,0 +1,66 @@
+/// @file VOTableTags.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// Include own header file first
+#include "VOTableTags.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+using namespace askap::accessors;
+
+const XercescLiteral VOTableTags::VOTABLE("VOTABLE");
+const XercescLiteral VOTableTags::RESOURCE("RESOURCE");
+const XercescLiteral VOTableTags::TABLE("TABLE");
+const XercescLiteral VOTableTags::FIELD("FIELD");
+const XercescLiteral VOTableTags::PARAM("PARAM");
+const XercescLiteral VOTableTags::GROUP("GROUP");
+const XercescLiteral VOTableTags::INFO("INFO");
+const XercescLiteral VOTableTags::DESCRIPTION("DESCRIPTION");
+const XercescLiteral VOTableTags::DATA("DATA");
+const XercescLiteral VOTableTags::TABLEDATA("TABLEDATA");
+const XercescLiteral VOTableTags::TR("TR");
+const XercescLiteral VOTableTags::TD("TD");
+const XercescLiteral VOTableTags::BINARY("BINARY");
+const XercescLiteral VOTableTags::BINARY2("BINARY2");
+const XercescLiteral VOTableTags::STREAM("STREAM");
+const XercescLiteral VOTableTags::FIELDref("FIELDref");
+const XercescLiteral VOTableTags::PARAMref("PARAMref");
+
+const XercescLiteral VOTableTags::ATTR_ID("ID");
+const XercescLiteral VOTableTags::ATTR_NAME("name");
+const XercescLiteral VOTableTags::ATTR_UCD("ucd");
+const XercescLiteral VOTableTags::ATTR_UNIT("unit");
+const XercescLiteral VOTableTags::ATTR_DATATYPE("datatype");
+const XercescLiteral VOTableTags::ATTR_ARRAYSIZE("arraysize");
+const XercescLiteral VOTableTags::ATTR_UTYPE("utype");
+const XercescLiteral VOTableTags::ATTR_REF("ref");
+const XercescLiteral VOTableTags::ATTR_VALUE("value");
+const XercescLiteral VOTableTags::ATTR_TYPE("type");
+const XercescLiteral VOTableTags::ATTR_ENCODING("encoding");
+const XercescLiteral VOTableTags::ATTR_HREF("href");
+const XercescLiteral VOTableTags::ATTR_VERSION("version");
+const XercescLiteral VOTableTags::ATTR_XMLNS("xmlns");
@@ -0,0 +1,87 @@
+/// @file VOTableTags.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLETAGS_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLETAGS_H
+
+// Local package includes
+#include "askap/votable/XercescString.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Element and attribute names of the VOTable vocabulary
+        /// @details The names are converted to XMLCh once, at static initialisation,
+        /// and can be passed to Xerces wherever a tag or an attribute name is expected
+        /// instead of creating an XercescString every time.
+        ///
+        /// @ingroup votableaccess
+        class VOTableTags {
+            public:
+                /// @name Element names
+                /// @{
+                static const XercescLiteral VOTABLE;
+                static const XercescLiteral RESOURCE;
+                static const XercescLiteral TABLE;
+                static const XercescLiteral FIELD;
+                static const XercescLiteral PARAM;
+                static const XercescLiteral GROUP;
+                static const XercescLiteral INFO;
+                static const XercescLiteral DESCRIPTION;
+                static const XercescLiteral DATA;
+                static const XercescLiteral TABLEDATA;
+                static const XercescLiteral TR;
+                static const XercescLiteral TD;
+                static const XercescLiteral BINARY;
+                static const XercescLiteral BINARY2;
+                static const XercescLiteral STREAM;
+                static const XercescLiteral FIELDref;
+                static const XercescLiteral PARAMref;
+                /// @}
+
+                /// @name Attribute names
+                /// @{
+                static const XercescLiteral ATTR_ID;
+                static const XercescLiteral ATTR_NAME;
+                static const XercescLiteral ATTR_UCD;
+                static const XercescLiteral ATTR_UNIT;
+                static const XercescLiteral ATTR_DATATYPE;
+                static const XercescLiteral ATTR_ARRAYSIZE;
+                static const XercescLiteral ATTR_UTYPE;
+                static const XercescLiteral ATTR_REF;
+                static const XercescLiteral ATTR_VALUE;
+                static const XercescLiteral ATTR_TYPE;
+                static const XercescLiteral ATTR_ENCODING;
+                static const XercescLiteral ATTR_HREF;
+                static const XercescLiteral ATTR_VERSION;
+                static const XercescLiteral ATTR_XMLNS;
+                /// @}
+        };
+
+    }
+}
+
+#endif
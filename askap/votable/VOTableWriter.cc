@@ -0,0 +1,359 @@
+/// @file VOTableWriter.cc
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+// Include own header file first
+#include "VOTableWriter.h"
+
+// Include package level header file
+#include "askap_accessors.h"
+
+// System includes
+#include <string>
+#include <vector>
+#include <ostream>
+#include <fstream>
+
+// ASKAPsoft includes
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+
+ASKAP_LOGGER(logger, ".VOTableWriter");
+
+using namespace askap;
+using namespace askap::accessors;
+
+VOTableWriter::VOTableWriter(std::ostream& os, const std::string& description) :
+    itsStream(os), itsInResource(false), itsInTable(false), itsClosed(false), itsRowCount(0)
+{
+    writeHeader(description);
+}
+
+VOTableWriter::VOTableWriter(const std::string& filename, const std::string& description) :
+    itsFile(new VOTableOutputStream(filename)), itsStream(*itsFile),
+    itsInResource(false), itsInTable(false), itsClosed(false), itsRowCount(0)
+{
+    writeHeader(description);
+}
+
+VOTableWriter::~VOTableWriter()
+{
+    if (!itsClosed) {
+        try {
+            close();
+        } catch (const AskapError& e) {
+            ASKAPLOG_ERROR_STR(logger, "Failed to close the VOTable: " << e.what());
+        }
+    }
+}
+
+void VOTableWriter::addInfo(const VOTableInfo& info)
+{
+    ASKAPCHECK(!itsClosed, "The VOTable has already been closed");
+    ASKAPCHECK(!itsInTable, "INFO can't be written inside a TABLE");
+    writeInfo(info, itsInResource ? 2 : 1);
+    checkStream();
+}
+
+void VOTableWriter::beginResource(const VOTableResource& resource)
+{
+    ASKAPCHECK(!itsClosed, "The VOTable has already been closed");
+    ASKAPCHECK(!itsInResource, "Nested RESOURCE elements are not supported");
+    indent(1) << "<RESOURCE";
+    writeAttribute("ID", resource.getID());
+    writeAttribute("name", resource.getName());
+    writeAttribute("type", resource.getType());
+    itsStream << ">\n";
+    writeDescription(resource.getDescription(), 2);
+    const std::vector<VOTableInfo>& info = resource.getInfo();
+    for (std::vector<VOTableInfo>::const_iterator it = info.begin();
+            it != info.end(); ++it) {
+        writeInfo(*it, 2);
+    }
+    itsInResource = true;
+    checkStream();
+}
+
+void VOTableWriter::beginTable(const VOTableTable& table)
+{
+    ASKAPCHECK(itsInResource, "TABLE has to be written inside a RESOURCE");
+    ASKAPCHECK(!itsInTable, "Nested TABLE elements are not supported");
+    indent(2) << "<TABLE";
+    writeAttribute("ID", table.getID());
+    writeAttribute("name", table.getName());
+    itsStream << ">\n";
+    writeDescription(table.getDescription(), 3);
+
+    const std::vector<VOTableGroup>& groups = table.getGroups();
+    for (std::vector<VOTableGroup>::const_iterator it = groups.begin();
+            it != groups.end(); ++it) {
+        writeGroup(*it, 3);
+    }
+    const std::vector<VOTableField>& fields = table.getFields();
+    for (std::vector<VOTableField>::const_iterator it = fields.begin();
+            it != fields.end(); ++it) {
+        writeField(*it, 3);
+    }
+
+    indent(3) << "<DATA>\n";
+    if (table.getDataFormat() == VOTableTable::TABLEDATA) {
+        indent(4) << "<TABLEDATA>\n";
+    } else {
+        const bool binary2 = table.getDataFormat() == VOTableTable::BINARY2;
+        itsBinaryElement = binary2 ? "BINARY2" : "BINARY";
+        itsBinary.reset(new VOTableBinary(fields, binary2));
+        itsBinaryPending.clear();
+        indent(4) << "<" << itsBinaryElement << ">\n";
+        indent(5) << "<STREAM encoding=\"base64\">\n";
+    }
+    itsInTable = true;
+
+    VOTableRow row;
+    for (size_t r = 0; r < table.getNRows(); ++r) {
+        table.getRow(r, row);
+        addRow(row);
+    }
+    checkStream();
+}
+
+void VOTableWriter::addRow(const VOTableRow& row)
+{
+    ASKAPCHECK(itsInTable, "TR has to be written inside a TABLE");
+    if (itsBinary) {
+        itsBinary->encodeRow(row, itsBinaryPending);
+        writeBinary(false);
+        ++itsRowCount;
+        return;
+    }
+    const std::vector<std::string>& cells = row.getCells();
+    indent(5) << "<TR>";
+    for (std::vector<std::string>::const_iterator it = cells.begin();
+            it != cells.end(); ++it) {
+        itsStream << "<TD>" << escape(*it) << "</TD>";
+    }
+    itsStream << "</TR>\n";
+    ++itsRowCount;
+}
+
+void VOTableWriter::endTable()
+{
+    ASKAPCHECK(itsInTable, "There is no open TABLE to close");
+    if (itsBinary) {
+        writeBinary(true);
+        indent(5) << "</STREAM>\n";
+        indent(4) << "</" << itsBinaryElement << ">\n";
+        itsBinary.reset();
+    } else {
+        indent(4) << "</TABLEDATA>\n";
+    }
+    indent(3) << "</DATA>\n";
+    indent(2) << "</TABLE>\n";
+    itsInTable = false;
+    checkStream();
+}
+
+void VOTableWriter::endResource()
+{
+    ASKAPCHECK(itsInResource, "There is no open RESOURCE to close");
+    if (itsInTable) {
+        endTable();
+    }
+    indent(1) << "</RESOURCE>\n";
+    itsInResource = false;
+    checkStream();
+}
+
+void VOTableWriter::close()
+{
+    ASKAPCHECK(!itsClosed, "The VOTable has already been closed");
+    if (itsInResource) {
+        endResource();
+    }
+    itsStream << "</VOTABLE>\n";
+    itsStream.flush();
+    itsClosed = true;
+    if (itsFile) {
+        itsFile->close();
+    }
+    checkStream();
+}
+
+size_t VOTableWriter::rowCount() const
+{
+    return itsRowCount;
+}
+
+std::string VOTableWriter::escape(const std::string& str)
+{
+    if (str.find_first_of("&<>\"'") == std::string::npos) {
+        return str;
+    }
+    std::string result;
+    result.reserve(str.size() + 16);
+    for (std::string::const_iterator it = str.begin(); it != str.end(); ++it) {
+        switch (*it) {
+            case '&': result += "&amp;"; break;
+            case '<': result += "&lt;"; break;
+            case '>': result += "&gt;"; break;
+            case '"': result += "&quot;"; break;
+            case '\'': result += "&apos;"; break;
+            default: result += *it;
+        }
+    }
+    return result;
+}
+
+void VOTableWriter::writeHeader(const std::string& description)
+{
+    // Same root element as written by VOTable::toXML
+    itsStream << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\" ?>\n";
+    itsStream << "<VOTABLE version=\"1.2\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\""
+              << " xmlns=\"http://www.ivoa.net/xml/VOTable/v1.2\""
+              << " xmlns:stc=\"http://www.ivoa.net/xml/STC/v1.30\">\n";
+    writeDescription(description, 1);
+    checkStream();
+}
+
+void VOTableWriter::writeAttribute(const std::string& key, const std::string& value)
+{
+    if (value.length() > 0) {
+        itsStream << " " << key << "=\"" << escape(value) << "\"";
+    }
+}
+
+void VOTableWriter::writeDescription(const std::string& description, int level)
+{
+    if (description.length() > 0) {
+        indent(level) << "<DESCRIPTION>" << escape(description) << "</DESCRIPTION>\n";
+    }
+}
+
+void VOTableWriter::writeInfo(const VOTableInfo& info, int level)
+{
+    indent(level) << "<INFO";
+    writeAttribute("ID", info.getID());
+    writeAttribute("name", info.getName());
+    writeAttribute("value", info.getValue());
+    itsStream << ">" << escape(info.getText()) << "</INFO>\n";
+}
+
+void VOTableWriter::writeGroup(const VOTableGroup& group, int level)
+{
+    indent(level) << "<GROUP";
+    writeAttribute("name", group.getName());
+    writeAttribute("ID", group.getID());
+    writeAttribute("ucd", group.getUCD());
+    writeAttribute("utype", group.getUType());
+    writeAttribute("ref", group.getRef());
+    itsStream << ">\n";
+    writeDescription(group.getDescription(), level + 1);
+
+    const std::vector<VOTableParam>& params = group.getParams();
+    for (std::vector<VOTableParam>::const_iterator it = params.begin();
+            it != params.end(); ++it) {
+        writeParam(*it, level + 1);
+    }
+    const std::vector<std::string>& fieldRefs = group.getFieldRefs();
+    for (std::vector<std::string>::const_iterator it = fieldRefs.begin();
+            it != fieldRefs.end(); ++it) {
+        indent(level + 1) << "<FIELDref ref=\"" << escape(*it) << "\"/>\n";
+    }
+    const std::vector<std::string>& paramRefs = group.getParamRefs();
+    for (std::vector<std::string>::const_iterator it = paramRefs.begin();
+            it != paramRefs.end(); ++it) {
+        indent(level + 1) << "<PARAMref ref=\"" << escape(*it) << "\"/>\n";
+    }
+    indent(level) << "</GROUP>\n";
+}
+
+void VOTableWriter::writeParam(const VOTableParam& param, int level)
+{
+    indent(level) << "<PARAM";
+    writeAttribute("name", param.getName());
+    writeAttribute("ID", param.getID());
+    writeAttribute("datatype", param.getDatatype());
+    writeAttribute("arraysize", param.getArraysize());
+    writeAttribute("unit", param.getUnit());
+    writeAttribute("ucd", param.getUCD());
+    writeAttribute("utype", param.getUType());
+    writeAttribute("ref", param.getRef());
+    writeAttribute("value", param.getValue());
+    if (param.getDescription().length() > 0) {
+        itsStream << ">\n";
+        writeDescription(param.getDescription(), level + 1);
+        indent(level) << "</PARAM>\n";
+    } else {
+        itsStream << "/>\n";
+    }
+}
+
+void VOTableWriter::writeField(const VOTableField& field, int level)
+{
+    indent(level) << "<FIELD";
+    writeAttribute("name", field.getName());
+    writeAttribute("ID", field.getID());
+    writeAttribute("datatype", field.getDatatype());
+    writeAttribute("arraysize", field.getArraysize());
+    writeAttribute("unit", field.getUnit());
+    writeAttribute("ucd", field.getUCD());
+    writeAttribute("utype", field.getUType());
+    writeAttribute("ref", field.getRef());
+    if (field.getDescription().length() > 0) {
+        itsStream << ">\n";
+        writeDescription(field.getDescription(), level + 1);
+        indent(level) << "</FIELD>\n";
+    } else {
+        itsStream << "/>\n";
+    }
+}
+
+std::ostream& VOTableWriter::indent(int level)
+{
+    for (int i = 0; i < level; ++i) {
+        itsStream << "  ";
+    }
+    return itsStream;
+}
+
+void VOTableWriter::writeBinary(bool final)
+{
+    // 57 bytes give a line of 76 base64 characters
+    const size_t lineBytes = 57;
+    size_t pos = 0;
+    for (; pos + lineBytes <= itsBinaryPending.size(); pos += lineBytes) {
+        itsStream << VOTableBinary::base64Encode(itsBinaryPending.data() + pos, lineBytes) << "\n";
+    }
+    if (final && pos < itsBinaryPending.size()) {
+        itsStream << VOTableBinary::base64Encode(itsBinaryPending.data() + pos,
+                                                 itsBinaryPending.size() - pos) << "\n";
+        pos = itsBinaryPending.size();
+    }
+    itsBinaryPending.erase(0, pos);
+}
+
+void VOTableWriter::checkStream() const
+{
+    ASKAPCHECK(itsStream.good(), "Error writing the VOTable");
+}
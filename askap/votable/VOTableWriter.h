@@ -0,0 +1,181 @@
+/// @file VOTableWriter.h
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef ASKAP_ACCESSORS_VOTABLE_VOTABLEWRITER_H
+#define ASKAP_ACCESSORS_VOTABLE_VOTABLEWRITER_H
+
+// System includes
+#include <string>
+#include <ostream>
+#include <fstream>
+
+// ASKAPsoft includes
+#include "boost/scoped_ptr.hpp"
+#include "boost/noncopyable.hpp"
+
+// Local package includes
+#include "askap/votable/VOTableInfo.h"
+#include "askap/votable/VOTableResource.h"
+#include "askap/votable/VOTableField.h"
+#include "askap/votable/VOTableParam.h"
+#include "askap/votable/VOTableRow.h"
+#include "askap/votable/VOTableTable.h"
+#include "askap/votable/VOTableGroup.h"
+#include "askap/votable/VOTableBinary.h"
+#include "askap/votable/VOTableStream.h"
+
+namespace askap {
+    namespace accessors {
+
+        /// @brief Streaming writer of XML VOTables
+        /// @details VOTable::toXML builds the DOM tree for the whole VOTable before
+        /// it is serialised, so the complete table has to be held in memory twice.
+        /// This writer emits the XML directly to the stream as the elements are
+        /// given, so the producer can push rows one by one and the memory footprint
+        /// doesn't depend on the size of the table. The layout of the output is:
+        /// @code
+        /// VOTableWriter writer(os, "description");
+        /// writer.beginResource(resource);   // attributes, description and INFO
+        /// writer.beginTable(table);         // description, groups, fields (and rows if any)
+        /// writer.addRow(row);               // as many times as necessary
+        /// writer.endTable();
+        /// writer.endResource();
+        /// writer.close();                   // also called by the destructor
+        /// @endcode
+        /// Any open elements are closed by endResource and close as necessary.
+        /// The rows are written as TABLEDATA or as a base64 encoded BINARY or BINARY2
+        /// stream depending on VOTableTable::getDataFormat of the table given to beginTable.
+        ///
+        /// @ingroup votableaccess
+        class VOTableWriter : private boost::noncopyable {
+            public:
+
+                /// @brief Constructor, writes the header of the VOTable
+                /// @param[in] os   an ostream to which the XML output string
+                ///                 will be written.
+                /// @param[in] description text of the DESCRIPTION element (not written if empty)
+                explicit VOTableWriter(std::ostream& os, const std::string& description = "");
+
+                /// @brief Constructor, writes the header of the VOTable
+                /// @param[in] filename the file/path to write the XML output to,
+                ///                     compressed if it ends with .gz or .zst
+                ///                     (see VOTableOutputStream).
+                /// @param[in] description text of the DESCRIPTION element (not written if empty)
+                /// @throw AskapError   if the specified file cannot be opened.
+                explicit VOTableWriter(const std::string& filename, const std::string& description = "");
+
+                /// @brief Destructor, closes all open elements
+                ~VOTableWriter();
+
+                /// Write an INFO element to the VOTable or the current RESOURCE
+                void addInfo(const VOTableInfo& info);
+
+                /// Open a RESOURCE element
+                /// @details The attributes, description and INFO elements of the
+                /// given resource are written, its tables are ignored.
+                void beginResource(const VOTableResource& resource);
+
+                /// Open a TABLE element in the current RESOURCE
+                /// @details The attributes, description, groups and fields of the given
+                /// table are written followed by its rows, if any.
+                void beginTable(const VOTableTable& table);
+
+                /// Write a TR element to the current TABLE
+                void addRow(const VOTableRow& row);
+
+                /// Close the current TABLE element
+                void endTable();
+
+                /// Close the current RESOURCE element (and TABLE, if open)
+                void endResource();
+
+                /// Close all open elements and flush the stream
+                /// @details Nothing can be written after this call.
+                void close();
+
+                /// @return number of rows written so far
+                size_t rowCount() const;
+
+                /// Escape the XML special characters
+                static std::string escape(const std::string& str);
+
+            private:
+
+                /// Write the header of the VOTable
+                void writeHeader(const std::string& description);
+
+                /// Write an attribute, nothing is written if the value is empty
+                void writeAttribute(const std::string& key, const std::string& value);
+
+                /// Write a DESCRIPTION element, nothing is written if the text is empty
+                void writeDescription(const std::string& description, int level);
+
+                void writeInfo(const VOTableInfo& info, int level);
+                void writeGroup(const VOTableGroup& group, int level);
+                void writeParam(const VOTableParam& param, int level);
+                void writeField(const VOTableField& field, int level);
+
+                /// Start a line with the given indentation level
+                std::ostream& indent(int level);
+
+                /// Check the state of the stream
+                void checkStream() const;
+
+                /// Write the encoded binary data, incomplete lines are kept unless final is true
+                void writeBinary(bool final);
+
+                /// Output file, if the writer was given the file name
+                boost::scoped_ptr<VOTableOutputStream> itsFile;
+
+                /// Stream the XML is written to
+                std::ostream& itsStream;
+
+                /// True, if a RESOURCE element is open
+                bool itsInResource;
+
+                /// True, if a TABLE element is open
+                bool itsInTable;
+
+                /// True, if the VOTable has been closed
+                bool itsClosed;
+
+                /// Number of rows written
+                size_t itsRowCount;
+
+                /// Encoder of the current table, empty for TABLEDATA
+                boost::scoped_ptr<VOTableBinary> itsBinary;
+
+                /// Raw bytes of the binary stream not written yet
+                std::string itsBinaryPending;
+
+                /// Name of the binary serialisation element (BINARY or BINARY2)
+                std::string itsBinaryElement;
+        };
+
+    }
+}
+
+#endif
@@ -30,29 +30,136 @@
 // Include package level header file
 #include "askap_accessors.h"
 
+// System includes
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+
 // ASKAPsoft includes
+#include <askap/askap/AskapError.h>
 #include "xercesc/util/XMLString.hpp"
 
 using namespace askap::accessors;
 
-XercescString::XercescString(const char* str) : itsXMLCh(0)
+namespace {
+
+/// @brief Maximum number of free buffers kept per thread
+const std::size_t theirMaxPoolSize = 32;
+
+/// @brief Free buffers left by destroyed XercescString objects
+thread_local std::vector<std::vector<XMLCh> > theirPool;
+
+/// @brief Takes a free buffer from the pool, or creates a new one
+std::vector<XMLCh> acquireBuffer()
+{
+    std::vector<XMLCh> buf;
+    if (!theirPool.empty()) {
+        buf.swap(theirPool.back());
+        theirPool.pop_back();
+    }
+    buf.clear();
+    return buf;
+}
+
+/// @brief Returns the buffer to the pool, keeping its capacity
+void releaseBuffer(std::vector<XMLCh>& buf)
+{
+    if (theirPool.size() < theirMaxPoolSize && buf.capacity() > 0) {
+        theirPool.push_back(std::vector<XMLCh>());
+        theirPool.back().swap(buf);
+    }
+}
+
+/// @brief Returns true if the chars are 7-bit ASCII
+bool isAscii(const char* str, std::size_t length)
+{
+    for (std::size_t i = 0; i < length; ++i) {
+        if (static_cast<unsigned char>(str[i]) >= 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+XercescString::XercescString(const char* str)
 {
-    itsXMLCh = xercesc::XMLString::transcode(str);
+    assign(str, str ? std::strlen(str) : 0);
 }
 
-XercescString::XercescString(const XMLCh* xmlstr)
+XercescString::XercescString(const XMLCh* xmlstr) : itsXMLCh(acquireBuffer())
 {
-    itsXMLCh = xercesc::XMLString::replicate(xmlstr);
+    if (xmlstr) {
+        itsXMLCh.assign(xmlstr, xmlstr + xercesc::XMLString::stringLen(xmlstr));
+    }
+    itsXMLCh.push_back(0);
 }
 
-XercescString::XercescString(const std::string& str) : itsXMLCh(0)
+XercescString::XercescString(const std::string& str)
 {
-    itsXMLCh = xercesc::XMLString::transcode(str.c_str());
+    assign(str.data(), str.size());
+}
+
+XercescString::XercescString(const XercescString& other) : itsXMLCh(acquireBuffer())
+{
+    itsXMLCh.assign(other.itsXMLCh.begin(), other.itsXMLCh.end());
 }
 
 XercescString::~XercescString()
 {
-    if (itsXMLCh) {
-        xercesc::XMLString::release(&itsXMLCh);
+    releaseBuffer(itsXMLCh);
+}
+
+XercescString& XercescString::operator=(const XercescString& other)
+{
+    if (this != &other) {
+        itsXMLCh.assign(other.itsXMLCh.begin(), other.itsXMLCh.end());
     }
+    return *this;
+}
+
+void XercescString::assign(const char* str, std::size_t length)
+{
+    itsXMLCh = acquireBuffer();
+    if (isAscii(str, length)) {
+        itsXMLCh.assign(str, str + length);
+    } else {
+        const std::string tmp(str, length);
+        XMLCh* xmlstr = xercesc::XMLString::transcode(tmp.c_str());
+        itsXMLCh.assign(xmlstr, xmlstr + xercesc::XMLString::stringLen(xmlstr));
+        xercesc::XMLString::release(&xmlstr);
+    }
+    itsXMLCh.push_back(0);
+}
+
+std::string XercescString::toString(const XMLCh* xmlstr)
+{
+    return xmlstr ? toString(xmlstr, xercesc::XMLString::stringLen(xmlstr)) : std::string();
+}
+
+std::string XercescString::toString(const XMLCh* xmlstr, std::size_t length)
+{
+    std::string str(length, ' ');
+    for (std::size_t i = 0; i < length; ++i) {
+        if (xmlstr[i] >= 0x80) {
+            // not ASCII, the transcoder expects a null terminated array
+            std::vector<XMLCh> terminated(xmlstr, xmlstr + length);
+            terminated.push_back(0);
+            char* c = xercesc::XMLString::transcode(&terminated[0]);
+            str = c;
+            xercesc::XMLString::release(&c);
+            return str;
+        }
+        str[i] = static_cast<char>(xmlstr[i]);
+    }
+    return str;
+}
+
+XercescLiteral::XercescLiteral(const char* str) : itsString(str)
+{
+    ASKAPDEBUGASSERT(isAscii(itsString.data(), itsString.size()));
+    itsXMLCh.assign(itsString.begin(), itsString.end());
+    itsXMLCh.push_back(0);
 }
@@ -29,6 +29,8 @@
 
 // System includes
 #include <string>
+#include <vector>
+#include <cstddef>
 
 // ASKAPsoft includes
 #include "xercesc/util/XMLString.hpp"
@@ -39,6 +41,12 @@ namespace askap {
         /// @brief Helper class to  manage XMLCh arrays, and convert to and
         /// from std::string.
         ///
+        /// @details The XMLCh array is kept in a buffer taken from a per-thread
+        /// pool and returned to the pool on destruction, so the temporaries
+        /// created for every attribute and text value don't allocate once the
+        /// pool has warmed up. ASCII strings (the vast majority in VOTables) are
+        /// converted directly, other strings go through the Xerces transcoder.
+        ///
         /// @ingroup votableaccess
         class XercescString {
             public:
@@ -48,21 +56,58 @@ namespace askap {
 
                 explicit XercescString(const std::string& str);
 
+                XercescString(const XercescString& other);
+
                 ~XercescString();
 
+                XercescString& operator=(const XercescString& other);
+
                 operator const XMLCh*() const {
-                    return itsXMLCh;
+                    return &itsXMLCh[0];
                 }
 
                 operator const std::string() const {
-                    char* c = xercesc::XMLString::transcode(itsXMLCh);
-                    std::string s(c);
-                    xercesc::XMLString::release(&c);
-                    return s;
+                    return toString(&itsXMLCh[0], itsXMLCh.size() - 1);
                 }
 
+                /// @brief Converts the null terminated XMLCh array to std::string
+                /// @details A null pointer gives an empty string.
+                static std::string toString(const XMLCh* xmlstr);
+
+                /// @brief Converts the given number of XMLCh characters to std::string
+                static std::string toString(const XMLCh* xmlstr, std::size_t length);
+
             private:
-                XMLCh* itsXMLCh;
+                /// @brief Takes a buffer from the pool and fills it from the given chars
+                void assign(const char* str, std::size_t length);
+
+                /// @brief Null terminated XMLCh array
+                std::vector<XMLCh> itsXMLCh;
+        };
+
+        /// @brief Statically initialised XMLCh constant for an ASCII literal
+        /// @details Unlike XercescString, the conversion doesn't need the Xerces
+        /// platform to be initialised, so the constants can be defined at namespace
+        /// scope (see VOTableTags).
+        ///
+        /// @ingroup votableaccess
+        class XercescLiteral {
+            public:
+                explicit XercescLiteral(const char* str);
+
+                operator const XMLCh*() const {
+                    return &itsXMLCh[0];
+                }
+
+                /// @brief The literal as std::string
+                const std::string& str() const {
+                    return itsString;
+                }
+
+            private:
+                std::vector<XMLCh> itsXMLCh;
+
+                std::string itsString;
         };
 
     }
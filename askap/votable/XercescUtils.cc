@@ -40,18 +40,29 @@
 
 // Local package includes
 #include "askap/votable/XercescString.h"
+#include "askap/votable/VOTableTags.h"
 
 using namespace xercesc;
 using namespace askap::accessors;
 
 std::string XercescUtils::getAttribute(const xercesc::DOMElement& element, const std::string& key)
 {
-    const XMLCh* val = element.getAttribute(XercescString(key));
-    return XercescString(val);
+    return getAttribute(element, XercescString(key));
+}
+
+std::string XercescUtils::getAttribute(const xercesc::DOMElement& element, const XMLCh* key)
+{
+    return XercescString::toString(element.getAttribute(key));
 }
 
 xercesc::DOMElement* XercescUtils::getFirstElementByTagName(const xercesc::DOMElement& element,
         const std::string& name)
+{
+    return getFirstElementByTagName(element, XercescString(name));
+}
+
+xercesc::DOMElement* XercescUtils::getFirstElementByTagName(const xercesc::DOMElement& element,
+        const XMLCh* name)
 {
     const DOMNodeList* children = element.getChildNodes();
     ASKAPDEBUGASSERT(children != 0);
@@ -66,8 +77,7 @@ xercesc::DOMElement* XercescUtils::getFirstElementByTagName(const xercesc::DOMEl
         DOMElement* e1 = dynamic_cast<xercesc::DOMElement*>(children->item(i));
         ASKAPDEBUGASSERT(e1 != 0);
 
-        const string nodeName = XercescString(e1->getNodeName());
-        if (nodeName.compare(name) == 0) {
+        if (XMLString::equals(e1->getNodeName(), name)) {
             return e1;
         }
     }
@@ -77,15 +87,13 @@ xercesc::DOMElement* XercescUtils::getFirstElementByTagName(const xercesc::DOMEl
 
 std::string XercescUtils::getStringFromDOMText(const xercesc::DOMText& text)
 {
-	const XMLCh* wholeText(text.getWholeText());
-        std::string str = XercescString(wholeText);
-        return str;
+    return XercescString::toString(text.getWholeText());
 }
 
 std::string XercescUtils::getDescription(const xercesc::DOMElement& element)
 {
     // Find the DESCRIPTION node
-    DOMElement* descNode = getFirstElementByTagName(element, "DESCRIPTION");
+    DOMElement* descNode = getFirstElementByTagName(element, VOTableTags::DESCRIPTION);
 
     if (!descNode || descNode->getChildNodes()->getLength() < 1) {
         return "";
@@ -103,9 +111,15 @@ std::string XercescUtils::getDescription(const xercesc::DOMElement& element)
 
 xercesc::DOMElement* XercescUtils::addTextElement(xercesc::DOMElement& parent,
         const std::string& tag, const std::string& value)
+{
+    return addTextElement(parent, XercescString(tag), value);
+}
+
+xercesc::DOMElement* XercescUtils::addTextElement(xercesc::DOMElement& parent,
+        const XMLCh* tag, const std::string& value)
 {
     DOMDocument* doc = parent.getOwnerDocument();
-    DOMElement* child = doc->createElement(XercescString(tag));
+    DOMElement* child = doc->createElement(tag);
     DOMText* text = doc->createTextNode(XercescString(value));
     child->appendChild(text);
     parent.appendChild(child);
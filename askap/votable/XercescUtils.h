@@ -50,12 +50,24 @@ namespace askap {
                 static std::string getAttribute(const xercesc::DOMElement& element,
                         const std::string& key);
 
+                /// @brief Returns the value of an attibute associated with a
+                /// given DOM element, the key is already transcoded (see VOTableTags).
+                static std::string getAttribute(const xercesc::DOMElement& element,
+                        const XMLCh* key);
+
                 /// @brief Returns a pointer to the first element contained by
                 /// the "element" parameter, that has the tag matching name.
                 static xercesc::DOMElement* getFirstElementByTagName(
                         const xercesc::DOMElement& element,
                         const std::string& name);
 
+                /// @brief Returns a pointer to the first element contained by
+                /// the "element" parameter, that has the tag matching name.
+                /// @details The tag names are compared without transcoding.
+                static xercesc::DOMElement* getFirstElementByTagName(
+                        const xercesc::DOMElement& element,
+                        const XMLCh* name);
+
                 /// @brief Returns the string from an element with the
                 ///  tag DESCRIPTION.
                 static std::string getDescription(const xercesc::DOMElement& element);
@@ -63,6 +75,11 @@ namespace askap {
                 /// Adds a text element child to a DOMElement
                 static xercesc::DOMElement* addTextElement(xercesc::DOMElement& parent,
                         const std::string& tag, const std::string& value);
+
+                /// Adds a text element child to a DOMElement, the tag is
+                /// already transcoded (see VOTableTags).
+                static xercesc::DOMElement* addTextElement(xercesc::DOMElement& parent,
+                        const XMLCh* tag, const std::string& value);
         };
 
     }
@@ -0,0 +1,200 @@
+/// @file
+///
+/// @brief Runner of timed benchmarks with machine-readable output
+/// @details The runner repeats the benchmarks, collects the timing statistics and
+/// writes them in the JSON format.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include "BenchmarkRunner.h"
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// boost includes
+#include <boost/chrono.hpp>
+
+// std includes
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+ASKAP_LOGGER(logger, ".BenchmarkRunner");
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief set up the runner
+/// @param[in] repeats number of timed runs of each benchmark
+/// @param[in] filter only benchmarks with this substring in their names are run (empty means all)
+BenchmarkRunner::BenchmarkRunner(size_t repeats, const std::string &filter) : itsRepeats(repeats),
+         itsFilter(filter)
+{
+  ASKAPCHECK(itsRepeats > 0, "At least one timed run of each benchmark is required");
+}
+
+/// @brief add a parameter to be written with the results
+/// @param[in] name name of the parameter
+/// @param[in] value value of the parameter
+void BenchmarkRunner::setParameter(const std::string &name, const std::string &value)
+{
+  itsParameters[name] = value;
+}
+
+/// @brief add a benchmark
+/// @param[in] name unique name of the benchmark
+/// @param[in] unit unit of items processed by the benchmark
+/// @param[in] bench benchmark function
+void BenchmarkRunner::add(const std::string &name, const std::string &unit, const Benchmark &bench)
+{
+  for (size_t i = 0; i < itsBenchmarks.size(); ++i) {
+       ASKAPCHECK(itsBenchmarks[i].first.first != name, "Benchmark "<<name<<" is already defined");
+  }
+  itsBenchmarks.push_back(std::make_pair(std::make_pair(name, unit), bench));
+}
+
+/// @brief run all selected benchmarks
+/// @details Results are logged as they become available
+void BenchmarkRunner::run()
+{
+  for (size_t i = 0; i < itsBenchmarks.size(); ++i) {
+       const std::string &name = itsBenchmarks[i].first.first;
+       if (!itsFilter.empty() && (name.find(itsFilter) == std::string::npos)) {
+           continue;
+       }
+       const Result result = runOne(name, itsBenchmarks[i].first.second, itsBenchmarks[i].second);
+       ASKAPLOG_INFO_STR(logger, std::setw(24)<<std::left<<name<<" min "<<result.itsMinTime<<" s, mean "<<
+                 result.itsMeanTime<<" s, max "<<result.itsMaxTime<<" s for "<<result.itsItems<<" "<<
+                 result.itsUnit<<" ("<<result.itsItems / result.itsMinTime<<" "<<result.itsUnit<<"/s, "<<
+                 result.itsBytes / result.itsMinTime / 1048576.<<" MB/s)");
+       if (!result.itsMetrics.empty()) {
+           std::ostringstream os;
+           for (std::map<std::string, double>::const_iterator ci = result.itsMetrics.begin();
+                ci != result.itsMetrics.end(); ++ci) {
+                os<<" "<<ci->first<<" "<<ci->second;
+           }
+           ASKAPLOG_INFO_STR(logger, std::setw(24)<<std::left<<name<<os.str());
+       }
+       itsResults.push_back(result);
+  }
+}
+
+/// @brief run a single benchmark
+/// @details The counts of all timed runs are required to be the same, otherwise the
+/// benchmark doesn't do a fixed amount of work and its timings can't be compared.
+/// Metrics are allowed to differ between runs, the maximum is reported.
+/// @param[in] name name of the benchmark
+/// @param[in] unit unit of items
+/// @param[in] bench benchmark function
+/// @return timing statistics
+BenchmarkRunner::Result BenchmarkRunner::runOne(const std::string &name, const std::string &unit,
+                    const Benchmark &bench) const
+{
+  Result result;
+  result.itsName = name;
+  result.itsUnit = unit;
+  result.itsRuns = itsRepeats;
+  Counts warmUp;
+  bench(warmUp);
+  result.itsItems = warmUp.itsItems;
+  result.itsBytes = warmUp.itsBytes;
+  result.itsMinTime = -1.;
+  result.itsMaxTime = 0.;
+  double totalTime = 0.;
+  for (size_t run = 0; run < itsRepeats; ++run) {
+       Counts counts;
+       const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+       bench(counts);
+       const double time = boost::chrono::duration<double>(boost::chrono::steady_clock::now() - start).count();
+       ASKAPCHECK((counts.itsItems == result.itsItems) && (counts.itsBytes == result.itsBytes),
+                  "Benchmark "<<name<<" processed "<<counts.itsItems<<" item(s) and "<<counts.itsBytes<<
+                  " byte(s) in run "<<run + 1<<", the warm-up run processed "<<result.itsItems<<
+                  " item(s) and "<<result.itsBytes<<" byte(s)");
+       totalTime += time;
+       result.itsMinTime = result.itsMinTime < 0. ? time : std::min(result.itsMinTime, time);
+       result.itsMaxTime = std::max(result.itsMaxTime, time);
+       for (std::map<std::string, double>::const_iterator ci = counts.itsMetrics.begin();
+            ci != counts.itsMetrics.end(); ++ci) {
+            const std::map<std::string, double>::iterator it = result.itsMetrics.find(ci->first);
+            if (it == result.itsMetrics.end()) {
+                result.itsMetrics.insert(*ci);
+            } else {
+                it->second = std::max(it->second, ci->second);
+            }
+       }
+  }
+  result.itsMeanTime = totalTime / itsRepeats;
+  return result;
+}
+
+/// @brief write the parameters and the results in the JSON format
+/// @details Rates are derived from the minimum time, which is the least affected
+/// by other activity on the machine.
+/// @param[in] os output stream
+void BenchmarkRunner::writeJSON(std::ostream &os) const
+{
+  os<<"{\n  \"parameters\": {";
+  for (std::map<std::string, std::string>::const_iterator ci = itsParameters.begin();
+       ci != itsParameters.end(); ++ci) {
+       os<<(ci == itsParameters.begin() ? "\n" : ",\n")<<"    "<<quote(ci->first)<<": "<<quote(ci->second);
+  }
+  os<<"\n  },\n  \"results\": [";
+  std::ostringstream buf;
+  buf<<std::setprecision(9);
+  for (size_t i = 0; i < itsResults.size(); ++i) {
+       const Result &res = itsResults[i];
+       const double minTime = res.itsMinTime > 0. ? res.itsMinTime : 1e-9;
+       buf<<(i == 0 ? "\n" : ",\n")<<"    {\"name\": "<<quote(res.itsName)<<", \"unit\": "<<quote(res.itsUnit)<<
+            ", \"runs\": "<<res.itsRuns<<", \"items\": "<<res.itsItems<<", \"bytes\": "<<res.itsBytes<<
+            ", \"min_s\": "<<res.itsMinTime<<", \"mean_s\": "<<res.itsMeanTime<<", \"max_s\": "<<res.itsMaxTime<<
+            ", \"items_per_s\": "<<res.itsItems / minTime<<", \"mb_per_s\": "<<res.itsBytes / minTime / 1048576.;
+       for (std::map<std::string, double>::const_iterator ci = res.itsMetrics.begin();
+            ci != res.itsMetrics.end(); ++ci) {
+            buf<<", "<<quote(ci->first)<<": "<<ci->second;
+       }
+       buf<<"}";
+  }
+  os<<buf.str()<<"\n  ]\n}\n";
+}
+
+/// @brief quote a string for JSON output
+/// @param[in] str string to quote
+/// @return quoted string with special characters escaped
+std::string BenchmarkRunner::quote(const std::string &str)
+{
+  std::string result = "\"";
+  for (std::string::const_iterator ci = str.begin(); ci != str.end(); ++ci) {
+       if ((*ci == '"') || (*ci == '\\')) {
+           result += '\\';
+           result += *ci;
+       } else if (*ci == '\n') {
+           result += "\\n";
+       } else {
+           result += *ci;
+       }
+  }
+  return result + "\"";
+}
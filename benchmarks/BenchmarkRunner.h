@@ -0,0 +1,154 @@
+/// @file
+///
+/// @brief Runner of timed benchmarks with machine-readable output
+/// @details Each benchmark is a function doing a fixed amount of work and reporting the
+/// number of items (e.g. rows or accessors) and bytes it has processed. The runner repeats
+/// the benchmarks, collects the timing statistics and writes them in the JSON format,
+/// so results from different revisions and machines can be compared by scripts.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_BENCHMARK_RUNNER_H
+#define ASKAP_ACCESSORS_BENCHMARK_RUNNER_H
+
+// boost includes
+#include <boost/function.hpp>
+
+// std includes
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Runner of timed benchmarks with machine-readable output
+/// @details The first run of each benchmark is a warm-up and is not included in the
+/// statistics. Parameters describing the dataset and the run can be added to be
+/// written along with the results.
+class BenchmarkRunner {
+public:
+  /// @brief amount of work done by a single run of a benchmark
+  struct Counts {
+     /// @brief initialise with zeros
+     Counts() : itsItems(0), itsBytes(0) {}
+     /// @brief number of processed items
+     size_t itsItems;
+     /// @brief number of processed bytes
+     size_t itsBytes;
+     /// @brief optional quantities measured by the run (e.g. memory usage), keyed by name
+     std::map<std::string, double> itsMetrics;
+  };
+
+  /// @brief type of the benchmark function
+  /// @details The function does the work and increments the counts passed to it
+  typedef boost::function<void(Counts&)> Benchmark;
+
+  /// @brief timing statistics of a benchmark
+  struct Result {
+     /// @brief name of the benchmark
+     std::string itsName;
+     /// @brief unit of items (e.g. "rows")
+     std::string itsUnit;
+     /// @brief number of timed runs
+     size_t itsRuns;
+     /// @brief items processed per run
+     size_t itsItems;
+     /// @brief bytes processed per run
+     size_t itsBytes;
+     /// @brief minimum time of a single run in seconds
+     double itsMinTime;
+     /// @brief mean time of a single run in seconds
+     double itsMeanTime;
+     /// @brief maximum time of a single run in seconds
+     double itsMaxTime;
+     /// @brief maximum of each metric over the timed runs
+     std::map<std::string, double> itsMetrics;
+  };
+
+  /// @brief set up the runner
+  /// @param[in] repeats number of timed runs of each benchmark
+  /// @param[in] filter only benchmarks with this substring in their names are run (empty means all)
+  explicit BenchmarkRunner(size_t repeats = 5, const std::string &filter = "");
+
+  /// @brief add a parameter to be written with the results
+  /// @param[in] name name of the parameter
+  /// @param[in] value value of the parameter
+  void setParameter(const std::string &name, const std::string &value);
+
+  /// @brief add a benchmark
+  /// @param[in] name unique name of the benchmark
+  /// @param[in] unit unit of items processed by the benchmark
+  /// @param[in] bench benchmark function
+  void add(const std::string &name, const std::string &unit, const Benchmark &bench);
+
+  /// @brief run all selected benchmarks
+  /// @details Results are logged as they become available
+  void run();
+
+  /// @return results of the benchmarks run so far
+  inline const std::vector<Result>& results() const { return itsResults; }
+
+  /// @brief write the parameters and the results in the JSON format
+  /// @param[in] os output stream
+  void writeJSON(std::ostream &os) const;
+
+private:
+  /// @brief run a single benchmark
+  /// @param[in] name name of the benchmark
+  /// @param[in] unit unit of items
+  /// @param[in] bench benchmark function
+  /// @return timing statistics
+  Result runOne(const std::string &name, const std::string &unit, const Benchmark &bench) const;
+
+  /// @brief quote a string for JSON output
+  /// @param[in] str string to quote
+  /// @return quoted string with special characters escaped
+  static std::string quote(const std::string &str);
+
+  /// @brief number of timed runs
+  size_t itsRepeats;
+
+  /// @brief filter of benchmark names
+  std::string itsFilter;
+
+  /// @brief parameters written with the results
+  std::map<std::string, std::string> itsParameters;
+
+  /// @brief registered benchmarks: name, unit and function
+  std::vector<std::pair<std::pair<std::string, std::string>, Benchmark> > itsBenchmarks;
+
+  /// @brief results
+  std::vector<Result> itsResults;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_BENCHMARK_RUNNER_H
@@ -0,0 +1,242 @@
+/// @file
+///
+/// @brief Generator of synthetic VOTable catalogues for benchmarking
+/// @details This class produces a source catalogue with the given number of rows and a mix
+/// of datatypes. All cells are derived from their row and column by a fixed hash.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include "SyntheticCatalogueGenerator.h"
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/votable/VOTableField.h>
+#include <askap/votable/VOTableResource.h>
+#include <askap/votable/VOTableWriter.h>
+
+// casa includes
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <cstdio>
+#include <cmath>
+
+ASKAP_LOGGER(logger, ".SyntheticCatalogueGenerator");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief seed of the hash, the same for all catalogues
+const unsigned long long theSeed = 20260312ull;
+
+/// @brief description of a field: name, datatype, arraysize, unit, ucd and whether it can be null
+struct FieldDescription {
+   const char* itsName;
+   const char* itsDatatype;
+   const char* itsArraysize;
+   const char* itsUnit;
+   const char* itsUCD;
+   bool itsNullable;
+};
+
+/// @brief fields of the catalogue, fillRow relies on this order
+const FieldDescription theFields[] = {
+   {"component_id", "char", "*", "", "meta.id;meta.main", false},
+   {"ra_deg", "double", "", "deg", "pos.eq.ra;meta.main", false},
+   {"dec_deg", "double", "", "deg", "pos.eq.dec;meta.main", false},
+   {"ra_err", "float", "", "arcsec", "stat.error;pos.eq.ra", true},
+   {"dec_err", "float", "", "arcsec", "stat.error;pos.eq.dec", true},
+   {"flux_peak", "float", "", "mJy/beam", "phot.flux.density;stat.max", false},
+   {"flux_int", "float", "", "mJy", "phot.flux.density", true},
+   {"flux_int_err", "float", "", "mJy", "stat.error;phot.flux.density", true},
+   {"maj_axis", "float", "", "arcsec", "phys.angSize.smajAxis", true},
+   {"n_pix", "int", "", "", "meta.number", false},
+   {"n_chan", "short", "", "", "meta.number", false},
+   {"quality", "unsignedByte", "", "", "meta.code.qual", false},
+   {"pixel_index", "long", "", "", "meta.id", false},
+   {"has_siblings", "boolean", "", "", "meta.code", true},
+   {"island_id", "char", "*", "", "meta.id.parent", true}
+};
+
+/// @brief format a number with the given format string
+/// @param[in] fmt printf-style format of a single value
+/// @param[in] value value to format
+/// @return formatted text
+template<typename T>
+std::string format(const char* fmt, T value)
+{
+   char buf[64];
+   const int len = std::snprintf(buf, sizeof(buf), fmt, value);
+   ASKAPDEBUGASSERT((len >= 0) && (static_cast<size_t>(len) < sizeof(buf)));
+   return std::string(buf, len);
+}
+
+} // anonymous namespace
+
+/// @brief set up default parameters
+/// @details Defaults give a thousand rows with 2% of nulls.
+SyntheticCatalogueGenerator::SyntheticCatalogueGenerator() : itsNRows(1000), itsNullFraction(0.02) {}
+
+/// @brief set the number of rows
+/// @param[in] nRows number of rows in the catalogue
+void SyntheticCatalogueGenerator::setNumberOfRows(size_t nRows)
+{
+  itsNRows = nRows;
+}
+
+/// @brief set the fraction of null cells
+/// @param[in] fraction fraction of nullable cells which are null (between 0 and 1)
+void SyntheticCatalogueGenerator::setNullFraction(double fraction)
+{
+  ASKAPCHECK((fraction >= 0.) && (fraction <= 1.), "Fraction of null cells should be between 0 and 1, you have "<<
+             fraction);
+  itsNullFraction = fraction;
+}
+
+/// @return number of fields
+size_t SyntheticCatalogueGenerator::nFields()
+{
+  return sizeof(theFields) / sizeof(theFields[0]);
+}
+
+/// @brief table with all fields and no rows
+/// @param[in] format serialisation of the table data
+/// @return table header
+VOTableTable SyntheticCatalogueGenerator::header(VOTableTable::DataFormat format)
+{
+  VOTableTable table;
+  table.setName("components");
+  table.setDescription("Synthetic component catalogue");
+  table.setDataFormat(format);
+  for (size_t i = 0; i < nFields(); ++i) {
+       VOTableField field;
+       field.setName(theFields[i].itsName);
+       field.setID(theFields[i].itsName);
+       field.setDatatype(theFields[i].itsDatatype);
+       field.setArraysize(theFields[i].itsArraysize);
+       field.setUnit(theFields[i].itsUnit);
+       field.setUCD(theFields[i].itsUCD);
+       table.addField(std::move(field));
+  }
+  return table;
+}
+
+/// @brief generate the cells of the given row
+/// @details The row is resized to the number of fields, so the same object can be
+/// reused for all rows without reallocating its cells.
+/// @param[in] row row index
+/// @param[out] cells row to fill
+void SyntheticCatalogueGenerator::fillRow(size_t row, VOTableRow& cells) const
+{
+  cells.resize(nFields());
+  const double fluxPeak = 0.1 / (1e-3 + uniform(row, 5));
+  cells.setCell(0, format("SB12345_component_%zua", row));
+  cells.setCell(1, format("%.8f", 360. * uniform(row, 1)));
+  cells.setCell(2, format("%.8f", std::asin(1.4 * uniform(row, 2) - 1.) * 180. / casacore::C::pi));
+  for (size_t col = 3; col < 5; ++col) {
+       cells.setCell(col, isNull(row, col) ? std::string() : format("%.3f", 0.1 + uniform(row, col)));
+  }
+  cells.setCell(5, format("%.4f", fluxPeak));
+  cells.setCell(6, isNull(row, 6) ? std::string() : format("%.4f", fluxPeak * (1. + uniform(row, 6))));
+  cells.setCell(7, isNull(row, 7) ? std::string() : format("%.4f", 0.05 * fluxPeak * uniform(row, 7)));
+  cells.setCell(8, isNull(row, 8) ? std::string() : format("%.2f", 10. + 20. * uniform(row, 8)));
+  cells.setCell(9, std::to_string(static_cast<int>(10 + 1000 * uniform(row, 9))));
+  cells.setCell(10, std::to_string(static_cast<short>(1 + 288 * uniform(row, 10))));
+  cells.setCell(11, std::to_string(static_cast<unsigned int>(256 * uniform(row, 11))));
+  cells.setCell(12, std::to_string(static_cast<long long>(1e12 * uniform(row, 12))));
+  cells.setCell(13, isNull(row, 13) ? std::string() : std::string(uniform(row, 13) < 0.3 ? "T" : "F"));
+  cells.setCell(14, isNull(row, 14) ? std::string() : format("SB12345_island_%zu", row / 2));
+}
+
+/// @brief build the whole catalogue in memory
+/// @param[in] format serialisation of the table data
+/// @return VOTable with a single resource and table
+VOTable SyntheticCatalogueGenerator::makeVOTable(VOTableTable::DataFormat format) const
+{
+  VOTableTable table = header(format);
+  VOTableRow row;
+  for (size_t r = 0; r < itsNRows; ++r) {
+       fillRow(r, row);
+       table.addRow(row);
+  }
+  VOTableResource resource;
+  resource.setName("catalogue");
+  resource.addTable(std::move(table));
+  VOTable vot;
+  vot.setDescription("Synthetic catalogue for benchmarking");
+  vot.addResource(std::move(resource));
+  return vot;
+}
+
+/// @brief write the catalogue row by row
+/// @details The rows are streamed with VOTableWriter, so files much larger than the
+/// available memory can be produced. An existing file is overwritten.
+/// @param[in] filename name of the file
+/// @param[in] format serialisation of the table data
+void SyntheticCatalogueGenerator::write(const std::string& filename, VOTableTable::DataFormat format) const
+{
+  ASKAPLOG_DEBUG_STR(logger, "Writing synthetic catalogue with "<<itsNRows<<" rows into "<<filename);
+  VOTableWriter writer(filename, "Synthetic catalogue for benchmarking");
+  VOTableResource resource;
+  resource.setName("catalogue");
+  writer.beginResource(resource);
+  writer.beginTable(header(format));
+  VOTableRow row;
+  for (size_t r = 0; r < itsNRows; ++r) {
+       fillRow(r, row);
+       writer.addRow(row);
+  }
+  writer.close();
+}
+
+/// @brief uniformly distributed pseudo-random number for the given cell
+/// @details splitmix64 finaliser of the cell index, which is cheap and doesn't need
+/// any state, so rows can be generated in any order.
+/// @param[in] row row index
+/// @param[in] column column index
+/// @return number between 0 (inclusive) and 1 (exclusive)
+double SyntheticCatalogueGenerator::uniform(size_t row, size_t column)
+{
+  unsigned long long x = theSeed + (static_cast<unsigned long long>(row) * nFields() + column) *
+                         0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  x ^= x >> 31;
+  return static_cast<double>(x >> 11) / 9007199254740992.;
+}
+
+/// @brief check whether the given cell is null
+/// @param[in] row row index
+/// @param[in] column column index
+/// @return true, if the cell is null
+bool SyntheticCatalogueGenerator::isNull(size_t row, size_t column) const
+{
+  ASKAPDEBUGASSERT(column < nFields());
+  // the hash of a column beyond the last one is used, so nulls are independent of the values
+  return theFields[column].itsNullable && (uniform(row, column + nFields()) < itsNullFraction);
+}
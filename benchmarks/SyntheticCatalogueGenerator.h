@@ -0,0 +1,124 @@
+/// @file
+///
+/// @brief Generator of synthetic VOTable catalogues for benchmarking
+/// @details VOTable benchmarks need catalogues of a controlled size which can be recreated
+/// on any machine. This class produces a source catalogue with the given number of rows and
+/// a mix of string, floating point, integer and boolean fields. Every cell is derived from
+/// its row and column by a fixed hash, so the same parameters always give the same catalogue
+/// and rows can be generated one at a time without holding the whole table in memory.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_CATALOGUE_GENERATOR_H
+#define ASKAP_ACCESSORS_SYNTHETIC_CATALOGUE_GENERATOR_H
+
+// own includes
+#include <askap/votable/VOTable.h>
+#include <askap/votable/VOTableTable.h>
+#include <askap/votable/VOTableRow.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Generator of synthetic VOTable catalogues for benchmarking
+/// @details The catalogue resembles a component catalogue of the source finder: an
+/// identifier, position, fluxes with errors, sizes, counts, quality flags and a
+/// boolean. A fraction of the floating point, string and boolean cells is null;
+/// integer cells are never null, so the catalogue can be written in all serialisations
+/// (the BINARY serialisation has no nulls for integers).
+class SyntheticCatalogueGenerator {
+public:
+  /// @brief set up default parameters
+  /// @details Defaults give a thousand rows with 2% of nulls.
+  SyntheticCatalogueGenerator();
+
+  /// @brief set the number of rows
+  /// @param[in] nRows number of rows in the catalogue
+  void setNumberOfRows(size_t nRows);
+
+  /// @brief set the fraction of null cells
+  /// @param[in] fraction fraction of nullable cells which are null (between 0 and 1)
+  void setNullFraction(double fraction);
+
+  /// @return number of rows
+  inline size_t nRows() const { return itsNRows; }
+
+  /// @return number of fields
+  static size_t nFields();
+
+  /// @brief table with all fields and no rows
+  /// @param[in] format serialisation of the table data
+  /// @return table header
+  static VOTableTable header(VOTableTable::DataFormat format);
+
+  /// @brief generate the cells of the given row
+  /// @details The row is resized to the number of fields, so the same object can be
+  /// reused for all rows without reallocating its cells.
+  /// @param[in] row row index
+  /// @param[out] cells row to fill
+  void fillRow(size_t row, VOTableRow& cells) const;
+
+  /// @brief build the whole catalogue in memory
+  /// @param[in] format serialisation of the table data
+  /// @return VOTable with a single resource and table
+  VOTable makeVOTable(VOTableTable::DataFormat format) const;
+
+  /// @brief write the catalogue row by row
+  /// @details The rows are streamed with VOTableWriter, so files much larger than the
+  /// available memory can be produced. An existing file is overwritten.
+  /// @param[in] filename name of the file
+  /// @param[in] format serialisation of the table data
+  void write(const std::string& filename, VOTableTable::DataFormat format) const;
+
+private:
+  /// @brief uniformly distributed pseudo-random number for the given cell
+  /// @param[in] row row index
+  /// @param[in] column column index
+  /// @return number between 0 (inclusive) and 1 (exclusive)
+  static double uniform(size_t row, size_t column);
+
+  /// @brief check whether the given cell is null
+  /// @param[in] row row index
+  /// @param[in] column column index
+  /// @return true, if the cell is null
+  bool isNull(size_t row, size_t column) const;
+
+  /// @brief number of rows
+  size_t itsNRows;
+
+  /// @brief fraction of null cells
+  double itsNullFraction;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_CATALOGUE_GENERATOR_H
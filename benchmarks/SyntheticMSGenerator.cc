@@ -0,0 +1,391 @@
+/// @file
+///
+/// @brief Generator of synthetic measurement sets for benchmarking
+/// @details This class writes a measurement set with the given number of antennas, beams,
+/// spectral windows, channels and integrations. All values are derived from a fixed seed.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include "SyntheticMSGenerator.h"
+#include <askap/askap/AskapError.h>
+#include <askap/askap/AskapLogging.h>
+
+// casa includes
+#include <casacore/ms/MeasurementSets/MeasurementSet.h>
+#include <casacore/ms/MeasurementSets/MSColumns.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/measures/Measures/MFrequency.h>
+#include <casacore/measures/Measures/Stokes.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/Constants.h>
+
+// std includes
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+ASKAP_LOGGER(logger, ".SyntheticMSGenerator");
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief seed of the random generator, the same for all datasets
+const unsigned int theSeed = 20120312u;
+
+/// @brief start time of the observation (MJD 55000 in seconds)
+const double theStartTime = 55000. * 86400.;
+
+/// @brief integration time in seconds
+const double theIntegrationTime = 5.;
+
+/// @brief frequency of the first channel of the first spectral window in Hz
+const double theStartFrequency = 7e8;
+
+/// @brief channel width in Hz
+const double theChannelWidth = 1e6;
+
+/// @brief spacing of beams on the sky in radians
+const double theBeamSpacing = casacore::C::pi / 180.;
+
+/// @brief noise of the synthetic visibilities (in Jy)
+const float theNoise = 0.1;
+
+/// @brief ITRF position of the array centre in metres (near the ASKAP site)
+const double theArrayCentre[3] = {-2556743.707, 5097440.315, -2847749.766};
+
+/// @brief maximum offset of antennas from the array centre along each axis in metres
+const double theMaxAntennaOffset = 3000.;
+
+} // anonymous namespace
+
+/// @brief set up default parameters
+/// @details Defaults give a dataset of a few tens of megabytes.
+SyntheticMSGenerator::SyntheticMSGenerator() : itsNAnt(12), itsNBeam(1), itsNSpw(1), itsNChan(256),
+       itsNTimes(20), itsFlaggedFraction(0.01) {}
+
+/// @brief set the number of antennas
+/// @param[in] nAnt number of antennas (at least 2)
+void SyntheticMSGenerator::setNumberOfAntennas(casacore::uInt nAnt)
+{
+  ASKAPCHECK(nAnt > 1, "At least 2 antennas are required, you have "<<nAnt);
+  itsNAnt = nAnt;
+}
+
+/// @brief set the number of beams
+/// @param[in] nBeam number of beams (feeds), which are correlated independently
+void SyntheticMSGenerator::setNumberOfBeams(casacore::uInt nBeam)
+{
+  ASKAPCHECK(nBeam > 0, "At least one beam is required");
+  itsNBeam = nBeam;
+}
+
+/// @brief set the number of spectral windows
+/// @details Each spectral window has its own data descriptor
+/// @param[in] nSpw number of spectral windows
+void SyntheticMSGenerator::setNumberOfSpectralWindows(casacore::uInt nSpw)
+{
+  ASKAPCHECK(nSpw > 0, "At least one spectral window is required");
+  itsNSpw = nSpw;
+}
+
+/// @brief set the number of spectral channels per spectral window
+/// @param[in] nChan number of channels
+void SyntheticMSGenerator::setNumberOfChannels(casacore::uInt nChan)
+{
+  ASKAPCHECK(nChan > 0, "At least one spectral channel is required");
+  itsNChan = nChan;
+}
+
+/// @brief set the number of integrations
+/// @param[in] nTimes number of time steps
+void SyntheticMSGenerator::setNumberOfIntegrations(casacore::uInt nTimes)
+{
+  ASKAPCHECK(nTimes > 0, "At least one integration is required");
+  itsNTimes = nTimes;
+}
+
+/// @brief set the fraction of flagged samples
+/// @param[in] fraction fraction of visibilities to flag (between 0 and 1)
+void SyntheticMSGenerator::setFlaggedFraction(double fraction)
+{
+  ASKAPCHECK((fraction >= 0.) && (fraction <= 1.), "Fraction of flagged samples should be between 0 and 1, you have "<<
+             fraction);
+  itsFlaggedFraction = fraction;
+}
+
+/// @return number of rows in the main table
+casacore::uInt SyntheticMSGenerator::nRows() const
+{
+  return itsNTimes * itsNSpw * itsNBeam * itsNAnt * (itsNAnt + 1) / 2;
+}
+
+/// @return size of the visibility data in bytes
+size_t SyntheticMSGenerator::dataSize() const
+{
+  return size_t(nRows()) * itsNChan * nPol() * sizeof(casacore::Complex);
+}
+
+/// @brief write the measurement set
+/// @details An existing table with the same name is overwritten.
+/// @param[in] name file name of the measurement set
+void SyntheticMSGenerator::create(const std::string &name) const
+{
+  ASKAPLOG_INFO_STR(logger, "Creating synthetic measurement set "<<name<<": "<<itsNAnt<<" antennas, "<<
+                    itsNBeam<<" beam(s), "<<itsNSpw<<" spectral window(s) x "<<itsNChan<<" channels, "<<
+                    itsNTimes<<" integration(s), "<<nRows()<<" rows");
+  casacore::TableDesc td = casacore::MeasurementSet::requiredTableDesc();
+  casacore::MeasurementSet::addColumnToDesc(td, casacore::MeasurementSet::DATA, 2);
+  casacore::SetupNewTable newMS(name, td, casacore::Table::New);
+  casacore::StandardStMan ssm("SSMData", 32768);
+  newMS.bindAll(ssm);
+  // tiles span all polarisations and a block of channels for a number of rows
+  const casacore::uInt tileChannels = std::min(itsNChan, casacore::uInt(256));
+  const casacore::IPosition tileShape(3, nPol(), tileChannels, std::max(casacore::uInt(1), 8192 / tileChannels));
+  casacore::TiledShapeStMan dataMan("TiledData", tileShape);
+  newMS.bindColumn(casacore::MeasurementSet::columnName(casacore::MeasurementSet::DATA), dataMan);
+  casacore::TiledShapeStMan flagMan("TiledFlag", tileShape);
+  newMS.bindColumn(casacore::MeasurementSet::columnName(casacore::MeasurementSet::FLAG), flagMan);
+  {
+    casacore::MeasurementSet ms(newMS, 0);
+    ms.createDefaultSubtables(casacore::Table::New);
+  }
+  fillSubtables(name);
+  fillMainTable(name);
+}
+
+/// @brief write the subtables
+/// @param[in] name file name of the measurement set (should already exist)
+void SyntheticMSGenerator::fillSubtables(const std::string &name) const
+{
+  casacore::MeasurementSet ms(name, casacore::Table::Update);
+  casacore::MSColumns cols(ms);
+  std::mt19937 gen(theSeed);
+  std::uniform_real_distribution<double> offsetDist(-theMaxAntennaOffset, theMaxAntennaOffset);
+
+  // antennas
+  ms.antenna().addRow(itsNAnt);
+  for (casacore::uInt ant = 0; ant < itsNAnt; ++ant) {
+       casacore::Vector<casacore::Double> pos(3);
+       for (casacore::uInt dim = 0; dim < 3; ++dim) {
+            pos[dim] = theArrayCentre[dim] + offsetDist(gen);
+       }
+       cols.antenna().name().put(ant, "ak" + std::to_string(ant + 1));
+       cols.antenna().station().put(ant, "ASKAP");
+       cols.antenna().type().put(ant, "GROUND-BASED");
+       cols.antenna().mount().put(ant, "ALT-AZ");
+       cols.antenna().position().put(ant, pos);
+       cols.antenna().offset().put(ant, casacore::Vector<casacore::Double>(3, 0.));
+       cols.antenna().dishDiameter().put(ant, 12.);
+       cols.antenna().flagRow().put(ant, false);
+  }
+
+  // spectral windows and data descriptors, one per spectral window
+  ms.spectralWindow().addRow(itsNSpw);
+  ms.dataDescription().addRow(itsNSpw);
+  for (casacore::uInt spw = 0; spw < itsNSpw; ++spw) {
+       casacore::Vector<casacore::Double> freqs(itsNChan);
+       for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+            freqs[chan] = theStartFrequency + (spw * itsNChan + chan) * theChannelWidth;
+       }
+       const casacore::Vector<casacore::Double> widths(itsNChan, theChannelWidth);
+       cols.spectralWindow().numChan().put(spw, casacore::Int(itsNChan));
+       cols.spectralWindow().name().put(spw, "spw" + std::to_string(spw));
+       cols.spectralWindow().refFrequency().put(spw, freqs[0]);
+       cols.spectralWindow().chanFreq().put(spw, freqs);
+       cols.spectralWindow().chanWidth().put(spw, widths);
+       cols.spectralWindow().effectiveBW().put(spw, widths);
+       cols.spectralWindow().resolution().put(spw, widths);
+       cols.spectralWindow().measFreqRef().put(spw, casacore::MFrequency::TOPO);
+       cols.spectralWindow().totalBandwidth().put(spw, itsNChan * theChannelWidth);
+       cols.spectralWindow().netSideband().put(spw, 1);
+       cols.spectralWindow().ifConvChain().put(spw, 0);
+       cols.spectralWindow().freqGroup().put(spw, 0);
+       cols.spectralWindow().freqGroupName().put(spw, "");
+       cols.spectralWindow().flagRow().put(spw, false);
+       cols.dataDescription().spectralWindowId().put(spw, casacore::Int(spw));
+       cols.dataDescription().polarizationId().put(spw, 0);
+       cols.dataDescription().flagRow().put(spw, false);
+  }
+
+  // linear polarisation products
+  ms.polarization().addRow(1);
+  {
+    casacore::Vector<casacore::Int> corrType(nPol());
+    corrType[0] = casacore::Stokes::XX;
+    corrType[1] = casacore::Stokes::XY;
+    corrType[2] = casacore::Stokes::YX;
+    corrType[3] = casacore::Stokes::YY;
+    casacore::Matrix<casacore::Int> corrProduct(2, nPol());
+    for (casacore::uInt pol = 0; pol < nPol(); ++pol) {
+         corrProduct(0, pol) = pol / 2;
+         corrProduct(1, pol) = pol % 2;
+    }
+    cols.polarization().numCorr().put(0, casacore::Int(nPol()));
+    cols.polarization().corrType().put(0, corrType);
+    cols.polarization().corrProduct().put(0, corrProduct);
+    cols.polarization().flagRow().put(0, false);
+  }
+
+  // feeds valid for the whole observation and all spectral windows, beams are offset along a line
+  ms.feed().addRow(itsNAnt * itsNBeam);
+  {
+    casacore::Vector<casacore::String> polType(2);
+    polType[0] = "X";
+    polType[1] = "Y";
+    casacore::Matrix<casacore::Complex> polResponse(2, 2, casacore::Complex(0., 0.));
+    polResponse.diagonal() = casacore::Complex(1., 0.);
+    casacore::uInt row = 0;
+    for (casacore::uInt ant = 0; ant < itsNAnt; ++ant) {
+         for (casacore::uInt beam = 0; beam < itsNBeam; ++beam, ++row) {
+              casacore::Matrix<casacore::Double> beamOffset(2, 2, 0.);
+              beamOffset(0, 0) = beamOffset(0, 1) = beam * theBeamSpacing;
+              cols.feed().antennaId().put(row, casacore::Int(ant));
+              cols.feed().feedId().put(row, casacore::Int(beam));
+              cols.feed().spectralWindowId().put(row, -1);
+              cols.feed().time().put(row, theStartTime + 0.5 * itsNTimes * theIntegrationTime);
+              // zero interval means the feed is valid forever
+              cols.feed().interval().put(row, 0.);
+              cols.feed().numReceptors().put(row, 2);
+              cols.feed().beamId().put(row, -1);
+              cols.feed().beamOffset().put(row, beamOffset);
+              cols.feed().polarizationType().put(row, polType);
+              cols.feed().polResponse().put(row, polResponse);
+              cols.feed().position().put(row, casacore::Vector<casacore::Double>(3, 0.));
+              cols.feed().receptorAngle().put(row, casacore::Vector<casacore::Double>(2, 0.));
+         }
+    }
+  }
+
+  // single field at Dec -45 deg
+  ms.field().addRow(1);
+  {
+    casacore::Matrix<casacore::Double> dir(2, 1);
+    dir(0, 0) = 0.;
+    dir(1, 0) = -casacore::C::pi / 4.;
+    cols.field().name().put(0, "synthetic");
+    cols.field().code().put(0, "");
+    cols.field().time().put(0, theStartTime);
+    cols.field().numPoly().put(0, 0);
+    cols.field().delayDir().put(0, dir);
+    cols.field().phaseDir().put(0, dir);
+    cols.field().referenceDir().put(0, dir);
+    cols.field().sourceId().put(0, -1);
+    cols.field().flagRow().put(0, false);
+  }
+
+  ms.observation().addRow(1);
+  {
+    casacore::Vector<casacore::Double> timeRange(2);
+    timeRange[0] = theStartTime;
+    timeRange[1] = theStartTime + itsNTimes * theIntegrationTime;
+    cols.observation().telescopeName().put(0, "ASKAP");
+    cols.observation().timeRange().put(0, timeRange);
+    cols.observation().observer().put(0, "benchmark");
+    cols.observation().project().put(0, "");
+    cols.observation().releaseDate().put(0, 0.);
+    cols.observation().flagRow().put(0, false);
+  }
+}
+
+/// @brief write the main table
+/// @details Visibilities are those of a 1 Jy unpolarised source at the phase centre with
+/// noise added. The uvw coordinates follow the rotation of the baseline vectors with the
+/// hour angle, they are good enough to exercise the code but not astrometrically exact.
+/// @param[in] name file name of the measurement set (should already exist)
+void SyntheticMSGenerator::fillMainTable(const std::string &name) const
+{
+  casacore::MeasurementSet ms(name, casacore::Table::Update);
+  casacore::MSColumns cols(ms);
+  const casacore::Matrix<casacore::Double> antPos = cols.antenna().position().getColumn();
+  ASKAPDEBUGASSERT(antPos.ncolumn() == itsNAnt);
+  // separate generator, so the data don't depend on the number of antennas generated
+  std::mt19937 gen(theSeed + 1);
+  std::normal_distribution<float> noiseDist(0., theNoise);
+  std::uniform_real_distribution<double> flagDist(0., 1.);
+
+  ms.addRow(nRows());
+  casacore::Matrix<casacore::Complex> vis(nPol(), itsNChan);
+  casacore::Matrix<casacore::Bool> flag(nPol(), itsNChan);
+  const casacore::Vector<casacore::Float> sigma(nPol(), theNoise);
+  const casacore::Vector<casacore::Float> weight(nPol(), 1. / (theNoise * theNoise));
+  casacore::Vector<casacore::Double> uvw(3);
+  casacore::uInt row = 0;
+  for (casacore::uInt cycle = 0; cycle < itsNTimes; ++cycle) {
+       const double time = theStartTime + (cycle + 0.5) * theIntegrationTime;
+       // earth rotation angle since the start of the observation
+       const double ha = 2. * casacore::C::pi * cycle * theIntegrationTime / 86164.1;
+       const double cosHA = std::cos(ha);
+       const double sinHA = std::sin(ha);
+       for (casacore::uInt spw = 0; spw < itsNSpw; ++spw) {
+            for (casacore::uInt beam = 0; beam < itsNBeam; ++beam) {
+                 for (casacore::uInt ant1 = 0; ant1 < itsNAnt; ++ant1) {
+                      for (casacore::uInt ant2 = ant1; ant2 < itsNAnt; ++ant2, ++row) {
+                           const double bx = antPos(0, ant2) - antPos(0, ant1);
+                           const double by = antPos(1, ant2) - antPos(1, ant1);
+                           uvw[0] = bx * cosHA - by * sinHA;
+                           uvw[1] = bx * sinHA + by * cosHA;
+                           uvw[2] = antPos(2, ant2) - antPos(2, ant1);
+                           for (casacore::uInt chan = 0; chan < itsNChan; ++chan) {
+                                for (casacore::uInt pol = 0; pol < nPol(); ++pol) {
+                                     const float model = (pol == 0) || (pol == 3) ? 1. : 0.;
+                                     vis(pol, chan) = casacore::Complex(model + noiseDist(gen), noiseDist(gen));
+                                     flag(pol, chan) = flagDist(gen) < itsFlaggedFraction;
+                                }
+                           }
+                           cols.time().put(row, time);
+                           cols.timeCentroid().put(row, time);
+                           cols.interval().put(row, theIntegrationTime);
+                           cols.exposure().put(row, theIntegrationTime);
+                           cols.antenna1().put(row, casacore::Int(ant1));
+                           cols.antenna2().put(row, casacore::Int(ant2));
+                           cols.feed1().put(row, casacore::Int(beam));
+                           cols.feed2().put(row, casacore::Int(beam));
+                           cols.dataDescId().put(row, casacore::Int(spw));
+                           cols.fieldId().put(row, 0);
+                           cols.arrayId().put(row, 0);
+                           cols.observationId().put(row, 0);
+                           cols.processorId().put(row, -1);
+                           cols.scanNumber().put(row, 1);
+                           cols.stateId().put(row, -1);
+                           cols.uvw().put(row, uvw);
+                           cols.data().put(row, vis);
+                           cols.flag().put(row, flag);
+                           cols.flagRow().put(row, false);
+                           cols.sigma().put(row, sigma);
+                           cols.weight().put(row, weight);
+                      }
+                 }
+            }
+       }
+  }
+  ASKAPDEBUGASSERT(row == nRows());
+}
@@ -0,0 +1,145 @@
+/// @file
+///
+/// @brief Generator of synthetic measurement sets for benchmarking
+/// @details Benchmarks need datasets of a controlled size which can be recreated on any
+/// machine. This class writes a measurement set with the given number of antennas, beams,
+/// spectral windows (data descriptors), channels and integrations. All values are derived
+/// from a fixed seed, so the same parameters always give the same dataset.
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef ASKAP_ACCESSORS_SYNTHETIC_MS_GENERATOR_H
+#define ASKAP_ACCESSORS_SYNTHETIC_MS_GENERATOR_H
+
+// casa includes
+#include <casacore/casa/aips.h>
+
+// std includes
+#include <string>
+
+namespace askap {
+
+namespace accessors {
+
+/// @brief Generator of synthetic measurement sets for benchmarking
+/// @details The dataset contains cross- and auto-correlations of all antennas for each
+/// beam (feed), spectral window and integration, ordered by time. Visibilities are those of
+/// a point source at the phase centre with a small deterministic noise, a fraction of all
+/// samples is flagged. DATA and FLAG columns are written with the tiled storage manager.
+/// Antennas are located around the ASKAP site, beams are offset along a line.
+class SyntheticMSGenerator {
+public:
+  /// @brief set up default parameters
+  /// @details Defaults give a dataset of a few tens of megabytes.
+  SyntheticMSGenerator();
+
+  /// @brief set the number of antennas
+  /// @param[in] nAnt number of antennas (at least 2)
+  void setNumberOfAntennas(casacore::uInt nAnt);
+
+  /// @brief set the number of beams
+  /// @param[in] nBeam number of beams (feeds), which are correlated independently
+  void setNumberOfBeams(casacore::uInt nBeam);
+
+  /// @brief set the number of spectral windows
+  /// @details Each spectral window has its own data descriptor
+  /// @param[in] nSpw number of spectral windows
+  void setNumberOfSpectralWindows(casacore::uInt nSpw);
+
+  /// @brief set the number of spectral channels per spectral window
+  /// @param[in] nChan number of channels
+  void setNumberOfChannels(casacore::uInt nChan);
+
+  /// @brief set the number of integrations
+  /// @param[in] nTimes number of time steps
+  void setNumberOfIntegrations(casacore::uInt nTimes);
+
+  /// @brief set the fraction of flagged samples
+  /// @param[in] fraction fraction of visibilities to flag (between 0 and 1)
+  void setFlaggedFraction(double fraction);
+
+  /// @return number of antennas
+  inline casacore::uInt nAntennas() const { return itsNAnt; }
+
+  /// @return number of beams
+  inline casacore::uInt nBeams() const { return itsNBeam; }
+
+  /// @return number of spectral windows
+  inline casacore::uInt nSpectralWindows() const { return itsNSpw; }
+
+  /// @return number of channels per spectral window
+  inline casacore::uInt nChannels() const { return itsNChan; }
+
+  /// @return number of polarisation products
+  inline casacore::uInt nPol() const { return 4; }
+
+  /// @return number of integrations
+  inline casacore::uInt nIntegrations() const { return itsNTimes; }
+
+  /// @return number of rows in the main table
+  casacore::uInt nRows() const;
+
+  /// @return size of the visibility data in bytes
+  size_t dataSize() const;
+
+  /// @brief write the measurement set
+  /// @details An existing table with the same name is overwritten.
+  /// @param[in] name file name of the measurement set
+  void create(const std::string &name) const;
+
+private:
+  /// @brief write the subtables
+  /// @param[in] name file name of the measurement set (should already exist)
+  void fillSubtables(const std::string &name) const;
+
+  /// @brief write the main table
+  /// @param[in] name file name of the measurement set (should already exist)
+  void fillMainTable(const std::string &name) const;
+
+  /// @brief number of antennas
+  casacore::uInt itsNAnt;
+
+  /// @brief number of beams
+  casacore::uInt itsNBeam;
+
+  /// @brief number of spectral windows
+  casacore::uInt itsNSpw;
+
+  /// @brief number of channels per spectral window
+  casacore::uInt itsNChan;
+
+  /// @brief number of integrations
+  casacore::uInt itsNTimes;
+
+  /// @brief fraction of flagged samples
+  double itsFlaggedFraction;
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef ASKAP_ACCESSORS_SYNTHETIC_MS_GENERATOR_H
@@ -0,0 +1,541 @@
+/// @file
+///
+/// @brief Benchmark suite of the accessor stack
+/// @details This program generates a synthetic measurement set of the given size and
+/// times the typical operations of the data access layer on it: iteration, reading of
+/// individual accessor fields, selector and iterator creation, uvw rotation, buffer
+/// input/output, calibration solution lookup and image input/output. Results are written
+/// in the JSON format, so they can be compared between revisions and machines.
+///
+/// Usage: benchaccessors [--antennas N] [--beams N] [--spws N] [--channels N] [--times N]
+///                       [--imagesize N] [--repeat N] [--filter substring]
+///                       [--workdir dir] [--output file.json]
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include "SyntheticMSGenerator.h"
+#include "BenchmarkRunner.h"
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/TableConstDataSource.h>
+#include <askap/dataaccess/SharedIter.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/calibaccess/TableCalSolutionSource.h>
+#include <askap/calibaccess/TableCalSolutionConstSource.h>
+#include <askap/calibaccess/JonesIndex.h>
+#include <askap/imageaccess/ImageAccessFactory.h>
+
+ASKAP_LOGGER(logger, ".benchaccessors");
+
+// casa includes
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/coordinates/Coordinates/CoordinateSystem.h>
+#include <casacore/coordinates/Coordinates/DirectionCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+#include <casacore/coordinates/Coordinates/Projection.h>
+#include <casacore/measures/Measures/MDirection.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+
+// other 3rd party
+#include <Common/ParameterSet.h>
+
+// std includes
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <map>
+
+using namespace askap;
+using namespace askap::accessors;
+
+/// @brief benchmarks of the accessor stack
+/// @details All benchmarks operate on the synthetic measurement set and a number of
+/// auxiliary files created in the working directory.
+class AccessorBenchmarks : public boost::noncopyable {
+public:
+  /// @brief set up the benchmarks
+  /// @param[in] gen generator of the dataset (the measurement set is created here)
+  /// @param[in] workDir working directory for all files
+  /// @param[in] imageSize number of pixels along each spatial axis of the test image
+  AccessorBenchmarks(const SyntheticMSGenerator &gen, const std::string &workDir, casacore::uInt imageSize);
+
+  /// @brief register all benchmarks with the runner
+  /// @param[in] runner benchmark runner
+  void registerBenchmarks(BenchmarkRunner &runner);
+
+private:
+  /// @brief iterate over the dataset without accessing the data
+  /// @param[out] counts number of rows
+  void iterate(BenchmarkRunner::Counts &counts) const;
+
+  /// @brief iterate over the dataset reading the given accessor field
+  /// @param[in] field accessor field to read (one of IDataSelector::AccessorFields values)
+  /// @param[out] counts number of rows and bytes read
+  void fill(casacore::uInt field, BenchmarkRunner::Counts &counts) const;
+
+  /// @brief create selectors and iterators
+  /// @param[out] counts number of iterators created
+  void createIterators(BenchmarkRunner::Counts &counts) const;
+
+  /// @brief iterate over the dataset computing uvw for a tangent point offset from the phase centre
+  /// @param[out] counts number of rows and bytes of rotated uvw
+  void rotateUVW(BenchmarkRunner::Counts &counts) const;
+
+  /// @brief copy visibilities into a buffer
+  /// @param[in] ds data source to use
+  /// @param[out] counts number of rows and bytes written
+  void writeBuffer(const boost::shared_ptr<IDataSource> &ds, BenchmarkRunner::Counts &counts) const;
+
+  /// @brief read visibilities from a buffer
+  /// @param[in] ds data source to use (writeBuffer should be called first)
+  /// @param[out] counts number of rows and bytes read
+  void readBuffer(const boost::shared_ptr<IDataSource> &ds, BenchmarkRunner::Counts &counts) const;
+
+  /// @brief write calibration solution for all antennas, beams and channels
+  /// @param[out] counts number of Jones terms written
+  void writeCalibration(BenchmarkRunner::Counts &counts) const;
+
+  /// @brief look up calibration solution for all antennas, beams and channels
+  /// @param[out] counts number of Jones terms read
+  void readCalibration(BenchmarkRunner::Counts &counts) const;
+
+  /// @brief create and write an image
+  /// @param[in] type image type ("casa" or "fits")
+  /// @param[out] counts number of pixels and bytes written
+  void writeImage(const std::string &type, BenchmarkRunner::Counts &counts) const;
+
+  /// @brief read an image
+  /// @param[in] type image type ("casa" or "fits", writeImage should be called first)
+  /// @param[out] counts number of pixels and bytes read
+  void readImage(const std::string &type, BenchmarkRunner::Counts &counts) const;
+
+  /// @brief dataset generator
+  const SyntheticMSGenerator &itsGenerator;
+
+  /// @brief working directory
+  std::string itsWorkDir;
+
+  /// @brief name of the measurement set
+  std::string itsMSName;
+
+  /// @brief name of the calibration table
+  std::string itsCalName;
+
+  /// @brief number of pixels along each spatial axis of the test image
+  casacore::uInt itsImageSize;
+
+  /// @brief read-only data source
+  boost::shared_ptr<IConstDataSource> itsROSource;
+
+  /// @brief data source with buffers held in memory
+  boost::shared_ptr<IDataSource> itsMemBufferSource;
+
+  /// @brief data source with buffers held in the measurement set
+  boost::shared_ptr<IDataSource> itsTableBufferSource;
+
+  /// @brief pixels of the test image
+  casacore::Array<casacore::Float> itsPixels;
+};
+
+/// @brief set up the benchmarks
+/// @param[in] gen generator of the dataset (the measurement set is created here)
+/// @param[in] workDir working directory for all files
+/// @param[in] imageSize number of pixels along each spatial axis of the test image
+AccessorBenchmarks::AccessorBenchmarks(const SyntheticMSGenerator &gen, const std::string &workDir,
+                    casacore::uInt imageSize) : itsGenerator(gen), itsWorkDir(workDir),
+      itsMSName(workDir + "/synthetic.ms"), itsCalName(workDir + "/calibration.tab"), itsImageSize(imageSize)
+{
+  ASKAPCHECK(itsImageSize > 0, "Image size should be positive");
+  const casacore::File dir(itsWorkDir);
+  if (!dir.exists()) {
+      casacore::Directory(itsWorkDir).create();
+  }
+  const casacore::File ms(itsMSName);
+  if (ms.exists()) {
+      casacore::Directory(itsMSName).removeRecursive();
+  }
+  itsGenerator.create(itsMSName);
+  itsROSource.reset(new TableConstDataSource(itsMSName));
+  itsMemBufferSource.reset(new TableDataSource(itsMSName, TableDataSource::MEMORY_BUFFERS));
+  itsTableBufferSource.reset(new TableDataSource(itsMSName, TableDataSource::WRITE_PERMITTED));
+  itsPixels.resize(casacore::IPosition(3, itsImageSize, itsImageSize, itsGenerator.nChannels()));
+  itsPixels.set(1.);
+}
+
+/// @brief register all benchmarks with the runner
+/// @param[in] runner benchmark runner
+void AccessorBenchmarks::registerBenchmarks(BenchmarkRunner &runner)
+{
+  runner.add("iteration", "rows", boost::bind(&AccessorBenchmarks::iterate, this, _1));
+  runner.add("fill.visibility", "rows", boost::bind(&AccessorBenchmarks::fill, this,
+             casacore::uInt(IDataSelector::VISIBILITY), _1));
+  runner.add("fill.flag", "rows", boost::bind(&AccessorBenchmarks::fill, this,
+             casacore::uInt(IDataSelector::FLAG), _1));
+  runner.add("fill.noise", "rows", boost::bind(&AccessorBenchmarks::fill, this,
+             casacore::uInt(IDataSelector::NOISE), _1));
+  runner.add("fill.uvw", "rows", boost::bind(&AccessorBenchmarks::fill, this,
+             casacore::uInt(IDataSelector::UVW), _1));
+  runner.add("fill.frequency", "rows", boost::bind(&AccessorBenchmarks::fill, this,
+             casacore::uInt(IDataSelector::FREQUENCY), _1));
+  runner.add("fill.pointing", "rows", boost::bind(&AccessorBenchmarks::fill, this,
+             casacore::uInt(IDataSelector::POINTING), _1));
+  runner.add("fill.feedPA", "rows", boost::bind(&AccessorBenchmarks::fill, this,
+             casacore::uInt(IDataSelector::FEED_PA), _1));
+  runner.add("selector", "iterators", boost::bind(&AccessorBenchmarks::createIterators, this, _1));
+  runner.add("rotatedUVW", "rows", boost::bind(&AccessorBenchmarks::rotateUVW, this, _1));
+  // reading requires the buffer to be written, this is ensured by the order of benchmarks
+  runner.add("buffer.memory.write", "rows", boost::bind(&AccessorBenchmarks::writeBuffer, this,
+             itsMemBufferSource, _1));
+  runner.add("buffer.memory.read", "rows", boost::bind(&AccessorBenchmarks::readBuffer, this,
+             itsMemBufferSource, _1));
+  runner.add("buffer.table.write", "rows", boost::bind(&AccessorBenchmarks::writeBuffer, this,
+             itsTableBufferSource, _1));
+  runner.add("buffer.table.read", "rows", boost::bind(&AccessorBenchmarks::readBuffer, this,
+             itsTableBufferSource, _1));
+  runner.add("calibration.write", "terms", boost::bind(&AccessorBenchmarks::writeCalibration, this, _1));
+  runner.add("calibration.read", "terms", boost::bind(&AccessorBenchmarks::readCalibration, this, _1));
+  runner.add("image.casa.write", "pixels", boost::bind(&AccessorBenchmarks::writeImage, this,
+             std::string("casa"), _1));
+  runner.add("image.casa.read", "pixels", boost::bind(&AccessorBenchmarks::readImage, this,
+             std::string("casa"), _1));
+  runner.add("image.fits.write", "pixels", boost::bind(&AccessorBenchmarks::writeImage, this,
+             std::string("fits"), _1));
+  runner.add("image.fits.read", "pixels", boost::bind(&AccessorBenchmarks::readImage, this,
+             std::string("fits"), _1));
+}
+
+/// @brief iterate over the dataset without accessing the data
+/// @param[out] counts number of rows
+void AccessorBenchmarks::iterate(BenchmarkRunner::Counts &counts) const
+{
+  for (IConstDataSharedIter it = itsROSource->createConstIterator(); it != it.end(); ++it) {
+       counts.itsItems += it->nRow();
+  }
+}
+
+/// @brief iterate over the dataset reading the given accessor field
+/// @param[in] field accessor field to read (one of IDataSelector::AccessorFields values)
+/// @param[out] counts number of rows and bytes read
+void AccessorBenchmarks::fill(casacore::uInt field, BenchmarkRunner::Counts &counts) const
+{
+  for (IConstDataSharedIter it = itsROSource->createConstIterator(); it != it.end(); ++it) {
+       counts.itsItems += it->nRow();
+       switch (field) {
+          case IDataSelector::VISIBILITY:
+               counts.itsBytes += it->visibility().nelements() * sizeof(casacore::Complex);
+               break;
+          case IDataSelector::FLAG:
+               counts.itsBytes += it->flag().nelements() * sizeof(casacore::Bool);
+               break;
+          case IDataSelector::NOISE:
+               counts.itsBytes += it->noise().nelements() * sizeof(casacore::Complex);
+               break;
+          case IDataSelector::UVW:
+               counts.itsBytes += it->uvw().nelements() * sizeof(casacore::RigidVector<casacore::Double, 3>);
+               break;
+          case IDataSelector::FREQUENCY:
+               counts.itsBytes += it->frequency().nelements() * sizeof(casacore::Double);
+               break;
+          case IDataSelector::POINTING:
+               counts.itsBytes += (it->pointingDir1().nelements() + it->pointingDir2().nelements()) *
+                                  sizeof(casacore::MVDirection);
+               break;
+          case IDataSelector::FEED_PA:
+               counts.itsBytes += (it->feed1PA().nelements() + it->feed2PA().nelements()) *
+                                  sizeof(casacore::Float);
+               break;
+          default:
+               ASKAPTHROW(AskapError, "Field "<<field<<" is not supported by the benchmark");
+       }
+  }
+}
+
+/// @brief create selectors and iterators
+/// @details Selection of a single beam and cross-correlations is typical for imaging
+/// @param[out] counts number of iterators created
+void AccessorBenchmarks::createIterators(BenchmarkRunner::Counts &counts) const
+{
+  const casacore::uInt nIterators = 100;
+  for (casacore::uInt i = 0; i < nIterators; ++i) {
+       IDataSelectorPtr sel = itsROSource->createSelector();
+       sel->chooseFeed(i % itsGenerator.nBeams());
+       sel->chooseCrossCorrelations();
+       IDataConverterPtr conv = itsROSource->createConverter();
+       const IConstDataSharedIter it = itsROSource->createConstIterator(sel, conv);
+       ++counts.itsItems;
+  }
+}
+
+/// @brief iterate over the dataset computing uvw for a tangent point offset from the phase centre
+/// @param[out] counts number of rows and bytes of rotated uvw
+void AccessorBenchmarks::rotateUVW(BenchmarkRunner::Counts &counts) const
+{
+  // the synthetic field is at RA=0, Dec=-45 deg, the tangent point is one degree away
+  const casacore::MDirection tangent(casacore::MVDirection(casacore::Quantity(1., "deg"),
+                                     casacore::Quantity(-45., "deg")), casacore::MDirection::J2000);
+  for (IConstDataSharedIter it = itsROSource->createConstIterator(); it != it.end(); ++it) {
+       counts.itsItems += it->nRow();
+       counts.itsBytes += it->rotatedUVW(tangent).nelements() * sizeof(casacore::RigidVector<casacore::Double, 3>);
+  }
+}
+
+/// @brief copy visibilities into a buffer
+/// @param[in] ds data source to use
+/// @param[out] counts number of rows and bytes written
+void AccessorBenchmarks::writeBuffer(const boost::shared_ptr<IDataSource> &ds,
+                                     BenchmarkRunner::Counts &counts) const
+{
+  ASKAPDEBUGASSERT(ds);
+  IDataSharedIter it = ds->createIterator();
+  for (it.init(); it != it.end(); it.next()) {
+       it.buffer("BENCHMARK").rwVisibility() = it->visibility();
+       counts.itsItems += it->nRow();
+       counts.itsBytes += it->visibility().nelements() * sizeof(casacore::Complex);
+  }
+}
+
+/// @brief read visibilities from a buffer
+/// @param[in] ds data source to use (writeBuffer should be called first)
+/// @param[out] counts number of rows and bytes read
+void AccessorBenchmarks::readBuffer(const boost::shared_ptr<IDataSource> &ds,
+                                    BenchmarkRunner::Counts &counts) const
+{
+  ASKAPDEBUGASSERT(ds);
+  IDataSharedIter it = ds->createIterator();
+  for (it.init(); it != it.end(); it.next()) {
+       const casacore::Cube<casacore::Complex> &vis = it.buffer("BENCHMARK").visibility();
+       counts.itsItems += it->nRow();
+       counts.itsBytes += vis.nelements() * sizeof(casacore::Complex);
+  }
+}
+
+/// @brief write calibration solution for all antennas, beams and channels
+/// @details The table is recreated every time, so the amount of work is the same for each run
+/// @param[out] counts number of Jones terms written
+void AccessorBenchmarks::writeCalibration(BenchmarkRunner::Counts &counts) const
+{
+  TableCalSolutionSource::removeOldTable(itsCalName);
+  const casacore::uInt nAnt = itsGenerator.nAntennas();
+  const casacore::uInt nBeam = itsGenerator.nBeams();
+  const casacore::uInt nChan = itsGenerator.nChannels();
+  TableCalSolutionSource css(itsCalName, nAnt, nBeam, nChan);
+  const long id = css.newSolutionID(0.);
+  boost::shared_ptr<ICalSolutionAccessor> acc = css.rwSolution(id);
+  ASKAPDEBUGASSERT(acc);
+  for (casacore::uInt ant = 0; ant < nAnt; ++ant) {
+       for (casacore::uInt beam = 0; beam < nBeam; ++beam) {
+            const JonesIndex index(ant, beam);
+            acc->setGain(index, JonesJTerm(casacore::Complex(1., 0.), true, casacore::Complex(1., 0.), true));
+            ++counts.itsItems;
+            for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                 acc->setBandpass(index, JonesJTerm(casacore::Complex(1., 0.), true,
+                                  casacore::Complex(1., 0.), true), chan);
+                 ++counts.itsItems;
+            }
+       }
+  }
+}
+
+/// @brief look up calibration solution for all antennas, beams and channels
+/// @param[out] counts number of Jones terms read
+void AccessorBenchmarks::readCalibration(BenchmarkRunner::Counts &counts) const
+{
+  const TableCalSolutionConstSource css(itsCalName);
+  boost::shared_ptr<ICalSolutionConstAccessor> acc = css.roSolution(css.mostRecentSolution());
+  ASKAPDEBUGASSERT(acc);
+  for (casacore::uInt ant = 0; ant < itsGenerator.nAntennas(); ++ant) {
+       for (casacore::uInt beam = 0; beam < itsGenerator.nBeams(); ++beam) {
+            const JonesIndex index(ant, beam);
+            ASKAPCHECK(acc->gain(index).g1IsValid(), "Gain for antenna "<<ant<<" beam "<<beam<<" is not valid");
+            ++counts.itsItems;
+            for (casacore::uInt chan = 0; chan < itsGenerator.nChannels(); ++chan) {
+                 ASKAPCHECK(acc->bandpass(index, chan).g1IsValid(), "Bandpass for antenna "<<ant<<" beam "<<
+                            beam<<" channel "<<chan<<" is not valid");
+                 ++counts.itsItems;
+            }
+       }
+  }
+}
+
+/// @brief create and write an image
+/// @param[in] type image type ("casa" or "fits")
+/// @param[out] counts number of pixels and bytes written
+void AccessorBenchmarks::writeImage(const std::string &type, BenchmarkRunner::Counts &counts) const
+{
+  LOFAR::ParameterSet parset;
+  parset.add("imagetype", type);
+  boost::shared_ptr<IImageAccess<casacore::Float> > ia = imageAccessFactory(parset);
+  ASKAPDEBUGASSERT(ia);
+  casacore::Matrix<casacore::Double> xform(2, 2, 0.);
+  xform.diagonal() = 1.;
+  const casacore::DirectionCoordinate radec(casacore::MDirection::J2000, casacore::Projection(casacore::Projection::SIN),
+             0., -casacore::C::pi / 4., -casacore::C::pi / 180. / 3600., casacore::C::pi / 180. / 3600.,
+             xform, itsImageSize / 2., itsImageSize / 2.);
+  const casacore::SpectralCoordinate spectral(casacore::MFrequency::TOPO, 7e8, 1e6, 0., 1420.40575e6);
+  casacore::CoordinateSystem csys;
+  csys.addCoordinate(radec);
+  csys.addCoordinate(spectral);
+  const std::string name = itsWorkDir + "/image." + type;
+  ia->create(name, itsPixels.shape(), csys);
+  ia->write(name, itsPixels);
+  counts.itsItems += itsPixels.nelements();
+  counts.itsBytes += itsPixels.nelements() * sizeof(casacore::Float);
+}
+
+/// @brief read an image
+/// @param[in] type image type ("casa" or "fits", writeImage should be called first)
+/// @param[out] counts number of pixels and bytes read
+void AccessorBenchmarks::readImage(const std::string &type, BenchmarkRunner::Counts &counts) const
+{
+  LOFAR::ParameterSet parset;
+  parset.add("imagetype", type);
+  boost::shared_ptr<IImageAccess<casacore::Float> > ia = imageAccessFactory(parset);
+  ASKAPDEBUGASSERT(ia);
+  const casacore::Array<casacore::Float> pixels = ia->read(itsWorkDir + "/image." + type);
+  ASKAPCHECK(pixels.shape() == itsPixels.shape(), "Image read back has shape "<<pixels.shape()<<
+             ", expected "<<itsPixels.shape());
+  counts.itsItems += pixels.nelements();
+  counts.itsBytes += pixels.nelements() * sizeof(casacore::Float);
+}
+
+/// @brief parse command line options
+/// @details All options have the form --name value
+/// @param[in] argc number of arguments
+/// @param[in] argv arguments
+/// @param[in] defaults names of allowed options with their default values
+/// @return map of option names (without dashes) to values
+std::map<std::string, std::string> parseOptions(int argc, char **argv, const std::map<std::string, std::string> &defaults)
+{
+  std::map<std::string, std::string> result(defaults);
+  for (int arg = 1; arg < argc; arg += 2) {
+       const std::string name(argv[arg]);
+       ASKAPCHECK((name.size() > 2) && (name.compare(0, 2, "--") == 0), "Options should start with --, you have "<<name);
+       ASKAPCHECK(result.find(name.substr(2)) != result.end(), "Unknown option "<<name);
+       ASKAPCHECK(arg + 1 < argc, "Option "<<name<<" requires a value");
+       result[name.substr(2)] = argv[arg + 1];
+  }
+  return result;
+}
+
+/// @brief convert the option value to a number
+/// @param[in] options parsed options
+/// @param[in] name name of the option
+/// @return numeric value
+casacore::uInt numericOption(const std::map<std::string, std::string> &options, const std::string &name)
+{
+  const std::map<std::string, std::string>::const_iterator ci = options.find(name);
+  ASKAPDEBUGASSERT(ci != options.end());
+  std::istringstream is(ci->second);
+  casacore::uInt result = 0;
+  is >> result;
+  ASKAPCHECK(!is.fail() && is.eof(), "Option --"<<name<<" requires a non-negative integer, you have "<<ci->second);
+  return result;
+}
+
+int main(int argc, char **argv) {
+  try {
+     if (!ASKAPLOG_ISCONFIGURED) {
+         const std::ifstream config("askap.log_cfg", std::ifstream::in);
+         if (config) {
+             ASKAPLOG_INIT("askap.log_cfg");
+         } else {
+             std::ostringstream ss;
+             ss << argv[0] << ".log_cfg";
+             ASKAPLOG_INIT(ss.str().c_str());
+         }
+     }
+     std::map<std::string, std::string> defaults;
+     defaults["antennas"] = "12";
+     defaults["beams"] = "1";
+     defaults["spws"] = "1";
+     defaults["channels"] = "256";
+     defaults["times"] = "20";
+     defaults["imagesize"] = "256";
+     defaults["repeat"] = "5";
+     defaults["filter"] = "";
+     defaults["workdir"] = "benchaccessors.tmp";
+     defaults["output"] = "benchaccessors.json";
+     const std::map<std::string, std::string> options = parseOptions(argc, argv, defaults);
+
+     SyntheticMSGenerator gen;
+     gen.setNumberOfAntennas(numericOption(options, "antennas"));
+     gen.setNumberOfBeams(numericOption(options, "beams"));
+     gen.setNumberOfSpectralWindows(numericOption(options, "spws"));
+     gen.setNumberOfChannels(numericOption(options, "channels"));
+     gen.setNumberOfIntegrations(numericOption(options, "times"));
+
+     BenchmarkRunner runner(numericOption(options, "repeat"), options.find("filter")->second);
+     for (std::map<std::string, std::string>::const_iterator ci = options.begin(); ci != options.end(); ++ci) {
+          if ((ci->first != "output") && (ci->first != "workdir")) {
+              runner.setParameter(ci->first, ci->second);
+          }
+     }
+     runner.setParameter("version", ASKAP_PACKAGE_VERSION);
+     runner.setParameter("rows", std::to_string(gen.nRows()));
+     runner.setParameter("data_bytes", std::to_string(gen.dataSize()));
+     runner.setParameter("statistics", DataAccessStatistics::enabled() ? "enabled" : "disabled");
+
+     AccessorBenchmarks benchmarks(gen, options.find("workdir")->second, numericOption(options, "imagesize"));
+     benchmarks.registerBenchmarks(runner);
+     runner.run();
+
+     const std::string output = options.find("output")->second;
+     if (output == "-") {
+         runner.writeJSON(std::cout);
+     } else {
+         std::ofstream os(output.c_str());
+         ASKAPCHECK(os, "Unable to open "<<output<<" for writing");
+         runner.writeJSON(os);
+         ASKAPLOG_INFO_STR(logger, "Results have been written to "<<output);
+     }
+     // summary is only available if ASKAP_DATAACCESS_STATISTICS is set in the environment
+     DataAccessStatistics::log();
+  }
+  catch(const AskapError &ce) {
+     std::cerr<<"AskapError has been caught. "<<ce.what()<<std::endl;
+     return -1;
+  }
+  catch(const std::exception &ex) {
+     std::cerr<<"std::exception has been caught. "<<ex.what()<<std::endl;
+     return -1;
+  }
+  catch(...) {
+     std::cerr<<"An unexpected exception has been caught"<<std::endl;
+     return -1;
+  }
+  return 0;
+}
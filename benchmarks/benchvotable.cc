@@ -0,0 +1,560 @@
+/// @file
+///
+/// @brief Benchmark suite of the VOTable classes
+/// @details This program generates synthetic catalogues of the given sizes and times
+/// parsing and serialisation through the DOM interface (VOTable::fromXML/toXML) and the
+/// streaming interface (VOTableReader/VOTableWriter) for the TABLEDATA, BINARY and
+/// BINARY2 serialisations. Besides the throughput, the peak resident memory and the
+/// number of heap allocations per row are recorded for each benchmark. Results are
+/// written in the JSON format, so they can be compared between revisions and machines.
+///
+/// Usage: benchvotable [--rows N1,N2,...] [--maxdomrows N] [--nullfraction x]
+///                     [--repeat N] [--filter substring] [--workdir dir] [--output file.json]
+///
+/// The DOM benchmarks hold the whole catalogue in memory and are skipped for catalogues
+/// with more than maxdomrows rows. The peak memory is reset before each run via
+/// /proc/self/clear_refs; if this is not supported by the kernel, the reported peak
+/// covers the whole lifetime of the process (see the peak_rss_reset parameter).
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+// own includes
+#include "SyntheticCatalogueGenerator.h"
+#include "BenchmarkRunner.h"
+#include <askap_accessors.h>
+#include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
+#include <askap/votable/VOTable.h>
+#include <askap/votable/VOTableReader.h>
+#include <askap/votable/VOTableWriter.h>
+#include <askap/votable/VOTableResource.h>
+
+ASKAP_LOGGER(logger, ".benchvotable");
+
+// casa includes
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/RegularFile.h>
+
+// boost includes
+#include <boost/bind.hpp>
+#include <boost/noncopyable.hpp>
+
+// std includes
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <map>
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+using namespace askap;
+using namespace askap::accessors;
+
+namespace {
+
+/// @brief number of heap allocations made by the process so far
+std::atomic<size_t> theAllocations(0);
+
+} // anonymous namespace
+
+// the global allocation functions are replaced to count allocations, the memory itself
+// is managed by malloc as usual
+
+void* operator new(std::size_t size)
+{
+  ++theAllocations;
+  void* ptr = std::malloc(size > 0 ? size : 1);
+  if (ptr == 0) {
+      throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  ++theAllocations;
+  return std::malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  std::free(ptr);
+}
+
+/// @brief read a memory counter of this process
+/// @param[in] key name of the counter in /proc/self/status (e.g. "VmRSS:")
+/// @return value in kB (zero if it can't be determined)
+long memoryCounter(const std::string &key)
+{
+  std::ifstream is("/proc/self/status");
+  std::string line;
+  while (std::getline(is, line)) {
+         if (line.compare(0, key.size(), key) == 0) {
+             std::istringstream iss(line.substr(key.size()));
+             long result = 0;
+             iss >> result;
+             return result;
+         }
+  }
+  return 0;
+}
+
+/// @brief reset the peak resident memory of this process to the current value
+/// @return true, if the kernel supports the reset
+bool resetPeakMemory()
+{
+  std::ofstream os("/proc/self/clear_refs");
+  os << "5";
+  os.close();
+  return !os.fail();
+}
+
+/// @brief run a benchmark recording its memory usage and allocations
+/// @details The benchmark's own counts are used, the metrics are added to them:
+/// allocations_per_row, peak_rss_kb (peak resident memory of the process during the run)
+/// and peak_increase_kb (peak over the resident memory at the start of the run).
+/// @param[in] bench benchmark to run
+/// @param[in] nRows number of rows in the catalogue, to normalise the allocations
+/// @param[out] counts counts of the benchmark with the metrics
+void measure(const BenchmarkRunner::Benchmark &bench, size_t nRows, BenchmarkRunner::Counts &counts)
+{
+  resetPeakMemory();
+  const long startMemory = memoryCounter("VmRSS:");
+  const size_t startAllocations = theAllocations;
+  bench(counts);
+  const size_t allocations = theAllocations - startAllocations;
+  const long peakMemory = memoryCounter("VmHWM:");
+  counts.itsMetrics["allocations_per_row"] = nRows > 0 ? double(allocations) / nRows : double(allocations);
+  counts.itsMetrics["peak_rss_kb"] = peakMemory;
+  counts.itsMetrics["peak_increase_kb"] = peakMemory > startMemory ? peakMemory - startMemory : 0;
+}
+
+/// @brief row callback doing nothing
+/// @details Used to measure the cost of the streaming reader alone
+void ignoreRow(const VOTableTable&, const VOTableRow&) {}
+
+/// @brief benchmarks of the VOTable classes
+/// @details Catalogues of all sizes are written into the working directory in every
+/// serialisation when the object is created, the reading benchmarks use these files.
+class VOTableBenchmarks : public boost::noncopyable {
+public:
+  /// @brief set up the benchmarks
+  /// @param[in] sizes numbers of rows of the catalogues
+  /// @param[in] maxDOMRows maximum number of rows for the DOM benchmarks
+  /// @param[in] nullFraction fraction of null cells
+  /// @param[in] workDir working directory for all files
+  VOTableBenchmarks(const std::vector<size_t> &sizes, size_t maxDOMRows, double nullFraction,
+                    const std::string &workDir);
+
+  /// @brief register all benchmarks with the runner
+  /// @param[in] runner benchmark runner
+  void registerBenchmarks(BenchmarkRunner &runner);
+
+private:
+  /// @brief parse the catalogue file into memory
+  /// @param[in] nRows number of rows of the catalogue
+  /// @param[in] format serialisation of the catalogue
+  /// @param[out] counts number of rows and bytes read
+  void domRead(size_t nRows, VOTableTable::DataFormat format, BenchmarkRunner::Counts &counts) const;
+
+  /// @brief serialise the catalogue held in memory
+  /// @details The catalogue is built on the first call (i.e. during the warm-up run)
+  /// and kept until a catalogue of another size or serialisation is requested.
+  /// @param[in] nRows number of rows of the catalogue
+  /// @param[in] format serialisation of the catalogue
+  /// @param[out] counts number of rows and bytes written
+  void domWrite(size_t nRows, VOTableTable::DataFormat format, BenchmarkRunner::Counts &counts);
+
+  /// @brief read the catalogue file row by row without keeping the rows
+  /// @param[in] nRows number of rows of the catalogue
+  /// @param[in] format serialisation of the catalogue
+  /// @param[out] counts number of rows and bytes read
+  void streamRead(size_t nRows, VOTableTable::DataFormat format, BenchmarkRunner::Counts &counts) const;
+
+  /// @brief write the catalogue row by row as it is generated
+  /// @param[in] nRows number of rows of the catalogue
+  /// @param[in] format serialisation of the catalogue
+  /// @param[out] counts number of rows and bytes written
+  void streamWrite(size_t nRows, VOTableTable::DataFormat format, BenchmarkRunner::Counts &counts) const;
+
+  /// @brief generator for the given number of rows
+  /// @param[in] nRows number of rows of the catalogue
+  /// @return generator
+  SyntheticCatalogueGenerator generator(size_t nRows) const;
+
+  /// @brief name of the catalogue file
+  /// @param[in] what "input" for the files read by the benchmarks, "output" for those written
+  /// @param[in] nRows number of rows of the catalogue
+  /// @param[in] format serialisation of the catalogue
+  /// @return file name in the working directory
+  std::string fileName(const std::string &what, size_t nRows, VOTableTable::DataFormat format) const;
+
+  /// @brief name of the serialisation
+  /// @param[in] format serialisation
+  /// @return lower case name used in file and benchmark names
+  static std::string formatName(VOTableTable::DataFormat format);
+
+  /// @brief size of the file
+  /// @param[in] name file name
+  /// @return size in bytes
+  static size_t fileSize(const std::string &name);
+
+  /// @brief numbers of rows of the catalogues
+  std::vector<size_t> itsSizes;
+
+  /// @brief maximum number of rows for the DOM benchmarks
+  size_t itsMaxDOMRows;
+
+  /// @brief fraction of null cells
+  double itsNullFraction;
+
+  /// @brief working directory
+  std::string itsWorkDir;
+
+  /// @brief catalogue held in memory for domWrite
+  VOTable itsCachedVOTable;
+
+  /// @brief number of rows of the cached catalogue (zero if nothing is cached)
+  size_t itsCachedRows;
+
+  /// @brief serialisation of the cached catalogue
+  VOTableTable::DataFormat itsCachedFormat;
+};
+
+/// @brief serialisations covered by the benchmarks
+const VOTableTable::DataFormat theFormats[] = {VOTableTable::TABLEDATA, VOTableTable::BINARY,
+                                               VOTableTable::BINARY2};
+
+/// @brief set up the benchmarks
+/// @param[in] sizes numbers of rows of the catalogues
+/// @param[in] maxDOMRows maximum number of rows for the DOM benchmarks
+/// @param[in] nullFraction fraction of null cells
+/// @param[in] workDir working directory for all files
+VOTableBenchmarks::VOTableBenchmarks(const std::vector<size_t> &sizes, size_t maxDOMRows, double nullFraction,
+                    const std::string &workDir) : itsSizes(sizes), itsMaxDOMRows(maxDOMRows),
+      itsNullFraction(nullFraction), itsWorkDir(workDir), itsCachedRows(0),
+      itsCachedFormat(VOTableTable::TABLEDATA)
+{
+  ASKAPCHECK(!itsSizes.empty(), "At least one catalogue size is required");
+  const casacore::File dir(itsWorkDir);
+  if (!dir.exists()) {
+      casacore::Directory(itsWorkDir).create();
+  }
+  for (size_t i = 0; i < itsSizes.size(); ++i) {
+       for (size_t f = 0; f < sizeof(theFormats) / sizeof(theFormats[0]); ++f) {
+            const std::string name = fileName("input", itsSizes[i], theFormats[f]);
+            generator(itsSizes[i]).write(name, theFormats[f]);
+            ASKAPLOG_INFO_STR(logger, "Catalogue "<<name<<" has "<<itsSizes[i]<<" rows and "<<
+                              fileSize(name)<<" bytes");
+       }
+  }
+}
+
+/// @brief register all benchmarks with the runner
+/// @param[in] runner benchmark runner
+void VOTableBenchmarks::registerBenchmarks(BenchmarkRunner &runner)
+{
+  for (size_t i = 0; i < itsSizes.size(); ++i) {
+       const size_t nRows = itsSizes[i];
+       for (size_t f = 0; f < sizeof(theFormats) / sizeof(theFormats[0]); ++f) {
+            const VOTableTable::DataFormat format = theFormats[f];
+            const std::string suffix = "." + formatName(format) + "." + std::to_string(nRows);
+            // the inner benchmark is wrapped into boost::function, so it isn't evaluated by the outer bind
+            runner.add("stream.write" + suffix, "rows", boost::bind(&measure, BenchmarkRunner::Benchmark(
+                       boost::bind(&VOTableBenchmarks::streamWrite, this, nRows, format, _1)), nRows, _1));
+            runner.add("stream.read" + suffix, "rows", boost::bind(&measure, BenchmarkRunner::Benchmark(
+                       boost::bind(&VOTableBenchmarks::streamRead, this, nRows, format, _1)), nRows, _1));
+            if (nRows <= itsMaxDOMRows) {
+                runner.add("dom.write" + suffix, "rows", boost::bind(&measure, BenchmarkRunner::Benchmark(
+                           boost::bind(&VOTableBenchmarks::domWrite, this, nRows, format, _1)), nRows, _1));
+                runner.add("dom.read" + suffix, "rows", boost::bind(&measure, BenchmarkRunner::Benchmark(
+                           boost::bind(&VOTableBenchmarks::domRead, this, nRows, format, _1)), nRows, _1));
+            }
+       }
+  }
+}
+
+/// @brief parse the catalogue file into memory
+/// @param[in] nRows number of rows of the catalogue
+/// @param[in] format serialisation of the catalogue
+/// @param[out] counts number of rows and bytes read
+void VOTableBenchmarks::domRead(size_t nRows, VOTableTable::DataFormat format,
+                                BenchmarkRunner::Counts &counts) const
+{
+  const std::string name = fileName("input", nRows, format);
+  const VOTable vot = VOTable::fromXML(name);
+  ASKAPCHECK(vot.getResource().size() == 1, "Expect a single resource in "<<name);
+  const size_t rowsRead = vot.getResource()[0].getTables()[0].getNRows();
+  ASKAPCHECK(rowsRead == nRows, "Read "<<rowsRead<<" rows from "<<name<<", expected "<<nRows);
+  counts.itsItems += rowsRead;
+  counts.itsBytes += fileSize(name);
+}
+
+/// @brief serialise the catalogue held in memory
+/// @details The catalogue is built on the first call (i.e. during the warm-up run)
+/// and kept until a catalogue of another size or serialisation is requested.
+/// @param[in] nRows number of rows of the catalogue
+/// @param[in] format serialisation of the catalogue
+/// @param[out] counts number of rows and bytes written
+void VOTableBenchmarks::domWrite(size_t nRows, VOTableTable::DataFormat format, BenchmarkRunner::Counts &counts)
+{
+  if ((itsCachedRows != nRows) || (itsCachedFormat != format)) {
+      // release the old catalogue first, so two catalogues are never held at the same time
+      itsCachedVOTable = VOTable();
+      itsCachedVOTable = generator(nRows).makeVOTable(format);
+      itsCachedRows = nRows;
+      itsCachedFormat = format;
+  }
+  const std::string name = fileName("output", nRows, format);
+  itsCachedVOTable.toXML(name);
+  counts.itsItems += nRows;
+  counts.itsBytes += fileSize(name);
+}
+
+/// @brief read the catalogue file row by row without keeping the rows
+/// @param[in] nRows number of rows of the catalogue
+/// @param[in] format serialisation of the catalogue
+/// @param[out] counts number of rows and bytes read
+void VOTableBenchmarks::streamRead(size_t nRows, VOTableTable::DataFormat format,
+                                   BenchmarkRunner::Counts &counts) const
+{
+  const std::string name = fileName("input", nRows, format);
+  // rows passed to a callback are not accumulated in the table
+  VOTableReader reader((VOTableReader::RowCallback(&ignoreRow)));
+  reader.read(name);
+  ASKAPCHECK(reader.rowCount() == nRows, "Read "<<reader.rowCount()<<" rows from "<<name<<", expected "<<nRows);
+  counts.itsItems += reader.rowCount();
+  counts.itsBytes += fileSize(name);
+}
+
+/// @brief write the catalogue row by row as it is generated
+/// @param[in] nRows number of rows of the catalogue
+/// @param[in] format serialisation of the catalogue
+/// @param[out] counts number of rows and bytes written
+void VOTableBenchmarks::streamWrite(size_t nRows, VOTableTable::DataFormat format,
+                                    BenchmarkRunner::Counts &counts) const
+{
+  const std::string name = fileName("output", nRows, format);
+  generator(nRows).write(name, format);
+  counts.itsItems += nRows;
+  counts.itsBytes += fileSize(name);
+}
+
+/// @brief generator for the given number of rows
+/// @param[in] nRows number of rows of the catalogue
+/// @return generator
+SyntheticCatalogueGenerator VOTableBenchmarks::generator(size_t nRows) const
+{
+  SyntheticCatalogueGenerator gen;
+  gen.setNumberOfRows(nRows);
+  gen.setNullFraction(itsNullFraction);
+  return gen;
+}
+
+/// @brief name of the catalogue file
+/// @param[in] what "input" for the files read by the benchmarks, "output" for those written
+/// @param[in] nRows number of rows of the catalogue
+/// @param[in] format serialisation of the catalogue
+/// @return file name in the working directory
+std::string VOTableBenchmarks::fileName(const std::string &what, size_t nRows,
+                                        VOTableTable::DataFormat format) const
+{
+  return itsWorkDir + "/" + what + "." + formatName(format) + "." + std::to_string(nRows) + ".xml";
+}
+
+/// @brief name of the serialisation
+/// @param[in] format serialisation
+/// @return lower case name used in file and benchmark names
+std::string VOTableBenchmarks::formatName(VOTableTable::DataFormat format)
+{
+  switch (format) {
+     case VOTableTable::TABLEDATA:
+          return "tabledata";
+     case VOTableTable::BINARY:
+          return "binary";
+     case VOTableTable::BINARY2:
+          return "binary2";
+  }
+  ASKAPTHROW(AskapError, "Unknown VOTable serialisation "<<int(format));
+}
+
+/// @brief size of the file
+/// @param[in] name file name
+/// @return size in bytes
+size_t VOTableBenchmarks::fileSize(const std::string &name)
+{
+  return casacore::RegularFile(name).size();
+}
+
+/// @brief parse command line options
+/// @details All options have the form --name value
+/// @param[in] argc number of arguments
+/// @param[in] argv arguments
+/// @param[in] defaults names of allowed options with their default values
+/// @return map of option names (without dashes) to values
+std::map<std::string, std::string> parseOptions(int argc, char **argv, const std::map<std::string, std::string> &defaults)
+{
+  std::map<std::string, std::string> result(defaults);
+  for (int arg = 1; arg < argc; arg += 2) {
+       const std::string name(argv[arg]);
+       ASKAPCHECK((name.size() > 2) && (name.compare(0, 2, "--") == 0), "Options should start with --, you have "<<name);
+       ASKAPCHECK(result.find(name.substr(2)) != result.end(), "Unknown option "<<name);
+       ASKAPCHECK(arg + 1 < argc, "Option "<<name<<" requires a value");
+       result[name.substr(2)] = argv[arg + 1];
+  }
+  return result;
+}
+
+/// @brief convert the option value to a list of numbers
+/// @param[in] options parsed options
+/// @param[in] name name of the option
+/// @return numeric values given as a comma separated list
+std::vector<size_t> numericListOption(const std::map<std::string, std::string> &options, const std::string &name)
+{
+  const std::map<std::string, std::string>::const_iterator ci = options.find(name);
+  ASKAPDEBUGASSERT(ci != options.end());
+  std::vector<size_t> result;
+  std::istringstream is(ci->second);
+  std::string item;
+  while (std::getline(is, item, ',')) {
+         std::istringstream iss(item);
+         size_t value = 0;
+         iss >> value;
+         ASKAPCHECK(!iss.fail() && iss.eof(), "Option --"<<name<<" requires a comma separated list of "
+                    "non-negative integers, you have "<<ci->second);
+         result.push_back(value);
+  }
+  return result;
+}
+
+/// @brief convert the option value to a number
+/// @param[in] options parsed options
+/// @param[in] name name of the option
+/// @return numeric value
+double numericOption(const std::map<std::string, std::string> &options, const std::string &name)
+{
+  const std::map<std::string, std::string>::const_iterator ci = options.find(name);
+  ASKAPDEBUGASSERT(ci != options.end());
+  std::istringstream is(ci->second);
+  double result = 0;
+  is >> result;
+  ASKAPCHECK(!is.fail() && is.eof() && (result >= 0), "Option --"<<name<<" requires a non-negative number, you have "<<
+             ci->second);
+  return result;
+}
+
+int main(int argc, char **argv) {
+  try {
+     if (!ASKAPLOG_ISCONFIGURED) {
+         const std::ifstream config("askap.log_cfg", std::ifstream::in);
+         if (config) {
+             ASKAPLOG_INIT("askap.log_cfg");
+         } else {
+             std::ostringstream ss;
+             ss << argv[0] << ".log_cfg";
+             ASKAPLOG_INIT(ss.str().c_str());
+         }
+     }
+     std::map<std::string, std::string> defaults;
+     defaults["rows"] = "1000,10000,100000";
+     defaults["maxdomrows"] = "1000000";
+     defaults["nullfraction"] = "0.02";
+     defaults["repeat"] = "3";
+     defaults["filter"] = "";
+     defaults["workdir"] = "benchvotable.tmp";
+     defaults["output"] = "benchvotable.json";
+     const std::map<std::string, std::string> options = parseOptions(argc, argv, defaults);
+
+     BenchmarkRunner runner(static_cast<size_t>(numericOption(options, "repeat")), options.find("filter")->second);
+     for (std::map<std::string, std::string>::const_iterator ci = options.begin(); ci != options.end(); ++ci) {
+          if ((ci->first != "output") && (ci->first != "workdir")) {
+              runner.setParameter(ci->first, ci->second);
+          }
+     }
+     runner.setParameter("version", ASKAP_PACKAGE_VERSION);
+     runner.setParameter("fields", std::to_string(SyntheticCatalogueGenerator::nFields()));
+     runner.setParameter("peak_rss_reset", resetPeakMemory() ? "yes" : "no");
+
+     VOTableBenchmarks benchmarks(numericListOption(options, "rows"),
+                                  static_cast<size_t>(numericOption(options, "maxdomrows")),
+                                  numericOption(options, "nullfraction"), options.find("workdir")->second);
+     benchmarks.registerBenchmarks(runner);
+     runner.run();
+
+     const std::string output = options.find("output")->second;
+     if (output == "-") {
+         runner.writeJSON(std::cout);
+     } else {
+         std::ofstream os(output.c_str());
+         ASKAPCHECK(os, "Unable to open "<<output<<" for writing");
+         runner.writeJSON(os);
+         ASKAPLOG_INFO_STR(logger, "Results have been written to "<<output);
+     }
+  }
+  catch(const AskapError &ce) {
+     std::cerr<<"AskapError has been caught. "<<ce.what()<<std::endl;
+     return -1;
+  }
+  catch(const std::exception &ex) {
+     std::cerr<<"std::exception has been caught. "<<ex.what()<<std::endl;
+     return -1;
+  }
+  catch(...) {
+     std::cerr<<"An unexpected exception has been caught"<<std::endl;
+     return -1;
+  }
+  return 0;
+}
@@ -32,8 +32,10 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <askap/calibaccess/CachedCalSolutionAccessor.h>
 #include <askap/calibaccess/JonesIndex.h>
+#include <askap/calibaccess/CalSolutionSnapshotHolder.h>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
 
 
 namespace askap {
@@ -46,8 +48,33 @@ class CachedCalSolutionTest : public CppUnit::TestFixture
    CPPUNIT_TEST(testReadWrite);
    CPPUNIT_TEST(testPartiallyUndefined);
    CPPUNIT_TEST(testConsistent);
+   CPPUNIT_TEST(testDenseStorage);
+   CPPUNIT_TEST(testSnapshotHolder);
    CPPUNIT_TEST_SUITE_END();
 protected:
+   /// @brief reader thread checking that the snapshot is consistent
+   /// @details The writer sets the gain of antenna 0, beam 0 equal to the version of the snapshot
+   struct SnapshotReader {
+      SnapshotReader(const CalSolutionSnapshotHolder &holder, size_t &errors) :
+             itsHolder(holder), itsErrors(errors) {}
+
+      void operator()() const {
+         for (size_t iter = 0; iter < 2000; ++iter) {
+              const boost::shared_ptr<CalSolutionSnapshotHolder::Snapshot const> snap = itsHolder.snapshot();
+              if (snap) {
+                  const JonesJTerm gain = snap->itsSolution->gain(JonesIndex(0u,0u));
+                  if (!gain.g1IsValid() || (abs(gain.g1() - casacore::Complex(float(snap->itsVersion),0.)) > 1e-5) ||
+                      (snap->itsID != static_cast<long>(snap->itsVersion))) {
+                      ++itsErrors;
+                  }
+              }
+         }
+      }
+
+      const CalSolutionSnapshotHolder &itsHolder;
+      size_t &itsErrors;
+   };
+
    static void createDummyParams(ICalSolutionAccessor &acc) {
        for (casa::uInt ant=0; ant<5; ++ant) {
             for (casa::uInt beam=0; beam<4; ++beam) {
@@ -230,6 +257,67 @@ public:
        }
    }
 
+   void testDenseStorage() {
+        CachedCalSolutionAccessor acc;
+        acc.useDenseStorage();
+        CPPUNIT_ASSERT(acc.denseStorage());
+        createDummyParams(acc);
+        testDummyParams(acc);
+        // names are built on export only
+        CPPUNIT_ASSERT_EQUAL(880u, acc.cache().size());
+        CPPUNIT_ASSERT(acc.cache().has(CalParamNameHelper::paramName(4,3,casacore::Stokes::YX)));
+        testDummyParams(acc);
+
+        // the values from the cache are picked up by the copy and by the string-based mode
+        CachedCalSolutionAccessor acc2(acc);
+        CPPUNIT_ASSERT(acc2.denseStorage());
+        testDummyParams(acc2);
+        acc2.useDenseStorage(false);
+        CPPUNIT_ASSERT(!acc2.denseStorage());
+        testDummyParams(acc2);
+
+        // changes to the cache made by the caller are respected
+        const JonesIndex index(1u,2u);
+        acc.cache().remove(CalParamNameHelper::paramName(index, casacore::Stokes::XX));
+        CPPUNIT_ASSERT(!acc.gain(index).g1IsValid());
+        CPPUNIT_ASSERT(acc.gain(index).g2IsValid());
+
+        // invalid values are ignored, undefined elements return defaults
+        acc.setGain(index, JonesJTerm(casacore::Complex(0.5,0.), false, casacore::Complex(0.7,0.), true));
+        CPPUNIT_ASSERT(!acc.gain(index).g1IsValid());
+        testComplex(casacore::Complex(0.7,0.), acc.gain(index).g2());
+        const JonesJTerm undefined = acc.bandpass(JonesIndex(10u,0u), 25);
+        CPPUNIT_ASSERT(!undefined.g1IsValid() && !undefined.g2IsValid());
+        testComplex(casacore::Complex(1.,0.), undefined.g1());
+        CPPUNIT_ASSERT_EQUAL(879u, acc.cache().size());
+   }
+
+   void testSnapshotHolder() {
+        CalSolutionSnapshotHolder holder;
+        CPPUNIT_ASSERT(!holder.solution());
+        CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), holder.version());
+        size_t errors1 = 0, errors2 = 0;
+        boost::thread reader1(SnapshotReader(holder, errors1));
+        boost::thread reader2(SnapshotReader(holder, errors2));
+        CachedCalSolutionAccessor acc;
+        acc.useDenseStorage();
+        for (casacore::uInt version = 1; version <= 100; ++version) {
+             acc.setGain(JonesIndex(0u,0u), JonesJTerm(casacore::Complex(float(version),0.), true,
+                         casacore::Complex(1.,0.), true));
+             CPPUNIT_ASSERT_EQUAL(casacore::uInt64(version), holder.publish(acc, long(version)));
+        }
+        reader1.join();
+        reader2.join();
+        CPPUNIT_ASSERT_EQUAL(size_t(0), errors1);
+        CPPUNIT_ASSERT_EQUAL(size_t(0), errors2);
+        CPPUNIT_ASSERT_EQUAL(casacore::uInt64(100), holder.version());
+        CPPUNIT_ASSERT_EQUAL(100l, holder.snapshot()->itsID);
+        // the snapshot doesn't change when the writer carries on
+        const boost::shared_ptr<ICalSolutionConstAccessor const> published = holder.solution();
+        acc.setGain(JonesIndex(0u,0u), JonesJTerm(casacore::Complex(-1.,0.), true, casacore::Complex(1.,0.), true));
+        testComplex(casacore::Complex(100.,0.), published->gain(JonesIndex(0u,0u)).g1());
+   }
+
    /*
    void testSolutionSource() {
         const std::string fname = "tmp.testparset";
@@ -0,0 +1,266 @@
+/// @file
+///
+/// Unit test for the adapter applying calibration solution to the visibilities
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+
+#ifndef CALIBRATION_ACCESSOR_ADAPTER_TEST_H
+#define CALIBRATION_ACCESSOR_ADAPTER_TEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <askap/calibaccess/CalibrationAccessorAdapter.h>
+#include <askap/calibaccess/CachedCalSolutionAccessor.h>
+#include <askap/calibaccess/CalSolutionConstSourceStub.h>
+#include <askap/calibaccess/JonesMatrixCache.h>
+#include <askap/calibaccess/JonesMatrixCacheMonitor.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+#include <askap/askap/AskapError.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+class CalibrationAccessorAdapterTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(CalibrationAccessorAdapterTest);
+   CPPUNIT_TEST(testCorruptAndCorrect);
+   CPPUNIT_TEST(testFlagPropagation);
+   CPPUNIT_TEST_EXCEPTION(testSinglePol, AskapError);
+   CPPUNIT_TEST(testJonesCache);
+   CPPUNIT_TEST_EXCEPTION(testJonesCacheChannelRange, AskapError);
+   CPPUNIT_TEST(testJonesCacheMonitor);
+   CPPUNIT_TEST_SUITE_END();
+protected:
+   /// @brief solution source with the most recent solution ID set by the test
+   struct TestSolutionSource : public CalSolutionConstSourceStub {
+      explicit TestSolutionSource(const ICalSolutionConstAccessor::ShPtr &acc) :
+               CalSolutionConstSourceStub(acc), itsID(0) {}
+      virtual long mostRecentSolution() const { return itsID; }
+      long itsID;
+   };
+
+   /// @brief make a full polarisation accessor with some non-trivial visibilities
+   static boost::shared_ptr<DataAccessorStub> makeAccessor() {
+      boost::shared_ptr<DataAccessorStub> acc(new DataAccessorStub(true));
+      const casacore::uInt nRow = acc->nRow();
+      const casacore::uInt nChan = acc->nChannel();
+      acc->itsVisibility.resize(nRow, nChan, 4);
+      acc->itsNoise.resize(nRow, nChan, 4);
+      acc->itsNoise.set(casacore::Complex(1.,1.));
+      acc->itsFlag.resize(nRow, nChan, 4);
+      acc->itsFlag.set(false);
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+                acc->itsVisibility(row, chan, 0) = casacore::Complex(1. + 0.01 * row, 0.1 * chan);
+                acc->itsVisibility(row, chan, 1) = casacore::Complex(0.05, -0.02 * chan);
+                acc->itsVisibility(row, chan, 2) = casacore::Complex(-0.03, 0.01 * row);
+                acc->itsVisibility(row, chan, 3) = casacore::Complex(0.9, -0.001 * row);
+           }
+      }
+      acc->itsStokes.resize(4);
+      acc->itsStokes[0] = casacore::Stokes::XX;
+      acc->itsStokes[1] = casacore::Stokes::XY;
+      acc->itsStokes[2] = casacore::Stokes::YX;
+      acc->itsStokes[3] = casacore::Stokes::YY;
+      return acc;
+   }
+
+   /// @brief make solution with all terms defined for 30 antennas and 8 channels
+   /// @param[in] skipAnt antenna with undefined bandpass for channel skipChan
+   /// @param[in] skipChan channel with undefined bandpass
+   static ICalSolutionConstAccessor::ShPtr makeSolution(casacore::uInt skipAnt = 100, casacore::uInt skipChan = 100) {
+      boost::shared_ptr<CachedCalSolutionAccessor> acc(new CachedCalSolutionAccessor);
+      for (casacore::uInt ant = 0; ant < 30; ++ant) {
+           const JonesIndex index(ant, 0u);
+           const float tag = float(ant) / 100.;
+           acc->setGain(index, JonesJTerm(casacore::Complex(1.1 + tag, 0.1), true, casacore::Complex(0.9, -tag), true));
+           acc->setLeakage(index, JonesDTerm(casacore::Complex(0.05, tag), casacore::Complex(-tag, 0.02)));
+           for (casacore::uInt chan = 0; chan < 8; ++chan) {
+                if (ant != skipAnt || chan != skipChan) {
+                    acc->setBandpass(index, JonesJTerm(casacore::Complex(1., 0.01 * chan), true,
+                                     casacore::Complex(1. - 0.01 * chan, 0.), true), chan);
+                }
+                acc->setBPLeakage(index, JonesDTerm(casacore::Complex(0.,0.), casacore::Complex(0.,0.)), chan);
+           }
+      }
+      return acc;
+   }
+
+   static void testComplex(const casacore::Complex &expected, const casacore::Complex &obtained, const float tol = 1e-5) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(real(expected),real(obtained),tol);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(imag(expected),imag(obtained),tol);
+   }
+
+public:
+   void testCorruptAndCorrect() {
+      const boost::shared_ptr<DataAccessorStub> acc = makeAccessor();
+      const ICalSolutionConstAccessor::ShPtr sol = makeSolution();
+      CalibrationAccessorAdapter corrupted(*acc, sol, false);
+      CPPUNIT_ASSERT(!corrupted.correcting());
+      const casacore::Cube<casacore::Complex> &vis = corrupted.visibility();
+      CPPUNIT_ASSERT(vis.shape() == acc->visibility().shape());
+      CPPUNIT_ASSERT_EQUAL(acc->nRow(), corrupted.nRow());
+      for (casacore::uInt row = 0; row < acc->nRow(); ++row) {
+           for (casacore::uInt chan = 0; chan < acc->nChannel(); ++chan) {
+                const casacore::SquareMatrix<casacore::Complex, 2> j1 = sol->jones(acc->antenna1()[row], 0, chan);
+                const casacore::SquareMatrix<casacore::Complex, 2> j2 = sol->jones(acc->antenna2()[row], 0, chan);
+                const casacore::Cube<casacore::Complex> &orig = acc->visibility();
+                for (casacore::uInt i = 0; i < 2; ++i) {
+                     for (casacore::uInt j = 0; j < 2; ++j) {
+                          // J1 V J2^H
+                          casacore::Complex expected(0.,0.);
+                          for (casacore::uInt k = 0; k < 2; ++k) {
+                               for (casacore::uInt l = 0; l < 2; ++l) {
+                                    expected += j1(i,k) * orig(row, chan, 2 * k + l) * conj(j2(j,l));
+                               }
+                          }
+                          testComplex(expected, vis(row, chan, 2 * i + j));
+                          CPPUNIT_ASSERT(!corrupted.flag()(row, chan, 2 * i + j));
+                     }
+                }
+           }
+      }
+      // correction should undo the corruption
+      // copy of the stub shares the arrays, make the visibility cube unique
+      DataAccessorStub corruptedAcc(*acc);
+      corruptedAcc.itsVisibility.reference(vis.copy());
+      CalibrationAccessorAdapter corrected(corruptedAcc, sol);
+      CPPUNIT_ASSERT(corrected.correcting());
+      const casacore::Cube<casacore::Complex> &result = corrected.visibility();
+      for (casacore::uInt row = 0; row < acc->nRow(); ++row) {
+           for (casacore::uInt chan = 0; chan < acc->nChannel(); ++chan) {
+                for (casacore::uInt pol = 0; pol < 4; ++pol) {
+                     testComplex(acc->visibility()(row, chan, pol), result(row, chan, pol));
+                }
+           }
+      }
+   }
+
+   void testFlagPropagation() {
+      const boost::shared_ptr<DataAccessorStub> acc = makeAccessor();
+      const ICalSolutionConstAccessor::ShPtr sol = makeSolution(3, 5);
+      CPPUNIT_ASSERT(!sol->jonesAllValid(3, 0, 5));
+      CPPUNIT_ASSERT(sol->jonesValid(3, 0, 5));
+      CalibrationAccessorAdapter strict(*acc, sol);
+      CalibrationAccessorAdapter relaxed(*acc, sol, true, 0, false);
+      for (casacore::uInt row = 0; row < acc->nRow(); ++row) {
+           const bool hasAnt = acc->antenna1()[row] == 3 || acc->antenna2()[row] == 3;
+           for (casacore::uInt chan = 0; chan < acc->nChannel(); ++chan) {
+                for (casacore::uInt pol = 0; pol < 4; ++pol) {
+                     CPPUNIT_ASSERT_EQUAL(hasAnt && chan == 5, bool(strict.flag()(row, chan, pol)));
+                     CPPUNIT_ASSERT(!relaxed.flag()(row, chan, pol));
+                     if (hasAnt && chan == 5) {
+                         testComplex(casacore::Complex(0.,0.), strict.visibility()(row, chan, pol));
+                     }
+                }
+           }
+      }
+      // flags of the original accessor are preserved
+      acc->itsFlag(0, 0, 1) = true;
+      strict.invalidate();
+      CPPUNIT_ASSERT(strict.flag()(0, 0, 1));
+      CPPUNIT_ASSERT(!strict.flag()(0, 0, 0));
+   }
+
+   void testSinglePol() {
+      DataAccessorStub acc(true);
+      CalibrationAccessorAdapter adapter(acc, makeSolution());
+      adapter.visibility();
+   }
+
+   void testJonesCache() {
+      const boost::shared_ptr<DataAccessorStub> acc = makeAccessor();
+      const ICalSolutionConstAccessor::ShPtr sol = makeSolution(3, 5);
+      // several beams to exercise the parallel composition, only beam 0 is defined
+      const JonesMatrixCache::ShPtr cache(new JonesMatrixCache(sol, 30, 4, 0, 8, true, true, 3, 7));
+      CPPUNIT_ASSERT_EQUAL(30u, cache->nAnt());
+      CPPUNIT_ASSERT_EQUAL(4u, cache->nBeam());
+      CPPUNIT_ASSERT_EQUAL(8u, cache->nChan());
+      CPPUNIT_ASSERT_EQUAL(7l, cache->solutionID());
+      CPPUNIT_ASSERT(cache->correcting());
+      CPPUNIT_ASSERT_EQUAL(size_t(4 * 30 * 8) * (4 * sizeof(casacore::Complex) + 1), cache->memoryUsed());
+      CPPUNIT_ASSERT(!cache->validity(3, 0)[5]);
+      CPPUNIT_ASSERT(cache->validity(3, 0)[4]);
+      CPPUNIT_ASSERT(!cache->validity(0, 1)[0]);
+      // the result should be the same as computed directly from the solution
+      CalibrationAccessorAdapter direct(*acc, sol);
+      CalibrationAccessorAdapter cached(*acc, cache, 0);
+      CPPUNIT_ASSERT(cached.correcting());
+      for (casacore::uInt row = 0; row < acc->nRow(); ++row) {
+           for (casacore::uInt chan = 0; chan < acc->nChannel(); ++chan) {
+                for (casacore::uInt pol = 0; pol < 4; ++pol) {
+                     testComplex(direct.visibility()(row, chan, pol), cached.visibility()(row, chan, pol));
+                     CPPUNIT_ASSERT_EQUAL(bool(direct.flag()(row, chan, pol)), bool(cached.flag()(row, chan, pol)));
+                }
+           }
+      }
+      // corruption with the matrices composed in a single thread
+      const JonesMatrixCache::ShPtr serial(new JonesMatrixCache(sol, 30, 1, 0, 8, false, true, 1));
+      CalibrationAccessorAdapter corrupted(*acc, sol, false);
+      CalibrationAccessorAdapter cachedCorrupted(*acc, serial, 0);
+      CPPUNIT_ASSERT(!cachedCorrupted.correcting());
+      testComplex(corrupted.visibility()(10, 6, 1), cachedCorrupted.visibility()(10, 6, 1));
+   }
+
+   void testJonesCacheChannelRange() {
+      const boost::shared_ptr<DataAccessorStub> acc = makeAccessor();
+      const JonesMatrixCache::ShPtr cache(new JonesMatrixCache(makeSolution(), 30, 1, 0, 8));
+      // 8 channels starting from channel 1 are not in the cache
+      CalibrationAccessorAdapter adapter(*acc, cache, 1);
+      adapter.visibility();
+   }
+
+   void testJonesCacheMonitor() {
+      const boost::shared_ptr<TestSolutionSource> src(new TestSolutionSource(makeSolution()));
+      JonesMatrixCacheMonitor monitor(src, 30, 1, 0, 8);
+      CPPUNIT_ASSERT_EQUAL(-1l, monitor.solutionID());
+      CPPUNIT_ASSERT_EQUAL(size_t(0), monitor.rebuilds());
+      const JonesMatrixCache::ShPtr first = monitor.cache();
+      CPPUNIT_ASSERT(first);
+      CPPUNIT_ASSERT_EQUAL(0l, monitor.solutionID());
+      CPPUNIT_ASSERT_EQUAL(size_t(1), monitor.rebuilds());
+      // no new solution, the cache is reused
+      CPPUNIT_ASSERT(!monitor.update());
+      CPPUNIT_ASSERT(!monitor.waitForUpdate(0.));
+      CPPUNIT_ASSERT(monitor.cache() == first);
+      CPPUNIT_ASSERT_EQUAL(size_t(1), monitor.rebuilds());
+      // new solution invalidates the cache, the old one stays usable
+      src->itsID = 2;
+      CPPUNIT_ASSERT(monitor.waitForUpdate(0.));
+      CPPUNIT_ASSERT_EQUAL(2l, monitor.solutionID());
+      CPPUNIT_ASSERT_EQUAL(size_t(2), monitor.rebuilds());
+      CPPUNIT_ASSERT(monitor.cache() != first);
+      CPPUNIT_ASSERT_EQUAL(0l, first->solutionID());
+      CPPUNIT_ASSERT_EQUAL(30u, first->nAnt());
+   }
+};
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef CALIBRATION_ACCESSOR_ADAPTER_TEST_H
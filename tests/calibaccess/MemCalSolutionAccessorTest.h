@@ -35,12 +35,17 @@
 #include <askap/calibaccess/JonesIndex.h>
 #include <askap/calibaccess/MemCalSolutionAccessor.h>
 #include <askap/calibaccess/ICalSolutionFiller.h>
+#include <askap/calibaccess/SharedMemCalSolutionFiller.h>
 #include <askap/askap/AskapUtil.h>
 
 
 // boost includes
 #include <boost/shared_ptr.hpp>
 
+// std includes
+#include <sstream>
+#include <unistd.h>
+
 
 namespace askap {
 
@@ -52,9 +57,14 @@ class MemCalSolutionAccessorTest : public CppUnit::TestFixture,
    CPPUNIT_TEST_SUITE(MemCalSolutionAccessorTest);
    CPPUNIT_TEST(testRead);
    CPPUNIT_TEST(testCache);
+   CPPUNIT_TEST(testBulkRead);
+   CPPUNIT_TEST(testIonoBulkAccess);
+   CPPUNIT_TEST(testSharedMemory);
    CPPUNIT_TEST(testWriteGains);
    CPPUNIT_TEST(testWriteLeakages);
    CPPUNIT_TEST(testWriteBandpasses);
+   CPPUNIT_TEST(testValidity);
+   CPPUNIT_TEST(testCubeView);
    CPPUNIT_TEST_EXCEPTION(testOverwriteROGains,AskapError);
    CPPUNIT_TEST_EXCEPTION(testOverwriteROLeakages,AskapError);
    CPPUNIT_TEST_EXCEPTION(testOverwriteROBandpasses,AskapError);
@@ -326,6 +336,91 @@ public:
      CPPUNIT_ASSERT(!itsBPLeakagesWritten);
   }
 
+  void testBulkRead() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(true);
+     const casacore::uInt beam = 3;
+     casacore::Matrix<casacore::Complex> values, defaultValues;
+     casacore::Matrix<casacore::Bool> valid, defaultValid;
+     acc->gainsForBeam(beam, itsNAnt, values, valid);
+     CPPUNIT_ASSERT_EQUAL(size_t(2u), values.nrow());
+     CPPUNIT_ASSERT_EQUAL(size_t(itsNAnt), values.ncolumn());
+     CPPUNIT_ASSERT(values.shape() == valid.shape());
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          const JonesIndex index(ant,beam);
+          for (casacore::uInt row = 0; row < 2; ++row) {
+               CPPUNIT_ASSERT(valid(row, ant));
+               testValue(values(row, ant), index, row);
+          }
+     }
+     acc->leakagesForBeam(beam, itsNAnt, values, valid);
+     CPPUNIT_ASSERT_EQUAL(size_t(2u), values.nrow());
+     testValue(values(1, 5), JonesIndex(5u, beam), 1);
+     // only a part of the bandpass, the result should match element-wise access
+     const casacore::uInt startChan = 5;
+     const casacore::uInt nChan = 7;
+     acc->bandpassForBeam(beam, itsNAnt, startChan, nChan, values, valid);
+     acc->ICalSolutionConstAccessor::bandpassForBeam(beam, itsNAnt, startChan, nChan, defaultValues, defaultValid);
+     CPPUNIT_ASSERT_EQUAL(size_t(2 * nChan), values.nrow());
+     CPPUNIT_ASSERT_EQUAL(size_t(itsNAnt), values.ncolumn());
+     CPPUNIT_ASSERT(values.shape() == defaultValues.shape());
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          const JonesIndex index(ant,beam);
+          for (casacore::uInt chan = 0; chan < nChan; ++chan) {
+               const JonesJTerm bp = acc->bandpass(index, startChan + chan);
+               CPPUNIT_ASSERT(valid(2 * chan, ant) && valid(2 * chan + 1, ant));
+               CPPUNIT_ASSERT(defaultValid(2 * chan, ant) && defaultValid(2 * chan + 1, ant));
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(bp.g1() - values(2 * chan, ant)), 1e-6);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(bp.g2() - values(2 * chan + 1, ant)), 1e-6);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(defaultValues(2 * chan, ant) - values(2 * chan, ant)), 1e-6);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(defaultValues(2 * chan + 1, ant) - values(2 * chan + 1, ant)), 1e-6);
+          }
+     }
+     acc->bpleakageForBeam(beam, itsNAnt, startChan, nChan, values, valid);
+     acc->ICalSolutionConstAccessor::bpleakageForBeam(beam, itsNAnt, startChan, nChan, defaultValues, defaultValid);
+     CPPUNIT_ASSERT(values.shape() == defaultValues.shape());
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          for (casacore::uInt row = 0; row < 2 * nChan; ++row) {
+               CPPUNIT_ASSERT(valid(row, ant) && defaultValid(row, ant));
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(defaultValues(row, ant) - values(row, ant)), 1e-6);
+          }
+     }
+     CPPUNIT_ASSERT(!itsGainsWritten);
+     CPPUNIT_ASSERT(!itsBandpassesWritten);
+  }
+
+  void testIonoBulkAccess() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
+     const casacore::uInt beam = 3;
+     casacore::Vector<casacore::Float> params, defaultParams;
+     casacore::Vector<casacore::Bool> valid, defaultValid;
+     acc->ionoparamsForBeam(beam, itsNAnt, params, valid);
+     acc->ICalSolutionConstAccessor::ionoparamsForBeam(beam, itsNAnt, defaultParams, defaultValid);
+     CPPUNIT_ASSERT(itsIonoParamsRead);
+     CPPUNIT_ASSERT_EQUAL(size_t(itsNAnt), params.nelements());
+     CPPUNIT_ASSERT_EQUAL(size_t(itsNAnt), valid.nelements());
+     for (casacore::uInt param = 0; param < itsNAnt; ++param) {
+          CPPUNIT_ASSERT(valid[param] && defaultValid[param]);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(defaultParams[param], params[param], 1e-6);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(real(acc->ionoparam(JonesIndex(param, beam)).param()), params[param], 1e-6);
+     }
+     // the layout should follow the setter
+     acc->setIonosphere(JonesIndex(2u, beam), IonoTerm(casacore::Complex(0.5,0.), false));
+     casacore::Matrix<casacore::Float> allParams;
+     casacore::Matrix<casacore::Bool> allValid;
+     acc->ionoparams(5, itsNBeam, allParams, allValid);
+     CPPUNIT_ASSERT_EQUAL(size_t(5u), allParams.nrow());
+     CPPUNIT_ASSERT_EQUAL(size_t(itsNBeam), allParams.ncolumn());
+     for (casacore::uInt dir = 0; dir < itsNBeam; ++dir) {
+          for (casacore::uInt param = 0; param < 5; ++param) {
+               const IonoTerm term = acc->ionoparam(JonesIndex(param, dir));
+               CPPUNIT_ASSERT_EQUAL(term.paramIsValid(), bool(allValid(param, dir)));
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(real(term.param()), allParams(param, dir), 1e-6);
+          }
+     }
+     CPPUNIT_ASSERT(!allValid(2, beam));
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, allParams(2, beam), 1e-6);
+  }
+
   void testCache() {
      boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(true);
      // the following should read gains, bandpasses and leakages
@@ -356,6 +451,47 @@ public:
      CPPUNIT_ASSERT(!itsBPLeakagesWritten);
   }
 
+  void testSharedMemory() {
+     boost::shared_ptr<ICalSolutionFiller> csf(this, utility::NullDeleter());
+     std::ostringstream key;
+     key<<"MemCalSolutionAccessorTest."<<getpid();
+     boost::shared_ptr<SharedMemCalSolutionFiller> filler1(new SharedMemCalSolutionFiller(csf, key.str(), 5));
+     MemCalSolutionAccessor acc1(filler1, true);
+     acc1.jones(0,0,0);
+     CPPUNIT_ASSERT(itsGainsRead);
+     CPPUNIT_ASSERT(itsBandpassesRead);
+     CPPUNIT_ASSERT_EQUAL(size_t(4), filler1->segmentsPublished());
+     // the second filler with the same key and ID maps the data published by the first one
+     itsGainsRead = false;
+     itsLeakagesRead = false;
+     itsBandpassesRead = false;
+     itsBPLeakagesRead = false;
+     boost::shared_ptr<SharedMemCalSolutionFiller> filler2(new SharedMemCalSolutionFiller(csf, key.str(), 5));
+     MemCalSolutionAccessor acc2(filler2, true);
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          for (casacore::uInt beam = 0; beam<itsNBeam; ++beam) {
+               const JonesIndex index(ant,beam);
+               const JonesJTerm gains = acc2.gain(index);
+               CPPUNIT_ASSERT(gains.g1IsValid() && gains.g2IsValid());
+               testValue(gains.g1(), index, 0);
+               testValue(gains.g2(), index, 1);
+               const JonesJTerm bp = acc2.bandpass(index, itsNChan - 1);
+               testValue(bp.g1(), index, 2 * itsNChan - 2);
+               testValue(bp.g2(), index, 2 * itsNChan - 1);
+          }
+     }
+     CPPUNIT_ASSERT(!itsGainsRead);
+     CPPUNIT_ASSERT(!itsBandpassesRead);
+     CPPUNIT_ASSERT_EQUAL(size_t(0), filler2->segmentsPublished());
+     CPPUNIT_ASSERT_EQUAL(size_t(2), filler2->segmentsMapped());
+     // different solution ID is not shared
+     boost::shared_ptr<SharedMemCalSolutionFiller> filler3(new SharedMemCalSolutionFiller(csf, key.str(), 6));
+     MemCalSolutionAccessor acc3(filler3, true);
+     testValue(acc3.gain(JonesIndex(1u,2u)).g1(), JonesIndex(1u,2u), 0);
+     CPPUNIT_ASSERT(itsGainsRead);
+     CPPUNIT_ASSERT_EQUAL(size_t(1), filler3->segmentsPublished());
+  }
+
   void testWriteGains() {
      boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
      for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
@@ -534,6 +670,84 @@ void testWriteBandpasses() {
      CPPUNIT_ASSERT(itsBPLeakagesWritten);
   }
 
+  void testValidity() {
+     boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(false);
+     // everything is valid for this filler
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          for (casacore::uInt beam = 0; beam<itsNBeam; ++beam) {
+               for (casacore::uInt chan = 0; chan<itsNChan; ++chan) {
+                    CPPUNIT_ASSERT(acc->jonesAllValid(ant,beam,chan));
+               }
+          }
+     }
+     CPPUNIT_ASSERT(itsGainsRead);
+     CPPUNIT_ASSERT(itsLeakagesRead);
+     CPPUNIT_ASSERT(itsBandpassesRead);
+     CPPUNIT_ASSERT(itsBPLeakagesRead);
+     // the bitmap should follow the setters
+     acc->setBandpass(JonesIndex(1u,2u), JonesJTerm(1., false, 1., true), 3);
+     CPPUNIT_ASSERT(!acc->jonesAllValid(1,2,3));
+     CPPUNIT_ASSERT(acc->jonesValid(1,2,3));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(ICalSolutionConstAccessor::ALL_VALID &
+                          ~ICalSolutionConstAccessor::BANDPASS_VALID), acc->validity(JonesIndex(1u,2u),3));
+     CPPUNIT_ASSERT(acc->jonesAllValid(1,2,4));
+     CPPUNIT_ASSERT(acc->jonesAllValid(2,1,3));
+     acc->setGain(JonesIndex(1u,2u), JonesJTerm(1., false, 1., false));
+     CPPUNIT_ASSERT(!acc->jonesAllValid(1,2,4));
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(ICalSolutionConstAccessor::LEAKAGE_VALID |
+                          ICalSolutionConstAccessor::BPLEAKAGE_VALID), acc->validity(JonesIndex(1u,2u),3));
+     acc->setBandpass(JonesIndex(1u,2u), JonesJTerm(1., true, 1., true), 3);
+     acc->setGain(JonesIndex(1u,2u), JonesJTerm(1., true, 1., true));
+     CPPUNIT_ASSERT(acc->jonesAllValid(1,2,3));
+     // the result should match the one obtained via individual terms
+     CPPUNIT_ASSERT_EQUAL(acc->validity(JonesIndex(1u,2u),3),
+                acc->ICalSolutionConstAccessor::validity(JonesIndex(1u,2u),3));
+  }
+
+  void testCubeView() {
+     boost::shared_ptr<MemCalSolutionAccessor> acc =
+           boost::dynamic_pointer_cast<MemCalSolutionAccessor>(initAccessor(false));
+     CPPUNIT_ASSERT(acc);
+     const MemCalSolutionAccessor::GainView gains = acc->gainView();
+     const MemCalSolutionAccessor::GainView leakages = acc->leakageView();
+     const MemCalSolutionAccessor::BandpassView bp = acc->bandpassView();
+     CPPUNIT_ASSERT(itsGainsRead);
+     CPPUNIT_ASSERT(itsLeakagesRead);
+     CPPUNIT_ASSERT(itsBandpassesRead);
+     CPPUNIT_ASSERT(!gains.empty());
+     CPPUNIT_ASSERT_EQUAL(itsNAnt, gains.nAnt());
+     CPPUNIT_ASSERT_EQUAL(itsNBeam, gains.nBeam());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), gains.nChan());
+     CPPUNIT_ASSERT_EQUAL(itsNChan, bp.nChan());
+     for (casacore::uInt ant = 0; ant<itsNAnt; ++ant) {
+          for (casacore::uInt beam = 0; beam<itsNBeam; ++beam) {
+               const JonesIndex index(ant, beam);
+               const JonesJTerm gain = acc->gain(index);
+               const JonesJTerm viewGain = gains.jterm(index);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(gain.g1() - viewGain.g1()), 1e-6);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(gain.g2() - gains.value(1, ant, beam)), 1e-6);
+               CPPUNIT_ASSERT_EQUAL(gain.g2IsValid(), bool(gains.isValid(1, ant, beam)));
+               const JonesDTerm leakage = acc->leakage(index);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(leakage.d12() - leakages.dterm(index).d12()), 1e-6);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(leakage.d21() - leakages.dterm(index).d21()), 1e-6);
+               for (casacore::uInt chan = 0; chan<itsNChan; ++chan) {
+                    const JonesJTerm bpTerm = acc->bandpass(index, chan);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(bpTerm.g1() - bp.value(0, ant, beam, chan)), 1e-6);
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(bpTerm.g2() - bp.jterm(index, chan).g2()), 1e-6);
+               }
+          }
+     }
+     // the view refers to the cache, so it should follow the setters
+     acc->setBandpass(JonesIndex(1u,2u), JonesJTerm(casacore::Complex(0.5,0.), true, 1., false), 3);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, real(bp.value(0, 1, 2, 3)), 1e-6);
+     CPPUNIT_ASSERT(!bp.isValid(1, 1, 2, 3));
+     // policy classes are expected to give the same order of polarisations
+     CPPUNIT_ASSERT_EQUAL(size_t(1), CubeJonesLayout::offset(1, 0, 0, 0, itsNChan, itsNAnt, itsNBeam));
+     CPPUNIT_ASSERT_EQUAL(size_t(2 * itsNChan), CubeJonesLayout::offset(0, 0, 1, 0, itsNChan, itsNAnt, itsNBeam));
+     CPPUNIT_ASSERT_EQUAL(size_t(2 * itsNAnt * itsNBeam),
+                ChannelMajorJonesLayout::offset(0, 1, 0, 0, itsNChan, itsNAnt, itsNBeam));
+  }
+
   void testOverwriteROGains() {
      boost::shared_ptr<ICalSolutionAccessor> acc = initAccessor(true);
      const JonesJTerm gain;
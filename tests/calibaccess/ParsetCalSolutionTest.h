@@ -33,8 +33,11 @@
 #include <askap/calibaccess/ParsetCalSolutionSource.h>
 #include <askap/calibaccess/ParsetCalSolutionAccessor.h>
 #include <askap/calibaccess/JonesIndex.h>
+#include <askap/calibaccess/ParsetCalSolutionParser.h>
+#include <askap/askap/AskapError.h>
 
 #include <boost/shared_ptr.hpp>
+#include <string>
 
 
 namespace askap {
@@ -48,6 +51,8 @@ class ParsetCalSolutionTest : public CppUnit::TestFixture
    CPPUNIT_TEST(testOverwrite);
    CPPUNIT_TEST(testPartiallyUndefined);
    CPPUNIT_TEST(testSolutionSource);
+   CPPUNIT_TEST(testFastParser);
+   CPPUNIT_TEST_EXCEPTION(testMalformedParset, AskapError);
    CPPUNIT_TEST_SUITE_END();
 protected:
    static void createDummyParset(ICalSolutionAccessor &acc) {
@@ -211,6 +216,54 @@ public:
         CPPUNIT_ASSERT(roAcc);
         testDummyParset(*roAcc);
    }
+
+   void testFastParser() {
+        const std::string text = "# comment\ngain.g11.0.0 = [1.1,0.1]\n  gain.g22.1.2=[1.05 , -0.1] # trailing\n\n"
+              "leakage.d12.0.0 = [0.1,-0.1]\nleakage.d21.3.1 = 0.2\ngain.g11.1.1.5 = [0.9,0.2]\n"
+              "leakage.d21.1.1.7 = [0.01]\nionosphere.test = [0.5,0.]\ngain.g11.0.0 = [1.2,0.1]";
+        // the result should not depend on the number of threads
+        for (size_t nThreads = 1; nThreads < 5; ++nThreads) {
+             DenseCalSolutionStore store;
+             scimath::Params other;
+             const size_t nParsed = ParsetCalSolutionParser::parse(text.data(), text.data() + text.size(),
+                                    store, other, nThreads);
+             CPPUNIT_ASSERT_EQUAL(size_t(7), nParsed);
+             CPPUNIT_ASSERT_EQUAL(size_t(6), store.size());
+             casacore::Complex val;
+             // the last value of the duplicated key is taken
+             CPPUNIT_ASSERT(store.get(DenseCalSolutionStore::GAIN, 0, 0, 0, 0, val));
+             testComplex(casacore::Complex(1.2,0.1), val);
+             CPPUNIT_ASSERT(!store.get(DenseCalSolutionStore::GAIN, 0, 0, 1, 0, val));
+             CPPUNIT_ASSERT(store.get(DenseCalSolutionStore::GAIN, 1, 2, 1, 0, val));
+             testComplex(casacore::Complex(1.05,-0.1), val);
+             CPPUNIT_ASSERT(store.get(DenseCalSolutionStore::LEAKAGE, 0, 0, 0, 0, val));
+             testComplex(casacore::Complex(0.1,-0.1), val);
+             CPPUNIT_ASSERT(store.get(DenseCalSolutionStore::LEAKAGE, 3, 1, 1, 0, val));
+             testComplex(casacore::Complex(0.2,0.), val);
+             CPPUNIT_ASSERT(store.get(DenseCalSolutionStore::BANDPASS, 1, 1, 0, 5, val));
+             testComplex(casacore::Complex(0.9,0.2), val);
+             CPPUNIT_ASSERT(!store.get(DenseCalSolutionStore::BANDPASS, 1, 1, 0, 4, val));
+             CPPUNIT_ASSERT(store.get(DenseCalSolutionStore::BPLEAKAGE, 1, 1, 1, 7, val));
+             testComplex(casacore::Complex(0.01,0.), val);
+             CPPUNIT_ASSERT(other.has("ionosphere.test"));
+             CPPUNIT_ASSERT(!other.has("gain.g11.0.0"));
+             testComplex(casacore::Complex(0.5,0.), other.complexValue("ionosphere.test"));
+        }
+        // the accessor reads the file written by itself via the same parser
+        const std::string fname = "tmp.testparset";
+        createDummyParset(fname);
+        DenseCalSolutionStore store;
+        scimath::Params other;
+        CPPUNIT_ASSERT_EQUAL(size_t(5 * 4 * 4 * 21), ParsetCalSolutionParser::parseFile(fname, store, other, 2));
+        CPPUNIT_ASSERT_EQUAL(size_t(0), other.names().size());
+   }
+
+   void testMalformedParset() {
+        const std::string text = "gain.g11.0.0 = [1.1,0.1]\ngain.g22.0.0 = [1.1,\n";
+        DenseCalSolutionStore store;
+        scimath::Params other;
+        ParsetCalSolutionParser::parse(text.data(), text.data() + text.size(), store, other, 1);
+   }
 };
 
 } // namespace accessors
@@ -34,12 +34,28 @@
 #include <askap/calibaccess/ParsetCalSolutionAccessor.h>
 #include <askap/calibaccess/JonesIndex.h>
 #include <askap/calibaccess/ChanAdapterCalSolutionConstSource.h>
+#include <askap/calibaccess/ChanAdapterCalSolutionConstAccessor.h>
+#include <askap/calibaccess/ChanOffsetCalSolutionView.h>
+#include <askap/calibaccess/MemCalSolutionAccessor.h>
+#include <askap/calibaccess/DistributedTableCalSolutionConstSource.h>
+#include <askap/calibaccess/CollectiveBandpassWriter.h>
+#include <askap/calibaccess/AsyncCalSolutionSource.h>
+#include <askap/calibaccess/AsyncCalAccess.h>
+#include <askap/calibaccess/BinaryCalSolutionConstSource.h>
+#include <askap/calibaccess/InterpolatingCalSolutionConstSource.h>
+#include <askap/calibaccess/CalSolutionSequenceFile.h>
 #include <casacore/tables/Tables/Table.h>
 
 
 
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/chrono.hpp>
+#include <boost/bind.hpp>
 #include <string>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace askap {
 
@@ -50,10 +66,21 @@ class TableCalSolutionTest : public CppUnit::TestFixture
    CPPUNIT_TEST_SUITE(TableCalSolutionTest);
    CPPUNIT_TEST(testCreate);
    CPPUNIT_TEST(testRead);
+   CPPUNIT_TEST(testPackedTable);
    CPPUNIT_TEST(testBlankEntries);
    CPPUNIT_TEST(testTrailingBlankEntry);
    CPPUNIT_TEST(testChanAdapterRead);
+   CPPUNIT_TEST(testChanRangeRead);
+   CPPUNIT_TEST(testInterpolation);
+   CPPUNIT_TEST(testSolutionCache);
    CPPUNIT_TEST(testDelayedWrite);
+   CPPUNIT_TEST(testPartialWrite);
+   CPPUNIT_TEST(testBatchedWrite);
+   CPPUNIT_TEST(testCollectiveWrite);
+   CPPUNIT_TEST(testAsyncSource);
+   CPPUNIT_TEST(testAsyncRead);
+   CPPUNIT_TEST(testBinaryFile);
+   CPPUNIT_TEST(testChangeNotification);
 //   CPPUNIT_TEST_EXCEPTION(testChanAdapterUndefinedBandpass, AskapError);
    CPPUNIT_TEST_EXCEPTION(testUndefinedGains, AskapError);
    CPPUNIT_TEST_EXCEPTION(testUndefinedLeakages, AskapError);
@@ -319,6 +346,25 @@ public:
        doBandpassTest(acc);
    }
 
+   void testPackedTable() {
+       testCreate();
+       // the table distributed between processes is packed into a blob and restored as a memory table
+       LOFAR::BlobString bs;
+       DistributedTableCalSolutionConstSource::pack(casacore::Table("calibdata.tab"), bs);
+       CPPUNIT_ASSERT(bs.size() > 0);
+       const boost::shared_ptr<ICalSolutionConstSource> css(new TableCalSolutionConstSource(
+                    DistributedTableCalSolutionConstSource::unpack(bs)));
+       CPPUNIT_ASSERT_EQUAL(3l, css->mostRecentSolution());
+       for (long id = 0; id<4; ++id) {
+            CPPUNIT_ASSERT_EQUAL(id, css->solutionID(0.5+60.*id));
+            CPPUNIT_ASSERT(abs(60.*id - css->solutionIDBefore(0.5+60.*id).second) < 0.01);
+       }
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(3);
+       CPPUNIT_ASSERT(acc);
+       doGainAndLeakageTest(acc);
+       doBandpassTest(acc);
+   }
+
    void testDelayedWrite() {
        // do essentially the same as testRead case but write the table in a different fashion - first request IDs for all entries then write.
        // this test would've caught read-write vs. read-only bug we lived with for a while (see ASKAPSDP-3731)
@@ -364,6 +410,253 @@ public:
        doBandpassTest(accRO);
    }
 
+   void testPartialWrite() {
+       boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
+       const long newID = css->newSolutionID(0.);
+       boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(newID);
+       for (casacore::uInt chan = 0; chan < 8; ++chan) {
+            acc->setBandpass(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.,0.1 * chan),true,
+                             casacore::Complex(0.5,0.1 * chan),true),chan);
+       }
+       acc.reset();
+       // update one channel of the existing solution, only this channel is written back
+       acc = css->rwSolution(newID);
+       acc->setBandpass(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(2.,0.),true,casacore::Complex(0.,2.),false),3u);
+       acc->setBPLeakage(JonesIndex(1u,2u),JonesDTerm(casacore::Complex(0.1,-0.2),true,casacore::Complex(-0.1,-0.1),true),5u);
+       acc.reset();
+       css.reset();
+
+       const boost::shared_ptr<ICalSolutionConstAccessor> accRO = roSource()->roSolution(newID);
+       CPPUNIT_ASSERT(accRO);
+       for (casacore::uInt chan = 0; chan < 8; ++chan) {
+            const JonesJTerm bp = accRO->bandpass(JonesIndex(0u,0u),chan);
+            if (chan == 3) {
+                testComplex(casacore::Complex(2.,0.), bp.g1());
+                testComplex(casacore::Complex(0.,2.), bp.g2());
+                CPPUNIT_ASSERT(bp.g1IsValid());
+                CPPUNIT_ASSERT(!bp.g2IsValid());
+            } else {
+                testComplex(casacore::Complex(1.,0.1 * chan), bp.g1());
+                testComplex(casacore::Complex(0.5,0.1 * chan), bp.g2());
+                CPPUNIT_ASSERT(bp.g1IsValid());
+                CPPUNIT_ASSERT(bp.g2IsValid());
+            }
+            const JonesDTerm bpl = accRO->bpleakage(JonesIndex(1u,2u),chan);
+            CPPUNIT_ASSERT_EQUAL(chan == 5, bpl.d12IsValid());
+            CPPUNIT_ASSERT_EQUAL(chan == 5, bpl.d21IsValid());
+       }
+       testComplex(casacore::Complex(0.1,-0.2), accRO->bpleakage(JonesIndex(1u,2u),5u).d12());
+   }
+
+   void testBatchedWrite() {
+       TableCalSolutionSource::removeOldTable("calibdata.tab");
+       boost::shared_ptr<TableCalSolutionSource> css(new TableCalSolutionSource("calibdata.tab",6,3,8));
+       css->batchWrites(3);
+       // small tiles to exercise the tiled storage manager
+       css->setMaxTileSize(256);
+       for (int interval = 0; interval < 5; ++interval) {
+            const long id = css->newSolutionID(60. * interval);
+            CPPUNIT_ASSERT_EQUAL(static_cast<long>(interval), id);
+            const boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(id);
+            acc->setGain(JonesIndex(1u,2u),JonesJTerm(casacore::Complex(1.,0.1 * interval),true,
+                         casacore::Complex(0.5,-0.1 * interval),true));
+            acc->setBandpass(JonesIndex(0u,1u),JonesJTerm(casacore::Complex(0.9,0.),true,
+                             casacore::Complex(1.1,0.),interval % 2 == 0),casacore::uInt(interval));
+       }
+       // the last two solutions are flushed here
+       css.reset();
+
+       const boost::shared_ptr<ICalSolutionConstSource> cssRO = roSource();
+       CPPUNIT_ASSERT_EQUAL(4l, cssRO->mostRecentSolution());
+       for (int interval = 0; interval < 5; ++interval) {
+            const boost::shared_ptr<ICalSolutionConstAccessor> acc = cssRO->roSolution(interval);
+            CPPUNIT_ASSERT(acc);
+            const JonesJTerm gain = acc->gain(JonesIndex(1u,2u));
+            testComplex(casacore::Complex(1.,0.1 * interval), gain.g1());
+            testComplex(casacore::Complex(0.5,-0.1 * interval), gain.g2());
+            CPPUNIT_ASSERT(gain.g1IsValid() && gain.g2IsValid());
+            CPPUNIT_ASSERT(!acc->gain(JonesIndex(0u,0u)).g1IsValid());
+            for (casacore::uInt chan = 0; chan < 8; ++chan) {
+                 const JonesJTerm bp = acc->bandpass(JonesIndex(0u,1u),chan);
+                 CPPUNIT_ASSERT_EQUAL(chan == casacore::uInt(interval), bp.g1IsValid());
+                 CPPUNIT_ASSERT_EQUAL((chan == casacore::uInt(interval)) && (interval % 2 == 0), bp.g2IsValid());
+            }
+            testComplex(casacore::Complex(1.1,0.), acc->bandpass(JonesIndex(0u,1u),interval).g2());
+       }
+   }
+
+   void testCollectiveWrite() {
+       TableCalSolutionSource::removeOldTable("calibdata.tab");
+       const long id = CollectiveBandpassWriter::prepareSolution("calibdata.tab", 60., 6, 3, 8);
+       CPPUNIT_ASSERT_EQUAL(0l, id);
+       {
+         // two writers emulate two processes writing their own range of channels
+         CollectiveBandpassWriter writer1("calibdata.tab", id, 0, 3);
+         CollectiveBandpassWriter writer2("calibdata.tab", id, 3, 5);
+         for (casacore::uInt chan = 0; chan < 8; ++chan) {
+              CollectiveBandpassWriter &writer = chan < 3 ? writer1 : writer2;
+              writer.setBandpass(JonesIndex(1u,2u),JonesJTerm(casacore::Complex(1.,0.1 * chan),true,
+                                 casacore::Complex(0.5,-0.1 * chan),true),chan);
+         }
+         writer2.setBPLeakage(JonesIndex(0u,1u),JonesDTerm(casacore::Complex(0.1,-0.2),true,
+                              casacore::Complex(-0.1,-0.1),false),4u);
+         writer2.flush();
+         // channel 4 is not written by the first writer
+         CPPUNIT_ASSERT_THROW(writer1.setBandpass(JonesIndex(0u,0u),JonesJTerm(1.,true,1.,true),4u), AskapError);
+       }
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = roSource()->roSolution(id);
+       CPPUNIT_ASSERT(acc);
+       for (casacore::uInt chan = 0; chan < 8; ++chan) {
+            const JonesJTerm bp = acc->bandpass(JonesIndex(1u,2u),chan);
+            testComplex(casacore::Complex(1.,0.1 * chan), bp.g1());
+            testComplex(casacore::Complex(0.5,-0.1 * chan), bp.g2());
+            CPPUNIT_ASSERT(bp.g1IsValid());
+            CPPUNIT_ASSERT(bp.g2IsValid());
+            CPPUNIT_ASSERT(!acc->bandpass(JonesIndex(0u,0u),chan).g1IsValid());
+            const JonesDTerm bpl = acc->bpleakage(JonesIndex(0u,1u),chan);
+            CPPUNIT_ASSERT_EQUAL(chan == 4, bpl.d12IsValid());
+            CPPUNIT_ASSERT(!bpl.d21IsValid());
+       }
+       testComplex(casacore::Complex(0.1,-0.2), acc->bpleakage(JonesIndex(0u,1u),4u).d12());
+   }
+
+   void testAsyncSource() {
+       boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
+       CPPUNIT_ASSERT_EQUAL(0l, css->newSolutionID(0.));
+       css->rwSolution(0)->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.0,-1.0),true,
+                                   casacore::Complex(-1.0,1.0),true));
+       AsyncCalSolutionSource async(css, 0.01, 2);
+       CPPUNIT_ASSERT_EQUAL(0l, async.mostRecentSolution());
+       boost::shared_ptr<ICalSolutionConstAccessor> acc = async.roSolution(0);
+       CPPUNIT_ASSERT(acc);
+       testComplex(casacore::Complex(-1.0,1.0), acc->gain(JonesIndex(0u,0u)).g2());
+       // the most recent solution has been read by the first poll
+       CPPUNIT_ASSERT_EQUAL(size_t(1), async.solutionsPrefetched());
+       CPPUNIT_ASSERT_EQUAL(size_t(1), async.cacheHits());
+       CPPUNIT_ASSERT_EQUAL(size_t(0), async.cacheMisses());
+
+       // new solution is written in background
+       const long newID = async.newSolutionID(60.);
+       CPPUNIT_ASSERT_EQUAL(1l, newID);
+       boost::shared_ptr<ICalSolutionAccessor> rwAcc = async.rwSolution(newID);
+       CPPUNIT_ASSERT(rwAcc);
+       rwAcc->setGain(JonesIndex(1u,0u),JonesJTerm(casacore::Complex(0.5,0.5),true,casacore::Complex(0.,1.),false));
+       rwAcc.reset();
+       async.waitForWrites();
+       CPPUNIT_ASSERT_EQUAL(size_t(1), async.writesCompleted());
+       const size_t nPrefetched = async.solutionsPrefetched();
+       for (int attempt = 0; (attempt < 500) && (async.solutionsPrefetched() == nPrefetched); ++attempt) {
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+       }
+       CPPUNIT_ASSERT_EQUAL(nPrefetched + 1, async.solutionsPrefetched());
+       CPPUNIT_ASSERT_EQUAL(newID, async.mostRecentSolution());
+       acc = async.roSolution(newID);
+       CPPUNIT_ASSERT_EQUAL(size_t(2), async.cacheHits());
+       const JonesJTerm gain = acc->gain(JonesIndex(1u,0u));
+       testComplex(casacore::Complex(0.5,0.5), gain.g1());
+       CPPUNIT_ASSERT(gain.g1IsValid());
+       CPPUNIT_ASSERT(!gain.g2IsValid());
+       CPPUNIT_ASSERT_EQUAL(newID, async.solutionID(61.));
+   }
+
+   void testAsyncRead() {
+       testCreate();
+       const boost::shared_ptr<ICalSolutionConstSource const> css(new TableCalSolutionConstSource("calibdata.tab"));
+       // all solutions are requested at once, the table is read through a single strand
+       IOThreadPool pool(2);
+       IOThreadPool::Strand strand(pool);
+       std::vector<std::future<boost::shared_ptr<ICalSolutionConstAccessor> > > solutions;
+       for (long id = 0; id < 4; ++id) {
+            solutions.push_back(roSolutionAsync(css, id, strand));
+       }
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc0 = solutions[0].get();
+       CPPUNIT_ASSERT(acc0);
+       testComplex(casacore::Complex(-1.0,1.0), acc0->gain(JonesIndex(0u,0u)).g2());
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc1 = solutions[1].get();
+       CPPUNIT_ASSERT(acc1);
+       testComplex(casacore::Complex(0.1,-0.1), acc1->leakage(JonesIndex(2u,1u)).d12());
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc2 = solutions[2].get();
+       CPPUNIT_ASSERT(acc2);
+       testComplex(casacore::Complex(0.9,-0.1), acc2->bandpass(JonesIndex(1u,1u),1u).g2());
+       CPPUNIT_ASSERT(solutions[3].get());
+       CPPUNIT_ASSERT_THROW(roSolutionAsync(boost::shared_ptr<ICalSolutionConstSource const>(), 0, strand),
+                            askap::AskapError);
+   }
+
+   static void publishLater(const CalSolutionSequenceFile &sequenceFile, long nSolutions) {
+       boost::this_thread::sleep_for(boost::chrono::milliseconds(100));
+       sequenceFile.publish(nSolutions);
+   }
+
+   void testChangeNotification() {
+       boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
+       const CalSolutionSequenceFile sequenceFile("calibdata.tab");
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), sequenceFile.read().itsSequence);
+       // the writer announces each flush
+       const long id = css->newSolutionID(55553.*86400);
+       css->rwSolution(id)->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.,0.),true,
+                                    casacore::Complex(1.,0.),true));
+       const CalSolutionSequenceFile::State state = sequenceFile.read();
+       CPPUNIT_ASSERT(state.itsSequence > 0);
+       CPPUNIT_ASSERT_EQUAL(1l, state.itsNSolutions);
+       boost::shared_ptr<TableCalSolutionConstSource> reader(new TableCalSolutionConstSource("calibdata.tab"));
+       reader->setChangePollInterval(0.05);
+       CPPUNIT_ASSERT_EQUAL(0l, reader->waitForNewSolution(-1, 1.));
+       // nothing new, the timeout expires
+       CPPUNIT_ASSERT_EQUAL(0l, reader->waitForNewSolution(0, 0.1));
+       const long newID = css->newSolutionID(55553.*86400 + 60.);
+       css->rwSolution(newID)->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(0.5,0.),true,
+                                       casacore::Complex(0.5,0.),true));
+       CPPUNIT_ASSERT(sequenceFile.read().itsSequence > state.itsSequence);
+       CPPUNIT_ASSERT_EQUAL(1l, reader->waitForNewSolution(0, 10.));
+       reader.reset();
+       css.reset();
+
+       // the waiting side wakes up when the file is replaced
+       const std::string dirName("calseq_test.dir");
+       mkdir(dirName.c_str(), 0755);
+       const CalSolutionSequenceFile testFile(dirName);
+       std::remove(testFile.fileName().c_str());
+       boost::thread writer(boost::bind(&TableCalSolutionTest::publishLater, boost::cref(testFile), 3l));
+       const boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+       const CalSolutionSequenceFile::State changed = testFile.waitForChange(0, 10.);
+       writer.join();
+       CPPUNIT_ASSERT(boost::chrono::steady_clock::now() - start < boost::chrono::seconds(5));
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), changed.itsSequence);
+       CPPUNIT_ASSERT_EQUAL(3l, changed.itsNSolutions);
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(1), testFile.waitForChange(0, 0.1).itsSequence);
+       std::remove(testFile.fileName().c_str());
+       rmdir(dirName.c_str());
+   }
+
+   void testBinaryFile() {
+       testCreate();
+       BinaryCalSolutionConstSource::convertTable(casacore::Table("calibdata.tab"), "calibdata.bin");
+       boost::shared_ptr<BinaryCalSolutionConstSource> css(new BinaryCalSolutionConstSource("calibdata.bin"));
+       CPPUNIT_ASSERT_EQUAL(4l, css->numberOfSolutions());
+       CPPUNIT_ASSERT_EQUAL(3l, css->mostRecentSolution());
+       for (long id = 0; id<4; ++id) {
+            CPPUNIT_ASSERT_EQUAL(id, css->solutionID(0.5+60.*id));
+            CPPUNIT_ASSERT(abs(60.*id - css->solutionIDBefore(0.5+60.*id).second) < 0.01);
+            if (id > 0) {
+                CPPUNIT_ASSERT_EQUAL(id, css->solutionIDAfter(0.5+60.*(id-1)).first);
+            }
+       }
+       // the leakage is not defined in the first row, bandpasses are not defined in the first two rows
+       boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(0);
+       CPPUNIT_ASSERT(acc);
+       CPPUNIT_ASSERT(acc->gain(JonesIndex(0u,0u)).g1IsValid());
+       CPPUNIT_ASSERT(!acc->leakage(JonesIndex(2u,1u)).d12IsValid());
+       acc = css->roSolution(1);
+       doGainAndLeakageTest(acc);
+       CPPUNIT_ASSERT(!acc->bandpass(JonesIndex(1u,1u),1u).g1IsValid());
+       acc = css->roSolution(3);
+       // the accessor keeps the file mapped
+       css.reset();
+       doGainAndLeakageTest(acc);
+       doBandpassTest(acc);
+   }
+
    void testTooFarIntoThePast() {
        boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
        CPPUNIT_ASSERT(css);
@@ -431,6 +724,180 @@ public:
                  }
             }
        }
+       // bulk access should apply the same offset
+       casacore::Matrix<casacore::Complex> bpValues;
+       casacore::Matrix<casacore::Bool> bpValid;
+       acc->bandpassForBeam(1u, 6u, 0u, 7u, bpValues, bpValid);
+       CPPUNIT_ASSERT_EQUAL(size_t(14u), bpValues.nrow());
+       CPPUNIT_ASSERT_EQUAL(size_t(6u), bpValues.ncolumn());
+       for (casacore::uInt ant = 0; ant<6; ++ant) {
+            for (casacore::uInt chan = 0; chan < 7; ++chan) {
+                 const JonesJTerm bp = acc->bandpass(JonesIndex(ant,1u),chan);
+                 testComplex(bp.g1(), bpValues(2 * chan, ant));
+                 testComplex(bp.g2(), bpValues(2 * chan + 1, ant));
+                 CPPUNIT_ASSERT_EQUAL(bp.g1IsValid(), bool(bpValid(2 * chan, ant)));
+                 CPPUNIT_ASSERT_EQUAL(bp.g2IsValid(), bool(bpValid(2 * chan + 1, ant)));
+            }
+       }
+       // nested adapters should collapse into one
+       const boost::shared_ptr<MemCalSolutionAccessor> memAcc =
+             boost::dynamic_pointer_cast<MemCalSolutionAccessor>(roSource()->roSolution(sID));
+       CPPUNIT_ASSERT(memAcc);
+       const boost::shared_ptr<ChanAdapterCalSolutionConstAccessor> inner(new ChanAdapterCalSolutionConstAccessor(memAcc, 2u));
+       const ChanAdapterCalSolutionConstAccessor outer(inner, 1u);
+       CPPUNIT_ASSERT(outer.accessor() == memAcc);
+       CPPUNIT_ASSERT_EQUAL(3u, outer.offset());
+       // non-virtual view should give the same result as the adapter
+       const ChanOffsetCalSolutionView<MemCalSolutionAccessor> view = chanOffsetView(*memAcc, 1u);
+       for (casacore::uInt ant = 0; ant<6; ++ant) {
+            for (casacore::uInt beam = 0; beam<3; ++beam) {
+                 const JonesIndex index(ant,beam);
+                 for (casacore::uInt chan = 0; chan < 7; ++chan) {
+                      const JonesJTerm bp = acc->bandpass(index,chan);
+                      const JonesJTerm bpView = view.bandpass(index,chan);
+                      testComplex(bp.g1(), bpView.g1());
+                      testComplex(bp.g2(), bpView.g2());
+                      CPPUNIT_ASSERT_EQUAL(bp.g1IsValid(), bpView.g1IsValid());
+                      CPPUNIT_ASSERT_EQUAL(bp.g2IsValid(), bpView.g2IsValid());
+                      CPPUNIT_ASSERT_EQUAL(acc->validity(index,chan), view.validity(index,chan));
+                 }
+            }
+       }
+       casacore::Matrix<casacore::Complex> viewValues;
+       casacore::Matrix<casacore::Bool> viewValid;
+       view.bandpassForBeam(1u, 6u, 0u, 7u, viewValues, viewValid);
+       CPPUNIT_ASSERT(viewValues.shape() == bpValues.shape());
+       for (casacore::uInt ant = 0; ant<6; ++ant) {
+            for (casacore::uInt row = 0; row < 14; ++row) {
+                 testComplex(bpValues(row, ant), viewValues(row, ant));
+                 CPPUNIT_ASSERT_EQUAL(bool(bpValid(row, ant)), bool(viewValid(row, ant)));
+            }
+       }
+   }
+
+   void testInterpolation() {
+       boost::shared_ptr<ICalSolutionSource> css = rwSource(true);
+       long newID = css->newSolutionID(0.);
+       boost::shared_ptr<ICalSolutionAccessor> acc = css->rwSolution(newID);
+       acc->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.,0.),true,casacore::Complex(1.,0.),true));
+       acc->setBandpass(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(1.,0.),true,casacore::Complex(1.,0.),true),1u);
+       acc.reset();
+       newID = css->newSolutionID(60.);
+       acc = css->rwSolution(newID);
+       acc->setGain(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(0.,2.),true,casacore::Complex(2.,0.),true));
+       acc->setBandpass(JonesIndex(0u,0u),JonesJTerm(casacore::Complex(0.,2.),true,casacore::Complex(2.,0.),true),1u);
+       acc->setLeakage(JonesIndex(0u,0u),JonesDTerm(casacore::Complex(0.1,0.),casacore::Complex(0.,0.1)));
+       acc.reset();
+       css.reset();
+
+       const boost::shared_ptr<InterpolatingCalSolutionConstSource> linear(new InterpolatingCalSolutionConstSource(roSource()));
+       boost::shared_ptr<ICalSolutionConstAccessor> ia = linear->roSolutionForTime(15.);
+       CPPUNIT_ASSERT(ia);
+       CPPUNIT_ASSERT_EQUAL(size_t(2), linear->solutionsLoaded());
+       JonesJTerm gain = ia->gain(JonesIndex(0u,0u));
+       CPPUNIT_ASSERT(gain.g1IsValid() && gain.g2IsValid());
+       testComplex(casacore::Complex(0.75,0.5), gain.g1());
+       testComplex(casacore::Complex(1.25,0.), gain.g2());
+       testComplex(casacore::Complex(0.75,0.5), ia->bandpass(JonesIndex(0u,0u),1u).g1());
+       // leakages are only defined in the second solution and used as they are
+       const JonesDTerm leakage = ia->leakage(JonesIndex(0u,0u));
+       CPPUNIT_ASSERT(leakage.d12IsValid() && leakage.d21IsValid());
+       testComplex(casacore::Complex(0.1,0.), leakage.d12());
+       // bulk retrieval should give the same result
+       casacore::Matrix<casacore::Complex> gains;
+       casacore::Matrix<casacore::Bool> valid;
+       ia->gainsForBeam(0u, 6u, gains, valid);
+       CPPUNIT_ASSERT(valid(0,0) && valid(1,0));
+       CPPUNIT_ASSERT(!valid(0,1) && !valid(1,1));
+       testComplex(gain.g1(), gains(0,0));
+       testComplex(gain.g2(), gains(1,0));
+       // the same pair of solutions is reused
+       ia = linear->roSolutionForTime(45.);
+       testComplex(casacore::Complex(0.25,1.5), ia->gain(JonesIndex(0u,0u)).g1());
+       CPPUNIT_ASSERT_EQUAL(size_t(2), linear->solutionsLoaded());
+       // exact match and times beyond the last solution give the solution as it is
+       testComplex(casacore::Complex(0.,2.), linear->roSolutionForTime(60.)->gain(JonesIndex(0u,0u)).g1());
+       testComplex(casacore::Complex(0.,2.), linear->roSolutionForTime(600.)->gain(JonesIndex(0u,0u)).g1());
+       CPPUNIT_ASSERT_EQUAL(size_t(2), linear->solutionsLoaded());
+
+       const boost::shared_ptr<InterpolatingCalSolutionConstSource> ampPhase(new InterpolatingCalSolutionConstSource(roSource(),
+                   InterpolatingCalSolutionConstAccessor::AMPLITUDE_PHASE));
+       gain = ampPhase->roSolutionForTime(15.)->gain(JonesIndex(0u,0u));
+       testComplex(std::polar(1.25f, static_cast<float>(casacore::C::pi / 8.)), gain.g1());
+       testComplex(casacore::Complex(1.25,0.), gain.g2());
+   }
+
+   void testSolutionCache() {
+       testCreate();
+       const boost::shared_ptr<TableCalSolutionConstSource> css(new TableCalSolutionConstSource("calibdata.tab"));
+       css->cacheSolutions(2, true);
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc0 = css->roSolution(0);
+       CPPUNIT_ASSERT(acc0);
+       CPPUNIT_ASSERT_EQUAL(size_t(1), css->cacheMisses());
+       // the same solution is returned from the cache
+       CPPUNIT_ASSERT(acc0 == css->roSolution(0));
+       CPPUNIT_ASSERT_EQUAL(size_t(1), css->cacheHits());
+       // the next solution has been read in background
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc1 = css->roSolution(1);
+       CPPUNIT_ASSERT(acc1);
+       CPPUNIT_ASSERT_EQUAL(size_t(2), css->cacheHits());
+       CPPUNIT_ASSERT_EQUAL(size_t(1), css->cacheMisses());
+       CPPUNIT_ASSERT_EQUAL(size_t(1), css->solutionsPrefetched());
+       // gains are found by the backward search
+       const JonesJTerm gain = acc1->gain(JonesIndex(0u,0u));
+       CPPUNIT_ASSERT(gain.g1IsValid() && gain.g2IsValid());
+       testComplex(casacore::Complex(1.0,-1.0), gain.g1());
+       testComplex(casacore::Complex(-1.0,1.0), gain.g2());
+       // the solution following the previous one is prefetched although it is not used
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc3 = css->roSolution(3);
+       CPPUNIT_ASSERT_EQUAL(size_t(2), css->cacheMisses());
+       CPPUNIT_ASSERT_EQUAL(size_t(2), css->solutionsPrefetched());
+       doGainAndLeakageTest(acc3);
+       doBandpassTest(acc3);
+       // only 2 most recently used solutions are kept
+       CPPUNIT_ASSERT(acc0 != css->roSolution(0));
+       CPPUNIT_ASSERT_EQUAL(size_t(3), css->cacheMisses());
+       // range of channels is cached separately
+       css->roSolutionForChannels(3, 1, 4);
+       CPPUNIT_ASSERT_EQUAL(size_t(4), css->cacheMisses());
+   }
+
+   void testChanRangeRead() {
+       testCreate();
+       // adapter reading 3 channels starting from channel 1
+       const boost::shared_ptr<ICalSolutionConstSource> css(new ChanAdapterCalSolutionConstSource(roSource(),1u,3u));
+       CPPUNIT_ASSERT(css);
+       const boost::shared_ptr<ICalSolutionConstAccessor> acc = css->roSolution(css->mostRecentSolution());
+       CPPUNIT_ASSERT(acc);
+       doGainAndLeakageTest(acc);
+       // the result should match the full read with the same offset
+       const boost::shared_ptr<ICalSolutionConstSource> fullSource(new ChanAdapterCalSolutionConstSource(roSource(),1u));
+       const boost::shared_ptr<ICalSolutionConstAccessor> fullAcc = fullSource->roSolution(fullSource->mostRecentSolution());
+       CPPUNIT_ASSERT(fullAcc);
+       for (casacore::uInt ant = 0; ant<6; ++ant) {
+            for (casacore::uInt beam = 0; beam<3; ++beam) {
+                 const JonesIndex index(ant,beam);
+                 for (casacore::uInt chan = 0; chan < 3; ++chan) {
+                      const JonesJTerm bp = acc->bandpass(index,chan);
+                      const JonesJTerm bpFull = fullAcc->bandpass(index,chan);
+                      testComplex(bpFull.g1(), bp.g1());
+                      testComplex(bpFull.g2(), bp.g2());
+                      CPPUNIT_ASSERT_EQUAL(bpFull.g1IsValid(), bp.g1IsValid());
+                      CPPUNIT_ASSERT_EQUAL(bpFull.g2IsValid(), bp.g2IsValid());
+                 }
+            }
+       }
+       CPPUNIT_ASSERT(acc->bandpass(JonesIndex(1u,1u),0).g1IsValid());
+       // channels outside the range are not read
+       try {
+          acc->bandpass(JonesIndex(0u,0u),3);
+          CPPUNIT_FAIL("An exception is expected for the channel outside the selected range");
+       }
+       catch (const AskapError &) {}
+       // the range is truncated at the end of the spectrum
+       const boost::shared_ptr<ICalSolutionConstAccessor> tailAcc = roSource()->roSolutionForChannels(3, 6u, 10u);
+       CPPUNIT_ASSERT(tailAcc);
+       CPPUNIT_ASSERT(!tailAcc->bandpass(JonesIndex(0u,0u),1).g1IsValid());
    }
 
    void testUndefinedGains() {
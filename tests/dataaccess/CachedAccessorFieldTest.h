@@ -35,8 +35,12 @@
 // own includes
 #include <askap/dataaccess/CachedAccessorField.h>
 
+// casa includes
+#include <casacore/casa/Arrays/Cube.h>
+
 // std includes
 #include <string>
+#include <utility>
 
 namespace askap {
 
@@ -49,6 +53,9 @@ class CachedAccessorFieldTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_EXCEPTION(readRequiredTest, AskapError);
   CPPUNIT_TEST_EXCEPTION(readRequiredBeforeWriteTest, AskapError);
   CPPUNIT_TEST_EXCEPTION(readUnsyncedTest, AskapError);
+  CPPUNIT_TEST(moveTest);
+  CPPUNIT_TEST(swapTest);
+  CPPUNIT_TEST_EXCEPTION(swapOutRequiresReadTest, AskapError);
   CPPUNIT_TEST_SUITE_END();
 private:
   CachedAccessorField<std::string> itsCAF;
@@ -59,6 +66,11 @@ public:
   void operator()(std::string &str) const {
        str="filled by operator()";
   }
+
+  void cubeFiller(casacore::Cube<casacore::Float> &cube) const {
+       cube.resize(3,4,2);
+       cube.set(1.);
+  }
   
   void readOnDemandTest() {
      CPPUNIT_ASSERT(!itsCAF.isValid());
@@ -154,6 +166,45 @@ public:
      itsCAF.value(*this);     
   }
   
+  void moveTest() {
+     CachedAccessorField<casacore::Cube<casacore::Float> > caf;
+     const casacore::Float *storage = caf.value(*this, &CachedAccessorFieldTest::cubeFiller).data();
+     CachedAccessorField<casacore::Cube<casacore::Float> > moved(std::move(caf));
+     CPPUNIT_ASSERT(!caf.isValid());
+     CPPUNIT_ASSERT(moved.isValid());
+     // no copy should be made
+     CPPUNIT_ASSERT(moved.value().data() == storage);
+     caf = std::move(moved);
+     CPPUNIT_ASSERT(caf.isValid());
+     CPPUNIT_ASSERT(!moved.isValid());
+     CPPUNIT_ASSERT(caf.value().data() == storage);
+     CPPUNIT_ASSERT(caf.value().shape() == casacore::IPosition(3,3,4,2));
+  }
+
+  void swapTest() {
+     CachedAccessorField<casacore::Cube<casacore::Float> > caf;
+     casacore::Cube<casacore::Float> buffer(2,2,2,3.);
+     const casacore::Float *storage = buffer.data();
+     caf.swapIn(buffer);
+     CPPUNIT_ASSERT(caf.isValid());
+     CPPUNIT_ASSERT(!caf.flushNeeded());
+     CPPUNIT_ASSERT(buffer.nelements() == 0);
+     // no read is expected
+     const casacore::Cube<casacore::Float> &value = caf.value(*this, &CachedAccessorFieldTest::cubeFiller);
+     CPPUNIT_ASSERT(value.data() == storage);
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(3., value(1,1,1), 1e-6);
+     caf.swapOut(buffer);
+     CPPUNIT_ASSERT(!caf.isValid());
+     CPPUNIT_ASSERT(buffer.data() == storage);
+     CPPUNIT_ASSERT(caf.value(*this, &CachedAccessorFieldTest::cubeFiller).shape() == casacore::IPosition(3,3,4,2));
+  }
+
+  void swapOutRequiresReadTest() {
+     CachedAccessorField<casacore::Cube<casacore::Float> > caf;
+     casacore::Cube<casacore::Float> buffer;
+     caf.swapOut(buffer);
+  }
+
 }; // class CachedAccessorFieldTest
 
 } // namespace accessors
@@ -0,0 +1,143 @@
+/// @file
+/// $brief Unit tests of the streaming mode of the direction-dependent calibration buffer
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef DDCAL_BUFFER_DATA_ACCESSOR_TEST_H
+#define DDCAL_BUFFER_DATA_ACCESSOR_TEST_H
+
+#include <askap/dataaccess/DDCalBufferDataAccessor.h>
+#include <askap/dataaccess/DataAccessorStub.h>
+#include <askap/dataaccess/PooledBufferManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <boost/shared_ptr.hpp>
+
+namespace askap {
+
+namespace accessors {
+
+class DDCalBufferDataAccessorTest : public CppUnit::TestFixture {
+   CPPUNIT_TEST_SUITE(DDCalBufferDataAccessorTest);
+   CPPUNIT_TEST(memoryModeTest);
+   CPPUNIT_TEST(streamingTest);
+   CPPUNIT_TEST(fillerTest);
+   CPPUNIT_TEST_EXCEPTION(wholeBufferTest, DataAccessLogicError);
+   CPPUNIT_TEST_EXCEPTION(directionIndexTest, DataAccessLogicError);
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void memoryModeTest() {
+      DataAccessorStub acc(true);
+      DDCalBufferDataAccessor ddAcc(acc);
+      ddAcc.setNDir(3);
+      CPPUNIT_ASSERT(!ddAcc.isStreaming());
+      ddAcc.rwDirectionVisibility(1).set(casacore::Complex(1.,-1.));
+      // directions are views into the whole buffer
+      const casacore::Cube<casacore::Complex> &vis = ddAcc.visibility();
+      CPPUNIT_ASSERT_EQUAL(3 * acc.nRow(), casacore::uInt(vis.nrow()));
+      CPPUNIT_ASSERT(abs(vis(acc.nRow(), 0, 0) - casacore::Complex(1.,-1.)) < 1e-7);
+      CPPUNIT_ASSERT(abs(ddAcc.directionVisibility(0)(0,0,0)) < 1e-7);
+      CPPUNIT_ASSERT_EQUAL(3u, ddAcc.nResidentDirections());
+   }
+
+   void streamingTest() {
+      DataAccessorStub acc(true);
+      DDCalBufferDataAccessor ddAcc(acc);
+      ddAcc.setNDir(4);
+      boost::shared_ptr<PooledBufferManager> mgr(new PooledBufferManager(64));
+      ddAcc.configureStreaming(mgr, 2);
+      CPPUNIT_ASSERT(ddAcc.isStreaming());
+      for (casacore::uInt dir = 0; dir < 4; ++dir) {
+           casacore::Cube<casacore::Complex> &vis = ddAcc.rwDirectionVisibility(dir);
+           CPPUNIT_ASSERT_EQUAL(acc.nRow(), casacore::uInt(vis.nrow()));
+           CPPUNIT_ASSERT_EQUAL(acc.nChannel(), casacore::uInt(vis.ncolumn()));
+           CPPUNIT_ASSERT_EQUAL(acc.nPol(), casacore::uInt(vis.nplane()));
+           vis.set(casacore::Complex(dir, 0.));
+           CPPUNIT_ASSERT(ddAcc.nResidentDirections() <= 2u);
+      }
+      // the first two directions have been evicted
+      CPPUNIT_ASSERT(mgr->bufferExists("DDCAL", 0));
+      CPPUNIT_ASSERT(mgr->bufferExists("DDCAL", 1));
+      CPPUNIT_ASSERT(!mgr->bufferExists("DDCAL", 3));
+      for (casacore::uInt dir = 0; dir < 4; ++dir) {
+           CPPUNIT_ASSERT(abs(ddAcc.directionVisibility(dir)(0,0,0) - casacore::Complex(dir, 0.)) < 1e-7);
+      }
+      ddAcc.flushDirections();
+      CPPUNIT_ASSERT(mgr->bufferExists("DDCAL", 3));
+      // the content is no longer used for the next chunk
+      ddAcc.discardDirections();
+      CPPUNIT_ASSERT_EQUAL(0u, ddAcc.nResidentDirections());
+      CPPUNIT_ASSERT(abs(ddAcc.directionVisibility(2)(0,0,0)) < 1e-7);
+   }
+
+   void fillerTest() {
+      DataAccessorStub acc(true);
+      DDCalBufferDataAccessor ddAcc(acc);
+      ddAcc.setNDir(3);
+      ddAcc.setDirectionFiller(fillDirection);
+      boost::shared_ptr<PooledBufferManager> mgr(new PooledBufferManager);
+      ddAcc.configureStreaming(mgr, 1);
+      CPPUNIT_ASSERT(abs(ddAcc.directionVisibility(2)(0,0,0) - casacore::Complex(2.,1.)) < 1e-7);
+      ddAcc.rwDirectionVisibility(1)(0,0,0) = casacore::Complex(-1.,0.);
+      // unmodified directions are not stored, they are computed again
+      CPPUNIT_ASSERT(abs(ddAcc.directionVisibility(2)(0,0,0) - casacore::Complex(2.,1.)) < 1e-7);
+      CPPUNIT_ASSERT(!mgr->bufferExists("DDCAL", 2));
+      CPPUNIT_ASSERT(abs(ddAcc.directionVisibility(1)(0,0,0) - casacore::Complex(-1.,0.)) < 1e-7);
+      CPPUNIT_ASSERT(abs(ddAcc.directionVisibility(1)(1,0,0) - casacore::Complex(1.,1.)) < 1e-7);
+   }
+
+   void wholeBufferTest() {
+      DataAccessorStub acc(true);
+      DDCalBufferDataAccessor ddAcc(acc);
+      ddAcc.setNDir(2);
+      boost::shared_ptr<PooledBufferManager> mgr(new PooledBufferManager);
+      ddAcc.configureStreaming(mgr, 1);
+      ddAcc.rwVisibility();
+   }
+
+   void directionIndexTest() {
+      DataAccessorStub acc(true);
+      DDCalBufferDataAccessor ddAcc(acc);
+      ddAcc.setNDir(2);
+      ddAcc.directionVisibility(2);
+   }
+
+protected:
+   /// @brief filler setting the value equal to the direction index and the imaginary part to 1
+   /// @param[in] dir direction index
+   /// @param[in] vis cube to fill
+   static void fillDirection(casacore::uInt dir, casacore::Cube<casacore::Complex> &vis) {
+      vis.set(casacore::Complex(dir, 1.));
+   }
+}; // class DDCalBufferDataAccessorTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef DDCAL_BUFFER_DATA_ACCESSOR_TEST_H
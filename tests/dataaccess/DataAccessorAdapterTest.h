@@ -37,6 +37,9 @@
 #include <askap/dataaccess/DataAccessorAdapter.h>
 #include <askap/dataaccess/TableDataSource.h>
 #include <askap/dataaccess/BestWPlaneDataAccessor.h>
+#include <askap/dataaccess/SmearingAccessorAdapter.h>
+#include <askap/dataaccess/FusedDataAccessor.h>
+#include <askap/dataaccess/WPlaneSchedule.h>
 #include "TableTestRunner.h"
 
 namespace askap {
@@ -46,6 +49,7 @@ namespace accessors {
 class DataAccessorAdapterTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(DataAccessorAdapterTest);
   CPPUNIT_TEST(onDemandBufferDATest);
+  CPPUNIT_TEST(onDemandBufferRowsTest);
   CPPUNIT_TEST(daAdapterTest);
   CPPUNIT_TEST_EXCEPTION(daAdapterDetachTest, AskapError);
   CPPUNIT_TEST_EXCEPTION(daAdapterVoidTest, AskapError);
@@ -54,8 +58,12 @@ class DataAccessorAdapterTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_EXCEPTION(daAdapterNonConstTest, AskapError);
   CPPUNIT_TEST(bestWPlaneAdapterTest);
   CPPUNIT_TEST_EXCEPTION(nonCoplanarTest, AskapError);
+  CPPUNIT_TEST(planeScheduleTest);
+  CPPUNIT_TEST(precomputePlaneScheduleTest);
   CPPUNIT_TEST(noiseAdapterTest);
   CPPUNIT_TEST(flagAdapterTest);
+  CPPUNIT_TEST(smearingFactorsTest);
+  CPPUNIT_TEST(fusedAdapterTest);
   CPPUNIT_TEST_SUITE_END();
 public:
   void onDemandBufferDATest() {
@@ -81,6 +89,33 @@ public:
       checkAllCube(acc2.visibility(),-1.);      
   }
   
+  void onDemandBufferRowsTest() {
+      DataAccessorStub acc(true);
+      const casacore::uInt nRow = acc.nRow();
+      CPPUNIT_ASSERT(nRow > 100);
+      OnDemandBufferDataAccessor acc2(acc, 10);
+      // modify rows 15-24, they cover two blocks
+      acc2.rwVisibilityRows(15,10).set(1.);
+      CPPUNIT_ASSERT(acc2.isDecoupled());
+      CPPUNIT_ASSERT_EQUAL(2u, acc2.numberOfCopiedBlocks());
+      checkAllCube(acc2.visibilityRows(15,10), 1.);
+      // untouched rows are read from the original cube without copying
+      checkAllCube(acc2.visibilityRows(50,10), 0.);
+      CPPUNIT_ASSERT_EQUAL(3u, acc2.numberOfCopiedBlocks());
+      checkAllCube(acc.visibility(), 0.);
+      // whole-cube access completes the copy
+      const casacore::Cube<casacore::Complex> &vis = acc2.visibility();
+      CPPUNIT_ASSERT_EQUAL((nRow + 9) / 10, acc2.numberOfCopiedBlocks());
+      for (casacore::uInt row = 0; row < nRow; ++row) {
+           const float expected = (row >= 15) && (row < 25) ? 1. : 0.;
+           checkAllCube(vis(casacore::Slice(row,1), casacore::Slice(), casacore::Slice()), expected);
+      }
+      acc2.discardCache();
+      CPPUNIT_ASSERT(!acc2.isDecoupled());
+      CPPUNIT_ASSERT_EQUAL(0u, acc2.numberOfCopiedBlocks());
+      checkAllCube(acc2.visibilityRows(15,10), 0.);
+  }
+
   void noiseAdapterTest() {
       DataAccessorStub acc(true);
       checkAllCube(acc.noise(),1.);
@@ -103,6 +138,60 @@ public:
       acc2.rwNoise().set(2.);
       checkAllCube(acc2.noise(),2.);                  
   }
+
+  void smearingFactorsTest() {
+      DataAccessorStub acc(true);
+      SmearingAccessorAdapter acc2(acc);
+      const casacore::MVDirection tangent(casacore::Quantity(30.,"deg"), casacore::Quantity(-45.,"deg"));
+      const casacore::MDirection tangentPoint(tangent, casacore::MDirection::J2000);
+      // no smearing at the phase centre
+      const casacore::Matrix<casacore::Float> &atCentre = acc2.smearingFactors(tangentPoint, tangent, 1e6, 10.);
+      CPPUNIT_ASSERT_EQUAL(acc.nRow(), atCentre.nrow());
+      CPPUNIT_ASSERT_EQUAL(acc.nChannel(), atCentre.ncolumn());
+      for (casacore::uInt row = 0; row < atCentre.nrow(); ++row) {
+           for (casacore::uInt chan = 0; chan < atCentre.ncolumn(); ++chan) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(1., atCentre(row, chan), 1e-6);
+           }
+      }
+      // bandwidth smearing only, the factor doesn't depend on the channel
+      casacore::MVDirection dir(tangent);
+      dir.shift(casacore::Quantity(0.5,"deg"), casacore::Quantity(0.5,"deg"), casacore::True);
+      casacore::Matrix<casacore::Float> bandwidthOnly = acc2.smearingFactors(tangentPoint, dir, 1e6, 0.).copy();
+      bool smeared = false;
+      for (casacore::uInt row = 0; row < bandwidthOnly.nrow(); ++row) {
+           for (casacore::uInt chan = 0; chan < bandwidthOnly.ncolumn(); ++chan) {
+                CPPUNIT_ASSERT(bandwidthOnly(row, chan) <= 1.);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(bandwidthOnly(row, 0), bandwidthOnly(row, chan), 1e-7);
+           }
+           if (bandwidthOnly(row, 0) < 0.999) {
+               smeared = true;
+           }
+      }
+      CPPUNIT_ASSERT(smeared);
+      // time smearing lowers the factor further (or keeps it the same)
+      const casacore::Matrix<casacore::Float> &both = acc2.smearingFactors(tangentPoint, dir, 1e6, 10.);
+      for (casacore::uInt row = 0; row < both.nrow(); ++row) {
+           for (casacore::uInt chan = 0; chan < both.ncolumn(); ++chan) {
+                CPPUNIT_ASSERT(std::abs(both(row, chan)) <= std::abs(bandwidthOnly(row, chan)) + 1e-6);
+           }
+      }
+      // the same inputs give the cached matrix
+      const casacore::Matrix<casacore::Float> &cached = acc2.smearingFactors(tangentPoint, dir, 1e6, 10.);
+      CPPUNIT_ASSERT(&cached == &both);
+      // a change of the frequencies is picked up
+      const casacore::Matrix<casacore::Float> before = both.copy();
+      acc2.rwFrequency() *= 2.;
+      const casacore::Matrix<casacore::Float> &after = acc2.smearingFactors(tangentPoint, dir, 1e6, 10.);
+      bool changed = false;
+      for (casacore::uInt row = 0; row < after.nrow(); ++row) {
+           for (casacore::uInt chan = 0; chan < after.ncolumn(); ++chan) {
+                if (std::abs(after(row, chan) - before(row, chan)) > 1e-6) {
+                    changed = true;
+                }
+           }
+      }
+      CPPUNIT_ASSERT(changed);
+  }
   
   void daAdapterTest() {
       DataAccessorStub acc(true);
@@ -244,6 +333,130 @@ public:
       CPPUNIT_ASSERT(cm != acc2.planeChangeMonitor());
   }
   
+  void fusedAdapterTest() {
+      DataAccessorStub acc(true);
+      makeCoplanar(acc, 1.3, -0.4);
+      FusedDataAccessor acc2(1);
+      CPPUNIT_ASSERT(acc2.fitsWPlane());
+      acc2.associate(acc);
+      testZeroW(acc2);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.3, acc2.coeffA(), 1e-7);
+      checkAllCube(acc2.noise(),1.);
+      acc2.rwNoise().set(2.);
+      acc2.rwVisibility().set(casacore::Complex(0.,-1.));
+      acc2.rwFlag().set(true);
+      acc2.rwFrequency()[0] = -1.;
+      checkAllCube(acc2.noise(),2.);
+      checkAllCube(acc2.visibility(),casacore::Complex(0.,-1.));
+      checkAllBoolCube(acc2.flag(),true);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-1., acc2.frequency()[0], 1e-7);
+      // the original accessor is not changed
+      checkAllCube(acc.noise(),1.);
+      checkAllBoolCube(acc.flag(),false);
+      CPPUNIT_ASSERT(acc.frequency()[0] > 0.);
+      // new association invalidates all buffers
+      acc2.associate(acc);
+      checkAllCube(acc2.noise(),1.);
+      checkAllBoolCube(acc2.flag(),false);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(acc.frequency()[0], acc2.frequency()[0], 1e-7);
+      // without fitting, w's are passed through
+      FusedDataAccessor acc3;
+      CPPUNIT_ASSERT(!acc3.fitsWPlane());
+      acc3.associate(acc);
+      const casacore::MDirection fakeTangent(acc.dishPointing1()[0], casacore::MDirection::J2000);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(acc.rotatedUVW(fakeTangent)[1](2), acc3.rotatedUVW(fakeTangent)[1](2), 1e-7);
+  }
+
+  void planeScheduleTest() {
+      DataAccessorStub acc(true);
+      const casacore::MDirection fakeTangent(acc.dishPointing1()[0], casacore::MDirection::J2000);
+      boost::shared_ptr<WPlaneSchedule> schedule(new WPlaneSchedule(fakeTangent));
+      schedule->add(100., 1.3, -0.4);
+      schedule->add(200., -0.7, 0.5);
+      CPPUNIT_ASSERT_EQUAL(size_t(2), schedule->size());
+      CPPUNIT_ASSERT_EQUAL(size_t(0), schedule->planeIndex(50.));
+      CPPUNIT_ASSERT_EQUAL(size_t(0), schedule->planeIndex(199.));
+      CPPUNIT_ASSERT_EQUAL(size_t(1), schedule->planeIndex(200.));
+      CPPUNIT_ASSERT_EQUAL(size_t(1), schedule->planeIndex(1e6));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(200., schedule->changePoint(1), 1e-7);
+
+      BestWPlaneDataAccessor acc2(1);
+      acc2.setPlaneSchedule(schedule);
+      CPPUNIT_ASSERT(acc2.planeSchedule() == schedule);
+      scimath::ChangeMonitor cm = acc2.planeChangeMonitor();
+      makeCoplanar(acc, 1.3, -0.4);
+      acc.itsTime = 150.;
+      acc2.associate(acc);
+      testZeroW(acc2);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.3, acc2.coeffA(), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.4, acc2.coeffB(), 1e-7);
+      CPPUNIT_ASSERT(cm != acc2.planeChangeMonitor());
+      cm = acc2.planeChangeMonitor();
+      // the plane changes at the scheduled time, not when the deviation exceeds the tolerance
+      makeCoplanar(acc, -0.7, 0.5);
+      acc.itsTime = 250.;
+      acc2.associate(acc);
+      testZeroW(acc2);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-0.7, acc2.coeffA(), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, acc2.coeffB(), 1e-7);
+      CPPUNIT_ASSERT(cm != acc2.planeChangeMonitor());
+      cm = acc2.planeChangeMonitor();
+      acc.itsTime = 260.;
+      acc2.associate(acc);
+      testZeroW(acc2);
+      CPPUNIT_ASSERT(cm == acc2.planeChangeMonitor());
+  }
+
+  void precomputePlaneScheduleTest() {
+      TableConstDataSource ds(TableTestRunner::msName());
+      IDataSelectorPtr sel = ds.createSelector();
+      // one accessor per time stamp
+      sel->chooseSpectralWindow(0);
+      sel->chooseAccessorFields(IDataSelector::UVW | IDataSelector::POINTING | IDataSelector::FREQUENCY);
+      IConstDataSharedIter it = ds.createConstIterator(sel);
+      CPPUNIT_ASSERT(it != it.end());
+      const casacore::MDirection tangent(it->pointingDir1()[0], casacore::MDirection::J2000);
+      // strict tolerance ensures a number of planes is fitted, the residual is not checked
+      BestWPlaneDataAccessor acc(0.01, false);
+      const boost::shared_ptr<IConstDataIterator> &iter = it;
+      const boost::shared_ptr<WPlaneSchedule> schedule = acc.precomputePlaneSchedule(*iter, tangent);
+      CPPUNIT_ASSERT(it == it.end());
+      CPPUNIT_ASSERT(schedule->size() > 1);
+      for (size_t plane = 1; plane < schedule->size(); ++plane) {
+           CPPUNIT_ASSERT(schedule->changePoint(plane - 1) < schedule->changePoint(plane));
+      }
+      // the state of the adapter is not changed
+      CPPUNIT_ASSERT(!acc.isAssociated());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., acc.coeffA(), 1e-10);
+
+      // planes taken from the schedule match those fitted as the data are accessed
+      BestWPlaneDataAccessor scheduled(0.01, false);
+      scheduled.setPlaneSchedule(schedule);
+      size_t nChanges = 0;
+      scimath::ChangeMonitor cm = acc.planeChangeMonitor();
+      for (it.init(); it != it.end(); ++it) {
+           acc.associate(*it);
+           scheduled.associate(*it);
+           const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc.rotatedUVW(tangent);
+           const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &scheduledUVW = scheduled.rotatedUVW(tangent);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(acc.coeffA(), scheduled.coeffA(), 1e-10);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(acc.coeffB(), scheduled.coeffB(), 1e-10);
+           CPPUNIT_ASSERT_EQUAL(uvw.nelements(), scheduledUVW.nelements());
+           const UVWBounds bounds = scheduled.rotatedUVWBounds(tangent);
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(scheduledUVW.nelements()), bounds.nRow());
+           for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(uvw[row](2), scheduledUVW[row](2), 1e-6);
+                // bounds correspond to w with the plane subtracted
+                CPPUNIT_ASSERT(scheduledUVW[row](2) >= bounds.minW() && scheduledUVW[row](2) <= bounds.maxW());
+           }
+           if (cm != acc.planeChangeMonitor()) {
+               ++nChanges;
+               cm = acc.planeChangeMonitor();
+           }
+      }
+      CPPUNIT_ASSERT(nChanges + 1 >= schedule->size());
+  }
+
   void nonCoplanarTest() 
   {
       DataAccessorStub acc(true);
@@ -61,8 +61,10 @@ class DataConverterTest : public CppUnit::TestFixture {
    CPPUNIT_TEST_SUITE(DataConverterTest);
    CPPUNIT_TEST(testEpochConversion);
    CPPUNIT_TEST(testDirectionConversion);
+   CPPUNIT_TEST(testBatchConversion);
    CPPUNIT_TEST_EXCEPTION(testMissingFrame,std::exception);
    CPPUNIT_TEST(testFrequencyConversion);
+   CPPUNIT_TEST(testFrequencyAxisConversion);
    CPPUNIT_TEST(testVelocityConversion);
    CPPUNIT_TEST_EXCEPTION(testMissingRestFrequency1,std::exception);
    CPPUNIT_TEST_EXCEPTION(testMissingRestFrequency2,std::exception);
@@ -144,6 +146,45 @@ public:
     CPPUNIT_ASSERT(result.separation(direction)<1e-7);
    }
 
+   /// test conversion of a number of epochs or directions in one go
+   void testBatchConversion()
+   {
+    const casacore::MEpoch refEpoch(casacore::MVEpoch(casacore::Quantity(50257.29,"d")),
+                            casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+    itsConverter->setEpochFrame(refEpoch,"s");
+    casacore::Vector<casacore::MVEpoch> epochs(5);
+    for (casacore::uInt i = 0; i < epochs.nelements(); ++i) {
+         epochs[i] = casacore::MVEpoch(casacore::Quantity(50257.29 + 0.5 * i,"d"));
+    }
+    casacore::Vector<casacore::Double> times;
+    itsConverter->epochs(epochs, casacore::MEpoch::Ref(casacore::MEpoch::UTC), times);
+    CPPUNIT_ASSERT_EQUAL(epochs.nelements(), times.nelements());
+    for (casacore::uInt i = 0; i < times.nelements(); ++i) {
+         CPPUNIT_ASSERT(fabs(times[i] - 43200. * i) < 1e-6);
+    }
+
+    // galactic to J2000 for a number of directions, compare with one-by-one conversion
+    itsConverter->setDirectionFrame(casacore::MDirection::Ref(casacore::MDirection::J2000));
+    casacore::Vector<casacore::MVDirection> galDirs(4);
+    for (casacore::uInt i = 0; i < galDirs.nelements(); ++i) {
+         galDirs[i] = casacore::MVDirection(casacore::Quantity(30. * i,"deg"),
+                                  casacore::Quantity(-50. + 20. * i,"deg"));
+    }
+    casacore::Vector<casacore::MVDirection> j2000Dirs;
+    itsConverter->directions(galDirs, casacore::MDirection::Ref(casacore::MDirection::GALACTIC), j2000Dirs);
+    CPPUNIT_ASSERT_EQUAL(galDirs.nelements(), j2000Dirs.nelements());
+    for (casacore::uInt i = 0; i < galDirs.nelements(); ++i) {
+         casacore::MVDirection result;
+         itsConverter->direction(casacore::MDirection(galDirs[i], casacore::MDirection::GALACTIC), result);
+         CPPUNIT_ASSERT(result.separation(j2000Dirs[i]) < 1e-10);
+    }
+
+    // empty input gives an empty output
+    itsConverter->directions(casacore::Vector<casacore::MVDirection>(),
+                  casacore::MDirection::Ref(casacore::MDirection::GALACTIC), j2000Dirs);
+    CPPUNIT_ASSERT_EQUAL(0u, j2000Dirs.nelements());
+   }
+
    /// test Frequency conversion
    void testFrequencyConversion()
    {
@@ -168,6 +209,56 @@ public:
      CPPUNIT_ASSERT(fabs(itsConverter->frequency(topoFreq)-1.42)<1e-5);
    }
 
+   /// test conversion of the whole frequency axis with and without caching
+   void testFrequencyAxisConversion()
+   {
+     itsConverter->setFrequencyFrame(casacore::MFrequency::Ref(
+                      casacore::MFrequency::LSRK),"GHz");
+     casacore::Vector<casacore::Double> topoFreqs(5);
+     for (casacore::uInt ch = 0; ch < topoFreqs.nelements(); ++ch) {
+          topoFreqs[ch] = 1420. + ch;
+     }
+     const casacore::MeasFrame someFrame=getSomeFrame();
+     const casacore::MEpoch when(*dynamic_cast<const casacore::MEpoch*>(someFrame.epoch()));
+     const casacore::MPosition where(*dynamic_cast<const casacore::MPosition*>(someFrame.position()));
+     const casacore::MDirection what(*dynamic_cast<const casacore::MDirection*>(someFrame.direction()));
+     const casacore::MFrequency::Ref topoRef(casacore::MFrequency::TOPO);
+
+     // exact conversion should match the channel by channel one
+     casacore::Vector<casacore::Double> exact;
+     itsConverter->frequencies(-1, topoFreqs, topoRef, "MHz", when, where, what, exact);
+     CPPUNIT_ASSERT_EQUAL(topoFreqs.nelements(), exact.nelements());
+     itsConverter->setMeasFrame(someFrame);
+     for (casacore::uInt ch = 0; ch < topoFreqs.nelements(); ++ch) {
+          const casacore::MFrequency topoFreq(casacore::MVFrequency(casacore::Quantity(topoFreqs[ch],"MHz")),
+                                              topoRef);
+          CPPUNIT_ASSERT(fabs(itsConverter->frequency(topoFreq) - exact[ch]) < 1e-10);
+          CPPUNIT_ASSERT(fabs(exact[ch] - topoFreqs[ch] / 1e3) < 1e-4);
+     }
+
+     // the axis converted for the middle of a 60s interval
+     itsConverter->setFrequencyTolerance(60.);
+     casacore::Vector<casacore::Double> approx;
+     itsConverter->frequencies(0, topoFreqs, topoRef, "MHz", when, where, what, approx);
+     CPPUNIT_ASSERT_EQUAL(topoFreqs.nelements(), approx.nelements());
+     for (casacore::uInt ch = 0; ch < topoFreqs.nelements(); ++ch) {
+          CPPUNIT_ASSERT(fabs(approx[ch] - exact[ch]) < 1e-6);
+     }
+
+     // linear interpolation between the interval boundaries
+     itsConverter->setFrequencyTolerance(60., true);
+     itsConverter->frequencies(0, topoFreqs, topoRef, "MHz", when, where, what, approx);
+     for (casacore::uInt ch = 0; ch < topoFreqs.nelements(); ++ch) {
+          CPPUNIT_ASSERT(fabs(approx[ch] - exact[ch]) < 1e-9);
+     }
+     // the second call is served from the cache
+     casacore::Vector<casacore::Double> cached;
+     itsConverter->frequencies(0, topoFreqs, topoRef, "MHz", when, where, what, cached);
+     for (casacore::uInt ch = 0; ch < topoFreqs.nelements(); ++ch) {
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(approx[ch], cached[ch], 1e-12);
+     }
+   }
+
    /// test Velocity conversion
    void testVelocityConversion()
    {
@@ -0,0 +1,97 @@
+/// @file
+/// $brief Unit tests of the storage reused by accessor fields of different shapes
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef HIGH_WATER_STORAGE_TEST_H
+#define HIGH_WATER_STORAGE_TEST_H
+
+#include <askap/dataaccess/HighWaterStorage.h>
+#include <askap/dataaccess/ArraySwap.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+namespace askap {
+
+namespace accessors {
+
+class HighWaterStorageTest : public CppUnit::TestFixture {
+   CPPUNIT_TEST_SUITE(HighWaterStorageTest);
+   CPPUNIT_TEST(reuseTest);
+   CPPUNIT_TEST(handOverTest);
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void reuseTest() {
+      HighWaterStorage<casacore::Float> storage;
+      casacore::Cube<casacore::Float> cube;
+      storage.attach(cube, casacore::IPosition(3,10,4,2));
+      CPPUNIT_ASSERT(cube.shape() == casacore::IPosition(3,10,4,2));
+      CPPUNIT_ASSERT_EQUAL(size_t(80), storage.capacity());
+      CPPUNIT_ASSERT_EQUAL(size_t(1), storage.nAllocations());
+      const casacore::Float *data = cube.data();
+      cube.set(1.);
+      // smaller chunk is a view into the same storage
+      storage.attach(cube, casacore::IPosition(3,3,5,2));
+      CPPUNIT_ASSERT(cube.shape() == casacore::IPosition(3,3,5,2));
+      CPPUNIT_ASSERT(cube.contiguousStorage());
+      CPPUNIT_ASSERT(cube.data() == data);
+      cube.set(2.);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2., cube(2,4,1), 1e-6);
+      // switching back doesn't allocate
+      storage.attach(cube, casacore::IPosition(3,10,4,2));
+      CPPUNIT_ASSERT(cube.data() == data);
+      CPPUNIT_ASSERT_EQUAL(size_t(1), storage.nAllocations());
+      // a larger chunk causes reallocation
+      storage.attach(cube, casacore::IPosition(3,10,5,2));
+      CPPUNIT_ASSERT_EQUAL(size_t(100), storage.capacity());
+      CPPUNIT_ASSERT_EQUAL(size_t(2), storage.nAllocations());
+      storage.attach(cube, casacore::IPosition(3,0,5,2));
+      CPPUNIT_ASSERT_EQUAL(size_t(0), size_t(cube.nelements()));
+   }
+
+   void handOverTest() {
+      HighWaterStorage<casacore::Float> storage;
+      casacore::Cube<casacore::Float> cube;
+      storage.attach(cube, casacore::IPosition(3,2,2,2));
+      cube.set(3.);
+      // the filled cube is given away, it shouldn't be overwritten
+      casacore::Cube<casacore::Float> other;
+      swapValues(cube, other);
+      storage.attach(cube, casacore::IPosition(3,2,2,2));
+      CPPUNIT_ASSERT(cube.data() != other.data());
+      CPPUNIT_ASSERT_EQUAL(size_t(2), storage.nAllocations());
+      cube.set(4.);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(3., other(1,1,1), 1e-6);
+   }
+}; // class HighWaterStorageTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef HIGH_WATER_STORAGE_TEST_H
@@ -0,0 +1,174 @@
+/// @file
+/// $brief Unit tests of the memory-based buffer manager using a pool of slabs
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef POOLED_BUFFER_MANAGER_TEST_H
+#define POOLED_BUFFER_MANAGER_TEST_H
+
+#include <askap/dataaccess/PooledBufferManager.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <casacore/casa/Arrays/Cube.h>
+
+namespace askap {
+
+namespace accessors {
+
+class PooledBufferManagerTest : public CppUnit::TestFixture {
+   CPPUNIT_TEST_SUITE(PooledBufferManagerTest);
+   CPPUNIT_TEST(readWriteTest);
+   CPPUNIT_TEST(reuseTest);
+   CPPUNIT_TEST_EXCEPTION(memoryLimitTest, DataAccessError);
+   CPPUNIT_TEST_EXCEPTION(undefinedBufferTest, AskapError);
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void readWriteTest() {
+      // slab size is deliberately not a divisor of the cube size
+      PooledBufferManager mgr(7);
+      CPPUNIT_ASSERT(!mgr.bufferExists("TEST",1));
+      casacore::Cube<casacore::Complex> vis(3,5,2);
+      fillCube(vis, 0.);
+      mgr.writeBuffer(vis, "TEST", 1);
+      CPPUNIT_ASSERT(mgr.bufferExists("TEST",1));
+      CPPUNIT_ASSERT(!mgr.bufferExists("TEST",0));
+      CPPUNIT_ASSERT(!mgr.bufferExists("OTHER",1));
+      CPPUNIT_ASSERT_EQUAL(size_t(5), mgr.slabsInUse());
+      casacore::Cube<casacore::Complex> result;
+      mgr.readBuffer(result, "TEST", 1);
+      CPPUNIT_ASSERT(result.shape() == vis.shape());
+      checkCube(result, 0.);
+      // a slice of a bigger cube is not contiguous
+      casacore::Cube<casacore::Complex> bigCube(6,5,2);
+      fillCube(bigCube, 10.);
+      const casacore::Cube<casacore::Complex> slice = bigCube(casacore::Slice(0,3,2),
+                 casacore::Slice(), casacore::Slice());
+      mgr.writeBuffer(slice, "TEST", 2);
+      mgr.readBuffer(result, "TEST", 2);
+      CPPUNIT_ASSERT(result.shape() == slice.shape());
+      for (casacore::uInt row = 0; row < result.nrow(); ++row) {
+           for (casacore::uInt chan = 0; chan < result.ncolumn(); ++chan) {
+                for (casacore::uInt pol = 0; pol < result.nplane(); ++pol) {
+                     CPPUNIT_ASSERT(abs(result(row,chan,pol) - bigCube(2 * row, chan, pol)) < 1e-7);
+                }
+           }
+      }
+   }
+
+   void reuseTest() {
+      PooledBufferManager mgr(10);
+      casacore::Cube<casacore::Complex> vis(4,5,2);
+      fillCube(vis, 1.);
+      mgr.writeBuffer(vis, "A", 0);
+      mgr.writeBuffer(vis, "A", 1);
+      CPPUNIT_ASSERT_EQUAL(size_t(8), mgr.slabsAllocated());
+      CPPUNIT_ASSERT_EQUAL(size_t(0), mgr.slabReuses());
+      // shrinking the cell returns slabs to the pool
+      casacore::Cube<casacore::Complex> small(1,5,2);
+      fillCube(small, 2.);
+      mgr.writeBuffer(small, "A", 1);
+      CPPUNIT_ASSERT_EQUAL(size_t(5), mgr.slabsInUse());
+      // another buffer takes slabs from the pool
+      mgr.writeBuffer(small, "B", 0);
+      CPPUNIT_ASSERT_EQUAL(size_t(8), mgr.slabsAllocated());
+      CPPUNIT_ASSERT_EQUAL(size_t(1), mgr.slabReuses());
+      mgr.releaseBuffer("A");
+      CPPUNIT_ASSERT(!mgr.bufferExists("A",0));
+      CPPUNIT_ASSERT_EQUAL(size_t(1), mgr.slabsInUse());
+      // next iteration needs the same amount of memory, no allocation is done
+      mgr.writeBuffer(vis, "A", 0);
+      mgr.writeBuffer(vis, "A", 1);
+      CPPUNIT_ASSERT_EQUAL(size_t(9), mgr.slabsAllocated());
+      CPPUNIT_ASSERT_EQUAL(size_t(8), mgr.slabReuses());
+      CPPUNIT_ASSERT_EQUAL(size_t(9), mgr.peakSlabsInUse());
+      CPPUNIT_ASSERT_EQUAL(9 * 10 * sizeof(casacore::Complex), mgr.memoryAllocated());
+      casacore::Cube<casacore::Complex> result;
+      mgr.readBuffer(result, "A", 1);
+      checkCube(result, 1.);
+      mgr.readBuffer(result, "B", 0);
+      checkCube(result, 2.);
+   }
+
+   void memoryLimitTest() {
+      // room for 4 slabs
+      PooledBufferManager mgr(10, 4 * 10 * sizeof(casacore::Complex));
+      casacore::Cube<casacore::Complex> vis(2,5,2);
+      mgr.writeBuffer(vis, "A", 0);
+      CPPUNIT_ASSERT_EQUAL(size_t(2), mgr.slabsInUse());
+      try {
+         casacore::Cube<casacore::Complex> big(3,5,2);
+         mgr.writeBuffer(big, "A", 1);
+      }
+      catch (const DataAccessError &) {
+         // the failed cell should be cleaned up
+         CPPUNIT_ASSERT(!mgr.bufferExists("A",1));
+         CPPUNIT_ASSERT_EQUAL(size_t(2), mgr.slabsInUse());
+         throw;
+      }
+   }
+
+   void undefinedBufferTest() {
+      PooledBufferManager mgr;
+      casacore::Cube<casacore::Complex> vis(2,5,2);
+      mgr.writeBuffer(vis, "A", 0);
+      mgr.readBuffer(vis, "A", 1);
+   }
+
+protected:
+   /// @brief fill cube with a pattern
+   /// @param[in] cube cube to fill
+   /// @param[in] offset value added to the real part
+   static void fillCube(casacore::Cube<casacore::Complex> &cube, float offset) {
+      for (casacore::uInt row = 0; row < cube.nrow(); ++row) {
+           for (casacore::uInt chan = 0; chan < cube.ncolumn(); ++chan) {
+                for (casacore::uInt pol = 0; pol < cube.nplane(); ++pol) {
+                     cube(row,chan,pol) = casacore::Complex(offset + row, chan + 0.5 * pol);
+                }
+           }
+      }
+   }
+
+   /// @brief check that the cube has the pattern set by fillCube
+   /// @param[in] cube cube to check
+   /// @param[in] offset value added to the real part
+   static void checkCube(const casacore::Cube<casacore::Complex> &cube, float offset) {
+      for (casacore::uInt row = 0; row < cube.nrow(); ++row) {
+           for (casacore::uInt chan = 0; chan < cube.ncolumn(); ++chan) {
+                for (casacore::uInt pol = 0; pol < cube.nplane(); ++pol) {
+                     CPPUNIT_ASSERT(abs(cube(row,chan,pol) - casacore::Complex(offset + row, chan + 0.5 * pol)) < 1e-7);
+                }
+           }
+      }
+   }
+}; // class PooledBufferManagerTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef POOLED_BUFFER_MANAGER_TEST_H
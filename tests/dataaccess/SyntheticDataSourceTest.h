@@ -0,0 +1,181 @@
+/// @file
+/// $brief Unit tests of the synthetic data source
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#ifndef SYNTHETIC_DATA_SOURCE_TEST_H
+#define SYNTHETIC_DATA_SOURCE_TEST_H
+
+#include <askap/dataaccess/SyntheticConstDataSource.h>
+#include <askap/dataaccess/SyntheticObservation.h>
+#include <askap/dataaccess/IConstDataSource.h>
+#include <askap/dataaccess/SharedIter.h>
+#include <askap/dataaccess/DataAccessError.h>
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <casacore/casa/BasicSL/Constants.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Quanta/MVPosition.h>
+
+namespace askap {
+
+namespace accessors {
+
+class SyntheticDataSourceTest : public CppUnit::TestFixture {
+   CPPUNIT_TEST_SUITE(SyntheticDataSourceTest);
+   CPPUNIT_TEST(shapeTest);
+   CPPUNIT_TEST(chunkTest);
+   CPPUNIT_TEST(selectionTest);
+   CPPUNIT_TEST(visibilityTest);
+   CPPUNIT_TEST(flagTest);
+   CPPUNIT_TEST_EXCEPTION(unsupportedSelectionTest, DataAccessLogicError);
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void shapeTest() {
+      const SyntheticObservation obs(6, 4, 16, 3);
+      CPPUNIT_ASSERT_EQUAL(casacore::uInt(84), obs.nRowsPerCycle());
+      const SyntheticConstDataSource ds(obs);
+      casacore::uInt nAccessors = 0;
+      for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++nAccessors) {
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(84), it->nRow());
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(16), it->nChannel());
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(4), it->nPol());
+           CPPUNIT_ASSERT(it->visibility().shape() == casacore::IPosition(3, 84, 16, 4));
+           CPPUNIT_ASSERT(it->flag().shape() == it->visibility().shape());
+           CPPUNIT_ASSERT_EQUAL(size_t(84), size_t(it->uvw().nelements()));
+           CPPUNIT_ASSERT_EQUAL(size_t(16), size_t(it->frequency().nelements()));
+           // rows are ordered by beam, then by baseline
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), it->feed1()[0]);
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(3), it->feed1()[83]);
+           CPPUNIT_ASSERT_EQUAL(it->antenna1()[1], casacore::uInt(0));
+           CPPUNIT_ASSERT_EQUAL(it->antenna2()[1], casacore::uInt(1));
+           for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                CPPUNIT_ASSERT(it->antenna1()[row] <= it->antenna2()[row]);
+                CPPUNIT_ASSERT_EQUAL(it->feed1()[row], it->feed2()[row]);
+           }
+      }
+      CPPUNIT_ASSERT_EQUAL(casacore::uInt(3), nAccessors);
+   }
+
+   void chunkTest() {
+      const SyntheticObservation obs(6, 4, 16, 3);
+      const SyntheticConstDataSource ds(obs, 50);
+      casacore::uInt nAccessors = 0;
+      casacore::uInt nRows = 0;
+      for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++nAccessors) {
+           // chunks do not cross cycle boundaries
+           CPPUNIT_ASSERT_EQUAL(nAccessors % 2 ? casacore::uInt(34) : casacore::uInt(50), it->nRow());
+           nRows += it->nRow();
+      }
+      CPPUNIT_ASSERT_EQUAL(casacore::uInt(6), nAccessors);
+      CPPUNIT_ASSERT_EQUAL(3 * obs.nRowsPerCycle(), nRows);
+   }
+
+   void selectionTest() {
+      const SyntheticObservation obs(6, 4, 16, 3);
+      const SyntheticConstDataSource ds(obs);
+      IDataSelectorPtr sel = ds.createSelector();
+      sel->chooseFeed(1);
+      sel->chooseCrossCorrelations();
+      sel->chooseChannels(8, 4);
+      sel->chooseCycles(1, 2);
+      casacore::uInt nAccessors = 0;
+      for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it, ++nAccessors) {
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(15), it->nRow());
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt(8), it->nChannel());
+           CPPUNIT_ASSERT(casacore::abs(it->frequency()[0] - obs.frequencies()[4]) < 1e-3);
+           for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), it->feed1()[row]);
+                CPPUNIT_ASSERT(it->antenna1()[row] != it->antenna2()[row]);
+           }
+      }
+      CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), nAccessors);
+   }
+
+   void visibilityTest() {
+      SyntheticObservation obs(6, 2, 300, 1);
+      obs.setSource(2., 1e-3, -1e-3);
+      const SyntheticConstDataSource ds(obs);
+      IConstDataSharedIter it = ds.createConstIterator();
+      CPPUNIT_ASSERT(it != it.end());
+      const double l = 1e-3, m = -1e-3, n = sqrt(1. - l * l - m * m);
+      for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+           const casacore::RigidVector<casacore::Double, 3> &uvw = it->uvw()[row];
+           // rotation preserves the baseline length
+           const casacore::MVPosition ant1 = obs.antennaPosition(it->antenna1()[row]).getValue();
+           const casacore::MVPosition ant2 = obs.antennaPosition(it->antenna2()[row]).getValue();
+           CPPUNIT_ASSERT(casacore::abs(sqrt(uvw(0) * uvw(0) + uvw(1) * uvw(1) + uvw(2) * uvw(2)) - (ant2 - ant1).getLength().getValue()) < 1e-6);
+           // the recurrence shouldn't accumulate phase errors along the spectrum
+           for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                const double phase = -casacore::C::_2pi * it->frequency()[chan] / casacore::C::c *
+                             (uvw(0) * l + uvw(1) * m + uvw(2) * (n - 1.));
+                const casacore::Complex expected(2. * cos(phase), 2. * sin(phase));
+                CPPUNIT_ASSERT(abs(it->visibility()(row, chan, 0) - expected) < 1e-4);
+                CPPUNIT_ASSERT(abs(it->visibility()(row, chan, 3) - expected) < 1e-4);
+                CPPUNIT_ASSERT(abs(it->visibility()(row, chan, 1)) < 1e-6);
+           }
+      }
+   }
+
+   void flagTest() {
+      SyntheticObservation obs(6, 4, 64, 2);
+      obs.setFlagging(0.25, 0.);
+      casacore::uInt nFlagged = 0;
+      for (casacore::uInt chan = 0; chan < obs.nChannels(); ++chan) {
+           if (obs.channelFlags()[chan]) {
+               ++nFlagged;
+           }
+      }
+      CPPUNIT_ASSERT_EQUAL(casacore::uInt(16), nFlagged);
+      const SyntheticConstDataSource ds(obs);
+      for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+           for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                     CPPUNIT_ASSERT_EQUAL(bool(obs.channelFlags()[chan]), bool(it->flag()(row, chan, 0)));
+                }
+           }
+      }
+      // all rows flagged
+      obs.setFlagging(0., 1.);
+      const SyntheticConstDataSource dsFlagged(obs);
+      for (IConstDataSharedIter it = dsFlagged.createConstIterator(); it != it.end(); ++it) {
+           CPPUNIT_ASSERT(casacore::allTrue(it->flag()));
+      }
+   }
+
+   void unsupportedSelectionTest() {
+      const SyntheticConstDataSource ds(SyntheticObservation(6, 4, 16, 3));
+      IDataSelectorPtr sel = ds.createSelector();
+      sel->chooseMinUVDistance(100.);
+   }
+}; // class SyntheticDataSourceTest
+
+} // namespace accessors
+
+} // namespace askap
+
+#endif // #ifndef SYNTHETIC_DATA_SOURCE_TEST_H
@@ -30,25 +30,90 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/thread.hpp>
 
 // casa includes
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/casa/OS/EnvVar.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/measures/Measures/UVWMachine.h>
 
 // std includes
 #include <string>
 #include <vector>
+#include <map>
+#include <algorithm>
+#include <sstream>
+#include <future>
+#include <cmath>
+#include <cstdio>
 
 // cppunit includes
 #include <cppunit/extensions/HelperMacros.h>
 
+// LOFAR includes
+#include <Blob/BlobString.h>
+#include <Blob/BlobIBufString.h>
+#include <Blob/BlobOBufString.h>
+#include <Blob/BlobIStream.h>
+#include <Blob/BlobOStream.h>
+
 // own includes
 #include <askap/dataaccess/DataAccessError.h>
+#include <askap/dataaccess/DataAccessStatistics.h>
+#include <askap/dataaccess/IORecorder.h>
+#include <askap/dataaccess/LogRateLimiter.h>
+#include <askap/dataaccess/ArrayAllocator.h>
+#include <askap/dataaccess/DeviceUploadStage.h>
+#include <askap/dataaccess/ThreadAffinity.h>
+#include <askap/dataaccess/IOThreadPool.h>
+#include <askap/dataaccess/AsyncDataAccess.h>
+#include <askap/dataaccess/RowSliceAccessor.h>
+#include <askap/dataaccess/TileSortedAccessor.h>
+#include <askap/dataaccess/BestWPlaneDataAccessor.h>
 #include <askap/dataaccess/TableInfoAccessor.h>
 #include <askap/dataaccess/TableDataSource.h>
+#include <askap/dataaccess/TableMetaDataIterator.h>
+#include <askap/dataaccess/ChunkSummaryMap.h>
+#include <askap/dataaccess/ColumnRuns.h>
 #include <askap/dataaccess/IConstDataSource.h>
 #include <askap/dataaccess/TableConstDataIterator.h>
+#include <askap/dataaccess/TableDataIterator.h>
+#include <askap/dataaccess/RowRangeSet.h>
+#include <askap/dataaccess/StreamingMSWriter.h>
+#include <askap/dataaccess/TableBufferManager.h>
+#include <askap/dataaccess/PooledBufferManager.h>
+#include <askap/dataaccess/CompactNoise.h>
+#include <askap/dataaccess/CompactVisibility.h>
+#include <askap/dataaccess/VisibilityCache.h>
+#include <askap/dataaccess/DataChecksum.h>
+#include <askap/dataaccess/RotatedUVWCache.h>
+#include <askap/dataaccess/PointingSubtableHandler.h>
+#include <askap/dataaccess/MemTableRowIndex.h>
+#include <askap/dataaccess/TableSelectionCache.h>
+#include <askap/dataaccess/ITableDataSelectorImpl.h>
+#include <askap/dataaccess/AntennaDirectionCache.h>
+#include <askap/dataaccess/BatchDirectionConverter.h>
+#include <askap/dataaccess/DirectionConverter.h>
+#include <askap/dataaccess/MultiTableConstDataSource.h>
+#include <askap/dataaccess/AccessorWireFormat.h>
+#include <askap/dataaccess/WireDataAccessor.h>
+#include <askap/dataaccess/MemoryGovernor.h>
+#include <askap/dataaccess/MultiTableConstDataIterator.h>
+#include <askap/dataaccess/TablePartitionPlan.h>
+#include <askap/dataaccess/SubtableHandlerCache.h>
+#include <askap/dataaccess/MemTableSpWindowHolder.h>
+#include <askap/dataaccess/MappedTableConstDataSource.h>
+#include <askap/dataaccess/PolarisationConversion.h>
+#include <askap/scimath/utils/PolConverter.h>
 #include "TableTestRunner.h"
 
 namespace askap {
@@ -78,6 +143,57 @@ class TableDataAccessTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(channelSelectionTest);
   CPPUNIT_TEST(freqSelectionTest);
   CPPUNIT_TEST(chunkSizeTest);
+  CPPUNIT_TEST(readAheadTest);
+  CPPUNIT_TEST(channelSlabTest);
+  CPPUNIT_TEST(accessorFieldsTest);
+  CPPUNIT_TEST(channelBlockTest);
+  CPPUNIT_TEST(parallelSpWindowTest);
+  CPPUNIT_TEST(rotatedUVWTest);
+  CPPUNIT_TEST(soaViewTest);
+  CPPUNIT_TEST(packedFlagTest);
+  CPPUNIT_TEST(writeBehindTest);
+  CPPUNIT_TEST(flagRowUpdateTest);
+  CPPUNIT_TEST(streamingWriterTest);
+  CPPUNIT_TEST(compactNoiseTest);
+  CPPUNIT_TEST(columnRunsTest);
+  CPPUNIT_TEST(rowIndexTest);
+  CPPUNIT_TEST(timeRangeSelectionTest);
+  CPPUNIT_TEST(selectionCacheTest);
+  CPPUNIT_TEST(uvDistanceIndexTest);
+  CPPUNIT_TEST(directionCacheTest);
+  CPPUNIT_TEST(multiMSTest);
+  CPPUNIT_TEST(partitionPlanTest);
+  CPPUNIT_TEST(subtableCacheTest);
+  CPPUNIT_TEST(subtableWarmTest);
+  CPPUNIT_TEST(concurrentReadTest);
+  CPPUNIT_TEST(mappedSourceTest);
+  CPPUNIT_TEST(visibilityCacheTest);
+  CPPUNIT_TEST(statisticsTest);
+  CPPUNIT_TEST(traceTest);
+  CPPUNIT_TEST(ioRecorderTest);
+  CPPUNIT_TEST(logRateLimiterTest);
+  CPPUNIT_TEST(arrayAllocatorTest);
+  CPPUNIT_TEST(deviceUploadTest);
+  CPPUNIT_TEST(threadAffinityTest);
+  CPPUNIT_TEST(asyncAccessTest);
+  CPPUNIT_TEST(channelAveragingTest);
+  CPPUNIT_TEST(rowSliceTest);
+  CPPUNIT_TEST(tileSortTest);
+  CPPUNIT_TEST(metaDataIteratorTest);
+  CPPUNIT_TEST(chunkSummaryTest);
+  CPPUNIT_TEST(uvwBoundsTest);
+  CPPUNIT_TEST(computedUVWTest);
+  CPPUNIT_TEST(polSelectionTest);
+  CPPUNIT_TEST(stokesConversionTest);
+  CPPUNIT_TEST(polConversionKernelTest);
+  CPPUNIT_TEST_EXCEPTION(polConversionTest, DataAccessLogicError);
+  CPPUNIT_TEST(checksumTest);
+  CPPUNIT_TEST(seekCycleTest);
+  CPPUNIT_TEST_EXCEPTION(seekBeyondEndTest, DataAccessLogicError);
+  CPPUNIT_TEST(uvwRotationCacheTest);
+  CPPUNIT_TEST(pointingTableTest);
+  CPPUNIT_TEST(wireFormatTest);
+  CPPUNIT_TEST(memoryGovernorTest);
   CPPUNIT_TEST_SUITE_END();
 public:
 
@@ -125,10 +241,147 @@ public:
   void freqSelectionTest();
   /// test restriction of the chunk size
   void chunkSizeTest();
+  /// test reading of the next chunk in the background
+  void readAheadTest();
+  /// test bulk reads of a channel range against the full spectra
+  void channelSlabTest();
+  /// test declaration of the subset of accessor fields
+  void accessorFieldsTest();
+  /// test splitting of the spectral axis into blocks
+  void channelBlockTest();
+  /// test parallel processing of spectral windows
+  void parallelSpWindowTest();
+  /// test batch uvw rotation against the uvw machine applied row by row
+  void rotatedUVWTest();
+  /// test struct-of-arrays view of uvw and pointing directions
+  void soaViewTest();
+  /// test bit-packed flags
+  void packedFlagTest();
+  /// test asynchronous write of original visibilities
+  void writeBehindTest();
+  /// test write back of flags for changed rows only
+  void flagRowUpdateTest();
+  /// test writing of a new measurement set from a stream of accessors
+  void streamingWriterTest();
+  /// test compact noise representation
+  void compactNoiseTest();
+  /// test run-length decomposition of DATA_DESC_ID-like columns
+  void columnRunsTest();
+  /// test row index used for selection
+  void rowIndexTest();
+  /// test selection of a time range
+  void timeRangeSelectionTest();
+  /// test cache of table selections
+  void selectionCacheTest();
+  /// test uv-distance selection via the row index
+  void uvDistanceIndexTest();
+  /// test batch direction conversion and the cache of dish pointings
+  void directionCacheTest();
+  /// test concatenation of measurement sets
+  void multiMSTest();
+  /// test splitting of the measurement set between processes
+  void partitionPlanTest();
+  /// test sharing of subtable handlers between data sources
+  void subtableCacheTest();
+  /// test construction of subtable handlers in the background
+  void subtableWarmTest();
+  /// test iteration over one data source from several threads
+  void concurrentReadTest();
+  /// test data source with memory-mapped columns
+  void mappedSourceTest();
+  void visibilityCacheTest();
+  void statisticsTest();
+  /// test export of the trace events
+  void traceTest();
+  /// test recording of the I/O access pattern
+  void ioRecorderTest();
+  /// test rate limiting of the hot path messages
+  void logRateLimiterTest();
+  /// test allocation policies for the cubes
+  void arrayAllocatorTest();
+  /// test double-buffered upload of the accessors through page-locked slots
+  void deviceUploadTest();
+  /// @brief helper method to record uploaded slots
+  static void recordUpload(const DeviceUploadStage::Slot &slot, size_t index,
+                           std::vector<casacore::Complex> *sums, size_t *maxIndex);
+  /// test placement of the read-ahead threads
+  void threadAffinityTest();
+  /// test asynchronous iteration through the I/O pool
+  void asyncAccessTest();
+  /// test averaging of adjacent channels on the fly
+  void channelAveragingTest();
+  /// @brief helper method to compare averaged accessor with the average of the full resolution one
+  static void checkChannelAverage(const IConstDataAccessor &acc, const IConstDataAccessor &ref,
+                                  casacore::uInt nAvg);
+  /// test row-range views of an accessor
+  void rowSliceTest();
+  /// @brief helper method to sum visibilities and uvw of a row slice in a separate thread
+  static void sumRowSlice(const IConstDataAccessor *acc, casacore::DComplex *result);
+  /// test views with rows sorted into grid tiles
+  void tileSortTest();
+  /// test block-wise reading of the metadata columns
+  void metaDataIteratorTest();
+  /// test summaries of time stamps collected during full passes
+  void chunkSummaryTest();
+  /// test bounding boxes of uvw computed along with uvw
+  void uvwBoundsTest();
+  /// test uvw computed from antenna positions
+  void computedUVWTest();
+  /// test reading of a subset of polarisation products
+  void polSelectionTest();
+  /// test conversion of the stored correlations into the selected products
+  void stokesConversionTest();
+  /// test conversion of polarisation products applied to whole cubes
+  void polConversionKernelTest();
+  /// test that products requiring conversion are rejected
+  void polConversionTest();
+  /// test checksums of the data computed during iteration
+  void checksumTest();
+  /// test random access to cycles and scans
+  void seekCycleTest();
+  /// test that seeking beyond the last cycle is detected
+  void seekBeyondEndTest();
+  /// test caching of rotated uvw and delays across iterations
+  void uvwRotationCacheTest();
+  /// test dish pointings interpolated from the POINTING subtable
+  void pointingTableTest();
+  /// test packing of accessors into contiguous buffers and wrapping them without copy
+  void wireFormatTest();
+  /// test the process-wide memory budget shared by the caches
+  void memoryGovernorTest();
 protected:
+  /// @brief helper method counting rows for a spectral window
+  /// @param[in] spWindow spectral window ID
+  /// @param[in] it iterator to process
+  void countRows(casacore::uInt spWindow, IConstDataIterator &it);
+  /// @brief helper method counting rows in a separate thread
+  /// @details The iterator is created in the calling thread and the result is stored
+  /// in itsRowsPerSpWindow with the given key. Nothing is stored if an exception is thrown.
+  /// @param[in] ds data source to iterate over
+  /// @param[in] sel selector to use
+  /// @param[in] conv converter to use
+  /// @param[in] key key to store the number of rows with
+  void countRowsInThread(const TableConstDataSource *ds, const IDataSelectorConstPtr &sel,
+                         const IDataConverterConstPtr &conv, casacore::uInt key);
   void doBufferTest() const;
+  /// @brief test of buffers stored with the tiled storage manager
+  void doTiledBufferTest() const;
+  /// @brief helper method to compare row numbers
+  /// @param[in] rows sorted row numbers obtained from the index
+  /// @param[in] selection table obtained via the table selection
+  static void checkRows(const std::vector<casacore::rownr_t> &rows,
+                        const casacore::Table &selection);
+  /// @brief helper method to compare the bounding box with the uvw it has been computed for
+  /// @param[in] bounds bounding box to check
+  /// @param[in] uvw vector with uvw coordinates
+  static void checkBounds(const UVWBounds &bounds,
+                          const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw);
 private:
   boost::shared_ptr<ITableInfoAccessor> itsTableInfoAccessor;
+  /// @brief number of rows per spectral window (used in parallelSpWindowTest and concurrentReadTest)
+  std::map<casacore::uInt, casacore::uInt> itsRowsPerSpWindow;
+  /// @brief mutex protecting itsRowsPerSpWindow
+  boost::mutex itsRowsMutex;
 }; // class TableDataAccessTest
 
 void TableDataAccessTest::setUp()
@@ -242,6 +495,306 @@ void TableDataAccessTest::chunkSizeTest()
 }
 
 
+void TableDataAccessTest::readAheadTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   IDataSelectorPtr sel = ds.createSelector();
+   sel->chooseChannels(3,2);
+   // break each time step into a number of chunks to exercise both the read-ahead
+   // within the same time step and across the time steps
+   ds.configureMaxChunkSize(7);
+   IConstDataSharedIter refIt = ds.createConstIterator(sel);
+   ds.configureReadAhead(true);
+   IConstDataSharedIter it = ds.createConstIterator(sel);
+   // the test dataset is not compressed, so read-ahead is only enabled on request
+   const boost::shared_ptr<TableConstDataIterator> tabRefIt = refIt.dynamicCast<TableConstDataIterator>();
+   const boost::shared_ptr<TableConstDataIterator> tabIt = it.dynamicCast<TableConstDataIterator>();
+   CPPUNIT_ASSERT(tabRefIt && tabIt);
+   CPPUNIT_ASSERT(!tabIt->compressedDataColumn());
+   CPPUNIT_ASSERT_EQUAL(std::string(), tabIt->compressingDataManager());
+   CPPUNIT_ASSERT(!tabRefIt->readAheadEnabled());
+   CPPUNIT_ASSERT(tabIt->readAheadEnabled());
+   casacore::uInt count = 0;
+   for (; it != it.end(); ++it, ++refIt, ++count) {
+        CPPUNIT_ASSERT(refIt != refIt.end());
+        CPPUNIT_ASSERT_EQUAL(refIt->nRow(), it->nRow());
+        CPPUNIT_ASSERT_EQUAL(refIt->nChannel(), it->nChannel());
+        CPPUNIT_ASSERT_EQUAL(refIt->nPol(), it->nPol());
+        // skip uvw for some chunks to check that unused buffers don't break the iteration
+        if (count % 3 != 1) {
+            for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+                 for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                      CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->uvw()[row](dim), it->uvw()[row](dim), 1e-10);
+                 }
+            }
+        }
+        const casacore::Cube<casacore::Complex> &vis = it->visibility();
+        const casacore::Cube<casacore::Complex> &refVis = refIt->visibility();
+        const casacore::Cube<casacore::Bool> &flag = it->flag();
+        const casacore::Cube<casacore::Bool> &refFlag = refIt->flag();
+        CPPUNIT_ASSERT(vis.shape() == refVis.shape());
+        CPPUNIT_ASSERT(flag.shape() == refFlag.shape());
+        for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+             for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+                  for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                       CPPUNIT_ASSERT_DOUBLES_EQUAL(0., casacore::abs(vis(row,chan,pol) - refVis(row,chan,pol)), 1e-6);
+                       CPPUNIT_ASSERT_EQUAL(refFlag(row,chan,pol), flag(row,chan,pol));
+                  }
+             }
+        }
+   }
+   CPPUNIT_ASSERT(refIt == refIt.end());
+   CPPUNIT_ASSERT(count > 0);
+}
+
+void TableDataAccessTest::channelSlabTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   // channel range is read with a single slicer for all rows of the chunk
+   IDataSelectorPtr sel = ds.createSelector();
+   const casacore::uInt startChan = 2;
+   sel->chooseChannels(3, startChan);
+   IConstDataSharedIter refIt = ds.createConstIterator();
+   IConstDataSharedIter it = ds.createConstIterator(sel);
+   casacore::uInt count = 0;
+   for (; it != it.end(); ++it, ++refIt, ++count) {
+        CPPUNIT_ASSERT(refIt != refIt.end());
+        CPPUNIT_ASSERT_EQUAL(refIt->nRow(), it->nRow());
+        CPPUNIT_ASSERT_EQUAL(casacore::uInt(3), it->nChannel());
+        const casacore::Cube<casacore::Complex> &vis = it->visibility();
+        const casacore::Cube<casacore::Complex> &refVis = refIt->visibility();
+        const casacore::Cube<casacore::Bool> &flag = it->flag();
+        const casacore::Cube<casacore::Bool> &refFlag = refIt->flag();
+        CPPUNIT_ASSERT(vis.shape() == flag.shape());
+        for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+             for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+                  for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                       CPPUNIT_ASSERT_DOUBLES_EQUAL(0., casacore::abs(vis(row,chan,pol) -
+                                                    refVis(row,chan + startChan,pol)), 1e-6);
+                       CPPUNIT_ASSERT_EQUAL(refFlag(row,chan + startChan,pol), flag(row,chan,pol));
+                  }
+             }
+        }
+   }
+   CPPUNIT_ASSERT(refIt == refIt.end());
+   CPPUNIT_ASSERT(count > 0);
+}
+
+void TableDataAccessTest::accessorFieldsTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   IDataSelectorPtr sel = ds.createSelector();
+   sel->chooseAccessorFields(IDataSelector::VISIBILITY | IDataSelector::FLAG | IDataSelector::ANTENNA);
+   ds.configureReadAhead(true);
+   casacore::uInt count = 0;
+   for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it,++count) {
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->visibility().nrow()));
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->flag().nrow()));
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->antenna1().nelements()));
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->antenna2().nelements()));
+        // time is always available
+        it->time();
+        CPPUNIT_ASSERT_THROW(it->uvw(), DataAccessLogicError);
+        CPPUNIT_ASSERT_THROW(it->noise(), DataAccessLogicError);
+        CPPUNIT_ASSERT_THROW(it->pointingDir1(), DataAccessLogicError);
+        CPPUNIT_ASSERT_THROW(it->feed1(), DataAccessLogicError);
+   }
+   CPPUNIT_ASSERT(count > 0);
+   // pointing directions imply antenna and feed indices used internally
+   sel = ds.createSelector();
+   sel->chooseAccessorFields(IDataSelector::POINTING);
+   for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it) {
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->pointingDir1().nelements()));
+        CPPUNIT_ASSERT_THROW(it->visibility(), DataAccessLogicError);
+   }
+}
+
+void TableDataAccessTest::channelBlockTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   IDataSelectorPtr sel = ds.createSelector();
+   IConstDataSharedIter refIt = ds.createConstIterator(sel);
+   const casacore::uInt maxChannels = 3;
+   ds.configureMaxChannelBlock(maxChannels);
+   IConstDataSharedIter it = ds.createConstIterator(sel);
+   casacore::uInt count = 0;
+   for (; refIt != refIt.end(); ++refIt, ++count) {
+        const casacore::Cube<casacore::Complex> &refVis = refIt->visibility();
+        const casacore::Vector<casacore::Double> &refFreq = refIt->frequency();
+        // each reference accessor corresponds to a number of accessors with the same rows
+        for (casacore::uInt startChan = 0; startChan < refIt->nChannel(); ++it) {
+             CPPUNIT_ASSERT(it != it.end());
+             CPPUNIT_ASSERT_EQUAL(refIt->nRow(), it->nRow());
+             CPPUNIT_ASSERT_EQUAL(refIt->nPol(), it->nPol());
+             CPPUNIT_ASSERT(it->nChannel() <= maxChannels);
+             CPPUNIT_ASSERT(it->nChannel() > 0);
+             CPPUNIT_ASSERT(startChan + it->nChannel() <= refIt->nChannel());
+             const casacore::Cube<casacore::Complex> &vis = it->visibility();
+             const casacore::Vector<casacore::Double> &freq = it->frequency();
+             CPPUNIT_ASSERT_EQUAL(it->nChannel(), casacore::uInt(freq.nelements()));
+             CPPUNIT_ASSERT_EQUAL(it->nChannel(), casacore::uInt(vis.ncolumn()));
+             for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL(refFreq[startChan + chan], freq[chan], 1e-6);
+                  for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+                       CPPUNIT_ASSERT_EQUAL(refIt->antenna1()[row], it->antenna1()[row]);
+                       for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                            CPPUNIT_ASSERT_DOUBLES_EQUAL(0., casacore::abs(vis(row,chan,pol) -
+                                        refVis(row,startChan + chan,pol)), 1e-6);
+                       }
+                  }
+             }
+             startChan += it->nChannel();
+        }
+   }
+   CPPUNIT_ASSERT(it == it.end());
+   CPPUNIT_ASSERT(count > 0);
+}
+
+void TableDataAccessTest::countRows(casacore::uInt spWindow, IConstDataIterator &it)
+{
+   casacore::uInt nRows = 0;
+   for (; it.hasMore(); it.next()) {
+        nRows += (*it).nRow();
+        CPPUNIT_ASSERT_EQUAL(casacore::uInt((*it).nRow()), casacore::uInt((*it).visibility().nrow()));
+   }
+   boost::lock_guard<boost::mutex> lock(itsRowsMutex);
+   itsRowsPerSpWindow[spWindow] += nRows;
+}
+
+void TableDataAccessTest::parallelSpWindowTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   IDataSelectorPtr sel = ds.createSelector();
+   IDataConverterPtr conv = ds.createConverter();
+   casacore::uInt totalRows = 0;
+   for (IConstDataSharedIter it=ds.createConstIterator(sel,conv);it!=it.end();++it) {
+        totalRows += it->nRow();
+   }
+   itsRowsPerSpWindow.clear();
+   ds.processSpectralWindows(sel, conv, 2, boost::bind(&TableDataAccessTest::countRows, this, _1, _2));
+   CPPUNIT_ASSERT(itsRowsPerSpWindow.size() > 0);
+   casacore::uInt parallelRows = 0;
+   for (std::map<casacore::uInt, casacore::uInt>::const_iterator ci = itsRowsPerSpWindow.begin();
+        ci != itsRowsPerSpWindow.end(); ++ci) {
+        parallelRows += ci->second;
+   }
+   CPPUNIT_ASSERT_EQUAL(totalRows, parallelRows);
+}
+
+void TableDataAccessTest::rotatedUVWTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   const casacore::MDirection tangent(casacore::MVDirection(0.12345,-0.12345), casacore::MDirection::J2000);
+   int maxiter = 3;
+   for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end() && maxiter>0;++it,--maxiter) {
+        const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &rotated = it->rotatedUVW(tangent);
+        const casacore::Vector<casacore::Double> &delays = it->uvwRotationDelay(tangent, tangent);
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(rotated.nelements()));
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(delays.nelements()));
+        for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+             const casacore::MDirection phaseCentre(it->pointingDir1()[row], casacore::MDirection::J2000);
+             casacore::UVWMachine machine(tangent, phaseCentre, false, false);
+             casacore::Vector<casacore::Double> buf(3);
+             for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                  buf(dim) = (dim < 2 ? -1. : 1.) * it->uvw()[row](dim);
+             }
+             casacore::Double delay = 0.;
+             machine.convertUVW(delay, buf);
+             for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL((dim < 2 ? -1. : 1.) * buf(dim), rotated[row](dim), 1e-6);
+             }
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(delay, delays[row], 1e-6);
+        }
+   }
+}
+
+void TableDataAccessTest::soaViewTest()
+{
+   TableConstDataSource ds(TableTestRunner::msName());
+   int maxiter = 3;
+   for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end() && maxiter>0;++it,--maxiter) {
+        const TableConstDataAccessor *acc = dynamic_cast<const TableConstDataAccessor*>(&(*it));
+        CPPUNIT_ASSERT(acc != NULL);
+        const casacore::Matrix<casacore::Double> &uvw = acc->uvwColumns();
+        const casacore::Matrix<casacore::Double> &dir1 = acc->pointingDir1Columns();
+        const casacore::Matrix<casacore::Double> &dir2 = acc->pointingDir2Columns();
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(uvw.nrow()));
+        CPPUNIT_ASSERT_EQUAL(3u, casacore::uInt(uvw.ncolumn()));
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(dir1.nrow()));
+        CPPUNIT_ASSERT_EQUAL(2u, casacore::uInt(dir1.ncolumn()));
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(dir2.nrow()));
+        CPPUNIT_ASSERT_EQUAL(2u, casacore::uInt(dir2.ncolumn()));
+        for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+             for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL(it->uvw()[row](dim), uvw(row,dim), 1e-10);
+             }
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(it->pointingDir1()[row].getLong(), dir1(row,0), 1e-10);
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(it->pointingDir1()[row].getLat(), dir1(row,1), 1e-10);
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(it->pointingDir2()[row].getLong(), dir2(row,0), 1e-10);
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(it->pointingDir2()[row].getLat(), dir2(row,1), 1e-10);
+        }
+        // contiguous ids and baseline indices
+        const casacore::uInt nAnt = ds.getNumberOfAntennas();
+        const casacore::uInt *ant1 = acc->antenna1Data();
+        const casacore::uInt *ant2 = acc->antenna2Data();
+        const casacore::uInt *feed1 = acc->feed1Data();
+        const casacore::uInt *feed2 = acc->feed2Data();
+        const casacore::Vector<casacore::uInt> &baselines = acc->baselineIndex();
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(baselines.nelements()));
+        for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+             CPPUNIT_ASSERT_EQUAL(it->antenna1()[row], ant1[row]);
+             CPPUNIT_ASSERT_EQUAL(it->antenna2()[row], ant2[row]);
+             CPPUNIT_ASSERT_EQUAL(it->feed1()[row], feed1[row]);
+             CPPUNIT_ASSERT_EQUAL(it->feed2()[row], feed2[row]);
+             CPPUNIT_ASSERT_EQUAL(ant1[row] * nAnt + ant2[row], baselines[row]);
+             CPPUNIT_ASSERT(baselines[row] < nAnt * nAnt);
+        }
+   }
+}
+
+void TableDataAccessTest::packedFlagTest()
+{
+   // first test the packed cube itself with a flag pattern crossing the word boundary
+   casacore::Cube<casacore::Bool> flags(3, 40, 2, casacore::False);
+   flags.yzPlane(1) = casacore::True;
+   flags(2, 33, 1) = casacore::True;
+   const PackedFlagCube packed(flags);
+   CPPUNIT_ASSERT_EQUAL(3u, packed.nRow());
+   CPPUNIT_ASSERT_EQUAL(40u, packed.nChannel());
+   CPPUNIT_ASSERT_EQUAL(2u, packed.nPol());
+   CPPUNIT_ASSERT_EQUAL(size_t(2), packed.wordsPerRow());
+   CPPUNIT_ASSERT(packed.noneFlagged(0));
+   CPPUNIT_ASSERT(packed.allFlagged(1));
+   CPPUNIT_ASSERT_EQUAL(PackedFlagCube::PARTIALLY_FLAGGED, packed.rowSummary(2));
+   for (casacore::uInt row = 0; row < flags.nrow(); ++row) {
+        for (casacore::uInt chan = 0; chan < flags.ncolumn(); ++chan) {
+             for (casacore::uInt pol = 0; pol < flags.nplane(); ++pol) {
+                  CPPUNIT_ASSERT_EQUAL(bool(flags(row, chan, pol)), packed(row, chan, pol));
+             }
+        }
+   }
+
+   // now the accessor
+   TableConstDataSource ds(TableTestRunner::msName());
+   int maxiter = 3;
+   for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end() && maxiter>0;++it,--maxiter) {
+        const TableConstDataAccessor *acc = dynamic_cast<const TableConstDataAccessor*>(&(*it));
+        CPPUNIT_ASSERT(acc != NULL);
+        const PackedFlagCube &accPacked = acc->packedFlag();
+        const casacore::Cube<casacore::Bool> &accFlags = it->flag();
+        CPPUNIT_ASSERT_EQUAL(it->nRow(), accPacked.nRow());
+        CPPUNIT_ASSERT_EQUAL(it->nChannel(), accPacked.nChannel());
+        CPPUNIT_ASSERT_EQUAL(it->nPol(), accPacked.nPol());
+        for (casacore::uInt row = 0; row < accFlags.nrow(); ++row) {
+             for (casacore::uInt chan = 0; chan < accFlags.ncolumn(); ++chan) {
+                  for (casacore::uInt pol = 0; pol < accFlags.nplane(); ++pol) {
+                       CPPUNIT_ASSERT_EQUAL(bool(accFlags(row, chan, pol)), accPacked(row, chan, pol));
+                  }
+             }
+        }
+   }
+}
+
 /// test of correlation type selection
 void TableDataAccessTest::corrTypeSelectionTest()
 {
@@ -379,6 +932,10 @@ void TableDataAccessTest::bufferManagerTest()
   itsTableInfoAccessor.reset(new TableInfoAccessor(
             casacore::Table(TableTestRunner::msName(),casacore::Table::Update), false));
   doBufferTest();
+  // disk buffers with the tiled storage manager, tiles of 3 rows
+  itsTableInfoAccessor.reset(new TableInfoAccessor(
+            casacore::Table(TableTestRunner::msName(),casacore::Table::Update), false, "DATA", 480));
+  doTiledBufferTest();
 }
 
 /// test access to data description subtable
@@ -476,6 +1033,18 @@ void TableDataAccessTest::feedTest()
        }
        CPPUNIT_ASSERT(fabs(feedSubtable.getBeamPA(time,0,0,feed))<1e-5);
   }
+  CPPUNIT_ASSERT(!feedSubtable.newBeamDetails(time,0));
+  CPPUNIT_ASSERT(feedSubtable.getAllBeamOffsets(time,0).nelements() == 
+                 feedSubtable.getAllBeamPAs(time,0).nelements());
+  CPPUNIT_ASSERT(feedSubtable.getIndices().nrow() >= 6);
+  CPPUNIT_ASSERT(feedSubtable.getIndices().ncolumn() >= 5);
+  // going back in time within the same interval shouldn't change anything
+  const casacore::MEpoch earlierTime(casacore::MVEpoch(casacore::Quantity(50257.2,"d")),
+                    casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+  if (!feedSubtable.newBeamDetails(earlierTime,0)) {
+      CPPUNIT_ASSERT(fabs(feedSubtable.getBeamOffset(earlierTime,0,0,0)(0)-
+                     feedSubtable.getBeamOffset(time,0,0,0)(0))<1e-7);
+  }
 }
 
 /// test access to the field subtable
@@ -496,6 +1065,14 @@ void TableDataAccessTest::fieldTest()
                  casacore::MDirection::J2000);
   CPPUNIT_ASSERT(fieldSubtable.getReferenceDir(time).getValue().
                  separation(refDir)<1e-7);
+  CPPUNIT_ASSERT(!fieldSubtable.newField(time));
+  // going back in time should give the same field
+  const casacore::MEpoch earlierTime(casacore::MVEpoch(casacore::Quantity(50257.2,"d")),
+                    casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+  CPPUNIT_ASSERT(fieldSubtable.getReferenceDir(earlierTime).getValue().
+                 separation(refDir)<1e-7);
+  CPPUNIT_ASSERT(fieldSubtable.getReferenceDir(time).getValue().
+                 separation(refDir)<1e-7);
 
   // test random access (for row=0)
   CPPUNIT_ASSERT(fieldSubtable.getReferenceDir(0).getRef().getType() ==
@@ -536,6 +1113,50 @@ void TableDataAccessTest::doBufferTest() const
   }
 }
 
+/// @brief test of buffers stored with the tiled storage manager
+/// @details This also tests read/write of a range of rows
+void TableDataAccessTest::doTiledBufferTest() const
+{
+  const TableBufferManager *bufferMgr = dynamic_cast<const TableBufferManager*>(
+              &(itsTableInfoAccessor->subtableInfo().getBufferManager()));
+  CPPUNIT_ASSERT(bufferMgr != NULL);
+  CPPUNIT_ASSERT_EQUAL(size_t(480), bufferMgr->maxTileSize());
+  const casacore::uInt index = 2;
+  CPPUNIT_ASSERT(!bufferMgr->bufferExists("TILED",index));
+  casacore::Cube<casacore::Complex> vis(6,10,2);
+  for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+       vis.yzPlane(row) = casacore::Complex(float(row), -0.5);
+  }
+  bufferMgr->writeBuffer(vis,"TILED",index);
+  CPPUNIT_ASSERT(bufferMgr->bufferExists("TILED",index));
+  // the block of rows crosses the tile boundary
+  casacore::Cube<casacore::Complex> block(2,10,2);
+  bufferMgr->readBufferRows(block,"TILED",index,2);
+  for (casacore::uInt row = 0; row < block.nrow(); ++row) {
+       for (casacore::uInt chan = 0; chan < block.ncolumn(); ++chan) {
+            for (casacore::uInt pol = 0; pol < block.nplane(); ++pol) {
+                 CPPUNIT_ASSERT(abs(block(row,chan,pol) - casacore::Complex(float(row + 2), -0.5))<1e-7);
+            }
+       }
+  }
+  block.set(casacore::Complex(0.,1.));
+  bufferMgr->writeBufferRows(block,"TILED",index,3);
+  casacore::Cube<casacore::Complex> result;
+  bufferMgr->readBuffer(result,"TILED",index);
+  CPPUNIT_ASSERT(result.shape() == vis.shape());
+  for (casacore::uInt row = 0; row < result.nrow(); ++row) {
+       const casacore::Complex expected = (row == 3) || (row == 4) ? casacore::Complex(0.,1.) :
+                                          casacore::Complex(float(row), -0.5);
+       for (casacore::uInt chan = 0; chan < result.ncolumn(); ++chan) {
+            for (casacore::uInt pol = 0; pol < result.nplane(); ++pol) {
+                 CPPUNIT_ASSERT(abs(result(row,chan,pol) - expected)<1e-7);
+            }
+       }
+  }
+  // writing rows of an undefined buffer should fail
+  CPPUNIT_ASSERT_THROW(bufferMgr->writeBufferRows(block,"TILED",index+1,0), askap::AskapError);
+}
+
 /// test access to the antenna subtable
 void TableDataAccessTest::antennaTest()
 {
@@ -841,6 +1462,2325 @@ void TableDataAccessTest::originalVisRewriteTest()
   }
 }
 
+/// test row index used for selection
+void TableDataAccessTest::rowIndexTest()
+{
+  const casacore::Table ms(TableTestRunner::msName());
+  const MemTableRowIndex index(ms);
+  // compare with the result of the table selection
+  checkRows(index.antennaRows(2u), ms((ms.col("ANTENNA1") == 2) || (ms.col("ANTENNA2") == 2)));
+  checkRows(index.baselineRows(0u, 1u), ms((ms.col("ANTENNA1") == 0) && (ms.col("ANTENNA2") == 1)));
+  checkRows(index.feedRows(0u), ms((ms.col("FEED1") == 0) && (ms.col("FEED2") == 0)));
+  checkRows(index.autoCorrelationRows(), ms((ms.col("ANTENNA1") == ms.col("ANTENNA2")) &&
+            (ms.col("FEED1") == ms.col("FEED2"))));
+  checkRows(index.crossCorrelationRows(), ms((ms.col("ANTENNA1") != ms.col("ANTENNA2")) ||
+            (ms.col("FEED1") != ms.col("FEED2"))));
+  checkRows(index.dataDescRows(std::vector<size_t>(1, 0)), ms(ms.col("DATA_DESC_ID") == 0));
+  CPPUNIT_ASSERT_EQUAL(size_t(0), index.dataDescRows(std::vector<size_t>()).size());
+
+  // combined selection through the iterator
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseCrossCorrelations();
+  sel->chooseBaseline(0u, 1u);
+  size_t nRows = 0;
+  for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it) {
+       for (casacore::uInt row=0;row<it->nRow();++row) {
+            CPPUNIT_ASSERT_EQUAL(0u, it->antenna1()[row]);
+            CPPUNIT_ASSERT_EQUAL(1u, it->antenna2()[row]);
+       }
+       nRows += it->nRow();
+  }
+  CPPUNIT_ASSERT_EQUAL(index.baselineRows(0u, 1u).size(), nRows);
+}
+
+/// test selection of a time range
+void TableDataAccessTest::timeRangeSelectionTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  // count rows per time stamp
+  std::vector<std::pair<casacore::Double, casacore::uInt> > rowsPerTime;
+  for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end();++it) {
+       rowsPerTime.push_back(std::pair<casacore::Double, casacore::uInt>(it->time(), it->nRow()));
+  }
+  CPPUNIT_ASSERT(rowsPerTime.size() > 3);
+  // interval ends are excluded from the selection
+  const casacore::Double start = rowsPerTime[1].first;
+  const casacore::Double stop = rowsPerTime[rowsPerTime.size() - 2].first;
+  casacore::uInt expectedRows = 0;
+  for (size_t i = 0; i < rowsPerTime.size(); ++i) {
+       if ((rowsPerTime[i].first > start) && (rowsPerTime[i].first < stop)) {
+           expectedRows += rowsPerTime[i].second;
+       }
+  }
+  // binary search on the row index
+  const casacore::Table ms(TableTestRunner::msName());
+  const MemTableRowIndex index(ms);
+  if (index.timeOrdered()) {
+      const casacore::Vector<casacore::Double> times =
+            casacore::ROScalarColumn<casacore::Double>(ms, "TIME").getColumn();
+      const std::pair<casacore::rownr_t, casacore::rownr_t> range =
+            index.timeRange(times[0], times[times.nelements() - 1]);
+      CPPUNIT_ASSERT(range.first > 0);
+      CPPUNIT_ASSERT(range.second < times.nelements());
+      CPPUNIT_ASSERT(times[range.first] > times[0]);
+      CPPUNIT_ASSERT(times[range.first - 1] == times[0]);
+      CPPUNIT_ASSERT(times[range.second] == times[times.nelements() - 1]);
+      CPPUNIT_ASSERT(times[range.second - 1] < times[times.nelements() - 1]);
+  }
+  // the result should be the same regardless of how the selection is done
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseTimeRange(start, stop);
+  casacore::uInt nRows = 0;
+  for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it) {
+       CPPUNIT_ASSERT(it->time() > start);
+       CPPUNIT_ASSERT(it->time() < stop);
+       nRows += it->nRow();
+  }
+  CPPUNIT_ASSERT_EQUAL(expectedRows, nRows);
+
+  // chaining with the selection based on the row index
+  sel = ds.createSelector();
+  sel->chooseCrossCorrelations();
+  sel->chooseTimeRange(start, stop);
+  for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it) {
+       CPPUNIT_ASSERT(it->time() > start);
+       CPPUNIT_ASSERT(it->time() < stop);
+       for (casacore::uInt row=0;row<it->nRow();++row) {
+            CPPUNIT_ASSERT((it->antenna1()[row] != it->antenna2()[row]) ||
+                           (it->feed1()[row] != it->feed2()[row]));
+       }
+  }
+}
+
+/// test cache of table selections
+void TableDataAccessTest::selectionCacheTest()
+{
+  const casacore::Table ms(TableTestRunner::msName());
+  const TableSelectionCache cache(ms, 2);
+  casacore::Table tab;
+  CPPUNIT_ASSERT(!cache.find("A", tab));
+  cache.add("A", ms(ms.col("ANTENNA1") == 0));
+  cache.add("B", ms(ms.col("ANTENNA1") == 1));
+  CPPUNIT_ASSERT(cache.find("A", tab));
+  CPPUNIT_ASSERT_EQUAL(ms(ms.col("ANTENNA1") == 0).nrow(), tab.nrow());
+  // B is the least recently used selection now
+  cache.add("C", ms(ms.col("ANTENNA1") == 2));
+  CPPUNIT_ASSERT_EQUAL(size_t(2), cache.size());
+  CPPUNIT_ASSERT(!cache.find("B", tab));
+  CPPUNIT_ASSERT(cache.find("A", tab));
+  CPPUNIT_ASSERT(cache.find("C", tab));
+  CPPUNIT_ASSERT_EQUAL(size_t(3), cache.hits());
+
+  // canonical form of the selection should not depend on the order of calls
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel1 = ds.createSelector();
+  sel1->chooseCrossCorrelations();
+  sel1->chooseFeed(0u);
+  IDataSelectorPtr sel2 = ds.createSelector();
+  sel2->chooseFeed(0u);
+  sel2->chooseCrossCorrelations();
+  IDataSelectorPtr sel3 = ds.createSelector();
+  sel3->chooseFeed(1u);
+  sel3->chooseCrossCorrelations();
+  const boost::shared_ptr<ITableDataSelectorImpl> impl1 = boost::dynamic_pointer_cast<ITableDataSelectorImpl>(sel1);
+  const boost::shared_ptr<ITableDataSelectorImpl> impl2 = boost::dynamic_pointer_cast<ITableDataSelectorImpl>(sel2);
+  const boost::shared_ptr<ITableDataSelectorImpl> impl3 = boost::dynamic_pointer_cast<ITableDataSelectorImpl>(sel3);
+  CPPUNIT_ASSERT(impl1 && impl2 && impl3);
+  CPPUNIT_ASSERT_EQUAL(impl1->getSelectionKey(), impl2->getSelectionKey());
+  CPPUNIT_ASSERT(impl1->getSelectionKey() != impl3->getSelectionKey());
+  CPPUNIT_ASSERT_EQUAL(std::string(), boost::dynamic_pointer_cast<ITableDataSelectorImpl>(
+                       ds.createSelector())->getSelectionKey());
+
+  // repeated iteration, the second one uses the cached selection
+  casacore::uInt nRows[2] = {0u, 0u};
+  for (int pass = 0; pass < 2; ++pass) {
+       for (IConstDataSharedIter it=ds.createConstIterator(pass ? sel2 : sel1);it!=it.end();++it) {
+            for (casacore::uInt row=0;row<it->nRow();++row) {
+                 CPPUNIT_ASSERT_EQUAL(0u, it->feed1()[row]);
+                 CPPUNIT_ASSERT_EQUAL(0u, it->feed2()[row]);
+                 CPPUNIT_ASSERT(it->antenna1()[row] != it->antenna2()[row]);
+            }
+            nRows[pass] += it->nRow();
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(nRows[0], nRows[1]);
+  // the second iteration replays the plan built by the first one
+  CPPUNIT_ASSERT(ds.subtableInfo().getSelectionCache().planHits() > 0);
+
+  // iteration plans are dropped together with their selections
+  boost::shared_ptr<TableSelectionCache::IterationPlan const> plan(new TableSelectionCache::IterationPlan(1,
+                       std::make_pair(casacore::rownr_t(0), ms.nrow())));
+  boost::shared_ptr<TableSelectionCache::IterationPlan const> foundPlan;
+  cache.addPlan("B", plan);
+  CPPUNIT_ASSERT(!cache.findPlan("B", foundPlan));
+  cache.addPlan("A", plan);
+  cache.addPlan("", plan);
+  CPPUNIT_ASSERT(cache.findPlan("A", foundPlan));
+  CPPUNIT_ASSERT(foundPlan == plan);
+  CPPUNIT_ASSERT(cache.findPlan("", foundPlan));
+  cache.add("A", ms(ms.col("ANTENNA1") == 0));
+  CPPUNIT_ASSERT(!cache.findPlan("A", foundPlan));
+  CPPUNIT_ASSERT_EQUAL(size_t(2), cache.planHits());
+}
+
+/// test uv-distance selection via the row index
+void TableDataAccessTest::uvDistanceIndexTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  TableConstDataSource indexedDS(TableTestRunner::msName());
+  indexedDS.configureUVDistanceIndex(true);
+  for (int test = 0; test < 3; ++test) {
+       IDataSelectorPtr sel = ds.createSelector();
+       IDataSelectorPtr indexedSel = indexedDS.createSelector();
+       if (test == 0) {
+           sel->chooseMinUVDistance(1000.);
+           indexedSel->chooseMinUVDistance(1000.);
+       } else if (test == 1) {
+           sel->chooseMaxUVDistance(3000.);
+           indexedSel->chooseMaxUVDistance(3000.);
+       } else {
+           sel->chooseMinNonZeroUVDistance(1000.);
+           indexedSel->chooseMinNonZeroUVDistance(1000.);
+       }
+       casacore::uInt nRows = 0;
+       for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it) {
+            nRows += it->nRow();
+       }
+       casacore::uInt nIndexedRows = 0;
+       for (IConstDataSharedIter it=indexedDS.createConstIterator(indexedSel);it!=it.end();++it) {
+            for (casacore::uInt row=0;row<it->nRow();++row) {
+                 const casacore::RigidVector<casacore::Double, 3> &uvw = it->uvw()(row);
+                 const casacore::Double uvDist = sqrt(casacore::square(uvw(0))+
+                                                  casacore::square(uvw(1)));
+                 if (test == 1) {
+                     CPPUNIT_ASSERT(uvDist <= 3000.);
+                 } else if (test == 0) {
+                     CPPUNIT_ASSERT(uvDist >= 1000.);
+                 }
+            }
+            nIndexedRows += it->nRow();
+       }
+       CPPUNIT_ASSERT_EQUAL(nRows, nIndexedRows);
+  }
+}
+
+/// test batch direction conversion and the cache of dish pointings
+void TableDataAccessTest::directionCacheTest()
+{
+  const casacore::MEpoch epoch(casacore::MVEpoch(casacore::Quantity(50257.29,"d")),
+                    casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+  const casacore::MDirection dir(casacore::MVDirection(casacore::Quantity(0.,"deg"), 
+                    casacore::Quantity(-50.,"deg")), casacore::MDirection::J2000);
+  const casacore::MPosition pos(casacore::MVPosition(-4.75e6, 2.79e6, -3.2e6), 
+                    casacore::MPosition::ITRF);
+
+  // batch converter should give the same result as the plain one 
+  DirectionConverter plainConv((casacore::MDirection::Ref(casacore::MDirection::AZEL)));
+  plainConv.setMeasFrame(casacore::MeasFrame(epoch, pos));
+  BatchDirectionConverter batchConv((casacore::MDirection::Ref(casacore::MDirection::AZEL)));
+  batchConv.setEpoch(epoch);
+  batchConv.setPosition(pos);
+  CPPUNIT_ASSERT(batchConv(dir).separation(plainConv(dir)) < 1e-9);
+  // the same engine is reused for another epoch
+  const casacore::MEpoch laterEpoch(casacore::MVEpoch(casacore::Quantity(50257.4,"d")),
+                    casacore::MEpoch::Ref(casacore::MEpoch::UTC));
+  plainConv.setMeasFrame(casacore::MeasFrame(laterEpoch, pos));
+  batchConv.setEpoch(laterEpoch);
+  CPPUNIT_ASSERT(batchConv(dir).separation(plainConv(dir)) < 1e-9);
+
+  // the cache keeps the first epochs when it is full
+  const AntennaDirectionCache cache(1);
+  casacore::Vector<casacore::Double> angles;
+  CPPUNIT_ASSERT(!cache.findParallacticAngles(epoch, dir, angles));
+  cache.addParallacticAngles(epoch, dir, casacore::Vector<casacore::Double>(3, 0.5));
+  cache.addParallacticAngles(laterEpoch, dir, casacore::Vector<casacore::Double>(3, 1.));
+  CPPUNIT_ASSERT(cache.findParallacticAngles(epoch, dir, angles));
+  CPPUNIT_ASSERT_EQUAL(size_t(3), size_t(angles.nelements()));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, angles[2], 1e-10);
+  CPPUNIT_ASSERT(!cache.findParallacticAngles(laterEpoch, dir, angles));
+  casacore::Vector<casacore::MVDirection> dirs;
+  CPPUNIT_ASSERT(!cache.findDishPointings(epoch, dir, 
+                  casacore::MDirection::Ref(casacore::MDirection::J2000), dirs));
+  CPPUNIT_ASSERT_EQUAL(size_t(1), cache.size());
+  CPPUNIT_ASSERT_EQUAL(size_t(1), cache.hits());
+
+  // the second pass over the data uses cached dish pointings
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseCrossCorrelations();
+  std::vector<casacore::MVDirection> pointings;
+  for (int pass = 0; pass < 2; ++pass) {
+       size_t counter = 0;
+       for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it,++counter) {
+            CPPUNIT_ASSERT(it->nRow() > 0);
+            const casacore::MVDirection &pnt = it->dishPointing1()[0];
+            if (pass) {
+                CPPUNIT_ASSERT(counter < pointings.size());
+                CPPUNIT_ASSERT(pnt.separation(pointings[counter]) < 1e-9);
+            } else {
+                pointings.push_back(pnt);
+            }
+            CPPUNIT_ASSERT(it->pointingDir1()[0].separation(pnt) < 1e-2);
+       }
+       CPPUNIT_ASSERT_EQUAL(pointings.size(), counter);
+  }
+}
+
+/// test concatenation of measurement sets
+void TableDataAccessTest::multiMSTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseCrossCorrelations();
+  std::vector<std::pair<casacore::Double, casacore::uInt> > rowsPerTime;
+  for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it) {
+       rowsPerTime.push_back(std::pair<casacore::Double, casacore::uInt>(it->time(), it->nRow()));
+  }
+  CPPUNIT_ASSERT(rowsPerTime.size() > 0);
+
+  // the same measurement set given twice, subtables are shared
+  const std::vector<std::string> names(2, TableTestRunner::msName());
+  const MultiTableConstDataSource msOrderDS(names);
+  CPPUNIT_ASSERT_EQUAL(size_t(2), msOrderDS.nSources());
+  IDataSelectorPtr multiSel = msOrderDS.createSelector();
+  multiSel->chooseCrossCorrelations();
+  size_t counter = 0;
+  for (IConstDataSharedIter it=msOrderDS.createConstIterator(multiSel);it!=it.end();++it,++counter) {
+       CPPUNIT_ASSERT(counter < 2 * rowsPerTime.size());
+       const size_t expected = counter % rowsPerTime.size();
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(rowsPerTime[expected].first, it->time(), 1e-6);
+       CPPUNIT_ASSERT_EQUAL(rowsPerTime[expected].second, it->nRow());
+       for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+            CPPUNIT_ASSERT(it->antenna1()[row] != it->antenna2()[row]);
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(2 * rowsPerTime.size(), counter);
+  CPPUNIT_ASSERT_EQUAL(size_t(4), msOrderDS.sharedSubtables());
+  CPPUNIT_ASSERT_EQUAL(ds.getNumberOfAntennas(), msOrderDS.source(1).getNumberOfAntennas());
+
+  // accessors of both measurement sets are interleaved in the time order
+  const MultiTableConstDataSource timeOrderDS(names, "DATA", MultiTableConstDataSource::TIME_ORDER);
+  multiSel = timeOrderDS.createSelector();
+  multiSel->chooseCrossCorrelations();
+  const boost::shared_ptr<IConstDataIterator> it =
+        timeOrderDS.createConstIterator(multiSel, timeOrderDS.createConverter());
+  const boost::shared_ptr<MultiTableConstDataIterator> multiIt =
+        boost::dynamic_pointer_cast<MultiTableConstDataIterator>(it);
+  CPPUNIT_ASSERT(multiIt);
+  std::vector<size_t> perSource(2, 0);
+  casacore::Double prevTime = rowsPerTime[0].first;
+  for (; it->hasMore(); it->next()) {
+       CPPUNIT_ASSERT(multiIt->currentSource() < perSource.size());
+       CPPUNIT_ASSERT((*it)->time() >= prevTime);
+       prevTime = (*it)->time();
+       ++perSource[multiIt->currentSource()];
+  }
+  CPPUNIT_ASSERT_EQUAL(rowsPerTime.size(), perSource[0]);
+  CPPUNIT_ASSERT_EQUAL(rowsPerTime.size(), perSource[1]);
+}
+
+/// test splitting of the measurement set between processes
+void TableDataAccessTest::partitionPlanTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  const casacore::Table ms(TableTestRunner::msName());
+  const casacore::uInt nParts = 3;
+  const TablePartitionPlan::Mode modes[] = {TablePartitionPlan::CHANNEL, TablePartitionPlan::TIME,
+                                            TablePartitionPlan::BASELINE};
+  for (size_t m = 0; m < 3; ++m) {
+       const TablePartitionPlan plan(ms, modes[m], nParts);
+       CPPUNIT_ASSERT_EQUAL(nParts, plan.nParts());
+       // the plan survives serialisation
+       LOFAR::BlobString bs;
+       bs.resize(0);
+       LOFAR::BlobOBufString bob(bs);
+       LOFAR::BlobOStream out(bob);
+       plan.write(out);
+       LOFAR::BlobIBufString bib(bs);
+       LOFAR::BlobIStream in(bib);
+       TablePartitionPlan copy;
+       copy.read(in);
+       CPPUNIT_ASSERT_EQUAL(plan.mode(), copy.mode());
+       CPPUNIT_ASSERT_EQUAL(nParts, copy.nParts());
+       // parts cover the whole dataset without overlap
+       casacore::uInt64 totalWeight = 0;
+       casacore::uInt64 maxWeight = 0;
+       for (casacore::uInt part = 0; part < nParts; ++part) {
+            CPPUNIT_ASSERT_EQUAL(plan.weight(part), copy.weight(part));
+            totalWeight += plan.weight(part);
+            maxWeight = std::max(maxWeight, plan.weight(part));
+            IDataSelectorPtr sel = ds.createSelector();
+            const boost::shared_ptr<TableDataSelector> tabSel =
+                  boost::dynamic_pointer_cast<TableDataSelector>(sel);
+            CPPUNIT_ASSERT(tabSel);
+            copy.apply(part, *tabSel);
+            casacore::uInt64 weight = 0;
+            for (IConstDataSharedIter it=ds.createConstIterator(sel);it!=it.end();++it) {
+                 weight += modes[m] == TablePartitionPlan::CHANNEL ? it->nRow() * it->nChannel() : it->nRow();
+                 if (modes[m] == TablePartitionPlan::CHANNEL) {
+                     CPPUNIT_ASSERT_EQUAL(plan.channels(part).second, it->nChannel());
+                 }
+            }
+            CPPUNIT_ASSERT_EQUAL(plan.weight(part), weight);
+       }
+       if (modes[m] == TablePartitionPlan::CHANNEL) {
+           CPPUNIT_ASSERT(maxWeight * nParts < totalWeight + ms.nrow() * nParts);
+       } else {
+           CPPUNIT_ASSERT_EQUAL(casacore::uInt64(ms.nrow()), totalWeight);
+       }
+  }
+}
+
+/// test sharing of subtable handlers between data sources
+void TableDataAccessTest::subtableCacheTest()
+{
+  SubtableHandlerCache &cache = SubtableHandlerCache::instance();
+  cache.clear();
+  const casacore::Table ms(TableTestRunner::msName());
+  const size_t misses = cache.misses();
+  const size_t hits = cache.hits();
+  boost::shared_ptr<ITableSpWindowHolder const> spWin1 =
+        cache.get<MemTableSpWindowHolder, ITableSpWindowHolder>(ms, "SPECTRAL_WINDOW");
+  const boost::shared_ptr<ITableSpWindowHolder const> spWin2 =
+        cache.get<MemTableSpWindowHolder, ITableSpWindowHolder>(casacore::Table(TableTestRunner::msName()),
+                  "SPECTRAL_WINDOW");
+  CPPUNIT_ASSERT(spWin1 == spWin2);
+  CPPUNIT_ASSERT_EQUAL(misses + 1, cache.misses());
+  CPPUNIT_ASSERT_EQUAL(hits + 1, cache.hits());
+  // handlers are not kept alive by the cache
+  spWin1.reset();
+  CPPUNIT_ASSERT_EQUAL(misses + 1, cache.misses());
+  // two data sources on the same measurement set read the subtables once
+  cache.clear();
+  TableConstDataSource ds1(TableTestRunner::msName());
+  TableConstDataSource ds2(TableTestRunner::msName());
+  IConstDataSharedIter it1 = ds1.createConstIterator();
+  CPPUNIT_ASSERT(it1 != it1.end());
+  const casacore::uInt nChan = it1->frequency().nelements();
+  const size_t missesAfterFirst = cache.misses();
+  CPPUNIT_ASSERT(missesAfterFirst > misses + 1);
+  IConstDataSharedIter it2 = ds2.createConstIterator();
+  CPPUNIT_ASSERT(it2 != it2.end());
+  CPPUNIT_ASSERT_EQUAL(nChan, casacore::uInt(it2->frequency().nelements()));
+  CPPUNIT_ASSERT_EQUAL(missesAfterFirst, cache.misses());
+  CPPUNIT_ASSERT(cache.hits() > hits + 1);
+}
+
+/// test construction of subtable handlers in the background
+void TableDataAccessTest::subtableWarmTest()
+{
+  SubtableHandlerCache &cache = SubtableHandlerCache::instance();
+  cache.clear();
+  TableConstDataSource ds(TableTestRunner::msName());
+  const size_t misses = cache.misses();
+  std::shared_future<void> warm = ds.warmSubtables(ISubtableInfoHolder::ANTENNA |
+                    ISubtableInfoHolder::SPECTRAL_WINDOW | ISubtableInfoHolder::DATA_DESCRIPTION);
+  // getters called while the handlers are being built should see the same objects
+  const IAntennaSubtableHandler &antenna = ds.subtableInfo().getAntenna();
+  warm.get();
+  CPPUNIT_ASSERT_EQUAL(misses + 3, cache.misses());
+  CPPUNIT_ASSERT(&antenna == &ds.subtableInfo().getAntenna());
+  const casacore::Table antTable(TableTestRunner::msName() + "/ANTENNA");
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(antTable.nrow()), antenna.getNumberOfAntennas());
+  // handlers which already exist are not built again
+  ds.subtableInfo().preload(ISubtableInfoHolder::ANTENNA | ISubtableInfoHolder::SPECTRAL_WINDOW);
+  CPPUNIT_ASSERT_EQUAL(misses + 3, cache.misses());
+  IConstDataSharedIter it = ds.createConstIterator();
+  CPPUNIT_ASSERT(it != it.end());
+  CPPUNIT_ASSERT(it->frequency().nelements() > 0);
+  // the data source may go away before the background thread finishes
+  std::shared_future<void> orphan;
+  {
+    TableConstDataSource ds2(TableTestRunner::msName());
+    orphan = ds2.warmSubtables();
+  }
+  orphan.get();
+}
+
+/// @brief helper method counting rows in a separate thread
+/// @param[in] ds data source to iterate over
+/// @param[in] sel selector to use
+/// @param[in] conv converter to use
+/// @param[in] key key to store the number of rows with
+void TableDataAccessTest::countRowsInThread(const TableConstDataSource *ds, const IDataSelectorConstPtr &sel,
+                                            const IDataConverterConstPtr &conv, casacore::uInt key)
+{
+  try {
+     const boost::shared_ptr<IConstDataIterator> it = ds->createConstIterator(sel, conv);
+     CPPUNIT_ASSERT(it);
+     countRows(key, *it);
+  }
+  catch (...) {
+     // missing key is detected by the test
+  }
+}
+
+/// test iteration over one data source from several threads
+void TableDataAccessTest::concurrentReadTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  ds.configureConcurrentRead(true);
+  ds.configureMaxChunkSize(7);
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseCrossCorrelations();
+  IDataConverterPtr conv = ds.createConverter();
+  casacore::uInt totalRows = 0;
+  for (IConstDataSharedIter it=ds.createConstIterator(sel,conv);it!=it.end();++it) {
+       totalRows += it->nRow();
+  }
+  CPPUNIT_ASSERT(totalRows > 0);
+  itsRowsPerSpWindow.clear();
+  const casacore::uInt nThreads = 4;
+  boost::thread_group threads;
+  for (casacore::uInt thread = 0; thread < nThreads; ++thread) {
+       threads.create_thread(boost::bind(&TableDataAccessTest::countRowsInThread, this, &ds,
+                             IDataSelectorConstPtr(sel), IDataConverterConstPtr(conv), thread));
+  }
+  threads.join_all();
+  CPPUNIT_ASSERT_EQUAL(size_t(nThreads), itsRowsPerSpWindow.size());
+  for (std::map<casacore::uInt, casacore::uInt>::const_iterator ci = itsRowsPerSpWindow.begin();
+       ci != itsRowsPerSpWindow.end(); ++ci) {
+       CPPUNIT_ASSERT_EQUAL(totalRows, ci->second);
+  }
+}
+
+/// test data source with memory-mapped columns
+void TableDataAccessTest::mappedSourceTest()
+{
+  // the result should be the same regardless of whether the layout of the
+  // test dataset allows the columns to be mapped
+  TableConstDataSource ds(TableTestRunner::msName());
+  MappedTableConstDataSource mds(TableTestRunner::msName());
+  ds.configureMaxChunkSize(11);
+  mds.configureMaxChunkSize(11);
+  for (int pass = 0; pass < 2; ++pass) {
+       IDataSelectorPtr sel = ds.createSelector();
+       IDataSelectorPtr msel = mds.createSelector();
+       if (pass > 0) {
+           sel->chooseChannels(2, 1);
+           msel->chooseChannels(2, 1);
+           sel->chooseCrossCorrelations();
+           msel->chooseCrossCorrelations();
+       }
+       IConstDataSharedIter it = ds.createConstIterator(sel);
+       IConstDataSharedIter mit = mds.createConstIterator(msel);
+       size_t count = 0;
+       for (; it != it.end(); ++it, ++mit, ++count) {
+            CPPUNIT_ASSERT(mit != mit.end());
+            CPPUNIT_ASSERT_EQUAL(it->nRow(), mit->nRow());
+            const casacore::Cube<casacore::Complex> &vis = it->visibility();
+            const casacore::Cube<casacore::Complex> &mvis = mit->visibility();
+            const casacore::Cube<casacore::Bool> &flag = it->flag();
+            const casacore::Cube<casacore::Bool> &mflag = mit->flag();
+            CPPUNIT_ASSERT(vis.shape() == mvis.shape());
+            CPPUNIT_ASSERT(flag.shape() == mflag.shape());
+            for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+                 for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+                      for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                           CPPUNIT_ASSERT(abs(vis(row,chan,pol) - mvis(row,chan,pol)) < 1e-7);
+                           CPPUNIT_ASSERT_EQUAL(flag(row,chan,pol), mflag(row,chan,pol));
+                      }
+                 }
+            }
+       }
+       CPPUNIT_ASSERT(mit == mit.end());
+       CPPUNIT_ASSERT(count > 0);
+  }
+  CPPUNIT_ASSERT(!mds.isMapped("NON_EXISTENT_COLUMN"));
+}
+
+/// test caching of visibilities and flags between iterations
+void TableDataAccessTest::visibilityCacheTest()
+{
+  // first test the compact representation itself
+  casacore::Cube<casacore::Complex> vis(3, 4, 2);
+  for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+       for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+            for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                 vis(row, chan, pol) = casacore::Complex(0.1 * (row + 1) * (chan + 1), -1.5 * pol + 0.01 * chan);
+            }
+       }
+  }
+  CompactVisibility compact;
+  casacore::Cube<casacore::Complex> expanded;
+  compact.assign(vis, CompactVisibility::HALF);
+  CPPUNIT_ASSERT_EQUAL(CompactVisibility::HALF, compact.precision());
+  compact.expand(expanded);
+  CPPUNIT_ASSERT(expanded.shape() == vis.shape());
+  for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+       for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+            for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                 // 11 bits of mantissa
+                 CPPUNIT_ASSERT(abs(expanded(row, chan, pol) - vis(row, chan, pol)) <
+                                1e-3 * abs(vis(row, chan, pol)) + 1e-6);
+            }
+       }
+  }
+  compact.assign(vis, CompactVisibility::INT16);
+  // two 16-bit integers per visibility and a scale per row
+  CPPUNIT_ASSERT_EQUAL(vis.nelements() * 2 * sizeof(uint16_t) + vis.nrow() * sizeof(casacore::Float),
+                       compact.memoryUsage());
+  compact.expand(expanded);
+  for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+       // the scale is the largest component in the row
+       const casacore::Float scale = std::max(casacore::Float(0.4 * (row + 1)), casacore::Float(1.5));
+       for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+            for (casacore::uInt pol = 0; pol < vis.nplane(); ++pol) {
+                 CPPUNIT_ASSERT(abs(expanded(row, chan, pol) - vis(row, chan, pol)) < scale / 32767.);
+            }
+       }
+  }
+
+  // now iterate twice over the dataset, the second pass should be served from the cache
+  for (int mode = 0; mode < 2; ++mode) {
+       TableConstDataSource ds(TableTestRunner::msName());
+       ds.configureMaxChunkSize(11);
+       ds.configureVisibilityCache(true, CompactVisibility::INT16, mode > 0 ? "/tmp" : "");
+       const boost::shared_ptr<VisibilityCache> cache = ds.visibilityCache();
+       CPPUNIT_ASSERT(cache);
+       CPPUNIT_ASSERT_EQUAL(mode > 0, cache->onDisk());
+       IDataSelectorPtr sel = ds.createSelector();
+       sel->chooseChannels(4, 2);
+       std::vector<casacore::Cube<casacore::Complex> > visBuffer;
+       std::vector<casacore::Cube<casacore::Bool> > flagBuffer;
+       for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it) {
+            visBuffer.push_back(it->visibility().copy());
+            flagBuffer.push_back(it->flag().copy());
+       }
+       CPPUNIT_ASSERT(visBuffer.size() > 0);
+       CPPUNIT_ASSERT_EQUAL(size_t(0), cache->hits());
+       const size_t misses = cache->misses();
+       CPPUNIT_ASSERT_EQUAL(2 * visBuffer.size(), misses);
+       if (mode > 0) {
+           CPPUNIT_ASSERT(cache->diskUsage() > 0);
+       }
+       // a different selection doesn't match the cached data
+       IDataSelectorPtr otherSel = ds.createSelector();
+       otherSel->chooseChannels(2, 0);
+       IConstDataSharedIter otherIt = ds.createConstIterator(otherSel);
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), otherIt->visibility().ncolumn());
+       CPPUNIT_ASSERT_EQUAL(size_t(0), cache->hits());
+       CPPUNIT_ASSERT_EQUAL(misses + 1, cache->misses());
+       // same selection, the data should be the same as in the first pass
+       size_t count = 0;
+       for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it, ++count) {
+            CPPUNIT_ASSERT(count < visBuffer.size());
+            const casacore::Cube<casacore::Complex> &cachedVis = it->visibility();
+            const casacore::Cube<casacore::Bool> &cachedFlag = it->flag();
+            CPPUNIT_ASSERT(cachedVis.shape() == visBuffer[count].shape());
+            CPPUNIT_ASSERT(cachedFlag.shape() == flagBuffer[count].shape());
+            for (casacore::uInt row = 0; row < cachedVis.nrow(); ++row) {
+                 for (casacore::uInt chan = 0; chan < cachedVis.ncolumn(); ++chan) {
+                      for (casacore::uInt pol = 0; pol < cachedVis.nplane(); ++pol) {
+                           CPPUNIT_ASSERT(cachedVis(row, chan, pol) == visBuffer[count](row, chan, pol));
+                           CPPUNIT_ASSERT_EQUAL(flagBuffer[count](row, chan, pol), cachedFlag(row, chan, pol));
+                      }
+                 }
+            }
+       }
+       CPPUNIT_ASSERT_EQUAL(visBuffer.size(), count);
+       CPPUNIT_ASSERT_EQUAL(2 * count, cache->hits());
+       CPPUNIT_ASSERT_EQUAL(misses + 1, cache->misses());
+  }
+
+  // cached flags should match the measurement set exactly, visibilities within the quantisation error
+  TableConstDataSource ds(TableTestRunner::msName());
+  TableConstDataSource cds(TableTestRunner::msName());
+  cds.configureVisibilityCache(true);
+  IConstDataSharedIter cit = cds.createConstIterator();
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++cit) {
+       CPPUNIT_ASSERT(cit != cit.end());
+       const casacore::Cube<casacore::Complex> &origVis = it->visibility();
+       const casacore::Cube<casacore::Complex> &cachedVis = cit->visibility();
+       const casacore::Cube<casacore::Bool> &origFlag = it->flag();
+       const casacore::Cube<casacore::Bool> &cachedFlag = cit->flag();
+       CPPUNIT_ASSERT(origVis.shape() == cachedVis.shape());
+       for (casacore::uInt row = 0; row < origVis.nrow(); ++row) {
+            casacore::Float maxAbs = 0.;
+            for (casacore::uInt chan = 0; chan < origVis.ncolumn(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < origVis.nplane(); ++pol) {
+                      maxAbs = std::max(maxAbs, std::max(std::abs(real(origVis(row, chan, pol))),
+                                                         std::abs(imag(origVis(row, chan, pol)))));
+                 }
+            }
+            for (casacore::uInt chan = 0; chan < origVis.ncolumn(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < origVis.nplane(); ++pol) {
+                      CPPUNIT_ASSERT(abs(origVis(row, chan, pol) - cachedVis(row, chan, pol)) <= maxAbs / 32767. + 1e-7);
+                      CPPUNIT_ASSERT_EQUAL(origFlag(row, chan, pol), cachedFlag(row, chan, pol));
+                 }
+            }
+       }
+  }
+  CPPUNIT_ASSERT(cit == cit.end());
+}
+
+/// test counters of the data access stages
+void TableDataAccessTest::statisticsTest()
+{
+  const bool wasEnabled = DataAccessStatistics::enabled();
+  DataAccessStatistics::enable(false);
+  DataAccessStatistics::reset();
+  TableConstDataSource ds(TableTestRunner::msName());
+  IConstDataSharedIter it = ds.createConstIterator();
+  CPPUNIT_ASSERT(it->visibility().nelements() > 0);
+  // nothing is collected while disabled
+  CPPUNIT_ASSERT(DataAccessStatistics::allCounters().size() == 0);
+  DataAccessStatistics::enable();
+  if (!DataAccessStatistics::enabled()) {
+      // the library is built without statistics
+      DataAccessStatistics::enable(wasEnabled);
+      return;
+  }
+  size_t count = 0;
+  size_t bytes = 0;
+  for (it.init(); it != it.end(); ++it, ++count) {
+       bytes += it->visibility().nelements() * sizeof(casacore::Complex);
+       it->flag();
+       it->uvw();
+  }
+  DataAccessStatistics::enable(wasEnabled);
+  const DataAccessStatistics::Counters vis = DataAccessStatistics::counters("TableConstDataIterator::fillVisibility");
+  CPPUNIT_ASSERT_EQUAL(count, vis.itsCalls);
+  CPPUNIT_ASSERT_EQUAL(bytes, vis.itsBytes);
+  CPPUNIT_ASSERT_EQUAL(count, vis.itsHits + vis.itsMisses);
+  CPPUNIT_ASSERT(vis.itsTime >= 0.);
+  CPPUNIT_ASSERT_EQUAL(count, DataAccessStatistics::counters("TableConstDataIterator::fillFlag").itsCalls);
+  CPPUNIT_ASSERT_EQUAL(count, DataAccessStatistics::counters("TableConstDataIterator::fillUVW").itsCalls);
+  CPPUNIT_ASSERT_EQUAL(size_t(0), DataAccessStatistics::counters("NON_EXISTENT_STAGE").itsCalls);
+  DataAccessStatistics::log();
+  DataAccessStatistics::reset();
+  CPPUNIT_ASSERT(DataAccessStatistics::allCounters().size() == 0);
+}
+
+/// test export of the trace events
+void TableDataAccessTest::traceTest()
+{
+  const bool wasEnabled = DataAccessStatistics::enabled();
+  const bool wasTracing = DataAccessStatistics::tracing();
+  DataAccessStatistics::reset();
+  DataAccessStatistics::enableTrace();
+  if (!DataAccessStatistics::enabled()) {
+      // the library is built without statistics
+      DataAccessStatistics::enableTrace(wasTracing);
+      DataAccessStatistics::enable(wasEnabled);
+      return;
+  }
+  TableConstDataSource ds(TableTestRunner::msName());
+  size_t count = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++count) {
+       it->visibility();
+  }
+  DataAccessStatistics::enableTrace(wasTracing);
+  DataAccessStatistics::enable(wasEnabled);
+  CPPUNIT_ASSERT(count > 0);
+  const std::vector<DataAccessStatistics::TraceEvent> events = DataAccessStatistics::traceEvents();
+  CPPUNIT_ASSERT_EQUAL(size_t(0), DataAccessStatistics::droppedEvents());
+  size_t visEvents = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+       CPPUNIT_ASSERT(events[i].itsDuration >= 0.);
+       if (std::string(events[i].itsStage) == "TableConstDataIterator::fillVisibility") {
+           CPPUNIT_ASSERT(events[i].itsBytes > 0);
+           ++visEvents;
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(count, visEvents);
+  CPPUNIT_ASSERT_EQUAL(count, DataAccessStatistics::counters("TableConstDataIterator::fillVisibility").itsCalls);
+  std::ostringstream os;
+  DataAccessStatistics::writeTrace(os);
+  CPPUNIT_ASSERT(os.str().find("\"traceEvents\"") != std::string::npos);
+  CPPUNIT_ASSERT(os.str().find("TableConstDataIterator::fillVisibility") != std::string::npos);
+  DataAccessStatistics::reset();
+  CPPUNIT_ASSERT_EQUAL(size_t(0), DataAccessStatistics::traceEvents().size());
+  CPPUNIT_ASSERT_EQUAL(size_t(0), DataAccessStatistics::droppedEvents());
+}
+
+/// test recording of the I/O access pattern
+void TableDataAccessTest::ioRecorderTest()
+{
+  if (IORecorder::enabled()) {
+      // recording is set up via the environment, don't interfere with it
+      return;
+  }
+  const std::string name = "tmp.iorecorder.trace";
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseChannels(3, 2);
+  IORecorder::start(name);
+  CPPUNIT_ASSERT(IORecorder::enabled());
+  size_t count = 0;
+  casacore::uInt nRows = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it, ++count) {
+       it->visibility();
+       nRows += it->nRow();
+  }
+  IORecorder::stop();
+  CPPUNIT_ASSERT(!IORecorder::enabled());
+  CPPUNIT_ASSERT(count > 0);
+  const std::vector<IORecorder::Event> events = IORecorder::readTrace(name);
+  CPPUNIT_ASSERT_EQUAL(IORecorder::eventsRecorded(), events.size());
+  const std::string msName = casacore::Table(TableTestRunner::msName()).tableName();
+  size_t visEvents = 0;
+  casacore::uInt visRows = 0;
+  for (size_t i = 0; i < events.size(); ++i) {
+       CPPUNIT_ASSERT(events[i].itsStart >= 0.);
+       CPPUNIT_ASSERT(events[i].itsDuration >= 0.);
+       CPPUNIT_ASSERT(events[i].itsThread > 0);
+       if ((events[i].itsType == IORecorder::TABLE_READ) && (events[i].itsDetail == "DATA")) {
+           CPPUNIT_ASSERT_EQUAL(msName, events[i].itsObject);
+           CPPUNIT_ASSERT_EQUAL(size_t(4), events[i].itsCoordinates.size());
+           CPPUNIT_ASSERT_EQUAL(casacore::Int64(3), events[i].itsCoordinates[2]);
+           CPPUNIT_ASSERT_EQUAL(casacore::Int64(2), events[i].itsCoordinates[3]);
+           CPPUNIT_ASSERT(events[i].itsBytes > 0);
+           visRows += static_cast<casacore::uInt>(events[i].itsCoordinates[1]);
+           ++visEvents;
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(count, visEvents);
+  CPPUNIT_ASSERT_EQUAL(nRows, visRows);
+  CPPUNIT_ASSERT_EQUAL(std::string("table_read"), IORecorder::typeName(IORecorder::TABLE_READ));
+  std::remove(name.c_str());
+}
+
+/// test rate limiting of the hot path messages
+void TableDataAccessTest::logRateLimiterTest()
+{
+  const double oldInterval = LogRateLimiter::interval();
+  LogRateLimiter::setInterval(1000.);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(1000., LogRateLimiter::interval(), 1e-6);
+  LogRateLimiter limiter;
+  size_t suppressed = 100;
+  // the first message is always let through
+  CPPUNIT_ASSERT(limiter.allow(suppressed));
+  CPPUNIT_ASSERT_EQUAL(size_t(0), suppressed);
+  for (size_t i = 0; i < 5; ++i) {
+       CPPUNIT_ASSERT(!limiter.allow(suppressed));
+  }
+  // zero interval lets everything through and reports the suppressed messages once
+  LogRateLimiter::setInterval(0.);
+  CPPUNIT_ASSERT(limiter.allow(suppressed));
+  CPPUNIT_ASSERT_EQUAL(size_t(5), suppressed);
+  CPPUNIT_ASSERT(limiter.allow(suppressed));
+  CPPUNIT_ASSERT_EQUAL(size_t(0), suppressed);
+  // negative interval suppresses everything
+  LogRateLimiter::setInterval(-1.);
+  CPPUNIT_ASSERT(!limiter.allow(suppressed));
+  LogRateLimiter another;
+  CPPUNIT_ASSERT(!another.allow(suppressed));
+  LogRateLimiter::setInterval(oldInterval);
+}
+
+/// test allocation policies for the cubes
+void TableDataAccessTest::arrayAllocatorTest()
+{
+  CPPUNIT_ASSERT(!ArrayAllocator::create("heap"));
+  CPPUNIT_ASSERT_EQUAL(std::string("hugepages"), ArrayAllocator::create("hugepages")->name());
+  const boost::shared_ptr<ArrayAllocator const> numa = ArrayAllocator::create("numa");
+  CPPUNIT_ASSERT_EQUAL(std::string("numa"), numa->name());
+  CPPUNIT_ASSERT_EQUAL(std::string("pinned"), ArrayAllocator::create("pinned")->name());
+  CPPUNIT_ASSERT_THROW(ArrayAllocator::create("unknown"), askap::AskapError);
+
+  // locking may fail due to the limit on locked memory, but it is attempted for large blocks only
+  const boost::shared_ptr<PinnedArrayAllocator const> pinned(new PinnedArrayAllocator(1024 * 1024));
+  casacore::Vector<casacore::Complex> small = pinned->allocate<casacore::Complex>(16);
+  CPPUNIT_ASSERT_EQUAL(size_t(0), pinned->nLocked() + pinned->nFailed());
+  casacore::Vector<casacore::Complex> large = pinned->allocate<casacore::Complex>(1024 * 1024);
+  CPPUNIT_ASSERT_EQUAL(size_t(1), pinned->nLocked() + pinned->nFailed());
+  large.set(casacore::Complex(1., -1.));
+  CPPUNIT_ASSERT(casacore::allEQ(large, casacore::Complex(1., -1.)));
+
+  // buffer pool with page-locked slabs
+  PooledBufferManager pool(1024 * 1024, 0, pinned);
+  CPPUNIT_ASSERT(pool.allocator() == pinned);
+  casacore::Cube<casacore::Complex> buf(10, 16, 4, casacore::Complex(2., 0.5));
+  pool.writeBuffer(buf, "TEST", 0);
+  CPPUNIT_ASSERT_EQUAL(size_t(2), pinned->nLocked() + pinned->nFailed());
+  casacore::Cube<casacore::Complex> bufRead;
+  pool.readBuffer(bufRead, "TEST", 0);
+  CPPUNIT_ASSERT(casacore::allEQ(bufRead, buf));
+
+  // resize keeps the storage if the shape matches
+  casacore::Cube<casacore::Complex> cube;
+  numa->resize(cube, casacore::IPosition(3, 100, 64, 4));
+  CPPUNIT_ASSERT(cube.shape().isEqual(casacore::IPosition(3, 100, 64, 4)));
+  const casacore::Complex *storage = cube.data();
+  numa->resize(cube, casacore::IPosition(3, 100, 64, 4));
+  CPPUNIT_ASSERT(cube.data() == storage);
+  numa->resize(cube, casacore::IPosition(3, 0, 64, 4));
+  CPPUNIT_ASSERT_EQUAL(size_t(0), size_t(cube.nelements()));
+
+  // the data don't depend on the policy
+  TableConstDataSource ds(TableTestRunner::msName());
+  std::vector<casacore::Cube<casacore::Complex> > expected;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+       expected.push_back(casacore::Cube<casacore::Complex>(it->visibility().copy()));
+  }
+  const boost::shared_ptr<ArrayAllocator const> hugePages(new HugePageArrayAllocator(0));
+  ds.configureArrayAllocator(hugePages);
+  CPPUNIT_ASSERT(ds.arrayAllocator() == hugePages);
+  ds.configureReadAhead(true);
+  size_t count = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++count) {
+       CPPUNIT_ASSERT(count < expected.size());
+       const casacore::Cube<casacore::Complex> &vis = it->visibility();
+       CPPUNIT_ASSERT(vis.shape().isEqual(expected[count].shape()));
+       CPPUNIT_ASSERT(casacore::allEQ(vis, expected[count]));
+  }
+  CPPUNIT_ASSERT_EQUAL(expected.size(), count);
+  ds.configureReadAhead(false);
+  ds.configureArrayAllocator(boost::shared_ptr<ArrayAllocator const>());
+}
+
+/// @brief helper method to record uploaded slots
+/// @param[in] slot slot to upload
+/// @param[in] index index of the slot
+/// @param[in] sums vector to append the sum of visibilities to
+/// @param[in] maxIndex largest slot index encountered so far
+void TableDataAccessTest::recordUpload(const DeviceUploadStage::Slot &slot, size_t index,
+                         std::vector<casacore::Complex> *sums, size_t *maxIndex)
+{
+  CPPUNIT_ASSERT(sums != NULL);
+  CPPUNIT_ASSERT(maxIndex != NULL);
+  CPPUNIT_ASSERT(slot.itsFlag.shape().isEqual(slot.itsVisibility.shape()));
+  CPPUNIT_ASSERT_EQUAL(slot.itsVisibility.nrow(), slot.itsUVW.nelements());
+  sums->push_back(casacore::sum(slot.itsVisibility));
+  *maxIndex = std::max(*maxIndex, index);
+}
+
+/// test double-buffered upload of the accessors through page-locked slots
+void TableDataAccessTest::deviceUploadTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  std::vector<casacore::Complex> expected;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+       expected.push_back(casacore::sum(it->visibility()));
+  }
+  CPPUNIT_ASSERT(expected.size() > 2);
+  ds.configureArrayAllocator(ArrayAllocator::create("pinned"));
+  std::vector<casacore::Complex> uploaded;
+  size_t maxIndex = 0;
+  {
+    DeviceUploadStage stage(boost::bind(&TableDataAccessTest::recordUpload, _1, _2, &uploaded, &maxIndex));
+    CPPUNIT_ASSERT_EQUAL(size_t(2), stage.nSlots());
+    for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+         CPPUNIT_ASSERT(stage.submit(*it) < stage.nSlots());
+    }
+    stage.flush();
+    CPPUNIT_ASSERT_EQUAL(expected.size(), stage.nUploaded());
+  }
+  ds.configureArrayAllocator(boost::shared_ptr<ArrayAllocator const>());
+  CPPUNIT_ASSERT_EQUAL(size_t(1), maxIndex);
+  CPPUNIT_ASSERT_EQUAL(expected.size(), uploaded.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+       CPPUNIT_ASSERT(abs(expected[i] - uploaded[i]) < 1e-5 * std::max(1.f, abs(expected[i])));
+  }
+}
+
+/// test placement of the read-ahead threads
+void TableDataAccessTest::threadAffinityTest()
+{
+  CPPUNIT_ASSERT_EQUAL(ThreadAffinity::NONE, ThreadAffinity().policy());
+  CPPUNIT_ASSERT(!ThreadAffinity().allocator());
+  CPPUNIT_ASSERT(!ThreadAffinity().apply("test"));
+  CPPUNIT_ASSERT_EQUAL(std::string("none"), ThreadAffinity::create("none").name());
+  CPPUNIT_ASSERT_EQUAL(std::string("node:1"), ThreadAffinity::create("node:1").name());
+  CPPUNIT_ASSERT_EQUAL(1, ThreadAffinity::create("node:1").node());
+  CPPUNIT_ASSERT_THROW(ThreadAffinity::create("node:x"), askap::AskapError);
+  CPPUNIT_ASSERT_THROW(ThreadAffinity::create("socket"), askap::AskapError);
+  const ThreadAffinity consumer = ThreadAffinity::create("consumer");
+  CPPUNIT_ASSERT_EQUAL(ThreadAffinity::CONSUMER, consumer.policy());
+  CPPUNIT_ASSERT(consumer.node() < 0);
+  const ThreadAffinity resolved = consumer.resolve();
+  CPPUNIT_ASSERT_EQUAL(ThreadAffinity::currentNode(), resolved.node());
+  CPPUNIT_ASSERT_EQUAL(std::string("numa"), resolved.allocator()->name());
+
+  // the data don't depend on the placement
+  TableConstDataSource ds(TableTestRunner::msName());
+  std::vector<casacore::Cube<casacore::Complex> > expected;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+       expected.push_back(casacore::Cube<casacore::Complex>(it->visibility().copy()));
+  }
+  ThreadAffinity::resetPlacements();
+  ds.configureThreadAffinity(consumer);
+  CPPUNIT_ASSERT_EQUAL(ThreadAffinity::CONSUMER, ds.threadAffinity().policy());
+  ds.configureReadAhead(true);
+  size_t count = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++count) {
+       CPPUNIT_ASSERT(count < expected.size());
+       CPPUNIT_ASSERT(casacore::allEQ(it->visibility(), expected[count]));
+  }
+  CPPUNIT_ASSERT_EQUAL(expected.size(), count);
+  if (count > 1) {
+      // every read-ahead thread has attempted to pin itself
+      const std::map<std::string, ThreadAffinity::Placement> placements = ThreadAffinity::placements();
+      const std::map<std::string, ThreadAffinity::Placement>::const_iterator ci = placements.find("read-ahead");
+      CPPUNIT_ASSERT(ci != placements.end());
+      CPPUNIT_ASSERT(ci->second.itsPinned + ci->second.itsFailed > 0);
+      if (ci->second.itsPinned > 0) {
+          CPPUNIT_ASSERT_EQUAL(resolved.node(), ci->second.itsNode);
+          CPPUNIT_ASSERT(ci->second.itsCPUs.size() > 0);
+      }
+  }
+  ds.configureReadAhead(false);
+  ds.configureThreadAffinity(ThreadAffinity());
+  ThreadAffinity::resetPlacements();
+}
+
+/// test asynchronous iteration through the I/O pool
+void TableDataAccessTest::asyncAccessTest()
+{
+  IOThreadPool pool(2);
+  CPPUNIT_ASSERT_EQUAL(size_t(2), pool.nThreads());
+  CPPUNIT_ASSERT_THROW(IOThreadPool(0), askap::AskapError);
+
+  TableConstDataSource ds(TableTestRunner::msName());
+  std::vector<casacore::Cube<casacore::Complex> > expected;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+       expected.push_back(casacore::Cube<casacore::Complex>(it->visibility().copy()));
+  }
+  CPPUNIT_ASSERT(expected.size() > 0);
+
+  // two iterators over the same table are advanced alternately, the table is not
+  // thread-safe, so both go through the same strand
+  IOThreadPool::Strand strand(pool);
+  const boost::shared_ptr<IConstDataIterator> it1 = ds.createConstIterator(ds.createSelector(), ds.createConverter());
+  const boost::shared_ptr<IConstDataIterator> it2 = ds.createConstIterator(ds.createSelector(), ds.createConverter());
+  std::future<bool> more1 = fetchAsync(it1, strand);
+  std::future<bool> more2 = fetchAsync(it2, strand, IDataSelector::VISIBILITY);
+  size_t count = 0;
+  while (more1.get()) {
+         CPPUNIT_ASSERT(more2.get());
+         CPPUNIT_ASSERT(count < expected.size());
+         CPPUNIT_ASSERT(casacore::allEQ((*it1)->visibility(), expected[count]));
+         CPPUNIT_ASSERT(casacore::allEQ((*it2)->visibility(), expected[count]));
+         more1 = nextAsync(it1, strand);
+         more2 = nextAsync(it2, strand, IDataSelector::VISIBILITY);
+         ++count;
+  }
+  CPPUNIT_ASSERT(!more2.get());
+  CPPUNIT_ASSERT_EQUAL(expected.size(), count);
+  CPPUNIT_ASSERT(pool.tasksCompleted() >= 2 * count);
+  CPPUNIT_ASSERT_THROW(nextAsync(boost::shared_ptr<IConstDataIterator>(), strand), askap::AskapError);
+}
+
+void TableDataAccessTest::channelAveragingTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr refSel = ds.createSelector();
+  refSel->chooseChannels(12, 1);
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->chooseChannels(4, 1, 3);
+  IConstDataSharedIter refIt = ds.createConstIterator(refSel);
+  for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it, ++refIt) {
+       CPPUNIT_ASSERT(refIt != refIt.end());
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(4), it->nChannel());
+       checkChannelAverage(*it, *refIt, 3);
+  }
+  CPPUNIT_ASSERT(refIt == refIt.end());
+
+  // coarser frequency increment is the same as averaging, the start frequency is the
+  // centre of the first output channel
+  const casacore::Vector<casacore::Double> freqs = ds.createConstIterator()->frequency().copy();
+  CPPUNIT_ASSERT(freqs.nelements() > 8);
+  IDataSelectorPtr freqSel = ds.createSelector();
+  freqSel->chooseFrequencies(2, casacore::MFrequency(casacore::MVFrequency(freqs(4))),
+                             casacore::MVFrequency(3. * (freqs(1) - freqs(0))));
+  refSel = ds.createSelector();
+  refSel->chooseChannels(6, 3);
+  refIt = ds.createConstIterator(refSel);
+  for (IConstDataSharedIter it = ds.createConstIterator(freqSel); it != it.end(); ++it, ++refIt) {
+       CPPUNIT_ASSERT(refIt != refIt.end());
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), it->nChannel());
+       checkChannelAverage(*it, *refIt, 3);
+  }
+
+  // the increment has to be a multiple of the channel width
+  freqSel->chooseFrequencies(2, casacore::MFrequency(casacore::MVFrequency(freqs(4))),
+                             casacore::MVFrequency(1.5 * (freqs(1) - freqs(0))));
+  CPPUNIT_ASSERT_THROW(ds.createConstIterator(freqSel)->nChannel(), askap::AskapError);
+}
+
+/// @brief helper method to compare averaged accessor with the average of the full resolution one
+/// @param[in] acc accessor with averaged channels
+/// @param[in] ref accessor with the full resolution
+/// @param[in] nAvg number of channels averaged
+void TableDataAccessTest::checkChannelAverage(const IConstDataAccessor &acc, const IConstDataAccessor &ref,
+                                              casacore::uInt nAvg)
+{
+  CPPUNIT_ASSERT_EQUAL(ref.nRow(), acc.nRow());
+  CPPUNIT_ASSERT_EQUAL(ref.nChannel(), acc.nChannel() * nAvg);
+  CPPUNIT_ASSERT_EQUAL(ref.nPol(), acc.nPol());
+  const casacore::Cube<casacore::Complex> &vis = acc.visibility();
+  const casacore::Cube<casacore::Bool> &flag = acc.flag();
+  const casacore::Cube<casacore::Complex> &noise = acc.noise();
+  const casacore::Cube<casacore::Complex> &refVis = ref.visibility();
+  const casacore::Cube<casacore::Bool> &refFlag = ref.flag();
+  const casacore::Cube<casacore::Complex> &refNoise = ref.noise();
+  CPPUNIT_ASSERT_EQUAL(acc.nChannel(), casacore::uInt(acc.frequency().nelements()));
+  for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+       double freq = 0.;
+       for (casacore::uInt k = 0; k < nAvg; ++k) {
+            freq += ref.frequency()[chan * nAvg + k] / nAvg;
+       }
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(freq, acc.frequency()[chan], 1e-3);
+       for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+            for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+                 // noise is the same for real and imaginary parts in the test dataset,
+                 // without SIGMA_SPECTRUM all weights of the group are the same
+                 bool allFlagged = true;
+                 double weight = 0., allWeight = 0.;
+                 casacore::DComplex sum(0., 0.), allSum(0., 0.);
+                 for (casacore::uInt k = 0; k < nAvg; ++k) {
+                      const casacore::uInt inChan = chan * nAvg + k;
+                      const double sigma = casacore::real(refNoise(row, inChan, pol));
+                      const double w = sigma > 0. ? 1. / (sigma * sigma) : 0.;
+                      const casacore::DComplex value(refVis(row, inChan, pol));
+                      allSum += w * value;
+                      allWeight += w;
+                      if (!refFlag(row, inChan, pol)) {
+                          allFlagged = false;
+                          sum += w * value;
+                          weight += w;
+                      }
+                 }
+                 CPPUNIT_ASSERT_EQUAL(allFlagged, bool(flag(row, chan, pol)));
+                 const casacore::DComplex expected = weight > 0. ? sum / weight :
+                                      (allWeight > 0. ? allSum / allWeight : casacore::DComplex(0., 0.));
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(casacore::DComplex(vis(row, chan, pol)) - expected),
+                                              1e-5 * (1. + abs(expected)));
+                 if (weight > 0.) {
+                     CPPUNIT_ASSERT_DOUBLES_EQUAL(1. / sqrt(weight), casacore::real(noise(row, chan, pol)),
+                                                  1e-5 / sqrt(weight));
+                 }
+            }
+       }
+  }
+}
+
+/// @brief helper method to compare row numbers
+/// @param[in] rows sorted row numbers obtained from the index
+/// @param[in] selection table obtained via the table selection
+void TableDataAccessTest::checkRows(const std::vector<casacore::rownr_t> &rows,
+                                    const casacore::Table &selection)
+{
+  const casacore::Vector<casacore::rownr_t> expected = selection.rowNumbers();
+  CPPUNIT_ASSERT_EQUAL(size_t(expected.nelements()), rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+       CPPUNIT_ASSERT_EQUAL(expected[i], rows[i]);
+  }
+}
+
+/// test run-length decomposition of DATA_DESC_ID-like columns
+void TableDataAccessTest::columnRunsTest()
+{
+  ColumnRuns runs;
+  CPPUNIT_ASSERT(runs.empty());
+  // interleaved spectral windows, with the changes in different blocks of values
+  casacore::Vector<casacore::Int> ids(200, 0);
+  for (casacore::uInt row = 3; row < 70; ++row) {
+       ids[row] = 1;
+  }
+  ids[150] = 2;
+  runs.assign(ids);
+  CPPUNIT_ASSERT_EQUAL(size_t(5), runs.nRuns());
+  CPPUNIT_ASSERT_EQUAL(casacore::rownr_t(200), runs.nRows());
+  const casacore::Int values[] = {0, 1, 0, 2, 0};
+  const casacore::rownr_t ends[] = {3, 70, 150, 151, 200};
+  // sequential access as done by the iterator
+  for (casacore::rownr_t row = 0, run = 0; row < ids.nelements(); ++row) {
+       if (row == ends[run]) {
+           ++run;
+       }
+       const ColumnRuns::Run result = runs.run(row);
+       CPPUNIT_ASSERT_EQUAL(values[run], result.first);
+       CPPUNIT_ASSERT_EQUAL(ends[run], result.second);
+  }
+  // random access
+  CPPUNIT_ASSERT_EQUAL(ends[1], runs.run(5).second);
+  CPPUNIT_ASSERT_EQUAL(ends[4], runs.run(199).second);
+  CPPUNIT_ASSERT_EQUAL(ends[0], runs.run(0).second);
+  CPPUNIT_ASSERT_EQUAL(casacore::Int(2), runs.run(150).first);
+  runs.assign(casacore::Vector<casacore::Int>(10, 4));
+  CPPUNIT_ASSERT_EQUAL(size_t(1), runs.nRuns());
+  CPPUNIT_ASSERT_EQUAL(casacore::rownr_t(10), runs.run(7).second);
+  runs.clear();
+  CPPUNIT_ASSERT(runs.empty());
+}
+
+/// test compact noise representation
+void TableDataAccessTest::compactNoiseTest()
+{
+  // first test the class itself
+  casacore::Matrix<casacore::Float> sigma(3, 2);
+  for (casacore::uInt row = 0; row < sigma.nrow(); ++row) {
+       sigma(row, 0) = 1. + row;
+       sigma(row, 1) = 10. + row;
+  }
+  CompactNoise compact;
+  compact.assign(sigma, 4);
+  CPPUNIT_ASSERT(!compact.isFull());
+  CPPUNIT_ASSERT(!compact.hasSpectrum());
+  casacore::Vector<casacore::Float> spectrum(4);
+  for (casacore::uInt chan = 0; chan < spectrum.nelements(); ++chan) {
+       spectrum[chan] = 0.5 * (chan + 1);
+  }
+  compact.setSpectrum(spectrum);
+  CPPUNIT_ASSERT(compact.hasSpectrum());
+  casacore::Cube<casacore::Complex> expanded;
+  compact.expand(expanded);
+  CPPUNIT_ASSERT(expanded.shape() == casacore::IPosition(3, 3, 4, 2));
+  for (casacore::uInt row = 0; row < expanded.nrow(); ++row) {
+       for (casacore::uInt chan = 0; chan < expanded.ncolumn(); ++chan) {
+            for (casacore::uInt pol = 0; pol < expanded.nplane(); ++pol) {
+                 const casacore::Float val = sigma(row, pol) * spectrum[chan];
+                 CPPUNIT_ASSERT(abs(expanded(row, chan, pol) - casacore::Complex(val, val)) < 1e-6);
+                 CPPUNIT_ASSERT(abs(compact(row, chan, pol) - expanded(row, chan, pol)) < 1e-6);
+            }
+       }
+  }
+  compact.assign(expanded);
+  CPPUNIT_ASSERT(compact.isFull());
+  CPPUNIT_ASSERT(abs(compact(2, 3, 1) - expanded(2, 3, 1)) < 1e-6);
+  CPPUNIT_ASSERT_THROW(compact.sigma(), askap::AskapError);
+
+  // now the accessor, compact noise should match the cube
+  TableConstDataSource ds(TableTestRunner::msName());
+  int maxiter = 3;
+  for (IConstDataSharedIter it=ds.createConstIterator();it!=it.end() && maxiter>0;++it,--maxiter) {
+       const TableConstDataAccessor *acc = dynamic_cast<const TableConstDataAccessor*>(&(*it));
+       CPPUNIT_ASSERT(acc != NULL);
+       const CompactNoise &accNoise = acc->compactNoise();
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), accNoise.nRow());
+       CPPUNIT_ASSERT_EQUAL(it->nChannel(), accNoise.nChannel());
+       CPPUNIT_ASSERT_EQUAL(it->nPol(), accNoise.nPol());
+       const casacore::Cube<casacore::Complex> &noise = it->noise();
+       for (casacore::uInt row = 0; row < noise.nrow(); ++row) {
+            for (casacore::uInt chan = 0; chan < noise.ncolumn(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < noise.nplane(); ++pol) {
+                      CPPUNIT_ASSERT(abs(noise(row, chan, pol) - accNoise(row, chan, pol)) < 1e-6);
+                 }
+            }
+       }
+  }
+}
+
+/// test asynchronous write of original visibilities
+void TableDataAccessTest::writeBehindTest()
+{
+  TableDataSource tds(TableTestRunner::msName(), TableDataSource::WRITE_PERMITTED);
+  tds.configureWriteBehind(true);
+  IDataSource &ds=tds; // to have all interface methods available without
+                       // ambiguity (otherwise methods overridden in
+                       // TableDataSource would get a priority)
+  std::vector<casacore::Cube<casacore::Complex> > memoryBuffer;
+  const boost::shared_ptr<TableDataIterator> it =
+        boost::dynamic_pointer_cast<TableDataIterator>(ds.createIterator());
+  CPPUNIT_ASSERT(it);
+  CPPUNIT_ASSERT(it->writeBehindEnabled());
+  for (it->init(); it->hasMore(); it->next()) {
+       // save original values in memory
+       memoryBuffer.push_back((**it).visibility().copy());
+       // set visibilities to a different constant for every iteration
+       (**it).rwVisibility().set(casacore::Complex(1.,0.5 * memoryBuffer.size()));
+  }
+  // barrier, all data are on disk after this call
+  it->sync();
+
+  casacore::uInt iterCntr = 0;
+  for (IConstDataSharedIter cit = ds.createConstIterator();
+                                  cit != cit.end(); ++cit,++iterCntr) {
+       CPPUNIT_ASSERT(iterCntr < memoryBuffer.size());
+       const casacore::Cube<casacore::Complex> &vis = cit->visibility();
+       const casacore::Complex expected(1., 0.5 * (iterCntr + 1));
+       for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+            for (casacore::uInt column = 0; column < vis.ncolumn(); ++column) {
+                 for (casacore::uInt plane = 0; plane < vis.nplane(); ++plane) {
+                      CPPUNIT_ASSERT(abs(vis(row,column,plane) - expected)<1e-7);
+                 }
+            }
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(memoryBuffer.size(), size_t(iterCntr));
+
+  // set visibilities back to the original values, the last write is flushed by init()
+  iterCntr = 0;
+  for (it->init(); it->hasMore(); it->next(),++iterCntr) {
+       (**it).rwVisibility() = memoryBuffer[iterCntr];
+  }
+  it->init();
+
+  iterCntr = 0;
+  for (IConstDataSharedIter cit = ds.createConstIterator();
+                                  cit != cit.end(); ++cit,++iterCntr) {
+       const casacore::Cube<casacore::Complex> &vis = cit->visibility();
+       for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+            for (casacore::uInt column = 0; column < vis.ncolumn(); ++column) {
+                 for (casacore::uInt plane = 0; plane < vis.nplane(); ++plane) {
+                      CPPUNIT_ASSERT(abs(vis(row,column,plane)-
+                             memoryBuffer[iterCntr](row,column,plane))<1e-7);
+                 }
+            }
+       }
+  }
+}
+
+/// test write back of flags for changed rows only
+void TableDataAccessTest::flagRowUpdateTest()
+{
+  // runs of rows are merged
+  RowRangeSet rows;
+  rows.add(5, 2);
+  rows.add(1, 2);
+  rows.add(3, 2);
+  CPPUNIT_ASSERT_EQUAL(size_t(1), rows.ranges().size());
+  CPPUNIT_ASSERT_EQUAL(6u, rows.nRows());
+  rows.remove(2, 1);
+  CPPUNIT_ASSERT_EQUAL(size_t(2), rows.ranges().size());
+  CPPUNIT_ASSERT(rows.contains(1) && !rows.contains(2) && rows.contains(6) && !rows.contains(7));
+
+  // flagging modifies FLAG_ROW, keep the original columns to restore them at the end
+  casacore::Table ms(TableTestRunner::msName(), casacore::Table::Update);
+  casacore::ArrayColumn<casacore::Bool> flagCol(ms, "FLAG");
+  casacore::ScalarColumn<casacore::Bool> flagRowCol(ms, "FLAG_ROW");
+  const casacore::Array<casacore::Bool> origFlag = flagCol.getColumn();
+  const casacore::Vector<casacore::Bool> origFlagRow = flagRowCol.getColumn();
+
+  std::vector<casacore::Cube<casacore::Bool> > memoryBuffer;
+  {
+    TableDataSource tds(TableTestRunner::msName(), TableDataSource::WRITE_PERMITTED);
+    IDataSource &ds=tds;
+    casacore::uInt iterCntr = 0;
+    for (IDataSharedIter it=ds.createIterator(); it!=it.end(); ++it,++iterCntr) {
+         memoryBuffer.push_back(it->flag().copy());
+         IFlagDataAccessor& acc = dynamic_cast<IFlagDataAccessor&>(*it);
+         if (iterCntr % 2 == 0) {
+             CPPUNIT_ASSERT(it->nRow() > 5);
+             // rows 1 and 2 are changed, row 5 is flagged entirely
+             acc.updateFlags(1, casacore::Cube<casacore::Bool>(2, it->nChannel(), it->nPol(), casacore::True));
+             acc.flagRows(5, 1);
+             CPPUNIT_ASSERT(casacore::allEQ(acc.flag().yzPlane(5), casacore::True));
+         }
+    }
+  }
+
+  TableConstDataSource ds(TableTestRunner::msName());
+  casacore::uInt iterCntr = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it,++iterCntr) {
+       CPPUNIT_ASSERT(iterCntr < memoryBuffer.size());
+       const casacore::Cube<casacore::Bool> &flag = it->flag();
+       CPPUNIT_ASSERT(flag.shape() == memoryBuffer[iterCntr].shape());
+       for (casacore::uInt row = 0; row < flag.nrow(); ++row) {
+            const bool changed = (iterCntr % 2 == 0) && ((row == 1) || (row == 2) || (row == 5));
+            for (casacore::uInt chan = 0; chan < flag.ncolumn(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < flag.nplane(); ++pol) {
+                      CPPUNIT_ASSERT_EQUAL(changed ? casacore::True : memoryBuffer[iterCntr](row,chan,pol),
+                                           flag(row,chan,pol));
+                 }
+            }
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(memoryBuffer.size(), size_t(iterCntr));
+
+  flagCol.putColumn(origFlag);
+  flagRowCol.putColumn(origFlagRow);
+}
+
+/// test writing of a new measurement set from a stream of accessors
+void TableDataAccessTest::streamingWriterTest()
+{
+  const std::string name = "tmp.streamingwriter.ms";
+  const casacore::uInt maxChunks = 10;
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  // the channel selection requires the spectral window to be updated in the new dataset
+  sel->chooseChannels(2, 3);
+  {
+    StreamingMSWriter writer(name, TableTestRunner::msName());
+    casacore::uInt nRows = 0;
+    casacore::uInt count = 0;
+    for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end() && count < maxChunks;
+         ++it, ++count) {
+         writer.write(*it);
+         nRows += it->nRow();
+    }
+    CPPUNIT_ASSERT_EQUAL(maxChunks, writer.chunksWritten());
+    CPPUNIT_ASSERT_EQUAL(casacore::rownr_t(nRows), writer.nRowsWritten());
+  }
+
+  TableConstDataSource newDS(name);
+  IConstDataSharedIter it = ds.createConstIterator(sel);
+  casacore::uInt count = 0;
+  for (IConstDataSharedIter newIt = newDS.createConstIterator(); newIt != newIt.end(); ++newIt, ++it, ++count) {
+       CPPUNIT_ASSERT(count < maxChunks);
+       CPPUNIT_ASSERT(it != it.end());
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), newIt->nRow());
+       CPPUNIT_ASSERT_EQUAL(2u, newIt->nChannel());
+       CPPUNIT_ASSERT_EQUAL(it->nPol(), newIt->nPol());
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(it->time(), newIt->time(), 1e-6);
+       for (casacore::uInt chan = 0; chan < newIt->nChannel(); ++chan) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(it->frequency()[chan], newIt->frequency()[chan], 1.);
+       }
+       for (casacore::uInt row = 0; row < newIt->nRow(); ++row) {
+            CPPUNIT_ASSERT_EQUAL(it->antenna1()[row], newIt->antenna1()[row]);
+            CPPUNIT_ASSERT_EQUAL(it->antenna2()[row], newIt->antenna2()[row]);
+            for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(it->uvw()[row](dim), newIt->uvw()[row](dim), 1e-10);
+            }
+            for (casacore::uInt chan = 0; chan < newIt->nChannel(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < newIt->nPol(); ++pol) {
+                      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., casacore::abs(it->visibility()(row,chan,pol) -
+                                                   newIt->visibility()(row,chan,pol)), 1e-6);
+                      CPPUNIT_ASSERT_EQUAL(it->flag()(row,chan,pol), newIt->flag()(row,chan,pol));
+                 }
+            }
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(maxChunks, count);
+  casacore::Table(name, casacore::Table::Update).markForDelete();
+}
+
+/// test row-range views of an accessor
+void TableDataAccessTest::rowSliceTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  ds.configureMaxChunkSize(23);
+  const casacore::uInt nParts = 4;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+       const IConstDataAccessor &acc = *it;
+       fetchFields(acc, IDataSelector::VISIBILITY | IDataSelector::FLAG | IDataSelector::UVW |
+                   IDataSelector::ANTENNA | IDataSelector::FEED);
+       const std::vector<RowSliceAccessor> slices = RowSliceAccessor::split(acc, nParts);
+       CPPUNIT_ASSERT_EQUAL(size_t(nParts), slices.size());
+       casacore::uInt row = 0;
+       for (size_t part = 0; part < slices.size(); ++part) {
+            const RowSliceAccessor &slice = slices[part];
+            CPPUNIT_ASSERT_EQUAL(row, slice.begin());
+            CPPUNIT_ASSERT_EQUAL(acc.nChannel(), slice.nChannel());
+            CPPUNIT_ASSERT_EQUAL(acc.nPol(), slice.nPol());
+            CPPUNIT_ASSERT_EQUAL(acc.time(), slice.time());
+            CPPUNIT_ASSERT_EQUAL(slice.nRow(), slice.visibility().nrow());
+            CPPUNIT_ASSERT_EQUAL(acc.nChannel(), slice.visibility().ncolumn());
+            if (slice.nRow() > 0) {
+                // the view references the parent's data
+                CPPUNIT_ASSERT(&slice.visibility()(0, 0, 0) == &acc.visibility()(row, 0, 0));
+            }
+            for (casacore::uInt i = 0; i < slice.nRow(); ++i, ++row) {
+                 CPPUNIT_ASSERT_EQUAL(acc.antenna1()[row], slice.antenna1()[i]);
+                 CPPUNIT_ASSERT_EQUAL(acc.antenna2()[row], slice.antenna2()[i]);
+                 CPPUNIT_ASSERT_EQUAL(acc.feed1()[row], slice.feed1()[i]);
+                 CPPUNIT_ASSERT_EQUAL(acc.feed2()[row], slice.feed2()[i]);
+                 for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                      CPPUNIT_ASSERT_EQUAL(acc.uvw()[row](dim), slice.uvw()[i](dim));
+                 }
+                 for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+                      for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+                           CPPUNIT_ASSERT_EQUAL(acc.flag()(row, chan, pol), slice.flag()(i, chan, pol));
+                      }
+                 }
+            }
+            CPPUNIT_ASSERT_EQUAL(row, slice.end());
+       }
+       CPPUNIT_ASSERT_EQUAL(acc.nRow(), row);
+       // rowSlice gives the same view
+       if (acc.nRow() > 1) {
+           const RowSliceAccessor slice = acc.rowSlice(1, acc.nRow());
+           CPPUNIT_ASSERT_EQUAL(acc.nRow() - 1, slice.nRow());
+           CPPUNIT_ASSERT_EQUAL(acc.antenna2()[1], slice.antenna2()[0]);
+       }
+
+       // process the slices in parallel and compare with the serial sum
+       casacore::DComplex expected(0., 0.);
+       sumRowSlice(&acc, &expected);
+       std::vector<casacore::DComplex> sums(nParts, casacore::DComplex(0., 0.));
+       boost::thread_group threads;
+       for (size_t part = 0; part < slices.size(); ++part) {
+            threads.create_thread(boost::bind(&TableDataAccessTest::sumRowSlice, &slices[part], &sums[part]));
+       }
+       threads.join_all();
+       casacore::DComplex total(0., 0.);
+       for (size_t part = 0; part < sums.size(); ++part) {
+            total += sums[part];
+       }
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(0., abs(total - expected), 1e-6 * (1. + abs(expected)));
+  }
+  // slices beyond the parent rows are rejected
+  IConstDataSharedIter it = ds.createConstIterator();
+  CPPUNIT_ASSERT_THROW(it->rowSlice(0, it->nRow() + 1), askap::AskapError);
+  CPPUNIT_ASSERT_THROW(RowSliceAccessor::split(*it, 0), askap::AskapError);
+}
+
+/// @brief helper method to sum visibilities and uvw of a row slice in a separate thread
+/// @param[in] acc accessor to work with
+/// @param[out] result sum of unflagged visibilities plus the sum of u and v as a complex number
+void TableDataAccessTest::sumRowSlice(const IConstDataAccessor *acc, casacore::DComplex *result)
+{
+  ASKAPDEBUGASSERT(acc != NULL);
+  ASKAPDEBUGASSERT(result != NULL);
+  const casacore::Cube<casacore::Complex> &vis = acc->visibility();
+  const casacore::Cube<casacore::Bool> &flag = acc->flag();
+  const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = acc->uvw();
+  casacore::DComplex sum(0., 0.);
+  for (casacore::uInt row = 0; row < acc->nRow(); ++row) {
+       sum += casacore::DComplex(uvw[row](0), uvw[row](1));
+       for (casacore::uInt chan = 0; chan < acc->nChannel(); ++chan) {
+            for (casacore::uInt pol = 0; pol < acc->nPol(); ++pol) {
+                 if (!flag(row, chan, pol)) {
+                     sum += casacore::DComplex(vis(row, chan, pol));
+                 }
+            }
+       }
+  }
+  *result = sum;
+}
+
+/// test views with rows sorted into grid tiles
+void TableDataAccessTest::tileSortTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  const casacore::MDirection tangent(casacore::MVDirection(0.12345,-0.12345), casacore::MDirection::J2000);
+  const double uvTile = 50.;
+  const double wStep = 20.;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it) {
+       const IConstDataAccessor &acc = *it;
+       const TileSortedAccessor sorted(acc, tangent, uvTile, wStep);
+       CPPUNIT_ASSERT_EQUAL(acc.nRow(), sorted.nRow());
+       CPPUNIT_ASSERT_EQUAL(acc.nChannel(), sorted.nChannel());
+       CPPUNIT_ASSERT_EQUAL(acc.time(), sorted.time());
+       const casacore::Vector<casacore::uInt> &perm = sorted.permutation();
+       CPPUNIT_ASSERT_EQUAL(acc.nRow(), casacore::uInt(perm.nelements()));
+       CPPUNIT_ASSERT(sorted.nTiles() > 0);
+       CPPUNIT_ASSERT(sorted.nTiles() <= acc.nRow());
+       // every parent row appears exactly once
+       std::vector<bool> used(acc.nRow(), false);
+       for (casacore::uInt row = 0; row < perm.nelements(); ++row) {
+            CPPUNIT_ASSERT(perm[row] < acc.nRow());
+            CPPUNIT_ASSERT(!used[perm[row]]);
+            used[perm[row]] = true;
+       }
+       // rows are ordered by w-plane, u-tile and v-tile, rows within a tile keep the storage order
+       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &rotated = sorted.rotatedUVW(tangent);
+       const UVWBounds bounds = acc.rotatedUVWBounds(tangent);
+       casacore::uInt nTiles = 0;
+       for (casacore::uInt row = 0; row < sorted.nRow(); ++row) {
+            for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                 CPPUNIT_ASSERT_EQUAL(acc.rotatedUVW(tangent)[perm[row]](dim), rotated[row](dim));
+                 CPPUNIT_ASSERT_EQUAL(acc.uvw()[perm[row]](dim), sorted.uvw()[row](dim));
+            }
+            CPPUNIT_ASSERT_EQUAL(acc.antenna1()[perm[row]], sorted.antenna1()[row]);
+            CPPUNIT_ASSERT_EQUAL(acc.antenna2()[perm[row]], sorted.antenna2()[row]);
+            for (casacore::uInt chan = 0; chan < acc.nChannel(); ++chan) {
+                 for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+                      CPPUNIT_ASSERT_EQUAL(acc.visibility()(perm[row], chan, pol), sorted.visibility()(row, chan, pol));
+                      CPPUNIT_ASSERT_EQUAL(acc.flag()(perm[row], chan, pol), sorted.flag()(row, chan, pol));
+                 }
+            }
+            const int w = int(std::floor((rotated[row](2) - bounds.minW()) / wStep));
+            const int u = int(std::floor((rotated[row](0) - bounds.minU()) / uvTile));
+            const int v = int(std::floor((rotated[row](1) - bounds.minV()) / uvTile));
+            if (row == 0) {
+                ++nTiles;
+                continue;
+            }
+            const int prevW = int(std::floor((rotated[row - 1](2) - bounds.minW()) / wStep));
+            const int prevU = int(std::floor((rotated[row - 1](0) - bounds.minU()) / uvTile));
+            const int prevV = int(std::floor((rotated[row - 1](1) - bounds.minV()) / uvTile));
+            CPPUNIT_ASSERT(prevW <= w);
+            if (prevW == w) {
+                CPPUNIT_ASSERT(prevU <= u);
+                if (prevU == u) {
+                    CPPUNIT_ASSERT(prevV <= v);
+                    if (prevV == v) {
+                        CPPUNIT_ASSERT(perm[row - 1] < perm[row]);
+                        continue;
+                    }
+                }
+            }
+            ++nTiles;
+       }
+       CPPUNIT_ASSERT_EQUAL(nTiles, sorted.nTiles());
+
+       // with the best plane subtracted, the rows are sorted by the residual w-term
+       BestWPlaneDataAccessor planeAcc(1e5, false);
+       planeAcc.associate(acc);
+       const TileSortedAccessor planeSorted(planeAcc, tangent, uvTile, wStep);
+       const UVWBounds planeBounds = planeAcc.rotatedUVWBounds(tangent);
+       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &planeUVW = planeSorted.rotatedUVW(tangent);
+       for (casacore::uInt row = 1; row < planeSorted.nRow(); ++row) {
+            CPPUNIT_ASSERT(std::floor((planeUVW[row - 1](2) - planeBounds.minW()) / wStep) <=
+                           std::floor((planeUVW[row](2) - planeBounds.minW()) / wStep));
+       }
+  }
+  // an empty accessor or non-positive tile size
+  casacore::Vector<casacore::uInt> perm(5);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), TileSortedAccessor::sortRows(
+           casacore::Vector<casacore::RigidVector<casacore::Double, 3> >(), UVWBounds(), 1., 1., perm));
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(0), casacore::uInt(perm.nelements()));
+  CPPUNIT_ASSERT_THROW(TileSortedAccessor::sortRows(
+           casacore::Vector<casacore::RigidVector<casacore::Double, 3> >(), UVWBounds(), 0., 1., perm),
+           askap::AskapError);
+}
+
+/// test block-wise reading of the metadata columns
+void TableDataAccessTest::metaDataIteratorTest()
+{
+  const casacore::Table ms(TableTestRunner::msName());
+  const casacore::Vector<casacore::Double> time = casacore::ROScalarColumn<casacore::Double>(ms, "TIME").getColumn();
+  const casacore::Vector<casacore::Int> ant1 = casacore::ROScalarColumn<casacore::Int>(ms, "ANTENNA1").getColumn();
+  const casacore::Vector<casacore::Int> ant2 = casacore::ROScalarColumn<casacore::Int>(ms, "ANTENNA2").getColumn();
+  const casacore::Matrix<casacore::Double> uvw = casacore::ROArrayColumn<casacore::Double>(ms, "UVW").getColumn();
+  const casacore::Vector<casacore::Bool> flagRow =
+        casacore::ROScalarColumn<casacore::Bool>(ms, "FLAG_ROW").getColumn();
+  CPPUNIT_ASSERT(ms.nrow() > 100);
+  TableConstDataSource ds(TableTestRunner::msName());
+  const boost::shared_ptr<TableMetaDataIterator> it = ds.createMetaDataIterator(100);
+  CPPUNIT_ASSERT(it);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(100), it->blockSize());
+  for (int pass = 0; pass < 2; ++pass) {
+       size_t row = 0;
+       size_t nBlocks = 0;
+       for (it->init(); it->hasMore(); it->next(), ++nBlocks) {
+            CPPUNIT_ASSERT(it->nRow() <= it->blockSize());
+            CPPUNIT_ASSERT_EQUAL(casacore::rownr_t(row), it->firstRow());
+            CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->time().nelements()));
+            CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->uvw().nelements()));
+            for (casacore::uInt i = 0; i < it->nRow(); ++i, ++row) {
+                 CPPUNIT_ASSERT_EQUAL(time[row], it->time()[i]);
+                 CPPUNIT_ASSERT_EQUAL(casacore::uInt(ant1[row]), it->antenna1()[i]);
+                 CPPUNIT_ASSERT_EQUAL(casacore::uInt(ant2[row]), it->antenna2()[i]);
+                 CPPUNIT_ASSERT_EQUAL(flagRow[row], it->flagRow()[i]);
+                 for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                      CPPUNIT_ASSERT_EQUAL(uvw(dim, row), it->uvw()[i](dim));
+                 }
+            }
+       }
+       CPPUNIT_ASSERT_EQUAL(size_t(ms.nrow()), row);
+       CPPUNIT_ASSERT_EQUAL((row + 99) / 100, nBlocks);
+       CPPUNIT_ASSERT(!it->next());
+  }
+  // the whole table in one block
+  TableMetaDataIterator bigIt(ms, ms.nrow() + 1);
+  CPPUNIT_ASSERT(bigIt.hasMore());
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(ms.nrow()), bigIt.nRow());
+  CPPUNIT_ASSERT(!bigIt.next());
+}
+
+/// test summaries of time stamps collected during full passes
+void TableDataAccessTest::chunkSummaryTest()
+{
+  CPPUNIT_ASSERT_EQUAL(std::string("test.ms.chunksummary"), ChunkSummaryMap::defaultFileName("test.ms"));
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT(!ds.chunkSummaries());
+  ds.configureChunkSummaries(true, false);
+  CPPUNIT_ASSERT(ds.chunkSummaries());
+  CPPUNIT_ASSERT_EQUAL(size_t(0), ds.chunkSummaries()->size());
+  // small chunks, so time stamps are split between several of them
+  ds.configureMaxChunkSize(7);
+  IDataSelectorPtr sel = ds.createSelector();
+  boost::shared_ptr<TableConstDataIterator> it =
+       boost::dynamic_pointer_cast<TableConstDataIterator>(ds.createConstIterator(sel));
+  CPPUNIT_ASSERT(it);
+  std::map<double, ChunkSummary> expected;
+  ChunkSummary summary;
+  for (; it->hasMore(); it->next()) {
+       // nothing is known before the first pass
+       CPPUNIT_ASSERT(!it->currentChunkSummary(summary));
+       const casacore::Cube<casacore::Bool> &flag = (*it)->flag();
+       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = (*it)->uvw();
+       ChunkSummary &exp = expected[it->time()];
+       exp.itsNRow += (*it)->nRow();
+       exp.itsNSamples += flag.nelements();
+       exp.itsNFlagged += casacore::ntrue(flag);
+       for (casacore::uInt row = 0; row < (*it)->nRow(); ++row) {
+            const double uvDist = std::sqrt(uvw[row](0) * uvw[row](0) + uvw[row](1) * uvw[row](1));
+            exp.itsMinUVDistance = std::min(exp.itsMinUVDistance, uvDist);
+            exp.itsMaxUVDistance = std::max(exp.itsMaxUVDistance, uvDist);
+       }
+  }
+  CPPUNIT_ASSERT(expected.size() > 1);
+  CPPUNIT_ASSERT_EQUAL(expected.size(), ds.chunkSummaries()->size());
+
+  // summaries are available to iterators with any selection
+  sel->chooseCrossCorrelations();
+  sel->chooseChannels(3,2);
+  it = boost::dynamic_pointer_cast<TableConstDataIterator>(ds.createConstIterator(sel));
+  CPPUNIT_ASSERT(it);
+  size_t nChunks = 0;
+  for (; it->hasMore(); it->next(), ++nChunks) {
+       CPPUNIT_ASSERT(it->currentChunkSummary(summary));
+       const std::map<double, ChunkSummary>::const_iterator ci = expected.find(it->time());
+       CPPUNIT_ASSERT(ci != expected.end());
+       CPPUNIT_ASSERT_EQUAL(ci->second.itsNRow, summary.itsNRow);
+       CPPUNIT_ASSERT_EQUAL(ci->second.itsNSamples, summary.itsNSamples);
+       CPPUNIT_ASSERT_EQUAL(ci->second.itsNFlagged, summary.itsNFlagged);
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(ci->second.itsMinUVDistance, summary.itsMinUVDistance, 1e-6);
+       CPPUNIT_ASSERT_DOUBLES_EQUAL(ci->second.itsMaxUVDistance, summary.itsMaxUVDistance, 1e-6);
+       CPPUNIT_ASSERT(summary.itsMinW <= summary.itsMaxW);
+       CPPUNIT_ASSERT_EQUAL(summary.itsNFlagged == summary.itsNSamples, summary.allFlagged());
+       // reading a subset of the data doesn't change the summary
+       (*it)->flag();
+  }
+  CPPUNIT_ASSERT(nChunks > 0);
+  CPPUNIT_ASSERT_EQUAL(expected.size(), ds.chunkSummaries()->size());
+
+  // a pass with a restricted selection doesn't add anything
+  ds.chunkSummaries()->clear();
+  for (IConstDataSharedIter cit = ds.createConstIterator(sel); cit != cit.end(); ++cit) {
+       cit->flag();
+  }
+  CPPUNIT_ASSERT_EQUAL(size_t(0), ds.chunkSummaries()->size());
+  ds.configureChunkSummaries(false);
+  CPPUNIT_ASSERT(!ds.chunkSummaries());
+}
+
+/// @brief helper method to compare the bounding box with the uvw it has been computed for
+/// @param[in] bounds bounding box to check
+/// @param[in] uvw vector with uvw coordinates
+void TableDataAccessTest::checkBounds(const UVWBounds &bounds,
+                                      const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw)
+{
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(uvw.nelements()), bounds.nRow());
+  CPPUNIT_ASSERT(!bounds.empty());
+  double maxUVDist = 0.;
+  for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+       CPPUNIT_ASSERT(uvw[row](0) >= bounds.minU() && uvw[row](0) <= bounds.maxU());
+       CPPUNIT_ASSERT(uvw[row](1) >= bounds.minV() && uvw[row](1) <= bounds.maxV());
+       CPPUNIT_ASSERT(uvw[row](2) >= bounds.minW() && uvw[row](2) <= bounds.maxW());
+       CPPUNIT_ASSERT(std::abs(uvw[row](2)) <= bounds.maxAbsW());
+       maxUVDist = std::max(maxUVDist, std::sqrt(uvw[row](0) * uvw[row](0) + uvw[row](1) * uvw[row](1)));
+  }
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(maxUVDist, bounds.maxUVDistance(), 1e-6);
+  // the bounds are attained
+  const UVWBounds scanned(uvw);
+  CPPUNIT_ASSERT_EQUAL(scanned.minU(), bounds.minU());
+  CPPUNIT_ASSERT_EQUAL(scanned.maxV(), bounds.maxV());
+  CPPUNIT_ASSERT_EQUAL(scanned.minW(), bounds.minW());
+  CPPUNIT_ASSERT_EQUAL(scanned.maxW(), bounds.maxW());
+}
+
+/// test bounding boxes of uvw computed along with uvw
+void TableDataAccessTest::uvwBoundsTest()
+{
+  UVWBounds empty;
+  CPPUNIT_ASSERT(empty.empty());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0., empty.maxAbsW(), 1e-10);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0., empty.maxUVDistance(), 1e-10);
+  UVWBounds box;
+  box.add(3., -4., 1.);
+  box.add(-1., 2., -5.);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), box.nRow());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(-1., box.minU(), 1e-10);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2., box.maxV(), 1e-10);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(4., box.maxAbsV(), 1e-10);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(5., box.maxAbsW(), 1e-10);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(5., box.maxUVDistance(), 1e-10);
+  empty.add(box);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(2), empty.nRow());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(-5., empty.minW(), 1e-10);
+
+  TableConstDataSource ds(TableTestRunner::msName());
+  ds.configureUVWRotationCache(true);
+  const casacore::MDirection tangent(casacore::MVDirection(0.12345,-0.12345), casacore::MDirection::J2000);
+  for (int pass = 0; pass < 2; ++pass) {
+       // the second pass reads ahead and takes rotated uvw from the cache
+       ds.configureReadAhead(pass > 0);
+       size_t nChunks = 0;
+       for (IConstDataSharedIter it=ds.createConstIterator(); it!=it.end(); ++it, ++nChunks) {
+            // bounds requested before the uvw
+            const UVWBounds bounds = it->uvwBounds();
+            checkBounds(bounds, it->uvw());
+            const UVWBounds rotatedBounds = it->rotatedUVWBounds(tangent);
+            checkBounds(rotatedBounds, it->rotatedUVW(tangent));
+       }
+       CPPUNIT_ASSERT(nChunks > 1);
+  }
+  CPPUNIT_ASSERT(ds.uvwRotationCache()->hits() > 0);
+}
+
+/// test uvw computed from antenna positions
+void TableDataAccessTest::computedUVWTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT(!ds.computedUVW());
+  ds.configureComputedUVW(true);
+  CPPUNIT_ASSERT(ds.computedUVW());
+  const boost::shared_ptr<TableConstDataIterator> it =
+       boost::dynamic_pointer_cast<TableConstDataIterator>(ds.createConstIterator());
+  CPPUNIT_ASSERT(it);
+  CPPUNIT_ASSERT(it->computedUVW());
+  TableConstDataSource refDS(TableTestRunner::msName());
+  IConstDataSharedIter refIt = refDS.createConstIterator();
+  size_t nChunks = 0;
+  for (; it->hasMore(); it->next(), refIt.next(), ++nChunks) {
+       CPPUNIT_ASSERT(refIt.hasMore());
+       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvw = (*it)->uvw();
+       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &stored = refIt->uvw();
+       CPPUNIT_ASSERT_EQUAL(stored.nelements(), uvw.nelements());
+       checkBounds((*it)->uvwBounds(), uvw);
+       for (casacore::uInt row = 0; row < uvw.nelements(); ++row) {
+            // baseline length doesn't depend on the orientation of the uvw frame
+            const double length = std::sqrt(uvw[row](0) * uvw[row](0) + uvw[row](1) * uvw[row](1) +
+                                            uvw[row](2) * uvw[row](2));
+            const double storedLength = std::sqrt(stored[row](0) * stored[row](0) +
+                      stored[row](1) * stored[row](1) + stored[row](2) * stored[row](2));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(storedLength, length, 1e-3);
+            if ((*it)->antenna1()[row] == (*it)->antenna2()[row]) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(0., length, 1e-10);
+            }
+       }
+  }
+  CPPUNIT_ASSERT(nChunks > 1);
+  CPPUNIT_ASSERT(!refIt.hasMore());
+}
+
+/// test reading of a subset of polarisation products
+void TableDataAccessTest::polSelectionTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->choosePolarizations("YY");
+  IConstDataSharedIter cit = ds.createConstIterator(sel);
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++cit) {
+       CPPUNIT_ASSERT(cit != cit.end());
+       CPPUNIT_ASSERT_EQUAL(2u, it->nPol());
+       CPPUNIT_ASSERT_EQUAL(1u, cit->nPol());
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), cit->nRow());
+       CPPUNIT_ASSERT(cit->stokes().nelements() == 1);
+       CPPUNIT_ASSERT(cit->stokes()[0] == casacore::Stokes::YY);
+       const casacore::Cube<casacore::Complex> &vis = cit->visibility();
+       const casacore::Cube<casacore::Bool> &flag = cit->flag();
+       const casacore::Cube<casacore::Complex> &noise = cit->noise();
+       CPPUNIT_ASSERT(vis.shape() == casacore::IPosition(3, it->nRow(), it->nChannel(), 1));
+       CPPUNIT_ASSERT(flag.shape() == vis.shape());
+       CPPUNIT_ASSERT(noise.shape() == vis.shape());
+       for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+            for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+                 CPPUNIT_ASSERT(abs(vis(row, chan, 0) - it->visibility()(row, chan, 1)) < 1e-7);
+                 CPPUNIT_ASSERT(flag(row, chan, 0) == it->flag()(row, chan, 1));
+                 CPPUNIT_ASSERT(abs(noise(row, chan, 0) - it->noise()(row, chan, 1)) < 1e-7);
+            }
+       }
+  }
+  CPPUNIT_ASSERT(cit == cit.end());
+}
+
+/// test conversion of the stored correlations into the selected products
+void TableDataAccessTest::stokesConversionTest()
+{
+  // only XX and YY are stored
+  const scimath::PolConverter converter(scimath::PolConverter::fromString("XX,YY"),
+                                        scimath::PolConverter::fromString("I,Q"));
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  sel->choosePolarizations("I,Q");
+  IDataSelectorPtr swapSel = ds.createSelector();
+  swapSel->choosePolarizations("YY,XX");
+  IConstDataSharedIter cit = ds.createConstIterator(sel);
+  IConstDataSharedIter sit = ds.createConstIterator(swapSel);
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++cit, ++sit) {
+       CPPUNIT_ASSERT(cit != cit.end());
+       CPPUNIT_ASSERT(sit != sit.end());
+       CPPUNIT_ASSERT_EQUAL(2u, it->nPol());
+       CPPUNIT_ASSERT_EQUAL(2u, cit->nPol());
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), cit->nRow());
+       CPPUNIT_ASSERT(cit->stokes().nelements() == 2);
+       CPPUNIT_ASSERT(cit->stokes()[0] == casacore::Stokes::I);
+       CPPUNIT_ASSERT(cit->stokes()[1] == casacore::Stokes::Q);
+       CPPUNIT_ASSERT(sit->stokes()[0] == casacore::Stokes::YY);
+       const casacore::Cube<casacore::Complex> &vis = cit->visibility();
+       const casacore::Cube<casacore::Bool> &flag = cit->flag();
+       const casacore::Cube<casacore::Complex> &noise = cit->noise();
+       const casacore::Cube<casacore::Complex> &swappedVis = sit->visibility();
+       CPPUNIT_ASSERT(vis.shape() == it->visibility().shape());
+       CPPUNIT_ASSERT(flag.shape() == vis.shape());
+       CPPUNIT_ASSERT(noise.shape() == vis.shape());
+       CPPUNIT_ASSERT(swappedVis.shape() == vis.shape());
+       casacore::Vector<casacore::Complex> linear(2);
+       for (casacore::uInt row = 0; row < vis.nrow(); ++row) {
+            for (casacore::uInt chan = 0; chan < vis.ncolumn(); ++chan) {
+                 linear[0] = it->visibility()(row, chan, 0);
+                 linear[1] = it->visibility()(row, chan, 1);
+                 const casacore::Vector<casacore::Complex> expected = converter(linear);
+                 const casacore::Bool anyFlagged = it->flag()(row, chan, 0) || it->flag()(row, chan, 1);
+                 for (casacore::uInt pol = 0; pol < 2; ++pol) {
+                      CPPUNIT_ASSERT(abs(vis(row, chan, pol) - expected[pol]) < 1e-5);
+                      CPPUNIT_ASSERT_EQUAL(anyFlagged, flag(row, chan, pol));
+                      CPPUNIT_ASSERT(abs(swappedVis(row, chan, pol) - it->visibility()(row, chan, 1 - pol)) < 1e-7);
+                 }
+                 // I and Q combine both correlations with the same weight
+                 CPPUNIT_ASSERT(abs(noise(row, chan, 0) - noise(row, chan, 1)) < 1e-5);
+                 CPPUNIT_ASSERT(real(noise(row, chan, 0)) > 0.);
+            }
+       }
+  }
+  CPPUNIT_ASSERT(cit == cit.end());
+  CPPUNIT_ASSERT(sit == sit.end());
+}
+
+/// test conversion of polarisation products applied to whole cubes
+void TableDataAccessTest::polConversionKernelTest()
+{
+  const casacore::Vector<casacore::Stokes::StokesTypes> linear = scimath::PolConverter::fromString("XX,XY,YX,YY");
+  const char *products[] = {"I,Q,U,V", "I,V,Q", "I", "YY,XX"};
+  casacore::Cube<casacore::Complex> in(3, 5, 4);
+  casacore::Cube<casacore::Bool> inFlag(in.shape(), casacore::False);
+  casacore::Cube<casacore::Complex> inNoise(in.shape());
+  for (casacore::uInt row = 0; row < in.nrow(); ++row) {
+       for (casacore::uInt chan = 0; chan < in.ncolumn(); ++chan) {
+            for (casacore::uInt pol = 0; pol < in.nplane(); ++pol) {
+                 in(row, chan, pol) = casacore::Complex(row + 0.5 * chan - pol, 2. * pol - chan);
+                 inNoise(row, chan, pol) = casacore::Complex(1. + 0.1 * pol, 1. + 0.1 * pol);
+            }
+       }
+  }
+  inFlag(1, 2, 1) = casacore::True;
+  casacore::Matrix<casacore::Float> inSigma(in.nrow(), in.nplane());
+  for (casacore::uInt pol = 0; pol < in.nplane(); ++pol) {
+       inSigma.column(pol) = 1. + 0.1 * pol;
+  }
+  for (size_t test = 0; test < sizeof(products) / sizeof(const char*); ++test) {
+       const casacore::Vector<casacore::Stokes::StokesTypes> wanted = scimath::PolConverter::fromString(products[test]);
+       CPPUNIT_ASSERT(PolarisationConversion::canConvert(linear, wanted));
+       const PolarisationConversion conv(linear, wanted);
+       CPPUNIT_ASSERT_EQUAL(4u, conv.nIn());
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(wanted.nelements()), conv.nOut());
+       const scimath::PolConverter converter(linear, wanted);
+       casacore::Cube<casacore::Complex> out;
+       casacore::Cube<casacore::Bool> outFlag;
+       casacore::Cube<casacore::Complex> outNoise;
+       casacore::Matrix<casacore::Float> outSigma;
+       conv.convertVisibility(in, out);
+       conv.convertFlag(inFlag, outFlag);
+       conv.convertNoise(inNoise, outNoise);
+       conv.convertSigma(inSigma, outSigma);
+       CPPUNIT_ASSERT(out.shape() == casacore::IPosition(3, in.nrow(), in.ncolumn(), conv.nOut()));
+       CPPUNIT_ASSERT(outFlag.shape() == out.shape());
+       CPPUNIT_ASSERT(outNoise.shape() == out.shape());
+       CPPUNIT_ASSERT_EQUAL(in.nrow(), outSigma.nrow());
+       CPPUNIT_ASSERT_EQUAL(conv.nOut(), casacore::uInt(outSigma.ncolumn()));
+       for (casacore::uInt row = 0; row < in.nrow(); ++row) {
+            for (casacore::uInt chan = 0; chan < in.ncolumn(); ++chan) {
+                 const casacore::Vector<casacore::Complex> expected = converter(in.yzPlane(row).row(chan).copy());
+                 for (casacore::uInt pol = 0; pol < conv.nOut(); ++pol) {
+                      CPPUNIT_ASSERT(abs(out(row, chan, pol) - expected[pol]) < 1e-5);
+                      const bool flagged = (row == 1) && (chan == 2) && (abs(conv.coefficient(pol, 1)) > 0.);
+                      CPPUNIT_ASSERT_EQUAL(flagged, bool(outFlag(row, chan, pol)));
+                      // noise is the same for both parts and all rows, as is sigma
+                      CPPUNIT_ASSERT(std::abs(real(outNoise(row, chan, pol)) - outSigma(row, pol)) < 1e-5);
+                      CPPUNIT_ASSERT(std::abs(imag(outNoise(row, chan, pol)) - outSigma(row, pol)) < 1e-5);
+                 }
+            }
+       }
+  }
+  // U needs cross-hand products
+  CPPUNIT_ASSERT(!PolarisationConversion::canConvert(scimath::PolConverter::fromString("XX,YY"),
+                  scimath::PolConverter::fromString("U")));
+}
+
+/// test that products which can't be obtained from the stored correlations are rejected
+void TableDataAccessTest::polConversionTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  // only XX and YY are stored, U requires XY and YX
+  sel->choosePolarizations("U");
+  IConstDataSharedIter it = ds.createConstIterator(sel);
+  it->visibility();
+}
+
+/// test checksums of the data computed during iteration
+void TableDataAccessTest::checksumTest()
+{
+  // the result shouldn't depend on how the data are split into blocks
+  casacore::Vector<casacore::Complex> buf(13);
+  for (casacore::uInt i = 0; i < buf.nelements(); ++i) {
+       buf[i] = casacore::Complex(i, -2. * i);
+  }
+  DataChecksum whole(1);
+  whole.update(buf);
+  DataChecksum pieces(1);
+  const char *ptr = reinterpret_cast<const char*>(buf.data());
+  pieces.update(ptr, 3);
+  pieces.update(ptr + 3, 50);
+  pieces.update(ptr + 53, buf.nelements() * sizeof(casacore::Complex) - 53);
+  CPPUNIT_ASSERT_EQUAL(whole.nBytes(), pieces.nBytes());
+  CPPUNIT_ASSERT(whole.value() == pieces.value());
+  CPPUNIT_ASSERT(whole.value() != DataChecksum(2).value());
+
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT(!ds.checksums());
+  ds.configureChecksums(true);
+  CPPUNIT_ASSERT(ds.checksums());
+  ds.configureMaxChunkSize(7);
+  IDataSelectorPtr sel = ds.createSelector();
+  boost::shared_ptr<TableConstDataIterator> it =
+       boost::dynamic_pointer_cast<TableConstDataIterator>(ds.createConstIterator(sel));
+  CPPUNIT_ASSERT(it);
+  CPPUNIT_ASSERT(it->checksumsEnabled());
+  std::vector<casacore::uInt64> visChecksums;
+  for (; it->hasMore(); it->next()) {
+       (*it)->visibility();
+       (*it)->flag();
+       visChecksums.push_back(it->visibilityChecksum());
+       // accessing the data again doesn't add to the checksum
+       (*it)->visibility();
+       CPPUNIT_ASSERT(visChecksums.back() == it->visibilityChecksum());
+       CPPUNIT_ASSERT(it->flagChecksum() != it->visibilityChecksum());
+  }
+  CPPUNIT_ASSERT(visChecksums.size() > 1);
+  const casacore::uInt64 firstPass = ds.checksums()->value();
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt64(2 * visChecksums.size()), ds.checksums()->count());
+  CPPUNIT_ASSERT(ds.checksums()->nBytes() > 0);
+
+  // the same data read in the background give the same checksums
+  ds.checksums()->reset();
+  ds.configureReadAhead(true);
+  it = boost::dynamic_pointer_cast<TableConstDataIterator>(ds.createConstIterator(sel));
+  CPPUNIT_ASSERT(it);
+  size_t chunk = 0;
+  for (; it->hasMore(); it->next(), ++chunk) {
+       CPPUNIT_ASSERT(chunk < visChecksums.size());
+       (*it)->flag();
+       (*it)->visibility();
+       CPPUNIT_ASSERT(visChecksums[chunk] == it->visibilityChecksum());
+  }
+  CPPUNIT_ASSERT_EQUAL(visChecksums.size(), chunk);
+  CPPUNIT_ASSERT(firstPass == ds.checksums()->value());
+
+  // a different selection gives a different result
+  ds.checksums()->reset();
+  sel->chooseChannels(3,2);
+  for (IConstDataSharedIter cit = ds.createConstIterator(sel); cit != cit.end(); ++cit) {
+       cit->visibility();
+       cit->flag();
+  }
+  CPPUNIT_ASSERT(firstPass != ds.checksums()->value());
+
+  // iterators created after checksums are disabled don't compute them
+  ds.configureChecksums(false);
+  CPPUNIT_ASSERT(!ds.checksums());
+  it = boost::dynamic_pointer_cast<TableConstDataIterator>(ds.createConstIterator(sel));
+  CPPUNIT_ASSERT(it);
+  CPPUNIT_ASSERT(!it->checksumsEnabled());
+  (*it)->visibility();
+  try {
+     it->visibilityChecksum();
+     CPPUNIT_FAIL("An exception is expected if checksums are disabled");
+  }
+  catch (const DataAccessLogicError &) {}
+}
+
+/// test random access to cycles and scans
+void TableDataAccessTest::seekCycleTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  ds.configureMaxChunkSize(7);
+  IDataSelectorPtr sel = ds.createSelector();
+  IDataConverterPtr conv = ds.createConverter();
+  // time and scan of the first accessor in each cycle for sequential iteration
+  std::vector<double> times;
+  std::vector<casacore::uInt> scans;
+  boost::shared_ptr<TableConstDataIterator> it =
+       boost::dynamic_pointer_cast<TableConstDataIterator>(ds.createConstIterator(sel, conv));
+  CPPUNIT_ASSERT(it);
+  for (; it->hasMore(); it->next()) {
+       if (it->currentCycle() == times.size()) {
+           times.push_back((*it)->time());
+           scans.push_back(it->currentScanID());
+       }
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt(times.size() - 1), it->currentCycle());
+  }
+  CPPUNIT_ASSERT(times.size() > 2);
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(times.size()), it->nCycles());
+
+  // jump backwards within the same iterator and continue from there
+  const casacore::uInt middle = casacore::uInt(times.size() / 2);
+  it->seekCycle(middle);
+  CPPUNIT_ASSERT(it->hasMore());
+  CPPUNIT_ASSERT_EQUAL(middle, it->currentCycle());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(times[middle], (*it)->time(), 1e-6);
+  casacore::uInt nCyclesLeft = 1;
+  for (casacore::uInt cycle = middle; it->hasMore(); it->next()) {
+       if (it->currentCycle() != cycle) {
+           CPPUNIT_ASSERT_EQUAL(cycle + 1, it->currentCycle());
+           cycle = it->currentCycle();
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(times[cycle], (*it)->time(), 1e-6);
+           ++nCyclesLeft;
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(casacore::uInt(times.size()) - middle, nCyclesLeft);
+
+  // new iterators positioned via the data source, with and without read-ahead
+  for (int pass = 0; pass < 2; ++pass) {
+       ds.configureReadAhead(pass == 1);
+       for (casacore::uInt cycle = 0; cycle < times.size(); cycle += 2) {
+            const boost::shared_ptr<TableConstDataIterator> cit = ds.createConstIteratorAtCycle(sel, conv, cycle);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(times[cycle], (*cit)->time(), 1e-6);
+            CPPUNIT_ASSERT((*cit)->visibility().nelements() > 0);
+       }
+  }
+  // the first cycle of the scan is found
+  const casacore::uInt lastScan = scans.back();
+  const casacore::uInt firstCycle = casacore::uInt(std::find(scans.begin(), scans.end(), lastScan) - scans.begin());
+  const boost::shared_ptr<TableConstDataIterator> sit = ds.createConstIteratorAtScan(sel, conv, lastScan);
+  CPPUNIT_ASSERT_EQUAL(firstCycle, sit->currentCycle());
+  CPPUNIT_ASSERT_EQUAL(lastScan, sit->currentScanID());
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(times[firstCycle], (*sit)->time(), 1e-6);
+}
+
+/// test that seeking beyond the last cycle is detected
+void TableDataAccessTest::seekBeyondEndTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  IDataSelectorPtr sel = ds.createSelector();
+  boost::shared_ptr<TableConstDataIterator> it =
+       boost::dynamic_pointer_cast<TableConstDataIterator>(ds.createConstIterator(sel));
+  CPPUNIT_ASSERT(it);
+  it->seekCycle(it->nCycles());
+}
+
+/// test caching of rotated uvw and delays across iterations
+void TableDataAccessTest::uvwRotationCacheTest()
+{
+  // least recently used entries are dropped when the memory limit is reached
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > uvw(2, casacore::RigidVector<casacore::Double, 3>(1.,2.,3.));
+  casacore::Vector<casacore::Double> delays(2, 0.5);
+  const size_t entrySize = 2 * (sizeof(casacore::RigidVector<casacore::Double, 3>) + sizeof(casacore::Double));
+  RotatedUVWCache cache(2 * entrySize);
+  cache.add("A", uvw, delays);
+  cache.add("B", uvw, delays);
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > uvwOut;
+  casacore::Vector<casacore::Double> delaysOut;
+  CPPUNIT_ASSERT(cache.find("A", uvwOut, delaysOut));
+  CPPUNIT_ASSERT_EQUAL(size_t(2), size_t(uvwOut.nelements()));
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(2., uvwOut[1](1), 1e-10);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, delaysOut[0], 1e-10);
+  cache.add("C", uvw, delays);
+  CPPUNIT_ASSERT_EQUAL(size_t(2), cache.size());
+  CPPUNIT_ASSERT_EQUAL(2 * entrySize, cache.memoryUsed());
+  CPPUNIT_ASSERT(!cache.find("B", uvwOut, delaysOut));
+  CPPUNIT_ASSERT(cache.find("C", uvwOut, delaysOut));
+  // an entry bigger than the limit is not stored
+  RotatedUVWCache smallCache(entrySize - 1);
+  smallCache.add("A", uvw, delays);
+  CPPUNIT_ASSERT_EQUAL(size_t(0), smallCache.size());
+
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT(!ds.uvwRotationCache());
+  ds.configureUVWRotationCache(true);
+  CPPUNIT_ASSERT(ds.uvwRotationCache());
+  const casacore::MDirection tangent(casacore::MVDirection(0.12345,-0.12345), casacore::MDirection::J2000);
+  const casacore::MDirection imageCentre(casacore::MVDirection(0.1235,-0.1234), casacore::MDirection::J2000);
+  std::vector<casacore::Vector<casacore::RigidVector<casacore::Double, 3> > > rotated;
+  std::vector<casacore::Vector<casacore::Double> > shiftedDelays;
+  for (IConstDataSharedIter it=ds.createConstIterator(); it!=it.end(); ++it) {
+       rotated.push_back(it->rotatedUVW(tangent).copy());
+       shiftedDelays.push_back(it->uvwRotationDelay(tangent, imageCentre).copy());
+  }
+  CPPUNIT_ASSERT(rotated.size() > 1);
+  CPPUNIT_ASSERT_EQUAL(size_t(0), ds.uvwRotationCache()->hits());
+  CPPUNIT_ASSERT_EQUAL(rotated.size(), ds.uvwRotationCache()->size());
+
+  // the second pass takes the results from the cache
+  size_t chunk = 0;
+  for (IConstDataSharedIter it=ds.createConstIterator(); it!=it.end(); ++it, ++chunk) {
+       CPPUNIT_ASSERT(chunk < rotated.size());
+       // request delays first to check that the shift is not stored in the cache
+       const casacore::Vector<casacore::Double> &delays = it->uvwRotationDelay(tangent, imageCentre);
+       const casacore::Vector<casacore::RigidVector<casacore::Double, 3> > &uvwRotated = it->rotatedUVW(tangent);
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(uvwRotated.nelements()));
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(delays.nelements()));
+       for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+            for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                 CPPUNIT_ASSERT_DOUBLES_EQUAL(rotated[chunk][row](dim), uvwRotated[row](dim), 1e-10);
+            }
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(shiftedDelays[chunk][row], delays[row], 1e-10);
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(rotated.size(), chunk);
+  CPPUNIT_ASSERT_EQUAL(rotated.size(), ds.uvwRotationCache()->hits());
+
+  // a different tangent point is a different entry
+  const casacore::MDirection otherTangent(casacore::MVDirection(0.2,-0.2), casacore::MDirection::J2000);
+  IConstDataSharedIter it=ds.createConstIterator();
+  it->rotatedUVW(otherTangent);
+  CPPUNIT_ASSERT_EQUAL(rotated.size(), ds.uvwRotationCache()->hits());
+  CPPUNIT_ASSERT_EQUAL(rotated.size() + 1, ds.uvwRotationCache()->size());
+}
+
+void TableDataAccessTest::pointingTableTest()
+{
+  const casacore::Table ms(TableTestRunner::msName());
+  const PointingSubtableHandler handler(ms);
+  CPPUNIT_ASSERT(!handler.isMapped());
+  // spilling to a file should give the same result
+  const PointingSubtableHandler mappedHandler(ms, ".", 0);
+  CPPUNIT_ASSERT_EQUAL(handler.nSamples(), mappedHandler.nSamples());
+  CPPUNIT_ASSERT_EQUAL(handler.nAntenna(), mappedHandler.nAntenna());
+  CPPUNIT_ASSERT(handler.empty() || mappedHandler.isMapped());
+  CPPUNIT_ASSERT_EQUAL(handler.dataSize(), mappedHandler.dataSize());
+  const casacore::Table pointingTable = ms.keywordSet().asTable("POINTING");
+  CPPUNIT_ASSERT_EQUAL(size_t(pointingTable.nrow()), handler.nSamples());
+  if (!handler.empty()) {
+      const casacore::ROScalarColumn<casacore::Double> timeCol(pointingTable, "TIME");
+      const casacore::ROScalarColumn<casacore::Int> antCol(pointingTable, "ANTENNA_ID");
+      const casacore::ROArrayColumn<casacore::Double> dirCol(pointingTable, "DIRECTION");
+      for (casacore::uInt row = 0; row < pointingTable.nrow(); row += 1 + pointingTable.nrow() / 10) {
+           const casacore::Array<casacore::Double> dir = dirCol(row);
+           const casacore::MVDirection expected(dir.data()[0], dir.data()[1]);
+           casacore::MVDirection result, mappedResult;
+           CPPUNIT_ASSERT(handler.getPointing(antCol(row), timeCol(row), result));
+           CPPUNIT_ASSERT(mappedHandler.getPointing(antCol(row), timeCol(row), mappedResult));
+           // multiple rows for the same time are allowed, but shouldn't differ much
+           CPPUNIT_ASSERT(result.separation(expected) < 1e-3);
+           CPPUNIT_ASSERT(result.separation(mappedResult) < 1e-12);
+      }
+  }
+  casacore::MVDirection dir;
+  CPPUNIT_ASSERT(!handler.getPointing(handler.nAntenna(), 0., dir));
+
+  // the FIELD subtable is used for antennas which have no pointing samples
+  TableConstDataSource ds(TableTestRunner::msName());
+  CPPUNIT_ASSERT(!ds.pointingHandler());
+  std::vector<casacore::MVDirection> fieldPointings;
+  for (IConstDataSharedIter it=ds.createConstIterator(); it!=it.end(); ++it) {
+       fieldPointings.push_back(it->dishPointing1()[0]);
+  }
+  ds.configurePointingTable(true);
+  CPPUNIT_ASSERT(ds.pointingHandler());
+  CPPUNIT_ASSERT_EQUAL(handler.nSamples(), ds.pointingHandler()->nSamples());
+  size_t chunk = 0;
+  for (IConstDataSharedIter it=ds.createConstIterator(); it!=it.end(); ++it, ++chunk) {
+       CPPUNIT_ASSERT(chunk < fieldPointings.size());
+       CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->dishPointing1().nelements()));
+       if (handler.empty()) {
+           CPPUNIT_ASSERT(it->dishPointing1()[0].separation(fieldPointings[chunk]) < 1e-10);
+       }
+  }
+  CPPUNIT_ASSERT_EQUAL(fieldPointings.size(), chunk);
+  ds.configurePointingTable(false);
+  CPPUNIT_ASSERT(!ds.pointingHandler());
+}
+
+void TableDataAccessTest::wireFormatTest()
+{
+  TableConstDataSource ds(TableTestRunner::msName());
+  const casacore::uInt fields = IDataSelector::VISIBILITY | IDataSelector::FLAG | IDataSelector::NOISE |
+        IDataSelector::UVW | IDataSelector::FREQUENCY | IDataSelector::ANTENNA | IDataSelector::FEED_PA |
+        IDataSelector::POINTING | IDataSelector::STOKES;
+  size_t nAccessors = 0;
+  for (IConstDataSharedIter it = ds.createConstIterator(); it != it.end(); ++it, ++nAccessors) {
+       const IConstDataAccessor &acc = *it;
+       boost::shared_ptr<std::vector<char> > buffer(new std::vector<char>);
+       AccessorWireFormat::pack(acc, *buffer, fields);
+       const AccessorWireFormat::Header header = AccessorWireFormat::header(*buffer);
+       CPPUNIT_ASSERT_EQUAL(fields, header.itsFields);
+       CPPUNIT_ASSERT_EQUAL(acc.nRow(), header.itsNRow);
+       CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), header.itsOffsets[AccessorWireFormat::FEED1_BLOCK]);
+       for (int block = 0; block < AccessorWireFormat::N_BLOCKS; ++block) {
+            CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), header.itsOffsets[block] % AccessorWireFormat::theirAlignment);
+       }
+
+       const WireDataAccessor wire(buffer);
+       CPPUNIT_ASSERT_EQUAL(fields, wire.fields());
+       CPPUNIT_ASSERT_EQUAL(acc.nRow(), wire.nRow());
+       CPPUNIT_ASSERT_EQUAL(acc.nChannel(), wire.nChannel());
+       CPPUNIT_ASSERT_EQUAL(acc.nPol(), wire.nPol());
+       CPPUNIT_ASSERT_EQUAL(acc.time(), wire.time());
+       // the cubes refer to the buffer rather than to a copy
+       CPPUNIT_ASSERT(reinterpret_cast<const char*>(wire.visibility().data()) ==
+                      &(*buffer)[0] + header.itsOffsets[AccessorWireFormat::VISIBILITY_BLOCK]);
+       CPPUNIT_ASSERT(reinterpret_cast<const char*>(wire.flag().data()) ==
+                      &(*buffer)[0] + header.itsOffsets[AccessorWireFormat::FLAG_BLOCK]);
+       CPPUNIT_ASSERT(casacore::allEQ(acc.visibility(), wire.visibility()));
+       CPPUNIT_ASSERT(casacore::allEQ(acc.flag(), wire.flag()));
+       CPPUNIT_ASSERT(casacore::allEQ(acc.noise(), wire.noise()));
+       CPPUNIT_ASSERT(casacore::allEQ(acc.frequency(), wire.frequency()));
+       CPPUNIT_ASSERT(casacore::allEQ(acc.antenna1(), wire.antenna1()));
+       CPPUNIT_ASSERT(casacore::allEQ(acc.antenna2(), wire.antenna2()));
+       CPPUNIT_ASSERT(casacore::allEQ(acc.feed1PA(), wire.feed1PA()));
+       CPPUNIT_ASSERT(casacore::allEQ(acc.feed2PA(), wire.feed2PA()));
+       CPPUNIT_ASSERT_EQUAL(size_t(0), size_t(wire.feed1().nelements()));
+       CPPUNIT_ASSERT_EQUAL(acc.stokes().nelements(), wire.stokes().nelements());
+       for (casacore::uInt pol = 0; pol < acc.nPol(); ++pol) {
+            CPPUNIT_ASSERT_EQUAL(acc.stokes()[pol], wire.stokes()[pol]);
+       }
+       for (casacore::uInt row = 0; row < acc.nRow(); ++row) {
+            for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                 CPPUNIT_ASSERT_EQUAL(acc.uvw()[row](dim), wire.uvw()[row](dim));
+            }
+            CPPUNIT_ASSERT(acc.pointingDir1()[row].separation(wire.pointingDir1()[row]) < 1e-12);
+            CPPUNIT_ASSERT(acc.pointingDir2()[row].separation(wire.pointingDir2()[row]) < 1e-12);
+       }
+  }
+  CPPUNIT_ASSERT(nAccessors > 0);
+
+  // buffers not in this format are rejected
+  std::vector<char> garbage(sizeof(AccessorWireFormat::Header) + 16, 'x');
+  CPPUNIT_ASSERT_THROW(AccessorWireFormat::header(garbage), AskapError);
+  garbage.resize(4);
+  CPPUNIT_ASSERT_THROW(AccessorWireFormat::header(garbage), AskapError);
+}
+
+void TableDataAccessTest::memoryGovernorTest()
+{
+  MemoryGovernor &governor = MemoryGovernor::instance();
+  const size_t oldBudget = governor.budget();
+  governor.setBudget(0);
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > uvw(2, casacore::RigidVector<casacore::Double, 3>(1.,2.,3.));
+  casacore::Vector<casacore::Double> delays(2, 0.5);
+  const size_t entrySize = 2 * (sizeof(casacore::RigidVector<casacore::Double, 3>) + sizeof(casacore::Double));
+  casacore::Vector<casacore::RigidVector<casacore::Double, 3> > uvwOut;
+  casacore::Vector<casacore::Double> delaysOut;
+  {
+    RotatedUVWCache first(10 * entrySize);
+    RotatedUVWCache second(10 * entrySize);
+    first.add("A", uvw, delays);
+    second.add("B", uvw, delays);
+    first.add("C", uvw, delays);
+    CPPUNIT_ASSERT(first.find("A", uvwOut, delaysOut));
+    const size_t used = governor.memoryUsed();
+    CPPUNIT_ASSERT(used >= 3 * entrySize);
+    // the least recently used entry goes first, whichever cache it belongs to
+    const size_t evictions = governor.evictions();
+    governor.setBudget(used - 1);
+    CPPUNIT_ASSERT_EQUAL(evictions + 1, governor.evictions());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), second.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), first.size());
+    CPPUNIT_ASSERT(first.find("C", uvwOut, delaysOut));
+    // caches with the lower priority are released first, even if their entries are newer
+    governor.setBudget(0);
+    VisibilityCache visCache;
+    governor.setPriority("VisibilityCache", 1);
+    visCache.addFlag("row0", casacore::Cube<casacore::Bool>(10, 8, 4, false));
+    const size_t flagSize = visCache.memoryUsage();
+    CPPUNIT_ASSERT(flagSize > 0);
+    CPPUNIT_ASSERT(first.find("A", uvwOut, delaysOut));
+    CPPUNIT_ASSERT(first.find("C", uvwOut, delaysOut));
+    governor.setBudget(governor.memoryUsed() - 1);
+    CPPUNIT_ASSERT_EQUAL(size_t(1), first.size());
+    CPPUNIT_ASSERT(first.find("C", uvwOut, delaysOut));
+    CPPUNIT_ASSERT_EQUAL(flagSize, visCache.memoryUsage());
+    const std::vector<MemoryGovernor::Usage> usage = governor.usage();
+    size_t total = 0;
+    for (size_t index = 0; index < usage.size(); ++index) {
+         total += usage[index].itsBytes;
+         if (usage[index].itsName == "VisibilityCache") {
+             CPPUNIT_ASSERT_EQUAL(1, usage[index].itsPriority);
+         }
+    }
+    CPPUNIT_ASSERT_EQUAL(governor.memoryUsed(), total);
+    governor.setPriority("VisibilityCache", 0);
+  }
+  // the budget is given in megabytes in the parset
+  LOFAR::ParameterSet parset;
+  parset.add("memorybudget", "2");
+  parset.add("memorybudget.priority.RotatedUVWCache", "-1");
+  governor.configure(parset);
+  CPPUNIT_ASSERT_EQUAL(size_t(2 * 1024 * 1024), governor.budget());
+  governor.setPriority("RotatedUVWCache", 0);
+  governor.setBudget(oldBudget);
+}
+
 } // namespace accessors
 
 } // namespace askap
@@ -31,13 +31,30 @@
 
 // boost includes
 #include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+// std includes
+#include <set>
+#include <map>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <algorithm>
 
 // cppunit includes
 #include <cppunit/extensions/HelperMacros.h>
+// casa includes
+#include <casacore/casa/Arrays/ArrayLogical.h>
 // own includes
 #include <askap/dataaccess/TableDataSource.h>
 #include <askap/dataaccess/IConstDataSource.h>
 #include <askap/dataaccess/TimeChunkIteratorAdapter.h>
+#include <askap/dataaccess/TimeChunkBuffer.h>
+#include <askap/dataaccess/AccessorBroadcast.h>
+#include <askap/dataaccess/StatisticsIteratorAdapter.h>
+#include <askap/dataaccess/TimeAveragingIteratorAdapter.h>
+#include <askap/dataaccess/BaselineMajorIterator.h>
 #include <askap/askap/AskapError.h>
 #include "TableTestRunner.h"
 #include <askap/askap/AskapUtil.h>
@@ -53,6 +70,12 @@ class TimeChunkIteratorAdapterTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_EXCEPTION(testReadOnlyBuffer,AskapError);  
   CPPUNIT_TEST_EXCEPTION(testReadOnlyAccessor,AskapError); 
   CPPUNIT_TEST_EXCEPTION(testNoResume,AskapError); 
+  CPPUNIT_TEST(testChunkBuffer);
+  CPPUNIT_TEST_EXCEPTION(testChunkBufferLookAhead,AskapError);
+  CPPUNIT_TEST(testBroadcast);
+  CPPUNIT_TEST(testStatistics);
+  CPPUNIT_TEST(testTimeAveraging);
+  CPPUNIT_TEST(testBaselineMajor);
   CPPUNIT_TEST_SUITE_END();
 protected:
   static size_t countSteps(const IConstDataSharedIter &it) {
@@ -60,6 +83,19 @@ protected:
      for (counter = 0; it!=it.end(); ++it,++counter) {}
      return counter;     
   }
+
+  /// @brief consume all accessors of the broadcast
+  /// @param[in] broadcast broadcast object
+  /// @param[in] consumer index of the consumer
+  /// @param[out] count number of accessors received
+  /// @param[out] sumTime sum of the time stamps of all accessors received
+  static void consume(AccessorBroadcast *broadcast, size_t consumer, size_t *count, double *sumTime) {
+     for (boost::shared_ptr<IConstDataAccessor const> acc = broadcast->next(consumer); acc;
+          acc = broadcast->next(consumer)) {
+          ++(*count);
+          *sumTime += acc->time();
+     }
+  }
 public:
   void testTimeChunks() {
      TableConstDataSource ds(TableTestRunner::msName());
@@ -142,6 +178,296 @@ public:
      // the following should throw AskapError
      CPPUNIT_ASSERT(it->next());
   }
+
+  void testChunkBuffer() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     IConstDataSharedIter plainIt = ds.createConstIterator(conv);
+     TimeChunkBuffer buf(ds.createConstIterator(conv), 5990, 3);
+     CPPUNIT_ASSERT_EQUAL(size_t(3), buf.maxChunks());
+     size_t counter = 0;
+     for (; buf.hasChunk(); ++counter) {
+          boost::shared_ptr<TimeChunkBuffer::Chunk const> chunk = buf.chunk();
+          CPPUNIT_ASSERT(chunk);
+          CPPUNIT_ASSERT_EQUAL(size_t(10), chunk->itsAccessors.size());
+          // buffered accessors should match those read directly
+          for (size_t index = 0; index < chunk->itsAccessors.size(); ++index, ++plainIt) {
+               CPPUNIT_ASSERT(plainIt != plainIt.end());
+               const IConstDataAccessor &acc = *(chunk->itsAccessors[index]);
+               CPPUNIT_ASSERT_EQUAL(plainIt->nRow(), acc.nRow());
+               CPPUNIT_ASSERT_EQUAL(plainIt->nChannel(), acc.nChannel());
+               CPPUNIT_ASSERT_EQUAL(plainIt->nPol(), acc.nPol());
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(plainIt->time(), acc.time(), 1e-6);
+               CPPUNIT_ASSERT(casacore::allEQ(plainIt->visibility(), acc.visibility()));
+               CPPUNIT_ASSERT(casacore::allEQ(plainIt->antenna1(), acc.antenna1()));
+               CPPUNIT_ASSERT(casacore::allEQ(plainIt->frequency(), acc.frequency()));
+          }
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(chunk->itsAccessors[0]->time(), chunk->itsTime, 1e-6);
+          // look ahead without re-reading
+          if (buf.hasChunk(2)) {
+              CPPUNIT_ASSERT(buf.chunk(1)->itsTime > chunk->itsTime);
+              CPPUNIT_ASSERT(buf.chunk(2)->itsTime > buf.chunk(1)->itsTime);
+          }
+          buf.next();
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(42), counter);
+     CPPUNIT_ASSERT_EQUAL(size_t(42), buf.chunksRead());
+     CPPUNIT_ASSERT(buf.peakChunksHeld() <= 3);
+     CPPUNIT_ASSERT(buf.peakChunksHeld() > 0);
+     CPPUNIT_ASSERT(buf.producerWaitTime() >= 0.);
+     CPPUNIT_ASSERT(buf.consumerWaitTime() >= 0.);
+     CPPUNIT_ASSERT(!buf.hasChunk(2));
+  }
+
+  void testChunkBufferLookAhead() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     TimeChunkBuffer buf(ds.createConstIterator(conv), 5990, 2);
+     CPPUNIT_ASSERT(buf.hasChunk(1));
+     // this should throw AskapError, as the buffer holds only 2 chunks
+     buf.hasChunk(2);
+  }
+
+  void testStatistics() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataSelectorPtr sel = ds.createSelector();
+     sel->chooseChannels(5,0);
+     // reference statistics from a plain loop over the flag cube
+     casacore::uInt64 nSamples = 0, nFlagged = 0;
+     double sumAmp = 0.;
+     size_t nAccessors = 0;
+     std::set<std::pair<casacore::uInt, casacore::uInt> > baselines;
+     for (IConstDataSharedIter it = ds.createConstIterator(sel); it != it.end(); ++it, ++nAccessors) {
+          nSamples += it->flag().nelements();
+          nFlagged += casacore::ntrue(it->flag());
+          for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+               baselines.insert(std::make_pair(it->antenna1()[row], it->antenna2()[row]));
+               for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                    for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+                         if (!it->flag()(row, chan, pol)) {
+                             sumAmp += casacore::abs(it->visibility()(row, chan, pol));
+                         }
+                    }
+               }
+          }
+     }
+     CPPUNIT_ASSERT(nSamples > 0);
+     for (casacore::uInt nThreads = 1; nThreads < 5; nThreads += 3) {
+          StatisticsIteratorAdapter it(ds.createConstIterator(sel), nThreads);
+          CPPUNIT_ASSERT_EQUAL(nThreads, it.nThreads());
+          size_t counter = 0;
+          for (it.init(); it.hasMore(); it.next(), ++counter) {
+               CPPUNIT_ASSERT(it->nRow() > 0);
+          }
+          CPPUNIT_ASSERT_EQUAL(nAccessors, counter);
+          const VisibilityStatistics &stats = it.statistics();
+          CPPUNIT_ASSERT_EQUAL(nSamples, stats.total().itsSamples);
+          CPPUNIT_ASSERT_EQUAL(nFlagged, stats.total().itsFlagged);
+          CPPUNIT_ASSERT_EQUAL(nSamples - nFlagged, stats.amplitude().itsCount);
+          CPPUNIT_ASSERT_EQUAL(nSamples - nFlagged, stats.noise().itsCount);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(sumAmp, stats.amplitude().itsSum, 1e-6 * (sumAmp + 1.));
+          CPPUNIT_ASSERT(stats.amplitude().variance() >= 0.);
+          CPPUNIT_ASSERT(stats.noise().itsMin <= stats.noise().itsMax);
+          CPPUNIT_ASSERT_EQUAL(baselines.size(), stats.baselines().size());
+          CPPUNIT_ASSERT_EQUAL(size_t(5), stats.channels().size());
+          casacore::uInt64 channelSamples = 0, baselineFlagged = 0, timeSamples = 0;
+          for (size_t chan = 0; chan < stats.channels().size(); ++chan) {
+               channelSamples += stats.channels()[chan].itsSamples;
+          }
+          for (std::map<VisibilityStatistics::BaselineType, VisibilityStatistics::BaselineSummary>::const_iterator ci =
+               stats.baselines().begin(); ci != stats.baselines().end(); ++ci) {
+               baselineFlagged += ci->second.itsFlags.itsFlagged;
+          }
+          for (std::map<double, VisibilityStatistics::FlagCounts>::const_iterator ci = stats.times().begin();
+               ci != stats.times().end(); ++ci) {
+               timeSamples += ci->second.itsSamples;
+          }
+          CPPUNIT_ASSERT_EQUAL(nSamples, channelSamples);
+          CPPUNIT_ASSERT_EQUAL(nFlagged, baselineFlagged);
+          CPPUNIT_ASSERT_EQUAL(nSamples, timeSamples);
+          // the statistics are reset for a new pass
+          it.init();
+          CPPUNIT_ASSERT_EQUAL(casacore::uInt64(0), it.statistics().total().itsSamples);
+     }
+  }
+
+  void testTimeAveraging() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     IDataSelectorPtr sel = ds.createSelector();
+     sel->chooseChannels(5,0);
+     // a single integration is a copy of the original data
+     IConstDataSharedIter refIt = ds.createConstIterator(sel,conv);
+     TimeAveragingIteratorAdapter it(ds.createConstIterator(sel,conv), 1);
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), it.nIntegrations());
+     size_t counter = 0;
+     for (; it.hasMore(); it.next(), ++refIt, ++counter) {
+          CPPUNIT_ASSERT(refIt != refIt.end());
+          CPPUNIT_ASSERT_EQUAL(casacore::uInt(1), it.integrationsAveraged());
+          CPPUNIT_ASSERT_EQUAL(refIt->nRow(), it->nRow());
+          CPPUNIT_ASSERT_EQUAL(refIt->nChannel(), it->nChannel());
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->time(), it->time(), 1e-6);
+          for (casacore::uInt row = 0; row < it->nRow(); ++row) {
+               CPPUNIT_ASSERT_EQUAL(refIt->antenna1()[row], it->antenna1()[row]);
+               CPPUNIT_ASSERT_EQUAL(refIt->antenna2()[row], it->antenna2()[row]);
+               for (casacore::uInt dim = 0; dim < 3; ++dim) {
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(refIt->uvw()[row](dim), it->uvw()[row](dim), 1e-6);
+               }
+               for (casacore::uInt chan = 0; chan < it->nChannel(); ++chan) {
+                    for (casacore::uInt pol = 0; pol < it->nPol(); ++pol) {
+                         const casacore::Complex refVis = refIt->visibility()(row, chan, pol);
+                         CPPUNIT_ASSERT(casacore::abs(refVis - it->visibility()(row, chan, pol)) <
+                                        1e-5 * (1. + casacore::abs(refVis)));
+                         if (casacore::real(refIt->noise()(row, chan, pol)) > 0.) {
+                             CPPUNIT_ASSERT_EQUAL(bool(refIt->flag()(row, chan, pol)),
+                                                  bool(it->flag()(row, chan, pol)));
+                         }
+                    }
+               }
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(420), counter);
+     CPPUNIT_ASSERT(refIt == refIt.end());
+
+     // average 10 integrations and compare the first interval with the sums done here
+     TimeAveragingIteratorAdapter avgIt(ds.createConstIterator(sel,conv), 10);
+     CPPUNIT_ASSERT(avgIt.hasMore());
+     CPPUNIT_ASSERT(avgIt.integrationsAveraged() <= 10);
+     std::map<std::pair<casacore::uInt, casacore::uInt>, std::pair<casacore::DComplex, double> > sums;
+     double sumTime = 0.;
+     refIt.init();
+     for (size_t step = 0; step < avgIt.accessorsAveraged(); ++step, ++refIt) {
+          CPPUNIT_ASSERT(refIt != refIt.end());
+          sumTime += refIt->time();
+          for (casacore::uInt row = 0; row < refIt->nRow(); ++row) {
+               const casacore::Float sigma = casacore::real(refIt->noise()(row, 0, 0));
+               if (!refIt->flag()(row, 0, 0) && sigma > 0.) {
+                   std::pair<casacore::DComplex, double> &sum =
+                           sums[std::make_pair(refIt->antenna1()[row], refIt->antenna2()[row])];
+                   sum.first += casacore::DComplex(refIt->visibility()(row, 0, 0)) / double(sigma * sigma);
+                   sum.second += 1. / (sigma * sigma);
+               }
+          }
+     }
+     CPPUNIT_ASSERT_DOUBLES_EQUAL(sumTime / avgIt.accessorsAveraged(), avgIt->time(), 1e-3);
+     for (casacore::uInt row = 0; row < avgIt->nRow(); ++row) {
+          const std::map<std::pair<casacore::uInt, casacore::uInt>, std::pair<casacore::DComplex, double> >::const_iterator
+                ci = sums.find(std::make_pair(avgIt->antenna1()[row], avgIt->antenna2()[row]));
+          CPPUNIT_ASSERT_EQUAL(ci == sums.end(), bool(avgIt->flag()(row, 0, 0)));
+          if (ci != sums.end()) {
+              const casacore::DComplex expected = ci->second.first / ci->second.second;
+              CPPUNIT_ASSERT(abs(expected - casacore::DComplex(avgIt->visibility()(row, 0, 0))) <
+                             1e-5 * (1. + abs(expected)));
+              CPPUNIT_ASSERT_DOUBLES_EQUAL(1. / sqrt(ci->second.second), casacore::real(avgIt->noise()(row, 0, 0)),
+                                           1e-5);
+          }
+     }
+     size_t nAveraged = 0;
+     casacore::uInt maxRows = 0;
+     for (avgIt.init(); avgIt.hasMore(); avgIt.next()) {
+          nAveraged += avgIt.integrationsAveraged();
+          maxRows = std::max(maxRows, avgIt->nRow());
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(420), nAveraged);
+
+     // the bound on the number of rows closes the interval before new baselines are added,
+     // but a single accessor is always accepted
+     TimeAveragingIteratorAdapter boundIt(ds.createConstIterator(sel,conv), 10, 1);
+     CPPUNIT_ASSERT_EQUAL(size_t(1), boundIt.maxRows());
+     for (nAveraged = 0; boundIt.hasMore(); boundIt.next()) {
+          CPPUNIT_ASSERT(boundIt->nRow() <= maxRows);
+          nAveraged += boundIt.integrationsAveraged();
+     }
+     CPPUNIT_ASSERT_EQUAL(size_t(420), nAveraged);
+  }
+
+  void testBaselineMajor() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     IDataSelectorPtr sel = ds.createSelector();
+     sel->chooseChannels(5,0);
+     // time series of each baseline gathered in memory
+     typedef BaselineMajorCache::BaselineKey BaselineKey;
+     std::map<BaselineKey, std::vector<std::pair<double, casacore::Complex> > > series;
+     size_t totalRows = 0;
+     for (IConstDataSharedIter it = ds.createConstIterator(sel,conv); it != it.end(); ++it) {
+          for (casacore::uInt row = 0; row < it->nRow(); ++row, ++totalRows) {
+               series[BaselineKey(it->antenna1()[row], it->antenna2()[row], it->feed1()[row],
+                      it->feed2()[row])].push_back(std::make_pair(it->time(), it->visibility()(row, 4, 0)));
+          }
+     }
+     IConstDataSharedIter srcIt = ds.createConstIterator(sel,conv);
+     BaselineMajorIterator it(*srcIt, "/tmp", 16);
+     // 420 integrations in blocks of 16
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(27), it.cache().nBlocks());
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt(series.size()), it.cache().nBaselines());
+     CPPUNIT_ASSERT(it.cache().diskUsage() > 0);
+     size_t nRows = 0;
+     for (; it.hasMore(); it.next()) {
+          CPPUNIT_ASSERT_EQUAL(casacore::uInt(5), it->nChannel());
+          CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it.times().nelements()));
+          CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->flag().nrow()));
+          CPPUNIT_ASSERT_EQUAL(it->nRow(), casacore::uInt(it->uvw().nelements()));
+          CPPUNIT_ASSERT(it->nRow() > 0);
+          const BaselineKey key(it->antenna1()[0], it->antenna2()[0], it->feed1()[0], it->feed2()[0]);
+          CPPUNIT_ASSERT(key == it.cache().baseline(it.baselineIndex()));
+          const std::map<BaselineKey, std::vector<std::pair<double, casacore::Complex> > >::const_iterator ci =
+                series.find(key);
+          CPPUNIT_ASSERT(ci != series.end());
+          CPPUNIT_ASSERT_EQUAL(ci->second.size(), size_t(it->nRow()));
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(ci->second[0].first, it->time(), 1e-6);
+          for (casacore::uInt row = 0; row < it->nRow(); ++row, ++nRows) {
+               CPPUNIT_ASSERT_EQUAL(std::get<1>(key), it->antenna2()[row]);
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(ci->second[row].first, it.times()[row], 1e-6);
+               CPPUNIT_ASSERT_EQUAL(ci->second[row].second, it->visibility()(row, 4, 0));
+          }
+     }
+     CPPUNIT_ASSERT_EQUAL(totalRows, nRows);
+  }
+
+  void testBroadcast() {
+     TableConstDataSource ds(TableTestRunner::msName());
+     IDataConverterPtr conv=ds.createConverter();
+     conv->setEpochFrame(); // ensures seconds since 0 MJD
+     double plainSumTime = 0.;
+     for (IConstDataSharedIter it = ds.createConstIterator(conv); it != it.end(); ++it) {
+          plainSumTime += it->time();
+     }
+     const boost::shared_ptr<AccessorBroadcast> broadcast(new AccessorBroadcast(ds.createConstIterator(conv), 4, 3));
+     CPPUNIT_ASSERT_EQUAL(size_t(4), broadcast->nConsumers());
+     CPPUNIT_ASSERT_EQUAL(size_t(3), broadcast->capacity());
+     // the last consumer stops early, this shouldn't stall the others
+     {
+       BroadcastConsumerIterator it(broadcast, 3);
+       CPPUNIT_ASSERT(it.hasMore());
+       it.init();
+       CPPUNIT_ASSERT(it->nRow() > 0);
+       it.next();
+     }
+     size_t counts[3] = {0, 0, 0};
+     double sumTimes[3] = {0., 0., 0.};
+     boost::thread_group threads;
+     for (size_t consumer = 0; consumer < 2; ++consumer) {
+          threads.create_thread(boost::bind(&TimeChunkIteratorAdapterTest::consume, broadcast.get(), consumer,
+                                counts + consumer, sumTimes + consumer));
+     }
+     // the iterator interface in this thread
+     for (BroadcastConsumerIterator it(broadcast, 2); it.hasMore(); it.next()) {
+          ++counts[2];
+          sumTimes[2] += it->time();
+          CPPUNIT_ASSERT(it->visibility().nelements() > 0);
+     }
+     threads.join_all();
+     for (size_t consumer = 0; consumer < 3; ++consumer) {
+          CPPUNIT_ASSERT_EQUAL(size_t(420), counts[consumer]);
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(plainSumTime, sumTimes[consumer], 1e-3);
+     }
+     CPPUNIT_ASSERT_EQUAL(casacore::uInt64(420), broadcast->accessorsRead());
+  }
  
 };
 
@@ -31,6 +31,8 @@
 #define UVW_MACHINE_CACHE_TEST_H
 
 #include <askap/dataaccess/UVWMachineCache.h>
+#include <askap/dataaccess/CompiledUVWMachine.h>
+#include <askap/dataaccess/TempUVWMachine.h>
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <casacore/casa/Quanta/MVDirection.h>
@@ -56,6 +58,8 @@ class UVWMachineCacheTest : public CppUnit::TestFixture {
    CPPUNIT_TEST(oneElementCacheTest);
    CPPUNIT_TEST(twoElementsCacheTest);
    CPPUNIT_TEST(uvwMachineFrameConvTest);
+   CPPUNIT_TEST(lruStatsTest);
+   CPPUNIT_TEST(compiledMachineTest);
    CPPUNIT_TEST_SUITE_END();
 public:
    void setUp() {
@@ -235,6 +239,33 @@ public:
       itsMachineCache.reset(new UVWMachineCache(2,1e-6));
       testCaching();
    }
+
+   void lruStatsTest() {
+      itsMachineCache.reset(new UVWMachineCache(2,1e-6));
+      const casacore::MDirection dir1(casacore::MVDirection(0.123456, -0.123456), casacore::MDirection::J2000);
+      const casacore::MDirection dir2(casacore::MVDirection(-0.123456, -0.123456), casacore::MDirection::J2000);
+      const casacore::MDirection dir3(casacore::MVDirection(1.123456, -0.2), casacore::MDirection::J2000);
+      // slightly offset from dir1, within the tolerance
+      const casacore::MDirection dir1a(casacore::MVDirection(0.123456+1e-7, -0.123456), casacore::MDirection::J2000);
+      itsMachineCache->machine(dir1,dir2);
+      itsMachineCache->machine(dir3,dir2);
+      CPPUNIT_ASSERT_EQUAL(size_t(0), itsMachineCache->hits());
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsMachineCache->misses());
+      CPPUNIT_ASSERT_EQUAL(size_t(0), itsMachineCache->evictions());
+      // dir1 becomes the most recently used
+      itsMachineCache->machine(dir1a,dir2);
+      CPPUNIT_ASSERT_EQUAL(size_t(1), itsMachineCache->hits());
+      // this should evict dir3 (least recently used)
+      itsMachineCache->machine(dir2,dir1);
+      CPPUNIT_ASSERT_EQUAL(size_t(3), itsMachineCache->misses());
+      CPPUNIT_ASSERT_EQUAL(size_t(1), itsMachineCache->evictions());
+      itsMachineCache->machine(dir1,dir2);
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsMachineCache->hits());
+      itsMachineCache->machine(dir3,dir2);
+      CPPUNIT_ASSERT_EQUAL(size_t(4), itsMachineCache->misses());
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsMachineCache->evictions());
+      testDirections(dir1.getValue(), dir2.getValue());
+   }
    
 protected:
    void testCaching() const {
@@ -254,13 +285,14 @@ protected:
       casacore::MDirection dir1j2000(dir1, casacore::MDirection::J2000);
       casacore::MDirection dir2j2000(dir2, casacore::MDirection::J2000);
       ASKAPASSERT(itsMachineCache);
-      const accessors::UVWMachineCache::machineType &cachedMachine = itsMachineCache->machine(dir1,dir2);
+      const accessors::CompiledUVWMachine &cachedMachine = itsMachineCache->machine(dir1,dir2);
       // create a proper machine by hand
       accessors::UVWMachineCache::machineType machine2(dir2,dir1,false,false);
       compareMachines(cachedMachine, machine2);         
    }
    
-   static void compareMachines(const accessors::UVWMachineCache::machineType &m1, const accessors::UVWMachineCache::machineType &m2) {
+   template<typename Machine1, typename Machine2>
+   static void compareMachines(const Machine1 &m1, const Machine2 &m2) {
        casacore::Vector<double> uvw(3);
        uvw[0]=1000.0; uvw[1]=-3250.0; uvw[2]=12.5;
        casacore::Vector<double> uvwCopy(uvw.copy());
@@ -273,6 +305,53 @@ protected:
        }
    }   
    
+   void compiledMachineTest() {
+      const casacore::MDirection dir1(casacore::MVDirection(0.123456, -0.723456), casacore::MDirection::J2000);
+      const casacore::MDirection dir2(casacore::MVDirection(0.183456, -0.693456), casacore::MDirection::J2000);
+      // projection is included in the compiled form
+      const casacore::UVWMachine machine(dir2, dir1, false, true);
+      const accessors::CompiledUVWMachine compiled = accessors::CompiledUVWMachine::compile(machine);
+      compareMachines(compiled, machine);
+      const accessors::TempUVWMachine tempMachine(dir2, dir1);
+      compareMachines(accessors::CompiledUVWMachine::compile(tempMachine), tempMachine);
+
+      // batched conversion gives the same result as the machine row by row
+      const size_t nRows = 7;
+      casacore::Vector<casacore::RigidVector<double, 3> > uvw(nRows), uvwOut(nRows);
+      casacore::Vector<double> delays(nRows);
+      for (size_t row = 0; row < nRows; ++row) {
+           uvw[row](0) = 100. * row - 250.;
+           uvw[row](1) = 3000. - 700. * row;
+           uvw[row](2) = 15. * row;
+      }
+      UVWBounds bounds;
+      compiled.convertUVW(uvw.data(), uvwOut.data(), delays.data(), nRows, bounds);
+      CPPUNIT_ASSERT_EQUAL(nRows, size_t(bounds.nRow()));
+      // flipped machine negates u and v around the conversion
+      casacore::Vector<casacore::RigidVector<double, 3> > uvwFlipped(nRows);
+      casacore::Vector<double> delaysFlipped(nRows);
+      compiled.flippedUV().convertUVW(uvw.data(), uvwFlipped.data(), delaysFlipped.data(), nRows);
+      for (size_t row = 0; row < nRows; ++row) {
+           casacore::Vector<double> buf = uvw[row].vector();
+           double delay = 0.;
+           machine.convertUVW(delay, buf);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(delay, delays[row], 1e-6);
+           for (size_t dim = 0; dim < 3; ++dim) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(buf[dim], uvwOut[row](dim), 1e-6);
+                CPPUNIT_ASSERT(uvwOut[row](dim) >= (dim == 0 ? bounds.minU() : (dim == 1 ? bounds.minV() : bounds.minW())));
+                CPPUNIT_ASSERT(uvwOut[row](dim) <= (dim == 0 ? bounds.maxU() : (dim == 1 ? bounds.maxV() : bounds.maxW())));
+           }
+           buf = uvw[row].vector();
+           buf[0] *= -1.;
+           buf[1] *= -1.;
+           machine.convertUVW(delay, buf);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(delay, delaysFlipped[row], 1e-6);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(-buf[0], uvwFlipped[row](0), 1e-6);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(-buf[1], uvwFlipped[row](1), 1e-6);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(buf[2], uvwFlipped[row](2), 1e-6);
+      }
+   }
+
 private:   
    boost::shared_ptr<UVWMachineCache> itsMachineCache;
 };
@@ -37,6 +37,10 @@
 #include "DataAccessorAdapterTest.h"
 #include "CachedAccessorFieldTest.h"
 #include "TimeChunkIteratorAdapterTest.h"
+#include "PooledBufferManagerTest.h"
+#include "SyntheticDataSourceTest.h"
+#include "HighWaterStorageTest.h"
+#include "DDCalBufferDataAccessorTest.h"
 
 #include "TableTestRunner.h"
 
@@ -52,6 +56,10 @@ int main(int argc, char *argv[])
    runner.addTest(askap::accessors::DataAccessorAdapterTest::suite());
    runner.addTest(askap::accessors::CachedAccessorFieldTest::suite());
    runner.addTest(askap::accessors::TimeChunkIteratorAdapterTest::suite());
+   runner.addTest(askap::accessors::PooledBufferManagerTest::suite());
+   runner.addTest(askap::accessors::SyntheticDataSourceTest::suite());
+   runner.addTest(askap::accessors::HighWaterStorageTest::suite());
+   runner.addTest(askap::accessors::DDCalBufferDataAccessorTest::suite());
    runner.run();
    return 0;
  }
@@ -28,6 +28,10 @@
 /// @author Max Voronkov <maxim.voronkov@csiro.au>
 
 #include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/ImageCursor.h>
+#include <askap/imageaccess/AsyncImageWriter.h>
+#include <askap/imageaccess/CubeTransposer.h>
+#include <askap/imageaccess/ImageRegionLock.h>
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <casacore/casa/Arrays/Vector.h>
@@ -41,6 +45,9 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <vector>
+#include <sys/stat.h>
+
 #include <Common/ParameterSet.h>
 
 namespace askap {
@@ -52,6 +59,18 @@ class CasaImageAccessTest : public CppUnit::TestFixture
    CPPUNIT_TEST_SUITE(CasaImageAccessTest);
    CPPUNIT_TEST(testReadWrite);
    CPPUNIT_TEST(testWriteTable);
+   CPPUNIT_TEST(testHandleCache);
+   CPPUNIT_TEST(testCursor);
+   CPPUNIT_TEST(testReadInto);
+   CPPUNIT_TEST(testAsyncWrite);
+   CPPUNIT_TEST(testTranspose);
+   CPPUNIT_TEST(testCoordSysSlice);
+   CPPUNIT_TEST(testFastAlloc);
+   CPPUNIT_TEST(testAddInto);
+   CPPUNIT_TEST(testStridedRead);
+   CPPUNIT_TEST(testReadMany);
+   CPPUNIT_TEST(testMetadata);
+   CPPUNIT_TEST(testChannelBeam);
 //   CPPUNIT_TEST(testReadTable);
    CPPUNIT_TEST_SUITE_END();
 public:
@@ -158,6 +177,395 @@ public:
 
    }
 
+   void testHandleCache() {
+      // planes are written through the cached handle holding the user lock
+      CasaImageAccess<casacore::Float> accessor(casacore::TableLock::UserLocking, 1);
+      const std::string cachedName = "tmp.testcachedimage";
+      const casacore::IPosition shape(3,10,10,5);
+      accessor.create(cachedName, shape, makeCoords());
+      casacore::Array<float> plane(casacore::IPosition(3,10,10,1));
+      for (int chan = 0; chan < shape[2]; ++chan) {
+           plane.set(static_cast<float>(chan));
+           accessor.write(cachedName, plane, casacore::IPosition(3,0,0,chan));
+      }
+      accessor.setUnits(cachedName, "Jy/beam");
+      CPPUNIT_ASSERT(accessor.shape(cachedName) == shape);
+      accessor.flush();
+
+      // the changes should be visible to an independent accessor
+      CasaImageAccess<casacore::Float> other;
+      const casacore::Array<float> readBack = other.read(cachedName);
+      CPPUNIT_ASSERT(readBack.shape() == shape);
+      for (int chan = 0; chan < shape[2]; ++chan) {
+           CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,3,4,chan)) - chan) < 1e-7);
+      }
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), other.getUnits(cachedName));
+      other.close();
+      accessor.close(cachedName);
+      // closing an image which is not open is not an error
+      accessor.close(cachedName);
+   }
+
+   void testCursor() {
+      CasaImageAccess<casacore::Float> accessor;
+      const std::string cursorName = "tmp.testcursorimage";
+      const casacore::IPosition shape(3,10,10,5);
+      accessor.create(cursorName, shape, makeCoords());
+      casacore::Array<float> plane(casacore::IPosition(3,10,10,1));
+      for (int chan = 0; chan < shape[2]; ++chan) {
+           plane.set(static_cast<float>(chan));
+           accessor.write(cursorName, plane, casacore::IPosition(3,0,0,chan));
+      }
+      // planes with and without prefetch
+      for (int prefetch = 0; prefetch < 2; ++prefetch) {
+           ImageCursor<casacore::Float> planes(accessor, cursorName,
+                       ImageCursor<casacore::Float>::planeShape(shape), prefetch == 1);
+           casacore::Array<float> buffer;
+           int count = 0;
+           while (planes.next(buffer)) {
+                  CPPUNIT_ASSERT(buffer.shape() == casacore::IPosition(3,10,10,1));
+                  CPPUNIT_ASSERT_EQUAL(count, static_cast<int>(planes.blc()(2)));
+                  CPPUNIT_ASSERT(planes.trc() == casacore::IPosition(3,9,9,count));
+                  CPPUNIT_ASSERT(fabs(buffer(casacore::IPosition(3,5,7,0)) - count) < 1e-7);
+                  ++count;
+           }
+           CPPUNIT_ASSERT_EQUAL(5, count);
+           CPPUNIT_ASSERT(!planes.hasMore());
+      }
+      // spectra
+      ImageCursor<casacore::Float> spectra(accessor, cursorName, ImageCursor<casacore::Float>::spectrumShape(shape));
+      casacore::Array<float> spectrum;
+      int count = 0;
+      while (spectra.next(spectrum)) {
+             CPPUNIT_ASSERT(spectrum.shape() == casacore::IPosition(3,1,1,5));
+             CPPUNIT_ASSERT(fabs(spectrum(casacore::IPosition(3,0,0,3)) - 3.) < 1e-7);
+             ++count;
+      }
+      CPPUNIT_ASSERT_EQUAL(100, count);
+      // tiles which don't divide the image
+      ImageCursor<casacore::Float> tiles(accessor, cursorName, casacore::IPosition(3,4,4,5), false);
+      casacore::Array<float> tile;
+      count = 0;
+      while (tiles.next(tile)) {
+             CPPUNIT_ASSERT(tile.shape() == tiles.trc() - tiles.blc() + 1);
+             ++count;
+      }
+      CPPUNIT_ASSERT_EQUAL(9, count);
+   }
+
+   void testAsyncWrite() {
+      boost::shared_ptr<CasaImageAccess<casacore::Float> > accessor(new CasaImageAccess<casacore::Float>());
+      const std::string asyncName = "tmp.testasyncimage";
+      const casacore::IPosition shape(3,10,10,5);
+      accessor->create(asyncName, shape, makeCoords());
+      {
+        // budget of two planes, so some writes have to wait
+        AsyncImageWriter<casacore::Float> writer(accessor, 2 * 100 * sizeof(float));
+        casacore::Array<float> plane(casacore::IPosition(3,10,10,1));
+        for (int chan = 0; chan < shape[2]; ++chan) {
+             plane.set(static_cast<float>(chan));
+             if (chan % 2 == 0) {
+                 writer.write(asyncName, plane, casacore::IPosition(3,0,0,chan));
+             } else {
+                 writer.writeAdopt(asyncName, plane, casacore::IPosition(3,0,0,chan));
+                 CPPUNIT_ASSERT_EQUAL(size_t(0), plane.nelements());
+                 plane.resize(casacore::IPosition(3,10,10,1));
+             }
+             CPPUNIT_ASSERT(writer.pendingBytes() <= 2 * 100 * sizeof(float));
+        }
+        writer.flush();
+        CPPUNIT_ASSERT_EQUAL(size_t(0), writer.pendingWrites());
+        CPPUNIT_ASSERT_EQUAL(size_t(0), writer.pendingBytes());
+        // errors are reported by flush, the writer is usable afterwards
+        writer.write(asyncName, plane, casacore::IPosition(3,0,0,shape[2]));
+        CPPUNIT_ASSERT_THROW(writer.flush(), std::exception);
+        writer.flush();
+      }
+      accessor->close(asyncName);
+      for (int chan = 0; chan < shape[2]; ++chan) {
+           const casacore::Array<float> plane = accessor->read(asyncName, casacore::IPosition(3,0,0,chan),
+                                                casacore::IPosition(3,9,9,chan));
+           CPPUNIT_ASSERT(fabs(plane(casacore::IPosition(3,3,4,0)) - chan) < 1e-7);
+      }
+   }
+
+   void testTranspose() {
+      boost::shared_ptr<CasaImageAccess<casacore::Float> > input(new CasaImageAccess<casacore::Float>());
+      boost::shared_ptr<CasaImageAccess<casacore::Float> > output(new CasaImageAccess<casacore::Float>());
+      const std::string inName = "tmp.testtransposein";
+      const std::string outName = "tmp.testtransposeout";
+      const casacore::IPosition shape(3,6,7,5);
+      input->create(inName, shape, makeCoords());
+      casacore::Array<float> arr(shape);
+      for (int chan = 0; chan < shape[2]; ++chan) {
+           for (int y = 0; y < shape[1]; ++y) {
+                for (int x = 0; x < shape[0]; ++x) {
+                     arr(casacore::IPosition(3,x,y,chan)) = x + 10 * y + 100 * chan;
+                }
+           }
+      }
+      input->write(inName, arr);
+      input->setUnits(inName, "Jy/beam");
+      input->close(inName);
+
+      CubeTransposer transposer(input, output);
+      // 2 rows of all planes per block, so the last block is incomplete
+      transposer.setMaxBlockSize(2 * 6 * 5);
+      CPPUNIT_ASSERT_EQUAL(size_t(4), transposer.nBlocks(inName));
+      CPPUNIT_ASSERT(transposer.axisOrder(inName) == casacore::IPosition(3,2,0,1));
+      transposer.createOutput(inName, outName);
+      transposer.transpose(inName, outName);
+      transposer.copyMetadata(inName, outName);
+      output->close(outName);
+
+      CPPUNIT_ASSERT(output->shape(outName) == casacore::IPosition(3,5,6,7));
+      CPPUNIT_ASSERT_EQUAL(0u, CubeTransposer::spectralAxis(output->coordSys(outName)));
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), output->getUnits(outName));
+      // a spectrum is a single row of the output
+      const casacore::Array<float> spectrum = output->read(outName, casacore::IPosition(3,0,4,6),
+                                              casacore::IPosition(3,4,4,6));
+      for (int chan = 0; chan < shape[2]; ++chan) {
+           CPPUNIT_ASSERT(fabs(spectrum(casacore::IPosition(3,chan,0,0)) - 64. - 100. * chan) < 1e-7);
+      }
+
+      // the axis order is kept if the spectral tiling is done by the output accessor
+      const std::string tiledName = "tmp.testtransposetiled";
+      output->setAccessPattern(CasaImageAccess<casacore::Float>::SPECTRUM_MAJOR);
+      transposer.setSpectrumFirst(false);
+      transposer.createOutput(inName, tiledName);
+      transposer.transpose(inName, tiledName);
+      output->close(tiledName);
+      CPPUNIT_ASSERT(output->shape(tiledName) == shape);
+      CPPUNIT_ASSERT(fabs(output->read(tiledName)(casacore::IPosition(3,5,6,4)) - 465.) < 1e-7);
+      // different objects are needed to read and write
+      CPPUNIT_ASSERT_THROW(boost::shared_ptr<CubeTransposer>(new CubeTransposer(input, input)), askap::AskapError);
+   }
+
+   void testFastAlloc() {
+      CasaImageAccess<casacore::Float> accessor;
+      accessor.useFastAlloc(true);
+      accessor.setTileShape(casacore::IPosition(3,8,8,1));
+      const std::string fastName = "tmp.testfastallocimage";
+      const casacore::IPosition shape(3,20,10,3);
+      accessor.create(fastName, shape, makeCoords());
+      // 3 x 2 x 3 tiles of 64 pixels each
+      struct stat st;
+      CPPUNIT_ASSERT_EQUAL(0, stat((fastName + "/table.f0_TSM0").c_str(), &st));
+      CPPUNIT_ASSERT(st.st_size >= static_cast<off_t>(18 * 64 * sizeof(casacore::Float)));
+      // the image behaves as usual
+      casacore::Array<float> plane(casacore::IPosition(3,20,10,1), 2.f);
+      accessor.write(fastName, plane, casacore::IPosition(3,0,0,1));
+      accessor.close(fastName);
+      const casacore::Array<float> readBack = accessor.read(fastName);
+      CPPUNIT_ASSERT(readBack.shape() == shape);
+      CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,19,9,1)) - 2.) < 1e-7);
+      CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(3,5,5,2))) < 1e-7);
+   }
+
+   void testAddInto() {
+      CasaImageAccess<casacore::Float> accessor;
+      const std::string addName = "tmp.testaddintoimage";
+      const casacore::IPosition shape(3,10,10,2);
+      accessor.create(addName, shape, makeCoords());
+      accessor.write(addName, casacore::Array<float>(shape, 0.f));
+      const casacore::Array<float> block(casacore::IPosition(3,10,5,2), 1.5f);
+      for (int repeat = 0; repeat < 2; ++repeat) {
+           accessor.addInto(addName, block, casacore::IPosition(3,0,repeat * 3,0));
+      }
+      const casacore::Array<float> result = accessor.read(addName);
+      CPPUNIT_ASSERT(fabs(result(casacore::IPosition(3,2,1,1)) - 1.5) < 1e-7);
+      CPPUNIT_ASSERT(fabs(result(casacore::IPosition(3,2,4,1)) - 3.) < 1e-7);
+      CPPUNIT_ASSERT(fabs(result(casacore::IPosition(3,2,9,0))) < 1e-7);
+      // the region lock can be taken only once by the same object
+      ImageRegionLock lock(ImageRegionLock::lockFileName(addName));
+      lock.lock(shape, casacore::IPosition(3,0,0,0), casacore::IPosition(3,9,9,0));
+      CPPUNIT_ASSERT(lock.isLocked());
+      CPPUNIT_ASSERT_THROW(lock.lock(shape, casacore::IPosition(3,0,0,1), casacore::IPosition(3,9,9,1)),
+                           askap::AskapError);
+      lock.unlock();
+      CPPUNIT_ASSERT(!lock.isLocked());
+   }
+
+   void testStridedRead() {
+      CasaImageAccess<casacore::Float> accessor;
+      const std::string stridedName = "tmp.teststridedimage";
+      const casacore::IPosition shape(3,20,15,1);
+      accessor.create(stridedName, shape, makeCoords());
+      casacore::Array<float> arr(shape);
+      for (int y = 0; y < shape[1]; ++y) {
+           for (int x = 0; x < shape[0]; ++x) {
+                arr(casacore::IPosition(3,x,y,0)) = x + 100 * y;
+           }
+      }
+      accessor.write(stridedName, arr);
+      const casacore::Array<float> strided = accessor.read(stridedName, casacore::IPosition(3,0,0,0), shape - 1,
+                                             casacore::IPosition(3,5,7,1));
+      CPPUNIT_ASSERT(strided.shape() == casacore::IPosition(3,4,3,1));
+      CPPUNIT_ASSERT(fabs(strided(casacore::IPosition(3,3,2,0)) - 1415.) < 1e-7);
+      const casacore::Array<float> averaged = accessor.readAveraged(stridedName, casacore::IPosition(3,0,0,0),
+                                              shape - 1, casacore::IPosition(3,10,5,1));
+      CPPUNIT_ASSERT(averaged.shape() == casacore::IPosition(3,2,3,1));
+      CPPUNIT_ASSERT(fabs(averaged(casacore::IPosition(3,1,2,0)) - 1214.5) < 1e-4);
+   }
+
+   void testReadMany() {
+      CasaImageAccess<casacore::Float> accessor;
+      const std::string manyName = "tmp.testreadmanyimage";
+      const casacore::IPosition shape(3,20,15,1);
+      accessor.create(manyName, shape, makeCoords());
+      casacore::Array<float> arr(shape);
+      for (int y = 0; y < shape[1]; ++y) {
+           for (int x = 0; x < shape[0]; ++x) {
+                arr(casacore::IPosition(3,x,y,0)) = x + 100 * y;
+           }
+      }
+      accessor.write(manyName, arr);
+      // two overlapping cutouts, an adjacent one and a distant one
+      std::vector<PixelRegion> regions;
+      regions.push_back(PixelRegion(casacore::IPosition(3,0,0,0), casacore::IPosition(3,4,4,0)));
+      regions.push_back(PixelRegion(casacore::IPosition(3,3,3,0), casacore::IPosition(3,6,5,0)));
+      regions.push_back(PixelRegion(casacore::IPosition(3,7,0,0), casacore::IPosition(3,8,1,0)));
+      regions.push_back(PixelRegion(casacore::IPosition(3,15,12,0), casacore::IPosition(3,19,14,0)));
+      CPPUNIT_ASSERT_EQUAL(size_t(2), RegionCoalescer::coalesce(regions).size());
+      const std::vector<casacore::Array<float> > cutouts = accessor.readMany(manyName, regions);
+      CPPUNIT_ASSERT_EQUAL(regions.size(), cutouts.size());
+      for (size_t index = 0; index < regions.size(); ++index) {
+           const casacore::IPosition &blc = regions[index].first;
+           const casacore::IPosition &trc = regions[index].second;
+           CPPUNIT_ASSERT(cutouts[index].shape() == trc - blc + 1);
+           for (int y = blc[1]; y <= trc[1]; ++y) {
+                for (int x = blc[0]; x <= trc[0]; ++x) {
+                     CPPUNIT_ASSERT(fabs(cutouts[index](casacore::IPosition(3,x - blc[0],y - blc[1],0)) -
+                                         (x + 100 * y)) < 1e-7);
+                }
+           }
+      }
+      // the cutouts don't share the pixels
+      std::vector<casacore::Array<float> > copies = accessor.readMany(manyName, regions);
+      copies[1].set(-1.);
+      CPPUNIT_ASSERT(fabs(copies[0](casacore::IPosition(3,4,4,0)) - 404.) < 1e-7);
+      // a gap of one pixel merges all but the distant cutout, the limit on the size keeps them apart
+      CPPUNIT_ASSERT_EQUAL(size_t(2), RegionCoalescer::coalesce(regions, 1).size());
+      CPPUNIT_ASSERT_EQUAL(size_t(4), RegionCoalescer::coalesce(regions, 0, 25).size());
+   }
+
+   void testMetadata() {
+      CasaImageAccess<casacore::Float> accessor;
+      const std::string mdName = "tmp.testmetadataimage";
+      const casacore::IPosition shape(3,10,10,2);
+      accessor.create(mdName, shape, makeCoords());
+      accessor.setUnits(mdName, "Jy/beam");
+      accessor.setBeamInfo(mdName, 1e-4, 5e-5, 0.1);
+      accessor.setMetadataKeyword(mdName, "TESTKW", "test value", "test keyword");
+      const boost::shared_ptr<const ImageMetadata> md = accessor.metadata(mdName);
+      CPPUNIT_ASSERT(md);
+      CPPUNIT_ASSERT(md->itsShape == shape);
+      CPPUNIT_ASSERT(!md->itsMasked);
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), md->itsUnits);
+      CPPUNIT_ASSERT_EQUAL(2u, md->itsCoordSys.nCoordinates());
+      CPPUNIT_ASSERT_EQUAL(3u, md->itsBeam.nelements());
+      CPPUNIT_ASSERT(fabs(md->itsBeam[1].getValue("rad") - 5e-5) < 1e-9);
+      CPPUNIT_ASSERT_EQUAL(std::string("test value"), md->keyword("TESTKW").first);
+      CPPUNIT_ASSERT_EQUAL(std::string("test keyword"), md->keyword("TESTKW").second);
+      // cached until the image is modified
+      CPPUNIT_ASSERT(accessor.metadata(mdName) == md);
+      accessor.makeDefaultMask(mdName);
+      CPPUNIT_ASSERT(accessor.isMasked(mdName));
+      CPPUNIT_ASSERT(accessor.metadata(mdName) != md);
+   }
+
+   void testChannelBeam() {
+      CasaImageAccess<casacore::Float> accessor;
+      const std::string beamName = "tmp.testchannelbeamimage";
+      accessor.create(beamName, casacore::IPosition(3,10,10,5), makeCoords());
+      accessor.setBeamInfo(beamName, 1e-4, 5e-5, 0.1);
+      CPPUNIT_ASSERT(fabs(accessor.channelBeam(beamName, 2)[0].getValue("rad") - 1e-4) < 1e-9);
+      BeamList beamlist;
+      for (unsigned int chan = 0; chan < 5; ++chan) {
+           casacore::Vector<casacore::Quantum<double> > currentbeam(3);
+           currentbeam[0] = casacore::Quantum<double>(10 + chan * 0.1, "arcsec");
+           currentbeam[1] = casacore::Quantum<double>(5 + chan * 0.1, "arcsec");
+           currentbeam[2] = casacore::Quantum<double>(12. + chan, "deg");
+           beamlist[chan] = currentbeam;
+      }
+      accessor.setBeamInfo(beamName, beamlist);
+      for (unsigned int chan = 0; chan < 5; ++chan) {
+           CPPUNIT_ASSERT(fabs(accessor.channelBeam(beamName, chan)[1].getValue("arcsec") - (5 + chan * 0.1)) < 1e-6);
+      }
+   }
+
+   void testCoordSysSlice() {
+      CasaImageAccess<casacore::Float> accessor;
+      const std::string sliceName = "tmp.testcoordsysslice";
+      const casacore::IPosition shape(3,10,10,5);
+      accessor.create(sliceName, shape, makeCoords());
+      const casacore::CoordinateSystem full = accessor.coordSys(sliceName);
+      const casacore::IPosition blc(3,2,3,1);
+      const casacore::IPosition trc(3,5,6,3);
+      const casacore::CoordinateSystem slice = accessor.coordSysSlice(sliceName, blc, trc);
+      CPPUNIT_ASSERT_EQUAL(full.nPixelAxes(), slice.nPixelAxes());
+      const casacore::Vector<casacore::Double> fullRef = full.referencePixel();
+      const casacore::Vector<casacore::Double> sliceRef = slice.referencePixel();
+      for (casacore::uInt axis = 0; axis < 3; ++axis) {
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(fullRef[axis] - blc[axis], sliceRef[axis], 1e-10);
+      }
+      // the corner of the slice has the world coordinates of blc
+      casacore::Vector<casacore::Double> fullWorld, sliceWorld;
+      casacore::Vector<casacore::Double> pixel(3);
+      for (casacore::uInt axis = 0; axis < 3; ++axis) {
+           pixel[axis] = blc[axis];
+      }
+      CPPUNIT_ASSERT(full.toWorld(fullWorld, pixel));
+      pixel = 0.;
+      CPPUNIT_ASSERT(slice.toWorld(sliceWorld, pixel));
+      for (casacore::uInt axis = 0; axis < 3; ++axis) {
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(fullWorld[axis], sliceWorld[axis], 1e-10);
+      }
+      // selection outside the image is rejected
+      CPPUNIT_ASSERT_THROW(accessor.coordSysSlice(sliceName, blc, casacore::IPosition(3,5,10,3)), askap::AskapError);
+   }
+
+   void testReadInto() {
+      CasaImageAccess<casacore::Float> accessor;
+      const std::string intoName = "tmp.testreadintoimage";
+      const casacore::IPosition shape(3,10,10,2);
+      accessor.create(intoName, shape, makeCoords());
+      casacore::Array<float> arr(shape);
+      for (int y = 0; y < shape[1]; ++y) {
+           for (int x = 0; x < shape[0]; ++x) {
+                arr(casacore::IPosition(3,x,y,0)) = x + 10 * y;
+                arr(casacore::IPosition(3,x,y,1)) = -x - 10 * y;
+           }
+      }
+      accessor.write(intoName, arr);
+      // the buffer of the right shape is reused
+      casacore::Array<float> buffer(casacore::IPosition(3,4,4,1));
+      const float *storage = buffer.data();
+      accessor.readInto(intoName, casacore::IPosition(3,2,3,1), casacore::IPosition(3,5,6,1), buffer);
+      CPPUNIT_ASSERT(buffer.data() == storage);
+      CPPUNIT_ASSERT(fabs(buffer(casacore::IPosition(3,1,2,0)) + 53.) < 1e-7);
+      // raw memory
+      std::vector<float> raw(10);
+      accessor.readIntoStorage(intoName, casacore::IPosition(3,0,4,0), casacore::IPosition(3,9,4,0), raw.data());
+      for (int x = 0; x < 10; ++x) {
+           CPPUNIT_ASSERT(fabs(raw[x] - 40. - x) < 1e-7);
+      }
+      // masking is applied in place
+      accessor.makeDefaultMask(intoName);
+      casacore::LogicalArray mask(casacore::IPosition(3,10,10,1), true);
+      mask(casacore::IPosition(3,2,3,0)) = false;
+      accessor.writeMask(intoName, mask, casacore::IPosition(3,0,0,0));
+      casacore::LogicalArray maskBuffer;
+      accessor.readMaskInto(intoName, casacore::IPosition(3,2,3,0), casacore::IPosition(3,3,3,0), maskBuffer);
+      CPPUNIT_ASSERT(maskBuffer.shape() == casacore::IPosition(3,2,1,1));
+      CPPUNIT_ASSERT(!maskBuffer(casacore::IPosition(3,0,0,0)));
+      CPPUNIT_ASSERT(maskBuffer(casacore::IPosition(3,1,0,0)));
+      casacore::Array<float> plane;
+      accessor.readInto(intoName, casacore::IPosition(3,0,0,0), casacore::IPosition(3,9,9,0), plane);
+      CPPUNIT_ASSERT(fabs(plane(casacore::IPosition(3,2,3,0))) < 1e-7);
+      CPPUNIT_ASSERT(fabs(plane(casacore::IPosition(3,3,3,0)) - 33.) < 1e-7);
+   }
+
 protected:
 
    casacore::CoordinateSystem makeCoords() {
@@ -28,11 +28,22 @@
 /// @author Steve Ord <stephen.ord@csiro.au>
 
 #include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/FitsImageAccess.h>
+#include <askap/imageaccess/FitsMappedImage.h>
+#include <askap/imageaccess/FitsPixelConversion.h>
+#include <askap/imageaccess/SharedImageReader.h>
+#include <askap/imageaccess/ImageStatistics.h>
+#include <askap/imageaccess/FitsChecksum.h>
+#include <askap/imageaccess/FitsTableConverter.h>
+#include <askap/votable/VOTable.h>
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/IO/ArrayIO.h>
 
 #include <casacore/coordinates/Coordinates/LinearCoordinate.h>
@@ -45,11 +56,22 @@
 
 
 #include <boost/shared_ptr.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <fitsio.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include <Common/ParameterSet.h>
 
 #include "askap_accessors.h"
 #include <askap/askap/AskapLogging.h>
+#include <askap/askap/AskapError.h>
 
 
 
@@ -66,7 +88,44 @@ class FitsImageAccessTest : public CppUnit::TestFixture
    CPPUNIT_TEST(testReadWrite2);
    CPPUNIT_TEST(testAddHistory);
    CPPUNIT_TEST(testCreateFitsBinaryTable);
+   CPPUNIT_TEST(testHandleCache);
+   CPPUNIT_TEST(testHeaderUpdate);
+   CPPUNIT_TEST(testCompressedWrite);
+   CPPUNIT_TEST(testBlockWrite);
+   CPPUNIT_TEST(testMemoryMap);
+   CPPUNIT_TEST(testSharedReader);
+   CPPUNIT_TEST(testPixelConversion);
+   CPPUNIT_TEST(testIntegerImage);
+   CPPUNIT_TEST(testDoublePrecision);
+   CPPUNIT_TEST(testPackedMask);
+   CPPUNIT_TEST(testChecksum);
+   CPPUNIT_TEST(testIncrementalChecksum);
+   CPPUNIT_TEST(testLargeBinaryTable);
+   CPPUNIT_TEST(testStatistics);
+   CPPUNIT_TEST(testAddInto);
+   CPPUNIT_TEST(testStridedRead);
+   CPPUNIT_TEST(testMetadata);
+   CPPUNIT_TEST(testChannelBeam);
+   CPPUNIT_TEST(testTableToVOTable);
    CPPUNIT_TEST_SUITE_END();
+
+   /// @brief read cutouts of the image written by testSharedReader and count wrong pixels
+   static void readCutouts(const SharedImageReader &reader, const std::string &name, int offset, int &errors) {
+        casacore::Array<float> buffer;
+        for (int cutout = 0; cutout < 50; ++cutout) {
+             const int x0 = (cutout + offset) % 15;
+             const int y0 = (cutout * 3 + offset) % 10;
+             const int z = (cutout + offset) % 4;
+             reader.readInto(name, casacore::IPosition(3,x0,y0,z), casacore::IPosition(3,x0 + 4,y0 + 4,z), buffer);
+             for (int y = 0; y < 5; ++y) {
+                  for (int x = 0; x < 5; ++x) {
+                       if (buffer(casacore::IPosition(3,x,y,0)) != float(x0 + x + 100 * (y0 + y) + 10000 * z)) {
+                           ++errors;
+                       }
+                  }
+             }
+        }
+   }
 public:
     void setUp() {
         LOFAR::ParameterSet parset;
@@ -396,6 +455,757 @@ public:
         }
    }
 
+   void testHandleCache() {
+        const std::string name = "tmpfitsimage_cache";
+        CPPUNIT_ASSERT(itsImageAccessor);
+        const casacore::IPosition shape(2,10,12);
+        itsImageAccessor->create(name, shape, makeCoords());
+        // write row by row through the same open file
+        for (int y = 0; y < shape[1]; ++y) {
+             casacore::Array<float> row(casacore::IPosition(2,shape[0],1));
+             row.set(float(y));
+             itsImageAccessor->write(name, row, casacore::IPosition(2,0,y));
+        }
+        CPPUNIT_ASSERT(itsImageAccessor->shape(name) == shape);
+        itsImageAccessor->setUnits(name, "Jy/beam");
+        itsImageAccessor->setMetadataKeyword(name, "TESTKW", "test value", "test keyword");
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), itsImageAccessor->getUnits(name));
+        CPPUNIT_ASSERT_EQUAL(std::string("test value"), itsImageAccessor->getMetadataKeyword(name, "TESTKW").first);
+        // pixels written before the header update should be read back
+        casacore::Array<float> readBack = itsImageAccessor->read(name);
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        for (int x = 0; x < shape[0]; ++x) {
+             for (int y = 0; y < shape[1]; ++y) {
+                  CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(2,x,y)) - float(y)) < 1e-7);
+             }
+        }
+        // the same row is overwritten, the cached header should not hide the change
+        casacore::Array<float> row(casacore::IPosition(2,shape[0],1));
+        row.set(-1.);
+        itsImageAccessor->write(name, row, casacore::IPosition(2,0,3));
+        readBack = itsImageAccessor->read(name, casacore::IPosition(2,0,3), casacore::IPosition(2,shape[0]-1,3));
+        CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(2,0,0)) + 1.) < 1e-7);
+
+        // replace the file by another accessor, the cached handles and header should be dropped
+        {
+          LOFAR::ParameterSet parset;
+          parset.add("imagetype","fits");
+          boost::shared_ptr<IImageAccess<casacore::Float> > other = imageAccessFactory(parset);
+          CPPUNIT_ASSERT(other);
+          const casacore::IPosition shape2(2,8,6);
+          other->create(name, shape2, makeCoords());
+          casacore::Array<float> arr(shape2);
+          arr.set(5.);
+          other->write(name, arr);
+        }
+        CPPUNIT_ASSERT(itsImageAccessor->shape(name) == casacore::IPosition(2,8,6));
+        readBack = itsImageAccessor->read(name);
+        CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(2,7,5)) - 5.) < 1e-7);
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy"), itsImageAccessor->getUnits(name));
+
+        // explicit flush releases the handles, they are reopened on demand
+        boost::shared_ptr<FitsImageAccess> fitsAccessor = boost::dynamic_pointer_cast<FitsImageAccess>(itsImageAccessor);
+        CPPUNIT_ASSERT(fitsAccessor);
+        fitsAccessor->flush();
+        CPPUNIT_ASSERT(itsImageAccessor->shape(name) == casacore::IPosition(2,8,6));
+   }
+
+   void testHeaderUpdate() {
+        const std::string name = "tmpfitsimage_hdr";
+        LOFAR::ParameterSet parset;
+        parset.add("imagetype","fits");
+        parset.add("imagereservedkeywords","100");
+        boost::shared_ptr<IImageAccess<casacore::Float> > accessor = imageAccessFactory(parset);
+        CPPUNIT_ASSERT(accessor);
+        const casacore::IPosition shape(2,10,12);
+        accessor->create(name, shape, makeCoords());
+        casacore::Array<float> arr(shape);
+        arr.set(1.);
+        accessor->write(name, arr);
+        boost::shared_ptr<FitsImageAccess> fitsAccessor = boost::dynamic_pointer_cast<FitsImageAccess>(accessor);
+        CPPUNIT_ASSERT(fitsAccessor);
+        fitsAccessor->flush();
+        const FitsFileStamp before(name + ".fits");
+        CPPUNIT_ASSERT(before.valid());
+
+        LOFAR::ParameterSet keywords;
+        for (int i = 0; i < 60; ++i) {
+             std::ostringstream os;
+             os << "TESTKW" << i;
+             keywords.add(os.str(), "[\"value\", \"test keyword\"]");
+        }
+        keywords.add("TESTINT", "[\"42\", \"integer keyword\", \"INT\"]");
+        accessor->beginHeaderUpdate(name);
+        accessor->setMetadataKeywords(name, keywords);
+        accessor->setUnits(name, "Jy/beam");
+        accessor->setBeamInfo(name, 1e-4, 5e-5, 0.1);
+        accessor->addHistory(name, std::vector<std::string>(3, "test history"));
+        // staged changes are not visible before the commit
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy"), accessor->getUnits(name));
+        CPPUNIT_ASSERT_EQUAL(std::string(""), accessor->getMetadataKeyword(name, "TESTKW0").first);
+        accessor->commitHeaderUpdate(name);
+
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), accessor->getUnits(name));
+        CPPUNIT_ASSERT_EQUAL(std::string("value"), accessor->getMetadataKeyword(name, "TESTKW59").first);
+        CPPUNIT_ASSERT_EQUAL(std::string("42"), accessor->getMetadataKeyword(name, "TESTINT").first);
+        const casacore::Vector<casacore::Quantum<double> > beam = accessor->beamInfo(name);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), beam.nelements());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1e-4, beam[0].getValue("rad"), 1e-10);
+        casacore::Array<float> readBack = accessor->read(name);
+        CPPUNIT_ASSERT(fabs(readBack(casacore::IPosition(2,9,11)) - 1.) < 1e-7);
+        fitsAccessor->flush();
+        // the reserved space was enough, so the header hasn't been extended
+        const FitsFileStamp after(name + ".fits");
+        CPPUNIT_ASSERT(after.valid());
+        CPPUNIT_ASSERT_EQUAL(before.itsSize, after.itsSize);
+   }
+
+   void testCompressedWrite() {
+        const std::string name = "tmpfitsimage_compressed";
+        LOFAR::ParameterSet parset;
+        parset.add("imagetype","fits");
+        // lossless, so the pixels can be compared exactly
+        parset.add("imagecompress","gzip2");
+        parset.add("imagecompress.quantize","0");
+        boost::shared_ptr<IImageAccess<casacore::Float> > accessor = imageAccessFactory(parset);
+        CPPUNIT_ASSERT(accessor);
+        const casacore::IPosition shape(3,10,12,4);
+        casacore::CoordinateSystem coordsys = makeCoords();
+        casacore::Vector<casacore::Double> refPix(1,0.), refVal(1,1.4e9), inc(1,1e6);
+        casacore::Matrix<casacore::Double> xform(1,1,1.);
+        casacore::Vector<casacore::String> axisName(1,"freq"), axisUnit(1,"Hz");
+        coordsys.addCoordinate(casacore::LinearCoordinate(axisName, axisUnit, refVal, inc, xform, refPix));
+        accessor->create(name, shape, coordsys);
+        // one plane per tile by default, write plane by plane
+        for (int plane = 0; plane < shape[2]; ++plane) {
+             casacore::Array<float> arr(casacore::IPosition(2,shape[0],shape[1]));
+             for (int x = 0; x < shape[0]; ++x) {
+                  for (int y = 0; y < shape[1]; ++y) {
+                       arr(casacore::IPosition(2,x,y)) = float(x + 100 * y + 10000 * plane);
+                  }
+             }
+             accessor->write(name, arr, casacore::IPosition(3,0,0,plane));
+        }
+        // half a plane doesn't cover whole tiles
+        casacore::Array<float> half(casacore::IPosition(2,shape[0]/2,shape[1]), 0.f);
+        CPPUNIT_ASSERT_THROW(accessor->write(name, half, casacore::IPosition(3,0,0,1)), askap::AskapError);
+
+        accessor->setMetadataKeyword(name, "TESTKW", "compressed", "test keyword");
+        CPPUNIT_ASSERT_EQUAL(std::string("compressed"), accessor->getMetadataKeyword(name, "TESTKW").first);
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy"), accessor->getUnits(name));
+        CPPUNIT_ASSERT(accessor->shape(name) == shape);
+        const casacore::Array<float> readBack = accessor->read(name);
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        for (int plane = 0; plane < shape[2]; ++plane) {
+             for (int x = 0; x < shape[0]; ++x) {
+                  for (int y = 0; y < shape[1]; ++y) {
+                       CPPUNIT_ASSERT_EQUAL(float(x + 100 * y + 10000 * plane),
+                                            readBack(casacore::IPosition(3,x,y,plane)));
+                  }
+             }
+        }
+        const casacore::Array<float> slice = accessor->read(name, casacore::IPosition(3,2,3,2),
+                                                            casacore::IPosition(3,4,3,3));
+        CPPUNIT_ASSERT(slice.shape() == casacore::IPosition(3,3,1,2));
+        CPPUNIT_ASSERT_EQUAL(float(4 + 300 + 30000), slice(casacore::IPosition(3,2,0,1)));
+   }
+
+   void testBlockWrite() {
+        const std::string name = "tmpfitsimage_block";
+        CPPUNIT_ASSERT(itsImageAccessor);
+        const casacore::IPosition shape(4,6,5,3,4);
+        casacore::CoordinateSystem coordsys = makeCoords();
+        casacore::Vector<casacore::Double> refPix(2,0.), refVal(2,1.), inc(2,1.);
+        casacore::Matrix<casacore::Double> xform(2,2,0.);
+        xform.diagonal() = 1.;
+        casacore::Vector<casacore::String> axisName(2,"aux"), axisUnit(2,"");
+        coordsys.addCoordinate(casacore::LinearCoordinate(axisName, axisUnit, refVal, inc, xform, refPix));
+        itsImageAccessor->create(name, shape, coordsys);
+        casacore::Array<float> zeros(shape, 0.f);
+        itsImageAccessor->write(name, zeros);
+        // whole planes along the third axis are contiguous in the file
+        casacore::Array<float> planes(casacore::IPosition(4,6,5,3,1), 1.f);
+        itsImageAccessor->write(name, planes, casacore::IPosition(4,0,0,0,2));
+        // spectral block covering a few pixels and all channels along the last axis
+        casacore::Array<float> block(casacore::IPosition(4,2,3,1,4));
+        for (int chan = 0; chan < shape[3]; ++chan) {
+             for (int y = 0; y < 3; ++y) {
+                  for (int x = 0; x < 2; ++x) {
+                       block(casacore::IPosition(4,x,y,0,chan)) = float(10 + x + 10 * y + 100 * chan);
+                  }
+             }
+        }
+        itsImageAccessor->write(name, block, casacore::IPosition(4,1,1,1,0));
+        // the block outside of the image is rejected
+        CPPUNIT_ASSERT_THROW(itsImageAccessor->write(name, block, casacore::IPosition(4,5,1,1,0)), askap::AskapError);
+
+        const casacore::Array<float> readBack = itsImageAccessor->read(name);
+        CPPUNIT_ASSERT(readBack.shape() == shape);
+        for (int chan = 0; chan < shape[3]; ++chan) {
+             for (int z = 0; z < shape[2]; ++z) {
+                  for (int y = 0; y < shape[1]; ++y) {
+                       for (int x = 0; x < shape[0]; ++x) {
+                            const bool inBlock = (z == 1) && (x >= 1) && (x <= 2) && (y >= 1) && (y <= 3);
+                            const float expected = inBlock ? float(10 + (x - 1) + 10 * (y - 1) + 100 * chan) :
+                                                   (chan == 2 ? 1.f : 0.f);
+                            CPPUNIT_ASSERT_EQUAL(expected, readBack(casacore::IPosition(4,x,y,z,chan)));
+                       }
+                  }
+             }
+        }
+   }
+
+   void testMemoryMap() {
+        const std::string name = "tmpfitsimage_mapped";
+        const casacore::IPosition shape(3,20,15,4);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        casacore::Array<float> arr(shape);
+        for (int z = 0; z < shape[2]; ++z) {
+             for (int y = 0; y < shape[1]; ++y) {
+                  for (int x = 0; x < shape[0]; ++x) {
+                       arr(casacore::IPosition(3,x,y,z)) = float(x + 100 * y + 10000 * z);
+                  }
+             }
+        }
+        accessor.write(name, arr);
+        accessor.flush();
+
+        FitsMappedImage mapped(name + ".fits");
+        CPPUNIT_ASSERT(mapped.isMapped());
+        CPPUNIT_ASSERT(mapped.shape() == shape);
+        // postage stamp through the map and through cfitsio
+        const casacore::IPosition blc(3,3,4,1), trc(3,9,7,2);
+        casacore::Array<float> stamp;
+        mapped.read(blc, trc, stamp);
+        CPPUNIT_ASSERT(stamp.shape() == casacore::IPosition(3,7,4,2));
+        CPPUNIT_ASSERT_EQUAL(float(5 + 100 * 6 + 10000 * 2), stamp(casacore::IPosition(3,2,2,1)));
+        CPPUNIT_ASSERT_THROW(mapped.read(blc, casacore::IPosition(3,20,7,2), stamp), askap::AskapError);
+        const casacore::Array<float> viaMap = accessor.read(name, blc, trc);
+        accessor.useMemoryMap(false);
+        const casacore::Array<float> viaCfitsio = accessor.read(name, blc, trc);
+        CPPUNIT_ASSERT(casacore::allEQ(viaMap, viaCfitsio));
+        CPPUNIT_ASSERT(casacore::allEQ(viaMap, stamp));
+        // the map is refreshed after the image is modified
+        accessor.useMemoryMap(true);
+        casacore::Array<float> plane(casacore::IPosition(3,20,15,1), -1.f);
+        accessor.write(name, plane, casacore::IPosition(3,0,0,2));
+        const casacore::Array<float> modified = accessor.read(name, blc, trc);
+        CPPUNIT_ASSERT_EQUAL(-1.f, modified(casacore::IPosition(3,2,2,1)));
+        CPPUNIT_ASSERT_EQUAL(float(5 + 100 * 6 + 10000), modified(casacore::IPosition(3,2,2,0)));
+   }
+
+   void testSharedReader() {
+        const std::string name = "tmpfitsimage_shared";
+        const casacore::IPosition shape(3,20,15,4);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        casacore::Array<float> arr(shape);
+        for (int z = 0; z < shape[2]; ++z) {
+             for (int y = 0; y < shape[1]; ++y) {
+                  for (int x = 0; x < shape[0]; ++x) {
+                       arr(casacore::IPosition(3,x,y,z)) = float(x + 100 * y + 10000 * z);
+                  }
+             }
+        }
+        accessor.write(name, arr);
+        accessor.flush();
+
+        // through the shared map and through the pool of accessors
+        for (int useMap = 0; useMap < 2; ++useMap) {
+             LOFAR::ParameterSet parset;
+             parset.add("imagetype", "fits");
+             parset.add("imagememorymap", useMap ? "true" : "false");
+             SharedImageReader reader(parset);
+             CPPUNIT_ASSERT(reader.shape(name) == shape);
+             const casacore::CoordinateSystem slice = reader.coordSysSlice(name, casacore::IPosition(3,3,4,1),
+                                                                           casacore::IPosition(3,9,7,2));
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(reader.coordSys(name).referencePixel()[0] - 3., slice.referencePixel()[0], 1e-10);
+             const size_t nThreads = 4;
+             std::vector<int> errors(nThreads, 0);
+             boost::thread_group threads;
+             for (size_t thread = 0; thread < nThreads; ++thread) {
+                  threads.create_thread(boost::bind(&FitsImageAccessTest::readCutouts, boost::cref(reader), name,
+                                                    static_cast<int>(thread), boost::ref(errors[thread])));
+             }
+             threads.join_all();
+             for (size_t thread = 0; thread < nThreads; ++thread) {
+                  CPPUNIT_ASSERT_EQUAL(0, errors[thread]);
+             }
+             CPPUNIT_ASSERT(useMap ? reader.nAccessors() == 1 : reader.nAccessors() <= nThreads);
+        }
+   }
+
+   void testPixelConversion() {
+        // odd size to exercise the tail after the vectorised part
+        const size_t n = 5001;
+        std::vector<float> in(n);
+        for (size_t i = 0; i < n; ++i) {
+             in[i] = 0.5f * i - 100.f;
+        }
+        casacore::setNaN(in[7]);
+        const int bitpix[4] = {-32, -64, 16, 32};
+        for (int test = 0; test < 4; ++test) {
+             const double bscale = bitpix[test] > 0 ? 0.5 : 1.;
+             const double bzero = bitpix[test] > 0 ? 10. : 0.;
+             std::vector<char> raw(n * std::abs(bitpix[test]) / 8);
+             FitsPixelConversion::encode(in.data(), n, bitpix[test], bscale, bzero, true, -999, raw.data());
+             std::vector<float> out(n);
+             FitsPixelConversion::decode(raw.data(), n, bitpix[test], bscale, bzero, true, -999, out.data());
+             CPPUNIT_ASSERT(casacore::isNaN(out[7]));
+             for (size_t i = 0; i < n; ++i) {
+                  if (i != 7) {
+                      CPPUNIT_ASSERT_DOUBLES_EQUAL(in[i], out[i], 1e-6);
+                  }
+             }
+        }
+        // the file representation is big-endian
+        const float one = 1.f;
+        unsigned char raw[4];
+        FitsPixelConversion::encode(&one, 1, -32, 1., 0., false, 0, reinterpret_cast<char*>(raw));
+        CPPUNIT_ASSERT_EQUAL(0x3f, int(raw[0]));
+        CPPUNIT_ASSERT_EQUAL(0x80, int(raw[1]));
+        // NaN can't be written into an integer image without BLANK
+        std::vector<char> shorts(n * 2);
+        CPPUNIT_ASSERT_THROW(FitsPixelConversion::encode(in.data(), n, 16, 1., 0., false, 0, shorts.data()),
+                             askap::AskapError);
+   }
+
+   void testIntegerImage() {
+        const std::string name = "tmpfitsimage_int16";
+        const casacore::IPosition shape(3,20,10,3);
+        casacore::Array<float> arr(shape);
+        for (int z = 0; z < shape[2]; ++z) {
+             for (int y = 0; y < shape[1]; ++y) {
+                  for (int x = 0; x < shape[0]; ++x) {
+                       arr(casacore::IPosition(3,x,y,z)) = 0.01f * (x + 20 * y) - 1.f + z;
+                  }
+             }
+        }
+        casacore::setNaN(arr(casacore::IPosition(3,1,2,0)));
+        // the scaling is derived from the data
+        FitsImageAccess accessor;
+        accessor.setBitpix(16);
+        accessor.create(name, shape, makeCoords());
+        CPPUNIT_ASSERT_THROW(accessor.write(name, arr(casacore::IPosition(3,0,0,0), casacore::IPosition(3,19,9,0)),
+                             casacore::IPosition(3,0,0,0)), askap::AskapError);
+        accessor.write(name, arr);
+        CPPUNIT_ASSERT_EQUAL(std::string("16"), accessor.getMetadataKeyword(name, "BITPIX").first);
+        const double bscale = std::stod(accessor.getMetadataKeyword(name, "BSCALE").first);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL((3.99 + 1.) / 65534., bscale, 1e-9);
+        for (int test = 0; test < 2; ++test) {
+             // through the memory map and through casacore
+             accessor.useMemoryMap(test == 0);
+             const casacore::Array<float> readBack = accessor.read(name);
+             CPPUNIT_ASSERT(readBack.shape() == shape);
+             CPPUNIT_ASSERT(casacore::isNaN(readBack(casacore::IPosition(3,1,2,0))));
+             for (int z = 0; z < shape[2]; ++z) {
+                  for (int x = 0; x < shape[0]; ++x) {
+                       const casacore::IPosition pos(3,x,5,z);
+                       CPPUNIT_ASSERT_DOUBLES_EQUAL(arr(pos), readBack(pos), bscale);
+                  }
+             }
+        }
+        // fixed range, written plane by plane
+        accessor.setBitpix(32, -10., 10.);
+        accessor.create(name, shape, makeCoords());
+        for (int z = 0; z < shape[2]; ++z) {
+             const casacore::Array<float> plane = arr(casacore::IPosition(3,0,0,z), casacore::IPosition(3,19,9,z));
+             accessor.write(name, plane, casacore::IPosition(3,0,0,z));
+        }
+        const casacore::Array<float> readBack = accessor.read(name);
+        CPPUNIT_ASSERT(casacore::isNaN(readBack(casacore::IPosition(3,1,2,0))));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(arr(casacore::IPosition(3,7,3,2)), readBack(casacore::IPosition(3,7,3,2)), 1e-6);
+        // compression is only supported for floating point images
+        accessor.setCompression(FitsCompression(FitsCompression::RICE));
+        CPPUNIT_ASSERT_THROW(accessor.create(name, shape, makeCoords()), askap::AskapError);
+   }
+
+   void testDoublePrecision() {
+        const std::string name = "tmpfitsimage_double";
+        const casacore::IPosition shape(3,10,10,2);
+        casacore::Array<double> arr(shape);
+        for (int z = 0; z < shape[2]; ++z) {
+             for (int y = 0; y < shape[1]; ++y) {
+                  for (int x = 0; x < shape[0]; ++x) {
+                       arr(casacore::IPosition(3,x,y,z)) = 1. + 1e-12 * (x + 10 * y + 100 * z);
+                  }
+             }
+        }
+        FitsImageAccess accessor;
+        accessor.setBitpix(-64);
+        accessor.create(name, shape, makeCoords());
+        accessor.write(name, arr);
+        CPPUNIT_ASSERT_EQUAL(std::string("-64"), accessor.getMetadataKeyword(name, "BITPIX").first);
+        casacore::Array<double> readBack(shape);
+        accessor.readInto(name, casacore::IPosition(3,0,0,0), shape - 1, readBack);
+        CPPUNIT_ASSERT(casacore::allEQ(arr, readBack));
+        // overwrite a single plane, the image can still be read in single precision
+        const casacore::Array<double> plane = arr(casacore::IPosition(3,0,0,1), casacore::IPosition(3,9,9,1)) + 1.;
+        accessor.write(name, plane, casacore::IPosition(3,0,0,1));
+        casacore::Array<double> planeBack(plane.shape());
+        accessor.readInto(name, casacore::IPosition(3,0,0,1), casacore::IPosition(3,9,9,1), planeBack);
+        CPPUNIT_ASSERT(casacore::allEQ(plane, planeBack));
+        const casacore::Array<float> floatBack = accessor.read(name);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2., floatBack(casacore::IPosition(3,3,4,1)), 1e-6);
+        // double precision pixels can't be stored in integer images
+        accessor.setBitpix(16);
+        accessor.create(name, shape, makeCoords());
+        CPPUNIT_ASSERT_THROW(accessor.write(name, arr), askap::AskapError);
+   }
+
+   void testPackedMask() {
+        const std::string name = "tmpfitsimage_packedmask";
+        const casacore::IPosition shape(3,13,7,3);
+        casacore::Array<float> arr(shape, 1.f);
+        // plane 0 is fully valid, plane 1 is partially flagged, plane 2 is fully flagged
+        casacore::setNaN(arr(casacore::IPosition(3,4,3,1)));
+        casacore::setNaN(arr(casacore::IPosition(3,12,6,1)));
+        casacore::Array<float> lastPlane = arr(casacore::IPosition(3,0,0,2), casacore::IPosition(3,12,6,2));
+        casacore::setNaN(lastPlane);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        accessor.write(name, arr);
+        CPPUNIT_ASSERT_EQUAL(PackedMask::ALL_VALID, accessor.maskPlaneState(name, 0));
+        CPPUNIT_ASSERT_EQUAL(PackedMask::PARTIAL, accessor.maskPlaneState(name, 1));
+        CPPUNIT_ASSERT_EQUAL(PackedMask::ALL_MASKED, accessor.maskPlaneState(name, 2));
+        const casacore::IPosition blc(3,0,0,0);
+        const casacore::IPosition trc(3,12,6,2);
+        const PackedMask mask = accessor.readPackedMask(name, blc, trc);
+        CPPUNIT_ASSERT(mask.shape() == shape);
+        CPPUNIT_ASSERT_EQUAL(size_t(13 * 7 * 2 - 2), mask.nValid());
+        CPPUNIT_ASSERT(casacore::allEQ(mask.toArray(), accessor.readMask(name, blc, trc)));
+        CPPUNIT_ASSERT(!mask(casacore::IPosition(3,4,3,1)));
+        CPPUNIT_ASSERT(mask(casacore::IPosition(3,5,3,1)));
+        // the bits take 1/8 of the memory used by a LogicalArray
+        CPPUNIT_ASSERT(mask.memoryUsage() * 8 <= shape.product() + 64);
+        // rewriting the image invalidates the cached plane summaries
+        arr = 1.f;
+        accessor.write(name, arr);
+        CPPUNIT_ASSERT_EQUAL(PackedMask::ALL_VALID, accessor.maskPlaneState(name, 2));
+   }
+
+   void testLargeBinaryTable() {
+        // the table is longer than a single chunk of rows cfitsio buffers
+        const std::string name = "tmpfitsimage_largetable";
+        const casacore::IPosition shape(2,10,10);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        const casacore::uInt nRows = 50000;
+        casacore::Vector<casacore::Double> col1(nRows);
+        casacore::Vector<casacore::Int> col2(nRows);
+        casacore::Vector<casacore::String> col3(nRows);
+        for (casacore::uInt row = 0; row < nRows; ++row) {
+             col1[row] = 0.5 * row;
+             col2[row] = static_cast<casacore::Int>(row) - 100;
+             col3[row] = std::string("row") + std::to_string(row);
+        }
+        casacore::Record subrecord;
+        subrecord.define("Col1", col1);
+        subrecord.define("Col2", col2);
+        subrecord.define("Col3", col3);
+        casacore::Vector<casacore::String> units(3, "");
+        subrecord.define("Units", units);
+        casacore::Record info;
+        info.defineRecord("BigTable", subrecord);
+        accessor.setInfo(name, info);
+
+        casacore::Record result;
+        accessor.getInfo(name, "BigTable", result);
+        const casacore::Record &table = result.asRecord("BigTable").asRecord("BigTable");
+        const casacore::Array<casacore::Double> res1 = table.asArrayDouble("Col1");
+        const casacore::Array<casacore::Int> res2 = table.asArrayInt("Col2");
+        const casacore::Array<casacore::String> res3 = table.asArrayString("Col3");
+        CPPUNIT_ASSERT_EQUAL(size_t(nRows), res1.nelements());
+        CPPUNIT_ASSERT_EQUAL(size_t(nRows), res2.nelements());
+        CPPUNIT_ASSERT_EQUAL(size_t(nRows), res3.nelements());
+        for (casacore::uInt row = 0; row < nRows; row += 997) {
+             const casacore::IPosition pos(1, row);
+             CPPUNIT_ASSERT_DOUBLES_EQUAL(col1[row], res1(pos), 1e-10);
+             CPPUNIT_ASSERT_EQUAL(col2[row], res2(pos));
+             CPPUNIT_ASSERT_EQUAL(std::string(col3[row]), std::string(res3(pos)));
+        }
+   }
+
+   void testAddInto() {
+        const std::string name = "tmpfitsimage_addinto";
+        const casacore::IPosition shape(3,10,10,2);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        accessor.write(name, casacore::Array<float>(shape, 1.f));
+        // two overlapping regions
+        const casacore::Array<float> block(casacore::IPosition(3,6,6,1), 2.f);
+        accessor.addInto(name, block, casacore::IPosition(3,0,0,1));
+        accessor.addInto(name, block, casacore::IPosition(3,4,4,1));
+        const casacore::Array<float> result = accessor.read(name);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1., result(casacore::IPosition(3,5,5,0)), 1e-6);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(3., result(casacore::IPosition(3,1,1,1)), 1e-6);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(5., result(casacore::IPosition(3,5,5,1)), 1e-6);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(3., result(casacore::IPosition(3,9,9,1)), 1e-6);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1., result(casacore::IPosition(3,9,0,1)), 1e-6);
+        // the region has to fit into the image
+        CPPUNIT_ASSERT_THROW(accessor.addInto(name, block, casacore::IPosition(3,5,5,1)), askap::AskapError);
+   }
+
+   void testStridedRead() {
+        const std::string name = "tmpfitsimage_strided";
+        const casacore::IPosition shape(3,11,8,2);
+        casacore::Array<float> arr(shape);
+        for (int z = 0; z < shape[2]; ++z) {
+             for (int y = 0; y < shape[1]; ++y) {
+                  for (int x = 0; x < shape[0]; ++x) {
+                       arr(casacore::IPosition(3,x,y,z)) = x + 100 * y + 1000 * z;
+                  }
+             }
+        }
+        casacore::setNaN(arr(casacore::IPosition(3,0,0,1)));
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        accessor.write(name, arr);
+        const casacore::Array<float> strided = accessor.read(name, casacore::IPosition(3,1,0,0),
+                        casacore::IPosition(3,10,7,1), casacore::IPosition(3,3,2,1));
+        CPPUNIT_ASSERT(strided.shape() == casacore::IPosition(3,4,4,2));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1., strided(casacore::IPosition(3,0,0,0)), 1e-6);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1610., strided(casacore::IPosition(3,3,3,1)), 1e-6);
+        // the same through the generic implementation in the interface
+        const IImageAccess<> &iface = accessor;
+        CPPUNIT_ASSERT(casacore::allEQ(strided, iface.IImageAccess<>::read(name, casacore::IPosition(3,1,0,0),
+                       casacore::IPosition(3,10,7,1), casacore::IPosition(3,3,2,1))));
+        // block averages, the last block along the first axis has one column only
+        const casacore::Array<float> averaged = accessor.readAveraged(name, casacore::IPosition(3,0,0,0),
+                        shape - 1, casacore::IPosition(3,2,4,1));
+        CPPUNIT_ASSERT(averaged.shape() == casacore::IPosition(3,6,2,2));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(150.5, averaged(casacore::IPosition(3,0,0,0)), 1e-4);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(560., averaged(casacore::IPosition(3,5,1,0)), 1e-4);
+        // the blanked pixel is ignored
+        CPPUNIT_ASSERT_DOUBLES_EQUAL((8 * 1150.5 - 1000.) / 7., averaged(casacore::IPosition(3,0,0,1)), 1e-3);
+        CPPUNIT_ASSERT_THROW(accessor.read(name, casacore::IPosition(3,0,0,0), shape - 1, casacore::IPosition(3,0,1,1)),
+                             askap::AskapError);
+   }
+
+   void testMetadata() {
+        const std::string name = "tmpfitsimage_metadata";
+        const casacore::IPosition shape(3,10,10,2);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        accessor.setUnits(name, "Jy/beam");
+        accessor.setBeamInfo(name, 1e-4, 5e-5, 0.1);
+        accessor.setMetadataKeyword(name, "TESTKW", "test value", "test keyword");
+        const boost::shared_ptr<const ImageMetadata> md = accessor.metadata(name);
+        CPPUNIT_ASSERT(md);
+        CPPUNIT_ASSERT(md->itsShape == shape);
+        CPPUNIT_ASSERT(md->itsMasked);
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), md->itsUnits);
+        CPPUNIT_ASSERT_EQUAL(3u, md->itsBeam.nelements());
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(1e-4, md->itsBeam[0].getValue("rad"), 1e-9);
+        CPPUNIT_ASSERT(md->itsBeamList.empty());
+        CPPUNIT_ASSERT_EQUAL(std::string("test value"), md->keyword("TESTKW").first);
+        CPPUNIT_ASSERT_EQUAL(std::string("test keyword"), md->keyword("TESTKW").second);
+        CPPUNIT_ASSERT_EQUAL(std::string("-32"), md->keyword("BITPIX").first);
+        CPPUNIT_ASSERT(md->keyword("NOSUCHKW").first.empty());
+        // the getters agree with the snapshot, which is reused until the image changes
+        CPPUNIT_ASSERT_EQUAL(accessor.getMetadataKeyword(name, "TESTKW").first, md->keyword("TESTKW").first);
+        CPPUNIT_ASSERT(accessor.metadata(name) == md);
+        accessor.setUnits(name, "Jy/pixel");
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy/pixel"), accessor.getUnits(name));
+        CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), md->itsUnits);
+   }
+
+   void testChannelBeam() {
+        const std::string name = "tmpfitsimage_channelbeam";
+        const casacore::IPosition shape(3,10,10,5);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        // single beam
+        accessor.setBeamInfo(name, 1e-4, 5e-5, 0.1);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(5e-5, accessor.channelBeam(name, 3)[1].getValue("rad"), 1e-9);
+        BeamList beamlist;
+        for (unsigned int chan = 0; chan < 5; ++chan) {
+             casacore::Vector<casacore::Quantum<double> > currentbeam(3);
+             currentbeam[0] = casacore::Quantum<double>(10 + chan * 0.1, "arcsec");
+             currentbeam[1] = casacore::Quantum<double>(5 + chan * 0.1, "arcsec");
+             currentbeam[2] = casacore::Quantum<double>(12. + chan, "deg");
+             beamlist[chan] = currentbeam;
+        }
+        accessor.setBeamInfo(name, beamlist);
+        // read from the beam table without the snapshot, then from the snapshot
+        for (int pass = 0; pass < 2; ++pass) {
+             for (unsigned int chan = 0; chan < 5; ++chan) {
+                  const casacore::Vector<casacore::Quantum<double> > beam = accessor.channelBeam(name, chan);
+                  CPPUNIT_ASSERT_EQUAL(3u, beam.nelements());
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL(10 + chan * 0.1, beam[0].getValue("arcsec"), 1e-4);
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL(5 + chan * 0.1, beam[1].getValue("arcsec"), 1e-4);
+                  CPPUNIT_ASSERT_DOUBLES_EQUAL(12. + chan, beam[2].getValue("deg"), 1e-4);
+             }
+             CPPUNIT_ASSERT_THROW(accessor.channelBeam(name, 7), askap::AskapError);
+             accessor.metadata(name);
+        }
+   }
+
+   void testStatistics() {
+        const std::string name = "tmpfitsimage_statistics";
+        const casacore::IPosition shape(3,10,10,2);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        boost::shared_ptr<ImageStatistics> stats(new ImageStatistics(shape));
+        accessor.setStatistics(stats);
+        // plane 0 has values 0..99, plane 1 is constant with one blanked pixel
+        casacore::Array<float> plane(casacore::IPosition(3,10,10,1));
+        for (int y = 0; y < 10; ++y) {
+             for (int x = 0; x < 10; ++x) {
+                  plane(casacore::IPosition(3,x,y,0)) = float(x + 10 * y);
+             }
+        }
+        accessor.write(name, plane, casacore::IPosition(3,0,0,0));
+        plane.set(3.f);
+        casacore::setNaN(plane(casacore::IPosition(3,4,4,0)));
+        accessor.write(name, plane, casacore::IPosition(3,0,0,1));
+        accessor.setStatistics(boost::shared_ptr<ImageStatistics>());
+        // not accumulated any more
+        accessor.write(name, plane, casacore::IPosition(3,0,0,1));
+
+        CPPUNIT_ASSERT_EQUAL(size_t(2), stats->nPlanes());
+        CPPUNIT_ASSERT_EQUAL(100ull, stats->plane(0).itsCount);
+        CPPUNIT_ASSERT_EQUAL(0.f, stats->plane(0).itsMin);
+        CPPUNIT_ASSERT_EQUAL(99.f, stats->plane(0).itsMax);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(49.5, stats->plane(0).mean(), 1e-10);
+        CPPUNIT_ASSERT_EQUAL(99ull, stats->plane(1).itsCount);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(3., stats->plane(1).rms(), 1e-10);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0., stats->plane(1).stddev(), 1e-10);
+        const ImageMoments total = stats->total();
+        CPPUNIT_ASSERT_EQUAL(199ull, total.itsCount);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL((4950. + 297.) / 199., total.mean(), 1e-10);
+
+        stats->writeKeywords(accessor, name);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(99., std::stod(accessor.getMetadataKeyword(name, "DATAMAX").first), 1e-10);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(0., std::stod(accessor.getMetadataKeyword(name, "DATAMIN").first), 1e-10);
+        stats->writeTable(accessor, name);
+        casacore::Record info;
+        accessor.getInfo(name, "STATISTICS", info);
+        const casacore::Record &table = info.asRecord("STATISTICS").asRecord("STATISTICS");
+        const casacore::Array<casacore::Int64> counts = table.asArrayInt64("NPIX");
+        CPPUNIT_ASSERT_EQUAL(size_t(2), counts.nelements());
+        CPPUNIT_ASSERT_EQUAL(casacore::Int64(99), counts(casacore::IPosition(1,1)));
+   }
+
+   void testChecksum() {
+        const std::string name = "tmpfitsimage_checksum";
+        const casacore::IPosition shape(2,10,10);
+        FitsImageAccess accessor;
+        accessor.create(name, shape, makeCoords());
+        accessor.write(name, casacore::Array<float>(shape, 2.f));
+        CPPUNIT_ASSERT_EQUAL(std::string(""), accessor.getMetadataKeyword(name, "CHECKSUM").first);
+        accessor.writeChecksum(name);
+        CPPUNIT_ASSERT_EQUAL(size_t(16), accessor.getMetadataKeyword(name, "CHECKSUM").first.size());
+        CPPUNIT_ASSERT(accessor.getMetadataKeyword(name, "DATASUM").first != "");
+        // the pixels are still accessible
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(2., accessor.read(name)(casacore::IPosition(2,3,4)), 1e-7);
+   }
+
+   void testIncrementalChecksum() {
+        // the sum doesn't depend on how the bytes are split
+        const char bytes[] = "0123456789abcdefghijk";
+        FitsChecksum whole;
+        whole.add(bytes, 21, 0);
+        FitsChecksum pieces;
+        pieces.add(bytes + 7, 14, 7);
+        pieces.add(bytes, 3, 0);
+        pieces.add(bytes + 3, 4, 3);
+        CPPUNIT_ASSERT_EQUAL(whole.value(), pieces.value());
+
+        // the image is written in blocks which are not contiguous in the file
+        const casacore::IPosition shape(2,10,12);
+        const casacore::IPosition blockShape(2,5,6);
+        casacore::Array<float> block(blockShape);
+        const std::string names[2] = {"tmpfitsimage_fullchecksum", "tmpfitsimage_incrementalchecksum"};
+        for (int image = 0; image < 2; ++image) {
+             FitsImageAccess accessor;
+             accessor.useIncrementalChecksum(image == 1);
+             accessor.create(names[image], shape, makeCoords());
+             for (int x = 0; x < 2; ++x) {
+                  for (int y = 0; y < 2; ++y) {
+                       for (size_t pix = 0; pix < block.nelements(); ++pix) {
+                            block.data()[pix] = 0.1f * pix - 3.f * x + y;
+                       }
+                       accessor.write(names[image], block, casacore::IPosition(2, 5 * x, 6 * y));
+                  }
+             }
+             accessor.writeChecksum(names[image]);
+        }
+        FitsImageAccess reader;
+        CPPUNIT_ASSERT_EQUAL(reader.getMetadataKeyword(names[0], "DATASUM").first,
+                             reader.getMetadataKeyword(names[1], "DATASUM").first);
+        // the comment of CHECKSUM includes the time, so let cfitsio verify the sums instead
+        fitsfile *fptr = nullptr;
+        int status = 0;
+        int dataOK = 0;
+        int hduOK = 0;
+        fits_open_file(&fptr, (names[1] + ".fits").c_str(), READONLY, &status);
+        fits_verify_chksum(fptr, &dataOK, &hduOK, &status);
+        fits_close_file(fptr, &status);
+        CPPUNIT_ASSERT_EQUAL(0, status);
+        CPPUNIT_ASSERT_EQUAL(1, dataOK);
+        CPPUNIT_ASSERT_EQUAL(1, hduOK);
+   }
+
+   void testTableToVOTable() {
+        const std::string name = "tmpfitsimage_votable";
+        FitsImageAccess accessor;
+        accessor.create(name, casacore::IPosition(2,10,10), makeCoords());
+        accessor.setInfo(name, create_dummy_record());
+
+        const FitsTableConverter converter(name);
+        const std::vector<std::string> names = converter.tableNames();
+        CPPUNIT_ASSERT_EQUAL(size_t(1), names.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("Table"), names[0]);
+        const VOTableTable::DataFormat formats[] = {VOTableTable::TABLEDATA, VOTableTable::BINARY2};
+        for (const VOTableTable::DataFormat format : formats) {
+             std::stringstream ss;
+             {
+               VOTableWriter writer(ss);
+               CPPUNIT_ASSERT_EQUAL(size_t(10), converter.convert("All", writer, format));
+             }
+             const VOTable vot = VOTable::fromXML(ss);
+             CPPUNIT_ASSERT_EQUAL(size_t(1), vot.getResource().size());
+             const VOTableResource &resource = vot.getResource()[0];
+             CPPUNIT_ASSERT_EQUAL(std::string("Table"), resource.getName());
+             bool foundExposure = false;
+             for (const VOTableInfo &info : resource.getInfo()) {
+                  CPPUNIT_ASSERT(info.getName() != "TTYPE1" && info.getName() != "NAXIS2");
+                  if (info.getName() == "EXPOSURE") {
+                      CPPUNIT_ASSERT_EQUAL(std::string("1500"), info.getValue());
+                      foundExposure = true;
+                  } else if (info.getName() == "KWORD1") {
+                      CPPUNIT_ASSERT_EQUAL(std::string("Testing"), info.getValue());
+                  }
+             }
+             CPPUNIT_ASSERT(foundExposure);
+             const VOTableTable &table = resource.getTables()[0];
+             CPPUNIT_ASSERT_EQUAL(format, table.getDataFormat());
+             const std::vector<VOTableField> fields = table.getFields();
+             CPPUNIT_ASSERT_EQUAL(size_t(2), fields.size());
+             CPPUNIT_ASSERT_EQUAL(std::string("Col1"), fields[0].getName());
+             CPPUNIT_ASSERT_EQUAL(std::string("double"), fields[0].getDatatype());
+             CPPUNIT_ASSERT_EQUAL(std::string("Unit4Col1"), fields[0].getUnit());
+             CPPUNIT_ASSERT_EQUAL(std::string("char"), fields[1].getDatatype());
+             CPPUNIT_ASSERT_EQUAL(std::string("*"), fields[1].getArraysize());
+             const std::vector<VOTableRow> rows = table.getRows();
+             CPPUNIT_ASSERT_EQUAL(size_t(10), rows.size());
+             for (size_t row = 0; row < rows.size(); ++row) {
+                  const std::vector<std::string> &cells = rows[row].getCells();
+                  // values should read back exactly
+                  CPPUNIT_ASSERT_EQUAL((row + 1) * 2.2, std::strtod(cells[0].c_str(), nullptr));
+                  CPPUNIT_ASSERT_EQUAL("col2 string" + std::to_string(row + 1), cells[1]);
+             }
+        }
+
+        // a single table straight to a file
+        CPPUNIT_ASSERT_EQUAL(size_t(10), converter.convert("Table", name + ".xml"));
+        const VOTable vot = VOTable::fromXML(name + ".xml");
+        CPPUNIT_ASSERT_EQUAL(size_t(10), vot.getResource()[0].getTables()[0].getRows().size());
+        CPPUNIT_ASSERT_THROW(converter.convert("NoSuchTable", name + ".xml"), AskapError);
+   }
+
 protected:
 
    casacore::CoordinateSystem makeCoords() {
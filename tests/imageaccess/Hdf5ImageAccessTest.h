@@ -0,0 +1,144 @@
+/// @file
+///
+/// Unit test for the HDF5 image access code
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/Hdf5ImageAccess.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/Matrix.h>
+#include <casacore/coordinates/Coordinates/LinearCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+#include <casacore/casa/Containers/Record.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <vector>
+
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+class Hdf5ImageAccessTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(Hdf5ImageAccessTest);
+   CPPUNIT_TEST(testReadWrite);
+   CPPUNIT_TEST(testMetadata);
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void testReadWrite() {
+      if (!Hdf5ImageAccess<>::hasHDF5Support()) {
+          return;
+      }
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","hdf5");
+      parset.add("imagechunkshape","[4,4,5]");
+      boost::shared_ptr<IImageAccess<casacore::Float> > accessor = imageAccessFactory(parset);
+      CPPUNIT_ASSERT(accessor);
+      const std::string name = "tmp.testhdf5image";
+      const casacore::IPosition shape(3,10,10,5);
+      accessor->create(name, shape, makeCoords());
+      // write plane by plane
+      casacore::Array<float> plane(casacore::IPosition(3,10,10,1));
+      for (int chan = 0; chan < shape[2]; ++chan) {
+           plane.set(float(chan));
+           accessor->write(name, plane, casacore::IPosition(3,0,0,chan));
+      }
+      CPPUNIT_ASSERT(accessor->shape(name) == shape);
+      // read a spectrum
+      const casacore::Array<float> spectrum = accessor->read(name, casacore::IPosition(3,3,4,0),
+                                                             casacore::IPosition(3,3,4,4));
+      CPPUNIT_ASSERT_EQUAL(size_t(5), spectrum.nelements());
+      for (int chan = 0; chan < shape[2]; ++chan) {
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(float(chan), spectrum(casacore::IPosition(3,0,0,chan)), 1e-7);
+      }
+      CPPUNIT_ASSERT(!accessor->isMasked(name));
+      CPPUNIT_ASSERT_EQUAL(casacore::uInt(3), accessor->coordSys(name).nPixelAxes());
+
+      // the chunk shape is clipped at the image shape
+      Hdf5ImageAccess<> hdf5;
+      hdf5.setChunkShape(casacore::IPosition(2,16,2));
+      CPPUNIT_ASSERT(hdf5.tiledShape(shape).tileShape() == casacore::IPosition(3,10,2,1));
+   }
+
+   void testMetadata() {
+      if (!Hdf5ImageAccess<>::hasHDF5Support()) {
+          return;
+      }
+      Hdf5ImageAccess<> accessor;
+      const std::string name = "tmp.testhdf5metadata";
+      const casacore::IPosition shape(3,8,8,2);
+      accessor.create(name, shape, makeCoords());
+      accessor.write(name, casacore::Array<float>(shape, 1.f));
+      accessor.setUnits(name, "Jy/beam");
+      accessor.setBeamInfo(name, 1e-4, 5e-5, 0.5);
+      accessor.setMetadataKeyword(name, "TELESCOP", "ASKAP", "telescope");
+      accessor.addHistory(name, std::vector<std::string>(1, "first line"));
+      casacore::Record table;
+      table.define("Units", "none");
+      casacore::Record info;
+      info.defineRecord("TESTTABLE", table);
+      accessor.setInfo(name, info);
+      accessor.close();
+
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), accessor.getUnits(name));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1e-4, accessor.beamInfo(name)[0].getValue("rad"), 1e-10);
+      CPPUNIT_ASSERT_EQUAL(std::string("ASKAP"), accessor.getMetadataKeyword(name, "TELESCOP").first);
+      CPPUNIT_ASSERT_EQUAL(std::string("telescope"), accessor.getMetadataKeyword(name, "TELESCOP").second);
+      casacore::Record readBack;
+      accessor.getInfo(name, "TESTTABLE", readBack);
+      CPPUNIT_ASSERT(readBack.isDefined("TESTTABLE"));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1., accessor.read(name)(casacore::IPosition(3,2,3,1)), 1e-7);
+   }
+
+protected:
+   casacore::CoordinateSystem makeCoords() {
+      casacore::Vector<casacore::String> names(2);
+      names[0]="x"; names[1]="y";
+      casacore::Vector<double> increment(2 ,1.);
+
+      casacore::Matrix<double> xform(2,2,0.);
+      xform.diagonal() = 1.;
+      casacore::LinearCoordinate linear(names, casacore::Vector<casacore::String>(2,"pixel"),
+             casacore::Vector<double>(2,0.),increment, xform, casacore::Vector<double>(2,0.));
+
+      casacore::CoordinateSystem coords;
+      coords.addCoordinate(linear);
+      coords.addCoordinate(casacore::SpectralCoordinate(casacore::MFrequency::TOPO, 1.e9, 1.e8, 0.0));
+      return coords;
+   }
+};
+
+} // namespace accessors
+
+} // namespace askap
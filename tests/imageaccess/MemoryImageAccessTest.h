@@ -0,0 +1,312 @@
+/// @file
+///
+/// Unit test for the memory image access code
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <askap/imageaccess/ImageStatistics.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/coordinates/Coordinates/LinearCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+#include <casacore/casa/Containers/Record.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <vector>
+
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+class MemoryImageAccessTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(MemoryImageAccessTest);
+   CPPUNIT_TEST(testReadWrite);
+   CPPUNIT_TEST(testSharedStore);
+   CPPUNIT_TEST(testMetadata);
+   CPPUNIT_TEST(testMask);
+   CPPUNIT_TEST(testAddInto);
+   CPPUNIT_TEST(testSpill);
+   CPPUNIT_TEST_EXCEPTION(testMissingImage, AskapError);
+   CPPUNIT_TEST_EXCEPTION(testOutOfBounds, AskapError);
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void setUp() {
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","memory");
+      itsImageAccessor = imageAccessFactory(parset);
+      itsMemoryAccessor = boost::dynamic_pointer_cast<MemoryImageAccess<casacore::Float> >(itsImageAccessor);
+   }
+
+   void tearDown() {
+      // the images are shared by the whole process, clean up after each test
+      const char* names[] = {"tmp.memimage", "tmp.memimage2", "tmp.memimage3"};
+      for (size_t i = 0; i < 3; ++i) {
+           itsMemoryAccessor->erase(names[i]);
+      }
+      itsMemoryAccessor->setMemoryBudget(0);
+      itsMemoryAccessor->setSpillDirectory("");
+   }
+
+   void testReadWrite() {
+      CPPUNIT_ASSERT(itsMemoryAccessor);
+      const std::string name = "tmp.memimage";
+      const casacore::IPosition shape(3,10,10,5);
+      CPPUNIT_ASSERT(!itsMemoryAccessor->exists(name));
+      itsImageAccessor->create(name, shape, makeCoords());
+      CPPUNIT_ASSERT(itsMemoryAccessor->exists(name));
+      CPPUNIT_ASSERT(itsImageAccessor->shape(name) == shape);
+      CPPUNIT_ASSERT_EQUAL(size_t(shape.product() * sizeof(float)), itsMemoryAccessor->memoryUsed());
+      // new image is filled with zeros
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., itsImageAccessor->read(name)(casacore::IPosition(3,5,5,2)), 1e-7);
+
+      casacore::Array<float> arr(shape);
+      arr.set(1.);
+      itsImageAccessor->write(name, arr);
+      casacore::Vector<float> vec(10,2.);
+      itsImageAccessor->write(name,vec,casacore::IPosition(3,0,3,0));
+      const casacore::Array<float> readBack = itsImageAccessor->read(name);
+      CPPUNIT_ASSERT(readBack.shape() == shape);
+      for (int x=0; x<shape[0]; ++x) {
+           for (int y=0; y<shape[1]; ++y) {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(y == 3 ? 2. : 1., readBack(casacore::IPosition(3,x,y,0)), 1e-7);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(1., readBack(casacore::IPosition(3,x,y,1)), 1e-7);
+           }
+      }
+      // slices and the reusable buffer
+      casacore::Array<float> buffer;
+      itsImageAccessor->readInto(name, casacore::IPosition(3,2,2,0), casacore::IPosition(3,4,3,0), buffer);
+      CPPUNIT_ASSERT(buffer.shape() == casacore::IPosition(3,3,2,1));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1., buffer(casacore::IPosition(3,0,0,0)), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2., buffer(casacore::IPosition(3,2,1,0)), 1e-7);
+      // the result is a copy
+      buffer.set(-1.);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1., itsImageAccessor->read(name)(casacore::IPosition(3,2,2,0)), 1e-7);
+      // coordinates
+      CPPUNIT_ASSERT(itsImageAccessor->coordSys(name).nCoordinates() == 2);
+      CPPUNIT_ASSERT(itsImageAccessor->coordSys(name).type(1) == casacore::CoordinateSystem::SPECTRAL);
+      const casacore::CoordinateSystem slice = itsImageAccessor->coordSysSlice(name, casacore::IPosition(3,0,0,2),
+                                                                              casacore::IPosition(3,9,9,4));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-2., slice.referencePixel()[2], 1e-7);
+      // re-creation replaces the image
+      itsImageAccessor->create(name, casacore::IPosition(3,4,4,1), makeCoords());
+      CPPUNIT_ASSERT(itsImageAccessor->shape(name) == casacore::IPosition(3,4,4,1));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., itsImageAccessor->read(name)(casacore::IPosition(3,0,3,0)), 1e-7);
+      itsMemoryAccessor->erase(name);
+      CPPUNIT_ASSERT(!itsMemoryAccessor->exists(name));
+      CPPUNIT_ASSERT_EQUAL(size_t(0), itsMemoryAccessor->memoryUsed());
+   }
+
+   void testSharedStore() {
+      // images written through one accessor are visible through another one
+      const std::string name = "tmp.memimage";
+      itsImageAccessor->create(name, casacore::IPosition(3,4,4,1), makeCoords());
+      itsImageAccessor->write(name, casacore::Array<float>(casacore::IPosition(3,4,4,1), 3.));
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","memory");
+      const boost::shared_ptr<IImageAccess<casacore::Float> > other = imageAccessFactory(parset);
+      CPPUNIT_ASSERT(other != itsImageAccessor);
+      CPPUNIT_ASSERT(other->shape(name) == casacore::IPosition(3,4,4,1));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(3., other->read(name)(casacore::IPosition(3,1,2,0)), 1e-7);
+   }
+
+   void testMetadata() {
+      const std::string name = "tmp.memimage";
+      itsImageAccessor->create(name, casacore::IPosition(3,4,4,3), makeCoords());
+      const boost::shared_ptr<const ImageMetadata> before = itsImageAccessor->metadata(name);
+      itsImageAccessor->setUnits(name, "Jy/beam");
+      itsImageAccessor->setBeamInfo(name, 0.02, 0.01, 1.0);
+      itsImageAccessor->setMetadataKeyword(name, "TESTKW", "value", "comment");
+      LOFAR::ParameterSet keywords;
+      keywords.add("INTKW", "[\"5\", \"an integer\", \"INT\"]");
+      keywords.add("BADKW", "[\"five\", \"not an integer\", \"INT\"]");
+      itsImageAccessor->setMetadataKeywords(name, keywords);
+      std::vector<std::string> history(2, "line");
+      itsImageAccessor->addHistory(name, history);
+
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), itsImageAccessor->getUnits(name));
+      const casacore::Vector<casacore::Quantum<double> > beam = itsImageAccessor->beamInfo(name);
+      CPPUNIT_ASSERT_EQUAL(3u, beam.nelements());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.02, beam[0].getValue("rad"), 1e-10);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.01, beam[1].getValue("rad"), 1e-10);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, beam[2].getValue("rad"), 1e-10);
+      CPPUNIT_ASSERT(itsImageAccessor->beamList(name).empty());
+      CPPUNIT_ASSERT_EQUAL(std::string("value"), itsImageAccessor->getMetadataKeyword(name, "TESTKW").first);
+      CPPUNIT_ASSERT_EQUAL(std::string("comment"), itsImageAccessor->getMetadataKeyword(name, "TESTKW").second);
+      CPPUNIT_ASSERT_EQUAL(std::string("5"), itsImageAccessor->getMetadataKeyword(name, "INTKW").first);
+      CPPUNIT_ASSERT_EQUAL(std::string(""), itsImageAccessor->getMetadataKeyword(name, "BADKW").first);
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsMemoryAccessor->history(name).size());
+      // snapshots handed out earlier are not changed
+      CPPUNIT_ASSERT_EQUAL(std::string(""), before->itsUnits);
+      CPPUNIT_ASSERT(before->itsKeywords.empty());
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsImageAccessor->metadata(name)->itsKeywords.size());
+
+      // beam per channel
+      BeamList beams;
+      for (unsigned int chan = 0; chan < 3; ++chan) {
+           beams[chan] = casacore::GaussianBeam(casacore::Quantity(0.01 * (chan + 1), "rad"),
+                         casacore::Quantity(0.01, "rad"), casacore::Quantity(0., "rad")).toVector();
+      }
+      itsImageAccessor->setBeamInfo(name, beams);
+      CPPUNIT_ASSERT_EQUAL(size_t(3), itsImageAccessor->beamList(name).size());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.03, itsImageAccessor->channelBeam(name, 2)[0].getValue("rad"), 1e-10);
+
+      // info tables
+      casacore::Record table, info;
+      table.define("Col1", casacore::Vector<casacore::Int>(3, 1));
+      info.defineRecord("table 1", table);
+      itsImageAccessor->setInfo(name, info);
+      casacore::Record readBack;
+      itsImageAccessor->getInfo(name, "table 1", readBack);
+      CPPUNIT_ASSERT_EQUAL(1u, readBack.nfields());
+      casacore::Record none;
+      itsImageAccessor->getInfo(name, "table 2", none);
+      CPPUNIT_ASSERT_EQUAL(0u, none.nfields());
+   }
+
+   void testMask() {
+      const std::string name = "tmp.memimage";
+      const casacore::IPosition shape(3,4,4,1);
+      itsImageAccessor->create(name, shape, makeCoords());
+      CPPUNIT_ASSERT(!itsImageAccessor->isMasked(name));
+      CPPUNIT_ASSERT(itsImageAccessor->readMask(name)(casacore::IPosition(3,1,1,0)));
+      casacore::Array<float> arr(casacore::IPosition(3,2,2,1), 5.);
+      casacore::Array<bool> mask(casacore::IPosition(3,2,2,1), true);
+      mask(casacore::IPosition(3,1,1,0)) = false;
+      itsImageAccessor->write(name, arr, mask, casacore::IPosition(3,1,1,0));
+      CPPUNIT_ASSERT(itsImageAccessor->isMasked(name));
+      const casacore::LogicalArray readMask = itsImageAccessor->readMask(name);
+      CPPUNIT_ASSERT(readMask.shape() == shape);
+      CPPUNIT_ASSERT(readMask(casacore::IPosition(3,0,0,0)));
+      CPPUNIT_ASSERT(readMask(casacore::IPosition(3,1,1,0)));
+      CPPUNIT_ASSERT(!readMask(casacore::IPosition(3,2,2,0)));
+      // unmasked pixels are returned as written
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(5., itsImageAccessor->read(name)(casacore::IPosition(3,2,2,0)), 1e-7);
+      CPPUNIT_ASSERT_EQUAL(size_t(shape.product() * (sizeof(float) + sizeof(casacore::Bool))),
+                           itsMemoryAccessor->memoryUsed());
+      itsImageAccessor->makeDefaultMask(name);
+      CPPUNIT_ASSERT(itsImageAccessor->readMask(name)(casacore::IPosition(3,2,2,0)));
+   }
+
+   void testAddInto() {
+      const std::string name = "tmp.memimage";
+      itsImageAccessor->create(name, casacore::IPosition(3,4,4,1), makeCoords());
+      const boost::shared_ptr<ImageStatistics> stats(new ImageStatistics);
+      itsImageAccessor->setStatistics(stats);
+      const casacore::Array<float> arr(casacore::IPosition(3,2,2,1), 1.5);
+      itsImageAccessor->addInto(name, arr, casacore::IPosition(3,0,0,0));
+      itsImageAccessor->addInto(name, arr, casacore::IPosition(3,1,1,0));
+      const casacore::Array<float> result = itsImageAccessor->read(name);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, result(casacore::IPosition(3,0,0,0)), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(3., result(casacore::IPosition(3,1,1,0)), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, result(casacore::IPosition(3,2,2,0)), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0., result(casacore::IPosition(3,3,3,0)), 1e-7);
+      itsImageAccessor->setStatistics(boost::shared_ptr<ImageStatistics>());
+   }
+
+   void testSpill() {
+      const casacore::IPosition shape(3,16,16,2);
+      const size_t imageSize = shape.product() * sizeof(float);
+      // budget for a bit more than one image, no spill directory yet
+      itsMemoryAccessor->setMemoryBudget(imageSize + imageSize / 2);
+      itsImageAccessor->create("tmp.memimage", shape, makeCoords());
+      itsImageAccessor->create("tmp.memimage2", shape, makeCoords());
+      CPPUNIT_ASSERT_EQUAL(2 * imageSize, itsMemoryAccessor->memoryUsed());
+      CPPUNIT_ASSERT_EQUAL(size_t(0), itsMemoryAccessor->spills());
+      // setting the directory enforces the budget
+      itsImageAccessor->write("tmp.memimage", casacore::Array<float>(shape, 7.));
+      itsImageAccessor->setMetadataKeyword("tmp.memimage", "KW", "kept");
+      itsImageAccessor->write("tmp.memimage2", casacore::Array<float>(shape, 8.));
+      itsMemoryAccessor->setSpillDirectory(".");
+      CPPUNIT_ASSERT_EQUAL(size_t(1), itsMemoryAccessor->spills());
+      CPPUNIT_ASSERT(itsMemoryAccessor->isSpilled("tmp.memimage"));
+      CPPUNIT_ASSERT(!itsMemoryAccessor->isSpilled("tmp.memimage2"));
+      CPPUNIT_ASSERT_EQUAL(imageSize, itsMemoryAccessor->memoryUsed());
+      // metadata are available without reading the pixels back
+      CPPUNIT_ASSERT(itsImageAccessor->shape("tmp.memimage") == shape);
+      CPPUNIT_ASSERT_EQUAL(std::string("kept"), itsImageAccessor->getMetadataKeyword("tmp.memimage", "KW").first);
+      CPPUNIT_ASSERT(itsMemoryAccessor->isSpilled("tmp.memimage"));
+      // reading the pixels brings the image back and spills the other one
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(7., itsImageAccessor->read("tmp.memimage")(casacore::IPosition(3,3,4,1)), 1e-7);
+      CPPUNIT_ASSERT(!itsMemoryAccessor->isSpilled("tmp.memimage"));
+      CPPUNIT_ASSERT(itsMemoryAccessor->isSpilled("tmp.memimage2"));
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsMemoryAccessor->spills());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(8., itsImageAccessor->read("tmp.memimage2")(casacore::IPosition(3,0,0,0)), 1e-7);
+      // without the budget everything stays in memory
+      itsMemoryAccessor->setMemoryBudget(0);
+      itsImageAccessor->read("tmp.memimage");
+      CPPUNIT_ASSERT(!itsMemoryAccessor->isSpilled("tmp.memimage"));
+      CPPUNIT_ASSERT(!itsMemoryAccessor->isSpilled("tmp.memimage2"));
+   }
+
+   void testMissingImage() {
+      itsImageAccessor->read("tmp.memimage3");
+   }
+
+   void testOutOfBounds() {
+      itsImageAccessor->create("tmp.memimage", casacore::IPosition(3,4,4,1), makeCoords());
+      itsImageAccessor->write("tmp.memimage", casacore::Array<float>(casacore::IPosition(3,5,1,1), 1.),
+                              casacore::IPosition(3,0,0,0));
+   }
+
+protected:
+   casacore::CoordinateSystem makeCoords() {
+      casacore::Vector<casacore::String> names(2);
+      names[0]="x"; names[1]="y";
+      casacore::Vector<double> increment(2 ,1.);
+
+      casacore::Matrix<double> xform(2,2,0.);
+      xform.diagonal() = 1.;
+      casacore::LinearCoordinate linear(names, casacore::Vector<casacore::String>(2,"pixel"),
+             casacore::Vector<double>(2,0.),increment, xform, casacore::Vector<double>(2,0.));
+
+      casacore::CoordinateSystem coords;
+      coords.addCoordinate(linear);
+
+      coords.addCoordinate(casacore::SpectralCoordinate(casacore::MFrequency::TOPO,
+        1.e9, 1.e8, 0.0));
+      return coords;
+   }
+
+private:
+   /// @brief method to access image
+   boost::shared_ptr<IImageAccess<casacore::Float> > itsImageAccessor;
+   /// @brief the same accessor with the memory-specific interface
+   boost::shared_ptr<MemoryImageAccess<casacore::Float> > itsMemoryAccessor;
+};
+
+} // namespace accessors
+
+} // namespace askap
@@ -0,0 +1,188 @@
+/// @file
+///
+/// Unit test for the staged image access code
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+
+#include <askap/imageaccess/StagedImageAccess.h>
+#include <askap/imageaccess/ImageDrain.h>
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/coordinates/Coordinates/LinearCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+class StagedImageAccessTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(StagedImageAccessTest);
+   CPPUNIT_TEST(testStageAndDrain);
+   CPPUNIT_TEST(testDrainOnDestruction);
+   CPPUNIT_TEST(testCopyVerified);
+   CPPUNIT_TEST_EXCEPTION(testDrainUnstaged, AskapError);
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void setUp() {
+      ImageDrain::removeAll("tmp.staging");
+      ImageDrain::removeAll("tmp.stagedimage");
+      ImageDrain::removeAll("tmp.stagedfile");
+      ImageDrain::removeAll("tmp.stagedfile.copy");
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","casa");
+      parset.add("imagestaging.dir","tmp.staging");
+      parset.add("imagestaging.maxdrains","1");
+      itsImageAccessor = imageAccessFactory(parset);
+      itsStagedAccessor = boost::dynamic_pointer_cast<StagedImageAccess<casacore::Float> >(itsImageAccessor);
+   }
+
+   void tearDown() {
+      itsStagedAccessor.reset();
+      itsImageAccessor.reset();
+   }
+
+   void testStageAndDrain() {
+      CPPUNIT_ASSERT(itsStagedAccessor);
+      const std::string name = "tmp.stagedimage";
+      const casacore::IPosition shape(3,10,10,2);
+      itsImageAccessor->create(name, shape, makeCoords());
+      CPPUNIT_ASSERT(itsStagedAccessor->drainState(name) == ImageDrain::STAGED);
+      casacore::Array<float> arr(shape);
+      arr.set(1.);
+      itsImageAccessor->write(name, arr);
+      itsImageAccessor->setUnits(name, "Jy/beam");
+      // the image lives in the staging directory until it is drained
+      CPPUNIT_ASSERT(!exists(name));
+      CPPUNIT_ASSERT(itsImageAccessor->shape(name) == shape);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1., itsImageAccessor->read(name)(casacore::IPosition(3,5,5,1)), 1e-7);
+
+      itsStagedAccessor->drain(name);
+      CPPUNIT_ASSERT(itsStagedAccessor->waitDurable(name, 60.));
+      CPPUNIT_ASSERT(itsStagedAccessor->isDurable(name));
+      CPPUNIT_ASSERT(itsStagedAccessor->drainError(name) == "");
+      CPPUNIT_ASSERT(itsStagedAccessor->bytesDrained() > size_t(shape.product()) * sizeof(float));
+      CPPUNIT_ASSERT(exists(name));
+      CPPUNIT_ASSERT(itsStagedAccessor->waitAll());
+      // the staged copy is removed (the first image staged gets the prefix 0)
+      CPPUNIT_ASSERT(exists("tmp.staging"));
+      CPPUNIT_ASSERT(!exists("tmp.staging/0_" + name));
+
+      // the durable image is read at its final name, also by other accessors
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), itsImageAccessor->getUnits(name));
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","casa");
+      const boost::shared_ptr<IImageAccess<casacore::Float> > plain = imageAccessFactory(parset);
+      CPPUNIT_ASSERT(plain->shape(name) == shape);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(1., plain->read(name)(casacore::IPosition(3,9,9,1)), 1e-7);
+      CPPUNIT_ASSERT_EQUAL(std::string("Jy/beam"), plain->getUnits(name));
+   }
+
+   void testDrainOnDestruction() {
+      const std::string name = "tmp.stagedimage";
+      itsImageAccessor->create(name, casacore::IPosition(3,4,4,1), makeCoords());
+      itsImageAccessor->write(name, casacore::Array<float>(casacore::IPosition(3,4,4,1), 3.));
+      CPPUNIT_ASSERT(!exists(name));
+      // the accessor drains the staged images and waits for the transfers
+      itsStagedAccessor.reset();
+      itsImageAccessor.reset();
+      CPPUNIT_ASSERT(exists(name));
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","casa");
+      const boost::shared_ptr<IImageAccess<casacore::Float> > plain = imageAccessFactory(parset);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(3., plain->read(name)(casacore::IPosition(3,2,2,0)), 1e-7);
+   }
+
+   void testCopyVerified() {
+      {
+        std::ofstream os("tmp.stagedfile");
+        for (int i = 0; i < 1000; ++i) {
+             os << i << std::endl;
+        }
+      }
+      const size_t bytes = ImageDrain::copyVerified("tmp.stagedfile", "tmp.stagedfile.copy");
+      struct stat info;
+      CPPUNIT_ASSERT(::stat("tmp.stagedfile.copy", &info) == 0);
+      CPPUNIT_ASSERT_EQUAL(size_t(info.st_size), bytes);
+      ImageDrain::removeAll("tmp.stagedfile");
+      ImageDrain::removeAll("tmp.stagedfile.copy");
+      CPPUNIT_ASSERT(!exists("tmp.stagedfile"));
+      CPPUNIT_ASSERT(!exists("tmp.stagedfile.copy"));
+   }
+
+   void testDrainUnstaged() {
+      // only the images created through the accessor can be drained
+      itsStagedAccessor->drain("tmp.stagedimage");
+   }
+
+protected:
+   static bool exists(const std::string &name) {
+      struct stat info;
+      return ::stat(name.c_str(), &info) == 0;
+   }
+
+   casacore::CoordinateSystem makeCoords() {
+      casacore::Vector<casacore::String> names(2);
+      names[0]="x"; names[1]="y";
+      casacore::Vector<double> increment(2 ,1.);
+
+      casacore::Matrix<double> xform(2,2,0.);
+      xform.diagonal() = 1.;
+      casacore::LinearCoordinate linear(names, casacore::Vector<casacore::String>(2,"pixel"),
+             casacore::Vector<double>(2,0.),increment, xform, casacore::Vector<double>(2,0.));
+
+      casacore::CoordinateSystem coords;
+      coords.addCoordinate(linear);
+
+      coords.addCoordinate(casacore::SpectralCoordinate(casacore::MFrequency::TOPO,
+        1.e9, 1.e8, 0.0));
+      return coords;
+   }
+
+private:
+   /// @brief method to access image
+   boost::shared_ptr<IImageAccess<casacore::Float> > itsImageAccessor;
+   /// @brief the same accessor with the staging-specific interface
+   boost::shared_ptr<StagedImageAccess<casacore::Float> > itsStagedAccessor;
+};
+
+} // namespace accessors
+
+} // namespace askap
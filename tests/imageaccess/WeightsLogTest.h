@@ -48,6 +48,7 @@ class WeightsLogTest : public CppUnit::TestFixture
    CPPUNIT_TEST_SUITE(WeightsLogTest);
    CPPUNIT_TEST(testCreate);
    CPPUNIT_TEST(testReadWrite);
+   CPPUNIT_TEST(testBinaryReadWrite);
    CPPUNIT_TEST_SUITE_END();
 public:
     void setUp() {
@@ -67,14 +68,15 @@ public:
         CPPUNIT_ASSERT(itsWeightsLog.filename() == name);
 
         // fill with values
-        std::map<unsigned int, float>& mywts = itsWeightsLog.weightslist();
-        mywts[0] = 10.;
-        mywts[1] = 11.;
-        mywts[2] = 12.;
+        itsWeightsLog.setWeight(0, 10.);
+        itsWeightsLog.setWeight(1, 11.);
+        itsWeightsLog.setWeight(2, 12.);
 
         CPPUNIT_ASSERT(itsWeightsLog.weight(1) == 11.);
         CPPUNIT_ASSERT(itsWeightsLog.weight(2) == 12.);
         CPPUNIT_ASSERT(itsWeightsLog.weight(3) == 0.);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), itsWeightsLog.nChannels());
+        CPPUNIT_ASSERT_EQUAL(size_t(3), itsWeightsLog.weightslist().size());
     }
 
     void testReadWrite() {
@@ -84,7 +86,8 @@ public:
         itsWeightsLog.write();
 
         // Make sure it is empty
-        itsWeightsLog.weightslist().clear();
+        itsWeightsLog.clear();
+        CPPUNIT_ASSERT_EQUAL(size_t(0), itsWeightsLog.nChannels());
 
         // Read weights log
         itsWeightsLog.read();
@@ -93,6 +96,37 @@ public:
         CPPUNIT_ASSERT(itsWeightsLog.weight(2) == 12.);
    }
 
+    void testBinaryReadWrite() {
+        LOFAR::ParameterSet parset;
+        const std::string name = "weightslog.test.bin";
+        parset.add("WeightsLog",name);
+        parset.add("WeightsLogFormat","binary");
+        itsWeightsLog = WeightsLog(parset);
+        CPPUNIT_ASSERT(itsWeightsLog.binary());
+
+        // sparse channels to check the mask
+        itsWeightsLog.setWeight(1, 11.);
+        itsWeightsLog.setWeight(7, 17.);
+        itsWeightsLog.setWeight(20000, 0.5);
+        itsWeightsLog.write();
+        itsWeightsLog.clear();
+
+        // the format is recognised on reading
+        itsWeightsLog = WeightsLog(name);
+        CPPUNIT_ASSERT(!itsWeightsLog.binary());
+        itsWeightsLog.read();
+        CPPUNIT_ASSERT_EQUAL(size_t(20001), itsWeightsLog.nChannels());
+        CPPUNIT_ASSERT(itsWeightsLog.hasChannel(1));
+        CPPUNIT_ASSERT(!itsWeightsLog.hasChannel(2));
+        CPPUNIT_ASSERT(itsWeightsLog.hasChannel(20000));
+        CPPUNIT_ASSERT(!itsWeightsLog.hasChannel(20001));
+        CPPUNIT_ASSERT(itsWeightsLog.weight(1) == 11.);
+        CPPUNIT_ASSERT(itsWeightsLog.weight(7) == 17.);
+        CPPUNIT_ASSERT(itsWeightsLog.weight(20000) == 0.5);
+        CPPUNIT_ASSERT(itsWeightsLog.weight(0) == 0.);
+        CPPUNIT_ASSERT_EQUAL(size_t(3), itsWeightsLog.weightslist().size());
+   }
+
 private:
    WeightsLog itsWeightsLog;
 };
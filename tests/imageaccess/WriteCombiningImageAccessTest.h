@@ -0,0 +1,189 @@
+/// @file
+///
+/// Unit test for the write-combining image access code
+///
+///
+/// @copyright (c) 2026 CSIRO
+/// Australia Telescope National Facility (ATNF)
+/// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+/// PO Box 76, Epping NSW 1710, Australia
+/// atnf-enquiries@csiro.au
+///
+/// This file is part of the ASKAP software distribution.
+///
+/// The ASKAP software distribution is free software: you can redistribute it
+/// and/or modify it under the terms of the GNU General Public License as
+/// published by the Free Software Foundation; either version 2 of the License,
+/// or (at your option) any later version.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program; if not, write to the Free Software
+/// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+///
+/// @author Max Voronkov <maxim.voronkov@csiro.au>
+///
+
+
+#include <askap/imageaccess/WriteCombiningImageAccess.h>
+#include <askap/imageaccess/MemoryImageAccess.h>
+#include <askap/imageaccess/ImageAccessFactory.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/coordinates/Coordinates/LinearCoordinate.h>
+#include <casacore/coordinates/Coordinates/SpectralCoordinate.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+
+#include <Common/ParameterSet.h>
+
+namespace askap {
+
+namespace accessors {
+
+class WriteCombiningImageAccessTest : public CppUnit::TestFixture
+{
+   CPPUNIT_TEST_SUITE(WriteCombiningImageAccessTest);
+   CPPUNIT_TEST(testCombinePlanes);
+   CPPUNIT_TEST(testFlushOnRead);
+   CPPUNIT_TEST(testNotContinued);
+   CPPUNIT_TEST(testFactory);
+   CPPUNIT_TEST_SUITE_END();
+public:
+   void setUp() {
+      itsMemoryAccessor.reset(new MemoryImageAccess<casacore::Float>());
+      // blocks of 4 planes of 10x10 pixels
+      itsCombiningAccessor.reset(new WriteCombiningImageAccess<casacore::Float>(itsMemoryAccessor, 400));
+      itsMemoryAccessor->create(theName, theShape, makeCoords());
+      itsMemoryAccessor->write(theName, casacore::Array<float>(theShape, -1.));
+   }
+
+   void tearDown() {
+      itsCombiningAccessor.reset();
+      itsMemoryAccessor.reset();
+   }
+
+   void testCombinePlanes() {
+      // blocks are [0,4), [4,8) and [8,10) along the last axis
+      for (int plane = 0; plane < theShape(2); ++plane) {
+           writePlane(plane);
+           if (plane == 2) {
+               // nothing is written until the first block is complete
+               CPPUNIT_ASSERT_EQUAL(size_t(0), itsCombiningAccessor->blocksWritten());
+               CPPUNIT_ASSERT_DOUBLES_EQUAL(-1., itsMemoryAccessor->read(theName)(casacore::IPosition(3,5,5,0)), 1e-7);
+           }
+      }
+      CPPUNIT_ASSERT_EQUAL(size_t(10), itsCombiningAccessor->slicesCombined());
+      CPPUNIT_ASSERT_EQUAL(size_t(3), itsCombiningAccessor->blocksWritten());
+      checkPlanes(*itsMemoryAccessor, theShape(2));
+   }
+
+   void testFlushOnRead() {
+      writePlane(0);
+      writePlane(1);
+      CPPUNIT_ASSERT_EQUAL(size_t(0), itsCombiningAccessor->blocksWritten());
+      // the partially filled block is written before the read
+      const casacore::Array<float> plane = itsCombiningAccessor->read(theName, casacore::IPosition(3,0,0,1),
+                                                                      casacore::IPosition(3,9,9,1));
+      CPPUNIT_ASSERT_EQUAL(size_t(1), itsCombiningAccessor->blocksWritten());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2., plane(casacore::IPosition(3,3,4,0)), 1e-7);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-1., itsMemoryAccessor->read(theName)(casacore::IPosition(3,3,4,2)), 1e-7);
+      // the block written doesn't extend past the planes given
+      writePlane(2);
+      itsCombiningAccessor->flush();
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsCombiningAccessor->blocksWritten());
+      checkPlanes(*itsMemoryAccessor, 3);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(-1., itsMemoryAccessor->read(theName)(casacore::IPosition(3,3,4,3)), 1e-7);
+   }
+
+   void testNotContinued() {
+      writePlane(0);
+      // a gap along the stacking axis starts a new block
+      writePlane(2);
+      CPPUNIT_ASSERT_EQUAL(size_t(1), itsCombiningAccessor->blocksWritten());
+      // the full image is written straight away
+      itsCombiningAccessor->write(theName, casacore::Array<float>(theShape, 5.));
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsCombiningAccessor->blocksWritten());
+      CPPUNIT_ASSERT_EQUAL(size_t(2), itsCombiningAccessor->slicesCombined());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(5., itsMemoryAccessor->read(theName)(casacore::IPosition(3,1,1,2)), 1e-7);
+      // the buffered planes are written when the accessor is destroyed
+      writePlane(8);
+      itsCombiningAccessor.reset();
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(9., itsMemoryAccessor->read(theName)(casacore::IPosition(3,1,1,8)), 1e-7);
+   }
+
+   void testFactory() {
+      LOFAR::ParameterSet parset;
+      parset.add("imagetype","memory");
+      CPPUNIT_ASSERT(!boost::dynamic_pointer_cast<WriteCombiningImageAccess<casacore::Float> >(imageAccessFactory(parset)));
+      parset.add("imagewritebuffer","1");
+      const boost::shared_ptr<WriteCombiningImageAccess<casacore::Float> > accessor =
+          boost::dynamic_pointer_cast<WriteCombiningImageAccess<casacore::Float> >(imageAccessFactory(parset));
+      CPPUNIT_ASSERT(accessor);
+      CPPUNIT_ASSERT_EQUAL(size_t(262144), accessor->maxPixels());
+   }
+
+protected:
+   /// @brief write a plane through the write-combining accessor
+   /// @details Pixels of the plane are set to the plane number plus one.
+   /// @param[in] plane plane number
+   void writePlane(int plane) {
+      const casacore::IPosition planeShape(3, theShape(0), theShape(1), 1);
+      itsCombiningAccessor->write(theName, casacore::Array<float>(planeShape, plane + 1.),
+                                  casacore::IPosition(3, 0, 0, plane));
+   }
+
+   /// @brief check the planes written by writePlane
+   /// @param[in] accessor accessor to read the pixels with
+   /// @param[in] nPlanes number of planes to check
+   static void checkPlanes(const IImageAccess<casacore::Float> &accessor, int nPlanes) {
+      const casacore::Array<float> pixels = accessor.read(theName);
+      for (int plane = 0; plane < nPlanes; ++plane) {
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(plane + 1., pixels(casacore::IPosition(3,0,0,plane)), 1e-7);
+           CPPUNIT_ASSERT_DOUBLES_EQUAL(plane + 1., pixels(casacore::IPosition(3,9,9,plane)), 1e-7);
+      }
+   }
+
+   casacore::CoordinateSystem makeCoords() {
+      casacore::Vector<casacore::String> names(2);
+      names[0]="x"; names[1]="y";
+      casacore::Vector<double> increment(2 ,1.);
+
+      casacore::Matrix<double> xform(2,2,0.);
+      xform.diagonal() = 1.;
+      casacore::LinearCoordinate linear(names, casacore::Vector<casacore::String>(2,"pixel"),
+             casacore::Vector<double>(2,0.),increment, xform, casacore::Vector<double>(2,0.));
+
+      casacore::CoordinateSystem coords;
+      coords.addCoordinate(linear);
+
+      coords.addCoordinate(casacore::SpectralCoordinate(casacore::MFrequency::TOPO,
+        1.e9, 1.e8, 0.0));
+      return coords;
+   }
+
+private:
+   /// @brief name of the test image
+   static const std::string theName;
+   /// @brief shape of the test image
+   static const casacore::IPosition theShape;
+   /// @brief accessor holding the image
+   boost::shared_ptr<IImageAccess<casacore::Float> > itsMemoryAccessor;
+   /// @brief accessor combining the planes written
+   boost::shared_ptr<WriteCombiningImageAccess<casacore::Float> > itsCombiningAccessor;
+};
+
+const std::string WriteCombiningImageAccessTest::theName = "tmp.combinedimage";
+const casacore::IPosition WriteCombiningImageAccessTest::theShape(3, 10, 10, 10);
+
+} // namespace accessors
+
+} // namespace askap
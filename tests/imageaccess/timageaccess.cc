@@ -28,7 +28,11 @@
 // Test includes
 #include "CasaImageAccessTest.h"
 #include "FitsImageAccessTest.h"
+#include "Hdf5ImageAccessTest.h"
+#include "MemoryImageAccessTest.h"
+#include "StagedImageAccessTest.h"
 #include "WeightsLogTest.h"
+#include "WriteCombiningImageAccessTest.h"
 
 
 
@@ -50,7 +54,11 @@ int main(int argc, char *argv[])
     askapdev::testutils::AskapTestRunner runner(argv[0]);
     runner.addTest( askap::accessors::CasaImageAccessTest::suite());
     runner.addTest( askap::accessors::FitsImageAccessTest::suite());
+    runner.addTest( askap::accessors::Hdf5ImageAccessTest::suite());
+    runner.addTest( askap::accessors::MemoryImageAccessTest::suite());
+    runner.addTest( askap::accessors::StagedImageAccessTest::suite());
     runner.addTest( askap::accessors::WeightsLogTest::suite());
+    runner.addTest( askap::accessors::WriteCombiningImageAccessTest::suite());
     bool wasSuccessful = runner.run();
 
     return wasSuccessful ? 0 : 1;
@@ -33,9 +33,16 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <cmath>
 
 // Classes to test
 #include "askap/votable/VOTable.h"
+#include "askap/votable/VOTableArrow.h"
+#include "askap/votable/VOTableReader.h"
+#include "askap/votable/VOTableWriter.h"
+#include "askap/votable/VOTableBinary.h"
+#include "askap/votable/VOTableIndex.h"
+#include "askap/votable/VOTableStream.h"
 
 using namespace std;
 
@@ -46,6 +53,17 @@ class VOTableTest : public CppUnit::TestFixture {
         CPPUNIT_TEST_SUITE(VOTableTest);
         CPPUNIT_TEST(testDescription);
         CPPUNIT_TEST(testXML);
+        CPPUNIT_TEST(testStreamingReader);
+        CPPUNIT_TEST(testRowCallback);
+        CPPUNIT_TEST(testStreamingWriter);
+        CPPUNIT_TEST(testBase64);
+        CPPUNIT_TEST(testBinary);
+        CPPUNIT_TEST(testColumns);
+        CPPUNIT_TEST(testMoveAndReferences);
+        CPPUNIT_TEST(testParallelParsing);
+        CPPUNIT_TEST(testIndexes);
+        CPPUNIT_TEST(testCompressedFiles);
+        CPPUNIT_TEST(testArrow);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -132,7 +150,598 @@ class VOTableTest : public CppUnit::TestFixture {
             CPPUNIT_ASSERT(rows[1].getCells()[1] == "4.0");
         }
 
+        void testStreamingReader() {
+            const VOTable vot1 = makeTable();
+            std::stringstream ss;
+            vot1.toXML(ss);
+            ss.seekg(0, ios::beg);
+            VOTableReader reader;
+            const VOTable vot2 = reader.read(ss);
+            CPPUNIT_ASSERT_EQUAL(2ul, reader.rowCount());
+
+            CPPUNIT_ASSERT(vot2.getDescription() == vot1.getDescription());
+            CPPUNIT_ASSERT_EQUAL(0ul, vot2.getInfo().size());
+            CPPUNIT_ASSERT_EQUAL(1ul, vot2.getResource().size());
+            const VOTableResource res2 = vot2.getResource()[0];
+            CPPUNIT_ASSERT(res2.getName() == "Test Resource");
+            CPPUNIT_ASSERT_EQUAL(1ul, res2.getTables().size());
+            const VOTableTable vottab2 = res2.getTables()[0];
+            CPPUNIT_ASSERT(vottab2.getName() == "tabletablename");
+            CPPUNIT_ASSERT(vottab2.getDescription() == "tabletabledesc");
+
+            const std::vector<VOTableGroup> groups = vottab2.getGroups();
+            CPPUNIT_ASSERT_EQUAL(1ul, groups.size());
+            CPPUNIT_ASSERT_EQUAL(2ul, groups[0].getFieldRefs().size());
+            const std::vector<VOTableParam> params = groups[0].getParams();
+            CPPUNIT_ASSERT_EQUAL(1ul, params.size());
+            CPPUNIT_ASSERT(params[0].getValue() == "UTC-ICRS-TOPO");
+
+            const std::vector<VOTableField> fields = vottab2.getFields();
+            CPPUNIT_ASSERT_EQUAL(2ul, fields.size());
+            CPPUNIT_ASSERT(fields[0].getName() == "RA");
+            CPPUNIT_ASSERT(fields[1].getID() == "col2");
+            CPPUNIT_ASSERT(fields[1].getUnit() == "deg");
+
+            const std::vector<VOTableRow> rows = vottab2.getRows();
+            CPPUNIT_ASSERT_EQUAL(2ul, rows.size());
+            CPPUNIT_ASSERT(rows[0].getCells()[0] == "1.0");
+            CPPUNIT_ASSERT(rows[0].getCells()[1] == "2.0");
+            CPPUNIT_ASSERT(rows[1].getCells()[0] == "3.0");
+            CPPUNIT_ASSERT(rows[1].getCells()[1] == "4.0");
+
+            // malformed document
+            std::stringstream bad("<VOTABLE><RESOURCE></VOTABLE>");
+            CPPUNIT_ASSERT_THROW(reader.read(bad), askap::AskapError);
+        }
+
+        void testRowCallback() {
+            const VOTable vot1 = makeTable();
+            std::stringstream ss;
+            vot1.toXML(ss);
+            ss.seekg(0, ios::beg);
+            std::vector<std::string> cells;
+            VOTableReader reader((RowCollector(cells)));
+            const VOTable vot2 = reader.read(ss);
+            CPPUNIT_ASSERT_EQUAL(2ul, reader.rowCount());
+            // rows are not kept in the table
+            CPPUNIT_ASSERT_EQUAL(1ul, vot2.getResource().size());
+            CPPUNIT_ASSERT_EQUAL(0ul, vot2.getResource()[0].getTables()[0].getRows().size());
+            CPPUNIT_ASSERT_EQUAL(2ul, vot2.getResource()[0].getTables()[0].getFields().size());
+            CPPUNIT_ASSERT_EQUAL(4ul, cells.size());
+            CPPUNIT_ASSERT(cells[0] == "RA=1.0");
+            CPPUNIT_ASSERT(cells[1] == "Dec=2.0");
+            CPPUNIT_ASSERT(cells[2] == "RA=3.0");
+            CPPUNIT_ASSERT(cells[3] == "Dec=4.0");
+        }
+
+        void testStreamingWriter() {
+            const VOTable vot1 = makeTable();
+            const VOTableResource res1 = vot1.getResource()[0];
+            const VOTableTable vottab1 = res1.getTables()[0];
+            const std::vector<VOTableRow> rows1 = vottab1.getRows();
+            // the header is written without rows, they are pushed one by one
+            VOTableTable header;
+            header.setName(vottab1.getName());
+            header.setDescription(vottab1.getDescription());
+            header.addGroup(vottab1.getGroups()[0]);
+            const std::vector<VOTableField> fields1 = vottab1.getFields();
+            for (size_t i = 0; i < fields1.size(); ++i) {
+                header.addField(fields1[i]);
+            }
+
+            std::stringstream ss;
+            {
+                VOTableWriter writer(ss, vot1.getDescription());
+                VOTableInfo info;
+                info.setName("note");
+                info.setText("a < b & c");
+                writer.addInfo(info);
+                writer.beginResource(res1);
+                writer.beginTable(header);
+                for (size_t i = 0; i < rows1.size(); ++i) {
+                    writer.addRow(rows1[i]);
+                }
+                VOTableRow special;
+                special.addCell("<5");
+                special.addCell("\"A&B\"");
+                writer.addRow(special);
+                CPPUNIT_ASSERT_EQUAL(3ul, writer.rowCount());
+                writer.endTable();
+                CPPUNIT_ASSERT_THROW(writer.addRow(special), askap::AskapError);
+                // the destructor closes the resource and the VOTable
+            }
+
+            ss.seekg(0, ios::beg);
+            const VOTable vot2 = VOTable::fromXML(ss);
+            CPPUNIT_ASSERT(vot2.getDescription() == vot1.getDescription());
+            CPPUNIT_ASSERT_EQUAL(1ul, vot2.getInfo().size());
+            CPPUNIT_ASSERT(vot2.getInfo()[0].getText() == "a < b & c");
+            CPPUNIT_ASSERT_EQUAL(1ul, vot2.getResource().size());
+            CPPUNIT_ASSERT(vot2.getResource()[0].getName() == "Test Resource");
+            const VOTableTable vottab2 = vot2.getResource()[0].getTables()[0];
+            CPPUNIT_ASSERT(vottab2.getName() == "tabletablename");
+            CPPUNIT_ASSERT(vottab2.getDescription() == "tabletabledesc");
+            CPPUNIT_ASSERT_EQUAL(1ul, vottab2.getGroups().size());
+            CPPUNIT_ASSERT_EQUAL(2ul, vottab2.getGroups()[0].getFieldRefs().size());
+            CPPUNIT_ASSERT(vottab2.getGroups()[0].getParams()[0].getValue() == "UTC-ICRS-TOPO");
+            const std::vector<VOTableField> fields2 = vottab2.getFields();
+            CPPUNIT_ASSERT_EQUAL(2ul, fields2.size());
+            CPPUNIT_ASSERT(fields2[0].getUCD() == "pos.eq.ra;meta.main");
+            CPPUNIT_ASSERT(fields2[1].getUType() == "stc:AstroCoords.Position2D.Value2.C2");
+            const std::vector<VOTableRow> rows2 = vottab2.getRows();
+            CPPUNIT_ASSERT_EQUAL(3ul, rows2.size());
+            CPPUNIT_ASSERT(rows2[0].getCells()[0] == "1.0");
+            CPPUNIT_ASSERT(rows2[1].getCells()[1] == "4.0");
+            CPPUNIT_ASSERT(rows2[2].getCells()[0] == "<5");
+            CPPUNIT_ASSERT(rows2[2].getCells()[1] == "\"A&B\"");
+
+            // the streaming reader understands the output as well
+            ss.clear();
+            ss.seekg(0, ios::beg);
+            VOTableReader reader;
+            const VOTable vot3 = reader.read(ss);
+            CPPUNIT_ASSERT_EQUAL(3ul, reader.rowCount());
+            CPPUNIT_ASSERT(vot3.getResource()[0].getTables()[0].getRows()[2].getCells()[0] == "<5");
+        }
+
+        void testBase64() {
+            const std::string data("\0\x01\xfe\xffabc", 7);
+            const std::string encoded = VOTableBinary::base64Encode(data.data(), data.size());
+            CPPUNIT_ASSERT(encoded == "AAH+/2FiYw==");
+            // decoding in pieces, with white space
+            const std::string text = "AAH+\n/2Fi  Yw==\n";
+            std::string pending, decoded;
+            for (size_t pos = 0; pos < text.size(); pos += 3) {
+                VOTableBinary::base64Decode(text.data() + pos, std::min<size_t>(3, text.size() - pos),
+                                            pending, decoded);
+            }
+            CPPUNIT_ASSERT(pending.empty());
+            CPPUNIT_ASSERT(decoded == data);
+            CPPUNIT_ASSERT_THROW(VOTableBinary::base64Decode("AA*A", 4, pending, decoded), askap::AskapError);
+        }
+
+        void testBinary() {
+            for (int binary2 = 0; binary2 < 2; ++binary2) {
+                const VOTableTable::DataFormat format = binary2 ? VOTableTable::BINARY2 : VOTableTable::BINARY;
+                const VOTable vot1 = makeBinaryTable(format);
+                const std::vector<VOTableRow> rows1 = vot1.getResource()[0].getTables()[0].getRows();
+
+                // DOM based serialisation
+                std::stringstream ss;
+                vot1.toXML(ss);
+                CPPUNIT_ASSERT(ss.str().find("<TD>") == std::string::npos);
+                ss.seekg(0, ios::beg);
+                const VOTableTable tab2 = VOTable::fromXML(ss).getResource()[0].getTables()[0];
+                CPPUNIT_ASSERT_EQUAL(format, tab2.getDataFormat());
+                checkBinaryRows(rows1, tab2.getRows());
+
+                // streaming serialisation
+                std::stringstream ss2;
+                {
+                    VOTableWriter writer(ss2);
+                    writer.beginResource(vot1.getResource()[0]);
+                    VOTableTable header;
+                    const std::vector<VOTableField> fields = vot1.getResource()[0].getTables()[0].getFields();
+                    for (size_t i = 0; i < fields.size(); ++i) {
+                        header.addField(fields[i]);
+                    }
+                    header.setDataFormat(format);
+                    writer.beginTable(header);
+                    for (size_t i = 0; i < rows1.size(); ++i) {
+                        writer.addRow(rows1[i]);
+                    }
+                    writer.close();
+                }
+                ss2.seekg(0, ios::beg);
+                VOTableReader reader;
+                const VOTableTable tab3 = reader.read(ss2).getResource()[0].getTables()[0];
+                CPPUNIT_ASSERT_EQUAL(format, tab3.getDataFormat());
+                CPPUNIT_ASSERT_EQUAL(rows1.size(), reader.rowCount());
+                checkBinaryRows(rows1, tab3.getRows());
+            }
+        }
+
+        void testColumns() {
+            const VOTable vot = makeBinaryTable(VOTableTable::TABLEDATA);
+            const VOTableTable tab = vot.getResource()[0].getTables()[0];
+            CPPUNIT_ASSERT_EQUAL(3ul, tab.getNRows());
+            CPPUNIT_ASSERT_EQUAL(8ul, tab.getNColumns());
+            CPPUNIT_ASSERT_EQUAL(VOTableColumn::STRING, tab.getColumn("name").getType());
+            CPPUNIT_ASSERT_EQUAL(VOTableColumn::REAL, tab.getColumn("ra").getType());
+            CPPUNIT_ASSERT_EQUAL(VOTableColumn::INTEGER, tab.getColumn("npix").getType());
+            CPPUNIT_ASSERT_EQUAL(VOTableColumn::BOOLEAN, tab.getColumn("resolved").getType());
+            // arrays and complex values are kept as strings
+            CPPUNIT_ASSERT_EQUAL(VOTableColumn::STRING, tab.getColumn("shape").getType());
+            CPPUNIT_ASSERT_EQUAL(VOTableColumn::STRING, tab.getColumn("gain").getType());
+
+            const std::vector<double>& ra = tab.getColumn("ra").getReals();
+            CPPUNIT_ASSERT_EQUAL(3ul, ra.size());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(187.123456789012, ra[0], 1e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(-1e-10, ra[1], 1e-20);
+            CPPUNIT_ASSERT(std::isnan(ra[2]));
+            CPPUNIT_ASSERT(tab.getColumn("ra").isNull(2));
+            CPPUNIT_ASSERT(!tab.getColumn("npix").isNull(2));
+            CPPUNIT_ASSERT_EQUAL(-42ll, tab.getColumn("npix").getIntegers()[0]);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(7., tab.getColumn(3).getDouble(1), 1e-12);
+            CPPUNIT_ASSERT_EQUAL('F', tab.getColumn("resolved").getBooleans()[1]);
+            CPPUNIT_ASSERT_THROW(tab.getColumn("ra").getIntegers(), askap::AskapError);
+            CPPUNIT_ASSERT_THROW(tab.getColumn("nosuchfield"), askap::AskapError);
+
+            // the text of the cells is preserved
+            VOTableTable tab2;
+            VOTableField f;
+            f.setName("flux");
+            f.setDatatype("double");
+            tab2.addField(f);
+            const char* cells[] = {"1.0", "0.500", "1e5", "N/A", "42", "3.14159265358979"};
+            for (size_t i = 0; i < 6; ++i) {
+                VOTableRow row;
+                row.addCell(cells[i]);
+                tab2.addRow(row);
+            }
+            // a row with a cell beyond the fields and an empty row
+            VOTableRow wide;
+            wide.addCell("2.5");
+            wide.addCell("extra");
+            tab2.addRow(wide);
+            tab2.addRow(VOTableRow());
+            CPPUNIT_ASSERT_EQUAL(8ul, tab2.getNRows());
+            CPPUNIT_ASSERT_EQUAL(2ul, tab2.getNColumns());
+            const std::vector<VOTableRow> rows = tab2.getRows();
+            for (size_t i = 0; i < 6; ++i) {
+                CPPUNIT_ASSERT_EQUAL(1ul, rows[i].getCells().size());
+                CPPUNIT_ASSERT_EQUAL(std::string(cells[i]), rows[i].getCells()[0]);
+            }
+            CPPUNIT_ASSERT_EQUAL(2ul, rows[6].getCells().size());
+            CPPUNIT_ASSERT(rows[6].getCells()[1] == "extra");
+            CPPUNIT_ASSERT_EQUAL(0ul, rows[7].getCells().size());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, tab2.getColumn(0).getReals()[1], 1e-12);
+            CPPUNIT_ASSERT(std::isnan(tab2.getColumn(0).getReals()[3]));
+        }
+
+        void testMoveAndReferences() {
+            VOTable vot = makeBinaryTable(VOTableTable::TABLEDATA);
+            // getters return references to the stored collections
+            const VOTableResource& res = vot.getResource()[0];
+            CPPUNIT_ASSERT(&res == &vot.getResource()[0]);
+            const VOTableTable& tab = res.getTables()[0];
+            CPPUNIT_ASSERT(&tab.getFields() == &res.getTables()[0].getFields());
+
+            // the row is reused, short rows shrink it
+            VOTableRow row;
+            tab.getRow(0, row);
+            CPPUNIT_ASSERT_EQUAL(8ul, row.getCells().size());
+            CPPUNIT_ASSERT(row.getCells()[0] == "J1234-5678");
+            tab.getRow(1, row);
+            CPPUNIT_ASSERT(row.getCells()[0] == "<&>");
+            CPPUNIT_ASSERT(row.getCells()[7] == "abcd");
+            CPPUNIT_ASSERT_THROW(tab.getRow(3, row), askap::AskapError);
+
+            // objects added by rvalue reference are moved
+            VOTableTable tab2;
+            VOTableField f;
+            f.setName("name");
+            f.setDatatype("char");
+            f.setArraysize("*");
+            tab2.addField(std::move(f));
+            VOTableRow longRow;
+            longRow.addCell(std::string(100, 'x'));
+            longRow.addCell("extra");
+            tab2.addRow(std::move(longRow));
+            VOTableRow shortRow;
+            tab2.addRow(std::move(shortRow));
+            CPPUNIT_ASSERT_EQUAL(2ul, tab2.getNRows());
+            CPPUNIT_ASSERT_EQUAL(std::string(100, 'x'), tab2.getColumn("name").getStrings()[0]);
+            tab2.getRow(0, row);
+            CPPUNIT_ASSERT_EQUAL(2ul, row.getCells().size());
+            CPPUNIT_ASSERT(row.getCells()[1] == "extra");
+            tab2.getRow(1, row);
+            CPPUNIT_ASSERT_EQUAL(0ul, row.getCells().size());
+
+            VOTableResource res2;
+            res2.addTable(std::move(tab2));
+            vot.addResource(std::move(res2));
+            CPPUNIT_ASSERT_EQUAL(2ul, vot.getResource().size());
+            CPPUNIT_ASSERT_EQUAL(2ul, vot.getResource()[1].getTables()[0].getNRows());
+        }
+
+        void testParallelParsing() {
+            // several resources with several tables each, in both serialisations
+            VOTable vot;
+            for (size_t r = 0; r < 3; ++r) {
+                VOTableResource res;
+                res.setName("resource" + std::to_string(r));
+                for (size_t t = 0; t < 3; ++t) {
+                    VOTableTable tab = makeBinaryTable(t == 1 ? VOTableTable::BINARY2 :
+                                       VOTableTable::TABLEDATA).getResource()[0].getTables()[0];
+                    tab.setName("table" + std::to_string(r) + std::to_string(t));
+                    res.addTable(std::move(tab));
+                }
+                vot.addResource(std::move(res));
+            }
+            std::stringstream ss;
+            vot.toXML(ss);
+            const std::string xml = ss.str();
+
+            for (unsigned int nThreads = 0; nThreads < 4; ++nThreads) {
+                std::istringstream is1(xml);
+                const VOTable serial = VOTable::fromXML(is1);
+                std::istringstream is2(xml);
+                const VOTable parallel = VOTable::fromXMLParallel(is2, nThreads);
+                CPPUNIT_ASSERT_EQUAL(3ul, parallel.getResource().size());
+                for (size_t r = 0; r < 3; ++r) {
+                    const VOTableResource& res1 = serial.getResource()[r];
+                    const VOTableResource& res2 = parallel.getResource()[r];
+                    CPPUNIT_ASSERT_EQUAL(res1.getName(), res2.getName());
+                    CPPUNIT_ASSERT_EQUAL(3ul, res2.getTables().size());
+                    for (size_t t = 0; t < 3; ++t) {
+                        const VOTableTable& tab1 = res1.getTables()[t];
+                        const VOTableTable& tab2 = res2.getTables()[t];
+                        CPPUNIT_ASSERT_EQUAL(tab1.getName(), tab2.getName());
+                        CPPUNIT_ASSERT(tab1.getDataFormat() == tab2.getDataFormat());
+                        CPPUNIT_ASSERT_EQUAL(tab1.getFields().size(), tab2.getFields().size());
+                        CPPUNIT_ASSERT_EQUAL(3ul, tab2.getNRows());
+                        for (size_t row = 0; row < 3; ++row) {
+                            CPPUNIT_ASSERT(tab1.getRow(row).getCells() == tab2.getRow(row).getCells());
+                        }
+                    }
+                }
+            }
+
+            // a single table is parsed serially
+            std::stringstream ss2;
+            makeBinaryTable(VOTableTable::TABLEDATA).toXML(ss2);
+            const VOTable single = VOTable::fromXMLParallel(ss2);
+            CPPUNIT_ASSERT_EQUAL(3ul, single.getResource()[0].getTables()[0].getNRows());
+        }
+
+        void testIndexes() {
+            const char* types[][3] = {{"id", "char", "*"}, {"ra", "double", ""},
+                                      {"dec", "double", ""}, {"npix", "int", ""}};
+            VOTableTable tab;
+            for (size_t i = 0; i < 4; ++i) {
+                VOTableField f;
+                f.setName(types[i][0]);
+                f.setDatatype(types[i][1]);
+                f.setArraysize(types[i][2]);
+                tab.addField(f);
+            }
+            const char* cells[][4] = {{"a", "10.0", "-45.0", "5"}, {"b", "10.5", "-45.2", "7"},
+                                      {"c", "359.9", "0.0", ""}, {"d", "0.1", "0.05", "5"},
+                                      {"", "", "", "9"}, {"a", "180", "89.9", "-1"}};
+            for (size_t r = 0; r < 6; ++r) {
+                VOTableRow row;
+                for (size_t c = 0; c < 4; ++c) {
+                    row.addCell(cells[r][c]);
+                }
+                tab.addRow(row);
+            }
+
+            // nulls are not indexed
+            const VOTableSortedIndex sorted(tab.getColumn("npix"));
+            CPPUNIT_ASSERT_EQUAL(5ul, sorted.size());
+            const std::vector<size_t> range = sorted.findRange(5, 7);
+            CPPUNIT_ASSERT_EQUAL(3ul, range.size());
+            CPPUNIT_ASSERT_EQUAL(3ul, range[2]);
+            CPPUNIT_ASSERT_EQUAL(4ul, sorted.find(9)[0]);
+            CPPUNIT_ASSERT_THROW(VOTableSortedIndex(tab.getColumn("id")), askap::AskapError);
+
+            const VOTableHashIndex hash(tab.getColumn("id"));
+            CPPUNIT_ASSERT_EQUAL(4ul, hash.size());
+            CPPUNIT_ASSERT_EQUAL(2ul, hash.find("a").size());
+            CPPUNIT_ASSERT_EQUAL(5ul, hash.find("a")[1]);
+            CPPUNIT_ASSERT(!hash.contains(""));
+
+            // the result doesn't depend on the bucket size
+            for (double cellSize = 0.1; cellSize < 200.; cellSize *= 10.) {
+                const VOTableSkyIndex sky(tab.getColumn("ra"), tab.getColumn("dec"), cellSize);
+                CPPUNIT_ASSERT_EQUAL(5ul, sky.size());
+                CPPUNIT_ASSERT_EQUAL(2ul, sky.findCone(10.2, -45.1, 0.5).size());
+                // across ra = 0
+                const std::vector<size_t> cone = sky.findCone(0., 0., 0.2);
+                CPPUNIT_ASSERT_EQUAL(2ul, cone.size());
+                CPPUNIT_ASSERT_EQUAL(2ul, cone[0]);
+                CPPUNIT_ASSERT_EQUAL(3ul, cone[1]);
+                // close to the pole
+                CPPUNIT_ASSERT_EQUAL(5ul, sky.findCone(0., 89.95, 0.2)[0]);
+                CPPUNIT_ASSERT(sky.findCone(5., 0., 1.).empty());
+                CPPUNIT_ASSERT_EQUAL(5ul, sky.findCone(0., 0., 180.).size());
+            }
+
+            // predicates are combined by chaining the scans
+            std::vector<char> mask;
+            tab.getColumn("npix").selectRange(4, 8, mask);
+            tab.getColumn("ra").selectRange(5, 20, mask);
+            CPPUNIT_ASSERT_EQUAL(2ul, VOTableColumn::selectedRows(mask).size());
+            mask.clear();
+            tab.getColumn("id").selectEqual("a", mask);
+            CPPUNIT_ASSERT_EQUAL(5ul, VOTableColumn::selectedRows(mask)[1]);
+            mask.clear();
+            tab.getColumn("npix").selectRange(-10, 10, mask);
+            CPPUNIT_ASSERT_EQUAL(5ul, VOTableColumn::selectedRows(mask).size());
+            CPPUNIT_ASSERT_THROW(tab.getColumn("id").selectRange(0, 1, mask), askap::AskapError);
+        }
+
+        void testCompressedFiles() {
+            const VOTable vot1 = makeBinaryTable(VOTableTable::TABLEDATA);
+            const std::vector<VOTableRow> rows1 = vot1.getResource()[0].getTables()[0].getRows();
+
+            // the DOM interface, compression is chosen by the extension on output
+            vot1.toXML("unittest_votable.xml.gz");
+            CPPUNIT_ASSERT(VOTableCompression::detect("unittest_votable.xml.gz") == VOTableCompression::GZIP);
+            const VOTable vot2 = VOTable::fromXML("unittest_votable.xml.gz");
+            checkBinaryRows(rows1, vot2.getResource()[0].getTables()[0].getRows());
+            const VOTable vot3 = VOTable::fromXMLParallel("unittest_votable.xml.gz");
+            checkBinaryRows(rows1, vot3.getResource()[0].getTables()[0].getRows());
+
+            // the streaming writer and reader
+            {
+                VOTableWriter writer("unittest_votable_stream.xml.gz");
+                writer.beginResource(vot1.getResource()[0]);
+                VOTableTable header;
+                const std::vector<VOTableField> fields1 = vot1.getResource()[0].getTables()[0].getFields();
+                for (size_t i = 0; i < fields1.size(); ++i) {
+                    header.addField(fields1[i]);
+                }
+                writer.beginTable(header);
+                for (size_t i = 0; i < rows1.size(); ++i) {
+                    writer.addRow(rows1[i]);
+                }
+            }
+            CPPUNIT_ASSERT(VOTableCompression::detect("unittest_votable_stream.xml.gz") == VOTableCompression::GZIP);
+            VOTableReader reader;
+            const VOTable vot4 = reader.read("unittest_votable_stream.xml.gz");
+            CPPUNIT_ASSERT_EQUAL(rows1.size(), reader.rowCount());
+            checkBinaryRows(rows1, vot4.getResource()[0].getTables()[0].getRows());
+
+            // the content is detected on input, regardless of the extension
+            {
+                std::ifstream in("unittest_votable.xml.gz", ios::binary);
+                std::ofstream out("unittest_votable_gz.xml", ios::binary | ios::trunc);
+                out << in.rdbuf();
+            }
+            const VOTable vot5 = VOTable::fromXML("unittest_votable_gz.xml");
+            checkBinaryRows(rows1, vot5.getResource()[0].getTables()[0].getRows());
+
+            // plain files are unaffected
+            vot1.toXML("unittest_votable.xml");
+            CPPUNIT_ASSERT(VOTableCompression::detect("unittest_votable.xml") == VOTableCompression::NONE);
+            const VOTable vot6 = VOTable::fromXML("unittest_votable.xml");
+            checkBinaryRows(rows1, vot6.getResource()[0].getTables()[0].getRows());
+        }
+
+        void testArrow() {
+            const VOTable vot = makeBinaryTable(VOTableTable::TABLEDATA);
+            const boost::shared_ptr<const VOTableTable> tab(new VOTableTable(vot.getResource()[0].getTables()[0]));
+            ArrowSchema schema;
+            ArrowArray array;
+            VOTableArrow::exportTable(tab, &schema, &array);
+            CPPUNIT_ASSERT_EQUAL(std::string("+s"), std::string(schema.format));
+            CPPUNIT_ASSERT_EQUAL(std::string("binarytable"), std::string(schema.name));
+            CPPUNIT_ASSERT_EQUAL(int64_t(8), schema.n_children);
+            CPPUNIT_ASSERT_EQUAL(int64_t(3), array.length);
+            CPPUNIT_ASSERT_EQUAL(int64_t(8), array.n_children);
+            const char* formats[] = {"u", "g", "g", "l", "b", "u", "u", "u"};
+            for (size_t c = 0; c < 8; ++c) {
+                 CPPUNIT_ASSERT_EQUAL(std::string(formats[c]), std::string(schema.children[c]->format));
+                 CPPUNIT_ASSERT_EQUAL(int64_t(3), array.children[c]->length);
+            }
+            // numeric columns share the typed store of the table
+            CPPUNIT_ASSERT(array.children[1]->buffers[1] == &tab->getColumn(1).getReals()[0]);
+            CPPUNIT_ASSERT(array.children[3]->buffers[1] == &tab->getColumn(3).getIntegers()[0]);
+            const double* ra = static_cast<const double*>(array.children[1]->buffers[1]);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(187.123456789012, ra[0], 1e-12);
+            // the last row has nulls except for npix and shape
+            CPPUNIT_ASSERT_EQUAL(int64_t(1), array.children[1]->null_count);
+            CPPUNIT_ASSERT_EQUAL(int64_t(0), array.children[3]->null_count);
+            const uint8_t* validity = static_cast<const uint8_t*>(array.children[1]->buffers[0]);
+            CPPUNIT_ASSERT_EQUAL(3, int(validity[0] & 7));
+            const uint8_t* resolved = static_cast<const uint8_t*>(array.children[4]->buffers[1]);
+            CPPUNIT_ASSERT_EQUAL(1, int(resolved[0] & 3));
+            const int32_t* offsets = static_cast<const int32_t*>(array.children[0]->buffers[1]);
+            const char* text = static_cast<const char*>(array.children[0]->buffers[2]);
+            CPPUNIT_ASSERT_EQUAL(std::string("<&>"), std::string(text + offsets[1], offsets[2] - offsets[1]));
+
+            // the consumer may move a child out and release it separately
+            ArrowArray child = *array.children[2];
+            array.children[2]->release = 0;
+            child.release(&child);
+            CPPUNIT_ASSERT(child.release == 0);
+            array.release(&array);
+            CPPUNIT_ASSERT(array.release == 0);
+
+            // the round trip keeps the fields and the cells
+            VOTableArrow::exportTable(*tab, &schema, &array);
+            schema.release(&schema);
+            VOTableArrow::exportTable(*tab, &schema, &array);
+            const VOTableTable tab2 = VOTableArrow::importTable(&schema, &array);
+            CPPUNIT_ASSERT(schema.release == 0);
+            CPPUNIT_ASSERT(array.release == 0);
+            CPPUNIT_ASSERT_EQUAL(tab->getName(), tab2.getName());
+            CPPUNIT_ASSERT_EQUAL(tab->getFields().size(), tab2.getFields().size());
+            for (size_t c = 0; c < tab->getFields().size(); ++c) {
+                 CPPUNIT_ASSERT_EQUAL(tab->getFields()[c].getName(), tab2.getFields()[c].getName());
+                 CPPUNIT_ASSERT_EQUAL(tab->getFields()[c].getDatatype(), tab2.getFields()[c].getDatatype());
+                 CPPUNIT_ASSERT_EQUAL(tab->getFields()[c].getArraysize(), tab2.getFields()[c].getArraysize());
+                 CPPUNIT_ASSERT(tab->getColumn(c).getType() == tab2.getColumn(c).getType());
+            }
+            checkBinaryRows(tab->getRows(), tab2.getRows());
+
+            // only struct arrays are accepted, the structures are released anyway
+            VOTableArrow::exportTable(*tab, &schema, &array);
+            ArrowSchema* first = schema.children[0];
+            ArrowArray* firstArray = array.children[0];
+            CPPUNIT_ASSERT_THROW(VOTableArrow::importTable(first, firstArray), askap::AskapError);
+            CPPUNIT_ASSERT(first->release == 0);
+            CPPUNIT_ASSERT(firstArray->release == 0);
+            schema.release(&schema);
+            array.release(&array);
+        }
+
     private:
+        /// @brief table with fields of different datatypes and the given serialisation
+        static VOTable makeBinaryTable(VOTableTable::DataFormat format) {
+            const char* types[][3] = {{"name", "char", "*"}, {"ra", "double", ""}, {"flux", "float", ""},
+                                      {"npix", "int", ""}, {"resolved", "boolean", ""},
+                                      {"shape", "short", "3"}, {"gain", "floatComplex", ""},
+                                      {"code", "char", "4"}};
+            VOTableTable tab;
+            tab.setName("binarytable");
+            tab.setDataFormat(format);
+            for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+                VOTableField f;
+                f.setName(types[i][0]);
+                f.setDatatype(types[i][1]);
+                f.setArraysize(types[i][2]);
+                tab.addField(f);
+            }
+            const char* cells[][8] = {{"J1234-5678", "187.123456789012", "0.25", "-42", "T", "1 2 -3", "1.5 -2", "ab"},
+                                      {"<&>", "-1e-10", "3.5", "7", "F", "0 0 0", "0 0", "abcd"},
+                                      {"", "", "", "0", "", "4 5 6", "1 1", ""}};
+            for (size_t r = 0; r < 3; ++r) {
+                VOTableRow row;
+                for (size_t c = 0; c < 8; ++c) {
+                    row.addCell(cells[r][c]);
+                }
+                tab.addRow(row);
+            }
+            VOTableResource res;
+            res.setName("Binary Resource");
+            res.addTable(tab);
+            VOTable vot;
+            vot.addResource(res);
+            return vot;
+        }
+
+        /// @brief compare the rows read back (integers can't be null in BINARY, so null isn't used for them)
+        static void checkBinaryRows(const std::vector<VOTableRow>& expected, const std::vector<VOTableRow>& rows) {
+            CPPUNIT_ASSERT_EQUAL(expected.size(), rows.size());
+            for (size_t r = 0; r < rows.size(); ++r) {
+                 const std::vector<std::string> cells1 = expected[r].getCells();
+                 const std::vector<std::string> cells2 = rows[r].getCells();
+                 CPPUNIT_ASSERT_EQUAL(cells1.size(), cells2.size());
+                 for (size_t c = 0; c < cells1.size(); ++c) {
+                      CPPUNIT_ASSERT_EQUAL(cells1[c], cells2[c]);
+                 }
+            }
+        }
+
+        /// @brief row callback recording field name and value of every cell
+        struct RowCollector {
+            explicit RowCollector(std::vector<std::string>& cells) : itsCells(&cells) {}
+
+            void operator()(const VOTableTable& table, const VOTableRow& row) const {
+                const std::vector<VOTableField> fields = table.getFields();
+                const std::vector<std::string> cells = row.getCells();
+                CPPUNIT_ASSERT_EQUAL(fields.size(), cells.size());
+                for (size_t i = 0; i < cells.size(); ++i) {
+                    itsCells->push_back(fields[i].getName() + "=" + cells[i]);
+                }
+            }
+
+            std::vector<std::string>* itsCells;
+        };
+
         static void writeStringstream(const std::stringstream& ss) {
             std::ofstream fs("unittest_votable.xml", fstream::out | fstream::trunc);
             CPPUNIT_ASSERT(fs);
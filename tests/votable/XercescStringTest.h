@@ -33,6 +33,7 @@
 
 // Classes to test
 #include "askap/votable/XercescString.h"
+#include "askap/votable/VOTableTags.h"
 
 using namespace std;
 
@@ -42,6 +43,8 @@ namespace accessors {
 class XercescStringTest : public CppUnit::TestFixture {
         CPPUNIT_TEST_SUITE(XercescStringTest);
         CPPUNIT_TEST(testAll);
+        CPPUNIT_TEST(testPooledBuffers);
+        CPPUNIT_TEST(testTags);
         CPPUNIT_TEST_SUITE_END();
 
     public:
@@ -64,6 +67,32 @@ class XercescStringTest : public CppUnit::TestFixture {
             XercescString xs2(testStr);
             CPPUNIT_ASSERT(testStr.compare(xs2) == 0);
         }
+
+        void testPooledBuffers() {
+            // the buffers are reused, copies have to stay independent
+            for (int i = 0; i < 3; ++i) {
+                const XercescString xs1(std::string("J1234-5678"));
+                XercescString xs2(xs1);
+                CPPUNIT_ASSERT_EQUAL(std::string("J1234-5678"), XercescString::toString(xs2));
+                xs2 = XercescString("");
+                CPPUNIT_ASSERT_EQUAL(std::string(), XercescString::toString(xs2));
+                CPPUNIT_ASSERT_EQUAL(std::string("J1234-5678"), XercescString::toString(xs1));
+            }
+            CPPUNIT_ASSERT_EQUAL(std::string(), XercescString::toString(static_cast<const XMLCh*>(0)));
+
+            // non-ASCII strings go through the transcoder
+            const std::string latin("caf\xc3\xa9");
+            const XercescString xs3(latin);
+            const std::string back = xs3;
+            CPPUNIT_ASSERT_EQUAL(std::string("caf"), back.substr(0, 3));
+            CPPUNIT_ASSERT(back.size() > 3);
+        }
+
+        void testTags() {
+            CPPUNIT_ASSERT_EQUAL(std::string("FIELDref"), VOTableTags::FIELDref.str());
+            CPPUNIT_ASSERT(xercesc::XMLString::equals(VOTableTags::ATTR_ARRAYSIZE, XercescString("arraysize")));
+            CPPUNIT_ASSERT_EQUAL(std::string("TABLEDATA"), XercescString::toString(VOTableTags::TABLEDATA));
+        }
 };
 
 }